@@ -17,24 +17,45 @@
 #include "DetourModKit/anchor.hpp"
 #include "DetourModKit/async_logger_config.hpp"
 #include "DetourModKit/config.hpp"
+#include "DetourModKit/deferred.hpp"
 #include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/diagnostics_export.hpp"
 #include "DetourModKit/detail/drift_manifest.hpp"
 #include "DetourModKit/detail/event_dispatcher.hpp"
 #include "DetourModKit/filesystem.hpp"
 #include "DetourModKit/format.hpp"
 #include "DetourModKit/hook.hpp"
+#include "DetourModKit/hook_mux.hpp"
+#include "DetourModKit/integrity.hpp"
 #include "DetourModKit/input.hpp"
 #include "DetourModKit/input_codes.hpp"
+#include "DetourModKit/log_kv.hpp"
+#include "DetourModKit/log_ring.hpp"
 #include "DetourModKit/logger.hpp"
 #include "DetourModKit/manifest.hpp"
 #include "DetourModKit/math.hpp"
 #include "DetourModKit/memory.hpp"
+#include "DetourModKit/metrics.hpp"
+#include "DetourModKit/offline.hpp"
+#include "DetourModKit/pointer_map.hpp"
+#include "DetourModKit/profile_dump.hpp"
+#include "DetourModKit/profile_stream.hpp"
 #include "DetourModKit/profiler.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/rtti.hpp"
 #include "DetourModKit/rtti_dissect.hpp"
 #include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_async.hpp"
+#include "DetourModKit/scan_cache.hpp"
+#include "DetourModKit/scan_cursor.hpp"
+#include "DetourModKit/scan_index.hpp"
+#include "DetourModKit/scan_ladder_store.hpp"
+#include "DetourModKit/services.hpp"
 #include "DetourModKit/session.hpp"
 #include "DetourModKit/sighealth.hpp"
+#include "DetourModKit/snapshot.hpp"
+#include "DetourModKit/value_scanner.hpp"
+#include "DetourModKit/watch_set.hpp"
 #include "DetourModKit/detail/worker.hpp"
 
 #endif // DETOURMODKIT_HPP
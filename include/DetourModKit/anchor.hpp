@@ -22,12 +22,14 @@
 
 #include "DetourModKit/error.hpp"
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/scan.hpp"
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <stop_token>
 #include <string_view>
 
 namespace DetourModKit
@@ -94,6 +96,11 @@ namespace DetourModKit
         static_assert(static_cast<std::size_t>(AnchorKind::Unset) + 1 == ANCHOR_KIND_COUNT,
                       "ANCHOR_KIND_COUNT must track the AnchorKind enumerator count.");
 
+        /// @ref Anchor::parent of an anchor that depends on no other (the default).
+        inline constexpr std::size_t NO_PARENT = static_cast<std::size_t>(-1);
+        /// Bytes a child anchor scans from its parent's resolved value when @ref Anchor::parent_window is 0.
+        inline constexpr std::size_t DEFAULT_PARENT_WINDOW = 0x1000;
+
         /**
          * @enum QuorumMatch
          * @brief The agreement policy a @ref AnchorKind::Quorum applies when deciding whether two resolved member
@@ -252,6 +259,31 @@ namespace DetourModKit
             std::string_view export_module;
             /// ExportName: the exact, case-sensitive export symbol name (no decoration), e.g. "Sleep". Borrowed.
             std::string_view export_name;
+            /**
+             * @brief RipGlobal: the site's last known offset from the scope's base, or 0 (the default) for none.
+             * @details Forwarded as @ref scan::ScanRequest::hint_rva, so after a patch the cascade first tries its byte
+             *          rungs in the small window around where the site last resolved and widens to the whole scope
+             *          only when that window has no unique hit. @ref ResolvedAnchor::source reports which answered;
+             *          refresh the hint from a Resolved entry's value minus the scope base. Not part of the drift
+             *          fingerprint, since it moves with every patch. Ignored by RegionSet scopes and other kinds.
+             *          Appended to preserve positional aggregate initialization of the established fields.
+             */
+            std::uint64_t last_seen_rva = 0;
+            /**
+             * @brief Index, within the same table, of the anchor this one is found inside; @ref NO_PARENT (the
+             *        default) for none.
+             * @details Honoured by @ref resolve_all and its variants. A child resolves after its parent, against the
+             *          window of @ref parent_window bytes starting at the parent's resolved value instead of the
+             *          table's scope: the function a RipGlobal or StringXref parent found, or the site a CodeOperand
+             *          child then reads. The parallel resolvers run independent anchors concurrently and start a child
+             *          the moment its parent resolves. A child whose parent did not resolve, or whose index is out of
+             *          range or on a cycle, fails closed without scanning. A single-anchor @ref resolve ignores it, and
+             *          it is not part of the drift fingerprint. Appended to preserve positional aggregate
+             *          initialization of the established fields.
+             */
+            std::size_t parent = NO_PARENT;
+            /// Bytes a child scans from its parent's value; 0 (the default) selects @ref DEFAULT_PARENT_WINDOW.
+            std::size_t parent_window = 0;
         };
 
         /**
@@ -272,6 +304,11 @@ namespace DetourModKit
             AnchorStatus status = AnchorStatus::Unresolved;
             /// The resolved quantity, meaningful only when @ref status is @ref AnchorStatus::Resolved.
             std::int64_t value = 0;
+            /**
+             * @brief The resolve stage that answered a Resolved RipGlobal: the full cascade, a cache entry, or the
+             *        @ref Anchor::last_seen_rva window. Left @ref scan::HitSource::Ladder for every other kind.
+             */
+            scan::HitSource source = scan::HitSource::Ladder;
         };
 
         /**
@@ -405,6 +442,11 @@ namespace DetourModKit
             scan::CandidateOrder candidate_order = scan::CandidateOrder::AsDeclared;
             /// A per-@ref AnchorKind deny-list. A denied backend fails closed (never silently replaced by another).
             std::array<bool, ANCHOR_KIND_COUNT> deny_backend{};
+            /**
+             * @brief Optional resolution cache for RipGlobal cascades (see @ref scan::ScanRequest::cache). Non-owning;
+             *        nullptr resolves every cascade in full.
+             */
+            scan::ResolutionCache *resolution_cache = nullptr;
 
             /**
              * @brief Reports whether @p kind's backend is denied by this profile.
@@ -438,12 +480,28 @@ namespace DetourModKit
          */
         [[nodiscard]] ResolvedAnchor resolve(const Anchor &anchor, Region scope = Region::host());
 
+        /**
+         * @brief Resolves one anchor within every span of a RegionSet.
+         * @param anchor The anchor to resolve.
+         * @param scope The spans to resolve within; an empty set fails the anchor closed.
+         * @return A @ref ResolvedAnchor carrying the outcome and (on success) the value.
+         * @details A RipGlobal cascade resolves across the whole set at once (see @ref scan::ScanRequest::regions),
+         *          so its ladder order and uniqueness hold set-wide. Every other kind resolves in each span on its own
+         *          and is accepted only when every span that resolves it agrees on one value: a vtable found in two
+         *          spans fails closed, while a Manual literal or an export in a named module -- the same answer
+         *          anywhere -- resolves. A Quorum's members must therefore resolve within one span.
+         */
+        [[nodiscard]] ResolvedAnchor resolve(const Anchor &anchor, const RegionSet &scope);
+
         /**
          * @brief Resolves a table of anchors serially, writing one @ref ResolvedAnchor per input.
          * @param anchors The anchor table.
          * @param out The report buffer; at most `min(anchors.size(), out.size())` entries are written.
          * @param scope The module image to resolve within.
          * @return The number of entries written.
+         * @details Outcome-identical to resolving each anchor alone, but batched: the byte rungs of every RipGlobal
+         *          cascade and CodeOperand site are swept in one multi-pattern pass per page class, the string
+         *          literals share one reference index, and every scan replays one captured page map of @p scope.
          */
         [[nodiscard]] std::size_t resolve_all(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out,
                                               Region scope = Region::host());
@@ -454,15 +512,19 @@ namespace DetourModKit
          * @param out The report buffer; at most `min(anchors.size(), out.size())` entries are written, in input order.
          * @param scope The module image to resolve within.
          * @param max_workers Upper bound on worker threads (0 = auto-select from hardware_concurrency, clamped).
+         * @param stop Cancels the rest of the table when it fires; every anchor it skips or cuts short reads Failed.
          * @return The number of entries written.
          * @details Each anchor still goes through the single-anchor @ref resolve path, so backend failures, validators,
-         *          quorum checks, and result ordering all match @ref resolve_all. It is opt-in because validators run
+         *          quorum checks, and result ordering all match @ref resolve_all. A table that declares
+         *          @ref Anchor::parent links runs as a dependency graph: every chain proceeds independently, and a
+         *          child starts as soon as its own parent resolves. It is opt-in because validators run
          *          concurrently; use the serial @ref resolve_all when a validator context is order-dependent or must be
          *          externally serialized.
          * @note Setup/control-plane only: spawns a worker pool. Never call it from a hook or under the loader lock.
          */
         [[nodiscard]] std::size_t resolve_all_parallel(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out,
-                                                       Region scope = Region::host(), std::size_t max_workers = 0);
+                                                       Region scope = Region::host(), std::size_t max_workers = 0,
+                                                       std::stop_token stop = {});
 
         /**
          * @brief Rolls a drift report into an @ref AnchorQuality summary in one allocation-free pass (no re-resolve).
@@ -508,6 +570,14 @@ namespace DetourModKit
         [[nodiscard]] ResolvedAnchor resolve_with_profile(const Anchor &anchor, const ScanProfile &profile,
                                                           Region scope = Region::host());
 
+        /**
+         * @brief Resolves one anchor within a RegionSet with a profile's defaults applied.
+         * @details The RegionSet rules of @ref resolve(const Anchor &, const RegionSet &), with the profile applied as
+         *          in the Region overload.
+         */
+        [[nodiscard]] ResolvedAnchor resolve_with_profile(const Anchor &anchor, const ScanProfile &profile,
+                                                          const RegionSet &scope);
+
         /**
          * @brief Resolves a table serially with a profile's defaults applied.
          * @param anchors The anchor table.
@@ -527,6 +597,7 @@ namespace DetourModKit
          * @param profile The per-game defaults.
          * @param scope The module image to resolve within.
          * @param max_workers Upper bound on worker threads (0 = auto-select).
+         * @param stop Cancels the rest of the table when it fires, as for @ref resolve_all_parallel.
          * @return The number of entries written.
          * @note Setup/control-plane only: spawns a worker pool. Never call it from a hook or under the loader lock.
          */
@@ -534,7 +605,8 @@ namespace DetourModKit
                                                                     std::span<ResolvedAnchor> out,
                                                                     const ScanProfile &profile,
                                                                     Region scope = Region::host(),
-                                                                    std::size_t max_workers = 0);
+                                                                    std::size_t max_workers = 0,
+                                                                    std::stop_token stop = {});
     } // namespace anchor
 } // namespace DetourModKit
 
@@ -4,12 +4,12 @@
 /**
  * @file async_logger_config.hpp
  * @brief Lightweight, public async-logger configuration surface.
- * @details This header carries only the control-plane configuration types (OverflowPolicy and AsyncLoggerConfig) plus
- *          the default constants the configuration references. It deliberately pulls none of the async-logger plumbing
- *          (no MPMC queue, no string pool, no <atomic> machinery), so a DllMain-entry header such as bootstrap.hpp can
- *          embed an AsyncLoggerConfig by value without forcing every consumer translation unit to compile the queue and
- *          pool. The internal writer header includes this header too, so the public Logger facade and private async
- *          transport share one configuration type.
+ * @details This header carries only the control-plane configuration types (OverflowPolicy, AsyncLoggerConfig, and
+ *          AdaptiveLoggingConfig) plus the default constants the configuration references. It deliberately pulls none
+ *          of the async-logger plumbing (no MPMC queue, no string pool, no <atomic> machinery), so a DllMain-entry
+ *          header such as bootstrap.hpp can embed an AsyncLoggerConfig by value without forcing every consumer
+ *          translation unit to compile the queue and pool. The internal writer header includes this header too, so
+ *          the public Logger facade and private async transport share one configuration type.
  */
 
 #include <chrono>
@@ -26,6 +26,27 @@ namespace DetourModKit
     inline constexpr auto DEFAULT_FLUSH_INTERVAL = std::chrono::milliseconds(100);
     /// Default spin-backoff iteration count before a producer yields/parks.
     inline constexpr size_t DEFAULT_SPIN_BACKOFF_ITERATIONS = 32;
+    /// Default slot count of each producer lane under LogTransport::PerThreadLanes.
+    inline constexpr size_t DEFAULT_LANE_CAPACITY = 1024;
+    /// Default bytes per page of the overlapped file sink.
+    inline constexpr size_t DEFAULT_WRITE_BUFFER_SIZE = 64 * 1024;
+    /// Page counts the overlapped file sink accepts: double or triple buffering.
+    inline constexpr size_t MIN_WRITE_BUFFER_COUNT = 2;
+    inline constexpr size_t MAX_WRITE_BUFFER_COUNT = 3;
+    /// Default lines a call site may log back to back before rate_limit_per_second applies.
+    inline constexpr size_t DEFAULT_RATE_LIMIT_BURST = 64;
+    /// Largest rate_limit_per_second and rate_limit_burst AsyncLoggerConfig::validate() accepts.
+    inline constexpr size_t MAX_RATE_LIMIT_PER_SECOND = 1'000'000;
+    inline constexpr size_t MAX_RATE_LIMIT_BURST = (size_t{1} << 24) - 1;
+    /// Default size of the crash ring file: 2047 lines of up to 488 bytes each (see log_ring.hpp).
+    inline constexpr size_t DEFAULT_CRASH_RING_SIZE = 1024 * 1024;
+    /// Sizes AsyncLoggerConfig::validate() accepts for crash_ring_size.
+    inline constexpr size_t MIN_CRASH_RING_SIZE = 64 * 1024;
+    inline constexpr size_t MAX_CRASH_RING_SIZE = size_t{1} << 30;
+    /// Default time a synchronous log call may wait for the sink lock before adaptive mode promotes to async.
+    inline constexpr auto DEFAULT_PROMOTION_LOCK_WAIT = std::chrono::microseconds(100);
+    /// Default time one synchronous sink write may take before adaptive mode promotes to async.
+    inline constexpr auto DEFAULT_PROMOTION_WRITE_LATENCY = std::chrono::microseconds(1000);
 
     /**
      * @enum OverflowPolicy
@@ -46,6 +67,24 @@ namespace DetourModKit
         SyncFallback
     };
 
+    /**
+     * @enum LogTransport
+     * @brief How AsyncLogger::enqueue hands a record to the writer thread.
+     */
+    enum class LogTransport
+    {
+        /// One bounded ring every producer pushes into. Every producer contends on its enqueue cursor.
+        SharedQueue,
+        /**
+         * @brief A bounded ring of lane_capacity slots per producing thread, created on the thread's first message.
+         * @details A producer only touches its own lane, so threads logging at once no longer meet on one cursor.
+         *          The writer drains every lane in each pass and writes the pass in timestamp order; one thread's
+         *          messages keep their order. The overflow_policy applies to each lane on its own. Threads past the
+         *          lane limit (64 per logger) fall back to the shared queue.
+         */
+        PerThreadLanes
+    };
+
     /**
      * @struct AsyncLoggerConfig
      * @brief Configuration for the async logger.
@@ -53,11 +92,13 @@ namespace DetourModKit
      *          LOG_INLINE_MESSAGE_SIZE (512) byte inline buffer, so the ring buffer's resident footprint is on the
      *          order of a few MiB at the default capacity (queue_capacity must stay a power of two). The overflow
      *          string pool (for messages larger than the inline buffer) is a separate, lazily grown allocation behind
-     *          the AsyncLogger pimpl (detail::StringPool). Shrink queue_capacity for memory-constrained hosts.
+     *          the AsyncLogger pimpl (detail::StringPool). Shrink queue_capacity for memory-constrained hosts. Under
+     *          LogTransport::PerThreadLanes every producing thread adds a lane of lane_capacity slots on top.
      */
     struct AsyncLoggerConfig
     {
         size_t queue_capacity = DEFAULT_QUEUE_CAPACITY;
+        /// Messages per writer pass while the queue is quiet; a backlog grows the pass to up to 16 times this.
         size_t batch_size = DEFAULT_BATCH_SIZE;
         std::chrono::milliseconds flush_interval = DEFAULT_FLUSH_INTERVAL;
         OverflowPolicy overflow_policy = OverflowPolicy::DropOldest;
@@ -70,6 +111,74 @@ namespace DetourModKit
          *          timestamps; the trailing ".<ms>" is appended by the writer, not this format.
          */
         std::string timestamp_format{"%Y-%m-%d %H:%M:%S"};
+        /// The producer-to-writer transport (see @ref LogTransport).
+        LogTransport transport = LogTransport::SharedQueue;
+        /// Slots in each per-thread lane (power of two); used only by LogTransport::PerThreadLanes.
+        size_t lane_capacity = DEFAULT_LANE_CAPACITY;
+        /**
+         * @brief Moves std::format work for scalar-only log lines from the calling thread to the writer.
+         * @details When set, a formatted Logger::log() whose arguments are all arithmetic values or untyped pointers
+         *          enqueues the format string, the call site, and the raw argument bytes, and the writer renders the
+         *          line. Lines with any other argument (strings, views, user types that may reference caller memory)
+         *          are still formatted eagerly. The rendered text is identical either way.
+         */
+        bool defer_formatting = false;
+        /**
+         * @brief Writes the log file with overlapped I/O so the writer keeps draining while a page is on its way out.
+         * @details The sink's handle is switched to FILE_FLAG_OVERLAPPED when the async logger starts and rotates
+         *          through write_buffer_count pages of write_buffer_size bytes; the writer fills one page while the
+         *          previous one is in flight and blocks only when every page is queued. The file stays in this mode
+         *          for the rest of its life, synchronous logging included. If the switch fails the sink keeps
+         *          synchronous writes.
+         */
+        bool overlapped_writes = false;
+        /// Bytes per page under overlapped_writes (4 KiB to 16 MiB).
+        size_t write_buffer_size = DEFAULT_WRITE_BUFFER_SIZE;
+        /// Pages in rotation under overlapped_writes (MIN_WRITE_BUFFER_COUNT to MAX_WRITE_BUFFER_COUNT).
+        size_t write_buffer_count = MIN_WRITE_BUFFER_COUNT;
+        /**
+         * @brief Bytes the writer lets collect in the sink before handing them to the OS after a batch.
+         * @details 0 hands every batch over, as before. A larger value lets small batches share one write; the idle
+         *          writer still hands over whatever is buffered once flush_interval passes, and Logger::flush() always
+         *          does. A value above write_buffer_size is rejected.
+         */
+        size_t flush_threshold = 0;
+        /**
+         * @brief Lines per second each call site may log; 0 (the default) turns rate limiting off.
+         * @details Keyed on the source location a LocatedFormat captures, so it applies to the formatted
+         *          log() / try_log() forms and the level-named loggers; a pre-rendered log(level, message) has no call
+         *          site and is never limited. Each site holds a token bucket of rate_limit_burst lines refilled at this
+         *          rate. A line over the limit is dropped before it is formatted or queued and counted with the
+         *          queue's overflow drops.
+         */
+        size_t rate_limit_per_second = 0;
+        /// Lines a call site may log at once before rate_limit_per_second throttles it (1 to MAX_RATE_LIMIT_BURST).
+        size_t rate_limit_burst = DEFAULT_RATE_LIMIT_BURST;
+        /**
+         * @brief Writes a run of identical consecutive lines once, followed by "last message repeated N times".
+         * @details Two lines are identical when their level and text match; the timestamps may differ. The count
+         *          line goes out when a different line arrives, when the writer has been idle for flush_interval,
+         *          on Logger::flush(), and at shutdown.
+         */
+        bool collapse_duplicates = false;
+        /**
+         * @brief UTF-8 path of a crash ring file the logger mirrors every line into; empty (the default) for none.
+         * @details The file is mapped into memory and each producer copies its line into the next slot before queueing
+         *          it, with no system call, so the lines still in the queue when the process dies are on disk anyway.
+         *          A line through defer_formatting reaches the ring when the writer renders it. The previous
+         *          session's ring is kept as `<path>.prev`. Decode a ring with log_ring::read_file or the
+         *          DetourModKit_log_ring_decode tool. A ring that cannot be created is skipped; logging carries on.
+         */
+        std::string crash_ring_path;
+        /// Bytes of the crash ring file (MIN_CRASH_RING_SIZE to MAX_CRASH_RING_SIZE); used only with crash_ring_path.
+        size_t crash_ring_size = DEFAULT_CRASH_RING_SIZE;
+        /**
+         * @brief UTF-8 path of the binary structured log that Logger::log_kv() records go to; empty (the default) for
+         *        none, in which case those records are written to the text log as lines.
+         * @details The file is recreated each session. Decode it with log_kv::read_file or the
+         *          DetourModKit_log_kv_decode tool. A file that cannot be created is skipped; logging carries on.
+         */
+        std::string structured_log_path;
 
         [[nodiscard]] constexpr bool validate() const noexcept
         {
@@ -85,10 +194,47 @@ namespace DetourModKit
                 return false;
             if (block_max_spin_iterations == 0)
                 return false;
+            if (lane_capacity < 2 || (lane_capacity & (lane_capacity - 1)) != 0)
+                return false;
+            if (write_buffer_size < 4096 || write_buffer_size > 16 * 1024 * 1024)
+                return false;
+            if (write_buffer_count < MIN_WRITE_BUFFER_COUNT || write_buffer_count > MAX_WRITE_BUFFER_COUNT)
+                return false;
+            if (flush_threshold > write_buffer_size)
+                return false;
+            if (rate_limit_per_second > MAX_RATE_LIMIT_PER_SECOND)
+                return false;
+            if (rate_limit_burst == 0 || rate_limit_burst > MAX_RATE_LIMIT_BURST)
+                return false;
+            if (!crash_ring_path.empty() &&
+                (crash_ring_size < MIN_CRASH_RING_SIZE || crash_ring_size > MAX_CRASH_RING_SIZE))
+                return false;
             return true;
         }
     };
 
+    /**
+     * @struct AdaptiveLoggingConfig
+     * @brief Configuration for Logger::enable_adaptive_mode.
+     * @details The logger stays synchronous until one log call waits longer than lock_wait for the sink lock or
+     *          spends longer than write_latency writing its line, then switches to async mode with the async
+     *          configuration below. A zero threshold promotes on the first line that measures it.
+     */
+    struct AdaptiveLoggingConfig
+    {
+        /// Sink lock wait that promotes the logger; only measured when the lock is already held.
+        std::chrono::microseconds lock_wait = DEFAULT_PROMOTION_LOCK_WAIT;
+        /// Duration of one synchronous write, flush included, that promotes the logger.
+        std::chrono::microseconds write_latency = DEFAULT_PROMOTION_WRITE_LATENCY;
+        /// Configuration handed to Logger::enable_async_mode on promotion.
+        AsyncLoggerConfig async{};
+
+        [[nodiscard]] constexpr bool validate() const noexcept
+        {
+            return lock_wait.count() >= 0 && write_latency.count() >= 0 && async.validate();
+        }
+    };
+
     // Compile-time validation: the default queue capacity must be a power of 2 and at least 2.
     static_assert(DEFAULT_QUEUE_CAPACITY >= 2 && (DEFAULT_QUEUE_CAPACITY & (DEFAULT_QUEUE_CAPACITY - 1)) == 0,
                   "DEFAULT_QUEUE_CAPACITY must be a power of 2 and at least 2");
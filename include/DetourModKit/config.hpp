@@ -26,16 +26,24 @@
  *       background reload worker that may itself be blocked on it (see reload()).
  */
 
+#include "DetourModKit/detail/event_dispatcher.hpp"
 #include "DetourModKit/input.hpp"
+#include "DetourModKit/logger.hpp"
 
 #include <atomic>
 #include <chrono>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -53,10 +61,50 @@ namespace DetourModKit
             AlreadyRunning,
             /// load() was never called, so there is no path to watch.
             NoPriorLoad,
-            /// The parent directory could not be opened or the start handshake failed.
+            /// The parent directory could not be opened or watched.
             StartFailed
         };
 
+        /**
+         * @struct ConfigKey
+         * @brief One bound INI key, as reported by reload(std::vector<ConfigKey> &).
+         */
+        struct ConfigKey
+        {
+            std::string section;
+            std::string ini_key;
+
+            bool operator==(const ConfigKey &) const = default;
+        };
+
+        /**
+         * @struct ConfigReloaded
+         * @brief Emitted on reload_events() once per load() / reload() pass that changed at least one bound key.
+         */
+        struct ConfigReloaded
+        {
+            /**
+             * @brief Every bound key whose parsed value changed in the pass, in registration order.
+             * @details All of them for the first load(). Includes a key whose setter threw.
+             */
+            std::vector<ConfigKey> changed_keys;
+            /// False when a setter threw or an unload cut the setter pass short; the next reload retries those keys.
+            bool all_applied = true;
+
+            /// True when @p section / @p ini_key is among changed_keys.
+            [[nodiscard]] bool changed(std::string_view section, std::string_view ini_key) const noexcept
+            {
+                for (const ConfigKey &key : changed_keys)
+                {
+                    if (key.section == section && key.ini_key == ini_key)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+        };
+
         /// Constrains the atomic-backed bind to the scalar types the INI pipeline parses directly.
         template <typename T>
         concept BindableScalar = std::same_as<T, int> || std::same_as<T, bool> || std::same_as<T, float>;
@@ -179,6 +227,123 @@ namespace DetourModKit
                          std::atomic<std::uint32_t> &out, std::function<std::uint32_t(std::string_view)> parse,
                          std::string_view default_value);
 
+        /**
+         * @class Snapshot
+         * @brief An immutable configuration value that hot paths read with no lock and no allocation.
+         * @details For settings an std::atomic cannot hold: strings, and structs parsed from one key. Each publish()
+         *          builds a new const T and swaps it in with one pointer exchange; the value it replaced is retired and
+         *          freed by a later publish once no reader can still hold it. read() announces the reclamation epoch in
+         *          the calling thread's own reader record -- the records EventDispatcher::emit uses, so a read nests
+         *          inside an emit and vice versa -- loads the pointer, and returns a Reader that clears the record when
+         *          it goes out of scope. After a thread's first read or emit, which claims its record, a read is
+         *          wait-free. Writers (the bind_snapshot setter, or a direct publish()) serialize on a private mutex.
+         *
+         *          Bind it with bind_snapshot(). The Snapshot must outlive that binding and every Reader; destroying it
+         *          frees the current and retired values.
+         * @tparam T The value type.
+         */
+        template <typename T> class Snapshot
+        {
+        public:
+            /**
+             * @class Reader
+             * @brief Pins one published value for the Reader's lifetime.
+             * @details Keep it scoped to the read: while any Reader is alive on any thread, no value retired after it
+             *          was taken can be freed. Not movable, so it cannot escape the scope that took it.
+             */
+            class Reader
+            {
+            public:
+                Reader(const Reader &) = delete;
+                Reader &operator=(const Reader &) = delete;
+
+                [[nodiscard]] const T &get() const noexcept { return *m_value; }
+                [[nodiscard]] const T &operator*() const noexcept { return *m_value; }
+                [[nodiscard]] const T *operator->() const noexcept { return m_value; }
+
+            private:
+                friend class Snapshot;
+
+                explicit Reader(const std::atomic<const T *> &current) noexcept
+                    : m_value(current.load(std::memory_order_seq_cst))
+                {
+                }
+
+                // Declared first so the announcement precedes the pointer load in m_value's initializer.
+                detail::EmitEpochScope m_epoch;
+                const T *m_value;
+            };
+
+            /// Publishes @p initial as the first value.
+            explicit Snapshot(T initial = T{}) : m_current(new const T(std::move(initial))) {}
+
+            ~Snapshot() { delete m_current.load(std::memory_order_relaxed); }
+
+            Snapshot(const Snapshot &) = delete;
+            Snapshot &operator=(const Snapshot &) = delete;
+
+            /// Pins and returns the current value. Safe from any thread, including hooks.
+            [[nodiscard]] Reader read() const noexcept { return Reader{m_current}; }
+
+            /**
+             * @brief Replaces the value readers see.
+             * @details Allocates; a std::bad_alloc leaves the previous value published. Frees every retired value no
+             *          Reader can still hold.
+             */
+            void publish(T value)
+            {
+                auto next = std::make_unique<const T>(std::move(value));
+                std::lock_guard<std::mutex> lock(m_writer_mutex);
+                m_retired.reserve_one();
+                m_retired.retire(m_current.exchange(next.release(), std::memory_order_seq_cst));
+            }
+
+            /// Replaced values not yet freed because a Reader may still hold them.
+            [[nodiscard]] std::size_t retired_count() const
+            {
+                std::lock_guard<std::mutex> lock(m_writer_mutex);
+                return m_retired.size();
+            }
+
+        private:
+            std::atomic<const T *> m_current;
+            mutable std::mutex m_writer_mutex;
+            detail::RetiredSnapshots<T> m_retired;
+        };
+
+        /**
+         * @brief Binds an INI key to a Snapshot through a user parse function.
+         * @details The parse function turns the raw INI string into a T, which is published to @p out at registration
+         *          (from @p default_value) and again on each load() / reload() that changes the key's value. Readers
+         *          never wait for it. @p out is captured by reference and must outlive the registration.
+         * @param section INI section name.
+         * @param key INI key name.
+         * @param display_name Human-readable name shown in log output.
+         * @param out Snapshot the parsed values are published to.
+         * @param parse Function turning the raw INI string into the published value; an exception it throws is
+         *              logged and leaves the previous value published.
+         * @param default_value Default INI string parsed when the key is absent.
+         * @note Setup/control-plane only: registration may allocate and updates the config registry.
+         */
+        template <typename T>
+        void bind_snapshot(std::string_view section, std::string_view key, std::string_view display_name,
+                           Snapshot<T> &out, std::type_identity_t<std::function<T(std::string_view)>> parse,
+                           std::string_view default_value)
+        {
+            bind_string(
+                section, key, display_name, [&out, parse = std::move(parse)](std::string_view value)
+                { out.publish(parse(value)); }, default_value);
+        }
+
+        /// Binds an INI key to a string Snapshot holding the raw value. See the parsing overload.
+        inline void bind_snapshot(std::string_view section, std::string_view key, std::string_view display_name,
+                                  Snapshot<std::string> &out, std::string_view default_value)
+        {
+            bind_string(
+                section, key, display_name, [&out](std::string_view value) { out.publish(std::string(value)); },
+                default_value);
+        }
+
         /**
          * @brief Binds a log-level INI key that applies directly to the logger.
          * @details Parses @p default_value via the logger's string-to-level mapping and applies it both at registration
@@ -189,6 +354,27 @@ namespace DetourModKit
          */
         void bind_log_level(std::string_view section, std::string_view key, std::string_view default_value = "INFO");
 
+        /**
+         * @brief Binds a log-level INI key that pins one log category's level.
+         * @details A recognised value pins @p category through Logger::set_log_level(category, level); an empty value
+         *          unpins it so it follows the global level again. Applied at registration and on each load() /
+         *          reload(), so clearing the key on a reload drops the pin.
+         * @param section INI section name.
+         * @param key INI key name.
+         * @param category The category the key controls.
+         * @param default_value Default level string; empty (the default) leaves the category on the global level.
+         */
+        void bind_log_level(std::string_view section, std::string_view key, LogCategory category,
+                            std::string_view default_value = "");
+
+        /**
+         * @brief Binds one key per log category in @p section, named by to_string(LogCategory) ("Hook", "Scan", ...).
+         * @details Each key behaves like the categorized bind_log_level with an empty default, so
+         *          `[Logging.Categories] Scan = DEBUG` raises the scanner's level alone and absent keys follow the
+         *          global level.
+         */
+        void bind_log_categories(std::string_view section);
+
         /**
          * @brief Binds an INI combo string to a press-mode input binding and returns its guard.
          * @details Parses the INI value as one or more key combinations (commas separate independent combos under OR
@@ -282,12 +468,14 @@ namespace DetourModKit
         void load(std::string_view ini_filename);
 
         /**
-         * @brief Re-applies all bound setters against the last-loaded INI file.
-         * @details Re-reads the file passed to the most recent load() and re-invokes every setter with the fresh value.
-         *          If the file's bytes are unchanged since the last successful load (content-hash short-circuit), the
-         *          setters are skipped. If the file cannot be read (deleted or locked mid-save) or fails to parse, the
-         *          setters are also skipped and the last-applied values are retained rather than snapped back to their
-         *          defaults; reload() still returns true. Bindings persist across reloads.
+         * @brief Re-applies the bound setters whose values changed in the last-loaded INI file.
+         * @details Re-reads the file passed to the most recent load() and re-invokes the setter of every key whose
+         *          parsed value differs from the one its setter last received; each bound item keeps a fingerprint of
+         *          that value, so an edit to one key of a large config wakes one setter (and rebinds at most one
+         *          combo). If the file's bytes are unchanged since the last successful load (content-hash
+         *          short-circuit), the setters are skipped. If the file cannot be read (deleted or locked mid-save) or
+         *          fails to parse, the setters are also skipped and the last-applied values are retained rather than
+         *          snapped back to their defaults; reload() still returns true. Bindings persist across reloads.
          * @return true if a previous load() path was available and the reload proceeded; false if reload() was called
          *         before any load().
          * @note Safe from any thread. Concurrent reload() and load() passes are serialized end to end, so two racing
@@ -300,6 +488,44 @@ namespace DetourModKit
          */
         [[nodiscard]] bool reload();
 
+        /**
+         * @brief reload(), also reporting which keys changed.
+         * @details @p changed_keys is cleared, then receives every bound key whose parsed value changed in this pass,
+         *          in registration order -- including one whose setter threw, which the next reload retries. It stays
+         *          empty when the pass was skipped (unchanged content, read or parse failure) or nothing changed.
+         * @param changed_keys Receives the changed keys.
+         * @return As reload().
+         */
+        [[nodiscard]] bool reload(std::vector<ConfigKey> &changed_keys);
+
+        /**
+         * @brief Returns the process-wide dispatcher for @ref ConfigReloaded.
+         * @details Emitted after the last setter of a load() / reload() pass that changed anything has run, whichever
+         *          thread drove the pass (the caller, the auto-reload watcher, or the reload hotkey servicer), so a
+         *          handler observes every value of the pass already applied. A pass that changed nothing -- unchanged
+         *          content, a read or parse failure -- emits nothing, and nothing is emitted once a Logic DLL unload
+         *          has latched reloads off. Handler exceptions are caught and logged. The returned reference is stable
+         *          for the process lifetime.
+         * @note Handlers run under the pass lock, like setters, so passes are reported in the order they applied; a
+         *       handler is bound by the setter contract (see reload()) and must not call load(), reload(),
+         *       disable_auto_reload(), or clear().
+         */
+        EventDispatcher<ConfigReloaded> &reload_events();
+
+        /**
+         * @brief Coalesced change notification: runs @p on_change once per pass that changed any of @p keys.
+         * @details For state derived from several keys (a lookup table, a constant block), bind the inputs without
+         *          setters -- bind() to an atomic, or bind_snapshot() -- and rebuild here, once per reload, instead of
+         *          from each key's setter. An empty @p keys matches every change. A filtered reload_events()
+         *          subscription; see there for the threading contract.
+         * @param keys The keys to watch.
+         * @param on_change Called with the pass's event.
+         * @return The subscription; notifications stop when it is reset or destroyed. Inactive if @p on_change is
+         *         empty.
+         */
+        [[nodiscard]] Subscription on_keys_changed(std::vector<ConfigKey> keys,
+                                                   std::function<void(const ConfigReloaded &)> on_change);
+
         /**
          * @brief Starts a background watcher that calls reload() when the INI changes.
          * @details Watches the directory of the path last passed to load(), collapsing bursty editor saves into one
@@ -311,7 +537,7 @@ namespace DetourModKit
          * @param debounce Quiet window between change detection and reload (default 250 ms).
          * @param on_reload Optional callback invoked after each reload attempt.
          * @return Started if the watcher is now running; AlreadyRunning if one was already installed; NoPriorLoad if
-         *         load() has not been called; StartFailed if the directory could not be opened or the handshake failed.
+         *         load() has not been called; StartFailed if the directory could not be opened or watched.
          */
         [[nodiscard]] AutoReloadStatus
         enable_auto_reload(std::chrono::milliseconds debounce = std::chrono::milliseconds{250},
@@ -319,9 +545,9 @@ namespace DetourModKit
 
         /**
          * @brief Stops the auto-reload watcher.
-         * @details Idempotent. Returns once the watcher thread has exited (or been detached under the Windows loader
-         *          lock). Calling this from inside an on_reload callback (the watcher thread) is a no-op that logs and
-         *          leaves the watcher running, since joining the worker from itself would deadlock.
+         * @details Idempotent. Returns once a running reload pass has finished (without waiting under the Windows
+         *          loader lock). Calling this from inside an on_reload callback (the watcher thread) is a no-op that
+         *          logs and leaves the watcher running, since the wait would be for the caller itself.
          */
         void disable_auto_reload() noexcept;
 
@@ -411,12 +637,37 @@ namespace DetourModKit
                 config::bind_parsed(m_section, key, display_name, out, std::move(parse), default_value);
             }
 
+            /// Section-scoped parsed snapshot bind. See config::bind_snapshot.
+            template <typename T>
+            void bind_snapshot(std::string_view key, std::string_view display_name, Snapshot<T> &out,
+                               std::type_identity_t<std::function<T(std::string_view)>> parse,
+                               std::string_view default_value) const
+            {
+                config::bind_snapshot<T>(m_section, key, display_name, out, std::move(parse), default_value);
+            }
+
+            /// Section-scoped raw-string snapshot bind. See config::bind_snapshot.
+            void bind_snapshot(std::string_view key, std::string_view display_name, Snapshot<std::string> &out,
+                               std::string_view default_value) const
+            {
+                config::bind_snapshot(m_section, key, display_name, out, default_value);
+            }
+
             /// Section-scoped log-level bind. See config::bind_log_level.
             void bind_log_level(std::string_view key, std::string_view default_value = "INFO") const
             {
                 config::bind_log_level(m_section, key, default_value);
             }
 
+            /// Section-scoped per-category log-level bind. See config::bind_log_level.
+            void bind_log_level(std::string_view key, LogCategory category, std::string_view default_value = "") const
+            {
+                config::bind_log_level(m_section, key, category, default_value);
+            }
+
+            /// Binds every log category's key in this section. See config::bind_log_categories.
+            void bind_log_categories() const { config::bind_log_categories(m_section); }
+
             /// Section-scoped press-combo fusion. See config::press_combo.
             [[nodiscard]] input::BindingGuard press_combo(std::string_view ini_key, std::string_view log_name,
                                                           std::string_view binding_name, std::function<void()> on_press,
@@ -504,12 +755,28 @@ namespace DetourModKit
                 config::bind_log_level(sec, key, default_value);
             }
 
+            /// Per-category log-level bind. See config::bind_log_level.
+            void bind_log_level(std::string_view sec, std::string_view key, LogCategory category,
+                                std::string_view default_value = "") const
+            {
+                config::bind_log_level(sec, key, category, default_value);
+            }
+
+            /// Binds every log category's key in @p sec. See config::bind_log_categories.
+            void bind_log_categories(std::string_view sec) const { config::bind_log_categories(sec); }
+
             /// Loads the named INI file. See config::load.
             void load(std::string_view ini_filename) const { config::load(ini_filename); }
 
-            /// Re-applies bound setters. See config::reload.
+            /// Re-applies the setters of changed keys. See config::reload.
             [[nodiscard]] bool reload() const { return config::reload(); }
 
+            /// Re-applies changed setters and reports the changed keys. See config::reload.
+            [[nodiscard]] bool reload(std::vector<ConfigKey> &changed_keys) const
+            {
+                return config::reload(changed_keys);
+            }
+
             /// Starts the auto-reload watcher. See config::enable_auto_reload.
             [[nodiscard]] AutoReloadStatus
             enable_auto_reload(std::chrono::milliseconds debounce = std::chrono::milliseconds{250},
@@ -0,0 +1,134 @@
+#ifndef DETOURMODKIT_DEFERRED_HPP
+#define DETOURMODKIT_DEFERRED_HPP
+
+/**
+ * @file deferred.hpp
+ * @brief Module-load-triggered resolution: anchors and hook rows registered against a DLL that is not loaded yet are
+ *        resolved, and the hooks installed, the moment the loader maps it.
+ * @details A table scoped to a late-loaded plugin (`Region::module_named("engine_plugin.dll")`) otherwise has to poll
+ *          memory::is_module_loaded and retry. @ref deferred::on_module_load registers the table once; a loader DLL
+ *          notification (LdrRegisterDllNotification) reports the mapping, and a library-owned worker thread then
+ *          resolves the anchors and installs the hooks against the new image and hands the results to the table's
+ *          callback. A module that is already loaded when the table registers is handled the same way, right away.
+ *
+ *          The notification runs under the loader lock, so it only matches the module name and queues the image span;
+ *          every scan, install and callback runs on the worker, outside the loader lock. The worker therefore may run
+ *          while the module's own DllMain is still running on the loading thread.
+ */
+
+#include "DetourModKit/anchor.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/hook.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace deferred
+    {
+        /**
+         * @struct ModuleLoad
+         * @brief What one deferred table produced when its module mapped, as the table's callback sees it.
+         * @details Every view lives only for the callback. @ref hooks is mutable so the callback can move the hooks it
+         *          keeps into a @ref hook::HookStack (in table order); the hooks still in the outcomes when the
+         *          callback returns are uninstalled, exactly as dropping @ref hook::install_all's vector does.
+         */
+        struct ModuleLoad
+        {
+            /// The module name the table registered with.
+            std::string_view module;
+            /// The mapped image every anchor and hook row was resolved within.
+            Region image;
+            /// One entry per registered anchor, in table order.
+            std::span<const anchor::ResolvedAnchor> anchors;
+            /// One outcome per registered hook row, in table order.
+            std::span<hook::InstallOutcome> hooks;
+            /// @ref hook::install_all's own result: the error of a Mandatory row that failed, otherwise empty.
+            Result<void> install;
+        };
+
+        /// Runs once on the worker thread when the table's module maps.
+        using ModuleLoadCallback = std::move_only_function<void(ModuleLoad &)>;
+
+        /**
+         * @struct DeferredTable
+         * @brief One module's deferred work: the anchors to resolve, the hook rows to install, and who to tell.
+         * @details The anchors are borrowed, as for @ref anchor::resolve_all: the canonical table is static and must
+         *          outlive the registration. Each hook row is re-scoped to the mapped image before it installs (see
+         *          @ref hook::HookSpec::with_scope), so its target's own scope is ignored.
+         */
+        struct DeferredTable
+        {
+            /// Base name of the module, e.g. "engine_plugin.dll"; matched case-insensitively, ".dll" implied.
+            std::string module;
+            /// Anchors resolved within the module image. Borrowed.
+            std::span<const anchor::Anchor> anchors;
+            /// Hook rows installed on the module image once the anchors have resolved.
+            std::vector<hook::HookSpec> hooks;
+            /// Receives the results. Required.
+            ModuleLoadCallback on_load;
+        };
+
+        /**
+         * @class Registration
+         * @brief Keeps one @ref DeferredTable registered; destroying or cancelling it withdraws the table.
+         * @details A table fires at most once, for the first mapping of its module seen after it registered; a later
+         *          unload and reload does not fire it again. Move-only; a moved-from registration is inert.
+         * @note Setup/control-plane only: cancelling waits for the table's callback when the worker is running it,
+         *       except on the worker thread itself (a callback cancelling its own registration) or under the loader
+         *       lock, where it returns at once and the running callback finishes on its own.
+         */
+        class Registration
+        {
+        public:
+            Registration() noexcept = default;
+            ~Registration() noexcept;
+
+            Registration(Registration &&other) noexcept;
+            Registration &operator=(Registration &&other) noexcept;
+            Registration(const Registration &) = delete;
+            Registration &operator=(const Registration &) = delete;
+
+            /// Withdraws the table if it has not fired. Idempotent.
+            void cancel() noexcept;
+
+            /// True while the table is registered and has not fired.
+            [[nodiscard]] bool is_pending() const noexcept;
+
+        private:
+            friend Result<Registration> on_module_load(DeferredTable table) noexcept;
+            explicit Registration(std::uint64_t id) noexcept : m_id(id) {}
+
+            std::uint64_t m_id = 0;
+        };
+
+        /**
+         * @brief Registers @p table to run when its module maps.
+         * @details Subscribes the loader notification and starts the worker on first use. When the module is already
+         *          loaded the table is queued at once, so the callback always runs on the worker, never on the caller.
+         * @return The registration, or Error{InvalidArg} for an empty module name or a missing callback,
+         *         Error{OutOfMemory}, or Error{SystemCallFailed} when the loader notification or the worker cannot be
+         *         set up.
+         */
+        [[nodiscard]] Result<Registration> on_module_load(DeferredTable table) noexcept;
+
+        /// Tables registered and not yet fired.
+        [[nodiscard]] std::size_t pending_count() noexcept;
+
+        /**
+         * @brief Withdraws every table, unsubscribes the loader notification and stops the worker.
+         * @details The session teardown calls this. The worker is joined, or detached under the loader lock (see
+         *          StoppableWorker::shutdown()). The next @ref on_module_load starts over.
+         */
+        void shutdown() noexcept;
+    } // namespace deferred
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_DEFERRED_HPP
@@ -68,6 +68,19 @@ namespace DMK = DetourModKit;
 #define DMK_FORCE_INLINE inline
 #endif
 
+// AddressSanitizer opt-out for deliberate cross-region reads
+// ASan poisons the shadow of this process's own committed, readable memory (the redzones around stack locals and
+// instrumented globals), so the AOB scanner's in-bounds, never-faulting reads across whole regions would be reported
+// as overflows. DMK_NO_SANITIZE_ADDRESS removes the compiler's load instrumentation from a function that reads scanned
+// memory; it does not stop ASan's libc interceptors, which is why those functions never call memchr or memcpy. ASan
+// links only under MSVC here (mingw-w64 ships no sanitizer runtime), so the macro is empty in every other build. It
+// lives here rather than in the engine because the compile-time pattern kernels are instantiated in consumer code.
+#if defined(_MSC_VER) && defined(__SANITIZE_ADDRESS__)
+#define DMK_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
+#else
+#define DMK_NO_SANITIZE_ADDRESS
+#endif
+
 // Flag-enum operator generator
 /**
  * @brief Emits the bitwise `| & ^ ~` and compound `|= &= ^=` operators for a scoped flag enum.
@@ -6,7 +6,8 @@
  * @brief Durable serialization of self-heal drift reports (@ref DetourModKit::rtti::DriftEntry).
  * @details Lets a consumer persist a @ref DetourModKit::rtti::heal_report across game versions and diff the saved
  *          manifests to see which offsets moved between patches, instead of only logging the live telemetry once per
- *          run.
+ *          run. The text manifest is the diff-friendly export; the binary report is the compact form a mod maps
+ *          and reads back at startup with no per-entry parse or allocation.
  * @note This header sits in the detail/ directory for compile visibility: the umbrella includes it. It declares its
  *       types in the rtti namespace because they extend the rtti drift surface; diagnostics.hpp and manifest.hpp name
  *       rtti::DriftEntry / rtti::parse_drift_report directly. Directory placement and namespace placement are
@@ -17,6 +18,8 @@
 #include "DetourModKit/rtti_dissect.hpp"
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <span>
 #include <string>
 #include <string_view>
@@ -94,6 +97,109 @@ namespace DetourModKit
          *         are corrupt. An opened-but-empty file reports MissingHeader.
          */
         [[nodiscard]] Result<std::vector<DriftRecord>> read_drift_report_from_file(const std::string &path);
+
+        /// The binary drift report format version this build reads and writes; DriftReportView::parse rejects others.
+        inline constexpr std::uint32_t DRIFT_BINARY_FORMAT_VERSION = 1;
+
+        /**
+         * @brief Serializes a drift report to the compact binary form @ref DriftReportView reads in place.
+         * @details The text manifest stays the diff-friendly export; the blob is what a mod reloads at startup. A
+         *          fixed header (magic, format version, entry count, pool size, total size, and a checksum of
+         *          everything after it) is followed by one fixed-size record per entry and a string pool holding the
+         *          names. Records refer to their names by pool range, never by pointer, so the blob loads from any
+         *          address. Errors are stored as their ErrorCode value and must be one the text form can carry.
+         * @param entries The drift entries to serialize (e.g. from @ref heal_report).
+         * @return The blob, or an Error: InvalidArg when the report is too large for the format's 32-bit counts and
+         *         offsets, or OutOfMemory.
+         */
+        [[nodiscard]] Result<std::vector<std::byte>> serialize_drift_report_binary(std::span<const DriftEntry> entries);
+
+        /**
+         * @class DriftReportView
+         * @brief A validated, non-owning view of a binary drift report.
+         * @details @ref parse checks the whole blob once -- header, size, checksum, and every record's name range, ok
+         *          flag and error code -- so reading an entry afterwards is a bounds-free copy of one fixed-size record
+         *          whose @c name aliases the blob. Nothing is allocated, either to parse or per entry.
+         * @note The view borrows the blob: keep the bytes (or the @ref MappedDriftReport) alive while it is in use.
+         */
+        class DriftReportView
+        {
+        public:
+            DriftReportView() noexcept = default;
+
+            /**
+             * @brief Validates @p blob and returns a view over it.
+             * @param blob Bytes produced by @ref serialize_drift_report_binary; no alignment is assumed.
+             * @return The view, or an Error: MissingHeader (wrong magic, a format version this build cannot read, or a
+             *         size that disagrees with the header) or MalformedLine (a checksum mismatch, a name outside the
+             *         pool, or an ok flag or error code out of range).
+             */
+            [[nodiscard]] static Result<DriftReportView> parse(std::span<const std::byte> blob) noexcept;
+
+            /// The number of entries.
+            [[nodiscard]] std::size_t size() const noexcept { return m_count; }
+
+            /// True when the report has no entries.
+            [[nodiscard]] bool empty() const noexcept { return m_count == 0; }
+
+            /// Entry @p index (below @ref size); its @c name aliases the blob.
+            [[nodiscard]] DriftEntry operator[](std::size_t index) const noexcept;
+
+        private:
+            DriftReportView(std::span<const std::byte> blob, std::size_t count, std::size_t strings_at) noexcept
+                : m_blob(blob), m_count(count), m_strings_at(strings_at)
+            {
+            }
+
+            std::span<const std::byte> m_blob;
+            std::size_t m_count = 0;
+            // Byte offset of the string pool within m_blob.
+            std::size_t m_strings_at = 0;
+        };
+
+        /**
+         * @brief Writes @ref serialize_drift_report_binary of @p entries to @p path, truncating it.
+         * @return Empty on success, the serialize error, FileOpenFailed, or FileWriteFailed. Like
+         *         @ref write_drift_report_to_file the write is not atomic; a torn file fails the checksum on the next
+         *         @ref MappedDriftReport::open.
+         */
+        [[nodiscard]] Result<void> write_drift_report_binary_to_file(const std::string &path,
+                                                                     std::span<const DriftEntry> entries);
+
+        /**
+         * @class MappedDriftReport
+         * @brief A binary drift report file mapped read-only, with the validated @ref DriftReportView over it.
+         * @details The file is mapped without write sharing, so its bytes cannot change under the view. The only
+         *          allocation is the small owner of the mapping; the entries are read straight from the mapped pages,
+         *          so seeding a heal table from a saved report costs one checksum pass over the file.
+         * @note Move-only. The view and every name it hands out are valid only while this object is alive.
+         */
+        class MappedDriftReport
+        {
+        public:
+            /**
+             * @brief Maps @p path and validates it through @ref DriftReportView::parse.
+             * @param path Source file path (UTF-8).
+             * @return The mapped report, FileOpenFailed (missing, locked, or not a regular file), OutOfMemory, or a
+             *         @ref DriftReportView::parse error. An empty file reports MissingHeader.
+             */
+            [[nodiscard]] static Result<MappedDriftReport> open(const std::string &path) noexcept;
+
+            MappedDriftReport(MappedDriftReport &&) noexcept;
+            MappedDriftReport &operator=(MappedDriftReport &&) noexcept;
+            MappedDriftReport(const MappedDriftReport &) = delete;
+            MappedDriftReport &operator=(const MappedDriftReport &) = delete;
+            ~MappedDriftReport() noexcept;
+
+            /// The validated entries.
+            [[nodiscard]] const DriftReportView &view() const noexcept { return m_view; }
+
+        private:
+            struct Impl;
+            MappedDriftReport(std::unique_ptr<Impl> impl, DriftReportView view) noexcept;
+            std::unique_ptr<Impl> m_impl;
+            DriftReportView m_view;
+        };
     } // namespace rtti
 } // namespace DetourModKit
 
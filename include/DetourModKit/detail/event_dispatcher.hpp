@@ -9,21 +9,21 @@
  *       DetourModKit namespace because installed headers name the type directly. Directory placement and namespace
  *       placement are independent; the directory reflects compile visibility, not privacy.
  *
- * @details Provides a per-event-type pub/sub dispatcher. Subscribers receive events by const reference. Subscriptions
- *          are RAII objects that automatically unsubscribe on destruction.
+ * @details Provides a per-event-type pub/sub dispatcher, and EventBus, which carries a fixed set of event types in one
+ *          object. Subscribers receive events by const reference. Subscriptions are RAII objects that automatically
+ *          unsubscribe on destruction.
  *
  *          **Threading model:**
- *          - `emit()` / `emit_safe()` avoid any `shared_mutex` / reader lock.
- *            The zero-subscriber fast path is wait-free: a single `memory_order_acquire` load of an atomic counter.
- *            When subscribers exist, an atomic acquire-load of a `std::shared_ptr<const std::vector<Entry>>` snapshot
- *            is performed, then the contiguous handler vector is iterated. `std::atomic<std::shared_ptr<T>>` is NOT
- *            lock-free on either shipped toolchain: libstdc++ (MinGW) and the MSVC STL both back it with an
- *            implementation-internal lock table / bit lock, so the snapshot load takes one bounded internal critical
- *            section rather than being lock-free. It still needs no reader lock of ours and no allocation, so it stays
- *            callback-safe; only the zero-subscriber fast path above is genuinely wait-free.
+ *          - `emit()` / `emit_safe()` take no lock and perform no atomic read-modify-write on a line another thread
+ *            writes. The zero-subscriber fast path is one `memory_order_acquire` load of an atomic counter. Otherwise
+ *            the emitting thread announces the current reclamation epoch in its own cache-line-sized reader record,
+ *            loads the raw pointer to the immutable handler vector, iterates it, and clears its record. Once a thread
+ *            has emitted once (its first emit claims a record from a lock-free registry) every emit is wait-free.
  *          - `subscribe()` / manual `unsubscribe()` serialize writers through
- *            a small `std::mutex` and publish a new immutable snapshot via copy-on-write. Mutation paths allocate; see
- *            the `subscribe()`, `unsubscribe()`, and `clear()` method docs for the OOM contract.
+ *            a small `std::mutex` and publish a new immutable snapshot via copy-on-write. The replaced vector is
+ *            retired, not freed: it is deleted by a later writer once every reader record is clear or names a newer
+ *            epoch, so an in-flight emit never loses the vector it iterates. Mutation paths allocate; see the
+ *            `subscribe()`, `unsubscribe()`, and `clear()` method docs for the OOM contract.
  *          - Safe to emit from multiple threads concurrently (e.g., hook callbacks).
  *          - Safe to subscribe/unsubscribe from any thread while the dispatcher is alive. The dispatcher must outlive
  *            every concurrent subscription operation; the Subscription weak_ptr guard only makes an unsubscribe safe
@@ -31,17 +31,23 @@
  *            Subscription lifetime contract.
  *
  *          **Performance characteristics:**
- *          - `emit()`: atomic acquire-load of a `shared_ptr` snapshot, then
- *            linear iteration over the contiguous handler vector. No user-visible mutex acquisition on the hot path.
- *            When there are no subscribers, `emit()` skips the snapshot load entirely via the atomic counter (wait-free
- *            fast path).
+ *          - `emit()`: a store to the thread's own reader record, one
+ *            acquire-ordered pointer load, then linear iteration over the contiguous handler vector. Concurrent
+ *            emitters share only read-only lines, so they scale with the thread count. When there are no subscribers,
+ *            `emit()` skips the snapshot entirely via the atomic counter.
  *          - `subscribe()` / `unsubscribe()`: copy-on-write. Each writer
- *            allocates a new handler vector (O(n) in the current subscriber count), appends or removes an entry, and
- *            publishes it atomically. Typical dispatcher usage is 1-10 subscribers and write-rarely, so the O(n)
- *            publish cost is negligible in practice.
- *          - No heap allocation on the ordinary no-deferral `emit()` path beyond the `shared_ptr` refcount bump.
- *            If a handler unsubscribes from the same dispatcher during emit, the guard may allocate a replacement
- *            snapshot while draining that deferred removal on unwind. Handler vector is cache-friendly.
+ *            allocates a new handler vector (O(n) in the current subscriber count), appends or removes an entry,
+ *            publishes it atomically, and frees whichever retired vectors no reader can still hold. Typical dispatcher
+ *            usage is 1-10 subscribers and write-rarely, so the O(n) publish cost is negligible in practice.
+ *          - `batch()` / `subscribe_many()`: a startup that registers (or a reconfiguration that swaps) many handlers
+ *            stages them in an `EventDispatcher::Batch`, whose `commit()` rebuilds and publishes the vector once for
+ *            the lot instead of once per handler.
+ *          - No heap allocation on the ordinary no-deferral `emit()` path after a thread's first emit. If a handler
+ *            unsubscribes from the same dispatcher during emit, the guard may allocate a replacement snapshot while
+ *            draining that deferred removal on unwind.
+ *          - Each entry holds its callable inline (detail::InlineHandler) rather than behind a `std::function`, so the
+ *            handler vector is one packed array, a capture of up to 48 bytes costs no allocation at subscribe, and a
+ *            call is a single indirect jump.
  *
  *          **Usage:**
  *          @code
@@ -62,12 +68,20 @@
 #include "DetourModKit/logger.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -107,9 +121,11 @@ namespace DetourModKit
         Subscription &operator=(const Subscription &) = delete;
 
         Subscription(Subscription &&other) noexcept
-            : m_alive(std::move(other.m_alive)), m_unsubscribe(std::move(other.m_unsubscribe))
+            : m_alive(std::move(other.m_alive)), m_unsubscribe(std::move(other.m_unsubscribe)), m_id(other.m_id),
+              m_source(other.m_source)
         {
             other.m_unsubscribe = nullptr;
+            other.m_source = nullptr;
         }
 
         Subscription &operator=(Subscription &&other) noexcept
@@ -119,7 +135,10 @@ namespace DetourModKit
                 reset();
                 m_alive = std::move(other.m_alive);
                 m_unsubscribe = std::move(other.m_unsubscribe);
+                m_id = other.m_id;
+                m_source = other.m_source;
                 other.m_unsubscribe = nullptr;
+                other.m_source = nullptr;
             }
             return *this;
         }
@@ -156,6 +175,7 @@ namespace DetourModKit
             }
             m_unsubscribe = nullptr;
             m_alive.reset();
+            m_source = nullptr;
         }
 
         /// Returns true if this subscription is still active.
@@ -163,16 +183,275 @@ namespace DetourModKit
 
     private:
         template <typename E> friend class EventDispatcher;
+        template <typename... Events> friend class EventBus;
+        template <typename Key, typename Event, typename Hash> friend class KeyedEventDispatcher;
 
-        Subscription(std::weak_ptr<void> alive, std::function<bool()> unsub) noexcept
-            : m_alive(std::move(alive)), m_unsubscribe(std::move(unsub))
+        Subscription(std::weak_ptr<void> alive, std::function<bool()> unsub, SubscriptionId id = {},
+                     const void *source = nullptr) noexcept
+            : m_alive(std::move(alive)), m_unsubscribe(std::move(unsub)), m_id(id), m_source(source)
         {
         }
 
         std::weak_ptr<void> m_alive;
         std::function<bool()> m_unsubscribe;
+        // Which EventDispatcher minted this guard and under what id, so EventDispatcher::Batch can fold its removal
+        // into one snapshot rebuild. Null for guards minted elsewhere (EventBus, KeyedEventDispatcher).
+        SubscriptionId m_id{};
+        const void *m_source{nullptr};
     };
 
+    namespace detail
+    {
+        /**
+         * @brief Announces that the calling thread is entering an emit, so no snapshot it may load is freed until
+         *        the matching leave_emit_epoch().
+         * @details Shared by every EventDispatcher instantiation, so a handler emitting on a dispatcher of another
+         *          Event type nests inside the outer announcement instead of clearing it. Only the outermost call
+         *          writes: it stores the current epoch into the thread's own reader record (claimed on the thread's
+         *          first emit and handed back when it exits) with sequential consistency, so a writer scanning the
+         *          records after publishing a replacement either sees this announcement or this thread sees the
+         *          replacement. If no record can be allocated the thread falls back to a process-wide counter that
+         *          holds back every reclamation while it is emitting.
+         */
+        void enter_emit_epoch() noexcept;
+
+        /// Ends the calling thread's enter_emit_epoch(); the outermost call clears its reader record.
+        void leave_emit_epoch() noexcept;
+
+        /// Advances the reclamation epoch and returns the new value, under which a just-replaced snapshot is retired.
+        [[nodiscard]] std::uint64_t advance_emit_epoch() noexcept;
+
+        /**
+         * @brief The oldest epoch any thread inside an emit announced: a snapshot retired at an epoch no greater than
+         *        this is unreachable and may be freed.
+         * @return The oldest announced epoch, UINT64_MAX when no thread is emitting, or 0 while a thread that could
+         *         not get a reader record is emitting.
+         */
+        [[nodiscard]] std::uint64_t oldest_emit_epoch() noexcept;
+
+        template <typename T> inline constexpr bool is_std_function_v = false;
+        template <typename Signature> inline constexpr bool is_std_function_v<std::function<Signature>> = true;
+
+        /**
+         * @brief Type-erased, copyable handler with inline storage: the callable EventDispatcher keeps per entry.
+         * @details A callable of at most INLINE_CAPACITY bytes, pointer alignment and a noexcept move is constructed
+         *          in place, so subscribing it never allocates; a larger one is boxed on the heap behind the same
+         *          interface. A call is one indirect jump through a thunk specialised for the stored type, with no
+         *          further indirection for an inline callable. Sized so the whole object is one cache line.
+         *
+         *          The callable takes either one event or a `std::span<const Event>` batch; the per-event form is
+         *          preferred when both fit. call_batch() runs a per-event callable once per element, and hands a
+         *          batch-aware one the whole span, which operator() wraps as a span of one.
+         */
+        template <typename Event> class InlineHandler
+        {
+        public:
+            static constexpr std::size_t INLINE_CAPACITY = 48;
+
+            template <typename F> static constexpr bool stored_inline_v =
+                sizeof(F) <= INLINE_CAPACITY && alignof(F) <= alignof(void *) &&
+                std::is_nothrow_move_constructible_v<F>;
+
+            template <typename F>
+            static constexpr bool batch_only_v =
+                !std::invocable<F &, const Event &> && std::invocable<F &, std::span<const Event>>;
+
+            template <typename F>
+                requires(!std::same_as<std::decay_t<F>, InlineHandler>)
+            explicit InlineHandler(F &&callable)
+            {
+                using Stored = std::decay_t<F>;
+                if constexpr (stored_inline_v<Stored>)
+                {
+                    ::new (static_cast<void *>(m_storage)) Stored(std::forward<F>(callable));
+                    m_invoke = [](void *storage, const Event &event) { call_one(*as<Stored>(storage), event); };
+                    m_ops = &INLINE_OPS<Stored>;
+                }
+                else
+                {
+                    ::new (static_cast<void *>(m_storage)) Stored *(new Stored(std::forward<F>(callable)));
+                    m_invoke = [](void *storage, const Event &event) { call_one(**as<Stored *>(storage), event); };
+                    m_ops = &BOXED_OPS<Stored>;
+                }
+            }
+
+            InlineHandler(const InlineHandler &other) : m_invoke(other.m_invoke)
+            {
+                other.m_ops->copy(m_storage, other.m_storage);
+                m_ops = other.m_ops;
+            }
+
+            InlineHandler(InlineHandler &&other) noexcept : m_invoke(other.m_invoke), m_ops(other.m_ops)
+            {
+                m_ops->move(m_storage, other.m_storage);
+                other.m_ops = nullptr;
+            }
+
+            InlineHandler &operator=(const InlineHandler &) = delete;
+            InlineHandler &operator=(InlineHandler &&) = delete;
+
+            ~InlineHandler()
+            {
+                if (m_ops != nullptr)
+                {
+                    m_ops->destroy(m_storage);
+                }
+            }
+
+            void operator()(const Event &event) const { m_invoke(m_storage, event); }
+
+            /// Runs the callable over @p events: once per element, or once with the span for a batch-aware one.
+            void call_batch(std::span<const Event> events) const { m_ops->invoke_batch(m_storage, events); }
+
+        private:
+            struct Ops
+            {
+                void (*copy)(void *destination, const void *source);
+                void (*move)(void *destination, void *source) noexcept;
+                void (*destroy)(void *storage) noexcept;
+                // Kept here rather than beside m_invoke so the handler stays one cache line; a batch pays the extra
+                // load once.
+                void (*invoke_batch)(void *storage, std::span<const Event> events);
+            };
+
+            template <typename Stored> static void call_one(Stored &callable, const Event &event)
+            {
+                if constexpr (batch_only_v<Stored>)
+                {
+                    std::invoke(callable, std::span<const Event>{&event, 1});
+                }
+                else
+                {
+                    std::invoke(callable, event);
+                }
+            }
+
+            template <typename Stored> static void call_many(Stored &callable, std::span<const Event> events)
+            {
+                if constexpr (batch_only_v<Stored>)
+                {
+                    std::invoke(callable, events);
+                }
+                else
+                {
+                    for (const Event &event : events)
+                    {
+                        std::invoke(callable, event);
+                    }
+                }
+            }
+
+            template <typename T> [[nodiscard]] static T *as(void *storage) noexcept
+            {
+                return std::launder(static_cast<T *>(storage));
+            }
+
+            template <typename T> [[nodiscard]] static const T *as(const void *storage) noexcept
+            {
+                return std::launder(static_cast<const T *>(storage));
+            }
+
+            template <typename Stored>
+            static constexpr Ops INLINE_OPS{
+                [](void *destination, const void *source)
+                { ::new (destination) Stored(*as<Stored>(source)); },
+                [](void *destination, void *source) noexcept
+                {
+                    ::new (destination) Stored(std::move(*as<Stored>(source)));
+                    as<Stored>(source)->~Stored();
+                },
+                [](void *storage) noexcept { as<Stored>(storage)->~Stored(); },
+                [](void *storage, std::span<const Event> events) { call_many(*as<Stored>(storage), events); }};
+
+            // A boxed callable's storage holds only the owning pointer, so a move steals it and a copy deep-copies.
+            template <typename Stored>
+            static constexpr Ops BOXED_OPS{
+                [](void *destination, const void *source)
+                { ::new (destination) Stored *(new Stored(**as<Stored *>(source))); },
+                [](void *destination, void *source) noexcept
+                { ::new (destination) Stored *(*as<Stored *>(source)); },
+                [](void *storage) noexcept { delete *as<Stored *>(storage); },
+                [](void *storage, std::span<const Event> events) { call_many(**as<Stored *>(storage), events); }};
+
+            void (*m_invoke)(void *storage, const Event &event){nullptr};
+            const Ops *m_ops{nullptr};
+            // mutable: a handler may be a mutable lambda, invoked through the const snapshot as std::function allowed.
+            alignas(void *) mutable std::byte m_storage[INLINE_CAPACITY];
+        };
+
+        /**
+         * @brief The snapshots a copy-on-write publisher has replaced but not yet freed, each with the epoch it was
+         *        retired under.
+         * @details Not synchronized: the owner guards it with its writer mutex. reserve_one() is the only call that
+         *          can throw, so a writer makes it before publishing and retire() then cannot fail. Whatever is still
+         *          retired is freed on destruction, when no emit may be in flight.
+         */
+        template <typename Snapshot> class RetiredSnapshots
+        {
+        public:
+            RetiredSnapshots() = default;
+            RetiredSnapshots(const RetiredSnapshots &) = delete;
+            RetiredSnapshots &operator=(const RetiredSnapshots &) = delete;
+
+            ~RetiredSnapshots()
+            {
+                for (const Retired &retired : m_retired)
+                {
+                    delete retired.snapshot;
+                }
+            }
+
+            /// Makes room for the next retire().
+            void reserve_one() { m_retired.reserve(m_retired.size() + 1); }
+
+            /**
+             * @brief Retires @p previous, just replaced by a seq_cst publish, then frees every retired snapshot no
+             *        emit can still be iterating.
+             * @details The epoch advance and the reader-record scan that follow the publish are seq_cst as well: an
+             *          emit whose announcement the scan misses is ordered after the publish and loads the new
+             *          snapshot, while one that loaded @p previous announced an epoch older than the one it is retired
+             *          under, and holds it back.
+             */
+            void retire(const Snapshot *previous) noexcept
+            {
+                m_retired.push_back(Retired{advance_emit_epoch(), previous});
+                const std::uint64_t oldest = oldest_emit_epoch();
+                std::erase_if(m_retired,
+                              [oldest](const Retired &retired)
+                              {
+                                  if (retired.epoch > oldest)
+                                  {
+                                      return false;
+                                  }
+                                  delete retired.snapshot;
+                                  return true;
+                              });
+            }
+
+            [[nodiscard]] std::size_t size() const noexcept { return m_retired.size(); }
+
+        private:
+            struct Retired
+            {
+                std::uint64_t epoch;
+                const Snapshot *snapshot;
+            };
+
+            std::vector<Retired> m_retired;
+        };
+
+        /// RAII pairing of enter_emit_epoch() and leave_emit_epoch() around one emit.
+        class EmitEpochScope
+        {
+        public:
+            EmitEpochScope() noexcept { enter_emit_epoch(); }
+            ~EmitEpochScope() noexcept { leave_emit_epoch(); }
+
+            EmitEpochScope(const EmitEpochScope &) = delete;
+            EmitEpochScope &operator=(const EmitEpochScope &) = delete;
+        };
+    } // namespace detail
+
     /**
      * @brief Thread-safe typed event dispatcher with RAII subscription management.
      *
@@ -189,18 +468,20 @@ namespace DetourModKit
      *          @endcode
      *
      * **Thread safety:**
-     * - `emit()` / `emit_safe()`: the zero-subscriber fast path is wait-free
-     *   (single atomic counter load). Otherwise acquires a `shared_ptr` snapshot of the immutable handler list and
-     *   iterates it. `std::atomic<std::shared_ptr<T>>` is NOT lock-free on either shipped toolchain (libstdc++
-     *   on MinGW and the MSVC STL both back it with an implementation-internal lock), so the snapshot load takes
-     *   one bounded internal critical section rather than being lock-free. It takes no reader lock of ours and no
-     *   allocation, so it stays callback-safe.
+     * - `emit()` / `emit_safe()`: wait-free after the calling thread's first emit. The
+     *   zero-subscriber fast path is a single atomic counter load; otherwise the thread announces itself in its own
+     *   reader record (detail::EmitEpochScope), loads the raw snapshot pointer and iterates the immutable handler
+     *   list. No lock, no allocation and no read-modify-write on a shared cache line, so it stays callback-safe and
+     *   concurrent emitters do not contend.
      * - `subscribe()` / `unsubscribe()`: copy-on-write under a small writer
-     *   mutex. Each mutation allocates a new handler vector, appends or removes the entry, and publishes the new
-     *   snapshot atomically. See the method docs for the OOM contract.
-     * - Handlers are invoked while the snapshot's `shared_ptr` keeps the
-     *   vector alive. A thread-local reentrancy guard rejects subscribe calls from within a same-type handler and
-     *   defers unsubscribe calls only when this exact dispatcher is on the current thread's emit stack.
+     *   mutex. Each mutation allocates a new handler vector, appends or removes the entry, publishes the new
+     *   snapshot atomically and retires the old one. See the method docs for the OOM contract. A Batch folds many
+     *   mutations into one such publish.
+     * - Handlers are invoked while the thread's announced epoch keeps the
+     *   vector alive: a retired vector is freed only by a writer that finds no reader announced at or before its
+     *   retirement epoch, or by the destructor. A thread-local reentrancy guard rejects subscribe calls from within
+     *   a same-type handler and defers unsubscribe calls only when this exact dispatcher is on the current thread's
+     *   emit stack.
      *
      * **Reentrancy guard scope:** The guard is per-template-instantiation, not per-instance. Two dispatchers of the
      * same Event type share the same thread-local counter. Subscribing to a second dispatcher of the same type from
@@ -216,7 +497,7 @@ namespace DetourModKit
     template <typename Event> class EventDispatcher
     {
     public:
-        /// Handler function signature: receives the event by const reference.
+        /// A std::function handler, still accepted by subscribe(); any copyable callable taking the event works too.
         using Handler = std::function<void(const Event &)>;
 
     private:
@@ -225,7 +506,7 @@ namespace DetourModKit
         struct Entry
         {
             SubscriptionId id;
-            Handler callback;
+            detail::InlineHandler<Event> callback;
         };
 
         struct EmitStackNode
@@ -235,12 +516,63 @@ namespace DetourModKit
         };
 
         using HandlerList = std::vector<Entry>;
-        using SharedList = std::shared_ptr<const HandlerList>;
+
+        /**
+         * @brief One deferred-queue cell.
+         * @details sequence == position: free for that position's producer; position + 1: holds its event; the
+         *          consumer hands it to position + capacity once the event is dispatched and destroyed.
+         */
+        struct DeferredSlot
+        {
+            std::atomic<size_t> sequence;
+            alignas(Event) std::byte storage[sizeof(Event)];
+        };
 
     public:
-        EventDispatcher() : m_handlers(std::make_shared<const HandlerList>()), m_alive(std::make_shared<char>('\0')) {}
+        EventDispatcher() : m_handlers(new HandlerList()), m_alive(std::make_shared<char>('\0')) {}
+
+        /**
+         * @brief Constructs a dispatcher with a deferred queue of @p deferred_capacity events (rounded up to a power of
+         *        2, at least 2) for emit_deferred() / drain().
+         * @details The queue is allocated here, so a deferred emit never allocates. 0 gives no queue, the same as the
+         *          default constructor: every emit_deferred() is then rejected.
+         */
+        explicit EventDispatcher(size_t deferred_capacity) : EventDispatcher()
+        {
+            if (deferred_capacity == 0)
+            {
+                return;
+            }
+            const size_t capacity = std::bit_ceil(std::max<size_t>(deferred_capacity, 2));
+            this->m_deferred_slots = std::make_unique<DeferredSlot[]>(capacity);
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                this->m_deferred_slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            this->m_deferred_mask = capacity - 1;
+        }
 
-        ~EventDispatcher() noexcept = default;
+        /**
+         * @brief Frees the current and every retired snapshot, and destroys any events still queued.
+         * @details No emit or drain may be in flight.
+         */
+        ~EventDispatcher() noexcept
+        {
+            if (this->m_deferred_slots)
+            {
+                const size_t end = this->m_enqueue_position.load(std::memory_order_acquire);
+                for (size_t position = this->m_dequeue_position.load(std::memory_order_relaxed); position != end;
+                     ++position)
+                {
+                    DeferredSlot &slot = this->m_deferred_slots[position & this->m_deferred_mask];
+                    if (slot.sequence.load(std::memory_order_acquire) == position + 1)
+                    {
+                        deferred_event(slot)->~Event();
+                    }
+                }
+            }
+            delete this->m_handlers.load(std::memory_order_relaxed);
+        }
 
         EventDispatcher(const EventDispatcher &) = delete;
         EventDispatcher &operator=(const EventDispatcher &) = delete;
@@ -249,8 +581,12 @@ namespace DetourModKit
 
         /**
          * @brief Subscribes a handler to this event type.
-         * @param handler Callable invoked on each emit(). Must be safe to call from any thread. An empty handler is
-         *                rejected (see @return).
+         * @param handler Copyable callable invoked on each emit(). Must be safe to call from any thread. A callable
+         *                of up to detail::InlineHandler::INLINE_CAPACITY bytes is stored inside the handler list
+         *                without an allocation of its own; a larger one is boxed. An empty std::function or null
+         *                function pointer is rejected (see @return). A batch-aware callable taking
+         *                `std::span<const Event>` instead receives emit_batch()'s whole span, and a span of one
+         *                from emit().
          * @return RAII Subscription guard. The handler is removed when the guard is destroyed or reset(). An EMPTY
          *         handler, or a call made from within a same-type handler (reentrancy), yields an INACTIVE Subscription
          *         (active() == false) rather than throwing; test active() when either is possible.
@@ -258,9 +594,19 @@ namespace DetourModKit
          *       Acceptable for the expected mutation rate (startup and occasional reconfiguration). Do not call from
          *       within a handler.
          */
-        [[nodiscard]] Subscription subscribe(Handler handler)
+        template <typename F>
+            requires(std::invocable<std::decay_t<F> &, const Event &> ||
+                     std::invocable<std::decay_t<F> &, std::span<const Event>>) &&
+                    std::copy_constructible<std::decay_t<F>>
+        [[nodiscard]] Subscription subscribe(F &&handler)
         {
-            if (!handler)
+            using Stored = std::decay_t<F>;
+            bool empty_handler = false;
+            if constexpr (std::is_pointer_v<Stored> || detail::is_std_function_v<Stored>)
+            {
+                empty_handler = handler == nullptr;
+            }
+            if (empty_handler)
             {
                 // An empty std::function target would be published into the snapshot and then throw
                 // std::bad_function_call the first time emit() invoked it -- or be silently swallowed by emit_safe()
@@ -282,32 +628,182 @@ namespace DetourModKit
                 return {};
             }
 
+            // Erased before the lock so boxing an oversized callable allocates outside the writer critical section.
+            detail::InlineHandler<Event> callback{std::forward<F>(handler)};
             const auto id = static_cast<SubscriptionId>(this->m_next_id.fetch_add(1, std::memory_order_relaxed));
 
             {
                 std::scoped_lock lock{this->m_writer_mutex};
-                auto current = this->m_handlers.load(std::memory_order_acquire);
-                auto next = std::make_shared<HandlerList>(*current);
-                next->push_back(Entry{id, std::move(handler)});
+                const HandlerList *current = this->m_handlers.load(std::memory_order_acquire);
+                auto next = std::make_unique<HandlerList>(*current);
+                next->push_back(Entry{id, std::move(callback)});
+                this->m_retired.reserve_one();
                 // Publish the new count first so a reader that sees 0 on the counter and skips the snapshot load cannot
                 // miss a handler that has already been installed in the snapshot.
                 this->m_handler_count.store(next->size(), std::memory_order_release);
-                this->m_handlers.store(std::shared_ptr<const HandlerList>(std::move(next)), std::memory_order_release);
+                this->publish_locked(next.release());
             }
 
-            std::weak_ptr<void> weak = this->m_alive;
-            return Subscription(std::move(weak), [this, id]() noexcept -> bool { return this->unsubscribe(id); });
+            return this->make_subscription(id);
+        }
+
+        /**
+         * @brief Stages subscribes and unsubscribes against one dispatcher and publishes them as one snapshot.
+         * @details subscribe() and unsubscribe() each copy the handler list and publish (and retire) a snapshot, so
+         *          registering N handlers one by one costs N copies of a growing list. A batch stages its adds and
+         *          removals instead; commit() builds one replacement from the current list under the writer mutex,
+         *          folds in any removals this dispatcher has deferred mid-emit and not yet drained, and publishes once.
+         *          Staging takes no lock, so another writer may run between staging and commit(); commit() works from
+         *          whatever list is current then.
+         *
+         *          Not thread-safe: one thread owns a batch. Obtain it from batch(); it must not outlive the
+         *          dispatcher. Dropping a batch without commit() discards its staged adds (none was ever published) and
+         *          unsubscribes its staged removals one by one, as their guards would have.
+         */
+        class Batch
+        {
+        public:
+            ~Batch() noexcept = default;
+
+            Batch(const Batch &) = delete;
+            Batch &operator=(const Batch &) = delete;
+            Batch(Batch &&) = delete;
+            Batch &operator=(Batch &&) = delete;
+
+            /**
+             * @brief Stages @p handler, with the same requirements as EventDispatcher::subscribe().
+             * @return The position of the handler's Subscription in commit()'s result. An empty handler keeps its
+             *         position but yields an inactive Subscription there.
+             * @throws std::bad_alloc when the staging list or a boxed callable cannot be allocated; nothing staged
+             *         earlier is lost.
+             */
+            template <typename F>
+                requires(std::invocable<std::decay_t<F> &, const Event &> ||
+                         std::invocable<std::decay_t<F> &, std::span<const Event>>) &&
+                        std::copy_constructible<std::decay_t<F>>
+            size_t subscribe(F &&handler)
+            {
+                using Stored = std::decay_t<F>;
+                bool empty_handler = false;
+                if constexpr (std::is_pointer_v<Stored> || detail::is_std_function_v<Stored>)
+                {
+                    empty_handler = handler == nullptr;
+                }
+                this->m_adds.reserve(this->m_adds.size() + 1);
+                if (empty_handler)
+                {
+                    report_empty_handler_rejection();
+                    this->m_adds.emplace_back(std::nullopt);
+                }
+                else
+                {
+                    const auto id =
+                        static_cast<SubscriptionId>(this->m_owner->m_next_id.fetch_add(1, std::memory_order_relaxed));
+                    this->m_adds.emplace_back(Entry{id, detail::InlineHandler<Event>{std::forward<F>(handler)}});
+                }
+                return this->m_adds.size() - 1;
+            }
+
+            /**
+             * @brief Stages the removal of @p subscription, taking it over.
+             * @details A guard minted by another dispatcher, or an inactive one, is reset on the spot instead.
+             * @throws std::bad_alloc when the staging list cannot grow; @p subscription is then left untouched.
+             */
+            void unsubscribe(Subscription &&subscription)
+            {
+                if (subscription.m_source != this->m_owner || !subscription.active())
+                {
+                    subscription.reset();
+                    return;
+                }
+                this->m_removals.push_back(std::move(subscription));
+            }
+
+            /// Handlers and removals staged since the last commit().
+            [[nodiscard]] size_t staged() const noexcept { return this->m_adds.size() + this->m_removals.size(); }
+
+            /**
+             * @brief Publishes every staged change as one snapshot and returns the new handlers' Subscriptions, in
+             *        staging order.
+             * @details Called from within a same-type handler it is rejected like subscribe(): every returned
+             *          Subscription is inactive and the staged removals go through the ordinary (deferred)
+             *          unsubscribe. Either way the batch is empty afterwards and can be reused.
+             * @throws std::bad_alloc when the replacement list cannot be built. The dispatcher is then unchanged and
+             *         the staged changes stay in the batch, so commit() can be retried.
+             */
+            [[nodiscard]] std::vector<Subscription> commit()
+            {
+                std::vector<Subscription> live(this->m_adds.size());
+                if (this->staged() == 0)
+                {
+                    return live;
+                }
+                if (this->m_owner->emitting_depth() > 0)
+                {
+                    report_reentrant_rejection("batch commit");
+                    this->m_adds.clear();
+                    this->m_removals.clear();
+                    return live;
+                }
+                // The guards are built before the lock: a failure here, or under it, destroys them, and each one's
+                // idempotent unsubscribe must be free to take the writer mutex.
+                for (size_t i = 0; i < this->m_adds.size(); ++i)
+                {
+                    if (this->m_adds[i])
+                    {
+                        live[i] = this->m_owner->make_subscription(this->m_adds[i]->id);
+                    }
+                }
+                this->m_owner->publish_batch(this->m_adds, this->m_removals);
+                // Published: the removed entries are gone, so their guards are disarmed rather than reset.
+                for (Subscription &removed : this->m_removals)
+                {
+                    removed.m_unsubscribe = nullptr;
+                    removed.m_alive.reset();
+                    removed.m_source = nullptr;
+                }
+                this->m_adds.clear();
+                this->m_removals.clear();
+                return live;
+            }
+
+        private:
+            friend class EventDispatcher;
+
+            explicit Batch(EventDispatcher &owner) noexcept : m_owner(&owner) {}
+
+            EventDispatcher *m_owner;
+            // nullopt marks an empty handler rejected at staging; it keeps its position in commit()'s result.
+            std::vector<std::optional<Entry>> m_adds;
+            std::vector<Subscription> m_removals;
+        };
+
+        /// Opens a Batch on this dispatcher.
+        [[nodiscard]] Batch batch() noexcept { return Batch{*this}; }
+
+        /**
+         * @brief Subscribes every handler in one snapshot publish, as one Batch would.
+         * @return One Subscription per handler, in argument order; see Batch::commit() for the inactive cases.
+         */
+        template <typename... F>
+            requires(sizeof...(F) > 0)
+        [[nodiscard]] std::array<Subscription, sizeof...(F)> subscribe_many(F &&...handlers)
+        {
+            Batch staged = this->batch();
+            (staged.subscribe(std::forward<F>(handlers)), ...);
+            std::vector<Subscription> live = staged.commit();
+            std::array<Subscription, sizeof...(F)> out;
+            std::move(live.begin(), live.end(), out.begin());
+            return out;
         }
 
         /**
          * @brief Emits an event to all subscribers.
          * @param event The event payload, passed by const reference to each handler.
-         * @note No user-visible mutex on the read path: performs one atomic acquire-load of the snapshot
-         *       pointer and iterates. Multiple threads may emit concurrently; the snapshot load takes one bounded
-         *       internal critical section rather than a user-visible lock (std::atomic<std::shared_ptr> is not
-         *       lock-free on either shipped toolchain -- see the class Threading model), so only the zero-subscriber
-         *       fast path is genuinely wait-free. Handlers are invoked synchronously in subscription order. Exceptions
-         *       thrown by handlers propagate to the caller.
+         * @note Wait-free after the calling thread's first emit: announces the thread in its own reader record,
+         *       loads the snapshot pointer and iterates. Multiple threads may emit concurrently without contending on
+         *       any shared cache line. Handlers are invoked synchronously in subscription order. Exceptions thrown by
+         *       handlers propagate to the caller.
          * @warning If calling from a game hook callback or any context where an unhandled exception would crash the
          *          host process, use emit_safe() instead. emit() lets handler exceptions propagate uncaught, which will
          *          terminate the process if no catch frame exists above the call site.
@@ -320,7 +816,11 @@ namespace DetourModKit
                 return;
             }
 
-            SharedList snap = this->m_handlers.load(std::memory_order_acquire);
+            // The announcement must be in place before the pointer load: a writer that publishes after it is ordered
+            // before the load sees it when deciding what to free (both sides are seq_cst, see publish_locked). The
+            // epoch scope outlives the emit guard, so a drain on unwind still runs under the announcement.
+            detail::EmitEpochScope epoch;
+            const HandlerList *snap = this->m_handlers.load(std::memory_order_seq_cst);
             EmitGuard guard{*this, emitting_depth()};
             for (const auto &entry : *snap)
             {
@@ -342,9 +842,10 @@ namespace DetourModKit
                 return;
             }
 
-            // std::shared_ptr copy-construction and load are noexcept, so the entire function remains noexcept despite
-            // the per-handler catch.
-            SharedList snap = this->m_handlers.load(std::memory_order_acquire);
+            // The epoch scope and the pointer load are noexcept, so the entire function remains noexcept despite the
+            // per-handler catch.
+            detail::EmitEpochScope epoch;
+            const HandlerList *snap = this->m_handlers.load(std::memory_order_seq_cst);
             EmitGuard guard{*this, emitting_depth()};
             for (const auto &entry : *snap)
             {
@@ -369,6 +870,164 @@ namespace DetourModKit
             }
         }
 
+        /**
+         * @brief Emits every event of @p events to every subscriber, paying the count check, snapshot load and
+         *        reentrancy guard once for the whole batch.
+         * @details Handler-major: the first subscriber sees the whole span, in order, before the second sees any of
+         *          it. A per-event handler is called once per element; a batch-aware one is called once with the span.
+         *          An unsubscribe made by a handler takes effect when the batch unwinds, as with emit(), so a handler
+         *          removed mid-batch by an earlier one still sees the batch. Exceptions propagate, abandoning the rest
+         *          of the batch.
+         */
+        void emit_batch(std::span<const Event> events) const
+        {
+            if (events.empty() || this->m_handler_count.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const HandlerList *snap = this->m_handlers.load(std::memory_order_seq_cst);
+            EmitGuard guard{*this, emitting_depth()};
+            for (const auto &entry : *snap)
+            {
+                entry.callback.call_batch(events);
+            }
+        }
+
+        /**
+         * @brief emit_batch(), with handler exceptions contained and reported as in emit_safe().
+         * @details A throw abandons the rest of the span for that handler only; the remaining handlers still receive
+         *          the whole batch.
+         */
+        void emit_batch_safe(std::span<const Event> events) const noexcept
+        {
+            if (events.empty() || this->m_handler_count.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const HandlerList *snap = this->m_handlers.load(std::memory_order_seq_cst);
+            EmitGuard guard{*this, emitting_depth()};
+            for (const auto &entry : *snap)
+            {
+                try
+                {
+                    entry.callback.call_batch(events);
+                }
+                catch (const std::exception &ex)
+                {
+                    report_handler_exception(ex.what());
+                }
+                catch (...)
+                {
+                    report_handler_exception(nullptr);
+                }
+            }
+        }
+
+        /**
+         * @brief Queues @p event for the next drain() instead of running the handlers on this thread.
+         * @details For hook threads that must hand work to the game or main thread: the cost here is one claim on the
+         *          bounded multi-producer queue (a CAS on its enqueue position) and a move of the event into its slot,
+         *          with no lock, no allocation and no handler work. Any number of threads may call it concurrently.
+         * @return false, and the event is dropped (counted in deferred_dropped()), when the queue is full or the
+         *         dispatcher was built without one.
+         */
+        bool emit_deferred(Event event) noexcept
+            requires std::is_nothrow_move_constructible_v<Event>
+        {
+            if (!this->m_deferred_slots)
+            {
+                this->m_deferred_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            size_t position = this->m_enqueue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                DeferredSlot &slot = this->m_deferred_slots[position & this->m_deferred_mask];
+                const size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+                if (lag == 0)
+                {
+                    if (this->m_enqueue_position.compare_exchange_weak(position, position + 1,
+                                                                       std::memory_order_relaxed))
+                    {
+                        ::new (static_cast<void *>(slot.storage)) Event(std::move(event));
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (lag < 0)
+                {
+                    // The consumer has not yet freed this slot from the previous lap: the queue is full.
+                    this->m_deferred_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                else
+                {
+                    position = this->m_enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Dispatches up to @p max_events queued events, oldest first, on the calling thread.
+         * @details Each event is dispatched as its own emit_safe(): handler exceptions are contained and reported, and
+         *          an unsubscribe made by a handler is completed before the next event, so a removed handler does not
+         *          see the rest of the batch. Stops early at a slot a producer has claimed but not yet filled. Meant
+         *          for one consumer (typically once per frame); concurrent drain() calls serialize. A drain() from
+         *          within a same-type handler is rejected like a reentrant subscribe() and returns 0.
+         * @return The number of events dispatched.
+         */
+        size_t drain(size_t max_events = SIZE_MAX) noexcept
+        {
+            if (!this->m_deferred_slots || max_events == 0)
+            {
+                return 0;
+            }
+            if (emitting_depth() > 0)
+            {
+                report_reentrant_rejection("drain");
+                return 0;
+            }
+
+            std::scoped_lock lock{this->m_drain_mutex};
+            size_t dispatched = 0;
+            while (dispatched < max_events)
+            {
+                const size_t position = this->m_dequeue_position.load(std::memory_order_relaxed);
+                DeferredSlot &slot = this->m_deferred_slots[position & this->m_deferred_mask];
+                if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+                {
+                    break;
+                }
+                Event *event = deferred_event(slot);
+                this->emit_safe(*event);
+                event->~Event();
+                this->m_dequeue_position.store(position + 1, std::memory_order_release);
+                slot.sequence.store(position + this->m_deferred_mask + 1, std::memory_order_release);
+                ++dispatched;
+            }
+            return dispatched;
+        }
+
+        /// Events queued by emit_deferred() and not yet drained; approximate while producers or the consumer run.
+        [[nodiscard]] size_t deferred_pending() const noexcept
+        {
+            // Dequeue first: the enqueue cursor read after it can only be further along, so the difference never
+            // underflows.
+            const size_t dequeued = this->m_dequeue_position.load(std::memory_order_acquire);
+            return this->m_enqueue_position.load(std::memory_order_acquire) - dequeued;
+        }
+
+        /// Events emit_deferred() dropped because the queue was full or absent.
+        [[nodiscard]] uint64_t deferred_dropped() const noexcept
+        {
+            return this->m_deferred_dropped.load(std::memory_order_relaxed);
+        }
+
         /// Returns the number of active subscribers.
         [[nodiscard]] size_t subscriber_count() const noexcept
         {
@@ -381,8 +1040,8 @@ namespace DetourModKit
         /**
          * @brief Removes all subscribers.
          * @note Serializes with other writers via the writer mutex; readers in flight keep their snapshot alive through
-         *       their shared_ptr. Allocates a fresh empty snapshot. On allocation failure the dispatcher state is left
-         *       unchanged (best-effort no-op) so the noexcept contract is never violated by a throwing allocator.
+         *       their announced epoch. Allocates a fresh empty snapshot. On allocation failure the dispatcher state is
+         *       left unchanged (best-effort no-op) so the noexcept contract is never violated by a throwing allocator.
          */
         void clear() noexcept
         {
@@ -390,10 +1049,11 @@ namespace DetourModKit
             // Build the replacement snapshot before touching any published state so a throwing allocator leaves
             // m_handlers / m_handler_count in their prior consistent pair. Swallowing bad_alloc keeps clear() a
             // noexcept best-effort teardown.
-            std::shared_ptr<const HandlerList> empty_snap;
+            std::unique_ptr<HandlerList> empty_snap;
             try
             {
-                empty_snap = std::make_shared<const HandlerList>();
+                empty_snap = std::make_unique<HandlerList>();
+                this->m_retired.reserve_one();
             }
             catch (...)
             {
@@ -402,44 +1062,97 @@ namespace DetourModKit
             // Counter must go to 0 before publishing the empty snapshot so an emit that reads 0 on the fast-path
             // counter cannot still see the non-empty old snapshot afterwards.
             this->m_handler_count.store(0, std::memory_order_release);
-            this->m_handlers.store(std::move(empty_snap), std::memory_order_release);
+            this->publish_locked(empty_snap.release());
         }
 
 #if defined(DMK_EVENT_DISPATCHER_INTERNAL_TESTING)
         /**
-         * @brief Test-only diagnostic: returns the number of outstanding references to the current handler snapshot,
-         *        excluding the temporary this call itself creates. A value of 1 means the dispatcher's own atomic is
-         *        the sole holder (steady state). A value >1 indicates an in-flight emit or a leaked snapshot reference.
-         *        Enabled only when
-         *        DMK_EVENT_DISPATCHER_INTERNAL_TESTING is defined by the test translation unit. Not part of the public
-         *        API.
+         * @brief Test-only diagnostic: returns the number of replaced snapshots not yet freed. 0 is the steady state
+         *        once no emit is in flight and a writer has run since; a larger value that survives the next write with
+         *        no emit in flight is a leaked snapshot. Enabled only when DMK_EVENT_DISPATCHER_INTERNAL_TESTING is
+         *        defined by the test translation unit. Not part of the public API.
          */
-        [[nodiscard]] long debug_snapshot_use_count() const noexcept
+        [[nodiscard]] size_t debug_retired_snapshot_count() const noexcept
         {
-            // load() returns a shared_ptr copy that bumps the refcount by 1 for its own lifetime; subtract that so the
-            // reported count reflects only the other holders (the dispatcher atomic and any in-flight emit snapshots).
-            auto snap = this->m_handlers.load(std::memory_order_acquire);
-            return snap.use_count() - 1;
+            std::scoped_lock lock{this->m_writer_mutex};
+            return this->m_retired.size();
         }
 #endif
 
     private:
-        // Returns false when called from within a handler (reentrancy) or when the replacement snapshot could not be
-        // allocated. The
-        // Subscription::reset() caller retains its m_unsubscribe lambda on false returns and will retry on the next
-        // reset() call (including the destructor). This is safe because the m_alive weak_ptr prevents calling into a
-        // destroyed dispatcher, and on allocation failure the published state is left untouched so the retry observes
-        // the same entry still present.
-        //
-        // Allocates (std::make_shared + vector growth). On OOM, leaves the dispatcher state unchanged and returns false
-        // so the RAII retry path handles it naturally.
-        bool unsubscribe(SubscriptionId id) noexcept
+        [[nodiscard]] Subscription make_subscription(SubscriptionId id)
         {
-            if (is_emitting_this_dispatcher())
+            std::weak_ptr<void> weak = this->m_alive;
+            return Subscription(
+                std::move(weak), [this, id]() noexcept -> bool { return this->unsubscribe(id); }, id, this);
+        }
+
+        // Batch::commit()'s one rebuild: the current list minus the staged removals and any removals deferred mid-emit,
+        // plus the staged adds, published once. Everything that can throw runs before the publish, and the adds are
+        // moved out only once nothing can, so a bad_alloc leaves both the dispatcher and the batch as they were.
+        void publish_batch(std::vector<std::optional<Entry>> &adds, const std::vector<Subscription> &removals)
+        {
+            std::scoped_lock lock{this->m_writer_mutex};
+            const HandlerList *current = this->m_handlers.load(std::memory_order_acquire);
+            const auto removed = [this, &removals](SubscriptionId id) noexcept
             {
-                // Deferred removal. A handler on this thread requested this unsubscribe mid-emit (directly, or via a
-                // Subscription reset/destructor). Rebuilding the published snapshot now would break the
-                // no-mutation-during-emit invariant the in-flight iteration relies on, so the id is queued and the
+                return std::find(this->m_pending_removals.begin(), this->m_pending_removals.end(), id) !=
+                           this->m_pending_removals.end() ||
+                       std::any_of(removals.begin(), removals.end(),
+                                   [id](const Subscription &subscription) { return subscription.m_id == id; });
+            };
+
+            auto next = std::make_unique<HandlerList>();
+            next->reserve(current->size() + adds.size());
+            this->m_retired.reserve_one();
+            for (const auto &entry : *current)
+            {
+                if (!removed(entry.id))
+                {
+                    next->push_back(entry);
+                }
+            }
+            for (auto &staged : adds)
+            {
+                if (staged)
+                {
+                    next->push_back(std::move(*staged));
+                }
+            }
+
+            // A net add publishes the count first and a net removal publishes it last, matching subscribe() and
+            // unsubscribe(): a reader that trusts a zero count never misses a live handler either way.
+            const size_t new_count = next->size();
+            const bool grows = new_count >= this->m_handler_count.load(std::memory_order_relaxed);
+            if (grows)
+            {
+                this->m_handler_count.store(new_count, std::memory_order_release);
+            }
+            this->publish_locked(next.release());
+            if (!grows)
+            {
+                this->m_handler_count.store(new_count, std::memory_order_release);
+            }
+            this->m_pending_removals.clear();
+            this->m_has_pending_removals.store(false, std::memory_order_release);
+        }
+
+        // Returns false when called from within a handler (reentrancy) or when the replacement snapshot could not be
+        // allocated. The
+        // Subscription::reset() caller retains its m_unsubscribe lambda on false returns and will retry on the next
+        // reset() call (including the destructor). This is safe because the m_alive weak_ptr prevents calling into a
+        // destroyed dispatcher, and on allocation failure the published state is left untouched so the retry observes
+        // the same entry still present.
+        //
+        // Allocates (std::make_shared + vector growth). On OOM, leaves the dispatcher state unchanged and returns false
+        // so the RAII retry path handles it naturally.
+        bool unsubscribe(SubscriptionId id) noexcept
+        {
+            if (is_emitting_this_dispatcher())
+            {
+                // Deferred removal. A handler on this thread requested this unsubscribe mid-emit (directly, or via a
+                // Subscription reset/destructor). Rebuilding the published snapshot now would break the
+                // no-mutation-during-emit invariant the in-flight iteration relies on, so the id is queued and the
                 // real removal runs when THIS dispatcher's emit unwinds (its own EmitGuard drains the queue).
                 // If this exact dispatcher is not on the current thread's emit stack, the unsubscribe must run
                 // immediately: a different same-type dispatcher has no guard that could drain this queue, and
@@ -453,7 +1166,7 @@ namespace DetourModKit
             }
 
             std::scoped_lock lock{this->m_writer_mutex};
-            auto current = this->m_handlers.load(std::memory_order_acquire);
+            const HandlerList *current = this->m_handlers.load(std::memory_order_acquire);
             auto it =
                 std::find_if(current->begin(), current->end(), [id](const Entry &entry) { return entry.id == id; });
             if (it == current->end())
@@ -462,13 +1175,14 @@ namespace DetourModKit
                 return true;
             }
 
-            // Build the replacement snapshot in full before touching any published state. A throwing allocator (reserve
-            // / push_back / make_shared) must not leave m_handlers and m_handler_count out of sync, and noexcept
-            // forbids propagation, so we catch bad_alloc and fall through to the false-return retry path.
-            std::shared_ptr<HandlerList> next;
+            // Build the replacement snapshot in full, and make room to retire the current one, before touching any
+            // published state. A throwing allocator (reserve / push_back / make_unique) must not leave m_handlers and
+            // m_handler_count out of sync, and noexcept forbids propagation, so we catch bad_alloc and fall through to
+            // the false-return retry path.
+            std::unique_ptr<HandlerList> next;
             try
             {
-                next = std::make_shared<HandlerList>();
+                next = std::make_unique<HandlerList>();
                 next->reserve(current->size() - 1);
                 for (const auto &entry : *current)
                 {
@@ -477,6 +1191,7 @@ namespace DetourModKit
                         next->push_back(entry);
                     }
                 }
+                this->m_retired.reserve_one();
             }
             catch (...)
             {
@@ -484,9 +1199,10 @@ namespace DetourModKit
             }
 
             // Publish snapshot first, then the counter. An emit that loads a stale snapshot containing the removed
-            // handler is still safe because the handler callable is retained by the old snapshot.
-            this->m_handlers.store(std::shared_ptr<const HandlerList>(std::move(next)), std::memory_order_release);
-            this->m_handler_count.store(current->size() - 1, std::memory_order_release);
+            // handler is still safe because the old snapshot is retired, not freed, while that emit is announced.
+            const size_t new_count = next->size();
+            this->publish_locked(next.release());
+            this->m_handler_count.store(new_count, std::memory_order_release);
             return true;
         }
 
@@ -522,7 +1238,7 @@ namespace DetourModKit
         // thread, so a depth==0 gate would drain whichever instance owns the outermost emit and strand a nested inner
         // instance's queued removals (re-fire, or a use-after-free if the handler destroyed its owner). Rebuilding the
         // snapshot here is safe even if another emit of this instance is still iterating higher on the stack, because
-        // that iteration holds its own copy-on-write snapshot alive. Const because emit() is const; it mutates only the
+        // that iteration's announced epoch keeps its snapshot alive. Const because emit() is const; it mutates only the
         // mutable snapshot / count / queue / flag members, serialized against writers by the mutable writer mutex.
         // noexcept and best-effort: on allocation failure the queue and flag are left set so the next guard (or a
         // Subscription retry) completes the removal.
@@ -537,11 +1253,11 @@ namespace DetourModKit
                 return;
             }
 
-            auto current = this->m_handlers.load(std::memory_order_acquire);
-            std::shared_ptr<HandlerList> next;
+            const HandlerList *current = this->m_handlers.load(std::memory_order_acquire);
+            std::unique_ptr<HandlerList> next;
             try
             {
-                next = std::make_shared<HandlerList>();
+                next = std::make_unique<HandlerList>();
                 next->reserve(current->size());
                 for (const auto &entry : *current)
                 {
@@ -552,6 +1268,7 @@ namespace DetourModKit
                         next->push_back(entry);
                     }
                 }
+                this->m_retired.reserve_one();
             }
             catch (...)
             {
@@ -560,29 +1277,44 @@ namespace DetourModKit
             }
 
             // Publish the snapshot before the counter, matching unsubscribe(): an emit that briefly loads the stale
-            // snapshot (still holding a removed handler) stays safe because that handler is retained by the old
-            // snapshot's shared_ptr.
+            // snapshot (still holding a removed handler) stays safe because the old snapshot is only retired.
             const size_t new_count = next->size();
-            this->m_handlers.store(std::shared_ptr<const HandlerList>(std::move(next)), std::memory_order_release);
+            this->publish_locked(next.release());
             this->m_handler_count.store(new_count, std::memory_order_release);
             this->m_pending_removals.clear();
             this->m_has_pending_removals.store(false, std::memory_order_release);
         }
 
+        [[nodiscard]] static Event *deferred_event(DeferredSlot &slot) noexcept
+        {
+            return std::launder(reinterpret_cast<Event *>(slot.storage));
+        }
+
         /**
-         * @brief Best-effort report that the reentrancy guard rejected a subscribe() from within a handler.
-         * @details Only subscribe() routes here. A subscribe cannot be deferred -- it must hand back a live
+         * @brief Publishes @p next as the snapshot and retires the one it replaces (see RetiredSnapshots::retire).
+         * @details The caller holds m_writer_mutex and has called m_retired.reserve_one(), so this cannot throw. Const
+         *          because the deferred-removal drain runs from const emit().
+         */
+        void publish_locked(HandlerList *next) const noexcept
+        {
+            this->m_retired.retire(this->m_handlers.exchange(next, std::memory_order_seq_cst));
+        }
+
+        /**
+         * @brief Best-effort report that the reentrancy guard rejected a subscribe() or drain() from within a handler.
+         * @details Only subscribe() and drain() route here. A subscribe cannot be deferred -- it must hand back a live
          *          Subscription synchronously -- so a subscribe requested from inside a handler on a same-type
-         *          dispatcher is hard-rejected and reported here. (An unsubscribe requested mid-emit is NOT routed
-         *          here: it is deferred and completed when that dispatcher's emit unwinds; see unsubscribe().) Emits a
-         *          Debug log via log().try_log so the otherwise-silent per-instantiation rejection surfaces during
-         *          development. The try/catch swallows try_log's own formatting and sink failures once the logger is
-         *          available, so a routine logging hiccup never turns a rejected mutation into host termination. It
-         *          cannot catch a first-use logger-construction failure: log() is noexcept, so an out-of-memory there
-         *          terminates before try_log runs, an unrecoverable condition rather than this best-effort path's
-         *          concern. Deliberately does NOT assert: a reentrant subscribe is a defined, observable outcome (the
-         *          returned Subscription is inactive), not a bug to abort on. Zero-cost on the success path because it
-         *          is only reached after the guard has already rejected the call.
+         *          dispatcher is hard-rejected and reported here; a nested drain() would dispatch queued events in the
+         *          middle of another handler, so it is rejected the same way. (An unsubscribe requested mid-emit is NOT
+         *          routed here: it is deferred and completed when that dispatcher's emit unwinds; see unsubscribe().)
+         *          Emits a Debug log via log().try_log so the otherwise-silent per-instantiation rejection surfaces
+         *          during development. The try/catch swallows try_log's own formatting and sink failures once the
+         *          logger is available, so a routine logging hiccup never turns a rejected mutation into host
+         *          termination. It cannot catch a first-use logger-construction failure: log() is noexcept, so an
+         *          out-of-memory there terminates before try_log runs, an unrecoverable condition rather than this
+         *          best-effort path's concern. Deliberately does NOT assert: a reentrant subscribe is a defined,
+         *          observable outcome (the returned Subscription is inactive), not a bug to abort on. Zero-cost on the
+         *          success path because it is only reached after the guard has already rejected the call.
          */
         static void report_reentrant_rejection(const char *op) noexcept
         {
@@ -591,7 +1323,7 @@ namespace DetourModKit
                 (void)log().try_log(
                     LogLevel::Debug,
                     "EventDispatcher: {} rejected -- called from within a handler on a same-type dispatcher "
-                    "(per-instantiation reentrancy guard). Defer the mutation until the emit returns.",
+                    "(per-instantiation reentrancy guard). Defer the call until the emit returns.",
                     op);
             }
             catch (...)
@@ -717,9 +1449,10 @@ namespace DetourModKit
             EmitGuard &operator=(EmitGuard &&) = delete;
         };
 
-        // alignas(64) keeps the hot atomics on their own cache line so the writer mutex and shared_ptr control-block
-        // traffic do not produce false sharing with readers doing the fast-path counter load.
-        alignas(64) mutable std::atomic<SharedList> m_handlers;
+        // alignas(64) keeps the hot atomics on their own cache line so writer mutex traffic does not produce false
+        // sharing with readers doing the fast-path counter and snapshot loads. Owned: freed by the writer that replaces
+        // it (once retired and unreachable) or by the destructor.
+        alignas(64) mutable std::atomic<const HandlerList *> m_handlers;
         // mutable: emit() is const, but its EmitGuard drains this dispatcher's deferred removals, which republishes
         // both the snapshot and this count. The drain is serialized against writers by the (also mutable) writer mutex.
         mutable std::atomic<size_t> m_handler_count{0};
@@ -732,10 +1465,779 @@ namespace DetourModKit
         // entirely on the common no-deferral emit (a single acquire load). Set/cleared under m_writer_mutex alongside
         // the queue so the two stay consistent; read without the lock by the guard on unwind.
         mutable std::atomic<bool> m_has_pending_removals{false};
+        // Replaced snapshots an emit may still be iterating, oldest first. Guarded by m_writer_mutex; each writer frees
+        // the ones no announced epoch can reach.
+        mutable detail::RetiredSnapshots<HandlerList> m_retired;
+        // Deferred queue (emit_deferred / drain): absent unless the capacity constructor was used. Producers claim
+        // positions on the enqueue cursor, which has its own cache line; the dequeue cursor and the slot hand-back
+        // belong to the one consumer holding m_drain_mutex (the cursor is atomic only so deferred_pending() can read
+        // it).
+        std::unique_ptr<DeferredSlot[]> m_deferred_slots;
+        size_t m_deferred_mask{0};
+        alignas(64) std::atomic<size_t> m_enqueue_position{0};
+        std::atomic<uint64_t> m_deferred_dropped{0};
+        alignas(64) std::atomic<size_t> m_dequeue_position{0};
+        std::mutex m_drain_mutex;
         // Prevents Subscription::reset() from calling unsubscribe() after dispatcher destruction.
         std::shared_ptr<void> m_alive;
     };
 
+    namespace detail
+    {
+        template <typename E, typename... Events>
+        inline constexpr std::size_t event_count_v = (std::size_t{0} + ... + std::size_t{std::is_same_v<E, Events>});
+
+        /// The position of @p E in @p Events; only meaningful when it occurs exactly once.
+        template <typename E, typename... Events> consteval std::size_t event_index()
+        {
+            constexpr bool matches[] = {std::is_same_v<E, Events>...};
+            std::size_t index = 0;
+            while (!matches[index])
+            {
+                ++index;
+            }
+            return index;
+        }
+
+        /// What an EventBus entry's handler receives: the event, whose type the bus knows from the entry's range.
+        struct ErasedEventRef
+        {
+            const void *event;
+        };
+    } // namespace detail
+
+    /**
+     * @brief A fixed set of event types behind one snapshot, one writer mutex and one reclamation domain.
+     *
+     * @tparam Events The distinct event types the bus carries.
+     *
+     * @details An alternative to a struct of one EventDispatcher per event type. Every subscriber of every event sits
+     *          in ONE contiguous handler array, grouped by event type, with a small offset table marking where each
+     *          type's range starts. emit<E>() finds that range with an index fixed at compile time, so firing several
+     *          events in a row walks neighbouring entries of one allocation, and the bus costs one mutex, one
+     *          snapshot and one retired list in total instead of one per event type. Subscribing or unsubscribing for
+     *          any event republishes the whole array, copy-on-write, as EventDispatcher does for its one type.
+     *
+     *          emit() / emit_safe() have EventDispatcher's read path: an atomic per-event counter for the
+     *          zero-subscriber fast path, then an epoch-announced raw snapshot load (detail::EmitEpochScope), wait-free
+     *          after the thread's first emit; handlers are stored inline (detail::InlineHandler).
+     *
+     *          Unlike EventDispatcher, a handler may subscribe or unsubscribe on the bus during an emit: the emit in
+     *          flight keeps iterating the snapshot it loaded (kept alive by its announced epoch), and the change is
+     *          seen by the next emit. There is no reentrancy guard and no deferred-removal queue to reason about.
+     *
+     *          @code
+     *          EventBus<PlayerStateChanged, CameraUpdated> bus;
+     *          auto sub = bus.subscribe<CameraUpdated>([](const CameraUpdated& e) { ... });
+     *          bus.emit(CameraUpdated{...});
+     *          @endcode
+     */
+    template <typename... Events> class EventBus
+    {
+        static_assert(sizeof...(Events) > 0, "an EventBus carries at least one event type");
+        static_assert(((detail::event_count_v<Events, Events...> == 1) && ...),
+                      "each event type may appear only once in an EventBus");
+
+        static constexpr std::size_t EVENT_COUNT = sizeof...(Events);
+
+        template <typename E> static constexpr bool carries_v = detail::event_count_v<E, Events...> == 1;
+
+        template <typename E> static constexpr std::size_t index_v = detail::event_index<E, Events...>();
+
+        struct Entry
+        {
+            SubscriptionId id;
+            detail::InlineHandler<detail::ErasedEventRef> callback;
+        };
+
+        struct Snapshot
+        {
+            /// Entries of event i are entries[begin[i], begin[i + 1]), in subscription order.
+            std::array<std::uint32_t, EVENT_COUNT + 1> begin{};
+            std::vector<Entry> entries;
+        };
+
+    public:
+        EventBus() : m_snapshot(new Snapshot()), m_alive(std::make_shared<char>('\0')) {}
+
+        /// No emit may be in flight: the current and every retired snapshot are freed here.
+        ~EventBus() noexcept { delete m_snapshot.load(std::memory_order_relaxed); }
+
+        EventBus(const EventBus &) = delete;
+        EventBus &operator=(const EventBus &) = delete;
+        EventBus(EventBus &&) = delete;
+        EventBus &operator=(EventBus &&) = delete;
+
+        /**
+         * @brief Subscribes @p handler to event type @p E.
+         * @return RAII Subscription guard, or an INACTIVE one for an empty std::function or null function pointer.
+         * @note Copy-on-write: allocates a new handler array holding every event's entries plus this one.
+         */
+        template <typename E, typename F>
+            requires carries_v<E> && std::invocable<std::decay_t<F> &, const E &> &&
+                     std::copy_constructible<std::decay_t<F>>
+        [[nodiscard]] Subscription subscribe(F &&handler)
+        {
+            using Stored = std::decay_t<F>;
+            bool empty_handler = false;
+            if constexpr (std::is_pointer_v<Stored> || detail::is_std_function_v<Stored>)
+            {
+                empty_handler = handler == nullptr;
+            }
+            if (empty_handler)
+            {
+                report_empty_handler_rejection();
+                return {};
+            }
+
+            constexpr std::size_t index = index_v<E>;
+            detail::InlineHandler<detail::ErasedEventRef> callback{
+                [target = std::forward<F>(handler)](const detail::ErasedEventRef &ref) mutable
+                { std::invoke(target, *static_cast<const E *>(ref.event)); }};
+            const auto id = static_cast<SubscriptionId>(m_next_id.fetch_add(1, std::memory_order_relaxed));
+
+            {
+                std::scoped_lock lock{m_writer_mutex};
+                const Snapshot *current = m_snapshot.load(std::memory_order_acquire);
+                auto next = std::make_unique<Snapshot>();
+                next->entries.reserve(current->entries.size() + 1);
+                const std::uint32_t insert_at = current->begin[index + 1];
+                for (std::uint32_t i = 0; i < insert_at; ++i)
+                {
+                    next->entries.push_back(current->entries[i]);
+                }
+                next->entries.push_back(Entry{id, std::move(callback)});
+                for (std::size_t i = insert_at; i < current->entries.size(); ++i)
+                {
+                    next->entries.push_back(current->entries[i]);
+                }
+                next->begin = current->begin;
+                for (std::size_t i = index + 1; i <= EVENT_COUNT; ++i)
+                {
+                    ++next->begin[i];
+                }
+                m_retired.reserve_one();
+                // Count first, as in EventDispatcher::subscribe: a reader that sees 0 cannot miss an installed entry.
+                m_counts[index].store(next->begin[index + 1] - next->begin[index], std::memory_order_release);
+                publish_locked(next.release());
+            }
+
+            std::weak_ptr<void> weak = m_alive;
+            return Subscription(std::move(weak), [this, id]() noexcept -> bool { return unsubscribe(id); });
+        }
+
+        /**
+         * @brief Emits @p event to the subscribers of its type, synchronously and in subscription order.
+         * @note Same read path as EventDispatcher::emit(); handler exceptions propagate to the caller.
+         */
+        template <typename E>
+            requires carries_v<E>
+        void emit(const E &event) const
+        {
+            constexpr std::size_t index = index_v<E>;
+            if (m_counts[index].load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const Snapshot *snap = m_snapshot.load(std::memory_order_seq_cst);
+            const detail::ErasedEventRef ref{&event};
+            for (std::uint32_t i = snap->begin[index]; i != snap->begin[index + 1]; ++i)
+            {
+                snap->entries[i].callback(ref);
+            }
+        }
+
+        /// emit(), with each handler's exception contained and reported; the remaining handlers still run.
+        template <typename E>
+            requires carries_v<E>
+        void emit_safe(const E &event) const noexcept
+        {
+            constexpr std::size_t index = index_v<E>;
+            if (m_counts[index].load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const Snapshot *snap = m_snapshot.load(std::memory_order_seq_cst);
+            const detail::ErasedEventRef ref{&event};
+            for (std::uint32_t i = snap->begin[index]; i != snap->begin[index + 1]; ++i)
+            {
+                try
+                {
+                    snap->entries[i].callback(ref);
+                }
+                catch (const std::exception &ex)
+                {
+                    report_handler_exception(ex.what());
+                }
+                catch (...)
+                {
+                    report_handler_exception(nullptr);
+                }
+            }
+        }
+
+        /// Returns the number of active subscribers of event type @p E.
+        template <typename E>
+            requires carries_v<E>
+        [[nodiscard]] std::size_t subscriber_count() const noexcept
+        {
+            return m_counts[index_v<E>].load(std::memory_order_acquire);
+        }
+
+        /// Returns true if event type @p E has no subscribers.
+        template <typename E>
+            requires carries_v<E>
+        [[nodiscard]] bool empty() const noexcept
+        {
+            return subscriber_count<E>() == 0;
+        }
+
+        /**
+         * @brief Removes every subscriber of every event type, in one publish.
+         * @note On allocation failure the bus is left unchanged (best-effort no-op), as EventDispatcher::clear().
+         */
+        void clear() noexcept
+        {
+            std::scoped_lock lock{m_writer_mutex};
+            std::unique_ptr<Snapshot> empty_snap;
+            try
+            {
+                empty_snap = std::make_unique<Snapshot>();
+                m_retired.reserve_one();
+            }
+            catch (...)
+            {
+                return;
+            }
+            for (auto &count : m_counts)
+            {
+                count.store(0, std::memory_order_release);
+            }
+            publish_locked(empty_snap.release());
+        }
+
+    private:
+        // Returns false only when the replacement array could not be allocated; the Subscription keeps its retry
+        // lambda and completes the removal on a later reset(), as with EventDispatcher.
+        bool unsubscribe(SubscriptionId id) noexcept
+        {
+            std::scoped_lock lock{m_writer_mutex};
+            const Snapshot *current = m_snapshot.load(std::memory_order_acquire);
+            const auto it = std::find_if(current->entries.begin(), current->entries.end(),
+                                         [id](const Entry &entry) { return entry.id == id; });
+            if (it == current->entries.end())
+            {
+                return true;
+            }
+            const auto removed = static_cast<std::uint32_t>(it - current->entries.begin());
+            std::size_t index = 0;
+            while (current->begin[index + 1] <= removed)
+            {
+                ++index;
+            }
+
+            std::unique_ptr<Snapshot> next;
+            try
+            {
+                next = std::make_unique<Snapshot>();
+                next->entries.reserve(current->entries.size() - 1);
+                for (std::uint32_t i = 0; i < current->entries.size(); ++i)
+                {
+                    if (i != removed)
+                    {
+                        next->entries.push_back(current->entries[i]);
+                    }
+                }
+                m_retired.reserve_one();
+            }
+            catch (...)
+            {
+                return false;
+            }
+            next->begin = current->begin;
+            for (std::size_t i = index + 1; i <= EVENT_COUNT; ++i)
+            {
+                --next->begin[i];
+            }
+
+            const std::uint32_t new_count = next->begin[index + 1] - next->begin[index];
+            publish_locked(next.release());
+            m_counts[index].store(new_count, std::memory_order_release);
+            return true;
+        }
+
+        void publish_locked(Snapshot *next) noexcept
+        {
+            m_retired.retire(m_snapshot.exchange(next, std::memory_order_seq_cst));
+        }
+
+        static void report_empty_handler_rejection() noexcept
+        {
+            try
+            {
+                (void)log().try_log(LogLevel::Warning,
+                                    "EventBus: subscribe rejected an empty handler -- the returned Subscription is "
+                                    "inactive. Pass a callable target.");
+            }
+            catch (...)
+            {
+            }
+        }
+
+        static void report_handler_exception(const char *what) noexcept
+        {
+            try
+            {
+                (void)log().try_log(LogLevel::Warning,
+                                    "EventBus: emit_safe swallowed a subscriber handler exception: {}",
+                                    (what != nullptr && what[0] != '\0') ? what : "(non-std exception)");
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // Read by every emit; kept together on their own cache line, away from the writer-side members below.
+        alignas(64) std::atomic<const Snapshot *> m_snapshot;
+        std::array<std::atomic<std::uint32_t>, EVENT_COUNT> m_counts{};
+        alignas(64) std::mutex m_writer_mutex;
+        std::atomic<uint64_t> m_next_id{1};
+        // Guarded by m_writer_mutex.
+        detail::RetiredSnapshots<Snapshot> m_retired;
+        // Prevents Subscription::reset() from calling unsubscribe() after the bus is destroyed.
+        std::shared_ptr<void> m_alive;
+    };
+
+    namespace detail
+    {
+        /// What a KeyedEventDispatcher entry's handler receives: the key the event was emitted under, and the event.
+        template <typename Key, typename Event> struct KeyedEventRef
+        {
+            const Key *key;
+            const Event *event;
+        };
+    } // namespace detail
+
+    /**
+     * @brief Event dispatcher whose subscribers register under a key, so an emit reaches only that key's handlers.
+     *
+     * @tparam Key The routing key (entity id, binding-name hash, ...): copyable and equality comparable.
+     * @tparam Event The event type.
+     * @tparam Hash Hashes a Key; its result is remixed, so an identity hash such as std::hash<int> is fine.
+     *
+     * @details For a dispatcher that carries events for many entities, where an EventDispatcher would call every
+     *          subscriber and leave each to filter by key. The snapshot holds the entries grouped by key, wildcard
+     *          subscribers first, and an open-addressed table (at most half full) from key to its group's range, so
+     *          emit(key, event) costs one hash and a probe or two before it calls just the key's handlers and the
+     *          wildcards, however many other keys have subscribers.
+     *
+     *          The read path and reentrancy rules are EventBus's: an atomic counter for the zero-subscriber fast path,
+     *          an epoch-announced raw snapshot load (detail::EmitEpochScope), handlers stored inline
+     *          (detail::InlineHandler), and a handler may subscribe or unsubscribe during an emit, seen by the next
+     *          one. Subscribing or unsubscribing republishes the entries and rebuilds the table, copy-on-write.
+     *
+     *          A handler takes either the event alone or the key and the event, which is what a wildcard usually
+     *          wants:
+     *          @code
+     *          KeyedEventDispatcher<std::uint32_t, DamageTaken> damage;
+     *          auto player = damage.subscribe(player_id, [](const DamageTaken& e) { ... });
+     *          auto audit = damage.subscribe_all([](std::uint32_t entity, const DamageTaken& e) { ... });
+     *          damage.emit(entity_id, DamageTaken{...});
+     *          @endcode
+     */
+    template <typename Key, typename Event, typename Hash = std::hash<Key>> class KeyedEventDispatcher
+    {
+        using EventRef = detail::KeyedEventRef<Key, Event>;
+
+        template <typename F>
+        static constexpr bool keyed_handler_v = std::invocable<std::decay_t<F> &, const Key &, const Event &>;
+
+        template <typename F>
+        static constexpr bool handler_v = std::copy_constructible<std::decay_t<F>> &&
+                                          (std::invocable<std::decay_t<F> &, const Event &> || keyed_handler_v<F>);
+
+        struct Entry
+        {
+            SubscriptionId id;
+            // Empty for a wildcard subscriber.
+            std::optional<Key> key;
+            detail::InlineHandler<EventRef> callback;
+        };
+
+        // end == 0 marks a free slot: a key's group always ends past at least one entry.
+        struct Slot
+        {
+            std::uint64_t hash;
+            std::uint32_t begin;
+            std::uint32_t end;
+        };
+
+        struct Snapshot
+        {
+            /// Wildcard entries are entries[0, wildcard_end); each key's entries follow as one contiguous group.
+            std::vector<Entry> entries;
+            std::uint32_t wildcard_end{0};
+            /// Power-of-two sized, or empty when no key has a subscriber.
+            std::vector<Slot> table;
+            unsigned shift{64};
+        };
+
+    public:
+        KeyedEventDispatcher() : m_snapshot(new Snapshot()), m_alive(std::make_shared<char>('\0')) {}
+
+        /// No emit may be in flight: the current and every retired snapshot are freed here.
+        ~KeyedEventDispatcher() noexcept { delete m_snapshot.load(std::memory_order_relaxed); }
+
+        KeyedEventDispatcher(const KeyedEventDispatcher &) = delete;
+        KeyedEventDispatcher &operator=(const KeyedEventDispatcher &) = delete;
+        KeyedEventDispatcher(KeyedEventDispatcher &&) = delete;
+        KeyedEventDispatcher &operator=(KeyedEventDispatcher &&) = delete;
+
+        /**
+         * @brief Subscribes @p handler to the events emitted under @p key.
+         * @return RAII Subscription guard, or an INACTIVE one for an empty std::function or null function pointer.
+         * @note Copy-on-write: allocates a new entry array and key table holding every subscriber plus this one.
+         */
+        template <typename F>
+            requires handler_v<F>
+        [[nodiscard]] Subscription subscribe(const Key &key, F &&handler)
+        {
+            return add(std::optional<Key>{key}, std::forward<F>(handler));
+        }
+
+        /// Subscribes @p handler to every event, whatever its key; it runs after the key's own subscribers.
+        template <typename F>
+            requires handler_v<F>
+        [[nodiscard]] Subscription subscribe_all(F &&handler)
+        {
+            return add(std::nullopt, std::forward<F>(handler));
+        }
+
+        /**
+         * @brief Emits @p event to the subscribers of @p key, in subscription order, then to the wildcard subscribers.
+         * @note Same read path as EventDispatcher::emit(); handler exceptions propagate to the caller.
+         */
+        void emit(const Key &key, const Event &event) const
+        {
+            if (m_count.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const Snapshot *snap = m_snapshot.load(std::memory_order_seq_cst);
+            const EventRef ref{&key, &event};
+            const Slot *slot = find(*snap, key);
+            if (slot != nullptr)
+            {
+                for (std::uint32_t i = slot->begin; i != slot->end; ++i)
+                {
+                    snap->entries[i].callback(ref);
+                }
+            }
+            for (std::uint32_t i = 0; i != snap->wildcard_end; ++i)
+            {
+                snap->entries[i].callback(ref);
+            }
+        }
+
+        /// emit(), with each handler's exception contained and reported; the remaining handlers still run.
+        void emit_safe(const Key &key, const Event &event) const noexcept
+        {
+            if (m_count.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+
+            detail::EmitEpochScope epoch;
+            const Snapshot *snap = m_snapshot.load(std::memory_order_seq_cst);
+            const EventRef ref{&key, &event};
+            const Slot *slot = find(*snap, key);
+            if (slot != nullptr)
+            {
+                for (std::uint32_t i = slot->begin; i != slot->end; ++i)
+                {
+                    invoke_safe(snap->entries[i], ref);
+                }
+            }
+            for (std::uint32_t i = 0; i != snap->wildcard_end; ++i)
+            {
+                invoke_safe(snap->entries[i], ref);
+            }
+        }
+
+        /// Returns the number of active subscribers, keyed and wildcard.
+        [[nodiscard]] std::size_t subscriber_count() const noexcept { return m_count.load(std::memory_order_acquire); }
+
+        /// Returns the number of subscribers registered under @p key, not counting the wildcards.
+        [[nodiscard]] std::size_t subscriber_count(const Key &key) const
+        {
+            detail::EmitEpochScope epoch;
+            const Snapshot *snap = m_snapshot.load(std::memory_order_seq_cst);
+            const Slot *slot = find(*snap, key);
+            return slot == nullptr ? 0 : slot->end - slot->begin;
+        }
+
+        /// Returns true if there are no subscribers at all.
+        [[nodiscard]] bool empty() const noexcept { return subscriber_count() == 0; }
+
+        /**
+         * @brief Removes every subscriber, in one publish.
+         * @note On allocation failure the dispatcher is left unchanged (best-effort no-op), like EventDispatcher.
+         */
+        void clear() noexcept
+        {
+            std::scoped_lock lock{m_writer_mutex};
+            std::unique_ptr<Snapshot> empty_snap;
+            try
+            {
+                empty_snap = std::make_unique<Snapshot>();
+                m_retired.reserve_one();
+            }
+            catch (...)
+            {
+                return;
+            }
+            m_count.store(0, std::memory_order_release);
+            publish_locked(empty_snap.release());
+        }
+
+    private:
+        template <typename F> Subscription add(std::optional<Key> key, F &&handler)
+        {
+            using Stored = std::decay_t<F>;
+            bool empty_handler = false;
+            if constexpr (std::is_pointer_v<Stored> || detail::is_std_function_v<Stored>)
+            {
+                empty_handler = handler == nullptr;
+            }
+            if (empty_handler)
+            {
+                report_empty_handler_rejection();
+                return {};
+            }
+
+            detail::InlineHandler<EventRef> callback{
+                [target = std::forward<F>(handler)](const EventRef &ref) mutable
+                {
+                    if constexpr (keyed_handler_v<F>)
+                    {
+                        std::invoke(target, *ref.key, *ref.event);
+                    }
+                    else
+                    {
+                        std::invoke(target, *ref.event);
+                    }
+                }};
+            const auto id = static_cast<SubscriptionId>(m_next_id.fetch_add(1, std::memory_order_relaxed));
+
+            {
+                std::scoped_lock lock{m_writer_mutex};
+                const Snapshot *current = m_snapshot.load(std::memory_order_acquire);
+                // A new key's group goes last; an existing key's entry, or a wildcard, closes its own range.
+                std::uint32_t insert_at = current->wildcard_end;
+                if (key.has_value())
+                {
+                    const Slot *slot = find(*current, *key);
+                    insert_at = slot != nullptr ? slot->end : static_cast<std::uint32_t>(current->entries.size());
+                }
+                // push_back, not a range insert: an InlineHandler is not assignable.
+                std::vector<Entry> entries;
+                entries.reserve(current->entries.size() + 1);
+                for (std::uint32_t i = 0; i < insert_at; ++i)
+                {
+                    entries.push_back(current->entries[i]);
+                }
+                const bool wildcard = !key.has_value();
+                entries.push_back(Entry{id, std::move(key), std::move(callback)});
+                for (std::size_t i = insert_at; i < current->entries.size(); ++i)
+                {
+                    entries.push_back(current->entries[i]);
+                }
+                auto next = build(std::move(entries), current->wildcard_end + (wildcard ? 1 : 0));
+                m_retired.reserve_one();
+                // Count first, as in EventDispatcher::subscribe: a reader that sees 0 cannot miss an installed entry.
+                m_count.store(next->entries.size(), std::memory_order_release);
+                publish_locked(next.release());
+            }
+
+            std::weak_ptr<void> weak = m_alive;
+            return Subscription(std::move(weak), [this, id]() noexcept -> bool { return unsubscribe(id); });
+        }
+
+        // Returns false only when the replacement snapshot could not be allocated; the Subscription keeps its retry
+        // lambda and completes the removal on a later reset(), as with EventDispatcher.
+        bool unsubscribe(SubscriptionId id) noexcept
+        {
+            std::scoped_lock lock{m_writer_mutex};
+            const Snapshot *current = m_snapshot.load(std::memory_order_acquire);
+            const auto it = std::find_if(current->entries.begin(), current->entries.end(),
+                                         [id](const Entry &entry) { return entry.id == id; });
+            if (it == current->entries.end())
+            {
+                return true;
+            }
+            const bool wildcard = !it->key.has_value();
+            const auto removed = static_cast<std::size_t>(it - current->entries.begin());
+
+            std::unique_ptr<Snapshot> next;
+            try
+            {
+                std::vector<Entry> entries;
+                entries.reserve(current->entries.size() - 1);
+                for (std::size_t i = 0; i < current->entries.size(); ++i)
+                {
+                    if (i != removed)
+                    {
+                        entries.push_back(current->entries[i]);
+                    }
+                }
+                next = build(std::move(entries), current->wildcard_end - (wildcard ? 1 : 0));
+                m_retired.reserve_one();
+            }
+            catch (...)
+            {
+                return false;
+            }
+
+            const std::size_t new_count = next->entries.size();
+            publish_locked(next.release());
+            m_count.store(new_count, std::memory_order_release);
+            return true;
+        }
+
+        [[nodiscard]] static std::uint64_t mix(const Key &key)
+        {
+            // Fibonacci hashing: the table index is the top bits of the product, so low-entropy hashes still spread.
+            return static_cast<std::uint64_t>(Hash{}(key)) * 0x9E3779B97F4A7C15ULL;
+        }
+
+        [[nodiscard]] static const Slot *find(const Snapshot &snap, const Key &key)
+        {
+            if (snap.table.empty())
+            {
+                return nullptr;
+            }
+            const std::uint64_t hash = mix(key);
+            const std::size_t mask = snap.table.size() - 1;
+            for (std::size_t i = static_cast<std::size_t>(hash >> snap.shift);; i = (i + 1) & mask)
+            {
+                const Slot &slot = snap.table[i];
+                if (slot.end == 0)
+                {
+                    return nullptr;
+                }
+                if (slot.hash == hash && *snap.entries[slot.begin].key == key)
+                {
+                    return &slot;
+                }
+            }
+        }
+
+        // Wraps @p entries, grouped as Snapshot documents, with a key table sized to keep it at most half full.
+        [[nodiscard]] static std::unique_ptr<Snapshot> build(std::vector<Entry> entries, std::uint32_t wildcard_end)
+        {
+            auto snap = std::make_unique<Snapshot>();
+            snap->entries = std::move(entries);
+            snap->wildcard_end = wildcard_end;
+            const auto total = static_cast<std::uint32_t>(snap->entries.size());
+
+            std::size_t groups = 0;
+            for (std::uint32_t i = wildcard_end; i != total; ++i)
+            {
+                groups += (i == wildcard_end || *snap->entries[i].key != *snap->entries[i - 1].key) ? 1 : 0;
+            }
+            if (groups == 0)
+            {
+                return snap;
+            }
+            const std::size_t size = std::bit_ceil(groups * 2);
+            snap->table.assign(size, Slot{0, 0, 0});
+            snap->shift = 64 - static_cast<unsigned>(std::countr_zero(size));
+            const std::size_t mask = size - 1;
+
+            for (std::uint32_t begin = wildcard_end; begin != total;)
+            {
+                const Key &key = *snap->entries[begin].key;
+                std::uint32_t end = begin + 1;
+                while (end != total && *snap->entries[end].key == key)
+                {
+                    ++end;
+                }
+                const std::uint64_t hash = mix(key);
+                std::size_t i = static_cast<std::size_t>(hash >> snap->shift);
+                while (snap->table[i].end != 0)
+                {
+                    i = (i + 1) & mask;
+                }
+                snap->table[i] = Slot{hash, begin, end};
+                begin = end;
+            }
+            return snap;
+        }
+
+        static void invoke_safe(const Entry &entry, const EventRef &ref) noexcept
+        {
+            try
+            {
+                entry.callback(ref);
+            }
+            catch (const std::exception &ex)
+            {
+                report_handler_exception(ex.what());
+            }
+            catch (...)
+            {
+                report_handler_exception(nullptr);
+            }
+        }
+
+        void publish_locked(Snapshot *next) noexcept
+        {
+            m_retired.retire(m_snapshot.exchange(next, std::memory_order_seq_cst));
+        }
+
+        static void report_empty_handler_rejection() noexcept
+        {
+            try
+            {
+                (void)log().try_log(LogLevel::Warning,
+                                    "KeyedEventDispatcher: subscribe rejected an empty handler -- the returned "
+                                    "Subscription is inactive. Pass a callable target.");
+            }
+            catch (...)
+            {
+            }
+        }
+
+        static void report_handler_exception(const char *what) noexcept
+        {
+            try
+            {
+                (void)log().try_log(LogLevel::Warning,
+                                    "KeyedEventDispatcher: emit_safe swallowed a subscriber handler exception: {}",
+                                    (what != nullptr && what[0] != '\0') ? what : "(non-std exception)");
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // Read by every emit; kept on its own cache line, away from the writer-side members below.
+        alignas(64) std::atomic<const Snapshot *> m_snapshot;
+        std::atomic<std::size_t> m_count{0};
+        alignas(64) std::mutex m_writer_mutex;
+        std::atomic<uint64_t> m_next_id{1};
+        // Guarded by m_writer_mutex.
+        detail::RetiredSnapshots<Snapshot> m_retired;
+        // Prevents Subscription::reset() from calling unsubscribe() after the dispatcher is destroyed.
+        std::shared_ptr<void> m_alive;
+    };
+
 } // namespace DetourModKit
 
 #endif // DETOURMODKIT_EVENT_DISPATCHER_HPP
@@ -79,6 +79,25 @@ namespace DetourModKit::detail
     static_assert(SEGMENT_MATCH_STEP_BUDGET >= MAX_PATTERN_JUMPS * MAX_JUMP_SPAN,
                   "The per-position work budget must exceed the linear per-position cost of a well-formed pattern.");
 
+    /**
+     * @brief Maximum number of exact byte classes a single pattern may carry.
+     * @details A class token (`[0D|15]`) compiles to the tightest value/mask pair covering its members, which every
+     *          masked-compare verifier already checks; only a class that pair over-approximates needs its 256-bit
+     *          member set stored and checked on a verified candidate. Each stored class costs 40 bytes inline in
+     *          every value Pattern, so the cap stays at a handful: a real signature varies at one or two register or
+     *          condition-code bytes. A pattern that needs more fails closed at parse with TooManyClasses.
+     */
+    inline constexpr std::size_t MAX_PATTERN_CLASSES = 8;
+
+    /// Maximum number of alternation groups (`(48 8B 0D|48 8B 15)`) a single pattern may carry.
+    inline constexpr std::size_t MAX_PATTERN_GROUPS = 2;
+
+    /// Maximum number of alternatives one alternation group may list.
+    inline constexpr std::size_t MAX_GROUP_ALTERNATIVES = 4;
+
+    /// Maximum length, in bytes, of each alternative of an alternation group; every alternative has the same length.
+    inline constexpr std::size_t MAX_GROUP_BYTES = 8;
+
     /**
      * @struct PatternJump
      * @brief One bounded gap between two fixed byte runs (segments) of a compiled pattern.
@@ -118,7 +137,111 @@ namespace DetourModKit::detail
         /// A `[...]` jump token was malformed, out of range, or illegally placed (leading, trailing, or adjacent).
         InvalidJump,
         /// The pattern named more bounded jumps than MAX_PATTERN_JUMPS.
-        TooManyJumps
+        TooManyJumps,
+        /// A `[..|..]` / `[VV/MM]` class or `(..|..)` alternation group was malformed.
+        InvalidClass,
+        /// The pattern needed more exact classes than MAX_PATTERN_CLASSES or groups than MAX_PATTERN_GROUPS.
+        TooManyClasses
+    };
+
+    /**
+     * @struct ByteSet
+     * @brief A set of byte values as a 256-bit bitmap, bit v of the words set when value v is a member.
+     */
+    struct ByteSet
+    {
+        std::array<std::uint64_t, 4> words{};
+
+        /// Adds @p value to the set.
+        constexpr void add(std::uint8_t value) noexcept { words[value >> 6] |= std::uint64_t{1} << (value & 63u); }
+
+        /// Adds every value v with (v ^ value) & mask == 0, the values one masked DSL byte admits.
+        constexpr void add_masked(std::uint8_t value, std::uint8_t mask) noexcept
+        {
+            for (unsigned v = 0; v < 256; ++v)
+            {
+                if (((v ^ value) & mask) == 0)
+                {
+                    add(static_cast<std::uint8_t>(v));
+                }
+            }
+        }
+
+        /// True when @p value is a member.
+        [[nodiscard]] constexpr bool contains(std::byte value) const noexcept
+        {
+            const auto v = std::to_integer<unsigned>(value);
+            return ((words[v >> 6] >> (v & 63u)) & 1u) != 0;
+        }
+
+        /// Number of members.
+        [[nodiscard]] constexpr std::size_t count() const noexcept
+        {
+            std::size_t total = 0;
+            for (std::uint64_t word : words)
+            {
+                for (; word != 0; word &= word - 1)
+                {
+                    ++total;
+                }
+            }
+            return total;
+        }
+    };
+
+    /**
+     * @struct ByteClass
+     * @brief The exact member set of one class position, for a class its value/mask pair over-approximates.
+     * @details The position's bytes / mask entries hold the bits every member shares, so a masked compare already
+     *          rejects most non-members; @ref members then decides the rest. A position whose members are exactly the
+     *          values a value/mask pair admits (`[B8/F8]`, `[0D|0F]`) needs no ByteClass at all.
+     */
+    struct ByteClass
+    {
+        /// Fixed-byte index the class constrains.
+        std::size_t position{0};
+        /// The byte values the position accepts.
+        ByteSet members{};
+    };
+
+    /**
+     * @struct PatternGroup
+     * @brief One alternation group: @ref count equal-length alternatives at @ref position, any one of which must match.
+     * @details The group's positions also carry the tightest value/mask (and, where needed, a ByteClass) covering every
+     *          alternative, so the per-position checks run first; this record rejects a candidate that mixes bytes of
+     *          different alternatives. Alternative a is bytes[a][0, length) under mask[a][0, length); slots past
+     *          @ref count and @ref length are zero.
+     */
+    struct PatternGroup
+    {
+        /// Fixed-byte index of the group's first byte; the group never spans a bounded jump.
+        std::size_t position{0};
+        /// Bytes per alternative, in [1, MAX_GROUP_BYTES].
+        std::size_t length{0};
+        /// Number of alternatives, in [2, MAX_GROUP_ALTERNATIVES].
+        std::size_t count{0};
+        /// Pre-masked alternative bytes.
+        std::array<std::array<std::byte, MAX_GROUP_BYTES>, MAX_GROUP_ALTERNATIVES> bytes{};
+        /// Per-byte alternative masks.
+        std::array<std::array<std::byte, MAX_GROUP_BYTES>, MAX_GROUP_ALTERNATIVES> mask{};
+
+        /// True when some alternative matches @p at, which holds at least @ref length bytes.
+        [[nodiscard]] constexpr bool matches(std::span<const std::byte> at) const noexcept
+        {
+            for (std::size_t a = 0; a < count; ++a)
+            {
+                bool equal = true;
+                for (std::size_t i = 0; i < length && equal; ++i)
+                {
+                    equal = ((at[i] ^ bytes[a][i]) & mask[a][i]) == std::byte{0x00};
+                }
+                if (equal)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
     };
 
     /**
@@ -135,12 +258,16 @@ namespace DetourModKit::detail
      *          deliberately confined to segment 0 (the bytes before the first jump), because the matcher locates that
      *          first fixed run and then extends across the variable gaps: a byte in a later segment sits at an address
      *          that shifts with the gap, so it cannot drive the memchr prefilter.
+     *
+     *          A class or group position keeps the bits its members share in @ref bytes / @ref mask, so every masked
+     *          compare is a superset test; @ref classes and @ref groups hold the exact constraints that test leaves
+     *          open, in ascending position order, and a match must satisfy them too (see constraints_hold).
      */
     struct PatternBuffer
     {
         /// Pattern byte values; only entries [0, length) are valid.
         std::array<std::byte, MAX_PATTERN_BYTES> bytes{};
-        /// Per-byte match mask (0xFF literal, 0x00 wildcard, 0xF0 high nibble, 0x0F low nibble).
+        /// Per-byte match mask (0xFF literal, 0x00 wildcard, 0xF0 / 0x0F nibble, any other bit set for a class).
         std::array<std::byte, MAX_PATTERN_BYTES> mask{};
         /// Number of valid byte entries (all segments concatenated, gaps excluded).
         std::size_t length{0};
@@ -152,8 +279,91 @@ namespace DetourModKit::detail
         std::array<PatternJump, MAX_PATTERN_JUMPS> jumps{};
         /// Number of valid jump gaps; 0 for a plain (single-segment) pattern.
         std::size_t jump_count{0};
+        /// Exact class member sets in ascending position order; only entries [0, class_count) are valid.
+        std::array<ByteClass, MAX_PATTERN_CLASSES> classes{};
+        /// Number of valid classes; 0 when every position is exactly its value/mask pair.
+        std::size_t class_count{0};
+        /// Alternation groups in ascending position order; only entries [0, group_count) are valid.
+        std::array<PatternGroup, MAX_PATTERN_GROUPS> groups{};
+        /// Number of valid groups.
+        std::size_t group_count{0};
     };
 
+    /**
+     * @brief Checks the exact class and group constraints that fall inside one fixed run.
+     * @param classes The pattern's classes, ascending by position.
+     * @param groups The pattern's groups, ascending by position.
+     * @param run The memory the run occupies; run[0] holds fixed-byte index @p body_begin.
+     * @param body_begin First fixed-byte index of the run.
+     * @return True when every class and group inside [body_begin, body_begin + run.size()) is satisfied.
+     * @details Runs after the masked compare accepted the run, so it only settles what the class positions' shared bits
+     *          left open. A group never spans a jump, so it always lies wholly inside one run.
+     */
+    [[nodiscard]] constexpr bool constraints_hold(std::span<const ByteClass> classes,
+                                                  std::span<const PatternGroup> groups, std::span<const std::byte> run,
+                                                  std::size_t body_begin) noexcept
+    {
+        const std::size_t body_end = body_begin + run.size();
+        for (const ByteClass &entry : classes)
+        {
+            if (entry.position >= body_end)
+            {
+                break;
+            }
+            if (entry.position >= body_begin && !entry.members.contains(run[entry.position - body_begin]))
+            {
+                return false;
+            }
+        }
+        for (const PatternGroup &group : groups)
+        {
+            if (group.position >= body_end)
+            {
+                break;
+            }
+            if (group.position >= body_begin && group.position + group.length <= body_end &&
+                !group.matches(run.subspan(group.position - body_begin, group.length)))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// The valid classes of @p buffer.
+    [[nodiscard]] constexpr std::span<const ByteClass> classes_of(const PatternBuffer &buffer) noexcept
+    {
+        return std::span<const ByteClass>(buffer.classes.data(), buffer.class_count);
+    }
+
+    /// The valid groups of @p buffer.
+    [[nodiscard]] constexpr std::span<const PatternGroup> groups_of(const PatternBuffer &buffer) noexcept
+    {
+        return std::span<const PatternGroup>(buffer.groups.data(), buffer.group_count);
+    }
+
+    /**
+     * @brief True when fixed-byte position @p index of @p buffer accepts @p value on its own.
+     * @details The masked compare plus any class at the position. A group is read as its per-position classes here,
+     *          which is what a per-position consumer (the mismatch-counting approximate scans) can express.
+     */
+    [[nodiscard]] constexpr bool byte_admitted(const PatternBuffer &buffer, std::size_t index,
+                                               std::byte value) noexcept
+    {
+        if (((value ^ buffer.bytes[index]) & buffer.mask[index]) != std::byte{0x00})
+        {
+            return false;
+        }
+        for (const ByteClass &entry : classes_of(buffer))
+        {
+            if (entry.position == index)
+            {
+                return entry.members.contains(value);
+            }
+        }
+        return true;
+    }
+
     /**
      * @struct PatternParse
      * @brief A parse status paired with the buffer it produced (valid only when status == Ok).
@@ -357,6 +567,103 @@ namespace DetourModKit::detail
         return result;
     }
 
+    /**
+     * @brief Parses one masked byte token: `48`, `4?`, `?5`, `??` / `?`, or, when @p allow_bits is set, `VV/MM`.
+     * @param token The whitespace-free token.
+     * @param value Receives the pre-masked byte value.
+     * @param mask Receives the byte mask.
+     * @param allow_bits Admits the bit-set form `VV/MM` (value VV under bit mask MM), which only appears inside a class
+     *                   or group; VV may not set a bit outside MM.
+     * @return True on a well-formed token.
+     */
+    [[nodiscard]] constexpr bool parse_masked_byte(std::string_view token, std::byte &value, std::byte &mask,
+                                                   bool allow_bits) noexcept
+    {
+        if (token == "??" || token == "?")
+        {
+            value = std::byte{0x00};
+            mask = std::byte{0x00};
+            return true;
+        }
+        if (allow_bits && token.size() == 5 && token[2] == '/')
+        {
+            const int vh = hex_digit(token[0]);
+            const int vl = hex_digit(token[1]);
+            const int mh = hex_digit(token[3]);
+            const int ml = hex_digit(token[4]);
+            if (vh < 0 || vl < 0 || mh < 0 || ml < 0)
+            {
+                return false;
+            }
+            value = static_cast<std::byte>(static_cast<unsigned char>((vh << 4) | vl));
+            mask = static_cast<std::byte>(static_cast<unsigned char>((mh << 4) | ml));
+            return (value & ~mask) == std::byte{0x00};
+        }
+        if (token.size() != 2)
+        {
+            return false;
+        }
+        const int high = hex_digit(token[0]);
+        const int low = hex_digit(token[1]);
+        if (high >= 0 && low >= 0)
+        {
+            value = static_cast<std::byte>(static_cast<unsigned char>((high << 4) | low));
+            mask = std::byte{0xFF};
+        }
+        else if (high >= 0 && token[1] == '?')
+        {
+            value = static_cast<std::byte>(static_cast<unsigned char>(high << 4));
+            mask = std::byte{0xF0};
+        }
+        else if (token[0] == '?' && low >= 0)
+        {
+            value = static_cast<std::byte>(static_cast<unsigned char>(low));
+            mask = std::byte{0x0F};
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @struct ByteShape
+     * @brief The tightest value/mask pair covering a ByteSet, and whether that pair admits exactly the set.
+     */
+    struct ByteShape
+    {
+        std::byte value{0x00};
+        std::byte mask{0x00};
+        bool exact{false};
+    };
+
+    /// Keeps the bits every member of @p set agrees on; exact when the set is every value those bits admit.
+    [[nodiscard]] constexpr ByteShape shape_of(const ByteSet &set) noexcept
+    {
+        unsigned all = 0xFFu;
+        unsigned any = 0x00u;
+        for (unsigned v = 0; v < 256; ++v)
+        {
+            if (set.contains(static_cast<std::byte>(v)))
+            {
+                all &= v;
+                any |= v;
+            }
+        }
+        const unsigned mask = ~(all ^ any) & 0xFFu;
+        unsigned free_bits = 0;
+        for (unsigned bit = 0; bit < 8; ++bit)
+        {
+            free_bits += ((mask >> bit) & 1u) == 0 ? 1u : 0u;
+        }
+        ByteShape shape;
+        shape.value = static_cast<std::byte>(all & mask);
+        shape.mask = static_cast<std::byte>(mask);
+        shape.exact = set.count() == (std::size_t{1} << free_bits);
+        return shape;
+    }
+
     /**
      * @struct PatternBufferSink
      * @brief The fixed-array storage sink for the compile-time parse: caps at MAX_PATTERN_BYTES / MAX_PATTERN_JUMPS.
@@ -401,14 +708,172 @@ namespace DetourModKit::detail
             return true;
         }
 
+        /// Records an exact class; returns false when the class cap is reached (parser maps this to TooManyClasses).
+        [[nodiscard]] constexpr bool add_class(std::size_t position, const ByteSet &members) noexcept
+        {
+            if (buffer.class_count >= MAX_PATTERN_CLASSES)
+            {
+                return false;
+            }
+            buffer.classes[buffer.class_count] = ByteClass{position, members};
+            ++buffer.class_count;
+            return true;
+        }
+
+        /// Records an alternation group; returns false when the group cap is reached (TooManyClasses).
+        [[nodiscard]] constexpr bool add_group(const PatternGroup &group) noexcept
+        {
+            if (buffer.group_count >= MAX_PATTERN_GROUPS)
+            {
+                return false;
+            }
+            buffer.groups[buffer.group_count] = group;
+            ++buffer.group_count;
+            return true;
+        }
+
         /// Records the `|` marker position in the fixed byte stream.
         constexpr void set_offset(std::size_t position) noexcept { buffer.offset = position; }
     };
 
+    /// Appends one position accepting exactly @p members: its shared bits, plus a class when they over-approximate.
+    template <class Sink> [[nodiscard]] constexpr PatternStatus add_set_byte(Sink &sink, const ByteSet &members)
+    {
+        const ByteShape shape = shape_of(members);
+        const std::size_t position = sink.length();
+        if (!sink.add_byte(shape.value, shape.mask))
+        {
+            return PatternStatus::TooLong;
+        }
+        if (!shape.exact && !sink.add_class(position, members))
+        {
+            return PatternStatus::TooManyClasses;
+        }
+        return PatternStatus::Ok;
+    }
+
+    /**
+     * @brief Parses a class token, `[0D|15]`, `[4?|5?]` or `[B8/F8]`, into one constrained position.
+     * @details Members are separated by `|`; each is a hex byte, a nibble, or a bit-set `VV/MM`. A wildcard member, an
+     *          empty member, or any other shape is InvalidClass.
+     */
+    template <class Sink> [[nodiscard]] constexpr PatternStatus parse_class_token(std::string_view token, Sink &sink)
+    {
+        if (token.size() < 3 || token.back() != ']')
+        {
+            return PatternStatus::InvalidClass;
+        }
+        const std::string_view inner = token.substr(1, token.size() - 2);
+        ByteSet members{};
+        std::size_t begin = 0;
+        while (begin <= inner.size())
+        {
+            std::size_t stop = inner.find('|', begin);
+            if (stop == std::string_view::npos)
+            {
+                stop = inner.size();
+            }
+            std::byte value{0x00};
+            std::byte mask{0x00};
+            if (!parse_masked_byte(inner.substr(begin, stop - begin), value, mask, true) || mask == std::byte{0x00})
+            {
+                return PatternStatus::InvalidClass;
+            }
+            members.add_masked(std::to_integer<std::uint8_t>(value), std::to_integer<std::uint8_t>(mask));
+            begin = stop + 1;
+        }
+        return add_set_byte(sink, members);
+    }
+
+    /**
+     * @brief Parses an alternation group, `(48 8B 0D|48 8B 15)`, into its positions and, when needed, a group record.
+     * @details Between two and MAX_GROUP_ALTERNATIVES alternatives separated by `|`, each the same number (at most
+     *          MAX_GROUP_BYTES) of byte tokens: hex, nibble, wildcard, or bit-set. Every position takes the set its
+     *          alternatives admit. The group record is kept only when the alternatives differ at more than one
+     *          position, since otherwise the per-position sets already accept exactly the alternatives.
+     */
+    template <class Sink> [[nodiscard]] constexpr PatternStatus parse_group_token(std::string_view token, Sink &sink)
+    {
+        const std::string_view inner = token.substr(1, token.size() - 2);
+        PatternGroup group{};
+        group.position = sink.length();
+        std::size_t begin = 0;
+        while (begin <= inner.size())
+        {
+            std::size_t stop = inner.find('|', begin);
+            if (stop == std::string_view::npos)
+            {
+                stop = inner.size();
+            }
+            if (group.count >= MAX_GROUP_ALTERNATIVES)
+            {
+                return PatternStatus::InvalidClass;
+            }
+            const std::string_view alternative = inner.substr(begin, stop - begin);
+            std::size_t length = 0;
+            std::size_t cursor = 0;
+            while (cursor < alternative.size())
+            {
+                if (is_token_space(alternative[cursor]))
+                {
+                    ++cursor;
+                    continue;
+                }
+                const std::size_t start = cursor;
+                while (cursor < alternative.size() && !is_token_space(alternative[cursor]))
+                {
+                    ++cursor;
+                }
+                if (length >= MAX_GROUP_BYTES ||
+                    !parse_masked_byte(alternative.substr(start, cursor - start), group.bytes[group.count][length],
+                                       group.mask[group.count][length], true))
+                {
+                    return PatternStatus::InvalidClass;
+                }
+                ++length;
+            }
+            if (length == 0 || (group.count != 0 && length != group.length))
+            {
+                return PatternStatus::InvalidClass;
+            }
+            group.length = length;
+            ++group.count;
+            begin = stop + 1;
+        }
+        if (group.count < 2)
+        {
+            return PatternStatus::InvalidClass;
+        }
+
+        std::size_t varying = 0;
+        for (std::size_t i = 0; i < group.length; ++i)
+        {
+            ByteSet members{};
+            bool same = true;
+            for (std::size_t a = 0; a < group.count; ++a)
+            {
+                members.add_masked(std::to_integer<std::uint8_t>(group.bytes[a][i]),
+                                   std::to_integer<std::uint8_t>(group.mask[a][i]));
+                same = same && group.bytes[a][i] == group.bytes[0][i] && group.mask[a][i] == group.mask[0][i];
+            }
+            varying += same ? 0u : 1u;
+            if (const PatternStatus status = add_set_byte(sink, members); status != PatternStatus::Ok)
+            {
+                return status;
+            }
+        }
+        if (varying > 1 && !sink.add_group(group))
+        {
+            return PatternStatus::TooManyClasses;
+        }
+        return PatternStatus::Ok;
+    }
+
     /**
      * @brief The single AOB DSL grammar, parsing into any storage sink (fixed-array or heap-backed).
      * @param dsl The whitespace-separated token string, e.g. "48 8B 05 ?? ?? ?? ??".
-     * @param sink The storage sink; its add_byte / add_jump / set_offset / length / jump_count drive where tokens land.
+     * @param sink The storage sink; its add_byte / add_jump / add_class / add_group / set_offset / length /
+     *             jump_count drive where tokens land.
      * @return The parse status. On Ok the sink holds the compiled bytes / mask / jumps / offset (the anchor, which is
      *         storage-specific, is computed by the caller afterwards).
      * @details This is the one implementation of the grammar, so the compile-time Pattern and the runtime EnginePattern
@@ -420,10 +885,14 @@ namespace DetourModKit::detail
      *          - `?` then hex digit (`?5`)   -> low nibble fixed, mask 0x0F
      *          - `[X]` / `[X-Y]`             -> bounded jump: skip exactly X, or between X and Y, bytes before the next
      *                                           segment; splits the pattern into segments recorded as jumps
+     *          - `[0D|15]` / `[B8/F8]`       -> byte class: one byte that is any listed member, where a member is a hex
+     *                                           byte, a nibble, or a bit-set `VV/MM` (value VV under bit mask MM)
+     *          - `(48 8B 0D|48 8B 15)`       -> alternation group: equal-length byte runs, any one of which matches
      *          - `|`                         -> offset marker: records the position of the NEXT byte (or the length
      *                                           when trailing) as the result offset; permitted at most once
-     *          Any other token shape fails with InvalidToken. An input with no byte tokens fails with Empty. A sink that
-     *          rejects an append fails with TooLong (byte cap) or TooManyJumps (jump cap).
+     *          Any other token shape fails with InvalidToken, and a malformed class or group with InvalidClass. An
+     *          input with no byte tokens fails with Empty. A sink that rejects an append fails with TooLong (byte cap),
+     *          TooManyJumps (jump cap), or TooManyClasses (class or group cap).
      *
      *          Jump placement follows the YARA hex-string rule so every segment is a non-empty fixed run: a jump may not
      *          lead or trail the pattern and two jumps may not be adjacent (there is always at least one fixed byte
@@ -456,6 +925,25 @@ namespace DetourModKit::detail
             }
 
             const std::size_t token_start = cursor;
+            if (dsl[cursor] == '(')
+            {
+                // An alternation group spans whitespace, so it runs to its closing parenthesis instead.
+                while (cursor < end && dsl[cursor] != ')')
+                {
+                    ++cursor;
+                }
+                if (cursor == end || (cursor + 1 < end && !is_token_space(dsl[cursor + 1])))
+                {
+                    return PatternStatus::InvalidClass;
+                }
+                ++cursor;
+                if (const PatternStatus status = parse_group_token(dsl.substr(token_start, cursor - token_start), sink);
+                    status != PatternStatus::Ok)
+                {
+                    return status;
+                }
+                continue;
+            }
             while (cursor < end && !is_token_space(dsl[cursor]))
             {
                 ++cursor;
@@ -475,10 +963,20 @@ namespace DetourModKit::detail
                 continue;
             }
 
-            // Bounded jump: `[X]` or `[X-Y]`. A token that opens with `[` is always intended as a jump, so a malformed
+            // Byte class: a bracket token naming a `|` member list or a `/` bit mask, which no jump contains.
+            if (token.front() == '[' && token.find_first_of("|/") != std::string_view::npos)
+            {
+                if (const PatternStatus status = parse_class_token(token, sink); status != PatternStatus::Ok)
+                {
+                    return status;
+                }
+                continue;
+            }
+
+            // Bounded jump: `[X]` or `[X-Y]`. Any other token that opens with `[` is intended as a jump, so a malformed
             // bracket form is a hard InvalidJump rather than falling through to the byte-token parser (which would
             // otherwise misreport it as a generic InvalidToken).
-            if (!token.empty() && token.front() == '[')
+            if (token.front() == '[')
             {
                 const JumpParse jump = parse_jump_token(token);
                 if (!jump.ok)
@@ -501,41 +999,10 @@ namespace DetourModKit::detail
 
             std::byte byte_value{0x00};
             std::byte mask_value{0x00};
-            const bool double_wildcard = token.size() == 2 && token[0] == '?' && token[1] == '?';
-            const bool single_wildcard = token.size() == 1 && token[0] == '?';
-            if (double_wildcard || single_wildcard)
-            {
-                // Full wildcard: any byte matches, so both value and mask stay zero.
-            }
-            else if (token.size() == 2)
-            {
-                const int high = hex_digit(token[0]);
-                const int low = hex_digit(token[1]);
-                if (high >= 0 && low >= 0)
-                {
-                    byte_value = static_cast<std::byte>(static_cast<unsigned char>((high << 4) | low));
-                    mask_value = std::byte{0xFF};
-                }
-                else if (high >= 0 && token[1] == '?')
-                {
-                    byte_value = static_cast<std::byte>(static_cast<unsigned char>(high << 4));
-                    mask_value = std::byte{0xF0};
-                }
-                else if (token[0] == '?' && low >= 0)
-                {
-                    byte_value = static_cast<std::byte>(static_cast<unsigned char>(low));
-                    mask_value = std::byte{0x0F};
-                }
-                else
-                {
-                    return PatternStatus::InvalidToken;
-                }
-            }
-            else
+            if (!parse_masked_byte(token, byte_value, mask_value, false))
             {
                 return PatternStatus::InvalidToken;
             }
-
             if (!sink.add_byte(byte_value, mask_value))
             {
                 return PatternStatus::TooLong;
@@ -579,6 +1046,132 @@ namespace DetourModKit::detail
         return result;
     }
 
+    // Every member of each class passes its position's masked compare, and the classes ascend inside the pattern.
+    [[nodiscard]] constexpr bool classes_well_formed(const PatternBuffer &buffer) noexcept
+    {
+        if (buffer.class_count > MAX_PATTERN_CLASSES)
+        {
+            return false;
+        }
+        for (std::size_t index = 0; index < buffer.class_count; ++index)
+        {
+            const ByteClass &entry = buffer.classes[index];
+            if (entry.position >= buffer.length || (index != 0 && entry.position <= buffer.classes[index - 1].position))
+            {
+                return false;
+            }
+            const auto value = std::to_integer<unsigned>(buffer.bytes[entry.position]);
+            const auto mask = std::to_integer<unsigned>(buffer.mask[entry.position]);
+            for (unsigned v = 0; v < 256; ++v)
+            {
+                if (entry.members.contains(static_cast<std::byte>(v)) && ((v ^ value) & mask) != 0)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Each group ascends, fits one segment, and has alternatives no looser than its positions' masks require.
+    [[nodiscard]] constexpr bool groups_well_formed(const PatternBuffer &buffer) noexcept
+    {
+        if (buffer.group_count > MAX_PATTERN_GROUPS)
+        {
+            return false;
+        }
+        std::size_t taken = 0;
+        for (std::size_t index = 0; index < buffer.group_count; ++index)
+        {
+            const PatternGroup &group = buffer.groups[index];
+            if (group.length == 0 || group.length > MAX_GROUP_BYTES || group.count < 2 ||
+                group.count > MAX_GROUP_ALTERNATIVES || group.position < taken ||
+                group.position + group.length > buffer.length)
+            {
+                return false;
+            }
+            for (std::size_t j = 0; j < buffer.jump_count; ++j)
+            {
+                const std::size_t cut = buffer.jumps[j].position;
+                if (cut > group.position && cut < group.position + group.length)
+                {
+                    return false;
+                }
+            }
+            for (std::size_t a = 0; a < MAX_GROUP_ALTERNATIVES; ++a)
+            {
+                for (std::size_t i = 0; i < MAX_GROUP_BYTES; ++i)
+                {
+                    const std::byte value = group.bytes[a][i];
+                    const std::byte mask = group.mask[a][i];
+                    if (a >= group.count || i >= group.length)
+                    {
+                        if (value != std::byte{0x00} || mask != std::byte{0x00})
+                        {
+                            return false;
+                        }
+                        continue;
+                    }
+                    const std::byte required = buffer.mask[group.position + i];
+                    if ((value & ~mask) != std::byte{0x00} || (mask & required) != required ||
+                        ((value ^ buffer.bytes[group.position + i]) & required) != std::byte{0x00})
+                    {
+                        return false;
+                    }
+                }
+            }
+            taken = group.position + group.length;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reports whether @p buffer has a shape @ref parse_pattern could have produced, ignoring its anchor.
+     * @details For a buffer read back from outside the process (a compiled binary manifest), which must be checked
+     *          before anything indexes it: a length in [1, MAX_PATTERN_BYTES], an offset not past the length, no
+     *          value bit outside its mask, every slot past the length zeroed, and at most MAX_PATTERN_JUMPS jumps
+     *          placed strictly inside the pattern in ascending, non-adjacent order with bounds no wider than
+     *          MAX_JUMP_SPAN. Classes and groups must sit in ascending order inside the pattern, a group inside one
+     *          segment, and admit nothing their position's value/mask rejects, so the masked compare stays a superset
+     *          test. The anchor is not stored state worth trusting; re-select it.
+     */
+    [[nodiscard]] constexpr bool is_well_formed_buffer(const PatternBuffer &buffer) noexcept
+    {
+        if (buffer.length == 0 || buffer.length > MAX_PATTERN_BYTES || buffer.offset > buffer.length ||
+            buffer.jump_count > MAX_PATTERN_JUMPS)
+        {
+            return false;
+        }
+        for (std::size_t index = 0; index < MAX_PATTERN_BYTES; ++index)
+        {
+            const std::byte mask = buffer.mask[index];
+            if (index >= buffer.length)
+            {
+                if (mask != std::byte{0x00} || buffer.bytes[index] != std::byte{0x00})
+                {
+                    return false;
+                }
+                continue;
+            }
+            if ((buffer.bytes[index] & ~mask) != std::byte{0x00})
+            {
+                return false;
+            }
+        }
+        std::size_t previous = 0;
+        for (std::size_t index = 0; index < buffer.jump_count; ++index)
+        {
+            const PatternJump &jump = buffer.jumps[index];
+            if (jump.position <= previous || jump.position >= buffer.length || jump.min_skip > jump.max_skip ||
+                jump.max_skip > MAX_JUMP_SPAN)
+            {
+                return false;
+            }
+            previous = jump.position;
+        }
+        return classes_well_formed(buffer) && groups_well_formed(buffer);
+    }
+
     /**
      * @brief The fewest bytes any match of @p buffer can occupy (fixed bytes plus every gap's minimum skip).
      * @details A jump-free pattern's minimum span is just its length. With gaps the shortest possible match still
@@ -618,8 +1211,8 @@ namespace DetourModKit::detail
      * @param body_end One-past-last fixed-byte index of the run.
      * @return True when the run fits in the window from @p window_pos and every masked byte agrees.
      * @details The per-byte test is the same `(memory ^ pattern) & mask == 0` the scan engine uses, so a wildcard byte
-     *          always agrees and a nibble mask compares only its fixed nibble. A run that would read past the window end
-     *          cannot match.
+     *          always agrees and a nibble mask compares only its fixed nibble; the run's classes and groups are then
+     *          checked exactly. A run that would read past the window end cannot match.
      */
     [[nodiscard]] constexpr bool run_matches_at(const PatternBuffer &buffer, std::span<const std::byte> window,
                                                 std::size_t window_pos, std::size_t body_begin,
@@ -639,7 +1232,8 @@ namespace DetourModKit::detail
                 return false;
             }
         }
-        return true;
+        return constraints_hold(classes_of(buffer), groups_of(buffer), window.subspan(window_pos, run_length),
+                                body_begin);
     }
 
     /**
@@ -0,0 +1,212 @@
+#ifndef DETOURMODKIT_DETAIL_PATTERN_KERNEL_HPP
+#define DETOURMODKIT_DETAIL_PATTERN_KERNEL_HPP
+
+/**
+ * @file pattern_kernel.hpp
+ * @brief Compile-time specialized verifiers for in-source pattern literals: the `scan::scan<"...">` and
+ *        `scan::unchecked::find_pattern<"...">` kernels.
+ * @details A runtime pattern is verified by the engine's generic loop, which loads the pattern bytes and mask from the
+ *          heap for every candidate. A literal known at compile time can do better: its length, the lanes that carry
+ *          a literal, and the lanes that carry a nibble are all constants. plan_kernel() turns a PatternBuffer into a
+ *          short list of 16-, 8-, or 1-byte compare steps, and pattern_kernel() unrolls that list into straight-line
+ *          code with the expected bytes as constants. A step without nibble lanes needs no mask at all: wildcard lanes
+ *          are dropped by a 16-bit immediate on the compare's movemask. The engine still runs its anchor prefilter
+ *          and calls the kernel only on a candidate, so the kernel never decides where to look, only whether a
+ *          candidate matches.
+ * @note Like pattern_core.hpp this is implementation support scan.hpp needs at compile time, so it is installed. The
+ *       kernels cover jump-free patterns; kernel_for() returns nullptr for a pattern with bounded jumps, which keeps
+ *       the engine's segmented matchers. At a class position a kernel compares only the bits the members share, so
+ *       the engine settles classes and groups exactly after the kernel accepts a candidate.
+ */
+
+#include "DetourModKit/defines.hpp"
+#include "DetourModKit/detail/pattern_core.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#include <emmintrin.h>
+
+namespace DetourModKit::detail
+{
+    /// A verifier for one compiled pattern: true when the whole fixed pattern matches at @p candidate.
+    using PatternKernel = bool (*)(const std::byte *candidate) noexcept;
+
+    /**
+     * @struct PatternText
+     * @brief A string literal usable as a template argument, so a pattern's DSL can parameterize its kernel.
+     * @details Deduced from the literal, e.g. `scan::scan<"48 8B 05 ?? ?? ?? ??">(scope)`. The terminating NUL is
+     *          stored but not part of view().
+     */
+    template <std::size_t N> struct PatternText
+    {
+        std::array<char, N> text{};
+
+        consteval PatternText(const char (&literal)[N]) noexcept
+        {
+            for (std::size_t i = 0; i < N; ++i)
+            {
+                text[i] = literal[i];
+            }
+        }
+
+        [[nodiscard]] constexpr std::string_view view() const noexcept
+        {
+            return std::string_view(text.data(), N - 1);
+        }
+    };
+
+    /**
+     * @struct KernelStep
+     * @brief One unrolled compare of a kernel: @ref width bytes at @ref offset from the candidate start.
+     * @details @ref bytes holds the expected values (pre-masked, as in PatternBuffer) and @ref mask the lane masks,
+     *          lane j covering pattern byte offset + j. Bit j of @ref lanes is set for every lane that constrains
+     *          memory and was not already checked by an earlier step. @ref nibbles marks a step with a partially
+     *          masked lane, the only kind that applies @ref mask.
+     */
+    struct KernelStep
+    {
+        std::size_t offset = 0;
+        std::size_t width = 0;
+        std::array<std::uint8_t, 16> bytes{};
+        std::array<std::uint8_t, 16> mask{};
+        std::uint32_t lanes = 0;
+        bool nibbles = false;
+    };
+
+    /// Most steps a plan can hold: 16-byte chunks covering MAX_PATTERN_BYTES, or seven 1-byte steps for a short one.
+    inline constexpr std::size_t KERNEL_MAX_STEPS = MAX_PATTERN_BYTES / 16 + 1;
+    static_assert(KERNEL_MAX_STEPS >= 7, "A sub-8-byte pattern needs up to seven single-byte steps.");
+
+    /// The unrolled compare list for one pattern; only steps [0, count) are meaningful.
+    struct KernelPlan
+    {
+        std::array<KernelStep, KERNEL_MAX_STEPS> steps{};
+        std::size_t count = 0;
+    };
+
+    /**
+     * @brief Splits a jump-free pattern into the kernel's compare steps.
+     * @details A pattern of 16 bytes or more is covered by 16-byte chunks, the last one overlapping its predecessor so
+     *          no read passes the pattern's end. One of 8 to 15 bytes uses one or two 8-byte chunks the same way, and
+     *          a shorter one compares each constrained byte on its own. A chunk whose lanes are all wildcards, or all
+     *          already checked, emits no step.
+     */
+    [[nodiscard]] consteval KernelPlan plan_kernel(const PatternBuffer &buffer) noexcept
+    {
+        KernelPlan plan;
+        const std::size_t length = buffer.length;
+        const std::size_t width = length >= 16 ? 16 : (length >= 8 ? 8 : 1);
+        std::size_t covered = 0;
+        while (covered < length)
+        {
+            const std::size_t offset = (covered + width <= length) ? covered : length - width;
+            KernelStep step;
+            step.offset = offset;
+            step.width = width;
+            for (std::size_t lane = 0; lane < width; ++lane)
+            {
+                const std::size_t index = offset + lane;
+                const auto value = static_cast<std::uint8_t>(buffer.bytes[index]);
+                const auto mask = static_cast<std::uint8_t>(buffer.mask[index]);
+                step.bytes[lane] = value;
+                step.mask[lane] = mask;
+                if (index >= covered && mask != 0x00)
+                {
+                    step.lanes |= std::uint32_t{1} << lane;
+                    step.nibbles = step.nibbles || mask != 0xFF;
+                }
+            }
+            if (step.lanes != 0)
+            {
+                plan.steps[plan.count] = step;
+                ++plan.count;
+            }
+            covered = offset + width;
+        }
+        return plan;
+    }
+
+    /// The 16 lanes of @p values as an SSE2 constant.
+    [[nodiscard]] DMK_FORCE_INLINE __m128i kernel_constant(const std::array<std::uint8_t, 16> &values) noexcept
+    {
+        return _mm_setr_epi8(static_cast<char>(values[0]), static_cast<char>(values[1]), static_cast<char>(values[2]),
+                             static_cast<char>(values[3]), static_cast<char>(values[4]), static_cast<char>(values[5]),
+                             static_cast<char>(values[6]), static_cast<char>(values[7]), static_cast<char>(values[8]),
+                             static_cast<char>(values[9]), static_cast<char>(values[10]),
+                             static_cast<char>(values[11]), static_cast<char>(values[12]),
+                             static_cast<char>(values[13]), static_cast<char>(values[14]),
+                             static_cast<char>(values[15]));
+    }
+
+    /// Runs one compare step against the candidate at @p candidate.
+    template <KernelStep Step>
+    [[nodiscard]] DMK_NO_SANITIZE_ADDRESS DMK_FORCE_INLINE bool kernel_step(const std::byte *candidate) noexcept
+    {
+        const std::byte *const at = candidate + Step.offset;
+        if constexpr (Step.width == 1)
+        {
+            const auto value = static_cast<std::uint8_t>(*at);
+            if constexpr (Step.mask[0] == 0xFF)
+            {
+                return value == Step.bytes[0];
+            }
+            else
+            {
+                return static_cast<std::uint8_t>(value & Step.mask[0]) == Step.bytes[0];
+            }
+        }
+        else
+        {
+            __m128i memory;
+            if constexpr (Step.width == 16)
+            {
+                memory = _mm_loadu_si128(reinterpret_cast<const __m128i *>(at));
+            }
+            else
+            {
+                memory = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(at));
+            }
+            if constexpr (Step.nibbles)
+            {
+                memory = _mm_and_si128(memory, kernel_constant(Step.mask));
+            }
+            const auto equal =
+                static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(memory, kernel_constant(Step.bytes))));
+            return (equal & Step.lanes) == Step.lanes;
+        }
+    }
+
+    template <KernelPlan Plan, std::size_t... Index>
+    [[nodiscard]] DMK_NO_SANITIZE_ADDRESS DMK_FORCE_INLINE bool run_kernel(const std::byte *candidate,
+                                                                           std::index_sequence<Index...>) noexcept
+    {
+        return (kernel_step<Plan.steps[Index]>(candidate) && ...);
+    }
+
+    /// The specialized verifier for @p Buffer; see the file comment.
+    template <PatternBuffer Buffer>
+    [[nodiscard]] DMK_NO_SANITIZE_ADDRESS bool pattern_kernel(const std::byte *candidate) noexcept
+    {
+        static constexpr KernelPlan plan = plan_kernel(Buffer);
+        return run_kernel<plan>(candidate, std::make_index_sequence<plan.count>{});
+    }
+
+    /// The kernel for @p Buffer, or nullptr when it has bounded jumps (those keep the engine's own matchers).
+    template <PatternBuffer Buffer> [[nodiscard]] consteval PatternKernel kernel_for() noexcept
+    {
+        if constexpr (Buffer.jump_count == 0 && Buffer.length > 0)
+        {
+            return &pattern_kernel<Buffer>;
+        }
+        else
+        {
+            return nullptr;
+        }
+    }
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_DETAIL_PATTERN_KERNEL_HPP
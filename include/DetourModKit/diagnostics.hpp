@@ -5,18 +5,22 @@
  * @file diagnostics.hpp
  * @brief Consumer-queryable counters for DMK's intentional leak / detach paths, a process-wide diagnostic event bus
  *        for scanner-fault and hook-lifecycle transitions, and a one-call runtime-diagnostics @ref
- *        DetourModKit::diagnostics::Snapshot aggregator.
+ *        DetourModKit::diagnostics::Snapshot aggregator that also samples the metrics registry (metrics.hpp).
  */
 
 #include "DetourModKit/anchor.hpp"
 #include "DetourModKit/detail/event_dispatcher.hpp"
+#include "DetourModKit/metrics.hpp"
 #include "DetourModKit/rtti_dissect.hpp"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -164,6 +168,71 @@ namespace DetourModKit
          */
         EventDispatcher<HookLifecycleEvent> &hook_lifecycle();
 
+        /// Number of log2 latency buckets in a @ref HookStats histogram.
+        inline constexpr std::size_t HOOK_LATENCY_BUCKETS = 32;
+
+        /**
+         * @struct HookStats
+         * @brief One live hook's call count and latency histogram, reported by @ref collect.
+         * @details Recorded only in a build with `DMK_ENABLE_HOOK_STATS` defined (CMake option of the same name). For
+         *          an inline hook each sample is one guarded @ref hook::Hook::call / @ref hook::Hook::try_call into the
+         *          original, timed from gate entry to return; for a mid hook it is one run of the detour body. Calls
+         *          made through the raw @ref hook::Hook::original pointer, and VMT slots (the game calls the detour
+         *          directly), pass no library-owned call site and are not counted.
+         *
+         *          Latencies are in QPC ticks (see @ref Snapshot::hook_stats_tick_frequency). Bucket 0 counts
+         *          zero-tick samples, bucket `i` counts samples of `[2^(i-1), 2^i)` ticks, and the last bucket also
+         *          absorbs everything longer. Shards are summed with relaxed loads, so under live traffic @ref calls
+         *          and the bucket sum may differ by the calls in flight.
+         */
+        struct HookStats
+        {
+            /// The hook name given at install.
+            std::string name;
+            /// The hook's process-unique ledger id (the one its @ref HookLifecycleEvent carries).
+            std::uint64_t ledger_id = 0;
+            /// The hook flavor.
+            HookKind kind = HookKind::Inline;
+            /// Samples recorded.
+            std::uint64_t calls = 0;
+            /// Sum of every sample, in ticks.
+            std::uint64_t total_ticks = 0;
+            /// Log2-bucketed sample counts.
+            std::array<std::uint64_t, HOOK_LATENCY_BUCKETS> latency_buckets{};
+        };
+
+        /// One named phase of a lifecycle transition and its wall-clock time.
+        struct PhaseTiming
+        {
+            std::string name;
+            std::chrono::microseconds elapsed{0};
+        };
+
+        /**
+         * @struct LifecycleTimings
+         * @brief Per-phase wall-clock timings of the most recent session start, startup, teardown and Logic DLL unload.
+         * @details Each list holds the last run of its transition, in the order the phases ran, and is empty until that
+         *          transition has happened in this process. The phases are the library's own steps: Session::start's
+         *          process gate, instance mutex and logger start; each subsystem drain or join of the ordered teardown;
+         *          the steps of on_logic_dll_unload. The mod's own scans, hook installs and config load show up as the
+         *          stages of its last run_startup_pipeline call, and as a whole in @ref on_ready.
+         */
+        struct LifecycleTimings
+        {
+            /// Session::start (or bootstrap's setup): process_gate, instance_mutex, logger_start.
+            std::vector<PhaseTiming> start;
+            /// The bootstrap worker's on_ready call; 0 on the synchronous Session::start path.
+            std::chrono::microseconds on_ready{0};
+            /// Each stage of the last run_startup_pipeline call, by stage name; a skipped stage reports 0.
+            std::vector<PhaseTiming> startup_stages;
+            /// The last ordered ~Session teardown: scope_clear, then each subsystem shutdown, logger last.
+            std::vector<PhaseTiming> teardown;
+            /// From the request_shutdown() or bootstrap_detach() that ended the last session to its teardown's end.
+            std::chrono::microseconds shutdown_latency{0};
+            /// The last on_logic_dll_unload / on_logic_dll_unload_all.
+            std::vector<PhaseTiming> unload;
+        };
+
         /**
          * @struct Snapshot
          * @brief A point-in-time aggregate of DMK's runtime diagnostics, produced by @ref collect.
@@ -195,15 +264,32 @@ namespace DetourModKit
 
             /// Robustness roll-up of the supplied anchor report (empty when no anchor report is passed).
             anchor::AnchorQuality anchor_quality{};
+
+            /// Per-hook call statistics of the live hooks; empty unless built with `DMK_ENABLE_HOOK_STATS`.
+            std::vector<HookStats> hook_stats;
+            /// QPC ticks per second for @ref hook_stats latencies (the @ref Profiler clock); 0 when stats are off.
+            std::int64_t hook_stats_tick_frequency = 0;
+
+            /// Phase timings of the latest session start, startup, teardown and unload.
+            LifecycleTimings lifecycle;
+
+            /**
+             * @brief Every metric registered through @ref register_counter, @ref register_gauge and
+             *        @ref register_histogram, in registration order, followed by the library's `memory.cache.*` values
+             *        and, in a `DMK_ENABLE_SCAN_TELEMETRY` build, the `scan.telemetry.*` totals.
+             */
+            std::vector<MetricSample> metrics;
         };
 
         /**
          * @brief Aggregates DMK's live diagnostics into one @ref Snapshot.
-         * @details Reads the process-wide intentional-leak counters and the live hook population (derived from the
-         *          hook-lifecycle transition stream), and rolls up the two caller-owned reports: it counts healed vs
-         *          failed entries in @p drift_report (typically @ref rtti::heal_report output) and runs
-         *          @ref anchor::assess_quality over @p anchor_report (typically a resolve_all output). Pass an empty
-         *          span to skip either summary.
+         * @details Reads the process-wide intentional-leak counters, the live hook population (derived from the
+         *          hook-lifecycle transition stream), the @ref LifecycleTimings of the latest session transitions,
+         *          every registered metric and the memory cache's counters (@ref Snapshot::metrics), and, in a
+         *          `DMK_ENABLE_HOOK_STATS` build, each live hook's @ref HookStats, and rolls up the two
+         *          caller-owned reports: it counts healed vs failed entries in @p drift_report (typically
+         *          @ref rtti::heal_report output) and runs @ref anchor::assess_quality over @p anchor_report
+         *          (typically a resolve_all output). Pass an empty span to skip either summary.
          * @param drift_report A self-heal drift report, or an empty span to skip the drift summary.
          * @param anchor_report An anchor drift report, or an empty span to skip the anchor-quality summary.
          * @return The aggregated snapshot.
@@ -0,0 +1,175 @@
+#ifndef DETOURMODKIT_DIAGNOSTICS_EXPORT_HPP
+#define DETOURMODKIT_DIAGNOSTICS_EXPORT_HPP
+
+/**
+ * @file diagnostics_export.hpp
+ * @brief Publishes a periodic @ref DetourModKit::diagnostics::collect sample into a named shared-memory section that
+ *        an overlay or monitor in another process can poll, and decodes that section.
+ * @details A @ref DetourModKit::diagnostics::SharedExport owns a fixed-size, pagefile-backed section named
+ *          @ref DetourModKit::diagnostics::shared_export_name (by default) and republishes it from DMK's
+ *          shared background thread every period. Game threads do no work for it. A reader maps the section
+ *          read-only and copies it under the section's seqlock, so reading at any rate never blocks or slows the
+ *          publisher.
+ *
+ *          The format is little-endian and fixed:
+ *
+ *            header  (EXPORT_HEADER_SIZE bytes)   magic u64, version u32, section size u32, sequence u64 (odd while
+ *                                                 a publish is in progress, 0 before the first), UTC publish time in
+ *                                                 microseconds i64, reserved
+ *            summary (EXPORT_SUMMARY_SIZE bytes)  one u64 per LeakSubsystem, hooks total / active / disabled u64,
+ *                                                 metric count u32, metrics dropped u32
+ *            metrics (EXPORT_MAX_METRICS records of EXPORT_METRIC_SIZE bytes)
+ *                                                 name (EXPORT_METRIC_NAME_SIZE bytes, NUL-padded), kind u8,
+ *                                                 reserved, count u64, value i64, sum u64, then
+ *                                                 METRIC_HISTOGRAM_BUCKETS u64 buckets
+ *
+ *          A reader copies the whole section, and keeps the copy only when the sequence was even and unchanged across
+ *          the copy. The drift and anchor summaries and the per-hook statistics of a @ref Snapshot are not exported:
+ *          the first two need the caller's reports, and the hook list is unbounded.
+ */
+
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/metrics.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace diagnostics
+    {
+        /// "DMKDIAG1" read as a little-endian u64.
+        inline constexpr std::uint64_t EXPORT_MAGIC = 0x31474149444B4D44ULL;
+        inline constexpr std::uint32_t EXPORT_VERSION = 1;
+        inline constexpr std::size_t EXPORT_HEADER_SIZE = 64;
+        inline constexpr std::size_t EXPORT_SUMMARY_SIZE = 96;
+        inline constexpr std::size_t EXPORT_MAX_METRICS = 128;
+        /// Longest metric name the section holds; a longer one is cut.
+        inline constexpr std::size_t EXPORT_METRIC_NAME_SIZE = 64;
+        inline constexpr std::size_t EXPORT_METRIC_SIZE = EXPORT_METRIC_NAME_SIZE + 32 + METRIC_HISTOGRAM_BUCKETS * 8;
+        inline constexpr std::size_t EXPORT_SECTION_SIZE =
+            EXPORT_HEADER_SIZE + EXPORT_SUMMARY_SIZE + EXPORT_MAX_METRICS * EXPORT_METRIC_SIZE;
+
+        /// Byte offsets of the header and summary fields, from the start of the section.
+        inline constexpr std::size_t EXPORT_MAGIC_OFFSET = 0;
+        inline constexpr std::size_t EXPORT_VERSION_OFFSET = 8;
+        inline constexpr std::size_t EXPORT_SIZE_OFFSET = 12;
+        inline constexpr std::size_t EXPORT_SEQUENCE_OFFSET = 16;
+        inline constexpr std::size_t EXPORT_TIME_OFFSET = 24;
+        inline constexpr std::size_t EXPORT_LEAKS_OFFSET = EXPORT_HEADER_SIZE;
+        inline constexpr std::size_t EXPORT_HOOKS_OFFSET =
+            EXPORT_LEAKS_OFFSET + static_cast<std::size_t>(LeakSubsystem::Count) * 8;
+        inline constexpr std::size_t EXPORT_METRIC_COUNT_OFFSET = EXPORT_HOOKS_OFFSET + 24;
+        inline constexpr std::size_t EXPORT_METRICS_DROPPED_OFFSET = EXPORT_METRIC_COUNT_OFFSET + 4;
+        inline constexpr std::size_t EXPORT_METRICS_OFFSET = EXPORT_HEADER_SIZE + EXPORT_SUMMARY_SIZE;
+
+        static_assert(EXPORT_METRICS_DROPPED_OFFSET + 4 <= EXPORT_METRICS_OFFSET,
+                      "the export summary outgrew EXPORT_SUMMARY_SIZE; bump EXPORT_VERSION and resize it");
+
+        /// The default section name of process @p pid: `Local\DetourModKit.Diagnostics.<pid>`.
+        [[nodiscard]] std::string shared_export_name(std::uint32_t pid);
+
+        /**
+         * @struct ExportedSnapshot
+         * @brief One consistent publish of a @ref SharedExport section, as decoded by @ref decode_shared_export.
+         */
+        struct ExportedSnapshot
+        {
+            /// The section's sequence; it rises by two per publish, so a reader can tell a fresh sample from a repeat.
+            std::uint64_t sequence = 0;
+            /// UTC time of the publish, in microseconds since the Unix epoch.
+            std::int64_t published_at_us = 0;
+            /// @ref Snapshot::intentional_leaks at the publish.
+            std::array<std::size_t, static_cast<std::size_t>(LeakSubsystem::Count)> intentional_leaks{};
+            /// @ref Snapshot::hooks_total at the publish.
+            std::size_t hooks_total = 0;
+            /// @ref Snapshot::hooks_active at the publish.
+            std::size_t hooks_active = 0;
+            /// @ref Snapshot::hooks_disabled at the publish.
+            std::size_t hooks_disabled = 0;
+            /// @ref Snapshot::metrics at the publish, up to EXPORT_MAX_METRICS; names are cut to fit.
+            std::vector<MetricSample> metrics;
+            /// Metrics past EXPORT_MAX_METRICS that the publish left out.
+            std::size_t metrics_dropped = 0;
+        };
+
+        /// Settings of a @ref SharedExport.
+        struct SharedExportConfig
+        {
+            /// Section name; empty means @ref shared_export_name of the current process.
+            std::string name;
+            /// How often the background thread republishes. Each publish runs one @ref collect.
+            std::chrono::milliseconds period{250};
+        };
+
+        /**
+         * @class SharedExport
+         * @brief Owns the shared diagnostics section and its periodic publish task.
+         * @details Publishes once in @ref start, so a reader finds data as soon as the section exists, then again
+         *          every @ref SharedExportConfig::period on the shared background thread. Destroying it stops the task
+         *          and closes the section; a reader that still has it mapped keeps its last contents.
+         * @note Move-only. Setup/control-plane only: start, publish_now and the destructor take locks and may wait for
+         *       a publish in progress. Run one export per section name at a time; a second one would open the same
+         *       section and both would write it.
+         */
+        class SharedExport
+        {
+        public:
+            /**
+             * @brief Creates the section and schedules its publish task.
+             * @return The export, or an Error: InvalidArg for a zero period, SystemCallFailed when the section cannot
+             *         be created or mapped (Error::detail carries GetLastError()) or the background thread cannot
+             *         start, OutOfMemory.
+             */
+            [[nodiscard]] static Result<SharedExport> start(SharedExportConfig config = {});
+
+            SharedExport(SharedExport &&) noexcept;
+            SharedExport &operator=(SharedExport &&) noexcept;
+            SharedExport(const SharedExport &) = delete;
+            SharedExport &operator=(const SharedExport &) = delete;
+            ~SharedExport() noexcept;
+
+            /// Publishes a fresh sample now instead of waiting for the next period.
+            void publish_now() noexcept;
+
+            /// The section name readers open.
+            [[nodiscard]] const std::string &name() const noexcept;
+
+        private:
+            struct Impl;
+            explicit SharedExport(std::unique_ptr<Impl> impl) noexcept;
+            // Cancels the publish task and closes the section.
+            void stop() noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+
+        /**
+         * @brief Copies one consistent publish out of a mapped section and decodes it.
+         * @details Copies the section and retries while a publish is in progress or lands mid-copy, up to a bounded
+         *          number of attempts, so it never waits on the publisher.
+         * @param section The mapped section, at least EXPORT_SECTION_SIZE bytes; a live mapping or a saved copy.
+         * @return The sample, or an Error: MissingHeader (wrong magic, version or size, or nothing published yet) or
+         *         MalformedLine (every attempt raced a publish, or a field is out of range).
+         */
+        [[nodiscard]] Result<ExportedSnapshot> decode_shared_export(std::span<const std::byte> section);
+
+        /**
+         * @brief Opens the section named @p name read-only, decodes it, and closes it again.
+         * @details The section can be in another process: this is what an external monitor calls, at whatever rate
+         *          it likes.
+         * @return The sample, FileOpenFailed when no section of that name exists or it cannot be mapped, or
+         *         decode_shared_export's error.
+         */
+        [[nodiscard]] Result<ExportedSnapshot> read_shared_export(std::string_view name);
+    } // namespace diagnostics
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_DIAGNOSTICS_EXPORT_HPP
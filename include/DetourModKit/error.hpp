@@ -86,6 +86,8 @@ namespace DetourModKit
         NullChain,
         /// Last-resort code when no more specific one applies.
         Unknown,
+        /// The batch was cancelled (its stop token fired, or a fail-fast sibling failed) before this item resolved.
+        Cancelled,
 
         // Hook (0x01xx): the former HookError, 19 codes preserved
         /// The hook backend allocator could not be obtained.
@@ -289,6 +291,8 @@ namespace DetourModKit
             return "NullChain";
         case ErrorCode::Unknown:
             return "Unknown";
+        case ErrorCode::Cancelled:
+            return "Cancelled";
         case ErrorCode::AllocatorNotAvailable:
             return "AllocatorNotAvailable";
         case ErrorCode::InvalidTargetAddress:
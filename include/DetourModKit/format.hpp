@@ -5,15 +5,28 @@
  * @file format.hpp
  * @brief String and format utilities for DetourModKit.
  * @details Provides string manipulation (trimming) and formatting utilities for common game modding types like memory
- *          addresses, byte values, and virtual key codes.
+ *          addresses, byte values, and virtual key codes. Each formatter comes in two forms: one returning a
+ *          std::string, and a std::to_chars-based one writing into a caller buffer (a std::span<char>, which a
+ *          std::array<char, N> converts to) that never allocates. The std::formatter specializations for Address and
+ *          Region at the end of the file render the same text straight into a format call, and mark both types
+ *          deferrable, so `log().debug("hooked {}", address)` formats on the async writer when deferred formatting is
+ *          on. std::byte gets no formatter: the standard only lets a program specialize std::formatter for its own
+ *          types, so a byte still goes through format_byte.
  */
 
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <array>
+#include <charconv>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <span>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace DetourModKit
@@ -45,6 +58,61 @@ namespace DetourModKit
 
     namespace format
     {
+        /// Characters format_address writes: "0x" plus two digits per address byte.
+        inline constexpr std::size_t ADDRESS_CHARS = 2 + sizeof(std::uintptr_t) * 2;
+        /// Characters an unpadded format_hex writes at most: "-0x" plus 16 digits.
+        inline constexpr std::size_t HEX_CHARS = 3 + 16;
+        /// Characters format_byte writes: "0x" plus two digits.
+        inline constexpr std::size_t BYTE_CHARS = 4;
+
+        /// Characters format_int_vector writes at most for @p count values: brackets, ", " separators, and 10 each.
+        [[nodiscard]] constexpr std::size_t int_vector_chars(std::size_t count) noexcept
+        {
+            return count == 0 ? 2 : 2 + count * 10 + (count - 1) * 2;
+        }
+
+        namespace detail
+        {
+            /**
+             * @brief Writes @p value as upper-case hex into @p out: an optional '-', "0x", then the digits zero-padded
+             *        to @p width.
+             * @return The written prefix of @p out, or an empty view when the text does not fit (nothing is written).
+             */
+            [[nodiscard]] inline std::string_view write_hex(std::span<char> out, std::uint64_t value, int width,
+                                                            bool negative = false) noexcept
+            {
+                char digits[16];
+                // Sixteen characters hold any 64-bit value in base 16, so to_chars cannot fail here.
+                const char *const digits_end = std::to_chars(digits, digits + sizeof(digits), value, 16).ptr;
+                const auto count = static_cast<std::size_t>(digits_end - digits);
+                const std::size_t padded = width > 0 ? static_cast<std::size_t>(width) : 0;
+                const std::size_t pad = padded > count ? padded - count : 0;
+                const std::size_t total = (negative ? 1 : 0) + 2 + pad + count;
+                if (total > out.size())
+                {
+                    return {};
+                }
+
+                char *cursor = out.data();
+                if (negative)
+                {
+                    *cursor++ = '-';
+                }
+                *cursor++ = '0';
+                *cursor++ = 'x';
+                for (std::size_t i = 0; i < pad; ++i)
+                {
+                    *cursor++ = '0';
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const char c = digits[i];
+                    *cursor++ = (c >= 'a' && c <= 'f') ? static_cast<char>(c - 'a' + 'A') : c;
+                }
+                return std::string_view(out.data(), total);
+            }
+        } // namespace detail
+
         /**
          * @brief Formats a memory address as a hexadecimal string.
          * @param address The memory address to format.
@@ -55,6 +123,16 @@ namespace DetourModKit
             return std::format("0x{:0{}X}", address, sizeof(uintptr_t) * 2);
         }
 
+        /**
+         * @brief Writes a memory address into @p out without allocating; the text format_address(address) returns.
+         * @return The written text, a view into @p out, or an empty view when @p out holds fewer than ADDRESS_CHARS.
+         * @note Callback-safe: no allocation, locking, or I/O.
+         */
+        [[nodiscard]] inline std::string_view format_address(uintptr_t address, std::span<char> out) noexcept
+        {
+            return detail::write_hex(out, address, static_cast<int>(sizeof(uintptr_t) * 2));
+        }
+
         /**
          * @brief Formats a signed integer as an unsigned hexadecimal string.
          * @details Prints the unsigned two's-complement bit pattern, so a negative value widens to its unsigned
@@ -71,6 +149,16 @@ namespace DetourModKit
             return std::format("0x{:X}", static_cast<unsigned int>(value));
         }
 
+        /**
+         * @brief Writes format_hex(value, width)'s text into @p out without allocating.
+         * @return A view into @p out, or an empty view when the text does not fit.
+         * @note Callback-safe.
+         */
+        [[nodiscard]] inline std::string_view format_hex(int value, std::span<char> out, int width = 0) noexcept
+        {
+            return detail::write_hex(out, static_cast<unsigned int>(value), width);
+        }
+
         /**
          * @brief Formats any unsigned integer as a hexadecimal string.
          * @details Constrained to std::unsigned_integral so a size_t / unsigned / uint64_t argument binds here exactly
@@ -89,6 +177,13 @@ namespace DetourModKit
             return std::format("0x{:X}", value);
         }
 
+        /// Writes format_hex(value, width)'s text into @p out without allocating; empty when it does not fit.
+        template <std::unsigned_integral T>
+        [[nodiscard]] inline std::string_view format_hex(T value, std::span<char> out, int width = 0) noexcept
+        {
+            return detail::write_hex(out, static_cast<std::uint64_t>(value), width);
+        }
+
         /**
          * @brief Formats a ptrdiff_t as a signed hexadecimal string.
          * @details The signed 64-bit path. When this overload carried no width parameter, a call that supplied one --
@@ -118,6 +213,16 @@ namespace DetourModKit
             return std::format("0x{:X}", static_cast<size_t>(value));
         }
 
+        /// Writes format_hex(value, width)'s signed text into @p out without allocating; empty when it does not fit.
+        [[nodiscard]] inline std::string_view format_hex(ptrdiff_t value, std::span<char> out, int width = 0) noexcept
+        {
+            if (value < 0)
+            {
+                return detail::write_hex(out, ~static_cast<std::uint64_t>(value) + 1u, width, true);
+            }
+            return detail::write_hex(out, static_cast<std::uint64_t>(value), width);
+        }
+
         /**
          * @brief Formats a byte value as a two-digit hexadecimal string.
          * @param b The byte value to format.
@@ -128,6 +233,12 @@ namespace DetourModKit
             return std::format("0x{:02X}", static_cast<unsigned int>(b));
         }
 
+        /// Writes format_byte(b)'s text into @p out without allocating; empty when @p out holds fewer than BYTE_CHARS.
+        [[nodiscard]] inline std::string_view format_byte(std::byte b, std::span<char> out) noexcept
+        {
+            return detail::write_hex(out, static_cast<unsigned int>(b), 2);
+        }
+
         /**
          * @brief Formats a vector of integers as a comma-separated hex list.
          * @param values The vector of integer values.
@@ -156,6 +267,53 @@ namespace DetourModKit
             return result;
         }
 
+        /**
+         * @brief Writes format_int_vector's list text into @p out without allocating.
+         * @details int_vector_chars(values.size()) characters always suffice.
+         * @return A view into @p out, or an empty view when the list does not fit; a list is never cut short.
+         * @note Callback-safe.
+         */
+        [[nodiscard]] inline std::string_view format_int_vector(std::span<const int> values,
+                                                                std::span<char> out) noexcept
+        {
+            std::size_t used = 0;
+            const auto put = [&out, &used](std::string_view text) noexcept
+            {
+                if (text.size() > out.size() - used)
+                {
+                    return false;
+                }
+                for (const char c : text)
+                {
+                    out[used++] = c;
+                }
+                return true;
+            };
+
+            if (!put("["))
+            {
+                return {};
+            }
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                if (i > 0 && !put(", "))
+                {
+                    return {};
+                }
+                const std::string_view hex = format_hex(values[i], out.subspan(used), 2);
+                if (hex.empty())
+                {
+                    return {};
+                }
+                used += hex.size();
+            }
+            if (!put("]"))
+            {
+                return {};
+            }
+            return std::string_view(out.data(), used);
+        }
+
         /**
          * @brief Formats a Virtual Key code as a two-digit hexadecimal string.
          * @param vk_code The virtual key code.
@@ -166,6 +324,12 @@ namespace DetourModKit
             return format_hex(vk_code, 2);
         }
 
+        /// Writes format_vkcode(vk_code)'s text into @p out without allocating; empty when it does not fit.
+        [[nodiscard]] inline std::string_view format_vkcode(int vk_code, std::span<char> out) noexcept
+        {
+            return format_hex(vk_code, out, 2);
+        }
+
         /**
          * @brief Formats a vector of Virtual Key codes.
          * @param keys The vector of VK codes.
@@ -176,7 +340,96 @@ namespace DetourModKit
             return format_int_vector(keys);
         }
 
+        /// Writes format_vkcode_list(keys)'s text into @p out without allocating; empty when it does not fit.
+        [[nodiscard]] inline std::string_view format_vkcode_list(std::span<const int> keys,
+                                                                 std::span<char> out) noexcept
+        {
+            return format_int_vector(keys, out);
+        }
+
+
+        namespace detail
+        {
+            /**
+             * @brief The shared parse step of the Address and Region formatters.
+             * @details An empty spec keeps the kit's own rendering (format_address); any other spec is handed to the
+             *          formatter of the underlying integer, so `{:#x}` or `{:08X}` still work.
+             */
+            template <class Raw> struct DefaultOrRawFormatter
+            {
+                constexpr auto parse(std::format_parse_context &ctx)
+                {
+                    custom = ctx.begin() != ctx.end() && *ctx.begin() != '}';
+                    return custom ? raw.parse(ctx) : ctx.begin();
+                }
+
+                std::formatter<Raw, char> raw;
+                bool custom = false;
+            };
+
+            template <class Out> Out copy_text(std::string_view text, Out out)
+            {
+                for (const char c : text)
+                {
+                    *out++ = c;
+                }
+                return out;
+            }
+        } // namespace detail
     } // namespace format
+
+    namespace detail
+    {
+        // Declared here and defined in logger.hpp, so this header marks its types deferrable without including the
+        // logger; either header may come first.
+        template <typename T> struct DeferredLogFormat;
+
+        template <> struct DeferredLogFormat<Address> : std::true_type
+        {
+        };
+        template <> struct DeferredLogFormat<Region> : std::true_type
+        {
+        };
+    } // namespace detail
 } // namespace DetourModKit
 
+/// Formats an Address as format_address does ("0x00007FF6...") or, with a spec, as its raw integer.
+template <>
+struct std::formatter<DetourModKit::Address, char> : DetourModKit::format::detail::DefaultOrRawFormatter<std::uintptr_t>
+{
+    template <class FormatContext> auto format(DetourModKit::Address address, FormatContext &ctx) const
+    {
+        if (custom)
+        {
+            return raw.format(address.raw(), ctx);
+        }
+        std::array<char, DetourModKit::format::ADDRESS_CHARS> text;
+        return DetourModKit::format::detail::copy_text(DetourModKit::format::format_address(address.raw(), text),
+                                                       ctx.out());
+    }
+};
+
+/// Formats a Region as its half-open span, "[0x...base, 0x...end)"; a spec applies to both ends.
+template <>
+struct std::formatter<DetourModKit::Region, char> : DetourModKit::format::detail::DefaultOrRawFormatter<std::uintptr_t>
+{
+    template <class FormatContext> auto format(const DetourModKit::Region &region, FormatContext &ctx) const
+    {
+        using DetourModKit::format::detail::copy_text;
+        ctx.advance_to(copy_text("[", ctx.out()));
+        if (custom)
+        {
+            ctx.advance_to(raw.format(region.base.raw(), ctx));
+            ctx.advance_to(copy_text(", ", ctx.out()));
+            ctx.advance_to(raw.format(region.end().raw(), ctx));
+            return copy_text(")", ctx.out());
+        }
+        std::array<char, DetourModKit::format::ADDRESS_CHARS> text;
+        ctx.advance_to(copy_text(DetourModKit::format::format_address(region.base.raw(), text), ctx.out()));
+        ctx.advance_to(copy_text(", ", ctx.out()));
+        ctx.advance_to(copy_text(DetourModKit::format::format_address(region.end().raw(), text), ctx.out()));
+        return copy_text(")", ctx.out());
+    }
+};
+
 #endif // DETOURMODKIT_FORMAT_HPP
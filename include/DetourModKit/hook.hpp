@@ -33,6 +33,7 @@
 #include <memory>
 #include <mutex>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -176,6 +177,8 @@ namespace DetourModKit
 
         /**
          * @brief Read-only by-value snapshot of XMM register @p index (0..15); out-of-range returns a zeroed view.
+         * @details Under a narrowed @ref MidCapture, an xmm6..xmm15 the hook did not declare was never saved; debug
+         *          builds assert on reading it.
          * @note Callback-safe: a pure register read over the captured context, no allocation, locking, or I/O.
          */
         [[nodiscard]] XmmView xmm(const MidContext &ctx, std::size_t index) noexcept;
@@ -183,12 +186,14 @@ namespace DetourModKit
         /**
          * @enum Prologue
          * @brief Escalation policy for the inline/mid hook prologue pre-flight.
-         * @details The pre-flight fault-guard-reads the target's first byte. A leading 0xE8 (call rel32) means the
-         *          5-byte E9 patch would steal a relative call whose displacement was computed from the original
-         *          site, so the relocated trampoline copy can dispatch the call to the wrong absolute target; a
-         *          leading 0xCC/0xCD (int3 / int n breakpoint) means the slot is already a breakpoint stub, a patched
-         *          byte, or alignment padding, not a real function body. @ref Relocate logs and installs anyway;
-         *          @ref Fail refuses the create with @ref ErrorCode::TargetPrologueUnsafe.
+         * @details The pre-flight fault-guard-reads and length-decodes the target's first bytes. A leading 0xE8
+         *          (call rel32) means the 5-byte E9 patch would steal a relative call whose displacement was computed
+         *          from the original site, so the relocated trampoline copy can dispatch the call to the wrong absolute
+         *          target; a leading 0xCC/0xCD (int3 / int n breakpoint) means the slot is already a breakpoint stub, a
+         *          patched byte, or alignment padding, not a real function body. A ret or jmp (prefixed or indirect too)
+         *          that ends the code before the 5-byte patch does, with no int3/nop padding after it, means the patch
+         *          would overwrite whatever follows (usually the next function's entry). @ref Relocate logs and installs
+         *          anyway; @ref Fail refuses the create with @ref ErrorCode::TargetPrologueUnsafe.
          * @note The library DEFAULT is Fail (safe-by-default): a non-relocatable prologue fails the install rather
          *       than installing a hook that can dispatch to the wrong target. Opt into install-anyway with
          *       `Options{.prologue = Prologue::Relocate}`.
@@ -212,6 +217,36 @@ namespace DetourModKit
             Mandatory
         };
 
+        /**
+         * @struct MidCapture
+         * @brief Which XMM registers a mid hook's stub saves into the @ref MidContext it hands the detour.
+         * @details Every general-purpose register, rflags, and the rsp / resume-rsp / rip slots are captured in every
+         *          mode, so @ref gpr and the other scalar accessors always see the live value. The default mask
+         *          captures all sixteen XMM registers through the backend's full-context stub. Any other mask
+         *          installs a DMK stub that lays out the same context but moves only the declared XMM registers
+         *          plus xmm0..xmm5, which are always saved because the detour itself may clobber those Win64
+         *          volatile registers. xmm6..xmm15 are callee-saved, so a stub that skips them costs the site nothing
+         *          but the read: @ref xmm of an undeclared xmm6..xmm15 is rejected by an assert in debug builds and
+         *          returns an unspecified view in release builds.
+         */
+        struct MidCapture
+        {
+            /// The mask bit set for every XMM register, the backend's full-context capture.
+            static constexpr std::uint16_t ALL_XMM = 0xFFFF;
+
+            /// Bit `i` captures xmm`i`; bits 0..5 are implied (see above).
+            std::uint16_t xmm_mask = ALL_XMM;
+
+            /// The full-context capture, the default.
+            [[nodiscard]] static constexpr MidCapture full() noexcept { return MidCapture{}; }
+
+            /// General-purpose registers, rflags, and the volatile xmm0..xmm5 only: the cheapest stub.
+            [[nodiscard]] static constexpr MidCapture gpr_only() noexcept { return MidCapture{0}; }
+
+            /// True when the mask, with the implied xmm0..xmm5, selects the backend's full-context stub.
+            [[nodiscard]] constexpr bool is_full() const noexcept { return (xmm_mask | 0x003F) == ALL_XMM; }
+        };
+
         /**
          * @struct Options
          * @brief Per-hook policy for @ref inline_at / @ref mid_at.
@@ -229,6 +264,19 @@ namespace DetourModKit
              *          under a fault guard. The default (false) installs anyway and the new hook layers on top.
              */
             bool fail_if_already_hooked = false;
+
+            /// Register capture of a mid hook's stub (see @ref MidCapture); ignored by @ref inline_at.
+            MidCapture capture{};
+
+            /**
+             * @brief Install an inline hook through the target's hot-patch pad when it has one; ignored by @ref mid_at.
+             * @details A function built with /hotpatch (or sitting after 5 bytes of INT3/NOP padding) that starts with
+             *          a 2-byte instruction such as `mov edi, edi` is detoured by a JMP written into the padding and a
+             *          2-byte `jmp $-5` stored atomically over the entry. Enabling and disabling such a hook rewrites
+             *          only those two bytes, which makes toggling it cheap. A target without that layout gets an
+             *          ordinary inline hook, as if the flag were off.
+             */
+            bool hot_patch = false;
         };
 
         namespace detail
@@ -274,8 +322,8 @@ namespace DetourModKit
          * @class Hook
          * @brief Move-only RAII handle for one installed inline or mid hook; its destructor restores the prologue.
          * @details Constructed only by @ref inline_at / @ref mid_at / @ref install_all. The backend hook, a DMK-owned
-         *          `std::recursive_mutex` call guard, the atomic enable/disable status machine, and the ledger token
-         *          all live behind the pimpl, so this header never names SafetyHook. Dropping the handle (or letting
+         *          lock-free call gate, the atomic enable/disable status machine, and the ledger token all live behind
+         *          the pimpl, so this header never names SafetyHook. Dropping the handle (or letting
          *          it go out of scope) unhooks; @ref release detaches the hook for the process lifetime instead.
          * @note Teardown ordering: when two hooks are layered on the same target address, the newer one must be
          *       destroyed first (it saved the older hook's jump as its own original bytes). Natural reverse-order
@@ -336,48 +384,44 @@ namespace DetourModKit
              *         real by-value C ABI.
              * @return The original's return value, or a value-initialized Ret when the hook is inactive / not inline.
              * @details The opt-in safety twin of @ref original, modelled on SafetyHook's own call/unsafe_call split.
-             *          It pins a refcounted per-hook control block (the call gate: a recursive_mutex plus the currently
-             *          callable trampoline, published under that mutex) into a local strong reference BEFORE locking,
-             *          then holds the mutex across the trampoline invocation. Two properties follow. First, a
-             *          concurrent @ref enable / @ref disable / ~Hook / @ref operator=(Hook&&) that drops the handle's
-             *          own reference cannot free the gate itself while this call is entering: the local strong
-             *          reference keeps the gate (its mutex and its published-callable slot) alive until the call
-             *          returns, so a caller stalled just before locking still finds a live mutex to lock and a live
-             *          slot to read. A teardown that wins the race publishes a null callable under the mutex, so a
-             *          late caller reads null and fails closed to the inactive default rather than dispatching through
-             *          a freed trampoline. Second, the trampoline's own liveness comes from the mutex, not the gate
-             *          reference: a teardown frees the backend trampoline only after acquiring that same mutex and
-             *          nulling the callable, and this call holds the mutex across the dispatch, so a teardown cannot
-             *          free the trampoline while a call is in-flight. Reach for it when the hook can be torn down
-             *          (dynamically unloaded) while another thread is calling through it; for the common
-             *          hook-outlives-the-process case, @ref original is cheaper.
-             *
-             *          Lifetime precondition: the Hook object itself must outlive the call. The gate refcount keeps
-             *          the trampoline and mutex alive across a concurrent teardown, but reading this handle to reach
-             *          the gate is still an ordinary member access, so a caller must not race the destruction of the
-             *          `Hook` object's storage. Teardown work (restoring the prologue, freeing the trampoline) may run
-             *          concurrently with a call; only the handle's storage must remain alive until the member call has
-             *          copied the gate.
+             *          It enters the per-hook call gate without taking a lock: it bumps an in-flight counter on one of
+             *          the gate's cache-line-padded stripes (picked from the calling thread's id), re-reads the
+             *          handle's gate and the published trampoline, and dispatches if both are still live, dropping the
+             *          count when the original returns. Concurrent callers on different cores therefore touch
+             *          different cache lines and never wait on each other. A concurrent @ref disable / ~Hook /
+             *          @ref operator=(Hook&&) first publishes a null trampoline, then waits for the stripe counts to
+             *          drain to zero before it returns or frees anything, so a caller that got in keeps a live
+             *          trampoline until it returns, and a caller that arrives after the null publish fails closed to
+             *          the inactive default. Recursion through the same hook on one thread just stacks counts. Reach
+             *          for it when the hook can be torn down (dynamically unloaded) while another thread is calling
+             *          through it; for the common hook-outlives-the-process case, @ref original is cheaper still.
              *
+             *          Lifetime precondition: the Hook object itself must outlive the call. Gates are recycled rather
+             *          than freed, so a caller that read the gate just before a teardown touches live memory and backs
+             *          out, but reading this handle to reach the gate is an ordinary member access, so a caller must
+             *          not race the destruction of the `Hook` object's storage. @ref disable, ~Hook, and move-assigning
+             *          over the handle from inside a guarded call through the SAME hook wait for their own call to
+             *          drain and never return; disarm from outside the call instead.
+
              *          Parameters are `Args... args` BY VALUE (not a forwarding reference): for an lvalue argument a
              *          forwarding reference would deduce `Args` as a reference type, making the reconstructed
              *          `Ret(*)(Args...)` a reference-parameter function-pointer type that passes a hidden pointer
              *          where the real by-value trampoline expects the scalar -- silent, value-category-dependent ABI
              *          UB. By value, the reconstructed `Ret(*)(Args...)` is the true by-value signature; args... are
              *          passed directly with no std::forward. The caller must still supply argument types matching the
-             *          original's real signature; call cannot validate them. The guard blocks teardown from STARTING
-             *          during a call but cannot drain a thread already inside the original's body.
+             *          original's real signature; call cannot validate them. The unguarded @ref original path is
+             *          not counted, so a teardown does not wait for a thread that entered the original that way.
              * @note Not marked [[nodiscard]]: with the default Ret = void the attribute is inert, and firing it only
              *       for non-void instantiations would be surprising and inconsistent with the backend, which marks no
              *       call-family method [[nodiscard]].
              */
             template <typename Ret = void, typename... Args> Ret call(Args... args) const
             {
-                // Pin the gate, take its lock, and resolve the live trampoline through the shared @ref GuardedDispatch
-                // protocol; a null trampoline is any fail-closed path (disengaged handle, lock failure, torn-down or
-                // not-yet-armed hook), for which call returns the value-initialized default a caller cannot tell apart
-                // from a genuine one. The lock and pinned gate stay held for the object's lifetime, so the trampoline
-                // cannot be freed under this dispatch.
+                // Enter the gate and resolve the live trampoline through the shared @ref GuardedDispatch protocol; a
+                // null trampoline is any fail-closed path (disengaged handle, torn-down, disabled, or not-yet-armed
+                // hook), for which call returns the value-initialized default a caller cannot tell apart from a
+                // genuine one. The in-flight count stays raised for the object's lifetime, so a teardown cannot free
+                // the trampoline under this dispatch.
                 const GuardedDispatch dispatch{*this};
                 if (dispatch.trampoline == nullptr)
                 {
@@ -403,19 +447,19 @@ namespace DetourModKit
              *         (a forwarding reference would deduce a reference type and corrupt the reconstructed
              *         `Ret(*)(Args...)` signature).
              * @return The original's return value on a dispatched call. On any fail-closed path -- a disengaged handle
-             *         (moved-from or released), a call-lock acquisition failure, or a torn-down / disabled /
-             *         not-yet-armed trampoline -- an InvalidHookState error. That is the whole point: @ref call
+             *         (moved-from or released), or a torn-down / disabled / not-yet-armed trampoline -- an
+             *         InvalidHookState error. That is the whole point: @ref call
              *         collapses every one of those into a value-initialized `Ret{}` a caller cannot tell apart from a
              *         genuine `Ret{}` the original returned, whereas try_call keeps "the gate refused the call" in the
              *         error channel.
-             * @details Runs the identical pin-gate / acquire-lock / read-trampoline protocol as @ref call; only the
-             *          return channel differs. Reach for it when a value-initialized `Ret` is a legal result of the
+             * @details Runs the identical enter-gate / read-trampoline protocol as @ref call; only the return
+             *          channel differs. Reach for it when a value-initialized `Ret` is a legal result of the
              *          original (a query that can legitimately return `0` / `nullptr` / `false`) and a suppressed call
              *          must not be mistaken for that result. `try_call<void>()` still reports whether the call
-             *          dispatched. It offers no stronger call-site guarantee than @ref call: it takes the same one
-             *          bounded internal lock, so it is callback-safe on exactly the same terms.
-             * @note Callback-safe on the same terms as @ref call: it takes one bounded internal lock and performs no
-             *       allocation or I/O before dispatching.
+             *          dispatched. It offers no stronger call-site guarantee than @ref call: it enters the same
+             *          lock-free gate, so it is callback-safe on exactly the same terms.
+             * @note Callback-safe on the same terms as @ref call: it takes no lock and performs no allocation or I/O
+             *       before dispatching.
              */
             template <typename Ret = void, typename... Args> [[nodiscard]] Result<Ret> try_call(Args... args) const
             {
@@ -467,72 +511,73 @@ namespace DetourModKit
         private:
             struct Impl;
             /**
-             * @brief The refcounted per-hook call guard (recursive_mutex + published trampoline) defined in
+             * @brief The per-hook call gate (striped in-flight counts + published trampoline) defined in
              *        src/internal/hook_backend.hpp.
-             * @details Held behind a shared_ptr so a late @ref call keeps the mutex and trampoline alive after the
-             *          handle's teardown drops its own reference; see @ref call and the CallGate definition.
+             * @details Owned by the handle and returned to a process-wide pool on teardown rather than freed, so a late
+             *          @ref call that read the gate pointer always touches live memory; see @ref call and the
+             *          CallGate definition.
              */
             struct CallGate;
-            Hook(std::unique_ptr<Impl> impl, std::shared_ptr<CallGate> gate) noexcept;
-
-            /// Raw inline trampoline (or nullptr); the UNGUARDED backend touch behind original<Fn>(). Defined in .cpp.
-            [[nodiscard]] void *original_address() const noexcept;
-
-            /// Copies the atomic call-gate reference into a strong local for @ref call to pin. Defined in .cpp.
-            [[nodiscard]] std::shared_ptr<CallGate> pin_call_gate() const noexcept;
-
-            /**
-             * @brief Locks the gate's recursive_mutex and returns the owning token; the @ref call guard. Defined in
-             *        .cpp.
-             * @details noexcept: a recursive_mutex::lock failure yields an unowned lock (the caller checks
-             *          owns_lock()) rather than throwing out of the non-noexcept @ref call.
-             */
-            [[nodiscard]] std::unique_lock<std::recursive_mutex> acquire_call_lock(CallGate *gate) const noexcept;
-
-            /// The gate's published callable trampoline (nullptr when inactive); read with the call lock held.
-            [[nodiscard]] void *active_trampoline(CallGate *gate) const noexcept;
 
             /**
              * @brief One entry through the call gate, shared verbatim by @ref call and @ref try_call.
-             * @details Constructing it runs the three-stage protocol both call-family methods need: pin the refcounted
-             *          gate into a local strong reference (so a concurrent ~Hook / operator=(Hook&&) cannot free the
-             *          gate's mutex or the published trampoline while this call is entering), take that gate's
-             *          recursive lock, and read the published trampoline under the lock. Any stage that fails closed
-             *          leaves @ref trampoline null: a disengaged handle (moved-from / released) has an empty gate; a
-             *          recursive_mutex::lock failure yields an unowned lock (acquire_call_lock is noexcept and never
-             *          lets a std::system_error escape); a torn-down / disabled / not-yet-armed hook publishes a null
-             *          callable. On success it retains the strong gate reference and the held lock for the object's
-             *          lifetime, so the backend cannot free the trampoline under an in-flight dispatch. call and
+             * @details Constructing it runs the protocol both call-family methods need (see @ref enter_call): raise an
+             *          in-flight count on the gate, then confirm the handle still owns that gate and read the
+             *          published trampoline. Any stage that fails closed drops the count again and leaves
+             *          @ref trampoline null: a disengaged handle (moved-from / released) has no gate, a gate swapped
+             *          out by a concurrent teardown no longer matches, and a torn-down / disabled / not-yet-armed hook
+             *          publishes a null callable. On success the count stays raised until destruction, so a teardown
+             *          waiting for the gate to drain cannot free the trampoline under an in-flight dispatch. call and
              *          try_call then diverge only in how they report a null trampoline.
              */
             struct GuardedDispatch
             {
-                explicit GuardedDispatch(const Hook &hook)
+                explicit GuardedDispatch(const Hook &hook) noexcept { hook.enter_call(*this); }
+
+                ~GuardedDispatch()
                 {
-                    gate = hook.pin_call_gate();
-                    if (!gate)
-                        return;
-                    guard = hook.acquire_call_lock(gate.get());
-                    if (!guard.owns_lock())
-                        return;
-                    trampoline = hook.active_trampoline(gate.get());
+                    if (trampoline != nullptr)
+                    {
+                        leave_call(*this);
+                    }
                 }
 
-                std::shared_ptr<CallGate> gate;
-                std::unique_lock<std::recursive_mutex> guard;
+                GuardedDispatch(const GuardedDispatch &) = delete;
+                GuardedDispatch &operator=(const GuardedDispatch &) = delete;
+
+                /// The gate whose count this entry raised; meaningful only while @ref trampoline is set.
+                CallGate *gate = nullptr;
+                /// The in-flight stripe the count was raised on.
+                std::size_t stripe = 0;
                 /// The live trampoline to dispatch through, or nullptr when any gate stage failed closed.
                 void *trampoline = nullptr;
+#ifdef DMK_ENABLE_HOOK_STATS
+                /// QPC tick count at gate entry, for the per-hook latency histogram (diagnostics::HookStats).
+                std::int64_t start_ticks = 0;
+#endif
             };
 
+            Hook(std::unique_ptr<Impl> impl, CallGate *gate) noexcept;
+
+            /// Raw inline trampoline (or nullptr); the UNGUARDED backend touch behind original<Fn>(). Defined in .cpp.
+            [[nodiscard]] void *original_address() const noexcept;
+
+            /// Enters the call gate for @p dispatch; a fail-closed path leaves its trampoline null. Defined in .cpp.
+            void enter_call(GuardedDispatch &dispatch) const noexcept;
+
+            /// Drops the in-flight count a successful @ref enter_call raised. Defined in .cpp.
+            static void leave_call(const GuardedDispatch &dispatch) noexcept;
+
             std::unique_ptr<Impl> m_impl;
             /**
-             * @brief The shared call gate, held atomically so @ref call can pin it without racing a concurrent
-             *        teardown/move that publishes over it.
+             * @brief The handle's call gate, held atomically so @ref call can re-check it against a concurrent
+             *        teardown/move that swaps it out.
              */
-            std::atomic<std::shared_ptr<CallGate>> m_gate;
+            std::atomic<CallGate *> m_gate{nullptr};
 
             friend Result<Hook> mid_at(MidRequest request, MidHookFn detour);
             friend Result<Hook> detail::inline_at_raw(InlineRequest request, void *detour);
+            friend class Transaction;
         };
 
         /**
@@ -678,6 +723,99 @@ namespace DetourModKit
             std::vector<Hook> m_hooks;
         };
 
+        /**
+         * @class Transaction
+         * @brief A batch of @ref Hook enable / disable operations committed as one all-or-nothing set.
+         * @details Toggling a feature usually flips many hooks at once, and flipping them one @ref Hook::enable at a
+         *          time lets a frame run with half of the set armed. A transaction queues the operations and
+         *          @ref commit applies them in one patch window. It takes every involved hook's writer lock (in a fixed
+         *          order, so two commits cannot deadlock), toggles each backend back-to-back, and publishes the new
+         *          states. It only emits the lifecycle events and unlocks after that. If any backend toggle fails,
+         *          the hooks already toggled are put back and the commit reports the failure with every hook as it
+         *          was.
+         *
+         *          To land a toggle on a frame boundary, any thread may @ref schedule the built transaction. The
+         *          thread that owns the frame loop (typically a present or tick hook) then calls
+         *          @ref on_frame_boundary once per frame, and that call commits a scheduled transaction.
+         * @note Holds non-owning pointers: every queued hook must outlive the commit. A hook queued more than once
+         *       takes the last queued operation. Not internally synchronized apart from the schedule flag: build the
+         *       transaction on one thread, and do not touch it between @ref schedule and the commit.
+         */
+        class Transaction
+        {
+        public:
+            Transaction() = default;
+            Transaction(const Transaction &) = delete;
+            Transaction &operator=(const Transaction &) = delete;
+
+            /**
+             * @brief Queues arming @p hook.
+             * @throws std::bad_alloc when the queue cannot grow.
+             */
+            Transaction &enable(Hook &hook)
+            {
+                m_ops.push_back(Op{&hook, true});
+                return *this;
+            }
+
+            /**
+             * @brief Queues disarming @p hook.
+             * @throws std::bad_alloc when the queue cannot grow.
+             */
+            Transaction &disable(Hook &hook)
+            {
+                m_ops.push_back(Op{&hook, false});
+                return *this;
+            }
+
+            /**
+             * @brief Applies every queued operation as one set and, on success, empties the queue.
+             * @return Success when every queued hook is now in its requested state. On failure nothing changed: the
+             *         Error is InvalidHookState (a queued handle is empty, or its writer lock could not be taken),
+             *         BackendFailed, EnableFailed / DisableFailed (a backend toggle failed; the others were reverted),
+             *         or OutOfMemory. The queue is kept on failure.
+             * @details A hook already in its requested state is left alone and emits no lifecycle event. A scheduled
+             *          flag is cleared whether or not the commit succeeds.
+             * @note Setup/control-plane only, like @ref Hook::enable: it takes writer locks and drains guarded calls.
+             */
+            [[nodiscard]] Result<void> commit() noexcept;
+
+            /// Marks the transaction for the next @ref on_frame_boundary; safe from any thread.
+            void schedule() noexcept { m_scheduled.store(true, std::memory_order_release); }
+
+            /// True while a @ref schedule is waiting for its @ref on_frame_boundary.
+            [[nodiscard]] bool is_scheduled() const noexcept { return m_scheduled.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Commits the transaction if it is scheduled; otherwise a no-op success.
+             * @note Call from the frame-owning thread at the boundary the batch should land on.
+             */
+            [[nodiscard]] Result<void> on_frame_boundary() noexcept
+            {
+                if (!m_scheduled.load(std::memory_order_acquire))
+                {
+                    return {};
+                }
+                return commit();
+            }
+
+            /// Number of queued operations.
+            [[nodiscard]] std::size_t size() const noexcept { return m_ops.size(); }
+
+            /// Drops every queued operation without applying it.
+            void clear() noexcept { m_ops.clear(); }
+
+        private:
+            struct Op
+            {
+                Hook *hook;
+                bool enable;
+            };
+
+            std::vector<Op> m_ops;
+            std::atomic<bool> m_scheduled{false};
+        };
+
         /**
          * @brief Installs an inline hook at the request's target.
          * @tparam Fn The detour's function type; the function-to-void* cast happens here, once, behind a word-size
@@ -770,6 +908,20 @@ namespace DetourModKit
             /// Returns the per-row install policy applied by @ref install_all.
             [[nodiscard]] const Options &options() const noexcept { return m_options; }
 
+            /**
+             * @brief Returns a copy of this row whose target resolves within @p scope.
+             * @details For a table authored before its module is known, e.g. one @ref deferred::on_module_load installs
+             *          once the module maps. A multi-range target (a non-empty OwnedScanRequest::regions) keeps its
+             *          ranges, which take precedence over the scope as they do for any request.
+             * @note Setup/control-plane only: copies the row's name and target.
+             */
+            [[nodiscard]] HookSpec with_scope(Region scope) const
+            {
+                HookSpec scoped = *this;
+                scoped.m_target.scope = scope;
+                return scoped;
+            }
+
         private:
             HookSpec(std::string name, scan::OwnedScanRequest target, std::variant<InlineDetour, MidHookFn> detour,
                      Severity severity, Options options) noexcept
@@ -786,7 +938,8 @@ namespace DetourModKit
             /// Per-row install policy applied verbatim by @ref install_all.
             Options m_options;
 
-            friend Result<std::vector<InstallOutcome>> install_all(std::span<const HookSpec> table) noexcept;
+            friend Result<void> install_all(std::span<const HookSpec> table, std::span<InstallOutcome> out,
+                                            std::stop_token stop) noexcept;
         };
 
         /**
@@ -804,20 +957,33 @@ namespace DetourModKit
         struct InstallOutcome
         {
             std::string name;
-            Severity severity;
-            /// The installed Hook on success; an Error (e.g. NoMatch) when the row was skipped.
-            Result<Hook> hook;
+            Severity severity = Severity::BestEffort;
+            /**
+             * @brief The installed Hook on success; an Error (e.g. NoMatch) when the row was skipped. A
+             *        default-constructed slot holds Error{HookNotFound} until an install_all fills it.
+             */
+            Result<Hook> hook = std::unexpected(Error{ErrorCode::HookNotFound, "hook::InstallOutcome"});
         };
 
         /**
          * @brief Installs a whole declarative table of hooks, returning one outcome per row.
          * @param table The spec rows. Taken as a const span so a `const k_hook_table` binds; install_all copies each
          *        OwnedScanRequest it needs and never moves out of the caller's table.
+         * @param stop Cancels the install when it fires: the scans still running stop, and a stop between installs
+         *        rolls the installed rows back newest-first and fails the call with Cancelled.
          * @return The per-row outcomes on success. The outer Result fails fast on the FIRST @ref Severity::Mandatory
          *         miss (an all-Mandatory table short-circuits); otherwise it succeeds and every row's status is in the
          *         vector.
-         * @details noexcept, matching scan::resolve_batch: it catches bad_alloc / backend failure internally and
-         *          reports it per row rather than throwing across the init path.
+         * @details Runs in three phases. Every row's target is first resolved in one @ref scan::resolve_batch, so
+         *          the rows share one prescan of the image and every scan sees the prologues before this table patched
+         *          any of them; a Mandatory row whose scan misses fails the call there, before anything is installed,
+         *          and cancels the scans of the rows still running. Every resolved row is then pre-flighted on the
+         *          fork-join pool: its patch window must be readable, and the refusals its own @ref Options call for
+         *          (fail_if_already_hooked against a hook already in place, a risky prologue under @ref Prologue::Fail)
+         *          are applied, so a Mandatory refusal also fails the call before anything is installed.
+         *          The rows are then installed in table order, and a Mandatory install failure rolls the installed
+         *          rows back newest-first. noexcept, matching scan::resolve_batch: it catches bad_alloc / backend
+         *          failure internally and reports it per row rather than throwing across the init path.
          * @warning The returned `std::vector<InstallOutcome>` owns the installed hooks and, if simply dropped, tears
          *          them down OLDEST-first (front-to-back). That is the wrong order for hooks layered on one target and
          *          leaks the older backend to stay memory-safe (see @ref InstallOutcome and @ref Hook::~Hook). When any
@@ -825,7 +991,25 @@ namespace DetourModKit
          *          successful hooks out into a @ref HookStack in table order so teardown is newest-first by
          *          construction rather than by caller discipline.
          */
-        [[nodiscard]] Result<std::vector<InstallOutcome>> install_all(std::span<const HookSpec> table) noexcept;
+        [[nodiscard]] Result<std::vector<InstallOutcome>> install_all(std::span<const HookSpec> table,
+                                                                     std::stop_token stop = {}) noexcept;
+
+        /**
+         * @brief Installs a declarative table of hooks into the caller's @p out, one outcome slot per row.
+         * @details The same three-phase install as the vector overload, writing row i's outcome into out[i] instead of
+         *          a new vector, so a mod that reinstalls its table on every Logic DLL swap can keep one array of
+         *          slots. Each slot's name is assigned in place and reuses the capacity it already has. Slots past
+         *          table.size() are left untouched. The backend hook and the row's scan scratch are still allocated
+         *          per install.
+         * @return An empty Result once every row's slot is written. On a Mandatory miss or install failure, or
+         *         OutOfMemory, the error; every row installed so far is then uninstalled newest-first and its slot's
+         *         hook holds that error. InvalidArg (detail = out.size()) when @p out is shorter than @p table, with no
+         *         slot touched.
+         * @warning A slot that holds a Hook owns it, exactly as the vector overload's outcomes do: clear the slots
+         *          newest-first or move the hooks into a @ref HookStack before reusing the array.
+         */
+        [[nodiscard]] Result<void> install_all(std::span<const HookSpec> table, std::span<InstallOutcome> out,
+                                               std::stop_token stop = {}) noexcept;
 
         /**
          * @brief Reports whether a DMK hook (this kit) currently owns or is installing @p target.
@@ -834,10 +1018,30 @@ namespace DetourModKit
          *          visible. During a concurrent install it may report true after the target is reserved but before the
          *          backend patch is committed; that fail-closed bias prevents a redundant racing install from treating
          *          the target as free. Use it to short-circuit a redundant install; to also catch foreign hooks, set
-         *          Options::fail_if_already_hooked on the install instead.
+         *          Options::fail_if_already_hooked on the install instead. The query takes no lock, so it never waits
+         *          behind an install or teardown.
          */
         [[nodiscard]] bool is_target_hooked(Address target) noexcept;
 
+        /**
+         * @brief Reserves backend trampoline memory near @p site for a burst of @p hooks inline / mid installs.
+         * @details Every hook takes its trampoline from one process-wide backend allocator. That allocator already
+         *          carves each 64 KiB reservation near a target into trampolines and reuses freed space, but it grows
+         *          one allocation at a time: hundreds of hooks installed one by one each re-search the pool and, when
+         *          it runs dry, probe outward from the target for a fresh granule wherever one is free in the +/-2 GB
+         *          window. This makes one contiguous allocation sized for the whole burst near @p site and returns it
+         *          straight to the allocator's free list, which keeps the region, so the installs that follow carve
+         *          from it instead of probing. Space already free within reach of @p site is used first, so a call
+         *          made when the pool has room reserves nothing new. @ref install_all does this itself, once per
+         *          module its rows target.
+         * @param site An address in (or near) the module about to be hooked.
+         * @param hooks The number of hooks to make room for; 0 is a no-op.
+         * @return An empty Result, or NullTargetAddress, SizeTooLarge, AllocatorNotAvailable, or BackendFailed (no
+         *         free range within reach of @p site).
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] Result<void> reserve_trampolines(Address site, std::size_t hooks) noexcept;
+
         /**
          * @struct VmtOptions
          * @brief Policy for @ref vmt_for and @ref VmtHook::apply_to, symmetric with @ref Options.
@@ -928,6 +1132,25 @@ namespace DetourModKit
              */
             [[nodiscard]] Result<void> apply_to(void *object, VmtOptions options = {});
 
+            /**
+             * @brief Applies the cloned vtable to a batch of live objects of the seed's class, all or nothing.
+             * @param objects The objects to put on the clone, in any order; duplicates are applied once.
+             * @return The number of objects newly put on the clone (objects already on it are skipped), or the first
+             *         Error found, with nothing applied: InvalidHookState (disengaged handle), InvalidObject (a null or
+             *         misaligned object, one outside committed writable memory, or one whose vptr is not the seed's
+             *         vtable; the detail is the offending address or vptr), HookAlreadyExists (an object is on another
+             *         DMK hook's clone), OutOfMemory.
+             * @details Built for putting thousands of spawned objects on one clone at a level load. The objects are
+             *          sorted by address and validated before any vptr is written, under one acquisition of the locks
+             *          @ref apply_to takes per call. Consecutive objects in one memory region share a single protection
+             *          query, and each object's identity check is one qword compare against the vtable the seed carried
+             *          when @ref vmt_for cloned it, so no RTTI walk runs per object. This is stricter than
+             *          @ref apply_to, which applies to any object: a batch only accepts exact seed-class objects.
+             * @warning The same dispatch contract as @ref apply_to: no thread may be making a virtual call through any
+             *          of @p objects while the batch applies.
+             */
+            [[nodiscard]] Result<std::size_t> apply_to_many(std::span<void *const> objects);
+
             /**
              * @brief Restores the original vptr on one applied object.
              * @param object The object to restore.
@@ -1017,6 +1240,104 @@ namespace DetourModKit
 
             friend Result<VmtHook> vmt_for(std::string name, void *object, VmtOptions options);
         };
+
+        /// One method redirect of a shared clone (see @ref vmt_shared): a vtable index and the detour stored there.
+        struct VmtMethod
+        {
+            std::size_t index;
+            void *detour;
+        };
+
+        /**
+         * @brief Builds a @ref VmtMethod, doing the function-to-void* cast once behind a word-size static_assert.
+         * @details The index and detour ABI rules are those of @ref VmtHook::hook_method.
+         */
+        template <detail::FunctionPointer Fn> [[nodiscard]] VmtMethod vmt_method(std::size_t index, Fn detour) noexcept
+        {
+            static_assert(sizeof(Fn) == sizeof(void *), "function pointer must be word-sized");
+            return VmtMethod{index, reinterpret_cast<void *>(detour)};
+        }
+
+        class SharedVmtHook;
+
+        namespace detail
+        {
+            /// The state one shared clone's handles co-own; defined in src/hook_vmt_shared.cpp.
+            struct SharedVmtClone;
+        } // namespace detail
+
+        /**
+         * @brief Puts @p object on the process-wide clone of its vtable that carries exactly @p methods, creating the
+         *        clone on first use.
+         * @param name A descriptive name; it names the clone when this call creates it and is ignored otherwise.
+         * @param object The object whose vptr is swapped to the shared clone.
+         * @param methods The method redirects, in any order. Two calls share a clone only when they pass the same
+         *        set of (index, detour) pairs for objects carrying the same original vtable.
+         * @param options Apply-time policy, as for @ref vmt_for.
+         * @return The per-object RAII @ref SharedVmtHook, or an Error: InvalidArg (empty name, empty @p methods, a
+         *         null detour or a repeated index), InvalidObject, or any Error @ref vmt_for / @ref VmtHook::apply_to /
+         *         @ref VmtHook::hook_method reports.
+         * @details Built for hooking the same methods on thousands of objects of one class without a clone, and a
+         *          method table, per object. The first call for a (vtable, method set) key runs @ref vmt_for on
+         *          @p object and installs every method; each later call only swaps @p object's vptr with
+         *          @ref VmtHook::apply_to, so every object on the key dispatches through one cache-resident table. The
+         *          clone is reference-counted by the handles and freed with the last one. Two first calls racing on
+         *          the same key may each create a clone; later callers join whichever is registered first.
+         * @warning The dispatch contract of @ref VmtHook::apply_to: no thread may be making a virtual call through
+         *          @p object while its vptr is swapped, here or when the handle restores it.
+         */
+        [[nodiscard]] Result<SharedVmtHook> vmt_shared(std::string name, void *object,
+                                                       std::span<const VmtMethod> methods, VmtOptions options = {});
+
+        /**
+         * @class SharedVmtHook
+         * @brief Move-only RAII handle for one object on a shared clone from @ref vmt_shared.
+         * @details The destructor restores this object's vptr and drops its reference on the clone; the last handle
+         *          of a clone frees it. Methods cannot be hooked or lifted through a shared handle, since every object
+         *          on the clone would see the change; a different method set is a different clone.
+         */
+        class SharedVmtHook
+        {
+        public:
+            SharedVmtHook(SharedVmtHook &&other) noexcept;
+            SharedVmtHook &operator=(SharedVmtHook &&other) noexcept;
+            SharedVmtHook(const SharedVmtHook &) = delete;
+            SharedVmtHook &operator=(const SharedVmtHook &) = delete;
+
+            /// Restores this object's vptr and releases the clone reference, unless moved-from.
+            ~SharedVmtHook() noexcept;
+
+            /// True while this handle holds an object on a clone (false after a move-out).
+            [[nodiscard]] explicit operator bool() const noexcept;
+
+            /// The object this handle put on the clone (nullptr for a moved-from handle).
+            [[nodiscard]] void *object() const noexcept { return m_object; }
+
+            /// The number of handles currently sharing this handle's clone, this one included (0 if moved-from).
+            [[nodiscard]] std::size_t share_count() const noexcept;
+
+            /**
+             * @brief The pre-hook function pointer for the method at vtable @p index, typed as Fn.
+             * @return The original method, or nullptr for an index outside the clone's method set or a moved-from
+             *         handle. As with @ref VmtHook::original, the pointer is fixed for the clone's lifetime.
+             */
+            template <detail::FunctionPointer Fn> [[nodiscard]] Fn original(std::size_t index) const noexcept
+            {
+                return reinterpret_cast<Fn>(method_original_address(index));
+            }
+
+        private:
+            SharedVmtHook(std::shared_ptr<detail::SharedVmtClone> clone, void *object) noexcept;
+
+            /// The clone's original slot pointer for @p index; defined in src/hook_vmt_shared.cpp.
+            [[nodiscard]] void *method_original_address(std::size_t index) const noexcept;
+
+            std::shared_ptr<detail::SharedVmtClone> m_clone;
+            void *m_object = nullptr;
+
+            friend Result<SharedVmtHook> vmt_shared(std::string name, void *object, std::span<const VmtMethod> methods,
+                                                    VmtOptions options);
+        };
     } // namespace hook
 } // namespace DetourModKit
 
@@ -0,0 +1,433 @@
+#ifndef DETOURMODKIT_HOOK_MUX_HPP
+#define DETOURMODKIT_HOOK_MUX_HPP
+
+/**
+ * @file hook_mux.hpp
+ * @brief One inline detour per target, fanned out to a list of pre / post handlers that can change at any time.
+ * @details When several features (or several mods built on the kit) hook the same hot function, a @ref hook::HookStack
+ *          layers one inline hook per feature and every call bounces through each layer's trampoline. A
+ *          @ref hook::Multiplexer installs a single inline detour instead and runs the registered handlers from an
+ *          immutable snapshot. Pre handlers see the arguments first and may rewrite them or return early; post
+ *          handlers then see the result and may rewrite it. Adding or removing a handler publishes a new snapshot and
+ *          never repatches code, and each handler costs one indirect call.
+ *
+ *          The snapshot is reclaimed like an @ref EventDispatcher handler list: the detour announces itself through
+ *          detail::EmitEpochScope before loading the snapshot, and a replaced snapshot is freed only once no
+ *          announced thread can still be iterating it.
+ */
+
+#include "DetourModKit/detail/event_dispatcher.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/hook.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace hook
+    {
+        /// Identifies one handler registered on a @ref Multiplexer, for @ref Multiplexer::remove.
+        using MuxHandlerId = std::uint64_t;
+
+        /// The stage a @ref Multiplexer handler runs in.
+        enum class MuxPhase : std::uint8_t
+        {
+            Pre,
+            Post,
+        };
+
+        namespace detail
+        {
+            /// Stands in for the result slot of a @ref MuxFrame whose target returns void.
+            struct MuxNoResult
+            {
+            };
+
+            /// One registered handler: its type-erased function pointer and the id it was registered under.
+            struct MuxEntry
+            {
+                void *fn;
+                MuxHandlerId id;
+            };
+
+            /// The immutable handler list one dispatch iterates, in registration order per phase.
+            struct MuxSnapshot
+            {
+                std::vector<MuxEntry> pre;
+                std::vector<MuxEntry> post;
+            };
+
+            /**
+             * @class MuxCore
+             * @brief The signature-independent state of one @ref Multiplexer: the trampoline and the handler snapshot.
+             * @details Writers serialize on a mutex, copy the live snapshot, publish the copy with a seq_cst exchange,
+             *          and retire the one it replaced through a RetiredSnapshots. The reader accessors are inline so
+             *          the detour's no-handler fast path is two acquire loads.
+             */
+            class MuxCore
+            {
+            public:
+                MuxCore() = default;
+                MuxCore(const MuxCore &) = delete;
+                MuxCore &operator=(const MuxCore &) = delete;
+
+                /// Frees the live snapshot and every retired one; no dispatch may be in flight.
+                ~MuxCore() noexcept;
+
+                /// The original-function trampoline, or nullptr until the install publishes it.
+                [[nodiscard]] void *original() const noexcept { return m_original.load(std::memory_order_acquire); }
+
+                /// Publishes the trampoline the detour forwards to.
+                void set_original(void *original) noexcept { m_original.store(original, std::memory_order_release); }
+
+                /// The number of handlers in the live snapshot, across both phases.
+                [[nodiscard]] std::size_t handler_count() const noexcept
+                {
+                    return m_handler_count.load(std::memory_order_acquire);
+                }
+
+                /// The live snapshot; only valid inside an EmitEpochScope entered before the call.
+                [[nodiscard]] const MuxSnapshot *snapshot() const noexcept
+                {
+                    return m_snapshot.load(std::memory_order_seq_cst);
+                }
+
+                /**
+                 * @brief Appends @p fn to @p phase and publishes the result.
+                 * @return The new handler's id, or OutOfMemory with the live snapshot unchanged.
+                 */
+                [[nodiscard]] Result<MuxHandlerId> add(MuxPhase phase, void *fn) noexcept;
+
+                /**
+                 * @brief Drops the handler registered under @p id and publishes the result.
+                 * @return Success, InvalidArg when no live handler has that id, or OutOfMemory with nothing changed.
+                 */
+                [[nodiscard]] Result<void> remove(MuxHandlerId id) noexcept;
+
+            private:
+                // Swaps in @p next under m_writer and retires the snapshot it replaces.
+                void publish_locked(const MuxSnapshot *next) noexcept;
+
+                std::atomic<void *> m_original{nullptr};
+                std::atomic<const MuxSnapshot *> m_snapshot{nullptr};
+                std::atomic<std::size_t> m_handler_count{0};
+                std::mutex m_writer;
+                MuxHandlerId m_next_id = 1;
+                DetourModKit::detail::RetiredSnapshots<MuxSnapshot> m_retired;
+            };
+        } // namespace detail
+
+        template <typename Tag, typename Signature> class Multiplexer;
+
+        /**
+         * @class MuxFrame
+         * @brief The call a @ref Multiplexer handler observes: a copy of the arguments and the result slot.
+         * @details The arguments are copied once on entry and the original is called with the frame's copies, so a
+         *          pre handler that rewrites @ref arg changes what the original and every later handler see.
+         */
+        template <typename Ret, typename... Args> class MuxFrame
+        {
+        public:
+            /// The result slot's type: Ret, or an empty placeholder when the target returns void.
+            using ResultType = std::conditional_t<std::is_void_v<Ret>, detail::MuxNoResult, Ret>;
+
+            /// The number of arguments the target takes.
+            static constexpr std::size_t arity = sizeof...(Args);
+
+            MuxFrame(const MuxFrame &) = delete;
+            MuxFrame &operator=(const MuxFrame &) = delete;
+
+            /// The frame's copy of argument @p I.
+            template <std::size_t I> [[nodiscard]] auto &arg() noexcept { return std::get<I>(m_args); }
+
+            /**
+             * @brief From a pre handler: skip the original and the remaining pre handlers, and return @p value.
+             * @details Post handlers still run and see @p value as the result. From a post handler it only replaces
+             *          the result.
+             */
+            void return_early(ResultType value = {})
+            {
+                m_result = std::move(value);
+                m_returned_early = true;
+            }
+
+            /// True once a handler called @ref return_early.
+            [[nodiscard]] bool returned_early() const noexcept { return m_returned_early; }
+
+            /// The value the call will return: the original's result, or the early-return value, in a post handler.
+            [[nodiscard]] ResultType &result() noexcept
+                requires(!std::is_void_v<Ret>)
+            {
+                return m_result;
+            }
+
+        private:
+            template <typename Tag, typename Signature> friend class Multiplexer;
+
+            explicit MuxFrame(Args... args) : m_args(args...) {}
+
+            std::tuple<Args...> m_args;
+            ResultType m_result{};
+            bool m_returned_early = false;
+        };
+
+        /**
+         * @class Multiplexer
+         * @brief Move-only RAII owner of one multiplexed inline hook; its destructor restores the prologue.
+         * @tparam Tag An arbitrary type naming this target. The kit generates no code at runtime, so the detour is a
+         *         static function per Tag and finds its state through a per-Tag global. Give every multiplexed
+         *         target its own Tag (an empty struct is enough); installing a second Multiplexer of the same Tag while
+         *         one is live fails.
+         * @tparam Signature The target's function type, e.g. `int(void *, float)`. Arguments are passed by value,
+         *         as @ref Hook::call does, so Signature must be the target's real by-value C ABI.
+         * @details Handlers are captureless `void(*)(Frame &)` functions. A call runs every pre handler in registration
+         *          order until one returns early, calls the original with the frame's arguments unless one did, then
+         *          runs every post handler. With no handlers the detour forwards straight to the original. A handler
+         *          may add or remove handlers (the change applies from the next call) and may call the hooked function
+         *          again, which dispatches a nested call.
+         *
+         *          A call that lands between the patch and the trampoline publish at the end of the install returns
+         *          the value-initialized Ret, the same fail-closed default @ref Hook::call gives a not-yet-armed hook.
+         *          Ret must therefore be value-initializable.
+         * @note Lifetime precondition, as for @ref Hook::original: the Multiplexer must outlive every call in flight
+         *       through its detour. The destructor unpatches first, so no new call reaches the handlers, but a thread
+         *       already inside one is not waited for. Handler registration is safe from any thread; install and
+         *       destruction are setup/control-plane only.
+         */
+        template <typename Tag, typename Ret, typename... Args> class Multiplexer<Tag, Ret(Args...)>
+        {
+        public:
+            using Frame = MuxFrame<Ret, Args...>;
+            using Handler = void (*)(Frame &);
+            using Original = Ret (*)(Args...);
+
+            static_assert(std::is_void_v<Ret> || std::is_default_constructible_v<Ret>,
+                          "Multiplexer needs a value-initializable return type for its fail-closed default");
+
+            /**
+             * @brief Installs the multiplexed detour at @p request's target.
+             * @return The owner on success. HookAlreadyExists when a Multiplexer of this Tag is live, OutOfMemory, or
+             *         any Error @ref inline_at reports.
+             */
+            [[nodiscard]] static Result<Multiplexer> install(InlineRequest request)
+            {
+                bool expected = false;
+                if (!s_installed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+                {
+                    return std::unexpected(Error{ErrorCode::HookAlreadyExists, "hook::Multiplexer::install"});
+                }
+                std::unique_ptr<detail::MuxCore> core;
+                try
+                {
+                    core = std::make_unique<detail::MuxCore>();
+                }
+                catch (const std::bad_alloc &)
+                {
+                    s_installed.store(false, std::memory_order_release);
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::Multiplexer::install"});
+                }
+                // The core is published before the patch so a call that wins the race finds it, sees no trampoline
+                // yet, and fails closed instead of dereferencing nothing.
+                s_core.store(core.get(), std::memory_order_release);
+                Result<Hook> hook = inline_at(std::move(request), &detour);
+                if (!hook)
+                {
+                    s_core.store(nullptr, std::memory_order_release);
+                    s_installed.store(false, std::memory_order_release);
+                    return std::unexpected(hook.error());
+                }
+                core->set_original(reinterpret_cast<void *>(hook->original<Original>()));
+                return Multiplexer(std::move(core), std::move(*hook));
+            }
+
+            Multiplexer(Multiplexer &&other) noexcept
+                : m_core(std::move(other.m_core)), m_hook(std::move(other.m_hook))
+            {
+                other.m_hook.reset();
+            }
+
+            Multiplexer &operator=(Multiplexer &&other) noexcept
+            {
+                if (this != &other)
+                {
+                    teardown();
+                    m_core = std::move(other.m_core);
+                    m_hook = std::move(other.m_hook);
+                    other.m_hook.reset();
+                }
+                return *this;
+            }
+
+            Multiplexer(const Multiplexer &) = delete;
+            Multiplexer &operator=(const Multiplexer &) = delete;
+
+            /// Unpatches the target, then frees the handler snapshots; a no-op for a moved-from owner.
+            ~Multiplexer() noexcept { teardown(); }
+
+            /// True while this owner holds the live hook (false after a move-out).
+            [[nodiscard]] explicit operator bool() const noexcept { return m_core != nullptr; }
+
+            /**
+             * @brief Registers @p handler to run before the original.
+             * @return Its id, or InvalidArg (null handler), InvalidHookState (moved-from owner), or OutOfMemory.
+             */
+            [[nodiscard]] Result<MuxHandlerId> add_pre(Handler handler) noexcept { return add(MuxPhase::Pre, handler); }
+
+            /**
+             * @brief Registers @p handler to run after the original.
+             * @return Its id, or InvalidArg (null handler), InvalidHookState (moved-from owner), or OutOfMemory.
+             */
+            [[nodiscard]] Result<MuxHandlerId> add_post(Handler handler) noexcept
+            {
+                return add(MuxPhase::Post, handler);
+            }
+
+            /**
+             * @brief Unregisters the handler @p id names; a call already iterating the old snapshot still runs it.
+             * @return Success, InvalidArg for an unknown id, InvalidHookState (moved-from owner), or OutOfMemory.
+             */
+            [[nodiscard]] Result<void> remove(MuxHandlerId id) noexcept
+            {
+                if (m_core == nullptr)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::Multiplexer::remove"});
+                }
+                return m_core->remove(id);
+            }
+
+            /// The number of registered handlers across both phases (0 for a moved-from owner).
+            [[nodiscard]] std::size_t handler_count() const noexcept
+            {
+                return m_core != nullptr ? m_core->handler_count() : 0;
+            }
+
+            /**
+             * @brief The underlying inline hook, for enable / disable or a @ref Transaction.
+             * @pre The owner is engaged.
+             */
+            [[nodiscard]] Hook &hook() noexcept { return *m_hook; }
+
+            /// The original-function trampoline, for calling the target without dispatching (nullptr if moved-from).
+            [[nodiscard]] Original original() const noexcept
+            {
+                return m_core != nullptr ? reinterpret_cast<Original>(m_core->original()) : nullptr;
+            }
+
+        private:
+            Multiplexer(std::unique_ptr<detail::MuxCore> core, Hook hook) noexcept
+                : m_core(std::move(core)), m_hook(std::move(hook))
+            {
+            }
+
+            [[nodiscard]] Result<MuxHandlerId> add(MuxPhase phase, Handler handler) noexcept
+            {
+                if (handler == nullptr)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "hook::Multiplexer::add"});
+                }
+                if (m_core == nullptr)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::Multiplexer::add"});
+                }
+                return m_core->add(phase, reinterpret_cast<void *>(handler));
+            }
+
+            // Unpatches before unpublishing, so the detour never runs against a released core.
+            void teardown() noexcept
+            {
+                if (m_core == nullptr)
+                {
+                    return;
+                }
+                m_hook.reset();
+                s_core.store(nullptr, std::memory_order_release);
+                m_core.reset();
+                s_installed.store(false, std::memory_order_release);
+            }
+
+            static Ret detour(Args... args)
+            {
+                detail::MuxCore *const core = s_core.load(std::memory_order_acquire);
+                const Original original = core != nullptr ? reinterpret_cast<Original>(core->original()) : nullptr;
+                if (original == nullptr)
+                {
+                    if constexpr (std::is_void_v<Ret>)
+                    {
+                        return;
+                    }
+                    else
+                    {
+                        return Ret{};
+                    }
+                }
+                if (core->handler_count() == 0)
+                {
+                    return original(args...);
+                }
+
+                // As in EventDispatcher::emit, the announcement precedes the snapshot load so a writer that replaces
+                // it afterwards holds the old one back until this call leaves.
+                DetourModKit::detail::EmitEpochScope epoch;
+                const detail::MuxSnapshot &snapshot = *core->snapshot();
+                Frame frame{args...};
+                for (const detail::MuxEntry &entry : snapshot.pre)
+                {
+                    reinterpret_cast<Handler>(entry.fn)(frame);
+                    if (frame.m_returned_early)
+                    {
+                        break;
+                    }
+                }
+                if (!frame.m_returned_early)
+                {
+                    if constexpr (std::is_void_v<Ret>)
+                    {
+                        std::apply(original, frame.m_args);
+                    }
+                    else
+                    {
+                        frame.m_result = std::apply(original, frame.m_args);
+                    }
+                }
+                for (const detail::MuxEntry &entry : snapshot.post)
+                {
+                    reinterpret_cast<Handler>(entry.fn)(frame);
+                }
+                if constexpr (!std::is_void_v<Ret>)
+                {
+                    return std::move(frame.m_result);
+                }
+            }
+
+            static inline std::atomic<detail::MuxCore *> s_core{nullptr};
+            static inline std::atomic<bool> s_installed{false};
+
+            // m_core is heap-allocated so the address s_core publishes survives moves of the owner.
+            std::unique_ptr<detail::MuxCore> m_core;
+            std::optional<Hook> m_hook;
+        };
+
+        /**
+         * @brief Installs a multiplexed inline hook at @p request's target; see @ref Multiplexer.
+         * @tparam Tag A type unique to this target.
+         * @tparam Signature The target's function type.
+         */
+        template <typename Tag, typename Signature>
+        [[nodiscard]] Result<Multiplexer<Tag, Signature>> multiplex_at(InlineRequest request)
+        {
+            return Multiplexer<Tag, Signature>::install(std::move(request));
+        }
+    } // namespace hook
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_HOOK_MUX_HPP
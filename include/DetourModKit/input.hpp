@@ -23,11 +23,13 @@
 #include "DetourModKit/error.hpp"
 #include "DetourModKit/input_codes.hpp"
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -98,6 +100,148 @@ namespace DetourModKit
         inline constexpr std::chrono::milliseconds MIN_POLL_INTERVAL{1};
         /// Upper clamp for the poll interval.
         inline constexpr std::chrono::milliseconds MAX_POLL_INTERVAL{1000};
+        /// Default adaptive-mode idle cadence: the wait while no key or button any binding reads is down.
+        inline constexpr std::chrono::milliseconds DEFAULT_IDLE_POLL_INTERVAL{50};
+        /// Default adaptive-mode quiet timeout: how long after the last activity the fast cadence is kept.
+        inline constexpr std::chrono::milliseconds DEFAULT_ADAPTIVE_QUIET_TIMEOUT{500};
+
+        /**
+         * @struct PollCadenceStats
+         * @brief How the poll thread's cycles were paced since start(), for tuning the adaptive intervals.
+         * @details Each cycle counts once, by the wait that followed it.
+         */
+        struct PollCadenceStats
+        {
+            /// Cycles followed by the fast wait, Settings::poll_interval.
+            std::uint64_t fast_cycles = 0;
+            /// Cycles followed by the adaptive idle wait, Settings::idle_poll_interval.
+            std::uint64_t idle_cycles = 0;
+            /// Backend::RawInput cycles followed by a sleep until the next event.
+            std::uint64_t event_cycles = 0;
+            /// Times the adaptive cadence switched from idle to fast, i.e. activity began.
+            std::uint64_t fast_switches = 0;
+        };
+
+        /// Buckets in a LatencyHistogram; the last absorbs every longer sample.
+        inline constexpr std::size_t INPUT_LATENCY_BUCKETS = 32;
+
+        /**
+         * @struct LatencyHistogram
+         * @brief A log2 histogram of durations in QueryPerformanceCounter ticks.
+         * @details Bucket 0 counts zero-tick samples and bucket i counts samples of [2^(i-1), 2^i) ticks, as the hook
+         *          statistics do (diagnostics::HookStats).
+         */
+        struct LatencyHistogram
+        {
+            std::uint64_t samples = 0;
+            std::uint64_t total_ticks = 0;
+            std::array<std::uint64_t, INPUT_LATENCY_BUCKETS> buckets{};
+        };
+
+        /**
+         * @struct InputLatencyStats
+         * @brief Where the engine's input latency goes, recorded while Settings::latency_stats is set.
+         */
+        struct InputLatencyStats
+        {
+            /// QueryPerformanceFrequency, to convert the tick counts.
+            std::int64_t ticks_per_second = 0;
+            /// One sample per cycle: sampling the bound keys through edge detection and the snapshot publish.
+            LatencyHistogram cycle_cost;
+            /**
+             * One sample per cycle that detected an edge under Backend::RawInput: the WM_INPUT record was taken off
+             * the queue to the edge detected. Empty for polling, which has no event time to start from.
+             */
+            LatencyHistogram event_to_edge;
+            /// One sample per callback: the edge detected to its on_press / on_state_change invoked.
+            LatencyHistogram edge_to_dispatch;
+        };
+
+        /**
+         * @enum Backend
+         * @brief How the engine reads keyboard and mouse buttons. Gamepad and mouse-wheel input are unaffected.
+         */
+        enum class Backend
+        {
+            /// Samples GetAsyncKeyState for every referenced key once per poll interval.
+            Poll,
+            /**
+             * Keeps key state from WM_INPUT events on a message-only window and evaluates bindings as each event
+             * arrives, so an idle engine sleeps and a press is seen without waiting out the poll interval. Falls back
+             * to Poll when the process already has, or later takes over, a raw keyboard or mouse registration: Windows
+             * keeps one target window per device type per process, and the game's own must win.
+             */
+            RawInput
+        };
+
+        /**
+         * @brief Converts a Backend to its string representation.
+         * @param backend The keyboard/mouse backend.
+         * @return String form ("Poll" / "RawInput"), or "Unknown" for an out-of-range value.
+         */
+        [[nodiscard]] constexpr std::string_view to_string(Backend backend) noexcept
+        {
+            switch (backend)
+            {
+            case Backend::Poll:
+                return "Poll";
+            case Backend::RawInput:
+                return "RawInput";
+            }
+            return "Unknown";
+        }
+
+        /**
+         * @enum InputEdge
+         * @brief The transition an InputEvent records.
+         */
+        enum class InputEdge : std::uint8_t
+        {
+            /// The binding became active.
+            Press,
+            /// The binding stopped being active.
+            Release
+        };
+
+        /**
+         * @brief Converts an InputEdge to its string representation.
+         * @param edge The edge kind.
+         * @return String form ("Press" / "Release"), or "Unknown" for an out-of-range value.
+         */
+        [[nodiscard]] constexpr std::string_view to_string(InputEdge edge) noexcept
+        {
+            switch (edge)
+            {
+            case InputEdge::Press:
+                return "Press";
+            case InputEdge::Release:
+                return "Release";
+            }
+            return "Unknown";
+        }
+
+        /**
+         * @struct InputEvent
+         * @brief One binding edge queued by the poll thread for Input::drain_events.
+         * @details Identifies the binding entry by its index under a binding generation, which a BindingToken resolves
+         *          with BindingToken::matches; an event from before a reshape matches no current token. The timestamp
+         *          is the QueryPerformanceCounter value at which the cycle that detected the edge sampled its input, so
+         *          the consumer's own QPC read minus it is the poll-to-consume latency.
+         */
+        struct InputEvent
+        {
+            /// Binding generation the edge was detected under.
+            std::uint64_t generation = 0;
+            /// QueryPerformanceCounter ticks when the detecting cycle sampled its input.
+            std::int64_t timestamp = 0;
+            /// Binding entry index within that generation.
+            std::uint32_t entry = 0;
+            /// Press or release.
+            InputEdge edge = InputEdge::Press;
+        };
+
+        /// Default Settings::event_queue_capacity: 0, no event queue.
+        inline constexpr std::size_t DEFAULT_EVENT_QUEUE_CAPACITY = 0;
 
         /**
          * @struct ComboBinding
@@ -189,8 +333,29 @@ namespace DetourModKit
              */
             [[nodiscard]] bool valid() const noexcept { return m_generation != 0; }
 
+            /**
+             * @brief Reports whether a queued event belongs to this token's binding.
+             * @return false for an invalid token and for an event detected under a different binding generation.
+             */
+            [[nodiscard]] bool matches(const InputEvent &event) const noexcept
+            {
+                if (!valid() || event.generation != m_generation)
+                {
+                    return false;
+                }
+                for (const std::size_t index : m_indices)
+                {
+                    if (index == event.entry)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
         private:
             friend class DetourModKit::detail::InputPoller;
+            friend class InputSnapshot;
 
             // Binding generation this token was minted at; 0 marks an unresolved (invalid) token. A live generation is
             // always >= 1 (drawn from the process-wide counter that starts at 1), so 0 can never collide with a real
@@ -203,6 +368,124 @@ namespace DetourModKit
             std::vector<std::size_t> m_indices;
         };
 
+        /**
+         * @brief Binding entries an InputSnapshot covers.
+         * @details An entry at a higher index reads inactive in a snapshot; query it with Input::is_active instead.
+         */
+        inline constexpr std::size_t SNAPSHOT_BINDING_CAPACITY = 512;
+
+        /**
+         * @class InputSnapshot
+         * @brief One poll cycle's binding state, copied out in one consistent read.
+         * @details Input::snapshot() copies the state the poll thread published at the end of its latest cycle: which
+         *          bindings are active, which rose to active in that cycle, and the wheel notches it drained. Every
+         *          query then tests bits locally, with no lock and no cross-thread load, and two bindings read from
+         *          one snapshot can never disagree about which cycle they came from.
+         *
+         *          A query takes a BindingToken and fails closed (reads false) when the token was minted under a
+         *          different binding generation than the snapshot, exactly as Input::is_active(token) does. Edges are
+         *          those of the latest cycle only, so a reader slower than the poll interval can miss one; use the
+         *          press callbacks when every press matters. A default snapshot reads inactive everywhere.
+         */
+        class InputSnapshot
+        {
+        public:
+            InputSnapshot() = default;
+
+            /// The poll cycle the snapshot was taken from, counting from 1; 0 for a default snapshot.
+            [[nodiscard]] std::uint64_t cycle() const noexcept { return m_cycle; }
+
+            /// Whether any combo of the token's binding was active in the cycle.
+            [[nodiscard]] bool is_active(const BindingToken &token) const noexcept { return any_bit(m_active, token); }
+
+            /// Whether any combo of the token's binding became active in the cycle (a press edge).
+            [[nodiscard]] bool pressed(const BindingToken &token) const noexcept { return any_bit(m_pressed, token); }
+
+            /**
+             * @brief Wheel notches drained in the cycle for one direction.
+             * @param wheel_code A WheelCode direction (WheelCode::Up .. WheelCode::Right); anything else reads 0.
+             * @note Counted only while a wheel binding exists, since the wheel hook is installed for those alone.
+             */
+            [[nodiscard]] int wheel_notches(int wheel_code) const noexcept
+            {
+                const auto index = static_cast<unsigned>(wheel_code - WheelCode::Up);
+                return index < m_wheel.size() ? m_wheel[index] : 0;
+            }
+
+        private:
+            friend class DetourModKit::detail::InputPoller;
+
+            static constexpr std::size_t WORDS = SNAPSHOT_BINDING_CAPACITY / 64;
+
+            [[nodiscard]] bool any_bit(const std::array<std::uint64_t, WORDS> &bits,
+                                       const BindingToken &token) const noexcept
+            {
+                if (!token.valid() || token.m_generation != m_generation)
+                {
+                    return false;
+                }
+                for (const std::size_t index : token.m_indices)
+                {
+                    if (index < SNAPSHOT_BINDING_CAPACITY &&
+                        (bits[index / 64] & (std::uint64_t{1} << (index % 64))) != 0)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            std::uint64_t m_cycle{0};
+            // The binding generation the cycle evaluated; 0 (no generation) for a default snapshot.
+            std::uint64_t m_generation{0};
+            std::array<std::uint64_t, WORDS> m_active{};
+            std::array<std::uint64_t, WORDS> m_pressed{};
+            std::array<int, 4> m_wheel{};
+        };
+
+        /**
+         * @struct GamepadState
+         * @brief One XInput controller reading, field for field as XINPUT_GAMEPAD, so this header needs no <Xinput.h>.
+         */
+        struct GamepadState
+        {
+            /// XINPUT_GAMEPAD.wButtons: the digital button bits (the GamepadCode button values).
+            std::uint16_t buttons = 0;
+            std::uint8_t left_trigger = 0;
+            std::uint8_t right_trigger = 0;
+            std::int16_t left_thumb_x = 0;
+            std::int16_t left_thumb_y = 0;
+            std::int16_t right_thumb_x = 0;
+            std::int16_t right_thumb_y = 0;
+        };
+
+        /**
+         * @struct GamepadSnapshot
+         * @brief The poll thread's latest reading of its controller slot, for a consumer that needs analog values.
+         * @details Input::gamepad_snapshot() copies what the poll thread's latest XInputGetState call returned, so a
+         *          mod reading sticks or triggers need not make the call again, and never sees the suppression mask
+         *          halfway applied. @ref raw is the controller's own state (read through the suppression hook's
+         *          trampoline); @ref game is what that hook hands the game for the same reading, i.e. @ref raw less
+         *          the buttons a consume binding currently owns. The two are equal while nothing is suppressed.
+         *
+         *          The poll thread reads the controller only while a gamepad binding is registered and, with
+         *          Settings::require_focus, the process is focused; a disconnected slot is re-probed on a backoff.
+         *          The snapshot keeps the last reading in between, so compare @ref timestamp to tell how old it is.
+         */
+        struct GamepadSnapshot
+        {
+            /// QueryPerformanceCounter ticks when the poll read the controller; 0 before the first read.
+            std::int64_t timestamp = 0;
+            /// XINPUT_STATE.dwPacketNumber of the reading; it changes only when the controller state does.
+            std::uint32_t packet_number = 0;
+            /// The XInput slot read (Settings::gamepad_index).
+            std::uint32_t slot = 0;
+            /// Whether the read succeeded. Both states are zero when it did not.
+            bool connected = false;
+            GamepadState raw{};
+            GamepadState game{};
+        };
+
         /**
          * @class BindingGuard
          * @brief Move-only RAII cancellation token for a binding from register_combo or config::press_combo /
@@ -364,8 +647,9 @@ namespace DetourModKit
             /**
              * @struct Settings
              * @brief Poll-thread and gamepad tuning applied when start() builds the engine.
-             * @details poll_interval is clamped to [MIN_POLL_INTERVAL, MAX_POLL_INTERVAL]. The gamepad knobs take
-             *          effect only at start(); change require_focus live with set_require_focus.
+             * @details poll_interval is clamped to [MIN_POLL_INTERVAL, MAX_POLL_INTERVAL]. The gamepad knobs, the
+             *          backend, and the adaptive cadence take effect only at start(); change require_focus live with
+             *          set_require_focus.
              */
             struct Settings
             {
@@ -379,6 +663,27 @@ namespace DetourModKit
                 int trigger_threshold = GamepadCode::TriggerThreshold;
                 /// Thumbstick deadzone (0-32767). An axis exceeding this in any direction reads as pressed.
                 int stick_threshold = GamepadCode::StickThreshold;
+                /// Keyboard/mouse backend. Backend::RawInput is event-driven; see Backend for its fallback rule.
+                Backend backend = Backend::Poll;
+                /**
+                 * When true, the engine waits idle_poll_interval between cycles while no key or button any binding
+                 * reads is down and no binding is active, and poll_interval from the first such input until
+                 * adaptive_quiet_timeout after the last. The first press of an idle spell is then seen up to
+                 * idle_poll_interval late, and a tap shorter than it can be missed.
+                 */
+                bool adaptive_polling = false;
+                /// Adaptive idle cadence. Clamped to [poll_interval, MAX_POLL_INTERVAL].
+                std::chrono::milliseconds idle_poll_interval = DEFAULT_IDLE_POLL_INTERVAL;
+                /// Adaptive quiet timeout before dropping back to idle_poll_interval.
+                std::chrono::milliseconds adaptive_quiet_timeout = DEFAULT_ADAPTIVE_QUIET_TIMEOUT;
+                /**
+                 * Capacity of the edge queue read by drain_events, rounded up to a power of 2; 0 (default) keeps no
+                 * queue. The poll thread queues every binding's press and release edges alongside the callbacks, and
+                 * drops an edge, counting it in dropped_events, while the queue is full.
+                 */
+                std::size_t event_queue_capacity = DEFAULT_EVENT_QUEUE_CAPACITY;
+                /// When true, the engine times each cycle and callback into latency_stats(), at a QPC read per timestamp.
+                bool latency_stats = false;
             };
 
             /**
@@ -434,6 +739,40 @@ namespace DetourModKit
             /// Returns the number of registered binding entries (pending before start, or live after).
             [[nodiscard]] std::size_t binding_count() const noexcept;
 
+            /**
+             * @brief Copies the state the poll thread published at the end of its latest cycle.
+             * @details Lock-free: retries only while the poll thread is mid-publish. Cheaper than several
+             *          is_active(token) calls in one frame, and consistent across them. A default (inactive) snapshot
+             *          while the engine is not running.
+             */
+            [[nodiscard]] InputSnapshot snapshot() const noexcept;
+
+            /**
+             * @brief Copies the poll thread's latest controller reading (see GamepadSnapshot).
+             * @details Lock-free: retries only while the poll thread is mid-publish. A default (disconnected) snapshot
+             *          while the engine is not running.
+             */
+            [[nodiscard]] GamepadSnapshot gamepad_snapshot() const noexcept;
+
+            /**
+             * @brief Moves the oldest queued binding edges into @p out, for a consumer that handles input on its own
+             *        thread instead of in the poll-thread callbacks.
+             * @details Lock-free for the poll thread; concurrent drain_events calls serialize with one another. Match
+             *          each event to a binding with BindingToken::matches.
+             * @param out Receives up to out.size() events, oldest first.
+             * @return The number written; 0 while no engine is running or Settings::event_queue_capacity was 0.
+             */
+            std::size_t drain_events(std::span<InputEvent> out) noexcept;
+
+            /// Returns the edges the running engine dropped because its event queue was full.
+            [[nodiscard]] std::uint64_t dropped_events() const noexcept;
+
+            /// Returns the running engine's latency histograms; all zero unless it started with latency_stats set.
+            [[nodiscard]] InputLatencyStats latency_stats() const noexcept;
+
+            /// Returns how the running engine's cycles were paced; all zero while no engine is running.
+            [[nodiscard]] PollCadenceStats poll_cadence_stats() const noexcept;
+
             /**
              * @brief Queries whether any combo of a named binding is currently pressed.
              * @param name The binding name.
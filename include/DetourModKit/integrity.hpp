@@ -0,0 +1,155 @@
+#ifndef DETOURMODKIT_INTEGRITY_HPP
+#define DETOURMODKIT_INTEGRITY_HPP
+
+/**
+ * @file integrity.hpp
+ * @brief Code integrity monitoring: per-page hashes of the code a mod depends on, re-verified a few pages at a time.
+ * @details Another mod, or the game's own anti-tamper, may repatch a function a mod hooked or an instruction an anchor
+ *          resolved into. @ref hook::is_target_hooked answers that for one target at the moment it is asked. A
+ *          @ref integrity::CodeMonitor instead hashes each watched range one page at a time when the range is added.
+ *          Each @ref integrity::CodeMonitor::verify then re-hashes the next @p max_pages pages round-robin, so the
+ *          cost of one tick is fixed however much code is watched, and every page is covered again after
+ *          `page_count() / max_pages` ticks. @ref integrity::CodeMonitor::start runs those ticks on a background
+ *          worker. A page whose hash diverges raises a @ref integrity::CodeChangedEvent on
+ *          @ref integrity::CodeMonitor::changes with the changed part of the watched range.
+ *
+ *          The page hash (@ref integrity::page_hash) runs four 64-bit lanes over each 32-byte block, four at once
+ *          with AVX2 where the CPU has it. The scalar path computes the same value, so a baseline taken on one path
+ *          verifies on the other. It detects changes, not forgery: it is not a cryptographic hash.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/detail/event_dispatcher.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace DetourModKit
+{
+    namespace integrity
+    {
+        /// Granularity of a @ref CodeMonitor hash: a watched range is split at these boundaries.
+        inline constexpr std::size_t PAGE_BYTES = 4096;
+
+        /**
+         * @brief The change-detection hash @ref CodeMonitor keeps for each page.
+         * @details The same bytes always hash to the same value, on either the AVX2 or the scalar path, and the length
+         *          is mixed in, so a truncated copy does not match.
+         */
+        [[nodiscard]] std::uint64_t page_hash(std::span<const std::byte> bytes) noexcept;
+
+        /**
+         * @struct CodeChangedEvent
+         * @brief One watched page whose contents no longer match the hash taken for it.
+         * @details @ref label aliases the monitor's copy of the watch label for the duration of the emit only; copy it
+         *          to keep it.
+         */
+        struct CodeChangedEvent
+        {
+            /// The label the range was watched under.
+            std::string_view label;
+            /// The part of the watched range inside the changed page.
+            Region range;
+            /// The hash the page had before, or 0 when it did not read before.
+            std::uint64_t baseline = 0;
+            /// The hash it has now, or 0 when it no longer reads.
+            std::uint64_t observed = 0;
+            /// False when the page no longer reads, e.g. its module unloaded.
+            bool readable = true;
+        };
+
+        /**
+         * @struct MonitorOptions
+         * @brief The background pace of @ref CodeMonitor::start.
+         */
+        struct MonitorOptions
+        {
+            /// Pages re-hashed per tick. Must be non-zero.
+            std::size_t pages_per_tick = 4;
+            /// Sleep between ticks. Must be positive.
+            std::chrono::milliseconds interval{100};
+        };
+
+        /**
+         * @class CodeMonitor
+         * @brief Per-page hashes of a set of watched code ranges, re-verified incrementally.
+         * @details A page reports once per change: after its event it takes the observed hash as its new baseline. A
+         *          mod that patches watched code itself should rebaseline() once its own patch is in place.
+         *
+         *          watch(), rebaseline(), verify() and the worker may run on different threads. Handlers run on the
+         *          thread that ran verify(), with no monitor lock held, so a handler may call watch() or rebaseline().
+         *          It must not call verify(), stop() or the destructor.
+         * @note Move-only. A moved-from monitor is empty and may only be destroyed or assigned to.
+         */
+        class CodeMonitor
+        {
+        public:
+            /// Creates an empty monitor, or Error{OutOfMemory}.
+            [[nodiscard]] static Result<CodeMonitor> make() noexcept;
+
+            CodeMonitor(CodeMonitor &&) noexcept;
+            CodeMonitor &operator=(CodeMonitor &&) noexcept;
+            CodeMonitor(const CodeMonitor &) = delete;
+            CodeMonitor &operator=(const CodeMonitor &) = delete;
+            /// Stops the worker first (see stop()).
+            ~CodeMonitor() noexcept;
+
+            /**
+             * @brief Hashes @p range page by page and watches it under @p label.
+             * @details Typically a hooked target's first bytes or the instruction an anchor resolved into. A range that
+             *          straddles a page boundary is watched as two pages.
+             * @return The watch's index, or InvalidArg for an empty @p range, ReadFaulted when part of it does not
+             *         read now, or OutOfMemory. Nothing is watched on failure.
+             */
+            [[nodiscard]] Result<std::size_t> watch(std::string label, Region range) noexcept;
+
+            /// Re-hashes every watched page and takes the result as its baseline, raising no event.
+            void rebaseline() noexcept;
+
+            /**
+             * @brief Re-hashes the next @p max_pages watched pages, round-robin, and raises an event for each one
+             *        whose hash changed.
+             * @details A page that stops reading, or reads again, also counts as changed. Serialized against the
+             *          worker's ticks.
+             * @return The number of pages that changed.
+             */
+            std::size_t verify(std::size_t max_pages) noexcept;
+
+            /**
+             * @brief Runs verify(`options.pages_per_tick`) on a background worker every `options.interval`.
+             * @details A running worker is stopped first, so a second start() changes the pace.
+             * @return Empty, or InvalidArg for a zero `pages_per_tick` or a non-positive `interval`, OutOfMemory, or
+             *         SystemCallFailed when the worker thread cannot start.
+             */
+            [[nodiscard]] Result<void> start(MonitorOptions options = {}) noexcept;
+
+            /// Stops and joins the worker (see StoppableWorker::shutdown()). Idempotent.
+            void stop() noexcept;
+
+            /// True while the worker runs.
+            [[nodiscard]] bool running() const noexcept;
+
+            /// Watched pages across every range.
+            [[nodiscard]] std::size_t page_count() const noexcept;
+
+            /// The changed-page events. The reference is stable for the monitor's lifetime, across moves.
+            [[nodiscard]] EventDispatcher<CodeChangedEvent> &changes() noexcept;
+
+        private:
+            struct Impl;
+
+            explicit CodeMonitor(std::unique_ptr<Impl> impl) noexcept;
+
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace integrity
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTEGRITY_HPP
@@ -0,0 +1,122 @@
+#ifndef DETOURMODKIT_LOG_KV_HPP
+#define DETOURMODKIT_LOG_KV_HPP
+
+/**
+ * @file log_kv.hpp
+ * @brief File format and decoder of the structured log that Logger::log_kv() writes through the async writer
+ *        (AsyncLoggerConfig::structured_log_path).
+ * @details A structured log holds events, not text: each log_kv() record is an event id with named scalar fields. The
+ *          event's schema (id, call site, and each field's name and type) is written once, the first time the call
+ *          site logs, and every record after it carries only the schema number, the time, the level and the values.
+ *          A register dump of a dozen fields is then a few dozen bytes on disk instead of a few hundred characters,
+ *          and the writer copies bits instead of formatting text.
+ *
+ *          The format is little-endian. After a KV_FILE_HEADER_SIZE-byte header (magic u64, version u32, reserved
+ *          u32) the file is a sequence of records, each a kind byte, a varint payload size, and the payload:
+ *
+ *            KV_RECORD_SCHEMA   varint schema number, varint-length event id, varint-length source file name,
+ *                               varint line, varint field count, then per field a type byte and a varint-length name
+ *            KV_RECORD_EVENT    varint schema number, level byte, zigzag varint microseconds since the previous event
+ *                               (since the Unix epoch for the first), then per field its value: Bool one byte,
+ *                               Float32 4 bytes, Float64 8 bytes, and Int, UInt and Pointer a zigzag varint of the
+ *                               (wrapping) difference from the same field of the schema's previous event (from 0 for
+ *                               its first)
+ *
+ *          A record of an unknown kind is skipped by its size. A file cut short (the process died mid-write) decodes
+ *          up to its last whole record. The DetourModKit_log_kv_decode tool (DMK_BUILD_TOOLS) prints a file as
+ *          text or JSON lines.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/logger.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace log_kv
+    {
+        /// "DMKKVLG1" read as a little-endian u64.
+        inline constexpr std::uint64_t KV_MAGIC = 0x31474C564B4B4D44ULL;
+        inline constexpr std::uint32_t KV_VERSION = 1;
+        inline constexpr std::size_t KV_FILE_HEADER_SIZE = 16;
+        inline constexpr std::uint8_t KV_RECORD_SCHEMA = 1;
+        inline constexpr std::uint8_t KV_RECORD_EVENT = 2;
+
+        /// One field of a schema.
+        struct FieldSchema
+        {
+            std::string name;
+            KvType type{KvType::Int};
+        };
+
+        /// One event shape: the log_kv() call site that produced it.
+        struct Schema
+        {
+            std::string event_id;
+            std::string file;
+            std::uint32_t line{0};
+            std::vector<FieldSchema> fields;
+        };
+
+        /// One decoded log_kv() record.
+        struct Event
+        {
+            /// Index into Decoded::schemas.
+            std::size_t schema{0};
+            /// UTC time the record was logged, in microseconds since the Unix epoch.
+            std::int64_t time_us{0};
+            LogLevel level{LogLevel::Info};
+            /// One value per schema field, in the bit layout of detail::KvLogField::bits.
+            std::vector<std::uint64_t> values;
+        };
+
+        /// The result of @ref decode.
+        struct Decoded
+        {
+            std::vector<Schema> schemas;
+            std::vector<Event> events;
+            /// The file ends inside a record, or a record is malformed; everything before it is decoded.
+            bool truncated{false};
+        };
+
+        /**
+         * @brief Appends the text of one value: true/false, a decimal number, or 0x-prefixed hex for a pointer.
+         * @throws std::bad_alloc when @p out cannot grow.
+         */
+        void append_value(std::string &out, KvType type, std::uint64_t bits);
+
+        /**
+         * @brief Decodes a structured log image.
+         * @return The schemas and events, or `ErrorCode::MissingHeader` when @p image does not start with a version-1
+         *         header.
+         */
+        [[nodiscard]] Result<Decoded> decode(std::span<const std::byte> image);
+
+        /**
+         * @brief Reads a structured log file and decodes it; the file may still be open in a running logger.
+         * @return The decoded log, `ErrorCode::FileOpenFailed` when the file cannot be read, or decode()'s error.
+         */
+        [[nodiscard]] Result<Decoded> read_file(const std::string &path);
+
+        /**
+         * @brief Renders @p event as the text log would: "[<time>.<ms>] [LEVEL  ] :: [file:line] event name=value".
+         * @param timestamp_format strftime-style format of the local time, as in AsyncLoggerConfig.
+         */
+        [[nodiscard]] std::string format_text(const Decoded &decoded, const Event &event,
+                                              std::string_view timestamp_format = DEFAULT_TIMESTAMP_FORMAT);
+
+        /**
+         * @brief Renders @p event as one JSON object: time_us, level, event, file, line, and a fields object.
+         * @details Numbers stay numbers (a UInt past 2^53 is still written exactly); pointers are "0x..." strings.
+         */
+        [[nodiscard]] std::string format_json(const Decoded &decoded, const Event &event);
+    } // namespace log_kv
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_LOG_KV_HPP
@@ -0,0 +1,117 @@
+#ifndef DETOURMODKIT_LOG_RING_HPP
+#define DETOURMODKIT_LOG_RING_HPP
+
+/**
+ * @file log_ring.hpp
+ * @brief On-disk layout and decoder of the async logger's crash ring (AsyncLoggerConfig::crash_ring_path).
+ * @details The crash ring is a fixed-size file the async logger maps into memory and fills as a ring of
+ *          RING_SLOT_SIZE-byte slots, one log line per slot. A producer claims a slot with one atomic increment of the
+ *          header's sequence counter, copies the line in, and publishes it by storing the slot's sequence number last.
+ *          No system call is involved, and because the pages belong to a file mapping the OS writes them back even
+ *          when the process dies without flushing or closing anything: the lines still waiting in the async queue at
+ *          a crash are in the ring. What the ring cannot survive is the machine going down before the pages reach
+ *          the disk.
+ *
+ *          The format is little-endian and fixed:
+ *
+ *            header (RING_HEADER_SIZE bytes)   magic u64, version u32, slot_size u32, slot_count u64,
+ *                                              last claimed sequence u64, reserved
+ *            slot   (RING_SLOT_SIZE bytes)     sequence u64 (0 = never written or being rewritten), UTC time in
+ *                                              microseconds i64, checksum u32, text length u16, level u8, flags u8,
+ *                                              then up to RING_SLOT_TEXT_SIZE bytes of text
+ *
+ *          @ref decode returns the surviving lines oldest first. A slot whose checksum does not match (a producer died
+ *          mid-copy, or two producers lapped the ring onto one slot at once) is counted in Decoded::torn_slots and
+ *          skipped. The DetourModKit_log_ring_decode tool (DMK_BUILD_TOOLS) prints a ring file as text.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/logger.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace log_ring
+    {
+        /// "DMKRING1" read as a little-endian u64.
+        inline constexpr std::uint64_t RING_MAGIC = 0x31474E49524B4D44ULL;
+        inline constexpr std::uint32_t RING_VERSION = 1;
+        inline constexpr std::size_t RING_HEADER_SIZE = 64;
+        inline constexpr std::size_t RING_SLOT_SIZE = 512;
+        inline constexpr std::size_t RING_SLOT_HEADER_SIZE = 24;
+        /// Longest line a slot holds; a longer one is cut and flagged RING_FLAG_TRUNCATED.
+        inline constexpr std::size_t RING_SLOT_TEXT_SIZE = RING_SLOT_SIZE - RING_SLOT_HEADER_SIZE;
+        inline constexpr std::uint8_t RING_FLAG_TRUNCATED = 0x01;
+
+        /// Byte offsets of the header and slot fields.
+        inline constexpr std::size_t HEADER_MAGIC_OFFSET = 0;
+        inline constexpr std::size_t HEADER_VERSION_OFFSET = 8;
+        inline constexpr std::size_t HEADER_SLOT_SIZE_OFFSET = 12;
+        inline constexpr std::size_t HEADER_SLOT_COUNT_OFFSET = 16;
+        inline constexpr std::size_t HEADER_SEQUENCE_OFFSET = 24;
+        inline constexpr std::size_t SLOT_SEQUENCE_OFFSET = 0;
+        inline constexpr std::size_t SLOT_TIME_OFFSET = 8;
+        inline constexpr std::size_t SLOT_CHECKSUM_OFFSET = 16;
+        inline constexpr std::size_t SLOT_LENGTH_OFFSET = 20;
+        inline constexpr std::size_t SLOT_LEVEL_OFFSET = 22;
+        inline constexpr std::size_t SLOT_FLAGS_OFFSET = 23;
+
+        /// One line recovered from a ring.
+        struct Record
+        {
+            std::uint64_t sequence{0};
+            /// UTC time the line was logged, in microseconds since the Unix epoch.
+            std::int64_t time_us{0};
+            LogLevel level{LogLevel::Info};
+            /// The line was longer than RING_SLOT_TEXT_SIZE and is cut short.
+            bool truncated{false};
+            std::string text;
+        };
+
+        /// The result of @ref decode.
+        struct Decoded
+        {
+            /// Surviving lines, oldest first.
+            std::vector<Record> records;
+            /// Lines ever claimed in the ring; more than records.size() once the ring has wrapped.
+            std::uint64_t total_sequence{0};
+            /// Written slots whose contents failed the checksum.
+            std::size_t torn_slots{0};
+        };
+
+        /**
+         * @brief The checksum stored in a slot: 32-bit FNV-1a over its time, length, level, flags and text.
+         * @param slot One RING_SLOT_SIZE-byte slot; the length field must already be written.
+         */
+        [[nodiscard]] std::uint32_t slot_checksum(std::span<const std::byte, RING_SLOT_SIZE> slot) noexcept;
+
+        /**
+         * @brief Unrolls a ring image into its surviving lines.
+         * @param image The whole ring file.
+         * @return The records, or `ErrorCode::MissingHeader` when @p image is not a version-1 ring (wrong magic,
+         *         version or slot size, or shorter than its header says).
+         */
+        [[nodiscard]] Result<Decoded> decode(std::span<const std::byte> image);
+
+        /**
+         * @brief Reads a ring file and decodes it; the ring may still be mapped by a running logger.
+         * @return The decoded ring, `ErrorCode::FileOpenFailed` when the file cannot be read, or decode()'s error.
+         */
+        [[nodiscard]] Result<Decoded> read_file(const std::string &path);
+
+        /**
+         * @brief Renders @p record the way the async writer renders a line: "[<time>.<ms>] [LEVEL  ] :: text".
+         * @param timestamp_format strftime-style format of the local time, as in AsyncLoggerConfig.
+         */
+        [[nodiscard]] std::string format_line(const Record &record,
+                                              std::string_view timestamp_format = DEFAULT_TIMESTAMP_FORMAT);
+    } // namespace log_ring
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_LOG_RING_HPP
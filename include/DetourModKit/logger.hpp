@@ -29,13 +29,20 @@
 
 #include <array>
 #include <atomic>
+#include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <format>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <source_location>
+#include <span>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 
 namespace DetourModKit
 {
@@ -90,6 +97,35 @@ namespace DetourModKit
         return "UNKNOWN";
     }
 
+/**
+ * @def DMK_LOG_COMPILE_MIN_LEVEL
+ * @brief The lowest LogLevel (as its underlying value, 0 = Trace .. 3 = Warning) compiled into the formatted loggers.
+ * @details Set through the DMK_LOG_COMPILE_MIN_LEVEL CMake cache option, which defines it PUBLIC so the library and
+ *          every consumer agree. The default, 0, keeps every level.
+ */
+#ifndef DMK_LOG_COMPILE_MIN_LEVEL
+#define DMK_LOG_COMPILE_MIN_LEVEL 0
+#endif
+
+    static_assert(DMK_LOG_COMPILE_MIN_LEVEL >= 0 &&
+                      DMK_LOG_COMPILE_MIN_LEVEL <= static_cast<int>(LogLevel::Warning),
+                  "DMK_LOG_COMPILE_MIN_LEVEL must name Trace (0) through Warning (3); errors cannot be compiled out");
+
+    /**
+     * @brief The compile-time log level floor, from DMK_LOG_COMPILE_MIN_LEVEL.
+     * @details A record below it is never written, whatever Logger::set_log_level says. The level-named templates
+     *          below the floor have empty bodies, so a `trace(...)` call costs no level load, no branch and no
+     *          formatting; Logger::is_enabled folds to false for those levels, so work gated behind it is removed too.
+     *          set_log_level still filters at run time among the levels at or above the floor.
+     */
+    inline constexpr LogLevel LOG_COMPILE_MIN_LEVEL = static_cast<LogLevel>(DMK_LOG_COMPILE_MIN_LEVEL);
+
+    /// True when records at @p level are compiled in, i.e. @p level is at or above LOG_COMPILE_MIN_LEVEL.
+    [[nodiscard]] constexpr bool log_level_compiled_in(LogLevel level) noexcept
+    {
+        return level >= LOG_COMPILE_MIN_LEVEL;
+    }
+
     /**
      * @brief Parses a level name back into a LogLevel (case-insensitive).
      * @param level_str The level name, e.g. "INFO" or "debug". Surrounding whitespace is NOT trimmed.
@@ -101,6 +137,95 @@ namespace DetourModKit
      */
     [[nodiscard]] LogLevel string_to_log_level(std::string_view level_str);
 
+    /**
+     * @enum LogCategory
+     * @brief The subsystem a categorized record belongs to, each with its own run-time level.
+     * @details The kit's own subsystems log under the first six; User0..User3 are free for a mod's own areas. A
+     *          category follows the global Logger::set_log_level until Logger::set_log_level(category, level) pins it,
+     *          so `Scan = DEBUG` turns on scanner debug output without turning it on for input, config and hooks.
+     *          A record logged without a category is filtered by the global level alone.
+     */
+    enum class LogCategory : std::uint8_t
+    {
+        Hook,
+        Scan,
+        Memory,
+        Input,
+        Config,
+        Rtti,
+        User0,
+        User1,
+        User2,
+        User3,
+        Count
+    };
+
+    /// The number of log categories: the size of Logger's per-category level table.
+    inline constexpr std::size_t LOG_CATEGORY_COUNT = static_cast<std::size_t>(LogCategory::Count);
+
+    /**
+     * @brief Returns the name of a log category, as used for its INI key ("Hook", "Scan", ..., "User3").
+     * @return A static string view, or "Unknown" for Count or an out-of-range value.
+     * @note Callback-safe: pure, allocation-free, and noexcept.
+     */
+    [[nodiscard]] constexpr std::string_view to_string(LogCategory category) noexcept
+    {
+        switch (category)
+        {
+        case LogCategory::Hook:
+            return "Hook";
+        case LogCategory::Scan:
+            return "Scan";
+        case LogCategory::Memory:
+            return "Memory";
+        case LogCategory::Input:
+            return "Input";
+        case LogCategory::Config:
+            return "Config";
+        case LogCategory::Rtti:
+            return "Rtti";
+        case LogCategory::User0:
+            return "User0";
+        case LogCategory::User1:
+            return "User1";
+        case LogCategory::User2:
+            return "User2";
+        case LogCategory::User3:
+            return "User3";
+        case LogCategory::Count:
+            break;
+        }
+        return "Unknown";
+    }
+
+    /**
+     * @struct LogCategoryTag
+     * @brief A compile-time category argument for the categorized Logger templates.
+     * @details Passing the category as a type rather than a run-time value lets the templates index the level table
+     *          with a constant, so the categorized enabled check is one relaxed load like the uncategorized one.
+     *          Use the objects in @ref log_category: `log().debug(log_category::scan, "...")`.
+     */
+    template <LogCategory Category> struct LogCategoryTag
+    {
+        static_assert(Category < LogCategory::Count, "LogCategory::Count is not a category");
+        static constexpr LogCategory value = Category;
+    };
+
+    /// Tag objects for the categorized Logger templates, one per LogCategory.
+    namespace log_category
+    {
+        inline constexpr LogCategoryTag<LogCategory::Hook> hook{};
+        inline constexpr LogCategoryTag<LogCategory::Scan> scan{};
+        inline constexpr LogCategoryTag<LogCategory::Memory> memory{};
+        inline constexpr LogCategoryTag<LogCategory::Input> input{};
+        inline constexpr LogCategoryTag<LogCategory::Config> config{};
+        inline constexpr LogCategoryTag<LogCategory::Rtti> rtti{};
+        inline constexpr LogCategoryTag<LogCategory::User0> user0{};
+        inline constexpr LogCategoryTag<LogCategory::User1> user1{};
+        inline constexpr LogCategoryTag<LogCategory::User2> user2{};
+        inline constexpr LogCategoryTag<LogCategory::User3> user3{};
+    } // namespace log_category
+
     /// Default subsystem prefix stamped into the log file's banner line.
     inline constexpr const char *DEFAULT_LOG_PREFIX = "DetourModKit";
     /// Default log file name, resolved against the runtime module directory when relative.
@@ -138,8 +263,11 @@ namespace DetourModKit
          * @brief Wraps a compile-time format string and records the originating source location.
          * @param s The format string; validated against Args at compile time exactly as std::format would.
          * @param loc Defaulted to the call site through std::source_location::current(); do not pass explicitly.
+         * @note Constrained like std::format_string's own constructor, so a LogCategoryTag first argument selects the
+         *       categorized overloads instead of making the uncategorized ones ambiguous.
          */
         template <typename String>
+            requires std::convertible_to<const String &, std::string_view>
         consteval LocatedFormat(const String &s, std::source_location loc = std::source_location::current()) noexcept
             : fmt(s), where(loc)
         {
@@ -151,6 +279,205 @@ namespace DetourModKit
         std::source_location where;
     };
 
+    namespace detail
+    {
+        /// Renders a deferred log record (header followed by the packed arguments) into @p out.
+        using DeferredLogRender = void (*)(std::string &out, const std::byte *record);
+
+        /**
+         * @struct DeferredLogHeader
+         * @brief The leading bytes of a deferred log record: how to render it and what it renders.
+         * @details The format string and file name point at static storage (a consteval-checked literal and the
+         *          compiler's source_location string), so the writer may read them after the call site returned.
+         */
+        struct DeferredLogHeader
+        {
+            DeferredLogRender render;
+            const char *format;
+            std::size_t format_size;
+            const char *file;
+            std::uint_least32_t line;
+        };
+
+        /**
+         * @brief An argument whose value alone determines its formatted text, so its bytes can be rendered later.
+         * @details Arithmetic types and untyped pointers (formatted as an address). Character pointers, string views,
+         *          and user types can reference caller memory that is gone by the time the writer runs, so they are
+         *          never deferred.
+         */
+        template <typename T>
+        concept DeferrableLogArg = std::is_arithmetic_v<T> || std::is_same_v<T, void *> ||
+                                   std::is_same_v<T, const void *> || std::is_same_v<T, std::nullptr_t>;
+
+        /**
+         * @brief Opt-in for a trivially copyable value type whose std::formatter renders from its bytes alone.
+         * @details Specialised to true beside the formatter itself (format.hpp does so for Address and Region), so a
+         *          translation unit that can format the type can also defer it. Unlike DeferrableLogArg it does not
+         *          make the type a log_kv() field.
+         */
+        template <typename T> struct DeferredLogFormat : std::false_type
+        {
+        };
+
+        /// An argument a deferred text record may carry: a DeferrableLogArg or an opted-in DeferredLogFormat type.
+        template <typename T>
+        concept DeferredFormatArg =
+            DeferrableLogArg<T> || (DeferredLogFormat<T>::value && std::is_trivially_copyable_v<T> &&
+                                    std::is_default_constructible_v<T>);
+
+        /// Bytes of the deferred record for @p Args: the header followed by each argument's object representation.
+        template <typename... Args>
+        inline constexpr std::size_t deferred_log_record_size = sizeof(DeferredLogHeader) + (sizeof(Args) + ... + 0);
+
+        /**
+         * @brief True when a line formatted from @p Args can be deferred: at least one argument, all deferrable, and a
+         *        record that fits the async inline message buffer.
+         */
+        template <typename... Args>
+        inline constexpr bool deferrable_log_args =
+            sizeof...(Args) > 0 && (DeferredFormatArg<std::remove_cvref_t<Args>> && ...) &&
+            deferred_log_record_size<std::remove_cvref_t<Args>...> <= LOG_INLINE_MESSAGE_SIZE;
+    } // namespace detail
+
+    /**
+     * @enum KvType
+     * @brief The value type of one log_kv() field, as stored in a structured log (see log_kv.hpp).
+     * @details Character types are integers here. A long double is narrowed to Float64.
+     */
+    enum class KvType : std::uint8_t
+    {
+        Bool = 0,
+        Int = 1,
+        UInt = 2,
+        Float32 = 3,
+        Float64 = 4,
+        Pointer = 5,
+    };
+
+    /**
+     * @struct KvField
+     * @brief One named value of a log_kv() record; build it with kv().
+     * @tparam T A scalar or untyped pointer (detail::DeferrableLogArg), so the record never references caller memory.
+     */
+    template <typename T> struct KvField
+    {
+        /// The field name: a string literal, so the writer can read it after the call site returned.
+        const char *name;
+        T value;
+    };
+
+    /// Names @p value as field @p name of a log_kv() record. @p name must be a string literal.
+    template <std::size_t N, typename T>
+        requires detail::DeferrableLogArg<std::remove_cvref_t<T>>
+    [[nodiscard]] constexpr KvField<std::remove_cvref_t<T>> kv(const char (&name)[N], T &&value) noexcept
+    {
+        return {name, value};
+    }
+
+    /**
+     * @struct KvEvent
+     * @brief The event id of a log_kv() record plus its call site, captured the way LocatedFormat captures a log site.
+     */
+    struct KvEvent
+    {
+        /**
+         * @param event_id A string literal naming the event, such as "hook.installed".
+         * @param loc Defaulted to the call site through std::source_location::current(); do not pass explicitly.
+         */
+        template <std::size_t N>
+        consteval KvEvent(const char (&event_id)[N],
+                          std::source_location loc = std::source_location::current()) noexcept
+            : id(event_id, N - 1), where(loc)
+        {
+        }
+
+        std::string_view id;
+        std::source_location where;
+    };
+
+    namespace detail
+    {
+        /// One packed field of a structured record: the name literal, its type, and the value's bits.
+        struct KvLogField
+        {
+            const char *name;
+            std::uint64_t bits;
+            KvType type;
+        };
+
+        /**
+         * @struct KvLogHeader
+         * @brief The leading bytes of a structured record, followed by @ref field_count KvLogField entries.
+         * @details It starts with a DeferredLogHeader (format = the event id, render = render_kv_log_record), so a
+         *          writer without a structured sink renders it as text exactly like a deferred line.
+         */
+        struct KvLogHeader
+        {
+            DeferredLogHeader text;
+            std::uint32_t field_count;
+        };
+
+        /// Most fields one log_kv() record carries: as many as fit the async inline message buffer.
+        inline constexpr std::size_t KV_LOG_MAX_FIELDS =
+            (LOG_INLINE_MESSAGE_SIZE - sizeof(KvLogHeader)) / sizeof(KvLogField);
+
+        template <typename T> [[nodiscard]] constexpr KvType kv_type_of() noexcept
+        {
+            if constexpr (std::is_same_v<T, bool>)
+                return KvType::Bool;
+            else if constexpr (std::is_same_v<T, float>)
+                return KvType::Float32;
+            else if constexpr (std::is_floating_point_v<T>)
+                return KvType::Float64;
+            else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+                return KvType::Pointer;
+            else if constexpr (std::is_signed_v<T>)
+                return KvType::Int;
+            else
+                return KvType::UInt;
+        }
+
+        template <typename T> [[nodiscard]] KvLogField make_kv_log_field(const KvField<T> &field) noexcept
+        {
+            KvLogField packed{field.name, 0, kv_type_of<T>()};
+            if constexpr (std::is_same_v<T, float>)
+            {
+                std::uint32_t bits;
+                std::memcpy(&bits, &field.value, sizeof(bits));
+                packed.bits = bits;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                const auto value = static_cast<double>(field.value);
+                std::memcpy(&packed.bits, &value, sizeof(value));
+            }
+            else if constexpr (std::is_pointer_v<T>)
+            {
+                packed.bits = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(field.value));
+            }
+            else if constexpr (std::is_null_pointer_v<T>)
+            {
+                packed.bits = 0;
+            }
+            else if constexpr (std::is_same_v<T, bool> || std::is_unsigned_v<T>)
+            {
+                packed.bits = static_cast<std::uint64_t>(field.value);
+            }
+            else
+            {
+                packed.bits = static_cast<std::uint64_t>(static_cast<std::int64_t>(field.value));
+            }
+            return packed;
+        }
+
+        /**
+         * @brief Renders a structured record as text: "[file:line] event_id name=value name=value ...".
+         * @details Pointers print as 0x-prefixed hex, so the line reads like the formatted logger's address output.
+         * @throws std::bad_alloc when @p out cannot grow.
+         */
+        void render_kv_log_record(std::string &out, const std::byte *record);
+    } // namespace detail
+
     /**
      * @class Logger
      * @brief A thread-safe file logger: the value facade behind the free log() accessor and Session::log().
@@ -241,6 +568,29 @@ namespace DetourModKit
         /// Returns true when asynchronous logging is currently enabled. Callback-safe (a lock-free atomic read).
         [[nodiscard]] bool is_async_mode_enabled() const noexcept;
 
+        /**
+         * @brief Keeps logging synchronous until the sink gets slow or contended, then switches to async mode.
+         * @details While armed, each synchronous line measures how long it waited for the sink lock (only when the lock
+         *          was already held) and how long its write took. The first line that reaches config.lock_wait or
+         *          config.write_latency calls enable_async_mode(config.async) once it has released the lock, and a
+         *          line naming the measurement follows the usual "Async logging mode enabled" line. The async writer
+         *          writes under the same sink lock, so lines already past the async check land before any queued line
+         *          and each thread's lines keep their order across the switch. Promotion happens at most once; it is
+         *          put off while the calling thread holds the Windows loader lock. A no-op after shutdown or while
+         *          async mode is on; disable_async_mode() and shutdown() disarm it.
+         * @param config Promotion thresholds and the async configuration to promote to; an invalid config is
+         *               reported at Error level and leaves the logger unarmed.
+         * @note Setup/control-plane only: takes the async lifecycle mutex. The armed write path itself reads the
+         *       steady clock around the write and otherwise costs what a synchronous line costs.
+         */
+        void enable_adaptive_mode(const AdaptiveLoggingConfig &config);
+
+        /// Arms adaptive mode with the default AdaptiveLoggingConfig. See the config-taking overload.
+        void enable_adaptive_mode();
+
+        /// Returns true while adaptive mode is armed and has not yet promoted. Callback-safe (a lock-free atomic read).
+        [[nodiscard]] bool is_adaptive_mode_armed() const noexcept;
+
         /**
          * @brief Flushes pending log output.
          * @details In async mode, waits for the queue to drain; in sync mode, flushes the file stream.
@@ -249,6 +599,17 @@ namespace DetourModKit
          */
         void flush() noexcept;
 
+        /**
+         * @brief Writes what is still queued and flushes the file, for a process that is already exiting.
+         * @details For the process-termination path only (DLL_PROCESS_DETACH with a non-null lpReserved), where the
+         *          OS has already ended every other thread: the async writer is gone, so the calling thread writes the
+         *          queued records itself instead of waiting for it. A thread that died holding the sink lock left it
+         *          held for good, so the lock is only tried; when it is taken, the pending lines are lost rather than
+         *          the exit hung. Never joins, waits, or closes the file (the OS reclaims the handle).
+         * @note Not for a live process: another thread can be mid-write, and records are drained outside the writer.
+         */
+        void flush_at_process_exit() noexcept;
+
         /**
          * @brief Shuts the logger down: drains async output and closes the file without logging.
          * @details Safe to call during teardown; idempotent with the destructor. After shutdown() the destructor is a
@@ -267,12 +628,13 @@ namespace DetourModKit
          * @brief Tests whether a record at @p level would pass the current filter.
          * @param level The level to test.
          * @return true when a message at this level would be recorded.
-         * @details Gate expensive trace-only work behind this (e.g. building a string solely to log it).
+         * @details Gate expensive trace-only work behind this (e.g. building a string solely to log it). A level
+         *          below LOG_COMPILE_MIN_LEVEL is false at compile time, so the gated work is compiled out with it.
          * @note Callback-safe: a lock-free atomic read.
          */
         [[nodiscard]] bool is_enabled(LogLevel level) const noexcept
         {
-            return level >= m_current_log_level.load(std::memory_order_acquire);
+            return log_level_compiled_in(level) && level >= m_current_log_level.load(std::memory_order_acquire);
         }
 
         /**
@@ -282,6 +644,46 @@ namespace DetourModKit
          */
         void set_log_level(LogLevel level);
 
+        /// Returns @p category's current minimum level: its pinned level, else the global one. Callback-safe.
+        [[nodiscard]] LogLevel get_log_level(LogCategory category) const noexcept
+        {
+            return m_category_levels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Tests whether a record at @p level in @p category would pass the current filter.
+         * @details One relaxed load of the category's slot in the level table: set_log_level keeps every unpinned
+         *          slot equal to the global level, so no second load decides between the two.
+         * @pre @p category is below LogCategory::Count.
+         * @note Callback-safe: a lock-free atomic read.
+         */
+        [[nodiscard]] bool is_enabled(LogCategory category, LogLevel level) const noexcept
+        {
+            return log_level_compiled_in(level) &&
+                   level >= m_category_levels[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+        }
+
+        /// Compile-time-category form of is_enabled(LogCategory, LogLevel).
+        template <LogCategory Category>
+        [[nodiscard]] bool is_enabled(LogCategoryTag<Category> category, LogLevel level) const noexcept
+        {
+            (void)category;
+            return is_enabled(Category, level);
+        }
+
+        /**
+         * @brief Pins @p category to @p level; it no longer follows the global set_log_level.
+         * @details An out-of-range level or category is ignored with a warning, like set_log_level(LogLevel).
+         * @note Setup/control-plane only: emits a log line about the change.
+         */
+        void set_log_level(LogCategory category, LogLevel level);
+
+        /**
+         * @brief Unpins @p category so it follows the global level again, taking it at once.
+         * @note Setup/control-plane only.
+         */
+        void reset_log_level(LogCategory category);
+
         /**
          * @brief Logs an already-rendered message at @p level (no source-location stamp).
          * @param level The level of the message.
@@ -319,7 +721,9 @@ namespace DetourModKit
          * @brief Logs a source-location-stamped, std::format-style message at @p level.
          * @details Arguments are formatted only when @p level passes the filter (lazy evaluation). The leading
          *          LocatedFormat captures the call site, so the rendered line is prefixed with a compact [file:line]
-         *          stamp; the format string is validated against @p args at compile time.
+         *          stamp; the format string is validated against @p args at compile time. With
+         *          AsyncLoggerConfig::defer_formatting on and only scalar arguments (detail::DeferrableLogArg), the
+         *          caller enqueues the raw argument bytes instead and the writer thread does the formatting.
          * @tparam Args Deduced formatted argument types.
          * @param level The level of the message.
          * @param fmt The format string (auto-wrapped into a LocatedFormat capturing the call site).
@@ -330,10 +734,24 @@ namespace DetourModKit
         template <typename... Args>
         void log(LogLevel level, LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
         {
-            if (level >= m_current_log_level.load(std::memory_order_acquire))
+            if (is_enabled(level))
+            {
+                emit(level, fmt, std::forward<Args>(args)...);
+            }
+        }
+
+        /**
+         * @brief Logs a formatted message at @p level in a compile-time category.
+         * @details The same contract as log(level, fmt, args...), but filtered by @p category's level instead of the
+         *          global one, e.g. `log().log(log_category::scan, LogLevel::Debug, "tried {} rungs", n)`.
+         */
+        template <LogCategory Category, typename... Args>
+        void log(LogCategoryTag<Category> category, LogLevel level, LocatedFormat<std::type_identity_t<Args>...> fmt,
+                 Args &&...args)
+        {
+            if (is_enabled(category, level))
             {
-                (void)format_located([this, level](std::string_view rendered) { return this->log(level, rendered); },
-                                     fmt.where, fmt.fmt, std::forward<Args>(args)...);
+                emit(level, fmt, std::forward<Args>(args)...);
             }
         }
 
@@ -341,22 +759,37 @@ namespace DetourModKit
          * @name Level-named convenience loggers
          * @brief Shorthand for log(LogLevel::X, fmt, args...); each auto-stamps the call site. See log() for the
          *        delivery and lazy-evaluation contract.
+         *          trace / debug / info below LOG_COMPILE_MIN_LEVEL compile to an empty body. The call's argument
+         *          expressions are still evaluated at the call site, as for any function call, so gate a costly
+         *          argument behind is_enabled(), which folds to false below the floor.
          * @note Best-effort: same callback-safety as log() (callback-safe only in async mode).
          * @{
          */
-        template <typename... Args> void trace(LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
+        template <typename... Args>
+        void trace([[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
         {
-            log(LogLevel::Trace, fmt, std::forward<Args>(args)...);
+            if constexpr (log_level_compiled_in(LogLevel::Trace))
+            {
+                log(LogLevel::Trace, fmt, std::forward<Args>(args)...);
+            }
         }
 
-        template <typename... Args> void debug(LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
+        template <typename... Args>
+        void debug([[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
         {
-            log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
+            if constexpr (log_level_compiled_in(LogLevel::Debug))
+            {
+                log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
+            }
         }
 
-        template <typename... Args> void info(LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
+        template <typename... Args>
+        void info([[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
         {
-            log(LogLevel::Info, fmt, std::forward<Args>(args)...);
+            if constexpr (log_level_compiled_in(LogLevel::Info))
+            {
+                log(LogLevel::Info, fmt, std::forward<Args>(args)...);
+            }
         }
 
         template <typename... Args> void warning(LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
@@ -368,6 +801,49 @@ namespace DetourModKit
         {
             log(LogLevel::Error, fmt, std::forward<Args>(args)...);
         }
+
+        template <LogCategory Category, typename... Args>
+        void trace([[maybe_unused]] LogCategoryTag<Category> category,
+                   [[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
+        {
+            if constexpr (log_level_compiled_in(LogLevel::Trace))
+            {
+                log(category, LogLevel::Trace, fmt, std::forward<Args>(args)...);
+            }
+        }
+
+        template <LogCategory Category, typename... Args>
+        void debug([[maybe_unused]] LogCategoryTag<Category> category,
+                   [[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
+        {
+            if constexpr (log_level_compiled_in(LogLevel::Debug))
+            {
+                log(category, LogLevel::Debug, fmt, std::forward<Args>(args)...);
+            }
+        }
+
+        template <LogCategory Category, typename... Args>
+        void info([[maybe_unused]] LogCategoryTag<Category> category,
+                  [[maybe_unused]] LocatedFormat<std::type_identity_t<Args>...> fmt, [[maybe_unused]] Args &&...args)
+        {
+            if constexpr (log_level_compiled_in(LogLevel::Info))
+            {
+                log(category, LogLevel::Info, fmt, std::forward<Args>(args)...);
+            }
+        }
+
+        template <LogCategory Category, typename... Args>
+        void warning(LogCategoryTag<Category> category, LocatedFormat<std::type_identity_t<Args>...> fmt,
+                     Args &&...args)
+        {
+            log(category, LogLevel::Warning, fmt, std::forward<Args>(args)...);
+        }
+
+        template <LogCategory Category, typename... Args>
+        void error(LogCategoryTag<Category> category, LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
+        {
+            log(category, LogLevel::Error, fmt, std::forward<Args>(args)...);
+        }
         /** @} */
 
         /**
@@ -386,20 +862,54 @@ namespace DetourModKit
         [[nodiscard]] bool try_log(LogLevel level, LocatedFormat<std::type_identity_t<Args>...> fmt,
                                    Args &&...args) noexcept
         {
-            if (level < m_current_log_level.load(std::memory_order_acquire))
+            return is_enabled(level) && try_emit(level, fmt, std::forward<Args>(args)...);
+        }
+
+        /// Compile-time-category form of try_log(level, fmt, args...), filtered by @p category's level.
+        template <LogCategory Category, typename... Args>
+        [[nodiscard]] bool try_log(LogCategoryTag<Category> category, LogLevel level,
+                                   LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args) noexcept
+        {
+            return is_enabled(category, level) && try_emit(level, fmt, std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Logs a structured record: an event id plus named scalar fields, "hook.installed" with target=0x7FF6...
+         * @details With async mode on and AsyncLoggerConfig::structured_log_path set, the record is queued as raw
+         *          field bits and the writer appends it to that binary file, with the event's schema (id, call site,
+         *          field names and types) written once and every later record referring to it by number. Decode the
+         *          file with log_kv::read_file or the DetourModKit_log_kv_decode tool. Without a structured file, or in
+         *          synchronous mode, the record is rendered as a text line instead (see detail::render_kv_log_record).
+         * @param level The level of the record; filtered and rate limited like log().
+         * @param event A string literal naming the event; captures the call site.
+         * @param fields kv("name", value) pairs, at most detail::KV_LOG_MAX_FIELDS; names must be string literals.
+         * @return true if the record reached the queue or the sink.
+         * @note Callback-safe in async mode: packing the record allocates nothing.
+         */
+        template <typename... Fields>
+        bool log_kv(LogLevel level, KvEvent event, const KvField<Fields> &...fields) noexcept
+        {
+            static_assert(sizeof...(Fields) <= detail::KV_LOG_MAX_FIELDS,
+                          "log_kv carries at most KV_LOG_MAX_FIELDS fields");
+            if (!is_enabled(level))
             {
                 return false;
             }
-            try
+            if (m_rate_limit_sites.load(std::memory_order_acquire) && !admit_call_site(event.where))
             {
-                return format_located([this, level](std::string_view rendered) noexcept
-                                      { return this->log_noexcept(level, rendered); }, fmt.where, fmt.fmt,
-                                      std::forward<Args>(args)...);
+                return false;
             }
-            catch (...)
+            std::array<std::byte, sizeof(detail::KvLogHeader) + sizeof...(Fields) * sizeof(detail::KvLogField)> record;
+            const detail::KvLogHeader header{{&detail::render_kv_log_record, event.id.data(), event.id.size(),
+                                              event.where.file_name(), event.where.line()},
+                                             static_cast<std::uint32_t>(sizeof...(Fields))};
+            std::memcpy(record.data(), &header, sizeof(header));
+            if constexpr (sizeof...(Fields) > 0)
             {
-                return false;
+                const std::array<detail::KvLogField, sizeof...(Fields)> packed{detail::make_kv_log_field(fields)...};
+                std::memcpy(record.data() + sizeof(header), packed.data(), sizeof(packed));
             }
+            return submit_structured(level, record);
         }
 
         /**
@@ -425,15 +935,92 @@ namespace DetourModKit
         /// Constructs the process-default logger from the published StaticConfig; reached only through log().
         Logger();
 
+        /**
+         * @brief The formatted path after the level filter: the call-site rate limit, then a deferred record or a
+         *        rendered line written through write().
+         */
+        template <typename... Args>
+        void emit(LogLevel level, LocatedFormat<std::type_identity_t<Args>...> fmt, Args &&...args)
+        {
+            if (m_rate_limit_sites.load(std::memory_order_acquire) && !admit_call_site(fmt.where))
+            {
+                return;
+            }
+            if constexpr (detail::deferrable_log_args<Args...>)
+            {
+                if (m_defer_formatting.load(std::memory_order_acquire))
+                {
+                    (void)log_deferred(level, fmt.fmt.get(), fmt.where, args...);
+                    return;
+                }
+            }
+            (void)format_located([this, level](std::string_view rendered) { return this->write(level, rendered); },
+                                 fmt.where, fmt.fmt, std::forward<Args>(args)...);
+        }
+
+        /// No-throw counterpart of emit() behind try_log(); returns the delivery status.
+        template <typename... Args>
+        [[nodiscard]] bool try_emit(LogLevel level, LocatedFormat<std::type_identity_t<Args>...> fmt,
+                                    Args &&...args) noexcept
+        {
+            if (m_rate_limit_sites.load(std::memory_order_acquire) && !admit_call_site(fmt.where))
+            {
+                return false;
+            }
+            if constexpr (detail::deferrable_log_args<Args...>)
+            {
+                if (m_defer_formatting.load(std::memory_order_acquire))
+                {
+                    return log_deferred(level, fmt.fmt.get(), fmt.where, args...);
+                }
+            }
+            try
+            {
+                return format_located([this, level](std::string_view rendered) noexcept
+                                      { return this->write_noexcept(level, rendered); }, fmt.where, fmt.fmt,
+                                      std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        /**
+         * @brief Writes an already-filtered line to the async queue or the file sink; the body behind log(level,
+         *        message).
+         * @return The same delivery status as log(level, message).
+         */
+        bool write(LogLevel level, std::string_view message);
+
+        /// No-throw counterpart of write(): swallows any sink exception and reports the line as dropped.
+        [[nodiscard]] bool write_noexcept(LogLevel level, std::string_view message) noexcept;
+
+        /**
+         * @brief Writes one line to the file sink (or stderr); the caller holds *m_log_mutex_ptr.
+         * @details The timestamp is rendered on the stack and the whole line is assembled in m_sink_line, then handed
+         *          to the stream in one write, so a steady stream of lines allocates nothing once the buffer has grown.
+         */
+        bool write_to_sink(LogLevel level, std::string_view message);
+
+        /// The synchronous write while adaptive mode is armed: times the lock wait and the write, then maybe promotes.
+        bool write_adaptive(LogLevel level, std::string_view message);
+
+        /// Switches an armed logger to async mode; @p what and @p elapsed_ns name the measurement that crossed.
+        void promote_adaptive(std::string_view what, std::int64_t elapsed_ns) noexcept;
+
+        /// Seeds every category slot from the global level; constructors only.
+        void reset_category_levels() noexcept;
+
         /**
          * @brief Renders a source-located line into a stack buffer and hands it to @p sink.
          * @details Writes the compact "[file:line] " stamp followed by the formatted message into one buffer the size
          *          of the async inline message buffer (LOG_INLINE_MESSAGE_SIZE). std::format_to_n reports the
          *          untruncated length, so a line that fits is passed as a view with no heap allocation; the async
          *          LogMessage then copies it into its own inline buffer. A line longer than the buffer (or a pathologic
-         *          stamp that fills it) is re-rendered once through std::format, the documented overflow path. The
-         *          formatter only reads its arguments, so forwarding the same pack to both the fast and overflow paths
-         *          is safe.
+         *          stamp that fills it) is re-rendered once into a growing std::string, the documented overflow path.
+         *          The formatter only reads its arguments, so forwarding the same pack to both the fast and overflow
+         *          paths is safe.
          * @return Whatever @p sink returns for the line.
          */
         template <typename Sink, typename... Args>
@@ -457,10 +1044,74 @@ namespace DetourModKit
                 }
             }
 
-            return sink(
-                std::string_view(std::format("[{}:{}] {}", file, line, std::format(fmt, std::forward<Args>(args)...))));
+            std::string overflow = std::format("[{}:{}] ", file, line);
+            std::format_to(std::back_inserter(overflow), fmt, std::forward<Args>(args)...);
+            return sink(std::string_view(overflow));
         }
 
+        /**
+         * @brief Packs a scalar-only line into a deferred record and hands it to the async writer unformatted.
+         * @details Used instead of format_located() when AsyncLoggerConfig::defer_formatting is on and every argument
+         *          satisfies detail::DeferredFormatArg. The record is the detail::DeferredLogHeader followed by each
+         *          argument's bytes; render_deferred() for the same type list reads them back on the writer thread.
+         * @return submit_deferred()'s delivery status.
+         */
+        template <typename... Args>
+        bool log_deferred(LogLevel level, std::string_view format, const std::source_location &where,
+                          const Args &...args) noexcept
+        {
+            std::array<std::byte, detail::deferred_log_record_size<std::remove_cvref_t<Args>...>> record;
+            const detail::DeferredLogHeader header{&render_deferred<std::remove_cvref_t<Args>...>, format.data(),
+                                                   format.size(), where.file_name(), where.line()};
+            std::memcpy(record.data(), &header, sizeof(header));
+            std::size_t offset = sizeof(header);
+            ((std::memcpy(record.data() + offset, &args, sizeof(args)), offset += sizeof(args)), ...);
+            return submit_deferred(level, record);
+        }
+
+        /**
+         * @brief Renders a record packed by log_deferred() for the same argument types: the "[file:line] " stamp and
+         *        then the message, exactly as format_located() would have.
+         * @throws std::bad_alloc when @p out cannot grow.
+         */
+        template <typename... Args> static void render_deferred(std::string &out, const std::byte *record)
+        {
+            detail::DeferredLogHeader header;
+            std::memcpy(&header, record, sizeof(header));
+            std::tuple<Args...> values;
+            const std::byte *cursor = record + sizeof(header);
+            std::apply([&cursor](Args &...value)
+                       { ((std::memcpy(&value, cursor, sizeof(value)), cursor += sizeof(value)), ...); }, values);
+            std::format_to(std::back_inserter(out), "[{}:{}] ", source_basename(header.file), header.line);
+            std::apply(
+                [&out, &header](Args &...value)
+                {
+                    std::vformat_to(std::back_inserter(out), std::string_view(header.format, header.format_size),
+                                    std::make_format_args(value...));
+                },
+                values);
+        }
+
+        /**
+         * @brief Enqueues a deferred record on the async writer, or renders and logs it here when async mode has gone.
+         * @return true if the record reached the queue or the sink; a render or sink failure on the fallback drops it.
+         */
+        bool submit_deferred(LogLevel level, std::span<const std::byte> record) noexcept;
+
+        /**
+         * @brief Enqueues a structured record built by log_kv() on the async writer, or renders it as a text line and
+         *        logs it here in synchronous mode.
+         * @return true if the record reached the queue or the sink.
+         */
+        bool submit_structured(LogLevel level, std::span<const std::byte> record) noexcept;
+
+        /**
+         * @brief Asks the async writer's per-call-site rate limiter whether the line logged at @p where may proceed.
+         * @return false when the call site is over AsyncLoggerConfig::rate_limit_per_second (the line is counted as
+         *         dropped); true otherwise, including once async mode has gone.
+         */
+        [[nodiscard]] bool admit_call_site(const std::source_location &where) noexcept;
+
         /**
          * @brief Extracts the file name from a source_location path (the segment after the last '/' or '\\').
          * @details Keeps the stamp compact and toolchain-stable: __FILE__-derived paths differ between build roots and
@@ -475,9 +1126,15 @@ namespace DetourModKit
         /// Shared teardown body used by both ~Logger() and shutdown().
         void shutdown_internal() noexcept;
 
+        /// Capacity render_timestamp() needs: the strftime output plus the ".mmm" fraction.
+        static constexpr std::size_t TIMESTAMP_BUFFER_SIZE = 134;
+
         /// Generates the current timestamp formatted per m_timestamp_format, with a millisecond fraction appended.
         std::string get_timestamp() const;
 
+        /// get_timestamp() into @p buffer; returns a view of @p buffer, or of a static error marker on failure.
+        std::string_view render_timestamp(std::array<char, TIMESTAMP_BUFFER_SIZE> &buffer) const;
+
         /// Resolves the absolute log file path (wide for Unicode fidelity), relative to the runtime directory.
         std::wstring generate_log_file_path() const;
 
@@ -501,7 +1158,17 @@ namespace DetourModKit
 
         std::shared_ptr<detail::WinFileStream> m_log_file_stream_ptr;
         std::shared_ptr<std::mutex> m_log_mutex_ptr;
+        // Line assembly buffer for write_to_sink(), guarded by *m_log_mutex_ptr. It keeps its capacity between lines,
+        // rather than living in a thread_local whose MinGW first touch allocates, so a hook thread's line costs no
+        // allocation; a line past SINK_LINE_RETAIN bytes releases it again.
+        std::string m_sink_line;
         std::atomic<LogLevel> m_current_log_level{LogLevel::Info};
+        // One effective level per LogCategory. set_log_level(LogLevel) rewrites every slot whose bit is clear in
+        // m_pinned_categories, so the categorized enabled check never consults the global level. Both setters hold
+        // m_level_mutex so a global change cannot overwrite a slot a concurrent pin just wrote.
+        std::array<std::atomic<LogLevel>, LOG_CATEGORY_COUNT> m_category_levels{};
+        std::uint32_t m_pinned_categories = 0;
+        std::mutex m_level_mutex;
         std::atomic<bool> m_shutdown_called{false};
 
         // m_async_logger is held in an atomic so the log() hot path snapshots the writer without taking m_async_mutex
@@ -512,6 +1179,17 @@ namespace DetourModKit
         // mode already takes; it stays correct and callback-safe, just not a wait-free read.
         std::atomic<std::shared_ptr<AsyncLogger>> m_async_logger{};
         std::atomic<bool> m_async_mode_enabled{false};
+        // Latched from AsyncLoggerConfig::defer_formatting while async mode is on; read once per formatted line.
+        std::atomic<bool> m_defer_formatting{false};
+        // Latched from AsyncLoggerConfig::rate_limit_per_second != 0 like m_defer_formatting; while set, the formatted
+        // templates ask admit_call_site() before doing any work.
+        std::atomic<bool> m_rate_limit_sites{false};
+        // Adaptive mode: the armed flag gates the timed write path, and the first thread to clear it promotes. The
+        // thresholds are read relaxed on every armed line; m_adaptive_async_config is guarded by m_async_mutex.
+        std::atomic<bool> m_adaptive_armed{false};
+        std::atomic<std::int64_t> m_promotion_lock_wait_ns{0};
+        std::atomic<std::int64_t> m_promotion_write_ns{0};
+        AsyncLoggerConfig m_adaptive_async_config{};
         std::mutex m_async_mutex;
     };
 
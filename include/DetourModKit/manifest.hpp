@@ -39,15 +39,22 @@
 #include "DetourModKit/region.hpp"
 #include "DetourModKit/scan.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <memory>
+#include <optional>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace DetourModKit
 {
+    // LazyGate owns its prefetch worker by pointer, so the worker header is needed only by manifest.cpp.
+    class StoppableWorker;
+
     // Forward-declare the one hook:: type a Binding names (the mid-hook general-purpose register). A MidHookRegister
     // binding is inert data until a consumer feeds it to hook::gpr(ctx, reg) inside its own mid-hook callback, and that
     // consumer already includes hook.hpp. Pulling the whole hooking surface into every manifest translation unit merely
@@ -251,6 +258,28 @@ namespace DetourModKit
              *          Appended to preserve positional aggregate initialization of the established record fields.
              */
             std::string export_name;
+            /**
+             * @brief RipGlobal: the site's last known offset from its module's base; 0 (the default) means none.
+             * @details Serialized as the optional hex `last_seen_rva` key for RipGlobal records only and forwarded as
+             *          @ref anchor::Anchor::last_seen_rva, so the ladder first tries the small window around it. It is
+             *          a locality hint, not part of the definition, so it stays out of the fingerprint: refreshing it
+             *          from a @ref GatedSignature::address after a patch never reads as drift. Appended to preserve
+             *          positional aggregate initialization of the established record fields.
+             */
+            std::uint64_t last_seen_rva = 0;
+            /**
+             * @brief Label of the signature, in the same manifest, this one is found inside; empty (the default) for
+             *        none.
+             * @details @ref resolve_and_gate resolves a child after its parent, within @ref parent_window bytes of the
+             *          parent's resolved address and ignoring @ref module; a child whose parent is missing, did not
+             *          resolve, or is on a cycle fails closed. The manifest form of @ref anchor::Anchor::parent, which
+             *          @ref overlay maps onto this label. Serialized as the optional `parent` and `parent_window` keys;
+             *          not part of the fingerprint. Appended to preserve positional aggregate initialization of the
+             *          established record fields.
+             */
+            std::string parent;
+            /// Bytes a child scans from its parent's address; 0 (the default) selects anchor::DEFAULT_PARENT_WINDOW.
+            std::uint64_t parent_window = 0;
         };
 
         /**
@@ -270,6 +299,10 @@ namespace DetourModKit
             Drifted
         };
 
+        struct CompiledManifest;
+        struct GatePolicy;
+        struct GateResult;
+
         /**
          * @class Signature
          * @brief A compiled, resolvable signature: owns its candidate storage and presents an @ref anchor::Anchor view.
@@ -309,6 +342,14 @@ namespace DetourModKit
              */
             [[nodiscard]] static Result<Signature> adopt(const anchor::Anchor &source);
 
+            /**
+             * @brief Adopts @p source as a child of the signature labelled @p parent_label.
+             * @details An anchor names its parent by table index, which means nothing outside its table, so the caller
+             *          that holds the table (as @ref overlay does) supplies the parent's label for
+             *          @ref SignatureRecord::parent.
+             */
+            [[nodiscard]] static Result<Signature> adopt(const anchor::Anchor &source, std::string_view parent_label);
+
             /**
              * @brief Resolves this signature to a value through its anchor backend, fail-closed.
              * @param fallback_scope The module image to resolve within when the record names no module; defaults to the
@@ -318,6 +359,12 @@ namespace DetourModKit
              */
             [[nodiscard]] anchor::ResolvedAnchor resolve(Region fallback_scope = Region::host()) const;
 
+            /**
+             * @brief Resolves this signature inside @p window, whatever module the record names.
+             * @details How @ref resolve_and_gate resolves a child within its resolved parent's window.
+             */
+            [[nodiscard]] anchor::ResolvedAnchor resolve_within(Region window) const;
+
             /**
              * @brief The effective scope this signature resolves within.
              * @return @ref Region::module_named for the record's module, or @ref Region::host when it names none.
@@ -326,13 +373,15 @@ namespace DetourModKit
             [[nodiscard]] Region scope() const noexcept;
 
             /**
-             * @brief The live fingerprint of this signature, recomputed from its current declarative inputs.
+             * @brief The live fingerprint of this signature, computed once from its declarative inputs.
              * @return A content hash over the signature's declared definition: the @ref anchor::anchor_fingerprint of
              *         the locate evidence (compiled ladder, mangled name, xref literal) combined with the @ref Binding
              *         contract (register / offset chain / value width / vtable slot).
              * @details Content-derived and address-independent: it reads no game memory, so it is stable across runs
              *          and rebuilds on one platform and changes exactly when the signature's declared definition
              *          changes -- a re-authored pattern, a renamed type, a different literal, or an edited binding.
+             *          Those inputs are fixed once the signature exists, so the hash is taken at construction and this
+             *          (and @ref fingerprint_state) is a member read.
              */
             [[nodiscard]] std::uint64_t current_fingerprint() const noexcept;
 
@@ -374,6 +423,21 @@ namespace DetourModKit
 
             SignatureRecord m_record;
             std::vector<scan::Candidate> m_ladder;
+            // current_fingerprint() of m_record + m_ladder; neither changes after construction (recapture only moves
+            // the record's baseline), so it is hashed once rather than on every gate.
+            std::uint64_t m_fingerprint = 0;
+
+            // The binary loader rebuilds each ladder from its stored, precompiled patterns and hands it straight to
+            // the private constructor, skipping compile()'s pattern parse.
+            friend Result<CompiledManifest> parse_binary(std::span<const std::byte> blob);
+            // The gate pre-sweeps every RipGlobal ladder of the manifest in one pass, which needs each signature's
+            // anchor view up front rather than one opaque resolve() at a time.
+            friend GateResult resolve_and_gate(std::span<const Signature> signatures, const GatePolicy &policy,
+                                               Region scope, std::stop_token stop);
+            // The incremental gate resolves through the same batch, for only the signatures an edit touched.
+            friend class IncrementalGate;
+            // The lazy gate resolves each signature from its anchor view, alone or in the same batch.
+            friend class LazyGate;
         };
 
         /// The manifest INI format version this build reads and writes. Bumped only on an incompatible format change.
@@ -428,8 +492,8 @@ namespace DetourModKit
          * @brief Parses a manifest's INI text.
          * @param text The manifest text (a `[manifest]` header plus one `[sig.<label>]` section per contract).
          * @return The parsed @ref Manifest (header plus records in file order), or an Error: MissingHeader (no
-         *         `[manifest]` section or an unsupported schema), or MalformedLine (a section or header field that does
-         *         not parse, or an unknown kind).
+         *         `[manifest]` section or an unsupported schema), MalformedLine (a section or header field that does
+         *         not parse, or an unknown kind), or OutOfMemory (the text could not be indexed).
          * @details Fails closed, mirroring @ref rtti::parse_drift_report: a manifest that cannot be trusted to describe
          *          the signatures faithfully is rejected whole rather than partially applied. Blank values and missing
          *          optional keys fall back to the defaults; an absent `revision` is 0 (unversioned).
@@ -466,6 +530,66 @@ namespace DetourModKit
          */
         [[nodiscard]] Result<void> save(const std::filesystem::path &path, const Manifest &manifest);
 
+        /// The binary manifest format version this build reads and writes; @ref parse_binary rejects any other.
+        inline constexpr std::uint32_t BINARY_FORMAT_VERSION = 2;
+
+        /**
+         * @struct CompiledManifest
+         * @brief A manifest read back from its binary form: the header plus every signature, already compiled.
+         */
+        struct CompiledManifest
+        {
+            /// The header the manifest was compiled with (schema and contract revision).
+            ManifestHeader header{};
+            /// The compiled signatures, in the source manifest's record order.
+            std::vector<Signature> signatures{};
+        };
+
+        /**
+         * @brief Compiles a manifest into the flat binary form that @ref parse_binary loads without parsing.
+         * @details The INI stays the editable source; the blob is what ships. Every record is compiled first, so a
+         *          record that would fail @ref Signature::compile fails the build here rather than at a player's load.
+         *          The blob is one relocatable block: a fixed header, then fixed-size signature, rung, pattern and
+         *          offset tables and a string pool laid back to back, each sized by its header count. Every reference
+         *          is a table index or a pool range, never a pointer, so the blob loads from any address. Each
+         *          byte-tier rung carries its pattern already compiled (bytes, mask, result offset, jumps) next to its
+         *          source text, and a checksum over everything after the header catches a torn or corrupted file.
+         * @param manifest The header and records to compile.
+         * @return The blob, or the first failing record's compile error with Error::detail set to its index, or
+         *         InvalidArg when the manifest is too large for the format's 32-bit counts and offsets.
+         * @note Setup/control-plane only: a build step, run when the INI changes rather than at every launch.
+         */
+        [[nodiscard]] Result<std::vector<std::byte>> compile_to_binary(const Manifest &manifest);
+
+        /**
+         * @brief Loads a blob produced by @ref compile_to_binary: no INI indexing, no text-to-number parsing, and no
+         *        pattern compile.
+         * @details Each signature is built straight from its fixed-size table entry, and each byte-tier rung from its
+         *          stored pattern, which is bounds-checked field by field before use (its anchor is re-selected, an
+         *          O(pattern) pass). The result is the same Signature set @ref Signature::compile builds from the
+         *          source records -- same ladders, same fingerprints -- and owns its storage, so @p blob may be
+         *          unmapped as soon as this returns.
+         * @param blob The blob bytes; no alignment is assumed.
+         * @return The manifest, or an Error: MissingHeader (wrong magic, a format version or schema this build cannot
+         *         read, or a size that disagrees with the header), MalformedLine (a checksum mismatch, a table or
+         *         string that lies outside the blob, or a field out of range), or OutOfMemory.
+         */
+        [[nodiscard]] Result<CompiledManifest> parse_binary(std::span<const std::byte> blob);
+
+        /**
+         * @brief Writes @ref compile_to_binary of @p manifest to @p path, truncating it.
+         * @return Empty on success, the compile error, FileOpenFailed, or FileWriteFailed. Like @ref save, the write
+         *         is not atomic; a torn file fails the checksum on the next @ref load_binary.
+         */
+        [[nodiscard]] Result<void> save_binary(const std::filesystem::path &path, const Manifest &manifest);
+
+        /**
+         * @brief Maps a binary manifest file read-only and loads it through @ref parse_binary.
+         * @return The manifest, FileOpenFailed (missing, locked, or not a regular file), or a @ref parse_binary error.
+         *         The mapping is released before this returns.
+         */
+        [[nodiscard]] Result<CompiledManifest> load_binary(const std::filesystem::path &path);
+
         /**
          * @brief Merges a mod's in-code anchor defaults with optional file overrides, keyed by label.
          * @param defaults The in-code baseline: the anchors the mod always has. Their views are copied, so the caller's
@@ -517,6 +641,18 @@ namespace DetourModKit
              *        it, every signature is rejected. The default 0 imposes no floor (each signature stands alone).
              */
             double min_resolved_fraction = 0.0;
+            /**
+             * @brief Upper bound on threads resolving the manifest. The default 1 resolves serially; 0 selects one per
+             *        hardware thread. Signatures run concurrently only where no @ref SignatureRecord::parent chain
+             *        orders them, so validators must tolerate running side by side once this is raised.
+             */
+            std::size_t max_workers = 1;
+            /**
+             * @brief When true, cancel the rest of the batch as soon as enough signatures are rejected that
+             *        @ref min_resolved_fraction can no longer be met: the floor would reject every signature anyway,
+             *        so the remaining resolves are wasted. Without a floor it has no effect.
+             */
+            bool fail_fast = false;
 
             /**
              * @brief The strictest gate: reject drift, reject an unset baseline, and require every signature to
@@ -557,6 +693,8 @@ namespace DetourModKit
             Address address;
             /// The consumer-facing binding (a pointer into the source Signature).
             const Binding *binding = nullptr;
+            /// The resolve stage that answered (see @ref anchor::ResolvedAnchor::source).
+            scan::HitSource source = scan::HitSource::Ladder;
         };
 
         /**
@@ -604,6 +742,8 @@ namespace DetourModKit
          *                   caller; the result borrows their labels and bindings.
          * @param policy The trust thresholds.
          * @param scope The default module image for signatures that name no module; defaults to the host executable.
+         * @param stop Cancels the rest of the batch when it fires; every signature it skips or cuts short is rejected
+         *             as Failed.
          * @return The partition plus the manifest health summary.
          * @details The fail-safe the manifest depends on. A signature is rejected when its @ref Signature::resolve
          *          does not return a unique @ref anchor::AnchorStatus::Resolved, when its fingerprint drifted under
@@ -612,10 +752,175 @@ namespace DetourModKit
          *          @ref GatePolicy::min_resolved_fraction. A rejected feature does not install its hook or read its
          *          pointer; it stays off. This is the trust boundary that turns a silent wrong-address read into an
          *          observable safe-disable.
+         *
+         *          The manifest resolves as one batch: each image's page map is captured once, every string literal
+         *          and every root RipGlobal byte rung is located in one multi-pattern sweep per image, and the
+         *          per-signature resolves and fingerprint checks then run on up to @ref GatePolicy::max_workers
+         *          threads. Each outcome is the one the signature's own @ref Signature::resolve would report.
          * @note Setup/control-plane only: resolving a manifest walks each signature's scope.
          */
         [[nodiscard]] GateResult resolve_and_gate(std::span<const Signature> signatures, const GatePolicy &policy = {},
-                                                  Region scope = Region::host());
+                                                  Region scope = Region::host(), std::stop_token stop = {});
+
+        /**
+         * @class IncrementalGate
+         * @brief A gated manifest that, on each reload, re-resolves only the records an edit touched.
+         * @details Owns the compiled signatures, a content hash of each record, and each one's last
+         *          @ref anchor::ResolvedAnchor. @ref apply matches every incoming record to an unchanged predecessor
+         *          (same label, same hash over every field, the in-memory validator included) and keeps its
+         *          compiled signature and its resolve. A record is resolved again when it is new or edited, when its
+         *          parent is, or when its `parent` label now names a different record. The outcome is then re-gated
+         *          as a whole, so the trusted set, the health floor, and @ref GateResult::quality always describe
+         *          the full manifest, exactly as @ref resolve_and_gate of the same signatures would once the kept
+         *          resolves are still true of the image.
+         *
+         *          A kept resolve is not re-verified against memory: after the game module itself reloads or is
+         *          patched in place, call @ref invalidate so the next @ref apply resolves everything again.
+         * @note Setup/control-plane only, like @ref resolve_and_gate. Not thread-safe; one owner drives it.
+         */
+        class IncrementalGate
+        {
+        public:
+            /**
+             * @brief An empty gate; the first @ref apply resolves its whole manifest.
+             * @param policy The trust thresholds every @ref apply gates with.
+             * @param scope The default module image, as for @ref resolve_and_gate.
+             */
+            explicit IncrementalGate(const GatePolicy &policy = {}, Region scope = Region::host()) noexcept;
+
+            /**
+             * @brief Brings the gate up to @p manifest.
+             * @return How many records were resolved this time, or the first failing record's compile error with
+             *         Error::detail set to its index, in which case the previous outcome is kept unchanged.
+             *         OutOfMemory leaves the gate empty.
+             */
+            [[nodiscard]] Result<std::size_t> apply(const Manifest &manifest);
+
+            /// Forgets every kept resolve; the next @ref apply re-resolves each record, reusing its compiled form.
+            void invalidate() noexcept;
+
+            /**
+             * @brief The outcome of the latest successful @ref apply (empty before the first).
+             * @details It borrows from @ref signatures, so it is valid until the next @ref apply.
+             */
+            [[nodiscard]] const GateResult &result() const noexcept;
+
+            /// The compiled signatures, in the latest manifest's record order.
+            [[nodiscard]] std::span<const Signature> signatures() const noexcept;
+
+            /// Each signature's latest resolve, aligned with @ref signatures.
+            [[nodiscard]] std::span<const anchor::ResolvedAnchor> report() const noexcept;
+
+        private:
+            GatePolicy m_policy;
+            Region m_scope;
+            std::vector<Signature> m_signatures;
+            // Content hash of each signature's record, aligned with m_signatures.
+            std::vector<std::uint64_t> m_hashes;
+            std::vector<anchor::ResolvedAnchor> m_report;
+            GateResult m_result;
+            // Set by invalidate(): no kept resolve may be reused.
+            bool m_stale = false;
+        };
+
+        /**
+         * @class LazyGate
+         * @brief A gated manifest whose signatures resolve on first access instead of all at startup.
+         * @details Owns the compiled signatures and, for each, a once-flag and the slot its outcome lands in. The
+         *          first @ref get or @ref find of a signature resolves it (its parent chain first) and gates it against
+         *          the policy's fingerprint rules; later calls, from any thread, read the stored verdict.
+         *          @ref resolve_now settles a mandatory set up front in one @ref resolve_and_gate style batch on the
+         *          fork-join pool, and @ref prefetch then settles the rest in declaration order on a background
+         *          worker, so an optional feature that is enabled later usually finds its signature already resolved.
+         *
+         *          Each signature is judged alone: @ref GatePolicy::min_resolved_fraction is a whole-manifest floor
+         *          and is not applied. Gate the full set with @ref resolve_and_gate when the floor matters.
+         * @note Non-copyable and non-movable: the slots are shared with the prefetch worker. Destroy it outside the
+         *       loader lock so the destructor can join that worker.
+         */
+        class LazyGate
+        {
+        public:
+            /**
+             * @brief Adopts @p signatures without resolving any of them.
+             * @param signatures The compiled manifest; its order is the order @ref prefetch settles it in.
+             * @param policy The per-signature trust rules each first access gates with.
+             * @param scope The default module image, as for @ref resolve_and_gate.
+             * @throws std::bad_alloc if the slots cannot be allocated.
+             */
+            explicit LazyGate(std::vector<Signature> signatures, const GatePolicy &policy = {},
+                              Region scope = Region::host());
+            ~LazyGate() noexcept;
+
+            LazyGate(const LazyGate &) = delete;
+            LazyGate &operator=(const LazyGate &) = delete;
+            LazyGate(LazyGate &&) = delete;
+            LazyGate &operator=(LazyGate &&) = delete;
+
+            /**
+             * @brief The trusted entry of signature @p index, resolving and gating it on first access.
+             * @return A pointer that stays valid for the gate's lifetime, or nullptr when the signature did not
+             *         resolve, failed the fingerprint rules, or @p index is out of range.
+             * @details Blocks while another thread settles the same signature. A resolve that throws settles it
+             *          as Failed.
+             */
+            [[nodiscard]] const GatedSignature *get(std::size_t index) noexcept;
+
+            /// @ref get by label; nullptr as well when no signature carries @p label.
+            [[nodiscard]] const GatedSignature *find(std::string_view label) noexcept;
+
+            /**
+             * @brief Settles the signatures named by @p labels, and their parents, in one batch.
+             * @details Resolves every one not yet settled as @ref resolve_and_gate would, on up to
+             *          @ref GatePolicy::max_workers threads with the shared page snapshots and prescans. Call it at
+             *          startup with the signatures the mod cannot run without.
+             * @return Nothing, or InvalidArg with Error::detail set to the position of a label no signature carries
+             *         (nothing is resolved then), or OutOfMemory (the named signatures stay lazy).
+             * @note Setup/control-plane only: blocks until the batch finishes.
+             */
+            [[nodiscard]] Result<void> resolve_now(std::span<const std::string_view> labels);
+
+            /**
+             * @brief Starts a background worker that settles every signature still unsettled, in declaration order.
+             * @details Idempotent while the worker runs. The worker checks for a stop between signatures, so
+             *          @ref stop_prefetch and the destructor wait for one resolve at most.
+             * @return Nothing, or OutOfMemory / SystemCallFailed when the worker could not be started.
+             * @note Setup/control-plane only: starts a thread. Never call it under the loader lock.
+             */
+            [[nodiscard]] Result<void> prefetch() noexcept;
+
+            /// Stops and joins the prefetch worker, if one is running; signatures it did not reach stay lazy.
+            void stop_prefetch() noexcept;
+
+            /// True once signature @p index has a stored verdict; never blocks.
+            [[nodiscard]] bool settled(std::size_t index) const noexcept;
+
+            /// The resolve of signature @p index, or nullptr while it is still unsettled.
+            [[nodiscard]] const anchor::ResolvedAnchor *resolved(std::size_t index) const noexcept;
+
+            /// The index of the signature labelled @p label, if any.
+            [[nodiscard]] std::optional<std::size_t> index_of(std::string_view label) const noexcept;
+
+            /// The compiled signatures, in the order they were adopted.
+            [[nodiscard]] std::span<const Signature> signatures() const noexcept;
+
+        private:
+            struct Slot;
+
+            // Settles slot @p index through its once-flag, its parent chain first.
+            void settle(std::size_t index) noexcept;
+            // Stores @p outcome as slot @p index's verdict. Runs inside the slot's once-flag.
+            void store(std::size_t index, const anchor::ResolvedAnchor &outcome) noexcept;
+
+            GatePolicy m_policy;
+            Region m_scope;
+            std::vector<Signature> m_signatures;
+            // Parent index of each signature; FORK_JOIN_NO_PARENT for a root, past the end for a label that names no
+            // signature or sits on a parent cycle, which settles as Failed.
+            std::vector<std::size_t> m_parents;
+            std::unique_ptr<Slot[]> m_slots;
+            std::unique_ptr<StoppableWorker> m_prefetch;
+        };
 
         /**
          * @brief Maps a @ref BindingKind to a short human-readable label (its file token).
@@ -3,9 +3,27 @@
 
 /**
  * @file math.hpp
- * @brief Provides basic mathematical utility functions.
+ * @brief Provides basic mathematical utility functions and the vector, quaternion and matrix types camera and physics
+ *        hooks work in.
+ * @details The types are plain float aggregates laid out like the engine types a hook reads out of game memory, so a
+ *          pointer into a game's camera or transform block can be copied straight into them:
+ *          - Float3 / Float4 match DirectXMath's XMFLOAT3 / XMFLOAT4, Unity's Vector3 / Vector4, and a float build
+ *            of Unreal's FVector / FVector4 (UE5 stores doubles by default; convert those).
+ *          - Quat stores x, y, z, w like XMFLOAT4 quaternions, Unreal's FQuat and Unity's Quaternion. GLM's quat is
+ *            w-first unless GLM_FORCE_QUAT_DATA_XYZW is defined.
+ *          - Float4x4 is row-major with the row-vector convention of DirectX and Unreal (a point transforms as v * M,
+ *            translation sits in row 3), so `a * b` applies a first, then b.
+ *          Every single-value operation has a constexpr scalar form; the matrix product and Float4 transform switch to
+ *          SSE when not constant-evaluated. The batch transforms over spans live out of line and pick an AVX2-tier or
+ *          SSE kernel at run time, the same selection the scanner makes.
  */
+#include <cmath>
+#include <cstddef>
 #include <numbers>
+#include <span>
+#include <type_traits>
+
+#include <xmmintrin.h>
 
 namespace DetourModKit
 {
@@ -23,6 +41,351 @@ namespace DetourModKit
             return radians * (180.0f / std::numbers::pi_v<float>);
         }
 
+        /// A three-component float vector: a position, direction or Euler triple.
+        struct Float3
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+
+            [[nodiscard]] constexpr bool operator==(const Float3 &) const noexcept = default;
+        };
+
+        /// A four-component float vector: a homogeneous point (w = 1) or direction (w = 0).
+        struct Float4
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+            float w = 0.0f;
+
+            [[nodiscard]] constexpr bool operator==(const Float4 &) const noexcept = default;
+        };
+
+        /// A rotation quaternion stored x, y, z, w; default-constructed to the identity.
+        struct Quat
+        {
+            float x = 0.0f;
+            float y = 0.0f;
+            float z = 0.0f;
+            float w = 1.0f;
+
+            [[nodiscard]] constexpr bool operator==(const Quat &) const noexcept = default;
+        };
+
+        /// A row-major 4x4 matrix, m[row][column], under the row-vector convention; default-constructed to zero.
+        struct Float4x4
+        {
+            float m[4][4]{};
+
+            [[nodiscard]] constexpr bool operator==(const Float4x4 &) const noexcept = default;
+        };
+
+        // The layouts are the contract with engine memory: no padding, no hidden members.
+        static_assert(sizeof(Float3) == 12 && alignof(Float3) == 4 && std::is_trivially_copyable_v<Float3>);
+        static_assert(sizeof(Float4) == 16 && std::is_trivially_copyable_v<Float4>);
+        static_assert(sizeof(Quat) == 16 && std::is_trivially_copyable_v<Quat>);
+        static_assert(sizeof(Float4x4) == 64 && std::is_trivially_copyable_v<Float4x4>);
+
+        [[nodiscard]] constexpr Float3 operator+(Float3 a, Float3 b) noexcept
+        {
+            return {a.x + b.x, a.y + b.y, a.z + b.z};
+        }
+
+        [[nodiscard]] constexpr Float3 operator-(Float3 a, Float3 b) noexcept
+        {
+            return {a.x - b.x, a.y - b.y, a.z - b.z};
+        }
+
+        [[nodiscard]] constexpr Float3 operator-(Float3 v) noexcept
+        {
+            return {-v.x, -v.y, -v.z};
+        }
+
+        [[nodiscard]] constexpr Float3 operator*(Float3 v, float s) noexcept
+        {
+            return {v.x * s, v.y * s, v.z * s};
+        }
+
+        [[nodiscard]] constexpr Float3 operator*(float s, Float3 v) noexcept
+        {
+            return v * s;
+        }
+
+        [[nodiscard]] constexpr Float3 operator/(Float3 v, float s) noexcept
+        {
+            return {v.x / s, v.y / s, v.z / s};
+        }
+
+        [[nodiscard]] constexpr Float4 operator+(Float4 a, Float4 b) noexcept
+        {
+            return {a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w};
+        }
+
+        [[nodiscard]] constexpr Float4 operator-(Float4 a, Float4 b) noexcept
+        {
+            return {a.x - b.x, a.y - b.y, a.z - b.z, a.w - b.w};
+        }
+
+        [[nodiscard]] constexpr Float4 operator*(Float4 v, float s) noexcept
+        {
+            return {v.x * s, v.y * s, v.z * s, v.w * s};
+        }
+
+        [[nodiscard]] constexpr float dot(Float3 a, Float3 b) noexcept
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z;
+        }
+
+        [[nodiscard]] constexpr float dot(Float4 a, Float4 b) noexcept
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        /// The cross product; with the left-handed axes of DirectX and Unreal, cross(x, y) == z.
+        [[nodiscard]] constexpr Float3 cross(Float3 a, Float3 b) noexcept
+        {
+            return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+        }
+
+        [[nodiscard]] constexpr float length_squared(Float3 v) noexcept
+        {
+            return dot(v, v);
+        }
+
+        [[nodiscard]] inline float length(Float3 v) noexcept
+        {
+            return std::sqrt(length_squared(v));
+        }
+
+        [[nodiscard]] inline float distance(Float3 a, Float3 b) noexcept
+        {
+            return length(a - b);
+        }
+
+        /// Returns @p v scaled to unit length, or the zero vector when @p v has no length to scale.
+        [[nodiscard]] inline Float3 normalize(Float3 v) noexcept
+        {
+            const float len = length(v);
+            return len > 0.0f ? v / len : Float3{};
+        }
+
+        /// Linear interpolation: @p a at t = 0, @p b at t = 1.
+        [[nodiscard]] constexpr Float3 lerp(Float3 a, Float3 b, float t) noexcept
+        {
+            return a + (b - a) * t;
+        }
+
+        /**
+         * @brief The Hamilton product: rotating by `a * b` rotates by @p b first, then by @p a.
+         * @note The opposite order to the matrix product, as with Unreal's FQuat and FMatrix.
+         */
+        [[nodiscard]] constexpr Quat operator*(const Quat &a, const Quat &b) noexcept
+        {
+            return {a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y, a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                    a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w, a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z};
+        }
+
+        /// The inverse rotation of a unit quaternion.
+        [[nodiscard]] constexpr Quat conjugate(const Quat &q) noexcept
+        {
+            return {-q.x, -q.y, -q.z, q.w};
+        }
+
+        [[nodiscard]] constexpr float dot(const Quat &a, const Quat &b) noexcept
+        {
+            return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+        }
+
+        /// Returns @p q scaled to unit length, or the identity when @p q is zero.
+        [[nodiscard]] inline Quat normalize(const Quat &q) noexcept
+        {
+            const float len = std::sqrt(dot(q, q));
+            if (len <= 0.0f)
+            {
+                return Quat{};
+            }
+            return {q.x / len, q.y / len, q.z / len, q.w / len};
+        }
+
+        /**
+         * @brief The rotation of @p radians about @p axis.
+         * @pre @p axis is unit length.
+         */
+        [[nodiscard]] inline Quat from_axis_angle(Float3 axis, float radians) noexcept
+        {
+            const float s = std::sin(radians * 0.5f);
+            return {axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f)};
+        }
+
+        /// Rotates @p v by the unit quaternion @p q.
+        [[nodiscard]] constexpr Float3 rotate(const Quat &q, Float3 v) noexcept
+        {
+            // v' = v + w * t + u x t with t = 2 (u x v): two cross products instead of two quaternion products.
+            const Float3 u{q.x, q.y, q.z};
+            const Float3 t = cross(u, v) * 2.0f;
+            return v + t * q.w + cross(u, t);
+        }
+
+        /**
+         * @brief Spherical interpolation along the shorter arc between two unit quaternions.
+         * @details Falls back to a normalized lerp when the two are nearly parallel, where the slerp weights lose
+         *          precision.
+         */
+        [[nodiscard]] inline Quat slerp(const Quat &a, const Quat &b, float t) noexcept
+        {
+            float cos_theta = dot(a, b);
+            const float sign = cos_theta < 0.0f ? -1.0f : 1.0f;
+            cos_theta *= sign;
+
+            float wa = 1.0f - t;
+            float wb = t * sign;
+            if (cos_theta < 0.9995f)
+            {
+                const float theta = std::acos(cos_theta);
+                const float inv_sin = 1.0f / std::sin(theta);
+                wa = std::sin(wa * theta) * inv_sin;
+                wb = std::sin(t * theta) * inv_sin * sign;
+            }
+            return normalize(Quat{a.x * wa + b.x * wb, a.y * wa + b.y * wb, a.z * wa + b.z * wb, a.w * wa + b.w * wb});
+        }
+
+        [[nodiscard]] constexpr Float4x4 identity() noexcept
+        {
+            return Float4x4{{{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f},
+                             {0.0f, 0.0f, 0.0f, 1.0f}}};
+        }
+
+        [[nodiscard]] constexpr Float4x4 translation(Float3 t) noexcept
+        {
+            Float4x4 r = identity();
+            r.m[3][0] = t.x;
+            r.m[3][1] = t.y;
+            r.m[3][2] = t.z;
+            return r;
+        }
+
+        [[nodiscard]] constexpr Float4x4 scaling(Float3 s) noexcept
+        {
+            Float4x4 r = identity();
+            r.m[0][0] = s.x;
+            r.m[1][1] = s.y;
+            r.m[2][2] = s.z;
+            return r;
+        }
+
+        /// The rotation matrix of the unit quaternion @p q: transform_vector(rotation(q), v) == rotate(q, v).
+        [[nodiscard]] constexpr Float4x4 rotation(const Quat &q) noexcept
+        {
+            const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+            const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+            const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+            return Float4x4{{{1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy), 0.0f},
+                             {2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx), 0.0f},
+                             {2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy), 0.0f},
+                             {0.0f, 0.0f, 0.0f, 1.0f}}};
+        }
+
+        [[nodiscard]] constexpr Float4x4 transpose(const Float4x4 &a) noexcept
+        {
+            Float4x4 r;
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    r.m[i][j] = a.m[j][i];
+                }
+            }
+            return r;
+        }
+
+        /// The matrix product; under the row-vector convention `a * b` applies @p a first, then @p b.
+        [[nodiscard]] constexpr Float4x4 operator*(const Float4x4 &a, const Float4x4 &b) noexcept
+        {
+            Float4x4 r;
+            if !consteval
+            {
+                const __m128 b0 = _mm_loadu_ps(b.m[0]);
+                const __m128 b1 = _mm_loadu_ps(b.m[1]);
+                const __m128 b2 = _mm_loadu_ps(b.m[2]);
+                const __m128 b3 = _mm_loadu_ps(b.m[3]);
+                for (int i = 0; i < 4; ++i)
+                {
+                    __m128 row = _mm_mul_ps(_mm_set1_ps(a.m[i][0]), b0);
+                    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][1]), b1));
+                    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][2]), b2));
+                    row = _mm_add_ps(row, _mm_mul_ps(_mm_set1_ps(a.m[i][3]), b3));
+                    _mm_storeu_ps(r.m[i], row);
+                }
+                return r;
+            }
+            for (int i = 0; i < 4; ++i)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] +
+                                a.m[i][3] * b.m[3][j];
+                }
+            }
+            return r;
+        }
+
+        /// Transforms the homogeneous vector @p v as `v * m`.
+        [[nodiscard]] constexpr Float4 transform(const Float4x4 &m, Float4 v) noexcept
+        {
+            if !consteval
+            {
+                __m128 r = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(m.m[0]));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(m.m[1])));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(m.m[2])));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.w), _mm_loadu_ps(m.m[3])));
+                Float4 out;
+                _mm_storeu_ps(&out.x, r);
+                return out;
+            }
+            return {v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + v.w * m.m[3][0],
+                    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + v.w * m.m[3][1],
+                    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + v.w * m.m[3][2],
+                    v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + v.w * m.m[3][3]};
+        }
+
+        /// Transforms the point @p p (w = 1, translation applied); the w column is ignored, so no divide.
+        [[nodiscard]] constexpr Float3 transform_point(const Float4x4 &m, Float3 p) noexcept
+        {
+            return {p.x * m.m[0][0] + p.y * m.m[1][0] + p.z * m.m[2][0] + m.m[3][0],
+                    p.x * m.m[0][1] + p.y * m.m[1][1] + p.z * m.m[2][1] + m.m[3][1],
+                    p.x * m.m[0][2] + p.y * m.m[1][2] + p.z * m.m[2][2] + m.m[3][2]};
+        }
+
+        /// Transforms the direction @p v (w = 0, translation ignored).
+        [[nodiscard]] constexpr Float3 transform_vector(const Float4x4 &m, Float3 v) noexcept
+        {
+            return {v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0],
+                    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1],
+                    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2]};
+        }
+
+        /**
+         * @brief Transforms min(in.size(), out.size()) points by @p m into @p out, as transform_point does each.
+         * @details Runs an AVX2-tier kernel when scan::active_simd_level() reports one, else SSE. @p in and @p out
+         *          may be the same span; partially overlapping spans are not supported.
+         * @return The number of points written.
+         * @note Callback-safe: no allocation, locking, or I/O.
+         */
+        [[nodiscard]] std::size_t transform_points(const Float4x4 &m, std::span<const Float3> in,
+                                                   std::span<Float3> out) noexcept;
+
+        /// Batch transform_vector over min(in.size(), out.size()) directions; the same contract as transform_points.
+        [[nodiscard]] std::size_t transform_vectors(const Float4x4 &m, std::span<const Float3> in,
+                                                    std::span<Float3> out) noexcept;
+
+        /// Batch transform over min(in.size(), out.size()) homogeneous vectors; the same contract as transform_points.
+        [[nodiscard]] std::size_t transform(const Float4x4 &m, std::span<const Float4> in,
+                                            std::span<Float4> out) noexcept;
+
+        /// Batch rotate by a unit quaternion; builds rotation(q) once, then runs transform_vectors.
+        [[nodiscard]] std::size_t rotate(const Quat &q, std::span<const Float3> in, std::span<Float3> out) noexcept;
+
     } // namespace math
 } // namespace DetourModKit
 
@@ -28,6 +28,7 @@
 #include "DetourModKit/defines.hpp"
 #include "DetourModKit/error.hpp"
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 
 #include <array>
 #include <bit>
@@ -35,11 +36,14 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
 #include <memory>
+#include <new>
 #include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -104,6 +108,12 @@ namespace DetourModKit
         inline constexpr std::size_t DEFAULT_CACHE_SHARD_COUNT = 16;
         /// Default multiplier bounding the cache's hard maximum size relative to its configured size.
         inline constexpr std::size_t DEFAULT_MAX_CACHE_SIZE_MULTIPLIER = 2;
+        /// Default lifetime, in milliseconds, of a cached unmapped or unreadable region (capped at the cache expiry).
+        inline constexpr unsigned int DEFAULT_NEGATIVE_CACHE_EXPIRY_MS = 10;
+        /// Default ceiling on the shard count an adaptive cache grows to.
+        inline constexpr std::size_t DEFAULT_MAX_ADAPTIVE_SHARD_COUNT = 64;
+        /// Default ceiling on an adaptive cache's total soft capacity, as a multiple of its configured size.
+        inline constexpr std::size_t DEFAULT_ADAPTIVE_CACHE_GROWTH_LIMIT = 8;
 
         /**
          * @brief Structural plausibility test for an x64 user-mode pointer.
@@ -162,6 +172,416 @@ namespace DetourModKit
             return std::bit_cast<T>(storage);
         }
 
+        /**
+         * @struct ReadDescriptor
+         * @brief One copy of a @ref read_many batch: `destination.size()` bytes from @ref address into
+         *        @ref destination.
+         */
+        struct ReadDescriptor
+        {
+            /// Source address.
+            Address address{};
+            /// Destination bytes. An empty span is a successful no-op.
+            std::span<std::byte> destination{};
+        };
+
+        /**
+         * @brief Guarded scatter-gather copy: performs every read in @p reads under one fault-guard entry.
+         * @param reads The copies to perform, in order. Sources may repeat, overlap, or sit in different regions.
+         * @param ok One status per read, written in input order: 1 copied, 0 faulted or rejected. Must hold at least
+         *        `reads.size()` entries; entries past that are left untouched.
+         * @return The number of reads that copied, or `ErrorCode::InvalidArg` when @p ok is too short.
+         * @details Built for per-frame sweeps that read dozens of fields off thousands of objects, where entering the
+         *          guard once per @ref read_into dominates the cost. Each read is screened exactly as @ref read_into
+         *          screens it, then the copies run back to back inside one guard (MSVC `__try`, MinGW vectored
+         *          handler). A fault fails only the read that raised it: the guard is re-entered past it and the rest of
+         *          the batch still copies. A failed read's destination is unspecified.
+         * @note Callback-safe (see @ref read_into).
+         */
+        [[nodiscard]] Result<std::size_t> read_many(std::span<const ReadDescriptor> reads,
+                                                    std::span<std::uint8_t> ok) noexcept;
+
+        /**
+         * @brief Issues a software prefetch hint for the cache line at each `address + offset`.
+         * @param addresses Addresses to warm; null entries are skipped.
+         * @param offset Byte offset added to every address, e.g. the first field a sweep will read.
+         * @details A prefetch is a hint, not an access: it never faults, so stale or unmapped addresses are harmless
+         *          and cost only the issued instruction. Used by @ref PointerArrayView to start the next block's
+         *          dependent misses while the caller still works through the current one.
+         * @note Callback-safe: no lock, no allocation, no syscall.
+         */
+        void prefetch(std::span<const Address> addresses, std::ptrdiff_t offset = 0) noexcept;
+
+        /**
+         * @brief Prefetch hints for @p count elements of @p stride bytes from @p base: one per element, or one per
+         *        cache line when elements are smaller than a line.
+         * @note Callback-safe; never faults (see @ref prefetch).
+         */
+        void prefetch_strided(Address base, std::size_t count, std::size_t stride) noexcept;
+
+        /// Elements a @ref StridedView or @ref PointerArrayView sweep reads per guarded batch: ~2 KiB, at most 64.
+        template <class T>
+        inline constexpr std::size_t VIEW_BLOCK_ELEMENTS =
+            sizeof(T) >= 2048 ? 1 : (2048 / sizeof(T) > 64 ? 64 : 2048 / sizeof(T));
+
+        /**
+         * @struct ViewElement
+         * @brief One element yielded by a @ref StridedView or @ref PointerArrayView sweep.
+         * @details @ref value points into the iterator's block buffer and stays valid until the iterator advances.
+         */
+        template <class T> struct ViewElement
+        {
+            /// Position of the element in the view.
+            std::size_t index = 0;
+            /// The element itself for a StridedView; the object its slot points at for a PointerArrayView.
+            Address address{};
+            /// The copied value, or null when its read faulted or its slot held a null pointer.
+            const T *value = nullptr;
+
+            [[nodiscard]] explicit operator bool() const noexcept { return value != nullptr; }
+        };
+
+        /**
+         * @class StridedView
+         * @brief A guarded, block-buffered view of @p count elements spaced @p stride bytes apart in target memory.
+         * @details Models an engine array (TArray-style base, count and element size) or one field across an array of
+         *          entities: construct it at `base + field_offset` with the entity size as the stride and @p T as the
+         *          field. Iteration reads @ref VIEW_BLOCK_ELEMENTS elements at a time through one @ref read_many, so a
+         *          sweep enters the fault guard once per block instead of once per element, and prefetches the next
+         *          block before copying the current one. A faulted element yields a null @ref ViewElement::value; the
+         *          sweep continues. The view is a trivially copyable value; the block buffer lives in the iterator.
+         * @note Callback-safe: iteration allocates nothing, takes no lock, and issues no syscall.
+         */
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        class StridedView
+        {
+        public:
+            static constexpr std::size_t BLOCK = VIEW_BLOCK_ELEMENTS<T>;
+
+            class iterator;
+
+            constexpr StridedView() noexcept = default;
+
+            /// A view of @p count elements from @p base; a @p stride of zero means `sizeof(T)`.
+            constexpr StridedView(Address base, std::size_t count, std::size_t stride = sizeof(T)) noexcept
+                : m_base(base), m_count(count), m_stride(stride == 0 ? sizeof(T) : stride)
+            {
+            }
+
+            [[nodiscard]] constexpr Address base() const noexcept { return m_base; }
+            [[nodiscard]] constexpr std::size_t size() const noexcept { return m_count; }
+            [[nodiscard]] constexpr bool empty() const noexcept { return m_count == 0; }
+            [[nodiscard]] constexpr std::size_t stride() const noexcept { return m_stride; }
+
+            [[nodiscard]] constexpr Address address_of(std::size_t index) const noexcept
+            {
+                return Address{m_base.raw() + index * m_stride};
+            }
+
+            /// Guarded read of one element; `ErrorCode::InvalidArg` (with the index in `Error::detail`) past the end.
+            [[nodiscard]] Result<T> read(std::size_t index) const noexcept
+            {
+                if (index >= m_count)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "memory::StridedView::read", index});
+                }
+                return memory::read<T>(address_of(index));
+            }
+
+            /**
+             * @brief Reads elements `[first, first + out.size())` in guarded batches of @ref BLOCK.
+             * @param ok One status per element of @p out, as @ref read_many writes it. Must be at least as long.
+             * @return The number of elements copied; `ErrorCode::InvalidArg` when @p ok is short or the range runs past
+             *         the end of the view.
+             */
+            [[nodiscard]] Result<std::size_t> read_block(std::size_t first, std::span<T> out,
+                                                         std::span<std::uint8_t> ok) const noexcept
+            {
+                if (ok.size() < out.size() || first > m_count || out.size() > m_count - first)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "memory::StridedView::read_block", first});
+                }
+                return read_raw(first, out.size(), reinterpret_cast<std::byte *>(out.data()), ok.data());
+            }
+
+            [[nodiscard]] iterator begin() const noexcept { return iterator(*this); }
+            [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+        private:
+            std::size_t read_raw(std::size_t first, std::size_t count, std::byte *out, std::uint8_t *ok) const noexcept
+            {
+                std::array<ReadDescriptor, BLOCK> reads{};
+                std::size_t copied = 0;
+                for (std::size_t done = 0; done < count;)
+                {
+                    const std::size_t batch = count - done < BLOCK ? count - done : BLOCK;
+                    const std::size_t next = first + done + batch;
+                    if (next < m_count)
+                    {
+                        prefetch_strided(address_of(next), m_count - next < BLOCK ? m_count - next : BLOCK, m_stride);
+                    }
+                    for (std::size_t i = 0; i < batch; ++i)
+                    {
+                        reads[i] = {address_of(first + done + i), {out + (done + i) * sizeof(T), sizeof(T)}};
+                    }
+                    copied += read_many(std::span(reads).first(batch), {ok + done, batch}).value_or(0);
+                    done += batch;
+                }
+                return copied;
+            }
+
+            Address m_base{};
+            std::size_t m_count = 0;
+            std::size_t m_stride = sizeof(T);
+        };
+
+        /**
+         * @class StridedView::iterator
+         * @brief Input iterator over a @ref StridedView; dereferences to a @ref ViewElement by value.
+         */
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        class StridedView<T>::iterator
+        {
+        public:
+            using value_type = ViewElement<T>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() noexcept = default;
+
+            [[nodiscard]] ViewElement<T> operator*() const noexcept
+            {
+                const std::size_t slot = m_index - m_first;
+                return {m_index, m_view.address_of(m_index),
+                        m_ok[slot] != 0 ? std::launder(reinterpret_cast<const T *>(m_storage + slot * sizeof(T)))
+                                        : nullptr};
+            }
+
+            iterator &operator++() noexcept
+            {
+                ++m_index;
+                settle();
+                return *this;
+            }
+
+            void operator++(int) noexcept { ++*this; }
+
+            [[nodiscard]] friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept
+            {
+                return it.m_index >= it.m_view.size();
+            }
+
+        private:
+            friend class StridedView;
+
+            explicit iterator(const StridedView &view) noexcept : m_view(view) { settle(); }
+
+            // Refills the block buffer when the index has run off the end of the current block.
+            void settle() noexcept
+            {
+                if (m_index < m_view.m_count && m_index >= m_first + m_filled)
+                {
+                    m_first = m_index;
+                    m_filled = m_view.m_count - m_index < BLOCK ? m_view.m_count - m_index : BLOCK;
+                    (void)m_view.read_raw(m_first, m_filled, m_storage, m_ok.data());
+                }
+            }
+
+            StridedView m_view{};
+            std::size_t m_index = 0;
+            std::size_t m_first = 0;
+            std::size_t m_filled = 0;
+            std::array<std::uint8_t, BLOCK> m_ok{};
+            alignas(T) std::byte m_storage[BLOCK * sizeof(T)];
+        };
+
+        /**
+         * @class PointerArrayView
+         * @brief A guarded, block-buffered view of an array of @p count object pointers, reading a @p T at
+         *        `*slot + offset` for each.
+         * @details The `TArray<Entity *>` walk: the slot block is one guarded copy (falling back to per-slot reads when
+         *          it faults), the objects it points at are one @ref read_many, and as each block is handed out the
+         *          iterator already reads the next block's slots and prefetches their objects, so the dependent miss
+         *          of the next block overlaps the caller's work on this one. A null slot or a faulted object yields a
+         *          null @ref ViewElement::value; the sweep continues.
+         * @note Callback-safe: iteration allocates nothing, takes no lock, and issues no syscall.
+         */
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        class PointerArrayView
+        {
+        public:
+            static constexpr std::size_t BLOCK = VIEW_BLOCK_ELEMENTS<T>;
+
+            class iterator;
+
+            constexpr PointerArrayView() noexcept = default;
+
+            /// A view of the @p count pointer slots at @p slots, reading each object's @p T at @p offset.
+            constexpr PointerArrayView(Address slots, std::size_t count, std::ptrdiff_t offset = 0) noexcept
+                : m_slots(slots), m_count(count), m_offset(offset)
+            {
+            }
+
+            [[nodiscard]] constexpr Address slots() const noexcept { return m_slots; }
+            [[nodiscard]] constexpr std::size_t size() const noexcept { return m_count; }
+            [[nodiscard]] constexpr bool empty() const noexcept { return m_count == 0; }
+            [[nodiscard]] constexpr std::ptrdiff_t offset() const noexcept { return m_offset; }
+
+            /// Guarded read of slot @p index; `ErrorCode::InvalidArg` (with the index in `Error::detail`) past the end.
+            [[nodiscard]] Result<Address> pointer_at(std::size_t index) const noexcept
+            {
+                if (index >= m_count)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "memory::PointerArrayView::pointer_at", index});
+                }
+                return memory::read<Address>(slot_address(index));
+            }
+
+            /// Guarded read of the @p T behind slot @p index: the slot read, then the object read.
+            [[nodiscard]] Result<T> read(std::size_t index) const noexcept
+            {
+                Result<Address> object = pointer_at(index);
+                if (!object)
+                {
+                    return std::unexpected(object.error());
+                }
+                return memory::read<T>(object->offset(m_offset));
+            }
+
+            [[nodiscard]] iterator begin() const noexcept { return iterator(*this); }
+            [[nodiscard]] std::default_sentinel_t end() const noexcept { return {}; }
+
+        private:
+            [[nodiscard]] constexpr Address slot_address(std::size_t index) const noexcept
+            {
+                return Address{m_slots.raw() + index * sizeof(Address)};
+            }
+
+            // Copies slots [first, first + count) into @p out, zeroing any slot that cannot be read.
+            void read_slots(std::size_t first, std::size_t count, Address *out) const noexcept
+            {
+                if (read_into(slot_address(first), {reinterpret_cast<std::byte *>(out), count * sizeof(Address)}))
+                {
+                    return;
+                }
+                std::array<ReadDescriptor, BLOCK> reads{};
+                std::array<std::uint8_t, BLOCK> ok{};
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    reads[i] = {slot_address(first + i), {reinterpret_cast<std::byte *>(out + i), sizeof(Address)}};
+                }
+                (void)read_many(std::span(reads).first(count), ok);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    if (ok[i] == 0)
+                    {
+                        out[i] = Address{};
+                    }
+                }
+            }
+
+            Address m_slots{};
+            std::size_t m_count = 0;
+            std::ptrdiff_t m_offset = 0;
+        };
+
+        /**
+         * @class PointerArrayView::iterator
+         * @brief Input iterator over a @ref PointerArrayView; dereferences to a @ref ViewElement by value.
+         */
+        template <class T>
+            requires std::is_trivially_copyable_v<T>
+        class PointerArrayView<T>::iterator
+        {
+        public:
+            using value_type = ViewElement<T>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::input_iterator_tag;
+
+            iterator() noexcept = default;
+
+            [[nodiscard]] ViewElement<T> operator*() const noexcept
+            {
+                const std::size_t slot = m_index - m_first;
+                return {m_index, m_pointers[slot],
+                        m_ok[slot] != 0 ? std::launder(reinterpret_cast<const T *>(m_storage + slot * sizeof(T)))
+                                        : nullptr};
+            }
+
+            iterator &operator++() noexcept
+            {
+                ++m_index;
+                settle();
+                return *this;
+            }
+
+            void operator++(int) noexcept { ++*this; }
+
+            [[nodiscard]] friend bool operator==(const iterator &it, std::default_sentinel_t) noexcept
+            {
+                return it.m_index >= it.m_view.size();
+            }
+
+        private:
+            friend class PointerArrayView;
+
+            explicit iterator(const PointerArrayView &view) noexcept : m_view(view)
+            {
+                if (m_view.m_count != 0)
+                {
+                    m_view.read_slots(0, block_length(0), m_next.data());
+                }
+                settle();
+            }
+
+            [[nodiscard]] std::size_t block_length(std::size_t first) const noexcept
+            {
+                return m_view.m_count - first < BLOCK ? m_view.m_count - first : BLOCK;
+            }
+
+            // Moves onto the next block: its slots were read (and its objects prefetched) one block ago, so only the
+            // object batch runs here, followed by the slot read and prefetch of the block after it.
+            void settle() noexcept
+            {
+                if (m_index >= m_view.m_count || m_index < m_first + m_filled)
+                {
+                    return;
+                }
+                m_first = m_index;
+                m_filled = block_length(m_first);
+                m_pointers = m_next;
+
+                std::array<ReadDescriptor, BLOCK> reads{};
+                for (std::size_t i = 0; i < m_filled; ++i)
+                {
+                    // A null slot keeps a null address, which read_many's screen rejects like any other bad pointer.
+                    const Address object = m_pointers[i] ? m_pointers[i].offset(m_view.m_offset) : Address{};
+                    reads[i] = {object, {m_storage + i * sizeof(T), sizeof(T)}};
+                }
+                (void)read_many(std::span(reads).first(m_filled), m_ok);
+
+                const std::size_t next = m_first + m_filled;
+                if (next < m_view.m_count)
+                {
+                    const std::size_t length = block_length(next);
+                    m_view.read_slots(next, length, m_next.data());
+                    prefetch(std::span<const Address>(m_next).first(length), m_view.m_offset);
+                }
+            }
+
+            PointerArrayView m_view{};
+            std::size_t m_index = 0;
+            std::size_t m_first = 0;
+            std::size_t m_filled = 0;
+            std::array<Address, BLOCK> m_pointers{};
+            std::array<Address, BLOCK> m_next{};
+            std::array<std::uint8_t, BLOCK> m_ok{};
+            alignas(T) std::byte m_storage[BLOCK * sizeof(T)];
+        };
+
         /**
          * @brief Guarded write of a byte span to @p address, changing page protection only if it must.
          * @param address Destination address.
@@ -324,6 +744,93 @@ namespace DetourModKit
         [[nodiscard]] Result<Address> walk(Address base, std::span<const std::ptrdiff_t> offsets,
                                            std::span<Address> trace = {}) noexcept;
 
+        /// Roots @ref walk_many advances together, and so the most loads it keeps in flight per hop.
+        inline constexpr std::size_t WALK_MANY_GROUP = 32;
+
+        /**
+         * @brief Walks one chain from many roots at once: `out[i]` receives what `walk(bases[i], steps)` would return.
+         * @param bases Chain roots, e.g. one entity base per element.
+         * @param steps One @ref ChainStep per hop, shared by every root, with the @ref walk semantics.
+         * @param out One result per root, in input order. Must hold at least `bases.size()` entries; entries past that
+         *        are left untouched. A failed root carries the same error @ref walk reports (`NullChain`, or
+         *        `ReadFaulted` with the failing hop index in `Error::detail`).
+         * @return The number of roots that resolved, or `ErrorCode::InvalidArg` when @p out is too short.
+         * @details A serial walk over a thousand roots is a thousand chains of dependent misses, one outstanding at a
+         *          time. This advances the roots hop by hop in groups of @ref WALK_MANY_GROUP: each hop of a group
+         *          prefetches every live root's link, then reads them all through one @ref read_many, so the core keeps
+         *          a group's misses in flight together and the guard is entered once per hop instead of once per root.
+         *          A root that fails drops out of its group; the others carry on.
+         * @note Callback-safe (see @ref read_into): the group state lives on a fixed stack buffer.
+         */
+        [[nodiscard]] Result<std::size_t> walk_many(std::span<const Address> bases, std::span<const ChainStep> steps,
+                                                    std::span<Result<Address>> out) noexcept;
+
+        /// Default interval, in milliseconds, after which a @ref CompiledChain re-reads its memoized stable hops.
+        inline constexpr unsigned int DEFAULT_CHAIN_REVALIDATE_MS = 250;
+
+        /**
+         * @class CompiledChain
+         * @brief A pointer chain whose leading, rarely-changing hops are dereferenced once and memoized.
+         * @details The first hops of a typical chain (module global -> manager -> list) almost never change, yet
+         *          @ref walk re-reads every one of them on every call. A CompiledChain owns its steps and remembers the
+         *          link its first `stable_hops` dereferences produced, so a @ref walk re-reads only the volatile tail:
+         *          an 8-hop chain with 6 stable hops costs two guarded reads per call instead of eight. The memo is
+         *          re-read when it is older than the revalidation interval, after any @ref invalidate_range (or
+         *          cache clear) while the protection cache is initialized, on @ref invalidate, and once -- with a retry
+         *          of the tail -- whenever the tail fails to resolve from it, so a level reload that rebuilds the
+         *          manager self-heals on the next call.
+         * @note Not thread-safe: @ref walk updates the memo. Give each consumer thread its own instance.
+         */
+        class CompiledChain
+        {
+        public:
+            /**
+             * @brief Compiles @p steps rooted at @p base, memoizing the dereferences of the first @p stable_hops steps.
+             * @param base Root address of the chain.
+             * @param steps One @ref ChainStep per hop, with the @ref walk semantics. Copied into the chain.
+             * @param stable_hops Leading dereferenced hops to memoize; at most `steps.size() - 1`, since the final step
+             *        is never dereferenced. Zero makes @ref walk a plain @ref walk.
+             * @param revalidate_ms Age, in milliseconds, after which the memo is re-read. Zero re-reads it every call.
+             * @return The chain, or `ErrorCode::NullChain` for a null @p base with a non-empty chain,
+             *         `ErrorCode::InvalidArg` when @p stable_hops leaves no final step, or `ErrorCode::OutOfMemory`.
+             * @details Reads nothing: the first @ref walk fills the memo.
+             */
+            [[nodiscard]] static Result<CompiledChain>
+            make(Address base, std::span<const ChainStep> steps, std::size_t stable_hops,
+                 unsigned int revalidate_ms = DEFAULT_CHAIN_REVALIDATE_MS) noexcept;
+
+            /**
+             * @brief Resolves the chain, re-reading only the volatile tail while the memo is fresh.
+             * @param trace Optional out-buffer with the @ref walk trace semantics; memoized hops report their
+             *        memoized links.
+             * @return The resolved leaf address, or the @ref walk errors with the failing hop index counted from the
+             *         chain's first step.
+             */
+            [[nodiscard]] Result<Address> walk(std::span<Address> trace = {}) noexcept;
+
+            /// Drops the memo, so the next @ref walk re-reads every hop.
+            void invalidate() noexcept { m_memo_valid = false; }
+
+            /// True while a memo is held (it may still be re-read by @ref walk once stale).
+            [[nodiscard]] bool memoized() const noexcept { return m_memo_valid; }
+
+        private:
+            CompiledChain() noexcept = default;
+
+            // Re-reads the stable prefix into m_memo; fails with the walk error of the first failing stable hop.
+            [[nodiscard]] Result<void> refresh() noexcept;
+
+            Address m_base{};
+            std::vector<ChainStep> m_steps;
+            std::size_t m_stable_hops = 0;
+            std::uint64_t m_revalidate_ns = 0;
+            // The links the stable hops produced; the last one is the root of the volatile tail.
+            std::vector<Address> m_memo;
+            std::uint64_t m_memo_time_ns = 0;
+            std::uint64_t m_memo_generation = 0;
+            bool m_memo_valid = false;
+        };
+
         /**
          * @class ProtectGuard
          * @brief Move-only RAII page-protection change: applies a @ref Prot to a @ref Region and restores it on scope
@@ -387,20 +894,105 @@ namespace DetourModKit
             std::unique_ptr<Impl> m_impl;
         };
 
+        /**
+         * @class PatchBatch
+         * @brief Collects byte patches and applies them all-or-nothing with one protection change per page run.
+         * @details A @ref write_bytes to a code page pays two VirtualProtect calls, an instruction-cache flush, and a
+         *          cache invalidation of its own, so applying a manifest of 200 patches one by one costs 400+ protect
+         *          syscalls. A batch copies each patch's bytes at @ref add, then @ref apply sorts them, merges the
+         *          pages they touch into contiguous runs, changes each run's protection once (per VirtualQuery region,
+         *          like @ref ProtectGuard), writes every patch, restores each run, flushes the instruction cache once
+         *          per run, and invalidates the protection cache once over the batch's extent.
+         * @note All-or-nothing: if any run cannot be made writable nothing is written, and if a store faults every
+         *       patch already written gets its original bytes back before the protection is restored. The one
+         *       exception is a failed restore after every byte landed, reported as `ProtectionRestoreFailed`.
+         */
+        class PatchBatch
+        {
+        public:
+            /// An empty batch; @ref apply on it is a successful no-op.
+            PatchBatch() noexcept = default;
+
+            /**
+             * @brief Queues a copy of @p bytes to be written at @p address on @ref apply.
+             * @return Success (an empty span is a no-op), or `ErrorCode::NullTargetAddress`,
+             *         `ErrorCode::NullSourceBytes`, `ErrorCode::SizeTooLarge` (over @ref MAX_WRITE_SIZE, or a span
+             *         whose end wraps), or `ErrorCode::OutOfMemory`. On failure the batch is unchanged.
+             * @details Overlapping patches are rejected by @ref apply, not here, so the order patches are added in
+             *          never decides which bytes win.
+             */
+            [[nodiscard]] Result<void> add(Address address, std::span<const std::byte> bytes) noexcept;
+
+            /// Queues the object representation of @p value at @p address; constrained like @ref write.
+            template <class T>
+                requires std::is_trivially_copyable_v<T> && (!detail::is_non_owning_view_v<std::remove_cvref_t<T>>)
+            [[nodiscard]] Result<void> add(Address address, const T &value) noexcept
+            {
+                const auto storage = std::bit_cast<std::array<std::byte, sizeof(T)>>(value);
+                return add(address, std::span<const std::byte>{storage});
+            }
+
+            /**
+             * @brief Writes every queued patch, all-or-nothing, and leaves the batch queued for reuse.
+             * @return Success, or `ErrorCode::InvalidArg` (two patches overlap; nothing is touched),
+             *         `ErrorCode::OutOfMemory`, `ErrorCode::ProtectionChangeFailed` or `ErrorCode::WriteFaulted`
+             *         (every page holds its original bytes and protection again), or
+             *         `ErrorCode::ProtectionRestoreFailed` (every patch landed but a run kept its writable protection).
+             *         `Error::detail` names the address of the failing patch or run; `Error::extra` carries the OS
+             *         error of a failed VirtualProtect.
+             */
+            [[nodiscard]] Result<void> apply() const noexcept;
+
+            /// Drops every queued patch.
+            void clear() noexcept;
+
+            /// Number of queued patches.
+            [[nodiscard]] std::size_t size() const noexcept { return m_patches.size(); }
+
+            /// True when no patch is queued.
+            [[nodiscard]] bool empty() const noexcept { return m_patches.empty(); }
+
+        private:
+            // One queued patch: its target and where its bytes sit in m_bytes.
+            struct Patch
+            {
+                std::uintptr_t address = 0;
+                std::size_t offset = 0;
+                std::size_t size = 0;
+            };
+
+            std::vector<Patch> m_patches;
+            std::vector<std::byte> m_bytes;
+        };
+
         /**
          * @brief Resolves the mapped image span of the module that owns @p address.
          * @param address Any address inside the target module.
          * @return The owning module's @ref Region, or an empty Region when @p address is null, falls inside no loaded
-         *         module, or the module's PE headers do not validate.
+         *         module, or the module's PE headers do not validate. An address inside a live
+         *         @ref offline::MappedImage copy reports that copy's extent.
          * @details The address-keyed module lookup: given a resolved pointer, answer "which module is this in, and what
          *          is its full image span?" so a caller can range-check the pointer against its own image
          *          (@ref Region::own), the host image (@ref Region::host), or a third module. The result is cached per
          *          module handle for the process lifetime, so repeated probes degenerate to a loader lookup plus a hash
-         *          hit.
-         * @note Setup/control-plane only -- issues a loader lookup; call from init or a worker, not a hot callback.
+         *          hit. Between @ref init_cache and @ref shutdown_cache a table of loaded image spans, kept current by
+         *          loader load / unload notifications, answers instead with a lock-free binary search and no loader
+         *          call.
+         * @note Without an initialized cache this issues a loader lookup; call it from init or a worker, not a hot
+         *       callback. With the cache initialized it is cheap enough for per-candidate validation loops.
          */
         [[nodiscard]] Region module_of(Address address) noexcept;
 
+        /**
+         * @brief Reports whether @p address lies inside the loaded module based at @p module_base.
+         * @param address The pointer to classify (a vtable, a function pointer, a global).
+         * @param module_base The module's base address (its HMODULE value), e.g. `Region::host().base`.
+         * @return True when @ref module_of(@p address) is the image based at @p module_base; false for a null argument.
+         * @details The "does this vtable live in the game image?" predicate, with @ref module_of's cost: a lock-free
+         *          table search while the cache is initialized.
+         */
+        [[nodiscard]] bool is_in_module(Address address, Address module_base) noexcept;
+
         /**
          * @brief Reports whether a module with the given base name is currently loaded in the process.
          * @param basename The module's file name as the loader knows it (e.g. "kernel32.dll"); a bare name, not a path.
@@ -441,10 +1033,59 @@ namespace DetourModKit
             std::uint64_t coalesced_queries = 0;
             /// Cumulative on-demand cleanup passes.
             std::uint64_t on_demand_cleanups = 0;
+            /// Cumulative entries evicted by a cleanup pass for outliving the expiry window.
+            std::uint64_t expired_entries = 0;
             /// Live entry count summed across all shards at snapshot time.
             std::size_t total_entries = 0;
+            /// Live entries pinned past the expiry (committed, non-writable image regions) at snapshot time.
+            std::size_t pinned_entries = 0;
+            /// The subset of @ref hits served by a pinned entry older than the expiry window.
+            std::uint64_t pinned_hits = 0;
             /// hits / (hits + misses) * 100, or -1.0 when no queries have been tracked.
             double hit_rate_percent = -1.0;
+            /// True when the cache was initialized with @ref CacheOptions::adaptive.
+            bool adaptive = false;
+            /// Shard-array growths an adaptive cache has made since @ref init_cache.
+            std::uint64_t shard_growths = 0;
+            /// Per-shard capacity growths an adaptive cache has made since @ref init_cache.
+            std::uint64_t capacity_growths = 0;
+            /// Cumulative shard-lock acquisitions whose first try-acquire failed.
+            std::uint64_t contended_acquires = 0;
+            /// Cumulative entries evicted to make room for another (capacity pressure, not the expiry).
+            std::uint64_t capacity_evictions = 0;
+            /// The subset of @ref hits answered by the negative table (an unmapped or unreadable region).
+            std::uint64_t negative_hits = 0;
+            /// Negative-table entry lifetime in milliseconds; 0 when the table is disabled.
+            unsigned int negative_expiry_ms = 0;
+        };
+
+        /**
+         * @struct CacheOptions
+         * @brief Configuration of the protection cache, including its adaptive shard and capacity growth.
+         * @details With @ref adaptive set, the periodic cleanup task also watches the cache once per interval: when
+         *          more than one shard-lock acquisition in 64 found its first try-acquire failing, it doubles the shard
+         *          count, and when the shards evicted at least one entry for every four misses, it doubles the
+         *          per-shard capacity. Both stop at their ceilings. A capacity growth is applied in place; a shard
+         *          growth swaps in a fresh, empty array once the reader epoch drains, and is retried at a later
+         *          interval when readers keep it from draining. An interval needs enough locked lookups or misses to
+         *          act on, so an idle cache never grows.
+         */
+        struct CacheOptions
+        {
+            /// Desired number of entries across the cache.
+            std::size_t cache_size = DEFAULT_CACHE_SIZE;
+            /// Cache entry expiry time in milliseconds.
+            unsigned int expiry_ms = DEFAULT_CACHE_EXPIRY_MS;
+            /// Number of cache shards; the starting count when @ref adaptive is set.
+            std::size_t shard_count = DEFAULT_CACHE_SHARD_COUNT;
+            /// Grow the shard count on lock contention and the per-shard capacity on eviction churn.
+            bool adaptive = false;
+            /// Largest shard count adaptive growth reaches; never below @ref shard_count.
+            std::size_t max_shard_count = DEFAULT_MAX_ADAPTIVE_SHARD_COUNT;
+            /// Largest total soft capacity adaptive growth reaches; 0 scales @ref cache_size by the growth limit.
+            std::size_t max_cache_size = 0;
+            /// Lifetime of a cached unmapped or unreadable region, capped at @ref expiry_ms; 0 disables the table.
+            unsigned int negative_expiry_ms = DEFAULT_NEGATIVE_CACHE_EXPIRY_MS;
         };
 
         /**
@@ -453,28 +1094,52 @@ namespace DetourModKit
          * @param expiry_ms Cache entry expiry time in milliseconds.
          * @param shard_count Number of cache shards for concurrent access.
          * @return True if the cache is ready for use (newly or previously initialized), false on allocation failure.
-         * @details Only the first call configures the cache; later calls return true without reconfiguring. Starts a
-         *          background cleanup thread when the platform permits, falling back to on-demand cleanup otherwise. On
+         * @details Only the first call configures the cache; later calls return true without reconfiguring. Registers a
+         *          periodic cleanup task on DMK's shared background thread, falling back to on-demand cleanup when that
+         *          fails. On
          *          MinGW it also installs the process-wide vectored fault handler the guarded reads rely on, so a
          *          guarded read never has to fall back to a per-call VirtualQuery.
+         *
+         *          @p expiry_ms bounds how stale an entry can be, but committed image regions the process cannot
+         *          write (module code and read-only data) are exempt from it while the loader's unload notification
+         *          is subscribed: only a protection change or an unload alters them, and an unload, @ref
+         *          invalidate_range, and every DMK write path evict them explicitly. Any invalidation returns pinned
+         *          entries to the normal expiry until they are next queried. Writable and non-image regions always
+         *          expire. @ref MemoryStats::pinned_entries and @ref MemoryStats::pinned_hits report the effect.
+         *
+         *          A probe that finds its address free, reserved, or unreadable caches that region, with its exact
+         *          bounds, in a separate negative table for @ref DEFAULT_NEGATIVE_CACHE_EXPIRY_MS, so repeated checks
+         *          of stale pointers stop costing a VirtualQuery each without taking shard capacity. An address past
+         *          @ref USERSPACE_PTR_MAX is rejected without any query.
          * @note Setup/control-plane only.
          */
         [[nodiscard]] bool init_cache(std::size_t cache_size = DEFAULT_CACHE_SIZE,
                                       unsigned int expiry_ms = DEFAULT_CACHE_EXPIRY_MS,
                                       std::size_t shard_count = DEFAULT_CACHE_SHARD_COUNT);
 
+        /**
+         * @brief Initializes the protection-region cache from @p options, optionally in adaptive mode.
+         * @param options The starting configuration and, for an adaptive cache, its growth ceilings.
+         * @return True if the cache is ready for use (newly or previously initialized), false on allocation failure.
+         * @details Behaves as the positional overload; see @ref CacheOptions for what @ref CacheOptions::adaptive
+         *          adds. Adaptive growth runs on the periodic cleanup task, so a cache that fell back to on-demand
+         *          cleanup keeps its starting configuration. @ref MemoryStats reports the configuration in force and
+         *          the growths made.
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] bool init_cache(const CacheOptions &options);
+
         /**
          * @brief Clears all entries from the protection cache, leaving it initialized.
-         * @details Invalidates all cached region information; the background cleanup thread keeps running.
+         * @details Invalidates all cached region information; the periodic cleanup task keeps running.
          */
         void clear_cache() noexcept;
 
         /**
-         * @brief Shuts the cache down and joins the background cleanup thread.
-         * @details Call before module unload to terminate the cleanup thread cleanly. After shutdown the cache cannot
-         * be
-         *          reused without re-initialization. Under loader lock the thread is detached rather than joined to
-         *          avoid deadlock, and on MinGW the vectored fault handler is drained and removed.
+         * @brief Shuts the cache down and cancels its periodic cleanup task.
+         * @details Call before module unload. Waits for a cleanup run in progress to finish, except under loader lock,
+         *          where the task is only unregistered to avoid deadlock. After shutdown the cache cannot be reused
+         *          without re-initialization. On MinGW the vectored fault handler is drained and removed.
          * @note Setup/control-plane only.
          */
         void shutdown_cache() noexcept;
@@ -500,6 +1165,33 @@ namespace DetourModKit
          */
         void invalidate_range(Region range) noexcept;
 
+        /**
+         * @brief Seeds the protection cache with every committed region inside @p range, ahead of the first probe.
+         * @param range The span to warm, e.g. @ref module_of for a module or a known hot heap range.
+         * @return The number of VirtualQuery regions cached (0 while the cache is down), or Error{InvalidRange} when
+         *         @p range has a null base and a non-zero size or runs past the end of the address space.
+         * @details Right after @ref init_cache every first check of a region takes the cold-miss path: a VirtualQuery
+         *          plus an exclusive shard insert, coalesced across racing threads. prewarm walks the region map of
+         *          @p range once and inserts each committed region into every shard that has room, since any shard
+         *          can serve a lookup inside it. It never evicts a live entry to make room, so a cache sized below the
+         *          warmed set warms only part of it. Image code and read-only data stay cached past the expiry
+         *          window (see @ref init_cache); other regions are warm only for one expiry window, so they are
+         *          worth warming just before the hot loop that checks them.
+         * @note Setup/control-plane only: it issues one VirtualQuery per region and takes each shard's lock
+         *       exclusively. Call it from the init thread, or a worker (such as the bootstrap on_ready thread) that
+         *       runs before the hot paths start.
+         */
+        [[nodiscard]] Result<std::size_t> prewarm(Region range) noexcept;
+
+        /**
+         * @brief Seeds the protection cache with every committed region inside each span of @p ranges.
+         * @return The number of VirtualQuery regions cached across all spans (0 while the cache is down).
+         * @details Same walk and capacity rules as the Region overload. One VirtualQuery region can reach across
+         *          the gap between two spans; it is walked, and counted, once.
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] std::size_t prewarm(const RegionSet &ranges) noexcept;
+
         /**
          * @enum ReadableStatus
          * @brief Tri-state result for the non-blocking readability check.
@@ -546,6 +1238,24 @@ namespace DetourModKit
          */
         [[nodiscard]] ReadableStatus is_readable_nonblocking(Region range) noexcept;
 
+        /**
+         * @brief Answers @ref is_readable for `Region{addresses[i], bytes}` for every address in one call.
+         * @param addresses The pointers to check, in any order. A null address is never readable.
+         * @param bytes Bytes that must be readable at each address. Zero marks every address unreadable, as an
+         *        empty @ref is_readable range does.
+         * @param out One verdict per address, written in input order: 1 readable, 0 not. Must hold at least
+         *        `addresses.size()` entries; entries past that are left untouched.
+         * @return The number of readable addresses, or `ErrorCode::InvalidArg` when @p out is too short.
+         * @details Built for entity-list sweeps that validate thousands of pointers into a handful of heap regions:
+         *          each distinct region is resolved once through the cache (or one VirtualQuery when the cache is
+         *          down), and every other address inside it is answered by a range compare against a small local
+         *          table of the batch's regions, with no lock, clock read, or reader-guard round trip per address.
+         *          The whole batch is one time-of-check snapshot, with the same caveat as @ref is_readable.
+         * @note Allocates nothing, so it is safe to call with a per-frame stack or arena buffer.
+         */
+        [[nodiscard]] Result<std::size_t> is_readable_batch(std::span<const Address> addresses, std::size_t bytes,
+                                                            std::span<std::uint8_t> out) noexcept;
+
         /**
          * @namespace DetourModKit::memory::unchecked
          * @brief The raw, validation-free fast path. Every entry point here FAULTS THE HOST on an unreadable byte.
@@ -0,0 +1,173 @@
+#ifndef DETOURMODKIT_METRICS_HPP
+#define DETOURMODKIT_METRICS_HPP
+
+/**
+ * @file metrics.hpp
+ * @brief A process-wide registry of named counters, gauges and histograms that @ref DetourModKit::diagnostics::collect
+ *        samples in one call.
+ * @details A subsystem registers its metrics by name once, at startup, and keeps the returned handles. Recording
+ *          through a handle touches only the calling thread's shard of that metric: no lock, no allocation, no
+ *          registry lookup. @ref diagnostics::collect sums the shards of every registered metric into
+ *          @ref diagnostics::Snapshot::metrics, next to the library's own memory-cache counters, so one periodic
+ *          sample shows how every subsystem is doing.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        struct CounterCell;
+        struct GaugeCell;
+        struct HistogramCell;
+    } // namespace detail
+
+    namespace diagnostics
+    {
+        /// The shape of a registered metric.
+        enum class MetricKind : std::uint8_t
+        {
+            /// A monotonically increasing total (events, bytes, retries).
+            Counter,
+            /// A current level that is set or moved up and down (queue depth, live entries).
+            Gauge,
+            /// A distribution of unsigned samples (latencies, sizes) in log2 buckets.
+            Histogram
+        };
+
+        /// Number of log2 buckets in a @ref Histogram.
+        inline constexpr std::size_t METRIC_HISTOGRAM_BUCKETS = 32;
+
+        /**
+         * @class Counter
+         * @brief A handle to a registered counter.
+         * @details Callback-safe: @ref add is one relaxed add on the calling thread's shard, so threads counting one
+         *          hot event write separate cache lines. A default-constructed handle records nothing, so a subsystem
+         *          whose registration failed can keep calling it.
+         */
+        class Counter
+        {
+        public:
+            Counter() noexcept = default;
+
+            /// Adds @p amount to the counter.
+            void add(std::uint64_t amount = 1) const noexcept;
+
+        private:
+            friend Result<Counter> register_counter(std::string_view name);
+            explicit Counter(detail::CounterCell *cell) noexcept : m_cell(cell) {}
+            detail::CounterCell *m_cell = nullptr;
+        };
+
+        /**
+         * @class Gauge
+         * @brief A handle to a registered gauge.
+         * @details A gauge holds one value rather than per-thread partial sums, since a set from one thread must
+         *          replace the level every other thread sees. Both operations are a single relaxed atomic and are
+         *          callback-safe. A default-constructed handle records nothing.
+         */
+        class Gauge
+        {
+        public:
+            Gauge() noexcept = default;
+
+            /// Replaces the gauge's value with @p value.
+            void set(std::int64_t value) const noexcept;
+
+            /// Moves the gauge's value by @p delta (negative to lower it).
+            void add(std::int64_t delta) const noexcept;
+
+        private:
+            friend Result<Gauge> register_gauge(std::string_view name);
+            explicit Gauge(detail::GaugeCell *cell) noexcept : m_cell(cell) {}
+            detail::GaugeCell *m_cell = nullptr;
+        };
+
+        /**
+         * @class Histogram
+         * @brief A handle to a registered histogram.
+         * @details Bucket 0 counts zero samples and bucket `i` counts samples of `[2^(i-1), 2^i)`; the last bucket also
+         *          absorbs everything larger, as a @ref HookStats histogram does. @ref record is three relaxed adds on
+         *          the calling thread's shard and is callback-safe. A default-constructed handle records nothing.
+         */
+        class Histogram
+        {
+        public:
+            Histogram() noexcept = default;
+
+            /// Records one sample of @p value.
+            void record(std::uint64_t value) const noexcept;
+
+        private:
+            friend Result<Histogram> register_histogram(std::string_view name);
+            explicit Histogram(detail::HistogramCell *cell) noexcept : m_cell(cell) {}
+            detail::HistogramCell *m_cell = nullptr;
+        };
+
+        /**
+         * @brief Registers a counter named @p name, or returns the one already registered under it.
+         * @details Registration is idempotent, so two modules (or one module loaded twice) that name the same counter
+         *          share it. A registered metric lives for the rest of the process, and its handle stays valid through
+         *          static teardown.
+         * @return The handle, or an Error: InvalidArg for an empty name or a name already registered as another
+         *         kind, OutOfMemory.
+         * @note Setup/control-plane only: takes the registry lock and may allocate. Register once and keep the handle.
+         */
+        [[nodiscard]] Result<Counter> register_counter(std::string_view name);
+
+        /**
+         * @brief Registers a gauge named @p name, or returns the one already registered under it.
+         * @return The handle, or the errors of @ref register_counter.
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] Result<Gauge> register_gauge(std::string_view name);
+
+        /**
+         * @brief Registers a histogram named @p name, or returns the one already registered under it.
+         * @return The handle, or the errors of @ref register_counter.
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] Result<Histogram> register_histogram(std::string_view name);
+
+        /**
+         * @struct MetricSample
+         * @brief One metric's value at the time of a @ref collect.
+         * @details Shards are summed with relaxed loads, so under live traffic a histogram's @ref count and its bucket
+         *          sum may differ by the samples in flight.
+         */
+        struct MetricSample
+        {
+            /// The registered name.
+            std::string name;
+            /// The metric's shape; selects which fields below are meaningful.
+            MetricKind kind = MetricKind::Counter;
+            /// Counter: the total. Histogram: the number of samples. Gauge: 0.
+            std::uint64_t count = 0;
+            /// Gauge: the current value. Counter and histogram: 0.
+            std::int64_t value = 0;
+            /// Histogram: the sum of every sample. Otherwise 0.
+            std::uint64_t sum = 0;
+            /// Histogram: log2-bucketed sample counts. Otherwise zero.
+            std::array<std::uint64_t, METRIC_HISTOGRAM_BUCKETS> buckets{};
+        };
+
+        /**
+         * @brief Appends a sample of every registered metric to @p out, in registration order.
+         * @details @ref collect calls this for @ref Snapshot::metrics; call it directly to sample the registry without
+         *          building a whole snapshot.
+         * @throws std::bad_alloc if a sample cannot be appended.
+         * @note Setup/control-plane only: takes the registry lock.
+         */
+        void collect_metrics(std::vector<MetricSample> &out);
+    } // namespace diagnostics
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_METRICS_HPP
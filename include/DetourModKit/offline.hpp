@@ -0,0 +1,190 @@
+#ifndef DETOURMODKIT_OFFLINE_HPP
+#define DETOURMODKIT_OFFLINE_HPP
+
+/**
+ * @file offline.hpp
+ * @brief Offline manifest validation: lay a PE file from disk out at its virtual addresses and gate a manifest against
+ *        it, with no game process running.
+ * @details @ref manifest::resolve_and_gate answers "does this manifest still resolve?" only inside a live game, so a
+ *          patch-day regression is found by launching every build by hand. @ref MappedImage reads an image file, copies
+ *          its headers and sections to their RVAs in a private allocation, applies its base relocations, and marks the
+ *          code sections executable, so every resolver that takes a @ref Region -- pattern ladders, RIP-relative
+ *          globals, string xrefs, export lookups, the reverse-RTTI walk -- runs against the copy exactly as it would
+ *          against the loaded module. @ref validate gates one manifest against one file, and @ref validate_all fans a
+ *          list of files (say, every archived build of a game) out across worker threads.
+ *
+ *          The copy is data, never code: no import is bound, no TLS callback or entry point runs, and nothing
+ *          inside the copy is ever called. Executable protection exists only so scans restricted to
+ *          @ref scan::Pages::Executable see the code sections.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/manifest.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace offline
+    {
+        /// How @ref MappedImage::map lays a file out.
+        struct MapOptions
+        {
+            /**
+             * @brief Rebase absolute pointers to the copy's address (the default). Off leaves them at the file's
+             *        preferred base, which breaks the RTTI walk and any vtable or pointer-slot evidence.
+             */
+            bool apply_relocations = true;
+        };
+
+        /**
+         * @class MappedImage
+         * @brief A read-only, loader-independent copy of a 64-bit PE file laid out at its virtual addresses.
+         * @details Move-only; the destructor releases the copy. While it is alive, @ref memory::module_of reports
+         *          @ref region for any address inside it, so resolvers that recover an owning module from a pointer
+         *          (the RTTI walk does so for every vtable) treat the copy as a module.
+         * @note Setup/control-plane only: maps and copies the whole file.
+         */
+        class MappedImage
+        {
+        public:
+            /**
+             * @brief Reads @p path and lays it out as an image.
+             * @param path The PE file (an .exe or .dll; never loaded, only read).
+             * @param options Layout options.
+             * @return The mapped image, or an Error: FileOpenFailed (the file could not be opened or read; detail =
+             *         GetLastError()), InvalidRange (not a well-formed PE32+ image, or a section, header, or
+             *         relocation block outside the file or image), SystemCallFailed (the allocation or a protection
+             *         change failed; detail = GetLastError()), or OutOfMemory.
+             */
+            [[nodiscard]] static Result<MappedImage> map(const std::filesystem::path &path,
+                                                         const MapOptions &options = {}) noexcept;
+
+            MappedImage(MappedImage &&other) noexcept;
+            MappedImage &operator=(MappedImage &&other) noexcept;
+            MappedImage(const MappedImage &) = delete;
+            MappedImage &operator=(const MappedImage &) = delete;
+            ~MappedImage() noexcept;
+
+            /// The copy's extent: [base, base + SizeOfImage). Pass it as the scope of any scan or resolve.
+            [[nodiscard]] Region region() const noexcept { return Region{Address{m_base}, m_size}; }
+            /// The file's ImageBase, the address its code expects to load at.
+            [[nodiscard]] std::uintptr_t preferred_base() const noexcept { return m_preferred_base; }
+            /// The file's basename (e.g. "Game.exe"), the name a manifest record uses to target this module.
+            [[nodiscard]] std::string_view module_name() const noexcept { return m_module_name; }
+
+        private:
+            MappedImage(std::uintptr_t base, std::size_t size, std::uintptr_t preferred_base,
+                        std::string module_name) noexcept;
+            void release() noexcept;
+
+            std::uintptr_t m_base = 0;
+            std::size_t m_size = 0;
+            std::uintptr_t m_preferred_base = 0;
+            std::string m_module_name;
+        };
+
+        /// Why @ref validate left a manifest record out of the gate.
+        enum class SkipReason : std::uint8_t
+        {
+            /// The record names a module other than the validated file; it needs that module's own file.
+            ForeignModule,
+            /// @ref manifest::Signature::compile rejected the record; @ref SkippedRecord::error says why.
+            CompileFailed
+        };
+
+        /// One manifest record that was not gated against the image.
+        struct SkippedRecord
+        {
+            std::string label;
+            SkipReason reason = SkipReason::ForeignModule;
+            /// The compile error for @ref SkipReason::CompileFailed; Ok otherwise.
+            ErrorCode error = ErrorCode::Ok;
+        };
+
+        /**
+         * @struct ImageReport
+         * @brief One file's verdict: the manifest's @ref manifest::GateResult against that file, plus what was skipped.
+         * @details Move-only, because @ref gate borrows labels and bindings from @ref signatures. Addresses in
+         *          @ref gate are inside the copy the report was taken against; when @ref validate mapped the file
+         *          itself that copy is already gone, so read them through @ref rva, which is stable across builds that
+         *          did not move the target.
+         */
+        struct ImageReport
+        {
+            ImageReport() = default;
+            ImageReport(ImageReport &&) noexcept = default;
+            ImageReport &operator=(ImageReport &&) noexcept = default;
+            ImageReport(const ImageReport &) = delete;
+            ImageReport &operator=(const ImageReport &) = delete;
+            ~ImageReport() = default;
+
+            std::filesystem::path path;
+            std::string module_name;
+            /// Where the copy was laid out; the base the @ref gate addresses are relative to.
+            std::uintptr_t mapped_base = 0;
+            std::uintptr_t preferred_base = 0;
+            std::size_t image_size = 0;
+            /// The compiled signatures the gate ran; backing storage for the views in @ref gate.
+            std::vector<manifest::Signature> signatures;
+            manifest::GateResult gate;
+            std::vector<SkippedRecord> skipped;
+
+            /// The image-relative address of a trusted signature (0 for a value outside the image, e.g. Manual).
+            [[nodiscard]] std::uintptr_t rva(const manifest::GatedSignature &signature) const noexcept
+            {
+                const std::uintptr_t address = signature.address.raw();
+                return (address >= mapped_base && address - mapped_base < image_size) ? address - mapped_base : 0;
+            }
+        };
+
+        /**
+         * @brief Gates @p manifest against an already mapped image.
+         * @param image The image; it must outlive any use of the report's addresses.
+         * @param manifest The parsed manifest.
+         * @param policy The trust thresholds, as for @ref manifest::resolve_and_gate.
+         * @return The report, or Error{OutOfMemory}.
+         * @details Records that name no module, or that name @ref MappedImage::module_name (compared ASCII
+         *          case-insensitively), resolve within the image; any other named module is skipped as
+         *          @ref SkipReason::ForeignModule rather than resolved against whatever the validating process has
+         *          loaded. The fingerprint verdict is taken from the record as authored, so retargeting a record at the
+         *          copy never reads as drift.
+         */
+        [[nodiscard]] Result<ImageReport> validate(const MappedImage &image, const manifest::Manifest &manifest,
+                                                   const manifest::GatePolicy &policy = {}) noexcept;
+
+        /**
+         * @brief Maps @p path, gates @p manifest against it, and releases the copy.
+         * @return The report (read addresses through @ref ImageReport::rva), or the Error from @ref MappedImage::map
+         *         or @ref validate.
+         */
+        [[nodiscard]] Result<ImageReport> validate(const std::filesystem::path &path,
+                                                   const manifest::Manifest &manifest,
+                                                   const manifest::GatePolicy &policy = {},
+                                                   const MapOptions &options = {}) noexcept;
+
+        /**
+         * @brief Validates one manifest against many files concurrently.
+         * @param paths The image files.
+         * @param manifest The parsed manifest, shared read-only by every worker.
+         * @param policy The trust thresholds.
+         * @param max_workers Upper bound on worker threads (0 = auto). Each worker holds one mapped copy at a time,
+         *                    so peak memory is about max_workers times the largest image.
+         * @return One report or Error per file, in input order; Error{OutOfMemory} if the batch itself could not
+         *         start. Scans inside each file stay serial, so the thread count is never multiplied.
+         */
+        [[nodiscard]] Result<std::vector<Result<ImageReport>>>
+        validate_all(std::span<const std::filesystem::path> paths, const manifest::Manifest &manifest,
+                     const manifest::GatePolicy &policy = {}, std::size_t max_workers = 0,
+                     const MapOptions &options = {}) noexcept;
+    } // namespace offline
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_OFFLINE_HPP
@@ -0,0 +1,126 @@
+#ifndef DETOURMODKIT_POINTER_MAP_HPP
+#define DETOURMODKIT_POINTER_MAP_HPP
+
+/**
+ * @file pointer_map.hpp
+ * @brief Pointer-path search: rebuild a @ref memory::walk chain from a module global to an address found at run time.
+ * @details When a patch moves a structure, the chain that reached one of its fields has to be found again. A
+ *          @ref memory::PointerMap is a reverse pointer map of writable memory: every aligned qword whose value points
+ *          into writable memory, recorded as (value, slot) and sorted by value. It is built once by a parallel pass
+ *          over the scope. @ref memory::PointerMap::paths_to then searches backwards from a target, breadth-first and
+ *          depth by depth: which slots point at or a little below it, which slots point at or a little below those,
+ *          and so on until a slot inside a loaded module (a static) is reached. Each path it finds is returned as a
+ *          base and the @ref memory::ChainStep list @ref memory::walk takes.
+ *
+ *          A map entry packs its two 47-bit user-mode addresses into 12 bytes, so a map of a few hundred million
+ *          pointers -- a 16 GB heap -- stays within a few GB. The map is a snapshot: a value rewritten after the build
+ *          is not seen, so every path is re-walked before it is returned and one that no longer reaches the target
+ *          is dropped.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/region_set.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace memory
+    {
+        /**
+         * @struct PointerMapOptions
+         * @brief Scope and parallelism of a @ref PointerMap build.
+         */
+        struct PointerMapOptions
+        {
+            /// The ranges whose writable pages are mapped; empty maps the whole user address space.
+            RegionSet scope{};
+            /// Upper bound on worker threads for the build (0 = hardware concurrency).
+            std::size_t max_workers = 0;
+        };
+
+        /**
+         * @struct PointerPathOptions
+         * @brief Bounds of one @ref PointerMap::paths_to search.
+         */
+        struct PointerPathOptions
+        {
+            /// Most dereferences a path may take, counting the static slot's own; at least 1.
+            std::size_t max_depth = 4;
+            /// Largest field offset a hop may add to the pointer it read.
+            std::size_t max_offset = 0x1000;
+            /// Paths to return at most.
+            std::size_t max_results = 64;
+            /// Slots carried from one depth to the next at most, so a densely linked heap cannot blow up the search.
+            std::size_t max_frontier = 4096;
+        };
+
+        /**
+         * @struct PointerPath
+         * @brief One chain from a module to the target: `walk(base, steps)` resolves to it.
+         * @details @ref base is the base of the module holding the static slot, and the first step's offset is that
+         *          slot's RVA, so the pair survives a relocated image. There are depth + 1 steps: a dereference per
+         *          hop and the final field offset.
+         */
+        struct PointerPath
+        {
+            /// Base of the module holding the path's static slot.
+            Address base{};
+            /// The hops, in @ref walk order.
+            std::vector<ChainStep> steps;
+        };
+
+        /**
+         * @class PointerMap
+         * @brief A sorted reverse pointer map of writable memory, queried for paths to a target.
+         * @note Move-only. The build and every query are setup/control-plane work: the build reads every writable page
+         *       of the scope and spawns worker threads for the duration of the call. Queries only read the map and
+         *       re-walk their results, so several threads may query one map at once.
+         */
+        class PointerMap
+        {
+        public:
+            /**
+             * @brief Maps every aligned qword of the scope's writable pages that points into one of those pages.
+             * @return The map, or OutOfMemory.
+             */
+            [[nodiscard]] static Result<PointerMap> build(const PointerMapOptions &options = {}) noexcept;
+
+            PointerMap(PointerMap &&) noexcept;
+            PointerMap &operator=(PointerMap &&) noexcept;
+            PointerMap(const PointerMap &) = delete;
+            PointerMap &operator=(const PointerMap &) = delete;
+            ~PointerMap() noexcept;
+
+            /**
+             * @brief Searches back from @p target to static slots and returns the paths found.
+             * @details Paths are ranked by depth (fewest dereferences first), then by stability: a path rooted in the
+             *          host executable before one rooted in a DLL, then by the smallest sum of hop offsets, since a
+             *          small offset is the likelier to survive a layout change. The search visits each slot at most
+             *          once, at the shallowest depth it is reached, so cyclic structures terminate.
+             * @return The ranked paths, possibly empty; NullTargetAddress for a null @p target, InvalidArg for a
+             *         zero max_depth or max_results or a moved-from map, or OutOfMemory.
+             */
+            [[nodiscard]] Result<std::vector<PointerPath>> paths_to(Address target,
+                                                                    const PointerPathOptions &options = {}) const
+                noexcept;
+
+            /// The number of pointers in the map.
+            [[nodiscard]] std::size_t size() const noexcept;
+
+            /// True when the build skipped a chunk that faulted or could not be allocated.
+            [[nodiscard]] bool incomplete() const noexcept;
+
+        private:
+            struct Impl;
+            explicit PointerMap(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace memory
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_POINTER_MAP_HPP
@@ -0,0 +1,236 @@
+#ifndef DETOURMODKIT_PROFILE_DUMP_HPP
+#define DETOURMODKIT_PROFILE_DUMP_HPP
+
+/**
+ * @file profile_dump.hpp
+ * @brief File format and decoder of the compact binary profile dump that Profiler::export_binary() writes, and its
+ *        conversion to Chrome Trace Event JSON.
+ * @details A dump holds the profiler's samples as fixed-size binary records instead of JSON text: each sample is
+ *          DUMP_SAMPLE_RECORD_SIZE bytes rather than a hundred-odd characters, and writing one is a few copies
+ *          rather than a float format. Scope names are written once, the first time a name is seen, and every sample
+ *          after it carries only the name's number. Convert a dump with @ref format_chrome_json, or offline with the
+ *          DetourModKit_profile_dump_convert tool (DMK_BUILD_TOOLS); the JSON matches what
+ *          Profiler::export_chrome_json() would have produced from the same samples.
+ *
+ *          The format is little-endian. After a DUMP_HEADER_SIZE-byte header (magic u64, version u32, reserved u32,
+ *          QPC frequency i64) the file is a sequence of records, each a kind byte and a fixed layout:
+ *
+ *            DUMP_RECORD_NAME         name number u32 (the count of names before it), length u16, then the name
+ *                                     bytes
+ *            DUMP_RECORD_SAMPLE       name number u32, thread id u32, start QPC ticks i64, duration in
+ *                                     microseconds u32
+ *            DUMP_RECORD_COUNTER      name number u32, thread id u32, QPC ticks i64, value i64
+ *            DUMP_RECORD_FLOW_BEGIN   name number u32, thread id u32, QPC ticks i64, flow id u64
+ *            DUMP_RECORD_FLOW_END     name number u32, thread id u32, QPC ticks i64, flow id u64
+ *
+ *          Version 1 had only the first two records; decode() reads either version. A file cut short (the process
+ *          died mid-write) decodes up to its last whole record.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace profile_dump
+    {
+        /// "DMKPROF1" read as a little-endian u64.
+        inline constexpr std::uint64_t DUMP_MAGIC = 0x31464F52504B4D44ULL;
+        /// The version export_binary() writes; 2 added the counter and flow records.
+        inline constexpr std::uint32_t DUMP_VERSION = 2;
+        inline constexpr std::size_t DUMP_HEADER_SIZE = 24;
+        inline constexpr std::uint8_t DUMP_RECORD_NAME = 1;
+        inline constexpr std::uint8_t DUMP_RECORD_SAMPLE = 2;
+        inline constexpr std::uint8_t DUMP_RECORD_COUNTER = 3;
+        inline constexpr std::uint8_t DUMP_RECORD_FLOW_BEGIN = 4;
+        inline constexpr std::uint8_t DUMP_RECORD_FLOW_END = 5;
+        /// Bytes of a DUMP_RECORD_SAMPLE record, kind byte included.
+        inline constexpr std::size_t DUMP_SAMPLE_RECORD_SIZE = 21;
+        /// Bytes of a counter or flow record, kind byte included.
+        inline constexpr std::size_t DUMP_VALUE_RECORD_SIZE = 25;
+        /// Longest name a DUMP_RECORD_NAME record holds; a longer one is cut.
+        inline constexpr std::size_t DUMP_MAX_NAME_LENGTH = 0xFFFF;
+
+        /// What a decoded sample records.
+        enum class SampleKind : std::uint8_t
+        {
+            /// A timed scope (DUMP_RECORD_SAMPLE).
+            Duration,
+            /// A counter's value at one instant.
+            Counter,
+            /// The start of a flow arrow.
+            FlowBegin,
+            /// The end of a flow arrow.
+            FlowEnd
+        };
+
+        /// One decoded sample.
+        struct Sample
+        {
+            /// Index into Decoded::names.
+            std::uint32_t name{0};
+            std::uint32_t thread_id{0};
+            /// QPC tick count at scope entry, or of the counter reading or flow point.
+            std::int64_t start_ticks{0};
+            /// Duration samples only.
+            std::uint32_t duration_us{0};
+            SampleKind kind{SampleKind::Duration};
+            /// A counter's value, or a flow's id (as a bit pattern); 0 for a duration sample.
+            std::int64_t value{0};
+        };
+
+        /// The result of @ref decode.
+        struct Decoded
+        {
+            /// QPC ticks per second of the session that wrote the dump.
+            std::int64_t qpc_frequency{0};
+            std::vector<std::string> names;
+            /// In the order the profiler exported them: grouped by ring, oldest first within each.
+            std::vector<Sample> samples;
+            /// The file ends inside a record, or a record is malformed; everything before it is decoded.
+            bool truncated{false};
+        };
+
+        /**
+         * @brief Decodes a profile dump image.
+         * @return The names and samples, or `ErrorCode::MissingHeader` when @p image does not start with a version 1
+         *         or 2 header.
+         */
+        [[nodiscard]] Result<Decoded> decode(std::span<const std::byte> image);
+
+        /**
+         * @brief Reads a profile dump file and decodes it.
+         * @return The decoded dump, `ErrorCode::FileOpenFailed` when the file cannot be read, or decode()'s error.
+         */
+        [[nodiscard]] Result<Decoded> read_file(const std::string &path);
+
+        /// Renders every sample of @p decoded as a Chrome Trace Event JSON array, the way the profiler exports it.
+        [[nodiscard]] std::string format_chrome_json(const Decoded &decoded);
+
+        namespace detail
+        {
+            /**
+             * @brief Appends @p input to @p out escaped for a JSON string value.
+             * @details Handles the characters that are special in JSON strings: backslash, double quote, and
+             *          control characters (U+0000..U+001F). Forward slash is NOT escaped (legal unescaped in JSON per
+             *          RFC 8259).
+             */
+            inline void append_json_escaped(std::string &out, std::string_view input)
+            {
+                for (const char c : input)
+                {
+                    switch (c)
+                    {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\b':
+                        out += "\\b";
+                        break;
+                    case '\f':
+                        out += "\\f";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    case '\r':
+                        out += "\\r";
+                        break;
+                    case '\t':
+                        out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            // Control characters U+0000..U+001F require \uXXXX encoding
+                            std::format_to(std::back_inserter(out), "\\u{:04x}",
+                                           static_cast<unsigned int>(static_cast<unsigned char>(c)));
+                        }
+                        else
+                        {
+                            out += c;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            /**
+             * @brief Appends one Chrome Trace Event "X" (complete) event, the shape both the profiler's exporters and
+             *        format_chrome_json() write, so a converted dump matches a direct export byte for byte.
+             * @param ticks_to_us 1'000'000.0 / QPC frequency.
+             */
+            inline void append_chrome_event(std::string &out, std::string_view name, std::int64_t start_ticks,
+                                            std::uint32_t duration_us, std::uint32_t thread_id, double ticks_to_us)
+            {
+                out += R"({"name":")";
+                append_json_escaped(out, name);
+                std::format_to(std::back_inserter(out), R"(","ph":"X","ts":{:.1f},"dur":{},"pid":1,"tid":{}}})",
+                               static_cast<double>(start_ticks) * ticks_to_us, duration_us, thread_id);
+            }
+
+            /// Appends one Chrome Trace Event "C" (counter) event: the track @p name steps to @p value at that time.
+            inline void append_chrome_counter(std::string &out, std::string_view name, std::int64_t ticks,
+                                              std::int64_t value, std::uint32_t thread_id, double ticks_to_us)
+            {
+                out += R"({"name":")";
+                append_json_escaped(out, name);
+                std::format_to(std::back_inserter(out),
+                               R"(","ph":"C","ts":{:.1f},"pid":1,"tid":{},"args":{{"value":{}}}}})",
+                               static_cast<double>(ticks) * ticks_to_us, thread_id, value);
+            }
+
+            /**
+             * @brief Appends one Chrome Trace Event "s" (flow start) or "f" (flow end) event.
+             * @details Chrome joins a start and an end of the same name and @p flow_id into one arrow, drawn from the
+             *          slice enclosing the start to the slice enclosing the end ("bp":"e").
+             */
+            inline void append_chrome_flow(std::string &out, std::string_view name, std::int64_t ticks,
+                                           std::uint64_t flow_id, bool begin, std::uint32_t thread_id,
+                                           double ticks_to_us)
+            {
+                out += R"({"name":")";
+                append_json_escaped(out, name);
+                std::format_to(std::back_inserter(out),
+                               R"(","cat":"flow","ph":"{}",{}"id":{},"ts":{:.1f},"pid":1,"tid":{}}})",
+                               begin ? 's' : 'f', begin ? "" : R"("bp":"e",)", flow_id,
+                               static_cast<double>(ticks) * ticks_to_us, thread_id);
+            }
+
+            /// Appends @p sample as the Chrome Trace Event of its kind.
+            inline void append_chrome_sample(std::string &out, std::string_view name, const Sample &sample,
+                                             double ticks_to_us)
+            {
+                switch (sample.kind)
+                {
+                case SampleKind::Counter:
+                    append_chrome_counter(out, name, sample.start_ticks, sample.value, sample.thread_id, ticks_to_us);
+                    break;
+                case SampleKind::FlowBegin:
+                case SampleKind::FlowEnd:
+                    append_chrome_flow(out, name, sample.start_ticks, static_cast<std::uint64_t>(sample.value),
+                                       sample.kind == SampleKind::FlowBegin, sample.thread_id, ticks_to_us);
+                    break;
+                case SampleKind::Duration:
+                default:
+                    append_chrome_event(out, name, sample.start_ticks, sample.duration_us, sample.thread_id,
+                                        ticks_to_us);
+                    break;
+                }
+            }
+        } // namespace detail
+    } // namespace profile_dump
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_PROFILE_DUMP_HPP
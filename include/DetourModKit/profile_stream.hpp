@@ -0,0 +1,180 @@
+#ifndef DETOURMODKIT_PROFILE_STREAM_HPP
+#define DETOURMODKIT_PROFILE_STREAM_HPP
+
+/**
+ * @file profile_stream.hpp
+ * @brief Layout of the live profile stream that Profiler::start_stream() publishes into shared memory, and the reader
+ *        a viewer process uses to follow it.
+ * @details The stream is one named, pagefile-backed mapping per process (see mapping_name()): a header, a table of
+ *          scope names, and a ring of STREAM_SLOT_COUNT fixed-size sample slots. Producers never wait on a viewer. A
+ *          sample takes a position with a fetch_add on the header's write cursor and fills the slot at that
+ *          position under the same odd/even sequence scheme as ProfileSample, except that the sequence also names
+ *          the position: 2 * position + 1 while the slot is being written, 2 * position + 2 once it holds that
+ *          position's sample. A reader keeps its own cursor, so it can tell a slot not yet written (sequence below
+ *          its position's) from one a producer has already lapped (above it), and counts the samples it missed
+ *          instead of misreading them. Any number of viewers may follow one stream.
+ *
+ *          Names go into the table once, the first time a name pointer is published, and slots carry only the
+ *          name's index. Every DetourModKit copy in the process (two mods, each with its own static library) maps
+ *          the same stream and publishes into it; their name pointers cannot collide, since they share one address
+ *          space.
+ *
+ *          All fields are little-endian and accessed through std::atomic_ref; the structs below are the layout, not
+ *          types to copy.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace profile_stream
+    {
+        /// "DMKSTRM1" read as a little-endian u64.
+        inline constexpr std::uint64_t STREAM_MAGIC = 0x314D5254534B4D44ULL;
+        /// Bump on any change to the structs below; it is part of the mapping name.
+        inline constexpr std::uint32_t STREAM_VERSION = 1;
+        /// Sample slots in the ring (a power of 2).
+        inline constexpr std::size_t STREAM_SLOT_COUNT = 65536;
+        /// Distinct scope names the stream can name; samples of further names carry STREAM_NO_NAME.
+        inline constexpr std::size_t STREAM_NAME_COUNT = 1024;
+        /// Bytes of name text a table entry holds; a longer name is cut.
+        inline constexpr std::size_t STREAM_NAME_BYTES = 48;
+        /// The name index of a sample whose name did not fit in the table.
+        inline constexpr std::uint32_t STREAM_NO_NAME = 0xFFFFFFFFU;
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: StreamHeader and StreamName are padded to whole cache lines by alignas(64) on purpose, so producers writing
+// the cursor or claiming a name never share a line with the fields around them.
+#pragma warning(disable : 4324)
+#endif
+        /// The mapping's first bytes. The write cursor has a cache line of its own, since every producer writes it.
+        struct alignas(64) StreamHeader
+        {
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::uint32_t slot_count;
+            std::uint32_t name_count;
+            /// Profilers publishing now: start_stream() adds one, stop_stream() takes it back.
+            std::uint32_t producers;
+            /// QPC ticks per second; every start_ticks in the ring is on the QPC timeline.
+            std::int64_t qpc_frequency;
+            alignas(64) std::uint64_t write_cursor;
+        };
+
+        /// One name table entry. key is the producer's name pointer (0 = free); length is stored last, with release.
+        struct alignas(64) StreamName
+        {
+            std::uint64_t key;
+            /// The text's length plus one once it is written; 0 before.
+            std::uint32_t length;
+            char text[STREAM_NAME_BYTES];
+        };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+        /// One sample slot; see the file comment for what sequence holds.
+        struct StreamSlot
+        {
+            std::uint64_t sequence;
+            std::uint32_t name;
+            std::uint32_t thread_id;
+            std::int64_t start_ticks;
+            std::uint32_t duration_us;
+            std::uint32_t frame;
+        };
+
+        static_assert(sizeof(StreamHeader) == 128 && sizeof(StreamName) == 64 && sizeof(StreamSlot) == 32,
+                      "the stream layout is shared with other processes and must not change without STREAM_VERSION");
+        static_assert((STREAM_SLOT_COUNT & (STREAM_SLOT_COUNT - 1)) == 0, "slot count must be a power of 2");
+
+        /// Byte offset of the name table in the mapping.
+        inline constexpr std::size_t STREAM_NAMES_OFFSET = sizeof(StreamHeader);
+        /// Byte offset of the sample ring in the mapping.
+        inline constexpr std::size_t STREAM_SLOTS_OFFSET = STREAM_NAMES_OFFSET + STREAM_NAME_COUNT * sizeof(StreamName);
+        /// Size of the whole mapping.
+        inline constexpr std::size_t STREAM_BYTES = STREAM_SLOTS_OFFSET + STREAM_SLOT_COUNT * sizeof(StreamSlot);
+
+        /// Name of the stream mapping of process @p process_id, in the session's Local\ namespace.
+        [[nodiscard]] inline std::wstring mapping_name(std::uint32_t process_id)
+        {
+            return L"Local\\DetourModKit.ProfileStream.v" + std::to_wstring(STREAM_VERSION) + L"." +
+                   std::to_wstring(process_id);
+        }
+
+        /// One sample read from the stream.
+        struct StreamSample
+        {
+            /// Index for StreamReader::name(), or STREAM_NO_NAME.
+            std::uint32_t name{STREAM_NO_NAME};
+            std::uint32_t thread_id{0};
+            /// QPC tick count at scope entry.
+            std::int64_t start_ticks{0};
+            std::uint32_t duration_us{0};
+            /// Profiler::frame_index() when the sample was recorded.
+            std::uint32_t frame{0};
+        };
+
+        /**
+         * @class StreamReader
+         * @brief A viewer's read-only view of one process's stream, with its own cursor; move-only, unmapped on
+         *        destruction.
+         * @details The reader never writes the mapping, so it cannot slow or corrupt the producers; a reader that
+         *          falls more than STREAM_SLOT_COUNT samples behind loses the oldest of them and counts them in
+         *          dropped().
+         */
+        class StreamReader
+        {
+        public:
+            /**
+             * @brief Opens the stream of process @p process_id, positioned at its oldest sample still in the ring.
+             * @return The reader, Error{SystemCallFailed} (detail = GetLastError()) when the process publishes no
+             *         stream or it cannot be mapped, or Error{MissingHeader} when the mapping holds no stream of this
+             *         version.
+             */
+            [[nodiscard]] static Result<StreamReader> open(std::uint32_t process_id) noexcept;
+
+            StreamReader(StreamReader &&other) noexcept;
+            StreamReader &operator=(StreamReader &&other) noexcept;
+            StreamReader(const StreamReader &) = delete;
+            StreamReader &operator=(const StreamReader &) = delete;
+            ~StreamReader() noexcept;
+
+            /**
+             * @brief Appends the samples published since the last poll to @p out, oldest first.
+             * @param max_samples Most samples to take this call; the rest wait for the next.
+             * @return The number appended. Stops early at a position a producer has taken but not yet filled.
+             */
+            std::size_t poll(std::vector<StreamSample> &out, std::size_t max_samples = SIZE_MAX);
+
+            /// The text of name @p index, or an empty view while it is being written or for STREAM_NO_NAME.
+            [[nodiscard]] std::string_view name(std::uint32_t index) const noexcept;
+
+            [[nodiscard]] std::int64_t qpc_frequency() const noexcept;
+
+            /// Whether any profiler is publishing into the stream now.
+            [[nodiscard]] bool producer_live() const noexcept;
+
+            /// Samples lost since open(): overwritten before this reader got to them.
+            [[nodiscard]] std::uint64_t dropped() const noexcept { return m_dropped; }
+
+        private:
+            StreamReader(void *mapping, void *view) noexcept;
+            void release() noexcept;
+
+            void *m_mapping = nullptr;
+            void *m_view = nullptr;
+            std::uint64_t m_cursor = 0;
+            std::uint64_t m_dropped = 0;
+        };
+    } // namespace profile_stream
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_PROFILE_STREAM_HPP
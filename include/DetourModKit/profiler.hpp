@@ -6,16 +6,17 @@
  * @brief Opt-in profiling instrumentation for measuring hook and subsystem timing.
  *
  * @details Provides zero-overhead profiling when disabled at compile time. When enabled via DMK_ENABLE_PROFILING,
- *          records scoped timing samples into a lock-free ring buffer and exports to Chrome Tracing JSON format
- *          (viewable in chrome://tracing or https://ui.perfetto.dev).
+ *          records scoped timing samples, counter values and flow arrows into lock-free per-thread ring buffers and
+ *          exports to Chrome Tracing JSON format (viewable in chrome://tracing or https://ui.perfetto.dev).
  *
  *          **Compile-time control:**
  *          - Define DMK_ENABLE_PROFILING before including this header, or
  *          - Pass -DDMK_ENABLE_PROFILING=ON to CMake.
  *
  *          **Performance characteristics (when enabled):**
- *          - ~50 ns per scoped measurement (two QPC calls + one atomic store)
- *          - Fixed-size ring buffer (no heap allocations on the hot path)
+ *          - ~50 ns per scoped measurement (two QPC calls + a few stores into the calling thread's ring), less with
+ *            Profiler::set_clock(ProfilerClock::Tsc) on a CPU with an invariant TSC
+ *          - Fixed-size rings (one heap allocation per thread, on its first sample)
  *          - Lock-free recording from multiple threads
  *
  *          **Usage:**
@@ -30,12 +31,18 @@
  *          @endcode
  */
 
+#include "DetourModKit/error.hpp"
+
+#include <array>
 #include <atomic>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #ifdef DMK_ENABLE_PROFILING
 
@@ -65,39 +72,83 @@
         __func__                                                                                                       \
     }
 
+// Frame boundary: closes the frame opened by the previous marker and opens the next. Place it once per frame on the
+// thread that drives the frame (e.g. at the top of a Present hook). See Profiler::mark_frame().
+#define DMK_PROFILE_FRAME() ::DetourModKit::Profiler::get_instance().mark_frame()
+
+// Counter track: the value of `name` (same lifetime rule as DMK_PROFILE_SCOPE) is `value` from now on. See
+// Profiler::record_counter().
+#define DMK_PROFILE_COUNTER(name, value)                                                                               \
+    ::DetourModKit::Profiler::get_instance().record_counter(name, static_cast<int64_t>(value))
+
+// Flow arrow from the scope enclosing the begin to the scope enclosing the end with the same name and id, typically on
+// another thread. Take the id from Profiler::new_flow_id() and carry it with the work.
+#define DMK_PROFILE_FLOW_BEGIN(name, id) ::DetourModKit::Profiler::get_instance().record_flow_begin(name, id)
+#define DMK_PROFILE_FLOW_END(name, id) ::DetourModKit::Profiler::get_instance().record_flow_end(name, id)
+
 #else
 
 #define DMK_PROFILE_SCOPE(name) ((void)0)
 #define DMK_PROFILE_FUNCTION() ((void)0)
+#define DMK_PROFILE_FRAME() ((void)0)
+#define DMK_PROFILE_COUNTER(name, value) ((void)0)
+#define DMK_PROFILE_FLOW_BEGIN(name, id) ((void)0)
+#define DMK_PROFILE_FLOW_END(name, id) ((void)0)
 
 #endif // DMK_ENABLE_PROFILING
 
 namespace DetourModKit
 {
+    /// What a ProfileSample records.
+    enum class ProfileSampleKind : uint8_t
+    {
+        /// A timed scope (record()).
+        Duration,
+        /// A counter's value at one instant (record_counter()).
+        Counter,
+        /// The start of a flow arrow (record_flow_begin()).
+        FlowBegin,
+        /// The end of a flow arrow (record_flow_end()).
+        FlowEnd
+    };
+
     /**
-     * @brief A single timing sample recorded by the profiler.
-     * @details The sequence field uses odd/even protocol to detect in-flight
-     *          writes: record() stores an odd sequence before writing fields
-     *          and an even sequence after. Readers skip samples with odd sequence values (torn/in-progress writes).
+     * @brief One ring slot of the profiler: a timed scope, a counter value or one end of a flow, in 16 bytes.
+     * @details The name and the thread are stored as small ids the profiler interns at first use, and the start ticks
+     *          and frame as signed offsets from the base of the 256-slot block the slot lies in, which the block's
+     *          first sample sets. Exports expand all of them back. A sample whose offsets or value do not fit, and
+     *          every sample of the shared ring, takes one further slot, its extension, which holds the start ticks and
+     *          frame in full; the value then spans the head's start_delta and value fields.
+     *
+     *          The sequence field uses odd/even protocol to detect in-flight writes: record() stores an odd sequence
+     *          before writing fields and an even sequence after. Readers skip samples with odd sequence values
+     *          (torn/in-progress writes).
      */
     struct ProfileSample
     {
         /// Odd = write in progress, even = committed.
-        std::atomic<uint32_t> sequence{0};
+        std::atomic<uint16_t> sequence{0};
         /**
-         * @brief Non-owning pointer to the sample name.
-         * @note Caller must ensure the pointed-to string outlives the process (e.g. a string literal or a
+         * @brief 1-based id of the interned name; 0 for no name, which exports skip. An extension: frame bits 0-15.
+         * @note The name pointer the id stands for must outlive the process (e.g. a string literal or a
          *       namespace-scope `static constexpr char` array). The ScopedProfile
          *       array-reference constructor only rejects pointer decay;
          *       it does NOT verify static-storage.
          */
-        const char *name{nullptr};
-        /// QPC tick count at scope entry.
-        int64_t start_ticks{0};
-        /// Duration in microseconds (max ~71 minutes).
-        uint32_t duration_us{0};
-        /// Win32 thread ID of the recording thread.
-        uint32_t thread_id{0};
+        uint16_t name{0};
+        /// Index of the recording thread's Win32 ID in the profiler's thread registry. An extension: frame bits 16-31.
+        uint16_t thread{0};
+        /// The ProfileSampleKind, the wide and extension flags, and the ring lap the slot was written in, mod 16.
+        uint8_t tag{0};
+        /// Profiler::frame_index() when the sample was recorded, less the block base's frame.
+        int8_t frame_delta{0};
+        /// Start ticks less the block base's. Wide: the value's high 32 bits. An extension: the start's low 32 bits.
+        int32_t start_delta{0};
+        /**
+         * @brief Duration: microseconds (max ~71 minutes). Counter: the value. Flow: the flow id, as a bit pattern.
+         * @details Wide: the value's low 32 bits. An extension: the start's high 32 bits.
+         */
+        uint32_t value{0};
 
         ProfileSample() noexcept = default;
         ProfileSample(const ProfileSample &) = delete;
@@ -106,18 +157,103 @@ namespace DetourModKit
         ProfileSample &operator=(ProfileSample &&) = delete;
     };
 
+    /// The clock a Profiler reads for ScopedProfile timestamps.
+    enum class ProfilerClock : uint8_t
+    {
+        /// QueryPerformanceCounter (the default).
+        Qpc,
+        /// The CPU timestamp counter through rdtsc, calibrated against QPC; only used when the TSC is invariant.
+        Tsc
+    };
+
+    /**
+     * @brief Running totals of one scope name, kept by the profiler as samples are recorded.
+     * @details Unlike the rings these never wrap: every sample since the last reset() is counted. Durations go into
+     *          a log-linear histogram (HdrHistogram-style): values below 8 us get a bucket each, and every power of two
+     *          above that is split into 8 equal buckets, so a percentile read from it is within 12.5% of the exact
+     *          value across the whole uint32 microsecond range.
+     */
+    struct ScopeStats
+    {
+        /// Sub-buckets per power of two; also the count of exact buckets at the bottom.
+        static constexpr size_t SUB_BUCKETS{8};
+        /// Buckets covering every uint32_t duration.
+        static constexpr size_t HISTOGRAM_BUCKETS{SUB_BUCKETS + (32 - 3) * SUB_BUCKETS};
+
+        /// The scope name as recorded (see Profiler::record() for its lifetime).
+        const char *name{nullptr};
+        uint64_t count{0};
+        /// Calls left untimed by the scope's sample rate (Profiler::set_sample_rate()); not part of count.
+        uint64_t skipped{0};
+        uint64_t total_us{0};
+        uint32_t min_us{0};
+        uint32_t max_us{0};
+        std::array<uint64_t, HISTOGRAM_BUCKETS> histogram{};
+
+        /// Histogram bucket of a duration.
+        [[nodiscard]] static constexpr size_t bucket_of(uint32_t duration_us) noexcept
+        {
+            if (duration_us < SUB_BUCKETS)
+            {
+                return duration_us;
+            }
+            // The top bit is at least bit 3 here, so the shift keeps the three bits below it as the sub-bucket.
+            const auto shift = static_cast<unsigned>(std::bit_width(duration_us)) - 4;
+            return SUB_BUCKETS + shift * SUB_BUCKETS + ((duration_us >> shift) & (SUB_BUCKETS - 1));
+        }
+
+        /// Largest duration that lands in bucket @p index (below HISTOGRAM_BUCKETS).
+        [[nodiscard]] static constexpr uint32_t bucket_upper_bound(size_t index) noexcept
+        {
+            if (index < SUB_BUCKETS)
+            {
+                return static_cast<uint32_t>(index);
+            }
+            const size_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+            const uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+            return static_cast<uint32_t>(lower + ((uint64_t{1} << shift) - 1));
+        }
+
+        /// Mean duration, or 0 with no samples.
+        [[nodiscard]] double mean_us() const noexcept
+        {
+            return count == 0 ? 0.0 : static_cast<double>(total_us) / static_cast<double>(count);
+        }
+
+        /**
+         * @brief Duration below which the fraction @p quantile of samples fall, from the histogram.
+         * @param quantile 0.0 to 1.0; 0.99 is the p99.
+         * @return The upper bound of the bucket holding that sample, capped at max_us; 0 with no samples.
+         */
+        [[nodiscard]] uint32_t percentile_us(double quantile) const noexcept;
+    };
+
     /**
      * @brief Lock-free ring buffer profiler with Chrome Tracing JSON export.
      *
-     * @details Uses a fixed-capacity power-of-2 ring buffer. Recording is lock-free via a single atomic fetch_add on
-     *          the write position. When the buffer wraps, oldest samples are silently overwritten (no allocation, no
-     *          lock).
+     * @details Each recording thread gets its own fixed-capacity power-of-2 ring, built the first time that thread
+     *          records and kept for the life of the process. A thread is the only writer of its ring, so recording
+     *          costs a few plain loads and stores and no atomic read-modify-write on memory any other thread writes.
+     *          When a ring wraps, that thread's oldest samples are silently overwritten (no allocation, no lock).
+     *
+     *          Rings are found through a fixed table of MAX_THREAD_RINGS entries keyed by thread id. A thread arriving
+     *          once the table is full, or whose ring could not be allocated, records into one shared ring through the
+     *          multi-producer path (a fetch_add on its write position). A thread that exits leaves its ring behind; a
+     *          later thread the OS gives the same id adopts it.
+     *
+     *          Alongside its samples each ring keeps running ScopeStats per scope name, which stats() merges: counts,
+     *          totals and a duration histogram that survive the ring wrapping.
+     *
+     *          Two settings keep a hot scope from flooding the rings. set_sample_rate() times only one call in N of a
+     *          scope, per thread; the others skip the clock reads and the ring altogether. A frame budget
+     *          (set_frame_budget_us(), with DMK_PROFILE_FRAME() marking the frames) keeps the samples of frames that
+     *          ran over it and drops the rest, so the ring holds the slow frames at full detail.
      *
      *          The profiler is a singleton. All public methods are safe to call from multiple threads. Export methods
-     *          take a consistent snapshot by reading the current write position and walking backwards.
+     *          walk every ring, oldest sample first within each, and group the output by ring.
      *
      * **Thread safety:**
-     * - `record()`: lock-free (atomic fetch_add + sequence counter)
+     * - `record()`: lock-free (per-thread ring, or fetch_add on the shared ring, plus the sample sequence counter)
      * - `reset()`: safe when no concurrent `record()` calls are in flight
      * - `export_chrome_json()` / `export_to_file()`: safe to call concurrently
      *   with `record()`. Uses odd/even sequence protocol to skip in-flight writes, preventing torn reads in the
@@ -126,8 +262,41 @@ namespace DetourModKit
     class Profiler
     {
     public:
-        /// Default ring buffer capacity (must be a power of 2).
-        static constexpr size_t DEFAULT_CAPACITY{65536};
+        /// Capacity of each ring in 16-byte slots, per recording thread (must be a power of 2): 2 MiB per ring.
+        static constexpr size_t DEFAULT_CAPACITY{131072};
+
+        /// Slots that share one start-ticks and frame base (must be a power of 2 dividing DEFAULT_CAPACITY).
+        static constexpr size_t SAMPLE_BLOCK_SIZE{256};
+
+        /// Distinct name pointers the rings can hold samples of; samples of further names are left out of exports.
+        static constexpr size_t MAX_SAMPLE_NAMES{4096};
+
+        /// Distinct thread IDs the rings store as-is; samples of further threads export thread ID 0.
+        static constexpr size_t MAX_SAMPLE_THREADS{1024};
+
+        /// Most threads given a ring of their own; later threads share one ring.
+        static constexpr size_t MAX_THREAD_RINGS{32};
+
+        /// Bytes export_to_file() and export_binary() gather before each write to the file.
+        static constexpr size_t EXPORT_CHUNK_SIZE{64 * 1024};
+
+        /// Distinct scope names each ring keeps ScopeStats for; samples of further names are only stored in the ring.
+        static constexpr size_t MAX_SCOPES_PER_RING{64};
+
+        /// How long set_clock(ProfilerClock::Tsc) measures the TSC against QPC.
+        static constexpr int64_t TSC_CALIBRATION_MS{20};
+
+        /// Distinct scope names set_sample_rate() can hold a rate for.
+        static constexpr size_t MAX_SAMPLE_RATES{32};
+
+        /// Closed frames whose budget verdict is remembered (must be a power of 2); older frames count as under it.
+        static constexpr size_t FRAME_HISTORY{4096};
+
+        /// begin_scope()'s result for a call its scope's sample rate leaves untimed.
+        static constexpr int64_t SCOPE_SKIPPED{INT64_MIN};
+
+        /// Name of the sample mark_frame() records for each closed frame.
+        static constexpr char FRAME_SAMPLE_NAME[] = "frame";
 
         Profiler(const Profiler &) = delete;
         Profiler &operator=(const Profiler &) = delete;
@@ -146,15 +315,42 @@ namespace DetourModKit
          *             static-storage at compile time; array-reference binding accepts any array, so callers remain
          *             responsible for lifetime. Safe sources: string literals, `static constexpr char` arrays at
          *             namespace scope, and `__func__` (see [dcl.fct.def.general]/8).
-         * @param start_ticks QPC tick count at scope entry.
-         * @param end_ticks QPC tick count at scope exit.
-         * @param thread_id Win32 thread ID of the recording thread.
-         * @note Lock-free. Safe to call from any thread at any time.
+         * @param start_ticks Tick count of the active clock (now_ticks(); QPC by default) at scope entry.
+         * @param end_ticks Tick count of the active clock at scope exit.
+         * @param thread_id Win32 thread ID stored in the sample. The ring is chosen by the calling thread, not by
+         *                  this value.
+         * @note Lock-free. Safe to call from any thread at any time. A thread's first call allocates its ring.
          */
         void record(const char *name, int64_t start_ticks, int64_t end_ticks, uint32_t thread_id) noexcept;
 
         /**
-         * @brief Resets the profiler, discarding all recorded samples.
+         * @brief Records the value of the counter track @p name now, on the calling thread.
+         * @details Exported as a Chrome "C" event: the track holds @p value until the next sample of the same name.
+         *          Counters take a ring slot but stay out of stats() and the live stream, which carry durations.
+         * @param name Same lifetime rule as record(); nullptr records nothing.
+         * @note Lock-free; costs one clock read and one ring slot.
+         */
+        void record_counter(const char *name, int64_t value) noexcept;
+
+        /// A process-unique id for a flow (never 0), to pass to record_flow_begin() and later record_flow_end().
+        [[nodiscard]] uint64_t new_flow_id() noexcept;
+
+        /**
+         * @brief Records the start of the flow @p flow_id on the calling thread.
+         * @details Exported as a Chrome "s" event. The viewer draws an arrow from the scope open around the begin to
+         *          the scope open around the matching record_flow_end() (same name, same id), so both should sit
+         *          inside a DMK_PROFILE_SCOPE.
+         * @param name Same lifetime rule as record(); nullptr records nothing.
+         * @note Lock-free; costs one clock read and one ring slot.
+         */
+        void record_flow_begin(const char *name, uint64_t flow_id) noexcept;
+
+        /// Records the end of the flow @p flow_id on the calling thread; exported as a Chrome "f" event.
+        void record_flow_end(const char *name, uint64_t flow_id) noexcept;
+
+        /**
+         * @brief Resets the profiler, discarding all recorded samples and scope statistics.
+         * @details Threads keep their rings; only the samples and totals are cleared.
          * @note Not safe to call while other threads are calling record(). Intended for use between profiling sessions.
          */
         void reset() noexcept;
@@ -162,48 +358,319 @@ namespace DetourModKit
         /**
          * @brief Exports recorded samples as a Chrome Tracing JSON string.
          * @details Output conforms to the Chrome Trace Event Format (array form). Open the result in chrome://tracing
-         *          or https://ui.perfetto.dev.
+         *          or https://ui.perfetto.dev. The string holds every sample at once, about 120 bytes each; prefer
+         *          export_to_file() or export_binary() for a mid-session export.
          * @return JSON string containing all recorded samples.
          */
         [[nodiscard]] std::string export_chrome_json() const;
 
         /**
          * @brief Exports recorded samples to a JSON file on disk.
+         * @details Streams: samples are formatted into one EXPORT_CHUNK_SIZE buffer that is written out each time it
+         *          fills, so memory stays bounded however many samples the rings hold. The file's content is what
+         *          export_chrome_json() would have returned.
          * @param path File path to write (created or overwritten).
          * @return true on success, false on I/O failure.
          */
         [[nodiscard]] bool export_to_file(std::string_view path) const;
 
-        /// Returns the number of samples recorded (may exceed capacity due to wrapping).
+        /**
+         * @brief Exports recorded samples to a compact binary dump (see profile_dump.hpp).
+         * @details Streams through the same bounded buffer as export_to_file(), and copies each sample rather than
+         *          formatting it, so it is the cheaper export to run mid-session. Convert the dump to Chrome JSON with
+         *          profile_dump::format_chrome_json() or the DetourModKit_profile_dump_convert tool.
+         * @param path File path to write (created or overwritten).
+         * @return true on success, false on I/O failure.
+         */
+        [[nodiscard]] bool export_binary(std::string_view path) const;
+
+        /// Returns the number of samples recorded across all rings (may exceed capacity due to wrapping).
         [[nodiscard]] size_t total_samples_recorded() const noexcept;
 
-        /// Returns the number of valid samples available for export (min of recorded, capacity).
+        /**
+         * @brief Returns the number of valid samples available for export (the sum over rings of min(recorded,
+         *        capacity)).
+         * @details A ring that has wrapped with extended samples in it holds fewer than capacity; its share is then
+         *          estimated from its mix of extended and plain samples.
+         */
         [[nodiscard]] size_t available_samples() const noexcept;
 
-        /// Returns the ring buffer capacity.
+        /// Returns the capacity of one ring buffer, in slots (samples without an extension).
         [[nodiscard]] size_t capacity() const noexcept;
 
-        /// Returns the QPC frequency (ticks per second) used for timing.
+        /// Returns the QPC frequency (ticks per second); exported timestamps are on the QPC timeline in either clock.
         [[nodiscard]] int64_t qpc_frequency() const noexcept;
 
+        /**
+         * @brief Selects the clock ScopedProfile reads, and discards the samples recorded under the previous one.
+         * @details The TSC costs a few nanoseconds to read where QPC can cost tens, which matters for a scope around a
+         *          function called millions of times per second. It is only trusted when CPUID reports it invariant
+         *          (constant rate across power states and cores); otherwise the profiler stays on QPC. Switching to the
+         *          TSC calibrates its frequency against QPC, which blocks the caller for about
+         *          TSC_CALIBRATION_MS. Either way export keeps converting to microseconds on the QPC timeline.
+         * @note Calls reset(), so it has reset()'s contract: no record() or live ScopedProfile may be in flight.
+         * @return The clock now in use: ProfilerClock::Qpc when the TSC was asked for but is not invariant.
+         */
+        ProfilerClock set_clock(ProfilerClock clock) noexcept;
+
+        /// The clock record()'s tick arguments are read from.
+        [[nodiscard]] ProfilerClock clock() const noexcept;
+
+        /// Ticks per second of the active clock.
+        [[nodiscard]] int64_t tick_frequency() const noexcept;
+
+        /// The active clock's current tick count, the value ScopedProfile passes to record().
+        [[nodiscard]] int64_t now_ticks() const noexcept;
+
+        /// Whether this CPU's timestamp counter is invariant (CPUID 0x80000007, EDX bit 8).
+        [[nodiscard]] static bool tsc_is_invariant() noexcept;
+
+        /**
+         * @brief Running totals of every scope recorded since the last reset(), sorted by name.
+         * @details Merges each thread's totals; two name pointers with the same text are one scope. Safe to call while
+         *          other threads record: each field is exact as read, but a scope's fields can be a sample or two
+         *          apart from each other while it is being recorded.
+         */
+        [[nodiscard]] std::vector<ScopeStats> stats() const;
+
+        /// The running totals of one scope name, or nullopt when it has not been recorded since the last reset().
+        [[nodiscard]] std::optional<ScopeStats> scope_stats(std::string_view name) const;
+
+        /**
+         * @brief Times one call in @p every_n of the scopes named @p name; the others are counted in
+         *        ScopeStats::skipped and leave no sample.
+         * @details Each thread counts its own calls, and times the first of every @p every_n, so a scope around a
+         *          per-particle hook costs one table probe on most calls instead of two clock reads and a ring slot.
+         *          The rate applies to every scope whose name has this text. Takes effect on each thread's next call
+         *          of the scope, and may be changed at any time.
+         * @param every_n 0 or 1 times every call again and frees the name's entry.
+         * @return false when MAX_SAMPLE_RATES other names already have a rate.
+         */
+        bool set_sample_rate(std::string_view name, uint32_t every_n) noexcept;
+
+        /// The rate set for @p name, or 1 when none is.
+        [[nodiscard]] uint32_t sample_rate(std::string_view name) const noexcept;
+
+        /**
+         * @brief Starts timing one call of the scope @p name: the active clock's tick count, or SCOPE_SKIPPED when the
+         *        scope's sample rate leaves this call untimed.
+         * @details What ScopedProfile calls on entry; pass the result, unless it is SCOPE_SKIPPED, to record() on exit.
+         *          With no sample rate set it is now_ticks() behind one load.
+         */
+        [[nodiscard]] int64_t begin_scope(const char *name) noexcept;
+
+        /**
+         * @brief Closes the current frame and opens the next; what DMK_PROFILE_FRAME() calls.
+         * @details Every sample is tagged with the frame open when it was recorded (frame_index()); samples recorded
+         *          before the first marker are frame 0. A closed frame is recorded as a FRAME_SAMPLE_NAME sample on the
+         *          calling thread, so the trace shows frame boundaries and stats() has the frame times. With a frame
+         *          budget set, the frame is over budget when it ran longer than the budget; the samples of a frame
+         *          that was not are dropped from every export, and each thread's ring takes back their slots the
+         *          next time that thread records.
+         * @note Call from one thread: the frames are that thread's. Lock-free.
+         */
+        void mark_frame() noexcept;
+
+        /**
+         * @brief Sets the frame budget and starts a new session, discarding every sample.
+         * @param budget_us 0 (the default) keeps every frame.
+         * @note Calls reset(), so it has reset()'s contract: no record() or live ScopedProfile may be in flight.
+         */
+        void set_frame_budget_us(uint32_t budget_us) noexcept;
+
+        [[nodiscard]] uint32_t frame_budget_us() const noexcept;
+
+        /// The frame now open: the number of mark_frame() calls since the last reset().
+        [[nodiscard]] uint32_t frame_index() const noexcept;
+
+        /// Frames that ran over the budget since the last reset().
+        [[nodiscard]] uint64_t frames_over_budget() const noexcept;
+
+        /**
+         * @brief Starts publishing every sample recorded from now on into this process's live stream, which a viewer
+         *        follows with profile_stream::StreamReader (see profile_stream.hpp).
+         * @details The stream is a named shared-memory ring beside the profiler's own rings, not instead of them:
+         *          exports and stats() are unchanged. Publishing a sample adds a fetch_add on the stream's cursor, a
+         *          probe of its name table and a 32-byte slot write to record(); timestamps go out on the QPC timeline
+         *          in either clock. A frame budget does not apply to the stream: it carries every frame, and each
+         *          sample's frame number, for the viewer to judge. Calling it while streaming does nothing.
+         *
+         *          The mapping is created on the first call and stays mapped until the process exits, so
+         *          stop_stream() never pulls it from under a record() in flight and viewers keep what was published.
+         * @return Nothing on success, Error{SystemCallFailed} (detail = GetLastError()) when the mapping cannot be
+         *         created or mapped, or Error{InvalidRange} when a mapping of that name holds something else.
+         */
+        [[nodiscard]] Result<void> start_stream() noexcept;
+
+        /// Stops publishing into the live stream; samples already published stay readable.
+        void stop_stream() noexcept;
+
+        [[nodiscard]] bool is_streaming() const noexcept;
+
     private:
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: SampleRing is intentionally padded to a full cache line by alignas(64) so two threads' write positions never
+// share one.
+#pragma warning(disable : 4324)
+#endif
+        /// The running totals behind one ScopeStats; written only by the ring's writers.
+        struct ScopeSlot
+        {
+            std::atomic<const char *> name{nullptr};
+            std::atomic<uint64_t> count{0};
+            std::atomic<uint64_t> total_us{0};
+            // Sampling: every call begin_scope() saw, the ones it left untimed, and the rate it tests them against,
+            // copied from the rate table when the table's generation moves past rate_generation.
+            std::atomic<uint64_t> calls{0};
+            std::atomic<uint64_t> skipped{0};
+            std::atomic<uint32_t> every{1};
+            std::atomic<uint32_t> rate_generation{0};
+            std::atomic<uint32_t> min_us{UINT32_MAX};
+            std::atomic<uint32_t> max_us{0};
+            std::array<std::atomic<uint64_t>, ScopeStats::HISTOGRAM_BUCKETS> histogram{};
+        };
+
+        /**
+         * @brief The start ticks and frame one block's samples are stored relative to, for one lap of the ring.
+         * @details Written by the writer of the block's first slot in that lap, under its own seqlock: sequence is
+         *          2 * lap + 1 while it is written and 2 * lap + 2 once published, so a reader knows which lap it
+         *          holds; 0 holds none.
+         */
+        struct SampleBlockBase
+        {
+            std::atomic<uint64_t> sequence{0};
+            std::atomic<int64_t> ticks{0};
+            std::atomic<uint32_t> frame{0};
+        };
+
+        /// One ring of DEFAULT_CAPACITY slots, the slots and samples ever written into it, and its scope totals.
+        struct alignas(64) SampleRing
+        {
+            SampleRing();
+
+            std::atomic<size_t> write_pos{0};
+            // Samples, which exceed the slots by each sample's extension.
+            std::atomic<size_t> recorded{0};
+            std::unique_ptr<ProfileSample[]> samples;
+            // Two bases per block, for alternate laps, so the lap still being overwritten keeps its own.
+            std::unique_ptr<SampleBlockBase[]> bases;
+            std::unique_ptr<ScopeSlot[]> scopes;
+            // The frame this ring's writer last recorded in and the write position and sample count it started at,
+            // which a dropped frame rewinds to. Touched only by the writer (thread rings) and reset().
+            uint32_t frame{0};
+            size_t frame_start{0};
+            size_t frame_start_recorded{0};
+        };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+        struct ThreadRingEntry
+        {
+            std::atomic<uint32_t> owner{0};
+            std::atomic<SampleRing *> ring{nullptr};
+        };
+
+        /// One set_sample_rate() entry, keyed by a hash of the name text (0 marks a free entry).
+        struct SampleRateEntry
+        {
+            std::atomic<size_t> hash{0};
+            std::atomic<uint32_t> every{1};
+        };
+
         Profiler();
-        ~Profiler() noexcept = default;
-
-        // m_write_pos first to avoid 40 bytes of padding (alignas(64) requirement). This placement ensures cache-line
-        // alignment for the lock-free ring buffer.
-        alignas(64) std::atomic<size_t> m_write_pos{0};
-        std::unique_ptr<ProfileSample[]> m_buffer;
-        size_t m_capacity;
-        size_t m_mask; // m_capacity - 1 for power-of-2 index wrapping
+        ~Profiler() noexcept;
+
+        /// The calling thread's own ring, built on first use; nullptr when it must use the shared ring.
+        [[nodiscard]] SampleRing *ring_for_current_thread() noexcept;
+
+        /**
+         * @brief Writes one sample into the calling thread's ring, or the shared ring, under the seqlock.
+         * @return The ring written.
+         */
+        SampleRing &write_sample(ProfileSampleKind kind, uint32_t frame, const char *name, int64_t start_ticks,
+                                 int64_t value, uint32_t thread_id) noexcept;
+
+        /// Calls @p visit with every ring that exists: the shared ring first, then each thread's.
+        template <typename Visit> void for_each_ring(Visit &&visit) const;
+
+        /// Calls @p visit with every committed sample of every ring, in export order.
+        template <typename Visit> void for_each_sample(Visit &&visit) const;
+
+        /// Calls @p visit with every committed sample of @p ring, oldest first, with its name and thread expanded.
+        template <typename Visit> void visit_ring_samples(const SampleRing &ring, Visit &visit) const;
+
+        /// The 1-based id of @p name, interning it on first sight; 0 for nullptr or a full table.
+        [[nodiscard]] uint16_t intern_name(const char *name) noexcept;
+
+        /// The registry index of @p thread_id, registering it on first sight; UINT16_MAX for a full registry.
+        [[nodiscard]] uint16_t intern_thread(uint32_t thread_id) noexcept;
+
+        /**
+         * @brief Adds one sample to @p ring's totals for @p name.
+         * @param shared The ring has many writers (the shared ring), so every update must be a read-modify-write.
+         */
+        static void accumulate(SampleRing &ring, const char *name, uint32_t duration_us, bool shared) noexcept;
+
+        /**
+         * @brief @p ring's totals for @p name, claiming a free slot for it; nullptr when every slot holds another name.
+         * @param shared The ring has many writers, so a free slot is claimed by compare-exchange.
+         */
+        [[nodiscard]] static ScopeSlot *find_scope(SampleRing &ring, const char *name, bool shared) noexcept;
+
+        /// The rate set for the name text @p name, or 1.
+        [[nodiscard]] uint32_t lookup_sample_rate(std::string_view name) const noexcept;
+
+        /// Microseconds between two ticks of the active clock, clamped to [0, UINT32_MAX].
+        [[nodiscard]] uint32_t elapsed_us(int64_t start_ticks, int64_t end_ticks) const noexcept;
+
+        /// Whether the samples of @p frame are exported: always without a budget, else unless it closed under it.
+        [[nodiscard]] bool frame_kept(uint32_t frame) const noexcept;
+
+        /// @p ticks of the active clock as a QPC tick count, the timeline every export writes.
+        [[nodiscard]] int64_t to_qpc_ticks(int64_t ticks) const noexcept;
+
+        // The shared ring first: it is alignas(64), so leading with it avoids padding ahead of it.
+        SampleRing m_shared;
+        std::array<ThreadRingEntry, MAX_THREAD_RINGS> m_thread_rings{};
         int64_t m_qpc_frequency{0};
+        // The active clock. Written only by the constructor and set_clock(), under reset()'s no-recording contract.
+        std::atomic<bool> m_use_tsc{false};
+        int64_t m_tick_frequency{0};
+        // A simultaneous TSC and QPC reading taken at calibration, which maps one timeline onto the other.
+        int64_t m_tsc_origin{0};
+        int64_t m_qpc_origin{0};
+        std::array<SampleRateEntry, MAX_SAMPLE_RATES> m_sample_rates{};
+        // Bumped by every set_sample_rate(), so each scope slot knows to re-read its rate.
+        std::atomic<uint32_t> m_rate_generation{0};
+        // Set by the first set_sample_rate(); until then begin_scope() does not look at the scope slots.
+        std::atomic<bool> m_sampling_active{false};
+        std::atomic<uint32_t> m_frame_index{0};
+        // Active-clock ticks at which the open frame started; INT64_MIN before the first marker.
+        std::atomic<int64_t> m_frame_start{INT64_MIN};
+        // Written only by set_frame_budget_us(), under reset()'s no-recording contract.
+        std::atomic<uint32_t> m_frame_budget_us{0};
+        std::atomic<uint64_t> m_frames_over_budget{0};
+        // Per closed frame, at frame % FRAME_HISTORY: a valid bit, the frame number, and whether it was over budget.
+        std::array<std::atomic<uint64_t>, FRAME_HISTORY> m_frame_verdicts{};
+        // The live stream's mapping, kept from the first start_stream() to process exit, and the view record()
+        // publishes into: the mapped view while streaming, nullptr otherwise.
+        std::atomic<void *> m_stream_mapping{nullptr};
+        std::atomic<std::byte *> m_stream_view{nullptr};
+        std::atomic<std::byte *> m_stream{nullptr};
+        std::atomic<uint64_t> m_next_flow_id{1};
+        // The interned names (id - 1 indexes the table) and thread IDs (stored + 1, so 0 marks a free entry). Both
+        // outlive reset(): a sample's id means the same pointer for the process lifetime.
+        std::array<std::atomic<const char *>, MAX_SAMPLE_NAMES> m_sample_names{};
+        std::array<std::atomic<uint64_t>, MAX_SAMPLE_THREADS> m_sample_threads{};
     };
 
     /**
      * @brief RAII scoped profiler that records timing on destruction.
      *
-     * @details Captures QPC tick count and thread ID in the constructor. On destruction, computes duration and records
-     *          the sample in the global Profiler ring buffer.
+     * @details Captures the profiler clock's tick count and thread ID in the constructor. On destruction, computes
+     *          duration and records the sample in the global Profiler ring buffer.
      *
      *          This class is only active when DMK_ENABLE_PROFILING is defined. Use the DMK_PROFILE_SCOPE() macro
      *          instead of constructing directly.
@@ -223,8 +690,10 @@ namespace DetourModKit
          *        scope exits. This overload does NOT prove static storage; callers must still ensure the bound array
          *        outlives the process. Safe sources: string literals, namespace-scope `static constexpr char` arrays,
          *        and `__func__` (static-storage per [dcl.fct.def.general]/8).
-         * @note Hot-path cost: two pointer-sized stores (name pointer and thread id) plus the QPC read; the
-         *       array-reference overload adds no runtime overhead over a raw `const char *` parameter.
+         * @note Hot-path cost: two pointer-sized stores (name pointer and thread id) plus the clock read; the
+         *       array-reference overload adds no runtime overhead over a raw `const char *` parameter. Once any
+         *       sample rate is set, entry also probes the thread's scope table (Profiler::begin_scope()), and a call
+         *       the rate skips reads no clock and records nothing.
          */
         template <size_t N>
         explicit ScopedProfile(const char (&name)[N]) noexcept
@@ -246,6 +715,7 @@ namespace DetourModKit
         ScopedProfile(const char *name, literal_tag) noexcept;
 
         const char *m_name;
+        /// Profiler::SCOPE_SKIPPED when the scope's sample rate left this call untimed.
         int64_t m_start_ticks;
         uint32_t m_thread_id;
     };
@@ -0,0 +1,80 @@
+#ifndef DETOURMODKIT_REGION_SET_HPP
+#define DETOURMODKIT_REGION_SET_HPP
+
+/**
+ * @file region_set.hpp
+ * @brief RegionSet -- several Regions treated as one scan scope.
+ * @details A Region names one contiguous span, but the code a signature should be found in is often scattered: the
+ *          .text of the host plus one plugin DLL, three JIT arenas, or two sections of one image with .rdata cut out
+ *          between them. Scanning each Region on its own cannot answer "is this match unique across all of them?",
+ *          and scanning a Region that covers the gaps reads memory the caller never meant to search. A RegionSet
+ *          holds the spans sorted and coalesced (overlapping or touching spans merge into one), so scan::scan,
+ *          scan::resolve (through @ref scan::ScanRequest::regions), and anchor::resolve can take the whole set as
+ *          one scope: occurrences count in ascending address order across it, uniqueness is proved across it, and an
+ *          in-scope gate is a membership test against it.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace DetourModKit
+{
+    /**
+     * @class RegionSet
+     * @brief A sorted, coalesced set of disjoint Regions.
+     * @details The invariant -- ascending, non-empty, non-overlapping, non-touching spans -- is what lets a membership
+     *          query binary-search the spans in O(log n) and lets a scan walk them in address order without ever
+     *          double-counting a byte, so the spans are private and only the factory and @ref add build them. Two
+     *          spans that touch are merged, so a match can never straddle a boundary between two of them: a boundary
+     *          always sits next to bytes outside the set.
+     */
+    class RegionSet
+    {
+    public:
+        /// An empty set; every scan over it fails with InvalidRange and contains() is false for every address.
+        RegionSet() noexcept = default;
+
+        /**
+         * @brief Builds a set from @p regions in any order, merging overlapping and touching spans.
+         * @param regions The spans to include. Empty Regions (size 0) are skipped.
+         * @return The set, or Error{InvalidRange} when a Region has a null base and a non-zero size or runs past the
+         *         end of the address space, or Error{OutOfMemory}.
+         */
+        [[nodiscard]] static Result<RegionSet> of(std::span<const Region> regions) noexcept;
+
+        /**
+         * @brief Adds @p region to the set, merging it with every span it overlaps or touches.
+         * @return Success (an empty Region is a no-op), or the same errors as @ref of. On failure the set is unchanged.
+         */
+        [[nodiscard]] Result<void> add(Region region) noexcept;
+
+        /// True when @p address lies inside one of the spans. O(log n).
+        [[nodiscard]] bool contains(Address address) const noexcept;
+
+        /// The span holding @p address, or nullopt when no span does. O(log n).
+        [[nodiscard]] std::optional<Region> range_of(Address address) const noexcept;
+
+        /// The coalesced spans, in ascending address order.
+        [[nodiscard]] std::span<const Region> ranges() const noexcept { return m_ranges; }
+
+        /// True when the set holds no bytes.
+        [[nodiscard]] bool empty() const noexcept { return m_ranges.empty(); }
+
+        /// Total bytes across the spans (gaps excluded).
+        [[nodiscard]] std::size_t byte_size() const noexcept;
+
+        /// The smallest single Region covering every span, gaps included; empty for an empty set.
+        [[nodiscard]] Region bounds() const noexcept;
+
+    private:
+        std::vector<Region> m_ranges;
+    };
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_REGION_SET_HPP
@@ -1,14 +1,19 @@
 #ifndef DETOURMODKIT_RTTI_HPP
 #define DETOURMODKIT_RTTI_HPP
 
+#include "DetourModKit/error.hpp"
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -75,7 +80,8 @@ namespace DetourModKit
          * @return The mangled name on success, std::nullopt on any failure (null vtable, unmapped page, missing COL,
          *         bad RVA, allocation failure).
          * @note Performs one heap allocation for the returned std::string. For per-frame identity probes use @ref
-         *       vtable_is_type or @ref type_name_into to avoid the allocation.
+         *       vtable_is_type or @ref type_name_into to avoid the allocation, or @ref interned_type_name to label
+         *       objects without copying the name at all.
          */
         [[nodiscard]] std::optional<std::string> type_name_of(Address vtable,
                                                               std::size_t max_len = DEFAULT_TYPE_NAME_MAX) noexcept;
@@ -90,12 +96,32 @@ namespace DetourModKit
          * @param out_len Capacity of @p out including the NUL terminator. The function never writes more than @p
          *                out_len bytes.
          * @return Number of name bytes written (excluding the NUL terminator), or 0 on failure or empty output.
-         * @note Zero-allocation, but each call runs the loader-querying COL prelude (a GetModuleHandleEx-class lookup),
-         *       so it is an occasional identity probe, not a zero-cost per-frame test; cache a @ref TypeIdentity when
-         *       checking the same type every frame.
+         * @note Zero-allocation. A vtable already in the @ref interned_type_name cache costs a slot load and a copy;
+         *       any other runs the loader-querying COL prelude (a GetModuleHandleEx-class lookup), so cache a
+         *       @ref TypeIdentity when checking the same type every frame.
          */
         [[nodiscard]] std::size_t type_name_into(Address vtable, char *out, std::size_t out_len) noexcept;
 
+        /**
+         * @brief The mangled name for @p vtable from a process-wide interned cache, walking RTTI only on first sight.
+         * @details @ref type_name_of, @ref type_name_into and @ref vtable_is_type consult the same cache first, so a
+         *          debug overlay labelling hundreds of objects per frame pays one walk per distinct vtable and then a
+         *          lock-free slot load per label. Every mapping is dropped when any module unloads, and the cache is
+         *          bypassed while the memory cache is not initialized, since unloads are only observed between
+         *          memory::init_cache and memory::shutdown_cache.
+         *
+         *          Only vtables whose vtable[-1] meta-slot and COL lie on read-only pages are interned, as a normal
+         *          /GR image places them in .rdata. A writable COL could be rewritten without an unload, so such a
+         *          vtable is never cached and this function returns std::nullopt for it; the other entry points fall
+         *          back to their own walk.
+         * @param vtable Runtime vtable pointer (the first qword of the object).
+         * @return A view of the interned name, valid until the process exits; std::nullopt when the vtable does not
+         *         resolve, is not cacheable, or the cache is bypassed or full.
+         * @note Allocation-free after the first sight of each vtable. The first sight takes an internal lock and may
+         *       allocate, so warm the labels outside a hook callback.
+         */
+        [[nodiscard]] std::optional<std::string_view> interned_type_name(Address vtable) noexcept;
+
         /**
          * @brief Tests whether the MSVC RTTI mangled name for @p vtable equals @p expected exactly.
          * @details Performs a byte-exact comparison of the mangled name plus the terminating NUL, rejecting both proper
@@ -106,8 +132,9 @@ namespace DetourModKit
          * @param expected Mangled name to compare against. Must be non-empty and shorter than @ref MAX_TYPE_NAME_LEN.
          * @return true on exact match; false on mismatch, on any read failure, or when @p expected is empty or
          *         oversized.
-         * @note Each call runs the loader-querying COL prelude, so it is an occasional identity probe, not a zero-cost
-         *       per-frame test; cache a @ref TypeIdentity when checking the same type every frame.
+         * @note A vtable already in the @ref interned_type_name cache is compared against the interned name without
+         *       reading process memory. Any other runs the loader-querying COL prelude, so cache a @ref TypeIdentity
+         *       when checking the same type every frame.
          */
         [[nodiscard]] bool vtable_is_type(Address vtable, std::string_view expected) noexcept;
 
@@ -294,6 +321,178 @@ namespace DetourModKit
             // writes this; a resolved identity returns from the m_resolved fast path and never touches it again.
             mutable std::atomic<std::uint64_t> m_last_attempt_ms{0};
         };
+
+        /// The @ref classify label of an object that matched none of the identities, or whose vptr did not read.
+        inline constexpr std::uint8_t CLASSIFY_NO_MATCH = 0xFF;
+
+        /// Most identities one @ref classify call matches against; a label must fit below @ref CLASSIFY_NO_MATCH.
+        inline constexpr std::size_t MAX_CLASSIFY_TYPES = CLASSIFY_NO_MATCH;
+
+        /**
+         * @brief Labels each object of an array with the identity its primary vtable matches.
+         * @details The batch form of @ref TypeIdentity::matches for per-frame entity filtering. Each identity is
+         *          resolved once per call. The vptrs are gathered in bounded scatter-gather passes under one fault
+         *          guard each, as @ref memory::read_many does, and compared against the whole identity set four at a
+         *          time on an AVX2 host. @c out[i] is the index into @p types of the first identity @c objects[i]
+         *          matches, or @ref CLASSIFY_NO_MATCH for a null, unreadable or unlisted object. Like @ref
+         *          TypeIdentity::matches, only the primary vtable matches: a pointer to a secondary base subobject is
+         *          not labelled.
+         * @param objects Object addresses; each one's first qword is read as its vptr.
+         * @param types The identities to match, at most @ref MAX_CLASSIFY_TYPES. An unresolvable one matches nothing.
+         * @param out One label per object, written in input order.
+         * @return The number of labels written: @c min(objects.size(), out.size()), or 0 when @p types holds more
+         *         than @ref MAX_CLASSIFY_TYPES identities.
+         * @note Callback-safe once every identity is warm: allocates nothing and takes no lock. The first call
+         *       resolves any identity not yet resolved, which is a module sweep.
+         */
+        [[nodiscard]] std::size_t classify(std::span<const Address> objects, std::span<const TypeIdentity> types,
+                                           std::span<std::uint8_t> out) noexcept;
+
+        /// Most vtables one @ref find_instances call matches.
+        inline constexpr std::size_t MAX_INSTANCE_VTABLES = 4096;
+
+        /**
+         * @struct InstanceScanOptions
+         * @brief Scope and parallelism of a @ref find_instances sweep.
+         */
+        struct InstanceScanOptions
+        {
+            /// The ranges whose writable pages are swept; empty sweeps the whole user address space.
+            RegionSet scope{};
+            /// Upper bound on worker threads (0 = hardware concurrency); a call from a fork-join worker runs serially.
+            std::size_t max_workers = 0;
+        };
+
+        /**
+         * @struct InstanceMatch
+         * @brief One object whose first qword equals a vtable of the set.
+         */
+        struct InstanceMatch
+        {
+            /// The object: the address of the qword that held the vtable.
+            Address object{};
+            /// Index into the @ref find_instances vtable span of the vtable it held (the first, for a repeated one).
+            std::size_t vtable = 0;
+        };
+
+        /**
+         * @struct InstanceScan
+         * @brief The outcome of a @ref find_instances sweep.
+         */
+        struct InstanceScan
+        {
+            /// The matches in ascending object address order.
+            std::vector<InstanceMatch> matches;
+            /// True when a chunk faulted mid-sweep, so matches in it may be missing.
+            bool incomplete = false;
+        };
+
+        /**
+         * @brief Finds live objects by vtable: every aligned qword of writable memory that equals one of @p vtables.
+         * @details Cuts the scope's committed writable windows (heap, stack, and module .data pages) into chunks and
+         *          sweeps them on the fork-join pool under the page-gated scans' fault guard, as the value scanner
+         *          and pointer map do. With up to eight vtables each aligned qword is compared against every one at
+         *          once, four qwords per step on an AVX2 host. A larger set is first range-screened against its lowest
+         *          and highest vtable, four qwords per step, and only the survivors probe a small open-addressed
+         *          table. Qwords inside the call's own copies of the set, and inside @p vtables itself, are dropped.
+         *          A hit is a qword that held a vtable when it was read: confirm it before trusting it (a stale
+         *          pointer to a freed object, or a table of vtables, matches as well), for instance with a guarded
+         *          read of a field the type always holds. Pass @ref TypeIdentity::vtable() or @ref vtables_for_type
+         *          results to find objects of a class and, with secondary vtables, its embedded bases.
+         * @param vtables The vtables to find, at most @ref MAX_INSTANCE_VTABLES. None may be null.
+         * @param options Scope and parallelism.
+         * @return The matches; `ErrorCode::InvalidArg` for an empty set or a null vtable, `ErrorCode::SizeTooLarge`
+         *         past @ref MAX_INSTANCE_VTABLES, or `ErrorCode::OutOfMemory`.
+         * @note Setup/control-plane only: reads every writable page of the scope and may spawn worker threads.
+         */
+        [[nodiscard]] Result<InstanceScan> find_instances(std::span<const Address> vtables,
+                                                          const InstanceScanOptions &options = {}) noexcept;
+
+        /**
+         * @class TypeIndex
+         * @brief Every RTTI record of one module, indexed once: mangled name to vtables, and vtable to name.
+         * @details @ref vtable_for_type and @ref vtables_for_type sweep the module's RTTI-bearing sections for every
+         *          query, which a mod resolving a hundred types at startup pays a hundred times. The build makes that
+         *          sweep once and keeps every COL it validates, with the sections cut into chunks that run on the
+         *          fork-join pool. Each candidate passes the same COL prelude as the per-query sweep, so the index
+         *          holds exactly the vtables those functions can find. Queries are then hash lookups that read no
+         *          process memory.
+         *
+         *          The index is a snapshot of the image at build time. A module's vtables and RTTI records do not move
+         *          while it stays mapped, so @ref shared keeps one index per scope for the whole process and rebuilds
+         *          it only when a different image is mapped at that base.
+         * @note Move-only. The build is setup/control-plane work that reads the scope's RTTI sections and may spawn
+         *       worker threads for the call. Queries are noexcept and read only the index, so any number of threads
+         *       may query one index at once.
+         */
+        class TypeIndex
+        {
+        public:
+            /**
+             * @brief Sweeps @p range once and indexes every validated COL.
+             * @param range Module image to index, as for @ref vtable_for_type. Defaults to the host EXE.
+             * @param max_workers Upper bound on worker threads (0 = auto); a call from inside a fork-join worker runs
+             *                    serially.
+             * @return The index; InvalidRange when @p range is not a valid span, OutOfMemory when the records cannot
+             *         be stored.
+             */
+            [[nodiscard]] static Result<TypeIndex> build(Region range = Region::host(),
+                                                         std::size_t max_workers = 0) noexcept;
+
+            /**
+             * @brief The process-wide index of @p range, built on first use.
+             * @details Every caller asking for the same scope shares one index. It is trusted only while the owning
+             *          module's header fingerprint (base, image size, link stamp, checksum) matches the one it was
+             *          built against, so an unloaded module or a different image at the same base is re-indexed on
+             *          the next call. A scope outside any loaded module has no fingerprint and is never cached; each
+             *          call builds it afresh.
+             * @return The shared index, or the errors of @ref build.
+             */
+            [[nodiscard]] static Result<std::shared_ptr<const TypeIndex>>
+            shared(Region range = Region::host()) noexcept;
+
+            TypeIndex(TypeIndex &&) noexcept;
+            TypeIndex &operator=(TypeIndex &&) noexcept;
+            TypeIndex(const TypeIndex &) = delete;
+            TypeIndex &operator=(const TypeIndex &) = delete;
+            ~TypeIndex() noexcept;
+
+            /**
+             * @brief The primary vtable for @p mangled: what @ref vtable_for_type returns for the indexed scope.
+             * @return The unique COL.offset == 0 vtable; std::nullopt when the name is unknown, has no primary, has
+             *         several, or has 64 or more vtables, where the per-query sweep saturates.
+             */
+            [[nodiscard]] std::optional<Address> vtable_for(std::string_view mangled) const noexcept;
+
+            /**
+             * @brief Every sub-object vtable for @p mangled, in ascending COL.offset order.
+             * @details As @ref vtables_for_type, except that the count is exact: the index does not stop collecting at
+             *          an internal cap.
+             * @return Total matching vtables; a value greater than @p out_cap signals the output was truncated.
+             */
+            [[nodiscard]] std::size_t vtables_for(std::string_view mangled, Address *out,
+                                                  std::size_t out_cap) const noexcept;
+
+            /**
+             * @brief The mangled name whose COL @p vtable points back to, if the build saw that vtable.
+             * @return A view into the index, valid while the index lives; std::nullopt for a vtable not indexed.
+             */
+            [[nodiscard]] std::optional<std::string_view> type_name_of(Address vtable) const noexcept;
+
+            /// Distinct mangled names indexed.
+            [[nodiscard]] std::size_t type_count() const noexcept;
+
+            /// Vtables indexed, over every name.
+            [[nodiscard]] std::size_t vtable_count() const noexcept;
+
+            /// The scope the index was built over.
+            [[nodiscard]] Region range() const noexcept;
+
+        private:
+            struct Impl;
+            explicit TypeIndex(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
     } // namespace rtti
 } // namespace DetourModKit
 
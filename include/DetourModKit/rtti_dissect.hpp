@@ -11,6 +11,8 @@
  *            slot refer to, and what is its RTTI type?" (the per-slot primitive).
  *          - @ref reverse_scan_block -- "RTTI-label every pointer slot in
  *            this struct" (allocating, init-time/tooling triage).
+ *          - @ref crawl -- "follow those labelled pointers from a root object
+ *            and map the whole object graph" (allocating, parallel, tooling only).
  *          - @ref heal_landmark -- "a small patch shifted the layout; find
  *            where the field of type T moved to" (the self-healing offset resolver).
  *          - @ref solve_fingerprint -- "several fields co-moved; find the
@@ -28,12 +30,14 @@
 #include "DetourModKit/rtti.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <concepts>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -118,7 +122,8 @@ namespace DetourModKit
          *          Error channel instead of a bool. @ref identify_pointee_type is exactly @c has_value() over this --
          *          one probe, one prelude walk, one implementation. The Error's code is one of
          *          @ref ErrorCode::BadSlotAddress (null/low slot), @ref ErrorCode::UnreadableSlot (faulted or null/low
-         *          slot value), or @ref ErrorCode::NoRtti (neither shape carried a verifiable COL). Use this (or @ref
+         *          slot value), or @ref ErrorCode::NoRtti (neither shape carried a verifiable COL, or the slot value is
+         *          a kernel-half or misaligned address no MSVC object or vtable can occupy). Use this (or @ref
          *          identify_pointee_type_or) when the reason for a miss matters (cascade diagnostics, telemetry); use
          *          the bool form otherwise.
          * @param slot_addr Address of the pointer-sized slot to probe.
@@ -208,8 +213,11 @@ namespace DetourModKit
          * @param out Receives the resolved slots, appended in slot order.
          * @param stride Byte distance between adjacent slots. Zero is treated as sizeof(std::uintptr_t).
          * @return Number of slots appended to @p out.
-         * @warning ALLOCATES (grows @p out) and calls the syscall-heavy prelude per slot. Init-time / tooling only --
-         *          never the hot path.
+         * @warning ALLOCATES (grows @p out) and calls the syscall-heavy prelude per plausible slot. Init-time /
+         *          tooling only -- never the hot path.
+         * @note With the default stride the block is read a page at a time and screened in bulk (four slots per step
+         *       on an AVX2 host): only 8-byte-aligned user-mode values reach the RTTI walk, so the floats, integers and
+         *       nulls that fill most structs cost no guarded read. The labels are the same as probing every slot.
          * @note The (slot_count * stride) span is overflow-guarded; a malformed tuple is treated as an empty block and
          *       returns 0. If a reallocation of @p out throws, the sweep stops early and returns the count appended so
          *       far (the noexcept contract holds).
@@ -231,6 +239,97 @@ namespace DetourModKit
                                                            std::vector<LabeledSlot> &out,
                                                            std::size_t stride = sizeof(std::uintptr_t)) noexcept;
 
+        /// Most objects one @ref crawl records; a graph that reaches it stops growing and is marked truncated.
+        inline constexpr std::size_t MAX_CRAWL_NODES = std::size_t{1} << 16;
+
+        /// Most bytes of each object @ref crawl scans for fields.
+        inline constexpr std::size_t MAX_CRAWL_OBJECT_BYTES = std::size_t{1} << 16;
+
+        /**
+         * @struct CrawlType
+         * @brief One distinct type in a @ref CrawlGraph.
+         */
+        struct CrawlType
+        {
+            /// Mangled name.
+            std::string name;
+            /// Objects of this type in the graph.
+            std::size_t count = 0;
+        };
+
+        /**
+         * @struct CrawlNode
+         * @brief One object reached by a @ref crawl.
+         */
+        struct CrawlNode
+        {
+            /// The complete object (its most-derived subobject's base).
+            Address object{};
+            /// The vtable the object was first reached through; a secondary base's when reached through one.
+            Address vtable{};
+            /// Index of the object's type in @ref CrawlGraph::types.
+            std::uint32_t type = 0;
+            /// Edges from the root to the object: 0 for the root.
+            std::uint32_t depth = 0;
+        };
+
+        /**
+         * @struct CrawlEdge
+         * @brief One RTTI-labelled field of a crawled object that refers to another object of the graph.
+         */
+        struct CrawlEdge
+        {
+            /// Index of the object holding the field in @ref CrawlGraph::nodes.
+            std::uint32_t from = 0;
+            /// Index of the object the field refers to.
+            std::uint32_t to = 0;
+            /// Byte offset of the field within the holding object.
+            std::ptrdiff_t offset = 0;
+            /// True when the field is an embedded object (its vtable sits in the field) rather than a pointer to one.
+            bool embedded = false;
+        };
+
+        /**
+         * @struct CrawlGraph
+         * @brief The object graph a @ref crawl reached: each object once, each labelled field as an edge.
+         */
+        struct CrawlGraph
+        {
+            /// Distinct types, in the order first reached, with their object counts.
+            std::vector<CrawlType> types;
+            /// Objects in breadth-first order; nodes[0] is the root.
+            std::vector<CrawlNode> nodes;
+            /// Edges grouped by holding object in node order, each object's in field order.
+            std::vector<CrawlEdge> edges;
+            /// Bytes of object memory scanned for fields.
+            std::size_t bytes_scanned = 0;
+            /// True when @ref MAX_CRAWL_NODES was reached and further objects (and the edges to them) were dropped.
+            bool truncated = false;
+        };
+
+        /**
+         * @brief Breadth-first walk of the object graph under @p root, RTTI-labelling every field.
+         * @details The automated form of running @ref reverse_scan_block by hand from a root object: each object's
+         *          first @p byte_budget bytes are swept, every field that resolves to an object becomes an edge, and
+         *          each object not seen before joins the next level. Objects are keyed by their complete-object
+         *          address, so a cycle, a back pointer, or a secondary-base pointer into a known object adds an edge
+         *          but no node, and an object's own secondary vtables are not edges. The objects of one level are
+         *          swept in parallel on the fork-join pool; the graph is merged in level and field order, so the same
+         *          memory always yields the same graph.
+         * @param root An object whose first qword is its vtable (not a pointer to one).
+         * @param depth Levels of edges to follow: 0 records the root alone, 1 adds the objects it refers to, ...
+         * @param byte_budget Bytes of each object to sweep, pointer granular; at most @ref MAX_CRAWL_OBJECT_BYTES.
+         * @param max_workers Upper bound on worker threads (0 = auto); a call from inside a fork-join worker runs
+         *                    serially.
+         * @return The graph, or @ref ErrorCode::InvalidArg for a @p byte_budget under one pointer or over the cap,
+         *         the @ref identify_pointee_typed error when @p root does not resolve, @ref ErrorCode::NoRtti when it
+         *         resolves only as a pointer, or @ref ErrorCode::OutOfMemory.
+         * @warning ALLOCATES and runs the RTTI prelude for every plausible field of every object it reaches.
+         *          Reverse-engineering and tooling only -- never the hot path.
+         */
+        [[nodiscard]] Result<CrawlGraph> crawl(Address root, std::size_t depth, std::size_t byte_budget,
+                                               std::size_t max_workers = 0) noexcept;
+
         /**
          * @enum Indirection
          * @brief Slot shape (and, for @ref CompleteObject, subobject position) a self-heal landmark requires of a
@@ -408,8 +507,9 @@ namespace DetourModKit
          *       required landmarks satisfied at a delta, so two landmarks sharing a nominal_offset would probe the same
          *       slot and double-count it. Duplicate offsets are rejected as @ref ErrorCode::BadDescriptor before any
          *       memory is touched.
-         * @warning Init-time only: the probe count is (2 * window_bytes / 8 + 1) * fp.size() prelude walks. Allocates
-         *          nothing.
+         * @warning Init-time only. The union of the landmarks' windows is read a page at a time and each plausible slot
+         *          value in it costs one prelude walk, however many windows share the slot; the deltas are then scored
+         *          with word-wide bit operations. Allocates nothing (about 8 KiB of stack).
          */
         [[nodiscard]] Result<FingerprintHit> solve_fingerprint(Address base, std::span<const Landmark> fp,
                                                                std::size_t window_bytes) noexcept;
@@ -449,6 +549,25 @@ namespace DetourModKit
          */
         [[nodiscard]] std::size_t heal_report(std::span<const Landmark> landmarks, std::span<DriftEntry> out) noexcept;
 
+        /**
+         * @brief Heals a set of landmarks concurrently on the shared fork-join pool, writing @ref heal_report's report.
+         * @details Each landmark runs the @ref heal_landmark path on whichever worker claims it and its entry lands at
+         *          its own index, so the report is in input order and entry-for-entry what @ref heal_report writes.
+         *          The workers share one vtable-to-RTTI cache for the call: a vtable one worker has walked (or failed
+         *          to walk) is answered from the cache for every other window that sees it. The cache is dropped when
+         *          the call returns. Wide windows are started first so one slow heal does not trail the batch.
+         * @param landmarks The landmarks to heal (each with @c base set).
+         * @param out Destination, parallel to @p landmarks. At most @c out.size() entries are written.
+         * @param max_workers Upper bound on worker threads (0 = auto-select from hardware_concurrency, clamped).
+         * @param stop Cancels the landmarks not yet started when it fires; their entries read @c ok == false with
+         *        @ref ErrorCode::Cancelled.
+         * @return The number of entries written: @c min(landmarks.size(), out.size()).
+         * @note Setup/control-plane only: allocates the cache and runs on the pool. Never call it from a hook or under
+         *       the loader lock. When the cache cannot be allocated the landmarks heal serially, as @ref heal_report.
+         */
+        [[nodiscard]] std::size_t heal_report_parallel(std::span<const Landmark> landmarks, std::span<DriftEntry> out,
+                                                       std::size_t max_workers = 0, std::stop_token stop = {}) noexcept;
+
         /**
          * @enum HealEscalation
          * @brief Log-severity policy a @ref HealScheduler applies to a landmark that does not resolve during a scan.
@@ -491,6 +610,26 @@ namespace DetourModKit
             HealEscalation escalate = HealEscalation::WarnRequired;
         };
 
+        /**
+         * @struct HealTickStats
+         * @brief What one @ref HealScheduler::tick cost: its wall-clock time and how much heal work it ran or put off.
+         */
+        struct HealTickStats
+        {
+            /// Wall-clock time of the whole tick, gates and work callbacks included.
+            std::chrono::microseconds elapsed{0};
+            /// The longest single work callback this tick; the floor a budget cannot go under.
+            std::chrono::microseconds longest_group{0};
+            /// Work callbacks run this tick.
+            std::size_t groups_run = 0;
+            /// Interval-due groups left for the next tick because the budget ran out. Their interval is not spent.
+            std::size_t groups_deferred = 0;
+            /// Groups that ran and asked to continue on the next tick through @ref HealRun::continue_next_tick.
+            std::size_t groups_continued = 0;
+            /// True when the tick ran past its budget (always false for the unbudgeted @ref HealScheduler::tick).
+            bool over_budget = false;
+        };
+
         class HealScheduler;
 
         /**
@@ -543,10 +682,36 @@ namespace DetourModKit
             void note_drift(std::string_view label, std::ptrdiff_t nominal_offset,
                             std::ptrdiff_t healed_offset) noexcept;
 
+            /**
+             * @brief The time left in the running tick's budget; zero once it is spent.
+             * @details A group that heals in several steps (one landmark, or one slice of a @ref solve_fingerprint
+             *          window, per step) checks this between steps and stops with @ref continue_next_tick when it runs
+             *          out. Under the unbudgeted @ref HealScheduler::tick it is effectively unlimited.
+             */
+            [[nodiscard]] std::chrono::microseconds remaining() const noexcept;
+
+            /// Returns true once the running tick's budget is spent.
+            [[nodiscard]] bool budget_exhausted() const noexcept
+            {
+                return remaining().count() <= 0;
+            }
+
+            /**
+             * @brief Asks for the group to run again on the next tick instead of after the retry interval.
+             * @details For a group that keeps its progress in its own state and did only part of its work: it returns
+             *          false (not resolved) after calling this, and the scheduler re-runs it next tick without spending
+             *          the interval. A group that returns true latches regardless.
+             */
+            void continue_next_tick() noexcept
+            {
+                m_continue = true;
+            }
+
         private:
             friend class HealScheduler;
-            HealRun(const HealConfig &config, std::atomic<bool> &drift_warned) noexcept
-                : m_config(config), m_drift_warned(drift_warned)
+            HealRun(const HealConfig &config, std::atomic<bool> &drift_warned,
+                    std::chrono::steady_clock::time_point deadline) noexcept
+                : m_config(config), m_drift_warned(drift_warned), m_deadline(deadline)
             {
             }
 
@@ -556,6 +721,8 @@ namespace DetourModKit
 
             const HealConfig &m_config;
             std::atomic<bool> &m_drift_warned;
+            std::chrono::steady_clock::time_point m_deadline;
+            bool m_continue = false;
         };
 
         /**
@@ -573,6 +740,10 @@ namespace DetourModKit
          *          solve_fingerprint bracket, a dependent hop through a healed offset, ...) and returns whether
          *          the group has fully resolved. There is NO attempt cap: an unresolved group is retried on the fixed
          *          interval for as long as it takes, then latches.
+         *
+         *          A frame-time-sensitive caller passes a budget to @ref tick: the groups the budget does not reach
+         *          wait for the next tick, and a group with more work than one frame affords splits it into steps and
+         *          resumes through @ref HealRun::continue_next_tick. Each tick returns a @ref HealTickStats.
          * @note Render-thread only. The scheduler is single-owner and move-only; construct it once (via @ref start) and
          *       drive it from the same thread that walks the pointer chains. The offset SLOTS a group writes are the
          *       cross-thread channel (a std::atomic<std::ptrdiff_t> per offset), not the scheduler itself.
@@ -618,8 +789,21 @@ namespace DetourModKit
             /**
              * @brief Advances the scheduler by one frame: scans every un-latched, gate-passing, interval-due group.
              * @details Never throws; a work or gate callback that throws is treated as "did not resolve this frame".
+             * @return What the tick cost.
+             */
+            HealTickStats tick() noexcept;
+
+            /**
+             * @brief Advances the scheduler by one frame, running heal work only while @p budget lasts.
+             * @details The clock is checked before each group's work, so a tick overruns @p budget by at most one
+             *          callback; a group that heals in steps keeps that overrun small through @ref HealRun::remaining.
+             *          At least one due group runs per tick, so a zero budget still makes progress. A due group the
+             *          budget did not reach keeps its interval and runs first on the next tick, so no group starves.
+             *          Gates of groups the tick does not reach are not evaluated.
+             * @param budget Wall-clock time the tick may spend on heal work.
+             * @return What the tick cost and how much work it deferred.
              */
-            void tick() noexcept;
+            HealTickStats tick(std::chrono::microseconds budget) noexcept;
 
             /// Returns true when every registered group has latched (vacuously true with no groups).
             [[nodiscard]] bool all_resolved() const noexcept;
@@ -11,9 +11,11 @@
  *          the VirtualQuery page walk, hooked-prologue recovery, the x86 decoder) lives under
  *          `src/internal/` and is never installed: an installed header is a public compile contract
  *          regardless of namespace, so the engine stays physically out of the include tree. The only
- *          implementation detail this header pulls is `detail/pattern_core.hpp`, the inline storage
+ *          implementation details this header pulls are `detail/pattern_core.hpp`, the inline storage
  *          and constexpr parser that `Pattern` holds by value (it must be compile-visible for the
- *          consteval `literal()` path and is allowlisted on those grounds).
+ *          consteval `literal()` path and is allowlisted on those grounds), and
+ *          `detail/pattern_kernel.hpp`, the compile-time verifiers the `scan<"...">` templates
+ *          instantiate in the caller's translation unit.
  *
  *          Vocabulary:
  *          - A Pattern is a compiled AOB mini-DSL string. It owns its bytes/mask inline (no heap),
@@ -28,16 +30,23 @@
 #include "DetourModKit/address.hpp"
 #include "DetourModKit/defines.hpp"
 #include "DetourModKit/detail/pattern_core.hpp"
+#include "DetourModKit/detail/pattern_kernel.hpp"
 #include "DetourModKit/error.hpp"
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 
 #include <array>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <optional>
 #include <span>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <type_traits>
 #include <variant>
 #include <vector>
 
@@ -50,6 +59,12 @@ namespace DetourModKit::detail
 {
     /// Returns @p pattern's immutable compiled buffer for internal scan adapters.
     [[nodiscard]] constexpr const PatternBuffer &pattern_buffer(const scan::Pattern &pattern) noexcept;
+
+    /// Rebuilds a Pattern from a stored buffer that passes is_well_formed_buffer, re-selecting its anchor.
+    [[nodiscard]] constexpr std::optional<scan::Pattern> pattern_from_buffer(PatternBuffer buffer) noexcept;
+
+    /// Pattern::compile's body: answers @p dsl from the process-wide intern table, parsing and publishing on a miss.
+    [[nodiscard]] Result<scan::Pattern> compile_interned_pattern(std::string_view dsl) noexcept;
 } // namespace DetourModKit::detail
 
 namespace DetourModKit::scan
@@ -74,17 +89,17 @@ namespace DetourModKit::scan
          * @details Never undefined behaviour on bad input: a parse failure becomes a recoverable Error. The specific
          *          parse status is stashed in the Error's extra slot so a caller can distinguish, for example, an
          *          over-long pattern from an invalid token without the resolver surface growing more error codes.
+         *
+         *          Successful compiles are interned process-wide by their exact DSL text, so a repeated compile of the
+         *          same string (every mod re-declaring a shared signature, a ladder rebuilt per profile) is one
+         *          lock-free table probe and a copy of the stored Pattern rather than a re-parse and anchor
+         *          re-selection. The table is bounded; once full, further new strings are parsed without being
+         *          cached and the result is identical either way. Malformed strings are never interned.
          * @note Setup/control-plane only -- compile patterns at init, not inside a hot callback.
          */
         [[nodiscard]] static Result<Pattern> compile(std::string_view dsl)
         {
-            const detail::PatternParse parsed = detail::parse_pattern(dsl);
-            if (parsed.status != detail::PatternStatus::Ok)
-            {
-                return std::unexpected(
-                    Error{ErrorCode::BadPattern, "scan::compile", 0, static_cast<std::uint32_t>(parsed.status)});
-            }
-            return Pattern{parsed.buffer};
+            return detail::compile_interned_pattern(dsl);
         }
 
         /**
@@ -127,12 +142,22 @@ namespace DetourModKit::scan
             return std::span<const std::byte>(m_data.bytes.data(), m_data.length);
         }
 
-        /// View over the per-byte match mask paralleling bytes() (length == size()).
+        /**
+         * @brief View over the per-byte match mask paralleling bytes() (length == size()).
+         * @details A class or group position holds the bits its members share, so at such a position the masked
+         *          compare is necessary but, when has_classes() is true, not sufficient.
+         */
         [[nodiscard]] constexpr std::span<const std::byte> mask() const noexcept
         {
             return std::span<const std::byte>(m_data.mask.data(), m_data.length);
         }
 
+        /// True when a `[0D|15]` class or `(..|..)` group needs an exact check beyond the masked compare.
+        [[nodiscard]] constexpr bool has_classes() const noexcept
+        {
+            return m_data.class_count > 0 || m_data.group_count > 0;
+        }
+
         /// True when the pattern carries at least one bounded jump (and therefore more than one segment).
         [[nodiscard]] constexpr bool has_jumps() const noexcept { return m_data.jump_count > 0; }
 
@@ -170,10 +195,10 @@ namespace DetourModKit::scan
          * @return True when the pattern (every segment placed across its gaps) matches beginning at the window start.
          * @details Applies the same compare the scan engine uses, expressed per byte: a position matches when
          *          (memory ^ pattern) & mask is zero for every byte, so wildcard bytes (mask 0x00) always agree and a
-         *          nibble mask (0xF0 / 0x0F) compares only the fixed nibble. A jump-free pattern is a single
-         *          fixed-width compare; a pattern with bounded jumps runs the same bounded backtracking search the
-         *          engine uses,
-         *          trying each gap width in ascending order. A window too short to hold the pattern cannot match.
+         *          nibble mask (0xF0 / 0x0F) compares only the fixed nibble, and classes and groups then take their
+         *          exact member check. A jump-free pattern is a single fixed-width compare; a pattern with bounded
+         *          jumps runs the same bounded backtracking search the engine uses, trying each gap width in ascending
+         *          order. A window too short to hold the pattern cannot match.
          * @note Callback-safe -- a pure masked byte compare with no allocation, I/O, or locking.
          */
         [[nodiscard]] constexpr bool matches_at(std::span<const std::byte> window) const noexcept
@@ -183,6 +208,7 @@ namespace DetourModKit::scan
 
     private:
         friend constexpr const detail::PatternBuffer &detail::pattern_buffer(const Pattern &pattern) noexcept;
+        friend constexpr std::optional<Pattern> detail::pattern_from_buffer(detail::PatternBuffer buffer) noexcept;
 
         // Private so the only ways to obtain a Pattern are the validating factories; a default-constructed or
         // arbitrary-buffer Pattern can never exist.
@@ -200,11 +226,45 @@ namespace DetourModKit::detail
     {
         return pattern.m_data;
     }
+
+    [[nodiscard]] constexpr std::optional<scan::Pattern> pattern_from_buffer(PatternBuffer buffer) noexcept
+    {
+        if (!is_well_formed_buffer(buffer))
+        {
+            return std::nullopt;
+        }
+        buffer.anchor = select_anchor(buffer);
+        return scan::Pattern{buffer};
+    }
 } // namespace DetourModKit::detail
 
 namespace DetourModKit::scan
 {
 
+    /**
+     * @struct PatternInternStats
+     * @brief A snapshot of the process-wide Pattern::compile intern table.
+     * @details hits counts compiles answered from the table, misses counts compiles that parsed (including malformed
+     *          strings), and uncached counts well-formed strings that parsed but could not be published because the
+     *          table was full, the text was over the interning length cap, or the entry allocation failed. The
+     *          counters are relaxed and may be mutually inconsistent by an in-flight compile.
+     */
+    struct PatternInternStats
+    {
+        std::size_t entries = 0;
+        std::size_t capacity = 0;
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t uncached = 0;
+    };
+
+    /**
+     * @brief Reads the Pattern::compile intern table's occupancy and hit counters.
+     * @return The current PatternInternStats snapshot.
+     * @note Callback-safe -- a handful of relaxed atomic loads with no allocation, I/O, or locking.
+     */
+    [[nodiscard]] PatternInternStats pattern_intern_stats() noexcept;
+
     /**
      * @enum Pages
      * @brief Which page-protection class a page-gated scan accepts.
@@ -289,7 +349,8 @@ namespace DetourModKit::scan
      * @brief Reports the SIMD tier find-pattern matching uses at runtime.
      * @details Reflects both compile-time support (which intrinsics were built) and runtime CPU detection (CPUID plus
      *          OS XGETBV). Reports Avx512 only when the library was built with the opt-in DMK_ENABLE_AVX512 option and
-     *          the host has AVX-512F + AVX-512BW; otherwise it reports the highest available lower tier.
+     *          the host has AVX-512F + AVX-512BW; otherwise it reports the highest available lower tier. An applied
+     *          @ref apply_simd_calibration caps the result at the calibrated tier.
      * @note Callback-safe: pure CPU-feature read, no allocation or locking.
      */
     [[nodiscard]] SimdLevel active_simd_level() noexcept;
@@ -417,13 +478,33 @@ namespace DetourModKit::scan
      *          export directory, i.e. it names a "OtherDll.OtherFunc" string rather than code in this module) fails
      *          closed with @ref ErrorCode::ExportForwarded rather than returning the address of an ASCII string a caller
      *          would then hook and crash on: following a forwarder would require the loader (GetProcAddress) and would
-     *          break the allocation-free, loader-free contract.
-     * @note Allocation-free and noexcept: the name compare runs against a fixed-length window with no heap use, so this
-     *       is safe to call where @ref find_string_xref (which may allocate in its broad decode phase) is not. Still
-     *       setup/control-plane by convention -- it queries a module image, not a per-frame quantity.
+     *          break the loader-free contract.
+     *
+     *          The first query per module builds a process-wide index of its export names (an open-addressing hash
+     *          from each name to its name-table slot), so later queries cost a few guarded reads instead of a walk of
+     *          the whole table. Each call still re-reads the headers and export directory, and the index is used only
+     *          while their fingerprint is unchanged: a module that unloads drops its index, and a different image at
+     *          the same base rebuilds it. Ordinals and function RVAs are read live, so a patched EAT resolves as it
+     *          reads now. While the name strings themselves are not rewritten in place (they are read-only data in
+     *          a mapped image), every verdict, error codes included, is the one the linear walk gives.
+     * @note noexcept. The index build allocates once per module; if that fails, the call walks the table with no heap
+     *       use instead. Setup/control-plane by convention -- it queries a module image, not a per-frame quantity.
      */
     [[nodiscard]] Result<Address> resolve_export(std::string_view export_name, Region module = Region::host()) noexcept;
 
+    /**
+     * @brief Resolves many named exports of one module in a single call, one Result per name in input order.
+     * @param export_names The exact, case-sensitive export symbols; borrowed for the call.
+     * @param module The mapped image whose export directory to search; defaults to the host executable.
+     * @return On success, (*result)[i] is exactly what @ref resolve_export returns for export_names[i]. The OUTER
+     *         Result fails with Error{OutOfMemory} only when the result vector cannot be allocated.
+     * @details Reads the headers once for the whole batch and answers every name from the module's export index, so
+     *          a proxy DLL can resolve its whole forwarding table in one pass.
+     * @note Setup/control-plane only: allocates the result vector and, on first use, the module's index.
+     */
+    [[nodiscard]] Result<std::vector<Result<Address>>> resolve_exports(std::span<const std::string_view> export_names,
+                                                                       Region module = Region::host()) noexcept;
+
     /**
      * @enum OperandKind
      * @brief Which operand field @ref read_code_constant extracts.
@@ -467,13 +548,20 @@ namespace DetourModKit::scan
      *          Pattern far more selective), then the remaining byte patterns. Reordering never changes which addresses
      *          are valid: every candidate is still verified (unique-in-scope when required, in-scope, plausibly
      *          resolved), so a promoted candidate can only be tried earlier, never accepted on weaker evidence.
+     *
+     *          Adaptive learns the order from the request's own history in its @ref ResolutionCache: tiers that have
+     *          resolved lead, by success rate and then by mean time per attempt, untried tiers follow, and tiers that
+     *          have only missed or matched ambiguously go last. The UniqueFirst order breaks every tie, and is the
+     *          whole order for a request without a cache or history.
      */
     enum class CandidateOrder : std::uint8_t
     {
         /// Try candidates in the order the caller wrote them.
         AsDeclared,
         /// Try unique-only text tiers, then anchored byte patterns, then the rest; declared order kept within a group.
-        UniqueFirst
+        UniqueFirst,
+        /// Try the tiers that have historically resolved soonest and cheapest first; UniqueFirst without history.
+        Adaptive
     };
 
     /**
@@ -490,6 +578,8 @@ namespace DetourModKit::scan
             return "AsDeclared";
         case CandidateOrder::UniqueFirst:
             return "UniqueFirst";
+        case CandidateOrder::Adaptive:
+            return "Adaptive";
         }
         return "Unknown";
     }
@@ -744,6 +834,106 @@ namespace DetourModKit::scan
     [[nodiscard]] Result<std::int64_t> read_code_constant(const CodeConstant &code_constant,
                                                           Region scope = Region::host());
 
+    /**
+     * @brief Reads many code constants in one pass into the caller's @p out, one slot per constant in input order.
+     * @param constants The declarations to read; every ladder resolves in @p scope.
+     * @param out Receives constant i's value or Error in slot i, exactly what @ref read_code_constant returns for it;
+     *            slots past constants.size() are left untouched.
+     * @param scope Module image to resolve every site in; defaults to the host executable.
+     * @param max_workers Upper bound on resolve workers (0 = auto-select), as for @ref resolve_batch.
+     * @return An empty Result once every slot is written; InvalidArg (detail = out.size()) when @p out is shorter than
+     *         @p constants, with no slot touched; OutOfMemory when the batch scratch cannot be allocated, with every
+     *         slot then holding that same Error.
+     * @details The ladders resolve through one @ref resolve_batch, so a config-driven mod that re-derives dozens of
+     *          strides and field offsets pays one page-map snapshot and prescan instead of one full resolve each, and a
+     *          large batch spreads over the worker pool. The resolved sites then decode with one decoder, in address
+     *          order: sites within a page of each other share one execute-readable check and one guarded read, and a
+     *          span that cannot be read whole falls back to reading its sites one at a time.
+     * @note Setup/control-plane only, like @ref read_code_constant.
+     */
+    [[nodiscard]] Result<void> read_code_constants(std::span<const CodeConstant> constants,
+                                                   std::span<Result<std::int64_t>> out, Region scope = Region::host(),
+                                                   std::size_t max_workers = 0) noexcept;
+
+    /**
+     * @enum HitSource
+     * @brief Which stage of resolve() produced a Hit.
+     * @details Lets a caller tell a full-scope proof from the cheaper stages that answer first: a warm cache entry, or
+     *          the locality window around @ref ScanRequest::hint_rva. Appended to Hit after its established fields, so
+     *          Hit{address, name} still builds a @ref HitSource::Ladder hit.
+     */
+    enum class HitSource : std::uint8_t
+    {
+        /// The candidate ladder, run over the whole scope.
+        Ladder,
+        /// A ResolutionCache entry that re-verified at its remembered site.
+        Cache,
+        /// A byte tier that matched uniquely inside the hint window around @ref ScanRequest::hint_rva.
+        HintWindow,
+        /// Hooked-prologue recovery after a full direct miss.
+        PrologueRecovery,
+    };
+
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+    /// True in a build with `DMK_ENABLE_SCAN_TELEMETRY` defined, where scans record @ref ScanTelemetry.
+    inline constexpr bool SCAN_TELEMETRY_ENABLED = true;
+#else
+    /// True in a build with `DMK_ENABLE_SCAN_TELEMETRY` defined, where scans record @ref ScanTelemetry.
+    inline constexpr bool SCAN_TELEMETRY_ENABLED = false;
+#endif
+
+    /**
+     * @struct ScanTelemetry
+     * @brief The work one scan or resolve call did: bytes read, regions walked, matcher effort, faults and time.
+     * @details Recorded only in a build with `DMK_ENABLE_SCAN_TELEMETRY` defined (CMake option of the same name);
+     *          otherwise every field stays zero. A resolve counts every scan its tiers ran, including the work of
+     *          fork-join helpers on a parallel sweep. Meant for tuning a signature set: a signature whose
+     *          verify_calls dwarf its anchor_candidates, or whose segmented_steps climb, is the one to tighten.
+     */
+    struct ScanTelemetry
+    {
+        /// Bytes handed to the matcher, summed over the regions walked.
+        std::uint64_t bytes_scanned = 0;
+        /// Committed regions of the requested page class that were scanned.
+        std::uint64_t regions_walked = 0;
+        /// Positions the anchor search proposed (a first-byte or rare-byte hit; every position without an anchor).
+        std::uint64_t anchor_candidates = 0;
+        /// Candidates compared against the full pattern.
+        std::uint64_t verify_calls = 0;
+        /// Node visits of the `[X-Y]` jump matcher; zero for a pattern without jumps.
+        std::uint64_t segmented_steps = 0;
+        /// Regions skipped because a read faulted.
+        std::uint64_t faults = 0;
+        /// Wall time of the call.
+        std::chrono::nanoseconds elapsed{0};
+    };
+
+    /**
+     * @struct ScanTelemetryTotals
+     * @brief The process-wide sum of @ref ScanTelemetry over every top-level scan or resolve since the last reset.
+     */
+    struct ScanTelemetryTotals
+    {
+        /// Top-level calls counted; a scan run inside a resolve is part of the resolve, not a call of its own.
+        std::uint64_t scans = 0;
+        /// Field-wise sum of the calls' telemetry.
+        ScanTelemetry totals;
+    };
+
+    /**
+     * @brief The telemetry of the calling thread's most recent top-level scan or resolve.
+     * @details Covers @ref scan, @ref find_all, @ref for_each_match, @ref resolve, a whole @ref resolve_batch and the
+     *          calls built on them. All zero before the thread's first call, or in a build without
+     *          `DMK_ENABLE_SCAN_TELEMETRY`.
+     */
+    [[nodiscard]] ScanTelemetry last_scan_telemetry() noexcept;
+
+    /// The process-wide telemetry registry; all zero in a build without `DMK_ENABLE_SCAN_TELEMETRY`.
+    [[nodiscard]] ScanTelemetryTotals scan_telemetry_totals() noexcept;
+
+    /// Zeroes the process-wide registry; calls still in flight add to the fresh totals when they finish.
+    void reset_scan_telemetry_totals() noexcept;
+
     /**
      * @struct Hit
      * @brief A resolved address paired with the name of the candidate that produced it; owns its name.
@@ -756,6 +946,10 @@ namespace DetourModKit::scan
         Address address;
         /// A copy of the winning candidate's name.
         std::string winning_name;
+        /// The resolve stage that answered.
+        HitSource source = HitSource::Ladder;
+        /// The work the resolve did; all zero in a build without `DMK_ENABLE_SCAN_TELEMETRY`.
+        ScanTelemetry telemetry{};
     };
 
     /**
@@ -807,6 +1001,13 @@ namespace DetourModKit::scan
         const void *context = nullptr;
     };
 
+    /// Default half-width of a ScanRequest's locality hint window (256 KiB), sized for a patch that shifts code a bit.
+    inline constexpr std::size_t DEFAULT_HINT_WINDOW = std::size_t{256} << 10;
+
+    // Defined in scan_cache.hpp; a request only carries a pointer to one, so the file-backed cache stays out of every
+    // translation unit that merely builds a request.
+    class ResolutionCache;
+
     /**
      * @struct ScanRequest
      * @brief A non-owning resolution request: a candidate ladder plus the scope and policy to resolve it under.
@@ -842,6 +1043,49 @@ namespace DetourModKit::scan
          *          aggregate initialization of existing request fields.
          */
         bool require_executable_result = false;
+        /**
+         * @brief Optional resolution cache consulted before the ladder and updated after a byte-tier win.
+         * @details Non-owning; nullptr (the default) resolves in full every time. See scan_cache.hpp for what a warm
+         *          hit re-verifies. Appended to preserve positional aggregate initialization.
+         */
+        ResolutionCache *cache = nullptr;
+        /**
+         * @brief Optional multi-range scope; when non-null the request resolves within its spans and @ref scope is
+         *        ignored.
+         * @details Non-owning. The byte tiers count occurrences and prove uniqueness across the whole set, and every
+         *          in-scope gate is a membership test against it. An RTTI or string-xref tier resolves in each span on
+         *          its own and is accepted only when exactly one span answers, so a string literal and the code that
+         *          references it must share a span. The cache is keyed by one image's identity and is not consulted
+         *          for a set. An empty set fails with InvalidRange. Appended to preserve positional aggregate
+         *          initialization.
+         */
+        const RegionSet *regions = nullptr;
+        /**
+         * @brief Last known offset of the resolved site from @ref scope's base; 0 (the default) means no hint.
+         * @details After a cache miss the byte tiers are first tried, in ladder order, inside the window of
+         *          @ref hint_window bytes on each side of `scope.base + hint_rva` (clamped to the scope). A candidate
+         *          that matches uniquely inside the window and passes every in-scope and executable gate answers with
+         *          @ref HitSource::HintWindow; an empty or ambiguous window falls through to the full ladder. Window
+         *          uniqueness is a locality proof, not a whole-scope one -- the same trust a re-verified cache entry
+         *          gets -- so leave the hint unset where a distant duplicate must fail the resolve. Ignored for a
+         *          RegionSet scope and for an offset outside the scope. Appended to preserve positional aggregate
+         *          initialization.
+         */
+        std::uint64_t hint_rva = 0;
+        /// Half-width of the hint window, in bytes (see @ref hint_rva).
+        std::size_t hint_window = DEFAULT_HINT_WINDOW;
+        /**
+         * @brief Races the ordered tiers concurrently on the fork-join pool instead of trying them one by one.
+         * @details Returns the same Hit as the serial walk: every tier runs on its own worker, the lowest-ordered tier
+         *          that resolves wins, and a tier ordered after an established winner is skipped before it starts or
+         *          before its uniqueness scan. A scan already under way runs to the end of its walk, so the latency is
+         *          bounded by the slowest tier ordered at or before the winner rather than the sum of every earlier
+         *          miss. Each tier scans serially on its worker, so racing pays off for a ladder of several costly
+         *          tiers rather than one very large image. A request resolved on a resolve_batch worker, a one-tier
+         *          ladder, or a race that fails to allocate or has a tier throw falls back to the serial walk. Appended to
+         *          preserve positional aggregate initialization.
+         */
+        bool race_tiers = false;
     };
 
     /**
@@ -942,6 +1186,16 @@ namespace DetourModKit::scan
         Pages pages = Pages::Readable;
         /// Whether the final resolved address must be execute-readable.
         bool require_executable_result = false;
+        /// Optional resolution cache (see @ref ScanRequest::cache); non-owning, must outlive every resolve of this.
+        ResolutionCache *cache = nullptr;
+        /// Owned multi-range scope (see @ref ScanRequest::regions); an empty set resolves within @ref scope instead.
+        RegionSet regions;
+        /// Last known offset of the site from @ref scope's base (see @ref ScanRequest::hint_rva); 0 means no hint.
+        std::uint64_t hint_rva = 0;
+        /// Half-width of the hint window, in bytes (see @ref ScanRequest::hint_window).
+        std::size_t hint_window = DEFAULT_HINT_WINDOW;
+        /// Race the ordered tiers concurrently (see @ref ScanRequest::race_tiers).
+        bool race_tiers = false;
 
         /**
          * @brief Returns a borrowed ScanRequest viewing this object's owned storage.
@@ -959,6 +1213,11 @@ namespace DetourModKit::scan
                 .order = order,
                 .pages = pages,
                 .require_executable_result = require_executable_result,
+                .cache = cache,
+                .regions = regions.empty() ? nullptr : &regions,
+                .hint_rva = hint_rva,
+                .hint_window = hint_window,
+                .race_tiers = race_tiers,
             };
         }
     };
@@ -971,7 +1230,8 @@ namespace DetourModKit::scan
      * @return The number of indices written.
      * @details Pure index math, no allocation: it emits an ordering, never touches the candidates. AsDeclared is the
      *          identity permutation. UniqueFirst is a stable three-pass partition (unique-only text tiers, then
-     *          anchored byte patterns, then the rest), declared order preserved within each group.
+     *          anchored byte patterns, then the rest), declared order preserved within each group. Adaptive has no
+     *          history here and emits the UniqueFirst permutation; scan::resolve reorders it from the request's cache.
      * @note Callback-safe: pure index math, noexcept, no allocation.
      */
     [[nodiscard]] std::size_t order_candidates(CandidateOrder order, std::span<const Candidate> ladder,
@@ -1012,6 +1272,168 @@ namespace DetourModKit::scan
     [[nodiscard]] Result<std::vector<Result<Hit>>> resolve_batch(std::span<const ScanRequest> requests,
                                                                  std::size_t max_workers = 0) noexcept;
 
+    /**
+     * @brief Resolves a batch of requests concurrently into the caller's @p out, one slot per request in input order.
+     * @details The same batch as the vector overload, without its result container: a mod that re-resolves the same
+     *          table on every Logic DLL reload keeps one array of slots and reuses it. Slot i receives request i's
+     *          @ref Hit or Error, exactly as the vector overload would return it; slots past requests.size() are left
+     *          untouched. An Error carries only a static string, so a failed slot allocates nothing either. The
+     *          batch's own scratch (the page-map snapshot, the prescan, the cost plan) is still allocated per call.
+     * @return An empty Result once every slot is written; InvalidArg (detail = out.size()) when @p out is shorter than
+     *         @p requests, with no slot touched; OutOfMemory when the batch scratch cannot be allocated, with every
+     *         slot then holding that same Error.
+     * @note Setup/control-plane only, like the vector overload.
+     */
+    [[nodiscard]] Result<void> resolve_batch(std::span<const ScanRequest> requests, std::span<Result<Hit>> out,
+                                             std::size_t max_workers = 0) noexcept;
+
+    /**
+     * @struct BatchOptions
+     * @brief How a @ref resolve_batch runs: its worker bound, and when it gives up early.
+     * @details Cancellation reaches every request wherever it runs. A request not yet started is skipped, and one in
+     *          the middle of a page walk stops at the next region boundary, so a cancelled batch returns within about
+     *          one region scan per worker. Every request the cancellation cut short or skipped holds
+     *          Error{Cancelled}; a request that resolved before it keeps its Hit.
+     */
+    struct BatchOptions
+    {
+        /// Upper bound on worker threads (0 = auto-select), as for the plain overloads.
+        std::size_t max_workers = 0;
+        /// Cancels the batch when it fires: hand it the unloading module's or shutting-down worker's token.
+        std::stop_token stop{};
+        /**
+         * @brief Cancel the rest of the batch on the first request that fails, for a caller that would discard the
+         *        whole batch over one miss.
+         */
+        bool fail_fast = false;
+        /**
+         * @brief With @ref fail_fast, which requests are mandatory: only the failure of request i with mandatory[i]
+         *        set cancels the batch. Empty makes every request mandatory; a request past its end is optional.
+         */
+        std::span<const bool> mandatory{};
+    };
+
+    /// @ref resolve_batch with @p options controlling its workers and cancellation; vector results as above.
+    [[nodiscard]] Result<std::vector<Result<Hit>>> resolve_batch(std::span<const ScanRequest> requests,
+                                                                 const BatchOptions &options) noexcept;
+
+    /// @ref resolve_batch into the caller's @p out, with @p options controlling its workers and cancellation.
+    [[nodiscard]] Result<void> resolve_batch(std::span<const ScanRequest> requests, std::span<Result<Hit>> out,
+                                             const BatchOptions &options) noexcept;
+
+    /**
+     * @struct WorkerPlacement
+     * @brief How the worker pool shared by every batch API places its threads.
+     * @details The pool serves @ref resolve_batch, anchor::resolve_all_parallel, the manifest and offline batches, and
+     *          the chunked large-scope scans. The placement is process-wide so a mod sets it once, typically before
+     *          scanning during a loading screen, and every batch honours it.
+     */
+    struct WorkerPlacement
+    {
+        /**
+         * @brief Run pool workers at below-normal priority with EcoQoS power throttling, restricted to the efficiency
+         *        cores of a hybrid CPU, so background resolution does not compete with the game for performance cores.
+         */
+        bool background = false;
+        /**
+         * @brief With @ref background set, while a window of this process is in the foreground a batch invites at most
+         *        this fraction of the logical processors as workers (at least one). Clamped to [0, 1].
+         */
+        double foreground_core_fraction = 0.5;
+    };
+
+    /**
+     * @brief Sets the pool's @ref WorkerPlacement.
+     * @details Idle workers pick up a change when they next join a batch; a batch already running keeps its workers
+     *          where they are. The thread that issues a batch also works on it and is never re-placed. Every placement
+     *          call is best-effort: an OS without EcoQoS or CPU sets still gets the priority change and the cap.
+     */
+    void set_worker_placement(const WorkerPlacement &placement) noexcept;
+
+    /// The placement @ref set_worker_placement last set, with the fraction as clamped.
+    [[nodiscard]] WorkerPlacement worker_placement() noexcept;
+
+    /**
+     * @struct SimdCalibration
+     * @brief What @ref calibrate_simd measured on this host: the fastest verify tier and a batch worker count.
+     */
+    struct SimdCalibration
+    {
+        /// The fastest tier measured; the widest tier the engine runs once applied.
+        SimdLevel level = SimdLevel::Sse2;
+        /// The worker count a batch with max_workers = 0 uses once applied; 0 keeps the hardware thread count.
+        std::size_t workers = 0;
+        /// The fastest calibration sweep of each tier in nanoseconds, indexed by SimdLevel; 0 for a tier not measured.
+        std::array<std::uint64_t, 4> tier_nanos{};
+        /// Batch throughput on @ref workers participants relative to one, in thousandths; 0 when not measured.
+        std::uint32_t speedup_permille = 0;
+        /// The @ref calibration_host_key the measurement belongs to.
+        std::uint64_t host_key = 0;
+        /// True when @ref calibrate_simd took this from CalibrationOptions::cache instead of measuring.
+        bool from_cache = false;
+
+        [[nodiscard]] bool operator==(const SimdCalibration &) const noexcept = default;
+    };
+
+    /// Settings of one @ref calibrate_simd run.
+    struct CalibrationOptions
+    {
+        /// Bytes of the sample region copied and swept. Larger is steadier and slower; clamped to the region.
+        std::size_t sample_bytes = std::size_t{64} * 1024;
+        /// Sweeps per tier; the fastest is kept, so one preempted sweep does not skew the pick.
+        std::size_t rounds = 5;
+        /// Also time a multi-worker batch of the same sweeps and size max_workers = 0 batches from its speedup.
+        bool measure_workers = true;
+        /// Apply the result through @ref apply_simd_calibration before returning.
+        bool apply = true;
+        /**
+         * @brief When set, a calibration this cache holds for the current host is returned without measuring, and a
+         *        fresh measurement is recorded into it, so a saved cache carries the decision to the next launch.
+         */
+        ResolutionCache *cache = nullptr;
+    };
+
+    /**
+     * @brief The fingerprint a calibration is valid for: CPUID signature, logical processor count, and detected tier.
+     * @details A cache file copied to another machine, or a CPU upgrade, changes the key and so forces a fresh
+     *          measurement.
+     * @note Callback-safe: a few CPUID reads, no allocation or locking.
+     */
+    [[nodiscard]] std::uint64_t calibration_host_key() noexcept;
+
+    /**
+     * @brief Times the verify tiers this host supports on a slice of real image bytes and picks the fastest.
+     * @details Copies the first CalibrationOptions::sample_bytes of @p sample under a fault guard, then sweeps the
+     *          engine's verify ladder over every position of the copy with each tier as the widest: once with a
+     *          pattern that fails in its first chunk and once with one that verifies to its last byte, the two ends of
+     *          what an anchor hit costs. Running the sweeps in situ is the point: an AVX-512 tier that downclocks the
+     *          core, or a CPU whose 256-bit units are split, shows up as a slower time rather than as a feature bit.
+     *          A narrower tier must beat the widest by more than 5% to be picked, so timing noise never flips the
+     *          default. With CalibrationOptions::measure_workers, the picked tier's sweep is then run as a batch on
+     *          every logical processor, and its measured speedup (rounded, at least one) becomes the worker count,
+     *          so a host whose cores the game already saturates stops fanning a batch out over all of them.
+     *
+     *          Meant as an opt-in startup stage (see run_startup_pipeline) run off the loader lock on the game's code
+     *          section, e.g. Region::host(); under the loader lock the batch cannot fan out and the worker count is
+     *          not measured.
+     * @return The calibration, or an Error: RegionTooSmall when @p sample is smaller than 256 bytes, ReadFaulted when
+     *         the sample cannot be read, OutOfMemory.
+     * @note Setup/control-plane only: allocates, and takes roughly rounds x tiers sweeps of the sample (a few
+     *       milliseconds at the defaults) plus one batch.
+     */
+    [[nodiscard]] Result<SimdCalibration> calibrate_simd(Region sample,
+                                                         const CalibrationOptions &options = {}) noexcept;
+
+    /**
+     * @brief Caps every later scan at @p calibration.level and sets the max_workers = 0 batch width to its workers.
+     * @details The level is a ceiling: it never enables a tier the build or CPU lacks, and Sse2 is the floor. Scans
+     *          already running keep the tiers they selected. @ref active_simd_level reports the capped tier.
+     */
+    void apply_simd_calibration(const SimdCalibration &calibration) noexcept;
+
+    /// Drops any applied calibration: scans use the widest detected tier and batches the hardware thread count.
+    void reset_simd_calibration() noexcept;
+
     /**
      * @brief Scans one Pattern over a known scope and returns the Nth match address.
      * @param pattern The compiled signature.
@@ -1031,6 +1453,217 @@ namespace DetourModKit::scan
     [[nodiscard]] Result<Address> scan(const Pattern &pattern, Region scope, std::size_t occurrence = 1,
                                        Pages pages = Pages::Readable) noexcept;
 
+    /**
+     * @brief Scans one Pattern over every span of a RegionSet and returns the Nth match across the set.
+     * @param pattern The compiled signature.
+     * @param scope The spans to search; the gaps between them are never read.
+     * @param occurrence Which match to return (1-based), counted in ascending address order across the spans.
+     * @param pages Which page-protection class to accept.
+     * @return The Nth match address, or Error{InvalidRange} for an empty set, or the errors of the Region overload.
+     * @details The same page gate and fault guard as the Region overload, applied span by span. A large set is split
+     *          across the cores by its total size, not span by span, so many small spans and one large one balance
+     *          alike, and the answer is the serial walk's.
+     * @note Setup/control-plane only, like the Region overload.
+     */
+    [[nodiscard]] Result<Address> scan(const Pattern &pattern, const RegionSet &scope, std::size_t occurrence = 1,
+                                       Pages pages = Pages::Readable) noexcept;
+
+    /**
+     * @struct MatchSummary
+     * @brief How a for_each_match() or find_all() enumeration ended.
+     * @details An occurrence scan folds a skipped region and a spent bounded-jump budget into one NoMatch; an
+     *          enumeration keeps both visible, because the matches it did deliver are real either way. A caller using
+     *          the count as a proof (a uniqueness study, a table size) must require complete().
+     */
+    struct MatchSummary
+    {
+        /// Matches the visitor accepted; for find_all(), the addresses written.
+        std::size_t matches = 0;
+        /// True when a region faulted mid-scan and its unread bytes were skipped; matches there are missing.
+        bool faulted = false;
+        /// True when a bounded-jump matcher spent its work budget; later matches in that region may be missing.
+        bool truncated = false;
+        /// True when the visitor ended the walk; for find_all(), the output filled while matches remained.
+        bool stopped = false;
+
+        /// True when every match in the scope was visited: nothing faulted, truncated, or stopped.
+        [[nodiscard]] constexpr bool complete() const noexcept { return !faulted && !truncated && !stopped; }
+    };
+} // namespace DetourModKit::scan
+
+namespace DetourModKit::detail
+{
+    /// scan() with a compile-time verifier for @p pattern (nullptr = the generic verify); see scan::scan<Dsl>.
+    [[nodiscard]] Result<Address> scan_with_kernel(const scan::Pattern &pattern, PatternKernel kernel, Region scope,
+                                                   std::size_t occurrence, scan::Pages pages) noexcept;
+
+    /// unchecked::find_pattern() with a compile-time verifier for @p pattern; see scan::unchecked::find_pattern<Dsl>.
+    [[nodiscard]] const std::byte *find_pattern_with_kernel(Region region, const scan::Pattern &pattern,
+                                                            PatternKernel kernel, std::size_t occurrence) noexcept;
+
+    /// The type-erased visitor scan::for_each_match() forwards to; returning false ends the walk.
+    using AddressVisitor = bool (*)(void *context, Address match) noexcept;
+
+    /// The non-template body of scan::for_each_match().
+    [[nodiscard]] Result<scan::MatchSummary> for_each_match(const scan::Pattern &pattern, Region scope,
+                                                            scan::Pages pages, AddressVisitor visit,
+                                                            void *context) noexcept;
+} // namespace DetourModKit::detail
+
+namespace DetourModKit::scan
+{
+    /**
+     * @brief scan() for an in-source literal, verified by a kernel specialized on that literal at compile time.
+     * @tparam Dsl The pattern DSL, e.g. `scan<"48 8B 05 ?? ?? ?? ?? 48 85 C0">(scope)`. A malformed literal is a
+     *             compile error, exactly as with Pattern::literal().
+     * @return Exactly what scan(Pattern::literal(Dsl), scope, occurrence, pages) returns.
+     * @details The generic verify reloads the pattern's bytes and mask for every candidate the prefilter finds. Here
+     *          the length and the literal lanes are template constants, so each candidate is checked by a few unrolled
+     *          16- or 8-byte compares against constant vectors, and lanes without nibbles need no mask at all (see
+     *          detail/pattern_kernel.hpp). The page walk, the anchor choice, and every verdict are the runtime scan's.
+     *          A literal with bounded jumps compiles to the plain scan.
+     * @note Setup/control-plane only, like scan().
+     */
+    template <detail::PatternText Dsl>
+    [[nodiscard]] Result<Address> scan(Region scope, std::size_t occurrence = 1, Pages pages = Pages::Readable) noexcept
+    {
+        static constexpr Pattern pattern = Pattern::literal(Dsl.view());
+        constexpr detail::PatternKernel kernel = detail::kernel_for<detail::pattern_buffer(pattern)>();
+        return detail::scan_with_kernel(pattern, kernel, scope, occurrence, pages);
+    }
+
+    /**
+     * @brief Calls @p visitor with every match of @p pattern in @p scope, in ascending address order, in one pass.
+     * @param pattern The compiled signature.
+     * @param scope The region to enumerate.
+     * @param visitor Called as `visitor(Address)` for each match (adjusted by the Pattern's `|` offset). It may return
+     *                void, or a bool where false ends the walk. A throw also ends it; the exception is not propagated.
+     * @param pages Which page-protection class to accept, as in scan().
+     * @return The MatchSummary, or Error{InvalidRange} for an empty or wrapping scope, Error{InvalidArg} for an
+     *         out-of-range @p pages, Error{OutOfMemory} when the scan could not be prepared. No match is a success
+     *         with MatchSummary::matches == 0.
+     * @details Walking the Nth occurrence for N = 1, 2, ... rescans from the scope start each time; this visits the
+     *          same matches, each exactly once, for the cost of a single scan(). The page gate, fault guard, and
+     *          protection-split carry are scan()'s. The visitor runs on the calling thread, outside the fault guard,
+     *          and the walk stays serial regardless of the scope's size.
+     * @note Setup/control-plane only, like scan().
+     */
+    template <typename Visitor>
+    [[nodiscard]] Result<MatchSummary> for_each_match(const Pattern &pattern, Region scope, Visitor &&visitor,
+                                                      Pages pages = Pages::Readable) noexcept
+    {
+        using Callable = std::remove_reference_t<Visitor>;
+        static_assert(std::is_invocable_v<Callable &, Address>, "scan::for_each_match: visitor must take an Address");
+        const detail::AddressVisitor trampoline = [](void *context, Address match) noexcept -> bool
+        {
+            Callable &callable = *static_cast<Callable *>(context);
+            try
+            {
+                if constexpr (std::is_void_v<std::invoke_result_t<Callable &, Address>>)
+                {
+                    callable(match);
+                    return true;
+                }
+                else
+                {
+                    return static_cast<bool>(callable(match));
+                }
+            }
+            catch (...)
+            {
+                return false;
+            }
+        };
+        void *const context = const_cast<void *>(static_cast<const void *>(std::addressof(visitor)));
+        return detail::for_each_match(pattern, scope, pages, trampoline, context);
+    }
+
+    /**
+     * @brief Writes the first matches of @p pattern in @p scope to @p out, in ascending address order.
+     * @return The MatchSummary (MatchSummary::matches is the count written), or the errors of for_each_match().
+     * @details One pass, as for_each_match(). MatchSummary::stopped is set when @p out filled and at least one more
+     *          match exists, so an exactly-sized table reads complete() and an undersized one does not.
+     * @note Setup/control-plane only, like scan().
+     */
+    [[nodiscard]] Result<MatchSummary> find_all(const Pattern &pattern, Region scope, std::span<Address> out,
+                                                Pages pages = Pages::Readable) noexcept;
+
+    /// Most byte substitutions find_approximate() searches within.
+    inline constexpr std::size_t MAX_APPROXIMATE_MISMATCHES = 8;
+
+    /**
+     * @struct ApproximateMatch
+     * @brief One site within find_approximate()'s mismatch budget, and the pattern positions where it disagrees.
+     * @details A position disagrees when the site's byte fails that position's mask compare: a fixed byte that differs,
+     *          a fixed nibble that differs, or a byte outside a class. An alternation group counts per position, as
+     *          the class of bytes its alternatives allow there. Wildcard positions never disagree.
+     */
+    struct ApproximateMatch
+    {
+        /// The site's first byte. Not adjusted by the Pattern's `|` offset, so the positions index from here.
+        Address site;
+        /// How many positions disagree; 0 for an exact match.
+        std::uint8_t mismatches = 0;
+        /// The first @ref mismatches entries hold the disagreeing pattern indexes, ascending.
+        std::array<std::uint8_t, MAX_APPROXIMATE_MISMATCHES> positions{};
+
+        /// The disagreeing pattern indexes, ascending.
+        [[nodiscard]] constexpr std::span<const std::uint8_t> mismatch_positions() const noexcept
+        {
+            return std::span<const std::uint8_t>(positions.data(), mismatches);
+        }
+    };
+
+    /**
+     * @brief Writes the first sites in @p scope that match @p pattern with at most @p max_mismatches substitutions to
+     *        @p out, in ascending address order.
+     * @param pattern A compiled signature without `[X-Y]` jumps.
+     * @param scope The region to search.
+     * @param max_mismatches The substitution budget, at most MAX_APPROXIMATE_MISMATCHES and less than the pattern's
+     *                       constrained (non-wildcard) position count, since at that budget every site would match.
+     * @param out Receives each site and its disagreeing positions. Exact matches are included, with 0 mismatches.
+     * @param pages Which page-protection class to accept, as in scan().
+     * @param max_workers Upper bound on worker threads (0 = auto); a call from inside a fork-join worker runs serially.
+     * @return The MatchSummary (MatchSummary::matches is the count written), or Error{InvalidArg} for a jump-bearing
+     *         pattern, an out-of-range budget or @p pages, Error{InvalidRange} for an empty scope, or
+     *         Error{OutOfMemory}.
+     * @details This is the tool for a signature a patch has broken: the moved site usually differs in a byte or two
+     *          that a recompile renumbered, and a scan with a small budget finds it and names the bytes that changed.
+     *          The matcher is bit-parallel (Wu-Manber over Hamming distance): one state bitset per mismatch count,
+     *          each advanced by a shift, a table AND and an OR per scanned byte, so the cost is linear in the scope and
+     *          independent of how many sites come close. The scope's readable pages are cut into chunks that run on
+     *          the fork-join pool under the page-gated scans' fault guard. MatchSummary::faulted reports a chunk that
+     *          faulted part-way, and MatchSummary::stopped reports more sites than @p out could hold.
+     * @note Setup/control-plane only: reads process memory and may spawn worker threads for the call.
+     */
+    [[nodiscard]] Result<MatchSummary> find_approximate(const Pattern &pattern, Region scope,
+                                                        std::size_t max_mismatches, std::span<ApproximateMatch> out,
+                                                        Pages pages = Pages::Readable,
+                                                        std::size_t max_workers = 0) noexcept;
+
+    /**
+     * @brief Profiles a module's code once, so later scans inside it choose their prefilter byte by its real byte
+     *        frequencies.
+     * @param module The mapped image to profile; defaults to the host executable.
+     * @return The number of code bytes tallied, or Error{InvalidRange} when @p module is not a parseable PE32+ image
+     *         or none of its executable sections could be read, or Error{OutOfMemory}.
+     * @details Every scan picks one fully-known byte of the pattern to sweep for with memchr and verifies the whole
+     *          pattern only where that byte occurs, so the rarer the byte is in the haystack, the fewer verifies the
+     *          scan pays for. By default that choice comes from a small strided sample of the scope, taken again on
+     *          every scan. After this call, a @ref Pages::Executable scan inside @p module, or a scan whose scope lies
+     *          within one of its executable sections, uses a 256-bin histogram of all of the module's code instead:
+     *          packed, obfuscated, or SSE-heavy code that the sample misjudges gets an anchor that is actually rare in
+     *          it, and the per-scan sampling is skipped. Other scans of the module keep sampling, since code
+     *          frequencies say little about .rdata or .data.
+     *
+     *          Opt-in and correctness-neutral: the anchor only decides which byte the prefilter sweeps for, never
+     *          whether a position matches. Calling it again re-profiles the module. A profile is never evicted; one
+     *          left behind by a module that unloaded can at worst pick a slower anchor for a module later mapped at
+     *          the same base.
+     * @note Setup/control-plane only: reads every executable byte of the module once, under a fault guard.
+     */
+    [[nodiscard]] Result<std::size_t> tune_anchors(Region module = Region::host()) noexcept;
+
     /// Common x86-64 RIP-relative opcode prefixes (the bytes preceding the disp32 field), for find_and_resolve.
     inline constexpr std::array<std::byte, 3> PREFIX_MOV_RAX_RIP = {std::byte{0x48}, std::byte{0x8B}, std::byte{0x05}};
     inline constexpr std::array<std::byte, 3> PREFIX_MOV_RCX_RIP = {std::byte{0x48}, std::byte{0x8B}, std::byte{0x0D}};
@@ -1096,6 +1729,40 @@ namespace DetourModKit::scan
      */
     [[nodiscard]] bool is_likely_function_prologue(Address addr) noexcept;
 
+    /**
+     * @struct FunctionBounds
+     * @brief The registered function range holding an address, and the primary function that range belongs to.
+     * @details A funclet or a hot/cold-split fragment is registered as its own range whose unwind chain ends at the
+     *          function it was split from, so @ref begin / @ref end bound the fragment while @ref entry is the callable
+     *          start. For an unsplit function all three describe the same function and entry == begin.
+     */
+    struct FunctionBounds
+    {
+        /// The primary function's first byte: the root of the range's unwind chain.
+        Address entry;
+        /// First byte of the range containing the queried address.
+        Address begin;
+        /// One past the last byte of that range.
+        Address end;
+    };
+
+    /**
+     * @brief Finds the function containing @p address from its image's exception directory (.pdata).
+     * @param address Any address inside a mapped PE32+ image, e.g. a scan hit in the middle of a function.
+     * @return The containing range and its primary entry. ErrorCode::NullInput for a null @p address;
+     *         ErrorCode::FunctionNotFound when the image's table holds no range for @p address (a leaf function that
+     *         registers no unwind data, inter-function padding, or data); ErrorCode::InvalidRange when @p address is in
+     *         no image, or the image has no usable exception directory. The last two carry @p address in detail.
+     * @details The first query in an image builds a sorted index of its whole table, with every chained range already
+     *          folded to its primary function; each later query re-reads the image's headers to confirm the index
+     *          still describes the image mapped at that base and binary-searches it. The same index backs
+     *          XrefReturn::EnclosingFunction. Covers only statically registered tables: code registered at run time
+     *          through RtlAddFunctionTable (JIT output, some packers) reports ErrorCode::InvalidRange.
+     * @note Not callback-safe on an image's first query, which allocates the index and takes a lock; afterwards a
+     *       query is two guarded header reads, a shared lock and a binary search, cheap enough for hot diagnostics.
+     */
+    [[nodiscard]] Result<FunctionBounds> function_containing(Address address) noexcept;
+
     /**
      * @brief Flattens a resolve Result to its address, or a null Address on failure.
      * @details The single blessed convenience for the address-or-nothing shape. It is a convenience adapter, not the
@@ -1135,6 +1802,21 @@ namespace DetourModKit::scan
          */
         [[nodiscard]] const std::byte *find_pattern(Region region, const Pattern &pattern,
                                                     std::size_t occurrence = 1) noexcept;
+
+        /**
+         * @brief find_pattern() for an in-source literal, with the compile-time specialized verifier of scan<Dsl>.
+         * @tparam Dsl The pattern DSL; a malformed literal is a compile error.
+         * @return Exactly what find_pattern(region, Pattern::literal(Dsl), occurrence) returns, under the same
+         *         READABLE-RANGE contract.
+         * @note Setup/control-plane only, like find_pattern().
+         */
+        template <detail::PatternText Dsl>
+        [[nodiscard]] const std::byte *find_pattern(Region region, std::size_t occurrence = 1) noexcept
+        {
+            static constexpr Pattern pattern = Pattern::literal(Dsl.view());
+            constexpr detail::PatternKernel kernel = detail::kernel_for<detail::pattern_buffer(pattern)>();
+            return detail::find_pattern_with_kernel(region, pattern, kernel, occurrence);
+        }
     } // namespace unchecked
 
 } // namespace DetourModKit::scan
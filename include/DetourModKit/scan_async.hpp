@@ -0,0 +1,145 @@
+#ifndef DETOURMODKIT_SCAN_ASYNC_HPP
+#define DETOURMODKIT_SCAN_ASYNC_HPP
+
+/**
+ * @file scan_async.hpp
+ * @brief Background resolves: @ref scan::resolve and @ref scan::resolve_batch on a library-owned thread, with a
+ *        waitable future and an optional completion callback.
+ * @details Both blocking resolvers keep the caller idle while they sweep the image. @ref scan::resolve_async and
+ *          @ref scan::resolve_batch_async start the same resolve on a DMK-owned worker thread and return at once, so
+ *          startup work that does not depend on the outstanding signatures -- logger and config setup, input
+ *          bindings, hooks whose targets are already known -- runs while the scans continue. The verdicts are exactly
+ *          the blocking calls': the worker runs the same resolver over an owned copy of the requests.
+ *
+ *          Each call owns one worker thread whose lifetime is tied to the returned future. The thread takes a counted
+ *          reference on the library module (see @ref StoppableWorker), so its code stays mapped even if the future
+ *          leaks past unload. An attached @ref scan::ResolutionCache is still borrowed and must outlive the resolve.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace scan
+    {
+        /// Completion callback for @ref resolve_async; runs once on the worker thread with the final result.
+        using ResolveCallback = std::move_only_function<void(const Result<Hit> &)>;
+
+        /// The outcome of a batch resolve, as @ref resolve_batch returns it.
+        using BatchResult = Result<std::vector<Result<Hit>>>;
+
+        /// Completion callback for @ref resolve_batch_async; runs once on the worker thread with the final result.
+        using BatchResolveCallback = std::move_only_function<void(const BatchResult &)>;
+
+        /**
+         * @class ResolveFuture
+         * @brief The pending result of one @ref resolve_async call.
+         * @details Move-only. Destroying a future whose resolve is still running blocks until the resolve and its
+         *          callback finish (a resolve cannot be interrupted mid-sweep), except under the loader lock or on the
+         *          worker thread itself -- a callback releasing its own future -- where the thread is detached.
+         * @note Setup/control-plane only: waiting blocks the calling thread.
+         */
+        class ResolveFuture
+        {
+        public:
+            ResolveFuture(ResolveFuture &&) noexcept;
+            ResolveFuture &operator=(ResolveFuture &&) noexcept;
+            ResolveFuture(const ResolveFuture &) = delete;
+            ResolveFuture &operator=(const ResolveFuture &) = delete;
+            ~ResolveFuture() noexcept;
+
+            /// True once the result is available; never blocks.
+            [[nodiscard]] bool ready() const noexcept;
+
+            /// Blocks until the result is available.
+            void wait() const noexcept;
+
+            /// Blocks up to @p timeout; returns true when the result is available.
+            [[nodiscard]] bool wait_for(std::chrono::milliseconds timeout) const noexcept;
+
+            /**
+             * @brief Blocks until the result is available and returns it.
+             * @return The result @ref resolve would have returned. The reference lives as long as the future. A
+             *         moved-from future returns Error{InvalidArg}.
+             */
+            [[nodiscard]] const Result<Hit> &get() const noexcept;
+
+        private:
+            friend Result<ResolveFuture> resolve_async(OwnedScanRequest request, ResolveCallback on_complete) noexcept;
+            struct Impl;
+            explicit ResolveFuture(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+
+        /**
+         * @class BatchResolveFuture
+         * @brief The pending result of one @ref resolve_batch_async call; the same contract as @ref ResolveFuture.
+         */
+        class BatchResolveFuture
+        {
+        public:
+            BatchResolveFuture(BatchResolveFuture &&) noexcept;
+            BatchResolveFuture &operator=(BatchResolveFuture &&) noexcept;
+            BatchResolveFuture(const BatchResolveFuture &) = delete;
+            BatchResolveFuture &operator=(const BatchResolveFuture &) = delete;
+            ~BatchResolveFuture() noexcept;
+
+            /// True once the result is available; never blocks.
+            [[nodiscard]] bool ready() const noexcept;
+
+            /// Blocks until the result is available.
+            void wait() const noexcept;
+
+            /// Blocks up to @p timeout; returns true when the result is available.
+            [[nodiscard]] bool wait_for(std::chrono::milliseconds timeout) const noexcept;
+
+            /**
+             * @brief Blocks until the result is available and returns it.
+             * @return The result @ref resolve_batch would have returned, in input order. The reference lives as long
+             *         as the future. A moved-from future returns Error{InvalidArg}.
+             */
+            [[nodiscard]] const BatchResult &get() const noexcept;
+
+        private:
+            friend Result<BatchResolveFuture> resolve_batch_async(std::vector<OwnedScanRequest> requests,
+                                                                  std::size_t max_workers,
+                                                                  BatchResolveCallback on_complete) noexcept;
+            struct Impl;
+            explicit BatchResolveFuture(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+
+        /**
+         * @brief Starts @ref resolve on a library-owned worker thread and returns without waiting.
+         * @param request The request, owned by the resolve for its whole run.
+         * @param on_complete Optional callback, run once on the worker thread after the result is published. A throw
+         *                    from it is swallowed. It must not wait on its own future.
+         * @return The future, or Error{OutOfMemory} / Error{SystemCallFailed} when the worker could not be started;
+         *         nothing runs in that case and @p on_complete is never called.
+         * @note Setup/control-plane only: starts a thread. Never call it under the loader lock.
+         */
+        [[nodiscard]] Result<ResolveFuture> resolve_async(OwnedScanRequest request,
+                                                          ResolveCallback on_complete = {}) noexcept;
+
+        /**
+         * @brief Starts @ref resolve_batch on a library-owned worker thread and returns without waiting.
+         * @param requests The requests, owned by the resolve for its whole run.
+         * @param max_workers Forwarded to @ref resolve_batch (0 = auto); the batch fans out from the worker thread.
+         * @param on_complete Optional callback with the same contract as @ref resolve_async's.
+         * @return The future, or Error{OutOfMemory} / Error{SystemCallFailed} when the worker could not be started.
+         * @note Setup/control-plane only: starts a thread that in turn spawns the batch's worker pool.
+         */
+        [[nodiscard]] Result<BatchResolveFuture> resolve_batch_async(std::vector<OwnedScanRequest> requests,
+                                                                     std::size_t max_workers = 0,
+                                                                     BatchResolveCallback on_complete = {}) noexcept;
+    } // namespace scan
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SCAN_ASYNC_HPP
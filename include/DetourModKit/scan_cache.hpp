@@ -0,0 +1,244 @@
+#ifndef DETOURMODKIT_SCAN_CACHE_HPP
+#define DETOURMODKIT_SCAN_CACHE_HPP
+
+/**
+ * @file scan_cache.hpp
+ * @brief Opt-in persistent resolution cache: remembers each resolved byte-tier Hit as an RVA keyed on module identity.
+ * @details A game binary rarely changes between launches, yet every launch re-runs the full @ref scan::resolve ladder
+ *          over the whole image. A @ref scan::ResolutionCache attached to a request (@ref scan::ScanRequest::cache, or
+ *          @ref anchor::ScanProfile::resolution_cache for an anchor table) records the winning candidate and its
+ *          match site as image-relative offsets, keyed on the scope module's @ref scan::ModuleIdentity (PE
+ *          TimeDateStamp, SizeOfImage, and a hash of its section headers). On a warm start the resolver re-verifies
+ *          the cached site with @ref scan::Pattern::matches_at, re-derives the address through the same Direct /
+ *          RipRelative decode, applies the same scope and executable gates, and returns it without sweeping the image.
+ *          Any mismatch -- a different build, a patched or hooked site, a decode that disagrees -- falls back to the
+ *          full ladder, whose result then replaces the stale entry.
+ *
+ *          What the cache deliberately does not re-prove is uniqueness: a warm hit trusts that the byte-identical image
+ *          that once had exactly one match still has exactly one. That holds for the unmodified on-disk image the
+ *          identity describes; a caller who also needs live-memory uniqueness (another mod may have written a twin)
+ *          resolves without a cache. Only byte-tier wins of jump-free patterns are cached; text tiers, bounded-jump
+ *          patterns, and prologue-recovery hits always resolve in full.
+ *
+ *          Within one process, several mods each link their own copy of the library and would each sweep the same
+ *          game image for the same signatures. @ref scan::ResolutionCache::share_in_process opts a cache into a
+ *          process-wide table, backed by a named file mapping, through which every opted-in instance publishes its
+ *          wins and consults the others' before scanning. A shared entry is re-verified exactly like a local one.
+ *
+ * @note The on-disk form is a line-oriented text file in the style of the drift manifest (a versioned header, one
+ *       tab-separated line per entry). It is a regenerable accelerator, never load-bearing state: a torn or corrupt
+ *       file loads as an error the caller can ignore, and every entry is re-verified before use anyway.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        struct ResolutionCacheAccess;
+    } // namespace detail
+
+    namespace scan
+    {
+        /**
+         * @struct ModuleIdentity
+         * @brief The build identity of a mapped PE image: link timestamp, image size, and a section-layout hash.
+         * @details Two images with equal identities are, for the cache's purposes, the same build: the linker stamps
+         *          TimeDateStamp per link, SizeOfImage changes with any section growth, and the section-header hash
+         *          (names, virtual addresses and sizes, raw sizes, characteristics) catches a rebuild whose timestamp
+         *          was zeroed for reproducibility. None of the three depends on the load address, so an identity is
+         *          stable across ASLR relocations.
+         */
+        struct ModuleIdentity
+        {
+            /// IMAGE_FILE_HEADER::TimeDateStamp.
+            std::uint32_t time_date_stamp = 0;
+            /// IMAGE_OPTIONAL_HEADER64::SizeOfImage.
+            std::uint32_t size_of_image = 0;
+            /// FNV-1a 64 over every IMAGE_SECTION_HEADER.
+            std::uint64_t section_hash = 0;
+
+            [[nodiscard]] bool operator==(const ModuleIdentity &) const noexcept = default;
+        };
+
+        /**
+         * @brief Reads the @ref ModuleIdentity of the PE image mapped at @p module.
+         * @param module A module image region (Region::host(), Region::module_named(...)).
+         * @return The identity, or ErrorCode::InvalidRange when the region is empty, its DOS / NT headers do not
+         *         validate as PE32+, or the section table lies outside the image.
+         * @note Setup/control-plane only: a bounded sequence of guarded header reads.
+         */
+        [[nodiscard]] Result<ModuleIdentity> module_identity(Region module) noexcept;
+
+        /**
+         * @struct ResolutionCacheStats
+         * @brief Lookup counters for one @ref ResolutionCache, for confirming a warm start actually skipped its scans.
+         */
+        struct ResolutionCacheStats
+        {
+            /// Lookups answered from a re-verified entry.
+            std::size_t hits = 0;
+            /// Lookups with no entry, or an entry recorded against a different module identity.
+            std::size_t misses = 0;
+            /// Lookups whose entry matched the identity but failed re-verification (the full ladder then ran).
+            std::size_t rejected = 0;
+            /// The subset of @ref hits answered from an entry another instance published to the shared table.
+            std::size_t shared_hits = 0;
+        };
+
+        /**
+         * @struct TierStats
+         * @brief What one ladder tier of a @ref CandidateOrder::Adaptive request did over its recorded resolves.
+         * @details Every attempt lands in exactly one of the three outcome counters. The counters are halved together
+         *          once a tier has been tried @ref ResolutionCache::TIER_HISTORY_WINDOW times, so the order follows a
+         *          game patch that retires a tier instead of trusting its old record forever.
+         */
+        struct TierStats
+        {
+            /// Attempts that resolved (the tier won the walk).
+            std::uint32_t hits = 0;
+            /// Attempts with no usable match: absent, incomplete, out of scope, or a rejected decode.
+            std::uint32_t misses = 0;
+            /// Attempts whose byte pattern matched more than once in scope.
+            std::uint32_t ambiguous = 0;
+            /// Wall-clock microseconds spent across all attempts, halved with the counters.
+            std::uint64_t micros = 0;
+
+            /// The attempts behind these counters.
+            [[nodiscard]] std::uint64_t attempts() const noexcept
+            {
+                return std::uint64_t{hits} + std::uint64_t{misses} + std::uint64_t{ambiguous};
+            }
+
+            [[nodiscard]] bool operator==(const TierStats &) const noexcept = default;
+        };
+
+        /**
+         * @class ResolutionCache
+         * @brief A thread-safe set of remembered resolutions, optionally persisted between launches.
+         * @details Entries are keyed by a stable hash of the request's ladder content and resolve policy (the same
+         *          candidate hash the anchor drift fingerprint uses), so renaming a label keeps its entry while
+         *          editing a pattern invalidates it. One entry is kept per key: a request resolved against a new build
+         *          overwrites its stale entry instead of accumulating one per game version. The cache is shared by
+         *          pointer, so a single instance can serve every request of a batch resolve concurrently; its internal
+         *          lock is held only for the map lookup or update, never across a scan.
+         *
+         *          For a @ref CandidateOrder::Adaptive request the cache also keeps a @ref TierStats per ladder tier,
+         *          under the same key but not tied to a module identity: after a patch the winning entry goes stale,
+         *          and that is exactly when knowing which tier has been resolving pays off.
+         * @note Setup/control-plane only: lookups and updates take a lock and may allocate.
+         */
+        class ResolutionCache
+        {
+        public:
+            /// Attempts after which a tier's @ref TierStats are halved, so old outcomes fade.
+            static constexpr std::uint32_t TIER_HISTORY_WINDOW = 64;
+            /// Ladder tiers a key keeps history for; tiers past this are always ordered as untried.
+            static constexpr std::size_t TIER_HISTORY_MAX_TIERS = 64;
+
+            /// Creates an empty cache.
+            ResolutionCache();
+            ~ResolutionCache() noexcept;
+
+            ResolutionCache(ResolutionCache &&other) noexcept;
+            ResolutionCache &operator=(ResolutionCache &&other) noexcept;
+            ResolutionCache(const ResolutionCache &) = delete;
+            ResolutionCache &operator=(const ResolutionCache &) = delete;
+
+            /**
+             * @brief Parses a cache produced by @ref serialize.
+             * @return The cache, or ErrorCode::MissingHeader (no or wrong-version header line) /
+             *         ErrorCode::MalformedLine (a bad entry, tier-history or calibration line). Blank lines and CRLF
+             *         line endings are tolerated, and a v1 file (entries only) or v2 file (no calibration) still loads.
+             */
+            [[nodiscard]] static Result<ResolutionCache> parse(std::string_view text);
+
+            /**
+             * @brief Reads and parses a cache file.
+             * @return The cache, ErrorCode::FileOpenFailed when the file cannot be opened, or a @ref parse error. A
+             *         first launch sees FileOpenFailed and simply starts from an empty cache.
+             */
+            [[nodiscard]] static Result<ResolutionCache> load(const std::filesystem::path &path);
+
+            /// Serializes every entry to the versioned, line-oriented text form @ref parse reads back.
+            [[nodiscard]] std::string serialize() const;
+
+            /**
+             * @brief Writes @ref serialize to @p path, truncating it.
+             * @return An empty Result, ErrorCode::FileOpenFailed, or ErrorCode::FileWriteFailed (opened but the write
+             *         or close did not complete). The write is not atomic; a torn file fails @ref load next launch and
+             *         the cache is rebuilt, which is safe because it is only an accelerator.
+             */
+            [[nodiscard]] Result<void> save(const std::filesystem::path &path) const;
+
+            /// Number of remembered resolutions.
+            [[nodiscard]] std::size_t size() const noexcept;
+
+            /// Forgets every entry, all tier history and the calibration, and resets the lookup counters.
+            void clear() noexcept;
+
+            /**
+             * @brief The recorded @ref TierStats of @p request's ladder, one per declared tier.
+             * @return A vector of request.ladder.size() stats, all zero for a request with no history; empty on a
+             *         moved-from cache.
+             * @throws std::bad_alloc if the vector cannot be allocated.
+             */
+            [[nodiscard]] std::vector<TierStats> tier_history(const ScanRequest &request) const;
+
+            /// The lookup counters accumulated since construction, load, or the last @ref clear.
+            [[nodiscard]] ResolutionCacheStats stats() const noexcept;
+
+            /**
+             * @brief The @ref SimdCalibration recorded by @ref record_calibration or loaded from a v3 file.
+             * @details Not tied to a module identity: it describes the host, and its SimdCalibration::host_key says
+             *          which one. @ref calibrate_simd only reuses it when that key matches the running host.
+             */
+            [[nodiscard]] std::optional<SimdCalibration> calibration() const noexcept;
+
+            /// Remembers @p calibration, replacing any earlier one; @ref serialize writes it.
+            void record_calibration(const SimdCalibration &calibration) noexcept;
+
+            /**
+             * @brief Joins the process-wide resolution table shared by every DetourModKit instance in this process.
+             * @details Once joined, a lookup that misses this cache's own entries consults the table before the
+             *          resolver scans, and every win this cache records is also published to it, so the first mod to
+             *          resolve a signature spares the others the sweep. The table is a named, pagefile-backed file
+             *          mapping private to the process and to this major version of the library; instances of another
+             *          major version use a different table. Its entries are hints: one adopted from the table passes
+             *          the same identity, live-byte, decode, and scope checks as a local entry, and only after that is
+             *          it copied into this cache (and so into @ref save). Joining again is a no-op. A moved-from cache
+             *          cannot join.
+             * @return An empty Result; ErrorCode::SystemCallFailed (detail = GetLastError()) when the mapping cannot
+             *         be created or mapped; ErrorCode::InvalidRange when a mapping of that name exists but does not
+             *         hold a table of this layout; ErrorCode::InvalidArg on a moved-from cache. On failure the cache
+             *         keeps working unshared.
+             * @note Setup/control-plane only: creates or opens a kernel object.
+             */
+            [[nodiscard]] Result<void> share_in_process() noexcept;
+
+            /// True once @ref share_in_process has succeeded.
+            [[nodiscard]] bool shares_in_process() const noexcept;
+
+        private:
+            // The entry map, its lock, the counters, and the shared-table view live in scan_cache.cpp; the resolver
+            // reaches them through detail::ResolutionCacheAccess.
+            friend struct detail::ResolutionCacheAccess;
+            struct Impl;
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace scan
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SCAN_CACHE_HPP
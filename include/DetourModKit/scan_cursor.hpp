@@ -0,0 +1,115 @@
+#ifndef DETOURMODKIT_SCAN_CURSOR_HPP
+#define DETOURMODKIT_SCAN_CURSOR_HPP
+
+/**
+ * @file scan_cursor.hpp
+ * @brief Resumable, time-sliced page-gated scan: one @ref scan::scan spread across as many frames as it takes.
+ * @details A signature that can only be resolved late (its module loads mid-game, or the resolve must run on the game
+ *          thread) cannot afford a full @ref scan::scan in one go: a sweep over a large image stalls a frame for tens
+ *          of milliseconds. A @ref scan::ScanCursor holds the page walk's position between calls; each
+ *          @ref scan::ScanCursor::step advances it slice by slice until its time budget is spent, then returns the
+ *          progress so far. The frame-driven shape mirrors @ref rtti::HealScheduler::tick.
+ *
+ *          The verdict is exactly the one @ref scan::scan would return for the same arguments: slices own the matches
+ *          that start inside them and read one match length past their end, so the Nth occurrence, the skipped-fault
+ *          and bounded-jump-budget fail-closed rules, and the needle self-exclusion are the serial walk's. The bytes
+ *          are read live slice by slice, so memory rewritten behind the cursor between steps is not re-read -- the
+ *          same as a write racing a @ref scan::scan that has already passed it.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+
+namespace DetourModKit
+{
+    namespace scan
+    {
+        /**
+         * @brief Most bytes of the page walk one cursor slice scans before the cursor re-checks its time budget.
+         * @details 1 MiB keeps a slice well under a millisecond at the engine's sweep rate, so a step overruns its
+         *          budget by at most one slice. A VirtualQuery region larger than this is split across slices.
+         */
+        inline constexpr std::size_t SCAN_CURSOR_SLICE_BYTES = std::size_t{1} << 20;
+
+        /**
+         * @struct ScanProgress
+         * @brief How far a @ref ScanCursor has walked its scope.
+         */
+        struct ScanProgress
+        {
+            /// Bytes of the scope behind the cursor, including skipped uncommitted or rejected regions.
+            std::size_t scanned_bytes = 0;
+            /// The scope's size in bytes.
+            std::size_t total_bytes = 0;
+            /// True once the verdict is known (@ref ScanCursor::result is set); it may arrive before the scope ends.
+            bool done = false;
+        };
+
+        /**
+         * @class ScanCursor
+         * @brief A page-gated @ref scan::scan that runs a bounded slice of its walk per @ref step.
+         * @details The cursor compiles its own copy of the pattern at @ref start, so the Pattern need not outlive it.
+         *          A step always scans at least one slice, so a loop of steps terminates even with a zero budget. A
+         *          moved-from cursor reports done with ErrorCode::InvalidArg.
+         * @note Single-owner and move-only; drive it from one thread. Each step is setup/control-plane work in
+         *       miniature: it walks the OS page map and reads memory under a fault guard, for a bounded time.
+         */
+        class ScanCursor
+        {
+        public:
+            /**
+             * @brief Validates the arguments and prepares a cursor at the start of @p scope.
+             * @param pattern The compiled signature.
+             * @param scope The memory range to search.
+             * @param occurrence Which match to find (1-based).
+             * @param pages Which page-protection class to accept.
+             * @return The cursor, or the error @ref scan::scan reports before it reads any memory: NoMatch for
+             *         occurrence 0, InvalidArg for an unknown @p pages, InvalidRange for an empty scope, OutOfMemory.
+             * @note Samples the scope's byte frequencies once (a bounded 256 KiB of guarded reads) to pick the anchor
+             *       byte, as @ref scan::scan does.
+             */
+            [[nodiscard]] static Result<ScanCursor> start(const Pattern &pattern, Region scope,
+                                                          std::size_t occurrence = 1,
+                                                          Pages pages = Pages::Readable) noexcept;
+
+            ScanCursor(ScanCursor &&) noexcept;
+            ScanCursor &operator=(ScanCursor &&) noexcept;
+            ScanCursor(const ScanCursor &) = delete;
+            ScanCursor &operator=(const ScanCursor &) = delete;
+            ~ScanCursor() noexcept;
+
+            /**
+             * @brief Scans slices until @p budget has elapsed, the match is found, or the scope is exhausted.
+             * @details The clock is checked between slices, so a step may overrun @p budget by up to one slice of
+             *          @ref SCAN_CURSOR_SLICE_BYTES. Once done, further steps return the final progress unchanged.
+             */
+            ScanProgress step(std::chrono::microseconds budget) noexcept;
+
+            /// The current progress, without scanning.
+            [[nodiscard]] ScanProgress progress() const noexcept;
+
+            /// True once the verdict is known.
+            [[nodiscard]] bool done() const noexcept;
+
+            /**
+             * @brief The verdict, once @ref done: the Nth match's address or the error @ref scan::scan would return.
+             * @return Empty while the walk is still running.
+             */
+            [[nodiscard]] std::optional<Result<Address>> result() const noexcept;
+
+        private:
+            struct Impl;
+            explicit ScanCursor(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace scan
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SCAN_CURSOR_HPP
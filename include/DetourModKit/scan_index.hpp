@@ -0,0 +1,148 @@
+#ifndef DETOURMODKIT_SCAN_INDEX_HPP
+#define DETOURMODKIT_SCAN_INDEX_HPP
+
+/**
+ * @file scan_index.hpp
+ * @brief An optional 4-gram inverted index over a module's code, for tooling that scans the same image many times.
+ * @details Every @ref scan::scan reads the whole scope again. That is right for a mod resolving its signatures once
+ *          at startup. It is wasteful for a tool that runs hundreds of queries against one image: a live signature
+ *          editor re-scanning on each keystroke, a health report re-run after each edit, a repair search trying
+ *          variants. A @ref scan::CodeIndex reads the image once and records, for every 4-byte sequence (a 4-gram)
+ *          it contains, the sorted positions where it starts. A pattern with a run of four fully-known bytes is then
+ *          answered from the posting lists of its grams: the shortest list supplies the candidate sites, the
+ *          next-shortest filters them by intersection, and only the survivors are compared against live memory.
+ *
+ *          The image is cut into shards of up to @ref scan::CODE_INDEX_SHARD_BYTES. Shards are built in parallel, and
+ *          each keeps its own sorted gram directory and delta-encoded (LEB128) posting lists, so a position costs
+ *          one to three bytes plus its share of the directory. @ref scan::CodeIndexStats reports the resident size
+ *          so a tool can decide whether the index pays for itself on a given image.
+ *
+ *          The index is a snapshot of the bytes at build time; every answer is re-verified against live memory.
+ *          A site that stopped matching after the build is therefore never reported, but a site that started
+ *          matching after the build is missed until the index is rebuilt. A pattern the index cannot narrow (one
+ *          with `[X-Y]` jumps, or without four consecutive fully-known bytes) is answered by a live scan of the
+ *          indexed scope instead, with the same result.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <span>
+
+namespace DetourModKit
+{
+    namespace scan
+    {
+        /// Largest slice of the image one index shard covers; positions inside a shard are 32-bit offsets.
+        inline constexpr std::size_t CODE_INDEX_SHARD_BYTES = std::size_t{4} << 20;
+
+        /**
+         * @struct CodeIndexOptions
+         * @brief What a @ref CodeIndex build reads, how wide it runs, and how much memory it may keep.
+         */
+        struct CodeIndexOptions
+        {
+            /// Which page class is indexed; Executable indexes code only, which is what signatures target.
+            Pages pages = Pages::Executable;
+            /// Upper bound on worker threads for the build (0 = auto); a call from inside a worker runs serially.
+            std::size_t max_workers = 0;
+            /**
+             * @brief Most resident bytes the finished index may keep (0 = no limit). A build that would exceed it
+             *        fails with OutOfMemory rather than keeping an index larger than the caller budgeted.
+             */
+            std::size_t memory_budget = 0;
+        };
+
+        /**
+         * @struct CodeIndexStats
+         * @brief What a @ref CodeIndex covers and what it costs to keep.
+         */
+        struct CodeIndexStats
+        {
+            /// Bytes of the scope the index covers.
+            std::size_t indexed_bytes = 0;
+            /// Shards the covered bytes were cut into.
+            std::size_t shards = 0;
+            /// Distinct 4-grams, summed over the shards.
+            std::size_t grams = 0;
+            /// Positions recorded across every posting list.
+            std::size_t postings = 0;
+            /// Bytes the directories and posting lists keep resident.
+            std::size_t resident_bytes = 0;
+            /// False when a shard faulted during the build; its bytes are then answered by a live scan.
+            bool complete = true;
+
+            /// Resident bytes per indexed byte; 0 for an empty index.
+            [[nodiscard]] constexpr double bytes_per_indexed_byte() const noexcept
+            {
+                return indexed_bytes == 0
+                           ? 0.0
+                           : static_cast<double>(resident_bytes) / static_cast<double>(indexed_bytes);
+            }
+        };
+
+        /**
+         * @class CodeIndex
+         * @brief A 4-gram inverted index of one scope, answering @ref scan::scan and @ref scan::find_all queries.
+         * @details Answers are exactly those of the live scan over the indexed scope and page class, provided the
+         *          bytes have not changed since the build. Queries only read the index and live memory, so several
+         *          threads may query one index at once.
+         * @note Move-only. The build and every query are setup/control-plane work: the build reads every indexed
+         *       page and spawns worker threads for the duration of the call.
+         */
+        class CodeIndex
+        {
+        public:
+            /**
+             * @brief Indexes every 4-gram of @p scope's pages of the requested class.
+             * @return The index, or InvalidArg for an out-of-range page class, InvalidRange for an empty scope, or
+             *         OutOfMemory when an allocation failed or the index outgrew @ref CodeIndexOptions::memory_budget
+             *         (the error's detail then holds the size it would have kept).
+             */
+            [[nodiscard]] static Result<CodeIndex> build(Region scope, const CodeIndexOptions &options = {}) noexcept;
+
+            CodeIndex(CodeIndex &&) noexcept;
+            CodeIndex &operator=(CodeIndex &&) noexcept;
+            CodeIndex(const CodeIndex &) = delete;
+            CodeIndex &operator=(const CodeIndex &) = delete;
+            ~CodeIndex() noexcept;
+
+            /// True when @p pattern is answered from the posting lists rather than by a live scan.
+            [[nodiscard]] bool accelerates(const Pattern &pattern) const noexcept;
+
+            /**
+             * @brief The Nth match of @p pattern in the indexed scope, as @ref scan::scan returns it.
+             * @return The match address (adjusted by the `|` offset), NoMatch when there are fewer than
+             *         @p occurrence matches or @p occurrence is 0, InvalidArg for a moved-from index, or the errors
+             *         of the live scan a non-accelerated pattern falls back to.
+             */
+            [[nodiscard]] Result<Address> scan(const Pattern &pattern, std::size_t occurrence = 1) const noexcept;
+
+            /**
+             * @brief Writes the first matches of @p pattern in the indexed scope to @p out, in ascending order.
+             * @return The MatchSummary as @ref scan::find_all reports it, with MatchSummary::faulted also set when a
+             *         shard faulted at build time or a candidate faulted during verification. InvalidArg for a
+             *         moved-from index.
+             */
+            [[nodiscard]] Result<MatchSummary> find_all(const Pattern &pattern, std::span<Address> out) const noexcept;
+
+            /// The scope the index was built over; empty for a moved-from index.
+            [[nodiscard]] Region scope() const noexcept;
+
+            /// Coverage and memory figures.
+            [[nodiscard]] CodeIndexStats stats() const noexcept;
+
+        private:
+            // The shards and their directories live in scan_index.cpp.
+            struct Impl;
+            explicit CodeIndex(std::unique_ptr<Impl> impl) noexcept;
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace scan
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SCAN_INDEX_HPP
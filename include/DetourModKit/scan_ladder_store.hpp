@@ -0,0 +1,155 @@
+#ifndef DETOURMODKIT_SCAN_LADDER_STORE_HPP
+#define DETOURMODKIT_SCAN_LADDER_STORE_HPP
+
+/**
+ * @file scan_ladder_store.hpp
+ * @brief Flyweight storage for candidate ladders: interned names, pattern bytes and literals behind 32-bit handles.
+ * @details A @ref scan::Candidate is built to be self-contained, which makes it large: its Pattern carries the
+ *          fixed-capacity byte, mask and jump arrays inline whatever the pattern's real length, and its name and text
+ *          payloads are separate strings. A manifest of a few hundred signatures with multi-tier ladders therefore
+ *          keeps hundreds of kilobytes of mostly-empty arrays resident, spread across one vector and many small
+ *          strings per ladder, for data read only at startup and on a reload.
+ *
+ *          A @ref scan::LadderStore keeps the same ladders packed: each rung is a small fixed-size record in one
+ *          contiguous array, a pattern stores only its used bytes and mask, and every name, mangled type name and
+ *          literal is interned once in a shared character pool. Identical patterns, strings and whole ladders are
+ *          stored once, so a ladder added twice (two requests sharing a fallback ladder, a reloaded manifest) returns
+ *          the handle it already has. A @ref scan::LadderHandle is a 32-bit index, cheap to keep in a registration
+ *          table in place of an owned std::vector<Candidate>.
+ *
+ *          Resolution still takes Candidate objects, so @ref scan::LadderStore::resolve rebuilds the handle's ladder
+ *          for the duration of the call. The rebuilt candidates carry the same content as the ones added (the
+ *          compiled bytes, mask, offset, jumps and decode parameters), so a @ref scan::ResolutionCache keys them
+ *          identically and a resolve through the store returns what resolving the original ladder returns.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace scan
+    {
+        /**
+         * @enum LadderHandle
+         * @brief A compact reference to one ladder in a @ref LadderStore; meaningful only to the store that issued it.
+         */
+        enum class LadderHandle : std::uint32_t
+        {
+            /// Never issued; every lookup through it reports an unknown handle.
+            Invalid = 0xFFFFFFFFu
+        };
+
+        /**
+         * @struct LadderStoreStats
+         * @brief What a @ref LadderStore holds and what holding the same ladders as Candidates would cost.
+         */
+        struct LadderStoreStats
+        {
+            /// Distinct ladders stored (handles issued).
+            std::size_t ladders = 0;
+            /// Rung records across the distinct ladders.
+            std::size_t rungs = 0;
+            /// Distinct patterns in the pattern pool.
+            std::size_t patterns = 0;
+            /// Distinct strings in the string pool (names, mangled names, literals).
+            std::size_t strings = 0;
+            /// Ladders submitted to @ref LadderStore::add, counting each duplicate again.
+            std::size_t ladders_added = 0;
+            /// Bytes the store's pools and tables have reserved.
+            std::size_t resident_bytes = 0;
+            /**
+             * @brief Bytes the submitted ladders would occupy as std::vector<Candidate> storage.
+             * @details sizeof(Candidate) per submitted rung plus the characters of every string too long for the
+             *          small-string buffer. Counts every submission, so it is the footprint the store replaces.
+             */
+            std::size_t candidate_bytes = 0;
+        };
+
+        /**
+         * @class LadderStore
+         * @brief An arena of interned candidate ladders, each referenced by a @ref LadderHandle.
+         * @details Append-only: a ladder once added stays until @ref clear, and a handle stays valid until then. Adding
+         *          is not synchronized with anything; build the store at init, after which the const members are safe
+         *          to call from several threads at once. Move-only; a moved-from store is empty and reports every
+         *          handle as unknown.
+         * @note Setup/control-plane only: adding and resolving allocate.
+         */
+        class LadderStore
+        {
+        public:
+            /// Most rungs one ladder may hold; far above any hand-written ladder.
+            static constexpr std::size_t MAX_LADDER_RUNGS = 0xFFFF;
+
+            /// Creates an empty store.
+            LadderStore();
+            ~LadderStore() noexcept;
+
+            LadderStore(LadderStore &&other) noexcept;
+            LadderStore &operator=(LadderStore &&other) noexcept;
+            LadderStore(const LadderStore &) = delete;
+            LadderStore &operator=(const LadderStore &) = delete;
+
+            /**
+             * @brief Interns @p ladder and returns its handle.
+             * @param ladder The candidates, in resolve order; copied in, not retained.
+             * @return The ladder's handle -- the existing one when an identical ladder (same names and content, in the
+             *         same order) was added before. ErrorCode::EmptyCandidates for an empty ladder;
+             *         ErrorCode::InvalidArg for a ladder over @ref MAX_LADDER_RUNGS, a pool that would pass 4 GiB, or a
+             *         moved-from store; ErrorCode::OutOfMemory when a pool cannot grow. A failed add leaves every
+             *         existing handle valid.
+             */
+            [[nodiscard]] Result<LadderHandle> add(std::span<const Candidate> ladder) noexcept;
+
+            /// True when @p handle names a ladder in this store.
+            [[nodiscard]] bool contains(LadderHandle handle) const noexcept;
+
+            /// Number of rungs in @p handle's ladder; 0 for an unknown handle.
+            [[nodiscard]] std::size_t size(LadderHandle handle) const noexcept;
+
+            /**
+             * @brief The interned name of rung @p rung of @p handle's ladder.
+             * @return A view into the store's string pool, valid until @ref clear or the store is destroyed or moved
+             *         from; empty for an unknown handle or an out-of-range rung.
+             */
+            [[nodiscard]] std::string_view name(LadderHandle handle, std::size_t rung) const noexcept;
+
+            /**
+             * @brief Rebuilds @p handle's ladder as owned Candidates.
+             * @return The candidates in the order they were added; ErrorCode::InvalidArg for an unknown handle;
+             *         ErrorCode::OutOfMemory when the vector or a name cannot be allocated.
+             */
+            [[nodiscard]] Result<std::vector<Candidate>> ladder(LadderHandle handle) const noexcept;
+
+            /**
+             * @brief Resolves @p handle's ladder under @p policy.
+             * @param handle The ladder to try.
+             * @param policy Scope and policy for the resolve; its own ladder is ignored and replaced by the handle's.
+             * @return Exactly what @ref scan::resolve returns for the rebuilt ladder under @p policy, or a
+             *         @ref ladder error for an unknown handle or a failed rebuild.
+             * @note Not noexcept, for the same reason @ref scan::resolve is not.
+             */
+            [[nodiscard]] Result<Hit> resolve(LadderHandle handle, ScanRequest policy) const;
+
+            /// What the store holds and the footprint it replaces.
+            [[nodiscard]] LadderStoreStats stats() const noexcept;
+
+            /// Drops every ladder, pattern and string; every issued handle becomes unknown.
+            void clear() noexcept;
+
+        private:
+            // The rung, pattern and string pools and their intern indexes live in scan_ladder_store.cpp.
+            struct Impl;
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace scan
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SCAN_LADDER_STORE_HPP
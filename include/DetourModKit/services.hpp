@@ -0,0 +1,112 @@
+#ifndef DETOURMODKIT_SERVICES_HPP
+#define DETOURMODKIT_SERVICES_HPP
+
+/**
+ * @file services.hpp
+ * @brief Opt-in process-wide shared services: several DetourModKit-based mods in one game share one background
+ *        scheduler, one keyboard/mouse poll sweep, and one page-protection cache.
+ * @details Each mod links its own copy of the library, so three mods in one game otherwise run three background
+ *          service threads, three input poll threads each calling GetAsyncKeyState for its own keys, and three
+ *          protection caches each paying its own VirtualQuery for the same game code. @ref services::enable joins a
+ *          per-process registry kept in a named file mapping. The first instance to join hosts it; a later one
+ *          attaches, provided the host speaks the same services ABI major version (see @ref services::ABI_MAJOR),
+ *          and otherwise runs standalone exactly as before.
+ *
+ *          While attached:
+ *          - Background tasks this instance registers (the memory cache's cleanup, the diagnostics export refresh)
+ *            run on the host's service thread, reached through a function table the host exports, so no service
+ *            thread of this instance starts for them. Tasks registered before enable() stay where they are.
+ *          - The instance that owns the process's key sweep (the first joined instance whose poll thread runs)
+ *            samples every joined instance's binding keys once per cycle and publishes the result; the other poll
+ *            threads read a sweep at most two poll intervals old instead of calling GetAsyncKeyState, and fall back to
+ *            their own calls when the sweep is older or does not cover a key.
+ *          - A protection-cache miss on committed, non-writable image memory (code and read-only data, the regions
+ *            the cache pins) is answered from a process-wide table when another instance already queried the region;
+ *            every instance's memory::invalidate_range retires the whole table.
+ *
+ *          When the host leaves (disable(), or its Session teardown), it first stops serving every attached
+ *          instance's tasks and hands them back to their own background services, so each attached instance carries
+ *          on standalone. A later enable() may host again.
+ * @note Setup/control-plane only. The library's code keeps running from each mod's own module, so a host must leave
+ *       through disable() or its Session teardown before its DLL unloads; an explicit FreeLibrary without either
+ *       leaves the attached instances calling into unmapped code.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourModKit
+{
+    namespace services
+    {
+        /// Incompatible revisions of the exported function tables; instances with different majors never attach.
+        inline constexpr std::uint32_t ABI_MAJOR = 1;
+        /// Backward-compatible revisions: a newer minor only appends table members an older instance ignores.
+        inline constexpr std::uint32_t ABI_MINOR = 0;
+
+        /// How this instance takes part in the process-wide registry.
+        enum class Role : std::uint8_t
+        {
+            /// Not joined, or joined but unable to attach (see Status::host_abi_major).
+            Standalone,
+            /// Joined first: other instances' tasks run on this instance's service thread.
+            Host,
+            /// Joined a host: this instance's new background tasks run on the host's service thread.
+            Attached
+        };
+
+        /**
+         * @struct Status
+         * @brief A snapshot of this instance's part in the registry.
+         */
+        struct Status
+        {
+            Role role = Role::Standalone;
+            /// The host's ABI version, or 0.0 when there is none. A Standalone role with a host here is a mismatch.
+            std::uint32_t host_abi_major = 0;
+            std::uint32_t host_abi_minor = 0;
+            /// Instances joined to the registry, this one included; 0 when this one is not joined.
+            std::size_t instances = 0;
+            /// This instance's background tasks running on the host's service thread.
+            std::size_t delegated_tasks = 0;
+            /// Other instances' background tasks running on this instance's service thread.
+            std::size_t hosted_tasks = 0;
+            /// Poll cycles this instance answered from the shared key sweep instead of its own GetAsyncKeyState calls.
+            std::uint64_t shared_key_sweeps = 0;
+            /// Protection-cache misses this instance answered from the shared table instead of a VirtualQuery.
+            std::uint64_t shared_region_hits = 0;
+        };
+
+        /**
+         * @brief Joins the process-wide registry: hosts it when no instance does, else attaches to the host.
+         * @return The role taken (also when already joined): Host, Attached, or Standalone when the host's ABI major
+         *         differs; or Error{SystemCallFailed} (detail = GetLastError()) when the mapping or its lock cannot be
+         *         created, Error{InvalidRange} when a mapping of that name holds something else, or Error{OutOfMemory}.
+         * @note Call it early, before the subsystems it shares start, and off the loader lock (it waits on the
+         *       registry lock).
+         */
+        [[nodiscard]] Result<Role> enable() noexcept;
+
+        /**
+         * @brief Leaves the registry; a no-op when not joined.
+         * @details An attached instance takes its delegated tasks back onto its own service thread. A host stops
+         *          serving the attached instances' tasks, waiting for a running one to return, and hands them back.
+         *          The session teardown calls this before it stops the background service. Under the loader lock it
+         *          leaves only when the registry lock is free at once and waits for no running task.
+         *
+         *          A host waits a bounded time (10 ms under the loader lock, one second otherwise) for the attached
+         *          instances' calls into its scheduler to return. If one is still inside, the host stays joined as
+         *          host with its scheduler withdrawn: no new task reaches it, the tasks it runs keep running, its
+         *          module is kept loaded for the rest of the process (an intentional Worker leak in diagnostics), and
+         *          a later disable() tries again.
+         */
+        void disable() noexcept;
+
+        /// This instance's role, its host's version, and the work shared so far.
+        [[nodiscard]] Status status() noexcept;
+    } // namespace services
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SERVICES_HPP
@@ -20,9 +20,15 @@
 #include "DetourModKit/input.hpp"
 #include "DetourModKit/logger.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <optional>
 #include <span>
+#include <string>
 #include <string_view>
+#include <vector>
 
 // HMODULE is `struct HINSTANCE__ *`. Forward-declaring the incomplete tag lets this public header expose the
 // module-handle type without pulling <windows.h> (and its macro soup) into every consumer translation unit. A TU that
@@ -32,6 +38,11 @@ struct HINSTANCE__;
 
 namespace DetourModKit
 {
+    namespace scan
+    {
+        class ResolutionCache;
+    } // namespace scan
+
     /**
      * @brief Opaque Win32 module handle, identical to HMODULE (which is `struct HINSTANCE__ *`).
      * @details Aliased so the public surface needs no <windows.h>; a real HMODULE binds to it with no cast.
@@ -83,7 +94,9 @@ namespace DetourModKit
      *          the config auto-reload watcher, the input poll thread, the memory cache, the config registry, and the
      *          logger LAST (every prior step may still log). Each subsystem shutdown embeds its own loader-lock guard
      *          (join when safe, detach-and-leak when the loader lock is held), so ~Session delegates the join/leak
-     *          decision to the leaves rather than making one central, and therefore wrong, choice.
+     *          decision to the leaves rather than making one central, and therefore wrong, choice. Every subsystem
+     *          starts on first use (Input::start, memory::init_cache, config::enable_auto_reload, the first parallel
+     *          batch), and the teardown skips one that never started, so a mod pays only for what it uses.
      *
      *          Hooks are NOT owned by the Session: each hook lives in a caller-held Hook handle and unhooks when that
      *          handle drops, so hook lifetime is orthogonal to the session and correctly ordered by the caller's own
@@ -215,8 +228,12 @@ namespace DetourModKit
      *            blocking under the loader lock would deadlock any peer DllMain. A mod that needs a guaranteed-drained
      *            unload must call request_shutdown() before FreeLibrary and give the worker time to finish.
      *          - @p reserved != NULL (process termination): the OS has already killed the worker, so this takes the
-     *            abandon path -- no teardown, no unhook, no flush, no join. Handles are closed without waiting and the
-     *            OS reclaims the rest.
+     *            abandon path -- no teardown, no unhook, no join. Only the log sink is flushed, on this thread, so the
+     *            last lines reach the file; each subsystem that had started is recorded as an intentional leak
+     *            (diagnostics). Handles are closed without waiting and the OS reclaims the rest.
+     *
+     *          A Session held directly (Session::start) in static storage gets the same treatment: its destructor
+     *          detects the process-exit pass and skips the ordered teardown.
      *
      *          Idempotent: subsequent calls are no-ops.
      * @param reserved DllMain's lpvReserved (NULL for FreeLibrary, non-NULL for process exit).
@@ -242,6 +259,142 @@ namespace DetourModKit
      */
     [[nodiscard]] ModuleHandle module_handle() noexcept;
 
+    /**
+     * @struct StartupStage
+     * @brief One named step of a mod's startup, with the stages it must wait for.
+     * @details A mod's on_ready usually does several independent things -- load the INI, prewarm a signature cache,
+     *          read a manifest, install hooks -- and only some of them depend on each other. Declaring each as a stage
+     *          lets run_startup_pipeline() overlap the independent ones, so the time to mod-ready is the longest
+     *          dependency chain instead of the sum of every step.
+     *
+     *          @p name and the strings in @p after are borrowed for the duration of the run_startup_pipeline() call.
+     *          @p run returns Result<void> like on_ready; an exception escaping it is caught and reported as a failure
+     *          of that stage.
+     */
+    struct StartupStage
+    {
+        /// Unique stage name; appears in the report and the log summary.
+        std::string_view name{};
+        /// Names of the stages that must succeed before this one starts.
+        std::vector<std::string_view> after{};
+        /// The stage's work. Runs on the calling thread or a fork-join pool worker.
+        std::function<Result<void>()> run{};
+    };
+
+    /// How one stage of a run_startup_pipeline() call ended.
+    enum class StartupStageStatus : std::uint8_t
+    {
+        Succeeded,
+        Failed,
+        Skipped
+    };
+
+    /**
+     * @struct StartupStageTiming
+     * @brief One stage's outcome and where it sat on the startup timeline.
+     * @details @p started_at is measured from the start of the run_startup_pipeline() call. A Skipped stage (one whose
+     *          dependency failed or was skipped) never ran, so both durations are zero.
+     */
+    struct StartupStageTiming
+    {
+        std::string name{};
+        StartupStageStatus status{StartupStageStatus::Skipped};
+        std::chrono::microseconds started_at{0};
+        std::chrono::microseconds elapsed{0};
+        /// The stage's own failure, when status is Failed.
+        std::optional<Error> error{};
+    };
+
+    /**
+     * @struct StartupReport
+     * @brief Per-stage timings of one run_startup_pipeline() call, in declaration order.
+     * @details @p total is the wall time of the whole pipeline; @p serial is the sum of every stage's elapsed time,
+     *          what the same stages would have cost run one after another. The gap between the two is the overlap the
+     *          pipeline bought.
+     */
+    struct StartupReport
+    {
+        std::vector<StartupStageTiming> stages{};
+        std::chrono::microseconds total{0};
+        std::chrono::microseconds serial{0};
+
+        /// True when every stage succeeded.
+        [[nodiscard]] bool ok() const noexcept
+        {
+            for (const StartupStageTiming &stage : stages)
+            {
+                if (stage.status != StartupStageStatus::Succeeded)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    /**
+     * @brief Runs @p stages as a dependency graph on the fork-join pool and reports how long each took.
+     * @details Every stage whose dependencies have succeeded is ready, and ready stages run concurrently: the calling
+     *          thread and up to @p max_workers - 1 pool workers each take the next ready stage until none are left.
+     *          A stage that fails (or throws) marks every stage depending on it, directly or transitively, Skipped;
+     *          independent stages still run. Returns once every stage has finished or been skipped.
+     *
+     *          Meant for on_ready: Session::start / bootstrap() have already configured the logger, so every stage can
+     *          log, and on_ready is off the loader lock. Under the loader lock the pool cannot start and the calling
+     *          thread runs every stage itself, in dependency order.
+     * @param stages The stages to run. Names must be unique and every name in `after` must name another stage.
+     * @param max_workers Most threads running stages at once, the caller included; 0 selects the hardware thread count.
+     * @return The report, stage failures included (check StartupReport::ok()), or InvalidArg when a stage has no
+     *         `run`, a name repeats, an `after` entry names no stage, or the dependencies form a cycle (Error::detail is
+     *         the offending stage's index), or OutOfMemory.
+     * @note Setup-time only. The stages run concurrently, so two stages that touch the same state need an `after` edge
+     *       between them.
+     */
+    [[nodiscard]] Result<StartupReport> run_startup_pipeline(std::span<const StartupStage> stages,
+                                                             std::size_t max_workers = 0) noexcept;
+
+    /**
+     * @brief Logs @p report as one Info line: total and serial time, then each stage's elapsed time and status.
+     * @details Call it once the mod is up (after the first frame, say) so the line lands outside the startup window it
+     *          measures. Failures additionally log each failed stage's error at Error level. Never throws.
+     */
+    void log_startup_report(const StartupReport &report) noexcept;
+
+    /**
+     * @brief Keeps signature resolutions across Logic DLL reloads: every resolve that carries no cache of its own
+     *        consults and updates the session's reload cache.
+     * @details A Logic DLL reloaded during development re-runs the same scan::resolve / hook::install_all calls
+     *          against a game image that has not changed. With the reload cache on, a request whose
+     *          ScanRequest::cache (or anchor::ScanProfile::resolution_cache) is null uses this one instead, so the
+     *          first load pays the full ladder and every reload re-verifies each remembered site and skips the sweep.
+     *          A request with a cache of its own keeps using it. The cache lives in this library, not in the Logic
+     *          DLL: on_logic_dll_unload() and on_logic_dll_unload_all() leave it alone, and ~Session disables it.
+     *
+     *          The hooks themselves still go when their Hook handles drop on unload, since their detours live in the
+     *          unloading DLL's .text; the reloaded DLL's install_all reattaches each row at its cached address. The
+     *          trampoline memory the old hooks freed stays with the process-wide hook allocator, so those installs
+     *          carve from it rather than reserving new pages.
+     *
+     *          A warm entry is trusted to still be unique, exactly as ScanRequest::cache documents; enable this for
+     *          the edit-reload loop, not where another mod may have planted a byte twin of a signature.
+     * @return An empty Result (also when already enabled), or OutOfMemory when the cache cannot be created.
+     * @note Setup/control-plane only.
+     */
+    [[nodiscard]] Result<void> enable_reload_cache() noexcept;
+
+    /**
+     * @brief Stops consulting the reload cache and forgets its entries. A no-op when it is off.
+     * @note Setup/control-plane only. A resolve already running on another thread finishes against the emptied cache.
+     */
+    void disable_reload_cache() noexcept;
+
+    /**
+     * @brief The reload cache while it is enabled, else nullptr.
+     * @details Include DetourModKit/scan_cache.hpp to read its stats(), save() it for the next launch, or
+     *          share_in_process() it. The object outlives every disable, so the pointer never dangles.
+     */
+    [[nodiscard]] scan::ResolutionCache *reload_cache() noexcept;
+
     /**
      * @brief Hot-reload helper: drops the named input bindings and clears the config registry, keeping the process and
      *        its subsystems alive.
@@ -251,7 +404,8 @@ namespace DetourModKit
      *          not run under a loader lock), stops the config auto-reload watcher, then clears the config registry --
      *          the registered setters' call operators live in the unloading DLL's .text and would become
      *          use-after-unload hazards on the next load. Hooks are NOT touched: each is owned by a caller-held Hook
-     *          handle and unhooks when that handle drops. Idempotent.
+     *          handle and unhooks when that handle drops. The reload cache (enable_reload_cache) is kept for the next
+     *          load. Idempotent.
      *
      * @param binding_names Names registered via input::register_combo (or config::press_combo / hold_combo).
      * @note Setup/control-plane only and loader-lock-safe: intended for a Logic-DLL Shutdown() or a DllMain detach
@@ -10,11 +10,12 @@
  *          patch, when the author is no longer looking. This module closes that gap: it grades a signature statically,
  *          from its declarative bytes alone, so a weak anchor is caught at authoring time rather than in a bug report.
  *
- *          Everything here is offline and side-effect-free. It touches no process memory, spawns no worker, and needs
- *          no game running -- it reads the compiled @ref scan::Pattern bytes and the @ref manifest::SignatureRecord
- *          fields and returns a report. That makes it the natural companion to the @ref manifest module: once a
- *          signature contract is editable data, its quality becomes checkable data too, and an author (or a CI lane)
- *          can lint a `.signatures.ini` the same way it lints source.
+ *          Everything here but @ref analyze_pattern_calibrated and @ref analyze_manifest_live is offline and
+ *          side-effect-free. It touches no process memory, spawns no worker, and needs no game running -- it reads
+ *          the compiled @ref scan::Pattern bytes and the @ref manifest::SignatureRecord fields and returns a report.
+ *          That makes it the natural companion to the @ref manifest module: once a signature contract is editable
+ *          data, its quality becomes checkable data too, and an author (or a CI lane) can lint a `.signatures.ini`
+ *          the same way it lints source.
  *
  *          Three axes drive the grade, each a well-known signature-quality signal:
  *
@@ -33,6 +34,15 @@
  *            reliably separates a
  *            5-rare-byte anchor (effectively unique) from a 3-common-byte one (thousands of hits).
  *
+ *          Alongside the grade, every pattern carries a @ref PatternCost: how many times its prefilter byte should
+ *          fire per MiB, how much gap backtracking its `[X-Y]` jumps invite, and the sweep time those imply over the
+ *          nominal module. @ref analyze_pattern_calibrated replaces the model with a measured scan over a real
+ *          @ref Region.
+ *
+ *          @ref analyze_manifest_live asks the question the static grade can only estimate: against this build of
+ *          the game, how many sites match each rung, and how many mismatches away is the nearest site that almost
+ *          does? That uniqueness margin is what a patch erodes, and it is measured for a whole manifest in one sweep.
+ *
  *          The analysis layers over the @ref manifest surface the same way the manifest layers over @ref anchor:
  *          @ref analyze_pattern is the primitive over one @ref scan::Pattern; @ref analyze_candidate grades one ladder
  *          rung; @ref analyze_record grades a whole @ref manifest::SignatureRecord (its ladder or its text anchor, per
@@ -47,6 +57,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -106,6 +117,13 @@ namespace DetourModKit
             NonSerializableKind,
             /// No rung in a candidate ladder graded Robust, so the record has no strong tier to fall back on.
             NoRobustRung,
+            /// The estimated (or measured) sweep time over the nominal module exceeds @ref HealthPolicy::warn_scan_us.
+            ExpensiveScan,
+            /**
+             * @brief The `[X-Y]` jump widths multiply into many gap placements per anchor match. Critical once they can
+             *        exhaust the matcher's per-position budget, which drops a placement rather than proving it absent.
+             */
+            BacktrackingRisk,
             /**
              * @brief The record as a whole fails @ref manifest::Signature::compile (a malformed RIP-relative rung
              *        layout, an out-of-range page class, or a non-serializable kind), so the trust gate could never
@@ -179,6 +197,67 @@ namespace DetourModKit
             double warn_expected_matches = 1.0;
             /// An expected-match estimate above this escalates @ref FindingKind::WeakSelectivity to Critical severity.
             double fail_expected_matches = 32.0;
+            /// The cost model's prefilter sweep rate, in haystack bytes per microsecond.
+            double scan_bytes_per_us = 8192.0;
+            /// The cost model's price of verifying one prefilter hit, in nanoseconds.
+            double verify_ns = 10.0;
+            /// The cost model's price of one gap placement the segmented matcher tries, in nanoseconds.
+            double backtrack_step_ns = 2.0;
+            /// A @ref PatternCost::expected_us above this trips @ref FindingKind::ExpensiveScan.
+            double warn_scan_us = 50000.0;
+            /// A @ref PatternCost::gap_combinations above this trips a Warning @ref FindingKind::BacktrackingRisk.
+            std::uint64_t warn_gap_combinations = 4096;
+            /// Mismatches within which @ref analyze_manifest_live counts near misses, capped at MAX_NEAR_MISS_DISTANCE.
+            std::size_t near_miss_distance = 2;
+            /// A live record whose winning rung's @ref RungLiveHealth::margin is at most this grades Fragile.
+            std::size_t warn_uniqueness_margin = 1;
+        };
+
+        /// The deepest near-miss search @ref analyze_manifest_live runs; a larger policy value is clamped to it.
+        inline constexpr std::size_t MAX_NEAR_MISS_DISTANCE = 8;
+
+        /**
+         * @struct PatternCost
+         * @brief What one sweep of a pattern should cost: prefilter hits, gap backtracking, and time.
+         * @details The model follows the engine: a memchr sweep for the anchor byte, a verify at every hit, then for a
+         *          pattern with jumps a walk over the gap widths at every segment-0 match. Hit rates come from the
+         *          same byte-frequency model as @ref PatternHealth::selectivity_bits, and times from the
+         *          @ref HealthPolicy rates, so the figures are estimates for comparing patterns, not benchmarks. The
+         *          measured fields are set only by @ref analyze_pattern_calibrated.
+         */
+        struct PatternCost
+        {
+            /**
+             * @brief The prefilter byte (Pattern::anchor_index), or the pattern length when none exists and every
+             *        position is verified.
+             */
+            std::size_t anchor_index = 0;
+            /// Expected prefilter hits, and so verifies, per MiB of haystack.
+            double anchor_hits_per_mib = 0.0;
+            /**
+             * @brief Worst-case gap placements one segment-0 match can try: the product of the jump widths (1 with no
+             *        jumps), capped just past the matcher's per-position budget.
+             */
+            std::uint64_t gap_combinations = 1;
+            /// Expected gap placements tried per MiB of haystack.
+            double backtrack_steps_per_mib = 0.0;
+            /// Modelled microseconds for one sweep of @ref HealthPolicy::nominal_haystack_bytes.
+            double estimated_us = 0.0;
+            /// True once @ref analyze_pattern_calibrated has measured a real scan.
+            bool calibrated = false;
+            /// Calibrated: the bytes of the measured scope.
+            std::size_t measured_bytes = 0;
+            /// Calibrated: microseconds one full enumeration of the scope took.
+            double measured_us = 0.0;
+            /// Calibrated: prefilter-byte occurrences per MiB of the scope.
+            double measured_anchor_hits_per_mib = 0.0;
+            /// Calibrated: the pattern's matches in the scope.
+            std::size_t measured_matches = 0;
+            /// Calibrated: @ref measured_us scaled to @ref HealthPolicy::nominal_haystack_bytes.
+            double projected_us = 0.0;
+
+            /// The figure the grade judges: @ref projected_us once calibrated, else @ref estimated_us.
+            [[nodiscard]] double expected_us() const noexcept { return calibrated ? projected_us : estimated_us; }
         };
 
         /**
@@ -220,6 +299,8 @@ namespace DetourModKit
             double expected_matches = 0.0;
             /// True when every fully-known byte is a high-frequency opcode or padding (low atom rarity).
             bool common_bytes_only = false;
+            /// The scan-cost estimate, measured when the pattern came from @ref analyze_pattern_calibrated.
+            PatternCost cost;
             /// The findings this pattern tripped.
             std::vector<Finding> findings;
             /// The roll-up verdict.
@@ -308,6 +389,130 @@ namespace DetourModKit
             Grade grade = Grade::Robust;
         };
 
+        /**
+         * @struct RungLiveHealth
+         * @brief How one ladder rung fares against a live image: its exact matches and its near misses.
+         * @details A near miss is a site that differs from the pattern in 1..@ref distance constrained positions (a
+         *          fixed byte or a fixed nibble that disagrees). The closest one is how far a patch, or a second copy
+         *          of the function, is from turning a unique match ambiguous, which the static
+         *          @ref PatternHealth::expected_matches estimate can only guess at. Only jump-free byte rungs that
+         *          compile are analyzed; text-tier rungs and patterns with `[X-Y]` jumps leave @ref analyzed false.
+         */
+        struct RungLiveHealth
+        {
+            /// Which resolution tier this rung uses.
+            scan::Mode mode = scan::Mode::Direct;
+            /// True when the rung was swept; every figure below is 0 / empty otherwise.
+            bool analyzed = false;
+            /**
+             * @brief The near-miss depth searched: the policy's @ref HealthPolicy::near_miss_distance, lowered to one
+             *        less than the pattern's fully-known byte count when the pattern has fewer to split on.
+             */
+            std::size_t distance = 0;
+            /// Sites matching the pattern exactly.
+            std::size_t matches = 0;
+            /// near_misses[d - 1] counts the sites exactly d mismatches away, for d in 1..@ref distance.
+            std::vector<std::size_t> near_misses;
+            /**
+             * @brief For a rung that matched exactly once, the mismatches to the nearest other site, or @ref distance
+             *        + 1 when none lies within @ref distance. 0 when the rung matched zero times or more than once.
+             */
+            std::size_t margin = 0;
+        };
+
+        /**
+         * @struct RecordLiveHealth
+         * @brief One record's live verdict: which rung wins, and by what margin.
+         * @details The winning rung is the first analyzed rung, in file order, that matched exactly once. @ref grade
+         *          is Unusable when no analyzed rung matched exactly once, Fragile when the winner's margin is at most
+         *          @ref HealthPolicy::warn_uniqueness_margin, and Robust otherwise. A record with no analyzed rung (a
+         *          text backend, a Manual pin, a ladder of text tiers or jump patterns) is left unjudged.
+         */
+        struct RecordLiveHealth
+        {
+            /// The signature's key.
+            std::string label;
+            /// Which anchor backend the record uses.
+            anchor::AnchorKind kind = anchor::AnchorKind::RipGlobal;
+            /// One entry per ladder rung, in file order. Empty for text / Manual backends.
+            std::vector<RungLiveHealth> ladder;
+            /// True when at least one rung was analyzed; @ref grade means nothing otherwise.
+            bool analyzed = false;
+            /// Index into @ref ladder of the winning rung, if any.
+            std::optional<std::size_t> winning_rung;
+            /// The winning rung's @ref RungLiveHealth::margin; 0 without a winner.
+            std::size_t margin = 0;
+            /// The live verdict.
+            Grade grade = Grade::Robust;
+        };
+
+        /**
+         * @struct ManifestLiveHealth
+         * @brief A whole manifest measured against one live image in a single sweep.
+         * @details @ref grade is the weakest analyzed record's grade. @ref complete is false when part of the image
+         *          faulted mid-sweep: every count is then a lower bound, so a margin may be overstated.
+         */
+        struct ManifestLiveHealth
+        {
+            /// Per-record results, in file order.
+            std::vector<RecordLiveHealth> records;
+            /// Analyzed records that graded @ref Grade::Robust.
+            std::size_t robust = 0;
+            /// Analyzed records that graded @ref Grade::Fragile.
+            std::size_t fragile = 0;
+            /// Analyzed records that graded @ref Grade::Unusable.
+            std::size_t unusable = 0;
+            /// Records with no analyzable rung.
+            std::size_t skipped = 0;
+            /// Bytes of the image the sweep read.
+            std::size_t scanned_bytes = 0;
+            /// False when a faulted page left the counts a lower bound.
+            bool complete = true;
+            /// The weakest analyzed record's grade.
+            Grade grade = Grade::Robust;
+            /// The sweep's work; all zero in a build without `DMK_ENABLE_SCAN_TELEMETRY`.
+            scan::ScanTelemetry telemetry;
+        };
+
+        /**
+         * @struct RepairSuggestion
+         * @brief The nearest live site to a pattern that no longer matches, and the edits that would make it match.
+         * @details Filled by @ref suggest_repair. A pattern that still matches exactly has nothing to repair and only
+         *          @ref matches is set. Otherwise, @ref nearest is the fewest substitutions any site in the scope
+         *          needs, and when exactly one site needs that few, @ref repairable is set and the two rewritten
+         *          patterns describe it. @ref relearned keeps the pattern's shape and takes the site's bytes where they
+         *          disagree; it is the tighter fix but trusts that the changed bytes are stable. @ref loosened
+         *          wildcards those positions instead; it survives the next renumbering but is less selective.
+         */
+        struct RepairSuggestion
+        {
+            /// Sites matching the pattern exactly; nonzero means there is nothing to repair.
+            std::size_t matches = 0;
+            /**
+             * @brief The deepest substitution count searched: the policy's @ref HealthPolicy::near_miss_distance,
+             *        lowered to one less than the pattern's constrained position count when it has fewer.
+             */
+            std::size_t distance = 0;
+            /// Substitutions the nearest site needs; 0 when no site lies within @ref distance.
+            std::size_t nearest = 0;
+            /// Sites that need @ref nearest substitutions; a lower bound once it reaches the search's site cap.
+            std::size_t nearest_sites = 0;
+            /// True when exactly one site is nearest, so the fields below describe it.
+            bool repairable = false;
+            /// The nearest site's first byte (not adjusted by the pattern's `|` offset).
+            Address site;
+            /// The pattern indexes at which the nearest site disagrees, ascending.
+            std::vector<std::size_t> mismatch_positions;
+            /// The pattern with each disagreeing byte (or nibble) rewritten to the site's value.
+            std::string relearned;
+            /// The pattern with each disagreeing position turned into a `??` wildcard.
+            std::string loosened;
+            /// Sites @ref relearned matches in the scope, counted up to 2; 1 means it resolves uniquely again.
+            std::size_t relearned_matches = 0;
+            /// False when part of the scope faulted mid-sweep, so a nearer site may have been missed.
+            bool complete = true;
+        };
+
         /**
          * @brief Grades one compiled byte pattern's robustness.
          * @param pattern The compiled pattern (from @ref scan::Pattern::compile or @ref scan::Pattern::literal).
@@ -318,6 +523,21 @@ namespace DetourModKit
          */
         [[nodiscard]] PatternHealth analyze_pattern(const scan::Pattern &pattern, const HealthPolicy &policy = {});
 
+        /**
+         * @brief @ref analyze_pattern, with the cost measured by enumerating @p pattern over @p scope.
+         * @param pattern The compiled pattern.
+         * @param scope A mapped region representative of the target, e.g. the game's module.
+         * @param policy The grading thresholds; the measurement is projected to its nominal_haystack_bytes.
+         * @param pages Which page class the measured scan accepts, as in scan::scan.
+         * @return The health with @ref PatternCost::calibrated set and @ref FindingKind::ExpensiveScan judged on the
+         *         measured time, or the errors of scan::for_each_match.
+         * @note Setup/control-plane only: two page-gated sweeps of @p scope, one for the prefilter byte and one for
+         *       the pattern. Unlike the rest of this module it reads process memory.
+         */
+        [[nodiscard]] Result<PatternHealth> analyze_pattern_calibrated(const scan::Pattern &pattern, Region scope,
+                                                                       const HealthPolicy &policy = {},
+                                                                       scan::Pages pages = scan::Pages::Readable);
+
         /**
          * @brief Grades one candidate-ladder rung, compiling its byte pattern or measuring its text anchor by tier.
          * @param spec The rung to grade.
@@ -350,6 +570,49 @@ namespace DetourModKit
         [[nodiscard]] ManifestHealth analyze_manifest(const manifest::Manifest &manifest,
                                                       const HealthPolicy &policy = {});
 
+        /**
+         * @brief Counts every byte rung's exact matches and near misses in @p scope, in one parallel sweep.
+         * @details Near misses are found by the pigeonhole principle: a rung searched to depth d is cut into d + 1
+         *          blocks, and a site within d mismatches matches at least one block exactly. Every block of every
+         *          rung is keyed by its rarest fully-known byte into one 256-entry table, so the sweep reads each byte
+         *          of the image once and verifies only the sites some block's key byte lands on. The image is cut
+         *          into chunks that run on the fork-join pool, each under the page-gated scans' fault guard.
+         * @param manifest The parsed manifest.
+         * @param scope The live image, e.g. the game's module.
+         * @param policy Supplies @ref HealthPolicy::near_miss_distance and @ref HealthPolicy::warn_uniqueness_margin.
+         * @param pages Which page class the sweep reads, as in scan::scan.
+         * @param max_workers Upper bound on worker threads (0 = auto); a call from inside a fork-join worker runs
+         *                    serially.
+         * @return The per-record results, or InvalidArg for an out-of-range @p pages and InvalidRange for an empty
+         *         @p scope.
+         * @note Setup/control-plane only: reads process memory and may spawn worker threads for the call.
+         */
+        [[nodiscard]] Result<ManifestLiveHealth> analyze_manifest_live(const manifest::Manifest &manifest,
+                                                                       Region scope, const HealthPolicy &policy = {},
+                                                                       scan::Pages pages = scan::Pages::Readable,
+                                                                       std::size_t max_workers = 0);
+
+        /**
+         * @brief Finds where a broken byte pattern moved to, and suggests the edits that would make it match there.
+         * @details Searches @p scope with scan::find_approximate at 0, 1, 2, ... substitutions, stopping at the first
+         *          depth that yields any site. The first sweep that finds something therefore finds the nearest sites,
+         *          and a pattern a patch broke by a byte or two costs two or three parallel sweeps. When one site is
+         *          nearest, the suggestion names the positions that changed and both rewrites of the pattern, and the
+         *          relearned one is scanned for to confirm that it resolves uniquely again.
+         * @param pattern The compiled pattern; it must have no `[X-Y]` jumps and at least one constrained position.
+         * @param scope The live image, e.g. the game's module.
+         * @param policy Supplies @ref HealthPolicy::near_miss_distance, the deepest search.
+         * @param pages Which page class the sweeps read, as in scan::scan.
+         * @param max_workers Upper bound on worker threads per sweep (0 = auto).
+         * @return The suggestion, or InvalidArg for a jump-bearing or all-wildcard pattern or an out-of-range @p pages,
+         *         InvalidRange for an empty @p scope, or OutOfMemory.
+         * @note Setup/control-plane only: reads process memory and may spawn worker threads for the call.
+         */
+        [[nodiscard]] Result<RepairSuggestion> suggest_repair(const scan::Pattern &pattern, Region scope,
+                                                              const HealthPolicy &policy = {},
+                                                              scan::Pages pages = scan::Pages::Readable,
+                                                              std::size_t max_workers = 0);
+
         /**
          * @brief Maps a @ref Severity to a short human-readable label.
          * @param severity The severity.
@@ -379,7 +642,7 @@ namespace DetourModKit
          * @param health The analyzed pattern.
          * @param label An optional caption for the pattern (e.g. the rung name); rendered when non-empty.
          * @return A human-readable report: the grade, the byte composition, the selectivity and expected-match figures,
-         *         and one line per finding.
+         *         the cost estimate (and measurement, when calibrated), and one line per finding.
          * @note Allocates; intended for tool output or a log line, never a hot path.
          */
         [[nodiscard]] std::string format_report(const PatternHealth &health, std::string_view label = {});
@@ -400,6 +663,26 @@ namespace DetourModKit
          * @note Allocates; intended for tool output or a log line, never a hot path.
          */
         [[nodiscard]] std::string format_report(const ManifestHealth &health);
+
+        /**
+         * @brief Renders a live manifest measurement as a multi-line report.
+         * @param health The measured manifest.
+         * @return A human-readable report: the grade tally and sweep size, the sweep's @ref scan::ScanTelemetry in a
+         *         `DMK_ENABLE_SCAN_TELEMETRY` build, then per record its winning rung and margin and per rung its match
+         *         and near-miss counts.
+         * @note Allocates; intended for tool output or a log line, never a hot path.
+         */
+        [[nodiscard]] std::string format_report(const ManifestLiveHealth &health);
+
+        /**
+         * @brief Renders a repair suggestion as a multi-line report.
+         * @param suggestion The suggestion to render.
+         * @param label An optional caption for the pattern (e.g. the record label); rendered when non-empty.
+         * @return A human-readable report: the exact-match count or the nearest distance and site count, then for a
+         *         repairable pattern the site, the changed positions, and both rewrites.
+         * @note Allocates; intended for tool output or a log line, never a hot path.
+         */
+        [[nodiscard]] std::string format_report(const RepairSuggestion &suggestion, std::string_view label = {});
     } // namespace sighealth
 } // namespace DetourModKit
 
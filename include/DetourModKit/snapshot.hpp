@@ -0,0 +1,206 @@
+#ifndef DETOURMODKIT_SNAPSHOT_HPP
+#define DETOURMODKIT_SNAPSHOT_HPP
+
+/**
+ * @file snapshot.hpp
+ * @brief Struct snapshots: read several fields of a game object with one guarded copy.
+ * @details Reading a struct field by field with @ref memory::read enters the fault guard once per field, and a
+ *          writer thread can change the object between two of those reads, so the fields come from different
+ *          moments. A @ref memory::Snapshot is declared over a compile-time @ref memory::Layout of typed
+ *          @ref memory::Field tags. Each @ref memory::Snapshot::read copies the byte range covering every field into
+ *          the snapshot's own inline buffer with a single @ref memory::read_into, and `get<Field>()` decodes a field
+ *          from that copy. The copy is not atomic, but its window is one memcpy instead of one guarded call per field.
+ *
+ *          Offsets start at each field's nominal value and can be replaced at run time, typically with the
+ *          @ref rtti::heal_landmark result for that field after a patch moved it. The buffer is sized at compile time
+ *          with slack on either side of the nominal range, so a healed layout is read the same way.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/rtti_dissect.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace DetourModKit
+{
+    namespace memory
+    {
+        /**
+         * @struct Field
+         * @brief A snapshot field tag: the value type and its nominal byte offset from the struct base.
+         * @details Derive a named tag from it, `struct Health : memory::Field<std::int32_t, 0x140> {};`, and list the
+         *          tags in a @ref Layout.
+         */
+        template <class T, std::ptrdiff_t NominalOffset>
+            requires std::is_trivially_copyable_v<T>
+        struct Field
+        {
+            using value_type = T;
+            static constexpr std::ptrdiff_t nominal_offset = NominalOffset;
+        };
+
+        /**
+         * @struct Layout
+         * @brief The compile-time field list of a @ref Snapshot, and the nominal byte range it covers.
+         */
+        template <class... Fields> struct Layout
+        {
+            static_assert(sizeof...(Fields) > 0, "memory::Layout needs at least one field");
+
+            static constexpr std::size_t field_count = sizeof...(Fields);
+            static constexpr std::array<std::ptrdiff_t, field_count> nominal_offsets = {Fields::nominal_offset...};
+            static constexpr std::array<std::size_t, field_count> sizes = {sizeof(typename Fields::value_type)...};
+
+            /// First byte of the nominal covering range, relative to the struct base.
+            static constexpr std::ptrdiff_t nominal_begin = std::min({Fields::nominal_offset...});
+            /// One past the last byte of the nominal covering range.
+            static constexpr std::ptrdiff_t nominal_end = std::max(
+                {static_cast<std::ptrdiff_t>(Fields::nominal_offset + sizeof(typename Fields::value_type))...});
+
+            /// The position of tag @p F in the list; listing a tag twice or naming an absent one is ill-formed.
+            template <class F> static consteval std::size_t index_of() noexcept
+            {
+                constexpr std::array<bool, field_count> matches = {std::is_same_v<F, Fields>...};
+                static_assert(std::count(matches.begin(), matches.end(), true) == 1,
+                              "the field must appear exactly once in the layout");
+                return static_cast<std::size_t>(std::find(matches.begin(), matches.end(), true) - matches.begin());
+            }
+        };
+
+        /**
+         * @class Snapshot
+         * @brief One guarded copy of the bytes covering a @ref Layout, with typed field access over it.
+         * @tparam L The @ref Layout.
+         * @tparam Slack Bytes on either side of the nominal range that run-time offsets may move into; the default
+         *         matches the default @ref rtti::Landmark window. The inline buffer is the nominal range plus twice
+         *         this.
+         * @details Holds its buffer inline, so a snapshot declared in a hook callback lives on that callback's stack.
+         *          Each @ref read copies only the range the current offsets cover, not the whole buffer.
+         * @note Not thread-safe; give each reading thread its own snapshot.
+         */
+        template <class L, std::size_t Slack = 0x40> class Snapshot
+        {
+        public:
+            /// Size of the inline buffer: the largest range the offsets may cover.
+            static constexpr std::size_t CAPACITY =
+                static_cast<std::size_t>(L::nominal_end - L::nominal_begin) + 2 * Slack;
+
+            /// A snapshot at the nominal offsets, holding no value until the first @ref read.
+            Snapshot() noexcept : m_offsets(L::nominal_offsets) { (void)cover(m_offsets); }
+
+            /**
+             * @brief Moves field @p F to @p offset from the struct base.
+             * @return An empty `Result`, or `ErrorCode::SizeTooLarge` (offsets unchanged) when the range covering
+             *         every field would outgrow @ref CAPACITY.
+             * @details Clears @ref valid: the bytes held were copied under the old layout.
+             */
+            template <class F> [[nodiscard]] Result<void> set_offset(std::ptrdiff_t offset) noexcept
+            {
+                std::array<std::ptrdiff_t, L::field_count> candidate = m_offsets;
+                candidate[L::template index_of<F>()] = offset;
+                if (!cover(candidate))
+                {
+                    return std::unexpected(Error{ErrorCode::SizeTooLarge, "memory::Snapshot::set_offset"});
+                }
+                m_offsets = candidate;
+                m_valid = false;
+                return {};
+            }
+
+            /// Moves field @p F to the offset @ref rtti::heal_landmark found for it.
+            template <class F> [[nodiscard]] Result<void> set_offset(const rtti::HealHit &hit) noexcept
+            {
+                return set_offset<F>(hit.healed_offset);
+            }
+
+            /// Moves field @p F to a heal result's offset, or propagates the heal's error with the offsets unchanged.
+            template <class F> [[nodiscard]] Result<void> set_offset(const Result<rtti::HealHit> &healed) noexcept
+            {
+                if (!healed)
+                {
+                    return std::unexpected(healed.error());
+                }
+                return set_offset<F>(healed->healed_offset);
+            }
+
+            /// The current offset of field @p F.
+            template <class F> [[nodiscard]] std::ptrdiff_t offset() const noexcept
+            {
+                return m_offsets[L::template index_of<F>()];
+            }
+
+            /**
+             * @brief Copies the range covering every field of the struct at @p base into the snapshot.
+             * @return An empty `Result`, `ErrorCode::NullTargetAddress` for a null @p base, or the @ref read_into
+             *         error. On failure @ref valid is false and the held bytes are unspecified.
+             * @note Callback-safe (see @ref read_into).
+             */
+            [[nodiscard]] Result<void> read(Address base) noexcept
+            {
+                m_valid = false;
+                if (!base)
+                {
+                    return std::unexpected(Error{ErrorCode::NullTargetAddress, "memory::Snapshot::read"});
+                }
+                if (auto copied = read_into(base.offset(m_begin), std::span<std::byte>{m_bytes.data(), m_span});
+                    !copied)
+                {
+                    return std::unexpected(copied.error());
+                }
+                m_valid = true;
+                return {};
+            }
+
+            /// Field @p F from the last @ref read; meaningful only while @ref valid.
+            template <class F> [[nodiscard]] typename F::value_type get() const noexcept
+            {
+                std::array<std::byte, sizeof(typename F::value_type)> storage;
+                std::memcpy(storage.data(), m_bytes.data() + (offset<F>() - m_begin), storage.size());
+                return std::bit_cast<typename F::value_type>(storage);
+            }
+
+            /// True when the last @ref read succeeded and no offset has moved since.
+            [[nodiscard]] bool valid() const noexcept { return m_valid; }
+
+            /// Bytes a @ref read copies under the current offsets.
+            [[nodiscard]] std::size_t span_bytes() const noexcept { return m_span; }
+
+        private:
+            // Recomputes the covering range of offsets into m_begin / m_span; false, leaving both, when it would not
+            // fit the buffer.
+            [[nodiscard]] bool cover(const std::array<std::ptrdiff_t, L::field_count> &offsets) noexcept
+            {
+                std::ptrdiff_t begin = offsets[0];
+                std::ptrdiff_t end = offsets[0] + static_cast<std::ptrdiff_t>(L::sizes[0]);
+                for (std::size_t i = 1; i < L::field_count; ++i)
+                {
+                    begin = std::min(begin, offsets[i]);
+                    end = std::max(end, offsets[i] + static_cast<std::ptrdiff_t>(L::sizes[i]));
+                }
+                if (static_cast<std::size_t>(end - begin) > CAPACITY)
+                {
+                    return false;
+                }
+                m_begin = begin;
+                m_span = static_cast<std::size_t>(end - begin);
+                return true;
+            }
+
+            std::array<std::ptrdiff_t, L::field_count> m_offsets;
+            std::ptrdiff_t m_begin = 0;
+            std::size_t m_span = 0;
+            bool m_valid = false;
+            std::array<std::byte, CAPACITY> m_bytes{};
+        };
+    } // namespace memory
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_SNAPSHOT_HPP
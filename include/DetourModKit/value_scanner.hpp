@@ -0,0 +1,199 @@
+#ifndef DETOURMODKIT_VALUE_SCANNER_HPP
+#define DETOURMODKIT_VALUE_SCANNER_HPP
+
+/**
+ * @file value_scanner.hpp
+ * @brief Value scanning: find every writable address holding a number, then narrow the set as the number changes.
+ * @details The trainer workflow for state that has no stable signature: a first scan finds every aligned slot in the
+ *          process's writable pages that holds a value (or a value in a range), and each refine pass re-reads the
+ *          survivors and keeps those that changed, stayed, went up, went down, or now equal a new value. A few
+ *          passes usually leave a handful of addresses, from which a pointer chain or signature can then be built.
+ *
+ *          The first scan walks the scope through the same page gate the pattern scanners use, restricted to committed
+ *          writable pages, and cuts it into 1 MiB chunks swept in parallel; each chunk compares 32 bytes per step
+ *          with AVX2 where the CPU has it. Results are stored per chunk as a base address, a 32-bit offset per hit,
+ *          and the hit's last-read value at its own width, so an i32 hit costs 8 bytes. Every read of foreign memory
+ *          is fault-guarded, so a page freed between passes drops its hits rather than faulting the host.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/region_set.hpp"
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace memory
+    {
+        /**
+         * @enum ValueType
+         * @brief The width and interpretation of the values a @ref ValueScanner compares.
+         */
+        enum class ValueType : std::uint8_t
+        {
+            /// 32-bit signed integer, 4-byte aligned.
+            I32,
+            /// IEEE-754 single, 4-byte aligned.
+            F32,
+            /// IEEE-754 double, 8-byte aligned.
+            F64,
+        };
+
+        /**
+         * @enum Refine
+         * @brief How a @ref ValueScanner::refine pass compares each survivor's current value with its previous one.
+         * @details Changed / Unchanged compare the stored bits, so a NaN that stays the same NaN is unchanged.
+         *          Increased / Decreased compare numerically, so a NaN on either side is neither.
+         */
+        enum class Refine : std::uint8_t
+        {
+            /// The value differs from the last pass.
+            Changed,
+            /// The value is the same as the last pass.
+            Unchanged,
+            /// The value is greater than at the last pass.
+            Increased,
+            /// The value is less than at the last pass.
+            Decreased,
+        };
+
+        /// The types a @ref ValueScanner can search for.
+        template <typename T>
+        concept ScanValue = std::same_as<T, std::int32_t> || std::same_as<T, float> || std::same_as<T, double>;
+
+        /**
+         * @struct ValueScanOptions
+         * @brief Scope and parallelism of a @ref ValueScanner first scan.
+         */
+        struct ValueScanOptions
+        {
+            /// The ranges to search; empty searches the whole user address space (Region::whole_process()).
+            RegionSet scope{};
+            /// Upper bound on worker threads for the first scan and every refine (0 = hardware concurrency).
+            std::size_t max_workers = 0;
+        };
+
+        /**
+         * @class ValueScanner
+         * @brief The candidate set of one value search, narrowed pass by pass.
+         * @details Float comparisons are numeric: a first scan for 0.0f also finds -0.0f, and no search ever matches
+         *          a NaN. A slot that cannot be read during a pass is dropped and the scanner reports @ref incomplete.
+         *          The search's own transient state (its argument, a worker's scratch buffer) lives in writable
+         *          memory too and can match a first scan; such hits fall out on the first refine that sees them change.
+         * @note Single-owner and move-only. Every scan and refine is setup/control-plane work: it walks or re-reads
+         *       possibly gigabytes of memory and spawns worker threads for the duration of the call. A moved-from
+         *       scanner is empty and its refines fail with ErrorCode::InvalidArg.
+         */
+        class ValueScanner
+        {
+        public:
+            /**
+             * @brief Finds every aligned slot in the scope's writable pages that holds @p value.
+             * @return The scanner, or InvalidArg for a NaN @p value, or OutOfMemory.
+             */
+            template <ScanValue T>
+            [[nodiscard]] static Result<ValueScanner> first_scan(T value, const ValueScanOptions &options = {}) noexcept
+            {
+                return start(value_type_of<T>(), bits_of(value), bits_of(value), options);
+            }
+
+            /**
+             * @brief Finds every aligned slot in the scope's writable pages whose value lies in [@p lo, @p hi].
+             * @return The scanner, or InvalidArg when @p lo > @p hi or either bound is NaN, or OutOfMemory.
+             */
+            template <ScanValue T>
+            [[nodiscard]] static Result<ValueScanner> first_scan_between(T lo, T hi,
+                                                                         const ValueScanOptions &options = {}) noexcept
+            {
+                return start(value_type_of<T>(), bits_of(lo), bits_of(hi), options);
+            }
+
+            ValueScanner(ValueScanner &&) noexcept;
+            ValueScanner &operator=(ValueScanner &&) noexcept;
+            ValueScanner(const ValueScanner &) = delete;
+            ValueScanner &operator=(const ValueScanner &) = delete;
+            ~ValueScanner() noexcept;
+
+            /**
+             * @brief Re-reads every survivor and keeps those that pass @p mode against their previous value.
+             * @details Each survivor's stored value becomes the one just read, so the next pass compares against it.
+             * @return The number of survivors, or InvalidArg for a moved-from scanner or an unknown @p mode.
+             */
+            Result<std::size_t> refine(Refine mode) noexcept;
+
+            /**
+             * @brief Re-reads every survivor and keeps those that now hold @p value.
+             * @return The number of survivors, or InvalidArg when T is not the scanner's type or @p value is NaN.
+             */
+            template <ScanValue T> Result<std::size_t> refine_equals(T value) noexcept
+            {
+                return refine_bits(value_type_of<T>(), bits_of(value), bits_of(value));
+            }
+
+            /**
+             * @brief Re-reads every survivor and keeps those whose value now lies in [@p lo, @p hi].
+             * @return The number of survivors, or InvalidArg when T is not the scanner's type, @p lo > @p hi, or a
+             *         bound is NaN.
+             */
+            template <ScanValue T> Result<std::size_t> refine_between(T lo, T hi) noexcept
+            {
+                return refine_bits(value_type_of<T>(), bits_of(lo), bits_of(hi));
+            }
+
+            /// The number of addresses still in the set.
+            [[nodiscard]] std::size_t size() const noexcept;
+
+            /// True when no address is left (or the scanner was moved from).
+            [[nodiscard]] bool empty() const noexcept;
+
+            /// The type the scanner was started with.
+            [[nodiscard]] ValueType type() const noexcept;
+
+            /// True once any pass skipped a faulted chunk or dropped an unreadable slot, or a worker ran out of memory.
+            [[nodiscard]] bool incomplete() const noexcept;
+
+            /**
+             * @brief The surviving addresses in ascending order, at most @p limit of them.
+             * @return The addresses, or OutOfMemory.
+             */
+            [[nodiscard]] Result<std::vector<Address>> addresses(std::size_t limit = SIZE_MAX) const noexcept;
+
+        private:
+            struct Impl;
+            explicit ValueScanner(std::unique_ptr<Impl> impl) noexcept;
+
+            template <ScanValue T> [[nodiscard]] static constexpr ValueType value_type_of() noexcept
+            {
+                if constexpr (std::same_as<T, std::int32_t>)
+                    return ValueType::I32;
+                else if constexpr (std::same_as<T, float>)
+                    return ValueType::F32;
+                else
+                    return ValueType::F64;
+            }
+
+            // The value's bit pattern, zero-extended, so the typed entry points share one non-template body.
+            template <ScanValue T> [[nodiscard]] static constexpr std::uint64_t bits_of(T value) noexcept
+            {
+                if constexpr (sizeof(T) == sizeof(std::uint32_t))
+                    return std::bit_cast<std::uint32_t>(value);
+                else
+                    return std::bit_cast<std::uint64_t>(value);
+            }
+
+            [[nodiscard]] static Result<ValueScanner> start(ValueType type, std::uint64_t lo, std::uint64_t hi,
+                                                            const ValueScanOptions &options) noexcept;
+            Result<std::size_t> refine_bits(ValueType type, std::uint64_t lo, std::uint64_t hi) noexcept;
+
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace memory
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_VALUE_SCANNER_HPP
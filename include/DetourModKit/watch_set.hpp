@@ -0,0 +1,125 @@
+#ifndef DETOURMODKIT_WATCH_SET_HPP
+#define DETOURMODKIT_WATCH_SET_HPP
+
+/**
+ * @file watch_set.hpp
+ * @brief Per-frame change detection over a fixed set of game values.
+ * @details A mod that reacts to a few dozen values -- health, ammo, the current map id, a menu flag -- would otherwise
+ *          re-read each one every frame and diff it against a copy it keeps itself. A @ref memory::WatchSet owns that
+ *          bookkeeping: entries are registered once as an address or a @ref memory::CompiledChain plus a byte size,
+ *          and their last values live back to back in one buffer. Each @ref memory::WatchSet::poll re-resolves the
+ *          chains, re-reads every entry through one @ref memory::read_many batch, compares the new buffer with the
+ *          old one a qword lane at a time (four lanes per step with AVX2 where the CPU has it), and returns the
+ *          indices of the entries that changed.
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/memory.hpp"
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <type_traits>
+
+namespace DetourModKit
+{
+    namespace memory
+    {
+        /// Largest value, in bytes, a single @ref WatchSet entry may watch.
+        inline constexpr std::size_t MAX_WATCH_SIZE = 4096;
+
+        /**
+         * @class WatchSet
+         * @brief A set of watched values re-read and diffed in one batch per @ref poll.
+         * @details An entry counts as changed on a poll when its bytes differ from the last successful read, when it
+         *          reads for the first time, and when it starts or stops reading (its page was freed, or its chain no
+         *          longer resolves). An entry that keeps failing is not reported again until it reads. @ref bytes
+         *          always holds the last value that read successfully.
+         * @note Move-only and not thread-safe: @ref poll updates the stored values and the compiled chains' memos. A
+         *       poll allocates nothing, since every buffer is sized by @ref add, so polling from a hook callback is
+         *       safe.
+         */
+        class WatchSet
+        {
+        public:
+            WatchSet() noexcept;
+            WatchSet(WatchSet &&) noexcept;
+            WatchSet &operator=(WatchSet &&) noexcept;
+            WatchSet(const WatchSet &) = delete;
+            WatchSet &operator=(const WatchSet &) = delete;
+            ~WatchSet() noexcept;
+
+            /**
+             * @brief Watches @p size bytes at a fixed @p address.
+             * @return The entry's index, or NullTargetAddress for a null @p address, InvalidArg for a zero @p size,
+             *         SizeTooLarge past @ref MAX_WATCH_SIZE, or OutOfMemory.
+             */
+            [[nodiscard]] Result<std::size_t> add(Address address, std::size_t size) noexcept;
+
+            /**
+             * @brief Watches @p size bytes at the leaf of @p chain, re-resolved on every @ref poll.
+             * @details A poll on which the chain does not resolve counts as a failed read for this entry.
+             * @return The entry's index, or InvalidArg for a zero @p size, SizeTooLarge past @ref MAX_WATCH_SIZE, or
+             *         OutOfMemory.
+             */
+            [[nodiscard]] Result<std::size_t> add(CompiledChain chain, std::size_t size) noexcept;
+
+            /**
+             * @brief Re-reads every entry and returns the indices of those that changed, in ascending order.
+             * @return A view valid until the next @ref poll, @ref add, or @ref clear.
+             */
+            [[nodiscard]] std::span<const std::size_t> poll() noexcept;
+
+            /// The last successfully read bytes of entry @p index; empty before its first read or for a bad index.
+            [[nodiscard]] std::span<const std::byte> bytes(std::size_t index) const noexcept;
+
+            /// True when entry @p index read successfully on the last @ref poll.
+            [[nodiscard]] bool valid(std::size_t index) const noexcept;
+
+            /**
+             * @brief The last successfully read value of entry @p index as a @p T.
+             * @return The value, or InvalidArg when @p index is out of range or `sizeof(T)` is not the entry's size,
+             *         or ReadFaulted before the entry's first successful read.
+             */
+            template <class T>
+                requires std::is_trivially_copyable_v<T>
+            [[nodiscard]] Result<T> value(std::size_t index) const noexcept
+            {
+                if (index >= size() || entry_size(index) != sizeof(T))
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "memory::WatchSet::value"});
+                }
+                const std::span<const std::byte> stored = bytes(index);
+                if (stored.empty())
+                {
+                    return std::unexpected(Error{ErrorCode::ReadFaulted, "memory::WatchSet::value"});
+                }
+                std::array<std::byte, sizeof(T)> storage;
+                std::memcpy(storage.data(), stored.data(), sizeof(T));
+                return std::bit_cast<T>(storage);
+            }
+
+            /// The number of entries.
+            [[nodiscard]] std::size_t size() const noexcept;
+
+            /// True when no entry is registered.
+            [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+            /// Removes every entry.
+            void clear() noexcept;
+
+        private:
+            struct Impl;
+
+            [[nodiscard]] std::size_t entry_size(std::size_t index) const noexcept;
+
+            std::unique_ptr<Impl> m_impl;
+        };
+    } // namespace memory
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_WATCH_SET_HPP
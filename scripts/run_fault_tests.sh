@@ -111,7 +111,7 @@ done
   -Wl,--end-group \
   -static -static-libgcc -static-libstdc++ \
   "${COVERAGE_FLAGS[@]}" \
-  -luser32 -lxinput1_4 -lpsapi -ldbghelp -lntdll \
+  -luser32 -lsynchronization -lxinput1_4 -lpsapi -ldbghelp -lntdll \
   -o "$OUT_EXE"
 
 echo "== running $OUT_EXE =="
@@ -87,7 +87,7 @@ SYS_INCLUDES=(
   -isystem "$BUILD_DIR/_deps/zydis-src/include" -isystem "$BUILD_DIR/_deps/zydis-build"
   -isystem "$BUILD_DIR/_deps/zydis-src/dependencies/zycore/include" -isystem "$BUILD_DIR/_deps/zydis-build/zycore"
 )
-WIN_LIBS=(-luser32 -lxinput1_4 -lpsapi -ldbghelp -lntdll)
+WIN_LIBS=(-luser32 -lsynchronization -lxinput1_4 -lpsapi -ldbghelp -lntdll)
 
 echo "== [1/3] building bootstrap_probe.dll (bootstrap worker probe, linked against $ARCHIVE) =="
 "$CXX" "${WARN_FLAGS[@]}" -shared \
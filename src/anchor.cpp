@@ -17,12 +17,20 @@
 #include "DetourModKit/anchor.hpp"
 #include "DetourModKit/rtti.hpp"
 
+#include "internal/anchor_prescan.hpp"
+#include "internal/fnv1a.hpp"
+#include "internal/scan_multi.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_xref_index.hpp"
+
 #include "fork_join.hpp"
 
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <optional>
 #include <span>
+#include <utility>
 #include <vector>
 
 namespace DetourModKit
@@ -221,41 +229,14 @@ namespace DetourModKit
                 return ratio;
             }
 
-            // FNV-1a 64 evidence hashing for anchor_fingerprint. The fingerprint must be stable across runs and builds
-            // so a persisted manifest can be diffed, so integers are folded least-significant-byte first (a fixed order
-            // independent of host endianness) and every variable-length field is length-prefixed to keep adjacent
-            // fields unambiguous (the literal "ab" then "" cannot collide with "a" then "b").
-            inline constexpr std::uint64_t FNV1A64_OFFSET = 14695981039346656037ULL;
-            inline constexpr std::uint64_t FNV1A64_PRIME = 1099511628211ULL;
-
-            [[nodiscard]] std::uint64_t fnv1a_byte(std::uint64_t hash, std::uint8_t value) noexcept
-            {
-                return (hash ^ value) * FNV1A64_PRIME;
-            }
-
-            // Folds an integer least-significant-byte first over sizeof(T) so the result is endianness-independent. The
-            // value is widened to u64 before shifting so a 1-byte type never hits a shift-width edge case.
-            template <typename T> [[nodiscard]] std::uint64_t fnv1a_int(std::uint64_t hash, T value) noexcept
-            {
-                auto bits = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(value));
-                for (std::size_t i = 0; i < sizeof(T); ++i)
-                {
-                    hash = fnv1a_byte(hash, static_cast<std::uint8_t>(bits & 0xFFu));
-                    bits >>= 8;
-                }
-                return hash;
-            }
-
-            // Length-prefixed string field: the size (folded LSB-first) then the bytes, so adjacent fields never alias.
-            [[nodiscard]] std::uint64_t fnv1a_field(std::uint64_t hash, std::string_view field) noexcept
-            {
-                hash = fnv1a_int(hash, static_cast<std::uint64_t>(field.size()));
-                for (const char c : field)
-                {
-                    hash = fnv1a_byte(hash, static_cast<std::uint8_t>(c));
-                }
-                return hash;
-            }
+            // The FNV-1a 64 evidence hashing (internal/fnv1a.hpp) is shared with the resolution cache's request key,
+            // so the drift fingerprint and the cache agree on what "the same candidate" means.
+            using DetourModKit::detail::FNV1A64_OFFSET;
+            using DetourModKit::detail::fnv1a_byte;
+            using DetourModKit::detail::fnv1a_bytes;
+            using DetourModKit::detail::fnv1a_cascade;
+            using DetourModKit::detail::fnv1a_field;
+            using DetourModKit::detail::fnv1a_int;
 
             // Length-prefixed ASCII case-insensitive field for Windows module basenames. Region::module_named treats
             // basename casing as equivalent, so quorum evidence must do the same or two spellings of one DLL could
@@ -275,73 +256,6 @@ namespace DetourModKit
                 return hash;
             }
 
-            // Length-prefixed raw-byte field for a compiled Pattern's bytes / mask spans.
-            [[nodiscard]] std::uint64_t fnv1a_bytes(std::uint64_t hash, std::span<const std::byte> data) noexcept
-            {
-                hash = fnv1a_int(hash, static_cast<std::uint64_t>(data.size()));
-                for (const std::byte b : data)
-                {
-                    hash = fnv1a_byte(hash, static_cast<std::uint8_t>(b));
-                }
-                return hash;
-            }
-
-            // Hashes one candidate's address-independent CONTENT. scan::Pattern is compiled and does not retain its
-            // source string, so the byte tiers hash the compiled bytes + wildcard mask + result-offset plus the decode
-            // parameters -- content that is stable across a diff and computable without re-parsing. The text tiers hash
-            // their owned name / literal and shape flags directly.
-            [[nodiscard]] std::uint64_t fnv1a_candidate(std::uint64_t hash, const scan::Candidate &candidate) noexcept
-            {
-                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(candidate.mode()));
-                switch (candidate.mode())
-                {
-                case scan::Mode::Direct:
-                {
-                    const scan::DirectPattern &direct = *candidate.as_direct();
-                    hash = fnv1a_bytes(hash, direct.pattern.bytes());
-                    hash = fnv1a_bytes(hash, direct.pattern.mask());
-                    hash = fnv1a_int(hash, static_cast<std::uint64_t>(direct.pattern.offset()));
-                    hash = fnv1a_int(hash, static_cast<std::int64_t>(direct.walk_back));
-                    break;
-                }
-                case scan::Mode::RipRelative:
-                {
-                    const scan::RipRelativePattern &rip = *candidate.as_rip_relative();
-                    hash = fnv1a_bytes(hash, rip.pattern.bytes());
-                    hash = fnv1a_bytes(hash, rip.pattern.mask());
-                    hash = fnv1a_int(hash, static_cast<std::uint64_t>(rip.pattern.offset()));
-                    hash = fnv1a_int(hash, static_cast<std::int64_t>(rip.displacement_at));
-                    hash = fnv1a_int(hash, static_cast<std::uint64_t>(rip.instruction_length));
-                    break;
-                }
-                case scan::Mode::RttiVtable:
-                    hash = fnv1a_field(hash, candidate.as_rtti_vtable()->mangled);
-                    break;
-                case scan::Mode::StringXref:
-                {
-                    const scan::StringXref &xref = *candidate.as_string_xref();
-                    hash = fnv1a_field(hash, xref.text);
-                    hash = fnv1a_byte(hash, static_cast<std::uint8_t>(xref.encoding));
-                    hash = fnv1a_byte(hash, static_cast<std::uint8_t>(xref.return_mode));
-                    hash = fnv1a_byte(hash, xref.require_terminator ? 1U : 0U);
-                    hash = fnv1a_byte(hash, xref.broad_match ? 1U : 0U);
-                    break;
-                }
-                }
-                return hash;
-            }
-
-            [[nodiscard]] std::uint64_t fnv1a_cascade(std::uint64_t hash,
-                                                      std::span<const scan::Candidate> site) noexcept
-            {
-                hash = fnv1a_int(hash, static_cast<std::uint64_t>(site.size()));
-                for (const scan::Candidate &candidate : site)
-                {
-                    hash = fnv1a_candidate(hash, candidate);
-                }
-                return hash;
-            }
-
             // Hashes one anchor's own evidence with no quorum recursion. A Quorum reaching here -- which the public
             // entry point only allows for a malformed sub-anchor, since nesting is rejected at resolve time --
             // contributes only its kind, which bounds recursion to a single level.
@@ -397,20 +311,19 @@ namespace DetourModKit
             // fingerprint above: "could these two anchors decode the SAME site?", not "did this anchor's declaration
             // change?". So each anchor reduces to a SET of site-determining ATOMS -- one per resolvable rung, or one
             // for a flat kind -- and two anchors are dependent when their sets intersect. The atoms are canonicalized
-            // across two axes the drift fingerprint deliberately keeps:
-            //   * scan POLICY is dropped. A StringXref's return_mode / require_terminator / broad_match change how the
-            //     sweep runs, never WHICH located literal it resolves, so two members on one literal that differ only in
-            //     a facet decode the same reference and must count as one signal. They would otherwise double-vote --
-            //     and under a WithinTolerance quorum two policy-variant views of one site could even land within
-            //     tolerance and self-corroborate from a single physical signal.
-            //   * the AnchorKind WRAPPER is dropped. A flat StringXref and a one-rung RipGlobal whose sole rung is a
-            //     StringXref candidate both resolve through find_string_xref to the identical site; a flat
-            //     VtableIdentity and a one-rung RipGlobal wrapping an RttiVtable candidate both resolve one vtable. The
-            //     gate reduces each anchor to kind-neutral evidence ATOMS so these equivalent spellings collide.
-            // Each atom carries an EvidenceClass tag (NOT the AnchorKind and NOT the scan::Mode) so a flat text kind
-            // and a candidate rung of the same class fold identically. Comparing atom SETS (not a single whole-anchor
-            // hash) is what catches a PARTIAL rung overlap: two ladders that share one rung share that atom, so they
-            // are dependent even when their other rungs differ.
+            // across two axes the drift fingerprint deliberately keeps: * scan POLICY is dropped. A StringXref's
+            // return_mode / require_terminator / broad_match change how the sweep runs, never WHICH located literal it
+            // resolves, so two members on one literal that differ only in a facet decode the same reference and must
+            // count as one signal. They would otherwise double-vote -- and under a WithinTolerance quorum two
+            // policy-variant views of one site could even land within tolerance and self-corroborate from a single
+            // physical signal. * the AnchorKind WRAPPER is dropped. A flat StringXref and a one-rung RipGlobal whose
+            // sole rung is a StringXref candidate both resolve through find_string_xref to the identical site; a flat
+            // VtableIdentity and a one-rung RipGlobal wrapping an RttiVtable candidate both resolve one vtable. The
+            // gate reduces each anchor to kind-neutral evidence ATOMS so these equivalent spellings collide. Each atom
+            // carries an EvidenceClass tag (NOT the AnchorKind and NOT the scan::Mode) so a flat text kind and a
+            // candidate rung of the same class fold identically. Comparing atom SETS (not a single whole-anchor hash)
+            // is what catches a PARTIAL rung overlap: two ladders that share one rung share that atom, so they are
+            // dependent even when their other rungs differ.
             enum class EvidenceClass : std::uint8_t
             {
                 ByteDirect = 1,
@@ -581,237 +494,529 @@ namespace DetourModKit
             return query;
         }
 
-        ResolvedAnchor resolve_with_profile(const Anchor &anchor, const ScanProfile &profile, Region scope)
+        namespace
         {
-            ResolvedAnchor result{anchor.label, anchor.kind, AnchorStatus::Unresolved, 0};
+            // The RipGlobal cascade request, built in one place so a table prescan and the per-anchor resolve hand the
+            // resolver byte-identical requests. The resolver applies the profile's candidate order internally through
+            // ScanRequest::order, so no local reordered copy is needed here. The page class defaults to Readable (a
+            // Direct rung may resolve a data-page global); a caller that knows every rung anchors on an in-image
+            // instruction narrows it to Executable through Anchor::pages so a data-page byte twin cannot alias the
+            // site.
+            [[nodiscard]] scan::ScanRequest cascade_request(const Anchor &anchor, const ScanProfile &profile,
+                                                            Region scope) noexcept
+            {
+                return scan::ScanRequest{
+                    .ladder = anchor.site,
+                    .label = anchor.label,
+                    .scope = scope,
+                    .order = profile.candidate_order,
+                    .pages = anchor.pages,
+                    .cache = profile.resolution_cache,
+                    .hint_rva = anchor.last_seen_rva,
+                };
+            }
 
-            // Backend deny-list: a denied kind fails closed before any scan. It is never silently replaced by another
-            // backend, which would risk returning a different, wrong target. An empty profile (the default resolve()
-            // path) denies nothing, so this is a no-op there.
-            if (profile.is_denied(anchor.kind))
+            // The CodeConstant a CodeOperand anchor reads. read_code_constant has no order parameter, so the profile's
+            // candidate order is applied by reordering the site into @p ordered, which backs the returned ladder.
+            [[nodiscard]] scan::CodeConstant code_constant_of(const Anchor &anchor, const ScanProfile &profile,
+                                                              std::vector<scan::Candidate> &ordered)
             {
-                result.status = AnchorStatus::Failed;
-                return result;
+                return scan::CodeConstant{
+                    .site = profiled_candidates(profile, anchor.site, ordered),
+                    .kind = anchor.operand_kind,
+                    .operand_index = anchor.operand_index,
+                    .byte_width = anchor.byte_width,
+                };
             }
 
-            switch (anchor.kind)
+            // Where a table-level prescan placed this anchor's cascade request, if it did.
+            struct CascadeHint
             {
-            case AnchorKind::VtableIdentity:
+                const DetourModKit::detail::LadderPrescan *prescan = nullptr;
+                std::size_t request_index = 0;
+            };
+
+            // A table's RipGlobal cascades and CodeOperand site ladders, pre-swept together so every byte rung of the
+            // table is verified in one pass per scope and page class (see detail::prescan_ladders). request_of maps
+            // each anchor to its request, or NO_REQUEST when the anchor is not prescanned.
+            struct TablePrescan
             {
-                const std::optional<Address> vtable = DetourModKit::rtti::vtable_for_type(anchor.mangled, scope);
-                if (vtable)
+                static constexpr std::size_t NO_REQUEST = static_cast<std::size_t>(-1);
+                std::vector<scan::ScanRequest> requests;
+                // The profile-ordered CodeOperand ladders the requests view; reserved up front so none moves.
+                std::vector<std::vector<scan::Candidate>> ordered_sites;
+                std::vector<std::size_t> request_of;
+                DetourModKit::detail::LadderPrescan prescan;
+
+                [[nodiscard]] std::optional<CascadeHint> hint_for(std::size_t anchor_index) const noexcept
                 {
-                    commit_resolved(anchor, result, static_cast<std::int64_t>(vtable->raw()));
+                    if (anchor_index >= request_of.size() || request_of[anchor_index] == NO_REQUEST)
+                    {
+                        return std::nullopt;
+                    }
+                    return CascadeHint{&prescan, request_of[anchor_index]};
                 }
-                else
+            };
+
+            // Builds the table prescan. The prescan only accelerates the cascades, so a table too small to benefit or
+            // an allocation failure yields an empty prescan and every anchor resolves on its own exactly as before.
+            [[nodiscard]] TablePrescan prescan_table(std::span<const Anchor> anchors, const ScanProfile &profile,
+                                                     Region scope) noexcept
+            {
+                TablePrescan table;
+                std::size_t candidate_total = 0;
+                for (const Anchor &anchor : anchors)
                 {
-                    result.status = AnchorStatus::Failed;
+                    if (anchor.kind == AnchorKind::RipGlobal || anchor.kind == AnchorKind::CodeOperand)
+                    {
+                        candidate_total += anchor.site.size();
+                    }
                 }
-                break;
-            }
-            case AnchorKind::RipGlobal:
-            {
-                if (anchor.pages != scan::Pages::Readable && anchor.pages != scan::Pages::Executable)
+                if (candidate_total < DetourModKit::detail::MULTI_SCAN_MIN_PATTERNS)
                 {
-                    return failed_anchor_result(anchor);
+                    return table;
                 }
-                // The cascade itself selects Direct vs RIP-relative per candidate, so a plain global address and a
-                // RIP-relative one share this backend. The resolver applies the profile's candidate order internally
-                // through ScanRequest::order, so no local reordered copy is needed here. The page class defaults to
-                // Readable (a Direct rung may resolve a data-page global); a caller that knows every rung anchors on an
-                // in-image instruction narrows it to Executable through Anchor::pages so a data-page byte twin cannot
-                // alias the site.
-                const scan::ScanRequest request{
-                    .ladder = anchor.site,
-                    .label = anchor.label,
-                    .scope = scope,
-                    .order = profile.candidate_order,
-                    .pages = anchor.pages,
-                };
-                const Result<scan::Hit> hit = scan::resolve(request);
-                if (hit)
+                try
                 {
-                    commit_resolved(anchor, result, static_cast<std::int64_t>(hit->address.raw()));
+                    table.request_of.assign(anchors.size(), TablePrescan::NO_REQUEST);
+                    table.ordered_sites.reserve(anchors.size());
+                    for (std::size_t i = 0; i < anchors.size(); ++i)
+                    {
+                        const Anchor &anchor = anchors[i];
+                        // A child scans its parent's window, not the table scope the prescan sweeps.
+                        if (profile.is_denied(anchor.kind) || anchor.parent != NO_PARENT)
+                        {
+                            continue;
+                        }
+                        if (anchor.kind == AnchorKind::CodeOperand)
+                        {
+                            const scan::CodeConstant constant =
+                                code_constant_of(anchor, profile, table.ordered_sites.emplace_back());
+                            table.request_of[i] = table.requests.size();
+                            table.requests.push_back(DetourModKit::detail::code_constant_request(constant, scope));
+                            continue;
+                        }
+                        const bool pages_valid =
+                            anchor.pages == scan::Pages::Readable || anchor.pages == scan::Pages::Executable;
+                        if (anchor.kind != AnchorKind::RipGlobal || !pages_valid)
+                        {
+                            continue;
+                        }
+                        table.request_of[i] = table.requests.size();
+                        table.requests.push_back(cascade_request(anchor, profile, scope));
+                    }
+                    table.prescan = DetourModKit::detail::prescan_ladders(table.requests);
                 }
-                else
+                catch (...)
                 {
-                    result.status = AnchorStatus::Failed;
+                    return TablePrescan{};
                 }
-                break;
+                return table;
             }
-            case AnchorKind::CodeOperand:
+
+            ResolvedAnchor resolve_anchor(const Anchor &anchor, const ScanProfile &profile, Region scope,
+                                          std::optional<CascadeHint> hint);
+
+            // Hands the literal of every StringXref anchor the profile allows to the batch literal prescan, so the
+            // table locates all of them in one sweep of the image. Purely an accelerator, like prescan_table.
+            void prescan_table_literals(DetourModKit::detail::XrefIndexCache &cache, std::span<const Anchor> table,
+                                        const ScanProfile &profile, Region scope) noexcept
             {
-                // read_code_constant has no order parameter, so the profile's candidate order is applied by reordering
-                // the site into a local ladder up front.
-                std::vector<scan::Candidate> ordered_site;
-                const scan::CodeConstant code_constant{
-                    .site = profiled_candidates(profile, anchor.site, ordered_site),
-                    .kind = anchor.operand_kind,
-                    .operand_index = anchor.operand_index,
-                    .byte_width = anchor.byte_width,
-                };
-                const Result<std::int64_t> constant = scan::read_code_constant(code_constant, scope);
-                if (constant)
+                try
                 {
-                    commit_resolved(anchor, result, *constant);
+                    std::vector<DetourModKit::detail::StringLiteralQuery> literals;
+                    const auto add_literal = [&](const Anchor &anchor)
+                    {
+                        if (anchor.kind != AnchorKind::StringXref || profile.is_denied(anchor.kind))
+                        {
+                            return;
+                        }
+                        literals.push_back(DetourModKit::detail::StringLiteralQuery{
+                            .query = scan::StringRefQuery{.text = anchor.xref_text,
+                                                          .encoding = anchor.xref_encoding,
+                                                          .require_terminator = anchor.xref_require_terminator},
+                            .range = DetourModKit::detail::module_span(scope),
+                        });
+                    };
+                    for (const Anchor &anchor : table)
+                    {
+                        if (anchor.parent != NO_PARENT)
+                        {
+                            continue;
+                        }
+                        // A Quorum's members resolve in the table scope too, so their literals join the same sweep.
+                        if (anchor.kind == AnchorKind::Quorum && !profile.is_denied(anchor.kind))
+                        {
+                            for (const Anchor *member : anchor.quorum_members)
+                            {
+                                if (member != nullptr)
+                                {
+                                    add_literal(*member);
+                                }
+                            }
+                            continue;
+                        }
+                        add_literal(anchor);
+                    }
+                    if (literals.size() >= DetourModKit::detail::STRING_PRESCAN_MIN_LITERALS)
+                    {
+                        DetourModKit::detail::prescan_string_literals(cache, literals);
+                    }
                 }
-                else
+                catch (...)
                 {
-                    result.status = AnchorStatus::Failed;
+                    // Without the prescan each anchor locates its own literal.
                 }
-                break;
             }
-            case AnchorKind::StringXref:
+
+            // Resolves a child anchor inside the window its resolved parent opens.
+            [[nodiscard]] ResolvedAnchor resolve_child_anchor(const Anchor &anchor, const ResolvedAnchor &parent,
+                                                              const ScanProfile &profile)
             {
-                // Anchor on an immutable string literal, then resolve the instruction (or enclosing function) that
-                // references it. The string survives game updates far better than the surrounding code, so this is the
-                // most update-resilient backend; it fails closed on a missing, duplicated, or unreferenced string.
-                scan::StringRefQuery query{};
-                query.text = anchor.xref_text;
-                query.encoding = anchor.xref_encoding;
-                query.require_terminator = anchor.xref_require_terminator;
-                query.return_mode = anchor.xref_return;
-                query.broad_match = anchor.xref_broad_match;
-                // The profile can only widen the broad sweep on (never off); a per-anchor xref_broad_match still wins.
-                query = apply_profile(profile, query);
-                const Result<Address> site = scan::find_string_xref(query, scope);
-                if (site)
+                if (parent.status != AnchorStatus::Resolved || parent.value == 0)
                 {
-                    commit_resolved(anchor, result, static_cast<std::int64_t>(site->raw()));
-                }
-                else
-                {
-                    result.status = AnchorStatus::Failed;
+                    return failed_anchor_result(anchor);
                 }
-                break;
+                const std::size_t window = (anchor.parent_window != 0) ? anchor.parent_window : DEFAULT_PARENT_WINDOW;
+                const Region inside_parent{Address{static_cast<std::uintptr_t>(parent.value)}, window};
+                return resolve_anchor(anchor, profile, inside_parent, std::nullopt);
             }
-            case AnchorKind::ExportName:
+
+            // Shared body of the four table resolvers: prescan the table's cascades once, then resolve each anchor
+            // through the single-anchor path, serially or on a fork-join pool. Every string anchor of the table shares
+            // one reference index per image, so the code section is decoded once rather than once per anchor, and
+            // every scan replays one captured page map of the scope instead of walking it again. A table with parent
+            // links resolves as a dependency graph instead, parents before their children.
+            std::size_t resolve_table(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out,
+                                      const ScanProfile &profile, Region scope, bool parallel, std::size_t max_workers)
             {
-                // Resolve a named export by walking its module's PE Export Address Table -- the most update-resilient
-                // backend, since an export name is a module's documented ABI rather than a patch-fragile byte pattern.
-                // The export's owning module is often not the table's shared scan scope (a mod scanning the game exe
-                // may anchor on a game DLL's export), so an explicit export_module names it and is resolved through
-                // module_named at resolve time; an empty export_module resolves the export within the passed scope. The
-                // backend fails closed on an unloaded module, an absent or forwarded export, or a corrupt export
-                // directory, so a miss surfaces as Failed with no invented address.
-                const Region module = anchor.export_module.empty() ? scope : Region::module_named(anchor.export_module);
-                const Result<Address> site = scan::resolve_export(anchor.export_name, module);
-                if (site)
+                const std::size_t count = (anchors.size() < out.size()) ? anchors.size() : out.size();
+                const std::span<const Anchor> table = anchors.first(count);
+                // Installed before the prescans so their sweeps replay it too. A caller that already installed its own
+                // snapshots (a manifest batch) keeps them; a capture that cannot allocate only costs the replay.
+                std::vector<DetourModKit::detail::PageSnapshot> snapshots;
+                if (count > 1 && DetourModKit::detail::installed_page_snapshots().empty())
                 {
-                    commit_resolved(anchor, result, static_cast<std::int64_t>(site->raw()));
+                    try
+                    {
+                        DetourModKit::detail::add_page_snapshot(snapshots, DetourModKit::detail::module_span(scope));
+                    }
+                    catch (...)
+                    {
+                        snapshots.clear();
+                    }
                 }
-                else
+                const std::span<const DetourModKit::detail::PageSnapshot> pages =
+                    snapshots.empty() ? DetourModKit::detail::installed_page_snapshots()
+                                      : std::span<const DetourModKit::detail::PageSnapshot>(snapshots);
+                const DetourModKit::detail::ScopedPageSnapshots install_pages(pages);
+                const TablePrescan prescan = prescan_table(table, profile, scope);
+                DetourModKit::detail::XrefIndexCache xref_index;
+                prescan_table_literals(xref_index, table, profile, scope);
+                const Anchor *first_anchor = table.data();
+
+                const bool chained = std::any_of(table.begin(), table.end(),
+                                                 [](const Anchor &anchor) { return anchor.parent != NO_PARENT; });
+                if (chained)
                 {
-                    result.status = AnchorStatus::Failed;
+                    std::vector<std::size_t> parents(count);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        parents[i] = table[i].parent;
+                    }
+                    const std::vector<ResolvedAnchor> results =
+                        DetourModKit::detail::run_fork_join_graph<Anchor, ResolvedAnchor>(
+                            table, parents, parallel ? max_workers : 1,
+                            [&profile, &prescan, &xref_index, pages, scope, first_anchor](
+                                const Anchor &anchor, const ResolvedAnchor *parent) -> ResolvedAnchor
+                            {
+                                // Workers are other threads, so hand them the caller's page snapshots.
+                                const DetourModKit::detail::ScopedPageSnapshots install_pages(pages);
+                                const DetourModKit::detail::ScopedXrefIndexCache install(&xref_index);
+                                if (parent != nullptr)
+                                {
+                                    return resolve_child_anchor(anchor, *parent, profile);
+                                }
+                                const auto index = static_cast<std::size_t>(&anchor - first_anchor);
+                                return resolve_anchor(anchor, profile, scope, prescan.hint_for(index));
+                            },
+                            [](const Anchor &anchor) noexcept -> ResolvedAnchor
+                            { return failed_anchor_result(anchor); });
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = results[i];
+                    }
+                    return count;
                 }
-                break;
-            }
-            case AnchorKind::Manual:
-                // A pinned literal always "resolves"; a report should still flag it as at-risk (it cannot self-heal) by
-                // inspecting the kind. By default the validator is skipped (the pinned-literal exemption); a caller
-                // that opts in via validate_manual routes the literal through the same fail-closed validator path as a
-                // backend.
-                if (anchor.validate_manual)
+
+                if (!parallel)
                 {
-                    commit_resolved(anchor, result, anchor.manual_value);
+                    const DetourModKit::detail::ScopedXrefIndexCache install(&xref_index);
+                    for (std::size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = resolve_anchor(table[i], profile, scope, prescan.hint_for(i));
+                    }
+                    return count;
                 }
-                else
+
+                const std::vector<ResolvedAnchor> results = DetourModKit::detail::run_fork_join<Anchor, ResolvedAnchor>(
+                    table, max_workers,
+                    [&profile, &prescan, &xref_index, pages, scope,
+                     first_anchor](const Anchor &anchor) -> ResolvedAnchor
+                    {
+                        const DetourModKit::detail::ScopedPageSnapshots install_pages(pages);
+                        const DetourModKit::detail::ScopedXrefIndexCache install(&xref_index);
+                        const auto index = static_cast<std::size_t>(&anchor - first_anchor);
+                        return resolve_anchor(anchor, profile, scope, prescan.hint_for(index));
+                    },
+                    [](const Anchor &anchor) noexcept -> ResolvedAnchor { return failed_anchor_result(anchor); });
+                for (std::size_t i = 0; i < count; ++i)
                 {
-                    result.value = anchor.manual_value;
-                    result.status = AnchorStatus::Resolved;
+                    out[i] = results[i];
                 }
-                break;
-            case AnchorKind::CallArgHome:
-                // Reserved for a future prologue-dataflow backend; no resolver yet.
-                result.status = AnchorStatus::Unsupported;
-                break;
-            case AnchorKind::Quorum:
+                return count;
+            }
+
+            ResolvedAnchor resolve_anchor(const Anchor &anchor, const ScanProfile &profile, Region scope,
+                                          std::optional<CascadeHint> hint)
             {
-                // A critical target accepts only when at least N of its M candidate signals independently resolve and
-                // agree (N-of-M voting). Corroboration this way survives a patch that breaks some of the M signals as
-                // long as N of them still agree, which no single backend can. Fail closed on a malformed declaration
-                // exactly as the single-signal backends fail closed on ambiguity.
-                const std::span<const Anchor *const> members = anchor.quorum_members;
-
-                // A quorum needs at least two members to corroborate; a null member or a member that is itself a Quorum
-                // is malformed (rejecting nested Quorum bounds recursion to one level).
-                if (members.size() < 2)
+                ResolvedAnchor result{anchor.label, anchor.kind, AnchorStatus::Unresolved, 0};
+
+                // Backend deny-list: a denied kind fails closed before any scan. It is never silently replaced by
+                // another backend, which would risk returning a different, wrong target. An empty profile (the default
+                // resolve() path) denies nothing, so this is a no-op there.
+                if (profile.is_denied(anchor.kind))
                 {
                     result.status = AnchorStatus::Failed;
+                    return result;
+                }
+
+                switch (anchor.kind)
+                {
+                case AnchorKind::VtableIdentity:
+                {
+                    const std::optional<Address> vtable = DetourModKit::rtti::vtable_for_type(anchor.mangled, scope);
+                    if (vtable)
+                    {
+                        commit_resolved(anchor, result, static_cast<std::int64_t>(vtable->raw()));
+                    }
+                    else
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
                     break;
                 }
-                const bool malformed_member =
-                    std::any_of(members.begin(), members.end(), [](const Anchor *member) noexcept
-                                { return member == nullptr || member->kind == AnchorKind::Quorum; });
-                if (malformed_member)
+                case AnchorKind::RipGlobal:
                 {
-                    result.status = AnchorStatus::Failed;
+                    if (anchor.pages != scan::Pages::Readable && anchor.pages != scan::Pages::Executable)
+                    {
+                        return failed_anchor_result(anchor);
+                    }
+                    // The cascade itself selects Direct vs RIP-relative per candidate, so a plain global address and a
+                    // RIP-relative one share this backend. A table resolve may have pre-swept this cascade's byte rungs
+                    // together with the rest of the table; the prescanned resolve is outcome-identical to
+                    // scan::resolve.
+                    const scan::ScanRequest request = cascade_request(anchor, profile, scope);
+                    const Result<scan::Hit> hit =
+                        hint ? DetourModKit::detail::resolve_prescanned(request, *hint->prescan, hint->request_index)
+                             : scan::resolve(request);
+                    if (hit)
+                    {
+                        commit_resolved(anchor, result, static_cast<std::int64_t>(hit->address.raw()));
+                        result.source = hit->source;
+                    }
+                    else
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
                     break;
                 }
-
-                // Effective N: 0 means unanimous (all members), so a default two-member quorum is the strict 2-of-2.
-                // A quorum is corroboration, so an explicit N below 2 or above the member count is a malformed vote and
-                // fails closed rather than silently degrading to a single signal.
-                const std::size_t threshold = (anchor.quorum_threshold == 0) ? members.size() : anchor.quorum_threshold;
-                if (threshold < 2 || threshold > members.size())
+                case AnchorKind::CodeOperand:
                 {
-                    result.status = AnchorStatus::Failed;
+                    // A table prescan may have swept the site ladder with the rest of the table, exactly as it does a
+                    // cascade.
+                    std::vector<scan::Candidate> ordered_site;
+                    const scan::CodeConstant code_constant = code_constant_of(anchor, profile, ordered_site);
+                    const Result<std::int64_t> constant =
+                        hint ? DetourModKit::detail::read_code_constant_prescanned(code_constant, scope, *hint->prescan,
+                                                                                   hint->request_index)
+                             : scan::read_code_constant(code_constant, scope);
+                    if (constant)
+                    {
+                        commit_resolved(anchor, result, *constant);
+                    }
+                    else
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
                     break;
                 }
-
-                // Independence is a static property of the declaration, so check it before the (potentially expensive)
-                // recursive resolves. Every member must be independent of every other; one dependent pair means the
-                // vote could count a single site twice, so report it precisely instead of letting it look corroborated.
-                if (!quorum_members_pairwise_independent(members))
+                case AnchorKind::StringXref:
                 {
-                    result.status = AnchorStatus::QuorumNotIndependent;
+                    // Anchor on an immutable string literal, then resolve the instruction (or enclosing function) that
+                    // references it. The string survives game updates far better than the surrounding code, so this is
+                    // the most update-resilient backend; it fails closed on a missing, duplicated, or unreferenced
+                    // string.
+                    scan::StringRefQuery query{};
+                    query.text = anchor.xref_text;
+                    query.encoding = anchor.xref_encoding;
+                    query.require_terminator = anchor.xref_require_terminator;
+                    query.return_mode = anchor.xref_return;
+                    query.broad_match = anchor.xref_broad_match;
+                    // The profile can only widen the broad sweep on (never off); a per-anchor xref_broad_match still
+                    // wins.
+                    query = apply_profile(profile, query);
+                    const Result<Address> site = scan::find_string_xref(query, scope);
+                    if (site)
+                    {
+                        commit_resolved(anchor, result, static_cast<std::int64_t>(site->raw()));
+                    }
+                    else
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
                     break;
                 }
-
-                // Resolve each member with the same profile so a denied sub-anchor kind (or a profile broad-default)
-                // threads down; only a member that resolves casts a vote. A member that fails contributes nothing
-                // rather than vetoing the vote -- that is the whole point of N-of-M: the target still corroborates when
-                // one of several independent signals breaks on a patch, so long as N of the rest agree.
-                std::vector<std::int64_t> votes;
-                votes.reserve(members.size());
-                for (const Anchor *member : members)
+                case AnchorKind::ExportName:
                 {
-                    const ResolvedAnchor resolved_member = resolve_with_profile(*member, profile, scope);
-                    if (resolved_member.status == AnchorStatus::Resolved)
+                    // Resolve a named export by walking its module's PE Export Address Table -- the most
+                    // update-resilient backend, since an export name is a module's documented ABI rather than a
+                    // patch-fragile byte pattern. The export's owning module is often not the table's shared scan scope
+                    // (a mod scanning the game exe may anchor on a game DLL's export), so an explicit export_module
+                    // names it and is resolved through module_named at resolve time; an empty export_module resolves
+                    // the export within the passed scope. The backend fails closed on an unloaded module, an absent or
+                    // forwarded export, or a corrupt export directory, so a miss surfaces as Failed with no invented
+                    // address.
+                    const Region module =
+                        anchor.export_module.empty() ? scope : Region::module_named(anchor.export_module);
+                    const Result<Address> site = scan::resolve_export(anchor.export_name, module);
+                    if (site)
                     {
-                        votes.push_back(resolved_member.value);
+                        commit_resolved(anchor, result, static_cast<std::int64_t>(site->raw()));
                     }
+                    else
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
+                    break;
                 }
-
-                // Accept if some member's value anchors an agreement cluster of at least N votes. Scanning the votes in
-                // declaration order and committing the first qualifying center keeps the corroborated value
-                // deterministic: for ExactValue every cluster member shares the value; for WithinTolerance it is the
-                // cluster center, within tolerance of the rest. Commit through the shared path so the Quorum's own
-                // validator runs on that value (each member's validator already ran in its recursive resolve).
-                bool corroborated = false;
-                for (const std::int64_t center : votes)
+                case AnchorKind::Manual:
+                    // A pinned literal always "resolves"; a report should still flag it as at-risk (it cannot
+                    // self-heal) by inspecting the kind. By default the validator is skipped (the pinned-literal
+                    // exemption); a caller that opts in via validate_manual routes the literal through the same
+                    // fail-closed validator path as a backend.
+                    if (anchor.validate_manual)
+                    {
+                        commit_resolved(anchor, result, anchor.manual_value);
+                    }
+                    else
+                    {
+                        result.value = anchor.manual_value;
+                        result.status = AnchorStatus::Resolved;
+                    }
+                    break;
+                case AnchorKind::CallArgHome:
+                    // Reserved for a future prologue-dataflow backend; no resolver yet.
+                    result.status = AnchorStatus::Unsupported;
+                    break;
+                case AnchorKind::Quorum:
                 {
-                    if (votes_agreeing_with(center, votes, anchor.quorum_match, anchor.quorum_tolerance) >= threshold)
+                    // A critical target accepts only when at least N of its M candidate signals independently resolve
+                    // and agree (N-of-M voting). Corroboration this way survives a patch that breaks some of the M
+                    // signals as long as N of them still agree, which no single backend can. Fail closed on a malformed
+                    // declaration exactly as the single-signal backends fail closed on ambiguity.
+                    const std::span<const Anchor *const> members = anchor.quorum_members;
+
+                    // A quorum needs at least two members to corroborate; a null member or a member that is itself a
+                    // Quorum is malformed (rejecting nested Quorum bounds recursion to one level).
+                    if (members.size() < 2)
+                    {
+                        result.status = AnchorStatus::Failed;
+                        break;
+                    }
+                    const bool malformed_member =
+                        std::any_of(members.begin(), members.end(), [](const Anchor *member) noexcept
+                                    { return member == nullptr || member->kind == AnchorKind::Quorum; });
+                    if (malformed_member)
+                    {
+                        result.status = AnchorStatus::Failed;
+                        break;
+                    }
+
+                    // Effective N: 0 means unanimous (all members), so a default two-member quorum is the strict
+                    // 2-of-2. A quorum is corroboration, so an explicit N below 2 or above the member count is a
+                    // malformed vote and fails closed rather than silently degrading to a single signal.
+                    const std::size_t threshold =
+                        (anchor.quorum_threshold == 0) ? members.size() : anchor.quorum_threshold;
+                    if (threshold < 2 || threshold > members.size())
+                    {
+                        result.status = AnchorStatus::Failed;
+                        break;
+                    }
+
+                    // Independence is a static property of the declaration, so check it before the (potentially
+                    // expensive) recursive resolves. Every member must be independent of every other; one dependent
+                    // pair means the vote could count a single site twice, so report it precisely instead of letting it
+                    // look corroborated.
+                    if (!quorum_members_pairwise_independent(members))
                     {
-                        commit_resolved(anchor, result, center);
-                        corroborated = true;
+                        result.status = AnchorStatus::QuorumNotIndependent;
                         break;
                     }
+
+                    // Resolve each member with the same profile so a denied sub-anchor kind (or a profile
+                    // broad-default) threads down; only a member that resolves casts a vote. A member that fails
+                    // contributes nothing rather than vetoing the vote -- that is the whole point of N-of-M: the target
+                    // still corroborates when one of several independent signals breaks on a patch, so long as N of the
+                    // rest agree.
+                    std::vector<std::int64_t> votes;
+                    votes.reserve(members.size());
+                    for (const Anchor *member : members)
+                    {
+                        const ResolvedAnchor resolved_member = resolve_with_profile(*member, profile, scope);
+                        if (resolved_member.status == AnchorStatus::Resolved)
+                        {
+                            votes.push_back(resolved_member.value);
+                        }
+                    }
+
+                    // Accept if some member's value anchors an agreement cluster of at least N votes. Scanning the
+                    // votes in declaration order and committing the first qualifying center keeps the corroborated
+                    // value deterministic: for ExactValue every cluster member shares the value; for WithinTolerance it
+                    // is the cluster center, within tolerance of the rest. Commit through the shared path so the
+                    // Quorum's own validator runs on that value (each member's validator already ran in its recursive
+                    // resolve).
+                    bool corroborated = false;
+                    for (const std::int64_t center : votes)
+                    {
+                        if (votes_agreeing_with(center, votes, anchor.quorum_match, anchor.quorum_tolerance) >=
+                            threshold)
+                        {
+                            commit_resolved(anchor, result, center);
+                            corroborated = true;
+                            break;
+                        }
+                    }
+                    if (!corroborated)
+                    {
+                        result.status = AnchorStatus::Failed;
+                    }
+                    break;
                 }
-                if (!corroborated)
-                {
+                case AnchorKind::Unset:
+                    // A default-constructed anchor whose kind was never set. There is no backend to resolve and no
+                    // value to trust, so fail closed rather than invent one -- this is the whole reason Unset exists.
                     result.status = AnchorStatus::Failed;
+                    break;
                 }
-                break;
-            }
-            case AnchorKind::Unset:
-                // A default-constructed anchor whose kind was never set. There is no backend to resolve and no value to
-                // trust, so fail closed rather than invent one -- this is the whole reason Unset exists.
-                result.status = AnchorStatus::Failed;
-                break;
+
+                return result;
             }
+        } // anonymous namespace
 
-            return result;
+        ResolvedAnchor resolve_with_profile(const Anchor &anchor, const ScanProfile &profile, Region scope)
+        {
+            return resolve_anchor(anchor, profile, scope, std::nullopt);
         }
 
         ResolvedAnchor resolve(const Anchor &anchor, Region scope)
@@ -820,57 +1025,92 @@ namespace DetourModKit
             return resolve_with_profile(anchor, ScanProfile{}, scope);
         }
 
-        std::size_t resolve_all(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out, Region scope)
+        ResolvedAnchor resolve_with_profile(const Anchor &anchor, const ScanProfile &profile, const RegionSet &scope)
         {
-            const std::size_t count = (anchors.size() < out.size()) ? anchors.size() : out.size();
-            for (std::size_t i = 0; i < count; ++i)
+            if (scope.empty() || profile.is_denied(anchor.kind))
             {
-                out[i] = resolve(anchors[i], scope);
+                return failed_anchor_result(anchor);
             }
-            return count;
+            if (anchor.kind == AnchorKind::RipGlobal)
+            {
+                if (anchor.pages != scan::Pages::Readable && anchor.pages != scan::Pages::Executable)
+                {
+                    return failed_anchor_result(anchor);
+                }
+                // The cascade runs once over the whole set, so its first-unique-tier rule holds across the spans.
+                scan::ScanRequest request = cascade_request(anchor, profile, scope.bounds());
+                request.regions = &scope;
+                ResolvedAnchor result{anchor.label, anchor.kind, AnchorStatus::Unresolved, 0};
+                const Result<scan::Hit> hit = scan::resolve(request);
+                if (hit)
+                {
+                    commit_resolved(anchor, result, static_cast<std::int64_t>(hit->address.raw()));
+                    result.source = hit->source;
+                }
+                else
+                {
+                    result.status = AnchorStatus::Failed;
+                }
+                return result;
+            }
+
+            // Every other backend takes one Region: resolve in each span and keep the answer only when all the spans
+            // that produced one agree. Disjoint spans cannot hold the same vtable or site, so agreement is either a
+            // single span answering or a scope-independent value (a Manual literal, a named-module export).
+            std::optional<ResolvedAnchor> agreed;
+            std::optional<ResolvedAnchor> first_miss;
+            for (const Region &range : scope.ranges())
+            {
+                const ResolvedAnchor resolved = resolve_anchor(anchor, profile, range, std::nullopt);
+                if (resolved.status != AnchorStatus::Resolved)
+                {
+                    // The first span's own status (Failed, Unsupported, QuorumNotIndependent) is the report's.
+                    if (!first_miss)
+                    {
+                        first_miss = resolved;
+                    }
+                    continue;
+                }
+                if (agreed && agreed->value != resolved.value)
+                {
+                    return failed_anchor_result(anchor);
+                }
+                agreed = resolved;
+            }
+            return agreed ? *agreed : first_miss.value_or(failed_anchor_result(anchor));
         }
 
-        std::size_t resolve_all_parallel(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out, Region scope,
-                                         std::size_t max_workers)
+        ResolvedAnchor resolve(const Anchor &anchor, const RegionSet &scope)
         {
-            const std::size_t count = (anchors.size() < out.size()) ? anchors.size() : out.size();
-            const std::vector<ResolvedAnchor> results = DetourModKit::detail::run_fork_join<Anchor, ResolvedAnchor>(
-                anchors.first(count), max_workers,
-                [scope](const Anchor &anchor) -> ResolvedAnchor { return resolve(anchor, scope); },
-                [](const Anchor &anchor) noexcept -> ResolvedAnchor { return failed_anchor_result(anchor); });
+            return resolve_with_profile(anchor, ScanProfile{}, scope);
+        }
 
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                out[i] = results[i];
-            }
-            return count;
+        std::size_t resolve_all(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out, Region scope)
+        {
+            return resolve_table(anchors, out, ScanProfile{}, scope, false, 0);
+        }
+
+        std::size_t resolve_all_parallel(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out, Region scope,
+                                         std::size_t max_workers, std::stop_token stop)
+        {
+            const DetourModKit::detail::BatchCancel cancel(std::move(stop));
+            const DetourModKit::detail::ScopedBatchCancel install(&cancel);
+            return resolve_table(anchors, out, ScanProfile{}, scope, true, max_workers);
         }
 
         std::size_t resolve_all_with_profile(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out,
                                              const ScanProfile &profile, Region scope)
         {
-            const std::size_t count = (anchors.size() < out.size()) ? anchors.size() : out.size();
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                out[i] = resolve_with_profile(anchors[i], profile, scope);
-            }
-            return count;
+            return resolve_table(anchors, out, profile, scope, false, 0);
         }
 
         std::size_t resolve_all_with_profile_parallel(std::span<const Anchor> anchors, std::span<ResolvedAnchor> out,
-                                                      const ScanProfile &profile, Region scope, std::size_t max_workers)
+                                                      const ScanProfile &profile, Region scope, std::size_t max_workers,
+                                                      std::stop_token stop)
         {
-            const std::size_t count = (anchors.size() < out.size()) ? anchors.size() : out.size();
-            const std::vector<ResolvedAnchor> results = DetourModKit::detail::run_fork_join<Anchor, ResolvedAnchor>(
-                anchors.first(count), max_workers, [&profile, scope](const Anchor &anchor) -> ResolvedAnchor
-                { return resolve_with_profile(anchor, profile, scope); },
-                [](const Anchor &anchor) noexcept -> ResolvedAnchor { return failed_anchor_result(anchor); });
-
-            for (std::size_t i = 0; i < count; ++i)
-            {
-                out[i] = results[i];
-            }
-            return count;
+            const DetourModKit::detail::BatchCancel cancel(std::move(stop));
+            const DetourModKit::detail::ScopedBatchCancel install(&cancel);
+            return resolve_table(anchors, out, profile, scope, true, max_workers);
         }
 
         AnchorQuality assess_quality(std::span<const ResolvedAnchor> report) noexcept
@@ -1085,4 +1325,21 @@ namespace DetourModKit
             return "Unknown";
         }
     } // namespace anchor
+
+    scan::ScanRequest detail::anchor_cascade_request(const anchor::Anchor &anchor, Region scope) noexcept
+    {
+        if (anchor.kind == anchor::AnchorKind::CodeOperand)
+        {
+            // The empty profile keeps the declared order, so the constant's ladder is the anchor's own site.
+            return code_constant_request(scan::CodeConstant{.site = anchor.site}, scope);
+        }
+        return anchor::cascade_request(anchor, anchor::ScanProfile{}, scope);
+    }
+
+    anchor::ResolvedAnchor detail::resolve_anchor_prescanned(const anchor::Anchor &anchor, Region scope,
+                                                             const LadderPrescan &prescan, std::size_t request_index)
+    {
+        return anchor::resolve_anchor(anchor, anchor::ScanProfile{}, scope,
+                                      anchor::CascadeHint{&prescan, request_index});
+    }
 } // namespace DetourModKit
@@ -19,17 +19,17 @@
 
 #include "internal/config_reload_gate.hpp"
 #include "internal/config_watcher.hpp"
+#include "internal/ini_reader.hpp"
+#include "internal/subsystem_usage.hpp"
 #include "platform.hpp"
 
-#include "SimpleIni.h"
-
+#include <algorithm>
 #include <atomic>
 #include <charconv>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <filesystem>
-#include <fstream>
 #include <limits>
 #include <memory>
 #include <mutex>
@@ -60,143 +60,116 @@ namespace DetourModKit
 {
     namespace config
     {
+        using DetourModKit::detail::ini_bool;
+        using DetourModKit::detail::IniDocument;
+        using DetourModKit::detail::MappedFile;
         using DetourModKit::filesystem::get_runtime_directory;
-        using DetourModKit::string::trim;
 
         // Anonymous namespace for internal helpers and storage.
         namespace
         {
+            /// Trims the whitespace string::trim() strips from both ends of @p text, as a view into it.
+            [[nodiscard]] std::string_view trim_view(std::string_view text) noexcept
+            {
+                constexpr std::string_view whitespace = " \t\n\r\f\v";
+                const size_t first = text.find_first_not_of(whitespace);
+                if (first == std::string_view::npos)
+                {
+                    return {};
+                }
+                return text.substr(first, text.find_last_not_of(whitespace) - first + 1);
+            }
+
             /**
-             * @brief Parses a comma-separated string of input tokens into a vector of InputCodes.
-             * @details Each token is first matched against the named key table and source-tagged hex via
+             * @brief Resolves one trimmed input token to an InputCode.
+             * @details The token is first matched against the named key table and source-tagged hex via
              *          parse_input_name (case-insensitive). If that yields nothing, the token is parsed as a bare
              *          hexadecimal VK code (with or without 0x prefix), defaulting to InputSource::Keyboard. That
              *          bare-hex fallback is the reconstruction path for format_input_code's bare-hex keyboard form
              *          (e.g. "0xFF" -> Keyboard 0xFF): parse_input_name alone returns nullopt for a bare-hex token, so
-             *          this parser -- not parse_input_name -- closes the keyboard round-trip. Handles inline semicolon
-             *          comments, whitespace, and gracefully skips invalid tokens.
-             * @param input The raw string to parse.
-             * @return std::vector<InputCode> Parsed valid input codes.
+             *          this parser -- not parse_input_name -- closes the keyboard round-trip.
+             * @param token The token, already trimmed; works on the caller's view and allocates nothing.
+             * @return The resolved InputCode, or std::nullopt for an invalid token.
              */
-            std::vector<InputCode> parse_input_code_list(const std::string &input)
+            [[nodiscard]] std::optional<InputCode> parse_input_token(std::string_view token)
             {
-                std::vector<InputCode> result;
-
-                // Strip trailing comment from the full line
-                const size_t comment_pos = input.find(';');
-                const std::string effective =
-                    trim((comment_pos != std::string::npos) ? input.substr(0, comment_pos) : input);
-                if (effective.empty())
+                if (auto named = parse_input_name(token))
                 {
-                    return result;
+                    return named;
                 }
 
-                // Walk comma-delimited tokens without istringstream overhead
-                size_t pos = 0;
-                while (pos < effective.size())
+                // Fall back to hex parsing (defaults to Keyboard source)
+                if (token.size() >= 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X'))
                 {
-                    const size_t comma = effective.find(',', pos);
-                    const size_t end = (comma != std::string::npos) ? comma : effective.size();
-                    const std::string token = trim(effective.substr(pos, end - pos));
-                    pos = end + 1;
-
-                    if (token.empty())
-                    {
-                        continue;
-                    }
-
-                    // Try named key lookup first (case-insensitive)
-                    auto named = parse_input_name(token);
-                    if (named.has_value())
-                    {
-                        result.push_back(*named);
-                        continue;
-                    }
-
-                    // Fall back to hex parsing (defaults to Keyboard source)
-                    size_t hex_start = 0;
-                    if (token.size() >= 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X'))
-                    {
-                        hex_start = 2;
-                    }
-                    if (hex_start >= token.size())
-                    {
-                        continue;
-                    }
-
-                    // Validate all remaining characters are hex digits
-                    const std::string_view hex_part(token.data() + hex_start, token.size() - hex_start);
-                    if (hex_part.find_first_not_of("0123456789abcdefABCDEF") != std::string_view::npos)
-                    {
-                        continue;
-                    }
-
-                    unsigned int value = 0;
-                    const char *const hex_begin = hex_part.data();
-                    const char *const hex_end = hex_begin + hex_part.size();
-                    const auto [parsed_end, parse_ec] = std::from_chars(hex_begin, hex_end, value, 16);
-                    if (parse_ec != std::errc{} || parsed_end != hex_end)
-                    {
-                        continue;
-                    }
-                    if (value > static_cast<unsigned int>(std::numeric_limits<int>::max()))
-                    {
-                        continue;
-                    }
-
-                    result.push_back(InputCode{InputSource::Keyboard, static_cast<int>(value)});
+                    token.remove_prefix(2);
+                }
+                if (token.empty() || token.find_first_not_of("0123456789abcdefABCDEF") != std::string_view::npos)
+                {
+                    return std::nullopt;
                 }
 
-                return result;
+                unsigned int value = 0;
+                const char *const hex_begin = token.data();
+                const char *const hex_end = hex_begin + token.size();
+                const auto [parsed_end, parse_ec] = std::from_chars(hex_begin, hex_end, value, 16);
+                if (parse_ec != std::errc{} || parsed_end != hex_end)
+                {
+                    return std::nullopt;
+                }
+                if (value > static_cast<unsigned int>(std::numeric_limits<int>::max()))
+                {
+                    return std::nullopt;
+                }
+                return InputCode{InputSource::Keyboard, static_cast<int>(value)};
             }
 
             /**
              * @brief Parses a single key combo string into a KeyCombo struct.
              * @details Format: "modifier1+modifier2+trigger_key" where each token is a named key or hex VK code. The
-             *          last '+'-delimited token is the trigger key, all preceding tokens are modifier keys (AND logic).
-             *          This function expects a single combo with no commas; use parse_key_combo_list to split
-             *          comma-separated alternatives first.
+             *          last non-empty '+'-delimited token is the trigger key, all preceding tokens are modifier keys
+             *          (AND logic); invalid tokens are skipped. This function expects a single combo with no commas;
+             *          use parse_key_combo_list to split comma-separated alternatives first. The segments are walked
+             *          as views of @p input, so the only allocations are the combo's own two vectors.
              * @param input The raw string to parse (no commas expected).
              * @return input::KeyCombo Parsed key combination.
              */
-            input::KeyCombo parse_key_combo(const std::string &input)
+            input::KeyCombo parse_key_combo(std::string_view input)
             {
                 input::KeyCombo result;
 
-                const std::string effective = trim(input);
+                const std::string_view effective = trim_view(input);
                 if (effective.empty())
                 {
                     return result;
                 }
 
-                // Split by '+' to get segments
-                std::vector<std::string> segments;
+                // Each non-blank segment is held back until the next one shows up: a segment followed by another is a
+                // modifier, and the one left over at the end is the trigger.
+                result.modifiers.reserve(static_cast<size_t>(std::ranges::count(effective, '+')));
+                std::string_view held;
                 size_t pos = 0;
-                while (pos < effective.size())
+                while (pos <= effective.size())
                 {
-                    const size_t plus = effective.find('+', pos);
-                    const size_t end = (plus != std::string::npos) ? plus : effective.size();
-                    const std::string segment = trim(effective.substr(pos, end - pos));
-                    pos = end + 1;
-                    if (!segment.empty())
+                    const size_t plus = std::min(effective.find('+', pos), effective.size());
+                    const std::string_view segment = trim_view(effective.substr(pos, plus - pos));
+                    pos = plus + 1;
+                    if (segment.empty())
+                    {
+                        continue;
+                    }
+                    if (!held.empty())
                     {
-                        segments.push_back(segment);
+                        if (auto code = parse_input_token(held))
+                        {
+                            result.modifiers.push_back(*code);
+                        }
                     }
+                    held = segment;
                 }
 
-                if (segments.empty())
-                {
-                    return result;
-                }
-
-                // Last segment is the trigger key
-                result.keys = parse_input_code_list(segments.back());
-
-                // All preceding segments are individual modifier keys
-                for (size_t i = 0; i + 1 < segments.size(); ++i)
+                if (auto code = parse_input_token(held))
                 {
-                    auto mod_codes = parse_input_code_list(segments[i]);
-                    result.modifiers.insert(result.modifiers.end(), mod_codes.begin(), mod_codes.end());
+                    result.keys.push_back(*code);
                 }
 
                 return result;
@@ -243,14 +216,12 @@ namespace DetourModKit
              *                          empty view, in which case the WARNING uses "<unnamed>".
              * @return input::KeyComboList Parsed list of key combinations.
              */
-            input::KeyComboList parse_key_combo_list(const std::string &input, std::string_view binding_log_name = {})
+            input::KeyComboList parse_key_combo_list(std::string_view input, std::string_view binding_log_name = {})
             {
                 input::KeyComboList result;
 
                 // Strip trailing comment from the full line
-                const size_t comment_pos = input.find(';');
-                const std::string effective =
-                    trim((comment_pos != std::string::npos) ? input.substr(0, comment_pos) : input);
+                const std::string_view effective = trim_view(input.substr(0, input.find(';')));
 
                 // Disposition 1: explicit opt-out via empty string. Silent.
                 if (effective.empty())
@@ -266,12 +237,13 @@ namespace DetourModKit
                 }
 
                 // Split by comma into independent combo strings
+                result.reserve(static_cast<size_t>(std::ranges::count(effective, ',')) + 1);
                 size_t pos = 0;
                 while (pos < effective.size())
                 {
                     const size_t comma = effective.find(',', pos);
-                    const size_t end = (comma != std::string::npos) ? comma : effective.size();
-                    const std::string combo_str = trim(effective.substr(pos, end - pos));
+                    const size_t end = (comma != std::string_view::npos) ? comma : effective.size();
+                    const std::string_view combo_str = trim_view(effective.substr(pos, end - pos));
                     pos = end + 1;
 
                     if (combo_str.empty())
@@ -355,6 +327,34 @@ namespace DetourModKit
             template <typename T>
             using SetterArg = std::conditional_t<std::same_as<T, std::string>, std::string_view, T>;
 
+            /**
+             * @brief Incremental 64-bit FNV-1a over a sequence of byte ranges.
+             * @details Backs both the whole-file content hash (fnv1a_64) and the per-item value fingerprints, so one
+             *          definition of the function serves both.
+             */
+            struct Fnv1a
+            {
+                std::uint64_t state{0xcbf29ce484222325ULL};
+
+                void mix(const void *data, std::size_t size) noexcept
+                {
+                    constexpr std::uint64_t FNV_PRIME{0x00000100000001b3ULL};
+                    const auto *bytes = static_cast<const std::uint8_t *>(data);
+                    for (std::size_t i = 0; i < size; ++i)
+                    {
+                        state ^= static_cast<std::uint64_t>(bytes[i]);
+                        state *= FNV_PRIME;
+                    }
+                }
+
+                template <typename T>
+                    requires std::is_trivially_copyable_v<T>
+                void mix(const T &value) noexcept
+                {
+                    mix(&value, sizeof(value));
+                }
+            };
+
             /**
              * @brief Base class for typed configuration items.
              * @details This allows storing different types of configuration items polymorphically in a collection.
@@ -377,10 +377,24 @@ namespace DetourModKit
 
                 /**
                  * @brief Loads the configuration value from the INI file.
-                 * @param ini Reference to the CSimpleIniA object.
+                 * @param ini The parsed INI document.
                  * @param logger Reference to the Logger object.
                  */
-                virtual void load(CSimpleIniA &ini, Logger &logger) = 0;
+                virtual void load(const IniDocument &ini, Logger &logger) = 0;
+
+                /**
+                 * @brief Fingerprint of the value the last load() parsed.
+                 * @details Equal values give equal fingerprints; reload() compares it with applied_fingerprint to
+                 *          decide whether the setter must run again.
+                 */
+                [[nodiscard]] virtual std::uint64_t value_fingerprint() const = 0;
+
+                /**
+                 * @brief Fingerprint of the value last handed to the setter by load() / reload().
+                 * @details Empty before the first pass and after a setter that threw or was never reached, so the next
+                 *          pass re-applies it. Guarded by get_config_mutex().
+                 */
+                std::optional<std::uint64_t> applied_fingerprint;
 
                 /**
                  * @brief Returns a deferred callback to invoke the setter outside the config mutex.
@@ -444,26 +458,26 @@ namespace DetourModKit
                 {
                 }
 
-                void load(CSimpleIniA &ini, [[maybe_unused]] Logger &logger) override
+                void load(const IniDocument &ini, [[maybe_unused]] Logger &logger) override
                 {
                     // One generic body for the scalar/string config types. KeyComboList takes the explicit
                     // specialization below instead, because its parse path differs (nullptr INI value handling,
                     // combo-list parsing).
                     if constexpr (std::same_as<T, int>)
                     {
-                        // SimpleIni's GetLongValue parses into a long, which is 32-bit on this LLP64 target, so a value
-                        // beyond int range can saturate before this bind sees it. Read the raw string and parse it with
+                        // SimpleIni's GetLongValue parsed into a long, which is 32-bit on this LLP64 target, so a value
+                        // beyond int range could saturate before this bind saw it. Parse the raw value with
                         // std::from_chars instead, so an out-of-range or non-numeric value falls back to the registered
                         // default with a Warning. Preserve the public base rule: 0x-prefixed values are hexadecimal and
                         // everything else is decimal (including leading-zero values such as "010").
-                        const char *raw = ini.GetValue(section.c_str(), ini_key.c_str(), nullptr);
-                        if (raw == nullptr)
+                        const std::optional<std::string_view> raw = ini.value(section, ini_key);
+                        if (!raw)
                         {
                             current_value = default_value;
                         }
                         else
                         {
-                            std::string_view text = trim_blanks_and_leading_plus(std::string_view{raw});
+                            std::string_view text = trim_blanks_and_leading_plus(*raw);
 
                             int base = 10;
                             if (text.size() >= 2 && text[0] == '0' && (text[1] == 'x' || text[1] == 'X'))
@@ -481,7 +495,7 @@ namespace DetourModKit
                             {
                                 logger.warning("Config: value '{}' for '{}' is not a valid int (non-numeric or out of "
                                                "range); using default {}.",
-                                               raw, ini_key, default_value);
+                                               *raw, ini_key, default_value);
                                 current_value = default_value;
                             }
                             else
@@ -492,22 +506,22 @@ namespace DetourModKit
                     }
                     else if constexpr (std::same_as<T, float>)
                     {
-                        // SimpleIni's GetDoubleValue routes through strtod, which is locale-dependent: on a host that
-                        // installed a comma-decimal locale (common in European game and middleware runtimes) it parses
-                        // "1.5" as 1, leaves ".5" unconsumed, and GetDoubleValue then silently returns the registered
+                        // SimpleIni's GetDoubleValue routed through strtod, which is locale-dependent: on a host that
+                        // installed a comma-decimal locale (common in European game and middleware runtimes) it parsed
+                        // "1.5" as 1, left ".5" unconsumed, and GetDoubleValue then silently returned the registered
                         // default -- no truncation warning, no trace. The int branch above was already moved off the
                         // locale-sensitive parser for the analogous saturation bug; do the same here. std::from_chars
                         // is locale-independent by definition ('.' is the only accepted decimal separator), so read the
                         // raw string and parse it directly, falling back to the default with a Warning on a non-numeric
                         // or out-of-range value with the same warn-and-default discipline as the int path.
-                        const char *raw = ini.GetValue(section.c_str(), ini_key.c_str(), nullptr);
-                        if (raw == nullptr)
+                        const std::optional<std::string_view> raw = ini.value(section, ini_key);
+                        if (!raw)
                         {
                             current_value = default_value;
                         }
                         else
                         {
-                            std::string_view text = trim_blanks_and_leading_plus(std::string_view{raw});
+                            std::string_view text = trim_blanks_and_leading_plus(*raw);
 
                             float parsed = default_value;
                             const auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), parsed);
@@ -517,7 +531,7 @@ namespace DetourModKit
                                 logger.warning(
                                     "Config: value '{}' for '{}' is not a valid float (non-numeric or out of "
                                     "range); using default {}.",
-                                    raw, ini_key, default_value);
+                                    *raw, ini_key, default_value);
                                 current_value = default_value;
                             }
                             else
@@ -528,11 +542,12 @@ namespace DetourModKit
                     }
                     else if constexpr (std::same_as<T, bool>)
                     {
-                        current_value = ini.GetBoolValue(section.c_str(), ini_key.c_str(), default_value);
+                        current_value = ini_bool(ini.value(section, ini_key).value_or(std::string_view{}))
+                                            .value_or(default_value);
                     }
                     else if constexpr (std::same_as<T, std::string>)
                     {
-                        current_value = ini.GetValue(section.c_str(), ini_key.c_str(), default_value.c_str());
+                        current_value = ini.value(section, ini_key).value_or(std::string_view{default_value});
                     }
                 }
 
@@ -540,16 +555,31 @@ namespace DetourModKit
                 {
                     if constexpr (std::same_as<T, bool>)
                     {
-                        logger.debug("Config:   {} = {}", ini_key, current_value ? "true" : "false");
+                        logger.debug(log_category::config, "Config:   {} = {}", ini_key,
+                                     current_value ? "true" : "false");
                     }
                     else if constexpr (std::same_as<T, std::string>)
                     {
-                        logger.debug("Config:   {} = \"{}\"", ini_key, current_value);
+                        logger.debug(log_category::config, "Config:   {} = \"{}\"", ini_key, current_value);
                     }
                     else // int, float
                     {
-                        logger.debug("Config:   {} = {}", ini_key, current_value);
+                        logger.debug(log_category::config, "Config:   {} = {}", ini_key, current_value);
+                    }
+                }
+
+                [[nodiscard]] std::uint64_t value_fingerprint() const override
+                {
+                    Fnv1a hash;
+                    if constexpr (std::same_as<T, std::string>)
+                    {
+                        hash.mix(current_value.data(), current_value.size());
                     }
+                    else // int, float, bool
+                    {
+                        hash.mix(current_value);
+                    }
+                    return hash.state;
                 }
 
                 /// Returns a self-contained callback that invokes setter with current_value.
@@ -575,12 +605,11 @@ namespace DetourModKit
 
             // For input::KeyComboList (list of key combinations)
             template <>
-            void CallbackConfigItem<input::KeyComboList>::load(CSimpleIniA &ini, [[maybe_unused]] Logger &logger)
+            void CallbackConfigItem<input::KeyComboList>::load(const IniDocument &ini, [[maybe_unused]] Logger &logger)
             {
-                const char *ini_value_str = ini.GetValue(section.c_str(), ini_key.c_str(), nullptr);
-                if (ini_value_str != nullptr)
+                if (const std::optional<std::string_view> ini_value_str = ini.value(section, ini_key))
                 {
-                    current_value = parse_key_combo_list(ini_value_str, log_key_name);
+                    current_value = parse_key_combo_list(*ini_value_str, log_key_name);
                 }
                 else
                 {
@@ -588,16 +617,39 @@ namespace DetourModKit
                 }
             }
 
+            template <> std::uint64_t CallbackConfigItem<input::KeyComboList>::value_fingerprint() const
+            {
+                // Hash the structure, not format_key_combo_list(): its "," joins both keys within a combo and whole
+                // combos, so "A,B" as one combo and as two would collide.
+                Fnv1a hash;
+                const auto mix_codes = [&hash](const std::vector<InputCode> &codes)
+                {
+                    hash.mix(codes.size());
+                    for (const InputCode &code : codes)
+                    {
+                        hash.mix(code.source);
+                        hash.mix(code.code);
+                    }
+                };
+                hash.mix(current_value.size());
+                for (const input::KeyCombo &combo : current_value)
+                {
+                    mix_codes(combo.keys);
+                    mix_codes(combo.modifiers);
+                }
+                return hash.state;
+            }
+
             template <> void CallbackConfigItem<input::KeyComboList>::log_current_value(Logger &logger) const
             {
                 const std::string formatted = format_key_combo_list(current_value);
                 if (formatted.empty())
                 {
-                    logger.debug("Config:   {} = (none)", ini_key);
+                    logger.debug(log_category::config, "Config:   {} = (none)", ini_key);
                 }
                 else
                 {
-                    logger.debug("Config:   {} = {}", ini_key, formatted);
+                    logger.debug(log_category::config, "Config:   {} = {}", ini_key, formatted);
                 }
             }
 
@@ -740,62 +792,16 @@ namespace DetourModKit
             }
 
             /**
-             * @brief 64-bit FNV-1a hash over a raw byte range.
-             * @details Computed on the disk bytes (pre-parse) so cosmetic churn by SimpleIni's own parser (comment
-             *          stripping, whitespace normalisation) cannot skew the result. Produces a stable value on any
+             * @brief 64-bit FNV-1a hash over the raw file bytes.
+             * @details Computed on the disk bytes (pre-parse) so a comment or whitespace edit still changes it, and a
+             *          byte the parser ignores cannot collide two different files. Produces a stable value on any
              *          platform without pulling in a dependency.
              */
-            [[nodiscard]] std::uint64_t fnv1a_64(const std::vector<std::uint8_t> &bytes) noexcept
+            [[nodiscard]] std::uint64_t fnv1a_64(std::string_view bytes) noexcept
             {
-                constexpr std::uint64_t FNV_OFFSET_BASIS{0xcbf29ce484222325ULL};
-                constexpr std::uint64_t FNV_PRIME{0x00000100000001b3ULL};
-                std::uint64_t h{FNV_OFFSET_BASIS};
-                for (std::uint8_t b : bytes)
-                {
-                    h ^= static_cast<std::uint64_t>(b);
-                    h *= FNV_PRIME;
-                }
-                return h;
-            }
-
-            /**
-             * @brief Reads all bytes of @p path into memory.
-             * @details Returns std::nullopt when the file cannot be opened (e.g. mid-save by an editor that locks
-             *          exclusively). The two callers diverge on nullopt: the initial load() proceeds with the bound
-             *          defaults (a first run legitimately has no file on disk yet), while reload() clears the cached
-             *          hash and returns before the setter pass so the last-applied values are retained rather than
-             *          snapped back to defaults.
-             */
-            [[nodiscard]] std::optional<std::vector<std::uint8_t>>
-            read_ini_bytes(const std::filesystem::path &path) noexcept
-            {
-                try
-                {
-                    std::ifstream in(path, std::ios::binary);
-                    if (!in)
-                    {
-                        return std::nullopt;
-                    }
-                    in.seekg(0, std::ios::end);
-                    const std::streamsize size = in.tellg();
-                    in.seekg(0, std::ios::beg);
-                    if (size <= 0)
-                    {
-                        return std::vector<std::uint8_t>{};
-                    }
-                    std::vector<std::uint8_t> buf(static_cast<std::size_t>(size));
-                    in.read(reinterpret_cast<char *>(buf.data()), size);
-                    if (!in && !in.eof())
-                    {
-                        return std::nullopt;
-                    }
-                    buf.resize(static_cast<std::size_t>(in.gcount()));
-                    return buf;
-                }
-                catch (...)
-                {
-                    return std::nullopt;
-                }
+                Fnv1a hash;
+                hash.mix(bytes.data(), bytes.size());
+                return hash.state;
             }
 
             /**
@@ -803,49 +809,48 @@ namespace DetourModKit
              */
             struct IniLoadOutcome
             {
-                /// Bytes successfully read from disk
+                /// File opened and mapped
                 bool read_succeeded{false};
-                /// CSimpleIniA::LoadData returned SI_OK
+                /// IniDocument::parse completed (it fails only on allocation)
                 bool parse_succeeded{false};
-                /// Raw SimpleIni return code (when read_succeeded)
-                SI_Error parse_rc{SI_OK};
-                /// FNV-1a hash of the read bytes
+                /// FNV-1a hash of the mapped bytes
                 std::optional<std::uint64_t> hash;
             };
 
             /**
-             * @brief Reads the INI bytes once, computes their hash, and feeds those exact bytes to
-             *        CSimpleIniA::LoadData.
-             * @details Closes the TOCTOU window where LoadFile would re-read the file after our byte snapshot: if the
-             *          file was rewritten between the two reads, the cached hash would reflect one version and the
-             *          parsed INI another. By using LoadData on the already-buffered bytes, the hash and the parse are
-             *          guaranteed to reflect the same file state.
+             * @brief Maps the INI file once, hashes the mapped bytes, and tokenizes those same bytes into @p ini.
+             * @details The mapping denies write sharing, so the hash and the parse are guaranteed to reflect the same
+             *          file state: an editor save cannot slip between them. The parse keeps views into the mapping, so
+             *          @p file must outlive every use of @p ini. A file that cannot be opened (e.g. mid-save by an
+             *          editor holding it for writing) fails the read stage. The two callers diverge on that: the
+             *          initial load() proceeds with the bound defaults (a first run legitimately has no file on disk
+             *          yet), while reload() clears the cached hash and returns before the setter pass so the
+             *          last-applied values are retained rather than snapped back to defaults.
              * @param path Absolute path to the INI file.
-             * @param ini  SimpleIni instance to populate.
+             * @param file Receives the mapping the parsed views point into.
+             * @param ini  Document to populate.
              * @return IniLoadOutcome describing each pipeline stage.
              */
-            [[nodiscard]] IniLoadOutcome load_ini_into(const std::filesystem::path &path, CSimpleIniA &ini) noexcept
+            [[nodiscard]] IniLoadOutcome load_ini_into(const std::filesystem::path &path, MappedFile &file,
+                                                       IniDocument &ini) noexcept
             {
                 IniLoadOutcome outcome{};
-                auto bytes = read_ini_bytes(path);
-                if (!bytes.has_value())
+                if (!file.open(path))
                 {
                     return outcome;
                 }
                 outcome.read_succeeded = true;
-                outcome.hash = fnv1a_64(*bytes);
+                outcome.hash = fnv1a_64(file.text());
 
-                // CSimpleIniA::LoadData(const char*, size_t). Empty buffers are accepted by SimpleIni (SI_OK, zero
-                // sections) -- we still preserve the hash so an empty file can be content-hash-skipped.
+                // An empty file parses to zero sections -- we still preserve the hash so an empty file can be
+                // content-hash-skipped.
                 try
                 {
-                    const char *data_ptr = bytes->empty() ? "" : reinterpret_cast<const char *>(bytes->data());
-                    outcome.parse_rc = ini.LoadData(data_ptr, bytes->size());
-                    outcome.parse_succeeded = (outcome.parse_rc >= 0);
+                    ini = IniDocument::parse(file.text(), false);
+                    outcome.parse_succeeded = true;
                 }
                 catch (...)
                 {
-                    outcome.parse_rc = SI_FAIL;
                     outcome.parse_succeeded = false;
                 }
                 return outcome;
@@ -971,7 +976,7 @@ namespace DetourModKit
                     std::atomic<bool> shutdown{false};
                     // Published by service_loop on entry and cleared on exit so ~ReloadServicer can detect a self-join:
                     // config::clear() reachable from a reload setter runs on this worker thread, and joining the worker
-                    // from itself would raise std::system_error. Mirrors ConfigWatcher::Impl::worker_thread_id.
+                    // from itself would raise std::system_error. Mirrors ConfigWatcher::is_worker_thread.
                     std::atomic<std::thread::id> worker_tid{};
                     std::unique_ptr<DetourModKit::StoppableWorker> worker;
                 };
@@ -1094,7 +1099,7 @@ namespace DetourModKit
                     // Publish our thread id so ~ReloadServicer can detect a self-join: config::clear() reached from a
                     // reload setter runs on this very thread, and joining the worker from itself would raise
                     // std::system_error. Cleared on exit below so a later OS-recycled thread id cannot alias a dead
-                    // worker. Counterpart to ConfigWatcher::Impl::worker_thread_id.
+                    // worker. Counterpart to ConfigWatcher::is_worker_thread.
                     channel.worker_tid.store(std::this_thread::get_id(), std::memory_order_release);
 
                     // Wake the CV when the worker is asked to stop so the blocked wait exits promptly instead of
@@ -1191,6 +1196,88 @@ namespace DetourModKit
                 items.push_back(std::move(item));
             }
 
+            /**
+             * @brief One deferred setter call and the key it applies.
+             */
+            struct DeferredApply
+            {
+                std::function<void()> apply;
+                ConfigKey key;
+            };
+
+            /**
+             * @brief Re-reads every bound item from @p ini and queues the setters whose value changed.
+             * @details An item whose value fingerprint matches the one recorded when its setter last ran is skipped,
+             *          unless @p apply_all (load() applies everything). The new fingerprint is recorded here, before
+             *          the setter runs unlocked; forget_applied() rolls it back for a setter that then fails or is
+             *          never reached, so the next pass retries that key.
+             * @param changed Receives the keys whose value changed, if non-null.
+             * @note Caller must hold get_config_mutex().
+             */
+            void collect_applies(const IniDocument &ini, Logger &logger, bool apply_all,
+                                 std::vector<DeferredApply> &out, std::vector<ConfigKey> *changed)
+            {
+                for (const auto &item : get_registered_config_items())
+                {
+                    item->load(ini, logger);
+                    const std::uint64_t fingerprint = item->value_fingerprint();
+                    const bool value_changed = item->applied_fingerprint != fingerprint;
+                    if (!value_changed && !apply_all)
+                    {
+                        continue;
+                    }
+                    item->applied_fingerprint = fingerprint;
+                    if (value_changed && changed != nullptr)
+                    {
+                        changed->push_back(ConfigKey{item->section, item->ini_key});
+                    }
+                    if (auto cb = item->take_deferred_apply())
+                    {
+                        out.push_back(DeferredApply{std::move(cb), ConfigKey{item->section, item->ini_key}});
+                    }
+                }
+            }
+
+            /**
+             * @brief Clears the recorded fingerprint of each key in @p keys, so the next pass re-applies it.
+             * @details Matched by key rather than by item pointer: a setter may have re-bound (replaced) its item
+             *          while the registry was unlocked, and a replacement starts with no fingerprint anyway.
+             */
+            void forget_applied(const std::vector<ConfigKey> &keys)
+            {
+                if (keys.empty())
+                {
+                    return;
+                }
+                std::lock_guard<std::mutex> lock(get_config_mutex());
+                for (const auto &item : get_registered_config_items())
+                {
+                    for (const ConfigKey &key : keys)
+                    {
+                        if (item->section == key.section && item->ini_key == key.ini_key)
+                        {
+                            item->applied_fingerprint.reset();
+                            break;
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Emits the pass's ConfigReloaded on reload_events(), unless it changed nothing.
+             * @details Called after the setter pass, still under the pass lock so events arrive in application order.
+             *          Skipped once an unload latched reloads off: every handler may be code in the unloading module.
+             */
+            void emit_reloaded(std::vector<ConfigKey> changed, bool all_applied) noexcept
+            {
+                EventDispatcher<ConfigReloaded> &events = reload_events();
+                if (changed.empty() || events.empty() || reload_disabled_latch().load(std::memory_order_seq_cst))
+                {
+                    return;
+                }
+                events.emit_safe(ConfigReloaded{std::move(changed), all_applied});
+            }
+
             /**
              * @brief Determines the full absolute path for the INI configuration file.
              */
@@ -1212,7 +1299,7 @@ namespace DetourModKit
                 {
                     std::filesystem::path ini_path_obj =
                         (std::filesystem::path(module_dir) / ini_filename).lexically_normal();
-                    logger.debug("Config: Determined INI file path: {}", ini_path_obj.string());
+                    logger.debug(log_category::config, "Config: Determined INI file path: {}", ini_path_obj.string());
                     return ini_path_obj;
                 }
                 catch (const std::filesystem::filesystem_error &fs_err)
@@ -1310,10 +1397,36 @@ namespace DetourModKit
                 [](std::string_view value) { log().set_log_level(string_to_log_level(value)); }, default_value);
         }
 
+        void bind_log_level(std::string_view section, std::string_view key, LogCategory category,
+                            std::string_view default_value)
+        {
+            bind_string(
+                section, key, "Log level",
+                [category](std::string_view value)
+                {
+                    if (value.empty())
+                    {
+                        log().reset_log_level(category);
+                        return;
+                    }
+                    log().set_log_level(category, string_to_log_level(value));
+                },
+                default_value);
+        }
+
+        void bind_log_categories(std::string_view section)
+        {
+            for (std::size_t i = 0; i < LOG_CATEGORY_COUNT; ++i)
+            {
+                const auto category = static_cast<LogCategory>(i);
+                bind_log_level(section, to_string(category), category);
+            }
+        }
+
         void bind_combos(std::string_view section, std::string_view key, std::string_view display_name,
                          std::function<void(const input::KeyComboList &)> setter, std::string_view default_value)
         {
-            input::KeyComboList default_combos = parse_key_combo_list(std::string(default_value), display_name);
+            input::KeyComboList default_combos = parse_key_combo_list(default_value, display_name);
 
             std::function<void()> deferred;
             {
@@ -1445,7 +1558,8 @@ namespace DetourModKit
             // and then releases the pass lock before the stale watcher is joined.
             std::unique_lock<std::mutex> apply_lock(get_reload_apply_mutex());
 
-            std::vector<std::function<void()>> deferred_callbacks;
+            std::vector<DeferredApply> deferred_callbacks;
+            std::vector<ConfigKey> changed;
             std::string loaded_resolved_path;
             std::optional<std::uint64_t> hash_to_commit;
 
@@ -1457,14 +1571,12 @@ namespace DetourModKit
                 // convert to narrow string for logger formatting
                 std::string ini_path_str = ini_path.string();
                 loaded_resolved_path = ini_path_str;
-                CSimpleIniA ini;
-                ini.SetUnicode(false);  // Assume ASCII/MBCS INI
-                ini.SetMultiKey(false); // Disallow duplicate keys in a section
+                MappedFile file;
+                IniDocument ini;
 
-                // Read-hash-parse pipeline: read bytes once, hash them, feed the same buffer into CSimpleIniA::LoadData
-                // so the cached hash and the parsed INI state are guaranteed to reflect identical file contents
-                // (TOCTOU-free vs. a separate LoadFile call).
-                IniLoadOutcome outcome = load_ini_into(ini_path, ini);
+                // Read-hash-parse pipeline: map the file once, hash the mapped bytes, and tokenize those same bytes in
+                // place, so the cached hash and the parsed INI state are guaranteed to reflect identical file contents.
+                IniLoadOutcome outcome = load_ini_into(ini_path, file, ini);
 
                 if (!outcome.read_succeeded)
                 {
@@ -1475,15 +1587,14 @@ namespace DetourModKit
                 }
                 else if (!outcome.parse_succeeded)
                 {
-                    logger.error("Config: Failed to parse '{}' (error {}). Using defaults.", ini_path_str,
-                                 static_cast<int>(outcome.parse_rc));
+                    logger.error("Config: Failed to parse '{}' (out of memory). Using defaults.", ini_path_str);
                     // Parse failed: clear the hash so a subsequent successful load() does not spuriously hash-skip a
                     // reload against a hash computed for bytes we could not actually parse.
                     get_last_loaded_ini_hash().reset();
                 }
                 else
                 {
-                    logger.debug("Config: Opened {}", ini_path_str);
+                    logger.debug(log_category::config, "Config: Opened {}", ini_path_str);
                     // Do not publish this hash until every deferred setter succeeds. Reset any prior file's hash now
                     // so a transient failure cannot make reload() skip this file merely because the two files happen
                     // to hash identically.
@@ -1491,16 +1602,10 @@ namespace DetourModKit
                     hash_to_commit = outcome.hash;
                 }
 
-                // Read all values under lock, but defer setter callbacks
-                for (const auto &item : get_registered_config_items())
-                {
-                    item->load(ini, logger);
-                    auto cb = item->take_deferred_apply();
-                    if (cb)
-                    {
-                        deferred_callbacks.push_back(std::move(cb));
-                    }
-                }
+                // Read all values under lock, but defer setter callbacks. load() applies every item regardless of
+                // fingerprint (it may be a different file, or the first pass), and records the fingerprints reload()
+                // diffs against.
+                collect_applies(ini, logger, true, deferred_callbacks, &changed);
 
                 // Remember the INI path so reload() and enable_auto_reload() can target the same file without the
                 // caller passing it again. Store it on every outcome, not just success: the normal ship-with-defaults
@@ -1526,28 +1631,33 @@ namespace DetourModKit
             // here.
             Logger &setter_logger = log();
             bool all_setters_applied = true;
-            for (auto &cb : deferred_callbacks)
+            std::vector<ConfigKey> not_applied;
+            for (auto &deferred : deferred_callbacks)
             {
                 try
                 {
-                    cb();
+                    deferred.apply();
                 }
                 catch (const std::exception &e)
                 {
                     all_setters_applied = false;
+                    not_applied.push_back(deferred.key);
                     setter_logger.error("Config: load setter threw: {}", e.what());
                 }
                 catch (...)
                 {
                     all_setters_applied = false;
+                    not_applied.push_back(deferred.key);
                     setter_logger.error("Config: load setter threw unknown exception.");
                 }
             }
+            forget_applied(not_applied);
             if (all_setters_applied && hash_to_commit.has_value())
             {
                 std::lock_guard<std::mutex> lock(get_config_mutex());
                 get_last_loaded_ini_hash() = hash_to_commit;
             }
+            emit_reloaded(std::move(changed), all_setters_applied);
 
             // Re-point the auto-reload watcher if load() switched the config file out from under an active watcher.
             // enable_auto_reload() bound the watcher to the path recorded at enable time; a later load("other.ini")
@@ -1639,12 +1749,17 @@ namespace DetourModKit
              *                             setter pass, when no bound item produced a setter, or when an unload latch
              *                             aborted the loop before the first setter (a teardown signal, so the pass is
              *                             not reported to on_reload as a completed reload).
+             * @param[out] out_changed If non-null, receives the keys whose value changed in this pass.
              * @return true if a previous load() path was available and the reload proceeded; false if reload() was
              *         called before any load().
              */
-            bool reload_impl(bool &out_setters_ran)
+            bool reload_impl(bool &out_setters_ran, std::vector<ConfigKey> *out_changed = nullptr)
             {
                 out_setters_ran = false;
+                if (out_changed != nullptr)
+                {
+                    out_changed->clear();
+                }
 
                 // Serialize this entire pass -- read, content-hash decision, and the deferred-setter application below
                 // -- against every other reload/load pass. The setter loop runs with get_config_mutex() released (so a
@@ -1654,7 +1769,9 @@ namespace DetourModKit
                 // each application is atomic w.r.t. other passes.
                 std::lock_guard<std::mutex> apply_lock(get_reload_apply_mutex());
 
-                std::vector<std::function<void()>> deferred_callbacks;
+                std::vector<DeferredApply> deferred_callbacks;
+                std::vector<ConfigKey> changed_local;
+                std::vector<ConfigKey> &changed = out_changed != nullptr ? *out_changed : changed_local;
                 std::string ini_filename;
                 std::optional<std::uint64_t> hash_to_commit;
 
@@ -1673,21 +1790,20 @@ namespace DetourModKit
                     std::filesystem::path ini_path = get_ini_file_path(ini_filename, logger);
                     std::string ini_path_str = ini_path.string();
 
-                    CSimpleIniA ini;
-                    ini.SetUnicode(false);
-                    ini.SetMultiKey(false);
+                    MappedFile file;
+                    IniDocument ini;
 
-                    // Read-hash-parse pipeline: the hash we compare against the cache and the bytes SimpleIni parses
-                    // come from a single read. Splitting the read (one for hashing, another via LoadFile for parsing)
-                    // would let an editor save slip between them and desync the cached hash from the parsed state.
-                    IniLoadOutcome outcome = load_ini_into(ini_path, ini);
+                    // Read-hash-parse pipeline: the hash we compare against the cache and the bytes the parser reads
+                    // come from a single mapping. Splitting the read (one for hashing, another for parsing) would let
+                    // an editor save slip between them and desync the cached hash from the parsed state.
+                    IniLoadOutcome outcome = load_ini_into(ini_path, file, ini);
 
                     if (!outcome.read_succeeded)
                     {
                         // Read failure (e.g. the file is locked mid-save, exactly the transient the debounce window is
                         // meant to ride out). Clear the cached hash so a later reload that happens to read bytes
                         // identical to the last good load cannot match a stale hash and hash-skip. Then return before
-                        // the setter pass: the CSimpleIniA below was never populated, so running item->load against it
+                        // the setter pass: the IniDocument above was never populated, so running item->load against it
                         // would read every bound value as its registered default and snap live state to defaults. The
                         // reload path was still available and was handled, so this is not a NoPriorLoad case and no
                         // setters ran (out_setters_ran stays false).
@@ -1709,7 +1825,8 @@ namespace DetourModKit
                         {
                             if (current_hash == *cached_hash)
                             {
-                                logger.debug("Config: reload content unchanged (hash {:016x}); skipping setters.",
+                                logger.debug(log_category::config,
+                                             "Config: reload content unchanged (hash {:016x}); skipping setters.",
                                              current_hash);
                                 return true;
                             }
@@ -1717,20 +1834,19 @@ namespace DetourModKit
 
                         if (!outcome.parse_succeeded)
                         {
-                            // Parse failure. This is not a malformed-content case: CSimpleIniA::LoadData returns SI_OK
-                            // for any byte content (embedded nulls, unclosed sections, and binary junk all parse), so a
-                            // negative code here means an internal SimpleIni allocation failure, or a bad_alloc that
-                            // load_ini_into caught as SI_FAIL. Treat it like the read-failure branch above: return
-                            // before the setter pass so the last in-memory values are retained rather than snapped to
-                            // their defaults by item->load against a parser that failed to populate. The one asymmetry
-                            // that remains is the cached hash -- a read failure reset it (it never observed the bytes),
-                            // but a parse failure did read the bytes, so remember that hash to avoid repeatedly parsing
-                            // the same known-bad content. No setters ran, so out_setters_ran stays false and on_reload
-                            // observes setters_ran == false.
+                            // Parse failure. This is not a malformed-content case: IniDocument::parse accepts any
+                            // byte content (embedded nulls, unclosed sections, and binary junk all parse), so it fails
+                            // only when its index cannot be allocated. Treat it like the read-failure branch above:
+                            // return before the setter pass so the last in-memory values are retained rather than
+                            // snapped to their defaults by item->load against a document that failed to populate. The
+                            // one asymmetry that remains is the cached hash -- a read failure reset it (it never
+                            // observed the bytes), but a parse failure did read the bytes, so remember that hash to
+                            // avoid repeatedly parsing the same content. No setters ran, so out_setters_ran stays false
+                            // and on_reload observes setters_ran == false.
                             get_last_loaded_ini_hash() = current_hash;
-                            logger.warning("Config: reload() parse error on '{}' (error {}); retaining last values "
-                                           "(setters not re-run).",
-                                           ini_path_str, static_cast<int>(outcome.parse_rc));
+                            logger.warning("Config: reload() could not parse '{}' (out of memory); retaining last "
+                                           "values (setters not re-run).",
+                                           ini_path_str);
                             return true;
                         }
 
@@ -1738,21 +1854,15 @@ namespace DetourModKit
                         // pending so a transient setter failure or an unload-latch interruption retries identical bytes
                         // instead of pinning partially applied state behind the unchanged-content fast path.
                         hash_to_commit = current_hash;
-                        logger.debug("Config: Reloading from {}", ini_path_str);
+                        logger.debug(log_category::config, "Config: Reloading from {}", ini_path_str);
                     }
 
-                    for (const auto &item : get_registered_config_items())
-                    {
-                        item->load(ini, logger);
-                        auto cb = item->take_deferred_apply();
-                        if (cb)
-                        {
-                            deferred_callbacks.push_back(std::move(cb));
-                        }
-                    }
+                    // Only the items whose parsed value changed are queued: an edit to one key of a large config
+                    // wakes that key's setter alone rather than every bound callback and combo rebind.
+                    collect_applies(ini, logger, false, deferred_callbacks, &changed);
 
-                    logger.info("Config: Reloaded {} items from {}", get_registered_config_items().size(),
-                                ini_path_str);
+                    logger.info("Config: Reloaded {} changed of {} items from {}", changed.size(),
+                                get_registered_config_items().size(), ini_path_str);
                 }
 
                 // The registry mutex is released by the scope above; setters run unlocked (the standard deferred-setter
@@ -1767,7 +1877,8 @@ namespace DetourModKit
                 // setter that throws still counts as invoked (the values were refreshed by item->load above and the
                 // remaining setters still run), matching the existing "a real reload happened" semantics for that case.
                 bool any_setter_invoked = false;
-                for (auto &cb : deferred_callbacks)
+                std::vector<ConfigKey> not_applied;
+                for (std::size_t i = 0; i < deferred_callbacks.size(); ++i)
                 {
                     // Abort the setter pass early if a Logic DLL unload latched reloads off mid-pass. Every remaining
                     // setter is code in the unloading module, so stopping now shrinks the window in which this
@@ -1777,24 +1888,33 @@ namespace DetourModKit
                     if (reload_disabled_latch().load(std::memory_order_seq_cst))
                     {
                         all_setters_applied = false;
+                        for (; i < deferred_callbacks.size(); ++i)
+                        {
+                            not_applied.push_back(std::move(deferred_callbacks[i].key));
+                        }
                         break;
                     }
                     any_setter_invoked = true;
                     try
                     {
-                        cb();
+                        deferred_callbacks[i].apply();
                     }
                     catch (const std::exception &e)
                     {
                         all_setters_applied = false;
+                        not_applied.push_back(deferred_callbacks[i].key);
                         logger.error("Config: reload setter threw: {}", e.what());
                     }
                     catch (...)
                     {
                         all_setters_applied = false;
+                        not_applied.push_back(deferred_callbacks[i].key);
                         logger.error("Config: reload setter threw unknown exception.");
                     }
                 }
+                // A key whose setter threw or was skipped keeps its old fingerprint out of the record, so the retry of
+                // these same bytes (the content hash is not committed below) re-applies exactly those keys.
+                forget_applied(not_applied);
                 // Report whether any setter actually ran. The watcher consumer re-checks the latch before invoking the
                 // user callback, but a concurrent load() re-arm can clear the latch in the window between an abort and
                 // that re-check; sourcing this flag from the real applied count (rather than setting it true
@@ -1806,6 +1926,15 @@ namespace DetourModKit
                     std::lock_guard<std::mutex> lock(get_config_mutex());
                     get_last_loaded_ini_hash() = hash_to_commit;
                 }
+                if (out_changed != nullptr)
+                {
+                    // The caller's list stays intact; the event gets its own copy.
+                    emit_reloaded(changed, all_setters_applied);
+                }
+                else
+                {
+                    emit_reloaded(std::move(changed), all_setters_applied);
+                }
                 return true;
             }
 
@@ -1831,6 +1960,7 @@ namespace DetourModKit
                 // so a LATER load()-driven re-point can reconstruct an equivalent watcher (ConfigWatcher swallows
                 // on_reload and exposes no getter). The caller published the intended callback into the slot before
                 // calling this (enable_auto_reload sets it; the re-point leaves the prior one in place).
+                DetourModKit::detail::mark_subsystem_used(DetourModKit::detail::Subsystem::ConfigWatcher);
                 watcher = std::make_unique<DetourModKit::detail::ConfigWatcher>(
                     resolved_path, debounce,
                     [user_cb = get_reload_user_callback()]()
@@ -1877,6 +2007,38 @@ namespace DetourModKit
             return reload_impl(ignored);
         }
 
+        bool reload(std::vector<ConfigKey> &changed_keys)
+        {
+            bool ignored = false;
+            return reload_impl(ignored, &changed_keys);
+        }
+
+        EventDispatcher<ConfigReloaded> &reload_events()
+        {
+            // Function-local static, like the diagnostics dispatchers: constructed on first use, so a subscription made
+            // before the first load() needs no static-init ordering.
+            static EventDispatcher<ConfigReloaded> dispatcher;
+            return dispatcher;
+        }
+
+        Subscription on_keys_changed(std::vector<ConfigKey> keys, std::function<void(const ConfigReloaded &)> on_change)
+        {
+            if (!on_change)
+            {
+                return Subscription{};
+            }
+            return reload_events().subscribe(
+                [keys = std::move(keys), on_change = std::move(on_change)](const ConfigReloaded &event)
+                {
+                    if (keys.empty() ||
+                        std::ranges::any_of(keys, [&event](const ConfigKey &key)
+                                            { return event.changed(key.section, key.ini_key); }))
+                    {
+                        on_change(event);
+                    }
+                });
+        }
+
         namespace detail
         {
             void disable_reloads_for_unload() noexcept
@@ -1929,9 +2091,9 @@ namespace DetourModKit
             std::string resolved_path = ini_path.string();
 
             // Hold get_watcher_mutex() across the whole publish-callback-then-start step to serialize against a
-            // concurrent disable_auto_reload(). start() normally returns in milliseconds; under a pathological
-            // handshake stall it returns within the 5 s timeout, which is preferable to a use-after-free on the watcher
-            // if we released the lock and disable_auto_reload() moved the unique_ptr out and destroyed it mid-start().
+            // concurrent disable_auto_reload(). start() returns once the directory is opened and its read queued, which
+            // is preferable to a use-after-free on the watcher if we released the lock and disable_auto_reload() moved
+            // the unique_ptr out and destroyed it mid-start().
             AutoReloadStatus status;
             {
                 std::lock_guard<std::mutex> wlock(get_watcher_mutex());
@@ -1971,11 +2133,10 @@ namespace DetourModKit
             {
                 std::lock_guard<std::mutex> wlock(get_watcher_mutex());
                 auto &watcher = get_config_watcher();
-                // Detect self-invocation from a setter that fires on the watcher thread. Moving out and destroying the
-                // unique_ptr here would force the worker to join itself inside ~StoppableWorker, raising
-                // std::system_error(resource_deadlock_would_occur) from std::thread::join(). Log and return instead --
-                // callers that want to cancel from inside a reload should release the input binding guard or flip their
-                // own disable flag.
+                // Detect self-invocation from a setter that fires on the watcher's dispatch thread. Destroying the
+                // watcher there could neither flush a pending change nor wait for the reload pass the caller is still
+                // inside, so the teardown would not honor its contract. Log and return instead -- callers that want to
+                // cancel from inside a reload should release the input binding guard or flip their own disable flag.
                 if (watcher && watcher->is_worker_thread(std::this_thread::get_id()))
                 {
                     (void)log().try_log(
@@ -2007,8 +2168,8 @@ namespace DetourModKit
                 // off-lock) that a disable landed, so it does not resurrect the watcher after this returns.
                 ++get_watcher_disable_generation();
             }
-            // Destructor of ConfigWatcher joins its worker outside our mutex to avoid holding the watcher mutex across
-            // a thread-join.
+            // Destructor of ConfigWatcher waits for its in-flight callback outside our mutex, so a reload pass
+            // that takes the watcher mutex can finish.
         }
 
         bool reload_hotkey(std::string_view ini_key, std::string_view default_combo)
@@ -2026,7 +2187,7 @@ namespace DetourModKit
             // Pre-parse the default. The parser emits its own WARNING when a non-empty, non-sentinel string fails to
             // parse, so no extra log is needed for the typo path. Explicit opt-out via the NONE sentinel still returns
             // false because a hotkey with no keys is useless.
-            const input::KeyComboList parsed = parse_key_combo_list(std::string(default_combo), "Config reload hotkey");
+            const input::KeyComboList parsed = parse_key_combo_list(default_combo, "Config reload hotkey");
             if (parsed.empty())
             {
                 return false;
@@ -2112,7 +2273,7 @@ namespace DetourModKit
                 if (item->section != current_section)
                 {
                     current_section = item->section;
-                    logger.debug("Config: [{}]", current_section);
+                    logger.debug(log_category::config, "Config: [{}]", current_section);
                 }
                 item->log_current_value(logger);
             }
@@ -2160,11 +2321,13 @@ namespace DetourModKit
             // failure.
             if (count > 0)
             {
-                (void)logger.try_log(LogLevel::Debug, "Config: Cleared {} registered configuration items.", count);
+                (void)logger.try_log(log_category::config, LogLevel::Debug,
+                                     "Config: Cleared {} registered configuration items.", count);
             }
             else
             {
-                (void)logger.try_log(LogLevel::Debug, "Config: clear called, but no items were registered.");
+                (void)logger.try_log(log_category::config, LogLevel::Debug,
+                                     "Config: clear called, but no items were registered.");
             }
         }
     } // namespace config
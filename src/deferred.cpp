@@ -0,0 +1,481 @@
+/**
+ * @file deferred.cpp
+ * @brief Module-load-triggered resolution: the table registry, its loader notification, and its worker thread.
+ * @details Registered tables live in one list guarded by one mutex. The loader notification holds that mutex only to
+ *          match the mapped module's base name against the pending tables and queue the image span; it never calls
+ *          back into the loader. The worker takes the queued loads one at a time and runs each table's resolve,
+ *          install and callback with the mutex released, so the loader can take it at any time. No path that holds
+ *          the mutex calls into the loader either, which is what keeps the two from deadlocking.
+ *
+ *          A table that is running stays in the list until its run returns; the worker retires it then, and a cancel
+ *          waits for that. The registry's state is built once in static storage and never destroyed, for the same
+ *          reason as the background service's: a worker detached under the loader lock may still be running when
+ *          static destructors do.
+ */
+
+#include "DetourModKit/deferred.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+#include "DetourModKit/logger.hpp"
+#include "internal/loader_notification.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "platform.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <system_error>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace deferred
+    {
+        namespace
+        {
+            using detail::LoaderDllNotificationData;
+
+            struct TableEntry
+            {
+                std::uint64_t id = 0;
+                // UTF-16 base name the loader reports, with ".dll" appended when the registered name has no extension.
+                std::wstring match_name;
+                DeferredTable table;
+                bool queued = false;
+                bool running = false;
+            };
+
+            struct PendingLoad
+            {
+                std::uint64_t id = 0;
+                Region image;
+            };
+
+            struct RegistryState
+            {
+                // Serializes subscribe / start against shutdown; never taken by the notification or the worker.
+                std::mutex lifecycle_mutex;
+                std::mutex mutex;
+                std::condition_variable_any wake_cv;
+                std::condition_variable idle_cv;
+                std::vector<std::unique_ptr<TableEntry>> entries;
+                std::vector<PendingLoad> loads;
+                std::uint64_t next_id = 1;
+                void *cookie = nullptr;
+                std::unique_ptr<StoppableWorker> worker;
+                std::atomic<DWORD> thread_id{0};
+            };
+
+            alignas(RegistryState) unsigned char s_registry_storage[sizeof(RegistryState)];
+
+            /// Constructed on first use in static storage and never destroyed; see the file comment.
+            RegistryState &registry_state() noexcept
+            {
+                static RegistryState *const state = ::new (static_cast<void *>(s_registry_storage)) RegistryState();
+                return *state;
+            }
+
+            [[nodiscard]] bool on_worker_thread(const RegistryState &state) noexcept
+            {
+                const DWORD id = state.thread_id.load(std::memory_order_acquire);
+                return id != 0 && id == GetCurrentThreadId();
+            }
+
+            [[nodiscard]] auto find_entry(RegistryState &state, std::uint64_t id) noexcept
+            {
+                return std::find_if(state.entries.begin(), state.entries.end(),
+                                    [id](const std::unique_ptr<TableEntry> &entry) { return entry->id == id; });
+            }
+
+            /// Widens @p module to the name the loader reports; empty on malformed UTF-8.
+            [[nodiscard]] std::wstring loader_match_name(std::string_view module)
+            {
+                const int wide_length =
+                    MultiByteToWideChar(CP_UTF8, 0, module.data(), static_cast<int>(module.size()), nullptr, 0);
+                if (wide_length <= 0)
+                {
+                    return {};
+                }
+                std::wstring wide(static_cast<std::size_t>(wide_length), L'\0');
+                MultiByteToWideChar(CP_UTF8, 0, module.data(), static_cast<int>(module.size()), wide.data(),
+                                    wide_length);
+                // GetModuleHandleW (and so Region::module_named) implies ".dll" for a name without an extension.
+                if (wide.find(L'.') == std::wstring::npos)
+                {
+                    wide += L".dll";
+                }
+                return wide;
+            }
+
+            // Runs under the loader lock. It only matches names and queues spans; a failed queue allocation drops the
+            // load, and the table then waits for the module's next mapping.
+            VOID CALLBACK on_dll_notification(ULONG reason, const LoaderDllNotificationData *data, PVOID) noexcept
+            {
+                if (reason != detail::LDR_DLL_NOTIFICATION_REASON_LOADED || data == nullptr ||
+                    data->dll_base == nullptr || data->size_of_image == 0 || data->base_dll_name == nullptr ||
+                    data->base_dll_name->buffer == nullptr)
+                {
+                    return;
+                }
+                const Region image{Address{reinterpret_cast<std::uintptr_t>(data->dll_base)},
+                                   static_cast<std::size_t>(data->size_of_image)};
+                const int name_length = static_cast<int>(data->base_dll_name->length / sizeof(wchar_t));
+
+                RegistryState &state = registry_state();
+                bool queued = false;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    for (const std::unique_ptr<TableEntry> &entry : state.entries)
+                    {
+                        if (entry->queued ||
+                            CompareStringOrdinal(data->base_dll_name->buffer, name_length, entry->match_name.data(),
+                                                 static_cast<int>(entry->match_name.size()), TRUE) != CSTR_EQUAL)
+                        {
+                            continue;
+                        }
+                        try
+                        {
+                            state.loads.push_back(PendingLoad{entry->id, image});
+                        }
+                        catch (const std::bad_alloc &)
+                        {
+                            break;
+                        }
+                        entry->queued = true;
+                        queued = true;
+                    }
+                }
+                if (queued)
+                {
+                    state.wake_cv.notify_one();
+                }
+            }
+
+            void run_table(TableEntry &entry, Region image, std::stop_token stop) noexcept
+            {
+                const DeferredTable &table = entry.table;
+                try
+                {
+                    std::vector<anchor::ResolvedAnchor> anchors(table.anchors.size());
+                    (void)anchor::resolve_all(table.anchors, anchors, image);
+
+                    std::vector<hook::HookSpec> rows;
+                    rows.reserve(table.hooks.size());
+                    for (const hook::HookSpec &row : table.hooks)
+                    {
+                        rows.push_back(row.with_scope(image));
+                    }
+                    // The outcomes outlive the callback, so the hooks it leaves in them are uninstalled here, after it.
+                    std::vector<hook::InstallOutcome> outcomes(rows.size());
+                    Result<void> installed = hook::install_all(rows, outcomes, stop);
+
+                    ModuleLoad load{table.module, image, anchors, outcomes, std::move(installed)};
+                    entry.table.on_load(load);
+                }
+                catch (const std::exception &e)
+                {
+                    (void)log().try_log(LogLevel::Error, "Deferred: table for '{}' threw: {}", table.module, e.what());
+                }
+                catch (...)
+                {
+                    (void)log().try_log(LogLevel::Error, "Deferred: table for '{}' threw a non-std exception.",
+                                        table.module);
+                }
+            }
+
+            void worker_loop(std::stop_token stop) noexcept
+            {
+                RegistryState &state = registry_state();
+                const DWORD self = GetCurrentThreadId();
+                state.thread_id.store(self, std::memory_order_release);
+                while (true)
+                {
+                    TableEntry *entry = nullptr;
+                    Region image;
+                    {
+                        std::unique_lock<std::mutex> lock(state.mutex);
+                        if (!state.wake_cv.wait(lock, stop, [&state]() { return !state.loads.empty(); }))
+                        {
+                            break;
+                        }
+                        const PendingLoad load = state.loads.front();
+                        state.loads.erase(state.loads.begin());
+                        const auto it = find_entry(state, load.id);
+                        if (it == state.entries.end())
+                        {
+                            continue;
+                        }
+                        entry = it->get();
+                        entry->running = true;
+                        image = load.image;
+                    }
+
+                    run_table(*entry, image, stop);
+
+                    // Fired tables retire; the retired entry (its callback and hook rows) is destroyed unlocked.
+                    std::unique_ptr<TableEntry> retired;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        const auto it = find_entry(state, entry->id);
+                        retired = std::move(*it);
+                        state.entries.erase(it);
+                    }
+                    state.idle_cv.notify_all();
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    // A newer worker may already be running when a detached one finally gets here.
+                    DWORD expected = self;
+                    (void)state.thread_id.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+                }
+                state.idle_cv.notify_all();
+            }
+
+            /// Subscribes the notification and starts the worker unless both are up. Call with the lifecycle mutex.
+            [[nodiscard]] Result<void> ensure_started(RegistryState &state, const char *where) noexcept
+            {
+                detail::mark_subsystem_used(detail::Subsystem::DeferredResolution);
+                if (state.worker == nullptr)
+                {
+                    try
+                    {
+                        state.worker = std::make_unique<StoppableWorker>("DeferredResolution", worker_loop);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                    }
+                    catch (const std::system_error &failure)
+                    {
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where,
+                                                     static_cast<std::uintptr_t>(failure.code().value())});
+                    }
+                    catch (...)
+                    {
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where});
+                    }
+                }
+                if (state.cookie == nullptr)
+                {
+                    const auto register_notification = reinterpret_cast<detail::LdrRegisterDllNotificationFunction>(
+                        detail::ntdll_export("LdrRegisterDllNotification"));
+                    if (register_notification == nullptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where});
+                    }
+                    const LONG status = register_notification(0, &on_dll_notification, nullptr, &state.cookie);
+                    if (status != 0 || state.cookie == nullptr)
+                    {
+                        state.cookie = nullptr;
+                        return std::unexpected(
+                            Error{ErrorCode::SystemCallFailed, where, static_cast<std::uintptr_t>(status)});
+                    }
+                }
+                return {};
+            }
+
+            void cancel_entry(std::uint64_t id) noexcept
+            {
+                RegistryState &state = registry_state();
+                // Declared before the lock so a retired table is destroyed after the mutex is released.
+                std::unique_ptr<TableEntry> retired;
+                std::unique_lock<std::mutex> lock(state.mutex);
+                const auto it = find_entry(state, id);
+                if (it == state.entries.end())
+                {
+                    return;
+                }
+                if (!(*it)->running)
+                {
+                    // A load still queued for it finds no entry and is skipped.
+                    retired = std::move(*it);
+                    state.entries.erase(it);
+                    return;
+                }
+                // Running: the worker retires it when the run returns. A callback cancelling its own registration, or a
+                // cancel under the loader lock, cannot wait for that.
+                if (on_worker_thread(state) || detail::is_loader_lock_held())
+                {
+                    return;
+                }
+                state.idle_cv.wait(lock,
+                                   [&state, id]()
+                                   {
+                                       return state.thread_id.load(std::memory_order_acquire) == 0 ||
+                                              find_entry(state, id) == state.entries.end();
+                                   });
+            }
+        } // namespace
+
+        Registration::~Registration() noexcept
+        {
+            cancel();
+        }
+
+        Registration::Registration(Registration &&other) noexcept : m_id(std::exchange(other.m_id, 0)) {}
+
+        Registration &Registration::operator=(Registration &&other) noexcept
+        {
+            if (this != &other)
+            {
+                cancel();
+                m_id = std::exchange(other.m_id, 0);
+            }
+            return *this;
+        }
+
+        void Registration::cancel() noexcept
+        {
+            if (m_id != 0)
+            {
+                cancel_entry(std::exchange(m_id, 0));
+            }
+        }
+
+        bool Registration::is_pending() const noexcept
+        {
+            if (m_id == 0)
+            {
+                return false;
+            }
+            RegistryState &state = registry_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            const auto it = find_entry(state, m_id);
+            return it != state.entries.end() && !(*it)->running;
+        }
+
+        Result<Registration> on_module_load(DeferredTable table) noexcept
+        {
+            constexpr const char *where = "deferred::on_module_load";
+            if (table.module.empty() || !table.on_load)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+
+            std::unique_ptr<TableEntry> entry;
+            // Kept for the already-loaded lookup below, which runs after the entry is shared with the worker.
+            std::string module;
+            try
+            {
+                entry = std::make_unique<TableEntry>();
+                entry->match_name = loader_match_name(table.module);
+                module = table.module;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            if (entry->match_name.empty())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            entry->table = std::move(table);
+
+            RegistryState &state = registry_state();
+            std::uint64_t id = 0;
+            {
+                std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+                if (auto started = ensure_started(state, where); !started)
+                {
+                    return std::unexpected(started.error());
+                }
+                std::lock_guard<std::mutex> lock(state.mutex);
+                try
+                {
+                    state.entries.reserve(state.entries.size() + 1);
+                    state.loads.reserve(state.loads.size() + 1);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+                id = state.next_id++;
+                entry->id = id;
+                state.entries.push_back(std::move(entry));
+            }
+
+            // Registered first, so a mapping from here on is reported by the notification; the lookup (a loader call,
+            // made with the mutex released) then covers a module that mapped before. Whichever queues it first wins.
+            const Region image = Region::module_named(module);
+            if (image.size != 0)
+            {
+                bool queued = false;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    const auto it = find_entry(state, id);
+                    if (it != state.entries.end() && !(*it)->queued)
+                    {
+                        state.loads.push_back(PendingLoad{id, image});
+                        (*it)->queued = true;
+                        queued = true;
+                    }
+                }
+                if (queued)
+                {
+                    state.wake_cv.notify_one();
+                }
+            }
+            return Registration{id};
+        }
+
+        std::size_t pending_count() noexcept
+        {
+            RegistryState &state = registry_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return static_cast<std::size_t>(
+                std::count_if(state.entries.begin(), state.entries.end(),
+                              [](const std::unique_ptr<TableEntry> &entry) { return !entry->running; }));
+        }
+
+        void shutdown() noexcept
+        {
+            RegistryState &state = registry_state();
+            std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+            if (state.cookie != nullptr)
+            {
+                const auto unregister_notification = reinterpret_cast<detail::LdrUnregisterDllNotificationFunction>(
+                    detail::ntdll_export("LdrUnregisterDllNotification"));
+                if (unregister_notification != nullptr)
+                {
+                    (void)unregister_notification(state.cookie);
+                }
+                state.cookie = nullptr;
+            }
+
+            std::unique_ptr<StoppableWorker> worker = std::move(state.worker);
+            if (worker != nullptr)
+            {
+                worker->shutdown();
+            }
+
+            // A worker detached under the loader lock may still be running a table; that entry stays for it to retire.
+            std::vector<std::unique_ptr<TableEntry>> retired;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            state.loads.clear();
+            for (std::unique_ptr<TableEntry> &entry : state.entries)
+            {
+                if (!entry->running)
+                {
+                    try
+                    {
+                        retired.push_back(std::move(entry));
+                    }
+                    catch (...)
+                    {
+                        // Out of memory: leak the table rather than destroy it under the lock.
+                        (void)entry.release();
+                    }
+                }
+            }
+            std::erase_if(state.entries, [](const std::unique_ptr<TableEntry> &entry) { return entry == nullptr; });
+        }
+    } // namespace deferred
+} // namespace DetourModKit
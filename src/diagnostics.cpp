@@ -6,6 +6,11 @@
 
 #include "DetourModKit/anchor.hpp"
 #include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/profiler.hpp"
+#include "DetourModKit/scan.hpp"
+#include "internal/hook_stats.hpp"
+#include "internal/lifecycle_timings.hpp"
 
 #include <array>
 #include <atomic>
@@ -13,6 +18,7 @@
 #include <cstdint>
 #include <mutex>
 #include <unordered_map>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -156,6 +162,56 @@ namespace DetourModKit
             }
         }
 
+        namespace
+        {
+            void append_counter(std::vector<MetricSample> &out, const char *name, std::uint64_t count)
+            {
+                MetricSample &sample = out.emplace_back();
+                sample.name = name;
+                sample.kind = MetricKind::Counter;
+                sample.count = count;
+            }
+
+            void append_gauge(std::vector<MetricSample> &out, const char *name, std::int64_t value)
+            {
+                MetricSample &sample = out.emplace_back();
+                sample.name = name;
+                sample.kind = MetricKind::Gauge;
+                sample.value = value;
+            }
+
+            // The protection cache already keeps its own relaxed counters; mirror them as samples rather than
+            // recording every probe twice.
+            void append_memory_metrics(std::vector<MetricSample> &out)
+            {
+                const memory::MemoryStats stats = memory::get_memory_stats();
+                append_counter(out, "memory.cache.hits", stats.hits);
+                append_counter(out, "memory.cache.misses", stats.misses);
+                append_counter(out, "memory.cache.invalidations", stats.invalidations);
+                append_counter(out, "memory.cache.coalesced_queries", stats.coalesced_queries);
+                append_counter(out, "memory.cache.expired_entries", stats.expired_entries);
+                append_gauge(out, "memory.cache.entries", static_cast<std::int64_t>(stats.total_entries));
+                append_gauge(out, "memory.cache.pinned_entries", static_cast<std::int64_t>(stats.pinned_entries));
+            }
+
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+            // The scan telemetry registry, likewise already kept as relaxed totals.
+            void append_scan_telemetry(std::vector<MetricSample> &out)
+            {
+                const scan::ScanTelemetryTotals totals = scan::scan_telemetry_totals();
+                append_counter(out, "scan.telemetry.scans", totals.scans);
+                append_counter(out, "scan.telemetry.bytes_scanned", totals.totals.bytes_scanned);
+                append_counter(out, "scan.telemetry.regions_walked", totals.totals.regions_walked);
+                append_counter(out, "scan.telemetry.anchor_candidates", totals.totals.anchor_candidates);
+                append_counter(out, "scan.telemetry.verify_calls", totals.totals.verify_calls);
+                append_counter(out, "scan.telemetry.segmented_steps", totals.totals.segmented_steps);
+                append_counter(out, "scan.telemetry.faults", totals.totals.faults);
+                append_counter(out, "scan.telemetry.elapsed_ns",
+                               static_cast<std::uint64_t>(totals.totals.elapsed.count()));
+            }
+#endif
+        } // namespace
+
         EventDispatcher<ScannerFaultEvent> &scanner_faults()
         {
             // Function-local static: a single process-wide dispatcher constructed on first use, so the stateless
@@ -201,6 +257,19 @@ namespace DetourModKit
 
             snapshot.anchor_quality = anchor::assess_quality(anchor_report);
 
+            DetourModKit::detail::collect_lifecycle_timings(snapshot.lifecycle);
+
+            collect_metrics(snapshot.metrics);
+            append_memory_metrics(snapshot.metrics);
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+            append_scan_telemetry(snapshot.metrics);
+#endif
+
+#ifdef DMK_ENABLE_HOOK_STATS
+            DetourModKit::detail::HookStatsRegistry::instance().collect(snapshot.hook_stats);
+            snapshot.hook_stats_tick_frequency = Profiler::get_instance().qpc_frequency();
+#endif
+
             return snapshot;
         }
     } // namespace diagnostics
@@ -0,0 +1,384 @@
+/**
+ * @file diagnostics_export.cpp
+ * @brief The shared diagnostics section: SharedExport's publish task and the seqlock reader.
+ * @details A publish first encodes the whole section body into a staging buffer, off the mapping, then copies it in
+ *          between the two sequence stores. The publisher is the only writer; its mutex serializes the periodic task
+ *          with publish_now. Readers never write the section, so any number of them can poll it.
+ */
+
+#include "DetourModKit/diagnostics_export.hpp"
+
+#include "internal/background_service.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <format>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace diagnostics
+    {
+        namespace
+        {
+            constexpr const char *WHERE = "diagnostics::shared_export";
+            // Copies a reader makes before it gives up on a section that is being republished on every attempt.
+            constexpr int READ_ATTEMPTS = 64;
+
+            template <typename T> void store(std::byte *at, T value) noexcept
+            {
+                std::memcpy(at, &value, sizeof(value));
+            }
+
+            template <typename T> [[nodiscard]] T load(const std::byte *at) noexcept
+            {
+                T value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+
+            // The sequence word is 8-byte aligned in the page-aligned view, so another process sees each store whole.
+            // A reader's mapping is read-only; it only ever loads through the reference.
+            [[nodiscard]] std::atomic_ref<std::uint64_t> sequence_at(const std::byte *section) noexcept
+            {
+                return std::atomic_ref<std::uint64_t>(
+                    *reinterpret_cast<std::uint64_t *>(const_cast<std::byte *>(section + EXPORT_SEQUENCE_OFFSET)));
+            }
+
+            [[nodiscard]] std::int64_t now_us() noexcept
+            {
+                return std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::system_clock::now().time_since_epoch())
+                    .count();
+            }
+
+            // UTF-8 to UTF-16 for the Win32 section name; empty on a name that does not convert.
+            [[nodiscard]] std::wstring widen(std::string_view name)
+            {
+                if (name.empty() || name.size() > static_cast<std::size_t>(INT_MAX))
+                {
+                    return {};
+                }
+                const int length = MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, name.data(),
+                                                       static_cast<int>(name.size()), nullptr, 0);
+                if (length <= 0)
+                {
+                    return {};
+                }
+                std::wstring wide(static_cast<std::size_t>(length), L'\0');
+                MultiByteToWideChar(CP_UTF8, MB_ERR_INVALID_CHARS, name.data(), static_cast<int>(name.size()),
+                                    wide.data(), length);
+                return wide;
+            }
+
+            // Encodes the summary and metric records of @p snapshot into the body of @p staging, a section-sized
+            // buffer; its header bytes are left alone.
+            void encode_body(const Snapshot &snapshot, std::span<std::byte, EXPORT_SECTION_SIZE> staging) noexcept
+            {
+                std::ranges::fill(staging.subspan(EXPORT_HEADER_SIZE), std::byte{0});
+                std::byte *const section = staging.data();
+                for (std::size_t i = 0; i < snapshot.intentional_leaks.size(); ++i)
+                {
+                    store<std::uint64_t>(section + EXPORT_LEAKS_OFFSET + i * 8, snapshot.intentional_leaks[i]);
+                }
+                store<std::uint64_t>(section + EXPORT_HOOKS_OFFSET, snapshot.hooks_total);
+                store<std::uint64_t>(section + EXPORT_HOOKS_OFFSET + 8, snapshot.hooks_active);
+                store<std::uint64_t>(section + EXPORT_HOOKS_OFFSET + 16, snapshot.hooks_disabled);
+
+                const std::size_t count = std::min(snapshot.metrics.size(), EXPORT_MAX_METRICS);
+                store<std::uint32_t>(section + EXPORT_METRIC_COUNT_OFFSET, static_cast<std::uint32_t>(count));
+                store<std::uint32_t>(section + EXPORT_METRICS_DROPPED_OFFSET,
+                                     static_cast<std::uint32_t>(snapshot.metrics.size() - count));
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const MetricSample &sample = snapshot.metrics[i];
+                    std::byte *const record = section + EXPORT_METRICS_OFFSET + i * EXPORT_METRIC_SIZE;
+                    // One byte is kept for the terminator, so a reader can treat the name as a C string.
+                    std::memcpy(record, sample.name.data(), std::min(sample.name.size(), EXPORT_METRIC_NAME_SIZE - 1));
+                    std::byte *const fields = record + EXPORT_METRIC_NAME_SIZE;
+                    store<std::uint8_t>(fields, static_cast<std::uint8_t>(sample.kind));
+                    store<std::uint64_t>(fields + 8, sample.count);
+                    store<std::int64_t>(fields + 16, sample.value);
+                    store<std::uint64_t>(fields + 24, sample.sum);
+                    std::memcpy(fields + 32, sample.buckets.data(), sizeof(sample.buckets));
+                }
+            }
+
+            [[nodiscard]] Result<ExportedSnapshot> decode_copy(std::span<const std::byte> copy, std::uint64_t sequence)
+            {
+                ExportedSnapshot out;
+                out.sequence = sequence;
+                out.published_at_us = load<std::int64_t>(copy.data() + EXPORT_TIME_OFFSET);
+                for (std::size_t i = 0; i < out.intentional_leaks.size(); ++i)
+                {
+                    out.intentional_leaks[i] =
+                        static_cast<std::size_t>(load<std::uint64_t>(copy.data() + EXPORT_LEAKS_OFFSET + i * 8));
+                }
+                out.hooks_total = static_cast<std::size_t>(load<std::uint64_t>(copy.data() + EXPORT_HOOKS_OFFSET));
+                out.hooks_active =
+                    static_cast<std::size_t>(load<std::uint64_t>(copy.data() + EXPORT_HOOKS_OFFSET + 8));
+                out.hooks_disabled =
+                    static_cast<std::size_t>(load<std::uint64_t>(copy.data() + EXPORT_HOOKS_OFFSET + 16));
+                out.metrics_dropped = load<std::uint32_t>(copy.data() + EXPORT_METRICS_DROPPED_OFFSET);
+
+                const std::uint32_t count = load<std::uint32_t>(copy.data() + EXPORT_METRIC_COUNT_OFFSET);
+                if (count > EXPORT_MAX_METRICS)
+                {
+                    return std::unexpected(Error{ErrorCode::MalformedLine, WHERE});
+                }
+                out.metrics.reserve(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const std::byte *const record = copy.data() + EXPORT_METRICS_OFFSET + i * EXPORT_METRIC_SIZE;
+                    const std::byte *const fields = record + EXPORT_METRIC_NAME_SIZE;
+                    const std::uint8_t kind = load<std::uint8_t>(fields);
+                    if (kind > static_cast<std::uint8_t>(MetricKind::Histogram))
+                    {
+                        return std::unexpected(Error{ErrorCode::MalformedLine, WHERE});
+                    }
+                    MetricSample &sample = out.metrics.emplace_back();
+                    const char *const name = reinterpret_cast<const char *>(record);
+                    sample.name.assign(name, std::find(name, name + EXPORT_METRIC_NAME_SIZE, '\0'));
+                    sample.kind = static_cast<MetricKind>(kind);
+                    sample.count = load<std::uint64_t>(fields + 8);
+                    sample.value = load<std::int64_t>(fields + 16);
+                    sample.sum = load<std::uint64_t>(fields + 24);
+                    std::memcpy(sample.buckets.data(), fields + 32, sizeof(sample.buckets));
+                }
+                return out;
+            }
+        } // namespace
+
+        std::string shared_export_name(std::uint32_t pid)
+        {
+            return std::format("Local\\DetourModKit.Diagnostics.{}", pid);
+        }
+
+        struct SharedExport::Impl
+        {
+            std::string name;
+            HANDLE mapping{nullptr};
+            std::byte *view{nullptr};
+            std::vector<std::byte> staging;
+            std::mutex publish_mutex;
+            detail::BackgroundTaskId task{detail::NO_BACKGROUND_TASK};
+
+            ~Impl() noexcept
+            {
+                if (view != nullptr)
+                {
+                    UnmapViewOfFile(view);
+                }
+                if (mapping != nullptr)
+                {
+                    CloseHandle(mapping);
+                }
+            }
+
+            void publish() noexcept
+            {
+                const std::lock_guard<std::mutex> lock(publish_mutex);
+                try
+                {
+                    const Snapshot snapshot = collect();
+                    encode_body(snapshot, std::span<std::byte, EXPORT_SECTION_SIZE>(staging.data(), staging.size()));
+                }
+                catch (...)
+                {
+                    // A sample that cannot be collected leaves the previous publish in place.
+                    return;
+                }
+                std::atomic_ref<std::uint64_t> sequence = sequence_at(view);
+                const std::uint64_t start = sequence.load(std::memory_order_relaxed);
+                sequence.store(start + 1, std::memory_order_relaxed);
+                // Keeps the odd sequence ahead of every body store, so a reader that sees new bytes sees the odd mark.
+                std::atomic_thread_fence(std::memory_order_release);
+                store<std::int64_t>(view + EXPORT_TIME_OFFSET, now_us());
+                std::memcpy(view + EXPORT_HEADER_SIZE, staging.data() + EXPORT_HEADER_SIZE,
+                            EXPORT_SECTION_SIZE - EXPORT_HEADER_SIZE);
+                sequence.store(start + 2, std::memory_order_release);
+            }
+        };
+
+        SharedExport::SharedExport(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+        SharedExport::SharedExport(SharedExport &&) noexcept = default;
+
+        SharedExport &SharedExport::operator=(SharedExport &&other) noexcept
+        {
+            if (this != &other)
+            {
+                stop();
+                m_impl = std::move(other.m_impl);
+            }
+            return *this;
+        }
+
+        SharedExport::~SharedExport() noexcept
+        {
+            stop();
+        }
+
+        void SharedExport::stop() noexcept
+        {
+            if (!m_impl)
+            {
+                return;
+            }
+            if (!detail::cancel_background_task(m_impl->task))
+            {
+                // Under the loader lock the task may still be running on the service thread; leave it its state.
+                static_cast<void>(m_impl.release());
+                return;
+            }
+            m_impl.reset();
+        }
+
+        Result<SharedExport> SharedExport::start(SharedExportConfig config)
+        {
+            if (config.period.count() <= 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, WHERE});
+            }
+            try
+            {
+                auto impl = std::make_unique<Impl>();
+                impl->name = config.name.empty() ? shared_export_name(GetCurrentProcessId()) : std::move(config.name);
+                impl->staging.resize(EXPORT_SECTION_SIZE);
+                const std::wstring wide_name = widen(impl->name);
+                if (wide_name.empty())
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, WHERE});
+                }
+                impl->mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0,
+                                                   static_cast<DWORD>(EXPORT_SECTION_SIZE), wide_name.c_str());
+                if (impl->mapping == nullptr)
+                {
+                    return std::unexpected(Error{ErrorCode::SystemCallFailed, WHERE, GetLastError()});
+                }
+                impl->view = static_cast<std::byte *>(MapViewOfFile(impl->mapping, FILE_MAP_WRITE, 0, 0, 0));
+                if (impl->view == nullptr)
+                {
+                    return std::unexpected(Error{ErrorCode::SystemCallFailed, WHERE, GetLastError()});
+                }
+
+                // A section left behind by an earlier export in this process carries on from its sequence, so a
+                // reader never sees the count go backwards. The header is rewritten before anything is published.
+                const std::uint64_t sequence = sequence_at(impl->view).load(std::memory_order_relaxed);
+                sequence_at(impl->view).store(sequence & ~std::uint64_t{1}, std::memory_order_relaxed);
+                store<std::uint64_t>(impl->view + EXPORT_MAGIC_OFFSET, EXPORT_MAGIC);
+                store<std::uint32_t>(impl->view + EXPORT_VERSION_OFFSET, EXPORT_VERSION);
+                store<std::uint32_t>(impl->view + EXPORT_SIZE_OFFSET, static_cast<std::uint32_t>(EXPORT_SECTION_SIZE));
+                impl->publish();
+
+                Impl *const raw = impl.get();
+                Result<detail::BackgroundTaskId> task = detail::schedule_background_timer(
+                    "Diagnostics export", config.period, [raw]() noexcept { raw->publish(); });
+                if (!task)
+                {
+                    return std::unexpected(task.error());
+                }
+                impl->task = *task;
+                return SharedExport(std::move(impl));
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, WHERE});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::Unknown, WHERE});
+            }
+        }
+
+        void SharedExport::publish_now() noexcept
+        {
+            if (m_impl)
+            {
+                m_impl->publish();
+            }
+        }
+
+        const std::string &SharedExport::name() const noexcept
+        {
+            static const std::string s_empty;
+            return m_impl ? m_impl->name : s_empty;
+        }
+
+        Result<ExportedSnapshot> decode_shared_export(std::span<const std::byte> section)
+        {
+            if (section.size() < EXPORT_SECTION_SIZE ||
+                load<std::uint64_t>(section.data() + EXPORT_MAGIC_OFFSET) != EXPORT_MAGIC ||
+                load<std::uint32_t>(section.data() + EXPORT_VERSION_OFFSET) != EXPORT_VERSION ||
+                load<std::uint32_t>(section.data() + EXPORT_SIZE_OFFSET) != EXPORT_SECTION_SIZE)
+            {
+                return std::unexpected(Error{ErrorCode::MissingHeader, WHERE});
+            }
+            try
+            {
+                std::vector<std::byte> copy(EXPORT_SECTION_SIZE);
+                const std::atomic_ref<std::uint64_t> sequence = sequence_at(section.data());
+                for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt)
+                {
+                    const std::uint64_t before = sequence.load(std::memory_order_acquire);
+                    if (before == 0)
+                    {
+                        return std::unexpected(Error{ErrorCode::MissingHeader, WHERE});
+                    }
+                    if ((before & 1) != 0)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    std::memcpy(copy.data(), section.data(), EXPORT_SECTION_SIZE);
+                    // Keeps the copy ahead of the second sequence load, so a publish that overlapped it is seen.
+                    std::atomic_thread_fence(std::memory_order_acquire);
+                    if (sequence.load(std::memory_order_relaxed) == before)
+                    {
+                        return decode_copy(copy, before);
+                    }
+                }
+                return std::unexpected(Error{ErrorCode::MalformedLine, WHERE});
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, WHERE});
+            }
+        }
+
+        Result<ExportedSnapshot> read_shared_export(std::string_view name)
+        {
+            const std::wstring wide_name = widen(name);
+            if (wide_name.empty())
+            {
+                return std::unexpected(Error{ErrorCode::FileOpenFailed, WHERE});
+            }
+            HANDLE mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, wide_name.c_str());
+            if (mapping == nullptr)
+            {
+                return std::unexpected(Error{ErrorCode::FileOpenFailed, WHERE, GetLastError()});
+            }
+            const void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            if (view == nullptr)
+            {
+                const DWORD error = GetLastError();
+                CloseHandle(mapping);
+                return std::unexpected(Error{ErrorCode::FileOpenFailed, WHERE, error});
+            }
+            MEMORY_BASIC_INFORMATION info{};
+            const std::size_t mapped =
+                VirtualQuery(view, &info, sizeof(info)) == sizeof(info) ? info.RegionSize : std::size_t{0};
+            Result<ExportedSnapshot> result =
+                decode_shared_export(std::span<const std::byte>(static_cast<const std::byte *>(view), mapped));
+            UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            return result;
+        }
+    } // namespace diagnostics
+} // namespace DetourModKit
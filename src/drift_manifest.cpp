@@ -1,14 +1,27 @@
 /**
  * @file drift_manifest.cpp
- * @brief Durable serialization of self-heal drift reports.
+ * @brief Durable serialization of self-heal drift reports: the text manifest and the binary report.
+ * @details The binary report is a fixed header (magic, format version, entry count, pool size, total size, and an
+ *          FNV-1a 64 checksum of everything after it), one fixed-size record per entry, and a string pool of names.
+ *          Records hold explicit-width fields and are read with memcpy, so the mapping's alignment never matters.
+ *          DriftReportView::parse checks everything once so that reading an entry afterwards cannot fail.
  */
 
 #include "DetourModKit/detail/drift_manifest.hpp"
 
+#include "internal/fnv1a.hpp"
+#include "internal/ini_reader.hpp"
+
+#include <array>
 #include <charconv>
+#include <cstring>
 #include <fstream>
 #include <iterator>
+#include <limits>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace DetourModKit
 {
@@ -88,6 +101,65 @@ namespace DetourModKit
             {
                 return std::unexpected(Error{code, "rtti::drift_manifest"});
             }
+
+            constexpr std::array<char, 8> DRIFT_MAGIC = {'D', 'M', 'K', 'D', 'R', 'F', 'T', '\0'};
+
+            struct DriftBlobHeader
+            {
+                std::array<char, 8> magic;
+                std::uint32_t format_version;
+                std::uint32_t entry_count;
+                std::uint32_t strings_size;
+                std::uint32_t reserved;
+                std::uint64_t total_size;
+                // FNV-1a 64 over every byte after the header.
+                std::uint64_t checksum;
+            };
+
+            struct DriftBlobEntry
+            {
+                // A range of the string pool.
+                std::uint32_t name_offset;
+                std::uint32_t name_size;
+                std::int64_t nominal_offset;
+                std::int64_t healed_offset;
+                std::int64_t delta;
+                std::uint16_t error;
+                std::uint8_t ok;
+                std::array<std::uint8_t, 5> reserved;
+            };
+
+            // The on-disk layout is these exact sizes; a padding change would silently break every saved report.
+            static_assert(sizeof(DriftBlobHeader) == 40 && sizeof(DriftBlobEntry) == 40,
+                          "binary drift report layout changed; bump DRIFT_BINARY_FORMAT_VERSION");
+            static_assert(std::is_trivially_copyable_v<DriftBlobHeader> &&
+                          std::is_trivially_copyable_v<DriftBlobEntry>);
+
+            // The codes the text form has a token for. Anything else is stored as BadDescriptor, the text form's
+            // fallback, so the two formats read back the same report.
+            [[nodiscard]] bool is_heal_error(ErrorCode error) noexcept
+            {
+                return error == ErrorCode::Ok || error == ErrorCode::BadDescriptor ||
+                       error == ErrorCode::HealNoMatch || error == ErrorCode::HealAmbiguous;
+            }
+
+            [[nodiscard]] std::uint64_t checksum_of(std::span<const std::byte> bytes) noexcept
+            {
+                std::uint64_t hash = detail::FNV1A64_OFFSET;
+                for (const std::byte b : bytes)
+                {
+                    hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(b));
+                }
+                return hash;
+            }
+
+            [[nodiscard]] DriftBlobEntry blob_entry(std::span<const std::byte> blob, std::size_t index) noexcept
+            {
+                DriftBlobEntry entry;
+                std::memcpy(&entry, blob.data() + sizeof(DriftBlobHeader) + index * sizeof(DriftBlobEntry),
+                            sizeof(entry));
+                return entry;
+            }
         } // anonymous namespace
 
         std::string serialize_drift_report(std::span<const DriftEntry> entries)
@@ -247,5 +319,174 @@ namespace DetourModKit
             const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
             return parse_drift_report(text);
         }
+
+        Result<std::vector<std::byte>> serialize_drift_report_binary(std::span<const DriftEntry> entries)
+        {
+            constexpr std::size_t LIMIT = std::numeric_limits<std::uint32_t>::max();
+            std::size_t strings_size = 0;
+            for (const DriftEntry &entry : entries)
+            {
+                strings_size += entry.name.size();
+            }
+            if (entries.size() > LIMIT || strings_size > LIMIT)
+            {
+                return manifest_error(ErrorCode::InvalidArg);
+            }
+
+            try
+            {
+                const std::size_t strings_at = sizeof(DriftBlobHeader) + entries.size() * sizeof(DriftBlobEntry);
+                std::vector<std::byte> blob(strings_at + strings_size);
+                std::size_t name_at = 0;
+                for (std::size_t index = 0; index < entries.size(); ++index)
+                {
+                    const DriftEntry &entry = entries[index];
+                    const DriftBlobEntry stored{
+                        .name_offset = static_cast<std::uint32_t>(name_at),
+                        .name_size = static_cast<std::uint32_t>(entry.name.size()),
+                        .nominal_offset = entry.nominal_offset,
+                        .healed_offset = entry.healed_offset,
+                        .delta = entry.delta,
+                        .error = static_cast<std::uint16_t>(is_heal_error(entry.error) ? entry.error
+                                                                                       : ErrorCode::BadDescriptor),
+                        .ok = static_cast<std::uint8_t>(entry.ok ? 1 : 0),
+                        .reserved = {},
+                    };
+                    std::memcpy(blob.data() + sizeof(DriftBlobHeader) + index * sizeof(DriftBlobEntry), &stored,
+                                sizeof(stored));
+                    std::memcpy(blob.data() + strings_at + name_at, entry.name.data(), entry.name.size());
+                    name_at += entry.name.size();
+                }
+
+                const DriftBlobHeader header{
+                    .magic = DRIFT_MAGIC,
+                    .format_version = DRIFT_BINARY_FORMAT_VERSION,
+                    .entry_count = static_cast<std::uint32_t>(entries.size()),
+                    .strings_size = static_cast<std::uint32_t>(strings_size),
+                    .reserved = 0,
+                    .total_size = blob.size(),
+                    .checksum = checksum_of(std::span<const std::byte>(blob).subspan(sizeof(DriftBlobHeader))),
+                };
+                std::memcpy(blob.data(), &header, sizeof(header));
+                return blob;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return manifest_error(ErrorCode::OutOfMemory);
+            }
+        }
+
+        Result<DriftReportView> DriftReportView::parse(std::span<const std::byte> blob) noexcept
+        {
+            DriftBlobHeader header;
+            if (blob.size() < sizeof(header))
+            {
+                return manifest_error(ErrorCode::MissingHeader);
+            }
+            std::memcpy(&header, blob.data(), sizeof(header));
+            if (header.magic != DRIFT_MAGIC || header.format_version != DRIFT_BINARY_FORMAT_VERSION ||
+                header.total_size != blob.size())
+            {
+                return manifest_error(ErrorCode::MissingHeader);
+            }
+            // The counts are 32-bit, so the body size cannot overflow 64-bit arithmetic.
+            const std::uint64_t body =
+                std::uint64_t{header.entry_count} * sizeof(DriftBlobEntry) + header.strings_size;
+            if (body != blob.size() - sizeof(header) || checksum_of(blob.subspan(sizeof(header))) != header.checksum)
+            {
+                return manifest_error(ErrorCode::MalformedLine);
+            }
+
+            // One pass over the records, so operator[] never has to check anything.
+            for (std::size_t index = 0; index < header.entry_count; ++index)
+            {
+                const DriftBlobEntry stored = blob_entry(blob, index);
+                if (std::uint64_t{stored.name_offset} + stored.name_size > header.strings_size || stored.ok > 1 ||
+                    !is_heal_error(static_cast<ErrorCode>(stored.error)))
+                {
+                    return manifest_error(ErrorCode::MalformedLine);
+                }
+            }
+            return DriftReportView(blob, header.entry_count,
+                                   sizeof(header) + std::size_t{header.entry_count} * sizeof(DriftBlobEntry));
+        }
+
+        DriftEntry DriftReportView::operator[](std::size_t index) const noexcept
+        {
+            const DriftBlobEntry stored = blob_entry(m_blob, index);
+            return DriftEntry{
+                .name = std::string_view(reinterpret_cast<const char *>(m_blob.data() + m_strings_at +
+                                                                        stored.name_offset),
+                                         stored.name_size),
+                .nominal_offset = static_cast<std::ptrdiff_t>(stored.nominal_offset),
+                .healed_offset = static_cast<std::ptrdiff_t>(stored.healed_offset),
+                .delta = static_cast<std::ptrdiff_t>(stored.delta),
+                .ok = stored.ok != 0,
+                .error = static_cast<ErrorCode>(stored.error),
+            };
+        }
+
+        Result<void> write_drift_report_binary_to_file(const std::string &path, std::span<const DriftEntry> entries)
+        {
+            const Result<std::vector<std::byte>> blob = serialize_drift_report_binary(entries);
+            if (!blob)
+            {
+                return std::unexpected(blob.error());
+            }
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file)
+            {
+                return manifest_error(ErrorCode::FileOpenFailed);
+            }
+            file.write(reinterpret_cast<const char *>(blob->data()), static_cast<std::streamsize>(blob->size()));
+            // As in write_drift_report_to_file: close explicitly so a close-time failure is observed here.
+            file.flush();
+            file.close();
+            if (!file)
+            {
+                return manifest_error(ErrorCode::FileWriteFailed);
+            }
+            return {};
+        }
+
+        struct MappedDriftReport::Impl
+        {
+            detail::MappedFile file;
+        };
+
+        MappedDriftReport::MappedDriftReport(std::unique_ptr<Impl> impl, DriftReportView view) noexcept
+            : m_impl(std::move(impl)), m_view(view)
+        {
+        }
+
+        MappedDriftReport::MappedDriftReport(MappedDriftReport &&) noexcept = default;
+        MappedDriftReport &MappedDriftReport::operator=(MappedDriftReport &&) noexcept = default;
+        MappedDriftReport::~MappedDriftReport() noexcept = default;
+
+        Result<MappedDriftReport> MappedDriftReport::open(const std::string &path) noexcept
+        {
+            std::unique_ptr<Impl> impl;
+            try
+            {
+                impl = std::make_unique<Impl>();
+                if (!impl->file.open(path))
+                {
+                    return manifest_error(ErrorCode::FileOpenFailed);
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                return manifest_error(ErrorCode::OutOfMemory);
+            }
+            // The view points into the mapped pages, not into Impl, so it stays valid when the report is moved.
+            const std::string_view bytes = impl->file.text();
+            Result<DriftReportView> view =
+                DriftReportView::parse(std::as_bytes(std::span<const char>(bytes.data(), bytes.size())));
+            if (!view)
+            {
+                return std::unexpected(view.error());
+            }
+            return MappedDriftReport(std::move(impl), *view);
+        }
     } // namespace rtti
 } // namespace DetourModKit
@@ -1,9 +1,161 @@
 /**
  * @file event_dispatcher.cpp
- * @brief Compilation unit for event_dispatcher.hpp.
+ * @brief Compilation unit for event_dispatcher.hpp, and the epoch reclamation every EventDispatcher shares.
  *
- * EventDispatcher is a header-only template module. This translation unit exists to ensure the header compiles cleanly
- * as part of the library build and to anchor any future non-template members.
+ * EventDispatcher is a header-only template module. This translation unit ensures the header compiles cleanly as part
+ * of the library build and holds its one non-template part: the process-wide epoch and the registry of per-thread
+ * reader records that decide when a replaced handler snapshot can be freed.
  */
 
 #include "DetourModKit/detail/event_dispatcher.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: ReaderRecord is padded to a whole cache line by alignas(64) on purpose, so one thread's announcement never
+// shares a line with another's.
+#pragma warning(disable : 4324)
+#endif
+            /**
+             * @brief One thread's announcement.
+             * @details Records are never freed: a thread hands its record back on exit and the next thread to emit
+             *          reuses it, so the registry is bounded by the peak number of emitting threads.
+             */
+            struct alignas(64) ReaderRecord
+            {
+                /// The epoch the owner announced at its outermost emit; 0 while it is not emitting.
+                std::atomic<std::uint64_t> epoch{0};
+                std::atomic<bool> claimed{true};
+                ReaderRecord *next{nullptr};
+            };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+            /// Starts at 1 so an announced epoch is never the "not emitting" 0.
+            std::atomic<std::uint64_t> s_epoch{1};
+            std::atomic<ReaderRecord *> s_records{nullptr};
+            /// Threads emitting without a record (its allocation failed); while nonzero nothing is reclaimed.
+            std::atomic<std::uint32_t> s_unrecorded_readers{0};
+
+            /// Takes a record another thread handed back, or pushes a new one; nullptr when allocation fails.
+            ReaderRecord *claim_record() noexcept
+            {
+                for (ReaderRecord *record = s_records.load(std::memory_order_acquire); record != nullptr;
+                     record = record->next)
+                {
+                    bool expected = false;
+                    if (!record->claimed.load(std::memory_order_relaxed) &&
+                        record->claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+                    {
+                        return record;
+                    }
+                }
+
+                auto *fresh = new (std::nothrow) ReaderRecord();
+                if (fresh == nullptr)
+                {
+                    return nullptr;
+                }
+                fresh->next = s_records.load(std::memory_order_relaxed);
+                while (!s_records.compare_exchange_weak(fresh->next, fresh, std::memory_order_release,
+                                                        std::memory_order_relaxed))
+                {
+                }
+                return fresh;
+            }
+
+            struct ThreadReader
+            {
+                ReaderRecord *record{nullptr};
+                /// Emits on this thread's stack, across every dispatcher and Event type.
+                std::uint32_t depth{0};
+                /// The outermost emit counted itself in s_unrecorded_readers instead of announcing in a record.
+                bool unrecorded{false};
+
+                // Only atomic stores, so it is safe at thread detach under loader lock.
+                ~ThreadReader()
+                {
+                    if (record != nullptr)
+                    {
+                        record->epoch.store(0, std::memory_order_release);
+                        record->claimed.store(false, std::memory_order_release);
+                        record = nullptr;
+                    }
+                }
+            };
+
+            thread_local ThreadReader s_reader;
+        } // namespace
+
+        void enter_emit_epoch() noexcept
+        {
+            ThreadReader &reader = s_reader;
+            if (reader.depth++ != 0)
+            {
+                return;
+            }
+            if (reader.record == nullptr)
+            {
+                reader.record = claim_record();
+            }
+            if (reader.record == nullptr)
+            {
+                reader.unrecorded = true;
+                s_unrecorded_readers.fetch_add(1, std::memory_order_seq_cst);
+                return;
+            }
+            reader.record->epoch.store(s_epoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+        }
+
+        void leave_emit_epoch() noexcept
+        {
+            ThreadReader &reader = s_reader;
+            if (--reader.depth != 0)
+            {
+                return;
+            }
+            if (reader.unrecorded)
+            {
+                reader.unrecorded = false;
+                s_unrecorded_readers.fetch_sub(1, std::memory_order_release);
+                return;
+            }
+            reader.record->epoch.store(0, std::memory_order_release);
+        }
+
+        std::uint64_t advance_emit_epoch() noexcept
+        {
+            return s_epoch.fetch_add(1, std::memory_order_seq_cst) + 1;
+        }
+
+        std::uint64_t oldest_emit_epoch() noexcept
+        {
+            if (s_unrecorded_readers.load(std::memory_order_seq_cst) != 0)
+            {
+                return 0;
+            }
+            std::uint64_t oldest = std::numeric_limits<std::uint64_t>::max();
+            for (ReaderRecord *record = s_records.load(std::memory_order_acquire); record != nullptr;
+                 record = record->next)
+            {
+                const std::uint64_t announced = record->epoch.load(std::memory_order_seq_cst);
+                if (announced != 0 && announced < oldest)
+                {
+                    oldest = announced;
+                }
+            }
+            return oldest;
+        }
+    } // namespace detail
+} // namespace DetourModKit
@@ -0,0 +1,835 @@
+/**
+ * @file fork_join.cpp
+ * @brief The persistent worker pool behind run_fork_join.
+ * @details The pool is a set of StoppableWorkers parked on one condition variable. A batch lives on its caller's
+ *          stack: the caller splits the index space into one range per participant, publishes the batch with a number
+ *          of open invitations, and runs its own range. Each worker that wakes takes one invitation and a range slot,
+ *          then everyone steals from everyone once their own range is empty. The caller closes the invitations when
+ *          it runs out of work and waits only for the helpers that joined, so an invitation nobody took costs nothing.
+ *
+ *          scan::set_worker_placement can move the workers into a background placement (below-normal priority, EcoQoS,
+ *          efficiency-class CPU sets) and cap how many a batch invites while the game owns the foreground. The calling
+ *          thread is never re-placed: it is the caller's.
+ *
+ *          The pool's state is built once in static storage and never destroyed. A worker StoppableWorker detached
+ *          under the loader lock may still be waking up when static destructors run, and it must not find the mutex it
+ *          waits on destroyed.
+ */
+
+#include "fork_join.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+#include "DetourModKit/logger.hpp"
+#include "internal/scan_telemetry.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "platform.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: each range is padded to a whole cache line by alignas(64) on purpose, so an owner taking from its front never
+// shares a line with a neighbour's.
+#pragma warning(disable : 4324)
+#endif
+            /// One participant's unclaimed indices, [begin, end) packed as begin | end << 32.
+            struct alignas(64) IndexRange
+            {
+                std::atomic<std::uint64_t> bounds{0};
+            };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+            [[nodiscard]] constexpr std::uint64_t pack_range(std::uint32_t begin, std::uint32_t end) noexcept
+            {
+                return static_cast<std::uint64_t>(begin) | (static_cast<std::uint64_t>(end) << 32);
+            }
+
+            [[nodiscard]] constexpr std::uint32_t range_begin(std::uint64_t bounds) noexcept
+            {
+                return static_cast<std::uint32_t>(bounds);
+            }
+
+            [[nodiscard]] constexpr std::uint32_t range_end(std::uint64_t bounds) noexcept
+            {
+                return static_cast<std::uint32_t>(bounds >> 32);
+            }
+
+            /**
+             * @brief One batch in flight, on its caller's stack.
+             * @details The invitation and helper counts and the list link are guarded by the pool mutex; the ranges are
+             *          lock-free.
+             */
+            struct PoolBatch
+            {
+                ForkJoinBody body{nullptr};
+                void *context{nullptr};
+                /// Range slots in use: the caller's (slot 0) plus one per invitation.
+                std::size_t participants{1};
+                /// Invitations no worker has taken yet.
+                std::size_t open_invitations{0};
+                /// Workers that took an invitation and have not finished; the caller waits for this to reach 0.
+                std::size_t active_helpers{0};
+                /// Slots handed out so far; the next helper takes this one.
+                std::size_t next_slot{1};
+                PoolBatch *next_open{nullptr};
+                /// The caller's open scan-telemetry sink, bound on each helper so its scan work counts to the caller.
+                TelemetrySink *telemetry{nullptr};
+                std::array<IndexRange, FORK_JOIN_MAX_PARTICIPANTS> ranges;
+            };
+
+            struct PoolState
+            {
+                /// Serializes starting against shutting down; never held while a batch runs.
+                std::mutex lifecycle_mutex;
+                std::vector<std::unique_ptr<StoppableWorker>> workers;
+
+                std::mutex work_mutex;
+                /// condition_variable_any so a worker's wait also wakes on its stop_token.
+                std::condition_variable_any work_cv;
+                std::condition_variable helpers_done_cv;
+                /// Batches with an open invitation, newest first.
+                PoolBatch *open_batches{nullptr};
+
+                std::atomic<std::size_t> size{0};
+                std::atomic<std::uint64_t> threads_started{0};
+            };
+
+            alignas(PoolState) unsigned char s_pool_storage[sizeof(PoolState)];
+
+            /// Constructed on first use in static storage and never destroyed; see the file comment.
+            PoolState &pool_state() noexcept
+            {
+                static PoolState *const state = ::new (static_cast<void *>(s_pool_storage)) PoolState();
+                return *state;
+            }
+
+            /// The placement set_fork_join_placement() last stored; a worker re-applies it when the generation moves.
+            std::atomic<bool> s_background_workers{false};
+            /// The foreground core fraction in thousandths.
+            std::atomic<std::uint32_t> s_foreground_permille{500};
+            std::atomic<std::uint32_t> s_placement_generation{0};
+            /// The calibrated max_workers = 0 count; 0 leaves the hardware default.
+            std::atomic<std::size_t> s_auto_workers{0};
+
+            // Mirrors of the Windows 10 thread-placement types, declared here so the build does not depend on an SDK
+            // or MinGW header recent enough to carry them; the functions are resolved at run time for the same reason
+            // and because older Windows lacks them.
+            /// THREAD_INFORMATION_CLASS::ThreadPowerThrottling.
+            constexpr int THREAD_POWER_THROTTLING_CLASS = 3;
+            constexpr ULONG POWER_THROTTLING_VERSION = 1;
+            constexpr ULONG POWER_THROTTLING_EXECUTION_SPEED = 0x1;
+
+            /// THREAD_POWER_THROTTLING_STATE.
+            struct PowerThrottlingState
+            {
+                ULONG version;
+                ULONG control_mask;
+                ULONG state_mask;
+            };
+
+            /// The fixed head of a SYSTEM_CPU_SET_INFORMATION record of type CpuSetInformation (0).
+            struct CpuSetRecord
+            {
+                DWORD size;
+                DWORD type;
+                DWORD id;
+                WORD group;
+                BYTE logical_processor_index;
+                BYTE core_index;
+                BYTE last_level_cache_index;
+                BYTE numa_node_index;
+                BYTE efficiency_class;
+            };
+
+            using SetThreadInformationFn = BOOL(WINAPI *)(HANDLE, int, LPVOID, DWORD);
+            using GetSystemCpuSetInformationFn = BOOL(WINAPI *)(void *, ULONG, PULONG, HANDLE, ULONG);
+            using SetThreadSelectedCpuSetsFn = BOOL(WINAPI *)(HANDLE, const ULONG *, ULONG);
+
+            /// Most efficiency-class CPU sets a worker is restricted to; more are truncated.
+            constexpr std::size_t MAX_EFFICIENCY_CPU_SETS = 256;
+
+            /// The placement APIs and the efficiency-class CPU sets, found once. Trivially destructible on purpose.
+            struct PlacementApis
+            {
+                SetThreadInformationFn set_thread_information{nullptr};
+                SetThreadSelectedCpuSetsFn set_selected_cpu_sets{nullptr};
+                /// CPU set ids of the lowest efficiency class; empty unless the CPU mixes classes.
+                std::array<ULONG, MAX_EFFICIENCY_CPU_SETS> efficiency_sets{};
+                std::size_t efficiency_set_count{0};
+            };
+
+            std::once_flag s_placement_once;
+            PlacementApis s_placement_apis;
+
+            /// Collects the CPU sets of the lowest efficiency class when the system has more than one class.
+            void find_efficiency_cpu_sets(PlacementApis &apis, GetSystemCpuSetInformationFn query) noexcept
+            {
+                ULONG length = 0;
+                (void)query(nullptr, 0, &length, GetCurrentProcess(), 0);
+                if (length == 0)
+                {
+                    return;
+                }
+                std::vector<unsigned char> buffer;
+                try
+                {
+                    buffer.resize(length);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return;
+                }
+                if (!query(buffer.data(), length, &length, GetCurrentProcess(), 0))
+                {
+                    return;
+                }
+
+                BYTE lowest = 0xFF;
+                BYTE highest = 0;
+                for (std::size_t offset = 0; offset + sizeof(CpuSetRecord) <= length;)
+                {
+                    CpuSetRecord record{};
+                    std::memcpy(&record, buffer.data() + offset, sizeof(record));
+                    if (record.size == 0)
+                    {
+                        break;
+                    }
+                    if (record.type == 0)
+                    {
+                        lowest = std::min(lowest, record.efficiency_class);
+                        highest = std::max(highest, record.efficiency_class);
+                    }
+                    offset += record.size;
+                }
+                if (lowest >= highest)
+                {
+                    return;
+                }
+                for (std::size_t offset = 0; offset + sizeof(CpuSetRecord) <= length;)
+                {
+                    CpuSetRecord record{};
+                    std::memcpy(&record, buffer.data() + offset, sizeof(record));
+                    if (record.size == 0 || apis.efficiency_set_count == apis.efficiency_sets.size())
+                    {
+                        break;
+                    }
+                    if (record.type == 0 && record.efficiency_class == lowest)
+                    {
+                        apis.efficiency_sets[apis.efficiency_set_count++] = record.id;
+                    }
+                    offset += record.size;
+                }
+            }
+
+            [[nodiscard]] const PlacementApis &placement_apis() noexcept
+            {
+                std::call_once(s_placement_once,
+                               []() noexcept
+                               {
+                                   const HMODULE kernel = GetModuleHandleW(L"kernel32.dll");
+                                   if (kernel == nullptr)
+                                   {
+                                       return;
+                                   }
+                                   PlacementApis &apis = s_placement_apis;
+                                   apis.set_thread_information = reinterpret_cast<SetThreadInformationFn>(
+                                       reinterpret_cast<void *>(GetProcAddress(kernel, "SetThreadInformation")));
+                                   apis.set_selected_cpu_sets = reinterpret_cast<SetThreadSelectedCpuSetsFn>(
+                                       reinterpret_cast<void *>(GetProcAddress(kernel, "SetThreadSelectedCpuSets")));
+                                   const auto query = reinterpret_cast<GetSystemCpuSetInformationFn>(
+                                       reinterpret_cast<void *>(GetProcAddress(kernel, "GetSystemCpuSetInformation")));
+                                   if (query != nullptr && apis.set_selected_cpu_sets != nullptr)
+                                   {
+                                       find_efficiency_cpu_sets(apis, query);
+                                   }
+                               });
+                return s_placement_apis;
+            }
+
+            /// Puts the calling worker in the background or the normal placement. Every step is best-effort.
+            void apply_worker_placement(bool background) noexcept
+            {
+                const HANDLE self = GetCurrentThread();
+                (void)SetThreadPriority(self, background ? THREAD_PRIORITY_BELOW_NORMAL : THREAD_PRIORITY_NORMAL);
+
+                const PlacementApis &apis = placement_apis();
+                if (apis.set_thread_information != nullptr)
+                {
+                    PowerThrottlingState throttling{POWER_THROTTLING_VERSION, POWER_THROTTLING_EXECUTION_SPEED,
+                                                    background ? POWER_THROTTLING_EXECUTION_SPEED : 0};
+                    (void)apis.set_thread_information(self, THREAD_POWER_THROTTLING_CLASS, &throttling,
+                                                      sizeof(throttling));
+                }
+                if (apis.set_selected_cpu_sets != nullptr && apis.efficiency_set_count != 0)
+                {
+                    // An empty selection hands the thread back to the process default.
+                    (void)apis.set_selected_cpu_sets(self, background ? apis.efficiency_sets.data() : nullptr,
+                                                     background ? static_cast<ULONG>(apis.efficiency_set_count) : 0);
+                }
+            }
+
+            /// True while a window of this process is the foreground window, i.e. the game is in front.
+            [[nodiscard]] bool process_owns_foreground() noexcept
+            {
+                const HWND foreground = GetForegroundWindow();
+                if (foreground == nullptr)
+                {
+                    return false;
+                }
+                DWORD owner = 0;
+                (void)GetWindowThreadProcessId(foreground, &owner);
+                return owner == GetCurrentProcessId();
+            }
+
+            /// Most helpers a background batch may invite while the game is in the foreground.
+            [[nodiscard]] std::size_t foreground_helper_cap() noexcept
+            {
+                const unsigned int hardware = std::thread::hardware_concurrency();
+                const std::size_t threads =
+                    (hardware == 0) ? FORK_JOIN_DEFAULT_WORKERS : static_cast<std::size_t>(hardware);
+                const std::size_t capped = threads * s_foreground_permille.load(std::memory_order_relaxed) / 1000;
+                return std::max<std::size_t>(capped, 1);
+            }
+
+            /// Takes the index at the front of @p range; false once it is empty.
+            [[nodiscard]] bool take_front(std::atomic<std::uint64_t> &range, std::uint32_t &index) noexcept
+            {
+                std::uint64_t bounds = range.load(std::memory_order_acquire);
+                for (;;)
+                {
+                    const std::uint32_t begin = range_begin(bounds);
+                    const std::uint32_t end = range_end(bounds);
+                    if (begin >= end)
+                    {
+                        return false;
+                    }
+                    if (range.compare_exchange_weak(bounds, pack_range(begin + 1, end), std::memory_order_acq_rel,
+                                                    std::memory_order_acquire))
+                    {
+                        index = begin;
+                        return true;
+                    }
+                }
+            }
+
+            /**
+             * @brief Moves the back half of another participant's range into @p slot's (empty) range.
+             * @details An empty range is never a thief's target, so the plain store into our own slot cannot race a
+             *          steal from it; a thief still holding an older, non-empty value fails its exchange, because a
+             *          range only ever shrinks or is refilled with indices it never held before.
+             * @return false when every other range was empty.
+             */
+            [[nodiscard]] bool steal_into(PoolBatch &batch, std::size_t slot) noexcept
+            {
+                for (std::size_t offset = 1; offset < batch.participants; ++offset)
+                {
+                    std::atomic<std::uint64_t> &victim = batch.ranges[(slot + offset) % batch.participants].bounds;
+                    std::uint64_t bounds = victim.load(std::memory_order_acquire);
+                    for (;;)
+                    {
+                        const std::uint32_t begin = range_begin(bounds);
+                        const std::uint32_t end = range_end(bounds);
+                        if (begin >= end)
+                        {
+                            break;
+                        }
+                        const std::uint32_t middle = end - (end - begin + 1) / 2;
+                        if (victim.compare_exchange_weak(bounds, pack_range(begin, middle), std::memory_order_acq_rel,
+                                                         std::memory_order_acquire))
+                        {
+                            batch.ranges[slot].bounds.store(pack_range(middle, end), std::memory_order_release);
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+
+            /// Adds without wrapping: a hint of UINT64_MAX is "as costly as it gets", not a small sum.
+            [[nodiscard]] constexpr std::uint64_t saturating_add(std::uint64_t a, std::uint64_t b) noexcept
+            {
+                return (a > std::numeric_limits<std::uint64_t>::max() - b) ? std::numeric_limits<std::uint64_t>::max()
+                                                                             : a + b;
+            }
+
+            /**
+             * @brief Seeds each participant's range.
+             * @details Without costs every slot gets an equal count. With them an index goes to the slot its cost's
+             *          midpoint falls in, measured along the running total, so each slot starts with an even share of
+             *          the work; the split stays contiguous, and a slot may start empty when one index outweighs a
+             *          share.
+             */
+            void seed_ranges(PoolBatch &batch, std::size_t count, std::span<const std::uint64_t> costs) noexcept
+            {
+                const std::size_t participants = batch.participants;
+                double total = 0.0;
+                if (costs.size() == count)
+                {
+                    for (const std::uint64_t cost : costs)
+                    {
+                        total += static_cast<double>(cost);
+                    }
+                }
+                if (total <= 0.0)
+                {
+                    for (std::size_t slot = 0; slot < participants; ++slot)
+                    {
+                        const auto begin = static_cast<std::uint32_t>(count * slot / participants);
+                        const auto end = static_cast<std::uint32_t>(count * (slot + 1) / participants);
+                        batch.ranges[slot].bounds.store(pack_range(begin, end), std::memory_order_relaxed);
+                    }
+                    return;
+                }
+
+                std::size_t index = 0;
+                double running = 0.0;
+                for (std::size_t slot = 0; slot < participants; ++slot)
+                {
+                    const std::size_t begin = index;
+                    const double share_end = total * static_cast<double>(slot + 1) / static_cast<double>(participants);
+                    while (index < count &&
+                           (slot + 1 == participants || running + static_cast<double>(costs[index]) / 2.0 < share_end))
+                    {
+                        running += static_cast<double>(costs[index]);
+                        ++index;
+                    }
+                    batch.ranges[slot].bounds.store(
+                        pack_range(static_cast<std::uint32_t>(begin), static_cast<std::uint32_t>(index)),
+                        std::memory_order_relaxed);
+                }
+            }
+
+            /// Runs @p slot's range, then steals until the whole batch is claimed.
+            void participate(PoolBatch &batch, std::size_t slot) noexcept
+            {
+                // Restored on exit because the calling thread also runs this and may itself be inside a batch.
+                bool &inside = in_fork_join_worker();
+                const bool was_inside = inside;
+                inside = true;
+                const TelemetryBinding telemetry(batch.telemetry);
+                std::atomic<std::uint64_t> &own = batch.ranges[slot].bounds;
+                for (;;)
+                {
+                    std::uint32_t index = 0;
+                    if (take_front(own, index))
+                    {
+                        batch.body(batch.context, index);
+                    }
+                    else if (!steal_into(batch, slot))
+                    {
+                        break;
+                    }
+                }
+                inside = was_inside;
+            }
+
+            /// Unlinks @p batch from the open list if it is still there. Caller holds the work mutex.
+            void close_invitations(PoolState &state, PoolBatch &batch) noexcept
+            {
+                batch.open_invitations = 0;
+                for (PoolBatch **link = &state.open_batches; *link != nullptr; link = &(*link)->next_open)
+                {
+                    if (*link == &batch)
+                    {
+                        *link = batch.next_open;
+                        break;
+                    }
+                }
+                batch.next_open = nullptr;
+            }
+
+            void worker_loop(const std::stop_token &stop)
+            {
+                PoolState &state = pool_state();
+                std::uint32_t applied_placement = 0;
+                std::unique_lock<std::mutex> lock(state.work_mutex);
+                for (;;)
+                {
+                    if (!state.work_cv.wait(lock, stop, [&state]() { return state.open_batches != nullptr; }) ||
+                        stop.stop_requested())
+                    {
+                        return;
+                    }
+
+                    PoolBatch &batch = *state.open_batches;
+                    const std::size_t slot = batch.next_slot++;
+                    ++batch.active_helpers;
+                    if (--batch.open_invitations == 0)
+                    {
+                        close_invitations(state, batch);
+                    }
+                    lock.unlock();
+                    const std::uint32_t placement = s_placement_generation.load(std::memory_order_acquire);
+                    if (placement != applied_placement)
+                    {
+                        apply_worker_placement(s_background_workers.load(std::memory_order_acquire));
+                        applied_placement = placement;
+                    }
+                    participate(batch, slot);
+                    lock.lock();
+                    if (--batch.active_helpers == 0)
+                    {
+                        state.helpers_done_cv.notify_all();
+                    }
+                }
+            }
+
+            /// Workers the pool starts: one per hardware thread beside the caller's.
+            [[nodiscard]] std::size_t pool_capacity() noexcept
+            {
+                const unsigned int hardware = std::thread::hardware_concurrency();
+                const std::size_t threads =
+                    (hardware == 0) ? FORK_JOIN_DEFAULT_WORKERS : static_cast<std::size_t>(hardware);
+                return std::clamp<std::size_t>(threads - 1, 1, FORK_JOIN_MAX_PARTICIPANTS - 1);
+            }
+
+            /// Starts the pool unless it is running; returns its size, which is 0 when no worker could be started.
+            std::size_t ensure_pool_started(PoolState &state) noexcept
+            {
+                std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+                if (!state.workers.empty())
+                {
+                    return state.workers.size();
+                }
+
+                const std::size_t capacity = pool_capacity();
+                mark_subsystem_used(Subsystem::ForkJoinPool);
+                try
+                {
+                    state.workers.reserve(capacity);
+                    for (std::size_t i = 0; i < capacity; ++i)
+                    {
+                        state.workers.push_back(std::make_unique<StoppableWorker>("ForkJoinPool", worker_loop));
+                        state.threads_started.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                catch (const std::exception &e)
+                {
+                    // A resource limit after zero or more workers: keep the ones that started. Batches invite at most
+                    // the pool's size, and the callers run whatever no worker takes.
+                    (void)log().try_log(LogLevel::Warning, "ForkJoinPool: started {} of {} workers: {}",
+                                        state.workers.size(), capacity, e.what());
+                }
+                state.size.store(state.workers.size(), std::memory_order_release);
+                return state.workers.size();
+            }
+
+            /// One graph run: the child lists, and the ready stack its participants share.
+            struct GraphRun
+            {
+                ForkJoinBody body{nullptr};
+                void *context{nullptr};
+                /// Node n's children are children[child_begin[n] .. child_begin[n + 1]).
+                std::vector<std::size_t> child_begin;
+                std::vector<std::size_t> children;
+
+                std::mutex mutex;
+                std::condition_variable ready_cv;
+                /// Reserved for every node up front, so pushing a child never allocates.
+                std::vector<std::size_t> ready;
+                /// Reachable nodes whose body has not returned yet.
+                std::size_t remaining{0};
+            };
+
+            /// Runs ready nodes until every reachable one has finished.
+            void run_graph_nodes(GraphRun &run) noexcept
+            {
+                std::unique_lock<std::mutex> lock(run.mutex);
+                for (;;)
+                {
+                    run.ready_cv.wait(lock, [&run]() { return !run.ready.empty() || run.remaining == 0; });
+                    if (run.remaining == 0)
+                    {
+                        return;
+                    }
+                    const std::size_t node = run.ready.back();
+                    run.ready.pop_back();
+                    lock.unlock();
+                    run.body(run.context, node);
+                    lock.lock();
+
+                    // Pushed in reverse so siblings come off the stack in input order.
+                    const std::size_t first = run.child_begin[node];
+                    const std::size_t last = run.child_begin[node + 1];
+                    for (std::size_t k = last; k > first; --k)
+                    {
+                        run.ready.push_back(run.children[k - 1]);
+                    }
+                    if (--run.remaining == 0 || last - first > 1)
+                    {
+                        run.ready_cv.notify_all();
+                    }
+                    else if (last != first)
+                    {
+                        run.ready_cv.notify_one();
+                    }
+                }
+            }
+        } // namespace
+
+        void fork_join_graph_dispatch(std::span<const std::size_t> parents, std::size_t helpers, ForkJoinBody body,
+                                      void *context)
+        {
+            const std::size_t count = parents.size();
+            GraphRun run;
+            run.body = body;
+            run.context = context;
+            run.child_begin.assign(count + 1, 0);
+            for (std::size_t node = 0; node < count; ++node)
+            {
+                const std::size_t parent = parents[node];
+                if (parent < count && parent != node)
+                {
+                    ++run.child_begin[parent + 1];
+                }
+            }
+            for (std::size_t node = 0; node < count; ++node)
+            {
+                run.child_begin[node + 1] += run.child_begin[node];
+            }
+            run.children.resize(run.child_begin[count]);
+            std::vector<std::size_t> fill(run.child_begin.begin(), run.child_begin.end() - 1);
+            for (std::size_t node = 0; node < count; ++node)
+            {
+                const std::size_t parent = parents[node];
+                if (parent < count && parent != node)
+                {
+                    run.children[fill[parent]++] = node;
+                }
+            }
+
+            // Only nodes reachable from a root will ever be pushed; counting them up front is what lets the
+            // participants stop instead of waiting on a cycle forever.
+            run.ready.reserve(count);
+            for (std::size_t node = count; node > 0; --node)
+            {
+                if (parents[node - 1] == FORK_JOIN_NO_PARENT)
+                {
+                    run.ready.push_back(node - 1);
+                }
+            }
+            std::vector<std::size_t> &reach = fill;
+            reach.assign(run.ready.begin(), run.ready.end());
+            for (std::size_t k = 0; k < reach.size(); ++k)
+            {
+                for (std::size_t c = run.child_begin[reach[k]]; c < run.child_begin[reach[k] + 1]; ++c)
+                {
+                    reach.push_back(run.children[c]);
+                }
+            }
+            run.remaining = reach.size();
+            if (run.remaining == 0)
+            {
+                return;
+            }
+
+            if (helpers == 0)
+            {
+                run_graph_nodes(run);
+                return;
+            }
+            // One dispatch index per participant, each running the node loop; a participant whose helper never joined
+            // is stolen only once the graph is done, and then returns at once.
+            const ForkJoinBody participant = [](void *raw, std::size_t) noexcept
+            { run_graph_nodes(*static_cast<GraphRun *>(raw)); };
+            fork_join_dispatch(std::min(helpers + 1, run.remaining), helpers, participant, &run);
+        }
+
+        ForkJoinPlan plan_fork_join(std::span<const std::uint64_t> item_costs, std::size_t workers)
+        {
+            ForkJoinPlan plan;
+            plan.order.resize(item_costs.size());
+            for (std::size_t i = 0; i < plan.order.size(); ++i)
+            {
+                plan.order[i] = i;
+            }
+            std::stable_sort(plan.order.begin(), plan.order.end(),
+                             [item_costs](std::size_t a, std::size_t b) { return item_costs[a] > item_costs[b]; });
+
+            std::uint64_t total = 0;
+            for (const std::uint64_t cost : item_costs)
+            {
+                total = saturating_add(total, cost);
+            }
+            const std::uint64_t tasks_wanted = std::max<std::uint64_t>(workers, 1) * FORK_JOIN_TASKS_PER_WORKER;
+            const std::uint64_t task_target = std::max<std::uint64_t>(total / tasks_wanted, 1);
+
+            plan.task_begin.reserve(plan.order.size() + 1);
+            plan.task_cost.reserve(plan.order.size());
+            std::uint64_t open_cost = 0;
+            bool open = false;
+            for (std::size_t k = 0; k < plan.order.size(); ++k)
+            {
+                if (!open)
+                {
+                    plan.task_begin.push_back(k);
+                    open_cost = 0;
+                    open = true;
+                }
+                open_cost = saturating_add(open_cost, item_costs[plan.order[k]]);
+                if (open_cost >= task_target)
+                {
+                    plan.task_cost.push_back(open_cost);
+                    open = false;
+                }
+            }
+            if (open)
+            {
+                plan.task_cost.push_back(open_cost);
+            }
+            plan.task_begin.push_back(plan.order.size());
+            return plan;
+        }
+
+        void fork_join_dispatch(std::size_t count, std::size_t helpers, ForkJoinBody body, void *context,
+                                std::span<const std::uint64_t> costs) noexcept
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            PoolState &state = pool_state();
+            std::size_t pool_size = 0;
+            if (helpers != 0 && count <= std::numeric_limits<std::uint32_t>::max() && !is_loader_lock_held())
+            {
+                pool_size = state.size.load(std::memory_order_acquire);
+                if (pool_size == 0)
+                {
+                    pool_size = ensure_pool_started(state);
+                }
+            }
+            if (pool_size != 0 && s_background_workers.load(std::memory_order_acquire) && process_owns_foreground())
+            {
+                helpers = std::min(helpers, foreground_helper_cap());
+            }
+            const std::size_t invitations = std::min({helpers, pool_size, count - 1});
+            if (invitations == 0)
+            {
+                bool &inside = in_fork_join_worker();
+                const bool was_inside = inside;
+                inside = true;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    body(context, i);
+                }
+                inside = was_inside;
+                return;
+            }
+
+            PoolBatch batch;
+            batch.body = body;
+            batch.context = context;
+            batch.telemetry = current_telemetry_sink();
+            batch.participants = invitations + 1;
+            batch.open_invitations = invitations;
+            seed_ranges(batch, count, costs);
+
+            {
+                std::lock_guard<std::mutex> lock(state.work_mutex);
+                batch.next_open = state.open_batches;
+                state.open_batches = &batch;
+            }
+            if (invitations == 1)
+            {
+                state.work_cv.notify_one();
+            }
+            else
+            {
+                state.work_cv.notify_all();
+            }
+
+            participate(batch, 0);
+
+            // Nothing is left to claim, so a helper joining now would find no work: close the batch to newcomers and
+            // wait for the ones already inside, whose claimed items may still be running.
+            std::unique_lock<std::mutex> lock(state.work_mutex);
+            close_invitations(state, batch);
+            state.helpers_done_cv.wait(lock, [&batch]() { return batch.active_helpers == 0; });
+        }
+
+        void shutdown_fork_join_pool() noexcept
+        {
+            PoolState &state = pool_state();
+            std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+            std::vector<std::unique_ptr<StoppableWorker>> workers = std::move(state.workers);
+            state.workers.clear();
+            state.size.store(0, std::memory_order_release);
+            for (const std::unique_ptr<StoppableWorker> &worker : workers)
+            {
+                worker->request_stop();
+            }
+            for (const std::unique_ptr<StoppableWorker> &worker : workers)
+            {
+                worker->shutdown();
+            }
+        }
+
+        void set_fork_join_placement(bool background, double foreground_core_fraction) noexcept
+        {
+            if (foreground_core_fraction == foreground_core_fraction)
+            {
+                const double clamped = std::clamp(foreground_core_fraction, 0.0, 1.0);
+                s_foreground_permille.store(static_cast<std::uint32_t>(clamped * 1000.0 + 0.5),
+                                            std::memory_order_relaxed);
+            }
+            if (s_background_workers.exchange(background, std::memory_order_acq_rel) != background)
+            {
+                s_placement_generation.fetch_add(1, std::memory_order_acq_rel);
+            }
+        }
+
+        void set_fork_join_auto_workers(std::size_t workers) noexcept
+        {
+            s_auto_workers.store(std::min(workers, FORK_JOIN_MAX_PARTICIPANTS), std::memory_order_relaxed);
+        }
+
+        std::size_t fork_join_auto_workers() noexcept
+        {
+            return s_auto_workers.load(std::memory_order_relaxed);
+        }
+
+        bool fork_join_background() noexcept
+        {
+            return s_background_workers.load(std::memory_order_acquire);
+        }
+
+        double fork_join_foreground_core_fraction() noexcept
+        {
+            return static_cast<double>(s_foreground_permille.load(std::memory_order_relaxed)) / 1000.0;
+        }
+
+        std::size_t fork_join_pool_size() noexcept
+        {
+            return pool_state().size.load(std::memory_order_acquire);
+        }
+
+        std::uint64_t fork_join_pool_threads_started() noexcept
+        {
+            return pool_state().threads_started.load(std::memory_order_relaxed);
+        }
+    } // namespace detail
+} // namespace DetourModKit
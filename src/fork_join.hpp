@@ -11,14 +11,25 @@
  *          to a caller-supplied resolve_one callable that invokes the existing serial primitive, and the results are
  *          gathered in input order. Centralizing the threading means the immutable-input sharing contract, the
  *          fail-closed result handling, and the join-before-read ordering are written and reviewed in one place.
+ *
+ *          The threads come from one process-wide pool (fork_join.cpp), started on the first batch that wants more
+ *          than one worker and kept until @ref DetourModKit::detail::shutdown_fork_join_pool, so a batch pays a wakeup
+ *          rather than a thread creation per worker.
+ *
+ *          A batch is cancelled through a @ref DetourModKit::detail::BatchCancel installed on the calling thread. The
+ *          drivers carry it to every item wherever it runs, skip the items not yet started once it fires, and the
+ *          page walk polls it between regions, so a cancelled batch winds down within one region scan per worker.
  */
 
 #include <algorithm>
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <span>
+#include <stop_token>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace DetourModKit
@@ -28,11 +39,29 @@ namespace DetourModKit
         /// Worker count when the host cannot report hardware_concurrency(); still clamped to the item count below.
         constexpr std::size_t FORK_JOIN_DEFAULT_WORKERS = 4;
 
+        /// Most threads one batch runs on, the caller included; the pool never grows past one less than this.
+        constexpr std::size_t FORK_JOIN_MAX_PARTICIPANTS = 64;
+
+        /// One batch item's work, type-erased: resolves item @p index of the batch @p context describes.
+        using ForkJoinBody = void (*)(void *context, std::size_t index) noexcept;
+
+        /**
+         * @brief Sets the worker count a batch with max_workers = 0 selects; the backing store of
+         *        scan::apply_simd_calibration.
+         * @details 0 restores the default, std::thread::hardware_concurrency(). Clamped to
+         *          @ref FORK_JOIN_MAX_PARTICIPANTS. A batch already running keeps the count it resolved.
+         */
+        void set_fork_join_auto_workers(std::size_t workers) noexcept;
+
+        /// The count set_fork_join_auto_workers() last stored; 0 while the hardware default applies.
+        [[nodiscard]] std::size_t fork_join_auto_workers() noexcept;
+
         /**
          * @brief Resolves the effective worker count for a batch.
-         * @details A @p max_workers of 0 selects std::thread::hardware_concurrency() (or @ref FORK_JOIN_DEFAULT_WORKERS
-         *          when the host cannot report it), then clamps the result to @p item_count so a batch never spawns
-         *          more workers than it has work. Returns 0 for an empty batch.
+         * @details A @p max_workers of 0 selects the calibrated @ref fork_join_auto_workers count when one is set, else
+         *          std::thread::hardware_concurrency() (or @ref FORK_JOIN_DEFAULT_WORKERS when the host cannot report
+         *          it), then clamps the result to @p item_count so a batch never spawns more workers than it has work.
+         *          Returns 0 for an empty batch.
          * @param item_count Number of items in the batch.
          * @param max_workers Caller's upper bound on workers, or 0 to auto-select.
          * @return 0 for an empty batch, otherwise a worker count in [1, item_count].
@@ -47,6 +76,10 @@ namespace DetourModKit
 
             std::size_t count = max_workers;
             if (count == 0)
+            {
+                count = fork_join_auto_workers();
+            }
+            if (count == 0)
             {
                 const unsigned int hardware = std::thread::hardware_concurrency();
                 count = (hardware == 0) ? FORK_JOIN_DEFAULT_WORKERS : static_cast<std::size_t>(hardware);
@@ -55,15 +88,233 @@ namespace DetourModKit
         }
 
         /**
-         * @brief Resolves a batch of items concurrently, gathering one result per item in input order.
-         * @details Allocates the result vector up front and seeds every slot with @p fail_one, so the batch stays
-         *          fail-closed even if a slot were never reached. Work is then distributed through an atomic cursor:
-         *          each index is claimed by exactly one worker via a fetch_add, so every result slot is written once
-         *          (no result race) and the scan path performs no allocation. The calling thread participates as one
-         *          worker, so at most @ref fork_join_worker_count() threads run at once; the std::jthread workers
-         *          RAII-join before the result vector is returned, and that join is the happens-before that lets the
-         *          caller observe every worker's write. A single-share batch (empty, or one worker) runs serially on
-         *          the calling thread with no thread creation.
+         * @brief Per-thread flag set while the calling thread runs a resolve_one of a multi-worker fork-join batch.
+         * @details A primitive that could itself fan out (the split module scan) reads it to stay serial inside an
+         *          already-parallel batch instead of multiplying the thread count. Touched only by setup-time batch
+         *          code, so the thread_local's first-touch cost on MinGW (emutls) never reaches a hook or loader-lock
+         *          path.
+         */
+        [[nodiscard]] inline bool &in_fork_join_worker() noexcept
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        /**
+         * @brief The cancellation state of one batch: the caller's std::stop_token, a fail-fast trip of its own, and
+         *        the batch it runs inside, if any.
+         * @details Constructed on the thread issuing the batch, it links to whichever BatchCancel that thread already
+         *          has installed, so a batch nested in another's item is cancelled with its outer one. Polling is two
+         *          relaxed loads per link; the flag is advisory, and an item that misses a trip just runs to its end.
+         */
+        class BatchCancel
+        {
+        public:
+            explicit BatchCancel(std::stop_token stop = {}) noexcept;
+
+            BatchCancel(const BatchCancel &) = delete;
+            BatchCancel &operator=(const BatchCancel &) = delete;
+
+            /// True once the stop token fired, cancel() ran, or the enclosing batch was cancelled.
+            [[nodiscard]] bool cancelled() const noexcept
+            {
+                for (const BatchCancel *link = this; link != nullptr; link = link->m_outer)
+                {
+                    if (link->m_tripped.load(std::memory_order_relaxed) || link->m_stop.stop_requested())
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            /// Cancels the batch from inside: the fail-fast trip an item pulls when its failure sinks every sibling.
+            void cancel() noexcept { m_tripped.store(true, std::memory_order_relaxed); }
+
+        private:
+            std::stop_token m_stop;
+            std::atomic<bool> m_tripped{false};
+            const BatchCancel *m_outer;
+        };
+
+        /// The BatchCancel installed on the calling thread, or nullptr outside any cancellable batch.
+        [[nodiscard]] inline const BatchCancel *&active_batch_cancel() noexcept
+        {
+            thread_local const BatchCancel *active = nullptr;
+            return active;
+        }
+
+        inline BatchCancel::BatchCancel(std::stop_token stop) noexcept
+            : m_stop(std::move(stop)), m_outer(active_batch_cancel())
+        {
+        }
+
+        /// Whether the batch the calling thread is working for has been cancelled; polled by the page walk.
+        [[nodiscard]] inline bool batch_cancelled() noexcept
+        {
+            const BatchCancel *cancel = active_batch_cancel();
+            return cancel != nullptr && cancel->cancelled();
+        }
+
+        /// Installs a BatchCancel on the calling thread for its lifetime; a null one leaves the installed one in place.
+        class ScopedBatchCancel
+        {
+        public:
+            explicit ScopedBatchCancel(const BatchCancel *cancel) noexcept : m_previous(active_batch_cancel())
+            {
+                if (cancel != nullptr)
+                {
+                    active_batch_cancel() = cancel;
+                }
+            }
+            ~ScopedBatchCancel() noexcept { active_batch_cancel() = m_previous; }
+
+            ScopedBatchCancel(const ScopedBatchCancel &) = delete;
+            ScopedBatchCancel &operator=(const ScopedBatchCancel &) = delete;
+
+        private:
+            const BatchCancel *m_previous;
+        };
+
+        /**
+         * @brief Runs @p body for every index in [0, @p count) on the calling thread and up to @p helpers pool workers.
+         * @details The indices are split into one contiguous range per participant. Each participant takes
+         *          indices from the front of its own range and, once that is empty, steals the back half of another's,
+         *          so a slow item never holds up the ones queued behind it. Pool workers are invited, not waited for:
+         *          a worker busy in another batch (or a pool that could not be started) leaves its range to be stolen,
+         *          and the caller blocks only on the helpers that actually joined. That is what makes a batch issued
+         *          from inside another batch's item safe. Returns once every index has run; the mutex the return waits
+         *          on is the happens-before that lets the caller read what the helpers wrote.
+         *
+         *          Starts the pool on first use. Under the Windows loader lock, where the new threads could not start,
+         *          and for a batch of more than UINT32_MAX items, the caller runs every index itself.
+         * @param costs Optional relative cost of each index. When it has @p count entries the initial ranges split
+         *              the summed cost evenly instead of the index count.
+         */
+        void fork_join_dispatch(std::size_t count, std::size_t helpers, ForkJoinBody body, void *context,
+                                std::span<const std::uint64_t> costs = {}) noexcept;
+
+        /**
+         * @brief Stops and joins the pool's workers; the next multi-worker batch starts a fresh pool.
+         * @details Called by Session teardown before the logger goes. Each worker finishes the batch share it is
+         *          running and then exits. Under the loader lock StoppableWorker detaches instead of joining, and the
+         *          pool's state is never freed, so a detached worker never touches destroyed statics.
+         */
+        void shutdown_fork_join_pool() noexcept;
+
+        /// Workers currently in the pool; 0 before the first parallel batch and after a shutdown.
+        [[nodiscard]] std::size_t fork_join_pool_size() noexcept;
+
+        /// Pool threads created over the process lifetime, for tests that check batches reuse them.
+        [[nodiscard]] std::uint64_t fork_join_pool_threads_started() noexcept;
+
+        /**
+         * @brief Sets how the pool's workers run; the backing store of scan::set_worker_placement.
+         * @details With @p background set, each worker drops to THREAD_PRIORITY_BELOW_NORMAL, opts into EcoQoS
+         *          (execution-speed power throttling), and on a hybrid CPU restricts itself to the CPU sets of the
+         *          lowest efficiency class. A worker applies a change the next time it joins a batch. While the
+         *          process owns the foreground window a dispatch then invites at most
+         *          max(1, @p foreground_core_fraction x logical processors) workers. @p foreground_core_fraction is
+         *          clamped to [0, 1]; NaN keeps the current value.
+         */
+        void set_fork_join_placement(bool background, double foreground_core_fraction) noexcept;
+
+        /// Whether workers run in the background placement.
+        [[nodiscard]] bool fork_join_background() noexcept;
+
+        /// The foreground core fraction set_fork_join_placement() last stored.
+        [[nodiscard]] double fork_join_foreground_core_fraction() noexcept;
+
+        /**
+         * @brief The order a cost-aware batch runs its items in, and how they are grouped into tasks.
+         * @details Items run costliest first (longest processing time first), so the big ones start at once instead of
+         *          whichever worker is unlucky picking one up last. Items too cheap to be worth an index claim of their
+         *          own are grouped with their neighbours in this order until the group is worth one.
+         */
+        struct ForkJoinPlan
+        {
+            /// Item indices, costliest first; ties keep their input order.
+            std::vector<std::size_t> order;
+            /// Task t runs order[task_begin[t]] .. order[task_begin[t + 1] - 1]; one entry more than there are tasks.
+            std::vector<std::size_t> task_begin;
+            /// Each task's summed cost, in task order.
+            std::vector<std::uint64_t> task_cost;
+        };
+
+        /// Tasks a cost-aware batch aims for per worker: enough for stealing to even out a poor cost estimate.
+        constexpr std::size_t FORK_JOIN_TASKS_PER_WORKER = 8;
+
+        /**
+         * @brief Orders and groups a batch by @p item_costs for @p workers participants.
+         * @details An item costing at least 1 / (@p workers * @ref FORK_JOIN_TASKS_PER_WORKER) of the batch is a task
+         *          of its own; cheaper ones are grouped until their group reaches that share.
+         * @throws std::bad_alloc if the plan cannot be allocated.
+         */
+        [[nodiscard]] ForkJoinPlan plan_fork_join(std::span<const std::uint64_t> item_costs, std::size_t workers);
+
+        /// Marks a graph node that depends on no other; see @ref run_fork_join_graph.
+        constexpr std::size_t FORK_JOIN_NO_PARENT = static_cast<std::size_t>(-1);
+
+        /**
+         * @brief Runs @p body for every node of a forest on the calling thread and up to @p helpers pool workers, each
+         *        node only after its parent's body returned.
+         * @details @p parents holds each node's parent index, or @ref FORK_JOIN_NO_PARENT. Roots are ready at once;
+         *          the moment a node's body returns its children become ready, so independent chains run side by side
+         *          and a child never waits for anything but its own parent. A node whose parent index is out of range,
+         *          or that sits on a cycle, is never reachable and never runs. Ready nodes are taken from one shared
+         *          mutex-guarded stack: a graph node is a whole resolve, so that lock is not where the time goes. With
+         *          no helpers the caller runs every reachable node itself, parents first, without marking itself as a
+         *          fork-join worker.
+         * @throws std::bad_alloc if the child lists cannot be built; no body has run then.
+         */
+        void fork_join_graph_dispatch(std::span<const std::size_t> parents, std::size_t helpers, ForkJoinBody body,
+                                      void *context);
+
+        /**
+         * @brief Resolves @p items[@p index] into @p results[@p index] under @p cancel; a throw puts back the fail_one
+         *        value.
+         * @details An item reached after @p cancel fired is not resolved: fail_one runs again instead, on the thread
+         *          that skipped it, so a fail_one that tests @ref batch_cancelled tells a skipped item from its seed.
+         */
+        template <typename Item, typename Result, typename ResolveOne, typename FailOne>
+        void resolve_fork_join_item(std::span<const Item> items, std::span<Result> results, ResolveOne &resolve_one,
+                                    FailOne &fail_one, std::size_t index, const BatchCancel *cancel) noexcept
+        {
+            const ScopedBatchCancel install(cancel);
+            if (cancel != nullptr && cancel->cancelled())
+            {
+                results[index] = fail_one(items[index]);
+                return;
+            }
+            try
+            {
+                results[index] = resolve_one(items[index]);
+            }
+            catch (...)
+            {
+                results[index] = fail_one(items[index]);
+            }
+        }
+
+        /**
+         * @brief Resolves a batch of items concurrently into the caller's @p results, one slot per item in input order.
+         * @details Seeds every slot with @p fail_one up front, so the batch stays fail-closed even if a slot were never
+         *          reached. The items are then handed to
+         *          @ref fork_join_dispatch: each index is claimed by exactly one participant, so every result slot is
+         *          written once (no result race) and the scan path performs no allocation. The calling thread
+         *          participates, so at most @ref fork_join_worker_count() threads (and at most the pool's size plus
+         *          one) run at once. A single-share batch (empty, or one worker) runs serially on the calling thread
+         *          without touching the pool.
+         *
+         *          With a @p cost_of, the batch is planned by @ref plan_fork_join first: items start costliest first,
+         *          cheap ones are claimed in groups, and each participant's initial range holds an equal share of the
+         *          summed cost rather than of the item count. The hint only orders the work; results stay in input
+         *          order and a wrong estimate costs balance, never correctness.
+         *
+         *          The @ref BatchCancel installed on the calling thread, if any, is installed around every item on
+         *          whichever thread runs it; once it fires, the items not yet started are skipped with their
+         *          @p fail_one value (see @ref resolve_fork_join_item) and the batch returns as soon as the running
+         *          ones end.
          * @tparam Item The batch element type (a plain-data request).
          * @tparam Result The per-item result type. Must be nothrow-move-assignable: a worker assigns into a result slot
          *                 from inside a noexcept body, so a throwing move would terminate the host.
@@ -73,84 +324,176 @@ namespace DetourModKit
          *                    share no mutable state (the serial primitives it wraps already satisfy this).
          * @tparam FailOne Callable (const Item&) -> Result giving the fail-closed result for an item. Must be noexcept:
          *                 it runs in the noexcept worker body, both as the up-front seed and on the catch path.
-         * @param items The batch to resolve. An empty span returns an empty vector.
+         * @tparam CostOf Callable (const Item&) noexcept -> std::uint64_t estimating an item's relative cost (any unit,
+         *                used only for comparison), or std::nullptr_t for no estimate.
+         * @param items The batch to resolve.
+         * @param results One slot per item, written in place; the caller guarantees results.size() == items.size().
          * @param max_workers Upper bound on worker threads (0 = auto; see @ref fork_join_worker_count).
          * @param resolve_one Per-item resolver.
          * @param fail_one Per-item fail-closed result factory.
-         * @return One @p Result per input item, in input order.
+         * @param cost_of Per-item cost hint, called once per item on the calling thread before any item runs.
+         * @throws std::bad_alloc if, with a @p cost_of, the plan cannot be allocated; without one nothing is
+         *         allocated, and every slot holds its @p fail_one seed at the throw.
          */
-        template <typename Item, typename Result, typename ResolveOne, typename FailOne>
-        [[nodiscard]] std::vector<Result> run_fork_join(std::span<const Item> items, std::size_t max_workers,
-                                                        ResolveOne resolve_one, FailOne fail_one)
+        template <typename Item, typename Result, typename ResolveOne, typename FailOne,
+                  typename CostOf = std::nullptr_t>
+        void run_fork_join_into(std::span<const Item> items, std::span<Result> results, std::size_t max_workers,
+                                ResolveOne resolve_one, FailOne fail_one, CostOf cost_of = nullptr)
         {
             static_assert(std::is_nothrow_move_assignable_v<Result>,
                           "Result is assigned into a slot inside a noexcept worker body and must not throw on move.");
             static_assert(std::is_nothrow_invocable_r_v<Result, FailOne, const Item &>,
                           "fail_one runs in the noexcept worker body; it must be noexcept and return Result.");
+            constexpr bool costed = !std::is_same_v<CostOf, std::nullptr_t>;
+            if constexpr (costed)
+            {
+                static_assert(std::is_nothrow_invocable_r_v<std::uint64_t, CostOf, const Item &>,
+                              "cost_of must be noexcept and return a std::uint64_t cost.");
+            }
 
-            std::vector<Result> results(items.size());
             for (std::size_t i = 0; i < items.size(); ++i)
             {
                 results[i] = fail_one(items[i]);
             }
 
+            const BatchCancel *cancel = active_batch_cancel();
             const std::size_t worker_count = fork_join_worker_count(items.size(), max_workers);
             if (worker_count <= 1)
             {
                 for (std::size_t i = 0; i < items.size(); ++i)
                 {
-                    try
-                    {
-                        results[i] = resolve_one(items[i]);
-                    }
-                    catch (...)
-                    {
-                        results[i] = fail_one(items[i]);
-                    }
+                    resolve_fork_join_item(items, results, resolve_one, fail_one, i, cancel);
                 }
-                return results;
+                return;
             }
 
-            std::atomic<std::size_t> cursor{0};
-            auto run = [&]() noexcept
+            struct Batch
             {
-                for (;;)
+                std::span<const Item> items;
+                std::span<Result> results;
+                ResolveOne &resolve_one;
+                FailOne &fail_one;
+                const ForkJoinPlan *plan;
+                const BatchCancel *cancel;
+            };
+            if constexpr (costed)
+            {
+                std::vector<std::uint64_t> costs(items.size());
+                for (std::size_t i = 0; i < items.size(); ++i)
                 {
-                    const std::size_t index = cursor.fetch_add(1, std::memory_order_relaxed);
-                    if (index >= items.size())
+                    costs[i] = cost_of(items[i]);
+                }
+                const ForkJoinPlan plan = plan_fork_join(costs, worker_count);
+                Batch batch{items, results, resolve_one, fail_one, &plan, cancel};
+                const ForkJoinBody body = [](void *context, std::size_t task) noexcept
+                {
+                    Batch &state = *static_cast<Batch *>(context);
+                    for (std::size_t k = state.plan->task_begin[task]; k < state.plan->task_begin[task + 1]; ++k)
                     {
-                        break;
+                        resolve_fork_join_item(state.items, state.results, state.resolve_one, state.fail_one,
+                                               state.plan->order[k], state.cancel);
                     }
+                };
+                fork_join_dispatch(plan.task_cost.size(), worker_count - 1, body, &batch, plan.task_cost);
+            }
+            else
+            {
+                (void)cost_of;
+                Batch batch{items, results, resolve_one, fail_one, nullptr, cancel};
+                const ForkJoinBody body = [](void *context, std::size_t index) noexcept
+                {
+                    Batch &state = *static_cast<Batch *>(context);
+                    resolve_fork_join_item(state.items, state.results, state.resolve_one, state.fail_one, index,
+                                           state.cancel);
+                };
+                fork_join_dispatch(items.size(), worker_count - 1, body, &batch);
+            }
+        }
 
-                    try
-                    {
-                        results[index] = resolve_one(items[index]);
-                    }
-                    catch (...)
-                    {
-                        results[index] = fail_one(items[index]);
-                    }
-                }
-            };
+        /**
+         * @brief Resolves a batch of items concurrently, gathering one result per item in input order.
+         * @details Allocates the result vector and hands it to @ref run_fork_join_into, whose contract this shares.
+         * @return One @p Result per input item, in input order; empty for an empty batch.
+         * @throws std::bad_alloc if the result vector (or, with a @p cost_of, the plan) cannot be allocated.
+         */
+        template <typename Item, typename Result, typename ResolveOne, typename FailOne,
+                  typename CostOf = std::nullptr_t>
+        [[nodiscard]] std::vector<Result> run_fork_join(std::span<const Item> items, std::size_t max_workers,
+                                                        ResolveOne resolve_one, FailOne fail_one,
+                                                        CostOf cost_of = nullptr)
+        {
+            std::vector<Result> results(items.size());
+            run_fork_join_into<Item, Result>(items, std::span<Result>(results), max_workers, std::move(resolve_one),
+                                             std::move(fail_one), std::move(cost_of));
+            return results;
+        }
+
+        /**
+         * @brief Resolves a batch whose items may depend on one another, gathering one result per item in input order.
+         * @details The dependency-aware sibling of @ref run_fork_join, over @ref fork_join_graph_dispatch. Item i
+         *          depends on item @p parents[i] (or on nothing, for @ref FORK_JOIN_NO_PARENT or an index past
+         *          @p parents), and its @p resolve_one receives a pointer to that parent's finished result, or nullptr
+         *          for a root; it decides what a failed parent means for it. An item whose parent never runs (out of
+         *          range, or on a cycle) keeps its @p fail_one seed. Results, fail-closed seeding, the throw handling
+         *          and cancellation are those of @ref run_fork_join; a node skipped by a cancellation still releases
+         *          its children, which are skipped in turn.
+         * @tparam ResolveOne Callable (const Item&, const Result *parent) -> Result. May throw; see @ref run_fork_join.
+         * @throws std::bad_alloc if the result vector or the graph cannot be allocated.
+         */
+        template <typename Item, typename Result, typename ResolveOne, typename FailOne>
+        [[nodiscard]] std::vector<Result> run_fork_join_graph(std::span<const Item> items,
+                                                              std::span<const std::size_t> parents,
+                                                              std::size_t max_workers, ResolveOne resolve_one,
+                                                              FailOne fail_one)
+        {
+            static_assert(std::is_nothrow_move_assignable_v<Result>,
+                          "Result is assigned into a slot inside a noexcept worker body and must not throw on move.");
+            static_assert(std::is_nothrow_invocable_r_v<Result, FailOne, const Item &>,
+                          "fail_one runs in the noexcept worker body; it must be noexcept and return Result.");
 
+            std::vector<Result> results(items.size());
+            for (std::size_t i = 0; i < items.size(); ++i)
+            {
+                results[i] = fail_one(items[i]);
+            }
+            std::vector<std::size_t> graph(items.size(), FORK_JOIN_NO_PARENT);
+            for (std::size_t i = 0; i < items.size() && i < parents.size(); ++i)
+            {
+                graph[i] = parents[i];
+            }
+
+            struct Batch
+            {
+                std::span<const Item> items;
+                std::span<const std::size_t> parents;
+                std::vector<Result> &results;
+                ResolveOne &resolve_one;
+                FailOne &fail_one;
+                const BatchCancel *cancel;
+            };
+            Batch batch{items, graph, results, resolve_one, fail_one, active_batch_cancel()};
+            const ForkJoinBody body = [](void *context, std::size_t index) noexcept
             {
-                std::vector<std::jthread> workers;
+                Batch &state = *static_cast<Batch *>(context);
+                const ScopedBatchCancel install(state.cancel);
+                if (state.cancel != nullptr && state.cancel->cancelled())
+                {
+                    state.results[index] = state.fail_one(state.items[index]);
+                    return;
+                }
+                const std::size_t parent = state.parents[index];
+                const Result *parent_result = (parent == FORK_JOIN_NO_PARENT) ? nullptr : &state.results[parent];
                 try
                 {
-                    workers.reserve(worker_count - 1);
-                    for (std::size_t i = 0; i + 1 < worker_count; ++i)
-                    {
-                        workers.emplace_back([&run]() noexcept { run(); });
-                    }
+                    state.results[index] = state.resolve_one(state.items[index], parent_result);
                 }
                 catch (...)
                 {
-                    // Thread creation hit a resource limit after starting zero or more workers. The calling thread
-                    // still drains the shared cursor below, so the batch completes on fewer workers.
+                    state.results[index] = state.fail_one(state.items[index]);
                 }
-                run();
-            }
-
+            };
+            const std::size_t worker_count = fork_join_worker_count(items.size(), max_workers);
+            fork_join_graph_dispatch(graph, worker_count > 1 ? worker_count - 1 : 0, body, &batch);
             return results;
         }
     } // namespace detail
@@ -17,24 +17,35 @@
 #include "DetourModKit/diagnostics.hpp"
 #include "DetourModKit/format.hpp"
 #include "DetourModKit/logger.hpp"
+#include "DetourModKit/profiler.hpp"
 
+#include "fork_join.hpp"
 #include "platform.hpp"
 #include "x86_decode.hpp"
 
 #include <windows.h>
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <initializer_list>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <new>
 #include <optional>
 #include <shared_mutex>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <thread>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -195,17 +206,24 @@ namespace DetourModKit
         {
             None,
             LeadingCall, // 0xE8 call rel32
-            Breakpoint   // 0xCC int3 / 0xCD int n
+            Breakpoint,  // 0xCC int3 / 0xCD int n
+            ShortBody    // a ret or jmp ends the body inside the 5-byte patch window, with no padding after it
         };
 
+        /// Bytes the E9 rel32 patch of an inline or mid hook overwrites.
+        constexpr std::size_t PATCH_WINDOW_BYTES = 5;
+
         // Classifies the first opcode byte of an inline/mid hook target. A leading E8 (call rel32) means the prologue
         // is a relative call whose displacement is computed from the original site; the backend relocates the stolen
         // prologue into a trampoline at a different address, so the relocated call can dispatch to the wrong absolute
         // target. A leading 0xCC (int3) or 0xCD (int n) means the entry is already a breakpoint -- a foreign hook's
         // stub, a patched slot, or alignment padding -- not a real function body. The E9 / FF 25 redirect shapes are
-        // handled separately by detect_existing_inline_hook, and EB rel8 is ordinary short-jump code; this classifier
-        // intentionally flags only the call and breakpoint shapes. The read is fault-guarded so an unmapped or guarded
-        // page yields None rather than faulting the host (the backend create validates separately).
+        // handled separately by detect_existing_inline_hook, and EB rel8 is ordinary short-jump code at the entry.
+        // A ret or an unconditional jmp (rel or indirect, prefixed or not) that ends the body before the 5-byte patch
+        // window does means the patch would also overwrite whatever follows, typically the next function's entry,
+        // unless that is int3/nop padding; that is the ShortBody shape. The reads are fault-guarded so an unmapped or
+        // guarded page yields None rather than faulting the host (the backend create validates separately), and a
+        // window the length decoder cannot walk is left to the backend as well.
         PrologueRisk classify_prologue_risk(std::uintptr_t target_address) noexcept
         {
             if (target_address == 0)
@@ -224,9 +242,40 @@ namespace DetourModKit
             case 0xCC:
             case 0xCD:
                 return PrologueRisk::Breakpoint;
+            case 0xEB:
+                // A short jump at the entry, such as a hot-patch hook's `jmp $-5`, is layered over whole.
+                return PrologueRisk::None;
             default:
+                break;
+            }
+
+            std::array<std::uint8_t, PATCH_WINDOW_BYTES + detail::X86_MAX_INSTRUCTION_LENGTH> window{};
+            if (!detail::guarded_read_bytes(target_address, window.data(), window.size()))
+            {
                 return PrologueRisk::None;
             }
+            std::size_t at = 0;
+            while (at < PATCH_WINDOW_BYTES)
+            {
+                detail::InsnShape shape;
+                if (!detail::decode_insn_shape(window.data() + at, window.size() - at, shape))
+                {
+                    return PrologueRisk::None;
+                }
+                at += shape.length;
+                // The decoded opcode, not the instruction's first byte: a prefixed terminator (rep ret, 66 C3,
+                // REX.W FF E0) ends the body just the same.
+                if (shape.never_falls_through())
+                {
+                    // Padding after the body (int3 or nop) is the one thing the patch may overwrite past its end.
+                    const auto padding = [](std::uint8_t byte) { return byte == 0xCC || byte == 0x90; };
+                    const bool padded = at >= PATCH_WINDOW_BYTES ||
+                                        std::all_of(window.begin() + static_cast<std::ptrdiff_t>(at),
+                                                    window.begin() + PATCH_WINDOW_BYTES, padding);
+                    return padded ? PrologueRisk::None : PrologueRisk::ShortBody;
+                }
+            }
+            return PrologueRisk::None;
         }
 
         /// Human-readable fragment describing a flagged prologue risk, for the diagnostic log lines.
@@ -238,6 +287,8 @@ namespace DetourModKit
                 return "a call (E8)";
             case PrologueRisk::Breakpoint:
                 return "a breakpoint (0xCC/0xCD)";
+            case PrologueRisk::ShortBody:
+                return "a body that ends inside the 5-byte patch";
             case PrologueRisk::None:
                 return "an unremarkable byte";
             }
@@ -321,12 +372,16 @@ namespace DetourModKit
          * @brief Returns the inline trampoline pointer for a hook backend, or nullptr for a mid hook / empty backend.
          * @details This is the value published into the @ref hook::Hook::CallGate while an inline hook is armed, so a
          *          guarded @ref hook::Hook::call can dispatch to it, and the value @ref hook::Hook::original returns on
-         *          its unguarded path. A mid hook holds a MidHook alternative (no callable original), so the get_if
-         *          fails and this returns nullptr.
+         *          its unguarded path. A mid hook holds a MidHook or LiteMidHook alternative (no callable original), so
+         *          both get_ifs fail and this returns nullptr.
          */
         [[nodiscard]] void *
-        inline_trampoline(const std::variant<safetyhook::InlineHook, safetyhook::MidHook> &backend) noexcept
+        inline_trampoline(const hook::HookBackend &backend) noexcept
         {
+            if (const auto *hot_patch = std::get_if<hook::HotPatchHook>(&backend))
+            {
+                return hot_patch->original();
+            }
             const auto *inline_backend = std::get_if<safetyhook::InlineHook>(&backend);
             if (inline_backend == nullptr || !*inline_backend)
             {
@@ -554,10 +609,25 @@ namespace DetourModKit
             }
         }
 
+#ifdef DMK_ENABLE_PROFILING
+        // Hooks created and not yet removed, for the "live_hooks" counter track. A released hook stays installed and
+        // so stays counted.
+        std::atomic<std::int64_t> s_live_hooks{0};
+#endif
+
         /// Emits a hook lifecycle event, swallowing any sink failure so a noexcept path stays no-throw.
         void emit_lifecycle(std::string_view name, std::uint64_t ledger_id, diagnostics::HookKind kind,
                             diagnostics::HookTransition transition) noexcept
         {
+#ifdef DMK_ENABLE_PROFILING
+            // Every creation and removal passes through here, so this is the one place the live count moves.
+            if (transition == diagnostics::HookTransition::Created ||
+                transition == diagnostics::HookTransition::Removed)
+            {
+                const std::int64_t delta = transition == diagnostics::HookTransition::Created ? 1 : -1;
+                DMK_PROFILE_COUNTER("live_hooks", s_live_hooks.fetch_add(delta, std::memory_order_relaxed) + delta);
+            }
+#endif
             try
             {
                 diagnostics::hook_lifecycle().emit_safe(diagnostics::HookLifecycleEvent{
@@ -627,7 +697,7 @@ namespace DetourModKit
                 (void)log().try_log(
                     LogLevel::Warning,
                     "hook: '{}' layers on a hook this kit already placed at {}; destroy layered hooks newest-first.",
-                    name, format::format_address(address));
+                    name, Address{address});
             }
             else
             {
@@ -644,7 +714,7 @@ namespace DetourModKit
                     (void)log().try_log(
                         LogLevel::Warning,
                         "hook: '{}' target {} is already inline-hooked by another module (JMP -> {}); layering on top.",
-                        name, format::format_address(address), format::format_address(prehook.jmp_destination));
+                        name, Address{address}, Address{prehook.jmp_destination});
                 }
             }
 
@@ -661,10 +731,302 @@ namespace DetourModKit
                 (void)log().try_log(
                     LogLevel::Warning,
                     "hook: '{}' target {} begins with {}; installed anyway under the Relocate prologue policy.", name,
-                    format::format_address(address), prologue_risk_description(risk));
+                    Address{address}, prologue_risk_description(risk));
             }
             return PreflightResult{address, reservation.id};
         }
+
+        /// One resolved @ref install_all row, as the table pre-flight checks it.
+        struct TablePreflightRow
+        {
+            std::uintptr_t address{0};
+            hook::Options options{};
+        };
+
+        /**
+         * @brief The read-only part of @ref preflight_target for one resolved @ref install_all row.
+         * @details Applies the refusals an install would apply -- fail_if_already_hooked against the ledger and
+         *          the foreign-JMP heuristic, the Fail prologue policy -- and checks the patch window is readable, but
+         *          takes no reservation and logs nothing, so it runs on any thread and alongside the other rows. The
+         *          install still runs preflight_target under its reservation; this only moves the failures it can
+         *          predict ahead of the first patch.
+         */
+        [[nodiscard]] Result<void> preflight_table_row(const TablePreflightRow &row) noexcept
+        {
+            constexpr const char *where = "hook::install_all";
+            std::array<std::uint8_t, PATCH_WINDOW_BYTES> window{};
+            if (!detail::guarded_read_bytes(row.address, window.data(), window.size()))
+            {
+                return std::unexpected(Error{ErrorCode::InvalidTargetAddress, where, row.address});
+            }
+            if (row.options.fail_if_already_hooked &&
+                (detail::HookLedger::instance().is_target_hooked(row.address) ||
+                 detect_existing_inline_hook(row.address).state == PrehookState::HookedByOtherModule))
+            {
+                return std::unexpected(Error{ErrorCode::TargetAlreadyHookedInProcess, where, row.address});
+            }
+            if (row.options.prologue == hook::Prologue::Fail &&
+                classify_prologue_risk(row.address) != PrologueRisk::None)
+            {
+                return std::unexpected(Error{ErrorCode::TargetPrologueUnsafe, where, row.address});
+            }
+            return {};
+        }
+
+        // Lightweight mid-hook capture stub (a MidCapture narrower than full()).
+        //
+        // The stub builds the backend's Context64 on the stack in the same order the backend's own stub does -- the
+        // rip slot (the trampoline), trampoline_rsp, rsp, then rbp, rax, rbx, rcx, rdx, rsi, rdi, r8..r15, rflags, and
+        // the 256-byte XMM area -- so the MidContext accessors read either shape unchanged. What it leaves out is the
+        // movdqu pair for every xmm6..xmm15 the hook did not declare; those are callee-saved, so the detour cannot
+        // clobber them and skipping them loses nothing but the read. The exit mirrors the backend: reload, skip the
+        // rsp slot, pop trampoline_rsp into rsp, and `ret` through the (possibly rewritten) rip slot.
+        static_assert(offsetof(safetyhook::Context64, rflags) == 16 * 16 &&
+                          offsetof(safetyhook::Context64, rip) == 16 * 16 + 18 * 8 &&
+                          sizeof(safetyhook::Context64) == 16 * 16 + 19 * 8,
+                      "the lightweight mid stub hard-codes the backend's Context64 layout");
+
+        /// xmm0..xmm5, Win64 volatile: saved whatever the declared mask, because the detour may clobber them.
+        constexpr std::uint16_t VOLATILE_XMM_MASK = 0x003F;
+
+        /// Debug builds fill each slot of an uncaptured XMM register with this qword so xmm() can reject the read.
+        constexpr std::uint64_t UNCAPTURED_XMM_FILL = 0xD3C70DD57A1ECA97ULL;
+
+        /// The emitted stub and where its trampoline qword sits, for the install to fill once the backend has one.
+        struct LiteMidStub
+        {
+            std::vector<std::uint8_t> bytes;
+            std::size_t trampoline_slot{0};
+        };
+
+        /**
+         * @brief Emits the capture stub for @p xmm_mask that calls @p detour with the built Context64.
+         * @details The trampoline and detour addresses are qwords after the code, reached rip-relative, so the stub is
+         *          position-independent and can be copied anywhere. The detour runs on a 16-byte aligned stack with
+         *          its 32-byte home area; rbx, already saved in the frame, holds the frame pointer across the call.
+         * @throws std::bad_alloc when the code buffer cannot be allocated.
+         */
+        [[nodiscard]] LiteMidStub build_lite_mid_stub(std::uint16_t xmm_mask, safetyhook::MidHookFn detour)
+        {
+            std::vector<std::uint8_t> code;
+            code.reserve(512);
+            const auto emit = [&code](std::initializer_list<std::uint8_t> bytes)
+            { code.insert(code.end(), bytes.begin(), bytes.end()); };
+            const auto emit_u32 = [&code](std::uint32_t value)
+            {
+                for (int shift = 0; shift < 32; shift += 8)
+                {
+                    code.push_back(static_cast<std::uint8_t>(value >> shift));
+                }
+            };
+            // movdqu [rsp + 16*index], xmm<index> (0x7F) or movdqu xmm<index>, [rsp + 16*index] (0x6F).
+            const auto emit_xmm_move = [&](std::uint8_t opcode, unsigned index)
+            {
+                emit({0xF3});
+                if (index >= 8)
+                {
+                    emit({0x44});
+                }
+                emit({0x0F, opcode, static_cast<std::uint8_t>(0x84 | ((index & 7u) << 3)), 0x24});
+                emit_u32(index * 16u);
+            };
+            const std::uint16_t saved = static_cast<std::uint16_t>(xmm_mask | VOLATILE_XMM_MASK);
+
+            emit({0xFF, 0x35}); // push qword [rip + trampoline]: the rip slot
+            const std::size_t trampoline_fixup = code.size();
+            emit_u32(0);
+            emit({0x54, 0xFF, 0x34, 0x24});                   // push rsp; push qword [rsp]
+            emit({0x55, 0x50, 0x53, 0x51, 0x52, 0x56, 0x57}); // push rbp, rax, rbx, rcx, rdx, rsi, rdi
+            for (std::uint8_t reg = 0; reg < 8; ++reg)
+            {
+                emit({0x41, static_cast<std::uint8_t>(0x50 + reg)}); // push r8..r15
+            }
+            emit({0x9C});                                     // pushfq
+            emit({0x48, 0x81, 0xEC, 0x00, 0x01, 0x00, 0x00}); // sub rsp, 256
+            for (unsigned index = 0; index < 16; ++index)
+            {
+                if ((saved >> index) & 1u)
+                {
+                    emit_xmm_move(0x7F, index);
+                }
+            }
+#ifndef NDEBUG
+            // rax is saved already and volatile across the detour call anyway, so it is free as the fill register.
+            emit({0x48, 0xB8}); // mov rax, imm64
+            for (int shift = 0; shift < 64; shift += 8)
+            {
+                code.push_back(static_cast<std::uint8_t>(UNCAPTURED_XMM_FILL >> shift));
+            }
+            for (unsigned index = 0; index < 16; ++index)
+            {
+                if (((saved >> index) & 1u) == 0)
+                {
+                    for (std::uint32_t half = 0; half < 16; half += 8)
+                    {
+                        emit({0x48, 0x89, 0x84, 0x24}); // mov [rsp + disp32], rax
+                        emit_u32(index * 16u + half);
+                    }
+                }
+            }
+#endif
+            emit({0x48, 0x89, 0xE1});       // mov rcx, rsp: the Context64&
+            emit({0x48, 0x89, 0xE3});       // mov rbx, rsp
+            emit({0x48, 0x83, 0xE4, 0xF0}); // and rsp, -16
+            emit({0x48, 0x83, 0xEC, 0x20}); // sub rsp, 32
+            emit({0xFF, 0x15});             // call qword [rip + detour]
+            const std::size_t detour_fixup = code.size();
+            emit_u32(0);
+            emit({0x48, 0x89, 0xDC}); // mov rsp, rbx
+            for (unsigned index = 0; index < 16; ++index)
+            {
+                if ((saved >> index) & 1u)
+                {
+                    emit_xmm_move(0x6F, index);
+                }
+            }
+            emit({0x48, 0x81, 0xC4, 0x00, 0x01, 0x00, 0x00}); // add rsp, 256
+            emit({0x9D});                                     // popfq
+            for (std::uint8_t reg = 8; reg-- > 0;)
+            {
+                emit({0x41, static_cast<std::uint8_t>(0x58 + reg)}); // pop r15..r8
+            }
+            emit({0x5F, 0x5E, 0x5A, 0x59, 0x5B, 0x58, 0x5D}); // pop rdi, rsi, rdx, rcx, rbx, rax, rbp
+            emit({0x48, 0x8D, 0x64, 0x24, 0x08});             // lea rsp, [rsp + 8]: skip the rsp slot
+            emit({0x5C, 0xC3});                               // pop rsp (trampoline_rsp); ret (the rip slot)
+            while (code.size() % 8 != 0)
+            {
+                code.push_back(0xCC);
+            }
+
+            const std::size_t trampoline_slot = code.size();
+            code.resize(code.size() + 8, 0);
+            const std::size_t detour_slot = code.size();
+            const auto detour_address = reinterpret_cast<std::uintptr_t>(detour);
+            for (int shift = 0; shift < 64; shift += 8)
+            {
+                code.push_back(static_cast<std::uint8_t>(detour_address >> shift));
+            }
+            const auto patch_rel32 = [&code](std::size_t fixup, std::size_t slot)
+            {
+                const auto rel = static_cast<std::uint32_t>(slot - (fixup + 4));
+                std::memcpy(code.data() + fixup, &rel, sizeof(rel));
+            };
+            patch_rel32(trampoline_fixup, trampoline_slot);
+            patch_rel32(detour_fixup, detour_slot);
+            return LiteMidStub{std::move(code), trampoline_slot};
+        }
+
+        /**
+         * @brief Installs a @ref hook::LiteMidHook at @p target: the stub in allocator memory near the site, then a
+         *        backend inline hook from the target to it.
+         * @details The inline hook is created disabled, so the target is patched only after the stub's trampoline
+         *          qword holds the relocated prologue; no thread can reach the stub before it knows where to resume.
+         *          Every failure is logged with its backend reason and collapses to ErrorCode::BackendFailed.
+         * @throws std::bad_alloc from the stub buffer.
+         */
+        [[nodiscard]] Result<hook::LiteMidHook>
+        create_lite_mid_hook(const std::shared_ptr<safetyhook::Allocator> &allocator, std::uintptr_t target,
+                             safetyhook::MidHookFn detour, std::uint16_t xmm_mask, std::string_view name)
+        {
+            const LiteMidStub built = build_lite_mid_stub(xmm_mask, detour);
+            auto allocated = allocator->allocate_near({reinterpret_cast<std::uint8_t *>(target)}, built.bytes.size());
+            if (!allocated)
+            {
+                log().error("hook::mid_at: no memory for the capture stub of '{}' at {} (allocator error {}).", name,
+                            Address{target}, static_cast<int>(allocated.error()));
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::mid_at", target});
+            }
+            safetyhook::Allocation stub = std::move(*allocated);
+            std::memcpy(stub.data(), built.bytes.data(), built.bytes.size());
+
+            auto created = safetyhook::InlineHook::create(allocator, reinterpret_cast<void *>(target), stub.data(),
+                                                          safetyhook::InlineHook::StartDisabled);
+            if (!created)
+            {
+                log().error("hook::mid_at: backend create failed for '{}' at {}: {}", name, Address{target},
+                            backend_error_string(created.error()));
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::mid_at", target});
+            }
+            safetyhook::InlineHook inline_hook = std::move(*created);
+            const auto trampoline = reinterpret_cast<std::uintptr_t>(inline_hook.original<void *>());
+            std::memcpy(stub.data() + built.trampoline_slot, &trampoline, sizeof(trampoline));
+            (void)::FlushInstructionCache(::GetCurrentProcess(), stub.data(), built.bytes.size());
+            if (auto enabled = inline_hook.enable(); !enabled)
+            {
+                log().error("hook::mid_at: enabling the capture stub of '{}' at {} failed: {}", name, Address{target},
+                            backend_error_string(enabled.error()));
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::mid_at", target});
+            }
+            return hook::LiteMidHook{std::move(stub), std::move(inline_hook)};
+        }
+
+        /// Size of the hot-patch stub: the 16-byte original, then the 14-byte absolute jump to the detour.
+        constexpr std::size_t HOT_PATCH_STUB_SIZE = 30;
+        /// Offset of the detour jump inside the hot-patch stub, where the pad's rel32 JMP lands.
+        constexpr std::size_t HOT_PATCH_RELAY_OFFSET = 16;
+
+        /// Writes `jmp qword [rip + 0]` followed by the absolute @p destination at @p code (14 bytes).
+        void emit_absolute_jump(std::uint8_t *code, std::uintptr_t destination) noexcept
+        {
+            constexpr std::array<std::uint8_t, 6> JMP_RIP = {0xFF, 0x25, 0x00, 0x00, 0x00, 0x00};
+            std::memcpy(code, JMP_RIP.data(), JMP_RIP.size());
+            std::memcpy(code + JMP_RIP.size(), &destination, sizeof(destination));
+        }
+
+        /**
+         * @brief Installs a @ref hook::HotPatchHook at the hot-patchable @p entry and arms it.
+         * @details The stub is completed and flushed, and the pad's rel32 JMP to it is written, before the entry is
+         *          touched: the filler is never executed, so those writes race with nobody, and the single 2-byte
+         *          store that arms the entry is the only change a running thread can observe. Every failure is logged
+         *          and collapses to ErrorCode::BackendFailed with every byte already written put back.
+         */
+        [[nodiscard]] Result<hook::HotPatchHook>
+        create_hot_patch_hook(const std::shared_ptr<safetyhook::Allocator> &allocator, std::uintptr_t entry,
+                              void *detour, const DetourModKit::detail::HotPatchSite &site, std::string_view name)
+        {
+            const std::uintptr_t pad = entry - site.pad.size();
+            auto allocated = allocator->allocate_near({reinterpret_cast<std::uint8_t *>(pad)}, HOT_PATCH_STUB_SIZE);
+            if (!allocated)
+            {
+                log().error("hook::inline_at: no memory for the hot-patch stub of '{}' at {} (allocator error {}).",
+                            name, Address{entry}, static_cast<int>(allocated.error()));
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", entry});
+            }
+            safetyhook::Allocation stub = std::move(*allocated);
+            std::uint8_t *code = stub.data();
+            std::memcpy(code, site.entry.data(), site.entry.size());
+            emit_absolute_jump(code + site.entry.size(), entry + site.entry.size());
+            emit_absolute_jump(code + HOT_PATCH_RELAY_OFFSET, reinterpret_cast<std::uintptr_t>(detour));
+            (void)::FlushInstructionCache(::GetCurrentProcess(), code, HOT_PATCH_STUB_SIZE);
+
+            const auto relay = static_cast<std::int64_t>(stub.address() + HOT_PATCH_RELAY_OFFSET);
+            const std::int64_t rel = relay - static_cast<std::int64_t>(pad + 5);
+            if (rel < std::numeric_limits<std::int32_t>::min() || rel > std::numeric_limits<std::int32_t>::max())
+            {
+                log().error("hook::inline_at: the hot-patch stub of '{}' landed out of rel32 reach of {}.", name,
+                            Address{entry});
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", entry});
+            }
+            std::array<std::byte, 5> pad_jump{std::byte{0xE9}};
+            const auto rel32 = static_cast<std::int32_t>(rel);
+            std::memcpy(pad_jump.data() + 1, &rel32, sizeof(rel32));
+            if (auto written = memory::write_bytes(Address{pad}, pad_jump); !written)
+            {
+                log().error("hook::inline_at: writing the hot-patch pad of '{}' at {} failed: {}", name, Address{entry},
+                            written.error().message());
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", entry});
+            }
+            // From here the HotPatchHook owns the pad: a failed enable unwinds through its destructor, which puts
+            // the filler back.
+            hook::HotPatchHook hot_patch{std::move(stub), entry, site.entry, site.pad};
+            if (auto enabled = hot_patch.enable(); !enabled)
+            {
+                log().error("hook::inline_at: arming the hot-patch entry of '{}' at {} failed: {}", name,
+                            Address{entry}, enabled.error().message());
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", entry});
+            }
+            return hot_patch;
+        }
     } // namespace
 
     namespace hook
@@ -750,6 +1112,13 @@ namespace DetourModKit
             const auto &context = reinterpret_cast<const safetyhook::Context64 &>(ctx);
             const safetyhook::Xmm &reg = (&context.xmm0)[index];
             std::memcpy(view.bytes.data(), reg.u8, view.bytes.size());
+#ifndef NDEBUG
+            // A lightweight stub built in a debug build fills every register it did not capture with the marker.
+            std::array<std::uint64_t, 2> halves{};
+            std::memcpy(halves.data(), view.bytes.data(), sizeof(halves));
+            assert(!(halves[0] == UNCAPTURED_XMM_FILL && halves[1] == UNCAPTURED_XMM_FILL) &&
+                   "hook::xmm: this register is outside the hook's MidCapture mask");
+#endif
             return view;
         }
 
@@ -762,17 +1131,347 @@ namespace DetourModKit
             return allocator;
         }
 
+        // HotPatchHook (the hot-patch pad backend, see hook_backend.hpp).
+        HotPatchHook::HotPatchHook(safetyhook::Allocation stub, std::uintptr_t entry,
+                                   std::array<std::uint8_t, 2> entry_bytes,
+                                   std::array<std::uint8_t, 5> pad_bytes) noexcept
+            : m_stub(std::move(stub)), m_entry(entry), m_entry_bytes(entry_bytes), m_pad_bytes(pad_bytes)
+        {
+        }
+
+        HotPatchHook::HotPatchHook(HotPatchHook &&other) noexcept
+            : m_stub(std::move(other.m_stub)), m_entry(std::exchange(other.m_entry, 0)),
+              m_entry_bytes(other.m_entry_bytes), m_pad_bytes(other.m_pad_bytes),
+              m_enabled(std::exchange(other.m_enabled, false))
+        {
+        }
+
+        HotPatchHook &HotPatchHook::operator=(HotPatchHook &&other) noexcept
+        {
+            if (this != &other)
+            {
+                reset();
+                m_stub = std::move(other.m_stub);
+                m_entry = std::exchange(other.m_entry, 0);
+                m_entry_bytes = other.m_entry_bytes;
+                m_pad_bytes = other.m_pad_bytes;
+                m_enabled = std::exchange(other.m_enabled, false);
+            }
+            return *this;
+        }
+
+        HotPatchHook::~HotPatchHook() noexcept
+        {
+            reset();
+        }
+
+        Result<void> HotPatchHook::enable() noexcept
+        {
+            if (m_entry == 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::HotPatchHook::enable"});
+            }
+            if (!m_enabled)
+            {
+                // EB F9: jmp back over the five pad bytes to the pad's rel32 JMP.
+                if (auto stored = store_entry({0xEB, 0xF9}); !stored)
+                {
+                    return stored;
+                }
+                m_enabled = true;
+            }
+            return {};
+        }
+
+        Result<void> HotPatchHook::disable() noexcept
+        {
+            if (m_entry == 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::HotPatchHook::disable"});
+            }
+            if (m_enabled)
+            {
+                if (auto stored = store_entry(m_entry_bytes); !stored)
+                {
+                    return stored;
+                }
+                m_enabled = false;
+            }
+            return {};
+        }
+
+        Result<void> HotPatchHook::store_entry(std::array<std::uint8_t, 2> bytes) noexcept
+        {
+            auto writable = memory::ProtectGuard::make(Region{Address{m_entry}, bytes.size()}, Prot::RWX);
+            if (!writable)
+            {
+                return std::unexpected(writable.error());
+            }
+            SHORT value = 0;
+            std::memcpy(&value, bytes.data(), sizeof(value));
+            (void)InterlockedExchange16(reinterpret_cast<SHORT volatile *>(m_entry), value);
+            (void)::FlushInstructionCache(::GetCurrentProcess(), reinterpret_cast<const void *>(m_entry), bytes.size());
+            return {};
+        }
+
+        void HotPatchHook::reset() noexcept
+        {
+            if (m_entry == 0)
+            {
+                return;
+            }
+            bool restored = !m_enabled || store_entry(m_entry_bytes).has_value();
+            m_enabled = false;
+            // A thread can still be between the old entry jump and the pad when the filler goes back; that is the
+            // same teardown window as the backend's own trampoline free, and it is a few instructions wide.
+            const std::uintptr_t entry = std::exchange(m_entry, 0);
+            if (restored)
+            {
+                const Address pad{entry - m_pad_bytes.size()};
+                restored = memory::write_bytes(pad, std::as_bytes(std::span{m_pad_bytes})).has_value();
+            }
+            if (!restored)
+            {
+                // The entry or the pad still reaches the stub: leak it rather than free code a thread can run.
+                log().warning("hook: could not restore the hot-patch site at {}; leaking its stub.", Address{entry});
+                (void)new (std::nothrow) safetyhook::Allocation(std::move(m_stub));
+                return;
+            }
+            m_stub = safetyhook::Allocation{};
+        }
+
+        // Trampoline reservation (reserve_trampolines, install_all).
+        namespace
+        {
+            // Backend bytes budgeted per hook: a relocated prologue and its return jump, plus a mid hook's
+            // context-saving stub, with room left for an instruction that needed widening. Over-budgeting is cheap;
+            // the surplus stays in the pool for the next install.
+            constexpr std::size_t TRAMPOLINE_BUDGET_BYTES = 512;
+
+            // The base of the reservation @p address lies in -- the module base for image code -- or @p address itself
+            // when it cannot be queried. Rows sharing a base share one trampoline reservation.
+            [[nodiscard]] std::uintptr_t allocation_base_of(std::uintptr_t address) noexcept
+            {
+                MEMORY_BASIC_INFORMATION info{};
+                if (VirtualQuery(reinterpret_cast<const void *>(address), &info, sizeof(info)) == 0 ||
+                    info.AllocationBase == nullptr)
+                {
+                    return address;
+                }
+                return reinterpret_cast<std::uintptr_t>(info.AllocationBase);
+            }
+        } // namespace
+
+        // Hook::CallGate -- the lock-free guarded-call gate and its free list.
+        namespace
+        {
+            // Drained gates awaiting reuse. Heap-allocated and never destroyed, so a Hook torn down from a static
+            // destructor after this TU's statics are gone still finds a live mutex to recycle under.
+            struct CallGatePool
+            {
+                std::mutex mutex;
+                void *head{nullptr};
+            };
+
+            [[nodiscard]] CallGatePool &call_gate_pool()
+            {
+                static CallGatePool *const pool = new CallGatePool{};
+                return *pool;
+            }
+        } // namespace
+
+        Hook::CallGate *Hook::CallGate::acquire()
+        {
+            CallGatePool &pool = call_gate_pool();
+            {
+                const std::lock_guard<std::mutex> lock(pool.mutex);
+                if (pool.head != nullptr)
+                {
+                    auto *gate = static_cast<CallGate *>(pool.head);
+                    pool.head = gate->next_free;
+                    gate->next_free = nullptr;
+                    return gate;
+                }
+            }
+            return new CallGate{};
+        }
+
+        void Hook::CallGate::recycle(CallGate *gate) noexcept
+        {
+            if (gate == nullptr)
+            {
+                return;
+            }
+            // Every stripe is back at zero (the teardown drained them) apart from stale callers that are about to back
+            // out, and those net to zero on their own stripe. Only the published trampoline needs clearing.
+            gate->callable.store(nullptr, std::memory_order_relaxed);
+#ifdef DMK_ENABLE_HOOK_STATS
+            gate->stats.store(nullptr, std::memory_order_relaxed);
+#endif
+            try
+            {
+                CallGatePool &pool = call_gate_pool();
+                const std::lock_guard<std::mutex> lock(pool.mutex);
+                gate->next_free = static_cast<CallGate *>(pool.head);
+                pool.head = gate;
+            }
+            catch (...)
+            {
+                // The gate must never be freed (a stale caller may still touch it), so a failed push leaks it.
+                diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::HookManager);
+            }
+        }
+
+        std::size_t Hook::CallGate::stripe_index() noexcept
+        {
+            // Golden-ratio mixing of the thread id, as the guarded-read in-flight stripes do: stable for the thread's
+            // life (so enter and leave hit the same stripe), allocation-free, and safe under loader lock, unlike a
+            // thread_local whose MinGW first touch allocates.
+            const std::uint64_t mixed = static_cast<std::uint64_t>(::GetCurrentThreadId()) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<std::size_t>(mixed >> 48) % STRIPE_COUNT;
+        }
+
+        std::unique_lock<std::mutex> Hook::CallGate::lock_control() noexcept
+        {
+            try
+            {
+                return std::unique_lock<std::mutex>(control);
+            }
+            catch (...)
+            {
+                // std::mutex::lock can throw std::system_error; the writers fail closed on the unowned lock.
+                return std::unique_lock<std::mutex>{};
+            }
+        }
+
+        void Hook::CallGate::drain() noexcept
+        {
+            // The caller has already published a null callable (seq_cst), so every caller not counted here backs out.
+            int spins = 0;
+            for (;;)
+            {
+                int total = 0;
+                for (const Stripe &stripe : in_flight)
+                {
+                    total += stripe.count.load(std::memory_order_seq_cst);
+                }
+                if (total == 0)
+                {
+                    return;
+                }
+                if (spins < 4096)
+                    std::this_thread::yield();
+                else
+                    std::this_thread::sleep_for(std::chrono::microseconds(100));
+                ++spins;
+            }
+        }
+
+#ifdef DMK_ENABLE_HOOK_STATS
+        // Per-hook call statistics (DMK_ENABLE_HOOK_STATS): the mid-hook timing thunks and the stats lease.
+        namespace
+        {
+            // The backend calls a mid-hook detour with nothing but the register context, so one shared timing wrapper
+            // could not tell which hook it is running for. Each wrapper is instead its own instantiation bound to one
+            // slot of a fixed table. A mid hook installed while every slot is taken still runs, just untimed.
+            constexpr std::size_t MID_STATS_SLOTS = 64;
+
+            struct MidStatsSlot
+            {
+                std::atomic<safetyhook::MidHookFn> detour{nullptr};
+                std::atomic<DetourModKit::detail::HookCallStats *> stats{nullptr};
+                bool claimed{false}; // guarded by mid_stats_mutex()
+            };
+
+            // Constant-initialized, so a thunk never runs ahead of its table.
+            std::array<MidStatsSlot, MID_STATS_SLOTS> s_mid_stats_slots{};
+
+            // Heap-allocated and never destroyed, for the same static-destruction reason as the call-gate pool.
+            [[nodiscard]] std::mutex &mid_stats_mutex()
+            {
+                static std::mutex *const mutex = new std::mutex();
+                return *mutex;
+            }
+
+            template <std::size_t Slot> void mid_stats_thunk(safetyhook::Context &ctx)
+            {
+                using DetourModKit::detail::HookCallStats;
+                MidStatsSlot &slot = s_mid_stats_slots[Slot];
+                const safetyhook::MidHookFn detour = slot.detour.load(std::memory_order_acquire);
+                if (detour == nullptr)
+                {
+                    return;
+                }
+                HookCallStats *const stats = slot.stats.load(std::memory_order_relaxed);
+                const std::int64_t start = HookCallStats::now();
+                detour(ctx);
+                if (stats != nullptr)
+                {
+                    stats->record(HookCallStats::shard_index(), HookCallStats::now() - start);
+                }
+            }
+
+            template <std::size_t... Slots>
+            [[nodiscard]] constexpr std::array<safetyhook::MidHookFn, sizeof...(Slots)>
+            make_mid_stats_thunks(std::index_sequence<Slots...>) noexcept
+            {
+                return {&mid_stats_thunk<Slots>...};
+            }
+
+            constexpr std::array<safetyhook::MidHookFn, MID_STATS_SLOTS> s_mid_stats_thunks =
+                make_mid_stats_thunks(std::make_index_sequence<MID_STATS_SLOTS>{});
+
+            /// Binds a free slot to @p detour / @p stats and returns its index, or -1 when every slot is taken.
+            [[nodiscard]] int claim_mid_stats_slot(safetyhook::MidHookFn detour,
+                                                   DetourModKit::detail::HookCallStats *stats)
+            {
+                const std::lock_guard<std::mutex> lock(mid_stats_mutex());
+                for (std::size_t i = 0; i < MID_STATS_SLOTS; ++i)
+                {
+                    MidStatsSlot &slot = s_mid_stats_slots[i];
+                    if (!slot.claimed)
+                    {
+                        slot.claimed = true;
+                        slot.stats.store(stats, std::memory_order_relaxed);
+                        slot.detour.store(detour, std::memory_order_release);
+                        return static_cast<int>(i);
+                    }
+                }
+                return -1;
+            }
+        } // namespace
+
+        HookStatsLease::~HookStatsLease()
+        {
+            if (mid_slot >= 0)
+            {
+                MidStatsSlot &slot = s_mid_stats_slots[static_cast<std::size_t>(mid_slot)];
+                slot.detour.store(nullptr, std::memory_order_release);
+                slot.stats.store(nullptr, std::memory_order_relaxed);
+                try
+                {
+                    const std::lock_guard<std::mutex> lock(mid_stats_mutex());
+                    slot.claimed = false;
+                }
+                catch (...)
+                {
+                    // std::mutex::lock threw: the slot stays claimed, costing one table entry rather than a race.
+                }
+            }
+            DetourModKit::detail::HookStatsRegistry::instance().release(stats);
+        }
+#endif
+
         // Hook -- RAII handle for one inline or mid hook.
-        Hook::Hook(std::unique_ptr<Impl> impl, std::shared_ptr<CallGate> gate) noexcept : m_impl(std::move(impl))
+        Hook::Hook(std::unique_ptr<Impl> impl, CallGate *gate) noexcept : m_impl(std::move(impl)), m_gate(gate)
         {
-            m_gate.store(std::move(gate), std::memory_order_release);
         }
 
         Hook::Hook(Hook &&other) noexcept : m_impl(std::move(other.m_impl))
         {
-            // std::atomic is not movable, so transfer the gate reference by hand. exchange leaves the source's gate
-            // empty, so a moved-from handle is fully disengaged: its ~Hook takes the early return and its call()
-            // reads an empty gate and returns the inactive default.
+            // std::atomic is not movable, so transfer the gate by hand. exchange leaves the source's gate empty, so a
+            // moved-from handle is fully disengaged: its ~Hook takes the early return and its call() reads an empty
+            // gate and returns the inactive default.
             m_gate.store(other.m_gate.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
         }
 
@@ -782,8 +1481,8 @@ namespace DetourModKit
             {
                 // Adopt the current hook into a temporary whose destructor unhooks it at the end of this scope, then
                 // take the source's impl and gate. Constructing `discard` from *this moves out BOTH members (see the
-                // move constructor), so a concurrent call() that pinned this handle's gate before the move keeps the
-                // old trampoline alive until it returns, while `discard`'s ~Hook runs the loader-lock-aware teardown.
+                // move constructor), so a concurrent call() that entered this handle's old gate before the move is
+                // drained by `discard`'s ~Hook, which runs the loader-lock-aware teardown.
                 Hook discard(std::move(*this));
                 m_impl = std::move(other.m_impl);
                 m_gate.store(other.m_gate.exchange(nullptr, std::memory_order_acq_rel), std::memory_order_release);
@@ -793,10 +1492,9 @@ namespace DetourModKit
 
         Hook::~Hook()
         {
-            // Take the handle's gate reference out for the whole teardown. A concurrent call() that already pinned the
-            // gate keeps its recursive_mutex (and, in the loader-lock branch, the leaked-but-live trampoline) alive via
-            // its own reference, so nulling the callable below is enough to make a late caller fail closed.
-            std::shared_ptr<CallGate> gate = m_gate.exchange(nullptr, std::memory_order_acq_rel);
+            // Take the gate out of the handle for the whole teardown. seq_cst pairs with the re-read in enter_call: a
+            // caller whose count lands after this exchange sees the handle's gate gone and backs out.
+            CallGate *const gate = m_gate.exchange(nullptr, std::memory_order_seq_cst);
             if (!m_impl)
             {
                 return;
@@ -806,8 +1504,8 @@ namespace DetourModKit
             // freeing the trampoline can deadlock against another thread waiting on a loader callback. Leave the
             // backend hook installed and leak the Impl rather than tear it down here. The Impl carries the module
             // reference taken before the backend was published (self_ref), so leaking it keeps the trampoline's code
-            // pages mapped -- the gate's published callable stays valid and a late guarded call() through it still
-            // dispatches correctly.
+            // pages mapped. The gate is leaked with it, callable still set, so a guarded call() already in flight
+            // keeps a valid trampoline and nothing waits on the loader lock for it to drain.
             if (DetourModKit::detail::is_loader_lock_held())
             {
                 diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::HookManager);
@@ -833,26 +1531,27 @@ namespace DetourModKit
             {
             }
 
-            // Serialize with any in-flight call() through the shared gate. A caller holding gate->mutex for its whole
-            // invocation runs to completion before this acquires it (the drain for callers that already locked).
-            // Publishing a null callable under the same mutex then makes a caller that locks AFTER this -- one that had
-            // only pinned the gate, not yet locked, when this teardown began -- read a null trampoline and return the
-            // inactive default instead of dispatching through the trampoline the reset below frees. The gate outlives
-            // that late caller because the caller holds its own reference; only the backend/trampoline is freed here.
-            if (gate)
+            // Stop guarded dispatch and wait out the calls already in flight. Publishing a null callable (seq_cst)
+            // makes every caller that enters after it back out, and drain() then waits for the counted ones to
+            // return, so no call() can be running on the trampoline the reset below frees. The drained gate goes back
+            // to the pool; a stale caller that still holds its pointer touches live memory and backs out.
+            if (gate != nullptr)
             {
-                std::unique_lock<std::recursive_mutex> guard = acquire_call_lock(gate.get());
+                std::unique_lock<std::mutex> guard = gate->lock_control();
                 if (!guard.owns_lock())
                 {
-                    // If the guard itself cannot be acquired, restoring is no longer provably safe. Leak the backend
-                    // (and, with it, the install-time module reference in the Impl, which keeps the trampoline mapped)
-                    // rather than risk freeing a trampoline that a guarded caller may still use.
+                    // If the writer lock itself cannot be acquired, restoring is no longer provably safe. Leak the
+                    // backend (and, with it, the install-time module reference in the Impl, which keeps the trampoline
+                    // mapped) and the gate rather than risk freeing a trampoline that a guarded caller may still use.
                     diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::HookManager);
                     (void)m_impl.release();
                     return;
                 }
-                gate->callable = nullptr;
+                gate->callable.store(nullptr, std::memory_order_seq_cst);
                 m_impl->status.store(HookState::Disabled, std::memory_order_release);
+                gate->drain();
+                guard.unlock();
+                CallGate::recycle(gate);
             }
 
             // Decide leak-vs-restore BEFORE touching backend memory, and do it while holding this target's install-
@@ -895,7 +1594,7 @@ namespace DetourModKit
                     "hook: '{}' at {} destroyed while {} newer hook(s) remain layered on the same target; leaked the "
                     "older backend to avoid a trampoline use-after-free. Tear layered hooks down newest-first (hold "
                     "them in a HookStack).",
-                    name, format::format_address(target), newer);
+                    name, Address{target}, newer);
                 emit_lifecycle(name, ledger_id, kind, diagnostics::HookTransition::Removed);
                 return;
             }
@@ -906,7 +1605,7 @@ namespace DetourModKit
             // the freshly-restored pristine prologue. Restore the prologue and free the trampoline FIRST, then release
             // the ledger entry (which drops both the slot sentinel and the creation-order record, waking that next
             // reserver). No call() can be dispatching through the trampoline here: the gate published a null callable
-            // under its mutex, and any caller that had already locked was drained above.
+            // and drained every caller that had already entered.
             //
             // Grab the install-time module reference before reset() destroys the Impl, then release the ledger slot
             // (release_hook) BEFORE that module reference. release_module_ref calls FreeLibrary, which takes the loader
@@ -948,34 +1647,47 @@ namespace DetourModKit
             return m_impl ? inline_trampoline(m_impl->backend) : nullptr;
         }
 
-        std::shared_ptr<Hook::CallGate> Hook::pin_call_gate() const noexcept
-        {
-            // Atomically copy the gate reference into a strong local so call() can hold the trampoline and mutex alive
-            // across a concurrent teardown that drops the handle's own reference.
-            return m_gate.load(std::memory_order_acquire);
-        }
-
-        std::unique_lock<std::recursive_mutex> Hook::acquire_call_lock(CallGate *gate) const noexcept
+        void Hook::enter_call(GuardedDispatch &dispatch) const noexcept
         {
-            try
+            CallGate *const gate = m_gate.load(std::memory_order_acquire);
+            if (gate == nullptr)
             {
-                return std::unique_lock<std::recursive_mutex>(gate->mutex);
+                return;
             }
-            catch (...)
-            {
-                // recursive_mutex::lock can throw std::system_error (max recursion / resource exhaustion). Fail
-                // closed: an unowned lock makes call() return the inactive default rather than dispatching unguarded
-                // or letting the throw escape the non-noexcept call() into a host that may be mid-teardown.
-                return std::unique_lock<std::recursive_mutex>{};
+            // Count first, then re-read: the seq_cst increment and loads order against the writer's seq_cst
+            // gate/callable publishes and drain loads, so either the writer counts this call or this call sees the
+            // null and backs out. The re-read of m_gate catches a teardown that recycled the gate after the first load.
+            const std::size_t stripe = CallGate::stripe_index();
+            std::atomic<int> &count = gate->in_flight[stripe].count;
+            count.fetch_add(1, std::memory_order_seq_cst);
+            void *const trampoline = m_gate.load(std::memory_order_seq_cst) == gate
+                                         ? gate->callable.load(std::memory_order_seq_cst)
+                                         : nullptr;
+            if (trampoline == nullptr)
+            {
+                count.fetch_sub(1, std::memory_order_release);
+                return;
             }
+            dispatch.gate = gate;
+            dispatch.stripe = stripe;
+            dispatch.trampoline = trampoline;
+#ifdef DMK_ENABLE_HOOK_STATS
+            dispatch.start_ticks = DetourModKit::detail::HookCallStats::now();
+#endif
         }
 
-        void *Hook::active_trampoline(CallGate *gate) const noexcept
+        void Hook::leave_call(const GuardedDispatch &dispatch) noexcept
         {
-            // Read the callable published under the gate mutex the caller already holds. create/enable/disable/~Hook
-            // all write gate->callable under the same mutex, so this observes either the live trampoline or the
-            // nullptr a teardown published before freeing the backend -- never a dangling pointer.
-            return gate->callable;
+#ifdef DMK_ENABLE_HOOK_STATS
+            // Record while still counted: the teardown's drain then orders every sample before the record is
+            // returned to the registry.
+            if (DetourModKit::detail::HookCallStats *const stats = dispatch.gate->stats.load(std::memory_order_relaxed))
+            {
+                stats->record(dispatch.stripe, DetourModKit::detail::HookCallStats::now() - dispatch.start_ticks);
+            }
+#endif
+            // release: the dispatch's trampoline use happens-before a drain that observes the count at zero.
+            dispatch.gate->in_flight[dispatch.stripe].count.fetch_sub(1, std::memory_order_release);
         }
 
         // NOLINTNEXTLINE(bugprone-exception-escape): std::visit is on a checked variant and cannot throw here
@@ -987,12 +1699,12 @@ namespace DetourModKit
             }
             // A live handle always has a gate (created with the Impl); the null check fails closed on the broken
             // invariant rather than dereferencing a null control block.
-            const std::shared_ptr<CallGate> gate = m_gate.load(std::memory_order_acquire);
-            if (!gate)
+            CallGate *const gate = m_gate.load(std::memory_order_acquire);
+            if (gate == nullptr)
             {
                 return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::enable"});
             }
-            std::unique_lock<std::recursive_mutex> guard = acquire_call_lock(gate.get());
+            std::unique_lock<std::mutex> guard = gate->lock_control();
             if (!guard.owns_lock())
             {
                 return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::enable"});
@@ -1014,18 +1726,18 @@ namespace DetourModKit
             if (std::visit([](auto &backend) { return backend.enable().has_value(); }, m_impl->backend))
             {
                 m_impl->status.store(HookState::Active, std::memory_order_release);
-                // Publish the callable trampoline under the gate mutex so a guarded call() dispatches to the freshly
-                // armed hook. A mid hook has no callable original, so inline_trampoline yields nullptr and call()
-                // keeps returning the inactive default for it.
-                gate->callable = inline_trampoline(m_impl->backend);
+                // Publish the callable trampoline so a guarded call() dispatches to the freshly armed hook. A mid hook
+                // has no callable original, so inline_trampoline yields nullptr and call() keeps returning the inactive
+                // default for it.
+                gate->callable.store(inline_trampoline(m_impl->backend), std::memory_order_release);
                 const diagnostics::HookKind kind =
                     m_impl->is_inline ? diagnostics::HookKind::Inline : diagnostics::HookKind::Mid;
                 const std::string_view name = m_impl->name;
                 const std::uint64_t ledger_id = m_impl->ledger_id;
                 // Release the gate guard before dispatching the lifecycle event: emit_lifecycle runs arbitrary
-                // subscriber code, which must not execute while DMK's per-hook mutex is held (CP.22 -- never call
-                // unknown code under a lock). enable() does not reset m_impl, so the captured name view and ledger id
-                // stay valid.
+                // subscriber code, which must not execute while DMK's per-hook writer mutex is held (CP.22 -- never
+                // call unknown code under a lock). enable() does not reset m_impl, so the captured name view and ledger
+                // id stay valid.
                 guard.unlock();
                 emit_lifecycle(name, ledger_id, kind, diagnostics::HookTransition::Enabled);
                 return {};
@@ -1041,12 +1753,12 @@ namespace DetourModKit
             {
                 return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::disable"});
             }
-            const std::shared_ptr<CallGate> gate = m_gate.load(std::memory_order_acquire);
-            if (!gate)
+            CallGate *const gate = m_gate.load(std::memory_order_acquire);
+            if (gate == nullptr)
             {
                 return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::disable"});
             }
-            std::unique_lock<std::recursive_mutex> guard = acquire_call_lock(gate.get());
+            std::unique_lock<std::mutex> guard = gate->lock_control();
             if (!guard.owns_lock())
             {
                 return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::disable"});
@@ -1068,11 +1780,11 @@ namespace DetourModKit
             if (std::visit([](auto &backend) { return backend.disable().has_value(); }, m_impl->backend))
             {
                 m_impl->status.store(HookState::Disabled, std::memory_order_release);
-                // Clear the callable under the gate mutex so a call() that arrives after this stops dispatching
-                // through the now-disarmed trampoline and returns the inactive default. A concurrent in-flight call()
-                // holding the gate mutex has already drained this disable (it blocks on guard above until the call
-                // returns).
-                gate->callable = nullptr;
+                // Clear the callable so a call() that arrives after this stops dispatching through the now-disarmed
+                // trampoline and returns the inactive default, then wait for the calls already in flight to return,
+                // so a caller of disable() knows no guarded call is still running the original.
+                gate->callable.store(nullptr, std::memory_order_seq_cst);
+                gate->drain();
                 const diagnostics::HookKind kind =
                     m_impl->is_inline ? diagnostics::HookKind::Inline : diagnostics::HookKind::Mid;
                 const std::string_view name = m_impl->name;
@@ -1096,12 +1808,191 @@ namespace DetourModKit
             // Leak the backend hook intentionally: it stays installed for the process lifetime. The ledger entry is
             // left in place too, since is_target_hooked must still report the target as hooked. Clearing the gate
             // disengages the handle: a later call()/enable()/disable() sees an empty gate and fails closed (matching
-            // the moved-from contract), while a call() that pinned the gate before this keeps dispatching to the
-            // still-installed (leaked) trampoline until it returns.
+            // the moved-from contract). The gate is leaked with the backend, so a call() that entered it before this
+            // keeps dispatching to the still-installed trampoline until it returns.
             (void)m_impl.release();
             m_gate.store(nullptr, std::memory_order_release);
         }
 
+        // NOLINTNEXTLINE(bugprone-exception-escape): every allocation happens inside the try, before any backend toggle
+        Result<void> Transaction::commit() noexcept
+        {
+            m_scheduled.store(false, std::memory_order_release);
+            struct Step
+            {
+                Hook *hook;
+                Hook::CallGate *gate;
+                bool enable;
+                HookState before;
+                bool toggled;
+            };
+            struct Event
+            {
+                std::string_view name;
+                std::uint64_t ledger_id;
+                diagnostics::HookKind kind;
+                diagnostics::HookTransition transition;
+            };
+            try
+            {
+                // Collapse a hook queued more than once to its last operation.
+                std::vector<Step> steps;
+                steps.reserve(m_ops.size());
+                for (auto op = m_ops.rbegin(); op != m_ops.rend(); ++op)
+                {
+                    const auto same_hook = [&op](const Step &step) { return step.hook == op->hook; };
+                    if (std::none_of(steps.begin(), steps.end(), same_hook))
+                    {
+                        steps.push_back(Step{op->hook, nullptr, op->enable, HookState::Disabled, false});
+                    }
+                }
+                for (Step &step : steps)
+                {
+                    step.gate = step.hook->m_impl ? step.hook->m_gate.load(std::memory_order_acquire) : nullptr;
+                    if (step.gate == nullptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::Transaction::commit"});
+                    }
+                }
+                // Lock in gate-address order so two overlapping commits cannot deadlock. A gate belongs to one live
+                // handle, so no gate repeats.
+                std::sort(steps.begin(), steps.end(),
+                          [](const Step &a, const Step &b) { return std::less<>{}(a.gate, b.gate); });
+                std::vector<std::unique_lock<std::mutex>> locks;
+                locks.reserve(steps.size());
+                std::vector<Event> events;
+                events.reserve(steps.size());
+                for (Step &step : steps)
+                {
+                    locks.push_back(step.gate->lock_control());
+                    if (!locks.back().owns_lock())
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::Transaction::commit"});
+                    }
+                }
+
+                // Under every writer lock the states are terminal and the backends cannot go away.
+                for (Step &step : steps)
+                {
+                    Hook::Impl &impl = *step.hook->m_impl;
+                    if (!std::visit([](auto &backend) { return static_cast<bool>(backend); }, impl.backend))
+                    {
+                        return std::unexpected(Error{ErrorCode::BackendFailed, "hook::Transaction::commit"});
+                    }
+                    step.before = impl.status.load(std::memory_order_acquire);
+                    if (step.before != HookState::Active && step.before != HookState::Disabled)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::Transaction::commit"});
+                    }
+                }
+
+                const auto toggle = [](Hook::Impl &impl, bool enable)
+                {
+                    return std::visit([enable](auto &backend)
+                                      { return enable ? backend.enable().has_value() : backend.disable().has_value(); },
+                                      impl.backend);
+                };
+                // Publishes @p enabled for a toggled hook the way Hook::enable / Hook::disable do.
+                const auto publish = [](Step &step, bool enabled)
+                {
+                    Hook::Impl &impl = *step.hook->m_impl;
+                    impl.status.store(enabled ? HookState::Active : HookState::Disabled, std::memory_order_release);
+                    if (enabled)
+                    {
+                        step.gate->callable.store(inline_trampoline(impl.backend), std::memory_order_release);
+                    }
+                    else
+                    {
+                        step.gate->callable.store(nullptr, std::memory_order_seq_cst);
+                    }
+                };
+
+                // The patch window: every backend toggle back-to-back, nothing published yet.
+                for (std::size_t i = 0; i < steps.size(); ++i)
+                {
+                    Step &step = steps[i];
+                    if (step.before == (step.enable ? HookState::Active : HookState::Disabled))
+                    {
+                        continue;
+                    }
+                    Hook::Impl &impl = *step.hook->m_impl;
+                    impl.status.store(step.enable ? HookState::Enabling : HookState::Disabling,
+                                      std::memory_order_release);
+                    if (toggle(impl, step.enable))
+                    {
+                        step.toggled = true;
+                        continue;
+                    }
+                    impl.status.store(step.before, std::memory_order_release);
+                    // Put the set back. A revert that itself fails leaves that hook in its new state, published as
+                    // such, so its status never disagrees with the backend.
+                    for (std::size_t j = 0; j < i; ++j)
+                    {
+                        if (!steps[j].toggled)
+                        {
+                            continue;
+                        }
+                        Hook::Impl &done = *steps[j].hook->m_impl;
+                        if (toggle(done, !steps[j].enable))
+                        {
+                            done.status.store(steps[j].before, std::memory_order_release);
+                        }
+                        else
+                        {
+                            publish(steps[j], steps[j].enable);
+                            (void)log().try_log(LogLevel::Warning,
+                                                "hook::Transaction::commit: could not revert '{}' after a failed "
+                                                "toggle; it stays {}.",
+                                                done.name, steps[j].enable ? "enabled" : "disabled");
+                        }
+                    }
+                    return std::unexpected(Error{step.enable ? ErrorCode::EnableFailed : ErrorCode::DisableFailed,
+                                                 "hook::Transaction::commit"});
+                }
+
+                for (Step &step : steps)
+                {
+                    if (step.toggled)
+                    {
+                        publish(step, step.enable);
+                    }
+                }
+                // Wait out guarded calls still running an original that is now disarmed, as Hook::disable does.
+                for (Step &step : steps)
+                {
+                    if (!step.toggled)
+                    {
+                        continue;
+                    }
+                    if (!step.enable)
+                    {
+                        step.gate->drain();
+                    }
+                    const Hook::Impl &impl = *step.hook->m_impl;
+                    events.push_back(Event{impl.name, impl.ledger_id,
+                                           impl.is_inline ? diagnostics::HookKind::Inline : diagnostics::HookKind::Mid,
+                                           step.enable ? diagnostics::HookTransition::Enabled
+                                                       : diagnostics::HookTransition::Disabled});
+                }
+                // Unlock before running subscriber code (CP.22, see Hook::enable).
+                locks.clear();
+                for (const Event &event : events)
+                {
+                    emit_lifecycle(event.name, event.ledger_id, event.kind, event.transition);
+                }
+                m_ops.clear();
+                return {};
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::Transaction::commit"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::UnknownError, "hook::Transaction::commit"});
+            }
+        }
+
         // Free install verbs.
         namespace detail
         {
@@ -1144,32 +2035,60 @@ namespace DetourModKit
                 }
                 try
                 {
-                    auto created = safetyhook::InlineHook::create(allocator, reinterpret_cast<void *>(target), detour,
-                                                                  safetyhook::InlineHook::Default);
-                    if (!created)
+                    std::optional<DetourModKit::detail::HotPatchSite> hot_patch_site;
+                    if (request.options.hot_patch)
                     {
-                        log().error("hook::inline_at: backend create failed for '{}' at {}: {}", request.name,
-                                    format::format_address(target), backend_error_string(created.error()));
-                        (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
-                        return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", target});
+                        hot_patch_site = DetourModKit::detail::decode_hotpatch_site(target);
                     }
-                    auto backend_hook = std::move(created.value());
-                    const HookState state = backend_hook.enabled() ? HookState::Active : HookState::Disabled;
                     // Store the reserved ledger id in the Impl (its teardown releases it). make_unique, the gate
                     // allocation, and the info log are the only steps that can still throw under OOM; the catch below
-                    // rolls the reservation back, and `impl` (if built) unwinds through ~Impl to restore the prologue.
-                    auto impl = std::make_unique<Hook::Impl>(std::move(backend_hook), std::move(request.name), target,
-                                                             ledger_id, state);
-                    auto gate = std::make_shared<Hook::CallGate>();
+                    // rolls the reservation back, `gate` returns to the pool, and `impl` (if built) unwinds through
+                    // ~Impl to restore the prologue.
+                    std::unique_ptr<Hook::Impl> impl;
+                    HookState state = HookState::Active;
+                    if (hot_patch_site)
+                    {
+                        Result<HotPatchHook> created =
+                            create_hot_patch_hook(allocator, target, detour, *hot_patch_site, request.name);
+                        if (!created)
+                        {
+                            (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
+                            return std::unexpected(created.error());
+                        }
+                        impl = std::make_unique<Hook::Impl>(std::move(*created), std::move(request.name), target,
+                                                            ledger_id, state);
+                    }
+                    else
+                    {
+                        auto created = safetyhook::InlineHook::create(allocator, reinterpret_cast<void *>(target),
+                                                                      detour, safetyhook::InlineHook::Default);
+                        if (!created)
+                        {
+                            log().error("hook::inline_at: backend create failed for '{}' at {}: {}", request.name,
+                                        Address{target}, backend_error_string(created.error()));
+                            (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
+                            return std::unexpected(Error{ErrorCode::BackendFailed, "hook::inline_at", target});
+                        }
+                        auto backend_hook = std::move(created.value());
+                        state = backend_hook.enabled() ? HookState::Active : HookState::Disabled;
+                        impl = std::make_unique<Hook::Impl>(std::move(backend_hook), std::move(request.name), target,
+                                                            ledger_id, state);
+                    }
+                    std::unique_ptr<Hook::CallGate, Hook::CallGate::Recycler> gate{Hook::CallGate::acquire()};
+#ifdef DMK_ENABLE_HOOK_STATS
+                    impl->stats_lease.stats = DetourModKit::detail::HookStatsRegistry::instance().acquire(
+                        impl->name, ledger_id, diagnostics::HookKind::Inline);
+                    gate->stats.store(impl->stats_lease.stats, std::memory_order_relaxed);
+#endif
                     // Publish the callable trampoline for an already-armed inline hook so a guarded call() dispatches
                     // immediately; a disabled create leaves it null until enable() publishes it.
                     if (state == HookState::Active)
                     {
-                        gate->callable = inline_trampoline(impl->backend);
+                        gate->callable.store(inline_trampoline(impl->backend), std::memory_order_release);
                     }
                     const std::string_view created_name = impl->name;
-                    log().info("hook::inline_at: created inline hook '{}' at {}.", created_name,
-                               format::format_address(target));
+                    log().info("hook::inline_at: created {}inline hook '{}' at {}.", hot_patch_site ? "hot-patch " : "",
+                               created_name, Address{target});
                     DetourModKit::detail::HookLedger::instance().commit_hook(target, ledger_id);
                     emit_lifecycle(created_name, ledger_id, diagnostics::HookKind::Inline,
                                    diagnostics::HookTransition::Created);
@@ -1177,7 +2096,7 @@ namespace DetourModKit
                     // callable as soon as the backend create succeeds. Hand it to the Impl only after every fallible
                     // setup step has completed; until then ModuleRefGuard releases it on rollback.
                     impl->self_ref = self_ref.release();
-                    return Hook(std::move(impl), std::move(gate));
+                    return Hook(std::move(impl), gate.release());
                 }
                 catch (const std::bad_alloc &)
                 {
@@ -1230,34 +2149,73 @@ namespace DetourModKit
             }
             try
             {
-                auto created = safetyhook::MidHook::create(allocator, reinterpret_cast<void *>(target),
-                                                           to_backend_detour(detour), safetyhook::MidHook::Default);
-                if (!created)
+#ifdef DMK_ENABLE_HOOK_STATS
+                // Route the backend through a timing thunk bound to this hook's stats record. Declared before the
+                // backend hook so a failed create unhooks before the slot is freed.
+                HookStatsLease stats_lease;
+                stats_lease.stats = DetourModKit::detail::HookStatsRegistry::instance().acquire(
+                    request.name, ledger_id, diagnostics::HookKind::Mid);
+                stats_lease.mid_slot = claim_mid_stats_slot(to_backend_detour(detour), stats_lease.stats);
+                if (stats_lease.mid_slot < 0)
                 {
-                    log().error("hook::mid_at: backend create failed for '{}' at {}: {}", request.name,
-                                format::format_address(target), backend_error_string(created.error()));
-                    (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
-                    return std::unexpected(Error{ErrorCode::BackendFailed, "hook::mid_at", target});
+                    DetourModKit::detail::HookStatsRegistry::instance().release(
+                        std::exchange(stats_lease.stats, nullptr));
+                    log().debug(log_category::hook, "hook::mid_at: every stats thunk is in use; '{}' runs untimed.",
+                                request.name);
                 }
-                auto backend_hook = std::move(created.value());
-                const HookState state = backend_hook.enabled() ? HookState::Active : HookState::Disabled;
+                const safetyhook::MidHookFn backend_detour =
+                    stats_lease.mid_slot >= 0 ? s_mid_stats_thunks[static_cast<std::size_t>(stats_lease.mid_slot)]
+                                              : to_backend_detour(detour);
+#else
+                const safetyhook::MidHookFn backend_detour = to_backend_detour(detour);
+#endif
                 // Store the reserved ledger id in the Impl (see inline_at_raw). make_unique, the gate allocation, and
                 // the info log are the only steps that can throw under OOM; the catch below rolls the reservation back
                 // and `impl` (if built) unwinds to restore the prologue.
-                auto impl = std::make_unique<Hook::Impl>(std::move(backend_hook), std::move(request.name), target,
-                                                         ledger_id, state);
+                std::unique_ptr<Hook::Impl> impl;
+                if (request.options.capture.is_full())
+                {
+                    auto created = safetyhook::MidHook::create(allocator, reinterpret_cast<void *>(target),
+                                                               backend_detour, safetyhook::MidHook::Default);
+                    if (!created)
+                    {
+                        log().error("hook::mid_at: backend create failed for '{}' at {}: {}", request.name,
+                                    Address{target}, backend_error_string(created.error()));
+                        (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
+                        return std::unexpected(Error{ErrorCode::BackendFailed, "hook::mid_at", target});
+                    }
+                    auto backend_hook = std::move(created.value());
+                    const HookState state = backend_hook.enabled() ? HookState::Active : HookState::Disabled;
+                    impl = std::make_unique<Hook::Impl>(std::move(backend_hook), std::move(request.name), target,
+                                                        ledger_id, state);
+                }
+                else
+                {
+                    Result<LiteMidHook> created = create_lite_mid_hook(
+                        allocator, target, backend_detour, request.options.capture.xmm_mask, request.name);
+                    if (!created)
+                    {
+                        (void)DetourModKit::detail::HookLedger::instance().release_hook(target, ledger_id);
+                        return std::unexpected(created.error());
+                    }
+                    impl = std::make_unique<Hook::Impl>(std::move(*created), std::move(request.name), target,
+                                                        ledger_id, HookState::Active);
+                }
+#ifdef DMK_ENABLE_HOOK_STATS
+                impl->stats_lease = std::move(stats_lease);
+#endif
                 // A mid hook has no callable original, so its gate stays null-callable (a guarded call() returns the
                 // inactive default); it still carries the gate so enable/disable/teardown serialize through it.
-                auto gate = std::make_shared<Hook::CallGate>();
+                std::unique_ptr<Hook::CallGate, Hook::CallGate::Recycler> gate{Hook::CallGate::acquire()};
                 const std::string_view created_name = impl->name;
-                log().info("hook::mid_at: created mid hook '{}' at {}.", created_name, format::format_address(target));
+                log().info("hook::mid_at: created mid hook '{}' at {}.", created_name, Address{target});
                 DetourModKit::detail::HookLedger::instance().commit_hook(target, ledger_id);
                 emit_lifecycle(created_name, ledger_id, diagnostics::HookKind::Mid,
                                diagnostics::HookTransition::Created);
                 // The module reference was taken before SafetyHook patched the target; hand it to the Impl only after
                 // every fallible setup step has completed.
                 impl->self_ref = self_ref.release();
-                return Hook(std::move(impl), std::move(gate));
+                return Hook(std::move(impl), gate.release());
             }
             catch (const std::bad_alloc &)
             {
@@ -1271,63 +2229,223 @@ namespace DetourModKit
             }
         }
 
-        Result<std::vector<InstallOutcome>> install_all(std::span<const HookSpec> table) noexcept
+        Result<std::vector<InstallOutcome>> install_all(std::span<const HookSpec> table, std::stop_token stop) noexcept
+        {
+            try
+            {
+                std::vector<InstallOutcome> outcomes(table.size());
+                // On failure the span overload has already uninstalled every row newest-first, so dropping the vector
+                // here tears nothing down.
+                if (Result<void> installed = install_all(table, outcomes, std::move(stop)); !installed)
+                {
+                    return std::unexpected(installed.error());
+                }
+                return outcomes;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::install_all"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::UnknownError, "hook::install_all"});
+            }
+        }
+
+        Result<void> install_all(std::span<const HookSpec> table, std::span<InstallOutcome> out,
+                                 std::stop_token stop) noexcept
         {
-            // Roll back a partially-built install newest-first. A std::vector<InstallOutcome> does not provide that
-            // teardown contract, which matters when hooks are layered on one target: restoring an older hook before a
-            // newer hook can rewrite the prologue underneath the newer hook's live trampoline. This guard owns the
-            // teardown order for both failure paths -- the mandatory-miss early return and an exception (a bad_alloc
-            // copying a row's scan request or growing the vector) unwinding the loop -- by popping from the back in
-            // its destructor, unless the rows were committed out to the caller on success.
+            // Roll back a partially-filled install newest-first. Letting the caller's slots (or a
+            // std::vector<InstallOutcome>) tear down does not provide that order, which matters when hooks are layered
+            // on one target: restoring an older hook before a newer hook can rewrite the prologue underneath the newer
+            // hook's live trampoline. This guard owns the teardown order for both failure paths -- the mandatory-miss
+            // early return and an exception (a bad_alloc copying a row's scan request or name) unwinding the loop --
+            // by resetting the filled slots from the back in its destructor, unless they were committed on success.
             class InstallRollback
             {
             public:
-                InstallRollback() = default;
+                explicit InstallRollback(std::span<InstallOutcome> rows) noexcept : m_rows(rows) {}
                 InstallRollback(const InstallRollback &) = delete;
                 InstallRollback &operator=(const InstallRollback &) = delete;
                 ~InstallRollback()
                 {
-                    while (!m_rows.empty())
+                    if (m_committed)
                     {
-                        m_rows.pop_back();
+                        return;
+                    }
+                    while (m_filled > 0)
+                    {
+                        m_rows[--m_filled].hook = std::unexpected(m_error);
                     }
                 }
 
-                [[nodiscard]] std::vector<InstallOutcome> &rows() noexcept { return m_rows; }
-                [[nodiscard]] std::vector<InstallOutcome> commit() noexcept { return std::move(m_rows); }
+                // The next slot, counted as filled before the caller writes it so a throw mid-write still resets it.
+                [[nodiscard]] InstallOutcome &next() noexcept { return m_rows[m_filled++]; }
+                // The error the rolled-back slots are left holding.
+                void fail(const Error &error) noexcept { m_error = error; }
+                void commit() noexcept { m_committed = true; }
 
             private:
-                std::vector<InstallOutcome> m_rows;
+                std::span<InstallOutcome> m_rows;
+                std::size_t m_filled = 0;
+                Error m_error{ErrorCode::OutOfMemory, "hook::install_all"};
+                bool m_committed = false;
             };
 
+            if (out.size() < table.size())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "hook::install_all", out.size()});
+            }
             try
             {
-                InstallRollback rollback;
-                rollback.rows().reserve(table.size());
-                for (const HookSpec &spec : table)
+                // Resolve every scan row before patching anything, in one scan::resolve_batch pass: the rows share
+                // the batch's single prescan of the image and its worker pool instead of scanning back to back, each
+                // sees the image before any row of this table rewrote a prologue, and a mandatory miss fails the call
+                // before a single patch is written, so there is nothing to roll back for it. The patches themselves
+                // stay one per row: the backend never suspends threads (each install revokes execute access on the
+                // patched pages and lets its vectored handler move a thread that faults there), so there is no
+                // stop-the-world window to share across rows.
+                // The first Mandatory miss sinks the call, so it cancels the rest of the batch rather than letting
+                // the other rows finish scans whose answers would be thrown away.
+                std::vector<scan::ScanRequest> requests;
+                requests.reserve(table.size());
+                const auto mandatory = std::make_unique<bool[]>(table.size());
+                for (std::size_t i = 0; i < table.size(); ++i)
+                {
+                    requests.push_back(table[i].m_target.view());
+                    mandatory[i] = table[i].m_severity == Severity::Mandatory;
+                }
+                std::vector<Result<scan::Hit>> resolved(table.size());
+                if (!requests.empty())
+                {
+                    const scan::BatchOptions options{.stop = stop,
+                                                     .fail_fast = true,
+                                                     .mandatory = std::span<const bool>(mandatory.get(), table.size())};
+                    if (Result<void> batch = scan::resolve_batch(requests, resolved, options); !batch)
+                    {
+                        return std::unexpected(batch.error());
+                    }
+                }
+                // Report the miss that tripped the batch, not a sibling it cancelled.
+                const Result<scan::Hit> *mandatory_miss = nullptr;
+                for (std::size_t i = 0; i < table.size(); ++i)
+                {
+                    if (!resolved[i] && mandatory[i] &&
+                        (mandatory_miss == nullptr || mandatory_miss->error().code == ErrorCode::Cancelled))
+                    {
+                        mandatory_miss = &resolved[i];
+                    }
+                }
+                if (mandatory_miss != nullptr)
+                {
+                    return std::unexpected(mandatory_miss->error());
+                }
+
+                // Pre-flight every resolved row before the first patch, on the fork-join pool: the decodes and
+                // fault-guarded reads are independent per row, and a row they refuse would otherwise be found only
+                // when the loop below reached it, with the rows before it already patched and then rolled back. A
+                // refused Mandatory row fails the call here; a refused BestEffort row is reported and skipped.
+                std::vector<TablePreflightRow> rows;
+                std::vector<std::size_t> row_of;
+                rows.reserve(table.size());
+                row_of.reserve(table.size());
+                for (std::size_t i = 0; i < table.size(); ++i)
+                {
+                    if (resolved[i])
+                    {
+                        rows.push_back(TablePreflightRow{resolved[i]->address.raw(), table[i].m_options});
+                        row_of.push_back(i);
+                    }
+                }
+                std::vector<Result<void>> preflights(rows.size());
+                DetourModKit::detail::run_fork_join_into<TablePreflightRow, Result<void>>(
+                    rows, preflights, 0, [](const TablePreflightRow &row) noexcept { return preflight_table_row(row); },
+                    [](const TablePreflightRow &row) noexcept -> Result<void>
+                    { return std::unexpected(Error{ErrorCode::UnknownError, "hook::install_all", row.address}); });
+                for (std::size_t k = 0; k < rows.size(); ++k)
+                {
+                    const std::size_t i = row_of[k];
+                    if (!preflights[k])
+                    {
+                        if (mandatory[i])
+                        {
+                            return std::unexpected(preflights[k].error());
+                        }
+                        resolved[i] = std::unexpected(preflights[k].error());
+                    }
+                }
+
+                // Make room for the table's trampolines before the first patch, one reservation per module the rows
+                // land in, so the installs below carve from it rather than each growing the backend pool on its own.
+                // Best-effort: a failed reservation only leaves each install to allocate for itself.
+                std::vector<std::pair<std::uintptr_t, std::size_t>> modules; // allocation base, rows landing in it
+                for (const Result<scan::Hit> &hit : resolved)
+                {
+                    if (!hit)
+                    {
+                        continue;
+                    }
+                    const std::uintptr_t base = allocation_base_of(hit->address.raw());
+                    const auto it = std::find_if(modules.begin(), modules.end(),
+                                                 [base](const auto &entry) { return entry.first == base; });
+                    if (it == modules.end())
+                    {
+                        modules.emplace_back(base, 1);
+                    }
+                    else
+                    {
+                        ++it->second;
+                    }
+                }
+                for (const auto &[base, rows] : modules)
+                {
+                    (void)reserve_trampolines(Address{base}, rows);
+                }
+
+                InstallRollback rollback(out);
+                for (std::size_t i = 0; i < table.size(); ++i)
                 {
-                    // Build the per-row request from the spec. The OwnedScanRequest is copied so install_all never
-                    // moves out of the caller's (possibly const) table; the row's own Options carry its install policy
+                    if (stop.stop_requested())
+                    {
+                        // A stop between installs takes the table back off, as a Mandatory failure would.
+                        const Error cancelled{ErrorCode::Cancelled, "hook::install_all"};
+                        rollback.fail(cancelled);
+                        return std::unexpected(cancelled);
+                    }
+                    const HookSpec &spec = table[i];
+                    InstallOutcome &slot = rollback.next();
+                    slot.name.assign(spec.m_name);
+                    slot.severity = spec.m_severity;
+                    if (!resolved[i])
+                    {
+                        // A best-effort miss or pre-flight refusal: report its error in the row exactly as a per-row
+                        // install would.
+                        slot.hook = std::unexpected(resolved[i].error());
+                        continue;
+                    }
+                    // Install the row at its resolved address. The row's own Options carry its install policy
                     // (Prologue escalation, fail_if_already_hooked) so a declarative table sets per-row policy without
                     // an out-of-band install call.
-                    Target target = spec.m_target;
+                    const Target target{resolved[i]->address};
                     Result<Hook> installed =
                         std::holds_alternative<InlineDetour>(spec.m_detour)
-                            ? detail::inline_at_raw(InlineRequest{spec.m_name, std::move(target), spec.m_options},
+                            ? detail::inline_at_raw(InlineRequest{spec.m_name, target, spec.m_options},
                                                     std::get<InlineDetour>(spec.m_detour).fn)
-                            : mid_at(MidRequest{spec.m_name, std::move(target), spec.m_options},
+                            : mid_at(MidRequest{spec.m_name, target, spec.m_options},
                                      std::get<MidHookFn>(spec.m_detour));
 
                     if (!installed && spec.m_severity == Severity::Mandatory)
                     {
                         // Fail fast: returning here runs ~InstallRollback, which unhooks every already-installed row
-                        // newest-first before the error propagates, so a mandatory miss rolls the whole table back
-                        // (in the safe order) rather than leaving a partial install.
+                        // newest-first before the error propagates, so a mandatory install failure rolls the whole
+                        // table back (in the safe order) rather than leaving a partial install.
+                        rollback.fail(installed.error());
                         return std::unexpected(installed.error());
                     }
-                    rollback.rows().push_back(InstallOutcome{spec.m_name, spec.m_severity, std::move(installed)});
+                    slot.hook = std::move(installed);
                 }
-                return rollback.commit();
+                rollback.commit();
+                return {};
             }
             catch (const std::bad_alloc &)
             {
@@ -1344,6 +2462,51 @@ namespace DetourModKit
             return DetourModKit::detail::HookLedger::instance().is_target_hooked(target.raw());
         }
 
+        // NOLINTNEXTLINE(bugprone-exception-escape): the only throwing step (the backend allocation) is caught below
+        Result<void> reserve_trampolines(Address site, std::size_t hooks) noexcept
+        {
+            if (!site)
+            {
+                return std::unexpected(Error{ErrorCode::NullTargetAddress, "hook::reserve_trampolines"});
+            }
+            if (hooks == 0)
+            {
+                return {};
+            }
+            if (hooks > std::numeric_limits<std::size_t>::max() / TRAMPOLINE_BUDGET_BYTES)
+            {
+                return std::unexpected(Error{ErrorCode::SizeTooLarge, "hook::reserve_trampolines"});
+            }
+            const std::shared_ptr<safetyhook::Allocator> &allocator = backend_allocator();
+            if (!allocator)
+            {
+                return std::unexpected(Error{ErrorCode::AllocatorNotAvailable, "hook::reserve_trampolines"});
+            }
+            try
+            {
+                // The allocation is dropped at the end of this scope. The backend frees it into the owning region's
+                // free list and keeps the region itself mapped, which is the whole point: the reservation outlives
+                // this call as pooled space near site.
+                auto slab = allocator->allocate_near({reinterpret_cast<std::uint8_t *>(site.raw())},
+                                                     hooks * TRAMPOLINE_BUDGET_BYTES);
+                if (!slab)
+                {
+                    log().warning("hook::reserve_trampolines: no {} bytes free within reach of {} (error {}).",
+                                  hooks * TRAMPOLINE_BUDGET_BYTES, site, static_cast<int>(slab.error()));
+                    return std::unexpected(Error{ErrorCode::BackendFailed, "hook::reserve_trampolines", site.raw()});
+                }
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::reserve_trampolines"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::UnknownError, "hook::reserve_trampolines"});
+            }
+            return {};
+        }
+
         // VmtHook -- RAII handle for a cloned vtable (object-level clone lifecycle).
         VmtHook::VmtHook(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
 
@@ -1498,8 +2661,7 @@ namespace DetourModKit
                     "hook::vmt_apply: applying VMT hook '{}' onto object {} whose vptr {} is already a clone owned by "
                     "another DMK VMT hook; that clone's hooked slots will be captured as this hook's original. Set "
                     "VmtOptions::fail_if_already_hooked to refuse instead.",
-                    std::string_view{m_impl->name}, format::format_address(reinterpret_cast<std::uintptr_t>(object)),
-                    format::format_address(*current_vptr));
+                    std::string_view{m_impl->name}, Address{object}, Address{*current_vptr});
             }
             // The backend tracks the applied object in an internal container, so apply can throw bad_alloc; contain it
             // so a failed apply returns an Error instead of unwinding out of the handle method.
@@ -1519,6 +2681,120 @@ namespace DetourModKit
             return {};
         }
 
+        Result<std::size_t> VmtHook::apply_to_many(std::span<void *const> objects)
+        {
+            if (!m_impl)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidHookState, "hook::vmt_apply_many"});
+            }
+            if (objects.empty())
+            {
+                return 0;
+            }
+            try
+            {
+                // Address order carries no meaning for a batch but buys two things: duplicates become adjacent, and
+                // objects that share a memory region arrive together, so one VirtualQuery covers the whole run.
+                std::vector<std::uintptr_t> sorted;
+                sorted.reserve(objects.size());
+                for (void *const object : objects)
+                {
+                    sorted.push_back(reinterpret_cast<std::uintptr_t>(object));
+                }
+                std::sort(sorted.begin(), sorted.end());
+                sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+                std::unique_lock<std::mutex> object_gate = acquire_vmt_object_lock();
+                if (!object_gate.owns_lock())
+                {
+                    return std::unexpected(Error{ErrorCode::UnknownError, "hook::vmt_apply_many"});
+                }
+                // One exclusive write for the whole batch, as apply_to takes per object: the validation and the swaps
+                // are one step against an original() snapshot reader and against vptr transitions on other handles.
+                std::unique_lock<DetourModKit::detail::SrwSharedMutex> gate(m_impl->method_mutex);
+
+                // Validate every object before writing a single vptr, so a bad entry fails the batch with nothing to
+                // undo. An 8-aligned vptr cannot straddle a page, so the region check on its first byte covers it.
+                constexpr DWORD WRITABLE = PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE |
+                                           PAGE_EXECUTE_WRITECOPY;
+                std::uintptr_t region_begin = 0;
+                std::uintptr_t region_end = 0;
+                bool region_writable = false;
+                std::vector<void *> pending;
+                pending.reserve(sorted.size());
+                for (const std::uintptr_t address : sorted)
+                {
+                    if (address == 0 || address % alignof(std::uintptr_t) != 0)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidObject, "hook::vmt_apply_many", address});
+                    }
+                    if (address < region_begin || address >= region_end)
+                    {
+                        MEMORY_BASIC_INFORMATION info{};
+                        if (VirtualQuery(reinterpret_cast<const void *>(address), &info, sizeof(info)) == 0)
+                        {
+                            return std::unexpected(Error{ErrorCode::InvalidObject, "hook::vmt_apply_many", address});
+                        }
+                        region_begin = reinterpret_cast<std::uintptr_t>(info.BaseAddress);
+                        region_end = region_begin + info.RegionSize;
+                        region_writable = info.State == MEM_COMMIT && (info.Protect & WRITABLE) != 0 &&
+                                          (info.Protect & (PAGE_GUARD | PAGE_NOACCESS)) == 0;
+                    }
+                    if (!region_writable)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidObject, "hook::vmt_apply_many", address});
+                    }
+                    const std::optional<std::uintptr_t> vptr =
+                        DetourModKit::detail::guarded_read<std::uintptr_t>(address);
+                    if (!vptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidObject, "hook::vmt_apply_many", address});
+                    }
+                    if (*vptr == m_impl->cloned_vptr_base)
+                    {
+                        continue;
+                    }
+                    if (*vptr != m_impl->source_vptr || m_impl->source_vptr == 0)
+                    {
+                        const ErrorCode code = DetourModKit::detail::HookLedger::instance().is_vmt_clone_base(*vptr)
+                                                   ? ErrorCode::HookAlreadyExists
+                                                   : ErrorCode::InvalidObject;
+                        return std::unexpected(Error{code, "hook::vmt_apply_many", *vptr});
+                    }
+                    pending.push_back(reinterpret_cast<void *>(address));
+                }
+
+                // Every object checked out; swap them. The backend records each object in a container, so an apply
+                // can throw bad_alloc: take the batch back off the clone so the call stays all or nothing.
+                std::size_t applied = 0;
+                try
+                {
+                    for (void *const object : pending)
+                    {
+                        m_impl->backend.apply(object);
+                        ++applied;
+                    }
+                }
+                catch (...)
+                {
+                    while (applied > 0)
+                    {
+                        m_impl->backend.remove(pending[--applied]);
+                    }
+                    throw;
+                }
+                return pending.size();
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::vmt_apply_many"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::BackendFailed, "hook::vmt_apply_many"});
+            }
+        }
+
         Result<void> VmtHook::remove_from(void *object)
         {
             if (!m_impl)
@@ -1743,8 +3019,7 @@ namespace DetourModKit
                     "hook::vmt_for: cloning object {} for VMT hook '{}' whose vptr {} is already a clone owned by "
                     "another DMK VMT hook; that clone's hooked slots will be captured as this hook's original. Set "
                     "VmtOptions::fail_if_already_hooked to refuse instead.",
-                    format::format_address(reinterpret_cast<std::uintptr_t>(object)), std::string_view{name},
-                    format::format_address(*current_vptr));
+                    Address{object}, std::string_view{name}, Address{*current_vptr});
             }
             const std::optional<std::size_t> method_count = count_vmt_method_slots(object);
             if (!method_count)
@@ -1796,6 +3071,7 @@ namespace DetourModKit
                     return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::vmt_for"});
                 }
                 impl->ledger_id = *recorded;
+                impl->source_vptr = current_vptr.value_or(0);
                 // The object gate has served its purpose (the check / vptr swap / ledger record are now one ordered
                 // step). Release it BEFORE the create log and the lifecycle event: emit_lifecycle runs arbitrary
                 // subscriber code, which must not execute while the process-wide VMT mutex is held (CP.22 -- never call
@@ -1809,8 +3085,7 @@ namespace DetourModKit
                 // post-commit logs in hook_method_raw / remove_method).
                 try
                 {
-                    log().info("hook::vmt_for: created VMT hook '{}' on object {}.", created_name,
-                               format::format_address(reinterpret_cast<std::uintptr_t>(object)));
+                    log().info("hook::vmt_for: created VMT hook '{}' on object {}.", created_name, Address{object});
                 }
                 catch (...)
                 {
@@ -0,0 +1,96 @@
+/**
+ * @file hook_mux.cpp
+ * @brief The multiplexer's copy-on-write handler list: registration, removal, and snapshot reclamation.
+ * @details Every change copies the live snapshot under the writer mutex, edits the copy, and publishes it with a
+ *          seq_cst exchange. The replaced snapshot is retired under a fresh emit epoch and freed once no detour that
+ *          could have loaded it is still announced, the same scheme EventDispatcher uses for its handler lists.
+ */
+
+#include "DetourModKit/hook_mux.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace hook
+    {
+        namespace detail
+        {
+            MuxCore::~MuxCore() noexcept
+            {
+                delete m_snapshot.load(std::memory_order_acquire);
+            }
+
+            Result<MuxHandlerId> MuxCore::add(MuxPhase phase, void *fn) noexcept
+            {
+                try
+                {
+                    std::lock_guard<std::mutex> lock(m_writer);
+                    const MuxSnapshot *live = m_snapshot.load(std::memory_order_relaxed);
+                    auto next =
+                        live != nullptr ? std::make_unique<MuxSnapshot>(*live) : std::make_unique<MuxSnapshot>();
+                    const MuxHandlerId id = m_next_id;
+                    (phase == MuxPhase::Pre ? next->pre : next->post).push_back(MuxEntry{fn, id});
+                    m_retired.reserve_one();
+                    ++m_next_id;
+                    publish_locked(next.release());
+                    return id;
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::Multiplexer::add"});
+                }
+                catch (...)
+                {
+                    return std::unexpected(Error{ErrorCode::UnknownError, "hook::Multiplexer::add"});
+                }
+            }
+
+            Result<void> MuxCore::remove(MuxHandlerId id) noexcept
+            {
+                try
+                {
+                    std::lock_guard<std::mutex> lock(m_writer);
+                    const MuxSnapshot *live = m_snapshot.load(std::memory_order_relaxed);
+                    const auto matches = [id](const MuxEntry &entry) { return entry.id == id; };
+                    if (live == nullptr ||
+                        (std::none_of(live->pre.begin(), live->pre.end(), matches) &&
+                         std::none_of(live->post.begin(), live->post.end(), matches)))
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidArg, "hook::Multiplexer::remove"});
+                    }
+                    auto next = std::make_unique<MuxSnapshot>(*live);
+                    std::erase_if(next->pre, matches);
+                    std::erase_if(next->post, matches);
+                    m_retired.reserve_one();
+                    publish_locked(next.release());
+                    return {};
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::Multiplexer::remove"});
+                }
+                catch (...)
+                {
+                    return std::unexpected(Error{ErrorCode::UnknownError, "hook::Multiplexer::remove"});
+                }
+            }
+
+            void MuxCore::publish_locked(const MuxSnapshot *next) noexcept
+            {
+                // The snapshot goes out before the count, so a detour that reads a non-zero count always finds one.
+                const MuxSnapshot *previous = m_snapshot.exchange(next, std::memory_order_seq_cst);
+                m_handler_count.store(next->pre.size() + next->post.size(), std::memory_order_release);
+                if (previous != nullptr)
+                {
+                    m_retired.retire(previous);
+                }
+            }
+        } // namespace detail
+    } // namespace hook
+} // namespace DetourModKit
@@ -0,0 +1,241 @@
+/**
+ * @file hook_vmt_shared.cpp
+ * @brief Shared VMT clones: one cloned vtable per (original vtable, method set), reference-counted by its objects.
+ * @details A small process-wide registry holds a weak reference to every live clone, keyed by the vtable the seed
+ *          object carried and the sorted method set installed on it. A lookup that finds a live clone puts the new
+ *          object on it with VmtHook::apply_to; a miss builds the clone through vmt_for + hook_method outside the
+ *          registry lock (both take the module reference and the VMT object gate, which must never nest under another
+ *          kit lock) and registers it afterwards. A clone is destroyed when its last handle drops, and its registry
+ *          slot is swept on the next lookup.
+ */
+
+#include "DetourModKit/hook.hpp"
+
+#include "internal/memory_guarded.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace hook
+    {
+        struct detail::SharedVmtClone
+        {
+            SharedVmtClone(VmtHook clone_hook, std::uintptr_t original, std::uintptr_t cloned,
+                           std::vector<VmtMethod> set)
+                : hook(std::move(clone_hook)), original_vtable(original), clone_vtable(cloned), methods(std::move(set))
+            {
+            }
+
+            VmtHook hook;
+            std::uintptr_t original_vtable;
+            std::uintptr_t clone_vtable;
+            std::vector<VmtMethod> methods;
+        };
+
+        namespace
+        {
+            using GenericMethod = void (*)();
+
+            // Only vmt_shared touches the registry; a handle's teardown never does, so a handle dropped during static
+            // destruction does not depend on the registry outliving it.
+            struct SharedVmtRegistry
+            {
+                std::mutex mutex;
+                std::vector<std::weak_ptr<detail::SharedVmtClone>> clones;
+            };
+
+            SharedVmtRegistry &shared_vmt_registry()
+            {
+                static SharedVmtRegistry registry;
+                return registry;
+            }
+
+            [[nodiscard]] bool same_methods(std::span<const VmtMethod> a, std::span<const VmtMethod> b) noexcept
+            {
+                return std::equal(a.begin(), a.end(), b.begin(), b.end(),
+                                  [](const VmtMethod &x, const VmtMethod &y)
+                                  { return x.index == y.index && x.detour == y.detour; });
+            }
+
+            // Finds a live clone for @p object's current vptr, sweeping expired slots on the way. An object whose vptr
+            // is already some shared clone's table reports it through @p already_shared.
+            [[nodiscard]] std::shared_ptr<detail::SharedVmtClone>
+            find_clone(SharedVmtRegistry &registry, std::uintptr_t vptr, std::span<const VmtMethod> methods,
+                       bool &already_shared)
+            {
+                std::shared_ptr<detail::SharedVmtClone> found;
+                std::erase_if(registry.clones,
+                              [&](const std::weak_ptr<detail::SharedVmtClone> &weak)
+                              {
+                                  std::shared_ptr<detail::SharedVmtClone> live = weak.lock();
+                                  if (!live)
+                                  {
+                                      return true;
+                                  }
+                                  if (live->clone_vtable == vptr)
+                                  {
+                                      already_shared = true;
+                                  }
+                                  else if (!found && live->original_vtable == vptr &&
+                                           same_methods(live->methods, methods))
+                                  {
+                                      found = std::move(live);
+                                  }
+                                  return false;
+                              });
+                return found;
+            }
+        } // namespace
+
+        SharedVmtHook::SharedVmtHook(std::shared_ptr<detail::SharedVmtClone> clone, void *object) noexcept
+            : m_clone(std::move(clone)), m_object(object)
+        {
+        }
+
+        SharedVmtHook::SharedVmtHook(SharedVmtHook &&other) noexcept
+            : m_clone(std::move(other.m_clone)), m_object(std::exchange(other.m_object, nullptr))
+        {
+        }
+
+        SharedVmtHook &SharedVmtHook::operator=(SharedVmtHook &&other) noexcept
+        {
+            if (this != &other)
+            {
+                SharedVmtHook dropped(std::move(*this));
+                m_clone = std::move(other.m_clone);
+                m_object = std::exchange(other.m_object, nullptr);
+            }
+            return *this;
+        }
+
+        SharedVmtHook::~SharedVmtHook() noexcept
+        {
+            if (!m_clone)
+            {
+                return;
+            }
+            // Restore first, then drop the reference; the last one destroys the VmtHook, whose teardown takes the VMT
+            // object gate itself, so no registry lock is held across it.
+            (void)m_clone->hook.remove_from(m_object);
+            m_clone.reset();
+        }
+
+        SharedVmtHook::operator bool() const noexcept
+        {
+            return m_clone != nullptr;
+        }
+
+        std::size_t SharedVmtHook::share_count() const noexcept
+        {
+            return m_clone ? static_cast<std::size_t>(m_clone.use_count()) : 0;
+        }
+
+        void *SharedVmtHook::method_original_address(std::size_t index) const noexcept
+        {
+            if (!m_clone)
+            {
+                return nullptr;
+            }
+            return reinterpret_cast<void *>(m_clone->hook.original<GenericMethod>(index));
+        }
+
+        Result<SharedVmtHook> vmt_shared(std::string name, void *object, std::span<const VmtMethod> methods,
+                                         VmtOptions options)
+        {
+            if (name.empty() || methods.empty())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "hook::vmt_shared"});
+            }
+            if (object == nullptr)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidObject, "hook::vmt_shared"});
+            }
+            try
+            {
+                std::vector<VmtMethod> sorted(methods.begin(), methods.end());
+                std::sort(sorted.begin(), sorted.end(),
+                          [](const VmtMethod &a, const VmtMethod &b) { return a.index < b.index; });
+                for (std::size_t i = 0; i < sorted.size(); ++i)
+                {
+                    if (sorted[i].detour == nullptr || (i > 0 && sorted[i].index == sorted[i - 1].index))
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidArg, "hook::vmt_shared", sorted[i].index});
+                    }
+                }
+
+                std::uintptr_t vptr = 0;
+                if (!DetourModKit::detail::guarded_read_bytes(reinterpret_cast<std::uintptr_t>(object), &vptr,
+                                                               sizeof(vptr)))
+                {
+                    return std::unexpected(
+                        Error{ErrorCode::InvalidObject, "hook::vmt_shared", reinterpret_cast<std::uintptr_t>(object)});
+                }
+
+                SharedVmtRegistry &registry = shared_vmt_registry();
+                std::shared_ptr<detail::SharedVmtClone> clone;
+                {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    bool already_shared = false;
+                    clone = find_clone(registry, vptr, sorted, already_shared);
+                    if (already_shared)
+                    {
+                        return std::unexpected(Error{ErrorCode::HookAlreadyExists, "hook::vmt_shared", vptr});
+                    }
+                }
+                if (clone)
+                {
+                    Result<void> applied = clone->hook.apply_to(object, options);
+                    if (!applied)
+                    {
+                        return std::unexpected(applied.error());
+                    }
+                    return SharedVmtHook(std::move(clone), object);
+                }
+
+                Result<VmtHook> created = vmt_for(std::move(name), object, options);
+                if (!created)
+                {
+                    return std::unexpected(created.error());
+                }
+                for (const VmtMethod &method : sorted)
+                {
+                    Result<void> hooked =
+                        created->hook_method(method.index, reinterpret_cast<GenericMethod>(method.detour));
+                    if (!hooked)
+                    {
+                        return std::unexpected(hooked.error());
+                    }
+                }
+                std::uintptr_t clone_vtable = 0;
+                (void)DetourModKit::detail::guarded_read_bytes(reinterpret_cast<std::uintptr_t>(object), &clone_vtable,
+                                                               sizeof(clone_vtable));
+                clone = std::make_shared<detail::SharedVmtClone>(std::move(*created), vptr, clone_vtable,
+                                                               std::move(sorted));
+                {
+                    std::lock_guard<std::mutex> lock(registry.mutex);
+                    registry.clones.push_back(clone);
+                }
+                return SharedVmtHook(std::move(clone), object);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "hook::vmt_shared"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::UnknownError, "hook::vmt_shared"});
+            }
+        }
+    } // namespace hook
+} // namespace DetourModKit
@@ -15,6 +15,7 @@
 #include "platform.hpp"
 #include "internal/input_binding_gate.hpp"
 #include "internal/input_poller.hpp"
+#include "internal/subsystem_usage.hpp"
 
 #include <algorithm>
 #include <atomic>
@@ -359,6 +360,7 @@ namespace DetourModKit
                         m_impl->m_pending.reserve(m_impl->m_pending.size() + entries.size());
                         for (auto &entry : entries)
                         {
+                            detail::mark_subsystem_used(detail::Subsystem::Input);
                             m_impl->m_pending.push_back(std::move(entry));
                         }
                         return BindingGuard{std::move(impl)};
@@ -400,7 +402,7 @@ namespace DetourModKit
 
                 if (m_impl->m_poller)
                 {
-                    log().debug("input::Input: start() called while already running; no-op.");
+                    log().debug(log_category::input, "input::Input: start() called while already running; no-op.");
                     return {};
                 }
 
@@ -414,11 +416,11 @@ namespace DetourModKit
                 }
 
                 Logger &logger = log();
-                logger.info("input::Input: Starting with {} binding(s), poll interval {}ms", m_impl->m_pending.size(),
-                            settings.poll_interval.count());
+                logger.info("input::Input: Starting with {} binding(s), poll interval {}ms, {} backend",
+                            m_impl->m_pending.size(), settings.poll_interval.count(), to_string(settings.backend));
                 for (const auto &binding : m_impl->m_pending)
                 {
-                    logger.trace("input::Input: Registered {} binding \"{}\" with {} key(s)",
+                    logger.trace(log_category::input, "input::Input: Registered {} binding \"{}\" with {} key(s)",
                                  to_string(binding.trigger), binding.name, binding.keys.size());
                 }
 
@@ -430,7 +432,17 @@ namespace DetourModKit
                 // path.
                 auto poller = std::make_shared<detail::InputPoller>(
                     m_impl->m_pending, settings.poll_interval, settings.require_focus, settings.gamepad_index,
-                    settings.trigger_threshold, settings.stick_threshold);
+                    settings.trigger_threshold, settings.stick_threshold, settings.backend);
+                if (settings.adaptive_polling)
+                {
+                    poller->set_adaptive_polling(settings.idle_poll_interval, settings.adaptive_quiet_timeout);
+                }
+                poller->set_latency_stats(settings.latency_stats);
+                if (!poller->set_event_queue(settings.event_queue_capacity))
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, "input::start"});
+                }
+                detail::mark_subsystem_used(detail::Subsystem::Input);
                 poller->start();
                 m_impl->m_pending.clear();
                 m_impl->m_poller = poller;
@@ -521,6 +533,42 @@ namespace DetourModKit
             return live_poller->binding_count();
         }
 
+        InputSnapshot Input::snapshot() const noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->snapshot() : InputSnapshot{};
+        }
+
+        GamepadSnapshot Input::gamepad_snapshot() const noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->gamepad_snapshot() : GamepadSnapshot{};
+        }
+
+        std::size_t Input::drain_events(std::span<InputEvent> out) noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->drain_events(out) : 0;
+        }
+
+        std::uint64_t Input::dropped_events() const noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->dropped_events() : 0;
+        }
+
+        InputLatencyStats Input::latency_stats() const noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->latency_stats() : InputLatencyStats{};
+        }
+
+        PollCadenceStats Input::poll_cadence_stats() const noexcept
+        {
+            auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
+            return active_poller ? active_poller->cadence_stats() : PollCadenceStats{};
+        }
+
         bool Input::is_active(std::string_view name) const noexcept
         {
             auto active_poller = m_impl->m_active.load(std::memory_order_acquire);
@@ -571,8 +619,8 @@ namespace DetourModKit
                     if (indices.empty())
                     {
                         lock.unlock();
-                        (void)log().try_log(LogLevel::Debug, "input::Input: rebind(\"{}\") ignored: name not found",
-                                            name);
+                        (void)log().try_log(log_category::input, LogLevel::Debug,
+                                            "input::Input: rebind(\"{}\") ignored: name not found", name);
                         return std::unexpected(Error{ErrorCode::InvalidArg, "input::rebind"});
                     }
 
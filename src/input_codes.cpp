@@ -10,7 +10,9 @@
 #include "DetourModKit/format.hpp"
 
 #include <algorithm>
+#include <array>
 #include <charconv>
+#include <cstdint>
 #include <limits>
 #include <unordered_map>
 
@@ -213,7 +215,7 @@ namespace DetourModKit
 
         constexpr size_t NAME_TABLE_SIZE = sizeof(NAME_TABLE) / sizeof(NAME_TABLE[0]);
 
-        int icompare(std::string_view a, std::string_view b) noexcept
+        constexpr int icompare(std::string_view a, std::string_view b) noexcept
         {
             // Branch-free ASCII case fold. The input-name and source tables are pure ASCII, so a locale-sensitive
             // std::tolower is both unnecessary and a portability hazard on this resolution path: under a non-invariant
@@ -306,27 +308,76 @@ namespace DetourModKit
             return InputCode{source, static_cast<int>(value)};
         }
 
-        struct SortedNameIndex
+        // Compile-time hash table over the case-folded names: FNV-1a of the folded bytes picks a slot and a taken slot
+        // probes linearly. 512 slots hold the ~155 names at a load factor under a third, so a lookup hashes the token
+        // once and compares against one or two entries, and nothing is sorted or allocated at first use. A slot holds
+        // a NAME_TABLE index plus one; zero marks it empty.
+        constexpr size_t NAME_HASH_SLOTS = 512;
+        static_assert((NAME_HASH_SLOTS & (NAME_HASH_SLOTS - 1)) == 0 && NAME_HASH_SLOTS >= 2 * NAME_TABLE_SIZE);
+
+        [[nodiscard]] constexpr size_t name_hash_slot(std::string_view name) noexcept
+        {
+            std::uint32_t hash = 2166136261u;
+            for (const char c : name)
+            {
+                const auto u = static_cast<unsigned char>(c);
+                hash = (hash ^ ((u >= 'A' && u <= 'Z') ? static_cast<unsigned char>(u + ('a' - 'A')) : u)) * 16777619u;
+            }
+            return static_cast<size_t>(hash) & (NAME_HASH_SLOTS - 1);
+        }
+
+        struct NameHashTable
         {
-            size_t indices[NAME_TABLE_SIZE]{};
-            size_t count = NAME_TABLE_SIZE;
+            std::array<std::uint16_t, NAME_HASH_SLOTS> slots{};
+            // Longest probe run any name needed; a lookup never walks further.
+            size_t max_probe = 0;
+            // Set when two names fold to the same text, which would make one of them unreachable.
+            bool duplicate = false;
+        };
 
-            SortedNameIndex()
+        consteval NameHashTable build_name_hash_table()
+        {
+            NameHashTable table;
+            for (size_t i = 0; i < NAME_TABLE_SIZE; ++i)
             {
-                for (size_t i = 0; i < NAME_TABLE_SIZE; ++i)
+                const std::string_view name = NAME_TABLE[i].name;
+                size_t slot = name_hash_slot(name);
+                size_t probe = 0;
+                while (table.slots[slot] != 0)
                 {
-                    indices[i] = i;
+                    table.duplicate |= icompare(NAME_TABLE[table.slots[slot] - 1].name, name) == 0;
+                    slot = (slot + 1) & (NAME_HASH_SLOTS - 1);
+                    ++probe;
                 }
-                std::sort(indices, indices + count,
-                          [](size_t a, size_t b) { return icompare(NAME_TABLE[a].name, NAME_TABLE[b].name) < 0; });
+                table.slots[slot] = static_cast<std::uint16_t>(i + 1);
+                table.max_probe = std::max(table.max_probe, probe);
             }
-        };
+            return table;
+        }
+
+        constexpr NameHashTable NAME_HASH = build_name_hash_table();
+        static_assert(!NAME_HASH.duplicate, "two input names fold to the same case-insensitive text");
+        static_assert(NAME_HASH.max_probe <= 8, "input name hash clusters; grow NAME_HASH_SLOTS");
 
-        const SortedNameIndex &get_sorted_index()
+        [[nodiscard]] constexpr const NameEntry *find_name(std::string_view name) noexcept
         {
-            static const SortedNameIndex instance;
-            return instance;
+            size_t slot = name_hash_slot(name);
+            for (size_t probe = 0; probe <= NAME_HASH.max_probe; ++probe)
+            {
+                const std::uint16_t entry = NAME_HASH.slots[slot];
+                if (entry == 0)
+                {
+                    return nullptr;
+                }
+                if (icompare(NAME_TABLE[entry - 1].name, name) == 0)
+                {
+                    return &NAME_TABLE[entry - 1];
+                }
+                slot = (slot + 1) & (NAME_HASH_SLOTS - 1);
+            }
+            return nullptr;
         }
+        static_assert(find_name("gamepad_dpadleft") != nullptr && find_name("NoSuchKey") == nullptr);
 
         struct CodeNameMap
         {
@@ -363,25 +414,9 @@ namespace DetourModKit
             }
         }
 
-        const auto &idx = get_sorted_index();
-        size_t lo = 0;
-        size_t hi = idx.count;
-        while (lo < hi)
+        if (const NameEntry *entry = find_name(name))
         {
-            const size_t mid = lo + (hi - lo) / 2;
-            const int cmp = icompare(NAME_TABLE[idx.indices[mid]].name, name);
-            if (cmp < 0)
-            {
-                lo = mid + 1;
-            }
-            else if (cmp > 0)
-            {
-                hi = mid;
-            }
-            else
-            {
-                return NAME_TABLE[idx.indices[mid]].code;
-            }
+            return entry->code;
         }
         return std::nullopt;
     }
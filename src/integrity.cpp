@@ -0,0 +1,409 @@
+/**
+ * @file integrity.cpp
+ * @brief The code monitor: the page hash kernel, the page table, the round-robin verify, and its worker.
+ * @details A watched range is split at page boundaries into one entry per page it touches; an entry keeps the
+ *          clipped span, the watch it belongs to, and the hash and read status of its last check. verify() walks the
+ *          entries from a cursor that wraps, copying each span through memory::read_into into a page-sized stack
+ *          buffer and hashing the copy, so a page that unmaps mid-check is a failed read rather than a fault.
+ *
+ *          Two mutexes: the table mutex guards the entries, labels and cursor and is held only while they are read or
+ *          changed; the verify mutex serializes whole verify() calls, including the emit, so the reusable event
+ *          buffer is never shared. Handlers therefore run with only the verify mutex held, and watch() and
+ *          rebaseline() never take it.
+ */
+
+#include "DetourModKit/integrity.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "internal/thunk_cache.hpp"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+// The AVX2 hash kernel, compiled with a target attribute on GCC/Clang (as in watch_set.cpp) so the rest of the TU
+// stays baseline x86-64; the runtime active_simd_level() gate decides whether it runs.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
+
+namespace DetourModKit
+{
+    namespace
+    {
+        constexpr std::size_t BLOCK_BYTES = 32;
+        constexpr std::size_t LANES = 4;
+        // Per-lane keys, advanced by KEY_STEP every block so a word hashes differently at every position.
+        constexpr std::array<std::uint64_t, LANES> LANE_KEYS = {0x243F6A8885A308D3ULL, 0x13198A2E03707344ULL,
+                                                                0xA4093822299F31D0ULL, 0x082EFA98EC4E6C89ULL};
+        constexpr std::uint64_t KEY_STEP = 0x9E3779B97F4A7C15ULL;
+
+        struct HashLanes
+        {
+            std::array<std::uint64_t, LANES> acc{};
+            std::array<std::uint64_t, LANES> key = LANE_KEYS;
+        };
+
+        // One block: each lane adds its word and the 32x32 product of the keyed word's halves. The AVX2 kernel does
+        // exactly this for four lanes at once, so both paths reach the same lanes.
+        void hash_block_scalar(HashLanes &lanes, const std::byte *block) noexcept
+        {
+            for (std::size_t j = 0; j < LANES; ++j)
+            {
+                std::uint64_t word = 0;
+                std::memcpy(&word, block + j * sizeof(word), sizeof(word));
+                const std::uint64_t keyed = word ^ lanes.key[j];
+                lanes.acc[j] += (keyed & 0xFFFFFFFFULL) * (keyed >> 32);
+                lanes.acc[j] += word;
+                lanes.key[j] += KEY_STEP;
+            }
+        }
+
+        void hash_blocks_scalar(HashLanes &lanes, const std::byte *bytes, std::size_t blocks) noexcept
+        {
+            for (std::size_t b = 0; b < blocks; ++b)
+            {
+                hash_block_scalar(lanes, bytes + b * BLOCK_BYTES);
+            }
+        }
+
+#ifdef DMK_HAS_AVX2
+        DMK_AVX2_TARGET
+        void hash_blocks_avx2(HashLanes &lanes, const std::byte *bytes, std::size_t blocks) noexcept
+        {
+            __m256i acc = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.acc.data()));
+            __m256i key = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(lanes.key.data()));
+            const __m256i step = _mm256_set1_epi64x(static_cast<long long>(KEY_STEP));
+            for (std::size_t b = 0; b < blocks; ++b)
+            {
+                const __m256i word = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes + b * BLOCK_BYTES));
+                const __m256i keyed = _mm256_xor_si256(word, key);
+                acc = _mm256_add_epi64(acc, _mm256_mul_epu32(keyed, _mm256_srli_epi64(keyed, 32)));
+                acc = _mm256_add_epi64(acc, word);
+                key = _mm256_add_epi64(key, step);
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.acc.data()), acc);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(lanes.key.data()), key);
+        }
+#endif
+
+        [[nodiscard]] std::uint64_t fmix64(std::uint64_t value) noexcept
+        {
+            value ^= value >> 33;
+            value *= 0xFF51AFD7ED558CCDULL;
+            value ^= value >> 33;
+            value *= 0xC4CEB9FE1A85EC53ULL;
+            value ^= value >> 33;
+            return value;
+        }
+
+        struct PageEntry
+        {
+            // The part of the watch inside this page.
+            std::uintptr_t begin = 0;
+            std::uint32_t length = 0;
+            std::uint32_t watch = 0;
+            std::uint64_t hash = 0;
+            bool readable = true;
+        };
+
+        [[nodiscard]] Region entry_region(const PageEntry &entry) noexcept
+        {
+            return Region{Address{entry.begin}, entry.length};
+        }
+    } // namespace
+
+    std::uint64_t integrity::page_hash(std::span<const std::byte> bytes) noexcept
+    {
+        HashLanes lanes;
+        const std::size_t blocks = bytes.size() / BLOCK_BYTES;
+#ifdef DMK_HAS_AVX2
+        if (scan::active_simd_level() >= scan::SimdLevel::Avx2)
+        {
+            hash_blocks_avx2(lanes, bytes.data(), blocks);
+        }
+        else
+#endif
+        {
+            hash_blocks_scalar(lanes, bytes.data(), blocks);
+        }
+
+        // A partial last block is zero-padded; the length mix below keeps it apart from real zero bytes.
+        if (const std::size_t tail = bytes.size() % BLOCK_BYTES; tail != 0)
+        {
+            std::array<std::byte, BLOCK_BYTES> last{};
+            std::memcpy(last.data(), bytes.data() + blocks * BLOCK_BYTES, tail);
+            hash_block_scalar(lanes, last.data());
+        }
+
+        std::uint64_t hash = fmix64(static_cast<std::uint64_t>(bytes.size()) * KEY_STEP);
+        for (const std::uint64_t lane : lanes.acc)
+        {
+            hash = fmix64(hash ^ lane);
+        }
+        return hash;
+    }
+
+    struct integrity::CodeMonitor::Impl
+    {
+        // Table mutex: guards labels, entries and cursor.
+        mutable std::mutex mutex;
+        // Deque, so a label's address survives later watches while an event aliases it.
+        std::deque<std::string> labels;
+        std::vector<PageEntry> entries;
+        std::size_t cursor = 0;
+
+        // Verify mutex: serializes verify() calls and owns the event buffer. The buffer grows only when a verify
+        // first sees more entries than it holds, so a steady-state verify allocates nothing.
+        std::mutex verify_mutex;
+        std::vector<CodeChangedEvent> pending;
+
+        EventDispatcher<CodeChangedEvent> changes;
+
+        std::mutex sleep_mutex;
+        std::condition_variable_any sleep_cv;
+        std::unique_ptr<StoppableWorker> worker;
+
+        // Hashes the entry's span now; false when it does not read.
+        [[nodiscard]] static bool hash_entry(const PageEntry &entry, std::uint64_t &hash) noexcept
+        {
+            alignas(64) std::array<std::byte, PAGE_BYTES> scratch;
+            const std::span<std::byte> bytes{scratch.data(), entry.length};
+            if (!memory::read_into(entry_region(entry).base, bytes))
+            {
+                return false;
+            }
+            hash = page_hash(bytes);
+            return true;
+        }
+
+        std::size_t verify(std::size_t max_pages) noexcept
+        {
+            std::scoped_lock verify_lock{verify_mutex};
+            pending.clear();
+            {
+                std::scoped_lock lock{mutex};
+                const std::size_t count = std::min(max_pages, entries.size());
+                try
+                {
+                    pending.reserve(count);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    // The cursor has not moved, so the next tick checks these pages.
+                    return 0;
+                }
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    PageEntry &entry = entries[cursor];
+                    cursor = (cursor + 1) % entries.size();
+
+                    std::uint64_t hash = 0;
+                    const bool readable = hash_entry(entry, hash);
+                    if (readable == entry.readable && hash == entry.hash)
+                    {
+                        continue;
+                    }
+                    pending.push_back(
+                        CodeChangedEvent{labels[entry.watch], entry_region(entry), entry.hash, hash, readable});
+                    entry.hash = hash;
+                    entry.readable = readable;
+                }
+            }
+
+            // Code that changed under a watch may be a thunk re-pointed at a new detour; drop the cached thunk
+            // destinations before any subscriber reacts, so a recovery it triggers decodes afresh.
+            if (!pending.empty())
+            {
+                detail::invalidate_thunk_targets();
+            }
+            for (const CodeChangedEvent &event : pending)
+            {
+                changes.emit_safe(event);
+            }
+            return pending.size();
+        }
+    };
+
+    integrity::CodeMonitor::CodeMonitor(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    integrity::CodeMonitor::CodeMonitor(CodeMonitor &&) noexcept = default;
+
+    integrity::CodeMonitor &integrity::CodeMonitor::operator=(CodeMonitor &&other) noexcept
+    {
+        if (this != &other)
+        {
+            stop();
+            m_impl = std::move(other.m_impl);
+        }
+        return *this;
+    }
+
+    integrity::CodeMonitor::~CodeMonitor() noexcept
+    {
+        stop();
+    }
+
+    Result<integrity::CodeMonitor> integrity::CodeMonitor::make() noexcept
+    {
+        std::unique_ptr<Impl> impl(new (std::nothrow) Impl{});
+        if (!impl)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "integrity::CodeMonitor::make"});
+        }
+        return CodeMonitor(std::move(impl));
+    }
+
+    Result<std::size_t> integrity::CodeMonitor::watch(std::string label, Region range) noexcept
+    {
+        constexpr const char *where = "integrity::CodeMonitor::watch";
+        if (range.size == 0 || !range.base || range.end() < range.base)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, where, range.base.raw(), 0});
+        }
+
+        // Split and baseline outside the table mutex, so a verify in flight is not held up by the reads.
+        std::vector<PageEntry> pages;
+        try
+        {
+            const std::uintptr_t first = range.base.raw() & ~(PAGE_BYTES - 1);
+            pages.reserve((range.end().raw() - first + PAGE_BYTES - 1) / PAGE_BYTES);
+            for (std::uintptr_t page = first; page < range.end().raw(); page += PAGE_BYTES)
+            {
+                PageEntry entry;
+                entry.begin = std::max(page, range.base.raw());
+                entry.length = static_cast<std::uint32_t>(std::min(page + PAGE_BYTES, range.end().raw()) - entry.begin);
+                pages.push_back(entry);
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+        }
+        for (PageEntry &entry : pages)
+        {
+            if (!Impl::hash_entry(entry, entry.hash))
+            {
+                return std::unexpected(Error{ErrorCode::ReadFaulted, where, entry.begin, 0});
+            }
+        }
+
+        std::scoped_lock lock{m_impl->mutex};
+        const std::size_t index = m_impl->labels.size();
+        try
+        {
+            m_impl->entries.reserve(m_impl->entries.size() + pages.size());
+            m_impl->labels.push_back(std::move(label));
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+        }
+        for (PageEntry &entry : pages)
+        {
+            entry.watch = static_cast<std::uint32_t>(index);
+            m_impl->entries.push_back(entry);
+        }
+        return index;
+    }
+
+    void integrity::CodeMonitor::rebaseline() noexcept
+    {
+        std::scoped_lock lock{m_impl->mutex};
+        for (PageEntry &entry : m_impl->entries)
+        {
+            entry.readable = Impl::hash_entry(entry, entry.hash);
+            if (!entry.readable)
+            {
+                entry.hash = 0;
+            }
+        }
+    }
+
+    std::size_t integrity::CodeMonitor::verify(std::size_t max_pages) noexcept
+    {
+        return m_impl->verify(max_pages);
+    }
+
+    Result<void> integrity::CodeMonitor::start(MonitorOptions options) noexcept
+    {
+        constexpr const char *where = "integrity::CodeMonitor::start";
+        if (options.pages_per_tick == 0 || options.interval.count() <= 0)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, where});
+        }
+        stop();
+
+        Impl *impl = m_impl.get();
+        // Captures the Impl, not the monitor, so moving the monitor does not strand the worker.
+        auto tick = [impl, options](std::stop_token stop_token)
+        {
+            while (!stop_token.stop_requested())
+            {
+                (void)impl->verify(options.pages_per_tick);
+                std::unique_lock lock{impl->sleep_mutex};
+                impl->sleep_cv.wait_for(lock, stop_token, options.interval, []() { return false; });
+            }
+        };
+        try
+        {
+            impl->worker = std::make_unique<StoppableWorker>("CodeMonitor", std::move(tick));
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+        }
+        catch (const std::system_error &failure)
+        {
+            return std::unexpected(
+                Error{ErrorCode::SystemCallFailed, where, static_cast<std::uintptr_t>(failure.code().value())});
+        }
+        return {};
+    }
+
+    void integrity::CodeMonitor::stop() noexcept
+    {
+        if (!m_impl || !m_impl->worker)
+        {
+            return;
+        }
+        m_impl->worker->shutdown();
+        m_impl->worker.reset();
+    }
+
+    bool integrity::CodeMonitor::running() const noexcept
+    {
+        return m_impl && m_impl->worker && m_impl->worker->is_running();
+    }
+
+    std::size_t integrity::CodeMonitor::page_count() const noexcept
+    {
+        if (!m_impl)
+        {
+            return 0;
+        }
+        std::scoped_lock lock{m_impl->mutex};
+        return m_impl->entries.size();
+    }
+
+    EventDispatcher<integrity::CodeChangedEvent> &integrity::CodeMonitor::changes() noexcept
+    {
+        return m_impl->changes;
+    }
+} // namespace DetourModKit
@@ -0,0 +1,40 @@
+#ifndef DETOURMODKIT_INTERNAL_ANCHOR_PRESCAN_HPP
+#define DETOURMODKIT_INTERNAL_ANCHOR_PRESCAN_HPP
+
+/**
+ * @file internal/anchor_prescan.hpp
+ * @brief True-private entry points that let a batch outside anchor.cpp pre-sweep RipGlobal cascades and CodeOperand
+ *        site ladders.
+ * @details Never installed. The anchor table resolvers prescan their own cascades (see detail::prescan_ladders), but a
+ *          batch that resolves anchors one by one under its own scheduling -- manifest::resolve_and_gate, whose
+ *          signatures carry a scope each -- needs the same request the single-anchor path would build and a way to
+ *          resolve against its slot. Both go through the default, empty ScanProfile, exactly as anchor::resolve does.
+ */
+
+#include "internal/scan_multi.hpp"
+
+#include "DetourModKit/anchor.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// The scan request anchor::resolve(@p anchor, @p scope) runs for a RipGlobal or CodeOperand anchor.
+        [[nodiscard]] scan::ScanRequest anchor_cascade_request(const anchor::Anchor &anchor, Region scope) noexcept;
+
+        /**
+         * @brief anchor::resolve(@p anchor, @p scope), with the RipGlobal cascade or CodeOperand site read from slot
+         *        @p request_index of @p prescan.
+         * @details Outcome-identical to anchor::resolve; the slot must have been built from
+         *          anchor_cascade_request(@p anchor, @p scope). Any other kind ignores the prescan.
+         */
+        [[nodiscard]] anchor::ResolvedAnchor resolve_anchor_prescanned(const anchor::Anchor &anchor, Region scope,
+                                                                       const LadderPrescan &prescan,
+                                                                       std::size_t request_index);
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_ANCHOR_PRESCAN_HPP
@@ -1,18 +1,24 @@
 #include "internal/async_logger.hpp"
 
 #include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/profiler.hpp"
 
 #include "internal/async_logger_queue.hpp"
+#include "internal/kv_log_writer.hpp"
+#include "internal/mapped_log_ring.hpp"
 #include "platform.hpp"
 #include "internal/win_file_stream.hpp"
 
 #include <algorithm>
+#include <array>
 #include <condition_variable>
+#include <cstdint>
 #include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <new>
 #include <span>
+#include <sstream>
 #include <system_error>
 #include <thread>
 #include <type_traits>
@@ -44,60 +50,69 @@ namespace DetourModKit
             return is_loader_lock_held();
         }
 
-        StringPool::StringPool() noexcept
-        {
-            std::lock_guard<std::mutex> lock(m_pool_mutex);
-            grow_pool_locked();
-        }
+        // Blocks are grown on first use per size class, so constructing the pool allocates nothing.
+        StringPool::StringPool() noexcept = default;
 
         StringPool::~StringPool() noexcept
         {
-            size_t leaked = 0;
-
-            {
-                // Acquire the mutex to synchronize with any in-flight deallocate() calls
-                std::lock_guard<std::mutex> lock(m_pool_mutex);
-                leaked = m_heap_fallback_count.load(std::memory_order_relaxed);
-            }
-
+            const size_t leaked = m_heap_fallback_count.load(std::memory_order_relaxed);
             if (leaked > 0)
             {
                 std::cerr << "[StringPool] " << leaked
                           << " heap-fallback string(s) were not returned before destruction\n";
             }
 
-            Block *current = m_head.load(std::memory_order_relaxed);
-            while (current)
+            for (Depot &depot : m_depots)
             {
-                Block *next = current->next;
-
-                PoolSlot *slots = reinterpret_cast<PoolSlot *>(current->data);
-                for (size_t i = 0; i < POOL_SLOTS_PER_BLOCK; ++i)
+                // Acquire the mutex to synchronize with any in-flight deallocate() calls
+                std::lock_guard<std::mutex> lock(depot.mutex);
+                Block *current = depot.blocks;
+                while (current)
                 {
-                    if (current->constructed_mask & (1u << i))
+                    Block *next = current->next;
+
+                    PoolSlot *slots = reinterpret_cast<PoolSlot *>(current->data);
+                    for (size_t i = 0; i < POOL_SLOTS_PER_BLOCK; ++i)
                     {
-                        slots[i].~PoolSlot();
+                        if (current->constructed_mask & (1u << i))
+                        {
+                            slots[i].~PoolSlot();
+                        }
                     }
+
+                    // Block is over-aligned (alignas(64)); it must be released through the aligned operator delete
+                    // that matches its aligned allocation in grow_depot_locked().
+                    ::operator delete(current, std::align_val_t{alignof(Block)});
+                    current = next;
                 }
+                depot.blocks = nullptr;
+                depot.free_list = nullptr;
+                depot.block_count = 0;
+            }
+        }
 
-                // Block is over-aligned (alignas(64)); it must be released through the aligned operator delete that
-                // matches its aligned allocation in grow_pool_locked().
-                ::operator delete(current, std::align_val_t{alignof(Block)});
-                current = next;
+        size_t StringPool::size_class_of(size_t size) noexcept
+        {
+            size_t size_class = 0;
+            while (POOL_SIZE_CLASSES[size_class] <= size)
+            {
+                ++size_class;
             }
-            m_head.store(nullptr, std::memory_order_relaxed);
+            return size_class;
         }
 
-        void StringPool::grow_pool_locked() noexcept
+        size_t StringPool::shard_index() noexcept
         {
-            Block *existing = m_head.load(std::memory_order_relaxed);
-            size_t count = 0;
-            for (Block *b = existing; b; b = b->next)
+            return static_cast<size_t>((static_cast<std::uint64_t>(::GetCurrentThreadId()) * 0x9E3779B97F4A7C15ULL) >>
+                                       48) %
+                   POOL_CACHE_SHARDS;
+        }
+
+        void StringPool::grow_depot_locked(Depot &depot, size_t size_class) noexcept
+        {
+            if (depot.block_count >= MEMORY_POOL_BLOCK_COUNT)
             {
-                if (++count >= MEMORY_POOL_BLOCK_COUNT)
-                {
-                    return;
-                }
+                return;
             }
 
             // Block is over-aligned via its alignas(64) data member, so it must be allocated through the aligned
@@ -113,9 +128,6 @@ namespace DetourModKit
             }
             Block *new_block = new (raw) Block();
 
-            new_block->next = existing;
-            new_block->free_list = nullptr;
-
             PoolSlot *slots = reinterpret_cast<PoolSlot *>(new_block->data);
             static_assert(POOL_SLOTS_PER_BLOCK <= 32,
                           "constructed_mask is uint32_t; increase its width if POOL_SLOTS_PER_BLOCK > 32");
@@ -123,18 +135,21 @@ namespace DetourModKit
             // this noexcept function. std::string's default constructor is noexcept, so the loop below is provably
             // no-throw.
             static_assert(std::is_nothrow_default_constructible_v<PoolSlot>,
-                          "PoolSlot must be nothrow-default-constructible so grow_pool_locked stays no-throw");
+                          "PoolSlot must be nothrow-default-constructible so grow_depot_locked stays no-throw");
             uint32_t constructed = 0;
             for (size_t i = 0; i < POOL_SLOTS_PER_BLOCK; ++i)
             {
                 new (&slots[i]) PoolSlot();
                 constructed |= (1u << i);
-                slots[i].next_free = (i + 1 < POOL_SLOTS_PER_BLOCK) ? &slots[i + 1] : nullptr;
+                slots[i].size_class = static_cast<std::uint8_t>(size_class);
+                slots[i].next_free = (i + 1 < POOL_SLOTS_PER_BLOCK) ? &slots[i + 1] : depot.free_list;
             }
             new_block->constructed_mask = constructed;
-            new_block->free_list = &slots[0];
+            new_block->next = depot.blocks;
 
-            m_head.store(new_block, std::memory_order_release);
+            depot.blocks = new_block;
+            depot.free_list = &slots[0];
+            ++depot.block_count;
         }
 
         StringPool &StringPool::instance() noexcept
@@ -144,61 +159,98 @@ namespace DetourModKit
             // (use-after-free under DLL unload and loader-lock teardown). A heap-allocated singleton (`*new
             // StringPool()`) would instead require a throwing operator new whose std::bad_alloc would escape this
             // noexcept accessor and terminate the host. Placement-new into static storage avoids both: the object lives
-            // for the whole process, its destructor never runs, and construction performs no throwing allocation
-            // because grow_pool_locked() is nothrow. The bounded block leak (at most MEMORY_POOL_BLOCK_COUNT blocks,
-            // each a POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot)-byte slot array) is released by the OS at process exit.
+            // for the whole process, its destructor never runs, and construction performs no allocation at all. The
+            // bounded block leak (at most MEMORY_POOL_BLOCK_COUNT blocks per size class) is released by the OS at
+            // process exit.
             alignas(StringPool) static unsigned char storage[sizeof(StringPool)];
             static StringPool *const pool = ::new (static_cast<void *>(storage)) StringPool();
             return *pool;
         }
 
-        StringPool::PoolSlot *StringPool::claim_free_slot() noexcept
+        size_t StringPool::take_from_depot(size_t size_class, PoolSlot **out, size_t count) noexcept
         {
-            for (Block *b = m_head.load(std::memory_order_relaxed); b; b = b->next)
+            Depot &depot = m_depots[size_class];
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            if (!depot.free_list)
             {
-                if (b->free_list)
-                {
-                    PoolSlot *slot = b->free_list;
-                    b->free_list = slot->next_free;
-                    return slot;
-                }
+                grow_depot_locked(depot, size_class);
             }
-            return nullptr;
+            size_t taken = 0;
+            while (taken < count && depot.free_list)
+            {
+                out[taken++] = depot.free_list;
+                depot.free_list = depot.free_list->next_free;
+            }
+            return taken;
+        }
+
+        void StringPool::return_to_depot(size_t size_class, PoolSlot *const *slots, size_t count) noexcept
+        {
+            Depot &depot = m_depots[size_class];
+            std::lock_guard<std::mutex> lock(depot.mutex);
+            for (size_t i = 0; i < count; ++i)
+            {
+                slots[i]->next_free = depot.free_list;
+                depot.free_list = slots[i];
+            }
+        }
+
+        std::string *StringPool::heap_string() noexcept
+        {
+            auto *slot = new (std::nothrow) PoolSlot();
+            if (!slot)
+            {
+                return nullptr;
+            }
+            m_heap_fallback_count.fetch_add(1, std::memory_order_relaxed);
+            return &slot->str;
         }
 
         std::string *StringPool::allocate(size_t size) noexcept
         {
             if (size > MAX_POOLED_STRING_SIZE)
             {
-                auto *ptr = new (std::nothrow) std::string();
-                if (ptr)
+                return heap_string();
+            }
+
+            const size_t size_class = size_class_of(size);
+            PoolSlot *slot = nullptr;
+            Magazine &magazine = m_magazines[shard_index()][size_class];
+            if (!magazine.busy.test_and_set(std::memory_order_acquire))
+            {
+                if (magazine.count == 0)
                 {
-                    m_heap_fallback_count.fetch_add(1, std::memory_order_relaxed);
+                    magazine.count = take_from_depot(size_class, magazine.slots.data(), POOL_MAGAZINE_SIZE / 2);
                 }
-                return ptr;
+                if (magazine.count > 0)
+                {
+                    slot = magazine.slots[--magazine.count];
+                }
+                magazine.busy.clear(std::memory_order_release);
             }
-
-            std::lock_guard<std::mutex> lock(m_pool_mutex);
-
-            PoolSlot *slot = claim_free_slot();
-            if (!slot)
+            else
             {
-                grow_pool_locked();
-                slot = claim_free_slot();
+                (void)take_from_depot(size_class, &slot, 1);
             }
 
-            if (slot)
+            if (!slot)
             {
-                slot->str.clear();
-                return &slot->str;
+                return heap_string();
             }
 
-            auto *ptr = new (std::nothrow) std::string();
-            if (ptr)
+            // Reserve the class capacity once per slot so a later assign of up to that size does not allocate. A
+            // failed reserve leaves the string empty; the caller's assign then allocates (and reports) on its own.
+            if (slot->str.capacity() < POOL_SIZE_CLASSES[size_class] - 1)
             {
-                m_heap_fallback_count.fetch_add(1, std::memory_order_relaxed);
+                try
+                {
+                    slot->str.reserve(POOL_SIZE_CLASSES[size_class] - 1);
+                }
+                catch (...)
+                {
+                }
             }
-            return ptr;
+            return &slot->str;
         }
 
         void StringPool::deallocate(std::string *ptr) noexcept
@@ -206,40 +258,41 @@ namespace DetourModKit
             if (!ptr)
                 return;
 
-            std::lock_guard<std::mutex> lock(m_pool_mutex);
-
-            for (Block *b = m_head.load(std::memory_order_relaxed); b; b = b->next)
+            PoolSlot *slot = reinterpret_cast<PoolSlot *>(ptr);
+            if (slot->size_class == HEAP_CLASS)
             {
-                const auto *block_begin = reinterpret_cast<const char *>(b->data);
-                const auto *block_end = block_begin + POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot);
-                const auto *raw_ptr = reinterpret_cast<const char *>(ptr);
-
-                if (raw_ptr >= block_begin && raw_ptr < block_end)
+                delete slot;
+                if (m_heap_fallback_count.load(std::memory_order_relaxed) > 0)
                 {
-                    auto offset = static_cast<size_t>(raw_ptr - block_begin);
-                    PoolSlot *slot = reinterpret_cast<PoolSlot *>(b->data) + (offset / sizeof(PoolSlot));
-                    slot->str.clear();
-                    return_slot_locked(slot, b);
-                    return;
+                    m_heap_fallback_count.fetch_sub(1, std::memory_order_relaxed);
                 }
+                return;
             }
 
-            // Not a pool allocation -- heap fallback. The delete is performed under m_pool_mutex to serialize with
-            // concurrent deallocate() calls that walk the block list above. Without the lock, a concurrent deallocate
-            // could see a partially updated free list. The lock does not prevent double-free of heap pointers (those
-            // are not tracked); callers must ensure each pointer is deallocated exactly once. The cost is a single
-            // free() call (or no-op for SSO-sized strings).
-            delete ptr;
-            if (m_heap_fallback_count.load(std::memory_order_relaxed) > 0)
+            const size_t size_class = slot->size_class;
+            if (slot->str.capacity() > POOL_SIZE_CLASSES[size_class] - 1)
             {
-                m_heap_fallback_count.fetch_sub(1, std::memory_order_relaxed);
+                // The caller grew the string past its class; drop the larger buffer so the slot stays class-sized.
+                slot->str = std::string();
+            }
+            else
+            {
+                slot->str.clear();
             }
-        }
 
-        void StringPool::return_slot_locked(PoolSlot *slot, Block *block) noexcept
-        {
-            slot->next_free = block->free_list;
-            block->free_list = slot;
+            Magazine &magazine = m_magazines[shard_index()][size_class];
+            if (magazine.busy.test_and_set(std::memory_order_acquire))
+            {
+                return_to_depot(size_class, &slot, 1);
+                return;
+            }
+            if (magazine.count == POOL_MAGAZINE_SIZE)
+            {
+                return_to_depot(size_class, magazine.slots.data() + POOL_MAGAZINE_SIZE / 2, POOL_MAGAZINE_SIZE / 2);
+                magazine.count = POOL_MAGAZINE_SIZE / 2;
+            }
+            magazine.slots[magazine.count++] = slot;
+            magazine.busy.clear(std::memory_order_release);
         }
 
         // buffer is intentionally left uninitialized on this hot path (see async_logger_queue.hpp): only [0, length)
@@ -280,6 +333,17 @@ namespace DetourModKit
             }
         }
 
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init) buffer is filled by the length-guarded memcpy below
+        LogMessage::LogMessage(LogLevel lvl, std::span<const std::byte> record) noexcept
+            : level(lvl), timestamp(std::chrono::system_clock::now()), deferred(true)
+        {
+            if (record.size() <= MAX_INLINE_SIZE)
+            {
+                std::memcpy(buffer.data(), record.data(), record.size());
+                length = record.size();
+            }
+        }
+
         LogMessage::~LogMessage() noexcept
         {
             reset();
@@ -291,8 +355,12 @@ namespace DetourModKit
         // it to the pool.
         // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init) buffer is filled by the length-guarded memcpy below
         LogMessage::LogMessage(LogMessage &&other) noexcept
-            : level(other.level), timestamp(other.timestamp), length(other.length), overflow(other.overflow)
+            : level(other.level), timestamp(other.timestamp), length(other.length), overflow(other.overflow),
+              deferred(other.deferred), structured(other.structured)
         {
+#ifdef DMK_ENABLE_PROFILING
+            flow_id = other.flow_id;
+#endif
             if (length > 0 && !overflow)
             {
                 std::memcpy(buffer.data(), other.buffer.data(), length);
@@ -310,6 +378,11 @@ namespace DetourModKit
                 timestamp = other.timestamp;
                 length = other.length;
                 overflow = other.overflow;
+                deferred = other.deferred;
+                structured = other.structured;
+#ifdef DMK_ENABLE_PROFILING
+                flow_id = other.flow_id;
+#endif
                 if (length > 0 && !overflow)
                 {
                     std::memcpy(buffer.data(), other.buffer.data(), length);
@@ -346,6 +419,8 @@ namespace DetourModKit
                 overflow = nullptr;
             }
             length = 0;
+            deferred = false;
+            structured = false;
         }
 
         size_t DynamicMPMCQueue::validated_capacity(size_t capacity)
@@ -474,6 +549,121 @@ namespace DetourModKit
         {
             return size() == 0;
         }
+
+        LogLaneTable::~LogLaneTable() noexcept
+        {
+            for (Entry &entry : m_entries)
+            {
+                delete entry.lane.load(std::memory_order_acquire);
+            }
+        }
+
+        LogLaneTable::Lane *LogLaneTable::lane_for_current_thread() noexcept
+        {
+            // Thread ids are never zero, so zero can mark a free entry. The multiplicative hash spreads the ids,
+            // which Windows hands out in steps of four, over the whole table.
+            const auto thread_id = static_cast<std::uint32_t>(::GetCurrentThreadId());
+            const auto start =
+                static_cast<size_t>((static_cast<std::uint64_t>(thread_id) * 0x9E3779B97F4A7C15ULL) >> 32);
+            for (size_t probe = 0; probe < MAX_LOG_LANES; ++probe)
+            {
+                Entry &entry = m_entries[(start + probe) % MAX_LOG_LANES];
+                std::uint32_t owner = entry.owner.load(std::memory_order_acquire);
+                if (owner == thread_id)
+                {
+                    return entry.lane.load(std::memory_order_acquire);
+                }
+                if (owner != 0 || !entry.owner.compare_exchange_strong(owner, thread_id, std::memory_order_acq_rel))
+                {
+                    // Another thread's entry, or one another thread just claimed: it can never become ours.
+                    continue;
+                }
+                // The lane is built off the shared path; on failure the entry stays claimed with no lane, and this
+                // thread keeps logging through the shared queue.
+                Lane *built = nullptr;
+                try
+                {
+                    built = new Lane(m_lane_capacity);
+                }
+                catch (...)
+                {
+                    built = nullptr;
+                }
+                // seq_cst, like the pending counts: the writer's park check must either see this lane or have its
+                // waiting flag seen by the first push into it.
+                entry.lane.store(built, std::memory_order_seq_cst);
+                return built;
+            }
+            return nullptr;
+        }
+
+        bool CallSiteRateLimiter::admit(std::uint64_t site, std::uint64_t now_ms) noexcept
+        {
+            // A short probe keeps a flood from a table of distinct sites cheap; the sites past it go unlimited.
+            constexpr size_t MAX_PROBES = 8;
+            // Zero marks a free entry, so a site that hashes to zero is folded onto one.
+            site = site != 0 ? site : 1;
+            const auto start = static_cast<size_t>((site * 0x9E3779B97F4A7C15ULL) >> 56);
+            for (size_t probe = 0; probe < MAX_PROBES; ++probe)
+            {
+                Entry &entry = m_entries[(start + probe) % RATE_LIMIT_SITES];
+                std::uint64_t key = entry.key.load(std::memory_order_acquire);
+                if (key == 0 && entry.key.compare_exchange_strong(key, site, std::memory_order_acq_rel))
+                {
+                    key = site;
+                }
+                if (key == site)
+                {
+                    return take(entry.bucket, now_ms);
+                }
+            }
+            return true;
+        }
+
+        bool CallSiteRateLimiter::take(std::atomic<std::uint64_t> &bucket, std::uint64_t now_ms) const noexcept
+        {
+            constexpr std::uint64_t TOKEN_MASK = MAX_BURST;
+            constexpr std::uint64_t STAMP_MASK = (std::uint64_t{1} << 40) - 1;
+            now_ms &= STAMP_MASK;
+
+            std::uint64_t state = bucket.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                std::uint64_t stamp = state >> 24;
+                std::uint64_t tokens = state & TOKEN_MASK;
+                // A zero word is a bucket no line has touched yet: full. Otherwise refill for the whole milliseconds
+                // since the stamp, and move the stamp only by the time the added tokens account for, so a site
+                // polled more often than its rate still accrues the fractions.
+                if (state == 0)
+                {
+                    stamp = now_ms;
+                    tokens = m_burst;
+                }
+                else if (now_ms > stamp)
+                {
+                    const std::uint64_t refill = (now_ms - stamp) * m_per_second / 1000;
+                    if (tokens + refill >= m_burst)
+                    {
+                        tokens = m_burst;
+                        stamp = now_ms;
+                    }
+                    else if (refill > 0)
+                    {
+                        tokens += refill;
+                        stamp += refill * 1000 / m_per_second;
+                    }
+                }
+                if (tokens == 0)
+                {
+                    return false;
+                }
+                const std::uint64_t desired = (stamp << 24) | (tokens - 1);
+                if (bucket.compare_exchange_weak(state, desired, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+        }
     } // namespace detail
 
     // The AsyncLogger pimpl: every member and method that touches the queue, string pool, writer thread, or flush
@@ -491,8 +681,12 @@ namespace DetourModKit
         Impl &operator=(Impl &&) = delete;
 
         [[nodiscard]] bool enqueue(LogLevel level, std::string_view message) noexcept;
+        [[nodiscard]] bool enqueue_deferred(LogLevel level, std::span<const std::byte> record) noexcept;
+        [[nodiscard]] bool enqueue_structured(LogLevel level, std::span<const std::byte> record) noexcept;
+        [[nodiscard]] bool admit_call_site(std::uint64_t site) noexcept;
         [[nodiscard]] bool flush_with_timeout(std::chrono::milliseconds timeout) noexcept;
         void flush() noexcept;
+        [[nodiscard]] bool drain_at_process_exit() noexcept;
         void shutdown() noexcept;
         [[nodiscard]] bool is_running() const noexcept;
         [[nodiscard]] bool is_writer_waiting() const noexcept;
@@ -510,20 +704,87 @@ namespace DetourModKit
         // late-enqueued messages that arrived between m_running=false and the writer observing an empty queue).
         void drain_remaining() noexcept;
         void write_batch(std::span<detail::LogMessage> messages) noexcept;
-        bool handle_overflow(detail::LogMessage &&message) noexcept;
-        // Wakes the writer thread if it is parked on m_flush_cv after a successful push. The producer increments
+        // Per-source pop counts of one writer pass: index 0 is the shared queue, index i + 1 is lane i.
+        using PoppedCounts = std::array<size_t, detail::MAX_LOG_LANES + 1>;
+        // Pops up to @p limit messages from the shared queue and then the lanes (starting one lane further on each
+        // pass, so a flooded lane cannot starve the rest) and records each source's count in @p popped. A batch drawn
+        // from more than one source is stable-sorted by timestamp, which keeps each thread's own order.
+        size_t collect_batch(std::vector<detail::LogMessage> &batch, PoppedCounts &popped, size_t limit) noexcept;
+        // Returns the written messages of a pass to their sources' pending counts.
+        void release_pending(const PoppedCounts &popped) noexcept;
+        // The pending count summed over the shared queue and every lane; the flush and park predicates use it.
+        [[nodiscard]] size_t pending_total() const noexcept;
+        [[nodiscard]] bool queues_empty() const noexcept;
+        void zero_pending() noexcept;
+        // Pushes @p message onto the calling thread's lane, or the shared queue when there is none.
+        [[nodiscard]] bool route(detail::LogMessage &message) noexcept;
+        // The text of @p message: message() for a plain one, or the deferred record rendered into m_render_scratch.
+        // The caller holds *m_log_mutex, which is what makes the shared scratch safe.
+        [[nodiscard]] std::string_view text_of(const detail::LogMessage &message) noexcept;
+        // Writes the "[<timestamp_format>.<ms>] " stamp of @p when. The date/time part is formatted once per second
+        // into m_stamp_head and reused for every line of that second; the caller holds *m_log_mutex.
+        void write_stamp(std::chrono::system_clock::time_point when) noexcept;
+        // Writes one line: the stamp, the level tag, @p text and the newline. Caller holds *m_log_mutex.
+        void write_line(std::chrono::system_clock::time_point when, LogLevel level, std::string_view text) noexcept;
+        // Under collapse_duplicates: true when @p text at @p level repeats the last written line, which is then
+        // counted instead of written. Otherwise ends the current run and remembers this line. Caller holds
+        // *m_log_mutex.
+        [[nodiscard]] bool absorb_repeat(std::chrono::system_clock::time_point when, LogLevel level,
+                                         std::string_view text) noexcept;
+        // Writes the "last message repeated N times" line for a pending run, if any, and forgets the last line.
+        // Caller holds *m_log_mutex.
+        void end_repeat_run() noexcept;
+        // Appends a structured message to the structured log (and its text to the crash ring). Caller holds
+        // *m_log_mutex and has checked m_kv_writer.
+        [[nodiscard]] bool write_structured(const detail::LogMessage &message) noexcept;
+        // Flushes the structured log, if there is one. Caller holds *m_log_mutex.
+        void flush_structured() noexcept;
+        // Pushes @p message onto @p queue, counted in @p pending, and applies the overflow policy when it is full.
+        [[nodiscard]] bool push_or_overflow(detail::DynamicMPMCQueue &queue, std::atomic<size_t> &pending,
+                                            detail::LogMessage &message) noexcept;
+        bool handle_overflow(detail::DynamicMPMCQueue &queue, std::atomic<size_t> &pending,
+                             detail::LogMessage &&message) noexcept;
+        // Wakes the writer thread if it is parked on m_wake_epoch after a successful push. The producer increments
         // m_pending_messages and publishes the slot before this load; the writer publishes m_writer_waiting before
         // checking the same count and parking. Those seq_cst operations form a store/load handshake that closes the
-        // lost-wakeup window without taking m_flush_mutex while the writer is actively draining. notify_all (not
-        // notify_one) keeps a flusher waiting on the same condition variable from absorbing the wake and leaving the
-        // writer asleep.
+        // lost-wakeup window without a lock. Only the producer whose exchange clears m_writer_waiting (the one that
+        // moved the queue off empty) pays the wake system call; every other push is a single load.
         void notify_writer() noexcept;
+        // Bumps m_wake_epoch and wakes the writer parked on it, whether or not it is parked.
+        void wake_writer() noexcept;
 
         detail::DynamicMPMCQueue m_queue;
         AsyncLoggerConfig m_config;
+        // Present only under LogTransport::PerThreadLanes. Built before the writer starts and never replaced, so the
+        // writer and producers read the pointer without synchronization.
+        std::unique_ptr<detail::LogLaneTable> m_lanes;
+        // The lane the next collect pass starts at. Atomic only because the loader-lock shutdown drains alongside a
+        // detached writer; relaxed, since it only spreads the starting point.
+        std::atomic<size_t> m_next_lane{0};
 
         std::shared_ptr<detail::WinFileStream> m_file_stream;
         std::shared_ptr<std::mutex> m_log_mutex;
+        // Rendering buffer for deferred records, guarded by *m_log_mutex; its capacity is kept across batches.
+        std::string m_render_scratch;
+        // "[" plus timestamp_format rendered for m_stamp_second plus ".", guarded by *m_log_mutex. A second of -1
+        // marks it stale; set_timestamp_format sets that so the next line formats under the new format.
+        std::time_t m_stamp_second{-1};
+        std::string m_stamp_head;
+        // collapse_duplicates state, guarded by *m_log_mutex: the last line written, and how many identical lines
+        // have been absorbed after it (with the newest one's time for the count line).
+        bool m_has_last_line{false};
+        LogLevel m_last_level{LogLevel::Info};
+        std::string m_last_line;
+        size_t m_repeats{0};
+        std::chrono::system_clock::time_point m_last_repeat_time{};
+        // Present only when rate_limit_per_second is non-zero; never replaced once the writer starts.
+        std::unique_ptr<detail::CallSiteRateLimiter> m_site_limiter;
+        // Present only when crash_ring_path is set and the ring could be mapped; never replaced once the writer starts.
+        std::unique_ptr<detail::MappedLogRing> m_crash_ring;
+        // Present only when structured_log_path is set and the file opened; m_kv_writer encodes into m_kv_stream.
+        // Both are used under *m_log_mutex and never replaced once the writer starts.
+        std::unique_ptr<detail::WinFileStream> m_kv_stream;
+        std::unique_ptr<detail::KvLogWriter> m_kv_writer;
 
         std::jthread m_writer_thread;
         // Counted reference on the module the writer thread's code lives in, taken before the thread is created.
@@ -538,14 +799,19 @@ namespace DetourModKit
         // destructor) avoids a TOCTOU where the loader-lock state differs between the detach decision and the free.
         std::atomic<bool> m_writer_detached{false};
 
+        // Flushers wait on m_flush_cv for the pending count to reach zero; the writer notifies it after each batch.
         std::mutex m_flush_mutex;
         std::condition_variable m_flush_cv;
 
-        // Set true by the writer immediately before it parks on m_flush_cv and cleared when it wakes. Producers read it
-        // outside m_flush_mutex after a successful queue push; the seq_cst order shared with m_pending_messages makes a
-        // racing push either visible to the writer's wait predicate or visible here as a parked-writer wake.
+        // The word the idle writer parks on with WaitOnAddress. A waker bumps it before WakeByAddress, so a wake that
+        // lands between the writer's last pending check and its wait makes the wait return at once.
+        std::atomic<std::uint32_t> m_wake_epoch{0};
+        // Set true by the writer immediately before it parks and cleared when it wakes, or by the producer that claims
+        // the wake. Producers read it after a successful queue push; the seq_cst order shared with m_pending_messages
+        // makes a racing push either visible to the writer's pre-park check or visible here as a parked-writer wake.
         std::atomic<bool> m_writer_waiting{false};
 
+        // Messages counted into the shared queue but not yet written; each lane keeps its own (see pending_total).
         std::atomic<size_t> m_pending_messages{0};
         std::atomic<size_t> m_dropped_messages{0};
     };
@@ -570,6 +836,46 @@ namespace DetourModKit
             throw std::invalid_argument("log_mutex cannot be null");
         }
 
+        if (m_config.transport == LogTransport::PerThreadLanes)
+        {
+            m_lanes = std::make_unique<detail::LogLaneTable>(m_config.lane_capacity);
+        }
+
+        static_assert(MAX_RATE_LIMIT_BURST == detail::CallSiteRateLimiter::MAX_BURST,
+                      "AsyncLoggerConfig accepts a larger burst than a rate-limit bucket can hold");
+        if (m_config.rate_limit_per_second != 0)
+        {
+            m_site_limiter = std::make_unique<detail::CallSiteRateLimiter>(m_config.rate_limit_per_second,
+                                                                           m_config.rate_limit_burst);
+        }
+
+        if (!m_config.crash_ring_path.empty())
+        {
+            // Fail-soft: without a ring the logger still writes its file, it just loses the crash mirror.
+            m_crash_ring = detail::MappedLogRing::open(m_config.crash_ring_path, m_config.crash_ring_size);
+        }
+
+        if (!m_config.structured_log_path.empty())
+        {
+            // Fail-soft as well: log_kv() records then reach the text log as rendered lines.
+            auto kv_stream = std::make_unique<detail::WinFileStream>(m_config.structured_log_path);
+            if (kv_stream->is_open())
+            {
+                m_kv_writer = std::make_unique<detail::KvLogWriter>(*kv_stream);
+                m_kv_stream = std::move(kv_stream);
+            }
+        }
+
+        static_assert(MAX_WRITE_BUFFER_COUNT <= detail::WinFileStreamBuf::MAX_WRITE_BUFFERS,
+                      "AsyncLoggerConfig accepts more write pages than the file sink can rotate");
+        if (m_config.overlapped_writes)
+        {
+            // Fail-soft like the rest of the sink: a stream that cannot switch (already overlapped from an earlier
+            // async session, or ReOpenFile refused) keeps writing the way it did.
+            std::lock_guard<std::mutex> lock(*m_log_mutex);
+            (void)m_file_stream->enable_overlapped(m_config.write_buffer_size, m_config.write_buffer_count);
+        }
+
         // Hold a counted reference on this module before creating the writer thread. Once std::jthread returns, the
         // writer may already be executing this TU's code, so the keepalive has to predate the thread start. shutdown()
         // releases it after a clean join or leaks it on the loader-lock detach path.
@@ -612,38 +918,336 @@ namespace DetourModKit
             }
 
             const auto now = std::chrono::system_clock::now();
-            const auto time_t = std::chrono::system_clock::to_time_t(now);
-            std::tm tm_buf{};
+            if (m_crash_ring)
+            {
+                m_crash_ring->append(level, now, message);
+            }
+            end_repeat_run();
+            write_line(now, level, message);
+            m_file_stream->flush();
+
+            // Surface a write/flush failure through the no-throw delivery bool.
+            return m_file_stream->good();
+        }
+
+        LogMessage msg(level, message);
+        if (m_crash_ring)
+        {
+            // Mirrored before the push, so the line is in the ring even if the process dies while it is queued.
+            m_crash_ring->append(level, msg.timestamp, message);
+        }
+        return route(msg);
+    }
+
+    bool AsyncLogger::Impl::enqueue_deferred(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        if (m_shutdown_requested.load(std::memory_order_acquire))
+        {
+            // No writer pass will run for it any more, so render it here and take enqueue()'s teardown write.
+            try
+            {
+                detail::DeferredLogHeader header;
+                std::memcpy(&header, record.data(), sizeof(header));
+                std::string rendered;
+                header.render(rendered, record.data());
+                return enqueue(level, rendered);
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }
+
+        LogMessage msg(level, record);
+        return route(msg);
+    }
+
+    bool AsyncLogger::Impl::enqueue_structured(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        if (!m_kv_writer)
+        {
+            // No structured log: the record starts with a DeferredLogHeader, so it is written as a deferred text line.
+            return enqueue_deferred(level, record);
+        }
+
+        LogMessage msg(level, record);
+        msg.structured = true;
+        if (m_shutdown_requested.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(*m_log_mutex);
+            const bool written = write_structured(msg);
+            m_kv_stream->flush();
+            return written && !m_kv_stream->fail();
+        }
+        return route(msg);
+    }
+
+    bool AsyncLogger::Impl::route(LogMessage &message) noexcept
+    {
+#ifdef DMK_ENABLE_PROFILING
+        // The flow starts inside this scope and ends inside the writer's log_write_batch scope, so the trace draws
+        // an arrow from the producer's enqueue to the batch that wrote the line.
+        DMK_PROFILE_SCOPE("log_enqueue");
+        message.flow_id = Profiler::get_instance().new_flow_id();
+        DMK_PROFILE_FLOW_BEGIN("log_message", message.flow_id);
+#endif
+        if (m_lanes)
+        {
+            if (detail::LogLaneTable::Lane *lane = m_lanes->lane_for_current_thread())
+            {
+                return push_or_overflow(lane->queue, lane->pending, message);
+            }
+        }
+        return push_or_overflow(m_queue, m_pending_messages, message);
+    }
 
+    std::string_view AsyncLogger::Impl::text_of(const LogMessage &message) noexcept
+    {
+        if (!message.deferred)
+        {
+            return message.message();
+        }
+        m_render_scratch.clear();
+        if (message.length < sizeof(detail::DeferredLogHeader))
+        {
+            return m_render_scratch;
+        }
+        try
+        {
+            detail::DeferredLogHeader header;
+            std::memcpy(&header, message.buffer.data(), sizeof(header));
+            header.render(m_render_scratch, reinterpret_cast<const std::byte *>(message.buffer.data()));
+            return m_render_scratch;
+        }
+        catch (...)
+        {
+            // The scratch could not grow; write a fixed marker rather than a half-rendered line.
+            m_render_scratch.clear();
+            return "<deferred log line could not be rendered>";
+        }
+    }
+
+    bool AsyncLogger::Impl::write_structured(const LogMessage &message) noexcept
+    {
+        if (m_crash_ring)
+        {
+            m_crash_ring->append(message.level, message.timestamp, text_of(message));
+        }
+        return m_kv_writer->write(message.level, message.timestamp,
+                                  std::span<const std::byte>(reinterpret_cast<const std::byte *>(message.buffer.data()),
+                                                             message.length));
+    }
+
+    void AsyncLogger::Impl::flush_structured() noexcept
+    {
+        if (m_kv_stream)
+        {
+            m_kv_stream->flush();
+        }
+    }
+
+    void AsyncLogger::Impl::write_stamp(std::chrono::system_clock::time_point when) noexcept
+    {
+        const auto second = std::chrono::system_clock::to_time_t(when);
+        if (second != m_stamp_second)
+        {
+            // Once per second (and after a format change) rather than once per line: localtime takes a CRT lock and
+            // put_time walks the whole format, while the rest of the stamp is three digits.
+            std::tm tm_buf{};
 #if defined(_WIN32) || defined(_MSC_VER)
-            localtime_s(&tm_buf, &time_t);
+            localtime_s(&tm_buf, &second);
 #else
-            localtime_r(&time_t, &tm_buf);
+            localtime_r(&second, &tm_buf);
 #endif
+            try
+            {
+                std::ostringstream head;
+                head << '[' << std::put_time(&tm_buf, m_config.timestamp_format.c_str()) << '.';
+                m_stamp_head = std::move(head).str();
+                m_stamp_second = second;
+            }
+            catch (...)
+            {
+                // No memory for the head: stamp this line with the bare brackets and retry on the next one.
+                m_stamp_head.clear();
+                m_stamp_second = -1;
+            }
+        }
 
-            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-            *m_file_stream << "[" << std::put_time(&tm_buf, m_config.timestamp_format.c_str()) << "."
-                           << std::setfill('0') << std::setw(3) << ms.count() << std::setfill(' ') << "] "
-                           << "[" << std::setw(7) << std::left << to_string(level) << "] :: " << message << '\n';
-            m_file_stream->flush();
+        const auto ms = static_cast<unsigned>(
+            (std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()) % 1000).count());
+        const std::array<char, 5> tail{static_cast<char>('0' + ms / 100), static_cast<char>('0' + ms / 10 % 10),
+                                       static_cast<char>('0' + ms % 10), ']', ' '};
+        if (m_stamp_head.empty())
+        {
+            *m_file_stream << '[';
+        }
+        else
+        {
+            *m_file_stream << m_stamp_head;
+        }
+        m_file_stream->write(tail.data(), static_cast<std::streamsize>(tail.size()));
+    }
 
-            // Surface a write/flush failure through the no-throw delivery bool.
-            return m_file_stream->good();
+    void AsyncLogger::Impl::write_line(std::chrono::system_clock::time_point when, LogLevel level,
+                                       std::string_view text) noexcept
+    {
+        write_stamp(when);
+        *m_file_stream << "[" << std::setw(7) << std::left << to_string(level) << "] :: " << text << '\n';
+    }
+
+    bool AsyncLogger::Impl::absorb_repeat(std::chrono::system_clock::time_point when, LogLevel level,
+                                          std::string_view text) noexcept
+    {
+        if (!m_config.collapse_duplicates)
+        {
+            return false;
         }
+        if (m_has_last_line && level == m_last_level && text == m_last_line)
+        {
+            ++m_repeats;
+            m_last_repeat_time = when;
+            return true;
+        }
+        end_repeat_run();
+        try
+        {
+            m_last_line.assign(text);
+            m_last_level = level;
+            m_has_last_line = true;
+        }
+        catch (...)
+        {
+            // No room to remember it: the next line simply cannot collapse onto this one.
+        }
+        return false;
+    }
 
-        LogMessage msg(level, message);
+    void AsyncLogger::Impl::end_repeat_run() noexcept
+    {
+        if (m_repeats != 0)
+        {
+            write_stamp(m_last_repeat_time);
+            *m_file_stream << "[" << std::setw(7) << std::left << to_string(m_last_level)
+                           << "] :: last message repeated " << m_repeats << " times\n";
+            m_repeats = 0;
+        }
+        m_has_last_line = false;
+    }
+
+    bool AsyncLogger::Impl::admit_call_site(std::uint64_t site) noexcept
+    {
+        if (!m_site_limiter)
+        {
+            return true;
+        }
+        const auto now_ms = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch())
+                .count());
+        if (m_site_limiter->admit(site, now_ms))
+        {
+            return true;
+        }
+        m_dropped_messages.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
 
+    bool AsyncLogger::Impl::push_or_overflow(detail::DynamicMPMCQueue &queue, std::atomic<size_t> &pending,
+                                             LogMessage &message) noexcept
+    {
         // Increment before push so flush cannot observe zero while a message is already in the queue but not yet
         // counted.
-        m_pending_messages.fetch_add(1, std::memory_order_seq_cst);
-        if (m_queue.try_push(msg))
+        pending.fetch_add(1, std::memory_order_seq_cst);
+        if (queue.try_push(message))
         {
             notify_writer();
             return true;
         }
         // Push failed -- undo the pre-increment before entering overflow handling
-        m_pending_messages.fetch_sub(1, std::memory_order_seq_cst);
-        return handle_overflow(std::move(msg));
+        pending.fetch_sub(1, std::memory_order_seq_cst);
+        return handle_overflow(queue, pending, std::move(message));
+    }
+
+    size_t AsyncLogger::Impl::collect_batch(std::vector<LogMessage> &batch, PoppedCounts &popped, size_t limit) noexcept
+    {
+        popped.fill(0);
+        size_t total = m_queue.try_pop_batch(batch, limit);
+        popped[0] = total;
+        if (!m_lanes)
+        {
+            return total;
+        }
+        size_t sources = total > 0 ? 1 : 0;
+        const size_t first_lane = m_next_lane.fetch_add(1, std::memory_order_relaxed);
+        for (size_t step = 0; step < detail::MAX_LOG_LANES && total < limit; ++step)
+        {
+            const size_t index = (first_lane + step) % detail::MAX_LOG_LANES;
+            detail::LogLaneTable::Lane *lane = m_lanes->lane(index);
+            if (lane == nullptr)
+            {
+                continue;
+            }
+            const size_t count = lane->queue.try_pop_batch(batch, limit - total);
+            if (count > 0)
+            {
+                popped[index + 1] = count;
+                total += count;
+                ++sources;
+            }
+        }
+        if (sources > 1)
+        {
+            // The LogMessage move and the comparison are noexcept, and stable_sort falls back to its in-place merge
+            // rather than throwing when it cannot get a scratch buffer, so this is safe on the writer's noexcept frame.
+            std::stable_sort(batch.begin(), batch.end(), [](const LogMessage &a, const LogMessage &b) noexcept
+                             { return a.timestamp < b.timestamp; });
+        }
+        return total;
+    }
+
+    void AsyncLogger::Impl::release_pending(const PoppedCounts &popped) noexcept
+    {
+        if (popped[0] > 0)
+        {
+            m_pending_messages.fetch_sub(popped[0], std::memory_order_acq_rel);
+        }
+        for (size_t index = 0; m_lanes && index < detail::MAX_LOG_LANES; ++index)
+        {
+            if (popped[index + 1] > 0)
+            {
+                m_lanes->lane(index)->pending.fetch_sub(popped[index + 1], std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    size_t AsyncLogger::Impl::pending_total() const noexcept
+    {
+        size_t total = m_pending_messages.load(std::memory_order_seq_cst);
+        for (size_t index = 0; m_lanes && index < detail::MAX_LOG_LANES; ++index)
+        {
+            if (const detail::LogLaneTable::Lane *lane = m_lanes->lane(index))
+            {
+                total += lane->pending.load(std::memory_order_seq_cst);
+            }
+        }
+        return total;
+    }
+
+    bool AsyncLogger::Impl::queues_empty() const noexcept
+    {
+        return queue_size() == 0;
+    }
+
+    void AsyncLogger::Impl::zero_pending() noexcept
+    {
+        m_pending_messages.store(0, std::memory_order_release);
+        for (size_t index = 0; m_lanes && index < detail::MAX_LOG_LANES; ++index)
+        {
+            if (detail::LogLaneTable::Lane *lane = m_lanes->lane(index))
+            {
+                lane->pending.store(0, std::memory_order_release);
+            }
+        }
     }
 
     bool AsyncLogger::Impl::flush_with_timeout(std::chrono::milliseconds timeout) noexcept
@@ -655,9 +1259,21 @@ namespace DetourModKit
 
         std::unique_lock<std::mutex> lock(m_flush_mutex);
 
-        const bool flushed = m_flush_cv.wait_for(lock, timeout, [this]() noexcept
-                                                 { return m_pending_messages.load(std::memory_order_acquire) == 0; });
+        const bool flushed = m_flush_cv.wait_for(lock, timeout, [this]() noexcept { return pending_total() == 0; });
+        lock.unlock();
 
+        // write_batch may leave bytes in the sink under flush_threshold or in flight under overlapped_writes; a flush
+        // promises them on file.
+        if (flushed)
+        {
+            std::lock_guard<std::mutex> stream_lock(*m_log_mutex);
+            if (m_file_stream->is_open())
+            {
+                end_repeat_run();
+                m_file_stream->flush();
+                flush_structured();
+            }
+        }
         return flushed;
     }
 
@@ -666,6 +1282,27 @@ namespace DetourModKit
         (void)flush_with_timeout(DEFAULT_FLUSH_TIMEOUT);
     }
 
+    bool AsyncLogger::Impl::drain_at_process_exit() noexcept
+    {
+        // Every other thread is gone. Probe the sink lock once: if a terminated thread died holding it, a blocking
+        // acquire in write_batch would hang the exit. Nothing else can take it between the probe and the drain.
+        {
+            std::unique_lock<std::mutex> probe(*m_log_mutex, std::try_to_lock);
+            if (!probe.owns_lock())
+            {
+                return false;
+            }
+        }
+        drain_remaining();
+
+        std::lock_guard<std::mutex> lock(*m_log_mutex);
+        if (m_file_stream->is_open())
+        {
+            m_file_stream->flush();
+        }
+        return true;
+    }
+
     void AsyncLogger::Impl::shutdown() noexcept
     {
         bool expected = false;
@@ -676,9 +1313,9 @@ namespace DetourModKit
 
         m_running.store(false, std::memory_order_release);
 
-        // Wake the writer if it is parked. Taking m_flush_mutex serializes this notify with the writer's
-        // atomic unlock-and-block inside wait_for, so a parked writer observes m_running == false promptly
-        // instead of waiting out the flush interval before it can exit and be joined below.
+        // Wake the writer if it is parked, so it observes m_running == false promptly instead of waiting out the flush
+        // interval before it can exit and be joined below; flushers on m_flush_cv re-check their predicate too.
+        wake_writer();
         {
             std::lock_guard<std::mutex> lock(m_flush_mutex);
             m_flush_cv.notify_all();
@@ -720,7 +1357,7 @@ namespace DetourModKit
 
         {
             std::lock_guard<std::mutex> lock(m_flush_mutex);
-            m_pending_messages.store(0, std::memory_order_release);
+            zero_pending();
             m_flush_cv.notify_all();
         }
     }
@@ -737,7 +1374,15 @@ namespace DetourModKit
 
     size_t AsyncLogger::Impl::queue_size() const noexcept
     {
-        return m_queue.size();
+        size_t total = m_queue.size();
+        for (size_t index = 0; m_lanes && index < detail::MAX_LOG_LANES; ++index)
+        {
+            if (const detail::LogLaneTable::Lane *lane = m_lanes->lane(index))
+            {
+                total += lane->queue.size();
+            }
+        }
+        return total;
     }
 
     size_t AsyncLogger::Impl::dropped_count() const noexcept
@@ -758,6 +1403,7 @@ namespace DetourModKit
         // would self-deadlock the reconfigure path that already owns it. std::string move-assignment is noexcept, so
         // the by-value parameter (copied in the caller's throwing context) makes this frame genuinely no-throw.
         m_config.timestamp_format = std::move(timestamp_format);
+        m_stamp_second = -1;
     }
 
     bool AsyncLogger::Impl::writer_was_detached() const noexcept
@@ -771,16 +1417,21 @@ namespace DetourModKit
         // seq_cst order, either the writer's pending-count predicate sees that increment before it parks,
         // or this load sees the writer's waiting flag and wakes it. That closes the lost-wakeup window
         // without taking m_flush_mutex while the writer is actively draining.
-        if (m_writer_waiting.load(std::memory_order_seq_cst))
+        // The plain load keeps the busy case to one shared read; the exchange then lets exactly one producer of a
+        // burst claim the wake.
+        if (m_writer_waiting.load(std::memory_order_seq_cst) &&
+            m_writer_waiting.exchange(false, std::memory_order_seq_cst))
         {
-            // Notify under m_flush_mutex so the wake cannot be lost against the writer's atomic
-            // unlock-and-block, and notify_all (not notify_one) so a flusher blocked on the same condition
-            // variable cannot absorb the single notification and leave the writer asleep.
-            std::lock_guard<std::mutex> lock(m_flush_mutex);
-            m_flush_cv.notify_all();
+            wake_writer();
         }
     }
 
+    void AsyncLogger::Impl::wake_writer() noexcept
+    {
+        m_wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+        WakeByAddressSingle(static_cast<void *>(&m_wake_epoch));
+    }
+
     void AsyncLogger::Impl::writer_thread_func() noexcept
     {
         // Per-idle-cycle cap on the cooperative yields the writer spins through when the pending count
@@ -792,23 +1443,43 @@ namespace DetourModKit
         // try_pop_batch owns the (fail-closed) reservation and only pops within the capacity it can secure. After the
         // first pop the batch retains its capacity across the clear()s below, so the steady-state reserve is a no-op.
         std::vector<LogMessage> batch;
+        PoppedCounts popped{};
+
+        // Adaptive batch limit: a pass that fills the limit doubles it, up to ADAPTIVE_BATCH_GROWTH times batch_size
+        // (and never past the queue capacity), and a pass under a quarter of it halves it back toward batch_size. A
+        // backlog then drains in few sink-lock handoffs while a trickle keeps batch_size passes.
+        constexpr size_t ADAPTIVE_BATCH_GROWTH = 16;
+        const size_t min_batch = m_config.batch_size;
+        const size_t max_batch =
+            std::max(min_batch, std::min(min_batch * ADAPTIVE_BATCH_GROWTH, m_config.queue_capacity));
+        size_t batch_limit = min_batch;
+
+        const DWORD park_ms = static_cast<DWORD>(
+            std::min<std::chrono::milliseconds::rep>(m_config.flush_interval.count(), INFINITE - 1));
 
         auto last_flush = std::chrono::steady_clock::now();
 
-        while (m_running.load(std::memory_order_acquire) || !m_queue.empty())
+        while (m_running.load(std::memory_order_acquire) || !queues_empty())
         {
             batch.clear();
-            // The popped count is not needed here; the batch.empty() check below decides between the write path and the
-            // idle-flush path.
-            (void)m_queue.try_pop_batch(batch, m_config.batch_size);
+            const size_t collected = collect_batch(batch, popped, batch_limit);
+            if (collected >= batch_limit)
+            {
+                batch_limit = std::min(batch_limit * 2, max_batch);
+            }
+            else if (collected < batch_limit / 4)
+            {
+                batch_limit = std::max(batch_limit / 2, min_batch);
+            }
 
             if (!batch.empty())
             {
+                // Taken before the batch is released, so it counts the batch in hand as well as what is still queued.
+                DMK_PROFILE_COUNTER("log_queue_depth", pending_total());
                 write_batch(batch);
-                const size_t batch_size = batch.size();
                 {
                     std::lock_guard<std::mutex> flock(m_flush_mutex);
-                    m_pending_messages.fetch_sub(batch_size, std::memory_order_acq_rel);
+                    release_pending(popped);
                 }
                 m_flush_cv.notify_all();
                 last_flush = std::chrono::steady_clock::now();
@@ -820,12 +1491,12 @@ namespace DetourModKit
                 // cooperative yields to let that push land; the common in-flight window is a few
                 // instructions, so the producer usually publishes here and the next pop drains it. The cap
                 // bounds the spin: if the producer is preempted past the cap, the loop falls through to the
-                // wait_for below, but with pending still non-zero the predicate is already satisfied, so it
+                // park below, but with pending still non-zero the pre-park check skips the wait, so it
                 // returns without blocking and the next cycle spins again -- bounded each pass rather than a
                 // tight hot loop. The writer only truly blocks once pending reaches zero (the genuinely idle
                 // case), where notify_writer() or the flush-interval timeout wakes it.
                 for (size_t spin = 0; spin < INFLIGHT_SPIN_LIMIT && m_running.load(std::memory_order_acquire) &&
-                                      m_pending_messages.load(std::memory_order_seq_cst) != 0 && m_queue.empty();
+                                      pending_total() != 0 && queues_empty();
                      ++spin)
                 {
                     std::this_thread::yield();
@@ -837,24 +1508,24 @@ namespace DetourModKit
                     std::lock_guard<std::mutex> lock(*m_log_mutex);
                     if (m_file_stream->is_open())
                     {
+                        end_repeat_run();
                         m_file_stream->flush();
+                        flush_structured();
                     }
                     last_flush = now;
                 }
 
-                std::unique_lock<std::mutex> lock(m_flush_mutex);
-
-                // Publish that the writer is about to park, then check the producer-maintained pending
-                // count while m_writer_waiting is still true. In the seq_cst order, a racing producer is
-                // either counted here or observes m_writer_waiting in notify_writer() and signals this
-                // condition variable under m_flush_mutex.
+                // Publish that the writer is about to park and read the wake epoch, then check the
+                // producer-maintained pending count while m_writer_waiting is still true. In the seq_cst order, a
+                // racing producer is either counted here or observes m_writer_waiting in notify_writer() and bumps
+                // the epoch past the value read here, so WaitOnAddress returns at once instead of sleeping. Waking
+                // spuriously or on the timeout just runs one more pass of this loop.
                 m_writer_waiting.store(true, std::memory_order_seq_cst);
-                m_flush_cv.wait_for(lock, m_config.flush_interval,
-                                    [this]() noexcept
-                                    {
-                                        return m_pending_messages.load(std::memory_order_seq_cst) != 0 ||
-                                               !m_running.load(std::memory_order_acquire);
-                                    });
+                std::uint32_t epoch = m_wake_epoch.load(std::memory_order_seq_cst);
+                if (pending_total() == 0 && m_running.load(std::memory_order_acquire))
+                {
+                    (void)WaitOnAddress(static_cast<volatile void *>(&m_wake_epoch), &epoch, sizeof(epoch), park_ms);
+                }
                 m_writer_waiting.store(false, std::memory_order_seq_cst);
             }
         }
@@ -863,13 +1534,15 @@ namespace DetourModKit
             std::lock_guard<std::mutex> lock(*m_log_mutex);
             if (m_file_stream->is_open())
             {
+                end_repeat_run();
                 m_file_stream->flush();
+                flush_structured();
             }
         }
 
         {
             std::lock_guard<std::mutex> lock(m_flush_mutex);
-            m_pending_messages.store(0, std::memory_order_release);
+            zero_pending();
             m_flush_cv.notify_all();
         }
     }
@@ -880,15 +1553,24 @@ namespace DetourModKit
         // writer_thread_func). Under OOM a drain iteration may pop fewer items or none; the loop then exits with
         // some messages still queued, which is the correct fail-closed shutdown behaviour (never a terminate).
         std::vector<LogMessage> remaining;
-        while (m_queue.try_pop_batch(remaining, m_config.batch_size) > 0)
+        PoppedCounts popped{};
+        while (collect_batch(remaining, popped, m_config.batch_size) > 0)
         {
             write_batch(remaining);
             remaining.clear();
         }
+
+        std::lock_guard<std::mutex> lock(*m_log_mutex);
+        if (m_file_stream->is_open() && m_file_stream->good())
+        {
+            end_repeat_run();
+        }
+        flush_structured();
     }
 
     void AsyncLogger::Impl::write_batch(std::span<LogMessage> messages) noexcept
     {
+        DMK_PROFILE_SCOPE("log_write_batch");
         std::lock_guard<std::mutex> lock(*m_log_mutex);
 
         if (!m_file_stream->is_open() || !m_file_stream->good())
@@ -896,38 +1578,39 @@ namespace DetourModKit
             return;
         }
 
-        // Cache the localtime result across consecutive messages that share the same second to avoid repeated CRT lock
-        // acquisition inside localtime_s.
-        std::time_t cached_second{-1};
-        std::tm cached_tm{};
-
         for (const auto &msg : messages)
         {
-            const auto time_t = std::chrono::system_clock::to_time_t(msg.timestamp);
-
-            if (time_t != cached_second)
-            {
-                cached_second = time_t;
-#if defined(_WIN32) || defined(_MSC_VER)
-                localtime_s(&cached_tm, &time_t);
-#else
-                localtime_r(&time_t, &cached_tm);
+#ifdef DMK_ENABLE_PROFILING
+            DMK_PROFILE_FLOW_END("log_message", msg.flow_id);
 #endif
+            if (msg.structured && m_kv_writer)
+            {
+                (void)write_structured(msg);
+                continue;
+            }
+            const std::string_view text = text_of(msg);
+            if (msg.deferred && m_crash_ring)
+            {
+                // A deferred record has no text until now; plain lines were mirrored by their producer.
+                m_crash_ring->append(msg.level, msg.timestamp, text);
+            }
+            if (!absorb_repeat(msg.timestamp, msg.level, text))
+            {
+                write_line(msg.timestamp, msg.level, text);
             }
-
-            const auto ms =
-                std::chrono::duration_cast<std::chrono::milliseconds>(msg.timestamp.time_since_epoch()) % 1000;
-
-            *m_file_stream << "[" << std::put_time(&cached_tm, m_config.timestamp_format.c_str()) << "."
-                           << std::setfill('0') << std::setw(3) << ms.count() << std::setfill(' ') << "] "
-                           << "[" << std::setw(7) << std::left << to_string(msg.level) << "] :: " << msg.message()
-                           << '\n';
         }
 
-        m_file_stream->flush();
+        // Hand the batch to the OS without waiting on it: under overlapped_writes the page goes out while the writer
+        // returns to the queue. Under flush_threshold small batches keep collecting; the idle flush and flush() pick
+        // up what is left.
+        if (m_file_stream->buffered() >= m_config.flush_threshold)
+        {
+            m_file_stream->submit();
+        }
     }
 
-    bool AsyncLogger::Impl::handle_overflow(LogMessage &&message) noexcept
+    bool AsyncLogger::Impl::handle_overflow(detail::DynamicMPMCQueue &queue, std::atomic<size_t> &pending,
+                                            LogMessage &&message) noexcept
     {
         switch (m_config.overflow_policy)
         {
@@ -938,18 +1621,18 @@ namespace DetourModKit
         case OverflowPolicy::DropOldest:
         {
             LogMessage oldest;
-            if (m_queue.try_pop(oldest))
+            if (queue.try_pop(oldest))
             {
                 // Count the evicted oldest message as dropped
                 m_dropped_messages.fetch_add(1, std::memory_order_relaxed);
-                if (m_queue.try_push(message))
+                if (queue.try_push(message))
                 {
-                    // Net effect on m_pending_messages: pop(-1) + push(+1) = 0
+                    // Net effect on the pending count: pop(-1) + push(+1) = 0
                     notify_writer();
                     return true;
                 }
                 // Pop succeeded but push failed: net -1
-                m_pending_messages.fetch_sub(1, std::memory_order_seq_cst);
+                pending.fetch_sub(1, std::memory_order_seq_cst);
             }
             // Count the new message as dropped (separate from the evicted oldest above). m_dropped_messages counts
             // individual lost messages, not overflow events.
@@ -963,11 +1646,11 @@ namespace DetourModKit
             size_t spin_count = 0;
 
             // Pre-increment so flush sees the in-flight message throughout the retry loop
-            m_pending_messages.fetch_add(1, std::memory_order_seq_cst);
+            pending.fetch_add(1, std::memory_order_seq_cst);
 
             while (std::chrono::steady_clock::now() < deadline)
             {
-                if (m_queue.try_push(message))
+                if (queue.try_push(message))
                 {
                     notify_writer();
                     return true;
@@ -988,7 +1671,7 @@ namespace DetourModKit
                 }
             }
             // Timed out -- undo the pre-increment
-            m_pending_messages.fetch_sub(1, std::memory_order_seq_cst);
+            pending.fetch_sub(1, std::memory_order_seq_cst);
             m_dropped_messages.fetch_add(1, std::memory_order_relaxed);
             return false;
         }
@@ -1001,21 +1684,19 @@ namespace DetourModKit
                 return false;
             }
 
-            const auto time_t = std::chrono::system_clock::to_time_t(message.timestamp);
-            std::tm tm_buf{};
-
-#if defined(_WIN32) || defined(_MSC_VER)
-            localtime_s(&tm_buf, &time_t);
-#else
-            localtime_r(&time_t, &tm_buf);
-#endif
-
-            const auto ms =
-                std::chrono::duration_cast<std::chrono::milliseconds>(message.timestamp.time_since_epoch()) % 1000;
-            *m_file_stream << "[" << std::put_time(&tm_buf, m_config.timestamp_format.c_str()) << "."
-                           << std::setfill('0') << std::setw(3) << ms.count() << std::setfill(' ') << "] "
-                           << "[" << std::setw(7) << std::left << to_string(message.level)
-                           << "] :: " << message.message() << '\n';
+            if (message.structured && m_kv_writer)
+            {
+                const bool written = write_structured(message);
+                m_kv_stream->flush();
+                return written && !m_kv_stream->fail();
+            }
+            const std::string_view text = text_of(message);
+            if (message.deferred && m_crash_ring)
+            {
+                m_crash_ring->append(message.level, message.timestamp, text);
+            }
+            end_repeat_run();
+            write_line(message.timestamp, message.level, text);
             m_file_stream->flush();
 
             if (m_file_stream->fail())
@@ -1080,6 +1761,21 @@ namespace DetourModKit
         return m_impl->enqueue(level, message);
     }
 
+    bool AsyncLogger::enqueue_deferred(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        return m_impl->enqueue_deferred(level, record);
+    }
+
+    bool AsyncLogger::enqueue_structured(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        return m_impl->enqueue_structured(level, record);
+    }
+
+    bool AsyncLogger::admit_call_site(std::uint64_t site) noexcept
+    {
+        return m_impl->admit_call_site(site);
+    }
+
     bool AsyncLogger::flush_with_timeout(std::chrono::milliseconds timeout) noexcept
     {
         return m_impl->flush_with_timeout(timeout);
@@ -1090,6 +1786,11 @@ namespace DetourModKit
         m_impl->flush();
     }
 
+    bool AsyncLogger::drain_at_process_exit() noexcept
+    {
+        return m_impl->drain_at_process_exit();
+    }
+
     void AsyncLogger::shutdown() noexcept
     {
         m_impl->shutdown();
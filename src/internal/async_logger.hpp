@@ -6,8 +6,10 @@
 
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 
@@ -81,6 +83,32 @@ namespace DetourModKit
          */
         [[nodiscard]] bool enqueue(LogLevel level, std::string_view message) noexcept;
 
+        /**
+         * @brief Enqueues a deferred record (detail::DeferredLogHeader plus packed arguments) for the writer to render.
+         * @param level The log level.
+         * @param record The record built by Logger; at most LOG_INLINE_MESSAGE_SIZE bytes.
+         * @return Same delivery contract as enqueue(). After shutdown() the record is rendered and written on the
+         *         calling thread, like a late enqueue().
+         */
+        [[nodiscard]] bool enqueue_deferred(LogLevel level, std::span<const std::byte> record) noexcept;
+
+        /**
+         * @brief Enqueues a structured record (detail::KvLogHeader plus packed fields) built by Logger::log_kv().
+         * @details The writer encodes it into AsyncLoggerConfig::structured_log_path; without a structured log it is
+         *          queued as a deferred record and written as a text line.
+         * @return Same delivery contract as enqueue(). After shutdown() the record is written on the calling thread.
+         */
+        [[nodiscard]] bool enqueue_structured(LogLevel level, std::span<const std::byte> record) noexcept;
+
+        /**
+         * @brief Takes a token from the rate-limit bucket of call site @p site.
+         * @param site A non-zero hash identifying the call site (Logger derives it from the LocatedFormat location).
+         * @return false when the site is over AsyncLoggerConfig::rate_limit_per_second; the line is then counted in
+         *         dropped_count() and the caller must not enqueue it. Always true when rate limiting is off.
+         * @note Callback-safe: lock-free and allocation-free.
+         */
+        [[nodiscard]] bool admit_call_site(std::uint64_t site) noexcept;
+
         /**
          * @brief Flushes all pending log messages with a timeout.
          * @param timeout Maximum time to wait for flush to complete.
@@ -95,6 +123,14 @@ namespace DetourModKit
          */
         void flush() noexcept;
 
+        /**
+         * @brief Drains the queue on the calling thread and flushes the file, for a process that is already exiting.
+         * @details The writer thread has been terminated by the OS, so nothing else will empty the queue. The sink
+         *          lock is only tried, since a terminated thread may have died holding it.
+         * @return false when the sink lock was held and nothing was written.
+         */
+        [[nodiscard]] bool drain_at_process_exit() noexcept;
+
         /**
          * @brief Stops the writer thread and drains remaining queued messages.
          * @details Signals shutdown. Off the Windows loader lock, joins the writer thread, then drains any messages
@@ -111,18 +147,19 @@ namespace DetourModKit
         [[nodiscard]] bool is_running() const noexcept;
 
         /**
-         * @brief Reports whether the writer thread is currently parked on the flush condition variable.
+         * @brief Reports whether the writer thread is currently parked waiting for a message.
          * @details Observability accessor for the idle-park state set by the writer immediately before it
-         *          blocks in wait_for and cleared when it wakes. Lets a test or diagnostic confirm the
-         *          writer has reached the parked path deterministically instead of relying on a fixed
-         *          sleep. The flag can flip at any time, so treat the result as a point-in-time snapshot.
+         *          blocks in WaitOnAddress and cleared when it wakes (or when a producer claims the wake).
+         *          Lets a test or diagnostic confirm the writer has reached the parked path deterministically
+         *          instead of relying on a fixed sleep. The flag can flip at any time, so treat the result as a
+         *          point-in-time snapshot.
          */
         [[nodiscard]] bool is_writer_waiting() const noexcept;
 
         [[nodiscard]] size_t queue_size() const noexcept;
 
         /**
-         * @brief Returns the total number of messages dropped due to queue overflow.
+         * @brief Returns the total number of messages dropped due to queue overflow or call-site rate limiting.
          * @return size_t Number of dropped messages.
          */
         [[nodiscard]] size_t dropped_count() const noexcept;
@@ -4,8 +4,9 @@
 /**
  * @file internal/async_logger_queue.hpp
  * @brief True-private async-logger transport: the overflow string pool, the per-message record, and the MPMC queue.
- * @details Houses the overflow string pool (StringPool), the per-message transport record (LogMessage), and the
- *          bounded Vyukov MPMC ring buffer (DynamicMPMCQueue), all in namespace DetourModKit::detail. It is never
+ * @details Houses the overflow string pool (StringPool), the per-message transport record (LogMessage), the
+ *          bounded Vyukov MPMC ring buffer (DynamicMPMCQueue), and the per-thread lane table (LogLaneTable), all in
+ *          namespace DetourModKit::detail. It is never
  *          installed: AsyncLogger holds these behind its pimpl (see src/async_logger.cpp), so no installed header names
  *          them and a consumer compiles without the queue/pool/threading internals on its include path. Only the
  *          AsyncLogger pimpl translation unit and the async-logger white-box tests reach in here.
@@ -20,6 +21,7 @@
 #include <cstdint>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -28,35 +30,62 @@ namespace DetourModKit::detail
 {
     /// Maximum length, in bytes, of a single log message.
     inline constexpr size_t MAX_MESSAGE_SIZE = 16777216;
+    /**
+     * @brief Slot capacities, in bytes including the terminator, of the StringPool size classes.
+     * @details A request is served from the smallest class whose capacity holds it, so a short overflow line never
+     *          pins a buffer sized for the longest one.
+     */
+    inline constexpr std::array<size_t, 4> POOL_SIZE_CLASSES = {64, 256, 1024, 4096};
     /**
      * @brief Largest request size the StringPool serves from a slot; a larger request falls back to a
      *        nothrow heap string.
      * @details A request-size ceiling, not the byte size of a Block: a Block holds POOL_SLOTS_PER_BLOCK slots, so its
      *          data array is POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot) bytes, unrelated to this value.
      */
-    inline constexpr size_t MAX_POOLED_STRING_SIZE = 4095;
-    /// Number of overflow blocks the StringPool preallocates.
+    inline constexpr size_t MAX_POOLED_STRING_SIZE = POOL_SIZE_CLASSES.back() - 1;
+    /// Most blocks the StringPool grows per size class.
     inline constexpr size_t MEMORY_POOL_BLOCK_COUNT = 64;
     /// Number of allocation slots carved from each StringPool block.
     inline constexpr size_t POOL_SLOTS_PER_BLOCK = 16;
+    /// Thread-id-hashed magazine shards in front of each StringPool depot.
+    inline constexpr size_t POOL_CACHE_SHARDS = 16;
+    /// Free slots one magazine holds; a refill or spill moves half of it to or from the depot at once.
+    inline constexpr size_t POOL_MAGAZINE_SIZE = 8;
 
     /**
      * @class StringPool
-     * @brief Memory pool for small string allocations to reduce heap fragmentation.
-     * @details Uses a free-list approach for O(1) allocation/deallocation. Blocks are allocated on-demand up to
-     *          MEMORY_POOL_BLOCK_COUNT. Each block is cache-line aligned to prevent false sharing.
+     * @brief Size-classed slab pool for the overflow strings of long log messages.
+     * @details Each size class has a depot: a mutex-guarded free list over blocks of POOL_SLOTS_PER_BLOCK slots,
+     *          grown on demand up to MEMORY_POOL_BLOCK_COUNT blocks. In front of the depots sit POOL_CACHE_SHARDS
+     *          magazine shards picked by a hash of the thread id (the same striping the hook call gate uses), each
+     *          holding up to POOL_MAGAZINE_SIZE free slots per class behind a try-lock flag. allocate() and
+     *          deallocate() touch only their shard's magazine in the common case and reach the depot once per half a
+     *          magazine, moving POOL_MAGAZINE_SIZE / 2 slots in one locked pass; a thread that finds its shard busy
+     *          goes to the depot directly rather than wait. Producers allocate and the writer frees, so the writer's
+     *          shard spills to the depot and the producers' shards refill from it.
+     *
+     *          A slot's string is reserved to its class capacity on first use and is released back to that size if a
+     *          caller grew it past the class, so a slot never keeps a larger buffer than its class. Every string the
+     *          pool hands out, heap fallbacks included, is the first member of a PoolSlot tagged with its class, which
+     *          makes deallocate() O(1) with no block walk.
      *
      * @note The singleton returned by instance() is intentionally leaked to avoid the static destruction order fiasco
      *       with late LogMessage teardown. Neither request_shutdown() nor the Session teardown reclaim it; the OS
-     *       releases the memory at process exit. The leak is bounded to MEMORY_POOL_BLOCK_COUNT blocks, each carrying a
-     *       POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot)-byte slot array.
+     *       releases the memory at process exit. The leak is bounded to MEMORY_POOL_BLOCK_COUNT blocks per size class,
+     *       each carrying a POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot)-byte slot array plus its slots' class buffers.
      */
+#ifdef _MSC_VER
+#pragma warning(push)
+// structure was padded due to alignment specifier
+#pragma warning(disable : 4324)
+#endif
     class StringPool
     {
     public:
         static StringPool &instance() noexcept;
 
         [[nodiscard]] std::string *allocate(size_t size) noexcept;
+        /// Returns @p ptr, which must come from allocate(), to the pool. Null is a no-op.
         void deallocate(std::string *ptr) noexcept;
 
         StringPool(const StringPool &) = delete;
@@ -65,10 +94,15 @@ namespace DetourModKit::detail
         StringPool &operator=(StringPool &&) = delete;
 
     private:
+        static constexpr size_t CLASS_COUNT = POOL_SIZE_CLASSES.size();
+        // The size_class tag of a heap-fallback slot, which deallocate() deletes instead of pooling.
+        static constexpr std::uint8_t HEAP_CLASS = 0xFF;
+
         struct PoolSlot
         {
             std::string str;
             PoolSlot *next_free{nullptr};
+            std::uint8_t size_class{HEAP_CLASS};
         };
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -84,26 +118,55 @@ namespace DetourModKit::detail
         {
             alignas(64) char data[POOL_SLOTS_PER_BLOCK * sizeof(PoolSlot)];
             Block *next{nullptr};
-            PoolSlot *free_list{nullptr};
             uint32_t constructed_mask{0};
         };
 
+        // One size class's backing store; every field is guarded by mutex.
+        struct Depot
+        {
+            std::mutex mutex;
+            Block *blocks{nullptr};
+            size_t block_count{0};
+            PoolSlot *free_list{nullptr};
+        };
+
+        // One shard's cache of free slots for one size class, owned by whoever set busy.
+        struct alignas(64) Magazine
+        {
+            std::atomic_flag busy;
+            size_t count{0};
+            std::array<PoolSlot *, POOL_MAGAZINE_SIZE> slots{};
+        };
+
         StringPool() noexcept;
         ~StringPool() noexcept;
 
+        /// The smallest size class holding a @p size -byte string; @p size is at most MAX_POOLED_STRING_SIZE.
+        [[nodiscard]] static size_t size_class_of(size_t size) noexcept;
+        /// The calling thread's magazine shard.
+        [[nodiscard]] static size_t shard_index() noexcept;
+
         /**
-         * @brief Appends one block to the pool. Must be called with m_pool_mutex held.
-         * @details No-throw: an allocation failure leaves the pool unchanged so
-         *          callers can fall back to a nothrow heap string instead of throwing out of the logging path.
+         * @brief Appends one block to @p depot. Must be called with the depot's mutex held.
+         * @details No-throw: an allocation failure, or a depot already at MEMORY_POOL_BLOCK_COUNT blocks, leaves it
+         *          unchanged so callers can fall back to a nothrow heap string instead of throwing out of the logging
+         *          path.
          */
-        void grow_pool_locked() noexcept;
-        PoolSlot *claim_free_slot() noexcept;
-        void return_slot_locked(PoolSlot *slot, Block *block) noexcept;
-
-        std::atomic<Block *> m_head{nullptr};
+        void grow_depot_locked(Depot &depot, size_t size_class) noexcept;
+        /// Moves up to @p count free slots of @p size_class into @p out, growing the depot once if it is empty.
+        [[nodiscard]] size_t take_from_depot(size_t size_class, PoolSlot **out, size_t count) noexcept;
+        /// Returns @p count slots of @p size_class to its depot's free list.
+        void return_to_depot(size_t size_class, PoolSlot *const *slots, size_t count) noexcept;
+        /// A fresh heap-fallback string, or nullptr when even that allocation fails.
+        [[nodiscard]] std::string *heap_string() noexcept;
+
+        std::array<Depot, CLASS_COUNT> m_depots;
+        std::array<std::array<Magazine, CLASS_COUNT>, POOL_CACHE_SHARDS> m_magazines;
         std::atomic<size_t> m_heap_fallback_count{0};
-        std::mutex m_pool_mutex;
     };
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
 
     /**
      * @struct LogMessage
@@ -130,7 +193,20 @@ namespace DetourModKit::detail
         // Owned: allocated by StringPool, freed by reset().
         std::string *overflow{nullptr};
 
+        // Set when buffer holds a deferred record (detail::DeferredLogHeader and packed arguments) rather than text;
+        // the writer renders it through the header's render function instead of reading message().
+        bool deferred{false};
+        // Set, together with deferred, when the record is a log_kv() one (detail::KvLogHeader and packed fields); the
+        // writer hands it to the structured log when there is one and renders it as text otherwise.
+        bool structured{false};
+#ifdef DMK_ENABLE_PROFILING
+        // The profiler flow joining the producer's enqueue to the writer's write of this message.
+        std::uint64_t flow_id{0};
+#endif
+
         LogMessage(LogLevel lvl, std::string_view msg) noexcept;
+        // A deferred message carrying @p record; a record larger than the inline buffer is dropped (length 0).
+        LogMessage(LogLevel lvl, std::span<const std::byte> record) noexcept;
         LogMessage() noexcept = default;
 
         ~LogMessage() noexcept;
@@ -255,6 +331,111 @@ namespace DetourModKit::detail
         alignas(64) std::atomic<size_t> m_dequeue_pos{0};
     };
 
+    /// Most producer lanes one LogLaneTable hands out; a thread arriving after that uses the shared queue.
+    inline constexpr size_t MAX_LOG_LANES = 64;
+
+    /**
+     * @class LogLaneTable
+     * @brief The per-thread producer lanes behind LogTransport::PerThreadLanes.
+     * @details A fixed open-addressing table of MAX_LOG_LANES entries keyed by thread id. A thread's first message
+     *          claims an entry by compare-exchanging its id into `owner` and publishes a freshly built lane; every
+     *          later message finds that entry on the same probe sequence without writing anything shared. A claimed
+     *          entry is never released: a thread that exits leaves its lane behind, and a later thread the OS gives
+     *          the same id adopts it, which keeps each lane single-producer because the old owner is gone.
+     *
+     *          A lane is a DynamicMPMCQueue with exactly one producer, so its enqueue CAS is uncontended rather than
+     *          the point every producer serializes on. The MPMC protocol is kept (instead of a plain SPSC ring) because
+     *          OverflowPolicy::DropOldest evicts from the producer side, which makes the producer a second consumer.
+     *          Each lane carries its own pending count for the same reason the shared queue has one.
+     */
+    class LogLaneTable
+    {
+    public:
+        /// One thread's ring and the count of its messages not yet written.
+        struct Lane
+        {
+            explicit Lane(size_t capacity) : queue(capacity) {}
+
+            DynamicMPMCQueue queue;
+            alignas(64) std::atomic<size_t> pending{0};
+        };
+
+        explicit LogLaneTable(size_t lane_capacity) noexcept : m_lane_capacity(lane_capacity) {}
+        ~LogLaneTable() noexcept;
+
+        LogLaneTable(const LogLaneTable &) = delete;
+        LogLaneTable &operator=(const LogLaneTable &) = delete;
+        LogLaneTable(LogLaneTable &&) = delete;
+        LogLaneTable &operator=(LogLaneTable &&) = delete;
+
+        /**
+         * @brief The calling thread's lane, built on first use.
+         * @return nullptr when the table is full or the lane could not be allocated; the caller then logs through
+         *         the shared queue.
+         */
+        [[nodiscard]] Lane *lane_for_current_thread() noexcept;
+
+        /// Lane @p index (below MAX_LOG_LANES), or nullptr while that entry has no published lane.
+        [[nodiscard]] Lane *lane(size_t index) const noexcept
+        {
+            return m_entries[index].lane.load(std::memory_order_seq_cst);
+        }
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint32_t> owner{0};
+            std::atomic<Lane *> lane{nullptr};
+        };
+
+        const size_t m_lane_capacity;
+        std::array<Entry, MAX_LOG_LANES> m_entries{};
+    };
+
+    /// Call sites a CallSiteRateLimiter tracks; a site past a full probe sequence is not limited.
+    inline constexpr size_t RATE_LIMIT_SITES = 256;
+
+    /**
+     * @class CallSiteRateLimiter
+     * @brief A token bucket per log call site, behind AsyncLoggerConfig::rate_limit_per_second.
+     * @details A fixed open-addressing table of RATE_LIMIT_SITES entries keyed by a non-zero call-site hash. A site's
+     *          first line claims an entry by compare-exchanging its key in; the entry is never released. Each bucket is
+     *          one 64-bit word, the millisecond its tokens were last counted (upper 40 bits) and the token count (lower
+     *          24), updated with one compare-exchange, so producers never take a lock. A fresh entry starts full.
+     *          When the probe sequence finds no entry for a new site the line is admitted: the limiter fails open
+     *          rather than silencing a site it cannot track.
+     */
+    class CallSiteRateLimiter
+    {
+    public:
+        /// Largest burst a bucket can hold (the 24-bit token field).
+        static constexpr std::uint64_t MAX_BURST = (std::uint64_t{1} << 24) - 1;
+
+        CallSiteRateLimiter(std::uint64_t per_second, std::uint64_t burst) noexcept
+            : m_per_second(per_second), m_burst(burst)
+        {
+        }
+
+        /**
+         * @brief Takes a token from @p site's bucket at time @p now_ms.
+         * @return false when the bucket is empty and the line should be suppressed.
+         */
+        [[nodiscard]] bool admit(std::uint64_t site, std::uint64_t now_ms) noexcept;
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> key{0};
+            std::atomic<std::uint64_t> bucket{0};
+        };
+
+        [[nodiscard]] bool take(std::atomic<std::uint64_t> &bucket, std::uint64_t now_ms) const noexcept;
+
+        const std::uint64_t m_per_second;
+        const std::uint64_t m_burst;
+        std::array<Entry, RATE_LIMIT_SITES> m_entries{};
+    };
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -0,0 +1,1077 @@
+/**
+ * @file internal/background_service.cpp
+ * @brief The shared background thread: a timer wheel and a WaitForMultipleObjects handle set.
+ * @details Tasks are owned by the service's task list. The wheel links timers intrusively through the tasks
+ *          themselves, and a round's due tasks are chained the same way, so serving a round never allocates. A task
+ *          that is cancelled while it runs stays in the list until its run returns; the service retires it then.
+ *
+ *          The service's state is built once in static storage and never destroyed, for the same reason as the
+ *          fork-join pool's: a service thread detached under the loader lock may still be running when static
+ *          destructors do.
+ *
+ *          While this instance is attached to another as its host (internal/shared_services.hpp), a new task's record
+ *          stays in the task list but never enters the wheel or the wait set: the host runs it, calling back through
+ *          run_delegated() with the task's id, and the record's running flag keeps cancel() and the retire rules
+ *          exactly as they are for a task run here.
+ */
+
+#include "internal/background_service.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+#include "DetourModKit/logger.hpp"
+#include "internal/shared_services.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "platform.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+            static_assert(BACKGROUND_WHEEL_SLOTS % 64 == 0, "The occupancy bitmap is whole 64-bit words.");
+            constexpr std::size_t WHEEL_WORDS = BACKGROUND_WHEEL_SLOTS / 64;
+            /// Longest single wait; keeps the DWORD timeout well clear of INFINITE.
+            constexpr std::uint64_t MAX_WAIT_TICKS = BACKGROUND_WHEEL_SLOTS;
+
+            struct BackgroundTask
+            {
+                BackgroundTaskId id{NO_BACKGROUND_TASK};
+                std::string name;
+                std::function<void()> body;
+                /// Timer period in ticks; 0 for a handle watch.
+                std::uint64_t period_ticks{0};
+                HANDLE handle{nullptr};
+
+                /// The tick a timer is next due at; meaningful while it is in the wheel.
+                std::uint64_t deadline{0};
+                BackgroundTask *wheel_prev{nullptr};
+                BackgroundTask *wheel_next{nullptr};
+                bool in_wheel{false};
+
+                /// Chains the tasks one round of the service runs.
+                BackgroundTask *due_next{nullptr};
+                bool queued{false};
+                bool wake_requested{false};
+                bool running{false};
+                /// Read without the lock just before a run, to skip a task cancelled since it was queued.
+                std::atomic<bool> cancelled{false};
+
+                // Non-null while a host runs the task instead: the host's lease identity, and the task's id there
+                // (NO_BACKGROUND_TASK while the host is still registering it).
+                const void *delegated_to{nullptr};
+                BackgroundTaskId host_id{NO_BACKGROUND_TASK};
+                /// Registered for another instance through host_background_task().
+                bool hosted{false};
+            };
+
+            struct ServiceState
+            {
+                /// Serializes starting against shutting down; never held while a task runs.
+                std::mutex lifecycle_mutex;
+                std::unique_ptr<StoppableWorker> worker;
+
+                std::mutex mutex;
+                /// Signaled when a round's tasks have finished and when the service adopts a new handle set.
+                std::condition_variable idle_cv;
+                /// Auto-reset; wakes the service to re-read its tasks. Created once and never closed.
+                HANDLE wake_event{nullptr};
+                std::vector<std::unique_ptr<BackgroundTask>> tasks;
+                std::array<BackgroundTask *, BACKGROUND_WHEEL_SLOTS> wheel{};
+                /// Bit s is set while wheel[s] is non-empty.
+                std::array<std::uint64_t, WHEEL_WORDS> occupied{};
+                /// The last tick whose slot has been served.
+                std::uint64_t current_tick{0};
+                BackgroundTaskId next_id{1};
+                std::size_t pending_wakes{0};
+                std::size_t watched_handles{0};
+                // Bumped whenever a handle watch is added or removed; the service copies it when it rebuilds its wait
+                // set, so a cancel can tell when a handle is no longer waited on.
+                std::uint64_t handle_epoch{0};
+                std::uint64_t applied_handle_epoch{0};
+                /// Set while attached to a host; see set_background_delegation().
+                bool delegation_open{false};
+                /// Registrations between taking their record's id and learning the host's; idle_cv signals the last.
+                std::size_t pending_delegations{0};
+
+                std::atomic<DWORD> thread_id{0};
+                std::atomic<std::uint64_t> threads_started{0};
+            };
+
+            alignas(ServiceState) unsigned char s_service_storage[sizeof(ServiceState)];
+
+            /// Set on a host's service thread while it runs one of this instance's delegated tasks.
+            thread_local bool t_in_delegated_task = false;
+
+            /// Constructed on first use in static storage and never destroyed; see the file comment.
+            ServiceState &service_state() noexcept
+            {
+                static ServiceState *const state = ::new (static_cast<void *>(s_service_storage)) ServiceState();
+                return *state;
+            }
+
+            [[nodiscard]] std::uint64_t now_tick() noexcept
+            {
+                const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch());
+                return static_cast<std::uint64_t>(elapsed.count() / BACKGROUND_TIMER_TICK.count());
+            }
+
+            [[nodiscard]] std::size_t slot_of(std::uint64_t tick) noexcept
+            {
+                return static_cast<std::size_t>(tick % BACKGROUND_WHEEL_SLOTS);
+            }
+
+            /// Puts timer @p task in the slot of its next deadline, one period after max(@p now, the served tick).
+            void arm(ServiceState &state, BackgroundTask &task, std::uint64_t now) noexcept
+            {
+                task.deadline = std::max(now, state.current_tick) + task.period_ticks;
+                const std::size_t slot = slot_of(task.deadline);
+                task.wheel_prev = nullptr;
+                task.wheel_next = state.wheel[slot];
+                if (task.wheel_next != nullptr)
+                {
+                    task.wheel_next->wheel_prev = &task;
+                }
+                state.wheel[slot] = &task;
+                task.in_wheel = true;
+                state.occupied[slot / 64] |= std::uint64_t{1} << (slot % 64);
+            }
+
+            void disarm(ServiceState &state, BackgroundTask &task) noexcept
+            {
+                if (!task.in_wheel)
+                {
+                    return;
+                }
+                const std::size_t slot = slot_of(task.deadline);
+                if (task.wheel_prev != nullptr)
+                {
+                    task.wheel_prev->wheel_next = task.wheel_next;
+                }
+                else
+                {
+                    state.wheel[slot] = task.wheel_next;
+                }
+                if (task.wheel_next != nullptr)
+                {
+                    task.wheel_next->wheel_prev = task.wheel_prev;
+                }
+                if (state.wheel[slot] == nullptr)
+                {
+                    state.occupied[slot / 64] &= ~(std::uint64_t{1} << (slot % 64));
+                }
+                task.wheel_prev = nullptr;
+                task.wheel_next = nullptr;
+                task.in_wheel = false;
+            }
+
+            /// Appends @p task to the round's due chain unless it is already on it.
+            void queue(BackgroundTask *&head, BackgroundTask *&tail, BackgroundTask &task) noexcept
+            {
+                if (task.queued)
+                {
+                    return;
+                }
+                task.queued = true;
+                task.due_next = nullptr;
+                (tail != nullptr ? tail->due_next : head) = &task;
+                tail = &task;
+            }
+
+            /// Milliseconds until the first tick after the served one whose slot holds a timer; INFINITE when none.
+            [[nodiscard]] DWORD next_timeout(const ServiceState &state, std::uint64_t now) noexcept
+            {
+                const std::size_t start = slot_of(state.current_tick + 1);
+                std::size_t scanned = 0;
+                while (scanned < BACKGROUND_WHEEL_SLOTS)
+                {
+                    const std::size_t slot = (start + scanned) % BACKGROUND_WHEEL_SLOTS;
+                    const std::size_t bit = slot % 64;
+                    const std::uint64_t word = state.occupied[slot / 64] >> bit;
+                    if (word == 0)
+                    {
+                        scanned += 64 - bit;
+                        continue;
+                    }
+                    const std::size_t distance = scanned + static_cast<std::size_t>(std::countr_zero(word));
+                    if (distance >= BACKGROUND_WHEEL_SLOTS)
+                    {
+                        break;
+                    }
+                    const std::uint64_t target = state.current_tick + 1 + distance;
+                    const std::uint64_t ticks = target > now ? std::min(target - now, MAX_WAIT_TICKS) : 0;
+                    return static_cast<DWORD>(ticks * static_cast<std::uint64_t>(BACKGROUND_TIMER_TICK.count()));
+                }
+                return INFINITE;
+            }
+
+            /// Moves the timers due by @p now, and every woken timer, onto the due chain and re-arms them.
+            void collect_timers(ServiceState &state, std::uint64_t now, BackgroundTask *&head,
+                                BackgroundTask *&tail) noexcept
+            {
+                BackgroundTask *const first_new = tail;
+                if (state.pending_wakes != 0)
+                {
+                    for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                    {
+                        if (task->wake_requested)
+                        {
+                            task->wake_requested = false;
+                            disarm(state, *task);
+                            queue(head, tail, *task);
+                        }
+                    }
+                    state.pending_wakes = 0;
+                }
+
+                if (now > state.current_tick)
+                {
+                    // A wait longer than one rotation visits every slot once; deadlines decide what is due.
+                    const std::uint64_t steps =
+                        std::min<std::uint64_t>(now - state.current_tick, BACKGROUND_WHEEL_SLOTS);
+                    for (std::uint64_t step = 1; step <= steps; ++step)
+                    {
+                        const std::size_t slot = slot_of(state.current_tick + step);
+                        BackgroundTask *task = state.wheel[slot];
+                        while (task != nullptr)
+                        {
+                            BackgroundTask *const next = task->wheel_next;
+                            if (task->deadline <= now)
+                            {
+                                disarm(state, *task);
+                                queue(head, tail, *task);
+                            }
+                            task = next;
+                        }
+                    }
+                    state.current_tick = now;
+                }
+
+                for (BackgroundTask *task = first_new != nullptr ? first_new->due_next : head; task != nullptr;
+                     task = task->due_next)
+                {
+                    if (task->period_ticks != 0 && !task->cancelled.load(std::memory_order_relaxed))
+                    {
+                        arm(state, *task, now);
+                    }
+                }
+            }
+
+            [[nodiscard]] std::vector<std::unique_ptr<BackgroundTask>>::iterator find_task(ServiceState &state,
+                                                                                          BackgroundTaskId id) noexcept
+            {
+                return std::find_if(state.tasks.begin(), state.tasks.end(),
+                                    [id](const std::unique_ptr<BackgroundTask> &task) { return task->id == id; });
+            }
+
+            /// Stops watching every handle the wait rejected, so one closed handle cannot spin the service.
+            void drop_failed_handles(ServiceState &state) noexcept
+            {
+                for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                {
+                    if (task->handle == nullptr || task->delegated_to != nullptr ||
+                        task->cancelled.load(std::memory_order_relaxed) ||
+                        WaitForSingleObject(task->handle, 0) != WAIT_FAILED)
+                    {
+                        continue;
+                    }
+                    (void)log().try_log(LogLevel::Warning,
+                                        "BackgroundService: task '{}' watches a handle the wait rejected (error {}); "
+                                        "it will not run again.",
+                                        task->name, GetLastError());
+                    task->cancelled.store(true, std::memory_order_relaxed);
+                    --state.watched_handles;
+                    ++state.handle_epoch;
+                }
+            }
+
+            void run_task(const BackgroundTask &task) noexcept
+            {
+                try
+                {
+                    task.body();
+                }
+                catch (const std::exception &e)
+                {
+                    (void)log().try_log(LogLevel::Error, "BackgroundService: task '{}' threw: {}", task.name, e.what());
+                }
+                catch (...)
+                {
+                    (void)log().try_log(LogLevel::Error, "BackgroundService: task '{}' threw a non-std exception.",
+                                        task.name);
+                }
+            }
+
+            void service_loop(std::stop_token stop_token) noexcept
+            {
+                ServiceState &state = service_state();
+                const DWORD self = GetCurrentThreadId();
+                state.thread_id.store(self, std::memory_order_release);
+                std::stop_callback wake_on_stop(stop_token, [&state]() noexcept { SetEvent(state.wake_event); });
+
+                std::array<HANDLE, BACKGROUND_MAX_HANDLES + 1> handles{};
+                std::array<BackgroundTaskId, BACKGROUND_MAX_HANDLES + 1> owners{};
+                handles[0] = state.wake_event;
+                while (!stop_token.stop_requested())
+                {
+                    DWORD handle_count = 1;
+                    DWORD timeout = INFINITE;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                        {
+                            if (task->handle != nullptr && task->delegated_to == nullptr &&
+                                !task->cancelled.load(std::memory_order_relaxed) && handle_count < handles.size())
+                            {
+                                handles[handle_count] = task->handle;
+                                owners[handle_count] = task->id;
+                                ++handle_count;
+                            }
+                        }
+                        state.applied_handle_epoch = state.handle_epoch;
+                        timeout = next_timeout(state, now_tick());
+                    }
+                    state.idle_cv.notify_all();
+
+                    const DWORD signaled = WaitForMultipleObjects(handle_count, handles.data(), FALSE, timeout);
+
+                    BackgroundTask *head = nullptr;
+                    BackgroundTask *tail = nullptr;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        DWORD index = 0;
+                        if (signaled == WAIT_FAILED)
+                        {
+                            drop_failed_handles(state);
+                        }
+                        else if (signaled < WAIT_OBJECT_0 + handle_count)
+                        {
+                            index = signaled - WAIT_OBJECT_0;
+                        }
+                        else if (signaled >= WAIT_ABANDONED_0 && signaled < WAIT_ABANDONED_0 + handle_count)
+                        {
+                            index = signaled - WAIT_ABANDONED_0;
+                        }
+                        if (index != 0)
+                        {
+                            const auto owner = find_task(state, owners[index]);
+                            if (owner != state.tasks.end() && !(*owner)->cancelled.load(std::memory_order_relaxed))
+                            {
+                                queue(head, tail, **owner);
+                            }
+                        }
+                        collect_timers(state, now_tick(), head, tail);
+                        for (BackgroundTask *task = head; task != nullptr; task = task->due_next)
+                        {
+                            task->running = true;
+                        }
+                    }
+
+                    for (BackgroundTask *task = head; task != nullptr; task = task->due_next)
+                    {
+                        if (!stop_token.stop_requested() && !task->cancelled.load(std::memory_order_relaxed))
+                        {
+                            run_task(*task);
+                        }
+                    }
+
+                    if (head != nullptr)
+                    {
+                        // Destroyed after the lock is released, so a retired task's body never dies under it.
+                        std::vector<std::unique_ptr<BackgroundTask>> retired;
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        BackgroundTask *task = head;
+                        while (task != nullptr)
+                        {
+                            BackgroundTask *const next = task->due_next;
+                            task->running = false;
+                            task->queued = false;
+                            task->due_next = nullptr;
+                            if (task->cancelled.load(std::memory_order_relaxed))
+                            {
+                                const auto it = find_task(state, task->id);
+                                try
+                                {
+                                    retired.push_back(std::move(*it));
+                                }
+                                catch (...)
+                                {
+                                    // Out of memory: leak the task rather than destroy its body under the lock.
+                                    (void)it->release();
+                                }
+                                state.tasks.erase(it);
+                            }
+                            task = next;
+                        }
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    // A newer service may already be running when a detached one finally gets here.
+                    DWORD expected = self;
+                    (void)state.thread_id.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+                }
+                state.idle_cv.notify_all();
+            }
+
+            /// Starts the service thread unless one is running. Call with the lifecycle mutex held.
+            [[nodiscard]] Result<void> ensure_service_started(ServiceState &state, const char *where) noexcept
+            {
+                if (state.worker != nullptr)
+                {
+                    return {};
+                }
+                mark_subsystem_used(Subsystem::BackgroundService);
+                if (state.wake_event == nullptr)
+                {
+                    state.wake_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+                    if (state.wake_event == nullptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where, GetLastError()});
+                    }
+                }
+                try
+                {
+                    state.worker = std::make_unique<StoppableWorker>("BackgroundService", service_loop);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+                catch (const std::system_error &failure)
+                {
+                    return std::unexpected(
+                        Error{ErrorCode::SystemCallFailed, where, static_cast<std::uintptr_t>(failure.code().value())});
+                }
+                catch (...)
+                {
+                    return std::unexpected(Error{ErrorCode::SystemCallFailed, where});
+                }
+                state.threads_started.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+
+            /// The host's way back into a task delegated to it: @p context carries the task's id here.
+            void run_delegated(void *context) noexcept
+            {
+                ServiceState &state = service_state();
+                const auto id = static_cast<BackgroundTaskId>(reinterpret_cast<std::uintptr_t>(context));
+                BackgroundTask *task = nullptr;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    const auto it = find_task(state, id);
+                    if (it == state.tasks.end() || (*it)->delegated_to == nullptr ||
+                        (*it)->cancelled.load(std::memory_order_relaxed))
+                    {
+                        return;
+                    }
+                    task = it->get();
+                    task->running = true;
+                }
+
+                t_in_delegated_task = true;
+                run_task(*task);
+                t_in_delegated_task = false;
+
+                // Destroyed after the lock is released, as on the service thread.
+                std::unique_ptr<BackgroundTask> retired;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    task->running = false;
+                    if (task->cancelled.load(std::memory_order_relaxed))
+                    {
+                        const auto it = find_task(state, id);
+                        retired = std::move(*it);
+                        state.tasks.erase(it);
+                    }
+                }
+                state.idle_cv.notify_all();
+            }
+
+            /**
+             * @brief Hands @p task to the host when delegation is open and a host has its table out.
+             * @return The task's id, with @p task moved into the task list; NO_BACKGROUND_TASK when it stays here,
+             *         still in @p task.
+             */
+            [[nodiscard]] BackgroundTaskId delegate_task(ServiceState &state,
+                                                         std::unique_ptr<BackgroundTask> &task) noexcept
+            {
+                // Held until the host's id is recorded, so a host cannot withdraw between registering the task and
+                // this record learning where it went.
+                const HostSchedulerLease lease = lease_host_scheduler();
+                BackgroundTask *const record = task.get();
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    if (!state.delegation_open || !lease)
+                    {
+                        return NO_BACKGROUND_TASK;
+                    }
+                    try
+                    {
+                        state.tasks.reserve(state.tasks.size() + 1);
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        return NO_BACKGROUND_TASK;
+                    }
+                    record->id = state.next_id++;
+                    record->delegated_to = lease.host();
+                    ++state.pending_delegations;
+                    state.tasks.push_back(std::move(task));
+                }
+
+                // The host calls back into run_delegated(), which only needs the record, so it may run the task
+                // before its id lands below.
+                const auto period = std::chrono::milliseconds(
+                    static_cast<std::chrono::milliseconds::rep>(record->period_ticks) * BACKGROUND_TIMER_TICK.count());
+                const BackgroundTaskId host_id =
+                    lease.schedule(record->name, period, record->handle, run_delegated,
+                                   reinterpret_cast<void *>(static_cast<std::uintptr_t>(record->id)));
+
+                const BackgroundTaskId id = record->id;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    --state.pending_delegations;
+                    if (host_id != NO_BACKGROUND_TASK)
+                    {
+                        record->host_id = host_id;
+                    }
+                    else
+                    {
+                        // Refused: the caller registers it here after all, under a fresh id.
+                        const auto it = find_task(state, id);
+                        task = std::move(*it);
+                        state.tasks.erase(it);
+                        task->delegated_to = nullptr;
+                        task->id = NO_BACKGROUND_TASK;
+                    }
+                }
+                state.idle_cv.notify_all();
+                return host_id != NO_BACKGROUND_TASK ? id : NO_BACKGROUND_TASK;
+            }
+
+            /**
+             * @brief Closes delegation and cancels every delegated task on the host it went to.
+             * @details Waits out registrations still learning their host id first. The records stay in the list,
+             *          still marked delegated; a host that has already withdrawn its table cancelled them itself.
+             *          Allocation-free, so a teardown can always run it.
+             */
+            void withdraw_delegated(ServiceState &state) noexcept
+            {
+                {
+                    std::unique_lock<std::mutex> lock(state.mutex);
+                    state.delegation_open = false;
+                    state.idle_cv.wait(lock, [&state]() { return state.pending_delegations == 0; });
+                }
+                for (;;)
+                {
+                    const void *host = nullptr;
+                    BackgroundTaskId host_id = NO_BACKGROUND_TASK;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                        {
+                            if (task->delegated_to != nullptr && task->host_id != NO_BACKGROUND_TASK)
+                            {
+                                host = task->delegated_to;
+                                host_id = std::exchange(task->host_id, NO_BACKGROUND_TASK);
+                                break;
+                            }
+                        }
+                    }
+                    if (host_id == NO_BACKGROUND_TASK)
+                    {
+                        return;
+                    }
+                    // Waits for the host to finish a run in progress, so nothing of this task runs there afterwards.
+                    const HostSchedulerLease lease = lease_host_scheduler();
+                    if (lease && lease.host() == host)
+                    {
+                        (void)lease.cancel(host_id);
+                    }
+                }
+            }
+
+            /// Retires the delegated records withdraw_delegated() left; a running one is cancelled and retires itself.
+            void retire_withdrawn(ServiceState &state) noexcept
+            {
+                for (;;)
+                {
+                    // Destroyed after the lock is released, as on the service thread.
+                    std::unique_ptr<BackgroundTask> retired;
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    auto found = state.tasks.end();
+                    for (auto it = state.tasks.begin(); it != state.tasks.end(); ++it)
+                    {
+                        if ((*it)->delegated_to == nullptr)
+                        {
+                            continue;
+                        }
+                        (*it)->cancelled.store(true, std::memory_order_relaxed);
+                        if (!(*it)->running && found == state.tasks.end())
+                        {
+                            found = it;
+                        }
+                    }
+                    if (found == state.tasks.end())
+                    {
+                        return;
+                    }
+                    retired = std::move(*found);
+                    state.tasks.erase(found);
+                }
+            }
+
+            [[nodiscard]] Result<BackgroundTaskId> register_task(std::string_view name, std::uint64_t period_ticks,
+                                                                 HANDLE handle, std::function<void()> body,
+                                                                 const char *where, bool hosted = false) noexcept
+            {
+                ServiceState &state = service_state();
+                std::unique_ptr<BackgroundTask> task;
+                try
+                {
+                    task = std::make_unique<BackgroundTask>();
+                    task->name = std::string(name);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+                task->body = std::move(body);
+                task->period_ticks = period_ticks;
+                task->handle = handle;
+                task->hosted = hosted;
+                if (!hosted)
+                {
+                    if (const BackgroundTaskId delegated = delegate_task(state, task); delegated != NO_BACKGROUND_TASK)
+                    {
+                        return delegated;
+                    }
+                }
+
+                // A task registering another runs on the service thread, which is live; taking the lifecycle mutex
+                // there would deadlock against a shutdown joining this very thread.
+                std::unique_lock<std::mutex> lifecycle(state.lifecycle_mutex, std::defer_lock);
+                if (!on_background_service_thread())
+                {
+                    lifecycle.lock();
+                    if (auto started = ensure_service_started(state, where); !started)
+                    {
+                        return std::unexpected(started.error());
+                    }
+                }
+
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (handle != nullptr && state.watched_handles >= BACKGROUND_MAX_HANDLES)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, where, BACKGROUND_MAX_HANDLES});
+                }
+                try
+                {
+                    state.tasks.reserve(state.tasks.size() + 1);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+
+                task->id = state.next_id++;
+                if (handle != nullptr)
+                {
+                    ++state.watched_handles;
+                    ++state.handle_epoch;
+                }
+                else
+                {
+                    arm(state, *task, now_tick());
+                }
+                const BackgroundTaskId id = task->id;
+                state.tasks.push_back(std::move(task));
+                SetEvent(state.wake_event);
+                return id;
+            }
+        } // namespace
+
+        Result<BackgroundTaskId> schedule_background_timer(std::string_view name, std::chrono::milliseconds period,
+                                                           std::function<void()> task)
+        {
+            constexpr const char *where = "detail::schedule_background_timer";
+            if (!task || period <= std::chrono::milliseconds::zero())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            const auto tick = BACKGROUND_TIMER_TICK.count();
+            const auto period_ticks = static_cast<std::uint64_t>((period.count() + tick - 1) / tick);
+            return register_task(name, period_ticks, nullptr, std::move(task), where);
+        }
+
+        Result<BackgroundTaskId> watch_background_handle(std::string_view name, void *handle,
+                                                         std::function<void()> task)
+        {
+            constexpr const char *where = "detail::watch_background_handle";
+            if (handle == nullptr || handle == INVALID_HANDLE_VALUE || !task)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            return register_task(name, 0, static_cast<HANDLE>(handle), std::move(task), where);
+        }
+
+        void wake_background_task(BackgroundTaskId id) noexcept
+        {
+            if (id == NO_BACKGROUND_TASK)
+            {
+                return;
+            }
+            ServiceState &state = service_state();
+            const void *host = nullptr;
+            BackgroundTaskId host_id = NO_BACKGROUND_TASK;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                const auto it = find_task(state, id);
+                if (it == state.tasks.end() || (*it)->period_ticks == 0 || (*it)->wake_requested ||
+                    (*it)->cancelled.load(std::memory_order_relaxed))
+                {
+                    return;
+                }
+                if ((*it)->delegated_to == nullptr)
+                {
+                    (*it)->wake_requested = true;
+                    ++state.pending_wakes;
+                    SetEvent(state.wake_event);
+                    return;
+                }
+                host = (*it)->delegated_to;
+                host_id = (*it)->host_id;
+            }
+            // Outside the lock: the host may be about to run this very task, which takes it.
+            const HostSchedulerLease lease = lease_host_scheduler();
+            if (host_id != NO_BACKGROUND_TASK && lease && lease.host() == host)
+            {
+                lease.wake(host_id);
+            }
+        }
+
+        bool cancel_background_task(BackgroundTaskId id) noexcept
+        {
+            if (id == NO_BACKGROUND_TASK)
+            {
+                return true;
+            }
+            ServiceState &state = service_state();
+            // Declared before the lock so a retired task's body is destroyed after the lock is released.
+            std::unique_ptr<BackgroundTask> retired;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            const auto it = find_task(state, id);
+            if (it == state.tasks.end())
+            {
+                return true;
+            }
+
+            BackgroundTask &task = **it;
+            if (task.delegated_to != nullptr)
+            {
+                task.cancelled.store(true, std::memory_order_relaxed);
+                const void *const host = task.delegated_to;
+                const BackgroundTaskId host_id = std::exchange(task.host_id, NO_BACKGROUND_TASK);
+                const bool running = task.running;
+                if (!running)
+                {
+                    retired = std::move(*it);
+                    state.tasks.erase(it);
+                }
+                lock.unlock();
+
+                // The host's cancel waits for a run in progress there, which retires the record on its way out.
+                if (host_id != NO_BACKGROUND_TASK)
+                {
+                    const HostSchedulerLease lease = lease_host_scheduler();
+                    if (lease && lease.host() == host)
+                    {
+                        (void)lease.cancel(host_id);
+                    }
+                }
+                if (!running || t_in_delegated_task)
+                {
+                    return true;
+                }
+                if (is_loader_lock_held())
+                {
+                    return false;
+                }
+                lock.lock();
+                state.idle_cv.wait(lock, [&state, id]() { return find_task(state, id) == state.tasks.end(); });
+                return true;
+            }
+
+            const bool watches_handle = task.handle != nullptr && !task.cancelled.load(std::memory_order_relaxed);
+            task.cancelled.store(true, std::memory_order_relaxed);
+            disarm(state, task);
+            if (task.wake_requested)
+            {
+                task.wake_requested = false;
+                --state.pending_wakes;
+            }
+            if (watches_handle)
+            {
+                --state.watched_handles;
+                ++state.handle_epoch;
+                SetEvent(state.wake_event);
+            }
+            const std::uint64_t epoch = state.handle_epoch;
+            const bool running = task.running;
+            if (!running)
+            {
+                retired = std::move(*it);
+                state.tasks.erase(it);
+            }
+
+            // Inside a task the service is neither waiting nor running another task, and it rebuilds its wait set
+            // before it waits again.
+            if (on_background_service_thread())
+            {
+                return true;
+            }
+            if (is_loader_lock_held())
+            {
+                return !running && !watches_handle;
+            }
+            state.idle_cv.wait(lock,
+                               [&state, id, epoch, watches_handle]()
+                               {
+                                   if (state.thread_id.load(std::memory_order_acquire) == 0)
+                                   {
+                                       return true;
+                                   }
+                                   return find_task(state, id) == state.tasks.end() &&
+                                          (!watches_handle || state.applied_handle_epoch >= epoch);
+                               });
+            return true;
+        }
+
+        void shutdown_background_service() noexcept
+        {
+            ServiceState &state = service_state();
+            // Delegated tasks first, which need no thread here: once no host runs them their records simply retire.
+            withdraw_delegated(state);
+            retire_withdrawn(state);
+
+            std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+            std::unique_ptr<StoppableWorker> worker = std::move(state.worker);
+            if (worker == nullptr)
+            {
+                return;
+            }
+            // shutdown() detaches in exactly these two cases; the thread may then still be running a task.
+            const bool joins = !is_loader_lock_held() && !on_background_service_thread();
+            worker->shutdown();
+
+            std::vector<std::unique_ptr<BackgroundTask>> retired;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+            {
+                task->cancelled.store(true, std::memory_order_relaxed);
+                disarm(state, *task);
+                task->wake_requested = false;
+            }
+            state.pending_wakes = 0;
+            state.watched_handles = 0;
+            ++state.handle_epoch;
+            if (joins)
+            {
+                retired = std::move(state.tasks);
+                state.tasks.clear();
+            }
+        }
+
+        bool on_background_service_thread() noexcept
+        {
+            if (t_in_delegated_task)
+            {
+                return true;
+            }
+            const DWORD id = service_state().thread_id.load(std::memory_order_acquire);
+            return id != 0 && id == GetCurrentThreadId();
+        }
+
+        std::size_t background_task_count() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return static_cast<std::size_t>(
+                std::count_if(state.tasks.begin(), state.tasks.end(), [](const std::unique_ptr<BackgroundTask> &task)
+                              { return !task->cancelled.load(std::memory_order_relaxed); }));
+        }
+
+        std::uint64_t background_service_threads_started() noexcept
+        {
+            return service_state().threads_started.load(std::memory_order_relaxed);
+        }
+
+        Result<BackgroundTaskId> host_background_task(std::string_view name, std::chrono::milliseconds period,
+                                                      void *handle, ForeignTaskFn run, void *context) noexcept
+        {
+            constexpr const char *where = "detail::host_background_task";
+            if (run == nullptr || handle == INVALID_HANDLE_VALUE ||
+                (handle == nullptr && period <= std::chrono::milliseconds::zero()))
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            std::function<void()> body;
+            try
+            {
+                body = [run, context]() { run(context); };
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            const auto tick = BACKGROUND_TIMER_TICK.count();
+            const auto period_ticks =
+                handle != nullptr ? std::uint64_t{0} : static_cast<std::uint64_t>((period.count() + tick - 1) / tick);
+            return register_task(name, period_ticks, static_cast<HANDLE>(handle), std::move(body), where, true);
+        }
+
+        void cancel_hosted_background_tasks() noexcept
+        {
+            ServiceState &state = service_state();
+            for (;;)
+            {
+                BackgroundTaskId id = NO_BACKGROUND_TASK;
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                    {
+                        if (task->hosted && !task->cancelled.load(std::memory_order_relaxed))
+                        {
+                            id = task->id;
+                            break;
+                        }
+                    }
+                }
+                if (id == NO_BACKGROUND_TASK)
+                {
+                    return;
+                }
+                (void)cancel_background_task(id);
+            }
+        }
+
+        std::size_t hosted_background_task_count() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return static_cast<std::size_t>(
+                std::count_if(state.tasks.begin(), state.tasks.end(), [](const std::unique_ptr<BackgroundTask> &task)
+                              { return task->hosted && !task->cancelled.load(std::memory_order_relaxed); }));
+        }
+
+        void set_background_delegation(bool open) noexcept
+        {
+            constexpr const char *where = "detail::set_background_delegation";
+            ServiceState &state = service_state();
+            if (open)
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                state.delegation_open = true;
+                return;
+            }
+
+            withdraw_delegated(state);
+            std::unique_lock<std::mutex> lifecycle(state.lifecycle_mutex, std::defer_lock);
+            if (!on_background_service_thread())
+            {
+                lifecycle.lock();
+            }
+            bool any = false;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                any = std::any_of(state.tasks.begin(), state.tasks.end(),
+                                  [](const std::unique_ptr<BackgroundTask> &task)
+                                  { return task->delegated_to != nullptr; });
+            }
+            if (!any)
+            {
+                return;
+            }
+            const Result<void> started = ensure_service_started(state, where);
+            if (!started)
+            {
+                (void)log().try_log(LogLevel::Error,
+                                    "BackgroundService: cannot start the service thread to take back delegated tasks "
+                                    "(error {}); they will not run again.",
+                                    started.error().detail);
+                retire_withdrawn(state);
+                return;
+            }
+
+            bool dropped = false;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                const std::uint64_t now = now_tick();
+                for (const std::unique_ptr<BackgroundTask> &task : state.tasks)
+                {
+                    // A cancelled one is still running on the host and retires itself there.
+                    if (task->delegated_to == nullptr || task->cancelled.load(std::memory_order_relaxed))
+                    {
+                        continue;
+                    }
+                    if (task->handle != nullptr && state.watched_handles >= BACKGROUND_MAX_HANDLES)
+                    {
+                        (void)log().try_log(LogLevel::Warning,
+                                            "BackgroundService: no room to watch the handle of task '{}' taken back "
+                                            "from its host; it will not run again.",
+                                            task->name);
+                        dropped = true;
+                        continue;
+                    }
+                    task->delegated_to = nullptr;
+                    if (task->handle == nullptr)
+                    {
+                        arm(state, *task, now);
+                    }
+                    else
+                    {
+                        ++state.watched_handles;
+                        ++state.handle_epoch;
+                    }
+                }
+                SetEvent(state.wake_event);
+            }
+            if (dropped)
+            {
+                retire_withdrawn(state);
+            }
+        }
+
+        std::size_t delegated_background_task_count() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return static_cast<std::size_t>(
+                std::count_if(state.tasks.begin(), state.tasks.end(), [](const std::unique_ptr<BackgroundTask> &task)
+                              {
+                                  return task->delegated_to != nullptr &&
+                                         !task->cancelled.load(std::memory_order_relaxed);
+                              }));
+        }
+    } // namespace detail
+} // namespace DetourModKit
@@ -0,0 +1,129 @@
+#ifndef DETOURMODKIT_INTERNAL_BACKGROUND_SERVICE_HPP
+#define DETOURMODKIT_INTERNAL_BACKGROUND_SERVICE_HPP
+
+/**
+ * @file internal/background_service.hpp
+ * @brief True-private shared background thread: periodic timers on a timer wheel and waits on kernel handles.
+ * @details Never installed. Periodic library work registers here as a task instead of owning a thread, so an idle
+ *          session has one parked thread rather than one per subsystem, and a game thread attach/detach notifies one
+ *          fewer DMK thread for each subsystem that moved over.
+ *
+ *          The service thread sleeps in one WaitForMultipleObjects call: on its wake event, on every watched handle,
+ *          and with a timeout to the next occupied timer-wheel slot. The wheel has BACKGROUND_WHEEL_SLOTS slots of
+ *          BACKGROUND_TIMER_TICK each; a timer further out than one rotation stays in its slot and is skipped until
+ *          its deadline comes round, so an idle service wakes at most once per rotation per long timer.
+ *
+ *          Tasks run one at a time, on the service thread, outside the service's lock. A task must return promptly:
+ *          while it runs no other task is served. An exception escaping a task is caught, logged, and swallowed.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// Identifies one registered task; never reused within a process.
+        using BackgroundTaskId = std::uint64_t;
+        /// The id no task has; cancel_background_task() and wake_background_task() ignore it.
+        inline constexpr BackgroundTaskId NO_BACKGROUND_TASK = 0;
+        /// Resolution of the timer wheel. Periods are rounded up to a whole tick.
+        inline constexpr std::chrono::milliseconds BACKGROUND_TIMER_TICK{1};
+        /// Slots in the timer wheel; one rotation is BACKGROUND_WHEEL_SLOTS ticks.
+        inline constexpr std::size_t BACKGROUND_WHEEL_SLOTS = 1024;
+        /// Handles one service thread can watch: MAXIMUM_WAIT_OBJECTS less the service's own wake event.
+        inline constexpr std::size_t BACKGROUND_MAX_HANDLES = 63;
+
+        /**
+         * @brief Runs @p task on the service thread every @p period, starting one period from now.
+         * @details Starts the service thread on first use. wake_background_task() runs the task early; the next
+         *          period is then counted from that early run.
+         * @return The task's id, `ErrorCode::InvalidArg` for an empty @p task or a zero @p period,
+         *         `ErrorCode::OutOfMemory`, or `ErrorCode::SystemCallFailed` when the service thread cannot start.
+         */
+        [[nodiscard]] Result<BackgroundTaskId> schedule_background_timer(std::string_view name,
+                                                                         std::chrono::milliseconds period,
+                                                                         std::function<void()> task);
+
+        /**
+         * @brief Runs @p task on the service thread each time @p handle is signaled.
+         * @details @p handle is a Win32 waitable HANDLE (void * here to keep <windows.h> out of this header). It must
+         *          stay open until cancel_background_task() has returned true for this task. A manual-reset object
+         *          stays signaled, so @p task must reset it or the service runs it again at once; an auto-reset event
+         *          or an overlapped-I/O event that @p task re-arms is the intended use.
+         * @return The task's id, `ErrorCode::InvalidArg` for a null @p handle, an empty @p task, or a service already
+         *         watching BACKGROUND_MAX_HANDLES handles, `ErrorCode::OutOfMemory`, or `ErrorCode::SystemCallFailed`
+         *         when the service thread cannot start.
+         */
+        [[nodiscard]] Result<BackgroundTaskId> watch_background_handle(std::string_view name, void *handle,
+                                                                       std::function<void()> task);
+
+        /// Runs timer task @p id on the service thread as soon as it is free. Does not block; unknown ids are ignored.
+        void wake_background_task(BackgroundTaskId id) noexcept;
+
+        /**
+         * @brief Unregisters task @p id.
+         * @details Waits until the task is not running and, for a handle watch, until the service has stopped waiting
+         *          on the handle. From a task on the service thread the wait is skipped (no other task can be running
+         *          there). Under the loader lock nothing is waited for.
+         * @return true when the task will not run again and its handle is no longer waited on (or @p id is unknown);
+         *         false when the loader lock prevented the wait, so the task's state and handle must be leaked.
+         */
+        bool cancel_background_task(BackgroundTaskId id) noexcept;
+
+        /**
+         * @brief Stops the service thread and drops every task still registered.
+         * @details Joins the thread, or detaches it under the loader lock (see StoppableWorker::shutdown()). The next
+         *          registration starts a fresh thread. Owners are expected to have cancelled their tasks first.
+         */
+        void shutdown_background_service() noexcept;
+
+        /// True on the service thread, i.e. inside a task; also inside a task this instance delegated to a host.
+        [[nodiscard]] bool on_background_service_thread() noexcept;
+
+        /// Tasks currently registered, delegated ones included.
+        [[nodiscard]] std::size_t background_task_count() noexcept;
+
+        /// Service threads started over the process lifetime; a steady value shows tasks share one thread.
+        [[nodiscard]] std::uint64_t background_service_threads_started() noexcept;
+
+        /// A task body another DetourModKit instance hands this one's service thread (see services.hpp).
+        using ForeignTaskFn = void (*)(void *context) noexcept;
+
+        /**
+         * @brief Registers @p run (@p context) for another instance: every @p period, or each time @p handle is
+         *        signaled when it is non-null.
+         * @details What the host's exported scheduler table lands on. The task is otherwise an ordinary one, cancelled
+         *          by the returned id, until cancel_hosted_background_tasks() withdraws every such task at once.
+         * @return As schedule_background_timer() / watch_background_handle().
+         */
+        [[nodiscard]] Result<BackgroundTaskId> host_background_task(std::string_view name,
+                                                                    std::chrono::milliseconds period, void *handle,
+                                                                    ForeignTaskFn run, void *context) noexcept;
+
+        /// Cancels every task host_background_task() registered, each as cancel_background_task() does.
+        void cancel_hosted_background_tasks() noexcept;
+
+        /// Tasks host_background_task() registered that are still registered.
+        [[nodiscard]] std::size_t hosted_background_task_count() noexcept;
+
+        /**
+         * @brief Sends the tasks registered from now on to the host's service thread (@p open), or stops doing so.
+         * @details While open, a registration with a host lease to hand runs there and keeps only its record (and
+         *          its id) here. Closing takes every delegated task back: it is cancelled on the host while the host
+         *          still has its table out, then armed on this instance's own service thread, which starts for it.
+         */
+        void set_background_delegation(bool open) noexcept;
+
+        /// Tasks of this instance currently running on a host's service thread.
+        [[nodiscard]] std::size_t delegated_background_task_count() noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_BACKGROUND_SERVICE_HPP
@@ -3,9 +3,9 @@
 
 /**
  * @file config_watcher.hpp
- * @brief Internal filesystem watcher engine that triggers a callback when an INI file changes.
- * @details This is the private engine that backs config::enable_auto_reload / disable_auto_reload. It is reached only
- *          through the config module's pimpl orchestration, carries the Win32 ReadDirectoryChangesW pump, and is never
+ * @brief Internal filesystem watcher that triggers a callback when an INI file changes.
+ * @details This is the private watcher that backs config::enable_auto_reload / disable_auto_reload. It is reached only
+ *          through the config module's pimpl orchestration, registers with the shared file-watch service, and is never
  *          installed. The config surface owns the watcher's lifetime; consumers do not see this type.
  */
 
@@ -22,12 +22,10 @@ namespace DetourModKit
     {
         /**
          * @class ConfigWatcher
-         * @brief Background watcher for a single INI config file.
-         * @details Owns a StoppableWorker that opens the INI file's parent directory via ReadDirectoryChangesW and
-         * fires @p
-         *          on_reload when the target file is modified. Consecutive change events within the debounce window
-         *          collapse to a single callback so editor save-flurries (Notepad++ / VSCode atomic save, rename-swap-save,
-         *          last-write-time tick) do not cause redundant reloads.
+         * @brief Watch on a single INI config file, registered with the process-wide file-watch service.
+         * @details Fires @p on_reload when the target file is modified. Consecutive change events within the debounce
+         *          window collapse to a single callback so editor save-flurries (Notepad++ / VSCode atomic save,
+         *          rename-swap-save, last-write-time tick) do not cause redundant reloads.
          *
          *          Detected change kinds:
          *            - FILE_NOTIFY_CHANGE_LAST_WRITE  (plain save in place)
@@ -35,20 +33,17 @@ namespace DetourModKit
          *            - FILE_NOTIFY_CHANGE_FILE_NAME   (rename-swap-save pattern,
          *              where the editor writes to a sibling temp and renames it over the target)
          *
-         *          Filename matching is case-insensitive (Windows filesystem convention). The watcher does not recurse into
-         *          subdirectories.
+         *          Filename matching is case-insensitive (Windows filesystem convention). The watcher does not recurse
+         *          into subdirectories. The service's one pump thread serves every watch in the process and shares one
+         *          directory read between the files of a directory (see internal/file_watch_service.hpp), so a watcher
+         *          owns no thread of its own. The watcher leaves the content-hash short-circuit to its consumer: Config
+         *          hashes the file itself and reports an unchanged rewrite to on_reload as a reload that ran no setter.
          *
-         *          Non-copyable, non-movable. The watcher owns a worker thread and a directory handle; neither would
-         *          survive a duplicated or moved owner.
+         *          Non-copyable, non-movable, matching the single owner slot Config keeps it in.
          *
-         * @warning The @p on_reload callback is invoked on the watcher's background thread. Callers must handle their
-         * own
-         *          synchronization if the callback touches shared state. An exception escaping the callback is caught at
-         *          the invocation site, logged as an error, and swallowed, so the watcher keeps pumping. This
-         *          containment is mandatory rather than cosmetic: letting a throw unwind the worker body would free the
-         *          in-flight ReadDirectoryChangesW OVERLAPPED and notification buffer before the kernel notify IRP is
-         *          drained. The StoppableWorker body handler remains only a last-resort backstop for a non-callback
-         *          throw.
+         * @warning The @p on_reload callback is invoked on the service's dispatch thread, shared with every other
+         *          watch. Callers must handle their own synchronization if the callback touches shared state. An
+         *          exception escaping the callback is caught, logged, and swallowed, so the watcher keeps firing.
          */
         class ConfigWatcher
         {
@@ -59,9 +54,8 @@ namespace DetourModKit
              *                 change notifications; the file itself does not need to exist at construction time.
              * @param debounce Quiet-window length. A callback fires only after @p debounce has elapsed since the last
              *                 matching change event.
-             * @param on_reload Callback invoked on the watcher thread when a debounced change is observed. May be empty
-             * to
-             *                  construct an inert watcher.
+             * @param on_reload Callback invoked on the dispatch thread when a debounced change is observed. May be
+             *                  empty to construct an inert watcher.
              */
             explicit ConfigWatcher(std::string_view ini_path,
                                    std::chrono::milliseconds debounce = std::chrono::milliseconds{250},
@@ -75,33 +69,29 @@ namespace DetourModKit
             ConfigWatcher &operator=(ConfigWatcher &&) = delete;
 
             /**
-             * @brief Starts the background watcher thread.
-             * @details Idempotent. If the watcher is already running, the call is a no-op and returns true. The worker
-             *          opens the parent directory and issues the first overlapped
-             *          ReadDirectoryChangesW before signalling the main thread, so a true return means I/O is in flight.
-             * @return true if the worker is (or already was) running. Returns false when the directory handle could not
-             * be
-             *         opened, when the startup handshake timed out after
-             *         5 seconds (e.g. a hostile hook on CreateFileW), or when the worker lambda threw before signalling --
-             *         in all three cases an error has already been logged and the watcher remains stopped.
+             * @brief Registers the watch.
+             * @details Idempotent. If the watcher is already running, the call is a no-op and returns true. The
+             *          directory's overlapped ReadDirectoryChangesW is queued before this returns, so a true return
+             *          means I/O is in flight.
+             * @return true if the watch is (or already was) registered. Returns false when the path is empty or the
+             *         parent directory could not be opened or watched; an error has then been logged and the watcher
+             *         remains stopped and reusable.
              */
             [[nodiscard]] bool start();
 
             /**
-             * @brief Stops the background watcher thread.
-             * @details Idempotent. Safe to call before start() or multiple times. Blocks until the worker exits, unless
-             * the
-             *          current thread holds the Windows loader lock, in which case the worker is detached (see
-             *          StoppableWorker::shutdown()). Returns promptly (~100 ms bound) regardless.
+             * @brief Unregisters the watch.
+             * @details Idempotent. Safe to call before start() or multiple times. Blocks until a running @p on_reload
+             *          returns and the directory's read has drained, unless the current thread holds the Windows loader
+             *          lock or is the dispatch thread itself (see detail::unwatch_file()).
              * @note A change that arrived within the debounce window but had not yet fired triggers one final @p
-             * on_reload
-             *       callback during this stop, so stop() does not guarantee that no further callback runs. Callers that
-             *       must observe no callback after stopping should latch their own flag.
+             *       on_reload callback during this stop, so stop() does not guarantee that no further callback runs.
+             *       Callers that must observe no callback after stopping should latch their own flag.
              */
             void stop() noexcept;
 
             /**
-             * @brief Returns true while the watcher thread is still alive.
+             * @brief Returns true while the watch is registered.
              */
             [[nodiscard]] bool is_running() const noexcept;
 
@@ -116,30 +106,20 @@ namespace DetourModKit
             [[nodiscard]] std::chrono::milliseconds debounce() const noexcept;
 
             /**
-             * @brief Returns true if @p id names the background worker thread.
+             * @brief Returns true if @p id names the thread @p on_reload runs on.
              * @details Lets a stop request detect a setter-induced self-call (a reload callback that, running on the
-             * worker
-             *          thread, tries to tear the watcher down) and avoid joining the worker from the worker itself, which
-             *          would otherwise raise
-             *          std::system_error(resource_deadlock_would_occur). The worker publishes its id when its thread
-             *          starts (before the first overlapped read is issued) and clears it on exit, so this returns false
-             *          before the worker thread has started and after the worker has exited (including after stop() has
-             *          joined it); a later OS-recycled thread id therefore cannot alias a dead worker and suppress a real
-             *          stop.
+             *          dispatch thread, tries to tear the watcher down) and skip it rather than wait for the callback
+             *          it is running inside. Returns false before start() and after stop(), so an OS-recycled thread id
+             *          cannot alias the dispatch thread of a watch that no longer exists and suppress a real stop.
              * @param id The thread id to compare against.
-             * @return true only while the worker is running and @p id equals its thread id; the default (no-thread) id
-             *         never matches.
+             * @return true only while the watch is registered and @p id is the dispatch thread; the default (no-thread)
+             *         id never matches.
              */
             [[nodiscard]] bool is_worker_thread(std::thread::id id) const noexcept;
 
         private:
             struct Impl;
 
-            // Move an Impl into a never-freed heap cell and record the intentional leak, releasing the unique_ptr on
-            // allocation failure so the storage still leaks without running ~Impl. Both husk paths -- the loader-lock
-            // teardown and the start leak-on-timeout -- share this exact dance, so it lives in one audited place.
-            static void leak_impl_storage(std::unique_ptr<Impl> &impl) noexcept;
-
             std::unique_ptr<Impl> m_impl;
         };
     } // namespace detail
@@ -0,0 +1,1047 @@
+/**
+ * @file internal/file_watch_service.cpp
+ * @brief The process-wide file watcher: one completion port, a pump thread, and a dispatch thread.
+ * @details Directories are owned by the service's directory list. The completion port knows each by a key rather
+ *          than its address, so a completion that arrives for a directory the service already gave up on (see the
+ *          drain in service_directories()) is recognised and ignored. A directory's OVERLAPPED and notification buffer
+ *          stay valid until its read's completion has been dequeued; a read the kernel will not complete is leaked.
+ *          Watches are shared between their directory and the dispatch queue, so a watch removed while its callback
+ *          is queued or running keeps the callback alive until the dispatch thread is done with it.
+ *
+ *          The service's state is built once in static storage and never destroyed, for the same reason as the
+ *          background service's: a thread detached under the loader lock may still be running when static
+ *          destructors do.
+ */
+
+#include "internal/file_watch_service.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/logger.hpp"
+#include "internal/fnv1a.hpp"
+#include "internal/ini_reader.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "platform.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+            using Clock = std::chrono::steady_clock;
+
+            constexpr DWORD NOTIFY_FILTER =
+                FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+            /// Per-directory notification buffer, sized so bursty editor saves do not overflow one read.
+            constexpr DWORD BUFFER_BYTES = 16 * 1024;
+            /// Completions dequeued per wait.
+            constexpr ULONG COMPLETION_BATCH = 16;
+            /// Key of the packet that wakes the pump to re-read its state; directory keys start above it.
+            constexpr ULONG_PTR WAKE_KEY = 0;
+            /**
+             * @brief Minimum delay before re-arming a read after ERROR_NOTIFY_ENUM_DIR.
+             * @details Some redirectors report it continuously under an event storm; the delay keeps the pump from
+             *          spinning on them.
+             */
+            constexpr std::chrono::milliseconds OVERFLOW_REARM_DELAY{50};
+            /// Bound of each drain step for a directory's last read: after CancelIoEx, then after closing the handle.
+            constexpr std::chrono::milliseconds DRAIN_TIMEOUT{1000};
+
+            // Case-insensitive filename comparison using ordinal (locale-independent) Unicode folding.
+            // CompareStringOrdinal with bIgnoreCase == TRUE applies the same simple uppercase fold NTFS/exFAT use and,
+            // unlike ::towupper, does not consult the process locale, so a Turkish locale still matches "Config.ini"
+            // against "config.ini". The empty short-circuit avoids passing a null data()/zero count to the API.
+            bool iequals_w(std::wstring_view lhs, std::wstring_view rhs) noexcept
+            {
+                if (lhs.size() != rhs.size())
+                {
+                    return false;
+                }
+                if (lhs.empty())
+                {
+                    return true;
+                }
+                return ::CompareStringOrdinal(lhs.data(), static_cast<int>(lhs.size()), rhs.data(),
+                                              static_cast<int>(rhs.size()), TRUE) == CSTR_EQUAL;
+            }
+
+            struct FileWatch
+            {
+                FileWatchId id{NO_FILE_WATCH};
+                std::filesystem::path path;
+                std::wstring filename;
+                /// The path as the caller spelled it, for log lines.
+                std::string label;
+                std::chrono::milliseconds debounce{0};
+                bool skip_unchanged_content{false};
+                std::function<void()> on_change;
+
+                // Guarded by the service mutex.
+                bool pending{false};
+                Clock::time_point last_change{};
+                /// Callbacks queued or running for this watch.
+                std::size_t outstanding{0};
+                /// Set once the watch is removed without a wait; its queued callbacks are then dropped.
+                bool discarded{false};
+
+                /// Hash of the bytes last delivered. Touched only on the dispatch thread once the watch is published.
+                std::optional<std::uint64_t> content_hash;
+            };
+
+            struct WatchedDirectory
+            {
+                ULONG_PTR key{WAKE_KEY};
+                std::wstring path;
+                /// The label of the watch that opened the directory, for log lines.
+                std::string label;
+                HANDLE handle{INVALID_HANDLE_VALUE};
+                OVERLAPPED overlapped{};
+                std::vector<BYTE> buffer;
+                std::vector<std::shared_ptr<FileWatch>> watches;
+                bool read_pending{false};
+                bool handle_closed{false};
+                // The read failed for good (e.g. the directory was removed or renamed); its watches stay registered
+                // but see no further change.
+                bool failed{false};
+                bool overflow_logged{false};
+                // When set, the read is re-issued at this time rather than at once (see OVERFLOW_REARM_DELAY).
+                std::optional<Clock::time_point> rearm_at;
+                // Set once the last watch has left: the read is being cancelled and the directory is released when
+                // its completion is dequeued, or given up on at drain_deadline.
+                bool closing{false};
+                Clock::time_point drain_deadline{};
+            };
+
+            struct ServiceState
+            {
+                /// Serializes starting against shutting down; never held while a callback runs.
+                std::mutex lifecycle_mutex;
+                std::unique_ptr<StoppableWorker> pump;
+                std::unique_ptr<StoppableWorker> dispatcher;
+
+                std::mutex mutex;
+                /// Signaled when a callback is queued.
+                std::condition_variable dispatch_cv;
+                /// Signaled when a callback returns, when a directory is released, and when a service thread exits.
+                std::condition_variable idle_cv;
+                /// Created once and never closed: a detached pump may still be waiting on it.
+                HANDLE port{nullptr};
+                std::vector<std::unique_ptr<WatchedDirectory>> directories;
+                std::deque<std::shared_ptr<FileWatch>> queue;
+                FileWatchId next_watch_id{1};
+                ULONG_PTR next_directory_key{WAKE_KEY + 1};
+                // Service threads started and not yet exited, counting detached ones; a wait for a thread to act
+                // gives up once none is left to act.
+                std::size_t pumps_alive{0};
+                std::size_t dispatchers_alive{0};
+
+                std::atomic<DWORD> pump_thread_id{0};
+                std::atomic<std::thread::id> dispatch_thread{};
+                std::atomic<std::uint64_t> threads_started{0};
+            };
+
+            alignas(ServiceState) unsigned char s_service_storage[sizeof(ServiceState)];
+
+            /// Constructed on first use in static storage and never destroyed; see the file comment.
+            ServiceState &service_state() noexcept
+            {
+                static ServiceState *const state = ::new (static_cast<void *>(s_service_storage)) ServiceState();
+                return *state;
+            }
+
+            [[nodiscard]] bool on_service_thread(const ServiceState &state) noexcept
+            {
+                const DWORD pump = state.pump_thread_id.load(std::memory_order_acquire);
+                return (pump != 0 && pump == GetCurrentThreadId()) ||
+                       is_file_watch_dispatch_thread(std::this_thread::get_id());
+            }
+
+            void wake_pump(const ServiceState &state) noexcept
+            {
+                (void)PostQueuedCompletionStatus(state.port, 0, WAKE_KEY, nullptr);
+            }
+
+            [[nodiscard]] std::uint64_t content_hash_of(std::string_view bytes) noexcept
+            {
+                return fnv1a_field(FNV1A64_OFFSET, bytes);
+            }
+
+            [[nodiscard]] std::vector<std::unique_ptr<WatchedDirectory>>::iterator
+            find_directory(ServiceState &state, ULONG_PTR key) noexcept
+            {
+                return std::find_if(state.directories.begin(), state.directories.end(),
+                                    [key](const std::unique_ptr<WatchedDirectory> &dir) { return dir->key == key; });
+            }
+
+            /// The directory at @p path whose read is live, or nullptr.
+            [[nodiscard]] WatchedDirectory *find_open_directory(ServiceState &state, std::wstring_view path) noexcept
+            {
+                for (const std::unique_ptr<WatchedDirectory> &dir : state.directories)
+                {
+                    if (!dir->closing && !dir->failed && iequals_w(dir->path, path))
+                    {
+                        return dir.get();
+                    }
+                }
+                return nullptr;
+            }
+
+            void close_handle(WatchedDirectory &dir) noexcept
+            {
+                if (!dir.handle_closed)
+                {
+                    CloseHandle(dir.handle);
+                    dir.handle_closed = true;
+                }
+            }
+
+            [[nodiscard]] bool issue_read(WatchedDirectory &dir) noexcept
+            {
+                dir.overlapped = OVERLAPPED{};
+                if (!ReadDirectoryChangesW(dir.handle, dir.buffer.data(), static_cast<DWORD>(dir.buffer.size()), FALSE,
+                                           NOTIFY_FILTER, nullptr, &dir.overlapped, nullptr))
+                {
+                    return false;
+                }
+                dir.read_pending = true;
+                return true;
+            }
+
+            /// Re-issues @p dir's read, retiring the directory when the read cannot be issued.
+            void rearm(WatchedDirectory &dir) noexcept
+            {
+                if (issue_read(dir))
+                {
+                    return;
+                }
+                (void)log().try_log(LogLevel::Error,
+                                    "FileWatch: ReadDirectoryChangesW failed for the directory of '{}' (GLE={}); its "
+                                    "files are no longer watched.",
+                                    dir.label, GetLastError());
+                dir.failed = true;
+                close_handle(dir);
+            }
+
+            void mark_changed(FileWatch &watch, Clock::time_point now) noexcept
+            {
+                watch.pending = true;
+                watch.last_change = now;
+            }
+
+            /// Treats every file in @p dir as changed after the kernel dropped its events.
+            void mark_overflow(WatchedDirectory &dir, Clock::time_point now, const char *cause) noexcept
+            {
+                if (!dir.overflow_logged)
+                {
+                    (void)log().try_log(log_category::config, LogLevel::Debug,
+                                        "FileWatch: notification buffer for the directory of '{}' overflowed ({}); "
+                                        "coalescing dropped events.",
+                                        dir.label, cause);
+                    dir.overflow_logged = true;
+                }
+                for (const std::shared_ptr<FileWatch> &watch : dir.watches)
+                {
+                    mark_changed(*watch, now);
+                }
+            }
+
+            // Walks the FILE_NOTIFY_INFORMATION chain of one completed read. Every kernel-supplied length and offset is
+            // bounds-checked against the bytes actually returned before any read or advance, and the walk stops (fails
+            // closed) on the first inconsistency rather than reading past them.
+            void match_notifications(WatchedDirectory &dir, DWORD bytes, Clock::time_point now) noexcept
+            {
+                const BYTE *cursor = dir.buffer.data();
+                const BYTE *const end_ptr = cursor + std::min<std::size_t>(bytes, dir.buffer.size());
+                constexpr std::size_t name_field_offset = offsetof(FILE_NOTIFY_INFORMATION, FileName);
+
+                // The entry header must fit before any of its fields is read.
+                while (static_cast<std::size_t>(end_ptr - cursor) >= name_field_offset)
+                {
+                    const auto *info = reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(cursor);
+                    const DWORD name_bytes = info->FileNameLength;
+                    const BYTE *const name_start = cursor + name_field_offset;
+                    if (name_bytes % sizeof(WCHAR) != 0 || name_bytes > static_cast<std::size_t>(end_ptr - name_start))
+                    {
+                        break;
+                    }
+
+                    // Rename-swap-save (temp -> target) surfaces the target name in the RENAMED_NEW_NAME entry.
+                    const std::wstring_view changed_name(info->FileName, name_bytes / sizeof(WCHAR));
+                    for (const std::shared_ptr<FileWatch> &watch : dir.watches)
+                    {
+                        if (iequals_w(changed_name, watch->filename))
+                        {
+                            mark_changed(*watch, now);
+                        }
+                    }
+
+                    // NextEntryOffset must move past this entry's header and stay inside the returned bytes; zero
+                    // ends the chain.
+                    const DWORD next = info->NextEntryOffset;
+                    if (next == 0 || next < name_field_offset || next > static_cast<std::size_t>(end_ptr - cursor))
+                    {
+                        break;
+                    }
+                    cursor += next;
+                }
+            }
+
+            /// Handles the dequeued completion of @p dir's read. @p dir is not closing.
+            void complete_read(WatchedDirectory &dir, Clock::time_point now) noexcept
+            {
+                dir.read_pending = false;
+                DWORD bytes = 0;
+                DWORD error = ERROR_SUCCESS;
+                if (!GetOverlappedResult(dir.handle, &dir.overlapped, &bytes, FALSE))
+                {
+                    error = GetLastError();
+                }
+
+                if (error == ERROR_NOTIFY_ENUM_DIR)
+                {
+                    mark_overflow(dir, now, "ERROR_NOTIFY_ENUM_DIR");
+                    dir.rearm_at = now + OVERFLOW_REARM_DELAY;
+                    return;
+                }
+                if (error != ERROR_SUCCESS)
+                {
+                    // Typically ERROR_OPERATION_ABORTED or ERROR_ACCESS_DENIED after the directory itself was removed
+                    // or renamed; a handle to a vanished directory cannot be recovered here.
+                    (void)log().try_log(LogLevel::Warning,
+                                        "FileWatch: watching the directory of '{}' stopped (GLE={}); it was removed or "
+                                        "renamed.",
+                                        dir.label, error);
+                    dir.failed = true;
+                    close_handle(dir);
+                    return;
+                }
+
+                if (bytes == 0)
+                {
+                    // A successful empty completion is the kernel's other way of reporting dropped events.
+                    mark_overflow(dir, now, "zero-byte completion");
+                }
+                else
+                {
+                    dir.overflow_logged = false;
+                    match_notifications(dir, bytes, now);
+                }
+                rearm(dir);
+            }
+
+            /**
+             * @brief Starts releasing @p it after its last watch left. Call with the service lock held.
+             * @return true when the directory was released at once; false while its cancelled read drains.
+             */
+            bool begin_release(ServiceState &state,
+                               std::vector<std::unique_ptr<WatchedDirectory>>::iterator it) noexcept
+            {
+                WatchedDirectory &dir = **it;
+                if (!dir.read_pending)
+                {
+                    close_handle(dir);
+                    state.directories.erase(it);
+                    return true;
+                }
+                dir.closing = true;
+                dir.rearm_at.reset();
+                dir.drain_deadline = Clock::now() + DRAIN_TIMEOUT;
+                (void)CancelIoEx(dir.handle, &dir.overlapped);
+                // The pump recomputes its timeout to cover the drain deadline.
+                wake_pump(state);
+                return false;
+            }
+
+            /**
+             * @brief Re-arms directories whose overflow delay ended and escalates the drains that ran out of time.
+             * @return true when a directory was given up on, so waiters for its release re-check.
+             */
+            bool service_directories(ServiceState &state, Clock::time_point now) noexcept
+            {
+                bool released = false;
+                auto it = state.directories.begin();
+                while (it != state.directories.end())
+                {
+                    WatchedDirectory &dir = **it;
+                    if (dir.closing)
+                    {
+                        if (now >= dir.drain_deadline && !dir.handle_closed)
+                        {
+                            // A watched directory that was deleted can orphan the notify IRP: CancelIoEx succeeds yet
+                            // nothing completes. Dropping the last handle makes the I/O manager complete it.
+                            close_handle(dir);
+                            dir.drain_deadline = now + DRAIN_TIMEOUT;
+                        }
+                        else if (now >= dir.drain_deadline)
+                        {
+                            // Still no completion: leak the OVERLAPPED and buffer so a late one cannot write into freed
+                            // memory. Its key is gone from the list, so the pump ignores it if it ever arrives.
+                            (void)log().try_log(LogLevel::Warning,
+                                                "FileWatch: the read on the directory of '{}' did not drain after "
+                                                "cancel and handle close; leaking its buffer to stay memory-safe.",
+                                                dir.label);
+                            (void)it->release();
+                            it = state.directories.erase(it);
+                            diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::ConfigWatcher);
+                            released = true;
+                            continue;
+                        }
+                    }
+                    else if (dir.rearm_at.has_value() && now >= *dir.rearm_at)
+                    {
+                        dir.rearm_at.reset();
+                        rearm(dir);
+                    }
+                    ++it;
+                }
+                return released;
+            }
+
+            /// Queues one callback for @p watch. Call with the service lock held.
+            [[nodiscard]] bool enqueue(ServiceState &state, const std::shared_ptr<FileWatch> &watch) noexcept
+            {
+                try
+                {
+                    state.queue.push_back(watch);
+                }
+                catch (...)
+                {
+                    return false;
+                }
+                ++watch->outstanding;
+                return true;
+            }
+
+            /**
+             * @brief Queues the callback of every watch whose quiet window has ended.
+             * @return true when one was queued.
+             */
+            bool collect_due(ServiceState &state, Clock::time_point now) noexcept
+            {
+                bool queued = false;
+                for (const std::unique_ptr<WatchedDirectory> &dir : state.directories)
+                {
+                    for (const std::shared_ptr<FileWatch> &watch : dir->watches)
+                    {
+                        // A change that cannot be queued for lack of memory stays pending and is retried next round.
+                        if (watch->pending && now - watch->last_change >= watch->debounce && enqueue(state, watch))
+                        {
+                            watch->pending = false;
+                            queued = true;
+                        }
+                    }
+                }
+                return queued;
+            }
+
+            /// Milliseconds until the next debounce deadline, overflow re-arm, or drain step; INFINITE when none.
+            [[nodiscard]] DWORD next_timeout(const ServiceState &state, Clock::time_point now) noexcept
+            {
+                std::optional<Clock::time_point> next;
+                const auto consider = [&next](Clock::time_point at) noexcept
+                {
+                    if (!next.has_value() || at < *next)
+                    {
+                        next = at;
+                    }
+                };
+                for (const std::unique_ptr<WatchedDirectory> &dir : state.directories)
+                {
+                    if (dir->closing)
+                    {
+                        consider(dir->drain_deadline);
+                    }
+                    else if (dir->rearm_at.has_value())
+                    {
+                        consider(*dir->rearm_at);
+                    }
+                    for (const std::shared_ptr<FileWatch> &watch : dir->watches)
+                    {
+                        if (watch->pending)
+                        {
+                            consider(watch->last_change + watch->debounce);
+                        }
+                    }
+                }
+                if (!next.has_value())
+                {
+                    return INFINITE;
+                }
+                if (*next <= now)
+                {
+                    return 0;
+                }
+                const auto wait = std::chrono::ceil<std::chrono::milliseconds>(*next - now).count();
+                return static_cast<DWORD>(std::min<long long>(wait, INFINITE - 1));
+            }
+
+            void pump_loop(std::stop_token stop_token) noexcept
+            {
+                ServiceState &state = service_state();
+                const DWORD self = GetCurrentThreadId();
+                state.pump_thread_id.store(self, std::memory_order_release);
+                std::stop_callback wake_on_stop(stop_token, [&state]() noexcept { wake_pump(state); });
+
+                std::array<OVERLAPPED_ENTRY, COMPLETION_BATCH> entries{};
+                DWORD timeout = INFINITE;
+                while (!stop_token.stop_requested())
+                {
+                    ULONG count = 0;
+                    if (!GetQueuedCompletionStatusEx(state.port, entries.data(), COMPLETION_BATCH, &count, timeout,
+                                                     FALSE))
+                    {
+                        // WAIT_TIMEOUT: a deadline is due.
+                        count = 0;
+                    }
+
+                    bool queued = false;
+                    bool released = false;
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        const Clock::time_point now = Clock::now();
+                        for (ULONG i = 0; i < count; ++i)
+                        {
+                            const ULONG_PTR key = entries[i].lpCompletionKey;
+                            if (key == WAKE_KEY)
+                            {
+                                continue;
+                            }
+                            const auto it = find_directory(state, key);
+                            if (it == state.directories.end())
+                            {
+                                continue;
+                            }
+                            if ((*it)->closing)
+                            {
+                                // The cancelled read is done with the OVERLAPPED and buffer; release the directory.
+                                close_handle(**it);
+                                state.directories.erase(it);
+                                released = true;
+                                continue;
+                            }
+                            complete_read(**it, now);
+                        }
+                        released = service_directories(state, now) || released;
+                        queued = collect_due(state, now);
+                        timeout = next_timeout(state, Clock::now());
+                    }
+                    if (queued)
+                    {
+                        state.dispatch_cv.notify_one();
+                    }
+                    if (released)
+                    {
+                        state.idle_cv.notify_all();
+                    }
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(state.mutex);
+                    --state.pumps_alive;
+                    // A newer pump may already be running when a detached one finally gets here.
+                    DWORD expected = self;
+                    (void)state.pump_thread_id.compare_exchange_strong(expected, 0, std::memory_order_acq_rel);
+                }
+                state.idle_cv.notify_all();
+            }
+
+            /// Runs @p watch's callback unless its content hash shows the bytes have not changed since the last run.
+            void deliver(FileWatch &watch) noexcept
+            {
+                if (watch.skip_unchanged_content)
+                {
+                    MappedFile file;
+                    if (file.open(watch.path))
+                    {
+                        const std::uint64_t hash = content_hash_of(file.text());
+                        if (watch.content_hash == hash)
+                        {
+                            return;
+                        }
+                        watch.content_hash = hash;
+                    }
+                }
+                try
+                {
+                    watch.on_change();
+                }
+                catch (const std::exception &e)
+                {
+                    (void)log().try_log(LogLevel::Error, "FileWatch '{}': change callback threw: {}", watch.label,
+                                        e.what());
+                }
+                catch (...)
+                {
+                    (void)log().try_log(LogLevel::Error, "FileWatch '{}': change callback threw a non-std exception.",
+                                        watch.label);
+                }
+            }
+
+            void dispatch_loop(std::stop_token stop_token) noexcept
+            {
+                ServiceState &state = service_state();
+                const std::thread::id self = std::this_thread::get_id();
+                state.dispatch_thread.store(self, std::memory_order_release);
+                std::stop_callback wake_on_stop(stop_token,
+                                                [&state]() noexcept
+                                                {
+                                                    {
+                                                        std::lock_guard<std::mutex> lock(state.mutex);
+                                                    }
+                                                    state.dispatch_cv.notify_all();
+                                                });
+
+                // Callbacks already queued when the stop arrives still run, so a flushed change is not lost.
+                std::unique_lock<std::mutex> lock(state.mutex);
+                while (true)
+                {
+                    state.dispatch_cv.wait(lock,
+                                           [&]() { return stop_token.stop_requested() || !state.queue.empty(); });
+                    if (state.queue.empty())
+                    {
+                        break;
+                    }
+                    std::shared_ptr<FileWatch> watch = std::move(state.queue.front());
+                    state.queue.pop_front();
+                    const bool run = !watch->discarded;
+                    lock.unlock();
+
+                    if (run)
+                    {
+                        deliver(*watch);
+                    }
+
+                    lock.lock();
+                    --watch->outstanding;
+                    lock.unlock();
+                    state.idle_cv.notify_all();
+                    // The last owner of a removed watch may be this one; its callback dies off the lock.
+                    watch.reset();
+                    lock.lock();
+                }
+
+                --state.dispatchers_alive;
+                std::thread::id expected = self;
+                (void)state.dispatch_thread.compare_exchange_strong(expected, std::thread::id{},
+                                                                    std::memory_order_acq_rel);
+                lock.unlock();
+                state.idle_cv.notify_all();
+            }
+
+            /// Starts whichever service thread is not running. Call with the lifecycle mutex held.
+            [[nodiscard]] Result<void> ensure_service_started(ServiceState &state, const char *where) noexcept
+            {
+                mark_subsystem_used(Subsystem::FileWatchService);
+                if (state.port == nullptr)
+                {
+                    state.port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 1);
+                    if (state.port == nullptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where, GetLastError()});
+                    }
+                }
+
+                const auto start = [&state, where](std::unique_ptr<StoppableWorker> &slot, std::size_t &alive,
+                                                   const char *name, void (*body)(std::stop_token) noexcept)
+                    -> Result<void>
+                {
+                    if (slot != nullptr)
+                    {
+                        return {};
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        ++alive;
+                    }
+                    try
+                    {
+                        slot = std::make_unique<StoppableWorker>(name, body);
+                        return {};
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        --alive;
+                        return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                    }
+                    catch (const std::system_error &failure)
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        --alive;
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where,
+                                                     static_cast<std::uintptr_t>(failure.code().value())});
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+                        --alive;
+                        return std::unexpected(Error{ErrorCode::SystemCallFailed, where});
+                    }
+                };
+
+                if (auto started = start(state.dispatcher, state.dispatchers_alive, "FileWatchDispatch", dispatch_loop);
+                    !started)
+                {
+                    return started;
+                }
+                if (state.pump != nullptr)
+                {
+                    return {};
+                }
+                if (auto started = start(state.pump, state.pumps_alive, "FileWatchPump", pump_loop); !started)
+                {
+                    return started;
+                }
+                state.threads_started.fetch_add(1, std::memory_order_relaxed);
+                return {};
+            }
+
+            /// Adds @p watch to @p dir. Call with the service lock held.
+            [[nodiscard]] Result<FileWatchId> add_watch(ServiceState &state, WatchedDirectory &dir,
+                                                        std::shared_ptr<FileWatch> watch, const char *where) noexcept
+            {
+                try
+                {
+                    dir.watches.reserve(dir.watches.size() + 1);
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+                watch->id = state.next_watch_id++;
+                const FileWatchId id = watch->id;
+                dir.watches.push_back(std::move(watch));
+                return id;
+            }
+
+            /**
+             * @brief Removes watch @p id into @p retired. Call with the service lock held.
+             * @return The key of the watch's directory while its read drains, WAKE_KEY otherwise.
+             */
+            ULONG_PTR remove_watch(ServiceState &state, FileWatchId id, std::shared_ptr<FileWatch> &retired) noexcept
+            {
+                for (auto dir = state.directories.begin(); dir != state.directories.end(); ++dir)
+                {
+                    std::vector<std::shared_ptr<FileWatch>> &watches = (*dir)->watches;
+                    const auto it = std::find_if(watches.begin(), watches.end(),
+                                                 [id](const std::shared_ptr<FileWatch> &watch)
+                                                 { return watch->id == id; });
+                    if (it == watches.end())
+                    {
+                        continue;
+                    }
+                    retired = std::move(*it);
+                    watches.erase(it);
+                    const ULONG_PTR key = (*dir)->key;
+                    if (watches.empty() && !begin_release(state, dir))
+                    {
+                        return key;
+                    }
+                    return WAKE_KEY;
+                }
+                return WAKE_KEY;
+            }
+        } // namespace
+
+        Result<FileWatchId> watch_file(std::string_view path, const FileWatchOptions &options,
+                                       std::function<void()> on_change)
+        {
+            constexpr const char *where = "detail::watch_file";
+            if (!on_change)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+
+            std::shared_ptr<FileWatch> watch;
+            std::wstring directory;
+            try
+            {
+                watch = std::make_shared<FileWatch>();
+                watch->label = std::string(path);
+                // weakly_canonical would need the file to exist; absolute() is enough for ReadDirectoryChangesW.
+                const std::filesystem::path input(watch->label);
+                std::error_code ec;
+                watch->path = std::filesystem::absolute(input, ec);
+                if (ec)
+                {
+                    watch->path = input;
+                }
+                directory = watch->path.parent_path().wstring();
+                watch->filename = watch->path.filename().wstring();
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            catch (...)
+            {
+                // The path does not convert from the narrow code page.
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            if (directory.empty() || watch->filename.empty())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, where});
+            }
+            watch->debounce = options.debounce;
+            watch->skip_unchanged_content = options.skip_unchanged_content;
+            watch->on_change = std::move(on_change);
+            if (watch->skip_unchanged_content)
+            {
+                MappedFile file;
+                if (file.open(watch->path))
+                {
+                    watch->content_hash = content_hash_of(file.text());
+                }
+            }
+
+            ServiceState &state = service_state();
+            // A callback registering another runs on the dispatch thread, which is live; taking the lifecycle mutex
+            // there would deadlock against a shutdown joining this very thread.
+            std::unique_lock<std::mutex> lifecycle(state.lifecycle_mutex, std::defer_lock);
+            if (!on_service_thread(state))
+            {
+                lifecycle.lock();
+                if (auto started = ensure_service_started(state, where); !started)
+                {
+                    return std::unexpected(started.error());
+                }
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+                if (WatchedDirectory *open = find_open_directory(state, directory))
+                {
+                    return add_watch(state, *open, std::move(watch), where);
+                }
+            }
+
+            // Opened outside the lock: CreateFileW can stall on a slow redirector or a hooked file API, and the pump
+            // needs the lock meanwhile.
+            std::unique_ptr<WatchedDirectory> dir;
+            try
+            {
+                dir = std::make_unique<WatchedDirectory>();
+                dir->path = directory;
+                dir->label = watch->label;
+                dir->buffer.resize(BUFFER_BYTES);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            dir->handle = CreateFileW(directory.c_str(), FILE_LIST_DIRECTORY,
+                                      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+                                      FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+            if (dir->handle == INVALID_HANDLE_VALUE)
+            {
+                return std::unexpected(Error{ErrorCode::SystemCallFailed, where, GetLastError()});
+            }
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+            if (WatchedDirectory *open = find_open_directory(state, directory))
+            {
+                // Another registration opened the directory meanwhile; its read already covers this file.
+                CloseHandle(dir->handle);
+                return add_watch(state, *open, std::move(watch), where);
+            }
+            try
+            {
+                state.directories.reserve(state.directories.size() + 1);
+            }
+            catch (const std::bad_alloc &)
+            {
+                CloseHandle(dir->handle);
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            dir->key = state.next_directory_key++;
+            // A read on a handle bound to a completion port is not cancelled when the issuing thread exits, so the
+            // first read can be issued here and the pump re-issues the rest.
+            if (CreateIoCompletionPort(dir->handle, state.port, dir->key, 0) == nullptr || !issue_read(*dir))
+            {
+                const DWORD error = GetLastError();
+                CloseHandle(dir->handle);
+                return std::unexpected(Error{ErrorCode::SystemCallFailed, where, error});
+            }
+            WatchedDirectory &added = *dir;
+            state.directories.push_back(std::move(dir));
+            // add_watch only fails to reserve; the directory then stays with no watch and is released at once.
+            Result<FileWatchId> id = add_watch(state, added, std::move(watch), where);
+            if (!id)
+            {
+                (void)begin_release(state, state.directories.end() - 1);
+            }
+            return id;
+        }
+
+        bool unwatch_file(FileWatchId id, bool flush_pending) noexcept
+        {
+            if (id == NO_FILE_WATCH)
+            {
+                return true;
+            }
+            ServiceState &state = service_state();
+            // Declared before the lock so the retired callback is destroyed after the lock is released.
+            std::shared_ptr<FileWatch> retired;
+            std::unique_lock<std::mutex> lock(state.mutex);
+            const ULONG_PTR draining = remove_watch(state, id, retired);
+            if (retired == nullptr)
+            {
+                return true;
+            }
+
+            // Inside a callback the only one running is the caller's, and it cannot wait for itself.
+            if (is_file_watch_dispatch_thread(std::this_thread::get_id()))
+            {
+                retired->discarded = true;
+                return true;
+            }
+            if (flush_pending && retired->pending && enqueue(state, retired))
+            {
+                retired->pending = false;
+                state.dispatch_cv.notify_one();
+            }
+            if (is_loader_lock_held())
+            {
+                return retired->outstanding == 0 && draining == WAKE_KEY;
+            }
+            state.idle_cv.wait(lock,
+                               [&state, &retired, draining]()
+                               {
+                                   const bool delivered = retired->outstanding == 0 || state.dispatchers_alive == 0;
+                                   const bool drained = draining == WAKE_KEY || state.pumps_alive == 0 ||
+                                                        find_directory(state, draining) == state.directories.end();
+                                   return delivered && drained;
+                               });
+            lock.unlock();
+            return true;
+        }
+
+        void detach_file_watch(FileWatchId id) noexcept
+        {
+            if (id == NO_FILE_WATCH)
+            {
+                return;
+            }
+            ServiceState &state = service_state();
+            std::shared_ptr<FileWatch> retired;
+            std::lock_guard<std::mutex> lock(state.mutex);
+            (void)remove_watch(state, id, retired);
+            if (retired != nullptr)
+            {
+                retired->discarded = true;
+            }
+        }
+
+        void shutdown_file_watch_service() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lifecycle(state.lifecycle_mutex);
+            if (state.pump == nullptr && state.dispatcher == nullptr)
+            {
+                return;
+            }
+            // StoppableWorker::shutdown() detaches in exactly these two cases; the threads may then still be running.
+            const bool joins = !is_loader_lock_held() && !on_service_thread(state);
+
+            std::vector<std::shared_ptr<FileWatch>> retired;
+            {
+                std::unique_lock<std::mutex> lock(state.mutex);
+                auto dir = state.directories.begin();
+                while (dir != state.directories.end())
+                {
+                    for (std::shared_ptr<FileWatch> &watch : (*dir)->watches)
+                    {
+                        watch->discarded = true;
+                        try
+                        {
+                            retired.push_back(std::move(watch));
+                        }
+                        catch (...)
+                        {
+                            // Out of memory: the callback dies under the lock instead of after it.
+                        }
+                    }
+                    (*dir)->watches.clear();
+                    if ((*dir)->closing)
+                    {
+                        ++dir;
+                        continue;
+                    }
+                    const std::ptrdiff_t index = dir - state.directories.begin();
+                    dir = begin_release(state, dir) ? state.directories.begin() + index
+                                                    : state.directories.begin() + index + 1;
+                }
+                if (joins)
+                {
+                    // Each drain is bounded by the pump's escalation (cancel, close, leak).
+                    state.idle_cv.wait(lock,
+                                       [&state]() { return state.directories.empty() || state.pumps_alive == 0; });
+                }
+            }
+
+            std::unique_ptr<StoppableWorker> pump = std::move(state.pump);
+            std::unique_ptr<StoppableWorker> dispatcher = std::move(state.dispatcher);
+            if (pump != nullptr)
+            {
+                pump->shutdown();
+            }
+            if (dispatcher != nullptr)
+            {
+                dispatcher->shutdown();
+            }
+        }
+
+        bool is_file_watch_dispatch_thread(std::thread::id id) noexcept
+        {
+            const std::thread::id dispatcher = service_state().dispatch_thread.load(std::memory_order_acquire);
+            return dispatcher != std::thread::id{} && dispatcher == id;
+        }
+
+        std::size_t file_watch_count() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            std::size_t count = 0;
+            for (const std::unique_ptr<WatchedDirectory> &dir : state.directories)
+            {
+                count += dir->watches.size();
+            }
+            return count;
+        }
+
+        std::size_t watched_directory_count() noexcept
+        {
+            ServiceState &state = service_state();
+            std::lock_guard<std::mutex> lock(state.mutex);
+            return static_cast<std::size_t>(std::count_if(state.directories.begin(), state.directories.end(),
+                                                          [](const std::unique_ptr<WatchedDirectory> &dir)
+                                                          { return !dir->closing && !dir->failed; }));
+        }
+
+        std::uint64_t file_watch_threads_started() noexcept
+        {
+            return service_state().threads_started.load(std::memory_order_relaxed);
+        }
+    } // namespace detail
+} // namespace DetourModKit
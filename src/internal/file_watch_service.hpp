@@ -0,0 +1,108 @@
+#ifndef DETOURMODKIT_INTERNAL_FILE_WATCH_SERVICE_HPP
+#define DETOURMODKIT_INTERNAL_FILE_WATCH_SERVICE_HPP
+
+/**
+ * @file internal/file_watch_service.hpp
+ * @brief True-private process-wide file watcher: every watched file on one I/O completion port and one pump thread.
+ * @details Never installed. Each watched directory holds one overlapped ReadDirectoryChangesW, shared by every file
+ *          watched in it and completed through a single I/O completion port. One pump thread dequeues the
+ *          completions, matches the changed names against the files watched in that directory, and runs each file's
+ *          debounce deadline; a second dispatch thread runs the change callbacks, so a slow reload never delays change
+ *          detection for another file. A session watching a config file and any number of manifests therefore costs
+ *          two threads instead of one per file.
+ *
+ *          Callbacks run one at a time on the dispatch thread, outside the service's lock. An exception escaping a
+ *          callback is caught, logged, and swallowed.
+ */
+
+#include "DetourModKit/error.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <thread>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// Identifies one watched file; never reused within a process.
+        using FileWatchId = std::uint64_t;
+        /// The id no watch has; unwatch_file() and detach_file_watch() ignore it.
+        inline constexpr FileWatchId NO_FILE_WATCH = 0;
+
+        /**
+         * @struct FileWatchOptions
+         * @brief Per-file change filtering.
+         */
+        struct FileWatchOptions
+        {
+            /// Quiet window: the callback runs once no change to the file has been seen for this long.
+            std::chrono::milliseconds debounce{250};
+            /**
+             * @brief Hash the file when the quiet window ends and skip the callback when the bytes match those of the
+             *        last change delivered (or of registration).
+             * @details A file that cannot be read at that moment counts as changed.
+             */
+            bool skip_unchanged_content = false;
+        };
+
+        /**
+         * @brief Calls @p on_change on the dispatch thread each time @p path changes and then stays quiet for the
+         *        debounce window.
+         * @details The file need not exist; its parent directory must. Starts the service threads on first use. A
+         *          write, a resize, and a rename onto @p path all count as changes, and names match
+         *          case-insensitively. A notification-buffer overflow counts as a change to every file watched in that
+         *          directory. When this returns the directory's read is already queued, so a change made afterwards is
+         *          seen.
+         * @return The watch's id, `ErrorCode::InvalidArg` for an empty @p on_change or a path with no file or
+         *         directory part, `ErrorCode::SystemCallFailed` (detail: the Win32 error) when the directory cannot be
+         *         opened or watched or a service thread cannot start, or `ErrorCode::OutOfMemory`.
+         */
+        [[nodiscard]] Result<FileWatchId> watch_file(std::string_view path, const FileWatchOptions &options,
+                                                     std::function<void()> on_change);
+
+        /**
+         * @brief Stops watching @p id.
+         * @param flush_pending When a change is still inside its quiet window, deliver it now instead of dropping it.
+         * @details Waits until the watch's callback is not running and will not run again, and until its directory's
+         *          read has drained when it was the directory's last watch. From the dispatch thread -- inside a
+         *          callback -- nothing is waited for and nothing is flushed; callbacks already queued for the watch are
+         *          dropped. Under the loader lock nothing is waited for.
+         * @return true when the watch's callback will not run again (or @p id is unknown); false when the loader lock
+         *         prevented the wait.
+         */
+        bool unwatch_file(FileWatchId id, bool flush_pending) noexcept;
+
+        /**
+         * @brief Stops watching @p id without waiting or flushing, for teardown under the loader lock.
+         * @details Callbacks already queued for the watch are dropped; one already running finishes on the dispatch
+         *          thread, which keeps the callback alive until it returns.
+         */
+        void detach_file_watch(FileWatchId id) noexcept;
+
+        /**
+         * @brief Stops both service threads and drops every watch still registered.
+         * @details Waits for the directory reads to drain and joins the threads, or detaches them under the loader
+         *          lock (see StoppableWorker::shutdown()). The next watch_file() starts fresh threads. Owners are
+         *          expected to have unwatched their files first.
+         */
+        void shutdown_file_watch_service() noexcept;
+
+        /// True when @p id is the dispatch thread, i.e. the thread change callbacks run on.
+        [[nodiscard]] bool is_file_watch_dispatch_thread(std::thread::id id) noexcept;
+
+        /// Files currently watched.
+        [[nodiscard]] std::size_t file_watch_count() noexcept;
+
+        /// Directories currently holding a read, one per distinct parent directory of a watched file.
+        [[nodiscard]] std::size_t watched_directory_count() noexcept;
+
+        /// Pump threads started over the process lifetime; a steady value shows watches share one thread.
+        [[nodiscard]] std::uint64_t file_watch_threads_started() noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_FILE_WATCH_SERVICE_HPP
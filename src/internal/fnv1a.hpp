@@ -0,0 +1,130 @@
+#ifndef DETOURMODKIT_INTERNAL_FNV1A_HPP
+#define DETOURMODKIT_INTERNAL_FNV1A_HPP
+
+/**
+ * @file internal/fnv1a.hpp
+ * @brief True-private FNV-1a 64 evidence hashing over scan candidates and their fields.
+ * @details Never installed. One definition of the stable, endianness-independent candidate hash, shared by the anchor
+ *          drift fingerprint and the resolution cache's request key so the two never disagree on candidate identity.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        // FNV-1a 64 evidence hashing for anchor_fingerprint and the resolution-cache request key. Both hashes are
+        // persisted (a diffed manifest, an on-disk cache) and must be stable across runs and builds, so integers are
+        // folded least-significant-byte first (a fixed order independent of host endianness) and every variable-length
+        // field is length-prefixed to keep adjacent fields unambiguous (the literal "ab" then "" cannot collide with
+        // "a" then "b").
+        inline constexpr std::uint64_t FNV1A64_OFFSET = 14695981039346656037ULL;
+        inline constexpr std::uint64_t FNV1A64_PRIME = 1099511628211ULL;
+
+        [[nodiscard]] inline std::uint64_t fnv1a_byte(std::uint64_t hash, std::uint8_t value) noexcept
+        {
+            return (hash ^ value) * FNV1A64_PRIME;
+        }
+
+        // Folds an integer least-significant-byte first over sizeof(T) so the result is endianness-independent. The
+        // value is widened to u64 before shifting so a 1-byte type never hits a shift-width edge case.
+        template <typename T> [[nodiscard]] inline std::uint64_t fnv1a_int(std::uint64_t hash, T value) noexcept
+        {
+            auto bits = static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(value));
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(bits & 0xFFu));
+                bits >>= 8;
+            }
+            return hash;
+        }
+
+        // Length-prefixed string field: the size (folded LSB-first) then the bytes, so adjacent fields never alias.
+        [[nodiscard]] inline std::uint64_t fnv1a_field(std::uint64_t hash, std::string_view field) noexcept
+        {
+            hash = fnv1a_int(hash, static_cast<std::uint64_t>(field.size()));
+            for (const char c : field)
+            {
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(c));
+            }
+            return hash;
+        }
+
+        // Length-prefixed raw-byte field for a compiled Pattern's bytes / mask spans.
+        [[nodiscard]] inline std::uint64_t fnv1a_bytes(std::uint64_t hash, std::span<const std::byte> data) noexcept
+        {
+            hash = fnv1a_int(hash, static_cast<std::uint64_t>(data.size()));
+            for (const std::byte b : data)
+            {
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(b));
+            }
+            return hash;
+        }
+
+        // Hashes one candidate's address-independent CONTENT. scan::Pattern is compiled and does not retain its
+        // source string, so the byte tiers hash the compiled bytes + wildcard mask + result-offset plus the decode
+        // parameters -- content that is stable across a diff and computable without re-parsing. The text tiers hash
+        // their owned name / literal and shape flags directly.
+        [[nodiscard]] inline std::uint64_t fnv1a_candidate(std::uint64_t hash,
+                                                           const scan::Candidate &candidate) noexcept
+        {
+            hash = fnv1a_byte(hash, static_cast<std::uint8_t>(candidate.mode()));
+            switch (candidate.mode())
+            {
+            case scan::Mode::Direct:
+            {
+                const scan::DirectPattern &direct = *candidate.as_direct();
+                hash = fnv1a_bytes(hash, direct.pattern.bytes());
+                hash = fnv1a_bytes(hash, direct.pattern.mask());
+                hash = fnv1a_int(hash, static_cast<std::uint64_t>(direct.pattern.offset()));
+                hash = fnv1a_int(hash, static_cast<std::int64_t>(direct.walk_back));
+                break;
+            }
+            case scan::Mode::RipRelative:
+            {
+                const scan::RipRelativePattern &rip = *candidate.as_rip_relative();
+                hash = fnv1a_bytes(hash, rip.pattern.bytes());
+                hash = fnv1a_bytes(hash, rip.pattern.mask());
+                hash = fnv1a_int(hash, static_cast<std::uint64_t>(rip.pattern.offset()));
+                hash = fnv1a_int(hash, static_cast<std::int64_t>(rip.displacement_at));
+                hash = fnv1a_int(hash, static_cast<std::uint64_t>(rip.instruction_length));
+                break;
+            }
+            case scan::Mode::RttiVtable:
+                hash = fnv1a_field(hash, candidate.as_rtti_vtable()->mangled);
+                break;
+            case scan::Mode::StringXref:
+            {
+                const scan::StringXref &xref = *candidate.as_string_xref();
+                hash = fnv1a_field(hash, xref.text);
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(xref.encoding));
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(xref.return_mode));
+                hash = fnv1a_byte(hash, xref.require_terminator ? 1U : 0U);
+                hash = fnv1a_byte(hash, xref.broad_match ? 1U : 0U);
+                break;
+            }
+            }
+            return hash;
+        }
+
+        [[nodiscard]] inline std::uint64_t fnv1a_cascade(std::uint64_t hash,
+                                                         std::span<const scan::Candidate> site) noexcept
+        {
+            hash = fnv1a_int(hash, static_cast<std::uint64_t>(site.size()));
+            for (const scan::Candidate &candidate : site)
+            {
+                hash = fnv1a_candidate(hash, candidate);
+            }
+            return hash;
+        }
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_FNV1A_HPP
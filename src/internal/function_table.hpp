@@ -0,0 +1,50 @@
+#ifndef DETOURMODKIT_INTERNAL_FUNCTION_TABLE_HPP
+#define DETOURMODKIT_INTERNAL_FUNCTION_TABLE_HPP
+
+/**
+ * @file internal/function_table.hpp
+ * @brief Private seam to the per-module function-boundary index built from a module's exception directory.
+ * @details The index lives in scan_function_table.cpp. It is built once per mapped image from the image's own .pdata,
+ *          with every funclet and split fragment already folded to its primary function, and is shared by the
+ *          public scan::function_containing and the string-xref enclosing-function lookup.
+ */
+
+#include <cstdint>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// One RUNTIME_FUNCTION range and the primary function it belongs to, as absolute addresses.
+        struct FunctionRange
+        {
+            /// Primary function entry: the root of the unwind chain, or @ref begin for an unchained range.
+            std::uintptr_t entry = 0;
+            /// Start of the range containing the queried address.
+            std::uintptr_t begin = 0;
+            /// One past the end of that range.
+            std::uintptr_t end = 0;
+        };
+
+        /// Outcome of a function-boundary lookup.
+        enum class FunctionLookup : std::uint8_t
+        {
+            /// The address lies in a registered range; the out-parameter is filled.
+            Found,
+            /// The owning image has an index but no range holds the address (a leaf function, padding, or data).
+            NotInTable,
+            /// No index answers (no owning image, no exception directory, or a failed build); ask the OS instead.
+            NoTable
+        };
+
+        /**
+         * @brief Finds the function range containing @p address through its module's cached index.
+         * @details The first lookup in a module builds its index; later ones re-read the module's headers to confirm
+         *          the index still describes the image mapped there, then binary-search it. noexcept: a failed build
+         *          reports NoTable.
+         */
+        [[nodiscard]] FunctionLookup lookup_function(std::uintptr_t address, FunctionRange &out) noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_FUNCTION_TABLE_HPP
@@ -0,0 +1,97 @@
+#ifndef DETOURMODKIT_INTERNAL_GAMEPAD_PROBE_HPP
+#define DETOURMODKIT_INTERNAL_GAMEPAD_PROBE_HPP
+
+/**
+ * @file gamepad_probe.hpp
+ * @brief Internal schedule deciding when the poll loop calls XInputGetState for its controller slot.
+ * @details Poll-thread-private helper used by InputPoller. XInputGetState on an empty slot is far more expensive than
+ *          on a connected one (it re-enumerates devices before reporting ERROR_DEVICE_NOT_CONNECTED), so a connected
+ *          slot is read every cycle while a disconnected one is probed on an exponential backoff. A change in the
+ *          system's input device count, which the caller samples cheaply, cuts the backoff short so a controller
+ *          that is plugged in is picked up on the next cycle. Windows-agnostic so it is unit-testable on synthetic
+ *          time. Not installed.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+namespace DetourModKit::detail
+{
+    /// First wait after a slot is found empty; each further empty probe doubles it.
+    inline constexpr std::chrono::milliseconds GAMEPAD_PROBE_MIN_BACKOFF{1000};
+    /// Cap on the empty-slot backoff.
+    inline constexpr std::chrono::milliseconds GAMEPAD_PROBE_MAX_BACKOFF{8000};
+
+    /**
+     * @class GamepadProbeSchedule
+     * @brief Connection state and next-probe deadline for one XInput slot.
+     */
+    class GamepadProbeSchedule
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Whether to call XInputGetState this cycle.
+         * @param now The cycle's time.
+         * @param device_count The system's current input device count; a change since the last call means a device
+         *        arrived or left, and probes at once. Pass the same value every call to rely on the backoff alone.
+         */
+        [[nodiscard]] bool should_probe(Clock::time_point now, std::uint32_t device_count) noexcept
+        {
+            if (m_connected)
+            {
+                return true;
+            }
+            // The first count seen after a connect (or ever) is only adopted: there is nothing to compare it to.
+            const bool devices_changed = m_device_count != UNKNOWN_COUNT && device_count != m_device_count;
+            m_device_count = device_count;
+            return devices_changed || now >= m_next_probe;
+        }
+
+        /// Records a probe's outcome and, for an empty slot, schedules the next probe.
+        void record(bool connected, Clock::time_point now) noexcept
+        {
+            if (connected)
+            {
+                m_connected = true;
+                m_probed_empty = false;
+                m_device_count = UNKNOWN_COUNT;
+                m_backoff = GAMEPAD_PROBE_MIN_BACKOFF;
+                return;
+            }
+            if (m_connected || !m_probed_empty)
+            {
+                m_backoff = GAMEPAD_PROBE_MIN_BACKOFF;
+            }
+            else
+            {
+                m_backoff = std::min(m_backoff * 2, GAMEPAD_PROBE_MAX_BACKOFF);
+            }
+            m_connected = false;
+            m_probed_empty = true;
+            m_next_probe = now + m_backoff;
+        }
+
+        /// Whether the last probe found a controller.
+        [[nodiscard]] bool connected() const noexcept { return m_connected; }
+
+        /// The wait before the next empty-slot probe.
+        [[nodiscard]] std::chrono::milliseconds backoff() const noexcept { return m_backoff; }
+
+    private:
+        static constexpr std::uint32_t UNKNOWN_COUNT = std::numeric_limits<std::uint32_t>::max();
+
+        bool m_connected{false};
+        // Whether the previous probe found the slot empty too; only then does the backoff double.
+        bool m_probed_empty{false};
+        std::chrono::milliseconds m_backoff{GAMEPAD_PROBE_MIN_BACKOFF};
+        // The first cycle probes at once: the deadline is in the past.
+        Clock::time_point m_next_probe{};
+        std::uint32_t m_device_count{UNKNOWN_COUNT};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_GAMEPAD_PROBE_HPP
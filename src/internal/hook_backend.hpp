@@ -18,10 +18,12 @@
 
 #include "DetourModKit/hook.hpp"
 
+#include "internal/hook_stats.hpp"
 #include "internal/srw_shared_mutex.hpp"
 
 #include "safetyhook.hpp"
 
+#include <array>
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
@@ -52,44 +54,190 @@ namespace DetourModKit
         };
 
         /**
-         * @brief The refcounted call gate that outlives the backend it fronts, so a late @ref Hook::call is safe.
-         * @details The guarded @ref Hook::call must survive a concurrent teardown that frees the backend trampoline.
-         *          It cannot do that if the mutex it locks lives inside the same @ref Hook::Impl the teardown
-         *          destroys, because a caller stalled just before acquiring the lock would then dereference freed
-         *          storage. The gate breaks that coupling: it holds only the per-hook recursive_mutex and the
-         *          currently-callable trampoline pointer, is owned by a shared_ptr that @ref Hook::call copies into a
-         *          local strong reference BEFORE locking, and is therefore kept alive by any in-flight call even after
-         *          the handle drops its own reference during teardown. The trampoline is published under the mutex, so
-         *          a late caller that acquires the lock after teardown reads a nullptr callable and fails closed to the
-         *          inactive default instead of dispatching through a trampoline the backend destructor has freed.
+         * @brief The lock-free call gate that fronts a hook's trampoline for the guarded @ref Hook::call.
+         * @details The guarded call must survive a concurrent teardown that frees the backend trampoline, without
+         *          serializing callers against each other. Callers never lock: each raises the in-flight count on one
+         *          of STRIPE_COUNT cache-line-padded stripes (chosen from its thread id, so its enter and leave land on
+         *          the same stripe), then re-reads the handle's gate pointer and `callable`, and only dispatches when
+         *          both are still live. A writer that must stop dispatch publishes a null `callable` and then waits for
+         *          the stripe sum to reach zero. The count increment, the re-reads, the null publish, and the drain's
+         *          stripe loads are all seq_cst, the same Dekker protocol as the guarded-read VEH drain: a caller that
+         *          saw a live trampoline is counted before the drain can observe zero, and a caller the drain did not
+         *          count sees the null and backs out.
          *
-         *          The mutex is recursive because a detour may re-enter @ref Hook::call on the same handle (the
-         *          original it calls can itself be hooked). `callable` is the inline trampoline while the hook is armed
-         *          and inline, and nullptr otherwise: a disabled hook, a mid hook, or a normally torn-down hook (~Hook
-         *          nulls it under `mutex` before freeing the backend). The one exception is the loader-lock teardown
-         *          branch, which intentionally leaks the backend -- its module reference was taken before publication
-         *          and keeps the code mapped -- and leaves `callable` set, so a late guarded @ref Hook::call through
-         *          the still-live gate keeps dispatching to the leaked-but-live trampoline. It is a plain pointer
-         *          guarded by `mutex`, not an atomic, because every reader and writer holds `mutex`.
+         *          `control` serializes the writers (enable, disable, teardown) with each other; the call path never
+         *          touches it, so a detour can re-enter @ref Hook::call on the same handle and recursion only stacks
+         *          counts. `callable` is the inline trampoline while the hook is armed and inline, and nullptr
+         *          otherwise: a disabled hook, a mid hook, or a normally torn-down hook. The one exception is the
+         *          loader-lock teardown branch, which intentionally leaks the backend -- its module reference was taken
+         *          before publication and keeps the code mapped -- together with the gate, leaving `callable` set so
+         *          an in-flight call keeps running on the leaked-but-live trampoline.
+         *
+         *          A drained gate is not freed but pushed onto a process-wide free list (`next_free`) and reused by the
+         *          next install. A caller that read a gate pointer just before the teardown therefore always
+         *          increments live memory; its re-read of the handle then fails and it backs the count out again.
          */
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: Stripe is intentionally padded to a full cache line by alignas(64) so concurrent callers never share one.
+#pragma warning(disable : 4324)
+#endif
         struct Hook::CallGate
         {
-            std::recursive_mutex mutex;
-            void *callable{nullptr};
+            static constexpr std::size_t STRIPE_COUNT = 16;
+
+            struct alignas(64) Stripe
+            {
+                std::atomic<int> count{0};
+            };
+
+            std::array<Stripe, STRIPE_COUNT> in_flight{};
+            std::mutex control;
+            std::atomic<void *> callable{nullptr};
+            CallGate *next_free{nullptr};
+#ifdef DMK_ENABLE_HOOK_STATS
+            // The owning inline hook's stats record, or nullptr (mid hooks time their detour instead). Set before the
+            // gate is handed to a Hook, cleared on recycle; leave_call records into it before dropping its count.
+            std::atomic<DetourModKit::detail::HookCallStats *> stats{nullptr};
+            static_assert(STRIPE_COUNT == DetourModKit::detail::HookCallStats::SHARD_COUNT,
+                          "a dispatch's stripe doubles as its stats shard");
+#endif
+
+            /// A cleared gate from the free list, or a new one; throws std::bad_alloc. Defined in hook.cpp.
+            [[nodiscard]] static CallGate *acquire();
+
+            /// Clears a drained gate and returns it to the free list. Defined in hook.cpp.
+            static void recycle(CallGate *gate) noexcept;
+
+            /// The stripe the calling thread counts itself on. Defined in hook.cpp.
+            [[nodiscard]] static std::size_t stripe_index() noexcept;
+
+            /// Locks `control`; an unowned lock when std::mutex::lock throws. Defined in hook.cpp.
+            [[nodiscard]] std::unique_lock<std::mutex> lock_control() noexcept;
+
+            /// Waits until no guarded call is in flight. Defined in hook.cpp.
+            void drain() noexcept;
+
+            /// unique_ptr deleter that recycles instead of deleting, for the install paths' rollback.
+            struct Recycler
+            {
+                void operator()(CallGate *gate) const noexcept { recycle(gate); }
+            };
         };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#ifdef DMK_ENABLE_HOOK_STATS
+        /**
+         * @brief A hook's stats record, plus the mid-hook timing thunk slot when it holds one.
+         * @details Declared as the first member of @ref Hook::Impl so it is destroyed last, after the backend member
+         *          has restored the prologue: no new entry can reach the thunk by then, so the slot and the record
+         *          are free to be reused. A leaked Impl leaks its lease too, and the still-installed hook keeps
+         *          reporting. Move-assignment swaps, so the previous contents are released with the source.
+         */
+        struct HookStatsLease
+        {
+            DetourModKit::detail::HookCallStats *stats{nullptr};
+            /// Index into the mid-hook timing thunk table, or -1.
+            int mid_slot{-1};
+
+            HookStatsLease() noexcept = default;
+            HookStatsLease(HookStatsLease &&other) noexcept
+                : stats(std::exchange(other.stats, nullptr)), mid_slot(std::exchange(other.mid_slot, -1))
+            {
+            }
+            HookStatsLease &operator=(HookStatsLease &&other) noexcept
+            {
+                std::swap(stats, other.stats);
+                std::swap(mid_slot, other.mid_slot);
+                return *this;
+            }
+            HookStatsLease(const HookStatsLease &) = delete;
+            HookStatsLease &operator=(const HookStatsLease &) = delete;
+
+            /// Frees the thunk slot, then returns the record to the registry. Defined in hook.cpp.
+            ~HookStatsLease();
+        };
+#endif
+
+        /**
+         * @brief A mid hook built on a DMK-emitted capture stub, for a narrowed @ref MidCapture.
+         * @details The stub lays out the backend's Context64 exactly, so the MidContext accessors read it unchanged,
+         *          but moves only the declared XMM registers. `hook` is a backend inline hook from the target to the
+         *          stub and owns the relocated prologue the stub resumes into. It is declared after `stub` so it is
+         *          destroyed first: the prologue is restored before the stub's memory returns to the allocator.
+         *          enable / disable / bool forward to `hook`, the members @ref Hook visits the backend for.
+         */
+        struct LiteMidHook
+        {
+            safetyhook::Allocation stub;
+            safetyhook::InlineHook hook;
+
+            explicit operator bool() const noexcept { return static_cast<bool>(hook); }
+            [[nodiscard]] auto enable() { return hook.enable(); }
+            [[nodiscard]] auto disable() { return hook.disable(); }
+        };
+
+        /**
+         * @brief An inline hook armed through the target's hot-patch pad (see @ref Options::hot_patch).
+         * @details The five filler bytes before the entry hold a rel32 JMP to an absolute jump to the detour, and
+         *          arming writes `jmp $-5` (EB F9) over the 2-byte entry instruction with one InterlockedExchange16.
+         *          The entry is 2-byte aligned, so every thread executes either the old two bytes or the new two,
+         *          never a mix, and no thread needs to be trapped or stopped; enable and disable touch nothing else.
+         *          `stub` holds the original (the replaced entry instruction replayed, then an absolute jump to
+         *          entry + 2) followed by the detour jump the pad lands on. Destruction disarms the entry first and
+         *          only then restores the filler. The member functions live in hook.cpp.
+         */
+        class HotPatchHook
+        {
+        public:
+            HotPatchHook(safetyhook::Allocation stub, std::uintptr_t entry, std::array<std::uint8_t, 2> entry_bytes,
+                         std::array<std::uint8_t, 5> pad_bytes) noexcept;
+            HotPatchHook(HotPatchHook &&other) noexcept;
+            HotPatchHook &operator=(HotPatchHook &&other) noexcept;
+            HotPatchHook(const HotPatchHook &) = delete;
+            HotPatchHook &operator=(const HotPatchHook &) = delete;
+            ~HotPatchHook() noexcept;
+
+            explicit operator bool() const noexcept { return m_entry != 0; }
+            [[nodiscard]] Result<void> enable() noexcept;
+            [[nodiscard]] Result<void> disable() noexcept;
+            [[nodiscard]] bool enabled() const noexcept { return m_enabled; }
+            /// The callable original: the replayed entry instruction, then the jump back to entry + 2.
+            [[nodiscard]] void *original() const noexcept { return m_entry != 0 ? m_stub.data() : nullptr; }
+
+        private:
+            // Swaps the entry's two bytes for @p bytes in one atomic store; nothing is written when the page
+            // protection cannot be changed.
+            [[nodiscard]] Result<void> store_entry(std::array<std::uint8_t, 2> bytes) noexcept;
+            void reset() noexcept;
+
+            safetyhook::Allocation m_stub;
+            std::uintptr_t m_entry{0};
+            std::array<std::uint8_t, 2> m_entry_bytes{};
+            std::array<std::uint8_t, 5> m_pad_bytes{};
+            bool m_enabled{false};
+        };
+
+        /// Every backend a @ref Hook can own; the active alternative tells the inline and mid flavours apart.
+        using HookBackend = std::variant<safetyhook::InlineHook, safetyhook::MidHook, LiteMidHook, HotPatchHook>;
 
         /**
          * @brief The complete backend state behind a @ref Hook handle.
          * @details Holds the backend inline OR mid hook in a variant (inline vs mid is the active alternative), the
          *          atomic enable/disable status, the registered name, the patched target address, and the ledger id
-         *          used to deregister on teardown. The per-hook recursive_mutex that serializes call/enable/disable/
-         *          teardown lives in a separate refcounted @ref Hook::CallGate (not here) so a late @ref Hook::call
-         *          keeps the mutex alive after this Impl is destroyed; see that type. The atomic status makes Impl
+         *          used to deregister on teardown. The in-flight counts and the writer mutex live in a separate,
+         *          recycled @ref Hook::CallGate (not here) so a late @ref Hook::call never touches a destroyed Impl;
+         *          see that type. The atomic status makes Impl
          *          non-movable, which is why it lives behind a unique_ptr.
          */
         struct Hook::Impl
         {
-            std::variant<safetyhook::InlineHook, safetyhook::MidHook> backend;
+#ifdef DMK_ENABLE_HOOK_STATS
+            HookStatsLease stats_lease;
+#endif
+            HookBackend backend;
             std::atomic<HookState> status;
             std::string name;
             std::uintptr_t target{0};
@@ -115,13 +263,28 @@ namespace DetourModKit
                   ledger_id(ledger), is_inline(false)
             {
             }
+
+            Impl(HotPatchHook hook, std::string hook_name, std::uintptr_t hook_target, std::uint64_t ledger,
+                 HookState initial_state)
+                : backend(std::move(hook)), status(initial_state), name(std::move(hook_name)), target(hook_target),
+                  ledger_id(ledger), is_inline(true)
+            {
+            }
+
+            Impl(LiteMidHook hook, std::string hook_name, std::uintptr_t hook_target, std::uint64_t ledger,
+                 HookState initial_state)
+                : backend(std::move(hook)), status(initial_state), name(std::move(hook_name)), target(hook_target),
+                  ledger_id(ledger), is_inline(false)
+            {
+            }
         };
 
         /**
          * @brief The complete backend state behind a @ref VmtHook handle.
          * @details Owns the backend VMT hook (the cloned vtable), the registered name, the cloned-vptr base recorded
-         *          at create (so an apply can tell "already on my clone" from "on another hook's clone"), the number
-         *          of callable slots in the clone, the ledger id, and the per-index method-hook table.
+         *          at create (so an apply can tell "already on my clone" from "on another hook's clone"), the seed's
+         *          original vptr (the class identity a batch apply checks), the number of callable slots in the clone,
+         *          the ledger id, and the per-index method-hook table.
          *
          *          Per-method hooks are backend VmHooks keyed by vtable index. Each VmHook, on destruction, rewrites
          *          its cloned-vtable slot back to the original function pointer, so erasing an entry (@ref
@@ -144,6 +307,9 @@ namespace DetourModKit
             safetyhook::VmtHook backend;
             std::string name;
             std::uintptr_t cloned_vptr_base{0};
+            // The seed's vptr before the clone went on (0 when it could not be read); apply_to_many accepts only
+            // objects still carrying it.
+            std::uintptr_t source_vptr{0};
             std::size_t method_count{0};
             std::uint64_t ledger_id{0};
             // Counted reference on the module this clone's code lives in, taken before the clone is published;
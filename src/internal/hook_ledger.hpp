@@ -16,17 +16,24 @@
  *          many NEWER live hooks still sit on the same target. A non-zero answer means the caller is unwinding layered
  *          same-target hooks out of order, so the backend is intentionally leaked rather than restoring a prologue
  *          that a newer trampoline still depends on.
+ *
+ *          Targets are spread over SHARD_COUNT shards by a multiplicative hash of the address, each with its own mutex,
+ *          install condition variable, and open-addressing table, so installs and teardowns on unrelated targets never
+ *          meet on one lock. @ref HookLedger::is_target_hooked reads a shard's table without locking: a key, once
+ *          placed, never moves within its table, and a grown table replaces the old one by one atomic pointer swap. A
+ *          replaced table is freed only when no lock-free reader is counted on the shard, otherwise at a later growth.
  */
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
 namespace DetourModKit
@@ -99,12 +106,19 @@ namespace DetourModKit
              */
             [[nodiscard]] Reservation try_reserve_hook(std::uintptr_t target, bool refuse_if_hooked) noexcept
             {
+                if (target == 0)
+                {
+                    // 0 marks an empty table slot, so it cannot be tracked. Every install path has already refused a
+                    // null target; fail closed like any other bookkeeping failure.
+                    return Reservation{ReserveStatus::OutOfMemory, 0, false};
+                }
                 const std::uint64_t id = m_next_id.fetch_add(1, std::memory_order_relaxed);
+                Shard &shard = shard_for(target);
                 try
                 {
-                    std::unique_lock<std::mutex> guard(m_mutex);
-                    const auto it = m_by_target.find(target);
-                    const bool preexisting = (it != m_by_target.end());
+                    std::unique_lock<std::mutex> guard(shard.mutex);
+                    const Slot *existing = find(shard.current.get(), target);
+                    const bool preexisting = existing != nullptr && !existing->entry.order.empty();
                     if (preexisting && refuse_if_hooked)
                     {
                         // Exact same-kit duplicate at this target: refuse without reserving. The id is simply skipped
@@ -118,30 +132,15 @@ namespace DetourModKit
                     // -- and `pending` holds only in-flight reservations, bounded by the number of concurrent
                     // installer threads (a single thread must commit or release before reserving the same target
                     // again, or it deadlocks on the wait below per the @warning, so it cannot grow the queue alone).
-                    if (preexisting)
-                    {
-                        // Layering on an already-tracked target: push_back gives the strong guarantee, so a failed
-                        // growth leaves the existing order vector unchanged.
-                        it->second.order.push_back(id);
-                        it->second.pending.push_back(id);
-                    }
-                    else
-                    {
-                        // Build the order vector fully before publishing it, so a throwing allocation never leaves an
-                        // empty entry in the map (which is_target_hooked would misread as a live hook).
-                        TargetEntry entry;
-                        entry.order.push_back(id);
-                        entry.pending.push_back(id);
-                        m_by_target.emplace(target, std::move(entry));
-                    }
+                    //
+                    // A throwing insert or push_back leaves at worst a keyed slot with an empty order, which every
+                    // reader treats as unhooked; the catch below rolls back an id that did reach `order`.
+                    Slot &slot = insert(shard, target);
+                    slot.entry.order.push_back(id);
+                    slot.entry.pending.push_back(id);
+                    publish_live(slot);
 
-                    m_install_cv.wait(guard,
-                                      [this, target, id]
-                                      {
-                                          const auto current = m_by_target.find(target);
-                                          return current != m_by_target.end() && !current->second.pending.empty() &&
-                                                 current->second.pending.front() == id;
-                                      });
+                    shard.install_cv.wait(guard, [&shard, target, id] { return is_pending_front(shard, target, id); });
                     return Reservation{ReserveStatus::Reserved, id, preexisting};
                 }
                 catch (...)
@@ -159,19 +158,20 @@ namespace DetourModKit
              */
             void commit_hook(std::uintptr_t target, std::uint64_t id) noexcept
             {
-                std::lock_guard<std::mutex> guard(m_mutex);
-                auto it = m_by_target.find(target);
-                if (it == m_by_target.end())
+                Shard &shard = shard_for(target);
+                std::lock_guard<std::mutex> guard(shard.mutex);
+                Slot *slot = find(shard.current.get(), target);
+                if (slot == nullptr)
                 {
                     return;
                 }
-                std::vector<std::uint64_t> &pending = it->second.pending;
+                std::vector<std::uint64_t> &pending = slot->entry.pending;
                 const auto found = std::find(pending.begin(), pending.end(), id);
                 if (found != pending.end())
                 {
                     pending.erase(found);
                 }
-                m_install_cv.notify_all();
+                shard.install_cv.notify_all();
             }
 
             /**
@@ -183,34 +183,34 @@ namespace DetourModKit
              */
             [[nodiscard]] std::size_t release_hook(std::uintptr_t target, std::uint64_t id) noexcept
             {
-                std::lock_guard<std::mutex> guard(m_mutex);
-                auto it = m_by_target.find(target);
-                if (it == m_by_target.end())
+                Shard &shard = shard_for(target);
+                std::lock_guard<std::mutex> guard(shard.mutex);
+                Slot *slot = find(shard.current.get(), target);
+                if (slot == nullptr)
                 {
                     return 0;
                 }
-                std::vector<std::uint64_t> &pending = it->second.pending;
+                std::vector<std::uint64_t> &pending = slot->entry.pending;
                 const auto pending_found = std::find(pending.begin(), pending.end(), id);
                 if (pending_found != pending.end())
                 {
                     pending.erase(pending_found);
                 }
 
-                std::vector<std::uint64_t> &order = it->second.order;
+                std::vector<std::uint64_t> &order = slot->entry.order;
                 const auto found = std::find(order.begin(), order.end(), id);
                 if (found == order.end())
                 {
-                    m_install_cv.notify_all();
+                    shard.install_cv.notify_all();
                     return 0;
                 }
                 // Entries after this id (toward the back) were created later: they are the newer layers still live.
                 const std::size_t newer = static_cast<std::size_t>(std::distance(std::next(found), order.end()));
                 order.erase(found);
-                if (order.empty())
-                {
-                    m_by_target.erase(it);
-                }
-                m_install_cv.notify_all();
+                // An emptied entry keeps its key (a slot never moves or empties within a table) and reads as unhooked;
+                // the next growth drops it.
+                publish_live(*slot);
+                shard.install_cv.notify_all();
                 return newer;
             }
 
@@ -239,22 +239,23 @@ namespace DetourModKit
              */
             [[nodiscard]] std::size_t acquire_teardown_slot(std::uintptr_t target, std::uint64_t id) noexcept
             {
-                std::unique_lock<std::mutex> guard(m_mutex);
-                auto it = m_by_target.find(target);
-                if (it == m_by_target.end())
+                Shard &shard = shard_for(target);
+                std::unique_lock<std::mutex> guard(shard.mutex);
+                Slot *slot = find(shard.current.get(), target);
+                if (slot == nullptr)
                 {
                     // Without the ledger entry there is no serialization guarantee. Fail closed to a backend leak.
                     return 1;
                 }
-                const auto order_found = std::find(it->second.order.begin(), it->second.order.end(), id);
-                if (order_found == it->second.order.end())
+                const auto order_found = std::find(slot->entry.order.begin(), slot->entry.order.end(), id);
+                if (order_found == slot->entry.order.end())
                 {
                     // An unknown id cannot safely claim this target's teardown right. Fail closed to a backend leak.
                     return 1;
                 }
                 try
                 {
-                    it->second.pending.push_back(id);
+                    slot->entry.pending.push_back(id);
                 }
                 catch (...)
                 {
@@ -264,21 +265,15 @@ namespace DetourModKit
                 }
                 // Wait our turn behind any installer already mid-patch on this target (front of pending), exactly as an
                 // installer does. Once this id is front, no install is touching the target's prologue.
-                m_install_cv.wait(guard,
-                                  [this, target, id]
-                                  {
-                                      const auto current = m_by_target.find(target);
-                                      return current != m_by_target.end() && !current->second.pending.empty() &&
-                                             current->second.pending.front() == id;
-                                  });
-                // Re-find under the still-held lock (a concurrent emplace/erase may have rehashed the map while we
+                shard.install_cv.wait(guard, [&shard, target, id] { return is_pending_front(shard, target, id); });
+                // Re-find under the still-held lock (a concurrent insert may have grown the shard's table while we
                 // waited) and measure the newer-live count at the instant the slot is owned.
-                const auto current = m_by_target.find(target);
-                if (current == m_by_target.end())
+                const Slot *current = find(shard.current.get(), target);
+                if (current == nullptr)
                 {
                     return 1;
                 }
-                const std::vector<std::uint64_t> &order = current->second.order;
+                const std::vector<std::uint64_t> &order = current->entry.order;
                 const auto found = std::find(order.begin(), order.end(), id);
                 if (found == order.end())
                 {
@@ -298,26 +293,40 @@ namespace DetourModKit
              */
             void release_teardown_slot(std::uintptr_t target, std::uint64_t id) noexcept
             {
-                std::lock_guard<std::mutex> guard(m_mutex);
-                auto it = m_by_target.find(target);
-                if (it == m_by_target.end())
+                Shard &shard = shard_for(target);
+                std::lock_guard<std::mutex> guard(shard.mutex);
+                Slot *slot = find(shard.current.get(), target);
+                if (slot == nullptr)
                 {
                     return;
                 }
-                std::vector<std::uint64_t> &pending = it->second.pending;
+                std::vector<std::uint64_t> &pending = slot->entry.pending;
                 const auto found = std::find(pending.begin(), pending.end(), id);
                 if (found != pending.end())
                 {
                     pending.erase(found);
                 }
-                m_install_cv.notify_all();
+                shard.install_cv.notify_all();
             }
 
-            /// True when this kit currently has at least one live or reserved hook for @p target.
+            /**
+             * @brief True when this kit currently has at least one live or reserved hook for @p target.
+             * @details Lock-free: counts itself on the shard's reader counter, probes the published table, and reads
+             *          the slot's live count. The seq_cst count and table load pair with the growth path's seq_cst
+             *          table swap and count check, so a table this probe might still be reading is never freed.
+             */
             [[nodiscard]] bool is_target_hooked(std::uintptr_t target) const noexcept
             {
-                std::lock_guard<std::mutex> guard(m_mutex);
-                return m_by_target.find(target) != m_by_target.end();
+                if (target == 0)
+                {
+                    return false;
+                }
+                const Shard &shard = shard_for(target);
+                shard.readers.fetch_add(1, std::memory_order_seq_cst);
+                const Slot *slot = find(shard.table.load(std::memory_order_seq_cst), target);
+                const bool hooked = slot != nullptr && slot->live.load(std::memory_order_acquire) > 0;
+                shard.readers.fetch_sub(1, std::memory_order_release);
+                return hooked;
             }
 
             // VMT clones -- keyed by the cloned-vptr base SafetyHook installs. One base per VmtHook (every object the
@@ -335,7 +344,7 @@ namespace DetourModKit
                 const std::uint64_t id = m_next_id.fetch_add(1, std::memory_order_relaxed);
                 try
                 {
-                    std::lock_guard<std::mutex> guard(m_mutex);
+                    std::lock_guard<std::mutex> guard(m_vmt_mutex);
                     // push_back gives the strong guarantee, so a failed growth leaves m_vmt unchanged.
                     m_vmt.push_back(VmtEntry{id, cloned_base});
                 }
@@ -349,7 +358,7 @@ namespace DetourModKit
             /// Removes the VMT clone @p id from the ledger.
             void release_vmt(std::uint64_t id) noexcept
             {
-                std::lock_guard<std::mutex> guard(m_mutex);
+                std::lock_guard<std::mutex> guard(m_vmt_mutex);
                 std::erase_if(m_vmt, [id](const VmtEntry &entry) { return entry.id == id; });
             }
 
@@ -360,7 +369,7 @@ namespace DetourModKit
                 {
                     return false;
                 }
-                std::lock_guard<std::mutex> guard(m_mutex);
+                std::lock_guard<std::mutex> guard(m_vmt_mutex);
                 return std::any_of(m_vmt.begin(), m_vmt.end(),
                                    [vptr](const VmtEntry &entry) { return entry.base == vptr; });
             }
@@ -368,6 +377,9 @@ namespace DetourModKit
         private:
             HookLedger() = default;
 
+            static constexpr std::size_t SHARD_COUNT = 16;
+            static constexpr std::size_t MIN_TABLE_CAPACITY = 16;
+
             struct VmtEntry
             {
                 std::uint64_t id;
@@ -380,10 +392,178 @@ namespace DetourModKit
                 std::vector<std::uint64_t> pending;
             };
 
-            mutable std::mutex m_mutex;
-            std::condition_variable m_install_cv;
-            // target address -> live/reserved hook ids in creation order (back = newest).
-            std::unordered_map<std::uintptr_t, TargetEntry> m_by_target;
+            // One open-addressing slot. `key` (0 = empty) is written once, before the slot is reachable by a reader,
+            // and never changes; `live` mirrors entry.order.size() for the lock-free readers. `entry` is touched only
+            // under the shard mutex.
+            struct Slot
+            {
+                std::atomic<std::uintptr_t> key{0};
+                std::atomic<std::size_t> live{0};
+                TargetEntry entry;
+            };
+
+            // A power-of-two linear-probing table kept at most half occupied, so every probe ends at an empty slot.
+            struct Table
+            {
+                explicit Table(std::size_t capacity) : slots(std::make_unique<Slot[]>(capacity)), mask(capacity - 1) {}
+
+                std::unique_ptr<Slot[]> slots;
+                std::size_t mask;
+                std::size_t occupied{0};
+            };
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure padded due to alignment specifier (intentional, per-shard cache line)
+#endif
+            struct alignas(64) Shard
+            {
+                std::mutex mutex;
+                std::condition_variable install_cv;
+                // The table readers probe; always current.get(), swapped only under `mutex`.
+                std::atomic<Table *> table{nullptr};
+                // Lock-free readers currently probing `table`.
+                mutable std::atomic<int> readers{0};
+                std::unique_ptr<Table> current;
+                // Tables replaced while a reader may still hold them, freed at a later growth.
+                std::vector<std::unique_ptr<Table>> retired;
+            };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+            [[nodiscard]] static std::uint64_t mix(std::uintptr_t target) noexcept
+            {
+                return static_cast<std::uint64_t>(target) * 0x9E3779B97F4A7C15ULL;
+            }
+
+            [[nodiscard]] Shard &shard_for(std::uintptr_t target) noexcept { return m_shards[mix(target) >> 60]; }
+            [[nodiscard]] const Shard &shard_for(std::uintptr_t target) const noexcept
+            {
+                return m_shards[mix(target) >> 60];
+            }
+
+            /// The slot keyed @p target in @p table, or nullptr. Safe without the lock on a published table.
+            [[nodiscard]] static Slot *find(Table *table, std::uintptr_t target) noexcept
+            {
+                if (table == nullptr)
+                {
+                    return nullptr;
+                }
+                for (std::size_t i = (mix(target) >> 20) & table->mask;; i = (i + 1) & table->mask)
+                {
+                    const std::uintptr_t key = table->slots[i].key.load(std::memory_order_acquire);
+                    if (key == target)
+                    {
+                        return &table->slots[i];
+                    }
+                    if (key == 0)
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+
+            /// Places @p target in the first empty slot of its probe run; the caller has checked it is absent.
+            static Slot &place(Table &table, std::uintptr_t target) noexcept
+            {
+                std::size_t i = (mix(target) >> 20) & table.mask;
+                while (table.slots[i].key.load(std::memory_order_relaxed) != 0)
+                {
+                    i = (i + 1) & table.mask;
+                }
+                ++table.occupied;
+                return table.slots[i];
+            }
+
+            /**
+             * @brief The slot for @p target in @p shard, keying a new one (growing the table first when it would pass
+             *        half occupancy). Caller holds the shard mutex.
+             * @throws std::bad_alloc from a table allocation; the shard is unchanged.
+             */
+            static Slot &insert(Shard &shard, std::uintptr_t target)
+            {
+                if (Slot *existing = find(shard.current.get(), target))
+                {
+                    return *existing;
+                }
+                if (!shard.current || (shard.current->occupied + 1) * 2 > shard.current->mask + 1)
+                {
+                    grow(shard);
+                }
+                Slot &slot = place(*shard.current, target);
+                // The entry is empty, so a reader that sees the key reads live == 0 until publish_live.
+                slot.key.store(target, std::memory_order_release);
+                return slot;
+            }
+
+            /**
+             * @brief Rebuilds @p shard's table sized for its live entries, dropping emptied keys, publishes it, and
+             *        frees the replaced tables when no lock-free reader is counted.
+             * @throws std::bad_alloc before anything is published; the shard is unchanged.
+             */
+            static void grow(Shard &shard)
+            {
+                std::size_t live = 0;
+                if (shard.current)
+                {
+                    for (std::size_t i = 0; i <= shard.current->mask; ++i)
+                    {
+                        live += shard.current->slots[i].entry.order.empty() ? 0 : 1;
+                    }
+                }
+                std::size_t capacity = MIN_TABLE_CAPACITY;
+                while (capacity < 4 * (live + 1))
+                {
+                    capacity *= 2;
+                }
+                auto next = std::make_unique<Table>(capacity);
+                shard.retired.reserve(shard.retired.size() + 1);
+                if (shard.current)
+                {
+                    for (std::size_t i = 0; i <= shard.current->mask; ++i)
+                    {
+                        Slot &old_slot = shard.current->slots[i];
+                        if (old_slot.entry.order.empty())
+                        {
+                            continue;
+                        }
+                        const std::uintptr_t key = old_slot.key.load(std::memory_order_relaxed);
+                        Slot &moved = place(*next, key);
+                        moved.entry = std::move(old_slot.entry);
+                        moved.live.store(moved.entry.order.size(), std::memory_order_relaxed);
+                        moved.key.store(key, std::memory_order_relaxed);
+                    }
+                }
+                // The seq_cst swap, then the seq_cst reader check: a reader counted after the check loads the new
+                // table, so only a reader already counted can still be probing a retired one.
+                shard.table.store(next.get(), std::memory_order_seq_cst);
+                if (shard.current)
+                {
+                    shard.retired.push_back(std::move(shard.current));
+                }
+                shard.current = std::move(next);
+                if (shard.readers.load(std::memory_order_seq_cst) == 0)
+                {
+                    shard.retired.clear();
+                }
+            }
+
+            /// Publishes @p slot's order size to the lock-free readers. Caller holds the shard mutex.
+            static void publish_live(Slot &slot) noexcept
+            {
+                slot.live.store(slot.entry.order.size(), std::memory_order_release);
+            }
+
+            /// The install-queue predicate: @p id heads @p target's pending queue. Caller holds the shard mutex.
+            [[nodiscard]] static bool is_pending_front(Shard &shard, std::uintptr_t target, std::uint64_t id) noexcept
+            {
+                const Slot *slot = find(shard.current.get(), target);
+                return slot != nullptr && !slot->entry.pending.empty() && slot->entry.pending.front() == id;
+            }
+
+            std::array<Shard, SHARD_COUNT> m_shards{};
+            mutable std::mutex m_vmt_mutex;
             // Live VMT clones (small; a linear scan is cheaper than a map at this size).
             std::vector<VmtEntry> m_vmt;
             std::atomic<std::uint64_t> m_next_id{1};
@@ -0,0 +1,225 @@
+#ifndef DETOURMODKIT_INTERNAL_HOOK_STATS_HPP
+#define DETOURMODKIT_INTERNAL_HOOK_STATS_HPP
+
+/**
+ * @file internal/hook_stats.hpp
+ * @brief Per-hook call counters and log2 latency histograms behind the DMK_ENABLE_HOOK_STATS build switch.
+ * @details Only hook.cpp records into these and only diagnostics.cpp reads them, and both do so under
+ *          `#ifdef DMK_ENABLE_HOOK_STATS`, so a default build carries no counter, no clock read, and no registry
+ *          traffic on any hook path. The clock is the QPC tick source @ref Profiler already uses, and
+ *          @ref diagnostics::collect reports the profiler's frequency next to the histograms.
+ *
+ *          Counters are sharded by thread-id hash the same way the hook call gate stripes its in-flight counts, so
+ *          threads calling one hot hook increment separate cache lines. Records are type-stable: the registry reuses
+ *          a released record for the next hook rather than freeing it, so a late recorder that still holds the
+ *          pointer touches live memory (at worst adding one stray sample to the next owner).
+ */
+
+#include "DetourModKit/diagnostics.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <windows.h>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure padded due to alignment specifier (intentional, per-shard cache line)
+#endif
+        /**
+         * @class HookCallStats
+         * @brief One hook's sharded call count, total ticks, and log2 latency histogram.
+         * @details Bucket 0 counts zero-tick samples and bucket `i` counts samples of `[2^(i-1), 2^i)` ticks; the last
+         *          bucket also absorbs everything longer. Every update is a relaxed RMW on the caller's shard.
+         */
+        class HookCallStats
+        {
+        public:
+            static constexpr std::size_t SHARD_COUNT = 16;
+
+            /// The current QPC tick count.
+            [[nodiscard]] static std::int64_t now() noexcept
+            {
+                LARGE_INTEGER ticks;
+                QueryPerformanceCounter(&ticks);
+                return ticks.QuadPart;
+            }
+
+            /// The calling thread's shard, from a multiplicative hash of its id.
+            [[nodiscard]] static std::size_t shard_index() noexcept
+            {
+                return static_cast<std::size_t>((static_cast<std::uint64_t>(GetCurrentThreadId()) *
+                                                 0x9E3779B97F4A7C15ULL) >>
+                                                48) %
+                       SHARD_COUNT;
+            }
+
+            /// Counts one call of @p elapsed ticks on @p shard.
+            void record(std::size_t shard, std::int64_t elapsed) noexcept
+            {
+                Shard &s = m_shards[shard];
+                const auto ticks = static_cast<std::uint64_t>(elapsed > 0 ? elapsed : 0);
+                const auto bucket = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(ticks)),
+                                                          diagnostics::HOOK_LATENCY_BUCKETS - 1);
+                s.calls.fetch_add(1, std::memory_order_relaxed);
+                s.ticks.fetch_add(ticks, std::memory_order_relaxed);
+                s.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+            }
+
+            /// Zeroes every shard; only the registry calls it, while no hook owns the record.
+            void reset() noexcept
+            {
+                for (Shard &s : m_shards)
+                {
+                    s.calls.store(0, std::memory_order_relaxed);
+                    s.ticks.store(0, std::memory_order_relaxed);
+                    for (std::atomic<std::uint64_t> &bucket : s.buckets)
+                    {
+                        bucket.store(0, std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            /// Sums every shard into @p out's counters.
+            void accumulate(diagnostics::HookStats &out) const noexcept
+            {
+                for (const Shard &s : m_shards)
+                {
+                    out.calls += s.calls.load(std::memory_order_relaxed);
+                    out.total_ticks += s.ticks.load(std::memory_order_relaxed);
+                    for (std::size_t i = 0; i < s.buckets.size(); ++i)
+                    {
+                        out.latency_buckets[i] += s.buckets[i].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+        private:
+            struct alignas(64) Shard
+            {
+                std::atomic<std::uint64_t> calls{0};
+                std::atomic<std::uint64_t> ticks{0};
+                std::array<std::atomic<std::uint64_t>, diagnostics::HOOK_LATENCY_BUCKETS> buckets{};
+            };
+
+            std::array<Shard, SHARD_COUNT> m_shards{};
+        };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+        /**
+         * @class HookStatsRegistry
+         * @brief Process-wide list of the live hooks' @ref HookCallStats, for @ref diagnostics::collect to enumerate.
+         * @details Control-plane only: acquire and release run at hook install and teardown, collect from a
+         *          diagnostics caller, all under one mutex. The hot path never touches the registry, only the record
+         *          pointer it handed out.
+         */
+        class HookStatsRegistry
+        {
+        public:
+            /// The process-wide registry; never destroyed, so a hook torn down from a static destructor finds it.
+            [[nodiscard]] static HookStatsRegistry &instance()
+            {
+                static HookStatsRegistry *const s_instance = new HookStatsRegistry();
+                return *s_instance;
+            }
+
+            /**
+             * @brief Hands out a zeroed record for a new hook, reusing a released one when there is one.
+             * @throws std::bad_alloc when a new record or the name copy cannot be allocated.
+             */
+            [[nodiscard]] HookCallStats *acquire(std::string_view name, std::uint64_t ledger_id,
+                                                 diagnostics::HookKind kind)
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                Record *record = nullptr;
+                for (const std::unique_ptr<Record> &candidate : m_records)
+                {
+                    if (!candidate->live)
+                    {
+                        record = candidate.get();
+                        break;
+                    }
+                }
+                if (record == nullptr)
+                {
+                    m_records.push_back(std::make_unique<Record>());
+                    record = m_records.back().get();
+                }
+                record->name.assign(name);
+                record->stats.reset();
+                record->ledger_id = ledger_id;
+                record->kind = kind;
+                record->live = true;
+                return &record->stats;
+            }
+
+            /// Returns @p stats to the registry; collect stops reporting it. Null is a no-op.
+            void release(HookCallStats *stats) noexcept
+            {
+                if (stats == nullptr)
+                {
+                    return;
+                }
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                for (const std::unique_ptr<Record> &record : m_records)
+                {
+                    if (&record->stats == stats)
+                    {
+                        record->live = false;
+                        return;
+                    }
+                }
+            }
+
+            /// Appends one entry per live record to @p out, in acquisition-slot order.
+            void collect(std::vector<diagnostics::HookStats> &out) const
+            {
+                const std::lock_guard<std::mutex> lock(m_mutex);
+                for (const std::unique_ptr<Record> &record : m_records)
+                {
+                    if (!record->live)
+                    {
+                        continue;
+                    }
+                    diagnostics::HookStats &entry = out.emplace_back();
+                    entry.name = record->name;
+                    entry.ledger_id = record->ledger_id;
+                    entry.kind = record->kind;
+                    record->stats.accumulate(entry);
+                }
+            }
+
+        private:
+            struct Record
+            {
+                HookCallStats stats;
+                std::string name;
+                std::uint64_t ledger_id{0};
+                diagnostics::HookKind kind{diagnostics::HookKind::Inline};
+                bool live{false};
+            };
+
+            HookStatsRegistry() = default;
+
+            mutable std::mutex m_mutex;
+            std::vector<std::unique_ptr<Record>> m_records;
+        };
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_HOOK_STATS_HPP
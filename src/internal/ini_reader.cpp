@@ -0,0 +1,458 @@
+#include "internal/ini_reader.hpp"
+
+#include "internal/fnv1a.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+namespace DetourModKit::detail
+{
+    namespace
+    {
+        constexpr std::size_t MIN_SLOTS = 16;
+        constexpr std::string_view UTF8_BOM = "\xEF\xBB\xBF";
+        constexpr std::string_view HEREDOC_OPEN = "<<<";
+
+        // SimpleIni's IsSpace and IsNewLineChar: a lone '\r' ends a line as well as "\n" and "\r\n".
+        [[nodiscard]] constexpr bool is_space(char c) noexcept
+        {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+        }
+
+        [[nodiscard]] constexpr bool is_newline(char c) noexcept
+        {
+            return c == '\r' || c == '\n';
+        }
+
+        [[nodiscard]] constexpr char fold(char c) noexcept
+        {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        [[nodiscard]] bool equal_folded(std::string_view a, std::string_view b) noexcept
+        {
+            return std::ranges::equal(a, b, [](char x, char y) { return fold(x) == fold(y); });
+        }
+
+        [[nodiscard]] std::uint64_t hash_folded(std::uint64_t hash, std::string_view name) noexcept
+        {
+            for (const char c : name)
+            {
+                hash = fnv1a_byte(hash, static_cast<std::uint8_t>(fold(c)));
+            }
+            return hash;
+        }
+
+        [[nodiscard]] std::uint64_t section_hash(std::string_view name) noexcept
+        {
+            return hash_folded(FNV1A64_OFFSET, name);
+        }
+
+        [[nodiscard]] std::uint64_t entry_hash(std::uint32_t section, std::string_view key) noexcept
+        {
+            return hash_folded(fnv1a_int(FNV1A64_OFFSET, section), key);
+        }
+
+        [[nodiscard]] std::string_view trim_trailing(std::string_view text) noexcept
+        {
+            while (!text.empty() && is_space(text.back()))
+            {
+                text.remove_suffix(1);
+            }
+            return text;
+        }
+
+        /// Index of the line break (or end of text) at or after @p pos.
+        [[nodiscard]] std::size_t line_end(std::string_view text, std::size_t pos) noexcept
+        {
+            while (pos < text.size() && !is_newline(text[pos]))
+            {
+                ++pos;
+            }
+            return pos;
+        }
+
+        /// Steps over the line break at @p pos, taking "\r\n" as one.
+        [[nodiscard]] std::size_t skip_newline(std::string_view text, std::size_t pos) noexcept
+        {
+            if (pos >= text.size())
+            {
+                return pos;
+            }
+            const bool crlf = text[pos] == '\r' && pos + 1 < text.size() && text[pos + 1] == '\n';
+            return pos + (crlf ? 2 : 1);
+        }
+
+        /// Puts @p id in the first free slot of @p hash's linear probe sequence.
+        void place(std::vector<std::uint32_t> &slots, std::uint64_t hash, std::uint32_t id) noexcept
+        {
+            const std::size_t mask = slots.size() - 1;
+            for (auto i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask)
+            {
+                if (slots[i] == 0)
+                {
+                    slots[i] = id;
+                    return;
+                }
+            }
+        }
+
+        /**
+         * @brief Reads the heredoc body starting at @p pos up to the line equal to @p tag, and moves @p pos past it.
+         * @details SimpleIni's LoadMultiLineText: a line matches when, with its trailing whitespace dropped (never its
+         *          first character), it equals the tag case-insensitively. The body lines are joined with '\n' and the
+         *          break before the tag is dropped; at the end of the text everything read so far is the value. When
+         *          the body's own breaks are all '\n' that join is the text itself, so only a '\r' costs a copy.
+         */
+        [[nodiscard]] std::string_view read_heredoc(std::string_view text, std::size_t &pos, std::string_view tag,
+                                                    std::deque<std::string> &owned)
+        {
+            const std::size_t body_begin = pos;
+            std::size_t body_end = pos;
+            for (;;)
+            {
+                const std::size_t stop = line_end(text, pos);
+                std::string_view line = text.substr(pos, stop - pos);
+                while (line.size() > 1 && is_space(line.back()))
+                {
+                    line.remove_suffix(1);
+                }
+                if (equal_folded(line, tag))
+                {
+                    pos = skip_newline(text, stop);
+                    break;
+                }
+                body_end = stop;
+                pos = skip_newline(text, stop);
+                if (stop == text.size())
+                {
+                    break;
+                }
+            }
+
+            const std::string_view body = text.substr(body_begin, body_end - body_begin);
+            if (body.find('\r') == std::string_view::npos)
+            {
+                return body;
+            }
+            std::string &normalized = owned.emplace_back();
+            normalized.reserve(body.size());
+            for (std::size_t i = 0; i < body.size(); ++i)
+            {
+                if (body[i] != '\r')
+                {
+                    normalized += body[i];
+                    continue;
+                }
+                normalized += '\n';
+                if (i + 1 < body.size() && body[i + 1] == '\n')
+                {
+                    ++i;
+                }
+            }
+            return normalized;
+        }
+    } // namespace
+
+    std::optional<bool> ini_bool(std::string_view value) noexcept
+    {
+        if (value.empty())
+        {
+            return std::nullopt;
+        }
+        switch (value[0])
+        {
+        case 't':
+        case 'T':
+        case 'y':
+        case 'Y':
+        case '1':
+            return true;
+        case 'f':
+        case 'F':
+        case 'n':
+        case 'N':
+        case '0':
+            return false;
+        case 'o':
+        case 'O':
+            if (value.size() > 1 && fold(value[1]) == 'n')
+            {
+                return true;
+            }
+            if (value.size() > 1 && fold(value[1]) == 'f')
+            {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+        return std::nullopt;
+    }
+
+    IniDocument IniDocument::parse(std::string_view text, bool multi_line)
+    {
+        // SimpleIni reads a NUL-terminated copy, so a NUL ends the text for it too.
+        text = text.substr(0, text.find('\0'));
+        if (text.starts_with(UTF8_BOM))
+        {
+            text.remove_prefix(UTF8_BOM.size());
+        }
+
+        IniDocument doc;
+        std::optional<std::uint32_t> section;
+        std::size_t pos = 0;
+        for (;;)
+        {
+            while (pos < text.size() && is_space(text[pos]))
+            {
+                ++pos;
+            }
+            if (pos == text.size())
+            {
+                break;
+            }
+
+            const char lead = text[pos];
+            if (lead == ';' || lead == '#')
+            {
+                pos = line_end(text, pos);
+                continue;
+            }
+
+            if (lead == '[')
+            {
+                ++pos;
+                while (pos < text.size() && is_space(text[pos]))
+                {
+                    ++pos;
+                }
+                const std::size_t name_begin = pos;
+                pos = std::min(line_end(text, pos), text.find(']', pos));
+                if (pos == text.size() || text[pos] != ']')
+                {
+                    // An unterminated header is ignored and its line skipped; the keys after it stay in the prior
+                    // section.
+                    continue;
+                }
+                section = doc.add_section(trim_trailing(text.substr(name_begin, pos - name_begin)));
+                pos = line_end(text, pos);
+                continue;
+            }
+
+            const std::size_t key_begin = pos;
+            while (pos < text.size() && text[pos] != '=' && !is_newline(text[pos]))
+            {
+                ++pos;
+            }
+            if (pos == text.size() || text[pos] != '=')
+            {
+                continue;
+            }
+            if (pos == key_begin)
+            {
+                pos = line_end(text, pos);
+                continue;
+            }
+            const std::string_view key = trim_trailing(text.substr(key_begin, pos - key_begin));
+
+            ++pos;
+            while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t'))
+            {
+                ++pos;
+            }
+            const std::size_t value_begin = pos;
+            pos = line_end(text, pos);
+            std::string_view value = trim_trailing(text.substr(value_begin, pos - value_begin));
+            pos = skip_newline(text, pos);
+            if (multi_line && value.starts_with(HEREDOC_OPEN))
+            {
+                value = read_heredoc(text, pos, value.substr(HEREDOC_OPEN.size()), doc.m_owned);
+            }
+
+            if (!section)
+            {
+                section = doc.add_section({});
+            }
+            doc.set_entry(*section, key, value);
+        }
+        return doc;
+    }
+
+    std::optional<std::string_view> IniDocument::value(std::string_view section, std::string_view key) const noexcept
+    {
+        const std::optional<std::uint32_t> section_index = find_section(section);
+        if (!section_index)
+        {
+            return std::nullopt;
+        }
+        const std::optional<std::uint32_t> entry_index = find_entry(*section_index, key);
+        if (!entry_index)
+        {
+            return std::nullopt;
+        }
+        return m_entries[*entry_index].value;
+    }
+
+    bool IniDocument::has_section(std::string_view section) const noexcept
+    {
+        return find_section(section).has_value();
+    }
+
+    std::optional<std::uint32_t> IniDocument::find_section(std::string_view name) const noexcept
+    {
+        if (m_section_slots.empty())
+        {
+            return std::nullopt;
+        }
+        const std::size_t mask = m_section_slots.size() - 1;
+        for (auto i = static_cast<std::size_t>(section_hash(name)) & mask; m_section_slots[i] != 0; i = (i + 1) & mask)
+        {
+            const std::uint32_t index = m_section_slots[i] - 1;
+            if (equal_folded(m_sections[index], name))
+            {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::optional<std::uint32_t> IniDocument::find_entry(std::uint32_t section, std::string_view key) const noexcept
+    {
+        if (m_entry_slots.empty())
+        {
+            return std::nullopt;
+        }
+        const std::size_t mask = m_entry_slots.size() - 1;
+        for (auto i = static_cast<std::size_t>(entry_hash(section, key)) & mask; m_entry_slots[i] != 0;
+             i = (i + 1) & mask)
+        {
+            const std::uint32_t index = m_entry_slots[i] - 1;
+            if (m_entries[index].section == section && equal_folded(m_entries[index].key, key))
+            {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    std::uint32_t IniDocument::add_section(std::string_view name)
+    {
+        if (const std::optional<std::uint32_t> existing = find_section(name))
+        {
+            return *existing;
+        }
+        const auto index = static_cast<std::uint32_t>(m_sections.size());
+        m_sections.push_back(name);
+        if (m_sections.size() * 2 > m_section_slots.size())
+        {
+            m_section_slots.assign(std::max(MIN_SLOTS, std::bit_ceil(m_sections.size() * 2)), 0);
+            for (std::uint32_t i = 0; i < m_sections.size(); ++i)
+            {
+                place(m_section_slots, section_hash(m_sections[i]), i + 1);
+            }
+        }
+        else
+        {
+            place(m_section_slots, section_hash(name), index + 1);
+        }
+        return index;
+    }
+
+    void IniDocument::set_entry(std::uint32_t section, std::string_view key, std::string_view value)
+    {
+        // A repeated key replaces the earlier value in place, as SimpleIni does with multi-key off.
+        if (const std::optional<std::uint32_t> existing = find_entry(section, key))
+        {
+            m_entries[*existing].value = value;
+            return;
+        }
+        const auto index = static_cast<std::uint32_t>(m_entries.size());
+        m_entries.push_back(Entry{section, key, value});
+        if (m_entries.size() * 2 > m_entry_slots.size())
+        {
+            m_entry_slots.assign(std::max(MIN_SLOTS, std::bit_ceil(m_entries.size() * 2)), 0);
+            for (std::uint32_t i = 0; i < m_entries.size(); ++i)
+            {
+                place(m_entry_slots, entry_hash(m_entries[i].section, m_entries[i].key), i + 1);
+            }
+        }
+        else
+        {
+            place(m_entry_slots, entry_hash(section, key), index + 1);
+        }
+    }
+
+    MappedFile::~MappedFile() noexcept
+    {
+        close();
+    }
+
+    void MappedFile::close() noexcept
+    {
+        if (m_bytes != nullptr)
+        {
+            ::UnmapViewOfFile(m_bytes);
+        }
+        if (m_mapping != nullptr)
+        {
+            ::CloseHandle(m_mapping);
+        }
+        if (m_file != nullptr)
+        {
+            ::CloseHandle(m_file);
+        }
+        m_file = nullptr;
+        m_mapping = nullptr;
+        m_bytes = nullptr;
+        m_size = 0;
+    }
+
+    bool MappedFile::open(const std::filesystem::path &path) noexcept
+    {
+        close();
+        HANDLE file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        m_file = file;
+
+        LARGE_INTEGER size{};
+        if (!::GetFileSizeEx(file, &size) || size.QuadPart < 0 ||
+            static_cast<unsigned long long>(size.QuadPart) > std::numeric_limits<std::size_t>::max())
+        {
+            close();
+            return false;
+        }
+        if (size.QuadPart == 0)
+        {
+            // A zero-length file cannot be mapped; it is simply empty.
+            return true;
+        }
+
+        m_mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mapping == nullptr)
+        {
+            close();
+            return false;
+        }
+        m_bytes = static_cast<const char *>(::MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+        if (m_bytes == nullptr)
+        {
+            close();
+            return false;
+        }
+        m_size = static_cast<std::size_t>(size.QuadPart);
+        return true;
+    }
+} // namespace DetourModKit::detail
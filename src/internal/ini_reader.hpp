@@ -0,0 +1,123 @@
+#ifndef DETOURMODKIT_INTERNAL_INI_READER_HPP
+#define DETOURMODKIT_INTERNAL_INI_READER_HPP
+
+/**
+ * @file internal/ini_reader.hpp
+ * @brief Internal read-only INI reader shared by config and manifest: tokenizes in place over a mapped file.
+ * @details IniDocument::parse splits the text into sections, keys and values as std::string_view slices of the input,
+ *          indexed by flat open-addressing tables, so a lookup allocates nothing and a value costs no copy. The grammar
+ *          is the one SimpleIni reads for the way both callers configured it (CSimpleIniA: ASCII case-insensitive
+ *          names, last duplicate key wins, `;` / `#` comment lines, optional `<<<TAG` heredoc values), so files the
+ *          library wrote or accepted before read back unchanged. Writing stays with SimpleIni (manifest::serialize).
+ *          Not installed.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @brief Reads @p value as a boolean the way SimpleIni's GetBoolValue does.
+     * @return true for a value starting with t / y / 1 or reading "on", false for f / n / 0 or "off" (any case), and
+     *         nullopt for anything else -- including an empty value -- so the caller keeps its default.
+     */
+    [[nodiscard]] std::optional<bool> ini_bool(std::string_view value) noexcept;
+
+    /**
+     * @class IniDocument
+     * @brief The parsed sections and key/value entries of one INI text.
+     * @details Every view points into the text passed to parse(), which must outlive the document. The one exception
+     *          is a heredoc value whose lines end in "\r\n": its line breaks are normalized to '\n', so it is copied
+     *          into storage the document owns.
+     */
+    class IniDocument
+    {
+    public:
+        /**
+         * @brief Tokenizes @p text.
+         * @param multi_line Whether a value starting with `<<<` opens a heredoc (SimpleIni's SetMultiLine).
+         * @details Never fails on content: a line that is neither a section, a comment nor a `key = value` line is
+         *          skipped, a leading UTF-8 BOM is skipped, and the text ends at its first NUL.
+         * @throws std::bad_alloc when the index cannot be allocated.
+         */
+        [[nodiscard]] static IniDocument parse(std::string_view text, bool multi_line);
+
+        /// The value of @p key in @p section, or nullopt when either is absent. Names compare ASCII case-insensitively.
+        [[nodiscard]] std::optional<std::string_view> value(std::string_view section,
+                                                            std::string_view key) const noexcept;
+
+        /// Whether @p section appeared, even with no keys.
+        [[nodiscard]] bool has_section(std::string_view section) const noexcept;
+
+        /// Section names in order of first appearance; keys before any header belong to section "".
+        [[nodiscard]] std::span<const std::string_view> sections() const noexcept { return m_sections; }
+
+        /// Distinct (section, key) entries.
+        [[nodiscard]] std::size_t size() const noexcept { return m_entries.size(); }
+
+    private:
+        struct Entry
+        {
+            std::uint32_t section;
+            std::string_view key;
+            std::string_view value;
+        };
+
+        [[nodiscard]] std::optional<std::uint32_t> find_section(std::string_view name) const noexcept;
+        [[nodiscard]] std::optional<std::uint32_t> find_entry(std::uint32_t section,
+                                                               std::string_view key) const noexcept;
+        std::uint32_t add_section(std::string_view name);
+        void set_entry(std::uint32_t section, std::string_view key, std::string_view value);
+
+        std::vector<std::string_view> m_sections;
+        std::vector<Entry> m_entries;
+        // Open-addressing tables over m_sections / m_entries: each slot holds index + 1, 0 marks an empty slot. The
+        // slot count is a power of two kept at least twice the element count.
+        std::vector<std::uint32_t> m_section_slots;
+        std::vector<std::uint32_t> m_entry_slots;
+        // Normalized heredoc values. A deque never relocates its elements, so views into them stay valid as it grows
+        // and across a move of the document.
+        std::deque<std::string> m_owned;
+    };
+
+    /**
+     * @class MappedFile
+     * @brief A whole file mapped read-only for the duration of one parse.
+     * @details Opened without write sharing, so the bytes cannot change while they are hashed and parsed, and a file an
+     *          editor holds open for writing mid-save fails to open rather than being read half-written. The handles
+     *          are released on destruction; keep the mapping only as long as a view from text() is in use.
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() noexcept = default;
+        ~MappedFile() noexcept;
+        MappedFile(const MappedFile &) = delete;
+        MappedFile &operator=(const MappedFile &) = delete;
+
+        /// Maps @p path. Returns false when it cannot be opened or mapped; an empty file maps to empty text.
+        [[nodiscard]] bool open(const std::filesystem::path &path) noexcept;
+
+        /// The mapped bytes; empty before a successful open().
+        [[nodiscard]] std::string_view text() const noexcept { return {m_bytes, m_size}; }
+
+    private:
+        void close() noexcept;
+
+        // HANDLE values, kept as void * so this header does not pull in <windows.h>.
+        void *m_file{nullptr};
+        void *m_mapping{nullptr};
+        const char *m_bytes{nullptr};
+        std::size_t m_size{0};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INI_READER_HPP
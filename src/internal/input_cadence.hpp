@@ -0,0 +1,72 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_CADENCE_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_CADENCE_HPP
+
+/**
+ * @file input_cadence.hpp
+ * @brief Internal adaptive poll cadence: a slow idle interval that switches to the fast one on binding activity.
+ * @details Poll-thread-private helper used by InputPoller when input::Input::Settings::adaptive_polling is set. The
+ *          poll loop reports once per cycle whether any key or button a binding reads is down (or a binding is
+ *          active) and waits the interval this returns. Windows-agnostic so it is unit-testable on synthetic time.
+ *          Not installed.
+ */
+
+#include <chrono>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class AdaptiveCadence
+     * @brief Picks the wait after each poll cycle.
+     * @details Starts idle. Any activity switches to the fast interval at once; the fast interval is kept until
+     *          @p quiet_timeout has passed with no activity, so a player resting between presses of a chord does not
+     *          pay the idle latency on every one.
+     */
+    class AdaptiveCadence
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        AdaptiveCadence(std::chrono::milliseconds fast_interval, std::chrono::milliseconds idle_interval,
+                        std::chrono::milliseconds quiet_timeout) noexcept
+            : m_fast_interval(fast_interval), m_idle_interval(idle_interval), m_quiet_timeout(quiet_timeout)
+        {
+        }
+
+        /**
+         * @brief Records one cycle and returns the wait before the next.
+         * @param active Whether a binding-relevant input was down, or a binding active, this cycle.
+         * @param now The cycle's time.
+         */
+        [[nodiscard]] std::chrono::milliseconds step(bool active, Clock::time_point now) noexcept
+        {
+            m_switched_to_fast = false;
+            if (active)
+            {
+                m_switched_to_fast = !m_fast;
+                m_fast = true;
+                m_last_activity = now;
+            }
+            else if (m_fast && now - m_last_activity >= m_quiet_timeout)
+            {
+                m_fast = false;
+            }
+            return m_fast ? m_fast_interval : m_idle_interval;
+        }
+
+        /// Whether the last step() chose the fast interval.
+        [[nodiscard]] bool fast() const noexcept { return m_fast; }
+
+        /// Whether the last step() was the idle-to-fast switch.
+        [[nodiscard]] bool switched_to_fast() const noexcept { return m_switched_to_fast; }
+
+    private:
+        std::chrono::milliseconds m_fast_interval;
+        std::chrono::milliseconds m_idle_interval;
+        std::chrono::milliseconds m_quiet_timeout;
+        Clock::time_point m_last_activity{};
+        bool m_fast{false};
+        bool m_switched_to_fast{false};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_CADENCE_HPP
@@ -0,0 +1,119 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_EVENT_RING_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_EVENT_RING_HPP
+
+/**
+ * @file input_event_ring.hpp
+ * @brief Internal bounded single-producer ring of input::InputEvent records.
+ * @details Backs input::Input::drain_events. The poll thread is the only producer and pushes each binding edge as it
+ *          detects it; consumers drain on their own thread. The producer never blocks or allocates: a full ring drops
+ *          the new event and counts it. Concurrent consumers are serialized by the caller (InputPoller holds a drain
+ *          mutex), so the ring itself is single-producer / single-consumer. Windows-agnostic so it is unit-testable.
+ *          Not installed.
+ */
+
+#include "DetourModKit/input.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+
+namespace DetourModKit::detail
+{
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: the cursors are intentionally padded to a full cache line by alignas(64) so producer and consumer never
+// false-share.
+#pragma warning(disable : 4324)
+#endif
+    /**
+     * @class InputEventRing
+     * @brief Fixed-capacity SPSC queue; the capacity is rounded up to a power of 2.
+     */
+    class InputEventRing
+    {
+    public:
+        /// Largest accepted capacity; larger requests are clamped.
+        static constexpr std::size_t MAX_CAPACITY = std::size_t{1} << 16;
+
+        /**
+         * @brief Allocates a ring of at least @p capacity slots (clamped to [2, MAX_CAPACITY]).
+         * @return The ring, or null on allocation failure.
+         */
+        [[nodiscard]] static std::unique_ptr<InputEventRing> create(std::size_t capacity) noexcept
+        {
+            const std::size_t rounded = std::bit_ceil(std::clamp<std::size_t>(capacity, 2, MAX_CAPACITY));
+            std::unique_ptr<InputEventRing> ring(new (std::nothrow) InputEventRing());
+            if (!ring)
+            {
+                return nullptr;
+            }
+            ring->m_slots.reset(new (std::nothrow) input::InputEvent[rounded]);
+            if (!ring->m_slots)
+            {
+                return nullptr;
+            }
+            ring->m_mask = rounded - 1;
+            return ring;
+        }
+
+        /// Slot count.
+        [[nodiscard]] std::size_t capacity() const noexcept { return m_mask + 1; }
+
+        /// Producer side: appends @p event, or counts a drop and returns false when the ring is full.
+        bool push(const input::InputEvent &event) noexcept
+        {
+            const std::uint64_t head = m_head.load(std::memory_order_relaxed);
+            if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+            {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            m_slots[static_cast<std::size_t>(head) & m_mask] = event;
+            m_head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /// Consumer side: moves up to out.size() of the oldest events into @p out and returns how many.
+        std::size_t pop(std::span<input::InputEvent> out) noexcept
+        {
+            const std::uint64_t tail = m_tail.load(std::memory_order_relaxed);
+            const std::uint64_t available = m_head.load(std::memory_order_acquire) - tail;
+            const auto count = static_cast<std::size_t>(std::min<std::uint64_t>(available, out.size()));
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                out[i] = m_slots[static_cast<std::size_t>(tail + i) & m_mask];
+            }
+            m_tail.store(tail + count, std::memory_order_release);
+            return count;
+        }
+
+        /// Events queued and not yet popped; approximate while either side runs.
+        [[nodiscard]] std::size_t size() const noexcept
+        {
+            return static_cast<std::size_t>(m_head.load(std::memory_order_acquire) -
+                                            m_tail.load(std::memory_order_acquire));
+        }
+
+        /// Events push() dropped because the ring was full.
+        [[nodiscard]] std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+    private:
+        InputEventRing() = default;
+
+        alignas(64) std::atomic<std::uint64_t> m_head{0};
+        alignas(64) std::atomic<std::uint64_t> m_tail{0};
+        std::atomic<std::uint64_t> m_dropped{0};
+        std::unique_ptr<input::InputEvent[]> m_slots;
+        std::size_t m_mask{0};
+    };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_EVENT_RING_HPP
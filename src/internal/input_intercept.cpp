@@ -59,10 +59,33 @@ namespace DetourModKit::detail
         // again.
         std::atomic<bool> s_xinput_enable_warned{false};
         std::atomic<bool> s_xinput_ex_enable_warned{false};
-        std::atomic<int> s_bound_user_index{0};
-        std::atomic<uint16_t> s_suppress_mask{0};
         std::atomic<uint64_t> s_suppress_deadline_ms{0};
 
+        // Detour gate: everything the XInput detour needs to decide whether to touch a call, packed into one word so
+        // the common case -- no consume binding armed on this slot -- costs the game a single load. Bits 0-15 are the
+        // reactive suppression mask, 16-17 the bound controller slot, and the two flags below gate the consume rules.
+        // Several threads write disjoint fields (the poll thread the mask, slot, and focus gate; the binding-mutation
+        // thread the rules-present flag), so every write is a read-modify-write through update_detour_gate.
+        constexpr uint64_t GATE_MASK_BITS = 0xFFFFull;
+        constexpr unsigned GATE_SLOT_SHIFT = 16;
+        constexpr uint64_t GATE_SLOT_BITS = 0x3ull << GATE_SLOT_SHIFT;
+        // The poll loop's focus-and-connected gate for rule masking (set_gamepad_rule_suppress_enabled).
+        constexpr uint64_t GATE_RULES_ENABLED = 1ull << 20;
+        // A non-empty consume rule list is published.
+        constexpr uint64_t GATE_RULES_PRESENT = 1ull << 21;
+        constexpr uint64_t GATE_RULES_ARMED = GATE_RULES_ENABLED | GATE_RULES_PRESENT;
+        std::atomic<uint64_t> s_detour_gate{0};
+
+        /// Replaces the @p clear bits of the detour gate with @p set. The release orders earlier writes before it.
+        void update_detour_gate(uint64_t clear, uint64_t set) noexcept
+        {
+            uint64_t gate = s_detour_gate.load(std::memory_order_relaxed);
+            while (!s_detour_gate.compare_exchange_weak(gate, (gate & ~clear) | set, std::memory_order_release,
+                                                        std::memory_order_relaxed))
+            {
+            }
+        }
+
         // Count of game threads currently executing inside an XInput detour body. uninstall() first retires the
         // published trampoline pointers, then drains this to zero before destroying the hook objects, so no thread that
         // already copied a trampoline keeps running through memory the hook owns. SafetyHook still relocates a thread
@@ -112,11 +135,10 @@ namespace DetourModKit::detail
         std::atomic<uint32_t> s_consume_rule_count{0};
         std::atomic<uint32_t> s_consume_rules_seq{0};
 
-        // Gate for detour-side rule masking, driven every poll cycle. The published rule list and its time-to-live
-        // survive focus changes, so without this gate apply_suppress would keep masking the foreground game's input
-        // while the mod is unfocused. The poll loop sets it true only while focused and connected, mirroring how the
-        // reactive mask is cleared and how the per-direction wheel-consume mask is gated.
-        std::atomic<bool> s_rule_suppress_enabled{false};
+        // Detour-side rule masking is gated by GATE_RULES_ENABLED, driven every poll cycle. The published rule list
+        // and its time-to-live survive focus changes, so without that gate apply_suppress would keep masking the
+        // foreground game's input while the mod is unfocused. The poll loop sets it only while focused and connected,
+        // mirroring how the reactive mask is cleared and how the per-direction wheel-consume mask is gated.
 
         /**
          * @brief Packs a rule into one word: modifier (bits 0-15), forbidden (16-31), trigger (32-47).
@@ -222,38 +244,11 @@ namespace DetourModKit::detail
             {
                 return;
             }
-            if (static_cast<int>(user_index) != s_bound_user_index.load(std::memory_order_relaxed))
-            {
-                return;
-            }
-            // Acquire the reactive mask first. This load also orders the relaxed deadline read below:
-            // publish_gamepad_suppress writes the deadline before the release store on s_suppress_mask, so the acquire
-            // here establishes the happens-before even when the mask reads as 0.
-            const uint16_t reactive = s_suppress_mask.load(std::memory_order_acquire);
-
-            // raw is the true, unmasked state: this detour runs after the trampoline call. Evaluating the published
-            // chord rules against it masks a chord whose modifier and trigger were pressed inside one poll interval on
-            // the very frame the game reads it, rather than a cycle later. The focus gate suppresses this evaluation
-            // when the host window is unfocused or the controller is gone: the rule list and its deadline both survive
-            // those transitions, so the detour must not keep masking the foreground game's input (the reactive mask is
-            // already cleared by the poll loop on focus loss).
-            const uint16_t raw = state->Gamepad.wButtons;
-            const uint16_t rule_mask =
-                s_rule_suppress_enabled.load(std::memory_order_relaxed) ? evaluate_published_consume_rules(raw) : 0;
-            const uint16_t mask = static_cast<uint16_t>(reactive | rule_mask);
-            if (mask == 0)
+            const uint16_t mask = gamepad_detour_mask(state->Gamepad.wButtons, user_index);
+            if (mask != 0)
             {
-                return;
-            }
-            // The reactive mask and the rule list are both refreshed only while the poll thread is alive: rules exist
-            // only when consume gamepad bindings do, and that is exactly when publish_gamepad_suppress refreshes this
-            // deadline every cycle. A stalled poll thread therefore lets the deadline lapse and all masking stops, so
-            // the game regains its input rather than latching off.
-            if (GetTickCount64() >= s_suppress_deadline_ms.load(std::memory_order_relaxed))
-            {
-                return;
+                state->Gamepad.wButtons = static_cast<WORD>(state->Gamepad.wButtons & static_cast<WORD>(~mask));
             }
-            state->Gamepad.wButtons = static_cast<WORD>(raw & static_cast<WORD>(~mask));
         }
 
         DWORD WINAPI xinput_get_state_detour(DWORD user_index, XINPUT_STATE *state) noexcept
@@ -564,6 +559,8 @@ namespace DetourModKit::detail
         }
         s_consume_rule_count.store(static_cast<uint32_t>(count), std::memory_order_relaxed);
         s_consume_rules_seq.store(seq + 2, std::memory_order_release);
+        // Let the detour skip the list entirely while it is empty.
+        update_detour_gate(GATE_RULES_PRESENT, count > 0 ? GATE_RULES_PRESENT : 0);
     }
 
     uint16_t evaluate_published_consume_rules(uint16_t true_buttons) noexcept
@@ -582,10 +579,13 @@ namespace DetourModKit::detail
         {
             count = MAX_GAMEPAD_CONSUME_RULES;
         }
-        std::array<GamepadConsumeRule, MAX_GAMEPAD_CONSUME_RULES> snapshot{};
+        // Evaluate each rule as it is loaded rather than copying the list out first; the result is discarded below
+        // if the list changed underneath.
+        uint16_t mask = 0;
         for (uint32_t i = 0; i < count; ++i)
         {
-            snapshot[i] = unpack_consume_rule(s_consume_rules[i].load(std::memory_order_relaxed));
+            const GamepadConsumeRule rule = unpack_consume_rule(s_consume_rules[i].load(std::memory_order_relaxed));
+            mask = static_cast<uint16_t>(mask | evaluate_consume_rules(true_buttons, &rule, 1));
         }
         // Order the rule loads above before the sequence re-read below, so a writer that updated mid-copy is always
         // detected.
@@ -594,17 +594,57 @@ namespace DetourModKit::detail
         {
             return 0;
         }
-        return evaluate_consume_rules(true_buttons, snapshot.data(), count);
+        return mask;
+    }
+
+    uint16_t gamepad_detour_mask(uint16_t true_buttons, DWORD user_index) noexcept
+    {
+        // One acquire load answers whether this call is masked at all. It also orders the relaxed deadline read
+        // below: publish_gamepad_suppress writes the deadline before its release update of the gate, so the
+        // acquire here establishes the happens-before even when the mask reads as 0.
+        const uint64_t gate = s_detour_gate.load(std::memory_order_acquire);
+        if (user_index != static_cast<DWORD>((gate & GATE_SLOT_BITS) >> GATE_SLOT_SHIFT))
+        {
+            return 0;
+        }
+        const auto reactive = static_cast<uint16_t>(gate & GATE_MASK_BITS);
+        const bool rules_armed = (gate & GATE_RULES_ARMED) == GATE_RULES_ARMED;
+        if (reactive == 0 && !rules_armed)
+        {
+            return 0;
+        }
+
+        // true_buttons is the true, unmasked state: the detour calls this after the trampoline. Evaluating the
+        // published chord rules against it masks a chord whose modifier and trigger were pressed inside one poll
+        // interval on the very frame the game reads it, rather than a cycle later. The focus gate suppresses this
+        // evaluation when the host window is unfocused or the controller is gone: the rule list and its deadline
+        // both survive those transitions, so the detour must not keep masking the foreground game's input (the
+        // reactive mask is already cleared by the poll loop on focus loss).
+        const uint16_t rule_mask = rules_armed ? evaluate_published_consume_rules(true_buttons) : 0;
+        const uint16_t mask = static_cast<uint16_t>(reactive | rule_mask);
+        if (mask == 0)
+        {
+            return 0;
+        }
+        // The reactive mask and the rule list are both refreshed only while the poll thread is alive: rules exist
+        // only when consume gamepad bindings do, and that is exactly when publish_gamepad_suppress refreshes this
+        // deadline every cycle. A stalled poll thread therefore lets the deadline lapse and all masking stops, so
+        // the game regains its input rather than latching off.
+        if (GetTickCount64() >= s_suppress_deadline_ms.load(std::memory_order_relaxed))
+        {
+            return 0;
+        }
+        return mask;
     }
 
     void set_gamepad_rule_suppress_enabled(bool enabled) noexcept
     {
-        s_rule_suppress_enabled.store(enabled, std::memory_order_relaxed);
+        update_detour_gate(GATE_RULES_ENABLED, enabled ? GATE_RULES_ENABLED : 0);
     }
 
     bool install_xinput(int user_index) noexcept
     {
-        s_bound_user_index.store(user_index, std::memory_order_relaxed);
+        update_detour_gate(GATE_SLOT_BITS, (static_cast<uint64_t>(user_index) << GATE_SLOT_SHIFT) & GATE_SLOT_BITS);
         if (s_xinput_permanent_detour.load(std::memory_order_acquire))
         {
             const bool ready = s_xinput_original.load(std::memory_order_seq_cst) != nullptr;
@@ -715,11 +755,11 @@ namespace DetourModKit::detail
 
     void publish_gamepad_suppress(uint16_t suppress_bits) noexcept
     {
-        // Write the deadline before the mask (release on the mask). A detour that observes the new mask with acquire is
+        // Write the deadline before the mask (release on the gate). A detour that observes the new mask with acquire is
         // then guaranteed to also observe the refreshed deadline, so a fresh mask is never paired with a stale
         // (already-expired) deadline.
         s_suppress_deadline_ms.store(GetTickCount64() + SUPPRESS_TTL_MS, std::memory_order_relaxed);
-        s_suppress_mask.store(suppress_bits, std::memory_order_release);
+        update_detour_gate(GATE_MASK_BITS, suppress_bits);
     }
 
     bool install_wndproc() noexcept
@@ -861,16 +901,14 @@ namespace DetourModKit::detail
 
     void uninstall() noexcept
     {
-        // Stop masking before removing the hooks, with single-atomic stores only. Clearing the reactive mask stops
-        // reactive masking and clearing the rule gate stops rule masking. Do NOT seqlock-publish an empty rule list
-        // here:
-        // that is a multi-step write, and a concurrent binding mutation (set_consume
-        // / add_binding, serialized on InputPoller::m_bindings_rw_mutex) is a documented thread-safe call that could
-        // race a second writer and tear the list. The published list is left as is; it is inert once the hooks are gone
+        // Stop masking before removing the hooks, with single-atomic updates only. Clearing the gate's reactive mask
+        // stops reactive masking and clearing its rule gate stops rule masking. Do NOT seqlock-publish an empty rule
+        // list here: that is a multi-step write, and a concurrent binding mutation (set_consume / add_binding,
+        // serialized on InputPoller::m_bindings_rw_mutex) is a documented thread-safe call that could race a second
+        // writer and tear the list. The published list is left as is; it is inert once the hooks are gone
         // and the gate is false, the binding-clear path already empties it under the lock, and a later install
         // republishes before re-enabling the gate.
-        s_suppress_mask.store(0, std::memory_order_release);
-        s_rule_suppress_enabled.store(false, std::memory_order_relaxed);
+        update_detour_gate(GATE_MASK_BITS | GATE_RULES_ENABLED, 0);
         s_wheel_consume_mask.store(0, std::memory_order_release);
 
         uninstall_wndproc();
@@ -177,6 +177,18 @@ namespace DetourModKit::detail
      */
     [[nodiscard]] uint16_t evaluate_published_consume_rules(uint16_t true_buttons) noexcept;
 
+    /**
+     * @brief The button bits the XInput detour clears from one successful call on @p user_index.
+     * @details The detour's whole masking decision, exported for testing. Everything it needs to reject a call -- the
+     *          bound slot, the reactive mask, and whether consume rules are both published and enabled -- is packed
+     *          into one atomic word, so a call on an unbound slot, or with no consume binding armed, costs one load.
+     *          Only then are the rules evaluated and the time-to-live checked.
+     * @param true_buttons The unmasked XINPUT_GAMEPAD.wButtons the game will read.
+     * @param user_index The controller slot the game queried.
+     * @return Button bits to clear; 0 leaves the call untouched.
+     */
+    [[nodiscard]] uint16_t gamepad_detour_mask(uint16_t true_buttons, DWORD user_index) noexcept;
+
     /**
      * @brief Enables or disables detour-side consume-rule masking.
      * @details Gates whether the XInput detour evaluates the published rule list. The poll thread drives this every
@@ -0,0 +1,120 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_KEY_MASK_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_KEY_MASK_HPP
+
+/**
+ * @file input_key_mask.hpp
+ * @brief Internal 256-bit virtual-key masks and the compiled form of a keyboard/mouse binding.
+ * @details Poll-thread helper for InputPoller's binding pass. A binding whose triggers and modifiers are all
+ *          keyboard/mouse virtual keys is compiled, on every reshape, into three masks; the pass then builds one
+ *          KeyMask of the keys down this cycle and matches each compiled binding with a few word-wide AND/compare
+ *          operations instead of walking its codes and the known-modifier list. Windows-agnostic and allocation-free
+ *          so it is unit-testable. Not installed.
+ */
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @struct KeyMask
+     * @brief One bit per virtual key (0..255).
+     */
+    struct KeyMask
+    {
+        static constexpr std::size_t WORDS = 4;
+        std::array<std::uint64_t, WORDS> words{};
+
+        /// Sets @p vk's bit. Codes outside 0..255 are ignored.
+        constexpr void set(int vk) noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            if (index < WORDS * 64)
+            {
+                words[index / 64] |= std::uint64_t{1} << (index % 64);
+            }
+        }
+
+        /// Returns @p vk's bit. Codes outside 0..255 read as clear.
+        [[nodiscard]] constexpr bool test(int vk) const noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            return index < WORDS * 64 && (words[index / 64] & (std::uint64_t{1} << (index % 64))) != 0;
+        }
+
+        [[nodiscard]] constexpr bool empty() const noexcept
+        {
+            return (words[0] | words[1] | words[2] | words[3]) == 0;
+        }
+
+        /// True when every bit of @p required is set here.
+        [[nodiscard]] constexpr bool contains(const KeyMask &required) const noexcept
+        {
+            std::uint64_t missing = 0;
+            for (std::size_t i = 0; i < WORDS; ++i)
+            {
+                missing |= required.words[i] & ~words[i];
+            }
+            return missing == 0;
+        }
+
+        /// True when this mask and @p other share a bit.
+        [[nodiscard]] constexpr bool intersects(const KeyMask &other) const noexcept
+        {
+            std::uint64_t shared = 0;
+            for (std::size_t i = 0; i < WORDS; ++i)
+            {
+                shared |= words[i] & other.words[i];
+            }
+            return shared != 0;
+        }
+
+        constexpr KeyMask &operator|=(const KeyMask &other) noexcept
+        {
+            for (std::size_t i = 0; i < WORDS; ++i)
+            {
+                words[i] |= other.words[i];
+            }
+            return *this;
+        }
+
+        /// Invokes @p visit(vk) for each set bit, lowest first.
+        template <typename Visit> constexpr void for_each(Visit &&visit) const noexcept
+        {
+            for (std::size_t i = 0; i < WORDS; ++i)
+            {
+                for (std::uint64_t bits = words[i]; bits != 0; bits &= bits - 1)
+                {
+                    visit(static_cast<int>(i * 64 + static_cast<std::size_t>(std::countr_zero(bits))));
+                }
+            }
+        }
+    };
+
+    /**
+     * @struct CompiledCombo
+     * @brief A keyboard/mouse binding reduced to masks.
+     * @details The binding is down when every @ref required modifier is down, no @ref forbidden modifier is down (a
+     *          known modifier of another binding that none of this binding's modifiers satisfies, which is the strict
+     *          matching rule), and at least one @ref triggers key is down. A binding that cannot be expressed this way
+     *          (a gamepad or wheel code, an out-of-range code, or a gamepad modifier elsewhere in the set) has
+     *          @ref compiled false and keeps the per-code evaluation.
+     */
+    struct CompiledCombo
+    {
+        KeyMask required;
+        KeyMask forbidden;
+        KeyMask triggers;
+        bool compiled = false;
+
+        /// Whether the binding reads as pressed against @p down, the keys down this cycle.
+        [[nodiscard]] constexpr bool matches(const KeyMask &down) const noexcept
+        {
+            return down.contains(required) && !down.intersects(forbidden) && down.intersects(triggers);
+        }
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_KEY_MASK_HPP
@@ -0,0 +1,68 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_LATENCY_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_LATENCY_HPP
+
+/**
+ * @file input_latency.hpp
+ * @brief Internal log2 tick histogram behind input::Input::latency_stats.
+ * @details Written only by the poll thread, when input::Input::Settings::latency_stats is set, and read by any thread.
+ *          The buckets follow the hook-stats layout (internal/hook_stats.hpp): bucket 0 counts zero-tick samples and
+ *          bucket i counts samples of [2^(i-1), 2^i) ticks, the last one absorbing everything longer. A single writer
+ *          needs no read-modify-write, so each update is a relaxed load and store. Windows-agnostic so it is
+ *          unit-testable. Not installed.
+ */
+
+#include "DetourModKit/input.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class LatencyRecorder
+     * @brief One single-writer latency histogram in QPC ticks.
+     */
+    class LatencyRecorder
+    {
+    public:
+        /// Counts one sample of @p elapsed ticks; a negative value counts as zero. Poll thread only.
+        void record(std::int64_t elapsed) noexcept
+        {
+            const auto ticks = static_cast<std::uint64_t>(elapsed > 0 ? elapsed : 0);
+            const auto bucket = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(ticks)),
+                                                      input::INPUT_LATENCY_BUCKETS - 1);
+            bump(m_samples, 1);
+            bump(m_total_ticks, ticks);
+            bump(m_buckets[bucket], 1);
+        }
+
+        /// Copies the counters out. The fields are read one by one, so a copy racing a record can be off by one.
+        [[nodiscard]] input::LatencyHistogram read() const noexcept
+        {
+            input::LatencyHistogram out;
+            out.samples = m_samples.load(std::memory_order_relaxed);
+            out.total_ticks = m_total_ticks.load(std::memory_order_relaxed);
+            for (std::size_t i = 0; i < m_buckets.size(); ++i)
+            {
+                out.buckets[i] = m_buckets[i].load(std::memory_order_relaxed);
+            }
+            return out;
+        }
+
+    private:
+        static void bump(std::atomic<std::uint64_t> &counter, std::uint64_t by) noexcept
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+        }
+
+        std::atomic<std::uint64_t> m_samples{0};
+        std::atomic<std::uint64_t> m_total_ticks{0};
+        std::array<std::atomic<std::uint64_t>, input::INPUT_LATENCY_BUCKETS> m_buckets{};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_LATENCY_HPP
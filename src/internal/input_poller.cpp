@@ -7,9 +7,14 @@
  */
 
 #include "input_poller.hpp"
+#include "gamepad_probe.hpp"
+#include "input_cadence.hpp"
 #include "input_intercept.hpp"
 #include "input_key_cache.hpp"
+#include "input_key_mask.hpp"
+#include "input_raw_keys.hpp"
 #include "platform.hpp"
+#include "shared_services.hpp"
 
 #include "DetourModKit/diagnostics.hpp"
 #include "DetourModKit/logger.hpp"
@@ -23,10 +28,12 @@
 #include <cstdint>
 #include <exception>
 #include <new>
+#include <optional>
 #include <shared_mutex>
 #include <system_error>
 #include <type_traits>
 #include <unordered_set>
+#include <utility>
 
 namespace DetourModKit
 {
@@ -34,10 +41,89 @@ namespace DetourModKit
     {
         namespace
         {
+            /// The current QPC tick count.
+            [[nodiscard]] std::int64_t read_qpc() noexcept
+            {
+                LARGE_INTEGER ticks;
+                QueryPerformanceCounter(&ticks);
+                return ticks.QuadPart;
+            }
+
+            /// Copies an XINPUT_GAMEPAD into the public mirror.
+            [[nodiscard]] input::GamepadState to_gamepad_state(const XINPUT_GAMEPAD &pad) noexcept
+            {
+                return input::GamepadState{pad.wButtons, pad.bLeftTrigger, pad.bRightTrigger, pad.sThumbLX,
+                                           pad.sThumbLY, pad.sThumbRX,   pad.sThumbRY};
+            }
+
+            /// Packs buttons, triggers, and the left thumb of @p state into one word (see InputPoller::GamepadCell).
+            [[nodiscard]] std::uint64_t pack_buttons_left(const input::GamepadState &state) noexcept
+            {
+                return std::uint64_t{state.buttons} | (std::uint64_t{state.left_trigger} << 16) |
+                       (std::uint64_t{state.right_trigger} << 24) |
+                       (std::uint64_t{static_cast<std::uint16_t>(state.left_thumb_x)} << 32) |
+                       (std::uint64_t{static_cast<std::uint16_t>(state.left_thumb_y)} << 48);
+            }
+
+            [[nodiscard]] std::uint32_t pack_right_thumb(const input::GamepadState &state) noexcept
+            {
+                return std::uint32_t{static_cast<std::uint16_t>(state.right_thumb_x)} |
+                       (std::uint32_t{static_cast<std::uint16_t>(state.right_thumb_y)} << 16);
+            }
+
+            [[nodiscard]] input::GamepadState unpack_gamepad_state(std::uint64_t buttons_left,
+                                                                   std::uint32_t right_thumb) noexcept
+            {
+                input::GamepadState state;
+                state.buttons = static_cast<std::uint16_t>(buttons_left);
+                state.left_trigger = static_cast<std::uint8_t>(buttons_left >> 16);
+                state.right_trigger = static_cast<std::uint8_t>(buttons_left >> 24);
+                state.left_thumb_x = static_cast<std::int16_t>(static_cast<std::uint16_t>(buttons_left >> 32));
+                state.left_thumb_y = static_cast<std::int16_t>(static_cast<std::uint16_t>(buttons_left >> 48));
+                state.right_thumb_x = static_cast<std::int16_t>(static_cast<std::uint16_t>(right_thumb));
+                state.right_thumb_y = static_cast<std::int16_t>(static_cast<std::uint16_t>(right_thumb >> 16));
+                return state;
+            }
+
+            /**
+             * @struct KeySource
+             * @brief Where one cycle reads keyboard/mouse state: an injected probe, the shared key sweep for the keys
+             *        it covers, the raw input table, or else GetAsyncKeyState, in that order.
+             */
+            struct KeySource
+            {
+                const RawKeyState *raw_keys = nullptr;
+                InputPoller::KeyStateProbe probe = nullptr;
+                void *probe_context = nullptr;
+                /// Another instance's sweep this cycle read (see services.hpp), or both null.
+                const KeyMask *shared_down = nullptr;
+                const KeyMask *shared_covered = nullptr;
+
+                [[nodiscard]] bool pressed(int vk) const noexcept
+                {
+                    if (probe != nullptr)
+                    {
+                        return probe(probe_context, vk);
+                    }
+                    if (shared_covered != nullptr && shared_covered->test(vk))
+                    {
+                        return shared_down->test(vk);
+                    }
+                    return raw_keys != nullptr ? raw_keys->pressed(vk) : (GetAsyncKeyState(vk) & 0x8000) != 0;
+                }
+            };
+
+            /// Reads virtual key @p vk through the cycle cache from @p keys.
+            bool probe_vk(int vk, KeyStateCache &key_cache, const KeySource &keys) noexcept
+            {
+                return vk != 0 && key_cache.pressed(vk, [&keys](int key) noexcept { return keys.pressed(key); });
+            }
+
             /**
              * @brief Checks whether a single InputCode is currently pressed.
              * @param code The input code to check.
              * @param key_cache Per-cycle keyboard/mouse down-state memoization, probed at most once per distinct VK.
+             * @param keys The cycle's keyboard/mouse source (see KeySource).
              * @param gamepad_state Cached XInput state for the current poll cycle.
              * @param gamepad_connected Whether the gamepad is connected.
              * @param trigger_threshold Analog trigger deadzone threshold.
@@ -46,9 +132,9 @@ namespace DetourModKit
              *        WheelRight), latched once per cycle by the poll loop so repeated reads within a cycle stay consistent.
              * @return true if the input is currently pressed.
              */
-            bool is_code_pressed(const InputCode &code, KeyStateCache &key_cache, const XINPUT_STATE &gamepad_state,
-                                 bool gamepad_connected, int trigger_threshold, int stick_threshold,
-                                 uint8_t wheel_pulse) noexcept
+            bool is_code_pressed(const InputCode &code, KeyStateCache &key_cache, const KeySource &keys,
+                                 const XINPUT_STATE &gamepad_state, bool gamepad_connected, int trigger_threshold,
+                                 int stick_threshold, uint8_t wheel_pulse) noexcept
             {
                 switch (code.source)
                 {
@@ -57,9 +143,8 @@ namespace DetourModKit
                     // Route every keyboard/mouse read through the per-cycle cache so a VK referenced by many bindings
                     // (and by the strict known-modifier rescan) costs one GetAsyncKeyState call per cycle, not one per
                     // reference. The probe reads only the high (down) bit and gives the whole cycle one coherent
-                    // sample.
-                    return code.code != 0 && key_cache.pressed(code.code, [](int vk) noexcept
-                                                               { return (GetAsyncKeyState(vk) & 0x8000) != 0; });
+                    // sample. The raw input backend answers from its event-fed table instead.
+                    return probe_vk(code.code, key_cache, keys);
                 case InputSource::MouseWheel:
                 {
                     // The wheel has no held state; the poll loop latches each notch into wheel_pulse. WheelCode values
@@ -304,6 +389,73 @@ namespace DetourModKit
                 return rules;
             }
 
+            /// Whether the controller shows any press: a digital button, or a trigger or stick past its deadzone.
+            bool gamepad_in_use(const XINPUT_STATE &state, int trigger_threshold, int stick_threshold) noexcept
+            {
+                const XINPUT_GAMEPAD &pad = state.Gamepad;
+                const auto stick_moved = [stick_threshold](SHORT axis) noexcept
+                { return axis > stick_threshold || axis < -stick_threshold; };
+                return pad.wButtons != 0 || pad.bLeftTrigger > trigger_threshold ||
+                       pad.bRightTrigger > trigger_threshold || stick_moved(pad.sThumbLX) ||
+                       stick_moved(pad.sThumbLY) || stick_moved(pad.sThumbRX) || stick_moved(pad.sThumbRY);
+            }
+
+            /**
+             * @brief Compiles one binding into masks for the flat binding pass (see input_key_mask.hpp).
+             * @details Only a binding made of keyboard/mouse virtual keys compiles, and only when every known modifier
+             *          its strict match could be rejected by is a virtual key too; anything else returns a combo with
+             *          compiled false. A trigger with code 0 or out of range never reads as down, so it is dropped; a
+             *          modifier like that would block the binding forever, so it falls back instead.
+             */
+            CompiledCombo compile_binding(const InputBinding &binding,
+                                          const std::vector<InputCode> &known_modifiers) noexcept
+            {
+                const auto is_vk = [](const InputCode &code) noexcept
+                { return code.source == InputSource::Keyboard || code.source == InputSource::Mouse; };
+                const auto in_range = [](const InputCode &code) noexcept { return code.code > 0 && code.code < 256; };
+
+                CompiledCombo combo;
+                for (const auto &key : binding.keys)
+                {
+                    if (!is_vk(key))
+                    {
+                        return {};
+                    }
+                    if (in_range(key))
+                    {
+                        combo.triggers.set(key.code);
+                    }
+                }
+                for (const auto &mod : binding.modifiers)
+                {
+                    if (!is_vk(mod) || !in_range(mod))
+                    {
+                        return {};
+                    }
+                    combo.required.set(mod.code);
+                }
+                for (const auto &known : known_modifiers)
+                {
+                    const bool satisfied =
+                        std::any_of(binding.modifiers.begin(), binding.modifiers.end(),
+                                    [&known](const InputCode &mod) noexcept { return modifier_satisfies(mod, known); });
+                    if (satisfied)
+                    {
+                        continue;
+                    }
+                    if (!is_vk(known))
+                    {
+                        return {};
+                    }
+                    if (in_range(known))
+                    {
+                        combo.forbidden.set(known.code);
+                    }
+                }
+                combo.compiled = true;
+                return combo;
+            }
+
             // Release grace for gamepad consume-until-release. Long enough to absorb the
             // modifier-released-before-trigger window (the player relaxing the bumper a frame or two before the thumb
             // leaves the D-pad) without noticeably delaying a deliberate tap that follows.
@@ -320,6 +472,219 @@ namespace DetourModKit
             {
                 return s_next_binding_generation.fetch_add(1, std::memory_order_relaxed);
             }
+
+            // HID usages the raw input backend registers: generic desktop page, keyboard and mouse.
+            constexpr USHORT HID_USAGE_PAGE_GENERIC = 0x01;
+            constexpr USHORT HID_USAGE_GENERIC_MOUSE = 0x02;
+            constexpr USHORT HID_USAGE_GENERIC_KEYBOARD = 0x06;
+
+            // How often the raw input backend confirms it still owns its registration, and the longest it sleeps
+            // with nothing held. A game that registers raw input after the engine started silently redirects the
+            // events to its own window, so a stale table is at most this old before the poller falls back to polling.
+            constexpr auto RAW_INPUT_OWNERSHIP_CHECK = std::chrono::milliseconds{250};
+
+            /**
+             * @brief The raw input backend's message-only window and the key state its WM_INPUT events feed.
+             * @details Poll-thread-private: created, pumped, and destroyed on the poll thread, which owns the window's
+             *          message queue. Registers keyboard and mouse with RIDEV_INPUTSINK so events arrive whichever
+             *          window has focus; the poll loop applies the focus gate as it does for polling.
+             */
+            class RawInputSink
+            {
+            public:
+                RawInputSink() = default;
+                RawInputSink(const RawInputSink &) = delete;
+                RawInputSink &operator=(const RawInputSink &) = delete;
+                ~RawInputSink() noexcept { close(); }
+
+                /**
+                 * @brief Creates the window, takes the keyboard and mouse registrations, and seeds held keys.
+                 * @return false, with nothing left registered, when the process already has a raw keyboard or mouse
+                 *         registration (Windows keeps one target per usage, and replacing the game's would starve it)
+                 *         or a call fails.
+                 */
+                bool open() noexcept
+                {
+                    if (usage_registered_elsewhere())
+                    {
+                        return false;
+                    }
+                    m_window = CreateWindowExW(0, L"Message", L"DetourModKit raw input", 0, 0, 0, 0, 0, HWND_MESSAGE,
+                                               nullptr, nullptr, nullptr);
+                    if (m_window == nullptr)
+                    {
+                        return false;
+                    }
+                    const RAWINPUTDEVICE devices[] = {
+                        {HID_USAGE_PAGE_GENERIC, HID_USAGE_GENERIC_KEYBOARD, RIDEV_INPUTSINK, m_window},
+                        {HID_USAGE_PAGE_GENERIC, HID_USAGE_GENERIC_MOUSE, RIDEV_INPUTSINK, m_window},
+                    };
+                    if (!RegisterRawInputDevices(devices, static_cast<UINT>(std::size(devices)),
+                                                 sizeof(RAWINPUTDEVICE)))
+                    {
+                        DestroyWindow(m_window);
+                        m_window = nullptr;
+                        return false;
+                    }
+                    m_swapped = GetSystemMetrics(SM_SWAPBUTTON) != 0;
+
+                    // Keys already held when the window starts listening produce no event until released, so seed
+                    // them from the asynchronous state once. Registration came first, so a change from here on
+                    // arrives as an event.
+                    m_keys.clear();
+                    for (int vk = 1; vk < 255; ++vk)
+                    {
+                        m_keys.set(vk, (GetAsyncKeyState(vk) & 0x8000) != 0);
+                    }
+                    return true;
+                }
+
+                /// Drops the registrations this window still owns and destroys it. Idempotent.
+                void close() noexcept
+                {
+                    if (m_window == nullptr)
+                    {
+                        return;
+                    }
+                    if (owns_registration())
+                    {
+                        const RAWINPUTDEVICE devices[] = {
+                            {HID_USAGE_PAGE_GENERIC, HID_USAGE_GENERIC_KEYBOARD, RIDEV_REMOVE, nullptr},
+                            {HID_USAGE_PAGE_GENERIC, HID_USAGE_GENERIC_MOUSE, RIDEV_REMOVE, nullptr},
+                        };
+                        (void)RegisterRawInputDevices(devices, static_cast<UINT>(std::size(devices)),
+                                                      sizeof(RAWINPUTDEVICE));
+                    }
+                    DestroyWindow(m_window);
+                    m_window = nullptr;
+                }
+
+                [[nodiscard]] const RawKeyState &keys() const noexcept { return m_keys; }
+
+                /**
+                 * @brief Sleeps until raw input arrives, @p wake_event is signaled, or @p timeout elapses, then applies
+                 *        queued events up to and including the first one that changes a key.
+                 * @details Stopping at the first transition lets the caller evaluate bindings once per press or
+                 *          release, so a tap shorter than the poll interval still produces both edges; the rest of the
+                 *          queue is picked up by the next call, which returns at once (MWMO_INPUTAVAILABLE).
+                 * @return true when the wait timed out with nothing queued.
+                 */
+                bool wait(HANDLE wake_event, DWORD timeout_ms) noexcept
+                {
+                    const DWORD result =
+                        MsgWaitForMultipleObjectsEx(1, &wake_event, timeout_ms, QS_RAWINPUT, MWMO_INPUTAVAILABLE);
+                    MSG msg;
+                    while (PeekMessageW(&msg, nullptr, 0, 0, PM_REMOVE))
+                    {
+                        const bool changed = msg.message == WM_INPUT && apply(reinterpret_cast<HRAWINPUT>(msg.lParam));
+                        // DefWindowProc releases the WM_INPUT buffer.
+                        DispatchMessageW(&msg);
+                        if (changed)
+                        {
+                            if (m_time_transitions)
+                            {
+                                m_transition_ticks = read_qpc();
+                            }
+                            break;
+                        }
+                    }
+                    return result == WAIT_TIMEOUT;
+                }
+
+                /// Times each key transition wait() applies, for take_transition_ticks().
+                void time_transitions(bool enabled) noexcept { m_time_transitions = enabled; }
+
+                /// The QPC time wait() applied its last transition, then 0 until the next one; 0 when untimed.
+                [[nodiscard]] std::int64_t take_transition_ticks() noexcept
+                {
+                    return std::exchange(m_transition_ticks, std::int64_t{0});
+                }
+
+                /// True while both registrations still target this window; false once another window took one over.
+                [[nodiscard]] bool owns_registration() const noexcept
+                {
+                    bool keyboard = false;
+                    bool mouse = false;
+                    (void)for_each_registration(
+                        [&](const RAWINPUTDEVICE &device)
+                        {
+                            if (device.hwndTarget == m_window && device.usUsagePage == HID_USAGE_PAGE_GENERIC)
+                            {
+                                keyboard |= device.usUsage == HID_USAGE_GENERIC_KEYBOARD;
+                                mouse |= device.usUsage == HID_USAGE_GENERIC_MOUSE;
+                            }
+                        });
+                    return keyboard && mouse;
+                }
+
+                /// Re-reads the swap-buttons setting, which the user can change while the game runs.
+                void refresh_button_swap() noexcept { m_swapped = GetSystemMetrics(SM_SWAPBUTTON) != 0; }
+
+            private:
+                /**
+                 * @brief Invokes @p visit for each of the process's raw input registrations.
+                 * @return false, having visited none, when the list cannot be read (including a process with more
+                 *         registrations than the fixed buffer holds).
+                 */
+                template <typename Visit> static bool for_each_registration(Visit &&visit) noexcept
+                {
+                    std::array<RAWINPUTDEVICE, 32> devices{};
+                    UINT count = static_cast<UINT>(devices.size());
+                    const UINT listed = GetRegisteredRawInputDevices(devices.data(), &count, sizeof(RAWINPUTDEVICE));
+                    if (listed == static_cast<UINT>(-1))
+                    {
+                        return false;
+                    }
+                    for (UINT i = 0; i < listed; ++i)
+                    {
+                        visit(devices[i]);
+                    }
+                    return true;
+                }
+
+                /// True when something in the process already registered the keyboard or mouse usage.
+                [[nodiscard]] static bool usage_registered_elsewhere() noexcept
+                {
+                    bool taken = false;
+                    const bool listed = for_each_registration(
+                        [&taken](const RAWINPUTDEVICE &device)
+                        {
+                            taken |= device.usUsagePage == HID_USAGE_PAGE_GENERIC &&
+                                     (device.usUsage == HID_USAGE_GENERIC_KEYBOARD ||
+                                      device.usUsage == HID_USAGE_GENERIC_MOUSE);
+                        });
+                    // An unreadable list counts as taken: replacing a registration we cannot see would starve its
+                    // owner.
+                    return taken || !listed;
+                }
+
+                bool apply(HRAWINPUT handle) noexcept
+                {
+                    RAWINPUT raw{};
+                    UINT size = sizeof(raw);
+                    if (GetRawInputData(handle, RID_INPUT, &raw, &size, sizeof(RAWINPUTHEADER)) ==
+                        static_cast<UINT>(-1))
+                    {
+                        return false;
+                    }
+                    switch (raw.header.dwType)
+                    {
+                    case RIM_TYPEKEYBOARD:
+                        return m_keys.apply_keyboard(raw.data.keyboard.VKey, raw.data.keyboard.MakeCode,
+                                                     raw.data.keyboard.Flags);
+                    case RIM_TYPEMOUSE:
+                        return m_keys.apply_mouse(raw.data.mouse.usButtonFlags, m_swapped);
+                    default:
+                        return false;
+                    }
+                }
+
+                HWND m_window{nullptr};
+                bool m_swapped{false};
+                bool m_time_transitions{false};
+                std::int64_t m_transition_ticks{0};
+                RawKeyState m_keys;
+            };
         } // anonymous namespace
 
         static_assert(std::is_nothrow_move_assignable_v<InputBinding>,
@@ -328,10 +693,13 @@ namespace DetourModKit
                       "Input reshape commits rely on noexcept InputBinding move construction");
 
         InputPoller::InputPoller(std::vector<InputBinding> bindings, std::chrono::milliseconds poll_interval,
-                                 bool require_focus, int gamepad_index, int trigger_threshold, int stick_threshold)
+                                 bool require_focus, int gamepad_index, int trigger_threshold, int stick_threshold,
+                                 input::Backend backend)
             : m_bindings(std::move(bindings)),
               m_poll_interval(std::clamp(poll_interval, input::MIN_POLL_INTERVAL, input::MAX_POLL_INTERVAL)),
               m_require_focus(require_focus),
+              m_backend(backend),
+              m_idle_interval(m_poll_interval),
               m_active_states(std::make_unique<std::atomic<uint8_t>[]>(m_bindings.size())),
               m_gamepad_index(std::clamp(gamepad_index, 0, 3)),
               m_trigger_threshold(std::clamp(trigger_threshold, 0, 255)),
@@ -339,6 +707,19 @@ namespace DetourModKit
         {
             m_name_index.reserve(m_bindings.size());
             recompute_modifier_caches_locked();
+            if (m_backend == input::Backend::RawInput)
+            {
+                // A failed event only costs the raw input path: the poll thread falls back to polling.
+                m_wake_event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+            }
+        }
+
+        void InputPoller::wake_poll_thread() const noexcept
+        {
+            if (m_wake_event != nullptr)
+            {
+                SetEvent(static_cast<HANDLE>(m_wake_event));
+            }
         }
 
         void InputPoller::recompute_modifier_caches_locked() noexcept
@@ -377,6 +758,27 @@ namespace DetourModKit
                 }
                 std::vector<InputCode> known_modifiers(modifier_set.begin(), modifier_set.end());
 
+                // Compiled masks for the binding pass, parallel to m_bindings, and every virtual key any binding reads
+                // (compiled or not), which also feeds the adaptive cadence's activity test.
+                std::vector<CompiledCombo> compiled;
+                compiled.reserve(m_bindings.size());
+                KeyMask binding_keys;
+                for (const auto &binding : m_bindings)
+                {
+                    compiled.push_back(compile_binding(binding, known_modifiers));
+                    binding_keys |= compiled.back().forbidden;
+                    for (const auto *codes : {&binding.keys, &binding.modifiers})
+                    {
+                        for (const auto &code : *codes)
+                        {
+                            if (code.source == InputSource::Keyboard || code.source == InputSource::Mouse)
+                            {
+                                binding_keys.set(code.code);
+                            }
+                        }
+                    }
+                }
+
                 // Built from the same bindings and modifier set as the reactive path so the poll-published mask and the
                 // detour-side consume rules never disagree (published in the commit step below).
                 const std::vector<GamepadConsumeRule> consume_rules =
@@ -386,6 +788,8 @@ namespace DetourModKit
                 // function cannot fail.
                 m_name_index = std::move(name_index);
                 m_known_modifiers = std::move(known_modifiers);
+                m_compiled = std::move(compiled);
+                m_binding_keys = binding_keys;
                 m_has_gamepad_bindings.store(scan_for_gamepad_bindings(m_bindings), std::memory_order_relaxed);
                 const bool now_has_wheel_bindings = scan_for_wheel_bindings(m_bindings);
                 m_has_consume_gamepad_bindings.store(scan_for_consume_gamepad_bindings(m_bindings),
@@ -416,6 +820,8 @@ namespace DetourModKit
                 // binding array.
                 m_name_index.clear();
                 m_known_modifiers.clear();
+                m_compiled.clear();
+                m_binding_keys = KeyMask{};
                 m_has_gamepad_bindings.store(false, std::memory_order_relaxed);
                 m_has_wheel_bindings.store(false, std::memory_order_relaxed);
                 m_has_consume_gamepad_bindings.store(false, std::memory_order_relaxed);
@@ -424,18 +830,28 @@ namespace DetourModKit
                                     "InputPoller: out of memory rebuilding modifier caches; "
                                     "name lookup and input interception disabled until the next successful rebuild");
             }
+
+            // An event-driven poll thread may be asleep with nothing held; have it evaluate the new set and install
+            // any hook it now needs.
+            wake_poll_thread();
         }
 
         InputPoller::~InputPoller() noexcept
         {
             shutdown();
+            // A poll thread detached under the loader lock still waits on the event (its module reference, left in
+            // m_self_ref, marks that case), so the handle is leaked along with the thread.
+            if (m_wake_event != nullptr && m_self_ref == nullptr)
+            {
+                CloseHandle(static_cast<HANDLE>(m_wake_event));
+            }
         }
 
         void InputPoller::start()
         {
             if (m_poll_thread.joinable())
             {
-                log().debug("InputPoller: start() called while already running; no-op.");
+                log().debug(log_category::input, "InputPoller: start() called while already running; no-op.");
                 return;
             }
 
@@ -483,6 +899,195 @@ namespace DetourModKit
             return m_gamepad_index;
         }
 
+        input::Backend InputPoller::backend() const noexcept
+        {
+            return m_backend;
+        }
+
+        bool InputPoller::raw_input_active() const noexcept
+        {
+            return m_raw_input_active.load(std::memory_order_acquire);
+        }
+
+        void InputPoller::set_adaptive_polling(std::chrono::milliseconds idle_interval,
+                                               std::chrono::milliseconds quiet_timeout) noexcept
+        {
+            if (m_poll_thread.joinable())
+            {
+                return;
+            }
+            m_idle_interval = std::clamp(idle_interval, m_poll_interval, input::MAX_POLL_INTERVAL);
+            m_quiet_timeout = std::max(quiet_timeout, std::chrono::milliseconds{0});
+        }
+
+        std::chrono::milliseconds InputPoller::idle_poll_interval() const noexcept
+        {
+            return m_idle_interval;
+        }
+
+        void InputPoller::publish_snapshot(const input::InputSnapshot &cycle) noexcept
+        {
+            const std::uint64_t seq = m_snapshot_seq.load(std::memory_order_relaxed);
+            m_snapshot_seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_snapshot.cycle.store(cycle.m_cycle, std::memory_order_relaxed);
+            m_snapshot.generation.store(cycle.m_generation, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < m_snapshot.active.size(); ++i)
+            {
+                m_snapshot.active[i].store(cycle.m_active[i], std::memory_order_relaxed);
+                m_snapshot.pressed[i].store(cycle.m_pressed[i], std::memory_order_relaxed);
+            }
+            for (std::size_t i = 0; i < m_snapshot.wheel.size(); ++i)
+            {
+                m_snapshot.wheel[i].store(cycle.m_wheel[i], std::memory_order_relaxed);
+            }
+            m_snapshot_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        input::InputSnapshot InputPoller::snapshot() const noexcept
+        {
+            input::InputSnapshot copy;
+            for (;;)
+            {
+                const std::uint64_t before = m_snapshot_seq.load(std::memory_order_acquire);
+                if ((before & 1) != 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                copy.m_cycle = m_snapshot.cycle.load(std::memory_order_relaxed);
+                copy.m_generation = m_snapshot.generation.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < m_snapshot.active.size(); ++i)
+                {
+                    copy.m_active[i] = m_snapshot.active[i].load(std::memory_order_relaxed);
+                    copy.m_pressed[i] = m_snapshot.pressed[i].load(std::memory_order_relaxed);
+                }
+                for (std::size_t i = 0; i < m_snapshot.wheel.size(); ++i)
+                {
+                    copy.m_wheel[i] = m_snapshot.wheel[i].load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_snapshot_seq.load(std::memory_order_relaxed) == before)
+                {
+                    return copy;
+                }
+            }
+        }
+
+        void InputPoller::publish_gamepad(const input::GamepadSnapshot &reading) noexcept
+        {
+            const std::uint64_t seq = m_gamepad_seq.load(std::memory_order_relaxed);
+            m_gamepad_seq.store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            m_gamepad.timestamp.store(reading.timestamp, std::memory_order_relaxed);
+            m_gamepad.packet_number.store(reading.packet_number, std::memory_order_relaxed);
+            m_gamepad.slot.store(reading.slot, std::memory_order_relaxed);
+            m_gamepad.connected.store(reading.connected, std::memory_order_relaxed);
+            m_gamepad.buttons_left[0].store(pack_buttons_left(reading.raw), std::memory_order_relaxed);
+            m_gamepad.right_thumbs[0].store(pack_right_thumb(reading.raw), std::memory_order_relaxed);
+            m_gamepad.buttons_left[1].store(pack_buttons_left(reading.game), std::memory_order_relaxed);
+            m_gamepad.right_thumbs[1].store(pack_right_thumb(reading.game), std::memory_order_relaxed);
+            m_gamepad_seq.store(seq + 2, std::memory_order_release);
+        }
+
+        input::GamepadSnapshot InputPoller::gamepad_snapshot() const noexcept
+        {
+            input::GamepadSnapshot copy;
+            for (;;)
+            {
+                const std::uint64_t before = m_gamepad_seq.load(std::memory_order_acquire);
+                if ((before & 1) != 0)
+                {
+                    std::this_thread::yield();
+                    continue;
+                }
+                copy.timestamp = m_gamepad.timestamp.load(std::memory_order_relaxed);
+                copy.packet_number = m_gamepad.packet_number.load(std::memory_order_relaxed);
+                copy.slot = m_gamepad.slot.load(std::memory_order_relaxed);
+                copy.connected = m_gamepad.connected.load(std::memory_order_relaxed);
+                const std::uint64_t raw_low = m_gamepad.buttons_left[0].load(std::memory_order_relaxed);
+                const std::uint32_t raw_high = m_gamepad.right_thumbs[0].load(std::memory_order_relaxed);
+                const std::uint64_t game_low = m_gamepad.buttons_left[1].load(std::memory_order_relaxed);
+                const std::uint32_t game_high = m_gamepad.right_thumbs[1].load(std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (m_gamepad_seq.load(std::memory_order_relaxed) == before)
+                {
+                    copy.raw = unpack_gamepad_state(raw_low, raw_high);
+                    copy.game = unpack_gamepad_state(game_low, game_high);
+                    return copy;
+                }
+            }
+        }
+
+        bool InputPoller::set_event_queue(std::size_t capacity) noexcept
+        {
+            if (m_poll_thread.joinable())
+            {
+                return true;
+            }
+            if (capacity == 0)
+            {
+                m_event_ring.reset();
+                return true;
+            }
+            m_event_ring = InputEventRing::create(capacity);
+            return m_event_ring != nullptr;
+        }
+
+        std::size_t InputPoller::drain_events(std::span<input::InputEvent> out) noexcept
+        {
+            if (!m_event_ring || out.empty())
+            {
+                return 0;
+            }
+            std::scoped_lock lock{m_event_drain_mutex};
+            return m_event_ring->pop(out);
+        }
+
+        std::uint64_t InputPoller::dropped_events() const noexcept
+        {
+            return m_event_ring ? m_event_ring->dropped() : 0;
+        }
+
+        void InputPoller::set_latency_stats(bool enabled) noexcept
+        {
+            if (!m_poll_thread.joinable())
+            {
+                m_latency_stats = enabled;
+            }
+        }
+
+        input::InputLatencyStats InputPoller::latency_stats() const noexcept
+        {
+            input::InputLatencyStats stats;
+            LARGE_INTEGER frequency;
+            if (QueryPerformanceFrequency(&frequency))
+            {
+                stats.ticks_per_second = frequency.QuadPart;
+            }
+            stats.cycle_cost = m_cycle_cost.read();
+            stats.event_to_edge = m_event_to_edge.read();
+            stats.edge_to_dispatch = m_edge_to_dispatch.read();
+            return stats;
+        }
+
+        void InputPoller::set_key_state_probe(KeyStateProbe probe, void *context) noexcept
+        {
+            if (!m_poll_thread.joinable())
+            {
+                m_key_probe = probe;
+                m_key_probe_context = probe != nullptr ? context : nullptr;
+            }
+        }
+
+        input::PollCadenceStats InputPoller::cadence_stats() const noexcept
+        {
+            return input::PollCadenceStats{m_fast_cycles.load(std::memory_order_relaxed),
+                                           m_idle_cycles.load(std::memory_order_relaxed),
+                                           m_event_cycles.load(std::memory_order_relaxed),
+                                           m_fast_switches.load(std::memory_order_relaxed)};
+        }
+
         bool InputPoller::is_binding_active(size_t index) const noexcept
         {
             // Acquire the shared lock so the index/array pair stays consistent across a reshape (add_binding,
@@ -583,6 +1188,7 @@ namespace DetourModKit
         void InputPoller::set_require_focus(bool require_focus) noexcept
         {
             m_require_focus.store(require_focus, std::memory_order_relaxed);
+            wake_poll_thread();
         }
 
         void InputPoller::set_consume(std::string_view name, bool consume) noexcept
@@ -641,6 +1247,7 @@ namespace DetourModKit
 
             m_poll_thread.request_stop();
             m_cv.notify_all();
+            wake_poll_thread();
 
             if (is_loader_lock_held())
             {
@@ -686,9 +1293,8 @@ namespace DetourModKit
             const int trigger_thresh = m_trigger_threshold;
             const int stick_thresh = m_stick_threshold;
 
-            constexpr auto gamepad_reconnect_interval = std::chrono::seconds{2};
-            bool gamepad_was_connected = false;
-            auto last_gamepad_poll = std::chrono::steady_clock::time_point{};
+            // When the slot is read: every cycle while connected, on a backoff while empty (see gamepad_probe.hpp).
+            GamepadProbeSchedule gamepad_probe;
 
             // Interception state, carried across cycles. Both are poll-thread-private:
             // the published mask and wheel latch they feed live in input_intercept.
@@ -712,6 +1318,41 @@ namespace DetourModKit
             // once so its 256-byte table is allocated for the poll thread's lifetime, not rebuilt each cycle.
             KeyStateCache key_cache;
 
+            // Backend::RawInput: while raw_keys is set the key state comes from the sink's WM_INPUT events and the
+            // loop sleeps on them (and on m_wake_event) instead of on the poll interval. Cleared on any failure, after
+            // which this loop polls exactly as Backend::Poll does.
+            RawInputSink raw_sink;
+            const RawKeyState *raw_keys = nullptr;
+            if (m_backend == input::Backend::RawInput && m_key_probe != nullptr)
+            {
+                (void)log().try_log(log_category::input, LogLevel::Debug,
+                                    "InputPoller: key-state probe injected; raw input not opened");
+            }
+            else if (m_backend == input::Backend::RawInput)
+            {
+                if (m_wake_event != nullptr && raw_sink.open())
+                {
+                    raw_sink.time_transitions(m_latency_stats);
+                    raw_keys = &raw_sink.keys();
+                    m_raw_input_active.store(true, std::memory_order_release);
+                    (void)log().try_log(log_category::input, LogLevel::Debug,
+                                        "InputPoller: keyboard/mouse read from raw input events");
+                }
+                else
+                {
+                    (void)log().try_log(LogLevel::Warning,
+                                        "InputPoller: raw input unavailable (the process already registers raw "
+                                        "keyboard/mouse input, or setup failed); polling instead");
+                }
+            }
+            auto last_ownership_check = std::chrono::steady_clock::now();
+
+            // Adaptive polling is on when set_adaptive_polling() gave an idle interval above the fast one.
+            const bool adaptive = m_idle_interval > m_poll_interval;
+            AdaptiveCadence cadence(m_poll_interval, m_idle_interval, m_quiet_timeout);
+            // Numbers the published snapshots (input::InputSnapshot::cycle); a skipped publish leaves a gap.
+            std::uint64_t snapshot_cycle = 0;
+
             struct PendingCallback
             {
                 std::string name;
@@ -750,28 +1391,50 @@ namespace DetourModKit
                 // every cycle also disarms wheel swallowing the moment the last such binding is removed.
                 uint16_t gamepad_owned = 0;
                 uint8_t wheel_owned = 0;
+                // Whether any binding ended this pass active; an event-driven loop then keeps the poll cadence so a
+                // focus loss still releases a hold promptly.
+                bool any_binding_active = false;
+                // Whether any key, button, or notch a binding reads showed up this cycle; drives the adaptive cadence.
+                bool input_activity = false;
+                // QPC time the binding pass sampled its input; read only when the event queue or latency stats need
+                // it, and then the detection time of every edge this cycle.
+                std::int64_t cycle_ticks = 0;
+                bool cycle_had_edge = false;
 
                 // Poll gamepad state once per cycle when connected, into the hoisted gamepad_state buffer. When
-                // disconnected, throttle reconnection attempts to avoid the per-cycle overhead of XInputGetState on
-                // empty slots. Read through the saved trampoline when the suppression hook is installed so the poll
-                // observes the true, unmasked controller state rather than its own published mask. A successful poll
-                // overwrites the whole struct, and gamepad_state is read only when gamepad_connected is true, so a
-                // stale buffer is never observed.
+                // disconnected, probe on the schedule's backoff to avoid the per-cycle overhead of XInputGetState on
+                // an empty slot; the raw input device count, a cheap count query, changes when a controller is
+                // plugged in and ends the backoff early. Read through the saved trampoline when the suppression hook
+                // is installed so the poll observes the true, unmasked controller state rather than its own published
+                // mask. A successful poll overwrites the whole struct, and gamepad_state is read only when
+                // gamepad_connected is true, so a stale buffer is never observed.
                 bool gamepad_connected = false;
+                // Set when this cycle called XInputGetState; the reading is published after the suppression step
+                // below so its post-suppression half uses this cycle's mask.
+                bool gamepad_polled = false;
+                std::int64_t gamepad_ticks = 0;
                 if (m_has_gamepad_bindings.load(std::memory_order_relaxed) && process_focused)
                 {
                     const auto now = std::chrono::steady_clock::now();
-                    if (gamepad_was_connected || (now - last_gamepad_poll) >= gamepad_reconnect_interval)
+                    UINT device_count = 0;
+                    if (!gamepad_probe.connected() &&
+                        GetRawInputDeviceList(nullptr, &device_count, sizeof(RAWINPUTDEVICELIST)) != 0)
+                    {
+                        device_count = 0;
+                    }
+                    if (gamepad_probe.should_probe(now, device_count))
                     {
-                        last_gamepad_poll = now;
                         const XInputGetStateFn xinput_original = xinput_trampoline();
                         const DWORD xinput_result =
                             (xinput_original != nullptr)
                                 ? xinput_original(static_cast<DWORD>(m_gamepad_index), &gamepad_state)
                                 : XInputGetState(static_cast<DWORD>(m_gamepad_index), &gamepad_state);
-                        gamepad_was_connected = xinput_result == ERROR_SUCCESS;
+                        gamepad_probe.record(xinput_result == ERROR_SUCCESS, now);
+                        gamepad_polled = true;
+                        gamepad_ticks = read_qpc();
                     }
-                    gamepad_connected = gamepad_was_connected;
+                    gamepad_connected = gamepad_probe.connected();
+                    input_activity = gamepad_connected && gamepad_in_use(gamepad_state, trigger_thresh, stick_thresh);
                 }
 
                 // Stage this cycle's edge callbacks, then dispatch them after releasing the binding lock so user code
@@ -809,13 +1472,70 @@ namespace DetourModKit
                     // racing rebind registers between the drain and the evaluation (recompute_modifier_caches_locked
                     // runs under the exclusive side of this same lock).
                     uint8_t wheel_pulse_mask = 0;
+                    input::InputSnapshot cycle_snapshot;
                     if (m_has_wheel_bindings.load(std::memory_order_relaxed))
                     {
                         const auto taken = take_wheel_counts();
+                        cycle_snapshot.m_wheel = taken;
                         add_wheel_notches(wheel_pulse, taken);
                         wheel_pulse_mask = step_wheel_pulse(wheel_pulse);
                     }
 
+                    // One mask of every key a binding reads, probed once each, so a compiled binding matches with a
+                    // handful of word operations however many bindings share the keys. m_compiled is empty after a
+                    // failed rebuild, and then every binding takes the per-code path.
+                    const bool use_compiled = m_compiled.size() == count;
+                    // Joined to the services registry, one polling instance samples every instance's keys and the
+                    // rest read its sweep. Only a cycle that would call GetAsyncKeyState itself takes part.
+                    std::optional<KeyMask> sweep_for_others;
+                    KeyMask shared_down;
+                    KeyMask shared_covered;
+                    bool read_shared_sweep = false;
+                    if (process_focused && raw_keys == nullptr && m_key_probe == nullptr && shared_services_joined())
+                    {
+                        sweep_for_others = claim_key_sweep();
+                        if (!sweep_for_others)
+                        {
+                            publish_wanted_keys(m_binding_keys);
+                            read_shared_sweep = read_key_sweep(2 * m_poll_interval, shared_down, shared_covered);
+                        }
+                    }
+                    const KeySource keys{raw_keys, m_key_probe, m_key_probe_context,
+                                         read_shared_sweep ? &shared_down : nullptr,
+                                         read_shared_sweep ? &shared_covered : nullptr};
+                    InputEventRing *const event_ring = m_event_ring.get();
+                    if (event_ring || m_latency_stats)
+                    {
+                        cycle_ticks = read_qpc();
+                    }
+                    KeyMask keys_down;
+                    if (process_focused)
+                    {
+                        m_binding_keys.for_each(
+                            [&](int vk) noexcept
+                            {
+                                if (probe_vk(vk, key_cache, keys))
+                                {
+                                    keys_down.set(vk);
+                                }
+                            });
+                        if (sweep_for_others)
+                        {
+                            KeyMask swept_down = keys_down;
+                            sweep_for_others->for_each(
+                                [&](int vk) noexcept
+                                {
+                                    if (probe_vk(vk, key_cache, keys))
+                                    {
+                                        swept_down.set(vk);
+                                    }
+                                });
+                            *sweep_for_others |= m_binding_keys;
+                            publish_key_sweep(swept_down, *sweep_for_others);
+                        }
+                    }
+                    input_activity = input_activity || !keys_down.empty() || wheel_pulse_mask != 0;
+
                     for (size_t i = 0; i < count; ++i)
                     {
                         const auto &binding = m_bindings[i];
@@ -826,13 +1546,17 @@ namespace DetourModKit
 
                         bool any_pressed = false;
 
-                        if (process_focused)
+                        if (process_focused && use_compiled && m_compiled[i].compiled)
+                        {
+                            any_pressed = m_compiled[i].matches(keys_down);
+                        }
+                        else if (process_focused)
                         {
                             bool modifiers_held = true;
                             for (const auto &mod : binding.modifiers)
                             {
-                                if (!is_code_pressed(mod, key_cache, gamepad_state, gamepad_connected, trigger_thresh,
-                                                     stick_thresh, wheel_pulse_mask))
+                                if (!is_code_pressed(mod, key_cache, keys, gamepad_state, gamepad_connected,
+                                                     trigger_thresh, stick_thresh, wheel_pulse_mask))
                                 {
                                     modifiers_held = false;
                                     break;
@@ -845,7 +1569,7 @@ namespace DetourModKit
                                 // NOT in this binding's required set is currently held.
                                 for (const auto &km : known_mods)
                                 {
-                                    if (!is_code_pressed(km, key_cache, gamepad_state, gamepad_connected,
+                                    if (!is_code_pressed(km, key_cache, keys, gamepad_state, gamepad_connected,
                                                          trigger_thresh, stick_thresh, wheel_pulse_mask))
                                     {
                                         continue;
@@ -872,7 +1596,7 @@ namespace DetourModKit
                                 for (const auto &key : binding.keys)
                                 {
                                     const bool key_pressed =
-                                        is_code_pressed(key, key_cache, gamepad_state, gamepad_connected,
+                                        is_code_pressed(key, key_cache, keys, gamepad_state, gamepad_connected,
                                                         trigger_thresh, stick_thresh, wheel_pulse_mask);
 
                                     // Pre-arm the consume bit while the binding's modifiers are held, before the
@@ -925,6 +1649,23 @@ namespace DetourModKit
                         }
 
                         const bool was_active = m_active_states[i].load(std::memory_order_relaxed) != 0;
+                        any_binding_active |= any_pressed;
+                        if (any_pressed && i < input::SNAPSHOT_BINDING_CAPACITY)
+                        {
+                            const std::uint64_t bit = std::uint64_t{1} << (i % 64);
+                            cycle_snapshot.m_active[i / 64] |= bit;
+                            if (!was_active)
+                            {
+                                cycle_snapshot.m_pressed[i / 64] |= bit;
+                            }
+                        }
+
+                        cycle_had_edge |= any_pressed != was_active;
+                        if (event_ring && any_pressed != was_active)
+                        {
+                            (void)event_ring->push({m_binding_generation, cycle_ticks, static_cast<std::uint32_t>(i),
+                                                    any_pressed ? input::InputEdge::Press : input::InputEdge::Release});
+                        }
 
                         switch (binding.trigger)
                         {
@@ -948,6 +1689,16 @@ namespace DetourModKit
                         }
                         }
                     }
+
+                    // Publish while the generation read is still covered by the shared lock, and before this cycle's
+                    // callbacks run, so a reader a callback signals already sees the cycle that fired it.
+                    cycle_snapshot.m_cycle = ++snapshot_cycle;
+                    cycle_snapshot.m_generation = m_binding_generation;
+                    publish_snapshot(cycle_snapshot);
+                    if (m_latency_stats)
+                    {
+                        m_cycle_cost.record(read_qpc() - cycle_ticks);
+                    }
                 }
                 catch (...)
                 {
@@ -991,6 +1742,30 @@ namespace DetourModKit
                     gamepad_suppress_active = false;
                 }
 
+                // Publish the controller reading for Input::gamepad_snapshot(), so a consumer that wants analog values
+                // reads this cycle's call instead of making its own. The game half is what the XInput detour would
+                // hand back for the same buttons under the mask just published.
+                if (gamepad_polled)
+                {
+                    input::GamepadSnapshot reading;
+                    reading.timestamp = gamepad_ticks;
+                    reading.slot = static_cast<std::uint32_t>(m_gamepad_index);
+                    reading.connected = gamepad_connected;
+                    if (gamepad_connected)
+                    {
+                        reading.packet_number = gamepad_state.dwPacketNumber;
+                        reading.raw = to_gamepad_state(gamepad_state.Gamepad);
+                        reading.game = reading.raw;
+                        if (xinput_installed())
+                        {
+                            const std::uint16_t mask =
+                                gamepad_detour_mask(reading.raw.buttons, static_cast<DWORD>(m_gamepad_index));
+                            reading.game.buttons = static_cast<std::uint16_t>(reading.raw.buttons & ~mask);
+                        }
+                    }
+                    publish_gamepad(reading);
+                }
+
                 // Publish the per-direction wheel-swallow mask for the WndProc detour. Driven every cycle (not gated on
                 // wheel bindings) so it disarms on the first cycle after the last consume wheel binding is removed:
                 // wheel_owned is already 0 in that case, and a zero publish forwards every wheel message. A non-zero
@@ -998,8 +1773,23 @@ namespace DetourModKit
                 // wheel.
                 publish_wheel_consume(wheel_owned);
 
+                if (m_latency_stats && raw_keys != nullptr)
+                {
+                    // Only a cycle that detected an edge pairs with the event that woke it; a transition that
+                    // produced no edge (an unbound key) is dropped here so it cannot pair with a later cycle.
+                    const std::int64_t event_ticks = raw_sink.take_transition_ticks();
+                    if (cycle_had_edge && event_ticks != 0)
+                    {
+                        m_event_to_edge.record(cycle_ticks - event_ticks);
+                    }
+                }
+
                 for (auto &callback : pending)
                 {
+                    if (m_latency_stats)
+                    {
+                        m_edge_to_dispatch.record(read_qpc() - cycle_ticks);
+                    }
                     try
                     {
                         if (callback.on_press)
@@ -1023,10 +1813,61 @@ namespace DetourModKit
                     }
                 }
 
-                std::unique_lock lock(m_cv_mutex);
-                m_cv.wait_for(lock, stop_token, m_poll_interval,
-                              [&stop_token]() { return stop_token.stop_requested(); });
+                if (raw_keys == nullptr)
+                {
+                    auto interval = m_poll_interval;
+                    if (adaptive)
+                    {
+                        interval = cadence.step(input_activity || any_binding_active, std::chrono::steady_clock::now());
+                        if (cadence.switched_to_fast())
+                        {
+                            m_fast_switches.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                    (interval == m_poll_interval ? m_fast_cycles : m_idle_cycles)
+                        .fetch_add(1, std::memory_order_relaxed);
+                    std::unique_lock lock(m_cv_mutex);
+                    m_cv.wait_for(lock, stop_token, interval, [&stop_token]() { return stop_token.stop_requested(); });
+                    continue;
+                }
+
+                // Event-driven wait. Gamepad and wheel state, an unfinished lazy hook install, and a held binding
+                // still need the poll cadence; otherwise the thread sleeps until a key or button changes, a reshape or
+                // shutdown signals m_wake_event, or the ownership check falls due.
+                const bool needs_cadence =
+                    m_has_gamepad_bindings.load(std::memory_order_relaxed) || has_wheel_bindings ||
+                    any_binding_active ||
+                    (m_has_consume_gamepad_bindings.load(std::memory_order_relaxed) && !xinput_installed());
+                const auto timeout = needs_cadence ? std::min(m_poll_interval, RAW_INPUT_OWNERSHIP_CHECK)
+                                                   : RAW_INPUT_OWNERSHIP_CHECK;
+                if (stop_token.stop_requested())
+                {
+                    break;
+                }
+                (needs_cadence ? m_fast_cycles : m_event_cycles).fetch_add(1, std::memory_order_relaxed);
+                (void)raw_sink.wait(static_cast<HANDLE>(m_wake_event), static_cast<DWORD>(timeout.count()));
+
+                const auto now = std::chrono::steady_clock::now();
+                if (now - last_ownership_check >= RAW_INPUT_OWNERSHIP_CHECK)
+                {
+                    last_ownership_check = now;
+                    raw_sink.refresh_button_swap();
+                    if (!raw_sink.owns_registration())
+                    {
+                        // Another window (typically the game's, registered after this engine started) now receives
+                        // the raw events, so the table would go stale. Poll from here on; the next cycle reads the
+                        // live state, so nothing stays stuck down.
+                        raw_sink.close();
+                        raw_keys = nullptr;
+                        m_raw_input_active.store(false, std::memory_order_release);
+                        (void)log().try_log(LogLevel::Warning,
+                                            "InputPoller: raw input registration taken over by another window; "
+                                            "polling instead");
+                    }
+                }
             }
+            m_raw_input_active.store(false, std::memory_order_release);
+            release_key_sweep();
         }
 
         bool InputPoller::update_combos(std::string_view name, const input::KeyComboList &combos) noexcept
@@ -1043,8 +1884,8 @@ namespace DetourModKit
                     // Release the writer lock before logging so the emit does not run inside the critical section
                     // (deferred-logging convention).
                     lock.unlock();
-                    (void)log().try_log(LogLevel::Debug, "InputPoller: update_combos(\"{}\") ignored: name not found",
-                                        name);
+                    (void)log().try_log(log_category::input, LogLevel::Debug,
+                                        "InputPoller: update_combos(\"{}\") ignored: name not found", name);
                     return false;
                 }
 
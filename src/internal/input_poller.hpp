@@ -18,8 +18,12 @@
 
 #include "DetourModKit/input.hpp"
 #include "DetourModKit/input_codes.hpp"
+#include "internal/input_event_ring.hpp"
+#include "internal/input_key_mask.hpp"
+#include "internal/input_latency.hpp"
 #include "internal/srw_shared_mutex.hpp"
 
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -28,6 +32,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -79,9 +84,9 @@ namespace DetourModKit
         /**
          * @class InputPoller
          * @brief RAII polling engine monitoring input state on a background thread.
-         * @details Manages a dedicated poll thread that reads keyboard/mouse via GetAsyncKeyState, gamepad via XInput,
-         * and
-         *          the mouse wheel via the window-procedure subclass. Supports press (edge-triggered) and hold
+         * @details Manages a dedicated poll thread that reads keyboard/mouse via GetAsyncKeyState (or, with
+         *          Backend::RawInput, from WM_INPUT events on a message-only window), gamepad via XInput, and the mouse
+         *          wheel via the window-procedure subclass. Supports press (edge-triggered) and hold
          *          (level-triggered) bindings with modifier combinations and optional foreground-focus gating. On
          *          shutdown, active holds receive a final on_state_change(false).
          *
@@ -106,12 +111,15 @@ namespace DetourModKit
              * @param gamepad_index XInput controller index (clamped 0-3).
              * @param trigger_threshold Analog trigger deadzone (clamped 0-255).
              * @param stick_threshold Thumbstick deadzone (clamped 0-32767).
+             * @param backend Keyboard/mouse backend. Backend::RawInput falls back to polling when the raw input
+             *                registration cannot be taken (see input::Backend).
              */
             explicit InputPoller(std::vector<InputBinding> bindings,
                                  std::chrono::milliseconds poll_interval = input::DEFAULT_POLL_INTERVAL,
                                  bool require_focus = true, int gamepad_index = 0,
                                  int trigger_threshold = GamepadCode::TriggerThreshold,
-                                 int stick_threshold = GamepadCode::StickThreshold);
+                                 int stick_threshold = GamepadCode::StickThreshold,
+                                 input::Backend backend = input::Backend::Poll);
 
             ~InputPoller() noexcept;
 
@@ -139,6 +147,62 @@ namespace DetourModKit
             /// The configured XInput controller index (0-3).
             [[nodiscard]] int gamepad_index() const noexcept;
 
+            /// The configured keyboard/mouse backend.
+            [[nodiscard]] input::Backend backend() const noexcept;
+
+            /// True while the poll thread reads keyboard/mouse from its raw input window rather than by polling.
+            [[nodiscard]] bool raw_input_active() const noexcept;
+
+            /**
+             * @brief Enables the adaptive cadence (see input::Input::Settings::adaptive_polling).
+             * @details Call before start(); ignored once the poll thread runs. @p idle_interval is clamped to
+             *          [poll_interval(), MAX_POLL_INTERVAL] and @p quiet_timeout to at least zero.
+             */
+            void set_adaptive_polling(std::chrono::milliseconds idle_interval,
+                                      std::chrono::milliseconds quiet_timeout) noexcept;
+
+            /// The configured adaptive idle interval; equal to poll_interval() when adaptive polling is off.
+            [[nodiscard]] std::chrono::milliseconds idle_poll_interval() const noexcept;
+
+            /// How the poll thread's cycles were paced so far. Thread-safe.
+            [[nodiscard]] input::PollCadenceStats cadence_stats() const noexcept;
+
+            /// Reads the latest published cycle snapshot (seqlock; see m_snapshot). Lock-free and thread-safe.
+            [[nodiscard]] input::InputSnapshot snapshot() const noexcept;
+
+            /// Reads the latest published controller reading (seqlock; see m_gamepad). Lock-free and thread-safe.
+            [[nodiscard]] input::GamepadSnapshot gamepad_snapshot() const noexcept;
+
+            /**
+             * @brief Enables the edge queue (see input::Input::Settings::event_queue_capacity).
+             * @details Call before start(); ignored once the poll thread runs. A capacity of 0 keeps no queue.
+             * @return false when the queue could not be allocated (the poller then runs without one).
+             */
+            bool set_event_queue(std::size_t capacity) noexcept;
+
+            /// Moves up to out.size() queued edges into @p out, oldest first. Concurrent calls serialize.
+            std::size_t drain_events(std::span<input::InputEvent> out) noexcept;
+
+            /// Edges dropped because the queue was full; 0 without a queue.
+            [[nodiscard]] std::uint64_t dropped_events() const noexcept;
+
+            /// Enables latency recording (see input::Input::Settings::latency_stats). Ignored once running.
+            void set_latency_stats(bool enabled) noexcept;
+
+            /// The latency histograms recorded so far. Thread-safe.
+            [[nodiscard]] input::InputLatencyStats latency_stats() const noexcept;
+
+            /// Keyboard/mouse down-state probe replacing GetAsyncKeyState; @p context is the set_key_state_probe one.
+            using KeyStateProbe = bool (*)(void *context, int vk) noexcept;
+
+            /**
+             * @brief Reads keyboard and mouse state from @p probe instead of the OS (replay harnesses, benchmarks).
+             * @details Call before start(); ignored once the poll thread runs. The probe is called on the poll thread,
+             *          at most once per distinct key per cycle, and overrides Backend::RawInput, which then never
+             *          opens. Pass nullptr to restore the OS source. @p context must outlive the poll thread.
+             */
+            void set_key_state_probe(KeyStateProbe probe, void *context) noexcept;
+
             /// Queries activity by index. Returns false for out-of-range indices. Thread-safe.
             [[nodiscard]] bool is_binding_active(std::size_t index) const noexcept;
 
@@ -235,8 +299,14 @@ namespace DetourModKit
         private:
             void poll_loop(std::stop_token stop_token);
             void release_active_holds() noexcept;
+            /// Publishes one cycle's state to m_snapshot. Poll thread only.
+            void publish_snapshot(const input::InputSnapshot &cycle) noexcept;
+            /// Publishes one controller reading to m_gamepad. Poll thread only.
+            void publish_gamepad(const input::GamepadSnapshot &reading) noexcept;
             [[nodiscard]] bool is_process_foreground() const noexcept;
             void recompute_modifier_caches_locked() noexcept;
+            /// Wakes an event-driven poll thread so it re-evaluates now (a no-op for the polling backend).
+            void wake_poll_thread() const noexcept;
 
             /// Transparent hasher enabling std::string_view lookup without allocation.
             struct StringHash
@@ -245,15 +315,20 @@ namespace DetourModKit
                 std::size_t operator()(std::string_view sv) const noexcept { return std::hash<std::string_view>{}(sv); }
             };
 
-            // m_bindings_rw_mutex protects m_bindings, m_name_index, m_known_modifiers, m_binding_generation, and the
-            // interception gates during a live update. The poll loop holds a shared lock across the evaluation pass and
-            // releases it before dispatching callbacks, so callbacks may re-enter binding_count / is_binding_active /
-            // update_combos without re-acquiring the non-recursive lock; update_combos holds an exclusive lock. The
-            // m_active_states entries are always accessed via atomics and need no further guard.
+            // m_bindings_rw_mutex protects m_bindings, m_name_index, m_known_modifiers, m_compiled,
+            // m_binding_generation, and the interception gates during a live update. The poll loop holds a shared lock
+            // across the evaluation pass and releases it before dispatching callbacks, so callbacks may re-enter
+            // binding_count / is_binding_active / update_combos without re-acquiring the non-recursive lock;
+            // update_combos holds an exclusive lock. The m_active_states entries are always accessed via atomics and
+            // need no further guard.
             mutable SrwSharedMutex m_bindings_rw_mutex;
             std::vector<InputBinding> m_bindings;
             std::unordered_map<std::string, std::vector<std::size_t>, StringHash, std::equal_to<>> m_name_index;
             std::vector<InputCode> m_known_modifiers;
+            // Mask form of each binding, parallel to m_bindings (or empty after a failed rebuild), and every virtual
+            // key any binding reads; rebuilt with the other caches. See input_key_mask.hpp.
+            std::vector<CompiledCombo> m_compiled;
+            KeyMask m_binding_keys;
             // Advances on every binding-set reshape; an input::BindingToken captures this at acquire time and a query
             // whose token generation no longer matches fails closed. Guarded by m_bindings_rw_mutex.
             std::uint64_t m_binding_generation{0};
@@ -270,6 +345,65 @@ namespace DetourModKit
             std::mutex m_cv_mutex;
             std::condition_variable_any m_cv;
 
+            // Backend::RawInput state. m_wake_event is an auto-reset event HANDLE (void* as above) the raw input wait
+            // also sleeps on, created by the constructor and closed by the destructor; shutdown() and every binding
+            // reshape signal it so a sleeping poll thread sees the stop request or the new binding set. Null for the
+            // polling backend, or when it could not be created (the poll thread then polls).
+            input::Backend m_backend;
+            void *m_wake_event{nullptr};
+            std::atomic<bool> m_raw_input_active{false};
+
+            // Adaptive cadence, fixed before start() (m_idle_interval == m_poll_interval means off), and the cycle
+            // counters behind cadence_stats(), written only by the poll thread.
+            std::chrono::milliseconds m_idle_interval;
+            std::chrono::milliseconds m_quiet_timeout{0};
+            std::atomic<std::uint64_t> m_fast_cycles{0};
+            std::atomic<std::uint64_t> m_idle_cycles{0};
+            std::atomic<std::uint64_t> m_event_cycles{0};
+            std::atomic<std::uint64_t> m_fast_switches{0};
+
+            // The latest cycle's snapshot. A seqlock with the poll thread as its only writer: m_snapshot_seq is odd
+            // while a publish is in flight, and a reader retries until it copies the fields between two equal even
+            // reads. The fields are atomics so the racing copy a retry discards is not a data race.
+            struct SnapshotCell
+            {
+                std::atomic<std::uint64_t> cycle{0};
+                std::atomic<std::uint64_t> generation{0};
+                std::array<std::atomic<std::uint64_t>, input::SNAPSHOT_BINDING_CAPACITY / 64> active{};
+                std::array<std::atomic<std::uint64_t>, input::SNAPSHOT_BINDING_CAPACITY / 64> pressed{};
+                std::array<std::atomic<int>, 4> wheel{};
+            };
+            std::atomic<std::uint64_t> m_snapshot_seq{0};
+            SnapshotCell m_snapshot;
+
+            // The latest controller reading, a seqlock like m_snapshot. Each GamepadState (index 0 raw, 1 game) packs
+            // its buttons, triggers, and left thumb into one 64-bit word and its right thumb into one 32-bit word.
+            struct GamepadCell
+            {
+                std::atomic<std::int64_t> timestamp{0};
+                std::atomic<std::uint32_t> packet_number{0};
+                std::atomic<std::uint32_t> slot{0};
+                std::atomic<bool> connected{false};
+                std::array<std::atomic<std::uint64_t>, 2> buttons_left{};
+                std::array<std::atomic<std::uint32_t>, 2> right_thumbs{};
+            };
+            std::atomic<std::uint64_t> m_gamepad_seq{0};
+            GamepadCell m_gamepad;
+
+            // Edge queue behind drain_events(), fixed before start(); null when disabled. The poll thread is its only
+            // producer, and m_event_drain_mutex makes the draining threads its single consumer.
+            std::unique_ptr<InputEventRing> m_event_ring;
+            std::mutex m_event_drain_mutex;
+
+            // Latency recording and the injected key source, both fixed before start(). The recorders have the poll
+            // thread as their only writer.
+            bool m_latency_stats{false};
+            LatencyRecorder m_cycle_cost;
+            LatencyRecorder m_event_to_edge;
+            LatencyRecorder m_edge_to_dispatch;
+            KeyStateProbe m_key_probe{nullptr};
+            void *m_key_probe_context{nullptr};
+
             // Per-binding active state, indexed parallel to m_bindings. Atomic for cross-thread reads.
             std::unique_ptr<std::atomic<std::uint8_t>[]> m_active_states;
 
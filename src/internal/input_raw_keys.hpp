@@ -0,0 +1,159 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_RAW_KEYS_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_RAW_KEYS_HPP
+
+/**
+ * @file input_raw_keys.hpp
+ * @brief Internal virtual-key down-state kept from raw keyboard and mouse events.
+ * @details Poll-thread-private helper for the InputPoller's Backend::RawInput path. Windows-agnostic and
+ *          allocation-free so it can be unit-tested without a live message queue: the poll loop unpacks each
+ *          RAWKEYBOARD / RAWMOUSE record and hands the fields here, and the binding pass reads the result through the
+ *          same KeyStateCache probe the polling backend feeds from GetAsyncKeyState. Not installed.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class RawKeyState
+     * @brief Down-state per virtual key (0..255), updated from raw input events.
+     * @details Mirrors what GetAsyncKeyState would report. A raw keyboard event carries the generic VK for Shift,
+     *          Ctrl, and Alt, so the side is resolved from the scan code (Shift) or the E0 prefix (Ctrl, Alt), the
+     *          sided key is updated, and the generic key reads as down while either side is. Mouse buttons are mapped
+     *          from the RAWMOUSE button flags, swapping left and right when the user has swapped the buttons, as
+     *          GetAsyncKeyState does.
+     */
+    class RawKeyState
+    {
+    public:
+        // Raw input constants, mirrored so this header stays free of <windows.h>.
+        /// RAWKEYBOARD::Flags bit for a key-up event (RI_KEY_BREAK).
+        static constexpr std::uint16_t KEY_BREAK = 0x0001;
+        /// RAWKEYBOARD::Flags bit for an E0-prefixed scan code (RI_KEY_E0), the right Ctrl and Alt.
+        static constexpr std::uint16_t KEY_E0 = 0x0002;
+        /// RAWKEYBOARD::VKey value of a fake key that belongs to an escape sequence.
+        static constexpr std::uint16_t FAKE_VK = 0x00FF;
+        /// RAWKEYBOARD::MakeCode of the right Shift key.
+        static constexpr std::uint16_t RIGHT_SHIFT_MAKE_CODE = 0x0036;
+
+        /// Clears every key, e.g. before re-seeding from GetAsyncKeyState.
+        void clear() noexcept { m_down.fill(0); }
+
+        /// Sets @p vk's down-state directly; used to seed keys already held when the backend starts.
+        void set(int vk, bool down) noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            if (index < m_down.size())
+            {
+                m_down[index] = down ? 1 : 0;
+            }
+        }
+
+        /// Returns whether @p vk is down. Codes outside 0..255 read as not pressed.
+        [[nodiscard]] bool pressed(int vk) const noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            return index < m_down.size() && m_down[index] != 0;
+        }
+
+        /**
+         * @brief Applies one RAWKEYBOARD record.
+         * @param vk RAWKEYBOARD::VKey.
+         * @param make_code RAWKEYBOARD::MakeCode.
+         * @param flags RAWKEYBOARD::Flags.
+         * @return true when a key changed state; false for auto-repeat and ignored records.
+         */
+        bool apply_keyboard(std::uint16_t vk, std::uint16_t make_code, std::uint16_t flags) noexcept
+        {
+            if (vk == 0 || vk >= FAKE_VK)
+            {
+                return false;
+            }
+            const bool down = (flags & KEY_BREAK) == 0;
+            const bool e0 = (flags & KEY_E0) != 0;
+            switch (vk)
+            {
+            case CODE_SHIFT:
+                return apply_sided(CODE_SHIFT, make_code == RIGHT_SHIFT_MAKE_CODE ? CODE_RSHIFT : CODE_LSHIFT, down);
+            case CODE_CONTROL:
+                return apply_sided(CODE_CONTROL, e0 ? CODE_RCONTROL : CODE_LCONTROL, down);
+            case CODE_MENU:
+                return apply_sided(CODE_MENU, e0 ? CODE_RMENU : CODE_LMENU, down);
+            default:
+                return store(vk, down);
+            }
+        }
+
+        /**
+         * @brief Applies one RAWMOUSE::usButtonFlags value. Motion and wheel bits are ignored.
+         * @param button_flags The RI_MOUSE_* button transition bits.
+         * @param swapped Whether the primary and secondary buttons are swapped (SM_SWAPBUTTON).
+         * @return true when a button ended the record in a different state; false for motion-only records.
+         */
+        bool apply_mouse(std::uint16_t button_flags, bool swapped) noexcept
+        {
+            const int primary = swapped ? CODE_RBUTTON : CODE_LBUTTON;
+            const int secondary = swapped ? CODE_LBUTTON : CODE_RBUTTON;
+            // Each button owns a down bit and the up bit above it (RI_MOUSE_BUTTON_1_DOWN = 0x0001 .. _5_UP = 0x0200).
+            const int buttons[] = {primary, secondary, CODE_MBUTTON, CODE_XBUTTON1, CODE_XBUTTON2};
+            bool changed = false;
+            for (std::size_t i = 0; i < std::size(buttons); ++i)
+            {
+                const auto down_bit = static_cast<std::uint16_t>(1u << (2 * i));
+                const auto up_bit = static_cast<std::uint16_t>(1u << (2 * i + 1));
+                // A down and an up in one record is a click shorter than the event; it ends released.
+                if ((button_flags & up_bit) != 0)
+                {
+                    changed |= store(buttons[i], false);
+                }
+                else if ((button_flags & down_bit) != 0)
+                {
+                    changed |= store(buttons[i], true);
+                }
+            }
+            return changed;
+        }
+
+    private:
+        // Windows virtual-key codes used above (winuser.h values).
+        static constexpr int CODE_LBUTTON = 0x01;
+        static constexpr int CODE_RBUTTON = 0x02;
+        static constexpr int CODE_MBUTTON = 0x04;
+        static constexpr int CODE_XBUTTON1 = 0x05;
+        static constexpr int CODE_XBUTTON2 = 0x06;
+        static constexpr int CODE_SHIFT = 0x10;
+        static constexpr int CODE_CONTROL = 0x11;
+        static constexpr int CODE_MENU = 0x12;
+        static constexpr int CODE_LSHIFT = 0xA0;
+        static constexpr int CODE_RSHIFT = 0xA1;
+        static constexpr int CODE_LCONTROL = 0xA2;
+        static constexpr int CODE_RCONTROL = 0xA3;
+        static constexpr int CODE_LMENU = 0xA4;
+        static constexpr int CODE_RMENU = 0xA5;
+
+        /// Sets @p vk (in range by construction) and reports whether that changed it.
+        bool store(int vk, bool down) noexcept
+        {
+            std::uint8_t &slot = m_down[static_cast<std::size_t>(vk)];
+            const std::uint8_t next = down ? 1 : 0;
+            const bool changed = slot != next;
+            slot = next;
+            return changed;
+        }
+
+        bool apply_sided(int generic, int sided, bool down) noexcept
+        {
+            const bool changed = store(sided, down);
+            // The sided codes come in left/right pairs starting at an even code.
+            const int left = sided & ~1;
+            (void)store(generic, pressed(left) || pressed(left + 1));
+            return changed;
+        }
+
+        std::array<std::uint8_t, 256> m_down{};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_RAW_KEYS_HPP
@@ -0,0 +1,98 @@
+#ifndef DETOURMODKIT_INTERNAL_INPUT_REPLAY_HPP
+#define DETOURMODKIT_INTERNAL_INPUT_REPLAY_HPP
+
+/**
+ * @file input_replay.hpp
+ * @brief Internal recorded-input replay for driving InputPoller without a live keyboard.
+ * @details Test and benchmark harness. A ReplayKeyState is installed as the poller's key-state probe
+ *          (InputPoller::set_key_state_probe), so the poll thread reads its keyboard and mouse state from here instead
+ *          of GetAsyncKeyState; play() then applies a recorded timeline to it on the calling thread. Windows-agnostic
+ *          so the harness itself is unit-testable. Not installed.
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <thread>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class ReplayKeyState
+     * @brief Virtual-key down-state (0..255) set by a harness thread and read by the poll thread.
+     */
+    class ReplayKeyState
+    {
+    public:
+        /// Sets @p vk's down-state. Codes outside 0..255 are ignored.
+        void set(int vk, bool down) noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            if (index >= WORDS * 64)
+            {
+                return;
+            }
+            const std::uint64_t bit = std::uint64_t{1} << (index % 64);
+            if (down)
+            {
+                m_words[index / 64].fetch_or(bit, std::memory_order_release);
+            }
+            else
+            {
+                m_words[index / 64].fetch_and(~bit, std::memory_order_release);
+            }
+        }
+
+        /// Returns whether @p vk is down. Codes outside 0..255 read as not pressed.
+        [[nodiscard]] bool pressed(int vk) const noexcept
+        {
+            const auto index = static_cast<unsigned>(vk);
+            return index < WORDS * 64 &&
+                   (m_words[index / 64].load(std::memory_order_acquire) & (std::uint64_t{1} << (index % 64))) != 0;
+        }
+
+        /// Probe thunk for InputPoller::set_key_state_probe; @p context is the ReplayKeyState.
+        static bool probe(void *context, int vk) noexcept
+        {
+            return static_cast<const ReplayKeyState *>(context)->pressed(vk);
+        }
+
+    private:
+        static constexpr std::size_t WORDS = 4;
+        std::array<std::atomic<std::uint64_t>, WORDS> m_words{};
+    };
+
+    /**
+     * @struct ReplayEvent
+     * @brief One recorded key transition, @ref offset after the start of the recording.
+     */
+    struct ReplayEvent
+    {
+        std::chrono::microseconds offset{0};
+        int vk = 0;
+        bool down = false;
+    };
+
+    /**
+     * @brief Applies @p events to @p keys at their recorded offsets from @p start, in order, on the calling thread.
+     * @param on_applied Invoked as `on_applied(index, event)` right after each event is applied, e.g. to timestamp it.
+     * @details Sleeps until each offset, so an event is applied no earlier than recorded and late by the sleep's
+     *          granularity; a harness measuring latency timestamps in @p on_applied rather than trusting the offset.
+     */
+    template <typename OnApplied>
+    void play(std::span<const ReplayEvent> events, ReplayKeyState &keys, std::chrono::steady_clock::time_point start,
+              OnApplied &&on_applied)
+    {
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            std::this_thread::sleep_until(start + events[i].offset);
+            keys.set(events[i].vk, events[i].down);
+            on_applied(i, events[i]);
+        }
+    }
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_INPUT_REPLAY_HPP
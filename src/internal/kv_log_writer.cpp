@@ -0,0 +1,161 @@
+#include "internal/kv_log_writer.hpp"
+
+#include "DetourModKit/log_kv.hpp"
+
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit::detail
+{
+    namespace
+    {
+        void put_varint(std::string &out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out += static_cast<char>((value & 0x7F) | 0x80);
+                value >>= 7;
+            }
+            out += static_cast<char>(value);
+        }
+
+        void put_text(std::string &out, std::string_view text)
+        {
+            put_varint(out, text.size());
+            out += text;
+        }
+
+        template <typename T> void put_raw(std::string &out, const T &value)
+        {
+            out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+        }
+
+        [[nodiscard]] std::uint64_t zigzag(std::int64_t value) noexcept
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+        }
+
+        [[nodiscard]] std::string_view basename(std::string_view path) noexcept
+        {
+            const auto slash = path.find_last_of("/\\");
+            return slash == std::string_view::npos ? path : path.substr(slash + 1);
+        }
+    } // anonymous namespace
+
+    KvLogWriter::KvLogWriter(std::ostream &stream) : m_stream(stream)
+    {
+        std::array<char, log_kv::KV_FILE_HEADER_SIZE> header{};
+        std::memcpy(header.data(), &log_kv::KV_MAGIC, sizeof(log_kv::KV_MAGIC));
+        std::memcpy(header.data() + sizeof(log_kv::KV_MAGIC), &log_kv::KV_VERSION, sizeof(log_kv::KV_VERSION));
+        m_stream.write(header.data(), static_cast<std::streamsize>(header.size()));
+    }
+
+    bool KvLogWriter::write(LogLevel level, std::chrono::system_clock::time_point when,
+                            std::span<const std::byte> record) noexcept
+    {
+        KvLogHeader header;
+        if (record.size() < sizeof(header))
+        {
+            return false;
+        }
+        std::memcpy(&header, record.data(), sizeof(header));
+        if (header.field_count > KV_LOG_MAX_FIELDS ||
+            record.size() != sizeof(header) + header.field_count * sizeof(KvLogField))
+        {
+            return false;
+        }
+        std::array<KvLogField, KV_LOG_MAX_FIELDS> fields;
+        std::memcpy(fields.data(), record.data() + sizeof(header), header.field_count * sizeof(KvLogField));
+
+        try
+        {
+            m_key.clear();
+            put_raw(m_key, header.text.format);
+            put_raw(m_key, header.text.file);
+            put_raw(m_key, header.text.line);
+            for (std::uint32_t i = 0; i < header.field_count; ++i)
+            {
+                put_raw(m_key, fields[i].name);
+                put_raw(m_key, fields[i].type);
+            }
+
+            m_record.clear();
+            auto schema = m_schemas.find(m_key);
+            const bool new_schema = schema == m_schemas.end();
+            const std::uint32_t number =
+                new_schema ? static_cast<std::uint32_t>(m_schemas.size()) : schema->second.number;
+            // A schema's first event is encoded against all-zero previous values.
+            const std::uint64_t *previous = new_schema ? nullptr : schema->second.last_values.data();
+            if (new_schema)
+            {
+                m_payload.clear();
+                put_varint(m_payload, number);
+                put_text(m_payload, std::string_view(header.text.format, header.text.format_size));
+                put_text(m_payload, basename(header.text.file));
+                put_varint(m_payload, header.text.line);
+                put_varint(m_payload, header.field_count);
+                for (std::uint32_t i = 0; i < header.field_count; ++i)
+                {
+                    m_payload += static_cast<char>(fields[i].type);
+                    put_text(m_payload, fields[i].name);
+                }
+                m_record += static_cast<char>(log_kv::KV_RECORD_SCHEMA);
+                put_varint(m_record, m_payload.size());
+                m_record += m_payload;
+            }
+
+            const auto time_us = static_cast<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count());
+            m_payload.clear();
+            put_varint(m_payload, number);
+            m_payload += static_cast<char>(level);
+            put_varint(m_payload, zigzag(time_us - m_last_time_us));
+            for (std::uint32_t i = 0; i < header.field_count; ++i)
+            {
+                const std::uint64_t bits = fields[i].bits;
+                switch (fields[i].type)
+                {
+                case KvType::Bool:
+                    m_payload += static_cast<char>(bits != 0);
+                    break;
+                case KvType::Int:
+                case KvType::UInt:
+                case KvType::Pointer:
+                    // Successive values of one field (a base address, a counter) are usually close, so their
+                    // difference is a byte or two where the value itself is up to ten.
+                    put_varint(m_payload, zigzag(static_cast<std::int64_t>(bits - (previous ? previous[i] : 0))));
+                    break;
+                case KvType::Float32:
+                    put_raw(m_payload, static_cast<std::uint32_t>(bits));
+                    break;
+                case KvType::Float64:
+                    put_raw(m_payload, bits);
+                    break;
+                }
+            }
+            m_record += static_cast<char>(log_kv::KV_RECORD_EVENT);
+            put_varint(m_record, m_payload.size());
+            m_record += m_payload;
+            // Interned only once nothing else can throw, so a schema in the table has always been written.
+            if (new_schema)
+            {
+                schema = m_schemas.emplace(m_key, Schema{number, std::vector<std::uint64_t>(header.field_count)}).first;
+            }
+            for (std::uint32_t i = 0; i < header.field_count; ++i)
+            {
+                schema->second.last_values[i] = fields[i].bits;
+            }
+            m_last_time_us = time_us;
+
+            m_stream.write(m_record.data(), static_cast<std::streamsize>(m_record.size()));
+            return true;
+        }
+        catch (...)
+        {
+            // Out of memory growing a scratch buffer or the schema table: drop this record.
+            return false;
+        }
+    }
+} // namespace DetourModKit::detail
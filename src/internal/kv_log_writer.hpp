@@ -0,0 +1,70 @@
+#ifndef DETOURMODKIT_INTERNAL_KV_LOG_WRITER_HPP
+#define DETOURMODKIT_INTERNAL_KV_LOG_WRITER_HPP
+
+/**
+ * @file internal/kv_log_writer.hpp
+ * @brief The writer side of the structured log: encodes log_kv() records into the format of DetourModKit/log_kv.hpp.
+ */
+
+#include "DetourModKit/logger.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class KvLogWriter
+     * @brief Interns schemas and appends encoded events to one structured log stream.
+     * @details Owned by the async writer and called only under its log mutex. A record's schema is identified by the
+     *          addresses of its event id, file name and field names (all string literals, so one call site always
+     *          presents the same ones) plus the line and field types; the first record of a schema writes the schema
+     *          record ahead of it. Integer and pointer fields are written as differences from the schema's previous
+     *          event.
+     */
+    class KvLogWriter
+    {
+    public:
+        /// Writes the file header to @p stream, which must be empty and binary-safe.
+        explicit KvLogWriter(std::ostream &stream);
+
+        KvLogWriter(const KvLogWriter &) = delete;
+        KvLogWriter &operator=(const KvLogWriter &) = delete;
+
+        /**
+         * @brief Encodes @p record (a KvLogHeader and its fields, as packed by Logger::log_kv) and writes it.
+         * @return false when the record is malformed or could not be buffered (the record is dropped); the stream's
+         *         own state reports write failures.
+         */
+        bool write(LogLevel level, std::chrono::system_clock::time_point when,
+                   std::span<const std::byte> record) noexcept;
+
+        /// Schemas written so far.
+        [[nodiscard]] std::size_t schema_count() const noexcept { return m_schemas.size(); }
+
+    private:
+        struct Schema
+        {
+            std::uint32_t number;
+            // The schema's previous event, which the next one's integer fields are encoded against.
+            std::vector<std::uint64_t> last_values;
+        };
+
+        std::ostream &m_stream;
+        // Identity key (see @details) to schema.
+        std::unordered_map<std::string, Schema> m_schemas;
+        // Scratch buffers kept across records so a steady state allocates nothing.
+        std::string m_key;
+        std::string m_payload;
+        std::string m_record;
+        std::int64_t m_last_time_us{0};
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_KV_LOG_WRITER_HPP
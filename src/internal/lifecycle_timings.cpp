@@ -0,0 +1,167 @@
+/**
+ * @file internal/lifecycle_timings.cpp
+ * @brief Storage for the session's lifecycle phase timings.
+ * @details The state is built once in static storage and never destroyed: a teardown can run from a static
+ *          destructor or under the loader lock after static destruction began, and it must still find the mutex it
+ *          records under.
+ */
+
+#include "internal/lifecycle_timings.hpp"
+
+#include <array>
+#include <atomic>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <new>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+            struct FixedPhase
+            {
+                const char *name = nullptr;
+                std::chrono::microseconds elapsed{0};
+            };
+
+            struct FixedPhaseList
+            {
+                std::array<FixedPhase, LIFECYCLE_MAX_PHASES> phases{};
+                std::size_t count = 0;
+            };
+
+            struct LifecycleState
+            {
+                std::mutex mutex;
+                std::array<FixedPhaseList, static_cast<std::size_t>(LifecyclePhaseList::Count)> lists{};
+                std::chrono::microseconds on_ready{0};
+                std::vector<diagnostics::PhaseTiming> startup_stages;
+                std::chrono::microseconds shutdown_latency{0};
+                // steady_clock ticks of the pending shutdown request; 0 when none is pending.
+                std::atomic<std::int64_t> shutdown_requested{0};
+            };
+
+            alignas(LifecycleState) unsigned char s_lifecycle_storage[sizeof(LifecycleState)];
+
+            /// Constructed on first use in static storage and never destroyed; see the file comment.
+            LifecycleState &lifecycle_state() noexcept
+            {
+                static LifecycleState *const state =
+                    ::new (static_cast<void *>(s_lifecycle_storage)) LifecycleState();
+                return *state;
+            }
+
+            FixedPhaseList &list_of(LifecycleState &state, LifecyclePhaseList list) noexcept
+            {
+                return state.lists[static_cast<std::size_t>(list)];
+            }
+
+            void copy_list(const FixedPhaseList &from, std::vector<diagnostics::PhaseTiming> &to)
+            {
+                to.clear();
+                to.reserve(from.count);
+                for (std::size_t i = 0; i < from.count; ++i)
+                {
+                    to.push_back(diagnostics::PhaseTiming{from.phases[i].name, from.phases[i].elapsed});
+                }
+            }
+
+            double to_ms(std::chrono::microseconds us) noexcept
+            {
+                return static_cast<double>(us.count()) / 1000.0;
+            }
+        } // namespace
+
+        void begin_lifecycle_phases(LifecyclePhaseList list) noexcept
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::lock_guard lock(state.mutex);
+            list_of(state, list).count = 0;
+        }
+
+        void record_lifecycle_phase(LifecyclePhaseList list, const char *name,
+                                    std::chrono::microseconds elapsed) noexcept
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::lock_guard lock(state.mutex);
+            FixedPhaseList &phases = list_of(state, list);
+            if (phases.count < phases.phases.size())
+            {
+                phases.phases[phases.count++] = FixedPhase{name, elapsed};
+            }
+        }
+
+        void record_on_ready_time(std::chrono::microseconds elapsed) noexcept
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::lock_guard lock(state.mutex);
+            state.on_ready = elapsed;
+        }
+
+        void record_startup_stages(std::vector<diagnostics::PhaseTiming> stages) noexcept
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::lock_guard lock(state.mutex);
+            // Swapped rather than assigned so nothing here can throw; the old list dies with the parameter, after the
+            // lock is released.
+            state.startup_stages.swap(stages);
+        }
+
+        void mark_shutdown_requested() noexcept
+        {
+            std::int64_t none = 0;
+            const std::int64_t now = std::chrono::steady_clock::now().time_since_epoch().count();
+            (void)lifecycle_state().shutdown_requested.compare_exchange_strong(none, now == 0 ? 1 : now,
+                                                                               std::memory_order_relaxed);
+        }
+
+        void finish_shutdown_timing() noexcept
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::int64_t requested = state.shutdown_requested.exchange(0, std::memory_order_relaxed);
+            const std::lock_guard lock(state.mutex);
+            if (requested == 0)
+            {
+                state.shutdown_latency = std::chrono::microseconds{0};
+                return;
+            }
+            const std::chrono::steady_clock::time_point from{std::chrono::steady_clock::duration{requested}};
+            state.shutdown_latency =
+                std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - from);
+        }
+
+        void collect_lifecycle_timings(diagnostics::LifecycleTimings &out)
+        {
+            LifecycleState &state = lifecycle_state();
+            const std::lock_guard lock(state.mutex);
+            copy_list(list_of(state, LifecyclePhaseList::Start), out.start);
+            out.on_ready = state.on_ready;
+            out.startup_stages = state.startup_stages;
+            copy_list(list_of(state, LifecyclePhaseList::Teardown), out.teardown);
+            out.shutdown_latency = state.shutdown_latency;
+            copy_list(list_of(state, LifecyclePhaseList::Unload), out.unload);
+        }
+
+        std::string describe_lifecycle_phases(LifecyclePhaseList list)
+        {
+            FixedPhaseList phases;
+            {
+                LifecycleState &state = lifecycle_state();
+                const std::lock_guard lock(state.mutex);
+                phases = list_of(state, list);
+            }
+            std::chrono::microseconds total{0};
+            std::string parts;
+            for (std::size_t i = 0; i < phases.count; ++i)
+            {
+                total += phases.phases[i].elapsed;
+                std::format_to(std::back_inserter(parts), "{}{} {:.1f} ms", i == 0 ? "" : ", ", phases.phases[i].name,
+                               to_ms(phases.phases[i].elapsed));
+            }
+            return std::format("{:.1f} ms ({})", to_ms(total), parts);
+        }
+    } // namespace detail
+} // namespace DetourModKit
@@ -0,0 +1,86 @@
+#ifndef DETOURMODKIT_INTERNAL_LIFECYCLE_TIMINGS_HPP
+#define DETOURMODKIT_INTERNAL_LIFECYCLE_TIMINGS_HPP
+
+/**
+ * @file internal/lifecycle_timings.hpp
+ * @brief True-private recorder behind diagnostics::LifecycleTimings: per-phase wall-clock time of the session's start,
+ *        startup, teardown and Logic DLL unload.
+ * @details The session TUs time each phase and record it here; diagnostics::collect copies the latest of each list
+ *          out. The fixed lists hold static phase names in fixed storage, so recording one from a teardown or
+ *          DllMain path never allocates. Only the startup-stage list, whose names belong to the caller, is a vector,
+ *          and it is handed over whole from run_startup_pipeline.
+ */
+
+#include "DetourModKit/diagnostics.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// The fixed-name phase lists a lifecycle transition records into.
+        enum class LifecyclePhaseList : std::uint8_t
+        {
+            Start,
+            Teardown,
+            Unload,
+            Count
+        };
+
+        /// Phases one fixed list keeps; a phase recorded past this is dropped.
+        inline constexpr std::size_t LIFECYCLE_MAX_PHASES = 16;
+
+        /// Empties @p list at the start of a new run of its transition.
+        void begin_lifecycle_phases(LifecyclePhaseList list) noexcept;
+
+        /// Appends phase @p name (a static string) taking @p elapsed to @p list.
+        void record_lifecycle_phase(LifecyclePhaseList list, const char *name,
+                                    std::chrono::microseconds elapsed) noexcept;
+
+        /// Runs @p fn and records how long it took as phase @p name of @p list.
+        template <typename Fn>
+        void time_lifecycle_phase(LifecyclePhaseList list, const char *name, Fn &&fn) noexcept
+        {
+            const auto start = std::chrono::steady_clock::now();
+            std::forward<Fn>(fn)();
+            record_lifecycle_phase(list, name,
+                                   std::chrono::duration_cast<std::chrono::microseconds>(
+                                       std::chrono::steady_clock::now() - start));
+        }
+
+        /// Records the bootstrap worker's on_ready call.
+        void record_on_ready_time(std::chrono::microseconds elapsed) noexcept;
+
+        /// Replaces the startup-stage list with @p stages, the stages of the run_startup_pipeline call that just ended.
+        void record_startup_stages(std::vector<diagnostics::PhaseTiming> stages) noexcept;
+
+        /**
+         * @brief Stamps the moment a shutdown was requested; only the first request after a teardown counts.
+         * @details Callback-safe: one atomic compare-exchange, so request_shutdown() can call it from any thread.
+         */
+        void mark_shutdown_requested() noexcept;
+
+        /// Ends a teardown: turns the pending shutdown stamp, if any, into the shutdown latency and clears it.
+        void finish_shutdown_timing() noexcept;
+
+        /**
+         * @brief Copies every list into @p out.
+         * @throws std::bad_alloc if the copies cannot be allocated.
+         */
+        void collect_lifecycle_timings(diagnostics::LifecycleTimings &out);
+
+        /**
+         * @brief Formats @p list as "<total> ms (<phase> <ms> ms, ...)" for a summary log line.
+         * @throws std::bad_alloc if the string cannot be allocated.
+         */
+        [[nodiscard]] std::string describe_lifecycle_phases(LifecyclePhaseList list);
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_LIFECYCLE_TIMINGS_HPP
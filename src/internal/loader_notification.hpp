@@ -0,0 +1,53 @@
+#ifndef DETOURMODKIT_INTERNAL_LOADER_NOTIFICATION_HPP
+#define DETOURMODKIT_INTERNAL_LOADER_NOTIFICATION_HPP
+
+/**
+ * @file internal/loader_notification.hpp
+ * @brief True-private declarations of ntdll's loader DLL notification interface (LdrRegisterDllNotification).
+ * @details Never installed. The Windows SDK ships no header for it, so the subset the loaded-module table and the
+ *          deferred-resolution registry use is spelled out once here. The loaded and unloaded payloads share this
+ *          layout. A notification callback runs under the loader lock and must not call back into the loader.
+ */
+
+#include <windows.h>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        struct LoaderUnicodeString
+        {
+            /// In bytes, not characters; the buffer is not guaranteed to be NUL-terminated.
+            USHORT length;
+            USHORT maximum_length;
+            PWSTR buffer;
+        };
+
+        struct LoaderDllNotificationData
+        {
+            ULONG flags;
+            const LoaderUnicodeString *full_dll_name;
+            const LoaderUnicodeString *base_dll_name;
+            PVOID dll_base;
+            ULONG size_of_image;
+        };
+
+        inline constexpr ULONG LDR_DLL_NOTIFICATION_REASON_LOADED = 1;
+        inline constexpr ULONG LDR_DLL_NOTIFICATION_REASON_UNLOADED = 2;
+
+        using LdrDllNotificationFunction = VOID(CALLBACK *)(ULONG reason, const LoaderDllNotificationData *data,
+                                                            PVOID context);
+        using LdrRegisterDllNotificationFunction = LONG(NTAPI *)(ULONG flags, LdrDllNotificationFunction callback,
+                                                                 PVOID context, PVOID *cookie);
+        using LdrUnregisterDllNotificationFunction = LONG(NTAPI *)(PVOID cookie);
+
+        /// Looks up an ntdll export by name; nullptr when ntdll or the export is missing.
+        [[nodiscard]] inline void *ntdll_export(const char *name) noexcept
+        {
+            const HMODULE ntdll = ::GetModuleHandleW(L"ntdll.dll");
+            return ntdll != nullptr ? reinterpret_cast<void *>(::GetProcAddress(ntdll, name)) : nullptr;
+        }
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_LOADER_NOTIFICATION_HPP
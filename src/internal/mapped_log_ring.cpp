@@ -0,0 +1,137 @@
+#include "internal/mapped_log_ring.hpp"
+
+#include "DetourModKit/log_ring.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <system_error>
+
+namespace DetourModKit::detail
+{
+    namespace
+    {
+        namespace ring = DetourModKit::log_ring;
+
+        template <typename T> void store(std::byte *at, T value) noexcept
+        {
+            std::memcpy(at, &value, sizeof(value));
+        }
+
+        // The sequence words are 8-byte aligned (the view is page aligned and every offset is a multiple of 8), so
+        // another thread, or the decoder reading the file, sees each as one store.
+        [[nodiscard]] std::atomic_ref<std::uint64_t> word_at(std::byte *at) noexcept
+        {
+            return std::atomic_ref<std::uint64_t>(*reinterpret_cast<std::uint64_t *>(at));
+        }
+    } // anonymous namespace
+
+    std::unique_ptr<MappedLogRing> MappedLogRing::open(const std::string &path, size_t size) noexcept
+    {
+        const std::uint64_t slot_count = size > ring::RING_HEADER_SIZE
+                                             ? (size - ring::RING_HEADER_SIZE) / ring::RING_SLOT_SIZE
+                                             : 0;
+        if (slot_count == 0)
+        {
+            return nullptr;
+        }
+        const std::uint64_t file_size = ring::RING_HEADER_SIZE + slot_count * ring::RING_SLOT_SIZE;
+
+        HANDLE file = INVALID_HANDLE_VALUE;
+        try
+        {
+            const std::filesystem::path ring_path{std::u8string{path.begin(), path.end()}};
+            std::error_code ec;
+            if (std::filesystem::exists(ring_path, ec))
+            {
+                std::filesystem::path previous = ring_path;
+                previous += ".prev";
+                // Best effort: a ring that cannot be moved aside is overwritten rather than failing the logger.
+                std::filesystem::rename(ring_path, previous, ec);
+            }
+            // Other processes may read the ring while it is live; the decoder opens it with plain read access.
+            file = CreateFileW(ring_path.c_str(), GENERIC_READ | GENERIC_WRITE,
+                               FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS,
+                               FILE_ATTRIBUTE_NORMAL, nullptr);
+        }
+        catch (...)
+        {
+            file = INVALID_HANDLE_VALUE;
+        }
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return nullptr;
+        }
+
+        // Sizing the mapping past the new, empty file extends it with zero bytes: every slot starts unwritten.
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(file_size >> 32),
+                                            static_cast<DWORD>(file_size & 0xFFFFFFFFULL), nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+        auto *view = static_cast<std::byte *>(MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0));
+        if (view == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        store(view + ring::HEADER_VERSION_OFFSET, ring::RING_VERSION);
+        store(view + ring::HEADER_SLOT_SIZE_OFFSET, static_cast<std::uint32_t>(ring::RING_SLOT_SIZE));
+        store(view + ring::HEADER_SLOT_COUNT_OFFSET, slot_count);
+        // The magic goes in last, so a reader never takes a half-written header for a ring.
+        word_at(view + ring::HEADER_MAGIC_OFFSET).store(ring::RING_MAGIC, std::memory_order_release);
+
+        MappedLogRing *created = new (std::nothrow) MappedLogRing(file, mapping, view, slot_count);
+        if (created == nullptr)
+        {
+            UnmapViewOfFile(view);
+            CloseHandle(mapping);
+            CloseHandle(file);
+        }
+        return std::unique_ptr<MappedLogRing>(created);
+    }
+
+    MappedLogRing::~MappedLogRing() noexcept
+    {
+        // Unmapping does not discard anything: the dirty pages belong to the file and are written back by the OS.
+        UnmapViewOfFile(m_view);
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+        CloseHandle(static_cast<HANDLE>(m_file));
+    }
+
+    void MappedLogRing::append(LogLevel level, std::chrono::system_clock::time_point when,
+                               std::string_view text) noexcept
+    {
+        const std::uint64_t sequence =
+            word_at(m_view + ring::HEADER_SEQUENCE_OFFSET).fetch_add(1, std::memory_order_relaxed) + 1;
+        std::byte *slot = m_view + ring::RING_HEADER_SIZE + ((sequence - 1) % m_slot_count) * ring::RING_SLOT_SIZE;
+
+        // Retire the slot's old line before touching its body, so a reader never pairs the old sequence with a
+        // partly copied new line.
+        std::atomic_ref<std::uint64_t> sequence_word = word_at(slot + ring::SLOT_SEQUENCE_OFFSET);
+        sequence_word.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const size_t length = std::min(text.size(), ring::RING_SLOT_TEXT_SIZE);
+        const auto time_us = static_cast<std::int64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count());
+        store(slot + ring::SLOT_TIME_OFFSET, time_us);
+        store(slot + ring::SLOT_LENGTH_OFFSET, static_cast<std::uint16_t>(length));
+        store(slot + ring::SLOT_LEVEL_OFFSET, static_cast<std::uint8_t>(level));
+        store(slot + ring::SLOT_FLAGS_OFFSET,
+              static_cast<std::uint8_t>(length < text.size() ? ring::RING_FLAG_TRUNCATED : 0));
+        std::memcpy(slot + ring::RING_SLOT_HEADER_SIZE, text.data(), length);
+        store(slot + ring::SLOT_CHECKSUM_OFFSET,
+              ring::slot_checksum(std::span<const std::byte, ring::RING_SLOT_SIZE>{slot, ring::RING_SLOT_SIZE}));
+
+        sequence_word.store(sequence, std::memory_order_release);
+    }
+} // namespace DetourModKit::detail
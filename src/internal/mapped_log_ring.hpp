@@ -0,0 +1,65 @@
+#ifndef DETOURMODKIT_INTERNAL_MAPPED_LOG_RING_HPP
+#define DETOURMODKIT_INTERNAL_MAPPED_LOG_RING_HPP
+
+/**
+ * @file internal/mapped_log_ring.hpp
+ * @brief The writer side of the crash ring: a memory-mapped file filled by the async logger's producers.
+ * @details The on-disk layout and the decoder are public (DetourModKit/log_ring.hpp); this is the one writer of it.
+ */
+
+#include "DetourModKit/logger.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace DetourModKit::detail
+{
+    /**
+     * @class MappedLogRing
+     * @brief A crash ring file mapped for the life of an AsyncLogger.
+     * @details append() is lock-free and makes no system call: one fetch_add on the header's sequence counter claims
+     *          a slot, the slot's sequence word is cleared, the line is copied in with its checksum, and the sequence
+     *          is stored last with release order. Any number of threads may append at once.
+     */
+    class MappedLogRing
+    {
+    public:
+        /**
+         * @brief Creates a fresh ring of about @p size bytes at the UTF-8 path @p path and maps it.
+         * @details An existing file at @p path (the previous session's ring, possibly from a crash) is first renamed
+         *          to `<path>.prev`, replacing an older one, so starting the logger again does not overwrite the
+         *          evidence. The size is rounded down to whole slots.
+         * @return nullptr when the file cannot be created or mapped.
+         */
+        [[nodiscard]] static std::unique_ptr<MappedLogRing> open(const std::string &path, size_t size) noexcept;
+
+        ~MappedLogRing() noexcept;
+
+        MappedLogRing(const MappedLogRing &) = delete;
+        MappedLogRing &operator=(const MappedLogRing &) = delete;
+        MappedLogRing(MappedLogRing &&) = delete;
+        MappedLogRing &operator=(MappedLogRing &&) = delete;
+
+        /// Copies one line into the next slot; a line past log_ring::RING_SLOT_TEXT_SIZE bytes is cut and flagged.
+        void append(LogLevel level, std::chrono::system_clock::time_point when, std::string_view text) noexcept;
+
+        [[nodiscard]] std::uint64_t slot_count() const noexcept { return m_slot_count; }
+
+    private:
+        MappedLogRing(void *file, void *mapping, std::byte *view, std::uint64_t slot_count) noexcept
+            : m_file(file), m_mapping(mapping), m_view(view), m_slot_count(slot_count)
+        {
+        }
+
+        void *m_file;
+        void *m_mapping;
+        std::byte *m_view;
+        std::uint64_t m_slot_count;
+    };
+} // namespace DetourModKit::detail
+
+#endif // DETOURMODKIT_INTERNAL_MAPPED_LOG_RING_HPP
@@ -5,9 +5,10 @@
  * All Structured Exception Handling lives here. On MSVC the guarded copies and the chain walk run inside frame-based
  * __try / __except whose filter is the shared detail::is_guarded_read_fault set. MinGW/GCC has no __try, so this file
  * also owns a process-wide vectored exception handler that turns a fault inside an explicitly-armed foreign range into
- * a clean failure via __builtin_longjmp; the public memory surface and the scan engine reach that machinery only
- * through the small seam declared in memory_guarded.hpp and memory_fault.hpp. Confining SEH/VEH to this one translation
- * unit is what keeps the installed memory.hpp free of <windows.h> and structured-exception constructs.
+ * a clean failure via __builtin_longjmp, plus a second, permanent handler that serves small reads through a
+ * fault-landing-pad copy routine with no per-call arming; the public memory surface and the scan engine reach that
+ * machinery only through the small seam declared in memory_guarded.hpp and memory_fault.hpp. Confining SEH/VEH to this
+ * one translation unit is what keeps the installed memory.hpp free of <windows.h> and structured-exception constructs.
  */
 
 #include "internal/memory_guarded.hpp"
@@ -29,6 +30,53 @@
 #include <mutex>
 #include <thread>
 
+#if !defined(_MSC_VER) && defined(_WIN64)
+// The MinGW landing-pad copy: a leaf routine with no stack frame that copies n bytes from src (RDX) to dst (RCX), by
+// qwords and then by bytes, and returns 1. Its two source loads are the only instructions in
+// [dmk_landing_copy_begin, dmk_landing_copy_fault) that touch foreign memory; when one faults, the landing-pad handler
+// resumes the thread at dmk_landing_copy_fault, which returns 0. Throughout the faultable range RDX is the next
+// source byte and R8 the bytes still to copy, so [RDX, RDX + R8) is exactly the range a claimable fault may hit. It
+// uses only volatile registers and never moves RSP, so it needs no unwind data, and being assembly it is invisible to
+// AddressSanitizer for the same reason the rep movsb copies below are.
+__asm__(".text\n"
+        ".p2align 4\n"
+        ".globl dmk_landing_copy\n"
+        ".globl dmk_landing_copy_begin\n"
+        "dmk_landing_copy:\n"
+        "dmk_landing_copy_begin:\n"
+        "    cmpq $8, %r8\n"
+        "    jb 2f\n"
+        "1:  movq (%rdx), %rax\n"
+        "    movq %rax, (%rcx)\n"
+        "    addq $8, %rdx\n"
+        "    addq $8, %rcx\n"
+        "    subq $8, %r8\n"
+        "    cmpq $8, %r8\n"
+        "    jae 1b\n"
+        "2:  testq %r8, %r8\n"
+        "    jz 4f\n"
+        "3:  movzbl (%rdx), %eax\n"
+        "    movb %al, (%rcx)\n"
+        "    incq %rdx\n"
+        "    incq %rcx\n"
+        "    decq %r8\n"
+        "    jnz 3b\n"
+        "4:  movl $1, %eax\n"
+        "    ret\n"
+        ".globl dmk_landing_copy_fault\n"
+        "dmk_landing_copy_fault:\n"
+        "    xorl %eax, %eax\n"
+        "    ret\n");
+
+extern "C"
+{
+    int dmk_landing_copy(void *dst, const void *src, std::size_t n) noexcept;
+    // Code labels, declared as byte arrays so their addresses are constant expressions for the pad table.
+    extern const char dmk_landing_copy_begin[];
+    extern const char dmk_landing_copy_fault[];
+}
+#endif
+
 namespace DetourModKit
 {
     namespace
@@ -361,6 +409,113 @@ namespace DetourModKit
             RemoveVectoredExceptionHandler(handle);
         }
 
+        // Reads up to this size take the landing-pad copy; larger ones keep rep movsb, whose startup cost stops
+        // mattering once the copy itself dominates.
+        constexpr std::size_t LANDING_COPY_MAX_BYTES = 256;
+
+        // One fault landing pad: a fault on an instruction in [begin, end) resumes at landing. Every routine listed
+        // here keeps the cursor/remaining contract of dmk_landing_copy (RDX the next source byte, R8 the bytes left),
+        // so the handler can confine its claim to the source range without any per-call state.
+        struct LandingPad
+        {
+            const char *begin;
+            const char *end;
+            const char *landing;
+        };
+
+        constexpr std::array<LandingPad, 1> LANDING_PADS = {{
+            {dmk_landing_copy_begin, dmk_landing_copy_fault, dmk_landing_copy_fault},
+        }};
+
+        // The landing-pad handler is installed once and stays registered for the life of the module, unlike the
+        // longjmp handler that release_guarded_engine drains and removes. That is what lets the copy skip the
+        // in-flight stripes: no removal can race a copy while the module is loaded. A removal racing the module's own
+        // unload cannot strand a copy either, since a thread still executing the module's code at that point faults on
+        // the unmapped image regardless.
+        std::atomic<void *> s_landing_pad_handle{nullptr};
+        std::atomic<bool> s_landing_pads_retired{false};
+
+        // Claims a fault only when the faulting instruction is inside a listed pad range, the code is a guarded-read
+        // code carrying a faulting address, the access was a read, and the address lies in [RDX, RDX + R8). The thread
+        // is then resumed at the pad's landing with its registers otherwise untouched, so no setjmp snapshot, TLS
+        // record or stack adjustment is involved. Any other fault, including one raised on the copy's destination
+        // store, passes through.
+        LONG NTAPI dmk_landing_pad_handler(PEXCEPTION_POINTERS info) noexcept
+        {
+            CONTEXT *const ctx = info->ContextRecord;
+            const LandingPad *pad = nullptr;
+            for (const LandingPad &candidate : LANDING_PADS)
+            {
+                if (ctx->Rip >= reinterpret_cast<DWORD64>(candidate.begin) &&
+                    ctx->Rip < reinterpret_cast<DWORD64>(candidate.end))
+                {
+                    pad = &candidate;
+                    break;
+                }
+            }
+            if (pad == nullptr)
+                return EXCEPTION_CONTINUE_SEARCH;
+
+            const EXCEPTION_RECORD *const record = info->ExceptionRecord;
+            if (!detail::is_guarded_read_fault(record->ExceptionCode) || record->NumberParameters < 2 ||
+                record->ExceptionInformation[0] != 0)
+                return EXCEPTION_CONTINUE_SEARCH;
+
+            const DWORD64 fault_address = record->ExceptionInformation[1];
+            if (fault_address < ctx->Rdx || fault_address - ctx->Rdx >= ctx->R8)
+                return EXCEPTION_CONTINUE_SEARCH;
+
+            rearm_guard_page_if_consumed(record);
+            ctx->Rip = reinterpret_cast<DWORD64>(pad->landing);
+            return EXCEPTION_CONTINUE_EXECUTION;
+        }
+
+        // Unregisters the landing-pad handler when the module's static objects are destroyed, so a DLL build does not
+        // leave the process's handler list pointing into an unmapped image. Retires the fast path first so a read
+        // issued by a later static destructor takes the longjmp path instead of re-installing. An image linked into
+        // the executable skips the removal: the process is exiting, and other threads may still be mid-copy.
+        struct LandingPadOwner
+        {
+            LandingPadOwner() = default;
+            LandingPadOwner(const LandingPadOwner &) = delete;
+            LandingPadOwner &operator=(const LandingPadOwner &) = delete;
+
+            ~LandingPadOwner() noexcept
+            {
+                std::lock_guard<std::mutex> lock(s_veh_mutex);
+                s_landing_pads_retired.store(true, std::memory_order_release);
+                void *const handle = s_landing_pad_handle.exchange(nullptr, std::memory_order_acq_rel);
+                if (handle == nullptr)
+                    return;
+                HMODULE self = nullptr;
+                if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS |
+                                           GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                                       reinterpret_cast<LPCWSTR>(dmk_landing_copy_begin), &self) &&
+                    self == GetModuleHandleW(nullptr))
+                    return;
+                RemoveVectoredExceptionHandler(handle);
+            }
+        };
+
+        LandingPadOwner s_landing_pad_owner;
+
+        // True once the landing-pad handler is registered, installing it on first use. False after retirement or when
+        // AddVectoredExceptionHandler fails, in which case reads take the longjmp path.
+        [[nodiscard]] bool landing_pads_ready() noexcept
+        {
+            if (s_landing_pad_handle.load(std::memory_order_acquire) != nullptr)
+                return true;
+
+            std::lock_guard<std::mutex> lock(s_veh_mutex);
+            if (s_landing_pad_handle.load(std::memory_order_relaxed) != nullptr)
+                return true;
+            if (s_landing_pads_retired.load(std::memory_order_relaxed))
+                return false;
+            void *const handle = AddVectoredExceptionHandler(1, dmk_landing_pad_handler);
+            s_landing_pad_handle.store(handle, std::memory_order_release);
+            return handle != nullptr;
+        }
+
         // Copy [src, src + len) into out under the vectored handler. The copy is a single rep movsb emitted as raw
         // inline assembly: inline asm is invisible to AddressSanitizer, which instruments only compiler-emitted loads,
         // so this deliberate cross-region read cannot raise an ASan false positive (the same reason the MSVC probe
@@ -426,14 +581,18 @@ namespace DetourModKit
 
         // Single entry point the MinGW read paths share. Rejects a wrapping or low source range first (a wrapped
         // addr + bytes would invert the handler's [guard_lo, guard_hi) check and let a real fault escape the guard).
-        // Counts the read in the drain epoch around the path decision so a read on the guarded path is always visible
-        // to release_guarded_engine's drain. Falls back to a VirtualQuery plus ReadProcessMemory copy when the handler
-        // is unavailable.
+        // A small read takes the landing-pad copy: one call, no setjmp, no TLS publish and no in-flight count. Anything
+        // else counts the read in the drain epoch around the path decision so a read on the longjmp path is always
+        // visible to release_guarded_engine's drain. Falls back to a VirtualQuery plus ReadProcessMemory copy when the
+        // handler is unavailable.
         bool veh_read_bytes(std::uintptr_t addr, void *out, std::size_t bytes) noexcept
         {
             if (addr < memory::USERSPACE_PTR_MIN || addr + bytes < addr)
                 return false;
 
+            if (bytes <= LANDING_COPY_MAX_BYTES && landing_pads_ready())
+                return dmk_landing_copy(out, reinterpret_cast<const void *>(addr), bytes) != 0;
+
             ensure_veh_installed();
 
             const std::size_t stripe = veh_in_flight_stripe_index();
@@ -473,6 +632,44 @@ namespace DetourModKit
             s_veh_in_flight_stripes[stripe].count.fetch_sub(1, std::memory_order_release);
             return ok;
         }
+
+        // Copies the screened reads of a read_many batch from cursor onward under one armed guard, re-pointing the
+        // guard's claim range at each source before its rep movsb so a fault is claimed only inside the read that
+        // raised it. Returns true when every remaining read copied; on a fault the handler longjmps to the setjmp
+        // anchor and this returns false with cursor naming the faulting read, so the caller fails that one and calls
+        // again past it. cursor is the caller's volatile, the only state that must survive the longjmp. noinline for
+        // the same single-frame reason as veh_guarded_copy.
+        __attribute__((noinline)) bool veh_guarded_copy_run(const memory::ReadDescriptor *reads, std::size_t count,
+                                                            const std::uint8_t *screened,
+                                                            volatile std::size_t &cursor) noexcept
+        {
+            const DWORD slot = s_veh_tls_index.load(std::memory_order_acquire);
+            VehAccessGuard guard{};
+
+            if (__builtin_setjmp(guard.env) != 0)
+            {
+                return false;
+            }
+
+            TlsSetValue(slot, &guard);
+            for (std::size_t i = cursor; i < count; ++i)
+            {
+                cursor = i;
+                const std::size_t len = reads[i].destination.size();
+                if (screened[i] == 0 || len == 0)
+                    continue;
+                guard.guard_lo = reads[i].address.raw();
+                guard.guard_hi = guard.guard_lo + len;
+
+                void *dst = reads[i].destination.data();
+                const void *cur = reinterpret_cast<const void *>(guard.guard_lo);
+                std::size_t n = len;
+                __asm__ __volatile__("rep movsb" : "+D"(dst), "+S"(cur), "+c"(n) : : "memory");
+            }
+            TlsSetValue(slot, nullptr);
+            cursor = count;
+            return true;
+        }
 #endif // _WIN64
     } // namespace
 #endif // !_MSC_VER
@@ -559,6 +756,109 @@ namespace DetourModKit
 #endif
     }
 
+#ifdef _MSC_VER
+    namespace
+    {
+        // Copies the screened reads of a read_many batch from start onward inside one __try, stopping at the first
+        // fault. Returns the faulting read's index, or count when every remaining read copied. Holds only trivially
+        // destructible locals, as a __try frame requires, and tracks the in-progress read in a volatile so the
+        // __except path can name it.
+        std::size_t seh_copy_run(const memory::ReadDescriptor *reads, std::size_t start, std::size_t count,
+                                 const std::uint8_t *screened) noexcept
+        {
+            volatile std::size_t current = start;
+            __try
+            {
+                for (std::size_t i = start; i < count; ++i)
+                {
+                    current = i;
+                    const std::size_t len = reads[i].destination.size();
+                    if (screened[i] == 0 || len == 0)
+                        continue;
+#if defined(__SANITIZE_ADDRESS__)
+                    // __movsb for the same ASan reason as guarded_read_bytes.
+                    __movsb(reinterpret_cast<unsigned char *>(reads[i].destination.data()),
+                            reinterpret_cast<const unsigned char *>(reads[i].address.raw()), len);
+#else
+                    std::memcpy(reads[i].destination.data(), reinterpret_cast<const void *>(reads[i].address.raw()),
+                                len);
+#endif
+                }
+                return count;
+            }
+            __except (guarded_fault_filter(GetExceptionInformation()))
+            {
+                return current;
+            }
+        }
+    } // namespace
+#endif
+
+    std::size_t detail::guarded_read_many(const memory::ReadDescriptor *reads, std::size_t count,
+                                          std::uint8_t *ok) noexcept
+    {
+        // Screen every read up front with guarded_read_bytes' rules, so the copy loops below only ever touch a source
+        // that passed them. An empty read is a success that copies nothing.
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uintptr_t address = reads[i].address.raw();
+            const std::size_t bytes = reads[i].destination.size();
+            ok[i] = (bytes == 0 || (reads[i].destination.data() != nullptr && address >= memory::USERSPACE_PTR_MIN &&
+                                    address + bytes >= address))
+                        ? 1
+                        : 0;
+        }
+
+#ifdef _MSC_VER
+        std::size_t next = 0;
+        while (next < count)
+        {
+            const std::size_t faulted = seh_copy_run(reads, next, count, ok);
+            if (faulted == count)
+                break;
+            ok[faulted] = 0;
+            next = faulted + 1;
+        }
+#else
+        ensure_veh_installed();
+
+        // One drain-epoch count for the whole batch, mirroring veh_read_bytes.
+        const std::size_t stripe = veh_in_flight_stripe_index();
+        s_veh_in_flight_stripes[stripe].count.fetch_add(1, std::memory_order_seq_cst);
+        const bool armed = s_veh_handle.load(std::memory_order_seq_cst) != nullptr;
+        if (armed)
+        {
+            volatile std::size_t cursor = 0;
+            while (!veh_guarded_copy_run(reads, count, ok, cursor))
+            {
+                ok[cursor] = 0;
+                cursor = cursor + 1;
+            }
+        }
+        else
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (ok[i] != 0 && !reads[i].destination.empty())
+                {
+                    ok[i] = virtualquery_validated_copy(reads[i].address.raw(), reads[i].destination.data(),
+                                                        reads[i].destination.size())
+                                ? 1
+                                : 0;
+                }
+            }
+        }
+        s_veh_in_flight_stripes[stripe].count.fetch_sub(1, std::memory_order_release);
+#endif
+
+        std::size_t copied = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            copied += ok[i];
+        }
+        return copied;
+    }
+
     bool detail::guarded_write_bytes(std::uintptr_t address, const void *source, std::size_t bytes) noexcept
     {
         if (bytes == 0)
@@ -85,12 +85,56 @@ namespace DetourModKit
          *          region.cpp's Region factories (host / own / module_named) both route through this so a repeated
          *          module-range query degenerates to a loader handle lookup plus a hash hit, instead of re-walking the
          *          PE headers (DOS magic, e_lfanew, NT signature, SizeOfImage) through the guarded engine every call.
-         *          Entries are never invalidated on module unload, so a handle reused after unload can return a stale
-         *          span -- an intentional, fault-contained tradeoff for the transient non-owning Region contract; the
-         *          rationale (and when to resolve fresh instead) is documented on ModuleRangeCache in memory_module.cpp.
+         *          Entries are invalidated on module unload only while @ref install_module_table is in effect, so
+         *          outside it a handle reused after unload can return a stale span -- an intentional, fault-contained
+         *          tradeoff for the transient non-owning Region contract; the rationale (and when to resolve fresh
+         *          instead) is documented on ModuleRangeCache in memory_module.cpp.
          */
         [[nodiscard]] Region cached_module_image_region(Address module_base) noexcept;
 
+        /**
+         * @brief Fills the loaded-module span table and subscribes it to loader load / unload notifications.
+         * @details Once populated, memory::module_of answers from a lock-free binary search instead of a loader call.
+         *          Called by memory::init_cache; idempotent. Best-effort: when ntdll lacks the notification export,
+         *          the enumeration fails, or more modules load than the table holds, module_of keeps the loader path.
+         *          While subscribed, every unload also invalidates the unmapped image's span in the protection cache.
+         * @return True when the loader notification is subscribed (now or by an earlier call), so unloads are seen;
+         *         this holds even when the table itself could not be filled.
+         */
+        [[nodiscard]] bool install_module_table() noexcept;
+
+        /**
+         * @brief Unsubscribes the loaded-module table from loader notifications and empties it.
+         * @details Called on memory-subsystem teardown, so the notification callback cannot dangle into freed code if
+         *          the DMK module unloads. Safe under the loader lock; idempotent.
+         */
+        void release_module_table() noexcept;
+
+        /**
+         * @brief A counter that moves whenever a loaded image may have gone away, for caches of image contents.
+         * @details Bumped by every unload notification and by @ref release_module_table, so a value read while
+         *          subscribed never comes back after an image was unmapped. Callback-safe: two atomic loads.
+         * @return The counter, or std::nullopt while no loader notification is subscribed and an unload would go
+         *         unseen.
+         */
+        [[nodiscard]] std::optional<std::uint64_t> module_unload_epoch() noexcept;
+
+        /**
+         * @brief Publishes an offline::MappedImage copy so memory::module_of resolves addresses inside it.
+         * @param image The copy's extent.
+         * @return False only when the table could not grow (out of memory).
+         * @details The loader knows nothing of a copy laid out in private memory, so module_of falls back to this small
+         *          table when GetModuleHandleExW finds no owning module. Unlike the handle cache it is exact: the copy
+         *          withdraws its entry through @ref unregister_mapped_image before it frees its pages.
+         */
+        [[nodiscard]] bool register_mapped_image(Region image) noexcept;
+
+        /// Withdraws the entry @ref register_mapped_image published for the copy at @p base.
+        void unregister_mapped_image(Address base) noexcept;
+
+        /// The registered copy containing @p address, or an empty Region when none does.
+        [[nodiscard]] Region mapped_image_containing(Address address) noexcept;
+
         /**
          * @brief Guarded copy of @p bytes bytes from @p address into @p out.
          * @param address Source address. Below memory::USERSPACE_PTR_MIN, or an end that wraps the address space, is
@@ -101,6 +145,17 @@ namespace DetourModKit
          */
         [[nodiscard]] bool guarded_read_bytes(std::uintptr_t address, void *out, std::size_t bytes) noexcept;
 
+        /**
+         * @brief Guarded scatter-gather copy behind memory::read_many.
+         * @param reads @p count descriptors, each screened as guarded_read_bytes screens its arguments.
+         * @param ok @p count status bytes, set to 1 for a read that copied and 0 for one that faulted or was rejected.
+         * @return The number of reads that copied.
+         * @details The guard is entered once for the batch and re-entered once past each faulting read, so a bad
+         *          pointer costs one re-entry rather than failing the batch.
+         */
+        [[nodiscard]] std::size_t guarded_read_many(const memory::ReadDescriptor *reads, std::size_t count,
+                                                    std::uint8_t *ok) noexcept;
+
         /**
          * @brief Guarded typed read for engine code: a trivially copyable @p T at @p address, or nullopt on fault.
          * @tparam T A trivially copyable type (read through untyped storage + bit_cast, so it need not be default
@@ -268,6 +323,14 @@ namespace DetourModKit
                                                              std::size_t count, Address *trace,
                                                              std::size_t trace_cap) noexcept;
 
+        /**
+         * @brief The protection cache's invalidation generation, for callers that memoize what a read returned.
+         * @details Changes on every memory::invalidate_range, memory::clear_cache, and cache shutdown while the cache
+         *          is initialized, so memory::CompiledChain re-reads its memoized hops after the caller reported a
+         *          change. Defined in memory_cache.cpp; one acquire load.
+         */
+        [[nodiscard]] std::uint64_t protection_cache_generation() noexcept;
+
 #if !defined(_MSC_VER) && defined(_WIN64)
         /**
          * @brief Eagerly installs the MinGW process-wide vectored fault handler the guarded reads rely on.
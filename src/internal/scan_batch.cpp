@@ -2,13 +2,16 @@
  * @file internal/scan_batch.cpp
  * @brief Raw parallel batch scanners over the whole process or one module image.
  * @details Each item is dispatched to a serial page-gated scan on a worker thread, and results are gathered in input
- *          order by the shared fork-join driver. Correctness rests on read-only sharing: a fully compiled EnginePattern
- *          is immutable during scanning, so workers share the caller's patterns without cloning.
+ *          order by the shared fork-join driver. A module batch of MULTI_SCAN_MIN_PATTERNS or more items instead takes
+ *          the single-pass multi-pattern sweep, which reads the image once for the whole batch. Correctness rests on
+ *          read-only sharing: a fully compiled EnginePattern is immutable during scanning, so workers share the
+ *          caller's patterns without cloning.
  */
 
 #include "internal/scan_batch.hpp"
 
 #include "internal/scan_engine.hpp"
+#include "internal/scan_multi.hpp"
 #include "internal/scan_pages.hpp"
 
 #include "fork_join.hpp"
@@ -50,6 +53,21 @@ namespace DetourModKit
                                                              detail::ModuleSpan range, detail::ScannerKind kind,
                                                              std::size_t max_workers)
     {
+        // A large module batch is swept once for every eligible pattern instead of once per pattern (see
+        // scan_module_multi); the grouped sweep keeps the per-item contract, so each slot resolves exactly as its own
+        // serial module scan would, including the fail-closed mapping of an incomplete sweep to nullptr.
+        if (items.size() >= detail::MULTI_SCAN_MIN_PATTERNS)
+        {
+            const scan::Pages pages =
+                (kind == detail::ScannerKind::Readable) ? scan::Pages::Readable : scan::Pages::Executable;
+            const std::vector<detail::MultiMatchResult> swept = detail::scan_module_multi(items, range, pages, false);
+            std::vector<const std::byte *> results(swept.size(), nullptr);
+            for (std::size_t i = 0; i < swept.size(); ++i)
+            {
+                results[i] = swept[i].incomplete ? nullptr : swept[i].match;
+            }
+            return results;
+        }
         return detail::run_fork_join<detail::BatchScanItem, const std::byte *>(
             items, max_workers,
             [kind, range](const detail::BatchScanItem &item) -> const std::byte *
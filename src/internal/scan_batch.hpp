@@ -68,6 +68,9 @@ namespace DetourModKit
          * @param kind Readable (default) scans every readable page; Executable confines matches to code pages.
          * @param max_workers Upper bound on worker threads (see scan_regions_batch).
          * @return One pointer per input item, in input order (offset-applied match or nullptr).
+         * @details A batch of at least MULTI_SCAN_MIN_PATTERNS items is resolved by the single-pass multi-pattern sweep
+         *          (internal/scan_multi.hpp) on the calling thread, reading the image once instead of once per item;
+         *          @p max_workers then applies only to smaller batches. Results are identical on either path.
          * @note Setup/control-plane only, same constraints as scan_regions_batch.
          */
         [[nodiscard]] std::vector<const std::byte *> scan_module_batch(std::span<const BatchScanItem> items,
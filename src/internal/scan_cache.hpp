@@ -0,0 +1,134 @@
+#ifndef DETOURMODKIT_INTERNAL_SCAN_CACHE_HPP
+#define DETOURMODKIT_INTERNAL_SCAN_CACHE_HPP
+
+/**
+ * @file internal/scan_cache.hpp
+ * @brief True-private resolver seam of the persistent resolution cache: probe before the ladder, record after a win.
+ * @details Never installed. The public ResolutionCache exposes only persistence and counters; the resolver reaches its
+ *          entries through @ref DetourModKit::detail::ResolutionCacheAccess, the class's one friend. The probe does
+ *          the identity and byte re-verification (the parts that need the cache's own state); the resolver then
+ *          re-derives the address through its own Direct / RipRelative decode and gates, so a cached and a scanned
+ *          resolution are accepted by exactly the same code.
+ */
+
+#include "internal/memory_guarded.hpp"
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_cache.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /**
+         * @struct CacheProbe
+         * @brief The outcome of probing a ResolutionCache for one request, carried forward to the record step.
+         * @details @ref identity is empty when the scope is not a readable PE image, in which case nothing is cached
+         *          for the request. @ref candidate_index / @ref match_point are set only when an entry for this
+         *          identity exists (locally or in the shared table) and its pattern still matches at the remembered
+         *          site.
+         */
+        struct CacheProbe
+        {
+            /// The scope module's identity, or empty when it could not be read.
+            std::optional<scan::ModuleIdentity> identity;
+            /// The request's content key (ladder and resolve policy).
+            std::uint64_t key = 0;
+            /// Declared ladder index of the remembered winner, when the entry re-verified.
+            std::optional<std::size_t> candidate_index;
+            /// The remembered match point (offset-applied, absolute), valid with @ref candidate_index.
+            std::uintptr_t match_point = 0;
+            /// The remembered final address (absolute), valid with @ref candidate_index.
+            std::uintptr_t resolved = 0;
+            /// The re-verified entry came from the process-wide shared table rather than this cache's own map.
+            bool shared = false;
+            /// The scope's base, so settle() can turn an adopted shared entry back into image-relative offsets.
+            std::uintptr_t image_base = 0;
+        };
+
+        /// How one tier attempt of a serial ladder walk ended, for the Adaptive order's history.
+        enum class TierVerdict : std::uint8_t
+        {
+            Resolved,
+            Missed,
+            Ambiguous
+        };
+
+        /// One tier attempt: the declared ladder index, its verdict, and the microseconds it took.
+        struct TierOutcome
+        {
+            std::size_t index = 0;
+            TierVerdict verdict = TierVerdict::Missed;
+            std::uint64_t micros = 0;
+        };
+
+        /**
+         * @struct ResolutionCacheAccess
+         * @brief The resolver's privileged view of a ResolutionCache.
+         * @details Every member is noexcept: the cache is an accelerator, so an allocation failure while recording
+         *          or a failed header read degrades to the uncached resolve instead of failing it.
+         */
+        struct ResolutionCacheAccess
+        {
+            /**
+             * @brief Looks @p request up and re-verifies its entry's pattern bytes at the remembered site.
+             * @details A hit requires an entry recorded against the scope's current identity whose candidate is still a
+             *          jump-free byte tier of the ladder, whose site lies in @p range (and on an execute-readable page
+             *          when the request scans Pages::Executable), and whose pattern matches the live bytes there.
+             *          @p count_lookup false leaves the counters untouched, for the batch prescan's look-ahead probe.
+             */
+            [[nodiscard]] static CacheProbe probe(scan::ResolutionCache &cache, const scan::ScanRequest &request,
+                                                  ModuleSpan range, bool count_lookup = true) noexcept;
+
+            /**
+             * @brief Counts a probed entry the resolver accepted (@p accepted) or rejected after re-deriving its
+             *        address.
+             * @details An accepted entry from the shared table is also adopted into the cache's own map, so a later
+             *          lookup and @ref scan::ResolutionCache::save see it.
+             */
+            static void settle(scan::ResolutionCache &cache, const CacheProbe &probe, bool accepted) noexcept;
+
+            /**
+             * @brief Remembers a byte-tier win for @p probe's key, replacing any older entry, and publishes it to the
+             *        shared table when the cache has joined one.
+             * @details Skipped when the probe has no identity or the candidate is not a jump-free byte tier (its match
+             *          start could not be recovered from the offset-applied point on re-verify).
+             */
+            static void record(scan::ResolutionCache &cache, const scan::ScanRequest &request, const CacheProbe &probe,
+                               std::size_t candidate_index, std::uintptr_t match_point, std::uintptr_t resolved,
+                               ModuleSpan range) noexcept;
+
+            /**
+             * @brief Copies @p request's tier history into @p out, one stats slot per declared tier.
+             * @return False, leaving @p out untouched, when the request has no history (or @p out is shorter than
+             *         the ladder), so the caller keeps its static order without having allocated anything.
+             */
+            [[nodiscard]] static bool tier_history(const scan::ResolutionCache &cache, const scan::ScanRequest &request,
+                                                   std::span<scan::TierStats> out) noexcept;
+
+            /// Folds one walk's @p outcomes into @p request's tier history; an allocation failure drops them.
+            static void record_tiers(scan::ResolutionCache &cache, const scan::ScanRequest &request,
+                                     std::span<const TierOutcome> outcomes) noexcept;
+        };
+
+        /**
+         * @brief The session's reload cache while it is enabled (DetourModKit::enable_reload_cache), else nullptr.
+         * @details The resolver falls back to it for a request that carries no cache of its own. Defined in
+         *          session.cpp, which owns the cache.
+         */
+        [[nodiscard]] scan::ResolutionCache *reload_resolution_cache() noexcept;
+
+        /// The cache a resolve of @p request consults: its own, else the reload cache, else nullptr.
+        [[nodiscard]] inline scan::ResolutionCache *request_cache(const scan::ScanRequest &request) noexcept
+        {
+            return request.cache != nullptr ? request.cache : reload_resolution_cache();
+        }
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SCAN_CACHE_HPP
@@ -9,9 +9,13 @@
  */
 
 #include "internal/scan_engine.hpp"
+#include "internal/scan_telemetry.hpp"
 
 #include "DetourModKit/detail/pattern_core.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <new>
@@ -56,20 +60,8 @@
 #define DMK_AVX512_TARGET
 #endif
 
-// AddressSanitizer poisons the shadow of this process's own committed, readable memory -- the redzones around stack
-// locals and instrumented globals. The AOB scanner deliberately reads across whole readable regions, so under ASan its
-// in-bounds, never-faulting reads land on poisoned shadow and are reported as overflows. DMK_NO_SANITIZE_ADDRESS
-// removes the compiler's load instrumentation from such a function, so the read runs exactly as a release build does.
-// It does NOT stop ASan's libc interceptors (memchr/memcpy are hot-patched at runtime); the scanner therefore routes
-// the prefilter through a self-provided dmk_memchr that does its own byte comparisons and never calls into libc. The
-// attribute also covers the verify path's instrumented SIMD/scalar loads. ASan links only under MSVC here (mingw-w64
-// ships no sanitizer runtime), so the attribute is the MSVC __declspec form; the macro is empty in every other build,
-// leaving release codegen unchanged.
-#if defined(_MSC_VER) && defined(__SANITIZE_ADDRESS__)
-#define DMK_NO_SANITIZE_ADDRESS __declspec(no_sanitize_address)
-#else
-#define DMK_NO_SANITIZE_ADDRESS
-#endif
+// DMK_NO_SANITIZE_ADDRESS (defines.hpp) marks every function below that reads scanned memory. The prefilter routes
+// through the self-provided dmk_memchr for the same reason: the attribute cannot stop ASan's libc interceptors.
 
 namespace DetourModKit
 {
@@ -130,6 +122,23 @@ namespace DetourModKit
             return (xcr0 & required_mask) == required_mask;
 #else
             return false;
+#endif
+        }
+
+        /// CPUID leaf 1 EAX (family, model, stepping): the part of the calibration host key that names the processor.
+        std::uint32_t cpu_signature() noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx))
+                return 0;
+            return eax;
+#elif defined(_MSC_VER)
+            int cpui[4]{};
+            __cpuidex(cpui, 1, 0);
+            return static_cast<std::uint32_t>(cpui[0]);
+#else
+            return 0;
 #endif
         }
 #endif
@@ -286,6 +295,34 @@ namespace DetourModKit
         }
 #endif // DMK_HAS_AVX512
 
+        // The widest tier scan::apply_simd_calibration allows, as a SimdLevel value. Relaxed: a scan that still reads
+        // the previous ceiling runs the tier it would have run anyway, which matches the same bytes.
+        std::atomic<std::uint8_t> s_simd_ceiling{static_cast<std::uint8_t>(scan::SimdLevel::Avx512)};
+
+        [[nodiscard]] bool ceiling_allows(scan::SimdLevel tier) noexcept
+        {
+            return s_simd_ceiling.load(std::memory_order_relaxed) >= static_cast<std::uint8_t>(tier);
+        }
+
+        // Region size from which the flat sweep streams; see detail::set_streaming_sweep_threshold. Relaxed for the
+        // same reason as the ceiling: either mode reads the same bytes and finds the same match.
+        std::atomic<std::size_t> s_streaming_threshold{detail::STREAMING_SWEEP_BYTES};
+
+#ifdef DMK_HAS_AVX2
+        // cpu_has_avx2() under the calibrated ceiling: the gate every AVX2 body in the engine hoists.
+        bool avx2_enabled() noexcept
+        {
+            return cpu_has_avx2() && ceiling_allows(scan::SimdLevel::Avx2);
+        }
+#endif
+#ifdef DMK_HAS_AVX512
+        // cpu_has_avx512() under the calibrated ceiling.
+        bool avx512_enabled() noexcept
+        {
+            return cpu_has_avx512() && ceiling_allows(scan::SimdLevel::Avx512);
+        }
+#endif
+
         /**
          * @brief Picks the rarest fully-known byte's index in segment 0 of a compiled pattern.
          * @return The byte index in segment 0 with the lowest frequency score, or `pattern.size()` when segment 0 has
@@ -325,11 +362,48 @@ namespace DetourModKit
             }
             return best;
         }
+
+        /**
+         * @brief Picks the prefilter partner for @p anchor: the rarest fully-known segment-0 byte at another index.
+         * @return The partner's byte index, or `pattern.size()` when @p anchor is not a segment-0 literal or segment 0
+         *         holds no second one. Scored and tie-broken exactly like select_pattern_anchor().
+         */
+        std::size_t select_anchor_partner(const detail::EnginePattern &pattern, std::size_t anchor) noexcept
+        {
+            const std::size_t pattern_size = pattern.size();
+            const std::size_t segment0_end = pattern.jumps.empty() ? pattern_size : pattern.jumps.front().position;
+            if (anchor >= segment0_end)
+            {
+                return pattern_size;
+            }
+            std::size_t best = pattern_size;
+            std::uint8_t best_score = UINT8_MAX;
+            for (std::size_t i = 0; i < segment0_end; ++i)
+            {
+                if (i == anchor || pattern.mask[i] != std::byte{0xFF})
+                {
+                    continue;
+                }
+                const std::uint8_t score =
+                    detail::byte_frequency_class(std::to_integer<std::uint8_t>(pattern.bytes[i]));
+                if (best == pattern_size || score < best_score)
+                {
+                    best = i;
+                    best_score = score;
+                    if (score == 0)
+                    {
+                        break;
+                    }
+                }
+            }
+            return best;
+        }
     } // anonymous namespace
 
     void detail::EnginePattern::compile_anchor() noexcept
     {
         anchor = select_pattern_anchor(*this);
+        partner = select_anchor_partner(*this, anchor);
     }
 
     bool detail::pattern_has_literal_byte(const detail::EnginePattern &pattern) noexcept
@@ -375,6 +449,26 @@ namespace DetourModKit
                 return true;
             }
 
+            [[nodiscard]] bool add_class(std::size_t position, const detail::ByteSet &members)
+            {
+                if (pattern.classes.size() >= detail::MAX_PATTERN_CLASSES)
+                {
+                    return false;
+                }
+                pattern.classes.push_back(detail::ByteClass{position, members});
+                return true;
+            }
+
+            [[nodiscard]] bool add_group(const detail::PatternGroup &group)
+            {
+                if (pattern.groups.size() >= detail::MAX_PATTERN_GROUPS)
+                {
+                    return false;
+                }
+                pattern.groups.push_back(group);
+                return true;
+            }
+
             void set_offset(std::size_t position) noexcept { pattern.offset = static_cast<std::ptrdiff_t>(position); }
         };
     } // namespace
@@ -415,8 +509,13 @@ namespace DetourModKit
         compiled.bytes.assign(bytes.begin(), bytes.end());
         compiled.mask.assign(mask.begin(), mask.end());
         compiled.jumps.assign(jumps.begin(), jumps.end());
+        const std::span<const detail::ByteClass> classes = detail::classes_of(data);
+        const std::span<const detail::PatternGroup> groups = detail::groups_of(data);
+        compiled.classes.assign(classes.begin(), classes.end());
+        compiled.groups.assign(groups.begin(), groups.end());
         compiled.offset = static_cast<std::ptrdiff_t>(pattern.offset());
         compiled.anchor = anchor_index;
+        compiled.partner = select_anchor_partner(compiled, anchor_index);
         return compiled;
     }
 
@@ -480,6 +579,36 @@ namespace DetourModKit
             }
             return nullptr;
         }
+
+        // SSE2 paired-needle search: the first q in [p, p + n) with q[0] == first and q[delta] == second. Both vectors
+        // are compared in the same step and the two PCMPEQB masks ANDed, so a lane survives only when both bytes sit
+        // at their fixed distance. The caller guarantees [p + delta, p + n + delta) is readable as well.
+        DMK_NO_SANITIZE_ADDRESS
+        const unsigned char *dmk_find_pair_sse2(const unsigned char *p, std::size_t n, unsigned char first,
+                                                std::ptrdiff_t delta, unsigned char second) noexcept
+        {
+            const __m128i first_vec = _mm_set1_epi8(static_cast<char>(first));
+            const __m128i second_vec = _mm_set1_epi8(static_cast<char>(second));
+            for (; n >= 16; p += 16, n -= 16)
+            {
+                const __m128i lead = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+                const __m128i trail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + delta));
+                const __m128i both = _mm_and_si128(_mm_cmpeq_epi8(lead, first_vec), _mm_cmpeq_epi8(trail, second_vec));
+                const unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(both));
+                if (mask != 0)
+                {
+                    return p + dmk_movemask_first_index(mask);
+                }
+            }
+            for (; n > 0; ++p, --n)
+            {
+                if (p[0] == first && p[delta] == second)
+                {
+                    return p;
+                }
+            }
+            return nullptr;
+        }
 #endif // DMK_HAS_SSE2
 
 #ifdef DMK_HAS_AVX2
@@ -512,6 +641,76 @@ namespace DetourModKit
             }
             return nullptr;
         }
+
+        // AVX2 paired-needle search: the 32-byte form of dmk_find_pair_sse2, with a scalar tail for the same reason as
+        // the memchr body.
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        const unsigned char *dmk_find_pair_avx2(const unsigned char *p, std::size_t n, unsigned char first,
+                                                std::ptrdiff_t delta, unsigned char second) noexcept
+        {
+            const __m256i first_vec = _mm256_set1_epi8(static_cast<char>(first));
+            const __m256i second_vec = _mm256_set1_epi8(static_cast<char>(second));
+            for (; n >= 32; p += 32, n -= 32)
+            {
+                const __m256i lead = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i trail = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + delta));
+                const __m256i both =
+                    _mm256_and_si256(_mm256_cmpeq_epi8(lead, first_vec), _mm256_cmpeq_epi8(trail, second_vec));
+                const unsigned int mask = static_cast<unsigned int>(_mm256_movemask_epi8(both));
+                if (mask != 0)
+                {
+                    return p + dmk_movemask_first_index(mask);
+                }
+            }
+            for (; n > 0; ++p, --n)
+            {
+                if (p[0] == first && p[delta] == second)
+                {
+                    return p;
+                }
+            }
+            return nullptr;
+        }
+
+        // AVX2 anchor-class search over [p, end): the nibble fingerprint of detail::AnchorClass applied to 32 bytes at
+        // a time. VPSHUFB looks each byte's low nibble up in the broadcast lo table and its (shifted-down) high nibble
+        // in the hi table; a lane whose two lookups share a bit may hold an anchor value. The shift is done in 16-bit
+        // lanes, so the neighbouring byte's low bits are masked off before the lookup. Scalar tail, as in the memchr
+        // body, so no legacy-SSE encoding follows the VEX body.
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        const std::byte *dmk_find_anchor_class_avx2(const std::byte *p, const std::byte *end,
+                                                    const detail::AnchorClass &set) noexcept
+        {
+            const __m256i lo_table =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(set.lo.data())));
+            const __m256i hi_table =
+                _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i *>(set.hi.data())));
+            const __m256i nibble = _mm256_set1_epi8(0x0F);
+            const __m256i zero = _mm256_setzero_si256();
+            for (; end - p >= 32; p += 32)
+            {
+                const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+                const __m256i lo_hits = _mm256_shuffle_epi8(lo_table, _mm256_and_si256(chunk, nibble));
+                const __m256i hi_hits =
+                    _mm256_shuffle_epi8(hi_table, _mm256_and_si256(_mm256_srli_epi16(chunk, 4), nibble));
+                const __m256i empty = _mm256_cmpeq_epi8(_mm256_and_si256(lo_hits, hi_hits), zero);
+                const unsigned int mask = ~static_cast<unsigned int>(_mm256_movemask_epi8(empty));
+                if (mask != 0)
+                {
+                    return p + dmk_movemask_first_index(mask);
+                }
+            }
+            for (; p < end; ++p)
+            {
+                if (set.may_contain(std::to_integer<std::uint8_t>(*p)))
+                {
+                    return p;
+                }
+            }
+            return end;
+        }
 #endif // DMK_HAS_AVX2
 
         // use_avx2 is hoisted by find_pattern_raw so the per-anchor-hit sweep never re-reads the cpu_has_avx2() static.
@@ -558,10 +757,221 @@ namespace DetourModKit
             const std::size_t n = static_cast<std::size_t>(end - begin + 1);
             return static_cast<const std::byte *>(dmk_memchr(begin, target, n, use_avx2));
         }
+
+        // Paired form of scan_for_byte over [begin, end] inclusive: the first position holding @p target whose byte
+        // @p delta away holds @p partner. The caller guarantees [begin + delta, end + delta] is readable. Tiered like
+        // dmk_memchr, with the same 32-byte threshold for the AVX2 body.
+        DMK_NO_SANITIZE_ADDRESS
+        const std::byte *scan_for_byte_pair(const std::byte *begin, const std::byte *end, unsigned char target,
+                                            std::ptrdiff_t delta, unsigned char partner,
+                                            [[maybe_unused]] bool use_avx2) noexcept
+        {
+            const auto *p = reinterpret_cast<const unsigned char *>(begin);
+            std::size_t n = static_cast<std::size_t>(end - begin + 1);
+#ifdef DMK_HAS_AVX2
+            if (use_avx2 && n >= 32)
+            {
+                return reinterpret_cast<const std::byte *>(dmk_find_pair_avx2(p, n, target, delta, partner));
+            }
+#endif
+#ifdef DMK_HAS_SSE2
+            return reinterpret_cast<const std::byte *>(dmk_find_pair_sse2(p, n, target, delta, partner));
+#else
+            for (; n > 0; ++p, --n)
+            {
+                if (p[0] == target && p[delta] == partner)
+                {
+                    return reinterpret_cast<const std::byte *>(p);
+                }
+            }
+            return nullptr;
+#endif
+        }
+
+        // Issues a non-temporal prefetch for every cache line of [p, stop). A prefetch never faults; the caller still
+        // clips @p stop to its region so the sweep does not pull in lines it will not scan.
+        DMK_NO_SANITIZE_ADDRESS
+        void prefetch_range_nta([[maybe_unused]] const std::byte *p, [[maybe_unused]] const std::byte *stop) noexcept
+        {
+#ifdef DMK_HAS_SSE2
+            for (; p < stop; p += 64)
+            {
+                _mm_prefetch(reinterpret_cast<const char *>(p), _MM_HINT_NTA);
+            }
+#endif
+        }
+
+        /**
+         * @brief The segment-0 prefilter one scan sweeps with: the anchor byte alone, or the anchor and its partner.
+         * @details Built once per find_pattern_raw call. next() returns the next anchor position in [begin, end], the
+         *          same contract as scan_for_byte, so the three matchers swap it in without touching their candidate
+         *          arithmetic. A partner lies inside segment 0 by construction, so every byte the paired sweep reads is
+         *          one a candidate's verify would read anyway.
+         *
+         *          A streaming sweep (a region at or above detail::streaming_sweep_threshold()) walks the range in
+         *          STREAMING_BLOCK_BYTES blocks and, before each one, prefetches the block STREAMING_PREFETCH_BLOCKS
+         *          ahead with the non-temporal hint. The lines then arrive close to the core without being kept in the
+         *          shared cache levels, so a multi-gigabyte sweep does not evict the game's own working set.
+         */
+        struct AnchorSweep
+        {
+            unsigned char target = 0;
+            unsigned char partner = 0;
+            std::ptrdiff_t partner_delta = 0;
+            bool paired = false;
+            bool use_avx2 = false;
+            bool streaming = false;
+            // End of the range a streaming sweep has already prefetched, so a sweep resumed after a false candidate
+            // issues only the prefetches it has not issued yet.
+            mutable const std::byte *prefetched = nullptr;
+
+            DMK_NO_SANITIZE_ADDRESS
+            [[nodiscard]] const std::byte *next(const std::byte *begin, const std::byte *end) const noexcept
+            {
+                return streaming ? next_streamed(begin, end) : next_block(begin, end);
+            }
+
+        private:
+            DMK_NO_SANITIZE_ADDRESS
+            [[nodiscard]] const std::byte *next_block(const std::byte *begin, const std::byte *end) const noexcept
+            {
+                return paired ? scan_for_byte_pair(begin, end, target, partner_delta, partner, use_avx2)
+                              : scan_for_byte(begin, end, target, use_avx2);
+            }
+
+            DMK_NO_SANITIZE_ADDRESS
+            [[nodiscard]] const std::byte *next_streamed(const std::byte *begin, const std::byte *end) const noexcept
+            {
+                constexpr std::size_t AHEAD = detail::STREAMING_BLOCK_BYTES * detail::STREAMING_PREFETCH_BLOCKS;
+                for (const std::byte *block = begin;;)
+                {
+                    const auto left = static_cast<std::size_t>(end - block);
+                    const std::size_t span = std::min(left, detail::STREAMING_BLOCK_BYTES - 1);
+                    const std::byte *const horizon = left - span > AHEAD ? block + span + 1 + AHEAD : end + 1;
+                    if (prefetched == nullptr || prefetched < horizon)
+                    {
+                        prefetch_range_nta(prefetched == nullptr ? block : std::max(prefetched, block), horizon);
+                        prefetched = horizon;
+                    }
+                    if (const std::byte *hit = next_block(block, block + span))
+                    {
+                        return hit;
+                    }
+                    if (span == left)
+                    {
+                        return nullptr;
+                    }
+                    block += span + 1;
+                }
+            }
+        };
+
+        /// The sweep for @p pattern anchored at @p anchor (a fully-known segment-0 index); see EnginePattern::partner.
+        [[nodiscard]] AnchorSweep anchor_sweep(const detail::EnginePattern &pattern, std::size_t anchor,
+                                               bool use_avx2) noexcept
+        {
+            const std::size_t pattern_size = pattern.size();
+            const std::size_t segment0_end = pattern.jumps.empty() ? pattern_size : pattern.jumps.front().position;
+            std::size_t partner = pattern.partner;
+            if (partner > pattern_size)
+            {
+                partner = select_anchor_partner(pattern, anchor);
+            }
+            AnchorSweep sweep;
+            sweep.target = static_cast<unsigned char>(pattern.bytes[anchor]);
+            sweep.use_avx2 = use_avx2;
+            if (partner < segment0_end && partner != anchor && pattern.mask[partner] == std::byte{0xFF})
+            {
+                sweep.partner = static_cast<unsigned char>(pattern.bytes[partner]);
+                sweep.partner_delta = static_cast<std::ptrdiff_t>(partner) - static_cast<std::ptrdiff_t>(anchor);
+                sweep.paired = true;
+            }
+            return sweep;
+        }
     } // anonymous namespace
 
+    // Verifies the full pattern at one candidate position. SIMD tiers run widest-first: AVX-512 (64B) -> AVX2 (32B) ->
+    // SSE2 (16B) -> scalar (1B). Each tier resumes from the offset the previous one reached (start_offset j), so the
+    // widest enabled tiers cover the bulk and the scalar loop only ever finishes a sub-16-byte tail. The two gates are
+    // the caller's hoisted avx512_enabled() / avx2_enabled() results; verify_sweep passes its own to time one tier.
+    DMK_NO_SANITIZE_ADDRESS
+    static inline bool verify_candidate(const std::byte *pattern_start, const detail::EnginePattern &pattern,
+                                        [[maybe_unused]] bool use_avx512, [[maybe_unused]] bool use_avx2) noexcept
+    {
+        const std::size_t pattern_size = pattern.size();
+        bool match_found = true;
+        std::size_t j = 0;
+
+#ifdef DMK_HAS_AVX512
+        if (use_avx512)
+        {
+            const auto next_j = verify_pattern_avx512(pattern_start, pattern, j);
+            if (next_j.has_value())
+            {
+                j = *next_j;
+            }
+            else
+            {
+                match_found = false;
+            }
+        }
+#endif // DMK_HAS_AVX512
+
+#ifdef DMK_HAS_AVX2
+        if (match_found && use_avx2)
+        {
+            const auto next_j = verify_pattern_avx2(pattern_start, pattern, j);
+            if (next_j.has_value())
+            {
+                j = *next_j;
+            }
+            else
+            {
+                match_found = false;
+            }
+        }
+#endif // DMK_HAS_AVX2
+
+#ifdef DMK_HAS_SSE2
+        for (; match_found && j + 16 <= pattern_size; j += 16)
+        {
+            const __m128i mem = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern_start + j));
+            const __m128i pat = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.bytes.data() + j));
+            const __m128i msk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.mask.data() + j));
+
+            const __m128i xored = _mm_xor_si128(mem, pat);
+            const __m128i masked = _mm_and_si128(xored, msk);
+            const __m128i cmp = _mm_cmpeq_epi8(masked, _mm_setzero_si128());
+
+            if (_mm_movemask_epi8(cmp) != 0xFFFF)
+            {
+                match_found = false;
+                break;
+            }
+        }
+#endif // DMK_HAS_SSE2
+
+        for (; match_found && j < pattern_size; ++j)
+        {
+            // Masked compare so a partially-masked nibble byte checks only its known nibble: (mem ^ pat) & mask
+            // is zero exactly when every bit the mask selects agrees. A wildcard (mask 0x00) is trivially
+            // satisfied, a full literal (0xFF) compares the whole byte, and a nibble (0xF0 / 0x0F) compares one
+            // nibble.
+            const auto mem = std::to_integer<unsigned>(pattern_start[j]);
+            const auto pat = std::to_integer<unsigned>(pattern.bytes[j]);
+            const auto msk = std::to_integer<unsigned>(pattern.mask[j]);
+            if (((mem ^ pat) & msk) != 0)
+            {
+                match_found = false;
+            }
+        }
+
+        return match_found;
+    }
+
     // Flat single-segment matcher: the memchr-anchored SIMD body, returning the match START (no offset applied).
     // Every jump-free pattern dispatches here, so the overwhelmingly common case runs the direct fixed-width fast path.
+    // The prefilter sweeps for the anchor and, when the pattern has one, its partner byte together (see AnchorSweep).
     DMK_NO_SANITIZE_ADDRESS
     static const std::byte *find_pattern_flat_start(const std::byte *start_address, std::size_t region_size,
                                                     const detail::EnginePattern &pattern) noexcept
@@ -593,8 +1003,11 @@ namespace DetourModKit
                 return start_address;
             }
             const std::byte *const last_start = start_address + (region_size - pattern_size);
+            detail::EngineTally tally;
             for (const std::byte *pos = start_address; pos <= last_start; ++pos)
             {
+                tally.candidate();
+                tally.verify();
                 bool match_found = true;
                 for (std::size_t j = 0; j < pattern_size; ++j)
                 {
@@ -607,7 +1020,7 @@ namespace DetourModKit
                         break;
                     }
                 }
-                if (match_found)
+                if (match_found && pattern.constraints_hold_at(pos, 0, pattern_size))
                 {
                     return pos;
                 }
@@ -615,9 +1028,6 @@ namespace DetourModKit
             return nullptr;
         }
 
-        const std::byte target_byte = pattern.bytes[best_anchor];
-        const unsigned char target_val = static_cast<unsigned char>(target_byte);
-
         const std::byte *search_start = start_address + best_anchor;
         const std::byte *const search_end = start_address + (region_size - pattern_size) + best_anchor;
 
@@ -626,96 +1036,45 @@ namespace DetourModKit
         // once here lets both the prefilter sweep and the per-candidate verify branch use a register-resident bool.
         // It is defined unconditionally (false without an AVX2 build) because the prefilter takes it on every call.
 #ifdef DMK_HAS_AVX2
-        const bool use_avx2 = cpu_has_avx2();
+        const bool use_avx2 = avx2_enabled();
 #else
         const bool use_avx2 = false;
 #endif
 #ifdef DMK_HAS_AVX512
-        const bool use_avx512 = cpu_has_avx512();
+        const bool use_avx512 = avx512_enabled();
+#else
+        const bool use_avx512 = false;
 #endif
+        AnchorSweep sweep = anchor_sweep(pattern, best_anchor, use_avx2);
+        sweep.streaming = region_size >= s_streaming_threshold.load(std::memory_order_relaxed);
+        detail::EngineTally tally;
 
         while (search_start <= search_end)
         {
-            const std::byte *current_scan_ptr = scan_for_byte(search_start, search_end, target_val, use_avx2);
+            const std::byte *current_scan_ptr = sweep.next(search_start, search_end);
 
             if (!current_scan_ptr)
             {
                 break;
             }
             const std::byte *pattern_start = current_scan_ptr - best_anchor;
+            tally.candidate();
+            tally.verify();
 
-            // Verify the full pattern at this position. SIMD tiers run widest-first: AVX-512 (64B) -> AVX2 (32B) ->
-            // SSE2 (16B) -> scalar (1B). Each tier resumes from the offset the previous one reached (start_offset
-            // j), so the widest available tiers cover the bulk and the scalar loop only ever finishes a sub-16-byte
-            // tail.
-            bool match_found = true;
-            std::size_t j = 0;
-
-#ifdef DMK_HAS_AVX512
-            if (use_avx512)
-            {
-                const auto next_j = verify_pattern_avx512(pattern_start, pattern, j);
-                if (next_j.has_value())
-                {
-                    j = *next_j;
-                }
-                else
-                {
-                    match_found = false;
-                }
-            }
-#endif // DMK_HAS_AVX512
-
-#ifdef DMK_HAS_AVX2
-            if (match_found && use_avx2)
-            {
-                const auto next_j = verify_pattern_avx2(pattern_start, pattern, j);
-                if (next_j.has_value())
-                {
-                    j = *next_j;
-                }
-                else
-                {
-                    match_found = false;
-                }
-            }
-#endif // DMK_HAS_AVX2
-
-#ifdef DMK_HAS_SSE2
-            for (; match_found && j + 16 <= pattern_size; j += 16)
-            {
-                const __m128i mem = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern_start + j));
-                const __m128i pat = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.bytes.data() + j));
-                const __m128i msk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pattern.mask.data() + j));
-
-                const __m128i xored = _mm_xor_si128(mem, pat);
-                const __m128i masked = _mm_and_si128(xored, msk);
-                const __m128i cmp = _mm_cmpeq_epi8(masked, _mm_setzero_si128());
-
-                if (_mm_movemask_epi8(cmp) != 0xFFFF)
-                {
-                    match_found = false;
-                    break;
-                }
-            }
-#endif // DMK_HAS_SSE2
-
-            for (; match_found && j < pattern_size; ++j)
+            // A compile-time literal brings its own unrolled verifier; it replaces the verify_candidate tier ladder.
+            // Either way the masked compare is a superset test at class positions, so their exact check follows.
+            if (pattern.kernel != nullptr)
             {
-                // Masked compare so a partially-masked nibble byte checks only its known nibble: (mem ^ pat) & mask
-                // is zero exactly when every bit the mask selects agrees. A wildcard (mask 0x00) is trivially
-                // satisfied, a full literal (0xFF) compares the whole byte, and a nibble (0xF0 / 0x0F) compares one
-                // nibble.
-                const auto mem = std::to_integer<unsigned>(pattern_start[j]);
-                const auto pat = std::to_integer<unsigned>(pattern.bytes[j]);
-                const auto msk = std::to_integer<unsigned>(pattern.mask[j]);
-                if (((mem ^ pat) & msk) != 0)
+                if (pattern.kernel(pattern_start) && pattern.constraints_hold_at(pattern_start, 0, pattern_size))
                 {
-                    match_found = false;
+                    return pattern_start;
                 }
+                search_start = current_scan_ptr + 1;
+                continue;
             }
 
-            if (match_found)
+            if (verify_candidate(pattern_start, pattern, use_avx512, use_avx2) &&
+                pattern.constraints_hold_at(pattern_start, 0, pattern_size))
             {
                 return pattern_start;
             }
@@ -730,7 +1089,7 @@ namespace DetourModKit
     // Masked-compares one fixed segment run [body_begin, body_end) of the pattern against memory at addr. The caller
     // guarantees [addr, addr + (body_end - body_begin)) is inside the scanned region, so this does no bounds check. The
     // per-byte test is the same (mem ^ pat) & mask == 0 the flat verify uses, so wildcard and nibble bytes behave
-    // identically here.
+    // identically here, and the run's classes and groups are checked after it.
     DMK_NO_SANITIZE_ADDRESS
     static bool segment_run_matches(const std::byte *addr, const detail::EnginePattern &pattern, std::size_t body_begin,
                                     std::size_t body_end) noexcept
@@ -745,7 +1104,7 @@ namespace DetourModKit
                 return false;
             }
         }
-        return true;
+        return pattern.constraints_hold_at(addr, body_begin, body_end);
     }
 
     // Backtracking segment extension for a bounded-jump pattern. Tries to place segment `segment_index` (and every
@@ -858,11 +1217,312 @@ namespace DetourModKit
         return detail::RawMatch{segment_starts[0], end, point};
     }
 
+    // A fixed-width state bitset for the bit-parallel matcher: bit i is NFA state i. Words is 1 or 2, so every loop
+    // below unrolls to straight-line code.
+    template <std::size_t Words>
+    struct BitapMask
+    {
+        std::array<std::uint64_t, Words> words{};
+
+        void set(std::size_t bit) noexcept { words[bit / 64] |= std::uint64_t{1} << (bit % 64); }
+
+        [[nodiscard]] bool test(std::size_t bit) const noexcept
+        {
+            return bit < Words * 64 && ((words[bit / 64] >> (bit % 64)) & 1u) != 0;
+        }
+
+        [[nodiscard]] bool any() const noexcept
+        {
+            std::uint64_t folded = 0;
+            for (const std::uint64_t word : words)
+            {
+                folded |= word;
+            }
+            return folded != 0;
+        }
+
+        // Every live state advanced by one byte, with a fresh match attempt entering at state 0: (D << 1) | 1.
+        [[nodiscard]] BitapMask advanced() const noexcept
+        {
+            BitapMask out;
+            std::uint64_t carry = 1;
+            for (std::size_t i = 0; i < Words; ++i)
+            {
+                out.words[i] = (words[i] << 1) | carry;
+                carry = words[i] >> 63;
+            }
+            return out;
+        }
+
+        // The set shifted towards bit 0 by @p count (bits below count fall off).
+        [[nodiscard]] BitapMask shifted_down(std::size_t count) const noexcept
+        {
+            BitapMask out;
+            const std::size_t word_shift = count / 64;
+            const std::size_t bit_shift = count % 64;
+            for (std::size_t i = 0; i + word_shift < Words; ++i)
+            {
+                std::uint64_t value = words[i + word_shift] >> bit_shift;
+                if (bit_shift != 0 && i + word_shift + 1 < Words)
+                {
+                    value |= words[i + word_shift + 1] << (64 - bit_shift);
+                }
+                out.words[i] = value;
+            }
+            return out;
+        }
+
+        BitapMask &operator&=(const BitapMask &other) noexcept
+        {
+            for (std::size_t i = 0; i < Words; ++i)
+            {
+                words[i] &= other.words[i];
+            }
+            return *this;
+        }
+
+        BitapMask &operator|=(const BitapMask &other) noexcept
+        {
+            for (std::size_t i = 0; i < Words; ++i)
+            {
+                words[i] |= other.words[i];
+            }
+            return *this;
+        }
+    };
+
+    // Resolves the leftmost placement of a bounded-jump match starting exactly at @p start, or returns false when none
+    // fits before region_end. Offsets are relative to start and stay below max_match_length() <= Words * 64, so one
+    // bitset per segment holds every offset that segment may occupy. A backward pass keeps, per segment, only the
+    // offsets from which the rest of the pattern can still be completed; the forward pass then takes the smallest
+    // feasible gap at each boundary -- the same lexicographically-first placement extend_segments' ascending-gap
+    // backtracking returns, found in O(segments x span) compares instead of a search tree.
+    template <std::size_t Words>
+    DMK_NO_SANITIZE_ADDRESS static bool place_segments_at(const detail::EnginePattern &pattern, const std::byte *start,
+                                                          const std::byte *region_end,
+                                                          const std::byte **segment_starts) noexcept
+    {
+        const std::size_t jump_count = pattern.jumps.size();
+        const std::size_t available = static_cast<std::size_t>(region_end - start);
+        std::array<BitapMask<Words>, detail::MAX_PATTERN_JUMPS + 1> reachable{};
+        std::array<std::size_t, detail::MAX_PATTERN_JUMPS + 1> lengths{};
+
+        std::size_t lo = 0;
+        std::size_t hi = 0;
+        for (std::size_t segment_index = 0; segment_index <= jump_count; ++segment_index)
+        {
+            const std::size_t segment_begin = (segment_index == 0) ? 0 : pattern.jumps[segment_index - 1].position;
+            const std::size_t segment_end =
+                (segment_index < jump_count) ? pattern.jumps[segment_index].position : pattern.size();
+            const std::size_t length = segment_end - segment_begin;
+            lengths[segment_index] = length;
+            for (std::size_t offset = lo; offset <= hi && offset + length <= available; ++offset)
+            {
+                if (segment_run_matches(start + offset, pattern, segment_begin, segment_end))
+                {
+                    reachable[segment_index].set(offset);
+                }
+            }
+            if (segment_index < jump_count)
+            {
+                lo += length + pattern.jumps[segment_index].min_skip;
+                hi += length + pattern.jumps[segment_index].max_skip;
+            }
+        }
+
+        // Backward: an offset of segment k survives only if some gap width lands on a surviving offset of k + 1.
+        for (std::size_t segment_index = jump_count; segment_index-- > 0;)
+        {
+            const detail::PatternJump &gap = pattern.jumps[segment_index];
+            BitapMask<Words> continues{};
+            for (std::size_t skip = gap.min_skip; skip <= gap.max_skip; ++skip)
+            {
+                continues |= reachable[segment_index + 1].shifted_down(lengths[segment_index] + skip);
+            }
+            reachable[segment_index] &= continues;
+        }
+        if (!reachable[0].test(0))
+        {
+            return false;
+        }
+
+        std::size_t offset = 0;
+        segment_starts[0] = start;
+        for (std::size_t segment_index = 0; segment_index < jump_count; ++segment_index)
+        {
+            const detail::PatternJump &gap = pattern.jumps[segment_index];
+            for (std::size_t skip = gap.min_skip; skip <= gap.max_skip; ++skip)
+            {
+                const std::size_t next = offset + lengths[segment_index] + skip;
+                if (reachable[segment_index + 1].test(next))
+                {
+                    offset = next;
+                    break;
+                }
+            }
+            segment_starts[segment_index + 1] = start + offset;
+        }
+        return true;
+    }
+
+    // Bit-parallel (shift-and) matcher for a bounded-jump pattern whose longest match fits in Words * 64 bits. The
+    // pattern unrolls into a linear NFA with one state per fixed byte plus max_skip any-byte states per gap; a gap's
+    // optional (max_skip - min_skip) states are epsilon-reachable from the fixed byte before it. Every region byte
+    // costs one shift, one table AND, and one test per gap, independent of gap widths, so the sweep is linear and
+    // needs no work budget: it either reports the leftmost match or proves there is none. The automaton finds the
+    // earliest match END; the leftmost START lies within max_match_length() bytes before it (any earlier start would
+    // have ended first), and place_segments_at recovers it and its gap widths. With no live state, the sweep skips
+    // straight to the next segment-0 anchor hit, so a real signature still runs at memchr speed between candidates.
+    template <std::size_t Words>
+    DMK_NO_SANITIZE_ADDRESS static detail::RawMatch find_pattern_bitap(const std::byte *start_address,
+                                                                       std::size_t region_size,
+                                                                       const detail::EnginePattern &pattern,
+                                                                       bool use_avx2) noexcept
+    {
+        const std::size_t min_length = pattern.min_match_length();
+        const std::size_t max_length = pattern.max_match_length();
+        const std::byte *const region_end = start_address + region_size;
+        const std::byte *const last_candidate = start_address + (region_size - min_length);
+        const std::size_t jump_count = pattern.jumps.size();
+
+        // accepts[v]: the fixed-byte states byte v satisfies. Wildcard bytes and gap states accept anything, so they
+        // live once in any_byte instead of in all 256 rows.
+        std::array<BitapMask<Words>, 256> accepts{};
+        BitapMask<Words> any_byte{};
+        std::array<std::size_t, detail::MAX_PATTERN_JUMPS> gap_entry{};
+        std::array<BitapMask<Words>, detail::MAX_PATTERN_JUMPS> gap_shortcut{};
+        std::size_t state = 0;
+        std::size_t next_class = 0;
+        for (std::size_t i = 0; i < pattern.size(); ++i)
+        {
+            const auto pat = std::to_integer<unsigned>(pattern.bytes[i]);
+            const auto msk = std::to_integer<unsigned>(pattern.mask[i]);
+            if (next_class < pattern.classes.size() && pattern.classes[next_class].position == i)
+            {
+                // A class position accepts exactly its members, which its shared bits only over-approximate.
+                const detail::ByteSet &members = pattern.classes[next_class++].members;
+                for (unsigned value = 0; value < 256; ++value)
+                {
+                    if (members.contains(static_cast<std::byte>(value)))
+                    {
+                        accepts[value].set(state);
+                    }
+                }
+            }
+            else if (msk == 0xFFu)
+            {
+                accepts[pat].set(state);
+            }
+            else if (msk == 0)
+            {
+                any_byte.set(state);
+            }
+            else
+            {
+                for (unsigned value = 0; value < 256; ++value)
+                {
+                    if (((value ^ pat) & msk) == 0)
+                    {
+                        accepts[value].set(state);
+                    }
+                }
+            }
+            ++state;
+
+            for (std::size_t gap_index = 0; gap_index < jump_count; ++gap_index)
+            {
+                const detail::PatternJump &gap = pattern.jumps[gap_index];
+                if (gap.position != i + 1)
+                {
+                    continue;
+                }
+                gap_entry[gap_index] = state - 1;
+                for (std::size_t skip = 0; skip < gap.max_skip; ++skip)
+                {
+                    any_byte.set(state + skip);
+                }
+                for (std::size_t skip = 0; skip < gap.max_skip - gap.min_skip; ++skip)
+                {
+                    gap_shortcut[gap_index].set(state + skip);
+                }
+                state += gap.max_skip;
+            }
+        }
+        const std::size_t final_state = state - 1;
+
+        const std::size_t segment0_end = pattern.jumps.front().position;
+        const std::size_t anchor = pattern.anchor;
+        const bool anchored = anchor < segment0_end;
+        const AnchorSweep sweep = anchored ? anchor_sweep(pattern, anchor, use_avx2) : AnchorSweep{};
+
+        BitapMask<Words> live{};
+        const std::byte *p = start_address;
+        // A candidate is each restart of an idle automaton, a step each byte it consumes, a verify each placement.
+        detail::EngineTally tally;
+        while (p < region_end)
+        {
+            if (!live.any())
+            {
+                // Nothing in flight: the next match starts at a later candidate, or there is none.
+                if (p > last_candidate)
+                {
+                    break;
+                }
+                if (anchored)
+                {
+                    const std::byte *const hit = sweep.next(p + anchor, last_candidate + anchor);
+                    if (!hit)
+                    {
+                        break;
+                    }
+                    p = hit - anchor;
+                }
+                tally.candidate();
+            }
+
+            live = live.advanced();
+            BitapMask<Words> step = accepts[std::to_integer<unsigned>(*p)];
+            step |= any_byte;
+            live &= step;
+            for (std::size_t gap_index = 0; gap_index < jump_count; ++gap_index)
+            {
+                if (live.test(gap_entry[gap_index]))
+                {
+                    live |= gap_shortcut[gap_index];
+                }
+            }
+            ++p;
+            tally.steps(1);
+
+            if (live.test(final_state))
+            {
+                const std::byte *const match_end = p;
+                const std::size_t reach = static_cast<std::size_t>(match_end - start_address);
+                const std::byte *start = reach > max_length ? match_end - max_length : start_address;
+                const std::byte *segment_starts[detail::MAX_PATTERN_JUMPS + 1] = {};
+                for (; start <= match_end - min_length; ++start)
+                {
+                    tally.verify();
+                    if (place_segments_at<Words>(pattern, start, region_end, segment_starts))
+                    {
+                        return segmented_result(pattern, segment_starts);
+                    }
+                }
+                // Unreachable: the automaton accepted, so some start in the window places. Fail closed regardless.
+                detail::RawMatch result{};
+                result.budget_exhausted = true;
+                return result;
+            }
+        }
+        return detail::RawMatch{};
+    }
+
     // Segmented backtracking matcher for a bounded-jump pattern. Locates segment 0 with the same memchr anchor sweep
     // the flat matcher uses (or scans every start position when segment 0 has no literal anchor), then extends across
     // the gaps. Returns the leftmost match: the smallest segment-0 start that admits a full placement. Sets
     // RawMatch::budget_exhausted when the per-position or region-wide backtracking budget was spent before the sweep
-    // was exhaustive, so a caller counting occurrences fails closed rather than trusting a truncated verdict.
+    // was exhaustive, so a caller counting occurrences fails closed rather than trusting a truncated verdict. A pattern
+    // whose span fits BITAP_MAX_MATCH_LENGTH is handed to find_pattern_bitap instead and never touches the budget.
     DMK_NO_SANITIZE_ADDRESS
     static detail::RawMatch find_pattern_segmented(const std::byte *start_address, std::size_t region_size,
                                                    const detail::EnginePattern &pattern,
@@ -879,6 +1539,25 @@ namespace DetourModKit
         {
             return detail::RawMatch{};
         }
+        // A match span that fits the automaton's state bitset takes the linear bit-parallel sweep, which needs no
+        // budget; only wider spans fall through to the budgeted backtracking search. The automaton tracks single
+        // positions, so it reads a class exactly but cannot tie a group's positions to one alternative: a group-bearing
+        // pattern stays on the backtracking search, whose runs check the group whole.
+        const std::size_t max_length = pattern.max_match_length();
+        const bool automaton = pattern.groups.empty();
+        if (automaton && max_length <= 64)
+        {
+            detail::RawMatch match = find_pattern_bitap<1>(start_address, region_size, pattern, use_avx2);
+            match.budget_exhausted = match.budget_exhausted || budget.exhausted;
+            return match;
+        }
+        if (automaton && max_length <= detail::BITAP_MAX_MATCH_LENGTH)
+        {
+            detail::RawMatch match = find_pattern_bitap<2>(start_address, region_size, pattern, use_avx2);
+            match.budget_exhausted = match.budget_exhausted || budget.exhausted;
+            return match;
+        }
+
         const std::byte *const region_end = start_address + region_size;
         // A segment-0 start must leave room for at least a minimum-length match.
         const std::byte *const last_candidate = start_address + (region_size - min_length);
@@ -896,21 +1575,25 @@ namespace DetourModKit
         // closed rather than mistaking it for a proven leftmost occurrence.
 
         const std::size_t anchor = pattern.anchor;
+        // Node visits are counted from the budget by find_pattern_raw; this tallies the start positions tried.
+        detail::EngineTally tally;
         if (anchor < segment0_end)
         {
             // Anchored sweep: memchr for the segment-0 anchor byte, then try to extend from each hit. The anchor sits
             // `anchor` bytes into segment 0, so a hit at H means a candidate segment-0 start at H - anchor.
-            const auto target = static_cast<unsigned char>(pattern.bytes[anchor]);
+            const AnchorSweep sweep = anchor_sweep(pattern, anchor, use_avx2);
             const std::byte *const search_hi = last_candidate + anchor; // inclusive, mirrors the flat matcher
             const std::byte *search_start = start_address + anchor;
             while (search_start <= search_hi)
             {
-                const std::byte *const hit = scan_for_byte(search_start, search_hi, target, use_avx2);
+                const std::byte *const hit = sweep.next(search_start, search_hi);
                 if (!hit)
                 {
                     break;
                 }
                 const std::byte *const candidate = hit - anchor;
+                tally.candidate();
+                tally.verify();
                 // The per-position budget is reset at each start so one position's pathological backtracking can never
                 // starve a later, genuine match; the region-wide budget below still bounds their sum.
                 std::size_t steps = 0;
@@ -945,6 +1628,8 @@ namespace DetourModKit
         for (const std::byte *candidate = start_address; candidate <= last_candidate; ++candidate)
         {
             // Per-candidate work budget (see the anchored sweep above): reset at each start position.
+            tally.candidate();
+            tally.verify();
             std::size_t steps = 0;
             bool position_exhausted = false;
             const bool matched =
@@ -991,13 +1676,17 @@ namespace DetourModKit
         // Bounded-jump pattern: hoist the AVX2 gate once for the segmented sweep's memchr, then run the segmented
         // matcher, which applies the offset itself because a jump match's marker delta is not a constant.
 #ifdef DMK_HAS_AVX2
-        const bool use_avx2 = cpu_has_avx2();
+        const bool use_avx2 = avx2_enabled();
 #else
         const bool use_avx2 = false;
 #endif
         detail::SegmentedScanBudget local_budget{};
         detail::SegmentedScanBudget &budget = segmented_budget != nullptr ? *segmented_budget : local_budget;
-        return find_pattern_segmented(start_address, region_size, pattern, budget, use_avx2);
+        const std::size_t visits_before = budget.node_visits;
+        const RawMatch match = find_pattern_segmented(start_address, region_size, pattern, budget, use_avx2);
+        detail::EngineTally tally;
+        tally.steps(budget.node_visits - visits_before);
+        return match;
     }
 
     const std::byte *detail::find_pattern(const std::byte *start_address, std::size_t region_size,
@@ -1069,7 +1758,27 @@ namespace DetourModKit
         return nullptr;
     }
 
-    scan::SimdLevel detail::active_simd_level() noexcept
+    DMK_NO_SANITIZE_ADDRESS
+    const std::byte *detail::find_anchor_class(const std::byte *p, const std::byte *end,
+                                               const AnchorClass &set) noexcept
+    {
+#ifdef DMK_HAS_AVX2
+        if (end - p >= 32 && avx2_enabled())
+        {
+            return dmk_find_anchor_class_avx2(p, end, set);
+        }
+#endif
+        for (; p < end; ++p)
+        {
+            if (set.may_contain(std::to_integer<std::uint8_t>(*p)))
+            {
+                return p;
+            }
+        }
+        return end;
+    }
+
+    scan::SimdLevel detail::detected_simd_level() noexcept
     {
 #ifdef DMK_HAS_AVX512
         if (cpu_has_avx512())
@@ -1085,4 +1794,62 @@ namespace DetourModKit
         return scan::SimdLevel::Scalar;
 #endif
     }
+
+    scan::SimdLevel detail::active_simd_level() noexcept
+    {
+        return std::min(detected_simd_level(), simd_ceiling());
+    }
+
+    void detail::set_simd_ceiling(scan::SimdLevel ceiling) noexcept
+    {
+        // The SSE2 body is the build's baseline and is not gated, so a lower ceiling would only misreport it.
+        const scan::SimdLevel floor = std::min(scan::SimdLevel::Sse2, detected_simd_level());
+        s_simd_ceiling.store(static_cast<std::uint8_t>(std::max(ceiling, floor)), std::memory_order_relaxed);
+    }
+
+    scan::SimdLevel detail::simd_ceiling() noexcept
+    {
+        return static_cast<scan::SimdLevel>(s_simd_ceiling.load(std::memory_order_relaxed));
+    }
+
+    void detail::set_streaming_sweep_threshold(std::size_t bytes) noexcept
+    {
+        s_streaming_threshold.store(bytes, std::memory_order_relaxed);
+    }
+
+    std::size_t detail::streaming_sweep_threshold() noexcept
+    {
+        return s_streaming_threshold.load(std::memory_order_relaxed);
+    }
+
+    std::uint32_t detail::cpu_signature_word() noexcept
+    {
+#if defined(DMK_HAS_AVX2) || defined(DMK_HAS_AVX512)
+        return cpu_signature();
+#else
+        return 0;
+#endif
+    }
+
+    DMK_NO_SANITIZE_ADDRESS
+    std::size_t detail::verify_sweep(scan::SimdLevel tier, const std::byte *data, std::size_t size,
+                                     const detail::EnginePattern &pattern) noexcept
+    {
+        const std::size_t pattern_size = pattern.size();
+        if (pattern_size == 0 || data == nullptr || size < pattern_size)
+        {
+            return 0;
+        }
+        // Clamp to what this host runs, so a tier the CPU lacks is never entered.
+        const scan::SimdLevel level = std::min(tier, detected_simd_level());
+        const bool use_avx512 = level >= scan::SimdLevel::Avx512;
+        const bool use_avx2 = level >= scan::SimdLevel::Avx2;
+        std::size_t matches = 0;
+        const std::byte *const last = data + (size - pattern_size);
+        for (const std::byte *pos = data; pos <= last; ++pos)
+        {
+            matches += verify_candidate(pos, pattern, use_avx512, use_avx2) ? 1 : 0;
+        }
+        return matches;
+    }
 } // namespace DetourModKit
@@ -15,6 +15,7 @@
 
 #include "DetourModKit/scan.hpp"
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
@@ -41,13 +42,23 @@ namespace DetourModKit
         static_assert(SEGMENT_MATCH_REGION_STEP_BUDGET >= SEGMENT_MATCH_STEP_BUDGET,
                       "The per-region budget must let at least one start position run to its per-position ceiling.");
 
+        /**
+         * @brief Widest bounded-jump match span, in bytes, the segmented matcher runs as a bit-parallel automaton.
+         * @details A pattern whose max_match_length() fits takes a linear shift-and sweep with one NFA state per
+         *          spanned byte, so it spends no backtracking budget and never reports budget exhaustion. Wider spans
+         *          keep the budgeted backtracking search.
+         */
+        inline constexpr std::size_t BITAP_MAX_MATCH_LENGTH = 128;
+
         /**
          * @struct EnginePattern
          * @brief A heap-backed compiled AOB pattern with separate bytes and mask, plus a cached scan anchor.
          * @details The heap-backed compiled engine pattern. Stores the pattern bytes and a
          *          per-byte mask: a position passes when (memory_byte ^ bytes) & mask == 0, so 0xFF marks a fully
-         *          literal byte, 0x00 a wildcard, and 0xF0 / 0x0F a per-nibble token. @ref offset is the `|` result
-         *          marker (0 when absent). @ref anchor is the rarest fully-known byte the memchr prefilter sweeps for.
+         *          literal byte, 0x00 a wildcard, and 0xF0 / 0x0F a per-nibble token. A class or group position holds
+         *          the bits its members share, and @ref classes / @ref groups finish the check exactly. @ref offset is
+         *          the `|` result marker (0 when absent). @ref anchor is the rarest fully-known byte the memchr
+         *          prefilter sweeps for.
          */
         struct EnginePattern
         {
@@ -91,6 +102,34 @@ namespace DetourModKit
              */
             std::size_t anchor = std::numeric_limits<std::size_t>::max();
 
+            /**
+             * @brief Cached second prefilter byte selected alongside @ref anchor by compile_anchor().
+             * @details When segment 0 holds a second fully-known byte, the prefilter tests it in the same vector step
+             *          as the anchor: each candidate must carry the anchor value at its anchor position AND this byte's
+             *          value at its fixed distance from it. On `.text`, where even the rarest byte of a signature is
+             *          often a common opcode, the pair passes an order of magnitude fewer positions to the verify tier
+             *          than the anchor alone. The partner is the rarest remaining segment-0 literal, scored like the
+             *          anchor.
+             *
+             *          Sentinel values mirror @ref anchor:
+             *          - `[0, size())`   valid partner; a fully-known segment-0 byte other than @ref anchor.
+             *          - `size()`        no partner; the prefilter sweeps for the anchor byte alone.
+             *          - `>= size() + 1` not yet selected; the matcher picks one inline for the anchor it uses.
+             *
+             *          A partner that no longer qualifies for the anchor in use (one overridden after compile_anchor)
+             *          is ignored rather than trusted, so a stale partner costs speed, never a match.
+             */
+            std::size_t partner = std::numeric_limits<std::size_t>::max();
+
+            /**
+             * @brief Compile-time specialized verifier for a jump-free pattern, or nullptr for the generic verify.
+             * @details Set only from the `scan::scan<"...">` / `unchecked::find_pattern<"...">` front-ends, which
+             *          instantiate it from the same literal this pattern was built from (see pattern_kernel.hpp). The
+             *          flat matcher calls it on each prefilter candidate in place of the SIMD verify tiers; the
+             *          bounded-jump matchers ignore it. It must describe exactly @ref bytes and @ref mask.
+             */
+            PatternKernel kernel = nullptr;
+
             /**
              * @brief Bounded-jump gaps between fixed segments, in ascending position order.
              * @details Empty for a plain (single-segment) pattern, in which case the matcher takes the single
@@ -100,6 +139,31 @@ namespace DetourModKit
              */
             std::vector<PatternJump> jumps;
 
+            /**
+             * @brief Exact member sets of the class positions whose value/mask pair over-approximates them.
+             * @details Ascending by position and copied from the shared parser. The masked compare every verify tier
+             *          runs is a superset test at those positions; a candidate it accepts is settled here.
+             */
+            std::vector<ByteClass> classes;
+
+            /// Alternation groups whose alternatives differ at more than one position, ascending by position.
+            std::vector<PatternGroup> groups;
+
+            /// True when the pattern carries classes or groups a masked compare cannot settle on its own.
+            [[nodiscard]] bool has_constraints() const noexcept { return !classes.empty() || !groups.empty(); }
+
+            /**
+             * @brief Checks the classes and groups inside fixed run [body_begin, body_end) against memory at @p run.
+             * @details Called after the run's masked compare passed; trivially true for a pattern without them.
+             */
+            [[nodiscard]] bool constraints_hold_at(const std::byte *run, std::size_t body_begin,
+                                                   std::size_t body_end) const noexcept
+            {
+                return !has_constraints() ||
+                       constraints_hold(classes, groups, std::span<const std::byte>(run, body_end - body_begin),
+                                        body_begin);
+            }
+
             /// Returns the number of fixed bytes in the pattern (all segments concatenated, gaps excluded).
             [[nodiscard]] std::size_t size() const noexcept { return bytes.size(); }
 
@@ -135,9 +199,10 @@ namespace DetourModKit
              *          opcodes / padding score high; uncommon bytes score 0), and stores the lowest-scoring index in
              *          @ref anchor. Partially-masked nibble bytes are skipped: the prefilter needs one exact byte
              *          value, which a nibble does not provide. Ties break by first occurrence. A segment 0 with no
-             *          fully-known byte sets @ref anchor to size(). Idempotent and O(size()). Callers that mutate
-             *          @ref bytes, @ref mask, or @ref jumps afterwards MUST call it again before the next scan or the
-             *          cached anchor drifts. Not thread-safe with concurrent find_pattern() on the same instance.
+             *          fully-known byte sets @ref anchor to size(). A second walk then picks @ref partner.
+             *          Idempotent and O(size()). Callers that mutate @ref bytes, @ref mask, or @ref jumps afterwards
+             *          MUST call it again before the next scan or the cached anchor drifts. Not thread-safe with
+             *          concurrent find_pattern() on the same instance.
              */
             void compile_anchor() noexcept;
         };
@@ -146,12 +211,14 @@ namespace DetourModKit
          * @brief Parses a space-separated AOB string into a compiled EnginePattern.
          * @details Drives the single shared grammar (detail::parse_pattern_into) through a heap-backed sink, so the
          *          runtime engine and the compile-time scan::Pattern accept exactly the same DSL (hex bytes, `??` / `?`
-         *          wildcards, `4?` / `?5` nibbles, `[X]` / `[X-Y]` bounded jumps, and the `|` offset marker) and can
+         *          wildcards, `4?` / `?5` nibbles, `[0D|15]` classes, `(..|..)` groups, `[X]` / `[X-Y]` bounded jumps,
+         *          and the `|` offset marker) and can
          *          never silently diverge. Unlike the fixed-array scan::Pattern storage, the heap-backed EnginePattern
          *          imposes no MAX_PATTERN_BYTES cap, so a long runtime pattern (e.g. the byte pattern find_string_xref
          *          builds from a long search string) compiles here even when it would overflow a literal Pattern. The
-         *          jump count is still capped at MAX_PATTERN_JUMPS (the segmented matcher's fixed segment array). The
-         *          segment-0 anchor is computed after the parse.
+         *          jump count is still capped at MAX_PATTERN_JUMPS (the segmented matcher's fixed segment array), and
+         *          the class and group counts at the literal caps so both forms reject the same patterns. The segment-0
+         *          anchor is computed after the parse.
          * @param aob_str The AOB pattern string.
          * @return The compiled pattern, or std::nullopt on any parse failure (empty, malformed token, bad jump, or
          *         duplicate offset).
@@ -209,7 +276,8 @@ namespace DetourModKit
          * @brief Builds an EnginePattern from a public value-semantic scan::Pattern.
          * @param pattern The compiled value Pattern.
          * @param anchor_index The position the scan should prefilter on, already translated to the engine sentinel
-         *                      convention (anchor == size() means "no fully-known byte").
+         *                      convention (anchor == size() means "no fully-known byte"). The prefilter partner is
+         *                      selected for this anchor.
          * @return The heap-backed engine pattern. Allocates two small vectors, so callers on a noexcept path guard this
          *         against std::bad_alloc.
          */
@@ -277,7 +345,8 @@ namespace DetourModKit
          * @brief Internal raw scan primitive: locates the leftmost match and reports its start, end, and resolved
          * point.
          * @details The single dispatch point for both a plain single fixed-width pattern (the flat fixed-width fast
-         *          path) and a bounded-jump pattern (the segmented backtracking matcher). The page-walking sweeps and
+         *          path) and a bounded-jump pattern (the bit-parallel automaton when its span fits
+         *          BITAP_MAX_MATCH_LENGTH, the segmented backtracking matcher otherwise). The page-walking sweeps and
          *          the Nth-occurrence loop call this directly: they use RawMatch::start for self-exclusion and to
          *          continue past a hit, RawMatch::end to size the match, and RawMatch::point as the offset-applied
          *          result. The offset is baked into RawMatch::point so it is applied exactly once regardless of gap
@@ -295,6 +364,45 @@ namespace DetourModKit
          */
         [[nodiscard]] bool pattern_has_literal_byte(const EnginePattern &pattern) noexcept;
 
+        /**
+         * @struct AnchorClass
+         * @brief A nibble fingerprint of a set of anchor byte values, the one-byte form of the Teddy prefilter.
+         * @details Each value added to the set takes one of eight fingerprint bits and sets it in @ref lo at its low
+         *          nibble and in @ref hi at its high nibble; a byte b can be in the set only when lo[b & 0xF] &
+         *          hi[b >> 4] is nonzero. With at most eight values, one per bit, the test is exact; beyond that two
+         *          values sharing a bit can cross-combine their nibbles into a false positive, never a false negative,
+         *          so a caller that checks each hit exactly keeps its results unchanged.
+         */
+        struct AnchorClass
+        {
+            std::array<std::uint8_t, 16> lo{};
+            std::array<std::uint8_t, 16> hi{};
+
+            /// Adds @p value to the set under fingerprint bit @p bit (taken modulo 8).
+            constexpr void add(std::uint8_t value, unsigned bit) noexcept
+            {
+                const auto flag = static_cast<std::uint8_t>(1u << (bit & 7u));
+                lo[value & 0x0F] = static_cast<std::uint8_t>(lo[value & 0x0F] | flag);
+                hi[value >> 4] = static_cast<std::uint8_t>(hi[value >> 4] | flag);
+            }
+
+            /// True when @p value may be in the set (exact for at most eight values).
+            [[nodiscard]] constexpr bool may_contain(std::uint8_t value) const noexcept
+            {
+                return (lo[value & 0x0F] & hi[value >> 4]) != 0;
+            }
+        };
+
+        /**
+         * @brief Returns the first byte in [p, end) that @p set may contain, or @p end when none can.
+         * @details Lets a multi-pattern sweep skip runs of bytes no pattern is anchored on without a per-byte bucket
+         *          probe. On a host that passes the runtime AVX2 gate, 32 bytes are classified per iteration with two
+         *          VPSHUFB nibble lookups; otherwise, and for the sub-vector tail, a scalar loop applies the same
+         *          test. Reads only [p, end).
+         */
+        [[nodiscard]] const std::byte *find_anchor_class(const std::byte *p, const std::byte *end,
+                                                         const AnchorClass &set) noexcept;
+
         /**
          * @brief Reports the SIMD tier find_pattern matching uses at runtime.
          * @details Reflects compile-time support (which intrinsics were built) and runtime CPU detection (CPUID + OS
@@ -302,6 +410,55 @@ namespace DetourModKit
          *          the highest available lower tier.
          */
         [[nodiscard]] scan::SimdLevel active_simd_level() noexcept;
+
+        /// The widest tier this build and CPU support, before any calibrated ceiling.
+        [[nodiscard]] scan::SimdLevel detected_simd_level() noexcept;
+
+        /**
+         * @brief Caps the verify, prefilter and anchor-class tiers every later scan selects at @p ceiling.
+         * @details The backing store of scan::apply_simd_calibration. Raised to Sse2 (or the detected tier, when that
+         *          is lower), since the SSE2 body is the build's ungated baseline. A scan already running keeps the
+         *          tiers it hoisted.
+         */
+        void set_simd_ceiling(scan::SimdLevel ceiling) noexcept;
+
+        /// The ceiling set_simd_ceiling() last stored; Avx512 (no cap) until then.
+        [[nodiscard]] scan::SimdLevel simd_ceiling() noexcept;
+
+        /// Bytes one streaming-sweep block covers; the sweep prefetches and scans the region a block at a time.
+        inline constexpr std::size_t STREAMING_BLOCK_BYTES = 4096;
+
+        /// Blocks ahead of the scan position that a streaming sweep prefetches.
+        inline constexpr std::size_t STREAMING_PREFETCH_BLOCKS = 4;
+
+        /// Default region size from which the flat matcher streams; see set_streaming_sweep_threshold().
+        inline constexpr std::size_t STREAMING_SWEEP_BYTES = std::size_t{16} << 20;
+
+        /**
+         * @brief Sets the region size from which the flat matcher's prefilter sweep streams.
+         * @details A streaming sweep prefetches STREAMING_PREFETCH_BLOCKS blocks ahead with the non-temporal hint, so a
+         *          whole-process sweep over large heaps runs at memory bandwidth without filling the shared caches the
+         *          game's frame depends on. Below the threshold the sweep runs unchanged: a module-sized region is
+         *          cache-resident or prefetched well by the hardware, and the extra instructions would only cost.
+         *          Both modes find the same matches. SIZE_MAX disables streaming; 0 streams every sweep.
+         */
+        void set_streaming_sweep_threshold(std::size_t bytes) noexcept;
+
+        /// The threshold set_streaming_sweep_threshold() last stored; STREAMING_SWEEP_BYTES until then.
+        [[nodiscard]] std::size_t streaming_sweep_threshold() noexcept;
+
+        /// CPUID leaf 1 EAX (family, model, stepping), or 0 where CPUID cannot be read.
+        [[nodiscard]] std::uint32_t cpu_signature_word() noexcept;
+
+        /**
+         * @brief Runs the flat verify ladder at every position of [data, data + size) with tiers up to @p tier.
+         * @details The calibration kernel: the same verify_candidate body find_pattern runs per anchor hit, without
+         *          the prefilter, so timing it isolates the per-tier verify cost. @p tier is clamped to
+         *          detected_simd_level() and ignores the ceiling. The caller guarantees the range is readable.
+         * @return The number of positions that matched, so the sweep cannot be optimized away.
+         */
+        [[nodiscard]] std::size_t verify_sweep(scan::SimdLevel tier, const std::byte *data, std::size_t size,
+                                               const EnginePattern &pattern) noexcept;
     } // namespace detail
 } // namespace DetourModKit
 
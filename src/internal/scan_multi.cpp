@@ -0,0 +1,538 @@
+/**
+ * @file internal/scan_multi.cpp
+ * @brief Single-pass multi-pattern module scanning and the byte-tier ladder prescan built on it.
+ * @details The patterns of a batch are bucketed by anchor byte into one flat index (a counting sort, so each bucket is
+ *          a contiguous slice). Each contiguous readable run of the image is then swept once under the same TOCTOU
+ *          fault guard the serial page walk uses: a nibble-fingerprint prefilter (AVX2 where available) skips to the
+ *          next byte some pattern is anchored on, and only the bucket for that value is verified. Per-item
+ *          progress lives in a preallocated state array with a snapshot taken before each run, so a faulted run rolls
+ *          back exactly what it tallied without allocating inside the guard.
+ */
+
+#include "internal/scan_multi.hpp"
+
+#include "internal/memory_fault.hpp"
+#include "internal/scan_cache.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_shared.hpp"
+#include "internal/scan_telemetry.hpp"
+
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/logger.hpp"
+
+#include "fork_join.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // One pattern's entry in the anchor-bucketed index. Everything the inner verify loop touches is copied here
+        // so the sweep reads one contiguous array rather than chasing each EnginePattern's vectors.
+        struct MultiEntry
+        {
+            std::uint32_t item;
+            std::uint32_t anchor;
+            const std::byte *bytes;
+            const std::byte *mask;
+            std::size_t size;
+            std::ptrdiff_t offset;
+            // The pattern itself when it carries classes or groups for the exact check, else null.
+            const detail::EnginePattern *constrained;
+        };
+
+        // One swept pattern's own bytes buffer, [lo, hi).
+        struct NeedleRange
+        {
+            std::uintptr_t lo;
+            std::uintptr_t hi;
+        };
+
+        // Per-item sweep progress: how many counted matches were seen, the recorded occurrences, and how many the
+        // item needs (occurrence, plus one when the caller wants the next). Plain data so a run snapshot is a copy.
+        struct MultiState
+        {
+            std::size_t seen;
+            std::size_t occurrence;
+            std::size_t wanted;
+            const std::byte *match;
+            const std::byte *next;
+            bool done;
+        };
+
+        struct MultiIndex
+        {
+            // bucket_begin[b] .. bucket_begin[b + 1] is the slice of entries anchored on byte value b.
+            std::array<std::uint32_t, 257> bucket_begin{};
+            std::vector<MultiEntry> entries;
+            // Nibble fingerprint of the anchor values that own a non-empty bucket, so the sweep can skip runs of bytes
+            // no pattern is anchored on in vector-width steps instead of probing a bucket per byte.
+            detail::AnchorClass anchors;
+            // Every swept pattern's bytes buffer, sorted by address. Distinct heap allocations never overlap, so the
+            // buffers are ordered by both ends and one predecessor probe decides overlap.
+            std::vector<NeedleRange> needles;
+        };
+
+        // Self-exclusion, widened from the serial sweep's single needle to the whole batch: a readable scope can
+        // reach the heap, where a batch holding the same signature twice would otherwise see each copy's compiled
+        // buffer as a second occurrence of the other and fail both closed as ambiguous. Runs only on a verified
+        // match, so the binary search stays off the per-byte path.
+        [[nodiscard]] bool overlaps_needle(const MultiIndex &index, std::uintptr_t lo, std::uintptr_t hi) noexcept
+        {
+            const auto after = std::lower_bound(index.needles.begin(), index.needles.end(), hi,
+                                                [](const NeedleRange &needle, std::uintptr_t value) noexcept
+                                                { return needle.lo < value; });
+            return after != index.needles.begin() && std::prev(after)->hi > lo;
+        }
+
+        [[nodiscard]] bool masked_equal(const std::byte *candidate, const MultiEntry &entry) noexcept
+        {
+            for (std::size_t i = 0; i < entry.size; ++i)
+            {
+                if (((candidate[i] ^ entry.bytes[i]) & entry.mask[i]) != std::byte{0})
+                {
+                    return false;
+                }
+            }
+            return entry.constrained == nullptr || entry.constrained->constraints_hold_at(candidate, 0, entry.size);
+        }
+
+        // The unguarded sweep of one contiguous readable run [lo, hi). Every candidate start s = p - anchor is tested
+        // at most once per pattern, and because the anchor is fixed per pattern the starts a given pattern sees arrive
+        // in ascending order, so the per-item count is the same ascending occurrence count the serial scan keeps. No
+        // allocation and no destructors: this is the body the fault guard may abandon mid-run, so its telemetry is a
+        // plain call at the end rather than an EngineTally, and an abandoned run's work goes uncounted.
+        void sweep_run(const std::byte *lo, const std::byte *hi, const MultiIndex &index, MultiState *states,
+                       std::size_t &pending) noexcept
+        {
+            const MultiEntry *entries = index.entries.data();
+            std::uint64_t candidates = 0;
+            std::uint64_t verifies = 0;
+            for (const std::byte *p = lo; pending != 0; ++p)
+            {
+                p = detail::find_anchor_class(p, hi, index.anchors);
+                if (p == hi)
+                {
+                    break;
+                }
+                const auto value = std::to_integer<std::uint8_t>(*p);
+                const std::uint32_t first = index.bucket_begin[value];
+                const std::uint32_t last = index.bucket_begin[value + 1u];
+                for (std::uint32_t k = first; k < last; ++k)
+                {
+                    const MultiEntry &entry = entries[k];
+                    MultiState &state = states[entry.item];
+                    if (state.done)
+                    {
+                        continue;
+                    }
+                    if (static_cast<std::size_t>(p - lo) < entry.anchor)
+                    {
+                        continue;
+                    }
+                    ++candidates;
+                    const std::byte *start = p - entry.anchor;
+                    if (static_cast<std::size_t>(hi - start) < entry.size)
+                    {
+                        continue;
+                    }
+                    ++verifies;
+                    if (!masked_equal(start, entry))
+                    {
+                        continue;
+                    }
+                    const auto start_addr = reinterpret_cast<std::uintptr_t>(start);
+                    if (overlaps_needle(index, start_addr, start_addr + entry.size))
+                    {
+                        continue;
+                    }
+                    ++state.seen;
+                    if (state.seen == state.occurrence)
+                    {
+                        state.match = start + entry.offset;
+                    }
+                    else if (state.seen == state.occurrence + 1)
+                    {
+                        state.next = start + entry.offset;
+                    }
+                    if (state.seen == state.wanted)
+                    {
+                        state.done = true;
+                        --pending;
+                    }
+                }
+            }
+            detail::record_match_work(candidates, verifies, 0);
+        }
+
+        // Region-granular TOCTOU fault guard around sweep_run, the multi-pattern twin of scan_pages.cpp's
+        // scan_region_guarded: MSVC SEH through the shared guarded_fault_filter, or the MinGW x64 vectored guard. A
+        // 32-bit build is rejected by the architecture gate in defines.hpp. Returns false when a fault was swallowed.
+        [[nodiscard]] bool sweep_run_guarded(const std::byte *lo, const std::byte *hi, const MultiIndex &index,
+                                             MultiState *states, std::size_t &pending) noexcept
+        {
+#ifdef _MSC_VER
+            __try
+            {
+                sweep_run(lo, hi, index, states, pending);
+                return true;
+            }
+            __except (detail::guarded_fault_filter(GetExceptionInformation()))
+            {
+                return false;
+            }
+#elif defined(_WIN64)
+            struct SweepContext
+            {
+                const std::byte *lo;
+                const std::byte *hi;
+                const MultiIndex *index;
+                MultiState *states;
+                std::size_t *pending;
+            } sweep_ctx{lo, hi, &index, states, &pending};
+
+            const auto run_sweep = [](void *opaque) noexcept -> void
+            {
+                auto *context = static_cast<SweepContext *>(opaque);
+                sweep_run(context->lo, context->hi, *context->index, context->states, *context->pending);
+            };
+            return detail::run_guarded_region(reinterpret_cast<std::uintptr_t>(lo),
+                                              reinterpret_cast<std::uintptr_t>(hi), run_sweep, &sweep_ctx);
+#endif
+        }
+
+        // Best-effort fault diagnostics, matching the serial walk's report: a Debug line and the typed ScannerFault
+        // event. Neither may change the sweep result, so both swallow their own failures.
+        void report_faulted_runs(std::size_t faulted_runs, detail::ModuleSpan range) noexcept
+        {
+            if (faulted_runs == 0)
+            {
+                return;
+            }
+            try
+            {
+                (void)log().try_log(log_category::scan, LogLevel::Debug,
+                                    "Scanner: multi-pattern sweep skipped {} run(s) that faulted mid-scan "
+                                    "(concurrent decommit/reprotect).",
+                                    faulted_runs);
+            }
+            catch (...)
+            {
+            }
+            try
+            {
+                diagnostics::scanner_faults().emit_safe(diagnostics::ScannerFaultEvent{
+                    .faulted_regions = faulted_runs, .window_low = range.base, .window_high = range.end});
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // Returns the compiled byte Pattern for a byte-tier candidate, or nullptr for a text tier.
+        const scan::Pattern *byte_pattern_of(const scan::Candidate &candidate) noexcept
+        {
+            if (const scan::DirectPattern *direct = candidate.as_direct())
+            {
+                return &direct->pattern;
+            }
+            if (const scan::RipRelativePattern *rip = candidate.as_rip_relative())
+            {
+                return &rip->pattern;
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] bool same_group(const scan::ScanRequest &lhs, const scan::ScanRequest &rhs) noexcept
+        {
+            const detail::ModuleSpan a = detail::module_span(lhs.scope);
+            const detail::ModuleSpan b = detail::module_span(rhs.scope);
+            return a.base == b.base && a.end == b.end && lhs.pages == rhs.pages && rhs.regions == nullptr;
+        }
+    } // anonymous namespace
+
+    bool detail::multi_scan_eligible(const detail::EnginePattern &pattern) noexcept
+    {
+        return !pattern.empty() && pattern.jumps.empty() && pattern.anchor < pattern.size() &&
+               pattern.mask[pattern.anchor] == std::byte{0xFF};
+    }
+
+    std::vector<detail::MultiMatchResult> detail::scan_module_multi(std::span<const detail::BatchScanItem> items,
+                                                                    detail::ModuleSpan range, scan::Pages pages,
+                                                                    bool want_next)
+    {
+        std::vector<MultiMatchResult> results(items.size());
+        if (items.empty() || !range.valid() || (pages != scan::Pages::Readable && pages != scan::Pages::Executable))
+        {
+            return results;
+        }
+
+        // Partition: eligible items join the grouped sweep, every other live item keeps its own serial module scan so
+        // a bounded-jump pattern still runs under the segmented matcher's work budget.
+        std::vector<MultiState> states(items.size(), MultiState{});
+        std::array<std::uint32_t, 256> bucket_counts{};
+        std::size_t pending = 0;
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            const BatchScanItem &item = items[i];
+            if (item.pattern == nullptr || item.pattern->empty() || item.occurrence == 0)
+            {
+                states[i].done = true;
+                continue;
+            }
+            if (!multi_scan_eligible(*item.pattern))
+            {
+                states[i].done = true;
+                const MatchResult nth = scan_module_pages(*item.pattern, range, pages, item.occurrence);
+                results[i].match = nth.match;
+                results[i].incomplete = nth.incomplete;
+                if (want_next)
+                {
+                    const MatchResult after = scan_module_pages(*item.pattern, range, pages, item.occurrence + 1);
+                    results[i].next = after.match;
+                    results[i].next_incomplete = after.incomplete;
+                }
+                continue;
+            }
+            states[i].occurrence = item.occurrence;
+            states[i].wanted = item.occurrence + (want_next ? 1u : 0u);
+            ++bucket_counts[std::to_integer<std::uint8_t>(item.pattern->bytes[item.pattern->anchor])];
+            ++pending;
+        }
+        if (pending == 0)
+        {
+            return results;
+        }
+
+        // Counting sort into the flat bucketed index.
+        MultiIndex index;
+        unsigned distinct_anchors = 0;
+        for (std::size_t b = 0; b < 256; ++b)
+        {
+            index.bucket_begin[b + 1] = index.bucket_begin[b] + bucket_counts[b];
+            if (bucket_counts[b] != 0)
+            {
+                index.anchors.add(static_cast<std::uint8_t>(b), distinct_anchors++);
+            }
+        }
+        index.entries.resize(pending);
+        index.needles.reserve(pending);
+        std::array<std::uint32_t, 256> fill{};
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (states[i].done)
+            {
+                continue;
+            }
+            const EnginePattern &pattern = *items[i].pattern;
+            const auto value = std::to_integer<std::uint8_t>(pattern.bytes[pattern.anchor]);
+            const auto needle_lo = reinterpret_cast<std::uintptr_t>(pattern.bytes.data());
+            index.needles.push_back(NeedleRange{needle_lo, needle_lo + pattern.size()});
+            index.entries[index.bucket_begin[value] + fill[value]++] = MultiEntry{
+                .item = static_cast<std::uint32_t>(i),
+                .anchor = static_cast<std::uint32_t>(pattern.anchor),
+                .bytes = pattern.bytes.data(),
+                .mask = pattern.mask.data(),
+                .size = pattern.size(),
+                .offset = pattern.offset,
+                .constrained = pattern.has_constraints() ? &pattern : nullptr,
+            };
+        }
+        std::sort(index.needles.begin(), index.needles.end(),
+                  [](const NeedleRange &lhs, const NeedleRange &rhs) noexcept { return lhs.lo < rhs.lo; });
+
+        // Merge touching windows into contiguous runs: a match may straddle a protection split inside a run (both
+        // sides are readable), but never a gap, which is exactly the serial walk's carry rule.
+        const std::vector<ExecutableWindow> windows = collect_page_windows(range, pages);
+        std::vector<MultiState> snapshot(states.size());
+        std::size_t faulted_runs = 0;
+        std::size_t runs_swept = 0;
+        std::size_t bytes_swept = 0;
+        std::size_t w = 0;
+        while (w < windows.size() && pending != 0)
+        {
+            if (detail::batch_cancelled())
+            {
+                // The batch this sweep serves was cancelled: the runs left unread leave every open item incomplete,
+                // exactly as a faulted run does.
+                for (std::size_t i = 0; i < states.size(); ++i)
+                {
+                    if (!states[i].done)
+                    {
+                        results[i].incomplete = results[i].incomplete || states[i].seen < states[i].occurrence;
+                        results[i].next_incomplete = true;
+                    }
+                }
+                break;
+            }
+            const std::uintptr_t run_lo = windows[w].base;
+            std::uintptr_t run_hi = run_lo + windows[w].span;
+            ++w;
+            while (w < windows.size() && windows[w].base == run_hi)
+            {
+                run_hi += windows[w].span;
+                ++w;
+            }
+
+            ++runs_swept;
+            bytes_swept += static_cast<std::size_t>(run_hi - run_lo);
+            snapshot = states;
+            const std::size_t pending_before = pending;
+            if (!sweep_run_guarded(reinterpret_cast<const std::byte *>(run_lo),
+                                   reinterpret_cast<const std::byte *>(run_hi), index, states.data(), pending))
+            {
+                // A faulted run is skipped, not partially scanned: roll back what it tallied, then mark every item
+                // still short of its count incomplete, because the unread tail may hide an earlier occurrence.
+                states = snapshot;
+                pending = pending_before;
+                ++faulted_runs;
+                for (std::size_t i = 0; i < states.size(); ++i)
+                {
+                    if (states[i].done)
+                    {
+                        continue;
+                    }
+                    if (states[i].seen < states[i].occurrence)
+                    {
+                        results[i].incomplete = true;
+                    }
+                    results[i].next_incomplete = true;
+                }
+            }
+        }
+        report_faulted_runs(faulted_runs, range);
+        detail::record_page_walk(runs_swept, bytes_swept, faulted_runs);
+
+        for (std::size_t i = 0; i < states.size(); ++i)
+        {
+            if (states[i].occurrence == 0)
+            {
+                // A fallback or empty slot: its result was written during the partition.
+                continue;
+            }
+            results[i].match = states[i].match;
+            results[i].next = states[i].next;
+        }
+        return results;
+    }
+
+    detail::LadderPrescan detail::prescan_ladders(std::span<const scan::ScanRequest> requests)
+    {
+        LadderPrescan prescan;
+        prescan.offsets.resize(requests.size() + 1);
+        for (std::size_t r = 0; r < requests.size(); ++r)
+        {
+            prescan.offsets[r + 1] = prescan.offsets[r] + requests[r].ladder.size();
+        }
+        prescan.slots.resize(prescan.offsets.back());
+        prescan.present.assign(prescan.offsets.back(), 0);
+
+        // Group requests by (scope, page class); each group is one sweep. A request resolve() would reject outright
+        // (an invalid scope or page class) is left unswept so its own validation runs unchanged, and so is one scoped
+        // by a RegionSet, which resolve() scans itself.
+        std::vector<std::uint8_t> grouped(requests.size(), 0);
+        for (std::size_t leader = 0; leader < requests.size(); ++leader)
+        {
+            const scan::ScanRequest &head = requests[leader];
+            if (grouped[leader] != 0 || head.regions != nullptr || !module_span(head.scope).valid() ||
+                (head.pages != scan::Pages::Readable && head.pages != scan::Pages::Executable))
+            {
+                continue;
+            }
+
+            std::vector<std::size_t> members;
+            std::size_t candidate_total = 0;
+            for (std::size_t r = leader; r < requests.size(); ++r)
+            {
+                if (grouped[r] == 0 && same_group(head, requests[r]))
+                {
+                    grouped[r] = 1;
+                    // A request its cache will answer needs no sweep; should the resolver still reject the entry, it
+                    // scans that request itself, exactly as for an unprescanned slot.
+                    if (scan::ResolutionCache *const cache = request_cache(requests[r]);
+                        cache != nullptr &&
+                        ResolutionCacheAccess::probe(*cache, requests[r], module_span(requests[r].scope), false)
+                            .candidate_index)
+                    {
+                        continue;
+                    }
+                    members.push_back(r);
+                    candidate_total += requests[r].ladder.size();
+                }
+            }
+            if (candidate_total < MULTI_SCAN_MIN_PATTERNS)
+            {
+                continue;
+            }
+
+            // Compile every byte candidate against one shared haystack sample, exactly as resolve() does per request.
+            // The vector is reserved up front so the item pointers into it stay stable.
+            const HaystackHistogram histogram = sample_haystack(head.scope, head.pages);
+            std::vector<EnginePattern> compiled;
+            compiled.reserve(candidate_total);
+            std::vector<BatchScanItem> items;
+            std::vector<std::size_t> slot_of;
+            items.reserve(candidate_total);
+            slot_of.reserve(candidate_total);
+            for (const std::size_t r : members)
+            {
+                const std::span<const scan::Candidate> ladder = requests[r].ladder;
+                for (std::size_t k = 0; k < ladder.size(); ++k)
+                {
+                    const scan::Pattern *pattern = byte_pattern_of(ladder[k]);
+                    if (pattern == nullptr)
+                    {
+                        continue;
+                    }
+                    EnginePattern engine = to_engine_pattern(*pattern, histogram);
+                    if (!multi_scan_eligible(engine))
+                    {
+                        continue;
+                    }
+                    compiled.push_back(std::move(engine));
+                    items.push_back(BatchScanItem{&compiled.back(), 1});
+                    slot_of.push_back(prescan.offsets[r] + k);
+                }
+            }
+            if (items.size() < MULTI_SCAN_MIN_PATTERNS)
+            {
+                continue;
+            }
+
+            const std::vector<MultiMatchResult> swept =
+                scan_module_multi(items, module_span(head.scope), head.pages, true);
+            for (std::size_t i = 0; i < swept.size(); ++i)
+            {
+                prescan.slots[slot_of[i]] = swept[i];
+                prescan.present[slot_of[i]] = 1;
+            }
+        }
+        return prescan;
+    }
+
+    const detail::MultiMatchResult *detail::prescanned_match(const detail::LadderPrescan &prescan,
+                                                             std::size_t request_index,
+                                                             std::size_t ladder_index) noexcept
+    {
+        if (request_index + 1 >= prescan.offsets.size())
+        {
+            return nullptr;
+        }
+        const std::size_t slot = prescan.offsets[request_index] + ladder_index;
+        if (slot >= prescan.offsets[request_index + 1] || prescan.present[slot] == 0)
+        {
+            return nullptr;
+        }
+        return &prescan.slots[slot];
+    }
+} // namespace DetourModKit
@@ -0,0 +1,147 @@
+#ifndef DETOURMODKIT_INTERNAL_SCAN_MULTI_HPP
+#define DETOURMODKIT_INTERNAL_SCAN_MULTI_HPP
+
+/**
+ * @file internal/scan_multi.hpp
+ * @brief True-private single-pass multi-pattern scanner: every compiled pattern of a batch is verified in one sweep
+ *        per readable run instead of one full page walk per pattern.
+ * @details Never installed. The per-item batch scanners read the whole image once per pattern, so a manifest of a few
+ *          hundred signatures pays a few hundred full sweeps of a large .text. This engine groups every eligible
+ *          pattern by its anchor byte and walks each contiguous readable run of the image once: at each byte it
+ *          verifies only the patterns anchored on that value, so the sweep costs roughly one pass over the image
+ *          regardless of the pattern count. It keeps the serial scans' contract -- the same page gate, self-exclusion
+ *          of the needles' own buffers (widened to every pattern in the batch), ascending-address occurrence counting,
+ *          and fail-closed incomplete reporting when a run faults mid-sweep -- so a batch resolves identically
+ *          whichever path it takes. The ladder prescan layered on top feeds scan::resolve_batch and
+ *          anchor::resolve_all.
+ */
+
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_batch.hpp"
+#include "internal/scan_engine.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /**
+         * @brief Smallest batch for which the single-pass sweep replaces the per-item scans.
+         * @details Below this the per-pattern memchr sweeps are already cheap and the grouped sweep's per-byte bucket
+         *          probe would cost more than it saves, so small batches keep the per-item path.
+         */
+        inline constexpr std::size_t MULTI_SCAN_MIN_PATTERNS = 8;
+
+        /**
+         * @struct MultiMatchResult
+         * @brief One item's outcome from a single-pass multi-pattern sweep.
+         * @details @ref match is the Nth occurrence (offset-applied) and @ref next the (N+1)th when the sweep was asked
+         *          for it, so a uniqueness check needs no second scan. The two incomplete flags mirror
+         *          MatchResult::incomplete for the Nth and (N+1)th scans respectively: each is set when a run faulted
+         *          (or, on the per-item fallback, a bounded-jump budget was spent) before that occurrence was found,
+         *          leaving the count a lower bound.
+         */
+        struct MultiMatchResult
+        {
+            /// The Nth match (offset-applied) or nullptr.
+            const std::byte *match = nullptr;
+            /// The (N+1)th match (offset-applied) or nullptr; always nullptr unless the sweep was asked for it.
+            const std::byte *next = nullptr;
+            /// True when the Nth-occurrence count is only a lower bound.
+            bool incomplete = false;
+            /// True when the (N+1)th-occurrence count is only a lower bound.
+            bool next_incomplete = false;
+        };
+
+        /**
+         * @brief True when @p pattern can join the grouped single-pass sweep.
+         * @details The sweep verifies one fixed-width candidate start per anchor hit, so it takes a non-empty,
+         *          jump-free pattern whose anchor is a selected, fully-known byte. A bounded-jump pattern (which needs
+         *          the segmented matcher and its work budget) or an unanchored one keeps the per-pattern scan.
+         */
+        [[nodiscard]] bool multi_scan_eligible(const EnginePattern &pattern) noexcept;
+
+        /**
+         * @brief Resolves a batch of compiled patterns over one module image in a single grouped sweep.
+         * @param items The patterns to resolve. A null pattern, an empty pattern, or occurrence 0 yields an empty slot.
+         * @param range The mapped image to scan; an invalid range yields all-empty slots.
+         * @param pages The page-protection class to accept (the same gate as scan_module_pages).
+         * @param want_next Also record each item's (N+1)th occurrence, for a uniqueness check.
+         * @return One MultiMatchResult per input item, in input order.
+         * @details Eligible items (see @ref multi_scan_eligible) share one sweep per contiguous readable run; any other
+         *          non-null item falls back to its own scan_module_pages call, so every item resolves exactly as the
+         *          serial module scan would. A run that faults mid-sweep is skipped as a whole: matches seen in it are
+         *          discarded and every item still short of its count is marked incomplete, the same skip-and-fail-
+         *          closed contract the serial page walk follows.
+         * @note Setup/control-plane only: walks the image and allocates the bucket index.
+         */
+        [[nodiscard]] std::vector<MultiMatchResult> scan_module_multi(std::span<const BatchScanItem> items,
+                                                                      ModuleSpan range, scan::Pages pages,
+                                                                      bool want_next);
+
+        /**
+         * @struct LadderPrescan
+         * @brief Pre-swept byte-tier results for a set of ScanRequests, indexed by (request, ladder position).
+         * @details Built once before a batch resolve: every eligible Direct / RipRelative candidate of requests that
+         *          share a scope and page class is compiled and swept together through @ref scan_module_multi, so the
+         *          per-request resolver looks its first / second occurrence up instead of walking the image twice per
+         *          candidate. A slot that was not prescanned (a text tier, a bounded-jump pattern, or a group too small
+         *          to benefit) reads as absent and the resolver scans it itself. Immutable once built, so concurrent
+         *          workers share it without locking.
+         */
+        struct LadderPrescan
+        {
+            /// Start of each request's ladder in @ref slots; one entry per request plus a trailing end sentinel.
+            std::vector<std::size_t> offsets;
+            /// Per-candidate swept results, valid only where @ref present is set.
+            std::vector<MultiMatchResult> slots;
+            /// Per-candidate flag: 1 when the slot holds a swept result, 0 when the resolver must scan it itself.
+            std::vector<std::uint8_t> present;
+        };
+
+        /**
+         * @brief Builds the byte-tier prescan for @p requests.
+         * @return The prescan; empty (every slot absent) when no scope group reaches MULTI_SCAN_MIN_PATTERNS eligible
+         *         candidates. Allocates; a caller on a noexcept path guards it and resolves without a prescan on
+         *         std::bad_alloc, since the prescan is purely an accelerator.
+         * @note Setup/control-plane only.
+         */
+        [[nodiscard]] LadderPrescan prescan_ladders(std::span<const scan::ScanRequest> requests);
+
+        /// Returns the swept result for candidate @p ladder_index of request @p request_index, or nullptr when absent.
+        [[nodiscard]] const MultiMatchResult *prescanned_match(const LadderPrescan &prescan, std::size_t request_index,
+                                                               std::size_t ladder_index) noexcept;
+
+        /**
+         * @brief scan::resolve for request @p request_index of a batch, consulting @p prescan for its byte tiers.
+         * @details Identical to scan::resolve(request) in every outcome; a candidate with a prescanned slot reads its
+         *          occurrences from the slot instead of re-sweeping the image. Defined in scan_resolution.cpp.
+         * @note Setup/control-plane only, same constraints as scan::resolve.
+         */
+        [[nodiscard]] Result<scan::Hit> resolve_prescanned(const scan::ScanRequest &request,
+                                                           const LadderPrescan &prescan, std::size_t request_index);
+
+        /// The request scan::read_code_constant resolves @p code_constant's instruction site with.
+        [[nodiscard]] scan::ScanRequest code_constant_request(const scan::CodeConstant &code_constant,
+                                                              Region scope) noexcept;
+
+        /**
+         * @brief scan::read_code_constant for request @p request_index of a batch, its site resolved through
+         *        @ref resolve_prescanned.
+         * @details @p prescan must have been built over @ref code_constant_request of the same constant and scope.
+         *          Identical to scan::read_code_constant in every outcome. Defined in scan_code_constant.cpp.
+         * @note Setup/control-plane only, same constraints as scan::read_code_constant.
+         */
+        [[nodiscard]] Result<std::int64_t> read_code_constant_prescanned(const scan::CodeConstant &code_constant,
+                                                                         Region scope, const LadderPrescan &prescan,
+                                                                         std::size_t request_index);
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SCAN_MULTI_HPP
@@ -1,7 +1,8 @@
 /**
  * @file internal/scan_pages.cpp
- * @brief Page-gated AOB scanning: the VirtualQuery region walk, the per-region TOCTOU fault guard, the committed-window
- *        collector, and the executable-address / executable-range predicates.
+ * @brief Page-gated AOB scanning: the region walk (by PE section inside a loaded image, VirtualQuery elsewhere), the
+ *        per-region TOCTOU fault guard, the committed-window collector, the shared page snapshot, and the
+ *        executable-address / executable-range predicates.
  * @details Wraps the raw matcher in the OS page map so a scan over arbitrary process memory reads only committed pages
  *          of the requested protection class. The incomplete-scan state rides on a MatchResult return value (and an
  *          internal out-parameter) rather than a thread-local side channel, so concurrent scans cannot clobber each
@@ -15,18 +16,238 @@
 #include "DetourModKit/logger.hpp"
 
 #include "internal/memory_fault.hpp"
+#include "internal/scan_telemetry.hpp"
+
+#include "fork_join.hpp"
 
 #include <windows.h>
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace DetourModKit
 {
     namespace
     {
+        // The page snapshots installed on this thread by ScopedPageSnapshots. A batch item runs start to finish on one
+        // thread, so a thread-local installation reaches every page walk it makes -- through the resolver, the prescan,
+        // and the text-tier backends -- without threading a snapshot parameter through each of them.
+        thread_local std::span<const detail::PageSnapshot> t_page_snapshots{};
+
+        // The installed snapshot that fully covers [lo, hi), or nullptr. A whole-process window starts at 0, below
+        // every valid snapshot base, so a process-wide sweep always walks live.
+        const detail::PageSnapshot *covering_snapshot(std::uintptr_t lo, std::uintptr_t hi) noexcept
+        {
+            for (const detail::PageSnapshot &snapshot : t_page_snapshots)
+            {
+                if (snapshot.range.valid() && snapshot.range.base <= lo && hi <= snapshot.range.end)
+                {
+                    return &snapshot;
+                }
+            }
+            return nullptr;
+        }
+
+        // Matches an enumerating walk collects per guarded call. The visitor runs outside the fault guard, so a fault
+        // in caller code is never swallowed as a skipped region; each guarded call therefore stops once the batch is
+        // full and the walk delivers it and resumes the region from the byte after the last match start.
+        constexpr std::size_t ENUMERATION_BATCH = 64;
+
+        struct MatchBatch
+        {
+            std::array<const std::byte *, ENUMERATION_BATCH> points{};
+            std::size_t count = 0;
+            // Where the interrupted region scan resumes, or nullptr when the call reached the end of its span.
+            const std::byte *resume = nullptr;
+            // Bounded-jump work state carried across every resumed call over one region, so a batch boundary cannot
+            // reset the region-wide budget.
+            detail::SegmentedScanBudget budget{};
+        };
+
+        // The state of one detail::enumerate_module_pages walk, threaded through scan_regions_filtered.
+        struct Enumeration
+        {
+            detail::MatchVisitor visit = nullptr;
+            void *context = nullptr;
+            MatchBatch batch{};
+            detail::EnumerationResult result{};
+        };
+
+        // Base protections accepted by the executable-only sweeps: the three page variants that grant execute *and*
+        // read. Bare PAGE_EXECUTE (execute without a read bit) is excluded because dereferencing it raises an access
+        // violation; PAGE_GUARD / PAGE_NOACCESS are filtered separately inside scan_regions_filtered. This is the scope
+        // for code-only scans: the whole-process executable sweep and the prologue-recovery fallback, whose rebuilt
+        // near-JMP can only ever overwrite a code prologue.
+        constexpr DWORD EXECUTABLE_PAGE_FLAGS = PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+        // Base protections accepted by the readable sweep and the data-capable module-scoped scan: the
+        // executable-readable set plus the non-executable readable pages (.rdata / .data and read-only heaps). This
+        // reaches C++ vtables, RTTI type descriptors, and other read-only metadata the executable-only sweep cannot
+        // see.
+        constexpr DWORD READABLE_PAGE_FLAGS = EXECUTABLE_PAGE_FLAGS | PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY;
+
+        // The PE format caps a loadable image at 96 sections; a header declaring more is walked live, not by section.
+        constexpr std::uint16_t MAX_IMAGE_SECTIONS = 96;
+
+        // A page's protection class: the two bits every gate in this TU decides on. Two protections of one class pass
+        // or fail every accept mask alike, so the copy-on-write split of a written .data page (PAGE_WRITECOPY next to
+        // PAGE_READWRITE) or a hook's PAGE_EXECUTE_READWRITE island in .text does not change what a walk accepts.
+        constexpr DWORD CLASS_READABLE = 1;
+        constexpr DWORD CLASS_EXECUTABLE = 2;
+
+        [[nodiscard]] DWORD page_class(DWORD protect) noexcept
+        {
+            if ((protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0)
+                return 0;
+            return ((protect & READABLE_PAGE_FLAGS) != 0 ? CLASS_READABLE : 0) |
+                   ((protect & EXECUTABLE_PAGE_FLAGS) != 0 ? CLASS_EXECUTABLE : 0);
+        }
+
+        // The class the loader gives a section from its characteristics: readable when IMAGE_SCN_MEM_READ is set, and
+        // executable as well when IMAGE_SCN_MEM_EXECUTE is (execute without read is PAGE_EXECUTE, which no gate
+        // accepts).
+        [[nodiscard]] DWORD section_class(DWORD characteristics) noexcept
+        {
+            if ((characteristics & IMAGE_SCN_MEM_READ) == 0)
+                return 0;
+            return CLASS_READABLE | ((characteristics & IMAGE_SCN_MEM_EXECUTE) != 0 ? CLASS_EXECUTABLE : 0);
+        }
+
+        // One stretch of a loaded image whose class the header predicts: the header pages, then each section rounded
+        // up to the section alignment.
+        struct ImageSegment
+        {
+            std::uintptr_t lo = 0;
+            std::uintptr_t hi = 0;
+            DWORD page_class = 0;
+        };
+
+        struct ImageLayout
+        {
+            std::array<ImageSegment, MAX_IMAGE_SECTIONS + 1> segments{};
+            std::size_t count = 0;
+        };
+
+        // Reads the section layout of the loaded image at image_base in one pass over its headers (every read
+        // guarded). Accepts only the layout the loader itself produces -- page-aligned sections laid end to end from
+        // the header pages to SizeOfImage -- so the segments tile the image exactly; anything else returns false and
+        // the caller walks the image live.
+        [[nodiscard]] bool read_image_layout(std::uintptr_t image_base, ImageLayout &layout) noexcept
+        {
+            const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(image_base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0)
+                return false;
+            const std::uintptr_t nt_addr = image_base + static_cast<std::uintptr_t>(dos->e_lfanew);
+            const std::optional<IMAGE_NT_HEADERS64> nt = detail::guarded_read<IMAGE_NT_HEADERS64>(nt_addr);
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+                nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC ||
+                nt->FileHeader.NumberOfSections > MAX_IMAGE_SECTIONS)
+                return false;
+            // Below a page, sections share pages and the loader maps the image under one protection; walk it live.
+            const std::size_t alignment = nt->OptionalHeader.SectionAlignment;
+            if (alignment < 0x1000 || (alignment & (alignment - 1)) != 0)
+                return false;
+
+            std::array<IMAGE_SECTION_HEADER, MAX_IMAGE_SECTIONS> sections{};
+            const std::size_t count = nt->FileHeader.NumberOfSections;
+            const std::uintptr_t table_addr =
+                nt_addr + offsetof(IMAGE_NT_HEADERS64, OptionalHeader) + nt->FileHeader.SizeOfOptionalHeader;
+            if (!detail::guarded_read_bytes(table_addr, sections.data(), count * sizeof(IMAGE_SECTION_HEADER)))
+                return false;
+
+            const std::size_t image_bytes = nt->OptionalHeader.SizeOfImage;
+            const auto align_up = [alignment](std::size_t value) noexcept
+            { return (value + alignment - 1) & ~(alignment - 1); };
+            std::size_t cursor = align_up(nt->OptionalHeader.SizeOfHeaders);
+            if (cursor == 0 || cursor > image_bytes)
+                return false;
+            layout.segments[0] = ImageSegment{image_base, image_base + cursor, CLASS_READABLE};
+            layout.count = 1;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const IMAGE_SECTION_HEADER &section = sections[i];
+                const std::size_t va = section.VirtualAddress;
+                const std::size_t span =
+                    section.Misc.VirtualSize != 0 ? section.Misc.VirtualSize : section.SizeOfRawData;
+                if (va != cursor || span == 0 || span > image_bytes - va)
+                    return false;
+                const std::size_t end = align_up(va + span);
+                if (end > image_bytes)
+                    return false;
+                layout.segments[layout.count++] =
+                    ImageSegment{image_base + va, image_base + end, section_class(section.Characteristics)};
+                cursor = end;
+            }
+            return cursor == image_bytes;
+        }
+
+        // Visits the live page regions of [lo, hi) in address order, each clamped to the window, as (base, end, state,
+        // protect). Returns true when the visitor stopped the walk by returning true. Throws only what the visitor
+        // throws, so the collectors that allocate share it with the noexcept scans.
+        template <typename Visit> bool query_regions(std::uintptr_t lo, std::uintptr_t hi, Visit &visit)
+        {
+            MEMORY_BASIC_INFORMATION mbi{};
+            std::uintptr_t addr = lo;
+            while (addr < hi && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)))
+            {
+                const auto region_base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+                const std::uintptr_t region_end = region_base + mbi.RegionSize;
+                assert(region_end > addr && "VirtualQuery returned a non-advancing region");
+                if (region_end <= addr)
+                    break; // Overflow guard.
+                if (visit(region_base < lo ? lo : region_base, region_end > hi ? hi : region_end, mbi.State,
+                          mbi.Protect))
+                    return true;
+                addr = region_end;
+            }
+            return false;
+        }
+
+        // The page walk every module-scoped scan, collector, and snapshot shares. A window inside a loader-mapped
+        // image (MEM_IMAGE) is walked by the image's own section table: one query at the start of each section
+        // confirms the live class there matches the header's prediction, and the section is then visited as a single
+        // region with that protection instead of one region per VirtualQuery split. A section whose first page
+        // disagrees -- an unpacker's reprotected code, a guard page -- is walked live, as is any window that is not
+        // inside a well-formed image. Pages past a section's first that changed class are not observed; an unreadable
+        // one still faults under the per-region guard, which skips the section and reports the scan incomplete.
+        template <typename Visit> void walk_page_regions(std::uintptr_t lo, std::uintptr_t hi, Visit &&visit)
+        {
+            MEMORY_BASIC_INFORMATION first{};
+            ImageLayout layout;
+            if (lo < hi && VirtualQuery(reinterpret_cast<LPCVOID>(lo), &first, sizeof(first)) != 0 &&
+                first.Type == MEM_IMAGE &&
+                read_image_layout(reinterpret_cast<std::uintptr_t>(first.AllocationBase), layout) &&
+                layout.segments[0].lo <= lo && hi <= layout.segments[layout.count - 1].hi)
+            {
+                for (std::size_t i = 0; i < layout.count; ++i)
+                {
+                    const ImageSegment &segment = layout.segments[i];
+                    const std::uintptr_t segment_lo = segment.lo < lo ? lo : segment.lo;
+                    const std::uintptr_t segment_hi = segment.hi > hi ? hi : segment.hi;
+                    if (segment_hi <= segment_lo)
+                        continue;
+                    MEMORY_BASIC_INFORMATION mbi{};
+                    if (VirtualQuery(reinterpret_cast<LPCVOID>(segment_lo), &mbi, sizeof(mbi)) != 0 &&
+                        mbi.State == MEM_COMMIT && page_class(mbi.Protect) == segment.page_class)
+                    {
+                        if (visit(segment_lo, segment_hi, mbi.State, mbi.Protect))
+                            return;
+                        continue;
+                    }
+                    if (query_regions(segment_lo, segment_hi, visit))
+                        return;
+                }
+                return;
+            }
+            (void)query_regions(lo, hi, visit);
+        }
+
         // Scan one protection-gated region for the next needed match, decrementing matches_remaining for each counted,
         // non-self match. Returns the resolved point (offset-applied) when the Nth match lands in this region, or
         // nullptr when the region is exhausted first. This is the body the TOCTOU fault guard wraps (see
@@ -42,10 +263,20 @@ namespace DetourModKit
         // the match's true end (RawMatch::end), not a fixed pattern length, is what keeps this correct for a
         // variable-length bounded-jump match, where a fixed-length overlap would double-count a short match near the
         // boundary.
+        //
+        // start_limit is the first start address this scan does not own. The split scan hands each chunk worker a
+        // window that runs max_match_length() - 1 bytes past its chunk so a match straddling the chunk end is still
+        // found, and the limit keeps a match that merely begins in that tail (the next chunk's match) from being
+        // counted twice. Matches arrive in ascending start order, so the first one at or past the limit ends the scan.
+        // Every unsplit caller passes UINTPTR_MAX, which no match start can reach.
+        //
+        // With a batch the scan counts nothing: it records each counted match in the batch and, once the batch is
+        // full, stops with the batch's resume point set (see MatchBatch).
         const std::byte *scan_region_for_match(const std::byte *region_start, std::size_t scan_size,
                                                const detail::EnginePattern &pattern, std::uintptr_t needle_lo,
                                                std::uintptr_t needle_hi, std::uintptr_t count_floor,
-                                               std::size_t &matches_remaining, bool &out_budget_exhausted) noexcept
+                                               std::uintptr_t start_limit, std::size_t &matches_remaining,
+                                               bool &out_budget_exhausted, MatchBatch *batch) noexcept
         {
             // One SegmentedScanBudget stays live across every find_pattern_raw suffix call below. A bounded-jump sweep
             // whose per-position or region-wide backtracking budget was spent (RawMatch::budget_exhausted) leaves the
@@ -53,13 +284,16 @@ namespace DetourModKit
             // / uniqueness check closed. The flag is meaningful even when no match is found: a truncated no-match
             // is not a proven absence.
             out_budget_exhausted = false;
-            detail::SegmentedScanBudget segmented_budget{};
+            detail::SegmentedScanBudget local_budget{};
+            detail::SegmentedScanBudget &segmented_budget = batch != nullptr ? batch->budget : local_budget;
             detail::RawMatch match = detail::find_pattern_raw(region_start, scan_size, pattern, &segmented_budget);
             out_budget_exhausted = out_budget_exhausted || match.budget_exhausted;
             while (match.start != nullptr)
             {
                 const auto match_addr = reinterpret_cast<std::uintptr_t>(match.start);
                 const auto match_end = reinterpret_cast<std::uintptr_t>(match.end);
+                if (match_addr >= start_limit)
+                    break;
                 // The match spans [match_addr, match_end); it overlaps the needle's own bytes buffer iff those ranges
                 // intersect. Using the true end (not a fixed pattern length) keeps this exact for a jump match.
                 const bool self_match = match_addr < needle_hi && match_end > needle_lo;
@@ -68,9 +302,22 @@ namespace DetourModKit
                 const bool already_counted = match_end <= count_floor;
                 if (!self_match && !already_counted)
                 {
-                    --matches_remaining;
-                    if (matches_remaining == 0)
-                        return match.point;
+                    if (batch != nullptr)
+                    {
+                        batch->points[batch->count] = match.point;
+                        ++batch->count;
+                        if (batch->count == batch->points.size())
+                        {
+                            batch->resume = match.start + 1;
+                            return nullptr;
+                        }
+                    }
+                    else
+                    {
+                        --matches_remaining;
+                        if (matches_remaining == 0)
+                            return match.point;
+                    }
                 }
 
                 // Continue scanning past the current match START (not its variable end).
@@ -97,8 +344,9 @@ namespace DetourModKit
         const std::byte *scan_region_guarded(const std::byte *region_start, std::size_t scan_size,
                                              const detail::EnginePattern &pattern, std::uintptr_t needle_lo,
                                              std::uintptr_t needle_hi, std::uintptr_t count_floor,
-                                             std::size_t &matches_remaining, bool &out_faulted,
-                                             bool &out_budget_exhausted) noexcept
+                                             std::uintptr_t start_limit, std::size_t &matches_remaining,
+                                             bool &out_faulted, bool &out_budget_exhausted,
+                                             MatchBatch *batch = nullptr) noexcept
         {
             // A 64-bit target is guaranteed by the single architecture gate in defines.hpp (a 32-bit or non-x86
             // configure fails there with one clear #error), so this function carries only the two supported x64 arms:
@@ -111,7 +359,7 @@ namespace DetourModKit
             __try
             {
                 return scan_region_for_match(region_start, scan_size, pattern, needle_lo, needle_hi, count_floor,
-                                             matches_remaining, out_budget_exhausted);
+                                             start_limit, matches_remaining, out_budget_exhausted, batch);
             }
             __except (detail::guarded_fault_filter(GetExceptionInformation()))
             {
@@ -137,12 +385,13 @@ namespace DetourModKit
                 std::uintptr_t needle_lo;
                 std::uintptr_t needle_hi;
                 std::uintptr_t count_floor;
+                std::uintptr_t start_limit;
                 std::size_t *matches_remaining;
                 bool *budget_exhausted;
+                MatchBatch *batch;
                 const std::byte *result;
-            } scan_ctx{region_start, scan_size,   &pattern,           needle_lo,
-                       needle_hi,    count_floor, &matches_remaining, &out_budget_exhausted,
-                       nullptr};
+            } scan_ctx{region_start, scan_size,   &pattern,           needle_lo,             needle_hi, count_floor,
+                       start_limit,  &matches_remaining, &out_budget_exhausted, batch,     nullptr};
 
             const std::size_t original_matches_remaining = matches_remaining;
             const auto run_scan = [](void *opaque) noexcept -> void
@@ -150,7 +399,8 @@ namespace DetourModKit
                 auto *context = static_cast<ScanContext *>(opaque);
                 context->result = scan_region_for_match(context->region_start, context->scan_size, *context->pattern,
                                                         context->needle_lo, context->needle_hi, context->count_floor,
-                                                        *context->matches_remaining, *context->budget_exhausted);
+                                                        context->start_limit, *context->matches_remaining,
+                                                        *context->budget_exhausted, context->batch);
             };
 
             const auto span_lo = reinterpret_cast<std::uintptr_t>(region_start);
@@ -169,13 +419,13 @@ namespace DetourModKit
         }
 
         // Region-walking AOB scan shared by the whole-process scans and the module-scoped entry points. Walks the
-        // committed regions of [window_lo, window_hi) via VirtualQuery and runs the per-region scan
-        // (scan_region_for_match, behind the fault guard) against every region whose base protection is present in
-        // accept_mask, returning the Nth match (1-based, adjusted by pattern.offset) or nullptr. The whole-process
-        // scanners pass [0, UINTPTR_MAX); the module-scoped scan passes the image's [base, end) so only one contiguous
-        // image is searched. *out_incomplete is set true when any region faulted mid-scan and was skipped, or its
-        // bounded-jump matcher exhausted the region-wide work budget, so the caller can tell that an occurrence count
-        // is only a lower bound.
+        // committed regions of [window_lo, window_hi) via walk_page_regions (by section inside a loaded image,
+        // VirtualQuery otherwise) and runs the per-region scan (scan_region_for_match, behind the fault guard) against
+        // every region whose base protection is present in accept_mask, returning the Nth match (1-based, adjusted by
+        // pattern.offset) or nullptr. The whole-process scanners pass [0, UINTPTR_MAX); the module-scoped scan passes
+        // the image's [base, end) so only one contiguous image is searched. *out_incomplete is set true when any region
+        // faulted mid-scan and was skipped, or its bounded-jump matcher exhausted the region-wide work budget, so the
+        // caller can tell that an occurrence count is only a lower bound.
         //
         // Guard, no-access, and uncommitted regions are always skipped: PAGE_GUARD raises STATUS_GUARD_PAGE_VIOLATION
         // on the first touch and PAGE_NOACCESS faults even for reads, so neither is safe to dereference. The Windows
@@ -195,9 +445,23 @@ namespace DetourModKit
         // scan_region_for_match receives the region's true start as a count floor and counts only a match whose end
         // reaches past it. The floor, not the carry width, is what prevents a double count, which is why a
         // variable-length bounded-jump match stays correctly counted across the split.
+        //
+        // start_limit forwards to scan_region_for_match (matches starting at or past it are not this walk's to count)
+        // and, when out_counted is non-null, it receives how many matches the walk counted before it stopped -- the
+        // split scan sums these per-chunk tallies to locate the chunk holding the Nth match.
+        //
+        // With an enumeration the walk has no Nth match: it drains every accepted region batch by batch, hands each
+        // match to the visitor in address order, and stops only when the visitor declines one. The faulted and
+        // budget-exhausted states are reported separately in its result.
+        //
+        // Before each region the walk polls the cancellation of the batch it runs for (detail::batch_cancelled). A
+        // cancelled walk stops there and reports itself incomplete, since the regions it never reached could hold a
+        // match; an enumeration reports it as faulted.
         const std::byte *scan_regions_filtered(const detail::EnginePattern &pattern, std::size_t occurrence,
                                                DWORD accept_mask, std::uintptr_t window_lo, std::uintptr_t window_hi,
-                                               bool &out_incomplete) noexcept
+                                               bool &out_incomplete, std::uintptr_t start_limit = UINTPTR_MAX,
+                                               std::size_t *out_counted = nullptr,
+                                               Enumeration *enumeration = nullptr) noexcept
         {
             // The compiled pattern's own bytes buffer lives in readable heap memory, so a whole-process readable sweep
             // would match the needle against itself and could return the caller's pattern storage instead of the
@@ -211,11 +475,13 @@ namespace DetourModKit
             std::size_t matches_remaining = occurrence;
             std::size_t faulted_regions = 0;
             std::size_t total_faulted = 0;
+            // Scan telemetry: the regions and bytes handed to the matcher (dead stores in a build without it).
+            std::size_t regions_scanned = 0;
+            std::size_t bytes_scanned = 0;
             // Latches true once any region's segmented scan spent its backtracking budget; folded into out_incomplete
             // alongside the faulted-region count so a truncated bounded-jump sweep fails an occurrence check closed.
             bool budget_exhausted_total = false;
-            MEMORY_BASIC_INFORMATION mbi{};
-            std::uintptr_t addr = window_lo;
+            bool cancelled = false;
 
             // Contiguous-accepted-run tracking for the cross-boundary overlap (see the function comment).
             // prev_accept_hi is the end of the previous accepted region; run_lo is the start of the run of contiguous
@@ -238,7 +504,7 @@ namespace DetourModKit
                 try
                 {
                     (void)log().try_log(
-                        LogLevel::Debug,
+                        log_category::scan, LogLevel::Debug,
                         "Scanner: skipped {} region(s) that faulted mid-scan (concurrent decommit/reprotect).",
                         faulted_regions);
                 }
@@ -259,12 +525,12 @@ namespace DetourModKit
                 faulted_regions = 0;
             };
 
-            while (addr < window_hi && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)))
+            // Scans one region of the walk; gate_passed is the per-region protection gate (MEM_COMMIT, the class mask,
+            // not PAGE_GUARD / PAGE_NOACCESS). Returns true once the Nth match is found, leaving it in `found`.
+            const std::byte *found = nullptr;
+            const auto visit_region = [&](std::uintptr_t region_base, std::uintptr_t region_end,
+                                          bool gate_passed) noexcept -> bool
             {
-                const bool protection_unsafe = (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
-                const auto region_base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
-                const std::uintptr_t region_end = region_base + mbi.RegionSize;
-
                 // Clamp the region to the requested window so a region that straddles window_lo / window_hi is
                 // inspected only where it intersects. For a whole-process sweep the window is [0, UINTPTR_MAX), so the
                 // clamp is a no-op and the scanned span equals the region. For a module-scoped sweep this is what keeps
@@ -273,93 +539,159 @@ namespace DetourModKit
                 const std::uintptr_t scan_lo = region_base < window_lo ? window_lo : region_base;
                 const std::uintptr_t scan_hi = region_end > window_hi ? window_hi : region_end;
 
-                if (mbi.State == MEM_COMMIT && (mbi.Protect & accept_mask) != 0 && !protection_unsafe &&
-                    scan_hi > scan_lo)
+                if (!gate_passed || scan_hi <= scan_lo)
                 {
-                    // Continue the accepted run only when this region begins exactly where the previous accepted one
-                    // ended; otherwise restart it here. Done before computing the overlap so run_lo reflects the run
-                    // scan_lo joins.
-                    if (!prev_accepted || prev_accept_hi != scan_lo)
-                    {
-                        run_lo = scan_lo;
-                    }
+                    prev_accepted = false;
+                    return false;
+                }
+                if (detail::batch_cancelled())
+                {
+                    cancelled = true;
+                    return true;
+                }
 
-                    // Extend the scan back into the contiguous accepted run so a match that begins in the previous
-                    // region's tail and ends in this one is found. The carry is max_match_length() - 1, the longest
-                    // span a match can occupy minus one (for a plain pattern that is just size() - 1, so the common
-                    // case is unchanged; a bounded-jump match can span farther, so its carry is wider). Bounded by
-                    // run_lo so the read stays inside already-gated bytes. Re-counting an interior match that lies
-                    // wholly in the previous region is prevented by the count floor (scan_lo) passed below, not by the
-                    // carry width -- a variable-length match needs the explicit floor because a fixed carry cannot both
-                    // catch a long straddling match and exclude a short interior one.
-                    std::uintptr_t effective_scan_lo = scan_lo;
-                    const std::size_t match_span = pattern.max_match_length();
-                    if (match_span > 1 && scan_lo > run_lo)
-                    {
-                        const std::uintptr_t max_overlap = static_cast<std::uintptr_t>(match_span - 1);
-                        const std::uintptr_t available = scan_lo - run_lo;
-                        effective_scan_lo = scan_lo - ((max_overlap < available) ? max_overlap : available);
-                    }
+                // Continue the accepted run only when this region begins exactly where the previous accepted one
+                // ended; otherwise restart it here. Done before computing the overlap so run_lo reflects the run
+                // scan_lo joins.
+                if (!prev_accepted || prev_accept_hi != scan_lo)
+                {
+                    run_lo = scan_lo;
+                }
+
+                // Extend the scan back into the contiguous accepted run so a match that begins in the previous
+                // region's tail and ends in this one is found. The carry is max_match_length() - 1, the longest
+                // span a match can occupy minus one (for a plain pattern that is just size() - 1, so the common
+                // case is unchanged; a bounded-jump match can span farther, so its carry is wider). Bounded by
+                // run_lo so the read stays inside already-gated bytes. Re-counting an interior match that lies
+                // wholly in the previous region is prevented by the count floor (scan_lo) passed below, not by the
+                // carry width -- a variable-length match needs the explicit floor because a fixed carry cannot both
+                // catch a long straddling match and exclude a short interior one.
+                std::uintptr_t effective_scan_lo = scan_lo;
+                const std::size_t match_span = pattern.max_match_length();
+                if (match_span > 1 && scan_lo > run_lo)
+                {
+                    const std::uintptr_t max_overlap = static_cast<std::uintptr_t>(match_span - 1);
+                    const std::uintptr_t available = scan_lo - run_lo;
+                    effective_scan_lo = scan_lo - ((max_overlap < available) ? max_overlap : available);
+                }
+
+                const std::size_t scan_size = static_cast<std::size_t>(scan_hi - effective_scan_lo);
+                if (scan_size >= pattern.size())
+                {
+                    const auto *region_start = reinterpret_cast<const std::byte *>(effective_scan_lo);
+                    ++regions_scanned;
+                    bytes_scanned += scan_size;
 
-                    const std::size_t scan_size = static_cast<std::size_t>(scan_hi - effective_scan_lo);
-                    if (scan_size >= pattern.size())
+                    // The protection gate proved the region readable at gate time; scan_region_guarded backstops a
+                    // concurrent decommit / reprotect that could fault the read after the gate (a TOCTOU the gate
+                    // cannot close). A faulted region is skipped and counted, not fatal. scan_lo is the count floor:
+                    // matches that ended before it were already tallied by the previous region.
+                    bool region_faulted = false;
+                    bool region_budget_exhausted = false;
+                    if (enumeration != nullptr)
                     {
-                        const auto *region_start = reinterpret_cast<const std::byte *>(effective_scan_lo);
-
-                        // The protection gate above proved the region readable at gate time; scan_region_guarded
-                        // backstops a concurrent decommit / reprotect that could fault the read after the gate (a
-                        // TOCTOU the gate cannot close). A faulted region is skipped and counted, not fatal. scan_lo is
-                        // the count floor: matches that ended before it were already tallied by the previous region.
-                        bool region_faulted = false;
-                        bool region_budget_exhausted = false;
-                        const std::byte *result =
-                            scan_region_guarded(region_start, scan_size, pattern, needle_lo, needle_hi, scan_lo,
-                                                matches_remaining, region_faulted, region_budget_exhausted);
-                        // A spent bounded-jump backtracking budget makes any occurrence count a lower bound, exactly
-                        // like a skipped faulted region, so it feeds the same incomplete signal. Accumulated before the
-                        // match-found return so a match resolved in a truncated region is still reported incomplete.
-                        budget_exhausted_total = budget_exhausted_total || region_budget_exhausted;
-                        if (result != nullptr)
+                        MatchBatch &batch = enumeration->batch;
+                        batch.budget = detail::SegmentedScanBudget{};
+                        const std::byte *cursor = region_start;
+                        std::size_t remaining = scan_size;
+                        bool stopped = false;
+                        while (!stopped)
                         {
-                            report_faulted_regions();
-                            out_incomplete = total_faulted > 0 || budget_exhausted_total;
-                            return result;
+                            batch.count = 0;
+                            batch.resume = nullptr;
+                            bool call_budget_exhausted = false;
+                            (void)scan_region_guarded(cursor, remaining, pattern, needle_lo, needle_hi, scan_lo,
+                                                      start_limit, matches_remaining, region_faulted,
+                                                      call_budget_exhausted, &batch);
+                            region_budget_exhausted = region_budget_exhausted || call_budget_exhausted;
+                            // Matches collected before a fault were read intact and are delivered; the fault still
+                            // skips the rest of the region and marks the walk faulted.
+                            for (std::size_t i = 0; i < batch.count && !stopped; ++i)
+                            {
+                                stopped = !enumeration->visit(enumeration->context, batch.points[i]);
+                                enumeration->result.matches += stopped ? 0 : 1;
+                            }
+                            if (region_faulted || batch.resume == nullptr)
+                                break;
+                            remaining -= static_cast<std::size_t>(batch.resume - cursor);
+                            cursor = batch.resume;
+                            if (remaining < pattern.size())
+                                break;
                         }
+                        budget_exhausted_total = budget_exhausted_total || region_budget_exhausted;
                         if (region_faulted)
                             ++faulted_regions;
+                        if (stopped)
+                        {
+                            enumeration->result.stopped = true;
+                            return true;
+                        }
+                        prev_accepted = true;
+                        prev_accept_hi = scan_hi;
+                        return false;
                     }
-
-                    prev_accepted = true;
-                    prev_accept_hi = scan_hi;
+                    const std::byte *result =
+                        scan_region_guarded(region_start, scan_size, pattern, needle_lo, needle_hi, scan_lo,
+                                            start_limit, matches_remaining, region_faulted, region_budget_exhausted);
+                    // A spent bounded-jump backtracking budget makes any occurrence count a lower bound, exactly like
+                    // a skipped faulted region, so it feeds the same incomplete signal. Accumulated before the
+                    // match-found return so a match resolved in a truncated region is still reported incomplete.
+                    budget_exhausted_total = budget_exhausted_total || region_budget_exhausted;
+                    if (result != nullptr)
+                    {
+                        found = result;
+                        return true;
+                    }
+                    if (region_faulted)
+                        ++faulted_regions;
                 }
-                else
+
+                prev_accepted = true;
+                prev_accept_hi = scan_hi;
+                return false;
+            };
+
+            // A batch that installed a snapshot of this image replays its recorded gate instead of re-querying every
+            // region. The snapshot holds only readable regions, so a gap between two entries breaks the accepted run
+            // exactly as the rejected region between them does in the live walk.
+            if (const detail::PageSnapshot *snapshot = covering_snapshot(window_lo, window_hi))
+            {
+                for (const detail::PageSnapshotRegion &region : snapshot->regions)
                 {
-                    prev_accepted = false;
+                    if (region.end <= window_lo)
+                        continue;
+                    if (region.base >= window_hi)
+                        break;
+                    if (visit_region(region.base, region.end, (region.protect & accept_mask) != 0))
+                        break;
                 }
-
-                assert(region_end > addr && "VirtualQuery returned a non-advancing region");
-                if (region_end <= addr)
-                    break; // Overflow guard.
-                addr = region_end;
+            }
+            else
+            {
+                walk_page_regions(window_lo, window_hi,
+                                  [&](std::uintptr_t region_base, std::uintptr_t region_end, DWORD state,
+                                      DWORD protect) noexcept -> bool
+                                  {
+                                      const bool protection_unsafe = (protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
+                                      const bool gate_passed =
+                                          state == MEM_COMMIT && (protect & accept_mask) != 0 && !protection_unsafe;
+                                      return visit_region(region_base, region_end, gate_passed);
+                                  });
             }
 
             report_faulted_regions();
-            out_incomplete = total_faulted > 0 || budget_exhausted_total;
-            return nullptr;
+            detail::record_page_walk(regions_scanned, bytes_scanned, total_faulted);
+            out_incomplete = total_faulted > 0 || budget_exhausted_total || cancelled;
+            if (enumeration != nullptr)
+            {
+                enumeration->result.faulted = total_faulted > 0 || cancelled;
+                enumeration->result.budget_exhausted = budget_exhausted_total;
+            }
+            if (out_counted != nullptr)
+                *out_counted = (found != nullptr) ? occurrence : occurrence - matches_remaining;
+            return found;
         }
 
-        // Base protections accepted by the executable-only sweeps: the three page variants that grant execute *and*
-        // read. Bare PAGE_EXECUTE (execute without a read bit) is excluded because dereferencing it raises an access
-        // violation; PAGE_GUARD / PAGE_NOACCESS are filtered separately inside scan_regions_filtered. This is the scope
-        // for code-only scans: the whole-process executable sweep and the prologue-recovery fallback, whose rebuilt
-        // near-JMP can only ever overwrite a code prologue.
-        constexpr DWORD EXECUTABLE_PAGE_FLAGS = PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
-
-        // Base protections accepted by the readable sweep and the data-capable module-scoped scan: the
-        // executable-readable set plus the non-executable readable pages (.rdata / .data and read-only heaps). This
-        // reaches C++ vtables, RTTI type descriptors, and other read-only metadata the executable-only sweep cannot
-        // see.
-        constexpr DWORD READABLE_PAGE_FLAGS = EXECUTABLE_PAGE_FLAGS | PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY;
     } // anonymous namespace
 
     detail::MatchResult detail::scan_module_executable(const detail::EnginePattern &pattern, detail::ModuleSpan range,
@@ -440,42 +772,574 @@ namespace DetourModKit
         return MatchResult{};
     }
 
-    // Centralizes the executable-page protection gate for out-of-TU callers (the string-xref backend): one VirtualQuery
-    // walk over [range.base, range.end) that returns each committed, execute-readable region clamped to the range,
-    // using the identical mask scan_module_executable applies. The per-region gate (MEM_COMMIT, EXECUTABLE_PAGE_FLAGS,
-    // not PAGE_GUARD / PAGE_NOACCESS) guarantees the window is readable at gate time; the caller still wraps its reads
-    // of the window in a fault guard so a concurrent decommit / reprotect between gate and read cannot fault the host.
-    std::vector<detail::ExecutableWindow> detail::collect_executable_windows(detail::ModuleSpan range)
+    namespace
     {
-        std::vector<ExecutableWindow> windows;
-        if (!range.valid())
+        // The page-flag mask for a public page class; 0 for an out-of-range value, which every caller rejects.
+        [[nodiscard]] DWORD accept_mask_for(scan::Pages pages) noexcept
         {
-            return windows;
+            switch (pages)
+            {
+            case scan::Pages::Readable:
+                return READABLE_PAGE_FLAGS;
+            case scan::Pages::Executable:
+                return EXECUTABLE_PAGE_FLAGS;
+            }
+            return 0;
         }
 
-        MEMORY_BASIC_INFORMATION mbi{};
-        std::uintptr_t addr = range.base;
-        while (addr < range.end && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)))
+        // The serial walk behind both split scans. One span is exactly scan_module_pages; several are walked in
+        // order, each counting toward the same occurrence. The spans are disjoint with gaps between them, so a match
+        // never straddles two and each span's count simply carries into the next.
+        detail::MatchResult scan_spans_serial(const detail::EnginePattern &pattern,
+                                              std::span<const detail::ModuleSpan> spans, scan::Pages pages,
+                                              std::size_t occurrence) noexcept
         {
-            const bool protection_unsafe = (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
-            const auto region_base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
-            const std::uintptr_t region_end = region_base + mbi.RegionSize;
-            const std::uintptr_t scan_lo = region_base < range.base ? range.base : region_base;
-            const std::uintptr_t scan_hi = region_end > range.end ? range.end : region_end;
+            if (spans.size() == 1)
+            {
+                return detail::scan_module_pages(pattern, spans.front(), pages, occurrence);
+            }
+            const DWORD accept_mask = accept_mask_for(pages);
+            if (accept_mask == 0 || pattern.empty() || occurrence == 0)
+            {
+                return detail::MatchResult{};
+            }
+            bool incomplete = false;
+            std::size_t remaining = occurrence;
+            for (const detail::ModuleSpan &span : spans)
+            {
+                if (!span.valid())
+                {
+                    continue;
+                }
+                std::size_t counted = 0;
+                const std::byte *match = scan_regions_filtered(pattern, remaining, accept_mask, span.base, span.end,
+                                                               incomplete, UINTPTR_MAX, &counted);
+                if (match != nullptr)
+                {
+                    return detail::MatchResult{match, incomplete};
+                }
+                // A miss counted fewer than `remaining` matches, so at least one is still owed to a later span.
+                remaining -= counted;
+            }
+            return detail::MatchResult{nullptr, incomplete};
+        }
+
+        // One region of a sparse span that the gate passes, clamped to the span, and the allocation it belongs to: a
+        // module image or one private / mapped reservation.
+        struct PartitionRegion
+        {
+            std::uintptr_t lo;
+            std::uintptr_t hi;
+            std::uintptr_t allocation;
+        };
+
+        // Appends the regions of @p span a scan under @p accept_mask would read, in address order, and returns their
+        // byte total. The same gate the scans apply: committed, of the class, neither PAGE_GUARD nor PAGE_NOACCESS.
+        std::size_t collect_partition_regions(detail::ModuleSpan span, DWORD accept_mask,
+                                              std::vector<PartitionRegion> &out)
+        {
+            std::size_t bytes = 0;
+            MEMORY_BASIC_INFORMATION mbi{};
+            std::uintptr_t addr = span.base;
+            while (addr < span.end && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)))
+            {
+                const auto region_base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+                const std::uintptr_t region_end = region_base + mbi.RegionSize;
+                if (region_end <= addr)
+                    break; // Overflow guard.
+                const bool protection_unsafe = (mbi.Protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
+                if (mbi.State == MEM_COMMIT && (mbi.Protect & accept_mask) != 0 && !protection_unsafe)
+                {
+                    const std::uintptr_t lo = region_base < addr ? addr : region_base;
+                    const std::uintptr_t hi = region_end > span.end ? span.end : region_end;
+                    out.push_back(PartitionRegion{lo, hi, reinterpret_cast<std::uintptr_t>(mbi.AllocationBase)});
+                    bytes += static_cast<std::size_t>(hi - lo);
+                }
+                addr = region_end;
+            }
+            return bytes;
+        }
 
-            if (mbi.State == MEM_COMMIT && (mbi.Protect & EXECUTABLE_PAGE_FLAGS) != 0 && !protection_unsafe &&
-                scan_hi > scan_lo)
+        // Splits a large scan over one or more spans across the fork-join workers without changing its answer. Each
+        // span is cut into page-aligned chunks sized from the total; a chunk owns the match starts in
+        // [chunk_lo, chunk_hi) and scans a window that runs max_match_length() - 1 bytes past chunk_hi, clamped to its
+        // own span's end, so a match straddling a chunk boundary is found by the chunk it starts in and no other
+        // (start_limit keeps the next chunk's matches out of the tail). Phase one counts each chunk's matches in
+        // parallel, capped at the requested occurrence; a running prefix of those counts then names the one chunk that
+        // holds the Nth match, and phase two rescans just that chunk serially for its local occurrence. Chunks are laid
+        // out in ascending address order and every match is owned by exactly one of them, so the Nth match and its
+        // ascending-address order are exactly the serial scan's.
+        //
+        // A span of SPARSE_SCAN_MIN_SPAN_BYTES or more (a whole-process scope) is mostly unmapped, so cutting its
+        // addresses evenly would leave nearly every chunk empty and one holding all the modules. It is cut at the
+        // allocations its readable pages belong to instead -- one chunk per module image or private reservation, a
+        // large one cut further at every chunk_bytes of readable pages -- and each chunk covers the gap up to the
+        // next, so the chunks still tile the span. Chunks carry their readable bytes as a cost hint, so the pool
+        // starts the largest first.
+        detail::MatchResult scan_spans_split(const detail::EnginePattern &pattern,
+                                             std::span<const detail::ModuleSpan> spans, scan::Pages pages,
+                                             std::size_t occurrence, std::size_t max_workers) noexcept
+        {
+            const DWORD accept_mask = accept_mask_for(pages);
+            // A nested call from inside a fork-join worker (an anchor table already resolving in parallel) keeps the
+            // serial walk: the outer batch already occupies every core, and splitting again would only oversubscribe
+            // them.
+            if (accept_mask == 0 || pattern.empty() || occurrence == 0 || detail::in_fork_join_worker())
             {
-                windows.push_back(ExecutableWindow{scan_lo, static_cast<std::size_t>(scan_hi - scan_lo)});
+                return scan_spans_serial(pattern, spans, pages, occurrence);
             }
+            const auto sparse = [](const detail::ModuleSpan &span) noexcept
+            { return span.end - span.base >= detail::SPARSE_SCAN_MIN_SPAN_BYTES; };
+
+            struct ScanChunk
+            {
+                std::size_t index;
+                std::uintptr_t lo;
+                std::uintptr_t hi;
+                /// The end of the span the chunk was cut from; its tail read never passes it.
+                std::uintptr_t limit;
+                /// The bytes the chunk's scan reads, for the largest-first schedule.
+                std::uint64_t cost;
+            };
+            struct ChunkTally
+            {
+                std::size_t counted = 0;
+                bool incomplete = false;
+            };
 
-            if (region_end <= addr)
+            try
             {
-                break; // Overflow guard, mirroring scan_regions_filtered.
+                // A dense span counts all its bytes; a sparse one only those its scan would read.
+                std::vector<PartitionRegion> regions;
+                std::size_t total_bytes = 0;
+                for (const detail::ModuleSpan &span : spans)
+                {
+                    if (span.valid())
+                    {
+                        total_bytes += sparse(span) ? collect_partition_regions(span, accept_mask, regions)
+                                                    : static_cast<std::size_t>(span.end - span.base);
+                    }
+                }
+                if (total_bytes < detail::SPLIT_SCAN_MIN_BYTES)
+                {
+                    return scan_spans_serial(pattern, spans, pages, occurrence);
+                }
+                const std::size_t workers =
+                    detail::fork_join_worker_count(total_bytes / detail::SPLIT_SCAN_MIN_CHUNK_BYTES, max_workers);
+                if (workers <= 1)
+                {
+                    return scan_spans_serial(pattern, spans, pages, occurrence);
+                }
+
+                // A few chunks per worker let the atomic cursor balance a chunk that is mostly uncommitted against one
+                // that is dense with candidates, and let a low occurrence stop early (see satisfied_chunk below).
+                constexpr std::size_t PAGE_BYTES = 0x1000;
+                std::size_t chunk_bytes = total_bytes / (workers * 4);
+                chunk_bytes = chunk_bytes < detail::SPLIT_SCAN_MIN_CHUNK_BYTES ? detail::SPLIT_SCAN_MIN_CHUNK_BYTES
+                                                                               : chunk_bytes;
+                chunk_bytes = (chunk_bytes + PAGE_BYTES - 1) & ~(PAGE_BYTES - 1);
+
+                std::vector<ScanChunk> chunks;
+                chunks.reserve(total_bytes / chunk_bytes + spans.size() + regions.size());
+                std::size_t next_region = 0;
+                for (const detail::ModuleSpan &span : spans)
+                {
+                    if (!span.valid())
+                    {
+                        continue;
+                    }
+                    if (!sparse(span))
+                    {
+                        for (std::uintptr_t lo = span.base; lo < span.end;)
+                        {
+                            const std::uintptr_t hi = (span.end - lo > chunk_bytes) ? lo + chunk_bytes : span.end;
+                            chunks.push_back(ScanChunk{chunks.size(), lo, hi, span.end, hi - lo});
+                            lo = hi;
+                        }
+                        continue;
+                    }
+                    // The open chunk starts at `cut` and has taken `taken` readable bytes of `allocation`. Region
+                    // bounds and chunk_bytes are page multiples, so every cut lands on a page.
+                    std::uintptr_t cut = span.base;
+                    std::uintptr_t allocation = 0;
+                    std::size_t taken = 0;
+                    for (; next_region < regions.size() && regions[next_region].lo < span.end; ++next_region)
+                    {
+                        const PartitionRegion &region = regions[next_region];
+                        for (std::uintptr_t lo = region.lo; lo < region.hi;)
+                        {
+                            if (taken != 0 && (region.allocation != allocation || taken >= chunk_bytes))
+                            {
+                                chunks.push_back(ScanChunk{chunks.size(), cut, lo, span.end, taken});
+                                cut = lo;
+                                taken = 0;
+                            }
+                            allocation = region.allocation;
+                            const std::size_t room = chunk_bytes - taken;
+                            const std::uintptr_t hi = (region.hi - lo > room) ? lo + room : region.hi;
+                            taken += static_cast<std::size_t>(hi - lo);
+                            lo = hi;
+                        }
+                    }
+                    chunks.push_back(ScanChunk{chunks.size(), cut, span.end, span.end, taken});
+                }
+
+                const std::size_t tail = pattern.max_match_length() - 1;
+                const auto scan_window_hi = [tail](const ScanChunk &chunk) noexcept -> std::uintptr_t
+                { return (chunk.limit - chunk.hi > tail) ? chunk.hi + tail : chunk.limit; };
+
+                // Once any chunk alone holds `occurrence` matches, the Nth match lies in that chunk or an earlier one,
+                // so a later chunk's count cannot change the answer and is skipped. Its tally is never read: the prefix
+                // walk below stops at or before the satisfied chunk.
+                std::atomic<std::size_t> satisfied_chunk{chunks.size()};
+                // Chunk workers are other threads, so hand them the caller's installed snapshots explicitly.
+                const std::span<const detail::PageSnapshot> snapshots = t_page_snapshots;
+                const std::vector<ChunkTally> tallies = detail::run_fork_join<ScanChunk, ChunkTally>(
+                    std::span<const ScanChunk>(chunks), workers,
+                    [&](const ScanChunk &chunk) noexcept -> ChunkTally
+                    {
+                        const detail::ScopedPageSnapshots install(snapshots);
+                        ChunkTally tally{};
+                        if (chunk.index > satisfied_chunk.load(std::memory_order_relaxed))
+                        {
+                            return tally;
+                        }
+                        (void)scan_regions_filtered(pattern, occurrence, accept_mask, chunk.lo, scan_window_hi(chunk),
+                                                    tally.incomplete, chunk.hi, &tally.counted);
+                        if (tally.counted >= occurrence)
+                        {
+                            std::size_t current = satisfied_chunk.load(std::memory_order_relaxed);
+                            while (chunk.index < current &&
+                                   !satisfied_chunk.compare_exchange_weak(current, chunk.index,
+                                                                          std::memory_order_relaxed))
+                            {
+                            }
+                        }
+                        return tally;
+                    },
+                    [](const ScanChunk &) noexcept -> ChunkTally { return ChunkTally{0, true}; },
+                    [](const ScanChunk &chunk) noexcept -> std::uint64_t { return chunk.cost; });
+
+                bool incomplete = false;
+                std::size_t remaining = occurrence;
+                for (std::size_t i = 0; i < chunks.size(); ++i)
+                {
+                    incomplete = incomplete || tallies[i].incomplete;
+                    if (tallies[i].counted < remaining)
+                    {
+                        remaining -= tallies[i].counted;
+                        continue;
+                    }
+
+                    bool rescan_incomplete = false;
+                    const std::byte *match = scan_regions_filtered(pattern, remaining, accept_mask, chunks[i].lo,
+                                                                   scan_window_hi(chunks[i]), rescan_incomplete,
+                                                                   chunks[i].hi);
+                    // The rescan re-reads live memory, so a concurrent write can make it disagree with the phase-one
+                    // tally; a vanished match is then reported as an incomplete miss rather than a proven absence.
+                    return detail::MatchResult{match, incomplete || rescan_incomplete || match == nullptr};
+                }
+                return detail::MatchResult{nullptr, incomplete};
+            }
+            catch (...)
+            {
+                // Chunk bookkeeping or worker creation could not allocate; the split is only an accelerator, so fall
+                // back to the serial walk, which allocates nothing.
+                return scan_spans_serial(pattern, spans, pages, occurrence);
+            }
+        }
+    } // anonymous namespace
+
+    detail::MatchResult detail::scan_module_pages_split(const detail::EnginePattern &pattern, detail::ModuleSpan range,
+                                                        scan::Pages pages, std::size_t occurrence,
+                                                        std::size_t max_workers) noexcept
+    {
+        return scan_spans_split(pattern, std::span<const ModuleSpan>(&range, 1), pages, occurrence, max_workers);
+    }
+
+    std::vector<detail::ModuleSpan> detail::module_spans(const RegionSet &scope)
+    {
+        std::vector<ModuleSpan> spans;
+        spans.reserve(scope.ranges().size());
+        for (const Region &range : scope.ranges())
+        {
+            spans.push_back(module_span(range));
+        }
+        return spans;
+    }
+
+    bool detail::spans_contain(std::span<const ModuleSpan> spans, std::uintptr_t address) noexcept
+    {
+        // The first span ending past the address is the only one that can hold it, so one binary search settles it.
+        std::size_t lo = 0;
+        std::size_t hi = spans.size();
+        while (lo < hi)
+        {
+            const std::size_t mid = lo + (hi - lo) / 2;
+            if (spans[mid].end <= address)
+            {
+                lo = mid + 1;
+            }
+            else
+            {
+                hi = mid;
             }
-            addr = region_end;
         }
-        return windows;
+        return lo < spans.size() && spans[lo].contains(address);
+    }
+
+    detail::MatchResult detail::scan_module_set_split(const detail::EnginePattern &pattern,
+                                                      std::span<const ModuleSpan> spans, scan::Pages pages,
+                                                      std::size_t occurrence, std::size_t max_workers) noexcept
+    {
+        if (spans.empty())
+        {
+            return MatchResult{};
+        }
+        if (max_workers == 1)
+        {
+            return scan_spans_serial(pattern, spans, pages, occurrence);
+        }
+        return scan_spans_split(pattern, spans, pages, occurrence, max_workers);
+    }
+
+    // One step of a resumable module scan. The region walk here only finds where the next accepted bytes begin; the
+    // slice itself runs through scan_regions_filtered with a start limit, so its gate, fault guard, carry, and count
+    // floor are exactly the serial walk's. Regions that fail the gate are skipped without scanning, so a sparse scope
+    // (Region::whole_process()) costs one page-map query per rejected region rather than one slice per max_bytes.
+    detail::ScanSliceResult detail::scan_module_slice(const detail::EnginePattern &pattern, detail::ModuleSpan range,
+                                                      scan::Pages pages, std::uintptr_t from, std::size_t occurrence,
+                                                      std::size_t max_bytes) noexcept
+    {
+        ScanSliceResult result{};
+        result.next = range.end;
+        DWORD accept_mask = 0;
+        switch (pages)
+        {
+        case scan::Pages::Readable:
+            accept_mask = READABLE_PAGE_FLAGS;
+            break;
+        case scan::Pages::Executable:
+            accept_mask = EXECUTABLE_PAGE_FLAGS;
+            break;
+        }
+        if (accept_mask == 0 || pattern.empty() || occurrence == 0 || max_bytes == 0 || !range.valid() ||
+            from >= range.end)
+        {
+            return result;
+        }
+        if (from < range.base)
+        {
+            from = range.base;
+        }
+
+        // The first accepted region at or after `from`, clamped to the range.
+        std::uintptr_t slice_lo = 0;
+        std::uintptr_t region_hi = 0;
+        const auto take_region = [&](std::uintptr_t region_base, std::uintptr_t region_end) noexcept -> bool
+        {
+            const std::uintptr_t lo = region_base < from ? from : region_base;
+            const std::uintptr_t hi = region_end > range.end ? range.end : region_end;
+            if (hi <= lo)
+            {
+                return false;
+            }
+            slice_lo = lo;
+            region_hi = hi;
+            return true;
+        };
+        bool have_region = false;
+        if (const PageSnapshot *snapshot = covering_snapshot(from, range.end))
+        {
+            for (const PageSnapshotRegion &region : snapshot->regions)
+            {
+                if ((region.protect & accept_mask) != 0 && take_region(region.base, region.end))
+                {
+                    have_region = true;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            walk_page_regions(from, range.end,
+                              [&](std::uintptr_t region_base, std::uintptr_t region_end, DWORD state,
+                                  DWORD protect) noexcept -> bool
+                              {
+                                  const bool protection_unsafe = (protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
+                                  have_region = state == MEM_COMMIT && (protect & accept_mask) != 0 &&
+                                                !protection_unsafe && take_region(region_base, region_end);
+                                  return have_region;
+                              });
+        }
+        if (!have_region)
+        {
+            return result;
+        }
+
+        const std::uintptr_t slice_hi = (region_hi - slice_lo > max_bytes) ? slice_lo + max_bytes : region_hi;
+        const std::size_t tail = pattern.max_match_length() - 1;
+        const std::uintptr_t window_hi = (range.end - slice_hi > tail) ? slice_hi + tail : range.end;
+        result.match = scan_regions_filtered(pattern, occurrence, accept_mask, slice_lo, window_hi, result.incomplete,
+                                             slice_hi, &result.counted);
+        result.next = slice_hi;
+        return result;
+    }
+
+    // A single serial walk: the enumeration visits every region in address order, so a parallel split would only have
+    // to re-serialize its matches for the visitor.
+    detail::EnumerationResult detail::enumerate_module_pages(const detail::EnginePattern &pattern,
+                                                             detail::ModuleSpan range, scan::Pages pages,
+                                                             detail::MatchVisitor visit, void *context) noexcept
+    {
+        DWORD accept_mask = 0;
+        switch (pages)
+        {
+        case scan::Pages::Readable:
+            accept_mask = READABLE_PAGE_FLAGS;
+            break;
+        case scan::Pages::Executable:
+            accept_mask = EXECUTABLE_PAGE_FLAGS;
+            break;
+        }
+        if (accept_mask == 0 || pattern.empty() || visit == nullptr || !range.valid())
+        {
+            return EnumerationResult{};
+        }
+        Enumeration enumeration{};
+        enumeration.visit = visit;
+        enumeration.context = context;
+        bool incomplete = false;
+        (void)scan_regions_filtered(pattern, SIZE_MAX, accept_mask, range.base, range.end, incomplete, UINTPTR_MAX,
+                                    nullptr, &enumeration);
+        return enumeration.result;
+    }
+
+    namespace
+    {
+        // Base protections that grant write as well as read: the pages a running program can change. The value
+        // scanner keeps to this class, since a read-only or code page holds no state the host updates; bare
+        // PAGE_EXECUTE carries no read bit and is never in it.
+        constexpr DWORD WRITABLE_PAGE_FLAGS =
+            PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY;
+
+        // Centralizes the page-protection gate for out-of-TU callers (the string-xref backend, the multi-pattern
+        // sweep, and the value scanner): one page walk (walk_page_regions) over [range.base, range.end) that returns
+        // each committed region whose protection meets accept_mask, clamped to the range, using the identical mask
+        // the module-scoped scans apply. The per-region gate (MEM_COMMIT, the class mask, not PAGE_GUARD /
+        // PAGE_NOACCESS) guarantees the window is readable at gate time; the caller still wraps its reads of the
+        // window in a fault guard so a concurrent decommit / reprotect between gate and read cannot fault the host.
+        std::vector<detail::ExecutableWindow> collect_masked_windows(detail::ModuleSpan range, DWORD accept_mask)
+        {
+            std::vector<detail::ExecutableWindow> windows;
+            if (accept_mask == 0 || !range.valid())
+            {
+                return windows;
+            }
+
+            if (const detail::PageSnapshot *snapshot = covering_snapshot(range.base, range.end))
+            {
+                for (const detail::PageSnapshotRegion &region : snapshot->regions)
+                {
+                    const std::uintptr_t scan_lo = region.base < range.base ? range.base : region.base;
+                    const std::uintptr_t scan_hi = region.end > range.end ? range.end : region.end;
+                    if ((region.protect & accept_mask) != 0 && scan_hi > scan_lo)
+                    {
+                        windows.push_back(
+                            detail::ExecutableWindow{scan_lo, static_cast<std::size_t>(scan_hi - scan_lo)});
+                    }
+                }
+                return windows;
+            }
+
+            walk_page_regions(range.base, range.end,
+                              [&](std::uintptr_t scan_lo, std::uintptr_t scan_hi, DWORD state, DWORD protect) -> bool
+                              {
+                                  const bool protection_unsafe = (protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
+                                  if (state == MEM_COMMIT && (protect & accept_mask) != 0 && !protection_unsafe &&
+                                      scan_hi > scan_lo)
+                                  {
+                                      windows.push_back(detail::ExecutableWindow{
+                                          scan_lo, static_cast<std::size_t>(scan_hi - scan_lo)});
+                                  }
+                                  return false;
+                              });
+            return windows;
+        }
+    } // namespace
+
+    std::vector<detail::ExecutableWindow> detail::collect_page_windows(detail::ModuleSpan range, scan::Pages pages)
+    {
+        // An out-of-range enum value must not silently widen to readable pages, mirroring scan_module_pages.
+        return collect_masked_windows(range, accept_mask_for(pages));
+    }
+
+    std::vector<detail::ExecutableWindow> detail::collect_writable_windows(detail::ModuleSpan range)
+    {
+        return collect_masked_windows(range, WRITABLE_PAGE_FLAGS);
+    }
+
+    std::vector<detail::ExecutableWindow> detail::collect_executable_windows(detail::ModuleSpan range)
+    {
+        return collect_page_windows(range, scan::Pages::Executable);
+    }
+
+    // The same page walk and gate as collect_page_windows under the readable class, recording each region's raw
+    // protection so a replay can still apply the narrower executable mask.
+    detail::PageSnapshot detail::capture_page_snapshot(detail::ModuleSpan range)
+    {
+        PageSnapshot snapshot;
+        if (!range.valid())
+        {
+            return snapshot;
+        }
+        snapshot.range = range;
+
+        walk_page_regions(range.base, range.end,
+                          [&](std::uintptr_t scan_lo, std::uintptr_t scan_hi, DWORD state, DWORD protect) -> bool
+                          {
+                              const bool protection_unsafe = (protect & (PAGE_GUARD | PAGE_NOACCESS)) != 0;
+                              if (state == MEM_COMMIT && (protect & READABLE_PAGE_FLAGS) != 0 && !protection_unsafe &&
+                                  scan_hi > scan_lo)
+                              {
+                                  snapshot.regions.push_back(
+                                      PageSnapshotRegion{scan_lo, scan_hi, static_cast<std::uint32_t>(protect)});
+                              }
+                              return false;
+                          });
+        return snapshot;
+    }
+
+    void detail::add_page_snapshot(std::vector<PageSnapshot> &snapshots, detail::ModuleSpan range)
+    {
+        if (!range.valid())
+        {
+            return;
+        }
+        for (const PageSnapshot &snapshot : snapshots)
+        {
+            if (snapshot.range.base == range.base && snapshot.range.end == range.end)
+            {
+                return;
+            }
+        }
+        snapshots.push_back(capture_page_snapshot(range));
+    }
+
+    detail::ScopedPageSnapshots::ScopedPageSnapshots(std::span<const PageSnapshot> snapshots) noexcept
+        : m_previous(t_page_snapshots)
+    {
+        t_page_snapshots = snapshots;
+    }
+
+    detail::ScopedPageSnapshots::~ScopedPageSnapshots() noexcept
+    {
+        t_page_snapshots = m_previous;
+    }
+
+    std::span<const detail::PageSnapshot> detail::installed_page_snapshots() noexcept
+    {
+        return t_page_snapshots;
     }
 
     // Single-address sibling of the executable-page gate scan_regions_filtered applies per region. One VirtualQuery,
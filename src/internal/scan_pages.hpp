@@ -3,8 +3,8 @@
 
 /**
  * @file internal/scan_pages.hpp
- * @brief True-private page-gated scan primitives: the VirtualQuery page walk, the TOCTOU-guarded region reads, the
- *        committed-window collection, and the single-address executable-page predicate.
+ * @brief True-private page-gated scan primitives: the page walk, the TOCTOU-guarded region reads, the committed-window
+ *        collection, the shared page snapshot, and the single-address executable-page predicate.
  * @details Never installed. Wraps the raw scan_engine matcher in the OS page map so a scan over arbitrary process or
  *          module memory reads only committed pages of the requested protection class and skips unmapped / guard /
  *          no-access pages instead of faulting the host. The Windows page-protection masks (PAGE_EXECUTE_READ, ...)
@@ -12,16 +12,24 @@
  *          scans. A page-gated scan returns a MatchResult so the caller learns whether a region faulted mid-scan or its
  *          bounded-jump matcher exhausted a work budget; either condition leaves the occurrence count as only a lower
  *          bound, so incomplete state rides on the return value rather than a thread-local side channel.
+ *
+ *          Every module-scoped walk, collector, and snapshot shares one page walk. Inside a loader-mapped image it
+ *          follows the image's PE section table -- one guarded header read, then one VirtualQuery per section to
+ *          confirm the section's first page still has the protection class its header declares -- and visits each
+ *          confirmed section as a single region, however many regions VirtualQuery would split it into. A section
+ *          whose first page disagrees, and any range outside a well-formed image, is walked by VirtualQuery.
  */
 
 #include "internal/memory_guarded.hpp"
 #include "internal/scan_engine.hpp"
 
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/scan.hpp"
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <vector>
 
 namespace DetourModKit
@@ -87,11 +95,128 @@ namespace DetourModKit
         [[nodiscard]] MatchResult scan_module_pages(const EnginePattern &pattern, ModuleSpan range, scan::Pages pages,
                                                     std::size_t occurrence) noexcept;
 
+        /// Smallest image for which @ref scan_module_pages_split divides the walk across workers (16 MiB).
+        inline constexpr std::size_t SPLIT_SCAN_MIN_BYTES = std::size_t{16} << 20;
+
+        /// Smallest chunk a split scan hands one worker (4 MiB), so thread start-up stays small next to the sweep.
+        inline constexpr std::size_t SPLIT_SCAN_MIN_CHUNK_BYTES = std::size_t{4} << 20;
+
+        /**
+         * @brief Span size from which a split scan partitions by allocation rather than by address (4 GiB).
+         * @details No PE image reaches it (SizeOfImage is 32-bit), so a span this large is a multi-module or
+         *          whole-process scope whose addresses are mostly unmapped.
+         */
+        inline constexpr std::size_t SPARSE_SCAN_MIN_SPAN_BYTES = std::size_t{4} << 30;
+
+        /**
+         * @brief @ref scan_module_pages for one large image, split into chunks that are scanned in parallel.
+         * @details Cuts [range.base, range.end) into page-aligned chunks, each owning the matches that start inside it
+         *          and reading max_match_length() - 1 bytes past its end so a boundary-straddling match is still found.
+         *          Per-chunk counts are merged in address order, so the Nth occurrence -- and therefore a uniqueness
+         *          check built on the (N+1)th -- is exactly the serial scan's. A faulted chunk or a spent bounded-jump
+         *          budget before the Nth match reports incomplete, as the serial walk does. An image below
+         *          @ref SPLIT_SCAN_MIN_BYTES, a single available worker, or a call from inside a fork-join worker runs
+         *          the serial scan_module_pages unchanged; so does a failed chunk allocation. A range of
+         *          @ref SPARSE_SCAN_MIN_SPAN_BYTES or more (Region::whole_process()) is cut by module image and by
+         *          large private-region chunk instead, sized and scheduled largest-first by the pages it would read.
+         * @param max_workers Upper bound on worker threads (0 = auto; see fork_join_worker_count).
+         * @note Setup/control-plane only: spawns worker threads for the duration of the call.
+         */
+        [[nodiscard]] MatchResult scan_module_pages_split(const EnginePattern &pattern, ModuleSpan range,
+                                                          scan::Pages pages, std::size_t occurrence,
+                                                          std::size_t max_workers = 0) noexcept;
+
+        /// Converts a RegionSet's spans to engine ModuleSpans, keeping the set's ascending order; may throw bad_alloc.
+        [[nodiscard]] std::vector<ModuleSpan> module_spans(const RegionSet &scope);
+
+        /// True iff one of @p spans -- ascending and disjoint, as module_spans() yields them -- holds @p address.
+        [[nodiscard]] bool spans_contain(std::span<const ModuleSpan> spans, std::uintptr_t address) noexcept;
+
+        /**
+         * @brief @ref scan_module_pages_split over a multi-range scope: the Nth match counted across every span in
+         *        ascending address order.
+         * @details @p spans must be ascending and disjoint with a gap between neighbours (a RegionSet's invariant), so
+         *          no match straddles two of them and each span's count simply adds to the next. One span delegates to
+         *          scan_module_pages_split; several are cut into the same page-aligned chunks across the whole set --
+         *          a chunk never crosses a span, and its tail read stops at its own span's end -- so the workers split
+         *          the set's total bytes rather than one span each, and the answer is the serial walk's. The split is
+         *          skipped on the same conditions (a small total, one worker, a nested fork-join call); @p max_workers
+         *          1 forces the serial walk.
+         * @note Setup/control-plane only: may spawn worker threads for the duration of the call.
+         */
+        [[nodiscard]] MatchResult scan_module_set_split(const EnginePattern &pattern, std::span<const ModuleSpan> spans,
+                                                        scan::Pages pages, std::size_t occurrence,
+                                                        std::size_t max_workers = 0) noexcept;
+
+        /**
+         * @struct ScanSliceResult
+         * @brief The outcome of one @ref scan_module_slice step of a resumable module scan.
+         */
+        struct ScanSliceResult
+        {
+            /// The requested match (offset-applied) when it starts inside the slice, else nullptr.
+            const std::byte *match = nullptr;
+            /// Matches the slice counted when @ref match is nullptr.
+            std::size_t counted = 0;
+            /// Where the next slice starts; the range end once the walk is complete.
+            std::uintptr_t next = 0;
+            /// True when the slice skipped a faulted region or truncated bounded-jump work.
+            bool incomplete = false;
+        };
+
+        /**
+         * @brief Advances a serial module scan by one slice: the matches that START in [from, slice end).
+         * @details Skips the regions from @p from that fail the @p pages gate, then scans at most @p max_bytes of the
+         *          first accepted region, reading max_match_length() - 1 bytes past the slice end so a match that
+         *          straddles it is still found there and nowhere else -- the chunk ownership rule
+         *          @ref scan_module_pages_split uses. Calling it from range.base, then from each returned @ref
+         *          ScanSliceResult::next with the occurrence reduced by every @ref ScanSliceResult::counted, visits
+         *          every match of the serial walk exactly once and in order, so a caller can spread one scan across
+         *          as many calls as it likes and still get the serial answer.
+         */
+        [[nodiscard]] ScanSliceResult scan_module_slice(const EnginePattern &pattern, ModuleSpan range,
+                                                        scan::Pages pages, std::uintptr_t from,
+                                                        std::size_t occurrence, std::size_t max_bytes) noexcept;
+
+        /// Receives each match of @ref enumerate_module_pages (offset-applied); returning false ends the walk.
+        using MatchVisitor = bool (*)(void *context, const std::byte *match) noexcept;
+
+        /**
+         * @struct EnumerationResult
+         * @brief How an @ref enumerate_module_pages walk ended.
+         * @details @ref faulted and @ref budget_exhausted are the two causes MatchResult::incomplete folds together,
+         *          reported apart so an enumeration can tell a skipped region from a truncated bounded-jump sweep.
+         */
+        struct EnumerationResult
+        {
+            /// Matches the visitor accepted; the one it declined, if any, is not counted.
+            std::size_t matches = 0;
+            /// True when a region faulted mid-scan and the rest of it was skipped.
+            bool faulted = false;
+            /// True when a bounded-jump matcher spent its work budget in some region.
+            bool budget_exhausted = false;
+            /// True when the visitor declined a match, ending the walk early.
+            bool stopped = false;
+        };
+
+        /**
+         * @brief Visits every match of a module-scoped page-gated scan, in ascending address order, in one pass.
+         * @details The same gate, fault guard, protection-split carry, and count floor as @ref scan_module_pages, so
+         *          the visitor sees exactly the matches an occurrence scan counts, each once. Matches are collected
+         *          inside the fault guard in small batches and delivered outside it: a fault in the visitor is never
+         *          mistaken for a skipped region. A faulted region still delivers the matches read before the fault.
+         * @note Setup/control-plane only: walks the scope through the OS page map.
+         */
+        [[nodiscard]] EnumerationResult enumerate_module_pages(const EnginePattern &pattern, ModuleSpan range,
+                                                               scan::Pages pages, MatchVisitor visit,
+                                                               void *context) noexcept;
+
         /**
          * @struct ExecutableWindow
-         * @brief One committed, execute-readable slice of a module image.
-         * @details @ref base / @ref span describe bytes that passed the same VirtualQuery protection gate the scans
-         *          apply (MEM_COMMIT, execute-readable, not PAGE_GUARD / PAGE_NOACCESS) at gate time. The gate proves
+         * @brief One committed, protection-gated slice of a module image.
+         * @details @ref base / @ref span describe bytes that passed the same page-protection gate the scans
+         *          apply (MEM_COMMIT, execute-readable -- or any readable class for @ref collect_page_windows with
+         *          Pages::Readable -- not PAGE_GUARD / PAGE_NOACCESS) at gate time. The gate proves
          *          readability only at that instant, so a caller reading [base, base + span) should still wrap the read
          *          in a fault guard against a concurrent decommit / reprotect.
          */
@@ -105,13 +230,110 @@ namespace DetourModKit
 
         /**
          * @brief Collects the execute-readable windows of a module image in ascending address order.
-         * @details Walks [range.base, range.end) via VirtualQuery, returning each committed, execute-readable region
-         *          clamped to the range. Centralizes the executable-page gate so an out-of-TU caller (the string-xref
-         *          backend) scans the image's code without re-deriving the Windows page masks.
+         * @details Walks [range.base, range.end) with the shared page walk, returning each committed,
+         *          execute-readable region clamped to the range. Centralizes the executable-page gate so an out-of-TU
+         *          caller (the string-xref backend) scans the image's code without re-deriving the Windows page masks.
          * @return The execute-readable windows; empty when @p range is invalid or it exposes no readable code pages.
          */
         [[nodiscard]] std::vector<ExecutableWindow> collect_executable_windows(ModuleSpan range);
 
+        /**
+         * @brief Collects the committed windows of a module image that pass the @p pages protection class.
+         * @details The class-generic form of @ref collect_executable_windows (which is this call with
+         *          Pages::Executable): Pages::Readable also returns the non-executable readable regions (.rdata /
+         *          .data). Windows are clamped to @p range and returned in ascending address order; two windows whose
+         *          ends touch form one contiguous readable run. The multi-pattern sweep walks the image through it so
+         *          it applies exactly the page gate the per-pattern module scans do.
+         * @return The accepted windows; empty when @p range is invalid, @p pages is out of range, or no page passes.
+         */
+        [[nodiscard]] std::vector<ExecutableWindow> collect_page_windows(ModuleSpan range, scan::Pages pages);
+
+        /**
+         * @brief Collects the committed, writable windows of @p range in ascending address order.
+         * @details The same walk and gate as @ref collect_page_windows, narrowed to the protections that grant write
+         *          (PAGE_READWRITE, PAGE_WRITECOPY, and their execute forms): the heap, stack, and .data pages whose
+         *          contents the host changes at run time. The value scanner sweeps these. A snapshot covering
+         *          @p range is replayed as for the other collectors.
+         * @return The writable windows; empty when @p range is invalid or no page passes.
+         */
+        [[nodiscard]] std::vector<ExecutableWindow> collect_writable_windows(ModuleSpan range);
+
+        /**
+         * @struct PageSnapshotRegion
+         * @brief One walked region of a @ref PageSnapshot that passed the readable page gate.
+         * @details @ref protect is the region's raw page protection, so a snapshot-driven walk applies exactly the
+         *          class mask the live walk would (execute-readable for Pages::Executable, any readable class for
+         *          Pages::Readable). Bounds are clamped to the snapshot's range.
+         */
+        struct PageSnapshotRegion
+        {
+            /// First byte of the region.
+            std::uintptr_t base = 0;
+            /// One past the last byte of the region.
+            std::uintptr_t end = 0;
+            /// The region's page protection (a PAGE_* base value) at capture time.
+            std::uint32_t protect = 0;
+        };
+
+        /**
+         * @struct PageSnapshot
+         * @brief A module image's committed, readable page map, captured by one page walk.
+         * @details A batch resolve runs hundreds of scans over the same image, and each one otherwise repeats the same
+         *          VirtualQuery walk, a syscall per region whose cost grows with the process's VAD tree. A snapshot is
+         *          captured once per batch and installed with @ref ScopedPageSnapshots for each batch item; every
+         *          module-scoped page walk over a range the snapshot covers then iterates the recorded regions instead
+         *          of re-querying. Only the gate is cached, never the bytes: every read is still TOCTOU-fault-guarded,
+         *          so a region decommitted after capture is skipped and reported incomplete as in a live walk. A region
+         *          that becomes readable after capture is not seen, the same as one reprotected just after a live walk
+         *          passed it.
+         */
+        struct PageSnapshot
+        {
+            /// The image range the snapshot covers; invalid for an empty snapshot.
+            ModuleSpan range{};
+            /// The readable regions of @ref range, in ascending address order.
+            std::vector<PageSnapshotRegion> regions;
+        };
+
+        /**
+         * @brief Walks @p range once and records every committed region that passes the readable page gate.
+         * @return The snapshot; empty (invalid range) when @p range is invalid.
+         * @note Setup/control-plane only: allocates. A caller on a noexcept path guards it and scans live on failure.
+         */
+        [[nodiscard]] PageSnapshot capture_page_snapshot(ModuleSpan range);
+
+        /**
+         * @brief Appends a snapshot of @p range to @p snapshots unless one for the same range is already present.
+         * @details The batch entry points call it once per item scope, so a batch over one image captures one map.
+         *          An invalid range appends nothing.
+         * @note Setup/control-plane only: allocates.
+         */
+        void add_page_snapshot(std::vector<PageSnapshot> &snapshots, ModuleSpan range);
+
+        /**
+         * @class ScopedPageSnapshots
+         * @brief Installs a set of page snapshots for the module-scoped page walks on the calling thread.
+         * @details While an instance is alive, a module scan, a split chunk scan, or a window collection over a range
+         *          that one of @p snapshots fully covers reads that snapshot's regions instead of calling VirtualQuery.
+         *          Whole-process scans never use a snapshot. Installations nest: the destructor restores the previous
+         *          set. The snapshots are borrowed and must outlive the instance.
+         */
+        class ScopedPageSnapshots
+        {
+        public:
+            explicit ScopedPageSnapshots(std::span<const PageSnapshot> snapshots) noexcept;
+            ~ScopedPageSnapshots() noexcept;
+
+            ScopedPageSnapshots(const ScopedPageSnapshots &) = delete;
+            ScopedPageSnapshots &operator=(const ScopedPageSnapshots &) = delete;
+
+        private:
+            std::span<const PageSnapshot> m_previous;
+        };
+
+        /// The snapshots installed on the calling thread (empty when none), for handing on to fork-join workers.
+        [[nodiscard]] std::span<const PageSnapshot> installed_page_snapshots() noexcept;
+
         /**
          * @brief True when @p address lies on a committed, execute-readable page.
          * @details Single-address VirtualQuery gate using the same page-protection set the module and whole-process
@@ -14,6 +14,7 @@
 #include "internal/scan_engine.hpp"
 #include "internal/scan_pages.hpp"
 #include "internal/scan_shared.hpp"
+#include "internal/thunk_cache.hpp"
 
 #include "DetourModKit/detail/pattern_core.hpp"
 
@@ -121,6 +122,30 @@ namespace DetourModKit
                 rebuilt.bytes.push_back(original_bytes[i]);
                 rebuilt.mask.push_back(original_mask[i]);
             }
+            // The tail's classes and groups move with their bytes; a group cut by the patch has no faithful rebuild.
+            const detail::PatternBuffer &data = detail::pattern_buffer(original);
+            const std::size_t rebased = prefix.buffer.length;
+            for (const detail::ByteClass &entry : detail::classes_of(data))
+            {
+                if (entry.position >= shape.patch_bytes)
+                {
+                    rebuilt.classes.push_back(
+                        detail::ByteClass{rebased + (entry.position - shape.patch_bytes), entry.members});
+                }
+            }
+            for (detail::PatternGroup group : detail::groups_of(data))
+            {
+                if (group.position < shape.patch_bytes)
+                {
+                    if (group.position + group.length > shape.patch_bytes)
+                    {
+                        return std::nullopt;
+                    }
+                    continue;
+                }
+                group.position = rebased + (group.position - shape.patch_bytes);
+                rebuilt.groups.push_back(group);
+            }
             rebuilt.offset = 0;
             rebuilt.compile_anchor();
             return rebuilt;
@@ -131,7 +156,7 @@ namespace DetourModKit
         // resolve the anchored match. applicable becomes true once the rebuilt pattern is usable (enough literal tail),
         // independent of whether it then matches, so the caller can tell "no shape applied" from "applied but missed".
         std::optional<std::uintptr_t> try_prologue_shape(const scan::DirectPattern &direct, const PrologueShape &shape,
-                                                         detail::ModuleSpan range, bool &applicable)
+                                                         std::span<const detail::ModuleSpan> spans, bool &applicable)
         {
             const scan::Pattern &pattern = direct.pattern;
             const std::optional<detail::EnginePattern> rebuilt = build_rebuilt_prologue(pattern, shape);
@@ -143,13 +168,15 @@ namespace DetourModKit
 
             // Count up to two occurrences over the executable pages. A faulted region mid-scan makes the count a lower
             // bound, so a single hit over an incomplete sweep does not prove uniqueness; fail closed. More than one hit
-            // makes the rebuilt jump ambiguous; fail closed.
-            const detail::MatchResult first = detail::scan_module_executable(*rebuilt, range, 1);
+            // makes the rebuilt jump ambiguous; fail closed. The count runs serially across every span of the scope.
+            const detail::MatchResult first =
+                detail::scan_module_set_split(*rebuilt, spans, scan::Pages::Executable, 1, 1);
             if (first.match == nullptr)
             {
                 return std::nullopt;
             }
-            const detail::MatchResult second = detail::scan_module_executable(*rebuilt, range, 2);
+            const detail::MatchResult second =
+                detail::scan_module_set_split(*rebuilt, spans, scan::Pages::Executable, 2, 1);
             const bool ambiguous = second.match != nullptr;
             const bool incomplete = first.incomplete || second.incomplete;
             if (ambiguous || incomplete)
@@ -158,8 +185,9 @@ namespace DetourModKit
             }
 
             const std::uintptr_t match = reinterpret_cast<std::uintptr_t>(first.match);
-            const std::optional<std::uintptr_t> jump_target = shape.decode(match);
-            if (!jump_target || !detail::is_plausible_ptr(*jump_target) || !detail::is_executable_address(*jump_target))
+            // Targets hooked through the same overlay share thunks, so the decode and its executable-page gate go
+            // through the session's thunk cache: one decode per distinct thunk across a batch.
+            if (!detail::resolve_thunk_target(match, shape.decode))
             {
                 // The matched bytes do not redirect to executable code, so this is a coincidental opcode collision, not
                 // a hooked prologue. The jump destination itself is intentionally NOT range-constrained: a sibling
@@ -169,7 +197,7 @@ namespace DetourModKit
 
             const std::uintptr_t anchored = match + static_cast<std::uintptr_t>(pattern.offset());
             const std::optional<std::uintptr_t> resolved = detail::resolve_direct(anchored, direct);
-            if (!resolved || !range.contains(*resolved))
+            if (!resolved || !detail::spans_contain(spans, *resolved))
             {
                 // Bound the recovered address to the requested scope, matching the normal byte path: a Direct walk-back
                 // must not resolve outside the range even when it is reached through prologue recovery.
@@ -180,7 +208,8 @@ namespace DetourModKit
     } // anonymous namespace
 
     detail::FallbackOutcome detail::resolve_prologue_fallback(const scan::ScanRequest &request,
-                                                              std::span<const std::size_t> order, ModuleSpan range)
+                                                              std::span<const std::size_t> order,
+                                                              std::span<const ModuleSpan> spans)
     {
         FallbackOutcome outcome;
         const scan::FallbackPolicy policy = request.fallback_policy;
@@ -197,7 +226,7 @@ namespace DetourModKit
             for (const PrologueShape &shape : PROLOGUE_SHAPES)
             {
                 bool applicable = false;
-                const std::optional<std::uintptr_t> recovered = try_prologue_shape(*direct, shape, range, applicable);
+                const std::optional<std::uintptr_t> recovered = try_prologue_shape(*direct, shape, spans, applicable);
                 if (applicable)
                 {
                     outcome.not_applicable = false;
@@ -232,7 +261,7 @@ namespace DetourModKit
                     outcome.identity_warned = true;
                 }
 
-                outcome.hit = scan::Hit{Address{*recovered}, candidate.name()};
+                outcome.hit = scan::Hit{Address{*recovered}, candidate.name(), scan::HitSource::PrologueRecovery};
                 return outcome;
             }
         }
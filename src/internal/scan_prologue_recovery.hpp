@@ -49,12 +49,13 @@ namespace DetourModKit
          * @brief Runs hooked-prologue recovery across the ordered ladder.
          * @param request The resolution request (its ladder is indexed through @p order).
          * @param order The try order (indices into request.ladder), as produced by order_candidates.
-         * @param range The module image to scan, in engine ModuleSpan form.
+         * @param spans The scope to scan, as ascending disjoint engine spans (one for a Region scope).
          * @return The recovery outcome: a Hit when a shape uniquely recovered an executable target, plus the
          *         applicability diagnostics. May allocate while rebuilding patterns, so it is not noexcept.
          */
         [[nodiscard]] FallbackOutcome resolve_prologue_fallback(const scan::ScanRequest &request,
-                                                                std::span<const std::size_t> order, ModuleSpan range);
+                                                                std::span<const std::size_t> order,
+                                                                std::span<const ModuleSpan> spans);
     } // namespace detail
 } // namespace DetourModKit
 
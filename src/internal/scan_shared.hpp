@@ -16,6 +16,7 @@
 #include "internal/scan_engine.hpp"
 
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/scan.hpp"
 
 #include <array>
@@ -44,14 +45,27 @@ namespace DetourModKit
             std::size_t sampled = 0;
         };
 
-        // Sample a bounded, strided set of pages from the scope and tally a 256-bin byte-frequency histogram. Reads go
-        // through guarded_read_bytes one page at a time, so an unmapped / guard page inside the scope is skipped rather
-        // than faulting the host; the stride spreads the sample across .text and .rdata / .data so the frequencies
-        // reflect the whole image, not just its first pages. Entirely stack-based (the histogram and the page buffer
-        // are locals), so it never allocates and is safe to call from the noexcept scan paths.
-        [[nodiscard]] inline HaystackHistogram sample_haystack(Region scope) noexcept
+        /**
+         * @brief Copies the scan::tune_anchors profile that covers a scan of @p scope with @p pages into @p out.
+         * @return False when no profiled module contains @p scope, or when the scan also reads non-code pages
+         *         (Pages::Readable over more than one executable section). Defined in scan_anchor_tuning.cpp. Takes
+         *         no lock and copies nothing until the first module is profiled; never allocates.
+         */
+        [[nodiscard]] bool tuned_histogram(Region scope, scan::Pages pages, HaystackHistogram &out) noexcept;
+
+        // Sample a bounded, strided set of pages from the scope and tally a 256-bin byte-frequency histogram, unless
+        // scan::tune_anchors has profiled the code this scan reads, in which case that full histogram is used as is.
+        // Reads go through guarded_read_bytes one page at a time, so an unmapped / guard page inside the scope is
+        // skipped rather than faulting the host; the stride spreads the sample across .text and .rdata / .data so the
+        // frequencies reflect the whole image, not just its first pages. Entirely stack-based (the histogram and the
+        // page buffer are locals), so it never allocates and is safe to call from the noexcept scan paths.
+        [[nodiscard]] inline HaystackHistogram sample_haystack(Region scope, scan::Pages pages) noexcept
         {
             HaystackHistogram histogram;
+            if (tuned_histogram(scope, pages, histogram))
+            {
+                return histogram;
+            }
             const std::uintptr_t base = scope.base.raw();
             if (base == 0 || scope.size == 0 || scope.size > SAMPLE_MAX_SCOPE)
             {
@@ -81,24 +95,25 @@ namespace DetourModKit
             return histogram;
         }
 
-        // When a sufficient haystack sample exists, pick the pattern's fully-known byte whose value is rarest in this
-        // image (the most selective prefilter for this haystack), overriding the compile-time rarest-byte anchor the
-        // Pattern carries; otherwise fall back to that compile-time anchor. Returns the engine "no fully-known byte"
-        // sentinel (size()) when segment 0 has no full byte. Correctness-neutral: the anchor only selects which single
-        // byte the memchr prefilter sweeps for; the full masked compare still decides every accepted position.
-        //
-        // The override is confined to segment 0 (the fixed run before the first bounded jump), exactly like the
-        // compile-time anchor: the segmented matcher locates that first run and then walks the variable gaps, so a byte
-        // in a later segment sits at a gap-dependent address the memchr prefilter cannot sweep for. Choosing an anchor
-        // outside segment 0 would compute a wrong candidate start and silently miss real matches.
-        [[nodiscard]] inline std::size_t choose_scan_anchor(const scan::Pattern &pattern,
-                                                            const HaystackHistogram &histogram) noexcept
+        // A multi-range scope samples its widest span, the bytes a scan over it spends most of its time in. Sampling
+        // the set's bounds would stride into the gaps between spans -- memory the caller excluded from the scan.
+        [[nodiscard]] inline HaystackHistogram sample_haystack(const RegionSet &scope, scan::Pages pages) noexcept
         {
-            const std::size_t size = pattern.size();
-            if (histogram.sampled < SAMPLE_MIN_BYTES)
+            Region widest{};
+            for (const Region &range : scope.ranges())
             {
-                return pattern.has_anchor() ? pattern.anchor_index() : size;
+                widest = (range.size > widest.size) ? range : widest;
             }
+            return sample_haystack(widest, pages);
+        }
+
+        // The fully-known segment-0 byte whose value the sample counts least often, skipping index @p skip (size()
+        // skips none); size() when there is none. Ties break by first occurrence.
+        [[nodiscard]] inline std::size_t rarest_sampled_literal(const scan::Pattern &pattern,
+                                                                const HaystackHistogram &histogram,
+                                                                std::size_t skip) noexcept
+        {
+            const std::size_t size = pattern.size();
             const std::span<const std::byte> bytes = pattern.bytes();
             const std::span<const std::byte> mask = pattern.mask();
             const detail::PatternBuffer &data = detail::pattern_buffer(pattern);
@@ -107,7 +122,7 @@ namespace DetourModKit
             std::uint32_t best_count = 0;
             for (std::size_t i = 0; i < segment0_end; ++i)
             {
-                if (mask[i] != std::byte{0xFF})
+                if (i == skip || mask[i] != std::byte{0xFF})
                 {
                     // Only a fully-known byte gives the prefilter one exact value to memchr for; nibble / wildcard
                     // positions cannot anchor.
@@ -123,13 +138,39 @@ namespace DetourModKit
             return best_index;
         }
 
-        // Builds the engine pattern for a value Pattern with the haystack-chosen anchor. Allocates two small vectors,
-        // so every caller on a noexcept path guards this against std::bad_alloc.
+        // When a sufficient haystack sample exists, pick the pattern's fully-known byte whose value is rarest in this
+        // image (the most selective prefilter for this haystack), overriding the compile-time rarest-byte anchor the
+        // Pattern carries; otherwise fall back to that compile-time anchor. Returns the engine "no fully-known byte"
+        // sentinel (size()) when segment 0 has no full byte. Correctness-neutral: the anchor only selects which single
+        // byte the memchr prefilter sweeps for; the full masked compare still decides every accepted position.
+        //
+        // The override is confined to segment 0 (the fixed run before the first bounded jump), exactly like the
+        // compile-time anchor: the segmented matcher locates that first run and then walks the variable gaps, so a byte
+        // in a later segment sits at a gap-dependent address the memchr prefilter cannot sweep for. Choosing an anchor
+        // outside segment 0 would compute a wrong candidate start and silently miss real matches.
+        [[nodiscard]] inline std::size_t choose_scan_anchor(const scan::Pattern &pattern,
+                                                            const HaystackHistogram &histogram) noexcept
+        {
+            if (histogram.sampled < SAMPLE_MIN_BYTES)
+            {
+                return pattern.has_anchor() ? pattern.anchor_index() : pattern.size();
+            }
+            return rarest_sampled_literal(pattern, histogram, pattern.size());
+        }
+
+        // Builds the engine pattern for a value Pattern with the haystack-chosen anchor. With a sufficient sample the
+        // prefilter partner is ranked against the same histogram; otherwise engine_pattern_from's compile-time pick
+        // stands. Allocates two small vectors, so every caller on a noexcept path guards this against std::bad_alloc.
         [[nodiscard]] inline EnginePattern to_engine_pattern(const scan::Pattern &pattern,
                                                              const HaystackHistogram &histogram)
         {
             const std::size_t anchor = choose_scan_anchor(pattern, histogram);
-            return engine_pattern_from(pattern, anchor);
+            EnginePattern compiled = engine_pattern_from(pattern, anchor);
+            if (histogram.sampled >= SAMPLE_MIN_BYTES && anchor < pattern.size())
+            {
+                compiled.partner = rarest_sampled_literal(pattern, histogram, anchor);
+            }
+            return compiled;
         }
 
         // Direct-tier resolution: the resolved address is the match plus the signed walk-back. Screened through the
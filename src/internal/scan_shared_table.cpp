@@ -0,0 +1,274 @@
+/**
+ * @file internal/scan_shared_table.cpp
+ * @brief The process-wide resolution table: one named, pagefile-backed mapping of seqlock-guarded slots.
+ * @details The mapping is created zero-filled, so an all-zero slot is empty and an all-zero header means "not yet
+ *          initialized". The first instance to map it installs the magic with a compare-exchange; every later one
+ *          only checks it. Slots are claimed by a compare-exchange on their key and never released, so a key, once
+ *          published, keeps its slot for the life of the mapping and a newer resolution simply overwrites it.
+ */
+
+#include "internal/scan_shared_table.hpp"
+
+#include "DetourModKit/version.hpp"
+
+#include "internal/fnv1a.hpp"
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Bump on any change to SharedHeader / SharedSlot or the probing scheme. It is part of the mapping name, so
+        // instances built against different layouts never open each other's table; the header check below is only a
+        // second line of defence against a foreign mapping that happens to take the name.
+        constexpr std::uint32_t TABLE_LAYOUT = 1;
+        constexpr std::uint64_t TABLE_MAGIC = 0x444D'4B52'5442'4C00ULL | TABLE_LAYOUT; // "DMKRTBL" + layout
+
+        // 4096 slots of one cache line each: room for every signature a realistic mod set resolves, in 256 KiB of
+        // pagefile-backed memory whose pages are only faulted in as slots are touched.
+        constexpr std::size_t SLOT_COUNT = 4096;
+        // A full probe run means the table is saturated around this key; publishing gives up rather than scanning
+        // the whole array, and the entry stays in the publishing instance's own cache.
+        constexpr std::size_t MAX_PROBES = 32;
+
+        struct alignas(64) SharedHeader
+        {
+            std::uint64_t magic;
+        };
+
+        // key == 0 is an empty slot. sequence is even when the payload is stable and odd while a writer holds it;
+        // zero additionally means no payload was ever published.
+        struct alignas(64) SharedSlot
+        {
+            std::uint64_t key;
+            std::uint64_t sequence;
+            std::uint64_t identity_stamp; // time_date_stamp << 32 | size_of_image
+            std::uint64_t section_hash;
+            std::uint64_t candidate_index;
+            std::uint64_t match_rva;
+            std::uint64_t resolved_rva;
+        };
+
+        constexpr std::size_t TABLE_BYTES = sizeof(SharedHeader) + SLOT_COUNT * sizeof(SharedSlot);
+
+        [[nodiscard]] std::unexpected<Error> table_error(ErrorCode code, std::uint32_t detail = 0) noexcept
+        {
+            return std::unexpected(Error{code, "scan::ResolutionCache::share_in_process", detail});
+        }
+
+        [[nodiscard]] SharedHeader &header_of(void *view) noexcept
+        {
+            return *static_cast<SharedHeader *>(view);
+        }
+
+        [[nodiscard]] SharedSlot *slots_of(void *view) noexcept
+        {
+            return reinterpret_cast<SharedSlot *>(static_cast<std::byte *>(view) + sizeof(SharedHeader));
+        }
+
+        [[nodiscard]] std::uint64_t load_relaxed(std::uint64_t &word) noexcept
+        {
+            return std::atomic_ref<std::uint64_t>(word).load(std::memory_order_relaxed);
+        }
+
+        void store_relaxed(std::uint64_t &word, std::uint64_t value) noexcept
+        {
+            std::atomic_ref<std::uint64_t>(word).store(value, std::memory_order_relaxed);
+        }
+
+        // The slot key folds the identity into the request key, so the same request resolved against two builds of
+        // a module (a game and its launcher sharing code, say) occupies two slots instead of evicting each other.
+        [[nodiscard]] std::uint64_t slot_key(std::uint64_t key, const scan::ModuleIdentity &identity) noexcept
+        {
+            std::uint64_t hash = detail::fnv1a_int(detail::FNV1A64_OFFSET, key);
+            hash = detail::fnv1a_int(hash, identity.time_date_stamp);
+            hash = detail::fnv1a_int(hash, identity.size_of_image);
+            hash = detail::fnv1a_int(hash, identity.section_hash);
+            return hash == 0 ? 1 : hash;
+        }
+
+        [[nodiscard]] std::uint64_t identity_stamp(const scan::ModuleIdentity &identity) noexcept
+        {
+            return (static_cast<std::uint64_t>(identity.time_date_stamp) << 32) | identity.size_of_image;
+        }
+    } // anonymous namespace
+
+    detail::SharedResolutionTable::SharedResolutionTable(void *mapping, void *view) noexcept
+        : m_mapping(mapping), m_view(view)
+    {
+    }
+
+    detail::SharedResolutionTable::SharedResolutionTable(SharedResolutionTable &&other) noexcept
+        : m_mapping(std::exchange(other.m_mapping, nullptr)), m_view(std::exchange(other.m_view, nullptr))
+    {
+    }
+
+    detail::SharedResolutionTable &detail::SharedResolutionTable::operator=(SharedResolutionTable &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_mapping = std::exchange(other.m_mapping, nullptr);
+            m_view = std::exchange(other.m_view, nullptr);
+        }
+        return *this;
+    }
+
+    detail::SharedResolutionTable::~SharedResolutionTable() noexcept
+    {
+        release();
+    }
+
+    void detail::SharedResolutionTable::release() noexcept
+    {
+        if (m_view != nullptr)
+        {
+            UnmapViewOfFile(m_view);
+            m_view = nullptr;
+        }
+        if (m_mapping != nullptr)
+        {
+            CloseHandle(m_mapping);
+            m_mapping = nullptr;
+        }
+    }
+
+    Result<detail::SharedResolutionTable> detail::SharedResolutionTable::open() noexcept
+    {
+        // Local\ keeps the name in this session's namespace; the process id keeps two running games (or two
+        // instances of one) from ever sharing a table, since their modules live at different addresses.
+        wchar_t name[96]{};
+        std::swprintf(name, std::size(name), L"Local\\DetourModKit.ResolutionTable.v%u.%u.%lu",
+                      static_cast<unsigned>(DMK_VERSION_MAJOR), static_cast<unsigned>(TABLE_LAYOUT),
+                      static_cast<unsigned long>(GetCurrentProcessId()));
+
+        HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | SEC_COMMIT, 0,
+                                            static_cast<DWORD>(TABLE_BYTES), name);
+        if (mapping == nullptr)
+        {
+            return table_error(ErrorCode::SystemCallFailed, GetLastError());
+        }
+        void *view = MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, TABLE_BYTES);
+        if (view == nullptr)
+        {
+            const DWORD error = GetLastError();
+            CloseHandle(mapping);
+            return table_error(ErrorCode::SystemCallFailed, error);
+        }
+        SharedResolutionTable table(mapping, view);
+
+        // An existing mapping smaller than the table already failed the view above; what remains to rule out is one
+        // large enough that holds something else.
+        std::uint64_t expected = 0;
+        std::atomic_ref<std::uint64_t> magic(header_of(view).magic);
+        if (!magic.compare_exchange_strong(expected, TABLE_MAGIC, std::memory_order_acq_rel) &&
+            expected != TABLE_MAGIC)
+        {
+            return table_error(ErrorCode::InvalidRange);
+        }
+        return table;
+    }
+
+    std::optional<detail::SharedResolution>
+    detail::SharedResolutionTable::lookup(std::uint64_t key, const scan::ModuleIdentity &identity) const noexcept
+    {
+        if (m_view == nullptr)
+        {
+            return std::nullopt;
+        }
+        const std::uint64_t wanted = slot_key(key, identity);
+        SharedSlot *const slots = slots_of(m_view);
+        for (std::size_t probe = 0; probe < MAX_PROBES; ++probe)
+        {
+            SharedSlot &slot = slots[(wanted + probe) % SLOT_COUNT];
+            const std::uint64_t occupant = std::atomic_ref<std::uint64_t>(slot.key).load(std::memory_order_acquire);
+            if (occupant == 0)
+            {
+                return std::nullopt;
+            }
+            if (occupant != wanted)
+            {
+                continue;
+            }
+
+            std::atomic_ref<std::uint64_t> sequence(slot.sequence);
+            const std::uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before == 0 || (before & 1U) != 0)
+            {
+                // Claimed but never published yet, or a writer is mid-update: treat as absent, never wait.
+                return std::nullopt;
+            }
+            const std::uint64_t stamp = load_relaxed(slot.identity_stamp);
+            const std::uint64_t section_hash = load_relaxed(slot.section_hash);
+            const std::uint64_t candidate_index = load_relaxed(slot.candidate_index);
+            const std::uint64_t match_rva = load_relaxed(slot.match_rva);
+            const std::uint64_t resolved_rva = load_relaxed(slot.resolved_rva);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before)
+            {
+                return std::nullopt;
+            }
+            // The slot key is a hash; the identity check makes a collision a miss instead of a wrong-build entry.
+            if (stamp != identity_stamp(identity) || section_hash != identity.section_hash ||
+                candidate_index > std::numeric_limits<std::uint32_t>::max())
+            {
+                return std::nullopt;
+            }
+            return SharedResolution{
+                .identity = identity,
+                .candidate_index = static_cast<std::uint32_t>(candidate_index),
+                .match_rva = match_rva,
+                .resolved_rva = resolved_rva,
+            };
+        }
+        return std::nullopt;
+    }
+
+    void detail::SharedResolutionTable::publish(std::uint64_t key, const SharedResolution &resolution) noexcept
+    {
+        if (m_view == nullptr)
+        {
+            return;
+        }
+        const std::uint64_t wanted = slot_key(key, resolution.identity);
+        SharedSlot *const slots = slots_of(m_view);
+        for (std::size_t probe = 0; probe < MAX_PROBES; ++probe)
+        {
+            SharedSlot &slot = slots[(wanted + probe) % SLOT_COUNT];
+            std::uint64_t occupant = 0;
+            std::atomic_ref<std::uint64_t> slot_key_ref(slot.key);
+            if (!slot_key_ref.compare_exchange_strong(occupant, wanted, std::memory_order_acq_rel) &&
+                occupant != wanted)
+            {
+                continue;
+            }
+
+            // Take the slot by moving its sequence from even to odd; a concurrent writer already holds it, and
+            // whichever of the two publishes is as good as the other, so this one steps aside.
+            std::atomic_ref<std::uint64_t> sequence(slot.sequence);
+            std::uint64_t current = sequence.load(std::memory_order_relaxed);
+            if ((current & 1U) != 0 ||
+                !sequence.compare_exchange_strong(current, current + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            store_relaxed(slot.identity_stamp, identity_stamp(resolution.identity));
+            store_relaxed(slot.section_hash, resolution.identity.section_hash);
+            store_relaxed(slot.candidate_index, resolution.candidate_index);
+            store_relaxed(slot.match_rva, resolution.match_rva);
+            store_relaxed(slot.resolved_rva, resolution.resolved_rva);
+            sequence.store(current + 2, std::memory_order_release);
+            return;
+        }
+    }
+} // namespace DetourModKit
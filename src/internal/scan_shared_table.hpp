@@ -0,0 +1,75 @@
+#ifndef DETOURMODKIT_INTERNAL_SCAN_SHARED_TABLE_HPP
+#define DETOURMODKIT_INTERNAL_SCAN_SHARED_TABLE_HPP
+
+/**
+ * @file internal/scan_shared_table.hpp
+ * @brief The process-wide resolution table behind ResolutionCache::share_in_process: one named file mapping that every
+ *        DetourModKit instance in the process can read and publish to.
+ * @details Each mod links its own copy of the library, so no static can be shared between them; a pagefile-backed
+ *          mapping whose name carries the process id, the library major version, and the table layout is the one
+ *          object they can all find. The table is a fixed array of open-addressed slots, written lock-free: a slot is
+ *          claimed by a compare-exchange on its key and its payload is guarded by a per-slot sequence counter, so a
+ *          reader never sees a half-written entry and a writer never blocks. Everything in it is a hint; the cache
+ *          re-verifies a shared entry exactly like one of its own.
+ */
+
+#include "DetourModKit/error.hpp"
+#include "DetourModKit/scan_cache.hpp"
+
+#include <cstdint>
+#include <optional>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// One published resolution: the cache entry in the module identity's own words.
+        struct SharedResolution
+        {
+            scan::ModuleIdentity identity{};
+            std::uint32_t candidate_index = 0;
+            std::uint64_t match_rva = 0;
+            std::uint64_t resolved_rva = 0;
+        };
+
+        /**
+         * @class SharedResolutionTable
+         * @brief This instance's view of the process-wide table; move-only, unmapped on destruction.
+         * @details The mapping lives as long as any instance holds a view, so a mod that unloads takes its view with
+         *          it while the entries it published stay available to the rest.
+         */
+        class SharedResolutionTable
+        {
+        public:
+            /**
+             * @brief Opens the table for this process, creating it on first use.
+             * @return The view, or Error{SystemCallFailed} (detail = GetLastError()) when the mapping cannot be
+             *         created or mapped, or Error{InvalidRange} when a mapping of that name does not hold a table of
+             *         this layout.
+             */
+            [[nodiscard]] static Result<SharedResolutionTable> open() noexcept;
+
+            SharedResolutionTable(SharedResolutionTable &&other) noexcept;
+            SharedResolutionTable &operator=(SharedResolutionTable &&other) noexcept;
+            SharedResolutionTable(const SharedResolutionTable &) = delete;
+            SharedResolutionTable &operator=(const SharedResolutionTable &) = delete;
+            ~SharedResolutionTable() noexcept;
+
+            /// The entry published for @p key against @p identity, or nullopt when none is (or one is mid-write).
+            [[nodiscard]] std::optional<SharedResolution> lookup(std::uint64_t key,
+                                                                 const scan::ModuleIdentity &identity) const noexcept;
+
+            /// Publishes @p resolution for @p key, replacing an older one; dropped when the table or slot is busy.
+            void publish(std::uint64_t key, const SharedResolution &resolution) noexcept;
+
+        private:
+            SharedResolutionTable(void *mapping, void *view) noexcept;
+            void release() noexcept;
+
+            void *m_mapping = nullptr;
+            void *m_view = nullptr;
+        };
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SCAN_SHARED_TABLE_HPP
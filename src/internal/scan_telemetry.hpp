@@ -0,0 +1,153 @@
+#ifndef DETOURMODKIT_INTERNAL_SCAN_TELEMETRY_HPP
+#define DETOURMODKIT_INTERNAL_SCAN_TELEMETRY_HPP
+
+/**
+ * @file internal/scan_telemetry.hpp
+ * @brief The per-scan work counters behind the DMK_ENABLE_SCAN_TELEMETRY build switch.
+ * @details A public scan or resolve opens a @ref DetourModKit::detail::TelemetryScope. The scope installs its sink as
+ *          the calling thread's current one, so the page walk and the matcher add to it without a parameter threaded
+ *          through every signature. A scope opened inside another sends its totals to the outer one when it closes,
+ *          so a resolve accounts for every scan it ran. Only the outermost scope on a thread counts as one operation:
+ *          it publishes its totals as the thread's last telemetry and adds them to the process-wide registry.
+ *
+ *          Parallel sweeps run on fork-join helpers. fork_join_dispatch captures the caller's sink and binds it on each
+ *          helper for the batch (@ref DetourModKit::detail::TelemetryBinding). The sink's counters are atomic for that
+ *          reason, and the caller reads them only after the join.
+ *
+ *          The matcher counts into an @ref DetourModKit::detail::EngineTally on its own stack and adds it to the sink
+ *          once per call, so the hot loop pays a register increment per candidate. In a build without the switch
+ *          every type here is empty and every call is an inline no-op.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        struct TelemetrySink;
+
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+        /// One scope's counters; atomic because fork-join helpers add while the owner's scan runs.
+        struct TelemetrySink
+        {
+            std::atomic<std::uint64_t> bytes_scanned{0};
+            std::atomic<std::uint64_t> regions_walked{0};
+            std::atomic<std::uint64_t> anchor_candidates{0};
+            std::atomic<std::uint64_t> verify_calls{0};
+            std::atomic<std::uint64_t> segmented_steps{0};
+            std::atomic<std::uint64_t> faults{0};
+        };
+
+        /// The calling thread's innermost open sink, or nullptr outside any scope.
+        [[nodiscard]] TelemetrySink *&current_telemetry_sink() noexcept;
+
+        /// Adds one page walk's regions, bytes and skipped faulted regions to the current sink.
+        void record_page_walk(std::uint64_t regions, std::uint64_t bytes, std::uint64_t faults) noexcept;
+
+        /// Adds one matcher call's candidates, verifies and bounded-jump node visits to the current sink.
+        void record_match_work(std::uint64_t candidates, std::uint64_t verifies, std::uint64_t steps) noexcept;
+
+        /**
+         * @class TelemetryScope
+         * @brief Collects the work of one public scan or resolve on the calling thread.
+         * @details Non-copyable and non-movable: the thread's current-sink pointer refers to it until it closes.
+         */
+        class TelemetryScope
+        {
+        public:
+            TelemetryScope() noexcept;
+            ~TelemetryScope() noexcept;
+            TelemetryScope(const TelemetryScope &) = delete;
+            TelemetryScope &operator=(const TelemetryScope &) = delete;
+
+            /// The counters so far, with the time since the scope opened.
+            [[nodiscard]] scan::ScanTelemetry snapshot() const noexcept;
+
+        private:
+            TelemetrySink m_sink;
+            TelemetrySink *m_parent;
+            std::chrono::steady_clock::time_point m_start;
+        };
+
+        /// Binds a captured sink as the calling thread's current one for its lifetime; a fork-join helper's view.
+        class TelemetryBinding
+        {
+        public:
+            explicit TelemetryBinding(TelemetrySink *sink) noexcept
+                : m_saved(current_telemetry_sink())
+            {
+                current_telemetry_sink() = sink;
+            }
+            ~TelemetryBinding() noexcept { current_telemetry_sink() = m_saved; }
+            TelemetryBinding(const TelemetryBinding &) = delete;
+            TelemetryBinding &operator=(const TelemetryBinding &) = delete;
+
+        private:
+            TelemetrySink *m_saved;
+        };
+
+        /// One matcher call's counts, kept in registers and added to the current sink when the call returns.
+        class EngineTally
+        {
+        public:
+            EngineTally() noexcept = default;
+            ~EngineTally() noexcept
+            {
+                if ((m_candidates | m_verifies | m_steps) != 0)
+                {
+                    record_match_work(m_candidates, m_verifies, m_steps);
+                }
+            }
+            EngineTally(const EngineTally &) = delete;
+            EngineTally &operator=(const EngineTally &) = delete;
+
+            void candidate() noexcept { ++m_candidates; }
+            void verify() noexcept { ++m_verifies; }
+            void steps(std::uint64_t count) noexcept { m_steps += count; }
+
+        private:
+            std::uint64_t m_candidates = 0;
+            std::uint64_t m_verifies = 0;
+            std::uint64_t m_steps = 0;
+        };
+#else
+        [[nodiscard]] inline TelemetrySink *current_telemetry_sink() noexcept
+        {
+            return nullptr;
+        }
+
+        inline void record_page_walk(std::uint64_t, std::uint64_t, std::uint64_t) noexcept {}
+
+        inline void record_match_work(std::uint64_t, std::uint64_t, std::uint64_t) noexcept {}
+
+        class TelemetryScope
+        {
+        public:
+            TelemetryScope() noexcept {}
+            [[nodiscard]] scan::ScanTelemetry snapshot() const noexcept { return {}; }
+        };
+
+        class TelemetryBinding
+        {
+        public:
+            explicit TelemetryBinding(TelemetrySink *) noexcept {}
+        };
+
+        class EngineTally
+        {
+        public:
+            void candidate() noexcept {}
+            void verify() noexcept {}
+            void steps(std::uint64_t) noexcept {}
+        };
+#endif // DMK_ENABLE_SCAN_TELEMETRY
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SCAN_TELEMETRY_HPP
@@ -0,0 +1,115 @@
+#ifndef DETOURMODKIT_INTERNAL_SCAN_XREF_INDEX_HPP
+#define DETOURMODKIT_INTERNAL_SCAN_XREF_INDEX_HPP
+
+/**
+ * @file internal/scan_xref_index.hpp
+ * @brief True-private per-batch index of a module's RIP-relative references, shared by every string-xref query.
+ * @details Never installed. Phase 2 of find_string_xref sweeps the whole code section once per query -- the narrow
+ *          shape scan for every query, the Zydis decode sweep for broad and derived-return queries -- so a manifest
+ *          with dozens of string anchors in one image repeats the same decode dozens of times. A batch entry point
+ *          (resolve_batch, the anchor table resolvers, manifest::resolve_and_gate) owns one XrefIndexCache and
+ *          installs it on each thread that runs a batch item; the first string query per module then builds a
+ *          sorted (target -> referencing site) table in one pass, and every later query becomes a binary search. The
+ *          narrow and broad tables are built independently and on first use, so a batch of ReferencingInstruction
+ *          anchors never pays for the Zydis sweep. The index records exactly what the per-query sweeps would count
+ *          -- the same windows, back-carry, and de-duplication -- and a window that faults while indexing fails every
+ *          lookup of that table closed, just as the per-query sweep would have skipped it. The index lives only as
+ *          long as its batch, so it never outlives the code bytes it describes across a hook install. Zydis stays
+ *          confined to scan_string_xref.cpp, which defines ModuleXrefIndex.
+ *
+ *          Phase 1 (locating the literal itself) is batched the same way: before its workers start, a batch entry
+ *          point hands every string literal it will query to prescan_string_literals, which finds them all in one
+ *          multi-pattern sweep per image and parks each literal's first and second occurrence in the module slot.
+ */
+
+#include "internal/memory_guarded.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// One module's lazily built reference tables; defined in scan_string_xref.cpp next to the decoder.
+        struct ModuleXrefIndex;
+
+        /**
+         * @class XrefIndexCache
+         * @brief The per-batch set of module reference indexes, shared by every worker of the batch.
+         * @details Holds one ModuleXrefIndex per distinct module range; creating a slot takes the cache lock, and
+         *          each slot builds its tables at most once under its own once-flags, so concurrent workers querying
+         *          the same module wait for one build instead of repeating it.
+         * @note Setup/control-plane only: slots and tables allocate.
+         */
+        class XrefIndexCache
+        {
+        public:
+            XrefIndexCache() noexcept;
+            ~XrefIndexCache() noexcept;
+
+            XrefIndexCache(const XrefIndexCache &) = delete;
+            XrefIndexCache &operator=(const XrefIndexCache &) = delete;
+
+            /// The index slot for @p range, created on first use; nullptr when the slot could not be allocated.
+            [[nodiscard]] ModuleXrefIndex *slot_for(ModuleSpan range) noexcept;
+
+        private:
+            std::mutex m_mutex;
+            std::vector<std::unique_ptr<ModuleXrefIndex>> m_modules;
+        };
+
+        /**
+         * @class ScopedXrefIndexCache
+         * @brief Installs an XrefIndexCache for the string-xref queries made on the calling thread.
+         * @details Installations nest; the destructor restores the previous cache. The cache is borrowed and must
+         *          outlive the instance. With none installed, find_string_xref runs its per-query sweeps unchanged.
+         */
+        class ScopedXrefIndexCache
+        {
+        public:
+            explicit ScopedXrefIndexCache(XrefIndexCache *cache) noexcept;
+            ~ScopedXrefIndexCache() noexcept;
+
+            ScopedXrefIndexCache(const ScopedXrefIndexCache &) = delete;
+            ScopedXrefIndexCache &operator=(const ScopedXrefIndexCache &) = delete;
+
+        private:
+            XrefIndexCache *m_previous;
+        };
+
+        /**
+         * @brief Fewest distinct literals per image for which prescan_string_literals sweeps instead of leaving each
+         *        query its own scans.
+         * @details A lone literal keeps its two per-query scans, which split a large image across every core; from two
+         *          literals on, one serial sweep replaces at least four full scans.
+         */
+        inline constexpr std::size_t STRING_PRESCAN_MIN_LITERALS = 2;
+
+        /// One string literal a batch will look up, and the image it will be looked up in.
+        struct StringLiteralQuery
+        {
+            scan::StringRefQuery query;
+            ModuleSpan range;
+        };
+
+        /**
+         * @brief Locates every literal of @p literals once per image and records the occurrences in @p cache.
+         * @details Literals are grouped by image and de-duplicated by their compiled bytes; each group of at least
+         *          STRING_PRESCAN_MIN_LITERALS is resolved by one scan_module_multi sweep over the image's readable
+         *          pages, asking for each literal's first and second occurrence. find_string_xref then reads its
+         *          phase-1 verdict from the table -- outcome-identical to its own two scans, fault handling included.
+         *          Must run before any thread queries the cache, since the tables are published without a lock. Purely
+         *          an accelerator: a failure leaves the affected images without a table, and their queries scan.
+         * @note Setup/control-plane only: walks each image and allocates.
+         */
+        void prescan_string_literals(XrefIndexCache &cache, std::span<const StringLiteralQuery> literals) noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SCAN_XREF_INDEX_HPP
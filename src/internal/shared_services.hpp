@@ -0,0 +1,144 @@
+#ifndef DETOURMODKIT_INTERNAL_SHARED_SERVICES_HPP
+#define DETOURMODKIT_INTERNAL_SHARED_SERVICES_HPP
+
+/**
+ * @file internal/shared_services.hpp
+ * @brief The process-wide registry behind services::enable: the seams the background service, the input poller and
+ *        the memory cache call to share their work with the other DetourModKit instances in the process.
+ * @details The registry is one named, pagefile-backed mapping whose name carries the process id and the layout below
+ *          it, like the resolution table's. It holds the host's identity and the address of the function table the
+ *          host exports, one slot per joined instance (with the table that instance exports back), the key sweep,
+ *          and the shared region table. Every accessor here is a no-op, or reports "not shared", unless this instance
+ *          is joined, so the call sites need no guard of their own.
+ *
+ *          The view is never unmapped once mapped: a game thread may be reading the region table from a protection
+ *          check at any moment, as the memory cache's own fast table is never freed under a reader.
+ */
+
+#include "internal/background_service.hpp"
+#include "internal/input_key_mask.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// True while this instance is joined as host or attached.
+        [[nodiscard]] bool shared_services_joined() noexcept;
+
+        /**
+         * @class HostSchedulerLease
+         * @brief Keeps the host's exported scheduler table callable for the lease's lifetime.
+         * @details A host leaving withdraws its table, then waits for every outstanding lease before it cancels the
+         *          tasks it runs for others, so a call through a live lease never reaches a host that is gone. Hold a
+         *          lease only for the calls themselves: never across a wait on this instance's own state that a task
+         *          running on the host might hold.
+         */
+        class HostSchedulerLease
+        {
+        public:
+            HostSchedulerLease() noexcept = default;
+            HostSchedulerLease(HostSchedulerLease &&other) noexcept;
+            HostSchedulerLease &operator=(HostSchedulerLease &&) = delete;
+            HostSchedulerLease(const HostSchedulerLease &) = delete;
+            HostSchedulerLease &operator=(const HostSchedulerLease &) = delete;
+            ~HostSchedulerLease() noexcept;
+
+            /// False when no host table was live to lease.
+            [[nodiscard]] explicit operator bool() const noexcept { return m_table != nullptr; }
+
+            /// Identifies the host this lease reaches; a task id from one host means nothing to another.
+            [[nodiscard]] const void *host() const noexcept { return m_table; }
+
+            /**
+             * @brief Registers @p run (@p context) on the host: every @p period, or each time @p handle is signaled
+             *        when @p handle is non-null.
+             * @return The host's task id, or NO_BACKGROUND_TASK when the host refused it.
+             */
+            [[nodiscard]] BackgroundTaskId schedule(std::string_view name, std::chrono::milliseconds period,
+                                                    void *handle, ForeignTaskFn run, void *context) const noexcept;
+            void wake(BackgroundTaskId host_id) const noexcept;
+            /// As cancel_background_task() on the host: waits for a running task unless on the host's thread.
+            bool cancel(BackgroundTaskId host_id) const noexcept;
+
+        private:
+            friend HostSchedulerLease lease_host_scheduler() noexcept;
+            explicit HostSchedulerLease(const void *table) noexcept : m_table(table) {}
+
+            const void *m_table = nullptr;
+        };
+
+        /**
+         * @brief A lease on the live host's scheduler, or an empty one when no host has a table out.
+         * @details Does not check this instance's role, so a task delegated before leaving can still be cancelled;
+         *          whether to delegate a new task is the background service's own decision.
+         */
+        [[nodiscard]] HostSchedulerLease lease_host_scheduler() noexcept;
+
+        /**
+         * @brief Test-only: counts one lease on the host's table as taken (@p held) or returned.
+         * @details A host never leases its own table, so a single-instance suite cannot otherwise stand up an attached
+         *          instance caught inside a call while the host leaves. Not part of the shipping surface (this header
+         *          is never installed).
+         */
+        void stage_host_lease_for_test(bool held) noexcept;
+
+        /**
+         * @brief The keys every other joined instance's bindings read, when this instance owns the key sweep.
+         * @details The first joined poll thread to ask takes the sweep; it keeps it until release_key_sweep().
+         * @return The union of the other instances' wanted keys, or nullopt when another instance owns the sweep (or
+         *         this one is not joined).
+         */
+        [[nodiscard]] std::optional<KeyMask> claim_key_sweep() noexcept;
+
+        /// Publishes the owner's sweep: @p down is the state of every key in @p covered, sampled just now.
+        void publish_key_sweep(const KeyMask &down, const KeyMask &covered) noexcept;
+
+        /// Gives the sweep up, e.g. when the owner's poll thread stops. A no-op for an instance that does not own it.
+        void release_key_sweep() noexcept;
+
+        /// Records the keys this instance's bindings read, for the sweep owner's next cycle.
+        void publish_wanted_keys(const KeyMask &wanted) noexcept;
+
+        /**
+         * @brief Reads the current sweep when it was sampled within @p max_age.
+         * @param[out] down The sampled state of every key in @p covered.
+         * @param[out] covered The keys the sweep sampled.
+         * @return false when there is no sweep this fresh (or this instance owns it, or is not joined).
+         */
+        [[nodiscard]] bool read_key_sweep(std::chrono::milliseconds max_age, KeyMask &down, KeyMask &covered) noexcept;
+
+        /// One VirtualQuery result as the shared region table keeps it.
+        struct SharedRegion
+        {
+            std::uintptr_t base = 0;
+            std::size_t size = 0;
+            std::uint32_t protection = 0;
+            std::uint32_t state = 0;
+            std::uint32_t type = 0;
+        };
+
+        /// The invalidation count to pass shared_region_publish(), read before the VirtualQuery it publishes.
+        [[nodiscard]] std::uint64_t shared_region_epoch() noexcept;
+
+        /// The region holding @p address that some instance published since the last invalidation, if any.
+        [[nodiscard]] std::optional<SharedRegion> shared_region_lookup(std::uintptr_t address) noexcept;
+
+        /**
+         * @brief Publishes @p region, which must be one the protection cache pins, for the region holding @p address.
+         * @details @p epoch is shared_region_epoch() as read before the query, so a region queried across an
+         *          invalidation is never served after it.
+         */
+        void shared_region_publish(std::uintptr_t address, const SharedRegion &region, std::uint64_t epoch) noexcept;
+
+        /// Retires every published region, for any instance's memory::invalidate_range.
+        void shared_region_invalidate() noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SHARED_SERVICES_HPP
@@ -0,0 +1,77 @@
+#ifndef DETOURMODKIT_INTERNAL_SUBSYSTEM_USAGE_HPP
+#define DETOURMODKIT_INTERNAL_SUBSYSTEM_USAGE_HPP
+
+/**
+ * @file internal/subsystem_usage.hpp
+ * @brief True-private once-flags recording which process-wide subsystems have started since the last teardown.
+ * @details Every subsystem already starts on first use: the input poll thread on Input::start, the memory cache on
+ *          init_cache, the config watcher on enable_auto_reload, the pool, background service and file-watch threads
+ *          on their first task, and the deferred-resolution worker on its first table. What a small mod still paid for
+ *          was the teardown: ~Session shut every subsystem down in order, and shutting down one that was never used
+ *          first built its singleton state just to find nothing running. Each start site marks its flag, and the
+ *          session teardown takes the flag before the matching shutdown, so an untouched subsystem costs nothing at
+ *          either end while the teardown order stays exactly where it was.
+ *
+ *          A flag is set before the subsystem's state goes live and cleared only by the teardown that shuts it down,
+ *          so a start racing the teardown is either shut down by it or left marked for the next one.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// Subsystems whose teardown the session skips when they never started.
+        enum class Subsystem : std::uint8_t
+        {
+            Input,
+            MemoryCache,
+            ConfigWatcher,
+            FileWatchService,
+            ForkJoinPool,
+            BackgroundService,
+            DeferredResolution,
+            SharedServices
+        };
+
+        // The flag word. Constant-initialized, so it is ready before any static constructor that might start a
+        // subsystem, and never destroyed before a static destructor that tears one down.
+        [[nodiscard]] inline std::atomic<std::uint32_t> &subsystems_used_word() noexcept
+        {
+            static std::atomic<std::uint32_t> used{0};
+            return used;
+        }
+
+        [[nodiscard]] constexpr std::uint32_t subsystem_bit(Subsystem subsystem) noexcept
+        {
+            return std::uint32_t{1} << static_cast<std::uint32_t>(subsystem);
+        }
+
+        /// Marks @p subsystem started. A plain load when it already is, so a start path can call it every time.
+        inline void mark_subsystem_used(Subsystem subsystem) noexcept
+        {
+            const std::uint32_t bit = subsystem_bit(subsystem);
+            if ((subsystems_used_word().load(std::memory_order_relaxed) & bit) == 0)
+            {
+                subsystems_used_word().fetch_or(bit, std::memory_order_acq_rel);
+            }
+        }
+
+        /// Whether @p subsystem started since the last teardown took its flag.
+        [[nodiscard]] inline bool subsystem_used(Subsystem subsystem) noexcept
+        {
+            return (subsystems_used_word().load(std::memory_order_acquire) & subsystem_bit(subsystem)) != 0;
+        }
+
+        /// Clears @p subsystem's flag and returns whether it was set: the teardown's "does this need shutting down".
+        [[nodiscard]] inline bool take_subsystem_used(Subsystem subsystem) noexcept
+        {
+            const std::uint32_t bit = subsystem_bit(subsystem);
+            return (subsystems_used_word().fetch_and(~bit, std::memory_order_acq_rel) & bit) != 0;
+        }
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_SUBSYSTEM_USAGE_HPP
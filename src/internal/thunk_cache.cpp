@@ -0,0 +1,93 @@
+/**
+ * @file internal/thunk_cache.cpp
+ * @brief The jump-thunk destination cache behind hooked-prologue recovery.
+ * @details A fixed direct-mapped table under one reader/writer lock: recovery runs off the hot path, a few times per
+ *          resolve, so a colliding thunk simply evicts the slot it maps to. Invalidation is a generation bump and
+ *          never takes the lock.
+ */
+
+#include "internal/thunk_cache.hpp"
+
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/srw_shared_mutex.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Slots in the table. A process with more live foreign thunks than this on one recovery pass only re-decodes
+        // the ones that collide.
+        constexpr std::size_t THUNK_CACHE_SLOTS = 256;
+
+        struct ThunkSlot
+        {
+            std::uintptr_t thunk = 0;
+            detail::ThunkDecoder decode = nullptr;
+            std::uintptr_t target = 0;
+            std::uint64_t generation = 0;
+        };
+
+        detail::SrwSharedMutex s_thunk_mutex;
+        std::array<ThunkSlot, THUNK_CACHE_SLOTS> s_thunk_slots{};
+        // Starts above the slots' zero so an untouched slot is never current.
+        std::atomic<std::uint64_t> s_thunk_generation{1};
+        std::atomic<std::uint64_t> s_thunk_hits{0};
+        std::atomic<std::uint64_t> s_thunk_misses{0};
+
+        [[nodiscard]] std::size_t thunk_slot_index(std::uintptr_t thunk) noexcept
+        {
+            // Fibonacci hashing over the address; thunks are rarely aligned beyond 16 bytes, so drop only those bits.
+            const std::uint64_t mixed = static_cast<std::uint64_t>(thunk >> 4) * 0x9E3779B97F4A7C15ULL;
+            return static_cast<std::size_t>(mixed >> 56) % THUNK_CACHE_SLOTS;
+        }
+    } // anonymous namespace
+
+    std::optional<std::uintptr_t> detail::resolve_thunk_target(std::uintptr_t thunk, ThunkDecoder decode) noexcept
+    {
+        if (decode == nullptr)
+        {
+            return std::nullopt;
+        }
+        const std::size_t index = thunk_slot_index(thunk);
+        const std::uint64_t generation = s_thunk_generation.load(std::memory_order_acquire);
+        {
+            std::shared_lock lock{s_thunk_mutex};
+            const ThunkSlot &slot = s_thunk_slots[index];
+            if (slot.generation == generation && slot.thunk == thunk && slot.decode == decode)
+            {
+                s_thunk_hits.fetch_add(1, std::memory_order_relaxed);
+                return slot.target;
+            }
+        }
+        s_thunk_misses.fetch_add(1, std::memory_order_relaxed);
+
+        const std::optional<std::uintptr_t> target = decode(thunk);
+        if (!target || !is_plausible_ptr(*target) || !is_executable_address(*target))
+        {
+            return std::nullopt;
+        }
+        std::unique_lock lock{s_thunk_mutex};
+        s_thunk_slots[index] = ThunkSlot{thunk, decode, *target, generation};
+        return target;
+    }
+
+    void detail::invalidate_thunk_targets() noexcept
+    {
+        s_thunk_generation.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+    detail::ThunkCacheStats detail::thunk_cache_stats() noexcept
+    {
+        return ThunkCacheStats{s_thunk_hits.load(std::memory_order_relaxed),
+                               s_thunk_misses.load(std::memory_order_relaxed)};
+    }
+} // namespace DetourModKit
@@ -0,0 +1,53 @@
+#ifndef DETOURMODKIT_INTERNAL_THUNK_CACHE_HPP
+#define DETOURMODKIT_INTERNAL_THUNK_CACHE_HPP
+
+/**
+ * @file internal/thunk_cache.hpp
+ * @brief True-private cache of foreign jump-thunk destinations, keyed by thunk address, for hooked-prologue recovery.
+ * @details Never installed. Several targets hooked by the same overlay or hook library land on the same handful of
+ *          thunks, and prologue recovery would otherwise copy, decode, and page-query each one again for every target
+ *          it recovers. The cache keeps only destinations that passed the recovery gate (a plausible pointer into
+ *          committed executable memory); a thunk that failed it is decoded again next time, so a trampoline allocated
+ *          later is never hidden behind a cached refusal.
+ *
+ *          Entries live for the session. Every memory::invalidate_range / clear_cache retires them all (through the
+ *          protection cache's one retire point, which shutdown_cache also reaches), as does an integrity::CodeMonitor
+ *          raising a change. Between those, a thunk whose destination another library re-points is served its old
+ *          destination; recovery uses the destination only to confirm the site is a real redirect, never as the
+ *          address it returns, so a stale entry can at worst accept a site whose detour was since freed.
+ */
+
+#include <cstdint>
+#include <optional>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        /// Decodes the jump at a thunk address to its destination (one of the x86_decode.hpp decoders).
+        using ThunkDecoder = std::optional<std::uintptr_t> (*)(std::uintptr_t) noexcept;
+
+        /**
+         * @brief The destination @p decode finds at @p thunk, when it is a plausible address in executable memory.
+         * @details Served from the cache when an entry for this thunk and decoder is current; otherwise decoded,
+         *          gated, and (on success) cached with the invalidation count read before the decode, so a
+         *          destination decoded across an invalidation is never served after it. Safe from any thread.
+         */
+        [[nodiscard]] std::optional<std::uintptr_t> resolve_thunk_target(std::uintptr_t thunk,
+                                                                         ThunkDecoder decode) noexcept;
+
+        /// Retires every cached destination. Lock-free, so the memory cache may call it from under its own locks.
+        void invalidate_thunk_targets() noexcept;
+
+        /// Lookups served from the cache and lookups that decoded, over the process lifetime.
+        struct ThunkCacheStats
+        {
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+        };
+
+        [[nodiscard]] ThunkCacheStats thunk_cache_stats() noexcept;
+    } // namespace detail
+} // namespace DetourModKit
+
+#endif // DETOURMODKIT_INTERNAL_THUNK_CACHE_HPP
@@ -4,10 +4,54 @@
 #include <algorithm>
 #include <cassert>
 #include <climits>
+#include <cstdint>
 #include <cstring>
+#include <new>
 
 namespace DetourModKit::detail
 {
+    struct WinFileStreamBuf::OverlappedPages
+    {
+        struct Page
+        {
+            std::unique_ptr<char[]> data;
+            DWORD size{0};
+            // Bytes of this page already on file; a short write reissues from here.
+            DWORD written{0};
+            std::uint64_t offset{0};
+            OVERLAPPED overlapped{};
+            HANDLE event{nullptr};
+            bool in_flight{false};
+        };
+
+        OverlappedPages() noexcept = default;
+        OverlappedPages(const OverlappedPages &) = delete;
+        OverlappedPages &operator=(const OverlappedPages &) = delete;
+
+        ~OverlappedPages() noexcept
+        {
+            for (Page &page : pages)
+            {
+                if (page.event != nullptr)
+                {
+                    CloseHandle(page.event);
+                }
+            }
+        }
+
+        // The page the put area fills: the one after the queued run.
+        [[nodiscard]] size_t filling() const noexcept { return (oldest + queued) % count; }
+
+        std::array<Page, MAX_WRITE_BUFFERS> pages;
+        size_t count{0};
+        size_t page_size{0};
+        // Queued pages are [oldest, oldest + queued) in ring order; only the oldest is ever in flight.
+        size_t oldest{0};
+        size_t queued{0};
+        // File offset of the next queued page in truncating mode; append mode writes at end of file instead.
+        std::uint64_t next_offset{0};
+    };
+
     WinFileStreamBuf::WinFileStreamBuf() noexcept : m_handle(INVALID_HANDLE_VALUE), m_buffer{}
     {
         setp(m_buffer.data(), m_buffer.data() + BUFFER_SIZE);
@@ -26,6 +70,7 @@ namespace DetourModKit::detail
         }
 
         const bool append = (mode & std::ios_base::app) != 0;
+        m_append = append;
 
         // Append mode requests FILE_APPEND_DATA so the OS positions every WriteFile at the current end of file
         // atomically. This lets multiple writers sharing one file (e.g. several log sinks) append without
@@ -82,11 +127,168 @@ namespace DetourModKit::detail
         }
 
         flush_buffer();
+        if (m_overlapped)
+        {
+            // The pages must outlive every write that reads them, so wait the whole queue out before freeing them.
+            (void)pump_pages(0);
+        }
         CloseHandle(static_cast<HANDLE>(m_handle));
         m_handle = INVALID_HANDLE_VALUE;
+        m_overlapped.reset();
         setp(nullptr, nullptr);
     }
 
+    bool WinFileStreamBuf::enable_overlapped(size_t buffer_size, size_t buffer_count) noexcept
+    {
+        if (!is_open() || m_overlapped || buffer_count < 2 || buffer_count > MAX_WRITE_BUFFERS || buffer_size == 0 ||
+            buffer_size > MAXDWORD)
+        {
+            return false;
+        }
+
+        std::unique_ptr<OverlappedPages> pages(new (std::nothrow) OverlappedPages());
+        if (!pages)
+        {
+            return false;
+        }
+        pages->count = buffer_count;
+        pages->page_size = buffer_size;
+        for (size_t i = 0; i < buffer_count; ++i)
+        {
+            OverlappedPages::Page &page = pages->pages[i];
+            page.data.reset(new (std::nothrow) char[buffer_size]);
+            page.event = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+            if (!page.data || page.event == nullptr)
+            {
+                return false;
+            }
+        }
+
+        if (!flush_buffer())
+        {
+            return false;
+        }
+
+        // Truncating mode addresses every overlapped write explicitly, so it needs the position the synchronous writes
+        // reached; append mode keeps writing at end of file.
+        LARGE_INTEGER position{};
+        if (!m_append && !SetFilePointerEx(static_cast<HANDLE>(m_handle), LARGE_INTEGER{}, &position, FILE_CURRENT))
+        {
+            return false;
+        }
+
+        // ReOpenFile gives a second handle to the same open file with different flags: nothing is recreated or
+        // truncated, so the switch is invisible to readers of the log.
+        const DWORD access = m_append ? FILE_APPEND_DATA : GENERIC_WRITE;
+        HANDLE reopened = ReOpenFile(static_cast<HANDLE>(m_handle), access,
+                                     FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, FILE_FLAG_OVERLAPPED);
+        if (reopened == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        CloseHandle(static_cast<HANDLE>(m_handle));
+        m_handle = reopened;
+
+        pages->next_offset = static_cast<std::uint64_t>(position.QuadPart);
+        char *first = pages->pages[0].data.get();
+        m_overlapped = std::move(pages);
+        setp(first, first + buffer_size);
+        return true;
+    }
+
+    bool WinFileStreamBuf::submit() noexcept
+    {
+        if (!is_open())
+        {
+            return false;
+        }
+        return m_overlapped ? queue_current_page() : flush_buffer();
+    }
+
+    bool WinFileStreamBuf::queue_current_page() noexcept
+    {
+        OverlappedPages &pages = *m_overlapped;
+        const auto count = static_cast<DWORD>(pptr() - pbase());
+        if (count != 0)
+        {
+            OverlappedPages::Page &page = pages.pages[pages.filling()];
+            page.size = count;
+            page.written = 0;
+            page.offset = pages.next_offset;
+            pages.next_offset += count;
+            ++pages.queued;
+        }
+
+        // Block only when every page is queued: the put area needs one free page to continue into.
+        const bool ok = pump_pages(pages.count - 1);
+        char *next = pages.pages[pages.filling()].data.get();
+        setp(next, next + pages.page_size);
+        return ok;
+    }
+
+    bool WinFileStreamBuf::pump_pages(size_t target) noexcept
+    {
+        OverlappedPages &pages = *m_overlapped;
+        const auto handle = static_cast<HANDLE>(m_handle);
+        bool ok = true;
+        const auto retire = [&pages]() noexcept
+        {
+            pages.pages[pages.oldest].in_flight = false;
+            pages.oldest = (pages.oldest + 1) % pages.count;
+            --pages.queued;
+        };
+
+        while (pages.queued > 0)
+        {
+            OverlappedPages::Page &page = pages.pages[pages.oldest];
+            if (!page.in_flight)
+            {
+                const std::uint64_t at = page.offset + page.written;
+                page.overlapped = OVERLAPPED{};
+                page.overlapped.hEvent = page.event;
+                // 0xFFFFFFFF in both halves is the overlapped spelling of "append at end of file". Issuing one write at
+                // a time keeps the pages in order there as well.
+                page.overlapped.Offset = m_append ? 0xFFFFFFFFu : static_cast<DWORD>(at);
+                page.overlapped.OffsetHigh = m_append ? 0xFFFFFFFFu : static_cast<DWORD>(at >> 32);
+                if (!WriteFile(handle, page.data.get() + page.written, page.size - page.written, nullptr,
+                               &page.overlapped) &&
+                    GetLastError() != ERROR_IO_PENDING)
+                {
+                    ok = false;
+                    retire();
+                    continue;
+                }
+                page.in_flight = true;
+            }
+
+            const bool block = pages.queued > target;
+            DWORD transferred = 0;
+            if (!GetOverlappedResult(handle, &page.overlapped, &transferred, block ? TRUE : FALSE))
+            {
+                if (!block && GetLastError() == ERROR_IO_INCOMPLETE)
+                {
+                    break;
+                }
+                ok = false;
+                retire();
+                continue;
+            }
+            page.in_flight = false;
+            page.written += transferred;
+            // Same short-write rule as flush_buffer(): reissue the tail, but give up on a write that made no progress.
+            if (transferred == 0)
+            {
+                ok = false;
+                retire();
+            }
+            else if (page.written == page.size)
+            {
+                retire();
+            }
+        }
+        return ok;
+    }
+
     WinFileStreamBuf::int_type WinFileStreamBuf::overflow(int_type ch)
     {
         if (!is_open())
@@ -115,6 +317,12 @@ namespace DetourModKit::detail
             return -1;
         }
 
+        if (m_overlapped)
+        {
+            const bool queued = queue_current_page();
+            const bool drained = pump_pages(0);
+            return queued && drained ? 0 : -1;
+        }
         return flush_buffer() ? 0 : -1;
     }
 
@@ -154,6 +362,11 @@ namespace DetourModKit::detail
 
     bool WinFileStreamBuf::flush_buffer() noexcept
     {
+        if (m_overlapped)
+        {
+            return queue_current_page();
+        }
+
         const auto count = static_cast<DWORD>(pptr() - pbase());
         if (count == 0)
         {
@@ -214,6 +427,24 @@ namespace DetourModKit::detail
         }
     }
 
+    bool WinFileStream::enable_overlapped(size_t buffer_size, size_t buffer_count) noexcept
+    {
+        return m_buf.enable_overlapped(buffer_size, buffer_count);
+    }
+
+    size_t WinFileStream::buffered() const noexcept
+    {
+        return m_buf.buffered();
+    }
+
+    void WinFileStream::submit() noexcept
+    {
+        if (!m_buf.submit())
+        {
+            setstate(std::ios_base::badbit);
+        }
+    }
+
     bool WinFileStream::is_open() const noexcept
     {
         return m_buf.is_open();
@@ -2,7 +2,9 @@
 #define DETOURMODKIT_WIN_FILE_STREAM_HPP
 
 #include <array>
+#include <cstddef>
 #include <ios>
+#include <memory>
 #include <ostream>
 #include <string>
 
@@ -17,11 +19,20 @@ namespace DetourModKit::detail
      * @details Opens files with FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
      *          allowing external processes to read log files while they are being written. Uses an internal buffer to
      *          minimize WriteFile syscalls.
+     *
+     *          enable_overlapped() switches an open buffer to pipelined writes: the handle is reopened with
+     *          FILE_FLAG_OVERLAPPED and the put area rotates through two or three heap pages. A full page (or a
+     *          submit()) is handed to WriteFile without waiting, and the caller keeps filling the next page while it is
+     *          in flight. Only one write is outstanding at a time, in page order, so append-mode writers sharing the
+     *          file still land whole and in sequence; the caller blocks only when every page is queued. sync() and
+     *          close() wait for every queued page.
      */
     class WinFileStreamBuf : public std::streambuf
     {
     public:
         static constexpr size_t BUFFER_SIZE = 8192;
+        /// Most pages enable_overlapped() accepts.
+        static constexpr size_t MAX_WRITE_BUFFERS = 3;
 
         WinFileStreamBuf() noexcept;
         ~WinFileStreamBuf() noexcept override;
@@ -36,6 +47,29 @@ namespace DetourModKit::detail
         [[nodiscard]] bool is_open() const noexcept;
         void close() noexcept;
 
+        /**
+         * @brief Moves an open buffer to overlapped, multi-page writes.
+         * @param buffer_size Bytes per page.
+         * @param buffer_count Pages in rotation, 2 to MAX_WRITE_BUFFERS.
+         * @return true when the buffer is now overlapped; false (left as it was) when it is closed, the arguments are
+         *         out of range, or the handle could not be reopened or the pages allocated.
+         * @details Writes out the current put area first. Reopening keeps the file and its position, so nothing is
+         *          truncated. The mode lasts until the next open() or close().
+         */
+        [[nodiscard]] bool enable_overlapped(size_t buffer_size, size_t buffer_count) noexcept;
+        [[nodiscard]] bool is_overlapped() const noexcept { return m_overlapped != nullptr; }
+
+        /// Bytes in the put area not yet handed to the OS.
+        [[nodiscard]] size_t buffered() const noexcept { return static_cast<size_t>(pptr() - pbase()); }
+
+        /**
+         * @brief Hands the put area to the OS without waiting for it to reach the file.
+         * @details Overlapped: queues the current page and returns once a free page is ready. Otherwise the same
+         *          synchronous write as sync(). Use sync() (or the stream's flush()) when the bytes must be on disk.
+         * @return false when a write failed.
+         */
+        bool submit() noexcept;
+
     protected:
         int_type overflow(int_type ch) override;
         int sync() override;
@@ -44,8 +78,17 @@ namespace DetourModKit::detail
     private:
         bool flush_buffer() noexcept;
 
+        // The page ring and per-page OVERLAPPED state, defined in the .cpp so this header stays free of <windows.h>.
+        struct OverlappedPages;
+        // Queues the put area's page and points the put area at the next free page, waiting only when none is free.
+        bool queue_current_page() noexcept;
+        // Issues and completes queued writes in page order, blocking only while more than @p target pages are queued.
+        bool pump_pages(size_t target) noexcept;
+
         WinHandle m_handle;
+        bool m_append{false};
         std::array<char, BUFFER_SIZE> m_buffer;
+        std::unique_ptr<OverlappedPages> m_overlapped;
     };
 
     /**
@@ -71,6 +114,13 @@ namespace DetourModKit::detail
         [[nodiscard]] bool is_open() const noexcept;
         void close() noexcept;
 
+        /// See WinFileStreamBuf::enable_overlapped().
+        [[nodiscard]] bool enable_overlapped(size_t buffer_size, size_t buffer_count) noexcept;
+        /// See WinFileStreamBuf::buffered().
+        [[nodiscard]] size_t buffered() const noexcept;
+        /// See WinFileStreamBuf::submit(); sets badbit when a write failed.
+        void submit() noexcept;
+
     private:
         WinFileStreamBuf m_buf;
     };
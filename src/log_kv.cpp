@@ -0,0 +1,407 @@
+/**
+ * @file log_kv.cpp
+ * @brief Structured log decoder: varint reading, schema and event records, and text / JSON rendering.
+ */
+
+#include "DetourModKit/log_kv.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <ctime>
+#include <format>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <optional>
+#include <sstream>
+
+namespace DetourModKit
+{
+    namespace log_kv
+    {
+        namespace
+        {
+            /// Bounds-checked cursor over a record payload; every read returns nullopt past the end.
+            class Reader
+            {
+            public:
+                explicit Reader(std::span<const std::byte> bytes) noexcept : m_bytes(bytes) {}
+
+                [[nodiscard]] bool empty() const noexcept { return m_offset == m_bytes.size(); }
+
+                [[nodiscard]] std::optional<std::uint8_t> byte() noexcept
+                {
+                    if (m_offset >= m_bytes.size())
+                    {
+                        return std::nullopt;
+                    }
+                    return static_cast<std::uint8_t>(m_bytes[m_offset++]);
+                }
+
+                [[nodiscard]] std::optional<std::uint64_t> varint() noexcept
+                {
+                    std::uint64_t value = 0;
+                    for (unsigned shift = 0; shift < 64; shift += 7)
+                    {
+                        const auto next = byte();
+                        if (!next)
+                        {
+                            return std::nullopt;
+                        }
+                        value |= static_cast<std::uint64_t>(*next & 0x7FU) << shift;
+                        if ((*next & 0x80U) == 0)
+                        {
+                            return value;
+                        }
+                    }
+                    return std::nullopt;
+                }
+
+                [[nodiscard]] std::optional<std::uint64_t> fixed(std::size_t size) noexcept
+                {
+                    if (m_bytes.size() - m_offset < size)
+                    {
+                        return std::nullopt;
+                    }
+                    std::uint64_t value = 0;
+                    std::memcpy(&value, m_bytes.data() + m_offset, size);
+                    m_offset += size;
+                    return value;
+                }
+
+                [[nodiscard]] std::optional<std::string> text()
+                {
+                    const auto size = varint();
+                    if (!size || *size > m_bytes.size() - m_offset)
+                    {
+                        return std::nullopt;
+                    }
+                    std::string value(reinterpret_cast<const char *>(m_bytes.data() + m_offset),
+                                      static_cast<std::size_t>(*size));
+                    m_offset += static_cast<std::size_t>(*size);
+                    return value;
+                }
+
+                [[nodiscard]] std::span<const std::byte> take(std::size_t size) noexcept
+                {
+                    const std::span<const std::byte> taken = m_bytes.subspan(m_offset, size);
+                    m_offset += size;
+                    return taken;
+                }
+
+                [[nodiscard]] std::size_t remaining() const noexcept { return m_bytes.size() - m_offset; }
+
+            private:
+                std::span<const std::byte> m_bytes;
+                std::size_t m_offset{0};
+            };
+
+            [[nodiscard]] std::int64_t unzigzag(std::uint64_t value) noexcept
+            {
+                return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+            }
+
+            [[nodiscard]] bool read_schema(Reader &payload, Decoded &decoded,
+                                           std::vector<std::vector<std::uint64_t>> &last_values)
+            {
+                const auto number = payload.varint();
+                auto event_id = payload.text();
+                auto file = payload.text();
+                const auto line = payload.varint();
+                const auto count = payload.varint();
+                // Schemas are numbered in the order they are written, so a gap or a repeat is corruption.
+                if (!number || *number != decoded.schemas.size() || !event_id || !file || !line || !count ||
+                    *count > payload.remaining())
+                {
+                    return false;
+                }
+                Schema schema{std::move(*event_id), std::move(*file), static_cast<std::uint32_t>(*line), {}};
+                schema.fields.reserve(static_cast<std::size_t>(*count));
+                for (std::uint64_t i = 0; i < *count; ++i)
+                {
+                    const auto type = payload.byte();
+                    auto name = payload.text();
+                    if (!type || *type > static_cast<std::uint8_t>(KvType::Pointer) || !name)
+                    {
+                        return false;
+                    }
+                    schema.fields.push_back({std::move(*name), static_cast<KvType>(*type)});
+                }
+                last_values.emplace_back(schema.fields.size(), 0);
+                decoded.schemas.push_back(std::move(schema));
+                return true;
+            }
+
+            [[nodiscard]] bool read_event(Reader &payload, Decoded &decoded, std::int64_t &last_time_us,
+                                          std::vector<std::vector<std::uint64_t>> &last_values)
+            {
+                const auto number = payload.varint();
+                const auto level = payload.byte();
+                const auto delta = payload.varint();
+                if (!number || *number >= decoded.schemas.size() || !level ||
+                    *level > static_cast<std::uint8_t>(LogLevel::Error) || !delta)
+                {
+                    return false;
+                }
+                const Schema &schema = decoded.schemas[static_cast<std::size_t>(*number)];
+                std::vector<std::uint64_t> &previous = last_values[static_cast<std::size_t>(*number)];
+                Event event;
+                event.schema = static_cast<std::size_t>(*number);
+                event.level = static_cast<LogLevel>(*level);
+                event.time_us = last_time_us + unzigzag(*delta);
+                event.values.reserve(schema.fields.size());
+                for (const FieldSchema &field : schema.fields)
+                {
+                    std::optional<std::uint64_t> value;
+                    switch (field.type)
+                    {
+                    case KvType::Bool:
+                        value = payload.fixed(1);
+                        break;
+                    case KvType::Int:
+                    case KvType::UInt:
+                    case KvType::Pointer:
+                        if (const auto delta = payload.varint())
+                        {
+                            value = previous[event.values.size()] + static_cast<std::uint64_t>(unzigzag(*delta));
+                        }
+                        break;
+                    case KvType::Float32:
+                        value = payload.fixed(4);
+                        break;
+                    case KvType::Float64:
+                        value = payload.fixed(8);
+                        break;
+                    }
+                    if (!value)
+                    {
+                        return false;
+                    }
+                    event.values.push_back(*value);
+                }
+                last_time_us = event.time_us;
+                previous = event.values;
+                decoded.events.push_back(std::move(event));
+                return true;
+            }
+
+            [[nodiscard]] std::unexpected<Error> kv_error(ErrorCode code, const char *where) noexcept
+            {
+                return std::unexpected(Error{code, where});
+            }
+
+            /// JSON has no NaN or infinity, so format_json writes those as null.
+            [[nodiscard]] bool is_finite(KvType type, std::uint64_t bits) noexcept
+            {
+                if (type == KvType::Float32)
+                {
+                    const auto low = static_cast<std::uint32_t>(bits);
+                    float value;
+                    std::memcpy(&value, &low, sizeof(value));
+                    return std::isfinite(value);
+                }
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                return std::isfinite(value);
+            }
+
+            void append_json_string(std::string &out, std::string_view text)
+            {
+                out += '"';
+                for (const char c : text)
+                {
+                    switch (c)
+                    {
+                    case '"':
+                        out += "\\\"";
+                        break;
+                    case '\\':
+                        out += "\\\\";
+                        break;
+                    case '\n':
+                        out += "\\n";
+                        break;
+                    case '\r':
+                        out += "\\r";
+                        break;
+                    case '\t':
+                        out += "\\t";
+                        break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20)
+                        {
+                            std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+                        }
+                        else
+                        {
+                            out += c;
+                        }
+                    }
+                }
+                out += '"';
+            }
+        } // anonymous namespace
+
+        void append_value(std::string &out, KvType type, std::uint64_t bits)
+        {
+            switch (type)
+            {
+            case KvType::Bool:
+                out += bits != 0 ? "true" : "false";
+                return;
+            case KvType::Int:
+                std::format_to(std::back_inserter(out), "{}", static_cast<std::int64_t>(bits));
+                return;
+            case KvType::UInt:
+                std::format_to(std::back_inserter(out), "{}", bits);
+                return;
+            case KvType::Float32:
+            {
+                const auto low = static_cast<std::uint32_t>(bits);
+                float value;
+                std::memcpy(&value, &low, sizeof(value));
+                std::format_to(std::back_inserter(out), "{}", value);
+                return;
+            }
+            case KvType::Float64:
+            {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                std::format_to(std::back_inserter(out), "{}", value);
+                return;
+            }
+            case KvType::Pointer:
+                std::format_to(std::back_inserter(out), "0x{:X}", bits);
+                return;
+            }
+        }
+
+        Result<Decoded> decode(std::span<const std::byte> image)
+        {
+            if (image.size() < KV_FILE_HEADER_SIZE)
+            {
+                return kv_error(ErrorCode::MissingHeader, "log_kv::decode");
+            }
+            std::uint64_t magic;
+            std::uint32_t version;
+            std::memcpy(&magic, image.data(), sizeof(magic));
+            std::memcpy(&version, image.data() + sizeof(magic), sizeof(version));
+            if (magic != KV_MAGIC || version != KV_VERSION)
+            {
+                return kv_error(ErrorCode::MissingHeader, "log_kv::decode");
+            }
+
+            Decoded decoded;
+            std::int64_t last_time_us = 0;
+            // Per schema, the previous event's values, which integer fields are encoded against.
+            std::vector<std::vector<std::uint64_t>> last_values;
+            Reader records(image.subspan(KV_FILE_HEADER_SIZE));
+            while (!records.empty())
+            {
+                const auto kind = records.byte();
+                const auto size = records.varint();
+                if (!kind || !size || *size > records.remaining())
+                {
+                    decoded.truncated = true;
+                    break;
+                }
+                Reader payload(records.take(static_cast<std::size_t>(*size)));
+                bool valid = true;
+                if (*kind == KV_RECORD_SCHEMA)
+                {
+                    valid = read_schema(payload, decoded, last_values);
+                }
+                else if (*kind == KV_RECORD_EVENT)
+                {
+                    valid = read_event(payload, decoded, last_time_us, last_values);
+                }
+                if (!valid)
+                {
+                    decoded.truncated = true;
+                    break;
+                }
+            }
+            return decoded;
+        }
+
+        Result<Decoded> read_file(const std::string &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return kv_error(ErrorCode::FileOpenFailed, "log_kv::read_file");
+            }
+            const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return decode(std::as_bytes(std::span<const char>{bytes.data(), bytes.size()}));
+        }
+
+        std::string format_text(const Decoded &decoded, const Event &event, std::string_view timestamp_format)
+        {
+            const Schema &schema = decoded.schemas[event.schema];
+            const std::chrono::system_clock::time_point when{std::chrono::microseconds{event.time_us}};
+            const std::time_t second = std::chrono::system_clock::to_time_t(when);
+            std::tm tm_buf{};
+#if defined(_WIN32) || defined(_MSC_VER)
+            localtime_s(&tm_buf, &second);
+#else
+            localtime_r(&second, &tm_buf);
+#endif
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()) % 1000;
+            const std::string format{timestamp_format};
+            std::ostringstream stamp;
+            stamp << '[' << std::put_time(&tm_buf, format.c_str()) << '.' << std::setfill('0') << std::setw(3)
+                  << ms.count() << std::setfill(' ') << "] [" << std::setw(7) << std::left << to_string(event.level)
+                  << "] :: ";
+
+            std::string line = std::move(stamp).str();
+            std::format_to(std::back_inserter(line), "[{}:{}] {}", schema.file, schema.line, schema.event_id);
+            for (std::size_t i = 0; i < schema.fields.size() && i < event.values.size(); ++i)
+            {
+                std::format_to(std::back_inserter(line), " {}=", schema.fields[i].name);
+                append_value(line, schema.fields[i].type, event.values[i]);
+            }
+            return line;
+        }
+
+        std::string format_json(const Decoded &decoded, const Event &event)
+        {
+            const Schema &schema = decoded.schemas[event.schema];
+            std::string json;
+            std::format_to(std::back_inserter(json), "{{\"time_us\":{},\"level\":", event.time_us);
+            append_json_string(json, to_string(event.level));
+            json += ",\"event\":";
+            append_json_string(json, schema.event_id);
+            json += ",\"file\":";
+            append_json_string(json, schema.file);
+            std::format_to(std::back_inserter(json), ",\"line\":{},\"fields\":{{", schema.line);
+            for (std::size_t i = 0; i < schema.fields.size() && i < event.values.size(); ++i)
+            {
+                if (i != 0)
+                {
+                    json += ',';
+                }
+                append_json_string(json, schema.fields[i].name);
+                json += ':';
+                const KvType type = schema.fields[i].type;
+                if (type == KvType::Pointer)
+                {
+                    std::string text;
+                    append_value(text, type, event.values[i]);
+                    append_json_string(json, text);
+                }
+                else if ((type == KvType::Float32 || type == KvType::Float64) &&
+                         !is_finite(type, event.values[i]))
+                {
+                    json += "null";
+                }
+                else
+                {
+                    append_value(json, type, event.values[i]);
+                }
+            }
+            json += "}}";
+            return json;
+        }
+    } // namespace log_kv
+} // namespace DetourModKit
@@ -0,0 +1,140 @@
+/**
+ * @file log_ring.cpp
+ * @brief Crash-ring decoder: slot validation, ordering, and text rendering.
+ */
+
+#include "DetourModKit/log_ring.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+
+namespace DetourModKit
+{
+    namespace log_ring
+    {
+        namespace
+        {
+            template <typename T> [[nodiscard]] T load(const std::byte *at) noexcept
+            {
+                T value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+
+            [[nodiscard]] std::uint32_t fnv1a(std::uint32_t hash, const std::byte *data, std::size_t size) noexcept
+            {
+                for (std::size_t i = 0; i < size; ++i)
+                {
+                    hash ^= static_cast<std::uint8_t>(data[i]);
+                    hash *= 16777619U;
+                }
+                return hash;
+            }
+
+            [[nodiscard]] std::unexpected<Error> ring_error(ErrorCode code) noexcept
+            {
+                return std::unexpected(Error{code, "log_ring::decode"});
+            }
+        } // anonymous namespace
+
+        std::uint32_t slot_checksum(std::span<const std::byte, RING_SLOT_SIZE> slot) noexcept
+        {
+            const auto length =
+                std::min<std::size_t>(load<std::uint16_t>(slot.data() + SLOT_LENGTH_OFFSET), RING_SLOT_TEXT_SIZE);
+            std::uint32_t hash = 2166136261U;
+            hash = fnv1a(hash, slot.data() + SLOT_TIME_OFFSET, 8);
+            hash = fnv1a(hash, slot.data() + SLOT_LENGTH_OFFSET, 4);
+            return fnv1a(hash, slot.data() + RING_SLOT_HEADER_SIZE, length);
+        }
+
+        Result<Decoded> decode(std::span<const std::byte> image)
+        {
+            if (image.size() < RING_HEADER_SIZE ||
+                load<std::uint64_t>(image.data() + HEADER_MAGIC_OFFSET) != RING_MAGIC ||
+                load<std::uint32_t>(image.data() + HEADER_VERSION_OFFSET) != RING_VERSION ||
+                load<std::uint32_t>(image.data() + HEADER_SLOT_SIZE_OFFSET) != RING_SLOT_SIZE)
+            {
+                return ring_error(ErrorCode::MissingHeader);
+            }
+            const auto slot_count = load<std::uint64_t>(image.data() + HEADER_SLOT_COUNT_OFFSET);
+            if (slot_count == 0 || slot_count > (image.size() - RING_HEADER_SIZE) / RING_SLOT_SIZE)
+            {
+                return ring_error(ErrorCode::MissingHeader);
+            }
+
+            Decoded decoded;
+            decoded.total_sequence = load<std::uint64_t>(image.data() + HEADER_SEQUENCE_OFFSET);
+            decoded.records.reserve(static_cast<std::size_t>(std::min(slot_count, decoded.total_sequence)));
+            for (std::uint64_t index = 0; index < slot_count; ++index)
+            {
+                const std::span<const std::byte, RING_SLOT_SIZE> slot{
+                    image.data() + RING_HEADER_SIZE + static_cast<std::size_t>(index) * RING_SLOT_SIZE, RING_SLOT_SIZE};
+                const auto sequence = load<std::uint64_t>(slot.data() + SLOT_SEQUENCE_OFFSET);
+                if (sequence == 0)
+                {
+                    continue;
+                }
+                // A sequence that does not belong to this slot, a length past the slot, or a checksum mismatch all
+                // mean the slot was caught mid-write.
+                const auto length = load<std::uint16_t>(slot.data() + SLOT_LENGTH_OFFSET);
+                const auto level = load<std::uint8_t>(slot.data() + SLOT_LEVEL_OFFSET);
+                if ((sequence - 1) % slot_count != index || length > RING_SLOT_TEXT_SIZE ||
+                    level > static_cast<std::uint8_t>(LogLevel::Error) ||
+                    load<std::uint32_t>(slot.data() + SLOT_CHECKSUM_OFFSET) != slot_checksum(slot))
+                {
+                    ++decoded.torn_slots;
+                    continue;
+                }
+                Record &record = decoded.records.emplace_back();
+                record.sequence = sequence;
+                record.time_us = load<std::int64_t>(slot.data() + SLOT_TIME_OFFSET);
+                record.level = static_cast<LogLevel>(level);
+                record.truncated = (load<std::uint8_t>(slot.data() + SLOT_FLAGS_OFFSET) & RING_FLAG_TRUNCATED) != 0;
+                record.text.assign(reinterpret_cast<const char *>(slot.data() + RING_SLOT_HEADER_SIZE), length);
+            }
+            std::sort(decoded.records.begin(), decoded.records.end(),
+                      [](const Record &a, const Record &b) { return a.sequence < b.sequence; });
+            return decoded;
+        }
+
+        Result<Decoded> read_file(const std::string &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return std::unexpected(Error{ErrorCode::FileOpenFailed, "log_ring::read_file"});
+            }
+            const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return decode(std::as_bytes(std::span<const char>{bytes.data(), bytes.size()}));
+        }
+
+        std::string format_line(const Record &record, std::string_view timestamp_format)
+        {
+            const std::chrono::system_clock::time_point when{std::chrono::microseconds{record.time_us}};
+            const std::time_t second = std::chrono::system_clock::to_time_t(when);
+            std::tm tm_buf{};
+#if defined(_WIN32) || defined(_MSC_VER)
+            localtime_s(&tm_buf, &second);
+#else
+            localtime_r(&second, &tm_buf);
+#endif
+            const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(when.time_since_epoch()) % 1000;
+            const std::string format{timestamp_format};
+            std::ostringstream line;
+            line << '[' << std::put_time(&tm_buf, format.c_str()) << '.' << std::setfill('0') << std::setw(3)
+                 << ms.count() << std::setfill(' ') << "] [" << std::setw(7) << std::left << to_string(record.level)
+                 << "] :: " << record.text;
+            if (record.truncated)
+            {
+                line << " [truncated]";
+            }
+            return std::move(line).str();
+        }
+    } // namespace log_ring
+} // namespace DetourModKit
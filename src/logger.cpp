@@ -1,6 +1,7 @@
 #include "DetourModKit/logger.hpp"
 #include "DetourModKit/diagnostics.hpp"
 #include "DetourModKit/filesystem.hpp"
+#include "DetourModKit/log_kv.hpp"
 
 #include "internal/async_logger.hpp"
 #include "internal/win_file_stream.hpp"
@@ -9,12 +10,15 @@
 #include <algorithm>
 #include <cctype>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <ctime>
 #include <filesystem>
 #include <iomanip>
 #include <iostream>
 #include <new>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 
@@ -26,6 +30,25 @@ namespace DetourModKit::detail
     // after-shutdown enable cannot reach, because by then the stream is also closed). Set / cleared on a single thread
     // inside a test fixture; a plain function pointer, so it is null and branch-only in production.
     void (*g_logger_shutdown_gap_probe)() noexcept = nullptr;
+
+    void render_kv_log_record(std::string &out, const std::byte *record)
+    {
+        KvLogHeader header;
+        std::memcpy(&header, record, sizeof(header));
+        const std::string_view file{header.text.file};
+        const auto slash = file.find_last_of("/\\");
+        const std::string_view base = slash == std::string_view::npos ? file : file.substr(slash + 1);
+        std::format_to(std::back_inserter(out), "[{}:{}] {}", base, header.text.line,
+                       std::string_view(header.text.format, header.text.format_size));
+        const std::byte *cursor = record + sizeof(header);
+        for (std::uint32_t i = 0; i < header.field_count; ++i, cursor += sizeof(KvLogField))
+        {
+            KvLogField field;
+            std::memcpy(&field, cursor, sizeof(field));
+            std::format_to(std::back_inserter(out), " {}=", field.name);
+            log_kv::append_value(out, field.type, field.bits);
+        }
+    }
 } // namespace DetourModKit::detail
 
 namespace DetourModKit
@@ -34,6 +57,8 @@ namespace DetourModKit
     namespace
     {
         constexpr std::size_t EMERGENCY_ASYNC_LOGGER_LEAK_SLOTS = 16;
+        // Capacity Logger::m_sink_line keeps between lines; one oversized line must not pin its buffer for good.
+        constexpr std::size_t SINK_LINE_RETAIN = 16 * 1024;
 
         struct AsyncLoggerLeakSlot
         {
@@ -94,6 +119,17 @@ namespace DetourModKit
 
             std::terminate();
         }
+
+        [[nodiscard]] constexpr bool valid_log_level(LogLevel level) noexcept
+        {
+            const auto level_int = static_cast<std::underlying_type_t<LogLevel>>(level);
+            return level_int >= 0 && level_int <= static_cast<std::underlying_type_t<LogLevel>>(LogLevel::Error);
+        }
+
+        [[nodiscard]] constexpr std::uint32_t category_bit(LogCategory category) noexcept
+        {
+            return std::uint32_t{1} << static_cast<std::size_t>(category);
+        }
     } // anonymous namespace
 
     std::shared_ptr<const Logger::StaticConfig> Logger::get_static_config()
@@ -205,6 +241,7 @@ namespace DetourModKit
         m_log_file_name = config->log_file_name;
         m_timestamp_format = config->timestamp_format;
 
+        reset_category_levels();
         open_sink(false);
     }
 
@@ -213,9 +250,21 @@ namespace DetourModKit
           m_log_file_stream_ptr(std::make_shared<detail::WinFileStream>()),
           m_log_mutex_ptr(std::make_shared<std::mutex>())
     {
+        reset_category_levels();
         open_sink(false);
     }
 
+    void Logger::reset_category_levels() noexcept
+    {
+        // std::atomic has no copy-initialising array form, so the slots start value-initialised (Trace) and take the
+        // default level here, before the logger is reachable from another thread.
+        const LogLevel level = m_current_log_level.load(std::memory_order_relaxed);
+        for (std::atomic<LogLevel> &slot : m_category_levels)
+        {
+            slot.store(level, std::memory_order_relaxed);
+        }
+    }
+
     void Logger::open_sink(bool reconfiguring)
     {
         // The caller owns the synchronization: a constructor runs single-threaded before the logger is reachable, and
@@ -263,8 +312,11 @@ namespace DetourModKit
 
         {
             std::lock_guard<std::mutex> lock(m_async_mutex);
+            m_adaptive_armed.store(false, std::memory_order_release);
             if (m_async_mode_enabled.load(std::memory_order_acquire))
             {
+                m_defer_formatting.store(false, std::memory_order_release);
+                m_rate_limit_sites.store(false, std::memory_order_release);
                 local_logger = m_async_logger.exchange(nullptr, std::memory_order_acq_rel);
                 m_async_mode_enabled.store(false, std::memory_order_release);
                 if (local_logger)
@@ -316,32 +368,82 @@ namespace DetourModKit
 
     void Logger::set_log_level(LogLevel level)
     {
-        auto level_int = static_cast<std::underlying_type_t<LogLevel>>(level);
-        if (level_int < 0 || level_int > static_cast<std::underlying_type_t<LogLevel>>(LogLevel::Error))
+        if (!valid_log_level(level))
         {
             log(LogLevel::Warning, "Attempted to set an invalid log level value ({}). Keeping current level.",
-                level_int);
+                static_cast<std::underlying_type_t<LogLevel>>(level));
             return;
         }
 
-        auto old_level = m_current_log_level.load(std::memory_order_acquire);
-        if (old_level == level)
+        LogLevel old_level;
+        {
+            std::lock_guard<std::mutex> lock(m_level_mutex);
+            old_level = m_current_log_level.load(std::memory_order_acquire);
+            if (old_level == level)
+            {
+                return;
+            }
+            m_current_log_level.store(level, std::memory_order_release);
+            for (std::size_t i = 0; i < LOG_CATEGORY_COUNT; ++i)
+            {
+                if ((m_pinned_categories & category_bit(static_cast<LogCategory>(i))) == 0)
+                {
+                    m_category_levels[i].store(level, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        log(LogLevel::Info, "Log level changed from {} to {}", to_string(old_level), to_string(level));
+    }
+
+    void Logger::set_log_level(LogCategory category, LogLevel level)
+    {
+        if (category >= LogCategory::Count || !valid_log_level(level))
         {
+            log(LogLevel::Warning,
+                "Attempted to set an invalid level ({}) for log category {}. Keeping current level.",
+                static_cast<std::underlying_type_t<LogLevel>>(level), static_cast<unsigned>(category));
             return;
         }
 
-        m_current_log_level.store(level, std::memory_order_release);
+        LogLevel old_level;
+        {
+            std::lock_guard<std::mutex> lock(m_level_mutex);
+            std::atomic<LogLevel> &slot = m_category_levels[static_cast<std::size_t>(category)];
+            old_level = slot.load(std::memory_order_relaxed);
+            m_pinned_categories |= category_bit(category);
+            if (old_level == level)
+            {
+                return;
+            }
+            slot.store(level, std::memory_order_relaxed);
+        }
 
-        log(LogLevel::Info, "Log level changed from {} to {}", to_string(old_level), to_string(level));
+        log(LogLevel::Info, "Log level for {} changed from {} to {}", to_string(category), to_string(old_level),
+            to_string(level));
     }
 
-    bool Logger::log(LogLevel level, std::string_view message)
+    void Logger::reset_log_level(LogCategory category)
     {
-        if (level < m_current_log_level.load(std::memory_order_acquire))
+        if (category >= LogCategory::Count)
         {
-            return false;
+            log(LogLevel::Warning, "Attempted to reset an invalid log category ({}).", static_cast<unsigned>(category));
+            return;
         }
 
+        std::lock_guard<std::mutex> lock(m_level_mutex);
+        m_pinned_categories &= ~category_bit(category);
+        m_category_levels[static_cast<std::size_t>(category)].store(
+            m_current_log_level.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+
+    bool Logger::log(LogLevel level, std::string_view message)
+    {
+        return is_enabled(level) && write(level, message);
+    }
+
+    bool Logger::write(LogLevel level, std::string_view message)
+    {
         // Fast path: an atomic<bool> gate (a genuine lock-free read) selects async mode. The atomic<shared_ptr>
         // snapshot that follows is correct and callback-safe but takes a bounded internal STL lock, not a lock-free
         // read (see the m_async_logger member comment in logger.hpp), so it is not described as lock-free here.
@@ -356,13 +458,29 @@ namespace DetourModKit
             }
         }
 
-        const auto level_str = to_string(level);
+        if (m_adaptive_armed.load(std::memory_order_relaxed))
+        {
+            return write_adaptive(level, message);
+        }
+
         std::lock_guard<std::mutex> lock(*m_log_mutex_ptr);
+        return write_to_sink(level, message);
+    }
 
+    bool Logger::write_to_sink(LogLevel level, std::string_view message)
+    {
+        const auto level_str = to_string(level);
+        std::array<char, TIMESTAMP_BUFFER_SIZE> stamp;
+        const std::string_view timestamp = render_timestamp(stamp);
         if (m_log_file_stream_ptr->is_open() && m_log_file_stream_ptr->good())
         {
-            *m_log_file_stream_ptr << "[" << get_timestamp() << "] "
-                                   << "[" << std::setw(7) << std::left << level_str << "] :: " << message << '\n';
+            m_sink_line.clear();
+            std::format_to(std::back_inserter(m_sink_line), "[{}] [{:<7}] :: {}\n", timestamp, level_str, message);
+            m_log_file_stream_ptr->write(m_sink_line.data(), static_cast<std::streamsize>(m_sink_line.size()));
+            if (m_sink_line.capacity() > SINK_LINE_RETAIN)
+            {
+                std::string().swap(m_sink_line);
+            }
 
             // Flush on warnings/errors to ensure critical messages survive crashes
             if (level >= LogLevel::Warning)
@@ -377,7 +495,7 @@ namespace DetourModKit
 
         if (level >= LogLevel::Error)
         {
-            std::cerr << "[" << m_log_prefix << " LOG_FILE_WRITE_ERROR] [" << get_timestamp() << "] [" << std::setw(7)
+            std::cerr << "[" << m_log_prefix << " LOG_FILE_WRITE_ERROR] [" << timestamp << "] [" << std::setw(7)
                       << std::left << level_str << "] :: " << message << '\n';
         }
 
@@ -386,14 +504,138 @@ namespace DetourModKit
         return false;
     }
 
+    bool Logger::write_adaptive(LogLevel level, std::string_view message)
+    {
+        using clock = std::chrono::steady_clock;
+        const auto to_ns = [](clock::duration d)
+        { return static_cast<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()); };
+
+        // An uncontended lock costs no clock read; only a line that actually had to wait measures the wait.
+        std::unique_lock<std::mutex> lock(*m_log_mutex_ptr, std::try_to_lock);
+        std::int64_t waited_ns = -1;
+        if (!lock.owns_lock())
+        {
+            const auto wait_start = clock::now();
+            lock.lock();
+            waited_ns = to_ns(clock::now() - wait_start);
+        }
+
+        const auto write_start = clock::now();
+        const bool delivered = write_to_sink(level, message);
+        const std::int64_t wrote_ns = to_ns(clock::now() - write_start);
+        lock.unlock();
+
+        // Promote only after the sink lock is released: enable_async_mode() takes m_async_mutex, which orders before
+        // the sink lock, and logs its own line through this logger.
+        if (waited_ns >= 0 && waited_ns >= m_promotion_lock_wait_ns.load(std::memory_order_relaxed))
+        {
+            promote_adaptive("sink lock wait", waited_ns);
+        }
+        else if (wrote_ns >= m_promotion_write_ns.load(std::memory_order_relaxed))
+        {
+            promote_adaptive("sink write latency", wrote_ns);
+        }
+        return delivered;
+    }
+
+    void Logger::promote_adaptive(std::string_view what, std::int64_t elapsed_ns) noexcept
+    {
+        // Every thread that crossed a threshold lands here; the exchange lets exactly one of them switch.
+        if (!m_adaptive_armed.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        // Starting the writer thread under the loader lock is what DllMain must not do; stay synchronous and let a
+        // later line off the loader lock promote instead.
+        if (detail::is_loader_lock_held())
+        {
+            m_adaptive_armed.store(true, std::memory_order_release);
+            return;
+        }
+
+        try
+        {
+            AsyncLoggerConfig config;
+            {
+                std::lock_guard<std::mutex> lock(m_async_mutex);
+                config = m_adaptive_async_config;
+            }
+            enable_async_mode(config);
+            if (m_async_mode_enabled.load(std::memory_order_acquire))
+            {
+                log(LogLevel::Info, "Adaptive logging promoted to async mode: {} of {} us.", what, elapsed_ns / 1000);
+            }
+        }
+        catch (...)
+        {
+            // enable_async_mode() reports its own failures; a throw here can only come from copying the config or from
+            // the follow-up line, and the switch must not take the caller's log call down with it.
+        }
+    }
+
     bool Logger::log_noexcept(LogLevel level, std::string_view message) noexcept
     {
-        // The synchronous sink allocates (timestamp formatting) and a custom stream could raise, so the throwing log()
-        // is wrapped here to keep the no-throw contract for noexcept-boundary callers. The returned bool is log()'s
-        // real delivery status, not merely "did not throw".
+        return is_enabled(level) && write_noexcept(level, message);
+    }
+
+    bool Logger::write_noexcept(LogLevel level, std::string_view message) noexcept
+    {
+        // The synchronous sink allocates (timestamp formatting) and a custom stream could raise, so the throwing
+        // write() is wrapped here to keep the no-throw contract for noexcept-boundary callers. The returned bool is
+        // write()'s real delivery status, not merely "did not throw".
+        try
+        {
+            return write(level, message);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool Logger::submit_deferred(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        if (m_async_mode_enabled.load(std::memory_order_acquire))
+        {
+            if (auto local_logger = m_async_logger.load(std::memory_order_acquire))
+            {
+                return local_logger->enqueue_deferred(level, record);
+            }
+        }
+
+        // Async mode was disabled between the caller's m_defer_formatting check and here, so nothing will render the
+        // record later: render it on this thread and take the synchronous path the eager form would have taken.
+        try
+        {
+            detail::DeferredLogHeader header;
+            std::memcpy(&header, record.data(), sizeof(header));
+            std::string rendered;
+            header.render(rendered, record.data());
+            return write(level, rendered);
+        }
+        catch (...)
+        {
+            return false;
+        }
+    }
+
+    bool Logger::submit_structured(LogLevel level, std::span<const std::byte> record) noexcept
+    {
+        if (m_async_mode_enabled.load(std::memory_order_acquire))
+        {
+            if (auto local_logger = m_async_logger.load(std::memory_order_acquire))
+            {
+                return local_logger->enqueue_structured(level, record);
+            }
+        }
+
+        // Synchronous mode has only the text sink: render the record as a line, like a deferred one.
         try
         {
-            return log(level, message);
+            std::string rendered;
+            detail::render_kv_log_record(rendered, record.data());
+            return write(level, rendered);
         }
         catch (...)
         {
@@ -401,7 +643,25 @@ namespace DetourModKit
         }
     }
 
+    bool Logger::admit_call_site(const std::source_location &where) noexcept
+    {
+        if (auto local_logger = m_async_logger.load(std::memory_order_acquire))
+        {
+            // file_name() points at one string literal per translation unit, so the pointer plus the line tells the
+            // call sites apart without hashing the path.
+            const auto file = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(where.file_name()));
+            return local_logger->admit_call_site((file * 0x9E3779B97F4A7C15ULL) ^ where.line());
+        }
+        return true;
+    }
+
     std::string Logger::get_timestamp() const
+    {
+        std::array<char, TIMESTAMP_BUFFER_SIZE> buffer;
+        return std::string(render_timestamp(buffer));
+    }
+
+    std::string_view Logger::render_timestamp(std::array<char, TIMESTAMP_BUFFER_SIZE> &buffer) const
     {
         try
         {
@@ -422,9 +682,9 @@ namespace DetourModKit
                 throw std::runtime_error("localtime_r failed to convert time.");
             }
 #endif
-            // Single stack buffer for timestamp + milliseconds, no heap allocation
-            char buf[134];
-            const size_t len = std::strftime(buf, sizeof(buf) - 5, m_timestamp_format.c_str(), &timeinfo_struct);
+            // The caller's stack buffer holds timestamp + milliseconds, no heap allocation
+            char *const buf = buffer.data();
+            const size_t len = std::strftime(buf, buffer.size() - 5, m_timestamp_format.c_str(), &timeinfo_struct);
             if (len == 0)
             {
                 return "TIMESTAMP_FORMAT_ERROR";
@@ -432,7 +692,7 @@ namespace DetourModKit
 
             const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
             const int ms_len = std::snprintf(buf + len, 5, ".%03d", static_cast<int>(ms.count()));
-            return std::string(buf, len + static_cast<size_t>(ms_len));
+            return std::string_view(buf, len + static_cast<size_t>(ms_len));
         }
         catch (const std::exception &e)
         {
@@ -530,6 +790,8 @@ namespace DetourModKit
                         std::make_shared<AsyncLogger>(effective_config, m_log_file_stream_ptr, m_log_mutex_ptr),
                         std::memory_order_release);
                     m_async_mode_enabled.store(true, std::memory_order_release);
+                    m_defer_formatting.store(config.defer_formatting, std::memory_order_release);
+                    m_rate_limit_sites.store(config.rate_limit_per_second != 0, std::memory_order_release);
                     should_log_success = true;
                     queue_cap = config.queue_capacity;
                     batch_sz = config.batch_size;
@@ -564,12 +826,15 @@ namespace DetourModKit
 
         {
             std::lock_guard<std::mutex> lock(m_async_mutex);
+            m_adaptive_armed.store(false, std::memory_order_release);
 
             if (!m_async_mode_enabled.load(std::memory_order_acquire))
             {
                 return;
             }
 
+            m_defer_formatting.store(false, std::memory_order_release);
+            m_rate_limit_sites.store(false, std::memory_order_release);
             local_async = m_async_logger.exchange(nullptr, std::memory_order_acq_rel);
             if (local_async)
             {
@@ -615,6 +880,45 @@ namespace DetourModKit
         return m_async_mode_enabled.load(std::memory_order_acquire);
     }
 
+    void Logger::enable_adaptive_mode(const AdaptiveLoggingConfig &config)
+    {
+        if (!config.validate())
+        {
+            log(LogLevel::Error, "Cannot enable adaptive logging mode: invalid configuration.");
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_async_mutex);
+
+            // Same gate as enable_async_mode(): an armed logger would otherwise promote itself after teardown began.
+            if (m_shutdown_called.load(std::memory_order_acquire) ||
+                m_async_mode_enabled.load(std::memory_order_acquire))
+            {
+                return;
+            }
+
+            // No line announces the arming: it would go through the armed path and could promote on its own.
+            using std::chrono::nanoseconds;
+            m_adaptive_async_config = config.async;
+            m_promotion_lock_wait_ns.store(std::chrono::duration_cast<nanoseconds>(config.lock_wait).count(),
+                                           std::memory_order_relaxed);
+            m_promotion_write_ns.store(std::chrono::duration_cast<nanoseconds>(config.write_latency).count(),
+                                       std::memory_order_relaxed);
+            m_adaptive_armed.store(true, std::memory_order_release);
+        }
+    }
+
+    void Logger::enable_adaptive_mode()
+    {
+        enable_adaptive_mode(AdaptiveLoggingConfig{});
+    }
+
+    bool Logger::is_adaptive_mode_armed() const noexcept
+    {
+        return m_adaptive_armed.load(std::memory_order_acquire);
+    }
+
     void Logger::flush() noexcept
     {
         if (m_async_mode_enabled.load(std::memory_order_acquire))
@@ -634,6 +938,25 @@ namespace DetourModKit
         }
     }
 
+    void Logger::flush_at_process_exit() noexcept
+    {
+        if (m_async_mode_enabled.load(std::memory_order_acquire))
+        {
+            auto local_logger = m_async_logger.load(std::memory_order_acquire);
+            if (local_logger)
+            {
+                (void)local_logger->drain_at_process_exit();
+                return;
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(*m_log_mutex_ptr, std::try_to_lock);
+        if (lock.owns_lock() && m_log_file_stream_ptr->is_open())
+        {
+            m_log_file_stream_ptr->flush();
+        }
+    }
+
     // NOLINTNEXTLINE(bugprone-exception-escape): OOM constructing the logger deliberately terminates (see below)
     Logger &log() noexcept
     {
@@ -1,30 +1,46 @@
 /**
  * @file manifest.cpp
  * @brief Signature manifest implementation: INI serialization, ladder compilation, and the resolve-time trust gate.
- * @details The INI parser and emitter are confined to this translation unit: manifest.hpp names no INI type, so the
- *          simpleini dependency never reaches a consumer's include path. The file schema is a versioned `[manifest]`
- *          header followed by one `[sig.<label>]` section per contract, with the candidate ladder for the byte-scanned
- *          kinds spilling into ordered `[sig.<label>.rung.<N>]` sub-sections. Uniform rung sub-sections (rather than an
- *          inline first rung) keep the parse unambiguous: a section-level key never has to serve double duty as both an
- *          anchor field and a candidate field, so round-tripping is mechanical and a hand-edit cannot be misread.
+ * @details The INI reader (internal/ini_reader.hpp) and the SimpleIni emitter are confined to this translation unit:
+ *          manifest.hpp names no INI type, so neither reaches a consumer's include path. The file schema is a versioned
+ *          `[manifest]` header followed by one `[sig.<label>]` section per contract, with the candidate ladder for the
+ *          byte-scanned kinds spilling into ordered `[sig.<label>.rung.<N>]` sub-sections. Uniform rung sub-sections
+ *          (rather than an inline first rung) keep the parse unambiguous: a section-level key never has to serve double
+ *          duty as both an anchor field and a candidate field, so round-tripping is mechanical and a hand-edit cannot
+ *          be misread.
  */
 
 #include "DetourModKit/manifest.hpp"
 
+#include "internal/anchor_prescan.hpp"
+#include "internal/fnv1a.hpp"
+#include "internal/ini_reader.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_xref_index.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
 #include "DetourModKit/hook.hpp"
 #include "DetourModKit/logger.hpp"
 
 #include "SimpleIni.h"
 
+#include "fork_join.hpp"
+
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <format>
 #include <fstream>
-#include <iterator>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -471,20 +487,20 @@ namespace DetourModKit::manifest
 
         // Reads one candidate-ladder rung out of its sub-section. Returns nullopt-shaped failure via the Result so a
         // bad field fails the whole parse closed (a partially-trusted ladder is worse than none).
-        [[nodiscard]] Result<CandidateSpec> parse_rung(const CSimpleIniA &ini, const char *section)
+        [[nodiscard]] Result<CandidateSpec> parse_rung(const detail::IniDocument &ini, std::string_view section)
         {
             CandidateSpec spec;
-            if (const char *name = ini.GetValue(section, "name", nullptr))
+            if (const std::optional<std::string_view> name = ini.value(section, "name"))
             {
-                spec.name = name;
+                spec.name = *name;
             }
 
-            const char *mode_raw = ini.GetValue(section, "mode", nullptr);
-            if (mode_raw == nullptr)
+            const std::optional<std::string_view> mode_raw = ini.value(section, "mode");
+            if (!mode_raw)
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
             }
-            const std::optional<scan::Mode> mode = parse_scan_mode(mode_raw);
+            const std::optional<scan::Mode> mode = parse_scan_mode(*mode_raw);
             if (!mode)
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -496,17 +512,17 @@ namespace DetourModKit::manifest
             case scan::Mode::Direct:
             case scan::Mode::RipRelative:
             {
-                if (const char *pattern = ini.GetValue(section, "pattern", nullptr))
+                if (const std::optional<std::string_view> pattern = ini.value(section, "pattern"))
                 {
-                    spec.pattern = pattern;
+                    spec.pattern = *pattern;
                 }
                 else
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
-                if (const char *walk = ini.GetValue(section, "walk_back", nullptr))
+                if (const std::optional<std::string_view> walk = ini.value(section, "walk_back"))
                 {
-                    const std::optional<long long> value = parse_signed(walk);
+                    const std::optional<long long> value = parse_signed(*walk);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -514,9 +530,9 @@ namespace DetourModKit::manifest
                     spec.walk_back = static_cast<std::ptrdiff_t>(*value);
                 }
                 bool has_displacement = false;
-                if (const char *disp = ini.GetValue(section, "displacement_at", nullptr))
+                if (const std::optional<std::string_view> disp = ini.value(section, "displacement_at"))
                 {
-                    const std::optional<long long> value = parse_signed(disp);
+                    const std::optional<long long> value = parse_signed(*disp);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -525,9 +541,9 @@ namespace DetourModKit::manifest
                     has_displacement = true;
                 }
                 bool has_instruction_length = false;
-                if (const char *len = ini.GetValue(section, "instruction_length", nullptr))
+                if (const std::optional<std::string_view> len = ini.value(section, "instruction_length"))
                 {
-                    const std::optional<unsigned long long> value = parse_unsigned(len);
+                    const std::optional<unsigned long long> value = parse_unsigned(*len);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -561,9 +577,9 @@ namespace DetourModKit::manifest
             }
             case scan::Mode::RttiVtable:
             {
-                if (const char *mangled = ini.GetValue(section, "mangled", nullptr))
+                if (const std::optional<std::string_view> mangled = ini.value(section, "mangled"))
                 {
-                    spec.mangled = mangled;
+                    spec.mangled = *mangled;
                 }
                 else
                 {
@@ -573,44 +589,44 @@ namespace DetourModKit::manifest
             }
             case scan::Mode::StringXref:
             {
-                if (const char *text = ini.GetValue(section, "string_text", nullptr))
+                if (const std::optional<std::string_view> text = ini.value(section, "string_text"))
                 {
-                    spec.string_text = text;
+                    spec.string_text = *text;
                 }
                 else
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
-                if (const char *encoding = ini.GetValue(section, "string_encoding", nullptr))
+                if (const std::optional<std::string_view> encoding = ini.value(section, "string_encoding"))
                 {
-                    const std::optional<scan::StringEncoding> value = parse_encoding(encoding);
+                    const std::optional<scan::StringEncoding> value = parse_encoding(*encoding);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     spec.string_encoding = *value;
                 }
-                if (const char *ret = ini.GetValue(section, "string_return", nullptr))
+                if (const std::optional<std::string_view> ret = ini.value(section, "string_return"))
                 {
-                    const std::optional<scan::XrefReturn> value = parse_xref_return(ret);
+                    const std::optional<scan::XrefReturn> value = parse_xref_return(*ret);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     spec.string_return = *value;
                 }
-                if (const char *term = ini.GetValue(section, "string_require_terminator", nullptr))
+                if (const std::optional<std::string_view> term = ini.value(section, "string_require_terminator"))
                 {
-                    const std::optional<bool> value = parse_bool(term);
+                    const std::optional<bool> value = parse_bool(*term);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     spec.string_require_terminator = *value;
                 }
-                if (const char *broad = ini.GetValue(section, "string_broad_match", nullptr))
+                if (const std::optional<std::string_view> broad = ini.value(section, "string_broad_match"))
                 {
-                    const std::optional<bool> value = parse_bool(broad);
+                    const std::optional<bool> value = parse_bool(*broad);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -626,41 +642,54 @@ namespace DetourModKit::manifest
         // Reads one signature's anchor-level fields out of its `[sig.<label>]` section. The candidate ladder is
         // attached by the caller (it lives in sub-sections), so this handles only the fields keyed directly on the
         // section.
-        [[nodiscard]] Result<SignatureRecord> parse_record(const CSimpleIniA &ini, const char *section,
+        [[nodiscard]] Result<SignatureRecord> parse_record(const detail::IniDocument &ini, std::string_view section,
                                                            std::string label)
         {
             SignatureRecord record;
             record.label = std::move(label);
 
-            const char *kind_raw = ini.GetValue(section, "kind", nullptr);
-            if (kind_raw == nullptr)
+            const std::optional<std::string_view> kind_raw = ini.value(section, "kind");
+            if (!kind_raw)
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
             }
-            const std::optional<anchor::AnchorKind> kind = parse_anchor_kind(kind_raw);
+            const std::optional<anchor::AnchorKind> kind = parse_anchor_kind(*kind_raw);
             if (!kind)
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
             }
             record.kind = *kind;
 
-            if (const char *module = ini.GetValue(section, "module", nullptr))
+            if (const std::optional<std::string_view> module = ini.value(section, "module"))
+            {
+                record.module = *module;
+            }
+            if (const std::optional<std::string_view> parent = ini.value(section, "parent"))
+            {
+                record.parent = *parent;
+            }
+            if (const std::optional<std::string_view> window = ini.value(section, "parent_window"))
             {
-                record.module = module;
+                const std::optional<unsigned long long> value = parse_unsigned(*window);
+                if (!value)
+                {
+                    return fail(ErrorCode::MalformedLine, "manifest::parse");
+                }
+                record.parent_window = static_cast<std::uint64_t>(*value);
             }
 
-            if (const char *binding_raw = ini.GetValue(section, "binding", nullptr))
+            if (const std::optional<std::string_view> binding_raw = ini.value(section, "binding"))
             {
-                const std::optional<BindingKind> binding_kind = parse_binding_kind(binding_raw);
+                const std::optional<BindingKind> binding_kind = parse_binding_kind(*binding_raw);
                 if (!binding_kind)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
                 record.binding.kind = *binding_kind;
             }
-            if (const char *offsets = ini.GetValue(section, "offsets", nullptr))
+            if (const std::optional<std::string_view> offsets = ini.value(section, "offsets"))
             {
-                std::string_view rest = offsets;
+                std::string_view rest = *offsets;
                 while (!rest.empty())
                 {
                     const std::size_t comma = rest.find(',');
@@ -681,36 +710,36 @@ namespace DetourModKit::manifest
                     rest.remove_prefix(comma + 1);
                 }
             }
-            if (const char *width = ini.GetValue(section, "value_width", nullptr))
+            if (const std::optional<std::string_view> width = ini.value(section, "value_width"))
             {
-                const std::optional<std::uint8_t> value = parse_u8(width);
+                const std::optional<std::uint8_t> value = parse_u8(*width);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
                 record.binding.value_width = *value;
             }
-            if (const char *reg = ini.GetValue(section, "read_register", nullptr))
+            if (const std::optional<std::string_view> reg = ini.value(section, "read_register"))
             {
-                const std::optional<hook::Gpr> value = parse_gpr(reg);
+                const std::optional<hook::Gpr> value = parse_gpr(*reg);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
                 record.binding.read_register = *value;
             }
-            if (const char *xmm = ini.GetValue(section, "xmm_index", nullptr))
+            if (const std::optional<std::string_view> xmm = ini.value(section, "xmm_index"))
             {
-                const std::optional<std::uint8_t> value = parse_u8(xmm);
+                const std::optional<std::uint8_t> value = parse_u8(*xmm);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
                 record.binding.xmm_index = *value;
             }
-            if (const char *vmt = ini.GetValue(section, "vmt_index", nullptr))
+            if (const std::optional<std::string_view> vmt = ini.value(section, "vmt_index"))
             {
-                const std::optional<unsigned long long> value = parse_unsigned(vmt);
+                const std::optional<unsigned long long> value = parse_unsigned(*vmt);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -718,9 +747,9 @@ namespace DetourModKit::manifest
                 record.binding.vmt_index = static_cast<std::size_t>(*value);
             }
 
-            if (const char *fingerprint = ini.GetValue(section, "fingerprint", nullptr))
+            if (const std::optional<std::string_view> fingerprint = ini.value(section, "fingerprint"))
             {
-                const std::optional<unsigned long long> value = parse_unsigned(fingerprint);
+                const std::optional<unsigned long long> value = parse_unsigned(*fingerprint);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -731,33 +760,33 @@ namespace DetourModKit::manifest
             switch (record.kind)
             {
             case anchor::AnchorKind::VtableIdentity:
-                if (const char *mangled = ini.GetValue(section, "mangled", nullptr))
+                if (const std::optional<std::string_view> mangled = ini.value(section, "mangled"))
                 {
-                    record.mangled = mangled;
+                    record.mangled = *mangled;
                 }
                 break;
             case anchor::AnchorKind::CodeOperand:
-                if (const char *operand_kind = ini.GetValue(section, "operand_kind", nullptr))
+                if (const std::optional<std::string_view> operand_kind = ini.value(section, "operand_kind"))
                 {
-                    const std::optional<scan::OperandKind> value = parse_operand_kind(operand_kind);
+                    const std::optional<scan::OperandKind> value = parse_operand_kind(*operand_kind);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.operand_kind = *value;
                 }
-                if (const char *index = ini.GetValue(section, "operand_index", nullptr))
+                if (const std::optional<std::string_view> index = ini.value(section, "operand_index"))
                 {
-                    const std::optional<std::uint8_t> value = parse_u8(index);
+                    const std::optional<std::uint8_t> value = parse_u8(*index);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.operand_index = *value;
                 }
-                if (const char *width = ini.GetValue(section, "byte_width", nullptr))
+                if (const std::optional<std::string_view> width = ini.value(section, "byte_width"))
                 {
-                    const std::optional<std::uint8_t> value = parse_u8(width);
+                    const std::optional<std::uint8_t> value = parse_u8(*width);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -766,40 +795,40 @@ namespace DetourModKit::manifest
                 }
                 break;
             case anchor::AnchorKind::StringXref:
-                if (const char *text = ini.GetValue(section, "xref_text", nullptr))
+                if (const std::optional<std::string_view> text = ini.value(section, "xref_text"))
                 {
-                    record.xref_text = text;
+                    record.xref_text = *text;
                 }
-                if (const char *encoding = ini.GetValue(section, "xref_encoding", nullptr))
+                if (const std::optional<std::string_view> encoding = ini.value(section, "xref_encoding"))
                 {
-                    const std::optional<scan::StringEncoding> value = parse_encoding(encoding);
+                    const std::optional<scan::StringEncoding> value = parse_encoding(*encoding);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.xref_encoding = *value;
                 }
-                if (const char *ret = ini.GetValue(section, "xref_return", nullptr))
+                if (const std::optional<std::string_view> ret = ini.value(section, "xref_return"))
                 {
-                    const std::optional<scan::XrefReturn> value = parse_xref_return(ret);
+                    const std::optional<scan::XrefReturn> value = parse_xref_return(*ret);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.xref_return = *value;
                 }
-                if (const char *term = ini.GetValue(section, "xref_require_terminator", nullptr))
+                if (const std::optional<std::string_view> term = ini.value(section, "xref_require_terminator"))
                 {
-                    const std::optional<bool> value = parse_bool(term);
+                    const std::optional<bool> value = parse_bool(*term);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.xref_require_terminator = *value;
                 }
-                if (const char *broad = ini.GetValue(section, "xref_broad_match", nullptr))
+                if (const std::optional<std::string_view> broad = ini.value(section, "xref_broad_match"))
                 {
-                    const std::optional<bool> value = parse_bool(broad);
+                    const std::optional<bool> value = parse_bool(*broad);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -813,12 +842,12 @@ namespace DetourModKit::manifest
                 // 0 and overlay a trusted Address{0} over a working in-code default. Require the key: an author who
                 // genuinely means zero writes `manual_value = 0` explicitly (the presence check, not the value, is what
                 // distinguishes a deliberate pin from a forgotten field). Mirrors the RipRelative required-key gate.
-                const char *manual = ini.GetValue(section, "manual_value", nullptr);
-                if (manual == nullptr)
+                const std::optional<std::string_view> manual = ini.value(section, "manual_value");
+                if (!manual)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
                 }
-                const std::optional<long long> value = parse_signed(manual);
+                const std::optional<long long> value = parse_signed(*manual);
                 if (!value)
                 {
                     return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -827,22 +856,31 @@ namespace DetourModKit::manifest
                 break;
             }
             case anchor::AnchorKind::RipGlobal:
-                if (const char *pages = ini.GetValue(section, "pages", nullptr))
+                if (const std::optional<std::string_view> pages = ini.value(section, "pages"))
                 {
-                    const std::optional<scan::Pages> value = parse_pages(pages);
+                    const std::optional<scan::Pages> value = parse_pages(*pages);
                     if (!value)
                     {
                         return fail(ErrorCode::MalformedLine, "manifest::parse");
                     }
                     record.pages = *value;
                 }
+                if (const std::optional<std::string_view> rva = ini.value(section, "last_seen_rva"))
+                {
+                    const std::optional<unsigned long long> value = parse_unsigned(*rva);
+                    if (!value)
+                    {
+                        return fail(ErrorCode::MalformedLine, "manifest::parse");
+                    }
+                    record.last_seen_rva = static_cast<std::uint64_t>(*value);
+                }
                 break;
             case anchor::AnchorKind::ExportName:
                 // The export symbol; the owning module was read into record.module above. An empty/absent export_name
                 // is rejected by compile()'s empty-evidence gate, mirroring StringXref's optional xref_text read here.
-                if (const char *export_name = ini.GetValue(section, "export_name", nullptr))
+                if (const std::optional<std::string_view> export_name = ini.value(section, "export_name"))
                 {
-                    record.export_name = export_name;
+                    record.export_name = *export_name;
                 }
                 break;
             case anchor::AnchorKind::CallArgHome:
@@ -915,7 +953,7 @@ namespace DetourModKit::manifest
         // is rejected at construction (fail closed) rather than serialized into a file parse() would then reject or
         // silently misattribute. Hazards: INI-structural characters (`[` / `]` end the section token; `\r` / `\n` split
         // the header line), an embedded NUL (the C-string API truncates the section name), a trailing space or tab
-        // (SimpleIni strips leading and trailing whitespace from a section name on read, so `[sig.foo ]` reloads as
+        // (the INI reader strips leading and trailing whitespace from a section name, so `[sig.foo ]` reloads as
         // `sig.foo` and silently changes the lookup key), and a label matching the `.rung.<digits>` grammar -- parse()
         // always reads `sig.<parent>.rung.<N>` as a candidate sub-section, so no top-level record can carry such a
         // label. A leading blank is safe (the fixed `sig.` prefix, not the blank, starts the section name) and interior
@@ -1045,6 +1083,12 @@ namespace DetourModKit::manifest
     Signature::Signature(SignatureRecord record, std::vector<scan::Candidate> ladder) noexcept
         : m_record(std::move(record)), m_ladder(std::move(ladder))
     {
+        // anchor_fingerprint covers the "locate" evidence (pattern bytes, mangled name, xref literal). Extend it with
+        // the Binding -- the "read it there" contract (register / offset chain / value width / vtable slot) -- so a
+        // binding-only repair is caught by the drift gate too. The anchor view make_anchor() builds carries no binding,
+        // so without this fold a rcx -> rax register churn or a +0x1C8 -> +0x1D0 offset move would leave the
+        // fingerprint unchanged and slip past the gate unverified.
+        m_fingerprint = fold_binding(anchor::anchor_fingerprint(make_anchor()), m_record.binding);
     }
 
     anchor::Anchor Signature::make_anchor() const noexcept
@@ -1071,6 +1115,7 @@ namespace DetourModKit::manifest
         anchor.export_module = m_record.module;
         anchor.export_name = m_record.export_name;
         anchor.manual_value = m_record.manual_value;
+        anchor.last_seen_rva = m_record.last_seen_rva;
         // Thread the post-resolve validator onto the borrowed view so a compiled (file-loaded or adopted) signature can
         // assert a domain invariant, exactly as an in-code Anchor can. Without these the manifest path could never
         // reach a validator, silently trusting whatever raw address the backend returned.
@@ -1102,7 +1147,8 @@ namespace DetourModKit::manifest
         }
 
         if (value_is_unserializable(record.module) || value_is_unserializable(record.mangled) ||
-            value_is_unserializable(record.xref_text) || value_is_unserializable(record.export_name))
+            value_is_unserializable(record.xref_text) || value_is_unserializable(record.export_name) ||
+            value_is_unserializable(record.parent))
         {
             return fail(ErrorCode::InvalidArg, "manifest::compile");
         }
@@ -1210,6 +1256,7 @@ namespace DetourModKit::manifest
         record.xref_require_terminator = source.xref_require_terminator;
         record.xref_broad_match = source.xref_broad_match;
         record.manual_value = source.manual_value;
+        record.last_seen_rva = source.last_seen_rva;
         // Preserve the source anchor's post-resolve validator across adoption. Dropping it would silently downgrade a
         // validated in-code anchor into an unchecked one once it became a Signature -- a fail-open regression.
         record.validator = source.validator;
@@ -1223,12 +1270,28 @@ namespace DetourModKit::manifest
         return Signature(std::move(record), std::move(ladder));
     }
 
+    Result<Signature> Signature::adopt(const anchor::Anchor &source, std::string_view parent_label)
+    {
+        Result<Signature> adopted = adopt(source);
+        if (adopted)
+        {
+            adopted->m_record.parent = std::string(parent_label);
+            adopted->m_record.parent_window = source.parent_window;
+        }
+        return adopted;
+    }
+
     anchor::ResolvedAnchor Signature::resolve(Region fallback_scope) const
     {
         const Region effective = m_record.module.empty() ? fallback_scope : Region::module_named(m_record.module);
         return anchor::resolve(make_anchor(), effective);
     }
 
+    anchor::ResolvedAnchor Signature::resolve_within(Region window) const
+    {
+        return anchor::resolve(make_anchor(), window);
+    }
+
     Region Signature::scope() const noexcept
     {
         return m_record.module.empty() ? Region::host() : Region::module_named(m_record.module);
@@ -1236,12 +1299,7 @@ namespace DetourModKit::manifest
 
     std::uint64_t Signature::current_fingerprint() const noexcept
     {
-        // anchor_fingerprint covers the "locate" evidence (pattern bytes, mangled name, xref literal). Extend it with
-        // the Binding -- the "read it there" contract (register / offset chain / value width / vtable slot) -- so a
-        // binding-only repair is caught by the drift gate too. The anchor view make_anchor() builds carries no binding,
-        // so without this fold a rcx -> rax register churn or a +0x1C8 -> +0x1D0 offset move would leave the
-        // fingerprint unchanged and slip past the gate unverified.
-        return fold_binding(anchor::anchor_fingerprint(make_anchor()), m_record.binding);
+        return m_fingerprint;
     }
 
     FingerprintState Signature::fingerprint_state() const noexcept
@@ -1281,28 +1339,31 @@ namespace DetourModKit::manifest
 
     Result<Manifest> parse(std::string_view text)
     {
-        CSimpleIniA ini;
-        ini.SetMultiKey(false);
         // Read values as multi-line (heredoc) data so a literal carrying an embedded '\n' / '\r' -- routine in log and
-        // format strings a StringXref anchors on -- is reassembled whole. Without this, SimpleIni ends the value at the
-        // first newline and re-reads the tail as a new key: the literal truncates and an attacker-shaped tail could
-        // even inject a spurious `binding =` key the fingerprint gate cannot see. Serialize enables the same mode, so
-        // the pair round-trips. See the paired SetMultiLine in serialize().
-        ini.SetMultiLine(true);
-        if (ini.LoadData(text.data(), text.size()) < 0)
+        // format strings a StringXref anchors on -- is reassembled whole. Without this, the reader ends the value at
+        // the first newline and re-reads the tail as a new key: the literal truncates and an attacker-shaped tail
+        // could even inject a spurious `binding =` key the fingerprint gate cannot see. Serialize enables the same
+        // mode, so the pair round-trips. See the paired SetMultiLine in serialize(). The document's views point into
+        // @p text, which outlives every use below.
+        detail::IniDocument ini;
+        try
         {
-            return fail(ErrorCode::MalformedLine, "manifest::parse");
+            ini = detail::IniDocument::parse(text, true);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return fail(ErrorCode::OutOfMemory, "manifest::parse");
         }
 
         // The `[manifest]` header both proves this is a manifest (not some unrelated INI) and pins the schema. A
         // missing header or a schema this build does not understand fails closed, so a future format is never misread
         // under the wrong grammar.
-        const char *schema_raw = ini.GetValue("manifest", "schema", nullptr);
-        if (schema_raw == nullptr)
+        const std::optional<std::string_view> schema_raw = ini.value("manifest", "schema");
+        if (!schema_raw)
         {
             return fail(ErrorCode::MissingHeader, "manifest::parse");
         }
-        const std::optional<unsigned long long> schema = parse_unsigned(schema_raw);
+        const std::optional<unsigned long long> schema = parse_unsigned(*schema_raw);
         if (!schema || *schema != static_cast<unsigned long long>(SCHEMA_VERSION))
         {
             return fail(ErrorCode::MissingHeader, "manifest::parse");
@@ -1312,9 +1373,9 @@ namespace DetourModKit::manifest
         // interpret it -- a consumer gates on it through revision_compatible -- but a present value must parse and fit
         // a 32-bit field, else the file is not trustworthy and fails closed.
         std::uint32_t revision = 0;
-        if (const char *revision_raw = ini.GetValue("manifest", "revision", nullptr))
+        if (const std::optional<std::string_view> revision_raw = ini.value("manifest", "revision"))
         {
-            const std::optional<unsigned long long> parsed_revision = parse_unsigned(revision_raw);
+            const std::optional<unsigned long long> parsed_revision = parse_unsigned(*revision_raw);
             if (!parsed_revision || *parsed_revision > 0xFFFFFFFFULL)
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
@@ -1322,14 +1383,12 @@ namespace DetourModKit::manifest
             revision = static_cast<std::uint32_t>(*parsed_revision);
         }
 
-        CSimpleIniA::TNamesDepend sections;
-        ini.GetAllSections(sections);
-        // Emit records in the file's load order, so a round-trip and a hand-diff stay stable.
-        sections.sort(CSimpleIniA::Entry::LoadOrder());
+        // Sections come back in the file's load order, so records are emitted in it and a round-trip and a hand-diff
+        // stay stable.
+        const std::span<const std::string_view> sections = ini.sections();
 
-        for (const CSimpleIniA::Entry &entry : sections)
+        for (const std::string_view name : sections)
         {
-            const std::string_view name = entry.pItem;
             if (!name.starts_with("sig."))
             {
                 continue;
@@ -1341,17 +1400,15 @@ namespace DetourModKit::manifest
                 continue;
             }
 
-            const std::string parent{rung->parent};
-            if (parent.size() <= 4U || ini.GetSection(parent.c_str()) == nullptr)
+            if (rung->parent.size() <= 4U || !ini.has_section(rung->parent))
             {
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
             }
         }
 
         std::vector<SignatureRecord> records;
-        for (const CSimpleIniA::Entry &entry : sections)
+        for (const std::string_view name : sections)
         {
-            const std::string_view name = entry.pItem;
             if (!name.starts_with("sig.") || parse_rung_section_name(name).has_value())
             {
                 continue;
@@ -1363,7 +1420,7 @@ namespace DetourModKit::manifest
                 return fail(ErrorCode::MalformedLine, "manifest::parse");
             }
 
-            Result<SignatureRecord> record = parse_record(ini, entry.pItem, std::string(label));
+            Result<SignatureRecord> record = parse_record(ini, name, std::string(label));
             if (!record)
             {
                 return std::unexpected(record.error());
@@ -1375,12 +1432,12 @@ namespace DetourModKit::manifest
             std::size_t first_missing_rung = 0;
             for (;; ++first_missing_rung)
             {
-                const std::string rung_section = std::format("{}.rung.{}", entry.pItem, first_missing_rung);
-                if (ini.GetValue(rung_section.c_str(), "mode", nullptr) == nullptr)
+                const std::string rung_section = std::format("{}.rung.{}", name, first_missing_rung);
+                if (!ini.value(rung_section, "mode"))
                 {
                     break;
                 }
-                Result<CandidateSpec> rung = parse_rung(ini, rung_section.c_str());
+                Result<CandidateSpec> rung = parse_rung(ini, rung_section);
                 if (!rung)
                 {
                     return std::unexpected(rung.error());
@@ -1388,9 +1445,8 @@ namespace DetourModKit::manifest
                 record->ladder.push_back(std::move(*rung));
             }
 
-            for (const CSimpleIniA::Entry &maybe_rung_entry : sections)
+            for (const std::string_view maybe_rung : sections)
             {
-                const std::string_view maybe_rung = maybe_rung_entry.pItem;
                 const std::optional<RungSectionName> rung = parse_rung_section_name(maybe_rung);
                 if (rung && rung->parent == name && rung->index >= first_missing_rung)
                 {
@@ -1429,6 +1485,14 @@ namespace DetourModKit::manifest
             {
                 ini.SetValue(sec, "module", record.module.c_str());
             }
+            if (!record.parent.empty())
+            {
+                ini.SetValue(sec, "parent", record.parent.c_str());
+            }
+            if (record.parent_window != 0)
+            {
+                ini.SetValue(sec, "parent_window", std::format("0x{:X}", record.parent_window).c_str());
+            }
 
             ini.SetValue(sec, "binding", std::string(binding_kind_to_string(record.binding.kind)).c_str());
             switch (record.binding.kind)
@@ -1493,6 +1557,10 @@ namespace DetourModKit::manifest
                 {
                     ini.SetValue(sec, "pages", std::string(pages_token(record.pages)).c_str());
                 }
+                if (record.last_seen_rva != 0)
+                {
+                    ini.SetValue(sec, "last_seen_rva", std::format("0x{:X}", record.last_seen_rva).c_str());
+                }
                 break;
             case anchor::AnchorKind::ExportName:
                 // The owning module is written above as the shared `module` key; only the export symbol is
@@ -1553,13 +1621,13 @@ namespace DetourModKit::manifest
 
     Result<Manifest> load(const std::filesystem::path &path)
     {
-        std::ifstream in(path, std::ios::binary);
-        if (!in)
+        // Parse straight off a read-only mapping: the values are views into it, copied once into the records.
+        detail::MappedFile file;
+        if (!file.open(path))
         {
             return fail(ErrorCode::FileOpenFailed, "manifest::load");
         }
-        const std::string text{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
-        return parse(text);
+        return parse(file.text());
     }
 
     Result<void> save(const std::filesystem::path &path, const Manifest &manifest)
@@ -1620,7 +1688,9 @@ namespace DetourModKit::manifest
                               def.label, compiled.error().message());
             }
 
-            Result<Signature> adopted = Signature::adopt(def);
+            const std::string_view parent_label =
+                (def.parent < defaults.size()) ? defaults[def.parent].label : std::string_view{};
+            Result<Signature> adopted = Signature::adopt(def, parent_label);
             if (adopted)
             {
                 merged.push_back(std::move(*adopted));
@@ -1648,92 +1718,804 @@ namespace DetourModKit::manifest
         return nullptr;
     }
 
-    GateResult resolve_and_gate(std::span<const Signature> signatures, const GatePolicy &policy, Region scope)
+    namespace
     {
-        GateResult result;
+        constexpr std::size_t NO_REQUEST = static_cast<std::size_t>(-1);
+
+        // Everything a record's gate outcome depends on, for IncrementalGate's unchanged-record match. Unlike the drift
+        // fingerprint it covers the raw text (the ladder source, not its compile), the scope and parent keys, the
+        // captured baseline, and the in-memory validator hook, so any edit that could change the outcome changes it.
+        [[nodiscard]] std::uint64_t record_content_hash(const SignatureRecord &record) noexcept
+        {
+            namespace fnv = DetourModKit::detail;
+            std::uint64_t hash = fnv::fnv1a_field(fnv::FNV1A64_OFFSET, record.label);
+            hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(record.kind));
+            hash = fnv::fnv1a_field(hash, record.module);
+            hash = fnv::fnv1a_int(hash, static_cast<std::uint64_t>(record.ladder.size()));
+            for (const CandidateSpec &spec : record.ladder)
+            {
+                hash = fnv::fnv1a_field(hash, spec.name);
+                hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(spec.mode));
+                hash = fnv::fnv1a_field(hash, spec.pattern);
+                hash = fnv::fnv1a_int(hash, static_cast<std::int64_t>(spec.walk_back));
+                hash = fnv::fnv1a_int(hash, static_cast<std::int64_t>(spec.displacement_at));
+                hash = fnv::fnv1a_int(hash, static_cast<std::uint64_t>(spec.instruction_length));
+                hash = fnv::fnv1a_field(hash, spec.mangled);
+                hash = fnv::fnv1a_field(hash, spec.string_text);
+                hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(spec.string_encoding));
+                hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(spec.string_return));
+                hash = fnv::fnv1a_byte(hash, spec.string_require_terminator ? 1U : 0U);
+                hash = fnv::fnv1a_byte(hash, spec.string_broad_match ? 1U : 0U);
+            }
+            hash = fnv::fnv1a_field(hash, record.mangled);
+            hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(record.operand_kind));
+            hash = fnv::fnv1a_byte(hash, record.operand_index);
+            hash = fnv::fnv1a_byte(hash, record.byte_width);
+            hash = fnv::fnv1a_field(hash, record.xref_text);
+            hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(record.xref_encoding));
+            hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(record.xref_return));
+            hash = fnv::fnv1a_byte(hash, record.xref_require_terminator ? 1U : 0U);
+            hash = fnv::fnv1a_byte(hash, record.xref_broad_match ? 1U : 0U);
+            hash = fnv::fnv1a_int(hash, record.manual_value);
+            hash = fnv::fnv1a_int(hash, reinterpret_cast<std::uintptr_t>(record.validator));
+            hash = fnv::fnv1a_int(hash, reinterpret_cast<std::uintptr_t>(record.validator_context));
+            hash = fnv::fnv1a_byte(hash, record.validate_manual ? 1U : 0U);
+            hash = fnv::fnv1a_byte(hash, record.require_validator ? 1U : 0U);
+            hash = fold_binding(hash, record.binding);
+            hash = fnv::fnv1a_int(hash, record.expected_fingerprint);
+            hash = fnv::fnv1a_byte(hash, static_cast<std::uint8_t>(record.pages));
+            hash = fnv::fnv1a_field(hash, record.export_name);
+            hash = fnv::fnv1a_int(hash, record.last_seen_rva);
+            hash = fnv::fnv1a_field(hash, record.parent);
+            return fnv::fnv1a_int(hash, record.parent_window);
+        }
+
+        // Parent labels become graph edges. A label that names no signature (or the child itself) maps past the end,
+        // so that child is never reached and keeps its fail-closed seed.
+        [[nodiscard]] std::vector<std::size_t> parent_indices(std::span<const Signature> signatures)
+        {
+            std::vector<std::size_t> parents(signatures.size(), DetourModKit::detail::FORK_JOIN_NO_PARENT);
+            for (std::size_t index = 0; index < signatures.size(); ++index)
+            {
+                const std::string &parent_label = signatures[index].record().parent;
+                if (parent_label.empty())
+                {
+                    continue;
+                }
+                parents[index] = signatures.size();
+                for (std::size_t candidate = 0; candidate < signatures.size(); ++candidate)
+                {
+                    if (candidate != index && signatures[candidate].label() == parent_label)
+                    {
+                        parents[index] = candidate;
+                        break;
+                    }
+                }
+            }
+            return parents;
+        }
 
-        // Resolve every signature first, then summarize: assess_quality needs the whole report, and a signature's
-        // fingerprint verdict is independent of the resolve outcome.
-        std::vector<anchor::ResolvedAnchor> report;
-        report.reserve(signatures.size());
-        for (const Signature &signature : signatures)
+        // Resolves a child inside its parent's resolved window; a parent that did not resolve fails the child closed.
+        [[nodiscard]] anchor::ResolvedAnchor resolve_in_parent(const Signature &signature, const anchor::Anchor &view,
+                                                               const anchor::ResolvedAnchor &parent)
         {
-            report.push_back(signature.resolve(scope));
+            if (parent.status != anchor::AnchorStatus::Resolved || parent.value == 0)
+            {
+                return anchor::ResolvedAnchor{signature.label(), signature.kind(), anchor::AnchorStatus::Failed, 0};
+            }
+            const std::uint64_t window = signature.record().parent_window;
+            const auto size = static_cast<std::size_t>(window != 0 ? window : anchor::DEFAULT_PARENT_WINDOW);
+            return anchor::resolve(view, Region{Address{static_cast<std::uintptr_t>(parent.value)}, size});
         }
-        result.quality = anchor::assess_quality(report);
 
-        // The fingerprint state of each provisionally-trusted signature, kept parallel to result.trusted so a
-        // whole-manifest floor demotion below can report the true drift state rather than guessing it.
-        std::vector<FingerprintState> trusted_fingerprints;
-        trusted_fingerprints.reserve(signatures.size());
-
-        for (std::size_t index = 0; index < signatures.size(); ++index)
+        // The per-signature half of the gate; the whole-manifest floor is the caller's.
+        [[nodiscard]] bool passes_gate(const anchor::ResolvedAnchor &resolved, FingerprintState fingerprint,
+                                       const GatePolicy &policy) noexcept
         {
-            const Signature &signature = signatures[index];
-            const anchor::ResolvedAnchor &resolved = report[index];
-            const FingerprintState fingerprint = signature.fingerprint_state();
-
             // A non-unique or missed locate is never trusted: acting on an un-resolved address is the corruption this
             // gate exists to prevent.
             if (resolved.status != anchor::AnchorStatus::Resolved)
             {
-                result.rejected.push_back(RejectedSignature{
-                    .label = signature.label(), .status = resolved.status, .fingerprint = fingerprint});
-                continue;
+                return false;
             }
             // A drifted fingerprint means the signature's declared definition was edited without re-capturing the
             // baseline, so the edited binding is unverified and must not be trusted even though something resolved at
             // that address.
             if (policy.reject_on_fingerprint_drift && fingerprint == FingerprintState::Drifted)
             {
-                result.rejected.push_back(RejectedSignature{.label = signature.label(),
-                                                            .status = anchor::AnchorStatus::Resolved,
-                                                            .fingerprint = FingerprintState::Drifted});
-                continue;
+                return false;
+            }
+            return !(policy.reject_unset_fingerprint && fingerprint == FingerprintState::Unset);
+        }
+
+        // GatePolicy::min_resolved_fraction clamped to [0, 1]; a negative or NaN floor folds to "no floor", matching
+        // the anchor gate's strict-default handling of a nonsensical threshold.
+        [[nodiscard]] double health_floor(const GatePolicy &policy) noexcept
+        {
+            const double floor = policy.min_resolved_fraction;
+            if (!(floor >= 0.0))
+            {
+                return 0.0;
             }
-            if (policy.reject_unset_fingerprint && fingerprint == FingerprintState::Unset)
+            return floor > 1.0 ? 1.0 : floor;
+        }
+
+        // GatePolicy::fail_fast for one batch: once more signatures are rejected than the health floor tolerates, the
+        // floor will reject the whole manifest anyway, so the rest of the batch is cancelled. Called from the workers.
+        class GateFailFast
+        {
+        public:
+            GateFailFast(std::span<const Signature> signatures, const GatePolicy &policy,
+                         DetourModKit::detail::BatchCancel &cancel) noexcept
+                : m_signatures(signatures), m_policy(policy), m_floor(health_floor(policy)), m_cancel(cancel)
             {
-                result.rejected.push_back(RejectedSignature{.label = signature.label(),
-                                                            .status = anchor::AnchorStatus::Resolved,
-                                                            .fingerprint = FingerprintState::Unset});
-                continue;
             }
 
-            result.trusted.push_back(GatedSignature{.label = signature.label(),
-                                                    .kind = signature.kind(),
-                                                    .address = Address{static_cast<std::uintptr_t>(resolved.value)},
-                                                    .binding = &signature.binding()});
-            trusted_fingerprints.push_back(fingerprint);
+            void record(std::size_t index, const anchor::ResolvedAnchor &resolved) noexcept
+            {
+                if (passes_gate(resolved, m_signatures[index].fingerprint_state(), m_policy))
+                {
+                    return;
+                }
+                const std::size_t rejected = m_rejected.fetch_add(1, std::memory_order_relaxed) + 1;
+                const std::size_t total = m_signatures.size();
+                // The same comparison gate_report makes, on the best case left: every signature not yet rejected.
+                if (static_cast<double>(total - rejected) / static_cast<double>(total) < m_floor)
+                {
+                    m_cancel.cancel();
+                }
+            }
+
+        private:
+            std::span<const Signature> m_signatures;
+            const GatePolicy &m_policy;
+            double m_floor;
+            DetourModKit::detail::BatchCancel &m_cancel;
+            std::atomic<std::size_t> m_rejected{0};
+        };
+
+        // Resolves every signature on the graph its parent labels form; anchors[i] is signatures[i]'s anchor view. A
+        // signature with a @p kept entry returns that result without resolving (@p kept is empty, or aligned with
+        // @p signatures), and only the signatures that do resolve feed the shared page snapshots and prescans. A
+        // non-null @p fail_fast sees every fresh outcome as it lands.
+        [[nodiscard]] std::vector<anchor::ResolvedAnchor>
+        resolve_report(std::span<const Signature> signatures, std::span<const anchor::Anchor> anchors,
+                       std::span<const std::optional<anchor::ResolvedAnchor>> kept, std::size_t max_workers,
+                       Region scope, GateFailFast *fail_fast = nullptr)
+        {
+            const auto resolves = [kept](std::size_t index) noexcept { return kept.empty() || !kept[index]; };
+            const auto effective_scope = [scope](const Signature &signature) noexcept
+            { return signature.record().module.empty() ? scope : signature.scope(); };
+            std::size_t resolving = 0;
+            for (std::size_t index = 0; index < signatures.size(); ++index)
+            {
+                resolving += resolves(index) ? 1 : 0;
+            }
+
+            // Every signature walks the page map of its scope -- almost always the same image -- so the map is
+            // captured once per distinct scope and replayed by each resolve. A capture that cannot allocate only costs
+            // the replay.
+            std::vector<DetourModKit::detail::PageSnapshot> snapshots;
+            if (resolving > 1)
+            {
+                try
+                {
+                    for (std::size_t index = 0; index < signatures.size(); ++index)
+                    {
+                        if (resolves(index))
+                        {
+                            DetourModKit::detail::add_page_snapshot(
+                                snapshots, DetourModKit::detail::module_span(effective_scope(signatures[index])));
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    snapshots.clear();
+                }
+            }
+            const DetourModKit::detail::ScopedPageSnapshots install(snapshots);
+            // Likewise every string_xref signature in the scope shares one reference index instead of decoding the
+            // code section again per signature.
+            DetourModKit::detail::XrefIndexCache xref_index;
+            try
+            {
+                std::vector<DetourModKit::detail::StringLiteralQuery> literals;
+                for (std::size_t index = 0; index < signatures.size(); ++index)
+                {
+                    const SignatureRecord &record = signatures[index].record();
+                    if (record.kind != anchor::AnchorKind::StringXref || !resolves(index))
+                    {
+                        continue;
+                    }
+                    literals.push_back(DetourModKit::detail::StringLiteralQuery{
+                        .query = scan::StringRefQuery{.text = record.xref_text,
+                                                      .encoding = record.xref_encoding,
+                                                      .require_terminator = record.xref_require_terminator},
+                        .range = DetourModKit::detail::module_span(effective_scope(signatures[index])),
+                    });
+                }
+                if (literals.size() >= DetourModKit::detail::STRING_PRESCAN_MIN_LITERALS)
+                {
+                    DetourModKit::detail::prescan_string_literals(xref_index, literals);
+                }
+            }
+            catch (...)
+            {
+                // Without the prescan each signature locates its own literal.
+            }
+            const DetourModKit::detail::ScopedXrefIndexCache install_index(&xref_index);
+
+            // Every root RipGlobal and CodeOperand signature's byte rungs are swept together, one pass per image and
+            // page class (see detail::prescan_ladders), instead of each resolve walking the image twice per rung.
+            // Purely an accelerator: a batch too small to benefit, or a prescan that cannot allocate, resolves every
+            // signature on its own exactly as before.
+            std::vector<std::size_t> request_of;
+            DetourModKit::detail::LadderPrescan prescan;
+            try
+            {
+                const auto prescannable = [&](std::size_t index) noexcept
+                {
+                    const anchor::AnchorKind kind = anchors[index].kind;
+                    return resolves(index) &&
+                           (kind == anchor::AnchorKind::RipGlobal || kind == anchor::AnchorKind::CodeOperand) &&
+                           signatures[index].record().parent.empty();
+                };
+                std::size_t candidate_total = 0;
+                for (std::size_t index = 0; index < signatures.size(); ++index)
+                {
+                    candidate_total += prescannable(index) ? anchors[index].site.size() : 0;
+                }
+                if (candidate_total >= DetourModKit::detail::MULTI_SCAN_MIN_PATTERNS)
+                {
+                    std::vector<scan::ScanRequest> requests;
+                    request_of.assign(signatures.size(), NO_REQUEST);
+                    for (std::size_t index = 0; index < signatures.size(); ++index)
+                    {
+                        if (prescannable(index))
+                        {
+                            request_of[index] = requests.size();
+                            requests.push_back(DetourModKit::detail::anchor_cascade_request(
+                                anchors[index], effective_scope(signatures[index])));
+                        }
+                    }
+                    prescan = DetourModKit::detail::prescan_ladders(requests);
+                }
+            }
+            catch (...)
+            {
+                request_of.clear();
+                prescan = DetourModKit::detail::LadderPrescan{};
+            }
+
+            const std::vector<std::size_t> parents = parent_indices(signatures);
+            const Signature *first_signature = signatures.data();
+            // Workers are other threads, so hand them the caller's installed page snapshots and reference index.
+            return DetourModKit::detail::run_fork_join_graph<Signature, anchor::ResolvedAnchor>(
+                signatures, parents, max_workers,
+                [&](const Signature &signature, const anchor::ResolvedAnchor *parent) -> anchor::ResolvedAnchor
+                {
+                    const auto index = static_cast<std::size_t>(&signature - first_signature);
+                    if (!resolves(index))
+                    {
+                        return *kept[index];
+                    }
+                    const DetourModKit::detail::ScopedPageSnapshots install_pages(snapshots);
+                    const DetourModKit::detail::ScopedXrefIndexCache install_xrefs(&xref_index);
+                    anchor::ResolvedAnchor resolved;
+                    if (parent != nullptr)
+                    {
+                        resolved = resolve_in_parent(signature, anchors[index], *parent);
+                    }
+                    else if (index < request_of.size() && request_of[index] != NO_REQUEST)
+                    {
+                        resolved = DetourModKit::detail::resolve_anchor_prescanned(
+                            anchors[index], effective_scope(signature), prescan, request_of[index]);
+                    }
+                    else
+                    {
+                        resolved = anchor::resolve(anchors[index], effective_scope(signature));
+                    }
+                    if (fail_fast != nullptr)
+                    {
+                        fail_fast->record(index, resolved);
+                    }
+                    return resolved;
+                },
+                [](const Signature &signature) noexcept -> anchor::ResolvedAnchor
+                {
+                    return anchor::ResolvedAnchor{signature.label(), signature.kind(), anchor::AnchorStatus::Failed,
+                                                  0};
+                });
         }
 
-        // Whole-manifest health floor: if too small a fraction of the manifest is trustworthy, none of it is. The guard
-        // `!(floor >= 0)` folds a negative or NaN floor to "no floor", matching the anchor gate's strict-default
-        // handling of a nonsensical threshold.
-        double floor = policy.min_resolved_fraction;
-        if (!(floor >= 0.0))
+        // A trusted signature's entry; its label and binding borrow from @p signature.
+        [[nodiscard]] GatedSignature gated_entry(const Signature &signature,
+                                                 const anchor::ResolvedAnchor &resolved) noexcept
         {
-            floor = 0.0;
+            return GatedSignature{.label = signature.label(),
+                                  .kind = signature.kind(),
+                                  .address = Address{static_cast<std::uintptr_t>(resolved.value)},
+                                  .binding = &signature.binding(),
+                                  .source = resolved.source};
         }
-        if (floor > 1.0)
+
+        // Partitions a resolved manifest into trusted and safe-disabled against @p policy; report[i] is signatures[i]'s
+        // outcome.
+        [[nodiscard]] GateResult gate_report(std::span<const Signature> signatures,
+                                             std::span<const anchor::ResolvedAnchor> report, const GatePolicy &policy)
         {
-            floor = 1.0;
+            GateResult result;
+            result.quality = anchor::assess_quality(report);
+
+            // The fingerprint state of each provisionally-trusted signature, kept parallel to result.trusted so a
+            // whole-manifest floor demotion below can report the true drift state rather than guessing it.
+            std::vector<FingerprintState> trusted_fingerprints;
+            trusted_fingerprints.reserve(signatures.size());
+
+            for (std::size_t index = 0; index < signatures.size(); ++index)
+            {
+                const Signature &signature = signatures[index];
+                const anchor::ResolvedAnchor &resolved = report[index];
+                const FingerprintState fingerprint = signature.fingerprint_state();
+                if (!passes_gate(resolved, fingerprint, policy))
+                {
+                    result.rejected.push_back(RejectedSignature{
+                        .label = signature.label(), .status = resolved.status, .fingerprint = fingerprint});
+                    continue;
+                }
+                result.trusted.push_back(gated_entry(signature, resolved));
+                trusted_fingerprints.push_back(fingerprint);
+            }
+
+            // Whole-manifest health floor: if too small a fraction of the manifest is trustworthy, none of it is.
+            const double floor = health_floor(policy);
+            if (!signatures.empty() && floor > 0.0)
+            {
+                const double fraction =
+                    static_cast<double>(result.trusted.size()) / static_cast<double>(signatures.size());
+                if (fraction < floor)
+                {
+                    for (std::size_t index = 0; index < result.trusted.size(); ++index)
+                    {
+                        result.rejected.push_back(RejectedSignature{.label = result.trusted[index].label,
+                                                                    .status = anchor::AnchorStatus::Resolved,
+                                                                    .fingerprint = trusted_fingerprints[index]});
+                    }
+                    result.trusted.clear();
+                }
+            }
+
+            return result;
         }
-        if (!signatures.empty() && floor > 0.0)
+    } // namespace
+
+    GateResult resolve_and_gate(std::span<const Signature> signatures, const GatePolicy &policy, Region scope,
+                                std::stop_token stop)
+    {
+        // Resolve every signature first, then summarize: assess_quality needs the whole report, and a signature's
+        // fingerprint verdict is independent of the resolve outcome.
+        std::vector<anchor::Anchor> anchors;
+        anchors.reserve(signatures.size());
+        for (const Signature &signature : signatures)
+        {
+            anchors.push_back(signature.make_anchor());
+        }
+        DetourModKit::detail::BatchCancel cancel(std::move(stop));
+        const DetourModKit::detail::ScopedBatchCancel install(&cancel);
+        std::optional<GateFailFast> fail_fast;
+        if (policy.fail_fast && !signatures.empty() && health_floor(policy) > 0.0)
+        {
+            fail_fast.emplace(signatures, policy, cancel);
+        }
+        const std::vector<anchor::ResolvedAnchor> report =
+            resolve_report(signatures, anchors, {}, policy.max_workers, scope, fail_fast ? &*fail_fast : nullptr);
+        return gate_report(signatures, report, policy);
+    }
+
+    IncrementalGate::IncrementalGate(const GatePolicy &policy, Region scope) noexcept : m_policy(policy), m_scope(scope)
+    {
+    }
+
+    Result<std::size_t> IncrementalGate::apply(const Manifest &manifest)
+    {
+        const std::span<const SignatureRecord> records = manifest.records;
+        std::vector<std::uint64_t> hashes;
+        std::vector<std::size_t> reuse(records.size(), NO_REQUEST);
+        std::vector<std::optional<Signature>> fresh(records.size());
+        try
+        {
+            // Pair each record with an unchanged predecessor: the same hash and label, each predecessor used once.
+            std::vector<std::pair<std::uint64_t, std::size_t>> previous;
+            previous.reserve(m_hashes.size());
+            for (std::size_t index = 0; index < m_hashes.size(); ++index)
+            {
+                previous.emplace_back(m_hashes[index], index);
+            }
+            std::ranges::sort(previous);
+            std::vector<std::uint8_t> taken(m_signatures.size(), 0);
+            hashes.reserve(records.size());
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                hashes.push_back(record_content_hash(records[index]));
+                for (auto it = std::ranges::lower_bound(previous, std::pair{hashes.back(), std::size_t{0}});
+                     it != previous.end() && it->first == hashes.back(); ++it)
+                {
+                    if (taken[it->second] == 0 && m_signatures[it->second].label() == records[index].label)
+                    {
+                        taken[it->second] = 1;
+                        reuse[index] = it->second;
+                        break;
+                    }
+                }
+            }
+            // Compile every new or edited record before touching the current state, so a bad edit keeps the last
+            // good gate.
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                if (reuse[index] != NO_REQUEST)
+                {
+                    continue;
+                }
+                Result<Signature> compiled = Signature::compile(records[index]);
+                if (!compiled)
+                {
+                    Error error = compiled.error();
+                    error.detail = index;
+                    return std::unexpected(error);
+                }
+                fresh[index].emplace(std::move(*compiled));
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "manifest::IncrementalGate::apply"});
+        }
+
+        try
+        {
+            std::vector<Signature> signatures;
+            signatures.reserve(records.size());
+            std::vector<anchor::Anchor> anchors;
+            anchors.reserve(records.size());
+            std::vector<std::optional<anchor::ResolvedAnchor>> kept(records.size());
+            const std::vector<std::size_t> old_parents = parent_indices(m_signatures);
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                if (reuse[index] != NO_REQUEST && !m_stale)
+                {
+                    kept[index] = m_report[reuse[index]];
+                }
+            }
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                signatures.push_back(reuse[index] != NO_REQUEST ? std::move(m_signatures[reuse[index]])
+                                                                : std::move(*fresh[index]));
+            }
+            const std::vector<std::size_t> parents = parent_indices(signatures);
+
+            // A kept resolve is invalid once its parent resolves again or its parent label names another record.
+            // Parents may follow their children, so sweep until nothing more drops.
+            const auto same_parent = [&](std::size_t index) noexcept
+            {
+                const std::size_t now = parents[index];
+                const std::size_t before = old_parents[reuse[index]];
+                if (now == DetourModKit::detail::FORK_JOIN_NO_PARENT || now == signatures.size())
+                {
+                    return before == now || (now == signatures.size() && before == m_signatures.size());
+                }
+                return reuse[now] == before;
+            };
+            for (bool dropped = true; dropped;)
+            {
+                dropped = false;
+                for (std::size_t index = 0; index < records.size(); ++index)
+                {
+                    if (!kept[index])
+                    {
+                        continue;
+                    }
+                    const std::size_t parent = parents[index];
+                    const bool parent_resolves = parent < signatures.size() && !kept[parent];
+                    if (parent_resolves || !same_parent(index))
+                    {
+                        kept[index].reset();
+                        dropped = true;
+                    }
+                }
+            }
+
+            std::size_t resolving = 0;
+            for (std::size_t index = 0; index < records.size(); ++index)
+            {
+                anchors.push_back(signatures[index].make_anchor());
+                if (kept[index])
+                {
+                    // The label view aimed at the predecessor's string, which moved with its signature.
+                    kept[index]->label = signatures[index].label();
+                }
+                else
+                {
+                    ++resolving;
+                }
+            }
+
+            std::vector<anchor::ResolvedAnchor> report =
+                resolve_report(signatures, anchors, kept, m_policy.max_workers, m_scope);
+            GateResult result = gate_report(signatures, report, m_policy);
+            m_signatures = std::move(signatures);
+            m_hashes = std::move(hashes);
+            m_report = std::move(report);
+            m_result = std::move(result);
+            m_stale = false;
+            return resolving;
+        }
+        catch (const std::bad_alloc &)
+        {
+            // The predecessors may already have moved out, so nothing consistent is left to keep.
+            m_signatures.clear();
+            m_hashes.clear();
+            m_report.clear();
+            m_result = GateResult{};
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "manifest::IncrementalGate::apply"});
+        }
+    }
+
+    void IncrementalGate::invalidate() noexcept
+    {
+        m_stale = true;
+    }
+
+    const GateResult &IncrementalGate::result() const noexcept
+    {
+        return m_result;
+    }
+
+    std::span<const Signature> IncrementalGate::signatures() const noexcept
+    {
+        return m_signatures;
+    }
+
+    std::span<const anchor::ResolvedAnchor> IncrementalGate::report() const noexcept
+    {
+        return m_report;
+    }
+
+    struct LazyGate::Slot
+    {
+        std::once_flag once;
+        // Set with release once resolved and trusted are written, so settled() and resolved() read them lock-free.
+        std::atomic<bool> settled{false};
+        anchor::ResolvedAnchor resolved;
+        std::optional<GatedSignature> trusted;
+    };
+
+    LazyGate::LazyGate(std::vector<Signature> signatures, const GatePolicy &policy, Region scope)
+        : m_policy(policy), m_scope(scope), m_signatures(std::move(signatures)),
+          m_parents(parent_indices(m_signatures)), m_slots(std::make_unique<Slot[]>(m_signatures.size()))
+    {
+        // settle() walks the parent chain first, so a chain that loops back on itself must never reach it: a
+        // signature whose walk outlasts the manifest sits on a cycle and is cut loose to fail closed, which is what
+        // the batch does with a node it never reaches.
+        const std::size_t count = m_signatures.size();
+        for (std::size_t index = 0; index < count; ++index)
+        {
+            std::size_t at = index;
+            std::size_t steps = 0;
+            while (at < count && m_parents[at] != DetourModKit::detail::FORK_JOIN_NO_PARENT && steps <= count)
+            {
+                at = m_parents[at];
+                ++steps;
+            }
+            if (steps > count)
+            {
+                m_parents[index] = count;
+            }
+        }
+    }
+
+    LazyGate::~LazyGate() noexcept
+    {
+        stop_prefetch();
+    }
+
+    void LazyGate::store(std::size_t index, const anchor::ResolvedAnchor &outcome) noexcept
+    {
+        Slot &slot = m_slots[index];
+        const Signature &signature = m_signatures[index];
+        slot.resolved = outcome;
+        if (passes_gate(outcome, signature.fingerprint_state(), m_policy))
+        {
+            slot.trusted = gated_entry(signature, outcome);
+        }
+        slot.settled.store(true, std::memory_order_release);
+    }
+
+    void LazyGate::settle(std::size_t index) noexcept
+    {
+        Slot &slot = m_slots[index];
+        if (slot.settled.load(std::memory_order_acquire))
+        {
+            return;
+        }
+        const std::size_t parent = m_parents[index];
+        if (parent < m_signatures.size())
+        {
+            settle(parent);
+        }
+        std::call_once(slot.once,
+                       [this, index, parent]() noexcept
+                       {
+                           const Signature &signature = m_signatures[index];
+                           anchor::ResolvedAnchor outcome{signature.label(), signature.kind(),
+                                                          anchor::AnchorStatus::Failed, 0};
+                           try
+                           {
+                               const anchor::Anchor view = signature.make_anchor();
+                               if (parent == DetourModKit::detail::FORK_JOIN_NO_PARENT)
+                               {
+                                   outcome = anchor::resolve(
+                                       view, signature.record().module.empty() ? m_scope : signature.scope());
+                               }
+                               else if (parent < m_signatures.size())
+                               {
+                                   outcome = resolve_in_parent(signature, view, m_slots[parent].resolved);
+                               }
+                           }
+                           catch (...)
+                           {
+                               // A throwing validator settles its signature as Failed, never as a retry.
+                           }
+                           store(index, outcome);
+                       });
+    }
+
+    const GatedSignature *LazyGate::get(std::size_t index) noexcept
+    {
+        if (index >= m_signatures.size())
+        {
+            return nullptr;
+        }
+        settle(index);
+        const std::optional<GatedSignature> &trusted = m_slots[index].trusted;
+        return trusted ? &*trusted : nullptr;
+    }
+
+    const GatedSignature *LazyGate::find(std::string_view label) noexcept
+    {
+        const std::optional<std::size_t> index = index_of(label);
+        return index ? get(*index) : nullptr;
+    }
+
+    Result<void> LazyGate::resolve_now(std::span<const std::string_view> labels)
+    {
+        const std::size_t count = m_signatures.size();
+        try
         {
-            const double fraction = static_cast<double>(result.trusted.size()) / static_cast<double>(signatures.size());
-            if (fraction < floor)
+            // Mark the named signatures and every ancestor that is still unsettled; the rest of the batch is passed
+            // through as kept, either a settled verdict or a placeholder that is never stored.
+            std::vector<std::uint8_t> wanted(count, 0);
+            for (std::size_t position = 0; position < labels.size(); ++position)
+            {
+                const std::optional<std::size_t> index = index_of(labels[position]);
+                if (!index)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "LazyGate::resolve_now", position});
+                }
+                for (std::size_t at = *index; at < count && wanted[at] == 0; at = m_parents[at])
+                {
+                    wanted[at] = 1;
+                }
+            }
+
+            std::vector<std::optional<anchor::ResolvedAnchor>> kept(count);
+            std::vector<anchor::Anchor> anchors;
+            anchors.reserve(count);
+            std::size_t pending = 0;
+            for (std::size_t index = 0; index < count; ++index)
             {
-                for (std::size_t index = 0; index < result.trusted.size(); ++index)
+                const Signature &signature = m_signatures[index];
+                anchors.push_back(signature.make_anchor());
+                if (m_slots[index].settled.load(std::memory_order_acquire))
+                {
+                    kept[index] = m_slots[index].resolved;
+                }
+                else if (wanted[index] == 0)
+                {
+                    kept[index] =
+                        anchor::ResolvedAnchor{signature.label(), signature.kind(), anchor::AnchorStatus::Failed, 0};
+                }
+                else
                 {
-                    result.rejected.push_back(RejectedSignature{.label = result.trusted[index].label,
-                                                                .status = anchor::AnchorStatus::Resolved,
-                                                                .fingerprint = trusted_fingerprints[index]});
+                    ++pending;
                 }
-                result.trusted.clear();
             }
+            if (pending == 0)
+            {
+                return {};
+            }
+
+            const std::vector<anchor::ResolvedAnchor> report =
+                resolve_report(m_signatures, anchors, kept, m_policy.max_workers, m_scope);
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                // A first access or the prefetch worker may have settled it meanwhile; the flag keeps whichever
+                // verdict landed first, and both came from the same resolve.
+                if (!kept[index])
+                {
+                    std::call_once(m_slots[index].once,
+                                   [this, index, &report]() noexcept { store(index, report[index]); });
+                }
+            }
+            return {};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "LazyGate::resolve_now"});
         }
+    }
 
-        return result;
+    Result<void> LazyGate::prefetch() noexcept
+    {
+        if (m_prefetch && m_prefetch->is_running())
+        {
+            return {};
+        }
+        try
+        {
+            m_prefetch.reset();
+            m_prefetch = std::make_unique<StoppableWorker>(
+                "manifest prefetch",
+                [this](std::stop_token stop)
+                {
+                    for (std::size_t index = 0; index < m_signatures.size() && !stop.stop_requested(); ++index)
+                    {
+                        settle(index);
+                    }
+                });
+            return {};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "LazyGate::prefetch"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::SystemCallFailed, "LazyGate::prefetch"});
+        }
+    }
+
+    void LazyGate::stop_prefetch() noexcept
+    {
+        if (m_prefetch)
+        {
+            m_prefetch->shutdown();
+        }
+    }
+
+    bool LazyGate::settled(std::size_t index) const noexcept
+    {
+        return index < m_signatures.size() && m_slots[index].settled.load(std::memory_order_acquire);
+    }
+
+    const anchor::ResolvedAnchor *LazyGate::resolved(std::size_t index) const noexcept
+    {
+        return settled(index) ? &m_slots[index].resolved : nullptr;
+    }
+
+    std::optional<std::size_t> LazyGate::index_of(std::string_view label) const noexcept
+    {
+        const auto it = std::ranges::find(m_signatures, label, &Signature::label);
+        if (it == m_signatures.end())
+        {
+            return std::nullopt;
+        }
+        return static_cast<std::size_t>(it - m_signatures.begin());
+    }
+
+    std::span<const Signature> LazyGate::signatures() const noexcept
+    {
+        return m_signatures;
     }
 
     std::string_view binding_kind_to_string(BindingKind kind) noexcept
@@ -0,0 +1,760 @@
+/**
+ * @file manifest_binary.cpp
+ * @brief The compiled binary manifest: compile_to_binary, parse_binary, and their file wrappers.
+ * @details The blob is the INI manifest with every parse already done. A fixed header (magic, format version, the
+ *          manifest header, the table counts, the total size, and a checksum of everything after it) is followed by
+ *          four fixed-size tables laid back to back -- signatures, rungs, compiled patterns, binding offsets -- and
+ *          then a string pool. Every cross reference is an index into a table or an (offset, size) pair into the pool,
+ *          so the blob has no absolute pointers and loads from any address. The tables hold explicit-width fields
+ *          only and are read with memcpy, so neither the byte order nor the alignment of the mapping matters beyond
+ *          the x64 little-endian target the library already assumes.
+ *
+ *          The loader trusts nothing it cannot check cheaply: the checksum first, then every index and string range
+ *          against its table, every enumerator against its type, and every stored pattern through
+ *          detail::pattern_from_buffer before a Pattern exists.
+ */
+
+#include "DetourModKit/manifest.hpp"
+
+#include "internal/fnv1a.hpp"
+#include "internal/ini_reader.hpp"
+
+#include "DetourModKit/hook.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit::manifest
+{
+    namespace
+    {
+        constexpr std::array<char, 8> BLOB_MAGIC = {'D', 'M', 'K', 'M', 'A', 'N', 'B', '\0'};
+
+        // A rung with no stored pattern (a text tier, or a rung of a kind that never compiles its ladder).
+        constexpr std::uint32_t NO_PATTERN = std::numeric_limits<std::uint32_t>::max();
+
+        // The hook::Gpr enumerators a manifest can name (rax .. r15; rsp and rip are absent from the enum).
+        constexpr std::uint8_t GPR_COUNT = 15;
+
+        // xref_flags / string_flags bits.
+        constexpr std::uint8_t FLAG_REQUIRE_TERMINATOR = 0x01;
+        constexpr std::uint8_t FLAG_BROAD_MATCH = 0x02;
+
+        struct BlobHeader
+        {
+            std::array<char, 8> magic;
+            std::uint32_t format_version;
+            std::uint32_t schema;
+            std::uint32_t revision;
+            std::uint32_t signature_count;
+            std::uint32_t rung_count;
+            std::uint32_t pattern_count;
+            std::uint32_t offset_count;
+            std::uint32_t strings_size;
+            std::uint64_t total_size;
+            // FNV-1a 64 over every byte after the header.
+            std::uint64_t checksum;
+        };
+
+        // A range of the string pool.
+        struct BlobString
+        {
+            std::uint32_t offset;
+            std::uint32_t size;
+        };
+
+        struct BlobSignature
+        {
+            BlobString label;
+            BlobString module;
+            BlobString mangled;
+            BlobString xref_text;
+            BlobString export_name;
+            BlobString parent;
+            std::int64_t manual_value;
+            std::uint64_t expected_fingerprint;
+            std::uint64_t last_seen_rva;
+            std::uint64_t parent_window;
+            std::uint64_t vmt_index;
+            std::uint32_t first_rung;
+            std::uint32_t rung_count;
+            std::uint32_t first_offset;
+            std::uint32_t offset_count;
+            std::uint8_t kind;
+            std::uint8_t pages;
+            std::uint8_t operand_kind;
+            std::uint8_t operand_index;
+            std::uint8_t byte_width;
+            std::uint8_t xref_encoding;
+            std::uint8_t xref_return;
+            std::uint8_t xref_flags;
+            std::uint8_t binding_kind;
+            std::uint8_t value_width;
+            std::uint8_t read_register;
+            std::uint8_t xmm_index;
+            std::array<std::uint8_t, 4> reserved;
+        };
+
+        struct BlobRung
+        {
+            BlobString name;
+            BlobString pattern;
+            BlobString mangled;
+            BlobString string_text;
+            std::int64_t walk_back;
+            std::int64_t displacement_at;
+            std::uint64_t instruction_length;
+            std::uint32_t pattern_index;
+            std::uint8_t mode;
+            std::uint8_t string_encoding;
+            std::uint8_t string_return;
+            std::uint8_t string_flags;
+        };
+
+        struct BlobJump
+        {
+            std::uint32_t position;
+            std::uint32_t min_skip;
+            std::uint32_t max_skip;
+        };
+
+        struct BlobClass
+        {
+            std::uint32_t position;
+            std::uint32_t reserved;
+            std::array<std::uint64_t, 4> members;
+        };
+
+        struct BlobGroup
+        {
+            std::uint32_t position;
+            std::uint32_t length;
+            std::uint32_t count;
+            std::uint32_t reserved;
+            std::array<std::array<std::uint8_t, detail::MAX_GROUP_BYTES>, detail::MAX_GROUP_ALTERNATIVES> bytes;
+            std::array<std::array<std::uint8_t, detail::MAX_GROUP_BYTES>, detail::MAX_GROUP_ALTERNATIVES> mask;
+        };
+
+        struct BlobPattern
+        {
+            std::array<std::uint8_t, detail::MAX_PATTERN_BYTES> bytes;
+            std::array<std::uint8_t, detail::MAX_PATTERN_BYTES> mask;
+            std::uint32_t length;
+            std::uint32_t offset;
+            std::uint32_t jump_count;
+            std::uint32_t reserved;
+            std::array<BlobJump, detail::MAX_PATTERN_JUMPS> jumps;
+            std::uint32_t class_count;
+            std::uint32_t group_count;
+            std::array<BlobClass, detail::MAX_PATTERN_CLASSES> classes;
+            std::array<BlobGroup, detail::MAX_PATTERN_GROUPS> groups;
+        };
+
+        // The on-disk layout is these exact sizes; a padding change would silently break every shipped blob.
+        static_assert(sizeof(BlobHeader) == 56 && sizeof(BlobString) == 8 && sizeof(BlobSignature) == 120 &&
+                          sizeof(BlobRung) == 64 && sizeof(BlobPattern) == 856,
+                      "binary manifest layout changed; bump BINARY_FORMAT_VERSION");
+        static_assert(std::is_trivially_copyable_v<BlobHeader> && std::is_trivially_copyable_v<BlobSignature> &&
+                      std::is_trivially_copyable_v<BlobRung> && std::is_trivially_copyable_v<BlobPattern>);
+
+        [[nodiscard]] std::unexpected<Error> fail(ErrorCode code, const char *where) noexcept
+        {
+            return std::unexpected(Error{code, where});
+        }
+
+        [[nodiscard]] std::uint64_t checksum_of(std::span<const std::byte> bytes) noexcept
+        {
+            std::uint64_t hash = detail::FNV1A64_OFFSET;
+            for (const std::byte b : bytes)
+            {
+                hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(b));
+            }
+            return hash;
+        }
+
+        [[nodiscard]] constexpr std::uint8_t pack_flags(bool require_terminator, bool broad_match) noexcept
+        {
+            return static_cast<std::uint8_t>((require_terminator ? FLAG_REQUIRE_TERMINATOR : 0) |
+                                             (broad_match ? FLAG_BROAD_MATCH : 0));
+        }
+
+        // Accumulates the tables and the string pool; each append is a plain push, and the pool is not deduplicated
+        // (labels and patterns rarely repeat, and a shared range would only save bytes the mapping never touches).
+        class BlobWriter
+        {
+        public:
+            [[nodiscard]] BlobString add_string(std::string_view text)
+            {
+                const BlobString range{static_cast<std::uint32_t>(m_strings.size()),
+                                       static_cast<std::uint32_t>(text.size())};
+                m_strings.append(text);
+                return range;
+            }
+
+            [[nodiscard]] std::uint32_t add_pattern(const scan::Pattern &pattern)
+            {
+                const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+                BlobPattern stored{};
+                for (std::size_t i = 0; i < buffer.length; ++i)
+                {
+                    stored.bytes[i] = std::to_integer<std::uint8_t>(buffer.bytes[i]);
+                    stored.mask[i] = std::to_integer<std::uint8_t>(buffer.mask[i]);
+                }
+                stored.length = static_cast<std::uint32_t>(buffer.length);
+                stored.offset = static_cast<std::uint32_t>(buffer.offset);
+                stored.jump_count = static_cast<std::uint32_t>(buffer.jump_count);
+                for (std::size_t i = 0; i < buffer.jump_count; ++i)
+                {
+                    stored.jumps[i] = BlobJump{static_cast<std::uint32_t>(buffer.jumps[i].position),
+                                               static_cast<std::uint32_t>(buffer.jumps[i].min_skip),
+                                               static_cast<std::uint32_t>(buffer.jumps[i].max_skip)};
+                }
+                stored.class_count = static_cast<std::uint32_t>(buffer.class_count);
+                for (std::size_t i = 0; i < buffer.class_count; ++i)
+                {
+                    stored.classes[i].position = static_cast<std::uint32_t>(buffer.classes[i].position);
+                    stored.classes[i].members = buffer.classes[i].members.words;
+                }
+                stored.group_count = static_cast<std::uint32_t>(buffer.group_count);
+                for (std::size_t i = 0; i < buffer.group_count; ++i)
+                {
+                    const detail::PatternGroup &group = buffer.groups[i];
+                    BlobGroup &out = stored.groups[i];
+                    out.position = static_cast<std::uint32_t>(group.position);
+                    out.length = static_cast<std::uint32_t>(group.length);
+                    out.count = static_cast<std::uint32_t>(group.count);
+                    for (std::size_t a = 0; a < detail::MAX_GROUP_ALTERNATIVES; ++a)
+                    {
+                        for (std::size_t b = 0; b < detail::MAX_GROUP_BYTES; ++b)
+                        {
+                            out.bytes[a][b] = std::to_integer<std::uint8_t>(group.bytes[a][b]);
+                            out.mask[a][b] = std::to_integer<std::uint8_t>(group.mask[a][b]);
+                        }
+                    }
+                }
+                m_patterns.push_back(stored);
+                return static_cast<std::uint32_t>(m_patterns.size() - 1);
+            }
+
+            std::vector<BlobSignature> signatures;
+            std::vector<BlobRung> rungs;
+            std::vector<std::int64_t> offsets;
+
+            // The four tables and the pool must each stay addressable by the header's 32-bit fields.
+            [[nodiscard]] bool fits() const noexcept
+            {
+                constexpr std::size_t LIMIT = std::numeric_limits<std::uint32_t>::max();
+                return signatures.size() <= LIMIT && rungs.size() < LIMIT && m_patterns.size() < LIMIT &&
+                       offsets.size() <= LIMIT && m_strings.size() <= LIMIT;
+            }
+
+            [[nodiscard]] std::vector<std::byte> finish(const ManifestHeader &manifest_header) const
+            {
+                const std::size_t body_size = signatures.size() * sizeof(BlobSignature) +
+                                              rungs.size() * sizeof(BlobRung) +
+                                              m_patterns.size() * sizeof(BlobPattern) +
+                                              offsets.size() * sizeof(std::int64_t) + m_strings.size();
+                std::vector<std::byte> blob(sizeof(BlobHeader) + body_size);
+                std::size_t cursor = sizeof(BlobHeader);
+                const auto put = [&blob, &cursor](const void *data, std::size_t size)
+                {
+                    if (size != 0)
+                    {
+                        std::memcpy(blob.data() + cursor, data, size);
+                        cursor += size;
+                    }
+                };
+                put(signatures.data(), signatures.size() * sizeof(BlobSignature));
+                put(rungs.data(), rungs.size() * sizeof(BlobRung));
+                put(m_patterns.data(), m_patterns.size() * sizeof(BlobPattern));
+                put(offsets.data(), offsets.size() * sizeof(std::int64_t));
+                put(m_strings.data(), m_strings.size());
+
+                const BlobHeader header{
+                    .magic = BLOB_MAGIC,
+                    .format_version = BINARY_FORMAT_VERSION,
+                    .schema = SCHEMA_VERSION,
+                    .revision = manifest_header.revision,
+                    .signature_count = static_cast<std::uint32_t>(signatures.size()),
+                    .rung_count = static_cast<std::uint32_t>(rungs.size()),
+                    .pattern_count = static_cast<std::uint32_t>(m_patterns.size()),
+                    .offset_count = static_cast<std::uint32_t>(offsets.size()),
+                    .strings_size = static_cast<std::uint32_t>(m_strings.size()),
+                    .total_size = static_cast<std::uint64_t>(blob.size()),
+                    .checksum = checksum_of(std::span<const std::byte>(blob).subspan(sizeof(BlobHeader))),
+                };
+                std::memcpy(blob.data(), &header, sizeof(header));
+                return blob;
+            }
+
+        private:
+            std::vector<BlobPattern> m_patterns;
+            std::string m_strings;
+        };
+
+        // Random access into a blob whose header and total size have already been checked. Each table read copies the
+        // fixed-size entry out, so nothing depends on the mapping's alignment.
+        class BlobReader
+        {
+        public:
+            BlobReader(std::span<const std::byte> blob, const BlobHeader &header) noexcept
+                : m_blob(blob), m_header(header)
+            {
+                m_rungs_at = sizeof(BlobHeader) + std::size_t{header.signature_count} * sizeof(BlobSignature);
+                m_patterns_at = m_rungs_at + std::size_t{header.rung_count} * sizeof(BlobRung);
+                m_offsets_at = m_patterns_at + std::size_t{header.pattern_count} * sizeof(BlobPattern);
+                m_strings_at = m_offsets_at + std::size_t{header.offset_count} * sizeof(std::int64_t);
+            }
+
+            [[nodiscard]] BlobSignature signature(std::size_t index) const noexcept
+            {
+                return entry<BlobSignature>(sizeof(BlobHeader), index);
+            }
+
+            [[nodiscard]] BlobRung rung(std::size_t index) const noexcept { return entry<BlobRung>(m_rungs_at, index); }
+
+            [[nodiscard]] BlobPattern pattern(std::size_t index) const noexcept
+            {
+                return entry<BlobPattern>(m_patterns_at, index);
+            }
+
+            [[nodiscard]] std::int64_t offset(std::size_t index) const noexcept
+            {
+                return entry<std::int64_t>(m_offsets_at, index);
+            }
+
+            // A pool range, or nullopt when it runs past the pool.
+            [[nodiscard]] std::optional<std::string_view> string(BlobString range) const noexcept
+            {
+                if (std::uint64_t{range.offset} + range.size > m_header.strings_size)
+                {
+                    return std::nullopt;
+                }
+                return std::string_view(reinterpret_cast<const char *>(m_blob.data() + m_strings_at + range.offset),
+                                        range.size);
+            }
+
+            // True when [first, first + count) lies inside a table of @p table_size entries.
+            [[nodiscard]] static bool in_table(std::uint32_t first, std::uint32_t count,
+                                               std::uint32_t table_size) noexcept
+            {
+                return std::uint64_t{first} + count <= table_size;
+            }
+
+        private:
+            template <typename T> [[nodiscard]] T entry(std::size_t table_at, std::size_t index) const noexcept
+            {
+                T value;
+                std::memcpy(&value, m_blob.data() + table_at + index * sizeof(T), sizeof(T));
+                return value;
+            }
+
+            std::span<const std::byte> m_blob;
+            const BlobHeader &m_header;
+            std::size_t m_rungs_at = 0;
+            std::size_t m_patterns_at = 0;
+            std::size_t m_offsets_at = 0;
+            std::size_t m_strings_at = 0;
+        };
+
+        [[nodiscard]] bool is_serializable_kind(std::uint8_t kind) noexcept
+        {
+            switch (static_cast<anchor::AnchorKind>(kind))
+            {
+            case anchor::AnchorKind::VtableIdentity:
+            case anchor::AnchorKind::RipGlobal:
+            case anchor::AnchorKind::CodeOperand:
+            case anchor::AnchorKind::StringXref:
+            case anchor::AnchorKind::Manual:
+            case anchor::AnchorKind::ExportName:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        [[nodiscard]] std::optional<scan::Pattern> stored_pattern(const BlobReader &reader, const BlobHeader &header,
+                                                                  std::uint32_t index) noexcept
+        {
+            if (index >= header.pattern_count)
+            {
+                return std::nullopt;
+            }
+            const BlobPattern stored = reader.pattern(index);
+            if (stored.length > detail::MAX_PATTERN_BYTES || stored.jump_count > detail::MAX_PATTERN_JUMPS ||
+                stored.class_count > detail::MAX_PATTERN_CLASSES || stored.group_count > detail::MAX_PATTERN_GROUPS)
+            {
+                return std::nullopt;
+            }
+            detail::PatternBuffer buffer{};
+            for (std::size_t i = 0; i < detail::MAX_PATTERN_BYTES; ++i)
+            {
+                buffer.bytes[i] = std::byte{stored.bytes[i]};
+                buffer.mask[i] = std::byte{stored.mask[i]};
+            }
+            buffer.length = stored.length;
+            buffer.offset = stored.offset;
+            buffer.jump_count = stored.jump_count;
+            for (std::size_t i = 0; i < stored.jump_count; ++i)
+            {
+                buffer.jumps[i] = detail::PatternJump{stored.jumps[i].position, stored.jumps[i].min_skip,
+                                                      stored.jumps[i].max_skip};
+            }
+            buffer.class_count = stored.class_count;
+            for (std::size_t i = 0; i < stored.class_count; ++i)
+            {
+                buffer.classes[i].position = stored.classes[i].position;
+                buffer.classes[i].members.words = stored.classes[i].members;
+            }
+            buffer.group_count = stored.group_count;
+            for (std::size_t i = 0; i < stored.group_count; ++i)
+            {
+                const BlobGroup &group = stored.groups[i];
+                buffer.groups[i].position = group.position;
+                buffer.groups[i].length = group.length;
+                buffer.groups[i].count = group.count;
+                for (std::size_t a = 0; a < detail::MAX_GROUP_ALTERNATIVES; ++a)
+                {
+                    for (std::size_t b = 0; b < detail::MAX_GROUP_BYTES; ++b)
+                    {
+                        buffer.groups[i].bytes[a][b] = std::byte{group.bytes[a][b]};
+                        buffer.groups[i].mask[a][b] = std::byte{group.mask[a][b]};
+                    }
+                }
+            }
+            return detail::pattern_from_buffer(buffer);
+        }
+
+        // Rebuilds one rung's CandidateSpec and, for a signature whose kind resolves through its ladder, the compiled
+        // Candidate. Mirrors compile_rung in manifest.cpp, with the stored pattern in place of Pattern::compile.
+        [[nodiscard]] bool read_rung(const BlobReader &reader, const BlobHeader &header, const BlobRung &stored,
+                                     bool compile, CandidateSpec &spec, std::optional<scan::Candidate> &candidate)
+        {
+            const std::optional<std::string_view> name = reader.string(stored.name);
+            const std::optional<std::string_view> pattern = reader.string(stored.pattern);
+            const std::optional<std::string_view> mangled = reader.string(stored.mangled);
+            const std::optional<std::string_view> text = reader.string(stored.string_text);
+            if (!name || !pattern || !mangled || !text ||
+                stored.mode > static_cast<std::uint8_t>(scan::Mode::StringXref) ||
+                stored.string_encoding > static_cast<std::uint8_t>(scan::StringEncoding::Utf16le) ||
+                stored.string_return > static_cast<std::uint8_t>(scan::XrefReturn::StringPointerSlot))
+            {
+                return false;
+            }
+            spec.name = std::string(*name);
+            spec.mode = static_cast<scan::Mode>(stored.mode);
+            spec.pattern = std::string(*pattern);
+            spec.walk_back = static_cast<std::ptrdiff_t>(stored.walk_back);
+            spec.displacement_at = static_cast<std::ptrdiff_t>(stored.displacement_at);
+            spec.instruction_length = static_cast<std::size_t>(stored.instruction_length);
+            spec.mangled = std::string(*mangled);
+            spec.string_text = std::string(*text);
+            spec.string_encoding = static_cast<scan::StringEncoding>(stored.string_encoding);
+            spec.string_return = static_cast<scan::XrefReturn>(stored.string_return);
+            spec.string_require_terminator = (stored.string_flags & FLAG_REQUIRE_TERMINATOR) != 0;
+            spec.string_broad_match = (stored.string_flags & FLAG_BROAD_MATCH) != 0;
+            if (!compile)
+            {
+                return true;
+            }
+
+            switch (spec.mode)
+            {
+            case scan::Mode::Direct:
+            {
+                const std::optional<scan::Pattern> compiled = stored_pattern(reader, header, stored.pattern_index);
+                if (!compiled)
+                {
+                    return false;
+                }
+                candidate = scan::Candidate::direct(spec.name, *compiled, spec.walk_back);
+                return true;
+            }
+            case scan::Mode::RipRelative:
+            {
+                const std::optional<scan::Pattern> compiled = stored_pattern(reader, header, stored.pattern_index);
+                if (!compiled || spec.displacement_at < 0 ||
+                    !scan::is_valid_rip_relative_layout(static_cast<std::size_t>(spec.displacement_at),
+                                                        spec.instruction_length))
+                {
+                    return false;
+                }
+                candidate =
+                    scan::Candidate::rip_relative(spec.name, *compiled, spec.displacement_at, spec.instruction_length);
+                return true;
+            }
+            case scan::Mode::RttiVtable:
+                candidate = scan::Candidate::rtti_vtable(spec.name, spec.mangled);
+                return true;
+            case scan::Mode::StringXref:
+                candidate = scan::Candidate::string_xref(spec.name, scan::StringRefQuery{
+                                                                        .text = spec.string_text,
+                                                                        .encoding = spec.string_encoding,
+                                                                        .require_terminator =
+                                                                            spec.string_require_terminator,
+                                                                        .return_mode = spec.string_return,
+                                                                        .broad_match = spec.string_broad_match,
+                                                                    });
+                return true;
+            }
+            return false;
+        }
+    } // namespace
+
+    Result<std::vector<std::byte>> compile_to_binary(const Manifest &manifest)
+    {
+        BlobWriter writer;
+        writer.signatures.reserve(manifest.records.size());
+        for (std::size_t index = 0; index < manifest.records.size(); ++index)
+        {
+            const SignatureRecord &record = manifest.records[index];
+            // Compile exactly as a load of the INI would, so the blob never carries a record the text path rejects.
+            if (Result<Signature> compiled = Signature::compile(record); !compiled)
+            {
+                Error error = compiled.error();
+                error.where = "manifest::compile_to_binary";
+                error.detail = index;
+                return std::unexpected(error);
+            }
+            const bool uses_ladder =
+                record.kind == anchor::AnchorKind::RipGlobal || record.kind == anchor::AnchorKind::CodeOperand;
+
+            BlobSignature stored{};
+            stored.label = writer.add_string(record.label);
+            stored.module = writer.add_string(record.module);
+            stored.mangled = writer.add_string(record.mangled);
+            stored.xref_text = writer.add_string(record.xref_text);
+            stored.export_name = writer.add_string(record.export_name);
+            stored.parent = writer.add_string(record.parent);
+            stored.manual_value = record.manual_value;
+            stored.expected_fingerprint = record.expected_fingerprint;
+            stored.last_seen_rva = record.last_seen_rva;
+            stored.parent_window = record.parent_window;
+            stored.vmt_index = static_cast<std::uint64_t>(record.binding.vmt_index);
+            stored.first_rung = static_cast<std::uint32_t>(writer.rungs.size());
+            stored.rung_count = static_cast<std::uint32_t>(record.ladder.size());
+            stored.first_offset = static_cast<std::uint32_t>(writer.offsets.size());
+            stored.offset_count = static_cast<std::uint32_t>(record.binding.offsets.size());
+            stored.kind = static_cast<std::uint8_t>(record.kind);
+            stored.pages = static_cast<std::uint8_t>(record.pages);
+            stored.operand_kind = static_cast<std::uint8_t>(record.operand_kind);
+            stored.operand_index = record.operand_index;
+            stored.byte_width = record.byte_width;
+            stored.xref_encoding = static_cast<std::uint8_t>(record.xref_encoding);
+            stored.xref_return = static_cast<std::uint8_t>(record.xref_return);
+            stored.xref_flags = pack_flags(record.xref_require_terminator, record.xref_broad_match);
+            stored.binding_kind = static_cast<std::uint8_t>(record.binding.kind);
+            stored.value_width = record.binding.value_width;
+            stored.read_register = static_cast<std::uint8_t>(record.binding.read_register);
+            stored.xmm_index = record.binding.xmm_index;
+
+            for (const CandidateSpec &spec : record.ladder)
+            {
+                BlobRung rung{};
+                rung.name = writer.add_string(spec.name);
+                rung.pattern = writer.add_string(spec.pattern);
+                rung.mangled = writer.add_string(spec.mangled);
+                rung.string_text = writer.add_string(spec.string_text);
+                rung.walk_back = static_cast<std::int64_t>(spec.walk_back);
+                rung.displacement_at = static_cast<std::int64_t>(spec.displacement_at);
+                rung.instruction_length = static_cast<std::uint64_t>(spec.instruction_length);
+                rung.pattern_index = NO_PATTERN;
+                rung.mode = static_cast<std::uint8_t>(spec.mode);
+                rung.string_encoding = static_cast<std::uint8_t>(spec.string_encoding);
+                rung.string_return = static_cast<std::uint8_t>(spec.string_return);
+                rung.string_flags = pack_flags(spec.string_require_terminator, spec.string_broad_match);
+                // Only a ladder the signature resolves through was compiled above, so only its byte rungs are known
+                // to hold a pattern that compiles.
+                if (uses_ladder && (spec.mode == scan::Mode::Direct || spec.mode == scan::Mode::RipRelative))
+                {
+                    const Result<scan::Pattern> pattern = scan::Pattern::compile(spec.pattern);
+                    if (!pattern)
+                    {
+                        return std::unexpected(Error{pattern.error().code, "manifest::compile_to_binary", index,
+                                                     pattern.error().extra});
+                    }
+                    rung.pattern_index = writer.add_pattern(*pattern);
+                }
+                writer.rungs.push_back(rung);
+            }
+            for (const std::ptrdiff_t offset : record.binding.offsets)
+            {
+                writer.offsets.push_back(static_cast<std::int64_t>(offset));
+            }
+            writer.signatures.push_back(stored);
+        }
+        if (!writer.fits())
+        {
+            return fail(ErrorCode::InvalidArg, "manifest::compile_to_binary");
+        }
+        return writer.finish(manifest.header);
+    }
+
+    Result<CompiledManifest> parse_binary(std::span<const std::byte> blob)
+    {
+        BlobHeader header;
+        if (blob.size() < sizeof(header))
+        {
+            return fail(ErrorCode::MissingHeader, "manifest::parse_binary");
+        }
+        std::memcpy(&header, blob.data(), sizeof(header));
+        if (header.magic != BLOB_MAGIC || header.format_version != BINARY_FORMAT_VERSION ||
+            header.schema != SCHEMA_VERSION || header.total_size != blob.size())
+        {
+            return fail(ErrorCode::MissingHeader, "manifest::parse_binary");
+        }
+        // The counts are 32-bit, so the table sizes cannot overflow 64-bit arithmetic.
+        const std::uint64_t body = std::uint64_t{header.signature_count} * sizeof(BlobSignature) +
+                                   std::uint64_t{header.rung_count} * sizeof(BlobRung) +
+                                   std::uint64_t{header.pattern_count} * sizeof(BlobPattern) +
+                                   std::uint64_t{header.offset_count} * sizeof(std::int64_t) + header.strings_size;
+        if (body != blob.size() - sizeof(header) || checksum_of(blob.subspan(sizeof(header))) != header.checksum)
+        {
+            return fail(ErrorCode::MalformedLine, "manifest::parse_binary");
+        }
+
+        try
+        {
+            const BlobReader reader(blob, header);
+            CompiledManifest out;
+            out.header = ManifestHeader{.schema = header.schema, .revision = header.revision};
+            out.signatures.reserve(header.signature_count);
+            for (std::size_t index = 0; index < header.signature_count; ++index)
+            {
+                const BlobSignature stored = reader.signature(index);
+                const std::optional<std::string_view> label = reader.string(stored.label);
+                const std::optional<std::string_view> module = reader.string(stored.module);
+                const std::optional<std::string_view> mangled = reader.string(stored.mangled);
+                const std::optional<std::string_view> xref_text = reader.string(stored.xref_text);
+                const std::optional<std::string_view> export_name = reader.string(stored.export_name);
+                const std::optional<std::string_view> parent = reader.string(stored.parent);
+                if (!label || !module || !mangled || !xref_text || !export_name || !parent ||
+                    !is_serializable_kind(stored.kind) ||
+                    stored.pages > static_cast<std::uint8_t>(scan::Pages::Executable) ||
+                    stored.operand_kind > static_cast<std::uint8_t>(scan::OperandKind::MemoryDisplacement) ||
+                    stored.xref_encoding > static_cast<std::uint8_t>(scan::StringEncoding::Utf16le) ||
+                    stored.xref_return > static_cast<std::uint8_t>(scan::XrefReturn::StringPointerSlot) ||
+                    stored.binding_kind > static_cast<std::uint8_t>(BindingKind::VmtMethod) ||
+                    stored.read_register >= GPR_COUNT ||
+                    !BlobReader::in_table(stored.first_rung, stored.rung_count, header.rung_count) ||
+                    !BlobReader::in_table(stored.first_offset, stored.offset_count, header.offset_count))
+                {
+                    return fail(ErrorCode::MalformedLine, "manifest::parse_binary");
+                }
+
+                SignatureRecord record;
+                record.label = std::string(*label);
+                record.kind = static_cast<anchor::AnchorKind>(stored.kind);
+                record.module = std::string(*module);
+                record.mangled = std::string(*mangled);
+                record.operand_kind = static_cast<scan::OperandKind>(stored.operand_kind);
+                record.operand_index = stored.operand_index;
+                record.byte_width = stored.byte_width;
+                record.xref_text = std::string(*xref_text);
+                record.xref_encoding = static_cast<scan::StringEncoding>(stored.xref_encoding);
+                record.xref_return = static_cast<scan::XrefReturn>(stored.xref_return);
+                record.xref_require_terminator = (stored.xref_flags & FLAG_REQUIRE_TERMINATOR) != 0;
+                record.xref_broad_match = (stored.xref_flags & FLAG_BROAD_MATCH) != 0;
+                record.manual_value = stored.manual_value;
+                record.binding.kind = static_cast<BindingKind>(stored.binding_kind);
+                record.binding.offsets.reserve(stored.offset_count);
+                for (std::size_t i = 0; i < stored.offset_count; ++i)
+                {
+                    record.binding.offsets.push_back(
+                        static_cast<std::ptrdiff_t>(reader.offset(std::size_t{stored.first_offset} + i)));
+                }
+                record.binding.value_width = stored.value_width;
+                record.binding.read_register = static_cast<hook::Gpr>(stored.read_register);
+                record.binding.xmm_index = stored.xmm_index;
+                record.binding.vmt_index = static_cast<std::size_t>(stored.vmt_index);
+                record.expected_fingerprint = stored.expected_fingerprint;
+                record.pages = static_cast<scan::Pages>(stored.pages);
+                record.export_name = std::string(*export_name);
+                record.last_seen_rva = stored.last_seen_rva;
+                record.parent = std::string(*parent);
+                record.parent_window = stored.parent_window;
+
+                // The evidence checks Signature::compile makes, so a blob cannot produce a signature the INI could not.
+                const bool uses_ladder =
+                    record.kind == anchor::AnchorKind::RipGlobal || record.kind == anchor::AnchorKind::CodeOperand;
+                if ((uses_ladder && stored.rung_count == 0) ||
+                    (record.kind == anchor::AnchorKind::VtableIdentity && record.mangled.empty()) ||
+                    (record.kind == anchor::AnchorKind::StringXref && record.xref_text.empty()) ||
+                    (record.kind == anchor::AnchorKind::ExportName && record.export_name.empty()))
+                {
+                    return fail(ErrorCode::MalformedLine, "manifest::parse_binary");
+                }
+
+                std::vector<scan::Candidate> ladder;
+                record.ladder.resize(stored.rung_count);
+                if (uses_ladder)
+                {
+                    ladder.reserve(stored.rung_count);
+                }
+                for (std::size_t i = 0; i < stored.rung_count; ++i)
+                {
+                    std::optional<scan::Candidate> candidate;
+                    if (!read_rung(reader, header, reader.rung(std::size_t{stored.first_rung} + i), uses_ladder,
+                                   record.ladder[i], candidate))
+                    {
+                        return fail(ErrorCode::MalformedLine, "manifest::parse_binary");
+                    }
+                    if (candidate)
+                    {
+                        ladder.push_back(std::move(*candidate));
+                    }
+                }
+                out.signatures.push_back(Signature(std::move(record), std::move(ladder)));
+            }
+            return out;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return fail(ErrorCode::OutOfMemory, "manifest::parse_binary");
+        }
+    }
+
+    Result<void> save_binary(const std::filesystem::path &path, const Manifest &manifest)
+    {
+        const Result<std::vector<std::byte>> blob = compile_to_binary(manifest);
+        if (!blob)
+        {
+            return std::unexpected(blob.error());
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        if (!out)
+        {
+            return fail(ErrorCode::FileOpenFailed, "manifest::save_binary");
+        }
+        out.write(reinterpret_cast<const char *>(blob->data()), static_cast<std::streamsize>(blob->size()));
+        out.flush();
+        if (!out)
+        {
+            return fail(ErrorCode::FileWriteFailed, "manifest::save_binary");
+        }
+        return {};
+    }
+
+    Result<CompiledManifest> load_binary(const std::filesystem::path &path)
+    {
+        detail::MappedFile file;
+        if (!file.open(path))
+        {
+            return fail(ErrorCode::FileOpenFailed, "manifest::load_binary");
+        }
+        const std::string_view bytes = file.text();
+        return parse_binary(std::as_bytes(std::span<const char>(bytes.data(), bytes.size())));
+    }
+} // namespace DetourModKit::manifest
@@ -0,0 +1,252 @@
+/**
+ * @file math.cpp
+ * @brief The batch transforms of math.hpp: SSE kernels, and AVX kernels chosen by the scanner's SIMD tier.
+ * @details A Float3 array is twelve-byte records, so the kernels load four (SSE) or eight (AVX) points as three
+ *          full-width registers, shuffle them into one register per component, and transform the points as structure
+ *          of arrays before shuffling them back. A Float4 array needs no shuffle: each vector broadcasts its own
+ *          components against the matrix rows. The scalar tail uses the header's constexpr forms, so every path
+ *          computes the same sums in the same order.
+ */
+
+#include "DetourModKit/math.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include <xmmintrin.h>
+
+// The AVX kernels, compiled with a target attribute on GCC/Clang (as in rtti.cpp) so the rest of the TU stays baseline
+// x86-64; the runtime active_simd_level() gate decides whether they run.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
+
+namespace DetourModKit
+{
+    namespace
+    {
+        using math::Float3;
+        using math::Float4;
+        using math::Float4x4;
+
+        template <int I0, int I1, int I2, int I3> __m128 pick(__m128 p, __m128 q) noexcept
+        {
+            return _mm_shuffle_ps(p, q, _MM_SHUFFLE(I3, I2, I1, I0));
+        }
+
+        // Four xyz records a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3 into x, y, z = one component each.
+        void deinterleave(__m128 a, __m128 b, __m128 c, __m128 &x, __m128 &y, __m128 &z) noexcept
+        {
+            x = pick<0, 3, 0, 2>(a, pick<2, 2, 1, 1>(b, c));
+            y = pick<0, 2, 0, 2>(pick<1, 1, 0, 0>(a, b), pick<3, 3, 2, 2>(b, c));
+            z = pick<0, 2, 0, 2>(pick<2, 2, 1, 1>(a, b), pick<0, 0, 3, 3>(c, c));
+        }
+
+        void interleave(__m128 x, __m128 y, __m128 z, __m128 &a, __m128 &b, __m128 &c) noexcept
+        {
+            a = pick<0, 2, 0, 2>(pick<0, 0, 0, 0>(x, y), pick<0, 0, 1, 1>(z, x));
+            b = pick<0, 2, 0, 2>(pick<1, 1, 1, 1>(y, z), pick<2, 2, 2, 2>(x, y));
+            c = pick<0, 2, 0, 2>(pick<2, 2, 3, 3>(z, x), pick<3, 3, 3, 3>(y, z));
+        }
+
+        template <bool Point> Float3 transform_one(const Float4x4 &m, Float3 v) noexcept
+        {
+            return Point ? math::transform_point(m, v) : math::transform_vector(m, v);
+        }
+
+        template <bool Point>
+        void transform3_sse(const Float4x4 &m, const Float3 *in, Float3 *out, std::size_t count) noexcept
+        {
+            // col[j][k] broadcasts m[k][j]: the weight of input component k in output component j (k = 3: translation).
+            __m128 col[3][4];
+            for (int j = 0; j < 3; ++j)
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    col[j][k] = _mm_set1_ps(m.m[k][j]);
+                }
+            }
+
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const float *src = reinterpret_cast<const float *>(in + i);
+                __m128 x, y, z;
+                deinterleave(_mm_loadu_ps(src), _mm_loadu_ps(src + 4), _mm_loadu_ps(src + 8), x, y, z);
+                __m128 r[3];
+                for (int j = 0; j < 3; ++j)
+                {
+                    r[j] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, col[j][0]), _mm_mul_ps(y, col[j][1])),
+                                      _mm_mul_ps(z, col[j][2]));
+                    if constexpr (Point)
+                    {
+                        r[j] = _mm_add_ps(r[j], col[j][3]);
+                    }
+                }
+                __m128 a, b, c;
+                interleave(r[0], r[1], r[2], a, b, c);
+                float *dst = reinterpret_cast<float *>(out + i);
+                _mm_storeu_ps(dst, a);
+                _mm_storeu_ps(dst + 4, b);
+                _mm_storeu_ps(dst + 8, c);
+            }
+            for (; i < count; ++i)
+            {
+                out[i] = transform_one<Point>(m, in[i]);
+            }
+        }
+
+        void transform4_sse(const Float4x4 &m, const Float4 *in, Float4 *out, std::size_t count) noexcept
+        {
+            const __m128 r0 = _mm_loadu_ps(m.m[0]);
+            const __m128 r1 = _mm_loadu_ps(m.m[1]);
+            const __m128 r2 = _mm_loadu_ps(m.m[2]);
+            const __m128 r3 = _mm_loadu_ps(m.m[3]);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const __m128 v = _mm_loadu_ps(&in[i].x);
+                __m128 r = _mm_mul_ps(_mm_shuffle_ps(v, v, 0x00), r0);
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0x55), r1));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xAA), r2));
+                r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(v, v, 0xFF), r3));
+                _mm_storeu_ps(&out[i].x, r);
+            }
+        }
+
+#ifdef DMK_HAS_AVX2
+        template <int I0, int I1, int I2, int I3> DMK_AVX2_TARGET __m256 pick256(__m256 p, __m256 q) noexcept
+        {
+            return _mm256_shuffle_ps(p, q, _MM_SHUFFLE(I3, I2, I1, I0));
+        }
+
+        // Eight points as two four-point blocks, block A in the low lanes and block B in the high ones. The in-lane
+        // 256-bit shuffles then run the SSE deinterleave on both blocks at once.
+        template <bool Point>
+        DMK_AVX2_TARGET void transform3_avx(const Float4x4 &m, const Float3 *in, Float3 *out,
+                                            std::size_t count) noexcept
+        {
+            __m256 col[3][4];
+            for (int j = 0; j < 3; ++j)
+            {
+                for (int k = 0; k < 4; ++k)
+                {
+                    col[j][k] = _mm256_set1_ps(m.m[k][j]);
+                }
+            }
+
+            std::size_t i = 0;
+            for (; i + 8 <= count; i += 8)
+            {
+                const float *src = reinterpret_cast<const float *>(in + i);
+                const __m256 l0 = _mm256_loadu_ps(src);
+                const __m256 l1 = _mm256_loadu_ps(src + 8);
+                const __m256 l2 = _mm256_loadu_ps(src + 16);
+                const __m256 a = _mm256_permute2f128_ps(l0, l1, 0x30);
+                const __m256 b = _mm256_permute2f128_ps(l0, l2, 0x21);
+                const __m256 c = _mm256_permute2f128_ps(l1, l2, 0x30);
+
+                const __m256 x = pick256<0, 3, 0, 2>(a, pick256<2, 2, 1, 1>(b, c));
+                const __m256 y = pick256<0, 2, 0, 2>(pick256<1, 1, 0, 0>(a, b), pick256<3, 3, 2, 2>(b, c));
+                const __m256 z = pick256<0, 2, 0, 2>(pick256<2, 2, 1, 1>(a, b), pick256<0, 0, 3, 3>(c, c));
+
+                __m256 r[3];
+                for (int j = 0; j < 3; ++j)
+                {
+                    r[j] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, col[j][0]), _mm256_mul_ps(y, col[j][1])),
+                                         _mm256_mul_ps(z, col[j][2]));
+                    if constexpr (Point)
+                    {
+                        r[j] = _mm256_add_ps(r[j], col[j][3]);
+                    }
+                }
+
+                const __m256 oa =
+                    pick256<0, 2, 0, 2>(pick256<0, 0, 0, 0>(r[0], r[1]), pick256<0, 0, 1, 1>(r[2], r[0]));
+                const __m256 ob =
+                    pick256<0, 2, 0, 2>(pick256<1, 1, 1, 1>(r[1], r[2]), pick256<2, 2, 2, 2>(r[0], r[1]));
+                const __m256 oc =
+                    pick256<0, 2, 0, 2>(pick256<2, 2, 3, 3>(r[2], r[0]), pick256<3, 3, 3, 3>(r[1], r[2]));
+                float *dst = reinterpret_cast<float *>(out + i);
+                _mm256_storeu_ps(dst, _mm256_permute2f128_ps(oa, ob, 0x20));
+                _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(oc, oa, 0x30));
+                _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(ob, oc, 0x31));
+            }
+            transform3_sse<Point>(m, in + i, out + i, count - i);
+        }
+
+        // Two vectors per register; each lane pair broadcasts its own vector's components against the doubled rows.
+        DMK_AVX2_TARGET void transform4_avx(const Float4x4 &m, const Float4 *in, Float4 *out,
+                                            std::size_t count) noexcept
+        {
+            const __m256 r0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m.m[0]));
+            const __m256 r1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m.m[1]));
+            const __m256 r2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m.m[2]));
+            const __m256 r3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(m.m[3]));
+            std::size_t i = 0;
+            for (; i + 2 <= count; i += 2)
+            {
+                const __m256 v = _mm256_loadu_ps(&in[i].x);
+                __m256 r = _mm256_mul_ps(_mm256_permute_ps(v, 0x00), r0);
+                r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(v, 0x55), r1));
+                r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(v, 0xAA), r2));
+                r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(v, 0xFF), r3));
+                _mm256_storeu_ps(&out[i].x, r);
+            }
+            transform4_sse(m, in + i, out + i, count - i);
+        }
+#endif
+
+        template <bool Point>
+        std::size_t transform3(const Float4x4 &m, std::span<const Float3> in, std::span<Float3> out) noexcept
+        {
+            const std::size_t count = std::min(in.size(), out.size());
+#ifdef DMK_HAS_AVX2
+            if (scan::active_simd_level() >= scan::SimdLevel::Avx2)
+            {
+                transform3_avx<Point>(m, in.data(), out.data(), count);
+                return count;
+            }
+#endif
+            transform3_sse<Point>(m, in.data(), out.data(), count);
+            return count;
+        }
+    } // namespace
+
+    std::size_t math::transform_points(const Float4x4 &m, std::span<const Float3> in, std::span<Float3> out) noexcept
+    {
+        return transform3<true>(m, in, out);
+    }
+
+    std::size_t math::transform_vectors(const Float4x4 &m, std::span<const Float3> in, std::span<Float3> out) noexcept
+    {
+        return transform3<false>(m, in, out);
+    }
+
+    std::size_t math::transform(const Float4x4 &m, std::span<const Float4> in, std::span<Float4> out) noexcept
+    {
+        const std::size_t count = std::min(in.size(), out.size());
+#ifdef DMK_HAS_AVX2
+        if (scan::active_simd_level() >= scan::SimdLevel::Avx2)
+        {
+            transform4_avx(m, in.data(), out.data(), count);
+            return count;
+        }
+#endif
+        transform4_sse(m, in.data(), out.data(), count);
+        return count;
+    }
+
+    std::size_t math::rotate(const Quat &q, std::span<const Float3> in, std::span<Float3> out) noexcept
+    {
+        return transform_vectors(rotation(q), in, out);
+    }
+} // namespace DetourModKit
@@ -1,6 +1,7 @@
 /**
  * @file memory_access.cpp
- * @brief Public faces of the guarded access surface: read_into, write_bytes, and the pointer-chain walk.
+ * @brief Public faces of the guarded access surface: read_into, read_many, the prefetch hints, write_bytes, and the
+ *        pointer-chain walks (memory::walk, memory::walk_many and memory::CompiledChain).
  *
  * These translation units hold no Structured Exception Handling and touch no Win32 directly: they validate arguments in
  * the v4 value vocabulary (Address / Region / Result / Error), call the SEH-confined engine in memory_guarded.cpp, and
@@ -12,10 +13,16 @@
 
 #include "internal/memory_guarded.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <new>
 #include <span>
 
+#include <xmmintrin.h>
+
 namespace DetourModKit
 {
     namespace memory
@@ -33,6 +40,37 @@ namespace DetourModKit
             return {};
         }
 
+        Result<std::size_t> read_many(std::span<const ReadDescriptor> reads, std::span<std::uint8_t> ok) noexcept
+        {
+            if (ok.size() < reads.size())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "memory::read_many"});
+            }
+            return detail::guarded_read_many(reads.data(), reads.size(), ok.data());
+        }
+
+        void prefetch(std::span<const Address> addresses, std::ptrdiff_t offset) noexcept
+        {
+            for (const Address address : addresses)
+            {
+                if (address)
+                {
+                    _mm_prefetch(address.offset(offset).as<const char *>(), _MM_HINT_T0);
+                }
+            }
+        }
+
+        void prefetch_strided(Address base, std::size_t count, std::size_t stride) noexcept
+        {
+            constexpr std::size_t cache_line = 64;
+            const std::size_t step = stride < cache_line ? cache_line : stride;
+            const std::uintptr_t end = base.raw() + count * stride;
+            for (std::uintptr_t at = base.raw(); at < end; at += step)
+            {
+                _mm_prefetch(reinterpret_cast<const char *>(at), _MM_HINT_T0);
+            }
+        }
+
         Result<void> write_bytes(Address address, std::span<const std::byte> source) noexcept
         {
             // Validation order: a null target outranks a null source, and a zero-length write is a success no-op that
@@ -167,5 +205,185 @@ namespace DetourModKit
             }
             return walk(base, std::span<const ChainStep>{steps.data(), offsets.size()}, trace);
         }
+
+        Result<std::size_t> walk_many(std::span<const Address> bases, std::span<const ChainStep> steps,
+                                      std::span<Result<Address>> out) noexcept
+        {
+            if (out.size() < bases.size())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "memory::walk_many"});
+            }
+
+            std::size_t resolved = 0;
+            // Per group: the running address of each root still walking, its slot in bases / out, the link each
+            // hop's read_many lands in, and the read_many status.
+            std::array<std::uintptr_t, WALK_MANY_GROUP> cursor{};
+            std::array<std::size_t, WALK_MANY_GROUP> slot{};
+            std::array<std::uintptr_t, WALK_MANY_GROUP> link{};
+            std::array<Address, WALK_MANY_GROUP> link_address{};
+            std::array<ReadDescriptor, WALK_MANY_GROUP> reads{};
+            std::array<std::uint8_t, WALK_MANY_GROUP> ok{};
+
+            for (std::size_t first = 0; first < bases.size(); first += WALK_MANY_GROUP)
+            {
+                const std::size_t group = std::min(WALK_MANY_GROUP, bases.size() - first);
+                std::size_t live = 0;
+                for (std::size_t i = 0; i < group; ++i)
+                {
+                    const Address base = bases[first + i];
+                    if (!base && !steps.empty())
+                    {
+                        out[first + i] = std::unexpected(Error{ErrorCode::NullChain, "memory::walk_many", 0, 0});
+                        continue;
+                    }
+                    cursor[live] = base.raw();
+                    slot[live] = first + i;
+                    ++live;
+                }
+
+                for (std::size_t hop = 0; hop + 1 < steps.size() && live != 0; ++hop)
+                {
+                    const ChainStep &step = steps[hop];
+                    for (std::size_t i = 0; i < live; ++i)
+                    {
+                        link_address[i] = Address{cursor[i] + static_cast<std::uintptr_t>(step.offset)};
+                        reads[i] = ReadDescriptor{link_address[i], std::as_writable_bytes(std::span(&link[i], 1))};
+                    }
+                    // Every link of the hop is independent of the others, so their misses can overlap: hint them all
+                    // before the copies start, then take the copies under one guard entry.
+                    prefetch(std::span<const Address>(link_address.data(), live));
+                    (void)detail::guarded_read_many(reads.data(), live, ok.data());
+
+                    // Survivors are compacted to the front in order, so the next hop reads only the roots still live.
+                    std::size_t kept = 0;
+                    for (std::size_t i = 0; i < live; ++i)
+                    {
+                        if (ok[i] == 0 || link[i] < step.min_valid.raw() || link[i] >= USERSPACE_PTR_MAX)
+                        {
+                            out[slot[i]] = std::unexpected(Error{ErrorCode::ReadFaulted, "memory::walk_many", hop, 0});
+                            continue;
+                        }
+                        cursor[kept] = link[i];
+                        slot[kept] = slot[i];
+                        ++kept;
+                    }
+                    live = kept;
+                }
+
+                const std::ptrdiff_t leaf_offset = steps.empty() ? 0 : steps.back().offset;
+                for (std::size_t i = 0; i < live; ++i)
+                {
+                    out[slot[i]] = Address{cursor[i] + static_cast<std::uintptr_t>(leaf_offset)};
+                }
+                resolved += live;
+            }
+            return resolved;
+        }
+
+        namespace
+        {
+            [[nodiscard]] std::uint64_t steady_now_ns() noexcept
+            {
+                return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                                      std::chrono::steady_clock::now().time_since_epoch())
+                                                      .count());
+            }
+        } // namespace
+
+        Result<CompiledChain> CompiledChain::make(Address base, std::span<const ChainStep> steps,
+                                                  std::size_t stable_hops, unsigned int revalidate_ms) noexcept
+        {
+            if (!base && !steps.empty())
+            {
+                return std::unexpected(Error{ErrorCode::NullChain, "memory::CompiledChain::make", 0, 0});
+            }
+            // The final step is added, never dereferenced, so it has no link to memoize: at least one step must stay
+            // in the tail whenever any hop is marked stable.
+            if (stable_hops != 0 && stable_hops >= steps.size())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "memory::CompiledChain::make", stable_hops,
+                                             static_cast<std::uint32_t>(steps.size())});
+            }
+
+            CompiledChain chain;
+            try
+            {
+                chain.m_steps.assign(steps.begin(), steps.end());
+                chain.m_memo.resize(stable_hops);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::CompiledChain::make"});
+            }
+            chain.m_base = base;
+            chain.m_stable_hops = stable_hops;
+            chain.m_revalidate_ns = static_cast<std::uint64_t>(revalidate_ms) * 1'000'000ULL;
+            return chain;
+        }
+
+        Result<void> CompiledChain::refresh() noexcept
+        {
+            m_memo_valid = false;
+            // Walking one step past the stable prefix makes the engine dereference exactly the stable hops; the extra
+            // step's leaf falls outside the trace capacity, so only the memoized links are written.
+            const std::uint64_t generation = detail::protection_cache_generation();
+            const detail::ChainWalkOutcome outcome = detail::guarded_resolve_chain(
+                m_base, m_steps.data(), m_stable_hops + 1, m_memo.data(), m_stable_hops);
+            if (!outcome.ok)
+            {
+                return std::unexpected(
+                    Error{ErrorCode::ReadFaulted, "memory::CompiledChain::walk", outcome.fail_index, 0});
+            }
+            m_memo_time_ns = steady_now_ns();
+            m_memo_generation = generation;
+            m_memo_valid = true;
+            return {};
+        }
+
+        Result<Address> CompiledChain::walk(std::span<Address> trace) noexcept
+        {
+            if (m_stable_hops == 0)
+            {
+                return memory::walk(m_base, m_steps, trace);
+            }
+
+            bool refreshed = false;
+            if (!m_memo_valid || m_memo_generation != detail::protection_cache_generation() ||
+                steady_now_ns() - m_memo_time_ns >= m_revalidate_ns)
+            {
+                if (Result<void> fresh = refresh(); !fresh)
+                {
+                    return std::unexpected(fresh.error());
+                }
+                refreshed = true;
+            }
+
+            Address *const tail_trace = trace.size() > m_stable_hops ? trace.data() + m_stable_hops : nullptr;
+            const std::size_t tail_cap = trace.size() > m_stable_hops ? trace.size() - m_stable_hops : 0;
+            detail::ChainWalkOutcome outcome =
+                detail::guarded_resolve_chain(m_memo.back(), m_steps.data() + m_stable_hops,
+                                              m_steps.size() - m_stable_hops, tail_trace, tail_cap);
+            if (!outcome.ok && !refreshed)
+            {
+                // A memo that was fresh by the clock can still be stale by the game: a rebuilt object leaves the old
+                // link dangling. Re-read the stable hops once before reporting the tail failure.
+                if (Result<void> fresh = refresh(); !fresh)
+                {
+                    return std::unexpected(fresh.error());
+                }
+                outcome = detail::guarded_resolve_chain(m_memo.back(), m_steps.data() + m_stable_hops,
+                                                        m_steps.size() - m_stable_hops, tail_trace, tail_cap);
+            }
+            for (std::size_t i = 0; i < m_stable_hops && i < trace.size(); ++i)
+            {
+                trace[i] = m_memo[i];
+            }
+            if (!outcome.ok)
+            {
+                return std::unexpected(Error{ErrorCode::ReadFaulted, "memory::CompiledChain::walk",
+                                             m_stable_hops + outcome.fail_index, 0});
+            }
+            return outcome.address;
+        }
     } // namespace memory
 } // namespace DetourModKit
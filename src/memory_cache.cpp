@@ -6,16 +6,25 @@
  * / stats / invalidate). The cache uses sharded SRW locks for high-concurrency read-heavy access, a monotonic-counter
  * LRU map for O(log n) eviction, in-flight query coalescing to prevent VirtualQuery stampedes, on-demand cleanup to
  * keep the miss path clean, and epoch-based reader tracking so shutdown can drain readers before freeing shard storage.
+ * Regions a probe finds unmapped or unreadable skip the shards for a short-lived, lock-free negative table.
+ * In adaptive mode the cleanup task also grows the shard array on lock contention, through the same reader drain, and
+ * the per-shard capacity on eviction churn.
+ * A per-thread L0 and a process-wide fast table of generation-retired seqlock slots sit in front of the shards, so
+ * repeat hits never touch a lock.
  * This TU touches no Structured Exception Handling; on MinGW it drives the guarded-engine vectored-handler lifecycle
  * through the engine seam so a guarded read never has to fall back to a per-call VirtualQuery.
  */
 
 #include "DetourModKit/memory.hpp"
-#include "DetourModKit/diagnostics.hpp"
 #include "DetourModKit/logger.hpp"
+#include "DetourModKit/profiler.hpp"
 #include "internal/srw_shared_mutex.hpp"
 #include "platform.hpp"
 #include "internal/memory_guarded.hpp"
+#include "internal/background_service.hpp"
+#include "internal/shared_services.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "internal/thunk_cache.hpp"
 
 #include <windows.h>
 
@@ -23,7 +32,6 @@
 #include <array>
 #include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
@@ -32,7 +40,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <span>
 #include <sstream>
 #include <string>
 #include <thread>
@@ -43,9 +53,7 @@ namespace DetourModKit
 {
     namespace memory
     {
-        using DetourModKit::detail::acquire_module_ref;
         using DetourModKit::detail::is_loader_lock_held;
-        using DetourModKit::detail::release_module_ref;
         using DetourModKit::detail::SrwSharedMutex;
 
         namespace
@@ -65,6 +73,9 @@ namespace DetourModKit
             /**
              * @struct CachedMemoryRegionInfo
              * @brief Cached protection snapshot for one VirtualQuery region, with an LRU key and validity timestamp.
+             * @details pin_generation is non-zero for a region exempt from the expiry (see pinned_region): the
+             *          s_fast_generation value loaded before the VirtualQuery that produced it. The exemption holds
+             *          only while that generation is current, so any invalidation returns the entry to the expiry.
              */
             struct CachedMemoryRegionInfo
             {
@@ -72,13 +83,15 @@ namespace DetourModKit
                 std::size_t region_size;
                 DWORD protection;
                 DWORD state;
+                DWORD type;
                 std::uint64_t timestamp_ns;
                 std::uint64_t lru_key;
+                std::uint64_t pin_generation;
                 bool valid;
 
                 CachedMemoryRegionInfo()
-                    : base_address(0), region_size(0), protection(0), state(0), timestamp_ns(0), lru_key(0),
-                      valid(false)
+                    : base_address(0), region_size(0), protection(0), state(0), type(0), timestamp_ns(0), lru_key(0),
+                      pin_generation(0), valid(false)
                 {
                 }
             };
@@ -94,8 +107,8 @@ namespace DetourModKit
              *          (`sorted_ranges`) gives the O(log n) containment lookup for an address anywhere inside a larger
              *          cached region. The per-shard SRW lock and the in_flight stampede-coalescing flag are inline and
              *          the struct is cache-line aligned, so one shard's lock word never shares a line with another's.
-             *          Inlining the mutex makes the shard non-movable, so the shards are a fixed-size array allocated
-             *          once, never a resizable vector.
+             *          Inlining the mutex makes the shard non-movable, so the shards are a fixed-size array, never a
+             *          resizable vector; an adaptive cache grows by swapping in a larger array (see grow_shards).
              */
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -122,6 +135,13 @@ namespace DetourModKit
                 // get_memory_stats sums them across shards under the same reader guard it uses for the entry totals.
                 std::atomic<std::uint64_t> hits{0};
                 std::atomic<std::uint64_t> misses{0};
+                // The subset of hits served by a pinned entry already past the expiry: lookups a pure TTL cache would
+                // have sent back to VirtualQuery.
+                std::atomic<std::uint64_t> pinned_hits{0};
+                // Lock acquisitions whose first try-acquire failed, and entries evicted to make room: the contention
+                // and churn signals an adaptive cache grows on (see adapt_cache_configuration).
+                std::atomic<std::uint64_t> contended{0};
+                std::atomic<std::uint64_t> evictions{0};
                 std::uint64_t entry_counter{0};
                 std::size_t capacity;
                 std::size_t max_capacity;
@@ -156,13 +176,61 @@ namespace DetourModKit
                 return (static_cast<std::size_t>((address * 0x9E3779B97F4A7C15ULL) >> 48)) % shard_count;
             }
 
-            // Fixed-size shard array, allocated once by perform_cache_initialization and never resized: CacheShard owns
-            // its SrwSharedMutex and in_flight atomic inline and so is non-movable. null until init, reset on shutdown.
+            /// Takes @p shard's lock shared, counting a failed first try-acquire as contention.
+            [[nodiscard]] std::shared_lock<SrwSharedMutex> lock_shard_shared(CacheShard &shard) noexcept
+            {
+                std::shared_lock<SrwSharedMutex> lock(shard.mtx, std::try_to_lock);
+                if (!lock.owns_lock())
+                {
+                    shard.contended.fetch_add(1, std::memory_order_relaxed);
+                    lock.lock();
+                }
+                return lock;
+            }
+
+            /// Takes @p shard's lock exclusive, counting a failed first try-acquire as contention.
+            [[nodiscard]] std::unique_lock<SrwSharedMutex> lock_shard_exclusive(CacheShard &shard) noexcept
+            {
+                std::unique_lock<SrwSharedMutex> lock(shard.mtx, std::try_to_lock);
+                if (!lock.owns_lock())
+                {
+                    shard.contended.fetch_add(1, std::memory_order_relaxed);
+                    lock.lock();
+                }
+                return lock;
+            }
+
+            // Fixed-size shard array: CacheShard owns its SrwSharedMutex and in_flight atomic inline and so is
+            // non-movable. Allocated by perform_cache_initialization, replaced whole by an adaptive grow_shards, null
+            // until init and reset on shutdown. Both replacements first publish s_shard_count = 0 and drain the reader
+            // epoch, so every guarded reader loads the count seq_cst: that load, after its seq_cst stripe increment,
+            // is what the drain's stripe sum pairs with.
             std::unique_ptr<CacheShard[]> s_cache_shards;
             std::atomic<std::size_t> s_shard_count{0};
             std::atomic<std::size_t> s_max_entries_per_shard{0};
             std::atomic<unsigned int> s_configured_expiry_ms{0};
             std::atomic<bool> s_cache_initialized{false};
+            // Set while the loaded-module table's loader notification is subscribed. Only then does an unload reach
+            // invalidate_range, so only then may an image region outlive the expiry; otherwise every entry keeps it.
+            std::atomic<bool> s_pin_image_regions{false};
+
+#ifdef DMK_ENABLE_PROFILING
+            // Entries across every shard, for the "memory_cache_entries" counter track. Each shard's mutations add the
+            // change they made to its size under its exclusive lock, so no reader sums the shards.
+            std::atomic<std::int64_t> s_profiled_entries{0};
+#endif
+
+            /// Adds @p delta to the entry total and records it on the counter track; a no-op without profiling.
+            inline void profile_entry_count_change([[maybe_unused]] std::int64_t delta) noexcept
+            {
+#ifdef DMK_ENABLE_PROFILING
+                if (delta != 0)
+                {
+                    DMK_PROFILE_COUNTER("memory_cache_entries",
+                                        s_profiled_entries.fetch_add(delta, std::memory_order_relaxed) + delta);
+                }
+#endif
+            }
 
             /// Configured cache-entry expiry converted from milliseconds to nanoseconds.
             [[nodiscard]] inline std::uint64_t configured_expiry_ns() noexcept
@@ -175,6 +243,209 @@ namespace DetourModKit
             // cleared.
             std::mutex s_cache_state_mutex;
 
+            // Lock-free region snapshots. A hit in the sharded cache still takes the shard's SRW lock in shared mode,
+            // and acquiring it is an interlocked write to the lock word every reader of that shard shares, so a hot
+            // is_readable loop on many threads bounces that line even though nothing is contended logically. Two
+            // layers of seqlock slots sit in front of the shards and answer repeat hits without any lock: a tiny
+            // per-thread L0 on the reader's own stripe (see ReaderStripe), then a process-wide, page-hashed fast table.
+            // A reader only loads from a slot and re-checks its sequence, so a hit writes nothing but the reader's own
+            // stripe. Slots are (re)published from the locked paths -- a shard hit or a fresh VirtualQuery -- and a
+            // miss, a torn read, or a slot a writer holds simply falls through to the shard path. Staleness is bounded
+            // exactly as in the shards: each slot carries its entry timestamp for the expiry check, and
+            // s_fast_generation is bumped after every invalidation, clear, and shutdown, which retires every slot of
+            // both layers at once without touching them. A publisher captures the generation before it reads the
+            // shard or the OS, so a snapshot taken before an invalidation can never be published as current after it.
+            // Both layers are static storage and never freed, so a reader racing shutdown_cache reads a retired slot
+            // rather than freed memory.
+#if defined(_MSC_VER)
+#pragma warning(push)
+// C4324: FastSlot is intentionally padded to a full cache line by alignas(64) so a publish never tears a neighbour.
+#pragma warning(disable : 4324)
+#endif
+            struct alignas(64) FastSlot
+            {
+                // Odd while a publisher is writing the fields below; readers retry through the shard path instead.
+                std::atomic<std::uint32_t> sequence{0};
+                std::atomic<std::uintptr_t> base{0};
+                std::atomic<std::uintptr_t> end{0};
+                // Protection in the low 32 bits, state in the high 31, and PINNED_SNAPSHOT_BIT on top, so one load
+                // carries all three (MEM_* state values never reach bit 31).
+                std::atomic<std::uint64_t> protection_state{0};
+                std::atomic<std::uint64_t> timestamp_ns{0};
+                std::atomic<std::uint64_t> generation{0};
+            };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+            // Starts above the slots' zero so an untouched slot is never current.
+            alignas(64) std::atomic<std::uint64_t> s_fast_generation{1};
+
+            /// Retires every published snapshot slot, the shared region table's, and the cached thunk destinations.
+            inline void retire_fast_slots() noexcept
+            {
+                s_fast_generation.fetch_add(1, std::memory_order_acq_rel);
+                detail::shared_region_invalidate();
+                detail::invalidate_thunk_targets();
+            }
+
+            /// Marks a slot whose snapshot is pinned: exempt from the expiry check, still retired by a generation bump.
+            constexpr std::uint64_t PINNED_SNAPSHOT_BIT = std::uint64_t{1} << 63;
+
+            /// One region's protection snapshot as a slot stores it, plus whether it is pinned past the expiry.
+            struct RegionSnapshot
+            {
+                std::uintptr_t base;
+                std::uintptr_t end;
+                DWORD protection;
+                DWORD state;
+                std::uint64_t timestamp_ns;
+                bool pinned;
+            };
+
+            /// The snapshot of a region of @p region_size bytes at @p base, or nullopt when its end wraps.
+            [[nodiscard]] constexpr std::optional<RegionSnapshot> snapshot_of(std::uintptr_t base,
+                                                                              std::size_t region_size,
+                                                                              DWORD protection, DWORD state,
+                                                                              std::uint64_t timestamp_ns,
+                                                                              bool pinned) noexcept
+            {
+                const std::uintptr_t end = base + region_size;
+                if (end < base)
+                    return std::nullopt;
+                return RegionSnapshot{base, end, protection, state, timestamp_ns, pinned};
+            }
+
+            /**
+             * @brief True when VirtualQuery's @p mbi describes a region cached until invalidated, not for the expiry.
+             * @details Committed image pages the process cannot write -- code and read-only data -- only change through
+             *          a VirtualProtect, which DMK's own write paths follow with invalidate_range, or an unload, which
+             *          the loader notification turns into one. Re-querying them every expiry window is the bulk of a
+             *          steady-state hook workload's misses. Writable image pages (.data, patched code) keep the
+             *          expiry, as does everything while s_pin_image_regions is clear.
+             */
+            [[nodiscard]] inline bool pinned_region(const MEMORY_BASIC_INFORMATION &mbi) noexcept
+            {
+                return s_pin_image_regions.load(std::memory_order_acquire) && mbi.Type == MEM_IMAGE &&
+                       mbi.State == MEM_COMMIT && (mbi.Protect & CachePermissions::WRITE_PERMISSION_FLAGS) == 0;
+            }
+
+            /**
+             * @brief VirtualQuery, answered from the shared region table when another instance already queried a
+             *        pinned region (see services.hpp).
+             * @details Only while pinning is on: the shared table holds nothing else, so a lookup otherwise only costs.
+             *          A pinned region this query produced is published for the others.
+             */
+            [[nodiscard]] bool query_region(LPCVOID address, MEMORY_BASIC_INFORMATION &mbi) noexcept
+            {
+                if (!s_pin_image_regions.load(std::memory_order_acquire))
+                    return VirtualQuery(address, &mbi, sizeof(mbi)) != 0;
+
+                const auto addr_val = reinterpret_cast<std::uintptr_t>(address);
+                if (const std::optional<detail::SharedRegion> shared = detail::shared_region_lookup(addr_val))
+                {
+                    mbi = MEMORY_BASIC_INFORMATION{};
+                    mbi.BaseAddress = reinterpret_cast<PVOID>(shared->base);
+                    mbi.RegionSize = shared->size;
+                    mbi.Protect = shared->protection;
+                    mbi.State = shared->state;
+                    mbi.Type = shared->type;
+                    return true;
+                }
+                const std::uint64_t epoch = detail::shared_region_epoch();
+                if (VirtualQuery(address, &mbi, sizeof(mbi)) == 0)
+                    return false;
+                if (pinned_region(mbi))
+                {
+                    detail::SharedRegion region;
+                    region.base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+                    region.size = mbi.RegionSize;
+                    region.protection = static_cast<std::uint32_t>(mbi.Protect);
+                    region.state = static_cast<std::uint32_t>(mbi.State);
+                    region.type = static_cast<std::uint32_t>(mbi.Type);
+                    detail::shared_region_publish(addr_val, region, epoch);
+                }
+                return true;
+            }
+
+            /// True when @p entry is pinned and no invalidation has landed since the query that produced it.
+            [[nodiscard]] inline bool entry_pinned(const CachedMemoryRegionInfo &entry) noexcept
+            {
+                return entry.pin_generation != 0 &&
+                       entry.pin_generation == s_fast_generation.load(std::memory_order_acquire);
+            }
+
+            /// True when @p entry is past the expiry that applies to it; a current pinned entry never is.
+            [[nodiscard]] inline bool entry_expired(const CachedMemoryRegionInfo &entry, std::uint64_t current_ns,
+                                                    std::uint64_t expiry_ns) noexcept
+            {
+                return current_ns - entry.timestamp_ns > expiry_ns && !entry_pinned(entry);
+            }
+
+            /**
+             * @brief Reads @p slot without writing it and returns its snapshot when it covers [address, query_end).
+             * @return nullopt when the slot is empty, being written, torn, retired by a generation bump, expired, or
+             *         does not cover the whole range.
+             */
+            [[nodiscard]] std::optional<RegionSnapshot> read_slot(const FastSlot &slot, std::uintptr_t address,
+                                                                  std::uintptr_t query_end, std::uint64_t now_ns,
+                                                                  std::uint64_t expiry_ns,
+                                                                  std::uint64_t generation) noexcept
+            {
+                const std::uint32_t before = slot.sequence.load(std::memory_order_acquire);
+                if ((before & 1u) != 0)
+                    return std::nullopt;
+
+                const std::uintptr_t base = slot.base.load(std::memory_order_relaxed);
+                const std::uintptr_t end = slot.end.load(std::memory_order_relaxed);
+                const std::uint64_t protection_state = slot.protection_state.load(std::memory_order_relaxed);
+                const std::uint64_t timestamp_ns = slot.timestamp_ns.load(std::memory_order_relaxed);
+                const std::uint64_t slot_generation = slot.generation.load(std::memory_order_relaxed);
+
+                // Seqlock read side: the acquire fence orders the field loads above before the re-check, so an
+                // unchanged even sequence proves they came from one publish.
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.sequence.load(std::memory_order_relaxed) != before)
+                    return std::nullopt;
+
+                const bool pinned = (protection_state & PINNED_SNAPSHOT_BIT) != 0;
+                if (slot_generation != generation || (!pinned && now_ns - timestamp_ns > expiry_ns))
+                    return std::nullopt;
+                if (address < base || query_end > end)
+                    return std::nullopt;
+
+                return RegionSnapshot{base, end, static_cast<DWORD>(protection_state),
+                                      static_cast<DWORD>((protection_state & ~PINNED_SNAPSHOT_BIT) >> 32), timestamp_ns,
+                                      pinned};
+            }
+
+            /**
+             * @brief Publishes @p snapshot into @p slot, tagged with @p generation.
+             * @param generation The s_fast_generation value loaded before the snapshot was read from the shard or OS.
+             * @details Best-effort: when another publisher holds the slot the snapshot is dropped, since the shard
+             *          path still holds it.
+             */
+            void write_slot(FastSlot &slot, const RegionSnapshot &snapshot, std::uint64_t generation) noexcept
+            {
+                std::uint32_t sequence = slot.sequence.load(std::memory_order_relaxed);
+                if ((sequence & 1u) != 0 ||
+                    !slot.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed))
+                    return;
+
+                // Seqlock write side: the release fence keeps the field stores below from becoming visible before
+                // the odd sequence, and the closing release store publishes them with the next even value.
+                std::atomic_thread_fence(std::memory_order_release);
+                slot.base.store(snapshot.base, std::memory_order_relaxed);
+                slot.end.store(snapshot.end, std::memory_order_relaxed);
+                slot.protection_state.store(static_cast<std::uint64_t>(snapshot.protection) |
+                                                (static_cast<std::uint64_t>(snapshot.state) << 32) |
+                                                (snapshot.pinned ? PINNED_SNAPSHOT_BIT : 0),
+                                            std::memory_order_relaxed);
+                slot.timestamp_ns.store(snapshot.timestamp_ns, std::memory_order_relaxed);
+                slot.generation.store(generation, std::memory_order_relaxed);
+                slot.sequence.store(sequence + 2, std::memory_order_release);
+            }
+
             // Epoch-based reader tracking to prevent use-after-free during shutdown. Readers increment on entry and
             // decrement on exit; shutdown waits for the count to reach zero before freeing data. The count is striped
             // across cache-line-padded counters rather than a single global atomic, so concurrent readers do not
@@ -187,9 +458,27 @@ namespace DetourModKit
 // C4324: ReaderStripe is intentionally padded to a full cache line by alignas(64) so stripes never share a line.
 #pragma warning(disable : 4324)
 #endif
+            // Entries in each stripe's L0. Hot callers check thousands of addresses inside a handful of heap regions
+            // per frame, so a few whole-region entries catch nearly all of them with a few compares.
+            constexpr std::size_t L0_ENTRY_COUNT = 4;
+
             struct alignas(64) ReaderStripe
             {
                 std::atomic<std::int32_t> count{0};
+                // Lock-free hits (L0 and fast table), tallied here because the reader already owns this line for the
+                // guard increment; get_memory_stats sums them into the hit count.
+                std::atomic<std::uint64_t> fast_hits{0};
+                // The subset of fast_hits served by a pinned snapshot already past the expiry.
+                std::atomic<std::uint64_t> pinned_hits{0};
+                // The subset of fast_hits served by the negative table.
+                std::atomic<std::uint64_t> negative_hits{0};
+                // Round-robin replacement cursor for l0.
+                std::atomic<std::uint32_t> l0_next{0};
+                // The per-thread L0: regions this stripe's thread validated recently. It lives on the stripe rather
+                // than in a thread_local because a readability check can run under loader lock, where MinGW's
+                // emutls first touch would allocate (see reader_stripe_index). Only the threads that hash onto this
+                // stripe touch it, normally one; the seqlock keeps a rare collision correct, just less effective.
+                std::array<FastSlot, L0_ENTRY_COUNT> l0{};
             };
 #if defined(_MSC_VER)
 #pragma warning(pop)
@@ -256,43 +545,45 @@ namespace DetourModKit
                 ActiveReaderGuard(const ActiveReaderGuard &) = delete;
                 ActiveReaderGuard &operator=(const ActiveReaderGuard &) = delete;
 
+                /// This reader's stripe, which also holds its L0.
+                [[nodiscard]] ReaderStripe &stripe() const noexcept { return s_reader_stripes[m_stripe]; }
+
+                /// Counts a hit served by the L0 or the fast table on this reader's own stripe.
+                void count_fast_hit(const RegionSnapshot &hit, std::uint64_t now_ns, std::uint64_t expiry_ns) noexcept
+                {
+                    s_reader_stripes[m_stripe].fast_hits.fetch_add(1, std::memory_order_relaxed);
+                    if (now_ns - hit.timestamp_ns > expiry_ns)
+                        s_reader_stripes[m_stripe].pinned_hits.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                /// Counts a hit served by the negative table on this reader's own stripe.
+                void count_negative_hit() noexcept
+                {
+                    s_reader_stripes[m_stripe].fast_hits.fetch_add(1, std::memory_order_relaxed);
+                    s_reader_stripes[m_stripe].negative_hits.fetch_add(1, std::memory_order_relaxed);
+                }
+
             private:
                 const std::size_t m_stripe;
             };
 
-            // Background cleanup thread. Uses std::thread (not jthread) because these are namespace-scope statics:
-            // jthread's auto-join destructor would run after s_cleanup_cv/s_cleanup_mutex are destroyed (reverse
-            // declaration order), causing UB. Manual join in shutdown_cache avoids this.
-            std::atomic<bool> s_cleanup_thread_running{false};
-            std::thread s_cleanup_thread;
-            // Counted reference on this module, taken before the cleanup thread is created while the module is fully
-            // mapped, so its code cannot be unmapped by a caller's FreeLibrary while it runs. Released after a clean
-            // join; leaked on the loader-lock detach path so the detached thread's code stays mapped.
-            HMODULE s_cleanup_self_ref{nullptr};
-            std::mutex s_cleanup_mutex;
-            std::condition_variable s_cleanup_cv;
-            std::atomic<bool> s_cleanup_requested{false};
-            // Serializes the join/detach decision so two concurrent shutdown_cache callers (an explicit teardown racing
-            // the atexit handler) cannot both pass s_cleanup_thread.joinable() and both join the same std::thread --
-            // the second join is a std::system_error thrown out of this noexcept function, terminating the host. The
-            // winner joins/detaches (which flips joinable() to false), and any loser that then takes this lock sees the
-            // thread already non-joinable and skips. Loader-lock teardown uses a try-lock variant so it never waits
-            // while a normal shutdown is already joining the thread; the cleanup thread's own exit may need the loader
-            // lock.
-            // The cleanup thread never takes this mutex, and it is released before s_cache_state_mutex, so it never
-            // nests with the state lock either.
-            std::mutex s_cleanup_join_mutex;
-
-            // On-demand cleanup fallback timer (used when the background thread is disabled).
+            // The periodic cleanup task on the shared background service, or NO_BACKGROUND_TASK when it could not be
+            // registered and cleanup runs on demand from the miss path instead. Set by init_cache under the state
+            // mutex; shutdown_cache exchanges it out so exactly one caller cancels it.
+            std::atomic<detail::BackgroundTaskId> s_cleanup_task{detail::NO_BACKGROUND_TASK};
+
+            // On-demand cleanup fallback timer (used when the background task is not registered).
             std::atomic<std::uint64_t> s_last_cleanup_time_ns{0};
-            constexpr std::uint64_t CLEANUP_INTERVAL_NS = 1'000'000'000ULL;
+            constexpr std::chrono::milliseconds CLEANUP_INTERVAL{1000};
+            constexpr std::uint64_t CLEANUP_INTERVAL_NS =
+                static_cast<std::uint64_t>(std::chrono::nanoseconds(CLEANUP_INTERVAL).count());
 
             // Process-global cache statistics for the COLD counters. The hot hit / miss tallies live per-shard in
             // CacheShard (summed at snapshot time), so a hot query bumps only the shard line it is already touching
             // rather than one process-global counter line. The counters here are bumped only off the read hot path --
-            // invalidations after a write, coalesced queries on a stampede, on-demand cleanups periodically -- so a
-            // single line is fine. Each is alignas(64) so the three never false-share with one another. Same rationale
-            // as CacheShard / ReaderStripe.
+            // invalidations after a write, coalesced queries on a stampede, on-demand cleanups and expiry evictions
+            // periodically -- so a single line is fine. Each is alignas(64) so they never false-share with one another.
+            // Same rationale as CacheShard / ReaderStripe.
 #if defined(_MSC_VER)
 #pragma warning(push)
 // C4324: each counter is intentionally padded to a full cache line by alignas(64) to prevent false sharing.
@@ -303,24 +594,115 @@ namespace DetourModKit
                 alignas(64) std::atomic<std::uint64_t> invalidations{0};
                 alignas(64) std::atomic<std::uint64_t> coalesced_queries{0};
                 alignas(64) std::atomic<std::uint64_t> on_demand_cleanups{0};
+                alignas(64) std::atomic<std::uint64_t> expired_entries{0};
+                alignas(64) std::atomic<std::uint64_t> shard_growths{0};
+                alignas(64) std::atomic<std::uint64_t> capacity_growths{0};
             };
 #if defined(_MSC_VER)
 #pragma warning(pop)
 #endif
             CacheStats s_stats;
 
+            // The per-shard tallies of a shard array an adaptive grow_shards replaced, folded in before it was freed so
+            // the reported totals never step back. Written only by grow_shards after the reader drain, and read under
+            // the reader guard like the shard tallies themselves.
+            struct RetiredShardCounters
+            {
+                std::atomic<std::uint64_t> hits{0};
+                std::atomic<std::uint64_t> misses{0};
+                std::atomic<std::uint64_t> pinned_hits{0};
+                std::atomic<std::uint64_t> contended{0};
+                std::atomic<std::uint64_t> evictions{0};
+
+                void reset() noexcept
+                {
+                    hits.store(0, std::memory_order_relaxed);
+                    misses.store(0, std::memory_order_relaxed);
+                    pinned_hits.store(0, std::memory_order_relaxed);
+                    contended.store(0, std::memory_order_relaxed);
+                    evictions.store(0, std::memory_order_relaxed);
+                }
+            };
+            RetiredShardCounters s_retired;
+
+            // The process-wide fast table: direct-mapped by page, shared by every thread, and consulted after a
+            // reader's own L0 misses.
+            constexpr std::size_t FAST_SLOT_BITS = 10;
+            constexpr std::size_t FAST_SLOT_COUNT = std::size_t{1} << FAST_SLOT_BITS;
+
+            std::array<FastSlot, FAST_SLOT_COUNT> s_fast_slots{};
+
+            /// The fast-table slot for the page holding @p address (golden-ratio mix of the page number).
+            [[nodiscard]] inline FastSlot &fast_slot_for(std::uintptr_t address) noexcept
+            {
+                const std::uint64_t mixed = static_cast<std::uint64_t>(address >> 12) * 0x9E3779B97F4A7C15ULL;
+                return s_fast_slots[static_cast<std::size_t>(mixed >> (64 - FAST_SLOT_BITS))];
+            }
+
+            /**
+             * @brief Answers [address, address + size) from @p stripe's L0, then the fast table, without a lock.
+             * @details A fast-table hit is copied into the L0, so the next check on the same region stays on the
+             *          reader's own stripe.
+             */
+            [[nodiscard]] std::optional<RegionSnapshot> fast_lookup(ReaderStripe &stripe, std::uintptr_t address,
+                                                                    std::size_t size, std::uint64_t now_ns,
+                                                                    std::uint64_t expiry_ns,
+                                                                    std::uint64_t generation) noexcept
+            {
+                const std::uintptr_t query_end = address + size;
+                if (query_end < address)
+                    return std::nullopt;
+
+                for (const FastSlot &entry : stripe.l0)
+                {
+                    if (std::optional<RegionSnapshot> hit =
+                            read_slot(entry, address, query_end, now_ns, expiry_ns, generation))
+                        return hit;
+                }
+
+                std::optional<RegionSnapshot> hit =
+                    read_slot(fast_slot_for(address), address, query_end, now_ns, expiry_ns, generation);
+                if (hit)
+                {
+                    const std::uint32_t next = stripe.l0_next.fetch_add(1, std::memory_order_relaxed);
+                    write_slot(stripe.l0[next % L0_ENTRY_COUNT], *hit, generation);
+                }
+                return hit;
+            }
+
+            /// Publishes a snapshot read under the shard lock or from the OS into @p stripe's L0 and the fast table.
+            void fast_publish(ReaderStripe &stripe, std::uintptr_t address,
+                              const std::optional<RegionSnapshot> &snapshot, std::uint64_t generation) noexcept
+            {
+                if (!snapshot)
+                    return;
+                write_slot(fast_slot_for(address), *snapshot, generation);
+                const std::uint32_t next = stripe.l0_next.fetch_add(1, std::memory_order_relaxed);
+                write_slot(stripe.l0[next % L0_ENTRY_COUNT], *snapshot, generation);
+            }
+
+            /// Zeroes the lock-free hit tallies alongside the per-shard counters.
+            inline void reset_fast_hits() noexcept
+            {
+                for (ReaderStripe &stripe : s_reader_stripes)
+                {
+                    stripe.fast_hits.store(0, std::memory_order_relaxed);
+                    stripe.pinned_hits.store(0, std::memory_order_relaxed);
+                    stripe.negative_hits.store(0, std::memory_order_relaxed);
+                }
+            }
+
             /**
-             * @brief Checks if a cache entry is valid and covers [address, address + size).
+             * @brief Checks if a cache entry is valid, unexpired, and covers [address, address + size).
              */
-            constexpr inline bool is_entry_valid_and_covers(const CachedMemoryRegionInfo &entry, std::uintptr_t address,
-                                                            std::size_t size, std::uint64_t current_ns,
-                                                            std::uint64_t expiry_ns) noexcept
+            inline bool is_entry_valid_and_covers(const CachedMemoryRegionInfo &entry, std::uintptr_t address,
+                                                  std::size_t size, std::uint64_t current_ns,
+                                                  std::uint64_t expiry_ns) noexcept
             {
                 if (!entry.valid)
                     return false;
 
-                const std::uint64_t entry_age = current_ns - entry.timestamp_ns;
-                if (entry_age > expiry_ns)
+                if (entry_expired(entry, current_ns, expiry_ns))
                     return false;
 
                 const std::uintptr_t end_address = address + size;
@@ -348,6 +730,54 @@ namespace DetourModKit
                        (protection & CachePermissions::NOACCESS_GUARD_FLAGS) == 0;
             }
 
+            // The negative table: regions a probe found free, reserved, or unreadable (PAGE_NOACCESS, a guard page,
+            // execute-only), with the exact bounds VirtualQuery reported. Such a region fails every permission check,
+            // so caching it in the shards would only spend capacity that committed regions earned; a stale-slot sweep
+            // over freed entities would flush them. Instead each lands in a direct-mapped seqlock slot keyed by the
+            // 64 KiB allocation granule of the probed address, read without a lock like the fast table and retired
+            // by the same s_fast_generation bump. The negative expiry is shorter than the shards', since an
+            // allocation DMK never sees can commit the range at any time; an allocation DMK makes, a DMK write, and a
+            // module load all invalidate it at once.
+            constexpr std::size_t NEGATIVE_SLOT_BITS = 8;
+            constexpr std::size_t NEGATIVE_SLOT_COUNT = std::size_t{1} << NEGATIVE_SLOT_BITS;
+
+            std::array<FastSlot, NEGATIVE_SLOT_COUNT> s_negative_slots{};
+            // 0 while the cache is down or when CacheOptions::negative_expiry_ms disables the table.
+            std::atomic<unsigned int> s_negative_expiry_ms{0};
+
+            /// The negative-table slot for the allocation granule holding @p address.
+            [[nodiscard]] inline FastSlot &negative_slot_for(std::uintptr_t address) noexcept
+            {
+                const std::uint64_t mixed = static_cast<std::uint64_t>(address >> 16) * 0x9E3779B97F4A7C15ULL;
+                return s_negative_slots[static_cast<std::size_t>(mixed >> (64 - NEGATIVE_SLOT_BITS))];
+            }
+
+            /// True when VirtualQuery's @p mbi describes a region no read or write check can pass.
+            [[nodiscard]] constexpr bool negative_region(const MEMORY_BASIC_INFORMATION &mbi) noexcept
+            {
+                return mbi.State != MEM_COMMIT || !check_read_permission(mbi.Protect);
+            }
+
+            /// The negative snapshot holding @p address, or nullopt when the table has none current.
+            [[nodiscard]] std::optional<RegionSnapshot> negative_lookup(std::uintptr_t address, std::uint64_t now_ns,
+                                                                        std::uint64_t generation) noexcept
+            {
+                const unsigned int expiry_ms = s_negative_expiry_ms.load(std::memory_order_relaxed);
+                if (expiry_ms == 0)
+                    return std::nullopt;
+                // Only the region holding the first byte matters: a span that starts in it fails whatever follows.
+                return read_slot(negative_slot_for(address), address, address + 1, now_ns,
+                                 static_cast<std::uint64_t>(expiry_ms) * 1'000'000ULL, generation);
+            }
+
+            /// Publishes a negative region read from the OS into the slot for @p address.
+            void negative_publish(std::uintptr_t address, const std::optional<RegionSnapshot> &snapshot,
+                                  std::uint64_t generation) noexcept
+            {
+                if (snapshot && s_negative_expiry_ms.load(std::memory_order_relaxed) != 0)
+                    write_slot(negative_slot_for(address), *snapshot, generation);
+            }
+
             /**
              * @brief Inserts a range into the shard's sorted auxiliary container.
              * @note Must be called with the shard mutex held (exclusive).
@@ -446,6 +876,7 @@ namespace DetourModKit
                 {
                     shard.entries.erase(entry_it);
                     remove_sorted_range(shard, oldest_base);
+                    shard.evictions.fetch_add(1, std::memory_order_relaxed);
                     return true;
                 }
                 return false;
@@ -465,11 +896,12 @@ namespace DetourModKit
 
             /**
              * @brief Updates or inserts a cache entry in a specific shard (the throwing body).
+             * @param pin_generation The entry's pin_generation: 0, or the generation loaded before the VirtualQuery.
              * @note Must be called with the shard mutex held (exclusive). Inserts unordered_map / map / deque nodes, so
              *       it can throw bad_alloc; the noexcept @ref update_shard_with_region wrapper fails soft on that.
              */
             void update_shard_with_region_impl(CacheShard &shard, const MEMORY_BASIC_INFORMATION &mbi,
-                                               std::uint64_t current_ns)
+                                               std::uint64_t current_ns, std::uint64_t pin_generation)
             {
                 const std::uintptr_t base_addr = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
 
@@ -494,8 +926,10 @@ namespace DetourModKit
                     old_entry.region_size = mbi.RegionSize;
                     old_entry.protection = mbi.Protect;
                     old_entry.state = mbi.State;
+                    old_entry.type = mbi.Type;
                     old_entry.timestamp_ns = current_ns;
                     old_entry.lru_key = new_lru_key;
+                    old_entry.pin_generation = pin_generation;
                     old_entry.valid = true;
 
                     shard.lru_index.emplace(new_lru_key, base_addr);
@@ -519,8 +953,10 @@ namespace DetourModKit
                     new_entry.region_size = mbi.RegionSize;
                     new_entry.protection = mbi.Protect;
                     new_entry.state = mbi.State;
+                    new_entry.type = mbi.Type;
                     new_entry.timestamp_ns = current_ns;
                     new_entry.lru_key = new_lru_key;
+                    new_entry.pin_generation = pin_generation;
                     new_entry.valid = true;
 
                     shard.entries.insert_or_assign(base_addr, new_entry);
@@ -544,19 +980,22 @@ namespace DetourModKit
              *          detail::cached_module_image_region.
              */
             void update_shard_with_region(CacheShard &shard, const MEMORY_BASIC_INFORMATION &mbi,
-                                          std::uint64_t current_ns) noexcept
+                                          std::uint64_t current_ns, std::uint64_t pin_generation) noexcept
             {
+                const std::size_t before = shard.entries.size();
                 try
                 {
-                    update_shard_with_region_impl(shard, mbi, current_ns);
+                    update_shard_with_region_impl(shard, mbi, current_ns, pin_generation);
                 }
                 catch (const std::bad_alloc &)
                 {
                 }
+                profile_entry_count_change(static_cast<std::int64_t>(shard.entries.size()) -
+                                           static_cast<std::int64_t>(before));
             }
 
             /**
-             * @brief Removes expired entries from a shard.
+             * @brief Removes expired entries from a shard; a current pinned entry is kept however old.
              * @note Must be called with the shard mutex held (exclusive).
              * @return Number of entries removed from this shard.
              */
@@ -568,10 +1007,12 @@ namespace DetourModKit
                 while (it != shard.entries.end())
                 {
                     const CachedMemoryRegionInfo &entry = it->second;
-                    const std::uint64_t entry_age = current_ns - entry.timestamp_ns;
+                    const bool expired = entry.valid && entry_expired(entry, current_ns, expiry_ns);
 
-                    if (!entry.valid || entry_age > expiry_ns)
+                    if (!entry.valid || expired)
                     {
+                        if (expired)
+                            s_stats.expired_entries.fetch_add(1, std::memory_order_relaxed);
                         const auto lru_it = shard.lru_index.find(entry.lru_key);
                         if (lru_it != shard.lru_index.end() && lru_it->second == it->first)
                         {
@@ -587,6 +1028,7 @@ namespace DetourModKit
                         ++it;
                     }
                 }
+                profile_entry_count_change(-static_cast<std::int64_t>(removed));
                 return removed;
             }
 
@@ -624,7 +1066,10 @@ namespace DetourModKit
                     if (shard_lock.owns_lock())
                     {
                         cleanup_expired_entries_in_shard(s_cache_shards[i], current_ts, expiry_ns);
+                        const std::size_t before_trim = s_cache_shards[i].entries.size();
                         trim_to_max_capacity(s_cache_shards[i]);
+                        profile_entry_count_change(static_cast<std::int64_t>(s_cache_shards[i].entries.size()) -
+                                                   static_cast<std::int64_t>(before_trim));
                     }
                 }
             }
@@ -656,39 +1101,14 @@ namespace DetourModKit
             }
 
             /**
-             * @brief Background cleanup thread body: removes expired entries periodically off the miss path.
-             */
-            void cleanup_thread_func() noexcept
-            {
-                while (s_cleanup_thread_running.load(std::memory_order_acquire))
-                {
-                    {
-                        std::unique_lock<std::mutex> lock(s_cleanup_mutex);
-                        s_cleanup_cv.wait_for(lock, std::chrono::seconds(1),
-                                              [&]()
-                                              {
-                                                  return s_cleanup_requested.load(std::memory_order_acquire) ||
-                                                         !s_cleanup_thread_running.load(std::memory_order_acquire);
-                                              });
-                    }
-
-                    if (!s_cleanup_thread_running.load(std::memory_order_acquire))
-                        break;
-
-                    cleanup_expired_entries(true);
-                    s_cleanup_requested.store(false, std::memory_order_relaxed);
-                }
-            }
-
-            /**
-             * @brief Signals the cleanup thread to run, or triggers on-demand cleanup when the thread is disabled.
+             * @brief Runs the cleanup task now, or triggers on-demand cleanup when the task is not registered.
              */
             void request_cleanup() noexcept
             {
-                if (s_cleanup_thread_running.load(std::memory_order_acquire))
+                const detail::BackgroundTaskId task = s_cleanup_task.load(std::memory_order_acquire);
+                if (task != detail::NO_BACKGROUND_TASK)
                 {
-                    s_cleanup_requested.store(true, std::memory_order_relaxed);
-                    s_cleanup_cv.notify_one();
+                    detail::wake_background_task(task);
                 }
                 else
                 {
@@ -696,71 +1116,6 @@ namespace DetourModKit
                 }
             }
 
-            /**
-             * @brief Detaches the cleanup thread under loader lock after the caller has claimed the join mutex.
-             */
-            void detach_cleanup_thread_under_loader_lock() noexcept
-            {
-                if (!s_cleanup_thread.joinable())
-                {
-                    return;
-                }
-
-                // Under loader lock (DllMain / FreeLibrary): a join would deadlock because the cleanup thread cannot
-                // exit while the loader lock is held. Detach it and leak the module reference taken at creation, so its
-                // code stays mapped for the rest of the process.
-                s_cleanup_thread.detach();
-                DetourModKit::diagnostics::record_intentional_leak(
-                    DetourModKit::diagnostics::LeakSubsystem::MemoryCache);
-            }
-
-            /**
-             * @brief Tries to claim and detach the cleanup thread without blocking under loader lock.
-             * @return true if this caller claimed the join mutex and observed the thread state; false if another
-             *         shutdown is already joining or detaching the thread.
-             */
-            bool try_detach_cleanup_thread_under_loader_lock() noexcept
-            {
-                std::unique_lock<std::mutex> join_lock(s_cleanup_join_mutex, std::try_to_lock);
-                if (!join_lock.owns_lock())
-                {
-                    // Do not wait under the loader lock. The owner is already handling the join/detach decision; after
-                    // this thread returns from detach, the cleanup thread can finish its own loader notifications and
-                    // let that owner complete.
-                    return false;
-                }
-
-                detach_cleanup_thread_under_loader_lock();
-                return true;
-            }
-
-            /**
-             * @brief Claims the cleanup thread's final join/detach action exactly once.
-             */
-            void finish_cleanup_thread() noexcept
-            {
-                if (is_loader_lock_held())
-                {
-                    (void)try_detach_cleanup_thread_under_loader_lock();
-                    return;
-                }
-
-                std::lock_guard<std::mutex> join_lock(s_cleanup_join_mutex);
-                if (!s_cleanup_thread.joinable())
-                {
-                    return;
-                }
-
-                s_cleanup_thread.join();
-                // Joined off the loader lock: drop the reference taken at creation. Another reference on the module
-                // still exists (the caller running this teardown), so this is never the terminal release.
-                if (s_cleanup_self_ref != nullptr)
-                {
-                    release_module_ref(s_cleanup_self_ref);
-                    s_cleanup_self_ref = nullptr;
-                }
-            }
-
             /**
              * @brief Evicts every entry in a shard whose region overlaps [address, end_address).
              * @note Must be called with the shard mutex held (exclusive).
@@ -802,6 +1157,7 @@ namespace DetourModKit
                         ++it;
                     }
                 }
+                profile_entry_count_change(-static_cast<std::int64_t>(evicted));
                 return evicted;
             }
 
@@ -814,7 +1170,7 @@ namespace DetourModKit
                     return;
 
                 const std::uintptr_t end_address = (address + size < address) ? UINTPTR_MAX : address + size;
-                const std::size_t shard_count = s_shard_count.load(std::memory_order_acquire);
+                const std::size_t shard_count = s_shard_count.load(std::memory_order_seq_cst);
 
                 constexpr std::size_t MAX_INVALIDATION_RETRIES = 3;
 
@@ -844,18 +1200,44 @@ namespace DetourModKit
                     }
                 }
 
+                // Retire the fast table only after the shards are swept: a reader that published a stale shard entry
+                // mid-sweep captured the pre-bump generation, so this bump retires that slot too.
+                retire_fast_slots();
+
                 if (skipped_shards > 0)
                 {
                     // A shard that stayed contended across every retry keeps its entries until the configured expiry
                     // sweeps them. Surface it for diagnosis instead of skipping silently; try_log keeps this noexcept
                     // path honest when the level is enabled.
-                    (void)log().try_log(LogLevel::Debug,
+                    (void)log().try_log(log_category::memory, LogLevel::Debug,
                                         "MemoryCache: invalidate_range left {} contended shard(s) unswept; "
                                         "stale entries persist until expiry.",
                                         skipped_shards);
                 }
             }
 
+            /// A shard array of @p shard_count shards with @p entries_per_shard soft capacity each, or null on failure.
+            [[nodiscard]] std::unique_ptr<CacheShard[]> allocate_shards(std::size_t shard_count,
+                                                                        std::size_t entries_per_shard) noexcept
+            {
+                const std::size_t hard_max_per_shard = entries_per_shard * DEFAULT_MAX_CACHE_SIZE_MULTIPLIER;
+                try
+                {
+                    auto shards = std::make_unique<CacheShard[]>(shard_count);
+                    for (std::size_t i = 0; i < shard_count; ++i)
+                    {
+                        shards[i].entries.reserve(hard_max_per_shard);
+                        shards[i].capacity = entries_per_shard;
+                        shards[i].max_capacity = hard_max_per_shard;
+                    }
+                    return shards;
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return nullptr;
+                }
+            }
+
             /**
              * @brief Performs one-time cache initialization (allocates the shard array, configures bounds).
              */
@@ -869,20 +1251,10 @@ namespace DetourModKit
                 const std::size_t entries_per_shard = (cache_size + shard_count - 1) / shard_count;
                 const std::size_t hard_max_per_shard = entries_per_shard * DEFAULT_MAX_CACHE_SIZE_MULTIPLIER;
 
-                try
-                {
-                    s_cache_shards = std::make_unique<CacheShard[]>(shard_count);
-                    for (std::size_t i = 0; i < shard_count; ++i)
-                    {
-                        s_cache_shards[i].entries.reserve(hard_max_per_shard);
-                        s_cache_shards[i].capacity = entries_per_shard;
-                        s_cache_shards[i].max_capacity = hard_max_per_shard;
-                    }
-                }
-                catch (const std::bad_alloc &)
+                s_cache_shards = allocate_shards(shard_count, entries_per_shard);
+                if (!s_cache_shards)
                 {
                     log().error("MemoryCache: Failed to allocate memory for cache shards.");
-                    s_cache_shards.reset();
                     s_cache_initialized.store(false, std::memory_order_relaxed);
                     return false;
                 }
@@ -896,12 +1268,184 @@ namespace DetourModKit
                 // a torn half-initialized snapshot where shard_count is set but expiry / max-entries are still zero.
                 s_shard_count.store(shard_count, std::memory_order_release);
 
-                log().debug("MemoryCache: Initialized with {} shards ({} entries/shard, {}ms expiry, {} max).",
+                log().debug(log_category::memory,
+                            "MemoryCache: Initialized with {} shards ({} entries/shard, {}ms expiry, {} max).",
                             shard_count, entries_per_shard, expiry_ms, hard_max_per_shard);
 
                 return true;
             }
 
+            // Adaptive growth thresholds, applied to the change in the shard tallies over one cleanup interval. An
+            // interval with fewer locked lookups or misses than the minimum is too quiet to say anything.
+            constexpr std::uint64_t ADAPTIVE_MIN_LOCKED_LOOKUPS = 1024;
+            constexpr std::uint64_t ADAPTIVE_CONTENTION_RATIO = 64;
+            constexpr std::uint64_t ADAPTIVE_MIN_MISSES = 256;
+            constexpr std::uint64_t ADAPTIVE_CHURN_RATIO = 4;
+            // Yields a shard growth waits for the reader epoch to drain before it backs out until the next interval.
+            constexpr int ADAPTIVE_DRAIN_YIELDS = 4096;
+
+            /// The shard tallies an adaptive evaluation compares across intervals, retired arrays included.
+            struct ShardTallies
+            {
+                std::uint64_t lookups = 0;
+                std::uint64_t misses = 0;
+                std::uint64_t contended = 0;
+                std::uint64_t evictions = 0;
+            };
+
+            // Adaptive-mode configuration and the tallies seen at the previous evaluation. Guarded by
+            // s_cache_state_mutex; s_adaptive_enabled mirrors enabled for the lock-free stats snapshot.
+            struct AdaptiveState
+            {
+                bool enabled = false;
+                std::size_t max_shard_count = 0;
+                std::size_t max_total_entries = 0;
+                ShardTallies previous{};
+            };
+            AdaptiveState s_adaptive;
+            std::atomic<bool> s_adaptive_enabled{false};
+
+            /// Sums the tallies of the first @p shard_count shards and the retired arrays. State mutex held.
+            [[nodiscard]] ShardTallies sum_shard_tallies(std::size_t shard_count) noexcept
+            {
+                ShardTallies total{};
+                total.lookups = s_retired.hits.load(std::memory_order_relaxed) +
+                                s_retired.misses.load(std::memory_order_relaxed);
+                total.misses = s_retired.misses.load(std::memory_order_relaxed);
+                total.contended = s_retired.contended.load(std::memory_order_relaxed);
+                total.evictions = s_retired.evictions.load(std::memory_order_relaxed);
+                for (std::size_t i = 0; i < shard_count; ++i)
+                {
+                    const CacheShard &shard = s_cache_shards[i];
+                    const std::uint64_t misses = shard.misses.load(std::memory_order_relaxed);
+                    total.lookups += shard.hits.load(std::memory_order_relaxed) + misses;
+                    total.misses += misses;
+                    total.contended += shard.contended.load(std::memory_order_relaxed);
+                    total.evictions += shard.evictions.load(std::memory_order_relaxed);
+                }
+                return total;
+            }
+
+            /// Spins until no reader holds an ActiveReaderGuard, giving up after ADAPTIVE_DRAIN_YIELDS yields.
+            [[nodiscard]] bool drain_readers_bounded() noexcept
+            {
+                for (int spins = 0; active_reader_total() > 0; ++spins)
+                {
+                    if (spins >= ADAPTIVE_DRAIN_YIELDS)
+                        return false;
+                    std::this_thread::yield();
+                }
+                return true;
+            }
+
+            /**
+             * @brief Replaces the shard array with @p shard_count empty shards once the reader epoch drains.
+             * @return false when the allocation failed or readers kept the epoch from draining; the old array stays.
+             * @details The same quiescence shutdown_cache reaches: publishing a zero shard count sends every new reader
+             *          to the uncached VirtualQuery walk, and the drain waits out the readers that saw the old count.
+             *          Entries are not carried over, since an invalidation that saw the zero count swept nothing; the
+             *          fast table and L0 hold copies of region state, not shard pointers, so they stay current. The
+             *          old tallies fold into s_retired before the array is freed. State mutex held, outside any
+             *          reader guard.
+             */
+            bool grow_shards(std::size_t shard_count, std::size_t entries_per_shard) noexcept
+            {
+                std::unique_ptr<CacheShard[]> grown = allocate_shards(shard_count, entries_per_shard);
+                if (!grown)
+                    return false;
+
+                const std::size_t old_count = s_shard_count.load(std::memory_order_acquire);
+                s_shard_count.store(0, std::memory_order_seq_cst);
+                if (!drain_readers_bounded())
+                {
+                    s_shard_count.store(old_count, std::memory_order_release);
+                    return false;
+                }
+
+                for (std::size_t i = 0; i < old_count; ++i)
+                {
+                    const CacheShard &shard = s_cache_shards[i];
+                    s_retired.hits.fetch_add(shard.hits.load(std::memory_order_relaxed), std::memory_order_relaxed);
+                    s_retired.misses.fetch_add(shard.misses.load(std::memory_order_relaxed),
+                                               std::memory_order_relaxed);
+                    s_retired.pinned_hits.fetch_add(shard.pinned_hits.load(std::memory_order_relaxed),
+                                                    std::memory_order_relaxed);
+                    s_retired.contended.fetch_add(shard.contended.load(std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+                    s_retired.evictions.fetch_add(shard.evictions.load(std::memory_order_relaxed),
+                                                  std::memory_order_relaxed);
+                    profile_entry_count_change(-static_cast<std::int64_t>(shard.entries.size()));
+                }
+                s_cache_shards.swap(grown);
+                s_shard_count.store(shard_count, std::memory_order_release);
+                s_stats.shard_growths.fetch_add(1, std::memory_order_relaxed);
+
+                (void)log().try_log(log_category::memory, LogLevel::Debug,
+                                    "MemoryCache: Adaptive growth to {} shards ({} entries/shard).", shard_count,
+                                    entries_per_shard);
+                return true;
+            }
+
+            /// Raises every shard's soft capacity to @p entries_per_shard in place. State mutex held.
+            void grow_capacity(std::size_t shard_count, std::size_t entries_per_shard) noexcept
+            {
+                for (std::size_t i = 0; i < shard_count; ++i)
+                {
+                    std::unique_lock<SrwSharedMutex> shard_lock(s_cache_shards[i].mtx);
+                    s_cache_shards[i].capacity = entries_per_shard;
+                    s_cache_shards[i].max_capacity = entries_per_shard * DEFAULT_MAX_CACHE_SIZE_MULTIPLIER;
+                }
+                s_max_entries_per_shard.store(entries_per_shard, std::memory_order_release);
+                s_stats.capacity_growths.fetch_add(1, std::memory_order_relaxed);
+
+                (void)log().try_log(log_category::memory, LogLevel::Debug,
+                                    "MemoryCache: Adaptive growth to {} entries/shard across {} shards.",
+                                    entries_per_shard, shard_count);
+            }
+
+            /**
+             * @brief Grows an adaptive cache's shard count on contention, or its per-shard capacity on churn.
+             * @details Runs after each periodic cleanup, on the background thread and outside any reader guard, which
+             *          the shard-growth drain requires. It acts on the tallies' change since the last run: contention
+             *          wins over churn, since more shards also spread the entries, and one interval makes at most one
+             *          growth. Both keep the total soft capacity within max_total_entries.
+             */
+            void adapt_cache_configuration() noexcept
+            {
+                std::lock_guard<std::mutex> state_lock(s_cache_state_mutex);
+                if (!s_adaptive.enabled || !s_cache_initialized.load(std::memory_order_seq_cst))
+                    return;
+                const std::size_t shard_count = s_shard_count.load(std::memory_order_acquire);
+                if (shard_count == 0)
+                    return;
+
+                const ShardTallies now = sum_shard_tallies(shard_count);
+                const ShardTallies &before = s_adaptive.previous;
+                const std::uint64_t lookups = now.lookups - before.lookups;
+                const std::uint64_t misses = now.misses - before.misses;
+                const std::uint64_t contended = now.contended - before.contended;
+                const std::uint64_t evictions = now.evictions - before.evictions;
+                s_adaptive.previous = now;
+
+                const std::size_t per_shard = s_max_entries_per_shard.load(std::memory_order_acquire);
+                const std::size_t budget = s_adaptive.max_total_entries;
+
+                if (lookups >= ADAPTIVE_MIN_LOCKED_LOOKUPS && contended * ADAPTIVE_CONTENTION_RATIO >= lookups)
+                {
+                    const std::size_t grown =
+                        std::min({shard_count * 2, s_adaptive.max_shard_count, budget / per_shard});
+                    if (grown > shard_count && grow_shards(grown, per_shard))
+                        return;
+                }
+
+                if (misses >= ADAPTIVE_MIN_MISSES && evictions * ADAPTIVE_CHURN_RATIO >= misses)
+                {
+                    const std::size_t grown = std::min(per_shard * 2, budget / shard_count);
+                    if (grown > per_shard)
+                        grow_capacity(shard_count, grown);
+                }
+            }
+
             /**
              * @brief Performs VirtualQuery and updates the cache with stampede coalescing.
              * @return true if VirtualQuery (or a coalesced follower read) succeeded.
@@ -910,17 +1454,20 @@ namespace DetourModKit
                                         MEMORY_BASIC_INFORMATION &mbi_out) noexcept
             {
                 CacheShard &shard = s_cache_shards[shard_idx];
+                // Loaded before the VirtualQuery, so an invalidation landing after it un-pins whatever this inserts.
+                const std::uint64_t generation = s_fast_generation.load(std::memory_order_acquire);
 
                 char expected = 0;
                 if (shard.in_flight.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
                 {
-                    const bool result = VirtualQuery(address, &mbi_out, sizeof(mbi_out)) != 0;
+                    const bool result = query_region(address, mbi_out);
                     const std::uint64_t now_ns = current_time_ns();
 
-                    if (result)
+                    // A negative region goes to the negative table (see resolve_region), never into the shard.
+                    if (result && !negative_region(mbi_out))
                     {
-                        std::unique_lock<SrwSharedMutex> lock(s_cache_shards[shard_idx].mtx);
-                        update_shard_with_region(shard, mbi_out, now_ns);
+                        std::unique_lock<SrwSharedMutex> lock = lock_shard_exclusive(shard);
+                        update_shard_with_region(shard, mbi_out, now_ns, pinned_region(mbi_out) ? generation : 0);
                     }
 
                     shard.in_flight.store(0, std::memory_order_release);
@@ -936,7 +1483,19 @@ namespace DetourModKit
                         if (shard.in_flight.load(std::memory_order_acquire) == 0)
                         {
                             const std::uintptr_t addr_val = reinterpret_cast<std::uintptr_t>(address);
-                            std::shared_lock<SrwSharedMutex> lock(s_cache_shards[shard_idx].mtx);
+                            // A leader that found the region negative published it there rather than in the shard.
+                            if (const std::optional<RegionSnapshot> negative =
+                                    negative_lookup(addr_val, current_time_ns(), generation))
+                            {
+                                s_stats.coalesced_queries.fetch_add(1, std::memory_order_relaxed);
+                                mbi_out = MEMORY_BASIC_INFORMATION{};
+                                mbi_out.BaseAddress = reinterpret_cast<PVOID>(negative->base);
+                                mbi_out.RegionSize = negative->end - negative->base;
+                                mbi_out.Protect = negative->protection;
+                                mbi_out.State = negative->state;
+                                return true;
+                            }
+                            std::shared_lock<SrwSharedMutex> lock = lock_shard_shared(shard);
                             CachedMemoryRegionInfo *cached =
                                 find_in_shard(shard, addr_val, 1, current_time_ns(), expiry_ns);
                             if (cached)
@@ -946,6 +1505,7 @@ namespace DetourModKit
                                 mbi_out.RegionSize = cached->region_size;
                                 mbi_out.Protect = cached->protection;
                                 mbi_out.State = cached->state;
+                                mbi_out.Type = cached->type;
                                 return true;
                             }
                             break;
@@ -957,12 +1517,12 @@ namespace DetourModKit
                     expected = 0;
                     if (shard.in_flight.compare_exchange_strong(expected, 1, std::memory_order_acq_rel))
                     {
-                        const bool result = VirtualQuery(address, &mbi_out, sizeof(mbi_out)) != 0;
-                        if (result)
+                        const bool result = query_region(address, mbi_out);
+                        if (result && !negative_region(mbi_out))
                         {
-                            std::unique_lock<SrwSharedMutex> lock(s_cache_shards[shard_idx].mtx);
+                            std::unique_lock<SrwSharedMutex> lock = lock_shard_exclusive(shard);
                             const std::uint64_t now_ns = current_time_ns();
-                            update_shard_with_region(shard, mbi_out, now_ns);
+                            update_shard_with_region(shard, mbi_out, now_ns, pinned_region(mbi_out) ? generation : 0);
                         }
                         shard.in_flight.store(0, std::memory_order_release);
                         return result;
@@ -1024,53 +1584,52 @@ namespace DetourModKit
             }
 
             /**
-             * @brief Unified permission check shared by is_readable and is_writable.
-             * @param address Start address of the query (0 fails closed).
-             * @param size Number of bytes to check (0 fails closed).
-             * @param check_permission Predicate validating the protection flags.
+             * @brief Resolves the region holding @p address through the L0, the fast table, the shard, and finally
+             *        VirtualQuery, publishing what it read into the lock-free layers.
+             * @param reader_guard The caller's live guard; @p shard_count must have been read under it and be non-zero.
+             * @param size The span the cached layers must cover whole to count as a hit. A VirtualQuery result is
+             *        returned whatever its extent, so the caller checks the span against the returned end.
+             * @return The region's snapshot, or nullopt when VirtualQuery itself failed.
              */
-            bool check_memory_permission(std::uintptr_t address, std::size_t size,
-                                         bool (*check_permission)(DWORD) noexcept) noexcept
+            [[nodiscard]] std::optional<RegionSnapshot> resolve_region(ActiveReaderGuard &reader_guard,
+                                                                       std::uintptr_t address, std::size_t size,
+                                                                       std::size_t shard_count) noexcept
             {
-                if (address == 0 || size == 0)
-                    return false;
-
-                // Construct the reader guard before loading s_cache_initialized so shutdown_cache cannot free the shard
-                // array between the check and the access.
-                ActiveReaderGuard reader_guard;
-
-                const bool cache_initialized = s_cache_initialized.load(std::memory_order_seq_cst);
-                const std::size_t shard_count = cache_initialized ? s_shard_count.load(std::memory_order_acquire) : 0;
+                const std::uint64_t now_ns = current_time_ns();
+                const std::uint64_t expiry_ns = configured_expiry_ns();
 
-                // Fall back to a direct VirtualQuery whenever the cache is unavailable: never initialized, observed in
-                // the brief init publication window (flag set but count still 0), or a concurrent shutdown that already
-                // zeroed the count.
-                if (shard_count == 0)
+                // Loaded before the shard or the OS is consulted, so whatever this call publishes below is retired by
+                // any invalidation that lands after this point.
+                const std::uint64_t generation = s_fast_generation.load(std::memory_order_acquire);
+                ReaderStripe &stripe = reader_guard.stripe();
+                if (std::optional<RegionSnapshot> fast =
+                        fast_lookup(stripe, address, size, now_ns, expiry_ns, generation))
                 {
-                    // No cache to consult: walk the range directly. The walk spans protection boundaries, so a range
-                    // that crosses a re-protected interior page is answered correctly instead of failing closed on the
-                    // first region's end.
-                    return range_permission_uncached(address, size, check_permission);
+                    reader_guard.count_fast_hit(*fast, now_ns, expiry_ns);
+                    return fast;
+                }
+                if (std::optional<RegionSnapshot> negative = negative_lookup(address, now_ns, generation))
+                {
+                    reader_guard.count_negative_hit();
+                    return negative;
                 }
 
                 const std::size_t shard_idx = compute_shard_index(address, shard_count);
-                const std::uint64_t now_ns = current_time_ns();
-                const std::uint64_t expiry_ns = configured_expiry_ns();
-
                 {
-                    std::shared_lock<SrwSharedMutex> lock(s_cache_shards[shard_idx].mtx);
+                    std::shared_lock<SrwSharedMutex> lock = lock_shard_shared(s_cache_shards[shard_idx]);
                     CachedMemoryRegionInfo *cached_info =
                         find_in_shard(s_cache_shards[shard_idx], address, size, now_ns, expiry_ns);
                     if (cached_info)
                     {
                         s_cache_shards[shard_idx].hits.fetch_add(1, std::memory_order_relaxed);
-                        // Require MEM_COMMIT on the hit path exactly as the miss and uncached-walk paths do below: a
-                        // cached region whose stored state is not committed (a reserved or freed range) is not
-                        // readable/writable regardless of its protection mask, matching the "readable and committed"
-                        // contract this predicate documents. VirtualQuery reports Protect == 0 for a non-committed
-                        // region, which check_permission already rejects, so this is defense-in-depth that keeps the
-                        // hit path symmetric with every other path rather than a currently-reachable wrong answer.
-                        return cached_info->state == MEM_COMMIT && check_permission(cached_info->protection);
+                        // A valid entry past the expiry can only be a pinned one.
+                        if (now_ns - cached_info->timestamp_ns > expiry_ns)
+                            s_cache_shards[shard_idx].pinned_hits.fetch_add(1, std::memory_order_relaxed);
+                        std::optional<RegionSnapshot> cached =
+                            snapshot_of(cached_info->base_address, cached_info->region_size, cached_info->protection,
+                                        cached_info->state, cached_info->timestamp_ns, entry_pinned(*cached_info));
+                        fast_publish(stripe, address, cached, generation);
+                        return cached;
                     }
                 }
 
@@ -1078,37 +1637,166 @@ namespace DetourModKit
 
                 MEMORY_BASIC_INFORMATION mbi{};
                 if (!query_and_update_cache(shard_idx, reinterpret_cast<LPCVOID>(address), mbi))
-                    return false;
+                    return std::nullopt;
+
+                // now_ns predates the query, so the slot never outlives the snapshot it holds. A negative region is
+                // kept out of the fast table and L0, whose slots live for the longer shard expiry.
+                std::optional<RegionSnapshot> queried =
+                    snapshot_of(reinterpret_cast<std::uintptr_t>(mbi.BaseAddress), mbi.RegionSize, mbi.Protect,
+                                mbi.State, now_ns, pinned_region(mbi));
+                if (negative_region(mbi))
+                    negative_publish(address, queried, generation);
+                else
+                    fast_publish(stripe, address, queried, generation);
+                return queried;
+            }
 
-                if (mbi.State != MEM_COMMIT)
+            /**
+             * @brief Answers the permission check for [address, address + size) given the region holding @p address.
+             * @details Requires MEM_COMMIT on every path, cached or queried: a region whose stored state is not
+             *          committed (a reserved or freed range) is not readable/writable regardless of its protection
+             *          mask, matching the "readable and committed" contract the predicates document. VirtualQuery
+             *          reports Protect == 0 for a non-committed region, which check_permission already rejects, so
+             *          this is defense-in-depth that keeps every path symmetric rather than a currently-reachable
+             *          wrong answer.
+             */
+            bool permission_in_region(const RegionSnapshot &region, std::uintptr_t address, std::size_t size,
+                                      bool (*check_permission)(DWORD) noexcept) noexcept
+            {
+                if (region.state != MEM_COMMIT)
                     return false;
 
-                if (!check_permission(mbi.Protect))
+                if (!check_permission(region.protection))
                     return false;
 
-                const std::uintptr_t region_end_addr =
-                    reinterpret_cast<std::uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
                 const std::uintptr_t query_end_addr = address + size;
 
                 if (query_end_addr < address)
                     return false;
-                if (region_end_addr <= address)
+                if (region.end <= address)
                     return false;
 
-                // The query landed inside the region just cached by query_and_update_cache (VirtualQuery always returns
-                // the region that contains `address`, so the range starts at or after its base). The common case is
-                // that the whole range fits within this one region -- answer directly and keep the region cached for
-                // the next probe. When the range extends past this region it crosses into an adjacent protection
-                // region, which a single cache entry can never cover, so walk the remainder uncached: fail closed if
-                // any sub-region is uncommitted, disallowed, or separated by an unmapped gap.
-                if (query_end_addr <= region_end_addr)
+                // VirtualQuery always returns the region that contains `address`, so the range starts at or after its
+                // base. The common case is that the whole range fits within this one region -- answer directly. When
+                // the range extends past this region it crosses into an adjacent protection region, which a single
+                // cache entry can never cover, so walk the remainder uncached: fail closed if any sub-region is
+                // uncommitted, disallowed, or separated by an unmapped gap.
+                if (query_end_addr <= region.end)
                     return true;
 
-                return range_permission_uncached(region_end_addr, query_end_addr - region_end_addr, check_permission);
+                return range_permission_uncached(region.end, query_end_addr - region.end, check_permission);
+            }
+
+            /**
+             * @brief Unified permission check shared by is_readable and is_writable.
+             * @param address Start address of the query (0 fails closed).
+             * @param size Number of bytes to check (0 fails closed).
+             * @param check_permission Predicate validating the protection flags.
+             */
+            bool check_memory_permission(std::uintptr_t address, std::size_t size,
+                                         bool (*check_permission)(DWORD) noexcept) noexcept
+            {
+                if (address == 0 || size == 0)
+                    return false;
+                // Past the user address space VirtualQuery fails for every address, so no query can say otherwise.
+                if (address >= USERSPACE_PTR_MAX)
+                    return false;
+
+                // Construct the reader guard before loading s_cache_initialized so shutdown_cache cannot free the shard
+                // array between the check and the access.
+                ActiveReaderGuard reader_guard;
+
+                const bool cache_initialized = s_cache_initialized.load(std::memory_order_seq_cst);
+                const std::size_t shard_count =
+                    cache_initialized ? s_shard_count.load(std::memory_order_seq_cst) : 0;
+
+                // Fall back to a direct VirtualQuery whenever the cache is unavailable: never initialized, observed in
+                // the brief init publication window (flag set but count still 0), or a concurrent shutdown or adaptive
+                // shard growth that zeroed the count.
+                if (shard_count == 0)
+                {
+                    // No cache to consult: walk the range directly. The walk spans protection boundaries, so a range
+                    // that crosses a re-protected interior page is answered correctly instead of failing closed on the
+                    // first region's end.
+                    return range_permission_uncached(address, size, check_permission);
+                }
+
+                const std::optional<RegionSnapshot> region = resolve_region(reader_guard, address, size, shard_count);
+                return region && permission_in_region(*region, address, size, check_permission);
+            }
+
+            // Regions one is_readable_batch call remembers. Entity lists live in a handful of heap regions, so a small
+            // table answers nearly every address with a few compares; a batch that touches more regions only pays a
+            // re-resolve (usually an L0 or fast-table hit) when an evicted one comes back.
+            constexpr std::size_t BATCH_REGION_SLOTS = 16;
+
+            /// The region holding @p address from one direct VirtualQuery, for a batch run while the cache is down.
+            [[nodiscard]] std::optional<RegionSnapshot> query_region_uncached(std::uintptr_t address) noexcept
+            {
+                MEMORY_BASIC_INFORMATION mbi{};
+                if (VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) == 0)
+                    return std::nullopt;
+                return snapshot_of(reinterpret_cast<std::uintptr_t>(mbi.BaseAddress), mbi.RegionSize, mbi.Protect,
+                                   mbi.State, 0, false);
+            }
+
+            /**
+             * @brief Caches every committed region from @p begin up to @p end into each shard with spare room.
+             * @param walked_to Receives the end of the last region walked, which can lie past @p end.
+             * @return The number of regions inserted into at least one shard.
+             * @note The caller holds an ActiveReaderGuard and has observed the cache live with @p shard_count shards.
+             */
+            std::size_t prewarm_span(std::uintptr_t begin, std::uintptr_t end, std::size_t shard_count,
+                                     std::uintptr_t &walked_to) noexcept
+            {
+                std::size_t cached = 0;
+                std::uintptr_t cursor = begin;
+                while (cursor < end)
+                {
+                    // Loaded before the query, as on the miss path, so an invalidation racing the walk un-pins what
+                    // it inserts.
+                    const std::uint64_t generation = s_fast_generation.load(std::memory_order_acquire);
+                    MEMORY_BASIC_INFORMATION mbi{};
+                    if (VirtualQuery(reinterpret_cast<LPCVOID>(cursor), &mbi, sizeof(mbi)) == 0)
+                        break;
+                    const std::uintptr_t region_base = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress);
+                    const std::uintptr_t region_end = region_base + mbi.RegionSize;
+                    // Same forward-progress backstop as range_permission_uncached; it also stops at a wrapped end.
+                    if (region_end <= cursor)
+                        break;
+
+                    if (mbi.State == MEM_COMMIT)
+                    {
+                        const std::uint64_t now_ns = current_time_ns();
+                        const std::uint64_t pin_generation = pinned_region(mbi) ? generation : 0;
+                        bool inserted = false;
+                        // A lookup anywhere in the region can hash to any shard, so each one gets its own copy.
+                        for (std::size_t i = 0; i < shard_count; ++i)
+                        {
+                            CacheShard &shard = s_cache_shards[i];
+                            std::unique_lock<SrwSharedMutex> lock(shard.mtx);
+                            // Spare room only: a speculative entry is not worth evicting one a lookup already earned.
+                            if (shard.entries.size() >= shard.capacity && !shard.entries.contains(region_base))
+                                continue;
+                            update_shard_with_region(shard, mbi, now_ns, pin_generation);
+                            inserted = true;
+                        }
+                        cached += inserted ? 1 : 0;
+                    }
+                    cursor = region_end;
+                }
+                walked_to = cursor;
+                return cached;
             }
         } // namespace
 
         bool init_cache(std::size_t cache_size, unsigned int expiry_ms, std::size_t shard_count)
+        {
+            return init_cache(
+                CacheOptions{.cache_size = cache_size, .expiry_ms = expiry_ms, .shard_count = shard_count});
+        }
+
+        bool init_cache(const CacheOptions &options)
         {
             std::lock_guard<std::mutex> state_lock(s_cache_state_mutex);
 
@@ -1118,42 +1806,54 @@ namespace DetourModKit
             bool expected = false;
             if (s_cache_initialized.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
             {
-                if (!perform_cache_initialization(cache_size, expiry_ms, shard_count))
+                detail::mark_subsystem_used(detail::Subsystem::MemoryCache);
+                if (!perform_cache_initialization(options.cache_size, options.expiry_ms, options.shard_count))
                 {
                     return false;
                 }
 
+                // The growth ceilings never sit below the starting configuration, so adaptive mode only ever grows.
+                const std::size_t shard_count = s_shard_count.load(std::memory_order_acquire);
+                const std::size_t cache_size = shard_count * s_max_entries_per_shard.load(std::memory_order_acquire);
+                s_adaptive = AdaptiveState{};
+                s_adaptive.enabled = options.adaptive;
+                s_adaptive.max_shard_count = std::max(options.max_shard_count, shard_count);
+                s_adaptive.max_total_entries =
+                    std::max(options.max_cache_size != 0 ? options.max_cache_size
+                                                         : cache_size * DEFAULT_ADAPTIVE_CACHE_GROWTH_LIMIT,
+                             cache_size);
+                s_adaptive_enabled.store(options.adaptive, std::memory_order_relaxed);
+                s_negative_expiry_ms.store(std::min(options.negative_expiry_ms,
+                                                    s_configured_expiry_ms.load(std::memory_order_acquire)),
+                                           std::memory_order_relaxed);
+
 #if !defined(_MSC_VER) && defined(_WIN64)
                 // MinGW has no frame-based SEH; install the process-wide vectored fault handler the guarded reads rely
                 // on so a guarded read never has to fall back to a per-call VirtualQuery. Best-effort and independent
                 // of cache success.
                 detail::ensure_guarded_engine_installed();
 #endif
-
-                s_cleanup_thread_running.store(true, std::memory_order_release);
-                // Hold a counted reference before creating the cleanup thread; after std::thread returns the cleanup
-                // routine may already be executing library code. A creation failure releases this reference below.
-                s_cleanup_self_ref = acquire_module_ref();
-                if (s_cleanup_self_ref == nullptr)
+                // Take module_of off the loader path for the cache's lifetime. Best-effort, like the handler install.
+                // Image regions are pinned past the expiry only when the subscription is live to report unloads.
+                s_pin_image_regions.store(detail::install_module_table(), std::memory_order_release);
+
+                // Expired entries are swept by a periodic task on the shared background service rather than by a
+                // thread of the cache's own.
+                auto cleanup_task = detail::schedule_background_timer("MemoryCache cleanup", CLEANUP_INTERVAL,
+                                                                      []() noexcept
+                                                                      {
+                                                                          cleanup_expired_entries(true);
+                                                                          adapt_cache_configuration();
+                                                                      });
+                if (cleanup_task)
                 {
-                    s_cleanup_thread_running.store(false, std::memory_order_release);
-                    log().debug(
-                        "MemoryCache: Module reference unavailable, using on-demand cleanup instead of background "
-                        "cleanup.");
+                    s_cleanup_task.store(*cleanup_task, std::memory_order_release);
                 }
                 else
                 {
-                    try
-                    {
-                        s_cleanup_thread = std::thread(cleanup_thread_func);
-                    }
-                    catch (...)
-                    {
-                        release_module_ref(s_cleanup_self_ref);
-                        s_cleanup_self_ref = nullptr;
-                        s_cleanup_thread_running.store(false, std::memory_order_release);
-                        log().debug("MemoryCache: Background cleanup thread unavailable, using on-demand cleanup.");
-                    }
+                    log().debug(log_category::memory,
+                                "MemoryCache: Background cleanup unavailable ({}), using on-demand cleanup.",
+                                cleanup_task.error().message());
                 }
 
                 // Last-resort safety net: clean up if the consumer forgets to call shutdown_cache. The handler detects
@@ -1174,13 +1874,14 @@ namespace DetourModKit
                                     // soon-to-be-freed code is worse than the detached-thread leak below.
                                     detail::release_guarded_engine();
 #endif
-                                    s_cleanup_thread_running.store(false, std::memory_order_release);
-                                    s_cleanup_cv.notify_one();
-                                    // Serialize the detach with shutdown_cache's join/detach so an explicit teardown
-                                    // racing this atexit handler cannot touch the same std::thread twice. This is a
-                                    // try-lock under loader lock; if another shutdown is already joining, returning
-                                    // promptly lets the cleanup thread finish its own loader notifications.
-                                    (void)try_detach_cleanup_thread_under_loader_lock();
+                                    // Same reasoning for the loader notification: unregistering is safe under loader
+                                    // lock, and a callback left registered would dangle once the module unloads.
+                                    detail::release_module_table();
+                                    s_pin_image_regions.store(false, std::memory_order_release);
+                                    // Unregister the cleanup task without waiting for a run in progress: the service
+                                    // does not wait under loader lock, and the task never frees cache state.
+                                    (void)detail::cancel_background_task(
+                                        s_cleanup_task.exchange(detail::NO_BACKGROUND_TASK, std::memory_order_acq_rel));
                                     s_cache_initialized.store(false, std::memory_order_release);
                                     return;
                                 }
@@ -1207,29 +1908,38 @@ namespace DetourModKit
             if (shard_count == 0)
                 return;
 
-            // Blocking exclusive lock per shard to guarantee all entries are cleared. The cleanup thread uses try_lock,
+            // Blocking exclusive lock per shard to guarantee all entries are cleared. The cleanup task uses try_lock,
             // so it skips shards we hold without deadlocking.
             for (std::size_t i = 0; i < shard_count; ++i)
             {
                 std::unique_lock<SrwSharedMutex> shard_lock(s_cache_shards[i].mtx);
+                profile_entry_count_change(-static_cast<std::int64_t>(s_cache_shards[i].entries.size()));
                 s_cache_shards[i].entries.clear();
                 s_cache_shards[i].lru_index.clear();
                 s_cache_shards[i].sorted_ranges.clear();
                 s_cache_shards[i].in_flight.store(0, std::memory_order_relaxed);
                 s_cache_shards[i].hits.store(0, std::memory_order_relaxed);
                 s_cache_shards[i].misses.store(0, std::memory_order_relaxed);
+                s_cache_shards[i].pinned_hits.store(0, std::memory_order_relaxed);
+                s_cache_shards[i].contended.store(0, std::memory_order_relaxed);
+                s_cache_shards[i].evictions.store(0, std::memory_order_relaxed);
             }
+            retire_fast_slots();
+            reset_fast_hits();
+            s_retired.reset();
+            s_adaptive.previous = ShardTallies{};
 
             s_stats.invalidations.store(0, std::memory_order_relaxed);
             s_stats.coalesced_queries.store(0, std::memory_order_relaxed);
             s_stats.on_demand_cleanups.store(0, std::memory_order_relaxed);
+            s_stats.expired_entries.store(0, std::memory_order_relaxed);
 
             s_last_cleanup_time_ns.store(current_time_ns(), std::memory_order_relaxed);
 
             // Diagnostic-only tail; clear_cache is noexcept, so a sink or format failure drops the line.
             try
             {
-                log().debug("MemoryCache: All entries cleared.");
+                log().debug(log_category::memory, "MemoryCache: All entries cleared.");
             }
             catch (...)
             {
@@ -1238,14 +1948,11 @@ namespace DetourModKit
 
         void shutdown_cache() noexcept
         {
-            // Signal and join the cleanup thread before acquiring the state mutex: the thread takes s_cache_state_mutex
-            // in cleanup_expired_entries(force=true), so joining while holding it would deadlock.
-            s_cleanup_thread_running.store(false, std::memory_order_release);
-            s_cleanup_cv.notify_one();
-
-            // Claim the cleanup thread's final action before taking the state mutex; a loader-lock caller uses the
-            // helper's non-blocking detach path.
-            finish_cleanup_thread();
+            // Cancel the cleanup task before acquiring the state mutex: a run in progress takes s_cache_state_mutex in
+            // cleanup_expired_entries(force=true), and the cancel waits for it. The exchange hands the task to exactly
+            // one of several concurrent callers; under loader lock the cancel does not wait.
+            (void)detail::cancel_background_task(
+                s_cleanup_task.exchange(detail::NO_BACKGROUND_TASK, std::memory_order_acq_rel));
 
             std::lock_guard<std::mutex> state_lock(s_cache_state_mutex);
 
@@ -1278,22 +1985,31 @@ namespace DetourModKit
             for (std::size_t i = 0; i < shard_count; ++i)
             {
                 std::unique_lock<SrwSharedMutex> shard_lock(s_cache_shards[i].mtx);
+                profile_entry_count_change(-static_cast<std::int64_t>(s_cache_shards[i].entries.size()));
                 s_cache_shards[i].entries.clear();
                 s_cache_shards[i].lru_index.clear();
                 s_cache_shards[i].sorted_ranges.clear();
             }
 
             s_cache_shards.reset();
+            retire_fast_slots();
 
-            // The per-shard hit / miss tallies were freed with the shard array above; only the global cold counters
-            // need an explicit reset here.
+            // The per-shard hit / miss tallies were freed with the shard array above; the fast-table tallies on the
+            // reader stripes and the global cold counters need an explicit reset here.
+            reset_fast_hits();
             s_stats.invalidations.store(0, std::memory_order_relaxed);
             s_stats.coalesced_queries.store(0, std::memory_order_relaxed);
             s_stats.on_demand_cleanups.store(0, std::memory_order_relaxed);
+            s_stats.expired_entries.store(0, std::memory_order_relaxed);
             s_last_cleanup_time_ns.store(0, std::memory_order_relaxed);
             s_configured_expiry_ms.store(0, std::memory_order_relaxed);
             s_max_entries_per_shard.store(0, std::memory_order_relaxed);
-            s_cleanup_requested.store(false, std::memory_order_relaxed);
+            s_retired.reset();
+            s_stats.shard_growths.store(0, std::memory_order_relaxed);
+            s_stats.capacity_growths.store(0, std::memory_order_relaxed);
+            s_adaptive = AdaptiveState{};
+            s_adaptive_enabled.store(false, std::memory_order_relaxed);
+            s_negative_expiry_ms.store(0, std::memory_order_relaxed);
 
 #if !defined(_MSC_VER) && defined(_WIN64)
             // Remove the vectored fault handler so it cannot dangle into freed code if the DMK module is unloaded after
@@ -1301,10 +2017,13 @@ namespace DetourModKit
             // read cannot fault into a missing handler. Idempotent; a later guarded read re-installs it.
             detail::release_guarded_engine();
 #endif
+            // Unsubscribe the loaded-module table for the same reason; module_of returns to the loader path.
+            detail::release_module_table();
+            s_pin_image_regions.store(false, std::memory_order_release);
 
             try
             {
-                log().debug("MemoryCache: Shutdown complete.");
+                log().debug(log_category::memory, "MemoryCache: Shutdown complete.");
             }
             catch (...)
             {
@@ -1315,12 +2034,15 @@ namespace DetourModKit
         {
             MemoryStats stats{};
             // The COLD counters live in the static CacheStats, independent of the shard-array lifetime, so a relaxed
-            // load outside the reader guard is safe. The hot hits / misses tallies live per-shard and are summed under
-            // the reader guard below (alongside the entry totals), so while the cache is down -- no shard array to sum
-            // -- they read 0, the zero a fresh snapshot reports.
+            // load outside the reader guard is safe. The hot hits / misses tallies live per-shard (plus the fast-table
+            // hits on the reader stripes) and are summed under the reader guard below (alongside the entry totals), so
+            // while the cache is down -- no shard array to sum -- they read 0, the zero a fresh snapshot reports.
             stats.invalidations = s_stats.invalidations.load(std::memory_order_relaxed);
             stats.coalesced_queries = s_stats.coalesced_queries.load(std::memory_order_relaxed);
             stats.on_demand_cleanups = s_stats.on_demand_cleanups.load(std::memory_order_relaxed);
+            stats.expired_entries = s_stats.expired_entries.load(std::memory_order_relaxed);
+            stats.shard_growths = s_stats.shard_growths.load(std::memory_order_relaxed);
+            stats.capacity_growths = s_stats.capacity_growths.load(std::memory_order_relaxed);
 
             // Capture the configuration fields and the live-entry totals as one coherent snapshot behind the reader
             // guard and the same seq_cst s_cache_initialized gate the permission readers use (see
@@ -1335,12 +2057,19 @@ namespace DetourModKit
                 ActiveReaderGuard reader_guard;
                 if (s_cache_initialized.load(std::memory_order_seq_cst))
                 {
-                    const std::size_t active_shard_count = s_shard_count.load(std::memory_order_acquire);
+                    const std::size_t active_shard_count = s_shard_count.load(std::memory_order_seq_cst);
                     if (active_shard_count > 0)
                     {
                         stats.shard_count = active_shard_count;
                         stats.max_entries_per_shard = s_max_entries_per_shard.load(std::memory_order_acquire);
                         stats.expiry_ms = s_configured_expiry_ms.load(std::memory_order_acquire);
+                        stats.adaptive = s_adaptive_enabled.load(std::memory_order_relaxed);
+                        stats.negative_expiry_ms = s_negative_expiry_ms.load(std::memory_order_relaxed);
+                        stats.hits = s_retired.hits.load(std::memory_order_relaxed);
+                        stats.misses = s_retired.misses.load(std::memory_order_relaxed);
+                        stats.pinned_hits = s_retired.pinned_hits.load(std::memory_order_relaxed);
+                        stats.contended_acquires = s_retired.contended.load(std::memory_order_relaxed);
+                        stats.capacity_evictions = s_retired.evictions.load(std::memory_order_relaxed);
 
                         std::size_t total_hard_max = 0;
                         for (std::size_t i = 0; i < active_shard_count; ++i)
@@ -1350,8 +2079,21 @@ namespace DetourModKit
                             total_hard_max += s_cache_shards[i].max_capacity;
                             stats.hits += s_cache_shards[i].hits.load(std::memory_order_relaxed);
                             stats.misses += s_cache_shards[i].misses.load(std::memory_order_relaxed);
+                            stats.pinned_hits += s_cache_shards[i].pinned_hits.load(std::memory_order_relaxed);
+                            stats.contended_acquires += s_cache_shards[i].contended.load(std::memory_order_relaxed);
+                            stats.capacity_evictions += s_cache_shards[i].evictions.load(std::memory_order_relaxed);
+                            for (const auto &[base, entry] : s_cache_shards[i].entries)
+                            {
+                                stats.pinned_entries += entry_pinned(entry) ? 1 : 0;
+                            }
                         }
                         stats.hard_max_per_shard = total_hard_max / active_shard_count;
+                        for (const ReaderStripe &stripe : s_reader_stripes)
+                        {
+                            stats.hits += stripe.fast_hits.load(std::memory_order_relaxed);
+                            stats.pinned_hits += stripe.pinned_hits.load(std::memory_order_relaxed);
+                            stats.negative_hits += stripe.negative_hits.load(std::memory_order_relaxed);
+                        }
                     }
                 }
             }
@@ -1372,7 +2114,12 @@ namespace DetourModKit
                 << ", HardMax/Shard: " << s.hard_max_per_shard << ", Expiry: " << s.expiry_ms << "ms) - "
                 << "Hits: " << s.hits << ", Misses: " << s.misses << ", Invalidations: " << s.invalidations
                 << ", Coalesced: " << s.coalesced_queries << ", OnDemandCleanups: " << s.on_demand_cleanups
-                << ", TotalEntries: " << s.total_entries;
+                << ", Expired: " << s.expired_entries << ", TotalEntries: " << s.total_entries
+                << ", PinnedEntries: " << s.pinned_entries << ", PinnedHits: " << s.pinned_hits
+                << ", Contended: " << s.contended_acquires << ", CapacityEvictions: " << s.capacity_evictions
+                << ", Adaptive: " << (s.adaptive ? "yes" : "no") << ", ShardGrowths: " << s.shard_growths
+                << ", CapacityGrowths: " << s.capacity_growths << ", NegativeHits: " << s.negative_hits
+                << ", NegativeExpiry: " << s.negative_expiry_ms << "ms";
 
             if (s.hit_rate_percent >= 0.0)
             {
@@ -1390,6 +2137,9 @@ namespace DetourModKit
             if (!range.base || range.size == 0)
                 return;
 
+            // Thunk destinations are cached whether or not the protection cache is up, so retire them first.
+            detail::invalidate_thunk_targets();
+
             // Construct the reader guard before checking s_cache_initialized so shutdown_cache cannot free the shard
             // array between the check and the access.
             ActiveReaderGuard reader_guard;
@@ -1397,7 +2147,7 @@ namespace DetourModKit
             if (!s_cache_initialized.load(std::memory_order_seq_cst))
                 return;
 
-            const std::size_t shard_count = s_shard_count.load(std::memory_order_acquire);
+            const std::size_t shard_count = s_shard_count.load(std::memory_order_seq_cst);
             if (shard_count == 0)
                 return;
 
@@ -1408,6 +2158,49 @@ namespace DetourModKit
             request_cleanup();
         }
 
+        Result<std::size_t> prewarm(Region range) noexcept
+        {
+            if (range.size == 0)
+                return std::size_t{0};
+            const std::uintptr_t begin = range.base.raw();
+            if (begin == 0 || range.size > UINTPTR_MAX - begin)
+                return std::unexpected(Error{ErrorCode::InvalidRange, "memory::prewarm", begin});
+
+            // Same guard-then-gate order as every reader, so shutdown_cache cannot free the shards mid-walk.
+            ActiveReaderGuard reader_guard;
+            if (!s_cache_initialized.load(std::memory_order_seq_cst))
+                return std::size_t{0};
+            const std::size_t shard_count = s_shard_count.load(std::memory_order_seq_cst);
+            if (shard_count == 0)
+                return std::size_t{0};
+
+            std::uintptr_t walked_to = 0;
+            return prewarm_span(begin, begin + range.size, shard_count, walked_to);
+        }
+
+        std::size_t prewarm(const RegionSet &ranges) noexcept
+        {
+            ActiveReaderGuard reader_guard;
+            if (!s_cache_initialized.load(std::memory_order_seq_cst))
+                return 0;
+            const std::size_t shard_count = s_shard_count.load(std::memory_order_seq_cst);
+            if (shard_count == 0)
+                return 0;
+
+            // RegionSet spans are sorted, so resuming each walk at the previous one's end skips a region already
+            // cached from the span before.
+            std::size_t cached = 0;
+            std::uintptr_t walked_to = 0;
+            for (const Region &span : ranges.ranges())
+            {
+                const std::uintptr_t begin = std::max(span.base.raw(), walked_to);
+                const std::uintptr_t end = span.end().raw();
+                if (begin < end)
+                    cached += prewarm_span(begin, end, shard_count, walked_to);
+            }
+            return cached;
+        }
+
         bool is_readable(Region range) noexcept
         {
             return check_memory_permission(range.base.raw(), range.size, check_read_permission);
@@ -1422,7 +2215,7 @@ namespace DetourModKit
         {
             const std::uintptr_t address = range.base.raw();
             const std::size_t size = range.size;
-            if (address == 0 || size == 0)
+            if (address == 0 || size == 0 || address >= USERSPACE_PTR_MAX)
                 return ReadableStatus::NotReadable;
 
             ActiveReaderGuard reader_guard;
@@ -1437,14 +2230,32 @@ namespace DetourModKit
                                                                                        : ReadableStatus::NotReadable;
             }
 
-            const std::size_t shard_count = s_shard_count.load(std::memory_order_acquire);
+            const std::size_t shard_count = s_shard_count.load(std::memory_order_seq_cst);
             if (shard_count == 0)
                 return ReadableStatus::Unknown;
 
-            const std::size_t shard_idx = compute_shard_index(address, shard_count);
             const std::uint64_t now_ns = current_time_ns();
             const std::uint64_t expiry_ns = configured_expiry_ns();
 
+            // The L0 and fast table never block, so they are consulted first; a miss there still tries the shard.
+            const std::uint64_t generation = s_fast_generation.load(std::memory_order_acquire);
+            ReaderStripe &stripe = reader_guard.stripe();
+            if (const std::optional<RegionSnapshot> fast =
+                    fast_lookup(stripe, address, size, now_ns, expiry_ns, generation))
+            {
+                reader_guard.count_fast_hit(*fast, now_ns, expiry_ns);
+                return (fast->state == MEM_COMMIT && check_read_permission(fast->protection))
+                           ? ReadableStatus::Readable
+                           : ReadableStatus::NotReadable;
+            }
+            if (negative_lookup(address, now_ns, generation))
+            {
+                reader_guard.count_negative_hit();
+                return ReadableStatus::NotReadable;
+            }
+
+            const std::size_t shard_idx = compute_shard_index(address, shard_count);
+
             // Non-blocking: try_lock_shared so a latency-sensitive thread is never stalled on a contended shard.
             std::shared_lock<SrwSharedMutex> lock(s_cache_shards[shard_idx].mtx, std::try_to_lock);
             if (!lock.owns_lock())
@@ -1455,6 +2266,12 @@ namespace DetourModKit
             if (cached_info)
             {
                 s_cache_shards[shard_idx].hits.fetch_add(1, std::memory_order_relaxed);
+                if (now_ns - cached_info->timestamp_ns > expiry_ns)
+                    s_cache_shards[shard_idx].pinned_hits.fetch_add(1, std::memory_order_relaxed);
+                fast_publish(stripe, address,
+                             snapshot_of(cached_info->base_address, cached_info->region_size, cached_info->protection,
+                                         cached_info->state, cached_info->timestamp_ns, entry_pinned(*cached_info)),
+                             generation);
                 // Require MEM_COMMIT alongside the read permission, symmetric with the blocking hit path and the miss
                 // paths: a non-committed cached region is never readable even if its protection bits looked permissive.
                 return (cached_info->state == MEM_COMMIT && check_read_permission(cached_info->protection))
@@ -1465,5 +2282,73 @@ namespace DetourModKit
             // Cache miss under non-blocking semantics: return Unknown rather than issuing a VirtualQuery.
             return ReadableStatus::Unknown;
         }
+
+        Result<std::size_t> is_readable_batch(std::span<const Address> addresses, std::size_t bytes,
+                                              std::span<std::uint8_t> out) noexcept
+        {
+            if (out.size() < addresses.size())
+                return std::unexpected(Error{ErrorCode::InvalidArg, "memory::is_readable_batch"});
+
+            if (bytes == 0)
+            {
+                std::fill_n(out.begin(), addresses.size(), std::uint8_t{0});
+                return std::size_t{0};
+            }
+
+            // One guard for the whole batch, taken before the s_cache_initialized load exactly as the single-address
+            // predicates do, so shutdown_cache cannot free the shard array under any of the resolves below.
+            ActiveReaderGuard reader_guard;
+            const bool cache_initialized = s_cache_initialized.load(std::memory_order_seq_cst);
+            const std::size_t shard_count = cache_initialized ? s_shard_count.load(std::memory_order_seq_cst) : 0;
+
+            std::array<RegionSnapshot, BATCH_REGION_SLOTS> regions{};
+            std::size_t region_count = 0;
+            std::size_t next_slot = 0;
+            std::size_t readable = 0;
+
+            for (std::size_t i = 0; i < addresses.size(); ++i)
+            {
+                const std::uintptr_t address = addresses[i].raw();
+                bool verdict = false;
+                if (address != 0 && address < USERSPACE_PTR_MAX)
+                {
+                    // The batch-local table is plain memory owned by this call: a hit is a pair of compares, with no
+                    // atomic, clock read, or lock.
+                    const RegionSnapshot *region = nullptr;
+                    for (std::size_t slot = 0; slot < region_count; ++slot)
+                    {
+                        if (address >= regions[slot].base && address < regions[slot].end)
+                        {
+                            region = &regions[slot];
+                            break;
+                        }
+                    }
+                    if (region == nullptr)
+                    {
+                        // Resolve by the address alone (size 1): the region is what the table remembers, and the
+                        // span is checked against it below, so one resolve serves every address inside it.
+                        const std::optional<RegionSnapshot> resolved =
+                            shard_count == 0 ? query_region_uncached(address)
+                                             : resolve_region(reader_guard, address, 1, shard_count);
+                        if (resolved)
+                        {
+                            const std::size_t slot =
+                                region_count < BATCH_REGION_SLOTS ? region_count++ : next_slot++ % BATCH_REGION_SLOTS;
+                            regions[slot] = *resolved;
+                            region = &regions[slot];
+                        }
+                    }
+                    verdict = region != nullptr && permission_in_region(*region, address, bytes, check_read_permission);
+                }
+                out[i] = verdict ? 1 : 0;
+                readable += verdict ? 1 : 0;
+            }
+            return readable;
+        }
     } // namespace memory
+
+    std::uint64_t detail::protection_cache_generation() noexcept
+    {
+        return memory::s_fast_generation.load(std::memory_order_acquire);
+    }
 } // namespace DetourModKit
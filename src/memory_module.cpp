@@ -1,19 +1,27 @@
 /**
  * @file memory_module.cpp
- * @brief Module-presence and address-to-module queries: memory::module_of and memory::is_module_loaded.
+ * @brief Module-presence and address-to-module queries: memory::module_of, memory::is_in_module, and
+ *        memory::is_module_loaded.
  *
  * module_of answers "which loaded image owns this pointer, and what is its full mapped span?" by resolving the owning
  * module handle through the loader and reading its PE headers via the guarded read engine (so a partially-mapped or
  * corrupt image fails closed instead of faulting the host); results are cached per module handle for the process
- * lifetime. is_module_loaded answers "is a module with this base name present?" against the loader's own table rather
- * than a from-scratch enumeration.
+ * lifetime. While the memory cache is initialized, a loader-notification-maintained table of loaded image spans
+ * answers module_of with a lock-free binary search instead. is_module_loaded answers "is a module with this base name
+ * present?" against the loader's own table rather than a from-scratch enumeration.
  */
 
 #include "DetourModKit/memory.hpp"
+#include "internal/loader_notification.hpp"
+#include "internal/memory_guarded.hpp"
 #include "internal/srw_shared_mutex.hpp"
 
 #include <windows.h>
+#include <psapi.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
 #include <cwchar>
 #include <mutex>
@@ -22,11 +30,18 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 namespace DetourModKit
 {
     namespace
     {
+        using DetourModKit::detail::LDR_DLL_NOTIFICATION_REASON_LOADED;
+        using DetourModKit::detail::LDR_DLL_NOTIFICATION_REASON_UNLOADED;
+        using DetourModKit::detail::LdrRegisterDllNotificationFunction;
+        using DetourModKit::detail::LdrUnregisterDllNotificationFunction;
+        using DetourModKit::detail::LoaderDllNotificationData;
+        using DetourModKit::detail::ntdll_export;
         using DetourModKit::detail::SrwSharedMutex;
 
         /**
@@ -46,9 +61,10 @@ namespace DetourModKit
          *          (2) every consumer feeds the span to the guarded read/scan engine, so a stale (larger) span at worst
          *          over-scans into adjacent mappings whose faults are contained, never a crash or UB; (3) DMK resolves
          *          module ranges at init for images that do not unload mid-session (the host EXE, the mod's own DLL).
-         *          The alternative -- hooking loader unload notifications to evict -- is disproportionate machinery for
-         *          this fault-contained, rare (base-reuse-after-unload) case. Callers that must track a module across an
-         *          unload/reload should resolve the range fresh at the point of use instead of caching a handle.
+         *          While the loaded-module table is installed (init_cache to shutdown_cache) its unload notification
+         *          also evicts the unloaded handle here, closing the base-reuse window; outside that window callers
+         *          that must track a module across an unload/reload should resolve the range fresh at the point of use
+         *          instead of caching a handle.
          */
         struct ModuleRangeCache
         {
@@ -61,6 +77,247 @@ namespace DetourModKit
             static ModuleRangeCache cache;
             return cache;
         }
+
+        /// The offline::MappedImage copies module_of falls back to; a handful at most, searched linearly.
+        struct MappedImageTable
+        {
+            SrwSharedMutex mutex;
+            std::vector<Region> images;
+            /// Entries currently published; lets every module_of miss skip the lock while no copy exists.
+            std::atomic<std::size_t> count{0};
+        };
+
+        [[nodiscard]] MappedImageTable &mapped_image_table() noexcept
+        {
+            static MappedImageTable table;
+            return table;
+        }
+
+        /// Loaded modules the table can hold before it marks itself incomplete and module_of falls back to the loader.
+        constexpr std::size_t MODULE_TABLE_CAPACITY = 2048;
+
+        /// One loaded image's [base, end) span, stored as two atomics so a seqlock reader never races a plain store.
+        struct ModuleSpanSlot
+        {
+            std::atomic<std::uintptr_t> base{0};
+            std::atomic<std::uintptr_t> end{0};
+        };
+
+        /**
+         * @struct LoadedModuleTable
+         * @brief Sorted [base, end) spans of every loaded image, readable without a lock.
+         * @details Turns module_of from a GetModuleHandleExW loader-lock acquisition into a binary search, so RTTI
+         *          plausibility checks and vtable-in-image gates can afford it per candidate. It is filled once by
+         *          install_module_table and kept current by a loader DLL notification, whose callback runs under the
+         *          loader lock and only ever takes @ref writer -- nothing that holds @ref writer calls into the loader,
+         *          so the two locks never nest the other way. Readers take no lock: the writer bumps @ref sequence to
+         *          odd, edits the slots, and bumps it back to even, and a reader retries a search that straddled an
+         *          edit, the same seqlock the protection cache's fast table uses. The slots are static storage, so a
+         *          reader racing release_module_table reads stale spans rather than freed memory.
+         */
+        struct LoadedModuleTable
+        {
+            alignas(64) std::atomic<std::uint64_t> sequence{0};
+            std::atomic<std::size_t> count{0};
+            /// True while the spans are authoritative: populated, subscribed, and never overflowed.
+            std::atomic<bool> active{false};
+            /// Bumped by every unload notification, so install_module_table can tell its enumeration went stale.
+            std::atomic<std::uint64_t> unloads{0};
+            /// True while the loader notification is registered, so every unload reaches @ref unloads.
+            std::atomic<bool> subscribed{false};
+            /// Guards the slots, count, and overflowed. Never held across a loader call.
+            std::mutex writer;
+            bool overflowed = false;
+            /// Serializes install / release; held across the loader (un)registration, never inside a notification.
+            std::mutex lifecycle;
+            void *cookie = nullptr;
+            std::array<ModuleSpanSlot, MODULE_TABLE_CAPACITY> slots;
+        };
+
+        [[nodiscard]] LoadedModuleTable &loaded_module_table() noexcept
+        {
+            static LoadedModuleTable table;
+            return table;
+        }
+
+        /// Outcome of a lock-free table probe: the owning span, an authoritative miss, or unknown (retries spent).
+        enum class TableProbe
+        {
+            Hit,
+            Miss,
+            Unknown
+        };
+
+        [[nodiscard]] TableProbe probe_module_table(std::uintptr_t address, Region &out) noexcept
+        {
+            LoadedModuleTable &table = loaded_module_table();
+            constexpr int max_attempts = 4;
+            for (int attempt = 0; attempt < max_attempts; ++attempt)
+            {
+                const std::uint64_t before = table.sequence.load(std::memory_order_acquire);
+                if ((before & 1) != 0)
+                {
+                    continue;
+                }
+                const std::size_t count = std::min(table.count.load(std::memory_order_relaxed), MODULE_TABLE_CAPACITY);
+                // The last span whose base is <= address is the only candidate; spans never overlap.
+                std::size_t lo = 0;
+                std::size_t hi = count;
+                while (lo < hi)
+                {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (table.slots[mid].base.load(std::memory_order_relaxed) <= address)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                std::uintptr_t base = 0;
+                std::uintptr_t end = 0;
+                if (lo != 0)
+                {
+                    base = table.slots[lo - 1].base.load(std::memory_order_relaxed);
+                    end = table.slots[lo - 1].end.load(std::memory_order_relaxed);
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (table.sequence.load(std::memory_order_relaxed) != before)
+                {
+                    continue;
+                }
+                if (base != 0 && address < end)
+                {
+                    out = Region{Address{base}, static_cast<std::size_t>(end - base)};
+                    return TableProbe::Hit;
+                }
+                return TableProbe::Miss;
+            }
+            return TableProbe::Unknown;
+        }
+
+        // Writer-side edits; the caller holds LoadedModuleTable::writer.
+        struct ModuleTableEdit
+        {
+            LoadedModuleTable &table;
+            std::uint64_t sequence;
+
+            explicit ModuleTableEdit(LoadedModuleTable &owner) noexcept
+                : table(owner), sequence(owner.sequence.load(std::memory_order_relaxed))
+            {
+                table.sequence.store(sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+            }
+
+            ~ModuleTableEdit() { table.sequence.store(sequence + 2, std::memory_order_release); }
+
+            ModuleTableEdit(const ModuleTableEdit &) = delete;
+            ModuleTableEdit &operator=(const ModuleTableEdit &) = delete;
+
+            [[nodiscard]] std::size_t lower_bound(std::size_t count, std::uintptr_t base) const noexcept
+            {
+                std::size_t lo = 0;
+                std::size_t hi = count;
+                while (lo < hi)
+                {
+                    const std::size_t mid = lo + (hi - lo) / 2;
+                    if (table.slots[mid].base.load(std::memory_order_relaxed) < base)
+                        lo = mid + 1;
+                    else
+                        hi = mid;
+                }
+                return lo;
+            }
+
+            void move_slot(std::size_t to, std::size_t from) noexcept
+            {
+                table.slots[to].base.store(table.slots[from].base.load(std::memory_order_relaxed),
+                                           std::memory_order_relaxed);
+                table.slots[to].end.store(table.slots[from].end.load(std::memory_order_relaxed),
+                                          std::memory_order_relaxed);
+            }
+
+            void insert(Region image) noexcept
+            {
+                const std::uintptr_t base = image.base.raw();
+                const std::size_t count = table.count.load(std::memory_order_relaxed);
+                const std::size_t at = lower_bound(count, base);
+                if (at < count && table.slots[at].base.load(std::memory_order_relaxed) == base)
+                {
+                    // Already present (the initial enumeration and a notification both reported it); refresh its end.
+                    table.slots[at].end.store(image.end().raw(), std::memory_order_relaxed);
+                    return;
+                }
+                if (count == MODULE_TABLE_CAPACITY)
+                {
+                    // An unrecorded module would turn its lookups into false misses, so stop claiming authority.
+                    table.overflowed = true;
+                    table.active.store(false, std::memory_order_release);
+                    return;
+                }
+                for (std::size_t i = count; i > at; --i)
+                {
+                    move_slot(i, i - 1);
+                }
+                table.slots[at].base.store(base, std::memory_order_relaxed);
+                table.slots[at].end.store(image.end().raw(), std::memory_order_relaxed);
+                table.count.store(count + 1, std::memory_order_relaxed);
+            }
+
+            void erase(std::uintptr_t base) noexcept
+            {
+                const std::size_t count = table.count.load(std::memory_order_relaxed);
+                const std::size_t at = lower_bound(count, base);
+                if (at == count || table.slots[at].base.load(std::memory_order_relaxed) != base)
+                {
+                    return;
+                }
+                for (std::size_t i = at; i + 1 < count; ++i)
+                {
+                    move_slot(i, i + 1);
+                }
+                table.count.store(count - 1, std::memory_order_relaxed);
+            }
+        };
+
+        // Runs under the loader lock: it must not call back into the loader, so it only edits the span table (under a
+        // lock no loader-calling path holds) and drops a handle-cache entry an unload just made stale.
+        VOID CALLBACK on_dll_notification(ULONG reason, const LoaderDllNotificationData *data, PVOID) noexcept
+        {
+            if (data == nullptr || data->dll_base == nullptr)
+            {
+                return;
+            }
+            const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(data->dll_base);
+            LoadedModuleTable &table = loaded_module_table();
+            if (reason == LDR_DLL_NOTIFICATION_REASON_LOADED && data->size_of_image != 0)
+            {
+                {
+                    std::lock_guard<std::mutex> lock(table.writer);
+                    ModuleTableEdit edit(table);
+                    edit.insert(Region{Address{base}, static_cast<std::size_t>(data->size_of_image)});
+                }
+                // The image now occupies a range the protection cache may hold as unmapped.
+                memory::invalidate_range(Region{Address{base}, static_cast<std::size_t>(data->size_of_image)});
+            }
+            else if (reason == LDR_DLL_NOTIFICATION_REASON_UNLOADED)
+            {
+                table.unloads.fetch_add(1, std::memory_order_acq_rel);
+                {
+                    std::lock_guard<std::mutex> lock(table.writer);
+                    ModuleTableEdit edit(table);
+                    edit.erase(base);
+                }
+                {
+                    ModuleRangeCache &cache = module_range_cache();
+                    std::unique_lock<SrwSharedMutex> lock(cache.mutex);
+                    cache.entries.erase(reinterpret_cast<HMODULE>(base));
+                }
+                // The protection cache holds image regions past its expiry while this notification is subscribed, so
+                // the unmapped image's regions must leave it now. invalidate_range only try-locks, so it is safe here.
+                if (data->size_of_image != 0)
+                {
+                    memory::invalidate_range(Region{Address{base}, static_cast<std::size_t>(data->size_of_image)});
+                }
+            }
+        }
     } // namespace
 
     namespace detail
@@ -148,6 +405,167 @@ namespace DetourModKit
             }
             return range;
         }
+
+        bool register_mapped_image(Region image) noexcept
+        {
+            MappedImageTable &table = mapped_image_table();
+            try
+            {
+                std::unique_lock<SrwSharedMutex> lock(table.mutex);
+                table.images.push_back(image);
+                table.count.store(table.images.size(), std::memory_order_release);
+                return true;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return false;
+            }
+        }
+
+        void unregister_mapped_image(Address base) noexcept
+        {
+            MappedImageTable &table = mapped_image_table();
+            std::unique_lock<SrwSharedMutex> lock(table.mutex);
+            std::erase_if(table.images, [base](const Region &image) { return image.base == base; });
+            table.count.store(table.images.size(), std::memory_order_release);
+        }
+
+        Region mapped_image_containing(Address address) noexcept
+        {
+            MappedImageTable &table = mapped_image_table();
+            if (table.count.load(std::memory_order_acquire) == 0)
+            {
+                return Region{};
+            }
+            std::shared_lock<SrwSharedMutex> lock(table.mutex);
+            const auto it = std::find_if(table.images.begin(), table.images.end(),
+                                         [address](const Region &image) { return image.contains(address); });
+            return it != table.images.end() ? *it : Region{};
+        }
+
+        bool install_module_table() noexcept
+        {
+            LoadedModuleTable &table = loaded_module_table();
+            std::lock_guard<std::mutex> lifecycle(table.lifecycle);
+            if (table.cookie != nullptr)
+            {
+                return true;
+            }
+
+            // Subscribe before enumerating, so a module loaded in between is reported by the notification rather than
+            // missed; the duplicate the enumeration then also finds is merged by insert.
+            const auto register_notification = reinterpret_cast<LdrRegisterDllNotificationFunction>(
+                ntdll_export("LdrRegisterDllNotification"));
+            if (register_notification == nullptr ||
+                register_notification(0, &on_dll_notification, nullptr, &table.cookie) != 0 || table.cookie == nullptr)
+            {
+                table.cookie = nullptr;
+                return false;
+            }
+            table.subscribed.store(true, std::memory_order_release);
+
+            // Enumerate and resolve outside the writer lock (the enumeration reads loader state), then publish under
+            // it. An unload notification in between could otherwise leave a span for an image that is already gone,
+            // so a changed unload count discards the pass and enumerates again.
+            constexpr int max_passes = 4;
+            for (int pass = 0; pass < max_passes; ++pass)
+            {
+                const std::uint64_t unloads_before = table.unloads.load(std::memory_order_acquire);
+                std::vector<Region> images;
+                try
+                {
+                    std::vector<HMODULE> modules(256);
+                    DWORD needed = 0;
+                    while (true)
+                    {
+                        const DWORD capacity = static_cast<DWORD>(modules.size() * sizeof(HMODULE));
+                        if (!::K32EnumProcessModules(::GetCurrentProcess(), modules.data(), capacity, &needed))
+                        {
+                            return true;
+                        }
+                        if (needed <= capacity)
+                        {
+                            modules.resize(needed / sizeof(HMODULE));
+                            break;
+                        }
+                        modules.resize(needed / sizeof(HMODULE) + 16);
+                    }
+                    images.reserve(modules.size());
+                    for (const HMODULE module : modules)
+                    {
+                        const Region span = module_image_region(Address{module});
+                        if (span.base && span.size != 0)
+                        {
+                            images.push_back(span);
+                        }
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    // Without a complete enumeration the table cannot answer misses; module_of keeps the loader path.
+                    return true;
+                }
+
+                std::lock_guard<std::mutex> lock(table.writer);
+                if (table.unloads.load(std::memory_order_acquire) != unloads_before)
+                {
+                    continue;
+                }
+                {
+                    ModuleTableEdit edit(table);
+                    for (const Region &image : images)
+                    {
+                        edit.insert(image);
+                    }
+                }
+                table.active.store(!table.overflowed, std::memory_order_release);
+                return true;
+            }
+            // Unloads kept racing the enumeration; the table stays inactive but the subscription still reports unloads.
+            return true;
+        }
+
+        void release_module_table() noexcept
+        {
+            LoadedModuleTable &table = loaded_module_table();
+            std::lock_guard<std::mutex> lifecycle(table.lifecycle);
+            if (table.cookie == nullptr)
+            {
+                return;
+            }
+            table.active.store(false, std::memory_order_release);
+            table.subscribed.store(false, std::memory_order_release);
+
+            // Unregistering waits out a notification already running, so once it returns nothing edits the table.
+            const auto unregister_notification = reinterpret_cast<LdrUnregisterDllNotificationFunction>(
+                ntdll_export("LdrUnregisterDllNotification"));
+            if (unregister_notification != nullptr)
+            {
+                (void)unregister_notification(table.cookie);
+            }
+            table.cookie = nullptr;
+            // Unloads from here until the next subscription go unseen, so an epoch read before now must not match one
+            // read after it.
+            table.unloads.fetch_add(1, std::memory_order_acq_rel);
+
+            std::lock_guard<std::mutex> lock(table.writer);
+            ModuleTableEdit edit(table);
+            table.count.store(0, std::memory_order_relaxed);
+            table.overflowed = false;
+        }
+
+        std::optional<std::uint64_t> module_unload_epoch() noexcept
+        {
+            const LoadedModuleTable &table = loaded_module_table();
+            // Read the counter before the flag: a release in between then reports nullopt rather than a pre-release
+            // value the bump in release_module_table has already moved past.
+            const std::uint64_t unloads = table.unloads.load(std::memory_order_acquire);
+            if (!table.subscribed.load(std::memory_order_acquire))
+            {
+                return std::nullopt;
+            }
+            return unloads;
+        }
     } // namespace detail
 
     namespace memory
@@ -194,6 +612,22 @@ namespace DetourModKit
                 return Region{};
             }
 
+            // While the loaded-module table is live it answers without the loader: a hit is the owning image, and a
+            // miss is authoritative for loaded modules, leaving only the offline copies to check.
+            if (loaded_module_table().active.load(std::memory_order_acquire))
+            {
+                Region owner{};
+                const TableProbe probe = probe_module_table(address.raw(), owner);
+                if (probe == TableProbe::Hit)
+                {
+                    return owner;
+                }
+                if (probe == TableProbe::Miss)
+                {
+                    return detail::mapped_image_containing(address);
+                }
+            }
+
             // FROM_ADDRESS resolves the module that contains the address; UNCHANGED_REFCOUNT looks it up without taking
             // a reference, matching the transient-scope contract a Region keeps.
             HMODULE owning_module = nullptr;
@@ -202,7 +636,8 @@ namespace DetourModKit
                                       address.as<LPCWSTR>(), &owning_module) ||
                 owning_module == nullptr)
             {
-                return Region{};
+                // Not a loaded module, but possibly an offline::MappedImage copy standing in for one.
+                return detail::mapped_image_containing(address);
             }
 
             // The resolved image span is cached per module handle by cached_module_image_region, so a repeated probe of
@@ -210,6 +645,15 @@ namespace DetourModKit
             return detail::cached_module_image_region(Address{owning_module});
         }
 
+        bool is_in_module(Address address, Address module_base) noexcept
+        {
+            if (!address || !module_base)
+            {
+                return false;
+            }
+            return module_of(address).base == module_base;
+        }
+
         bool is_module_loaded(std::string_view basename, bool case_insensitive) noexcept
         {
             const std::wstring wide_name = widen_module_name(basename);
@@ -1,6 +1,7 @@
 /**
  * @file memory_protect.cpp
- * @brief Implementation of memory::ProtectGuard, the move-only RAII page-protection change.
+ * @brief Implementation of memory::ProtectGuard, the move-only RAII page-protection change, and memory::PatchBatch,
+ *        which applies many patches under one protection change per page run.
  *
  * The guard captures a region's prior protection at construction and restores it on destruction, factoring the
  * VirtualProtect dance out of any caller that patches or writes a region repeatedly. The captured base / size /
@@ -14,10 +15,13 @@
 
 #include <windows.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <new>
+#include <numeric>
 #include <utility>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -25,6 +29,8 @@ namespace DetourModKit
     {
         // The per-region protection helpers live in DetourModKit::detail; pull them in with using-declarations so the
         // ProtectGuard::Impl definition and make()/restore paths can name them unqualified.
+        using DetourModKit::detail::guarded_read_bytes;
+        using DetourModKit::detail::guarded_write_bytes;
         using DetourModKit::detail::MAX_PROTECTION_SEGMENTS;
         using DetourModKit::detail::protect_across_regions;
         using DetourModKit::detail::ProtectionSegment;
@@ -58,6 +64,21 @@ namespace DetourModKit
                     return PAGE_READONLY;
                 return PAGE_NOACCESS;
             }
+
+            [[nodiscard]] std::uintptr_t system_page_size() noexcept
+            {
+                SYSTEM_INFO info{};
+                GetSystemInfo(&info);
+                return info.dwPageSize != 0 ? static_cast<std::uintptr_t>(info.dwPageSize) : 0x1000;
+            }
+
+            // A page-aligned span touched by one or more patches. Overlapping and touching spans merge, so each run is
+            // protected, flushed, and restored once.
+            struct PageRun
+            {
+                std::uintptr_t base = 0;
+                std::uintptr_t end = 0;
+            };
         } // namespace
 
         // The captured protection state. Kept in the .cpp so the installed header never names a Win32 type. The
@@ -180,5 +201,188 @@ namespace DetourModKit
             guard.m_impl = std::move(impl);
             return guard;
         }
+
+        Result<void> PatchBatch::add(Address address, std::span<const std::byte> bytes) noexcept
+        {
+            if (!address)
+            {
+                return std::unexpected(
+                    Error{ErrorCode::NullTargetAddress, "memory::PatchBatch::add", address.raw(), 0});
+            }
+            if (bytes.data() == nullptr && !bytes.empty())
+            {
+                return std::unexpected(Error{ErrorCode::NullSourceBytes, "memory::PatchBatch::add", address.raw(), 0});
+            }
+            if (bytes.empty())
+            {
+                return {};
+            }
+            if (bytes.size() > MAX_WRITE_SIZE || bytes.size() > UINTPTR_MAX - address.raw())
+            {
+                return std::unexpected(Error{ErrorCode::SizeTooLarge, "memory::PatchBatch::add", address.raw(), 0});
+            }
+
+            const std::size_t offset = m_bytes.size();
+            try
+            {
+                // Reserve the patch slot first, so the push_back after the byte copy cannot throw and strand bytes.
+                m_patches.reserve(m_patches.size() + 1);
+                m_bytes.insert(m_bytes.end(), bytes.begin(), bytes.end());
+            }
+            catch (const std::bad_alloc &)
+            {
+                m_bytes.resize(offset);
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::PatchBatch::add", address.raw(), 0});
+            }
+            m_patches.push_back(Patch{address.raw(), offset, bytes.size()});
+            return {};
+        }
+
+        void PatchBatch::clear() noexcept
+        {
+            m_patches.clear();
+            m_bytes.clear();
+        }
+
+        Result<void> PatchBatch::apply() const noexcept
+        {
+            if (m_patches.empty())
+            {
+                return {};
+            }
+
+            // Every allocation happens before the first VirtualProtect, so an OOM leaves no page touched: the patch
+            // order, the page runs, the captured segments, and the buffer that holds the bytes each patch overwrites.
+            // A run crossing several protection regions can still outgrow the segment reservation; that growth is
+            // caught below and rolled back.
+            std::vector<std::size_t> order;
+            std::vector<PageRun> runs;
+            std::vector<ProtectionSegment> segments;
+            std::vector<std::byte> originals;
+            try
+            {
+                order.resize(m_patches.size());
+                runs.reserve(m_patches.size());
+                segments.reserve(m_patches.size());
+                originals.resize(m_bytes.size());
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::PatchBatch::apply"});
+            }
+            std::iota(order.begin(), order.end(), std::size_t{0});
+            std::sort(order.begin(), order.end(), [this](std::size_t lhs, std::size_t rhs) noexcept
+                      { return m_patches[lhs].address < m_patches[rhs].address; });
+
+            // Overlapping patches have no well-defined result, so they are rejected before anything is touched. Each
+            // patch's pages join the previous run when they overlap or touch it.
+            const std::uintptr_t page = system_page_size();
+            std::uintptr_t previous_end = 0;
+            for (const std::size_t index : order)
+            {
+                const Patch &patch = m_patches[index];
+                if (patch.address < previous_end)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "memory::PatchBatch::apply", patch.address, 0});
+                }
+                previous_end = patch.address + patch.size;
+
+                const std::uintptr_t run_base = patch.address & ~(page - 1);
+                const std::uintptr_t run_end = (previous_end + page - 1) & ~(page - 1);
+                if (!runs.empty() && run_base <= runs.back().end)
+                {
+                    runs.back().end = std::max(runs.back().end, run_end);
+                }
+                else
+                {
+                    runs.push_back(PageRun{run_base, run_end});
+                }
+            }
+            const Region extent{Address{runs.front().base},
+                                static_cast<std::size_t>(runs.back().end - runs.front().base)};
+
+            // Make every run writable before writing anything, so a run that cannot be changed fails the batch with no
+            // byte written. PAGE_EXECUTE_READWRITE keeps a code page executable, as the write_bytes slow path does.
+            for (const PageRun &run : runs)
+            {
+                ProtectionSegment local[MAX_PROTECTION_SEGMENTS];
+                std::uint32_t os_error = 0;
+                const std::size_t count =
+                    protect_across_regions(run.base, static_cast<std::size_t>(run.end - run.base),
+                                           PAGE_EXECUTE_READWRITE, local, MAX_PROTECTION_SEGMENTS, os_error);
+                ErrorCode failure = ErrorCode::ProtectionChangeFailed;
+                if (count != 0)
+                {
+                    try
+                    {
+                        segments.insert(segments.end(), local, local + count);
+                        continue;
+                    }
+                    catch (const std::bad_alloc &)
+                    {
+                        std::uint32_t rollback_error = 0;
+                        (void)restore_across_regions(local, count, rollback_error);
+                        failure = ErrorCode::OutOfMemory;
+                    }
+                }
+                std::uint32_t rollback_error = 0;
+                (void)restore_across_regions(segments.data(), segments.size(), rollback_error);
+                invalidate_range(extent);
+                return std::unexpected(Error{failure, "memory::PatchBatch::apply", run.base, os_error});
+            }
+
+            // Save each patch's original bytes just before overwriting them. When a store faults part-way, every patch
+            // whose original was saved -- the faulting one included, whose prefix may have landed -- gets it back.
+            std::size_t saved = 0;
+            bool written = true;
+            std::uintptr_t failed_address = 0;
+            for (const std::size_t index : order)
+            {
+                const Patch &patch = m_patches[index];
+                if (!guarded_read_bytes(patch.address, originals.data() + patch.offset, patch.size))
+                {
+                    written = false;
+                    failed_address = patch.address;
+                    break;
+                }
+                ++saved;
+                if (!guarded_write_bytes(patch.address, m_bytes.data() + patch.offset, patch.size))
+                {
+                    written = false;
+                    failed_address = patch.address;
+                    break;
+                }
+            }
+            if (!written)
+            {
+                for (std::size_t i = 0; i < saved; ++i)
+                {
+                    const Patch &patch = m_patches[order[i]];
+                    (void)guarded_write_bytes(patch.address, originals.data() + patch.offset, patch.size);
+                }
+            }
+
+            // Restore and flush on every exit from here: the bytes changed (or were put back), and a stale instruction
+            // stream must never execute them. One flush per run and one cache invalidation cover the whole batch.
+            std::uint32_t restore_error = 0;
+            const bool restored = restore_across_regions(segments.data(), segments.size(), restore_error);
+            for (const PageRun &run : runs)
+            {
+                FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<LPCVOID>(run.base),
+                                      static_cast<SIZE_T>(run.end - run.base));
+            }
+            invalidate_range(extent);
+
+            if (!restored)
+            {
+                return std::unexpected(Error{ErrorCode::ProtectionRestoreFailed, "memory::PatchBatch::apply",
+                                             extent.base.raw(), restore_error});
+            }
+            if (!written)
+            {
+                return std::unexpected(Error{ErrorCode::WriteFaulted, "memory::PatchBatch::apply", failed_address, 0});
+            }
+            return {};
+        }
     } // namespace memory
 } // namespace DetourModKit
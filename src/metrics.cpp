@@ -0,0 +1,271 @@
+/**
+ * @file metrics.cpp
+ * @brief The process-wide metrics registry: named counter, gauge and histogram cells and their sampling.
+ * @details Counter and histogram cells are sharded by thread-id hash, the same way the hook-stats records and the hook
+ *          call gate stripe their counts, so a hot metric recorded from several threads lands on separate cache lines.
+ *          The shards are relaxed atomics rather than thread_local storage: a thread_local's first touch on MinGW
+ *          allocates and may lock, and a metric may be recorded from a hook or under the loader lock. Cells are
+ *          allocated once and never freed, and the registry itself is never destroyed, so a handle stays valid for
+ *          the life of the process.
+ */
+
+#include "DetourModKit/metrics.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+
+#include <windows.h>
+
+namespace DetourModKit
+{
+    namespace detail
+    {
+        namespace
+        {
+            constexpr std::size_t METRIC_SHARD_COUNT = 16;
+
+            // The calling thread's shard, from a multiplicative hash of its id.
+            [[nodiscard]] std::size_t metric_shard() noexcept
+            {
+                return static_cast<std::size_t>(
+                           (static_cast<std::uint64_t>(GetCurrentThreadId()) * 0x9E3779B97F4A7C15ULL) >> 48) %
+                       METRIC_SHARD_COUNT;
+            }
+        } // namespace
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4324) // structure padded due to alignment specifier (intentional, per-shard cache line)
+#endif
+        struct CounterCell
+        {
+            struct alignas(64) Shard
+            {
+                std::atomic<std::uint64_t> total{0};
+            };
+
+            std::array<Shard, METRIC_SHARD_COUNT> shards{};
+        };
+
+        struct GaugeCell
+        {
+            std::atomic<std::int64_t> value{0};
+        };
+
+        struct HistogramCell
+        {
+            struct alignas(64) Shard
+            {
+                std::atomic<std::uint64_t> count{0};
+                std::atomic<std::uint64_t> sum{0};
+                std::array<std::atomic<std::uint64_t>, diagnostics::METRIC_HISTOGRAM_BUCKETS> buckets{};
+            };
+
+            std::array<Shard, METRIC_SHARD_COUNT> shards{};
+        };
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+        namespace
+        {
+            class MetricRegistry
+            {
+            public:
+                // Never destroyed, so a metric recorded or registered from a static destructor finds it.
+                [[nodiscard]] static MetricRegistry &instance()
+                {
+                    static MetricRegistry *const s_instance = new MetricRegistry();
+                    return *s_instance;
+                }
+
+                // The cell registered as @p name, creating it when the name is new; nullptr when the name is empty or
+                // already names a metric of another kind.
+                template <typename Cell>
+                [[nodiscard]] Cell *find_or_add(std::string_view name, diagnostics::MetricKind kind)
+                {
+                    if (name.empty())
+                    {
+                        return nullptr;
+                    }
+                    const std::lock_guard<std::mutex> lock(m_mutex);
+                    for (const Entry &entry : m_entries)
+                    {
+                        if (entry.name == name)
+                        {
+                            return entry.kind == kind ? static_cast<Cell *>(entry.cell) : nullptr;
+                        }
+                    }
+                    Entry entry;
+                    entry.name.assign(name);
+                    entry.kind = kind;
+                    auto cell = std::make_unique<Cell>();
+                    m_entries.push_back(std::move(entry));
+                    m_entries.back().cell = cell.release();
+                    return static_cast<Cell *>(m_entries.back().cell);
+                }
+
+                void collect(std::vector<diagnostics::MetricSample> &out) const
+                {
+                    const std::lock_guard<std::mutex> lock(m_mutex);
+                    out.reserve(out.size() + m_entries.size());
+                    for (const Entry &entry : m_entries)
+                    {
+                        diagnostics::MetricSample &sample = out.emplace_back();
+                        sample.name = entry.name;
+                        sample.kind = entry.kind;
+                        switch (entry.kind)
+                        {
+                        case diagnostics::MetricKind::Counter:
+                            for (const CounterCell::Shard &shard :
+                                 static_cast<const CounterCell *>(entry.cell)->shards)
+                            {
+                                sample.count += shard.total.load(std::memory_order_relaxed);
+                            }
+                            break;
+                        case diagnostics::MetricKind::Gauge:
+                            sample.value =
+                                static_cast<const GaugeCell *>(entry.cell)->value.load(std::memory_order_relaxed);
+                            break;
+                        case diagnostics::MetricKind::Histogram:
+                            for (const HistogramCell::Shard &shard :
+                                 static_cast<const HistogramCell *>(entry.cell)->shards)
+                            {
+                                sample.count += shard.count.load(std::memory_order_relaxed);
+                                sample.sum += shard.sum.load(std::memory_order_relaxed);
+                                for (std::size_t i = 0; i < shard.buckets.size(); ++i)
+                                {
+                                    sample.buckets[i] += shard.buckets[i].load(std::memory_order_relaxed);
+                                }
+                            }
+                            break;
+                        }
+                    }
+                }
+
+            private:
+                struct Entry
+                {
+                    std::string name;
+                    diagnostics::MetricKind kind{diagnostics::MetricKind::Counter};
+                    // A CounterCell, GaugeCell or HistogramCell by kind; intentionally never freed.
+                    void *cell{nullptr};
+                };
+
+                MetricRegistry() = default;
+
+                mutable std::mutex m_mutex;
+                std::vector<Entry> m_entries;
+            };
+
+            template <typename Cell>
+            [[nodiscard]] Result<Cell *> register_metric(std::string_view name, diagnostics::MetricKind kind,
+                                                         const char *where) noexcept
+            {
+                try
+                {
+                    Cell *const cell = MetricRegistry::instance().find_or_add<Cell>(name, kind);
+                    if (cell == nullptr)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidArg, where});
+                    }
+                    return cell;
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+                }
+                catch (...)
+                {
+                    return std::unexpected(Error{ErrorCode::Unknown, where});
+                }
+            }
+        } // namespace
+    } // namespace detail
+
+    namespace diagnostics
+    {
+        void Counter::add(std::uint64_t amount) const noexcept
+        {
+            if (m_cell != nullptr)
+            {
+                m_cell->shards[detail::metric_shard()].total.fetch_add(amount, std::memory_order_relaxed);
+            }
+        }
+
+        void Gauge::set(std::int64_t value) const noexcept
+        {
+            if (m_cell != nullptr)
+            {
+                m_cell->value.store(value, std::memory_order_relaxed);
+            }
+        }
+
+        void Gauge::add(std::int64_t delta) const noexcept
+        {
+            if (m_cell != nullptr)
+            {
+                m_cell->value.fetch_add(delta, std::memory_order_relaxed);
+            }
+        }
+
+        void Histogram::record(std::uint64_t value) const noexcept
+        {
+            if (m_cell == nullptr)
+            {
+                return;
+            }
+            detail::HistogramCell::Shard &shard = m_cell->shards[detail::metric_shard()];
+            const auto bucket = std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(value)),
+                                                      METRIC_HISTOGRAM_BUCKETS - 1);
+            shard.count.fetch_add(1, std::memory_order_relaxed);
+            shard.sum.fetch_add(value, std::memory_order_relaxed);
+            shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Result<Counter> register_counter(std::string_view name)
+        {
+            const Result<detail::CounterCell *> cell =
+                detail::register_metric<detail::CounterCell>(name, MetricKind::Counter,
+                                                            "diagnostics::register_counter");
+            if (!cell)
+            {
+                return std::unexpected(cell.error());
+            }
+            return Counter(*cell);
+        }
+
+        Result<Gauge> register_gauge(std::string_view name)
+        {
+            const Result<detail::GaugeCell *> cell =
+                detail::register_metric<detail::GaugeCell>(name, MetricKind::Gauge, "diagnostics::register_gauge");
+            if (!cell)
+            {
+                return std::unexpected(cell.error());
+            }
+            return Gauge(*cell);
+        }
+
+        Result<Histogram> register_histogram(std::string_view name)
+        {
+            const Result<detail::HistogramCell *> cell =
+                detail::register_metric<detail::HistogramCell>(name, MetricKind::Histogram,
+                                                              "diagnostics::register_histogram");
+            if (!cell)
+            {
+                return std::unexpected(cell.error());
+            }
+            return Histogram(*cell);
+        }
+
+        void collect_metrics(std::vector<MetricSample> &out)
+        {
+            detail::MetricRegistry::instance().collect(out);
+        }
+    } // namespace diagnostics
+} // namespace DetourModKit
@@ -0,0 +1,511 @@
+/**
+ * @file offline.cpp
+ * @brief Offline manifest validation: the PE file layout behind offline::MappedImage and the per-file gate.
+ * @details map() reads the file through a read-only file mapping and builds the image in one private allocation:
+ *          headers and sections copied to their RVAs with every raw extent clamped to the file, base relocations
+ *          applied against the allocation's address, then the whole image protected read-only with the executable
+ *          sections raised to execute-read. Every size and offset the file declares is bounded before it is used, so a
+ *          truncated or hostile file fails as InvalidRange rather than reading past the view or writing past the
+ *          image.
+ */
+
+#include "DetourModKit/offline.hpp"
+
+#include "DetourModKit/anchor.hpp"
+#include "DetourModKit/memory.hpp"
+#include "fork_join.hpp"
+#include "internal/memory_guarded.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // The PE format caps a loadable image at 96 sections; a larger count is a corrupt or hostile header.
+        constexpr std::uint16_t MAX_IMAGE_SECTIONS = 96;
+
+        // The loader refuses an image whose SizeOfImage reaches 4 GiB; anything that large here is corrupt.
+        constexpr std::uint64_t MAX_IMAGE_BYTES = std::uint64_t{0xFFFFFFFF};
+
+        [[nodiscard]] Error map_error(ErrorCode code, std::uintptr_t detail = 0) noexcept
+        {
+            return Error{code, "offline::MappedImage::map", detail};
+        }
+
+        [[nodiscard]] Error last_error(ErrorCode code) noexcept
+        {
+            return map_error(code, static_cast<std::uintptr_t>(::GetLastError()));
+        }
+
+        /// Owns the file handle, its mapping, and the view for the duration of map().
+        struct FileView
+        {
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+            const std::byte *bytes = nullptr;
+            std::size_t size = 0;
+
+            FileView() noexcept = default;
+            FileView(const FileView &) = delete;
+            FileView &operator=(const FileView &) = delete;
+
+            ~FileView() noexcept
+            {
+                if (bytes != nullptr)
+                {
+                    ::UnmapViewOfFile(bytes);
+                }
+                if (mapping != nullptr)
+                {
+                    ::CloseHandle(mapping);
+                }
+                if (file != INVALID_HANDLE_VALUE)
+                {
+                    ::CloseHandle(file);
+                }
+            }
+        };
+
+        [[nodiscard]] std::optional<Error> open_view(const std::filesystem::path &path, FileView &view) noexcept
+        {
+            view.file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr,
+                                      OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (view.file == INVALID_HANDLE_VALUE)
+            {
+                return last_error(ErrorCode::FileOpenFailed);
+            }
+            LARGE_INTEGER size{};
+            if (!::GetFileSizeEx(view.file, &size))
+            {
+                return last_error(ErrorCode::FileOpenFailed);
+            }
+            if (size.QuadPart < static_cast<LONGLONG>(sizeof(IMAGE_DOS_HEADER)))
+            {
+                return map_error(ErrorCode::InvalidRange);
+            }
+            view.mapping = ::CreateFileMappingW(view.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (view.mapping == nullptr)
+            {
+                return last_error(ErrorCode::FileOpenFailed);
+            }
+            view.bytes = static_cast<const std::byte *>(::MapViewOfFile(view.mapping, FILE_MAP_READ, 0, 0, 0));
+            if (view.bytes == nullptr)
+            {
+                return last_error(ErrorCode::FileOpenFailed);
+            }
+            view.size = static_cast<std::size_t>(size.QuadPart);
+            return std::nullopt;
+        }
+
+        /// True when [offset, offset + length) lies inside a buffer of @p size bytes.
+        [[nodiscard]] bool within(std::uint64_t offset, std::uint64_t length, std::uint64_t size) noexcept
+        {
+            return offset <= size && length <= size - offset;
+        }
+
+        /// Copies a T out of @p view at @p offset, or nullopt when it would read past the file.
+        template <typename T>
+        [[nodiscard]] std::optional<T> read_file(const FileView &view, std::uint64_t offset) noexcept
+        {
+            if (!within(offset, sizeof(T), view.size))
+            {
+                return std::nullopt;
+            }
+            T value;
+            std::memcpy(&value, view.bytes + offset, sizeof(T));
+            return value;
+        }
+
+        /// The validated headers map() lays the image out from.
+        struct ImageLayout
+        {
+            IMAGE_NT_HEADERS64 nt{};
+            std::vector<IMAGE_SECTION_HEADER> sections;
+        };
+
+        [[nodiscard]] std::optional<ImageLayout> parse_layout(const FileView &view)
+        {
+            const std::optional<IMAGE_DOS_HEADER> dos = read_file<IMAGE_DOS_HEADER>(view, 0);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0)
+            {
+                return std::nullopt;
+            }
+            const auto nt_offset = static_cast<std::uint64_t>(dos->e_lfanew);
+            const std::optional<IMAGE_NT_HEADERS64> nt = read_file<IMAGE_NT_HEADERS64>(view, nt_offset);
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+                nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC ||
+                nt->FileHeader.NumberOfSections > MAX_IMAGE_SECTIONS || nt->OptionalHeader.SizeOfImage == 0 ||
+                nt->OptionalHeader.SizeOfImage > MAX_IMAGE_BYTES ||
+                nt->OptionalHeader.SizeOfHeaders > nt->OptionalHeader.SizeOfImage)
+            {
+                return std::nullopt;
+            }
+
+            ImageLayout layout;
+            layout.nt = *nt;
+            // The section table follows the optional header, whose size the file header declares (IMAGE_FIRST_SECTION).
+            const std::uint64_t table =
+                nt_offset + offsetof(IMAGE_NT_HEADERS64, OptionalHeader) + nt->FileHeader.SizeOfOptionalHeader;
+            layout.sections.reserve(nt->FileHeader.NumberOfSections);
+            for (std::uint16_t i = 0; i < nt->FileHeader.NumberOfSections; ++i)
+            {
+                const std::optional<IMAGE_SECTION_HEADER> section =
+                    read_file<IMAGE_SECTION_HEADER>(view, table + std::uint64_t{i} * sizeof(IMAGE_SECTION_HEADER));
+                if (!section || section->VirtualAddress >= nt->OptionalHeader.SizeOfImage)
+                {
+                    return std::nullopt;
+                }
+                layout.sections.push_back(*section);
+            }
+            return layout;
+        }
+
+        /// Copies the headers and every section's raw data to their RVAs; the allocation is already zero-filled.
+        [[nodiscard]] bool copy_sections(const FileView &view, const ImageLayout &layout, std::byte *image) noexcept
+        {
+            const std::size_t image_size = layout.nt.OptionalHeader.SizeOfImage;
+            std::memcpy(image, view.bytes, std::min<std::size_t>(layout.nt.OptionalHeader.SizeOfHeaders, view.size));
+            for (const IMAGE_SECTION_HEADER &section : layout.sections)
+            {
+                if (section.SizeOfRawData == 0)
+                {
+                    continue;
+                }
+                if (section.PointerToRawData >= view.size)
+                {
+                    return false;
+                }
+                // The loader copies min(raw, virtual) bytes and zero-fills the rest; a VirtualSize of 0 means "raw".
+                std::size_t length = section.SizeOfRawData;
+                if (section.Misc.VirtualSize != 0)
+                {
+                    length = std::min<std::size_t>(length, section.Misc.VirtualSize);
+                }
+                length = std::min<std::size_t>(length, view.size - section.PointerToRawData);
+                length = std::min<std::size_t>(length, image_size - section.VirtualAddress);
+                std::memcpy(image + section.VirtualAddress, view.bytes + section.PointerToRawData, length);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Applies the image's DIR64 base relocations for a load at @p image.
+         * @details Walks IMAGE_DIRECTORY_ENTRY_BASERELOC block by block in the copied image. ABSOLUTE entries are
+         *          padding; PE32+ images carry no other live type, so one would mean a corrupt table and fails the map
+         *          like a block that runs past the directory or a fixup that lands past the image.
+         */
+        [[nodiscard]] bool apply_relocations(const ImageLayout &layout, std::byte *image) noexcept
+        {
+            const std::uint64_t image_size = layout.nt.OptionalHeader.SizeOfImage;
+            const std::uint64_t delta = reinterpret_cast<std::uintptr_t>(image) - layout.nt.OptionalHeader.ImageBase;
+            const IMAGE_DATA_DIRECTORY &directory =
+                layout.nt.OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC];
+            if (delta == 0 || layout.nt.OptionalHeader.NumberOfRvaAndSizes <= IMAGE_DIRECTORY_ENTRY_BASERELOC ||
+                directory.VirtualAddress == 0 || directory.Size == 0)
+            {
+                return true;
+            }
+            if (!within(directory.VirtualAddress, directory.Size, image_size))
+            {
+                return false;
+            }
+
+            std::uint64_t cursor = directory.VirtualAddress;
+            const std::uint64_t end = cursor + directory.Size;
+            while (end - cursor >= sizeof(IMAGE_BASE_RELOCATION))
+            {
+                IMAGE_BASE_RELOCATION block;
+                std::memcpy(&block, image + cursor, sizeof(block));
+                if (block.SizeOfBlock < sizeof(IMAGE_BASE_RELOCATION) || block.SizeOfBlock > end - cursor)
+                {
+                    return false;
+                }
+                const std::size_t entries = (block.SizeOfBlock - sizeof(IMAGE_BASE_RELOCATION)) / sizeof(WORD);
+                for (std::size_t i = 0; i < entries; ++i)
+                {
+                    WORD entry;
+                    std::memcpy(&entry, image + cursor + sizeof(IMAGE_BASE_RELOCATION) + i * sizeof(WORD),
+                                sizeof(entry));
+                    const unsigned type = entry >> 12;
+                    if (type == IMAGE_REL_BASED_ABSOLUTE)
+                    {
+                        continue;
+                    }
+                    const std::uint64_t target = std::uint64_t{block.VirtualAddress} + (entry & 0x0FFFU);
+                    if (type != IMAGE_REL_BASED_DIR64 || !within(target, sizeof(std::uint64_t), image_size))
+                    {
+                        return false;
+                    }
+                    std::uint64_t value;
+                    std::memcpy(&value, image + target, sizeof(value));
+                    value += delta;
+                    std::memcpy(image + target, &value, sizeof(value));
+                }
+                cursor += block.SizeOfBlock;
+            }
+            return true;
+        }
+
+        /// Protects the whole copy read-only, then raises each executable section to execute-read.
+        [[nodiscard]] bool protect_image(const ImageLayout &layout, std::byte *image) noexcept
+        {
+            const std::size_t image_size = layout.nt.OptionalHeader.SizeOfImage;
+            DWORD previous = 0;
+            if (!::VirtualProtect(image, image_size, PAGE_READONLY, &previous))
+            {
+                return false;
+            }
+            for (const IMAGE_SECTION_HEADER &section : layout.sections)
+            {
+                if ((section.Characteristics & IMAGE_SCN_MEM_EXECUTE) == 0)
+                {
+                    continue;
+                }
+                const std::size_t extent = section.Misc.VirtualSize != 0 ? section.Misc.VirtualSize
+                                                                         : section.SizeOfRawData;
+                const std::size_t length = std::min<std::size_t>(extent, image_size - section.VirtualAddress);
+                if (length != 0 && !::VirtualProtect(image + section.VirtualAddress, length, PAGE_EXECUTE_READ,
+                                                     &previous))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// The file's basename as UTF-8, the spelling a manifest record's module field uses.
+        [[nodiscard]] std::string module_basename(const std::filesystem::path &path)
+        {
+            const std::u8string name = path.filename().u8string();
+            return std::string(reinterpret_cast<const char *>(name.data()), name.size());
+        }
+
+        [[nodiscard]] bool same_module(std::string_view lhs, std::string_view rhs) noexcept
+        {
+            // ASCII-only folding, as the loader's own basename match for the names games ship with.
+            const auto ascii_lower = [](char c) noexcept -> unsigned char
+            {
+                const auto value = static_cast<unsigned char>(c);
+                return (value >= 'A' && value <= 'Z') ? static_cast<unsigned char>(value + ('a' - 'A')) : value;
+            };
+            return lhs.size() == rhs.size() &&
+                   std::equal(lhs.begin(), lhs.end(), rhs.begin(),
+                              [&](char a, char b) { return ascii_lower(a) == ascii_lower(b); });
+        }
+
+        /**
+         * @brief Compiles @p record to resolve within the mapped copy rather than through the loader.
+         * @details A record naming the file's own module is compiled twice: as authored, for its fingerprint verdict,
+         *          and with the module cleared, so Signature::resolve uses the scope it is handed. ExportName folds its
+         *          module into the fingerprint, so the retargeted copy adopts the live fingerprint when the authored
+         *          one matched, keeping the drift verdict the record's own.
+         */
+        [[nodiscard]] Result<manifest::Signature> compile_for_image(const manifest::SignatureRecord &record)
+        {
+            Result<manifest::Signature> authored = manifest::Signature::compile(record);
+            if (!authored || record.module.empty())
+            {
+                return authored;
+            }
+            manifest::SignatureRecord local = record;
+            local.module.clear();
+            Result<manifest::Signature> retargeted = manifest::Signature::compile(std::move(local));
+            if (retargeted && authored->fingerprint_state() == manifest::FingerprintState::Match)
+            {
+                retargeted->recapture_fingerprint();
+            }
+            return retargeted;
+        }
+    } // anonymous namespace
+
+    offline::MappedImage::MappedImage(std::uintptr_t base, std::size_t size, std::uintptr_t preferred_base,
+                                      std::string module_name) noexcept
+        : m_base(base), m_size(size), m_preferred_base(preferred_base), m_module_name(std::move(module_name))
+    {
+    }
+
+    offline::MappedImage::MappedImage(MappedImage &&other) noexcept
+        : m_base(std::exchange(other.m_base, 0)), m_size(std::exchange(other.m_size, 0)),
+          m_preferred_base(other.m_preferred_base), m_module_name(std::move(other.m_module_name))
+    {
+    }
+
+    offline::MappedImage &offline::MappedImage::operator=(MappedImage &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_base = std::exchange(other.m_base, 0);
+            m_size = std::exchange(other.m_size, 0);
+            m_preferred_base = other.m_preferred_base;
+            m_module_name = std::move(other.m_module_name);
+        }
+        return *this;
+    }
+
+    offline::MappedImage::~MappedImage() noexcept
+    {
+        release();
+    }
+
+    void offline::MappedImage::release() noexcept
+    {
+        if (m_base == 0)
+        {
+            return;
+        }
+        detail::unregister_mapped_image(Address{m_base});
+        ::VirtualFree(reinterpret_cast<void *>(m_base), 0, MEM_RELEASE);
+        memory::invalidate_range(Region{Address{m_base}, m_size});
+        m_base = 0;
+        m_size = 0;
+    }
+
+    Result<offline::MappedImage> offline::MappedImage::map(const std::filesystem::path &path,
+                                                           const MapOptions &options) noexcept
+    {
+        try
+        {
+            FileView view;
+            if (const std::optional<Error> failure = open_view(path, view))
+            {
+                return std::unexpected(*failure);
+            }
+            const std::optional<ImageLayout> layout = parse_layout(view);
+            if (!layout)
+            {
+                return std::unexpected(map_error(ErrorCode::InvalidRange));
+            }
+
+            const std::size_t image_size = layout->nt.OptionalHeader.SizeOfImage;
+            auto *const image =
+                static_cast<std::byte *>(::VirtualAlloc(nullptr, image_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+            if (image == nullptr)
+            {
+                return std::unexpected(last_error(ErrorCode::SystemCallFailed));
+            }
+            // The protection cache may hold the range as unmapped from a probe before the allocation.
+            memory::invalidate_range(Region{Address{image}, image_size});
+            // Owns the allocation from here on; registration follows only once the layout is complete.
+            MappedImage mapped(reinterpret_cast<std::uintptr_t>(image), image_size, layout->nt.OptionalHeader.ImageBase,
+                               module_basename(path));
+
+            if (!copy_sections(view, *layout, image) ||
+                (options.apply_relocations && !apply_relocations(*layout, image)))
+            {
+                return std::unexpected(map_error(ErrorCode::InvalidRange));
+            }
+            if (!protect_image(*layout, image))
+            {
+                return std::unexpected(last_error(ErrorCode::SystemCallFailed));
+            }
+            if (!detail::register_mapped_image(mapped.region()))
+            {
+                return std::unexpected(map_error(ErrorCode::OutOfMemory));
+            }
+            return mapped;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(map_error(ErrorCode::OutOfMemory));
+        }
+    }
+
+    Result<offline::ImageReport> offline::validate(const MappedImage &image, const manifest::Manifest &manifest,
+                                                   const manifest::GatePolicy &policy) noexcept
+    {
+        try
+        {
+            ImageReport report;
+            report.module_name = std::string(image.module_name());
+            report.mapped_base = image.region().base.raw();
+            report.preferred_base = image.preferred_base();
+            report.image_size = image.region().size;
+            report.signatures.reserve(manifest.records.size());
+            for (const manifest::SignatureRecord &record : manifest.records)
+            {
+                if (!record.module.empty() && !same_module(record.module, image.module_name()))
+                {
+                    report.skipped.push_back(SkippedRecord{record.label, SkipReason::ForeignModule});
+                    continue;
+                }
+                Result<manifest::Signature> signature = compile_for_image(record);
+                if (!signature)
+                {
+                    report.skipped.push_back(
+                        SkippedRecord{record.label, SkipReason::CompileFailed, signature.error().code});
+                    continue;
+                }
+                report.signatures.push_back(std::move(*signature));
+            }
+            report.gate = manifest::resolve_and_gate(report.signatures, policy, image.region());
+            return report;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "offline::validate"});
+        }
+    }
+
+    Result<offline::ImageReport> offline::validate(const std::filesystem::path &path,
+                                                   const manifest::Manifest &manifest,
+                                                   const manifest::GatePolicy &policy,
+                                                   const MapOptions &options) noexcept
+    {
+        Result<MappedImage> image = MappedImage::map(path, options);
+        if (!image)
+        {
+            return std::unexpected(image.error());
+        }
+        Result<ImageReport> report = validate(*image, manifest, policy);
+        if (report)
+        {
+            try
+            {
+                report->path = path;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "offline::validate"});
+            }
+        }
+        return report;
+    }
+
+    Result<std::vector<Result<offline::ImageReport>>>
+    offline::validate_all(std::span<const std::filesystem::path> paths, const manifest::Manifest &manifest,
+                          const manifest::GatePolicy &policy, std::size_t max_workers,
+                          const MapOptions &options) noexcept
+    {
+        try
+        {
+            return detail::run_fork_join<std::filesystem::path, Result<ImageReport>>(
+                paths, max_workers,
+                [&](const std::filesystem::path &path) { return validate(path, manifest, policy, options); },
+                [](const std::filesystem::path &) noexcept -> Result<ImageReport>
+                { return std::unexpected(Error{ErrorCode::OutOfMemory, "offline::validate_all"}); });
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "offline::validate_all"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::Unknown, "offline::validate_all"});
+        }
+    }
+} // namespace DetourModKit
@@ -49,6 +49,27 @@ namespace DetourModKit::detail
         return cs->OwningThread == reinterpret_cast<HANDLE>(static_cast<uintptr_t>(GetCurrentThreadId()));
     }
 
+    /**
+     * @brief Checks whether the process is exiting: ExitProcess has ended every other thread and is running the
+     *        DLL_PROCESS_DETACH pass.
+     * @details Asks ntdll's RtlDllShutdownInProgress, resolved once through GetProcAddress (safe under the loader
+     *          lock, which every caller of this holds on that pass). It is what tells a static ~Session apart from an
+     *          explicit FreeLibrary, which DllMain would see as a non-null versus null lpReserved. Returns false when
+     *          ntdll does not export the function, so an unknown layout keeps the full teardown.
+     */
+    [[nodiscard]] inline bool is_process_terminating() noexcept
+    {
+        using ShutdownInProgressFn = BOOLEAN(NTAPI *)();
+        static const auto shutdown_in_progress = []() noexcept
+        {
+            const HMODULE ntdll = GetModuleHandleW(L"ntdll.dll");
+            return ntdll == nullptr ? nullptr
+                                    : reinterpret_cast<ShutdownInProgressFn>(
+                                          reinterpret_cast<void *>(GetProcAddress(ntdll, "RtlDllShutdownInProgress")));
+        }();
+        return shutdown_in_progress != nullptr && shutdown_in_progress() != FALSE;
+    }
+
     /**
      * @brief Takes a counted reference on the module DetourModKit is linked into, keeping it mapped while a background
      *        thread runs its code.
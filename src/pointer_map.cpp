@@ -0,0 +1,405 @@
+/**
+ * @file pointer_map.cpp
+ * @brief The reverse pointer map: its packed entries, the chunked parallel build, and the breadth-first path search.
+ * @details The build cuts the scope's writable windows into chunks, and each fork-join worker sweeps one chunk under
+ *          the page-gated scans' fault guard, recording the qwords whose value lands in a writable window. It then
+ *          sorts its own entries by value. The sorted runs are merged pairwise into one array, so the serial tail
+ *          is a merge rather than a full sort. A query is a bounded breadth-first search over that array: every
+ *          lookup is one lower_bound for the lowest value that can reach the current target within max_offset.
+ */
+
+#include "DetourModKit/pointer_map.hpp"
+
+#include "fork_join.hpp"
+#include "internal/memory_fault.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+
+#include "DetourModKit/defines.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Bytes of one build chunk; the same granularity as the value scanner's sweep.
+        constexpr std::size_t POINTER_MAP_CHUNK_BYTES = std::size_t{1} << 20;
+
+        // One (value, slot) entry, each address split into a low dword and a high word. User-mode addresses stay below
+        // USERSPACE_PTR_MAX (2^47), so 48 bits hold them and the entry is 12 bytes instead of 16.
+        struct PackedRef
+        {
+            std::uint32_t value_lo;
+            std::uint32_t slot_lo;
+            std::uint16_t value_hi;
+            std::uint16_t slot_hi;
+
+            [[nodiscard]] std::uintptr_t value() const noexcept
+            {
+                return (static_cast<std::uintptr_t>(value_hi) << 32) | value_lo;
+            }
+            [[nodiscard]] std::uintptr_t slot() const noexcept
+            {
+                return (static_cast<std::uintptr_t>(slot_hi) << 32) | slot_lo;
+            }
+        };
+        static_assert(sizeof(PackedRef) == 12);
+
+        [[nodiscard]] PackedRef pack(std::uintptr_t value, std::uintptr_t slot) noexcept
+        {
+            return PackedRef{static_cast<std::uint32_t>(value), static_cast<std::uint32_t>(slot),
+                             static_cast<std::uint16_t>(value >> 32), static_cast<std::uint16_t>(slot >> 32)};
+        }
+
+        [[nodiscard]] bool by_value(const PackedRef &lhs, const PackedRef &rhs) noexcept
+        {
+            return lhs.value() < rhs.value();
+        }
+
+        struct Chunk
+        {
+            std::uintptr_t base = 0;
+            std::size_t bytes = 0;
+        };
+
+        struct ChunkRefs
+        {
+            std::vector<PackedRef> refs;
+            bool failed = false;
+        };
+
+        struct MapContext
+        {
+            std::uintptr_t base;
+            std::size_t slots;
+            std::span<const detail::ModuleSpan> windows;
+            PackedRef *out;
+            std::size_t found;
+        };
+
+        // The body the build's fault guard wraps: tests each aligned qword of the chunk against the window bounds,
+        // then the windows themselves, and writes only the preallocated entries.
+        DMK_NO_SANITIZE_ADDRESS void map_chunk(void *opaque) noexcept
+        {
+            MapContext &context = *static_cast<MapContext *>(opaque);
+            const std::uintptr_t lo = context.windows.front().base;
+            const std::uintptr_t hi = context.windows.back().end;
+            for (std::size_t i = 0; i < context.slots; ++i)
+            {
+                const std::uintptr_t slot = context.base + i * sizeof(std::uintptr_t);
+                std::uintptr_t value;
+                std::memcpy(&value, reinterpret_cast<const void *>(slot), sizeof(value));
+                if (value < lo || value >= hi || !detail::spans_contain(context.windows, value))
+                {
+                    continue;
+                }
+                context.out[context.found++] = pack(value, slot);
+            }
+        }
+
+        // Runs fn(ctx) over [lo, hi) under the TOCTOU fault guard the page-gated scans use. Returns false when a fault
+        // was swallowed and fn did not complete.
+        bool run_guarded(std::uintptr_t lo, std::uintptr_t hi, void (*fn)(void *) noexcept, void *ctx) noexcept
+        {
+#ifdef _MSC_VER
+            (void)lo;
+            (void)hi;
+            __try
+            {
+                fn(ctx);
+                return true;
+            }
+            __except (detail::guarded_fault_filter(GetExceptionInformation()))
+            {
+                return false;
+            }
+#elif defined(_WIN64)
+            return detail::run_guarded_region(lo, hi, fn, ctx);
+#endif
+        }
+
+        // The scope's writable windows, merged where they touch, so a value test is one binary search.
+        [[nodiscard]] std::vector<detail::ModuleSpan> collect_windows(const RegionSet &scope)
+        {
+            std::vector<Region> spans;
+            if (scope.empty())
+            {
+                spans.push_back(Region::whole_process());
+            }
+            else
+            {
+                spans.assign(scope.ranges().begin(), scope.ranges().end());
+            }
+
+            std::vector<detail::ModuleSpan> windows;
+            for (const Region &span : spans)
+            {
+                for (const detail::ExecutableWindow &window :
+                     detail::collect_writable_windows(detail::module_span(span)))
+                {
+                    const std::uintptr_t end = window.base + window.span;
+                    if (!windows.empty() && windows.back().end == window.base)
+                    {
+                        windows.back().end = end;
+                        continue;
+                    }
+                    windows.push_back(detail::ModuleSpan{window.base, end});
+                }
+            }
+            return windows;
+        }
+
+        // Cuts the windows into 8-byte-aligned chunks, in ascending order.
+        [[nodiscard]] std::vector<Chunk> collect_chunks(std::span<const detail::ModuleSpan> windows)
+        {
+            std::vector<Chunk> chunks;
+            for (const detail::ModuleSpan &window : windows)
+            {
+                std::uintptr_t lo = (window.base + 7) & ~std::uintptr_t{7};
+                while (lo < window.end && window.end - lo >= sizeof(std::uintptr_t))
+                {
+                    const std::size_t bytes = std::min<std::size_t>(window.end - lo, POINTER_MAP_CHUNK_BYTES);
+                    chunks.push_back(Chunk{lo, bytes});
+                    lo += bytes;
+                }
+            }
+            return chunks;
+        }
+
+        // Maps one chunk into an exact-sized, value-sorted entry list. The scratch is allocated before the guard.
+        [[nodiscard]] ChunkRefs map_one(const Chunk &chunk, std::span<const detail::ModuleSpan> windows)
+        {
+            const std::size_t slots = chunk.bytes / sizeof(std::uintptr_t);
+            auto scratch = std::make_unique_for_overwrite<PackedRef[]>(slots);
+            MapContext context{chunk.base, slots, windows, scratch.get(), 0};
+            if (!run_guarded(chunk.base, chunk.base + chunk.bytes, map_chunk, &context))
+            {
+                return ChunkRefs{{}, true};
+            }
+            std::vector<PackedRef> refs(scratch.get(), scratch.get() + context.found);
+            std::sort(refs.begin(), refs.end(), by_value);
+            return ChunkRefs{std::move(refs), false};
+        }
+
+        // One search node: a slot that leads to its parent's address, or the target itself (no parent).
+        struct Node
+        {
+            std::uintptr_t address = 0;
+            std::ptrdiff_t offset = 0;
+            std::size_t parent = SIZE_MAX;
+        };
+
+        struct RankedPath
+        {
+            memory::PointerPath path;
+            bool in_host = false;
+            std::size_t offset_sum = 0;
+        };
+
+        // The chain from a static slot back up to the target: the slot's RVA, then each node's offset to its parent.
+        [[nodiscard]] RankedPath assemble(const std::vector<Node> &nodes, std::size_t terminal, Region module,
+                                          Region host)
+        {
+            RankedPath ranked;
+            ranked.path.base = module.base;
+            ranked.in_host = host.size != 0 && host.base == module.base;
+            ranked.path.steps.push_back(
+                memory::ChainStep{static_cast<std::ptrdiff_t>(nodes[terminal].address - module.base.raw())});
+            for (std::size_t index = terminal; nodes[index].parent != SIZE_MAX; index = nodes[index].parent)
+            {
+                ranked.path.steps.push_back(memory::ChainStep{nodes[index].offset});
+                ranked.offset_sum += static_cast<std::size_t>(nodes[index].offset);
+            }
+            return ranked;
+        }
+    } // namespace
+
+    struct memory::PointerMap::Impl
+    {
+        std::vector<PackedRef> refs;
+        bool incomplete = false;
+    };
+
+    memory::PointerMap::PointerMap(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    memory::PointerMap::PointerMap(PointerMap &&) noexcept = default;
+    memory::PointerMap &memory::PointerMap::operator=(PointerMap &&) noexcept = default;
+    memory::PointerMap::~PointerMap() noexcept = default;
+
+    Result<memory::PointerMap> memory::PointerMap::build(const PointerMapOptions &options) noexcept
+    {
+        try
+        {
+            auto impl = std::make_unique<Impl>();
+            const std::vector<detail::ModuleSpan> windows = collect_windows(options.scope);
+            const std::vector<Chunk> chunks = collect_chunks(windows);
+            const std::size_t workers = detail::in_fork_join_worker() ? 1 : options.max_workers;
+            std::vector<ChunkRefs> mapped = detail::run_fork_join<Chunk, ChunkRefs>(
+                chunks, workers, [&](const Chunk &chunk) { return map_one(chunk, windows); },
+                [](const Chunk &) noexcept { return ChunkRefs{{}, true}; });
+
+            std::size_t total = 0;
+            for (const ChunkRefs &chunk : mapped)
+            {
+                total += chunk.refs.size();
+                impl->incomplete = impl->incomplete || chunk.failed;
+            }
+            impl->refs.reserve(total);
+            std::vector<std::size_t> runs;
+            runs.reserve(mapped.size() + 1);
+            for (ChunkRefs &chunk : mapped)
+            {
+                if (chunk.refs.empty())
+                {
+                    continue;
+                }
+                runs.push_back(impl->refs.size());
+                impl->refs.insert(impl->refs.end(), chunk.refs.begin(), chunk.refs.end());
+                chunk.refs = {};
+            }
+            runs.push_back(impl->refs.size());
+
+            // Pairwise merges of the sorted runs, doubling the run length each round.
+            while (runs.size() > 2)
+            {
+                std::vector<std::size_t> merged;
+                merged.reserve(runs.size() / 2 + 2);
+                std::size_t i = 0;
+                for (; i + 2 < runs.size(); i += 2)
+                {
+                    std::inplace_merge(impl->refs.begin() + static_cast<std::ptrdiff_t>(runs[i]),
+                                       impl->refs.begin() + static_cast<std::ptrdiff_t>(runs[i + 1]),
+                                       impl->refs.begin() + static_cast<std::ptrdiff_t>(runs[i + 2]), by_value);
+                    merged.push_back(runs[i]);
+                }
+                for (; i < runs.size(); ++i)
+                {
+                    merged.push_back(runs[i]);
+                }
+                runs = std::move(merged);
+            }
+            return PointerMap{std::move(impl)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::PointerMap::build"});
+        }
+    }
+
+    Result<std::vector<memory::PointerPath>> memory::PointerMap::paths_to(Address target,
+                                                                          const PointerPathOptions &options) const
+        noexcept
+    {
+        if (target.raw() == 0)
+        {
+            return std::unexpected(Error{ErrorCode::NullTargetAddress, "memory::PointerMap::paths_to"});
+        }
+        if (!m_impl || options.max_depth == 0 || options.max_results == 0)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "memory::PointerMap::paths_to"});
+        }
+        try
+        {
+            const std::vector<PackedRef> &refs = m_impl->refs;
+            const Region host = Region::host();
+            std::vector<Node> nodes{Node{target.raw(), 0, SIZE_MAX}};
+            std::unordered_set<std::uintptr_t> visited{target.raw()};
+            std::vector<std::size_t> frontier{0};
+            std::vector<RankedPath> found;
+
+            // Breadth-first, so the first max_results static slots reached are also the shallowest ones.
+            for (std::size_t depth = 1; depth <= options.max_depth && !frontier.empty(); ++depth)
+            {
+                std::vector<std::size_t> next;
+                for (const std::size_t parent : frontier)
+                {
+                    if (found.size() == options.max_results)
+                    {
+                        break;
+                    }
+                    const std::uintptr_t address = nodes[parent].address;
+                    const std::uintptr_t lowest = address > options.max_offset ? address - options.max_offset : 0;
+                    const auto first = std::lower_bound(refs.begin(), refs.end(), lowest,
+                                                        [](const PackedRef &ref, std::uintptr_t value) noexcept
+                                                        { return ref.value() < value; });
+                    for (auto it = first; it != refs.end() && it->value() <= address; ++it)
+                    {
+                        const std::uintptr_t slot = it->slot();
+                        if (!visited.insert(slot).second)
+                        {
+                            continue;
+                        }
+                        nodes.push_back(Node{slot, static_cast<std::ptrdiff_t>(address - it->value()), parent});
+                        const std::size_t index = nodes.size() - 1;
+                        const Region module = memory::module_of(Address{slot});
+                        if (module.size != 0)
+                        {
+                            found.push_back(assemble(nodes, index, module, host));
+                            if (found.size() == options.max_results)
+                            {
+                                break;
+                            }
+                            continue;
+                        }
+                        if (depth < options.max_depth && next.size() < options.max_frontier)
+                        {
+                            next.push_back(index);
+                        }
+                    }
+                }
+                frontier = std::move(next);
+            }
+
+            // The map is a snapshot; keep only the paths that still reach the target.
+            std::erase_if(found,
+                          [&](const RankedPath &ranked)
+                          {
+                              const Result<Address> leaf = memory::walk(ranked.path.base, ranked.path.steps);
+                              return !leaf.has_value() || *leaf != target;
+                          });
+            std::stable_sort(found.begin(), found.end(),
+                             [](const RankedPath &lhs, const RankedPath &rhs) noexcept
+                             {
+                                 if (lhs.path.steps.size() != rhs.path.steps.size())
+                                     return lhs.path.steps.size() < rhs.path.steps.size();
+                                 if (lhs.in_host != rhs.in_host)
+                                     return lhs.in_host;
+                                 return lhs.offset_sum < rhs.offset_sum;
+                             });
+
+            std::vector<PointerPath> paths;
+            paths.reserve(found.size());
+            for (RankedPath &ranked : found)
+            {
+                paths.push_back(std::move(ranked.path));
+            }
+            return paths;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::PointerMap::paths_to"});
+        }
+    }
+
+    std::size_t memory::PointerMap::size() const noexcept
+    {
+        return m_impl ? m_impl->refs.size() : 0;
+    }
+
+    bool memory::PointerMap::incomplete() const noexcept
+    {
+        return m_impl && m_impl->incomplete;
+    }
+} // namespace DetourModKit
@@ -0,0 +1,158 @@
+/**
+ * @file profile_dump.cpp
+ * @brief Profile dump decoder and its Chrome Trace Event JSON rendering.
+ */
+
+#include "DetourModKit/profile_dump.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace DetourModKit
+{
+    namespace profile_dump
+    {
+        namespace
+        {
+            template <typename T> [[nodiscard]] T load(const std::byte *at) noexcept
+            {
+                T value;
+                std::memcpy(&value, at, sizeof(value));
+                return value;
+            }
+
+            /// Bytes of a DUMP_RECORD_NAME record ahead of the name, kind byte included.
+            constexpr std::size_t NAME_RECORD_HEADER_SIZE = 7;
+
+            /// The kind of a counter or flow record; SampleKind::Duration for any other record kind.
+            [[nodiscard]] constexpr SampleKind value_record_kind(std::uint8_t kind) noexcept
+            {
+                switch (kind)
+                {
+                case DUMP_RECORD_COUNTER:
+                    return SampleKind::Counter;
+                case DUMP_RECORD_FLOW_BEGIN:
+                    return SampleKind::FlowBegin;
+                case DUMP_RECORD_FLOW_END:
+                    return SampleKind::FlowEnd;
+                default:
+                    return SampleKind::Duration;
+                }
+            }
+        } // anonymous namespace
+
+        Result<Decoded> decode(std::span<const std::byte> image)
+        {
+            if (image.size() < DUMP_HEADER_SIZE || load<std::uint64_t>(image.data()) != DUMP_MAGIC)
+            {
+                return std::unexpected(Error{ErrorCode::MissingHeader, "profile_dump::decode"});
+            }
+            // Version 2 only added records, so a version 1 file is read by the same loop.
+            const auto version = load<std::uint32_t>(image.data() + 8);
+            if (version < 1 || version > DUMP_VERSION)
+            {
+                return std::unexpected(Error{ErrorCode::MissingHeader, "profile_dump::decode"});
+            }
+
+            Decoded decoded;
+            decoded.qpc_frequency = load<std::int64_t>(image.data() + 16);
+            decoded.samples.reserve((image.size() - DUMP_HEADER_SIZE) / DUMP_SAMPLE_RECORD_SIZE);
+
+            std::size_t offset = DUMP_HEADER_SIZE;
+            while (offset < image.size())
+            {
+                const std::size_t left = image.size() - offset;
+                const std::byte *record = image.data() + offset;
+                const auto kind = static_cast<std::uint8_t>(record[0]);
+                if (kind == DUMP_RECORD_NAME && left >= NAME_RECORD_HEADER_SIZE)
+                {
+                    const auto number = load<std::uint32_t>(record + 1);
+                    const auto length = load<std::uint16_t>(record + 5);
+                    // Names are numbered in the order they appear; any other number means the record is damaged.
+                    if (number != decoded.names.size() || left - NAME_RECORD_HEADER_SIZE < length)
+                    {
+                        break;
+                    }
+                    decoded.names.emplace_back(reinterpret_cast<const char *>(record + NAME_RECORD_HEADER_SIZE),
+                                               length);
+                    offset += NAME_RECORD_HEADER_SIZE + length;
+                    continue;
+                }
+                if (kind == DUMP_RECORD_SAMPLE && left >= DUMP_SAMPLE_RECORD_SIZE)
+                {
+                    Sample sample;
+                    sample.name = load<std::uint32_t>(record + 1);
+                    sample.thread_id = load<std::uint32_t>(record + 5);
+                    sample.start_ticks = load<std::int64_t>(record + 9);
+                    sample.duration_us = load<std::uint32_t>(record + 17);
+                    if (sample.name >= decoded.names.size())
+                    {
+                        break;
+                    }
+                    decoded.samples.push_back(sample);
+                    offset += DUMP_SAMPLE_RECORD_SIZE;
+                    continue;
+                }
+                if (const SampleKind value_kind = value_record_kind(kind);
+                    value_kind != SampleKind::Duration && left >= DUMP_VALUE_RECORD_SIZE)
+                {
+                    Sample sample;
+                    sample.kind = value_kind;
+                    sample.name = load<std::uint32_t>(record + 1);
+                    sample.thread_id = load<std::uint32_t>(record + 5);
+                    sample.start_ticks = load<std::int64_t>(record + 9);
+                    sample.value = load<std::int64_t>(record + 17);
+                    if (sample.name >= decoded.names.size())
+                    {
+                        break;
+                    }
+                    decoded.samples.push_back(sample);
+                    offset += DUMP_VALUE_RECORD_SIZE;
+                    continue;
+                }
+                // A cut-short record, or a kind this version does not know: records carry no size, so nothing past it
+                // can be found.
+                break;
+            }
+            decoded.truncated = offset != image.size();
+            return decoded;
+        }
+
+        Result<Decoded> read_file(const std::string &path)
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+            {
+                return std::unexpected(Error{ErrorCode::FileOpenFailed, "profile_dump::read_file"});
+            }
+            const std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            return decode(std::as_bytes(std::span<const char>{bytes.data(), bytes.size()}));
+        }
+
+        std::string format_chrome_json(const Decoded &decoded)
+        {
+            if (decoded.samples.empty() || decoded.qpc_frequency <= 0)
+            {
+                return "[]";
+            }
+            const double ticks_to_us = 1'000'000.0 / static_cast<double>(decoded.qpc_frequency);
+
+            std::string json;
+            json.reserve(decoded.samples.size() * 120 + 4);
+            json += "[\n";
+            bool first = true;
+            for (const Sample &sample : decoded.samples)
+            {
+                if (!first)
+                {
+                    json += ",\n";
+                }
+                first = false;
+                detail::append_chrome_sample(json, decoded.names[sample.name], sample, ticks_to_us);
+            }
+            json += "\n]";
+            return json;
+        }
+    } // namespace profile_dump
+} // namespace DetourModKit
@@ -0,0 +1,205 @@
+/**
+ * @file profile_stream.cpp
+ * @brief The viewer side of the live profile stream: maps another process's stream read-only and follows its ring.
+ */
+
+#include "DetourModKit/profile_stream.hpp"
+
+#include <windows.h>
+
+#include <atomic>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace profile_stream
+    {
+        namespace
+        {
+            constexpr std::uint64_t SLOT_MASK = STREAM_SLOT_COUNT - 1;
+
+            // The view is mapped read-only; std::atomic_ref needs a non-const object but only ever loads here, and
+            // an x86 aligned load is an ordinary read of the page.
+            template <typename T> [[nodiscard]] T load(const T &field, std::memory_order order) noexcept
+            {
+                return std::atomic_ref<T>(const_cast<T &>(field)).load(order);
+            }
+
+            [[nodiscard]] const StreamHeader &header_of(const void *view) noexcept
+            {
+                return *static_cast<const StreamHeader *>(view);
+            }
+
+            [[nodiscard]] const StreamName *names_of(const void *view) noexcept
+            {
+                return reinterpret_cast<const StreamName *>(static_cast<const std::byte *>(view) +
+                                                            STREAM_NAMES_OFFSET);
+            }
+
+            [[nodiscard]] const StreamSlot *slots_of(const void *view) noexcept
+            {
+                return reinterpret_cast<const StreamSlot *>(static_cast<const std::byte *>(view) +
+                                                            STREAM_SLOTS_OFFSET);
+            }
+
+            [[nodiscard]] std::unexpected<Error> reader_error(ErrorCode code, std::uint32_t detail = 0) noexcept
+            {
+                return std::unexpected(Error{code, "profile_stream::StreamReader::open", detail});
+            }
+        } // anonymous namespace
+
+        StreamReader::StreamReader(void *mapping, void *view) noexcept : m_mapping(mapping), m_view(view)
+        {
+        }
+
+        StreamReader::StreamReader(StreamReader &&other) noexcept
+            : m_mapping(std::exchange(other.m_mapping, nullptr)), m_view(std::exchange(other.m_view, nullptr)),
+              m_cursor(other.m_cursor), m_dropped(other.m_dropped)
+        {
+        }
+
+        StreamReader &StreamReader::operator=(StreamReader &&other) noexcept
+        {
+            if (this != &other)
+            {
+                release();
+                m_mapping = std::exchange(other.m_mapping, nullptr);
+                m_view = std::exchange(other.m_view, nullptr);
+                m_cursor = other.m_cursor;
+                m_dropped = other.m_dropped;
+            }
+            return *this;
+        }
+
+        StreamReader::~StreamReader() noexcept
+        {
+            release();
+        }
+
+        void StreamReader::release() noexcept
+        {
+            if (m_view != nullptr)
+            {
+                UnmapViewOfFile(m_view);
+                m_view = nullptr;
+            }
+            if (m_mapping != nullptr)
+            {
+                CloseHandle(m_mapping);
+                m_mapping = nullptr;
+            }
+        }
+
+        Result<StreamReader> StreamReader::open(std::uint32_t process_id) noexcept
+        {
+            std::wstring name;
+            try
+            {
+                name = mapping_name(process_id);
+            }
+            catch (...)
+            {
+                return reader_error(ErrorCode::OutOfMemory);
+            }
+            HANDLE mapping = OpenFileMappingW(FILE_MAP_READ, FALSE, name.c_str());
+            if (mapping == nullptr)
+            {
+                return reader_error(ErrorCode::SystemCallFailed, GetLastError());
+            }
+            void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, STREAM_BYTES);
+            if (view == nullptr)
+            {
+                const DWORD error = GetLastError();
+                CloseHandle(mapping);
+                return reader_error(ErrorCode::SystemCallFailed, error);
+            }
+            StreamReader reader(mapping, view);
+
+            // The producer installs the magic last, after the fields it guards.
+            const StreamHeader &header = header_of(view);
+            if (load(header.magic, std::memory_order_acquire) != STREAM_MAGIC ||
+                load(header.version, std::memory_order_relaxed) != STREAM_VERSION ||
+                load(header.slot_count, std::memory_order_relaxed) != STREAM_SLOT_COUNT ||
+                load(header.name_count, std::memory_order_relaxed) != STREAM_NAME_COUNT)
+            {
+                return reader_error(ErrorCode::MissingHeader);
+            }
+            const std::uint64_t written = load(header.write_cursor, std::memory_order_acquire);
+            reader.m_cursor = written > STREAM_SLOT_COUNT ? written - STREAM_SLOT_COUNT : 0;
+            return reader;
+        }
+
+        std::size_t StreamReader::poll(std::vector<StreamSample> &out, std::size_t max_samples)
+        {
+            if (m_view == nullptr)
+            {
+                return 0;
+            }
+            const std::uint64_t written = load(header_of(m_view).write_cursor, std::memory_order_acquire);
+            if (written - m_cursor > STREAM_SLOT_COUNT)
+            {
+                // The producers are a whole ring ahead: everything before the last ring's worth is gone.
+                m_dropped += written - STREAM_SLOT_COUNT - m_cursor;
+                m_cursor = written - STREAM_SLOT_COUNT;
+            }
+
+            const StreamSlot *const slots = slots_of(m_view);
+            std::size_t taken = 0;
+            while (m_cursor < written && taken < max_samples)
+            {
+                const StreamSlot &slot = slots[m_cursor & SLOT_MASK];
+                const std::uint64_t committed = 2 * m_cursor + 2;
+                const std::uint64_t before = load(slot.sequence, std::memory_order_acquire);
+                if (before < committed)
+                {
+                    // The position is taken but its sample is not written yet; pick it up next poll.
+                    break;
+                }
+                StreamSample sample;
+                sample.name = load(slot.name, std::memory_order_relaxed);
+                sample.thread_id = load(slot.thread_id, std::memory_order_relaxed);
+                sample.start_ticks = load(slot.start_ticks, std::memory_order_relaxed);
+                sample.duration_us = load(slot.duration_us, std::memory_order_relaxed);
+                sample.frame = load(slot.frame, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const std::uint64_t after = load(slot.sequence, std::memory_order_relaxed);
+                ++m_cursor;
+                if (before != committed || after != committed)
+                {
+                    // A producer a ring ahead has already reused the slot.
+                    ++m_dropped;
+                    continue;
+                }
+                out.push_back(sample);
+                ++taken;
+            }
+            return taken;
+        }
+
+        std::string_view StreamReader::name(std::uint32_t index) const noexcept
+        {
+            if (m_view == nullptr || index >= STREAM_NAME_COUNT)
+            {
+                return {};
+            }
+            const StreamName &entry = names_of(m_view)[index];
+            // The text is written once, before its length is published, and never changes after.
+            const std::uint32_t length = load(entry.length, std::memory_order_acquire);
+            if (length == 0)
+            {
+                return {};
+            }
+            return std::string_view{entry.text, length - 1};
+        }
+
+        std::int64_t StreamReader::qpc_frequency() const noexcept
+        {
+            return m_view != nullptr ? load(header_of(m_view).qpc_frequency, std::memory_order_relaxed) : 0;
+        }
+
+        bool StreamReader::producer_live() const noexcept
+        {
+            return m_view != nullptr && load(header_of(m_view).producers, std::memory_order_acquire) != 0;
+        }
+    } // namespace profile_stream
+} // namespace DetourModKit
@@ -1,84 +1,544 @@
 /**
  * @file profiler.cpp
- * @brief Implementation of the lock-free ring buffer profiler with Chrome Tracing export.
+ * @brief Implementation of the lock-free per-thread ring buffer profiler with Chrome Tracing export.
  */
 
 #include "DetourModKit/profiler.hpp"
+#include "DetourModKit/profile_dump.hpp"
+#include "DetourModKit/profile_stream.hpp"
 
 #include <windows.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
 #include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <cstdio>
-#include <format>
+#include <cstring>
 #include <memory>
 #include <new>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
 
 namespace DetourModKit
 {
     namespace
     {
+        /// Index mask of a ring; DEFAULT_CAPACITY is a power of 2.
+        constexpr size_t RING_MASK = Profiler::DEFAULT_CAPACITY - 1;
+        static_assert((Profiler::DEFAULT_CAPACITY & RING_MASK) == 0, "ring capacity must be a power of 2");
+
+        /// Slot index mask within a block, and the number of blocks in a ring.
+        constexpr size_t BLOCK_MASK = Profiler::SAMPLE_BLOCK_SIZE - 1;
+        constexpr size_t RING_BLOCKS = Profiler::DEFAULT_CAPACITY / Profiler::SAMPLE_BLOCK_SIZE;
+        static_assert((Profiler::SAMPLE_BLOCK_SIZE & BLOCK_MASK) == 0, "block size must be a power of 2");
+        static_assert(RING_BLOCKS * Profiler::SAMPLE_BLOCK_SIZE == Profiler::DEFAULT_CAPACITY,
+                      "block size must divide the ring capacity");
+        static_assert(sizeof(ProfileSample) == 16, "a ring slot is 16 bytes");
+
+        /// The registry index a thread past MAX_SAMPLE_THREADS records under; exported as thread ID 0.
+        constexpr uint16_t NO_THREAD_INDEX = UINT16_MAX;
+
+        // Entries intern_name() and intern_thread() probe before treating their table as full.
+        constexpr size_t MAX_INTERN_PROBES = 64;
+
+        // ProfileSample::tag: the kind in bits 0-1, the wide and extension flags, and the lap in bits 4-7. The lap
+        // tells a reader that a slot still holds the lap its position says, rather than an older or newer one.
+        constexpr uint8_t TAG_KIND_MASK = 0x03;
+        constexpr uint8_t TAG_WIDE = 0x04;
+        constexpr uint8_t TAG_EXTENSION = 0x08;
+        constexpr unsigned TAG_LAP_SHIFT = 4;
+
+        [[nodiscard]] constexpr size_t lap_of(size_t position) noexcept
+        {
+            return position / Profiler::DEFAULT_CAPACITY;
+        }
+
+        [[nodiscard]] constexpr uint8_t lap_tag(size_t position) noexcept
+        {
+            return static_cast<uint8_t>((lap_of(position) & 0x0F) << TAG_LAP_SHIFT);
+        }
+
+        /// The base entry of @p position's block in @p position's lap.
+        [[nodiscard]] constexpr size_t base_index(size_t position) noexcept
+        {
+            return ((position & RING_MASK) / Profiler::SAMPLE_BLOCK_SIZE) * 2 + (lap_of(position) & 1);
+        }
+
+        /// One slot's fields as record() writes them.
+        struct SlotPayload
+        {
+            uint16_t name;
+            uint16_t thread;
+            uint8_t tag;
+            int8_t frame_delta;
+            int32_t start_delta;
+            uint32_t value;
+        };
+
+        // Publish the payload through std::atomic_ref rather than plain stores. The exporter reads these same fields
+        // concurrently under the seqlock, so plain non-atomic stores here would be a formal C++ data race even though
+        // they are benign for aligned scalars on x86. Relaxed ordering is sufficient: the odd/even sequence protocol
+        // provides the synchronization. Both writers open the window with release (or acq_rel) ordering ahead of
+        // these stores and close it with a release store after them, so a reader that sees an even sequence (via its
+        // acquire load) is guaranteed to see these stores; the counter, not the payload ordering, is what makes the
+        // sample consistent.
+        void store_payload(ProfileSample &sample, const SlotPayload &payload) noexcept
+        {
+            std::atomic_ref<uint16_t>(sample.name).store(payload.name, std::memory_order_relaxed);
+            std::atomic_ref<uint16_t>(sample.thread).store(payload.thread, std::memory_order_relaxed);
+            std::atomic_ref<uint8_t>(sample.tag).store(payload.tag, std::memory_order_relaxed);
+            std::atomic_ref<int8_t>(sample.frame_delta).store(payload.frame_delta, std::memory_order_relaxed);
+            std::atomic_ref<int32_t>(sample.start_delta).store(payload.start_delta, std::memory_order_relaxed);
+            std::atomic_ref<uint32_t>(sample.value).store(payload.value, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] SlotPayload load_payload(ProfileSample &sample) noexcept
+        {
+            return SlotPayload{std::atomic_ref<uint16_t>(sample.name).load(std::memory_order_relaxed),
+                               std::atomic_ref<uint16_t>(sample.thread).load(std::memory_order_relaxed),
+                               std::atomic_ref<uint8_t>(sample.tag).load(std::memory_order_relaxed),
+                               std::atomic_ref<int8_t>(sample.frame_delta).load(std::memory_order_relaxed),
+                               std::atomic_ref<int32_t>(sample.start_delta).load(std::memory_order_relaxed),
+                               std::atomic_ref<uint32_t>(sample.value).load(std::memory_order_relaxed)};
+        }
+
+        /**
+         * @brief Writes one slot under its seqlock.
+         * @param shared The slot's ring has many writers (the shared ring), so the sequence moves by fetch_add.
+         */
+        void store_slot(ProfileSample &sample, const SlotPayload &payload, bool shared) noexcept
+        {
+            if (!shared)
+            {
+                // This thread is the ring's only writer, so the sequence needs no read-modify-write: a load and a
+                // store cannot race another writer. The release fence keeps the odd sequence ahead of the payload
+                // stores for a concurrent exporter, and the closing release store publishes them.
+                const uint16_t sequence = sample.sequence.load(std::memory_order_relaxed);
+                sample.sequence.store(static_cast<uint16_t>(sequence + 1), std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+                store_payload(sample, payload);
+                sample.sequence.store(static_cast<uint16_t>(sequence + 2), std::memory_order_release);
+                return;
+            }
+
+            // Open the write window with a monotonic increment. The result is guaranteed odd because every closed
+            // sequence is even (sequence starts at 0 in the constructor and reset(), and each write contributes
+            // exactly +2). Using fetch_add avoids the load-then-store RMW pattern: a producer preempted between a
+            // relaxed load and its first store could otherwise roll the slot's sequence backwards if another producer
+            // completed a full write on the same slot in the interim. fetch_add forbids that rollback.
+            //
+            // Monotonicity is unconditionally guaranteed by fetch_add: per [atomics.types.operations] the counter
+            // cannot roll backwards regardless of how many producers race on the same slot. Do NOT replace this with
+            // a load-then-store RMW: that would re-introduce the stale-publish race on wrap collision that this
+            // protocol exists to prevent. The 16-bit counter wraps only after 32768 writes of one slot, each a full lap
+            // of the ring apart, which no reader's copy of one slot outlasts.
+            (void)sample.sequence.fetch_add(1, std::memory_order_acq_rel);
+            store_payload(sample, payload);
+            // Close the write window. Another +1 keeps the slot's sequence monotonic and lands it on an even value,
+            // signalling a fully committed sample. Readers that observe an odd value skip this slot to avoid reading
+            // torn fields.
+            (void)sample.sequence.fetch_add(1, std::memory_order_release);
+        }
+
+        // The block-base helpers take Profiler::SampleBlockBase, which is private to Profiler, as a template parameter.
+        /// Publishes @p ticks and @p frame as the base of @p position's block in its lap.
+        template <typename BlockBase>
+        void publish_block_base(BlockBase *bases, size_t position, int64_t ticks, uint32_t frame) noexcept
+        {
+            BlockBase &base = bases[base_index(position)];
+            const uint64_t lap = lap_of(position);
+            base.sequence.store(2 * lap + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            base.ticks.store(ticks, std::memory_order_relaxed);
+            base.frame.store(frame, std::memory_order_relaxed);
+            base.sequence.store(2 * lap + 2, std::memory_order_release);
+        }
+
+        /// The base of @p position's block in its lap; false while it is unpublished, mid-write or another lap's.
+        template <typename BlockBase>
+        [[nodiscard]] bool read_block_base(const BlockBase *bases, size_t position, int64_t &ticks,
+                                           uint32_t &frame) noexcept
+        {
+            const BlockBase &base = bases[base_index(position)];
+            const uint64_t published = 2 * static_cast<uint64_t>(lap_of(position)) + 2;
+            if (base.sequence.load(std::memory_order_acquire) != published)
+            {
+                return false;
+            }
+            ticks = base.ticks.load(std::memory_order_relaxed);
+            frame = base.frame.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return base.sequence.load(std::memory_order_relaxed) == published;
+        }
+
         /**
-         * @brief Escapes a string for safe embedding in a JSON value.
-         * @details Handles the characters that are special in JSON strings:
-         *          backslash, double quote, and control characters (U+0000..U+001F). Forward slash is NOT escaped
-         *          (legal unescaped in JSON per RFC 8259).
-         * @param input The raw string to escape.
-         * @return A JSON-safe escaped string (without surrounding quotes).
+         * @brief Writes one sample at @p position, and at @p position + 1 when it needs an extension.
+         * @details On a thread ring the writer of a block's first slot publishes the block's base from its own sample
+         *          first, and any other sample is stored against that base when the offsets and value fit. The shared
+         *          ring's writers claim positions with one fetch_add and so cannot know the base ahead of it: @p shared
+         *          stores the sample wide, in two slots the caller has already claimed.
+         * @return Whether the sample went wide.
          */
-        std::string escape_json_string(std::string_view input)
+        template <typename BlockBase>
+        bool write_record(ProfileSample *samples, BlockBase *bases, size_t position,
+                          ProfileSampleKind kind, uint32_t frame, uint16_t name, int64_t start_ticks, int64_t value,
+                          uint16_t thread, bool shared) noexcept
         {
-            std::string out;
-            out.reserve(input.size());
-            for (const char c : input)
+            const uint8_t kind_bits = static_cast<uint8_t>(kind) & TAG_KIND_MASK;
+            if (!shared)
             {
-                switch (c)
+                if ((position & BLOCK_MASK) == 0)
                 {
-                case '"':
-                    out += "\\\"";
-                    break;
-                case '\\':
-                    out += "\\\\";
-                    break;
-                case '\b':
-                    out += "\\b";
-                    break;
-                case '\f':
-                    out += "\\f";
-                    break;
-                case '\n':
-                    out += "\\n";
-                    break;
-                case '\r':
-                    out += "\\r";
-                    break;
-                case '\t':
-                    out += "\\t";
-                    break;
-                default:
-                    if (static_cast<unsigned char>(c) < 0x20)
-                    {
-                        // Control characters U+0000..U+001F require \uXXXX encoding
-                        char buf[8];
-                        std::snprintf(buf, sizeof(buf), "\\u%04x",
-                                      static_cast<unsigned int>(static_cast<unsigned char>(c)));
-                        out += buf;
-                    }
-                    else
+                    publish_block_base(bases, position, start_ticks, frame);
+                }
+                int64_t base_ticks = 0;
+                uint32_t base_frame = 0;
+                if (read_block_base(bases, position, base_ticks, base_frame))
+                {
+                    const int64_t start_delta = start_ticks - base_ticks;
+                    const int64_t frame_delta = static_cast<int64_t>(frame) - static_cast<int64_t>(base_frame);
+                    const bool value_fits = kind == ProfileSampleKind::Duration ||
+                                            (value >= 0 && value <= static_cast<int64_t>(UINT32_MAX));
+                    if (value_fits && start_delta >= INT32_MIN && start_delta <= INT32_MAX && frame_delta >= INT8_MIN &&
+                        frame_delta <= INT8_MAX)
                     {
-                        out += c;
+                        store_slot(samples[position & RING_MASK],
+                                   SlotPayload{name, thread, static_cast<uint8_t>(kind_bits | lap_tag(position)),
+                                               static_cast<int8_t>(frame_delta), static_cast<int32_t>(start_delta),
+                                               static_cast<uint32_t>(value)},
+                                   false);
+                        return false;
                     }
-                    break;
                 }
             }
+
+            const auto bits = static_cast<uint64_t>(value);
+            const auto start_bits = static_cast<uint64_t>(start_ticks);
+            const size_t tail = position + 1;
+            if (!shared && (tail & BLOCK_MASK) == 0)
+            {
+                // The extension opens the next block, so its sample is that block's base.
+                publish_block_base(bases, tail, start_ticks, frame);
+            }
+            store_slot(samples[position & RING_MASK],
+                       SlotPayload{name, thread, static_cast<uint8_t>(kind_bits | TAG_WIDE | lap_tag(position)), 0,
+                                   static_cast<int32_t>(static_cast<uint32_t>(bits >> 32)),
+                                   static_cast<uint32_t>(bits)},
+                       shared);
+            store_slot(samples[tail & RING_MASK],
+                       SlotPayload{static_cast<uint16_t>(frame), static_cast<uint16_t>(frame >> 16),
+                                   static_cast<uint8_t>(TAG_EXTENSION | lap_tag(tail)), 0,
+                                   static_cast<int32_t>(static_cast<uint32_t>(start_bits)),
+                                   static_cast<uint32_t>(start_bits >> 32)},
+                       shared);
+            return true;
+        }
+
+        [[nodiscard]] int64_t read_qpc() noexcept
+        {
+            LARGE_INTEGER ticks;
+            QueryPerformanceCounter(&ticks);
+            return ticks.QuadPart;
+        }
+
+        [[nodiscard]] int64_t read_tsc() noexcept
+        {
+            // Plain rdtsc rather than rdtscp: a scope boundary needs no ordering against the surrounding instructions
+            // finer than the few cycles rdtsc may drift by, and rdtscp is the slower of the two.
+            return static_cast<int64_t>(__rdtsc());
+        }
+
+        /// Mask of a frame number's slot in the verdict history; FRAME_HISTORY is a power of 2.
+        constexpr size_t FRAME_HISTORY_MASK = Profiler::FRAME_HISTORY - 1;
+        static_assert((Profiler::FRAME_HISTORY & FRAME_HISTORY_MASK) == 0, "frame history must be a power of 2");
+
+        /// A frame verdict as mark_frame() stores it: a valid bit, the frame number, and the over-budget bit.
+        [[nodiscard]] constexpr uint64_t encode_verdict(uint32_t frame, bool over_budget) noexcept
+        {
+            return (uint64_t{1} << 63) | (static_cast<uint64_t>(frame) << 1) | (over_budget ? 1U : 0U);
+        }
+
+        /// The key set_sample_rate() files a name under; never 0, which marks a free entry.
+        [[nodiscard]] size_t rate_key(std::string_view name) noexcept
+        {
+            const size_t hash = std::hash<std::string_view>{}(name);
+            return hash != 0 ? hash : 1;
+        }
+
+        /// The stream's header, name table and sample ring within its view.
+        [[nodiscard]] profile_stream::StreamHeader &stream_header(std::byte *view) noexcept
+        {
+            return *reinterpret_cast<profile_stream::StreamHeader *>(view);
+        }
+
+        [[nodiscard]] profile_stream::StreamName *stream_names(std::byte *view) noexcept
+        {
+            return reinterpret_cast<profile_stream::StreamName *>(view + profile_stream::STREAM_NAMES_OFFSET);
+        }
+
+        [[nodiscard]] profile_stream::StreamSlot *stream_slots(std::byte *view) noexcept
+        {
+            return reinterpret_cast<profile_stream::StreamSlot *>(view + profile_stream::STREAM_SLOTS_OFFSET);
+        }
+
+        /**
+         * @brief The stream's index for @p name, entering it in the table on first sight.
+         * @details Keyed by pointer like the scope slots. Every writer of every DetourModKit copy in the process shares
+         *          the table, so a free entry is claimed by compare-exchange; the claimant writes the text, then
+         *          publishes its length with release. An entry found claimed but not yet published is still returned:
+         *          the viewer resolves names when it needs them, by which time the text is there.
+         */
+        [[nodiscard]] uint32_t stream_name_index(std::byte *view, const char *name) noexcept
+        {
+            using namespace profile_stream;
+            const auto key = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(name));
+            const auto start = static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 32);
+            StreamName *const names = stream_names(view);
+            // A short probe run: a table this crowded around one name gives up rather than walking all of it.
+            constexpr size_t max_probes = 64;
+            for (size_t probe = 0; probe < max_probes; ++probe)
+            {
+                const size_t index = (start + probe) % STREAM_NAME_COUNT;
+                StreamName &entry = names[index];
+                std::atomic_ref<uint64_t> owner(entry.key);
+                uint64_t seen = owner.load(std::memory_order_acquire);
+                if (seen == 0 && owner.compare_exchange_strong(seen, key, std::memory_order_acq_rel))
+                {
+                    const std::string_view text = std::string_view{name}.substr(0, STREAM_NAME_BYTES);
+                    std::memcpy(entry.text, text.data(), text.size());
+                    std::atomic_ref<uint32_t>(entry.length)
+                        .store(static_cast<uint32_t>(text.size() + 1), std::memory_order_release);
+                    return static_cast<uint32_t>(index);
+                }
+                if (seen == key)
+                {
+                    return static_cast<uint32_t>(index);
+                }
+            }
+            return STREAM_NO_NAME;
+        }
+
+        /**
+         * @brief Publishes one sample into the live stream.
+         * @details The multi-producer protocol of the shared ring with the position folded into the sequence (see
+         *          profile_stream.hpp): a stored 2 * position + 1 opens the slot and 2 * position + 2 closes it, so a
+         *          viewer's cursor knows which lap a slot holds. A store rather than a fetch_add is enough here,
+         *          because the value written comes from the position, not from the slot's previous sequence.
+         */
+        void publish_to_stream(std::byte *view, uint32_t frame, const char *name, int64_t start_qpc,
+                               uint32_t duration_us, uint32_t thread_id) noexcept
+        {
+            using namespace profile_stream;
+            const uint32_t name_index = stream_name_index(view, name);
+            const uint64_t position =
+                std::atomic_ref<uint64_t>(stream_header(view).write_cursor).fetch_add(1, std::memory_order_relaxed);
+            StreamSlot &slot = stream_slots(view)[position & (STREAM_SLOT_COUNT - 1)];
+            std::atomic_ref<uint64_t> sequence(slot.sequence);
+            sequence.store(2 * position + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            std::atomic_ref<uint32_t>(slot.name).store(name_index, std::memory_order_relaxed);
+            std::atomic_ref<uint32_t>(slot.thread_id).store(thread_id, std::memory_order_relaxed);
+            std::atomic_ref<int64_t>(slot.start_ticks).store(start_qpc, std::memory_order_relaxed);
+            std::atomic_ref<uint32_t>(slot.duration_us).store(duration_us, std::memory_order_relaxed);
+            std::atomic_ref<uint32_t>(slot.frame).store(frame, std::memory_order_relaxed);
+            sequence.store(2 * position + 2, std::memory_order_release);
+        }
+
+        /// One sample copied out of a ring under the seqlock.
+        struct CommittedSample
+        {
+            ProfileSampleKind kind;
+            uint32_t frame;
+            const char *name;
+            int64_t start_ticks;
+            int64_t value;
+            uint32_t thread_id;
+        };
+
+        /// @p sample in the decoder's form, which the Chrome event writers take; its name is left to the caller.
+        [[nodiscard]] profile_dump::Sample to_dump_sample(const CommittedSample &sample) noexcept
+        {
+            profile_dump::Sample out;
+            out.thread_id = sample.thread_id;
+            out.start_ticks = sample.start_ticks;
+            switch (sample.kind)
+            {
+            case ProfileSampleKind::Counter:
+                out.kind = profile_dump::SampleKind::Counter;
+                out.value = sample.value;
+                break;
+            case ProfileSampleKind::FlowBegin:
+                out.kind = profile_dump::SampleKind::FlowBegin;
+                out.value = sample.value;
+                break;
+            case ProfileSampleKind::FlowEnd:
+                out.kind = profile_dump::SampleKind::FlowEnd;
+                out.value = sample.value;
+                break;
+            case ProfileSampleKind::Duration:
+            default:
+                out.duration_us = static_cast<uint32_t>(sample.value);
+                break;
+            }
             return out;
         }
+
+        /// The dump record kind of @p kind.
+        [[nodiscard]] constexpr uint8_t dump_record_kind(ProfileSampleKind kind) noexcept
+        {
+            switch (kind)
+            {
+            case ProfileSampleKind::Counter:
+                return profile_dump::DUMP_RECORD_COUNTER;
+            case ProfileSampleKind::FlowBegin:
+                return profile_dump::DUMP_RECORD_FLOW_BEGIN;
+            case ProfileSampleKind::FlowEnd:
+                return profile_dump::DUMP_RECORD_FLOW_END;
+            case ProfileSampleKind::Duration:
+            default:
+                return profile_dump::DUMP_RECORD_SAMPLE;
+            }
+        }
+
+        /**
+         * @brief Appends one sample as a Chrome trace event, with the separator the array needs ahead of it.
+         * @param first Cleared once any event has been written.
+         */
+        void append_json_event(std::string &json, const CommittedSample &sample, double ticks_to_us, bool &first)
+        {
+            if (!first)
+            {
+                json += ",\n";
+            }
+            first = false;
+
+            // Chrome Trace Event Format: "X" = complete event (has duration), "C" = counter, "s"/"f" = flow. The name
+            // is escaped to produce valid JSON even if the caller passes a string containing quotes or backslashes.
+            profile_dump::detail::append_chrome_sample(json, sample.name, to_dump_sample(sample), ticks_to_us);
+        }
+
+        template <typename T> void append_le(std::string &out, T value)
+        {
+            char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            out.append(bytes, sizeof(T));
+        }
+
+        /**
+         * @class ChunkedFileSink
+         * @brief The buffered file behind the streaming exports.
+         * @details Callers append to buffer() and call commit() after each record; once the buffer holds
+         *          Profiler::EXPORT_CHUNK_SIZE bytes it goes to the file in one fwrite and is reused, so an export
+         *          holds one chunk in memory however long the file grows. The stdio buffer is turned off, since the
+         *          chunk already is one.
+         */
+        class ChunkedFileSink
+        {
+        public:
+            explicit ChunkedFileSink(std::string_view path)
+            {
+                const std::string path_str(path);
+                if (fopen_s(&m_file, path_str.c_str(), "wb") != 0)
+                {
+                    m_file = nullptr;
+                    return;
+                }
+                (void)std::setvbuf(m_file, nullptr, _IONBF, 0);
+                // A little headroom past the chunk, so the record that crosses it does not regrow the buffer.
+                m_chunk.reserve(Profiler::EXPORT_CHUNK_SIZE + 512);
+            }
+
+            ~ChunkedFileSink() noexcept
+            {
+                if (m_file != nullptr)
+                {
+                    std::fclose(m_file);
+                }
+            }
+
+            ChunkedFileSink(const ChunkedFileSink &) = delete;
+            ChunkedFileSink &operator=(const ChunkedFileSink &) = delete;
+            ChunkedFileSink(ChunkedFileSink &&) = delete;
+            ChunkedFileSink &operator=(ChunkedFileSink &&) = delete;
+
+            [[nodiscard]] bool is_open() const noexcept { return m_file != nullptr; }
+
+            [[nodiscard]] std::string &buffer() noexcept { return m_chunk; }
+
+            /// Writes the buffer out once it has reached a chunk.
+            void commit() noexcept
+            {
+                if (m_chunk.size() >= Profiler::EXPORT_CHUNK_SIZE)
+                {
+                    write_chunk();
+                }
+            }
+
+            /// Writes what is left and closes the file; false when any write, the flush or the close failed.
+            [[nodiscard]] bool finish() noexcept
+            {
+                write_chunk();
+                std::FILE *file = std::exchange(m_file, nullptr);
+                const bool flushed = std::fflush(file) == 0;
+                return std::fclose(file) == 0 && flushed && !m_failed;
+            }
+
+        private:
+            void write_chunk() noexcept
+            {
+                // After a failed write the rest is discarded; finish() reports the failure.
+                if (!m_failed && !m_chunk.empty() &&
+                    std::fwrite(m_chunk.data(), 1, m_chunk.size(), m_file) != m_chunk.size())
+                {
+                    m_failed = true;
+                }
+                m_chunk.clear();
+            }
+
+            std::FILE *m_file{nullptr};
+            std::string m_chunk;
+            bool m_failed{false};
+        };
     } // anonymous namespace
 
+    uint32_t ScopeStats::percentile_us(double quantile) const noexcept
+    {
+        if (count == 0)
+        {
+            return 0;
+        }
+        const double clamped = std::clamp(quantile, 0.0, 1.0);
+        // The rank of the wanted sample, 1-based: ceil(q * count), and at least the first sample.
+        const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+        uint64_t seen = 0;
+        for (size_t index = 0; index < HISTOGRAM_BUCKETS; ++index)
+        {
+            seen += histogram[index];
+            if (seen >= rank)
+            {
+                return std::min(bucket_upper_bound(index), max_us);
+            }
+        }
+        // Only a hand-built ScopeStats whose histogram holds fewer samples than count gets here; Profiler::stats()
+        // reads the histogram after the count, so its buckets always add up to at least count.
+        return max_us;
+    }
+
+    Profiler::SampleRing::SampleRing()
+        : samples(std::make_unique<ProfileSample[]>(DEFAULT_CAPACITY)),
+          bases(std::make_unique<SampleBlockBase[]>(2 * RING_BLOCKS)),
+          scopes(std::make_unique<ScopeSlot[]>(MAX_SCOPES_PER_RING))
+    {
+    }
+
     Profiler::Profiler()
-        : m_buffer(std::make_unique<ProfileSample[]>(DEFAULT_CAPACITY)), m_capacity(DEFAULT_CAPACITY),
-          m_mask(DEFAULT_CAPACITY - 1)
     {
         LARGE_INTEGER freq;
         // QueryPerformanceFrequency cannot fail and is always non-zero on Windows XP and later, but guard regardless: a
@@ -92,77 +552,421 @@ namespace DetourModKit
         {
             m_qpc_frequency = 10'000'000;
         }
+        m_tick_frequency = m_qpc_frequency;
+    }
+
+    // Never runs for the singleton (see get_instance()); it frees the thread rings so the lifetime is still complete.
+    Profiler::~Profiler() noexcept
+    {
+        for (ThreadRingEntry &entry : m_thread_rings)
+        {
+            delete entry.ring.load(std::memory_order_acquire);
+        }
     }
 
     Profiler &Profiler::get_instance() noexcept
     {
         // Constructed once into function-local static storage and never destroyed, mirroring StringPool::instance().
-        // A Meyers singleton (`static Profiler instance;`) registers a static destructor that frees m_buffer at
+        // A Meyers singleton (`static Profiler instance;`) registers a static destructor that frees the shared ring at
         // static-teardown time. A ScopedProfile whose own destructor runs *after* that -- a static/thread_local
         // ScopedProfile, or one on a thread still alive at process teardown -- would then call record() through this
-        // accessor and dereference the freed m_buffer (use-after-free under DLL unload / loader-lock teardown).
+        // accessor and dereference the freed ring (use-after-free under DLL unload / loader-lock teardown).
         // Placement-new into raw static storage keeps the object alive for the whole process and never runs its
-        // destructor, so a late record() is always safe. The single fixed-size ring-buffer leak is reclaimed by the
-        // OS at process exit. (Construction still uses a throwing make_unique for m_buffer; a first-use OOM there
-        // terminates this noexcept accessor exactly as the Meyers form did; this lifetime change does not alter
+        // destructor, so a late record() is always safe. The shared ring and every per-thread ring are reclaimed by
+        // the OS at process exit. (Construction still uses a throwing make_unique for the shared ring; a first-use OOM
+        // there terminates this noexcept accessor exactly as the Meyers form did; this lifetime change does not alter
         // construction-OOM behaviour.)
         alignas(Profiler) static unsigned char storage[sizeof(Profiler)];
         static Profiler *const instance = ::new (static_cast<void *>(storage)) Profiler();
         return *instance;
     }
 
-    void Profiler::record(const char *name, int64_t start_ticks, int64_t end_ticks, uint32_t thread_id) noexcept
+    Profiler::SampleRing *Profiler::ring_for_current_thread() noexcept
+    {
+        // Thread ids are never zero, so zero can mark a free entry. The multiplicative hash spreads the ids, which
+        // Windows hands out in steps of four, over the whole table.
+        const auto thread_id = static_cast<uint32_t>(GetCurrentThreadId());
+        const auto start = static_cast<size_t>((static_cast<uint64_t>(thread_id) * 0x9E3779B97F4A7C15ULL) >> 32);
+        for (size_t probe = 0; probe < MAX_THREAD_RINGS; ++probe)
+        {
+            ThreadRingEntry &entry = m_thread_rings[(start + probe) % MAX_THREAD_RINGS];
+            uint32_t owner = entry.owner.load(std::memory_order_acquire);
+            if (owner == thread_id)
+            {
+                return entry.ring.load(std::memory_order_acquire);
+            }
+            if (owner != 0 || !entry.owner.compare_exchange_strong(owner, thread_id, std::memory_order_acq_rel))
+            {
+                // Another thread's entry, or one another thread just claimed: it can never become ours.
+                continue;
+            }
+            // On failure the entry stays claimed with no ring, and this thread keeps recording into the shared ring.
+            SampleRing *built = nullptr;
+            try
+            {
+                built = new SampleRing();
+            }
+            catch (...)
+            {
+                built = nullptr;
+            }
+            entry.ring.store(built, std::memory_order_release);
+            return built;
+        }
+        return nullptr;
+    }
+
+    template <typename Visit> void Profiler::for_each_ring(Visit &&visit) const
+    {
+        visit(m_shared);
+        for (const ThreadRingEntry &entry : m_thread_rings)
+        {
+            if (const SampleRing *ring = entry.ring.load(std::memory_order_acquire))
+            {
+                visit(*ring);
+            }
+        }
+    }
+
+    template <typename Visit> void Profiler::for_each_sample(Visit &&visit) const
+    {
+        // Samples leave on the QPC timeline whichever clock recorded them, so every export reads the same way. A
+        // dropped frame's samples a ring has not yet taken back are skipped here.
+        const auto onto_qpc = [this, &visit](const CommittedSample &sample)
+        {
+            if (!frame_kept(sample.frame))
+            {
+                return;
+            }
+            CommittedSample converted = sample;
+            converted.start_ticks = to_qpc_ticks(sample.start_ticks);
+            visit(converted);
+        };
+        for_each_ring([this, &onto_qpc](const SampleRing &ring) { visit_ring_samples(ring, onto_qpc); });
+    }
+
+    template <typename Visit> void Profiler::visit_ring_samples(const SampleRing &ring, Visit &visit) const
+    {
+        const size_t total = ring.write_pos.load(std::memory_order_acquire);
+        const size_t count = std::min(total, DEFAULT_CAPACITY);
+        // The oldest surviving slot's position: 0 until the ring has wrapped.
+        const size_t first = total - count;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            const size_t position = first + i;
+            // Bind a non-const reference so the payload can be read through std::atomic_ref (its constructor takes a
+            // non-const lvalue). std::unique_ptr<T[]>::get() is const-qualified and returns a non-const T*, so the
+            // ring of a const Profiler can still be read. The reference is only read from.
+            ProfileSample &sample = ring.samples[position & RING_MASK];
+
+            // Seqlock read: load the sequence, copy the sample fields into locals, then re-load the sequence. record()
+            // opens a write with an odd sequence and closes it with the next even value, so a sample is consistent
+            // only when the pre-read sequence is even (no in-flight write) AND the post-read sequence is unchanged (no
+            // write started and finished mid-copy). The payload is read through std::atomic_ref (relaxed) to match
+            // record()'s atomic_ref stores, so the concurrent read/write pair is race-free rather than merely benign;
+            // the acquire fence between the field copies and the second sequence load stops the copies from being
+            // reordered after it. The lap in the tag rejects a slot a later lap has since taken (or an earlier lap
+            // still holds, behind a rewound frame). This runs on the cold export path; the producer hot path is
+            // untouched.
+            const uint16_t seq_before = sample.sequence.load(std::memory_order_acquire);
+            const SlotPayload head = load_payload(sample);
+            if ((seq_before & 1) != 0 || head.name == 0 || (head.tag & TAG_EXTENSION) != 0 ||
+                (head.tag & ~(TAG_KIND_MASK | TAG_WIDE)) != lap_tag(position))
+            {
+                continue;
+            }
+
+            CommittedSample committed{static_cast<ProfileSampleKind>(head.tag & TAG_KIND_MASK), 0, nullptr, 0, 0, 0};
+            if ((head.tag & TAG_WIDE) != 0)
+            {
+                // The extension is the next slot; a wide sample whose extension is not yet counted is skipped.
+                if (position + 1 >= total)
+                {
+                    continue;
+                }
+                ProfileSample &extension = ring.samples[(position + 1) & RING_MASK];
+                const uint16_t extension_before = extension.sequence.load(std::memory_order_acquire);
+                const SlotPayload tail = load_payload(extension);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if ((extension_before & 1) != 0 ||
+                    extension.sequence.load(std::memory_order_relaxed) != extension_before ||
+                    tail.tag != (TAG_EXTENSION | lap_tag(position + 1)))
+                {
+                    continue;
+                }
+                committed.frame = static_cast<uint32_t>(tail.name) | (static_cast<uint32_t>(tail.thread) << 16);
+                const auto start_low = static_cast<uint64_t>(static_cast<uint32_t>(tail.start_delta));
+                committed.start_ticks = static_cast<int64_t>(start_low | (static_cast<uint64_t>(tail.value) << 32));
+                committed.value = static_cast<int64_t>(
+                    (static_cast<uint64_t>(static_cast<uint32_t>(head.start_delta)) << 32) | head.value);
+            }
+            else
+            {
+                int64_t base_ticks = 0;
+                uint32_t base_frame = 0;
+                if (!read_block_base(ring.bases.get(), position, base_ticks, base_frame))
+                {
+                    continue;
+                }
+                committed.frame = base_frame + static_cast<uint32_t>(static_cast<int32_t>(head.frame_delta));
+                committed.start_ticks = base_ticks + head.start_delta;
+                committed.value = static_cast<int64_t>(head.value);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sample.sequence.load(std::memory_order_relaxed) != seq_before)
+            {
+                // A producer overwrote this slot mid-copy; drop the torn sample.
+                continue;
+            }
+            committed.name = m_sample_names[head.name - 1].load(std::memory_order_acquire);
+            if (committed.name == nullptr)
+            {
+                continue;
+            }
+            if (head.thread != NO_THREAD_INDEX)
+            {
+                committed.thread_id = static_cast<uint32_t>(
+                    m_sample_threads[head.thread].load(std::memory_order_acquire) - 1);
+            }
+            visit(committed);
+        }
+    }
+
+    uint16_t Profiler::intern_name(const char *name) noexcept
+    {
+        if (name == nullptr)
+        {
+            return 0;
+        }
+        // Keyed by the pointer, as find_scope() is; an id is never released, so a claimed entry is final.
+        const auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(name)) * 0x9E3779B97F4A7C15ULL;
+        const auto start = static_cast<size_t>(hash >> 32);
+        for (size_t probe = 0; probe < MAX_INTERN_PROBES; ++probe)
+        {
+            const size_t index = (start + probe) % MAX_SAMPLE_NAMES;
+            std::atomic<const char *> &entry = m_sample_names[index];
+            const char *owner = entry.load(std::memory_order_acquire);
+            // A failed claim leaves the winner in owner, which may be this same name.
+            if ((owner == nullptr &&
+                 entry.compare_exchange_strong(owner, name, std::memory_order_acq_rel, std::memory_order_acquire)) ||
+                owner == name)
+            {
+                return static_cast<uint16_t>(index + 1);
+            }
+        }
+        return 0;
+    }
+
+    uint16_t Profiler::intern_thread(uint32_t thread_id) noexcept
+    {
+        const uint64_t key = static_cast<uint64_t>(thread_id) + 1;
+        const uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+        const auto start = static_cast<size_t>(hash >> 32);
+        for (size_t probe = 0; probe < MAX_INTERN_PROBES; ++probe)
+        {
+            const size_t index = (start + probe) % MAX_SAMPLE_THREADS;
+            std::atomic<uint64_t> &entry = m_sample_threads[index];
+            uint64_t owner = entry.load(std::memory_order_acquire);
+            if ((owner == 0 &&
+                 entry.compare_exchange_strong(owner, key, std::memory_order_acq_rel, std::memory_order_acquire)) ||
+                owner == key)
+            {
+                return static_cast<uint16_t>(index);
+            }
+        }
+        return NO_THREAD_INDEX;
+    }
+
+    Profiler::ScopeSlot *Profiler::find_scope(SampleRing &ring, const char *name, bool shared) noexcept
+    {
+        // The slot is keyed by the name pointer, which every DMK_PROFILE_SCOPE site passes unchanged; stats() merges
+        // equal names behind different pointers.
+        const auto hash = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(name)) * 0x9E3779B97F4A7C15ULL;
+        const auto start = static_cast<size_t>(hash >> 32);
+        for (size_t probe = 0; probe < MAX_SCOPES_PER_RING; ++probe)
+        {
+            ScopeSlot &candidate = ring.scopes[(start + probe) % MAX_SCOPES_PER_RING];
+            const char *owner = candidate.name.load(std::memory_order_acquire);
+            if (owner == nullptr)
+            {
+                // The ring's own thread claims a free slot with a store; the shared ring's writers race for it, and
+                // a lost race leaves the winner's name in owner, which may still be ours.
+                if (!shared)
+                {
+                    candidate.name.store(name, std::memory_order_release);
+                    owner = name;
+                }
+                else if (candidate.name.compare_exchange_strong(owner, name, std::memory_order_acq_rel))
+                {
+                    owner = name;
+                }
+            }
+            if (owner == name)
+            {
+                return &candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    void Profiler::accumulate(SampleRing &ring, const char *name, uint32_t duration_us, bool shared) noexcept
+    {
+        ScopeSlot *slot = find_scope(ring, name, shared);
+        if (slot == nullptr)
+        {
+            // Every slot holds another name; the sample is only in the ring.
+            return;
+        }
+
+        auto &bucket = slot->histogram[ScopeStats::bucket_of(duration_us)];
+        if (!shared)
+        {
+            // One writer, so a load and a store cannot lose an update; readers see each counter whole.
+            bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            slot->total_us.store(slot->total_us.load(std::memory_order_relaxed) + duration_us,
+                                 std::memory_order_relaxed);
+            if (duration_us < slot->min_us.load(std::memory_order_relaxed))
+            {
+                slot->min_us.store(duration_us, std::memory_order_relaxed);
+            }
+            if (duration_us > slot->max_us.load(std::memory_order_relaxed))
+            {
+                slot->max_us.store(duration_us, std::memory_order_relaxed);
+            }
+            // The count goes last, with release, so a reader that sees it also sees the sample's other fields.
+            slot->count.store(slot->count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            return;
+        }
+
+        (void)bucket.fetch_add(1, std::memory_order_relaxed);
+        (void)slot->total_us.fetch_add(duration_us, std::memory_order_relaxed);
+        uint32_t seen = slot->min_us.load(std::memory_order_relaxed);
+        while (duration_us < seen && !slot->min_us.compare_exchange_weak(seen, duration_us, std::memory_order_relaxed))
+        {
+        }
+        seen = slot->max_us.load(std::memory_order_relaxed);
+        while (duration_us > seen && !slot->max_us.compare_exchange_weak(seen, duration_us, std::memory_order_relaxed))
+        {
+        }
+        (void)slot->count.fetch_add(1, std::memory_order_release);
+    }
+
+    uint32_t Profiler::elapsed_us(int64_t start_ticks, int64_t end_ticks) const noexcept
     {
         // Clamp a non-positive delta (end before start: swapped arguments or a backwards clock read) to zero so the
         // unsigned cast below cannot wrap a negative value into a bogus multi-minute duration.
         const int64_t delta_ticks = end_ticks > start_ticks ? end_ticks - start_ticks : 0;
 
         // Convert ticks to microseconds: (delta * 1'000'000) / frequency. The 64-bit intermediate (delta * 1'000'000)
-        // cannot overflow for any realistic
-        // delta: at a 10 MHz QPC frequency it would take a delta over ~922,000 seconds.
-        // duration_us is additionally clamped to UINT32_MAX microseconds (~71 minutes).
-        const auto duration_us = static_cast<uint32_t>(
-            std::min<int64_t>((delta_ticks * 1'000'000) / m_qpc_frequency, static_cast<int64_t>(UINT32_MAX)));
+        // overflows only past INT64_MAX / 1'000'000 ticks: ~922,000 seconds at a 10 MHz QPC frequency, but under an
+        // hour for a multi-GHz TSC, so such a delta goes straight to the clamp. duration_us is clamped to UINT32_MAX
+        // microseconds (~71 minutes).
+        constexpr int64_t max_exact_delta = INT64_MAX / 1'000'000;
+        return static_cast<uint32_t>(
+            delta_ticks > max_exact_delta
+                ? static_cast<int64_t>(UINT32_MAX)
+                : std::min<int64_t>((delta_ticks * 1'000'000) / m_tick_frequency, static_cast<int64_t>(UINT32_MAX)));
+    }
 
-        const size_t idx = m_write_pos.fetch_add(1, std::memory_order_relaxed) & m_mask;
+    Profiler::SampleRing &Profiler::write_sample(ProfileSampleKind kind, uint32_t frame, const char *name,
+                                                 int64_t start_ticks, int64_t value, uint32_t thread_id) noexcept
+    {
+        static_assert(std::atomic<uint16_t>::is_always_lock_free,
+                      "sequence counter must be lock-free for the seqlock protocol");
 
-        auto &sample = m_buffer[idx];
+        const uint16_t name_id = intern_name(name);
+        const uint16_t thread = intern_thread(thread_id);
+        if (SampleRing *ring = ring_for_current_thread())
+        {
+            // This thread is the ring's only writer, so the write position needs no read-modify-write. It is stored
+            // last, so an exporter that reads it never counts a sample whose window has not opened.
+            size_t pos = ring->write_pos.load(std::memory_order_relaxed);
+            size_t recorded = ring->recorded.load(std::memory_order_relaxed);
+            if (frame != ring->frame)
+            {
+                // The first sample since a marker closed this writer's frame. A frame not kept gives back the slots
+                // its samples took; the caller's acquire load of the frame index makes its verdict visible here.
+                if (!frame_kept(ring->frame))
+                {
+                    pos = ring->frame_start;
+                    recorded = ring->frame_start_recorded;
+                }
+                ring->frame = frame;
+                ring->frame_start = pos;
+                ring->frame_start_recorded = recorded;
+            }
+            const bool wide = write_record(ring->samples.get(), ring->bases.get(), pos, kind, frame, name_id,
+                                           start_ticks, value, thread, false);
+            ring->recorded.store(recorded + 1, std::memory_order_relaxed);
+            ring->write_pos.store(pos + (wide ? 2 : 1), std::memory_order_release);
+            return *ring;
+        }
 
-        // Open the write window with a monotonic increment. The result is guaranteed odd because every closed sequence
-        // is even (sequence starts at 0 in the constructor and reset(), and each record() contributes exactly +2).
-        // Using fetch_add avoids the load-then-store RMW pattern: a producer preempted between a relaxed load and its
-        // first store could otherwise roll the slot's sequence backwards if another producer completed a full write on
-        // the same slot in the interim. fetch_add forbids that rollback.
-        //
-        // Design note: if a writer is stalled between its fetch_add and its final sequence store, and 65536 intervening
-        // record() calls advance m_write_pos past a full buffer wrap, a new writer will land on the same slot and
-        // clobber the stalled writer's data. This requires the stalled writer to be preempted for the duration of an
-        // entire ring buffer cycle, which is unreachable at game-modding thread counts and frame rates. We accept this
-        // theoretical imprecision to keep the hot path to a single fetch_add + two stores with no CAS retry loop.
+        // The shared ring: any number of threads past MAX_THREAD_RINGS write it at once, each sample in two slots.
         //
-        // Monotonicity is unconditionally guaranteed by fetch_add: per
-        // [atomics.types.operations] the counter cannot roll backwards regardless of how many producers race on the
-        // same slot. Do NOT replace this with a load-then-store RMW: that would re-introduce the stale-publish race on
-        // wrap collision that this protocol exists to prevent.
-        static_assert(std::atomic<uint32_t>::is_always_lock_free,
-                      "sequence counter must be lock-free for the seqlock protocol");
-        (void)sample.sequence.fetch_add(1, std::memory_order_acq_rel);
+        // Design note: if a writer is stalled between its fetch_add and its final sequence store, and a ring's worth of
+        // intervening record() calls advance the write position past a full buffer wrap, a new writer will land on the
+        // same slots and clobber the stalled writer's data. This requires the stalled writer to be preempted for the
+        // duration of an entire ring buffer cycle, which is unreachable at game-modding thread counts and frame rates.
+        // We accept this theoretical imprecision to keep the hot path to a single fetch_add + two slot writes with no
+        // CAS retry loop.
+        const size_t pos = m_shared.write_pos.fetch_add(2, std::memory_order_relaxed);
+        m_shared.recorded.fetch_add(1, std::memory_order_relaxed);
+        (void)write_record(m_shared.samples.get(), m_shared.bases.get(), pos, kind, frame, name_id, start_ticks, value,
+                           thread, true);
+        return m_shared;
+    }
 
-        // Publish the payload through std::atomic_ref rather than plain stores. The exporter reads these same fields
-        // concurrently under the seqlock, so plain non-atomic stores here would be a formal C++ data race even though
-        // they are benign for aligned scalars on x86. Relaxed ordering is sufficient: the odd/even sequence protocol
-        // provides the synchronization. The opening fetch_add above is acq_rel and the closing fetch_add below is
-        // release, so a reader that sees an even sequence (via its acquire load) is guaranteed to see these stores;
-        // the counter, not the payload ordering, is what makes the sample consistent.
-        std::atomic_ref<const char *>(sample.name).store(name, std::memory_order_relaxed);
-        std::atomic_ref<int64_t>(sample.start_ticks).store(start_ticks, std::memory_order_relaxed);
-        std::atomic_ref<uint32_t>(sample.duration_us).store(duration_us, std::memory_order_relaxed);
-        std::atomic_ref<uint32_t>(sample.thread_id).store(thread_id, std::memory_order_relaxed);
+    void Profiler::record(const char *name, int64_t start_ticks, int64_t end_ticks, uint32_t thread_id) noexcept
+    {
+        const uint32_t duration_us = elapsed_us(start_ticks, end_ticks);
+        const uint32_t frame = m_frame_index.load(std::memory_order_acquire);
+        SampleRing &ring = write_sample(ProfileSampleKind::Duration, frame, name, start_ticks, duration_us, thread_id);
+        if (name != nullptr)
+        {
+            accumulate(ring, name, duration_us, &ring == &m_shared);
+            if (std::byte *stream = m_stream.load(std::memory_order_acquire))
+            {
+                publish_to_stream(stream, frame, name, to_qpc_ticks(start_ticks), duration_us, thread_id);
+            }
+        }
+    }
+
+    void Profiler::record_counter(const char *name, int64_t value) noexcept
+    {
+        if (name == nullptr)
+        {
+            return;
+        }
+        (void)write_sample(ProfileSampleKind::Counter, m_frame_index.load(std::memory_order_acquire), name,
+                           now_ticks(), value, static_cast<uint32_t>(GetCurrentThreadId()));
+    }
+
+    uint64_t Profiler::new_flow_id() noexcept
+    {
+        return m_next_flow_id.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void Profiler::record_flow_begin(const char *name, uint64_t flow_id) noexcept
+    {
+        if (name == nullptr)
+        {
+            return;
+        }
+        (void)write_sample(ProfileSampleKind::FlowBegin, m_frame_index.load(std::memory_order_acquire), name,
+                           now_ticks(), static_cast<int64_t>(flow_id), static_cast<uint32_t>(GetCurrentThreadId()));
+    }
 
-        // Close the write window. Another +1 keeps the slot's sequence monotonic and lands it on an even value,
-        // signalling a fully committed sample. Readers that observe an odd value skip this slot to avoid reading torn
-        // fields.
-        (void)sample.sequence.fetch_add(1, std::memory_order_release);
+    void Profiler::record_flow_end(const char *name, uint64_t flow_id) noexcept
+    {
+        if (name == nullptr)
+        {
+            return;
+        }
+        (void)write_sample(ProfileSampleKind::FlowEnd, m_frame_index.load(std::memory_order_acquire), name,
+                           now_ticks(), static_cast<int64_t>(flow_id), static_cast<uint32_t>(GetCurrentThreadId()));
     }
 
     // Caller must ensure no concurrent record() calls are in flight. There is no runtime guard because adding an atomic
@@ -170,35 +974,71 @@ namespace DetourModKit
     // relevant during session boundaries.
     void Profiler::reset() noexcept
     {
-        m_write_pos.store(0, std::memory_order_relaxed);
-        for (size_t i = 0; i < m_capacity; ++i)
+        const auto clear = [](SampleRing &ring) noexcept
+        {
+            ring.write_pos.store(0, std::memory_order_relaxed);
+            ring.recorded.store(0, std::memory_order_relaxed);
+            for (size_t i = 0; i < DEFAULT_CAPACITY; ++i)
+            {
+                auto &sample = ring.samples[i];
+                sample.sequence.store(0, std::memory_order_relaxed);
+                // Zero the payload through std::atomic_ref for the same reason record() does: reset() is contractually
+                // single-threaded against record(), but a cold-path export() may still be walking the ring, so the
+                // plain-store form would be a data race against that reader. Relaxed matches the seqlock read side.
+                store_payload(sample, SlotPayload{});
+            }
+            for (size_t i = 0; i < 2 * RING_BLOCKS; ++i)
+            {
+                ring.bases[i].sequence.store(0, std::memory_order_relaxed);
+            }
+            ring.frame = 0;
+            ring.frame_start = 0;
+            ring.frame_start_recorded = 0;
+            for (size_t i = 0; i < MAX_SCOPES_PER_RING; ++i)
+            {
+                ScopeSlot &slot = ring.scopes[i];
+                slot.name.store(nullptr, std::memory_order_relaxed);
+                slot.count.store(0, std::memory_order_relaxed);
+                slot.total_us.store(0, std::memory_order_relaxed);
+                slot.calls.store(0, std::memory_order_relaxed);
+                slot.skipped.store(0, std::memory_order_relaxed);
+                slot.every.store(1, std::memory_order_relaxed);
+                slot.rate_generation.store(0, std::memory_order_relaxed);
+                slot.min_us.store(UINT32_MAX, std::memory_order_relaxed);
+                slot.max_us.store(0, std::memory_order_relaxed);
+                for (auto &bucket : slot.histogram)
+                {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+            }
+        };
+        clear(m_shared);
+        // Threads keep their entries and rings; only the samples go.
+        for (ThreadRingEntry &entry : m_thread_rings)
+        {
+            if (SampleRing *ring = entry.ring.load(std::memory_order_acquire))
+            {
+                clear(*ring);
+            }
+        }
+        // Sample rates are settings and survive; frame numbering starts over.
+        m_frame_index.store(0, std::memory_order_relaxed);
+        m_frame_start.store(INT64_MIN, std::memory_order_relaxed);
+        m_frames_over_budget.store(0, std::memory_order_relaxed);
+        for (auto &verdict : m_frame_verdicts)
         {
-            auto &sample = m_buffer[i];
-            sample.sequence.store(0, std::memory_order_relaxed);
-            // Zero the payload through std::atomic_ref for the same reason record() does: reset() is contractually
-            // single-threaded against record(), but a cold-path export() may still be walking the buffer, so the
-            // plain-store form would be a data race against that reader. Relaxed matches the seqlock read side.
-            std::atomic_ref<const char *>(sample.name).store(nullptr, std::memory_order_relaxed);
-            std::atomic_ref<int64_t>(sample.start_ticks).store(0, std::memory_order_relaxed);
-            std::atomic_ref<uint32_t>(sample.duration_us).store(0, std::memory_order_relaxed);
-            std::atomic_ref<uint32_t>(sample.thread_id).store(0, std::memory_order_relaxed);
+            verdict.store(0, std::memory_order_relaxed);
         }
     }
 
     std::string Profiler::export_chrome_json() const
     {
-        const size_t total = m_write_pos.load(std::memory_order_relaxed);
-        const size_t count = std::min(total, m_capacity);
-
+        const size_t count = available_samples();
         if (count == 0)
         {
             return "[]";
         }
 
-        // Determine start index: if the buffer has wrapped, start from the oldest surviving sample; otherwise start
-        // from 0.
-        const size_t start_idx = (total > m_capacity) ? (total & m_mask) : 0;
-
         // Pre-allocate: ~120 bytes per JSON event is a reasonable estimate.
         std::string json;
         json.reserve(count * 120 + 4);
@@ -208,124 +1048,538 @@ namespace DetourModKit
         const double ticks_to_us = 1'000'000.0 / static_cast<double>(m_qpc_frequency);
 
         bool first = true;
-        for (size_t i = 0; i < count; ++i)
+        for_each_sample([&](const CommittedSample &sample) { append_json_event(json, sample, ticks_to_us, first); });
+        if (first)
         {
-            // Bind a non-const reference so the payload can be read through std::atomic_ref (its constructor takes a
-            // non-const lvalue). std::unique_ptr<T[]>::operator[] is const-qualified and returns a non-const T&, so
-            // this is well-formed even though export runs on a const Profiler. The reference is only read from.
-            auto &sample = m_buffer[(start_idx + i) & m_mask];
+            // Every sample belonged to a dropped frame.
+            return "[]";
+        }
 
-            // Seqlock read: load the sequence, copy the sample fields into locals, then re-load the sequence. record()
-            // opens a write with an odd sequence and closes it with the next even value, so a sample is consistent only
-            // when the pre-read sequence is even (no in-flight write) AND the post-read sequence is unchanged (no write
-            // started and finished mid-copy). The payload is read through std::atomic_ref (relaxed) to match record()'s
-            // atomic_ref stores, so the concurrent read/write pair is race-free rather than merely benign; the acquire
-            // fence between the field copies and the second sequence load stops the copies from being reordered after
-            // it. This runs on the cold export path; the second load costs nothing measurable and the producer hot path
-            // is untouched.
-            const uint32_t seq_before = sample.sequence.load(std::memory_order_acquire);
-            const char *const sampled_name = std::atomic_ref<const char *>(sample.name).load(std::memory_order_relaxed);
-            if ((seq_before & 1) != 0 || sampled_name == nullptr)
+        json += "\n]";
+        return json;
+    }
+
+    bool Profiler::export_to_file(std::string_view path) const
+    {
+        ChunkedFileSink sink(path);
+        if (!sink.is_open())
+        {
+            return false;
+        }
+        const double ticks_to_us = 1'000'000.0 / static_cast<double>(m_qpc_frequency);
+        std::string &chunk = sink.buffer();
+        chunk += "[\n";
+        bool first = true;
+        for_each_sample(
+            [&](const CommittedSample &sample)
             {
-                continue;
-            }
+                append_json_event(chunk, sample, ticks_to_us, first);
+                sink.commit();
+            });
+        // The same envelope export_chrome_json() writes, including its "[]" when no sample was written. Nothing has
+        // reached the file yet in that case: only an event can fill the chunk.
+        if (first)
+        {
+            chunk = "[]";
+            return sink.finish();
+        }
+        chunk += "\n]";
+        return sink.finish();
+    }
 
-            const char *name = sampled_name;
-            const auto start_ticks = std::atomic_ref<int64_t>(sample.start_ticks).load(std::memory_order_relaxed);
-            const auto duration_us = std::atomic_ref<uint32_t>(sample.duration_us).load(std::memory_order_relaxed);
-            const auto thread_id = std::atomic_ref<uint32_t>(sample.thread_id).load(std::memory_order_relaxed);
+    bool Profiler::export_binary(std::string_view path) const
+    {
+        ChunkedFileSink sink(path);
+        if (!sink.is_open())
+        {
+            return false;
+        }
 
-            std::atomic_thread_fence(std::memory_order_acquire);
-            const uint32_t seq_after = sample.sequence.load(std::memory_order_relaxed);
-            if (seq_after != seq_before)
+        std::string &chunk = sink.buffer();
+        append_le(chunk, profile_dump::DUMP_MAGIC);
+        append_le(chunk, profile_dump::DUMP_VERSION);
+        append_le(chunk, std::uint32_t{0});
+        append_le(chunk, m_qpc_frequency);
+
+        // Names are keyed by pointer: record() stores the caller's pointer unchanged, and every DMK_PROFILE_SCOPE
+        // site passes the same literal each time, so the table grows with the number of scopes, not of samples.
+        std::unordered_map<const char *, std::uint32_t> name_numbers;
+        for_each_sample(
+            [&](const CommittedSample &sample)
             {
-                // A producer overwrote this slot mid-copy; drop the torn sample.
-                continue;
+                const auto [it, inserted] =
+                    name_numbers.try_emplace(sample.name, static_cast<std::uint32_t>(name_numbers.size()));
+                if (inserted)
+                {
+                    const std::string_view name =
+                        std::string_view{sample.name}.substr(0, profile_dump::DUMP_MAX_NAME_LENGTH);
+                    chunk += static_cast<char>(profile_dump::DUMP_RECORD_NAME);
+                    append_le(chunk, it->second);
+                    append_le(chunk, static_cast<std::uint16_t>(name.size()));
+                    chunk += name;
+                }
+                chunk += static_cast<char>(dump_record_kind(sample.kind));
+                append_le(chunk, it->second);
+                append_le(chunk, sample.thread_id);
+                append_le(chunk, sample.start_ticks);
+                if (sample.kind == ProfileSampleKind::Duration)
+                {
+                    append_le(chunk, static_cast<std::uint32_t>(sample.value));
+                }
+                else
+                {
+                    append_le(chunk, sample.value);
+                }
+                sink.commit();
+            });
+        return sink.finish();
+    }
+
+    size_t Profiler::total_samples_recorded() const noexcept
+    {
+        size_t total = 0;
+        for_each_ring([&total](const SampleRing &ring) noexcept
+                      { total += ring.recorded.load(std::memory_order_relaxed); });
+        return total;
+    }
+
+    size_t Profiler::available_samples() const noexcept
+    {
+        size_t available = 0;
+        for_each_ring(
+            [&available](const SampleRing &ring) noexcept
+            {
+                const size_t slots = ring.write_pos.load(std::memory_order_relaxed);
+                const size_t recorded = std::min(ring.recorded.load(std::memory_order_relaxed), slots);
+                // Once wrapped, the surviving slots hold samples in the proportion the ring was written in; a ring of
+                // plain samples comes out at exactly DEFAULT_CAPACITY.
+                available += slots <= DEFAULT_CAPACITY ? recorded : recorded * DEFAULT_CAPACITY / slots;
+            });
+        return available;
+    }
+
+    size_t Profiler::capacity() const noexcept
+    {
+        return DEFAULT_CAPACITY;
+    }
+
+    int64_t Profiler::qpc_frequency() const noexcept
+    {
+        return m_qpc_frequency;
+    }
+
+    ProfilerClock Profiler::set_clock(ProfilerClock clock) noexcept
+    {
+        if (clock == ProfilerClock::Tsc && tsc_is_invariant())
+        {
+            // Count TSC ticks across a QPC interval. Spinning rather than sleeping keeps the interval tight at both
+            // ends, and the pair read at its start becomes the origin that maps TSC readings onto the QPC timeline.
+            const int64_t qpc_start = read_qpc();
+            const int64_t tsc_start = read_tsc();
+            const int64_t qpc_target = qpc_start + m_qpc_frequency * TSC_CALIBRATION_MS / 1000;
+            int64_t qpc_end = qpc_start;
+            while (qpc_end < qpc_target)
+            {
+                qpc_end = read_qpc();
+            }
+            const int64_t tsc_end = read_tsc();
+            const double tsc_frequency = static_cast<double>(tsc_end - tsc_start) *
+                                         static_cast<double>(m_qpc_frequency) /
+                                         static_cast<double>(qpc_end - qpc_start);
+            if (tsc_frequency >= static_cast<double>(m_qpc_frequency))
+            {
+                m_tick_frequency = static_cast<int64_t>(tsc_frequency);
+                m_tsc_origin = tsc_start;
+                m_qpc_origin = qpc_start;
+                m_use_tsc.store(true, std::memory_order_release);
+                reset();
+                return ProfilerClock::Tsc;
             }
+            // A TSC slower than QPC is not a clock worth switching to; fall through to QPC.
+        }
+        m_use_tsc.store(false, std::memory_order_release);
+        m_tick_frequency = m_qpc_frequency;
+        reset();
+        return ProfilerClock::Qpc;
+    }
 
-            if (!first)
+    ProfilerClock Profiler::clock() const noexcept
+    {
+        return m_use_tsc.load(std::memory_order_acquire) ? ProfilerClock::Tsc : ProfilerClock::Qpc;
+    }
+
+    int64_t Profiler::tick_frequency() const noexcept
+    {
+        return m_tick_frequency;
+    }
+
+    int64_t Profiler::now_ticks() const noexcept
+    {
+        return m_use_tsc.load(std::memory_order_relaxed) ? read_tsc() : read_qpc();
+    }
+
+    bool Profiler::tsc_is_invariant() noexcept
+    {
+        // The invariant-TSC flag lives in the extended leaf 0x80000007; a CPU whose highest extended leaf is below
+        // that has no such guarantee.
+#if defined(_MSC_VER)
+        int cpui[4]{};
+        __cpuid(cpui, static_cast<int>(0x80000000U));
+        if (static_cast<unsigned int>(cpui[0]) < 0x80000007U)
+        {
+            return false;
+        }
+        __cpuid(cpui, static_cast<int>(0x80000007U));
+        return (static_cast<unsigned int>(cpui[3]) & (1U << 8)) != 0;
+#else
+        unsigned int eax = 0;
+        unsigned int ebx = 0;
+        unsigned int ecx = 0;
+        unsigned int edx = 0;
+        if (!__get_cpuid(0x80000007U, &eax, &ebx, &ecx, &edx))
+        {
+            return false;
+        }
+        return (edx & (1U << 8)) != 0;
+#endif
+    }
+
+    int64_t Profiler::to_qpc_ticks(int64_t ticks) const noexcept
+    {
+        if (!m_use_tsc.load(std::memory_order_relaxed))
+        {
+            return ticks;
+        }
+        const double elapsed_qpc = static_cast<double>(ticks - m_tsc_origin) * static_cast<double>(m_qpc_frequency) /
+                                   static_cast<double>(m_tick_frequency);
+        return m_qpc_origin + static_cast<int64_t>(std::llround(elapsed_qpc));
+    }
+
+    std::vector<ScopeStats> Profiler::stats() const
+    {
+        std::vector<ScopeStats> merged;
+        for_each_ring(
+            [&merged](const SampleRing &ring)
             {
-                json += ",\n";
+                for (size_t i = 0; i < MAX_SCOPES_PER_RING; ++i)
+                {
+                    const ScopeSlot &slot = ring.scopes[i];
+                    const char *name = slot.name.load(std::memory_order_acquire);
+                    // The count first, with acquire: every field below then includes at least that many samples.
+                    const uint64_t count = name != nullptr ? slot.count.load(std::memory_order_acquire) : 0;
+                    const uint64_t skipped = name != nullptr ? slot.skipped.load(std::memory_order_relaxed) : 0;
+                    if (count == 0 && skipped == 0)
+                    {
+                        continue;
+                    }
+                    const std::string_view text{name};
+                    auto it = std::find_if(merged.begin(), merged.end(),
+                                           [text](const ScopeStats &entry) { return text == entry.name; });
+                    if (it == merged.end())
+                    {
+                        ScopeStats &fresh = merged.emplace_back();
+                        fresh.name = name;
+                        fresh.min_us = UINT32_MAX;
+                        it = merged.end() - 1;
+                    }
+                    it->count += count;
+                    it->skipped += skipped;
+                    it->total_us += slot.total_us.load(std::memory_order_relaxed);
+                    it->min_us = std::min(it->min_us, slot.min_us.load(std::memory_order_relaxed));
+                    it->max_us = std::max(it->max_us, slot.max_us.load(std::memory_order_relaxed));
+                    for (size_t bucket = 0; bucket < ScopeStats::HISTOGRAM_BUCKETS; ++bucket)
+                    {
+                        it->histogram[bucket] += slot.histogram[bucket].load(std::memory_order_relaxed);
+                    }
+                }
+            });
+        std::sort(merged.begin(), merged.end(), [](const ScopeStats &a, const ScopeStats &b)
+                  { return std::string_view{a.name} < std::string_view{b.name}; });
+        return merged;
+    }
+
+    std::optional<ScopeStats> Profiler::scope_stats(std::string_view name) const
+    {
+        for (ScopeStats &entry : stats())
+        {
+            if (name == entry.name)
+            {
+                return std::move(entry);
             }
-            first = false;
+        }
+        return std::nullopt;
+    }
 
-            // Chrome Trace Event Format: "X" = complete event (has duration). Escape the name to produce valid JSON
-            // even if the caller passes a string containing quotes or backslashes.
-            const double ts = static_cast<double>(start_ticks) * ticks_to_us;
-            const std::string escaped_name = escape_json_string(name);
-            json += std::format(R"({{"name":"{}","ph":"X","ts":{:.1f},"dur":{},"pid":1,"tid":{}}})", escaped_name, ts,
-                                duration_us, thread_id);
+    bool Profiler::set_sample_rate(std::string_view name, uint32_t every_n) noexcept
+    {
+        const size_t key = rate_key(name);
+        if (every_n <= 1)
+        {
+            // Back to timing every call: the name's entry, if it has one, is freed for another name.
+            for (SampleRateEntry &entry : m_sample_rates)
+            {
+                if (entry.hash.load(std::memory_order_acquire) == key)
+                {
+                    entry.every.store(1, std::memory_order_relaxed);
+                    entry.hash.store(0, std::memory_order_release);
+                }
+            }
+            (void)m_rate_generation.fetch_add(1, std::memory_order_release);
+            return true;
+        }
+        for (SampleRateEntry &entry : m_sample_rates)
+        {
+            size_t owner = entry.hash.load(std::memory_order_acquire);
+            if (owner == 0 && entry.hash.compare_exchange_strong(owner, key, std::memory_order_acq_rel))
+            {
+                owner = key;
+            }
+            if (owner != key)
+            {
+                continue;
+            }
+            entry.every.store(every_n, std::memory_order_relaxed);
+            // The generation moves after the rate is stored, so a scope that sees the new generation reads the rate.
+            (void)m_rate_generation.fetch_add(1, std::memory_order_release);
+            m_sampling_active.store(true, std::memory_order_release);
+            return true;
         }
+        return false;
+    }
 
-        json += "\n]";
-        return json;
+    uint32_t Profiler::sample_rate(std::string_view name) const noexcept
+    {
+        return lookup_sample_rate(name);
     }
 
-    bool Profiler::export_to_file(std::string_view path) const
+    uint32_t Profiler::lookup_sample_rate(std::string_view name) const noexcept
     {
-        const std::string json = export_chrome_json();
-        const std::string path_str(path);
+        const size_t key = rate_key(name);
+        for (const SampleRateEntry &entry : m_sample_rates)
+        {
+            if (entry.hash.load(std::memory_order_acquire) == key)
+            {
+                return entry.every.load(std::memory_order_relaxed);
+            }
+        }
+        return 1;
+    }
 
-        const auto closer = [](std::FILE *f) { std::fclose(f); };
-        std::FILE *file_ptr = nullptr;
+    int64_t Profiler::begin_scope(const char *name) noexcept
+    {
+        if (!m_sampling_active.load(std::memory_order_relaxed) || name == nullptr)
+        {
+            return now_ticks();
+        }
+        SampleRing *ring = ring_for_current_thread();
+        const bool shared = ring == nullptr;
+        ScopeSlot *slot = find_scope(shared ? m_shared : *ring, name, shared);
+        if (slot == nullptr)
+        {
+            // No slot to count calls in, so the scope is timed every call.
+            return now_ticks();
+        }
 
-        const errno_t err = fopen_s(&file_ptr, path_str.c_str(), "wb");
-        if (err != 0 || file_ptr == nullptr)
+        // The rate is looked up by name text only when set_sample_rate() has run since this slot last looked, which
+        // keeps the string hash off the hot path. Writers of the shared ring may refresh a slot together; they all
+        // store the same rate.
+        const uint32_t generation = m_rate_generation.load(std::memory_order_acquire);
+        if (slot->rate_generation.load(std::memory_order_relaxed) != generation)
         {
-            return false;
+            slot->every.store(lookup_sample_rate(name), std::memory_order_relaxed);
+            slot->rate_generation.store(generation, std::memory_order_relaxed);
+        }
+        const uint32_t every = slot->every.load(std::memory_order_relaxed);
+        if (every <= 1)
+        {
+            return now_ticks();
         }
 
-        std::unique_ptr<std::FILE, decltype(closer)> fp(file_ptr, closer);
-        const size_t written = std::fwrite(json.data(), 1, json.size(), fp.get());
-        if (written != json.size())
+        // One writer per thread ring, as in accumulate(): a load and a store cannot lose a count.
+        uint64_t call = 0;
+        if (!shared)
         {
-            return false;
+            call = slot->calls.load(std::memory_order_relaxed);
+            slot->calls.store(call + 1, std::memory_order_relaxed);
+        }
+        else
+        {
+            call = slot->calls.fetch_add(1, std::memory_order_relaxed);
         }
-        if (std::fflush(fp.get()) != 0)
+        if (call % every == 0)
         {
-            return false;
+            return now_ticks();
         }
-        // Release the pointer so unique_ptr does not double-close.
-        if (std::fclose(fp.release()) != 0)
+        if (!shared)
         {
-            return false;
+            slot->skipped.store(slot->skipped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
         }
-        return true;
+        else
+        {
+            (void)slot->skipped.fetch_add(1, std::memory_order_relaxed);
+        }
+        return SCOPE_SKIPPED;
     }
 
-    size_t Profiler::total_samples_recorded() const noexcept
+    void Profiler::mark_frame() noexcept
+    {
+        const int64_t now = now_ticks();
+        const int64_t opened = m_frame_start.exchange(now, std::memory_order_acq_rel);
+        const uint32_t frame = m_frame_index.load(std::memory_order_relaxed);
+        if (opened != INT64_MIN)
+        {
+            const uint32_t budget_us = m_frame_budget_us.load(std::memory_order_relaxed);
+            const bool over_budget = budget_us != 0 && elapsed_us(opened, now) > budget_us;
+            if (over_budget)
+            {
+                (void)m_frames_over_budget.fetch_add(1, std::memory_order_relaxed);
+            }
+            // The frame's own sample goes in while the frame is still open, so it is tagged with (and kept or
+            // dropped with) the frame it spans.
+            record(FRAME_SAMPLE_NAME, opened, now, static_cast<uint32_t>(GetCurrentThreadId()));
+            // The verdict is stored before the frame number moves on: a writer that sees the new number (acquire)
+            // finds the verdict of the frame it leaves.
+            m_frame_verdicts[frame & FRAME_HISTORY_MASK].store(encode_verdict(frame, over_budget),
+                                                               std::memory_order_release);
+        }
+        // The first marker opens frame 1; frame 0 holds what was recorded before it and is never judged.
+        m_frame_index.store(frame + 1, std::memory_order_release);
+    }
+
+    void Profiler::set_frame_budget_us(uint32_t budget_us) noexcept
     {
-        return m_write_pos.load(std::memory_order_relaxed);
+        m_frame_budget_us.store(budget_us, std::memory_order_relaxed);
+        reset();
     }
 
-    size_t Profiler::available_samples() const noexcept
+    uint32_t Profiler::frame_budget_us() const noexcept
     {
-        return std::min(m_write_pos.load(std::memory_order_relaxed), m_capacity);
+        return m_frame_budget_us.load(std::memory_order_relaxed);
     }
 
-    size_t Profiler::capacity() const noexcept
+    uint32_t Profiler::frame_index() const noexcept
     {
-        return m_capacity;
+        return m_frame_index.load(std::memory_order_acquire);
     }
 
-    int64_t Profiler::qpc_frequency() const noexcept
+    uint64_t Profiler::frames_over_budget() const noexcept
     {
-        return m_qpc_frequency;
+        return m_frames_over_budget.load(std::memory_order_relaxed);
+    }
+
+    bool Profiler::frame_kept(uint32_t frame) const noexcept
+    {
+        if (m_frame_budget_us.load(std::memory_order_relaxed) == 0 || frame == 0 ||
+            frame == m_frame_index.load(std::memory_order_acquire))
+        {
+            return true;
+        }
+        // A frame whose verdict has been overwritten by one FRAME_HISTORY frames later is too old to have been
+        // judged over budget as far as the export can tell, so it goes with the rest.
+        return m_frame_verdicts[frame & FRAME_HISTORY_MASK].load(std::memory_order_acquire) ==
+               encode_verdict(frame, true);
+    }
+
+    Result<void> Profiler::start_stream() noexcept
+    {
+        using namespace profile_stream;
+        std::byte *view = m_stream_view.load(std::memory_order_acquire);
+        if (view == nullptr)
+        {
+            std::wstring name;
+            try
+            {
+                name = mapping_name(static_cast<uint32_t>(GetCurrentProcessId()));
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "Profiler::start_stream"});
+            }
+            HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | SEC_COMMIT, 0,
+                                                static_cast<DWORD>(STREAM_BYTES), name.c_str());
+            if (mapping == nullptr)
+            {
+                return std::unexpected(Error{ErrorCode::SystemCallFailed, "Profiler::start_stream", GetLastError()});
+            }
+            auto *mapped = static_cast<std::byte *>(
+                MapViewOfFile(mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, STREAM_BYTES));
+            if (mapped == nullptr)
+            {
+                const DWORD error = GetLastError();
+                CloseHandle(mapping);
+                return std::unexpected(Error{ErrorCode::SystemCallFailed, "Profiler::start_stream", error});
+            }
+
+            // The mapping is created zero-filled. Whoever maps it first fills the header and installs the magic last;
+            // another DetourModKit copy in the process writes the same values, and after that only checks them.
+            StreamHeader &header = stream_header(mapped);
+            std::atomic_ref<uint64_t> magic(header.magic);
+            if (magic.load(std::memory_order_acquire) != STREAM_MAGIC)
+            {
+                std::atomic_ref<uint32_t>(header.version).store(STREAM_VERSION, std::memory_order_relaxed);
+                std::atomic_ref<uint32_t>(header.slot_count)
+                    .store(static_cast<uint32_t>(STREAM_SLOT_COUNT), std::memory_order_relaxed);
+                std::atomic_ref<uint32_t>(header.name_count)
+                    .store(static_cast<uint32_t>(STREAM_NAME_COUNT), std::memory_order_relaxed);
+                std::atomic_ref<int64_t>(header.qpc_frequency).store(m_qpc_frequency, std::memory_order_relaxed);
+                uint64_t expected = 0;
+                if (!magic.compare_exchange_strong(expected, STREAM_MAGIC, std::memory_order_acq_rel) &&
+                    expected != STREAM_MAGIC)
+                {
+                    UnmapViewOfFile(mapped);
+                    CloseHandle(mapping);
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "Profiler::start_stream"});
+                }
+            }
+
+            // Two first calls racing: the one that installs its view keeps it, the other maps nothing new.
+            std::byte *installed = nullptr;
+            if (m_stream_view.compare_exchange_strong(installed, mapped, std::memory_order_acq_rel))
+            {
+                m_stream_mapping.store(mapping, std::memory_order_release);
+                view = mapped;
+            }
+            else
+            {
+                UnmapViewOfFile(mapped);
+                CloseHandle(mapping);
+                view = installed;
+            }
+        }
+
+        if (m_stream.exchange(view, std::memory_order_acq_rel) == nullptr)
+        {
+            (void)std::atomic_ref<uint32_t>(stream_header(view).producers).fetch_add(1, std::memory_order_release);
+        }
+        return {};
+    }
+
+    void Profiler::stop_stream() noexcept
+    {
+        if (std::byte *view = m_stream.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            (void)std::atomic_ref<uint32_t>(stream_header(view).producers).fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    bool Profiler::is_streaming() const noexcept
+    {
+        return m_stream.load(std::memory_order_acquire) != nullptr;
     }
 
     ScopedProfile::ScopedProfile(const char *name, literal_tag) noexcept
-        : m_name(name), m_thread_id(GetCurrentThreadId())
+        : m_name(name), m_start_ticks(Profiler::get_instance().begin_scope(name)), m_thread_id(GetCurrentThreadId())
     {
-        LARGE_INTEGER ticks;
-        QueryPerformanceCounter(&ticks);
-        m_start_ticks = ticks.QuadPart;
     }
 
     ScopedProfile::~ScopedProfile() noexcept
     {
-        LARGE_INTEGER ticks;
-        QueryPerformanceCounter(&ticks);
-        Profiler::get_instance().record(m_name, m_start_ticks, ticks.QuadPart, m_thread_id);
+        if (m_start_ticks == Profiler::SCOPE_SKIPPED)
+        {
+            return;
+        }
+        Profiler &profiler = Profiler::get_instance();
+        profiler.record(m_name, m_start_ticks, profiler.now_ticks(), m_thread_id);
     }
 
 } // namespace DetourModKit
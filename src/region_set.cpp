@@ -0,0 +1,153 @@
+/**
+ * @file region_set.cpp
+ * @brief RegionSet construction (sort + coalesce) and its binary-searched membership queries.
+ */
+
+#include "DetourModKit/region_set.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // A span the set can hold: a non-null base whose end does not wrap. An empty Region is valid but contributes
+        // nothing, so the callers skip it after this check.
+        [[nodiscard]] bool well_formed(Region region) noexcept
+        {
+            if (region.size == 0)
+            {
+                return true;
+            }
+            const std::uintptr_t base = region.base.raw();
+            return base != 0 && region.size <= UINTPTR_MAX - base;
+        }
+
+        // Sorts @p spans by base and merges every run of overlapping or touching spans in place, leaving the
+        // RegionSet invariant. Merging touching spans too keeps the invariant simple for the scanners: no match can
+        // straddle two stored spans, because a stored boundary always borders bytes outside the set.
+        void coalesce(std::vector<Region> &spans) noexcept
+        {
+            std::sort(spans.begin(), spans.end(),
+                      [](const Region &lhs, const Region &rhs) noexcept { return lhs.base < rhs.base; });
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < spans.size(); ++i)
+            {
+                if (kept != 0)
+                {
+                    Region &last = spans[kept - 1];
+                    const std::uintptr_t last_end = last.end().raw();
+                    if (spans[i].base.raw() <= last_end)
+                    {
+                        const std::uintptr_t end = std::max(last_end, spans[i].end().raw());
+                        last.size = static_cast<std::size_t>(end - last.base.raw());
+                        continue;
+                    }
+                }
+                spans[kept++] = spans[i];
+            }
+            spans.resize(kept);
+        }
+
+        // The index of the first stored span whose end lies past @p address; the only span that can hold it.
+        [[nodiscard]] std::size_t candidate_span(std::span<const Region> spans, Address address) noexcept
+        {
+            const auto it = std::upper_bound(spans.begin(), spans.end(), address,
+                                             [](Address value, const Region &span) noexcept
+                                             { return value < span.end(); });
+            return static_cast<std::size_t>(it - spans.begin());
+        }
+    } // namespace
+
+    Result<RegionSet> RegionSet::of(std::span<const Region> regions) noexcept
+    {
+        RegionSet set;
+        try
+        {
+            set.m_ranges.reserve(regions.size());
+            for (const Region &region : regions)
+            {
+                if (!well_formed(region))
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "RegionSet::of"});
+                }
+                if (region.size != 0)
+                {
+                    set.m_ranges.push_back(region);
+                }
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "RegionSet::of"});
+        }
+        coalesce(set.m_ranges);
+        return set;
+    }
+
+    Result<void> RegionSet::add(Region region) noexcept
+    {
+        if (!well_formed(region))
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "RegionSet::add"});
+        }
+        if (region.size == 0)
+        {
+            return {};
+        }
+        // Build the merged spans beside the current ones, so an allocation failure leaves the set untouched.
+        try
+        {
+            std::vector<Region> spans;
+            spans.reserve(m_ranges.size() + 1);
+            spans.assign(m_ranges.begin(), m_ranges.end());
+            spans.push_back(region);
+            coalesce(spans);
+            m_ranges = std::move(spans);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "RegionSet::add"});
+        }
+        return {};
+    }
+
+    bool RegionSet::contains(Address address) const noexcept
+    {
+        return range_of(address).has_value();
+    }
+
+    std::optional<Region> RegionSet::range_of(Address address) const noexcept
+    {
+        const std::size_t index = candidate_span(m_ranges, address);
+        if (index == m_ranges.size() || !m_ranges[index].contains(address))
+        {
+            return std::nullopt;
+        }
+        return m_ranges[index];
+    }
+
+    std::size_t RegionSet::byte_size() const noexcept
+    {
+        std::size_t total = 0;
+        for (const Region &span : m_ranges)
+        {
+            total += span.size;
+        }
+        return total;
+    }
+
+    Region RegionSet::bounds() const noexcept
+    {
+        if (m_ranges.empty())
+        {
+            return Region{};
+        }
+        const Address lo = m_ranges.front().base;
+        return Region{lo, static_cast<std::size_t>(m_ranges.back().end().raw() - lo.raw())};
+    }
+} // namespace DetourModKit
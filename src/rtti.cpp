@@ -21,14 +21,46 @@
 
 #include "DetourModKit/rtti.hpp"
 #include "DetourModKit/memory.hpp"
+#include "DetourModKit/scan.hpp"
 
+#include "fork_join.hpp"
+#include "internal/fnv1a.hpp"
 #include "internal/memory_guarded.hpp"
 #include "internal/rtti_shared.hpp"
+#include "internal/srw_shared_mutex.hpp"
 
 #include <windows.h>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cstdint>
 #include <cstring>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// AVX2 vptr-compare kernel for classify, compiled per function with a target attribute on GCC/Clang (as in
+// value_scanner.cpp) so the rest of the TU stays baseline x86-64; the runtime active_simd_level() gate decides whether
+// it runs.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
 
 namespace DetourModKit::detail
 {
@@ -219,29 +251,176 @@ namespace DetourModKit
 
     namespace
     {
+        // Direct-mapped slots of the interned vtable -> name cache. A debug overlay labels a few hundred live types at
+        // most, so a collision is rare and costs one locked map lookup, not a walk.
+        inline constexpr std::size_t NAME_CACHE_SLOTS = 4096;
+
+        // Records the cache allocates before it stops interning. Records are never freed (a reader may still hold
+        // one), so the cap bounds what a churn of module loads and unloads can retain.
+        inline constexpr std::size_t NAME_CACHE_MAX_RECORDS = 65536;
+
+        // One interned vtable -> name mapping. Immutable once published and alive until the process exits.
+        struct NameRecord
+        {
+            std::uintptr_t vtable = 0;
+            std::uint64_t epoch = 0;
+            std::string_view name;
+        };
+
+        /**
+         * @struct TypeNameCache
+         * @brief Per-process map from a vtable to its interned mangled name, readable without a lock.
+         * @details A reader loads one slot and accepts the record only when its vtable matches and its epoch equals
+         *          the current module unload epoch, so every mapping dies the moment any image unloads. While no
+         *          loader notification is subscribed an unload would go unseen, so the cache is bypassed entirely.
+         *
+         *          A fill walks RTTI outside @ref writer and takes it only to intern the name and publish the record.
+         *          Only vtables whose meta-slot and COL sit on read-only pages are interned: those are what decide the
+         *          name, and a writable COL (a packed image, a test fixture) could be rewritten without an unload.
+         */
+        struct TypeNameCache
+        {
+            std::array<std::atomic<const NameRecord *>, NAME_CACHE_SLOTS> slots{};
+            // Guards everything below. Never held across a walk or a loader call.
+            std::mutex writer;
+            // Node-based, so a view into an element stays valid as the set grows.
+            std::unordered_set<std::string> names;
+            std::vector<std::unique_ptr<NameRecord>> records;
+            // The current epoch's record per vtable, so a slot two vtables share is refilled without a walk.
+            std::unordered_map<std::uintptr_t, const NameRecord *> by_vtable;
+            std::uint64_t by_vtable_epoch = 0;
+        };
+
+        [[nodiscard]] TypeNameCache &type_name_cache() noexcept
+        {
+            static TypeNameCache cache;
+            return cache;
+        }
+
+        [[nodiscard]] std::atomic<const NameRecord *> &name_cache_slot(std::uintptr_t vtable) noexcept
+        {
+            // Vtables are 8-byte aligned; drop the always-zero bits before masking.
+            return type_name_cache().slots[(vtable >> 3) & (NAME_CACHE_SLOTS - 1)];
+        }
+
+        // The outcome of resolving a vtable's name: an interned record, or where the caller reads the name itself.
+        struct NameLookup
+        {
+            const NameRecord *record = nullptr;
+            // Set when record is null and the vtable resolved; 0 when it does not resolve.
+            std::uintptr_t name_addr = 0;
+            std::uintptr_t module_end = 0;
+        };
+
+        // True when nothing short of an unload can change which name @p vtable resolves to.
+        [[nodiscard]] bool rtti_is_immutable(std::uintptr_t vtable, const rtti::detail::ColSite &site) noexcept
+        {
+            const Region meta_slot{Address{vtable - sizeof(std::uintptr_t)}, sizeof(std::uintptr_t)};
+            const Region col{Address{site.col_addr}, sizeof(rtti::detail::ColHead)};
+            return !memory::is_writable(meta_slot) && !memory::is_writable(col);
+        }
+
+        /**
+         * @brief Interns the name at @p site for @p vtable and publishes it, when the cache can hold it.
+         * @return The published record, or nullptr when the name is not cacheable or cannot be stored.
+         */
+        [[nodiscard]] const NameRecord *intern_type_name(std::uintptr_t vtable, const rtti::detail::ColSite &site,
+                                                         std::uint64_t epoch) noexcept
+        {
+            if (!rtti_is_immutable(vtable, site))
+                return nullptr;
+            char name[rtti::MAX_TYPE_NAME_LEN + 1];
+            const std::size_t len = rtti::detail::read_name_seh(site.name_addr, name, sizeof(name), site.module_end);
+            // Only a complete in-module name is interned; a truncated one leaves the caller on its own read.
+            if (len == 0 || len >= rtti::MAX_TYPE_NAME_LEN || site.module_end - site.name_addr <= len)
+                return nullptr;
+
+            TypeNameCache &cache = type_name_cache();
+            try
+            {
+                std::lock_guard<std::mutex> lock(cache.writer);
+                // An unload during the walk makes the record stale on arrival; a later call walks the new image.
+                if (DetourModKit::detail::module_unload_epoch() != epoch)
+                    return nullptr;
+                if (cache.by_vtable_epoch != epoch)
+                {
+                    cache.by_vtable.clear();
+                    cache.by_vtable_epoch = epoch;
+                }
+                if (cache.records.size() >= NAME_CACHE_MAX_RECORDS)
+                    return nullptr;
+                const auto interned = cache.names.emplace(name, len).first;
+                cache.records.push_back(std::make_unique<NameRecord>(NameRecord{vtable, epoch, *interned}));
+                const NameRecord *record = cache.records.back().get();
+                cache.by_vtable[vtable] = record;
+                name_cache_slot(vtable).store(record, std::memory_order_release);
+                return record;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return nullptr;
+            }
+        }
+
         /**
-         * @brief Resolves the address of the mangled-name buffer for @p vtable, plus its owning-module end.
-         * @details Thin wrapper over rtti::detail::resolve_col_site that keeps the forward walker's "name address or
-         *          zero" contract. Every failure mode of the prelude collapses to a 0 return. @p module_end_out
-         *          receives the owning module's exclusive end so the caller's name read can clamp to the module (the
-         *          RTTI-name over-read guard); it is left untouched on a 0 return.
-         * @return Address of the first byte of the NUL-terminated name, or 0 on any failure.
+         * @brief Resolves @p vtable's name through the interned cache, walking RTTI on a miss.
+         * @details A slot hit costs one acquire load and two compares. A miss retries the per-vtable map, then runs
+         *          the verified COL prelude and interns the result. When the name is not cacheable the prelude's
+         *          coordinates are returned instead, so the caller reads the name without walking twice.
          */
-        std::uintptr_t resolve_name_site(std::uintptr_t vtable, std::uintptr_t &module_end_out) noexcept
+        [[nodiscard]] NameLookup resolve_type_name(std::uintptr_t vtable) noexcept
         {
+            NameLookup out;
+            const std::optional<std::uint64_t> epoch = DetourModKit::detail::module_unload_epoch();
+            if (epoch)
+            {
+                const NameRecord *hit = name_cache_slot(vtable).load(std::memory_order_acquire);
+                if (hit && hit->vtable == vtable && hit->epoch == *epoch)
+                {
+                    out.record = hit;
+                    return out;
+                }
+
+                TypeNameCache &cache = type_name_cache();
+                std::lock_guard<std::mutex> lock(cache.writer);
+                if (cache.by_vtable_epoch == *epoch)
+                {
+                    const auto it = cache.by_vtable.find(vtable);
+                    if (it != cache.by_vtable.end())
+                    {
+                        name_cache_slot(vtable).store(it->second, std::memory_order_release);
+                        out.record = it->second;
+                        return out;
+                    }
+                }
+            }
+
             rtti::detail::ColSite site;
             if (!rtti::detail::resolve_col_site(vtable, site))
-                return 0;
-            module_end_out = site.module_end;
-            return site.name_addr;
+                return out;
+            if (epoch)
+                out.record = intern_type_name(vtable, site, *epoch);
+            if (!out.record)
+            {
+                out.name_addr = site.name_addr;
+                out.module_end = site.module_end;
+            }
+            return out;
         }
     } // anonymous namespace
 
+    std::optional<std::string_view> rtti::interned_type_name(Address vtable) noexcept
+    {
+        const NameLookup lookup = resolve_type_name(vtable.raw());
+        if (!lookup.record)
+            return std::nullopt;
+        return lookup.record->name;
+    }
+
     std::optional<std::string> rtti::type_name_of(Address vtable, std::size_t max_len) noexcept
     {
-        std::uintptr_t module_end = 0;
-        const std::uintptr_t name_addr = resolve_name_site(vtable.raw(), module_end);
-        if (name_addr == 0)
+        const NameLookup lookup = resolve_type_name(vtable.raw());
+        if (!lookup.record && lookup.name_addr == 0)
             return std::nullopt;
 
         if (max_len == 0)
@@ -252,13 +431,15 @@ namespace DetourModKit
         std::string out;
         try
         {
+            if (lookup.record)
+                return std::string(lookup.record->name.substr(0, max_len));
             out.resize(max_len + 1);
         }
         catch (...)
         {
             return std::nullopt;
         }
-        const std::size_t len = detail::read_name_seh(name_addr, out.data(), out.size(), module_end);
+        const std::size_t len = detail::read_name_seh(lookup.name_addr, out.data(), out.size(), lookup.module_end);
         if (len == 0)
             return std::nullopt;
         out.resize(len);
@@ -270,11 +451,17 @@ namespace DetourModKit
         if (!out || out_len == 0)
             return 0;
         out[0] = '\0';
-        std::uintptr_t module_end = 0;
-        const std::uintptr_t name_addr = resolve_name_site(vtable.raw(), module_end);
-        if (name_addr == 0)
+        const NameLookup lookup = resolve_type_name(vtable.raw());
+        if (lookup.record)
+        {
+            const std::string_view name = lookup.record->name.substr(0, out_len - 1);
+            std::memcpy(out, name.data(), name.size());
+            out[name.size()] = '\0';
+            return name.size();
+        }
+        if (lookup.name_addr == 0)
             return 0;
-        return detail::read_name_seh(name_addr, out, out_len, module_end);
+        return detail::read_name_seh(lookup.name_addr, out, out_len, lookup.module_end);
     }
 
     bool rtti::vtable_is_type(Address vtable, std::string_view expected) noexcept
@@ -282,8 +469,11 @@ namespace DetourModKit
         if (expected.empty() || expected.size() >= MAX_TYPE_NAME_LEN)
             return false;
 
-        std::uintptr_t module_end = 0;
-        const std::uintptr_t name_addr = resolve_name_site(vtable.raw(), module_end);
+        const NameLookup lookup = resolve_type_name(vtable.raw());
+        if (lookup.record)
+            return lookup.record->name == expected;
+        const std::uintptr_t name_addr = lookup.name_addr;
+        const std::uintptr_t module_end = lookup.module_end;
         if (name_addr == 0)
             return false;
 
@@ -825,4 +1015,545 @@ namespace DetourModKit
         const auto resolved = TypeIdentity::vtable();
         return resolved.has_value() && *resolved == vtable;
     }
+
+    namespace
+    {
+        // Objects one classify pass gathers under a single guard entry; the pass's buffers live on the stack.
+        constexpr std::size_t CLASSIFY_BATCH = 128;
+
+        // The resolved identities of one classify call: vtables[t] is the vtable of the identity labelled labels[t],
+        // in the caller's order, with the unresolvable ones left out.
+        struct ClassifySet
+        {
+            std::array<std::uintptr_t, rtti::MAX_CLASSIFY_TYPES> vtables;
+            std::array<std::uint8_t, rtti::MAX_CLASSIFY_TYPES> labels;
+            std::size_t count = 0;
+        };
+
+        // Labels each of the count vptrs with the first identity it equals. Also the tail of the AVX2 kernel.
+        void match_vptrs_scalar(const std::uintptr_t *vptrs, std::size_t count, const ClassifySet &set,
+                                std::uint8_t *out) noexcept
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::uint8_t label = rtti::CLASSIFY_NO_MATCH;
+                for (std::size_t t = 0; t < set.count; ++t)
+                {
+                    if (vptrs[i] == set.vtables[t])
+                    {
+                        label = set.labels[t];
+                        break;
+                    }
+                }
+                out[i] = label;
+            }
+        }
+
+#ifdef DMK_HAS_AVX2
+        // Four vptrs per compare against each identity in turn, stopping once all four are labelled. Identities are
+        // tried in order, so a vptr takes the first identity it equals, as in the scalar kernel.
+        DMK_AVX2_TARGET
+        void match_vptrs_avx2(const std::uintptr_t *vptrs, std::size_t count, const ClassifySet &set,
+                              std::uint8_t *out) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(vptrs + i));
+                std::uint8_t labels[4] = {rtti::CLASSIFY_NO_MATCH, rtti::CLASSIFY_NO_MATCH, rtti::CLASSIFY_NO_MATCH,
+                                          rtti::CLASSIFY_NO_MATCH};
+                unsigned int pending = 0xF;
+                for (std::size_t t = 0; t < set.count && pending != 0; ++t)
+                {
+                    const __m256i wanted = _mm256_set1_epi64x(static_cast<long long>(set.vtables[t]));
+                    const __m256i equal = _mm256_cmpeq_epi64(lanes, wanted);
+                    const unsigned int hit =
+                        static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(equal))) & pending;
+                    for (unsigned int bits = hit; bits != 0; bits &= bits - 1)
+                        labels[std::countr_zero(bits)] = set.labels[t];
+                    pending &= ~hit;
+                }
+                std::memcpy(out + i, labels, sizeof(labels));
+            }
+            match_vptrs_scalar(vptrs + i, count - i, set, out + i);
+        }
+#endif
+    } // namespace
+
+    std::size_t rtti::classify(std::span<const Address> objects, std::span<const TypeIdentity> types,
+                               std::span<std::uint8_t> out) noexcept
+    {
+        if (types.size() > MAX_CLASSIFY_TYPES)
+            return 0;
+        const std::size_t count = std::min(objects.size(), out.size());
+
+        ClassifySet set;
+        for (std::size_t t = 0; t < types.size(); ++t)
+        {
+            if (const auto vtable = types[t].vtable())
+            {
+                set.vtables[set.count] = vtable->raw();
+                set.labels[set.count] = static_cast<std::uint8_t>(t);
+                ++set.count;
+            }
+        }
+        if (set.count == 0)
+        {
+            std::fill_n(out.data(), count, CLASSIFY_NO_MATCH);
+            return count;
+        }
+
+#ifdef DMK_HAS_AVX2
+        const bool avx2 = scan::active_simd_level() >= scan::SimdLevel::Avx2;
+#endif
+        std::array<memory::ReadDescriptor, CLASSIFY_BATCH> reads;
+        std::array<std::uintptr_t, CLASSIFY_BATCH> vptrs;
+        std::array<std::uint8_t, CLASSIFY_BATCH> ok;
+        for (std::size_t first = 0; first < count; first += CLASSIFY_BATCH)
+        {
+            const std::size_t batch = std::min(CLASSIFY_BATCH, count - first);
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                reads[i] = memory::ReadDescriptor{objects[first + i],
+                                                  std::as_writable_bytes(std::span<std::uintptr_t>{&vptrs[i], 1})};
+            }
+            (void)DetourModKit::detail::guarded_read_many(reads.data(), batch, ok.data());
+            // A vptr that did not read is zeroed, which no resolved vtable equals.
+            for (std::size_t i = 0; i < batch; ++i)
+            {
+                if (ok[i] == 0)
+                    vptrs[i] = 0;
+            }
+#ifdef DMK_HAS_AVX2
+            if (avx2)
+                match_vptrs_avx2(vptrs.data(), batch, set, out.data() + first);
+            else
+                match_vptrs_scalar(vptrs.data(), batch, set, out.data() + first);
+#else
+            match_vptrs_scalar(vptrs.data(), batch, set, out.data() + first);
+#endif
+        }
+        return count;
+    }
+
+    namespace
+    {
+        // Bytes of scope one TypeIndex build chunk sweeps: enough pages that a chunk outweighs its fork-join claim,
+        // few enough that a multi-megabyte .rdata splits across every worker.
+        inline constexpr std::uintptr_t TYPE_INDEX_CHUNK_BYTES = std::uintptr_t{1} << 20;
+
+        // One qword-aligned window of a TypeIndex build.
+        struct IndexChunk
+        {
+            std::uintptr_t begin = 0;
+            std::uintptr_t end = 0;
+        };
+
+        // A validated COL a chunk sweep found, with the name its TypeDescriptor carries.
+        struct IndexHit
+        {
+            std::uintptr_t vtable = 0;
+            std::uint32_t col_offset = 0;
+            std::string name;
+        };
+
+        struct ChunkHits
+        {
+            std::vector<IndexHit> hits;
+            // The chunk's hits could not be stored; the build reports OutOfMemory.
+            bool failed = false;
+        };
+
+        /**
+         * @brief Sweeps one chunk for every validated COL, whatever its name.
+         * @details The page loop and validation of @ref sweep_range_for_name, keeping each hit instead of comparing it
+         *          to one name. A name is kept only when its NUL lies inside the owning module and below
+         *          MAX_TYPE_NAME_LEN, the names name_equals can match, so the index holds exactly what the per-query
+         *          sweep would find.
+         * @throws std::bad_alloc from the hit list.
+         */
+        [[nodiscard]] ChunkHits sweep_chunk_for_records(DetourModKit::detail::ModuleSpan mod,
+                                                        DetourModKit::detail::ModuleSpan owning, IndexChunk chunk)
+        {
+            ChunkHits out;
+            std::uintptr_t addr = chunk.begin;
+            while (addr + sizeof(std::uintptr_t) <= chunk.end)
+            {
+                const std::uintptr_t page_end = (addr | rtti::detail::PAGE_MASK) + 1;
+                const std::uintptr_t chunk_end = (page_end < chunk.end) ? page_end : chunk.end;
+                const std::size_t qwords = static_cast<std::size_t>(chunk_end - addr) / sizeof(std::uintptr_t);
+                if (qwords == 0)
+                {
+                    addr = chunk_end;
+                    continue;
+                }
+
+                std::uintptr_t buf[512];
+                const std::size_t want = (qwords < 512) ? qwords : 512;
+                if (DetourModKit::detail::guarded_read_bytes(addr, buf, want * sizeof(std::uintptr_t)))
+                {
+                    for (std::size_t j = 0; j < want; ++j)
+                    {
+                        if (!mod.contains(buf[j]))
+                            continue;
+
+                        const std::uintptr_t candidate_vtable = addr + (j + 1) * sizeof(std::uintptr_t);
+                        rtti::detail::ColSite site;
+                        const bool resolved_ok = owning.valid()
+                                                     ? rtti::detail::resolve_col_site(candidate_vtable, owning, site)
+                                                     : rtti::detail::resolve_col_site(candidate_vtable, site);
+                        if (!resolved_ok)
+                            continue;
+
+                        char name[rtti::MAX_TYPE_NAME_LEN + 1];
+                        const std::size_t len =
+                            rtti::detail::read_name_seh(site.name_addr, name, sizeof(name), site.module_end);
+                        if (len == 0 || len >= rtti::MAX_TYPE_NAME_LEN || site.module_end - site.name_addr <= len)
+                            continue;
+                        out.hits.push_back(IndexHit{candidate_vtable, site.col_offset, std::string(name, len)});
+                    }
+                }
+
+                addr += want * sizeof(std::uintptr_t);
+            }
+            return out;
+        }
+
+        /// Cuts the RTTI-bearing sections of @p mod (the whole scope when none parse) into qword-aligned chunks.
+        [[nodiscard]] std::vector<IndexChunk> plan_index_chunks(DetourModKit::detail::ModuleSpan mod)
+        {
+            ScanRange ranges[32];
+            std::size_t range_count = collect_rtti_scan_ranges(mod, ranges, 32);
+            if (range_count == 0)
+            {
+                ranges[0] = ScanRange{mod.base, mod.end};
+                range_count = 1;
+            }
+
+            std::vector<IndexChunk> chunks;
+            for (std::size_t i = 0; i < range_count; ++i)
+            {
+                std::uintptr_t begin = (ranges[i].begin + 7) & ~static_cast<std::uintptr_t>(7);
+                while (begin < ranges[i].end)
+                {
+                    const std::uintptr_t end = (ranges[i].end - begin > TYPE_INDEX_CHUNK_BYTES)
+                                                   ? begin + TYPE_INDEX_CHUNK_BYTES
+                                                   : ranges[i].end;
+                    chunks.push_back(IndexChunk{begin, end});
+                    begin = end;
+                }
+            }
+            return chunks;
+        }
+
+        [[nodiscard]] std::uint64_t hash_type_name(std::string_view name) noexcept
+        {
+            std::uint64_t hash = DetourModKit::detail::FNV1A64_OFFSET;
+            for (const char c : name)
+            {
+                hash = DetourModKit::detail::fnv1a_byte(hash, static_cast<std::uint8_t>(c));
+            }
+            return hash;
+        }
+
+        [[nodiscard]] std::uint64_t hash_vtable(std::uintptr_t vtable) noexcept
+        {
+            return DetourModKit::detail::fnv1a_int(DetourModKit::detail::FNV1A64_OFFSET, vtable);
+        }
+    } // namespace
+
+    struct rtti::TypeIndex::Impl
+    {
+        struct Type
+        {
+            std::uint32_t name_offset = 0;
+            std::uint32_t name_size = 0;
+            // First entry in `vtables`; a type's vtables are contiguous, in ascending COL.offset order.
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+        };
+
+        struct Vtable
+        {
+            std::uintptr_t vtable = 0;
+            std::uint32_t col_offset = 0;
+            std::uint32_t type = 0;
+        };
+
+        Region range{};
+        std::string names;
+        std::vector<Type> types;
+        std::vector<Vtable> vtables;
+        /// Type / vtable index + 1 per slot, 0 for empty; each size is a power of two with at least half left empty.
+        std::vector<std::uint32_t> name_slots;
+        std::vector<std::uint32_t> vtable_slots;
+
+        [[nodiscard]] std::string_view name_of(const Type &type) const noexcept
+        {
+            return std::string_view{names}.substr(type.name_offset, type.name_size);
+        }
+
+        [[nodiscard]] const Type *find(std::string_view name) const noexcept
+        {
+            const std::size_t mask = name_slots.size() - 1;
+            for (std::size_t slot = static_cast<std::size_t>(hash_type_name(name)) & mask; name_slots[slot] != 0;
+                 slot = (slot + 1) & mask)
+            {
+                const Type &type = types[name_slots[slot] - 1];
+                if (name_of(type) == name)
+                    return &type;
+            }
+            return nullptr;
+        }
+
+        [[nodiscard]] const Vtable *find(std::uintptr_t vtable) const noexcept
+        {
+            const std::size_t mask = vtable_slots.size() - 1;
+            for (std::size_t slot = static_cast<std::size_t>(hash_vtable(vtable)) & mask; vtable_slots[slot] != 0;
+                 slot = (slot + 1) & mask)
+            {
+                const Vtable &entry = vtables[vtable_slots[slot] - 1];
+                if (entry.vtable == vtable)
+                    return &entry;
+            }
+            return nullptr;
+        }
+    };
+
+    rtti::TypeIndex::TypeIndex(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    rtti::TypeIndex::TypeIndex(TypeIndex &&) noexcept = default;
+    rtti::TypeIndex &rtti::TypeIndex::operator=(TypeIndex &&) noexcept = default;
+    rtti::TypeIndex::~TypeIndex() noexcept = default;
+
+    Result<rtti::TypeIndex> rtti::TypeIndex::build(Region range, std::size_t max_workers) noexcept
+    {
+        const DetourModKit::detail::ModuleSpan mod = DetourModKit::detail::module_span(range);
+        if (!mod.valid())
+            return std::unexpected(Error{ErrorCode::InvalidRange, "rtti::TypeIndex::build"});
+
+        try
+        {
+            // Resolved once for every chunk, as scan_vtables_for_name does at its scope base.
+            const DetourModKit::detail::ModuleSpan owning =
+                DetourModKit::detail::module_span(memory::module_of(Address{mod.base}));
+            const std::vector<IndexChunk> chunks = plan_index_chunks(mod);
+            const std::size_t workers = DetourModKit::detail::in_fork_join_worker() ? 1 : max_workers;
+            std::vector<ChunkHits> swept = DetourModKit::detail::run_fork_join<IndexChunk, ChunkHits>(
+                chunks, workers,
+                [mod, owning](const IndexChunk &chunk) { return sweep_chunk_for_records(mod, owning, chunk); },
+                [](const IndexChunk &) noexcept { return ChunkHits{{}, true}; });
+
+            std::vector<IndexHit> hits;
+            for (ChunkHits &chunk : swept)
+            {
+                if (chunk.failed)
+                    return std::unexpected(Error{ErrorCode::OutOfMemory, "rtti::TypeIndex::build"});
+                std::ranges::move(chunk.hits, std::back_inserter(hits));
+            }
+
+            // Each slot is swept once, so a vtable repeats only when a malformed section table overlaps two ranges.
+            std::ranges::sort(hits, {}, &IndexHit::vtable);
+            const auto repeats = std::ranges::unique(hits, {}, &IndexHit::vtable);
+            hits.erase(repeats.begin(), repeats.end());
+            std::ranges::sort(hits,
+                              [](const IndexHit &a, const IndexHit &b)
+                              {
+                                  return std::tie(a.name, a.col_offset, a.vtable) <
+                                         std::tie(b.name, b.col_offset, b.vtable);
+                              });
+
+            auto impl = std::make_unique<Impl>();
+            impl->range = range;
+            impl->vtables.reserve(hits.size());
+            for (const IndexHit &hit : hits)
+            {
+                if (impl->types.empty() || impl->name_of(impl->types.back()) != hit.name)
+                {
+                    impl->types.push_back(Impl::Type{
+                        .name_offset = static_cast<std::uint32_t>(impl->names.size()),
+                        .name_size = static_cast<std::uint32_t>(hit.name.size()),
+                        .first = static_cast<std::uint32_t>(impl->vtables.size()),
+                    });
+                    impl->names += hit.name;
+                }
+                ++impl->types.back().count;
+                impl->vtables.push_back(Impl::Vtable{hit.vtable, hit.col_offset,
+                                                     static_cast<std::uint32_t>(impl->types.size() - 1)});
+            }
+
+            impl->name_slots.assign(std::bit_ceil(impl->types.size() * 2), 0);
+            for (std::size_t i = 0; i < impl->types.size(); ++i)
+            {
+                const std::size_t mask = impl->name_slots.size() - 1;
+                std::size_t slot = static_cast<std::size_t>(hash_type_name(impl->name_of(impl->types[i]))) & mask;
+                while (impl->name_slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+                impl->name_slots[slot] = static_cast<std::uint32_t>(i + 1);
+            }
+            impl->vtable_slots.assign(std::bit_ceil(impl->vtables.size() * 2), 0);
+            for (std::size_t i = 0; i < impl->vtables.size(); ++i)
+            {
+                const std::size_t mask = impl->vtable_slots.size() - 1;
+                std::size_t slot = static_cast<std::size_t>(hash_vtable(impl->vtables[i].vtable)) & mask;
+                while (impl->vtable_slots[slot] != 0)
+                    slot = (slot + 1) & mask;
+                impl->vtable_slots[slot] = static_cast<std::uint32_t>(i + 1);
+            }
+            return TypeIndex(std::move(impl));
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "rtti::TypeIndex::build"});
+        }
+    }
+
+    namespace
+    {
+        /**
+         * @brief Identity of the image owning @p owning: its extent, link stamp, checksum and image size.
+         * @return 0 when the headers cannot be read, so the scope is not cached.
+         */
+        [[nodiscard]] std::uint64_t owning_image_fingerprint(DetourModKit::detail::ModuleSpan owning) noexcept
+        {
+            if (!owning.valid())
+                return 0;
+            const auto dos = DetourModKit::detail::guarded_read<IMAGE_DOS_HEADER>(owning.base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE)
+                return 0;
+            const std::uintptr_t nt_addr =
+                owning.base + static_cast<std::uintptr_t>(static_cast<std::uint32_t>(dos->e_lfanew));
+            if (!owning.contains(nt_addr) || !owning.contains(nt_addr + sizeof(IMAGE_NT_HEADERS64)))
+                return 0;
+            const auto nt = DetourModKit::detail::guarded_read<IMAGE_NT_HEADERS64>(nt_addr);
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE)
+                return 0;
+
+            std::uint64_t hash = DetourModKit::detail::FNV1A64_OFFSET;
+            hash = DetourModKit::detail::fnv1a_int(hash, owning.base);
+            hash = DetourModKit::detail::fnv1a_int(hash, static_cast<std::uint64_t>(owning.end - owning.base));
+            hash = DetourModKit::detail::fnv1a_int(hash, nt->FileHeader.TimeDateStamp);
+            hash = DetourModKit::detail::fnv1a_int(hash, nt->OptionalHeader.CheckSum);
+            hash = DetourModKit::detail::fnv1a_int(hash, nt->OptionalHeader.SizeOfImage);
+            // Never the "not cacheable" sentinel.
+            return hash == 0 ? 1 : hash;
+        }
+
+        /**
+         * @struct TypeIndexCache
+         * @brief Per-process map from a scope base to its shared TypeIndex.
+         * @details An entry is trusted only for the same scope extent and while the owning image's fingerprint
+         *          matches the headers read on the current call, so a module that unloads or is replaced at the same
+         *          base is re-indexed. Loader unload notifications are not hooked, as for the export index cache.
+         */
+        struct TypeIndexCache
+        {
+            struct Entry
+            {
+                std::size_t size = 0;
+                std::uint64_t fingerprint = 0;
+                std::shared_ptr<const rtti::TypeIndex> index;
+            };
+
+            DetourModKit::detail::SrwSharedMutex mutex;
+            std::unordered_map<std::uintptr_t, Entry> entries;
+        };
+
+        [[nodiscard]] TypeIndexCache &type_index_cache() noexcept
+        {
+            static TypeIndexCache cache;
+            return cache;
+        }
+    } // namespace
+
+    Result<std::shared_ptr<const rtti::TypeIndex>> rtti::TypeIndex::shared(Region range) noexcept
+    {
+        const DetourModKit::detail::ModuleSpan mod = DetourModKit::detail::module_span(range);
+        if (!mod.valid())
+            return std::unexpected(Error{ErrorCode::InvalidRange, "rtti::TypeIndex::shared"});
+        const std::uint64_t fingerprint = owning_image_fingerprint(
+            DetourModKit::detail::module_span(memory::module_of(Address{mod.base})));
+
+        TypeIndexCache &cache = type_index_cache();
+        if (fingerprint != 0)
+        {
+            std::shared_lock<DetourModKit::detail::SrwSharedMutex> lock(cache.mutex);
+            const auto it = cache.entries.find(mod.base);
+            if (it != cache.entries.end() && it->second.size == range.size && it->second.fingerprint == fingerprint)
+                return it->second.index;
+        }
+
+        Result<TypeIndex> built = build(range);
+        if (!built)
+            return std::unexpected(built.error());
+        try
+        {
+            auto index = std::make_shared<const TypeIndex>(std::move(*built));
+            if (fingerprint == 0)
+                return index;
+
+            std::unique_lock<DetourModKit::detail::SrwSharedMutex> lock(cache.mutex);
+            TypeIndexCache::Entry &slot = cache.entries[mod.base];
+            if (slot.index && slot.size == range.size && slot.fingerprint == fingerprint)
+            {
+                // Another thread published the same index first; keep it.
+                return slot.index;
+            }
+            slot = TypeIndexCache::Entry{range.size, fingerprint, index};
+            return index;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "rtti::TypeIndex::shared"});
+        }
+    }
+
+    std::optional<Address> rtti::TypeIndex::vtable_for(std::string_view mangled) const noexcept
+    {
+        const Impl::Type *type = m_impl->find(mangled);
+        // The per-query sweep stops at MAX_REVERSE_MATCHES and cannot then promise its primary is the only one, so a
+        // name with that many vtables is ambiguous here too.
+        if (!type || type->count >= MAX_REVERSE_MATCHES)
+            return std::nullopt;
+        // Ascending COL.offset: the primaries lead, so exactly one means the second entry is not a primary.
+        const Impl::Vtable *first = &m_impl->vtables[type->first];
+        if (first->col_offset != 0 || (type->count > 1 && first[1].col_offset == 0))
+            return std::nullopt;
+        return Address{first->vtable};
+    }
+
+    std::size_t rtti::TypeIndex::vtables_for(std::string_view mangled, Address *out, std::size_t out_cap) const noexcept
+    {
+        const Impl::Type *type = m_impl->find(mangled);
+        if (!type)
+            return 0;
+        if (!out)
+            out_cap = 0;
+        const std::size_t to_write = (type->count < out_cap) ? type->count : out_cap;
+        for (std::size_t i = 0; i < to_write; ++i)
+            out[i] = Address{m_impl->vtables[type->first + i].vtable};
+        return type->count;
+    }
+
+    std::optional<std::string_view> rtti::TypeIndex::type_name_of(Address vtable) const noexcept
+    {
+        const Impl::Vtable *entry = m_impl->find(vtable.raw());
+        if (!entry)
+            return std::nullopt;
+        return m_impl->name_of(m_impl->types[entry->type]);
+    }
+
+    std::size_t rtti::TypeIndex::type_count() const noexcept
+    {
+        return m_impl->types.size();
+    }
+
+    std::size_t rtti::TypeIndex::vtable_count() const noexcept
+    {
+        return m_impl->vtables.size();
+    }
+
+    Region rtti::TypeIndex::range() const noexcept
+    {
+        return m_impl->range;
+    }
 } // namespace DetourModKit
@@ -5,12 +5,14 @@
  * Builds on top of the verified COL prelude shared with rtti.cpp:
  *   L1 identify_pointee_type  -- reverse-identify the object behind one slot.
  *   L2 reverse_scan_block     -- RTTI-label a block of slots (tooling).
+ *   L2 crawl                  -- follow the labelled slots breadth-first into an object graph (tooling).
  *   L3 heal_landmark          -- self-heal one field offset after a patch.
  *   L4 solve_fingerprint      -- recover one uniform shift across many fields.
  *   L5 HealScheduler          -- drive the heals on a frame cadence, latch per group, warn once on real drift.
  *
  * Every L1-L4 entry point is noexcept and fails closed. The hot self-heal path allocates nothing (it reuses one stack
- * PointeeType); only the explicitly tooling-only block scanner grows a vector. All reads go through the same
+ * PointeeType); only the explicitly tooling-only block scanner and crawler, and heal_report_parallel's per-call vtable
+ * verdict cache, allocate. All reads go through the same
  * SEH-guarded, module-bound-checked prelude the forward walker uses, so an unmapped page or forged COL is a clean
  * non-match, never a fault. Matching is byte-exact on the MSVC most-derived mangled name (no UnDecorateSymbolName).
  *
@@ -22,18 +24,53 @@
 #include "DetourModKit/rtti_dissect.hpp"
 #include "DetourModKit/logger.hpp"
 
+#include "DetourModKit/scan.hpp"
+
+#include "fork_join.hpp"
 #include "internal/memory_guarded.hpp"
 #include "internal/rtti_shared.hpp"
+#include "internal/srw_shared_mutex.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <stop_token>
+#include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
+
+// AVX2 prefilter kernel for the block sweep, compiled per function with a target attribute on GCC/Clang (as in
+// value_scanner.cpp) so the rest of the TU stays baseline x86-64; the runtime active_simd_level() gate decides whether
+// it runs.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
 
 namespace DetourModKit
 {
     namespace
     {
+        class VtableVerdictCache;
+
+        // The cached twin of rtti::identify_pointee_type, defined with the cache below.
+        [[nodiscard]] bool identify_pointee_cached(Address slot_addr, rtti::PointeeType &out,
+                                                   VtableVerdictCache &cache) noexcept;
+
         /**
          * @brief Soft policy filter: does a resolved slot's shape (and subobject position) satisfy the landmark's
          *        required indirection?
@@ -72,12 +109,16 @@ namespace DetourModKit
          * @brief Probe one slot: resolve, check shape, byte-exact name match.
          * @details Fills @p pt whenever the slot resolves (so the caller can read the match details), and reports
          *          whether it also passed the shape filter and the exact mangled-name compare. The name compare reuses
-         *          the same semantics as vtable_is_type: a superstring or a differing byte fails.
+         *          the same semantics as vtable_is_type: a superstring or a differing byte fails. With a @p cache the
+         *          prelude verdict for the slot's vtable comes from it (see @ref VtableVerdictCache).
          * @return true only on a full resolve + shape + exact-name match.
          */
-        [[nodiscard]] bool slot_matches(std::uintptr_t addr, const rtti::Landmark &lm, rtti::PointeeType &pt) noexcept
+        [[nodiscard]] bool slot_matches(std::uintptr_t addr, const rtti::Landmark &lm, rtti::PointeeType &pt,
+                                        VtableVerdictCache *cache = nullptr) noexcept
         {
-            if (!rtti::identify_pointee_type(Address{addr}, pt))
+            const bool identified = cache != nullptr ? identify_pointee_cached(Address{addr}, pt, *cache)
+                                                     : rtti::identify_pointee_type(Address{addr}, pt);
+            if (!identified)
                 return false;
             if (!shape_ok(pt.was_pointer, pt.col_offset, lm.indirection))
                 return false;
@@ -129,9 +170,11 @@ namespace DetourModKit
          * @details Takes the struct @p base explicitly (rather than reading @c lm.base) so a scheduler can heal
          *          from a per-frame live base without copying the landmark. Otherwise identical to the documented
          *          heal_landmark contract: nominal short-circuit, nearest-first widened grid, equidistant tie ->
-         *          HealAmbiguous, exhausted window -> HealNoMatch, malformed descriptor -> BadDescriptor.
+         *          HealAmbiguous, exhausted window -> HealNoMatch, malformed descriptor -> BadDescriptor. A @p cache
+         *          (heal_report_parallel's) changes where the prelude verdicts come from, never which slot heals.
          */
-        [[nodiscard]] Result<rtti::HealHit> heal_from(const rtti::Landmark &lm, Address base) noexcept
+        [[nodiscard]] Result<rtti::HealHit> heal_from(const rtti::Landmark &lm, Address base,
+                                                      VtableVerdictCache *cache = nullptr) noexcept
         {
             // 1. Descriptor validation. Every check below touches no memory.
             if (base.raw() < rtti::detail::MIN_VALID_PTR)
@@ -161,7 +204,7 @@ namespace DetourModKit
             // 3. Nominal slot first. An exact-offset match short-circuits before the
             //    window scan, so an unchanged offset -- or a same-typed neighbour in
             //    the window -- never reaches the ambiguity test.
-            if (slot_matches(nominal_slot, lm, pt))
+            if (slot_matches(nominal_slot, lm, pt, cache))
                 return make_hit(nominal_slot, base.raw(), pt);
 
             // 4. Widened grid scan, nearest distance first. Candidate slots are
@@ -179,7 +222,7 @@ namespace DetourModKit
 
                 bool minus_match = false;
                 rtti::HealHit minus_hit{};
-                if (minus_in && slot_matches(nominal_slot - step, lm, pt))
+                if (minus_in && slot_matches(nominal_slot - step, lm, pt, cache))
                 {
                     minus_match = true;
                     minus_hit = make_hit(nominal_slot - step, base.raw(), pt);
@@ -187,7 +230,7 @@ namespace DetourModKit
 
                 bool plus_match = false;
                 rtti::HealHit plus_hit{};
-                if (plus_in && slot_matches(nominal_slot + step, lm, pt))
+                if (plus_in && slot_matches(nominal_slot + step, lm, pt, cache))
                 {
                     plus_match = true;
                     plus_hit = make_hit(nominal_slot + step, base.raw(), pt);
@@ -207,99 +250,358 @@ namespace DetourModKit
         }
     } // anonymous namespace
 
-    Result<void> rtti::identify_pointee_typed(Address slot_addr, PointeeType &out) noexcept
+    namespace
     {
-        if (slot_addr.raw() < detail::MIN_VALID_PTR)
-            return std::unexpected(Error{ErrorCode::BadSlotAddress, "rtti::identify_pointee", slot_addr.raw()});
+        // Qwords one block-sweep window reads: a full 4 KiB page, so the read also never crosses one.
+        constexpr std::size_t SWEEP_WINDOW_SLOTS = 512;
 
-        const auto slot_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_addr.raw());
-        if (!slot_opt || *slot_opt < detail::MIN_VALID_PTR)
-            return std::unexpected(Error{ErrorCode::UnreadableSlot, "rtti::identify_pointee", slot_addr.raw()});
-        const std::uintptr_t slot_val = *slot_opt;
+        // A slot value the walk could resolve: an 8-byte-aligned user-mode address, since every MSVC polymorphic
+        // object and every vtable is pointer-aligned. Floats, small integers, nulls and kernel-half values fail here.
+        [[nodiscard]] constexpr bool plausible_slot_value(std::uintptr_t value) noexcept
+        {
+            return (value & 7) == 0 && value >= memory::USERSPACE_PTR_MIN && value < memory::USERSPACE_PTR_MAX;
+        }
 
-        detail::ColSite site;
-        bool was_pointer = false;
-        std::uintptr_t object_base = 0;
-        std::uintptr_t vtable = 0;
-
-        // Resolve the candidate vtable's owning-module span once and reuse it across both shape attempts when the
-        // second candidate lives in the same module. resolve_col_site's single-argument overload calls
-        // memory::module_of (a GetModuleHandleExW loader-lock acquisition) on every call, so the two-attempt probe
-        // below would otherwise take the loader lock up to twice per slot. The common direct-object case -- an object's
-        // vtable and its first virtual function both live in the class-defining module -- then costs a single
-        // acquisition. A genuinely cross-module second candidate (identify_pointee resolves an object whose vtable
-        // lives in a different DLL than the struct) still falls back to a fresh module_of, so the cross-DLL capability
-        // is preserved rather than regressed.
-        DetourModKit::detail::ModuleSpan first_span;
-        bool first_span_resolved = false;
-
-        // Pointer-to-object first: treat slot_val as a pointer to an object and try to resolve the pointee's vtable
-        // (*slot_val). A direct object would read its own first vtable entry here, which practically never satisfies
-        // the COL signature + pSelf cross-check, so this ordering does not misclassify real direct objects.
-        const auto vt2_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_val);
-        if (vt2_opt && *vt2_opt >= detail::MIN_VALID_PTR)
-        {
-            first_span = DetourModKit::detail::module_span(memory::module_of(Address{*vt2_opt}));
-            first_span_resolved = true;
-            if (detail::resolve_col_site(*vt2_opt, first_span, site))
-            {
-                was_pointer = true;
-                object_base = slot_val;
-                vtable = *vt2_opt;
-            }
-        }
-        // Else direct object base: the slot itself is the object, its value is the vtable. Pinned to ground truth: the
-        // object base is the slot ADDRESS, the vtable is the value READ at it (not a second deref).
-        if (vtable == 0)
-        {
-            // Reuse the first candidate's span when it also owns slot_val (the common same-module case); otherwise
-            // resolve slot_val's module afresh via the self-resolving overload (the cross-module fallback).
-            const bool resolved = (first_span_resolved && first_span.contains(slot_val))
-                                      ? detail::resolve_col_site(slot_val, first_span, site)
-                                      : detail::resolve_col_site(slot_val, site);
-            if (resolved)
+        // Bit i set for every plausible value in values[0, count), count <= 64. Also the tail of the AVX2 kernel.
+        [[nodiscard]] std::uint64_t plausible_mask_scalar(const std::uintptr_t *values, std::size_t count) noexcept
+        {
+            std::uint64_t mask = 0;
+            for (std::size_t i = 0; i < count; ++i)
             {
-                was_pointer = false;
-                object_base = slot_addr.raw();
-                vtable = slot_val;
+                if (plausible_slot_value(values[i]))
+                    mask |= std::uint64_t{1} << i;
             }
-            else
+            return mask;
+        }
+
+#ifdef DMK_HAS_AVX2
+        // Four qwords per step. The compares are signed, so a kernel-half value (top bit set) is negative and fails
+        // the floor test along with everything below USERSPACE_PTR_MIN.
+        DMK_AVX2_TARGET
+        std::uint64_t plausible_mask_avx2(const std::uintptr_t *values, std::size_t count) noexcept
+        {
+            const __m256i floor = _mm256_set1_epi64x(static_cast<long long>(memory::USERSPACE_PTR_MIN - 1));
+            const __m256i ceiling = _mm256_set1_epi64x(static_cast<long long>(memory::USERSPACE_PTR_MAX));
+            const __m256i low_bits = _mm256_set1_epi64x(7);
+            const __m256i zero = _mm256_setzero_si256();
+            std::uint64_t mask = 0;
+            std::size_t i = 0;
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values + i));
+                const __m256i in_range =
+                    _mm256_and_si256(_mm256_cmpgt_epi64(value, floor), _mm256_cmpgt_epi64(ceiling, value));
+                const __m256i aligned = _mm256_cmpeq_epi64(_mm256_and_si256(value, low_bits), zero);
+                const auto lanes = static_cast<unsigned int>(
+                    _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_and_si256(in_range, aligned))));
+                mask |= static_cast<std::uint64_t>(lanes) << i;
+            }
+            return mask | (plausible_mask_scalar(values + i, count - i) << i);
+        }
+#endif
+
+        // Writes a resolved slot's coordinates into @p out; the name is already in out.name_buf / out.name_len.
+        void publish_site(rtti::PointeeType &out, const rtti::detail::ColSite &site, std::uintptr_t slot_val,
+                          std::uintptr_t object_base, std::uintptr_t vtable, bool was_pointer) noexcept
+        {
+            out.vtable = Address{vtable};
+            out.col_addr = Address{site.col_addr};
+            out.td_addr = Address{site.td_addr};
+            out.name_addr = Address{site.name_addr};
+            out.object_base = Address{object_base};
+            out.col_offset = site.col_offset;
+            out.pointer_value = Address{slot_val};
+            out.was_pointer = was_pointer;
+
+            // Complete object with underflow clamp: a garbage or forged col_offset larger than object_base must not
+            // wrap the address; report object_base itself in that (non-physical) case.
+            out.complete_obj = Address{(object_base < site.col_offset) ? object_base : object_base - site.col_offset};
+        }
+
+        /**
+         * @brief The walk behind @ref rtti::identify_pointee_typed for a slot whose value is already read.
+         * @details Shared by the per-slot entry point and the block sweep, which reads its slots in bulk and forwards
+         *          only the plausible ones here.
+         */
+        Result<void> identify_slot_value(Address slot_addr, std::uintptr_t slot_val, rtti::PointeeType &out) noexcept
+        {
+            rtti::detail::ColSite site;
+            bool was_pointer = false;
+            std::uintptr_t object_base = 0;
+            std::uintptr_t vtable = 0;
+
+            // Resolve the candidate vtable's owning-module span once and reuse it across both shape attempts when the
+            // second candidate lives in the same module. resolve_col_site's single-argument overload calls
+            // memory::module_of (a GetModuleHandleExW loader-lock acquisition) on every call, so the two-attempt probe
+            // below would otherwise take the loader lock up to twice per slot. The common direct-object case -- an
+            // object's vtable and its first virtual function both live in the class-defining module -- then costs a
+            // single acquisition. A genuinely cross-module second candidate (identify_pointee resolves an object whose
+            // vtable lives in a different DLL than the struct) still falls back to a fresh module_of, so the cross-DLL
+            // capability is preserved rather than regressed.
+            DetourModKit::detail::ModuleSpan first_span;
+            bool first_span_resolved = false;
+
+            // Pointer-to-object first: treat slot_val as a pointer to an object and try to resolve the pointee's vtable
+            // (*slot_val). A direct object would read its own first vtable entry here, which practically never
+            // satisfies the COL signature + pSelf cross-check, so this ordering does not misclassify real direct
+            // objects.
+            const auto vt2_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_val);
+            if (vt2_opt && *vt2_opt >= rtti::detail::MIN_VALID_PTR)
+            {
+                first_span = DetourModKit::detail::module_span(memory::module_of(Address{*vt2_opt}));
+                first_span_resolved = true;
+                if (rtti::detail::resolve_col_site(*vt2_opt, first_span, site))
+                {
+                    was_pointer = true;
+                    object_base = slot_val;
+                    vtable = *vt2_opt;
+                }
+            }
+            // Else direct object base: the slot itself is the object, its value is the vtable. Pinned to ground truth:
+            // the object base is the slot ADDRESS, the vtable is the value READ at it (not a second deref).
+            if (vtable == 0)
             {
+                // Reuse the first candidate's span when it also owns slot_val (the common same-module case); otherwise
+                // resolve slot_val's module afresh via the self-resolving overload (the cross-module fallback).
+                const bool resolved = (first_span_resolved && first_span.contains(slot_val))
+                                          ? rtti::detail::resolve_col_site(slot_val, first_span, site)
+                                          : rtti::detail::resolve_col_site(slot_val, site);
+                if (resolved)
+                {
+                    was_pointer = false;
+                    object_base = slot_addr.raw();
+                    vtable = slot_val;
+                }
+                else
+                {
+                    return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+                }
+            }
+
+            // Read the name into the output buffer through the same page-bounded copy the forward walker uses. A
+            // faulted or empty name is a non-resolution. site.module_end clamps the copy to the vtable's owning module
+            // so a NUL-less edge-of-module name cannot over-read into an adjacent image.
+            const std::size_t name_len =
+                rtti::detail::read_name_seh(site.name_addr, out.name_buf, sizeof(out.name_buf), site.module_end);
+            if (name_len == 0)
+                return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+
+            // read_name_seh returns a boundary-truncated prefix when the name runs to the owning module's end without a
+            // NUL (it fills accum_cap == module_end - name_addr and appends its own output terminator). A name with no
+            // in-module terminator is not a confident identity: a forged descriptor whose non-terminated bytes equal a
+            // landmark's expected string would otherwise pass slot_matches's byte-exact pt.name() compare. Require the
+            // source terminator to sit strictly inside module_end -- a genuine name found its NUL below accum_cap, so
+            // name_addr + name_len stays below the boundary, while a boundary-truncated name lands exactly on it.
+            if (site.module_end != 0 && site.name_addr + name_len >= site.module_end)
                 return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+
+            out.name_len = static_cast<std::uint16_t>(name_len);
+            publish_site(out, site, slot_val, object_base, vtable, was_pointer);
+            return {};
+        }
+
+        /**
+         * @class VtableVerdictCache
+         * @brief The verified-prelude verdicts of one heal_report_parallel call, shared by all of its workers.
+         * @details Keyed by a candidate vtable value. A verdict records whether the COL walk failed, found a COL with
+         *          no confident name, or produced the name, so a vtable that many landmark windows see is walked once
+         *          per call rather than once per slot and worker. Entries are never changed or erased once published,
+         *          and unordered_map nodes never move, so a reader keeps its entry after the shard lock is released.
+         *          The cache lives for one call only: a module unloading later cannot leave a stale verdict behind.
+         */
+        class VtableVerdictCache
+        {
+        public:
+            enum class Outcome : std::uint8_t
+            {
+                NoCol,
+                BadName,
+                Named
+            };
+
+            struct Verdict
+            {
+                Outcome outcome = Outcome::NoCol;
+                rtti::detail::ColSite site;
+                std::string name;
+            };
+
+            /// The verdict for @p vtable, walking the prelude on a miss; nullptr when it could not be stored.
+            [[nodiscard]] const Verdict *find_or_walk(std::uintptr_t vtable) noexcept
+            {
+                Shard &shard = m_shards[(vtable >> 3) % SHARDS];
+                {
+                    std::shared_lock<DetourModKit::detail::SrwSharedMutex> lock(shard.mutex);
+                    if (const auto it = shard.entries.find(vtable); it != shard.entries.end())
+                        return &it->second;
+                }
+
+                // Walked unlocked: two workers missing on one vtable both walk it, and the first to publish wins.
+                try
+                {
+                    Verdict verdict;
+                    if (rtti::detail::resolve_col_site(vtable, verdict.site))
+                    {
+                        char name[rtti::MAX_TYPE_NAME_LEN + 1];
+                        const rtti::detail::ColSite &site = verdict.site;
+                        const std::size_t name_len =
+                            rtti::detail::read_name_seh(site.name_addr, name, sizeof(name), site.module_end);
+                        // The same confidence rule as identify_slot_value: a name with no in-module terminator fails.
+                        const bool confident =
+                            name_len != 0 && (site.module_end == 0 || site.name_addr + name_len < site.module_end);
+                        verdict.outcome = confident ? Outcome::Named : Outcome::BadName;
+                        if (confident)
+                            verdict.name.assign(name, name_len);
+                    }
+                    std::lock_guard<DetourModKit::detail::SrwSharedMutex> lock(shard.mutex);
+                    return &shard.entries.try_emplace(vtable, std::move(verdict)).first->second;
+                }
+                catch (const std::bad_alloc &)
+                {
+                    return nullptr;
+                }
+            }
+
+        private:
+            static constexpr std::size_t SHARDS = 16;
+
+            struct Shard
+            {
+                DetourModKit::detail::SrwSharedMutex mutex;
+                std::unordered_map<std::uintptr_t, Verdict> entries;
+            };
+
+            std::array<Shard, SHARDS> m_shards;
+        };
+
+        bool identify_pointee_cached(Address slot_addr, rtti::PointeeType &out, VtableVerdictCache &cache) noexcept
+        {
+            using Outcome = VtableVerdictCache::Outcome;
+            if (slot_addr.raw() < rtti::detail::MIN_VALID_PTR)
+                return false;
+            const auto slot_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_addr.raw());
+            if (!slot_opt || *slot_opt < rtti::detail::MIN_VALID_PTR || !plausible_slot_value(*slot_opt))
+                return false;
+            const std::uintptr_t slot_val = *slot_opt;
+
+            // The two shapes in identify_slot_value's order: pointer-to-object first, then direct object base. Only
+            // the prelude walks come from the cache; the slot and pointee reads are per slot. A verdict that cannot be
+            // stored sends the slot down the uncached walk instead.
+            const VtableVerdictCache::Verdict *verdict = nullptr;
+            bool was_pointer = false;
+            std::uintptr_t vtable = 0;
+            const auto vt2_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_val);
+            if (vt2_opt && *vt2_opt >= rtti::detail::MIN_VALID_PTR)
+            {
+                verdict = cache.find_or_walk(*vt2_opt);
+                if (verdict == nullptr)
+                    return identify_slot_value(slot_addr, slot_val, out).has_value();
+                if (verdict->outcome != Outcome::NoCol)
+                {
+                    was_pointer = true;
+                    vtable = *vt2_opt;
+                }
             }
+            if (vtable == 0)
+            {
+                verdict = cache.find_or_walk(slot_val);
+                if (verdict == nullptr)
+                    return identify_slot_value(slot_addr, slot_val, out).has_value();
+                if (verdict->outcome == Outcome::NoCol)
+                    return false;
+                vtable = slot_val;
+            }
+            if (verdict->outcome != Outcome::Named)
+                return false;
+
+            std::memcpy(out.name_buf, verdict->name.data(), verdict->name.size());
+            out.name_buf[verdict->name.size()] = '\0';
+            out.name_len = static_cast<std::uint16_t>(verdict->name.size());
+            publish_site(out, verdict->site, slot_val, was_pointer ? slot_val : slot_addr.raw(), vtable, was_pointer);
+            return true;
         }
 
-        // Read the name into the output buffer through the same page-bounded copy the forward walker uses. A faulted or
-        // empty name is a non-resolution. site.module_end clamps the copy to the vtable's owning module so a NUL-less
-        // edge-of-module name cannot over-read into an adjacent image.
-        const std::size_t name_len =
-            detail::read_name_seh(site.name_addr, out.name_buf, sizeof(out.name_buf), site.module_end);
-        if (name_len == 0)
-            return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+        // Deltas a fingerprint solve can test: MAX_HEAL_WINDOW / 8 shifts per side, plus zero.
+        constexpr std::size_t FINGERPRINT_MAX_DELTAS = 2 * (rtti::MAX_HEAL_WINDOW / sizeof(std::uintptr_t)) + 1;
 
-        // read_name_seh returns a boundary-truncated prefix when the name runs to the owning module's end without a NUL
-        // (it fills accum_cap == module_end - name_addr and appends its own output terminator). A name with no
-        // in-module terminator is not a confident identity: a forged descriptor whose non-terminated bytes equal a
-        // landmark's expected string would otherwise pass slot_matches's byte-exact pt.name() compare. Require the
-        // source terminator to sit strictly inside module_end -- a genuine name found its NUL below accum_cap, so
-        // name_addr + name_len stays below the boundary, while a boundary-truncated name lands exactly on it.
-        if (site.module_end != 0 && site.name_addr + name_len >= site.module_end)
-            return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+        // One bit per delta of a fingerprint solve.
+        using DeltaBits = std::array<std::uint64_t, (FINGERPRINT_MAX_DELTAS + 63) / 64>;
 
-        out.vtable = Address{vtable};
-        out.col_addr = Address{site.col_addr};
-        out.td_addr = Address{site.td_addr};
-        out.name_addr = Address{site.name_addr};
-        out.object_base = Address{object_base};
-        out.col_offset = site.col_offset;
-        out.pointer_value = Address{slot_val};
-        out.was_pointer = was_pointer;
-        out.name_len = static_cast<std::uint16_t>(name_len);
-
-        // Complete object with underflow clamp: a garbage or forged col_offset larger than object_base must not wrap
-        // the address; report object_base itself in that (non-physical) case.
-        out.complete_obj = Address{(object_base < site.col_offset) ? object_base : object_base - site.col_offset};
-        return {};
+        /**
+         * @brief Identifies every slot of the contiguous qword block [start, start + count * 8) that resolves.
+         * @details Reads a page of slots at a time and walks only the plausible values, so the floats, integers and
+         *          nulls that fill most structs cost a compare instead of a guarded read each. A window whose read
+         *          faults (the block crosses an unmapped page), or a slot straddling a page end, falls back to the
+         *          per-slot probe, which fails the same slots. @p on_slot(index, slot_addr) runs for each resolved
+         *          slot with @p pt filled, in address order; returning false ends the sweep.
+         */
+        template <typename OnSlot>
+        void sweep_slots(std::uintptr_t start, std::size_t count, rtti::PointeeType &pt, OnSlot &&on_slot) noexcept
+        {
+#ifdef DMK_HAS_AVX2
+            const bool avx2 = scan::active_simd_level() >= scan::SimdLevel::Avx2;
+#endif
+            std::uintptr_t values[SWEEP_WINDOW_SLOTS];
+            std::size_t i = 0;
+            while (i < count)
+            {
+                const std::uintptr_t window_addr = start + i * sizeof(std::uintptr_t);
+                const std::uintptr_t page_end = (window_addr | rtti::detail::PAGE_MASK) + 1;
+                std::size_t window = static_cast<std::size_t>(page_end - window_addr) / sizeof(std::uintptr_t);
+                window = std::min({window, SWEEP_WINDOW_SLOTS, count - i});
+                if (window == 0 || !DetourModKit::detail::guarded_read_bytes(window_addr, values,
+                                                                             window * sizeof(std::uintptr_t)))
+                {
+                    window = std::max<std::size_t>(window, 1);
+                    for (std::size_t k = 0; k < window; ++k)
+                    {
+                        const std::uintptr_t slot_addr = window_addr + k * sizeof(std::uintptr_t);
+                        if (rtti::identify_pointee_type(Address{slot_addr}, pt) && !on_slot(i + k, slot_addr))
+                            return;
+                    }
+                    i += window;
+                    continue;
+                }
+
+                for (std::size_t group = 0; group < window; group += 64)
+                {
+                    const std::size_t lanes = std::min<std::size_t>(64, window - group);
+#ifdef DMK_HAS_AVX2
+                    std::uint64_t mask = avx2 ? plausible_mask_avx2(values + group, lanes)
+                                              : plausible_mask_scalar(values + group, lanes);
+#else
+                    std::uint64_t mask = plausible_mask_scalar(values + group, lanes);
+#endif
+                    while (mask != 0)
+                    {
+                        const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+                        mask &= mask - 1;
+                        const std::size_t index = i + group + lane;
+                        const std::uintptr_t slot_addr = start + index * sizeof(std::uintptr_t);
+                        if (identify_slot_value(Address{slot_addr}, values[group + lane], pt).has_value() &&
+                            !on_slot(index, slot_addr))
+                            return;
+                    }
+                }
+                i += window;
+            }
+        }
+    } // anonymous namespace
+
+    Result<void> rtti::identify_pointee_typed(Address slot_addr, PointeeType &out) noexcept
+    {
+        if (slot_addr.raw() < detail::MIN_VALID_PTR)
+            return std::unexpected(Error{ErrorCode::BadSlotAddress, "rtti::identify_pointee", slot_addr.raw()});
+
+        const auto slot_opt = DetourModKit::detail::guarded_read<std::uintptr_t>(slot_addr.raw());
+        if (!slot_opt || *slot_opt < detail::MIN_VALID_PTR)
+            return std::unexpected(Error{ErrorCode::UnreadableSlot, "rtti::identify_pointee", slot_addr.raw()});
+        const std::uintptr_t slot_val = *slot_opt;
+
+        // No MSVC object or vtable lives at a kernel-half or misaligned address, so such a value resolves nothing.
+        if (!plausible_slot_value(slot_val))
+            return std::unexpected(Error{ErrorCode::NoRtti, "rtti::identify_pointee", slot_addr.raw()});
+        return identify_slot_value(slot_addr, slot_val, out);
     }
 
     bool rtti::identify_pointee_type(Address slot_addr, PointeeType &out) noexcept
@@ -328,23 +630,37 @@ namespace DetourModKit
 
         std::size_t added = 0;
         PointeeType pt;
-        for (std::size_t i = 0; i < slot_count; ++i)
+        // Appends one resolved slot; false once the vector cannot grow, which ends the sweep.
+        const auto label = [&out, &added, &pt](std::uintptr_t slot_addr, std::size_t index) noexcept
         {
-            const std::uintptr_t slot_addr = start_raw + i * stride;
-            if (!identify_pointee_type(Address{slot_addr}, pt))
-                continue;
             try
             {
-                out.push_back(LabeledSlot{Address{slot_addr}, i, pt});
+                out.push_back(LabeledSlot{Address{slot_addr}, index, pt});
             }
             catch (...)
             {
                 // A reallocation failure must not escape the noexcept boundary;
                 // stop and report the slots already appended.
-                return added;
+                return false;
             }
             ++added;
+            return true;
+        };
+
+        if (stride != sizeof(std::uintptr_t))
+        {
+            for (std::size_t i = 0; i < slot_count; ++i)
+            {
+                const std::uintptr_t slot_addr = start_raw + i * stride;
+                if (identify_pointee_type(Address{slot_addr}, pt) && !label(slot_addr, i))
+                    return added;
+            }
+            return added;
         }
+
+        // Contiguous slots: screened a page at a time, so only plausible values reach the RTTI walk.
+        sweep_slots(start_raw, slot_count, pt, [&label](std::size_t index, std::uintptr_t slot_addr) noexcept
+                    { return label(slot_addr, index); });
         return added;
     }
 
@@ -356,6 +672,126 @@ namespace DetourModKit
         return reverse_scan_block(start, byte_len / stride, out, stride);
     }
 
+    namespace
+    {
+        // One labelled field of a crawled object, carried from the parallel sweep to the serial merge.
+        struct CrawlField
+        {
+            std::ptrdiff_t offset = 0;
+            std::uintptr_t object = 0;
+            std::uintptr_t vtable = 0;
+            bool embedded = false;
+            std::string name;
+        };
+
+        // Sweeps one object's fields. Runs on a fork-join worker; a throw fails the object to no fields.
+        std::vector<CrawlField> sweep_crawl_object(std::uintptr_t object, std::size_t byte_budget)
+        {
+            std::vector<rtti::LabeledSlot> slots;
+            (void)rtti::reverse_scan_block_bytes(Address{object}, byte_budget, slots);
+            std::vector<CrawlField> fields;
+            fields.reserve(slots.size());
+            for (const rtti::LabeledSlot &slot : slots)
+            {
+                // The object's own primary and secondary vtables resolve back to the object itself.
+                const std::uintptr_t target = slot.type.complete_obj.raw();
+                if (target == object)
+                    continue;
+                fields.push_back(CrawlField{static_cast<std::ptrdiff_t>(slot.slot_addr.raw() - object), target,
+                                            slot.type.vtable.raw(), !slot.type.was_pointer,
+                                            std::string(slot.type.name())});
+            }
+            return fields;
+        }
+    } // anonymous namespace
+
+    Result<rtti::CrawlGraph> rtti::crawl(Address root, std::size_t depth, std::size_t byte_budget,
+                                         std::size_t max_workers) noexcept
+    {
+        if (byte_budget < sizeof(std::uintptr_t) || byte_budget > MAX_CRAWL_OBJECT_BYTES)
+            return std::unexpected(Error{ErrorCode::InvalidArg, "rtti::crawl"});
+        PointeeType pt;
+        if (Result<void> identified = identify_pointee_typed(root, pt); !identified)
+            return std::unexpected(identified.error());
+        if (pt.was_pointer)
+            return std::unexpected(Error{ErrorCode::NoRtti, "rtti::crawl", root.raw()});
+
+        try
+        {
+            CrawlGraph graph;
+            std::unordered_map<std::uintptr_t, std::uint32_t> node_of;
+            std::unordered_map<std::string, std::uint32_t> type_of;
+            const auto add_node = [&](std::uintptr_t object, std::uintptr_t vtable, std::string_view name,
+                                      std::uint32_t level)
+            {
+                const auto [type, inserted] =
+                    type_of.try_emplace(std::string(name), static_cast<std::uint32_t>(graph.types.size()));
+                if (inserted)
+                    graph.types.push_back(CrawlType{std::string(name), 0});
+                ++graph.types[type->second].count;
+                const auto index = static_cast<std::uint32_t>(graph.nodes.size());
+                graph.nodes.push_back(CrawlNode{Address{object}, Address{vtable}, type->second, level});
+                node_of.emplace(object, index);
+                return index;
+            };
+            add_node(pt.complete_obj.raw(), pt.vtable.raw(), pt.name(), 0);
+
+            // Level-synchronous: each level's objects are swept in parallel, then merged in node and field order so
+            // the node numbering, and so the whole graph, does not depend on which worker finished first.
+            const std::size_t workers = DetourModKit::detail::in_fork_join_worker() ? 1 : max_workers;
+            std::vector<std::uint32_t> frontier{0};
+            std::vector<std::uintptr_t> objects;
+            for (std::size_t level = 0; level < depth && !frontier.empty(); ++level)
+            {
+                objects.clear();
+                for (const std::uint32_t node : frontier)
+                    objects.push_back(graph.nodes[node].object.raw());
+                const std::vector<std::vector<CrawlField>> swept =
+                    DetourModKit::detail::run_fork_join<std::uintptr_t, std::vector<CrawlField>>(
+                        objects, workers,
+                        [byte_budget](const std::uintptr_t &object)
+                        { return sweep_crawl_object(object, byte_budget); },
+                        [](const std::uintptr_t &) noexcept { return std::vector<CrawlField>{}; });
+                graph.bytes_scanned += objects.size() * (byte_budget - byte_budget % sizeof(std::uintptr_t));
+
+                std::vector<std::uint32_t> next;
+                for (std::size_t i = 0; i < frontier.size(); ++i)
+                {
+                    for (const CrawlField &field : swept[i])
+                    {
+                        std::uint32_t to = 0;
+                        if (const auto known = node_of.find(field.object); known != node_of.end())
+                        {
+                            to = known->second;
+                        }
+                        else if (graph.nodes.size() >= MAX_CRAWL_NODES)
+                        {
+                            graph.truncated = true;
+                            continue;
+                        }
+                        else
+                        {
+                            to = add_node(field.object, field.vtable, field.name,
+                                          static_cast<std::uint32_t>(level + 1));
+                            next.push_back(to);
+                        }
+                        graph.edges.push_back(CrawlEdge{frontier[i], to, field.offset, field.embedded});
+                    }
+                }
+                frontier = std::move(next);
+            }
+            return graph;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "rtti::crawl"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::Unknown, "rtti::crawl"});
+        }
+    }
+
     Result<rtti::HealHit> rtti::heal_landmark(const Landmark &lm) noexcept
     {
         return heal_from(lm, lm.base);
@@ -391,92 +827,161 @@ namespace DetourModKit
             return std::unexpected(Error{ErrorCode::BadDescriptor, "rtti::solve_fingerprint"});
 
         // Enumerate uniform deltas in [-window, +window] stepping by pointer size (real-world layout shifts are
-        // pointer-granular). A delta is a candidate only when it satisfies every required landmark; among candidates
-        // the most optional hits wins. A tie for the top optional score latches HealAmbiguous (fail closed) only when
-        // it is between two nonzero deltas; a zero-drift candidate (delta 0, the anchor still validating) wins a tie
-        // outright, since the object is exactly where the caller anchored.
-        constexpr std::ptrdiff_t step = static_cast<std::ptrdiff_t>(sizeof(std::uintptr_t));
-        const std::ptrdiff_t w = static_cast<std::ptrdiff_t>(window_bytes);
+        // pointer-granular). Each landmark gets one bit per delta, set where its shifted slot resolves to its type and
+        // shape. The bits are filled by sweeping the union of the landmarks' windows once, so a slot that several
+        // overlapping windows share is identified once rather than once per landmark and delta, and only plausible
+        // slot values reach the prelude. The search over deltas is then word-wide ANDs and bit counts.
+        constexpr std::uintptr_t step = sizeof(std::uintptr_t);
+        const std::size_t per_side = window_bytes / step;
+        const std::size_t deltas = 2 * per_side + 1;
+        const std::size_t words = (deltas + 63) / 64;
+        const std::uintptr_t span = 2 * per_side * step;
 
+        std::array<DeltaBits, MAX_FINGERPRINT_LANDMARKS> hits{};
+        // first_slot[i] is landmark i's slot at delta -window; the rest of its window follows at pointer steps.
+        std::array<std::uintptr_t, MAX_FINGERPRINT_LANDMARKS> first_slot{};
+        std::array<std::size_t, MAX_FINGERPRINT_LANDMARKS> swept{};
+        std::size_t swept_count = 0;
         PointeeType pt;
-        bool have_best = false;
-        bool tie = false;
-        std::ptrdiff_t best_delta = 0;
-        std::size_t best_optional = 0;
-
-        const auto eval_delta = [&](std::ptrdiff_t delta) noexcept
+        for (std::size_t i = 0; i < fp.size(); ++i)
         {
-            std::size_t opt_hits = 0;
-            for (const Landmark &lm : fp)
+            const std::uintptr_t lo = base.raw() + static_cast<std::uintptr_t>(fp[i].nominal_offset) - span / 2;
+            first_slot[i] = lo;
+            if (lo + span >= lo && DetourModKit::detail::is_plausible_ptr(lo) &&
+                DetourModKit::detail::is_plausible_ptr(lo + span))
             {
-                const std::uintptr_t addr =
-                    base.raw() + static_cast<std::uintptr_t>(lm.nominal_offset) + static_cast<std::uintptr_t>(delta);
-                const bool ok = DetourModKit::detail::is_plausible_ptr(addr) && slot_matches(addr, lm, pt);
-                if (lm.required)
-                {
-                    // A missing required landmark disqualifies this delta outright; abandon it without scoring the
-                    // rest.
-                    if (!ok)
-                        return;
-                }
-                else if (ok)
-                {
-                    ++opt_hits;
-                }
+                swept[swept_count++] = i;
+                continue;
+            }
+            // A window that wraps or leaves user space is probed slot by slot, skipping the addresses outside it.
+            for (std::size_t k = 0; k < deltas; ++k)
+            {
+                const std::uintptr_t addr = lo + k * step;
+                if (DetourModKit::detail::is_plausible_ptr(addr) && slot_matches(addr, fp[i], pt))
+                    hits[i][k / 64] |= std::uint64_t{1} << (k % 64);
             }
+        }
 
-            // Every required landmark matched: this delta is a candidate.
-            if (!have_best || opt_hits > best_optional)
+        // Order the windows by 8-byte phase, then start, so each run of overlapping windows on one slot grid is
+        // swept as a single block.
+        std::sort(swept.begin(), swept.begin() + static_cast<std::ptrdiff_t>(swept_count),
+                  [&first_slot](std::size_t a, std::size_t b) noexcept
+                  {
+                      const std::uintptr_t phase_a = first_slot[a] & (step - 1);
+                      const std::uintptr_t phase_b = first_slot[b] & (step - 1);
+                      return phase_a != phase_b ? phase_a < phase_b : first_slot[a] < first_slot[b];
+                  });
+        for (std::size_t run = 0; run < swept_count;)
+        {
+            const std::uintptr_t run_lo = first_slot[swept[run]];
+            std::size_t run_end = run + 1;
+            while (run_end < swept_count && (first_slot[swept[run_end]] & (step - 1)) == (run_lo & (step - 1)) &&
+                   first_slot[swept[run_end]] <= first_slot[swept[run_end - 1]] + span + step)
             {
-                have_best = true;
-                best_optional = opt_hits;
-                best_delta = delta;
-                tie = false;
+                ++run_end;
             }
-            else if (opt_hits == best_optional && best_delta != 0)
+            const std::uintptr_t run_hi = first_slot[swept[run_end - 1]] + span;
+            const auto mark = [&](std::size_t, std::uintptr_t slot_addr) noexcept
             {
-                // An equal-score tie is genuine ambiguity only between two nonzero deltas: neither candidate sits at
-                // the caller's anchor, so there is no principled way to pick and the solve fails closed. When the
-                // incumbent is the zero-drift solution (delta 0 is probed first below, so best_delta == 0 means it
-                // already satisfies every required landmark), the anchor itself still validates: honour it. That is the
-                // "no drift -- the object is exactly where the caller anchored" reading, and it correctly resolves an
-                // array of same-typed objects to element 0 (the one at base) instead of refusing because a sibling at
-                // +stride matches equally. A strictly higher optional score at any delta still wins above; only an
-                // equal-score tie against the zero-drift incumbent is suppressed here.
-                tie = true;
+                for (std::size_t m = run; m < run_end; ++m)
+                {
+                    const std::size_t i = swept[m];
+                    if (slot_addr < first_slot[i] || slot_addr - first_slot[i] > span)
+                        continue;
+                    if (!shape_ok(pt.was_pointer, pt.col_offset, fp[i].indirection) ||
+                        pt.name() != fp[i].expected_mangled)
+                        continue;
+                    const std::size_t k = static_cast<std::size_t>((slot_addr - first_slot[i]) / step);
+                    hits[i][k / 64] |= std::uint64_t{1} << (k % 64);
+                }
+                return true;
+            };
+            sweep_slots(run_lo, static_cast<std::size_t>((run_hi - run_lo) / step) + 1, pt, mark);
+            run = run_end;
+        }
+
+        // A delta is a candidate only when it satisfies every required landmark: the AND of their bits.
+        DeltaBits candidates{};
+        for (std::size_t w = 0; w < words; ++w)
+            candidates[w] = ~std::uint64_t{0};
+        if (deltas % 64 != 0)
+            candidates[words - 1] = (std::uint64_t{1} << (deltas % 64)) - 1;
+        for (std::size_t i = 0; i < fp.size(); ++i)
+        {
+            if (!fp[i].required)
+                continue;
+            for (std::size_t w = 0; w < words; ++w)
+                candidates[w] &= hits[i][w];
+        }
+
+        const auto optional_hits = [&](std::size_t k) noexcept
+        {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < fp.size(); ++i)
+            {
+                if (!fp[i].required)
+                    count += static_cast<std::size_t>((hits[i][k / 64] >> (k % 64)) & 1);
             }
+            return count;
         };
 
-        // Iterate magnitudes 0, +step, -step, +2*step, ... so the scan is nearest-first; the decision itself is
-        // score-based, not distance-based.
-        for (std::ptrdiff_t m = 0; m <= w; m += step)
+        // Among candidates the most optional hits wins. An equal-score tie for the top is genuine ambiguity only
+        // between two nonzero deltas: neither sits at the caller's anchor, so there is no principled way to pick and
+        // the solve fails closed. When delta 0 is among the tied, the anchor itself still validates: honour it. That is
+        // the "no drift -- the object is exactly where the caller anchored" reading, and it correctly resolves an
+        // array of same-typed objects to element 0 (the one at base) instead of refusing because a sibling at +stride
+        // matches equally. A strictly higher optional score at any delta still wins.
+        bool have_best = false;
+        std::size_t best_k = 0;
+        std::size_t best_optional = 0;
+        std::size_t tied = 0;
+        for (std::size_t w = 0; w < words; ++w)
         {
-            eval_delta(m);
-            if (m != 0)
-                eval_delta(-m);
+            for (std::uint64_t bits = candidates[w]; bits != 0; bits &= bits - 1)
+            {
+                const std::size_t k = w * 64 + static_cast<std::size_t>(std::countr_zero(bits));
+                const std::size_t score = optional_hits(k);
+                if (!have_best || score > best_optional)
+                {
+                    have_best = true;
+                    best_k = k;
+                    best_optional = score;
+                    tied = 1;
+                }
+                else if (score == best_optional)
+                {
+                    ++tied;
+                }
+            }
         }
 
         if (!have_best)
             return std::unexpected(Error{ErrorCode::HealNoMatch, "rtti::solve_fingerprint", base.raw()});
-        if (tie)
+        const bool zero_tops =
+            ((candidates[per_side / 64] >> (per_side % 64)) & 1) != 0 && optional_hits(per_side) == best_optional;
+        if (zero_tops)
+            best_k = per_side;
+        else if (tied > 1)
             return std::unexpected(Error{ErrorCode::HealAmbiguous, "rtti::solve_fingerprint", base.raw()});
+        const std::ptrdiff_t best_delta =
+            (static_cast<std::ptrdiff_t>(best_k) - static_cast<std::ptrdiff_t>(per_side)) *
+            static_cast<std::ptrdiff_t>(step);
         return FingerprintHit{best_delta, required_count, best_optional};
     }
 
-    std::size_t rtti::heal_report(std::span<const Landmark> landmarks, std::span<DriftEntry> out) noexcept
+    namespace
     {
-        const std::size_t written = (landmarks.size() < out.size()) ? landmarks.size() : out.size();
-        for (std::size_t i = 0; i < written; ++i)
+        // One landmark's report entry; heal_report and heal_report_parallel differ only in the cache they pass.
+        [[nodiscard]] rtti::DriftEntry drift_entry_for(const rtti::Landmark &landmark,
+                                                       VtableVerdictCache *cache) noexcept
         {
-            const Landmark &landmark = landmarks[i];
-            DriftEntry &entry = out[i];
             // Start from a clean entry so a failed heal cannot expose stale healed_offset/delta from a reused
             // (non-zeroed) output buffer.
-            entry = DriftEntry{};
+            rtti::DriftEntry entry{};
             entry.name = landmark.expected_mangled;
             entry.nominal_offset = landmark.nominal_offset;
 
-            const auto heal = heal_landmark(landmark);
+            const auto heal = heal_from(landmark, landmark.base, cache);
             if (heal)
             {
                 entry.ok = true;
@@ -490,6 +995,66 @@ namespace DetourModKit
                 // ok stays false; healed_offset and delta stay 0 (valid only when ok).
                 entry.error = heal.error().code;
             }
+            return entry;
+        }
+    } // anonymous namespace
+
+    std::size_t rtti::heal_report(std::span<const Landmark> landmarks, std::span<DriftEntry> out) noexcept
+    {
+        const std::size_t written = (landmarks.size() < out.size()) ? landmarks.size() : out.size();
+        for (std::size_t i = 0; i < written; ++i)
+            out[i] = drift_entry_for(landmarks[i], nullptr);
+        return written;
+    }
+
+    std::size_t rtti::heal_report_parallel(std::span<const Landmark> landmarks, std::span<DriftEntry> out,
+                                           std::size_t max_workers, std::stop_token stop) noexcept
+    {
+        const std::size_t written = (landmarks.size() < out.size()) ? landmarks.size() : out.size();
+        const std::span<const Landmark> items = landmarks.first(written);
+        const std::span<DriftEntry> results = out.first(written);
+
+        std::unique_ptr<VtableVerdictCache> cache;
+        try
+        {
+            cache = std::make_unique<VtableVerdictCache>();
+        }
+        catch (const std::bad_alloc &)
+        {
+            return heal_report(items, results);
+        }
+
+        const DetourModKit::detail::BatchCancel cancel(std::move(stop));
+        const DetourModKit::detail::ScopedBatchCancel install(&cancel);
+        // A slot keeps this seed only when the stop skipped its landmark.
+        const auto skipped = [](const Landmark &landmark) noexcept
+        {
+            DriftEntry entry{};
+            entry.name = landmark.expected_mangled;
+            entry.nominal_offset = landmark.nominal_offset;
+            entry.error = ErrorCode::Cancelled;
+            return entry;
+        };
+        // A heal costs about one prelude probe per slot of its window, so the wide windows start first.
+        const auto window_slots = [](const Landmark &landmark) noexcept
+        {
+            const std::size_t stride = (landmark.stride == 0) ? sizeof(std::uintptr_t) : landmark.stride;
+            return static_cast<std::uint64_t>(landmark.window / stride) + 1;
+        };
+        try
+        {
+            DetourModKit::detail::run_fork_join_into<Landmark, DriftEntry>(
+                items, results, max_workers,
+                [&cache](const Landmark &landmark) noexcept { return drift_entry_for(landmark, cache.get()); },
+                skipped, window_slots);
+        }
+        catch (const std::bad_alloc &)
+        {
+            // Only the cost plan allocates, before any landmark runs; every slot still holds its seed.
+            DetourModKit::detail::run_fork_join_into<Landmark, DriftEntry>(
+                items, results, max_workers,
+                [&cache](const Landmark &landmark) noexcept { return drift_entry_for(landmark, cache.get()); },
+                skipped);
         }
         return written;
     }
@@ -516,6 +1081,8 @@ namespace DetourModKit
         // reference into it.
         std::vector<Group> pending;
         bool ticking = false;
+        // Where the next tick starts: the first group a budgeted tick did not reach, so deferred work runs first.
+        std::size_t next_group = 0;
     };
 
     Result<rtti::HealScheduler> rtti::HealScheduler::start(HealConfig config) noexcept
@@ -556,18 +1123,50 @@ namespace DetourModKit
         target.push_back(Impl::Group{std::move(work), std::move(gate), false, 0});
     }
 
-    void rtti::HealScheduler::tick() noexcept
+    rtti::HealTickStats rtti::HealScheduler::tick() noexcept
     {
+        return tick(std::chrono::microseconds::max());
+    }
+
+    rtti::HealTickStats rtti::HealScheduler::tick(std::chrono::microseconds budget) noexcept
+    {
+        using Clock = std::chrono::steady_clock;
+        HealTickStats stats;
         if (!m_impl)
-            return;
+            return stats;
+        const Clock::time_point started = Clock::now();
+        // A budget past the clock's headroom is no budget: the deadline saturates and the clock is never consulted.
+        const bool unlimited =
+            budget >= std::chrono::duration_cast<std::chrono::microseconds>(Clock::time_point::max() - started);
+        const Clock::time_point deadline = unlimited ? Clock::time_point::max() : started + budget;
+
         // Mark the scan in flight so a re-entrant add_group (from a work/gate callback) defers into `pending` rather
-        // than mutating `groups` under the range-for below.
+        // than mutating `groups` under the loop below.
         m_impl->ticking = true;
-        for (Impl::Group &group : m_impl->groups)
+        const std::size_t count = m_impl->groups.size();
+        const std::size_t first = count == 0 ? 0 : m_impl->next_group % count;
+        bool out_of_time = false;
+        for (std::size_t n = 0; n < count; ++n)
         {
+            const std::size_t index = (first + n) % count;
+            Impl::Group &group = m_impl->groups[index];
             if (group.latched)
                 continue;
 
+            // Once one group has run, the budget is checked before each further one. A group the tick does not reach
+            // is left exactly as it was -- gate unpolled, countdown untouched -- and the next tick starts with it.
+            if (!out_of_time && !unlimited && stats.groups_run != 0 && Clock::now() >= deadline)
+            {
+                out_of_time = true;
+                m_impl->next_group = index;
+            }
+            if (out_of_time)
+            {
+                if (group.frames_until_retry == 0)
+                    ++stats.groups_deferred;
+                continue;
+            }
+
             // Silent pre-gate, evaluated BEFORE the interval countdown: a target that is not constructed yet is polled
             // cheaply every frame and skipped without spending the retry budget or logging. A throwing gate is treated
             // as "not ready".
@@ -596,8 +1195,9 @@ namespace DetourModKit
             }
             group.frames_until_retry = m_impl->config.interval_frames;
 
-            HealRun run{m_impl->config, m_impl->drift_warned};
+            HealRun run{m_impl->config, m_impl->drift_warned, deadline};
             bool resolved = false;
+            const Clock::time_point work_start = Clock::now();
             try
             {
                 resolved = group.work(run);
@@ -607,8 +1207,20 @@ namespace DetourModKit
                 // A throwing work callback is treated as "did not resolve this frame"; the group retries next interval.
                 resolved = false;
             }
+            stats.longest_group =
+                std::max(stats.longest_group,
+                         std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - work_start));
+            ++stats.groups_run;
             if (resolved)
+            {
                 group.latched = true;
+            }
+            else if (run.m_continue)
+            {
+                // The group did part of its work and keeps its own place; it runs again next tick, not next interval.
+                group.frames_until_retry = 0;
+                ++stats.groups_continued;
+            }
         }
 
         // The scan loop is done; adopt any groups a callback deferred while ticking. insert() reserves once up front
@@ -628,6 +1240,11 @@ namespace DetourModKit
                 // Allocation failed; leave `pending` untouched so the deferred groups are retried on the next tick.
             }
         }
+
+        const Clock::time_point finished = Clock::now();
+        stats.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(finished - started);
+        stats.over_budget = !unlimited && finished > deadline;
+        return stats;
     }
 
     bool rtti::HealScheduler::all_resolved() const noexcept
@@ -673,6 +1290,14 @@ namespace DetourModKit
         }
     }
 
+    std::chrono::microseconds rtti::HealRun::remaining() const noexcept
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now >= m_deadline)
+            return std::chrono::microseconds{0};
+        return std::chrono::duration_cast<std::chrono::microseconds>(m_deadline - now);
+    }
+
     Result<rtti::HealHit> rtti::HealRun::heal_into(std::string_view label, const Landmark &landmark, Address base,
                                                    std::atomic<std::ptrdiff_t> &slot, bool required) noexcept
     {
@@ -692,8 +1317,8 @@ namespace DetourModKit
             }
             else
             {
-                (void)logger.try_log(LogLevel::Debug, "Self-heal: {} confirmed at nominal {:#x}", label,
-                                     landmark.nominal_offset);
+                (void)logger.try_log(log_category::rtti, LogLevel::Debug, "Self-heal: {} confirmed at nominal {:#x}",
+                                     label, landmark.nominal_offset);
             }
             return result;
         }
@@ -711,8 +1336,9 @@ namespace DetourModKit
         }
         else
         {
-            (void)logger.try_log(LogLevel::Debug, "Self-heal: {} not resolvable now ({}); keeping nominal {:#x}", label,
-                                 reason, landmark.nominal_offset);
+            (void)logger.try_log(log_category::rtti, LogLevel::Debug,
+                                 "Self-heal: {} not resolvable now ({}); keeping nominal {:#x}", label, reason,
+                                 landmark.nominal_offset);
         }
         return result;
     }
@@ -730,7 +1356,8 @@ namespace DetourModKit
         }
         else
         {
-            (void)logger.try_log(LogLevel::Debug, "Self-heal: {} confirmed at nominal {:#x}", label, nominal_offset);
+            (void)logger.try_log(log_category::rtti, LogLevel::Debug, "Self-heal: {} confirmed at nominal {:#x}", label,
+                                 nominal_offset);
         }
     }
 } // namespace DetourModKit
@@ -0,0 +1,395 @@
+/**
+ * @file rtti_instances.cpp
+ * @brief The live-instance finder: the chunked parallel sweep of writable memory for qwords equal to a vtable set.
+ * @details The sweep cuts the scope's writable windows into chunks like the pointer map build, and each fork-join
+ *          worker tests every aligned qword of one chunk under the page-gated scans' fault guard. A set of up to
+ *          VTABLE_COMPARE_MAX vtables is compared whole, lane by lane; a larger one is screened by its [lowest,
+ *          highest] range first, which rejects almost every qword of a heap, and the survivors probe an open-addressed
+ *          table.
+ *          Each chunk writes its hits into scratch allocated before the guard; the merge keeps chunk order, so the
+ *          matches come out ascending.
+ */
+
+#include "DetourModKit/rtti.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "fork_join.hpp"
+#include "internal/memory_fault.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+
+#include "DetourModKit/defines.hpp"
+#include "DetourModKit/region.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+// AVX2 qword-compare kernels, compiled per function with a target attribute on GCC/Clang (as in value_scanner.cpp) so
+// the rest of the TU stays baseline x86-64; the runtime active_simd_level() gate decides whether they run.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Bytes of one sweep chunk; the same granularity as the value scanner and the pointer map build. Hit offsets
+        // are relative to the chunk base, so 32 bits hold them.
+        constexpr std::size_t INSTANCE_CHUNK_BYTES = std::size_t{1} << 20;
+
+        // Sets up to this size are compared against every vtable directly; larger ones go through the table.
+        constexpr std::size_t VTABLE_COMPARE_MAX = 8;
+
+        struct Chunk
+        {
+            std::uintptr_t base = 0;
+            std::size_t bytes = 0;
+        };
+
+        struct Hit
+        {
+            std::uint32_t offset;
+            std::uint32_t vtable;
+        };
+
+        struct ChunkHits
+        {
+            std::vector<Hit> hits;
+            bool failed = false;
+        };
+
+        // The distinct vtables of one call. keys / indices list them ascending with each one's first index in the
+        // caller's span; table / table_indices is the open-addressed form a large set probes (a zero slot is empty,
+        // and no vtable is null).
+        struct VtableSet
+        {
+            std::vector<std::uintptr_t> keys;
+            std::vector<std::uint32_t> indices;
+            std::uintptr_t lo = 0;
+            std::uintptr_t hi = 0;
+            std::vector<std::uintptr_t> table;
+            std::vector<std::uint32_t> table_indices;
+            unsigned int shift = 0;
+
+            [[nodiscard]] std::size_t slot_of(std::uintptr_t value) const noexcept
+            {
+                return static_cast<std::size_t>((value * 0x9E3779B97F4A7C15ULL) >> shift);
+            }
+
+            // True when @p value is in the set, with its caller index in @p index.
+            [[nodiscard]] bool find(std::uintptr_t value, std::uint32_t &index) const noexcept
+            {
+                if (table.empty())
+                {
+                    for (std::size_t i = 0; i < keys.size(); ++i)
+                    {
+                        if (keys[i] == value)
+                        {
+                            index = indices[i];
+                            return true;
+                        }
+                    }
+                    return false;
+                }
+                const std::size_t mask = table.size() - 1;
+                for (std::size_t slot = slot_of(value);; slot = (slot + 1) & mask)
+                {
+                    if (table[slot] == value)
+                    {
+                        index = table_indices[slot];
+                        return true;
+                    }
+                    if (table[slot] == 0)
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            // True when @p value lies in buffers this set owns, whose copies of the vtables are not objects.
+            [[nodiscard]] bool owns(std::uintptr_t value) const noexcept
+            {
+                const auto inside = [value](const std::vector<std::uintptr_t> &buffer)
+                {
+                    const auto base = reinterpret_cast<std::uintptr_t>(buffer.data());
+                    return value >= base && value < base + buffer.size() * sizeof(std::uintptr_t);
+                };
+                return inside(keys) || inside(table);
+            }
+        };
+
+        // Builds the set; the table, at most half full, only for a set too large to compare whole. May throw
+        // bad_alloc.
+        [[nodiscard]] VtableSet make_set(std::span<const Address> vtables)
+        {
+            std::vector<std::pair<std::uintptr_t, std::uint32_t>> sorted;
+            sorted.reserve(vtables.size());
+            for (std::size_t i = 0; i < vtables.size(); ++i)
+            {
+                sorted.emplace_back(vtables[i].raw(), static_cast<std::uint32_t>(i));
+            }
+            // Sorting by (value, index) then keeping each value's first entry keeps its lowest caller index.
+            std::sort(sorted.begin(), sorted.end());
+            sorted.erase(std::unique(sorted.begin(), sorted.end(),
+                                     [](const auto &a, const auto &b) { return a.first == b.first; }),
+                         sorted.end());
+
+            VtableSet set;
+            for (const auto &[value, index] : sorted)
+            {
+                set.keys.push_back(value);
+                set.indices.push_back(index);
+            }
+            set.lo = set.keys.front();
+            set.hi = set.keys.back();
+            if (set.keys.size() > VTABLE_COMPARE_MAX)
+            {
+                const std::size_t capacity = std::bit_ceil(set.keys.size() * 2);
+                set.shift = static_cast<unsigned int>(64 - std::countr_zero(capacity));
+                set.table.assign(capacity, 0);
+                set.table_indices.assign(capacity, 0);
+                for (std::size_t i = 0; i < set.keys.size(); ++i)
+                {
+                    std::size_t slot = set.slot_of(set.keys[i]);
+                    while (set.table[slot] != 0)
+                    {
+                        slot = (slot + 1) & (capacity - 1);
+                    }
+                    set.table[slot] = set.keys[i];
+                    set.table_indices[slot] = set.indices[i];
+                }
+            }
+            return set;
+        }
+
+        // Tests the aligned qwords of [data + from, data + bytes) against the set. Also the tail of the AVX2 kernel.
+        DMK_NO_SANITIZE_ADDRESS std::size_t sweep_scalar(const std::byte *data, std::size_t from, std::size_t bytes,
+                                                         const VtableSet &set, Hit *out, std::size_t count) noexcept
+        {
+            for (std::size_t i = from; i + sizeof(std::uintptr_t) <= bytes; i += sizeof(std::uintptr_t))
+            {
+                std::uintptr_t value;
+                std::memcpy(&value, data + i, sizeof(value));
+                std::uint32_t index = 0;
+                if (value >= set.lo && value <= set.hi && set.find(value, index))
+                {
+                    out[count++] = Hit{static_cast<std::uint32_t>(i), index};
+                }
+            }
+            return count;
+        }
+
+#ifdef DMK_HAS_AVX2
+        // Four qwords per step. A small set ORs one equality compare per vtable; a large one keeps the lanes inside
+        // [lo, hi] (a signed compare is exact, since every vtable is a user-mode address below 2^47 and any qword
+        // with the top bit set reads as negative, below lo). Surviving lanes confirm through find.
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        std::size_t sweep_avx2(const std::byte *data, std::size_t bytes, const VtableSet &set, Hit *out) noexcept
+        {
+            const std::size_t compared = set.table.empty() ? set.keys.size() : 0;
+            __m256i wanted[VTABLE_COMPARE_MAX];
+            for (std::size_t t = 0; t < compared; ++t)
+            {
+                wanted[t] = _mm256_set1_epi64x(static_cast<long long>(set.keys[t]));
+            }
+            const __m256i below = _mm256_set1_epi64x(static_cast<long long>(set.lo - 1));
+            const __m256i above = _mm256_set1_epi64x(static_cast<long long>(set.hi));
+
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                const __m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                __m256i hit;
+                if (compared != 0)
+                {
+                    hit = _mm256_cmpeq_epi64(lanes, wanted[0]);
+                    for (std::size_t t = 1; t < compared; ++t)
+                    {
+                        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi64(lanes, wanted[t]));
+                    }
+                }
+                else
+                {
+                    hit = _mm256_andnot_si256(_mm256_cmpgt_epi64(lanes, above), _mm256_cmpgt_epi64(lanes, below));
+                }
+                auto mask = static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(hit)));
+                while (mask != 0)
+                {
+                    const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+                    mask &= mask - 1;
+                    std::uintptr_t value;
+                    std::memcpy(&value, data + i + lane * sizeof(value), sizeof(value));
+                    std::uint32_t index = 0;
+                    if (set.find(value, index))
+                    {
+                        out[count++] = Hit{static_cast<std::uint32_t>(i + lane * sizeof(value)), index};
+                    }
+                }
+            }
+            return sweep_scalar(data, i, bytes, set, out, count);
+        }
+#endif // DMK_HAS_AVX2
+
+        struct SweepContext
+        {
+            const std::byte *data;
+            std::size_t bytes;
+            const VtableSet *set;
+            bool avx2;
+            Hit *out;
+            std::size_t count;
+        };
+
+        // The body the sweep's fault guard wraps: reads the chunk in place, writes only the preallocated hits.
+        void sweep_chunk(void *opaque) noexcept
+        {
+            SweepContext &context = *static_cast<SweepContext *>(opaque);
+#ifdef DMK_HAS_AVX2
+            if (context.avx2)
+            {
+                context.count = sweep_avx2(context.data, context.bytes, *context.set, context.out);
+                return;
+            }
+#endif
+            context.count = sweep_scalar(context.data, 0, context.bytes, *context.set, context.out, 0);
+        }
+
+        // Runs fn(ctx) over [lo, hi) under the TOCTOU fault guard the page-gated scans use. Returns false when a fault
+        // was swallowed and fn did not complete.
+        bool run_guarded(std::uintptr_t lo, std::uintptr_t hi, void (*fn)(void *) noexcept, void *ctx) noexcept
+        {
+#ifdef _MSC_VER
+            (void)lo;
+            (void)hi;
+            __try
+            {
+                fn(ctx);
+                return true;
+            }
+            __except (detail::guarded_fault_filter(GetExceptionInformation()))
+            {
+                return false;
+            }
+#elif defined(_WIN64)
+            return detail::run_guarded_region(lo, hi, fn, ctx);
+#endif
+        }
+
+        // Cuts each writable window of the scope into 8-byte-aligned chunks, in ascending order.
+        [[nodiscard]] std::vector<Chunk> collect_chunks(const RegionSet &scope)
+        {
+            std::vector<Region> spans;
+            if (scope.empty())
+            {
+                spans.push_back(Region::whole_process());
+            }
+            else
+            {
+                spans.assign(scope.ranges().begin(), scope.ranges().end());
+            }
+
+            std::vector<Chunk> chunks;
+            for (const Region &span : spans)
+            {
+                for (const detail::ExecutableWindow &window :
+                     detail::collect_writable_windows(detail::module_span(span)))
+                {
+                    const std::uintptr_t end = window.base + window.span;
+                    std::uintptr_t lo = (window.base + 7) & ~std::uintptr_t{7};
+                    while (lo < end && end - lo >= sizeof(std::uintptr_t))
+                    {
+                        const std::size_t bytes = std::min<std::size_t>(end - lo, INSTANCE_CHUNK_BYTES);
+                        chunks.push_back(Chunk{lo, bytes});
+                        lo += bytes;
+                    }
+                }
+            }
+            return chunks;
+        }
+
+        // Sweeps one chunk into an exact-sized hit list. The scratch is allocated before the guard.
+        [[nodiscard]] ChunkHits sweep(const Chunk &chunk, const VtableSet &set, bool avx2)
+        {
+            auto scratch = std::make_unique_for_overwrite<Hit[]>(chunk.bytes / sizeof(std::uintptr_t));
+            SweepContext context{reinterpret_cast<const std::byte *>(chunk.base), chunk.bytes, &set, avx2,
+                                 scratch.get(), 0};
+            if (!run_guarded(chunk.base, chunk.base + chunk.bytes, sweep_chunk, &context))
+            {
+                return ChunkHits{{}, true};
+            }
+            return ChunkHits{std::vector<Hit>(scratch.get(), scratch.get() + context.count), false};
+        }
+    } // namespace
+
+    Result<rtti::InstanceScan> rtti::find_instances(std::span<const Address> vtables,
+                                                    const InstanceScanOptions &options) noexcept
+    {
+        if (vtables.empty())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "rtti::find_instances"});
+        }
+        if (vtables.size() > MAX_INSTANCE_VTABLES)
+        {
+            return std::unexpected(
+                Error{ErrorCode::SizeTooLarge, "rtti::find_instances", vtables.size(), MAX_INSTANCE_VTABLES});
+        }
+        for (std::size_t i = 0; i < vtables.size(); ++i)
+        {
+            if (!vtables[i])
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "rtti::find_instances", i});
+            }
+        }
+        try
+        {
+            const VtableSet set = make_set(vtables);
+            const std::vector<Chunk> chunks = collect_chunks(options.scope);
+            const bool avx2 = scan::active_simd_level() >= scan::SimdLevel::Avx2;
+            std::vector<ChunkHits> hits = detail::run_fork_join<Chunk, ChunkHits>(
+                chunks, detail::in_fork_join_worker() ? 1 : options.max_workers,
+                [&](const Chunk &chunk) { return sweep(chunk, set, avx2); },
+                [](const Chunk &) noexcept { return ChunkHits{{}, true}; });
+
+            const auto caller_lo = reinterpret_cast<std::uintptr_t>(vtables.data());
+            const std::uintptr_t caller_hi = caller_lo + vtables.size_bytes();
+            InstanceScan found;
+            for (std::size_t c = 0; c < chunks.size(); ++c)
+            {
+                found.incomplete = found.incomplete || hits[c].failed;
+                for (const Hit &hit : hits[c].hits)
+                {
+                    const std::uintptr_t object = chunks[c].base + hit.offset;
+                    if ((object >= caller_lo && object < caller_hi) || set.owns(object))
+                    {
+                        continue;
+                    }
+                    found.matches.push_back(InstanceMatch{Address{object}, hit.vtable});
+                }
+            }
+            return found;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "rtti::find_instances"});
+        }
+    }
+} // namespace DetourModKit
@@ -0,0 +1,280 @@
+/**
+ * @file scan_anchor_tuning.cpp
+ * @brief Module-tuned anchor selection: the one-time code-section byte histogram behind scan::tune_anchors, and the
+ *        per-process table sample_haystack consults before it samples.
+ * @details The default anchor override ranks a pattern's bytes against a 256 KiB strided sample of each scan's scope.
+ *          A profiled module replaces that sample with a count of every byte in its executable sections, which is both
+ *          exact for code scans and free at scan time. The table holds a handful of small entries, searched linearly
+ *          under a shared lock; an atomic flag keeps the lock off the scan path entirely until the first profile.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_shared.hpp"
+#include "internal/srw_shared_mutex.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <shared_mutex>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // The PE format caps a loadable image at 96 sections; a larger count is a corrupt or hostile header.
+        constexpr std::uint16_t MAX_IMAGE_SECTIONS = 96;
+
+        // Executable sections remembered per profile for the "scope lies inside one code section" test. Real images
+        // have one or two; a profile with more still counts every section, it only stops matching Readable scopes
+        // that start in the sections past this cap.
+        constexpr std::size_t TUNED_MAX_CODE_SECTIONS = 16;
+
+        // Bytes copied per guarded read while counting. A chunk that faults is retried page by page so one guard page
+        // does not drop the rest of the chunk from the profile.
+        constexpr std::size_t TUNE_CHUNK_BYTES = std::size_t{64} * 1024;
+
+        struct TunedModule
+        {
+            detail::ModuleSpan module{};
+            std::array<detail::ModuleSpan, TUNED_MAX_CODE_SECTIONS> code{};
+            std::size_t code_count = 0;
+            detail::HaystackHistogram histogram{};
+        };
+
+        struct TunedModuleTable
+        {
+            detail::SrwSharedMutex mutex;
+            std::vector<TunedModule> modules;
+            /// Set once the first profile is published; lets every untuned scan skip the lock.
+            std::atomic<bool> any{false};
+        };
+
+        [[nodiscard]] TunedModuleTable &tuned_module_table() noexcept
+        {
+            static TunedModuleTable table;
+            return table;
+        }
+
+        [[nodiscard]] bool span_within(const detail::ModuleSpan &outer, std::uintptr_t begin,
+                                       std::uintptr_t end) noexcept
+        {
+            return begin >= outer.base && end <= outer.end && begin < end;
+        }
+
+        /**
+         * @brief Adds every byte of @p bytes to @p banks.
+         * @details Four interleaved banks, one per byte lane, so consecutive equal bytes (long 0xCC / 0x00 padding runs
+         *          are the norm in code) increment different counters instead of serializing on one store-to-load
+         *          chain. A histogram scatter does not map onto SIMD lanes; the banked loop is the vector-free form of
+         *          the same parallelism and runs at several bytes per cycle.
+         */
+        void count_bytes(const std::uint8_t *bytes, std::size_t size,
+                         std::array<std::array<std::uint32_t, 256>, 4> &banks) noexcept
+        {
+            std::size_t i = 0;
+            for (; i + 8 <= size; i += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes + i, sizeof(word));
+                ++banks[0][static_cast<std::uint8_t>(word)];
+                ++banks[1][static_cast<std::uint8_t>(word >> 8)];
+                ++banks[2][static_cast<std::uint8_t>(word >> 16)];
+                ++banks[3][static_cast<std::uint8_t>(word >> 24)];
+                ++banks[0][static_cast<std::uint8_t>(word >> 32)];
+                ++banks[1][static_cast<std::uint8_t>(word >> 40)];
+                ++banks[2][static_cast<std::uint8_t>(word >> 48)];
+                ++banks[3][static_cast<std::uint8_t>(word >> 56)];
+            }
+            for (; i < size; ++i)
+            {
+                ++banks[0][bytes[i]];
+            }
+        }
+
+        /// Counts the readable bytes of [begin, end) into @p banks; returns how many were counted.
+        [[nodiscard]] std::size_t count_range(std::uintptr_t begin, std::uintptr_t end,
+                                              std::vector<std::uint8_t> &buffer,
+                                              std::array<std::array<std::uint32_t, 256>, 4> &banks) noexcept
+        {
+            std::size_t counted = 0;
+            for (std::uintptr_t cursor = begin; cursor < end;)
+            {
+                const std::size_t want =
+                    static_cast<std::size_t>(std::min<std::uintptr_t>(buffer.size(), end - cursor));
+                if (detail::guarded_read_bytes(cursor, buffer.data(), want))
+                {
+                    count_bytes(buffer.data(), want, banks);
+                    counted += want;
+                }
+                else
+                {
+                    for (std::size_t offset = 0; offset < want; offset += detail::SAMPLE_PAGE)
+                    {
+                        const std::size_t page = std::min(detail::SAMPLE_PAGE, want - offset);
+                        if (detail::guarded_read_bytes(cursor + offset, buffer.data(), page))
+                        {
+                            count_bytes(buffer.data(), page, banks);
+                            counted += page;
+                        }
+                    }
+                }
+                cursor += want;
+            }
+            return counted;
+        }
+
+        /// The module's executable sections, in-image and in-bounds, with the same header discipline as the RTTI walk.
+        [[nodiscard]] std::optional<std::vector<detail::ModuleSpan>> code_sections(const detail::ModuleSpan &span)
+        {
+            const std::size_t image_bytes = static_cast<std::size_t>(span.end - span.base);
+            const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(span.base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0 ||
+                image_bytes < sizeof(IMAGE_NT_HEADERS64) ||
+                static_cast<std::size_t>(dos->e_lfanew) > image_bytes - sizeof(IMAGE_NT_HEADERS64))
+            {
+                return std::nullopt;
+            }
+            const std::uintptr_t nt_addr = span.base + static_cast<std::uintptr_t>(dos->e_lfanew);
+            const std::optional<IMAGE_NT_HEADERS64> nt = detail::guarded_read<IMAGE_NT_HEADERS64>(nt_addr);
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+                nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC ||
+                nt->FileHeader.NumberOfSections > MAX_IMAGE_SECTIONS)
+            {
+                return std::nullopt;
+            }
+
+            // The section table follows the optional header, whose size the file header declares (IMAGE_FIRST_SECTION).
+            const std::uintptr_t table = nt_addr + offsetof(IMAGE_NT_HEADERS64, OptionalHeader) +
+                                         nt->FileHeader.SizeOfOptionalHeader;
+            std::vector<detail::ModuleSpan> sections;
+            for (std::uint16_t i = 0; i < nt->FileHeader.NumberOfSections; ++i)
+            {
+                const std::uintptr_t header = table + static_cast<std::uintptr_t>(i) * sizeof(IMAGE_SECTION_HEADER);
+                if (!span_within(span, header, header + sizeof(IMAGE_SECTION_HEADER)))
+                {
+                    break;
+                }
+                const std::optional<IMAGE_SECTION_HEADER> section = detail::guarded_read<IMAGE_SECTION_HEADER>(header);
+                if (!section)
+                {
+                    break;
+                }
+                if ((section->Characteristics & IMAGE_SCN_MEM_EXECUTE) == 0)
+                {
+                    continue;
+                }
+                // The in-memory extent (VirtualAddress + VirtualSize), clamped to the image.
+                const std::uintptr_t begin = span.base + section->VirtualAddress;
+                const std::uintptr_t end = std::min<std::uintptr_t>(begin + section->Misc.VirtualSize, span.end);
+                if (span_within(span, begin, end))
+                {
+                    sections.push_back(detail::ModuleSpan{begin, end});
+                }
+            }
+            return sections;
+        }
+    } // anonymous namespace
+
+    bool detail::tuned_histogram(Region scope, scan::Pages pages, HaystackHistogram &out) noexcept
+    {
+        TunedModuleTable &table = tuned_module_table();
+        if (!table.any.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        const std::uintptr_t begin = scope.base.raw();
+        const std::uintptr_t end = scope.end().raw();
+        std::shared_lock<SrwSharedMutex> lock(table.mutex);
+        for (const TunedModule &tuned : table.modules)
+        {
+            if (!span_within(tuned.module, begin, end))
+            {
+                continue;
+            }
+            bool applies = pages == scan::Pages::Executable;
+            for (std::size_t i = 0; !applies && i < tuned.code_count; ++i)
+            {
+                applies = span_within(tuned.code[i], begin, end);
+            }
+            if (applies)
+            {
+                out = tuned.histogram;
+            }
+            return applies;
+        }
+        return false;
+    }
+
+    Result<std::size_t> scan::tune_anchors(Region module) noexcept
+    {
+        const detail::ModuleSpan span = detail::module_span(module);
+        if (!span.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::tune_anchors"});
+        }
+
+        try
+        {
+            const std::optional<std::vector<detail::ModuleSpan>> sections = code_sections(span);
+            if (!sections || sections->empty())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::tune_anchors"});
+            }
+
+            std::vector<std::uint8_t> buffer(TUNE_CHUNK_BYTES);
+            std::array<std::array<std::uint32_t, 256>, 4> banks{};
+            TunedModule tuned;
+            tuned.module = span;
+            for (const detail::ModuleSpan &section : *sections)
+            {
+                tuned.histogram.sampled += count_range(section.base, section.end, buffer, banks);
+                if (tuned.code_count < TUNED_MAX_CODE_SECTIONS)
+                {
+                    tuned.code[tuned.code_count] = section;
+                    ++tuned.code_count;
+                }
+            }
+            if (tuned.histogram.sampled == 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::tune_anchors"});
+            }
+            for (std::size_t value = 0; value < 256; ++value)
+            {
+                tuned.histogram.counts[value] = banks[0][value] + banks[1][value] + banks[2][value] + banks[3][value];
+            }
+
+            TunedModuleTable &table = tuned_module_table();
+            {
+                std::unique_lock<detail::SrwSharedMutex> lock(table.mutex);
+                const auto existing = std::find_if(table.modules.begin(), table.modules.end(),
+                                                   [&](const TunedModule &entry)
+                                                   { return entry.module.base == span.base; });
+                if (existing != table.modules.end())
+                {
+                    *existing = tuned;
+                }
+                else
+                {
+                    table.modules.push_back(tuned);
+                }
+            }
+            table.any.store(true, std::memory_order_release);
+            return tuned.histogram.sampled;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::tune_anchors"});
+        }
+    }
+} // namespace DetourModKit
@@ -0,0 +1,292 @@
+/**
+ * @file scan_approximate.cpp
+ * @brief scan::find_approximate: every site within k byte substitutions of a pattern, in one parallel sweep.
+ * @details The matcher is the Wu-Manber extension of shift-and to Hamming distance. Bit i of state set R_j is live when
+ *          the last i + 1 bytes match the pattern's first i + 1 positions with at most j substitutions. Each byte c
+ *          advances every set at once:
+ *
+ *              R_0' = ((R_0 << 1) | 1) & accepts[c]
+ *              R_j' = (((R_j << 1) | 1) & accepts[c]) | ((R_{j-1} << 1) | 1)
+ *
+ *          where accepts[c] holds the positions c satisfies under their mask. The second term spends one substitution
+ *          on the current byte. A site is reported when bit length - 1 of R_k is live; its disagreeing positions are
+ *          then read back by a direct compare. A pattern holds at most MAX_PATTERN_BYTES bytes, so each set is one
+ *          or two 64-bit words and the update unrolls to straight-line code.
+ *
+ *          The scope's readable windows are merged where they touch and cut into chunks. A chunk owns the sites that
+ *          start inside it and reads length - 1 bytes past its end, stopping at the end of its readable run, so a
+ *          site that straddles two chunks is found exactly once. Each chunk writes into storage sized before its
+ *          fault guard is entered, and the chunks are gathered in ascending order.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include "DetourModKit/defines.hpp"
+
+#include "internal/memory_fault.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+
+#include "fork_join.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Bytes of site starts one chunk owns.
+        constexpr std::size_t APPROXIMATE_CHUNK_BYTES = std::size_t{1} << 20;
+
+        // Two words hold a state bit for every position of the longest Pattern.
+        constexpr std::size_t APPROXIMATE_WORDS = 2;
+        static_assert(detail::MAX_PATTERN_BYTES <= APPROXIMATE_WORDS * 64,
+                      "the approximate matcher's state sets must hold every pattern position");
+
+        using StateWords = std::array<std::uint64_t, APPROXIMATE_WORDS>;
+
+        struct ApproximatePlan
+        {
+            detail::PatternBuffer buffer{};
+            std::size_t max_mismatches = 0;
+            // Sites a chunk records before it stops: one more than the output holds, so an overflow is visible.
+            std::size_t chunk_limit = 0;
+            // accepts[v] bit i: byte value v satisfies pattern position i.
+            std::array<StateWords, 256> accepts{};
+        };
+
+        struct ApproximateChunk
+        {
+            // Site starts [base, base + bytes) belong to this chunk.
+            std::uintptr_t base = 0;
+            std::size_t bytes = 0;
+            // The end of the contiguous readable run the chunk sits in; no read passes it.
+            std::uintptr_t run_end = 0;
+        };
+
+        struct ChunkSites
+        {
+            std::vector<scan::ApproximateMatch> sites;
+            std::size_t count = 0;
+            bool failed = false;
+        };
+
+        struct SweepContext
+        {
+            const ApproximatePlan *plan;
+            ApproximateChunk chunk;
+            ChunkSites *out;
+            // Sites this chunk may record: the plan's limit, or fewer for a chunk shorter than that.
+            std::size_t limit;
+        };
+
+        // Reads back which positions @p site disagrees on. The automaton accepted it, so there are at most
+        // max_mismatches of them; the bound is kept regardless so the fixed array can never overflow.
+        [[nodiscard]] scan::ApproximateMatch describe_site(const detail::PatternBuffer &buffer,
+                                                           const std::byte *site) noexcept
+        {
+            scan::ApproximateMatch match{};
+            match.site = Address{reinterpret_cast<std::uintptr_t>(site)};
+            for (std::size_t i = 0; i < buffer.length && match.mismatches < scan::MAX_APPROXIMATE_MISMATCHES; ++i)
+            {
+                if (!detail::byte_admitted(buffer, i, site[i]))
+                {
+                    match.positions[match.mismatches++] = static_cast<std::uint8_t>(i);
+                }
+            }
+            return match;
+        }
+
+        // The body the fault guard wraps. Words is 1 for a pattern of up to 64 bytes, else 2. It writes only the
+        // presized site storage and the count, so a fault leaves the sites found before it intact.
+        template <std::size_t Words> DMK_NO_SANITIZE_ADDRESS void sweep_words(const SweepContext &context) noexcept
+        {
+            const ApproximatePlan &plan = *context.plan;
+            const ApproximateChunk &chunk = context.chunk;
+            ChunkSites &out = *context.out;
+            const std::size_t length = plan.buffer.length;
+            const std::size_t levels = plan.max_mismatches + 1;
+            const std::size_t final_word = (length - 1) / 64;
+            const std::uint64_t final_bit = std::uint64_t{1} << ((length - 1) % 64);
+
+            std::array<std::array<std::uint64_t, Words>, scan::MAX_APPROXIMATE_MISMATCHES + 1> state{};
+            const std::uintptr_t read_end = std::min(chunk.run_end, chunk.base + chunk.bytes + length - 1);
+            for (std::uintptr_t p = chunk.base; p < read_end; ++p)
+            {
+                const StateWords &accepts = plan.accepts[*reinterpret_cast<const std::uint8_t *>(p)];
+                // Descending, so R_j reads R_{j-1} before this byte updates it.
+                for (std::size_t j = levels; j-- > 0;)
+                {
+                    std::uint64_t carry = 1;
+                    std::uint64_t spill_carry = 1;
+                    for (std::size_t w = 0; w < Words; ++w)
+                    {
+                        const std::uint64_t word = state[j][w];
+                        std::uint64_t next = ((word << 1) | carry) & accepts[w];
+                        carry = word >> 63;
+                        if (j != 0)
+                        {
+                            const std::uint64_t below = state[j - 1][w];
+                            next |= (below << 1) | spill_carry;
+                            spill_carry = below >> 63;
+                        }
+                        state[j][w] = next;
+                    }
+                }
+                if ((state[levels - 1][final_word] & final_bit) == 0)
+                {
+                    continue;
+                }
+                if (out.count == context.limit)
+                {
+                    // Enough sites to fill the output and prove it overflowed; the rest of the chunk cannot matter.
+                    return;
+                }
+                const auto *site = reinterpret_cast<const std::byte *>(p - length + 1);
+                out.sites[out.count++] = describe_site(plan.buffer, site);
+            }
+        }
+
+        void sweep_chunk(void *opaque) noexcept
+        {
+            const SweepContext &context = *static_cast<const SweepContext *>(opaque);
+            if (context.plan->buffer.length <= 64)
+            {
+                sweep_words<1>(context);
+            }
+            else
+            {
+                sweep_words<2>(context);
+            }
+        }
+
+        // Runs fn(ctx) over [lo, hi) under the TOCTOU fault guard the page-gated scans use. Returns false when a
+        // fault was swallowed and fn did not complete.
+        bool run_guarded(std::uintptr_t lo, std::uintptr_t hi, void (*fn)(void *) noexcept, void *ctx) noexcept
+        {
+#ifdef _MSC_VER
+            (void)lo;
+            (void)hi;
+            __try
+            {
+                fn(ctx);
+                return true;
+            }
+            __except (detail::guarded_fault_filter(GetExceptionInformation()))
+            {
+                return false;
+            }
+#elif defined(_WIN64)
+            return detail::run_guarded_region(lo, hi, fn, ctx);
+#endif
+        }
+
+        [[nodiscard]] ChunkSites sweep_one(const ApproximateChunk &chunk, const ApproximatePlan &plan)
+        {
+            ChunkSites result;
+            result.sites.resize(std::min(plan.chunk_limit, chunk.bytes));
+            SweepContext context{&plan, chunk, &result, result.sites.size()};
+            result.failed = !run_guarded(chunk.base, chunk.run_end, sweep_chunk, &context);
+            return result;
+        }
+
+        // The scope's readable windows, merged where they touch, cut into chunks in ascending order.
+        [[nodiscard]] std::vector<ApproximateChunk> collect_chunks(detail::ModuleSpan range, scan::Pages pages)
+        {
+            std::vector<detail::ModuleSpan> runs;
+            for (const detail::ExecutableWindow &window : detail::collect_page_windows(range, pages))
+            {
+                const std::uintptr_t end = window.base + window.span;
+                if (!runs.empty() && runs.back().end == window.base)
+                {
+                    runs.back().end = end;
+                    continue;
+                }
+                runs.push_back(detail::ModuleSpan{window.base, end});
+            }
+
+            std::vector<ApproximateChunk> chunks;
+            for (const detail::ModuleSpan &run : runs)
+            {
+                for (std::uintptr_t lo = run.base; lo < run.end; lo += APPROXIMATE_CHUNK_BYTES)
+                {
+                    const std::size_t bytes = std::min<std::size_t>(run.end - lo, APPROXIMATE_CHUNK_BYTES);
+                    chunks.push_back(ApproximateChunk{lo, bytes, run.end});
+                }
+            }
+            return chunks;
+        }
+    } // namespace
+
+    Result<scan::MatchSummary> scan::find_approximate(const Pattern &pattern, Region scope, std::size_t max_mismatches,
+                                                      std::span<ApproximateMatch> out, Pages pages,
+                                                      std::size_t max_workers) noexcept
+    {
+        const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+        const auto constrained = static_cast<std::size_t>(
+            std::count_if(buffer.mask.begin(), buffer.mask.begin() + buffer.length,
+                          [](std::byte mask) { return mask != std::byte{0}; }));
+        if ((pages != Pages::Readable && pages != Pages::Executable) || buffer.jump_count != 0 ||
+            max_mismatches > MAX_APPROXIMATE_MISMATCHES || max_mismatches >= constrained)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::find_approximate", max_mismatches});
+        }
+        const detail::ModuleSpan range = detail::module_span(scope);
+        if (!range.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::find_approximate"});
+        }
+
+        try
+        {
+            ApproximatePlan plan;
+            plan.buffer = buffer;
+            plan.max_mismatches = max_mismatches;
+            plan.chunk_limit = out.size() + 1;
+            for (std::size_t i = 0; i < buffer.length; ++i)
+            {
+                for (unsigned value = 0; value < 256; ++value)
+                {
+                    if (detail::byte_admitted(buffer, i, static_cast<std::byte>(value)))
+                    {
+                        plan.accepts[value][i / 64] |= std::uint64_t{1} << (i % 64);
+                    }
+                }
+            }
+
+            const std::vector<ApproximateChunk> chunks = collect_chunks(range, pages);
+            const std::size_t workers = detail::in_fork_join_worker() ? 1 : max_workers;
+            const std::vector<ChunkSites> swept = detail::run_fork_join<ApproximateChunk, ChunkSites>(
+                chunks, workers, [&plan](const ApproximateChunk &chunk) { return sweep_one(chunk, plan); },
+                [](const ApproximateChunk &) noexcept { return ChunkSites{{}, 0, true}; });
+
+            MatchSummary summary{};
+            for (const ChunkSites &chunk : swept)
+            {
+                summary.faulted = summary.faulted || chunk.failed;
+                for (std::size_t i = 0; i < chunk.count && !summary.stopped; ++i)
+                {
+                    if (summary.matches == out.size())
+                    {
+                        summary.stopped = true;
+                        break;
+                    }
+                    out[summary.matches++] = chunk.sites[i];
+                }
+            }
+            return summary;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::find_approximate"});
+        }
+    }
+} // namespace DetourModKit
@@ -0,0 +1,271 @@
+/**
+ * @file scan_async.cpp
+ * @brief Background resolves: the shared result slot, the worker bodies, and the two futures.
+ * @details Each call moves its requests into a reference-counted state block and starts one StoppableWorker whose
+ *          body holds the only other reference. The body runs the blocking resolver, publishes the result under the
+ *          state's mutex, wakes every waiter, and then runs the completion callback. The future's Impl destroys its
+ *          worker before dropping its own reference, so a future that goes away mid-resolve joins instead of leaving
+ *          the body with a dangling state.
+ */
+
+#include "DetourModKit/scan_async.hpp"
+
+#include "DetourModKit/detail/worker.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <stop_token>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        /**
+         * @brief One background resolve's owned input, its result slot, and its completion callback.
+         * @details The slot is written exactly once, by publish(), and never changes afterwards, so a reader that has
+         *          observed `ready` (or waited on the condition) may read it without the lock.
+         */
+        template <typename Value, typename Input, typename Callback>
+        struct AsyncState
+        {
+            AsyncState(Input in, Callback callback) noexcept
+                : input(std::move(in)), on_complete(std::move(callback))
+            {
+            }
+
+            std::mutex mutex;
+            std::condition_variable condition;
+            std::atomic<bool> ready{false};
+            std::optional<Value> value;
+            Input input;
+            Callback on_complete;
+
+            void publish(Value result) noexcept
+            {
+                {
+                    std::lock_guard lock(mutex);
+                    value.emplace(std::move(result));
+                    ready.store(true, std::memory_order_release);
+                }
+                condition.notify_all();
+                if (on_complete)
+                {
+                    try
+                    {
+                        on_complete(*value);
+                    }
+                    catch (...)
+                    {
+                        // A throwing callback must not escape the worker body; the result is already published.
+                    }
+                }
+            }
+
+            void wait() noexcept
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [this] { return value.has_value(); });
+            }
+
+            [[nodiscard]] bool wait_for(std::chrono::milliseconds timeout) noexcept
+            {
+                std::unique_lock lock(mutex);
+                return condition.wait_for(lock, timeout, [this] { return value.has_value(); });
+            }
+        };
+
+        using SingleState = AsyncState<Result<scan::Hit>, scan::OwnedScanRequest, scan::ResolveCallback>;
+        using BatchState =
+            AsyncState<scan::BatchResult, std::vector<scan::OwnedScanRequest>, scan::BatchResolveCallback>;
+
+        /// Starts @p body on a new worker; maps the constructor's throw onto the Error the factories return.
+        template <typename Body>
+        [[nodiscard]] Result<std::unique_ptr<StoppableWorker>> start_worker(const char *name, const char *where,
+                                                                           Body body) noexcept
+        {
+            try
+            {
+                return std::make_unique<StoppableWorker>(name, std::move(body));
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, where});
+            }
+            catch (const std::system_error &failure)
+            {
+                return std::unexpected(
+                    Error{ErrorCode::SystemCallFailed, where, static_cast<std::uintptr_t>(failure.code().value())});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::SystemCallFailed, where});
+            }
+        }
+
+        // A future with no state (moved from) reports this from get().
+        const Result<scan::Hit> moved_from_single{std::unexpected(Error{ErrorCode::InvalidArg, "scan::ResolveFuture"})};
+        const scan::BatchResult moved_from_batch{
+            std::unexpected(Error{ErrorCode::InvalidArg, "scan::BatchResolveFuture"})};
+    } // anonymous namespace
+
+    // Member order matters: the worker is destroyed first, so it joins while the state is still referenced here.
+    struct scan::ResolveFuture::Impl
+    {
+        std::shared_ptr<SingleState> state;
+        std::unique_ptr<StoppableWorker> worker;
+    };
+
+    struct scan::BatchResolveFuture::Impl
+    {
+        std::shared_ptr<BatchState> state;
+        std::unique_ptr<StoppableWorker> worker;
+    };
+
+    scan::ResolveFuture::ResolveFuture(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    scan::ResolveFuture::ResolveFuture(ResolveFuture &&) noexcept = default;
+    scan::ResolveFuture &scan::ResolveFuture::operator=(ResolveFuture &&) noexcept = default;
+    scan::ResolveFuture::~ResolveFuture() noexcept = default;
+
+    bool scan::ResolveFuture::ready() const noexcept
+    {
+        return !m_impl || m_impl->state->ready.load(std::memory_order_acquire);
+    }
+
+    void scan::ResolveFuture::wait() const noexcept
+    {
+        if (m_impl)
+            m_impl->state->wait();
+    }
+
+    bool scan::ResolveFuture::wait_for(std::chrono::milliseconds timeout) const noexcept
+    {
+        return !m_impl || m_impl->state->wait_for(timeout);
+    }
+
+    const Result<scan::Hit> &scan::ResolveFuture::get() const noexcept
+    {
+        if (!m_impl)
+            return moved_from_single;
+        m_impl->state->wait();
+        return *m_impl->state->value;
+    }
+
+    scan::BatchResolveFuture::BatchResolveFuture(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    scan::BatchResolveFuture::BatchResolveFuture(BatchResolveFuture &&) noexcept = default;
+    scan::BatchResolveFuture &scan::BatchResolveFuture::operator=(BatchResolveFuture &&) noexcept = default;
+    scan::BatchResolveFuture::~BatchResolveFuture() noexcept = default;
+
+    bool scan::BatchResolveFuture::ready() const noexcept
+    {
+        return !m_impl || m_impl->state->ready.load(std::memory_order_acquire);
+    }
+
+    void scan::BatchResolveFuture::wait() const noexcept
+    {
+        if (m_impl)
+            m_impl->state->wait();
+    }
+
+    bool scan::BatchResolveFuture::wait_for(std::chrono::milliseconds timeout) const noexcept
+    {
+        return !m_impl || m_impl->state->wait_for(timeout);
+    }
+
+    const scan::BatchResult &scan::BatchResolveFuture::get() const noexcept
+    {
+        if (!m_impl)
+            return moved_from_batch;
+        m_impl->state->wait();
+        return *m_impl->state->value;
+    }
+
+    Result<scan::ResolveFuture> scan::resolve_async(OwnedScanRequest request, ResolveCallback on_complete) noexcept
+    {
+        std::shared_ptr<SingleState> state;
+        std::unique_ptr<ResolveFuture::Impl> impl;
+        try
+        {
+            state = std::make_shared<SingleState>(std::move(request), std::move(on_complete));
+            impl = std::make_unique<ResolveFuture::Impl>();
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_async"});
+        }
+
+        // StoppableWorker takes a copyable std::function, so the body captures only the shared state. A resolve is
+        // not interruptible, so the stop token is not polled; the worker's destructor waits for the resolve to end.
+        auto worker = start_worker("DMK scan::resolve_async", "scan::resolve_async", [state](std::stop_token) {
+            Result<Hit> result = std::unexpected(Error{ErrorCode::Unknown, "scan::resolve_async"});
+            try
+            {
+                result = resolve(state->input.view());
+            }
+            catch (const std::bad_alloc &)
+            {
+                result = std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_async"});
+            }
+            catch (...)
+            {
+                // Leaves the seeded Unknown.
+            }
+            state->publish(std::move(result));
+        });
+        if (!worker)
+            return std::unexpected(worker.error());
+
+        impl->state = std::move(state);
+        impl->worker = std::move(*worker);
+        return ResolveFuture{std::move(impl)};
+    }
+
+    Result<scan::BatchResolveFuture> scan::resolve_batch_async(std::vector<OwnedScanRequest> requests,
+                                                               std::size_t max_workers,
+                                                               BatchResolveCallback on_complete) noexcept
+    {
+        std::shared_ptr<BatchState> state;
+        std::unique_ptr<BatchResolveFuture::Impl> impl;
+        try
+        {
+            state = std::make_shared<BatchState>(std::move(requests), std::move(on_complete));
+            impl = std::make_unique<BatchResolveFuture::Impl>();
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_batch_async"});
+        }
+
+        const auto body = [state, max_workers](std::stop_token) {
+            BatchResult result = std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_batch_async"});
+            try
+            {
+                std::vector<ScanRequest> views;
+                views.reserve(state->input.size());
+                for (const OwnedScanRequest &owned : state->input)
+                    views.push_back(owned.view());
+                result = resolve_batch(views, max_workers);
+            }
+            catch (...)
+            {
+                // Only the view vector can throw (bad_alloc); that is a whole-batch OutOfMemory, as seeded.
+            }
+            state->publish(std::move(result));
+        };
+        auto worker = start_worker("DMK scan::resolve_batch_async", "scan::resolve_batch_async", body);
+        if (!worker)
+            return std::unexpected(worker.error());
+
+        impl->state = std::move(state);
+        impl->worker = std::move(*worker);
+        return BatchResolveFuture{std::move(impl)};
+    }
+} // namespace DetourModKit
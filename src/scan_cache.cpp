@@ -0,0 +1,807 @@
+/**
+ * @file scan_cache.cpp
+ * @brief The persistent resolution cache: module identity, the keyed entry map and tier history, their text form, and
+ *        the resolver seam.
+ * @details The cache remembers where a request's winning byte-tier candidate matched, as offsets from the module base,
+ *          plus the identity of the build it matched in. Nothing here decides whether a remembered site is still the
+ *          answer on its own: the probe re-checks identity and live bytes, and the resolver re-derives and gates the
+ *          address exactly as it would a fresh match. The text form mirrors the drift manifest (versioned header,
+ *          tab-separated fields) so a cache file is diffable and a torn one fails closed to an empty cache.
+ */
+
+#include "DetourModKit/scan_cache.hpp"
+
+#include "internal/fnv1a.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_cache.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_shared_table.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        constexpr std::string_view CACHE_HEADER = "# DetourModKit resolution cache v3";
+        // v2 predates the SIMD calibration line and v1 tier history; their other lines are unchanged, so an older
+        // file still warms a start.
+        constexpr std::string_view CACHE_HEADER_V2 = "# DetourModKit resolution cache v2";
+        constexpr std::string_view CACHE_HEADER_V1 = "# DetourModKit resolution cache v1";
+        constexpr char FIELD_SEP = '\t';
+        constexpr std::size_t FIELD_COUNT = 7;
+        // A tier-history line: the tag, then key, tier index, hits, misses, ambiguous, micros -- the same field count
+        // as an entry line, told apart by the tag, which is not a hex number.
+        constexpr std::string_view TIER_TAG = "tier";
+        // The calibration line: the tag, then host key, level, workers, speedup permille, and the Sse2, Avx2 and
+        // Avx512 sweep times. The one line with an extra field.
+        constexpr std::string_view CALIBRATION_TAG = "simd";
+        constexpr std::size_t CALIBRATION_FIELD_COUNT = 8;
+
+        // The PE format caps a loadable image at 96 sections; a larger count is a corrupt or hostile header, not a
+        // module worth identifying.
+        constexpr std::uint16_t MAX_IMAGE_SECTIONS = 96;
+
+        struct CacheEntry
+        {
+            scan::ModuleIdentity identity{};
+            std::uint32_t candidate_index = 0;
+            std::uint64_t match_rva = 0;
+            std::uint64_t resolved_rva = 0;
+        };
+
+        [[nodiscard]] std::unexpected<Error> cache_error(ErrorCode code) noexcept
+        {
+            return std::unexpected(Error{code, "scan::ResolutionCache"});
+        }
+
+        // The request's content key: the ladder (through the same candidate hash as the anchor drift fingerprint)
+        // plus every policy field that can change which candidate wins or whether its address is accepted. The label
+        // and scope are deliberately excluded -- the label is a diagnostic, and the scope contributes through the
+        // module identity stored with the entry.
+        [[nodiscard]] std::uint64_t request_key(const scan::ScanRequest &request) noexcept
+        {
+            std::uint64_t hash = detail::fnv1a_cascade(detail::FNV1A64_OFFSET, request.ladder);
+            hash = detail::fnv1a_byte(hash, request.require_unique ? 1U : 0U);
+            hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(request.order));
+            hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(request.pages));
+            return detail::fnv1a_byte(hash, request.require_executable_result ? 1U : 0U);
+        }
+
+        // The compiled byte pattern of a cacheable candidate: a byte tier whose pattern has no bounded jumps, so the
+        // match start is exactly the offset-applied point minus Pattern::offset() and re-verifying it is one
+        // fixed-width compare.
+        [[nodiscard]] const scan::Pattern *cacheable_pattern(const scan::Candidate &candidate) noexcept
+        {
+            const scan::Pattern *pattern = nullptr;
+            if (const scan::DirectPattern *direct = candidate.as_direct())
+            {
+                pattern = &direct->pattern;
+            }
+            else if (const scan::RipRelativePattern *rip = candidate.as_rip_relative())
+            {
+                pattern = &rip->pattern;
+            }
+            if (pattern == nullptr || pattern->has_jumps() || pattern->size() == 0)
+            {
+                return nullptr;
+            }
+            return pattern;
+        }
+
+        // Appends one field in lowercase hex; to_chars cannot fail into a 16-digit buffer for a 64-bit value.
+        void append_hex(std::string &out, std::uint64_t value)
+        {
+            std::array<char, 16> digits{};
+            const auto result = std::to_chars(digits.data(), digits.data() + digits.size(), value, 16);
+            out.append(digits.data(), result.ptr);
+        }
+
+        template <typename T> [[nodiscard]] bool parse_hex(std::string_view field, T &out) noexcept
+        {
+            if (field.empty())
+            {
+                return false;
+            }
+            const char *const begin = field.data();
+            const char *const end = field.data() + field.size();
+            const auto result = std::from_chars(begin, end, out, 16);
+            return result.ec == std::errc{} && result.ptr == end;
+        }
+    } // anonymous namespace
+
+    struct scan::ResolutionCache::Impl
+    {
+        mutable std::mutex mutex;
+        // Ordered so serialize() writes a stable, diffable file whatever order the requests resolved in.
+        std::map<std::uint64_t, CacheEntry> entries;
+        ResolutionCacheStats stats{};
+        // Per-tier outcomes of Adaptive requests, by the same key; each vector is as long as the ladder (capped).
+        std::map<std::uint64_t, std::vector<scan::TierStats>> history;
+        // The host's recorded scan::calibrate_simd result, if any.
+        std::optional<scan::SimdCalibration> calibration;
+        // Set once by share_in_process(); the table itself is lock-free, the pointer is read under the mutex.
+        std::unique_ptr<detail::SharedResolutionTable> shared;
+    };
+
+    Result<scan::ModuleIdentity> scan::module_identity(Region module) noexcept
+    {
+        const detail::ModuleSpan span = detail::module_span(module);
+        if (!span.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::module_identity"});
+        }
+
+        // The same DOS -> NT discipline as the export walk: every header is bound-checked inside the image and read
+        // through the guarded path before any field is trusted, and only a PE32+ image is accepted.
+        const std::size_t image_bytes = static_cast<std::size_t>(span.end - span.base);
+        const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(span.base);
+        if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0 ||
+            image_bytes < sizeof(IMAGE_NT_HEADERS64) ||
+            static_cast<std::size_t>(dos->e_lfanew) > image_bytes - sizeof(IMAGE_NT_HEADERS64))
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::module_identity"});
+        }
+        const std::uintptr_t nt_addr = span.base + static_cast<std::uintptr_t>(dos->e_lfanew);
+        const std::optional<IMAGE_NT_HEADERS64> nt = detail::guarded_read<IMAGE_NT_HEADERS64>(nt_addr);
+        if (!nt || nt->Signature != IMAGE_NT_SIGNATURE || nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC ||
+            nt->FileHeader.NumberOfSections > MAX_IMAGE_SECTIONS)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::module_identity"});
+        }
+
+        // The section table follows the optional header, whose size the file header declares (IMAGE_FIRST_SECTION).
+        const std::size_t table_offset = static_cast<std::size_t>(dos->e_lfanew) +
+                                         offsetof(IMAGE_NT_HEADERS64, OptionalHeader) +
+                                         nt->FileHeader.SizeOfOptionalHeader;
+        const std::size_t table_bytes =
+            static_cast<std::size_t>(nt->FileHeader.NumberOfSections) * sizeof(IMAGE_SECTION_HEADER);
+        if (table_offset > image_bytes || table_bytes > image_bytes - table_offset)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::module_identity"});
+        }
+
+        std::uint64_t section_hash = detail::fnv1a_int(detail::FNV1A64_OFFSET, nt->FileHeader.NumberOfSections);
+        for (std::uint16_t i = 0; i < nt->FileHeader.NumberOfSections; ++i)
+        {
+            const std::optional<IMAGE_SECTION_HEADER> section = detail::guarded_read<IMAGE_SECTION_HEADER>(
+                span.base + table_offset + static_cast<std::size_t>(i) * sizeof(IMAGE_SECTION_HEADER));
+            if (!section)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::module_identity"});
+            }
+            // Hash the identifying fields one by one rather than the raw struct, so the result does not depend on the
+            // relocation / line-number pointers a linker is free to leave as garbage.
+            for (const BYTE c : section->Name)
+            {
+                section_hash = detail::fnv1a_byte(section_hash, c);
+            }
+            section_hash = detail::fnv1a_int(section_hash, section->Misc.VirtualSize);
+            section_hash = detail::fnv1a_int(section_hash, section->VirtualAddress);
+            section_hash = detail::fnv1a_int(section_hash, section->SizeOfRawData);
+            section_hash = detail::fnv1a_int(section_hash, section->Characteristics);
+        }
+
+        return ModuleIdentity{
+            .time_date_stamp = static_cast<std::uint32_t>(nt->FileHeader.TimeDateStamp),
+            .size_of_image = static_cast<std::uint32_t>(nt->OptionalHeader.SizeOfImage),
+            .section_hash = section_hash,
+        };
+    }
+
+    scan::ResolutionCache::ResolutionCache() : m_impl(std::make_unique<Impl>()) {}
+
+    scan::ResolutionCache::~ResolutionCache() noexcept = default;
+
+    scan::ResolutionCache::ResolutionCache(ResolutionCache &&other) noexcept = default;
+
+    scan::ResolutionCache &scan::ResolutionCache::operator=(ResolutionCache &&other) noexcept = default;
+
+    Result<scan::ResolutionCache> scan::ResolutionCache::parse(std::string_view text)
+    {
+        ResolutionCache cache;
+        bool header_seen = false;
+        bool versioned = false;
+        bool calibrated = false;
+        std::size_t pos = 0;
+        while (pos <= text.size())
+        {
+            const std::size_t newline = text.find('\n', pos);
+            std::string_view line =
+                (newline == std::string_view::npos) ? text.substr(pos) : text.substr(pos, newline - pos);
+            pos = (newline == std::string_view::npos) ? text.size() + 1 : newline + 1;
+
+            // Strip a trailing CR (CRLF input) and skip blank lines.
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.remove_suffix(1);
+            }
+            if (line.empty())
+            {
+                continue;
+            }
+
+            if (!header_seen)
+            {
+                // A different version header is a format this build cannot read, reported like a missing one so the
+                // caller starts from an empty cache.
+                if (line != CACHE_HEADER && line != CACHE_HEADER_V2 && line != CACHE_HEADER_V1)
+                {
+                    return cache_error(ErrorCode::MissingHeader);
+                }
+                header_seen = true;
+                versioned = line != CACHE_HEADER_V1;
+                calibrated = line == CACHE_HEADER;
+                continue;
+            }
+
+            std::array<std::string_view, CALIBRATION_FIELD_COUNT> fields{};
+            std::size_t field_count = 0;
+            std::size_t field_pos = 0;
+            while (true)
+            {
+                const std::size_t sep = line.find(FIELD_SEP, field_pos);
+                if (field_count == fields.size())
+                {
+                    return cache_error(ErrorCode::MalformedLine);
+                }
+                fields[field_count++] = (sep == std::string_view::npos) ? line.substr(field_pos)
+                                                                        : line.substr(field_pos, sep - field_pos);
+                if (sep == std::string_view::npos)
+                {
+                    break;
+                }
+                field_pos = sep + 1;
+            }
+            if (calibrated && fields[0] == CALIBRATION_TAG)
+            {
+                scan::SimdCalibration calibration{};
+                std::uint8_t level = 0;
+                if (field_count != CALIBRATION_FIELD_COUNT || !parse_hex(fields[1], calibration.host_key) ||
+                    !parse_hex(fields[2], level) || level > static_cast<std::uint8_t>(scan::SimdLevel::Avx512) ||
+                    !parse_hex(fields[3], calibration.workers) || !parse_hex(fields[4], calibration.speedup_permille))
+                {
+                    return cache_error(ErrorCode::MalformedLine);
+                }
+                for (std::size_t tier = 1; tier < calibration.tier_nanos.size(); ++tier)
+                {
+                    if (!parse_hex(fields[4 + tier], calibration.tier_nanos[tier]))
+                    {
+                        return cache_error(ErrorCode::MalformedLine);
+                    }
+                }
+                calibration.level = static_cast<scan::SimdLevel>(level);
+                cache.m_impl->calibration = calibration;
+                continue;
+            }
+            if (field_count != FIELD_COUNT)
+            {
+                return cache_error(ErrorCode::MalformedLine);
+            }
+
+            std::uint64_t key = 0;
+            if (versioned && fields[0] == TIER_TAG)
+            {
+                std::size_t index = 0;
+                scan::TierStats stats{};
+                if (!parse_hex(fields[1], key) || !parse_hex(fields[2], index) ||
+                    index >= ResolutionCache::TIER_HISTORY_MAX_TIERS || !parse_hex(fields[3], stats.hits) ||
+                    !parse_hex(fields[4], stats.misses) || !parse_hex(fields[5], stats.ambiguous) ||
+                    !parse_hex(fields[6], stats.micros))
+                {
+                    return cache_error(ErrorCode::MalformedLine);
+                }
+                std::vector<scan::TierStats> &tiers = cache.m_impl->history[key];
+                if (tiers.size() <= index)
+                {
+                    tiers.resize(index + 1);
+                }
+                tiers[index] = stats;
+                continue;
+            }
+            CacheEntry entry{};
+            if (!parse_hex(fields[0], key) || !parse_hex(fields[1], entry.identity.time_date_stamp) ||
+                !parse_hex(fields[2], entry.identity.size_of_image) ||
+                !parse_hex(fields[3], entry.identity.section_hash) || !parse_hex(fields[4], entry.candidate_index) ||
+                !parse_hex(fields[5], entry.match_rva) || !parse_hex(fields[6], entry.resolved_rva))
+            {
+                return cache_error(ErrorCode::MalformedLine);
+            }
+            cache.m_impl->entries.insert_or_assign(key, entry);
+        }
+
+        if (!header_seen)
+        {
+            return cache_error(ErrorCode::MissingHeader);
+        }
+        return cache;
+    }
+
+    Result<scan::ResolutionCache> scan::ResolutionCache::load(const std::filesystem::path &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return cache_error(ErrorCode::FileOpenFailed);
+        }
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        return parse(text);
+    }
+
+    std::string scan::ResolutionCache::serialize() const
+    {
+        std::string out;
+        out.append(CACHE_HEADER.data(), CACHE_HEADER.size());
+        out.push_back('\n');
+        if (!m_impl)
+        {
+            return out;
+        }
+
+        const std::lock_guard lock(m_impl->mutex);
+        for (const auto &[key, entry] : m_impl->entries)
+        {
+            append_hex(out, key);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.identity.time_date_stamp);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.identity.size_of_image);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.identity.section_hash);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.candidate_index);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.match_rva);
+            out.push_back(FIELD_SEP);
+            append_hex(out, entry.resolved_rva);
+            out.push_back('\n');
+        }
+        for (const auto &[key, tiers] : m_impl->history)
+        {
+            for (std::size_t i = 0; i < tiers.size(); ++i)
+            {
+                // A never-tried tier reads back as zero anyway, so only the tiers with outcomes are written.
+                if (tiers[i].attempts() == 0)
+                {
+                    continue;
+                }
+                out.append(TIER_TAG.data(), TIER_TAG.size());
+                out.push_back(FIELD_SEP);
+                append_hex(out, key);
+                out.push_back(FIELD_SEP);
+                append_hex(out, i);
+                out.push_back(FIELD_SEP);
+                append_hex(out, tiers[i].hits);
+                out.push_back(FIELD_SEP);
+                append_hex(out, tiers[i].misses);
+                out.push_back(FIELD_SEP);
+                append_hex(out, tiers[i].ambiguous);
+                out.push_back(FIELD_SEP);
+                append_hex(out, tiers[i].micros);
+                out.push_back('\n');
+            }
+        }
+        if (const std::optional<SimdCalibration> &calibration = m_impl->calibration)
+        {
+            out.append(CALIBRATION_TAG.data(), CALIBRATION_TAG.size());
+            out.push_back(FIELD_SEP);
+            append_hex(out, calibration->host_key);
+            out.push_back(FIELD_SEP);
+            append_hex(out, static_cast<std::uint8_t>(calibration->level));
+            out.push_back(FIELD_SEP);
+            append_hex(out, calibration->workers);
+            out.push_back(FIELD_SEP);
+            append_hex(out, calibration->speedup_permille);
+            for (std::size_t tier = 1; tier < calibration->tier_nanos.size(); ++tier)
+            {
+                out.push_back(FIELD_SEP);
+                append_hex(out, calibration->tier_nanos[tier]);
+            }
+            out.push_back('\n');
+        }
+        return out;
+    }
+
+    Result<void> scan::ResolutionCache::save(const std::filesystem::path &path) const
+    {
+        // Binary mode so the '\n' line endings are written untranslated, as the drift manifest does.
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return cache_error(ErrorCode::FileOpenFailed);
+        }
+        const std::string text = serialize();
+        file.write(text.data(), static_cast<std::streamsize>(text.size()));
+        // Close explicitly so a failure that only surfaces on the final flush is observed here rather than swallowed
+        // by the destructor.
+        file.flush();
+        file.close();
+        if (!file)
+        {
+            return cache_error(ErrorCode::FileWriteFailed);
+        }
+        return {};
+    }
+
+    std::size_t scan::ResolutionCache::size() const noexcept
+    {
+        if (!m_impl)
+        {
+            return 0;
+        }
+        const std::lock_guard lock(m_impl->mutex);
+        return m_impl->entries.size();
+    }
+
+    void scan::ResolutionCache::clear() noexcept
+    {
+        if (!m_impl)
+        {
+            return;
+        }
+        const std::lock_guard lock(m_impl->mutex);
+        m_impl->entries.clear();
+        m_impl->history.clear();
+        m_impl->calibration.reset();
+        m_impl->stats = ResolutionCacheStats{};
+    }
+
+    std::vector<scan::TierStats> scan::ResolutionCache::tier_history(const ScanRequest &request) const
+    {
+        if (!m_impl)
+        {
+            return {};
+        }
+        std::vector<TierStats> out(request.ladder.size());
+        (void)detail::ResolutionCacheAccess::tier_history(*this, request, out);
+        return out;
+    }
+
+    scan::ResolutionCacheStats scan::ResolutionCache::stats() const noexcept
+    {
+        if (!m_impl)
+        {
+            return ResolutionCacheStats{};
+        }
+        const std::lock_guard lock(m_impl->mutex);
+        return m_impl->stats;
+    }
+
+    std::optional<scan::SimdCalibration> scan::ResolutionCache::calibration() const noexcept
+    {
+        if (!m_impl)
+        {
+            return std::nullopt;
+        }
+        const std::lock_guard lock(m_impl->mutex);
+        return m_impl->calibration;
+    }
+
+    void scan::ResolutionCache::record_calibration(const SimdCalibration &calibration) noexcept
+    {
+        if (!m_impl)
+        {
+            return;
+        }
+        SimdCalibration stored = calibration;
+        stored.from_cache = false;
+        const std::lock_guard lock(m_impl->mutex);
+        m_impl->calibration = stored;
+    }
+
+    Result<void> scan::ResolutionCache::share_in_process() noexcept
+    {
+        if (!m_impl)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::ResolutionCache::share_in_process"});
+        }
+        {
+            const std::lock_guard lock(m_impl->mutex);
+            if (m_impl->shared)
+            {
+                return {};
+            }
+        }
+        // Open outside the lock: creating the mapping is a kernel round trip no concurrent lookup should wait on.
+        Result<detail::SharedResolutionTable> table = detail::SharedResolutionTable::open();
+        if (!table)
+        {
+            return std::unexpected(table.error());
+        }
+        try
+        {
+            auto view = std::make_unique<detail::SharedResolutionTable>(std::move(*table));
+            const std::lock_guard lock(m_impl->mutex);
+            if (!m_impl->shared)
+            {
+                m_impl->shared = std::move(view);
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::ResolutionCache::share_in_process"});
+        }
+        return {};
+    }
+
+    bool scan::ResolutionCache::shares_in_process() const noexcept
+    {
+        if (!m_impl)
+        {
+            return false;
+        }
+        const std::lock_guard lock(m_impl->mutex);
+        return m_impl->shared != nullptr;
+    }
+
+    detail::CacheProbe detail::ResolutionCacheAccess::probe(scan::ResolutionCache &cache,
+                                                            const scan::ScanRequest &request,
+                                                            detail::ModuleSpan range, bool count_lookup) noexcept
+    {
+        CacheProbe probe{};
+        if (!cache.m_impl)
+        {
+            return probe;
+        }
+        const Result<scan::ModuleIdentity> identity = scan::module_identity(request.scope);
+        if (!identity)
+        {
+            // Not a PE image (an arbitrary memory Region): there is no build identity to key on, so the request
+            // resolves uncached and record() stores nothing for it.
+            return probe;
+        }
+        probe.identity = *identity;
+        probe.key = request_key(request);
+
+        std::optional<CacheEntry> entry;
+        {
+            const std::lock_guard lock(cache.m_impl->mutex);
+            const auto found = cache.m_impl->entries.find(probe.key);
+            if (found != cache.m_impl->entries.end() && found->second.identity == *identity)
+            {
+                entry = found->second;
+            }
+            else if (cache.m_impl->shared)
+            {
+                // Another instance in the process may already have resolved this request against the same build.
+                if (const auto published = cache.m_impl->shared->lookup(probe.key, *identity))
+                {
+                    entry = CacheEntry{
+                        .identity = published->identity,
+                        .candidate_index = published->candidate_index,
+                        .match_rva = published->match_rva,
+                        .resolved_rva = published->resolved_rva,
+                    };
+                    probe.shared = true;
+                }
+            }
+            if (!entry)
+            {
+                if (count_lookup)
+                {
+                    ++cache.m_impl->stats.misses;
+                }
+                return probe;
+            }
+        }
+
+        // Re-verify outside the lock: the guarded reads below may take a fault and must never stall another worker's
+        // lookup. A failure here is a rejection, not a miss -- the build matched but the live site no longer does.
+        const auto reject = [&cache, count_lookup]() noexcept
+        {
+            if (!count_lookup)
+            {
+                return;
+            }
+            const std::lock_guard lock(cache.m_impl->mutex);
+            ++cache.m_impl->stats.rejected;
+        };
+        const std::size_t image_bytes = static_cast<std::size_t>(range.end - range.base);
+        if (entry->candidate_index >= request.ladder.size() || entry->match_rva >= image_bytes ||
+            entry->resolved_rva >= image_bytes)
+        {
+            reject();
+            return probe;
+        }
+        const scan::Pattern *pattern = cacheable_pattern(request.ladder[entry->candidate_index]);
+        const std::uintptr_t match_point = range.base + static_cast<std::uintptr_t>(entry->match_rva);
+        if (pattern == nullptr || entry->match_rva < pattern->offset())
+        {
+            reject();
+            return probe;
+        }
+        const std::uintptr_t match_start = match_point - pattern->offset();
+        if (pattern->size() > static_cast<std::size_t>(range.end - match_start))
+        {
+            reject();
+            return probe;
+        }
+        // The page class gates a cached site exactly as it gates a scan: an Executable request never accepts a site
+        // that now lies on a data page.
+        if (request.pages == scan::Pages::Executable && !is_executable_range(match_start, pattern->size()))
+        {
+            reject();
+            return probe;
+        }
+        std::array<std::byte, MAX_PATTERN_BYTES> window{};
+        if (!guarded_read_bytes(match_start, window.data(), pattern->size()) ||
+            !pattern->matches_at(std::span<const std::byte>(window.data(), pattern->size())))
+        {
+            reject();
+            return probe;
+        }
+
+        probe.candidate_index = entry->candidate_index;
+        probe.match_point = match_point;
+        probe.resolved = range.base + static_cast<std::uintptr_t>(entry->resolved_rva);
+        probe.image_base = range.base;
+        return probe;
+    }
+
+    void detail::ResolutionCacheAccess::settle(scan::ResolutionCache &cache, const detail::CacheProbe &probe,
+                                               bool accepted) noexcept
+    {
+        if (!cache.m_impl)
+        {
+            return;
+        }
+        const std::lock_guard lock(cache.m_impl->mutex);
+        if (!accepted)
+        {
+            ++cache.m_impl->stats.rejected;
+            return;
+        }
+        ++cache.m_impl->stats.hits;
+        if (!probe.shared || !probe.identity || !probe.candidate_index)
+        {
+            return;
+        }
+        ++cache.m_impl->stats.shared_hits;
+        try
+        {
+            cache.m_impl->entries.insert_or_assign(
+                probe.key, CacheEntry{
+                               .identity = *probe.identity,
+                               .candidate_index = static_cast<std::uint32_t>(*probe.candidate_index),
+                               .match_rva = static_cast<std::uint64_t>(probe.match_point - probe.image_base),
+                               .resolved_rva = static_cast<std::uint64_t>(probe.resolved - probe.image_base),
+                           });
+        }
+        catch (...)
+        {
+            // Not adopting only means this cache's save() omits the entry; the shared table still serves it.
+        }
+    }
+
+    void detail::ResolutionCacheAccess::record(scan::ResolutionCache &cache, const scan::ScanRequest &request,
+                                               const detail::CacheProbe &probe, std::size_t candidate_index,
+                                               std::uintptr_t match_point, std::uintptr_t resolved,
+                                               detail::ModuleSpan range) noexcept
+    {
+        if (!cache.m_impl || !probe.identity || candidate_index >= request.ladder.size() ||
+            candidate_index > std::numeric_limits<std::uint32_t>::max() ||
+            cacheable_pattern(request.ladder[candidate_index]) == nullptr || !range.contains(match_point) ||
+            !range.contains(resolved))
+        {
+            return;
+        }
+        const CacheEntry entry{
+            .identity = *probe.identity,
+            .candidate_index = static_cast<std::uint32_t>(candidate_index),
+            .match_rva = static_cast<std::uint64_t>(match_point - range.base),
+            .resolved_rva = static_cast<std::uint64_t>(resolved - range.base),
+        };
+        const std::lock_guard lock(cache.m_impl->mutex);
+        if (cache.m_impl->shared)
+        {
+            cache.m_impl->shared->publish(probe.key, detail::SharedResolution{
+                                                         .identity = entry.identity,
+                                                         .candidate_index = entry.candidate_index,
+                                                         .match_rva = entry.match_rva,
+                                                         .resolved_rva = entry.resolved_rva,
+                                                     });
+        }
+        try
+        {
+            cache.m_impl->entries.insert_or_assign(probe.key, entry);
+        }
+        catch (...)
+        {
+            // A node allocation failure only costs the next launch its warm start for this request.
+        }
+    }
+
+    bool detail::ResolutionCacheAccess::tier_history(const scan::ResolutionCache &cache,
+                                                     const scan::ScanRequest &request,
+                                                     std::span<scan::TierStats> out) noexcept
+    {
+        if (!cache.m_impl || out.size() < request.ladder.size())
+        {
+            return false;
+        }
+        const std::uint64_t key = request_key(request);
+        const std::lock_guard lock(cache.m_impl->mutex);
+        const auto found = cache.m_impl->history.find(key);
+        if (found == cache.m_impl->history.end())
+        {
+            return false;
+        }
+        const std::vector<scan::TierStats> &tiers = found->second;
+        for (std::size_t i = 0; i < request.ladder.size(); ++i)
+        {
+            out[i] = i < tiers.size() ? tiers[i] : scan::TierStats{};
+        }
+        return true;
+    }
+
+    void detail::ResolutionCacheAccess::record_tiers(scan::ResolutionCache &cache, const scan::ScanRequest &request,
+                                                     std::span<const detail::TierOutcome> outcomes) noexcept
+    {
+        if (!cache.m_impl || outcomes.empty())
+        {
+            return;
+        }
+        const std::uint64_t key = request_key(request);
+        const std::size_t tier_count = std::min(request.ladder.size(), scan::ResolutionCache::TIER_HISTORY_MAX_TIERS);
+        const std::lock_guard lock(cache.m_impl->mutex);
+        try
+        {
+            std::vector<scan::TierStats> &tiers = cache.m_impl->history[key];
+            if (tiers.size() < tier_count)
+            {
+                tiers.resize(tier_count);
+            }
+            for (const detail::TierOutcome &outcome : outcomes)
+            {
+                if (outcome.index >= tiers.size())
+                {
+                    continue;
+                }
+                scan::TierStats &stats = tiers[outcome.index];
+                switch (outcome.verdict)
+                {
+                case detail::TierVerdict::Resolved:
+                    ++stats.hits;
+                    break;
+                case detail::TierVerdict::Missed:
+                    ++stats.misses;
+                    break;
+                case detail::TierVerdict::Ambiguous:
+                    ++stats.ambiguous;
+                    break;
+                }
+                stats.micros += outcome.micros;
+                if (stats.attempts() >= scan::ResolutionCache::TIER_HISTORY_WINDOW)
+                {
+                    stats.hits /= 2;
+                    stats.misses /= 2;
+                    stats.ambiguous /= 2;
+                    stats.micros /= 2;
+                }
+            }
+        }
+        catch (...)
+        {
+            // Dropped outcomes only leave the next Adaptive resolve on the order it already had.
+        }
+    }
+} // namespace DetourModKit
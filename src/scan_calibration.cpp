@@ -0,0 +1,242 @@
+/**
+ * @file scan_calibration.cpp
+ * @brief The startup self-benchmark behind scan::calibrate_simd: per-tier verify timings on real image bytes, the
+ *        batch speedup measurement, and the process-wide tier ceiling and worker count they set.
+ * @details Feature bits say which tiers a CPU can run, not which one is fastest on it: a wide tier can lose to a
+ *          narrower one on a core that downclocks for it or splits its vectors in two. The calibration therefore times
+ *          the engine's own verify ladder rather than a synthetic loop, over a private copy of the caller's sample so
+ *          a page that goes away mid-sweep cannot fault the host. Each tier keeps its fastest round, which filters a
+ *          preempted sweep without needing many rounds.
+ */
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_cache.hpp"
+
+#include "fork_join.hpp"
+#include "internal/fnv1a.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_engine.hpp"
+#include "platform.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        // Length of both calibration patterns: three AVX-512 chunks, so every tier runs its own body several times
+        // before the narrower ones finish the tail.
+        constexpr std::size_t CALIBRATION_PATTERN_BYTES = 192;
+
+        // The smallest sample calibrate_simd accepts; below this the sweeps are too short to time.
+        constexpr std::size_t CALIBRATION_MIN_SAMPLE = 256;
+
+        // A narrower tier must be this much faster than the widest one, in thousandths, to be picked.
+        constexpr std::uint64_t CALIBRATION_MARGIN_PERMILLE = 50;
+
+        // Batch items per participant in the speedup run: enough for stealing to hide one slow start.
+        constexpr std::size_t CALIBRATION_ITEMS_PER_WORKER = 4;
+
+        // The two ends of what a verify costs. The reject pattern is the sample's own first bytes, so at every other
+        // position it fails in its first chunk; the deep pattern is all wildcards but its last byte, so every chunk
+        // passes and only the scalar tail can reject.
+        struct CalibrationPatterns
+        {
+            detail::EnginePattern reject;
+            detail::EnginePattern deep;
+        };
+
+        [[nodiscard]] CalibrationPatterns make_patterns(const std::vector<std::byte> &sample)
+        {
+            CalibrationPatterns patterns;
+            patterns.reject.bytes.assign(sample.begin(), sample.begin() + CALIBRATION_PATTERN_BYTES);
+            patterns.reject.mask.assign(CALIBRATION_PATTERN_BYTES, std::byte{0xFF});
+            patterns.deep.bytes.assign(CALIBRATION_PATTERN_BYTES, std::byte{0x00});
+            patterns.deep.mask.assign(CALIBRATION_PATTERN_BYTES, std::byte{0x00});
+            patterns.deep.bytes.back() = sample[CALIBRATION_PATTERN_BYTES - 1];
+            patterns.deep.mask.back() = std::byte{0xFF};
+            return patterns;
+        }
+
+        // One sweep of both patterns with @p tier as the widest. The match count goes to @p sink so the sweeps have
+        // an observable result.
+        [[nodiscard]] std::uint64_t time_sweep(scan::SimdLevel tier, const std::vector<std::byte> &sample,
+                                               const CalibrationPatterns &patterns, std::atomic<std::size_t> &sink)
+        {
+            const Clock::time_point start = Clock::now();
+            std::size_t matches = detail::verify_sweep(tier, sample.data(), sample.size(), patterns.reject);
+            matches += detail::verify_sweep(tier, sample.data(), sample.size(), patterns.deep);
+            const Clock::duration elapsed = Clock::now() - start;
+            sink.fetch_add(matches, std::memory_order_relaxed);
+            return static_cast<std::uint64_t>(
+                std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(), 1));
+        }
+
+        struct SpeedupRun
+        {
+            scan::SimdLevel tier;
+            const std::vector<std::byte> *sample;
+            const CalibrationPatterns *patterns;
+            std::atomic<std::size_t> *sink;
+        };
+
+        void speedup_item(void *context, std::size_t) noexcept
+        {
+            const SpeedupRun &run = *static_cast<const SpeedupRun *>(context);
+            std::size_t matches =
+                detail::verify_sweep(run.tier, run.sample->data(), run.sample->size(), run.patterns->reject);
+            matches += detail::verify_sweep(run.tier, run.sample->data(), run.sample->size(), run.patterns->deep);
+            run.sink->fetch_add(matches, std::memory_order_relaxed);
+        }
+
+        // Runs CALIBRATION_ITEMS_PER_WORKER sweeps per logical processor as one batch and compares the wall time with
+        // the same sweeps run back to back. Leaves the calibration's worker fields at 0 when there is nothing to
+        // measure (one processor, or the loader lock, where the batch would run serially anyway).
+        void measure_workers(scan::SimdCalibration &calibration, const std::vector<std::byte> &sample,
+                             const CalibrationPatterns &patterns, std::atomic<std::size_t> &sink)
+        {
+            const unsigned int hardware = std::thread::hardware_concurrency();
+            if (hardware < 2 || detail::is_loader_lock_held())
+            {
+                return;
+            }
+            const std::size_t participants = std::min<std::size_t>(hardware, detail::FORK_JOIN_MAX_PARTICIPANTS);
+            const std::size_t items = participants * CALIBRATION_ITEMS_PER_WORKER;
+            const std::uint64_t serial_nanos =
+                calibration.tier_nanos[static_cast<std::size_t>(calibration.level)] * items;
+
+            SpeedupRun run{calibration.level, &sample, &patterns, &sink};
+            // One untimed pass first, so starting the pool's threads is not billed to the batch.
+            detail::fork_join_dispatch(participants, participants - 1, &speedup_item, &run);
+            const Clock::time_point start = Clock::now();
+            detail::fork_join_dispatch(items, participants - 1, &speedup_item, &run);
+            const auto parallel_nanos = static_cast<std::uint64_t>(std::max<std::int64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count(), 1));
+
+            const double speedup = static_cast<double>(serial_nanos) / static_cast<double>(parallel_nanos);
+            calibration.speedup_permille = static_cast<std::uint32_t>(
+                std::clamp(speedup * 1000.0, 0.0, static_cast<double>(participants) * 1000.0));
+            calibration.workers = std::clamp<std::size_t>(static_cast<std::size_t>(std::lround(speedup)), 1,
+                                                          participants);
+        }
+    } // namespace
+
+    namespace scan
+    {
+        std::uint64_t calibration_host_key() noexcept
+        {
+            std::uint64_t hash = detail::fnv1a_int(detail::FNV1A64_OFFSET, detail::cpu_signature_word());
+            hash = detail::fnv1a_int(hash, std::thread::hardware_concurrency());
+            return detail::fnv1a_byte(hash, static_cast<std::uint8_t>(detail::detected_simd_level()));
+        }
+
+        Result<SimdCalibration> calibrate_simd(Region sample, const CalibrationOptions &options) noexcept
+        {
+            try
+            {
+                const std::uint64_t host_key = calibration_host_key();
+                if (options.cache != nullptr)
+                {
+                    if (std::optional<SimdCalibration> cached = options.cache->calibration();
+                        cached.has_value() && cached->host_key == host_key)
+                    {
+                        cached->from_cache = true;
+                        if (options.apply)
+                        {
+                            apply_simd_calibration(*cached);
+                        }
+                        return *cached;
+                    }
+                }
+
+                const std::size_t bytes = std::min(options.sample_bytes, sample.size);
+                if (bytes < CALIBRATION_MIN_SAMPLE)
+                {
+                    return std::unexpected(Error{ErrorCode::RegionTooSmall, "scan::calibrate_simd", bytes, 0});
+                }
+                std::vector<std::byte> copy(bytes);
+                if (!detail::guarded_read_bytes(sample.base.raw(), copy.data(), bytes))
+                {
+                    return std::unexpected(
+                        Error{ErrorCode::ReadFaulted, "scan::calibrate_simd", sample.base.raw(), 0});
+                }
+                const CalibrationPatterns patterns = make_patterns(copy);
+
+                SimdCalibration calibration{};
+                calibration.host_key = host_key;
+                const SimdLevel widest = std::max(detail::detected_simd_level(), SimdLevel::Sse2);
+                std::atomic<std::size_t> sink{0};
+                const std::size_t rounds = std::max<std::size_t>(options.rounds, 1);
+                for (auto tier = static_cast<std::size_t>(SimdLevel::Sse2); tier <= static_cast<std::size_t>(widest);
+                     ++tier)
+                {
+                    std::uint64_t best = UINT64_MAX;
+                    for (std::size_t round = 0; round < rounds; ++round)
+                    {
+                        best = std::min(best, time_sweep(static_cast<SimdLevel>(tier), copy, patterns, sink));
+                    }
+                    calibration.tier_nanos[tier] = best;
+                }
+
+                // Start from the widest tier and let a narrower one take over only past the margin.
+                calibration.level = widest;
+                std::uint64_t fastest = calibration.tier_nanos[static_cast<std::size_t>(widest)];
+                const std::uint64_t threshold = fastest - fastest * CALIBRATION_MARGIN_PERMILLE / 1000;
+                for (auto tier = static_cast<std::size_t>(SimdLevel::Sse2); tier < static_cast<std::size_t>(widest);
+                     ++tier)
+                {
+                    if (calibration.tier_nanos[tier] < threshold && calibration.tier_nanos[tier] < fastest)
+                    {
+                        calibration.level = static_cast<SimdLevel>(tier);
+                        fastest = calibration.tier_nanos[tier];
+                    }
+                }
+
+                if (options.measure_workers)
+                {
+                    measure_workers(calibration, copy, patterns, sink);
+                }
+                if (options.cache != nullptr)
+                {
+                    options.cache->record_calibration(calibration);
+                }
+                if (options.apply)
+                {
+                    apply_simd_calibration(calibration);
+                }
+                return calibration;
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::calibrate_simd"});
+            }
+            catch (...)
+            {
+                return std::unexpected(Error{ErrorCode::Unknown, "scan::calibrate_simd"});
+            }
+        }
+
+        void apply_simd_calibration(const SimdCalibration &calibration) noexcept
+        {
+            detail::set_simd_ceiling(calibration.level);
+            detail::set_fork_join_auto_workers(calibration.workers);
+        }
+
+        void reset_simd_calibration() noexcept
+        {
+            detail::set_simd_ceiling(SimdLevel::Avx512);
+            detail::set_fork_join_auto_workers(0);
+        }
+    } // namespace scan
+} // namespace DetourModKit
@@ -29,8 +29,8 @@ namespace DetourModKit
                 return count;
             }
 
-            // UniqueFirst: three stable passes over the declared order. Every candidate falls into exactly one pass, so
-            // the result is a permutation of [0, count).
+            // UniqueFirst (and Adaptive, whose history only the resolver sees): three stable passes over the declared
+            // order. Every candidate falls into exactly one pass, so the result is a permutation of [0, count).
             std::size_t written = 0;
             const auto emit = [&](auto predicate)
             {
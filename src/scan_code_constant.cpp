@@ -6,17 +6,27 @@
  *          displacement is returned as the CURRENT value. The caller's nominal is never a short-circuit, so a
  *          same-shape / different-value drift is reported as the new value. The CodeConstant's Candidate ladder
  *          resolves the site; Zydis is confined to this TU.
+ *
+ *          read_code_constants() is the batch form: one resolve_batch over every ladder, one decoder for the batch, and
+ *          the resolved sites decoded in address order so neighbouring sites share one page-class check and one
+ *          guarded read.
  */
 
 #include "DetourModKit/scan.hpp"
 
+#include "internal/scan_multi.hpp"
 #include "internal/scan_pages.hpp"
 #include "internal/scan_shared.hpp"
 
 #include <Zydis/Zydis.h>
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <new>
+#include <span>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -42,117 +52,247 @@ namespace DetourModKit
                 const std::uint64_t extended = (masked ^ sign_bit) - sign_bit;
                 return static_cast<std::int64_t>(extended);
             }
-        } // namespace
 
-        Result<std::int64_t> read_code_constant(const CodeConstant &code_constant, Region scope)
-        {
-            // Resolve the instruction site through the candidate ladder and propagate its typed failure verbatim
-            // (EmptyCandidates, NoMatch, InvalidRange, ...). The resolved address must name an executable instruction
-            // site; require_executable_result rejects an unsuitable rung and lets resolve() try a later ladder
-            // fallback.
-            //
-            // A code constant is encoded in machine code. Restrict byte tiers to execute-readable pages so an identical
-            // run in .rdata / .data cannot win or make the code match ambiguous. A RipRelative or walked-back candidate
-            // can still transform an executable match into a data address, so enforce the final-page policy in
-            // resolve() and recheck below before the fault-safe read and decode. The recheck narrows, but cannot
-            // eliminate, a concurrent protection change; guarded_read_bytes preserves the fail-closed host-safety
-            // guarantee.
-            const ScanRequest request{
-                .ladder = code_constant.site,
-                .label = "read_code_constant",
-                .scope = scope,
-                .pages = Pages::Executable,
-                .require_executable_result = true,
-            };
-            const Result<Hit> hit = resolve(request);
-            if (!hit)
-            {
-                return std::unexpected(hit.error());
-            }
-            const std::uintptr_t site = hit->address.raw();
-            if (!detail::is_executable_address(site))
+            // Decodes the instruction whose first @p avail bytes, copied from @p site, are in @p buf, and extracts the
+            // operand @p code_constant names. @p window_executable says the caller has already checked that the whole
+            // copied window is execute-readable, which covers the decoded instruction's own range check.
+            Result<std::int64_t> decode_operand(const ZydisDecoder &decoder, const CodeConstant &code_constant,
+                                                std::uintptr_t site, const std::byte *buf, std::size_t avail,
+                                                bool window_executable) noexcept
             {
-                return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
-            }
+                ZydisDecodedInstruction insn;
+                ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+                if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, buf, avail, &insn, operands)))
+                {
+                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
+                if (!window_executable && !detail::is_executable_range(site, insn.length))
+                {
+                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
 
-            const detail::ModuleSpan range = detail::module_span(scope);
+                // Index the VISIBLE operands -- the ones a human counts in a disassembler. operand_count includes
+                // implicit/hidden operands (flags, implicit registers, stack writes), which would make a fixed
+                // operand_index drift between mnemonics.
+                if (code_constant.operand_index >= insn.operand_count_visible)
+                {
+                    return std::unexpected(Error{ErrorCode::OperandOutOfRange, "scan::read_code_constant"});
+                }
+                const ZydisDecodedOperand &operand = operands[code_constant.operand_index];
 
-            // Read a full maximum-length instruction window, clamped to the module so the read never runs past the end
-            // of the image, behind a fault guard. A truncated window that fails to decode is reported as DecodeFailed
-            // below.
-            std::byte buf[ZYDIS_MAX_INSTRUCTION_LENGTH];
-            std::size_t avail = sizeof(buf);
-            if (range.valid() && site < range.end)
-            {
-                const std::uintptr_t to_end = range.end - site;
-                if (to_end < avail)
+                if (code_constant.kind == OperandKind::Immediate)
                 {
-                    avail = static_cast<std::size_t>(to_end);
+                    if (operand.type != ZYDIS_OPERAND_TYPE_IMMEDIATE)
+                    {
+                        return std::unexpected(Error{ErrorCode::UnexpectedShape, "scan::read_code_constant"});
+                    }
+                    // imm.value.s is already 64-bit sign-extended by Zydis.
+                    return narrow_signed(static_cast<std::int64_t>(operand.imm.value.s), code_constant.byte_width);
                 }
+
+                // MemoryDisplacement. A register-indirect operand with no displacement (for example plain `[rcx]`)
+                // carries no constant to read.
+                if (operand.type != ZYDIS_OPERAND_TYPE_MEMORY || !operand.mem.disp.has_displacement)
+                {
+                    return std::unexpected(Error{ErrorCode::UnexpectedShape, "scan::read_code_constant"});
+                }
+
+                if (operand.mem.base == ZYDIS_REGISTER_RIP)
+                {
+                    // RIP-relative: the raw displacement is measured from the next instruction, not the absolute
+                    // constant the caller wants. Resolve it to the absolute target so the return value is meaningful
+                    // rather than a misleading relative offset.
+                    ZyanU64 absolute = 0;
+                    if (!ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&insn, &operand, static_cast<ZyanU64>(site), &absolute)))
+                    {
+                        return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                    }
+                    return static_cast<std::int64_t>(absolute);
+                }
+
+                // disp.value is already 64-bit sign-extended.
+                return narrow_signed(static_cast<std::int64_t>(operand.mem.disp.value), code_constant.byte_width);
             }
-            if (avail == 0 || !detail::guarded_read_bytes(site, buf, avail))
+
+            // Decodes the constant at the site @p hit resolved. A failed resolve propagates its typed failure verbatim
+            // (EmptyCandidates, NoMatch, InvalidRange, ...).
+            Result<std::int64_t> decode_code_constant(const CodeConstant &code_constant, Region scope,
+                                                      const Result<Hit> &hit)
             {
-                return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                if (!hit)
+                {
+                    return std::unexpected(hit.error());
+                }
+                const std::uintptr_t site = hit->address.raw();
+                if (!detail::is_executable_address(site))
+                {
+                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
+
+                const detail::ModuleSpan range = detail::module_span(scope);
+
+                // Read a full maximum-length instruction window, clamped to the module so the read never runs past the
+                // end of the image, behind a fault guard. A truncated window that fails to decode is reported as
+                // DecodeFailed below.
+                std::byte buf[ZYDIS_MAX_INSTRUCTION_LENGTH];
+                std::size_t avail = sizeof(buf);
+                if (range.valid() && site < range.end)
+                {
+                    const std::uintptr_t to_end = range.end - site;
+                    if (to_end < avail)
+                    {
+                        avail = static_cast<std::size_t>(to_end);
+                    }
+                }
+                if (avail == 0 || !detail::guarded_read_bytes(site, buf, avail))
+                {
+                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
+
+                ZydisDecoder decoder;
+                if (!ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)))
+                {
+                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
+
+                return decode_operand(decoder, code_constant, site, buf, avail, false);
             }
+        } // namespace
 
-            ZydisDecoder decoder;
-            if (!ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)))
+        Result<std::int64_t> read_code_constant(const CodeConstant &code_constant, Region scope)
+        {
+            // Resolve the instruction site through the candidate ladder, then decode the operand there.
+            return decode_code_constant(code_constant, scope,
+                                        resolve(detail::code_constant_request(code_constant, scope)));
+        }
+
+        Result<void> read_code_constants(std::span<const CodeConstant> constants, std::span<Result<std::int64_t>> out,
+                                         Region scope, std::size_t max_workers) noexcept
+        {
+            if (out.size() < constants.size())
             {
-                return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                return std::unexpected(Error{ErrorCode::InvalidArg, "scan::read_code_constants", out.size()});
             }
+            const std::span<Result<std::int64_t>> slots = out.first(constants.size());
 
-            ZydisDecodedInstruction insn;
-            ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
-            if (!ZYAN_SUCCESS(ZydisDecoderDecodeFull(&decoder, buf, avail, &insn, operands)))
+            std::vector<ScanRequest> requests;
+            std::vector<Result<Hit>> hits;
+            std::vector<std::size_t> order;
+            try
             {
-                return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                requests.reserve(constants.size());
+                for (const CodeConstant &code_constant : constants)
+                {
+                    requests.push_back(detail::code_constant_request(code_constant, scope));
+                }
+                hits.assign(constants.size(),
+                            Result<Hit>{std::unexpected(Error{ErrorCode::NoMatch, "scan::read_code_constants"})});
+                order.reserve(constants.size());
             }
-            if (!detail::is_executable_range(site, insn.length))
+            catch (const std::bad_alloc &)
             {
-                return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                const Error error{ErrorCode::OutOfMemory, "scan::read_code_constants"};
+                std::ranges::fill(slots, Result<std::int64_t>{std::unexpected(error)});
+                return std::unexpected(error);
             }
 
-            // Index the VISIBLE operands -- the ones a human counts in a disassembler. operand_count includes
-            // implicit/hidden operands (flags, implicit registers, stack writes), which would make a fixed
-            // operand_index drift between mnemonics.
-            if (code_constant.operand_index >= insn.operand_count_visible)
+            // Every ladder resolves in one batch: one page-map snapshot and prescan, spread over the worker pool when
+            // the batch is large enough to pay for it.
+            if (const Result<void> resolved = resolve_batch(requests, hits, max_workers); !resolved)
             {
-                return std::unexpected(Error{ErrorCode::OperandOutOfRange, "scan::read_code_constant"});
+                std::ranges::fill(slots, Result<std::int64_t>{std::unexpected(resolved.error())});
+                return resolved;
             }
-            const ZydisDecodedOperand &operand = operands[code_constant.operand_index];
 
-            if (code_constant.kind == OperandKind::Immediate)
+            ZydisDecoder decoder;
+            const bool decoder_ready =
+                ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64));
+            for (std::size_t i = 0; i < constants.size(); ++i)
             {
-                if (operand.type != ZYDIS_OPERAND_TYPE_IMMEDIATE)
+                if (!hits[i])
                 {
-                    return std::unexpected(Error{ErrorCode::UnexpectedShape, "scan::read_code_constant"});
+                    slots[i] = std::unexpected(hits[i].error());
+                }
+                else if (!decoder_ready)
+                {
+                    slots[i] = std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                }
+                else
+                {
+                    order.push_back(i);
                 }
-                // imm.value.s is already 64-bit sign-extended by Zydis.
-                return narrow_signed(static_cast<std::int64_t>(operand.imm.value.s), code_constant.byte_width);
             }
+            const auto site_of = [&hits](std::size_t i) noexcept { return hits[i]->address.raw(); };
+            std::ranges::sort(order, {}, site_of);
 
-            // MemoryDisplacement. A register-indirect operand with no displacement (for example plain `[rcx]`) carries
-            // no constant to read.
-            if (operand.type != ZYDIS_OPERAND_TYPE_MEMORY || !operand.mem.disp.has_displacement)
+            // Sites in address order are grouped into windows of at most one page plus an instruction. A group whose
+            // whole window is execute-readable and copies under one guarded read decodes every site from that copy;
+            // any other group falls back to the per-site checks and read, so a faulting or mixed-protection span
+            // reports each site exactly as read_code_constant would.
+            constexpr std::size_t SHARED_SPAN = 0x1000;
+            std::array<std::byte, SHARED_SPAN + ZYDIS_MAX_INSTRUCTION_LENGTH> window;
+            const detail::ModuleSpan range = detail::module_span(scope);
+            std::size_t group = 0;
+            while (group < order.size())
             {
-                return std::unexpected(Error{ErrorCode::UnexpectedShape, "scan::read_code_constant"});
-            }
+                const std::uintptr_t first = site_of(order[group]);
+                std::size_t next = group + 1;
+                while (next < order.size() && site_of(order[next]) - first <= SHARED_SPAN)
+                {
+                    ++next;
+                }
+                std::uintptr_t window_end = site_of(order[next - 1]) + ZYDIS_MAX_INSTRUCTION_LENGTH;
+                if (range.valid() && first < range.end && window_end > range.end)
+                {
+                    window_end = range.end;
+                }
+                const std::size_t window_size = static_cast<std::size_t>(window_end - first);
+                const bool shared = window_end > first && detail::is_executable_range(first, window_size) &&
+                                    detail::guarded_read_bytes(first, window.data(), window_size);
 
-            if (operand.mem.base == ZYDIS_REGISTER_RIP)
-            {
-                // RIP-relative: the raw displacement is measured from the next instruction, not the absolute constant
-                // the caller wants. Resolve it to the absolute target so the return value is meaningful rather than a
-                // misleading relative offset.
-                ZyanU64 absolute = 0;
-                if (!ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&insn, &operand, static_cast<ZyanU64>(site), &absolute)))
+                for (std::size_t k = group; k < next; ++k)
                 {
-                    return std::unexpected(Error{ErrorCode::DecodeFailed, "scan::read_code_constant"});
+                    const std::size_t i = order[k];
+                    const std::uintptr_t site = site_of(i);
+                    if (!shared || site >= window_end)
+                    {
+                        slots[i] = decode_code_constant(constants[i], scope, hits[i]);
+                        continue;
+                    }
+                    const auto avail = std::min<std::size_t>(ZYDIS_MAX_INSTRUCTION_LENGTH, window_end - site);
+                    slots[i] = decode_operand(decoder, constants[i], site, window.data() + (site - first), avail, true);
                 }
-                return static_cast<std::int64_t>(absolute);
+                group = next;
             }
-
-            // disp.value is already 64-bit sign-extended.
-            return narrow_signed(static_cast<std::int64_t>(operand.mem.disp.value), code_constant.byte_width);
+            return {};
         }
     } // namespace scan
+
+    scan::ScanRequest detail::code_constant_request(const scan::CodeConstant &code_constant, Region scope) noexcept
+    {
+        // The resolved address must name an executable instruction site; require_executable_result rejects an
+        // unsuitable rung and lets resolve() try a later ladder fallback.
+        //
+        // A code constant is encoded in machine code. Restrict byte tiers to execute-readable pages so an identical run
+        // in .rdata / .data cannot win or make the code match ambiguous. A RipRelative or walked-back candidate can
+        // still transform an executable match into a data address, so enforce the final-page policy in resolve() and
+        // recheck in the decode before the fault-safe read. The recheck narrows, but cannot eliminate, a concurrent
+        // protection change; guarded_read_bytes preserves the fail-closed host-safety guarantee.
+        return scan::ScanRequest{
+            .ladder = code_constant.site,
+            .label = "read_code_constant",
+            .scope = scope,
+            .pages = scan::Pages::Executable,
+            .require_executable_result = true,
+        };
+    }
+
+    Result<std::int64_t> detail::read_code_constant_prescanned(const scan::CodeConstant &code_constant, Region scope,
+                                                                const detail::LadderPrescan &prescan,
+                                                                std::size_t request_index)
+    {
+        return scan::decode_code_constant(
+            code_constant, scope,
+            detail::resolve_prescanned(detail::code_constant_request(code_constant, scope), prescan, request_index));
+    }
 } // namespace DetourModKit
@@ -0,0 +1,140 @@
+/**
+ * @file scan_cursor.cpp
+ * @brief The resumable page-gated scan: argument screening, the per-step slice loop, and the final verdict.
+ * @details The cursor owns a compiled copy of the pattern and the walk position. Every slice goes through
+ *          detail::scan_module_slice, which applies the serial walk's gate, fault guard, and match ownership, so the
+ *          cursor itself only sums counts, latches incompleteness, and watches the clock.
+ */
+
+#include "DetourModKit/scan_cursor.hpp"
+
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_engine.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_shared.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <utility>
+
+namespace DetourModKit
+{
+    struct scan::ScanCursor::Impl
+    {
+        detail::EnginePattern pattern;
+        detail::ModuleSpan range{};
+        Pages pages = Pages::Readable;
+        /// Matches still to pass before the requested one.
+        std::size_t remaining = 0;
+        /// Start of the next slice; range.end once the walk is exhausted.
+        std::uintptr_t next = 0;
+        bool incomplete = false;
+        std::optional<Result<Address>> verdict;
+    };
+
+    Result<scan::ScanCursor> scan::ScanCursor::start(const Pattern &pattern, Region scope, std::size_t occurrence,
+                                                     Pages pages) noexcept
+    {
+        // The same screening, in the same order, as scan::scan, so a bad argument fails identically before any read.
+        if (occurrence == 0)
+        {
+            return std::unexpected(Error{ErrorCode::NoMatch, "scan::ScanCursor::start"});
+        }
+        if (pages != Pages::Readable && pages != Pages::Executable)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::ScanCursor::start"});
+        }
+        const detail::ModuleSpan range = detail::module_span(scope);
+        if (!range.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::ScanCursor::start"});
+        }
+        try
+        {
+            auto impl = std::make_unique<Impl>();
+            impl->pattern = detail::to_engine_pattern(pattern, detail::sample_haystack(scope, pages));
+            impl->range = range;
+            impl->pages = pages;
+            impl->remaining = occurrence;
+            impl->next = range.base;
+            return ScanCursor{std::move(impl)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::ScanCursor::start"});
+        }
+    }
+
+    scan::ScanCursor::ScanCursor(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    scan::ScanCursor::ScanCursor(ScanCursor &&) noexcept = default;
+    scan::ScanCursor &scan::ScanCursor::operator=(ScanCursor &&) noexcept = default;
+    scan::ScanCursor::~ScanCursor() noexcept = default;
+
+    scan::ScanProgress scan::ScanCursor::step(std::chrono::microseconds budget) noexcept
+    {
+        if (!m_impl || m_impl->verdict)
+        {
+            return progress();
+        }
+        Impl &state = *m_impl;
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+        do
+        {
+            const detail::ScanSliceResult slice = detail::scan_module_slice(
+                state.pattern, state.range, state.pages, state.next, state.remaining, SCAN_CURSOR_SLICE_BYTES);
+            state.incomplete = state.incomplete || slice.incomplete;
+            state.next = slice.next;
+            if (slice.match != nullptr)
+            {
+                // A skipped faulted region or a truncated bounded-jump sweep earlier in the walk makes the occurrence
+                // number a lower bound, so the match is reported as a miss -- scan::scan's fail-closed rule.
+                if (state.incomplete)
+                {
+                    state.verdict = std::unexpected(Error{ErrorCode::NoMatch, "scan::ScanCursor::step"});
+                }
+                else
+                {
+                    state.verdict = Address{reinterpret_cast<std::uintptr_t>(slice.match)};
+                }
+                break;
+            }
+            state.remaining -= slice.counted;
+            if (state.next >= state.range.end)
+            {
+                state.verdict = std::unexpected(Error{ErrorCode::NoMatch, "scan::ScanCursor::step"});
+                break;
+            }
+        } while (std::chrono::steady_clock::now() < deadline);
+        return progress();
+    }
+
+    scan::ScanProgress scan::ScanCursor::progress() const noexcept
+    {
+        if (!m_impl)
+        {
+            return ScanProgress{0, 0, true};
+        }
+        const std::uintptr_t behind = m_impl->next < m_impl->range.end ? m_impl->next : m_impl->range.end;
+        return ScanProgress{static_cast<std::size_t>(behind - m_impl->range.base),
+                            static_cast<std::size_t>(m_impl->range.end - m_impl->range.base),
+                            m_impl->verdict.has_value()};
+    }
+
+    bool scan::ScanCursor::done() const noexcept
+    {
+        return !m_impl || m_impl->verdict.has_value();
+    }
+
+    std::optional<Result<Address>> scan::ScanCursor::result() const noexcept
+    {
+        if (!m_impl)
+        {
+            return Result<Address>{std::unexpected(Error{ErrorCode::InvalidArg, "scan::ScanCursor"})};
+        }
+        return m_impl->verdict;
+    }
+} // namespace DetourModKit
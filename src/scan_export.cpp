@@ -17,19 +17,35 @@
  *          [VirtualAddress, VirtualAddress + Size) window -- is the same range check the Windows loader uses to
  *          classify a forwarder, so any forwarder a module actually declares is never handed back as a code anchor to
  *          hook or read through.
+ *
+ *          Repeated lookups go through a per-module name index built on first use. The linear walk stays the
+ *          reference: the index stores only which name-table slot first carries each name and whether a second one
+ *          does, so its verdicts are the walk's, and the walk still answers when the index cannot be built.
  */
 
 #include "DetourModKit/scan.hpp"
 
+#include "internal/fnv1a.hpp"
 #include "internal/memory_guarded.hpp"
+#include "internal/srw_shared_mutex.hpp"
 
 #include <windows.h>
 
+#include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -117,167 +133,565 @@ namespace DetourModKit
                 const std::optional<char> terminator = detail::guarded_read<char>(terminator_addr);
                 return terminator && *terminator == '\0';
             }
-        } // namespace
 
-        Result<Address> resolve_export(std::string_view export_name, Region module) noexcept
-        {
-            // An empty name can never name an export entry; reject up front so the walk below never treats a
-            // zero-length compare as a spurious match against the first name in the table.
-            if (export_name.empty())
+            /**
+             * @brief Everything a name lookup needs from a module's validated headers and export directory.
+             * @details Produced by read_export_layout, which performs the fail-closed DOS -> NT -> export-directory
+             *          walk once per call; the array addresses are already bound-checked against the image.
+             */
+            struct ExportLayout
             {
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
-            }
+                detail::ModuleSpan span{};
+                IMAGE_DATA_DIRECTORY dir{};
+                std::uintptr_t names_va = 0;
+                std::uintptr_t ordinals_va = 0;
+                std::uintptr_t funcs_va = 0;
+                std::uint32_t name_count = 0;
+                std::uint32_t func_count = 0;
+                /// Header and directory identity, compared against a cached ExportIndex before it is trusted.
+                std::uint64_t fingerprint = 0;
+            };
 
-            const detail::ModuleSpan span = detail::module_span(module);
-            if (!span.valid())
+            // Hashes the fields that change when a different image lands at the same base or the export directory is
+            // rebuilt: the image size and link stamp, the directory window, and the export directory's own stamp,
+            // counts, and array RVAs.
+            [[nodiscard]] std::uint64_t layout_fingerprint(const detail::ModuleSpan &span, const IMAGE_NT_HEADERS64 &nt,
+                                                           const IMAGE_DATA_DIRECTORY &dir,
+                                                           const IMAGE_EXPORT_DIRECTORY &exports) noexcept
             {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                std::uint64_t hash = detail::FNV1A64_OFFSET;
+                hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(span.end - span.base));
+                hash = detail::fnv1a_int(hash, nt.FileHeader.TimeDateStamp);
+                hash = detail::fnv1a_int(hash, nt.OptionalHeader.CheckSum);
+                hash = detail::fnv1a_int(hash, nt.OptionalHeader.SizeOfImage);
+                hash = detail::fnv1a_int(hash, dir.VirtualAddress);
+                hash = detail::fnv1a_int(hash, dir.Size);
+                hash = detail::fnv1a_int(hash, exports.TimeDateStamp);
+                hash = detail::fnv1a_int(hash, exports.NumberOfNames);
+                hash = detail::fnv1a_int(hash, exports.NumberOfFunctions);
+                hash = detail::fnv1a_int(hash, exports.AddressOfNames);
+                hash = detail::fnv1a_int(hash, exports.AddressOfNameOrdinals);
+                return detail::fnv1a_int(hash, exports.AddressOfFunctions);
             }
-            const std::uintptr_t base = span.base;
-
-            // DOS -> NT header walk, with the same discipline as the RTTI image walk: read the DOS header, bound the NT
-            // offset inside the image, then read the 64-bit NT headers and confirm both signatures and the PE32+
-            // optional-header magic before trusting any field. The library is x64-only (an #error arch gate enforces
-            // it), so the explicit IMAGE_NT_HEADERS64 + PE32+ magic check is a defensive assertion against a
-            // wrong-bitness image, not a portability branch. The parse is kept local rather than shared with the RTTI
-            // walk: the two differ in error model (fail-closed ErrorCodes here vs a range count with a whole-module
-            // fallback there), so a shared helper would couple the two subsystems without removing real duplication.
-            const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(base);
-            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE)
-            {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
-            }
-            if (dos->e_lfanew < 0)
+
+            [[nodiscard]] Result<ExportLayout> read_export_layout(Region module) noexcept
             {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                const detail::ModuleSpan span = detail::module_span(module);
+                if (!span.valid())
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                }
+                const std::uintptr_t base = span.base;
+
+                // DOS -> NT header walk, with the same discipline as the RTTI image walk: read the DOS header, bound
+                // the NT offset inside the image, then read the 64-bit NT headers and confirm both signatures and the
+                // PE32+ optional-header magic before trusting any field. The library is x64-only (an #error arch gate
+                // enforces it), so the explicit IMAGE_NT_HEADERS64 + PE32+ magic check is a defensive assertion
+                // against a wrong-bitness image, not a portability branch. The parse is kept local rather than shared
+                // with the RTTI walk: the two differ in error model (fail-closed ErrorCodes here vs a range count with
+                // a whole-module fallback there), so a shared helper would couple the two subsystems without removing
+                // real duplication.
+                const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(base);
+                if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                }
+                if (dos->e_lfanew < 0)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                }
+                const std::optional<std::uintptr_t> nt_addr =
+                    checked_rva(span, static_cast<std::uint32_t>(dos->e_lfanew), sizeof(IMAGE_NT_HEADERS64));
+                if (!nt_addr)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                }
+                const std::optional<IMAGE_NT_HEADERS64> nt = detail::guarded_read<IMAGE_NT_HEADERS64>(*nt_addr);
+                if (!nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+                    nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                }
+
+                constexpr std::size_t export_directory_end =
+                    offsetof(IMAGE_OPTIONAL_HEADER64, DataDirectory) +
+                    (IMAGE_DIRECTORY_ENTRY_EXPORT + 1) * sizeof(IMAGE_DATA_DIRECTORY);
+                if (nt->FileHeader.SizeOfOptionalHeader < export_directory_end ||
+                    nt->OptionalHeader.NumberOfRvaAndSizes <= IMAGE_DIRECTORY_ENTRY_EXPORT)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+
+                // The export directory is data-directory entry 0. A module with no exports leaves it zeroed; that is
+                // not a fault, it simply has no name for this backend to resolve.
+                const IMAGE_DATA_DIRECTORY dir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
+                if (dir.VirtualAddress == 0 || dir.Size == 0)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+                const std::optional<std::uintptr_t> export_va = checked_rva(span, dir.VirtualAddress, dir.Size);
+                if (!export_va || dir.Size < sizeof(IMAGE_EXPORT_DIRECTORY))
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+                const std::optional<IMAGE_EXPORT_DIRECTORY> exports =
+                    detail::guarded_read<IMAGE_EXPORT_DIRECTORY>(*export_va);
+                if (!exports)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+
+                const std::uint32_t name_count = exports->NumberOfNames;
+                const std::uint32_t func_count = exports->NumberOfFunctions;
+                if (name_count == 0 || func_count == 0 || name_count > MAX_EXPORT_ENTRIES ||
+                    func_count > MAX_EXPORT_ENTRIES)
+                {
+                    // No name table to match against, or an implausibly large count from a corrupt/hostile directory.
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+
+                const std::optional<std::uintptr_t> names_va = checked_rva(
+                    span, exports->AddressOfNames, static_cast<std::uintptr_t>(name_count) * sizeof(std::uint32_t));
+                const std::optional<std::uintptr_t> ordinals_va =
+                    checked_rva(span, exports->AddressOfNameOrdinals,
+                                static_cast<std::uintptr_t>(name_count) * sizeof(std::uint16_t));
+                const std::optional<std::uintptr_t> funcs_va = checked_rva(
+                    span, exports->AddressOfFunctions, static_cast<std::uintptr_t>(func_count) * sizeof(std::uint32_t));
+                if (!names_va || !ordinals_va || !funcs_va)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+
+                return ExportLayout{
+                    .span = span,
+                    .dir = dir,
+                    .names_va = *names_va,
+                    .ordinals_va = *ordinals_va,
+                    .funcs_va = *funcs_va,
+                    .name_count = name_count,
+                    .func_count = func_count,
+                    .fingerprint = layout_fingerprint(span, *nt, dir, *exports),
+                };
             }
-            const std::optional<std::uintptr_t> nt_addr =
-                checked_rva(span, static_cast<std::uint32_t>(dos->e_lfanew), sizeof(IMAGE_NT_HEADERS64));
-            if (!nt_addr)
+
+            // The address of name-table entry @p index's string, or nullopt when its RVA is unreadable (fault) or the
+            // string starts outside the image. The two are told apart through @p faulted: the linear walk fails every
+            // query closed on an unreadable name RVA but merely skips an out-of-image one.
+            [[nodiscard]] std::optional<std::uintptr_t> name_address(const ExportLayout &layout, std::uint32_t index,
+                                                                     bool &faulted) noexcept
             {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                const std::optional<std::uint32_t> name_rva = detail::guarded_read<std::uint32_t>(
+                    layout.names_va + static_cast<std::uintptr_t>(index) * sizeof(std::uint32_t));
+                faulted = !name_rva;
+                if (!name_rva)
+                {
+                    return std::nullopt;
+                }
+                return checked_rva(layout.span, *name_rva, 1);
             }
-            const std::optional<IMAGE_NT_HEADERS64> nt = detail::guarded_read<IMAGE_NT_HEADERS64>(*nt_addr);
-            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE || nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC)
+
+            // Resolves the function behind name-table entry @p index: its ordinal, its function RVA, the forwarder
+            // test, and the in-image check, each failing closed exactly as the linear walk does for its first match.
+            [[nodiscard]] Result<Address> resolve_name_slot(const ExportLayout &layout, std::uint32_t index) noexcept
             {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve_export"});
+                // Name index maps to function index AddressOfNameOrdinals[index]. That WORD is a 0-based index into
+                // AddressOfFunctions directly (the directory's Base biases only the ORDINAL exposed to callers, not
+                // this array index), so it is used as-is after the bounds check.
+                const std::optional<std::uint16_t> ordinal = detail::guarded_read<std::uint16_t>(
+                    layout.ordinals_va + static_cast<std::uintptr_t>(index) * sizeof(std::uint16_t));
+                if (!ordinal || *ordinal >= layout.func_count)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+                const std::optional<std::uint32_t> func_rva = detail::guarded_read<std::uint32_t>(
+                    layout.funcs_va + static_cast<std::uintptr_t>(*ordinal) * sizeof(std::uint32_t));
+                if (!func_rva || *func_rva == 0)
+                {
+                    // A zero RVA in the functions array is an unused / absent slot, not a resolvable address.
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+
+                // A function RVA that points back inside the export directory region is a FORWARDER: the DWORD
+                // addresses an ASCII "TargetDll.TargetFunc" string, not code in this image. Following it would need
+                // the loader, and this [VirtualAddress, VirtualAddress + Size) window is exactly the loader's own
+                // forwarder test; fail closed so a declared forwarder is never handed back as a code anchor to hook or
+                // read through.
+                const std::uint64_t forwarder_begin = layout.dir.VirtualAddress;
+                const std::uint64_t forwarder_end = forwarder_begin + layout.dir.Size;
+                if (static_cast<std::uint64_t>(*func_rva) >= forwarder_begin &&
+                    static_cast<std::uint64_t>(*func_rva) < forwarder_end)
+                {
+                    return std::unexpected(Error{ErrorCode::ExportForwarded, "scan::resolve_export"});
+                }
+
+                const std::optional<std::uintptr_t> target = checked_rva(layout.span, *func_rva, 1);
+                if (!target)
+                {
+                    // The RVA resolved outside the mapped image: a corrupt entry, not a usable code address.
+                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                }
+                return Address{*target};
             }
 
-            constexpr std::size_t export_directory_end =
-                offsetof(IMAGE_OPTIONAL_HEADER64, DataDirectory) +
-                (IMAGE_DIRECTORY_ENTRY_EXPORT + 1) * sizeof(IMAGE_DATA_DIRECTORY);
-            if (nt->FileHeader.SizeOfOptionalHeader < export_directory_end ||
-                nt->OptionalHeader.NumberOfRvaAndSizes <= IMAGE_DIRECTORY_ENTRY_EXPORT)
+            // Linear scan of the parallel name / ordinal arrays: the reference semantics the index reproduces, and the
+            // path taken whenever the index is unavailable. The name table is spec-sorted for GetProcAddress's binary
+            // search, but a linear scan stays correct on the unsorted tables some packers emit. A duplicate matching
+            // name is rejected as an ambiguous, malformed table rather than letting array order choose a target.
+            [[nodiscard]] Result<Address> walk_exports(const ExportLayout &layout,
+                                                       std::string_view export_name) noexcept
             {
+                std::optional<Address> match;
+                for (std::uint32_t index = 0; index < layout.name_count; ++index)
+                {
+                    bool faulted = false;
+                    const std::optional<std::uintptr_t> name_va = name_address(layout, index, faulted);
+                    if (faulted)
+                    {
+                        return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                    }
+                    if (!name_va || !export_name_matches(layout.span, *name_va, export_name))
+                    {
+                        continue;
+                    }
+                    if (match)
+                    {
+                        return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                    }
+                    const Result<Address> slot = resolve_name_slot(layout, index);
+                    if (!slot)
+                    {
+                        return slot;
+                    }
+                    match = *slot;
+                }
+
+                if (match)
+                {
+                    return *match;
+                }
                 return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
             }
 
-            // The export directory is data-directory entry 0. A module with no exports leaves it zeroed; that is not a
-            // fault, it simply has no name for this backend to resolve.
-            const IMAGE_DATA_DIRECTORY dir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXPORT];
-            if (dir.VirtualAddress == 0 || dir.Size == 0)
+            /**
+             * @brief Longest export name the index records, in bytes, excluding the terminator.
+             * @details Bounds the build's per-name read on a hostile table whose strings never terminate. A name at or
+             *          past the cap is left out of the index, and a query at or past it takes the linear walk, so the
+             *          cap never changes a verdict. MSVC's decorated-name limit is 4096 bytes, but real export names
+             *          stay far below 1 KiB.
+             */
+            constexpr std::size_t EXPORT_INDEX_MAX_NAME = 1024;
+
+            // Bytes read per guarded copy while collecting a name; one copy covers nearly every real export name.
+            constexpr std::size_t EXPORT_NAME_CHUNK = 64;
+
+            /**
+             * @brief Appends the NUL-terminated name at @p name_va to @p arena.
+             * @return True when the whole name up to its terminator was readable, inside the image, and shorter than
+             *         EXPORT_INDEX_MAX_NAME. False leaves @p arena truncated back to its entry size: such a name is
+             *         one no query shorter than the cap can match, since export_name_matches reads every byte through
+             *         the terminator.
+             * @throws std::bad_alloc from the arena append.
+             */
+            [[nodiscard]] bool read_export_name(const detail::ModuleSpan &span, std::uintptr_t name_va,
+                                                std::string &arena)
             {
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                const std::size_t entry_size = arena.size();
+                std::uintptr_t cursor = name_va;
+                char chunk[EXPORT_NAME_CHUNK];
+                while (arena.size() - entry_size < EXPORT_INDEX_MAX_NAME && cursor < span.end)
+                {
+                    const std::size_t want =
+                        static_cast<std::size_t>(std::min<std::uintptr_t>(EXPORT_NAME_CHUNK, span.end - cursor));
+                    if (!detail::guarded_read_bytes(cursor, chunk, want))
+                    {
+                        // The chunk crosses an unreadable page; settle the name byte by byte up to the fault.
+                        const std::optional<char> byte = detail::guarded_read<char>(cursor);
+                        if (!byte)
+                        {
+                            break;
+                        }
+                        if (*byte == '\0')
+                        {
+                            return true;
+                        }
+                        arena.push_back(*byte);
+                        ++cursor;
+                        continue;
+                    }
+                    const std::string_view bytes{chunk, want};
+                    const std::size_t terminator = bytes.find('\0');
+                    arena.append(bytes.substr(0, terminator));
+                    if (terminator != std::string_view::npos)
+                    {
+                        if (arena.size() - entry_size < EXPORT_INDEX_MAX_NAME)
+                        {
+                            return true;
+                        }
+                        break;
+                    }
+                    cursor += want;
+                }
+                arena.resize(entry_size);
+                return false;
             }
-            const std::optional<std::uintptr_t> export_va = checked_rva(span, dir.VirtualAddress, dir.Size);
-            if (!export_va || dir.Size < sizeof(IMAGE_EXPORT_DIRECTORY))
+
+            [[nodiscard]] std::uint64_t hash_export_name(std::string_view name) noexcept
             {
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                std::uint64_t hash = detail::FNV1A64_OFFSET;
+                for (const char c : name)
+                {
+                    hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(c));
+                }
+                return hash;
             }
-            const std::optional<IMAGE_EXPORT_DIRECTORY> exports =
-                detail::guarded_read<IMAGE_EXPORT_DIRECTORY>(*export_va);
-            if (!exports)
+
+            /**
+             * @brief One module's export names in a flat open-addressing table, keyed to the name-table index.
+             * @details Built in one pass over the name table. Each distinct name keeps the index of its FIRST entry
+             *          and a duplicate flag, which is all the linear walk's verdict depends on: it resolves its first
+             *          match and fails any second one closed. Ordinals and function RVAs are not copied; a lookup
+             *          reads them live, so an EAT another mod patched resolves exactly as the walk would read it.
+             */
+            struct ExportIndex
             {
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                struct Entry
+                {
+                    std::uint32_t name_offset = 0;
+                    std::uint32_t name_size = 0;
+                    std::uint32_t name_index = 0;
+                    bool duplicate = false;
+                };
+
+                std::uint64_t fingerprint = 0;
+                /**
+                 * @brief An unreadable name RVA stopped the build.
+                 * @details The walk fails closed when it reaches that entry, unless a first match before it has
+                 *          already failed with its own error; the index holds only the entries before it and answers
+                 *          the same way.
+                 */
+                bool names_faulted = false;
+                std::string names;
+                std::vector<Entry> entries;
+                /// Entry index + 1 per slot, 0 for empty; the size is a power of two with at least half left empty.
+                std::vector<std::uint32_t> slots;
+
+                [[nodiscard]] std::string_view name_of(const Entry &entry) const noexcept
+                {
+                    return std::string_view{names}.substr(entry.name_offset, entry.name_size);
+                }
+
+                /// The slot holding @p name, or the empty slot where it would go.
+                [[nodiscard]] std::size_t probe(std::string_view name) const noexcept
+                {
+                    const std::size_t mask = slots.size() - 1;
+                    std::size_t slot = static_cast<std::size_t>(hash_export_name(name)) & mask;
+                    while (slots[slot] != 0 && name_of(entries[slots[slot] - 1]) != name)
+                    {
+                        slot = (slot + 1) & mask;
+                    }
+                    return slot;
+                }
+
+                [[nodiscard]] const Entry *find(std::string_view name) const noexcept
+                {
+                    const std::uint32_t stored = slots[probe(name)];
+                    return stored == 0 ? nullptr : &entries[stored - 1];
+                }
+            };
+
+            /**
+             * @brief Builds @p layout's index in one pass over its name table.
+             * @throws std::bad_alloc from the table allocations.
+             */
+            [[nodiscard]] std::shared_ptr<const ExportIndex> build_export_index(const ExportLayout &layout)
+            {
+                auto index = std::make_shared<ExportIndex>();
+                index->fingerprint = layout.fingerprint;
+                index->entries.reserve(layout.name_count);
+                index->slots.assign(std::bit_ceil(static_cast<std::size_t>(layout.name_count) * 2), 0);
+
+                for (std::uint32_t name_index = 0; name_index < layout.name_count; ++name_index)
+                {
+                    bool faulted = false;
+                    const std::optional<std::uintptr_t> name_va = name_address(layout, name_index, faulted);
+                    if (faulted)
+                    {
+                        index->names_faulted = true;
+                        break;
+                    }
+                    const std::size_t offset = index->names.size();
+                    if (!name_va || !read_export_name(layout.span, *name_va, index->names))
+                    {
+                        continue;
+                    }
+                    const std::string_view name = std::string_view{index->names}.substr(offset);
+                    const std::size_t slot = index->probe(name);
+                    if (index->slots[slot] != 0)
+                    {
+                        index->entries[index->slots[slot] - 1].duplicate = true;
+                        index->names.resize(offset);
+                        continue;
+                    }
+                    index->entries.push_back(ExportIndex::Entry{
+                        .name_offset = static_cast<std::uint32_t>(offset),
+                        .name_size = static_cast<std::uint32_t>(name.size()),
+                        .name_index = name_index,
+                    });
+                    index->slots[slot] = static_cast<std::uint32_t>(index->entries.size());
+                }
+                return index;
             }
 
-            const std::uint32_t name_count = exports->NumberOfNames;
-            const std::uint32_t func_count = exports->NumberOfFunctions;
-            if (name_count == 0 || func_count == 0 || name_count > MAX_EXPORT_ENTRIES ||
-                func_count > MAX_EXPORT_ENTRIES)
+            /**
+             * @struct ExportIndexCache
+             * @brief Per-process map from a module base to its export index.
+             * @details An entry is trusted only while its fingerprint matches the headers read on the current call, so
+             *          a module that unloads stops using it at once (its header reads fail, and the entry is dropped)
+             *          and a different image mapped at the same base rebuilds it. Loader unload notifications are not
+             *          hooked, for the reason ModuleRangeCache gives in memory_module.cpp.
+             */
+            struct ExportIndexCache
             {
-                // No name table to match against, or an implausibly large count from a corrupt/hostile directory.
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                detail::SrwSharedMutex mutex;
+                std::unordered_map<std::uintptr_t, std::shared_ptr<const ExportIndex>> entries;
+            };
+
+            [[nodiscard]] ExportIndexCache &export_index_cache() noexcept
+            {
+                static ExportIndexCache cache;
+                return cache;
             }
 
-            const std::optional<std::uintptr_t> names_va = checked_rva(
-                span, exports->AddressOfNames, static_cast<std::uintptr_t>(name_count) * sizeof(std::uint32_t));
-            const std::optional<std::uintptr_t> ordinals_va = checked_rva(
-                span, exports->AddressOfNameOrdinals, static_cast<std::uintptr_t>(name_count) * sizeof(std::uint16_t));
-            const std::optional<std::uintptr_t> funcs_va = checked_rva(
-                span, exports->AddressOfFunctions, static_cast<std::uintptr_t>(func_count) * sizeof(std::uint32_t));
-            if (!names_va || !ordinals_va || !funcs_va)
+            void forget_export_index(std::uintptr_t base) noexcept
             {
-                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                ExportIndexCache &cache = export_index_cache();
+                std::unique_lock<detail::SrwSharedMutex> lock(cache.mutex);
+                cache.entries.erase(base);
             }
 
-            // Linear scan the parallel name / ordinal arrays. The name table is spec-sorted for GetProcAddress's binary
-            // search, but a linear scan is chosen deliberately: it is O(exports) at setup time (never a hot path) and
-            // stays correct on the unsorted tables some packers emit. A duplicate matching name is rejected as an
-            // ambiguous, malformed table rather than letting array order choose a target.
-            std::optional<Address> match;
-            for (std::uint32_t index = 0; index < name_count; ++index)
+            /// The current index for @p layout, building and publishing it on a miss; nullptr under memory pressure.
+            [[nodiscard]] std::shared_ptr<const ExportIndex> export_index_for(const ExportLayout &layout) noexcept
             {
-                const std::optional<std::uint32_t> name_rva = detail::guarded_read<std::uint32_t>(
-                    *names_va + static_cast<std::uintptr_t>(index) * sizeof(std::uint32_t));
-                if (!name_rva)
+                ExportIndexCache &cache = export_index_cache();
                 {
-                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                    std::shared_lock<detail::SrwSharedMutex> lock(cache.mutex);
+                    const auto it = cache.entries.find(layout.span.base);
+                    if (it != cache.entries.end() && it->second->fingerprint == layout.fingerprint)
+                    {
+                        return it->second;
+                    }
                 }
-                const std::optional<std::uintptr_t> name_va = checked_rva(span, *name_rva, 1);
-                if (!name_va || !export_name_matches(span, *name_va, export_name))
+
+                try
                 {
-                    continue;
+                    std::shared_ptr<const ExportIndex> built = build_export_index(layout);
+                    std::unique_lock<detail::SrwSharedMutex> lock(cache.mutex);
+                    auto &slot = cache.entries[layout.span.base];
+                    if (slot && slot->fingerprint == layout.fingerprint)
+                    {
+                        // Another thread published the same index first; keep it.
+                        return slot;
+                    }
+                    slot = built;
+                    return built;
                 }
-                if (match)
+                catch (const std::bad_alloc &)
                 {
-                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                    // The index is an accelerator; the caller falls back to the linear walk.
+                    return nullptr;
                 }
+            }
 
-                // Name index maps to function index AddressOfNameOrdinals[index]. That WORD is a 0-based index into
-                // AddressOfFunctions directly (the directory's Base biases only the ORDINAL exposed to callers, not
-                // this array index), so it is used as-is after the bounds check.
-                const std::optional<std::uint16_t> ordinal = detail::guarded_read<std::uint16_t>(
-                    *ordinals_va + static_cast<std::uintptr_t>(index) * sizeof(std::uint16_t));
-                if (!ordinal || *ordinal >= func_count)
+            /**
+             * @brief Resolves @p export_name through the module's index, with the linear walk's exact verdict.
+             * @details A hit is re-verified against the live name table before it is used, so an index that has gone
+             *          stale under an unchanged fingerprint is dropped and the walk answers instead.
+             */
+            [[nodiscard]] Result<Address> lookup_export(const ExportLayout &layout,
+                                                        std::string_view export_name) noexcept
+            {
+                if (export_name.size() >= EXPORT_INDEX_MAX_NAME)
                 {
-                    return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+                    return walk_exports(layout, export_name);
                 }
-                const std::optional<std::uint32_t> func_rva = detail::guarded_read<std::uint32_t>(
-                    *funcs_va + static_cast<std::uintptr_t>(*ordinal) * sizeof(std::uint32_t));
-                if (!func_rva || *func_rva == 0)
+                const std::shared_ptr<const ExportIndex> index = export_index_for(layout);
+                if (!index)
+                {
+                    return walk_exports(layout, export_name);
+                }
+                const ExportIndex::Entry *entry = index->find(export_name);
+                if (entry == nullptr)
                 {
-                    // A zero RVA in the functions array is an unused / absent slot, not a resolvable address.
                     return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
                 }
 
-                // A function RVA that points back inside the export directory region is a FORWARDER: the DWORD
-                // addresses an ASCII "TargetDll.TargetFunc" string, not code in this image. Following it would need the
-                // loader, and this [VirtualAddress, VirtualAddress + Size) window is exactly the loader's own forwarder
-                // test; fail closed so a declared forwarder is never handed back as a code anchor to hook or read
-                // through.
-                const std::uint64_t forwarder_begin = dir.VirtualAddress;
-                const std::uint64_t forwarder_end = forwarder_begin + dir.Size;
-                if (static_cast<std::uint64_t>(*func_rva) >= forwarder_begin &&
-                    static_cast<std::uint64_t>(*func_rva) < forwarder_end)
+                bool faulted = false;
+                const std::optional<std::uintptr_t> name_va = name_address(layout, entry->name_index, faulted);
+                if (faulted || !name_va || !export_name_matches(layout.span, *name_va, export_name))
                 {
-                    return std::unexpected(Error{ErrorCode::ExportForwarded, "scan::resolve_export"});
+                    forget_export_index(layout.span.base);
+                    return walk_exports(layout, export_name);
                 }
-
-                const std::optional<std::uintptr_t> target = checked_rva(span, *func_rva, 1);
-                if (!target)
+                const Result<Address> slot = resolve_name_slot(layout, entry->name_index);
+                if (slot && (entry->duplicate || index->names_faulted))
                 {
-                    // The RVA resolved outside the mapped image: a corrupt entry, not a usable code address.
                     return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
                 }
-                match = Address{*target};
+                return slot;
             }
+        } // namespace
 
-            if (match)
+        Result<Address> resolve_export(std::string_view export_name, Region module) noexcept
+        {
+            // An empty name can never name an export entry; reject up front so the walk below never treats a
+            // zero-length compare as a spurious match against the first name in the table.
+            if (export_name.empty())
+            {
+                return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+            }
+
+            const Result<ExportLayout> layout = read_export_layout(module);
+            if (!layout)
             {
-                return *match;
+                if (layout.error().code == ErrorCode::InvalidRange && module.base)
+                {
+                    // The image is gone or no longer parses; its index, if any, describes nothing now.
+                    forget_export_index(module.base.raw());
+                }
+                return std::unexpected(layout.error());
+            }
+            return lookup_export(*layout, export_name);
+        }
+
+        Result<std::vector<Result<Address>>> resolve_exports(std::span<const std::string_view> export_names,
+                                                             Region module) noexcept
+        {
+            std::vector<Result<Address>> results;
+            try
+            {
+                results.assign(export_names.size(), Result<Address>{std::unexpected(
+                                                        Error{ErrorCode::ExportNotFound, "scan::resolve_export"})});
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_exports"});
+            }
+            if (export_names.empty())
+            {
+                return results;
+            }
+
+            const Result<ExportLayout> layout = read_export_layout(module);
+            for (std::size_t i = 0; i < export_names.size(); ++i)
+            {
+                if (export_names[i].empty())
+                {
+                    continue; // Seeded ExportNotFound, as resolve_export answers an empty name.
+                }
+                results[i] = layout ? lookup_export(*layout, export_names[i])
+                                    : Result<Address>{std::unexpected(layout.error())};
             }
-            return std::unexpected(Error{ErrorCode::ExportNotFound, "scan::resolve_export"});
+            return results;
         }
     } // namespace scan
 } // namespace DetourModKit
@@ -0,0 +1,316 @@
+/**
+ * @file scan_function_table.cpp
+ * @brief The per-module function-boundary index behind scan::function_containing and the string-xref
+ *        enclosing-function lookup.
+ * @details Every x64 function that touches the stack or calls another function registers a RUNTIME_FUNCTION in its
+ *          image's exception directory, so .pdata is an exact map of where functions begin and end. Asking the OS one
+ *          address at a time (RtlLookupFunctionEntry, then a guarded walk of each chained UNWIND_INFO back to the
+ *          primary function) repeats the same walk for every query. The index here does that walk once per image: it
+ *          copies the directory under a fault guard, folds every funclet and hot/cold-split fragment to the entry of
+ *          the primary function its unwind chain ends at, and keeps the ranges sorted by start RVA. A lookup is then
+ *          a header re-read, to confirm the index still describes the image at that base, and a binary search.
+ *
+ *          A range whose chain cannot be walked (an unreadable .xdata page, a chain longer than the hop bound) is left
+ *          out rather than guessed at, so a lookup there reports no range, exactly as the per-query walk gave up on it.
+ */
+
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "internal/fnv1a.hpp"
+#include "internal/function_table.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/srw_shared_mutex.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <optional>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // Upper bound on the RUNTIME_FUNCTION count one index holds. The largest retail executables register a few
+        // hundred thousand; the cap only stops a corrupt directory size from driving a multi-gigabyte copy.
+        constexpr std::size_t MAX_FUNCTION_ENTRIES = std::size_t{1} << 22;
+
+        // Hops allowed along one unwind chain; a real chain is one or two deep, so this only bounds a malformed,
+        // self-referential one.
+        constexpr int MAX_CHAIN_HOPS = 16;
+
+        // Where an image's exception directory lies, plus the identity a cached index is checked against.
+        struct ExceptionLayout
+        {
+            std::uintptr_t base = 0;
+            std::uint32_t size_of_image = 0;
+            IMAGE_DATA_DIRECTORY dir{};
+            std::uint64_t fingerprint = 0;
+        };
+
+        // Reads @p module's headers; nullopt when they do not validate as PE32+ or carry no in-image exception
+        // directory.
+        [[nodiscard]] std::optional<ExceptionLayout> read_exception_layout(Region module) noexcept
+        {
+            const detail::ModuleSpan span = detail::module_span(module);
+            if (!span.valid())
+            {
+                return std::nullopt;
+            }
+            const std::optional<IMAGE_DOS_HEADER> dos = detail::guarded_read<IMAGE_DOS_HEADER>(span.base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE || dos->e_lfanew < 0 ||
+                static_cast<std::uintptr_t>(dos->e_lfanew) > span.end - span.base - sizeof(IMAGE_NT_HEADERS64))
+            {
+                return std::nullopt;
+            }
+            const std::optional<IMAGE_NT_HEADERS64> nt =
+                detail::guarded_read<IMAGE_NT_HEADERS64>(span.base + static_cast<std::uintptr_t>(dos->e_lfanew));
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE ||
+                nt->OptionalHeader.Magic != IMAGE_NT_OPTIONAL_HDR64_MAGIC ||
+                nt->OptionalHeader.NumberOfRvaAndSizes <= IMAGE_DIRECTORY_ENTRY_EXCEPTION)
+            {
+                return std::nullopt;
+            }
+            const IMAGE_DATA_DIRECTORY dir = nt->OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_EXCEPTION];
+            const std::uint64_t image_size = span.end - span.base;
+            if (dir.VirtualAddress == 0 || dir.Size < sizeof(RUNTIME_FUNCTION) ||
+                std::uint64_t{dir.VirtualAddress} + dir.Size > image_size)
+            {
+                return std::nullopt;
+            }
+
+            std::uint64_t hash = detail::FNV1A64_OFFSET;
+            hash = detail::fnv1a_int(hash, image_size);
+            hash = detail::fnv1a_int(hash, nt->FileHeader.TimeDateStamp);
+            hash = detail::fnv1a_int(hash, nt->OptionalHeader.CheckSum);
+            hash = detail::fnv1a_int(hash, nt->OptionalHeader.SizeOfImage);
+            hash = detail::fnv1a_int(hash, dir.VirtualAddress);
+            hash = detail::fnv1a_int(hash, dir.Size);
+            return ExceptionLayout{.base = span.base,
+                                   .size_of_image = static_cast<std::uint32_t>(std::min<std::uint64_t>(
+                                       image_size, nt->OptionalHeader.SizeOfImage)),
+                                   .dir = dir,
+                                   .fingerprint = hash};
+        }
+
+        // The begin RVA of the primary function @p record's unwind chain ends at, or nullopt when the chain cannot be
+        // read. A funclet or split fragment sets UNW_FLAG_CHAININFO, and its chained RUNTIME_FUNCTION follows the
+        // unwind-code array, padded to an even count, at UnwindData + 4 + 2 * ((CountOfCodes + 1) & ~1).
+        [[nodiscard]] std::optional<std::uint32_t> primary_begin(std::uintptr_t base, RUNTIME_FUNCTION record) noexcept
+        {
+            for (int hop = 0; hop < MAX_CHAIN_HOPS; ++hop)
+            {
+                std::uint8_t unwind_header[4] = {};
+                if (!detail::guarded_read_bytes(base + record.UnwindData, unwind_header, sizeof(unwind_header)))
+                {
+                    return std::nullopt;
+                }
+                if (((unwind_header[0] >> 3) & UNW_FLAG_CHAININFO) == 0)
+                {
+                    return record.BeginAddress;
+                }
+                const std::uint32_t count_of_codes = unwind_header[2];
+                const std::uint32_t chained_rva = record.UnwindData + 4u + 2u * ((count_of_codes + 1u) & ~1u);
+                if (!detail::guarded_read_bytes(base + chained_rva, &record, sizeof(record)))
+                {
+                    return std::nullopt;
+                }
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @struct FunctionIndex
+         * @brief One image's registered function ranges, sorted by start, with every range's primary entry folded in.
+         * @details Three parallel RVA arrays rather than an array of records, so the binary search touches only the
+         *          start column.
+         */
+        struct FunctionIndex
+        {
+            std::uint64_t fingerprint = 0;
+            std::vector<std::uint32_t> begins;
+            std::vector<std::uint32_t> ends;
+            std::vector<std::uint32_t> entries;
+        };
+
+        [[nodiscard]] std::shared_ptr<const FunctionIndex> build_function_index(const ExceptionLayout &layout)
+        {
+            const std::size_t count =
+                std::min<std::size_t>(layout.dir.Size / sizeof(RUNTIME_FUNCTION), MAX_FUNCTION_ENTRIES);
+            std::vector<RUNTIME_FUNCTION> records(count);
+            if (!detail::guarded_read_bytes(layout.base + layout.dir.VirtualAddress, records.data(),
+                                            count * sizeof(RUNTIME_FUNCTION)))
+            {
+                return nullptr;
+            }
+
+            // The linker emits .pdata sorted by BeginAddress, but a hand-built or patched image need not be, so sort a
+            // permutation when it is not.
+            std::vector<std::uint32_t> order(count);
+            std::iota(order.begin(), order.end(), 0u);
+            const auto by_begin = [&records](std::uint32_t a, std::uint32_t b)
+            { return records[a].BeginAddress < records[b].BeginAddress; };
+            if (!std::is_sorted(order.begin(), order.end(), by_begin))
+            {
+                std::sort(order.begin(), order.end(), by_begin);
+            }
+
+            auto index = std::make_shared<FunctionIndex>();
+            index->fingerprint = layout.fingerprint;
+            index->begins.reserve(count);
+            index->ends.reserve(count);
+            index->entries.reserve(count);
+            for (const std::uint32_t i : order)
+            {
+                const RUNTIME_FUNCTION &record = records[i];
+                if (record.BeginAddress >= record.EndAddress || record.EndAddress > layout.size_of_image)
+                {
+                    continue;
+                }
+                const std::optional<std::uint32_t> entry = primary_begin(layout.base, record);
+                if (!entry)
+                {
+                    continue;
+                }
+                index->begins.push_back(record.BeginAddress);
+                index->ends.push_back(record.EndAddress);
+                index->entries.push_back(*entry);
+            }
+            return index;
+        }
+
+        /**
+         * @struct FunctionIndexCache
+         * @brief Per-process map from an image base to its function index.
+         * @details Trusted only while the fingerprint matches the headers read on the current lookup, the same rule
+         *          the export index follows, so an image that unloads or is replaced at the same base never answers
+         *          from a stale index.
+         */
+        struct FunctionIndexCache
+        {
+            detail::SrwSharedMutex mutex;
+            std::unordered_map<std::uintptr_t, std::shared_ptr<const FunctionIndex>> entries;
+        };
+
+        [[nodiscard]] FunctionIndexCache &function_index_cache() noexcept
+        {
+            static FunctionIndexCache cache;
+            return cache;
+        }
+
+        [[nodiscard]] std::shared_ptr<const FunctionIndex> function_index_for(const ExceptionLayout &layout) noexcept
+        {
+            FunctionIndexCache &cache = function_index_cache();
+            {
+                std::shared_lock<detail::SrwSharedMutex> lock(cache.mutex);
+                const auto it = cache.entries.find(layout.base);
+                if (it != cache.entries.end() && it->second->fingerprint == layout.fingerprint)
+                {
+                    return it->second;
+                }
+            }
+
+            try
+            {
+                std::shared_ptr<const FunctionIndex> built = build_function_index(layout);
+                if (!built)
+                {
+                    return nullptr;
+                }
+                std::unique_lock<detail::SrwSharedMutex> lock(cache.mutex);
+                auto &slot = cache.entries[layout.base];
+                if (slot && slot->fingerprint == layout.fingerprint)
+                {
+                    // Another thread published the same index first; keep it.
+                    return slot;
+                }
+                slot = built;
+                return built;
+            }
+            catch (const std::bad_alloc &)
+            {
+                // The index is an accelerator; the caller falls back to asking the OS.
+                return nullptr;
+            }
+        }
+
+        // Index of the last range starting at or before @p rva. The halving step is a conditional move rather than a
+        // branch, so the search costs log2(n) dependent loads and no mispredictions.
+        [[nodiscard]] std::size_t last_begin_at_or_before(const std::vector<std::uint32_t> &begins,
+                                                          std::uint32_t rva) noexcept
+        {
+            std::size_t lo = 0;
+            std::size_t n = begins.size();
+            while (n > 1)
+            {
+                const std::size_t half = n / 2;
+                lo = begins[lo + half] <= rva ? lo + half : lo;
+                n -= half;
+            }
+            return lo;
+        }
+    } // namespace
+
+    detail::FunctionLookup detail::lookup_function(std::uintptr_t address, FunctionRange &out) noexcept
+    {
+        const Region image = memory::module_of(Address{address});
+        const std::optional<ExceptionLayout> layout = read_exception_layout(image);
+        if (!layout)
+        {
+            return FunctionLookup::NoTable;
+        }
+        const std::shared_ptr<const FunctionIndex> index = function_index_for(*layout);
+        if (!index)
+        {
+            return FunctionLookup::NoTable;
+        }
+        const std::uintptr_t rva_wide = address - layout->base;
+        if (index->begins.empty() || rva_wide > UINT32_MAX)
+        {
+            return FunctionLookup::NotInTable;
+        }
+        const auto rva = static_cast<std::uint32_t>(rva_wide);
+        const std::size_t slot = last_begin_at_or_before(index->begins, rva);
+        if (index->begins[slot] > rva || rva >= index->ends[slot])
+        {
+            return FunctionLookup::NotInTable;
+        }
+        out = FunctionRange{.entry = layout->base + index->entries[slot],
+                            .begin = layout->base + index->begins[slot],
+                            .end = layout->base + index->ends[slot]};
+        return FunctionLookup::Found;
+    }
+
+    namespace scan
+    {
+        Result<FunctionBounds> function_containing(Address address) noexcept
+        {
+            if (!address)
+            {
+                return std::unexpected(Error{ErrorCode::NullInput, "scan::function_containing"});
+            }
+            detail::FunctionRange range;
+            switch (detail::lookup_function(address.raw(), range))
+            {
+            case detail::FunctionLookup::Found:
+                return FunctionBounds{.entry = Address{range.entry},
+                                      .begin = Address{range.begin},
+                                      .end = Address{range.end}};
+            case detail::FunctionLookup::NotInTable:
+                return std::unexpected(Error{ErrorCode::FunctionNotFound, "scan::function_containing", address.raw()});
+            case detail::FunctionLookup::NoTable:
+                break;
+            }
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::function_containing", address.raw()});
+        }
+    } // namespace scan
+} // namespace DetourModKit
@@ -0,0 +1,531 @@
+/**
+ * @file scan_index.cpp
+ * @brief scan::CodeIndex: the sharded 4-gram posting lists, their parallel build, and the intersecting query.
+ * @details A shard copies its slice of the image under the fault guard, then packs every position into a 64-bit key
+ *          (gram << 32 | offset) and sorts the keys. Equal grams become one directory entry, and their positions,
+ *          already ascending, are stored as LEB128 deltas. The shards are built on the fork-join pool.
+ *
+ *          A query picks, across all shards, the two grams of the pattern with the fewest posting bytes. The first
+ *          list supplies candidate sites; the second, walked in step, drops the candidates whose second gram is
+ *          missing. A site belongs to the shard that holds its first gram, so each site is produced once, and sites
+ *          come out in ascending order because shards and lists are both ascending. Every survivor is compared
+ *          against live memory before it is reported.
+ */
+
+#include "DetourModKit/scan_index.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+
+#include "fork_join.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        constexpr std::size_t GRAM_BYTES = 4;
+
+        struct ShardSpan
+        {
+            // Gram starts [base, base + bytes) belong to this shard.
+            std::uintptr_t base = 0;
+            std::size_t bytes = 0;
+            // The contiguous readable run the shard sits in; no site crosses its ends.
+            std::uintptr_t run_base = 0;
+            std::uintptr_t run_end = 0;
+        };
+
+        struct Shard
+        {
+            ShardSpan span;
+            // Sorted distinct grams; gram g's posting list is postings[list_begin[g]] .. postings[list_begin[g + 1]].
+            std::vector<std::uint32_t> grams;
+            std::vector<std::uint32_t> list_begin;
+            std::vector<std::uint8_t> postings;
+            std::size_t positions = 0;
+            // The slice could not be copied; queries fall back to a live scan of it.
+            bool failed = false;
+
+            [[nodiscard]] std::size_t resident_bytes() const noexcept
+            {
+                return grams.capacity() * sizeof(std::uint32_t) + list_begin.capacity() * sizeof(std::uint32_t) +
+                       postings.capacity();
+            }
+        };
+
+        struct PostingList
+        {
+            const std::uint8_t *begin = nullptr;
+            const std::uint8_t *end = nullptr;
+
+            [[nodiscard]] std::size_t size_bytes() const noexcept { return static_cast<std::size_t>(end - begin); }
+        };
+
+        // Walks one delta-encoded list in ascending order.
+        class PostingCursor
+        {
+        public:
+            explicit PostingCursor(PostingList list) noexcept : m_next(list.begin), m_end(list.end) {}
+
+            [[nodiscard]] bool next(std::uint32_t &position) noexcept
+            {
+                if (m_next == m_end)
+                {
+                    return false;
+                }
+                std::uint32_t delta = 0;
+                for (unsigned shift = 0; m_next != m_end; shift += 7)
+                {
+                    const std::uint8_t byte = *m_next++;
+                    delta |= static_cast<std::uint32_t>(byte & 0x7Fu) << shift;
+                    if ((byte & 0x80u) == 0)
+                    {
+                        break;
+                    }
+                }
+                m_value += delta;
+                position = m_value;
+                return true;
+            }
+
+        private:
+            const std::uint8_t *m_next;
+            const std::uint8_t *m_end;
+            std::uint32_t m_value = 0;
+        };
+
+        void append_varint(std::vector<std::uint8_t> &out, std::uint32_t value)
+        {
+            while (value >= 0x80u)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80u));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        [[nodiscard]] PostingList find_list(const Shard &shard, std::uint32_t gram) noexcept
+        {
+            const auto found = std::lower_bound(shard.grams.begin(), shard.grams.end(), gram);
+            if (found == shard.grams.end() || *found != gram)
+            {
+                return PostingList{};
+            }
+            const auto index = static_cast<std::size_t>(found - shard.grams.begin());
+            return PostingList{shard.postings.data() + shard.list_begin[index],
+                               shard.postings.data() + shard.list_begin[index + 1]};
+        }
+
+        // Copies the slice (plus the three bytes the last gram reads past it), then sorts and encodes its grams.
+        [[nodiscard]] Shard build_shard(const ShardSpan &span)
+        {
+            Shard shard;
+            shard.span = span;
+            const std::size_t readable =
+                std::min<std::size_t>(span.run_end - span.base, span.bytes + GRAM_BYTES - 1);
+            if (readable < GRAM_BYTES)
+            {
+                return shard;
+            }
+            auto copy = std::make_unique_for_overwrite<std::uint8_t[]>(readable);
+            if (!detail::guarded_read_bytes(span.base, copy.get(), readable))
+            {
+                shard.failed = true;
+                return shard;
+            }
+
+            const std::size_t count = std::min(span.bytes, readable - GRAM_BYTES + 1);
+            std::vector<std::uint64_t> keys(count);
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::uint32_t gram;
+                std::memcpy(&gram, copy.get() + i, sizeof(gram));
+                keys[i] = (static_cast<std::uint64_t>(gram) << 32) | i;
+            }
+            copy.reset();
+            std::sort(keys.begin(), keys.end());
+
+            shard.positions = count;
+            shard.postings.reserve(count + count / 2);
+            std::uint32_t previous = 0;
+            for (const std::uint64_t key : keys)
+            {
+                const auto gram = static_cast<std::uint32_t>(key >> 32);
+                const auto position = static_cast<std::uint32_t>(key);
+                if (shard.grams.empty() || shard.grams.back() != gram)
+                {
+                    shard.grams.push_back(gram);
+                    shard.list_begin.push_back(static_cast<std::uint32_t>(shard.postings.size()));
+                    previous = 0;
+                }
+                append_varint(shard.postings, position - previous);
+                previous = position;
+            }
+            shard.list_begin.push_back(static_cast<std::uint32_t>(shard.postings.size()));
+            shard.grams.shrink_to_fit();
+            shard.list_begin.shrink_to_fit();
+            shard.postings.shrink_to_fit();
+            return shard;
+        }
+
+        // The scope's windows of the page class, merged where they touch, cut into shards in ascending order.
+        [[nodiscard]] std::vector<ShardSpan> collect_shards(detail::ModuleSpan range, scan::Pages pages)
+        {
+            std::vector<detail::ModuleSpan> runs;
+            for (const detail::ExecutableWindow &window : detail::collect_page_windows(range, pages))
+            {
+                const std::uintptr_t end = window.base + window.span;
+                if (!runs.empty() && runs.back().end == window.base)
+                {
+                    runs.back().end = end;
+                    continue;
+                }
+                runs.push_back(detail::ModuleSpan{window.base, end});
+            }
+
+            std::vector<ShardSpan> shards;
+            for (const detail::ModuleSpan &run : runs)
+            {
+                for (std::uintptr_t lo = run.base; lo < run.end; lo += scan::CODE_INDEX_SHARD_BYTES)
+                {
+                    const std::size_t bytes = std::min<std::size_t>(run.end - lo, scan::CODE_INDEX_SHARD_BYTES);
+                    shards.push_back(ShardSpan{lo, bytes, run.base, run.end});
+                }
+            }
+            return shards;
+        }
+
+        // The pattern's 4-grams of fully-known bytes, by position. Only jump-free patterns are narrowed: a gap would
+        // make the distance between two grams vary.
+        struct GramWindow
+        {
+            std::size_t index = 0;
+            std::uint32_t gram = 0;
+            std::size_t cost = 0;
+        };
+
+        struct GramPlan
+        {
+            std::array<GramWindow, detail::MAX_PATTERN_BYTES> windows{};
+            std::size_t count = 0;
+        };
+
+        [[nodiscard]] GramPlan plan_grams(const detail::PatternBuffer &buffer) noexcept
+        {
+            GramPlan plan;
+            if (buffer.jump_count != 0 || buffer.length < GRAM_BYTES)
+            {
+                return plan;
+            }
+            std::size_t run = 0;
+            for (std::size_t i = 0; i < buffer.length; ++i)
+            {
+                run = buffer.mask[i] == std::byte{0xFF} ? run + 1 : 0;
+                if (run >= GRAM_BYTES)
+                {
+                    GramWindow &window = plan.windows[plan.count++];
+                    window.index = i + 1 - GRAM_BYTES;
+                    std::memcpy(&window.gram, buffer.bytes.data() + window.index, sizeof(window.gram));
+                }
+            }
+            return plan;
+        }
+
+        struct QueryOutcome
+        {
+            bool faulted = false;
+            bool stopped = false;
+        };
+    } // namespace
+
+    struct scan::CodeIndex::Impl
+    {
+        Region scope{};
+        Pages pages = Pages::Executable;
+        std::vector<Shard> shards;
+        CodeIndexStats stats{};
+
+        // Calls visit(site) for every live match of an accelerated pattern, in ascending order, until it returns
+        // false. Sites are the pattern's first byte, before the `|` offset.
+        template <typename Visit>
+        [[nodiscard]] QueryOutcome for_each_site(const Pattern &pattern, GramPlan plan, Visit &&visit) const
+        {
+            const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+            const std::size_t length = buffer.length;
+
+            // Cost each gram by its posting bytes over every shard, then take the cheapest two.
+            for (std::size_t w = 0; w < plan.count; ++w)
+            {
+                for (const Shard &shard : shards)
+                {
+                    plan.windows[w].cost += find_list(shard, plan.windows[w].gram).size_bytes();
+                }
+            }
+            std::sort(plan.windows.begin(), plan.windows.begin() + static_cast<std::ptrdiff_t>(plan.count),
+                      [](const GramWindow &lhs, const GramWindow &rhs) { return lhs.cost < rhs.cost; });
+            const GramWindow &primary = plan.windows[0];
+            const bool filtered = plan.count > 1;
+            const GramWindow &secondary = plan.windows[filtered ? 1 : 0];
+
+            QueryOutcome outcome;
+            std::array<std::byte, detail::MAX_PATTERN_BYTES> live{};
+            const auto consider = [&](std::uintptr_t site) -> bool
+            {
+                if (!detail::guarded_read_bytes(site, live.data(), length))
+                {
+                    outcome.faulted = true;
+                    return true;
+                }
+                if (!pattern.matches_at(std::span<const std::byte>(live.data(), length)))
+                {
+                    return true;
+                }
+                return visit(site);
+            };
+
+            for (const Shard &shard : shards)
+            {
+                const ShardSpan &span = shard.span;
+                if (shard.failed)
+                {
+                    // Sites whose primary gram lies in this shard, found by a live scan of just that reach.
+                    const std::uintptr_t lo = std::max(span.run_base, span.base - std::min(span.base, primary.index));
+                    const std::uintptr_t hi = std::min(span.run_end, span.base + span.bytes - primary.index + length);
+                    if (hi <= lo || hi - lo < length)
+                    {
+                        continue;
+                    }
+                    bool stop = false;
+                    const Result<MatchSummary> walked = scan::for_each_match(
+                        pattern, Region{Address{lo}, hi - lo},
+                        [&](Address match)
+                        {
+                            const std::uintptr_t site = match.raw() - buffer.offset;
+                            const std::uintptr_t key = site + primary.index;
+                            if (key < span.base || key >= span.base + span.bytes)
+                            {
+                                return true;
+                            }
+                            stop = !visit(site);
+                            return !stop;
+                        },
+                        pages);
+                    outcome.faulted = outcome.faulted || !walked || walked->faulted;
+                    if (stop)
+                    {
+                        outcome.stopped = true;
+                        return outcome;
+                    }
+                    continue;
+                }
+
+                const PostingList first = find_list(shard, primary.gram);
+                if (first.begin == first.end)
+                {
+                    continue;
+                }
+                PostingCursor candidates{first};
+                PostingCursor filter{find_list(shard, secondary.gram)};
+                std::uint32_t filter_at = 0;
+                bool filter_live = filtered && filter.next(filter_at);
+                std::uint32_t position = 0;
+                while (candidates.next(position))
+                {
+                    const std::uintptr_t key = span.base + position;
+                    if (key - span.run_base < primary.index)
+                    {
+                        continue;
+                    }
+                    const std::uintptr_t site = key - primary.index;
+                    if (span.run_end - site < length)
+                    {
+                        break;
+                    }
+                    if (filtered)
+                    {
+                        const std::uintptr_t second = site + secondary.index;
+                        if (second >= span.base && second < span.base + span.bytes)
+                        {
+                            const auto wanted = static_cast<std::uint32_t>(second - span.base);
+                            while (filter_live && filter_at < wanted)
+                            {
+                                filter_live = filter.next(filter_at);
+                            }
+                            if (!filter_live || filter_at != wanted)
+                            {
+                                continue;
+                            }
+                        }
+                    }
+                    if (!consider(site))
+                    {
+                        outcome.stopped = true;
+                        return outcome;
+                    }
+                }
+            }
+            return outcome;
+        }
+    };
+
+    scan::CodeIndex::CodeIndex(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    scan::CodeIndex::CodeIndex(CodeIndex &&) noexcept = default;
+    scan::CodeIndex &scan::CodeIndex::operator=(CodeIndex &&) noexcept = default;
+    scan::CodeIndex::~CodeIndex() noexcept = default;
+
+    Result<scan::CodeIndex> scan::CodeIndex::build(Region scope, const CodeIndexOptions &options) noexcept
+    {
+        if (options.pages != Pages::Readable && options.pages != Pages::Executable)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::CodeIndex::build"});
+        }
+        const detail::ModuleSpan range = detail::module_span(scope);
+        if (!range.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::CodeIndex::build"});
+        }
+        try
+        {
+            auto impl = std::make_unique<Impl>();
+            impl->scope = scope;
+            impl->pages = options.pages;
+            const std::vector<ShardSpan> spans = collect_shards(range, options.pages);
+            const std::size_t workers = detail::in_fork_join_worker() ? 1 : options.max_workers;
+            impl->shards = detail::run_fork_join<ShardSpan, Shard>(
+                spans, workers, [](const ShardSpan &span) { return build_shard(span); },
+                [](const ShardSpan &span) noexcept
+                {
+                    Shard shard;
+                    shard.span = span;
+                    shard.failed = true;
+                    return shard;
+                });
+
+            CodeIndexStats &stats = impl->stats;
+            stats.shards = impl->shards.size();
+            stats.resident_bytes = impl->shards.capacity() * sizeof(Shard);
+            for (const Shard &shard : impl->shards)
+            {
+                stats.indexed_bytes += shard.failed ? 0 : shard.span.bytes;
+                stats.grams += shard.grams.size();
+                stats.postings += shard.positions;
+                stats.resident_bytes += shard.resident_bytes();
+                stats.complete = stats.complete && !shard.failed;
+            }
+            if (options.memory_budget != 0 && stats.resident_bytes > options.memory_budget)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::CodeIndex::build", stats.resident_bytes});
+            }
+            return CodeIndex{std::move(impl)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::CodeIndex::build"});
+        }
+    }
+
+    bool scan::CodeIndex::accelerates(const Pattern &pattern) const noexcept
+    {
+        return m_impl && plan_grams(detail::pattern_buffer(pattern)).count != 0;
+    }
+
+    Result<Address> scan::CodeIndex::scan(const Pattern &pattern, std::size_t occurrence) const noexcept
+    {
+        if (!m_impl)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::CodeIndex::scan"});
+        }
+        const GramPlan plan = plan_grams(detail::pattern_buffer(pattern));
+        if (plan.count == 0)
+        {
+            return scan::scan(pattern, m_impl->scope, occurrence, m_impl->pages);
+        }
+        if (occurrence == 0)
+        {
+            return std::unexpected(Error{ErrorCode::NoMatch, "scan::CodeIndex::scan"});
+        }
+        try
+        {
+            std::size_t seen = 0;
+            std::uintptr_t found = 0;
+            (void)m_impl->for_each_site(pattern, plan,
+                                        [&](std::uintptr_t site)
+                                        {
+                                            if (++seen < occurrence)
+                                            {
+                                                return true;
+                                            }
+                                            found = site;
+                                            return false;
+                                        });
+            if (found == 0)
+            {
+                return std::unexpected(Error{ErrorCode::NoMatch, "scan::CodeIndex::scan"});
+            }
+            return Address{found + pattern.offset()};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::CodeIndex::scan"});
+        }
+    }
+
+    Result<scan::MatchSummary> scan::CodeIndex::find_all(const Pattern &pattern, std::span<Address> out) const noexcept
+    {
+        if (!m_impl)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::CodeIndex::find_all"});
+        }
+        const GramPlan plan = plan_grams(detail::pattern_buffer(pattern));
+        if (plan.count == 0)
+        {
+            return scan::find_all(pattern, m_impl->scope, out, m_impl->pages);
+        }
+        try
+        {
+            MatchSummary summary{};
+            const QueryOutcome outcome = m_impl->for_each_site(pattern, plan,
+                                                               [&](std::uintptr_t site)
+                                                               {
+                                                                   if (summary.matches == out.size())
+                                                                   {
+                                                                       return false;
+                                                                   }
+                                                                   out[summary.matches++] =
+                                                                       Address{site + pattern.offset()};
+                                                                   return true;
+                                                               });
+            summary.faulted = outcome.faulted;
+            summary.stopped = outcome.stopped;
+            return summary;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::CodeIndex::find_all"});
+        }
+    }
+
+    Region scan::CodeIndex::scope() const noexcept
+    {
+        return m_impl ? m_impl->scope : Region{};
+    }
+
+    scan::CodeIndexStats scan::CodeIndex::stats() const noexcept
+    {
+        return m_impl ? m_impl->stats : CodeIndexStats{};
+    }
+} // namespace DetourModKit
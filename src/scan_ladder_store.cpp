@@ -0,0 +1,551 @@
+/**
+ * @file scan_ladder_store.cpp
+ * @brief scan::LadderStore: the rung, pattern and string pools, their intern indexes, and the ladder rebuild.
+ * @details Every pool is an append-only vector addressed by 32-bit index, so growing a pool moves its elements but
+ *          never invalidates an index, and a handle stays valid however many ladders follow it. Each intern index maps
+ *          an FNV-1a content hash to the indexes that hashed there; a probe compares content, so a hash collision
+ *          costs a compare, never a wrong share.
+ */
+
+#include "DetourModKit/scan_ladder_store.hpp"
+
+#include "internal/fnv1a.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        constexpr std::uint64_t POOL_LIMIT = std::numeric_limits<std::uint32_t>::max();
+
+        // Rung flag bits for the StringXref facets.
+        constexpr std::uint8_t RUNG_REQUIRE_TERMINATOR = 0x01;
+        constexpr std::uint8_t RUNG_BROAD_MATCH = 0x02;
+
+        struct StringRecord
+        {
+            std::uint32_t offset = 0;
+            std::uint32_t length = 0;
+        };
+
+        // A pattern's used bytes sit at [bytes, bytes + length) of the byte pool and its mask right after them; its
+        // jumps are [first_jump, first_jump + jump_count) of the jump pool, and its classes and groups likewise.
+        struct PatternRecord
+        {
+            std::uint32_t bytes = 0;
+            std::uint32_t first_jump = 0;
+            std::uint32_t first_class = 0;
+            std::uint32_t first_group = 0;
+            std::uint16_t length = 0;
+            std::uint16_t result_offset = 0;
+            std::uint16_t jump_count = 0;
+            std::uint8_t class_count = 0;
+            std::uint8_t group_count = 0;
+        };
+
+        // One rung. payload is a pattern index for the byte tiers and a string index for the text tiers; delta is the
+        // Direct walk-back or the RipRelative displacement offset. Every field is a value or a pool index, so two
+        // rungs with equal records rebuild to equal candidates.
+        struct Rung
+        {
+            std::int64_t delta = 0;
+            std::uint32_t name = 0;
+            std::uint32_t payload = 0;
+            scan::Mode mode = scan::Mode::Direct;
+            std::uint8_t instruction_length = 0;
+            scan::StringEncoding encoding = scan::StringEncoding::Utf8;
+            scan::XrefReturn return_mode = scan::XrefReturn::ReferencingInstruction;
+            std::uint8_t flags = 0;
+
+            [[nodiscard]] bool operator==(const Rung &) const noexcept = default;
+        };
+
+        struct LadderRecord
+        {
+            std::uint32_t first = 0;
+            std::uint32_t count = 0;
+        };
+
+        [[nodiscard]] Error pool_full() noexcept
+        {
+            return Error{ErrorCode::InvalidArg, "scan::LadderStore::add"};
+        }
+
+        [[nodiscard]] bool fits(std::size_t used, std::size_t more) noexcept
+        {
+            return static_cast<std::uint64_t>(used) + more <= POOL_LIMIT;
+        }
+
+        [[nodiscard]] std::uint64_t rung_hash(std::uint64_t hash, const Rung &rung) noexcept
+        {
+            hash = detail::fnv1a_int(hash, rung.delta);
+            hash = detail::fnv1a_int(hash, rung.name);
+            hash = detail::fnv1a_int(hash, rung.payload);
+            hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(rung.mode));
+            hash = detail::fnv1a_byte(hash, rung.instruction_length);
+            hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(rung.encoding));
+            hash = detail::fnv1a_byte(hash, static_cast<std::uint8_t>(rung.return_mode));
+            return detail::fnv1a_byte(hash, rung.flags);
+        }
+
+        // Heap characters a std::string of @p length holds beyond its small-string buffer.
+        [[nodiscard]] std::size_t heap_chars(std::size_t length) noexcept
+        {
+            static const std::size_t small_capacity = std::string{}.capacity();
+            return length > small_capacity ? length + 1 : 0;
+        }
+
+        template <typename Map> [[nodiscard]] std::size_t index_bytes(const Map &map) noexcept
+        {
+            // Per node: the key/value pair plus the next pointer and cached hash the common implementations keep.
+            return map.size() * (sizeof(typename Map::value_type) + 2 * sizeof(void *)) +
+                   map.bucket_count() * sizeof(void *);
+        }
+    } // namespace
+
+    struct scan::LadderStore::Impl
+    {
+        std::vector<char> chars;
+        std::vector<StringRecord> strings;
+        std::vector<std::byte> pattern_bytes;
+        std::vector<detail::PatternJump> jumps;
+        std::vector<detail::ByteClass> classes;
+        std::vector<detail::PatternGroup> groups;
+        std::vector<PatternRecord> patterns;
+        std::vector<Rung> rungs;
+        std::vector<LadderRecord> ladders;
+        std::unordered_multimap<std::uint64_t, std::uint32_t> string_index;
+        std::unordered_multimap<std::uint64_t, std::uint32_t> pattern_index;
+        std::unordered_multimap<std::uint64_t, std::uint32_t> ladder_index;
+        std::size_t ladders_added = 0;
+        std::size_t candidate_bytes = 0;
+
+        [[nodiscard]] std::string_view string_at(std::uint32_t index) const noexcept
+        {
+            const StringRecord &record = strings[index];
+            return std::string_view{chars.data() + record.offset, record.length};
+        }
+
+        [[nodiscard]] Result<std::uint32_t> intern_string(std::string_view text)
+        {
+            const std::uint64_t hash = detail::fnv1a_field(detail::FNV1A64_OFFSET, text);
+            const auto [first, last] = string_index.equal_range(hash);
+            for (auto it = first; it != last; ++it)
+            {
+                if (string_at(it->second) == text)
+                {
+                    return it->second;
+                }
+            }
+            if (!fits(chars.size(), text.size()) || !fits(strings.size(), 1))
+            {
+                return std::unexpected(pool_full());
+            }
+            const auto index = static_cast<std::uint32_t>(strings.size());
+            strings.push_back(StringRecord{static_cast<std::uint32_t>(chars.size()),
+                                           static_cast<std::uint32_t>(text.size())});
+            chars.insert(chars.end(), text.begin(), text.end());
+            string_index.emplace(hash, index);
+            return index;
+        }
+
+        [[nodiscard]] bool pattern_equals(const PatternRecord &record,
+                                          const detail::PatternBuffer &buffer) const noexcept
+        {
+            if (record.length != buffer.length || record.result_offset != buffer.offset ||
+                record.jump_count != buffer.jump_count)
+            {
+                return false;
+            }
+            const std::byte *stored = pattern_bytes.data() + record.bytes;
+            if (!std::equal(stored, stored + record.length, buffer.bytes.begin()) ||
+                !std::equal(stored + record.length, stored + 2 * record.length, buffer.mask.begin()))
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < record.jump_count; ++i)
+            {
+                const detail::PatternJump &a = jumps[record.first_jump + i];
+                const detail::PatternJump &b = buffer.jumps[i];
+                if (a.position != b.position || a.min_skip != b.min_skip || a.max_skip != b.max_skip)
+                {
+                    return false;
+                }
+            }
+            if (record.class_count != buffer.class_count || record.group_count != buffer.group_count)
+            {
+                return false;
+            }
+            for (std::size_t i = 0; i < record.class_count; ++i)
+            {
+                const detail::ByteClass &a = classes[record.first_class + i];
+                const detail::ByteClass &b = buffer.classes[i];
+                if (a.position != b.position || a.members.words != b.members.words)
+                {
+                    return false;
+                }
+            }
+            for (std::size_t i = 0; i < record.group_count; ++i)
+            {
+                const detail::PatternGroup &a = groups[record.first_group + i];
+                const detail::PatternGroup &b = buffer.groups[i];
+                if (a.position != b.position || a.length != b.length || a.count != b.count || a.bytes != b.bytes ||
+                    a.mask != b.mask)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] Result<std::uint32_t> intern_pattern(const Pattern &pattern)
+        {
+            const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+            std::uint64_t hash = detail::fnv1a_bytes(detail::FNV1A64_OFFSET, pattern.bytes());
+            hash = detail::fnv1a_bytes(hash, pattern.mask());
+            hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.offset));
+            hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.jump_count));
+            for (std::size_t i = 0; i < buffer.jump_count; ++i)
+            {
+                hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.jumps[i].position));
+                hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.jumps[i].min_skip));
+                hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.jumps[i].max_skip));
+            }
+            // Two patterns can share bytes and mask yet differ in a class or group. Their counts and class positions
+            // keep the common cases in separate buckets; pattern_equals compares them whole.
+            hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.class_count));
+            for (std::size_t i = 0; i < buffer.class_count; ++i)
+            {
+                hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.classes[i].position));
+            }
+            hash = detail::fnv1a_int(hash, static_cast<std::uint64_t>(buffer.group_count));
+            const auto [first, last] = pattern_index.equal_range(hash);
+            for (auto it = first; it != last; ++it)
+            {
+                if (pattern_equals(patterns[it->second], buffer))
+                {
+                    return it->second;
+                }
+            }
+            if (!fits(pattern_bytes.size(), 2 * buffer.length) || !fits(jumps.size(), buffer.jump_count) ||
+                !fits(classes.size(), buffer.class_count) || !fits(groups.size(), buffer.group_count) ||
+                !fits(patterns.size(), 1))
+            {
+                return std::unexpected(pool_full());
+            }
+            const auto index = static_cast<std::uint32_t>(patterns.size());
+            patterns.push_back(PatternRecord{static_cast<std::uint32_t>(pattern_bytes.size()),
+                                             static_cast<std::uint32_t>(jumps.size()),
+                                             static_cast<std::uint32_t>(classes.size()),
+                                             static_cast<std::uint32_t>(groups.size()),
+                                             static_cast<std::uint16_t>(buffer.length),
+                                             static_cast<std::uint16_t>(buffer.offset),
+                                             static_cast<std::uint16_t>(buffer.jump_count),
+                                             static_cast<std::uint8_t>(buffer.class_count),
+                                             static_cast<std::uint8_t>(buffer.group_count)});
+            pattern_bytes.insert(pattern_bytes.end(), buffer.bytes.begin(), buffer.bytes.begin() + buffer.length);
+            pattern_bytes.insert(pattern_bytes.end(), buffer.mask.begin(), buffer.mask.begin() + buffer.length);
+            jumps.insert(jumps.end(), buffer.jumps.begin(), buffer.jumps.begin() + buffer.jump_count);
+            classes.insert(classes.end(), buffer.classes.begin(), buffer.classes.begin() + buffer.class_count);
+            groups.insert(groups.end(), buffer.groups.begin(), buffer.groups.begin() + buffer.group_count);
+            pattern_index.emplace(hash, index);
+            return index;
+        }
+
+        [[nodiscard]] Result<Rung> make_rung(const Candidate &candidate)
+        {
+            Result<std::uint32_t> name = intern_string(candidate.name());
+            if (!name)
+            {
+                return std::unexpected(name.error());
+            }
+            Rung rung;
+            rung.name = *name;
+            rung.mode = candidate.mode();
+            Result<std::uint32_t> payload = std::unexpected(pool_full());
+            std::size_t payload_chars = 0;
+            switch (candidate.mode())
+            {
+            case Mode::Direct:
+                payload = intern_pattern(candidate.as_direct()->pattern);
+                rung.delta = candidate.as_direct()->walk_back;
+                break;
+            case Mode::RipRelative:
+            {
+                const RipRelativePattern &rip = *candidate.as_rip_relative();
+                payload = intern_pattern(rip.pattern);
+                rung.delta = rip.displacement_at;
+                // The factory bounds this by MAX_X86_INSTRUCTION_LENGTH, so it always fits the byte.
+                rung.instruction_length = static_cast<std::uint8_t>(rip.instruction_length);
+                break;
+            }
+            case Mode::RttiVtable:
+                payload = intern_string(candidate.as_rtti_vtable()->mangled);
+                payload_chars = candidate.as_rtti_vtable()->mangled.size();
+                break;
+            case Mode::StringXref:
+            {
+                const StringXref &xref = *candidate.as_string_xref();
+                payload = intern_string(xref.text);
+                payload_chars = xref.text.size();
+                rung.encoding = xref.encoding;
+                rung.return_mode = xref.return_mode;
+                rung.flags = static_cast<std::uint8_t>((xref.require_terminator ? RUNG_REQUIRE_TERMINATOR : 0) |
+                                                       (xref.broad_match ? RUNG_BROAD_MATCH : 0));
+                break;
+            }
+            }
+            if (!payload)
+            {
+                return std::unexpected(payload.error());
+            }
+            rung.payload = *payload;
+            candidate_bytes += sizeof(Candidate) + heap_chars(candidate.name().size()) + heap_chars(payload_chars);
+            return rung;
+        }
+
+        [[nodiscard]] Pattern pattern_at(std::uint32_t index) const
+        {
+            const PatternRecord &record = patterns[index];
+            detail::PatternBuffer buffer{};
+            const std::byte *stored = pattern_bytes.data() + record.bytes;
+            std::copy(stored, stored + record.length, buffer.bytes.begin());
+            std::copy(stored + record.length, stored + 2 * record.length, buffer.mask.begin());
+            std::copy(jumps.begin() + record.first_jump, jumps.begin() + record.first_jump + record.jump_count,
+                      buffer.jumps.begin());
+            std::copy(classes.begin() + record.first_class, classes.begin() + record.first_class + record.class_count,
+                      buffer.classes.begin());
+            std::copy(groups.begin() + record.first_group, groups.begin() + record.first_group + record.group_count,
+                      buffer.groups.begin());
+            buffer.length = record.length;
+            buffer.offset = record.result_offset;
+            buffer.jump_count = record.jump_count;
+            buffer.class_count = record.class_count;
+            buffer.group_count = record.group_count;
+            // The record was taken from a compiled Pattern, so the rebuilt buffer is well formed; pattern_from_buffer
+            // re-selects the same anchor the original compile chose.
+            return *detail::pattern_from_buffer(buffer);
+        }
+
+        [[nodiscard]] Candidate candidate_at(const Rung &rung) const
+        {
+            std::string name{string_at(rung.name)};
+            switch (rung.mode)
+            {
+            case Mode::Direct:
+                return Candidate::direct(std::move(name), pattern_at(rung.payload),
+                                         static_cast<std::ptrdiff_t>(rung.delta));
+            case Mode::RipRelative:
+                return Candidate::rip_relative(std::move(name), pattern_at(rung.payload),
+                                               static_cast<std::ptrdiff_t>(rung.delta), rung.instruction_length);
+            case Mode::RttiVtable:
+                return Candidate::rtti_vtable(std::move(name), std::string{string_at(rung.payload)});
+            case Mode::StringXref:
+                break;
+            }
+            const StringRefQuery query{.text = string_at(rung.payload),
+                                       .encoding = rung.encoding,
+                                       .require_terminator = (rung.flags & RUNG_REQUIRE_TERMINATOR) != 0,
+                                       .return_mode = rung.return_mode,
+                                       .broad_match = (rung.flags & RUNG_BROAD_MATCH) != 0};
+            return Candidate::string_xref(std::move(name), query);
+        }
+    };
+
+    scan::LadderStore::LadderStore() : m_impl(std::make_unique<Impl>()) {}
+
+    scan::LadderStore::~LadderStore() noexcept = default;
+
+    scan::LadderStore::LadderStore(LadderStore &&other) noexcept = default;
+
+    scan::LadderStore &scan::LadderStore::operator=(LadderStore &&other) noexcept = default;
+
+    Result<scan::LadderHandle> scan::LadderStore::add(std::span<const Candidate> ladder) noexcept
+    {
+        if (!m_impl || ladder.size() > MAX_LADDER_RUNGS)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::LadderStore::add", ladder.size()});
+        }
+        if (ladder.empty())
+        {
+            return std::unexpected(Error{ErrorCode::EmptyCandidates, "scan::LadderStore::add"});
+        }
+        Impl &impl = *m_impl;
+        const std::size_t candidate_bytes = impl.candidate_bytes;
+        try
+        {
+            // Intern the rungs' strings and patterns first. An add that fails after this leaves those entries in the
+            // pools, unreferenced but harmless, and never a half-appended ladder.
+            std::vector<Rung> rungs;
+            rungs.reserve(ladder.size());
+            std::uint64_t hash = detail::fnv1a_int(detail::FNV1A64_OFFSET, static_cast<std::uint64_t>(ladder.size()));
+            for (const Candidate &candidate : ladder)
+            {
+                Result<Rung> rung = impl.make_rung(candidate);
+                if (!rung)
+                {
+                    impl.candidate_bytes = candidate_bytes;
+                    return std::unexpected(rung.error());
+                }
+                hash = rung_hash(hash, *rung);
+                rungs.push_back(*rung);
+            }
+
+            ++impl.ladders_added;
+            const auto [first, last] = impl.ladder_index.equal_range(hash);
+            for (auto it = first; it != last; ++it)
+            {
+                const LadderRecord &record = impl.ladders[it->second];
+                if (std::equal(rungs.begin(), rungs.end(), impl.rungs.begin() + record.first,
+                               impl.rungs.begin() + record.first + record.count))
+                {
+                    return static_cast<LadderHandle>(it->second);
+                }
+            }
+            // The new index stays below the limit, which is LadderHandle::Invalid.
+            if (!fits(impl.rungs.size(), rungs.size()) || !fits(impl.ladders.size(), 1))
+            {
+                --impl.ladders_added;
+                impl.candidate_bytes = candidate_bytes;
+                return std::unexpected(pool_full());
+            }
+            const auto index = static_cast<std::uint32_t>(impl.ladders.size());
+            impl.ladders.reserve(impl.ladders.size() + 1);
+            impl.rungs.reserve(impl.rungs.size() + rungs.size());
+            impl.ladder_index.emplace(hash, index);
+            impl.ladders.push_back(
+                LadderRecord{static_cast<std::uint32_t>(impl.rungs.size()), static_cast<std::uint32_t>(rungs.size())});
+            impl.rungs.insert(impl.rungs.end(), rungs.begin(), rungs.end());
+            return static_cast<LadderHandle>(index);
+        }
+        catch (const std::bad_alloc &)
+        {
+            impl.candidate_bytes = candidate_bytes;
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::LadderStore::add"});
+        }
+        catch (...)
+        {
+            impl.candidate_bytes = candidate_bytes;
+            return std::unexpected(Error{ErrorCode::Unknown, "scan::LadderStore::add"});
+        }
+    }
+
+    bool scan::LadderStore::contains(LadderHandle handle) const noexcept
+    {
+        return m_impl && static_cast<std::size_t>(handle) < m_impl->ladders.size();
+    }
+
+    std::size_t scan::LadderStore::size(LadderHandle handle) const noexcept
+    {
+        return contains(handle) ? m_impl->ladders[static_cast<std::size_t>(handle)].count : 0;
+    }
+
+    std::string_view scan::LadderStore::name(LadderHandle handle, std::size_t rung) const noexcept
+    {
+        if (rung >= size(handle))
+        {
+            return {};
+        }
+        const LadderRecord &record = m_impl->ladders[static_cast<std::size_t>(handle)];
+        return m_impl->string_at(m_impl->rungs[record.first + rung].name);
+    }
+
+    Result<std::vector<scan::Candidate>> scan::LadderStore::ladder(LadderHandle handle) const noexcept
+    {
+        if (!contains(handle))
+        {
+            return std::unexpected(
+                Error{ErrorCode::InvalidArg, "scan::LadderStore::ladder", static_cast<std::uintptr_t>(handle)});
+        }
+        try
+        {
+            const LadderRecord &record = m_impl->ladders[static_cast<std::size_t>(handle)];
+            std::vector<Candidate> candidates;
+            candidates.reserve(record.count);
+            for (std::uint32_t i = 0; i < record.count; ++i)
+            {
+                candidates.push_back(m_impl->candidate_at(m_impl->rungs[record.first + i]));
+            }
+            return candidates;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::LadderStore::ladder"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::Unknown, "scan::LadderStore::ladder"});
+        }
+    }
+
+    Result<scan::Hit> scan::LadderStore::resolve(LadderHandle handle, ScanRequest policy) const
+    {
+        Result<std::vector<Candidate>> rebuilt = ladder(handle);
+        if (!rebuilt)
+        {
+            return std::unexpected(rebuilt.error());
+        }
+        policy.ladder = *rebuilt;
+        return scan::resolve(policy);
+    }
+
+    scan::LadderStoreStats scan::LadderStore::stats() const noexcept
+    {
+        LadderStoreStats stats;
+        if (!m_impl)
+        {
+            return stats;
+        }
+        const Impl &impl = *m_impl;
+        stats.ladders = impl.ladders.size();
+        stats.rungs = impl.rungs.size();
+        stats.patterns = impl.patterns.size();
+        stats.strings = impl.strings.size();
+        stats.ladders_added = impl.ladders_added;
+        stats.candidate_bytes = impl.candidate_bytes;
+        stats.resident_bytes = impl.chars.capacity() + impl.strings.capacity() * sizeof(StringRecord) +
+                               impl.pattern_bytes.capacity() + impl.jumps.capacity() * sizeof(detail::PatternJump) +
+                               impl.classes.capacity() * sizeof(detail::ByteClass) +
+                               impl.groups.capacity() * sizeof(detail::PatternGroup) +
+                               impl.patterns.capacity() * sizeof(PatternRecord) + impl.rungs.capacity() * sizeof(Rung) +
+                               impl.ladders.capacity() * sizeof(LadderRecord) + index_bytes(impl.string_index) +
+                               index_bytes(impl.pattern_index) + index_bytes(impl.ladder_index);
+        return stats;
+    }
+
+    void scan::LadderStore::clear() noexcept
+    {
+        if (!m_impl)
+        {
+            return;
+        }
+        // Swapping with empty vectors releases the pools; a default-constructed vector never allocates, unlike some
+        // default-constructed unordered maps, so the indexes are only cleared.
+        Impl &impl = *m_impl;
+        std::vector<char>().swap(impl.chars);
+        std::vector<StringRecord>().swap(impl.strings);
+        std::vector<std::byte>().swap(impl.pattern_bytes);
+        std::vector<detail::PatternJump>().swap(impl.jumps);
+        std::vector<detail::ByteClass>().swap(impl.classes);
+        std::vector<detail::PatternGroup>().swap(impl.groups);
+        std::vector<PatternRecord>().swap(impl.patterns);
+        std::vector<Rung>().swap(impl.rungs);
+        std::vector<LadderRecord>().swap(impl.ladders);
+        impl.string_index.clear();
+        impl.pattern_index.clear();
+        impl.ladder_index.clear();
+        impl.ladders_added = 0;
+        impl.candidate_bytes = 0;
+    }
+} // namespace DetourModKit
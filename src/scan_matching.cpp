@@ -1,7 +1,8 @@
 /**
  * @file scan_matching.cpp
- * @brief Public single-pattern matching: scan() (page-gated, occurrence + Pages), unchecked::find_pattern() (raw Nth),
- *        active_simd_level(), and is_likely_function_prologue().
+ * @brief Public single-pattern matching: scan() (page-gated, occurrence + Pages, over a Region or a RegionSet),
+ *        unchecked::find_pattern() (raw Nth), the kernel entry points behind their `<"...">` literal forms, the
+ *        for_each_match() / find_all() enumerations, active_simd_level(), and is_likely_function_prologue().
  * @details Expresses the public matching surface in the Address / Region / Result vocabulary over the private engine.
  *          scan() walks the OS page map for the requested Pages class and reads only committed pages under a fault
  *          guard; the unchecked twin performs a raw, page-unfiltered scan the caller guarantees readable. The
@@ -15,10 +16,13 @@
 #include "internal/scan_engine.hpp"
 #include "internal/scan_pages.hpp"
 #include "internal/scan_shared.hpp"
+#include "internal/scan_telemetry.hpp"
 
 #include <cstddef>
 #include <cstdint>
 #include <new>
+#include <span>
+#include <vector>
 
 namespace DetourModKit
 {
@@ -30,6 +34,12 @@ namespace DetourModKit
         }
 
         Result<Address> scan(const Pattern &pattern, Region scope, std::size_t occurrence, Pages pages) noexcept
+        {
+            return detail::scan_with_kernel(pattern, nullptr, scope, occurrence, pages);
+        }
+
+        Result<Address> scan(const Pattern &pattern, const RegionSet &scope, std::size_t occurrence,
+                             Pages pages) noexcept
         {
             if (occurrence == 0)
             {
@@ -39,24 +49,20 @@ namespace DetourModKit
             {
                 return std::unexpected(Error{ErrorCode::InvalidArg, "scan::scan"});
             }
-            const detail::ModuleSpan range = detail::module_span(scope);
-            if (!range.valid())
+            if (scope.empty())
             {
                 return std::unexpected(Error{ErrorCode::InvalidRange, "scan::scan"});
             }
             try
             {
-                const detail::HaystackHistogram histogram = detail::sample_haystack(scope);
-                const detail::EnginePattern compiled = detail::to_engine_pattern(pattern, histogram);
-                const detail::MatchResult result = detail::scan_module_pages(compiled, range, pages, occurrence);
-                if (result.match == nullptr)
-                {
-                    return std::unexpected(Error{ErrorCode::NoMatch, "scan::scan"});
-                }
-                if (result.incomplete)
+                detail::TelemetryScope telemetry;
+                const std::vector<detail::ModuleSpan> spans = detail::module_spans(scope);
+                const detail::EnginePattern compiled =
+                    detail::to_engine_pattern(pattern, detail::sample_haystack(scope, pages));
+                const detail::MatchResult result = detail::scan_module_set_split(compiled, spans, pages, occurrence);
+                if (result.match == nullptr || result.incomplete)
                 {
-                    // A skipped faulted region or a bounded-jump budget truncation makes the occurrence count a lower
-                    // bound, so report a clean miss rather than a possibly-wrong address.
+                    // As for a single Region: an incomplete sweep makes the count a lower bound, so it is a miss.
                     return std::unexpected(Error{ErrorCode::NoMatch, "scan::scan"});
                 }
                 return Address{reinterpret_cast<std::uintptr_t>(result.match)};
@@ -67,6 +73,28 @@ namespace DetourModKit
             }
         }
 
+        Result<MatchSummary> find_all(const Pattern &pattern, Region scope, std::span<Address> out,
+                                      Pages pages) noexcept
+        {
+            struct Table
+            {
+                std::span<Address> out;
+                std::size_t written = 0;
+            } table{out, 0};
+            const auto store = [](void *context, Address match) noexcept -> bool
+            {
+                Table &target = *static_cast<Table *>(context);
+                if (target.written == target.out.size())
+                {
+                    return false;
+                }
+                target.out[target.written] = match;
+                ++target.written;
+                return true;
+            };
+            return detail::for_each_match(pattern, scope, pages, store, &table);
+        }
+
         bool is_likely_function_prologue(Address addr) noexcept
         {
             if (!addr)
@@ -96,24 +124,115 @@ namespace DetourModKit
         {
             const std::byte *find_pattern(Region region, const Pattern &pattern, std::size_t occurrence) noexcept
             {
-                if (region.base.raw() == 0 || region.size == 0 || occurrence == 0)
-                {
-                    return nullptr;
-                }
-                try
-                {
-                    // The raw primitive does no page filtering, so the caller owns readability; it also does not
-                    // consult the haystack histogram (that override accelerates the page-gated scan), using the
-                    // Pattern's compile-time anchor directly.
-                    const std::size_t anchor = pattern.has_anchor() ? pattern.anchor_index() : pattern.size();
-                    const detail::EnginePattern compiled = detail::engine_pattern_from(pattern, anchor);
-                    return detail::find_pattern(region.base.ptr<const std::byte>(), region.size, compiled, occurrence);
-                }
-                catch (const std::bad_alloc &)
-                {
-                    return nullptr;
-                }
+                return detail::find_pattern_with_kernel(region, pattern, nullptr, occurrence);
             }
         } // namespace unchecked
     } // namespace scan
+
+    Result<Address> detail::scan_with_kernel(const scan::Pattern &pattern, PatternKernel kernel, Region scope,
+                                             std::size_t occurrence, scan::Pages pages) noexcept
+    {
+        using scan::Pages;
+        if (occurrence == 0)
+        {
+            return std::unexpected(Error{ErrorCode::NoMatch, "scan::scan"});
+        }
+        if (pages != Pages::Readable && pages != Pages::Executable)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::scan"});
+        }
+        const detail::ModuleSpan range = detail::module_span(scope);
+        if (!range.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::scan"});
+        }
+        try
+        {
+            detail::TelemetryScope telemetry;
+            const detail::HaystackHistogram histogram = detail::sample_haystack(scope, pages);
+            detail::EnginePattern compiled = detail::to_engine_pattern(pattern, histogram);
+            compiled.kernel = kernel;
+            // A lone scan over a large scope (Region::host(), a big .text) is split across the cores; the split
+            // keeps the serial walk's exact Nth-occurrence answer and falls back to it for a small image.
+            const detail::MatchResult result =
+                detail::scan_module_pages_split(compiled, range, pages, occurrence);
+            if (result.match == nullptr)
+            {
+                return std::unexpected(Error{ErrorCode::NoMatch, "scan::scan"});
+            }
+            if (result.incomplete)
+            {
+                // A skipped faulted region or a bounded-jump budget truncation makes the occurrence count a lower
+                // bound, so report a clean miss rather than a possibly-wrong address.
+                return std::unexpected(Error{ErrorCode::NoMatch, "scan::scan"});
+            }
+            return Address{reinterpret_cast<std::uintptr_t>(result.match)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::scan"});
+        }
+    }
+
+    const std::byte *detail::find_pattern_with_kernel(Region region, const scan::Pattern &pattern,
+                                                      PatternKernel kernel, std::size_t occurrence) noexcept
+    {
+        if (region.base.raw() == 0 || region.size == 0 || occurrence == 0)
+        {
+            return nullptr;
+        }
+        try
+        {
+            // The raw primitive does no page filtering, so the caller owns readability; it also does not
+            // consult the haystack histogram (that override accelerates the page-gated scan), using the
+            // Pattern's compile-time anchor directly.
+            const std::size_t anchor = pattern.has_anchor() ? pattern.anchor_index() : pattern.size();
+            detail::EnginePattern compiled = detail::engine_pattern_from(pattern, anchor);
+            compiled.kernel = kernel;
+            return detail::find_pattern(region.base.ptr<const std::byte>(), region.size, compiled, occurrence);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return nullptr;
+        }
+    }
+
+    Result<scan::MatchSummary> detail::for_each_match(const scan::Pattern &pattern, Region scope, scan::Pages pages,
+                                                      AddressVisitor visit, void *context) noexcept
+    {
+        using scan::Pages;
+        if (pages != Pages::Readable && pages != Pages::Executable)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "scan::for_each_match"});
+        }
+        const detail::ModuleSpan range = detail::module_span(scope);
+        if (!range.valid())
+        {
+            return std::unexpected(Error{ErrorCode::InvalidRange, "scan::for_each_match"});
+        }
+        try
+        {
+            // The visitor's own scans, if any, count toward this enumeration.
+            detail::TelemetryScope telemetry;
+            const detail::HaystackHistogram histogram = detail::sample_haystack(scope, pages);
+            const detail::EnginePattern compiled = detail::to_engine_pattern(pattern, histogram);
+            struct Forward
+            {
+                AddressVisitor visit;
+                void *context;
+            } forward{visit, context};
+            const auto to_address = [](void *opaque, const std::byte *match) noexcept -> bool
+            {
+                const Forward &target = *static_cast<const Forward *>(opaque);
+                return target.visit(target.context, Address{reinterpret_cast<std::uintptr_t>(match)});
+            };
+            const detail::EnumerationResult walked =
+                detail::enumerate_module_pages(compiled, range, pages, to_address, &forward);
+            return scan::MatchSummary{walked.matches, walked.faulted, walked.budget_exhausted, walked.stopped};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::for_each_match"});
+        }
+    }
 } // namespace DetourModKit
@@ -0,0 +1,205 @@
+/**
+ * @file scan_pattern_intern.cpp
+ * @brief The process-wide intern table behind scan::Pattern::compile.
+ * @details Signatures are compiled at setup time, but the same DSL strings are compiled over and over: every mod in a
+ *          process declares the game's well-known signatures, and a ladder rebuilt per profile or per hot reload
+ *          re-parses text it has parsed before. The table maps the exact DSL text to the compiled Pattern, with its
+ *          rarest-byte anchor already selected, so a repeated compile is one hash and a short probe.
+ *
+ *          The table is a fixed array of atomic entry pointers probed linearly. Entries are published once with a
+ *          compare-exchange and never removed or replaced while the process runs, so a reader needs no lock: an
+ *          acquire load either sees a null slot, which ends the probe chain, or a fully built immutable entry. The
+ *          entry count is capped below the slot count to keep probe chains short, and a string that cannot be
+ *          published is simply parsed uncached -- the table is an optimisation, never a correctness dependency.
+ *
+ *          The EnginePattern form is not interned: its scan anchor is chosen against the byte histogram of the scope
+ *          being scanned, so it depends on the haystack rather than the text alone. What the table shares is the
+ *          parse and the compile-time anchor analysis every Pattern carries.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include "internal/fnv1a.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        // A power of two so the probe wraps with a mask; half of it is the entry cap, which keeps the load factor at
+        // or below one half and the expected probe run to a slot or two.
+        constexpr std::size_t INTERN_SLOTS = 2048;
+        constexpr std::size_t INTERN_CAPACITY = INTERN_SLOTS / 2;
+        constexpr std::size_t INTERN_MAX_PROBES = 32;
+
+        // Longest DSL text that is interned. A full-size pattern (MAX_PATTERN_BYTES bytes, every jump used) spells out
+        // in well under this; anything longer is padded with whitespace or generated text and compiles uncached.
+        constexpr std::size_t INTERN_MAX_TEXT = 2048;
+
+        struct InternedPattern
+        {
+            std::uint64_t hash = 0;
+            std::string text;
+            scan::Pattern pattern;
+        };
+
+        struct InternTable
+        {
+            std::array<std::atomic<const InternedPattern *>, INTERN_SLOTS> slots{};
+            std::atomic<std::size_t> entries{0};
+            std::atomic<std::uint64_t> hits{0};
+            std::atomic<std::uint64_t> misses{0};
+            std::atomic<std::uint64_t> uncached{0};
+
+            InternTable() = default;
+            InternTable(const InternTable &) = delete;
+            InternTable &operator=(const InternTable &) = delete;
+
+            // Frees the entries when the image unloads, so a hot-reloaded mod DLL does not leak its table. Each slot
+            // is cleared as it is freed: a compile from a later static destructor then finds an empty table and
+            // parses, rather than reading a freed entry.
+            ~InternTable()
+            {
+                for (std::atomic<const InternedPattern *> &slot : slots)
+                {
+                    delete slot.exchange(nullptr, std::memory_order_acq_rel);
+                }
+            }
+        };
+
+        [[nodiscard]] InternTable &intern_table() noexcept
+        {
+            static InternTable table;
+            return table;
+        }
+
+        [[nodiscard]] std::uint64_t text_hash(std::string_view text) noexcept
+        {
+            return detail::fnv1a_field(detail::FNV1A64_OFFSET, text);
+        }
+
+        // Folds the high half in so the slot index draws on every byte of the text, not only the last few multiplies.
+        [[nodiscard]] std::size_t home_slot(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::size_t>(hash ^ (hash >> 32)) & (INTERN_SLOTS - 1);
+        }
+
+        [[nodiscard]] bool same_text(const InternedPattern &entry, std::uint64_t hash, std::string_view text) noexcept
+        {
+            return entry.hash == hash && std::string_view{entry.text} == text;
+        }
+
+        [[nodiscard]] const InternedPattern *find_entry(const InternTable &table, std::uint64_t hash,
+                                                        std::string_view text) noexcept
+        {
+            const std::size_t home = home_slot(hash);
+            for (std::size_t probe = 0; probe < INTERN_MAX_PROBES; ++probe)
+            {
+                const InternedPattern *entry =
+                    table.slots[(home + probe) & (INTERN_SLOTS - 1)].load(std::memory_order_acquire);
+                if (entry == nullptr)
+                {
+                    // Entries are never removed, so the first empty slot ends the probe chain.
+                    return nullptr;
+                }
+                if (same_text(*entry, hash, text))
+                {
+                    return entry;
+                }
+            }
+            return nullptr;
+        }
+
+        // Publishes one compiled pattern. Returns false when it could not be cached; a concurrent compile of the same
+        // text that won the race counts as published, since the text is now interned either way.
+        [[nodiscard]] bool publish_entry(InternTable &table, std::uint64_t hash, std::string_view text,
+                                         const scan::Pattern &pattern) noexcept
+        {
+            if (text.size() > INTERN_MAX_TEXT || table.entries.load(std::memory_order_relaxed) >= INTERN_CAPACITY)
+            {
+                return false;
+            }
+
+            InternedPattern *fresh = nullptr;
+            try
+            {
+                fresh = new InternedPattern{hash, std::string{text}, pattern};
+            }
+            catch (const std::bad_alloc &)
+            {
+                return false;
+            }
+
+            const std::size_t home = home_slot(hash);
+            for (std::size_t probe = 0; probe < INTERN_MAX_PROBES; ++probe)
+            {
+                std::atomic<const InternedPattern *> &slot = table.slots[(home + probe) & (INTERN_SLOTS - 1)];
+                const InternedPattern *expected = nullptr;
+                if (slot.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel,
+                                                 std::memory_order_acquire))
+                {
+                    table.entries.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+                if (same_text(*expected, hash, text))
+                {
+                    delete fresh;
+                    return true;
+                }
+            }
+
+            // The probe bound was exhausted; a lookup would stop at the same bound, so the entry is dropped.
+            delete fresh;
+            return false;
+        }
+    } // namespace
+
+    Result<scan::Pattern> detail::compile_interned_pattern(std::string_view dsl) noexcept
+    {
+        InternTable &table = intern_table();
+        const std::uint64_t hash = text_hash(dsl);
+
+        if (const InternedPattern *entry = find_entry(table, hash, dsl))
+        {
+            table.hits.fetch_add(1, std::memory_order_relaxed);
+            return entry->pattern;
+        }
+        table.misses.fetch_add(1, std::memory_order_relaxed);
+
+        const PatternParse parsed = parse_pattern(dsl);
+        if (parsed.status != PatternStatus::Ok)
+        {
+            return std::unexpected(
+                Error{ErrorCode::BadPattern, "scan::compile", 0, static_cast<std::uint32_t>(parsed.status)});
+        }
+
+        // parse_pattern only reports Ok for a well-formed buffer, and pattern_from_buffer selects the same anchor the
+        // parser did, so the rebuild cannot fail.
+        const std::optional<scan::Pattern> compiled = pattern_from_buffer(parsed.buffer);
+        if (!publish_entry(table, hash, dsl, *compiled))
+        {
+            table.uncached.fetch_add(1, std::memory_order_relaxed);
+        }
+        return *compiled;
+    }
+
+    scan::PatternInternStats scan::pattern_intern_stats() noexcept
+    {
+        const InternTable &table = intern_table();
+        PatternInternStats stats;
+        stats.entries = table.entries.load(std::memory_order_relaxed);
+        stats.capacity = INTERN_CAPACITY;
+        stats.hits = table.hits.load(std::memory_order_relaxed);
+        stats.misses = table.misses.load(std::memory_order_relaxed);
+        stats.uncached = table.uncached.load(std::memory_order_relaxed);
+        return stats;
+    }
+} // namespace DetourModKit
@@ -7,16 +7,25 @@
  *          byte tiers reuse the page-gated SIMD engine with the bounded
  *          haystack-frequency anchor override (sampled lazily on the first byte candidate, shared across the ladder);
  *          the text tiers resolve through their unique-only backends. On a full direct miss with a non-Off
- *          fallback_policy, hooked-prologue recovery is attempted under that policy's identity gate.
+ *          fallback_policy, hooked-prologue recovery is attempted under that policy's identity gate. An attached
+ *          ResolutionCache (or, for a request without one, the session's reload cache) is probed before the ladder
+ *          and updated after a byte-tier win; a request carrying hint_rva tries its byte tiers in the small window
+ *          around that offset before the full scope, and race_tiers overlaps the ladder's tiers on the fork-join pool
+ *          while settling on the same winner as the serial walk. A request
+ *          scoped by a RegionSet runs the same body over the set's spans, with a single Region as the one-span case.
  */
 
 #include "DetourModKit/scan.hpp"
 
 #include "internal/memory_guarded.hpp"
 #include "internal/scan_engine.hpp"
+#include "internal/scan_cache.hpp"
+#include "internal/scan_multi.hpp"
 #include "internal/scan_pages.hpp"
 #include "internal/scan_prologue_recovery.hpp"
 #include "internal/scan_shared.hpp"
+#include "internal/scan_telemetry.hpp"
+#include "internal/scan_xref_index.hpp"
 
 #include "DetourModKit/format.hpp"
 #include "DetourModKit/logger.hpp"
@@ -25,6 +34,9 @@
 
 #include "fork_join.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <new>
@@ -32,6 +44,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -86,19 +99,18 @@ namespace DetourModKit
             {
                 try
                 {
-                    const std::string where = format::format_address(hit.address.raw());
                     if (via_prologue_recovery)
                     {
                         (void)DetourModKit::log().try_log(
-                            LogLevel::Debug,
+                            log_category::scan, LogLevel::Debug,
                             "scan::resolve: '{}' recovered {} via hooked-prologue reconstruction of candidate '{}'.",
-                            request.label, where, hit.winning_name);
+                            request.label, hit.address, hit.winning_name);
                     }
                     else
                     {
-                        (void)DetourModKit::log().try_log(LogLevel::Debug,
+                        (void)DetourModKit::log().try_log(log_category::scan, LogLevel::Debug,
                                                           "scan::resolve: '{}' resolved {} via candidate '{}'.",
-                                                          request.label, where, hit.winning_name);
+                                                          request.label, hit.address, hit.winning_name);
                     }
                 }
                 catch (...)
@@ -131,53 +143,165 @@ namespace DetourModKit
                         LogLevel::Warning,
                         "scan::resolve: '{}' recovered {} via hooked-prologue reconstruction, but its identity witness "
                         "disagreed (WarnOnly); the site may be a near-twin.",
-                        request.label, format::format_address(hit.address.raw()));
+                        request.label, hit.address);
                 }
                 catch (...)
                 {
                 }
             }
-        } // namespace
 
-        Result<Hit> resolve(const ScanRequest &request)
-        {
-            if (request.ladder.empty())
+            // Runs a text tier, whose backend takes one Region, over the request's scope: the scope itself, or each
+            // span of a RegionSet, accepting only when exactly one span answers. The backend's own unique-in-scope
+            // rule is what a single span proves; two spans answering is the same ambiguity lifted to the set.
+            template <typename ResolveIn>
+            std::optional<Address> resolve_text_tier(const ScanRequest &request, ResolveIn &&resolve_in)
             {
-                return std::unexpected(Error{ErrorCode::EmptyCandidates, "scan::resolve"});
+                if (request.regions == nullptr)
+                {
+                    return resolve_in(request.scope);
+                }
+                std::optional<Address> found;
+                for (const Region &range : request.regions->ranges())
+                {
+                    const std::optional<Address> hit = resolve_in(range);
+                    if (!hit)
+                    {
+                        continue;
+                    }
+                    if (found)
+                    {
+                        return std::nullopt;
+                    }
+                    found = hit;
+                }
+                return found;
             }
-            if (request.pages != Pages::Readable && request.pages != Pages::Executable)
+
+            // The locality window around the request's hint, clamped to @p range; an invalid span when the request
+            // carries no usable hint (none set, a RegionSet scope, a zero width, or an offset past the scope's end).
+            [[nodiscard]] detail::ModuleSpan hint_window_of(const ScanRequest &request,
+                                                            detail::ModuleSpan range) noexcept
             {
-                return std::unexpected(Error{ErrorCode::InvalidArg, "scan::resolve"});
+                if (request.hint_rva == 0 || request.hint_window == 0 || request.regions != nullptr ||
+                    request.hint_rva >= range.end - range.base)
+                {
+                    return {};
+                }
+                const std::uintptr_t center = range.base + static_cast<std::uintptr_t>(request.hint_rva);
+                const std::uintptr_t lo = (center - range.base > request.hint_window) ? center - request.hint_window
+                                                                                      : range.base;
+                const std::uintptr_t hi = (range.end - center > request.hint_window) ? center + request.hint_window
+                                                                                     : range.end;
+                return detail::ModuleSpan{lo, hi};
             }
-            const detail::ModuleSpan range = detail::module_span(request.scope);
-            if (!range.valid())
+
+            // Tries the byte tiers, in ladder order, inside the hint @p window only. The accept rules are the full
+            // ladder's -- complete sweep, no second occurrence when require_unique, resolved address inside the whole
+            // scope and past the executable gate -- with uniqueness proved over the window rather than the scope. The
+            // window is small, so it scans serially with a histogram sampled from the window itself. A win is
+            // recorded to the cache like any byte-tier win.
+            std::optional<Hit> resolve_in_hint_window(const ScanRequest &request, detail::ModuleSpan range,
+                                                      detail::ModuleSpan window, std::span<const std::size_t> order,
+                                                      const detail::CacheProbe &cached)
             {
-                return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve"});
+                const Region window_region{Address{window.base}, static_cast<std::size_t>(window.end - window.base)};
+                std::optional<detail::HaystackHistogram> histogram;
+                for (const std::size_t index : order)
+                {
+                    const Candidate &candidate = request.ladder[index];
+                    const Pattern *pattern = byte_pattern_of(candidate);
+                    if (pattern == nullptr)
+                    {
+                        continue;
+                    }
+                    if (!histogram)
+                    {
+                        histogram = detail::sample_haystack(window_region, request.pages);
+                    }
+                    const detail::EnginePattern compiled = detail::to_engine_pattern(*pattern, *histogram);
+                    const detail::MatchResult first = detail::scan_module_pages(compiled, window, request.pages, 1);
+                    if (first.match == nullptr || first.incomplete)
+                    {
+                        continue;
+                    }
+                    if (request.require_unique)
+                    {
+                        const detail::MatchResult second =
+                            detail::scan_module_pages(compiled, window, request.pages, 2);
+                        if (second.match != nullptr || second.incomplete)
+                        {
+                            continue;
+                        }
+                    }
+                    const auto match = reinterpret_cast<std::uintptr_t>(first.match);
+                    const std::optional<std::uintptr_t> resolved = resolve_byte_candidate(match, candidate);
+                    if (!resolved || !range.contains(*resolved) ||
+                        !accepts_resolved_address(request, Address{*resolved}))
+                    {
+                        continue;
+                    }
+                    if (request.cache != nullptr)
+                    {
+                        detail::ResolutionCacheAccess::record(*request.cache, request, cached, index, match, *resolved,
+                                                              range);
+                    }
+                    return Hit{Address{*resolved}, candidate.name(), HitSource::HintWindow};
+                }
+                return std::nullopt;
             }
+        } // namespace
 
-            // Lay out the try order once. The haystack histogram is sampled lazily on the first byte candidate and
-            // shared across every byte candidate in the ladder, since they all scan the same scope.
-            std::vector<std::size_t> order(request.ladder.size());
-            const std::size_t ordered_count = order_candidates(request.order, request.ladder, order);
-            std::optional<detail::HaystackHistogram> histogram;
+        namespace
+        {
+            // What a tier shares with its siblings in one resolve: the batch prescan slot and the scope's spans.
+            struct TierScope
+            {
+                const detail::LadderPrescan *prescan = nullptr;
+                std::size_t request_index = 0;
+                std::span<const detail::ModuleSpan> spans;
+            };
 
-            for (std::size_t k = 0; k < ordered_count; ++k)
+            // A tier that resolved and passed every gate. The match point is kept for the cache record, which the
+            // caller makes once it has settled on this tier.
+            struct TierWin
             {
-                const Candidate &candidate = request.ladder[order[k]];
+                Hit hit;
+                std::uintptr_t match = 0;
+                bool byte_tier = false;
+            };
+
+            // The byte tiers' shared histogram, sampled from the request's whole scope (the widest span of a set).
+            [[nodiscard]] detail::HaystackHistogram sample_request_haystack(const ScanRequest &request) noexcept
+            {
+                return (request.regions != nullptr) ? detail::sample_haystack(*request.regions, request.pages)
+                                                    : detail::sample_haystack(request.scope, request.pages);
+            }
+
+            // Runs ladder entry @p index through its backend and the shared accept rules. @p histogram is sampled on
+            // the first byte tier that needs it and reused after. @p settled, when non-null, is a race's lowest winning
+            // position so far: once it drops below @p position this tier can no longer be the answer, and it stops
+            // before its second (uniqueness) scan.
+            std::optional<TierWin> try_tier(const ScanRequest &request, const TierScope &scope, std::size_t index,
+                                            std::optional<detail::HaystackHistogram> &histogram,
+                                            const std::atomic<std::size_t> *settled = nullptr,
+                                            std::size_t position = 0, bool *was_ambiguous = nullptr)
+            {
+                const Candidate &candidate = request.ladder[index];
+                const auto in_scope = [&scope](std::uintptr_t address) noexcept
+                { return detail::spans_contain(scope.spans, address); };
 
                 if (const RttiVtable *rtti = candidate.as_rtti_vtable())
                 {
                     // Fully qualify the namespace: the local `rtti` pointer would otherwise shadow the `rtti` module
                     // namespace and make `rtti::vtable_for_type` name the variable instead.
                     const std::optional<Address> vtable =
-                        DetourModKit::rtti::vtable_for_type(rtti->mangled, request.scope);
-                    if (vtable && range.contains(vtable->raw()) && accepts_resolved_address(request, *vtable))
+                        resolve_text_tier(request, [rtti](Region range)
+                                          { return DetourModKit::rtti::vtable_for_type(rtti->mangled, range); });
+                    if (vtable && in_scope(vtable->raw()) && accepts_resolved_address(request, *vtable))
                     {
-                        Hit hit{*vtable, candidate.name()};
-                        log_resolved(request, hit, false);
-                        return hit;
+                        return TierWin{Hit{*vtable, candidate.name()}};
                     }
-                    continue;
+                    return std::nullopt;
                 }
                 if (const StringXref *xref = candidate.as_string_xref())
                 {
@@ -190,14 +314,18 @@ namespace DetourModKit
                         .return_mode = xref->return_mode,
                         .broad_match = xref->broad_match,
                     };
-                    const Result<Address> site = find_string_xref(query, request.scope);
-                    if (site && range.contains(site->raw()) && accepts_resolved_address(request, *site))
+                    const std::optional<Address> site = resolve_text_tier(
+                        request,
+                        [&query](Region range) -> std::optional<Address>
+                        {
+                            const Result<Address> found = find_string_xref(query, range);
+                            return found ? std::optional<Address>{*found} : std::nullopt;
+                        });
+                    if (site && in_scope(site->raw()) && accepts_resolved_address(request, *site))
                     {
-                        Hit hit{*site, candidate.name()};
-                        log_resolved(request, hit, false);
-                        return hit;
+                        return TierWin{Hit{*site, candidate.name()}};
                     }
-                    continue;
+                    return std::nullopt;
                 }
 
                 // Byte tiers (Direct / RipRelative).
@@ -205,110 +333,620 @@ namespace DetourModKit
                 if (pattern == nullptr)
                 {
                     // Unreachable through the factories (every alternative is handled above); skip defensively.
-                    continue;
-                }
-                if (!histogram)
-                {
-                    histogram = detail::sample_haystack(request.scope);
+                    return std::nullopt;
                 }
-                const detail::EnginePattern compiled = detail::to_engine_pattern(*pattern, *histogram);
-
                 // Honour the request's page class: Readable sweeps code + data, while Executable narrows to code pages
-                // so an instruction signature cannot alias an identical run in data.
-                const detail::MatchResult first = detail::scan_module_pages(compiled, range, request.pages, 1);
-                if (first.match == nullptr)
+                // so an instruction signature cannot alias an identical run in data. A batch prescan already swept
+                // this candidate under the same scope and page class, so read both occurrences from it.
+                detail::MatchResult first{};
+                bool incomplete = false;
+                bool ambiguous = false;
+                const detail::MultiMatchResult *swept =
+                    (scope.prescan != nullptr) ? detail::prescanned_match(*scope.prescan, scope.request_index, index)
+                                               : nullptr;
+                if (swept != nullptr)
                 {
-                    continue;
+                    first = detail::MatchResult{swept->match, swept->incomplete};
+                    if (first.match == nullptr)
+                    {
+                        return std::nullopt;
+                    }
+                    incomplete = first.incomplete;
+                    if (request.require_unique)
+                    {
+                        ambiguous = swept->next != nullptr;
+                        incomplete = incomplete || swept->next_incomplete;
+                    }
                 }
-                bool incomplete = first.incomplete;
-                bool ambiguous = false;
-                if (request.require_unique)
+                else
                 {
-                    const detail::MatchResult second = detail::scan_module_pages(compiled, range, request.pages, 2);
-                    ambiguous = second.match != nullptr;
-                    incomplete = incomplete || second.incomplete;
+                    if (!histogram)
+                    {
+                        histogram = sample_request_haystack(request);
+                    }
+                    const detail::EnginePattern compiled = detail::to_engine_pattern(*pattern, *histogram);
+                    // Unprescanned candidates of a large scope split across the cores; the split stays serial when
+                    // this resolve already runs on a fork-join worker.
+                    first = detail::scan_module_set_split(compiled, scope.spans, request.pages, 1);
+                    if (first.match == nullptr)
+                    {
+                        return std::nullopt;
+                    }
+                    incomplete = first.incomplete;
+                    if (request.require_unique)
+                    {
+                        if (settled != nullptr && settled->load(std::memory_order_relaxed) < position)
+                        {
+                            return std::nullopt;
+                        }
+                        const detail::MatchResult second =
+                            detail::scan_module_set_split(compiled, scope.spans, request.pages, 2);
+                        ambiguous = second.match != nullptr;
+                        incomplete = incomplete || second.incomplete;
+                    }
                 }
                 if (incomplete)
                 {
                     // A skipped faulted region or a bounded-jump budget truncation makes the occurrence count a lower
                     // bound. A hidden earlier match or duplicate could exist in unscanned bytes, so accepting this
                     // candidate would turn an incomplete sweep into a wrong address.
-                    continue;
+                    return std::nullopt;
                 }
                 if (ambiguous)
                 {
                     // Ambiguous in scope: the lowest-address match is not provably the intended target, so fall through
                     // to the next candidate rather than commit to an arbitrary site.
-                    continue;
+                    if (was_ambiguous != nullptr)
+                    {
+                        *was_ambiguous = true;
+                    }
+                    return std::nullopt;
                 }
-                const std::optional<std::uintptr_t> resolved =
-                    resolve_byte_candidate(reinterpret_cast<std::uintptr_t>(first.match), candidate);
-                if (!resolved || !range.contains(*resolved) || !accepts_resolved_address(request, Address{*resolved}))
+                const auto match = reinterpret_cast<std::uintptr_t>(first.match);
+                const std::optional<std::uintptr_t> resolved = resolve_byte_candidate(match, candidate);
+                if (!resolved || !in_scope(*resolved) || !accepts_resolved_address(request, Address{*resolved}))
                 {
                     // A RipRelative displacement can resolve outside the scanned scope (e.g. an import thunk in another
                     // module); reject it here so the ladder falls through instead of committing out of scope.
-                    continue;
+                    return std::nullopt;
                 }
-                Hit hit{Address{*resolved}, candidate.name()};
-                log_resolved(request, hit, false);
-                return hit;
+                return TierWin{Hit{Address{*resolved}, candidate.name()}, match, true};
             }
 
-            if (request.fallback_policy != FallbackPolicy::Off)
+            // A finished race: the winning ordered position and its win, or no win when every tier missed.
+            struct RaceOutcome
+            {
+                std::size_t position = 0;
+                std::optional<TierWin> win;
+            };
+
+            // Runs the ordered tiers concurrently on the fork-join pool and picks the lowest-positioned winner, which
+            // is exactly the tier the serial walk would have stopped at: a tier that loses to an earlier one is
+            // ignored, and a tier can only be skipped once an earlier position has already won. nullopt means the
+            // race did not run (nested in a batch worker, a one-tier ladder, or a failed allocation) or could not
+            // vouch for its answer because a tier threw; the caller then walks the ladder serially.
+            std::optional<RaceOutcome> race_tiers(const ScanRequest &request, const TierScope &scope,
+                                                  std::span<const std::size_t> tried,
+                                                  std::optional<detail::HaystackHistogram> &histogram) noexcept
             {
-                const detail::FallbackOutcome fallback = detail::resolve_prologue_fallback(
-                    request, std::span<const std::size_t>{order.data(), ordered_count}, range);
-                if (fallback.hit && accepts_resolved_address(request, fallback.hit->address))
+                if (tried.size() < 2 || detail::in_fork_join_worker())
                 {
-                    if (fallback.identity_warned)
+                    return std::nullopt;
+                }
+                try
+                {
+                    // Sample up front so the workers only ever read the histogram.
+                    if (!histogram)
+                    {
+                        histogram = sample_request_haystack(request);
+                    }
+                    std::atomic<std::size_t> settled{tried.size()};
+                    std::atomic<bool> faulted{false};
+                    // Tier workers are other threads, so hand them the caller's installed snapshots explicitly.
+                    const std::span<const detail::PageSnapshot> snapshots = detail::installed_page_snapshots();
+                    const std::size_t *first_index = tried.data();
+                    using RaceSlot = std::optional<TierWin>;
+                    std::vector<RaceSlot> wins = detail::run_fork_join<std::size_t, RaceSlot>(
+                        tried, 0,
+                        [&](const std::size_t &index) -> RaceSlot
+                        {
+                            const detail::ScopedPageSnapshots install(snapshots);
+                            const auto position = static_cast<std::size_t>(&index - first_index);
+                            if (settled.load(std::memory_order_relaxed) < position)
+                            {
+                                return std::nullopt;
+                            }
+                            try
+                            {
+                                RaceSlot win = try_tier(request, scope, index, histogram, &settled, position);
+                                if (win)
+                                {
+                                    std::size_t current = settled.load(std::memory_order_relaxed);
+                                    while (position < current &&
+                                           !settled.compare_exchange_weak(current, position, std::memory_order_relaxed))
+                                    {
+                                    }
+                                }
+                                return win;
+                            }
+                            catch (...)
+                            {
+                                faulted.store(true, std::memory_order_relaxed);
+                                return std::nullopt;
+                            }
+                        },
+                        [](const std::size_t &) noexcept -> RaceSlot { return std::nullopt; });
+                    if (faulted.load(std::memory_order_relaxed))
                     {
-                        log_identity_warning(request, *fallback.hit);
+                        return std::nullopt;
+                    }
+                    for (std::size_t position = 0; position < wins.size(); ++position)
+                    {
+                        if (wins[position])
+                        {
+                            return RaceOutcome{position, std::move(wins[position])};
+                        }
                     }
-                    log_resolved(request, *fallback.hit, true);
-                    return *fallback.hit;
+                    return RaceOutcome{};
                 }
-                if (fallback.identity_rejected)
+                catch (...)
                 {
-                    // RequireIdentity refused every structurally-recovered site: the rebuilt prologue matched uniquely,
-                    // but no recovered address passed the witness. Distinct from a plain miss so the caller learns that
-                    // a hooked near-twin exists and the signature needs a sharper witness or corroborating landmark.
-                    log_unresolved(request, "prologue recovery rejected by identity gate");
-                    return std::unexpected(Error{ErrorCode::PrologueIdentityRejected, "scan::resolve"});
+                    return std::nullopt;
                 }
-                if (fallback.had_direct && fallback.not_applicable)
+            }
+
+            // The Adaptive order: a stable sort of the static permutation @p tried by each tier's @p history. Tiers
+            // that have resolved lead, the more reliable first and then the cheaper per attempt; untried tiers keep
+            // their place behind them; tiers that have only missed or matched ambiguously go last. Ties keep the
+            // static order, so a request with no history at all is tried exactly as UniqueFirst.
+            void adapt_candidate_order(std::span<std::size_t> tried, std::span<const TierStats> history) noexcept
+            {
+                const auto rank = [history](std::size_t index) noexcept
                 {
-                    // A Direct candidate existed to rebuild, but its literal tail was too short for any shape. This is
-                    // a distinct diagnostic from a plain miss (a name/string/RipRelative-only ladder has no Direct
-                    // row).
-                    log_unresolved(request, "prologue recovery had no rebuildable Direct candidate");
-                    return std::unexpected(Error{ErrorCode::PrologueFallbackNotApplicable, "scan::resolve"});
+                    const TierStats &stats = history[index];
+                    if (stats.hits != 0)
+                    {
+                        return 0;
+                    }
+                    return stats.attempts() == 0 ? 1 : 2;
+                };
+                std::ranges::stable_sort(tried,
+                                         [&](std::size_t a, std::size_t b) noexcept
+                                         {
+                                             const int rank_a = rank(a);
+                                             const int rank_b = rank(b);
+                                             if (rank_a != rank_b || rank_a != 0)
+                                             {
+                                                 return rank_a < rank_b;
+                                             }
+                                             // Compare hit rates and mean costs cross-multiplied, with no division.
+                                             const TierStats &lhs = history[a];
+                                             const TierStats &rhs = history[b];
+                                             const std::uint64_t lhs_rate = std::uint64_t{lhs.hits} * rhs.attempts();
+                                             const std::uint64_t rhs_rate = std::uint64_t{rhs.hits} * lhs.attempts();
+                                             if (lhs_rate != rhs_rate)
+                                             {
+                                                 return lhs_rate > rhs_rate;
+                                             }
+                                             return lhs.micros * rhs.attempts() < rhs.micros * lhs.attempts();
+                                         });
+            }
+
+            // The one resolver body behind resolve() and resolve_batch(). @p prescan, when non-null, holds byte-tier
+            // occurrences swept for the whole batch (see detail::prescan_ladders); a candidate with a swept slot reads
+            // its first / second occurrence from it instead of walking the scope twice. Every accept / reject decision
+            // below is shared, so a prescanned and an unprescanned resolve cannot diverge.
+            Result<Hit> resolve_request(const ScanRequest &request, const detail::LadderPrescan *prescan,
+                                        std::size_t request_index)
+            {
+                if (request.cache == nullptr)
+                {
+                    if (ResolutionCache *const reload = detail::reload_resolution_cache(); reload != nullptr)
+                    {
+                        ScanRequest with_reload = request;
+                        with_reload.cache = reload;
+                        return resolve_request(with_reload, prescan, request_index);
+                    }
+                }
+                if (request.ladder.empty())
+                {
+                    return std::unexpected(Error{ErrorCode::EmptyCandidates, "scan::resolve"});
+                }
+                if (request.pages != Pages::Readable && request.pages != Pages::Executable)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "scan::resolve"});
+                }
+                // A RegionSet scope resolves within its spans; a Region scope is the one-span case of the same code.
+                std::vector<detail::ModuleSpan> set_spans;
+                detail::ModuleSpan range{};
+                if (request.regions != nullptr)
+                {
+                    if (request.regions->empty())
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve"});
+                    }
+                    set_spans = detail::module_spans(*request.regions);
+                    // The batch prescan sweeps one Region per group and never a set, so there is nothing to read.
+                    prescan = nullptr;
+                }
+                else
+                {
+                    range = detail::module_span(request.scope);
+                    if (!range.valid())
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidRange, "scan::resolve"});
+                    }
                 }
+                const std::span<const detail::ModuleSpan> spans =
+                    (request.regions != nullptr) ? std::span<const detail::ModuleSpan>(set_spans)
+                                                 : std::span<const detail::ModuleSpan>(&range, 1);
+                // A warm cache entry whose pattern still matches at its remembered site is re-derived and gated like
+                // a fresh match; anything it fails falls through to the full ladder, whose win then replaces it.
+                detail::CacheProbe cached{};
+                if (request.cache != nullptr && request.regions == nullptr)
+                {
+                    cached = detail::ResolutionCacheAccess::probe(*request.cache, request, range);
+                    if (cached.candidate_index)
+                    {
+                        const Candidate &candidate = request.ladder[*cached.candidate_index];
+                        const std::optional<std::uintptr_t> resolved =
+                            resolve_byte_candidate(cached.match_point, candidate);
+                        const bool accepted = resolved && *resolved == cached.resolved && range.contains(*resolved) &&
+                                              accepts_resolved_address(request, Address{*resolved});
+                        detail::ResolutionCacheAccess::settle(*request.cache, cached, accepted);
+                        if (accepted)
+                        {
+                            Hit hit{Address{*resolved}, candidate.name(), HitSource::Cache};
+                            log_resolved(request, hit, false);
+                            return hit;
+                        }
+                    }
+                }
+
+                // Lay out the try order once. The haystack histogram is sampled lazily on the first byte candidate and
+                // shared across every byte candidate in the ladder, since they all scan the same scope.
+                std::vector<std::size_t> order(request.ladder.size());
+                const std::size_t ordered_count = order_candidates(request.order, request.ladder, order);
+                const std::span<const std::size_t> tried{order.data(), ordered_count};
+                std::optional<detail::HaystackHistogram> histogram;
+
+                // Adaptive refines the static order from the request's tier history in its cache, and the serial walk
+                // below feeds every attempt back. A set-scoped request keeps no history, like it keeps no entry.
+                const bool adaptive =
+                    request.order == CandidateOrder::Adaptive && request.cache != nullptr && request.regions == nullptr;
+                std::vector<detail::TierOutcome> outcomes;
+                if (adaptive)
+                {
+                    std::vector<TierStats> history(request.ladder.size());
+                    if (detail::ResolutionCacheAccess::tier_history(*request.cache, request, history))
+                    {
+                        adapt_candidate_order(std::span<std::size_t>{order.data(), ordered_count}, history);
+                    }
+                    outcomes.reserve(ordered_count);
+                }
+
+                // Locality hint: a patch usually moves a site only a little, so the byte tiers first try the small
+                // window around its last-seen offset. Anything the window cannot answer falls through to the ladder.
+                if (const detail::ModuleSpan window = hint_window_of(request, range); window.valid())
+                {
+                    if (std::optional<Hit> hit = resolve_in_hint_window(request, range, window, tried, cached))
+                    {
+                        log_resolved(request, *hit, false);
+                        return std::move(*hit);
+                    }
+                }
+
+                const TierScope tier_scope{prescan, request_index, spans};
+                const auto accept_win = [&](std::size_t index, TierWin &win) -> Hit
+                {
+                    if (win.byte_tier && request.cache != nullptr && request.regions == nullptr)
+                    {
+                        detail::ResolutionCacheAccess::record(*request.cache, request, cached, index, win.match,
+                                                              win.hit.address.raw(), range);
+                    }
+                    log_resolved(request, win.hit, false);
+                    return std::move(win.hit);
+                };
+
+                // A race settles on the same tier the serial walk below would; it only overlaps the tiers' scans.
+                // When it proves every tier a miss the walk is skipped, and when it cannot run the walk does it all.
+                bool ordered_tiers_missed = false;
+                if (request.race_tiers)
+                {
+                    if (std::optional<RaceOutcome> raced = race_tiers(request, tier_scope, tried, histogram))
+                    {
+                        if (raced->win)
+                        {
+                            return accept_win(tried[raced->position], *raced->win);
+                        }
+                        ordered_tiers_missed = true;
+                    }
+                }
+                // Only this walk feeds the history: a race's losing tiers stop early, so their outcome and cost are
+                // not what the tier would have done alone.
+                const auto record_outcomes = [&]() noexcept
+                {
+                    if (adaptive)
+                    {
+                        detail::ResolutionCacheAccess::record_tiers(*request.cache, request, outcomes);
+                    }
+                };
+                for (std::size_t k = 0; k < ordered_count && !ordered_tiers_missed; ++k)
+                {
+                    const std::chrono::steady_clock::time_point started =
+                        adaptive ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point{};
+                    bool ambiguous = false;
+                    std::optional<TierWin> win = try_tier(request, tier_scope, order[k], histogram, nullptr, 0,
+                                                          adaptive ? &ambiguous : nullptr);
+                    if (adaptive)
+                    {
+                        const detail::TierVerdict verdict = win         ? detail::TierVerdict::Resolved
+                                                            : ambiguous ? detail::TierVerdict::Ambiguous
+                                                                        : detail::TierVerdict::Missed;
+                        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - started);
+                        // Reserved above, so this never reallocates.
+                        outcomes.push_back(detail::TierOutcome{order[k], verdict,
+                                                               static_cast<std::uint64_t>(elapsed.count())});
+                    }
+                    if (win)
+                    {
+                        record_outcomes();
+                        return accept_win(order[k], *win);
+                    }
+                }
+                record_outcomes();
+
+                if (request.fallback_policy != FallbackPolicy::Off)
+                {
+                    const detail::FallbackOutcome fallback = detail::resolve_prologue_fallback(
+                        request, std::span<const std::size_t>{order.data(), ordered_count}, spans);
+                    if (fallback.hit && accepts_resolved_address(request, fallback.hit->address))
+                    {
+                        if (fallback.identity_warned)
+                        {
+                            log_identity_warning(request, *fallback.hit);
+                        }
+                        log_resolved(request, *fallback.hit, true);
+                        return *fallback.hit;
+                    }
+                    if (fallback.identity_rejected)
+                    {
+                        // RequireIdentity refused every structurally-recovered site: the rebuilt prologue matched
+                        // uniquely, but no recovered address passed the witness. Distinct from a plain miss so the
+                        // caller learns that a hooked near-twin exists and the signature needs a sharper witness or
+                        // corroborating landmark.
+                        log_unresolved(request, "prologue recovery rejected by identity gate");
+                        return std::unexpected(Error{ErrorCode::PrologueIdentityRejected, "scan::resolve"});
+                    }
+                    if (fallback.had_direct && fallback.not_applicable)
+                    {
+                        // A Direct candidate existed to rebuild, but its literal tail was too short for any shape. This
+                        // is a distinct diagnostic from a plain miss (a name/string/RipRelative-only ladder has no
+                        // Direct row).
+                        log_unresolved(request, "prologue recovery had no rebuildable Direct candidate");
+                        return std::unexpected(Error{ErrorCode::PrologueFallbackNotApplicable, "scan::resolve"});
+                    }
+                }
+
+                log_unresolved(request, "no ladder candidate resolved uniquely in scope");
+                return std::unexpected(Error{ErrorCode::NoMatch, "scan::resolve"});
             }
 
-            log_unresolved(request, "no ladder candidate resolved uniquely in scope");
-            return std::unexpected(Error{ErrorCode::NoMatch, "scan::resolve"});
-        }
+            // One page snapshot per distinct scope in the batch -- usually just the host image -- so each request's
+            // page walks replay one VirtualQuery pass instead of repeating it. Purely an accelerator: a capture that
+            // cannot allocate leaves the batch walking the page map live.
+            std::vector<detail::PageSnapshot> snapshot_batch_scopes(std::span<const ScanRequest> requests) noexcept
+            {
+                std::vector<detail::PageSnapshot> snapshots;
+                if (requests.size() < 2)
+                {
+                    return snapshots;
+                }
+                try
+                {
+                    for (const ScanRequest &request : requests)
+                    {
+                        if (request.regions == nullptr)
+                        {
+                            detail::add_page_snapshot(snapshots, detail::module_span(request.scope));
+                            continue;
+                        }
+                        for (const Region &range : request.regions->ranges())
+                        {
+                            detail::add_page_snapshot(snapshots, detail::module_span(range));
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    snapshots.clear();
+                }
+                return snapshots;
+            }
 
-        Result<std::vector<Result<Hit>>> resolve_batch(std::span<const ScanRequest> requests,
-                                                       std::size_t max_workers) noexcept
-        {
-            try
+            // resolve_batch's scheduling hint: the bytes a request's scopes span, times the tiers that may each sweep
+            // them. Only the ratio between requests matters.
+            std::uint64_t request_scan_cost(const ScanRequest &request) noexcept
+            {
+                std::uint64_t bytes = 0;
+                const auto add_scope = [&bytes](const Region &range) noexcept
+                {
+                    const detail::ModuleSpan span = detail::module_span(range);
+                    if (span.valid())
+                    {
+                        bytes += span.end - span.base;
+                    }
+                };
+                if (request.regions == nullptr)
+                {
+                    add_scope(request.scope);
+                }
+                else
+                {
+                    for (const Region &range : request.regions->ranges())
+                    {
+                        add_scope(range);
+                    }
+                }
+                return bytes * std::max<std::uint64_t>(request.ladder.size(), 1);
+            }
+
+            // Hands every StringXref tier of the batch to the literal prescan, so phase 1 of each string resolve reads
+            // its occurrences from one multi-literal sweep per image. The query views alias the candidates' owned
+            // literals, which outlive the call.
+            void prescan_batch_literals(detail::XrefIndexCache &cache, std::span<const ScanRequest> requests) noexcept
+            {
+                try
+                {
+                    std::vector<detail::StringLiteralQuery> literals;
+                    for (const ScanRequest &request : requests)
+                    {
+                        // A set-scoped string tier resolves span by span, which the per-image prescan cannot key.
+                        if (request.regions != nullptr)
+                        {
+                            continue;
+                        }
+                        for (const Candidate &candidate : request.ladder)
+                        {
+                            if (const StringXref *xref = candidate.as_string_xref())
+                            {
+                                literals.push_back(detail::StringLiteralQuery{
+                                    .query = StringRefQuery{.text = xref->text,
+                                                            .encoding = xref->encoding,
+                                                            .require_terminator = xref->require_terminator},
+                                    .range = detail::module_span(request.scope),
+                                });
+                            }
+                        }
+                    }
+                    if (literals.size() >= detail::STRING_PRESCAN_MIN_LITERALS)
+                    {
+                        detail::prescan_string_literals(cache, literals);
+                    }
+                }
+                catch (...)
+                {
+                    // Without the prescan each string tier locates its own literal.
+                }
+            }
+
+            // The shared body of every resolve_batch overload: prescans the batch and resolves it into @p out, one slot
+            // per request. Throws only std::bad_alloc from the (costed) batch plan; every slot then holds its NoMatch
+            // seed.
+            void resolve_batch_into(std::span<const ScanRequest> requests, std::span<Result<Hit>> out,
+                                    const BatchOptions &options)
             {
-                return detail::run_fork_join<ScanRequest, Result<Hit>>(
-                    requests, max_workers,
-                    [](const ScanRequest &request) -> Result<Hit>
+                // Installed before the prescans so their sweeps stop with the batch too.
+                detail::BatchCancel cancel(options.stop);
+                const detail::ScopedBatchCancel install_cancel(&cancel);
+                const auto mandatory = [&options](std::size_t index) noexcept
+                { return options.mandatory.empty() || (index < options.mandatory.size() && options.mandatory[index]); };
+
+                // A large batch is pre-swept once: every eligible byte candidate sharing a scope is verified in a
+                // single pass over the image, so the startup cost tracks the image size rather than pattern count x
+                // image size. The prescan is purely an accelerator, so failing to build it under memory pressure
+                // degrades to the per-request scans rather than failing the batch, and a batch too small to reach the
+                // sweep threshold skips it before allocating anything.
+                std::size_t candidate_total = 0;
+                for (const ScanRequest &request : requests)
+                {
+                    candidate_total += request.ladder.size();
+                }
+                const std::vector<detail::PageSnapshot> snapshots = snapshot_batch_scopes(requests);
+                // String-xref tiers across the batch share one reference index per image, built by whichever worker
+                // asks first; see internal/scan_xref_index.hpp.
+                detail::XrefIndexCache xref_index;
+                {
+                    const detail::ScopedPageSnapshots install(snapshots);
+                    prescan_batch_literals(xref_index, requests);
+                }
+                detail::LadderPrescan prescan;
+                if (candidate_total >= detail::MULTI_SCAN_MIN_PATTERNS)
+                {
+                    try
                     {
+                        const detail::ScopedPageSnapshots install(snapshots);
+                        prescan = detail::prescan_ladders(requests);
+                    }
+                    catch (...)
+                    {
+                        prescan = detail::LadderPrescan{};
+                    }
+                }
+                const ScanRequest *first_request = requests.data();
+                detail::run_fork_join_into<ScanRequest, Result<Hit>>(
+                    requests, out, options.max_workers,
+                    [&](const ScanRequest &request) -> Result<Hit>
+                    {
+                        const detail::ScopedPageSnapshots install(snapshots);
+                        const detail::ScopedXrefIndexCache install_index(&xref_index);
+                        // run_fork_join hands each worker a reference into the caller's span, so the request's index is
+                        // its distance from the first element.
+                        const auto index = static_cast<std::size_t>(&request - first_request);
+                        Result<Hit> hit;
                         try
                         {
-                            return resolve(request);
+                            hit = detail::resolve_prescanned(request, prescan, index);
                         }
                         catch (const std::bad_alloc &)
                         {
-                            return std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_batch"});
+                            hit = std::unexpected(Error{ErrorCode::OutOfMemory, "scan::resolve_batch"});
+                        }
+                        if (!hit && cancel.cancelled())
+                        {
+                            // Tested before this miss can trip the batch: the miss that cancels keeps its own error,
+                            // and one whose walk the cancellation cut short reports that instead of a false NoMatch.
+                            return std::unexpected(Error{ErrorCode::Cancelled, "scan::resolve_batch"});
+                        }
+                        if (!hit && options.fail_fast && mandatory(index))
+                        {
+                            cancel.cancel();
                         }
+                        return hit;
                     },
                     [](const ScanRequest &) noexcept -> Result<Hit>
-                    { return std::unexpected(Error{ErrorCode::NoMatch, "scan::resolve_batch"}); });
+                    {
+                        const ErrorCode code = detail::batch_cancelled() ? ErrorCode::Cancelled : ErrorCode::NoMatch;
+                        return std::unexpected(Error{code, "scan::resolve_batch"});
+                    },
+                    [](const ScanRequest &request) noexcept { return request_scan_cost(request); });
+            }
+        } // namespace
+
+        Result<Hit> resolve(const ScanRequest &request)
+        {
+            detail::TelemetryScope telemetry;
+            Result<Hit> hit = resolve_request(request, nullptr, 0);
+            if (hit.has_value())
+            {
+                hit->telemetry = telemetry.snapshot();
+            }
+            return hit;
+        }
+
+        Result<std::vector<Result<Hit>>> resolve_batch(std::span<const ScanRequest> requests,
+                                                       std::size_t max_workers) noexcept
+        {
+            return resolve_batch(requests, BatchOptions{.max_workers = max_workers});
+        }
+
+        Result<void> resolve_batch(std::span<const ScanRequest> requests, std::span<Result<Hit>> out,
+                                   std::size_t max_workers) noexcept
+        {
+            return resolve_batch(requests, out, BatchOptions{.max_workers = max_workers});
+        }
+
+        Result<std::vector<Result<Hit>>> resolve_batch(std::span<const ScanRequest> requests,
+                                                       const BatchOptions &options) noexcept
+        {
+            try
+            {
+                // One batch is one telemetry operation; each request's own work still lands on its Hit.
+                detail::TelemetryScope telemetry;
+                std::vector<Result<Hit>> results(requests.size());
+                resolve_batch_into(requests, results, options);
+                return results;
             }
             catch (const std::bad_alloc &)
             {
@@ -323,5 +961,56 @@ namespace DetourModKit
                 return std::unexpected(Error{ErrorCode::Unknown, "scan::resolve_batch"});
             }
         }
+
+        Result<void> resolve_batch(std::span<const ScanRequest> requests, std::span<Result<Hit>> out,
+                                   const BatchOptions &options) noexcept
+        {
+            if (out.size() < requests.size())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "scan::resolve_batch", out.size()});
+            }
+            try
+            {
+                detail::TelemetryScope telemetry;
+                resolve_batch_into(requests, out.first(requests.size()), options);
+                return {};
+            }
+            catch (const std::bad_alloc &)
+            {
+                // The scratch failed before any request resolved, so no slot holds an answer worth keeping; mark them
+                // all with the batch's own failure rather than leave a mix of seeds and stale results.
+                const Error error{ErrorCode::OutOfMemory, "scan::resolve_batch"};
+                std::fill_n(out.begin(), requests.size(), Result<Hit>{std::unexpected(error)});
+                return std::unexpected(error);
+            }
+            catch (...)
+            {
+                const Error error{ErrorCode::Unknown, "scan::resolve_batch"};
+                std::fill_n(out.begin(), requests.size(), Result<Hit>{std::unexpected(error)});
+                return std::unexpected(error);
+            }
+        }
+
+        void set_worker_placement(const WorkerPlacement &placement) noexcept
+        {
+            detail::set_fork_join_placement(placement.background, placement.foreground_core_fraction);
+        }
+
+        WorkerPlacement worker_placement() noexcept
+        {
+            return WorkerPlacement{detail::fork_join_background(), detail::fork_join_foreground_core_fraction()};
+        }
     } // namespace scan
+
+    Result<scan::Hit> detail::resolve_prescanned(const scan::ScanRequest &request, const detail::LadderPrescan &prescan,
+                                                 std::size_t request_index)
+    {
+        detail::TelemetryScope telemetry;
+        Result<scan::Hit> hit = scan::resolve_request(request, &prescan, request_index);
+        if (hit.has_value())
+        {
+            hit->telemetry = telemetry.snapshot();
+        }
+        return hit;
+    }
 } // namespace DetourModKit
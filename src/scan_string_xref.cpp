@@ -4,35 +4,99 @@
  *        the unique instruction that references it.
  * @details Two fail-closed phases. Phase 1 locates the single occurrence of the query string in the image's readable
  *          pages (the page-gated readable scan). Phase 2 finds the single RIP-relative reference to that string: a
- *          fast, desync-immune shape scan for the dominant lea/mov forms by default, plus a Zydis-verified linear sweep
- *          for opt-in broad matches and derived-return uniqueness confirmation. Both phases resolve through the private
- *          engine page primitives. Zydis is confined to this TU: no public header exposes a Zydis type.
+ *          fast, desync-immune shape scan for the dominant lea/mov forms by default, plus a decoder-verified linear
+ *          sweep for opt-in broad matches and derived-return uniqueness confirmation. Both phases resolve through the
+ *          private engine page primitives. The sweep sizes instructions with the table-driven length decoder in
+ *          x86_decode.hpp; Zydis decodes only the StringPointerSlot store match and is confined to this TU: no public
+ *          header exposes a Zydis type.
  */
 
 #include "DetourModKit/scan.hpp"
 
+#include "internal/function_table.hpp"
 #include "internal/memory_fault.hpp"
 #include "internal/memory_guarded.hpp"
 #include "internal/scan_engine.hpp"
+#include "internal/scan_multi.hpp"
 #include "internal/scan_pages.hpp"
 #include "internal/scan_shared.hpp"
+#include "internal/scan_xref_index.hpp"
 
 #include "DetourModKit/logger.hpp"
 #include "DetourModKit/memory.hpp"
 
+#include "x86_decode.hpp"
+
 #include <windows.h>
 
 #include <Zydis/Zydis.h>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
+#include <mutex>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 namespace DetourModKit
 {
+    namespace detail
+    {
+        // One narrow-shape reference (a REX.W lea/mov [rip+disp32]) recorded by the batch index, with the register and
+        // window end the store-xref scan needs. Offsets are RVAs from the indexed module's base, which keeps an entry
+        // at 16 bytes; an image too large for 32-bit RVAs is never indexed.
+        struct NarrowXref
+        {
+            std::uint32_t target_rva = 0;
+            std::uint32_t site_rva = 0;
+            std::uint32_t window_end_rva = 0;
+            std::uint8_t reg = 0;
+            bool is_lea = false;
+        };
+
+        // One decoded instruction's RIP-relative memory operand, recorded once per (instruction, target).
+        struct BroadXref
+        {
+            std::uint32_t target_rva = 0;
+            std::uint32_t site_rva = 0;
+        };
+
+        // A reference table, built at most once and immutable afterwards. usable is false for an image whose extent
+        // does not fit 32-bit RVAs; incomplete is set when a window faulted while indexing, so every lookup of the
+        // table fails closed exactly as the per-query sweep over that window would have.
+        template <typename Entry> struct XrefTable
+        {
+            std::once_flag once;
+            bool usable = false;
+            bool incomplete = false;
+            std::vector<Entry> entries;
+        };
+
+        // One prescanned literal: its compiled bytes (the lookup key) and its first and second occurrence.
+        struct LiteralOccurrences
+        {
+            std::string key;
+            MultiMatchResult occurrences;
+        };
+
+        struct ModuleXrefIndex
+        {
+            ModuleSpan range{};
+            XrefTable<NarrowXref> narrow;
+            XrefTable<BroadXref> broad;
+            // Sorted by key. Written by prescan_string_literals before the batch's workers start, then read-only.
+            std::vector<LiteralOccurrences> literals;
+        };
+    } // namespace detail
+
     namespace scan
     {
         namespace
@@ -142,7 +206,7 @@ namespace DetourModKit
                     return;
                 }
                 (void)log().try_log(
-                    LogLevel::Debug,
+                    log_category::scan, LogLevel::Debug,
                     "scan::find_string_xref: skipped {} executable window(s) that faulted mid-scan (concurrent "
                     "decommit/reprotect).",
                     faulted_windows);
@@ -358,14 +422,14 @@ namespace DetourModKit
             }
 
             // Store-xref forward scan: starting just past a `lea reg, [rip+string]`, decode forward instruction by
-            // instruction (Zydis, the same decoder scan_string_ref_broad uses) and return the slot a `mov [rip+slot],
-            // reg` store caches the loaded pointer into, where reg is the lea destination. Decoding rather than a raw
-            // byte sweep keeps the match instruction-aligned and lets the scan stop the moment the loaded register is
-            // overwritten. The store shape is REX.W MOV [rip+disp32], reg64. The match is first-within-window, not
-            // uniqueness-checked, so the window is kept tight. Returns 0 (the caller maps it to StoreNotFound) on no
-            // store, a write to the loaded register, a CALL, an unconditional control transfer (JMP / RET), UD2, or an
-            // INT3, a decode failure, an unreadable byte, or the bound being hit. Reads go through
-            // detail::guarded_read_bytes so a truncated or unmapped tail cannot fault the host.
+            // instruction (with Zydis, which models the operand registers the broad sweep's length decoder does not)
+            // and return the slot a `mov [rip+slot], reg` store caches the loaded pointer into, where reg is the lea
+            // destination. Decoding rather than a raw byte sweep keeps the match instruction-aligned and lets the scan
+            // stop the moment the loaded register is overwritten. The store shape is REX.W MOV [rip+disp32], reg64.
+            // The match is first-within-window, not uniqueness-checked, so the window is kept tight. Returns 0 (the
+            // caller maps it to StoreNotFound) on no store, a write to the loaded register, a CALL, an unconditional
+            // control transfer (JMP / RET), UD2, or an INT3, a decode failure, an unreadable byte, or the bound being
+            // hit. Reads go through detail::guarded_read_bytes so a truncated or unmapped tail cannot fault the host.
             //
             // The scan must be control-flow-aware: the linear byte window can run past the end of this function into
             // the next one, and a store there caches an UNRELATED pointer. A `ret`, an unconditional `jmp` (a tail
@@ -490,23 +554,21 @@ namespace DetourModKit
                 return 0;
             }
 
-            // Inner broad scan of one already-gated executable window (no fault guard). Decodes each position with
-            // Zydis, counting RIP-relative operands whose absolute target equals string_addr; mutates found_count /
-            // first_site and returns once a second referencing site is seen. The decode/recovery contract is documented
-            // on scan_string_ref_broad.
-            void scan_window_broad_body(const ZydisDecoder &decoder, const detail::ExecutableWindow &window,
-                                        std::uintptr_t string_addr, std::uintptr_t count_floor,
-                                        std::size_t &found_count, std::uintptr_t &first_site) noexcept
+            // Inner broad scan of one already-gated executable window (no fault guard). Sizes each position with the
+            // table-driven length decoder, counting instructions whose RIP-relative operand targets string_addr;
+            // mutates found_count / first_site and returns once a second referencing site is seen. The decode/recovery
+            // contract is documented on scan_string_ref_broad.
+            void scan_window_broad_body(const detail::ExecutableWindow &window, std::uintptr_t string_addr,
+                                        std::uintptr_t count_floor, std::size_t &found_count,
+                                        std::uintptr_t &first_site) noexcept
             {
                 const auto *bytes = reinterpret_cast<const std::uint8_t *>(window.base);
                 std::size_t offset = 0;
                 while (offset < window.span)
                 {
-                    ZydisDecodedInstruction insn;
-                    ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT];
+                    detail::InsnShape insn;
                     const std::uintptr_t instr_addr = window.base + offset;
-                    if (!ZYAN_SUCCESS(
-                            ZydisDecoderDecodeFull(&decoder, bytes + offset, window.span - offset, &insn, operands)))
+                    if (!detail::decode_insn_shape(bytes + offset, window.span - offset, insn))
                     {
                         // Byte-restart recovery: realign past data / jump tables.
                         ++offset;
@@ -523,26 +585,10 @@ namespace DetourModKit
                     // base, so an un-extended window (count_floor == window.base) counts every instruction.
                     const bool already_counted_by_previous_window = instr_addr + insn.length <= count_floor;
 
-                    // A referencing instruction has a visible memory operand based on RIP whose absolute target is the
-                    // string. Visible operands are ordered first in the array, so iterating the visible count covers
-                    // every explicit operand a disassembler would show.
-                    bool references_string = false;
-                    for (std::size_t op = 0; op < insn.operand_count_visible; ++op)
-                    {
-                        const ZydisDecodedOperand &operand = operands[op];
-                        if (operand.type != ZYDIS_OPERAND_TYPE_MEMORY || operand.mem.base != ZYDIS_REGISTER_RIP)
-                        {
-                            continue;
-                        }
-                        ZyanU64 absolute = 0;
-                        if (ZYAN_SUCCESS(ZydisCalcAbsoluteAddress(&insn, &operand, static_cast<ZyanU64>(instr_addr),
-                                                                  &absolute)) &&
-                            static_cast<std::uintptr_t>(absolute) == string_addr)
-                        {
-                            references_string = true;
-                            break;
-                        }
-                    }
+                    // A referencing instruction has a [rip + disp32] memory operand whose absolute target is the
+                    // string. An instruction has at most one ModRM memory operand, so the decoder's single
+                    // RIP-relative flag covers every explicit operand a disassembler would show.
+                    const bool references_string = insn.rip_relative && insn.rip_target(instr_addr) == string_addr;
 
                     if (references_string && !already_counted_by_previous_window)
                     {
@@ -564,16 +610,16 @@ namespace DetourModKit
 
             // Window-granular TOCTOU fault guard around scan_window_broad_body; the narrow sibling
             // scan_window_narrow_guarded documents the rationale. Returns true when a fault was swallowed.
-            bool scan_window_broad_guarded(const ZydisDecoder &decoder, const detail::ExecutableWindow &window,
-                                           std::uintptr_t string_addr, std::uintptr_t count_floor,
-                                           std::size_t &found_count, std::uintptr_t &first_site) noexcept
+            bool scan_window_broad_guarded(const detail::ExecutableWindow &window, std::uintptr_t string_addr,
+                                           std::uintptr_t count_floor, std::size_t &found_count,
+                                           std::uintptr_t &first_site) noexcept
             {
 #ifdef _MSC_VER
                 const std::size_t original_found_count = found_count;
                 const std::uintptr_t original_first_site = first_site;
                 __try
                 {
-                    scan_window_broad_body(decoder, window, string_addr, count_floor, found_count, first_site);
+                    scan_window_broad_body(window, string_addr, count_floor, found_count, first_site);
                     return false;
                 }
                 __except (detail::guarded_fault_filter(GetExceptionInformation()))
@@ -591,19 +637,18 @@ namespace DetourModKit
                 const std::uintptr_t original_first_site = first_site;
                 struct BroadScanContext
                 {
-                    const ZydisDecoder *decoder;
                     const detail::ExecutableWindow *window;
                     std::uintptr_t string_addr;
                     std::uintptr_t count_floor;
                     std::size_t *found_count;
                     std::uintptr_t *first_site;
-                } scan_ctx{&decoder, &window, string_addr, count_floor, &found_count, &first_site};
+                } scan_ctx{&window, string_addr, count_floor, &found_count, &first_site};
 
                 const auto run_scan = [](void *opaque) noexcept -> void
                 {
                     auto *context = static_cast<BroadScanContext *>(opaque);
-                    scan_window_broad_body(*context->decoder, *context->window, context->string_addr,
-                                           context->count_floor, *context->found_count, *context->first_site);
+                    scan_window_broad_body(*context->window, context->string_addr, context->count_floor,
+                                           *context->found_count, *context->first_site);
                 };
 
                 if (detail::run_guarded_region(window.base, window.base + window.span, run_scan, &scan_ctx))
@@ -617,12 +662,13 @@ namespace DetourModKit
 #endif
             }
 
-            // Phase 2 ("broad") add-on for find_string_xref: a Zydis-verified linear sweep that recognizes the rarer
+            // Phase 2 ("broad") add-on for find_string_xref: a decoder-verified linear sweep that recognizes the rarer
             // RIP-relative reference shapes the narrow scan does not model -- cmp [rip+d], imm; push [rip+d]; a no-REX
             // lea/mov; any instruction whose memory operand is [rip+disp] and resolves to string_addr. The caller
             // merges this with the narrow scan so broad_match cannot lose coverage for the default lea/mov anchors.
             //
-            // The sweep decodes each position with the same decoder code_constant uses. x86-64 is not
+            // The sweep sizes each position with the table-driven length decoder (x86_decode.hpp): it needs only the
+            // length and the RIP-relative displacement, not the operand model Zydis builds. x86-64 is not
             // self-synchronizing, so on a decode failure the cursor advances one byte to realign (recovery); on success
             // it advances by the decoded instruction length, which is always >= 1 so the sweep cannot stall. Only a
             // RIP-relative operand whose absolute target exactly equals string_addr counts. That exact-target filter
@@ -635,24 +681,16 @@ namespace DetourModKit
                 incomplete = false;
                 std::uintptr_t first_site = 0;
 
-                ZydisDecoder decoder;
-                if (!ZYAN_SUCCESS(ZydisDecoderInit(&decoder, ZYDIS_MACHINE_MODE_LONG_64, ZYDIS_STACK_WIDTH_64)))
-                {
-                    // A decoder that will not initialize cannot verify any reference; fail closed as "no reference"
-                    // rather than guess a site.
-                    return 0;
-                }
-
                 std::size_t faulted_windows = 0;
                 // Cross-window back-carry, mirroring the narrow scan (and phase 1). A variable-length reference can
                 // straddle the split between two abutting execute-readable windows, decodable by neither window's own
                 // sweep (the previous window's decoder truncates at its end, and this window decodes from its base,
-                // mid-instruction). When this window abuts the previous, decode from ZYDIS_MAX_INSTRUCTION_LENGTH - 1
+                // mid-instruction). When this window abuts the previous, decode from X86_MAX_INSTRUCTION_LENGTH - 1
                 // bytes earlier so the straddler is decoded whole. A count floor at this window's real base then
                 // de-duplicates: an instruction ending at or before the base was already counted by the previous
                 // window, so scan_window_broad_body skips it (see there). The carry is bounded by the previous window's
                 // span so it never reads before it; page-granular regions make that bound a formality.
-                constexpr std::size_t broad_carry = ZYDIS_MAX_INSTRUCTION_LENGTH - 1;
+                constexpr std::size_t broad_carry = detail::X86_MAX_INSTRUCTION_LENGTH - 1;
                 std::uintptr_t prev_end = 0;
                 std::size_t prev_span = 0;
                 bool have_prev = false;
@@ -669,8 +707,7 @@ namespace DetourModKit
                     prev_span = window.span;
                     have_prev = true;
 
-                    if (scan_window_broad_guarded(decoder, effective, string_addr, window.base, found_count,
-                                                  first_site))
+                    if (scan_window_broad_guarded(effective, string_addr, window.base, found_count, first_site))
                     {
                         ++faulted_windows;
                         continue;
@@ -709,8 +746,25 @@ namespace DetourModKit
             // at UnwindData + 4 + 2 * ((CountOfCodes + 1) & ~1). Every module read is fault-guarded: .pdata /
             // .xdata is normally resident, but a partially unmapped or corrupt module must degrade to the fallback
             // rather than fault the host, and the hop count is bounded against a malformed self-referential chain.
+            //
+            // The module's cached function index (scan_function_table.cpp) answers first: it has already done this
+            // chain walk for every range in the image, so a batch of xref candidates in one module pays a header
+            // re-read and a binary search each instead of the walk. Only an address the index cannot speak for -- no
+            // owning image, or an image without an exception directory -- reaches RtlLookupFunctionEntry, which also
+            // consults tables registered at run time.
             std::uintptr_t function_entry_via_pdata(std::uintptr_t instr_addr) noexcept
             {
+                detail::FunctionRange range;
+                switch (detail::lookup_function(instr_addr, range))
+                {
+                case detail::FunctionLookup::Found:
+                    return range.entry;
+                case detail::FunctionLookup::NotInTable:
+                    return 0;
+                case detail::FunctionLookup::NoTable:
+                    break;
+                }
+
                 DWORD64 image_base = 0;
                 PRUNTIME_FUNCTION entry = RtlLookupFunctionEntry(instr_addr, &image_base, nullptr);
                 if (entry == nullptr || image_base == 0)
@@ -836,6 +890,335 @@ namespace DetourModKit
                 }
                 return 0;
             }
+
+            // The cache installed for this thread by ScopedXrefIndexCache, or nullptr outside a batch.
+            thread_local detail::XrefIndexCache *t_xref_index_cache = nullptr;
+
+            // Runs fn(ctx) over one gated window under the same TOCTOU fault guard as the per-query window sweeps
+            // (see scan_window_narrow_guarded). Returns false when a fault was swallowed and fn did not complete.
+            bool run_window_guarded(const detail::ExecutableWindow &window, void (*fn)(void *) noexcept,
+                                    void *ctx) noexcept
+            {
+#ifdef _MSC_VER
+                __try
+                {
+                    fn(ctx);
+                    return true;
+                }
+                __except (detail::guarded_fault_filter(GetExceptionInformation()))
+                {
+                    return false;
+                }
+#elif defined(_WIN64)
+                return detail::run_guarded_region(window.base, window.base + window.span, fn, ctx);
+#endif
+            }
+
+            struct NarrowIndexContext
+            {
+                const detail::ExecutableWindow *window;
+                detail::ModuleSpan range;
+                std::vector<detail::NarrowXref> *entries;
+                bool alloc_failed;
+            };
+
+            // The scan_window_narrow_body shape test at every byte of one window, recording each match whose target
+            // lies inside the module (a string the index is asked about always does) instead of counting one target.
+            // An allocation failure is flagged rather than thrown, so it never unwinds through the fault guard.
+            void index_window_narrow(void *opaque) noexcept
+            {
+                auto &context = *static_cast<NarrowIndexContext *>(opaque);
+                const detail::ExecutableWindow &window = *context.window;
+                constexpr std::size_t instr_len = 7;
+                const auto *bytes = reinterpret_cast<const std::uint8_t *>(window.base);
+                for (std::size_t i = 0; i + instr_len <= window.span; ++i)
+                {
+                    const std::uint8_t rex = bytes[i];
+                    const std::uint8_t opcode = bytes[i + 1];
+                    const std::uint8_t modrm = bytes[i + 2];
+                    if (rex < 0x48 || rex > 0x4F || (opcode != 0x8D && opcode != 0x8B) || (modrm & 0xC7) != 0x05)
+                    {
+                        continue;
+                    }
+                    std::int32_t disp = 0;
+                    std::memcpy(&disp, &bytes[i + 3], sizeof(disp));
+                    const std::uintptr_t instr_addr = window.base + i;
+                    const std::uintptr_t target =
+                        instr_addr + instr_len + static_cast<std::uintptr_t>(static_cast<std::int64_t>(disp));
+                    if (!context.range.contains(target))
+                    {
+                        continue;
+                    }
+                    try
+                    {
+                        context.entries->push_back(detail::NarrowXref{
+                            .target_rva = static_cast<std::uint32_t>(target - context.range.base),
+                            .site_rva = static_cast<std::uint32_t>(instr_addr - context.range.base),
+                            .window_end_rva =
+                                static_cast<std::uint32_t>(window.base + window.span - context.range.base),
+                            .reg = static_cast<std::uint8_t>(((rex & 0x04) << 1) | ((modrm >> 3) & 0x07)),
+                            .is_lea = opcode == 0x8D,
+                        });
+                    }
+                    catch (...)
+                    {
+                        context.alloc_failed = true;
+                        return;
+                    }
+                }
+            }
+
+            struct BroadIndexContext
+            {
+                const detail::ExecutableWindow *window;
+                std::uintptr_t count_floor;
+                detail::ModuleSpan range;
+                std::vector<detail::BroadXref> *entries;
+                bool alloc_failed;
+            };
+
+            // The scan_window_broad_body linear decode of one window -- the same byte-restart recovery and count-floor
+            // de-duplication -- recording the in-module target of each instruction's RIP-relative operand.
+            void index_window_broad(void *opaque) noexcept
+            {
+                auto &context = *static_cast<BroadIndexContext *>(opaque);
+                const detail::ExecutableWindow &window = *context.window;
+                const auto *bytes = reinterpret_cast<const std::uint8_t *>(window.base);
+                std::size_t offset = 0;
+                while (offset < window.span)
+                {
+                    detail::InsnShape insn;
+                    const std::uintptr_t instr_addr = window.base + offset;
+                    if (!detail::decode_insn_shape(bytes + offset, window.span - offset, insn))
+                    {
+                        ++offset;
+                        continue;
+                    }
+                    const std::uintptr_t target = insn.rip_relative ? insn.rip_target(instr_addr) : 0;
+                    if (instr_addr + insn.length > context.count_floor && insn.rip_relative &&
+                        context.range.contains(target))
+                    {
+                        try
+                        {
+                            context.entries->push_back(detail::BroadXref{
+                                .target_rva = static_cast<std::uint32_t>(target - context.range.base),
+                                .site_rva = static_cast<std::uint32_t>(instr_addr - context.range.base),
+                            });
+                        }
+                        catch (...)
+                        {
+                            context.alloc_failed = true;
+                            return;
+                        }
+                    }
+                    offset += insn.length;
+                }
+            }
+
+            // Sorts a finished table by (target, site), so a lookup is one equal_range and its first entry is the
+            // lowest-address site -- the one a per-query sweep, walking windows in ascending order, meets first.
+            template <typename Entry> void sort_xref_table(std::vector<Entry> &entries)
+            {
+                std::sort(entries.begin(), entries.end(),
+                          [](const Entry &lhs, const Entry &rhs) noexcept
+                          {
+                              return lhs.target_rva != rhs.target_rva ? lhs.target_rva < rhs.target_rva
+                                                                      : lhs.site_rva < rhs.site_rva;
+                          });
+            }
+
+            template <typename Entry>
+            std::span<const Entry> xref_run(const std::vector<Entry> &entries, std::uint32_t target_rva) noexcept
+            {
+                const auto lower =
+                    std::lower_bound(entries.begin(), entries.end(), target_rva,
+                                     [](const Entry &entry, std::uint32_t value) noexcept
+                                     { return entry.target_rva < value; });
+                auto upper = lower;
+                while (upper != entries.end() && upper->target_rva == target_rva)
+                {
+                    ++upper;
+                }
+                return std::span<const Entry>(lower, upper);
+            }
+
+            // Builds the narrow table over the same windows and back-carry as scan_string_ref_narrow. Throws
+            // std::bad_alloc, which leaves the table's once-flag unset so the caller sweeps instead.
+            void build_narrow_index(detail::ModuleXrefIndex &index)
+            {
+                constexpr std::size_t instr_len = 7;
+                std::vector<detail::NarrowXref> entries;
+                std::size_t faulted_windows = 0;
+                std::uintptr_t prev_end = 0;
+                std::size_t prev_span = 0;
+                bool have_prev = false;
+                for (const auto &window : detail::collect_executable_windows(index.range))
+                {
+                    detail::ExecutableWindow effective = window;
+                    if (have_prev && window.base == prev_end)
+                    {
+                        const std::size_t carry = (instr_len - 1 < prev_span) ? instr_len - 1 : prev_span;
+                        effective.base = window.base - carry;
+                        effective.span = window.span + carry;
+                    }
+                    prev_end = window.base + window.span;
+                    prev_span = window.span;
+                    have_prev = true;
+                    if (effective.span < instr_len)
+                    {
+                        continue;
+                    }
+
+                    const std::size_t mark = entries.size();
+                    NarrowIndexContext context{&effective, index.range, &entries, false};
+                    if (!run_window_guarded(effective, index_window_narrow, &context))
+                    {
+                        entries.resize(mark);
+                        ++faulted_windows;
+                        continue;
+                    }
+                    if (context.alloc_failed)
+                    {
+                        throw std::bad_alloc();
+                    }
+                }
+                log_faulted_windows(faulted_windows);
+                sort_xref_table(entries);
+                index.narrow.entries = std::move(entries);
+                index.narrow.incomplete = faulted_windows > 0;
+                index.narrow.usable = true;
+            }
+
+            // Builds the broad table over the same windows, back-carry, and count floor as scan_string_ref_broad.
+            void build_broad_index(detail::ModuleXrefIndex &index)
+            {
+                constexpr std::size_t broad_carry = detail::X86_MAX_INSTRUCTION_LENGTH - 1;
+                std::vector<detail::BroadXref> entries;
+                std::size_t faulted_windows = 0;
+                std::uintptr_t prev_end = 0;
+                std::size_t prev_span = 0;
+                bool have_prev = false;
+                for (const auto &window : detail::collect_executable_windows(index.range))
+                {
+                    detail::ExecutableWindow effective = window;
+                    if (have_prev && window.base == prev_end)
+                    {
+                        const std::size_t carry = (broad_carry < prev_span) ? broad_carry : prev_span;
+                        effective.base = window.base - carry;
+                        effective.span = window.span + carry;
+                    }
+                    prev_end = window.base + window.span;
+                    prev_span = window.span;
+                    have_prev = true;
+
+                    const std::size_t mark = entries.size();
+                    BroadIndexContext context{&effective, window.base, index.range, &entries, false};
+                    if (!run_window_guarded(effective, index_window_broad, &context))
+                    {
+                        entries.resize(mark);
+                        ++faulted_windows;
+                        continue;
+                    }
+                    if (context.alloc_failed)
+                    {
+                        throw std::bad_alloc();
+                    }
+                }
+                log_faulted_windows(faulted_windows);
+                sort_xref_table(entries);
+                index.broad.entries = std::move(entries);
+                index.broad.incomplete = faulted_windows > 0;
+                index.broad.usable = true;
+            }
+
+            // The index slot of @p cache for range, or nullptr (no cache, an image too large for 32-bit RVAs, or a
+            // slot that could not be allocated) -- in which case every lookup below reports "sweep instead".
+            detail::ModuleXrefIndex *xref_index_slot(detail::XrefIndexCache *cache, detail::ModuleSpan range) noexcept
+            {
+                if (cache == nullptr || range.end - range.base > std::numeric_limits<std::uint32_t>::max())
+                {
+                    return nullptr;
+                }
+                return cache->slot_for(range);
+            }
+
+            detail::ModuleXrefIndex *installed_xref_index(detail::ModuleSpan range) noexcept
+            {
+                return xref_index_slot(t_xref_index_cache, range);
+            }
+
+            // Builds @p table once through @p build, reporting whether it is ready to answer lookups. A build that
+            // throws leaves the once-flag unset, so a later query may retry while this one sweeps.
+            template <typename Entry, typename Build>
+            bool ensure_xref_table(detail::XrefTable<Entry> &table, detail::ModuleXrefIndex &index,
+                                   Build build) noexcept
+            {
+                try
+                {
+                    std::call_once(table.once, build, std::ref(index));
+                }
+                catch (...)
+                {
+                    return false;
+                }
+                return table.usable;
+            }
+
+            // scan_string_ref_narrow answered from the batch index. Returns false when no usable index is installed,
+            // leaving the caller to sweep; otherwise fills the same outputs the sweep would.
+            bool narrow_from_index(detail::ModuleXrefIndex *index, std::uintptr_t string_addr, std::uintptr_t &site,
+                                   std::size_t &found_count, LeaReferenceInfo &info, bool &incomplete) noexcept
+            {
+                if (index == nullptr || !ensure_xref_table(index->narrow, *index, build_narrow_index))
+                {
+                    return false;
+                }
+                const std::span<const detail::NarrowXref> run = xref_run(
+                    index->narrow.entries, static_cast<std::uint32_t>(string_addr - index->range.base));
+                found_count = run.size() < 2 ? run.size() : 2;
+                incomplete = index->narrow.incomplete;
+                info = LeaReferenceInfo{};
+                site = 0;
+                if (!run.empty())
+                {
+                    const detail::NarrowXref &first = run.front();
+                    info = LeaReferenceInfo{first.reg, 7, index->range.base + first.window_end_rva, first.is_lea};
+                    site = (found_count == 1) ? index->range.base + first.site_rva : 0;
+                }
+                return true;
+            }
+
+            // The batch prescan's occurrences of the literal @p pattern was compiled from, or nullptr when the batch
+            // did not prescan it (the caller then scans for it itself).
+            const detail::MultiMatchResult *prescanned_literal(const detail::ModuleXrefIndex *index,
+                                                               const detail::EnginePattern &pattern) noexcept
+            {
+                if (index == nullptr || index->literals.empty())
+                {
+                    return nullptr;
+                }
+                const std::string_view key(reinterpret_cast<const char *>(pattern.bytes.data()), pattern.bytes.size());
+                const auto found = std::lower_bound(index->literals.begin(), index->literals.end(), key,
+                                                    [](const detail::LiteralOccurrences &entry,
+                                                       std::string_view value) noexcept { return entry.key < value; });
+                return (found != index->literals.end() && found->key == key) ? &found->occurrences : nullptr;
+            }
+
+            // scan_string_ref_broad answered from the batch index; false means "sweep instead".
+            bool broad_from_index(detail::ModuleXrefIndex *index, std::uintptr_t string_addr, std::uintptr_t &site,
+                                  std::size_t &found_count, bool &incomplete) noexcept
+            {
+                if (index == nullptr || !ensure_xref_table(index->broad, *index, build_broad_index))
+                {
+                    return false;
+                }
+                const std::span<const detail::BroadXref> run =
+                    xref_run(index->broad.entries, static_cast<std::uint32_t>(string_addr - index->range.base));
+                found_count = run.size() < 2 ? run.size() : 2;
+                incomplete = index->broad.incomplete;
+                site = (found_count == 1) ? index->range.base + run.front().site_rva : 0;
+                return true;
+            }
         } // namespace
 
         Result<Address> find_string_xref(const StringRefQuery &query, Region scope)
@@ -859,7 +1242,12 @@ namespace DetourModKit
                 // guess.
                 return std::unexpected(Error{ErrorCode::StringNotFound, "scan::find_string_xref"});
             }
-            const detail::MatchResult first = detail::scan_module_readable(*pattern, range, 1);
+            // Inside a batch the literal may already have been located by the batch's one multi-literal sweep.
+            detail::ModuleXrefIndex *const index = installed_xref_index(range);
+            const detail::MultiMatchResult *const prescanned = prescanned_literal(index, *pattern);
+            const detail::MatchResult first =
+                prescanned != nullptr ? detail::MatchResult{prescanned->match, prescanned->incomplete}
+                                      : detail::scan_module_pages_split(*pattern, range, scan::Pages::Readable, 1);
             if (first.match == nullptr)
             {
                 // Not located in any readable region. A region that faulted mid-scan could hide the literal, but with
@@ -867,7 +1255,9 @@ namespace DetourModKit
                 // never guesses an address).
                 return std::unexpected(Error{ErrorCode::StringNotFound, "scan::find_string_xref"});
             }
-            const detail::MatchResult second = detail::scan_module_readable(*pattern, range, 2);
+            const detail::MatchResult second =
+                prescanned != nullptr ? detail::MatchResult{prescanned->next, prescanned->next_incomplete}
+                                      : detail::scan_module_pages_split(*pattern, range, scan::Pages::Readable, 2);
             if (second.match != nullptr)
             {
                 return std::unexpected(Error{ErrorCode::StringAmbiguous, "scan::find_string_xref"});
@@ -884,13 +1274,19 @@ namespace DetourModKit
             const auto string_addr = reinterpret_cast<std::uintptr_t>(first.match);
 
             // Phase 2: find the single RIP-relative reference whose target is the string. The narrow scan is the fast,
-            // desync-immune default; broad_match keeps that coverage and adds a Zydis sweep for rarer reference shapes.
+            // desync-immune default; broad_match keeps that coverage and adds a decoder sweep for rarer reference
+            // shapes.
             ReferenceScanResult references{};
             std::size_t narrow_count = 0;
             LeaReferenceInfo lea_info{};
             bool narrow_incomplete = false;
-            const std::uintptr_t narrow_site =
-                scan_string_ref_narrow(string_addr, range, narrow_count, lea_info, narrow_incomplete);
+            // Inside a batch the installed reference index answers both sweeps with a binary search; without one
+            // (or when it cannot be built) each sweep walks the code windows itself.
+            std::uintptr_t narrow_site = 0;
+            if (!narrow_from_index(index, string_addr, narrow_site, narrow_count, lea_info, narrow_incomplete))
+            {
+                narrow_site = scan_string_ref_narrow(string_addr, range, narrow_count, lea_info, narrow_incomplete);
+            }
             merge_reference_scan(references, narrow_site, narrow_count, narrow_incomplete);
 
             // The narrow scan only models the dominant REX.W lea/mov shapes, so a narrow count of 1 is a SHAPE-LOCAL
@@ -898,7 +1294,7 @@ namespace DetourModKit
             // lea/mov) elsewhere is invisible to it. For the derived return modes the result is computed FROM that
             // single reference -- the enclosing function it sits in (EnclosingFunction), or the store slot its loaded
             // pointer feeds (StringPointerSlot) -- so a hidden second reference would make that derivation attribute
-            // the answer to a site that is not actually unique. Confirm uniqueness with the broad Zydis sweep (a
+            // the answer to a site that is not actually unique. Confirm uniqueness with the broad decoder sweep (a
             // superset of every reference shape) before certifying, even when the caller did not opt into broad_match.
             // ReferencingInstruction returns the dominant reference directly and stays on the fast narrow-only path.
             // The broad sweep re-counts the narrow lea itself, so a genuinely-unique reference stays count 1 at the
@@ -908,19 +1304,21 @@ namespace DetourModKit
             // Cost note: a genuinely-unique reference keeps the narrow count at 1, so this confirmation disassembles
             // the whole scanned range once per derived-return anchor -- there is no early-out to skip it. A manifest
             // that anchors many EnclosingFunction/StringPointerSlot strings in one module therefore pays one full
-            // decode per such anchor at startup. Sharing a disassembly across anchors would require a cross-thread
-            // reference index in the parallel resolver, while skipping confirmation based on the narrow count is
-            // unsound because the narrow scan cannot see rarer reference shapes. Callers that resolve many string
-            // anchors in one image and can key on the referencing instruction should prefer ReferencingInstruction,
-            // which stays on the narrow-only path.
+            // decode per such anchor at startup -- unless it resolves through a batch entry point, whose shared
+            // reference index (internal/scan_xref_index.hpp) decodes the image once and answers every anchor from it.
+            // Skipping confirmation based on the narrow count is unsound because the narrow scan cannot see rarer
+            // reference shapes.
             const bool derived_return = query.return_mode != XrefReturn::ReferencingInstruction;
             const bool confirm_derived_uniqueness = derived_return && references.count == 1;
             if (references.count < 2 && (query.broad_match || confirm_derived_uniqueness))
             {
                 std::size_t broad_count = 0;
                 bool broad_incomplete = false;
-                const std::uintptr_t broad_site =
-                    scan_string_ref_broad(string_addr, range, broad_count, broad_incomplete);
+                std::uintptr_t broad_site = 0;
+                if (!broad_from_index(index, string_addr, broad_site, broad_count, broad_incomplete))
+                {
+                    broad_site = scan_string_ref_broad(string_addr, range, broad_count, broad_incomplete);
+                }
                 merge_reference_scan(references, broad_site, broad_count, broad_incomplete);
             }
 
@@ -973,4 +1371,118 @@ namespace DetourModKit
             return Address{references.site};
         }
     } // namespace scan
+
+    detail::XrefIndexCache::XrefIndexCache() noexcept = default;
+
+    detail::XrefIndexCache::~XrefIndexCache() noexcept = default;
+
+    detail::ModuleXrefIndex *detail::XrefIndexCache::slot_for(detail::ModuleSpan range) noexcept
+    {
+        if (!range.valid())
+        {
+            return nullptr;
+        }
+        try
+        {
+            const std::lock_guard lock(m_mutex);
+            for (const std::unique_ptr<ModuleXrefIndex> &module : m_modules)
+            {
+                if (module->range.base == range.base && module->range.end == range.end)
+                {
+                    return module.get();
+                }
+            }
+            auto slot = std::make_unique<ModuleXrefIndex>();
+            slot->range = range;
+            m_modules.push_back(std::move(slot));
+            return m_modules.back().get();
+        }
+        catch (...)
+        {
+            return nullptr;
+        }
+    }
+
+    void detail::prescan_string_literals(detail::XrefIndexCache &cache,
+                                         std::span<const detail::StringLiteralQuery> literals) noexcept
+    {
+        try
+        {
+            std::vector<std::uint8_t> grouped(literals.size(), 0);
+            for (std::size_t leader = 0; leader < literals.size(); ++leader)
+            {
+                if (grouped[leader] != 0)
+                {
+                    continue;
+                }
+                const ModuleSpan range = literals[leader].range;
+                std::vector<std::string> keys;
+                std::vector<EnginePattern> patterns;
+                for (std::size_t i = leader; i < literals.size(); ++i)
+                {
+                    if (literals[i].range.base != range.base || literals[i].range.end != range.end)
+                    {
+                        continue;
+                    }
+                    grouped[i] = 1;
+                    std::optional<EnginePattern> pattern = scan::compile_string_pattern(literals[i].query);
+                    if (!pattern)
+                    {
+                        continue;
+                    }
+                    std::string key(reinterpret_cast<const char *>(pattern->bytes.data()), pattern->bytes.size());
+                    if (std::find(keys.begin(), keys.end(), key) == keys.end())
+                    {
+                        keys.push_back(std::move(key));
+                        patterns.push_back(std::move(*pattern));
+                    }
+                }
+                if (patterns.size() < STRING_PRESCAN_MIN_LITERALS)
+                {
+                    continue;
+                }
+                // The slot is looked up the same way find_string_xref will, so an image the index refuses is not
+                // swept for a table nobody would read.
+                ModuleXrefIndex *const slot = scan::xref_index_slot(&cache, range);
+                if (slot == nullptr)
+                {
+                    continue;
+                }
+
+                std::vector<BatchScanItem> items;
+                items.reserve(patterns.size());
+                for (const EnginePattern &pattern : patterns)
+                {
+                    items.push_back(BatchScanItem{&pattern, 1});
+                }
+                const std::vector<MultiMatchResult> swept =
+                    scan_module_multi(items, range, scan::Pages::Readable, true);
+                std::vector<LiteralOccurrences> table;
+                table.reserve(swept.size());
+                for (std::size_t i = 0; i < swept.size(); ++i)
+                {
+                    table.push_back(LiteralOccurrences{std::move(keys[i]), swept[i]});
+                }
+                std::sort(table.begin(), table.end(),
+                          [](const LiteralOccurrences &lhs, const LiteralOccurrences &rhs) noexcept
+                          { return lhs.key < rhs.key; });
+                slot->literals = std::move(table);
+            }
+        }
+        catch (...)
+        {
+            // Images without a table simply scan per query.
+        }
+    }
+
+    detail::ScopedXrefIndexCache::ScopedXrefIndexCache(detail::XrefIndexCache *cache) noexcept
+        : m_previous(scan::t_xref_index_cache)
+    {
+        scan::t_xref_index_cache = cache;
+    }
+
+    detail::ScopedXrefIndexCache::~ScopedXrefIndexCache() noexcept
+    {
+        scan::t_xref_index_cache = m_previous;
+    }
 } // namespace DetourModKit
@@ -0,0 +1,165 @@
+/**
+ * @file scan_telemetry.cpp
+ * @brief The per-scan telemetry scopes and the process-wide registry behind DMK_ENABLE_SCAN_TELEMETRY.
+ * @details The registry is a set of relaxed atomics: each top-level scope adds its totals once when it closes, so the
+ *          registry costs a handful of atomic adds per public call and nothing inside the sweep. A reader may see one
+ *          call's fields half-added; the totals are diagnostics, not a ledger. In a build without the switch the
+ *          public readers return zeroes and nothing else here is compiled.
+ */
+
+#include "DetourModKit/scan.hpp"
+
+#include "internal/scan_telemetry.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace DetourModKit
+{
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+    namespace
+    {
+        struct TelemetryRegistry
+        {
+            std::atomic<std::uint64_t> scans{0};
+            detail::TelemetrySink sink;
+            std::atomic<std::int64_t> elapsed_ns{0};
+        };
+
+        TelemetryRegistry &registry() noexcept
+        {
+            static TelemetryRegistry instance;
+            return instance;
+        }
+
+        thread_local scan::ScanTelemetry t_last_telemetry{};
+
+        void add_counts(detail::TelemetrySink &into, const scan::ScanTelemetry &from) noexcept
+        {
+            into.bytes_scanned.fetch_add(from.bytes_scanned, std::memory_order_relaxed);
+            into.regions_walked.fetch_add(from.regions_walked, std::memory_order_relaxed);
+            into.anchor_candidates.fetch_add(from.anchor_candidates, std::memory_order_relaxed);
+            into.verify_calls.fetch_add(from.verify_calls, std::memory_order_relaxed);
+            into.segmented_steps.fetch_add(from.segmented_steps, std::memory_order_relaxed);
+            into.faults.fetch_add(from.faults, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] scan::ScanTelemetry read_counts(const detail::TelemetrySink &sink) noexcept
+        {
+            scan::ScanTelemetry out;
+            out.bytes_scanned = sink.bytes_scanned.load(std::memory_order_relaxed);
+            out.regions_walked = sink.regions_walked.load(std::memory_order_relaxed);
+            out.anchor_candidates = sink.anchor_candidates.load(std::memory_order_relaxed);
+            out.verify_calls = sink.verify_calls.load(std::memory_order_relaxed);
+            out.segmented_steps = sink.segmented_steps.load(std::memory_order_relaxed);
+            out.faults = sink.faults.load(std::memory_order_relaxed);
+            return out;
+        }
+    } // namespace
+
+    namespace detail
+    {
+        TelemetrySink *&current_telemetry_sink() noexcept
+        {
+            thread_local TelemetrySink *current = nullptr;
+            return current;
+        }
+
+        void record_page_walk(std::uint64_t regions, std::uint64_t bytes, std::uint64_t faults) noexcept
+        {
+            TelemetrySink *const sink = current_telemetry_sink();
+            if (sink == nullptr)
+            {
+                return;
+            }
+            sink->regions_walked.fetch_add(regions, std::memory_order_relaxed);
+            sink->bytes_scanned.fetch_add(bytes, std::memory_order_relaxed);
+            sink->faults.fetch_add(faults, std::memory_order_relaxed);
+        }
+
+        void record_match_work(std::uint64_t candidates, std::uint64_t verifies, std::uint64_t steps) noexcept
+        {
+            TelemetrySink *const sink = current_telemetry_sink();
+            if (sink == nullptr)
+            {
+                return;
+            }
+            sink->anchor_candidates.fetch_add(candidates, std::memory_order_relaxed);
+            sink->verify_calls.fetch_add(verifies, std::memory_order_relaxed);
+            sink->segmented_steps.fetch_add(steps, std::memory_order_relaxed);
+        }
+
+        TelemetryScope::TelemetryScope() noexcept
+            : m_parent(current_telemetry_sink()), m_start(std::chrono::steady_clock::now())
+        {
+            current_telemetry_sink() = &m_sink;
+        }
+
+        TelemetryScope::~TelemetryScope() noexcept
+        {
+            current_telemetry_sink() = m_parent;
+            const scan::ScanTelemetry result = snapshot();
+            if (m_parent != nullptr)
+            {
+                // A nested call is part of the enclosing one; its wall time is already inside the outer clock.
+                add_counts(*m_parent, result);
+                return;
+            }
+
+            t_last_telemetry = result;
+            TelemetryRegistry &totals = registry();
+            add_counts(totals.sink, result);
+            totals.elapsed_ns.fetch_add(result.elapsed.count(), std::memory_order_relaxed);
+            totals.scans.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        scan::ScanTelemetry TelemetryScope::snapshot() const noexcept
+        {
+            scan::ScanTelemetry out = read_counts(m_sink);
+            out.elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                                               m_start);
+            return out;
+        }
+    } // namespace detail
+#endif // DMK_ENABLE_SCAN_TELEMETRY
+
+    namespace scan
+    {
+        ScanTelemetry last_scan_telemetry() noexcept
+        {
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+            return t_last_telemetry;
+#else
+            return {};
+#endif
+        }
+
+        ScanTelemetryTotals scan_telemetry_totals() noexcept
+        {
+            ScanTelemetryTotals out;
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+            const TelemetryRegistry &totals = registry();
+            out.scans = totals.scans.load(std::memory_order_relaxed);
+            out.totals = read_counts(totals.sink);
+            out.totals.elapsed = std::chrono::nanoseconds{totals.elapsed_ns.load(std::memory_order_relaxed)};
+#endif
+            return out;
+        }
+
+        void reset_scan_telemetry_totals() noexcept
+        {
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+            TelemetryRegistry &totals = registry();
+            totals.scans.store(0, std::memory_order_relaxed);
+            totals.sink.bytes_scanned.store(0, std::memory_order_relaxed);
+            totals.sink.regions_walked.store(0, std::memory_order_relaxed);
+            totals.sink.anchor_candidates.store(0, std::memory_order_relaxed);
+            totals.sink.verify_calls.store(0, std::memory_order_relaxed);
+            totals.sink.segmented_steps.store(0, std::memory_order_relaxed);
+            totals.sink.faults.store(0, std::memory_order_relaxed);
+            totals.elapsed_ns.store(0, std::memory_order_relaxed);
+#endif
+        }
+    } // namespace scan
+} // namespace DetourModKit
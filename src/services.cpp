@@ -0,0 +1,858 @@
+/**
+ * @file services.cpp
+ * @brief The process-wide services registry: one named mapping, guarded by one named mutex, that every DetourModKit
+ *        instance in the process joins.
+ * @details The mapping is created zero-filled, so an all-zero header means "not yet initialized" and an all-zero slot
+ *          is free; the first instance to map it installs the magic with a compare-exchange, as the resolution table
+ *          does. Joining, leaving and hosting change the header and the slots under the registry mutex, a kernel
+ *          object because the instances share no static. The key sweep and the region table are written lock-free
+ *          under per-record sequence counters, since a poll thread and a game thread read them on every cycle.
+ *
+ *          Hosting crosses module boundaries through two C-layout tables of function pointers, each in the static
+ *          storage of the module that exports it: the host's scheduler table, whose address sits in the header, and
+ *          each instance's own table, holding the single call a leaving host makes back. Each table leads with its
+ *          ABI version and size, so an instance only calls members both sides know. A call into the host's table is
+ *          made only under a lease, a count in the header the host drains after withdrawing the table's address.
+ */
+
+#include "DetourModKit/services.hpp"
+
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/logger.hpp"
+#include "internal/shared_services.hpp"
+#include "internal/subsystem_usage.hpp"
+#include "platform.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cwchar>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        using detail::BackgroundTaskId;
+        using detail::ForeignTaskFn;
+        using detail::KeyMask;
+        using detail::NO_BACKGROUND_TASK;
+
+        // Bump on any change to the structs below. It is part of both kernel object names, so instances built against
+        // different layouts never open each other's registry; the function tables carry their own ABI version on top.
+        constexpr std::uint32_t REGISTRY_LAYOUT = 1;
+        constexpr std::uint64_t REGISTRY_MAGIC = 0x444D'4B53'5256'4300ULL | REGISTRY_LAYOUT; // "DMKSRVC" + layout
+
+        // Instances one registry admits: comfortably more mods than a game runs side by side.
+        constexpr std::size_t MAX_INSTANCES = 16;
+        // 2048 regions of one cache line each, keyed by 64 KiB allocation granule: every code and read-only data
+        // region of a large game image and its usual dependencies, in 128 KiB faulted in as slots are touched.
+        constexpr std::size_t REGION_SLOTS = 2048;
+        constexpr std::size_t REGION_PROBES = 16;
+        constexpr unsigned REGION_GRANULE_SHIFT = 16;
+        constexpr std::size_t NO_SLOT = std::numeric_limits<std::size_t>::max();
+        // How long a leaving host waits for the leases on its table, off and under the loader lock.
+        constexpr std::uint64_t HOST_LEASE_DRAIN_TIMEOUT_MS = 1000;
+        constexpr std::uint64_t HOST_LEASE_DRAIN_LOADER_LOCK_TIMEOUT_MS = 10;
+
+        struct alignas(64) RegistryHeader
+        {
+            std::uint64_t magic;
+            /// The hosting instance's token; 0 while none hosts.
+            std::uint64_t host_token;
+            /// The address of the host's HostTable while it serves; cleared first when it leaves.
+            std::uint64_t host_table;
+            /// Leases outstanding on host_table.
+            std::uint64_t host_leases;
+            /// The token of the instance sampling the key sweep; 0 while none does.
+            std::uint64_t sweep_owner;
+            /// Bumped by every invalidation; a region is current only while it carries the value it was queried under.
+            std::uint64_t region_epoch;
+        };
+
+        // token == 0 is a free slot. Written under the registry mutex, except wanted, which is the owner's alone.
+        struct alignas(64) InstanceSlot
+        {
+            std::uint64_t token;
+            std::uint64_t client_table;
+            std::uint64_t wanted[KeyMask::WORDS];
+        };
+
+        // sequence is even while the sweep is stable and odd while its owner rewrites it; 0 means never published.
+        struct alignas(64) KeySweep
+        {
+            std::uint64_t sequence;
+            std::uint64_t sampled_at; // QueryPerformanceCounter ticks
+            std::uint64_t down[KeyMask::WORDS];
+            std::uint64_t covered[KeyMask::WORDS];
+        };
+
+        // key == 0 is an empty slot, otherwise the granule index plus one; sequence as for the sweep.
+        struct alignas(64) RegionRecord
+        {
+            std::uint64_t key;
+            std::uint64_t sequence;
+            std::uint64_t base;
+            std::uint64_t size;
+            std::uint64_t protection_state; // protection in the low 32 bits, state in the high
+            std::uint64_t type;
+            std::uint64_t epoch;
+        };
+
+        struct Registry
+        {
+            RegistryHeader header;
+            InstanceSlot slots[MAX_INSTANCES];
+            KeySweep sweep;
+            RegionRecord regions[REGION_SLOTS];
+        };
+
+        /// The host's exported scheduler. Later minors append members; never reorder or remove one.
+        struct HostTable
+        {
+            std::uint32_t abi_major;
+            std::uint32_t abi_minor;
+            std::uint32_t size;
+            std::uint32_t reserved;
+            std::uint64_t (*schedule)(const char *name, std::size_t name_length, std::uint64_t period_ms, void *handle,
+                                      ForeignTaskFn run, void *context) noexcept;
+            void (*wake)(std::uint64_t host_id) noexcept;
+            bool (*cancel)(std::uint64_t host_id) noexcept;
+        };
+
+        /// What every joined instance exports back to the host.
+        struct ClientTable
+        {
+            std::uint32_t abi_major;
+            std::uint32_t abi_minor;
+            std::uint32_t size;
+            std::uint32_t reserved;
+            /// Called once, under the registry mutex, by a host that has stopped running the instance's tasks.
+            void (*host_leaving)() noexcept;
+        };
+
+        [[nodiscard]] std::uint64_t load(std::uint64_t &word,
+                                         std::memory_order order = std::memory_order_relaxed) noexcept
+        {
+            return std::atomic_ref<std::uint64_t>(word).load(order);
+        }
+
+        void store(std::uint64_t &word, std::uint64_t value,
+                   std::memory_order order = std::memory_order_relaxed) noexcept
+        {
+            std::atomic_ref<std::uint64_t>(word).store(value, order);
+        }
+
+        std::uint64_t host_schedule(const char *name, std::size_t name_length, std::uint64_t period_ms, void *handle,
+                                    ForeignTaskFn run, void *context) noexcept
+        {
+            const auto period = std::chrono::milliseconds(
+                static_cast<std::chrono::milliseconds::rep>(std::min<std::uint64_t>(period_ms, INT32_MAX)));
+            const Result<BackgroundTaskId> id =
+                detail::host_background_task(std::string_view(name, name_length), period, handle, run, context);
+            return id ? *id : NO_BACKGROUND_TASK;
+        }
+
+        void host_wake(std::uint64_t host_id) noexcept
+        {
+            detail::wake_background_task(host_id);
+        }
+
+        bool host_cancel(std::uint64_t host_id) noexcept
+        {
+            return detail::cancel_background_task(host_id);
+        }
+
+        void client_host_leaving() noexcept;
+
+        constinit const HostTable s_host_table{
+            services::ABI_MAJOR, services::ABI_MINOR, sizeof(HostTable), 0, host_schedule, host_wake, host_cancel,
+        };
+        constinit const ClientTable s_client_table{
+            services::ABI_MAJOR, services::ABI_MINOR, sizeof(ClientTable), 0, client_host_leaving,
+        };
+
+        /// This instance's identity in the registry: the address of its exported table, unique among loaded modules.
+        [[nodiscard]] std::uint64_t own_token() noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(&s_client_table);
+        }
+
+        struct BrokerState
+        {
+            /// Serializes enable() and disable(); taken before the registry mutex, never inside it.
+            std::mutex mutex;
+            HANDLE mapping{nullptr};
+            HANDLE registry_lock{nullptr};
+            /// Mapped once and never unmapped; see internal/shared_services.hpp.
+            std::atomic<Registry *> registry{nullptr};
+            std::atomic<std::size_t> slot{NO_SLOT};
+            std::atomic<services::Role> role{services::Role::Standalone};
+            std::atomic<std::uint32_t> host_abi_major{0};
+            std::atomic<std::uint32_t> host_abi_minor{0};
+            std::atomic<std::uint64_t> shared_key_sweeps{0};
+            std::atomic<std::uint64_t> shared_region_hits{0};
+            /// Set once a host's lease drain timed out and it kept this module mapped for the process lifetime.
+            std::atomic<bool> host_pinned{false};
+        };
+
+        alignas(BrokerState) unsigned char s_broker_storage[sizeof(BrokerState)];
+
+        /// Constructed on first use in static storage and never destroyed: a game thread may still read through it.
+        BrokerState &broker() noexcept
+        {
+            static BrokerState *const state = ::new (static_cast<void *>(s_broker_storage)) BrokerState();
+            return *state;
+        }
+
+        /// The registry while this instance holds a slot, else nullptr.
+        [[nodiscard]] Registry *joined_registry() noexcept
+        {
+            BrokerState &state = broker();
+            return state.slot.load(std::memory_order_acquire) != NO_SLOT
+                       ? state.registry.load(std::memory_order_acquire)
+                       : nullptr;
+        }
+
+        [[nodiscard]] std::int64_t qpc_now() noexcept
+        {
+            LARGE_INTEGER ticks;
+            QueryPerformanceCounter(&ticks);
+            return ticks.QuadPart;
+        }
+
+        [[nodiscard]] std::int64_t qpc_frequency() noexcept
+        {
+            static const std::int64_t frequency = []() noexcept
+            {
+                LARGE_INTEGER value;
+                return QueryPerformanceFrequency(&value) && value.QuadPart > 0 ? value.QuadPart : std::int64_t{1};
+            }();
+            return frequency;
+        }
+
+        [[nodiscard]] std::unexpected<Error> services_error(ErrorCode code, std::uintptr_t context = 0) noexcept
+        {
+            return std::unexpected(Error{code, "services::enable", context});
+        }
+
+        /// Maps the registry and opens its mutex, once per instance. Call with the broker mutex held.
+        [[nodiscard]] Result<Registry *> open_registry(BrokerState &state) noexcept
+        {
+            if (Registry *const mapped = state.registry.load(std::memory_order_acquire))
+            {
+                return mapped;
+            }
+            // Local\ and the process id as for the resolution table: only instances in this process ever meet.
+            wchar_t name[96]{};
+            std::swprintf(name, std::size(name), L"Local\\DetourModKit.Services.v%u.%lu",
+                          static_cast<unsigned>(REGISTRY_LAYOUT), static_cast<unsigned long>(GetCurrentProcessId()));
+            wchar_t lock_name[104]{};
+            std::swprintf(lock_name, std::size(lock_name), L"%ls.Lock", name);
+
+            if (state.registry_lock == nullptr)
+            {
+                state.registry_lock = CreateMutexW(nullptr, FALSE, lock_name);
+                if (state.registry_lock == nullptr)
+                {
+                    return services_error(ErrorCode::SystemCallFailed, GetLastError());
+                }
+            }
+            if (state.mapping == nullptr)
+            {
+                state.mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE | SEC_COMMIT, 0,
+                                                   static_cast<DWORD>(sizeof(Registry)), name);
+                if (state.mapping == nullptr)
+                {
+                    return services_error(ErrorCode::SystemCallFailed, GetLastError());
+                }
+            }
+            void *const view = MapViewOfFile(state.mapping, FILE_MAP_READ | FILE_MAP_WRITE, 0, 0, sizeof(Registry));
+            if (view == nullptr)
+            {
+                return services_error(ErrorCode::SystemCallFailed, GetLastError());
+            }
+
+            auto *const registry = static_cast<Registry *>(view);
+            std::uint64_t expected = 0;
+            std::atomic_ref<std::uint64_t> magic(registry->header.magic);
+            if (!magic.compare_exchange_strong(expected, REGISTRY_MAGIC, std::memory_order_acq_rel) &&
+                expected != REGISTRY_MAGIC)
+            {
+                UnmapViewOfFile(view);
+                return services_error(ErrorCode::InvalidRange);
+            }
+            state.registry.store(registry, std::memory_order_release);
+            return registry;
+        }
+
+        // Holds the registry mutex. An abandoned mutex is still held; the registry records nothing a dead thread
+        // could have left half-written that the next holder does not overwrite.
+        class RegistryLock
+        {
+        public:
+            RegistryLock(HANDLE mutex, DWORD timeout_ms) noexcept : m_mutex(mutex)
+            {
+                const DWORD result = WaitForSingleObject(mutex, timeout_ms);
+                m_held = result == WAIT_OBJECT_0 || result == WAIT_ABANDONED;
+            }
+            ~RegistryLock() noexcept
+            {
+                if (m_held)
+                {
+                    ReleaseMutex(m_mutex);
+                }
+            }
+            RegistryLock(const RegistryLock &) = delete;
+            RegistryLock &operator=(const RegistryLock &) = delete;
+
+            [[nodiscard]] bool held() const noexcept { return m_held; }
+
+        private:
+            HANDLE m_mutex;
+            bool m_held = false;
+        };
+
+        /**
+         * @brief Stops hosting. Call with the registry mutex held.
+         * @details Withdraws the table and drains its leases, so no attached instance is inside a call; cancels every
+         *          hosted task, waiting for a running one, so none of their code runs here again; and only then tells
+         *          each attached instance, which takes its tasks back.
+         *
+         *          The drain is bounded, as every drain under the registry mutex must be: a client inside host_cancel()
+         *          waits on this instance's service thread, which may be running that client's task, and under the
+         *          loader lock that task can be waiting on this very thread. On timeout the host stays registered with
+         *          its table withdrawn, so no new lease reaches it, keeps its module mapped for the leases still out,
+         *          and skips the rest; a later disable() off the loader lock can finish leaving.
+         * @return False when the drain timed out and the host is still registered.
+         */
+        [[nodiscard]] bool leave_as_host(BrokerState &state, Registry &registry) noexcept
+        {
+            store(registry.header.host_table, 0, std::memory_order_seq_cst);
+
+            // A wall-clock bound rather than a yield count, short under the loader lock where nothing may wait long.
+            const std::uint64_t timeout_ms =
+                detail::is_loader_lock_held() ? HOST_LEASE_DRAIN_LOADER_LOCK_TIMEOUT_MS : HOST_LEASE_DRAIN_TIMEOUT_MS;
+            const std::uint64_t deadline_ms = GetTickCount64() + timeout_ms;
+            while (load(registry.header.host_leases, std::memory_order_seq_cst) != 0 && GetTickCount64() < deadline_ms)
+            {
+                std::this_thread::yield();
+            }
+            const std::uint64_t still_leased = load(registry.header.host_leases, std::memory_order_seq_cst);
+            if (still_leased != 0)
+            {
+                // Leak-on-timeout, never free-on-timeout: a leased client may still be running this module's
+                // s_host_table code, so a counted reference on the module is taken once and never released. It cannot
+                // stop an unload the loader has already begun, only a FreeLibrary still to come. The hosted tasks keep
+                // running on this instance's service thread until a retry drains.
+                if (!state.host_pinned.load(std::memory_order_acquire) && detail::acquire_module_ref() != nullptr)
+                {
+                    state.host_pinned.store(true, std::memory_order_release);
+                    diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::Worker);
+                }
+                (void)log().try_log(LogLevel::Warning,
+                                    "Services: {} lease(s) on the host's scheduler still out after {} ms; staying "
+                                    "registered as host with the scheduler withdrawn.",
+                                    still_leased, timeout_ms);
+                return false;
+            }
+            detail::cancel_hosted_background_tasks();
+
+            const std::uint64_t self = own_token();
+            for (InstanceSlot &slot : registry.slots)
+            {
+                const std::uint64_t token = load(slot.token);
+                if (token == 0 || token == self)
+                {
+                    continue;
+                }
+                const auto *const client = reinterpret_cast<const ClientTable *>(load(slot.client_table));
+                if (client != nullptr && client->abi_major == services::ABI_MAJOR &&
+                    client->size >= sizeof(ClientTable))
+                {
+                    client->host_leaving();
+                }
+            }
+            store(registry.header.host_token, 0);
+            return true;
+        }
+
+        void client_host_leaving() noexcept
+        {
+            // On the host's thread, under the registry mutex. The broker mutex may be held by this instance's own
+            // enable() or disable() waiting for that mutex, so only atomics are touched here.
+            BrokerState &state = broker();
+            services::Role expected = services::Role::Attached;
+            if (state.role.compare_exchange_strong(expected, services::Role::Standalone, std::memory_order_acq_rel))
+            {
+                state.host_abi_major.store(0, std::memory_order_relaxed);
+                state.host_abi_minor.store(0, std::memory_order_relaxed);
+                detail::set_background_delegation(false);
+                (void)log().try_log(LogLevel::Info,
+                                    "Services: the host left; background tasks run on this instance's own thread.");
+            }
+        }
+    } // anonymous namespace
+
+    Result<services::Role> services::enable() noexcept
+    {
+        BrokerState &state = broker();
+        std::lock_guard<std::mutex> guard(state.mutex);
+        if (state.slot.load(std::memory_order_acquire) != NO_SLOT)
+        {
+            return state.role.load(std::memory_order_acquire);
+        }
+        const Result<Registry *> opened = open_registry(state);
+        if (!opened)
+        {
+            return std::unexpected(opened.error());
+        }
+        Registry &registry = **opened;
+
+        const RegistryLock lock(state.registry_lock, INFINITE);
+        if (!lock.held())
+        {
+            return services_error(ErrorCode::SystemCallFailed, GetLastError());
+        }
+        std::size_t slot_index = NO_SLOT;
+        for (std::size_t i = 0; i < MAX_INSTANCES; ++i)
+        {
+            if (load(registry.slots[i].token) == 0)
+            {
+                slot_index = i;
+                break;
+            }
+        }
+        if (slot_index == NO_SLOT)
+        {
+            return services_error(ErrorCode::OutOfMemory, MAX_INSTANCES);
+        }
+        InstanceSlot &slot = registry.slots[slot_index];
+        for (std::uint64_t &word : slot.wanted)
+        {
+            store(word, 0);
+        }
+        store(slot.client_table, reinterpret_cast<std::uintptr_t>(&s_client_table));
+        store(slot.token, own_token(), std::memory_order_release);
+        detail::mark_subsystem_used(detail::Subsystem::SharedServices);
+
+        Role role = Role::Standalone;
+        if (load(registry.header.host_token) == 0)
+        {
+            store(registry.header.host_token, own_token());
+            store(registry.header.host_table, reinterpret_cast<std::uintptr_t>(&s_host_table),
+                  std::memory_order_seq_cst);
+            state.host_abi_major.store(ABI_MAJOR, std::memory_order_relaxed);
+            state.host_abi_minor.store(ABI_MINOR, std::memory_order_relaxed);
+            role = Role::Host;
+        }
+        else if (const auto *const host = reinterpret_cast<const HostTable *>(load(registry.header.host_table)))
+        {
+            // A host is live while it holds host_token, and it can only leave under the registry mutex held here.
+            state.host_abi_major.store(host->abi_major, std::memory_order_relaxed);
+            state.host_abi_minor.store(host->abi_minor, std::memory_order_relaxed);
+            if (host->abi_major == ABI_MAJOR && host->size >= sizeof(HostTable))
+            {
+                role = Role::Attached;
+            }
+            else
+            {
+                (void)log().try_log(LogLevel::Warning,
+                                    "Services: the host speaks ABI {}.{}, this instance {}.{}; its background tasks "
+                                    "stay on its own thread.",
+                                    host->abi_major, host->abi_minor, ABI_MAJOR, ABI_MINOR);
+            }
+        }
+        state.role.store(role, std::memory_order_release);
+        state.slot.store(slot_index, std::memory_order_release);
+        if (role == Role::Attached)
+        {
+            detail::set_background_delegation(true);
+        }
+        return role;
+    }
+
+    void services::disable() noexcept
+    {
+        BrokerState &state = broker();
+        std::lock_guard<std::mutex> guard(state.mutex);
+        const std::size_t slot_index = state.slot.load(std::memory_order_acquire);
+        Registry *const registry = state.registry.load(std::memory_order_acquire);
+        if (slot_index == NO_SLOT || registry == nullptr)
+        {
+            return;
+        }
+
+        // Under the loader lock a wait on the registry mutex could be a wait on a thread that needs the loader lock.
+        const RegistryLock lock(state.registry_lock, detail::is_loader_lock_held() ? 0 : INFINITE);
+        if (!lock.held())
+        {
+            (void)log().try_log(LogLevel::Warning,
+                                "Services: the registry is busy under the loader lock; not leaving.");
+            return;
+        }
+        // A host whose lease drain timed out stays joined, and stays Host, until a later call drains.
+        if (state.role.load(std::memory_order_acquire) == Role::Host && !leave_as_host(state, *registry))
+        {
+            return;
+        }
+        if (state.role.exchange(Role::Standalone, std::memory_order_acq_rel) == Role::Attached)
+        {
+            // The host cannot leave while the registry mutex is held, so every delegated task is cancelled there.
+            detail::set_background_delegation(false);
+        }
+        InstanceSlot &slot = registry->slots[slot_index];
+        store(slot.client_table, 0);
+        store(slot.token, 0, std::memory_order_release);
+        state.slot.store(NO_SLOT, std::memory_order_release);
+        detail::release_key_sweep();
+        state.host_abi_major.store(0, std::memory_order_relaxed);
+        state.host_abi_minor.store(0, std::memory_order_relaxed);
+    }
+
+    services::Status services::status() noexcept
+    {
+        BrokerState &state = broker();
+        Status status;
+        status.role = state.role.load(std::memory_order_acquire);
+        status.host_abi_major = state.host_abi_major.load(std::memory_order_relaxed);
+        status.host_abi_minor = state.host_abi_minor.load(std::memory_order_relaxed);
+        if (Registry *const registry = joined_registry())
+        {
+            for (InstanceSlot &slot : registry->slots)
+            {
+                status.instances += load(slot.token) != 0 ? 1 : 0;
+            }
+        }
+        status.delegated_tasks = detail::delegated_background_task_count();
+        status.hosted_tasks = detail::hosted_background_task_count();
+        status.shared_key_sweeps = state.shared_key_sweeps.load(std::memory_order_relaxed);
+        status.shared_region_hits = state.shared_region_hits.load(std::memory_order_relaxed);
+        return status;
+    }
+
+    bool detail::shared_services_joined() noexcept
+    {
+        return joined_registry() != nullptr;
+    }
+
+    detail::HostSchedulerLease::HostSchedulerLease(HostSchedulerLease &&other) noexcept
+        : m_table(std::exchange(other.m_table, nullptr))
+    {
+    }
+
+    detail::HostSchedulerLease::~HostSchedulerLease() noexcept
+    {
+        if (m_table != nullptr)
+        {
+            Registry *const registry = broker().registry.load(std::memory_order_acquire);
+            std::atomic_ref<std::uint64_t>(registry->header.host_leases).fetch_sub(1, std::memory_order_seq_cst);
+        }
+    }
+
+    detail::HostSchedulerLease detail::lease_host_scheduler() noexcept
+    {
+        Registry *const registry = broker().registry.load(std::memory_order_acquire);
+        if (registry == nullptr || load(registry->header.host_table, std::memory_order_seq_cst) == 0)
+        {
+            return {};
+        }
+        // Counted before the table is read again, so a host that withdrew it in between is seen as gone, and a host
+        // draining its leases sees this one.
+        std::atomic_ref<std::uint64_t> leases(registry->header.host_leases);
+        leases.fetch_add(1, std::memory_order_seq_cst);
+        const std::uint64_t table = load(registry->header.host_table, std::memory_order_seq_cst);
+        if (table == 0 || table == reinterpret_cast<std::uintptr_t>(&s_host_table))
+        {
+            // Withdrawn meanwhile, or this instance's own table, which it never calls through.
+            leases.fetch_sub(1, std::memory_order_seq_cst);
+            return {};
+        }
+        return HostSchedulerLease(reinterpret_cast<const void *>(table));
+    }
+
+    void detail::stage_host_lease_for_test(bool held) noexcept
+    {
+        if (Registry *const registry = broker().registry.load(std::memory_order_acquire))
+        {
+            std::atomic_ref<std::uint64_t> leases(registry->header.host_leases);
+            if (held)
+            {
+                leases.fetch_add(1, std::memory_order_seq_cst);
+            }
+            else
+            {
+                leases.fetch_sub(1, std::memory_order_seq_cst);
+            }
+        }
+    }
+
+    BackgroundTaskId detail::HostSchedulerLease::schedule(std::string_view name, std::chrono::milliseconds period,
+                                                          void *handle, ForeignTaskFn run, void *context) const noexcept
+    {
+        if (m_table == nullptr)
+        {
+            return NO_BACKGROUND_TASK;
+        }
+        const auto period_ms = static_cast<std::uint64_t>(std::max<std::chrono::milliseconds::rep>(period.count(), 0));
+        return static_cast<const HostTable *>(m_table)->schedule(name.data(), name.size(), period_ms, handle, run,
+                                                                 context);
+    }
+
+    void detail::HostSchedulerLease::wake(BackgroundTaskId host_id) const noexcept
+    {
+        if (m_table != nullptr)
+        {
+            static_cast<const HostTable *>(m_table)->wake(host_id);
+        }
+    }
+
+    bool detail::HostSchedulerLease::cancel(BackgroundTaskId host_id) const noexcept
+    {
+        return m_table == nullptr || static_cast<const HostTable *>(m_table)->cancel(host_id);
+    }
+
+    std::optional<KeyMask> detail::claim_key_sweep() noexcept
+    {
+        Registry *const registry = joined_registry();
+        if (registry == nullptr)
+        {
+            return std::nullopt;
+        }
+        const std::uint64_t self = own_token();
+        std::uint64_t owner = 0;
+        if (!std::atomic_ref<std::uint64_t>(registry->header.sweep_owner)
+                 .compare_exchange_strong(owner, self, std::memory_order_acq_rel) &&
+            owner != self)
+        {
+            return std::nullopt;
+        }
+        if (joined_registry() == nullptr)
+        {
+            // disable() released the sweep between the check above and the claim; give it back.
+            release_key_sweep();
+            return std::nullopt;
+        }
+        KeyMask wanted;
+        for (InstanceSlot &slot : registry->slots)
+        {
+            const std::uint64_t token = load(slot.token, std::memory_order_acquire);
+            if (token == 0 || token == self)
+            {
+                continue;
+            }
+            for (std::size_t i = 0; i < KeyMask::WORDS; ++i)
+            {
+                wanted.words[i] |= load(slot.wanted[i]);
+            }
+        }
+        return wanted;
+    }
+
+    void detail::publish_key_sweep(const KeyMask &down, const KeyMask &covered) noexcept
+    {
+        Registry *const registry = joined_registry();
+        if (registry == nullptr || load(registry->header.sweep_owner, std::memory_order_acquire) != own_token())
+        {
+            return;
+        }
+        // The owner is the only writer, so the sequence is bumped rather than claimed.
+        KeySweep &sweep = registry->sweep;
+        std::atomic_ref<std::uint64_t> sequence(sweep.sequence);
+        const std::uint64_t current = sequence.load(std::memory_order_relaxed);
+        sequence.store(current | 1U, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (std::size_t i = 0; i < KeyMask::WORDS; ++i)
+        {
+            store(sweep.down[i], down.words[i]);
+            store(sweep.covered[i], covered.words[i]);
+        }
+        store(sweep.sampled_at, static_cast<std::uint64_t>(qpc_now()));
+        sequence.store((current | 1U) + 1, std::memory_order_release);
+    }
+
+    void detail::release_key_sweep() noexcept
+    {
+        Registry *const registry = broker().registry.load(std::memory_order_acquire);
+        if (registry != nullptr)
+        {
+            std::uint64_t owner = own_token();
+            (void)std::atomic_ref<std::uint64_t>(registry->header.sweep_owner)
+                .compare_exchange_strong(owner, 0, std::memory_order_acq_rel);
+        }
+    }
+
+    void detail::publish_wanted_keys(const KeyMask &wanted) noexcept
+    {
+        BrokerState &state = broker();
+        Registry *const registry = joined_registry();
+        const std::size_t slot_index = state.slot.load(std::memory_order_acquire);
+        if (registry == nullptr || slot_index == NO_SLOT)
+        {
+            return;
+        }
+        InstanceSlot &slot = registry->slots[slot_index];
+        for (std::size_t i = 0; i < KeyMask::WORDS; ++i)
+        {
+            // Skips the store when unchanged, so a steady binding set leaves the owner's cache line alone.
+            if (load(slot.wanted[i]) != wanted.words[i])
+            {
+                store(slot.wanted[i], wanted.words[i]);
+            }
+        }
+    }
+
+    bool detail::read_key_sweep(std::chrono::milliseconds max_age, KeyMask &down, KeyMask &covered) noexcept
+    {
+        Registry *const registry = joined_registry();
+        if (registry == nullptr)
+        {
+            return false;
+        }
+        const std::uint64_t owner = load(registry->header.sweep_owner, std::memory_order_acquire);
+        if (owner == 0 || owner == own_token())
+        {
+            return false;
+        }
+        KeySweep &sweep = registry->sweep;
+        std::atomic_ref<std::uint64_t> sequence(sweep.sequence);
+        const std::uint64_t before = sequence.load(std::memory_order_acquire);
+        if (before == 0 || (before & 1U) != 0)
+        {
+            return false;
+        }
+        KeyMask sampled_down;
+        KeyMask sampled_covered;
+        for (std::size_t i = 0; i < KeyMask::WORDS; ++i)
+        {
+            sampled_down.words[i] = load(sweep.down[i]);
+            sampled_covered.words[i] = load(sweep.covered[i]);
+        }
+        const auto sampled_at = static_cast<std::int64_t>(load(sweep.sampled_at));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) != before)
+        {
+            return false;
+        }
+        const std::int64_t max_ticks = max_age.count() * qpc_frequency() / 1000;
+        if (qpc_now() - sampled_at > max_ticks)
+        {
+            return false;
+        }
+        down = sampled_down;
+        covered = sampled_covered;
+        broker().shared_key_sweeps.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    std::uint64_t detail::shared_region_epoch() noexcept
+    {
+        Registry *const registry = joined_registry();
+        return registry != nullptr ? load(registry->header.region_epoch, std::memory_order_acquire) : 0;
+    }
+
+    std::optional<detail::SharedRegion> detail::shared_region_lookup(std::uintptr_t address) noexcept
+    {
+        Registry *const registry = joined_registry();
+        if (registry == nullptr)
+        {
+            return std::nullopt;
+        }
+        const std::uint64_t epoch = load(registry->header.region_epoch, std::memory_order_acquire);
+        const std::uint64_t key = (static_cast<std::uint64_t>(address) >> REGION_GRANULE_SHIFT) + 1;
+        for (std::size_t probe = 0; probe < REGION_PROBES; ++probe)
+        {
+            RegionRecord &record = registry->regions[(key + probe) % REGION_SLOTS];
+            const std::uint64_t occupant = load(record.key, std::memory_order_acquire);
+            if (occupant == 0)
+            {
+                return std::nullopt;
+            }
+            if (occupant != key)
+            {
+                continue;
+            }
+            std::atomic_ref<std::uint64_t> sequence(record.sequence);
+            const std::uint64_t before = sequence.load(std::memory_order_acquire);
+            if (before == 0 || (before & 1U) != 0)
+            {
+                return std::nullopt;
+            }
+            const std::uint64_t base = load(record.base);
+            const std::uint64_t size = load(record.size);
+            const std::uint64_t protection_state = load(record.protection_state);
+            const std::uint64_t type = load(record.type);
+            const std::uint64_t record_epoch = load(record.epoch);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) != before || record_epoch != epoch || address < base ||
+                address - base >= size)
+            {
+                return std::nullopt;
+            }
+            broker().shared_region_hits.fetch_add(1, std::memory_order_relaxed);
+            return SharedRegion{
+                .base = static_cast<std::uintptr_t>(base),
+                .size = static_cast<std::size_t>(size),
+                .protection = static_cast<std::uint32_t>(protection_state),
+                .state = static_cast<std::uint32_t>(protection_state >> 32),
+                .type = static_cast<std::uint32_t>(type),
+            };
+        }
+        return std::nullopt;
+    }
+
+    void detail::shared_region_publish(std::uintptr_t address, const SharedRegion &region,
+                                       std::uint64_t epoch) noexcept
+    {
+        Registry *const registry = joined_registry();
+        if (registry == nullptr || region.size == 0)
+        {
+            return;
+        }
+        const std::uint64_t key = (static_cast<std::uint64_t>(address) >> REGION_GRANULE_SHIFT) + 1;
+        for (std::size_t probe = 0; probe < REGION_PROBES; ++probe)
+        {
+            RegionRecord &record = registry->regions[(key + probe) % REGION_SLOTS];
+            std::uint64_t occupant = 0;
+            if (!std::atomic_ref<std::uint64_t>(record.key).compare_exchange_strong(occupant, key,
+                                                                                   std::memory_order_acq_rel) &&
+                occupant != key)
+            {
+                continue;
+            }
+            // A concurrent writer already holds the record, and its region is as good as this one.
+            std::atomic_ref<std::uint64_t> sequence(record.sequence);
+            std::uint64_t current = sequence.load(std::memory_order_relaxed);
+            if ((current & 1U) != 0 ||
+                !sequence.compare_exchange_strong(current, current + 1, std::memory_order_acquire))
+            {
+                return;
+            }
+            std::atomic_thread_fence(std::memory_order_release);
+            store(record.base, region.base);
+            store(record.size, region.size);
+            store(record.protection_state, (static_cast<std::uint64_t>(region.state) << 32) | region.protection);
+            store(record.type, region.type);
+            store(record.epoch, epoch);
+            sequence.store(current + 2, std::memory_order_release);
+            return;
+        }
+    }
+
+    void detail::shared_region_invalidate() noexcept
+    {
+        // Also after leaving: the regions this instance published stay visible to the rest until retired.
+        if (Registry *const registry = broker().registry.load(std::memory_order_acquire))
+        {
+            std::atomic_ref<std::uint64_t>(registry->header.region_epoch).fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+} // namespace DetourModKit
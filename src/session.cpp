@@ -1,12 +1,21 @@
 #include "DetourModKit/session.hpp"
 
 #include "DetourModKit/config.hpp"
+#include "DetourModKit/deferred.hpp"
 #include "DetourModKit/diagnostics.hpp"
 #include "DetourModKit/input.hpp"
 #include "DetourModKit/logger.hpp"
 #include "DetourModKit/memory.hpp"
+#include "DetourModKit/scan_cache.hpp"
+#include "DetourModKit/services.hpp"
 
+#include "fork_join.hpp"
+#include "internal/background_service.hpp"
 #include "internal/config_reload_gate.hpp"
+#include "internal/file_watch_service.hpp"
+#include "internal/lifecycle_timings.hpp"
+#include "internal/scan_cache.hpp"
+#include "internal/subsystem_usage.hpp"
 #include "platform.hpp"
 
 #include <windows.h>
@@ -16,12 +25,20 @@
 #include <cstdint>
 #include <cwchar>
 #include <exception>
+#include <new>
 #include <optional>
 #include <string>
 #include <utility>
 
 namespace DetourModKit
 {
+    namespace detail
+    {
+        // Test-only override for is_process_terminating(), mirroring g_async_logger_loader_lock_override: a process
+        // cannot exit and keep running the suite, so the test drives ~Session's process-exit branch through this.
+        bool (*g_process_terminating_override)() noexcept = nullptr;
+    } // namespace detail
+
     namespace
     {
         // Static bootstrap machinery (the async DllMain path only)
@@ -54,6 +71,20 @@ namespace DetourModKit
         // process teardown is the use-after-unload hazard the leak-on-purpose discipline forbids; the OS reclaims it.
         std::move_only_function<Result<void>(Session &)> s_on_ready;
 
+        // The reload cache (enable_reload_cache). Built on the first enable and never destroyed, so a resolve that
+        // loaded the pointer just before a disable still reaches a live (emptied) object; s_reload_cache is null while
+        // the cache is off.
+        alignas(scan::ResolutionCache) unsigned char s_reload_cache_storage[sizeof(scan::ResolutionCache)];
+        std::atomic<scan::ResolutionCache *> s_reload_cache{nullptr};
+
+        // Throws std::bad_alloc when the first construction cannot allocate; the next call retries.
+        scan::ResolutionCache &reload_cache_instance()
+        {
+            static scan::ResolutionCache *const cache =
+                ::new (static_cast<void *>(s_reload_cache_storage)) scan::ResolutionCache();
+            return *cache;
+        }
+
         // Compares the running executable's basename (case-insensitive) against @p expected. An empty expectation
         // always passes. Resolved as wide (not GetModuleFileNameA) so a non-ASCII EXE basename is not mangled through
         // the active code page and cannot false-match or false-miss the gate.
@@ -183,6 +214,100 @@ namespace DetourModKit
             return MutexAcquire::Acquired;
         }
 
+        // Times back-to-back phases of one lifecycle list: each end() records the time since the previous one (or since
+        // construction, which also empties the list).
+        class PhaseClock
+        {
+        public:
+            explicit PhaseClock(detail::LifecyclePhaseList list) noexcept
+                : m_list(list), m_since(std::chrono::steady_clock::now())
+            {
+                detail::begin_lifecycle_phases(list);
+            }
+
+            void end(const char *name) noexcept
+            {
+                const auto now = std::chrono::steady_clock::now();
+                detail::record_lifecycle_phase(m_list, name,
+                                               std::chrono::duration_cast<std::chrono::microseconds>(now - m_since));
+                m_since = now;
+            }
+
+        private:
+            detail::LifecyclePhaseList m_list;
+            std::chrono::steady_clock::time_point m_since;
+        };
+
+        [[nodiscard]] bool process_terminating() noexcept
+        {
+            if (auto *override_fn = detail::g_process_terminating_override)
+            {
+                return override_fn();
+            }
+            return detail::is_process_terminating();
+        }
+
+        // The process-exit counterpart of run_subsystem_teardown. Every other thread is already gone and the OS is
+        // reclaiming the address space, so stopping a subsystem buys nothing: each one that started is recorded as an
+        // intentional leak instead, and only the log sink is flushed so the last lines reach the file. Allocates
+        // nothing and takes no lock a terminated thread could have died holding.
+        void run_process_exit_teardown() noexcept
+        {
+            using diagnostics::LeakSubsystem;
+            constexpr std::pair<detail::Subsystem, LeakSubsystem> started[] = {
+                {detail::Subsystem::ConfigWatcher, LeakSubsystem::ConfigWatcher},
+                {detail::Subsystem::FileWatchService, LeakSubsystem::Worker},
+                {detail::Subsystem::Input, LeakSubsystem::Input},
+                {detail::Subsystem::MemoryCache, LeakSubsystem::MemoryCache},
+                {detail::Subsystem::ForkJoinPool, LeakSubsystem::Worker},
+                {detail::Subsystem::BackgroundService, LeakSubsystem::Worker},
+            };
+            for (const auto &[subsystem, leak] : started)
+            {
+                if (detail::take_subsystem_used(subsystem))
+                {
+                    diagnostics::record_intentional_leak(leak);
+                }
+            }
+            log().flush_at_process_exit();
+        }
+
+        // The one lifecycle summary line, written just before the logger shuts down: how long the session took to
+        // start and to come up, and every teardown phase so far. Best-effort, since it formats on a teardown path.
+        void log_lifecycle_summary() noexcept
+        {
+            try
+            {
+                diagnostics::LifecycleTimings timings;
+                detail::collect_lifecycle_timings(timings);
+                (void)log().try_log(LogLevel::Info, "Session lifecycle: start {}, on_ready {:.1f} ms, teardown {}",
+                                    detail::describe_lifecycle_phases(detail::LifecyclePhaseList::Start),
+                                    static_cast<double>(timings.on_ready.count()) / 1000.0,
+                                    detail::describe_lifecycle_phases(detail::LifecyclePhaseList::Teardown));
+            }
+            catch (...)
+            {
+            }
+        }
+
+        // The unload counterpart of the lifecycle summary: one line with each phase of the unload that just ran.
+        void log_unload_summary(const char *caller) noexcept
+        {
+            try
+            {
+                (void)log().try_log(LogLevel::Info, "{}: done in {}", caller,
+                                    detail::describe_lifecycle_phases(detail::LifecyclePhaseList::Unload));
+                if (const scan::ResolutionCache *const cache = s_reload_cache.load(std::memory_order_acquire))
+                {
+                    (void)log().try_log(LogLevel::Info, "{}: reload cache keeps {} resolution(s) for the next load.",
+                                        caller, cache->size());
+                }
+            }
+            catch (...)
+            {
+            }
+        }
+
         // The ordered process-wide subsystem teardown that ~Session runs after clearing the session's own scope. This
         // is the single home for the teardown ordering: reverse dependency order, with the logger LAST because every
         // prior step may still log. Each leaf shutdown embeds its OWN loader-lock guard (join when safe,
@@ -190,17 +315,48 @@ namespace DetourModKit
         // leaves rather than making one central, and therefore wrong, choice.
         void run_subsystem_teardown() noexcept
         {
+            constexpr detail::LifecyclePhaseList teardown = detail::LifecyclePhaseList::Teardown;
+            // Each subsystem below started on first use and marked itself (internal/subsystem_usage.hpp); one that
+            // never started is skipped rather than built just to be shut down. The order is the same either way.
+            const auto shut_down = [](detail::Subsystem subsystem, const char *phase, auto &&shutdown) noexcept
+            {
+                if (detail::take_subsystem_used(subsystem))
+                {
+                    detail::time_lifecycle_phase(teardown, phase, shutdown);
+                }
+            };
             // 1. Config auto-reload watcher first: its background thread can fire the user on_reload callback at any
             //    moment, so it must stop before any state that callback might touch is torn down.
-            config::disable_auto_reload();
+            shut_down(detail::Subsystem::ConfigWatcher, "config_watcher", []() { config::disable_auto_reload(); });
+            //    Its registration gone, the shared file-watch pump and dispatch threads go with it.
+            shut_down(detail::Subsystem::FileWatchService, "file_watch_service",
+                      []() { detail::shutdown_file_watch_service(); });
             // 2. Input poll thread (may invoke callbacks that log).
-            input::Input::instance().shutdown();
-            // 3. Memory cache cleanup thread (must stop before the logger it may log through).
-            memory::shutdown_cache();
-            // 4. Config registry: drops the bound std::function setters.
-            config::clear();
-            // 5. Logger last: flush and close the sink. Nothing may log after this.
-            log().shutdown();
+            shut_down(detail::Subsystem::Input, "input", []() { input::Input::instance().shutdown(); });
+            //    Deferred-resolution worker (may be resolving and installing a table, and runs callbacks that log).
+            shut_down(detail::Subsystem::DeferredResolution, "deferred_resolution", []() { deferred::shutdown(); });
+            // 3. Memory cache (cancels its cleanup task, which must stop before the logger it may log through).
+            shut_down(detail::Subsystem::MemoryCache, "memory_cache", []() { memory::shutdown_cache(); });
+            // 4. Fork-join pool workers (idle between batches; a worker mid-batch finishes its share first).
+            shut_down(detail::Subsystem::ForkJoinPool, "fork_join_pool", []() { detail::shutdown_fork_join_pool(); });
+            //    Shared services registry: a host hands every attached instance's tasks back, and an attached instance
+            //    takes its own back, before the service thread below is stopped.
+            shut_down(detail::Subsystem::SharedServices, "shared_services", []() { services::disable(); });
+            // 5. Shared background service thread, once every task above has been cancelled.
+            shut_down(detail::Subsystem::BackgroundService, "background_service",
+                      []() { detail::shutdown_background_service(); });
+            //    The reload cache belongs to the session, so it goes with it (nothing to do when it never came on).
+            if (reload_cache() != nullptr)
+            {
+                detail::time_lifecycle_phase(teardown, "reload_cache", []() { disable_reload_cache(); });
+            }
+            // 6. Config registry: drops the bound std::function setters.
+            detail::time_lifecycle_phase(teardown, "config_registry", []() { config::clear(); });
+            // 7. Logger last: flush and close the sink. Nothing may log after this, so the summary line goes first and
+            //    the logger's own phase is only in the diagnostics snapshot.
+            log_lifecycle_summary();
+            detail::time_lifecycle_phase(teardown, "logger", []() { log().shutdown(); });
+            detail::finish_shutdown_timing();
         }
 
         // Resets any partially-built bootstrap state after a setup failure. Destroying s_pending_session runs a clean
@@ -261,7 +417,10 @@ namespace DetourModKit
                 {
                     try
                     {
+                        const auto ready_start = std::chrono::steady_clock::now();
                         Result<void> ready = s_on_ready(session);
+                        detail::record_on_ready_time(std::chrono::duration_cast<std::chrono::microseconds>(
+                            std::chrono::steady_clock::now() - ready_start));
                         if (!ready)
                         {
                             (void)log().try_log(LogLevel::Error, "bootstrap: on_ready reported failure: {}",
@@ -424,9 +583,24 @@ namespace DetourModKit
             return;
         }
 
+        // A Session held in static storage is destroyed on the process-exit DLL_PROCESS_DETACH pass. Nothing it would
+        // stop can outlive the process, and the async logger's writer it would drain is already dead, so take the
+        // abandon path plus a sink flush. Hooks need no special case: their own destructors leak on the loader lock.
+        if (process_terminating())
+        {
+            m_scope.abandon();
+            run_process_exit_teardown();
+            m_instance_mutex = nullptr;
+            m_active = false;
+            s_session_active.store(false, std::memory_order_release);
+            return;
+        }
+
         // 1. Release this session's input bindings first, in reverse insertion order (a Hold binding's release edge
         //    fires before the bindings it may depend on).
-        m_scope.clear();
+        detail::begin_lifecycle_phases(detail::LifecyclePhaseList::Teardown);
+        detail::time_lifecycle_phase(detail::LifecyclePhaseList::Teardown, "scope_clear",
+                                     [this]() { m_scope.clear(); });
         // 2. Ordered process-wide subsystem teardown (logger last).
         run_subsystem_teardown();
         // 3. Release the single-instance guard so a subsequent load starts clean.
@@ -448,7 +622,10 @@ namespace DetourModKit
             return std::unexpected(Error{ErrorCode::SessionAlreadyActive, "Session::start"});
         }
 
-        if (!is_target_process(info.game_process_name))
+        PhaseClock phases(detail::LifecyclePhaseList::Start);
+        const bool target_process = is_target_process(info.game_process_name);
+        phases.end("process_gate");
+        if (!target_process)
         {
             // A clean "not for this process" outcome, not a fault: release the guard and let the caller decline to
             // load.
@@ -458,7 +635,9 @@ namespace DetourModKit
 
         HANDLE mutex = nullptr;
         DWORD err = 0;
-        switch (acquire_instance_mutex(info.instance_mutex_prefix, mutex, err))
+        const MutexAcquire acquired = acquire_instance_mutex(info.instance_mutex_prefix, mutex, err);
+        phases.end("instance_mutex");
+        switch (acquired)
         {
         case MutexAcquire::AlreadyHeld:
             s_session_active.store(false, std::memory_order_release);
@@ -478,6 +657,7 @@ namespace DetourModKit
             Logger::configure(info.name, info.log_file);
             // Qualified: inside this static member the free accessor is hidden by the non-static Session::log().
             DetourModKit::log().enable_async_mode(info.log);
+            phases.end("logger_start");
         }
         catch (...)
         {
@@ -579,12 +759,14 @@ namespace DetourModKit
             }
             s_module = nullptr;
             diagnostics::record_intentional_leak(diagnostics::LeakSubsystem::Bootstrap);
+            run_process_exit_teardown();
             return;
         }
 
         // EXPLICIT FreeLibrary. Signal the worker so its ~Session teardown runs OFF the loader lock (leaves JOIN).
         if (HANDLE event = s_shutdown_event.load(std::memory_order_acquire))
         {
+            detail::mark_shutdown_requested();
             SetEvent(event);
         }
 
@@ -641,6 +823,7 @@ namespace DetourModKit
         // retired it, and the no-op is the documented "already torn down" behaviour.
         if (HANDLE event = s_shutdown_event.load(std::memory_order_acquire))
         {
+            detail::mark_shutdown_requested();
             SetEvent(event);
         }
     }
@@ -661,9 +844,49 @@ namespace DetourModKit
 
     // Hot-reload helpers
 
+    Result<void> enable_reload_cache() noexcept
+    {
+        try
+        {
+            scan::ResolutionCache &cache = reload_cache_instance();
+            if (s_reload_cache.exchange(&cache, std::memory_order_acq_rel) == nullptr)
+            {
+                (void)log().try_log(LogLevel::Info, "Session: reload cache enabled.");
+            }
+            return {};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "enable_reload_cache"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::Unknown, "enable_reload_cache"});
+        }
+    }
+
+    void disable_reload_cache() noexcept
+    {
+        if (scan::ResolutionCache *const cache = s_reload_cache.exchange(nullptr, std::memory_order_acq_rel))
+        {
+            cache->clear();
+        }
+    }
+
+    scan::ResolutionCache *reload_cache() noexcept
+    {
+        return s_reload_cache.load(std::memory_order_acquire);
+    }
+
+    scan::ResolutionCache *detail::reload_resolution_cache() noexcept
+    {
+        return s_reload_cache.load(std::memory_order_acquire);
+    }
+
     void on_logic_dll_unload(std::span<const std::string_view> binding_names) noexcept
     {
         Logger &logger = log();
+        PhaseClock phases(detail::LifecyclePhaseList::Unload);
         size_t bindings_removed = 0;
 
         for (const auto name : binding_names)
@@ -700,6 +923,8 @@ namespace DetourModKit
             }
         }
 
+        phases.end("bindings");
+
         try
         {
             logger.info("on_logic_dll_unload: drained {} binding(s).", bindings_removed);
@@ -729,8 +954,12 @@ namespace DetourModKit
         // unload.
         config::detail::disable_reloads_for_unload();
         config::disable_auto_reload();
+        phases.end("config_watcher");
         config::clear();
-        if (!config::detail::await_reloads_quiesced(std::chrono::milliseconds(500)))
+        phases.end("config_registry");
+        const bool quiesced = config::detail::await_reloads_quiesced(std::chrono::milliseconds(500));
+        phases.end("reload_quiesce");
+        if (!quiesced)
         {
             try
             {
@@ -741,11 +970,13 @@ namespace DetourModKit
             {
             }
         }
+        log_unload_summary("on_logic_dll_unload");
     }
 
     void on_logic_dll_unload_all() noexcept
     {
         Logger &logger = log();
+        PhaseClock phases(detail::LifecyclePhaseList::Unload);
 
         // clear_bindings() leaves the poll thread running and ready for fresh bindings, matching the "tear down
         // per-Logic-DLL state but keep the manager re-usable" contract. Pass invoke_callbacks == false for the same
@@ -777,6 +1008,8 @@ namespace DetourModKit
             }
         }
 
+        phases.end("bindings");
+
         // Only claim success when clear_bindings actually completed: on a caught throw the error above already recorded
         // the partial teardown, so an unconditional "drained all bindings" would misreport it as a clean drain.
         if (bindings_cleared)
@@ -796,8 +1029,12 @@ namespace DetourModKit
         // on_logic_dll_unload for the full rationale.
         config::detail::disable_reloads_for_unload();
         config::disable_auto_reload();
+        phases.end("config_watcher");
         config::clear();
-        if (!config::detail::await_reloads_quiesced(std::chrono::milliseconds(500)))
+        phases.end("config_registry");
+        const bool quiesced = config::detail::await_reloads_quiesced(std::chrono::milliseconds(500));
+        phases.end("reload_quiesce");
+        if (!quiesced)
         {
             try
             {
@@ -808,5 +1045,6 @@ namespace DetourModKit
             {
             }
         }
+        log_unload_summary("on_logic_dll_unload_all");
     }
 } // namespace DetourModKit
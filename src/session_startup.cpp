@@ -0,0 +1,306 @@
+/**
+ * @file session_startup.cpp
+ * @brief The staged startup pipeline: run_startup_pipeline and log_startup_report.
+ * @details The stages form a DAG with any number of parents per node, so the pipeline keeps its own ready list rather
+ *          than the one-parent forest of fork_join_graph_dispatch. fork_join_dispatch only supplies the threads: each
+ *          of its indices is one participant that takes ready stages from the shared list until every stage is done,
+ *          waiting on a condition variable while the stages it could run are still blocked on ones in flight. A
+ *          participant whose worker never joined is run by the caller after its own loop, by which time nothing is
+ *          left, so its loop returns at once.
+ */
+
+#include "DetourModKit/session.hpp"
+
+#include "DetourModKit/logger.hpp"
+
+#include "fork_join.hpp"
+#include "internal/lifecycle_timings.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <mutex>
+#include <new>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        struct PipelineRun
+        {
+            std::span<const StartupStage> stages;
+            Clock::time_point start;
+            // dependents[i] lists the stages whose `after` names stage i.
+            std::vector<std::vector<std::size_t>> dependents;
+            // Dependencies of each stage that have not succeeded yet.
+            std::vector<std::size_t> waiting_on;
+            std::vector<StartupStageTiming> timings;
+            std::vector<std::size_t> ready;
+            std::size_t done = 0;
+            std::mutex mutex;
+            std::condition_variable wake;
+        };
+
+        std::chrono::microseconds since(Clock::time_point from, Clock::time_point to) noexcept
+        {
+            return std::chrono::duration_cast<std::chrono::microseconds>(to - from);
+        }
+
+        // Marks every not-yet-started stage downstream of @p index Skipped. The caller holds the mutex.
+        void skip_dependents(PipelineRun &run, std::size_t index) noexcept
+        {
+            for (const std::size_t dependent : run.dependents[index])
+            {
+                // waiting_on is zeroed once a stage is queued or skipped, so each stage is finished exactly once.
+                if (run.waiting_on[dependent] != 0)
+                {
+                    run.waiting_on[dependent] = 0;
+                    ++run.done;
+                    skip_dependents(run, dependent);
+                }
+            }
+        }
+
+        Result<void> run_stage(const StartupStage &stage) noexcept
+        {
+            // A stage is a whole subsystem's setup, often a scan batch of its own. Clear the nested-batch flag the
+            // dispatch set so that batch may still fan out; the pool's invitations keep the nesting safe.
+            bool &inside = detail::in_fork_join_worker();
+            const bool was_inside = inside;
+            inside = false;
+            Result<void> result;
+            try
+            {
+                result = stage.run();
+            }
+            catch (const std::bad_alloc &)
+            {
+                result = std::unexpected(Error{ErrorCode::OutOfMemory, "startup stage"});
+            }
+            catch (...)
+            {
+                result = std::unexpected(Error{ErrorCode::Unknown, "startup stage"});
+            }
+            inside = was_inside;
+            return result;
+        }
+
+        void participate(void *context, std::size_t) noexcept
+        {
+            PipelineRun &run = *static_cast<PipelineRun *>(context);
+            std::unique_lock lock(run.mutex);
+            for (;;)
+            {
+                run.wake.wait(lock, [&run]() { return !run.ready.empty() || run.done == run.stages.size(); });
+                if (run.ready.empty())
+                {
+                    return;
+                }
+                const std::size_t index = run.ready.back();
+                run.ready.pop_back();
+                lock.unlock();
+
+                const Clock::time_point started = Clock::now();
+                Result<void> result = run_stage(run.stages[index]);
+                const Clock::time_point finished = Clock::now();
+
+                lock.lock();
+                StartupStageTiming &timing = run.timings[index];
+                timing.started_at = since(run.start, started);
+                timing.elapsed = since(started, finished);
+                ++run.done;
+                if (result)
+                {
+                    timing.status = StartupStageStatus::Succeeded;
+                    for (const std::size_t dependent : run.dependents[index])
+                    {
+                        if (run.waiting_on[dependent] != 0 && --run.waiting_on[dependent] == 0)
+                        {
+                            run.ready.push_back(dependent);
+                        }
+                    }
+                }
+                else
+                {
+                    timing.status = StartupStageStatus::Failed;
+                    timing.error = result.error();
+                    skip_dependents(run, index);
+                }
+                run.wake.notify_all();
+            }
+        }
+
+        // Fills dependents and waiting_on from the stages' `after` lists and checks the graph is a DAG over known,
+        // unique names. waiting_on is left at each stage's dependency count.
+        Result<void> build_graph(PipelineRun &run)
+        {
+            const std::span<const StartupStage> stages = run.stages;
+            run.dependents.resize(stages.size());
+            run.waiting_on.assign(stages.size(), 0);
+            const auto find = [stages](std::string_view name) noexcept -> std::size_t
+            {
+                const auto it = std::ranges::find(stages, name, &StartupStage::name);
+                return static_cast<std::size_t>(it - stages.begin());
+            };
+            for (std::size_t i = 0; i < stages.size(); ++i)
+            {
+                if (!stages[i].run || find(stages[i].name) != i)
+                {
+                    return std::unexpected(Error{ErrorCode::InvalidArg, "run_startup_pipeline", i});
+                }
+                for (const std::string_view dependency : stages[i].after)
+                {
+                    const std::size_t parent = find(dependency);
+                    if (parent == stages.size() || parent == i)
+                    {
+                        return std::unexpected(Error{ErrorCode::InvalidArg, "run_startup_pipeline", i});
+                    }
+                    run.dependents[parent].push_back(i);
+                    ++run.waiting_on[i];
+                }
+            }
+
+            // Kahn's algorithm over a scratch copy: a stage the sweep never frees sits on or behind a cycle.
+            std::vector<std::size_t> pending = run.waiting_on;
+            std::vector<std::size_t> frontier;
+            for (std::size_t i = 0; i < stages.size(); ++i)
+            {
+                if (pending[i] == 0)
+                {
+                    frontier.push_back(i);
+                }
+            }
+            std::size_t freed = 0;
+            while (!frontier.empty())
+            {
+                const std::size_t index = frontier.back();
+                frontier.pop_back();
+                ++freed;
+                for (const std::size_t dependent : run.dependents[index])
+                {
+                    if (--pending[dependent] == 0)
+                    {
+                        frontier.push_back(dependent);
+                    }
+                }
+            }
+            if (freed != stages.size())
+            {
+                const auto stuck = std::ranges::find_if(pending, [](std::size_t count) { return count != 0; });
+                return std::unexpected(Error{ErrorCode::InvalidArg, "run_startup_pipeline",
+                                             static_cast<std::uintptr_t>(stuck - pending.begin())});
+            }
+            return {};
+        }
+
+        double to_ms(std::chrono::microseconds us) noexcept
+        {
+            return static_cast<double>(us.count()) / 1000.0;
+        }
+    } // namespace
+
+    Result<StartupReport> run_startup_pipeline(std::span<const StartupStage> stages, std::size_t max_workers) noexcept
+    {
+        try
+        {
+            PipelineRun run;
+            run.stages = stages;
+            if (Result<void> graph = build_graph(run); !graph)
+            {
+                return std::unexpected(graph.error());
+            }
+            run.timings.resize(stages.size());
+            run.ready.reserve(stages.size());
+            for (std::size_t i = 0; i < stages.size(); ++i)
+            {
+                run.timings[i].name = std::string(stages[i].name);
+                if (run.waiting_on[i] == 0)
+                {
+                    run.ready.push_back(i);
+                }
+            }
+            // The ready list is a stack; reverse it so roots start in declaration order.
+            std::ranges::reverse(run.ready);
+
+            run.start = Clock::now();
+            const std::size_t participants = detail::fork_join_worker_count(stages.size(), max_workers);
+            if (participants != 0)
+            {
+                detail::fork_join_dispatch(participants, participants - 1, &participate, &run);
+            }
+
+            StartupReport report;
+            report.total = since(run.start, Clock::now());
+            for (const StartupStageTiming &timing : run.timings)
+            {
+                report.serial += timing.elapsed;
+            }
+            report.stages = std::move(run.timings);
+
+            std::vector<diagnostics::PhaseTiming> phases;
+            phases.reserve(report.stages.size());
+            for (const StartupStageTiming &stage : report.stages)
+            {
+                phases.push_back(diagnostics::PhaseTiming{stage.name, stage.elapsed});
+            }
+            detail::record_startup_stages(std::move(phases));
+            return report;
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "run_startup_pipeline"});
+        }
+        catch (...)
+        {
+            return std::unexpected(Error{ErrorCode::Unknown, "run_startup_pipeline"});
+        }
+    }
+
+    void log_startup_report(const StartupReport &report) noexcept
+    {
+        try
+        {
+            std::string stages;
+            for (const StartupStageTiming &stage : report.stages)
+            {
+                if (!stages.empty())
+                {
+                    stages += ", ";
+                }
+                if (stage.status == StartupStageStatus::Skipped)
+                {
+                    std::format_to(std::back_inserter(stages), "{} skipped", stage.name);
+                }
+                else
+                {
+                    std::format_to(std::back_inserter(stages), "{} {:.1f} ms{}", stage.name, to_ms(stage.elapsed),
+                                   stage.status == StartupStageStatus::Failed ? " failed" : "");
+                }
+            }
+            (void)log().try_log(LogLevel::Info, "Startup: {} stage(s) in {:.1f} ms (serial {:.1f} ms): {}",
+                                report.stages.size(), to_ms(report.total), to_ms(report.serial), stages);
+            for (const StartupStageTiming &stage : report.stages)
+            {
+                if (stage.error)
+                {
+                    (void)log().try_log(LogLevel::Error, "Startup: stage '{}' failed: {}", stage.name,
+                                        stage.error->message());
+                }
+            }
+        }
+        catch (...)
+        {
+            // Best-effort: a report that cannot be formatted is simply not logged.
+        }
+    }
+} // namespace DetourModKit
@@ -4,11 +4,14 @@
 #include "DetourModKit/manifest.hpp"
 #include "DetourModKit/scan.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <format>
+#include <optional>
 #include <span>
 #include <string>
 #include <string_view>
@@ -104,6 +107,88 @@ namespace DetourModKit
                 return entropy;
             }
 
+            // Scan-cost model
+
+            constexpr double BYTES_PER_MIB = 1024.0 * 1024.0;
+
+            // Selectivity of one pattern position in bits, as analyze_pattern sums it.
+            [[nodiscard]] double position_bits(std::uint8_t mask, std::uint8_t value) noexcept
+            {
+                if (mask == 0xFF)
+                {
+                    return fixed_byte_bits(value);
+                }
+                return (mask == 0x00) ? 0.0 : 4.0;
+            }
+
+            // Prices one sweep the way the engine runs it. The memchr for the anchor byte touches every haystack
+            // byte; each hit verifies segment 0; and each segment-0 match of a jump-bearing pattern walks the widths
+            // of its first gap, each placement that matches the next segment walks the next gap, and so on. Hit rates
+            // use the selectivity model's per-position probabilities, 2^(-bits), so this and expected_matches agree.
+            [[nodiscard]] PatternCost estimate_cost(const scan::Pattern &pattern, const HealthPolicy &policy) noexcept
+            {
+                PatternCost cost{};
+                const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+                const std::span<const std::byte> bytes = pattern.bytes();
+                const std::span<const std::byte> mask = pattern.mask();
+
+                // Without an anchor the engine verifies at every position, so every byte is a "hit".
+                double hit_probability = 1.0;
+                cost.anchor_index = pattern.size();
+                if (pattern.has_anchor())
+                {
+                    cost.anchor_index = pattern.anchor_index();
+                    hit_probability =
+                        std::exp2(-fixed_byte_bits(std::to_integer<std::uint8_t>(pattern.anchor_byte())));
+                }
+                cost.anchor_hits_per_mib = BYTES_PER_MIB * hit_probability;
+
+                std::array<double, detail::MAX_PATTERN_JUMPS + 1> segment_bits{};
+                std::size_t segment = 0;
+                for (std::size_t index = 0; index < pattern.size(); ++index)
+                {
+                    if (segment < buffer.jump_count && index == buffer.jumps[segment].position)
+                    {
+                        ++segment;
+                    }
+                    segment_bits[segment] += position_bits(std::to_integer<std::uint8_t>(mask[index]),
+                                                           std::to_integer<std::uint8_t>(bytes[index]));
+                }
+
+                // Per haystack position: how often the walk reaches each gap, and the placements it tries there.
+                constexpr std::uint64_t budget = detail::SEGMENT_MATCH_STEP_BUDGET;
+                const double placements = std::exp2(-segment_bits[0]);
+                double reaching = placements;
+                double steps = 0.0;
+                for (std::size_t gap = 0; gap < buffer.jump_count; ++gap)
+                {
+                    const std::uint64_t width = buffer.jumps[gap].max_skip - buffer.jumps[gap].min_skip + 1;
+                    cost.gap_combinations = std::min(cost.gap_combinations * width, budget + 1);
+                    steps += reaching * static_cast<double>(width);
+                    reaching *= static_cast<double>(width) * std::exp2(-segment_bits[gap + 1]);
+                }
+                // The matcher gives up on a placement once it spends its budget, which bounds the walk per match.
+                steps = std::min(steps, placements * static_cast<double>(budget));
+                cost.backtrack_steps_per_mib = BYTES_PER_MIB * steps;
+
+                const double haystack = static_cast<double>(policy.nominal_haystack_bytes);
+                const double mib = haystack / BYTES_PER_MIB;
+                const double sweep_us = policy.scan_bytes_per_us > 0.0 ? haystack / policy.scan_bytes_per_us : 0.0;
+                const double work_ns = cost.anchor_hits_per_mib * policy.verify_ns +
+                                       cost.backtrack_steps_per_mib * policy.backtrack_step_ns;
+                cost.estimated_us = sweep_us + mib * work_ns / 1000.0;
+                return cost;
+            }
+
+            // The time-based finding, kept apart so a calibration can re-judge it on the measured figure.
+            void add_expensive_scan_finding(PatternHealth &health, const HealthPolicy &policy)
+            {
+                if (health.cost.expected_us() > policy.warn_scan_us)
+                {
+                    add_finding(health.findings, FindingKind::ExpensiveScan, Severity::Warning);
+                }
+            }
+
             // Enum naming (local: no public stringifier exists for these)
 
             [[nodiscard]] std::string_view anchor_kind_name(anchor::AnchorKind kind) noexcept
@@ -286,6 +371,71 @@ namespace DetourModKit
                 add_finding(health.findings, FindingKind::WeakSelectivity, Severity::Warning);
             }
 
+            health.cost = estimate_cost(pattern, policy);
+            if (health.cost.gap_combinations > detail::SEGMENT_MATCH_STEP_BUDGET)
+            {
+                add_finding(health.findings, FindingKind::BacktrackingRisk, Severity::Critical);
+            }
+            else if (health.cost.gap_combinations > policy.warn_gap_combinations)
+            {
+                add_finding(health.findings, FindingKind::BacktrackingRisk, Severity::Warning);
+            }
+            add_expensive_scan_finding(health, policy);
+
+            health.grade = grade_from(health.findings);
+            return health;
+        }
+
+        Result<PatternHealth> analyze_pattern_calibrated(const scan::Pattern &pattern, Region scope,
+                                                         const HealthPolicy &policy, scan::Pages pages)
+        {
+            PatternHealth health = analyze_pattern(pattern, policy);
+
+            std::size_t matches = 0;
+            const auto started = std::chrono::steady_clock::now();
+            const Result<scan::MatchSummary> swept =
+                scan::for_each_match(pattern, scope, [&matches](Address) noexcept { ++matches; }, pages);
+            const auto finished = std::chrono::steady_clock::now();
+            if (!swept)
+            {
+                return std::unexpected(swept.error());
+            }
+
+            // The prefilter byte's real frequency, counted with a one-byte pattern of it. Without one, every position
+            // is a candidate, exactly as the model assumes.
+            PatternCost &cost = health.cost;
+            const double mib = static_cast<double>(scope.size) / BYTES_PER_MIB;
+            cost.measured_anchor_hits_per_mib = BYTES_PER_MIB;
+            if (pattern.has_anchor())
+            {
+                detail::PatternBuffer anchor{};
+                anchor.bytes[0] = pattern.anchor_byte();
+                anchor.mask[0] = std::byte{0xFF};
+                anchor.length = 1;
+                std::size_t hits = 0;
+                if (const std::optional<scan::Pattern> probe = detail::pattern_from_buffer(anchor))
+                {
+                    const Result<scan::MatchSummary> counted =
+                        scan::for_each_match(*probe, scope, [&hits](Address) noexcept { ++hits; }, pages);
+                    if (!counted)
+                    {
+                        return std::unexpected(counted.error());
+                    }
+                }
+                cost.measured_anchor_hits_per_mib = mib > 0.0 ? static_cast<double>(hits) / mib : 0.0;
+            }
+
+            cost.calibrated = true;
+            cost.measured_bytes = scope.size;
+            cost.measured_matches = matches;
+            cost.measured_us = std::chrono::duration<double, std::micro>(finished - started).count();
+            cost.projected_us = cost.measured_bytes > 0 ? cost.measured_us *
+                                                              static_cast<double>(policy.nominal_haystack_bytes) /
+                                                              static_cast<double>(cost.measured_bytes)
+                                                        : 0.0;
+            std::erase_if(health.findings,
+                          [](const Finding &finding) { return finding.kind == FindingKind::ExpensiveScan; });
+            add_expensive_scan_finding(health, policy);
             health.grade = grade_from(health.findings);
             return health;
         }
@@ -534,6 +684,10 @@ namespace DetourModKit
                 return "the record kind is not file-serializable (Quorum / CallArgHome / Unset)";
             case FindingKind::NoRobustRung:
                 return "no candidate rung graded Robust";
+            case FindingKind::ExpensiveScan:
+                return "the estimated scan time over the nominal module is high";
+            case FindingKind::BacktrackingRisk:
+                return "the bounded-jump widths multiply into many gap placements per match";
             case FindingKind::UncompilableRecord:
                 return "the record does not compile as a signature (bad rung layout, page class, or kind)";
             }
@@ -581,6 +735,18 @@ namespace DetourModKit
                 std::format("  atoms={} longest_atom={} entropy={:.1f} bits selectivity={:.1f} bits\n",
                             health.atom_count, health.longest_atom, health.byte_entropy_bits, health.selectivity_bits);
             out += std::format("  expected_matches~={:.3g}\n", health.expected_matches);
+            out += std::format("  cost: anchor_hits~={:.3g}/MiB gap_combinations={} backtrack~={:.3g}/MiB "
+                               "estimated~={:.1f} ms\n",
+                               health.cost.anchor_hits_per_mib, health.cost.gap_combinations,
+                               health.cost.backtrack_steps_per_mib, health.cost.estimated_us / 1000.0);
+            if (health.cost.calibrated)
+            {
+                out += std::format("  measured: {:.1f} ms over {} bytes ({} matches, anchor_hits={:.3g}/MiB), "
+                                   "projected~={:.1f} ms\n",
+                                   health.cost.measured_us / 1000.0, health.cost.measured_bytes,
+                                   health.cost.measured_matches, health.cost.measured_anchor_hits_per_mib,
+                                   health.cost.projected_us / 1000.0);
+            }
             append_findings(out, health.findings);
             return out;
         }
@@ -598,7 +764,15 @@ namespace DetourModKit
                 for (std::size_t index = 0; index < health.ladder.size(); ++index)
                 {
                     const CandidateHealth &rung = health.ladder[index];
-                    out += std::format("  rung {} ({}): {}\n", index, mode_name(rung.mode), to_string(rung.grade));
+                    if (rung.pattern.length > 0)
+                    {
+                        out += std::format("  rung {} ({}): {}, ~{:.1f} ms per sweep\n", index, mode_name(rung.mode),
+                                           to_string(rung.grade), rung.pattern.cost.expected_us() / 1000.0);
+                    }
+                    else
+                    {
+                        out += std::format("  rung {} ({}): {}\n", index, mode_name(rung.mode), to_string(rung.grade));
+                    }
                     append_findings(out, rung.findings);
                 }
             }
@@ -621,5 +795,57 @@ namespace DetourModKit
             }
             return out;
         }
+
+        std::string format_report(const ManifestLiveHealth &health)
+        {
+            std::string out = std::format("live manifest health: {} ({} robust, {} fragile, {} unusable, {} skipped of "
+                                          "{}) over {} bytes{}\n",
+                                          to_string(health.grade), health.robust, health.fragile, health.unusable,
+                                          health.skipped, health.records.size(), health.scanned_bytes,
+                                          health.complete ? "" : ", incomplete: counts are lower bounds");
+            if constexpr (scan::SCAN_TELEMETRY_ENABLED)
+            {
+                const scan::ScanTelemetry &work = health.telemetry;
+                out += std::format("telemetry: {} region(s), {} anchor candidate(s), {} verify call(s), {} fault(s) in "
+                                   "{} us\n",
+                                   work.regions_walked, work.anchor_candidates, work.verify_calls, work.faults,
+                                   std::chrono::duration_cast<std::chrono::microseconds>(work.elapsed).count());
+            }
+            for (const RecordLiveHealth &record : health.records)
+            {
+                out += std::format("[{}] kind={}", record.label, anchor_kind_name(record.kind));
+                if (!record.analyzed)
+                {
+                    out += " not analyzed\n";
+                    continue;
+                }
+                if (record.winning_rung)
+                {
+                    out += std::format(" grade={} winner=rung {} margin={}\n", to_string(record.grade),
+                                       *record.winning_rung, record.margin);
+                }
+                else
+                {
+                    out += std::format(" grade={} no rung matched exactly once\n", to_string(record.grade));
+                }
+                for (std::size_t index = 0; index < record.ladder.size(); ++index)
+                {
+                    const RungLiveHealth &rung = record.ladder[index];
+                    if (!rung.analyzed)
+                    {
+                        out += std::format("  rung {} ({}): not analyzed\n", index, mode_name(rung.mode));
+                        continue;
+                    }
+                    out += std::format("  rung {} ({}): matches={} near_misses=[", index, mode_name(rung.mode),
+                                       rung.matches);
+                    for (std::size_t d = 0; d < rung.near_misses.size(); ++d)
+                    {
+                        out += std::format("{}{}", d == 0 ? "" : " ", rung.near_misses[d]);
+                    }
+                    out += std::format("] within {} mismatch(es)\n", rung.distance);
+                }
+            }
+            return out;
+        }
     } // namespace sighealth
 } // namespace DetourModKit
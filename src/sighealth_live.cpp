@@ -0,0 +1,459 @@
+/**
+ * @file sighealth_live.cpp
+ * @brief sighealth::analyze_manifest_live: every byte rung's exact matches and near misses, in one parallel sweep.
+ * @details A rung searched to depth d is cut into d + 1 blocks over its constrained positions, each holding at least
+ *          one fully-known byte, so a site within d mismatches matches some block exactly (the pigeonhole principle).
+ *          Each block is keyed by its rarest fully-known byte into one 256-entry table shared by every rung. The
+ *          sweep cuts the scope's page windows into chunks, and each fork-join worker walks one chunk under the
+ *          page-gated scans' fault guard: at every byte it looks up the blocks keyed on that value, and for each
+ *          whose block matches exactly it counts the site's mismatches over the whole pattern. A site is credited
+ *          only to the first block that matches it exactly, so it is counted once however many of its blocks agree,
+ *          and a chunk owns the key bytes inside it, so a site is also counted in one chunk only.
+ */
+
+#include "DetourModKit/sighealth.hpp"
+
+#include "fork_join.hpp"
+#include "internal/memory_fault.hpp"
+#include "internal/scan_pages.hpp"
+#include "internal/scan_telemetry.hpp"
+
+#include "DetourModKit/defines.hpp"
+#include "DetourModKit/manifest.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace sighealth
+    {
+        namespace
+        {
+            // Bytes of key positions one chunk owns; the pointer map's build granularity.
+            constexpr std::size_t LIVE_CHUNK_BYTES = std::size_t{1} << 20;
+
+            // Histogram slots per rung: distance 0 (an exact match) through MAX_NEAR_MISS_DISTANCE.
+            constexpr std::size_t LIVE_SLOTS = MAX_NEAR_MISS_DISTANCE + 1;
+
+            // A site no block may credit: too far from the pattern, or owned by an earlier block.
+            constexpr std::size_t NOT_CREDITED = std::numeric_limits<std::size_t>::max();
+
+            // One analyzed rung: its byte/mask, the depth it is searched to, and its block boundaries. Block b covers
+            // pattern positions [block_begin[b], block_begin[b + 1]).
+            struct LiveRung
+            {
+                detail::PatternBuffer buffer{};
+                std::size_t distance = 0;
+                std::array<std::uint8_t, LIVE_SLOTS + 1> block_begin{};
+            };
+
+            // One block of one rung, filed under the value of its key byte at pattern position @ref key.
+            struct Probe
+            {
+                std::uint32_t rung = 0;
+                std::uint8_t block = 0;
+                std::uint8_t key = 0;
+            };
+
+            // Every block of every rung, grouped by key value: the probes for value v are
+            // probes[first[v]] .. probes[first[v + 1] - 1].
+            struct ProbeTable
+            {
+                std::vector<LiveRung> rungs;
+                std::vector<Probe> probes;
+                std::array<std::uint32_t, 257> first{};
+            };
+
+            struct Chunk
+            {
+                // Key positions [base, base + bytes) belong to this chunk.
+                std::uintptr_t base = 0;
+                std::size_t bytes = 0;
+                // The contiguous readable run the chunk sits in; every site read stays inside it.
+                std::uintptr_t run_lo = 0;
+                std::uintptr_t run_hi = 0;
+            };
+
+            struct ChunkCounts
+            {
+                // rung * LIVE_SLOTS + d counts the rung's sites exactly d mismatches away.
+                std::vector<std::uint32_t> counts;
+                bool failed = false;
+            };
+
+            struct SweepContext
+            {
+                const ProbeTable *table;
+                Chunk chunk;
+                std::uint32_t *counts;
+            };
+
+            [[nodiscard]] std::size_t block_mismatches(const detail::PatternBuffer &buffer, const std::byte *site,
+                                                       std::size_t lo, std::size_t hi, std::size_t limit) noexcept
+            {
+                std::size_t mismatches = 0;
+                for (std::size_t i = lo; i < hi && mismatches <= limit; ++i)
+                {
+                    if (!detail::byte_admitted(buffer, i, site[i]))
+                    {
+                        ++mismatches;
+                    }
+                }
+                return mismatches;
+            }
+
+            // The site's mismatches to @p rung when block @p block is the first block it matches exactly, else
+            // NOT_CREDITED. Stops counting once the site is past the rung's depth.
+            [[nodiscard]] std::size_t site_distance(const LiveRung &rung, std::size_t block,
+                                                    const std::byte *site) noexcept
+            {
+                const detail::PatternBuffer &buffer = rung.buffer;
+                if (block_mismatches(buffer, site, rung.block_begin[block], rung.block_begin[block + 1], 0) != 0)
+                {
+                    return NOT_CREDITED;
+                }
+                std::size_t total = 0;
+                for (std::size_t b = 0; b <= rung.distance; ++b)
+                {
+                    if (b == block)
+                    {
+                        continue;
+                    }
+                    const std::size_t mismatches = block_mismatches(buffer, site, rung.block_begin[b],
+                                                                    rung.block_begin[b + 1], rung.distance - total);
+                    if (b < block && mismatches == 0)
+                    {
+                        return NOT_CREDITED;
+                    }
+                    total += mismatches;
+                    if (total > rung.distance)
+                    {
+                        return NOT_CREDITED;
+                    }
+                }
+                return total;
+            }
+
+            // The body the sweep's fault guard wraps: reads each key byte of the chunk and verifies the sites its
+            // probes point at, writing only the preallocated counts.
+            DMK_NO_SANITIZE_ADDRESS void sweep_chunk(void *opaque) noexcept
+            {
+                const SweepContext &context = *static_cast<const SweepContext *>(opaque);
+                const ProbeTable &table = *context.table;
+                const Chunk &chunk = context.chunk;
+                std::uint64_t candidates = 0;
+                std::uint64_t verifies = 0;
+                for (std::uintptr_t p = chunk.base; p < chunk.base + chunk.bytes; ++p)
+                {
+                    const auto value = *reinterpret_cast<const std::uint8_t *>(p);
+                    for (std::uint32_t i = table.first[value]; i < table.first[value + 1]; ++i)
+                    {
+                        const Probe &probe = table.probes[i];
+                        const LiveRung &rung = table.rungs[probe.rung];
+                        if (p - chunk.run_lo < probe.key)
+                        {
+                            continue;
+                        }
+                        ++candidates;
+                        const std::uintptr_t site = p - probe.key;
+                        if (chunk.run_hi - site < rung.buffer.length)
+                        {
+                            continue;
+                        }
+                        ++verifies;
+                        const std::size_t distance =
+                            site_distance(rung, probe.block, reinterpret_cast<const std::byte *>(site));
+                        if (distance != NOT_CREDITED)
+                        {
+                            ++context.counts[probe.rung * LIVE_SLOTS + distance];
+                        }
+                    }
+                }
+                // A plain call, not a destructor: a faulted chunk abandons this body and its work goes uncounted.
+                detail::record_match_work(candidates, verifies, 0);
+            }
+
+            // Runs fn(ctx) over [lo, hi) under the TOCTOU fault guard the page-gated scans use. Returns false when a
+            // fault was swallowed and fn did not complete.
+            bool run_guarded(std::uintptr_t lo, std::uintptr_t hi, void (*fn)(void *) noexcept, void *ctx) noexcept
+            {
+#ifdef _MSC_VER
+                (void)lo;
+                (void)hi;
+                __try
+                {
+                    fn(ctx);
+                    return true;
+                }
+                __except (detail::guarded_fault_filter(GetExceptionInformation()))
+                {
+                    return false;
+                }
+#elif defined(_WIN64)
+                return detail::run_guarded_region(lo, hi, fn, ctx);
+#endif
+            }
+
+            // The counts are allocated before the guard; a faulted chunk keeps the sites it counted before the fault.
+            [[nodiscard]] ChunkCounts sweep_one(const Chunk &chunk, const ProbeTable &table)
+            {
+                ChunkCounts result;
+                result.counts.assign(table.rungs.size() * LIVE_SLOTS, 0);
+                SweepContext context{&table, chunk, result.counts.data()};
+                result.failed = !run_guarded(chunk.run_lo, chunk.run_hi, sweep_chunk, &context);
+                return result;
+            }
+
+            // Cuts @p rung into distance + 1 blocks of about equal fully-known byte counts and files each under its
+            // rarest fully-known byte. Lowers the depth when the pattern has too few fully-known bytes to split on.
+            // Returns false when the pattern has none.
+            [[nodiscard]] bool plan_blocks(LiveRung &rung, std::size_t depth, std::uint32_t index,
+                                           std::vector<Probe> &probes)
+            {
+                const detail::PatternBuffer &buffer = rung.buffer;
+                std::vector<std::size_t> fixed;
+                for (std::size_t i = 0; i < buffer.length; ++i)
+                {
+                    if (buffer.mask[i] == std::byte{0xFF})
+                    {
+                        fixed.push_back(i);
+                    }
+                }
+                if (fixed.empty())
+                {
+                    return false;
+                }
+                rung.distance = std::min(depth, fixed.size() - 1);
+                const std::size_t blocks = rung.distance + 1;
+                rung.block_begin[0] = 0;
+                for (std::size_t b = 1; b < blocks; ++b)
+                {
+                    rung.block_begin[b] = static_cast<std::uint8_t>(fixed[b * fixed.size() / blocks]);
+                }
+                rung.block_begin[blocks] = static_cast<std::uint8_t>(buffer.length);
+
+                for (std::size_t b = 0; b < blocks; ++b)
+                {
+                    std::size_t key = buffer.length;
+                    std::uint8_t rarest = 0xFF;
+                    for (std::size_t i = rung.block_begin[b]; i < rung.block_begin[b + 1]; ++i)
+                    {
+                        if (buffer.mask[i] != std::byte{0xFF})
+                        {
+                            continue;
+                        }
+                        const std::uint8_t score =
+                            detail::byte_frequency_class(std::to_integer<std::uint8_t>(buffer.bytes[i]));
+                        if (key == buffer.length || score < rarest)
+                        {
+                            key = i;
+                            rarest = score;
+                        }
+                    }
+                    probes.push_back(Probe{index, static_cast<std::uint8_t>(b), static_cast<std::uint8_t>(key)});
+                }
+                return true;
+            }
+
+            // The scope's readable windows, merged where they touch, cut into chunks in ascending order.
+            [[nodiscard]] std::vector<Chunk> collect_chunks(detail::ModuleSpan range, scan::Pages pages,
+                                                            std::size_t &scanned_bytes)
+            {
+                std::vector<detail::ModuleSpan> runs;
+                for (const detail::ExecutableWindow &window : detail::collect_page_windows(range, pages))
+                {
+                    const std::uintptr_t end = window.base + window.span;
+                    if (!runs.empty() && runs.back().end == window.base)
+                    {
+                        runs.back().end = end;
+                        continue;
+                    }
+                    runs.push_back(detail::ModuleSpan{window.base, end});
+                }
+
+                std::vector<Chunk> chunks;
+                scanned_bytes = 0;
+                for (const detail::ModuleSpan &run : runs)
+                {
+                    scanned_bytes += run.end - run.base;
+                    for (std::uintptr_t lo = run.base; lo < run.end; lo += LIVE_CHUNK_BYTES)
+                    {
+                        const std::size_t bytes = std::min<std::size_t>(run.end - lo, LIVE_CHUNK_BYTES);
+                        chunks.push_back(Chunk{lo, bytes, run.base, run.end});
+                    }
+                }
+                detail::record_page_walk(runs.size(), scanned_bytes, 0);
+                return chunks;
+            }
+
+            [[nodiscard]] bool weaker(Grade lhs, Grade rhs) noexcept
+            {
+                return static_cast<std::uint8_t>(lhs) > static_cast<std::uint8_t>(rhs);
+            }
+        } // namespace
+
+        Result<ManifestLiveHealth> analyze_manifest_live(const manifest::Manifest &manifest, Region scope,
+                                                         const HealthPolicy &policy, scan::Pages pages,
+                                                         std::size_t max_workers)
+        {
+            if (pages != scan::Pages::Readable && pages != scan::Pages::Executable)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "sighealth::analyze_manifest_live"});
+            }
+            const detail::ModuleSpan range = detail::module_span(scope);
+            if (!range.valid())
+            {
+                return std::unexpected(Error{ErrorCode::InvalidRange, "sighealth::analyze_manifest_live"});
+            }
+
+            // Compile every jump-free byte rung and plan its blocks. rung_of maps (record, rung) to the table's rung
+            // index, or the table size for a rung that is not analyzed.
+            const std::size_t depth = std::min(policy.near_miss_distance, MAX_NEAR_MISS_DISTANCE);
+            ProbeTable table;
+            std::vector<std::vector<std::size_t>> rung_of(manifest.records.size());
+            std::vector<Probe> probes;
+            for (std::size_t r = 0; r < manifest.records.size(); ++r)
+            {
+                const manifest::SignatureRecord &record = manifest.records[r];
+                for (const manifest::CandidateSpec &spec : record.ladder)
+                {
+                    rung_of[r].push_back(std::numeric_limits<std::size_t>::max());
+                    if (spec.mode != scan::Mode::Direct && spec.mode != scan::Mode::RipRelative)
+                    {
+                        continue;
+                    }
+                    const Result<scan::Pattern> compiled = scan::Pattern::compile(spec.pattern);
+                    if (!compiled || detail::pattern_buffer(*compiled).jump_count != 0)
+                    {
+                        continue;
+                    }
+                    LiveRung rung;
+                    rung.buffer = detail::pattern_buffer(*compiled);
+                    const auto index = static_cast<std::uint32_t>(table.rungs.size());
+                    if (plan_blocks(rung, depth, index, probes))
+                    {
+                        rung_of[r].back() = index;
+                        table.rungs.push_back(rung);
+                    }
+                }
+            }
+
+            // Bucket the probes by key value, keeping file order within a bucket.
+            std::array<std::uint32_t, 256> per_value{};
+            for (const Probe &probe : probes)
+            {
+                ++per_value[std::to_integer<std::uint8_t>(table.rungs[probe.rung].buffer.bytes[probe.key])];
+            }
+            for (std::size_t v = 0; v < 256; ++v)
+            {
+                table.first[v + 1] = table.first[v] + per_value[v];
+            }
+            table.probes.resize(probes.size());
+            std::array<std::uint32_t, 256> cursor{};
+            std::copy_n(table.first.begin(), 256, cursor.begin());
+            for (const Probe &probe : probes)
+            {
+                const auto value = std::to_integer<std::uint8_t>(table.rungs[probe.rung].buffer.bytes[probe.key]);
+                table.probes[cursor[value]++] = probe;
+            }
+
+            detail::TelemetryScope telemetry;
+            ManifestLiveHealth health{};
+            std::vector<std::size_t> totals(table.rungs.size() * LIVE_SLOTS, 0);
+            if (!table.rungs.empty())
+            {
+                const std::vector<Chunk> chunks = collect_chunks(range, pages, health.scanned_bytes);
+                const std::size_t workers = detail::in_fork_join_worker() ? 1 : max_workers;
+                const std::vector<ChunkCounts> swept = detail::run_fork_join<Chunk, ChunkCounts>(
+                    chunks, workers, [&table](const Chunk &chunk) { return sweep_one(chunk, table); },
+                    [](const Chunk &) noexcept { return ChunkCounts{{}, true}; });
+                for (const ChunkCounts &chunk : swept)
+                {
+                    detail::record_page_walk(0, 0, chunk.failed ? 1 : 0);
+                    health.complete = health.complete && !chunk.failed;
+                    for (std::size_t i = 0; i < chunk.counts.size(); ++i)
+                    {
+                        totals[i] += chunk.counts[i];
+                    }
+                }
+            }
+
+            health.records.reserve(manifest.records.size());
+            for (std::size_t r = 0; r < manifest.records.size(); ++r)
+            {
+                const manifest::SignatureRecord &record = manifest.records[r];
+                RecordLiveHealth live{};
+                live.label = record.label;
+                live.kind = record.kind;
+                live.ladder.reserve(record.ladder.size());
+                for (std::size_t i = 0; i < record.ladder.size(); ++i)
+                {
+                    RungLiveHealth rung{};
+                    rung.mode = record.ladder[i].mode;
+                    const std::size_t index = rung_of[r][i];
+                    if (index < table.rungs.size())
+                    {
+                        const std::size_t *counts = totals.data() + index * LIVE_SLOTS;
+                        rung.analyzed = true;
+                        rung.distance = table.rungs[index].distance;
+                        rung.matches = counts[0];
+                        rung.near_misses.assign(counts + 1, counts + 1 + rung.distance);
+                        if (rung.matches == 1)
+                        {
+                            const auto nearest = std::ranges::find_if(rung.near_misses,
+                                                                      [](std::size_t sites) { return sites != 0; });
+                            rung.margin = static_cast<std::size_t>(nearest - rung.near_misses.begin()) + 1;
+                        }
+                        live.analyzed = true;
+                        if (!live.winning_rung && rung.matches == 1)
+                        {
+                            live.winning_rung = i;
+                            live.margin = rung.margin;
+                        }
+                    }
+                    live.ladder.push_back(std::move(rung));
+                }
+
+                if (!live.analyzed)
+                {
+                    ++health.skipped;
+                }
+                else
+                {
+                    if (!live.winning_rung)
+                    {
+                        live.grade = Grade::Unusable;
+                        ++health.unusable;
+                    }
+                    else if (live.margin <= policy.warn_uniqueness_margin)
+                    {
+                        live.grade = Grade::Fragile;
+                        ++health.fragile;
+                    }
+                    else
+                    {
+                        ++health.robust;
+                    }
+                    if (weaker(live.grade, health.grade))
+                    {
+                        health.grade = live.grade;
+                    }
+                }
+                health.records.push_back(std::move(live));
+            }
+            health.telemetry = telemetry.snapshot();
+            return health;
+        }
+    } // namespace sighealth
+} // namespace DetourModKit
@@ -0,0 +1,336 @@
+/**
+ * @file sighealth_repair.cpp
+ * @brief sighealth::suggest_repair: the nearest live site to a broken byte pattern, and the pattern rewritten to match.
+ * @details The search deepens one substitution at a time over scan::find_approximate, so the first depth that finds
+ *          anything holds exactly the nearest sites and every site it lists is that many substitutions away. A unique
+ *          nearest site yields two rewrites: one that takes the site's bytes where they disagree, and one that
+ *          wildcards those positions. Each is rendered back into the AOB DSL the manifest stores, so the fix can be
+ *          pasted over the old rung.
+ */
+
+#include "DetourModKit/sighealth.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include "internal/memory_guarded.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace DetourModKit
+{
+    namespace sighealth
+    {
+        namespace
+        {
+            // Sites one sweep lists. Only a unique nearest site is repaired, so the cap never hides a suggestion; it
+            // only bounds how exactly an ambiguous count is reported.
+            constexpr std::size_t REPAIR_SITE_LIMIT = 64;
+
+            static constexpr char HEX[] = "0123456789ABCDEF";
+
+            // True when each nibble of @p mask is wholly fixed or wholly free, the masks a bare token can spell.
+            [[nodiscard]] constexpr bool nibble_mask(unsigned mask) noexcept
+            {
+                const unsigned high = mask & 0xF0u;
+                const unsigned low = mask & 0x0Fu;
+                return (high == 0 || high == 0xF0u) && (low == 0 || low == 0x0Fu);
+            }
+
+            [[nodiscard]] bool holds_class(const detail::PatternBuffer &buffer, std::size_t index) noexcept
+            {
+                const std::span<const detail::ByteClass> classes = detail::classes_of(buffer);
+                return std::any_of(classes.begin(), classes.end(),
+                                   [index](const detail::ByteClass &entry) { return entry.position == index; });
+            }
+
+            // One masked byte: a fixed nibble prints its hex digit and an unconstrained nibble prints `?`, which spells
+            // `48`, `4?`, `?8` and `??` for the four nibble masks; any other mask prints the bit-set `VV/MM`, which
+            // the grammar accepts inside a class or group.
+            void append_masked(std::string &out, std::byte value, std::byte mask)
+            {
+                const auto bits = std::to_integer<unsigned>(value);
+                const auto known = std::to_integer<unsigned>(mask);
+                if (!nibble_mask(known))
+                {
+                    out += HEX[bits >> 4];
+                    out += HEX[bits & 0x0Fu];
+                    out += '/';
+                    out += HEX[known >> 4];
+                    out += HEX[known & 0x0Fu];
+                    return;
+                }
+                out += (known & 0xF0u) != 0 ? HEX[bits >> 4] : '?';
+                out += (known & 0x0Fu) != 0 ? HEX[bits & 0x0Fu] : '?';
+            }
+
+            // A class's members, with each complete high nibble folded to `h?`.
+            void append_class(std::string &out, const detail::ByteSet &members)
+            {
+                out += '[';
+                bool first = true;
+                for (unsigned high = 0; high < 16; ++high)
+                {
+                    unsigned present = 0;
+                    for (unsigned low = 0; low < 16; ++low)
+                    {
+                        present += members.contains(static_cast<std::byte>(high << 4 | low)) ? 1u : 0u;
+                    }
+                    for (unsigned low = 0; low < 16 && present != 0; ++low)
+                    {
+                        if (present != 16 && !members.contains(static_cast<std::byte>(high << 4 | low)))
+                        {
+                            continue;
+                        }
+                        out += first ? "" : "|";
+                        first = false;
+                        out += HEX[high];
+                        out += present == 16 ? '?' : HEX[low];
+                        if (present == 16)
+                        {
+                            break;
+                        }
+                    }
+                }
+                out += ']';
+            }
+
+            // One position outside any group: a class, a bit-set needing brackets, or a plain token.
+            void append_position(std::string &out, const detail::PatternBuffer &buffer, std::size_t index)
+            {
+                for (const detail::ByteClass &entry : detail::classes_of(buffer))
+                {
+                    if (entry.position == index)
+                    {
+                        append_class(out, entry.members);
+                        return;
+                    }
+                }
+                const bool nibbles = nibble_mask(std::to_integer<unsigned>(buffer.mask[index]));
+                if (!nibbles)
+                {
+                    out += '[';
+                }
+                append_masked(out, buffer.bytes[index], buffer.mask[index]);
+                if (!nibbles)
+                {
+                    out += ']';
+                }
+            }
+
+            void append_group(std::string &out, const detail::PatternGroup &group)
+            {
+                out += '(';
+                for (std::size_t a = 0; a < group.count; ++a)
+                {
+                    out += a == 0 ? "" : "|";
+                    for (std::size_t i = 0; i < group.length; ++i)
+                    {
+                        out += i == 0 ? "" : " ";
+                        append_masked(out, group.bytes[a][i], group.mask[a][i]);
+                    }
+                }
+                out += ')';
+            }
+
+            // Renders a jump-free buffer back into the DSL, with the `|` marker before the byte it points at.
+            [[nodiscard]] std::string render_pattern(const detail::PatternBuffer &buffer)
+            {
+                std::string out;
+                out.reserve(buffer.length * 3 + 2);
+                std::size_t next_group = 0;
+                for (std::size_t i = 0; i < buffer.length; ++i)
+                {
+                    if (i != 0)
+                    {
+                        out += ' ';
+                    }
+                    if (buffer.offset != 0 && i == buffer.offset)
+                    {
+                        out += "| ";
+                    }
+                    if (next_group < buffer.group_count && buffer.groups[next_group].position == i)
+                    {
+                        const detail::PatternGroup &group = buffer.groups[next_group++];
+                        append_group(out, group);
+                        i += group.length - 1;
+                        continue;
+                    }
+                    append_position(out, buffer, i);
+                }
+                return out;
+            }
+
+            // Frees @p position from its exact constraints: its class, and any group covering it, whose other
+            // positions keep the per-position sets the parser gave them.
+            void release_position(detail::PatternBuffer &buffer, std::size_t position)
+            {
+                std::size_t kept = 0;
+                for (std::size_t i = 0; i < buffer.class_count; ++i)
+                {
+                    if (buffer.classes[i].position != position)
+                    {
+                        buffer.classes[kept++] = buffer.classes[i];
+                    }
+                }
+                for (std::size_t i = kept; i < buffer.class_count; ++i)
+                {
+                    buffer.classes[i] = detail::ByteClass{};
+                }
+                buffer.class_count = kept;
+
+                kept = 0;
+                for (std::size_t i = 0; i < buffer.group_count; ++i)
+                {
+                    const detail::PatternGroup &group = buffer.groups[i];
+                    if (position < group.position || position >= group.position + group.length)
+                    {
+                        buffer.groups[kept++] = group;
+                    }
+                }
+                for (std::size_t i = kept; i < buffer.group_count; ++i)
+                {
+                    buffer.groups[i] = detail::PatternGroup{};
+                }
+                buffer.group_count = kept;
+            }
+        } // namespace
+
+        Result<RepairSuggestion> suggest_repair(const scan::Pattern &pattern, Region scope, const HealthPolicy &policy,
+                                                scan::Pages pages, std::size_t max_workers)
+        {
+            const detail::PatternBuffer &buffer = detail::pattern_buffer(pattern);
+            const auto constrained = static_cast<std::size_t>(
+                std::count_if(buffer.mask.begin(), buffer.mask.begin() + buffer.length,
+                              [](std::byte mask) { return mask != std::byte{0}; }));
+            if ((pages != scan::Pages::Readable && pages != scan::Pages::Executable) || buffer.jump_count != 0 ||
+                constrained == 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "sighealth::suggest_repair"});
+            }
+
+            RepairSuggestion suggestion{};
+            suggestion.distance = std::min({policy.near_miss_distance, MAX_NEAR_MISS_DISTANCE, constrained - 1});
+            std::vector<scan::ApproximateMatch> sites(REPAIR_SITE_LIMIT);
+            for (std::size_t depth = 0; depth <= suggestion.distance; ++depth)
+            {
+                const Result<scan::MatchSummary> swept =
+                    scan::find_approximate(pattern, scope, depth, sites, pages, max_workers);
+                if (!swept)
+                {
+                    return std::unexpected(swept.error());
+                }
+                suggestion.complete = suggestion.complete && !swept->faulted;
+                if (swept->matches == 0)
+                {
+                    continue;
+                }
+                if (depth == 0)
+                {
+                    suggestion.matches = swept->matches;
+                    return suggestion;
+                }
+                suggestion.nearest = depth;
+                suggestion.nearest_sites = swept->matches;
+                suggestion.repairable = swept->matches == 1 && !swept->stopped;
+                break;
+            }
+            if (!suggestion.repairable)
+            {
+                return suggestion;
+            }
+
+            const scan::ApproximateMatch &nearest = sites.front();
+            std::array<std::byte, detail::MAX_PATTERN_BYTES> live{};
+            if (!detail::guarded_read_bytes(nearest.site.raw(), live.data(), buffer.length))
+            {
+                // The page went away between the sweep and the read back; there is no site left to describe.
+                suggestion.repairable = false;
+                suggestion.complete = false;
+                return suggestion;
+            }
+
+            suggestion.site = nearest.site;
+            detail::PatternBuffer relearned = buffer;
+            detail::PatternBuffer loosened = buffer;
+            for (const std::uint8_t position : nearest.mismatch_positions())
+            {
+                suggestion.mismatch_positions.push_back(position);
+                // A class position relearns the site's whole byte: its shared bits alone would admit more than the
+                // class did.
+                if (holds_class(buffer, position))
+                {
+                    relearned.mask[position] = std::byte{0xFF};
+                }
+                relearned.bytes[position] = live[position] & relearned.mask[position];
+                release_position(relearned, position);
+                loosened.bytes[position] = std::byte{0};
+                loosened.mask[position] = std::byte{0};
+                release_position(loosened, position);
+            }
+            suggestion.relearned = render_pattern(relearned);
+            suggestion.loosened = render_pattern(loosened);
+
+            if (const Result<scan::Pattern> compiled = scan::Pattern::compile(suggestion.relearned))
+            {
+                std::array<Address, 2> hits{};
+                if (const Result<scan::MatchSummary> found = scan::find_all(*compiled, scope, hits, pages))
+                {
+                    suggestion.relearned_matches = found->matches;
+                }
+            }
+            return suggestion;
+        }
+
+        std::string format_report(const RepairSuggestion &suggestion, std::string_view label)
+        {
+            std::string out;
+            if (!label.empty())
+            {
+                out += std::format("{}: ", label);
+            }
+            if (suggestion.matches != 0)
+            {
+                out += std::format("matches exactly at {} site(s), nothing to repair", suggestion.matches);
+            }
+            else if (suggestion.nearest == 0)
+            {
+                out += std::format("no site within {} substitution(s)", suggestion.distance);
+            }
+            else if (!suggestion.repairable)
+            {
+                out += std::format("{}{} sites {} substitution(s) away, no unique repair",
+                                   suggestion.nearest_sites >= REPAIR_SITE_LIMIT ? "at least " : "",
+                                   suggestion.nearest_sites, suggestion.nearest);
+            }
+            else
+            {
+                out += std::format("one site {} substitution(s) away at 0x{:X}", suggestion.nearest,
+                                   suggestion.site.raw());
+            }
+            out += suggestion.complete ? "\n" : " (incomplete: part of the scope faulted)\n";
+            if (!suggestion.repairable)
+            {
+                return out;
+            }
+
+            out += "  changed positions: [";
+            for (std::size_t i = 0; i < suggestion.mismatch_positions.size(); ++i)
+            {
+                out += std::format("{}{}", i == 0 ? "" : " ", suggestion.mismatch_positions[i]);
+            }
+            out += "]\n";
+            out += std::format("  relearned: {} ({} match{})\n", suggestion.relearned, suggestion.relearned_matches,
+                               suggestion.relearned_matches == 1 ? "" : "es, not unique");
+            out += std::format("  loosened:  {}\n", suggestion.loosened);
+            return out;
+        }
+    } // namespace sighealth
+} // namespace DetourModKit
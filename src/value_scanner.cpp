@@ -0,0 +1,684 @@
+/**
+ * @file value_scanner.cpp
+ * @brief The value scanner: the chunked first-scan sweep, its AVX2 and scalar compare kernels, and the refine passes.
+ * @details A first scan runs in two fork-join passes. The sweep cuts the writable windows into chunks and records, per
+ *          chunk, the offsets whose value passes the bounds; the gather then reads each hit's value into its block.
+ *          Keeping the gather out of the sweep means no worker ever sweeps another's copies of matched values. A refine
+ *          is one fork-join pass over the blocks: each re-reads its hits under one fault guard (falling back to one
+ *          guarded read per hit when the guard trips), compacts the survivors in place, and stores their new values.
+ */
+
+#include "DetourModKit/value_scanner.hpp"
+
+#include "fork_join.hpp"
+#include "internal/memory_fault.hpp"
+#include "internal/memory_guarded.hpp"
+#include "internal/scan_pages.hpp"
+
+#include "DetourModKit/defines.hpp"
+#include "DetourModKit/region.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include <windows.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <numeric>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// AVX2 compare kernels, compiled per function with a target attribute on GCC/Clang (as in scan_engine.cpp) so the rest
+// of the TU stays baseline x86-64; the runtime active_simd_level() gate decides whether they run.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
+
+namespace DetourModKit
+{
+    namespace
+    {
+        using memory::ValueType;
+
+        // Bytes of one sweep chunk. A block's hit offsets are relative to its chunk base, so the chunk must stay below
+        // 4 GiB for them to fit 32 bits; 1 MiB also splits a large heap region finely enough to balance the workers.
+        constexpr std::size_t VALUE_SCAN_CHUNK_BYTES = std::size_t{1} << 20;
+
+        // What a pass keeps. Between is both a first scan's test and refine_equals / refine_between; the rest are the
+        // public Refine modes against each hit's previous value.
+        enum class Pass : std::uint8_t
+        {
+            Changed,
+            Unchanged,
+            Increased,
+            Decreased,
+            Between,
+        };
+
+        // One sweep chunk: an aligned slice of a writable window.
+        struct Chunk
+        {
+            std::uintptr_t base = 0;
+            std::size_t bytes = 0;
+        };
+
+        struct ChunkHits
+        {
+            std::vector<std::uint32_t> offsets;
+            bool failed = false;
+        };
+
+        struct RefineOutcome
+        {
+            bool failed = false;
+        };
+
+        [[nodiscard]] constexpr std::size_t width_of(ValueType type) noexcept
+        {
+            return type == ValueType::F64 ? sizeof(double) : sizeof(std::uint32_t);
+        }
+
+        template <typename T> [[nodiscard]] T from_bits(std::uint64_t bits) noexcept
+        {
+            if constexpr (sizeof(T) == sizeof(std::uint32_t))
+                return std::bit_cast<T>(static_cast<std::uint32_t>(bits));
+            else
+                return std::bit_cast<T>(bits);
+        }
+
+        template <typename T> [[nodiscard]] bool ordered_bounds(std::uint64_t lo_bits, std::uint64_t hi_bits) noexcept
+        {
+            const T lo = from_bits<T>(lo_bits);
+            const T hi = from_bits<T>(hi_bits);
+            if constexpr (std::is_floating_point_v<T>)
+            {
+                if (std::isnan(lo) || std::isnan(hi))
+                    return false;
+            }
+            return lo <= hi;
+        }
+
+        // True for a known type whose bounds are a non-empty, NaN-free range; every entry point screens with it.
+        [[nodiscard]] bool valid_bounds(ValueType type, std::uint64_t lo, std::uint64_t hi) noexcept
+        {
+            switch (type)
+            {
+            case ValueType::I32:
+                return ordered_bounds<std::int32_t>(lo, hi);
+            case ValueType::F32:
+                return ordered_bounds<float>(lo, hi);
+            case ValueType::F64:
+                return ordered_bounds<double>(lo, hi);
+            }
+            return false;
+        }
+
+        // Appends the offset of every lane set in @p mask, lanes being @p width bytes apart from @p offset.
+        [[nodiscard]] std::size_t emit_lanes(unsigned int mask, std::size_t offset, std::size_t width,
+                                             std::uint32_t *out, std::size_t count) noexcept
+        {
+            while (mask != 0)
+            {
+                const auto lane = static_cast<std::size_t>(std::countr_zero(mask));
+                out[count++] = static_cast<std::uint32_t>(offset + lane * width);
+                mask &= mask - 1;
+            }
+            return count;
+        }
+
+        // Tests every slot from @p from to the end of [data, data + bytes) against [lo, hi]; floats compare
+        // numerically, so a NaN never passes. Also the tail of every AVX2 kernel.
+        template <typename T>
+        DMK_NO_SANITIZE_ADDRESS std::size_t sweep_scalar(const std::byte *data, std::size_t from, std::size_t bytes,
+                                                         T lo, T hi, std::uint32_t *out, std::size_t count) noexcept
+        {
+            for (std::size_t i = from; i + sizeof(T) <= bytes; i += sizeof(T))
+            {
+                T value;
+                std::memcpy(&value, data + i, sizeof(T));
+                if (lo <= value && value <= hi)
+                {
+                    out[count++] = static_cast<std::uint32_t>(i);
+                }
+            }
+            return count;
+        }
+
+#ifdef DMK_HAS_AVX2
+        // Eight i32 lanes per step: a lane is in range exactly when clamping it to [lo, hi] leaves it unchanged.
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        std::size_t sweep_i32_avx2(const std::byte *data, std::size_t bytes, std::int32_t lo, std::int32_t hi,
+                                   std::uint32_t *out) noexcept
+        {
+            const __m256i lo_v = _mm256_set1_epi32(lo);
+            const __m256i hi_v = _mm256_set1_epi32(hi);
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+                const __m256i clamped = _mm256_min_epi32(_mm256_max_epi32(value, lo_v), hi_v);
+                const __m256i hit = _mm256_cmpeq_epi32(clamped, value);
+                const auto mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+                count = emit_lanes(mask, i, sizeof(std::int32_t), out, count);
+            }
+            return sweep_scalar<std::int32_t>(data, i, bytes, lo, hi, out, count);
+        }
+
+        // Ordered, non-signalling compares, so a NaN lane fails both bounds.
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        std::size_t sweep_f32_avx2(const std::byte *data, std::size_t bytes, float lo, float hi,
+                                   std::uint32_t *out) noexcept
+        {
+            const __m256 lo_v = _mm256_set1_ps(lo);
+            const __m256 hi_v = _mm256_set1_ps(hi);
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                const __m256 value = _mm256_loadu_ps(reinterpret_cast<const float *>(data + i));
+                const __m256 hit =
+                    _mm256_and_ps(_mm256_cmp_ps(value, lo_v, _CMP_GE_OQ), _mm256_cmp_ps(value, hi_v, _CMP_LE_OQ));
+                const auto mask = static_cast<unsigned int>(_mm256_movemask_ps(hit));
+                count = emit_lanes(mask, i, sizeof(float), out, count);
+            }
+            return sweep_scalar<float>(data, i, bytes, lo, hi, out, count);
+        }
+
+        DMK_AVX2_TARGET
+        DMK_NO_SANITIZE_ADDRESS
+        std::size_t sweep_f64_avx2(const std::byte *data, std::size_t bytes, double lo, double hi,
+                                   std::uint32_t *out) noexcept
+        {
+            const __m256d lo_v = _mm256_set1_pd(lo);
+            const __m256d hi_v = _mm256_set1_pd(hi);
+            std::size_t count = 0;
+            std::size_t i = 0;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                const __m256d value = _mm256_loadu_pd(reinterpret_cast<const double *>(data + i));
+                const __m256d hit =
+                    _mm256_and_pd(_mm256_cmp_pd(value, lo_v, _CMP_GE_OQ), _mm256_cmp_pd(value, hi_v, _CMP_LE_OQ));
+                const auto mask = static_cast<unsigned int>(_mm256_movemask_pd(hit));
+                count = emit_lanes(mask, i, sizeof(double), out, count);
+            }
+            return sweep_scalar<double>(data, i, bytes, lo, hi, out, count);
+        }
+#endif // DMK_HAS_AVX2
+
+        struct SweepContext
+        {
+            const std::byte *data;
+            std::size_t bytes;
+            ValueType type;
+            std::uint64_t lo;
+            std::uint64_t hi;
+            bool avx2;
+            std::uint32_t *out;
+            std::size_t count;
+        };
+
+        // The body the sweep's fault guard wraps: reads the chunk in place, writes only the preallocated offsets.
+        void sweep_chunk(void *opaque) noexcept
+        {
+            SweepContext &context = *static_cast<SweepContext *>(opaque);
+            switch (context.type)
+            {
+            case ValueType::I32:
+            {
+                const auto lo = from_bits<std::int32_t>(context.lo);
+                const auto hi = from_bits<std::int32_t>(context.hi);
+#ifdef DMK_HAS_AVX2
+                if (context.avx2)
+                {
+                    context.count = sweep_i32_avx2(context.data, context.bytes, lo, hi, context.out);
+                    return;
+                }
+#endif
+                context.count = sweep_scalar(context.data, 0, context.bytes, lo, hi, context.out, 0);
+                return;
+            }
+            case ValueType::F32:
+            {
+                const auto lo = from_bits<float>(context.lo);
+                const auto hi = from_bits<float>(context.hi);
+#ifdef DMK_HAS_AVX2
+                if (context.avx2)
+                {
+                    context.count = sweep_f32_avx2(context.data, context.bytes, lo, hi, context.out);
+                    return;
+                }
+#endif
+                context.count = sweep_scalar(context.data, 0, context.bytes, lo, hi, context.out, 0);
+                return;
+            }
+            case ValueType::F64:
+            {
+                const auto lo = from_bits<double>(context.lo);
+                const auto hi = from_bits<double>(context.hi);
+#ifdef DMK_HAS_AVX2
+                if (context.avx2)
+                {
+                    context.count = sweep_f64_avx2(context.data, context.bytes, lo, hi, context.out);
+                    return;
+                }
+#endif
+                context.count = sweep_scalar(context.data, 0, context.bytes, lo, hi, context.out, 0);
+                return;
+            }
+            }
+        }
+
+        struct GatherContext
+        {
+            std::uintptr_t base;
+            const std::uint32_t *offsets;
+            std::size_t count;
+            std::size_t width;
+            std::byte *out;
+        };
+
+        // The body a refine's fault guard wraps: copies each hit's current value out, with a constant-width copy per
+        // type so it compiles to plain loads.
+        DMK_NO_SANITIZE_ADDRESS void gather_values(void *opaque) noexcept
+        {
+            const GatherContext &context = *static_cast<const GatherContext *>(opaque);
+            if (context.width == sizeof(std::uint32_t))
+            {
+                for (std::size_t i = 0; i < context.count; ++i)
+                {
+                    std::memcpy(context.out + i * sizeof(std::uint32_t),
+                                reinterpret_cast<const void *>(context.base + context.offsets[i]),
+                                sizeof(std::uint32_t));
+                }
+                return;
+            }
+            for (std::size_t i = 0; i < context.count; ++i)
+            {
+                std::memcpy(context.out + i * sizeof(std::uint64_t),
+                            reinterpret_cast<const void *>(context.base + context.offsets[i]), sizeof(std::uint64_t));
+            }
+        }
+
+        // Runs fn(ctx) over [lo, hi) under the TOCTOU fault guard the page-gated scans use. Returns false when a fault
+        // was swallowed and fn did not complete.
+        bool run_guarded(std::uintptr_t lo, std::uintptr_t hi, void (*fn)(void *) noexcept, void *ctx) noexcept
+        {
+#ifdef _MSC_VER
+            (void)lo;
+            (void)hi;
+            __try
+            {
+                fn(ctx);
+                return true;
+            }
+            __except (detail::guarded_fault_filter(GetExceptionInformation()))
+            {
+                return false;
+            }
+#elif defined(_WIN64)
+            return detail::run_guarded_region(lo, hi, fn, ctx);
+#endif
+        }
+
+        // Cuts each writable window of the scope into chunks that start on a slot boundary, in ascending order.
+        [[nodiscard]] std::vector<Chunk> collect_chunks(const RegionSet &scope, std::size_t width)
+        {
+            std::vector<Region> spans;
+            if (scope.empty())
+            {
+                spans.push_back(Region::whole_process());
+            }
+            else
+            {
+                spans.assign(scope.ranges().begin(), scope.ranges().end());
+            }
+
+            std::vector<Chunk> chunks;
+            for (const Region &span : spans)
+            {
+                const std::vector<detail::ExecutableWindow> windows =
+                    detail::collect_writable_windows(detail::module_span(span));
+                for (const detail::ExecutableWindow &window : windows)
+                {
+                    const std::uintptr_t end = window.base + window.span;
+                    std::uintptr_t lo = (window.base + width - 1) & ~(static_cast<std::uintptr_t>(width) - 1);
+                    while (lo < end && end - lo >= width)
+                    {
+                        const std::size_t bytes = std::min<std::size_t>(end - lo, VALUE_SCAN_CHUNK_BYTES);
+                        chunks.push_back(Chunk{lo, bytes});
+                        lo += bytes;
+                    }
+                }
+            }
+            return chunks;
+        }
+
+        // Sweeps one chunk into an exact-sized offset list. The scratch is allocated before the guard and left
+        // uninitialized, so an empty chunk costs no page touches beyond the ones the sweep reads.
+        [[nodiscard]] ChunkHits sweep(const Chunk &chunk, ValueType type, std::uint64_t lo, std::uint64_t hi, bool avx2)
+        {
+            const std::size_t width = width_of(type);
+            auto scratch = std::make_unique_for_overwrite<std::uint32_t[]>(chunk.bytes / width);
+            SweepContext context{reinterpret_cast<const std::byte *>(chunk.base), chunk.bytes, type, lo, hi, avx2,
+                                 scratch.get(), 0};
+            if (!run_guarded(chunk.base, chunk.base + chunk.bytes, sweep_chunk, &context))
+            {
+                return ChunkHits{{}, true};
+            }
+            return ChunkHits{std::vector<std::uint32_t>(scratch.get(), scratch.get() + context.count), false};
+        }
+    } // namespace
+
+    namespace
+    {
+        // One chunk's surviving hits: offsets from the chunk base, ascending, and each hit's last-read value packed at
+        // the type's own width.
+        struct Block
+        {
+            std::uintptr_t base = 0;
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::byte> values;
+        };
+
+        // Everything a scanner owns, kept outside the private Impl so the pass helpers below can name it.
+        struct ScanState
+        {
+            ValueType type = ValueType::I32;
+            std::size_t max_workers = 0;
+            std::vector<Block> blocks;
+            std::size_t count = 0;
+            bool incomplete = false;
+        };
+
+        template <typename T> [[nodiscard]] bool keeps(Pass pass, T previous, T current, T lo, T hi) noexcept
+        {
+            using Bits = std::conditional_t<sizeof(T) == sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+            switch (pass)
+            {
+            case Pass::Changed:
+                return std::bit_cast<Bits>(previous) != std::bit_cast<Bits>(current);
+            case Pass::Unchanged:
+                return std::bit_cast<Bits>(previous) == std::bit_cast<Bits>(current);
+            case Pass::Increased:
+                return current > previous;
+            case Pass::Decreased:
+                return current < previous;
+            case Pass::Between:
+                return lo <= current && current <= hi;
+            }
+            return false;
+        }
+
+        // Keeps the hits whose current value passes, in order, storing the current value as the new previous one.
+        // A hit whose read failed (readable[i] == 0) is dropped.
+        template <typename T>
+        void compact(Block &block, const std::byte *current, const std::uint8_t *readable, Pass pass,
+                     std::uint64_t lo_bits, std::uint64_t hi_bits) noexcept
+        {
+            const T lo = from_bits<T>(lo_bits);
+            const T hi = from_bits<T>(hi_bits);
+            std::size_t kept = 0;
+            for (std::size_t i = 0; i < block.offsets.size(); ++i)
+            {
+                if (readable != nullptr && readable[i] == 0)
+                {
+                    continue;
+                }
+                T previous;
+                T now;
+                std::memcpy(&previous, block.values.data() + i * sizeof(T), sizeof(T));
+                std::memcpy(&now, current + i * sizeof(T), sizeof(T));
+                if (keeps(pass, previous, now, lo, hi))
+                {
+                    block.offsets[kept] = block.offsets[i];
+                    std::memcpy(block.values.data() + kept * sizeof(T), &now, sizeof(T));
+                    ++kept;
+                }
+            }
+            block.offsets.resize(kept);
+            block.values.resize(kept * sizeof(T));
+        }
+
+        // Re-reads one block and compacts it. The whole block is read under one guard; a fault there retries hit by
+        // hit, so one freed page drops only its own hits. An allocation failure throws before the block is touched.
+        [[nodiscard]] RefineOutcome refine_block(Block &block, ValueType type, Pass pass, std::uint64_t lo,
+                                                 std::uint64_t hi)
+        {
+            const std::size_t count = block.offsets.size();
+            const std::size_t width = width_of(type);
+            auto current = std::make_unique_for_overwrite<std::byte[]>(count * width);
+            std::unique_ptr<std::uint8_t[]> readable;
+            RefineOutcome outcome{};
+
+            GatherContext context{block.base, block.offsets.data(), count, width, current.get()};
+            const std::uintptr_t read_lo = block.base + block.offsets.front();
+            const std::uintptr_t read_hi = block.base + block.offsets.back() + width;
+            if (!run_guarded(read_lo, read_hi, gather_values, &context))
+            {
+                readable = std::make_unique<std::uint8_t[]>(count);
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const bool read = detail::guarded_read_bytes(block.base + block.offsets[i],
+                                                                 current.get() + i * width, width);
+                    readable[i] = read ? 1 : 0;
+                    outcome.failed = outcome.failed || !read;
+                }
+            }
+
+            switch (type)
+            {
+            case ValueType::I32:
+                compact<std::int32_t>(block, current.get(), readable.get(), pass, lo, hi);
+                break;
+            case ValueType::F32:
+                compact<float>(block, current.get(), readable.get(), pass, lo, hi);
+                break;
+            case ValueType::F64:
+                compact<double>(block, current.get(), readable.get(), pass, lo, hi);
+                break;
+            }
+            block.offsets.shrink_to_fit();
+            block.values.shrink_to_fit();
+            return outcome;
+        }
+
+        // Workers for one pass: the caller's bound, or one when already inside a fork-join batch.
+        [[nodiscard]] std::size_t pass_workers(std::size_t max_workers) noexcept
+        {
+            return detail::in_fork_join_worker() ? 1 : max_workers;
+        }
+
+        // One parallel pass over every block, then drops the emptied ones and recounts. The count is taken from the
+        // blocks rather than the outcomes, so a block a failed worker never touched keeps its hits.
+        void run_pass(ScanState &state, Pass pass, std::uint64_t lo, std::uint64_t hi)
+        {
+            std::vector<std::size_t> indices(state.blocks.size());
+            std::iota(indices.begin(), indices.end(), std::size_t{0});
+            const std::vector<RefineOutcome> outcomes = detail::run_fork_join<std::size_t, RefineOutcome>(
+                indices, pass_workers(state.max_workers),
+                [&](const std::size_t &index) { return refine_block(state.blocks[index], state.type, pass, lo, hi); },
+                [](const std::size_t &) noexcept { return RefineOutcome{true}; });
+
+            std::erase_if(state.blocks, [](const Block &block) noexcept { return block.offsets.empty(); });
+            state.count = 0;
+            for (const Block &block : state.blocks)
+            {
+                state.count += block.offsets.size();
+            }
+            state.incomplete = state.incomplete || std::ranges::any_of(outcomes, &RefineOutcome::failed);
+        }
+    } // namespace
+
+    struct memory::ValueScanner::Impl
+    {
+        ScanState state;
+    };
+
+    memory::ValueScanner::ValueScanner(std::unique_ptr<Impl> impl) noexcept : m_impl(std::move(impl)) {}
+    memory::ValueScanner::ValueScanner(ValueScanner &&) noexcept = default;
+    memory::ValueScanner &memory::ValueScanner::operator=(ValueScanner &&) noexcept = default;
+    memory::ValueScanner::~ValueScanner() noexcept = default;
+
+    Result<memory::ValueScanner> memory::ValueScanner::start(ValueType type, std::uint64_t lo, std::uint64_t hi,
+                                                             const ValueScanOptions &options) noexcept
+    {
+        if (!valid_bounds(type, lo, hi))
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "memory::ValueScanner::first_scan"});
+        }
+        try
+        {
+            auto impl = std::make_unique<Impl>();
+            ScanState &state = impl->state;
+            state.type = type;
+            state.max_workers = options.max_workers;
+
+            const std::vector<Chunk> chunks = collect_chunks(options.scope, width_of(type));
+            const bool avx2 = scan::active_simd_level() >= scan::SimdLevel::Avx2;
+            std::vector<ChunkHits> hits = detail::run_fork_join<Chunk, ChunkHits>(
+                chunks, pass_workers(options.max_workers),
+                [&](const Chunk &chunk) { return sweep(chunk, type, lo, hi, avx2); },
+                [](const Chunk &) noexcept { return ChunkHits{{}, true}; });
+
+            const std::size_t width = width_of(type);
+            for (std::size_t i = 0; i < chunks.size(); ++i)
+            {
+                state.incomplete = state.incomplete || hits[i].failed;
+                if (hits[i].offsets.empty())
+                {
+                    continue;
+                }
+                Block block;
+                block.base = chunks[i].base;
+                block.values.resize(hits[i].offsets.size() * width);
+                block.offsets = std::move(hits[i].offsets);
+                state.blocks.push_back(std::move(block));
+            }
+
+            // The gather re-tests the bounds, so a slot rewritten between sweep and gather drops out here.
+            run_pass(state, Pass::Between, lo, hi);
+            return ValueScanner{std::move(impl)};
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::ValueScanner::first_scan"});
+        }
+    }
+
+    Result<std::size_t> memory::ValueScanner::refine(Refine mode) noexcept
+    {
+        Pass pass{};
+        switch (mode)
+        {
+        case Refine::Changed:
+            pass = Pass::Changed;
+            break;
+        case Refine::Unchanged:
+            pass = Pass::Unchanged;
+            break;
+        case Refine::Increased:
+            pass = Pass::Increased;
+            break;
+        case Refine::Decreased:
+            pass = Pass::Decreased;
+            break;
+        default:
+            return std::unexpected(Error{ErrorCode::InvalidArg, "memory::ValueScanner::refine"});
+        }
+        if (!m_impl)
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "memory::ValueScanner::refine"});
+        }
+        try
+        {
+            run_pass(m_impl->state, pass, 0, 0);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::ValueScanner::refine"});
+        }
+        return m_impl->state.count;
+    }
+
+    Result<std::size_t> memory::ValueScanner::refine_bits(ValueType type, std::uint64_t lo, std::uint64_t hi) noexcept
+    {
+        if (!m_impl || type != m_impl->state.type || !valid_bounds(type, lo, hi))
+        {
+            return std::unexpected(Error{ErrorCode::InvalidArg, "memory::ValueScanner::refine"});
+        }
+        try
+        {
+            run_pass(m_impl->state, Pass::Between, lo, hi);
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::ValueScanner::refine"});
+        }
+        return m_impl->state.count;
+    }
+
+    std::size_t memory::ValueScanner::size() const noexcept
+    {
+        return m_impl ? m_impl->state.count : 0;
+    }
+
+    bool memory::ValueScanner::empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    memory::ValueType memory::ValueScanner::type() const noexcept
+    {
+        return m_impl ? m_impl->state.type : ValueType::I32;
+    }
+
+    bool memory::ValueScanner::incomplete() const noexcept
+    {
+        return m_impl && m_impl->state.incomplete;
+    }
+
+    Result<std::vector<Address>> memory::ValueScanner::addresses(std::size_t limit) const noexcept
+    {
+        std::vector<Address> out;
+        if (!m_impl)
+        {
+            return out;
+        }
+        try
+        {
+            out.reserve(std::min(limit, m_impl->state.count));
+            for (const Block &block : m_impl->state.blocks)
+            {
+                for (const std::uint32_t offset : block.offsets)
+                {
+                    if (out.size() == limit)
+                    {
+                        return out;
+                    }
+                    out.push_back(Address{block.base + offset});
+                }
+            }
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::ValueScanner::addresses"});
+        }
+        return out;
+    }
+} // namespace DetourModKit
@@ -0,0 +1,341 @@
+/**
+ * @file watch_set.cpp
+ * @brief The watch set: entry registration, the batched re-read, and the qword-lane diff of the value buffers.
+ * @details Every entry owns an 8-byte-aligned slot in two equally sized buffers: the last accepted values and the
+ *          values the current poll reads. Slot padding is never written, so it compares equal in both. A poll reads
+ *          into the current buffer with one read_many, restores the slot of every read that failed from the accepted
+ *          buffer, then marks each qword lane that differs in a bitmap. An entry changed when any lane of its slot is
+ *          marked or its read status flipped. The accepted buffer then takes the current one.
+ */
+
+#include "DetourModKit/watch_set.hpp"
+
+#include "DetourModKit/scan.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <new>
+#include <span>
+#include <utility>
+#include <vector>
+
+// The AVX2 diff kernel, compiled with a target attribute on GCC/Clang (as in scan_engine.cpp) so the rest of the TU
+// stays baseline x86-64; the runtime active_simd_level() gate decides whether it runs.
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define DMK_HAS_AVX2 1
+#include <immintrin.h>
+#define DMK_AVX2_TARGET
+#endif
+
+namespace DetourModKit
+{
+    namespace
+    {
+        constexpr std::size_t LANE_BYTES = sizeof(std::uint64_t);
+        // Buffers grow in whole 32-byte steps so the AVX2 kernel never needs a tail.
+        constexpr std::size_t BUFFER_STEP = 32;
+        constexpr std::uint32_t NO_CHAIN = std::numeric_limits<std::uint32_t>::max();
+
+        struct WatchState
+        {
+            // Per entry: the chain index or NO_CHAIN, the slot offset, the watched size, whether the last poll read
+            // it, and whether it has ever read. A fixed entry's address lives in its read descriptor.
+            std::vector<std::uint32_t> chain_of;
+            std::vector<std::uint32_t> offsets;
+            std::vector<std::uint32_t> sizes;
+            std::vector<std::uint8_t> valid;
+            std::vector<std::uint8_t> seen;
+            std::vector<memory::CompiledChain> chains;
+
+            // The accepted and in-flight values, and the lanes that differ between them.
+            std::vector<std::byte> accepted;
+            std::vector<std::byte> current;
+            std::vector<std::uint64_t> dirty;
+
+            // The read_many batch, pointed into current, and its per-read status.
+            std::vector<memory::ReadDescriptor> reads;
+            std::vector<std::uint8_t> ok;
+            std::vector<std::size_t> changed;
+            std::size_t used = 0;
+        };
+
+        // Marks in dirty every lane of the first `bytes` bytes where a and b differ. bytes is a multiple of 32.
+        void diff_lanes_scalar(const std::byte *a, const std::byte *b, std::size_t bytes, std::uint64_t *dirty) noexcept
+        {
+            for (std::size_t lane = 0; lane * LANE_BYTES < bytes; ++lane)
+            {
+                std::uint64_t x = 0;
+                std::uint64_t y = 0;
+                std::memcpy(&x, a + lane * LANE_BYTES, LANE_BYTES);
+                std::memcpy(&y, b + lane * LANE_BYTES, LANE_BYTES);
+                if (x != y)
+                {
+                    dirty[lane / 64] |= std::uint64_t{1} << (lane % 64);
+                }
+            }
+        }
+
+#ifdef DMK_HAS_AVX2
+        // Four lanes per step: the inverted cmpeq_epi64 mask is the group's four dirty bits.
+        DMK_AVX2_TARGET
+        void diff_lanes_avx2(const std::byte *a, const std::byte *b, std::size_t bytes, std::uint64_t *dirty) noexcept
+        {
+            for (std::size_t i = 0; i < bytes; i += BUFFER_STEP)
+            {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+                const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+                const auto same =
+                    static_cast<unsigned int>(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(x, y))));
+                const std::size_t lane = i / LANE_BYTES;
+                dirty[lane / 64] |= static_cast<std::uint64_t>(~same & 0xFu) << (lane % 64);
+            }
+        }
+#endif
+
+        // True when any lane in [first, last) is marked.
+        [[nodiscard]] bool any_dirty(const std::uint64_t *dirty, std::size_t first, std::size_t last) noexcept
+        {
+            for (std::size_t lane = first; lane < last; ++lane)
+            {
+                if ((dirty[lane / 64] >> (lane % 64) & 1u) != 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Points every descriptor at its slot in current; run after anything that may move the buffer.
+        void rebind_reads(WatchState &state) noexcept
+        {
+            for (std::size_t i = 0; i < state.reads.size(); ++i)
+            {
+                state.reads[i].destination =
+                    std::span<std::byte>{state.current.data() + state.offsets[i], state.sizes[i]};
+            }
+        }
+
+        // Makes room for one more element, doubling so a run of adds stays linear.
+        template <class T> void reserve_one_more(std::vector<T> &v)
+        {
+            if (v.size() == v.capacity())
+            {
+                v.reserve(std::max<std::size_t>(8, v.capacity() * 2));
+            }
+        }
+
+        // Appends one entry, growing every buffer first so a failed allocation leaves the state unchanged.
+        [[nodiscard]] Result<std::size_t> append(WatchState &state, Address address, std::uint32_t chain,
+                                                 std::size_t size) noexcept
+        {
+            const std::size_t index = state.sizes.size();
+            const std::size_t offset = state.used;
+            const std::size_t used = offset + (size + LANE_BYTES - 1) / LANE_BYTES * LANE_BYTES;
+            const std::size_t buffer = (used + BUFFER_STEP - 1) / BUFFER_STEP * BUFFER_STEP;
+            if (used > std::numeric_limits<std::uint32_t>::max())
+            {
+                return std::unexpected(Error{ErrorCode::SizeTooLarge, "memory::WatchSet::add"});
+            }
+            try
+            {
+                reserve_one_more(state.chain_of);
+                reserve_one_more(state.offsets);
+                reserve_one_more(state.sizes);
+                reserve_one_more(state.valid);
+                reserve_one_more(state.seen);
+                reserve_one_more(state.reads);
+                state.changed.reserve(state.reads.capacity());
+                state.ok.resize(index + 1);
+                state.accepted.resize(std::max(buffer, state.accepted.size()));
+                state.current.resize(std::max(buffer, state.current.size()));
+                state.dirty.resize((buffer / LANE_BYTES + 63) / 64);
+            }
+            catch (const std::bad_alloc &)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::WatchSet::add"});
+            }
+            state.chain_of.push_back(chain);
+            state.offsets.push_back(static_cast<std::uint32_t>(offset));
+            state.sizes.push_back(static_cast<std::uint32_t>(size));
+            state.valid.push_back(0);
+            state.seen.push_back(0);
+            state.reads.push_back(memory::ReadDescriptor{address, {}});
+            state.used = used;
+            rebind_reads(state);
+            return index;
+        }
+
+        [[nodiscard]] Result<void> check_size(std::size_t size) noexcept
+        {
+            if (size == 0)
+            {
+                return std::unexpected(Error{ErrorCode::InvalidArg, "memory::WatchSet::add"});
+            }
+            if (size > memory::MAX_WATCH_SIZE)
+            {
+                return std::unexpected(Error{ErrorCode::SizeTooLarge, "memory::WatchSet::add"});
+            }
+            return {};
+        }
+    } // namespace
+
+    struct memory::WatchSet::Impl
+    {
+        WatchState state;
+    };
+
+    memory::WatchSet::WatchSet() noexcept = default;
+    memory::WatchSet::WatchSet(WatchSet &&) noexcept = default;
+    memory::WatchSet &memory::WatchSet::operator=(WatchSet &&) noexcept = default;
+    memory::WatchSet::~WatchSet() noexcept = default;
+
+    Result<std::size_t> memory::WatchSet::add(Address address, std::size_t size) noexcept
+    {
+        if (!address)
+        {
+            return std::unexpected(Error{ErrorCode::NullTargetAddress, "memory::WatchSet::add"});
+        }
+        if (auto checked = check_size(size); !checked)
+        {
+            return std::unexpected(checked.error());
+        }
+        if (!m_impl)
+        {
+            m_impl.reset(new (std::nothrow) Impl{});
+            if (!m_impl)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::WatchSet::add"});
+            }
+        }
+        return append(m_impl->state, address, NO_CHAIN, size);
+    }
+
+    Result<std::size_t> memory::WatchSet::add(CompiledChain chain, std::size_t size) noexcept
+    {
+        if (auto checked = check_size(size); !checked)
+        {
+            return std::unexpected(checked.error());
+        }
+        if (!m_impl)
+        {
+            m_impl.reset(new (std::nothrow) Impl{});
+            if (!m_impl)
+            {
+                return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::WatchSet::add"});
+            }
+        }
+        WatchState &state = m_impl->state;
+        try
+        {
+            state.chains.push_back(std::move(chain));
+        }
+        catch (const std::bad_alloc &)
+        {
+            return std::unexpected(Error{ErrorCode::OutOfMemory, "memory::WatchSet::add"});
+        }
+        auto index = append(state, Address{}, static_cast<std::uint32_t>(state.chains.size() - 1), size);
+        if (!index)
+        {
+            state.chains.pop_back();
+        }
+        return index;
+    }
+
+    std::span<const std::size_t> memory::WatchSet::poll() noexcept
+    {
+        if (!m_impl)
+        {
+            return {};
+        }
+        WatchState &state = m_impl->state;
+        const std::size_t count = state.sizes.size();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (state.chain_of[i] != NO_CHAIN)
+            {
+                // A null address fails read_many's screen, so an unresolved chain is an ordinary failed read.
+                const Result<Address> leaf = state.chains[state.chain_of[i]].walk();
+                state.reads[i].address = leaf ? *leaf : Address{};
+            }
+        }
+        (void)memory::read_many(state.reads, state.ok);
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (state.ok[i] == 0)
+            {
+                std::memcpy(state.current.data() + state.offsets[i], state.accepted.data() + state.offsets[i],
+                            state.sizes[i]);
+            }
+        }
+
+        const std::size_t bytes = state.current.size();
+        std::fill(state.dirty.begin(), state.dirty.end(), std::uint64_t{0});
+#ifdef DMK_HAS_AVX2
+        if (scan::active_simd_level() >= scan::SimdLevel::Avx2)
+        {
+            diff_lanes_avx2(state.accepted.data(), state.current.data(), bytes, state.dirty.data());
+        }
+        else
+#endif
+        {
+            diff_lanes_scalar(state.accepted.data(), state.current.data(), bytes, state.dirty.data());
+        }
+
+        state.changed.clear();
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint8_t ok = state.ok[i];
+            const std::size_t first = state.offsets[i] / LANE_BYTES;
+            const std::size_t last = first + (state.sizes[i] + LANE_BYTES - 1) / LANE_BYTES;
+            // A status flip covers the first read, whose value may equal the zero-filled slot.
+            if (ok != state.valid[i] || (ok != 0 && any_dirty(state.dirty.data(), first, last)))
+            {
+                state.changed.push_back(i);
+            }
+            state.valid[i] = ok;
+            state.seen[i] = static_cast<std::uint8_t>(state.seen[i] | ok);
+        }
+        std::memcpy(state.accepted.data(), state.current.data(), bytes);
+        return state.changed;
+    }
+
+    std::span<const std::byte> memory::WatchSet::bytes(std::size_t index) const noexcept
+    {
+        if (!m_impl || index >= m_impl->state.sizes.size() || m_impl->state.seen[index] == 0)
+        {
+            return {};
+        }
+        const WatchState &state = m_impl->state;
+        return std::span<const std::byte>{state.accepted.data() + state.offsets[index], state.sizes[index]};
+    }
+
+    bool memory::WatchSet::valid(std::size_t index) const noexcept
+    {
+        return m_impl && index < m_impl->state.valid.size() && m_impl->state.valid[index] != 0;
+    }
+
+    std::size_t memory::WatchSet::size() const noexcept
+    {
+        return m_impl ? m_impl->state.sizes.size() : 0;
+    }
+
+    std::size_t memory::WatchSet::entry_size(std::size_t index) const noexcept
+    {
+        return m_impl && index < m_impl->state.sizes.size() ? m_impl->state.sizes[index] : 0;
+    }
+
+    void memory::WatchSet::clear() noexcept
+    {
+        m_impl.reset();
+    }
+} // namespace DetourModKit
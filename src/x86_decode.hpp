@@ -6,8 +6,10 @@
 #include "internal/memory_guarded.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
 #include <optional>
 
 namespace DetourModKit::detail
@@ -138,6 +140,503 @@ namespace DetourModKit::detail
         std::memcpy(&destination, code.data() + 2, sizeof(destination));
         return destination;
     }
+
+    /// The filler and entry bytes @ref decode_hotpatch_site read around a hot-patchable function entry.
+    struct HotPatchSite
+    {
+        std::array<std::uint8_t, 5> pad{};
+        std::array<std::uint8_t, 2> entry{};
+    };
+
+    /**
+     * @brief Reads the hot-patch layout around @p entry: five filler bytes before it and a 2-byte first instruction.
+     * @details The filler must be INT3 (CC) or NOP (90) bytes, the inter-function padding MSVC's /hotpatch and
+     *          /FUNCTIONPADMIN leave, so nothing ever executes it and a rel32 JMP can be written there at leisure. The
+     *          entry must be an instruction a stub can replay verbatim at any address: `mov edi, edi` (8B FF), the
+     *          2-byte NOP (66 90), or a REX-prefixed `push r64` (40/41 50..57). `mov edi, edi` is not a no-op on
+     *          x86-64 (it clears the upper half of rdi), which is why the original replays the instruction instead of
+     *          skipping it. The entry must also be 2-byte aligned, so the 2-byte store that arms the hook is one
+     *          atomic write that cannot straddle a cache line. Both ranges are copied under a single SEH fault guard
+     *          and inspected in the copy, like the decoders above.
+     * @param address Absolute address of the function entry.
+     * @return The filler and entry bytes, or std::nullopt when they are unreadable or the layout does not qualify.
+     */
+    [[nodiscard]] inline std::optional<HotPatchSite> decode_hotpatch_site(std::uintptr_t address) noexcept
+    {
+        if (address < 5 || address % 2 != 0)
+        {
+            return std::nullopt;
+        }
+        std::array<std::uint8_t, 7> code{};
+        if (!guarded_read_bytes(address - 5, code.data(), code.size()))
+        {
+            return std::nullopt;
+        }
+        for (std::size_t i = 0; i < 5; ++i)
+        {
+            if (code[i] != 0xCC && code[i] != 0x90)
+            {
+                return std::nullopt;
+            }
+        }
+        const std::uint8_t first = code[5];
+        const std::uint8_t second = code[6];
+        const bool mov_edi_edi = first == 0x8B && second == 0xFF;
+        const bool two_byte_nop = first == 0x66 && second == 0x90;
+        const bool rex_push = (first == 0x40 || first == 0x41) && second >= 0x50 && second <= 0x57;
+        if (!mov_edi_edi && !two_byte_nop && !rex_push)
+        {
+            return std::nullopt;
+        }
+        HotPatchSite site;
+        std::memcpy(site.pad.data(), code.data(), site.pad.size());
+        std::memcpy(site.entry.data(), code.data() + 5, site.entry.size());
+        return site;
+    }
+    /// Longest legal x86-64 instruction; a decode that would run past it is rejected, as the CPU rejects it (#GP).
+    inline constexpr std::size_t X86_MAX_INSTRUCTION_LENGTH = 15;
+
+    /**
+     * @struct InsnShape
+     * @brief What a linear code sweep needs from one instruction: its length and any RIP-relative displacement.
+     */
+    struct InsnShape
+    {
+        /// Encoded length in bytes, 1..X86_MAX_INSTRUCTION_LENGTH.
+        std::uint8_t length = 0;
+        /// True when the ModRM memory operand is [rip + disp32]; a 0x67 [eip + disp32] operand is not.
+        bool rip_relative = false;
+        /// The operand's disp32 when @ref rip_relative; 0 otherwise.
+        std::int32_t displacement = 0;
+        /// The opcode byte after any prefixes and REX for a one-byte-map instruction; 0x0F for every other map.
+        std::uint8_t opcode = 0;
+        /// ModRM.reg, which selects the member of a group such as FF; 0 without a ModRM byte.
+        std::uint8_t modrm_reg = 0;
+
+        /// True for a ret (near or far, with or without imm16) or an unconditional jmp (rel8, rel32 or FF /4, /5).
+        [[nodiscard]] constexpr bool never_falls_through() const noexcept
+        {
+            switch (opcode)
+            {
+            case 0xC2:
+            case 0xC3:
+            case 0xCA:
+            case 0xCB:
+            case 0xE9:
+            case 0xEB:
+                return true;
+            case 0xFF:
+                return modrm_reg == 4 || modrm_reg == 5;
+            default:
+                return false;
+            }
+        }
+
+        /// Absolute target of the RIP-relative operand for this instruction placed at @p address.
+        [[nodiscard]] constexpr std::uintptr_t rip_target(std::uintptr_t address) const noexcept
+        {
+            return static_cast<std::uintptr_t>(static_cast<std::int64_t>(address) + length + displacement);
+        }
+    };
+
+    namespace x86_shape
+    {
+        // Per-opcode shape bits. An opcode's immediate is the sum of its IMM bits, so ENTER (iw, ib) is IMM16 | IMM8.
+        inline constexpr std::uint8_t MODRM = 0x01;
+        inline constexpr std::uint8_t IMM8 = 0x02;
+        inline constexpr std::uint8_t IMM16 = 0x04;
+        // imm16 under a 0x66 prefix, else imm32 (REX.W keeps it imm32, sign-extended).
+        inline constexpr std::uint8_t IMMZ = 0x08;
+        // mov r, imm: imm64 under REX.W, imm16 under 0x66, else imm32.
+        inline constexpr std::uint8_t IMMV = 0x10;
+        // Near branch displacement; 64-bit mode ignores 0x66 here (Intel semantics, as Zydis decodes by default).
+        inline constexpr std::uint8_t REL32 = 0x20;
+        // No 64-bit encoding: the sweep byte-restarts on it.
+        inline constexpr std::uint8_t INVALID = 0x40;
+
+        [[nodiscard]] constexpr std::array<std::uint8_t, 256> make_one_byte_table() noexcept
+        {
+            std::array<std::uint8_t, 256> table{};
+            // 00-3F: eight ALU rows of r/m forms, then AL/eAX immediate forms; the x6/x7 and xE/xF holes are the
+            // segment push/pop and BCD opcodes 64-bit mode removed (26/2E/36/3E are prefixes and 0F is the escape).
+            for (std::size_t op = 0; op < 0x40; ++op)
+            {
+                const std::size_t low = op & 7;
+                table[op] = low <= 3 ? MODRM : low == 4 ? IMM8 : low == 5 ? IMMZ : INVALID;
+            }
+            table[0x0F] = 0;
+            table[0x26] = table[0x2E] = table[0x36] = table[0x3E] = 0;
+            table[0x60] = table[0x61] = INVALID;
+            table[0x63] = MODRM;
+            table[0x68] = IMMZ;
+            table[0x69] = MODRM | IMMZ;
+            table[0x6A] = IMM8;
+            table[0x6B] = MODRM | IMM8;
+            for (std::size_t op = 0x70; op <= 0x7F; ++op)
+            {
+                table[op] = IMM8;
+            }
+            table[0x80] = MODRM | IMM8;
+            table[0x81] = MODRM | IMMZ;
+            table[0x82] = INVALID;
+            table[0x83] = MODRM | IMM8;
+            for (std::size_t op = 0x84; op <= 0x8F; ++op)
+            {
+                table[op] = MODRM;
+            }
+            table[0x9A] = INVALID;
+            table[0xA8] = IMM8;
+            table[0xA9] = IMMZ;
+            for (std::size_t op = 0xB0; op <= 0xB7; ++op)
+            {
+                table[op] = IMM8;
+                table[op + 8] = IMMV;
+            }
+            table[0xC0] = table[0xC1] = MODRM | IMM8;
+            table[0xC2] = IMM16;
+            table[0xC6] = MODRM | IMM8;
+            table[0xC7] = MODRM | IMMZ;
+            table[0xC8] = IMM16 | IMM8;
+            table[0xCA] = IMM16;
+            table[0xCD] = IMM8;
+            table[0xCE] = INVALID;
+            for (std::size_t op = 0xD0; op <= 0xDF; ++op)
+            {
+                table[op] = MODRM;
+            }
+            table[0xD4] = table[0xD5] = table[0xD6] = INVALID;
+            table[0xD7] = 0;
+            for (std::size_t op = 0xE0; op <= 0xE7; ++op)
+            {
+                table[op] = IMM8;
+            }
+            table[0xE8] = table[0xE9] = REL32;
+            table[0xEA] = INVALID;
+            table[0xEB] = IMM8;
+            table[0xF6] = table[0xF7] = table[0xFE] = table[0xFF] = MODRM;
+            return table;
+        }
+
+        [[nodiscard]] constexpr std::array<std::uint8_t, 256> make_two_byte_table() noexcept
+        {
+            std::array<std::uint8_t, 256> table{};
+            table.fill(MODRM);
+            for (const std::size_t op : {0x04, 0x0A, 0x0C, 0x24, 0x25, 0x26, 0x27, 0x36, 0x39, 0x3B, 0x3C, 0x3D, 0x3E,
+                                         0x3F, 0x7A, 0x7B, 0xA6, 0xA7})
+            {
+                table[op] = INVALID;
+            }
+            for (const std::size_t op : {0x05, 0x06, 0x07, 0x08, 0x09, 0x0B, 0x0E, 0x30, 0x31, 0x32, 0x33, 0x34, 0x35,
+                                         0x37, 0x77, 0xA0, 0xA1, 0xA2, 0xA8, 0xA9, 0xAA})
+            {
+                table[op] = 0;
+            }
+            // 0F 0F is 3DNow!, whose opcode is an imm8-position suffix after the operands.
+            for (const std::size_t op : {0x0F, 0x70, 0x71, 0x72, 0x73, 0xA4, 0xAC, 0xBA, 0xC2, 0xC4, 0xC5, 0xC6})
+            {
+                table[op] = MODRM | IMM8;
+            }
+            for (std::size_t op = 0x80; op <= 0x8F; ++op)
+            {
+                table[op] = REL32;
+            }
+            for (std::size_t op = 0xC8; op <= 0xCF; ++op)
+            {
+                table[op] = 0;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint8_t, 256> ONE_BYTE = make_one_byte_table();
+        // The 0F map; 0F 38 and 0F 3A are uniform (ModRM, and ModRM plus imm8) and need no table.
+        inline constexpr std::array<std::uint8_t, 256> TWO_BYTE = make_two_byte_table();
+
+        [[nodiscard]] constexpr bool is_legacy_prefix(std::uint8_t byte) noexcept
+        {
+            switch (byte)
+            {
+            case 0x26:
+            case 0x2E:
+            case 0x36:
+            case 0x3E:
+            case 0x64:
+            case 0x65:
+            case 0x66:
+            case 0x67:
+            case 0xF0:
+            case 0xF2:
+            case 0xF3:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        // Shape of a VEX (map 1-3), EVEX (map 1-3, 5, 6) or XOP (map 8-A) opcode; INVALID for a map none defines.
+        [[nodiscard]] constexpr std::uint8_t vector_shape(std::uint8_t escape, unsigned map, std::uint8_t op) noexcept
+        {
+            if (escape == 0x8F)
+            {
+                return map == 0x8 ? (MODRM | IMM8) : map == 0x9 ? MODRM : map == 0xA ? (MODRM | IMMZ) : INVALID;
+            }
+            switch (map)
+            {
+            case 1:
+                if (escape != 0x62 && op == 0x77)
+                {
+                    // vzeroupper / vzeroall.
+                    return 0;
+                }
+                return (op >= 0x70 && op <= 0x73) || op == 0xC2 || (op >= 0xC4 && op <= 0xC6) ? (MODRM | IMM8) : MODRM;
+            case 2:
+                return MODRM;
+            case 3:
+                return MODRM | IMM8;
+            case 5:
+            case 6:
+                return escape == 0x62 ? MODRM : INVALID;
+            default:
+                return INVALID;
+            }
+        }
+    } // namespace x86_shape
+
+    /**
+     * @brief Table-driven x86-64 length and ModRM decode of the instruction at @p code, for linear code sweeps.
+     * @details Walks legacy prefixes and REX, the one-byte, 0F, 0F 38 and 0F 3A maps, and the VEX, EVEX and XOP
+     *          escapes far enough to size the ModRM, SIB, displacement and immediate fields, and reports the one thing
+     *          a reference sweep asks of the operands: whether the ModRM memory operand is [rip + disp32]. An x86-64
+     *          instruction has at most one ModRM memory operand, so that covers every explicit RIP-relative reference
+     *          a full decoder would list. It rejects the opcodes 64-bit mode removed, the undefined groups of C6/C7,
+     *          FE and FF, a register-form LEA, a VEX/EVEX/XOP escape behind REX or a 66/F2/F3/LOCK prefix, and anything
+     *          past 15 bytes or past @p available; inside a defined map it does not check every hole, so over data
+     *          it accepts a few encodings Zydis would reject. That is the sweep's usual desync, which the caller's
+     *          exact-target match absorbs. Operands, registers and semantics stay with Zydis on the paths that need
+     *          them (code constants, the StringPointerSlot store match).
+     * @param code First byte of the candidate instruction; read directly, so the caller guards the range.
+     * @param available Readable bytes at @p code.
+     * @param out Filled on success; untouched otherwise.
+     * @return True when the bytes decode to a complete instruction within @p available.
+     * @note Pure and allocation-free; no table lookups beyond two 256-byte constexpr arrays.
+     */
+    [[nodiscard]] constexpr bool decode_insn_shape(const std::uint8_t *code, std::size_t available,
+                                                   InsnShape &out) noexcept
+    {
+        using namespace x86_shape;
+        const std::size_t limit = available < X86_MAX_INSTRUCTION_LENGTH ? available : X86_MAX_INSTRUCTION_LENGTH;
+        std::size_t at = 0;
+        bool operand_16 = false;
+        bool address_32 = false;
+        bool simd_prefix = false;
+        bool rex = false;
+        bool rex_w = false;
+        // A REX applies only when it immediately precedes the opcode; a legacy prefix after it cancels it.
+        while (at < limit)
+        {
+            const std::uint8_t byte = code[at];
+            if ((byte & 0xF0) == 0x40)
+            {
+                rex = true;
+                rex_w = (byte & 0x08) != 0;
+                ++at;
+                continue;
+            }
+            if (!is_legacy_prefix(byte))
+            {
+                break;
+            }
+            operand_16 = operand_16 || byte == 0x66;
+            address_32 = address_32 || byte == 0x67;
+            simd_prefix = simd_prefix || byte == 0x66 || byte == 0xF0 || byte == 0xF2 || byte == 0xF3;
+            rex = false;
+            rex_w = false;
+            ++at;
+        }
+        if (at >= limit)
+        {
+            return false;
+        }
+
+        const std::uint8_t op = code[at++];
+        std::uint8_t shape = 0;
+        bool one_byte_map = false;
+        bool register_form = false;
+        // In 64-bit mode C4/C5 (LES/LDS) and 62 (BOUND) are always VEX/EVEX; 8F is XOP unless ModRM.reg is 0 (POP).
+        if (op == 0xC4 || op == 0xC5 || op == 0x62 || (op == 0x8F && at < limit && (code[at] & 0x38) != 0))
+        {
+            if (rex || simd_prefix)
+            {
+                return false;
+            }
+            const std::size_t payload = op == 0xC5 ? 1 : op == 0x62 ? 3 : 2;
+            if (at + payload >= limit)
+            {
+                return false;
+            }
+            unsigned map = 1;
+            if (op == 0x62)
+            {
+                // EVEX P1 bit 2 is fixed at 1.
+                if ((code[at + 1] & 0x04) == 0)
+                {
+                    return false;
+                }
+                map = code[at] & 0x07u;
+            }
+            else if (op != 0xC5)
+            {
+                map = code[at] & 0x1Fu;
+                rex_w = (code[at + 1] & 0x80) != 0;
+            }
+            at += payload;
+            shape = vector_shape(op, map, code[at++]);
+            // A vector immediate is never operand-size dependent; XOP's map-A imm32 is the only wide one.
+            operand_16 = false;
+        }
+        else if (op == 0x0F)
+        {
+            if (at >= limit)
+            {
+                return false;
+            }
+            const std::uint8_t second = code[at++];
+            if (second == 0x38 || second == 0x3A)
+            {
+                if (at >= limit)
+                {
+                    return false;
+                }
+                ++at;
+                shape = second == 0x38 ? MODRM : (MODRM | IMM8);
+            }
+            else
+            {
+                shape = TWO_BYTE[second];
+                // mov to/from CR and DR take a register whatever ModRM.mod says.
+                register_form = second >= 0x20 && second <= 0x23;
+            }
+        }
+        else
+        {
+            shape = ONE_BYTE[op];
+            one_byte_map = true;
+        }
+        if ((shape & INVALID) != 0)
+        {
+            return false;
+        }
+
+        std::size_t displacement = 0;
+        bool rip_relative = false;
+        std::size_t immediate = 0;
+        std::uint8_t modrm_reg = 0;
+        if ((shape & MODRM) != 0)
+        {
+            if (at >= limit)
+            {
+                return false;
+            }
+            const std::uint8_t modrm = code[at++];
+            const unsigned mod = modrm >> 6;
+            const unsigned reg = (modrm >> 3) & 7u;
+            modrm_reg = static_cast<std::uint8_t>(reg);
+            const unsigned rm = modrm & 7u;
+            if (one_byte_map)
+            {
+                const bool undefined_group = (op == 0x8D && mod == 3) ||
+                                             ((op == 0xC6 || op == 0xC7) && reg != 0 && modrm != 0xF8) ||
+                                             (op == 0xFE && reg >= 2) || (op == 0xFF && reg == 7);
+                if (undefined_group)
+                {
+                    return false;
+                }
+                // TEST r/m, imm is the only member of group 3 with an immediate.
+                if (op == 0xF6 && reg <= 1)
+                {
+                    immediate += 1;
+                }
+                else if (op == 0xF7 && reg <= 1)
+                {
+                    immediate += operand_16 && !rex_w ? 2 : 4;
+                }
+            }
+            if (mod != 3 && !register_form)
+            {
+                if (rm == 4)
+                {
+                    if (at >= limit)
+                    {
+                        return false;
+                    }
+                    // SIB with base 101 and mod 00 is [index*scale + disp32], never RIP-relative.
+                    if (mod == 0 && (code[at] & 7u) == 5)
+                    {
+                        displacement = 4;
+                    }
+                    ++at;
+                }
+                else if (mod == 0 && rm == 5)
+                {
+                    displacement = 4;
+                    rip_relative = !address_32;
+                }
+                if (mod == 1)
+                {
+                    displacement = 1;
+                }
+                else if (mod == 2)
+                {
+                    displacement = 4;
+                }
+            }
+        }
+
+        if ((shape & IMM8) != 0)
+        {
+            immediate += 1;
+        }
+        if ((shape & IMM16) != 0)
+        {
+            immediate += 2;
+        }
+        if ((shape & IMMZ) != 0)
+        {
+            immediate += operand_16 && !rex_w ? 2 : 4;
+        }
+        if ((shape & IMMV) != 0)
+        {
+            immediate += rex_w ? 8 : operand_16 ? 2 : 4;
+        }
+        if ((shape & REL32) != 0)
+        {
+            immediate += 4;
+        }
+        if (one_byte_map && op >= 0xA0 && op <= 0xA3)
+        {
+            // mov AL/rAX <-> moffs: a full-width absolute address, 32-bit under 0x67.
+            immediate += address_32 ? 4 : 8;
+        }
+
+        const std::size_t length = at + displacement + immediate;
+        if (length > limit)
+        {
+            return false;
+        }
+        out.length = static_cast<std::uint8_t>(length);
+        out.rip_relative = rip_relative;
+        out.opcode = one_byte_map ? op : std::uint8_t{0x0F};
+        out.modrm_reg = modrm_reg;
+        out.displacement = 0;
+        if (rip_relative)
+        {
+            const std::uint32_t raw = static_cast<std::uint32_t>(code[at]) |
+                                      (static_cast<std::uint32_t>(code[at + 1]) << 8) |
+                                      (static_cast<std::uint32_t>(code[at + 2]) << 16) |
+                                      (static_cast<std::uint32_t>(code[at + 3]) << 24);
+            out.displacement = static_cast<std::int32_t>(raw);
+        }
+        return true;
+    }
 } // namespace DetourModKit::detail
 
 #endif // DETOURMODKIT_X86_DECODE_HPP
@@ -0,0 +1,243 @@
+/**
+ * @file bench_config.cpp
+ * @brief Standalone benchmark for the config pipeline: load, reload and log_all as the bound key count grows.
+ *
+ * Each key count binds that many keys -- a rotating mix of int, float and bool atomics and string setters, fifty to a
+ * section -- over a generated INI, then times:
+ *
+ *   - cold_load     load() of a freshly bound registry (every setter runs)
+ *   - noop_reload   reload() of unchanged bytes (the content-hash short-circuit)
+ *   - one_key       reload() after one value changed (one setter runs)
+ *   - full_reload   reload() after every value changed
+ *   - log_all       log_all() at Debug level into the bench's log file
+ *
+ * The file is rewritten between samples outside the timed region. allocs is the largest number of operator new calls
+ * one operation made on the calling thread, counted through the test suite's allocation probe (test_alloc_probe.cpp
+ * is linked in for its global operator new replacement).
+ *
+ * Build with -DDMK_BUILD_BENCHMARKS=ON. Executable: DetourModKit_bench_config
+ * Output: a human-readable table plus a TSV block on stdout; --json / --compare as for every bench (bench_harness.hpp).
+ */
+
+#include "DetourModKit/config.hpp"
+#include "DetourModKit/logger.hpp"
+
+#include "bench_harness.hpp"
+#include "test_alloc_probe.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using namespace DetourModKit;
+
+    constexpr std::array<std::size_t, 4> KEY_COUNTS{10, 100, 1000, 10000};
+    constexpr std::size_t KEYS_PER_SECTION = 50;
+    constexpr std::size_t SAMPLES = 9;
+
+    struct Row
+    {
+        const char *scenario;
+        std::size_t keys;
+        double median_us;
+        double min_us;
+        long long allocs;
+    };
+
+    // The bound targets. Atomics cannot move, so each kind lives in a fixed array sized for the key count.
+    struct Targets
+    {
+        explicit Targets(std::size_t keys)
+            : ints(std::make_unique<std::atomic<int>[]>(keys)), floats(std::make_unique<std::atomic<float>[]>(keys)),
+              bools(std::make_unique<std::atomic<bool>[]>(keys))
+        {
+        }
+
+        std::unique_ptr<std::atomic<int>[]> ints;
+        std::unique_ptr<std::atomic<float>[]> floats;
+        std::unique_ptr<std::atomic<bool>[]> bools;
+        std::atomic<std::size_t> string_bytes{0};
+    };
+
+    std::string section_of(std::size_t i)
+    {
+        return "Section" + std::to_string(i / KEYS_PER_SECTION);
+    }
+
+    std::string key_of(std::size_t i)
+    {
+        return "Key" + std::to_string(i);
+    }
+
+    void bind_all(std::size_t keys, Targets &targets)
+    {
+        for (std::size_t i = 0; i < keys; ++i)
+        {
+            const std::string section = section_of(i);
+            const std::string key = key_of(i);
+            switch (i % 4)
+            {
+            case 0:
+                config::bind(section, key, key, targets.ints[i], 0);
+                break;
+            case 1:
+                config::bind(section, key, key, targets.floats[i], 0.0f);
+                break;
+            case 2:
+                config::bind(section, key, key, targets.bools[i], false);
+                break;
+            default:
+                config::bind_string(
+                    section, key, key,
+                    [&targets](std::string_view value)
+                    { targets.string_bytes.fetch_add(value.size(), std::memory_order_relaxed); },
+                    "unset");
+                break;
+            }
+        }
+    }
+
+    // Every key takes @p base as its value, except key 0, which takes @p first.
+    void write_ini(const std::filesystem::path &path, std::size_t keys, int base, int first)
+    {
+        std::string text;
+        text.reserve(keys * 24);
+        for (std::size_t i = 0; i < keys; ++i)
+        {
+            if (i % KEYS_PER_SECTION == 0)
+                text += "[" + section_of(i) + "]\n";
+            const int value = i == 0 ? first : base;
+            text += key_of(i) + " = ";
+            switch (i % 4)
+            {
+            case 0:
+                text += std::to_string(value);
+                break;
+            case 1:
+                text += std::to_string(value) + ".5";
+                break;
+            case 2:
+                text += value % 2 == 0 ? "false" : "true";
+                break;
+            default:
+                text += "value_" + std::to_string(value);
+                break;
+            }
+            text += '\n';
+        }
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    // Times SAMPLES runs of @p op, calling @p prepare untimed before each, and records them as "<scenario>/<keys>".
+    template <typename Prepare, typename Op>
+    Row measure(const char *scenario, std::size_t keys, Prepare prepare, Op op)
+    {
+        std::vector<double> times;
+        long long allocs = 0;
+        for (std::size_t s = 0; s < SAMPLES; ++s)
+        {
+            prepare(s);
+            const long long news_before = dmk_test::thread_new_calls();
+            const auto start = Clock::now();
+            op();
+            const auto end = Clock::now();
+            allocs = std::max(allocs, dmk_test::thread_new_calls() - news_before);
+            times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        const dmk_bench::Summary summary = dmk_bench::summarize(times);
+        dmk_bench::record(std::string(scenario) + "/" + std::to_string(keys), std::move(times));
+        return Row{scenario, keys, summary.median / 1000.0, summary.min / 1000.0, allocs};
+    }
+
+    void run_key_count(std::size_t keys, const std::filesystem::path &ini, std::vector<Row> &rows)
+    {
+        Targets targets(keys);
+        Logger &logger = log();
+        logger.set_log_level(LogLevel::Warning);
+
+        rows.push_back(measure(
+            "cold_load", keys,
+            [&](std::size_t)
+            {
+                config::clear();
+                bind_all(keys, targets);
+                write_ini(ini, keys, 1, 1);
+            },
+            [&]() { config::load(ini.string()); }));
+
+        rows.push_back(measure(
+            "noop_reload", keys, [](std::size_t) {}, [&]() { (void)config::reload(); }));
+
+        // Key 0 alternates between two values, so each sample changes exactly one key.
+        rows.push_back(measure(
+            "one_key", keys, [&](std::size_t s) { write_ini(ini, keys, 1, s % 2 == 0 ? 2 : 3); },
+            [&]() { (void)config::reload(); }));
+
+        // Every key alternates between two values, so each sample changes all of them.
+        rows.push_back(measure(
+            "full_reload", keys,
+            [&](std::size_t s)
+            {
+                const int value = s % 2 == 0 ? 4 : 5;
+                write_ini(ini, keys, value, value);
+            },
+            [&]() { (void)config::reload(); }));
+
+        logger.set_log_level(LogLevel::Debug);
+        rows.push_back(measure(
+            "log_all", keys, [](std::size_t) {}, []() { config::log_all(); }));
+        logger.set_log_level(LogLevel::Warning);
+
+        // The targets die with this scope; drop the bindings that point at them first.
+        config::clear();
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    dmk_bench::Session session("config", argc, argv);
+
+    Logger::configure("BenchConfig", "DetourModKit_bench_config.log");
+    const std::filesystem::path ini = std::filesystem::temp_directory_path() / "dmk_bench_config.ini";
+
+    dmk_bench::table("[1] Config pipeline, median of %zu samples (us per operation)\n", SAMPLES);
+    dmk_bench::table("  %-12s %7s %12s %12s %10s\n", "scenario", "keys", "median", "min", "allocs");
+    std::vector<Row> rows;
+    for (const std::size_t keys : KEY_COUNTS)
+    {
+        const std::size_t first = rows.size();
+        run_key_count(keys, ini, rows);
+        for (std::size_t i = first; i < rows.size(); ++i)
+        {
+            const Row &row = rows[i];
+            dmk_bench::table("  %-12s %7zu %12.1f %12.1f %10lld\n", row.scenario, row.keys, row.median_us, row.min_us,
+                             row.allocs);
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::remove(ini, ec);
+
+    // TSV block for machine parsing.
+    dmk_bench::table("\n#TSV\tscenario\tkeys\tmedian_us\tmin_us\tallocs\n");
+    for (const Row &row : rows)
+    {
+        dmk_bench::table("#TSV\t%s\t%zu\t%.1f\t%.1f\t%lld\n", row.scenario, row.keys, row.median_us, row.min_us,
+                         row.allocs);
+    }
+    return session.finish();
+}
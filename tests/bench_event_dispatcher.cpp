@@ -9,6 +9,7 @@
  *
  * Output is a tab-separated table on stdout. One row per metric. Columns:
  *   scenario, subscribers, iterations, median_ns_per_op, total_ms
+ * --json, --compare and the other flags of bench_harness.hpp apply.
  *
  * This binary is deliberately not a gtest: it is a separate executable so it can run under whatever build configuration
  * the user wants (release, release+PGO, etc.) without dragging in the gtest runtime.
@@ -16,12 +17,14 @@
 
 #include "DetourModKit/detail/event_dispatcher.hpp"
 
-#include <algorithm>
+#include "bench_harness.hpp"
+
 #include <atomic>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstdio>
+#include <string>
 #include <thread>
 #include <vector>
 
@@ -45,41 +48,13 @@ namespace
         s_sink.fetch_add(static_cast<std::uint64_t>(e.value), std::memory_order_relaxed);
     }
 
-    // Runs `op` `iterations` times within a single sample, repeats the sample `samples` times, and returns the median
-    // wall time per sample in nanoseconds divided by iterations (i.e. per-op cost).
-    template <typename Op> double median_ns_per_op(std::size_t iterations, std::size_t samples, Op &&op)
-    {
-        std::vector<double> per_op;
-        per_op.reserve(samples);
+    // Concurrent-emit handler. Each thread accumulates into its own sink and folds it into s_sink once, after its loop,
+    // so the measurement is the dispatcher's scaling and not contention on a shared sink line.
+    thread_local std::uint64_t t_sink{0};
 
-        // Warm caches and branch predictors so the first timed sample is not cold, matching the scanner/memory benches.
-        const std::size_t warmup = iterations / 10 + 1;
-        for (std::size_t i = 0; i < warmup; ++i)
-        {
-            op();
-        }
-
-        for (std::size_t s = 0; s < samples; ++s)
-        {
-            const auto start = Clock::now();
-            for (std::size_t i = 0; i < iterations; ++i)
-            {
-                op();
-            }
-            const auto end = Clock::now();
-            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-            per_op.push_back(static_cast<double>(ns) / static_cast<double>(iterations));
-        }
-
-        std::sort(per_op.begin(), per_op.end());
-        // Average the two middle samples on even counts so the helper returns the true median regardless of sample
-        // parity. Current callers use 11 samples (odd), but future callers may not.
-        const std::size_t n = per_op.size();
-        if ((n % 2) == 0)
-        {
-            return (per_op[(n / 2) - 1] + per_op[n / 2]) / 2.0;
-        }
-        return per_op[n / 2];
+    void thread_sink_handler(const BenchEvent &e) noexcept
+    {
+        t_sink += static_cast<std::uint64_t>(e.value);
     }
 
     void bench_emit(std::size_t subscriber_count, std::size_t iterations, std::size_t samples, const char *label,
@@ -95,24 +70,25 @@ namespace
 
         const BenchEvent evt{42};
         const auto total_start = Clock::now();
-        const double med = median_ns_per_op(iterations, samples,
-                                            [&]()
-                                            {
-                                                if (use_safe)
-                                                {
-                                                    dispatcher.emit_safe(evt);
-                                                }
-                                                else
-                                                {
-                                                    dispatcher.emit(evt);
-                                                }
-                                            });
+        const std::string row = std::string(label) + "/" + std::to_string(subscriber_count);
+        const double med = dmk_bench::median_ns_per_op(row, iterations, samples,
+                                                       [&]()
+                                                       {
+                                                           if (use_safe)
+                                                           {
+                                                               dispatcher.emit_safe(evt);
+                                                           }
+                                                           else
+                                                           {
+                                                               dispatcher.emit(evt);
+                                                           }
+                                                       });
         const auto total_end = Clock::now();
 
         const auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_end - total_start).count();
 
-        std::printf("%s\t%zu\t%zu\t%.2f\t%lld\n", label, subscriber_count, iterations, med,
-                    static_cast<long long>(total_ms));
+        dmk_bench::table("%s\t%zu\t%zu\t%.2f\t%lld\n", label, subscriber_count, iterations, med,
+                         static_cast<long long>(total_ms));
     }
 
     void bench_subscribe_unsubscribe(std::size_t iterations, std::size_t samples)
@@ -120,18 +96,18 @@ namespace
         DetourModKit::EventDispatcher<BenchEvent> dispatcher;
 
         const auto total_start = Clock::now();
-        const double med = median_ns_per_op(iterations, samples,
-                                            [&]()
-                                            {
-                                                auto sub = dispatcher.subscribe(&noop_handler);
-                                                // sub destroyed here: triggers unsubscribe
-                                            });
+        const double med = dmk_bench::median_ns_per_op("subscribe_unsub_roundtrip", iterations, samples,
+                                                       [&]()
+                                                       {
+                                                           auto sub = dispatcher.subscribe(&noop_handler);
+                                                           // sub destroyed here: triggers unsubscribe
+                                                       });
         const auto total_end = Clock::now();
 
         const auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_end - total_start).count();
 
-        std::printf("subscribe_unsub_roundtrip\t0\t%zu\t%.2f\t%lld\n", iterations, med,
-                    static_cast<long long>(total_ms));
+        dmk_bench::table("subscribe_unsub_roundtrip\t0\t%zu\t%.2f\t%lld\n", iterations, med,
+                         static_cast<long long>(total_ms));
     }
 
     void bench_concurrent_emit(std::size_t thread_count, std::size_t per_thread_iters, std::size_t subscriber_count)
@@ -141,7 +117,7 @@ namespace
         subs.reserve(subscriber_count);
         for (std::size_t i = 0; i < subscriber_count; ++i)
         {
-            subs.push_back(dispatcher.subscribe(&noop_handler));
+            subs.push_back(dispatcher.subscribe(&thread_sink_handler));
         }
 
         std::atomic<bool> go{false};
@@ -163,6 +139,7 @@ namespace
                     {
                         dispatcher.emit(evt);
                     }
+                    s_sink.fetch_add(t_sink, std::memory_order_relaxed);
                 });
         }
 
@@ -177,9 +154,10 @@ namespace
         const auto total_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
         const auto total_ops = thread_count * per_thread_iters;
         const double per_op = static_cast<double>(total_ns) / static_cast<double>(total_ops);
+        dmk_bench::record_value("emit_concurrent/" + std::to_string(thread_count) + "_threads", per_op);
 
-        std::printf("emit_concurrent_%zu_threads\t%zu\t%zu\t%.2f\t%lld\n", thread_count, subscriber_count, total_ops,
-                    per_op, static_cast<long long>(total_ns / 1'000'000));
+        dmk_bench::table("emit_concurrent_%zu_threads\t%zu\t%zu\t%.2f\t%lld\n", thread_count, subscriber_count,
+                         total_ops, per_op, static_cast<long long>(total_ns / 1'000'000));
     }
 
     void bench_reentrancy_rejection(std::size_t iterations, std::size_t samples)
@@ -198,20 +176,23 @@ namespace
         const BenchEvent evt{0};
 
         const auto total_start = Clock::now();
-        const double med = median_ns_per_op(iterations, samples, [&]() { dispatcher.emit(evt); });
+        const double med =
+            dmk_bench::median_ns_per_op("reentrancy_rejection", iterations, samples, [&]() { dispatcher.emit(evt); });
         const auto total_end = Clock::now();
 
         const auto total_ms = std::chrono::duration_cast<std::chrono::milliseconds>(total_end - total_start).count();
 
-        std::printf("reentrancy_rejection\t1\t%zu\t%.2f\t%lld\n", iterations, med, static_cast<long long>(total_ms));
+        dmk_bench::table("reentrancy_rejection\t1\t%zu\t%.2f\t%lld\n", iterations, med,
+                         static_cast<long long>(total_ms));
     }
 } // anonymous namespace
 
-int main()
+int main(int argc, char **argv)
 {
+    dmk_bench::Session session("event_dispatcher", argc, argv);
     constexpr std::size_t samples = 11; // odd, so median is well-defined
 
-    std::printf("scenario\tsubscribers\titerations\tmedian_ns_per_op\ttotal_ms\n");
+    dmk_bench::table("scenario\tsubscribers\titerations\tmedian_ns_per_op\ttotal_ms\n");
 
     // Single-thread emit()
     bench_emit(0, 10'000'000, samples, "emit", false);
@@ -228,13 +209,16 @@ int main()
     // Subscribe + unsubscribe round-trip
     bench_subscribe_unsubscribe(100'000, samples);
 
-    // Concurrent emit throughput
+    // Concurrent emit throughput. Emitters share no written cache line, so per-op cost should stay flat as threads
+    // are added.
+    bench_concurrent_emit(1, 1'000'000, 8);
     bench_concurrent_emit(4, 1'000'000, 8);
+    bench_concurrent_emit(8, 1'000'000, 8);
 
     // Reentrancy-rejection path
     bench_reentrancy_rejection(500'000, samples);
 
     // Touch s_sink so the optimizer keeps the handler body.
-    std::printf("# sink=%llu\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
-    return 0;
+    dmk_bench::table("# sink=%llu\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
+    return session.finish();
 }
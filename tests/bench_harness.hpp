@@ -0,0 +1,480 @@
+#ifndef DETOURMODKIT_TEST_BENCH_HARNESS_HPP
+#define DETOURMODKIT_TEST_BENCH_HARNESS_HPP
+
+/**
+ * @file bench_harness.hpp
+ * @brief The sampling, reporting and baseline-comparison machinery every DetourModKit_bench* executable shares.
+ * @details A bench opens one @ref dmk_bench::Session in main() and routes each measured row through it: the shared
+ *          samplers (@ref dmk_bench::sample_ns_per_op, @ref dmk_bench::median_ns_per_op) time the repeated samples
+ *          and @ref dmk_bench::record files them under a stable row name. The bench's own human-readable table is
+ *          printed through @ref dmk_bench::table, unchanged from before.
+ *
+ *          Every recorded row is a cost in nanoseconds, so lower is always better. The command line is the same for
+ *          every bench:
+ *            --json                  print one JSON object per recorded row on stdout (the table moves to stderr)
+ *            --compare <file>        compare each row against a baseline written earlier by --json
+ *            --threshold <percent>   smallest median change reported as a regression or an improvement (default 5)
+ *            --fail-on-regression    exit with status 3 when any row is significantly slower than the baseline
+ *
+ *          A row differs from its baseline only when Welch's two-sided t-test rejects equal means at the 5% level over
+ *          the two sample sets AND the medians differ by at least the threshold; the second condition keeps a real but
+ *          trivial shift on a very quiet row from failing a run. A row with fewer than two samples on either side is
+ *          reported with its delta but never judged.
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DMK_BENCH_PRINTF_FORMAT __attribute__((format(printf, 1, 2)))
+#else
+#define DMK_BENCH_PRINTF_FORMAT
+#endif
+
+namespace dmk_bench
+{
+    using Clock = std::chrono::steady_clock;
+
+    /// Order statistics and moments of one row's samples.
+    struct Summary
+    {
+        std::size_t count = 0;
+        double median = 0.0;
+        double mean = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    /// The median of @p values (the mean of the two middle values on an even count); 0 when empty.
+    [[nodiscard]] inline double median_of(std::vector<double> values)
+    {
+        if (values.empty())
+        {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        const std::size_t n = values.size();
+        return (n % 2) == 0 ? (values[(n / 2) - 1] + values[n / 2]) / 2.0 : values[n / 2];
+    }
+
+    /// Summarizes @p samples; the standard deviation is the sample (n - 1) one.
+    [[nodiscard]] inline Summary summarize(std::span<const double> samples)
+    {
+        Summary out;
+        out.count = samples.size();
+        if (samples.empty())
+        {
+            return out;
+        }
+        out.median = median_of(std::vector<double>(samples.begin(), samples.end()));
+        const auto [lo, hi] = std::minmax_element(samples.begin(), samples.end());
+        out.min = *lo;
+        out.max = *hi;
+        double sum = 0.0;
+        for (const double s : samples)
+        {
+            sum += s;
+        }
+        out.mean = sum / static_cast<double>(samples.size());
+        if (samples.size() > 1)
+        {
+            double squares = 0.0;
+            for (const double s : samples)
+            {
+                squares += (s - out.mean) * (s - out.mean);
+            }
+            out.stddev = std::sqrt(squares / static_cast<double>(samples.size() - 1));
+        }
+        return out;
+    }
+
+    /**
+     * @brief Times @p op in @p samples samples of @p iterations calls each, after a short warm-up.
+     * @return The per-call cost of each sample, in nanoseconds, in the order taken.
+     */
+    template <typename Op>
+    [[nodiscard]] std::vector<double> sample_ns_per_op(std::size_t iterations, std::size_t samples, Op &&op)
+    {
+        const std::size_t warmup = iterations / 10 + 1;
+        for (std::size_t i = 0; i < warmup; ++i)
+        {
+            op();
+        }
+
+        std::vector<double> out;
+        out.reserve(samples);
+        for (std::size_t s = 0; s < samples; ++s)
+        {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < iterations; ++i)
+            {
+                op();
+            }
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            out.push_back(static_cast<double>(ns) / static_cast<double>(iterations));
+        }
+        return out;
+    }
+
+    /// One row's verdict against its baseline.
+    struct Comparison
+    {
+        std::string row;
+        Summary baseline;
+        Summary current;
+        double delta_pct = 0.0;
+        double t = 0.0;
+        double df = 0.0;
+        /// "slower", "faster", "same", "unjudged" (too few samples) or "new" (no baseline row).
+        const char *verdict = "new";
+    };
+
+    /// The two-sided 5% critical value of Student's t at @p df degrees of freedom.
+    [[nodiscard]] inline double t_critical_95(double df) noexcept
+    {
+        static constexpr std::array<double, 30> table{12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306,
+                                                      2.262,  2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120,
+                                                      2.110,  2.101, 2.093, 2.086, 2.080, 2.074, 2.069, 2.064,
+                                                      2.060,  2.056, 2.052, 2.048, 2.045, 2.042};
+        if (df < 1.0)
+        {
+            return table[0];
+        }
+        if (df <= 30.0)
+        {
+            return table[static_cast<std::size_t>(df) - 1];
+        }
+        return df <= 60.0 ? 2.000 : (df <= 120.0 ? 1.980 : 1.960);
+    }
+
+    /// Judges @p current against @p baseline (Welch's t-test plus the median threshold, in percent).
+    [[nodiscard]] inline Comparison compare_samples(std::string row, std::span<const double> baseline,
+                                                    std::span<const double> current, double threshold_pct)
+    {
+        Comparison out;
+        out.row = std::move(row);
+        out.baseline = summarize(baseline);
+        out.current = summarize(current);
+        if (out.baseline.median > 0.0)
+        {
+            out.delta_pct = (out.current.median - out.baseline.median) / out.baseline.median * 100.0;
+        }
+        if (out.baseline.count < 2 || out.current.count < 2)
+        {
+            out.verdict = "unjudged";
+            return out;
+        }
+
+        const double vb = out.baseline.stddev * out.baseline.stddev / static_cast<double>(out.baseline.count);
+        const double vc = out.current.stddev * out.current.stddev / static_cast<double>(out.current.count);
+        const double spread = vb + vc;
+        bool significant = false;
+        if (spread > 0.0)
+        {
+            out.t = (out.current.mean - out.baseline.mean) / std::sqrt(spread);
+            out.df = (spread * spread) / ((vb * vb) / static_cast<double>(out.baseline.count - 1) +
+                                          (vc * vc) / static_cast<double>(out.current.count - 1));
+            significant = std::fabs(out.t) > t_critical_95(out.df);
+        }
+        else
+        {
+            // Two noiseless sets: any difference in the means is exact.
+            significant = out.current.mean != out.baseline.mean;
+        }
+
+        if (!significant || std::fabs(out.delta_pct) < threshold_pct)
+        {
+            out.verdict = "same";
+        }
+        else
+        {
+            out.verdict = out.delta_pct > 0.0 ? "slower" : "faster";
+        }
+        return out;
+    }
+
+    /// A row read back from a --json baseline.
+    struct BaselineRow
+    {
+        std::string bench;
+        std::string row;
+        std::vector<double> samples;
+    };
+
+    // Reads the string value of "key":"..." on @p line, undoing the two escapes write_json_string emits.
+    [[nodiscard]] inline bool json_string_field(std::string_view line, std::string_view key, std::string &out)
+    {
+        const std::string needle = "\"" + std::string(key) + "\":\"";
+        const std::size_t at = line.find(needle);
+        if (at == std::string_view::npos)
+        {
+            return false;
+        }
+        out.clear();
+        for (std::size_t i = at + needle.size(); i < line.size(); ++i)
+        {
+            if (line[i] == '\\' && i + 1 < line.size())
+            {
+                out.push_back(line[++i]);
+                continue;
+            }
+            if (line[i] == '"')
+            {
+                return true;
+            }
+            out.push_back(line[i]);
+        }
+        return false;
+    }
+
+    /// Parses the record lines of a --json run; comparison lines and anything else are skipped.
+    [[nodiscard]] inline bool load_baseline(const std::string &path, std::vector<BaselineRow> &out)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            return false;
+        }
+        std::string line;
+        while (std::getline(file, line))
+        {
+            BaselineRow row;
+            const std::size_t samples_at = line.find("\"samples\":[");
+            if (samples_at == std::string::npos || !json_string_field(line, "bench", row.bench) ||
+                !json_string_field(line, "row", row.row))
+            {
+                continue;
+            }
+            const char *cursor = line.c_str() + samples_at + 11;
+            while (*cursor != '\0' && *cursor != ']')
+            {
+                char *end = nullptr;
+                const double value = std::strtod(cursor, &end);
+                if (end == cursor)
+                {
+                    break;
+                }
+                row.samples.push_back(value);
+                cursor = end;
+                while (*cursor == ',' || *cursor == ' ')
+                {
+                    ++cursor;
+                }
+            }
+            out.push_back(std::move(row));
+        }
+        return true;
+    }
+
+    inline void write_json_string(std::FILE *stream, std::string_view text)
+    {
+        std::fputc('"', stream);
+        for (const char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                std::fputc('\\', stream);
+            }
+            std::fputc(c, stream);
+        }
+        std::fputc('"', stream);
+    }
+
+    /**
+     * @class Session
+     * @brief One bench run: its command line, its recorded rows, and the baseline comparison at the end.
+     * @details Construct it first thing in main() and return @ref finish from main(). The free helpers below record
+     *          into the open session, so a bench's measuring functions need no session parameter.
+     */
+    class Session
+    {
+    public:
+        Session(std::string_view bench, int argc, char **argv) : m_bench(bench)
+        {
+            for (int i = 1; i < argc; ++i)
+            {
+                const std::string_view arg{argv[i]};
+                if (arg == "--json")
+                {
+                    m_json = true;
+                }
+                else if (arg == "--compare" && i + 1 < argc)
+                {
+                    m_compare_path = argv[++i];
+                }
+                else if (arg == "--threshold" && i + 1 < argc)
+                {
+                    m_threshold_pct = std::strtod(argv[++i], nullptr);
+                }
+                else if (arg == "--fail-on-regression")
+                {
+                    m_fail_on_regression = true;
+                }
+                else
+                {
+                    std::fprintf(stderr, "[bench] ignoring unknown argument %s\n", argv[i]);
+                }
+            }
+            s_current = this;
+        }
+
+        ~Session() { s_current = nullptr; }
+        Session(const Session &) = delete;
+        Session &operator=(const Session &) = delete;
+
+        /// The open session, or nullptr outside one.
+        [[nodiscard]] static Session *current() noexcept { return s_current; }
+
+        [[nodiscard]] bool json() const noexcept { return m_json; }
+
+        /// Where the human-readable table goes: stdout, or stderr under --json so stdout stays machine-readable.
+        [[nodiscard]] std::FILE *table_stream() const noexcept { return m_json ? stderr : stdout; }
+
+        /// Files @p ns_samples under @p row and, under --json, prints the row's record line.
+        void record(std::string_view row, std::vector<double> ns_samples)
+        {
+            const Summary summary = summarize(ns_samples);
+            if (m_json)
+            {
+                std::fputs("{\"bench\":", stdout);
+                write_json_string(stdout, m_bench);
+                std::fputs(",\"row\":", stdout);
+                write_json_string(stdout, row);
+                std::printf(",\"unit\":\"ns\",\"n\":%zu,\"median\":%.3f,\"mean\":%.3f,\"stddev\":%.3f,\"min\":%.3f,"
+                            "\"max\":%.3f,\"samples\":[",
+                            summary.count, summary.median, summary.mean, summary.stddev, summary.min, summary.max);
+                for (std::size_t i = 0; i < ns_samples.size(); ++i)
+                {
+                    std::printf(i == 0 ? "%.3f" : ",%.3f", ns_samples[i]);
+                }
+                std::fputs("]}\n", stdout);
+            }
+            m_rows.emplace_back(std::string(row), std::move(ns_samples));
+        }
+
+        /**
+         * @brief Runs the --compare pass, if one was asked for, and returns main()'s exit status.
+         * @return 0; 2 when the baseline cannot be read; 3 under --fail-on-regression when a row got slower.
+         */
+        [[nodiscard]] int finish()
+        {
+            std::fflush(stdout);
+            if (m_compare_path.empty())
+            {
+                return 0;
+            }
+            std::vector<BaselineRow> baseline;
+            if (!load_baseline(m_compare_path, baseline))
+            {
+                std::fprintf(stderr, "[bench] cannot read baseline %s\n", m_compare_path.c_str());
+                return 2;
+            }
+
+            bool regressed = false;
+            std::FILE *const out = m_json ? stdout : table_stream();
+            if (!m_json)
+            {
+                std::fprintf(out, "\n#COMPARE\trow\tbaseline_median_ns\tmedian_ns\tdelta_pct\tt\tverdict\n");
+            }
+            for (const auto &[row, samples] : m_rows)
+            {
+                const auto match = std::find_if(baseline.begin(), baseline.end(), [&](const BaselineRow &b) {
+                    return b.bench == m_bench && b.row == row;
+                });
+                Comparison result;
+                if (match == baseline.end())
+                {
+                    result.row = row;
+                    result.current = summarize(samples);
+                }
+                else
+                {
+                    result = compare_samples(row, match->samples, samples, m_threshold_pct);
+                }
+                regressed = regressed || std::string_view{result.verdict} == "slower";
+                print_comparison(out, result);
+            }
+            std::fflush(out);
+            return (regressed && m_fail_on_regression) ? 3 : 0;
+        }
+
+    private:
+        void print_comparison(std::FILE *out, const Comparison &c) const
+        {
+            if (!m_json)
+            {
+                std::fprintf(out, "#COMPARE\t%s\t%.3f\t%.3f\t%+.2f\t%.2f\t%s\n", c.row.c_str(), c.baseline.median,
+                             c.current.median, c.delta_pct, c.t, c.verdict);
+                return;
+            }
+            std::fputs("{\"bench\":", out);
+            write_json_string(out, m_bench);
+            std::fputs(",\"row\":", out);
+            write_json_string(out, c.row);
+            std::fprintf(out,
+                         ",\"compare\":{\"baseline_median\":%.3f,\"median\":%.3f,\"delta_pct\":%.3f,\"t\":%.3f,"
+                         "\"df\":%.1f,\"verdict\":\"%s\"}}\n",
+                         c.baseline.median, c.current.median, c.delta_pct, c.t, c.df, c.verdict);
+        }
+
+        inline static Session *s_current = nullptr;
+
+        std::string m_bench;
+        bool m_json = false;
+        std::string m_compare_path;
+        double m_threshold_pct = 5.0;
+        bool m_fail_on_regression = false;
+        std::vector<std::pair<std::string, std::vector<double>>> m_rows;
+    };
+
+    /// Records @p ns_samples under @p row in the open session; does nothing outside one.
+    inline void record(std::string_view row, std::vector<double> ns_samples)
+    {
+        if (Session *const session = Session::current())
+        {
+            session->record(row, std::move(ns_samples));
+        }
+    }
+
+    /// Records a single observation; it is compared but never judged (see @ref compare_samples).
+    inline void record_value(std::string_view row, double ns)
+    {
+        record(row, std::vector<double>{ns});
+    }
+
+    /// Samples @p op as @ref sample_ns_per_op does, records the samples under @p row, and returns their median.
+    template <typename Op>
+    double median_ns_per_op(std::string_view row, std::size_t iterations, std::size_t samples, Op &&op)
+    {
+        std::vector<double> taken = sample_ns_per_op(iterations, samples, std::forward<Op>(op));
+        const double median = median_of(taken);
+        record(row, std::move(taken));
+        return median;
+    }
+
+    /// printf to the bench's human-readable table (see @ref Session::table_stream).
+    DMK_BENCH_PRINTF_FORMAT inline int table(const char *format, ...)
+    {
+        std::FILE *const stream = Session::current() != nullptr ? Session::current()->table_stream() : stdout;
+        va_list args;
+        va_start(args, format);
+        const int written = std::vfprintf(stream, format, args);
+        va_end(args);
+        return written;
+    }
+} // namespace dmk_bench
+
+#endif // DETOURMODKIT_TEST_BENCH_HARNESS_HPP
@@ -0,0 +1,690 @@
+/**
+ * @file bench_hook.cpp
+ * @brief Standalone benchmark for hooks: install latency, table installs, enable/disable, and call-through cost.
+ *
+ * Every hook lands in the hook_target_lib.dll fixture the integration tests hook, on its dmk_hook_bench_target
+ * functions (256 distinct int(int) bodies), so the numbers are taken against a real loaded module.
+ *
+ * Phase [1] is the per-call cost of a hooked function whose detour forwards to the original, on 1 to 16 threads
+ * calling it at once. Each path hooks its own target, and the detour forwards through:
+ *
+ *   - unhooked       (no hook at all, the floor)
+ *   - original       original<Fn>() (the unguarded trampoline call)
+ *   - call           call<int>() (the guarded call through the lock-free gate)
+ *   - try_call       try_call<int>() (the same gate with the Result report)
+ *   - legacy_gate    an atomic shared_ptr pin plus a recursive_mutex around the trampoline call, the shape the gate
+ *                    had before it went lock-free
+ *
+ * The contended rows report the median per-call cost a single thread sees and the aggregate throughput; the guarded
+ * call should stay close to its single-threaded cost while the legacy model collapses onto one lock.
+ *
+ * Phase [2] is install latency against thread count: 1 to 16 threads install at once, each on its own targets (or its
+ * own objects for vmt_for), and every install is timed on its thread; teardown is excluded. inline_at and mid_at take
+ * an Address, vmt_for is timed together with the hook_method of slot 0 that makes it useful.
+ *
+ * Phase [3] is install_all over 1 to 200 inline specs. Each spec's signature is the target's first bytes scoped to
+ * exactly those bytes, so the resolve phase is one compare per row and the figure is the table install itself;
+ * bench_resolve.cpp times install_all with real module-wide signatures.
+ *
+ * Phase [4] is one enable() and one disable() on an installed hook, each timed alone.
+ *
+ * Build with -DDMK_BUILD_BENCHMARKS=ON. Executable: DetourModKit_bench_hook (hook_target_lib.dll is copied beside it)
+ * Output: human-readable tables plus a TSV block on stdout; --json / --compare as for every bench (bench_harness.hpp).
+ */
+
+#include "DetourModKit/address.hpp"
+#include "DetourModKit/hook.hpp"
+#include "DetourModKit/region.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "bench_harness.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    namespace Hk = DetourModKit::hook;
+    namespace scan = DetourModKit::scan;
+    using DetourModKit::Address;
+    using DetourModKit::Region;
+
+    constexpr const char *FIXTURE_NAME = "hook_target_lib.dll";
+    constexpr std::size_t ITERS = 200000;
+    constexpr std::size_t SAMPLES = 15;
+    constexpr std::array<unsigned, 5> THREAD_COUNTS{1, 2, 4, 8, 16};
+
+    // Fixture target layout: the call-cost paths take the first CALL_PATHS targets, and the install phases reuse the
+    // range after them one phase at a time (every phase tears its hooks down before the next starts).
+    constexpr int CALL_PATHS = 5;
+    constexpr int INSTALL_BASE = CALL_PATHS;
+    constexpr int INSTALLS_PER_THREAD = 8;
+    constexpr std::size_t INSTALL_ROUNDS = 8;
+    constexpr std::array<std::size_t, 5> TABLE_SIZES{1, 10, 50, 100, 200};
+    constexpr std::size_t TABLE_RUNS = 9;
+    constexpr std::size_t TOGGLE_SAMPLES = 2001;
+    constexpr std::size_t SPEC_PATTERN_BYTES = 8;
+    constexpr std::size_t INSTALL_SPAN =
+        std::max<std::size_t>(THREAD_COUNTS.back() * std::size_t{INSTALLS_PER_THREAD}, TABLE_SIZES.back());
+    constexpr int TARGETS_NEEDED = INSTALL_BASE + static_cast<int>(INSTALL_SPAN);
+
+    using TargetFn = int (*)(int);
+    using TargetAtFn = void *(*)(int);
+    using TargetCountFn = int (*)();
+
+    // Anti-dead-code sink: every measured op feeds its thread's accumulator so the optimizer cannot delete the work
+    // being timed, and each thread folds it into s_sink once when it finishes. A shared atomic per op would itself be
+    // the contended line the multi-threaded phase is meant to rule out.
+    std::atomic<std::uint64_t> s_sink{0};
+    thread_local std::uint64_t t_sink = 0;
+
+    inline void sink(std::uint64_t v) noexcept
+    {
+        t_sink += v;
+    }
+
+    inline void flush_sink() noexcept
+    {
+        s_sink.fetch_add(t_sink, std::memory_order_relaxed);
+        t_sink = 0;
+    }
+
+    // The call-cost detours. Each path's hook is published here before any thread calls its target.
+    TargetFn g_original = nullptr;
+    Hk::Hook *g_call_hook = nullptr;
+    Hk::Hook *g_try_call_hook = nullptr;
+
+    // The pre-lock-free gate: pin a refcounted control block, then hold its recursive_mutex across the dispatch.
+    struct LegacyGate
+    {
+        std::recursive_mutex mutex;
+        void *callable{nullptr};
+    };
+
+    std::atomic<std::shared_ptr<LegacyGate>> g_legacy_gate;
+
+    int detour_original(int x)
+    {
+        return g_original(x) + 1;
+    }
+
+    int detour_call(int x)
+    {
+        return g_call_hook->call<int>(x) + 1;
+    }
+
+    int detour_try_call(int x)
+    {
+        return g_try_call_hook->try_call<int>(x).value_or(0) + 1;
+    }
+
+    int detour_legacy(int x)
+    {
+        const std::shared_ptr<LegacyGate> gate = g_legacy_gate.load(std::memory_order_acquire);
+        const std::lock_guard<std::recursive_mutex> lock(gate->mutex);
+        return reinterpret_cast<TargetFn>(gate->callable)(x) + 1;
+    }
+
+    // The install-phase detours never run: nothing calls an install-phase target.
+    int install_detour(int x)
+    {
+        return x;
+    }
+
+    void mid_detour(Hk::MidContext &ctx)
+    {
+        (void)ctx;
+    }
+
+    // A VMT seed class. value() is declared first so it is slot 0 under both the MSVC and the Itanium layout.
+    struct BenchInterface
+    {
+        virtual int value(int x) = 0;
+        virtual ~BenchInterface() = default;
+    };
+
+    struct BenchObject final : BenchInterface
+    {
+        int value(int x) override { return x; }
+    };
+
+    int vmt_detour(void *self, int x)
+    {
+        (void)self;
+        return x;
+    }
+
+    struct Fixture
+    {
+        HMODULE module = nullptr;
+        TargetAtFn target_at = nullptr;
+        int count = 0;
+
+        [[nodiscard]] void *target(int index) const { return target_at(index); }
+    };
+
+    [[nodiscard]] bool load_fixture(Fixture &out)
+    {
+        out.module = LoadLibraryA(FIXTURE_NAME);
+        if (out.module == nullptr)
+        {
+            std::fprintf(stderr, "[bench] cannot load %s (error %lu)\n", FIXTURE_NAME, GetLastError());
+            return false;
+        }
+        const auto count_fn = reinterpret_cast<TargetCountFn>(
+            reinterpret_cast<void *>(GetProcAddress(out.module, "dmk_hook_bench_target_count")));
+        out.target_at =
+            reinterpret_cast<TargetAtFn>(reinterpret_cast<void *>(GetProcAddress(out.module, "dmk_hook_bench_target")));
+        if (count_fn == nullptr || out.target_at == nullptr)
+        {
+            std::fprintf(stderr, "[bench] %s is missing the bench exports\n", FIXTURE_NAME);
+            return false;
+        }
+        out.count = count_fn();
+        if (out.count < TARGETS_NEEDED)
+        {
+            std::fprintf(stderr, "[bench] %s carries %d targets, the bench needs %d\n", FIXTURE_NAME, out.count,
+                         TARGETS_NEEDED);
+            return false;
+        }
+        return true;
+    }
+
+    [[nodiscard]] Address address_of(void *fn) noexcept
+    {
+        return Address{reinterpret_cast<std::uintptr_t>(fn)};
+    }
+
+    [[nodiscard]] double percentile(const std::vector<double> &sorted, double p)
+    {
+        if (sorted.empty())
+        {
+            return 0.0;
+        }
+        const std::size_t idx =
+            std::min(sorted.size() - 1, static_cast<std::size_t>(p * static_cast<double>(sorted.size())));
+        return sorted[idx];
+    }
+
+    // Amortized timing: run `op` `iters` times per sample, `samples` samples, return the ns-per-call of each sample.
+    // `op` takes the iteration index so the call argument varies and cannot be hoisted.
+    template <typename Op> std::vector<double> sample_ns_per_call(std::size_t iters, std::size_t samples, Op &&op)
+    {
+        int i = 0;
+        return dmk_bench::sample_ns_per_op(iters, samples, [&]() { op(i++); });
+    }
+
+    // Single-threaded median ns-per-call, recorded under `row`.
+    template <typename Op>
+    double median_ns_per_call(std::string_view row, std::size_t iters, std::size_t samples, Op &&op)
+    {
+        std::vector<double> taken = sample_ns_per_call(iters, samples, std::forward<Op>(op));
+        const double median = dmk_bench::median_of(taken);
+        dmk_bench::record(row, std::move(taken));
+        return median;
+    }
+
+    // Runs `op` on `threads` threads released together; records the per-thread ns-per-call medians under `row` and
+    // returns their median. The threads only sample; the session is touched once they have joined.
+    template <typename Op> double contended_ns_per_call(std::string_view row, unsigned threads, Op op)
+    {
+        std::atomic<bool> go{false};
+        std::vector<double> per_thread(threads, 0.0);
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            pool.emplace_back(
+                [&, t]()
+                {
+                    while (!go.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+                    per_thread[t] = dmk_bench::median_of(sample_ns_per_call(ITERS / 4, SAMPLES, op));
+                    flush_sink();
+                });
+        }
+        go.store(true, std::memory_order_release);
+        for (std::thread &worker : pool)
+        {
+            worker.join();
+        }
+        const double median = dmk_bench::median_of(per_thread);
+        dmk_bench::record(row, std::move(per_thread));
+        return median;
+    }
+
+    enum class InstallKind
+    {
+        Inline,
+        Mid,
+        Vmt,
+    };
+
+    [[nodiscard]] const char *install_kind_name(InstallKind kind) noexcept
+    {
+        switch (kind)
+        {
+        case InstallKind::Inline:
+            return "inline_at";
+        case InstallKind::Mid:
+            return "mid_at";
+        case InstallKind::Vmt:
+            return "vmt_for";
+        }
+        return "?";
+    }
+
+    // One thread's share of an install run: INSTALL_ROUNDS rounds of INSTALLS_PER_THREAD installs on its own targets
+    // (or objects), each timed alone; the round's hooks are torn down untimed before the next round. @return false
+    // on the first failed install.
+    [[nodiscard]] bool install_rounds(const Fixture &fixture, InstallKind kind, unsigned thread,
+                                      std::vector<double> &out_ns)
+    {
+        const int first = INSTALL_BASE + static_cast<int>(thread) * INSTALLS_PER_THREAD;
+        std::array<BenchObject, INSTALLS_PER_THREAD> objects{};
+        std::vector<Hk::Hook> hooks;
+        std::vector<Hk::VmtHook> vmts;
+        hooks.reserve(INSTALLS_PER_THREAD);
+        vmts.reserve(INSTALLS_PER_THREAD);
+        out_ns.reserve(INSTALL_ROUNDS * INSTALLS_PER_THREAD);
+        for (std::size_t round = 0; round < INSTALL_ROUNDS; ++round)
+        {
+            for (int i = 0; i < INSTALLS_PER_THREAD; ++i)
+            {
+                const Address target = address_of(fixture.target(first + i));
+                bool ok = false;
+                Clock::time_point start;
+                Clock::time_point end;
+                if (kind == InstallKind::Inline)
+                {
+                    Hk::InlineRequest request{.name = "bench.inline", .target = target};
+                    start = Clock::now();
+                    auto hook = Hk::inline_at(std::move(request), &install_detour);
+                    end = Clock::now();
+                    ok = hook.has_value();
+                    if (ok)
+                    {
+                        hooks.push_back(std::move(*hook));
+                    }
+                }
+                else if (kind == InstallKind::Mid)
+                {
+                    Hk::MidRequest request{.name = "bench.mid", .target = target};
+                    start = Clock::now();
+                    auto hook = Hk::mid_at(std::move(request), &mid_detour);
+                    end = Clock::now();
+                    ok = hook.has_value();
+                    if (ok)
+                    {
+                        hooks.push_back(std::move(*hook));
+                    }
+                }
+                else
+                {
+                    BenchInterface *object = &objects[static_cast<std::size_t>(i)];
+                    start = Clock::now();
+                    auto vmt = Hk::vmt_for("bench.vmt", object);
+                    ok = vmt.has_value() && vmt->hook_method(0, &vmt_detour).has_value();
+                    end = Clock::now();
+                    if (ok)
+                    {
+                        vmts.push_back(std::move(*vmt));
+                    }
+                }
+                if (!ok)
+                {
+                    return false;
+                }
+                out_ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+            }
+            hooks.clear();
+            vmts.clear();
+        }
+        return true;
+    }
+
+    struct InstallRow
+    {
+        const char *kind;
+        unsigned threads;
+        double p50_us;
+        double p99_us;
+    };
+
+    // Releases @p threads threads together into install_rounds and records every install they timed.
+    [[nodiscard]] InstallRow run_install(const Fixture &fixture, InstallKind kind, unsigned threads)
+    {
+        std::atomic<bool> go{false};
+        std::atomic<bool> failed{false};
+        std::vector<std::vector<double>> per_thread(threads);
+        std::vector<std::thread> pool;
+        pool.reserve(threads);
+        for (unsigned t = 0; t < threads; ++t)
+        {
+            pool.emplace_back(
+                [&, t]()
+                {
+                    while (!go.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+                    if (!install_rounds(fixture, kind, t, per_thread[t]))
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                });
+        }
+        go.store(true, std::memory_order_release);
+        for (std::thread &worker : pool)
+        {
+            worker.join();
+        }
+        if (failed.load(std::memory_order_relaxed))
+        {
+            std::fprintf(stderr, "[bench] %s failed on %u threads\n", install_kind_name(kind), threads);
+        }
+
+        std::vector<double> all;
+        for (const std::vector<double> &v : per_thread)
+        {
+            all.insert(all.end(), v.begin(), v.end());
+        }
+        std::sort(all.begin(), all.end());
+        const InstallRow row{install_kind_name(kind), threads, percentile(all, 0.50) / 1000.0,
+                             percentile(all, 0.99) / 1000.0};
+        dmk_bench::record(std::string("install/") + row.kind + "/" + std::to_string(threads), std::move(all));
+        return row;
+    }
+
+    // The target's first bytes as an exact AOB.
+    [[nodiscard]] std::string exact_pattern(const void *at)
+    {
+        static constexpr char HEX[] = "0123456789ABCDEF";
+        const auto *bytes = static_cast<const std::uint8_t *>(at);
+        std::string out;
+        out.reserve(SPEC_PATTERN_BYTES * 3);
+        for (std::size_t i = 0; i < SPEC_PATTERN_BYTES; ++i)
+        {
+            if (i != 0)
+            {
+                out += ' ';
+            }
+            out += HEX[bytes[i] >> 4];
+            out += HEX[bytes[i] & 0x0F];
+        }
+        return out;
+    }
+
+    // @p count inline specs over the install range, each scoped to exactly its target's first bytes.
+    [[nodiscard]] std::vector<Hk::HookSpec> hook_table(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<Hk::HookSpec> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            void *const target = fixture.target(INSTALL_BASE + static_cast<int>(i));
+            auto pattern = scan::Pattern::compile(exact_pattern(target));
+            if (!pattern.has_value())
+            {
+                return {};
+            }
+            scan::OwnedScanRequest request;
+            request.label = "bench.table." + std::to_string(i);
+            request.ladder.push_back(scan::Candidate::direct("exact", std::move(*pattern)));
+            request.scope = Region{address_of(target), SPEC_PATTERN_BYTES};
+            out.push_back(Hk::HookSpec::inline_hook(request.label, std::move(request), &install_detour));
+        }
+        return out;
+    }
+
+    struct TableRow
+    {
+        std::size_t specs;
+        double median_us;
+    };
+
+    [[nodiscard]] TableRow run_table(const Fixture &fixture, std::size_t specs)
+    {
+        const std::vector<Hk::HookSpec> table = hook_table(fixture, specs);
+        std::vector<double> ns;
+        ns.reserve(TABLE_RUNS);
+        for (std::size_t run = 0; run < TABLE_RUNS && table.size() == specs; ++run)
+        {
+            const auto start = Clock::now();
+            auto installed = Hk::install_all(table);
+            const auto end = Clock::now();
+            if (!installed.has_value())
+            {
+                std::fprintf(stderr, "[bench] install_all over %zu specs failed: %s\n", specs,
+                             installed.error().message().c_str());
+                break;
+            }
+            ns.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        const TableRow row{specs, dmk_bench::median_of(ns) / 1000.0};
+        dmk_bench::record("install_all/" + std::to_string(specs), std::move(ns));
+        return row;
+    }
+
+    struct ToggleRow
+    {
+        const char *op;
+        double median_us;
+        double p99_us;
+    };
+
+    // Alternates disable() and enable() on one inline hook, timing each call alone.
+    [[nodiscard]] std::array<ToggleRow, 2> run_toggle(const Fixture &fixture)
+    {
+        auto installed = Hk::inline_at(
+            Hk::InlineRequest{.name = "bench.toggle", .target = address_of(fixture.target(INSTALL_BASE))},
+            &install_detour);
+        if (!installed)
+        {
+            std::fprintf(stderr, "[bench] toggle install failed: %s\n", installed.error().message().c_str());
+            return {{{"disable", 0.0, 0.0}, {"enable", 0.0, 0.0}}};
+        }
+        Hk::Hook hook = std::move(*installed);
+        std::vector<double> disable_ns;
+        std::vector<double> enable_ns;
+        disable_ns.reserve(TOGGLE_SAMPLES);
+        enable_ns.reserve(TOGGLE_SAMPLES);
+        for (std::size_t s = 0; s < TOGGLE_SAMPLES; ++s)
+        {
+            const auto a = Clock::now();
+            const bool disabled = hook.disable().has_value();
+            const auto b = Clock::now();
+            const bool enabled = hook.enable().has_value();
+            const auto c = Clock::now();
+            if (!disabled || !enabled)
+            {
+                std::fprintf(stderr, "[bench] toggle failed at sample %zu\n", s);
+                break;
+            }
+            disable_ns.push_back(std::chrono::duration<double, std::nano>(b - a).count());
+            enable_ns.push_back(std::chrono::duration<double, std::nano>(c - b).count());
+        }
+        std::array<ToggleRow, 2> rows{};
+        const auto finish_row = [](const char *op, std::vector<double> ns)
+        {
+            std::vector<double> sorted = ns;
+            std::sort(sorted.begin(), sorted.end());
+            const ToggleRow row{op, percentile(sorted, 0.50) / 1000.0, percentile(sorted, 0.99) / 1000.0};
+            dmk_bench::record(std::string("toggle/") + op, std::move(ns));
+            return row;
+        };
+        rows[0] = finish_row("disable", std::move(disable_ns));
+        rows[1] = finish_row("enable", std::move(enable_ns));
+        return rows;
+    }
+
+    struct CallRow
+    {
+        const char *name;
+        double single_ns;
+        std::array<double, THREAD_COUNTS.size()> contended_ns;
+    };
+} // namespace
+
+int main(int argc, char **argv)
+{
+    dmk_bench::Session session("hook", argc, argv);
+
+    Fixture fixture;
+    if (!load_fixture(fixture))
+    {
+        return 1;
+    }
+
+    // Phase [1] hooks: one target per forwarding path; the unhooked path's target stays untouched.
+    const auto target_fn = [&fixture](int index) { return reinterpret_cast<TargetFn>(fixture.target(index)); };
+    const std::array<Hk::InlineRequest, 4> requests{{
+        {.name = "bench.original", .target = address_of(fixture.target(1))},
+        {.name = "bench.call", .target = address_of(fixture.target(2))},
+        {.name = "bench.try_call", .target = address_of(fixture.target(3))},
+        {.name = "bench.legacy_gate", .target = address_of(fixture.target(4))},
+    }};
+    const std::array<TargetFn, 4> detours{&detour_original, &detour_call, &detour_try_call, &detour_legacy};
+    std::vector<Hk::Hook> call_hooks;
+    call_hooks.reserve(requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        auto installed = Hk::inline_at(requests[i], detours[i]);
+        if (!installed)
+        {
+            std::fprintf(stderr, "[bench] inline_at(%s) failed: %s\n", requests[i].name.c_str(),
+                         installed.error().message().c_str());
+            return 1;
+        }
+        call_hooks.push_back(std::move(*installed));
+    }
+    g_original = call_hooks[0].original<TargetFn>();
+    g_call_hook = &call_hooks[1];
+    g_try_call_hook = &call_hooks[2];
+    auto legacy = std::make_shared<LegacyGate>();
+    legacy->callable = reinterpret_cast<void *>(call_hooks[3].original<TargetFn>());
+    g_legacy_gate.store(std::move(legacy), std::memory_order_release);
+
+    const std::array<const char *, CALL_PATHS> path_names{"unhooked", "original", "call", "try_call", "legacy_gate"};
+    std::vector<CallRow> rows;
+    dmk_bench::table("[1] Hooked call forwarding to the original (ns per call; threads: median per-thread ns)\n");
+    dmk_bench::table("  %-14s %10s", "path", "single");
+    for (const unsigned threads : THREAD_COUNTS)
+    {
+        dmk_bench::table(" %8uT", threads);
+    }
+    dmk_bench::table("\n");
+    for (int path = 0; path < CALL_PATHS; ++path)
+    {
+        const TargetFn fn = target_fn(path);
+        const auto op = [fn](int x) { sink(static_cast<std::uint64_t>(fn(x))); };
+        CallRow row{path_names[static_cast<std::size_t>(path)], 0.0, {}};
+        row.single_ns = median_ns_per_call(std::string("single/") + row.name, ITERS, SAMPLES, op);
+        flush_sink();
+        for (std::size_t t = 0; t < THREAD_COUNTS.size(); ++t)
+        {
+            const std::string key = std::string("contended/") + row.name + "/" + std::to_string(THREAD_COUNTS[t]);
+            row.contended_ns[t] = contended_ns_per_call(key, THREAD_COUNTS[t], op);
+        }
+        dmk_bench::table("  %-14s %10.2f", row.name, row.single_ns);
+        for (const double ns : row.contended_ns)
+        {
+            dmk_bench::table(" %9.2f", ns);
+        }
+        dmk_bench::table("\n");
+        rows.push_back(row);
+    }
+    const double top_ns = rows[2].contended_ns.back();
+    dmk_bench::table("  call at %uT: %.1f Mcalls/s aggregate, %.1fx its single-thread cost\n", THREAD_COUNTS.back(),
+                     top_ns > 0.0 ? THREAD_COUNTS.back() * 1.0e3 / top_ns : 0.0,
+                     rows[2].single_ns > 0.0 ? top_ns / rows[2].single_ns : 0.0);
+    g_call_hook = nullptr;
+    g_try_call_hook = nullptr;
+    call_hooks.clear();
+
+    dmk_bench::table("\n[2] Install latency, %zu x %d installs per thread (us per install, teardown excluded)\n",
+                     INSTALL_ROUNDS, INSTALLS_PER_THREAD);
+    dmk_bench::table("  %-10s %8s %10s %10s\n", "api", "threads", "p50", "p99");
+    std::vector<InstallRow> installs;
+    for (const InstallKind kind : {InstallKind::Inline, InstallKind::Mid, InstallKind::Vmt})
+    {
+        for (const unsigned threads : THREAD_COUNTS)
+        {
+            const InstallRow row = run_install(fixture, kind, threads);
+            dmk_bench::table("  %-10s %8u %10.2f %10.2f\n", row.kind, row.threads, row.p50_us, row.p99_us);
+            installs.push_back(row);
+        }
+    }
+
+    dmk_bench::table("\n[3] install_all, median of %zu runs (us per table, teardown excluded)\n", TABLE_RUNS);
+    dmk_bench::table("  %-10s %10s %12s\n", "specs", "median", "per_spec");
+    std::vector<TableRow> tables;
+    for (const std::size_t specs : TABLE_SIZES)
+    {
+        const TableRow row = run_table(fixture, specs);
+        dmk_bench::table("  %-10zu %10.2f %12.3f\n", row.specs, row.median_us,
+                         row.median_us / static_cast<double>(row.specs));
+        tables.push_back(row);
+    }
+
+    dmk_bench::table("\n[4] enable / disable, %zu toggles (us per call)\n", TOGGLE_SAMPLES);
+    dmk_bench::table("  %-10s %10s %10s\n", "op", "p50", "p99");
+    const std::array<ToggleRow, 2> toggles = run_toggle(fixture);
+    for (const ToggleRow &row : toggles)
+    {
+        dmk_bench::table("  %-10s %10.2f %10.2f\n", row.op, row.median_us, row.p99_us);
+    }
+
+    // TSV block for machine parsing.
+    dmk_bench::table("\n#TSV\tpath\tsingle_ns");
+    for (const unsigned threads : THREAD_COUNTS)
+    {
+        dmk_bench::table("\tcontended_%u_ns", threads);
+    }
+    dmk_bench::table("\n");
+    for (const CallRow &row : rows)
+    {
+        dmk_bench::table("#TSV\t%s\t%.2f", row.name, row.single_ns);
+        for (const double ns : row.contended_ns)
+        {
+            dmk_bench::table("\t%.2f", ns);
+        }
+        dmk_bench::table("\n");
+    }
+    dmk_bench::table("#TSV\tapi\tthreads\tp50_us\tp99_us\n");
+    for (const InstallRow &row : installs)
+    {
+        dmk_bench::table("#TSV\t%s\t%u\t%.2f\t%.2f\n", row.kind, row.threads, row.p50_us, row.p99_us);
+    }
+    dmk_bench::table("#TSV\tspecs\tinstall_all_us\n");
+    for (const TableRow &row : tables)
+    {
+        dmk_bench::table("#TSV\t%zu\t%.2f\n", row.specs, row.median_us);
+    }
+    dmk_bench::table("#TSV\ttoggle\tp50_us\tp99_us\n");
+    for (const ToggleRow &row : toggles)
+    {
+        dmk_bench::table("#TSV\t%s\t%.2f\t%.2f\n", row.op, row.median_us, row.p99_us);
+    }
+
+    flush_sink();
+    dmk_bench::table("\n(sink=%llu)\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
+    return session.finish();
+}
@@ -0,0 +1,332 @@
+/**
+ * @file bench_input.cpp
+ * @brief Standalone benchmark for the input engine: poll-cycle cost per binding count, and press latency per cadence.
+ *
+ * Both phases drive a white-box InputPoller from a recorded key timeline (internal/input_replay.hpp) through an
+ * injected key-state probe, so no physical key is pressed and the run is repeatable. The poller records its own
+ * histograms (Settings::latency_stats); the harness adds the times it applied each recorded press.
+ *
+ * Phase [1] is the cost of one binding pass, sampling through edge detection and the snapshot publish, as the binding
+ * count grows:
+ *
+ *   - compiled   keyboard bindings only, matched through the precompiled key masks
+ *   - per_code   the same set plus one gamepad-modifier binding, which sends every binding down the per-code path
+ *
+ * Phase [2] replays TAPS short taps against one binding and reports, per cadence:
+ *
+ *   - callback   the press applied to its on_press running on the poll thread
+ *   - queue      the press applied to a consumer thread draining the event queue every millisecond
+ *   - missed     taps that produced no press edge (shorter than the cadence can see)
+ *
+ * Backend::RawInput is not replayable here: the injected probe replaces the OS key source, so the raw input window is
+ * never opened. Measure it live with Settings::latency_stats, whose event_to_edge histogram covers that backend.
+ *
+ * Build with -DDMK_BUILD_BENCHMARKS=ON. Executable: DetourModKit_bench_input
+ * Output: human-readable tables plus a TSV block on stdout; --json / --compare as for every bench (bench_harness.hpp).
+ */
+
+#include "DetourModKit/input.hpp"
+
+#include "internal/input_poller.hpp"
+#include "internal/input_replay.hpp"
+
+#include "bench_harness.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <windows.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    using namespace DetourModKit;
+
+    constexpr std::array<std::size_t, 6> BINDING_COUNTS{1, 8, 32, 128, 256, 512};
+    constexpr auto CYCLE_RUN = std::chrono::milliseconds(500);
+    constexpr std::size_t TAPS = 150;
+    constexpr auto TAP_PERIOD = std::chrono::milliseconds(20);
+    constexpr auto TAP_HOLD = std::chrono::milliseconds(8);
+    constexpr int TAP_KEY = 0x87; // F24: bound by nothing a user is likely to hold.
+    constexpr int LSHIFT = 0xA0;
+    constexpr int LCONTROL = 0xA2;
+
+    std::int64_t read_qpc() noexcept
+    {
+        LARGE_INTEGER ticks;
+        QueryPerformanceCounter(&ticks);
+        return ticks.QuadPart;
+    }
+
+    double qpc_to_us(std::int64_t ticks, std::int64_t frequency)
+    {
+        return frequency > 0 ? static_cast<double>(ticks) * 1.0e6 / static_cast<double>(frequency) : 0.0;
+    }
+
+    // Upper bound of the bucket holding the p-th sample, in ticks: the histogram's resolution is a power of two.
+    std::uint64_t histogram_percentile(const input::LatencyHistogram &histogram, double p)
+    {
+        const auto target = static_cast<std::uint64_t>(p * static_cast<double>(histogram.samples));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < histogram.buckets.size(); ++i)
+        {
+            seen += histogram.buckets[i];
+            if (seen > target)
+            {
+                return i == 0 ? 0 : (std::uint64_t{1} << i) - 1;
+            }
+        }
+        return 0;
+    }
+
+    double percentile(std::vector<double> values, double p)
+    {
+        if (values.empty())
+            return 0.0;
+        std::sort(values.begin(), values.end());
+        const std::size_t idx =
+            std::min(values.size() - 1, static_cast<std::size_t>(p * static_cast<double>(values.size())));
+        return values[idx];
+    }
+
+    detail::InputBinding keyboard_binding(std::size_t i)
+    {
+        detail::InputBinding binding;
+        binding.name = "bench_" + std::to_string(i);
+        binding.keys = {keyboard_key(0x41 + static_cast<int>(i % 26))};
+        // A quarter of the set carries a modifier, so strict matching has known modifiers to reject against.
+        if (i % 4 == 1)
+            binding.modifiers = {keyboard_key(LSHIFT)};
+        else if (i % 4 == 3)
+            binding.modifiers = {keyboard_key(LCONTROL)};
+        binding.on_press = []() {};
+        return binding;
+    }
+
+    struct CycleRow
+    {
+        const char *path;
+        std::size_t bindings;
+        std::uint64_t cycles;
+        double mean_us;
+        double p50_us;
+        double p99_us;
+    };
+
+    // Runs a 1 ms poller over @p count bindings for CYCLE_RUN while a replay keeps keys moving, and reads back the
+    // poller's own cycle-cost histogram.
+    CycleRow run_cycle_cost(std::size_t count, bool per_code)
+    {
+        std::vector<detail::InputBinding> bindings;
+        bindings.reserve(count + 1);
+        for (std::size_t i = 0; i < count; ++i)
+            bindings.push_back(keyboard_binding(i));
+        if (per_code)
+        {
+            detail::InputBinding gamepad;
+            gamepad.name = "bench_gamepad";
+            gamepad.keys = {gamepad_button(GamepadCode::A)};
+            gamepad.modifiers = {gamepad_button(GamepadCode::LeftBumper)};
+            bindings.push_back(std::move(gamepad));
+        }
+
+        detail::ReplayKeyState keys;
+        detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(1), false);
+        poller.set_latency_stats(true);
+        poller.set_key_state_probe(&detail::ReplayKeyState::probe, &keys);
+        poller.start();
+
+        // Press and release a rotating key every 5 ms, with Shift held half the time.
+        std::vector<detail::ReplayEvent> recording;
+        for (std::size_t step = 0; step * 5 < static_cast<std::size_t>(CYCLE_RUN.count()); ++step)
+        {
+            const auto at = std::chrono::microseconds(step * 5000);
+            recording.push_back({at, 0x41 + static_cast<int>(step % 26), step % 2 == 0});
+            recording.push_back({at, LSHIFT, step % 4 < 2});
+        }
+        detail::play(recording, keys, Clock::now(), [](std::size_t, const detail::ReplayEvent &) {});
+        poller.shutdown();
+
+        const input::InputLatencyStats stats = poller.latency_stats();
+        const input::LatencyHistogram &cost = stats.cycle_cost;
+        CycleRow row{per_code ? "per_code" : "compiled", count, cost.samples, 0.0, 0.0, 0.0};
+        if (cost.samples > 0)
+        {
+            row.mean_us = qpc_to_us(static_cast<std::int64_t>(cost.total_ticks / cost.samples), stats.ticks_per_second);
+            row.p50_us = qpc_to_us(static_cast<std::int64_t>(histogram_percentile(cost, 0.50)), stats.ticks_per_second);
+            row.p99_us = qpc_to_us(static_cast<std::int64_t>(histogram_percentile(cost, 0.99)), stats.ticks_per_second);
+        }
+        return row;
+    }
+
+    struct Cadence
+    {
+        const char *name;
+        std::chrono::milliseconds poll_interval;
+        std::chrono::milliseconds idle_interval;
+    };
+
+    constexpr std::array<Cadence, 4> CADENCES{{
+        {"poll_1ms", std::chrono::milliseconds(1), std::chrono::milliseconds(0)},
+        {"poll_4ms", std::chrono::milliseconds(4), std::chrono::milliseconds(0)},
+        {"poll_16ms", std::chrono::milliseconds(16), std::chrono::milliseconds(0)},
+        {"adaptive_4_50ms", std::chrono::milliseconds(4), std::chrono::milliseconds(50)},
+    }};
+
+    struct LatencyRow
+    {
+        const char *cadence;
+        double callback_p50_us;
+        double callback_p99_us;
+        double queue_p50_us;
+        double queue_p99_us;
+        std::size_t missed;
+    };
+
+    // Replays TAPS taps against one binding under @p cadence and pairs each press edge with the tap that caused it.
+    LatencyRow run_latency(const Cadence &cadence)
+    {
+        std::array<std::int64_t, TAPS> applied{};
+        std::array<std::int64_t, TAPS> dispatched{};
+        std::atomic<std::size_t> presses{0};
+
+        std::vector<detail::InputBinding> bindings;
+        detail::InputBinding binding;
+        binding.name = "bench_tap";
+        binding.keys = {keyboard_key(TAP_KEY)};
+        binding.on_press = [&]()
+        {
+            const std::size_t n = presses.fetch_add(1, std::memory_order_relaxed);
+            if (n < TAPS)
+                dispatched[n] = read_qpc();
+        };
+        bindings.push_back(std::move(binding));
+
+        detail::ReplayKeyState keys;
+        detail::InputPoller poller(std::move(bindings), cadence.poll_interval, false);
+        if (cadence.idle_interval.count() > 0)
+            poller.set_adaptive_polling(cadence.idle_interval, input::DEFAULT_ADAPTIVE_QUIET_TIMEOUT);
+        (void)poller.set_event_queue(256);
+        poller.set_key_state_probe(&detail::ReplayKeyState::probe, &keys);
+        poller.start();
+
+        // The consumer drains once a millisecond, as a frame loop would far more coarsely.
+        std::vector<std::int64_t> drained;
+        drained.reserve(TAPS);
+        std::atomic<bool> stop{false};
+        std::thread consumer(
+            [&]()
+            {
+                std::array<input::InputEvent, 16> out{};
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const std::size_t n = poller.drain_events(out);
+                    const std::int64_t now = read_qpc();
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        if (out[i].edge == input::InputEdge::Press)
+                            drained.push_back(now);
+                    }
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+
+        std::vector<detail::ReplayEvent> recording;
+        recording.reserve(TAPS * 2);
+        for (std::size_t i = 0; i < TAPS; ++i)
+        {
+            const auto down = std::chrono::duration_cast<std::chrono::microseconds>(TAP_PERIOD * i);
+            recording.push_back({down, TAP_KEY, true});
+            recording.push_back({down + TAP_HOLD, TAP_KEY, false});
+        }
+        detail::play(recording, keys, Clock::now(),
+                     [&](std::size_t index, const detail::ReplayEvent &event)
+                     {
+                         if (event.down)
+                             applied[index / 2] = read_qpc();
+                     });
+        std::this_thread::sleep_for(TAP_PERIOD);
+        poller.shutdown();
+        stop.store(true, std::memory_order_relaxed);
+        consumer.join();
+
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        const std::size_t seen = std::min(presses.load(), TAPS);
+        std::vector<double> callback;
+        std::vector<double> queue;
+        // A missed tap shifts every later pairing, so latencies are only paired while nothing was missed.
+        if (seen == TAPS)
+        {
+            for (std::size_t i = 0; i < TAPS; ++i)
+                callback.push_back(qpc_to_us(dispatched[i] - applied[i], frequency.QuadPart));
+            for (std::size_t i = 0; i < std::min(drained.size(), TAPS); ++i)
+                queue.push_back(qpc_to_us(drained[i] - applied[i], frequency.QuadPart));
+        }
+        return LatencyRow{cadence.name,           percentile(callback, 0.50), percentile(callback, 0.99),
+                          percentile(queue, 0.50), percentile(queue, 0.99),    TAPS - seen};
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    dmk_bench::Session session("input", argc, argv);
+
+    dmk_bench::table("[1] Binding pass cost, 1 ms cadence, %lld ms per run (us per cycle)\n",
+                     static_cast<long long>(CYCLE_RUN.count()));
+    dmk_bench::table("  %-9s %9s %9s %10s %10s %10s\n", "path", "bindings", "cycles", "mean", "p50<=", "p99<=");
+    std::vector<CycleRow> cycles;
+    for (const bool per_code : {false, true})
+    {
+        for (const std::size_t count : BINDING_COUNTS)
+        {
+            const CycleRow row = run_cycle_cost(count, per_code);
+            dmk_bench::table("  %-9s %9zu %9llu %10.2f %10.2f %10.2f\n", row.path, row.bindings,
+                             static_cast<unsigned long long>(row.cycles), row.mean_us, row.p50_us, row.p99_us);
+            const std::string key = std::string("cycle/") + row.path + "/" + std::to_string(row.bindings);
+            dmk_bench::record_value(key + "/mean", row.mean_us * 1000.0);
+            dmk_bench::record_value(key + "/p99", row.p99_us * 1000.0);
+            cycles.push_back(row);
+        }
+    }
+
+    dmk_bench::table("\n[2] Press latency, %zu taps of %lld ms every %lld ms (us from the press applied)\n", TAPS,
+                     static_cast<long long>(TAP_HOLD.count()), static_cast<long long>(TAP_PERIOD.count()));
+    dmk_bench::table("  %-16s %12s %12s %12s %12s %8s\n", "cadence", "callback_p50", "callback_p99", "queue_p50",
+                     "queue_p99", "missed");
+    std::vector<LatencyRow> latencies;
+    for (const Cadence &cadence : CADENCES)
+    {
+        const LatencyRow row = run_latency(cadence);
+        dmk_bench::table("  %-16s %12.1f %12.1f %12.1f %12.1f %8zu\n", row.cadence, row.callback_p50_us,
+                         row.callback_p99_us, row.queue_p50_us, row.queue_p99_us, row.missed);
+        const std::string key = std::string("latency/") + row.cadence;
+        dmk_bench::record_value(key + "/callback_p50", row.callback_p50_us * 1000.0);
+        dmk_bench::record_value(key + "/queue_p50", row.queue_p50_us * 1000.0);
+        latencies.push_back(row);
+    }
+    dmk_bench::table("  RawInput: not replayable through the injected probe; see Settings::latency_stats.\n");
+
+    // TSV block for machine parsing.
+    dmk_bench::table("\n#TSV\tpath\tbindings\tcycles\tmean_us\tp50_us\tp99_us\n");
+    for (const CycleRow &row : cycles)
+    {
+        dmk_bench::table("#TSV\t%s\t%zu\t%llu\t%.2f\t%.2f\t%.2f\n", row.path, row.bindings,
+                         static_cast<unsigned long long>(row.cycles), row.mean_us, row.p50_us, row.p99_us);
+    }
+    dmk_bench::table("#TSV\tcadence\tcallback_p50_us\tcallback_p99_us\tqueue_p50_us\tqueue_p99_us\tmissed\n");
+    for (const LatencyRow &row : latencies)
+    {
+        dmk_bench::table("#TSV\t%s\t%.1f\t%.1f\t%.1f\t%.1f\t%zu\n", row.cadence, row.callback_p50_us,
+                         row.callback_p99_us, row.queue_p50_us, row.queue_p99_us, row.missed);
+    }
+    return session.finish();
+}
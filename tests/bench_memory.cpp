@@ -10,7 +10,7 @@
  *   - is_readable / is_writable  COLD MISS  (cache off -> direct VirtualQuery)
  *   - raw VirtualQuery                       (the syscall a cache miss pays)
  *   - unchecked::read<uint64_t>              (raw inline read, no guard, no syscall)
- *   - read<uint64_t> (guarded)               (fault-guarded read)
+ *   - read<uint64_t> (guarded)               (fault-guarded read, and its ratio to unchecked::read)
  *   - walk / walk + read<uint64_t>           (one fault guard for a whole chain)
  *   - direct volatile load / store           (floor)
  *   - write_bytes (8 bytes)                  (VirtualProtect x2 + Flush + invalidate)
@@ -30,15 +30,28 @@
  *       the read count and the miss rate, which a single average-per-call number does not capture.
  *   (G) [Phase 8] Pointer-chain primitives: a GATED per-link walk (is_readable
  *       before each dereference) vs walk / walk + read<uint64_t> (one fault guard for the whole walk).
+ *   (H) [Phase 10] Module-scope page walk: the raw VirtualQuery walk of the host image (what page discovery used to
+ *       cost per scan) vs a full scan::scan over Region::host(), before and after splitting a .bss buffer into
+ *       hundreds of alternating read-only / read-write regions. The scan walks the image by its PE section table, so
+ *       its cost should stay flat while the raw walk grows with the region count.
+ *   (I) [Phase 11] Entity-list sweep: 16k pointers scattered over four heap regions, validated one is_readable call
+ *       at a time vs one is_readable_batch call. The batch resolves each region once and answers the rest with range
+ *       compares, so its per-pointer cost should sit well below even a warm per-call hit.
+ *   (J) [Phase 12] Field sweep: 30 qword fields off each of 2000 actors, one read_into per field vs one read_many
+ *       call for the whole frame. The gap is the per-call guard entry read_many pays once.
  *
  * Build with -DDMK_BUILD_BENCHMARKS=ON. Executable: DetourModKit_bench_memory
- * Output: human-readable tables plus a TSV block on stdout.
+ * Output: human-readable tables plus a TSV block on stdout; --json, --compare and the other flags of bench_harness.hpp
+ * apply.
  */
 
 #include "DetourModKit/address.hpp"
 #include "DetourModKit/memory.hpp"
 #include "DetourModKit/region.hpp"
 #include "DetourModKit/logger.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "bench_harness.hpp"
 
 #include <windows.h>
 
@@ -52,7 +65,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <span>
+#include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 namespace
@@ -85,26 +100,12 @@ namespace
         s_sink.fetch_add(v, std::memory_order_relaxed);
     }
 
-    // Amortized timing: run `op` `iters` times per sample, `samples` samples, return the median ns-per-call. Matches
-    // the bench_scanner.cpp idiom but reports nanoseconds because these ops are sub-microsecond.
-    template <typename Op> double median_ns_per_call(std::size_t iters, std::size_t samples, Op &&op)
+    // Amortized timing: run `op` `iters` times per sample, `samples` samples, record them under `row` and return the
+    // median ns-per-call. Reports nanoseconds because these ops are sub-microsecond.
+    template <typename Op>
+    double median_ns_per_call(const std::string &row, std::size_t iters, std::size_t samples, Op &&op)
     {
-        std::vector<double> per_call;
-        per_call.reserve(samples);
-        for (std::size_t s = 0; s < samples; ++s)
-        {
-            const auto start = Clock::now();
-            for (std::size_t i = 0; i < iters; ++i)
-            {
-                op();
-            }
-            const auto end = Clock::now();
-            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-            per_call.push_back(static_cast<double>(ns) / static_cast<double>(iters));
-        }
-        std::sort(per_call.begin(), per_call.end());
-        const std::size_t n = per_call.size();
-        return (n % 2 == 0) ? (per_call[n / 2 - 1] + per_call[n / 2]) / 2.0 : per_call[n / 2];
+        return dmk_bench::median_ns_per_op(row, iters, samples, std::forward<Op>(op));
     }
 
     struct Row
@@ -118,7 +119,7 @@ namespace
     {
         g_rows.push_back({name, ns});
         const double per_sec = ns > 0.0 ? 1.0e9 / ns : 0.0;
-        std::printf("  %-26s %10.2f ns/call   %14.0f calls/s\n", name, ns, per_sec);
+        dmk_bench::table("  %-26s %10.2f ns/call   %14.0f calls/s\n", name, ns, per_sec);
     }
 
     // Allocate a single committed, readable+writable page to stand in for a "stable" game pose buffer. Seed it with a
@@ -147,6 +148,24 @@ namespace
             (void)VirtualAlloc(nullptr, 4096, MEM_RESERVE, PAGE_NOACCESS);
         }
     }
+
+    // Zero-initialized, so it lives in the image's .bss without adding to the file; Phase 10 reprotects alternate
+    // pages of it to split one section into many VirtualQuery regions of the same protection class.
+    constexpr std::size_t FRAGMENT_PAGES = 256;
+    alignas(4096) std::uint8_t g_fragment_pages[FRAGMENT_PAGES * 4096];
+
+    // The raw page-map walk over [lo, hi): the region count and, through the sink, the work a per-region walk does.
+    std::size_t walk_regions(std::uintptr_t lo, std::uintptr_t hi)
+    {
+        std::size_t regions = 0;
+        MEMORY_BASIC_INFORMATION mbi{};
+        for (std::uintptr_t addr = lo; addr < hi && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi));
+             addr = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress) + mbi.RegionSize)
+        {
+            ++regions;
+        }
+        return regions;
+    }
 } // namespace
 
 // (E) Contention study: p50/p99 latency of is_readable under N threads forcing cache misses. Each thread round-robins
@@ -367,8 +386,9 @@ namespace
     }
 } // namespace
 
-int main()
+int main(int argc, char **argv)
 {
+    dmk_bench::Session session("memory", argc, argv);
     // Silence write_bytes' success/debug logging so we time the memory work, not the log path. The level gate is an
     // atomic check before any string formatting, so Error-level leaves the hot ops uninstrumented.
     DetourModKit::log().set_log_level(DetourModKit::LogLevel::Error);
@@ -382,28 +402,30 @@ int main()
     std::byte src[8];
     std::memcpy(src, page, 8);
 
-    std::printf("DetourModKit Memory microbenchmark (toolchain: %s)\n",
+    dmk_bench::table("DetourModKit Memory microbenchmark (toolchain: %s)\n",
 #ifdef _MSC_VER
-                "MSVC (seh_* use __try/__except)"
+                     "MSVC (seh_* use __try/__except)"
 #else
-                "non-MSVC (seh_* use the vectored-handler fault guard)"
+                     "non-MSVC (seh_* use the vectored-handler fault guard)"
 #endif
     );
-    std::printf("DEFAULT_CACHE_EXPIRY_MS = %u\n\n", static_cast<unsigned>(Mem::DEFAULT_CACHE_EXPIRY_MS));
+    dmk_bench::table("DEFAULT_CACHE_EXPIRY_MS = %u\n\n", static_cast<unsigned>(Mem::DEFAULT_CACHE_EXPIRY_MS));
 
     // Phase 1: cache OFF -> validators take the direct-VirtualQuery branch.
     Mem::shutdown_cache(); // ensure uninitialized
-    std::printf("[1] Validation MISS / uncached (cache off -> VirtualQuery branch)\n");
-    const double ns_qry = median_ns_per_call(ITERS, SAMPLES,
+    dmk_bench::table("[1] Validation MISS / uncached (cache off -> VirtualQuery branch)\n");
+    const double ns_qry = median_ns_per_call("raw_virtual_query", ITERS, SAMPLES,
                                              [&]()
                                              {
                                                  MEMORY_BASIC_INFORMATION mbi;
                                                  sink(VirtualQuery(page, &mbi, sizeof(mbi)));
                                              });
     report("raw VirtualQuery", ns_qry);
-    const double ns_isr_miss = median_ns_per_call(ITERS, SAMPLES, [&]() { sink(is_readable(page, 8) ? 1u : 0u); });
+    const double ns_isr_miss =
+        median_ns_per_call("is_readable_miss", ITERS, SAMPLES, [&]() { sink(is_readable(page, 8) ? 1u : 0u); });
     report("is_readable MISS", ns_isr_miss);
-    const double ns_isw_miss = median_ns_per_call(ITERS, SAMPLES, [&]() { sink(is_writable(page, 8) ? 1u : 0u); });
+    const double ns_isw_miss =
+        median_ns_per_call("is_writable_miss", ITERS, SAMPLES, [&]() { sink(is_writable(page, 8) ? 1u : 0u); });
     report("is_writable MISS", ns_isw_miss);
 
     // Phase 2: cache ON, warm -> validators hit the fresh entry.
@@ -414,39 +436,45 @@ int main()
     }
     sink(is_readable(page, 8) ? 1u : 0u); // warm the entry
     sink(is_writable(page, 8) ? 1u : 0u);
-    std::printf("\n[2] Validation WARM HIT (cache on, entry fresh within TTL)\n");
-    const double ns_isr_hit = median_ns_per_call(ITERS, SAMPLES, [&]() { sink(is_readable(page, 8) ? 1u : 0u); });
+    dmk_bench::table("\n[2] Validation WARM HIT (cache on, entry fresh within TTL)\n");
+    const double ns_isr_hit =
+        median_ns_per_call("is_readable_hit", ITERS, SAMPLES, [&]() { sink(is_readable(page, 8) ? 1u : 0u); });
     report("is_readable HIT", ns_isr_hit);
-    const double ns_isw_hit = median_ns_per_call(ITERS, SAMPLES, [&]() { sink(is_writable(page, 8) ? 1u : 0u); });
+    const double ns_isw_hit =
+        median_ns_per_call("is_writable_hit", ITERS, SAMPLES, [&]() { sink(is_writable(page, 8) ? 1u : 0u); });
     report("is_writable HIT", ns_isw_hit);
 
     // Phase 3: direct access primitives (no cache dependence).
-    std::printf("\n[3] Direct access primitives\n");
+    dmk_bench::table("\n[3] Direct access primitives\n");
     const double ns_dread =
-        median_ns_per_call(ITERS, SAMPLES, [&]() { sink(*reinterpret_cast<volatile std::uint64_t *>(page)); });
+        median_ns_per_call("direct_volatile_load", ITERS, SAMPLES,
+                           [&]() { sink(*reinterpret_cast<volatile std::uint64_t *>(page)); });
     report("direct volatile load", ns_dread);
     const double ns_unchecked =
-        median_ns_per_call(ITERS, SAMPLES, [&]() { sink(Mem::unchecked::read<std::uint64_t>(Address{addr})); });
+        median_ns_per_call("unchecked_read_u64", ITERS, SAMPLES,
+                           [&]() { sink(Mem::unchecked::read<std::uint64_t>(Address{addr})); });
     report("unchecked::read<u64>", ns_unchecked);
-    const double ns_sehread = median_ns_per_call(ITERS, SAMPLES,
+    const double ns_sehread = median_ns_per_call("guarded_read_u64", ITERS, SAMPLES,
                                                  [&]()
                                                  {
                                                      auto v = Mem::read<std::uint64_t>(Address{addr});
                                                      sink(v ? *v : 0u);
                                                  });
     report("read<u64> (guarded)", ns_sehread);
+    dmk_bench::table("  guarded/unchecked ratio: %.1fx\n", ns_unchecked > 0 ? ns_sehread / ns_unchecked : 0.0);
     const double ns_dstore = median_ns_per_call(
-        ITERS, SAMPLES,
+        "direct_volatile_store", ITERS, SAMPLES,
         [&]() { *reinterpret_cast<volatile std::uint64_t *>(page) = s_sink.load(std::memory_order_relaxed); });
     report("direct volatile store", ns_dstore);
     const double ns_wbytes = median_ns_per_call(
-        WRITE_ITERS, SAMPLES, [&]() { (void)Mem::write_bytes(Address{page}, std::span<const std::byte>{src, 8}); });
+        "write_bytes_8", WRITE_ITERS, SAMPLES,
+        [&]() { (void)Mem::write_bytes(Address{page}, std::span<const std::byte>{src, 8}); });
     report("write_bytes(8)", ns_wbytes);
 
-    std::printf("\n  cache stats: %s\n", Mem::get_cache_stats().c_str());
+    dmk_bench::table("\n  cache stats: %s\n", Mem::get_cache_stats().c_str());
 
     // Phase 4: VirtualQuery cost vs VAD-tree size.
-    std::printf("\n[4] raw VirtualQuery vs VAD-tree size (single fixed address)\n");
+    dmk_bench::table("\n[4] raw VirtualQuery vs VAD-tree size (single fixed address)\n");
     const std::size_t vad_steps[] = {0, 1000, 4000, 12000};
     std::size_t grown = 0;
     for (std::size_t target : vad_steps)
@@ -456,24 +484,27 @@ int main()
             grow_vad(target - grown);
             grown = target;
         }
-        const double ns = median_ns_per_call(ITERS, SAMPLES,
+        const double ns = median_ns_per_call("virtual_query_vad_" + std::to_string(grown), ITERS, SAMPLES,
                                              [&]()
                                              {
                                                  MEMORY_BASIC_INFORMATION mbi;
                                                  sink(VirtualQuery(page, &mbi, sizeof(mbi)));
                                              });
-        std::printf("  +%6zu reserved regions   %10.2f ns/call\n", grown, ns);
+        dmk_bench::table("  +%6zu reserved regions   %10.2f ns/call\n", grown, ns);
     }
 
     // Phase 5: contention p50/p99 (the jitter mechanism).
-    std::printf("\n[5] is_readable latency under contention (mostly-miss workload)\n");
+    dmk_bench::table("\n[5] is_readable latency under contention (mostly-miss workload)\n");
     auto pool = make_churn_pool(4096); // 4096 addrs vs 256-entry cache => ~mostly miss
-    std::printf("  churn pool: %zu committed pages\n", pool.size());
+    dmk_bench::table("  churn pool: %zu committed pages\n", pool.size());
     for (unsigned threads : {1u, 2u, 4u})
     {
         auto r = run_contention(pool, threads, 50000);
-        std::printf("  %u thread(s):  p50 %8.0f ns   p99 %9.0f ns   max %10.0f ns\n", threads, r.p50_ns, r.p99_ns,
-                    r.max_ns);
+        dmk_bench::table("  %u thread(s):  p50 %8.0f ns   p99 %9.0f ns   max %10.0f ns\n", threads, r.p50_ns, r.p99_ns,
+                         r.max_ns);
+        const std::string prefix = "contention_" + std::to_string(threads) + "_threads";
+        dmk_bench::record_value(prefix + "_p50", r.p50_ns);
+        dmk_bench::record_value(prefix + "_p99", r.p99_ns);
     }
 
     // Phase 6: REALISTIC probe cost + tail. A probe = K dependent reads across a few distinct objects. GATED =
@@ -483,39 +514,41 @@ int main()
     constexpr std::size_t K_READS = 8;       // fields per probe (~5-8 typical)
     constexpr std::size_t READS_PER_OBJ = 3; // ~3 distinct objects per probe
     constexpr std::size_t PROBES = 30000;
-    std::printf("\n[6] Per-probe cost: %zu reads across ~%zu distinct (cache-missing) objects\n", K_READS,
-                (K_READS + READS_PER_OBJ - 1) / READS_PER_OBJ);
+    dmk_bench::table("\n[6] Per-probe cost: %zu reads across ~%zu distinct (cache-missing) objects\n", K_READS,
+                     (K_READS + READS_PER_OBJ - 1) / READS_PER_OBJ);
     const ProbeStats gated = run_probe(pool, PROBES, K_READS, READS_PER_OBJ, true);
     const ProbeStats direct = run_probe(pool, PROBES, K_READS, READS_PER_OBJ, false);
-    std::printf("  GATED  (is_readable+read): p50 %7.0f  p99 %8.0f  max %9.0f  mean %7.0f ns/probe\n", gated.p50,
-                gated.p99, gated.max, gated.mean);
-    std::printf("  DIRECT (raw read)        : p50 %7.0f  p99 %8.0f  max %9.0f  mean %7.0f ns/probe\n", direct.p50,
-                direct.p99, direct.max, direct.mean);
-    std::printf("  gated/direct mean ratio  : %.1fx   (added by the per-read gate: %.0f ns/probe)\n",
-                direct.mean > 0 ? gated.mean / direct.mean : 0.0, gated.mean - direct.mean);
-    std::printf("  cache stats after probes : %s\n", Mem::get_cache_stats().c_str());
+    dmk_bench::table("  GATED  (is_readable+read): p50 %7.0f  p99 %8.0f  max %9.0f  mean %7.0f ns/probe\n", gated.p50,
+                     gated.p99, gated.max, gated.mean);
+    dmk_bench::table("  DIRECT (raw read)        : p50 %7.0f  p99 %8.0f  max %9.0f  mean %7.0f ns/probe\n", direct.p50,
+                     direct.p99, direct.max, direct.mean);
+    dmk_bench::record_value("probe_gated_mean", gated.mean);
+    dmk_bench::record_value("probe_direct_mean", direct.mean);
+    dmk_bench::table("  gated/direct mean ratio  : %.1fx   (added by the per-read gate: %.0f ns/probe)\n",
+                     direct.mean > 0 ? gated.mean / direct.mean : 0.0, gated.mean - direct.mean);
+    dmk_bench::table("  cache stats after probes : %s\n", Mem::get_cache_stats().c_str());
 
     // Phase 7: per-frame budget. A per-bind / apply hook fires P probes in a frame (one per material instance /
     // bound object touched). Show what fraction of a 16.67 ms (60 FPS) frame the GATED vs DIRECT path consumes. This is
     // the model that matters: cost scales with PROBES-PER-FRAME, which for an apply path touching many bound objects is
     // large -- not "2/frame".
-    std::printf("\n[7] Per-frame budget (16.67 ms frame): cost = probes/frame x ns/probe\n");
-    std::printf("  %-12s %13s %9s %13s %9s\n", "probes/fr", "gated ms/fr", "%frame", "direct ms/fr", "%frame");
+    dmk_bench::table("\n[7] Per-frame budget (16.67 ms frame): cost = probes/frame x ns/probe\n");
+    dmk_bench::table("  %-12s %13s %9s %13s %9s\n", "probes/fr", "gated ms/fr", "%frame", "direct ms/fr", "%frame");
     for (std::size_t P : {1u, 8u, 64u, 256u, 1024u})
     {
         const double g_ms = static_cast<double>(P) * gated.mean / 1.0e6;
         const double d_ms = static_cast<double>(P) * direct.mean / 1.0e6;
-        std::printf("  %-12zu %13.4f %8.2f%% %13.4f %8.2f%%\n", P, g_ms, 100.0 * g_ms / 16.667, d_ms,
-                    100.0 * d_ms / 16.667);
+        dmk_bench::table("  %-12zu %13.4f %8.2f%% %13.4f %8.2f%%\n", P, g_ms, 100.0 * g_ms / 16.667, d_ms,
+                         100.0 * d_ms / 16.667);
     }
-    std::printf("  (worst single GATED probe this run: %.0f ns = %.4f ms -> a one-probe frame\n"
-                "   can spike %.2f%% of budget from the tail alone)\n",
-                gated.max, gated.max / 1.0e6, 100.0 * (gated.max / 1.0e6) / 16.667);
+    dmk_bench::table("  (worst single GATED probe this run: %.0f ns = %.4f ms -> a one-probe frame\n"
+                     "   can spike %.2f%% of budget from the tail alone)\n",
+                     gated.max, gated.max / 1.0e6, 100.0 * (gated.max / 1.0e6) / 16.667);
 
     // Contrast: the light case is a handful of validations per frame on a few
     // stable (cached) addresses. With warm hits that is sub-microsecond per frame, which is why a low-frequency
     // validated path is imperceptible while the high-frequency probe path above is not.
-    std::printf("  contrast (2 warm validations/frame): %.4f ms/frame\n", (ns_isr_hit + ns_isw_hit) / 1.0e6);
+    dmk_bench::table("  contrast (2 warm validations/frame): %.4f ms/frame\n", (ns_isr_hit + ns_isw_hit) / 1.0e6);
 
     // Phase 8: pointer-chain primitives. Walk a stable in-process chain (warm cache, the favorable case for the
     // gated walk) three ways: a GATED per-link walk that calls is_readable before each dereference, vs walk (resolve
@@ -530,9 +563,9 @@ int main()
     std::array<std::ptrdiff_t, CHAIN_CELLS> chain_offsets{}; // all zero
     const std::span<const std::ptrdiff_t> chain_span{chain_offsets};
 
-    std::printf("\n[8] Pointer chain (%zu links, warm cache)\n", CHAIN_CELLS);
+    dmk_bench::table("\n[8] Pointer chain (%zu links, warm cache)\n", CHAIN_CELLS);
     const double ns_gated_walk =
-        median_ns_per_call(ITERS, SAMPLES,
+        median_ns_per_call("gated_link_walk", ITERS, SAMPLES,
                            [&]()
                            {
                                std::uintptr_t cur = chain_base;
@@ -552,14 +585,14 @@ int main()
                                sink(v);
                            });
     report("gated link walk", ns_gated_walk);
-    const double ns_resolve_chain = median_ns_per_call(ITERS, SAMPLES,
+    const double ns_resolve_chain = median_ns_per_call("walk_chain", ITERS, SAMPLES,
                                                        [&]()
                                                        {
                                                            const auto a = Mem::walk(Address{chain_base}, chain_span);
                                                            sink(a ? a->raw() : 0u);
                                                        });
     report("walk (resolve chain)", ns_resolve_chain);
-    const double ns_read_chain = median_ns_per_call(ITERS, SAMPLES,
+    const double ns_read_chain = median_ns_per_call("walk_read_u64", ITERS, SAMPLES,
                                                     [&]()
                                                     {
                                                         // walk resolves the leaf address under one fault guard; the
@@ -575,7 +608,7 @@ int main()
                                                         sink(v);
                                                     });
     report("walk + read<u64>", ns_read_chain);
-    std::printf("  gated/(walk+read) ratio: %.1fx\n", ns_read_chain > 0 ? ns_gated_walk / ns_read_chain : 0.0);
+    dmk_bench::table("  gated/(walk+read) ratio: %.1fx\n", ns_read_chain > 0 ? ns_gated_walk / ns_read_chain : 0.0);
 
     // Phase 9: warm-HIT is_readable throughput under contention. The cache stays on and a small pre-warmed pool
     // keeps almost every lookup a hit, so this isolates the cross-thread cost of the reader-tracking counter and the
@@ -589,26 +622,187 @@ int main()
         for (void *p : warm_pool)
             sink(is_readable(p, 8) ? 1u : 0u); // pre-warm every entry into the cache
 
-        std::printf("\n[9] is_readable warm-HIT throughput under contention (Mops/s, higher is better)\n");
+        dmk_bench::table("\n[9] is_readable warm-HIT throughput under contention (Mops/s, higher is better)\n");
         for (const unsigned threads : {1u, 2u, 4u, 8u})
         {
             const double mops = run_warm_contention(warm_pool, threads, WARM_OPS);
-            std::printf("  %u thread(s): %10.2f Mops/s\n", threads, mops);
-            std::printf("#TSV\twarm_hit_mops_%u_threads\t%.2f\n", threads, mops);
+            dmk_bench::table("  %u thread(s): %10.2f Mops/s\n", threads, mops);
+            dmk_bench::table("#TSV\twarm_hit_mops_%u_threads\t%.2f\n", threads, mops);
+        }
+    }
+
+    // Phase 10: module-scope page walk. A scan over Region::host() used to discover its pages with one VirtualQuery
+    // per region; it now reads the section table once and queries each section's first page. Splitting a .bss buffer
+    // into alternating read-only / read-write pages multiplies the regions without changing any page's class, so
+    // the raw walk grows while the scan's page discovery does not.
+    {
+        constexpr std::size_t SCAN_ITERS = 20;
+        constexpr std::size_t SCAN_SAMPLES = 7;
+        const Region host = Region::host();
+        const std::uintptr_t host_lo = host.base.raw();
+        const std::uintptr_t host_hi = host_lo + host.size;
+        // Absent from the image: every scan sweeps the whole scope and pays its full page walk.
+        const auto absent = DetourModKit::scan::Pattern::compile("C3 5A 17 E9 0B 61 F4 88 2D 9E 70 13 CA 4B 66 D1");
+        if (!absent)
+        {
+            std::fprintf(stderr, "[bench] pattern compile failed\n");
+            return 1;
+        }
+        std::memset(g_fragment_pages, 0x5A, sizeof(g_fragment_pages));
+
+        dmk_bench::table("\n[10] Module-scope page walk over Region::host() (%zu KiB)\n", host.size / 1024);
+        const auto run_phase = [&](const char *label)
+        {
+            const std::size_t regions = walk_regions(host_lo, host_hi);
+            const double walk_ns =
+                median_ns_per_call(std::string("module_walk_") + label + "_raw", SCAN_ITERS, SCAN_SAMPLES,
+                                   [&]() { sink(walk_regions(host_lo, host_hi)); });
+            const double scan_ns = median_ns_per_call(
+                std::string("module_walk_") + label + "_scan", SCAN_ITERS, SCAN_SAMPLES,
+                [&]() { sink(DetourModKit::scan::scan(*absent, host).has_value() ? 1u : 0u); });
+            dmk_bench::table("  %-12s %5zu regions   raw VirtualQuery walk %10.0f ns   scan::scan %12.0f ns\n", label,
+                             regions, walk_ns, scan_ns);
+            dmk_bench::table("#TSV\tmodule_walk_%s_regions\t%zu\n", label, regions);
+            dmk_bench::table("#TSV\tmodule_walk_%s_raw_ns\t%.2f\n", label, walk_ns);
+            dmk_bench::table("#TSV\tmodule_walk_%s_scan_ns\t%.2f\n", label, scan_ns);
+        };
+        run_phase("contiguous");
+        DWORD old_protect = 0;
+        for (std::size_t page = 1; page < FRAGMENT_PAGES; page += 2)
+        {
+            (void)VirtualProtect(g_fragment_pages + page * 4096, 4096, PAGE_READONLY, &old_protect);
         }
+        run_phase("fragmented");
+        for (std::size_t page = 1; page < FRAGMENT_PAGES; page += 2)
+        {
+            (void)VirtualProtect(g_fragment_pages + page * 4096, 4096, PAGE_READWRITE, &old_protect);
+        }
+    }
+
+    // Phase 11: entity-list sweep. Pointers into a handful of heap regions, in a scattered order, validated per call
+    // and then as one batch. The cache is warm for both, so the gap is the per-call guard, clock read, and lookup the
+    // batch amortizes over each region.
+    {
+        constexpr std::size_t SWEEP_REGIONS = 4;
+        constexpr std::size_t SWEEP_REGION_BYTES = std::size_t{1} << 20;
+        constexpr std::size_t SWEEP_POINTERS = 16384;
+        constexpr std::size_t SWEEP_ITERS = 50;
+        constexpr std::size_t SWEEP_SAMPLES = 9;
+        std::array<std::uint8_t *, SWEEP_REGIONS> heaps{};
+        for (std::uint8_t *&heap : heaps)
+        {
+            heap = static_cast<std::uint8_t *>(
+                VirtualAlloc(nullptr, SWEEP_REGION_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+            if (!heap)
+            {
+                std::fprintf(stderr, "[bench] VirtualAlloc failed: %lu\n", GetLastError());
+                return 1;
+            }
+        }
+        std::vector<Address> pointers;
+        pointers.reserve(SWEEP_POINTERS);
+        std::uint64_t lcg = 0x9E3779B97F4A7C15ULL;
+        for (std::size_t i = 0; i < SWEEP_POINTERS; ++i)
+        {
+            lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+            const std::size_t offset = static_cast<std::size_t>(lcg >> 33) % (SWEEP_REGION_BYTES - 64);
+            pointers.emplace_back(heaps[(lcg >> 20) % SWEEP_REGIONS] + (offset & ~std::size_t{7}));
+        }
+        std::vector<std::uint8_t> verdicts(SWEEP_POINTERS);
+
+        dmk_bench::table("\n[11] Entity-list sweep: %zu pointers over %zu heap regions (ns per pointer)\n",
+                         SWEEP_POINTERS, SWEEP_REGIONS);
+        const double per_call_ns = median_ns_per_call("sweep_per_call", SWEEP_ITERS, SWEEP_SAMPLES,
+                                                      [&]()
+                                                      {
+                                                          std::uint64_t readable = 0;
+                                                          for (const Address pointer : pointers)
+                                                              readable += Mem::is_readable(Region{pointer, 64}) ? 1 : 0;
+                                                          sink(readable);
+                                                      }) /
+                                   static_cast<double>(SWEEP_POINTERS);
+        const double batch_ns = median_ns_per_call("sweep_batch", SWEEP_ITERS, SWEEP_SAMPLES,
+                                                   [&]()
+                                                   {
+                                                       const auto readable =
+                                                           Mem::is_readable_batch(pointers, 64, verdicts);
+                                                       sink(readable ? *readable : 0u);
+                                                   }) /
+                                static_cast<double>(SWEEP_POINTERS);
+        dmk_bench::table("  per-call is_readable %8.2f ns   is_readable_batch %8.2f ns   speedup %.1fx\n", per_call_ns,
+                         batch_ns, batch_ns > 0 ? per_call_ns / batch_ns : 0.0);
+        dmk_bench::table("#TSV\tsweep_per_call_ns\t%.2f\n", per_call_ns);
+        dmk_bench::table("#TSV\tsweep_batch_ns\t%.2f\n", batch_ns);
+        for (std::uint8_t *heap : heaps)
+            VirtualFree(heap, 0, MEM_RELEASE);
+    }
+
+    // Phase 12: field sweep. The per-frame actor read a mod does: dozens of fields off each of thousands of objects,
+    // all readable, so the only difference between the two loops is how often the fault guard is entered.
+    {
+        constexpr std::size_t ACTORS = 2000;
+        constexpr std::size_t FIELDS = 30;
+        constexpr std::size_t ACTOR_STRIDE = 512;
+        constexpr std::size_t FIELD_ITERS = 20;
+        constexpr std::size_t FIELD_SAMPLES = 9;
+        auto *actors = static_cast<std::uint8_t *>(
+            VirtualAlloc(nullptr, ACTORS * ACTOR_STRIDE, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        if (!actors)
+        {
+            std::fprintf(stderr, "[bench] VirtualAlloc failed: %lu\n", GetLastError());
+            return 1;
+        }
+        std::vector<std::uint64_t> values(ACTORS * FIELDS);
+        std::vector<Mem::ReadDescriptor> reads;
+        reads.reserve(ACTORS * FIELDS);
+        for (std::size_t actor = 0; actor < ACTORS; ++actor)
+        {
+            for (std::size_t field = 0; field < FIELDS; ++field)
+            {
+                std::uint64_t &slot = values[actor * FIELDS + field];
+                reads.push_back(Mem::ReadDescriptor{Address{actors + actor * ACTOR_STRIDE + field * 16},
+                                                    std::as_writable_bytes(std::span{&slot, 1})});
+            }
+        }
+        std::vector<std::uint8_t> statuses(reads.size());
+
+        dmk_bench::table("\n[12] Field sweep: %zu fields x %zu actors (ns per field)\n", FIELDS, ACTORS);
+        const double read_into_ns = median_ns_per_call("field_sweep_read_into", FIELD_ITERS, FIELD_SAMPLES,
+                                                       [&]()
+                                                       {
+                                                           std::uint64_t copied = 0;
+                                                           for (const Mem::ReadDescriptor &read : reads)
+                                                               copied += Mem::read_into(read.address, read.destination)
+                                                                             ? 1
+                                                                             : 0;
+                                                           sink(copied);
+                                                       }) /
+                                    static_cast<double>(reads.size());
+        const double read_many_ns = median_ns_per_call("field_sweep_read_many", FIELD_ITERS, FIELD_SAMPLES,
+                                                       [&]()
+                                                       {
+                                                           const auto copied = Mem::read_many(reads, statuses);
+                                                           sink(copied ? *copied : 0u);
+                                                       }) /
+                                    static_cast<double>(reads.size());
+        dmk_bench::table("  read_into per field %8.2f ns   read_many %8.2f ns   speedup %.1fx\n", read_into_ns,
+                         read_many_ns, read_many_ns > 0 ? read_into_ns / read_many_ns : 0.0);
+        dmk_bench::table("#TSV\tfield_sweep_read_into_ns\t%.2f\n", read_into_ns);
+        dmk_bench::table("#TSV\tfield_sweep_read_many_ns\t%.2f\n", read_many_ns);
+        VirtualFree(actors, 0, MEM_RELEASE);
     }
 
     // TSV block for machine parsing.
-    std::printf("\n#TSV\tscenario\tns_per_call\n");
+    dmk_bench::table("\n#TSV\tscenario\tns_per_call\n");
     for (const auto &r : g_rows)
-        std::printf("#TSV\t%s\t%.2f\n", r.name, r.ns);
-    std::printf("#TSV\tprobe_gated_mean\t%.2f\n", gated.mean);
-    std::printf("#TSV\tprobe_gated_p99\t%.2f\n", gated.p99);
-    std::printf("#TSV\tprobe_gated_max\t%.2f\n", gated.max);
-    std::printf("#TSV\tprobe_direct_mean\t%.2f\n", direct.mean);
-    std::printf("#TSV\tprobe_gated_over_direct\t%.2f\n", direct.mean > 0 ? gated.mean / direct.mean : 0.0);
+        dmk_bench::table("#TSV\t%s\t%.2f\n", r.name, r.ns);
+    dmk_bench::table("#TSV\tprobe_gated_mean\t%.2f\n", gated.mean);
+    dmk_bench::table("#TSV\tprobe_gated_p99\t%.2f\n", gated.p99);
+    dmk_bench::table("#TSV\tprobe_gated_max\t%.2f\n", gated.max);
+    dmk_bench::table("#TSV\tprobe_direct_mean\t%.2f\n", direct.mean);
+    dmk_bench::table("#TSV\tprobe_gated_over_direct\t%.2f\n", direct.mean > 0 ? gated.mean / direct.mean : 0.0);
 
     Mem::shutdown_cache();
-    std::printf("\n(sink=%llu)\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
-    return 0;
+    dmk_bench::table("\n(sink=%llu)\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
+    return session.finish();
 }
@@ -0,0 +1,502 @@
+/**
+ * @file bench_resolve.cpp
+ * @brief Standalone end-to-end benchmark for the public resolvers, against a real loaded module.
+ *
+ * bench_scanner.cpp times the matcher on a flat buffer; the startup cost a mod actually pays lives a level up, in the
+ * resolvers that own the page walk, the ladder, the prescan and the gate. This harness loads the resolve_bench_lib.dll
+ * fixture (1024 distinct functions, one .rdata string per function referenced through a RIP-relative lea, .pdata for
+ * every function, and synthetic MSVC RTTI for up to 1024 classes) and times each public API over the first N targets
+ * for N in {1, 10, 100, 1000}:
+ *
+ *   - scan.resolve              N single resolves of a Direct signature
+ *   - scan.resolve_batch        one batch of N Direct signatures
+ *   - scan.find_string_xref     N string-xref lookups (ReferencingInstruction)
+ *   - scan.string_xref_function N string-xref lookups returning the .pdata enclosing function
+ *   - scan.resolve_batch_xref   one batch of N string-xref candidates
+ *   - rtti.vtable_for_type      N reverse-RTTI sweeps
+ *   - rtti.type_index           one TypeIndex::build plus N lookups
+ *   - scan.resolve_batch_rtti   one batch of N RttiVtable candidates
+ *   - manifest.resolve_and_gate one gate over N compiled RipGlobal signatures
+ *   - hook.install_all          one install of N inline hooks (teardown excluded from the timing)
+ *
+ * Each signature is derived at run time from the target's own bytes, from its entry up to and including its magic
+ * immediate, so the table stays valid across compilers and optimisation levels; every one is checked to resolve to its
+ * own target before anything is timed. cold_us is the first iteration (empty caches, first touch of the pages),
+ * median_us the median of the remaining samples.
+ *
+ * Build with -DDMK_BUILD_BENCHMARKS=ON. Executable: DetourModKit_bench_resolve
+ * Output is a tab-separated table on stdout with the columns
+ *   api, signatures, iterations, cold_us, median_us, per_signature_us
+ * and the --json / --compare rows of every bench (bench_harness.hpp): "<api>/<N>" over the warm samples and
+ * "<api>/<N>/cold" for the cold figure.
+ */
+
+#include "DetourModKit/hook.hpp"
+#include "DetourModKit/manifest.hpp"
+#include "DetourModKit/rtti.hpp"
+#include "DetourModKit/scan.hpp"
+
+#include "bench_harness.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+    namespace scan = DetourModKit::scan;
+    namespace rtti = DetourModKit::rtti;
+    namespace manifest = DetourModKit::manifest;
+    namespace hook = DetourModKit::hook;
+    using DetourModKit::Address;
+    using DetourModKit::Region;
+    using DetourModKit::Result;
+
+    constexpr const char *FIXTURE_NAME = "resolve_bench_lib.dll";
+    constexpr std::array<std::size_t, 4> SIGNATURE_COUNTS{1, 10, 100, 1000};
+    // Bytes searched from a target's entry for its magic; far more than any prologue plus one store.
+    constexpr std::size_t MAGIC_SEARCH_BYTES = 64;
+
+    std::atomic<std::uintptr_t> s_sink{0};
+
+    using TargetCountFn = std::size_t (*)();
+    using TargetFn = void *(*)(std::size_t);
+    using TargetMagicFn = std::uint32_t (*)(std::size_t);
+    using BuildRttiFn = std::size_t (*)(std::size_t);
+    using RttiVtableFn = const void *(*)(std::size_t);
+
+    int bench_detour(int x)
+    {
+        return x;
+    }
+
+    // Everything the timed sections read, derived once from the loaded fixture.
+    struct Fixture
+    {
+        Region scope;
+        std::vector<const std::uint8_t *> entries;
+        std::vector<std::string> patterns;
+        std::vector<std::string> literals;
+        std::vector<std::string> type_names;
+        std::vector<const void *> vtables;
+    };
+
+    template <typename Fn> [[nodiscard]] Fn proc(HMODULE module, const char *name) noexcept
+    {
+        return reinterpret_cast<Fn>(reinterpret_cast<void *>(GetProcAddress(module, name)));
+    }
+
+    // Follows an incremental-link `jmp rel32` thunk to the function it forwards to.
+    [[nodiscard]] const std::uint8_t *function_body(const void *entry) noexcept
+    {
+        const auto *code = static_cast<const std::uint8_t *>(entry);
+        if (code[0] == 0xE9)
+        {
+            std::int32_t rel = 0;
+            std::memcpy(&rel, code + 1, sizeof(rel));
+            code += 5 + rel;
+        }
+        return code;
+    }
+
+    [[nodiscard]] std::string bytes_to_aob(const std::uint8_t *bytes, std::size_t count)
+    {
+        constexpr char digits[] = "0123456789ABCDEF";
+        std::string out;
+        out.reserve(count * 3);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (i != 0)
+            {
+                out.push_back(' ');
+            }
+            out.push_back(digits[bytes[i] >> 4]);
+            out.push_back(digits[bytes[i] & 0xFu]);
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::string four_digits(std::size_t index)
+    {
+        char text[8]{};
+        std::snprintf(text, sizeof(text), "%04zu", index);
+        return text;
+    }
+
+    [[nodiscard]] bool load_fixture(Fixture &out)
+    {
+        const HMODULE module = LoadLibraryA(FIXTURE_NAME);
+        if (module == nullptr)
+        {
+            std::fprintf(stderr, "[bench] cannot load %s (error %lu)\n", FIXTURE_NAME, GetLastError());
+            return false;
+        }
+        const auto count_fn = proc<TargetCountFn>(module, "dmk_bench_target_count");
+        const auto target_fn = proc<TargetFn>(module, "dmk_bench_target");
+        const auto magic_fn = proc<TargetMagicFn>(module, "dmk_bench_target_magic");
+        const auto build_rtti_fn = proc<BuildRttiFn>(module, "dmk_bench_build_rtti");
+        const auto vtable_fn = proc<RttiVtableFn>(module, "dmk_bench_rtti_vtable");
+        if (count_fn == nullptr || target_fn == nullptr || magic_fn == nullptr || build_rtti_fn == nullptr ||
+            vtable_fn == nullptr)
+        {
+            std::fprintf(stderr, "[bench] %s is missing a bench export\n", FIXTURE_NAME);
+            return false;
+        }
+
+        out.scope = Region::module_named(FIXTURE_NAME);
+        const std::size_t count = count_fn();
+        if (count < SIGNATURE_COUNTS.back() || build_rtti_fn(count) != count)
+        {
+            std::fprintf(stderr, "[bench] %s carries %zu targets, fewer than the bench needs\n", FIXTURE_NAME, count);
+            return false;
+        }
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint8_t *body = function_body(target_fn(i));
+            const std::uint32_t magic = magic_fn(i);
+            std::size_t end = 0;
+            for (std::size_t at = 0; at + sizeof(magic) <= MAGIC_SEARCH_BYTES; ++at)
+            {
+                if (std::memcmp(body + at, &magic, sizeof(magic)) == 0)
+                {
+                    end = at + sizeof(magic);
+                    break;
+                }
+            }
+            if (end == 0)
+            {
+                std::fprintf(stderr, "[bench] target %zu stores no magic in its first %zu bytes\n", i,
+                             MAGIC_SEARCH_BYTES);
+                return false;
+            }
+            out.entries.push_back(body);
+            out.patterns.push_back(bytes_to_aob(body, end));
+            out.literals.push_back("dmk.bench.string." + four_digits(i));
+            out.type_names.push_back(".?AVBenchType" + four_digits(i) + "@@");
+            out.vtables.push_back(vtable_fn(i));
+        }
+        return true;
+    }
+
+    [[nodiscard]] std::vector<scan::Candidate> direct_candidates(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<scan::Candidate> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto pattern = scan::Pattern::compile(fixture.patterns[i]);
+            if (!pattern.has_value())
+            {
+                std::fprintf(stderr, "[bench] cannot compile \"%s\"\n", fixture.patterns[i].c_str());
+                return {};
+            }
+            out.push_back(scan::Candidate::direct("direct." + four_digits(i), std::move(*pattern)));
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::vector<scan::Candidate> xref_candidates(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<scan::Candidate> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out.push_back(scan::Candidate::string_xref("xref." + four_digits(i), fixture.literals[i]));
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::vector<scan::Candidate> rtti_candidates(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<scan::Candidate> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out.push_back(scan::Candidate::rtti_vtable("rtti." + four_digits(i), fixture.type_names[i]));
+        }
+        return out;
+    }
+
+    // One single-rung request per candidate, scoped to the fixture. @p ladder must outlive the requests.
+    [[nodiscard]] std::vector<scan::ScanRequest> requests_for(const std::vector<scan::Candidate> &ladder, Region scope)
+    {
+        std::vector<scan::ScanRequest> out;
+        out.reserve(ladder.size());
+        for (const scan::Candidate &candidate : ladder)
+        {
+            out.push_back(scan::ScanRequest{.ladder = std::span<const scan::Candidate>(&candidate, 1), .scope = scope});
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::vector<manifest::Signature> gate_signatures(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<manifest::Signature> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            manifest::SignatureRecord record;
+            record.label = "bench." + four_digits(i);
+            record.kind = DetourModKit::anchor::AnchorKind::RipGlobal;
+            record.module = FIXTURE_NAME;
+            manifest::CandidateSpec rung;
+            rung.name = "direct";
+            rung.pattern = fixture.patterns[i];
+            record.ladder.push_back(std::move(rung));
+            auto signature = manifest::Signature::compile(std::move(record));
+            if (!signature.has_value())
+            {
+                std::fprintf(stderr, "[bench] cannot compile manifest signature %zu\n", i);
+                return {};
+            }
+            out.push_back(std::move(*signature));
+        }
+        return out;
+    }
+
+    [[nodiscard]] std::vector<hook::HookSpec> hook_table(const Fixture &fixture, std::size_t count)
+    {
+        std::vector<hook::HookSpec> out;
+        out.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto pattern = scan::Pattern::compile(fixture.patterns[i]);
+            if (!pattern.has_value())
+            {
+                return {};
+            }
+            scan::OwnedScanRequest target;
+            target.ladder.push_back(scan::Candidate::direct("direct", std::move(*pattern)));
+            target.label = "hook." + four_digits(i);
+            target.scope = fixture.scope;
+            out.push_back(hook::HookSpec::inline_hook(target.label, std::move(target), &bench_detour));
+        }
+        return out;
+    }
+
+    // Checks that every signature the timed sections use resolves to its own target, so a timing is never taken over
+    // a table that silently misses or matches the wrong site.
+    [[nodiscard]] bool verify_fixture(const Fixture &fixture)
+    {
+        const std::size_t count = SIGNATURE_COUNTS.back();
+        const std::vector<scan::Candidate> direct = direct_candidates(fixture, count);
+        if (direct.size() != count)
+        {
+            return false;
+        }
+        const std::vector<scan::ScanRequest> requests = requests_for(direct, fixture.scope);
+        const auto batch = scan::resolve_batch(requests);
+        if (!batch.has_value())
+        {
+            std::fprintf(stderr, "[bench] verification batch failed: %s\n", batch.error().message().c_str());
+            return false;
+        }
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const Result<scan::Hit> &hit = (*batch)[i];
+            if (!hit.has_value() || hit->address.raw() != reinterpret_cast<std::uintptr_t>(fixture.entries[i]))
+            {
+                std::fprintf(stderr, "[bench] signature %zu does not resolve uniquely to its target\n", i);
+                return false;
+            }
+            const auto vtable = rtti::vtable_for_type(fixture.type_names[i], fixture.scope);
+            if (!vtable.has_value() || vtable->raw() != reinterpret_cast<std::uintptr_t>(fixture.vtables[i]))
+            {
+                std::fprintf(stderr, "[bench] synthetic class %zu does not resolve to its vtable\n", i);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    struct Sample
+    {
+        double cold_us = 0.0;
+        double median_us = 0.0;
+        std::vector<double> warm_ns;
+    };
+
+    // Runs @p op (which times its own measured region and returns it) @p iterations times, keeping the first as the
+    // cold figure and the median of the rest as the warm one.
+    template <typename Op> Sample measure(std::size_t iterations, Op &&op)
+    {
+        Sample out;
+        out.warm_ns.reserve(iterations);
+        for (std::size_t i = 0; i < iterations; ++i)
+        {
+            const double ns = static_cast<double>(op().count());
+            if (i == 0)
+            {
+                out.cold_us = ns / 1000.0;
+                continue;
+            }
+            out.warm_ns.push_back(ns);
+        }
+        out.median_us = out.warm_ns.empty() ? out.cold_us : dmk_bench::median_of(out.warm_ns) / 1000.0;
+        return out;
+    }
+
+    template <typename Body> std::chrono::nanoseconds timed(Body &&body)
+    {
+        const auto start = Clock::now();
+        body();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+    }
+
+    // Prints the table row and records the warm samples as "<api>/<signatures>", the cold figure as ".../cold".
+    void report(const char *api, std::size_t signatures, std::size_t iterations, Sample sample)
+    {
+        const double per_signature = sample.median_us / static_cast<double>(signatures);
+        dmk_bench::table("%s\t%zu\t%zu\t%.3f\t%.3f\t%.3f\n", api, signatures, iterations, sample.cold_us,
+                         sample.median_us, per_signature);
+        const std::string row = std::string(api) + "/" + std::to_string(signatures);
+        dmk_bench::record_value(row + "/cold", sample.cold_us * 1000.0);
+        if (!sample.warm_ns.empty())
+        {
+            dmk_bench::record(row, std::move(sample.warm_ns));
+        }
+    }
+
+    // Fewer repetitions at the large sizes, where one iteration already runs long enough to be stable.
+    [[nodiscard]] std::size_t iterations_for(std::size_t signatures) noexcept
+    {
+        return signatures >= 1000 ? 5 : (signatures >= 100 ? 9 : 21);
+    }
+
+    void run_size(const Fixture &fixture, std::size_t n)
+    {
+        const std::size_t iterations = iterations_for(n);
+        const std::vector<scan::Candidate> direct = direct_candidates(fixture, n);
+        const std::vector<scan::Candidate> xref = xref_candidates(fixture, n);
+        const std::vector<scan::Candidate> types = rtti_candidates(fixture, n);
+        const std::vector<scan::ScanRequest> direct_requests = requests_for(direct, fixture.scope);
+        const std::vector<scan::ScanRequest> xref_requests = requests_for(xref, fixture.scope);
+        const std::vector<scan::ScanRequest> rtti_requests = requests_for(types, fixture.scope);
+
+        report("scan.resolve", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       for (const scan::ScanRequest &request : direct_requests)
+                       {
+                           const auto hit = scan::resolve(request);
+                           s_sink.fetch_add(hit ? hit->address.raw() : 0, std::memory_order_relaxed);
+                       }
+                   });
+               }));
+
+        report("scan.resolve_batch", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       const auto batch = scan::resolve_batch(direct_requests);
+                       s_sink.fetch_add(batch ? batch->size() : 0, std::memory_order_relaxed);
+                   });
+               }));
+
+        const auto xref_lookup = [&](scan::XrefReturn mode) {
+            return measure(iterations, [&] {
+                return timed([&] {
+                    for (std::size_t i = 0; i < n; ++i)
+                    {
+                        const scan::StringRefQuery query{.text = fixture.literals[i], .return_mode = mode};
+                        const auto site = scan::find_string_xref(query, fixture.scope);
+                        s_sink.fetch_add(site ? site->raw() : 0, std::memory_order_relaxed);
+                    }
+                });
+            });
+        };
+        report("scan.find_string_xref", n, iterations, xref_lookup(scan::XrefReturn::ReferencingInstruction));
+        report("scan.string_xref_function", n, iterations, xref_lookup(scan::XrefReturn::EnclosingFunction));
+
+        report("scan.resolve_batch_xref", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       const auto batch = scan::resolve_batch(xref_requests);
+                       s_sink.fetch_add(batch ? batch->size() : 0, std::memory_order_relaxed);
+                   });
+               }));
+
+        report("rtti.vtable_for_type", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       for (std::size_t i = 0; i < n; ++i)
+                       {
+                           const auto vtable = rtti::vtable_for_type(fixture.type_names[i], fixture.scope);
+                           s_sink.fetch_add(vtable ? vtable->raw() : 0, std::memory_order_relaxed);
+                       }
+                   });
+               }));
+
+        report("rtti.type_index", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       const auto index = rtti::TypeIndex::build(fixture.scope);
+                       if (!index.has_value())
+                       {
+                           return;
+                       }
+                       for (std::size_t i = 0; i < n; ++i)
+                       {
+                           const auto vtable = index->vtable_for(fixture.type_names[i]);
+                           s_sink.fetch_add(vtable ? vtable->raw() : 0, std::memory_order_relaxed);
+                       }
+                   });
+               }));
+
+        report("scan.resolve_batch_rtti", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       const auto batch = scan::resolve_batch(rtti_requests);
+                       s_sink.fetch_add(batch ? batch->size() : 0, std::memory_order_relaxed);
+                   });
+               }));
+
+        const std::vector<manifest::Signature> signatures = gate_signatures(fixture, n);
+        report("manifest.resolve_and_gate", n, iterations, measure(iterations, [&] {
+                   return timed([&] {
+                       const manifest::GateResult gate = manifest::resolve_and_gate(signatures);
+                       s_sink.fetch_add(gate.trusted.size(), std::memory_order_relaxed);
+                   });
+               }));
+
+        const std::vector<hook::HookSpec> table = hook_table(fixture, n);
+        report("hook.install_all", n, iterations, measure(iterations, [&] {
+                   DetourModKit::Result<std::vector<hook::InstallOutcome>> installed =
+                       std::unexpected(DetourModKit::Error{DetourModKit::ErrorCode::HookNotFound, "bench"});
+                   const auto elapsed = timed([&] { installed = hook::install_all(table); });
+                   if (!installed.has_value())
+                   {
+                       std::fprintf(stderr, "[bench] install_all over %zu rows failed: %s\n", n,
+                                    installed.error().message().c_str());
+                   }
+                   return elapsed;
+               }));
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    dmk_bench::Session session("resolve", argc, argv);
+
+    Fixture fixture;
+    if (!load_fixture(fixture) || !verify_fixture(fixture))
+    {
+        return 1;
+    }
+
+    dmk_bench::table("api\tsignatures\titerations\tcold_us\tmedian_us\tper_signature_us\n");
+    for (const std::size_t n : SIGNATURE_COUNTS)
+    {
+        run_size(fixture, n);
+    }
+
+    std::fprintf(stderr, "[bench] sink=%llu\n", static_cast<unsigned long long>(s_sink.load()));
+    return session.finish();
+}
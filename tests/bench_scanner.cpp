@@ -24,6 +24,8 @@
 #include "internal/memory_guarded.hpp"
 #include "internal/scan_engine.hpp"
 
+#include "bench_harness.hpp"
+
 #include <algorithm>
 #include <array>
 #include <atomic>
@@ -32,9 +34,12 @@
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <limits>
 #include <random>
 #include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #ifndef WIN32_LEAN_AND_MEAN
@@ -206,32 +211,12 @@ namespace
         return copy;
     }
 
-    // Runs the scan `iterations` times within a single sample, repeats the sample `samples` times, returns the median
-    // wall time per iteration in microseconds.
-    template <typename Op> double median_us_per_iter(std::size_t iterations, std::size_t samples, Op &&op)
+    // Runs the scan `iterations` times within a single sample, repeats the sample `samples` times, records the samples
+    // under @p row, and returns the median wall time per iteration in microseconds.
+    template <typename Op>
+    double median_us_per_iter(std::string_view row, std::size_t iterations, std::size_t samples, Op &&op)
     {
-        std::vector<double> per_iter;
-        per_iter.reserve(samples);
-
-        for (std::size_t s = 0; s < samples; ++s)
-        {
-            const auto start = Clock::now();
-            for (std::size_t i = 0; i < iterations; ++i)
-            {
-                op();
-            }
-            const auto end = Clock::now();
-            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
-            per_iter.push_back(static_cast<double>(ns) / static_cast<double>(iterations) / 1000.0);
-        }
-
-        std::sort(per_iter.begin(), per_iter.end());
-        const std::size_t n = per_iter.size();
-        if ((n % 2) == 0)
-        {
-            return (per_iter[(n / 2) - 1] + per_iter[n / 2]) / 2.0;
-        }
-        return per_iter[n / 2];
+        return dmk_bench::median_ns_per_op(row, iterations, samples, std::forward<Op>(op)) / 1000.0;
     }
 
     struct Scenario
@@ -265,7 +250,7 @@ namespace
         s_sink.fetch_add(reinterpret_cast<std::uintptr_t>(warm_smart), std::memory_order_relaxed);
 
         const double us_smart =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter(std::string(scenario.name) + "/smart", iterations, samples,
                                [&]()
                                {
                                    const auto *m =
@@ -274,7 +259,7 @@ namespace
                                });
 
         const double us_naive =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter(std::string(scenario.name) + "/naive", iterations, samples,
                                [&]()
                                {
                                    const auto *m =
@@ -286,11 +271,12 @@ namespace
         const double smart_throughput = 1.0e6 / us_smart;
         const double naive_throughput = 1.0e6 / us_naive;
 
-        std::printf("%-32s\t%-6s\t%9zu\t%12.3f\t%14.1f\t%9.2fx\n", scenario.name, "smart", iterations, us_smart,
-                    smart_throughput, 1.0);
-        std::printf("%-32s\t%-6s\t%9zu\t%12.3f\t%14.1f\t%9.2fx\n", scenario.name, "naive", iterations, us_naive,
-                    naive_throughput, 1.0 / speedup);
-        std::printf("%-32s\t%-6s\t%9zu\t%12s\t%14s\t%9.2fx\n", scenario.name, "ratio", iterations, "-", "-", speedup);
+        dmk_bench::table("%-32s\t%-6s\t%9zu\t%12.3f\t%14.1f\t%9.2fx\n", scenario.name, "smart", iterations, us_smart,
+                         smart_throughput, 1.0);
+        dmk_bench::table("%-32s\t%-6s\t%9zu\t%12.3f\t%14.1f\t%9.2fx\n", scenario.name, "naive", iterations, us_naive,
+                         naive_throughput, 1.0 / speedup);
+        dmk_bench::table("%-32s\t%-6s\t%9zu\t%12s\t%14s\t%9.2fx\n", scenario.name, "ratio", iterations, "-", "-",
+                         speedup);
     }
 
     // Prefilter isolation: measure the dmk_memchr sweep on its own. A sentinel byte is scrubbed out of the whole
@@ -334,7 +320,7 @@ namespace
         s_sink.fetch_add(reinterpret_cast<std::uintptr_t>(warm), std::memory_order_relaxed);
 
         const double us_scanner =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter("prefilter/dmk_memchr", iterations, samples,
                                [&]()
                                {
                                    const auto *m =
@@ -343,7 +329,7 @@ namespace
                                });
 
         const double us_libc =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter("prefilter/libc_memchr", iterations, samples,
                                [&]()
                                {
                                    const void *m = std::memchr(buffer.data(), SENTINEL, buffer.size());
@@ -353,13 +339,177 @@ namespace
         const double bytes = static_cast<double>(buffer_size);
         const auto gib_per_s = [bytes](double us) { return bytes / (us * 1.0e-6) / (1024.0 * 1024.0 * 1024.0); };
 
-        std::printf("\nPrefilter sweep (dmk_memchr isolation, %zu MiB buffer, unique sentinel anchor)\n",
-                    buffer_size / (1024u * 1024u));
-        std::printf("%-22s\t%12s\t%12s\n", "impl", "median_us", "GiB/s");
-        std::printf("%-22s\t%12.3f\t%12.2f\n", "dmk_memchr (scanner)", us_scanner, gib_per_s(us_scanner));
-        std::printf("%-22s\t%12.3f\t%12.2f\n", "libc memchr (ref)", us_libc, gib_per_s(us_libc));
-        std::printf("dmk/libc throughput ratio: %.2fx (>= 1.00x means no regression below libc)\n",
-                    us_libc / us_scanner);
+        dmk_bench::table("\nPrefilter sweep (dmk_memchr isolation, %zu MiB buffer, unique sentinel anchor)\n",
+                         buffer_size / (1024u * 1024u));
+        dmk_bench::table("%-22s\t%12s\t%12s\n", "impl", "median_us", "GiB/s");
+        dmk_bench::table("%-22s\t%12.3f\t%12.2f\n", "dmk_memchr (scanner)", us_scanner, gib_per_s(us_scanner));
+        dmk_bench::table("%-22s\t%12.3f\t%12.2f\n", "libc memchr (ref)", us_libc, gib_per_s(us_libc));
+        dmk_bench::table("dmk/libc throughput ratio: %.2fx (>= 1.00x means no regression below libc)\n",
+                         us_libc / us_scanner);
+    }
+
+    // Dual-anchor prefilter: a signature built only from hot opcode bytes, the `.text` case where even its rarest byte
+    // is common. The "single" run disables the partner (partner = size()) so the sweep is the one-byte memchr; the
+    // "paired" run is the production scanner testing anchor and partner in the same vector step. Candidate counts are
+    // tallied with a scalar pass over the buffer, so the table shows how many verifies each prefilter hands on as well
+    // as what that costs.
+    void run_dual_anchor_bench(std::span<const std::byte> buffer, std::size_t iterations, std::size_t samples)
+    {
+        auto parsed = DetourModKit::detail::parse_aob("8B 48 89 0F E8 83 C3 00");
+        if (!parsed.has_value() || parsed->partner >= parsed->size())
+        {
+            std::fprintf(stderr, "[bench] dual-anchor AOB parse failed\n");
+            return;
+        }
+        const EnginePattern paired = std::move(*parsed);
+        EnginePattern single = paired;
+        single.partner = single.size();
+
+        const auto *warm_paired = DetourModKit::detail::find_pattern(buffer.data(), buffer.size(), paired);
+        const auto *warm_single = DetourModKit::detail::find_pattern(buffer.data(), buffer.size(), single);
+        if (warm_paired != warm_single)
+        {
+            std::fprintf(stderr, "[bench] dual-anchor mismatch: paired=%p single=%p\n",
+                         static_cast<const void *>(warm_paired), static_cast<const void *>(warm_single));
+            return;
+        }
+        s_sink.fetch_add(reinterpret_cast<std::uintptr_t>(warm_paired), std::memory_order_relaxed);
+
+        const std::size_t last = buffer.size() - paired.size();
+        const std::byte anchor_value = paired.bytes[paired.anchor];
+        const std::byte partner_value = paired.bytes[paired.partner];
+        std::size_t single_candidates = 0;
+        std::size_t paired_candidates = 0;
+        for (std::size_t i = 0; i <= last; ++i)
+        {
+            if (buffer[i + paired.anchor] == anchor_value)
+            {
+                ++single_candidates;
+                paired_candidates += buffer[i + paired.partner] == partner_value ? 1u : 0u;
+            }
+        }
+
+        const auto time_scan = [&](std::string_view row, const EnginePattern &pattern)
+        {
+            return median_us_per_iter(row, iterations, samples,
+                                      [&]()
+                                      {
+                                          const auto *m = DetourModKit::detail::find_pattern(buffer.data(),
+                                                                                             buffer.size(), pattern);
+                                          s_sink.fetch_add(reinterpret_cast<std::uintptr_t>(m),
+                                                           std::memory_order_relaxed);
+                                      });
+        };
+        const double us_single = time_scan("dual_anchor/single", single);
+        const double us_paired = time_scan("dual_anchor/paired", paired);
+
+        dmk_bench::table("\nDual-anchor prefilter (hot-byte-only signature, %zu MiB code-like buffer)\n",
+                         buffer.size() / (1024u * 1024u));
+        dmk_bench::table("%-22s\t%12s\t%12s\t%12s\n", "prefilter", "median_us", "candidates", "speedup");
+        dmk_bench::table("%-22s\t%12.3f\t%12zu\t%12.2f\n", "single anchor", us_single, single_candidates, 1.0);
+        dmk_bench::table("%-22s\t%12.3f\t%12zu\t%12.2f\n", "anchor + partner", us_paired, paired_candidates,
+                         us_single / us_paired);
+    }
+
+    // Cache pollution of a large sweep. A "game" working set is touched until it is cache-resident, one full sweep of a
+    // large buffer runs, and then the working set is touched again; the time of that re-touch, against the same
+    // re-touch with no sweep in between, is what the sweep cost the game's frame. The plain and streaming rows run the
+    // same sweep with the streaming threshold forced off and on, so the only difference is the prefetch policy. The
+    // working set is walked one cache line at a time in a shuffled order so the hardware prefetcher cannot hide misses.
+    void run_streaming_bench(std::size_t sweep_size, std::size_t working_set, std::uint64_t seed, std::size_t samples)
+    {
+        auto sweep = make_codelike_buffer(sweep_size, seed);
+        for (auto &b : sweep)
+        {
+            if (b == std::byte{0x37})
+            {
+                b = std::byte{0x90};
+            }
+        }
+        plant_signature(sweep, sweep_size - 4096u, {0x37, 0xDE, 0xAD, 0xBE, 0xEF, 0xC0, 0x1D, 0xF0});
+        auto parsed = DetourModKit::detail::parse_aob("37 DE AD BE EF C0 1D F0");
+        if (!parsed.has_value())
+        {
+            std::fprintf(stderr, "[bench] streaming AOB parse failed\n");
+            return;
+        }
+        const EnginePattern pattern = std::move(*parsed);
+
+        constexpr std::size_t LINE = 64;
+        std::vector<std::uint64_t> hot(working_set / sizeof(std::uint64_t), 1);
+        std::vector<std::size_t> order(working_set / LINE);
+        for (std::size_t i = 0; i < order.size(); ++i)
+        {
+            order[i] = i * (LINE / sizeof(std::uint64_t));
+        }
+        std::shuffle(order.begin(), order.end(), std::mt19937_64(seed));
+        const auto touch = [&]()
+        {
+            std::uint64_t sum = 0;
+            for (const std::size_t index : order)
+            {
+                sum += hot[index];
+            }
+            s_sink.fetch_add(static_cast<std::uintptr_t>(sum), std::memory_order_relaxed);
+        };
+
+        const std::size_t saved = DetourModKit::detail::streaming_sweep_threshold();
+        struct Row
+        {
+            const char *name;
+            const char *row;
+            std::size_t threshold;
+            bool sweeps;
+        };
+        constexpr std::array<Row, 3> rows{{
+            {"no sweep", "streaming/none", std::numeric_limits<std::size_t>::max(), false},
+            {"plain sweep", "streaming/plain", std::numeric_limits<std::size_t>::max(), true},
+            {"streaming sweep", "streaming/streaming", 0, true},
+        }};
+
+        dmk_bench::table("\nSweep cache pollution (%zu MiB sweep, %zu KiB working set re-touched after it)\n",
+                         sweep_size / (1024u * 1024u), working_set / 1024u);
+        dmk_bench::table("%-22s\t%12s\t%12s\t%16s\n", "mode", "sweep_us", "GiB/s", "retouch_us");
+        for (const Row &row : rows)
+        {
+            DetourModKit::detail::set_streaming_sweep_threshold(row.threshold);
+            std::vector<double> sweep_ns;
+            std::vector<double> retouch_ns;
+            for (std::size_t s = 0; s < samples; ++s)
+            {
+                touch();
+                touch();
+                const auto swept = Clock::now();
+                if (row.sweeps)
+                {
+                    const auto *m = DetourModKit::detail::find_pattern(sweep.data(), sweep.size(), pattern);
+                    s_sink.fetch_add(reinterpret_cast<std::uintptr_t>(m), std::memory_order_relaxed);
+                }
+                const auto retouched = Clock::now();
+                touch();
+                const auto done = Clock::now();
+                sweep_ns.push_back(std::chrono::duration<double, std::nano>(retouched - swept).count());
+                retouch_ns.push_back(std::chrono::duration<double, std::nano>(done - retouched).count());
+            }
+            const double median_sweep = dmk_bench::median_of(sweep_ns) / 1000.0;
+            const double median_retouch = dmk_bench::median_of(retouch_ns) / 1000.0;
+            if (row.sweeps)
+            {
+                dmk_bench::record(std::string(row.row) + "/sweep", std::move(sweep_ns));
+            }
+            dmk_bench::record(std::string(row.row) + "/retouch", std::move(retouch_ns));
+            if (row.sweeps)
+            {
+                const double gib_per_s =
+                    static_cast<double>(sweep_size) / (median_sweep * 1.0e-6) / (1024.0 * 1024.0 * 1024.0);
+                dmk_bench::table("%-22s\t%12.1f\t%12.2f\t%16.1f\n", row.name, median_sweep, gib_per_s, median_retouch);
+            }
+            else
+            {
+                dmk_bench::table("%-22s\t%12s\t%12s\t%16.1f\n", row.name, "-", "-", median_retouch);
+            }
+        }
+        DetourModKit::detail::set_streaming_sweep_threshold(saved);
     }
 
     /// Returns the human-readable name of the SIMD verify tier find_pattern selects at runtime.
@@ -414,7 +564,7 @@ namespace
         const EnginePattern pattern = std::move(*parsed);
 
         const double us =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter("verify/deep", iterations, samples,
                                [&]()
                                {
                                    const auto *m =
@@ -424,13 +574,14 @@ namespace
 
         const double bytes = static_cast<double>(buffer_size);
         const double gib_per_s = bytes / (us * 1.0e-6) / (1024.0 * 1024.0 * 1024.0);
-        std::printf("\nVerify throughput (deep verify, %zu-byte literal pattern, break stride %zu, %zu MiB buffer)\n",
-                    pattern_len, stride, buffer_size / (1024u * 1024u));
-        std::printf("%-22s\t%12s\t%12s\n", "tier", "median_us", "GiB/s");
-        std::printf("%-22s\t%12.3f\t%12.2f\n", active_simd_tier_name(), us, gib_per_s);
+        dmk_bench::table(
+            "\nVerify throughput (deep verify, %zu-byte literal pattern, break stride %zu, %zu MiB buffer)\n",
+            pattern_len, stride, buffer_size / (1024u * 1024u));
+        dmk_bench::table("%-22s\t%12s\t%12s\n", "tier", "median_us", "GiB/s");
+        dmk_bench::table("%-22s\t%12.3f\t%12.2f\n", active_simd_tier_name(), us, gib_per_s);
         // Machine-readable verify-throughput line for the >= 30% AVX-512-vs-AVX2 gate: on a real AVX-512 host a
         // tier-enabled build and an AVX2 baseline build are compared and the ratio must clear the bar.
-        std::printf("#GATE\tverify_gib_per_s\t%.4f\t%s\n", gib_per_s, active_simd_tier_name());
+        dmk_bench::table("#GATE\tverify_gib_per_s\t%.4f\t%s\n", gib_per_s, active_simd_tier_name());
     }
 
     void run_resolver_batch_bench(std::size_t module_size, std::size_t target_count, std::size_t iterations,
@@ -507,7 +658,7 @@ namespace
         }
 
         const double us_serial =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter("resolver/serial", iterations, samples,
                                [&]()
                                {
                                    for (const auto &request : requests)
@@ -518,7 +669,7 @@ namespace
                                });
 
         const double us_batch =
-            median_us_per_iter(iterations, samples,
+            median_us_per_iter("resolver/batch", iterations, samples,
                                [&]()
                                {
                                    const auto batch = scan::resolve_batch(std::span{requests}, max_workers);
@@ -536,13 +687,13 @@ namespace
                                    }
                                });
 
-        std::printf("\nStartup resolver batch (%zu module-scoped cascades, %zu MiB module, %zu workers)\n",
-                    target_count, module_size / (1024u * 1024u), max_workers);
-        std::printf("%-22s\t%12s\t%12s\t%12s\n", "mode", "median_us", "targets/s", "speedup");
-        std::printf("%-22s\t%12.3f\t%12.1f\t%12.2f\n", "serial", us_serial,
-                    static_cast<double>(target_count) * 1.0e6 / us_serial, 1.0);
-        std::printf("%-22s\t%12.3f\t%12.1f\t%12.2f\n", "batch", us_batch,
-                    static_cast<double>(target_count) * 1.0e6 / us_batch, us_serial / us_batch);
+        dmk_bench::table("\nStartup resolver batch (%zu module-scoped cascades, %zu MiB module, %zu workers)\n",
+                         target_count, module_size / (1024u * 1024u), max_workers);
+        dmk_bench::table("%-22s\t%12s\t%12s\t%12s\n", "mode", "median_us", "targets/s", "speedup");
+        dmk_bench::table("%-22s\t%12.3f\t%12.1f\t%12.2f\n", "serial", us_serial,
+                         static_cast<double>(target_count) * 1.0e6 / us_serial, 1.0);
+        dmk_bench::table("%-22s\t%12.3f\t%12.1f\t%12.2f\n", "batch", us_batch,
+                         static_cast<double>(target_count) * 1.0e6 / us_batch, us_serial / us_batch);
     }
 } // namespace
 
@@ -565,30 +716,32 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    dmk_bench::Session session("scanner", argc, argv);
+
     constexpr std::size_t BUFFER_SIZE = 8u * 1024u * 1024u; // 8 MiB
     constexpr std::uint64_t SEED = 0xD37011CDull;
     constexpr std::size_t SAMPLES = 11;
 
-    std::printf("DetourModKit Scanner microbenchmark\n");
-    std::printf("Buffer: %zu bytes (code-like byte distribution, seed 0x%llx)\n", BUFFER_SIZE,
-                static_cast<unsigned long long>(SEED));
-    std::printf("SIMD tier: ");
+    dmk_bench::table("DetourModKit Scanner microbenchmark\n");
+    dmk_bench::table("Buffer: %zu bytes (code-like byte distribution, seed 0x%llx)\n", BUFFER_SIZE,
+                     static_cast<unsigned long long>(SEED));
+    dmk_bench::table("SIMD tier: ");
     switch (DetourModKit::detail::active_simd_level())
     {
     case DetourModKit::scan::SimdLevel::Avx512:
-        std::printf("AVX-512\n");
+        dmk_bench::table("AVX-512\n");
         break;
     case DetourModKit::scan::SimdLevel::Avx2:
-        std::printf("AVX2\n");
+        dmk_bench::table("AVX2\n");
         break;
     case DetourModKit::scan::SimdLevel::Sse2:
-        std::printf("SSE2\n");
+        dmk_bench::table("SSE2\n");
         break;
     case DetourModKit::scan::SimdLevel::Scalar:
-        std::printf("Scalar\n");
+        dmk_bench::table("Scalar\n");
         break;
     }
-    std::printf("\n");
+    dmk_bench::table("\n");
 
     auto buffer = make_codelike_buffer(BUFFER_SIZE, SEED);
 
@@ -613,10 +766,10 @@ int main(int argc, char **argv)
     }};
 
     // Header
-    std::printf("%-32s\t%-6s\t%9s\t%12s\t%14s\t%10s\n", "scenario", "anchor", "iters", "median_us", "scans/sec",
-                "speedup");
-    std::printf("%-32s\t%-6s\t%9s\t%12s\t%14s\t%10s\n", "--------", "------", "-----", "---------", "---------",
-                "-------");
+    dmk_bench::table("%-32s\t%-6s\t%9s\t%12s\t%14s\t%10s\n", "scenario", "anchor", "iters", "median_us", "scans/sec",
+                     "speedup");
+    dmk_bench::table("%-32s\t%-6s\t%9s\t%12s\t%14s\t%10s\n", "--------", "------", "-----", "---------", "---------",
+                     "-------");
 
     constexpr std::size_t ITERS = 200; // each iteration is a full 8 MiB scan
     for (const auto &s : scenarios)
@@ -624,6 +777,8 @@ int main(int argc, char **argv)
         run_scenario(s, buffer, ITERS, SAMPLES);
     }
 
+    run_dual_anchor_bench(buffer, ITERS, SAMPLES);
+
     // Prefilter-bound isolation on a larger buffer so the dmk_memchr sweep dominates and per-call overhead is
     // amortized. This isolates the prefilter so a SIMD prefilter change can be gated against the scalar/SWAR baseline
     // and the libc reference.
@@ -639,6 +794,12 @@ int main(int argc, char **argv)
     constexpr std::size_t VERIFY_ITERS = 10;
     run_verify_bench(VERIFY_BUFFER, VERIFY_PATTERN_LEN, VERIFY_STRIDE, VERIFY_ITERS, SAMPLES);
 
+    // Large-region streaming sweep: a 256 MiB sweep is well past the last-level cache, and a 4 MiB working set stands
+    // in for the game's hot data between two frames.
+    constexpr std::size_t STREAMING_SWEEP = 256u * 1024u * 1024u;
+    constexpr std::size_t STREAMING_WORKING_SET = 4u * 1024u * 1024u;
+    run_streaming_bench(STREAMING_SWEEP, STREAMING_WORKING_SET, SEED, SAMPLES);
+
     // Startup-resolution layer benchmark. This times the consumer-facing ladder resolver instead of the raw
     // EnginePattern batch, preserving per-target candidate order and uniqueness checks.
     constexpr std::size_t RESOLVER_MODULE = 8u * 1024u * 1024u;
@@ -648,6 +809,6 @@ int main(int argc, char **argv)
     run_resolver_batch_bench(RESOLVER_MODULE, RESOLVER_TARGETS, RESOLVER_ITERS, SAMPLES, RESOLVER_WORKERS);
 
     // Touch the sink so it can never be optimized away.
-    std::printf("\n(sink=%llu)\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
-    return 0;
+    dmk_bench::table("\n(sink=%llu)\n", static_cast<unsigned long long>(s_sink.load(std::memory_order_relaxed)));
+    return session.finish();
 }
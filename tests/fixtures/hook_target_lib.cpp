@@ -1,5 +1,34 @@
 #include <windows.h>
 
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace
+{
+    // bench_hook.cpp's targets: BENCH_TARGETS distinct functions with the same body shape as the compute_* exports.
+    // Each stores its own magic, so no two are byte-identical and an identical-code-folding linker cannot merge them.
+    constexpr int BENCH_TARGETS = 256;
+
+    template <int N> __declspec(noinline) int bench_target(int x)
+    {
+        volatile int magic = 0x4B000000 + N;
+        volatile int result = x + (magic - magic);
+        return result;
+    }
+
+    using BenchTargetFn = int (*)(int);
+
+    template <std::size_t... I>
+    constexpr std::array<BenchTargetFn, sizeof...(I)> make_bench_targets(std::index_sequence<I...>) noexcept
+    {
+        return {&bench_target<static_cast<int>(I)>...};
+    }
+
+    constexpr std::array<BenchTargetFn, BENCH_TARGETS> s_bench_targets =
+        make_bench_targets(std::make_index_sequence<BENCH_TARGETS>{});
+} // namespace
+
 extern "C"
 {
     __declspec(dllexport) __declspec(noinline) int compute_damage(int base, int modifier)
@@ -37,6 +66,21 @@ extern "C"
     // C++, which dllexport cannot apply to.
     __declspec(dllexport) extern const unsigned char dmk_scan_marker[16] = {
         0xA7, 0x3C, 0xF1, 0x88, 0x5E, 0x22, 0xD9, 0x04, 0x6B, 0xB0, 0x1F, 0x97, 0x4A, 0xE3, 0x7D, 0x50};
+
+    // The bench targets: how many there are, and the entry of target @p index (nullptr past the end).
+    __declspec(dllexport) int dmk_hook_bench_target_count()
+    {
+        return BENCH_TARGETS;
+    }
+
+    __declspec(dllexport) void *dmk_hook_bench_target(int index)
+    {
+        if (index < 0 || index >= BENCH_TARGETS)
+        {
+            return nullptr;
+        }
+        return reinterpret_cast<void *>(s_bench_targets[static_cast<std::size_t>(index)]);
+    }
 }
 
 BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
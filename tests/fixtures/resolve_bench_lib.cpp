@@ -0,0 +1,176 @@
+// Fixture DLL for bench_resolve.cpp: a module large enough that resolving inside it costs what a game image costs.
+//
+// It carries BENCH_TARGETS distinct functions, each with its own 32-bit magic (so a byte signature taken up to the
+// magic is unique), its own .rdata string referenced through a RIP-relative lea (a string-xref anchor), and a stack
+// frame (so it has a .pdata entry). MinGW does not emit MSVC RTTI, so dmk_bench_build_rtti writes the synthetic
+// COL / TypeDescriptor / vtable records the resolver walks into a static pool inside this image, with RVAs relative to
+// this DLL's base, exactly the layout test_rtti_reverse.cpp builds inside the test executable.
+
+#include <windows.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(_MSC_VER)
+#define DMK_BENCH_NOINLINE __declspec(noinline)
+#else
+#define DMK_BENCH_NOINLINE [[gnu::noinline]]
+#endif
+
+extern "C" IMAGE_DOS_HEADER __ImageBase;
+
+namespace
+{
+    constexpr std::size_t BENCH_TARGETS = 1024;
+    constexpr std::uint32_t BENCH_MAGIC_BASE = 0x5EED0000u;
+
+    constexpr std::size_t TAG_CAPACITY = 24;
+    constexpr char TAG_PREFIX[] = "dmk.bench.string.";
+
+    // Writes @p index as four decimal digits at @p at.
+    constexpr void put_digits(char *at, std::size_t index) noexcept
+    {
+        at[0] = static_cast<char>('0' + (index / 1000) % 10);
+        at[1] = static_cast<char>('0' + (index / 100) % 10);
+        at[2] = static_cast<char>('0' + (index / 10) % 10);
+        at[3] = static_cast<char>('0' + index % 10);
+    }
+
+    // The literal a target references: "dmk.bench.string.NNNN", NUL-terminated, one per instantiation.
+    template <std::size_t N> struct BenchTag
+    {
+        static constexpr std::array<char, TAG_CAPACITY> text = [] {
+            std::array<char, TAG_CAPACITY> out{};
+            std::size_t i = 0;
+            for (; TAG_PREFIX[i] != '\0'; ++i)
+            {
+                out[i] = TAG_PREFIX[i];
+            }
+            put_digits(out.data() + i, N);
+            return out;
+        }();
+    };
+
+    // The magic is stored before the tag so the bytes from the entry to the magic hold no RIP displacement.
+    template <std::size_t N> DMK_BENCH_NOINLINE int bench_target(int x)
+    {
+        volatile std::uint32_t magic = BENCH_MAGIC_BASE + static_cast<std::uint32_t>(N);
+        const char *volatile tag = BenchTag<N>::text.data();
+        return x + static_cast<int>(magic - magic) + (tag[0] == 'd' ? 1 : 0);
+    }
+
+    using TargetFn = int (*)(int);
+
+    template <std::size_t... I>
+    constexpr std::array<TargetFn, sizeof...(I)> make_targets(std::index_sequence<I...>) noexcept
+    {
+        return {&bench_target<I>...};
+    }
+
+    constexpr std::array<TargetFn, BENCH_TARGETS> s_targets = make_targets(std::make_index_sequence<BENCH_TARGETS>{});
+
+    // One synthetic class per slot. The COL sits at the start, its TypeDescriptor right after it, then the vtable[-1]
+    // meta-slot and a one-entry vtable pointing at the slot's own target.
+    constexpr std::size_t RTTI_SLOT_SIZE = 128;
+    constexpr std::size_t RTTI_COL_OFFSET = 0;
+    constexpr std::size_t RTTI_TD_OFFSET = RTTI_COL_OFFSET + 24;
+    constexpr std::size_t RTTI_TD_NAME_OFFSET = RTTI_TD_OFFSET + 16;
+    constexpr std::size_t RTTI_COL_PTR_OFFSET = 80;
+    constexpr std::size_t RTTI_VTABLE_OFFSET = RTTI_COL_PTR_OFFSET + 8;
+    constexpr char RTTI_NAME_PREFIX[] = ".?AVBenchType";
+    constexpr char RTTI_NAME_SUFFIX[] = "@@";
+
+    alignas(16) std::array<std::byte, RTTI_SLOT_SIZE * BENCH_TARGETS> s_rtti_pool{};
+    std::size_t s_rtti_built = 0;
+
+    template <typename T> void put(std::byte *at, std::size_t offset, const T &value) noexcept
+    {
+        std::memcpy(at + offset, &value, sizeof(T));
+    }
+
+    void build_rtti_slot(std::size_t index) noexcept
+    {
+        std::byte *const slot = s_rtti_pool.data() + (index * RTTI_SLOT_SIZE);
+        const auto image_base = reinterpret_cast<std::uintptr_t>(&__ImageBase);
+        const auto slot_rva = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(slot) - image_base);
+
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 0, 1);                           // signature (x64)
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 4, 0);                           // offset in complete object
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 8, 0);                           // cd_offset
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 12, slot_rva + RTTI_TD_OFFSET);  // p_type_descriptor
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 16, 0);                          // p_class_descriptor
+        put<std::uint32_t>(slot, RTTI_COL_OFFSET + 20, slot_rva + RTTI_COL_OFFSET); // p_self
+
+        char name[32]{};
+        std::size_t length = 0;
+        for (const char c : RTTI_NAME_PREFIX)
+        {
+            if (c != '\0')
+            {
+                name[length++] = c;
+            }
+        }
+        put_digits(name + length, index);
+        length += 4;
+        for (const char c : RTTI_NAME_SUFFIX)
+        {
+            if (c != '\0')
+            {
+                name[length++] = c;
+            }
+        }
+        std::memcpy(slot + RTTI_TD_NAME_OFFSET, name, length + 1);
+
+        put<std::uintptr_t>(slot, RTTI_COL_PTR_OFFSET, reinterpret_cast<std::uintptr_t>(slot + RTTI_COL_OFFSET));
+        put<std::uintptr_t>(slot, RTTI_VTABLE_OFFSET, reinterpret_cast<std::uintptr_t>(s_targets[index]));
+    }
+} // namespace
+
+extern "C"
+{
+    /// The number of bench targets this image carries.
+    __declspec(dllexport) std::size_t dmk_bench_target_count()
+    {
+        return BENCH_TARGETS;
+    }
+
+    /// The entry of target @p index (possibly an incremental-link thunk), or nullptr past the end.
+    __declspec(dllexport) void *dmk_bench_target(std::size_t index)
+    {
+        return index < BENCH_TARGETS ? reinterpret_cast<void *>(s_targets[index]) : nullptr;
+    }
+
+    /// The magic target @p index stores; the bench takes its signature up to and including these four bytes.
+    __declspec(dllexport) std::uint32_t dmk_bench_target_magic(std::size_t index)
+    {
+        return BENCH_MAGIC_BASE + static_cast<std::uint32_t>(index);
+    }
+
+    /// Writes the synthetic RTTI of classes [0, @p count) once, named ".?AVBenchTypeNNNN@@"; returns how many exist.
+    __declspec(dllexport) std::size_t dmk_bench_build_rtti(std::size_t count)
+    {
+        const std::size_t wanted = count < BENCH_TARGETS ? count : BENCH_TARGETS;
+        for (; s_rtti_built < wanted; ++s_rtti_built)
+        {
+            build_rtti_slot(s_rtti_built);
+        }
+        return s_rtti_built;
+    }
+
+    /// The vtable of synthetic class @p index, or nullptr when it has not been built.
+    __declspec(dllexport) const void *dmk_bench_rtti_vtable(std::size_t index)
+    {
+        return index < s_rtti_built ? s_rtti_pool.data() + (index * RTTI_SLOT_SIZE) + RTTI_VTABLE_OFFSET : nullptr;
+    }
+}
+
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD ul_reason_for_call, LPVOID lpReserved)
+{
+    (void)hModule;
+    (void)ul_reason_for_call;
+    (void)lpReserved;
+    return TRUE;
+}
@@ -8,9 +8,9 @@
  *          would write into freed memory during DLL unload or process exit.
  *
  *          The proof does not depend on a sanitizer. This translation unit replaces the global allocation operators
- *          with a size-targeted poisoning allocator. The profiler's fixed 2 MiB ring buffer is the only allocation
- *          above POISON_THRESHOLD, so only that buffer is served from a dedicated VirtualAlloc region; when it is
- *          freed, the region is flipped to PAGE_NOACCESS and leaked rather than released, so its address cannot be
+ *          with a size-targeted poisoning allocator. The profiler's fixed 2 MiB ring buffers (the shared ring and the
+ *          main thread's own) are the only allocations above POISON_THRESHOLD, so only they are served from dedicated
+ *          VirtualAlloc regions; when one is freed, the region is flipped to PAGE_NOACCESS and leaked rather than released, so its address cannot be
  *          recycled and any later access faults immediately instead of silently touching still-committed freed heap.
  *
  *          The ordering is arranged so a record() runs AFTER the profiler would have been destroyed. A namespace-scope
@@ -36,13 +36,13 @@
 
 namespace
 {
-    // The profiler ring buffer is DEFAULT_CAPACITY (65536) * sizeof(ProfileSample) (32) = 2 MiB. One mebibyte is well
-    // above any incidental allocation this tiny driver makes and comfortably below the ring buffer, so the threshold
-    // isolates exactly the profiler buffer for poisoning; everything else goes to the ordinary heap.
+    // A profiler ring buffer is DEFAULT_CAPACITY (131072) * sizeof(ProfileSample) (16) = 2 MiB. One mebibyte is well
+    // above any incidental allocation this tiny driver makes and comfortably below a ring buffer, so the threshold
+    // isolates exactly the profiler buffers for poisoning; everything else goes to the ordinary heap.
     constexpr std::size_t POISON_THRESHOLD = 0x100000; // 1 MiB
 
-    // A fixed, allocation-free registry of the large regions served from VirtualAlloc. A single run makes exactly one
-    // such allocation (the ring buffer); a few slots is ample. It must never call into operator new itself, so it is a
+    // A fixed, allocation-free registry of the large regions served from VirtualAlloc. A single run makes exactly two
+    // such allocations (the shared ring and the main thread's ring); a few slots is ample. It must never call into operator new itself, so it is a
     // plain aggregate with constant (zero) initialization, which guarantees it is ready before the first allocation of
     // static initialization.
     struct PoisonRegistry
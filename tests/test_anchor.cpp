@@ -9,6 +9,7 @@
 #include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include "DetourModKit/anchor.hpp"
 #include "DetourModKit/scan.hpp"
@@ -245,6 +246,73 @@ TEST(AnchorTest, RipGlobalResolvesToAddress)
     EXPECT_EQ(static_cast<std::uintptr_t>(result.value), page.addr(0x200));
 }
 
+// last_seen_rva forwards to the cascade's hint window, and the report says which stage answered.
+TEST(AnchorTest, LastSeenRvaReportsTheHintWindowSource)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    page.put(0x300, {0xCA, 0xFE, 0xBA, 0xBE, 0x10, 0x20, 0x30, 0x40});
+
+    const sc::Candidate cands[] = {sc::Candidate::direct("unique", aob("CA FE BA BE 10 20 30 40"))};
+    an::Anchor global{};
+    global.label = "global";
+    global.kind = an::AnchorKind::RipGlobal;
+    global.site = cands;
+    const an::ResolvedAnchor full = an::resolve(global, page.range());
+    EXPECT_EQ(full.status, an::AnchorStatus::Resolved);
+    EXPECT_EQ(full.source, sc::HitSource::Ladder);
+
+    global.last_seen_rva = 0x300;
+    const an::ResolvedAnchor hinted = an::resolve(global, page.range());
+    EXPECT_EQ(hinted.status, an::AnchorStatus::Resolved);
+    EXPECT_EQ(static_cast<std::uintptr_t>(hinted.value), page.addr(0x300));
+    EXPECT_EQ(hinted.source, sc::HitSource::HintWindow);
+}
+
+// A RegionSet scope: the cascade proves uniqueness across every span, while a CodeOperand resolves span by span and is
+// kept only when the spans agree.
+TEST(AnchorTest, RegionSetScopeResolvesAcrossSpans)
+{
+    ScratchPage first;
+    ScratchPage second;
+    ASSERT_TRUE(first.ok());
+    ASSERT_TRUE(second.ok());
+    first.put(0x200, {0xDE, 0xAD, 0xBE, 0xEF, 0x10, 0x20, 0x30, 0x40});
+    second.put(0x200, {0xDE, 0xAD, 0xBE, 0xEF, 0x10, 0x20, 0x30, 0x40});
+    second.put(0x300, {0xCA, 0xFE, 0xBA, 0xBE, 0x10, 0x20, 0x30, 0x40});
+
+    const std::array<dmk::Region, 2> spans = {first.range(), second.range()};
+    const dmk::Result<dmk::RegionSet> scope = dmk::RegionSet::of(spans);
+    ASSERT_TRUE(scope.has_value());
+
+    const sc::Candidate cands[] = {sc::Candidate::direct("split", aob("DE AD BE EF 10 20 30 40")),
+                                   sc::Candidate::direct("unique", aob("CA FE BA BE 10 20 30 40"))};
+    an::Anchor global{};
+    global.label = "global";
+    global.kind = an::AnchorKind::RipGlobal;
+    global.site = cands;
+    const an::ResolvedAnchor resolved = an::resolve(global, *scope);
+    EXPECT_EQ(resolved.status, an::AnchorStatus::Resolved);
+    EXPECT_EQ(static_cast<std::uintptr_t>(resolved.value), second.addr(0x300));
+
+    // A CodeOperand resolves span by span; only the first span holds its site, so that span's answer is the report's.
+    first.put(0x400, {0x48, 0x05, 0xF0, 0x00, 0x00, 0x00});
+    const sc::Candidate add_imm[] = {sc::Candidate::direct("add-imm", aob("48 05 F0 00 00 00"))};
+    an::Anchor stride{};
+    stride.label = "stride";
+    stride.kind = an::AnchorKind::CodeOperand;
+    stride.site = add_imm;
+    stride.operand_kind = sc::OperandKind::Immediate;
+    stride.operand_index = 1;
+    const an::ResolvedAnchor operand = an::resolve(stride, *scope);
+    EXPECT_EQ(operand.status, an::AnchorStatus::Resolved);
+    EXPECT_EQ(operand.value, 0xF0);
+
+    // An empty set fails closed.
+    const an::ResolvedAnchor empty = an::resolve(global, dmk::RegionSet{});
+    EXPECT_EQ(empty.status, an::AnchorStatus::Failed);
+}
+
 // The RipGlobal byte ladder honors the Anchor::pages knob. A byte run planted in a readable, NON-executable data page
 // resolves under the default Readable class, but is invisible once the anchor narrows to Executable -- so a caller that
 // knows its RipGlobal target is reached only through in-image code can reject a coincidental data-page twin and turn a
@@ -731,6 +799,70 @@ TEST(ScanExportTest, OutOfImageFunctionRvaFailsClosed)
     EXPECT_EQ(result.error().code, dmk::ErrorCode::ExportNotFound);
 }
 
+TEST(ScanExportTest, BatchResolveMatchesSingleLookups)
+{
+    ExportFixture fixture;
+    ASSERT_TRUE(fixture.ok());
+    const dmk::Region module = dmk::Region::module_named(ExportFixture::MODULE_NAME);
+
+    const std::array<std::string_view, 6> names = {"compute_damage", "compute_armor", "NoSuchExportZZZ",
+                                                   "",               "compute_speed", "compute_critical"};
+    const auto batch = sc::resolve_exports(names, module);
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_EQ(batch->size(), names.size());
+    for (std::size_t i = 0; i < names.size(); ++i)
+    {
+        const dmk::Result<dmk::Address> single = sc::resolve_export(names[i], module);
+        ASSERT_EQ((*batch)[i].has_value(), single.has_value()) << names[i];
+        if (single.has_value())
+        {
+            EXPECT_EQ((*batch)[i]->raw(), single->raw());
+            EXPECT_EQ(single->raw(), fixture.proc(std::string{names[i]}.c_str()));
+        }
+        else
+        {
+            EXPECT_EQ((*batch)[i].error().code, dmk::ErrorCode::ExportNotFound);
+        }
+    }
+
+    const auto no_module = sc::resolve_exports(names, dmk::Region{});
+    ASSERT_TRUE(no_module.has_value());
+    EXPECT_EQ((*no_module)[0].error().code, dmk::ErrorCode::InvalidRange);
+    EXPECT_EQ((*no_module)[3].error().code, dmk::ErrorCode::ExportNotFound);
+    EXPECT_TRUE(sc::resolve_exports({}, module)->empty());
+}
+
+TEST(ScanExportTest, IndexedLookupTracksTableRewrites)
+{
+    // The first lookup indexes the image. Ordinals and function RVAs are read live, so rewriting them changes the
+    // verdict at once; a rewrite that changes the directory (a second, duplicate name) rebuilds the index.
+    SyntheticExportImage image;
+    ASSERT_TRUE(image.ok());
+    ASSERT_TRUE(sc::resolve_export("fixture_export", image.range()).has_value());
+
+    image.put(SyntheticExportImage::FUNCTIONS_RVA, std::uint32_t{SyntheticExportImage::TARGET_RVA + 0x10});
+    const dmk::Result<dmk::Address> moved = sc::resolve_export("fixture_export", image.range());
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved->raw(), image.range().base.raw() + SyntheticExportImage::TARGET_RVA + 0x10);
+
+    IMAGE_EXPORT_DIRECTORY exports = image.get<IMAGE_EXPORT_DIRECTORY>(SyntheticExportImage::EXPORT_RVA);
+    exports.NumberOfNames = 2;
+    image.put(SyntheticExportImage::EXPORT_RVA, exports);
+    image.put(SyntheticExportImage::NAMES_RVA + sizeof(std::uint32_t), SyntheticExportImage::NAME_RVA);
+    image.put(SyntheticExportImage::ORDINALS_RVA + sizeof(std::uint16_t), std::uint16_t{0});
+    const dmk::Result<dmk::Address> duplicate = sc::resolve_export("fixture_export", image.range());
+    ASSERT_FALSE(duplicate.has_value());
+    EXPECT_EQ(duplicate.error().code, dmk::ErrorCode::ExportNotFound);
+
+    // A rename under an unchanged directory fails the live re-check of the indexed slot, so the walk answers.
+    exports.NumberOfNames = 1;
+    image.put(SyntheticExportImage::EXPORT_RVA, exports);
+    ASSERT_TRUE(sc::resolve_export("fixture_export", image.range()).has_value());
+    image.put_string(SyntheticExportImage::NAME_RVA, "renamed_export");
+    EXPECT_FALSE(sc::resolve_export("fixture_export", image.range()).has_value());
+    ASSERT_TRUE(sc::resolve_export("renamed_export", image.range()).has_value());
+}
+
 TEST(AnchorTest, ExportNameCaseSensitiveMatch)
 {
     ExportFixture fixture;
@@ -924,6 +1056,151 @@ TEST(AnchorTest, ResolveAllParallelMatchesSerialReport)
     }
 }
 
+// A table whose RipGlobal rungs reach the multi-pattern threshold is prescanned in one sweep; every entry must still
+// match its single-anchor resolve, including a twice-planted marker that fails closed as ambiguous.
+TEST(AnchorTest, ResolveAllPrescannedTableMatchesSingleAnchorResolve)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+
+    constexpr std::size_t COUNT = 10;
+    std::vector<sc::Candidate> cands;
+    cands.reserve(COUNT);
+    std::array<an::Anchor, COUNT> anchors{};
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        const auto tag = static_cast<std::uint8_t>(0x10 + i);
+        page.put(0x100 + i * 0x40, {0xDE, 0xAD, 0xBE, 0xEF, tag, 0x20, 0x30, 0x40});
+        cands.push_back(sc::Candidate::direct("marker", aob("DE AD BE EF " + std::to_string(10 + i) + " 20 30 40")));
+        anchors[i].label = "global";
+        anchors[i].kind = an::AnchorKind::RipGlobal;
+        anchors[i].site = std::span<const sc::Candidate>(&cands[i], 1);
+    }
+    // Plant the last marker a second time so its anchor is ambiguous.
+    page.put(0xF00, {0xDE, 0xAD, 0xBE, 0xEF, 0x19, 0x20, 0x30, 0x40});
+
+    std::array<an::ResolvedAnchor, COUNT> report{};
+    ASSERT_EQ(an::resolve_all(anchors, report, page.range()), COUNT);
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        const an::ResolvedAnchor single = an::resolve(anchors[i], page.range());
+        EXPECT_EQ(report[i].status, single.status) << "anchor=" << i;
+        EXPECT_EQ(report[i].value, single.value) << "anchor=" << i;
+    }
+    EXPECT_EQ(static_cast<std::uintptr_t>(report[0].value), page.addr(0x100));
+    EXPECT_EQ(report[COUNT - 1].status, an::AnchorStatus::Failed);
+}
+
+// CodeOperand site ladders join the table prescan in their Executable page class; each constant must still decode
+// exactly as its single-anchor resolve does, serially and on the pool.
+TEST(AnchorTest, ResolveAllPrescannedCodeOperandsMatchSingleAnchorResolve)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+
+    constexpr std::size_t COUNT = 10;
+    std::vector<sc::Candidate> cands;
+    cands.reserve(COUNT);
+    std::array<an::Anchor, COUNT> anchors{};
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        const auto imm = static_cast<std::uint8_t>(0x20 + i);
+        page.put(0x100 + i * 0x40, {0x48, 0x05, imm, 0x00, 0x00, 0x00}); // add rax, imm
+        cands.push_back(sc::Candidate::direct("add-imm", aob("48 05 " + std::to_string(20 + i) + " 00 00 00")));
+        anchors[i].label = "stride";
+        anchors[i].kind = an::AnchorKind::CodeOperand;
+        anchors[i].site = std::span<const sc::Candidate>(&cands[i], 1);
+        anchors[i].operand_index = 1;
+    }
+    // Plant the last instruction a second time so its anchor is ambiguous.
+    page.put(0xF00, {0x48, 0x05, 0x29, 0x00, 0x00, 0x00});
+
+    std::array<an::ResolvedAnchor, COUNT> serial{};
+    std::array<an::ResolvedAnchor, COUNT> parallel{};
+    ASSERT_EQ(an::resolve_all(anchors, serial, page.range()), COUNT);
+    ASSERT_EQ(an::resolve_all_parallel(anchors, parallel, page.range(), 4), COUNT);
+    for (std::size_t i = 0; i < COUNT; ++i)
+    {
+        const an::ResolvedAnchor single = an::resolve(anchors[i], page.range());
+        EXPECT_EQ(serial[i].status, single.status) << "anchor=" << i;
+        EXPECT_EQ(serial[i].value, single.value) << "anchor=" << i;
+        EXPECT_EQ(parallel[i].status, single.status) << "anchor=" << i;
+        EXPECT_EQ(parallel[i].value, single.value) << "anchor=" << i;
+    }
+    EXPECT_EQ(serial[0].value, 0x20);
+    EXPECT_EQ(serial[COUNT - 1].status, an::AnchorStatus::Failed);
+}
+
+// A child anchor scans its parent's window, not the table scope: its instruction appears twice in the page, once
+// inside the function the parent found, so it is ambiguous on its own and unique under its parent.
+TEST(AnchorTest, ResolveAllScansAChildInsideItsResolvedParent)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    page.put(0x100, {0xDE, 0xAD, 0xBE, 0xEF, 0x51, 0x52, 0x53, 0x54});
+    page.put(0x140, {0x48, 0x05, 0xF0, 0x00, 0x00, 0x00}); // add rax, 0xF0
+    page.put(0x800, {0x48, 0x05, 0xF0, 0x00, 0x00, 0x00});
+    const sc::Candidate function_start[] = {sc::Candidate::direct("fn", aob("DE AD BE EF 51 52 53 54"))};
+    const sc::Candidate missing[] = {sc::Candidate::direct("missing", aob("DE AD BE EF 61 62 63 64"))};
+    const sc::Candidate add_imm[] = {sc::Candidate::direct("add-imm", aob("48 05 F0 00 00 00"))};
+
+    an::Anchor anchors[4]{};
+    anchors[0].label = "child";
+    anchors[0].kind = an::AnchorKind::CodeOperand;
+    anchors[0].site = add_imm;
+    anchors[0].operand_index = 1;
+    anchors[0].parent = 1;
+    anchors[0].parent_window = 0x80;
+    anchors[1].label = "function";
+    anchors[1].kind = an::AnchorKind::RipGlobal;
+    anchors[1].site = function_start;
+    anchors[2].label = "missing";
+    anchors[2].kind = an::AnchorKind::RipGlobal;
+    anchors[2].site = missing;
+    anchors[3] = anchors[0];
+    anchors[3].label = "orphan";
+    anchors[3].parent = 2;
+
+    an::ResolvedAnchor serial[4]{};
+    an::ResolvedAnchor parallel[4]{};
+    ASSERT_EQ(an::resolve_all(anchors, serial, page.range()), 4u);
+    ASSERT_EQ(an::resolve_all_parallel(anchors, parallel, page.range(), 4), 4u);
+    for (const an::ResolvedAnchor *report : {serial, parallel})
+    {
+        EXPECT_EQ(static_cast<std::uintptr_t>(report[1].value), page.addr(0x100));
+        EXPECT_EQ(report[0].status, an::AnchorStatus::Resolved);
+        EXPECT_EQ(report[0].value, 0xF0);
+        EXPECT_EQ(report[2].status, an::AnchorStatus::Failed);
+        // Its parent did not resolve, so it fails without scanning.
+        EXPECT_EQ(report[3].status, an::AnchorStatus::Failed);
+    }
+    // On its own the child's instruction is ambiguous.
+    EXPECT_EQ(an::resolve(anchors[0], page.range()).status, an::AnchorStatus::Failed);
+}
+
+TEST(AnchorTest, ResolveAllFailsAChildOnACycleClosed)
+{
+    an::Anchor anchors[3]{};
+    anchors[0].label = "a";
+    anchors[0].kind = an::AnchorKind::Manual;
+    anchors[0].manual_value = 0x1000;
+    anchors[0].parent = 1;
+    anchors[1].label = "b";
+    anchors[1].kind = an::AnchorKind::Manual;
+    anchors[1].manual_value = 0x2000;
+    anchors[1].parent = 0;
+    anchors[2].label = "root";
+    anchors[2].kind = an::AnchorKind::Manual;
+    anchors[2].manual_value = 3;
+
+    an::ResolvedAnchor report[3]{};
+    ASSERT_EQ(an::resolve_all_parallel(anchors, report, dmk::Region::host(), 2), 3u);
+    EXPECT_EQ(report[0].status, an::AnchorStatus::Failed);
+    EXPECT_EQ(report[1].status, an::AnchorStatus::Failed);
+    EXPECT_EQ(report[2].status, an::AnchorStatus::Resolved);
+    EXPECT_EQ(report[2].value, 3);
+}
+
 TEST(AnchorTest, ResolveAllRespectsCapacity)
 {
     an::Anchor anchors[3]{};
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <array>
 #include <thread>
 #include <chrono>
 #include <atomic>
@@ -169,6 +170,42 @@ TEST_F(AsyncLoggerTest, HonorsConfiguredTimestampFormat)
     EXPECT_TRUE(found);
 }
 
+TEST_F(AsyncLoggerTest, CachedStampHead_EveryLineKeepsFormatAndItsOwnMilliseconds)
+{
+    AsyncLoggerConfig config;
+    config.batch_size = 16;
+    config.flush_interval = std::chrono::milliseconds{50};
+    config.timestamp_format = "%Y/%m/%d STAMP";
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+
+    // Lines spread over a few milliseconds within (mostly) one second share the cached date/time head; each must
+    // still carry the full head and three millisecond digits of its own.
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+    constexpr int kMessages = 40;
+    for (int i = 0; i < kMessages; ++i)
+    {
+        ASSERT_TRUE(logger->enqueue(LogLevel::Info, "stamped_" + std::to_string(i)));
+        if (i % 8 == 7)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        }
+    }
+    logger->shutdown();
+
+    std::ifstream file(m_test_log_file);
+    const std::regex stamp(R"(^\[\d{4}/\d{2}/\d{2} STAMP\.\d{3}\] \[INFO   \] :: stamped_\d+$)");
+    std::string line;
+    int seen = 0;
+    while (std::getline(file, line))
+    {
+        EXPECT_TRUE(std::regex_match(line, stamp)) << line;
+        ++seen;
+    }
+    EXPECT_EQ(seen, kMessages);
+}
+
 TEST_F(AsyncLoggerTest, Enqueue_ReturnsTrue_OnSuccess)
 {
     AsyncLoggerConfig config;
@@ -537,6 +574,53 @@ TEST(AsyncLoggerConfigTest, Validate_RejectsCapacityBelowTwo)
     EXPECT_FALSE(config.validate());
 }
 
+TEST(AsyncLoggerConfigTest, Validate_RejectsNonPowerOfTwoLaneCapacity)
+{
+    AsyncLoggerConfig config;
+    EXPECT_EQ(config.transport, LogTransport::SharedQueue);
+    config.lane_capacity = 100;
+    EXPECT_FALSE(config.validate());
+    config.lane_capacity = 1;
+    EXPECT_FALSE(config.validate());
+    config.lane_capacity = 256;
+    EXPECT_TRUE(config.validate());
+}
+
+TEST(AsyncLoggerConfigTest, Validate_BoundsTheOverlappedSinkSettings)
+{
+    AsyncLoggerConfig config;
+    EXPECT_FALSE(config.overlapped_writes);
+    EXPECT_EQ(config.flush_threshold, 0u);
+    config.write_buffer_count = 1;
+    EXPECT_FALSE(config.validate());
+    config.write_buffer_count = MAX_WRITE_BUFFER_COUNT + 1;
+    EXPECT_FALSE(config.validate());
+    config.write_buffer_count = MAX_WRITE_BUFFER_COUNT;
+    config.write_buffer_size = 1024;
+    EXPECT_FALSE(config.validate());
+    config.write_buffer_size = DEFAULT_WRITE_BUFFER_SIZE;
+    config.flush_threshold = DEFAULT_WRITE_BUFFER_SIZE + 1;
+    EXPECT_FALSE(config.validate());
+    config.flush_threshold = DEFAULT_WRITE_BUFFER_SIZE / 2;
+    EXPECT_TRUE(config.validate());
+}
+
+TEST(AsyncLoggerConfigTest, Validate_RateLimitBounds)
+{
+    AsyncLoggerConfig config;
+    EXPECT_EQ(config.rate_limit_per_second, 0u);
+    EXPECT_FALSE(config.collapse_duplicates);
+    config.rate_limit_per_second = MAX_RATE_LIMIT_PER_SECOND + 1;
+    EXPECT_FALSE(config.validate());
+    config.rate_limit_per_second = 100;
+    config.rate_limit_burst = 0;
+    EXPECT_FALSE(config.validate());
+    config.rate_limit_burst = MAX_RATE_LIMIT_BURST + 1;
+    EXPECT_FALSE(config.validate());
+    config.rate_limit_burst = MAX_RATE_LIMIT_BURST;
+    EXPECT_TRUE(config.validate());
+}
+
 TEST(AsyncLoggerConfigTest, Validate_RejectsZeroBatch)
 {
     AsyncLoggerConfig config;
@@ -1460,6 +1544,274 @@ TEST_F(AsyncLoggerTest, MultiThread_EnqueueStress)
     logger.shutdown();
 }
 
+TEST_F(AsyncLoggerTest, OverlappedWrites_FlushPutsEveryLineOnFileInOrder)
+{
+    AsyncLoggerConfig config;
+    config.overlapped_writes = true;
+    config.write_buffer_size = 4096;
+    config.write_buffer_count = 3;
+    config.flush_threshold = 2048;
+    config.overflow_policy = OverflowPolicy::Block;
+    config.block_timeout_ms = std::chrono::milliseconds{1000};
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    constexpr int kMessages = 2000;
+    for (int i = 0; i < kMessages; ++i)
+    {
+        ASSERT_TRUE(logger->enqueue(LogLevel::Info, "overlapped_msg_" + std::to_string(i)));
+    }
+
+    // flush() waits for the writer and then for every page still under the threshold or in flight.
+    EXPECT_TRUE(logger->flush_with_timeout(std::chrono::milliseconds(5000)));
+    {
+        std::ifstream in(m_test_log_file);
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        EXPECT_NE(content.find("overlapped_msg_" + std::to_string(kMessages - 1) + "\n"), std::string::npos);
+    }
+    logger->shutdown();
+    file_stream->close();
+
+    std::ifstream in(m_test_log_file);
+    const std::regex tag(R"(overlapped_msg_(\d+))");
+    int expected = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::smatch match;
+        ASSERT_TRUE(std::regex_search(line, match, tag)) << line;
+        EXPECT_EQ(std::stoi(match[1].str()), expected);
+        ++expected;
+    }
+    EXPECT_EQ(expected, kMessages);
+}
+
+TEST_F(AsyncLoggerTest, CollapseDuplicates_WritesARunOnceThenItsCount)
+{
+    AsyncLoggerConfig config;
+    config.collapse_duplicates = true;
+    config.overflow_policy = OverflowPolicy::Block;
+    config.block_timeout_ms = std::chrono::milliseconds{1000};
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    for (int i = 0; i < 10; ++i)
+    {
+        ASSERT_TRUE(logger->enqueue(LogLevel::Warning, "same warning"));
+    }
+    ASSERT_TRUE(logger->enqueue(LogLevel::Error, "same warning")); // another level is another line
+    ASSERT_TRUE(logger->enqueue(LogLevel::Info, "different"));
+    ASSERT_TRUE(logger->enqueue(LogLevel::Info, "different"));
+    logger->shutdown();
+    file_stream->close();
+
+    std::ifstream in(m_test_log_file);
+    std::vector<std::string> bodies;
+    for (std::string line; std::getline(in, line);)
+    {
+        bodies.push_back(line.substr(line.find("] [") + 2));
+    }
+    const std::vector<std::string> expected{"[WARNING] :: same warning", "[WARNING] :: last message repeated 9 times",
+                                            "[ERROR  ] :: same warning", "[INFO   ] :: different",
+                                            "[INFO   ] :: last message repeated 1 times"};
+    EXPECT_EQ(bodies, expected);
+    EXPECT_EQ(logger->dropped_count(), 0u);
+}
+
+TEST_F(AsyncLoggerTest, RateLimit_SuppressedLinesCountAsDropped)
+{
+    AsyncLoggerConfig config;
+    config.rate_limit_per_second = 1;
+    config.rate_limit_burst = 3;
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    int admitted = 0;
+    for (int i = 0; i < 10; ++i)
+    {
+        admitted += logger->admit_call_site(0x1234) ? 1 : 0;
+    }
+    // One more token may accrue if the loop straddles a second boundary, never more.
+    EXPECT_GE(admitted, 3);
+    EXPECT_LE(admitted, 4);
+    EXPECT_EQ(logger->dropped_count(), static_cast<size_t>(10 - admitted));
+    EXPECT_TRUE(logger->admit_call_site(0x5678)) << "a second call site has a bucket of its own";
+    logger->shutdown();
+}
+
+TEST_F(AsyncLoggerTest, RateLimit_OffAdmitsEverything)
+{
+    AsyncLoggerConfig config;
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+    for (int i = 0; i < 1000; ++i)
+    {
+        ASSERT_TRUE(logger->admit_call_site(0x1234));
+    }
+    EXPECT_EQ(logger->dropped_count(), 0u);
+    logger->shutdown();
+}
+
+TEST_F(AsyncLoggerTest, PerThreadLanes_KeepEachThreadsOrderAndAccountForEveryMessage)
+{
+    AsyncLoggerConfig config;
+    config.transport = LogTransport::PerThreadLanes;
+    config.lane_capacity = 256;
+    config.batch_size = 32;
+    config.overflow_policy = OverflowPolicy::DropNewest;
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    constexpr int num_threads = 4;
+    constexpr int msgs_per_thread = 500;
+    std::atomic<int> total_enqueued{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                for (int i = 0; i < msgs_per_thread; ++i)
+                {
+                    if (logger->enqueue(LogLevel::Info, "lane_" + std::to_string(t) + "_msg_" + std::to_string(i)))
+                    {
+                        total_enqueued.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+
+    EXPECT_TRUE(logger->flush_with_timeout(std::chrono::milliseconds(5000)));
+    EXPECT_EQ(logger->queue_size(), 0u);
+    EXPECT_EQ(total_enqueued.load() + static_cast<int>(logger->dropped_count()), num_threads * msgs_per_thread);
+    logger->shutdown();
+    file_stream->close();
+
+    // Messages from different threads may interleave, but each thread's own appear in the order it logged them.
+    std::ifstream in(m_test_log_file);
+    const std::regex tag(R"(lane_(\d+)_msg_(\d+))");
+    std::array<int, num_threads> last_seen;
+    last_seen.fill(-1);
+    int written = 0;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        std::smatch match;
+        if (!std::regex_search(line, match, tag))
+        {
+            continue;
+        }
+        const int thread_index = std::stoi(match[1].str());
+        const int message_index = std::stoi(match[2].str());
+        ASSERT_LT(thread_index, num_threads);
+        EXPECT_GT(message_index, last_seen[thread_index]) << line;
+        last_seen[thread_index] = message_index;
+        ++written;
+    }
+    EXPECT_EQ(written, total_enqueued.load());
+}
+
+TEST(LogLaneTableTest, HandsEachLiveThreadItsOwnLaneUpToTheLimit)
+{
+    LogLaneTable table(4);
+    LogLaneTable::Lane *mine = table.lane_for_current_thread();
+    ASSERT_NE(mine, nullptr);
+    EXPECT_EQ(table.lane_for_current_thread(), mine);
+    EXPECT_EQ(mine->queue.capacity(), 4u);
+
+    // MAX_LOG_LANES - 1 more live threads fill the table; one beyond that gets no lane.
+    constexpr size_t extra_threads = MAX_LOG_LANES;
+    std::vector<LogLaneTable::Lane *> lanes(extra_threads, nullptr);
+    std::atomic<size_t> arrived{0};
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < extra_threads; ++t)
+    {
+        threads.emplace_back(
+            [&, t]()
+            {
+                lanes[t] = table.lane_for_current_thread();
+                // Stay alive until every thread has asked, so no two of them can share a recycled thread id.
+                arrived.fetch_add(1, std::memory_order_acq_rel);
+                while (arrived.load(std::memory_order_acquire) < extra_threads)
+                {
+                    std::this_thread::yield();
+                }
+            });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+
+    const auto without_lane = static_cast<size_t>(std::count(lanes.begin(), lanes.end(), nullptr));
+    EXPECT_EQ(without_lane, 1u);
+    lanes.push_back(mine);
+    std::sort(lanes.begin(), lanes.end());
+    EXPECT_EQ(std::adjacent_find(lanes.begin() + 1, lanes.end()), lanes.end()) << "two threads shared a lane";
+    size_t published = 0;
+    for (size_t index = 0; index < MAX_LOG_LANES; ++index)
+    {
+        published += table.lane(index) != nullptr ? 1 : 0;
+    }
+    EXPECT_EQ(published, MAX_LOG_LANES);
+}
+
+TEST(CallSiteRateLimiterTest, BucketStartsFullAndRefillsAtTheConfiguredRate)
+{
+    CallSiteRateLimiter limiter(/*per_second=*/10, /*burst=*/4);
+    const std::uint64_t site = 0xABCDEF;
+    const std::uint64_t t0 = 1'000'000;
+
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(limiter.admit(site, t0)) << i;
+    }
+    EXPECT_FALSE(limiter.admit(site, t0));
+
+    // 10 lines per second is one token per 100 ms; polling more often still accrues the fractions.
+    EXPECT_FALSE(limiter.admit(site, t0 + 50));
+    EXPECT_TRUE(limiter.admit(site, t0 + 100));
+    EXPECT_FALSE(limiter.admit(site, t0 + 150));
+    EXPECT_TRUE(limiter.admit(site, t0 + 200));
+
+    // A long quiet spell refills only up to the burst.
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(limiter.admit(site, t0 + 60'000)) << i;
+    }
+    EXPECT_FALSE(limiter.admit(site, t0 + 60'000));
+}
+
+TEST(CallSiteRateLimiterTest, SitesHaveIndependentBucketsAndAFullTableFailsOpen)
+{
+    CallSiteRateLimiter limiter(/*per_second=*/1, /*burst=*/1);
+    EXPECT_TRUE(limiter.admit(1, 5000));
+    EXPECT_FALSE(limiter.admit(1, 5000));
+    EXPECT_TRUE(limiter.admit(2, 5000));
+    EXPECT_FALSE(limiter.admit(0, 5000)) << "site 0 is folded onto site 1, whose bucket is empty";
+
+    // Far more sites than entries: every untracked one is admitted rather than silenced.
+    size_t admitted = 0;
+    for (std::uint64_t site = 100; site < 100 + 4 * RATE_LIMIT_SITES; ++site)
+    {
+        admitted += limiter.admit(site, 5000) ? 1 : 0;
+    }
+    EXPECT_EQ(admitted, 4 * RATE_LIMIT_SITES);
+}
+
 TEST(StringPoolTest, AllocateDeallocate_BasicCycle)
 {
     auto &pool = StringPool::instance();
@@ -1566,7 +1918,7 @@ TEST(StringPoolTest, ReuseAfterDeallocate)
 
 TEST(StringPoolTest, GrowsAcrossMultipleAlignedBlocks)
 {
-    // Keep more slots live than a single block holds, forcing grow_pool_locked() to allocate several additional
+    // Keep more slots live than a single block holds, forcing grow_depot_locked() to allocate several additional
     // over-aligned blocks through the aligned operator new. Every allocation must succeed and stay independently
     // usable; a misaligned block would fault or trip the sanitizer probe rather than read back its stored value.
     auto &pool = StringPool::instance();
@@ -1594,6 +1946,66 @@ TEST(StringPoolTest, GrowsAcrossMultipleAlignedBlocks)
     }
 }
 
+TEST(StringPoolTest, RequestsTakeTheSmallestSizeClassAndSlotsStayClassSized)
+{
+    static_assert(MAX_POOLED_STRING_SIZE == POOL_SIZE_CLASSES.back() - 1);
+    auto &pool = StringPool::instance();
+
+    std::string *small = pool.allocate(10);
+    ASSERT_NE(small, nullptr);
+    EXPECT_GE(small->capacity(), POOL_SIZE_CLASSES[0] - 1);
+    EXPECT_LT(small->capacity(), POOL_SIZE_CLASSES[1] - 1);
+
+    std::string *large = pool.allocate(POOL_SIZE_CLASSES[1] + 1);
+    ASSERT_NE(large, nullptr);
+    EXPECT_GE(large->capacity(), POOL_SIZE_CLASSES[2] - 1);
+    EXPECT_LT(large->capacity(), POOL_SIZE_CLASSES[3] - 1);
+
+    // A slot grown past its class by the caller goes back to the pool at class size.
+    small->assign(POOL_SIZE_CLASSES[3], 'g');
+    pool.deallocate(small);
+    std::string *reused = pool.allocate(10);
+    ASSERT_NE(reused, nullptr);
+    EXPECT_TRUE(reused->empty());
+    EXPECT_LT(reused->capacity(), POOL_SIZE_CLASSES[1] - 1);
+
+    pool.deallocate(reused);
+    pool.deallocate(large);
+}
+
+TEST(StringPoolTest, SlotsFreedOnAnotherThreadReturnThroughTheDepot)
+{
+    auto &pool = StringPool::instance();
+    constexpr size_t kBurst = POOL_SLOTS_PER_BLOCK * 8;
+
+    std::vector<std::string *> ptrs;
+    ptrs.reserve(kBurst);
+    for (size_t round = 0; round < 3; ++round)
+    {
+        for (size_t i = 0; i < kBurst; ++i)
+        {
+            std::string *s = pool.allocate(700);
+            ASSERT_NE(s, nullptr);
+            s->assign(700, static_cast<char>('a' + (i % 26)));
+            ptrs.push_back(s);
+        }
+
+        // The writer frees what producers allocated: the freeing thread's magazine spills to the depot, and the
+        // next round's allocations refill from it.
+        std::thread writer(
+            [&pool, &ptrs]()
+            {
+                for (std::string *s : ptrs)
+                {
+                    EXPECT_EQ(s->size(), 700u);
+                    pool.deallocate(s);
+                }
+            });
+        writer.join();
+        ptrs.clear();
+    }
+}
+
 TEST(StringPoolTest, AllocationChainIsNoThrow)
 {
     // The logging hot path crosses noexcept boundaries (AsyncLogger::enqueue is noexcept), so every link of the
@@ -1903,6 +2315,42 @@ TEST_F(AsyncLoggerTest, ParkedWriterNeverStallsToFlushInterval)
     logger->shutdown();
 }
 
+TEST_F(AsyncLoggerTest, BacklogDrainsInOrderThroughGrownBatches)
+{
+    // batch_size 1 would take one sink-lock pass per message; a backlog grows the pass, and the lines must still land
+    // once each and in enqueue order.
+    AsyncLoggerConfig config;
+    config.batch_size = 1;
+    config.queue_capacity = 4096;
+    config.flush_interval = std::chrono::milliseconds{2000};
+
+    auto file_stream = std::make_shared<WinFileStream>(m_test_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    constexpr int MESSAGES = 2000;
+    for (int i = 0; i < MESSAGES; ++i)
+    {
+        ASSERT_TRUE(logger->enqueue(LogLevel::Info, "BACKLOG_" + std::to_string(i) + "_END"));
+    }
+    ASSERT_TRUE(logger->flush_with_timeout(std::chrono::milliseconds{1500}));
+    logger->shutdown();
+    file_stream->close();
+
+    std::ifstream in(m_test_log_file);
+    int expected = 0;
+    for (std::string line; std::getline(in, line);)
+    {
+        if (line.find("BACKLOG_") == std::string::npos)
+        {
+            continue;
+        }
+        ASSERT_NE(line.find("BACKLOG_" + std::to_string(expected) + "_END"), std::string::npos) << line;
+        ++expected;
+    }
+    EXPECT_EQ(expected, MESSAGES);
+}
+
 // The AsyncLogger destructor must be self-safe under the loader lock. shutdown() detaches the writer there (which keeps
 // reading the queue / cv / file stream until it observes the stop), so ~AsyncLogger must leak the Impl in place rather
 // than destroy those members out from under the detached writer. The real loader lock cannot be entered from user code,
@@ -0,0 +1,179 @@
+#include <gtest/gtest.h>
+
+#include "internal/background_service.hpp"
+
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+using namespace DetourModKit;
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    /// Polls @p done for up to @p limit, so a slow CI machine gets time without a fixed long sleep.
+    template <typename Done>
+    [[nodiscard]] bool eventually(Done done, std::chrono::milliseconds limit = 5000ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + limit;
+        while (!done())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+} // namespace
+
+TEST(BackgroundServiceTest, RejectsAnEmptyTaskOrAZeroPeriod)
+{
+    EXPECT_EQ(detail::schedule_background_timer("empty", 10ms, {}).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(detail::schedule_background_timer("zero", 0ms, []() {}).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(detail::watch_background_handle("null", nullptr, []() {}).error().code, ErrorCode::InvalidArg);
+}
+
+TEST(BackgroundServiceTest, TimersRunRepeatedlyUntilCancelled)
+{
+    std::atomic<int> runs{0};
+    const auto id = detail::schedule_background_timer("repeat", 5ms, [&runs]() { runs.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() >= 3; }));
+
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+    const int after_cancel = runs.load();
+    std::this_thread::sleep_for(30ms);
+    EXPECT_EQ(runs.load(), after_cancel);
+    // Cancelling twice, or a task that never existed, is harmless.
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+    EXPECT_TRUE(detail::cancel_background_task(detail::NO_BACKGROUND_TASK));
+}
+
+TEST(BackgroundServiceTest, WakeRunsATimerAheadOfItsPeriod)
+{
+    std::atomic<int> runs{0};
+    const auto id = detail::schedule_background_timer("woken", 1h, [&runs]() { runs.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+    detail::wake_background_task(*id);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() == 1; }));
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+}
+
+TEST(BackgroundServiceTest, HandleWatchRunsEachTimeTheEventIsSignaled)
+{
+    HANDLE event = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    ASSERT_NE(event, nullptr);
+    std::atomic<int> runs{0};
+    const auto id = detail::watch_background_handle("event", event, [&runs]() { runs.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+
+    SetEvent(event);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() == 1; }));
+    SetEvent(event);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() == 2; }));
+
+    // Once the cancel returns the service no longer waits on the handle, so closing it is safe.
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+    CloseHandle(event);
+}
+
+TEST(BackgroundServiceTest, TasksShareOneThread)
+{
+    std::atomic<DWORD> first_thread{0};
+    std::atomic<DWORD> second_thread{0};
+    const auto first = detail::schedule_background_timer(
+        "first", 2ms, [&first_thread]() { first_thread.store(GetCurrentThreadId()); });
+    const auto second = detail::schedule_background_timer(
+        "second", 3ms, [&second_thread]() { second_thread.store(GetCurrentThreadId()); });
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    const std::uint64_t started = detail::background_service_threads_started();
+
+    EXPECT_TRUE(eventually([&]() { return first_thread.load() != 0 && second_thread.load() != 0; }));
+    EXPECT_EQ(first_thread.load(), second_thread.load());
+    EXPECT_NE(first_thread.load(), GetCurrentThreadId());
+    EXPECT_EQ(detail::background_service_threads_started(), started);
+
+    EXPECT_TRUE(detail::cancel_background_task(*first));
+    EXPECT_TRUE(detail::cancel_background_task(*second));
+}
+
+TEST(BackgroundServiceTest, CancelWaitsForARunInProgress)
+{
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+    const auto id = detail::schedule_background_timer("slow", 1ms,
+                                                      [&entered, &finished]()
+                                                      {
+                                                          entered.store(true);
+                                                          std::this_thread::sleep_for(50ms);
+                                                          finished.store(true);
+                                                      });
+    ASSERT_TRUE(id.has_value());
+    ASSERT_TRUE(eventually([&entered]() { return entered.load(); }));
+
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(BackgroundServiceTest, ATaskThatThrowsKeepsTheServiceRunning)
+{
+    std::atomic<int> throws{0};
+    std::atomic<int> runs{0};
+    const auto thrower = detail::schedule_background_timer("thrower", 2ms,
+                                                           [&throws]()
+                                                           {
+                                                               throws.fetch_add(1);
+                                                               throw std::runtime_error("task failure");
+                                                           });
+    const auto steady = detail::schedule_background_timer("steady", 2ms, [&runs]() { runs.fetch_add(1); });
+    ASSERT_TRUE(thrower.has_value());
+    ASSERT_TRUE(steady.has_value());
+
+    EXPECT_TRUE(eventually([&]() { return throws.load() >= 2 && runs.load() >= 2; }));
+    EXPECT_TRUE(detail::cancel_background_task(*thrower));
+    EXPECT_TRUE(detail::cancel_background_task(*steady));
+}
+
+TEST(BackgroundServiceTest, ATaskCanCancelItself)
+{
+    std::atomic<int> runs{0};
+    std::atomic<detail::BackgroundTaskId> self{detail::NO_BACKGROUND_TASK};
+    const std::size_t registered = detail::background_task_count();
+    const auto id = detail::schedule_background_timer("self", 20ms,
+                                                      [&runs, &self]()
+                                                      {
+                                                          runs.fetch_add(1);
+                                                          EXPECT_TRUE(detail::on_background_service_thread());
+                                                          EXPECT_TRUE(detail::cancel_background_task(self.load()));
+                                                      });
+    ASSERT_TRUE(id.has_value());
+    self.store(*id);
+    EXPECT_EQ(detail::background_task_count(), registered + 1);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() >= 1; }));
+    EXPECT_TRUE(eventually([registered]() { return detail::background_task_count() == registered; }));
+    std::this_thread::sleep_for(60ms);
+    EXPECT_EQ(runs.load(), 1);
+}
+
+TEST(BackgroundServiceTest, ShutdownDropsTasksAndTheNextTaskRestartsTheThread)
+{
+    std::atomic<int> runs{0};
+    ASSERT_TRUE(detail::schedule_background_timer("dropped", 1h, []() {}).has_value());
+    const std::uint64_t started = detail::background_service_threads_started();
+
+    detail::shutdown_background_service();
+    EXPECT_EQ(detail::background_task_count(), 0u);
+
+    const auto id = detail::schedule_background_timer("restarted", 2ms, [&runs]() { runs.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(detail::background_service_threads_started(), started + 1);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() >= 1; }));
+    EXPECT_TRUE(detail::cancel_background_task(*id));
+}
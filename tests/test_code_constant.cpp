@@ -500,3 +500,95 @@ TEST(CodeConstantTest, InstructionCrossingIntoDataPageYieldsDecodeFailed)
     ASSERT_FALSE(value.has_value());
     EXPECT_EQ(value.error().code, ErrorCode::DecodeFailed);
 }
+
+TEST(CodeConstantTest, BatchMatchesSingleReadsSlotForSlot)
+{
+    CodeRegion region;
+    ASSERT_TRUE(region.ok());
+    region.put(0x300, {0x48, 0x05, 0xF0, 0x00, 0x00, 0x00});       // add rax, 0xF0
+    region.put(0x100, {0x0F, 0xB6, 0x81, 0x18, 0x02, 0x00, 0x00}); // movzx eax, byte [rcx+0x218]
+    region.put(0x200, {0x8B, 0x05, 0x00, 0x01, 0x00, 0x00});       // mov eax, [rip+0x100]
+    region.put(0xFFE, {0x48, 0x8B});                               // truncated at the end of the region
+
+    const scan::Candidate add[] = {scan::Candidate::direct("add-imm", aob("48 05 F0 00 00 00"))};
+    const scan::Candidate movzx[] = {scan::Candidate::direct("movzx", aob("0F B6 81 18 02 00 00"))};
+    const scan::Candidate riprel[] = {scan::Candidate::direct("riprel", aob("8B 05 00 01 00 00"))};
+    const scan::Candidate truncated[] = {scan::Candidate::direct("truncated", aob("48 8B"))};
+    const scan::Candidate absent[] = {scan::Candidate::direct("absent", aob("0F 0B 0F 0B 0F 0B"))};
+    const scan::CodeConstant constants[] = {
+        {.site = add, .kind = scan::OperandKind::Immediate, .operand_index = 1},
+        {.site = movzx, .kind = scan::OperandKind::MemoryDisplacement, .operand_index = 1},
+        {.site = riprel, .kind = scan::OperandKind::MemoryDisplacement, .operand_index = 1},
+        {.site = truncated, .kind = scan::OperandKind::Immediate, .operand_index = 1},
+        {.site = absent, .kind = scan::OperandKind::Immediate, .operand_index = 1},
+        {.site = add, .kind = scan::OperandKind::MemoryDisplacement, .operand_index = 1},
+    };
+
+    // One slot more than the batch, to show it is left alone.
+    const Result<std::int64_t> sentinel = std::unexpected(Error{ErrorCode::Unknown, "sentinel"});
+    Result<std::int64_t> out[std::size(constants) + 1] = {sentinel, sentinel, sentinel, sentinel, sentinel, sentinel,
+                                                          sentinel};
+    const Result<void> batch = scan::read_code_constants(constants, out, region.range());
+    ASSERT_TRUE(batch.has_value()) << batch.error().message();
+
+    for (std::size_t i = 0; i < std::size(constants); ++i)
+    {
+        const Result<std::int64_t> single = scan::read_code_constant(constants[i], region.range());
+        ASSERT_EQ(out[i].has_value(), single.has_value()) << "slot " << i;
+        if (single.has_value())
+        {
+            EXPECT_EQ(*out[i], *single) << "slot " << i;
+        }
+        else
+        {
+            EXPECT_EQ(out[i].error().code, single.error().code) << "slot " << i;
+        }
+    }
+    EXPECT_EQ(*out[0], 0xF0);
+    EXPECT_EQ(*out[1], 0x218);
+    EXPECT_EQ(static_cast<std::uintptr_t>(*out[2]), region.addr(0x200) + 6 + 0x100);
+    EXPECT_EQ(out[3].error().code, ErrorCode::DecodeFailed);
+    EXPECT_EQ(out[4].error().code, ErrorCode::NoMatch);
+    EXPECT_EQ(out[5].error().code, ErrorCode::UnexpectedShape);
+    EXPECT_EQ(out[std::size(constants)].error().code, ErrorCode::Unknown);
+}
+
+TEST(CodeConstantTest, BatchFallsBackPerSiteWhenItsSpanCrossesIntoData)
+{
+    // Both sites sit in one shared window, but the window runs into the data page, so each site is checked and read
+    // on its own: the site wholly in code still decodes, and the one whose instruction crosses the boundary fails.
+    SplitCodeDataImage image;
+    ASSERT_TRUE(image.ok());
+    image.put(0x800, {0x48, 0x05, 0x2A, 0x00, 0x00, 0x00}); // add rax, 0x2A
+    image.put(0xFFE, {0x48, 0x05, 0xF0, 0x00, 0x00, 0x00}); // add rax, 0xF0, crossing into the data page
+
+    const scan::Candidate inside[] = {scan::Candidate::direct("inside-add", aob("48 05 2A"))};
+    const scan::Candidate crossing[] = {scan::Candidate::direct("boundary-add", aob("48 05 F0"))};
+    const scan::CodeConstant constants[] = {
+        {.site = crossing, .kind = scan::OperandKind::Immediate, .operand_index = 1},
+        {.site = inside, .kind = scan::OperandKind::Immediate, .operand_index = 1},
+    };
+    Result<std::int64_t> out[2];
+    const Result<void> batch = scan::read_code_constants(constants, out, image.range());
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_FALSE(out[0].has_value());
+    EXPECT_EQ(out[0].error().code, ErrorCode::DecodeFailed);
+    ASSERT_TRUE(out[1].has_value()) << out[1].error().message();
+    EXPECT_EQ(*out[1], 0x2A);
+}
+
+TEST(CodeConstantTest, BatchRejectsShortOutputWithoutTouchingIt)
+{
+    CodeRegion region;
+    ASSERT_TRUE(region.ok());
+    const scan::Candidate add[] = {scan::Candidate::direct("add-imm", aob("48 05 F0 00 00 00"))};
+    const scan::CodeConstant constants[] = {{.site = add}, {.site = add}};
+
+    Result<std::int64_t> out[1] = {std::int64_t{7}};
+    const Result<void> batch = scan::read_code_constants(constants, out, region.range());
+    ASSERT_FALSE(batch.has_value());
+    EXPECT_EQ(batch.error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(batch.error().detail, 1u);
+    ASSERT_TRUE(out[0].has_value());
+    EXPECT_EQ(*out[0], 7);
+}
@@ -1668,6 +1668,73 @@ TEST(BindingGuard, DestructorReleasesFlag)
     EXPECT_FALSE(outer.is_active());
 }
 
+// Snapshot tests
+
+TEST_F(ConfigTest, Snapshot_ReaderKeepsItsValueAcrossPublishes)
+{
+    config::Snapshot<std::string> snapshot{std::string("first")};
+    {
+        const auto reader = snapshot.read();
+        snapshot.publish("second");
+        snapshot.publish("third");
+        // The pinned value is still intact, and neither replaced value may be freed while the reader is alive.
+        EXPECT_EQ(reader.get(), "first");
+        EXPECT_EQ(snapshot.retired_count(), 2u);
+        EXPECT_EQ(*snapshot.read(), "third");
+    }
+    // With no reader left, the next publish frees everything retired, including its own predecessor.
+    snapshot.publish("fourth");
+    EXPECT_EQ(snapshot.retired_count(), 0u);
+    EXPECT_EQ(*snapshot.read(), "fourth");
+}
+
+TEST_F(ConfigTest, BindSnapshot_PublishesParsedValueOnLoadAndChangedReload)
+{
+    struct Range
+    {
+        int low = 0;
+        int high = 0;
+    };
+    const auto parse_range = [](std::string_view text)
+    {
+        Range range;
+        const size_t dash = text.find('-');
+        range.low = std::stoi(std::string(text.substr(0, dash)));
+        range.high = dash == std::string_view::npos ? range.low : std::stoi(std::string(text.substr(dash + 1)));
+        return range;
+    };
+
+    config::Snapshot<Range> range;
+    config::Snapshot<std::string> label;
+    config::bind_snapshot<Range>("S", "Range", "range", range, parse_range, "1-2");
+    config::bind_snapshot("S", "Label", "label", label, "none");
+    EXPECT_EQ(range.read()->high, 2);
+    EXPECT_EQ(*label.read(), "none");
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nRange=10-20\nLabel=hot\n";
+    }
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+    EXPECT_EQ(range.read()->low, 10);
+    EXPECT_EQ(range.read()->high, 20);
+    EXPECT_EQ(*label.read(), "hot");
+
+    // A reload that changes only Range republishes only Range.
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nRange=5\nLabel=hot\n";
+    }
+    const auto label_before = label.read();
+    const std::string *label_address = &label_before.get();
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(range.read()->low, 5);
+    EXPECT_EQ(range.read()->high, 5);
+    EXPECT_EQ(&label.read().get(), label_address);
+
+    config::clear();
+}
+
 // Reload tests
 
 TEST_F(ConfigTest, Reload_WithoutInitialLoad_ReturnsFalse)
@@ -1720,6 +1787,224 @@ TEST_F(ConfigTest, Reload_PreservesRegistrations)
     EXPECT_EQ(string_invocations.back(), "second");
 }
 
+// A reload re-runs only the setters whose parsed value changed and reports exactly those keys. The diff is on the
+// parsed value, not the raw text: respacing a combo list changes the bytes but not the combos.
+TEST_F(ConfigTest, Reload_AppliesOnlyChangedKeysAndReportsThem)
+{
+    std::vector<int> count_invocations;
+    std::vector<std::string> label_invocations;
+    std::vector<size_t> combo_invocations;
+    config::bind_int("S", "Count", "count", [&](int v) { count_invocations.push_back(v); }, 0);
+    config::bind_string(
+        "S", "Label", "label", [&](std::string_view v) { label_invocations.push_back(std::string(v)); },
+        std::string("default"));
+    config::bind_combos(
+        "S", "Keys", "keys", [&](const input::KeyComboList &combos) { combo_invocations.push_back(combos.size()); },
+        "F1");
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nCount=7\nLabel=first\nKeys=F1,F2\n";
+    }
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+    const size_t count_before = count_invocations.size();
+    const size_t label_before = label_invocations.size();
+    const size_t combo_before = combo_invocations.size();
+
+    // Only Count changes; a comment changes the bytes so the content hash alone cannot skip the pass.
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "; edited\n[S]\nCount=8\nLabel=first\nKeys=F1,F2\n";
+    }
+    std::vector<config::ConfigKey> changed;
+    EXPECT_TRUE(config::reload(changed));
+    EXPECT_EQ(changed, (std::vector<config::ConfigKey>{{"S", "Count"}}));
+    ASSERT_EQ(count_invocations.size(), count_before + 1);
+    EXPECT_EQ(count_invocations.back(), 8);
+    EXPECT_EQ(label_invocations.size(), label_before);
+    EXPECT_EQ(combo_invocations.size(), combo_before);
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nCount=8\nLabel=first\nKeys=F1 , F2\n";
+    }
+    EXPECT_TRUE(config::reload(changed));
+    EXPECT_TRUE(changed.empty());
+    EXPECT_EQ(combo_invocations.size(), combo_before);
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nCount=8\nLabel=first\nKeys=F1,F2,F3\n";
+    }
+    EXPECT_TRUE(config::reload(changed));
+    EXPECT_EQ(changed, (std::vector<config::ConfigKey>{{"S", "Keys"}}));
+    ASSERT_EQ(combo_invocations.size(), combo_before + 1);
+    EXPECT_EQ(combo_invocations.back(), 3u);
+    EXPECT_EQ(count_invocations.size(), count_before + 1);
+    EXPECT_EQ(label_invocations.size(), label_before);
+}
+
+// The diff stays exact at the key counts the largest mods bind: over thousands of keys a one-key edit runs one setter
+// and reports one key, and an edit to every key runs and reports all of them once.
+TEST_F(ConfigTest, Reload_DiffScalesToThousandsOfKeys)
+{
+    constexpr int KEYS = 5000;
+    std::atomic<int> setter_calls{0};
+    for (int i = 0; i < KEYS; ++i)
+    {
+        config::bind_int("S" + std::to_string(i / 100), "K" + std::to_string(i), "k",
+                         [&setter_calls](int) { setter_calls.fetch_add(1, std::memory_order_relaxed); }, 0);
+    }
+    const auto write_all = [this](int value, int first)
+    {
+        std::ofstream f(m_test_ini_file);
+        for (int i = 0; i < KEYS; ++i)
+        {
+            if (i % 100 == 0)
+            {
+                f << "[S" << i / 100 << "]\n";
+            }
+            f << "K" << i << "=" << (i == 0 ? first : value) << "\n";
+        }
+    };
+
+    write_all(1, 1);
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+
+    std::vector<config::ConfigKey> changed;
+    write_all(1, 2);
+    int before = setter_calls.load();
+    EXPECT_TRUE(config::reload(changed));
+    EXPECT_EQ(changed, (std::vector<config::ConfigKey>{{"S0", "K0"}}));
+    EXPECT_EQ(setter_calls.load() - before, 1);
+
+    write_all(3, 3);
+    before = setter_calls.load();
+    EXPECT_TRUE(config::reload(changed));
+    EXPECT_EQ(changed.size(), static_cast<size_t>(KEYS));
+    EXPECT_EQ(setter_calls.load() - before, KEYS);
+}
+
+// One ConfigReloaded per pass that changed anything, carrying all of its changed keys, emitted after every setter ran.
+TEST_F(ConfigTest, ReloadEvents_EmitOncePerPassWithEveryChangedKey)
+{
+    std::atomic<int> width{0};
+    std::atomic<int> height{0};
+    config::bind("S", "Width", "width", width, 1);
+    config::bind("S", "Height", "height", height, 1);
+
+    std::vector<config::ConfigReloaded> events;
+    std::vector<int> area_at_event;
+    Subscription sub = config::reload_events().subscribe(
+        [&](const config::ConfigReloaded &event)
+        {
+            events.push_back(event);
+            area_at_event.push_back(width.load() * height.load());
+        });
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nWidth=4\nHeight=3\n";
+    }
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+    ASSERT_EQ(events.size(), 1u) << "the first load reports every bound key in one event";
+    EXPECT_EQ(events[0].changed_keys, (std::vector<config::ConfigKey>{{"S", "Width"}, {"S", "Height"}}));
+    EXPECT_TRUE(events[0].all_applied);
+    EXPECT_EQ(area_at_event[0], 12);
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nWidth=5\nHeight=6\n";
+    }
+    std::vector<config::ConfigKey> changed;
+    EXPECT_TRUE(config::reload(changed));
+    ASSERT_EQ(events.size(), 2u);
+    EXPECT_EQ(events[1].changed_keys, changed) << "the event and the out-parameter report the same keys";
+    EXPECT_EQ(area_at_event[1], 30) << "both values are applied before the event";
+    EXPECT_TRUE(events[1].changed("S", "Height"));
+    EXPECT_FALSE(events[1].changed("S", "Depth"));
+
+    // Unchanged content, and a changed file whose values did not change, both emit nothing.
+    EXPECT_TRUE(config::reload());
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "; comment\n[S]\nWidth=5\nHeight=6\n";
+    }
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(events.size(), 2u);
+
+    sub.reset();
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[S]\nWidth=7\nHeight=6\n";
+    }
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(events.size(), 2u);
+}
+
+// on_keys_changed fires once per pass touching any of its keys, however many of them changed, and a throwing setter
+// shows up as all_applied == false.
+TEST_F(ConfigTest, OnKeysChanged_CoalescesDependentRebuildsPerPass)
+{
+    std::atomic<int> r{0};
+    std::atomic<int> g{0};
+    std::atomic<int> other{0};
+    config::bind("Color", "R", "r", r, 0);
+    config::bind("Color", "G", "g", g, 0);
+    config::bind("Misc", "Other", "other", other, 0);
+    config::bind_int(
+        "Color", "Fail", "fail",
+        [](int v)
+        {
+            if (v == 1)
+            {
+                throw std::runtime_error("setter boom");
+            }
+        },
+        0);
+
+    int rebuilds = 0;
+    bool last_all_applied = true;
+    Subscription sub = config::on_keys_changed({{"Color", "R"}, {"Color", "G"}, {"Color", "Fail"}},
+                                               [&](const config::ConfigReloaded &event)
+                                               {
+                                                   ++rebuilds;
+                                                   last_all_applied = event.all_applied;
+                                               });
+    ASSERT_TRUE(sub.active());
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[Color]\nR=1\nG=2\n[Misc]\nOther=1\n";
+    }
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+    EXPECT_EQ(rebuilds, 1);
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[Color]\nR=3\nG=4\n[Misc]\nOther=1\n";
+    }
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(rebuilds, 2) << "two watched keys changed, one rebuild";
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[Color]\nR=3\nG=4\n[Misc]\nOther=2\n";
+    }
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(rebuilds, 2) << "an unwatched key does not rebuild";
+
+    {
+        std::ofstream f(m_test_ini_file);
+        f << "[Color]\nR=3\nG=4\nFail=1\n[Misc]\nOther=2\n";
+    }
+    EXPECT_TRUE(config::reload());
+    EXPECT_EQ(rebuilds, 3);
+    EXPECT_FALSE(last_all_applied);
+
+    EXPECT_FALSE(config::on_keys_changed({}, {}).active()) << "an empty callback yields no subscription";
+}
+
 // Concurrent reload passes must be serialized so a slower stale pass cannot overwrite a fresher one and pin stale
 // state behind the content-hash short-circuit. The teeth: thread T1 reloads value 1 and parks mid-apply BEFORE it
 // stores its value, while still holding the pass lock; T2 then reloads value 2. With the pass-serialization mutex, T2
@@ -2653,7 +2938,7 @@ TEST_F(ConfigTest, Reload_ContentChanged_RunsSetters)
 
 TEST_F(ConfigTest, Reload_FileUnreadable_RetainsWithoutRerunningSetters)
 {
-    // Prime: load once so a value + hash exist, then delete the file so read_ini_bytes() returns nullopt inside
+    // Prime: load once so a value + hash exist, then delete the file so the mapping fails to open inside
     // reload(). reload() must still return true because the reload path existed and was handled, but a read failure
     // retains the last values instead of running the setter pass against a never-populated INI object. The setter count
     // therefore must not advance.
@@ -2820,8 +3105,8 @@ TEST_F(ConfigTest, Reload_WatcherPath_HashSkip_EmitsSettersRanFalse)
 
 TEST_F(ConfigTest, Reload_EmptyFile_DoesNotCrash)
 {
-    // SimpleIni treats a zero-byte buffer as SI_OK with no sections; a subsequent reload() against the same empty bytes
-    // must hash-skip.
+    // A zero-byte file cannot be mapped but still reads as an empty document with no sections; a subsequent reload()
+    // against the same empty bytes must hash-skip.
     std::atomic<int> setter_hits{0};
     config::bind_int("S", "K", "k", [&](int /*v*/) { setter_hits.fetch_add(1, std::memory_order_relaxed); }, 7);
 
@@ -2945,6 +3230,35 @@ TEST_F(ConfigTest, RegisterLogLevel_RoundTripFromIni)
     log().set_log_level(original);
 }
 
+TEST_F(ConfigTest, RegisterLogCategories_PinsOnlyListedCategories)
+{
+    {
+        std::ofstream ini_file(m_test_ini_file);
+        ini_file << "[Logging.Categories]\nScan=ERROR\n";
+    }
+
+    const LogLevel original = log().get_log_level();
+    log().set_log_level(LogLevel::Info);
+    config::bind_log_categories("Logging.Categories");
+    ASSERT_NO_THROW(config::load(m_test_ini_file.string()));
+    EXPECT_EQ(log().get_log_level(LogCategory::Scan), LogLevel::Error);
+    EXPECT_EQ(log().get_log_level(LogCategory::Hook), LogLevel::Info);
+
+    // Unlisted categories keep following the global level; clearing the key unpins the listed one.
+    log().set_log_level(LogLevel::Warning);
+    EXPECT_EQ(log().get_log_level(LogCategory::Hook), LogLevel::Warning);
+    EXPECT_EQ(log().get_log_level(LogCategory::Scan), LogLevel::Error);
+    {
+        std::ofstream ini_file(m_test_ini_file);
+        ini_file << "[Logging.Categories]\nScan=\n";
+    }
+    (void)config::reload();
+    EXPECT_EQ(log().get_log_level(LogCategory::Scan), LogLevel::Warning);
+
+    log().reset_log_level(LogCategory::Scan);
+    log().set_log_level(original);
+}
+
 TEST_F(ConfigTest, RegisterAtomic_BoolRoundTrip)
 {
     {
@@ -4,12 +4,10 @@
 #include <chrono>
 #include <filesystem>
 #include <fstream>
-#include <memory>
 #include <process.h>
 #include <stdexcept>
 #include <string>
 #include <thread>
-#include <type_traits>
 
 #include <windows.h>
 
@@ -20,15 +18,6 @@
 using namespace DetourModKit;
 using namespace std::chrono_literals;
 
-// The loader-lock fallback in ~ConfigWatcher heap-allocates a std::unique_ptr<Impl> via new (std::nothrow) and leaks
-// the cell to outlive the destructor. Impl is a private nested type, so this assertion guards the unique_ptr leak-cell
-// pattern at the type level rather than referencing Impl directly: if std::unique_ptr ever ceased to be
-// nothrow-move-constructible, the leak cell could no longer be constructed from a noexcept context without risking
-// std::terminate.
-static_assert(std::is_nothrow_move_constructible_v<std::unique_ptr<int>>,
-              "std::unique_ptr must remain nothrow-move-constructible for the "
-              "ConfigWatcher loader-lock leak path to keep ~ConfigWatcher noexcept honest.");
-
 namespace
 {
     class ConfigWatcherTest : public ::testing::Test
@@ -119,10 +108,8 @@ namespace
         EXPECT_NO_THROW(watcher.stop());
     }
 
-    // A benign start failure -- the worker's CreateFileW fails fast because the parent directory does not exist -- must
-    // NOT take the leak-on-timeout path. That path (leak the whole Impl instead of joining) exists only for a worker
-    // genuinely wedged past the 5 s handshake; a worker that reported failure is already returning, so start() joins it
-    // cleanly, leaks nothing, and leaves the watcher reusable.
+    // A benign start failure -- the service cannot open the directory because it does not exist -- must leak nothing:
+    // no directory is registered, so there is no read to abandon, and the watcher stays reusable.
     TEST_F(ConfigWatcherTest, BenignStartFailureDoesNotLeakAndStaysReusable)
     {
         const std::filesystem::path missing = m_temp_dir / "no_such_subdir" / "watched.ini";
@@ -170,9 +157,9 @@ namespace
 
     TEST_F(ConfigWatcherTest, IsWorkerThreadFalseAfterStop)
     {
-        // The worker publishes its thread id on entry and must clear it again as it exits. Otherwise the stored id
-        // outlives the worker, and a later OS-recycled thread id reusing that value would make is_worker_thread()
-        // return a false positive, suppressing a genuine stop request as a self-call.
+        // The dispatch thread is shared by every watch and outlives this watcher's registration, so is_worker_thread()
+        // must stop matching it once the watcher is stopped. Otherwise a stop requested from another watcher's
+        // callback would be mistaken for a self-call and suppressed.
         std::atomic<bool> observed{false};
         std::atomic<std::thread::id> cb_tid{};
         DetourModKit::detail::ConfigWatcher watcher(m_ini_path.string(), 50ms,
@@ -196,21 +183,18 @@ namespace
         watcher.stop();
         ASSERT_FALSE(watcher.is_running());
 
-        // stop() joins the worker, so by the time it returns the worker has run its exit guard and reset the slot to
-        // the no-thread id. The captured worker id must therefore no longer match.
+        // stop() drops the registration before it returns, so the captured dispatch thread id must no longer match.
         EXPECT_FALSE(watcher.is_worker_thread(worker_tid))
-            << "the stored worker id must reset on worker exit so a recycled thread id cannot suppress a stop";
+            << "a stopped watcher must not claim the shared dispatch thread as its own";
         EXPECT_FALSE(watcher.is_worker_thread(std::thread::id{}))
             << "a default (no-thread) id must never be reported as the worker";
     }
 
     TEST_F(ConfigWatcherTest, IsWorkerThreadFalseAfterEarlyExit)
     {
-        // Covers the worker's early-return path: the id is published on entry, then CreateFileW fails for a
-        // non-existent parent directory and the worker returns before the pump loop. The same scope guard must clear
-        // the id on that return, and start()'s failure path joins the worker before returning, so by the time start()
-        // reports false the slot is back to the no-thread id. Complements IsWorkerThreadFalseAfterStop, which covers
-        // the normal-exit reset with a captured worker id.
+        // Covers the failed-start path: the service cannot open a non-existent parent directory, so no watch is
+        // registered and no thread may be reported as the watcher's. Complements IsWorkerThreadFalseAfterStop, which
+        // covers the reset after a successful start.
         DetourModKit::detail::ConfigWatcher watcher((m_temp_dir / "nonexistent_subdir" / "file.ini").string(), 50ms,
                                                     []() {});
 
@@ -298,9 +282,9 @@ namespace
                                "fire";
     }
 
-    // The debounce deadline must be evaluated every pump iteration, not only on the idle WAIT_TIMEOUT branch. A
-    // rotating log file typically shares the watched directory, so its sub-debounce writes keep GetOverlappedResultEx
-    // completing with non-matching events and the loop never idles. This test keeps a sibling file churning for the
+    // The debounce deadline must be evaluated every pump iteration, not only when the completion wait times out. A
+    // rotating log file typically shares the watched directory, so its sub-debounce writes keep the directory's read
+    // completing with non-matching events and the pump never idles. This test keeps a sibling file churning for the
     // whole wait and asserts the single target write still fires.
     TEST_F(ConfigWatcherTest, Debounce_FiresUnderSustainedForeignChurn)
     {
@@ -392,8 +376,8 @@ namespace
         ASSERT_TRUE(watcher.start());
         ASSERT_TRUE(wait_until([&]() { return watcher.is_running(); }, 1s));
 
-        // Stop must return within ~200 ms (pump timeout is 100 ms; we give a generous 1 s ceiling to avoid flakiness on
-        // loaded CI machines).
+        // Stop only waits for this watch's directory read to drain, which completes as soon as it is cancelled; the
+        // generous 1 s ceiling avoids flakiness on loaded CI machines.
         const auto t0 = std::chrono::steady_clock::now();
         watcher.stop();
         const auto elapsed = std::chrono::steady_clock::now() - t0;
@@ -459,8 +443,8 @@ namespace
 
     TEST_F(ConfigWatcherTest, ParentDirectoryRemoved_WatcherExitsCleanly)
     {
-        // Parent-dir removal surfaces as ERROR_OPERATION_ABORTED from
-        // GetOverlappedResultEx. The worker must break the pump loop and the destructor must still run cleanly.
+        // Parent-dir removal fails the directory's read. The service must retire that directory without disturbing
+        // the pump, and the destructor must still run cleanly.
         const std::filesystem::path temp_parent =
             std::filesystem::temp_directory_path() /
             ("dmk_watcher_removetest_" + std::to_string(_getpid()) + "_" + std::to_string(::GetCurrentThreadId()));
@@ -516,11 +500,10 @@ namespace
         EXPECT_FALSE(watcher.is_running());
     }
 
-    // A reload callback that throws must be contained at the invocation site so the throw never unwinds the worker
-    // body. Otherwise WatchIoState's destructor would free the OVERLAPPED and notification buffer while the in-flight
-    // ReadDirectoryChangesW notify IRP still references them. The deterministic proof that the throw was caught rather
+    // A reload callback that throws must be contained at the invocation site so the throw never unwinds the service's
+    // dispatch loop, which every other watched file shares. The deterministic proof that the throw was caught rather
     // than allowed to unwind the loop is that a second edit still fires the callback: had the exception escaped, it
-    // would have torn down the whole pump loop, so no further callback could arrive.
+    // would have torn down the dispatch thread, so no further callback could arrive.
     TEST_F(ConfigWatcherTest, ThrowingCallbackIsContainedAndWatcherKeepsPumping)
     {
         std::atomic<int> fires{0};
@@ -536,20 +519,19 @@ namespace
         write_ini("[S]\nK=2\n");
         ASSERT_TRUE(wait_until([&]() { return fires.load() >= 1; }, 2s)) << "first throwing fire never arrived";
 
-        // Reachable only if the first throw did not unwind (and thereby destroy) the pump loop.
+        // Reachable only if the first throw did not unwind (and thereby end) the dispatch loop.
         write_ini("[S]\nK=3\n");
         EXPECT_TRUE(wait_until([&]() { return fires.load() >= 2; }, 2s))
             << "watcher stopped pumping after a throwing callback -- the exception escaped the invocation site";
 
-        // Still alive, and it tears down cleanly on scope exit (the drain runs; no crash from a skipped CancelIoEx).
+        // Still alive, and it tears down cleanly on scope exit (the directory's read drains before stop() returns).
         EXPECT_TRUE(watcher.is_running());
     }
 
-    // The worker invokes the callback from two sites: the debounce-timeout fire above, and the final flush when it
-    // exits with a pending change (stop() / destruction). This covers the flush site: a long debounce means the change
-    // is still pending when stop() drives the worker out, so the pending edit flushes through the same guarded
-    // fire_reload at the end of the worker body. A throw there must stay contained so stop() joins cleanly rather than
-    // letting the exception unwind past the IRP drain.
+    // A callback reaches the dispatch thread two ways: the debounce-timeout fire above, and the flush stop() requests
+    // for a change still pending (stop() / destruction). This covers the flush: a long debounce means the change is
+    // still pending when stop() runs, so it is queued and delivered through the same guarded invocation while stop()
+    // waits. A throw there must stay contained so stop() returns cleanly.
     TEST_F(ConfigWatcherTest, ThrowingCallbackIsContainedOnStopTimeFlush)
     {
         std::atomic<int> fires{0};
@@ -567,17 +549,17 @@ namespace
         write_ini("[S]\nK=9\n");
         std::this_thread::sleep_for(200ms);
 
-        // stop() drives the worker's exit, which flushes the pending change through the guarded fire_reload and then
-        // joins. A contained throw means stop() returns without crashing or hanging.
+        // stop() flushes the pending change through the guarded invocation and waits for it. A contained throw means
+        // stop() returns without crashing or hanging.
         watcher.stop();
 
         EXPECT_EQ(fires.load(), 1) << "stop() must flush the pending change exactly once through the guarded callback";
         EXPECT_FALSE(watcher.is_running());
     }
 
-    // is_running() must not read the non-atomic m_impl->worker unique_ptr while start() assigns it and stop() moves it
-    // out under start_mutex. Hammer is_running() from one thread while another churns start()/stop(); the accessor uses
-    // the atomic worker-thread id, so this must neither crash nor hang.
+    // is_running() reads the registration id without start_mutex while start() publishes it and stop() clears it.
+    // Hammer is_running() from one thread while another churns start()/stop(); the id is atomic, so this must neither
+    // crash nor hang.
     TEST_F(ConfigWatcherTest, IsRunningConcurrentWithStartStopIsRaceFree)
     {
         DetourModKit::detail::ConfigWatcher watcher(m_ini_path.string(), 50ms, []() {});
@@ -607,9 +589,9 @@ namespace
 
 // Loader-lock detach tests. The real loader-lock branch (detected by reading the PEB inside DllMain) cannot be reached
 // from user code in a normal test process, so the runtime exposes a test-only function pointer override that reports
-// "loader lock held" on demand. These tests exercise the leak-on-loader-lock branch in ~ConfigWatcher: the worker is
-// detached instead of joined, the Impl is moved into a per-call heap cell allocated via new (std::nothrow) that
-// outlives the destructor, and the watcher does not deadlock.
+// "loader lock held" on demand. These tests exercise the loader-lock branch in ~ConfigWatcher: the registration is
+// detached from the file-watch service instead of waited for, the service keeps the callback alive for a run already
+// in progress, and the watcher does not deadlock.
 namespace DetourModKit::detail
 {
     extern bool (*g_config_watcher_loader_lock_override)() noexcept;
@@ -645,9 +627,9 @@ namespace
         }
         const auto elapsed = std::chrono::steady_clock::now() - t_start;
 
-        // Without the loader-lock override the destructor takes the normal join path. A clean join completes well under
-        // a second; a hang (e.g. a regression that joined under loader lock) would blow past the GetOverlappedResultEx
-        // pump timeout repeatedly.
+        // Without the loader-lock override the destructor takes the normal stop path, which waits for the directory
+        // read to drain. A clean stop completes well under a second; a hang (e.g. a regression that waited on a
+        // cancelled read that never completes) would blow past the ceiling.
         EXPECT_LT(elapsed, std::chrono::seconds(3));
     }
 
@@ -660,31 +642,28 @@ namespace
             ASSERT_TRUE(watcher.start());
             ASSERT_TRUE(wait_until([&]() { return watcher.is_running(); }, 1s));
 
-            // Flip the override on so ~ConfigWatcher takes the leak branch. The detach path must not block, must not
-            // call join(), and must keep the worker's captured pointers valid by leaking the Impl into a static vector.
+            // Flip the override on so ~ConfigWatcher takes the detach branch. The detach path must not block and must
+            // not wait on the dispatch thread.
             g_config_watcher_loader_lock_override = &always_true_loader_lock;
         }
         const auto elapsed = std::chrono::steady_clock::now() - t_start;
 
-        // Under loader lock the destructor returns essentially immediately:
-        // request_stop on the worker, detach, leak. The OS thread continues running but no longer blocks the
-        // destructor.
-        EXPECT_LT(elapsed, std::chrono::seconds(2)) << "Loader-lock detach branch must not join the worker";
+        // Under loader lock the destructor returns essentially immediately: it drops the registration and leaves the
+        // directory's read to the pump.
+        EXPECT_LT(elapsed, std::chrono::seconds(2)) << "Loader-lock detach branch must not wait on the service";
     }
 
     TEST_F(ConfigWatcherLoaderLockTest, MultipleLoaderLockTeardownsAreSafe)
     {
-        // Confirms the per-call heap leak path accepts multiple invocations without tripping the single-slot overwrite
-        // hazard that the
-        // Logger::shutdown_internal per-call-cell discipline avoids. Each teardown allocates its own cell via new
-        // (std::nothrow), so prior leaked Impls are never overwritten.
+        // Confirms repeated loader-lock teardowns of the same file are safe: each detach retires only its own
+        // registration, and a later start() attaches to whatever directory read the service still holds.
         for (int i = 0; i < 3; ++i)
         {
             DetourModKit::detail::ConfigWatcher watcher(m_ini_path.string(), 50ms, []() {});
             ASSERT_TRUE(watcher.start());
             ASSERT_TRUE(wait_until([&]() { return watcher.is_running(); }, 1s));
             g_config_watcher_loader_lock_override = &always_true_loader_lock;
-            // Watcher destructor on scope exit takes the leak path.
+            // Watcher destructor on scope exit takes the detach path.
         }
         SUCCEED();
     }
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <windows.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <utility>
+
+#include "DetourModKit/anchor.hpp"
+#include "DetourModKit/deferred.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    // The cross-module fixture the hook integration and anchor tests load; CMake copies it next to the test binary.
+    constexpr const char *FIXTURE_NAME = "hook_target_lib.dll";
+
+    // With no export_module the anchor resolves within its scope, which the registry sets to the mapped image.
+    [[nodiscard]] std::array<anchor::Anchor, 1> fixture_anchors()
+    {
+        anchor::Anchor entry;
+        entry.label = "compute_damage";
+        entry.kind = anchor::AnchorKind::ExportName;
+        entry.export_name = "compute_damage";
+        return {entry};
+    }
+
+    struct Delivery
+    {
+        Region image;
+        anchor::AnchorStatus status = anchor::AnchorStatus::Unresolved;
+        std::int64_t value = 0;
+        bool installed = false;
+    };
+} // namespace
+
+TEST(DeferredTest, RejectsMissingModuleOrCallback)
+{
+    deferred::DeferredTable unnamed;
+    unnamed.on_load = [](deferred::ModuleLoad &) {};
+    const auto no_name = deferred::on_module_load(std::move(unnamed));
+    ASSERT_FALSE(no_name.has_value());
+    EXPECT_EQ(no_name.error().code, ErrorCode::InvalidArg);
+
+    deferred::DeferredTable silent;
+    silent.module = FIXTURE_NAME;
+    const auto no_callback = deferred::on_module_load(std::move(silent));
+    ASSERT_FALSE(no_callback.has_value());
+    EXPECT_EQ(no_callback.error().code, ErrorCode::InvalidArg);
+}
+
+// Registered before the fixture maps (or after, if another test left it loaded): either way the table fires once,
+// on the worker, with the anchor resolved inside the fixture's image.
+TEST(DeferredTest, ResolvesAnchorsWhenModuleMaps)
+{
+    // Borrowed by the registration, so it must outlive it.
+    static const std::array<anchor::Anchor, 1> anchors = fixture_anchors();
+    auto promise = std::make_shared<std::promise<Delivery>>();
+    std::future<Delivery> delivered = promise->get_future();
+
+    deferred::DeferredTable table;
+    table.module = "HOOK_TARGET_LIB";
+    table.anchors = anchors;
+    table.on_load = [promise](deferred::ModuleLoad &load)
+    {
+        Delivery delivery;
+        delivery.image = load.image;
+        delivery.installed = load.install.has_value() && load.hooks.empty();
+        if (load.anchors.size() == 1)
+        {
+            delivery.status = load.anchors[0].status;
+            delivery.value = load.anchors[0].value;
+        }
+        promise->set_value(delivery);
+    };
+    auto registration = deferred::on_module_load(std::move(table));
+    ASSERT_TRUE(registration.has_value());
+
+    const HMODULE module = LoadLibraryA(FIXTURE_NAME);
+    ASSERT_NE(module, nullptr) << "Failed to load " << FIXTURE_NAME << ": " << GetLastError();
+
+    ASSERT_EQ(delivered.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    const Delivery delivery = delivered.get();
+    const auto expected = reinterpret_cast<std::uintptr_t>(GetProcAddress(module, "compute_damage"));
+    EXPECT_TRUE(delivery.image.contains(Address{expected}));
+    EXPECT_EQ(delivery.status, anchor::AnchorStatus::Resolved);
+    EXPECT_EQ(static_cast<std::uintptr_t>(delivery.value), expected);
+    EXPECT_TRUE(delivery.installed);
+
+    // A fired table retires; its registration is no longer pending and cancelling it is a no-op.
+    registration->cancel();
+    EXPECT_FALSE(registration->is_pending());
+    FreeLibrary(module);
+}
+
+TEST(DeferredTest, CancelAndShutdownWithdrawPendingTables)
+{
+    const std::size_t before = deferred::pending_count();
+    const auto make_table = []()
+    {
+        deferred::DeferredTable table;
+        table.module = "dmk_never_loaded_module.dll";
+        table.on_load = [](deferred::ModuleLoad &) { ADD_FAILURE() << "a module that never maps fired its table"; };
+        return table;
+    };
+
+    auto cancelled = deferred::on_module_load(make_table());
+    auto dropped = deferred::on_module_load(make_table());
+    ASSERT_TRUE(cancelled.has_value());
+    ASSERT_TRUE(dropped.has_value());
+    EXPECT_TRUE(cancelled->is_pending());
+    EXPECT_EQ(deferred::pending_count(), before + 2);
+
+    cancelled->cancel();
+    EXPECT_FALSE(cancelled->is_pending());
+    EXPECT_EQ(deferred::pending_count(), before + 1);
+
+    deferred::shutdown();
+    EXPECT_FALSE(dropped->is_pending());
+    EXPECT_EQ(deferred::pending_count(), 0U);
+
+    // The registry starts over after a shutdown.
+    auto again = deferred::on_module_load(make_table());
+    ASSERT_TRUE(again.has_value());
+    EXPECT_TRUE(again->is_pending());
+}
@@ -1,8 +1,12 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "DetourModKit/address.hpp"
@@ -66,6 +70,14 @@ namespace
         diag::HookKind kind;
         diag::HookTransition transition;
     };
+
+    // The stats entry for the live hook named `name`, or nullptr.
+    [[nodiscard]] const diag::HookStats *find_stats(const diag::Snapshot &snapshot, std::string_view name) noexcept
+    {
+        const auto it = std::find_if(snapshot.hook_stats.begin(), snapshot.hook_stats.end(),
+                                     [name](const diag::HookStats &entry) { return entry.name == name; });
+        return it == snapshot.hook_stats.end() ? nullptr : &*it;
+    }
 } // namespace
 
 // The counters are process-global. ctest runs each test in its own process, and the instrumented loader-lock paths
@@ -455,3 +467,72 @@ TEST_F(DiagnosticsSnapshotTest, SameNamedHooksOnDistinctTargetsEachCountAndSurvi
     EXPECT_EQ(restored.hooks_active, before.hooks_active);
     EXPECT_EQ(restored.hooks_disabled, before.hooks_disabled);
 }
+
+#ifdef DMK_ENABLE_HOOK_STATS
+TEST_F(DiagnosticsSnapshotTest, HookStatsCountGuardedCallsIntoTheOriginal)
+{
+    {
+        Result<hook::Hook> r = hook::inline_at(
+            hook::InlineRequest{.name = "StatsInline", .target = target_address(&lifecycle_target_add)},
+            &lifecycle_detour_add);
+        ASSERT_TRUE(r.has_value()) << r.error().message();
+        hook::Hook h = std::move(*r);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            EXPECT_EQ(h.call<int>(i, 1), i + 1);
+        }
+        // The raw trampoline bypasses the gate, so it is not counted.
+        EXPECT_EQ(h.original<int (*)(int, int)>()(2, 3), 5);
+
+        const diag::Snapshot snapshot = diag::collect();
+        const diag::HookStats *stats = find_stats(snapshot, "StatsInline");
+        ASSERT_NE(stats, nullptr);
+        EXPECT_EQ(stats->kind, diag::HookKind::Inline);
+        EXPECT_EQ(stats->calls, 10u);
+        EXPECT_EQ(std::accumulate(stats->latency_buckets.begin(), stats->latency_buckets.end(), std::uint64_t{0}),
+                  10u);
+        EXPECT_GT(snapshot.hook_stats_tick_frequency, 0);
+    }
+
+    // A torn-down hook drops out of the report.
+    EXPECT_EQ(find_stats(diag::collect(), "StatsInline"), nullptr);
+}
+
+TEST_F(DiagnosticsSnapshotTest, HookStatsTimeTheMidDetourBody)
+{
+    static int s_detour_runs = 0;
+    s_detour_runs = 0;
+    auto detour = [](hook::MidContext &) { ++s_detour_runs; };
+    Result<hook::Hook> r =
+        hook::mid_at(hook::MidRequest{.name = "StatsMid", .target = target_address(&lifecycle_target_mul)}, detour);
+    ASSERT_TRUE(r.has_value()) << r.error().message();
+    hook::Hook h = std::move(*r);
+
+    int (*volatile target)(int, int) = &lifecycle_target_mul;
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_EQ(target(i, 3), i * 3);
+    }
+    EXPECT_EQ(s_detour_runs, 5);
+
+    const diag::HookStats *stats = find_stats(diag::collect(), "StatsMid");
+    ASSERT_NE(stats, nullptr);
+    EXPECT_EQ(stats->kind, diag::HookKind::Mid);
+    EXPECT_EQ(stats->calls, 5u);
+}
+#else
+TEST_F(DiagnosticsSnapshotTest, HookStatsStayEmptyWithoutTheBuildSwitch)
+{
+    Result<hook::Hook> r =
+        hook::inline_at(hook::InlineRequest{.name = "StatsOff", .target = target_address(&lifecycle_target_add)},
+                        &lifecycle_detour_add);
+    ASSERT_TRUE(r.has_value()) << r.error().message();
+    hook::Hook h = std::move(*r);
+    EXPECT_EQ(h.call<int>(1, 2), 3);
+
+    const diag::Snapshot snapshot = diag::collect();
+    EXPECT_TRUE(snapshot.hook_stats.empty());
+    EXPECT_EQ(snapshot.hook_stats_tick_frequency, 0);
+}
+#endif
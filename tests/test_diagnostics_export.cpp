@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DetourModKit/diagnostics_export.hpp"
+#include "DetourModKit/metrics.hpp"
+
+#include <process.h> // _getpid for collision-free section names under parallel CTest
+
+namespace diag = DetourModKit::diagnostics;
+using DetourModKit::ErrorCode;
+
+namespace
+{
+    std::string unique_name(std::string_view test)
+    {
+        return std::string("Local\\DetourModKit.Test.") + std::string(test) + "." + std::to_string(_getpid());
+    }
+
+    const diag::MetricSample *find_sample(const std::vector<diag::MetricSample> &samples, std::string_view name)
+    {
+        const auto it = std::ranges::find(samples, name, &diag::MetricSample::name);
+        return it == samples.end() ? nullptr : &*it;
+    }
+} // namespace
+
+TEST(DiagnosticsExportTest, ReaderSeesPublishedMetrics)
+{
+    const auto counter = diag::register_counter("test.export.reader_sees");
+    ASSERT_TRUE(counter.has_value());
+    counter->add(7);
+
+    // A long period, so every publish in this test is the one start() or publish_now() made.
+    auto exported = diag::SharedExport::start({.name = unique_name("ReaderSees"), .period = std::chrono::hours(1)});
+    ASSERT_TRUE(exported.has_value()) << exported.error().message();
+
+    const auto first = diag::read_shared_export(exported->name());
+    ASSERT_TRUE(first.has_value()) << first.error().message();
+    EXPECT_EQ(first->sequence % 2, 0u);
+    EXPECT_GT(first->published_at_us, 0);
+    const diag::MetricSample *sample = find_sample(first->metrics, "test.export.reader_sees");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->kind, diag::MetricKind::Counter);
+    EXPECT_EQ(sample->count, 7u);
+
+    counter->add(3);
+    exported->publish_now();
+    const auto second = diag::read_shared_export(exported->name());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->sequence, first->sequence + 2);
+    sample = find_sample(second->metrics, "test.export.reader_sees");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->count, 10u);
+}
+
+TEST(DiagnosticsExportTest, SectionClosesWithTheExport)
+{
+    const std::string name = unique_name("Closes");
+    {
+        auto exported = diag::SharedExport::start({.name = name, .period = std::chrono::hours(1)});
+        ASSERT_TRUE(exported.has_value());
+        EXPECT_TRUE(diag::read_shared_export(name).has_value());
+    }
+    const auto gone = diag::read_shared_export(name);
+    ASSERT_FALSE(gone.has_value());
+    EXPECT_EQ(gone.error().code, ErrorCode::FileOpenFailed);
+}
+
+TEST(DiagnosticsExportTest, StartRejectsZeroPeriod)
+{
+    const auto exported = diag::SharedExport::start({.name = unique_name("ZeroPeriod"), .period = {}});
+    ASSERT_FALSE(exported.has_value());
+    EXPECT_EQ(exported.error().code, ErrorCode::InvalidArg);
+}
+
+TEST(DiagnosticsExportTest, DecodeRejectsForeignAndUnpublishedSections)
+{
+    std::vector<std::byte> section(diag::EXPORT_SECTION_SIZE);
+    const auto blank = diag::decode_shared_export(section);
+    ASSERT_FALSE(blank.has_value());
+    EXPECT_EQ(blank.error().code, ErrorCode::MissingHeader);
+
+    const auto write_u64 = [&section](std::size_t at, std::uint64_t value)
+    { std::memcpy(section.data() + at, &value, sizeof(value)); };
+    const auto write_u32 = [&section](std::size_t at, std::uint32_t value)
+    { std::memcpy(section.data() + at, &value, sizeof(value)); };
+    write_u64(diag::EXPORT_MAGIC_OFFSET, diag::EXPORT_MAGIC);
+    write_u32(diag::EXPORT_VERSION_OFFSET, diag::EXPORT_VERSION);
+    write_u32(diag::EXPORT_SIZE_OFFSET, static_cast<std::uint32_t>(diag::EXPORT_SECTION_SIZE));
+
+    // Sequence 0: the header is there but nothing was published.
+    const auto unpublished = diag::decode_shared_export(section);
+    ASSERT_FALSE(unpublished.has_value());
+    EXPECT_EQ(unpublished.error().code, ErrorCode::MissingHeader);
+
+    // A publish that never finishes (the writer died mid-copy) is reported rather than waited on.
+    write_u64(diag::EXPORT_SEQUENCE_OFFSET, 3);
+    const auto torn = diag::decode_shared_export(section);
+    ASSERT_FALSE(torn.has_value());
+    EXPECT_EQ(torn.error().code, ErrorCode::MalformedLine);
+
+    write_u64(diag::EXPORT_SEQUENCE_OFFSET, 4);
+    write_u32(diag::EXPORT_METRIC_COUNT_OFFSET, static_cast<std::uint32_t>(diag::EXPORT_MAX_METRICS + 1));
+    const auto overfull = diag::decode_shared_export(section);
+    ASSERT_FALSE(overfull.has_value());
+    EXPECT_EQ(overfull.error().code, ErrorCode::MalformedLine);
+
+    write_u32(diag::EXPORT_METRIC_COUNT_OFFSET, 0);
+    const auto empty = diag::decode_shared_export(section);
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->sequence, 4u);
+    EXPECT_TRUE(empty->metrics.empty());
+}
+
+TEST(DiagnosticsExportTest, ReadMissingSectionFailsClosed)
+{
+    const auto missing = diag::read_shared_export(unique_name("NoSuchSection"));
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, ErrorCode::FileOpenFailed);
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <cstddef>
 #include <cstdio>
 #include <span>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "DetourModKit/detail/drift_manifest.hpp"
 #include "DetourModKit/rtti_dissect.hpp"
@@ -208,3 +211,113 @@ TEST(DriftManifestTest, ManifestErrorCodesStringifyDistinctly)
     EXPECT_FALSE(to_string(ErrorCode::FileOpenFailed).empty());
     EXPECT_FALSE(to_string(ErrorCode::FileWriteFailed).empty());
 }
+
+TEST(DriftManifestTest, BinaryRoundTripReadsEntriesInPlace)
+{
+    const std::string name_a = ".?AVFoo@@";
+    const std::string name_b = ".?AVBar@@";
+    DriftEntry entries[3];
+    entries[0].name = name_a;
+    entries[0].nominal_offset = 0x10;
+    entries[0].healed_offset = 0x18;
+    entries[0].delta = 0x8;
+    entries[0].ok = true;
+    entries[1].name = name_b;
+    entries[1].nominal_offset = 0x40;
+    entries[1].ok = false;
+    entries[1].error = ErrorCode::HealAmbiguous;
+    // An empty name and a negative delta still round-trip.
+    entries[2].nominal_offset = 0x30;
+    entries[2].healed_offset = 0x20;
+    entries[2].delta = -0x10;
+    entries[2].ok = true;
+
+    const auto blob = rtti::serialize_drift_report_binary(entries);
+    ASSERT_TRUE(blob.has_value());
+    const auto view = rtti::DriftReportView::parse(*blob);
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->size(), 3u);
+
+    const DriftEntry first = (*view)[0];
+    EXPECT_EQ(first.name, name_a);
+    EXPECT_EQ(first.nominal_offset, 0x10);
+    EXPECT_EQ(first.healed_offset, 0x18);
+    EXPECT_EQ(first.delta, 0x8);
+    EXPECT_TRUE(first.ok);
+    EXPECT_EQ(first.error, ErrorCode::Ok);
+    // The name aliases the blob rather than a copy.
+    EXPECT_GE(reinterpret_cast<const std::byte *>(first.name.data()), blob->data());
+    EXPECT_LT(reinterpret_cast<const std::byte *>(first.name.data()), blob->data() + blob->size());
+
+    EXPECT_EQ((*view)[1].name, name_b);
+    EXPECT_FALSE((*view)[1].ok);
+    EXPECT_EQ((*view)[1].error, ErrorCode::HealAmbiguous);
+
+    EXPECT_TRUE((*view)[2].name.empty());
+    EXPECT_EQ((*view)[2].delta, -0x10);
+}
+
+TEST(DriftManifestTest, BinaryEmptyReportParsesEmpty)
+{
+    const auto blob = rtti::serialize_drift_report_binary({});
+    ASSERT_TRUE(blob.has_value());
+    const auto view = rtti::DriftReportView::parse(*blob);
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->empty());
+}
+
+TEST(DriftManifestTest, BinaryParseRejectsCorruptAndTruncatedBlobs)
+{
+    DriftEntry entry;
+    entry.name = ".?AVFoo@@";
+    entry.nominal_offset = 8;
+    entry.ok = true;
+    const auto blob = rtti::serialize_drift_report_binary(std::span<const DriftEntry>(&entry, 1));
+    ASSERT_TRUE(blob.has_value());
+
+    // A flipped name byte fails the checksum.
+    std::vector<std::byte> corrupt = *blob;
+    corrupt.back() ^= std::byte{0x01};
+    const auto flipped = rtti::DriftReportView::parse(corrupt);
+    ASSERT_FALSE(flipped.has_value());
+    EXPECT_EQ(flipped.error().code, ErrorCode::MalformedLine);
+
+    // A torn write disagrees with the header's total size.
+    const auto torn = rtti::DriftReportView::parse(std::span<const std::byte>(*blob).first(blob->size() - 1));
+    ASSERT_FALSE(torn.has_value());
+    EXPECT_EQ(torn.error().code, ErrorCode::MissingHeader);
+
+    // A text manifest is not a binary report.
+    const std::string text = rtti::serialize_drift_report(std::span<const DriftEntry>(&entry, 1));
+    const auto wrong_magic = rtti::DriftReportView::parse(std::as_bytes(std::span<const char>(text)));
+    ASSERT_FALSE(wrong_magic.has_value());
+    EXPECT_EQ(wrong_magic.error().code, ErrorCode::MissingHeader);
+}
+
+TEST(DriftManifestTest, BinaryFileRoundTripThroughMapping)
+{
+    DriftEntry entry;
+    entry.name = ".?AVFileFoo@@";
+    entry.nominal_offset = 0x20;
+    entry.healed_offset = 0x28;
+    entry.delta = 8;
+    entry.ok = true;
+
+    const std::string path = std::string("dmk_drift_binary_test_") + std::to_string(_getpid()) + ".tmp";
+    const auto written = rtti::write_drift_report_binary_to_file(path, std::span<const DriftEntry>(&entry, 1));
+    ASSERT_TRUE(written.has_value());
+    {
+        auto mapped = rtti::MappedDriftReport::open(path);
+        ASSERT_TRUE(mapped.has_value());
+        // The view survives a move of its owner: it points into the mapped pages.
+        const rtti::MappedDriftReport report = std::move(*mapped);
+        ASSERT_EQ(report.view().size(), 1u);
+        EXPECT_EQ(report.view()[0].name, ".?AVFileFoo@@");
+        EXPECT_EQ(report.view()[0].healed_offset, 0x28);
+    }
+    std::remove(path.c_str());
+
+    const auto missing = rtti::MappedDriftReport::open("dmk_definitely_no_such_binary_report.tmp");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, ErrorCode::FileOpenFailed);
+}
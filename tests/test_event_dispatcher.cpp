@@ -1,16 +1,23 @@
 #include <gtest/gtest.h>
 
-// Enables the test-only debug_snapshot_use_count() diagnostic on the dispatcher. Defined here (before the header
+// Enables the test-only debug_retired_snapshot_count() diagnostic on the dispatcher. Defined here (before the header
 // include) so it affects only this translation unit.
 #define DMK_EVENT_DISPATCHER_INTERNAL_TESTING 1
 
 #include "DetourModKit/detail/event_dispatcher.hpp"
 
+#include "test_alloc_probe.hpp"
+
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <mutex>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -384,6 +391,81 @@ TEST(EventDispatcherTest, SubscribeEmptyHandler_IsRejected)
     EXPECT_NO_THROW(dispatcher.emit_safe(SimpleEvent{1}));
 }
 
+TEST(EventDispatcherTest, SubscribeNullFunctionPointer_IsRejected)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    void (*null_handler)(const SimpleEvent &) = nullptr;
+
+    auto sub = dispatcher.subscribe(null_handler);
+
+    EXPECT_FALSE(sub.active());
+    EXPECT_EQ(dispatcher.subscriber_count(), 0u);
+}
+
+// Inline handler storage
+
+TEST(EventDispatcherTest, InlineHandler_IsOneCacheLine)
+{
+    EXPECT_EQ(sizeof(detail::InlineHandler<SimpleEvent>), 64u);
+}
+
+TEST(EventDispatcherTest, SmallCapture_SubscribesWithoutItsOwnAllocation)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    // The first subscribe sizes the retired-snapshot list; later ones reuse its capacity.
+    {
+        auto warm = dispatcher.subscribe([](const SimpleEvent &) {});
+    }
+
+    const auto subscribe_cost = [&dispatcher](auto handler)
+    {
+        const long long before = dmk_test::thread_new_calls();
+        Subscription sub = dispatcher.subscribe(std::move(handler));
+        const long long cost = dmk_test::thread_new_calls() - before;
+        sub.reset();
+        return cost;
+    };
+
+    std::array<std::uint64_t, 5> small{1, 2, 3, 4, 5};
+    std::array<std::uint64_t, 8> large{};
+    std::uint64_t seen{0};
+    const long long plain = subscribe_cost([](const SimpleEvent &) {});
+    const long long small_capture = subscribe_cost([small, &seen](const SimpleEvent &) { seen += small[0]; });
+    const long long large_capture = subscribe_cost([large, &seen](const SimpleEvent &) { seen += large[0]; });
+
+    // A 48-byte capture is stored in the entry like a captureless lambda; a larger one is boxed.
+    EXPECT_EQ(small_capture, plain);
+    EXPECT_EQ(large_capture, plain + 1);
+}
+
+TEST(EventDispatcherTest, LargeCapture_IsInvokedAndReleased)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    auto token = std::make_shared<int>(0);
+    std::array<char, 256> padding{};
+    padding[0] = 3;
+
+    auto sub = dispatcher.subscribe([token, padding](const SimpleEvent &e) { *token += e.value * padding[0]; });
+    dispatcher.emit(SimpleEvent{2});
+    EXPECT_EQ(*token, 6);
+
+    // No emit is in flight, so the unsubscribe frees every copy of the capture straight away.
+    sub.reset();
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(EventDispatcherTest, MutableLambda_KeepsItsStateAcrossEmits)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    int last_count = 0;
+
+    auto sub = dispatcher.subscribe([count = 0, &last_count](const SimpleEvent &) mutable { last_count = ++count; });
+    dispatcher.emit(SimpleEvent{});
+    dispatcher.emit(SimpleEvent{});
+
+    EXPECT_EQ(last_count, 2);
+}
+
 TEST(EventDispatcherTest, EmitSafe_SwallowsNonStdException)
 {
     EventDispatcher<SimpleEvent> dispatcher;
@@ -709,17 +791,14 @@ TEST(EventDispatcherTest, ConcurrentEmitWithInHandlerUnsubscribe_RemovedOnceNoSt
 
 TEST(EventDispatcherTest, EmptyFastPath_SkipsLock)
 {
-    // A freshly-constructed dispatcher holds exactly one snapshot reference internally. With no subscribers, emit()
-    // must be observably a no-op and subscriber_count()/empty() must report zero without mutating state.
+    // A freshly-constructed dispatcher has one snapshot and nothing retired. With no subscribers, emit() must be
+    // observably a no-op and subscriber_count()/empty() must report zero without mutating state.
     EventDispatcher<SimpleEvent> dispatcher;
 
     EXPECT_TRUE(dispatcher.empty());
     EXPECT_EQ(dispatcher.subscriber_count(), 0u);
 
-    // Record the dispatcher's own reference to its handler snapshot before any emit. If the fast path really skips the
-    // snapshot load, emit() should not leave any residual references alive afterwards.
-    const long use_count_before = dispatcher.debug_snapshot_use_count();
-    EXPECT_EQ(use_count_before, 1);
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 0u);
 
     for (int i = 0; i < 1000; ++i)
     {
@@ -729,7 +808,7 @@ TEST(EventDispatcherTest, EmptyFastPath_SkipsLock)
 
     EXPECT_TRUE(dispatcher.empty());
     EXPECT_EQ(dispatcher.subscriber_count(), 0u);
-    EXPECT_EQ(dispatcher.debug_snapshot_use_count(), use_count_before);
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 0u);
 }
 
 // Snapshot stability: in-flight emit sees pre-subscribe snapshot
@@ -796,15 +875,15 @@ TEST(EventDispatcherTest, SnapshotStability_DuringEmit)
     EXPECT_EQ(new_calls.load(), 1);
 }
 
-// Snapshot reclamation: no leaked shared_ptr references after churn
+// Snapshot reclamation: no retired snapshot outlives churn
 
 TEST(EventDispatcherTest, SnapshotReclamation_NoLeak)
 {
     EventDispatcher<SimpleEvent> dispatcher;
 
-    // Heavy subscribe + unsubscribe churn with interleaved emits. Each subscribe allocates a new snapshot; each
-    // unsubscribe does the same. Once every subscription's RAII guard is destroyed and no emit is in flight, only the
-    // dispatcher's own reference to the latest (empty) snapshot should remain.
+    // Heavy subscribe + unsubscribe churn with interleaved emits. Each subscribe allocates a new snapshot and retires
+    // the old one; each unsubscribe does the same. With no emit in flight, every writer frees what it retired, so
+    // nothing is left waiting once the churn ends.
     constexpr int iterations = 10000;
     for (int i = 0; i < iterations; ++i)
     {
@@ -818,19 +897,659 @@ TEST(EventDispatcherTest, SnapshotReclamation_NoLeak)
 
     EXPECT_EQ(dispatcher.subscriber_count(), 0u);
     EXPECT_TRUE(dispatcher.empty());
-    EXPECT_EQ(dispatcher.debug_snapshot_use_count(), 1)
-        << "Dispatcher should hold exactly one reference to its snapshot "
-           "after all subscriptions are released";
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 0u)
+        << "no emit is in flight, so every replaced snapshot should have been freed";
+}
+
+TEST(EventDispatcherTest, SnapshotReclamation_WaitsForInFlightEmit)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+
+    std::mutex gate_mtx;
+    std::condition_variable handler_started;
+    std::condition_variable handler_may_finish;
+    bool started{false};
+    bool may_finish{false};
+
+    auto blocking_sub = dispatcher.subscribe(
+        [&](const SimpleEvent &)
+        {
+            {
+                std::lock_guard lk{gate_mtx};
+                started = true;
+            }
+            handler_started.notify_one();
+
+            std::unique_lock lk{gate_mtx};
+            handler_may_finish.wait(lk, [&] { return may_finish; });
+        });
+
+    std::thread emitter([&] { dispatcher.emit(SimpleEvent{0}); });
+    {
+        std::unique_lock lk{gate_mtx};
+        handler_started.wait(lk, [&] { return started; });
+    }
+
+    // The emitter is iterating the current snapshot, so the writes below must retire it and the one after it rather
+    // than free them.
+    auto other_sub = dispatcher.subscribe([](const SimpleEvent &) {});
+    other_sub.reset();
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 2u);
+
+    {
+        std::lock_guard lk{gate_mtx};
+        may_finish = true;
+    }
+    handler_may_finish.notify_one();
+    emitter.join();
+
+    // The emit has left, so the next write frees everything retired before it, and what it retires itself.
+    auto last_sub = dispatcher.subscribe([](const SimpleEvent &) {});
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 0u);
 }
 
 // std::atomic<std::shared_ptr<T>> is NOT lock-free on either shipped toolchain: libstdc++ (MinGW) and the MSVC STL
-// both back it with an internal lock. The dispatcher's emit snapshot, the async-logger writer handle, and the
-// Hook::call gate all read such an atomic, so any "lock-free" claim about those reads would be wrong. This test pins
-// the property empirically so a future doc or code change that assumes lock-freedom is caught by a red test rather
-// than surviving as a stale comment.
+// both back it with an internal lock, which is why the dispatcher's emit snapshot is a raw pointer reclaimed by epoch
+// instead. The async-logger writer handle and the Hook::call gate still read such an atomic, so any "lock-free" claim
+// about those reads would be wrong. This test pins the property empirically so a future doc or code change that
+// assumes lock-freedom is caught by a red test rather than surviving as a stale comment.
 TEST(EventDispatcherTest, AtomicSharedPtrIsNotLockFree)
 {
     std::atomic<std::shared_ptr<int>> probe{};
     EXPECT_FALSE(probe.is_lock_free());
     EXPECT_FALSE(std::atomic<std::shared_ptr<int>>::is_always_lock_free);
 }
+
+// Deferred queue
+
+TEST(EventDispatcherTest, EmitDeferred_RunsHandlersOnTheDrainingThread)
+{
+    EventDispatcher<SimpleEvent> dispatcher(8);
+    std::vector<int> seen;
+    std::vector<std::thread::id> threads;
+    auto sub = dispatcher.subscribe(
+        [&](const SimpleEvent &e)
+        {
+            seen.push_back(e.value);
+            threads.push_back(std::this_thread::get_id());
+        });
+
+    std::thread producer(
+        [&dispatcher]
+        {
+            for (int i = 1; i <= 3; ++i)
+            {
+                EXPECT_TRUE(dispatcher.emit_deferred(SimpleEvent{i}));
+            }
+        });
+    producer.join();
+
+    // Nothing runs until the consumer drains.
+    EXPECT_TRUE(seen.empty());
+    EXPECT_EQ(dispatcher.deferred_pending(), 3u);
+
+    EXPECT_EQ(dispatcher.drain(), 3u);
+    EXPECT_EQ(seen, (std::vector<int>{1, 2, 3}));
+    for (const auto id : threads)
+    {
+        EXPECT_EQ(id, std::this_thread::get_id());
+    }
+    EXPECT_EQ(dispatcher.deferred_pending(), 0u);
+    EXPECT_EQ(dispatcher.drain(), 0u);
+}
+
+TEST(EventDispatcherTest, EmitDeferred_DropsWhenTheQueueIsFull)
+{
+    EventDispatcher<SimpleEvent> dispatcher(4);
+    int sum = 0;
+    auto sub = dispatcher.subscribe([&](const SimpleEvent &e) { sum += e.value; });
+
+    for (int i = 1; i <= 4; ++i)
+    {
+        EXPECT_TRUE(dispatcher.emit_deferred(SimpleEvent{i}));
+    }
+    EXPECT_FALSE(dispatcher.emit_deferred(SimpleEvent{100}));
+    EXPECT_EQ(dispatcher.deferred_dropped(), 1u);
+
+    // A bounded drain leaves the rest queued, and frees room for new events.
+    EXPECT_EQ(dispatcher.drain(2), 2u);
+    EXPECT_EQ(sum, 3);
+    EXPECT_EQ(dispatcher.deferred_pending(), 2u);
+    EXPECT_TRUE(dispatcher.emit_deferred(SimpleEvent{5}));
+    EXPECT_EQ(dispatcher.drain(), 3u);
+    EXPECT_EQ(sum, 15);
+}
+
+TEST(EventDispatcherTest, EmitDeferred_WithoutAQueueIsRejected)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    EXPECT_FALSE(dispatcher.emit_deferred(SimpleEvent{1}));
+    EXPECT_EQ(dispatcher.deferred_dropped(), 1u);
+    EXPECT_EQ(dispatcher.drain(), 0u);
+}
+
+TEST(EventDispatcherTest, Drain_CompletesAnUnsubscribeBeforeTheNextEvent)
+{
+    EventDispatcher<SimpleEvent> dispatcher(8);
+    int calls = 0;
+    Subscription self_sub;
+    self_sub = dispatcher.subscribe(
+        [&](const SimpleEvent &)
+        {
+            ++calls;
+            self_sub.reset();
+        });
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(dispatcher.emit_deferred(SimpleEvent{i}));
+    }
+    EXPECT_EQ(dispatcher.drain(), 3u);
+    EXPECT_EQ(calls, 1);
+    EXPECT_EQ(dispatcher.subscriber_count(), 0u);
+}
+
+TEST(EventDispatcherTest, Drain_FromAHandlerIsRejected)
+{
+    EventDispatcher<SimpleEvent> dispatcher(8);
+    size_t nested = 1;
+    auto sub = dispatcher.subscribe([&](const SimpleEvent &) { nested = dispatcher.drain(); });
+
+    ASSERT_TRUE(dispatcher.emit_deferred(SimpleEvent{1}));
+    ASSERT_TRUE(dispatcher.emit_deferred(SimpleEvent{2}));
+    EXPECT_EQ(dispatcher.drain(1), 1u);
+    EXPECT_EQ(nested, 0u);
+    EXPECT_EQ(dispatcher.deferred_pending(), 1u);
+}
+
+TEST(EventDispatcherTest, Destructor_DestroysUndrainedEvents)
+{
+    struct TokenEvent
+    {
+        std::shared_ptr<int> token;
+    };
+    auto token = std::make_shared<int>(0);
+    {
+        EventDispatcher<TokenEvent> dispatcher(4);
+        ASSERT_TRUE(dispatcher.emit_deferred(TokenEvent{token}));
+        ASSERT_TRUE(dispatcher.emit_deferred(TokenEvent{token}));
+        EXPECT_EQ(token.use_count(), 3);
+    }
+    EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(EventDispatcherTest, EmitDeferred_ConcurrentProducersLoseNothing)
+{
+    constexpr int producers = 4;
+    constexpr int per_producer = 5000;
+    EventDispatcher<SimpleEvent> dispatcher(1024);
+    long long sum = 0;
+    int count = 0;
+    auto sub = dispatcher.subscribe(
+        [&](const SimpleEvent &e)
+        {
+            sum += e.value;
+            ++count;
+        });
+
+    std::atomic<int> finished{0};
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p)
+    {
+        threads.emplace_back(
+            [&dispatcher, &finished]
+            {
+                for (int i = 1; i <= per_producer; ++i)
+                {
+                    // The consumer keeps up eventually; a full queue is retried, not lost.
+                    while (!dispatcher.emit_deferred(SimpleEvent{i}))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                finished.fetch_add(1, std::memory_order_release);
+            });
+    }
+
+    while (finished.load(std::memory_order_acquire) < producers || dispatcher.deferred_pending() != 0)
+    {
+        if (dispatcher.drain(64) == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (auto &t : threads)
+    {
+        t.join();
+    }
+
+    EXPECT_EQ(count, producers * per_producer);
+    EXPECT_EQ(sum, static_cast<long long>(producers) * per_producer * (per_producer + 1) / 2);
+}
+
+TEST(EventDispatcherTest, EmitBatch_RunsEachHandlerOverTheWholeSpan)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    std::vector<int> order;
+    auto first = dispatcher.subscribe([&](const SimpleEvent &e) { order.push_back(e.value); });
+    auto second = dispatcher.subscribe([&](const SimpleEvent &e) { order.push_back(e.value * 10); });
+
+    const std::array<SimpleEvent, 3> events{SimpleEvent{1}, SimpleEvent{2}, SimpleEvent{3}};
+    dispatcher.emit_batch(events);
+    dispatcher.emit_batch({});
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3, 10, 20, 30}));
+}
+
+TEST(EventDispatcherTest, BatchAwareHandler_ReceivesTheSpanOrASpanOfOne)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    std::vector<std::size_t> sizes;
+    int sum = 0;
+    auto sub = dispatcher.subscribe(
+        [&](std::span<const SimpleEvent> batch)
+        {
+            sizes.push_back(batch.size());
+            for (const SimpleEvent &e : batch)
+            {
+                sum += e.value;
+            }
+        });
+
+    const std::vector<SimpleEvent> events{SimpleEvent{1}, SimpleEvent{2}, SimpleEvent{3}, SimpleEvent{4}};
+    dispatcher.emit_batch(events);
+    dispatcher.emit(SimpleEvent{5});
+
+    EXPECT_EQ(sizes, (std::vector<std::size_t>{4, 1}));
+    EXPECT_EQ(sum, 15);
+}
+
+TEST(EventDispatcherTest, EmitBatchSafe_AThrowEndsOnlyThatHandlersBatch)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    int thrower_calls = 0;
+    int survivor_calls = 0;
+    auto thrower = dispatcher.subscribe(
+        [&](const SimpleEvent &)
+        {
+            ++thrower_calls;
+            throw std::runtime_error("boom");
+        });
+    auto survivor = dispatcher.subscribe([&](const SimpleEvent &) { ++survivor_calls; });
+
+    const std::array<SimpleEvent, 3> events{};
+    EXPECT_NO_THROW(dispatcher.emit_batch_safe(events));
+    EXPECT_EQ(thrower_calls, 1);
+    EXPECT_EQ(survivor_calls, 3);
+    EXPECT_THROW(dispatcher.emit_batch(events), std::runtime_error);
+}
+
+TEST(EventDispatcherTest, UnsubscribeInsideBatch_TakesEffectAtBatchUnwind)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    int calls = 0;
+    Subscription sub;
+    sub = dispatcher.subscribe(
+        [&](const SimpleEvent &)
+        {
+            ++calls;
+            sub.reset();
+        });
+
+    const std::array<SimpleEvent, 4> events{};
+    dispatcher.emit_batch(events);
+    dispatcher.emit_batch(events);
+
+    EXPECT_EQ(calls, 4);
+    EXPECT_EQ(dispatcher.subscriber_count(), 0u);
+}
+
+// Subscription batches
+
+TEST(EventDispatcherTest, SubscriptionBatch_PublishesOneSnapshotForEveryChange)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    auto first = dispatcher.subscribe([](const SimpleEvent &) {});
+    EXPECT_EQ(dispatcher.debug_retired_snapshot_count(), 0u);
+
+    // An emit on another event type's dispatcher announces this thread's epoch, so every snapshot the commit replaces
+    // stays retired until the outer emit returns; the handler is not a same-type handler, so the commit is allowed.
+    EventDispatcher<StringEvent> outer;
+    std::vector<Subscription> live;
+    size_t retired_during_emit = 0;
+    auto driver = outer.subscribe(
+        [&](const StringEvent &)
+        {
+            auto batch = dispatcher.batch();
+            batch.unsubscribe(std::move(first));
+            for (int i = 0; i < 3; ++i)
+            {
+                batch.subscribe([](const SimpleEvent &) {});
+            }
+            EXPECT_EQ(batch.staged(), 4u);
+            live = batch.commit();
+            EXPECT_EQ(batch.staged(), 0u);
+            retired_during_emit = dispatcher.debug_retired_snapshot_count();
+        });
+    outer.emit(StringEvent{"go"});
+
+    EXPECT_EQ(retired_during_emit, 1u);
+    ASSERT_EQ(live.size(), 3u);
+    EXPECT_EQ(dispatcher.subscriber_count(), 3u);
+    EXPECT_FALSE(first.active());
+}
+
+TEST(EventDispatcherTest, SubscriptionBatch_AppliesRemovalsAndKeepsOrder)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    std::vector<int> order;
+    auto a = dispatcher.subscribe([&](const SimpleEvent &) { order.push_back(1); });
+    auto b = dispatcher.subscribe([&](const SimpleEvent &) { order.push_back(2); });
+
+    auto batch = dispatcher.batch();
+    batch.unsubscribe(std::move(a));
+    EXPECT_EQ(batch.subscribe([&](const SimpleEvent &) { order.push_back(3); }), 0u);
+    EXPECT_EQ(batch.subscribe(std::function<void(const SimpleEvent &)>{}), 1u);
+    std::vector<Subscription> live = batch.commit();
+
+    ASSERT_EQ(live.size(), 2u);
+    EXPECT_TRUE(live[0].active());
+    EXPECT_FALSE(live[1].active());
+    EXPECT_FALSE(a.active());
+    EXPECT_EQ(dispatcher.subscriber_count(), 2u);
+
+    dispatcher.emit(SimpleEvent{});
+    EXPECT_EQ(order, (std::vector<int>{2, 3}));
+
+    live[0].reset();
+    EXPECT_EQ(dispatcher.subscriber_count(), 1u);
+}
+
+TEST(EventDispatcherTest, SubscriptionBatch_DroppedWithoutCommitStillRemoves)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    int calls = 0;
+    auto kept = dispatcher.subscribe([&](const SimpleEvent &) { ++calls; });
+    {
+        auto batch = dispatcher.batch();
+        batch.unsubscribe(std::move(kept));
+        batch.subscribe([&](const SimpleEvent &) { calls += 100; });
+    }
+
+    dispatcher.emit(SimpleEvent{});
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(dispatcher.empty());
+}
+
+TEST(EventDispatcherTest, SubscriptionBatch_ForeignSubscriptionIsResetAtOnce)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    EventDispatcher<SimpleEvent> other;
+    auto foreign = other.subscribe([](const SimpleEvent &) {});
+
+    auto batch = dispatcher.batch();
+    batch.unsubscribe(std::move(foreign));
+    EXPECT_EQ(batch.staged(), 0u);
+    EXPECT_TRUE(other.empty());
+}
+
+TEST(EventDispatcherTest, SubscriptionBatch_CommitFromASameTypeHandlerIsRejected)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    std::vector<Subscription> live;
+    auto sub = dispatcher.subscribe(
+        [&](const SimpleEvent &)
+        {
+            auto batch = dispatcher.batch();
+            batch.subscribe([](const SimpleEvent &) {});
+            live = batch.commit();
+        });
+
+    dispatcher.emit(SimpleEvent{});
+    ASSERT_EQ(live.size(), 1u);
+    EXPECT_FALSE(live[0].active());
+    EXPECT_EQ(dispatcher.subscriber_count(), 1u);
+}
+
+TEST(EventDispatcherTest, SubscribeMany_ReturnsOneActiveGuardPerHandler)
+{
+    EventDispatcher<SimpleEvent> dispatcher;
+    int sum = 0;
+    auto subs = dispatcher.subscribe_many([&](const SimpleEvent &e) { sum += e.value; },
+                                          [&](const SimpleEvent &e) { sum += 10 * e.value; },
+                                          [&](std::span<const SimpleEvent> events) { sum += 100 * events[0].value; });
+
+    for (const Subscription &sub : subs)
+    {
+        EXPECT_TRUE(sub.active());
+    }
+    dispatcher.emit(SimpleEvent{1});
+    EXPECT_EQ(sum, 111);
+
+    subs[1].reset();
+    dispatcher.emit(SimpleEvent{1});
+    EXPECT_EQ(sum, 212);
+}
+
+// EventBus
+
+TEST(EventBusTest, Emit_ReachesOnlyTheSubscribersOfThatEvent)
+{
+    EventBus<SimpleEvent, StringEvent> bus;
+    int simple_sum = 0;
+    std::string messages;
+    auto simple_sub = bus.subscribe<SimpleEvent>([&](const SimpleEvent &e) { simple_sum += e.value; });
+    auto string_sub = bus.subscribe<StringEvent>([&](const StringEvent &e) { messages += e.message; });
+
+    bus.emit(SimpleEvent{4});
+    bus.emit(StringEvent{"hi"});
+    bus.emit(SimpleEvent{5});
+
+    EXPECT_EQ(simple_sum, 9);
+    EXPECT_EQ(messages, "hi");
+    EXPECT_EQ(bus.subscriber_count<SimpleEvent>(), 1u);
+    EXPECT_EQ(bus.subscriber_count<StringEvent>(), 1u);
+}
+
+TEST(EventBusTest, Unsubscribe_KeepsTheOrderOfEveryEventsRange)
+{
+    EventBus<SimpleEvent, StringEvent> bus;
+    std::vector<int> order;
+    auto a = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { order.push_back(1); });
+    auto s = bus.subscribe<StringEvent>([&](const StringEvent &) { order.push_back(10); });
+    auto b = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { order.push_back(2); });
+    auto c = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { order.push_back(3); });
+
+    b.reset();
+    bus.emit(SimpleEvent{});
+    bus.emit(StringEvent{});
+
+    EXPECT_EQ(order, (std::vector<int>{1, 3, 10}));
+    EXPECT_EQ(bus.subscriber_count<SimpleEvent>(), 2u);
+    EXPECT_FALSE(bus.empty<StringEvent>());
+}
+
+TEST(EventBusTest, UnsubscribeInsideHandler_TakesEffectOnTheNextEmit)
+{
+    EventBus<SimpleEvent> bus;
+    int self_calls = 0;
+    int other_calls = 0;
+    Subscription self_sub;
+    self_sub = bus.subscribe<SimpleEvent>(
+        [&](const SimpleEvent &)
+        {
+            ++self_calls;
+            self_sub.reset();
+        });
+    auto other_sub = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { ++other_calls; });
+
+    // The emit in flight finishes its own snapshot, so the second handler still runs.
+    bus.emit(SimpleEvent{});
+    bus.emit(SimpleEvent{});
+
+    EXPECT_EQ(self_calls, 1);
+    EXPECT_EQ(other_calls, 2);
+    EXPECT_EQ(bus.subscriber_count<SimpleEvent>(), 1u);
+}
+
+TEST(EventBusTest, EmitSafe_ContainsHandlerExceptions)
+{
+    EventBus<SimpleEvent> bus;
+    int after = 0;
+    auto thrower = bus.subscribe<SimpleEvent>([](const SimpleEvent &) { throw std::runtime_error("boom"); });
+    auto survivor = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { ++after; });
+
+    EXPECT_NO_THROW(bus.emit_safe(SimpleEvent{}));
+    EXPECT_EQ(after, 1);
+    EXPECT_THROW(bus.emit(SimpleEvent{}), std::runtime_error);
+}
+
+TEST(EventBusTest, Clear_RemovesEveryEventsSubscribers)
+{
+    EventBus<SimpleEvent, StringEvent> bus;
+    int calls = 0;
+    auto a = bus.subscribe<SimpleEvent>([&](const SimpleEvent &) { ++calls; });
+    auto b = bus.subscribe<StringEvent>([&](const StringEvent &) { ++calls; });
+
+    bus.clear();
+    bus.emit(SimpleEvent{});
+    bus.emit(StringEvent{});
+
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(bus.empty<SimpleEvent>());
+    EXPECT_TRUE(bus.empty<StringEvent>());
+}
+
+TEST(EventBusTest, ConcurrentEmitDuringChurn_SeesOnlyLiveHandlers)
+{
+    EventBus<SimpleEvent, StringEvent> bus;
+    std::atomic<int> keeper_calls{0};
+    auto keeper = bus.subscribe<SimpleEvent>(
+        [&](const SimpleEvent &) { keeper_calls.fetch_add(1, std::memory_order_relaxed); });
+
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> emitters;
+    for (int t = 0; t < 3; ++t)
+    {
+        emitters.emplace_back(
+            [&bus, &stop]
+            {
+                while (!stop.load(std::memory_order_acquire))
+                {
+                    bus.emit(SimpleEvent{1});
+                    bus.emit(StringEvent{"x"});
+                }
+            });
+    }
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto token = std::make_shared<int>(i);
+        auto sub = bus.subscribe<StringEvent>([token](const StringEvent &) { (void)*token; });
+    }
+    stop.store(true, std::memory_order_release);
+    for (auto &t : emitters)
+    {
+        t.join();
+    }
+
+    EXPECT_GT(keeper_calls.load(), 0);
+    EXPECT_EQ(bus.subscriber_count<StringEvent>(), 0u);
+}
+
+// KeyedEventDispatcher
+
+TEST(KeyedEventDispatcherTest, Emit_ReachesOnlyThatKeysSubscribersAndTheWildcards)
+{
+    KeyedEventDispatcher<int, SimpleEvent> dispatcher;
+    std::vector<std::string> calls;
+    auto a = dispatcher.subscribe(1, [&](const SimpleEvent &e) { calls.push_back("a" + std::to_string(e.value)); });
+    auto b = dispatcher.subscribe(2, [&](const SimpleEvent &e) { calls.push_back("b" + std::to_string(e.value)); });
+    auto all = dispatcher.subscribe_all([&](int key, const SimpleEvent &e)
+                                        { calls.push_back("*" + std::to_string(key) + std::to_string(e.value)); });
+    auto a2 = dispatcher.subscribe(1, [&](const SimpleEvent &) { calls.push_back("a2"); });
+
+    dispatcher.emit(1, SimpleEvent{7});
+    dispatcher.emit(2, SimpleEvent{8});
+    dispatcher.emit(3, SimpleEvent{9});
+
+    EXPECT_EQ(calls, (std::vector<std::string>{"a7", "a2", "*17", "b8", "*28", "*39"}));
+    EXPECT_EQ(dispatcher.subscriber_count(), 4u);
+    EXPECT_EQ(dispatcher.subscriber_count(1), 2u);
+    EXPECT_EQ(dispatcher.subscriber_count(3), 0u);
+}
+
+TEST(KeyedEventDispatcherTest, ManyKeys_EachEmitCallsOnlyItsOwnHandler)
+{
+    KeyedEventDispatcher<std::uint64_t, SimpleEvent> dispatcher;
+    constexpr std::uint64_t keys = 500;
+    std::vector<int> hits(keys, 0);
+    std::vector<Subscription> subs;
+    for (std::uint64_t key = 0; key < keys; ++key)
+    {
+        // Keys that are multiples of a power of two would all share one slot under an unmixed identity hash.
+        subs.push_back(dispatcher.subscribe(key << 12, [&hits, key](const SimpleEvent &) { ++hits[key]; }));
+    }
+
+    for (std::uint64_t key = 0; key < keys; key += 3)
+    {
+        dispatcher.emit(key << 12, SimpleEvent{});
+    }
+    subs[3].reset();
+    dispatcher.emit(std::uint64_t{3} << 12, SimpleEvent{});
+
+    for (std::uint64_t key = 0; key < keys; ++key)
+    {
+        EXPECT_EQ(hits[key], key % 3 == 0 ? 1 : 0) << key;
+    }
+    EXPECT_EQ(dispatcher.subscriber_count(), keys - 1);
+}
+
+TEST(KeyedEventDispatcherTest, Unsubscribe_KeepsTheOtherGroupsInOrder)
+{
+    KeyedEventDispatcher<std::string, SimpleEvent> dispatcher;
+    std::vector<int> order;
+    auto w = dispatcher.subscribe_all([&](const SimpleEvent &) { order.push_back(0); });
+    auto a = dispatcher.subscribe("fire", [&](const SimpleEvent &) { order.push_back(1); });
+    auto b = dispatcher.subscribe("fire", [&](const SimpleEvent &) { order.push_back(2); });
+    auto c = dispatcher.subscribe("jump", [&](const SimpleEvent &) { order.push_back(3); });
+    auto d = dispatcher.subscribe("fire", [&](const SimpleEvent &) { order.push_back(4); });
+
+    a.reset();
+    w.reset();
+    dispatcher.emit("fire", SimpleEvent{});
+    dispatcher.emit("jump", SimpleEvent{});
+    c.reset();
+    dispatcher.emit("jump", SimpleEvent{});
+
+    EXPECT_EQ(order, (std::vector<int>{2, 4, 3}));
+    EXPECT_EQ(dispatcher.subscriber_count("jump"), 0u);
+    EXPECT_EQ(dispatcher.subscriber_count("fire"), 2u);
+}
+
+TEST(KeyedEventDispatcherTest, EmitSafe_ContainsHandlerExceptions)
+{
+    KeyedEventDispatcher<int, SimpleEvent> dispatcher;
+    int after = 0;
+    auto thrower = dispatcher.subscribe(1, [](const SimpleEvent &) { throw std::runtime_error("boom"); });
+    auto survivor = dispatcher.subscribe_all([&](const SimpleEvent &) { ++after; });
+
+    EXPECT_NO_THROW(dispatcher.emit_safe(1, SimpleEvent{}));
+    EXPECT_EQ(after, 1);
+    EXPECT_THROW(dispatcher.emit(1, SimpleEvent{}), std::runtime_error);
+}
+
+TEST(KeyedEventDispatcherTest, Clear_AndEmptyHandler_LeaveNothingSubscribed)
+{
+    KeyedEventDispatcher<int, SimpleEvent> dispatcher;
+    int calls = 0;
+    auto a = dispatcher.subscribe(1, [&](const SimpleEvent &) { ++calls; });
+    auto rejected = dispatcher.subscribe(1, std::function<void(const SimpleEvent &)>{});
+    EXPECT_FALSE(rejected.active());
+    EXPECT_EQ(dispatcher.subscriber_count(), 1u);
+
+    dispatcher.clear();
+    dispatcher.emit(1, SimpleEvent{});
+
+    EXPECT_EQ(calls, 0);
+    EXPECT_TRUE(dispatcher.empty());
+}
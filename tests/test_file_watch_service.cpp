@@ -0,0 +1,210 @@
+#include <gtest/gtest.h>
+
+#include "internal/file_watch_service.hpp"
+
+#include <windows.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+using namespace DetourModKit;
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    /// Polls @p done for up to @p limit, so a slow CI machine gets time without a fixed long sleep.
+    template <typename Done>
+    [[nodiscard]] bool eventually(Done done, std::chrono::milliseconds limit = 3000ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + limit;
+        while (!done())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        return true;
+    }
+
+    class FileWatchServiceTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            static int s_counter = 0;
+            m_root = std::filesystem::temp_directory_path() /
+                     ("dmk_file_watch_" + std::to_string(GetCurrentProcessId()) + "_" + std::to_string(++s_counter));
+            std::filesystem::create_directories(m_root / "a");
+            std::filesystem::create_directories(m_root / "b");
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(m_root, ec);
+        }
+
+        static void write(const std::filesystem::path &path, const std::string &content)
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << content;
+        }
+
+        std::filesystem::path m_root;
+    };
+} // namespace
+
+TEST_F(FileWatchServiceTest, RejectsAnEmptyCallbackOrAPathWithoutAFile)
+{
+    EXPECT_EQ(detail::watch_file((m_root / "a" / "x.ini").string(), {}, {}).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(detail::watch_file("", {}, []() {}).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(detail::watch_file((m_root / "missing" / "x.ini").string(), {}, []() {}).error().code,
+              ErrorCode::SystemCallFailed);
+    // Unknown ids are harmless.
+    EXPECT_TRUE(detail::unwatch_file(detail::NO_FILE_WATCH, true));
+    detail::detach_file_watch(detail::NO_FILE_WATCH);
+}
+
+// Files in one directory share its read, files in different directories share the pump, and each file keeps its own
+// debounce: a write to one fires only that file's callback.
+TEST_F(FileWatchServiceTest, ManyFilesAcrossDirectoriesShareOneThread)
+{
+    const std::filesystem::path files[] = {m_root / "a" / "one.ini", m_root / "a" / "two.ini",
+                                           m_root / "b" / "three.ini"};
+    for (const auto &file : files)
+    {
+        write(file, "k=0\n");
+    }
+
+    const std::size_t watches_before = detail::file_watch_count();
+    const std::size_t directories_before = detail::watched_directory_count();
+    std::atomic<int> hits[3]{};
+    std::atomic<bool> on_dispatch_thread{true};
+    detail::FileWatchId ids[3]{};
+    for (int i = 0; i < 3; ++i)
+    {
+        auto id = detail::watch_file(files[i].string(), detail::FileWatchOptions{50ms, false},
+                                     [&hits, &on_dispatch_thread, i]()
+                                     {
+                                         if (!detail::is_file_watch_dispatch_thread(std::this_thread::get_id()))
+                                         {
+                                             on_dispatch_thread.store(false);
+                                         }
+                                         hits[i].fetch_add(1);
+                                     });
+        ASSERT_TRUE(id.has_value());
+        ids[i] = *id;
+    }
+    const std::uint64_t started = detail::file_watch_threads_started();
+    EXPECT_EQ(detail::file_watch_count(), watches_before + 3);
+    EXPECT_EQ(detail::watched_directory_count(), directories_before + 2);
+
+    write(files[1], "k=1\n");
+    EXPECT_TRUE(eventually([&hits]() { return hits[1].load() >= 1; }));
+    write(files[2], "k=2\n");
+    EXPECT_TRUE(eventually([&hits]() { return hits[2].load() >= 1; }));
+    EXPECT_EQ(hits[0].load(), 0) << "a write to a sibling must not fire this file's callback";
+    EXPECT_TRUE(on_dispatch_thread.load());
+    EXPECT_EQ(detail::file_watch_threads_started(), started);
+
+    for (const detail::FileWatchId id : ids)
+    {
+        EXPECT_TRUE(detail::unwatch_file(id, false));
+    }
+    EXPECT_EQ(detail::file_watch_count(), watches_before);
+    // The last unwatch of a directory waits for its read to drain, so the count is already back.
+    EXPECT_EQ(detail::watched_directory_count(), directories_before);
+}
+
+TEST_F(FileWatchServiceTest, SkipUnchangedContentDropsAnIdenticalRewrite)
+{
+    const std::filesystem::path file = m_root / "a" / "hashed.ini";
+    write(file, "k=1\n");
+    std::atomic<int> hits{0};
+    auto id =
+        detail::watch_file(file.string(), detail::FileWatchOptions{50ms, true}, [&hits]() { hits.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+
+    write(file, "k=1\n");
+    std::this_thread::sleep_for(300ms);
+    EXPECT_EQ(hits.load(), 0) << "the bytes match those at registration";
+
+    write(file, "k=2\n");
+    EXPECT_TRUE(eventually([&hits]() { return hits.load() >= 1; }));
+
+    EXPECT_TRUE(detail::unwatch_file(*id, false));
+}
+
+TEST_F(FileWatchServiceTest, UnwatchFlushesAPendingChangeOnlyWhenAsked)
+{
+    const std::filesystem::path file = m_root / "a" / "flush.ini";
+    write(file, "k=1\n");
+    std::atomic<int> flushed{0};
+    std::atomic<int> dropped{0};
+    const detail::FileWatchOptions slow{5000ms, false};
+    auto flush_id = detail::watch_file(file.string(), slow, [&flushed]() { flushed.fetch_add(1); });
+    auto drop_id = detail::watch_file(file.string(), slow, [&dropped]() { dropped.fetch_add(1); });
+    ASSERT_TRUE(flush_id.has_value());
+    ASSERT_TRUE(drop_id.has_value());
+
+    write(file, "k=2\n");
+    std::this_thread::sleep_for(200ms);
+
+    EXPECT_TRUE(detail::unwatch_file(*flush_id, true));
+    EXPECT_EQ(flushed.load(), 1) << "the flush runs before unwatch_file returns";
+    EXPECT_TRUE(detail::unwatch_file(*drop_id, false));
+    EXPECT_EQ(dropped.load(), 0);
+}
+
+// From inside a callback there is nothing to wait for: the running callback is the caller.
+TEST_F(FileWatchServiceTest, UnwatchFromItsOwnCallbackReturnsWithoutWaiting)
+{
+    const std::filesystem::path file = m_root / "b" / "self.ini";
+    write(file, "k=1\n");
+    std::atomic<detail::FileWatchId> self{detail::NO_FILE_WATCH};
+    std::atomic<int> returned{0};
+    auto id = detail::watch_file(file.string(), detail::FileWatchOptions{50ms, false},
+                                 [&self, &returned]()
+                                 {
+                                     if (detail::unwatch_file(self.load(), true))
+                                     {
+                                         returned.fetch_add(1);
+                                     }
+                                 });
+    ASSERT_TRUE(id.has_value());
+    self.store(*id);
+
+    write(file, "k=2\n");
+    EXPECT_TRUE(eventually([&returned]() { return returned.load() == 1; }));
+    write(file, "k=3\n");
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(returned.load(), 1) << "the watch is gone after unwatching itself";
+}
+
+TEST_F(FileWatchServiceTest, ShutdownDropsWatchesAndTheNextWatchRestarts)
+{
+    const std::filesystem::path file = m_root / "a" / "restart.ini";
+    write(file, "k=1\n");
+    ASSERT_TRUE(detail::watch_file(file.string(), {}, []() {}).has_value());
+    const std::uint64_t started = detail::file_watch_threads_started();
+
+    detail::shutdown_file_watch_service();
+    EXPECT_EQ(detail::file_watch_count(), 0u);
+    EXPECT_EQ(detail::watched_directory_count(), 0u);
+
+    std::atomic<int> hits{0};
+    auto id =
+        detail::watch_file(file.string(), detail::FileWatchOptions{50ms, false}, [&hits]() { hits.fetch_add(1); });
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(detail::file_watch_threads_started(), started + 1);
+    write(file, "k=2\n");
+    EXPECT_TRUE(eventually([&hits]() { return hits.load() >= 1; }));
+    EXPECT_TRUE(detail::unwatch_file(*id, false));
+}
@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <format>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "DetourModKit/format.hpp"
@@ -260,3 +263,59 @@ TEST(FormatTest, FormatHex_PtrdiffWidthNegativeAboveInt)
     ptrdiff_t value = -static_cast<ptrdiff_t>(0x0000000100000000LL);
     EXPECT_EQ(format::format_hex(value, 4), "-0x100000000");
 }
+
+// The buffer overloads must produce exactly the text of the allocating ones, and an undersized buffer yields an empty
+// view rather than a cut-off string.
+TEST(FormatTest, BufferOverloads_MatchStringForms)
+{
+    std::array<char, format::ADDRESS_CHARS> address;
+    EXPECT_EQ(format::format_address(0x12345678, address), format::format_address(0x12345678));
+
+    std::array<char, format::HEX_CHARS> hex;
+    EXPECT_EQ(format::format_hex(255, hex, 4), "0x00FF");
+    EXPECT_EQ(format::format_hex(-1, hex), format::format_hex(-1));
+    EXPECT_EQ(format::format_hex(std::uint64_t{0xDEADBEEFCAFE}, hex), "0xDEADBEEFCAFE");
+    EXPECT_EQ(format::format_hex(ptrdiff_t{-0x10}, hex, 4), "-0x0010");
+    EXPECT_EQ(format::format_hex(static_cast<ptrdiff_t>(LLONG_MIN), hex), "-0x8000000000000000");
+
+    std::array<char, format::BYTE_CHARS> byte;
+    EXPECT_EQ(format::format_byte(std::byte{0xCC}, byte), "0xCC");
+    EXPECT_EQ(format::format_vkcode(0x72, byte), "0x72");
+}
+
+TEST(FormatTest, BufferOverloads_UndersizedBufferYieldsEmpty)
+{
+    std::array<char, format::ADDRESS_CHARS - 1> address;
+    EXPECT_TRUE(format::format_address(0x1000, address).empty());
+
+    std::array<char, 4> hex;
+    EXPECT_TRUE(format::format_hex(255u, hex, 4).empty());
+    EXPECT_EQ(format::format_hex(255u, hex), "0xFF");
+}
+
+TEST(FormatTest, BufferOverloads_IntVector)
+{
+    const std::vector<int> values = {0x72, 0xA0, 0x20};
+    std::array<char, format::int_vector_chars(3)> list;
+    EXPECT_EQ(format::format_int_vector(values, list), "[0x72, 0xA0, 0x20]");
+    EXPECT_EQ(format::format_vkcode_list(values, list), format::format_vkcode_list(values));
+    EXPECT_EQ(format::format_int_vector(std::span<const int>{}, list), "[]");
+
+    // The bound covers the widest entries; one character short of the text refuses the whole list.
+    const std::vector<int> widest = {-1, -1};
+    std::array<char, format::int_vector_chars(2)> exact;
+    EXPECT_EQ(format::format_int_vector(widest, exact), "[0xFFFFFFFF, 0xFFFFFFFF]");
+    std::array<char, 17> short_list;
+    EXPECT_TRUE(format::format_int_vector(values, short_list).empty());
+}
+
+TEST(FormatTest, Formatter_AddressAndRegion)
+{
+    EXPECT_EQ(std::format("{}", Address{0x1000}), "0x0000000000001000");
+    EXPECT_EQ(std::format("{:#x}", Address{0x1000}), "0x1000");
+    EXPECT_EQ(std::format("{}", Region{Address{0x1000}, 0x20}), "[0x0000000000001000, 0x0000000000001020)");
+    EXPECT_EQ(std::format("{:#x}", Region{Address{0x1000}, 0x20}), "[0x1000, 0x1020)");
+}
+
+// Address and Region render from their bytes alone, so a line made of them can be deferred.
+static_assert(detail::DeferredLogFormat<Address>::value && detail::DeferredLogFormat<Region>::value);
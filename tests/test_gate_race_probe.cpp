@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "internal/hook_ledger.hpp"
@@ -46,8 +47,8 @@ namespace
 // Distinct-target churn: every worker hammers its OWN target through the full reserve -> commit -> release lifecycle,
 // so the threads mutate the ledger's shared map concurrently on disjoint keys. A missing or mis-scoped lock corrupts
 // the map (a lost erase leaves a phantom hook, a torn insert drops one), which shows up as a reserve failure or a
-// target that stays hooked after teardown. The concurrent unordered_map insert/erase is also the primary race-detection
-// site.
+// target that stays hooked after teardown. The concurrent table inserts and removals are also the primary
+// race-detection site.
 TEST(GateRaceProbe, HookLedgerConcurrentDistinctTargetsStayConsistent)
 {
     HookLedger &ledger = HookLedger::instance();
@@ -90,6 +91,81 @@ TEST(GateRaceProbe, HookLedgerConcurrentDistinctTargetsStayConsistent)
     }
 }
 
+// Lock-free reads across table growth: writers reserve and commit enough distinct targets to grow every shard's table
+// several times, then release them, while readers keep querying one target committed up front. The steady target must
+// read hooked on every probe, even while its table is being replaced under the reader, and every churned target must
+// read unhooked once released.
+TEST(GateRaceProbe, HookLedgerLockFreeReadsSurviveTableGrowth)
+{
+    HookLedger &ledger = HookLedger::instance();
+    const std::uintptr_t steady = TARGET_BASE + 0xB000;
+    const auto steady_reservation = ledger.try_reserve_hook(steady, /*refuse_if_hooked=*/false);
+    ASSERT_EQ(steady_reservation.status, HookLedger::ReserveStatus::Reserved);
+    ledger.commit_hook(steady, steady_reservation.id);
+
+    constexpr int TARGETS_PER_WRITER = 256;
+    std::atomic<bool> writers_done{false};
+    std::atomic<int> missed_reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < STRESS_THREADS / 2; ++t)
+    {
+        readers.emplace_back(
+            [&]
+            {
+                while (!writers_done.load(std::memory_order_acquire))
+                {
+                    if (!ledger.is_target_hooked(steady))
+                    {
+                        missed_reads.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+    std::vector<std::thread> writers;
+    for (int t = 0; t < STRESS_THREADS / 2; ++t)
+    {
+        writers.emplace_back(
+            [&ledger, t]
+            {
+                std::vector<std::pair<std::uintptr_t, std::uint64_t>> held;
+                for (int i = 0; i < TARGETS_PER_WRITER; ++i)
+                {
+                    const std::uintptr_t target =
+                        TARGET_BASE + 0x100000 + static_cast<std::uintptr_t>((t * TARGETS_PER_WRITER + i) * 0x10);
+                    const auto reservation = ledger.try_reserve_hook(target, /*refuse_if_hooked=*/false);
+                    if (reservation.status == HookLedger::ReserveStatus::Reserved)
+                    {
+                        ledger.commit_hook(target, reservation.id);
+                        held.emplace_back(target, reservation.id);
+                    }
+                }
+                for (const auto &[target, id] : held)
+                {
+                    (void)ledger.release_hook(target, id);
+                }
+            });
+    }
+    for (auto &writer : writers)
+    {
+        writer.join();
+    }
+    writers_done.store(true, std::memory_order_release);
+    for (auto &reader : readers)
+    {
+        reader.join();
+    }
+
+    EXPECT_EQ(missed_reads.load(std::memory_order_relaxed), 0) << "a lock-free read lost the steady target";
+    EXPECT_TRUE(ledger.is_target_hooked(steady));
+    for (int i = 0; i < (STRESS_THREADS / 2) * TARGETS_PER_WRITER; ++i)
+    {
+        const std::uintptr_t target = TARGET_BASE + 0x100000 + static_cast<std::uintptr_t>(i * 0x10);
+        ASSERT_FALSE(ledger.is_target_hooked(target)) << "churned target " << i << " still reads hooked";
+    }
+    EXPECT_EQ(ledger.release_hook(steady, steady_reservation.id), 0u);
+    EXPECT_FALSE(ledger.is_target_hooked(steady));
+}
+
 // Same-target layering: every worker layers ONE hook on a single shared target and commits it (leaving it live). The
 // ledger makes reservations wait their turn in creation order, so the concurrent enqueue-then-wait handoff must still
 // produce exactly one distinct id per worker and leave the target hooked; tearing every layer down must then leave it
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -269,6 +270,107 @@ TEST(HealSchedulerTest, ManyGroupsAddedFromCallbackDeferWithoutInvalidatingItera
     EXPECT_TRUE(sched.all_resolved());
 }
 
+TEST(HealSchedulerTest, UnbudgetedTickRunsEveryDueGroupAndReportsIt)
+{
+    auto started = rtti::HealScheduler::start(rtti::HealConfig{.interval_frames = 5});
+    ASSERT_TRUE(started.has_value());
+    rtti::HealScheduler &sched = *started;
+
+    int scans = 0;
+    for (int g = 0; g < 3; ++g)
+    {
+        sched.add_group(
+            [&scans](rtti::HealRun &run) noexcept
+            {
+                ++scans;
+                EXPECT_FALSE(run.budget_exhausted());
+                return false;
+            });
+    }
+
+    const rtti::HealTickStats stats = sched.tick();
+    EXPECT_EQ(scans, 3);
+    EXPECT_EQ(stats.groups_run, 3u);
+    EXPECT_EQ(stats.groups_deferred, 0u);
+    EXPECT_EQ(stats.groups_continued, 0u);
+    EXPECT_FALSE(stats.over_budget);
+    EXPECT_GE(stats.elapsed, stats.longest_group);
+
+    // The next five ticks are interval skips: nothing runs and nothing counts as deferred.
+    const rtti::HealTickStats idle = sched.tick(std::chrono::microseconds{0});
+    EXPECT_EQ(idle.groups_run, 0u);
+    EXPECT_EQ(idle.groups_deferred, 0u);
+}
+
+TEST(HealSchedulerTest, SpentBudgetDefersDueGroupsWithoutSpendingTheirInterval)
+{
+    // A zero budget still runs one group per tick (forward progress); the rest stay due and the next tick starts
+    // with the first one it did not reach, so every group gets its scan within as many ticks as there are groups.
+    auto started = rtti::HealScheduler::start(rtti::HealConfig{.interval_frames = 30});
+    ASSERT_TRUE(started.has_value());
+    rtti::HealScheduler &sched = *started;
+
+    std::vector<int> order;
+    for (int g = 0; g < 3; ++g)
+    {
+        sched.add_group(
+            [&order, g](rtti::HealRun &run) noexcept
+            {
+                order.push_back(g);
+                EXPECT_TRUE(run.budget_exhausted());
+                EXPECT_EQ(run.remaining().count(), 0);
+                return true;
+            });
+    }
+
+    rtti::HealTickStats stats = sched.tick(std::chrono::microseconds{0});
+    EXPECT_EQ(stats.groups_run, 1u);
+    EXPECT_EQ(stats.groups_deferred, 2u);
+
+    stats = sched.tick(std::chrono::microseconds{0});
+    EXPECT_EQ(stats.groups_run, 1u);
+    EXPECT_EQ(stats.groups_deferred, 1u);
+
+    stats = sched.tick(std::chrono::microseconds{0});
+    EXPECT_EQ(stats.groups_run, 1u);
+    EXPECT_EQ(stats.groups_deferred, 0u);
+
+    EXPECT_EQ(order, (std::vector<int>{0, 1, 2})) << "a deferred group runs on the next tick, not an interval later";
+    EXPECT_TRUE(sched.all_resolved());
+}
+
+TEST(HealSchedulerTest, ContinueNextTickResumesWithoutWaitingTheInterval)
+{
+    // A group that heals one step per tick keeps its own cursor and asks to continue; it must not wait out the
+    // 30-frame interval between steps, and it latches once the last step resolves.
+    auto started = rtti::HealScheduler::start(rtti::HealConfig{.interval_frames = 30});
+    ASSERT_TRUE(started.has_value());
+    rtti::HealScheduler &sched = *started;
+
+    int step = 0;
+    sched.add_group(
+        [&step](rtti::HealRun &run) noexcept
+        {
+            if (++step < 4)
+            {
+                run.continue_next_tick();
+                return false;
+            }
+            return true;
+        });
+
+    for (int i = 0; i < 3; ++i)
+    {
+        const rtti::HealTickStats stats = sched.tick(std::chrono::microseconds{500});
+        EXPECT_EQ(stats.groups_run, 1u);
+        EXPECT_EQ(stats.groups_continued, 1u);
+    }
+    EXPECT_FALSE(sched.all_resolved());
+    (void)sched.tick(std::chrono::microseconds{500});
+    EXPECT_EQ(step, 4);
+    EXPECT_TRUE(sched.all_resolved());
+}
+
 // heal_into behaviour (with synthetic RTTI)
 
 namespace
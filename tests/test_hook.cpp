@@ -10,6 +10,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <optional>
 #include <span>
@@ -232,11 +233,15 @@ namespace
 {
     // Synthetic prologue buffers for the inline/mid prologue pre-flight. const (read-only) and alignas(16) so the
     // planted first byte sits at a deterministic, readable address across toolchains. The Fail-policy create refuses at
-    // the prologue pre-flight, so these need not be relocatable code -- only the first byte is classified, and the hook
-    // target is the buffer's address.
+    // the prologue pre-flight, so these need not be relocatable code -- only the first bytes are classified, and the
+    // hook target is the buffer's address.
     alignas(16) const std::uint8_t CALL_PROLOGUE_BYTES[] = {0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3, 0x90, 0x90};
     alignas(16) const std::uint8_t INT3_PROLOGUE_BYTES[] = {0xCC, 0xC3, 0x90, 0x90};
     alignas(16) const std::uint8_t INTN_PROLOGUE_BYTES[] = {0xCD, 0x03, 0xC3, 0x90};
+    // xor eax, eax; ret; then the next function's push rbp: the 5-byte patch would overwrite its entry.
+    alignas(16) const std::uint8_t SHORT_BODY_BYTES[] = {0x31, 0xC0, 0xC3, 0x55, 0x48, 0x89, 0xE5, 0xC3};
+    // The same short body ending in rep ret (F3 C3), which compilers still emit for branch-target returns.
+    alignas(16) const std::uint8_t REP_RET_BODY_BYTES[] = {0x31, 0xC0, 0xF3, 0xC3, 0x55, 0x48, 0x89, 0xE5, 0xC3};
     // Dedicated buffer for the Relocate-leak test: it installs and releases (leaks) a hook here, which patches the
     // first byte, so it must not share a buffer with the prologue-refusal tests that need a clean leading 0xE8.
     alignas(16) std::uint8_t RELOCATE_CALL_PROLOGUE_BYTES[] = {0xE8, 0x00, 0x00, 0x00, 0x00, 0xC3, 0x90, 0x90,
@@ -275,6 +280,25 @@ TEST(HookInlinePrologue, DefaultFailsOnIntNPrologue)
     EXPECT_EQ(r.error().code, ErrorCode::TargetPrologueUnsafe);
 }
 
+// A body that returns before the 5-byte patch ends cannot be relocated: the patch would also overwrite the code after
+// it. No int3/nop padding follows the ret here, so the default Fail policy must refuse.
+TEST(HookInlinePrologue, DefaultFailsOnBodyEndingInsideThePatch)
+{
+    Result<Hook> r = inline_at(InlineRequest{.name = "ShortBody", .target = addr_of(SHORT_BODY_BYTES)},
+                               reinterpret_cast<void (*)()>(&noop_detour));
+    ASSERT_FALSE(r.has_value());
+    EXPECT_EQ(r.error().code, ErrorCode::TargetPrologueUnsafe);
+}
+
+// The terminator is classified after its prefixes: a rep ret ends the body as surely as a plain ret.
+TEST(HookInlinePrologue, DefaultFailsOnPrefixedRetInsideThePatch)
+{
+    Result<Hook> r = inline_at(InlineRequest{.name = "RepRetBody", .target = addr_of(REP_RET_BODY_BYTES)},
+                               reinterpret_cast<void (*)()>(&noop_detour));
+    ASSERT_FALSE(r.has_value());
+    EXPECT_EQ(r.error().code, ErrorCode::TargetPrologueUnsafe);
+}
+
 // The default policy must never refuse a normal real-function target: a normal prologue installs with no false
 // TargetPrologueUnsafe.
 TEST(HookInlinePrologue, DefaultInstallsOnNormalTarget)
@@ -379,6 +403,236 @@ TEST(HookLedger, IsTargetHookedTrueWhileLiveFalseAfterDrop)
     EXPECT_FALSE(is_target_hooked(target));
 }
 
+// reserve_trampolines(Address, count)
+
+TEST(HookReserveTrampolines, ReservesNearTheModuleAndInstallsStillWork)
+{
+    const Address target = addr_of(&real_hook_target_add);
+    EXPECT_TRUE(reserve_trampolines(target, 0).has_value());
+    ASSERT_TRUE(reserve_trampolines(target, 64).has_value());
+
+    // A second call within reach of the same pool reuses the space the first one returned.
+    ASSERT_TRUE(reserve_trampolines(target, 64).has_value());
+
+    Result<Hook> r = inline_at(InlineRequest{.name = "AfterReserve", .target = target}, &real_hook_detour_add);
+    ASSERT_TRUE(r.has_value()) << r.error().message();
+    Hook h = std::move(*r);
+    EXPECT_EQ(real_hook_target_add(2, 3), 2 + 3 + 1000);
+}
+
+TEST(HookReserveTrampolines, RejectsNullAndOverflowingRequests)
+{
+    const auto null_site = reserve_trampolines(Address{std::uintptr_t{0}}, 4);
+    ASSERT_FALSE(null_site.has_value());
+    EXPECT_EQ(null_site.error().code, ErrorCode::NullTargetAddress);
+
+    const auto too_many = reserve_trampolines(addr_of(&real_hook_target_add), std::numeric_limits<std::size_t>::max());
+    ASSERT_FALSE(too_many.has_value());
+    EXPECT_EQ(too_many.error().code, ErrorCode::SizeTooLarge);
+}
+
+// Hot-patch pad
+
+namespace
+{
+    // A hot-patchable `int add(int, int)` in its own executable page: five INT3 filler bytes, then the 2-byte entry
+    // instruction and `lea eax, [rcx + rdx]; ret`, with the entry 16-byte aligned.
+    class HotPatchableAdd
+    {
+    public:
+        using Fn = int (*)(int, int);
+
+        explicit HotPatchableAdd(std::array<std::uint8_t, 2> entry_instruction)
+            : m_page(static_cast<std::uint8_t *>(
+                  VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE)))
+        {
+            if (m_page == nullptr)
+            {
+                return;
+            }
+            std::memset(m_page, 0xCC, 0x1000);
+            const std::array<std::uint8_t, 6> body = {entry_instruction[0], entry_instruction[1], 0x8D, 0x04, 0x11,
+                                                      0xC3};
+            std::memcpy(m_page + ENTRY_OFFSET, body.data(), body.size());
+            DWORD old_protect = 0;
+            (void)VirtualProtect(m_page, 0x1000, PAGE_EXECUTE_READ, &old_protect);
+            (void)FlushInstructionCache(GetCurrentProcess(), m_page, 0x1000);
+        }
+
+        ~HotPatchableAdd()
+        {
+            if (m_page != nullptr)
+            {
+                VirtualFree(m_page, 0, MEM_RELEASE);
+            }
+        }
+
+        HotPatchableAdd(const HotPatchableAdd &) = delete;
+        HotPatchableAdd &operator=(const HotPatchableAdd &) = delete;
+
+        [[nodiscard]] bool ok() const noexcept { return m_page != nullptr; }
+        [[nodiscard]] Address entry() const noexcept { return Address{m_page + ENTRY_OFFSET}; }
+        [[nodiscard]] Fn fn() const noexcept { return reinterpret_cast<Fn>(m_page + ENTRY_OFFSET); }
+        [[nodiscard]] std::array<std::uint8_t, 2> entry_bytes() const noexcept
+        {
+            return {m_page[ENTRY_OFFSET], m_page[ENTRY_OFFSET + 1]};
+        }
+        [[nodiscard]] std::array<std::uint8_t, 5> pad_bytes() const noexcept
+        {
+            std::array<std::uint8_t, 5> pad{};
+            std::memcpy(pad.data(), m_page + ENTRY_OFFSET - pad.size(), pad.size());
+            return pad;
+        }
+
+    private:
+        static constexpr std::size_t ENTRY_OFFSET = 0x40;
+        std::uint8_t *m_page;
+    };
+
+    constexpr std::array<std::uint8_t, 2> HOT_PATCH_ARMED = {0xEB, 0xF9};
+    constexpr std::array<std::uint8_t, 5> INT3_FILLER = {0xCC, 0xCC, 0xCC, 0xCC, 0xCC};
+} // anonymous namespace
+
+TEST(HookHotPatch, EligibleEntriesAreArmedThroughThePadAndRestoredOnTeardown)
+{
+    const std::array<std::array<std::uint8_t, 2>, 2> entries = {
+        std::array<std::uint8_t, 2>{0x8B, 0xFF}, // mov edi, edi
+        std::array<std::uint8_t, 2>{0x66, 0x90}, // 2-byte nop
+    };
+    for (const std::array<std::uint8_t, 2> &entry : entries)
+    {
+        HotPatchableAdd site(entry);
+        ASSERT_TRUE(site.ok());
+        ASSERT_EQ(site.fn()(2, 3), 5);
+        {
+            Result<Hook> hook = inline_at(
+                InlineRequest{.name = "HotPatchAdd", .target = site.entry(), .options = {.hot_patch = true}},
+                &real_hook_detour_add);
+            ASSERT_TRUE(hook.has_value()) << hook.error().message();
+            EXPECT_EQ(site.entry_bytes(), HOT_PATCH_ARMED);
+            EXPECT_EQ(site.pad_bytes()[0], 0xE9);
+            EXPECT_EQ(site.fn()(2, 3), 2 + 3 + 1000);
+            EXPECT_EQ(hook->original<HotPatchableAdd::Fn>()(2, 3), 5) << "the original replays the entry instruction";
+            EXPECT_EQ(hook->call<int>(2, 3), 5);
+
+            ASSERT_TRUE(hook->disable().has_value());
+            EXPECT_EQ(site.entry_bytes(), entry);
+            EXPECT_EQ(site.fn()(2, 3), 5);
+            EXPECT_NE(site.pad_bytes()[0], 0xCC) << "disabling rewrites only the entry";
+            ASSERT_TRUE(hook->enable().has_value());
+            EXPECT_EQ(site.entry_bytes(), HOT_PATCH_ARMED);
+            EXPECT_EQ(site.fn()(2, 3), 2 + 3 + 1000);
+        }
+        EXPECT_EQ(site.entry_bytes(), entry);
+        EXPECT_EQ(site.pad_bytes(), INT3_FILLER);
+        EXPECT_EQ(site.fn()(2, 3), 5);
+    }
+}
+
+TEST(HookHotPatch, TargetsWithoutThePadLayoutTakeTheRegularBackend)
+{
+    // No filler before this entry's first instruction: the flag falls back to an ordinary inline hook.
+    Result<Hook> hook = inline_at(InlineRequest{.name = "HotPatchFallback",
+                                                .target = addr_of(&real_hook_target_add),
+                                                .options = {.hot_patch = true}},
+                                  &real_hook_detour_add);
+    ASSERT_TRUE(hook.has_value()) << hook.error().message();
+    EXPECT_NE(*reinterpret_cast<const std::uint8_t *>(&real_hook_target_add), 0xEB);
+    EXPECT_EQ(real_hook_target_add(2, 3), 2 + 3 + 1000);
+    EXPECT_EQ(hook->original<int (*)(int, int)>()(2, 3), 5);
+
+    // Neither does a site whose 2-byte entry instruction cannot be replayed from a stub.
+    HotPatchableAdd site({0x89, 0xC8}); // mov eax, ecx
+    ASSERT_TRUE(site.ok());
+    Result<Hook> other = inline_at(
+        InlineRequest{.name = "HotPatchNoReplay", .target = site.entry(), .options = {.hot_patch = true}},
+        &real_hook_detour_add);
+    ASSERT_TRUE(other.has_value()) << other.error().message();
+    EXPECT_NE(site.entry_bytes(), HOT_PATCH_ARMED);
+    EXPECT_EQ(site.pad_bytes(), INT3_FILLER);
+    EXPECT_EQ(site.fn()(2, 3), 2 + 3 + 1000);
+}
+
+// Transaction
+
+TEST(HookTransaction, CommitFlipsTheWholeSetAndTheLastQueuedOperationWins)
+{
+    Result<Hook> add = inline_at(InlineRequest{.name = "TxAdd", .target = addr_of(&real_hook_target_add)},
+                                 &real_hook_detour_add);
+    ASSERT_TRUE(add.has_value()) << add.error().message();
+    auto detour = [](MidContext &ctx) { gpr(ctx, Gpr::Rcx) = 10; };
+    Result<Hook> mul = mid_at(MidRequest{.name = "TxMul", .target = addr_of(&real_hook_target_mul)}, detour);
+    ASSERT_TRUE(mul.has_value()) << mul.error().message();
+    EXPECT_EQ(real_hook_target_add(2, 3), 2 + 3 + 1000);
+    EXPECT_EQ(real_hook_target_mul(4, 5), 10 * 5);
+
+    Transaction off;
+    off.disable(*add).disable(*mul);
+    EXPECT_EQ(off.size(), 2u);
+    ASSERT_TRUE(off.commit().has_value());
+    EXPECT_EQ(off.size(), 0u);
+    EXPECT_FALSE(add->is_enabled());
+    EXPECT_FALSE(mul->is_enabled());
+    EXPECT_EQ(real_hook_target_add(2, 3), 5);
+    EXPECT_EQ(real_hook_target_mul(4, 5), 20);
+
+    Transaction on;
+    on.enable(*add).disable(*add).enable(*add).enable(*mul);
+    ASSERT_TRUE(on.commit().has_value());
+    EXPECT_TRUE(add->is_enabled());
+    EXPECT_TRUE(mul->is_enabled());
+    EXPECT_EQ(real_hook_target_add(2, 3), 2 + 3 + 1000);
+    EXPECT_EQ(real_hook_target_mul(4, 5), 10 * 5);
+
+    // A hook already in its requested state is left alone.
+    ASSERT_TRUE(on.enable(*add).commit().has_value());
+    EXPECT_TRUE(add->is_enabled());
+}
+
+TEST(HookTransaction, AnEmptyHandleFailsTheCommitWithNothingApplied)
+{
+    Result<Hook> add = inline_at(InlineRequest{.name = "TxAtomic", .target = addr_of(&real_hook_target_add)},
+                                 &real_hook_detour_add);
+    ASSERT_TRUE(add.has_value()) << add.error().message();
+    Hook moved_from = std::move(*add);
+    Hook &live = moved_from;
+    Hook &empty = *add;
+
+    Transaction tx;
+    tx.disable(live).disable(empty);
+    const Result<void> committed = tx.commit();
+    ASSERT_FALSE(committed.has_value());
+    EXPECT_EQ(committed.error().code, ErrorCode::InvalidHookState);
+    EXPECT_EQ(tx.size(), 2u);
+    EXPECT_TRUE(live.is_enabled());
+    EXPECT_EQ(real_hook_target_add(2, 3), 2 + 3 + 1000);
+
+    tx.clear();
+    EXPECT_TRUE(tx.commit().has_value());
+}
+
+TEST(HookTransaction, AScheduledCommitLandsOnTheNextFrameBoundary)
+{
+    Result<Hook> add = inline_at(InlineRequest{.name = "TxFrame", .target = addr_of(&real_hook_target_add)},
+                                 &real_hook_detour_add);
+    ASSERT_TRUE(add.has_value()) << add.error().message();
+
+    Transaction tx;
+    tx.disable(*add);
+    ASSERT_TRUE(tx.on_frame_boundary().has_value());
+    EXPECT_TRUE(add->is_enabled()) << "an unscheduled transaction must not commit at a frame boundary";
+
+    std::thread toggler([&tx] { tx.schedule(); });
+    toggler.join();
+    EXPECT_TRUE(tx.is_scheduled());
+    EXPECT_TRUE(add->is_enabled());
+
+    ASSERT_TRUE(tx.on_frame_boundary().has_value());
+    EXPECT_FALSE(tx.is_scheduled());
+    EXPECT_FALSE(add->is_enabled());
+    EXPECT_EQ(real_hook_target_add(2, 3), 5);
+}
+
 TEST(HookLedger, SameTargetReservationsWaitForCommit)
 {
     auto &ledger = DetourModKit::detail::HookLedger::instance();
@@ -922,7 +1176,7 @@ TEST(HookInstallAll, MandatoryMissFailsWholeCall)
     Result<std::vector<InstallOutcome>> res = install_all(table);
     ASSERT_FALSE(res.has_value());
     EXPECT_EQ(res.error().code, ErrorCode::NoMatch);
-    // The prior Mandatory row that landed is rolled back; nothing stays installed.
+    // Every row resolves before any is patched, so the scan miss fails the call before the hit row is installed.
     EXPECT_FALSE(is_target_hooked(addr_of(&install_target_one)));
 }
 
@@ -949,6 +1203,42 @@ TEST(HookInstallAll, BestEffortMissStillSucceedsWithMandatoryHit)
     EXPECT_TRUE((*res)[1].hook.has_value()) << (*res)[1].hook.error().message();
 }
 
+// The span overload fills caller-owned slots in table order and reports the same per-row outcomes as the vector one,
+// and rejects a span shorter than the table before resolving anything.
+TEST(HookInstallAll, SpanOverloadFillsCallerSlots)
+{
+    const HookSpec table[] = {
+        HookSpec::inline_hook("SpanMiss", unresolvable_request("SpanMissPat"), &install_detour_one,
+                              Severity::BestEffort),
+        HookSpec::inline_hook("SpanHit", resolvable_request("SpanHitPat", &install_target_two), &install_detour_two,
+                              Severity::Mandatory),
+    };
+
+    InstallOutcome short_out[1];
+    Result<void> rejected = install_all(table, short_out);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidArg);
+    EXPECT_FALSE(is_target_hooked(addr_of(&install_target_two)));
+
+    InstallOutcome out[2];
+    Result<void> res = install_all(table, out);
+    ASSERT_TRUE(res.has_value()) << res.error().message();
+
+    EXPECT_EQ(out[0].name, "SpanMiss");
+    EXPECT_EQ(out[0].severity, Severity::BestEffort);
+    ASSERT_FALSE(out[0].hook.has_value());
+    EXPECT_EQ(out[0].hook.error().code, ErrorCode::NoMatch);
+
+    EXPECT_EQ(out[1].name, "SpanHit");
+    EXPECT_EQ(out[1].severity, Severity::Mandatory);
+    EXPECT_TRUE(out[1].hook.has_value()) << out[1].hook.error().message();
+    EXPECT_TRUE(is_target_hooked(addr_of(&install_target_two)));
+
+    // The slots own the hooks: resetting one uninstalls it exactly as dropping the vector overload's row would.
+    out[1].hook = std::unexpected(Error{ErrorCode::HookNotFound, "test"});
+    EXPECT_FALSE(is_target_hooked(addr_of(&install_target_two)));
+}
+
 // install_all shares the never-terminate contract with scan::resolve_batch: it is noexcept and, under true
 // out-of-memory, reports the failure in its own result shape rather than terminating the host. Its shape is a
 // single Result<vector<InstallOutcome>>, so a container-allocation failure surfaces as unexpected(Error{OutOfMemory}),
@@ -1014,9 +1304,11 @@ TEST(HookInstallAll, AllocFailureReturnsOutOfMemoryWithoutEscaping)
     EXPECT_FALSE(is_target_hooked(addr_of(&install_target_one)));
 }
 
-// On a mandatory miss, install_all rolls the already-installed rows back newest-first. A std::vector<InstallOutcome>
-// unwind does not provide that teardown contract; install_all's InstallRollback guard pops back-to-front instead. The
-// Removed lifecycle events make the teardown order observable without forcing a faulting repro.
+// On a mandatory install failure, install_all rolls the already-installed rows back newest-first. A
+// std::vector<InstallOutcome> unwind does not provide that teardown contract; install_all's InstallRollback guard pops
+// back-to-front instead. The failing row resolves (a scan miss would fail before anything is patched) but refuses the
+// target the first row just hooked. The Removed lifecycle events make the teardown order observable without forcing a
+// faulting repro.
 TEST(HookInstallAll, MandatoryMissRollsBackNewestFirst)
 {
     std::vector<std::string> removed;
@@ -1034,13 +1326,13 @@ TEST(HookInstallAll, MandatoryMissRollsBackNewestFirst)
                               &install_detour_one, Severity::Mandatory),
         HookSpec::inline_hook("RollbackNewer", resolvable_request("RbNewerPat", &install_target_two),
                               &install_detour_two, Severity::Mandatory),
-        HookSpec::inline_hook("RollbackMiss", unresolvable_request("RbMissPat"), &install_detour_one,
-                              Severity::Mandatory),
+        HookSpec::inline_hook("RollbackMiss", resolvable_request("RbMissPat", &install_target_one), &install_detour_one,
+                              Severity::Mandatory, Options{.fail_if_already_hooked = true}),
     };
 
     Result<std::vector<InstallOutcome>> res = install_all(table);
     ASSERT_FALSE(res.has_value());
-    EXPECT_EQ(res.error().code, ErrorCode::NoMatch);
+    EXPECT_EQ(res.error().code, ErrorCode::TargetAlreadyHookedInProcess);
 
     // Both installed rows rolled back cleanly...
     EXPECT_FALSE(is_target_hooked(addr_of(&install_target_one)));
@@ -1051,6 +1343,38 @@ TEST(HookInstallAll, MandatoryMissRollsBackNewestFirst)
     EXPECT_EQ(removed[1], "RollbackOlder");
 }
 
+// The table pre-flight applies a row's refusals before the first patch: a Mandatory row refused there fails the call
+// with no row installed at all, where the install loop would have patched the rows before it and rolled them back.
+TEST(HookInstallAll, PreflightRefusalFailsBeforeAnyRowIsPatched)
+{
+    Result<Hook> pre = inline_at(InlineRequest{.name = "PreflightPreHook", .target = addr_of(&install_target_one)},
+                                 &install_detour_one);
+    ASSERT_TRUE(pre.has_value()) << pre.error().message();
+    Hook keep = std::move(*pre);
+
+    std::vector<std::string> created;
+    auto sub = diagnostics::hook_lifecycle().subscribe(
+        [&created](const diagnostics::HookLifecycleEvent &e)
+        {
+            if (e.transition == diagnostics::HookTransition::Created)
+            {
+                created.emplace_back(e.name);
+            }
+        });
+
+    const HookSpec table[] = {
+        HookSpec::inline_hook("PreflightFirst", resolvable_request("PfFirstPat", &install_target_two),
+                              &install_detour_two, Severity::Mandatory),
+        HookSpec::inline_hook("PreflightRefused", resolvable_request("PfRefusedPat", &install_target_one),
+                              &install_detour_two, Severity::Mandatory, Options{.fail_if_already_hooked = true}),
+    };
+    Result<std::vector<InstallOutcome>> res = install_all(table);
+    ASSERT_FALSE(res.has_value());
+    EXPECT_EQ(res.error().code, ErrorCode::TargetAlreadyHookedInProcess);
+    EXPECT_TRUE(created.empty()) << "no row may be patched once the pre-flight refused a Mandatory row";
+    EXPECT_FALSE(is_target_hooked(addr_of(&install_target_two)));
+}
+
 // VMT object hooking (RAII VmtHook)
 
 class VmtTestInterface
@@ -1068,6 +1392,14 @@ public:
     int transform(int x) override { return x * 2; }
 };
 
+// A sibling class with its own vtable, for the batch apply's class-identity check.
+class VmtOtherTarget : public VmtTestInterface
+{
+public:
+    int compute(int a, int b) override { return a - b; }
+    int transform(int x) override { return x * 3; }
+};
+
 // VMT method-hook test fixtures. The per-method surface installs a detour straight into a cloned vtable slot, so a
 // detour models the virtual method's real ABI: the object arrives as the leading integer argument (`this` in rcx under
 // the Win64 ABI) with no calling-convention decoration, because x64 has a single convention. The detour reaches the
@@ -1508,6 +1840,93 @@ TEST(HookVmt, ApplyToAndRemoveFromMultipleObjects)
     EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(target2.get()), vptr2_original); // restored
 }
 
+// apply_to_many validates the whole batch, applies each distinct object once, and skips objects already on the clone.
+TEST(HookVmt, ApplyToManyPutsEverySeedClassObjectOnTheClone)
+{
+    auto seed = std::make_unique<VmtTestTarget>();
+    std::vector<std::unique_ptr<VmtTestTarget>> actors;
+    for (int i = 0; i < 16; ++i)
+    {
+        actors.push_back(std::make_unique<VmtTestTarget>());
+    }
+    const auto original_vptr = *reinterpret_cast<std::uintptr_t *>(actors[0].get());
+
+    {
+        Result<VmtHook> r = vmt_for("BatchVmt", seed.get());
+        ASSERT_TRUE(r.has_value()) << r.error().message();
+        VmtHook vh = std::move(*r);
+        const auto clone_vptr = *reinterpret_cast<std::uintptr_t *>(seed.get());
+
+        std::vector<void *> batch;
+        for (const auto &actor : actors)
+        {
+            batch.push_back(actor.get());
+        }
+        batch.push_back(actors[3].get()); // a duplicate is applied once
+        batch.push_back(seed.get());      // already on the clone: skipped
+
+        Result<std::size_t> applied = vh.apply_to_many(batch);
+        ASSERT_TRUE(applied.has_value()) << applied.error().message();
+        EXPECT_EQ(*applied, actors.size());
+        for (const auto &actor : actors)
+        {
+            EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(actor.get()), clone_vptr);
+            EXPECT_EQ(actor->compute(2, 3), 5);
+        }
+
+        // A second pass finds every object already applied.
+        Result<std::size_t> again = vh.apply_to_many(batch);
+        ASSERT_TRUE(again.has_value()) << again.error().message();
+        EXPECT_EQ(*again, 0u);
+    }
+
+    // Teardown restores every batch-applied object.
+    for (const auto &actor : actors)
+    {
+        EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(actor.get()), original_vptr);
+    }
+}
+
+// One bad entry fails the whole batch before any vptr is written.
+TEST(HookVmt, ApplyToManyIsAllOrNothing)
+{
+    auto seed = std::make_unique<VmtTestTarget>();
+    auto good = std::make_unique<VmtTestTarget>();
+    auto other = std::make_unique<VmtOtherTarget>();
+    const auto good_vptr = *reinterpret_cast<std::uintptr_t *>(good.get());
+    const auto other_vptr = *reinterpret_cast<std::uintptr_t *>(other.get());
+
+    Result<VmtHook> r = vmt_for("BatchAllOrNothing", seed.get());
+    ASSERT_TRUE(r.has_value()) << r.error().message();
+    VmtHook vh = std::move(*r);
+
+    const std::array<void *, 2> wrong_class = {good.get(), other.get()};
+    Result<std::size_t> mixed = vh.apply_to_many(wrong_class);
+    ASSERT_FALSE(mixed.has_value());
+    EXPECT_EQ(mixed.error().code, ErrorCode::InvalidObject);
+    EXPECT_EQ(mixed.error().detail, other_vptr);
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(good.get()), good_vptr);
+
+    const std::array<void *, 2> with_null = {good.get(), nullptr};
+    Result<std::size_t> null_entry = vh.apply_to_many(with_null);
+    ASSERT_FALSE(null_entry.has_value());
+    EXPECT_EQ(null_entry.error().code, ErrorCode::InvalidObject);
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(good.get()), good_vptr);
+
+    // A seed-class object on a read-only page cannot take the vptr write, so the batch refuses it up front.
+    void *page = VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(page, nullptr);
+    std::memcpy(page, good.get(), sizeof(std::uintptr_t));
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(page, 0x1000, PAGE_READONLY, &old_protect));
+    const std::array<void *, 2> read_only = {good.get(), page};
+    Result<std::size_t> unwritable = vh.apply_to_many(read_only);
+    ASSERT_FALSE(unwritable.has_value());
+    EXPECT_EQ(unwritable.error().code, ErrorCode::InvalidObject);
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(good.get()), good_vptr);
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
 // Re-applying onto the handle's OWN clone is a success no-op; applying an object held by another live clone fails.
 TEST(HookVmt, ApplyToOwnCloneIsNoOpAnotherCloneFails)
 {
@@ -1939,6 +2358,113 @@ TEST(HookVmtMethod, DisengagedHandleFailsClosed)
     EXPECT_EQ(a.original<VmtComputeFn>(VMT_COMPUTE_INDEX), nullptr);
 }
 
+// VMT shared clones (vmt_shared)
+
+// Shared-clone detours ignore the original so each object's result shows which table it dispatched through.
+int shared_detour_compute(void *self, int a, int b)
+{
+    (void)self;
+    return (a * b) + 2000;
+}
+
+int shared_detour_transform(void *self, int x)
+{
+    (void)self;
+    return x + 3000;
+}
+
+// Objects hooked with the same method set land on one clone, and the clone outlives every handle but the last.
+TEST(HookVmtShared, SameMethodSetSharesOneCloneUntilTheLastHandleDrops)
+{
+    auto first = std::make_unique<VmtTestTarget>();
+    auto second = std::make_unique<VmtTestTarget>();
+    const std::uintptr_t original_vptr = *reinterpret_cast<std::uintptr_t *>(first.get());
+    const std::array<VmtMethod, 1> methods{vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute)};
+
+    Result<SharedVmtHook> a = vmt_shared("SharedVmt", first.get(), methods);
+    ASSERT_TRUE(a.has_value()) << a.error().message();
+    Result<SharedVmtHook> b = vmt_shared("SharedVmt", second.get(), methods);
+    ASSERT_TRUE(b.has_value()) << b.error().message();
+
+    const std::uintptr_t clone_vptr = *reinterpret_cast<std::uintptr_t *>(first.get());
+    EXPECT_NE(clone_vptr, original_vptr);
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(second.get()), clone_vptr);
+    EXPECT_EQ(a->share_count(), 2u);
+    EXPECT_EQ(dispatch_compute(first.get(), 3, 4), 2012);
+    EXPECT_EQ(dispatch_compute(second.get(), 3, 4), 2012);
+    EXPECT_EQ(dispatch_transform(second.get(), 5), 10);
+
+    auto *orig = b->original<VmtComputeFn>(VMT_COMPUTE_INDEX);
+    ASSERT_NE(orig, nullptr);
+    EXPECT_EQ(orig(second.get(), 3, 4), 7);
+    EXPECT_EQ(b->original<VmtComputeFn>(VMT_TRANSFORM_INDEX), nullptr);
+
+    // Dropping the seed's handle restores only the seed; the other object stays on the clone.
+    {
+        SharedVmtHook dropped = std::move(*a);
+    }
+    EXPECT_FALSE(static_cast<bool>(*a));
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(first.get()), original_vptr);
+    EXPECT_EQ(dispatch_compute(second.get(), 3, 4), 2012);
+    EXPECT_EQ(b->share_count(), 1u);
+
+    {
+        SharedVmtHook dropped = std::move(*b);
+    }
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(second.get()), original_vptr);
+    EXPECT_EQ(dispatch_compute(second.get(), 3, 4), 7);
+}
+
+// A different method set is a different key, so it gets its own clone; listing order does not change the key.
+TEST(HookVmtShared, DifferentMethodSetsGetTheirOwnClone)
+{
+    auto first = std::make_unique<VmtTestTarget>();
+    auto second = std::make_unique<VmtTestTarget>();
+    auto third = std::make_unique<VmtTestTarget>();
+    const std::array<VmtMethod, 1> compute_only{vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute)};
+    const std::array<VmtMethod, 2> both{vmt_method(VMT_TRANSFORM_INDEX, &shared_detour_transform),
+                                        vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute)};
+    const std::array<VmtMethod, 2> both_reordered{vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute),
+                                                  vmt_method(VMT_TRANSFORM_INDEX, &shared_detour_transform)};
+
+    Result<SharedVmtHook> a = vmt_shared("SharedCompute", first.get(), compute_only);
+    ASSERT_TRUE(a.has_value()) << a.error().message();
+    Result<SharedVmtHook> b = vmt_shared("SharedBoth", second.get(), both);
+    ASSERT_TRUE(b.has_value()) << b.error().message();
+    Result<SharedVmtHook> c = vmt_shared("SharedBoth", third.get(), both_reordered);
+    ASSERT_TRUE(c.has_value()) << c.error().message();
+
+    EXPECT_NE(*reinterpret_cast<std::uintptr_t *>(first.get()), *reinterpret_cast<std::uintptr_t *>(second.get()));
+    EXPECT_EQ(*reinterpret_cast<std::uintptr_t *>(second.get()), *reinterpret_cast<std::uintptr_t *>(third.get()));
+    EXPECT_EQ(a->share_count(), 1u);
+    EXPECT_EQ(c->share_count(), 2u);
+    EXPECT_EQ(dispatch_transform(first.get(), 5), 10);
+    EXPECT_EQ(dispatch_transform(third.get(), 5), 3005);
+}
+
+TEST(HookVmtShared, RejectsMalformedRequestsAndObjectsAlreadyShared)
+{
+    auto target = std::make_unique<VmtTestTarget>();
+    const std::array<VmtMethod, 1> methods{vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute)};
+    const std::array<VmtMethod, 2> repeated{vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute),
+                                            vmt_method(VMT_COMPUTE_INDEX, &shared_detour_compute)};
+    const std::array<VmtMethod, 1> null_detour{VmtMethod{VMT_COMPUTE_INDEX, nullptr}};
+
+    EXPECT_EQ(vmt_shared("", target.get(), methods).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(vmt_shared("SharedBad", target.get(), std::span<const VmtMethod>{}).error().code,
+              ErrorCode::InvalidArg);
+    EXPECT_EQ(vmt_shared("SharedBad", target.get(), repeated).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(vmt_shared("SharedBad", target.get(), null_detour).error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(vmt_shared("SharedBad", nullptr, methods).error().code, ErrorCode::InvalidObject);
+
+    Result<SharedVmtHook> held = vmt_shared("SharedOnce", target.get(), methods);
+    ASSERT_TRUE(held.has_value()) << held.error().message();
+    Result<SharedVmtHook> twice = vmt_shared("SharedOnce", target.get(), methods);
+    ASSERT_FALSE(twice.has_value());
+    EXPECT_EQ(twice.error().code, ErrorCode::HookAlreadyExists);
+    EXPECT_EQ(held->share_count(), 1u);
+}
+
 // Lifecycle events: typed transitions on the diagnostic bus
 namespace
 {
@@ -2247,14 +2773,14 @@ TEST(HookStackTest, PushReturnsUsableHandleAndReportsSize)
     // Scope exit restores echo cleanly (single hook, so order is moot but the stack still owns the teardown).
 }
 
-// Concurrency + reentrancy: the per-hook status machine and the call() guard under thread stress and self-reentry. The
-// per-hook recursive_mutex is held across call(), and disable()/~Hook must drain that mutex before the trampoline can
-// be restored or freed. These tests pin the caller-visible guarantees directly, including a parked original that keeps
-// the guard held until the test releases it.
+// Concurrency + reentrancy: the per-hook status machine and the call() gate under thread stress and self-reentry. A
+// call() holds an in-flight count on the per-hook gate, and disable()/~Hook must drain those counts before the
+// trampoline can be restored or freed. These tests pin the caller-visible guarantees directly, including a parked
+// original that keeps its count raised until the test releases it.
 namespace
 {
     // Reentrancy fixture: a recursive target whose self-call re-enters the hooked prologue, so a detour that forwards
-    // through call() is invoked again on the SAME thread while call() already holds the per-hook guard.
+    // through call() is invoked again on the SAME thread while call() is already in flight on the per-hook gate.
     std::atomic<int> s_reentrant_detour_calls{0};
     Hook *s_reentrant_hook = nullptr;
 
@@ -2271,18 +2797,20 @@ namespace
     int reentrant_detour(int n)
     {
         s_reentrant_detour_calls.fetch_add(1, std::memory_order_relaxed);
-        // Forward to the original through the guarded call(): it re-acquires the per-hook recursive_mutex. The original
-        // recurses back into this detour on the same thread, so the guard MUST be recursive or this self-deadlocks.
+        // Forward to the original through the guarded call(): it re-enters the per-hook gate. The original recurses
+        // back into this detour on the same thread, so the gate MUST admit a nested entry or this self-deadlocks.
         return s_reentrant_hook->call<int>(n);
     }
 
-    // Drain fixture: an original that parks inside call() (so call() keeps holding the guard) until the test releases
+    // Drain fixture: an original that parks inside call() (so call() keeps its count raised) until the test releases
     // it, giving a second thread a window to attempt disable() and observe that it waits for the in-flight call.
     std::atomic<bool> s_original_parked{false};
     std::atomic<bool> s_release_original{false};
+    std::atomic<int> s_original_parked_count{0};
 
     DMK_TEST_NOINLINE int parking_original(int x)
     {
+        s_original_parked_count.fetch_add(1, std::memory_order_acq_rel);
         s_original_parked.store(true, std::memory_order_release);
         while (!s_release_original.load(std::memory_order_acquire))
         {
@@ -2352,8 +2880,8 @@ TEST(HookConcurrency, ReentrantCallFromDetourRequiresRecursiveGuard)
     s_reentrant_detour_calls.store(0, std::memory_order_relaxed);
 
     // Invoking the hooked entry fires the detour, which forwards through the guarded call(); the original recurses into
-    // the hooked entry, re-entering the detour on the same thread. call() holds a per-hook recursive_mutex across the
-    // whole invocation, so the nested call() re-locks instead of self-deadlocking. A plain mutex would hang this line.
+    // the hooked entry, re-entering the detour on the same thread. call() takes no lock, so the nested call() only
+    // stacks a second in-flight count instead of self-deadlocking. A plain per-hook mutex would hang this line.
     const int result = reentrant_target(4);
     EXPECT_EQ(result, 4);                                                   // recursion adds 1 four times down to 0
     EXPECT_EQ(s_reentrant_detour_calls.load(std::memory_order_relaxed), 5); // detour fired at depths 4,3,2,1,0
@@ -2369,16 +2897,16 @@ TEST(HookConcurrency, DisableDrainsAnInFlightCall)
     s_original_parked.store(false, std::memory_order_release);
     s_release_original.store(false, std::memory_order_release);
 
-    // Thread A enters call(), which acquires the per-hook guard and runs the original; the original parks, so the guard
-    // stays held for as long as the test wants.
+    // Thread A enters call(), which raises its in-flight count and runs the original; the original parks, so the count
+    // stays raised for as long as the test wants.
     std::thread caller([&h]() { (void)h.call<int>(7); });
     while (!s_original_parked.load(std::memory_order_acquire))
     {
         std::this_thread::yield();
     }
 
-    // Thread B attempts disable() while the call is parked. disable() acquires the SAME guard, so it MUST block until
-    // the call releases it -- it must never free the trampoline out from under the in-flight original.
+    // Thread B attempts disable() while the call is parked. disable() drains the SAME gate, so it MUST block until the
+    // call returns -- it must never report the hook quiescent while the original is still in flight.
     std::atomic<bool> disable_started{false};
     std::atomic<bool> disable_returned{false};
     std::thread disabler(
@@ -2393,8 +2921,8 @@ TEST(HookConcurrency, DisableDrainsAnInFlightCall)
         std::this_thread::yield();
     }
 
-    // While the original is parked the guard is physically held, so disable() must not complete. A broken drain
-    // (disable freeing the trampoline without waiting) can flip this flag before the release below.
+    // While the original is parked its count is still raised, so disable() must not complete. A broken drain (disable
+    // returning without waiting) can flip this flag before the release below.
     for (int spin = 0; spin < 1000; ++spin)
     {
         ASSERT_FALSE(disable_returned.load(std::memory_order_acquire))
@@ -2402,7 +2930,7 @@ TEST(HookConcurrency, DisableDrainsAnInFlightCall)
         std::this_thread::yield();
     }
 
-    // Release the original; the call returns, the guard drops, and disable() drains through to completion.
+    // Release the original; the call returns, its count drops, and disable() drains through to completion.
     s_release_original.store(true, std::memory_order_release);
     disabler.join();
     caller.join();
@@ -2410,6 +2938,33 @@ TEST(HookConcurrency, DisableDrainsAnInFlightCall)
     EXPECT_FALSE(h.is_enabled());
 }
 
+TEST(HookConcurrency, GuardedCallsOnSeparateThreadsDoNotSerialize)
+{
+    Result<Hook> r =
+        inline_at(InlineRequest{.name = "ParallelCall", .target = addr_of(&parking_original)}, &echo_detour);
+    ASSERT_TRUE(r.has_value()) << r.error().message();
+    Hook h = std::move(*r);
+    s_original_parked_count.store(0, std::memory_order_release);
+    s_release_original.store(false, std::memory_order_release);
+
+    // Two threads call through the same hook while the original parks. The gate takes no lock, so both must be inside
+    // the original at once; a per-hook mutex would hold the second caller at the gate until the first returned.
+    std::thread first([&h]() { EXPECT_EQ(h.call<int>(3), 3); });
+    std::thread second([&h]() { EXPECT_EQ(h.try_call<int>(4).value_or(-1), 4); });
+    while (s_original_parked_count.load(std::memory_order_acquire) < 2)
+    {
+        std::this_thread::yield();
+    }
+
+    s_release_original.store(true, std::memory_order_release);
+    first.join();
+    second.join();
+
+    // Both counts drained, so disable() returns at once, and a guarded call through the disabled hook fails closed.
+    ASSERT_TRUE(h.disable().has_value());
+    EXPECT_FALSE(h.try_call<int>(5).has_value());
+}
+
 // The load-bearing property behind ~Hook's decide-vs-restore atomicity: while a teardown holds a target's
 // serialization slot (acquire_teardown_slot), a concurrent install on the same target cannot reach the Reserved
 // state, so it cannot read the target's still-patched prologue as its resume. That closes the peek/restore window in
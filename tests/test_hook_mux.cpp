@@ -0,0 +1,273 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "DetourModKit/hook_mux.hpp"
+
+using namespace DetourModKit;
+using namespace DetourModKit::hook;
+
+#if defined(_MSC_VER)
+#define DMK_TEST_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DMK_TEST_NOINLINE [[gnu::noinline]]
+#else
+#define DMK_TEST_NOINLINE
+#endif
+
+// One target and one Tag per test: a Tag names a single live multiplexer, and a volatile result keeps each call a real
+// call to the patched entry.
+namespace
+{
+    DMK_TEST_NOINLINE int mux_target_order(int a, int b)
+    {
+        volatile int r = a + b;
+        return r;
+    }
+
+    DMK_TEST_NOINLINE int mux_target_early(int a, int b)
+    {
+        volatile int r = a + b;
+        return r;
+    }
+
+    DMK_TEST_NOINLINE int mux_target_passthrough(int a, int b)
+    {
+        volatile int r = a * b;
+        return r;
+    }
+
+    DMK_TEST_NOINLINE void mux_target_void(int *out, int value)
+    {
+        volatile int v = value;
+        *out = v;
+    }
+
+    DMK_TEST_NOINLINE int mux_target_concurrent(int x)
+    {
+        volatile int r = x;
+        return r;
+    }
+
+    struct OrderTag
+    {
+    };
+    struct EarlyTag
+    {
+    };
+    struct PassthroughTag
+    {
+    };
+    struct DuplicateTag
+    {
+    };
+    struct VoidTag
+    {
+    };
+    struct ConcurrentTag
+    {
+    };
+
+    template <class Fn> [[nodiscard]] Address addr_of(Fn *fn) noexcept
+    {
+        return Address{reinterpret_cast<std::uintptr_t>(fn)};
+    }
+
+    using AddFrame = MuxFrame<int, int, int>;
+
+    std::vector<int> s_order;
+
+    void record_pre_a(AddFrame &frame)
+    {
+        s_order.push_back(1);
+        frame.arg<0>() += 10;
+    }
+
+    void record_pre_b(AddFrame &frame)
+    {
+        s_order.push_back(2);
+        frame.arg<1>() += 100;
+    }
+
+    void record_post_double(AddFrame &frame)
+    {
+        s_order.push_back(3);
+        frame.result() *= 2;
+    }
+
+    void return_seven(AddFrame &frame)
+    {
+        frame.return_early(7);
+    }
+
+    std::atomic<int> s_skipped_pre_calls{0};
+
+    void count_pre(AddFrame &frame)
+    {
+        (void)frame;
+        s_skipped_pre_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<bool> s_post_saw_early{false};
+
+    void note_early(AddFrame &frame)
+    {
+        s_post_saw_early.store(frame.returned_early() && frame.result() == 7, std::memory_order_relaxed);
+    }
+
+    void skip_void(MuxFrame<void, int *, int> &frame)
+    {
+        frame.arg<1>() = -1;
+        frame.return_early();
+    }
+
+    std::atomic<int> s_concurrent_calls{0};
+
+    void count_concurrent(MuxFrame<int, int> &frame)
+    {
+        (void)frame;
+        s_concurrent_calls.fetch_add(1, std::memory_order_relaxed);
+    }
+} // namespace
+
+TEST(HookMux, PreHandlersRewriteArgumentsAndPostHandlersRewriteTheResultInOrder)
+{
+    auto mux = multiplex_at<OrderTag, int(int, int)>(
+        InlineRequest{.name = "MuxOrder", .target = addr_of(&mux_target_order)});
+    ASSERT_TRUE(mux.has_value()) << mux.error().message();
+    EXPECT_EQ(mux->handler_count(), 0u);
+    EXPECT_EQ(mux_target_order(1, 2), 3);
+
+    ASSERT_TRUE(mux->add_pre(&record_pre_a).has_value());
+    ASSERT_TRUE(mux->add_pre(&record_pre_b).has_value());
+    ASSERT_TRUE(mux->add_post(&record_post_double).has_value());
+    EXPECT_EQ(mux->handler_count(), 3u);
+
+    s_order.clear();
+    EXPECT_EQ(mux_target_order(1, 2), (11 + 102) * 2);
+    EXPECT_EQ(s_order, (std::vector<int>{1, 2, 3}));
+
+    // The trampoline bypasses the handlers entirely.
+    ASSERT_NE(mux->original(), nullptr);
+    EXPECT_EQ(mux->original()(1, 2), 3);
+}
+
+TEST(HookMux, EarlyReturnSkipsTheOriginalAndLaterPreHandlersButNotPostHandlers)
+{
+    auto mux = multiplex_at<EarlyTag, int(int, int)>(
+        InlineRequest{.name = "MuxEarly", .target = addr_of(&mux_target_early)});
+    ASSERT_TRUE(mux.has_value()) << mux.error().message();
+    ASSERT_TRUE(mux->add_pre(&return_seven).has_value());
+    ASSERT_TRUE(mux->add_pre(&count_pre).has_value());
+    ASSERT_TRUE(mux->add_post(&note_early).has_value());
+
+    s_skipped_pre_calls.store(0);
+    s_post_saw_early.store(false);
+    EXPECT_EQ(mux_target_early(1, 2), 7);
+    EXPECT_EQ(s_skipped_pre_calls.load(), 0);
+    EXPECT_TRUE(s_post_saw_early.load());
+}
+
+TEST(HookMux, RemovingHandlersRestoresPassthroughWithoutRepatching)
+{
+    auto mux = multiplex_at<PassthroughTag, int(int, int)>(
+        InlineRequest{.name = "MuxPassthrough", .target = addr_of(&mux_target_passthrough)});
+    ASSERT_TRUE(mux.has_value()) << mux.error().message();
+
+    auto id = mux->add_pre(&return_seven);
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(mux_target_passthrough(3, 4), 7);
+
+    ASSERT_TRUE(mux->remove(*id).has_value());
+    EXPECT_EQ(mux->handler_count(), 0u);
+    EXPECT_EQ(mux_target_passthrough(3, 4), 12);
+    EXPECT_TRUE(mux->hook().is_enabled());
+
+    // A second remove of the same id, and a null handler, are refused.
+    auto again = mux->remove(*id);
+    ASSERT_FALSE(again.has_value());
+    EXPECT_EQ(again.error().code, ErrorCode::InvalidArg);
+    auto null_handler = mux->add_post(nullptr);
+    ASSERT_FALSE(null_handler.has_value());
+    EXPECT_EQ(null_handler.error().code, ErrorCode::InvalidArg);
+}
+
+TEST(HookMux, ASecondLiveMultiplexerOfTheSameTagIsRefused)
+{
+    auto first = multiplex_at<DuplicateTag, int(int, int)>(
+        InlineRequest{.name = "MuxDuplicate", .target = addr_of(&mux_target_order)});
+    ASSERT_TRUE(first.has_value()) << first.error().message();
+
+    auto second = multiplex_at<DuplicateTag, int(int, int)>(
+        InlineRequest{.name = "MuxDuplicate2", .target = addr_of(&mux_target_early)});
+    ASSERT_FALSE(second.has_value());
+    EXPECT_EQ(second.error().code, ErrorCode::HookAlreadyExists);
+
+    // Dropping the owner unpatches the target and frees the Tag for a fresh install.
+    {
+        auto dropped = std::move(*first);
+        EXPECT_FALSE(static_cast<bool>(*first));
+    }
+    EXPECT_EQ(mux_target_order(1, 2), 3);
+    auto third = multiplex_at<DuplicateTag, int(int, int)>(
+        InlineRequest{.name = "MuxDuplicate3", .target = addr_of(&mux_target_order)});
+    EXPECT_TRUE(third.has_value());
+}
+
+TEST(HookMux, VoidTargetsReturnEarlyWithoutResult)
+{
+    auto mux = multiplex_at<VoidTag, void(int *, int)>(
+        InlineRequest{.name = "MuxVoid", .target = addr_of(&mux_target_void)});
+    ASSERT_TRUE(mux.has_value()) << mux.error().message();
+
+    int out = 0;
+    mux_target_void(&out, 5);
+    EXPECT_EQ(out, 5);
+
+    ASSERT_TRUE(mux->add_pre(&skip_void).has_value());
+    out = 0;
+    mux_target_void(&out, 5);
+    EXPECT_EQ(out, 0);
+}
+
+TEST(HookMux, HandlersChangeWhileOtherThreadsCallThroughTheDetour)
+{
+    auto mux = multiplex_at<ConcurrentTag, int(int)>(
+        InlineRequest{.name = "MuxConcurrent", .target = addr_of(&mux_target_concurrent)});
+    ASSERT_TRUE(mux.has_value()) << mux.error().message();
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> wrong{0};
+    std::vector<std::thread> callers;
+    for (int t = 0; t < 4; ++t)
+    {
+        callers.emplace_back(
+            [&]
+            {
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    if (mux_target_concurrent(42) != 42)
+                    {
+                        wrong.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+    }
+    for (int round = 0; round < 500; ++round)
+    {
+        auto id = mux->add_pre(&count_concurrent);
+        ASSERT_TRUE(id.has_value());
+        ASSERT_TRUE(mux->remove(*id).has_value());
+    }
+    stop.store(true);
+    for (std::thread &caller : callers)
+    {
+        caller.join();
+    }
+    EXPECT_EQ(wrong.load(), 0);
+    EXPECT_EQ(mux->handler_count(), 0u);
+}
@@ -0,0 +1,210 @@
+#include "internal/ini_reader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <windows.h>
+
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+
+using DetourModKit::detail::ini_bool;
+using DetourModKit::detail::IniDocument;
+using DetourModKit::detail::MappedFile;
+
+using namespace std::string_view_literals;
+
+TEST(IniDocumentTest, LooksUpSectionsAndKeysCaseInsensitively)
+{
+    const IniDocument doc = IniDocument::parse("[General]\nWidth = 1920\n[Camera]\nfov=90\n", false);
+
+    EXPECT_EQ(doc.value("general", "WIDTH"), "1920");
+    EXPECT_EQ(doc.value("CAMERA", "Fov"), "90");
+    EXPECT_FALSE(doc.value("General", "fov").has_value());
+    EXPECT_FALSE(doc.value("Missing", "Width").has_value());
+    ASSERT_EQ(doc.sections().size(), 2u);
+    EXPECT_EQ(doc.sections()[0], "General");
+    EXPECT_EQ(doc.sections()[1], "Camera");
+    EXPECT_EQ(doc.size(), 2u);
+}
+
+// The reader must keep every value an existing config or manifest file carried through SimpleIni: blanks around a
+// name or value are trimmed, the last of a repeated key wins, a repeated header reopens its section, and comment,
+// key-less and header-less lines are ignored.
+TEST(IniDocumentTest, FollowsTheSimpleIniGrammar)
+{
+    const std::string_view text = "; leading comment\n"
+                                  "root = top\n"
+                                  "[ Spaced ]  trailing text\n"
+                                  "  key   =   padded value \t\r\n"
+                                  "# hash comment\n"
+                                  "no equals sign\n"
+                                  "= no key\n"
+                                  "[unterminated\n"
+                                  "after = still Spaced\n"
+                                  "empty =\n"
+                                  "[spaced]\n"
+                                  "KEY = last wins\n";
+    const IniDocument doc = IniDocument::parse(text, false);
+
+    EXPECT_EQ(doc.value("", "root"), "top");
+    EXPECT_EQ(doc.value("Spaced", "key"), "last wins");
+    EXPECT_EQ(doc.value("Spaced", "after"), "still Spaced");
+    EXPECT_EQ(doc.value("Spaced", "empty"), "");
+    EXPECT_FALSE(doc.value("Spaced", "no equals sign").has_value());
+    EXPECT_FALSE(doc.has_section("unterminated"));
+    ASSERT_EQ(doc.sections().size(), 2u);
+    EXPECT_EQ(doc.sections()[0], "");
+    EXPECT_EQ(doc.sections()[1], "Spaced");
+    EXPECT_EQ(doc.size(), 4u);
+}
+
+TEST(IniDocumentTest, ValuesAreViewsIntoTheText)
+{
+    const std::string text = "[s]\nk = value\n";
+    const IniDocument doc = IniDocument::parse(text, false);
+
+    const std::optional<std::string_view> value = doc.value("s", "k");
+    ASSERT_TRUE(value.has_value());
+    EXPECT_GE(value->data(), text.data());
+    EXPECT_LE(value->data() + value->size(), text.data() + text.size());
+}
+
+TEST(IniDocumentTest, SkipsBomAndEndsAtNul)
+{
+    const std::string text{"\xEF\xBB\xBF[s]\nk = v\n\0[hidden]\nx = 1\n", 29};
+    const IniDocument doc = IniDocument::parse(text, false);
+
+    EXPECT_EQ(doc.value("s", "k"), "v");
+    EXPECT_FALSE(doc.has_section("hidden"));
+}
+
+TEST(IniDocumentTest, HeredocJoinsLinesUpToTheTag)
+{
+    const std::string_view text = "[s]\n"
+                                  "lf = <<<END\n"
+                                  "first\n"
+                                  "  second \n"
+                                  "end \t\n"
+                                  "crlf = <<<END\r\n"
+                                  "a\r\n"
+                                  "\r\n"
+                                  "END\r\n"
+                                  "next = plain\n"
+                                  "open = <<<END\n"
+                                  "tail\n";
+    const IniDocument doc = IniDocument::parse(text, true);
+
+    EXPECT_EQ(doc.value("s", "lf"), "first\n  second ");
+    EXPECT_EQ(doc.value("s", "crlf"), "a\n");
+    EXPECT_EQ(doc.value("s", "next"), "plain");
+    // An unclosed heredoc runs to the end of the text, its final line break included.
+    EXPECT_EQ(doc.value("s", "open"), "tail\n");
+}
+
+TEST(IniDocumentTest, HeredocIsPlainTextWhenMultiLineIsOff)
+{
+    const IniDocument doc = IniDocument::parse("[s]\nk = <<<END\nline = 1\nEND\n", false);
+
+    EXPECT_EQ(doc.value("s", "k"), "<<<END");
+    EXPECT_EQ(doc.value("s", "line"), "1");
+}
+
+TEST(IniDocumentTest, IndexHoldsManySectionsAndKeys)
+{
+    std::string text;
+    for (int i = 0; i < 1000; ++i)
+    {
+        text += "[section" + std::to_string(i % 50) + "]\nkey" + std::to_string(i) + " = " + std::to_string(i) + "\n";
+    }
+    const IniDocument doc = IniDocument::parse(text, false);
+
+    EXPECT_EQ(doc.sections().size(), 50u);
+    EXPECT_EQ(doc.size(), 1000u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ(doc.value("SECTION" + std::to_string(i % 50), "KEY" + std::to_string(i)), std::to_string(i));
+    }
+}
+
+TEST(IniBoolTest, MatchesSimpleIniGetBoolValue)
+{
+    for (const std::string_view truthy : {"true"sv, "T"sv, "yes"sv, "Y"sv, "1"sv, "on"sv, "ON"sv})
+    {
+        EXPECT_EQ(ini_bool(truthy), true) << truthy;
+    }
+    for (const std::string_view falsy : {"false"sv, "F"sv, "no"sv, "N"sv, "0"sv, "off"sv, "Off"sv})
+    {
+        EXPECT_EQ(ini_bool(falsy), false) << falsy;
+    }
+    for (const std::string_view neither : {""sv, "o"sv, "maybe"sv, "2"sv})
+    {
+        EXPECT_FALSE(ini_bool(neither).has_value()) << neither;
+    }
+}
+
+class MappedFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        m_path = std::filesystem::temp_directory_path() /
+                 ("dmk_ini_reader_" + std::to_string(GetCurrentProcessId()) + ".ini");
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_path, ec);
+    }
+
+    void write(std::string_view text) const
+    {
+        std::ofstream out(m_path, std::ios::binary | std::ios::trunc);
+        out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    }
+
+    std::filesystem::path m_path;
+};
+
+TEST_F(MappedFileTest, MapsTheWholeFile)
+{
+    write("[s]\nk = v\n");
+    MappedFile file;
+    ASSERT_TRUE(file.open(m_path));
+    EXPECT_EQ(file.text(), "[s]\nk = v\n");
+    EXPECT_EQ(IniDocument::parse(file.text(), false).value("s", "k"), "v");
+}
+
+TEST_F(MappedFileTest, EmptyFileMapsToEmptyText)
+{
+    write("");
+    MappedFile file;
+    ASSERT_TRUE(file.open(m_path));
+    EXPECT_TRUE(file.text().empty());
+}
+
+TEST_F(MappedFileTest, MissingFileFailsToOpen)
+{
+    MappedFile file;
+    EXPECT_FALSE(file.open(m_path));
+    EXPECT_TRUE(file.text().empty());
+}
+
+// The mapping denies write sharing so the bytes cannot change between hashing and parsing; a file a writer still holds
+// open fails to map instead.
+TEST_F(MappedFileTest, FileHeldForWritingFailsToOpen)
+{
+    write("[s]\nk = v\n");
+    const HANDLE writer = ::CreateFileW(m_path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    ASSERT_NE(writer, INVALID_HANDLE_VALUE);
+
+    MappedFile file;
+    EXPECT_FALSE(file.open(m_path));
+
+    ::CloseHandle(writer);
+    EXPECT_TRUE(file.open(m_path));
+}
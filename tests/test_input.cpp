@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <clocale>
@@ -16,7 +17,14 @@
 #include "internal/input_poller.hpp"
 #include "internal/input_intercept.hpp"
 #include "internal/input_binding_gate.hpp"
+#include "internal/gamepad_probe.hpp"
+#include "internal/input_cadence.hpp"
+#include "internal/input_event_ring.hpp"
 #include "internal/input_key_cache.hpp"
+#include "internal/input_key_mask.hpp"
+#include "internal/input_latency.hpp"
+#include "internal/input_raw_keys.hpp"
+#include "internal/input_replay.hpp"
 
 #include "test_alloc_probe.hpp"
 
@@ -118,6 +126,18 @@ TEST(TriggerTest, HoldToString)
     EXPECT_EQ(input::to_string(input::Trigger::Hold), "Hold");
 }
 
+TEST(BackendTest, ToStringAndDefault)
+{
+    EXPECT_EQ(input::to_string(input::Backend::Poll), "Poll");
+    EXPECT_EQ(input::to_string(input::Backend::RawInput), "RawInput");
+    EXPECT_EQ(input::Input::Settings{}.backend, input::Backend::Poll);
+    EXPECT_FALSE(input::Input::Settings{}.adaptive_polling);
+    const input::InputSnapshot empty;
+    EXPECT_EQ(empty.cycle(), 0u);
+    EXPECT_FALSE(empty.is_active(input::BindingToken{}));
+    EXPECT_EQ(empty.wheel_notches(WheelCode::Up), 0);
+}
+
 // InputBinding
 
 TEST(InputBindingTest, DefaultTriggerIsPress)
@@ -266,6 +286,169 @@ TEST_F(InputPollerTest, StartThenRunning)
     poller.shutdown();
 }
 
+TEST_F(InputPollerTest, RawInputBackendStartsAndStopsCleanly)
+{
+    std::atomic<int> presses{0};
+    std::vector<detail::InputBinding> bindings;
+    bindings.push_back(detail::InputBinding{"raw", {keyboard_key(0x87)}, {}, input::Trigger::Press, false, 0,
+                                            [&presses]() { presses.fetch_add(1); }, {}});
+    detail::InputPoller poller(std::move(bindings), input::DEFAULT_POLL_INTERVAL, false, 0,
+                               GamepadCode::TriggerThreshold, GamepadCode::StickThreshold, input::Backend::RawInput);
+    EXPECT_EQ(poller.backend(), input::Backend::RawInput);
+    EXPECT_FALSE(poller.raw_input_active());
+
+    // Whether the registration is taken depends on the host (a process that already registers raw input polls
+    // instead), so only the lifecycle is asserted: the thread runs, answers queries, and a sleeping event wait
+    // still wakes for shutdown promptly.
+    poller.start();
+    EXPECT_TRUE(poller.is_running());
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_FALSE(poller.is_binding_active("raw"));
+
+    const auto before = std::chrono::steady_clock::now();
+    poller.shutdown();
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::milliseconds(200));
+    EXPECT_FALSE(poller.is_running());
+    EXPECT_FALSE(poller.raw_input_active());
+    EXPECT_EQ(presses.load(), 0);
+}
+
+TEST_F(InputPollerTest, AdaptivePollingClampsAndIsFixedAtStart)
+{
+    std::vector<detail::InputBinding> bindings;
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(10));
+    EXPECT_EQ(poller.idle_poll_interval(), std::chrono::milliseconds(10));
+
+    poller.set_adaptive_polling(std::chrono::milliseconds(2), std::chrono::milliseconds(100));
+    EXPECT_EQ(poller.idle_poll_interval(), std::chrono::milliseconds(10));
+    poller.set_adaptive_polling(std::chrono::milliseconds(5000), std::chrono::milliseconds(100));
+    EXPECT_EQ(poller.idle_poll_interval(), input::MAX_POLL_INTERVAL);
+    poller.set_adaptive_polling(std::chrono::milliseconds(40), std::chrono::milliseconds(100));
+    EXPECT_EQ(poller.idle_poll_interval(), std::chrono::milliseconds(40));
+
+    poller.start();
+    poller.set_adaptive_polling(std::chrono::milliseconds(80), std::chrono::milliseconds(100));
+    EXPECT_EQ(poller.idle_poll_interval(), std::chrono::milliseconds(40));
+    poller.shutdown();
+}
+
+TEST_F(InputPollerTest, AdaptivePollingIdlesWithNothingHeld)
+{
+    // F24 is bound: nothing a test host presses, so every cycle is idle.
+    std::vector<detail::InputBinding> bindings;
+    bindings.push_back(detail::InputBinding{"idle", {keyboard_key(0x87)}, {}, input::Trigger::Press, false, 0, {}, {}});
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(1), false);
+    poller.set_adaptive_polling(std::chrono::milliseconds(5), std::chrono::milliseconds(20));
+    poller.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    poller.shutdown();
+
+    const input::PollCadenceStats stats = poller.cadence_stats();
+    EXPECT_GT(stats.idle_cycles, 0u);
+    EXPECT_EQ(stats.fast_cycles, 0u);
+    EXPECT_EQ(stats.fast_switches, 0u);
+    EXPECT_EQ(stats.event_cycles, 0u);
+}
+
+TEST_F(InputPollerTest, SnapshotCarriesTheCycleActiveBitsEdgesAndWheelNotches)
+{
+    std::vector<detail::InputBinding> bindings;
+    detail::InputBinding wheel;
+    wheel.name = "snap_wheel";
+    wheel.keys = {mouse_wheel(WheelCode::Up)};
+    bindings.push_back(std::move(wheel));
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(20), false);
+    const input::BindingToken token = poller.acquire_binding_token("snap_wheel");
+    ASSERT_TRUE(token.valid());
+
+    // Before the first cycle the snapshot is the default one.
+    EXPECT_EQ(poller.snapshot().cycle(), 0u);
+    EXPECT_FALSE(poller.snapshot().is_active(token));
+
+    poller.start();
+    detail::seed_wheel_notches_for_test({2, 0, 0, 0});
+
+    // Find the cycle that drained the notches: the wheel binding is active, and pressed, in that same view.
+    bool seen = false;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!seen && std::chrono::steady_clock::now() < deadline)
+    {
+        const input::InputSnapshot snap = poller.snapshot();
+        if (snap.wheel_notches(WheelCode::Up) == 2)
+        {
+            seen = true;
+            EXPECT_GT(snap.cycle(), 0u);
+            EXPECT_TRUE(snap.is_active(token));
+            EXPECT_TRUE(snap.pressed(token));
+            EXPECT_EQ(snap.wheel_notches(WheelCode::Down), 0);
+            EXPECT_EQ(snap.wheel_notches(0), 0);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(seen);
+
+    // A reshape advances the generation; a token minted before it fails closed against later snapshots.
+    detail::InputBinding other;
+    other.name = "snap_other";
+    other.keys = {keyboard_key(0x87)};
+    ASSERT_TRUE(poller.add_binding(std::move(other)));
+    const std::uint64_t after_reshape = poller.snapshot().cycle();
+    while (poller.snapshot().cycle() <= after_reshape + 1 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    detail::seed_wheel_notches_for_test({1, 0, 0, 0});
+    seen = false;
+    while (!seen && std::chrono::steady_clock::now() < deadline + std::chrono::seconds(2))
+    {
+        const input::InputSnapshot snap = poller.snapshot();
+        if (snap.wheel_notches(WheelCode::Up) == 1)
+        {
+            seen = true;
+            EXPECT_FALSE(snap.is_active(token));
+            EXPECT_TRUE(snap.is_active(poller.acquire_binding_token("snap_wheel")));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_TRUE(seen);
+    poller.shutdown();
+}
+
+TEST_F(InputPollerTest, GamepadSnapshotPublishesEachControllerRead)
+{
+    std::vector<detail::InputBinding> bindings;
+    detail::InputBinding pad;
+    pad.name = "snap_pad";
+    pad.keys = {gamepad_button(GamepadCode::A)};
+    bindings.push_back(std::move(pad));
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(5), false, 2);
+
+    // Before the first read the snapshot is the default one.
+    EXPECT_EQ(poller.gamepad_snapshot().timestamp, 0);
+    EXPECT_FALSE(poller.gamepad_snapshot().connected);
+
+    poller.start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (poller.gamepad_snapshot().timestamp == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    const input::GamepadSnapshot snap = poller.gamepad_snapshot();
+    poller.shutdown();
+
+    // The first cycle probes the slot whether or not a controller is attached.
+    EXPECT_NE(snap.timestamp, 0);
+    EXPECT_EQ(snap.slot, 2u);
+    if (!snap.connected)
+    {
+        EXPECT_EQ(snap.raw.buttons, 0u);
+        EXPECT_EQ(snap.raw.left_thumb_x, 0);
+    }
+    // No consume binding, so nothing is suppressed and the game sees the raw reading.
+    EXPECT_EQ(snap.game.buttons, snap.raw.buttons);
+    EXPECT_EQ(snap.game.right_thumb_y, snap.raw.right_thumb_y);
+}
+
 TEST_F(InputPollerTest, DoubleStartIgnored)
 {
     std::vector<detail::InputBinding> bindings;
@@ -900,6 +1083,20 @@ TEST(InputCodeNameTest, NameResolutionIsLocaleIndependentAsciiFold)
     EXPECT_EQ(mixed, plain);
 }
 
+TEST(InputCodeNameTest, HashedLookupResolvesAliasesAndRejectsNearMisses)
+{
+    EXPECT_EQ(DetourModKit::parse_input_name("Backtick"), keyboard_key(0xC0));
+    EXPECT_EQ(DetourModKit::parse_input_name("TILDE"), keyboard_key(0xC0));
+    EXPECT_EQ(DetourModKit::parse_input_name("gamepad_rsright"),
+              DetourModKit::parse_input_name("Gamepad_RSRight"));
+    EXPECT_EQ(DetourModKit::parse_input_name("numpaddecimal"), keyboard_key(0x6E));
+
+    EXPECT_FALSE(DetourModKit::parse_input_name("").has_value());
+    EXPECT_FALSE(DetourModKit::parse_input_name("F25").has_value());
+    EXPECT_FALSE(DetourModKit::parse_input_name("Gamepad_RSRightX").has_value());
+    EXPECT_FALSE(DetourModKit::parse_input_name("Ctr").has_value());
+}
+
 TEST_F(InputTest, SingletonIdentity)
 {
     input::Input &a = input::Input::instance();
@@ -2821,6 +3018,413 @@ TEST(KeyStateCacheTest, OutOfRangeVkReadsAsNotPressedWithoutProbing)
     EXPECT_EQ(probe_calls, 0);
 }
 
+// RawKeyState: the raw input backend's event-fed key table
+
+TEST(RawKeyStateTest, KeyboardRecordsTrackDownAndUpAndIgnoreAutoRepeat)
+{
+    detail::RawKeyState keys;
+    EXPECT_TRUE(keys.apply_keyboard(0x41, 0x1E, 0));
+    EXPECT_TRUE(keys.pressed(0x41));
+    // Auto-repeat repeats the make record without a transition.
+    EXPECT_FALSE(keys.apply_keyboard(0x41, 0x1E, 0));
+    EXPECT_TRUE(keys.apply_keyboard(0x41, 0x1E, detail::RawKeyState::KEY_BREAK));
+    EXPECT_FALSE(keys.pressed(0x41));
+
+    // Fake keys from escape sequences and a zero VK are dropped.
+    EXPECT_FALSE(keys.apply_keyboard(detail::RawKeyState::FAKE_VK, 0x2A, 0));
+    EXPECT_FALSE(keys.apply_keyboard(0, 0x2A, 0));
+    EXPECT_FALSE(keys.pressed(detail::RawKeyState::FAKE_VK));
+}
+
+TEST(RawKeyStateTest, GenericModifierResolvesItsSideAndStaysDownWhileEitherIs)
+{
+    detail::RawKeyState keys;
+    // Raw records carry the generic VK_SHIFT; the scan code picks the side.
+    EXPECT_TRUE(keys.apply_keyboard(0x10, 0x2A, 0));
+    EXPECT_TRUE(keys.pressed(0xA0));
+    EXPECT_FALSE(keys.pressed(0xA1));
+    EXPECT_TRUE(keys.pressed(0x10));
+
+    EXPECT_TRUE(keys.apply_keyboard(0x10, detail::RawKeyState::RIGHT_SHIFT_MAKE_CODE, 0));
+    EXPECT_TRUE(keys.apply_keyboard(0x10, 0x2A, detail::RawKeyState::KEY_BREAK));
+    EXPECT_FALSE(keys.pressed(0xA0));
+    EXPECT_TRUE(keys.pressed(0xA1));
+    EXPECT_TRUE(keys.pressed(0x10));
+
+    EXPECT_TRUE(keys.apply_keyboard(0x10, detail::RawKeyState::RIGHT_SHIFT_MAKE_CODE, detail::RawKeyState::KEY_BREAK));
+    EXPECT_FALSE(keys.pressed(0x10));
+
+    // Ctrl and Alt take their side from the E0 prefix.
+    EXPECT_TRUE(keys.apply_keyboard(0x11, 0x1D, detail::RawKeyState::KEY_E0));
+    EXPECT_TRUE(keys.pressed(0xA3));
+    EXPECT_TRUE(keys.pressed(0x11));
+    EXPECT_TRUE(keys.apply_keyboard(0x12, 0x38, 0));
+    EXPECT_TRUE(keys.pressed(0xA4));
+    EXPECT_TRUE(keys.pressed(0x12));
+}
+
+TEST(RawKeyStateTest, MouseButtonFlagsMapToVirtualKeysAndHonorTheSwap)
+{
+    detail::RawKeyState keys;
+    // RI_MOUSE_LEFT_BUTTON_DOWN, then a motion-only record.
+    EXPECT_TRUE(keys.apply_mouse(0x0001, false));
+    EXPECT_TRUE(keys.pressed(0x01));
+    EXPECT_FALSE(keys.apply_mouse(0x0000, false));
+    // RI_MOUSE_BUTTON_4_DOWN and RI_MOUSE_LEFT_BUTTON_UP in one record.
+    EXPECT_TRUE(keys.apply_mouse(0x0040 | 0x0002, false));
+    EXPECT_TRUE(keys.pressed(0x05));
+    EXPECT_FALSE(keys.pressed(0x01));
+    // A down and up in one record ends released.
+    EXPECT_FALSE(keys.apply_mouse(0x0010 | 0x0020, false));
+    EXPECT_FALSE(keys.pressed(0x04));
+
+    // With swapped buttons the physical left button is VK_RBUTTON, as GetAsyncKeyState reports it.
+    keys.clear();
+    EXPECT_TRUE(keys.apply_mouse(0x0001, true));
+    EXPECT_TRUE(keys.pressed(0x02));
+    EXPECT_FALSE(keys.pressed(0x01));
+}
+
+TEST(RawKeyStateTest, SeededKeysAndOutOfRangeCodes)
+{
+    detail::RawKeyState keys;
+    keys.set(0x20, true);
+    EXPECT_TRUE(keys.pressed(0x20));
+    keys.set(-1, true);
+    keys.set(256, true);
+    EXPECT_FALSE(keys.pressed(-1));
+    EXPECT_FALSE(keys.pressed(256));
+    keys.clear();
+    EXPECT_FALSE(keys.pressed(0x20));
+}
+
+// KeyMask / CompiledCombo: the mask form of keyboard/mouse bindings
+
+TEST(KeyMaskTest, SetTestAndVisitAcrossWords)
+{
+    detail::KeyMask mask;
+    EXPECT_TRUE(mask.empty());
+    mask.set(0x01);
+    mask.set(0x41);
+    mask.set(0xA0);
+    mask.set(0xFF);
+    mask.set(-1);
+    mask.set(256);
+    EXPECT_FALSE(mask.empty());
+    EXPECT_TRUE(mask.test(0x41));
+    EXPECT_FALSE(mask.test(0x42));
+    EXPECT_FALSE(mask.test(256));
+
+    std::vector<int> visited;
+    mask.for_each([&visited](int vk) { visited.push_back(vk); });
+    EXPECT_EQ(visited, (std::vector<int>{0x01, 0x41, 0xA0, 0xFF}));
+}
+
+TEST(KeyMaskTest, CompiledComboAppliesStrictModifierMatching)
+{
+    // "Shift+V" and a bare "V" sharing a table: the bare binding forbids the known Shift modifier.
+    detail::CompiledCombo shift_v;
+    shift_v.required.set(0x10);
+    shift_v.triggers.set(0x56);
+    detail::CompiledCombo bare_v;
+    bare_v.forbidden.set(0x10);
+    bare_v.triggers.set(0x56);
+
+    detail::KeyMask down;
+    down.set(0x56);
+    EXPECT_TRUE(bare_v.matches(down));
+    EXPECT_FALSE(shift_v.matches(down));
+
+    down.set(0x10);
+    EXPECT_FALSE(bare_v.matches(down));
+    EXPECT_TRUE(shift_v.matches(down));
+
+    // Modifiers alone, without a trigger, never match.
+    detail::KeyMask modifiers_only;
+    modifiers_only.set(0x10);
+    EXPECT_FALSE(shift_v.matches(modifiers_only));
+
+    // Any one of several triggers is enough (OR logic).
+    detail::CompiledCombo either;
+    either.triggers.set(0x70);
+    either.triggers.set(0xC0);
+    detail::KeyMask high;
+    high.set(0xC0);
+    EXPECT_TRUE(either.matches(high));
+}
+
+// GamepadProbeSchedule: XInput probing backoff for an empty controller slot
+
+TEST(GamepadProbeScheduleTest, EmptySlotBacksOffAndAConnectedSlotIsReadEveryCycle)
+{
+    using Clock = detail::GamepadProbeSchedule::Clock;
+    const Clock::time_point t0 = Clock::now();
+    detail::GamepadProbeSchedule probe;
+
+    // The first cycle probes at once; an empty result waits the minimum backoff.
+    ASSERT_TRUE(probe.should_probe(t0, 5));
+    probe.record(false, t0);
+    EXPECT_EQ(probe.backoff(), detail::GAMEPAD_PROBE_MIN_BACKOFF);
+    EXPECT_FALSE(probe.should_probe(t0 + std::chrono::milliseconds(500), 5));
+    ASSERT_TRUE(probe.should_probe(t0 + detail::GAMEPAD_PROBE_MIN_BACKOFF, 5));
+
+    // Each further empty probe doubles the wait, up to the cap.
+    auto now = t0 + detail::GAMEPAD_PROBE_MIN_BACKOFF;
+    for (int i = 0; i < 8; ++i)
+    {
+        probe.record(false, now);
+        now += probe.backoff();
+    }
+    EXPECT_EQ(probe.backoff(), detail::GAMEPAD_PROBE_MAX_BACKOFF);
+
+    // Once connected, every cycle reads the slot whatever the device count.
+    probe.record(true, now);
+    EXPECT_TRUE(probe.connected());
+    EXPECT_TRUE(probe.should_probe(now, 5));
+    EXPECT_TRUE(probe.should_probe(now, 9));
+
+    // Unplugged again: the backoff restarts from the minimum.
+    probe.record(false, now);
+    EXPECT_FALSE(probe.connected());
+    EXPECT_EQ(probe.backoff(), detail::GAMEPAD_PROBE_MIN_BACKOFF);
+}
+
+TEST(GamepadProbeScheduleTest, ADeviceCountChangeEndsTheBackoffEarly)
+{
+    using Clock = detail::GamepadProbeSchedule::Clock;
+    const Clock::time_point t0 = Clock::now();
+    detail::GamepadProbeSchedule probe;
+    ASSERT_TRUE(probe.should_probe(t0, 4));
+    probe.record(false, t0);
+
+    const auto soon = t0 + std::chrono::milliseconds(10);
+    EXPECT_FALSE(probe.should_probe(soon, 4));
+    // A controller plugged in adds an input device.
+    EXPECT_TRUE(probe.should_probe(soon, 5));
+    probe.record(false, soon);
+    // The new count is the baseline from here on.
+    EXPECT_FALSE(probe.should_probe(soon + std::chrono::milliseconds(10), 5));
+}
+
+// AdaptiveCadence: idle/fast poll interval selection
+
+TEST(AdaptiveCadenceTest, ActivitySwitchesToFastAndQuietTimeoutDropsBack)
+{
+    using Clock = detail::AdaptiveCadence::Clock;
+    using std::chrono::milliseconds;
+    const Clock::time_point t0 = Clock::now();
+    detail::AdaptiveCadence cadence(milliseconds(4), milliseconds(50), milliseconds(200));
+
+    EXPECT_EQ(cadence.step(false, t0), milliseconds(50));
+    EXPECT_FALSE(cadence.fast());
+
+    EXPECT_EQ(cadence.step(true, t0 + milliseconds(50)), milliseconds(4));
+    EXPECT_TRUE(cadence.switched_to_fast());
+    EXPECT_EQ(cadence.step(true, t0 + milliseconds(54)), milliseconds(4));
+    EXPECT_FALSE(cadence.switched_to_fast());
+
+    // Quiet, but inside the timeout: stays fast.
+    EXPECT_EQ(cadence.step(false, t0 + milliseconds(200)), milliseconds(4));
+    EXPECT_TRUE(cadence.fast());
+    // Past the timeout since the last activity: back to idle.
+    EXPECT_EQ(cadence.step(false, t0 + milliseconds(254)), milliseconds(50));
+    EXPECT_FALSE(cadence.fast());
+
+    EXPECT_EQ(cadence.step(true, t0 + milliseconds(300)), milliseconds(4));
+    EXPECT_TRUE(cadence.switched_to_fast());
+}
+
+// InputEventRing: the poll thread's edge queue
+
+TEST(InputEventRingTest, PopsInOrderAndCountsDropsWhenFull)
+{
+    auto ring = detail::InputEventRing::create(3);
+    ASSERT_NE(ring, nullptr);
+    EXPECT_EQ(ring->capacity(), 4u);
+
+    for (std::uint32_t i = 0; i < 6; ++i)
+    {
+        EXPECT_EQ(ring->push({7, static_cast<std::int64_t>(100 + i), i, input::InputEdge::Press}), i < 4);
+    }
+    EXPECT_EQ(ring->size(), 4u);
+    EXPECT_EQ(ring->dropped(), 2u);
+
+    std::array<input::InputEvent, 3> out{};
+    ASSERT_EQ(ring->pop(out), 3u);
+    EXPECT_EQ(out[0].entry, 0u);
+    EXPECT_EQ(out[2].entry, 2u);
+    EXPECT_EQ(out[2].timestamp, 102);
+
+    // The freed slots take new events behind the one still queued.
+    EXPECT_TRUE(ring->push({7, 200, 9, input::InputEdge::Release}));
+    ASSERT_EQ(ring->pop(out), 2u);
+    EXPECT_EQ(out[0].entry, 3u);
+    EXPECT_EQ(out[1].entry, 9u);
+    EXPECT_EQ(out[1].edge, input::InputEdge::Release);
+    EXPECT_EQ(ring->pop(out), 0u);
+}
+
+TEST(InputEventRingTest, ConsumerThreadSeesEveryEventOnce)
+{
+    auto ring = detail::InputEventRing::create(64);
+    ASSERT_NE(ring, nullptr);
+    constexpr std::uint32_t total = 20000;
+
+    std::thread producer(
+        [&ring]()
+        {
+            for (std::uint32_t i = 0; i < total;)
+            {
+                if (ring->push({1, 0, i, input::InputEdge::Press}))
+                {
+                    ++i;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+    std::uint32_t expected = 0;
+    std::array<input::InputEvent, 16> out{};
+    while (expected < total)
+    {
+        const std::size_t n = ring->pop(out);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            ASSERT_EQ(out[i].entry, expected);
+            ++expected;
+        }
+        if (n == 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_EQ(expected, total);
+}
+
+TEST_F(InputPollerTest, EventQueueCarriesPressAndReleaseEdgesMatchedByToken)
+{
+    std::vector<detail::InputBinding> bindings;
+    detail::InputBinding other_binding;
+    other_binding.name = "queue_other";
+    other_binding.keys = {keyboard_key(0x87)};
+    bindings.push_back(std::move(other_binding));
+    detail::InputBinding wheel;
+    wheel.name = "queue_wheel";
+    wheel.keys = {mouse_wheel(WheelCode::Up)};
+    bindings.push_back(std::move(wheel));
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(5), false);
+    ASSERT_TRUE(poller.set_event_queue(16));
+    const input::BindingToken token = poller.acquire_binding_token("queue_wheel");
+    const input::BindingToken other = poller.acquire_binding_token("queue_other");
+
+    poller.start();
+    detail::seed_wheel_notches_for_test({1, 0, 0, 0});
+
+    // A notch is a one-cycle pulse: a Press edge, then a Release edge on a later cycle.
+    std::vector<input::InputEvent> seen;
+    std::array<input::InputEvent, 8> out{};
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (seen.size() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        const std::size_t n = poller.drain_events(out);
+        seen.insert(seen.end(), out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    poller.shutdown();
+
+    ASSERT_EQ(seen.size(), 2u);
+    EXPECT_EQ(seen[0].edge, input::InputEdge::Press);
+    EXPECT_EQ(seen[1].edge, input::InputEdge::Release);
+    EXPECT_TRUE(token.matches(seen[0]));
+    EXPECT_TRUE(token.matches(seen[1]));
+    EXPECT_FALSE(other.matches(seen[0]));
+    EXPECT_FALSE(input::BindingToken{}.matches(seen[0]));
+    EXPECT_GT(seen[0].timestamp, 0);
+    EXPECT_GT(seen[1].timestamp, seen[0].timestamp);
+    EXPECT_EQ(poller.dropped_events(), 0u);
+}
+
+// LatencyRecorder and the replay harness behind latency instrumentation
+
+TEST(LatencyRecorderTest, BucketsByBitWidthAndClampsTheTail)
+{
+    detail::LatencyRecorder recorder;
+    recorder.record(0);
+    recorder.record(-5);
+    recorder.record(1);
+    recorder.record(3);
+    recorder.record(4);
+    recorder.record(std::int64_t{1} << 40);
+
+    const input::LatencyHistogram histogram = recorder.read();
+    EXPECT_EQ(histogram.samples, 6u);
+    EXPECT_EQ(histogram.total_ticks, (std::uint64_t{1} << 40) + 8);
+    EXPECT_EQ(histogram.buckets[0], 2u);
+    EXPECT_EQ(histogram.buckets[1], 1u);
+    EXPECT_EQ(histogram.buckets[2], 1u);
+    EXPECT_EQ(histogram.buckets[3], 1u);
+    EXPECT_EQ(histogram.buckets[input::INPUT_LATENCY_BUCKETS - 1], 1u);
+}
+
+TEST(ReplayKeyStateTest, PlaysARecordingInOrderThroughTheProbe)
+{
+    detail::ReplayKeyState keys;
+    const std::array<detail::ReplayEvent, 3> recording{{
+        {std::chrono::microseconds(0), 0x41, true},
+        {std::chrono::microseconds(500), 0xA0, true},
+        {std::chrono::microseconds(1000), 0x41, false},
+    }};
+    std::vector<std::size_t> applied;
+    detail::play(recording, keys, std::chrono::steady_clock::now(),
+                 [&](std::size_t index, const detail::ReplayEvent &) { applied.push_back(index); });
+
+    EXPECT_EQ(applied, (std::vector<std::size_t>{0, 1, 2}));
+    EXPECT_FALSE(detail::ReplayKeyState::probe(&keys, 0x41));
+    EXPECT_TRUE(detail::ReplayKeyState::probe(&keys, 0xA0));
+    EXPECT_FALSE(keys.pressed(300));
+}
+
+TEST_F(InputPollerTest, InjectedProbeDrivesBindingsAndLatencyIsRecorded)
+{
+    std::atomic<int> presses{0};
+    std::vector<detail::InputBinding> bindings;
+    detail::InputBinding binding;
+    binding.name = "replayed";
+    binding.keys = {keyboard_key(0x87)};
+    binding.on_press = [&presses]() { presses.fetch_add(1, std::memory_order_relaxed); };
+    bindings.push_back(std::move(binding));
+
+    detail::ReplayKeyState keys;
+    detail::InputPoller poller(std::move(bindings), std::chrono::milliseconds(2), false);
+    poller.set_latency_stats(true);
+    poller.set_key_state_probe(&detail::ReplayKeyState::probe, &keys);
+    poller.start();
+
+    const std::array<detail::ReplayEvent, 2> tap{{
+        {std::chrono::microseconds(0), 0x87, true},
+        {std::chrono::microseconds(40000), 0x87, false},
+    }};
+    detail::play(tap, keys, std::chrono::steady_clock::now(), [](std::size_t, const detail::ReplayEvent &) {});
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (presses.load(std::memory_order_relaxed) == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    poller.shutdown();
+
+    EXPECT_EQ(presses.load(), 1);
+    const input::InputLatencyStats stats = poller.latency_stats();
+    EXPECT_GT(stats.ticks_per_second, 0);
+    EXPECT_GT(stats.cycle_cost.samples, 0u);
+    EXPECT_EQ(stats.edge_to_dispatch.samples, 1u);
+    // The polling backend has no event time to measure from.
+    EXPECT_EQ(stats.event_to_edge.samples, 0u);
+}
+
 // The poll loop re-reserves its deferred-callback staging vector to the live binding count each cycle and stages it
 // under a catch, so growing the binding set far past the startup reserve while the poll thread is running can neither
 // reallocate-then-throw out of the jthread body nor leave the thread dead. Drive a large live growth and assert the
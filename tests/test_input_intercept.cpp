@@ -19,6 +19,7 @@ using namespace DetourModKit;
 using DetourModKit::detail::add_wheel_notches;
 using DetourModKit::detail::evaluate_consume_rules;
 using DetourModKit::detail::evaluate_published_consume_rules;
+using DetourModKit::detail::gamepad_detour_mask;
 using DetourModKit::detail::GamepadConsumeRule;
 using DetourModKit::detail::GamepadSuppressState;
 using DetourModKit::detail::install_wndproc;
@@ -29,6 +30,7 @@ using DetourModKit::detail::MAX_WHEEL_PENDING;
 using DetourModKit::detail::publish_gamepad_consume_rules;
 using DetourModKit::detail::publish_gamepad_suppress;
 using DetourModKit::detail::publish_wheel_consume;
+using DetourModKit::detail::set_gamepad_rule_suppress_enabled;
 using DetourModKit::detail::step_gamepad_suppress;
 using DetourModKit::detail::step_wheel_pulse;
 using DetourModKit::detail::take_wheel_counts;
@@ -468,6 +470,58 @@ TEST_F(ConsumeRulePublishTest, ClearPublishesEmpty)
     EXPECT_EQ(evaluate_published_consume_rules(up), 0u);
 }
 
+// gamepad_detour_mask: the detour's one-load gate
+
+class DetourGateTest : public ::testing::Test
+{
+protected:
+    // The gate, rule list and reactive mask are process-global; leave all three disarmed. No hook is installed in a
+    // unit-test process, so the bound slot is 0.
+    void SetUp() override { reset(); }
+    void TearDown() override { reset(); }
+
+    static void reset()
+    {
+        publish_gamepad_suppress(0);
+        set_gamepad_rule_suppress_enabled(false);
+        publish_gamepad_consume_rules(nullptr, 0);
+    }
+};
+
+TEST_F(DetourGateTest, ReactiveMaskAppliesOnlyToTheBoundSlot)
+{
+    const uint16_t up = static_cast<uint16_t>(GamepadCode::DpadUp);
+    EXPECT_EQ(gamepad_detour_mask(up, 0), 0u);
+
+    publish_gamepad_suppress(up);
+    EXPECT_EQ(gamepad_detour_mask(up, 0), up);
+    EXPECT_EQ(gamepad_detour_mask(up, 1), 0u);
+
+    publish_gamepad_suppress(0);
+    EXPECT_EQ(gamepad_detour_mask(up, 0), 0u);
+}
+
+TEST_F(DetourGateTest, RulesApplyOnlyWhenPublishedAndEnabled)
+{
+    const uint16_t lb = static_cast<uint16_t>(GamepadCode::LeftBumper);
+    const uint16_t up = static_cast<uint16_t>(GamepadCode::DpadUp);
+    const auto chord = static_cast<uint16_t>(lb | up);
+    const GamepadConsumeRule rule{lb, 0, up};
+
+    // The rules are bounded by the deadline publish_gamepad_suppress refreshes, as the poll thread does every cycle.
+    publish_gamepad_suppress(0);
+    publish_gamepad_consume_rules(&rule, 1);
+    EXPECT_EQ(gamepad_detour_mask(chord, 0), 0u); // published, not enabled
+
+    set_gamepad_rule_suppress_enabled(true);
+    EXPECT_EQ(gamepad_detour_mask(chord, 0), up);
+    EXPECT_EQ(gamepad_detour_mask(up, 0), 0u); // modifier not held
+    EXPECT_EQ(gamepad_detour_mask(chord, 1), 0u);
+
+    publish_gamepad_consume_rules(nullptr, 0);
+    EXPECT_EQ(gamepad_detour_mask(chord, 0), 0u); // enabled, nothing published
+}
+
 // build_gamepad_consume_rules, via the InputPoller build+publish path
 
 class ConsumeRuleBuildTest : public ::testing::Test
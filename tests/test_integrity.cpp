@@ -0,0 +1,235 @@
+#include <gtest/gtest.h>
+
+#include <windows.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "DetourModKit/integrity.hpp"
+#include "DetourModKit/scan.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    // Page-aligned, readable and writable stand-in for a code range, so a test can "repatch" it.
+    struct Pages
+    {
+        explicit Pages(std::size_t count)
+            : bytes(static_cast<std::byte *>(
+                  VirtualAlloc(nullptr, count * integrity::PAGE_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE))),
+              size(count * integrity::PAGE_BYTES)
+        {
+        }
+        ~Pages()
+        {
+            VirtualFree(bytes, 0, MEM_RELEASE);
+        }
+        Pages(const Pages &) = delete;
+        Pages &operator=(const Pages &) = delete;
+
+        [[nodiscard]] Region region(std::size_t offset, std::size_t length) const noexcept
+        {
+            return Region{Address{bytes + offset}, length};
+        }
+
+        std::byte *bytes;
+        std::size_t size;
+    };
+
+    struct Recorder
+    {
+        std::vector<std::string> labels;
+        std::vector<integrity::CodeChangedEvent> events;
+    };
+
+    [[nodiscard]] Subscription record(integrity::CodeMonitor &monitor, Recorder &recorder)
+    {
+        return monitor.changes().subscribe(
+            [&recorder](const integrity::CodeChangedEvent &event)
+            {
+                recorder.labels.emplace_back(event.label);
+                recorder.events.push_back(event);
+            });
+    }
+} // namespace
+
+TEST(IntegrityPageHash, ScalarAndAvx2PathsAgree)
+{
+    std::vector<std::byte> bytes(integrity::PAGE_BYTES + 13);
+    for (std::size_t i = 0; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<std::byte>(i * 131 + 7);
+    }
+    const std::uint64_t widest = integrity::page_hash(bytes);
+
+    scan::SimdCalibration capped;
+    capped.level = scan::SimdLevel::Sse2;
+    scan::apply_simd_calibration(capped);
+    const std::uint64_t scalar = integrity::page_hash(bytes);
+    scan::reset_simd_calibration();
+
+    EXPECT_EQ(widest, scalar);
+}
+
+TEST(IntegrityPageHash, SeesEveryByteAndTheLength)
+{
+    std::array<std::byte, 256> bytes{};
+    const std::uint64_t zeros = integrity::page_hash(bytes);
+    EXPECT_NE(zeros, integrity::page_hash(std::span(bytes).first(255)));
+
+    // The same word in the same lane of another block hashes differently.
+    std::array<std::byte, 256> swapped{};
+    swapped[0] = std::byte{1};
+    const std::uint64_t first = integrity::page_hash(swapped);
+    swapped[0] = std::byte{0};
+    swapped[32] = std::byte{1};
+    EXPECT_NE(first, integrity::page_hash(swapped));
+
+    for (std::size_t i = 0; i < bytes.size(); i += 37)
+    {
+        bytes[i] = std::byte{0x90};
+        EXPECT_NE(integrity::page_hash(bytes), zeros) << "byte " << i;
+        bytes[i] = std::byte{0};
+    }
+}
+
+TEST(IntegrityCodeMonitor, ReportsAChangedPageOnceWithTheWatchedPart)
+{
+    Pages pages(2);
+    ASSERT_NE(pages.bytes, nullptr);
+    auto monitor = integrity::CodeMonitor::make();
+    ASSERT_TRUE(monitor.has_value());
+
+    // Straddles the page boundary, so it is watched as two pages.
+    const Region watched = pages.region(integrity::PAGE_BYTES - 16, 32);
+    ASSERT_EQ(monitor->watch("player_update", watched).value(), 0u);
+    EXPECT_EQ(monitor->page_count(), 2u);
+
+    Recorder recorder;
+    const Subscription subscription = record(*monitor, recorder);
+    EXPECT_EQ(monitor->verify(monitor->page_count()), 0u);
+
+    pages.bytes[integrity::PAGE_BYTES + 4] = std::byte{0xE9};
+    EXPECT_EQ(monitor->verify(monitor->page_count()), 1u);
+    ASSERT_EQ(recorder.events.size(), 1u);
+    EXPECT_EQ(recorder.labels[0], "player_update");
+    EXPECT_EQ(recorder.events[0].range.base, Address{pages.bytes + integrity::PAGE_BYTES});
+    EXPECT_EQ(recorder.events[0].range.size, 16u);
+    EXPECT_TRUE(recorder.events[0].readable);
+    EXPECT_NE(recorder.events[0].baseline, recorder.events[0].observed);
+
+    // The observed hash became the baseline, so the same bytes do not report again.
+    EXPECT_EQ(monitor->verify(monitor->page_count()), 0u);
+
+    // A change outside the watched part of a page is not a change.
+    pages.bytes[0] = std::byte{0xCC};
+    EXPECT_EQ(monitor->verify(monitor->page_count()), 0u);
+}
+
+TEST(IntegrityCodeMonitor, VerifiesABoundedNumberOfPagesPerCall)
+{
+    Pages pages(3);
+    ASSERT_NE(pages.bytes, nullptr);
+    auto monitor = integrity::CodeMonitor::make();
+    ASSERT_TRUE(monitor.has_value());
+    ASSERT_TRUE(monitor->watch("all", pages.region(0, pages.size)).has_value());
+    ASSERT_EQ(monitor->page_count(), 3u);
+
+    for (std::size_t page = 0; page < 3; ++page)
+    {
+        pages.bytes[page * integrity::PAGE_BYTES] = std::byte{0xC3};
+    }
+    EXPECT_EQ(monitor->verify(1), 1u);
+    EXPECT_EQ(monitor->verify(1), 1u);
+    EXPECT_EQ(monitor->verify(1), 1u);
+    EXPECT_EQ(monitor->verify(3), 0u);
+
+    // A rebaseline adopts the current bytes without raising anything.
+    pages.bytes[5] = std::byte{0x90};
+    monitor->rebaseline();
+    EXPECT_EQ(monitor->verify(3), 0u);
+}
+
+TEST(IntegrityCodeMonitor, AnUnreadablePageIsAChange)
+{
+    Pages pages(1);
+    ASSERT_NE(pages.bytes, nullptr);
+    auto monitor = integrity::CodeMonitor::make();
+    ASSERT_TRUE(monitor.has_value());
+    ASSERT_TRUE(monitor->watch("hooked", pages.region(64, 16)).has_value());
+
+    Recorder recorder;
+    const Subscription subscription = record(*monitor, recorder);
+    DWORD previous = 0;
+    ASSERT_TRUE(VirtualProtect(pages.bytes, pages.size, PAGE_NOACCESS, &previous));
+    EXPECT_EQ(monitor->verify(1), 1u);
+    ASSERT_TRUE(VirtualProtect(pages.bytes, pages.size, PAGE_READWRITE, &previous));
+
+    ASSERT_EQ(recorder.events.size(), 1u);
+    EXPECT_FALSE(recorder.events[0].readable);
+    EXPECT_EQ(recorder.events[0].observed, 0u);
+
+    // Reading again is a change back.
+    EXPECT_EQ(monitor->verify(1), 1u);
+    EXPECT_TRUE(recorder.events[1].readable);
+}
+
+TEST(IntegrityCodeMonitor, WatchRejectsEmptyAndUnreadableRanges)
+{
+    auto monitor = integrity::CodeMonitor::make();
+    ASSERT_TRUE(monitor.has_value());
+
+    const auto empty = monitor->watch("empty", Region{});
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, ErrorCode::InvalidArg);
+
+    // Reserved but never committed: an address that faults on read.
+    void *reserved = VirtualAlloc(nullptr, integrity::PAGE_BYTES, MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(reserved, nullptr);
+    const auto unmapped = monitor->watch("unmapped", Region{Address{reserved}, 16});
+    VirtualFree(reserved, 0, MEM_RELEASE);
+    ASSERT_FALSE(unmapped.has_value());
+    EXPECT_EQ(unmapped.error().code, ErrorCode::ReadFaulted);
+    EXPECT_EQ(monitor->page_count(), 0u);
+}
+
+TEST(IntegrityCodeMonitor, BackgroundWorkerRaisesTheEvent)
+{
+    Pages pages(1);
+    ASSERT_NE(pages.bytes, nullptr);
+    auto monitor = integrity::CodeMonitor::make();
+    ASSERT_TRUE(monitor.has_value());
+    ASSERT_TRUE(monitor->watch("detour", pages.region(0, 64)).has_value());
+
+    EXPECT_FALSE(monitor->start(integrity::MonitorOptions{0, std::chrono::milliseconds{1}}).has_value());
+
+    auto changed = std::make_shared<std::promise<Region>>();
+    std::future<Region> reported = changed->get_future();
+    auto fired = std::make_shared<bool>(false);
+    const Subscription subscription = monitor->changes().subscribe(
+        [changed, fired](const integrity::CodeChangedEvent &event)
+        {
+            if (!*fired)
+            {
+                *fired = true;
+                changed->set_value(event.range);
+            }
+        });
+
+    ASSERT_TRUE(monitor->start(integrity::MonitorOptions{1, std::chrono::milliseconds{1}}).has_value());
+    EXPECT_TRUE(monitor->running());
+    pages.bytes[8] = std::byte{0xFF};
+
+    ASSERT_EQ(reported.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    EXPECT_EQ(reported.get().base, Address{pages.bytes});
+    monitor->stop();
+    EXPECT_FALSE(monitor->running());
+}
@@ -0,0 +1,191 @@
+#include <gtest/gtest.h>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DetourModKit/log_kv.hpp"
+
+#include "internal/kv_log_writer.hpp"
+
+using namespace DetourModKit;
+// White-box access: KvLogWriter is the async writer's private encoder; these tests feed it records packed the way
+// Logger::log_kv() packs them and check what the public decoder makes of the output.
+using namespace DetourModKit::detail;
+
+namespace
+{
+    /// Packs a record like Logger::log_kv(); the literals stand in for a call site's event id, file and names.
+    template <typename... Fields>
+    std::vector<std::byte> pack(const char *event_id, std::uint_least32_t line, const KvField<Fields> &...fields)
+    {
+        const KvLogHeader header{{&render_kv_log_record, event_id, std::strlen(event_id), "src/hooks/player.cpp", line},
+                                 static_cast<std::uint32_t>(sizeof...(Fields))};
+        std::vector<std::byte> record(sizeof(header) + sizeof...(Fields) * sizeof(KvLogField));
+        std::memcpy(record.data(), &header, sizeof(header));
+        std::size_t offset = sizeof(header);
+        for (const KvLogField &packed : {make_kv_log_field(fields)...})
+        {
+            std::memcpy(record.data() + offset, &packed, sizeof(packed));
+            offset += sizeof(packed);
+        }
+        return record;
+    }
+
+    std::vector<std::byte> bytes_of(const std::ostringstream &out)
+    {
+        const std::string text = out.str();
+        const auto *first = reinterpret_cast<const std::byte *>(text.data());
+        return std::vector<std::byte>(first, first + text.size());
+    }
+
+    constexpr const char *HEALTH_EVENT = "player.health";
+} // namespace
+
+TEST(LogKvTest, RecordsRoundTripAndShareOneSchema)
+{
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    const auto when = std::chrono::system_clock::now();
+    auto *const base = reinterpret_cast<void *>(std::uintptr_t{0x7FF612340000});
+
+    ASSERT_TRUE(writer.write(LogLevel::Info, when,
+                             pack(HEALTH_EVENT, 42, kv("hp", -5), kv("max", 100u), kv("ratio", 0.25f),
+                                  kv("alive", true), kv("base", base))));
+    ASSERT_TRUE(writer.write(LogLevel::Warning, when + std::chrono::milliseconds(3),
+                             pack(HEALTH_EVENT, 42, kv("hp", 7), kv("max", 100u), kv("ratio", 1.5f),
+                                  kv("alive", false), kv("base", base))));
+    EXPECT_EQ(writer.schema_count(), 1u);
+
+    const auto decoded = log_kv::decode(bytes_of(out));
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_FALSE(decoded->truncated);
+    ASSERT_EQ(decoded->schemas.size(), 1u);
+    const log_kv::Schema &schema = decoded->schemas[0];
+    EXPECT_EQ(schema.event_id, "player.health");
+    EXPECT_EQ(schema.file, "player.cpp");
+    EXPECT_EQ(schema.line, 42u);
+    ASSERT_EQ(schema.fields.size(), 5u);
+    EXPECT_EQ(schema.fields[0].type, KvType::Int);
+    EXPECT_EQ(schema.fields[1].type, KvType::UInt);
+    EXPECT_EQ(schema.fields[2].type, KvType::Float32);
+    EXPECT_EQ(schema.fields[3].type, KvType::Bool);
+    EXPECT_EQ(schema.fields[4].type, KvType::Pointer);
+
+    ASSERT_EQ(decoded->events.size(), 2u);
+    EXPECT_EQ(decoded->events[1].time_us - decoded->events[0].time_us, 3000);
+    EXPECT_EQ(decoded->events[0].time_us,
+              std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count());
+    EXPECT_EQ(decoded->events[1].level, LogLevel::Warning);
+
+    const std::string text = log_kv::format_text(*decoded, decoded->events[0]);
+    EXPECT_NE(text.find("[INFO   ] :: [player.cpp:42] player.health hp=-5 max=100 ratio=0.25 alive=true "
+                        "base=0x7FF612340000"),
+              std::string::npos)
+        << text;
+    EXPECT_NE(log_kv::format_text(*decoded, decoded->events[1]).find("hp=7 max=100 ratio=1.5 alive=false"),
+              std::string::npos);
+}
+
+TEST(LogKvTest, JsonCarriesEveryFieldAndQuotesPointers)
+{
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    auto *const base = reinterpret_cast<void *>(std::uintptr_t{0xABC});
+    ASSERT_TRUE(writer.write(LogLevel::Error, std::chrono::system_clock::time_point{std::chrono::microseconds{1234}},
+                             pack("hook.failed", 7, kv("target", base), kv("code", 5))));
+
+    const auto decoded = log_kv::decode(bytes_of(out));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->events.size(), 1u);
+    EXPECT_EQ(log_kv::format_json(*decoded, decoded->events[0]),
+              "{\"time_us\":1234,\"level\":\"ERROR\",\"event\":\"hook.failed\",\"file\":\"player.cpp\",\"line\":7,"
+              "\"fields\":{\"target\":\"0xABC\",\"code\":5}}");
+}
+
+TEST(LogKvTest, DistinctCallSitesGetDistinctSchemas)
+{
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    const auto when = std::chrono::system_clock::now();
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, pack(HEALTH_EVENT, 1, kv("hp", 1))));
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, pack(HEALTH_EVENT, 2, kv("hp", 2))));
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, pack(HEALTH_EVENT, 1, kv("hp", 3))));
+    EXPECT_EQ(writer.schema_count(), 2u);
+
+    const auto decoded = log_kv::decode(bytes_of(out));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->events.size(), 3u);
+    EXPECT_EQ(decoded->events[0].schema, 0u);
+    EXPECT_EQ(decoded->events[1].schema, 1u);
+    EXPECT_EQ(decoded->events[2].schema, 0u);
+    EXPECT_EQ(decoded->events[2].values[0], 3u);
+}
+
+TEST(LogKvTest, FileCutMidRecordKeepsEverythingBeforeIt)
+{
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    const auto when = std::chrono::system_clock::now();
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, pack(HEALTH_EVENT, 1, kv("hp", 1))));
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, pack(HEALTH_EVENT, 1, kv("hp", 2))));
+
+    std::vector<std::byte> image = bytes_of(out);
+    image.pop_back();
+    const auto decoded = log_kv::decode(image);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->truncated);
+    ASSERT_EQ(decoded->events.size(), 1u);
+    EXPECT_EQ(decoded->events[0].values[0], 1u);
+}
+
+TEST(LogKvTest, DecodeRejectsAFileWithoutTheHeader)
+{
+    const std::vector<std::byte> too_short(4);
+    EXPECT_EQ(log_kv::decode(too_short).error().code, ErrorCode::MissingHeader);
+
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    std::vector<std::byte> image = bytes_of(out);
+    image[0] = std::byte{'X'};
+    EXPECT_EQ(log_kv::decode(image).error().code, ErrorCode::MissingHeader);
+    EXPECT_EQ(log_kv::read_file("dmk_no_such_structured_log.kv").error().code, ErrorCode::FileOpenFailed);
+}
+
+TEST(LogKvTest, RepeatedRegisterDumpIsAFractionOfItsTextLine)
+{
+    std::ostringstream out;
+    KvLogWriter writer(out);
+    const auto when = std::chrono::system_clock::now();
+    const auto dump = [](std::uintptr_t rax, std::uintptr_t rsp, std::uintptr_t rip)
+    {
+        const auto reg = [](std::uintptr_t value) { return reinterpret_cast<void *>(value); };
+        return pack("regs", 88, kv("rax", reg(rax)), kv("rbx", reg(0x000001C2D3E4F506)),
+                    kv("rcx", reg(0x00007FF6A1B20000)), kv("rdx", reg(0x0000000000000010)),
+                    kv("rsi", reg(0x000001C2D3E4F000)), kv("rdi", reg(0x000000E5F6A7B8C0)), kv("rsp", reg(rsp)),
+                    kv("rip", reg(rip)));
+    };
+    ASSERT_TRUE(writer.write(LogLevel::Info, when, dump(0x00007FF6A1B2C3D4, 0x000000E5F6A7B7F8, 0x00007FF6A1B2C3F0)));
+    const std::size_t first_size = out.str().size();
+    // The same hook a moment later: a few registers moved a little, the rest held.
+    const auto next = dump(0x00007FF6A1B2C414, 0x000000E5F6A7B7D0, 0x00007FF6A1B2C40C);
+    ASSERT_TRUE(writer.write(LogLevel::Info, when + std::chrono::microseconds(40), next));
+    const std::size_t event_size = out.str().size() - first_size;
+
+    std::string line;
+    render_kv_log_record(line, next.data());
+    // The text log adds a "[YYYY-MM-DD HH:MM:SS.mmm] [INFO   ] :: " stamp and a newline to every line.
+    const std::size_t text_size = line.size() + 39;
+    EXPECT_LE(event_size * 5, text_size) << event_size << " bytes vs " << text_size;
+
+    const auto decoded = log_kv::decode(bytes_of(out));
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->events.size(), 2u);
+    EXPECT_EQ(decoded->events[1].values[0], 0x00007FF6A1B2C414u);
+    EXPECT_EQ(decoded->events[1].values[6], 0x000000E5F6A7B7D0u);
+    EXPECT_EQ(decoded->events[1].values[7], 0x00007FF6A1B2C40Cu);
+}
@@ -0,0 +1,216 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <process.h>
+#include <string>
+#include <vector>
+
+#include "DetourModKit/log_ring.hpp"
+
+#include "internal/async_logger.hpp"
+#include "internal/mapped_log_ring.hpp"
+#include "internal/win_file_stream.hpp"
+
+using namespace DetourModKit;
+// White-box access: MappedLogRing is the async logger's private writer of the ring; these tests drive it directly and
+// check what the public decoder makes of the file.
+using namespace DetourModKit::detail;
+
+class LogRingTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        static int s_test_counter = 0;
+        const std::string stem = "test_log_ring_" + std::to_string(_getpid()) + "_" + std::to_string(s_test_counter++);
+        m_ring_file = std::filesystem::temp_directory_path() / (stem + ".ring");
+        m_log_file = std::filesystem::temp_directory_path() / (stem + ".log");
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(m_ring_file, ec);
+        std::filesystem::remove(m_ring_file.string() + ".prev", ec);
+        std::filesystem::remove(m_log_file, ec);
+    }
+
+    std::vector<std::byte> read_image() const
+    {
+        std::ifstream in(m_ring_file, std::ios::binary);
+        const std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        const auto *first = reinterpret_cast<const std::byte *>(bytes.data());
+        return std::vector<std::byte>(first, first + bytes.size());
+    }
+
+    std::filesystem::path m_ring_file;
+    std::filesystem::path m_log_file;
+};
+
+TEST_F(LogRingTest, AppendedLinesDecodeInOrderWithLevelAndTime)
+{
+    const auto when = std::chrono::system_clock::now();
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        EXPECT_EQ(ring->slot_count(), (MIN_CRASH_RING_SIZE - log_ring::RING_HEADER_SIZE) / log_ring::RING_SLOT_SIZE);
+        ring->append(LogLevel::Info, when, "first");
+        ring->append(LogLevel::Error, when, "second");
+    }
+
+    const auto decoded = log_ring::read_file(m_ring_file.string());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->total_sequence, 2u);
+    EXPECT_EQ(decoded->torn_slots, 0u);
+    ASSERT_EQ(decoded->records.size(), 2u);
+    EXPECT_EQ(decoded->records[0].text, "first");
+    EXPECT_EQ(decoded->records[0].level, LogLevel::Info);
+    EXPECT_EQ(decoded->records[1].text, "second");
+    EXPECT_EQ(decoded->records[1].level, LogLevel::Error);
+    EXPECT_EQ(decoded->records[1].time_us,
+              std::chrono::duration_cast<std::chrono::microseconds>(when.time_since_epoch()).count());
+
+    const std::string line = log_ring::format_line(decoded->records[1], "%Y");
+    EXPECT_NE(line.find("] [ERROR  ] :: second"), std::string::npos) << line;
+}
+
+TEST_F(LogRingTest, LongLineIsCutAndFlagged)
+{
+    const std::string long_line(log_ring::RING_SLOT_TEXT_SIZE + 100, 'x');
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        ring->append(LogLevel::Warning, std::chrono::system_clock::now(), long_line);
+    }
+
+    const auto decoded = log_ring::read_file(m_ring_file.string());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->records.size(), 1u);
+    EXPECT_TRUE(decoded->records[0].truncated);
+    EXPECT_EQ(decoded->records[0].text, long_line.substr(0, log_ring::RING_SLOT_TEXT_SIZE));
+    EXPECT_TRUE(log_ring::format_line(decoded->records[0]).ends_with(" [truncated]"));
+}
+
+TEST_F(LogRingTest, WrappedRingKeepsTheNewestSlotCountLines)
+{
+    std::uint64_t slots = 0;
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        slots = ring->slot_count();
+        for (std::uint64_t i = 0; i < slots + 10; ++i)
+        {
+            ring->append(LogLevel::Info, std::chrono::system_clock::now(), "line " + std::to_string(i));
+        }
+    }
+
+    const auto decoded = log_ring::read_file(m_ring_file.string());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->total_sequence, slots + 10);
+    ASSERT_EQ(decoded->records.size(), slots);
+    EXPECT_EQ(decoded->records.front().text, "line 10");
+    EXPECT_EQ(decoded->records.back().text, "line " + std::to_string(slots + 9));
+}
+
+TEST_F(LogRingTest, CorruptSlotIsCountedTornAndSkipped)
+{
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        ring->append(LogLevel::Info, std::chrono::system_clock::now(), "kept");
+        ring->append(LogLevel::Info, std::chrono::system_clock::now(), "torn");
+    }
+
+    std::vector<std::byte> image = read_image();
+    // Flip a text byte of the second slot, as a producer dying mid-copy would leave it.
+    image[log_ring::RING_HEADER_SIZE + log_ring::RING_SLOT_SIZE + log_ring::RING_SLOT_HEADER_SIZE] ^= std::byte{0x20};
+
+    const auto decoded = log_ring::decode(image);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->torn_slots, 1u);
+    ASSERT_EQ(decoded->records.size(), 1u);
+    EXPECT_EQ(decoded->records[0].text, "kept");
+}
+
+TEST_F(LogRingTest, DecodeRejectsWhatIsNotARing)
+{
+    const std::vector<std::byte> too_short(16);
+    EXPECT_EQ(log_ring::decode(too_short).error().code, ErrorCode::MissingHeader);
+
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+    }
+    std::vector<std::byte> image = read_image();
+    image[log_ring::HEADER_MAGIC_OFFSET] = std::byte{0};
+    EXPECT_EQ(log_ring::decode(image).error().code, ErrorCode::MissingHeader);
+
+    EXPECT_EQ(log_ring::read_file((m_ring_file.string() + ".missing")).error().code, ErrorCode::FileOpenFailed);
+}
+
+TEST_F(LogRingTest, ReopeningKeepsThePreviousRingAsPrev)
+{
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        ring->append(LogLevel::Error, std::chrono::system_clock::now(), "from the crashed session");
+    }
+    {
+        auto ring = MappedLogRing::open(m_ring_file.string(), MIN_CRASH_RING_SIZE);
+        ASSERT_NE(ring, nullptr);
+        ring->append(LogLevel::Info, std::chrono::system_clock::now(), "fresh");
+    }
+
+    const auto previous = log_ring::read_file(m_ring_file.string() + ".prev");
+    ASSERT_TRUE(previous.has_value());
+    ASSERT_EQ(previous->records.size(), 1u);
+    EXPECT_EQ(previous->records[0].text, "from the crashed session");
+
+    const auto current = log_ring::read_file(m_ring_file.string());
+    ASSERT_TRUE(current.has_value());
+    ASSERT_EQ(current->records.size(), 1u);
+    EXPECT_EQ(current->records[0].text, "fresh");
+}
+
+TEST_F(LogRingTest, AsyncLoggerMirrorsLinesBeforeTheWriterRuns)
+{
+    AsyncLoggerConfig config;
+    config.crash_ring_path = m_ring_file.string();
+    config.crash_ring_size = MIN_CRASH_RING_SIZE;
+    config.flush_interval = std::chrono::milliseconds{1000};
+
+    auto file_stream = std::make_shared<WinFileStream>(m_log_file.string());
+    auto log_mutex = std::make_shared<std::mutex>();
+    auto logger = std::make_unique<AsyncLogger>(config, file_stream, log_mutex);
+
+    ASSERT_TRUE(logger->enqueue(LogLevel::Warning, "queued, not yet written"));
+
+    // No flush: the producer's copy is already in the mapped file, readable by another handle.
+    const auto decoded = log_ring::read_file(m_ring_file.string());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->records.size(), 1u);
+    EXPECT_EQ(decoded->records[0].text, "queued, not yet written");
+    EXPECT_EQ(decoded->records[0].level, LogLevel::Warning);
+
+    logger->shutdown();
+    file_stream->close();
+}
+
+TEST(LogRingConfigTest, Validate_CrashRingSizeBoundsApplyOnlyWithAPath)
+{
+    AsyncLoggerConfig config;
+    config.crash_ring_size = 0;
+    EXPECT_TRUE(config.validate());
+
+    config.crash_ring_path = "crash.ring";
+    EXPECT_FALSE(config.validate());
+    config.crash_ring_size = MIN_CRASH_RING_SIZE;
+    EXPECT_TRUE(config.validate());
+    config.crash_ring_size = MAX_CRASH_RING_SIZE + 1;
+    EXPECT_FALSE(config.validate());
+}
@@ -4,12 +4,20 @@
 #include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
+#include <string_view>
 #include <thread>
 #include <chrono>
 #include <type_traits>
 #include <windows.h>
+#include <array>
 #include <atomic>
+#include <system_error>
+#include <vector>
+#include <iterator>
+#include <cstdint>
 
+#include "DetourModKit/log_kv.hpp"
 #include "DetourModKit/logger.hpp"
 #include "DetourModKit/diagnostics.hpp"
 
@@ -126,6 +134,31 @@ TEST_F(LoggerTest, SetAndGetLogLevel)
     EXPECT_EQ(logger.get_log_level(), LogLevel::Info);
 }
 
+// The compile-time floor never removes warnings or errors, and every level it keeps is still filtered at run time.
+static_assert(log_level_compiled_in(LogLevel::Warning) && log_level_compiled_in(LogLevel::Error));
+static_assert(log_level_compiled_in(LOG_COMPILE_MIN_LEVEL));
+
+TEST_F(LoggerTest, IsEnabled_CombinesCompileFloorWithRuntimeLevel)
+{
+    Logger &logger = log();
+    const std::array<LogLevel, 5> levels{LogLevel::Trace, LogLevel::Debug, LogLevel::Info, LogLevel::Warning,
+                                         LogLevel::Error};
+
+    logger.set_log_level(LogLevel::Trace);
+    for (const LogLevel level : levels)
+    {
+        EXPECT_EQ(logger.is_enabled(level), log_level_compiled_in(level)) << to_string(level);
+    }
+
+    // Above the floor the runtime level still decides.
+    logger.set_log_level(LogLevel::Warning);
+    EXPECT_FALSE(logger.is_enabled(LogLevel::Info));
+    EXPECT_TRUE(logger.is_enabled(LogLevel::Warning));
+    EXPECT_TRUE(logger.is_enabled(LogLevel::Error));
+
+    logger.set_log_level(LogLevel::Info);
+}
+
 TEST_F(LoggerTest, BasicLogging)
 {
     Logger &logger = log();
@@ -753,6 +786,47 @@ TEST_F(LoggerTest, AsyncMode_CustomConfig)
     EXPECT_FALSE(logger.is_async_mode_enabled());
 }
 
+TEST_F(LoggerTest, AdaptiveMode_PromotesOnWriteLatency)
+{
+    Logger &logger = log();
+
+    AdaptiveLoggingConfig config;
+    config.lock_wait = std::chrono::seconds{10};
+    config.write_latency = std::chrono::microseconds{0};
+
+    logger.enable_adaptive_mode(config);
+    EXPECT_TRUE(logger.is_adaptive_mode_armed());
+    EXPECT_FALSE(logger.is_async_mode_enabled());
+
+    logger.info("Adaptive line before promotion");
+    EXPECT_TRUE(logger.is_async_mode_enabled());
+    EXPECT_FALSE(logger.is_adaptive_mode_armed());
+
+    logger.info("Adaptive line after promotion");
+    logger.disable_async_mode();
+    EXPECT_FALSE(logger.is_async_mode_enabled());
+}
+
+TEST_F(LoggerTest, AdaptiveMode_DisarmedByDisableAndRefusedWhileAsync)
+{
+    Logger &logger = log();
+
+    logger.enable_adaptive_mode();
+    EXPECT_TRUE(logger.is_adaptive_mode_armed());
+    logger.disable_async_mode();
+    EXPECT_FALSE(logger.is_adaptive_mode_armed());
+
+    logger.enable_async_mode();
+    logger.enable_adaptive_mode();
+    EXPECT_FALSE(logger.is_adaptive_mode_armed());
+    logger.disable_async_mode();
+
+    AdaptiveLoggingConfig invalid;
+    invalid.write_latency = std::chrono::microseconds{-1};
+    logger.enable_adaptive_mode(invalid);
+    EXPECT_FALSE(logger.is_adaptive_mode_armed());
+}
+
 TEST_F(LoggerTest, Flush_SyncMode)
 {
     Logger &logger = log();
@@ -800,6 +874,67 @@ TEST_F(LoggerTest, LogLevelFiltering_OutputVerification)
     EXPECT_EQ(content.find("FILTERED_DEBUG_MSG_9x2k"), std::string::npos);
 }
 
+TEST_F(LoggerTest, CategoryLevels_FollowGlobalUntilPinned)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Warning);
+    EXPECT_EQ(logger.get_log_level(LogCategory::Scan), LogLevel::Warning);
+    EXPECT_FALSE(logger.is_enabled(log_category::scan, LogLevel::Info));
+
+    // A pinned category keeps its level across global changes; the others still follow.
+    logger.set_log_level(LogCategory::Scan, LogLevel::Info);
+    logger.set_log_level(LogLevel::Error);
+    EXPECT_TRUE(logger.is_enabled(log_category::scan, LogLevel::Info));
+    EXPECT_FALSE(logger.is_enabled(log_category::hook, LogLevel::Warning));
+    EXPECT_EQ(logger.get_log_level(LogCategory::Hook), LogLevel::Error);
+
+    // Unpinning takes the current global level at once.
+    logger.reset_log_level(LogCategory::Scan);
+    EXPECT_EQ(logger.get_log_level(LogCategory::Scan), LogLevel::Error);
+    logger.set_log_level(LogLevel::Info);
+    EXPECT_EQ(logger.get_log_level(LogCategory::Scan), LogLevel::Info);
+
+    // An invalid level or category is ignored.
+    logger.set_log_level(LogCategory::Input, static_cast<LogLevel>(99));
+    logger.set_log_level(LogCategory::Count, LogLevel::Error);
+    EXPECT_EQ(logger.get_log_level(LogCategory::Input), LogLevel::Info);
+}
+
+TEST_F(LoggerTest, CategoryLevels_FilterCategorizedOutput)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Warning);
+    logger.set_log_level(LogCategory::User0, LogLevel::Info);
+
+    logger.info(log_category::user0, "VISIBLE_CATEGORY_MSG_{}", 1);
+    logger.info(log_category::user1, "FILTERED_CATEGORY_MSG_{}", 2);
+    logger.info("FILTERED_GLOBAL_MSG_{}", 3);
+    EXPECT_TRUE(logger.try_log(log_category::user0, LogLevel::Info, "VISIBLE_TRY_MSG_{}", 4));
+    EXPECT_FALSE(logger.try_log(log_category::user1, LogLevel::Info, "FILTERED_TRY_MSG_{}", 5));
+    logger.flush();
+
+    std::ifstream ifs(m_test_log_file);
+    ASSERT_TRUE(ifs.is_open());
+    std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("VISIBLE_CATEGORY_MSG_1"), std::string::npos);
+    EXPECT_NE(content.find("VISIBLE_TRY_MSG_4"), std::string::npos);
+    EXPECT_EQ(content.find("FILTERED_CATEGORY_MSG_2"), std::string::npos);
+    EXPECT_EQ(content.find("FILTERED_GLOBAL_MSG_3"), std::string::npos);
+    EXPECT_EQ(content.find("FILTERED_TRY_MSG_5"), std::string::npos);
+
+    logger.reset_log_level(LogCategory::User0);
+    logger.set_log_level(LogLevel::Info);
+}
+
+TEST(LoggerCategory, ToStringNamesEveryCategory)
+{
+    EXPECT_EQ(to_string(LogCategory::Hook), "Hook");
+    EXPECT_EQ(to_string(LogCategory::Rtti), "Rtti");
+    EXPECT_EQ(to_string(LogCategory::User3), "User3");
+    EXPECT_EQ(to_string(LogCategory::Count), "Unknown");
+    static_assert(LOG_CATEGORY_COUNT == 10);
+}
+
 TEST_F(LoggerTest, Reconfigure_SwitchesFile)
 {
     Logger &logger = log();
@@ -994,6 +1129,33 @@ TEST_F(LoggerTest, Reconfigure_InvalidPath_KeepsOldFile)
     EXPECT_NE(content.find("BEFORE_INVALID_RECONFIG_3k7m"), std::string::npos);
 }
 
+TEST_F(LoggerTest, SyncWrite_KeepsLineLayoutAcrossBufferReuse)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Info);
+
+    const std::string oversized(40 * 1024, 'q');
+    logger.warning("SYNC_LAYOUT_FIRST_4h8c");
+    logger.info("SYNC_LAYOUT_BIG_{}", oversized);
+    logger.log(LogLevel::Info, "SYNC_LAYOUT_LAST_2w6n");
+    logger.flush();
+
+    std::ifstream ifs(m_test_log_file);
+    ASSERT_TRUE(ifs.is_open());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(ifs, line);)
+    {
+        if (line.find("SYNC_LAYOUT_") != std::string::npos)
+        {
+            lines.push_back(line);
+        }
+    }
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_NE(lines[0].find("] [WARNING] :: ["), std::string::npos);
+    EXPECT_NE(lines[1].find(oversized), std::string::npos);
+    EXPECT_NE(lines[2].find("] [INFO   ] :: SYNC_LAYOUT_LAST_2w6n"), std::string::npos);
+}
+
 TEST_F(LoggerTest, FlushAsync_DrainsPendingMessages)
 {
     Logger &logger = log();
@@ -1017,6 +1179,135 @@ TEST_F(LoggerTest, FlushAsync_DrainsPendingMessages)
     EXPECT_NE(content.find("ASYNC_DRAIN_MSG_19"), std::string::npos);
 }
 
+static_assert(detail::deferrable_log_args<int &, const double &, unsigned, bool, const void *>);
+static_assert(!detail::deferrable_log_args<>);
+static_assert(!detail::deferrable_log_args<int, const char *>);
+static_assert(!detail::deferrable_log_args<std::string_view>);
+static_assert(!detail::deferrable_log_args<std::string>);
+
+TEST_F(LoggerTest, DeferredFormatting_WriterRendersScalarLinesLikeTheEagerPath)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Info);
+
+    AsyncLoggerConfig config;
+    config.defer_formatting = true;
+    logger.enable_async_mode(config);
+    ASSERT_TRUE(logger.is_async_mode_enabled());
+
+    const int count = 7;
+    logger.info("DEFER_SCALARS {} {:.2f} {:#x} {}", count, 2.5, 255u, true);
+    logger.info("DEFER_POINTER {}", static_cast<const void *>(nullptr));
+    logger.info("DEFER_MIXED {} {}", std::string("eager"), count);
+    EXPECT_TRUE(logger.try_log(LogLevel::Warning, "DEFER_TRY {}", -3));
+    logger.flush();
+    logger.disable_async_mode();
+
+    logger.info("DEFER_SCALARS {} {:.2f} {:#x} {}", count, 2.5, 255u, true);
+    logger.flush();
+
+    std::ifstream ifs(m_test_log_file);
+    ASSERT_TRUE(ifs.is_open());
+    std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("DEFER_POINTER 0x0"), std::string::npos);
+    EXPECT_NE(content.find("DEFER_MIXED eager 7"), std::string::npos);
+    EXPECT_NE(content.find("DEFER_TRY -3"), std::string::npos);
+
+    // The deferred line and its synchronous twin carry the same stamp and body.
+    const std::string body = "] DEFER_SCALARS 7 2.50 0xff true";
+    const size_t first = content.find(body);
+    ASSERT_NE(first, std::string::npos);
+    const size_t second = content.find(body, first + body.size());
+    ASSERT_NE(second, std::string::npos);
+    const size_t first_stamp = content.rfind("[test_logger.cpp:", first);
+    const size_t second_stamp = content.rfind("[test_logger.cpp:", second);
+    ASSERT_NE(first_stamp, std::string::npos);
+    ASSERT_NE(second_stamp, first_stamp);
+}
+
+TEST_F(LoggerTest, RateLimit_ThrottlesAFloodingCallSiteOnly)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Info);
+
+    AsyncLoggerConfig config;
+    config.rate_limit_per_second = 1;
+    config.rate_limit_burst = 5;
+    logger.enable_async_mode(config);
+    ASSERT_TRUE(logger.is_async_mode_enabled());
+
+    for (int i = 0; i < 100; ++i)
+    {
+        logger.warning("RATE_FLOOD {}", i);
+    }
+    logger.info("RATE_OTHER_SITE");
+    logger.flush();
+    logger.disable_async_mode();
+
+    std::ifstream ifs(m_test_log_file);
+    ASSERT_TRUE(ifs.is_open());
+    int flood_lines = 0;
+    bool other_seen = false;
+    for (std::string line; std::getline(ifs, line);)
+    {
+        flood_lines += line.find("RATE_FLOOD") != std::string::npos ? 1 : 0;
+        other_seen = other_seen || line.find("RATE_OTHER_SITE") != std::string::npos;
+    }
+    // The burst, plus at most one token if the loop straddled a second.
+    EXPECT_GE(flood_lines, 5);
+    EXPECT_LE(flood_lines, 6);
+    EXPECT_TRUE(other_seen);
+}
+
+TEST_F(LoggerTest, LogKv_AsyncModeWritesTheStructuredLog)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Info);
+    const std::filesystem::path kv_file = m_test_log_file.string() + ".kv";
+
+    AsyncLoggerConfig config;
+    config.structured_log_path = kv_file.string();
+    logger.enable_async_mode(config);
+    ASSERT_TRUE(logger.is_async_mode_enabled());
+
+    auto *const target = reinterpret_cast<void *>(std::uintptr_t{0x1400});
+    EXPECT_TRUE(logger.log_kv(LogLevel::Warning, "hook.installed", kv("target", target), kv("size", 14)));
+    EXPECT_FALSE(logger.log_kv(LogLevel::Debug, "hook.filtered", kv("size", 1)));
+    logger.flush();
+    logger.disable_async_mode();
+
+    const auto decoded = log_kv::read_file(kv_file.string());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_FALSE(decoded->truncated);
+    ASSERT_EQ(decoded->events.size(), 1u);
+    const log_kv::Schema &schema = decoded->schemas[decoded->events[0].schema];
+    EXPECT_EQ(schema.event_id, "hook.installed");
+    EXPECT_EQ(schema.file, "test_logger.cpp");
+    EXPECT_EQ(decoded->events[0].level, LogLevel::Warning);
+    EXPECT_EQ(decoded->events[0].values, (std::vector<std::uint64_t>{0x1400, 14}));
+
+    std::ifstream ifs(m_test_log_file);
+    const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content.find("hook.installed"), std::string::npos);
+
+    std::error_code ec;
+    std::filesystem::remove(kv_file, ec);
+}
+
+TEST_F(LoggerTest, LogKv_WithoutAStructuredLogWritesATextLine)
+{
+    Logger &logger = log();
+    logger.set_log_level(LogLevel::Info);
+
+    EXPECT_TRUE(logger.log_kv(LogLevel::Info, "player.spawned", kv("id", 7u), kv("alive", true)));
+    logger.flush();
+
+    std::ifstream ifs(m_test_log_file);
+    const std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("[test_logger.cpp:"), std::string::npos);
+    EXPECT_NE(content.find("] player.spawned id=7 alive=true"), std::string::npos) << content;
+}
+
 TEST_F(LoggerTest, ShutdownWithAsyncMode_NoHang)
 {
     Logger &logger = log();
@@ -1911,3 +2202,26 @@ TEST_F(LoggerTest, ReconfigureFormatReachesLiveAsyncWriter)
     }
     EXPECT_TRUE(bravo_line_seen) << "async line missing from the reconfigured file";
 }
+
+// With the async writer still alive this only proves the drain reaches the file; on a real exit the writer is gone and
+// this call is the only thing that empties the queue.
+TEST_F(LoggerTest, FlushAtProcessExit_WritesQueuedLinesToTheFile)
+{
+    Logger &logger = log();
+    logger.info("sync line before exit");
+    logger.flush_at_process_exit();
+
+    AsyncLoggerConfig config;
+    config.flush_interval = std::chrono::milliseconds{10000};
+    logger.enable_async_mode(config);
+    ASSERT_TRUE(logger.is_async_mode_enabled());
+    logger.info("async line before exit");
+    logger.flush_at_process_exit();
+
+    std::ifstream in(m_test_log_file);
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find("sync line before exit"), std::string::npos);
+    EXPECT_NE(content.find("async line before exit"), std::string::npos);
+
+    logger.disable_async_mode();
+}
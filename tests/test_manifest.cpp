@@ -1,10 +1,12 @@
 #include <gtest/gtest.h>
 
 #include <atomic>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <filesystem>
+#include <format>
 #include <initializer_list>
 #include <limits>
 #include <optional>
@@ -12,6 +14,7 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <vector>
 
 #include "DetourModKit/anchor.hpp"
@@ -995,6 +998,51 @@ TEST(ManifestPageClassTest, CompileAndAdoptRejectInvalidPageClass)
     EXPECT_EQ(adopted.error().code, dmk::ErrorCode::InvalidArg);
 }
 
+TEST(ManifestLocalityHintTest, LastSeenRvaRoundTripsStaysOutOfTheFingerprintAndNarrowsTheScan)
+{
+    // Two copies of the marker further apart than the default hint window, so only the hint can tell them apart.
+    constexpr std::size_t size = 0x100000;
+    constexpr std::size_t moved_rva = 0xF0000;
+    void *data = VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(data, nullptr);
+    std::memset(data, 0xCC, size);
+    const std::uint8_t marker[] = {0xDE, 0xAD, 0xBE, 0xEF};
+    std::memcpy(static_cast<std::uint8_t *>(data) + 0x100, marker, sizeof(marker));
+    std::memcpy(static_cast<std::uint8_t *>(data) + moved_rva, marker, sizeof(marker));
+    const dmk::Region scope{dmk::Address{reinterpret_cast<std::uintptr_t>(data)}, size};
+
+    mf::CandidateSpec rung;
+    rung.mode = sc::Mode::Direct;
+    rung.pattern = "DE AD BE EF";
+
+    mf::SignatureRecord record;
+    record.label = "moved";
+    record.kind = an::AnchorKind::RipGlobal;
+    record.ladder = {rung};
+    const auto unhinted = mf::Signature::compile(record);
+    ASSERT_TRUE(unhinted.has_value()) << unhinted.error().message();
+    EXPECT_EQ(unhinted->resolve(scope).status, an::AnchorStatus::Failed);
+
+    record.last_seen_rva = moved_rva;
+    const auto parsed = mf::parse(mf::serialize(mf::Manifest{.records = {record}}));
+    ASSERT_TRUE(parsed.has_value()) << parsed.error().message();
+    ASSERT_EQ(parsed->records.size(), 1u);
+    EXPECT_EQ(parsed->records[0].last_seen_rva, moved_rva);
+
+    const auto hinted = mf::Signature::compile(parsed->records[0]);
+    ASSERT_TRUE(hinted.has_value()) << hinted.error().message();
+    EXPECT_EQ(hinted->current_fingerprint(), unhinted->current_fingerprint());
+
+    const std::vector<mf::Signature> signatures = {*hinted};
+    const mf::GateResult gate = mf::resolve_and_gate(signatures, {}, scope);
+    const mf::GatedSignature *trusted = gate.find("moved");
+    ASSERT_NE(trusted, nullptr);
+    EXPECT_EQ(trusted->address.raw(), reinterpret_cast<std::uintptr_t>(data) + moved_rva);
+    EXPECT_EQ(trusted->source, sc::HitSource::HintWindow);
+
+    VirtualFree(data, 0, MEM_RELEASE);
+}
+
 TEST(ManifestParseTest, RipRelativeRungMissingInstructionLengthIsMalformed)
 {
     const auto parsed = mf::parse("[manifest]\nschema = 1\n[sig.x]\nkind = rip_global\n"
@@ -1254,6 +1302,26 @@ TEST(ManifestFingerprintTest, RecaptureAdoptsCurrentAsBaseline)
     EXPECT_EQ(sig.record().expected_fingerprint, sig.current_fingerprint());
 }
 
+TEST(ManifestFingerprintTest, CopiesAndMovesKeepTheConstructionFingerprint)
+{
+    // The hash is taken once at construction; a copy or move must carry it, not re-derive it from a moved-from ladder.
+    mf::SignatureRecord record;
+    record.label = "probe.ladder";
+    record.kind = an::AnchorKind::RipGlobal;
+    mf::CandidateSpec rung;
+    rung.mode = sc::Mode::Direct;
+    rung.pattern = "48 8B 05 ?? ?? ?? ??";
+    record.ladder = {rung};
+    mf::Signature original = mf::Signature::compile(record).value();
+    const std::uint64_t fingerprint = original.current_fingerprint();
+
+    const mf::Signature copy = original;
+    EXPECT_EQ(copy.current_fingerprint(), fingerprint);
+    const mf::Signature moved = std::move(original);
+    EXPECT_EQ(moved.current_fingerprint(), fingerprint);
+    EXPECT_EQ(mf::Signature::compile(record).value().current_fingerprint(), fingerprint);
+}
+
 // The drift fingerprint must cover the Binding (the consumer "read it there" contract), not only the locate evidence.
 // Mutating ANY binding field -- register, offset chain, value width, XMM lane, or vtable slot -- must change the
 // fingerprint, so an un-recaptured binding edit is caught. Every case shares the same Manual locate value (0x1000), so
@@ -1425,6 +1493,372 @@ TEST(ManifestGateTest, ResolveFailureIsRejected)
     EXPECT_EQ(gate.rejected[0].status, an::AnchorStatus::Failed);
 }
 
+TEST(ManifestGateTest, ChildOfAFailedOrMissingParentIsRejected)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+
+    mf::SignatureRecord absent;
+    absent.label = "absent";
+    absent.kind = an::AnchorKind::RipGlobal;
+    mf::CandidateSpec rung;
+    rung.mode = sc::Mode::Direct;
+    rung.pattern = "11 22 33 44 55 66 77 88";
+    absent.ladder = {rung};
+
+    // A Manual literal resolves wherever it is scanned, so only the parent decides these three.
+    mf::SignatureRecord under_absent = manual_record("under.absent", 0x10);
+    under_absent.parent = "absent";
+    mf::SignatureRecord under_missing = manual_record("under.missing", 0x20);
+    under_missing.parent = "no.such.signature";
+    mf::SignatureRecord under_root = manual_record("under.root", 0x30);
+    under_root.parent = "root";
+
+    // Keep the child ahead of its parent, so the resolve order has to come from the graph, not the input.
+    std::vector<mf::Signature> sigs;
+    sigs.push_back(mf::Signature::compile(std::move(under_root)).value());
+    sigs.push_back(mf::Signature::compile(std::move(absent)).value());
+    sigs.push_back(mf::Signature::compile(std::move(under_absent)).value());
+    sigs.push_back(mf::Signature::compile(std::move(under_missing)).value());
+    sigs.push_back(manual_signature("root", 0x1000));
+
+    for (const std::size_t workers : {std::size_t{1}, std::size_t{4}})
+    {
+        mf::GatePolicy policy;
+        policy.max_workers = workers;
+        const mf::GateResult gate = mf::resolve_and_gate(sigs, policy, page.range());
+        ASSERT_EQ(gate.trusted.size(), 2u) << "workers=" << workers;
+        EXPECT_NE(gate.find("root"), nullptr);
+        ASSERT_NE(gate.find("under.root"), nullptr);
+        EXPECT_EQ(gate.find("under.root")->address.raw(), 0x30u);
+        EXPECT_EQ(gate.find("under.absent"), nullptr);
+        EXPECT_EQ(gate.find("under.missing"), nullptr);
+    }
+}
+
+TEST(ManifestGateTest, PrescannedManifestGatesLikeEachSignatureAlone)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+
+    // Enough byte rungs to cross the multi-pattern threshold: ten planted markers, one marker planted twice (so its
+    // locate is ambiguous), and one never planted.
+    constexpr std::size_t PLANTED = 10;
+    std::vector<mf::Signature> sigs;
+    for (std::size_t i = 0; i < PLANTED + 2; ++i)
+    {
+        const auto tag = static_cast<std::uint8_t>(0x10 + i);
+        if (i < PLANTED)
+        {
+            page.put(0x100 + i * 0x20, {0x5A, 0xA5, tag, 0x3C, 0xC3, 0x77});
+        }
+        if (i == 0)
+        {
+            page.put(0x800, {0x5A, 0xA5, tag, 0x3C, 0xC3, 0x77});
+        }
+        mf::SignatureRecord record;
+        record.label = "marker." + std::to_string(i);
+        record.kind = an::AnchorKind::RipGlobal;
+        mf::CandidateSpec rung;
+        rung.mode = sc::Mode::Direct;
+        rung.pattern = std::format("5A A5 {:02X} 3C C3 77", tag);
+        record.ladder = {rung};
+        sigs.push_back(mf::Signature::compile(std::move(record)).value());
+    }
+
+    for (const std::size_t workers : {std::size_t{1}, std::size_t{4}})
+    {
+        mf::GatePolicy policy;
+        policy.max_workers = workers;
+        const mf::GateResult gate = mf::resolve_and_gate(sigs, policy, page.range());
+        EXPECT_EQ(gate.trusted.size(), PLANTED - 1) << "workers=" << workers;
+        EXPECT_EQ(gate.rejected.size(), 3u) << "workers=" << workers;
+        for (const mf::Signature &signature : sigs)
+        {
+            const an::ResolvedAnchor alone = signature.resolve(page.range());
+            const mf::GatedSignature *gated = gate.find(signature.label());
+            ASSERT_EQ(gated != nullptr, alone.status == an::AnchorStatus::Resolved) << signature.label();
+            if (gated != nullptr)
+            {
+                EXPECT_EQ(gated->address.raw(), static_cast<std::uintptr_t>(alone.value)) << signature.label();
+            }
+        }
+        EXPECT_EQ(gate.find("marker.0"), nullptr);
+        ASSERT_NE(gate.find("marker.1"), nullptr);
+        EXPECT_EQ(gate.find("marker.1")->address.raw(), page.addr(0x120));
+    }
+}
+
+// IncrementalGate: a reload re-resolves only what the edit touched.
+
+namespace
+{
+    // A RipGlobal record locating the six-byte marker 5A A5 <tag> 3C C3 77.
+    [[nodiscard]] mf::SignatureRecord marker_record(std::string label, std::uint8_t tag)
+    {
+        mf::SignatureRecord record;
+        record.label = std::move(label);
+        record.kind = an::AnchorKind::RipGlobal;
+        mf::CandidateSpec rung;
+        rung.mode = sc::Mode::Direct;
+        rung.pattern = std::format("5A A5 {:02X} 3C C3 77", tag);
+        record.ladder = {rung};
+        return record;
+    }
+
+    // Three planted markers plus a Manual child of the first, which only its parent decides.
+    [[nodiscard]] mf::Manifest incremental_manifest(ScratchPage &page)
+    {
+        mf::Manifest manifest;
+        for (std::uint8_t i = 0; i < 3; ++i)
+        {
+            const auto tag = static_cast<std::uint8_t>(0x40 + i);
+            page.put(0x100 + i * 0x20u, {0x5A, 0xA5, tag, 0x3C, 0xC3, 0x77});
+            manifest.records.push_back(marker_record("marker." + std::to_string(i), tag));
+        }
+        mf::SignatureRecord child = manual_record("marker.0.child", 0x30);
+        child.parent = "marker.0";
+        manifest.records.push_back(std::move(child));
+        return manifest;
+    }
+} // namespace
+
+TEST(IncrementalGateTest, UnchangedReloadResolvesNothing)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    const mf::Manifest manifest = incremental_manifest(page);
+
+    mf::IncrementalGate gate({}, page.range());
+    const auto first = gate.apply(manifest);
+    ASSERT_TRUE(first.has_value()) << first.error().message();
+    EXPECT_EQ(*first, 4u);
+    EXPECT_EQ(gate.result().trusted.size(), 4u);
+
+    const auto again = gate.apply(manifest);
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(*again, 0u);
+    ASSERT_EQ(gate.result().trusted.size(), 4u);
+    ASSERT_NE(gate.result().find("marker.1"), nullptr);
+    EXPECT_EQ(gate.result().find("marker.1")->address.raw(), page.addr(0x120));
+    EXPECT_EQ(gate.report()[1].label, "marker.1");
+}
+
+TEST(IncrementalGateTest, EditedParentResolvesAgainWithItsChild)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    mf::Manifest manifest = incremental_manifest(page);
+    mf::IncrementalGate gate({}, page.range());
+    ASSERT_TRUE(gate.apply(manifest).has_value());
+
+    // Point marker.0 at a tag that is not planted: it and the child under it resolve again and both drop out.
+    manifest.records[0] = marker_record("marker.0", 0x7E);
+    const auto edited = gate.apply(manifest);
+    ASSERT_TRUE(edited.has_value());
+    EXPECT_EQ(*edited, 2u);
+    EXPECT_EQ(gate.result().find("marker.0"), nullptr);
+    EXPECT_EQ(gate.result().find("marker.0.child"), nullptr);
+    EXPECT_NE(gate.result().find("marker.2"), nullptr);
+
+    // The merged outcome is the one a full gate of the same signatures reports.
+    const mf::GateResult full = mf::resolve_and_gate(gate.signatures(), {}, page.range());
+    ASSERT_EQ(full.trusted.size(), gate.result().trusted.size());
+    for (const mf::GatedSignature &entry : full.trusted)
+    {
+        ASSERT_NE(gate.result().find(entry.label), nullptr) << entry.label;
+        EXPECT_EQ(gate.result().find(entry.label)->address.raw(), entry.address.raw());
+    }
+
+    // An edit to an unrelated leaf touches that leaf alone.
+    manifest.records[2].last_seen_rva = 0x120;
+    const auto leaf = gate.apply(manifest);
+    ASSERT_TRUE(leaf.has_value());
+    EXPECT_EQ(*leaf, 1u);
+}
+
+TEST(IncrementalGateTest, CompileErrorKeepsTheLastGoodOutcome)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    mf::Manifest manifest = incremental_manifest(page);
+    mf::IncrementalGate gate({}, page.range());
+    ASSERT_TRUE(gate.apply(manifest).has_value());
+
+    manifest.records[1].ladder[0].pattern = "5A ZZ";
+    const auto broken = gate.apply(manifest);
+    ASSERT_FALSE(broken.has_value());
+    EXPECT_EQ(broken.error().detail, 1u);
+    EXPECT_EQ(gate.result().trusted.size(), 4u);
+    EXPECT_EQ(gate.signatures().size(), 4u);
+}
+
+TEST(IncrementalGateTest, InvalidateResolvesEverythingAgain)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    const mf::Manifest manifest = incremental_manifest(page);
+    mf::IncrementalGate gate({}, page.range());
+    ASSERT_TRUE(gate.apply(manifest).has_value());
+
+    gate.invalidate();
+    const auto refreshed = gate.apply(manifest);
+    ASSERT_TRUE(refreshed.has_value());
+    EXPECT_EQ(*refreshed, 4u);
+    EXPECT_EQ(*gate.apply(manifest), 0u);
+}
+
+// LazyGate: a signature resolves on first access, or in the mandatory batch, or on the prefetch worker.
+
+namespace
+{
+    [[nodiscard]] std::vector<mf::Signature> compile_all(const mf::Manifest &manifest)
+    {
+        std::vector<mf::Signature> signatures;
+        for (const mf::SignatureRecord &record : manifest.records)
+        {
+            signatures.push_back(mf::Signature::compile(record).value());
+        }
+        return signatures;
+    }
+} // namespace
+
+TEST(LazyGateTest, FirstAccessResolvesOnlyTheSignatureAndItsParents)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    const std::vector<mf::Signature> signatures = compile_all(incremental_manifest(page));
+    const mf::GateResult full = mf::resolve_and_gate(signatures, {}, page.range());
+    mf::LazyGate gate(signatures, {}, page.range());
+    for (std::size_t index = 0; index < signatures.size(); ++index)
+    {
+        EXPECT_FALSE(gate.settled(index));
+        EXPECT_EQ(gate.resolved(index), nullptr);
+    }
+
+    const mf::GatedSignature *child = gate.find("marker.0.child");
+    ASSERT_NE(child, nullptr);
+    ASSERT_NE(full.find("marker.0.child"), nullptr);
+    EXPECT_EQ(child->address.raw(), full.find("marker.0.child")->address.raw());
+    EXPECT_TRUE(gate.settled(0));
+    EXPECT_FALSE(gate.settled(1));
+    EXPECT_FALSE(gate.settled(2));
+    EXPECT_TRUE(gate.settled(3));
+
+    // A second access reads the stored verdict.
+    EXPECT_EQ(gate.find("marker.0.child"), child);
+    ASSERT_NE(gate.get(0), nullptr);
+    EXPECT_EQ(gate.get(0)->address.raw(), page.addr(0x100));
+    EXPECT_EQ(gate.get(signatures.size()), nullptr);
+    EXPECT_EQ(gate.find("marker.9"), nullptr);
+}
+
+TEST(LazyGateTest, ResolveNowSettlesTheMandatorySet)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    mf::LazyGate gate(compile_all(incremental_manifest(page)), {}, page.range());
+
+    const std::string_view unknown[] = {"marker.1", "marker.9"};
+    const auto rejected = gate.resolve_now(unknown);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, dmk::ErrorCode::InvalidArg);
+    EXPECT_EQ(rejected.error().detail, 1u);
+    EXPECT_FALSE(gate.settled(1));
+
+    const std::string_view mandatory[] = {"marker.1", "marker.0.child"};
+    ASSERT_TRUE(gate.resolve_now(mandatory).has_value());
+    EXPECT_TRUE(gate.settled(0));
+    EXPECT_TRUE(gate.settled(1));
+    EXPECT_FALSE(gate.settled(2));
+    EXPECT_TRUE(gate.settled(3));
+    ASSERT_NE(gate.resolved(1), nullptr);
+    EXPECT_EQ(gate.resolved(1)->status, an::AnchorStatus::Resolved);
+    ASSERT_NE(gate.get(1), nullptr);
+    EXPECT_EQ(gate.get(1)->address.raw(), page.addr(0x120));
+}
+
+TEST(LazyGateTest, PrefetchSettlesEverySignatureInTheBackground)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    const std::vector<mf::Signature> signatures = compile_all(incremental_manifest(page));
+    const mf::GateResult full = mf::resolve_and_gate(signatures, {}, page.range());
+    mf::LazyGate gate(signatures, {}, page.range());
+
+    const std::string_view mandatory[] = {"marker.2"};
+    ASSERT_TRUE(gate.resolve_now(mandatory).has_value());
+    ASSERT_TRUE(gate.prefetch().has_value());
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    const auto all_settled = [&]()
+    {
+        for (std::size_t index = 0; index < signatures.size(); ++index)
+        {
+            if (!gate.settled(index))
+            {
+                return false;
+            }
+        }
+        return true;
+    };
+    while (!all_settled() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(all_settled());
+    gate.stop_prefetch();
+
+    for (const mf::Signature &signature : signatures)
+    {
+        const mf::GatedSignature *lazy = gate.find(signature.label());
+        const mf::GatedSignature *eager = full.find(signature.label());
+        ASSERT_EQ(lazy != nullptr, eager != nullptr) << signature.label();
+        if (lazy != nullptr)
+        {
+            EXPECT_EQ(lazy->address.raw(), eager->address.raw()) << signature.label();
+        }
+    }
+}
+
+TEST(LazyGateTest, DriftAndParentCyclesFailClosed)
+{
+    ScratchPage page;
+    ASSERT_TRUE(page.ok());
+    mf::Manifest manifest = incremental_manifest(page);
+    manifest.records[1].expected_fingerprint = 1;
+    mf::SignatureRecord loop_a = manual_record("loop.a", 0x10);
+    loop_a.parent = "loop.b";
+    mf::SignatureRecord loop_b = manual_record("loop.b", 0x20);
+    loop_b.parent = "loop.a";
+    manifest.records.push_back(std::move(loop_a));
+    manifest.records.push_back(std::move(loop_b));
+    mf::LazyGate gate(compile_all(manifest), {}, page.range());
+
+    // marker.1 resolves, but its baseline no longer matches, so the default policy rejects it.
+    EXPECT_EQ(gate.get(1), nullptr);
+    ASSERT_NE(gate.resolved(1), nullptr);
+    EXPECT_EQ(gate.resolved(1)->status, an::AnchorStatus::Resolved);
+
+    EXPECT_EQ(gate.find("loop.a"), nullptr);
+    EXPECT_EQ(gate.find("loop.b"), nullptr);
+    EXPECT_NE(gate.find("marker.2"), nullptr);
+}
+
+TEST(ManifestGateTest, ParentKeysRoundTrip)
+{
+    mf::SignatureRecord child = manual_record("player.health_write", 0x10);
+    child.parent = "player.update";
+    child.parent_window = 0x200;
+    const std::string text = mf::serialize(mf::Manifest{.records = {manual_record("player.update", 0x1000), child}});
+    const auto parsed = mf::parse(text);
+    ASSERT_TRUE(parsed.has_value()) << parsed.error().message();
+    ASSERT_EQ(parsed->records.size(), 2u);
+    EXPECT_TRUE(parsed->records[0].parent.empty());
+    EXPECT_EQ(parsed->records[1].parent, "player.update");
+    EXPECT_EQ(parsed->records[1].parent_window, 0x200u);
+    EXPECT_EQ(mf::serialize(*parsed), text);
+}
+
 TEST(ManifestGateTest, WholeManifestFloorDemotesAllWhenTooUnhealthy)
 {
     const std::uint64_t fp = manual_signature("probe", 100).current_fingerprint();
@@ -1488,6 +1922,26 @@ TEST(ManifestOverlayTest, FileOverridesCodeByLabelAndAdoptsTheRest)
     EXPECT_EQ(b->address.raw(), 999u); // file override won
 }
 
+TEST(ManifestOverlayTest, AdoptedChildNamesItsParentByLabel)
+{
+    an::Anchor defaults[2]{};
+    defaults[0].label = "fn";
+    defaults[0].kind = an::AnchorKind::Manual;
+    defaults[0].manual_value = 0x1000;
+    defaults[1].label = "site";
+    defaults[1].kind = an::AnchorKind::Manual;
+    defaults[1].manual_value = 0x20;
+    defaults[1].parent = 0;
+    defaults[1].parent_window = 0x40;
+
+    const auto merged = mf::overlay(defaults, {});
+    ASSERT_TRUE(merged.has_value());
+    ASSERT_EQ(merged->size(), 2u);
+    EXPECT_TRUE((*merged)[0].record().parent.empty());
+    EXPECT_EQ((*merged)[1].record().parent, "fn");
+    EXPECT_EQ((*merged)[1].record().parent_window, 0x40u);
+}
+
 TEST(ManifestOverlayTest, MissingOverridesPassDefaultsThrough)
 {
     an::Anchor defaults[1]{};
@@ -1689,3 +2143,158 @@ TEST(ManifestRevisionTest, SchemaEmittedBeforeRevisionInHeader)
     ASSERT_NE(revision_pos, std::string::npos);
     EXPECT_LT(schema_pos, revision_pos);
 }
+
+// Binary compiled manifest: compile_to_binary / parse_binary reproduce the INI load without re-parsing it.
+
+namespace
+{
+    // One record per byte-compiled rung shape plus the non-ladder kinds, so every table of the blob is populated.
+    [[nodiscard]] std::vector<mf::SignatureRecord> binary_sample_records()
+    {
+        std::vector<mf::SignatureRecord> records;
+        {
+            mf::SignatureRecord record;
+            record.label = "camera.fov_write";
+            record.kind = an::AnchorKind::RipGlobal;
+            record.module = "engine.dll";
+            record.binding.kind = mf::BindingKind::MidHookRegister;
+            record.binding.read_register = hk::Gpr::Rcx;
+            record.pages = sc::Pages::Executable;
+            mf::CandidateSpec rung0;
+            rung0.name = "fov-direct";
+            rung0.mode = sc::Mode::RipRelative;
+            rung0.pattern = "F3 0F 11 05 ?? ?? ?? ?? 48 8B";
+            rung0.displacement_at = 4;
+            rung0.instruction_length = 8;
+            mf::CandidateSpec rung1;
+            rung1.mode = sc::Mode::StringXref;
+            rung1.string_text = "CameraFov";
+            rung1.string_broad_match = true;
+            record.ladder = {rung0, rung1};
+            records.push_back(std::move(record));
+        }
+        {
+            mf::SignatureRecord record;
+            record.label = "player.health";
+            record.kind = an::AnchorKind::CodeOperand;
+            record.operand_kind = sc::OperandKind::MemoryDisplacement;
+            record.operand_index = 1;
+            record.byte_width = 4;
+            record.binding.kind = mf::BindingKind::PointerChain;
+            record.binding.offsets = {0x1C8, -0x40};
+            record.binding.value_width = 4;
+            mf::CandidateSpec rung;
+            rung.mode = sc::Mode::Direct;
+            rung.pattern = "48 8B 05 ?? ?? ?? ?? [2-4] 4? 85 | C0";
+            rung.walk_back = -3;
+            record.ladder = {rung};
+            records.push_back(std::move(record));
+        }
+        {
+            mf::SignatureRecord record;
+            record.label = "ai.think_vmethod";
+            record.kind = an::AnchorKind::VtableIdentity;
+            record.mangled = ".?AVCAIController@@";
+            record.binding.kind = mf::BindingKind::VmtMethod;
+            record.binding.vmt_index = 7;
+            records.push_back(std::move(record));
+        }
+        records.push_back(manual_record("debug.flag_ptr", 0x14000ABCD, 0x9F2C7A10B3D45E88ULL));
+        return records;
+    }
+
+    [[nodiscard]] std::vector<mf::SignatureRecord> records_of(const mf::CompiledManifest &compiled)
+    {
+        std::vector<mf::SignatureRecord> records;
+        for (const mf::Signature &signature : compiled.signatures)
+        {
+            records.push_back(signature.record());
+        }
+        return records;
+    }
+} // namespace
+
+TEST(ManifestBinaryTest, ParseReproducesTheSignaturesTheTextLoadCompiles)
+{
+    const mf::Manifest manifest{.header = {.revision = 3}, .records = binary_sample_records()};
+    const auto blob = mf::compile_to_binary(manifest);
+    ASSERT_TRUE(blob.has_value()) << blob.error().message();
+
+    const auto parsed = mf::parse_binary(*blob);
+    ASSERT_TRUE(parsed.has_value()) << parsed.error().message();
+    EXPECT_EQ(parsed->header.revision, 3u);
+    ASSERT_EQ(parsed->signatures.size(), manifest.records.size());
+    EXPECT_EQ(mf::serialize(mf::Manifest{.header = manifest.header, .records = records_of(*parsed)}),
+              mf::serialize(manifest));
+
+    // The fingerprint covers the compiled ladder, so equal fingerprints mean the stored patterns are the ones
+    // Pattern::compile builds from the text.
+    for (std::size_t i = 0; i < manifest.records.size(); ++i)
+    {
+        const auto reference = mf::Signature::compile(manifest.records[i]);
+        ASSERT_TRUE(reference.has_value());
+        EXPECT_EQ(parsed->signatures[i].current_fingerprint(), reference->current_fingerprint()) << "record " << i;
+    }
+}
+
+TEST(ManifestBinaryTest, RecordTheTextPathRejectsFailsToCompileWithItsIndex)
+{
+    std::vector<mf::SignatureRecord> records = binary_sample_records();
+    mf::SignatureRecord empty_ladder;
+    empty_ladder.label = "no.ladder";
+    empty_ladder.kind = an::AnchorKind::RipGlobal;
+    records.push_back(std::move(empty_ladder));
+
+    const auto blob = mf::compile_to_binary(mf::Manifest{.records = records});
+    ASSERT_FALSE(blob.has_value());
+    EXPECT_EQ(blob.error().code, dmk::ErrorCode::EmptyCandidates);
+    EXPECT_EQ(blob.error().detail, records.size() - 1);
+}
+
+TEST(ManifestBinaryTest, CorruptedBodyFailsTheChecksum)
+{
+    auto blob = mf::compile_to_binary(mf::Manifest{.records = binary_sample_records()});
+    ASSERT_TRUE(blob.has_value());
+    // The last byte sits in the string pool, which no structural check would catch on its own.
+    blob->back() ^= std::byte{0x20};
+
+    const auto parsed = mf::parse_binary(*blob);
+    ASSERT_FALSE(parsed.has_value());
+    EXPECT_EQ(parsed.error().code, dmk::ErrorCode::MalformedLine);
+}
+
+TEST(ManifestBinaryTest, TruncatedOrForeignBlobReportsMissingHeader)
+{
+    const auto blob = mf::compile_to_binary(mf::Manifest{.records = binary_sample_records()});
+    ASSERT_TRUE(blob.has_value());
+
+    const std::span<const std::byte> truncated(blob->data(), blob->size() - 1);
+    EXPECT_EQ(mf::parse_binary(truncated).error().code, dmk::ErrorCode::MissingHeader);
+    EXPECT_EQ(mf::parse_binary({}).error().code, dmk::ErrorCode::MissingHeader);
+
+    std::vector<std::byte> foreign = *blob;
+    foreign[0] = std::byte{'X'};
+    EXPECT_EQ(mf::parse_binary(foreign).error().code, dmk::ErrorCode::MissingHeader);
+}
+
+TEST(ManifestBinaryTest, SaveBinaryThenLoadBinaryRoundTrips)
+{
+    const mf::Manifest manifest{.records = binary_sample_records()};
+    const ScopedManifestFile file("binary");
+
+    const auto saved = mf::save_binary(file.path(), manifest);
+    ASSERT_TRUE(saved.has_value()) << saved.error().message();
+
+    const auto loaded = mf::load_binary(file.path());
+    ASSERT_TRUE(loaded.has_value()) << loaded.error().message();
+    EXPECT_EQ(mf::serialize(mf::Manifest{.records = records_of(*loaded)}), mf::serialize(manifest));
+}
+
+TEST(ManifestBinaryTest, LoadBinaryMissingFileReportsFileOpenFailed)
+{
+    const ScopedManifestFile file("binary_absent");
+
+    const auto loaded = mf::load_binary(file.path());
+    ASSERT_FALSE(loaded.has_value());
+    EXPECT_EQ(loaded.error().code, dmk::ErrorCode::FileOpenFailed);
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <cmath>
+#include <cstring>
 #include <numbers>
+#include <vector>
 
 #include "DetourModKit/math.hpp"
 
@@ -105,3 +107,141 @@ TEST(MathTest, radians_to_degrees_Infinity)
     float result = math::radians_to_degrees(std::numeric_limits<float>::infinity());
     EXPECT_TRUE(std::isinf(result));
 }
+
+namespace
+{
+    void expect_near(const math::Float3 &actual, const math::Float3 &expected)
+    {
+        EXPECT_NEAR(actual.x, expected.x, 1e-4f);
+        EXPECT_NEAR(actual.y, expected.y, 1e-4f);
+        EXPECT_NEAR(actual.z, expected.z, 1e-4f);
+    }
+
+    math::Float4x4 sample_transform()
+    {
+        return math::scaling({2.0f, 3.0f, 4.0f}) * math::rotation(math::normalize(math::Quat{0.3f, 0.2f, 0.1f, 0.9f})) *
+               math::translation({5.0f, -2.0f, 7.0f});
+    }
+
+    std::vector<math::Float3> sample_points(std::size_t n)
+    {
+        std::vector<math::Float3> points(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const float f = static_cast<float>(i);
+            points[i] = {f, 1.0f - 0.5f * f, 3.0f + 0.25f * f};
+        }
+        return points;
+    }
+} // namespace
+
+static_assert(math::identity() * math::identity() == math::identity());
+static_assert(math::transform_point(math::translation({1.0f, 2.0f, 3.0f}), math::Float3{1.0f, 1.0f, 1.0f}) ==
+              math::Float3{2.0f, 3.0f, 4.0f});
+static_assert(math::rotate(math::Quat{}, math::Float3{1.0f, 2.0f, 3.0f}) == math::Float3{1.0f, 2.0f, 3.0f});
+
+TEST(MathTest, Layout_MatchesEngineTypes)
+{
+    const float raw[16] = {1.0f, 2.0f, 3.0f, 4.0f};
+    math::Float3 v;
+    std::memcpy(&v, raw, sizeof(v));
+    EXPECT_EQ(v, (math::Float3{1.0f, 2.0f, 3.0f}));
+    math::Quat q;
+    std::memcpy(&q, raw, sizeof(q));
+    EXPECT_EQ(q.w, 4.0f);
+    EXPECT_EQ(math::Quat{}.w, 1.0f);
+}
+
+TEST(MathTest, DotAndCross)
+{
+    EXPECT_FLOAT_EQ(math::dot(math::Float3{1.0f, 2.0f, 3.0f}, math::Float3{4.0f, 5.0f, 6.0f}), 32.0f);
+    EXPECT_EQ(math::cross(math::Float3{1.0f, 0.0f, 0.0f}, math::Float3{0.0f, 1.0f, 0.0f}),
+              (math::Float3{0.0f, 0.0f, 1.0f}));
+    EXPECT_FLOAT_EQ(math::length(math::Float3{3.0f, 4.0f, 0.0f}), 5.0f);
+}
+
+TEST(MathTest, Rotate_QuarterTurnAboutZ)
+{
+    const math::Quat q = math::from_axis_angle({0.0f, 0.0f, 1.0f}, math::degrees_to_radians(90.0f));
+    expect_near(math::rotate(q, math::Float3{1.0f, 0.0f, 0.0f}), {0.0f, 1.0f, 0.0f});
+}
+
+TEST(MathTest, RotationMatrix_AgreesWithQuaternion)
+{
+    const math::Quat q = math::normalize(math::Quat{0.3f, -0.2f, 0.5f, 0.7f});
+    const math::Float3 v{1.0f, -2.0f, 0.5f};
+    expect_near(math::transform_vector(math::rotation(q), v), math::rotate(q, v));
+}
+
+TEST(MathTest, Product_AppliesLeftOperandFirst)
+{
+    const math::Float4x4 m = math::scaling({2.0f, 2.0f, 2.0f}) * math::translation({1.0f, 0.0f, 0.0f});
+    expect_near(math::transform_point(m, math::Float3{1.0f, 0.0f, 0.0f}), {3.0f, 0.0f, 0.0f});
+}
+
+TEST(MathTest, Slerp_Endpoints)
+{
+    const math::Quat q = math::from_axis_angle({0.0f, 1.0f, 0.0f}, 1.0f);
+    const math::Quat start = math::slerp(math::Quat{}, q, 0.0f);
+    const math::Quat end = math::slerp(math::Quat{}, q, 1.0f);
+    EXPECT_NEAR(start.w, 1.0f, 1e-5f);
+    EXPECT_NEAR(end.y, q.y, 1e-5f);
+    EXPECT_NEAR(end.w, q.w, 1e-5f);
+}
+
+TEST(MathTest, TransformPoints_MatchesScalarForm)
+{
+    const math::Float4x4 m = sample_transform();
+    // 19 covers the eight- and four-wide blocks plus a scalar tail.
+    const std::vector<math::Float3> in = sample_points(19);
+    std::vector<math::Float3> points(in.size());
+    std::vector<math::Float3> vectors(in.size());
+    EXPECT_EQ(math::transform_points(m, in, points), in.size());
+    EXPECT_EQ(math::transform_vectors(m, in, vectors), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        expect_near(points[i], math::transform_point(m, in[i]));
+        expect_near(vectors[i], math::transform_vector(m, in[i]));
+    }
+}
+
+TEST(MathTest, TransformFloat4_MatchesScalarForm)
+{
+    const math::Float4x4 m = sample_transform();
+    std::vector<math::Float4> in(5);
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        in[i] = {static_cast<float>(i), 2.0f, -1.0f, static_cast<float>(i % 2)};
+    }
+    std::vector<math::Float4> out(in.size());
+    EXPECT_EQ(math::transform(m, in, out), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        const math::Float4 expected = math::transform(m, in[i]);
+        EXPECT_NEAR(out[i].x, expected.x, 1e-4f);
+        EXPECT_NEAR(out[i].y, expected.y, 1e-4f);
+        EXPECT_NEAR(out[i].z, expected.z, 1e-4f);
+        EXPECT_NEAR(out[i].w, expected.w, 1e-4f);
+    }
+}
+
+TEST(MathTest, BatchRotate_InPlace)
+{
+    const math::Quat q = math::from_axis_angle({1.0f, 0.0f, 0.0f}, 0.75f);
+    const std::vector<math::Float3> in = sample_points(11);
+    std::vector<math::Float3> io = in;
+    EXPECT_EQ(math::rotate(q, io, io), in.size());
+    for (std::size_t i = 0; i < in.size(); ++i)
+    {
+        expect_near(io[i], math::rotate(q, in[i]));
+    }
+}
+
+TEST(MathTest, Batch_ProcessesShorterSpan)
+{
+    const std::vector<math::Float3> in = sample_points(6);
+    std::vector<math::Float3> out(4, math::Float3{-1.0f, -1.0f, -1.0f});
+    EXPECT_EQ(math::transform_points(math::identity(), in, std::span<math::Float3>(out).first(3)), 3u);
+    EXPECT_EQ(out[2], in[2]);
+    EXPECT_EQ(out[3], (math::Float3{-1.0f, -1.0f, -1.0f}));
+}
@@ -5,12 +5,14 @@
 #include <chrono>
 #include <atomic>
 #include <array>
+#include <cstddef>
 #include <span>
 #include <windows.h>
 
 #include "DetourModKit/memory.hpp"
 #include "DetourModKit/error.hpp"
 #include "DetourModKit/region.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/address.hpp"
 
 // White-box engine seams for the vectored-handler / fault-isolation tests.
@@ -365,6 +367,255 @@ TEST_F(MemoryTest, InvalidateRangeEvictsMultiPageRegionInterior)
     VirtualFree(region, 0, MEM_RELEASE);
 }
 
+TEST_F(MemoryTest, AdaptiveCacheGrowsItsCapacityUnderEvictionChurn)
+{
+    memory::shutdown_cache();
+    ASSERT_TRUE(memory::init_cache(memory::CacheOptions{.cache_size = 4,
+                                                        .expiry_ms = 60000,
+                                                        .shard_count = 1,
+                                                        .adaptive = true,
+                                                        .max_cache_size = 64}));
+    const memory::MemoryStats start = memory::get_memory_stats();
+    EXPECT_TRUE(start.adaptive);
+    EXPECT_EQ(start.shard_count, 1u);
+    EXPECT_EQ(start.max_entries_per_shard, 4u);
+
+    // Sixteen times more distinct regions than the cache holds: every pass misses and evicts on nearly each region.
+    // Invalidating an unrelated page retires the lock-free snapshots, so each pass reaches the shard again.
+    std::vector<void *> regions;
+    for (int i = 0; i < 64; ++i)
+    {
+        regions.push_back(VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+        ASSERT_NE(regions.back(), nullptr);
+    }
+    char unrelated = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    memory::MemoryStats stats = start;
+    while (stats.capacity_growths == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        for (void *region : regions)
+        {
+            EXPECT_TRUE(is_readable(region, 64));
+        }
+        invalidate_range(&unrelated, 1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        stats = memory::get_memory_stats();
+    }
+    EXPECT_GT(stats.capacity_evictions, 0u);
+    EXPECT_GT(stats.capacity_growths, 0u);
+    EXPECT_GT(stats.max_entries_per_shard, 4u);
+    EXPECT_LE(stats.shard_count * stats.max_entries_per_shard, 64u);
+    EXPECT_NE(memory::get_cache_stats().find("Adaptive: yes"), std::string::npos);
+
+    for (void *region : regions)
+    {
+        VirtualFree(region, 0, MEM_RELEASE);
+    }
+}
+
+TEST_F(MemoryTest, FixedCacheKeepsItsConfiguration)
+{
+    const memory::MemoryStats stats = memory::get_memory_stats();
+    EXPECT_FALSE(stats.adaptive);
+    EXPECT_EQ(stats.shard_count, memory::DEFAULT_CACHE_SHARD_COUNT);
+    EXPECT_EQ(stats.shard_growths + stats.capacity_growths, 0u);
+}
+
+TEST_F(MemoryTest, NegativeTableAnswersRepeatedStalePointerChecks)
+{
+    memory::shutdown_cache();
+    ASSERT_TRUE(memory::init_cache(memory::CacheOptions{.cache_size = 16,
+                                                        .expiry_ms = 60000,
+                                                        .shard_count = 4,
+                                                        .negative_expiry_ms = 60000}));
+    EXPECT_EQ(memory::get_memory_stats().negative_expiry_ms, 60000u);
+
+    auto *reserved = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, 2 * 4096, MEM_RESERVE, PAGE_NOACCESS));
+    ASSERT_NE(reserved, nullptr);
+
+    // The first check queries the OS; every later one inside the reserved range is a negative-table hit, on any page.
+    EXPECT_FALSE(is_readable(reserved + 8, 8));
+    EXPECT_FALSE(is_readable(reserved + 4096 + 64, 8));
+    EXPECT_FALSE(is_writable(reserved + 16, 8));
+    EXPECT_EQ(is_readable_nonblocking(reserved + 32, 8), memory::ReadableStatus::NotReadable);
+    const memory::MemoryStats stats = memory::get_memory_stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.negative_hits, 3u);
+    EXPECT_EQ(stats.total_entries, 0u);
+
+    // Committing the range and invalidating it, as every DMK allocation and write does, retires the negative entry.
+    ASSERT_NE(VirtualAlloc(reserved, 4096, MEM_COMMIT, PAGE_READWRITE), nullptr);
+    invalidate_range(reserved, 4096);
+    EXPECT_TRUE(is_readable(reserved + 8, 8));
+
+    // An address past the user address space is refused without a query.
+    const std::uint64_t misses = memory::get_memory_stats().misses;
+    EXPECT_FALSE(memory::is_readable(Region{Address{memory::USERSPACE_PTR_MAX + 0x1000}, 8}));
+    EXPECT_EQ(memory::get_memory_stats().misses, misses);
+
+    VirtualFree(reserved, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, NegativeEntriesExpireSoonerThanTheShards)
+{
+    memory::shutdown_cache();
+    ASSERT_TRUE(memory::init_cache(memory::CacheOptions{.cache_size = 16,
+                                                        .expiry_ms = 60000,
+                                                        .shard_count = 4,
+                                                        .negative_expiry_ms = 5}));
+
+    auto *reserved = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, 4096, MEM_RESERVE, PAGE_NOACCESS));
+    ASSERT_NE(reserved, nullptr);
+    EXPECT_FALSE(is_readable(reserved, 8));
+
+    // A commit DMK never sees is picked up once the short negative expiry lapses.
+    ASSERT_NE(VirtualAlloc(reserved, 4096, MEM_COMMIT, PAGE_READWRITE), nullptr);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_TRUE(is_readable(reserved, 8));
+
+    VirtualFree(reserved, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, FastTableHitsCountAndNeverOutliveAnInvalidation)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 60000, 4);
+
+    void *page = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(page, nullptr);
+
+    // One miss publishes the region; every repeat is then a hit, whether the lock-free table or the shard serves it.
+    for (int i = 0; i < 10; ++i)
+    {
+        EXPECT_TRUE(is_readable(page, 64));
+        EXPECT_TRUE(is_writable(page, 64));
+    }
+    const memory::MemoryStats warm = memory::get_memory_stats();
+    EXPECT_EQ(warm.misses, 1u);
+    EXPECT_EQ(warm.hits, 19u);
+    EXPECT_EQ(is_readable_nonblocking(page, 64), memory::ReadableStatus::Readable);
+
+    // The table must not keep serving the warm verdict once the range is re-protected and invalidated.
+    DWORD old_protect = 0;
+    ASSERT_NE(VirtualProtect(page, 4096, PAGE_NOACCESS, &old_protect), 0);
+    invalidate_range(page, 64);
+    EXPECT_FALSE(is_readable(page, 64));
+    EXPECT_FALSE(is_readable(page, 64));
+
+    // clear_cache zeroes the fast-table tallies along with the shard counters.
+    memory::clear_cache();
+    const memory::MemoryStats cleared = memory::get_memory_stats();
+    EXPECT_EQ(cleared.hits + cleared.misses, 0u);
+
+    VirtualProtect(page, 4096, old_protect, &old_protect);
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, ThreadL0AnswersEveryPageOfAValidatedRegion)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 60000, 4);
+
+    // One 16-page committed region with a reserved page after it: the first check caches the region whole, and every
+    // later page of it should be answered from this thread's L0 without a second VirtualQuery, even though the pages
+    // hash to different shards and fast-table slots.
+    constexpr std::size_t region_size = 16 * 4096;
+    void *region = VirtualAlloc(nullptr, region_size + 4096, MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(region, nullptr);
+    ASSERT_NE(VirtualAlloc(region, region_size, MEM_COMMIT, PAGE_READWRITE), nullptr);
+    auto *base = static_cast<uint8_t *>(region);
+
+    for (std::size_t page = 0; page < 16; ++page)
+    {
+        EXPECT_TRUE(is_readable(base + page * 4096 + 8, 32));
+    }
+    const memory::MemoryStats stats = memory::get_memory_stats();
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.hits, 15u);
+
+    // A range running into the reserved tail is never answered from a snapshot of the region alone.
+    EXPECT_FALSE(is_readable(base + region_size - 16, 32));
+
+    VirtualFree(region, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, ReadableBatchMatchesPerCallVerdicts)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 60000, 4);
+
+    constexpr std::size_t region_size = 16 * 4096;
+    void *heap = VirtualAlloc(nullptr, region_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    void *reserved = VirtualAlloc(nullptr, 4096, MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(heap, nullptr);
+    ASSERT_NE(reserved, nullptr);
+    auto *base = static_cast<uint8_t *>(heap);
+
+    // Many pointers into one region, interleaved with a null, a reserved page, and a span running off the end.
+    std::vector<Address> addresses;
+    for (std::size_t i = 0; i < 64; ++i)
+    {
+        addresses.emplace_back(base + (i * 977) % (region_size - 32));
+    }
+    addresses.emplace_back(std::uintptr_t{0});
+    addresses.emplace_back(reserved);
+    addresses.emplace_back(base + region_size - 8);
+
+    std::vector<std::uint8_t> out(addresses.size(), 0xFF);
+    const Result<std::size_t> readable = memory::is_readable_batch(addresses, 32, out);
+    ASSERT_TRUE(readable.has_value());
+    EXPECT_EQ(*readable, 64u);
+    for (std::size_t i = 0; i < addresses.size(); ++i)
+    {
+        EXPECT_EQ(out[i] != 0, memory::is_readable(Region{addresses[i], 32})) << "address #" << i;
+    }
+
+    VirtualFree(reserved, 0, MEM_RELEASE);
+    VirtualFree(heap, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, ReadableBatchResolvesARegionOnceAndRejectsAShortOutput)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 60000, 4);
+
+    char buffer[256] = {0};
+    std::array<Address, 8> addresses{};
+    for (std::size_t i = 0; i < addresses.size(); ++i)
+    {
+        addresses[i] = Address{buffer + i * 16};
+    }
+    std::array<std::uint8_t, 8> out{};
+    ASSERT_TRUE(memory::is_readable_batch(addresses, 16, out).has_value());
+    const memory::MemoryStats stats = memory::get_memory_stats();
+    EXPECT_EQ(stats.hits + stats.misses, 1u);
+
+    std::array<std::uint8_t, 7> short_out{};
+    const Result<std::size_t> rejected = memory::is_readable_batch(addresses, 16, short_out);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidArg);
+
+    // A zero-byte check is never readable, matching an empty is_readable range.
+    out.fill(1);
+    const Result<std::size_t> empty = memory::is_readable_batch(addresses, 0, out);
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(*empty, 0u);
+    EXPECT_EQ(out[0], 0u);
+}
+
+TEST_F(MemoryTest, ReadableBatchWithoutCacheQueriesEachRegionDirectly)
+{
+    memory::shutdown_cache();
+
+    char buffer[64] = {0};
+    const std::array<Address, 3> addresses = {Address{buffer}, Address{buffer + 32}, Address{std::uintptr_t{0}}};
+    std::array<std::uint8_t, 3> out{};
+    const Result<std::size_t> readable = memory::is_readable_batch(addresses, 16, out);
+    ASSERT_TRUE(readable.has_value());
+    EXPECT_EQ(*readable, 2u);
+    EXPECT_EQ(out[2], 0u);
+}
+
 TEST_F(MemoryTest, CacheClearStressTest)
 {
     char buffer[100] = {0};
@@ -1126,7 +1377,7 @@ TEST_F(MemoryTest, BackgroundCleanupThreadRuns)
     char buffer[100] = {0};
     EXPECT_TRUE(is_readable(buffer, sizeof(buffer)));
 
-    // Background cleanup thread runs every 1 second; sleep long enough for at least one pass
+    // The cleanup task runs every 1 second; sleep long enough for at least one pass
     std::this_thread::sleep_for(std::chrono::milliseconds(1200));
 
     // Cache should still work after background cleanup has run
@@ -1221,6 +1472,111 @@ TEST_F(MemoryTest, ExpiredEntryTriggersReFetch)
     EXPECT_GE(misses, prev_misses + 1u);
 }
 
+TEST_F(MemoryTest, ImageCodeRegionOutlivesTheExpiryWhileHeapRegionsDoNot)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 10, 4);
+
+    const void *code = reinterpret_cast<const void *>(&memory::module_of);
+    void *heap = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(heap, nullptr);
+
+    EXPECT_TRUE(is_readable(code, 16));
+    EXPECT_TRUE(is_readable(heap, 16));
+    const memory::MemoryStats warm = memory::get_memory_stats();
+    EXPECT_GE(warm.pinned_entries, 1u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+    // The code page is answered from its pinned entry; the heap page re-queries.
+    EXPECT_TRUE(is_readable(code, 16));
+    const memory::MemoryStats after_code = memory::get_memory_stats();
+    EXPECT_EQ(after_code.misses, warm.misses);
+    EXPECT_GE(after_code.pinned_hits, warm.pinned_hits + 1u);
+
+    EXPECT_TRUE(is_readable(heap, 16));
+    EXPECT_EQ(memory::get_memory_stats().misses, warm.misses + 1u);
+
+    VirtualFree(heap, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, InvalidateRangeUnpinsImageRegions)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(16, 10, 4);
+
+    const void *code = reinterpret_cast<const void *>(&memory::module_of);
+    EXPECT_TRUE(is_readable(code, 16));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_TRUE(is_readable(code, 16));
+    const std::uint64_t pinned_misses = memory::get_memory_stats().misses;
+
+    // After an invalidation the old entry falls back to the expiry, so the next check goes to the OS and re-pins.
+    invalidate_range(code, 16);
+    EXPECT_TRUE(is_readable(code, 16));
+    const memory::MemoryStats requeried = memory::get_memory_stats();
+    EXPECT_EQ(requeried.misses, pinned_misses + 1u);
+    EXPECT_GE(requeried.pinned_entries, 1u);
+
+    memory::clear_cache();
+    const memory::MemoryStats cleared = memory::get_memory_stats();
+    EXPECT_EQ(cleared.pinned_entries, 0u);
+    EXPECT_EQ(cleared.pinned_hits, 0u);
+    EXPECT_EQ(cleared.expired_entries, 0u);
+}
+
+TEST_F(MemoryTest, Prewarm_CachesEveryRegionOfARangeSoFirstChecksHit)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(64, 60000, 4);
+
+    // Three pages whose middle one is re-protected: three VirtualQuery regions.
+    constexpr std::size_t page = 4096;
+    auto *mem = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, 3 * page, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(mem, nullptr);
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(mem + page, page, PAGE_READONLY, &old_protect));
+
+    const Result<std::size_t> warmed = memory::prewarm(Region{Address{mem}, 3 * page});
+    ASSERT_TRUE(warmed.has_value());
+    EXPECT_EQ(*warmed, 3u);
+
+    const std::uint64_t misses = memory::get_memory_stats().misses;
+    EXPECT_TRUE(is_readable(mem + 0x10, 8));
+    EXPECT_TRUE(is_readable(mem + page + 0x200, 8));
+    EXPECT_FALSE(is_writable(mem + page + 0x300, 8));
+    EXPECT_TRUE(is_writable(mem + 2 * page + 0x20, 8));
+    EXPECT_EQ(memory::get_memory_stats().misses, misses);
+
+    VirtualFree(mem, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, Prewarm_WarmsAModuleAndASetAndIsANoOpWhileTheCacheIsDown)
+{
+    memory::shutdown_cache();
+    (void)memory::init_cache(256, 60000, 4);
+
+    const Region host = memory::module_of(Address{reinterpret_cast<const void *>(&memory::module_of)});
+    ASSERT_NE(host.size, 0u);
+    const std::array<Region, 1> spans = {host};
+    const Result<RegionSet> set = RegionSet::of(spans);
+    ASSERT_TRUE(set.has_value());
+    EXPECT_GE(memory::prewarm(*set), 1u);
+
+    const std::uint64_t misses = memory::get_memory_stats().misses;
+    EXPECT_TRUE(is_readable(reinterpret_cast<const void *>(&memory::module_of), 16));
+    EXPECT_EQ(memory::get_memory_stats().misses, misses);
+
+    const Result<std::size_t> wrapped = memory::prewarm(Region{Address{UINTPTR_MAX - 0xFF}, 0x200});
+    ASSERT_FALSE(wrapped.has_value());
+    EXPECT_EQ(wrapped.error().code, ErrorCode::InvalidRange);
+
+    memory::shutdown_cache();
+    const Result<std::size_t> idle = memory::prewarm(host);
+    ASSERT_TRUE(idle.has_value());
+    EXPECT_EQ(*idle, 0u);
+}
+
 TEST_F(MemoryTest, CacheHitPerformance_SingleThread)
 {
     memory::shutdown_cache();
@@ -2178,6 +2534,45 @@ TEST_F(MemoryTest, SehReadBytes_LargeRangePartialUnmapped)
     VirtualFree(mem, 0, MEM_RELEASE);
 }
 
+// Small reads against the end of a readable page, followed by a no-access page: every read that stays on the readable
+// page copies exactly, and every read that crosses into the no-access page fails, whether the fault lands on a qword
+// or a byte load of the copy. Then a small read on a guard page fails and leaves the guard armed. On MinGW these sizes
+// take the landing-pad copy rather than the longjmp path.
+TEST_F(MemoryTest, SehReadBytes_SmallReadsAtAPageBoundary)
+{
+    const SIZE_T page_size = 4096;
+    auto *base = static_cast<uint8_t *>(VirtualAlloc(nullptr, 2 * page_size, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(base, nullptr);
+    for (SIZE_T i = 0; i < page_size; ++i)
+        base[i] = static_cast<uint8_t>(i * 7 + 1);
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(base + page_size, page_size, PAGE_NOACCESS, &old_protect));
+
+    std::array<uint8_t, 64> buf{};
+    for (std::size_t size = 1; size <= buf.size(); ++size)
+    {
+        for (std::size_t tail = 0; tail < size + 8; ++tail)
+        {
+            const uintptr_t addr = reinterpret_cast<uintptr_t>(base) + page_size - size + tail;
+            const bool ok = read_bytes(addr, buf.data(), size);
+            ASSERT_EQ(ok, tail == 0) << "size " << size << " tail " << tail;
+            if (ok)
+            {
+                EXPECT_EQ(std::memcmp(buf.data(), base + page_size - size, size), 0);
+            }
+        }
+    }
+
+    ASSERT_TRUE(VirtualProtect(base, page_size, PAGE_READWRITE | PAGE_GUARD, &old_protect));
+    uint32_t out = 0;
+    EXPECT_FALSE(read_bytes(reinterpret_cast<uintptr_t>(base), &out, sizeof(out)));
+    MEMORY_BASIC_INFORMATION mbi{};
+    ASSERT_NE(VirtualQuery(base, &mbi, sizeof(mbi)), 0u);
+    EXPECT_NE(mbi.Protect & PAGE_GUARD, 0u);
+
+    VirtualFree(base, 0, MEM_RELEASE);
+}
+
 // read<T>
 
 TEST_F(MemoryTest, SehRead_Uintptr)
@@ -2239,6 +2634,41 @@ TEST_F(MemoryTest, SehRead_FreedMemoryReturnsNullopt)
 
 // Region / module_of / Region::own / Region::host
 
+TEST_F(MemoryTest, ReadMany_FaultFailsOnlyItsOwnDescriptor)
+{
+    const uint64_t first = 0x1111111111111111ULL;
+    const uint32_t last = 0x22222222u;
+    void *no_access = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(no_access, nullptr);
+
+    uint64_t out_first = 0;
+    uint64_t out_fault = 0;
+    uint32_t out_low = 0;
+    uint32_t out_last = 0;
+    const std::array<memory::ReadDescriptor, 5> reads = {
+        memory::ReadDescriptor{Address{&first}, std::as_writable_bytes(std::span{&out_first, 1})},
+        memory::ReadDescriptor{Address{no_access}, std::as_writable_bytes(std::span{&out_fault, 1})},
+        memory::ReadDescriptor{Address{std::uintptr_t{0x100}}, std::as_writable_bytes(std::span{&out_low, 1})},
+        memory::ReadDescriptor{Address{&first}, {}},
+        memory::ReadDescriptor{Address{&last}, std::as_writable_bytes(std::span{&out_last, 1})},
+    };
+    std::array<std::uint8_t, 5> ok{};
+    const Result<std::size_t> copied = memory::read_many(reads, ok);
+    ASSERT_TRUE(copied.has_value());
+    EXPECT_EQ(*copied, 3u);
+    EXPECT_EQ(ok, (std::array<std::uint8_t, 5>{1, 0, 0, 1, 1}));
+    EXPECT_EQ(out_first, first);
+    // The reads after the faulting one still copy: the guard is re-entered past the fault.
+    EXPECT_EQ(out_last, last);
+
+    std::array<std::uint8_t, 4> short_ok{};
+    const Result<std::size_t> rejected = memory::read_many(reads, short_ok);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidArg);
+
+    VirtualFree(no_access, 0, MEM_RELEASE);
+}
+
 TEST_F(MemoryTest, ModuleRange_DefaultIsInvalid)
 {
     Region range;
@@ -2366,6 +2796,53 @@ TEST_F(MemoryTest, ModuleRangeFor_KernelModuleResolves)
     EXPECT_EQ(range.base.raw(), reinterpret_cast<uintptr_t>(kernel));
 }
 
+TEST_F(MemoryTest, IsInModule_MatchesOnlyTheOwningImage)
+{
+    const Address host_base{reinterpret_cast<void *>(GetModuleHandleW(nullptr))};
+    HMODULE kernel = GetModuleHandleW(L"kernel32.dll");
+    ASSERT_NE(kernel, nullptr);
+    const Address host_code{reinterpret_cast<const void *>(&memory::module_of)};
+    const Address kernel_code{reinterpret_cast<void *>(GetProcAddress(kernel, "GetTickCount"))};
+    auto heap = std::make_unique<int>(7);
+
+    // Answered from the loaded-module table while the cache runs, and from the loader after shutdown: same verdicts.
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        EXPECT_TRUE(memory::is_in_module(host_code, host_base));
+        EXPECT_FALSE(memory::is_in_module(kernel_code, host_base));
+        EXPECT_TRUE(memory::is_in_module(kernel_code, Address{reinterpret_cast<void *>(kernel)}));
+        EXPECT_FALSE(memory::is_in_module(Address{heap.get()}, host_base));
+        EXPECT_FALSE(memory::is_in_module(Address{nullptr}, host_base));
+        EXPECT_FALSE(memory::is_in_module(host_code, Address{nullptr}));
+        memory::shutdown_cache();
+    }
+}
+
+TEST_F(MemoryTest, ModuleTable_FollowsALibraryLoadedAndUnloadedAfterInit)
+{
+    // A system DLL a test process has no reason to load; skip rather than assert if something already pulled it in.
+    if (GetModuleHandleW(L"mscms.dll") != nullptr)
+    {
+        GTEST_SKIP() << "mscms.dll is already loaded";
+    }
+    HMODULE module = LoadLibraryW(L"mscms.dll");
+    if (module == nullptr)
+    {
+        GTEST_SKIP() << "mscms.dll is unavailable";
+    }
+    const Address base{reinterpret_cast<void *>(module)};
+    const Region loaded = memory::module_of(base.offset(0x100));
+    EXPECT_EQ(loaded.base, base);
+    EXPECT_NE(loaded.size, 0u);
+
+    ASSERT_TRUE(FreeLibrary(module));
+    if (GetModuleHandleW(L"mscms.dll") == nullptr)
+    {
+        // The unload notification dropped the span, so the former base is no longer attributed to any image.
+        EXPECT_EQ(memory::module_of(base.offset(0x100)).size, 0u);
+    }
+}
+
 // Every SEH-guarded foreign read must swallow EXCEPTION_IN_PAGE_ERROR (a file-backed page failing to page in) alongside
 // the access-violation and guard-page faults, or the fault continues the handler search and terminates the host. The
 // __except filters in the memory engine and the region/window guards in the scan engine share this single predicate, so
@@ -3022,7 +3499,7 @@ TEST_F(MemoryTest, UncheckedRead_HappyPathOnKnownLocal)
 // (c) Region::own() is valid and contains a DMK function; module_of an in-image address returns a region containing it.
 TEST_F(MemoryTest, RegionOwn_ContainsDmkFunctionAndModuleOfAgrees)
 {
-    const Address fn{reinterpret_cast<const void *>(&memory::init_cache)};
+    const Address fn{reinterpret_cast<const void *>(&memory::shutdown_cache)};
 
     const Region own = Region::own();
     ASSERT_NE(own.size, 0u);
@@ -3386,15 +3863,15 @@ TEST_F(MemoryTest, GuardedRead_GuardPageRearmedFailsClosedOnRetry)
     VirtualFree(mem, 0, MEM_RELEASE);
 }
 
-// Several threads racing shutdown_cache must not both join the same cleanup std::thread (a std::system_error out of a
-// noexcept function -> std::terminate). The join mutex lets exactly one caller join; the rest skip.
+// Several threads racing shutdown_cache must cancel the cleanup task exactly once and none may deadlock on a cleanup
+// run in progress.
 TEST_F(MemoryTest, ShutdownCache_ConcurrentCallersJoinExactlyOnceNoTerminate)
 {
-    // Start from a known-initialized state so a background cleanup thread exists and the join/detach path is exercised.
+    // Start from a known-initialized state so the cleanup task is registered and the cancel path is exercised.
     memory::shutdown_cache();
     ASSERT_TRUE(memory::init_cache(32, 5000));
 
-    // Prime an entry so the cleanup thread has content and is definitely running.
+    // Prime an entry so a cleanup run has content.
     int probe = 0;
     (void)memory::is_readable(Region{Address{&probe}, sizeof(probe)});
 
@@ -3523,6 +4000,119 @@ TEST_F(MemoryTest, ProtectGuard_OverSegmentCapFailsClosedAndRollsBack)
     VirtualFree(base, 0, MEM_RELEASE);
 }
 
+TEST_F(MemoryTest, PatchBatch_AppliesAcrossMixedPagesAndRestoresEachProtection)
+{
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+    const std::size_t page = si.dwPageSize;
+    auto *base = static_cast<std::byte *>(VirtualAlloc(nullptr, 3 * page, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    ASSERT_NE(base, nullptr);
+    DWORD old = 0;
+    ASSERT_TRUE(VirtualProtect(base, page, PAGE_READONLY, &old));
+    ASSERT_TRUE(VirtualProtect(base + page, page, PAGE_EXECUTE_READ, &old));
+    ASSERT_TRUE(VirtualProtect(base + 2 * page, page, PAGE_READONLY, &old));
+
+    memory::PatchBatch batch;
+    const std::array<std::byte, 2> nops{std::byte{0x90}, std::byte{0x90}};
+    ASSERT_TRUE(batch.add(Address{base + 2 * page + 4}, std::uint32_t{0xDEADBEEFu}).has_value());
+    ASSERT_TRUE(batch.add(Address{base + 16}, std::span<const std::byte>{nops}).has_value());
+    ASSERT_TRUE(batch.add(Address{base + 2 * page - 1}, std::uint16_t{0xC3C3u}).has_value());
+    ASSERT_TRUE(batch.add(Address{base}, std::span<const std::byte>{}).has_value());
+    EXPECT_EQ(batch.size(), 3u);
+
+    ASSERT_TRUE(batch.apply().has_value());
+    EXPECT_EQ(base[16], std::byte{0x90});
+    EXPECT_EQ(base[17], std::byte{0x90});
+    EXPECT_EQ(base[2 * page - 1], std::byte{0xC3});
+    EXPECT_EQ(base[2 * page], std::byte{0xC3});
+    std::uint32_t value = 0;
+    std::memcpy(&value, base + 2 * page + 4, sizeof(value));
+    EXPECT_EQ(value, 0xDEADBEEFu);
+
+    // Each page got its own prior protection back; the executable page was not flattened to read-only.
+    EXPECT_EQ(current_page_protection(base), static_cast<DWORD>(PAGE_READONLY));
+    EXPECT_EQ(current_page_protection(base + page), static_cast<DWORD>(PAGE_EXECUTE_READ));
+    EXPECT_EQ(current_page_protection(base + 2 * page), static_cast<DWORD>(PAGE_READONLY));
+    EXPECT_FALSE(is_writable(base, 4));
+
+    VirtualFree(base, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, PatchBatch_OverlapIsRejectedBeforeAnyByteChanges)
+{
+    void *page = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READONLY);
+    ASSERT_NE(page, nullptr);
+    auto *bytes = static_cast<std::byte *>(page);
+
+    memory::PatchBatch batch;
+    ASSERT_TRUE(batch.add(Address{bytes + 8}, std::uint32_t{0x11111111u}).has_value());
+    ASSERT_TRUE(batch.add(Address{bytes}, std::uint64_t{0x2222222222222222ull}).has_value());
+    ASSERT_TRUE(batch.add(Address{bytes + 10}, std::uint8_t{0x33}).has_value());
+
+    const auto result = batch.apply();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(result.error().detail, reinterpret_cast<std::uintptr_t>(bytes + 10));
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        EXPECT_EQ(bytes[i], std::byte{0});
+    }
+    EXPECT_EQ(current_page_protection(page), static_cast<DWORD>(PAGE_READONLY));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(batch.apply().has_value());
+
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, PatchBatch_UnprotectableRunRollsBackTheWholeBatch)
+{
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+    const std::size_t page = si.dwPageSize;
+    // Page 0 is committed read-only; page 2 is only reserved, so VirtualProtect on it fails.
+    auto *base = static_cast<std::byte *>(VirtualAlloc(nullptr, 3 * page, MEM_RESERVE, PAGE_NOACCESS));
+    ASSERT_NE(base, nullptr);
+    ASSERT_NE(VirtualAlloc(base, page, MEM_COMMIT, PAGE_READONLY), nullptr);
+
+    memory::PatchBatch batch;
+    ASSERT_TRUE(batch.add(Address{base + 32}, std::uint32_t{0xC0FFEEu}).has_value());
+    ASSERT_TRUE(batch.add(Address{base + 2 * page}, std::uint32_t{0xC0FFEEu}).has_value());
+
+    const auto result = batch.apply();
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error().code, ErrorCode::ProtectionChangeFailed);
+    EXPECT_EQ(result.error().detail, reinterpret_cast<std::uintptr_t>(base + 2 * page));
+    std::uint32_t value = 1;
+    std::memcpy(&value, base + 32, sizeof(value));
+    EXPECT_EQ(value, 0u);
+    EXPECT_EQ(current_page_protection(base), static_cast<DWORD>(PAGE_READONLY));
+
+    VirtualFree(base, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, PatchBatch_AddValidatesLikeWriteBytes)
+{
+    std::uint32_t target = 0;
+    const std::byte source[4]{};
+    memory::PatchBatch batch;
+
+    const auto null_target = batch.add(Address{nullptr}, std::span<const std::byte>{source});
+    ASSERT_FALSE(null_target.has_value());
+    EXPECT_EQ(null_target.error().code, ErrorCode::NullTargetAddress);
+
+    const auto null_source =
+        batch.add(Address{&target}, std::span<const std::byte>{static_cast<const std::byte *>(nullptr), 1});
+    ASSERT_FALSE(null_source.has_value());
+    EXPECT_EQ(null_source.error().code, ErrorCode::NullSourceBytes);
+
+    const auto too_large = batch.add(Address{&target}, std::span<const std::byte>{source, memory::MAX_WRITE_SIZE + 1});
+    ASSERT_FALSE(too_large.has_value());
+    EXPECT_EQ(too_large.error().code, ErrorCode::SizeTooLarge);
+    EXPECT_TRUE(batch.empty());
+}
+
 // A bad_alloc anywhere in a cache-miss insert (the unordered_map node, the lru map node, or the sorted-range deque
 // chunk) must fail SOFT: update_shard_with_region catches it and is_readable still returns the authoritative
 // VirtualQuery answer, never terminating. This drives the failure across each successive insert allocation, so one
@@ -3556,3 +4146,136 @@ TEST_F(MemoryTest, IsReadable_CacheInsertAllocFailureFailsSoftAtEveryStage)
         EXPECT_TRUE(readable) << "allow=" << allow;
     }
 }
+
+TEST_F(MemoryTest, StridedView_SweepsOneFieldAcrossEntities)
+{
+    struct Entity
+    {
+        std::uint64_t id;
+        float health;
+        std::byte pad[52];
+    };
+    // More entities than one block holds, so the sweep refills and prefetches across block boundaries.
+    std::vector<Entity> entities(150);
+    for (std::size_t i = 0; i < entities.size(); ++i)
+    {
+        entities[i].id = i;
+        entities[i].health = static_cast<float>(i) * 0.5f;
+    }
+
+    const memory::StridedView<float> health(Address{&entities[0].health}, entities.size(), sizeof(Entity));
+    std::size_t visited = 0;
+    for (const memory::ViewElement<float> element : health)
+    {
+        ASSERT_TRUE(element);
+        EXPECT_EQ(element.index, visited);
+        EXPECT_EQ(element.address, Address{&entities[visited].health});
+        EXPECT_EQ(*element.value, entities[visited].health);
+        ++visited;
+    }
+    EXPECT_EQ(visited, entities.size());
+
+    const Result<float> last = health.read(149);
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(*last, entities[149].health);
+    const Result<float> past_end = health.read(150);
+    ASSERT_FALSE(past_end.has_value());
+    EXPECT_EQ(past_end.error().code, ErrorCode::InvalidArg);
+}
+
+TEST_F(MemoryTest, StridedView_FaultedElementIsNullAndSweepContinues)
+{
+    auto *pages = static_cast<std::byte *>(VirtualAlloc(nullptr, 8192, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(pages, nullptr);
+    for (std::size_t i = 0; i < 4; ++i)
+    {
+        const std::uint64_t value = 0xA0 + i;
+        std::memcpy(pages + i * 1024, &value, sizeof(value));
+    }
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(pages + 4096, 4096, PAGE_NOACCESS, &old_protect));
+
+    const memory::StridedView<std::uint64_t> view(Address{pages}, 8, 1024);
+    std::size_t readable = 0;
+    std::size_t faulted = 0;
+    for (const memory::ViewElement<std::uint64_t> element : view)
+    {
+        if (element)
+        {
+            EXPECT_EQ(*element.value, 0xA0 + element.index);
+            ++readable;
+        }
+        else
+        {
+            EXPECT_GE(element.index, 4u);
+            ++faulted;
+        }
+    }
+    EXPECT_EQ(readable, 4u);
+    EXPECT_EQ(faulted, 4u);
+
+    std::array<std::uint64_t, 3> block{};
+    std::array<std::uint8_t, 3> ok{};
+    const Result<std::size_t> copied = view.read_block(2, block, ok);
+    ASSERT_TRUE(copied.has_value());
+    EXPECT_EQ(*copied, 2u);
+    EXPECT_EQ(ok, (std::array<std::uint8_t, 3>{1, 1, 0}));
+    EXPECT_EQ(block[1], 0xA3u);
+    EXPECT_FALSE(view.read_block(6, block, ok).has_value());
+
+    VirtualFree(pages, 0, MEM_RELEASE);
+}
+
+TEST_F(MemoryTest, PointerArrayView_ReadsThroughSlotsAndSkipsBadPointers)
+{
+    struct Actor
+    {
+        std::uint64_t vtable;
+        std::uint32_t team;
+    };
+    void *no_access = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(no_access, nullptr);
+
+    // 100 slots span two blocks of the uint32_t view; slot 5 is null and slot 70 points at a no-access page.
+    std::vector<Actor> actors(100);
+    std::vector<Actor *> slots(actors.size());
+    for (std::size_t i = 0; i < actors.size(); ++i)
+    {
+        actors[i].team = static_cast<std::uint32_t>(i % 3);
+        slots[i] = &actors[i];
+    }
+    slots[5] = nullptr;
+    slots[70] = static_cast<Actor *>(no_access);
+
+    const memory::PointerArrayView<std::uint32_t> teams(Address{slots.data()}, slots.size(), offsetof(Actor, team));
+    std::size_t visited = 0;
+    for (const memory::ViewElement<std::uint32_t> element : teams)
+    {
+        EXPECT_EQ(element.index, visited);
+        EXPECT_EQ(element.address, Address{slots[visited]});
+        if (visited == 5 || visited == 70)
+        {
+            EXPECT_FALSE(element);
+        }
+        else
+        {
+            ASSERT_TRUE(element);
+            EXPECT_EQ(*element.value, actors[visited].team);
+        }
+        ++visited;
+    }
+    EXPECT_EQ(visited, slots.size());
+
+    const Result<std::uint32_t> one = teams.read(7);
+    ASSERT_TRUE(one.has_value());
+    EXPECT_EQ(*one, actors[7].team);
+    EXPECT_FALSE(teams.read(70).has_value());
+    EXPECT_FALSE(teams.pointer_at(100).has_value());
+
+    // Prefetch is a hint: null, low and no-access addresses are harmless.
+    const std::array<Address, 3> bad = {Address{}, Address{std::uintptr_t{0x100}}, Address{no_access}};
+    memory::prefetch(bad, 8);
+    memory::prefetch_strided(Address{no_access}, 64, 16);
+
+    VirtualFree(no_access, 0, MEM_RELEASE);
+}
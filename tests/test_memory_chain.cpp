@@ -421,3 +421,187 @@ TEST(MemoryWalk, PerHopMinValidFloorStopsLowLink)
     EXPECT_EQ(addr.error().code, ErrorCode::ReadFaulted);
     EXPECT_EQ(addr.error().detail, static_cast<uintptr_t>(0));
 }
+
+namespace
+{
+    // A four-step chain over in-process cells: root -> manager -> object -> field. The first two dereferences are the
+    // stable prefix a CompiledChain memoizes; the object's link and the field offset are the volatile tail.
+    struct ChainFixture
+    {
+        std::uint64_t leaf_a[2]{0, 0};
+        std::uint64_t leaf_b[2]{0, 0};
+        std::uintptr_t object_a = reinterpret_cast<std::uintptr_t>(&leaf_a);
+        std::uintptr_t object_b = reinterpret_cast<std::uintptr_t>(&leaf_b);
+        std::uintptr_t manager = reinterpret_cast<std::uintptr_t>(&object_a);
+        std::uintptr_t root = reinterpret_cast<std::uintptr_t>(&manager);
+
+        std::array<memory::ChainStep, 4> steps{memory::ChainStep{0}, memory::ChainStep{0}, memory::ChainStep{0},
+                                               memory::ChainStep{8}};
+
+        [[nodiscard]] Address base() const noexcept { return Address{reinterpret_cast<std::uintptr_t>(&root)}; }
+        [[nodiscard]] std::uintptr_t field_a() const noexcept { return reinterpret_cast<std::uintptr_t>(&leaf_a[1]); }
+        [[nodiscard]] std::uintptr_t field_b() const noexcept { return reinterpret_cast<std::uintptr_t>(&leaf_b[1]); }
+    };
+} // namespace
+
+TEST(MemoryWalkMany, MatchesWalkForEveryRootAcrossGroups)
+{
+    // More roots than one group, so the walk crosses a group boundary. Every third root's first link is null and
+    // fails at hop 0; root 5 is null itself.
+    constexpr std::size_t roots = memory::WALK_MANY_GROUP * 2 + 3;
+    std::array<std::uint64_t, roots> leaves{};
+    std::array<std::uintptr_t, roots> mids{};
+    std::array<std::uintptr_t, roots> heads{};
+    std::array<Address, roots> bases{};
+    for (std::size_t i = 0; i < roots; ++i)
+    {
+        mids[i] = reinterpret_cast<std::uintptr_t>(&leaves[i]);
+        heads[i] = i % 3 == 2 ? 0 : reinterpret_cast<std::uintptr_t>(&mids[i]) - 0x8;
+        bases[i] = Address{reinterpret_cast<std::uintptr_t>(&heads[i])};
+    }
+    bases[5] = Address{};
+
+    const std::array<memory::ChainStep, 3> steps{memory::ChainStep{0}, memory::ChainStep{0x8}, memory::ChainStep{0x4}};
+    std::array<Result<Address>, roots> out{};
+    const auto resolved = memory::walk_many(bases, steps, out);
+    ASSERT_TRUE(resolved.has_value());
+
+    std::size_t expected_resolved = 0;
+    for (std::size_t i = 0; i < roots; ++i)
+    {
+        const auto serial = memory::walk(bases[i], steps);
+        ASSERT_EQ(out[i].has_value(), serial.has_value()) << "root " << i;
+        if (serial.has_value())
+        {
+            ++expected_resolved;
+            EXPECT_EQ(out[i]->raw(), reinterpret_cast<std::uintptr_t>(&leaves[i]) + 0x4);
+        }
+        else
+        {
+            EXPECT_EQ(out[i].error().code, serial.error().code) << "root " << i;
+            EXPECT_EQ(out[i].error().detail, serial.error().detail) << "root " << i;
+        }
+    }
+    EXPECT_EQ(*resolved, expected_resolved);
+    EXPECT_EQ(out[5].error().code, ErrorCode::NullChain);
+    EXPECT_EQ(out[2].error().code, ErrorCode::ReadFaulted);
+}
+
+TEST(MemoryWalkMany, EmptyChainReturnsEveryBaseAndShortOutputIsRejected)
+{
+    int x = 0;
+    const std::array<Address, 2> bases{Address{reinterpret_cast<std::uintptr_t>(&x)}, Address{}};
+    std::array<Result<Address>, 2> out{};
+    const auto resolved = memory::walk_many(bases, std::span<const memory::ChainStep>{}, out);
+    ASSERT_TRUE(resolved.has_value());
+    EXPECT_EQ(*resolved, 2u);
+    EXPECT_EQ(out[0]->raw(), reinterpret_cast<std::uintptr_t>(&x));
+    EXPECT_EQ(out[1]->raw(), 0u);
+
+    const auto rejected = memory::walk_many(bases, std::span<const memory::ChainStep>{}, std::span(out).first(1));
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidArg);
+}
+
+TEST(MemoryCompiledChain, MatchesWalkAndReportsTheFullTrace)
+{
+    ChainFixture f;
+    Result<memory::CompiledChain> chain = memory::CompiledChain::make(f.base(), f.steps, 2);
+    ASSERT_TRUE(chain.has_value());
+    EXPECT_FALSE(chain->memoized());
+
+    std::array<Address, 4> trace{};
+    const auto addr = chain->walk(trace);
+    ASSERT_TRUE(addr.has_value());
+    EXPECT_TRUE(chain->memoized());
+    EXPECT_EQ(addr->raw(), f.field_a());
+    EXPECT_EQ(addr->raw(), memory::walk(f.base(), f.steps)->raw());
+    EXPECT_EQ(trace[0].raw(), reinterpret_cast<std::uintptr_t>(&f.manager));
+    EXPECT_EQ(trace[1].raw(), reinterpret_cast<std::uintptr_t>(&f.object_a));
+    EXPECT_EQ(trace[2].raw(), reinterpret_cast<std::uintptr_t>(&f.leaf_a));
+    EXPECT_EQ(trace[3].raw(), f.field_a());
+}
+
+TEST(MemoryCompiledChain, StableHopsAreNotReReadUntilInvalidated)
+{
+    ChainFixture f;
+    Result<memory::CompiledChain> chain = memory::CompiledChain::make(f.base(), f.steps, 2, 60'000);
+    ASSERT_TRUE(chain.has_value());
+    ASSERT_EQ(chain->walk()->raw(), f.field_a());
+
+    // Re-pointing the memoized manager link is invisible while the memo is fresh; the volatile tail still is not.
+    f.manager = reinterpret_cast<std::uintptr_t>(&f.object_b);
+    EXPECT_EQ(chain->walk()->raw(), f.field_a());
+    f.object_a = reinterpret_cast<std::uintptr_t>(&f.leaf_b);
+    EXPECT_EQ(chain->walk()->raw(), f.field_b());
+
+    f.object_a = reinterpret_cast<std::uintptr_t>(&f.leaf_a);
+    chain->invalidate();
+    EXPECT_FALSE(chain->memoized());
+    EXPECT_EQ(chain->walk()->raw(), f.field_b());
+
+    // A zero interval re-reads the stable prefix on every call.
+    Result<memory::CompiledChain> eager = memory::CompiledChain::make(f.base(), f.steps, 2, 0);
+    ASSERT_TRUE(eager.has_value());
+    ASSERT_EQ(eager->walk()->raw(), f.field_b());
+    f.manager = reinterpret_cast<std::uintptr_t>(&f.object_a);
+    EXPECT_EQ(eager->walk()->raw(), f.field_a());
+}
+
+TEST(MemoryCompiledChain, InvalidateRangeRetiresTheMemoWhileTheCacheRuns)
+{
+    ASSERT_TRUE(memory::init_cache());
+    ChainFixture f;
+    Result<memory::CompiledChain> chain = memory::CompiledChain::make(f.base(), f.steps, 2, 60'000);
+    ASSERT_TRUE(chain.has_value());
+    ASSERT_EQ(chain->walk()->raw(), f.field_a());
+
+    f.manager = reinterpret_cast<std::uintptr_t>(&f.object_b);
+    EXPECT_EQ(chain->walk()->raw(), f.field_a());
+    memory::invalidate_range(Region{Address{reinterpret_cast<std::uintptr_t>(&f.manager)}, sizeof(f.manager)});
+    EXPECT_EQ(chain->walk()->raw(), f.field_b());
+    memory::shutdown_cache();
+}
+
+TEST(MemoryCompiledChain, TailFailureRefreshesTheMemoOnceBeforeFailing)
+{
+    ChainFixture f;
+    Result<memory::CompiledChain> chain = memory::CompiledChain::make(f.base(), f.steps, 2, 60'000);
+    ASSERT_TRUE(chain.has_value());
+    ASSERT_EQ(chain->walk()->raw(), f.field_a());
+
+    // The memoized object dies (its link is nulled) and the manager now holds a rebuilt one: the walk self-heals.
+    f.object_a = 0;
+    f.manager = reinterpret_cast<std::uintptr_t>(&f.object_b);
+    EXPECT_EQ(chain->walk()->raw(), f.field_b());
+
+    // When the freshly read chain is broken too, the error names the failing hop counted from the first step.
+    f.object_b = 0;
+    const auto broken = chain->walk();
+    ASSERT_FALSE(broken.has_value());
+    EXPECT_EQ(broken.error().code, ErrorCode::ReadFaulted);
+    EXPECT_EQ(broken.error().detail, static_cast<std::uintptr_t>(2));
+
+    f.manager = 0;
+    const auto stable_broken = chain->walk();
+    ASSERT_FALSE(stable_broken.has_value());
+    EXPECT_EQ(stable_broken.error().detail, static_cast<std::uintptr_t>(1));
+    EXPECT_FALSE(chain->memoized());
+}
+
+TEST(MemoryCompiledChain, MakeRejectsANullRootAndAStableLeaf)
+{
+    ChainFixture f;
+    const auto null_root = memory::CompiledChain::make(Address{}, f.steps, 1);
+    ASSERT_FALSE(null_root.has_value());
+    EXPECT_EQ(null_root.error().code, ErrorCode::NullChain);
+
+    const auto stable_leaf = memory::CompiledChain::make(f.base(), f.steps, f.steps.size());
+    ASSERT_FALSE(stable_leaf.has_value());
+    EXPECT_EQ(stable_leaf.error().code, ErrorCode::InvalidArg);
+
+    // No stable hop is a plain walk.
+    Result<memory::CompiledChain> plain = memory::CompiledChain::make(f.base(), f.steps, 0);
+    ASSERT_TRUE(plain.has_value());
+    EXPECT_EQ(plain->walk()->raw(), f.field_a());
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/metrics.hpp"
+
+namespace diag = DetourModKit::diagnostics;
+using DetourModKit::ErrorCode;
+
+namespace
+{
+    // The registry is process-wide and never cleared, so every test uses names of its own.
+    const diag::MetricSample *find_sample(const std::vector<diag::MetricSample> &samples, std::string_view name)
+    {
+        const auto it = std::ranges::find(samples, name, &diag::MetricSample::name);
+        return it == samples.end() ? nullptr : &*it;
+    }
+} // namespace
+
+TEST(MetricsTest, CounterSumsAcrossThreads)
+{
+    const auto counter = diag::register_counter("test.metrics.counter_threads");
+    ASSERT_TRUE(counter.has_value());
+
+    constexpr int THREADS = 8;
+    constexpr int PER_THREAD = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; ++t)
+    {
+        threads.emplace_back(
+            [&counter]()
+            {
+                for (int i = 0; i < PER_THREAD; ++i)
+                {
+                    counter->add();
+                }
+            });
+    }
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<diag::MetricSample> samples;
+    diag::collect_metrics(samples);
+    const diag::MetricSample *sample = find_sample(samples, "test.metrics.counter_threads");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->kind, diag::MetricKind::Counter);
+    EXPECT_EQ(sample->count, static_cast<std::uint64_t>(THREADS) * PER_THREAD);
+}
+
+TEST(MetricsTest, GaugeHoldsTheLastLevel)
+{
+    const auto gauge = diag::register_gauge("test.metrics.gauge_level");
+    ASSERT_TRUE(gauge.has_value());
+    gauge->set(40);
+    gauge->add(5);
+    gauge->add(-12);
+
+    std::vector<diag::MetricSample> samples;
+    diag::collect_metrics(samples);
+    const diag::MetricSample *sample = find_sample(samples, "test.metrics.gauge_level");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->kind, diag::MetricKind::Gauge);
+    EXPECT_EQ(sample->value, 33);
+}
+
+TEST(MetricsTest, HistogramBucketsByLog2)
+{
+    const auto histogram = diag::register_histogram("test.metrics.histogram_buckets");
+    ASSERT_TRUE(histogram.has_value());
+    histogram->record(0);
+    histogram->record(1);
+    histogram->record(5);
+    histogram->record(7);
+    histogram->record(UINT64_MAX);
+
+    std::vector<diag::MetricSample> samples;
+    diag::collect_metrics(samples);
+    const diag::MetricSample *sample = find_sample(samples, "test.metrics.histogram_buckets");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->kind, diag::MetricKind::Histogram);
+    EXPECT_EQ(sample->count, 5u);
+    EXPECT_EQ(sample->buckets[0], 1u);
+    EXPECT_EQ(sample->buckets[1], 1u);
+    // 5 and 7 both have bit width 3.
+    EXPECT_EQ(sample->buckets[3], 2u);
+    // Anything wider than the last bucket lands in it.
+    EXPECT_EQ(sample->buckets[diag::METRIC_HISTOGRAM_BUCKETS - 1], 1u);
+}
+
+TEST(MetricsTest, RegistrationIsIdempotentPerKind)
+{
+    const auto first = diag::register_counter("test.metrics.shared");
+    const auto second = diag::register_counter("test.metrics.shared");
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    first->add(2);
+    second->add(3);
+
+    std::vector<diag::MetricSample> samples;
+    diag::collect_metrics(samples);
+    EXPECT_EQ(std::ranges::count(samples, std::string_view("test.metrics.shared"), &diag::MetricSample::name), 1);
+    const diag::MetricSample *sample = find_sample(samples, "test.metrics.shared");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->count, 5u);
+
+    // The same name cannot come back as another kind, and a metric needs a name.
+    const auto clash = diag::register_gauge("test.metrics.shared");
+    ASSERT_FALSE(clash.has_value());
+    EXPECT_EQ(clash.error().code, ErrorCode::InvalidArg);
+    const auto unnamed = diag::register_histogram("");
+    ASSERT_FALSE(unnamed.has_value());
+    EXPECT_EQ(unnamed.error().code, ErrorCode::InvalidArg);
+}
+
+TEST(MetricsTest, DefaultHandlesRecordNothing)
+{
+    const diag::Counter counter;
+    const diag::Gauge gauge;
+    const diag::Histogram histogram;
+    counter.add();
+    gauge.set(1);
+    gauge.add(1);
+    histogram.record(1);
+    SUCCEED();
+}
+
+TEST(MetricsTest, CollectReportsRegisteredAndMemoryMetrics)
+{
+    const auto counter = diag::register_counter("test.metrics.in_snapshot");
+    ASSERT_TRUE(counter.has_value());
+    counter->add(4);
+
+    const diag::Snapshot snapshot = diag::collect();
+    const diag::MetricSample *sample = find_sample(snapshot.metrics, "test.metrics.in_snapshot");
+    ASSERT_NE(sample, nullptr);
+    EXPECT_EQ(sample->count, 4u);
+    const diag::MetricSample *hits = find_sample(snapshot.metrics, "memory.cache.hits");
+    ASSERT_NE(hits, nullptr);
+    EXPECT_EQ(hits->kind, diag::MetricKind::Counter);
+    EXPECT_NE(find_sample(snapshot.metrics, "memory.cache.entries"), nullptr);
+}
@@ -92,9 +92,12 @@ namespace
      * @details Templated on the target's function type so a plain `&fn` argument reinterpret_casts cleanly to an
      *          Address (a function pointer does not implicitly convert to void*).
      */
-    template <class Fn> [[nodiscard]] Result<Hook> install_mid(std::string name, Fn *target, MidHookFn detour)
+    template <class Fn>
+    [[nodiscard]] Result<Hook> install_mid(std::string name, Fn *target, MidHookFn detour, Options options = {})
     {
-        return mid_at(MidRequest{.name = std::move(name), .target = Address{reinterpret_cast<std::uintptr_t>(target)}},
+        return mid_at(MidRequest{.name = std::move(name),
+                                 .target = Address{reinterpret_cast<std::uintptr_t>(target)},
+                                 .options = options},
                       detour);
     }
 } // namespace
@@ -281,6 +284,86 @@ TEST_F(MidHookContextTest, ResumeStackPointerAndFlagsAreReadable)
     EXPECT_NE(s_rflags.load() & 0x2u, 0u) << "flags() did not capture the live rflags register";
 }
 
+// 8. A GPR-only capture installs the lightweight stub, and every scalar accessor behaves as under the full capture:
+// argument reads, a surviving r8 write, and a live rflags.
+TEST_F(MidHookContextTest, GprOnlyCaptureReadsAndWritesGeneralPurposeRegisters)
+{
+#if !defined(__x86_64__) && !defined(_M_X64)
+    GTEST_SKIP() << "requires x86-64 (Win64) calling convention";
+#endif
+    auto detour = [](MidContext &ctx)
+    {
+        s_calls.fetch_add(1, std::memory_order_relaxed);
+        s_rcx.store(gpr(ctx, Gpr::Rcx), std::memory_order_relaxed);
+        s_rdx.store(gpr(ctx, Gpr::Rdx), std::memory_order_relaxed);
+        s_rflags.store(flags(ctx), std::memory_order_relaxed);
+        gpr(ctx, Gpr::R8) = 555;
+    };
+
+    Result<Hook> result =
+        install_mid("MidGprOnly", &return_third, detour, Options{.capture = MidCapture::gpr_only()});
+    ASSERT_TRUE(result.has_value()) << "mid_at failed: " << result.error().message();
+    Hook hook = std::move(*result);
+    EXPECT_TRUE(hook.is_enabled());
+
+    volatile int observed = return_third(0x44, 0x55, 3);
+    EXPECT_EQ(observed, 555) << "ctx.r8 write did not survive the lightweight stub's resume";
+    EXPECT_EQ(s_calls.load(), 1);
+    EXPECT_EQ(static_cast<int>(s_rcx.load() & 0xFFFFFFFFu), 0x44);
+    EXPECT_EQ(static_cast<int>(s_rdx.load() & 0xFFFFFFFFu), 0x55);
+    EXPECT_NE(s_rflags.load() & 0x2u, 0u);
+
+    // Disable and re-enable toggle the same stub.
+    ASSERT_TRUE(hook.disable().has_value());
+    EXPECT_EQ(return_third(1, 2, 3), 3);
+    ASSERT_TRUE(hook.enable().has_value());
+    EXPECT_EQ(return_third(1, 2, 3), 555);
+}
+
+// 9. The lightweight stub always saves the volatile xmm0..xmm5, so xmm0 reads live, and a rip rewrite still steers
+// the resume.
+TEST_F(MidHookContextTest, GprOnlyCaptureKeepsVolatileXmmAndRipRedirect)
+{
+#if !defined(__x86_64__) && !defined(_M_X64)
+    GTEST_SKIP() << "requires x86-64 (Win64) calling convention";
+#endif
+    auto xmm_detour = [](MidContext &ctx)
+    {
+        float v = xmm(ctx, 0).lane<float>(0);
+        std::uint32_t bits = 0;
+        std::memcpy(&bits, &v, sizeof(bits));
+        s_xmm0_bits.store(bits, std::memory_order_relaxed);
+    };
+    Result<Hook> xmm_hook =
+        install_mid("MidGprOnlyXmm", &pass_float, xmm_detour, Options{.capture = MidCapture::gpr_only()});
+    ASSERT_TRUE(xmm_hook.has_value()) << "mid_at failed: " << xmm_hook.error().message();
+
+    volatile float observed = pass_float(6.25f);
+    EXPECT_EQ(observed, 6.25f) << "the lightweight stub did not restore xmm0 for the resumed body";
+    float got = 0.0f;
+    const std::uint32_t bits = s_xmm0_bits.load();
+    std::memcpy(&got, &bits, sizeof(got));
+    EXPECT_EQ(got, 6.25f);
+
+    auto rip_detour = [](MidContext &ctx)
+    { instruction_pointer(ctx) = reinterpret_cast<uintptr_t>(&rip_replacement); };
+    Result<Hook> rip_hook =
+        install_mid("MidGprOnlyRip", &rip_original, rip_detour, Options{.capture = MidCapture{.xmm_mask = 0x0100}});
+    ASSERT_TRUE(rip_hook.has_value()) << "mid_at failed: " << rip_hook.error().message();
+    EXPECT_EQ(rip_original(), 22);
+}
+
+TEST(MidCaptureTest, OnlyTheFullMaskSelectsTheBackendStub)
+{
+    static_assert(MidCapture::full().is_full());
+    static_assert(Options{}.capture.is_full());
+    static_assert(!MidCapture::gpr_only().is_full());
+    static_assert(!MidCapture{.xmm_mask = 0x8000}.is_full());
+    // xmm0..xmm5 are implied, so declaring every callee-saved register is the full capture.
+    static_assert(MidCapture{.xmm_mask = 0xFFC0}.is_full());
+    SUCCEED();
+}
+
 // XmmView::lane fails closed on an out-of-range lane instead of reading past the 16-byte register. This needs no
 // live hook: XmmView is a plain value type, so it pins the bounds contract directly.
 TEST(MidContextXmmViewTest, LaneFailsClosedOutOfRange)
@@ -0,0 +1,270 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "DetourModKit/manifest.hpp"
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/offline.hpp"
+
+#include <process.h>
+// windows.h after project headers to avoid macro conflicts.
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+
+namespace dmk = DetourModKit;
+namespace mf = DetourModKit::manifest;
+namespace off = DetourModKit::offline;
+
+namespace
+{
+    // Data of the test executable itself: the mapped copy of the same file must hold it at the same RVA. Not const,
+    // so no toolchain duplicates its bytes into debug info as a constant value and the marker stays unique in the
+    // image. The pointer is constant-initialized, so it is an absolute address in the file a base relocation fixes.
+    char MARKER[] = "DMK-offline-marker:5f3a9c1e";
+    const char *const MARKER_POINTER = MARKER;
+
+    [[nodiscard]] std::filesystem::path executable_path()
+    {
+        std::wstring buffer(MAX_PATH, L'\0');
+        const DWORD length = GetModuleFileNameW(nullptr, buffer.data(), static_cast<DWORD>(buffer.size()));
+        buffer.resize(length);
+        return std::filesystem::path(buffer);
+    }
+
+    [[nodiscard]] std::uintptr_t host_rva(const void *address)
+    {
+        return reinterpret_cast<std::uintptr_t>(address) - dmk::Region::host().base.raw();
+    }
+
+    [[nodiscard]] const IMAGE_NT_HEADERS64 &host_nt_headers()
+    {
+        const auto base = dmk::Region::host().base.raw();
+        const auto *dos = reinterpret_cast<const IMAGE_DOS_HEADER *>(base);
+        return *reinterpret_cast<const IMAGE_NT_HEADERS64 *>(base + static_cast<std::uintptr_t>(dos->e_lfanew));
+    }
+
+    /// The marker's bytes (without its NUL) as an AOB the manifest can carry.
+    [[nodiscard]] std::string marker_pattern()
+    {
+        std::string pattern;
+        for (std::size_t i = 0; i + 1 < sizeof(MARKER); ++i)
+        {
+            pattern += std::format("{}{:02X}", i == 0 ? "" : " ", static_cast<unsigned char>(MARKER[i]));
+        }
+        return pattern;
+    }
+
+    [[nodiscard]] mf::SignatureRecord marker_record(std::string label, std::string module, std::string pattern)
+    {
+        mf::SignatureRecord record;
+        record.label = std::move(label);
+        record.kind = dmk::anchor::AnchorKind::RipGlobal;
+        record.module = std::move(module);
+        mf::CandidateSpec rung;
+        rung.name = "marker";
+        rung.pattern = std::move(pattern);
+        record.ladder.push_back(std::move(rung));
+        return record;
+    }
+
+    // A temp file removed on every scope exit, like test_manifest.cpp's ScopedManifestFile.
+    class ScopedTempFile
+    {
+    public:
+        explicit ScopedTempFile(const std::string &stem)
+            : m_path(std::filesystem::temp_directory_path() / (stem + "_" + std::to_string(_getpid()) + ".bin"))
+        {
+        }
+
+        ~ScopedTempFile()
+        {
+            std::error_code ec;
+            std::filesystem::remove(m_path, ec);
+        }
+
+        ScopedTempFile(const ScopedTempFile &) = delete;
+        ScopedTempFile &operator=(const ScopedTempFile &) = delete;
+
+        [[nodiscard]] const std::filesystem::path &path() const noexcept { return m_path; }
+
+    private:
+        std::filesystem::path m_path;
+    };
+} // anonymous namespace
+
+TEST(OfflineImageTest, CopiesTheImageAtItsRvas)
+{
+    const auto image = off::MappedImage::map(executable_path());
+    ASSERT_TRUE(image.has_value()) << image.error().message();
+
+    const dmk::Region host = dmk::Region::host();
+    EXPECT_EQ(image->region().size, host.size);
+    EXPECT_NE(image->region().base, host.base);
+    EXPECT_EQ(image->preferred_base(), host_nt_headers().OptionalHeader.ImageBase);
+    EXPECT_EQ(image->module_name(), executable_path().filename().string());
+
+    const std::uintptr_t rva = host_rva(MARKER);
+    ASSERT_LT(rva + sizeof(MARKER), image->region().size);
+    EXPECT_EQ(std::memcmp(image->region().base.offset(static_cast<std::ptrdiff_t>(rva)).as<const void *>(), MARKER,
+                          sizeof(MARKER)),
+              0);
+}
+
+TEST(OfflineImageTest, AppliesRelocationsAndCodeProtection)
+{
+    const auto image = off::MappedImage::map(executable_path());
+    ASSERT_TRUE(image.has_value()) << image.error().message();
+    const std::uintptr_t base = image->region().base.raw();
+
+    // The constant-initialized pointer now points at the marker inside the copy.
+    if (host_nt_headers().OptionalHeader.DataDirectory[IMAGE_DIRECTORY_ENTRY_BASERELOC].Size == 0)
+    {
+        GTEST_SKIP() << "the test executable was linked without base relocations";
+    }
+    std::uintptr_t pointer = 0;
+    std::memcpy(&pointer, reinterpret_cast<const void *>(base + host_rva(&MARKER_POINTER)), sizeof(pointer));
+    EXPECT_EQ(pointer, base + host_rva(MARKER));
+
+    // Code is execute-read so Pages::Executable scans see it; data is read-only.
+    const auto *const function = reinterpret_cast<const void *>(&executable_path);
+    MEMORY_BASIC_INFORMATION code{};
+    ASSERT_NE(VirtualQuery(reinterpret_cast<const void *>(base + host_rva(function)), &code, sizeof(code)), 0u);
+    EXPECT_EQ(code.Protect, static_cast<DWORD>(PAGE_EXECUTE_READ));
+    MEMORY_BASIC_INFORMATION data{};
+    ASSERT_NE(VirtualQuery(reinterpret_cast<const void *>(base + host_rva(MARKER)), &data, sizeof(data)), 0u);
+    EXPECT_EQ(data.Protect, static_cast<DWORD>(PAGE_READONLY));
+}
+
+TEST(OfflineImageTest, ModuleOfCoversALiveCopy)
+{
+    std::uintptr_t inside = 0;
+    {
+        auto image = off::MappedImage::map(executable_path());
+        ASSERT_TRUE(image.has_value()) << image.error().message();
+        inside = image->region().base.raw() + host_rva(MARKER);
+
+        const off::MappedImage moved = std::move(*image);
+        const dmk::Region owner = dmk::memory::module_of(dmk::Address{inside});
+        EXPECT_EQ(owner.base, moved.region().base);
+        EXPECT_EQ(owner.size, moved.region().size);
+        EXPECT_EQ(image->region().size, 0u);
+    }
+    EXPECT_EQ(dmk::memory::module_of(dmk::Address{inside}).size, 0u);
+}
+
+TEST(OfflineImageTest, RejectsMissingAndMalformedFiles)
+{
+    const auto missing = off::MappedImage::map(std::filesystem::temp_directory_path() / "dmk_offline_absent.exe");
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, dmk::ErrorCode::FileOpenFailed);
+
+    const ScopedTempFile garbage("dmk_offline_garbage");
+    {
+        std::ofstream out(garbage.path(), std::ios::binary);
+        const std::vector<char> bytes(0x400, 'Z');
+        out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    const auto malformed = off::MappedImage::map(garbage.path());
+    ASSERT_FALSE(malformed.has_value());
+    EXPECT_EQ(malformed.error().code, dmk::ErrorCode::InvalidRange);
+
+    // A real PE header cut off before its section table.
+    const ScopedTempFile truncated("dmk_offline_truncated");
+    {
+        std::ofstream out(truncated.path(), std::ios::binary);
+        const auto *headers = dmk::Region::host().base.as<const char *>();
+        const auto cut = static_cast<std::streamsize>(
+            reinterpret_cast<const IMAGE_DOS_HEADER *>(headers)->e_lfanew + sizeof(IMAGE_NT_HEADERS64));
+        out.write(headers, cut);
+    }
+    const auto cut_short = off::MappedImage::map(truncated.path());
+    ASSERT_FALSE(cut_short.has_value());
+    EXPECT_EQ(cut_short.error().code, dmk::ErrorCode::InvalidRange);
+}
+
+TEST(OfflineValidateTest, GatesRecordsAgainstTheCopy)
+{
+    const std::string module = executable_path().filename().string();
+    std::string shouted = module;
+    for (char &c : shouted)
+    {
+        c = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    mf::Manifest manifest;
+    manifest.records.push_back(marker_record("marker.scope", "", marker_pattern()));
+    manifest.records.push_back(marker_record("marker.named", shouted, marker_pattern()));
+    manifest.records.push_back(marker_record("marker.foreign", "other_module.dll", marker_pattern()));
+    manifest.records.push_back(marker_record("marker.broken", "", "ZZ"));
+
+    const auto image = off::MappedImage::map(executable_path());
+    ASSERT_TRUE(image.has_value()) << image.error().message();
+    const auto report = off::validate(*image, manifest);
+    ASSERT_TRUE(report.has_value()) << report.error().message();
+
+    ASSERT_EQ(report->gate.trusted.size(), 2u);
+    EXPECT_TRUE(report->gate.rejected.empty());
+    for (const char *label : {"marker.scope", "marker.named"})
+    {
+        const mf::GatedSignature *hit = report->gate.find(label);
+        ASSERT_NE(hit, nullptr) << label;
+        EXPECT_TRUE(image->region().contains(hit->address)) << label;
+        EXPECT_EQ(report->rva(*hit), host_rva(MARKER)) << label;
+    }
+
+    ASSERT_EQ(report->skipped.size(), 2u);
+    EXPECT_EQ(report->skipped[0].label, "marker.foreign");
+    EXPECT_EQ(report->skipped[0].reason, off::SkipReason::ForeignModule);
+    EXPECT_EQ(report->skipped[1].label, "marker.broken");
+    EXPECT_EQ(report->skipped[1].reason, off::SkipReason::CompileFailed);
+    EXPECT_EQ(report->skipped[1].error, dmk::ErrorCode::BadPattern);
+}
+
+TEST(OfflineValidateTest, RetargetingKeepsTheAuthoredFingerprintVerdict)
+{
+    const std::string module = executable_path().filename().string();
+    mf::SignatureRecord matched = marker_record("fp.match", module, marker_pattern());
+    matched.expected_fingerprint = mf::Signature::compile(matched).value().current_fingerprint();
+    mf::SignatureRecord drifted = marker_record("fp.drift", module, marker_pattern());
+    drifted.expected_fingerprint = matched.expected_fingerprint ^ 1ULL;
+
+    mf::Manifest manifest;
+    manifest.records = {matched, drifted};
+    const auto report = off::validate(executable_path(), manifest);
+    ASSERT_TRUE(report.has_value()) << report.error().message();
+    EXPECT_EQ(report->path, executable_path());
+    ASSERT_NE(report->gate.find("fp.match"), nullptr);
+    ASSERT_EQ(report->gate.rejected.size(), 1u);
+    EXPECT_EQ(report->gate.rejected[0].label, "fp.drift");
+    EXPECT_EQ(report->gate.rejected[0].fingerprint, mf::FingerprintState::Drifted);
+}
+
+TEST(OfflineValidateTest, ValidateAllKeepsInputOrder)
+{
+    mf::Manifest manifest;
+    manifest.records.push_back(marker_record("marker", "", marker_pattern()));
+
+    const std::vector<std::filesystem::path> paths{
+        executable_path(), std::filesystem::temp_directory_path() / "dmk_offline_absent.exe", executable_path()};
+    const auto reports = off::validate_all(paths, manifest, {}, 2);
+    ASSERT_TRUE(reports.has_value());
+    ASSERT_EQ(reports->size(), 3u);
+    for (const std::size_t i : {std::size_t{0}, std::size_t{2}})
+    {
+        ASSERT_TRUE((*reports)[i].has_value()) << i;
+        const mf::GatedSignature *hit = (*reports)[i]->gate.find("marker");
+        ASSERT_NE(hit, nullptr) << i;
+        EXPECT_EQ((*reports)[i]->rva(*hit), host_rva(MARKER)) << i;
+    }
+    ASSERT_FALSE((*reports)[1].has_value());
+    EXPECT_EQ((*reports)[1].error().code, dmk::ErrorCode::FileOpenFailed);
+}
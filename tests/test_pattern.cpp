@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "DetourModKit/detail/pattern_core.hpp"
@@ -349,3 +350,253 @@ TEST(PatternJumps, JumpBoundIsCapped)
     EXPECT_TRUE(scan::Pattern::compile("AA [1-" + std::to_string(detail::MAX_JUMP_SPAN) + "] BB").has_value());
     EXPECT_FALSE(scan::Pattern::compile("AA [1-" + std::to_string(detail::MAX_JUMP_SPAN + 1) + "] BB").has_value());
 }
+
+// Compile-time proof of the kernel plans: a short pattern compares only its constrained bytes, a mid-length one takes
+// two overlapping 8-byte chunks, a long one 16-byte chunks, and an all-literal chunk needs no mask.
+static_assert(detail::plan_kernel(detail::parse_pattern("48 ?? 05").buffer).count == 2);
+static_assert(detail::plan_kernel(detail::parse_pattern("48 8B 05 ?? ?? ?? ?? 48 85 C0").buffer).count == 2);
+static_assert(detail::plan_kernel(detail::parse_pattern("48 8B 05 ?? ?? ?? ?? 48 85 C0").buffer).steps[1].lanes ==
+              0xC0);
+static_assert(
+    !detail::plan_kernel(detail::parse_pattern("48 8B 05 11 22 33 44 55 66 77 88 99 AA BB CC DD").buffer).steps[0]
+         .nibbles);
+static_assert(detail::plan_kernel(detail::parse_pattern("48 8B 05 11 22 33 44 55 66 77 88 99 AA BB CC D?").buffer)
+                  .steps[0]
+                  .nibbles);
+static_assert(detail::kernel_for<detail::parse_pattern("48 [2-4] 8B").buffer>() == nullptr);
+
+TEST(PatternKernel, KernelAgreesWithMatchesAt)
+{
+    // Every window of a buffer that repeats fragments of the pattern, for short, mid-length, long, and nibble
+    // patterns: the specialized kernel must accept exactly the windows matches_at accepts.
+    constexpr auto short_buffer = detail::parse_pattern("48 ?? 05").buffer;
+    constexpr auto mid_buffer = detail::parse_pattern("48 8B 05 ?? ?? ?? ?? 48 85 C0").buffer;
+    constexpr auto long_buffer =
+        detail::parse_pattern("48 89 5C 24 ?? 57 48 83 EC 20 48 8B F9 E8 ?? ?? ?? ?? 4? 8B").buffer;
+    const detail::PatternKernel kernels[] = {detail::kernel_for<short_buffer>(), detail::kernel_for<mid_buffer>(),
+                                             detail::kernel_for<long_buffer>()};
+    const scan::Pattern patterns[] = {scan::Pattern::literal("48 ?? 05"),
+                                      scan::Pattern::literal("48 8B 05 ?? ?? ?? ?? 48 85 C0"),
+                                      scan::Pattern::literal(
+                                          "48 89 5C 24 ?? 57 48 83 EC 20 48 8B F9 E8 ?? ?? ?? ?? 4? 8B")};
+
+    for (std::size_t p = 0; p < 3; ++p)
+    {
+        ASSERT_NE(kernels[p], nullptr);
+        const std::span<const std::byte> bytes = patterns[p].bytes();
+        std::vector<std::byte> haystack;
+        std::uint32_t state = 0x1234567u;
+        for (std::size_t i = 0; i < 4096; ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            // Mostly pattern bytes from a random position, so near-misses of every length are common.
+            haystack.push_back((state >> 28) < 12 ? bytes[(state >> 8) % bytes.size()] : std::byte{0x41});
+        }
+        for (std::size_t planted = 100; planted < 4000; planted += 700)
+        {
+            for (std::size_t i = 0; i < bytes.size(); ++i)
+            {
+                haystack[planted + i] = bytes[i];
+            }
+        }
+
+        std::size_t accepted = 0;
+        for (std::size_t at = 0; at + patterns[p].size() <= haystack.size(); ++at)
+        {
+            const bool expected = patterns[p].matches_at(std::span<const std::byte>(haystack).subspan(at));
+            ASSERT_EQ(kernels[p](haystack.data() + at), expected) << "pattern " << p << " at " << at;
+            accepted += expected ? 1u : 0u;
+        }
+        EXPECT_GE(accepted, 6u);
+    }
+}
+
+TEST(PatternKernel, LiteralTemplatesMatchRuntimeScans)
+{
+    std::vector<std::byte> haystack(0x2000, std::byte{0xCC});
+    const std::array<std::uint8_t, 10> site = {0x48, 0x8B, 0x05, 0x10, 0x20, 0x30, 0x40, 0x48, 0x85, 0xC0};
+    for (const std::size_t at : {std::size_t{0x345}, std::size_t{0x1A00}})
+    {
+        for (std::size_t i = 0; i < site.size(); ++i)
+        {
+            haystack[at + i] = std::byte{site[i]};
+        }
+    }
+    const Region scope{Address{haystack.data()}, haystack.size()};
+    constexpr scan::Pattern pattern = scan::Pattern::literal("48 8B 05 ?? ?? ?? ?? 48 85 | C0");
+
+    for (const std::size_t occurrence : {std::size_t{1}, std::size_t{2}, std::size_t{3}})
+    {
+        EXPECT_EQ(scan::unchecked::find_pattern<"48 8B 05 ?? ?? ?? ?? 48 85 | C0">(scope, occurrence),
+                  scan::unchecked::find_pattern(scope, pattern, occurrence));
+
+        const auto specialized = scan::scan<"48 8B 05 ?? ?? ?? ?? 48 85 | C0">(scope, occurrence);
+        const auto generic = scan::scan(pattern, scope, occurrence);
+        ASSERT_EQ(specialized.has_value(), generic.has_value()) << occurrence;
+        if (generic.has_value())
+        {
+            EXPECT_EQ(*specialized, *generic);
+        }
+        else
+        {
+            EXPECT_EQ(specialized.error().code, generic.error().code);
+        }
+    }
+    ASSERT_NE(scan::unchecked::find_pattern<"48 8B 05 ?? ?? ?? ?? 48 85 | C0">(scope), nullptr);
+    EXPECT_EQ(scan::unchecked::find_pattern<"48 8B 05 ?? ?? ?? ?? 48 85 | C0">(scope), haystack.data() + 0x345 + 9);
+
+    // A literal with bounded jumps takes the engine's own matcher and still agrees.
+    EXPECT_EQ(scan::unchecked::find_pattern<"48 8B 05 [4] 48 85 C0">(scope),
+              scan::unchecked::find_pattern(scope, scan::Pattern::literal("48 8B 05 [4] 48 85 C0")));
+}
+
+// Classes and groups compile at compile time like every other token, so a literal ladder rung can carry them.
+static_assert(scan::Pattern::literal("48 8B [0D|15] ?? ?? ?? ??").has_classes());
+static_assert(scan::Pattern::literal("E8 (48 8B 0D|4C 8B 15)").has_classes());
+static_assert(!scan::Pattern::literal("[B8/F8] 01").has_classes());
+static_assert(scan::Pattern::literal("48 [0D|15] | 05").offset() == 2);
+
+TEST(PatternClasses, MatchesAtAcceptsExactlyTheMembers)
+{
+    // 0D and 15 share the bits E7 selects, which also admits 05 and 1D; the class check must turn both away.
+    const auto p = scan::Pattern::compile("48 8B [0D|15] 05");
+    ASSERT_TRUE(p.has_value());
+    EXPECT_EQ(p->size(), 4U);
+    EXPECT_TRUE(p->has_classes());
+    EXPECT_EQ(p->mask()[2], std::byte{0xE7});
+    EXPECT_TRUE(p->matches_at(window<4>({0x48, 0x8B, 0x0D, 0x05})));
+    EXPECT_TRUE(p->matches_at(window<4>({0x48, 0x8B, 0x15, 0x05})));
+    EXPECT_FALSE(p->matches_at(window<4>({0x48, 0x8B, 0x05, 0x05})));
+    EXPECT_FALSE(p->matches_at(window<4>({0x48, 0x8B, 0x1D, 0x05})));
+
+    // Nibble members widen a class to every value of the nibble.
+    const auto nibbles = scan::Pattern::compile("[4?|5?] FF");
+    ASSERT_TRUE(nibbles.has_value());
+    EXPECT_TRUE(nibbles->matches_at(window<2>({0x4A, 0xFF})));
+    EXPECT_TRUE(nibbles->matches_at(window<2>({0x5F, 0xFF})));
+    EXPECT_FALSE(nibbles->matches_at(window<2>({0x6A, 0xFF})));
+}
+
+TEST(PatternClasses, BitSetClassIsItsValueAndMask)
+{
+    // B8..BF: MOV r32, imm32 over every register. The pair is exact, so no class is stored.
+    const auto p = scan::Pattern::compile("[B8/F8] ?? ?? ?? ??");
+    ASSERT_TRUE(p.has_value());
+    EXPECT_FALSE(p->has_classes());
+    EXPECT_EQ(p->bytes()[0], std::byte{0xB8});
+    EXPECT_EQ(p->mask()[0], std::byte{0xF8});
+    EXPECT_TRUE(p->matches_at(window<5>({0xBF, 1, 2, 3, 4})));
+    EXPECT_FALSE(p->matches_at(window<5>({0xC0, 1, 2, 3, 4})));
+
+    // A bit-set member mixes with plain members.
+    const auto mixed = scan::Pattern::compile("[B8/FC|C3]");
+    ASSERT_TRUE(mixed.has_value());
+    EXPECT_TRUE(mixed->matches_at(window<1>({0xBB})));
+    EXPECT_TRUE(mixed->matches_at(window<1>({0xC3})));
+    EXPECT_FALSE(mixed->matches_at(window<1>({0xBC})));
+}
+
+TEST(PatternClasses, GroupRejectsMixedAlternatives)
+{
+    const auto p = scan::Pattern::compile("E8 (48 8B 0D|4C 8B 15) | 90");
+    ASSERT_TRUE(p.has_value());
+    EXPECT_EQ(p->size(), 5U);
+    EXPECT_EQ(p->offset(), 4U);
+    EXPECT_TRUE(p->matches_at(window<5>({0xE8, 0x48, 0x8B, 0x0D, 0x90})));
+    EXPECT_TRUE(p->matches_at(window<5>({0xE8, 0x4C, 0x8B, 0x15, 0x90})));
+    // Each byte belongs to some alternative, but no one alternative holds both.
+    EXPECT_FALSE(p->matches_at(window<5>({0xE8, 0x48, 0x8B, 0x15, 0x90})));
+    EXPECT_FALSE(p->matches_at(window<5>({0xE8, 0x4C, 0x8B, 0x0D, 0x90})));
+
+    // Alternatives that differ at one position are exactly that position's class, so no group record is kept.
+    const auto single = scan::Pattern::compile("(48 8B 0D|48 8B 15)");
+    ASSERT_TRUE(single.has_value());
+    EXPECT_EQ(detail::pattern_buffer(*single).group_count, 0U);
+    EXPECT_EQ(detail::pattern_buffer(*single).class_count, 1U);
+    EXPECT_EQ(single->anchor_index(), 1U);
+}
+
+TEST(PatternClasses, RejectsMalformedClassesAndGroups)
+{
+    const auto status = [](std::string_view dsl)
+    {
+        const auto compiled = scan::Pattern::compile(dsl);
+        return compiled.has_value() ? detail::PatternStatus::Ok
+                                    : static_cast<detail::PatternStatus>(compiled.error().extra);
+    };
+    EXPECT_EQ(status("48 [0D|] 05"), detail::PatternStatus::InvalidClass);         // empty member
+    EXPECT_EQ(status("48 [0D|??] 05"), detail::PatternStatus::InvalidClass);       // wildcard member
+    EXPECT_EQ(status("48 [B9/F8] 05"), detail::PatternStatus::InvalidClass);       // value bit outside the mask
+    EXPECT_EQ(status("48 [0D|1G] 05"), detail::PatternStatus::InvalidClass);       // not hex
+    EXPECT_EQ(status("(48|48 8B) 05"), detail::PatternStatus::InvalidClass);       // unequal lengths
+    EXPECT_EQ(status("(48 8B) 05"), detail::PatternStatus::InvalidClass);          // one alternative
+    EXPECT_EQ(status("(48|49 05"), detail::PatternStatus::InvalidClass);           // unclosed
+    EXPECT_EQ(status("(48|49)05"), detail::PatternStatus::InvalidClass);           // no separator after the group
+    EXPECT_EQ(status("(01|02|03|04|05) 06"), detail::PatternStatus::InvalidClass); // too many alternatives
+    EXPECT_EQ(status("48 [2-3] 05"), detail::PatternStatus::Ok);                   // a jump is still a jump
+
+    std::string over_cap;
+    for (std::size_t i = 0; i <= detail::MAX_PATTERN_CLASSES; ++i)
+    {
+        over_cap += "[0D|15] ";
+    }
+    EXPECT_EQ(status(over_cap), detail::PatternStatus::TooManyClasses);
+}
+
+TEST(PatternClasses, EveryMatcherHonorsTheClass)
+{
+    // One site per register choice, plus decoys that pass the class's shared bits but are not members.
+    std::vector<std::byte> haystack(0x3000, std::byte{0xCC});
+    const auto plant = [&](std::size_t at, std::uint8_t reg)
+    {
+        const std::array<std::uint8_t, 8> site = {0x48, 0x8B, reg, 0x11, 0x22, 0x33, 0x44, 0xC3};
+        for (std::size_t i = 0; i < site.size(); ++i)
+        {
+            haystack[at + i] = std::byte{site[i]};
+        }
+    };
+    plant(0x100, 0x05);
+    plant(0x400, 0x0D);
+    plant(0x900, 0x1D);
+    plant(0x1800, 0x15);
+    const Region scope{Address{haystack.data()}, haystack.size()};
+
+    constexpr scan::Pattern pattern = scan::Pattern::literal("48 8B [0D|15] ?? ?? ?? ?? C3");
+    std::array<Address, 4> hits{};
+    const auto found = scan::find_all(pattern, scope, hits);
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->matches, 2U);
+    EXPECT_EQ(hits[0].raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x400));
+    EXPECT_EQ(hits[1].raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x1800));
+
+    // The literal kernel prefilters on the shared bits and must reach the same answer.
+    EXPECT_EQ(scan::unchecked::find_pattern<"48 8B [0D|15] ?? ?? ?? ?? C3">(scope), haystack.data() + 0x400);
+    EXPECT_EQ(scan::unchecked::find_pattern<"48 8B [0D|15] ?? ?? ?? ?? C3">(scope, 2), haystack.data() + 0x1800);
+
+    // A jump-bearing pattern runs the automaton for a class and the backtracking search for a group.
+    const auto jumped = scan::Pattern::compile("48 8B [0D|15] [4] C3");
+    ASSERT_TRUE(jumped.has_value());
+    ASSERT_TRUE(scan::find_all(*jumped, scope, hits).has_value());
+    EXPECT_EQ(scan::find_all(*jumped, scope, hits)->matches, 2U);
+    const auto grouped = scan::Pattern::compile("(48 8B 0D|48 8B 1D) [4] C3");
+    ASSERT_TRUE(grouped.has_value());
+    const auto grouped_found = scan::find_all(*grouped, scope, hits);
+    ASSERT_TRUE(grouped_found.has_value());
+    ASSERT_EQ(grouped_found->matches, 2U);
+    EXPECT_EQ(hits[0].raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x400));
+    EXPECT_EQ(hits[1].raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x900));
+
+    // A unique class rung resolves through the batch sweep alongside a plain one.
+    haystack[0x1800 + 2] = std::byte{0x25};
+    const scan::Candidate classed[] = {scan::Candidate::direct("classed", pattern)};
+    const scan::Candidate plain[] = {
+        scan::Candidate::direct("plain", scan::Pattern::literal("48 8B 05 ?? ?? ?? ?? C3"))};
+    const std::array<scan::ScanRequest, 2> requests = {scan::ScanRequest{.ladder = classed, .scope = scope},
+                                                       scan::ScanRequest{.ladder = plain, .scope = scope}};
+    const auto batch = scan::resolve_batch(requests);
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_TRUE((*batch)[0].has_value());
+    EXPECT_EQ((*batch)[0]->address.raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x400));
+    ASSERT_TRUE((*batch)[1].has_value());
+    EXPECT_EQ((*batch)[1]->address.raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x100));
+}
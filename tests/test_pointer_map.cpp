@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <windows.h>
+
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/pointer_map.hpp"
+#include "DetourModKit/region_set.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    constexpr std::size_t ARENA_BYTES = 0x10000;
+
+    // Statics in the test image's writable data: the roots every expected path starts from.
+    void *volatile g_deep_root = nullptr;
+    void *volatile g_direct_root = nullptr;
+
+    class Arena
+    {
+    public:
+        Arena()
+            : m_base(static_cast<std::byte *>(
+                  VirtualAlloc(nullptr, ARENA_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+        {
+        }
+        ~Arena()
+        {
+            if (m_base != nullptr)
+                VirtualFree(m_base, 0, MEM_RELEASE);
+        }
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        [[nodiscard]] bool ok() const noexcept { return m_base != nullptr; }
+        [[nodiscard]] std::byte *at(std::size_t offset) const noexcept { return m_base + offset; }
+        [[nodiscard]] Region region() const noexcept { return Region{Address{m_base}, ARENA_BYTES}; }
+
+    private:
+        std::byte *m_base;
+    };
+
+    // The page holding a static, so the scope covers the roots without the rest of the image's data.
+    [[nodiscard]] Region page_of(const volatile void *address) noexcept
+    {
+        const auto raw = reinterpret_cast<std::uintptr_t>(address) & ~std::uintptr_t{0xFFF};
+        return Region{Address{raw}, 0x1000};
+    }
+
+    [[nodiscard]] memory::PointerMapOptions scope_of(std::span<const Region> ranges)
+    {
+        memory::PointerMapOptions options;
+        options.scope = RegionSet::of(ranges).value();
+        return options;
+    }
+
+    [[nodiscard]] std::vector<std::ptrdiff_t> offsets_of(const memory::PointerPath &path)
+    {
+        std::vector<std::ptrdiff_t> out;
+        for (const memory::ChainStep &step : path.steps)
+        {
+            out.push_back(step.offset);
+        }
+        return out;
+    }
+} // anonymous namespace
+
+TEST(PointerMap, FindsStaticRootedPathsRankedByDepthThatWalkToTheTarget)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    // g_deep_root -> node (arena + 0x1F80); node + 0x80 holds object (arena + 0x100); target is object + 0x40.
+    std::byte *const object = arena.at(0x100);
+    std::byte *const node = arena.at(0x1F80);
+    *reinterpret_cast<void **>(node + 0x80) = object;
+    g_deep_root = node;
+    g_direct_root = object;
+
+    const std::array<Region, 3> ranges = {arena.region(), page_of(&g_deep_root), page_of(&g_direct_root)};
+    const Result<memory::PointerMap> map = memory::PointerMap::build(scope_of(ranges));
+    ASSERT_TRUE(map.has_value());
+    EXPECT_GE(map->size(), 3u);
+    EXPECT_FALSE(map->incomplete());
+
+    const Address target{object + 0x40};
+    memory::PointerPathOptions options;
+    options.max_depth = 3;
+    options.max_offset = 0x100;
+    const Result<std::vector<memory::PointerPath>> paths = map->paths_to(target, options);
+    ASSERT_TRUE(paths.has_value());
+    ASSERT_GE(paths->size(), 2u);
+
+    const Region module = memory::module_of(Address{&g_direct_root});
+    ASSERT_NE(module.size, 0u);
+    const auto rva = [&](const volatile void *slot)
+    { return static_cast<std::ptrdiff_t>(reinterpret_cast<std::uintptr_t>(slot) - module.base.raw()); };
+
+    // Shallowest first: the direct root needs one dereference, the deep one two.
+    EXPECT_EQ((*paths)[0].base, module.base);
+    EXPECT_EQ(offsets_of((*paths)[0]), (std::vector<std::ptrdiff_t>{rva(&g_direct_root), 0x40}));
+    EXPECT_EQ((*paths)[1].base, module.base);
+    EXPECT_EQ(offsets_of((*paths)[1]), (std::vector<std::ptrdiff_t>{rva(&g_deep_root), 0x80, 0x40}));
+    for (const memory::PointerPath &path : *paths)
+    {
+        const Result<Address> leaf = memory::walk(path.base, path.steps);
+        ASSERT_TRUE(leaf.has_value());
+        EXPECT_EQ(*leaf, target);
+    }
+
+    g_deep_root = nullptr;
+    g_direct_root = nullptr;
+}
+
+TEST(PointerMap, DepthAndOffsetBoundsLimitTheSearchAndStalePathsAreDropped)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    std::byte *const object = arena.at(0x400);
+    std::byte *const node = arena.at(0x3000);
+    *reinterpret_cast<void **>(node) = object;
+    g_deep_root = node;
+
+    const std::array<Region, 2> ranges = {arena.region(), page_of(&g_deep_root)};
+    const Result<memory::PointerMap> map = memory::PointerMap::build(scope_of(ranges));
+    ASSERT_TRUE(map.has_value());
+    const Address target{object + 0x20};
+
+    memory::PointerPathOptions shallow;
+    shallow.max_depth = 1;
+    EXPECT_TRUE(map->paths_to(target, shallow).value().empty());
+
+    memory::PointerPathOptions narrow;
+    narrow.max_offset = 0x10;
+    EXPECT_TRUE(map->paths_to(target, narrow).value().empty());
+
+    ASSERT_EQ(map->paths_to(target).value().size(), 1u);
+
+    // The map still records the link, but the re-walk no longer reaches the target.
+    *reinterpret_cast<void **>(node) = arena.at(0x800);
+    EXPECT_TRUE(map->paths_to(target).value().empty());
+
+    g_deep_root = nullptr;
+}
+
+TEST(PointerMap, RejectsANullTargetAndEmptyBounds)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    const std::array<Region, 1> ranges = {arena.region()};
+    const Result<memory::PointerMap> map = memory::PointerMap::build(scope_of(ranges));
+    ASSERT_TRUE(map.has_value());
+
+    const auto null_target = map->paths_to(Address{});
+    ASSERT_FALSE(null_target.has_value());
+    EXPECT_EQ(null_target.error().code, ErrorCode::NullTargetAddress);
+
+    memory::PointerPathOptions no_depth;
+    no_depth.max_depth = 0;
+    const auto zero_depth = map->paths_to(Address{arena.at(0)}, no_depth);
+    ASSERT_FALSE(zero_depth.has_value());
+    EXPECT_EQ(zero_depth.error().code, ErrorCode::InvalidArg);
+}
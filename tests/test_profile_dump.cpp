@@ -0,0 +1,225 @@
+#include <gtest/gtest.h>
+
+#include "DetourModKit/profile_dump.hpp"
+#include "DetourModKit/profiler.hpp"
+
+#include <windows.h>
+#include <process.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace DetourModKit;
+
+namespace
+{
+    std::vector<std::byte> read_bytes(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        const std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        const auto *first = reinterpret_cast<const std::byte *>(text.data());
+        return std::vector<std::byte>(first, first + text.size());
+    }
+
+    std::string dump_path(const char *tag)
+    {
+        return std::format("dmk_profile_dump_{}_{}.bin", tag, _getpid());
+    }
+
+    class ProfileDumpTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override { Profiler::get_instance().reset(); }
+        void TearDown() override { Profiler::get_instance().reset(); }
+    };
+} // namespace
+
+TEST_F(ProfileDumpTest, ExportBinary_ConvertsToTheSameJsonAsADirectExport)
+{
+    auto &profiler = Profiler::get_instance();
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    profiler.record("camera_update", tick.QuadPart, tick.QuadPart + 5000, 11);
+    profiler.record("scope\"with\\special\tchars", tick.QuadPart + 10, tick.QuadPart + 20, 12);
+    profiler.record("camera_update", tick.QuadPart + 9000, tick.QuadPart + 9100, 11);
+
+    const std::string path = dump_path("roundtrip");
+    ASSERT_TRUE(profiler.export_binary(path));
+    const auto decoded = profile_dump::read_file(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(decoded.has_value());
+
+    EXPECT_FALSE(decoded->truncated);
+    EXPECT_EQ(decoded->qpc_frequency, profiler.qpc_frequency());
+    // The repeated scope name is written once.
+    ASSERT_EQ(decoded->names.size(), 2u);
+    ASSERT_EQ(decoded->samples.size(), 3u);
+    EXPECT_EQ(decoded->samples[0].name, decoded->samples[2].name);
+    EXPECT_EQ(decoded->samples[1].thread_id, 12u);
+    EXPECT_EQ(profile_dump::format_chrome_json(*decoded), profiler.export_chrome_json());
+}
+
+TEST_F(ProfileDumpTest, ExportBinary_ExpandsCompactSamples)
+{
+    static_assert(sizeof(ProfileSample) == 16);
+    auto &profiler = Profiler::get_instance();
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    // A start too far from its block's base and a counter beyond 32 bits each take an extension slot; the samples
+    // either side of them are stored against the block base.
+    const int64_t far_start = tick.QuadPart + (int64_t{1} << 40);
+    profiler.record("near", tick.QuadPart, tick.QuadPart + 100, 7);
+    profiler.record("far", far_start, far_start + 100, 0xFEDCBA98u);
+    profiler.record_counter("wide_counter", INT64_MIN + 5);
+    profiler.record("near", tick.QuadPart + 200, tick.QuadPart + 300, 7);
+    EXPECT_EQ(profiler.total_samples_recorded(), 4u);
+    EXPECT_EQ(profiler.available_samples(), 4u);
+
+    const std::string path = dump_path("compact");
+    ASSERT_TRUE(profiler.export_binary(path));
+    const auto decoded = profile_dump::read_file(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->samples.size(), 4u);
+
+    const auto &samples = decoded->samples;
+    EXPECT_EQ(decoded->names[samples[0].name], "near");
+    EXPECT_EQ(samples[0].start_ticks, tick.QuadPart);
+    EXPECT_EQ(samples[0].thread_id, 7u);
+    EXPECT_EQ(decoded->names[samples[1].name], "far");
+    EXPECT_EQ(samples[1].start_ticks, far_start);
+    EXPECT_EQ(samples[1].thread_id, 0xFEDCBA98u);
+    EXPECT_EQ(samples[2].kind, profile_dump::SampleKind::Counter);
+    EXPECT_EQ(samples[2].value, INT64_MIN + 5);
+    EXPECT_EQ(samples[2].thread_id, static_cast<std::uint32_t>(GetCurrentThreadId()));
+    EXPECT_EQ(samples[3].start_ticks, tick.QuadPart + 200);
+    EXPECT_EQ(samples[3].name, samples[0].name);
+}
+
+TEST_F(ProfileDumpTest, ExportBinary_IsSmallerThanTheJson)
+{
+    auto &profiler = Profiler::get_instance();
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    constexpr int samples = 1000;
+    for (int i = 0; i < samples; ++i)
+    {
+        profiler.record("hot_path", tick.QuadPart + i * 100, tick.QuadPart + i * 100 + 42, GetCurrentThreadId());
+    }
+
+    const std::string path = dump_path("size");
+    ASSERT_TRUE(profiler.export_binary(path));
+    const std::vector<std::byte> image = read_bytes(path);
+    std::remove(path.c_str());
+
+    // Header, one name record, and a fixed-size record per sample.
+    const size_t name_record = 7 + std::strlen("hot_path");
+    EXPECT_EQ(image.size(),
+              profile_dump::DUMP_HEADER_SIZE + name_record + samples * profile_dump::DUMP_SAMPLE_RECORD_SIZE);
+    EXPECT_LT(image.size() * 4, profiler.export_chrome_json().size());
+}
+
+TEST_F(ProfileDumpTest, EmptyProfiler_DumpsHeaderOnly)
+{
+    const std::string path = dump_path("empty");
+    ASSERT_TRUE(Profiler::get_instance().export_binary(path));
+    const auto decoded = profile_dump::read_file(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->samples.empty());
+    EXPECT_FALSE(decoded->truncated);
+    EXPECT_EQ(profile_dump::format_chrome_json(*decoded), "[]");
+}
+
+TEST_F(ProfileDumpTest, Decode_CutShortKeepsWholeRecords)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.record("first", 1000, 2000, 1);
+    profiler.record("second", 3000, 4000, 1);
+
+    const std::string path = dump_path("cut");
+    ASSERT_TRUE(profiler.export_binary(path));
+    std::vector<std::byte> image = read_bytes(path);
+    std::remove(path.c_str());
+
+    image.resize(image.size() - 5);
+    const auto decoded = profile_dump::decode(image);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_TRUE(decoded->truncated);
+    ASSERT_EQ(decoded->samples.size(), 1u);
+    EXPECT_EQ(decoded->names[decoded->samples[0].name], "first");
+    EXPECT_EQ(decoded->samples[0].start_ticks, 1000);
+}
+
+TEST_F(ProfileDumpTest, Decode_RejectsAnImageWithoutTheHeader)
+{
+    std::vector<std::byte> image(profile_dump::DUMP_HEADER_SIZE, std::byte{0});
+    const auto decoded = profile_dump::decode(image);
+    ASSERT_FALSE(decoded.has_value());
+    EXPECT_EQ(decoded.error().code, ErrorCode::MissingHeader);
+
+    const auto missing = profile_dump::read_file(dump_path("does_not_exist"));
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, ErrorCode::FileOpenFailed);
+}
+
+TEST_F(ProfileDumpTest, ExportBinary_CarriesCountersAndFlows)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.record("scope", 1000, 2000, 1);
+    profiler.record_counter("depth", -5);
+    const std::uint64_t flow = profiler.new_flow_id();
+    profiler.record_flow_begin("handoff", flow);
+    profiler.record_flow_end("handoff", flow);
+
+    const std::string path = dump_path("values");
+    ASSERT_TRUE(profiler.export_binary(path));
+    const std::vector<std::byte> image = read_bytes(path);
+    std::remove(path.c_str());
+    const auto decoded = profile_dump::decode(image);
+    ASSERT_TRUE(decoded.has_value());
+
+    EXPECT_FALSE(decoded->truncated);
+    ASSERT_EQ(decoded->samples.size(), 4u);
+    EXPECT_EQ(decoded->samples[0].kind, profile_dump::SampleKind::Duration);
+    EXPECT_EQ(decoded->samples[1].kind, profile_dump::SampleKind::Counter);
+    EXPECT_EQ(decoded->samples[1].value, -5);
+    EXPECT_EQ(decoded->samples[2].kind, profile_dump::SampleKind::FlowBegin);
+    EXPECT_EQ(decoded->samples[3].kind, profile_dump::SampleKind::FlowEnd);
+    EXPECT_EQ(static_cast<std::uint64_t>(decoded->samples[3].value), flow);
+    EXPECT_EQ(profile_dump::format_chrome_json(*decoded), profiler.export_chrome_json());
+
+    const size_t names = 3 * 7 + std::strlen("scope") + std::strlen("depth") + std::strlen("handoff");
+    EXPECT_EQ(image.size(), profile_dump::DUMP_HEADER_SIZE + names + profile_dump::DUMP_SAMPLE_RECORD_SIZE +
+                                3 * profile_dump::DUMP_VALUE_RECORD_SIZE);
+}
+
+TEST_F(ProfileDumpTest, Decode_ReadsAVersion1Dump)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.record("old_format", 1000, 2000, 1);
+
+    const std::string path = dump_path("v1");
+    ASSERT_TRUE(profiler.export_binary(path));
+    std::vector<std::byte> image = read_bytes(path);
+    std::remove(path.c_str());
+
+    // A duration-only dump is laid out as version 1 wrote it; only the header's version differs.
+    const std::uint32_t version = 1;
+    std::memcpy(image.data() + 8, &version, sizeof(version));
+    const auto decoded = profile_dump::decode(image);
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(decoded->samples.size(), 1u);
+    EXPECT_EQ(decoded->names[decoded->samples[0].name], "old_format");
+
+    const std::uint32_t future = profile_dump::DUMP_VERSION + 1;
+    std::memcpy(image.data() + 8, &future, sizeof(future));
+    EXPECT_FALSE(profile_dump::decode(image).has_value());
+}
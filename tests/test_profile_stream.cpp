@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+
+#include "DetourModKit/profile_stream.hpp"
+#include "DetourModKit/profiler.hpp"
+
+#include <windows.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace DetourModKit;
+using namespace DetourModKit::profile_stream;
+
+namespace
+{
+    class ProfileStreamTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            Profiler::get_instance().reset();
+            ASSERT_TRUE(Profiler::get_instance().start_stream().has_value());
+        }
+
+        void TearDown() override
+        {
+            Profiler::get_instance().stop_stream();
+            Profiler::get_instance().reset();
+        }
+
+        /// A reader past everything earlier tests published: the stream outlives each test.
+        [[nodiscard]] static StreamReader caught_up_reader()
+        {
+            auto reader = StreamReader::open(static_cast<std::uint32_t>(GetCurrentProcessId()));
+            EXPECT_TRUE(reader.has_value());
+            std::vector<StreamSample> backlog;
+            while (reader->poll(backlog) != 0)
+            {
+                backlog.clear();
+            }
+            return std::move(*reader);
+        }
+    };
+} // namespace
+
+TEST_F(ProfileStreamTest, Reader_SeesSamplesAsTheyAreRecorded)
+{
+    auto &profiler = Profiler::get_instance();
+    StreamReader reader = caught_up_reader();
+    EXPECT_TRUE(reader.producer_live());
+    EXPECT_EQ(reader.qpc_frequency(), profiler.qpc_frequency());
+
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    profiler.record("stream_first", tick.QuadPart, tick.QuadPart + profiler.qpc_frequency(), 21);
+    profiler.record("stream_second", tick.QuadPart + 10, tick.QuadPart + 20, 22);
+    profiler.record("stream_first", tick.QuadPart + 30, tick.QuadPart + 40, 21);
+
+    std::vector<StreamSample> samples;
+    ASSERT_EQ(reader.poll(samples), 3u);
+    EXPECT_EQ(reader.name(samples[0].name), "stream_first");
+    EXPECT_EQ(reader.name(samples[1].name), "stream_second");
+    // A name is entered once and shared by its later samples.
+    EXPECT_EQ(samples[2].name, samples[0].name);
+    EXPECT_EQ(samples[0].start_ticks, tick.QuadPart);
+    EXPECT_EQ(samples[0].duration_us, 1'000'000u);
+    EXPECT_EQ(samples[1].thread_id, 22u);
+    EXPECT_EQ(reader.dropped(), 0u);
+
+    // Nothing new, nothing returned.
+    samples.clear();
+    EXPECT_EQ(reader.poll(samples), 0u);
+}
+
+TEST_F(ProfileStreamTest, Poll_TakesAtMostTheAskedNumber)
+{
+    auto &profiler = Profiler::get_instance();
+    StreamReader reader = caught_up_reader();
+    for (int i = 0; i < 10; ++i)
+    {
+        profiler.record("stream_batched", i, i + 1, 1);
+    }
+
+    std::vector<StreamSample> samples;
+    EXPECT_EQ(reader.poll(samples, 4), 4u);
+    EXPECT_EQ(reader.poll(samples), 6u);
+    EXPECT_EQ(samples.size(), 10u);
+    EXPECT_EQ(samples[9].start_ticks, 9);
+}
+
+TEST_F(ProfileStreamTest, SlowReader_CountsWhatItMissed)
+{
+    auto &profiler = Profiler::get_instance();
+    StreamReader reader = caught_up_reader();
+    constexpr std::size_t overflow = 100;
+    for (std::size_t i = 0; i < STREAM_SLOT_COUNT + overflow; ++i)
+    {
+        profiler.record("stream_flood", static_cast<int64_t>(i), static_cast<int64_t>(i) + 1, 1);
+    }
+
+    std::vector<StreamSample> samples;
+    EXPECT_EQ(reader.poll(samples), STREAM_SLOT_COUNT);
+    EXPECT_EQ(reader.dropped(), overflow);
+    // The oldest samples went; what is left follows on from them.
+    EXPECT_EQ(samples.front().start_ticks, static_cast<int64_t>(overflow));
+}
+
+TEST_F(ProfileStreamTest, StopStream_StopsPublishing)
+{
+    auto &profiler = Profiler::get_instance();
+    StreamReader reader = caught_up_reader();
+    EXPECT_TRUE(profiler.is_streaming());
+
+    profiler.stop_stream();
+    EXPECT_FALSE(profiler.is_streaming());
+    EXPECT_FALSE(reader.producer_live());
+    profiler.record("stream_after_stop", 0, 1, 1);
+    std::vector<StreamSample> samples;
+    EXPECT_EQ(reader.poll(samples), 0u);
+    // The profiler's own rings are unaffected.
+    EXPECT_EQ(profiler.total_samples_recorded(), 1u);
+
+    // Starting again reuses the mapping the reader already follows.
+    ASSERT_TRUE(profiler.start_stream().has_value());
+    EXPECT_TRUE(reader.producer_live());
+    profiler.record("stream_restarted", 0, 1, 1);
+    ASSERT_EQ(reader.poll(samples), 1u);
+    EXPECT_EQ(reader.name(samples[0].name), "stream_restarted");
+}
+
+TEST(ProfileStreamReaderTest, Open_FailsForAProcessWithoutAStream)
+{
+    // The System process never runs DetourModKit.
+    const auto reader = StreamReader::open(4);
+    ASSERT_FALSE(reader.has_value());
+    EXPECT_EQ(reader.error().code, ErrorCode::SystemCallFailed);
+}
@@ -7,6 +7,8 @@
 #include <charconv>
 #include <chrono>
 #include <cstdio>
+#include <format>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <system_error>
@@ -62,7 +64,14 @@ class ProfilerRecordTest : public ::testing::Test
 {
 protected:
     void SetUp() override { Profiler::get_instance().reset(); }
-    void TearDown() override { Profiler::get_instance().reset(); }
+    // set_clock() and set_frame_budget_us() reset too; they also put back the default clock and budget for a test
+    // that changed them, even when it failed midway.
+    void TearDown() override
+    {
+        auto &profiler = Profiler::get_instance();
+        (void)profiler.set_clock(ProfilerClock::Qpc);
+        profiler.set_frame_budget_us(0);
+    }
 };
 
 TEST_F(ProfilerRecordTest, ConcurrentRecordAndExport_SeqlockPayloadRaceFree)
@@ -370,6 +379,65 @@ TEST_F(ProfilerRecordTest, ConcurrentRecord_NoDataRace)
     EXPECT_EQ(profiler.total_samples_recorded(), static_cast<size_t>(threads * samples_per_thread));
 }
 
+// Each recording thread writes its own ring, so a thread that wraps its ring evicts only its own samples. Under the
+// old single shared ring the worker's cap + 5 samples would have overwritten all of the main thread's.
+TEST_F(ProfilerRecordTest, PerThreadRings_WrapIndependently)
+{
+    auto &profiler = Profiler::get_instance();
+    const size_t cap = profiler.capacity();
+
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    for (int i = 0; i < 10; ++i)
+    {
+        profiler.record("main_keep", tick.QuadPart, tick.QuadPart + 100, GetCurrentThreadId());
+    }
+
+    std::thread worker(
+        [&profiler, cap]()
+        {
+            LARGE_INTEGER worker_tick;
+            QueryPerformanceCounter(&worker_tick);
+            for (size_t i = 0; i < cap + 5; ++i)
+            {
+                profiler.record("worker_wrap", worker_tick.QuadPart, worker_tick.QuadPart + 1, GetCurrentThreadId());
+            }
+        });
+    worker.join();
+
+    EXPECT_EQ(profiler.total_samples_recorded(), cap + 15);
+    EXPECT_EQ(profiler.available_samples(), cap + 10);
+
+    const std::string json = profiler.export_chrome_json();
+    size_t kept = 0;
+    for (size_t pos = json.find("\"main_keep\""); pos != std::string::npos; pos = json.find("\"main_keep\"", pos + 1))
+    {
+        ++kept;
+    }
+    EXPECT_EQ(kept, 10u);
+}
+
+// reset() keeps every thread's ring but clears it, so samples from a thread that has since exited do not reappear.
+TEST_F(ProfilerRecordTest, Reset_ClearsOtherThreadsRings)
+{
+    auto &profiler = Profiler::get_instance();
+
+    std::thread worker(
+        [&profiler]()
+        {
+            LARGE_INTEGER tick;
+            QueryPerformanceCounter(&tick);
+            profiler.record("worker_before_reset", tick.QuadPart, tick.QuadPart + 100, GetCurrentThreadId());
+        });
+    worker.join();
+    ASSERT_EQ(profiler.total_samples_recorded(), 1u);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.total_samples_recorded(), 0u);
+    EXPECT_EQ(profiler.available_samples(), 0u);
+    EXPECT_EQ(profiler.export_chrome_json(), "[]");
+}
+
 TEST_F(ProfilerRecordTest, ConcurrentScopedProfile_NoDataRace)
 {
     auto &profiler = Profiler::get_instance();
@@ -424,7 +492,7 @@ TEST_F(ProfilerRecordTest, ConcurrentRecordAndExport_NoTornReads)
     }
 
     // Reader thread: export while writers are active. Loop until the window closes AND at least one export has
-    // completed. A full 65536-sample buffer serializes to a multi-megabyte string, so on a loaded runner a single
+    // completed. A full 131072-sample buffer serializes to a multi-megabyte string, so on a loaded runner a single
     // export can outlast the 50 ms window; keying the exit on a completed export (not on wall-clock alone) keeps
     // export_count deterministic instead of letting it flake at 0.
     std::thread reader(
@@ -482,6 +550,29 @@ TEST_F(ProfilerRecordTest, ProfileFunctionMacro_RecordsSample)
     EXPECT_EQ(profiler.total_samples_recorded(), 1u);
 }
 
+TEST_F(ProfilerRecordTest, ProfileFrameMacro_AdvancesTheFrame)
+{
+    auto &profiler = Profiler::get_instance();
+
+    DMK_PROFILE_FRAME();
+    DMK_PROFILE_FRAME();
+
+    EXPECT_EQ(profiler.frame_index(), 2u);
+    EXPECT_EQ(profiler.total_samples_recorded(), 1u);
+}
+
+TEST_F(ProfilerRecordTest, ProfileCounterAndFlowMacros_RecordSamples)
+{
+    auto &profiler = Profiler::get_instance();
+
+    DMK_PROFILE_COUNTER("macro_counter", 3u);
+    const uint64_t flow = profiler.new_flow_id();
+    DMK_PROFILE_FLOW_BEGIN("macro_flow", flow);
+    DMK_PROFILE_FLOW_END("macro_flow", flow);
+
+    EXPECT_EQ(profiler.total_samples_recorded(), 3u);
+}
+
 #else
 
 TEST_F(ProfilerRecordTest, ProfileScopeMacro_IsNoOpWhenDisabled)
@@ -721,3 +812,390 @@ TEST_F(ProfilerRecordTest, ExportToFile_ContentMatchesChromeJson)
 
     EXPECT_EQ(content, expected);
 }
+
+// export_to_file() streams through a fixed chunk rather than building the whole JSON string; a file several chunks
+// long must still match the string export byte for byte.
+TEST_F(ProfilerRecordTest, ExportToFile_StreamsPastOneChunk)
+{
+    auto &profiler = Profiler::get_instance();
+
+    LARGE_INTEGER tick;
+    QueryPerformanceCounter(&tick);
+    for (int i = 0; i < 4000; ++i)
+    {
+        profiler.record("chunked_export", tick.QuadPart + i, tick.QuadPart + i + 50, 1);
+    }
+
+    const std::string expected = profiler.export_chrome_json();
+    ASSERT_GT(expected.size(), 3 * Profiler::EXPORT_CHUNK_SIZE);
+
+    const std::string path = std::format("dmk_profiler_chunk_test_{}.json", _getpid());
+    ASSERT_TRUE(profiler.export_to_file(path));
+
+    std::FILE *fp = open_binary_file(path);
+    ASSERT_NE(fp, nullptr);
+    std::string content;
+    char buffer[4096];
+    size_t read = 0;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), fp)) > 0)
+    {
+        content.append(buffer, read);
+    }
+    std::fclose(fp);
+    std::remove(path.c_str());
+
+    EXPECT_EQ(content, expected);
+}
+
+// Online scope statistics
+
+static_assert(ScopeStats::bucket_of(0) == 0);
+static_assert(ScopeStats::bucket_of(7) == 7);
+static_assert(ScopeStats::bucket_of(8) == 8);
+static_assert(ScopeStats::bucket_of(16) == 16);
+static_assert(ScopeStats::bucket_of(17) == 16);
+static_assert(ScopeStats::bucket_of(UINT32_MAX) == ScopeStats::HISTOGRAM_BUCKETS - 1);
+static_assert(ScopeStats::bucket_upper_bound(ScopeStats::HISTOGRAM_BUCKETS - 1) == UINT32_MAX);
+
+namespace
+{
+    /// Ticks that record() turns into exactly @p duration_us microseconds.
+    [[nodiscard]] int64_t ticks_for_us(uint32_t duration_us) noexcept
+    {
+        const int64_t frequency = Profiler::get_instance().qpc_frequency();
+        // Round up so the truncating conversion in record() lands on duration_us, not one below it.
+        return (static_cast<int64_t>(duration_us) * frequency + 999'999) / 1'000'000;
+    }
+} // anonymous namespace
+
+TEST(ScopeStatsTest, Buckets_AreContiguousAndWithinOneEighth)
+{
+    for (uint32_t value : {1u, 9u, 100u, 1'000u, 65'535u, 1'000'000u, 123'456'789u, UINT32_MAX - 1})
+    {
+        const size_t bucket = ScopeStats::bucket_of(value);
+        const uint32_t upper = ScopeStats::bucket_upper_bound(bucket);
+        EXPECT_GE(upper, value);
+        EXPECT_LE(static_cast<double>(upper - value), static_cast<double>(value) / 8.0);
+        if (bucket > 0)
+        {
+            EXPECT_EQ(ScopeStats::bucket_of(ScopeStats::bucket_upper_bound(bucket - 1) + 1), bucket);
+        }
+    }
+}
+
+TEST_F(ProfilerRecordTest, Stats_TrackCountTotalMinAndMax)
+{
+    auto &profiler = Profiler::get_instance();
+    const int64_t base = 1'000'000;
+    for (uint32_t us : {10u, 20u, 30u, 40u})
+    {
+        profiler.record("stats_basic", base, base + ticks_for_us(us), 1);
+    }
+    profiler.record("stats_other", base, base + ticks_for_us(5), 1);
+
+    const std::vector<ScopeStats> all = profiler.stats();
+    ASSERT_EQ(all.size(), 2u);
+    EXPECT_STREQ(all[0].name, "stats_basic");
+    EXPECT_STREQ(all[1].name, "stats_other");
+
+    const std::optional<ScopeStats> basic = profiler.scope_stats("stats_basic");
+    ASSERT_TRUE(basic.has_value());
+    EXPECT_EQ(basic->count, 4u);
+    EXPECT_EQ(basic->total_us, 100u);
+    EXPECT_EQ(basic->min_us, 10u);
+    EXPECT_EQ(basic->max_us, 40u);
+    EXPECT_DOUBLE_EQ(basic->mean_us(), 25.0);
+    EXPECT_FALSE(profiler.scope_stats("never_recorded").has_value());
+}
+
+TEST_F(ProfilerRecordTest, Stats_PercentilesComeFromTheHistogram)
+{
+    auto &profiler = Profiler::get_instance();
+    const int64_t base = 1'000'000;
+    for (int i = 0; i < 99; ++i)
+    {
+        profiler.record("stats_tail", base, base + ticks_for_us(100), 1);
+    }
+    profiler.record("stats_tail", base, base + ticks_for_us(10'000), 1);
+
+    const std::optional<ScopeStats> tail = profiler.scope_stats("stats_tail");
+    ASSERT_TRUE(tail.has_value());
+    const uint32_t p50 = tail->percentile_us(0.5);
+    EXPECT_GE(p50, 100u);
+    EXPECT_LE(p50, 100u + 100u / 8);
+    EXPECT_LE(tail->percentile_us(0.99), 100u + 100u / 8);
+    EXPECT_EQ(tail->percentile_us(1.0), 10'000u);
+}
+
+// The totals count every sample, so they keep what the ring has already wrapped away.
+TEST_F(ProfilerRecordTest, Stats_SurviveRingWrap)
+{
+    auto &profiler = Profiler::get_instance();
+    const size_t total = profiler.capacity() + 100;
+    for (size_t i = 0; i < total; ++i)
+    {
+        profiler.record("stats_wrap", 0, ticks_for_us(3), 1);
+    }
+    EXPECT_EQ(profiler.available_samples(), profiler.capacity());
+    const std::optional<ScopeStats> wrapped = profiler.scope_stats("stats_wrap");
+    ASSERT_TRUE(wrapped.has_value());
+    EXPECT_EQ(wrapped->count, total);
+    EXPECT_EQ(wrapped->histogram[ScopeStats::bucket_of(3)], total);
+}
+
+TEST_F(ProfilerRecordTest, Stats_MergeAcrossThreadsAndClearOnReset)
+{
+    auto &profiler = Profiler::get_instance();
+    constexpr int threads = 4;
+    constexpr int per_thread = 1000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t)
+    {
+        workers.emplace_back(
+            [&profiler]()
+            {
+                for (int i = 0; i < per_thread; ++i)
+                {
+                    profiler.record("stats_threads", 0, ticks_for_us(7), GetCurrentThreadId());
+                }
+            });
+    }
+    for (auto &w : workers)
+    {
+        w.join();
+    }
+
+    const std::optional<ScopeStats> merged = profiler.scope_stats("stats_threads");
+    ASSERT_TRUE(merged.has_value());
+    EXPECT_EQ(merged->count, static_cast<uint64_t>(threads * per_thread));
+    EXPECT_EQ(merged->total_us, static_cast<uint64_t>(threads * per_thread * 7));
+
+    profiler.reset();
+    EXPECT_TRUE(profiler.stats().empty());
+}
+
+// Profiler clock
+
+TEST_F(ProfilerRecordTest, Clock_DefaultsToQpc)
+{
+    const auto &profiler = Profiler::get_instance();
+    EXPECT_EQ(profiler.clock(), ProfilerClock::Qpc);
+    EXPECT_EQ(profiler.tick_frequency(), profiler.qpc_frequency());
+}
+
+// On a CPU with an invariant TSC the clock switches and is calibrated; elsewhere it must stay on QPC. Either way a
+// scope's duration is in microseconds and its timestamp on the QPC timeline, so traces from both clocks line up.
+TEST_F(ProfilerRecordTest, Clock_TscCalibratesOrFallsBack)
+{
+    auto &profiler = Profiler::get_instance();
+    const ProfilerClock active = profiler.set_clock(ProfilerClock::Tsc);
+    EXPECT_EQ(active, profiler.clock());
+    if (!Profiler::tsc_is_invariant())
+    {
+        EXPECT_EQ(active, ProfilerClock::Qpc);
+        EXPECT_EQ(profiler.tick_frequency(), profiler.qpc_frequency());
+        return;
+    }
+    ASSERT_EQ(active, ProfilerClock::Tsc);
+    EXPECT_GT(profiler.tick_frequency(), profiler.qpc_frequency());
+
+    LARGE_INTEGER before;
+    QueryPerformanceCounter(&before);
+    {
+        ScopedProfile sp("tsc_scope");
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    LARGE_INTEGER after;
+    QueryPerformanceCounter(&after);
+
+    const std::optional<ScopeStats> scope = profiler.scope_stats("tsc_scope");
+    ASSERT_TRUE(scope.has_value());
+    const auto wall_us = static_cast<uint32_t>((after.QuadPart - before.QuadPart) * 1'000'000 /
+                                               profiler.qpc_frequency());
+    EXPECT_GE(scope->max_us, 4'000u);
+    EXPECT_LE(scope->max_us, wall_us + 1'000u);
+
+    // The exported timestamp falls inside the QPC window the scope ran in.
+    const std::string json = profiler.export_chrome_json();
+    constexpr std::string_view ts_marker{"\"ts\":"};
+    const size_t ts_pos = json.find(ts_marker);
+    ASSERT_NE(ts_pos, std::string::npos);
+    double ts = 0.0;
+    const auto [ptr, ec] = std::from_chars(json.data() + ts_pos + ts_marker.size(), json.data() + json.size(), ts);
+    ASSERT_EQ(ec, std::errc{});
+    const double ticks_to_us = 1'000'000.0 / static_cast<double>(profiler.qpc_frequency());
+    EXPECT_GE(ts, static_cast<double>(before.QuadPart) * ticks_to_us - 1'000.0);
+    EXPECT_LE(ts, static_cast<double>(after.QuadPart) * ticks_to_us + 1'000.0);
+
+    EXPECT_EQ(profiler.set_clock(ProfilerClock::Qpc), ProfilerClock::Qpc);
+    EXPECT_EQ(profiler.tick_frequency(), profiler.qpc_frequency());
+}
+
+// Sampling and frames
+
+namespace
+{
+    /// Spins until @p duration_us has passed on the profiler's clock, so a frame is reliably longer than a budget.
+    void spin_for_us(int64_t duration_us) noexcept
+    {
+        const auto &profiler = Profiler::get_instance();
+        const int64_t end = profiler.now_ticks() + duration_us * profiler.tick_frequency() / 1'000'000;
+        while (profiler.now_ticks() < end)
+        {
+        }
+    }
+} // anonymous namespace
+
+TEST_F(ProfilerRecordTest, SampleRate_TimesOneCallInN)
+{
+    auto &profiler = Profiler::get_instance();
+    ASSERT_TRUE(profiler.set_sample_rate("sampled_scope", 4));
+    EXPECT_EQ(profiler.sample_rate("sampled_scope"), 4u);
+    EXPECT_EQ(profiler.sample_rate("unsampled_scope"), 1u);
+
+    for (int i = 0; i < 20; ++i)
+    {
+        ScopedProfile sampled("sampled_scope");
+        ScopedProfile unsampled("unsampled_scope");
+    }
+
+    const std::optional<ScopeStats> sampled = profiler.scope_stats("sampled_scope");
+    ASSERT_TRUE(sampled.has_value());
+    EXPECT_EQ(sampled->count, 5u);
+    EXPECT_EQ(sampled->skipped, 15u);
+    const std::optional<ScopeStats> unsampled = profiler.scope_stats("unsampled_scope");
+    ASSERT_TRUE(unsampled.has_value());
+    EXPECT_EQ(unsampled->count, 20u);
+    EXPECT_EQ(unsampled->skipped, 0u);
+    // A skipped call leaves no sample in the ring.
+    EXPECT_EQ(profiler.total_samples_recorded(), 25u);
+
+    // A rate of 1 times every call again, from the next one on.
+    ASSERT_TRUE(profiler.set_sample_rate("sampled_scope", 1));
+    for (int i = 0; i < 3; ++i)
+    {
+        ScopedProfile sampled_again("sampled_scope");
+    }
+    EXPECT_EQ(profiler.scope_stats("sampled_scope")->count, 8u);
+    EXPECT_EQ(profiler.sample_rate("sampled_scope"), 1u);
+}
+
+TEST_F(ProfilerRecordTest, SampleRate_TableFillsUp)
+{
+    auto &profiler = Profiler::get_instance();
+    std::vector<std::string> names;
+    bool full = false;
+    for (size_t i = 0; i <= Profiler::MAX_SAMPLE_RATES && !full; ++i)
+    {
+        names.push_back(std::format("rate_table_{}", i));
+        full = !profiler.set_sample_rate(names.back(), 2);
+    }
+    // Earlier tests may have taken entries of their own, so the table fills at the latest on the extra name.
+    EXPECT_TRUE(full);
+    // A name already in the table can still be changed.
+    EXPECT_TRUE(profiler.set_sample_rate(names.front(), 3));
+    EXPECT_EQ(profiler.sample_rate(names.front()), 3u);
+
+    // Clearing a rate frees its entry for a new name.
+    for (const std::string &name : names)
+    {
+        EXPECT_TRUE(profiler.set_sample_rate(name, 1));
+    }
+    EXPECT_EQ(profiler.sample_rate(names.front()), 1u);
+    EXPECT_TRUE(profiler.set_sample_rate("rate_table_after_clear", 2));
+    EXPECT_TRUE(profiler.set_sample_rate("rate_table_after_clear", 0));
+}
+
+TEST_F(ProfilerRecordTest, MarkFrame_TagsFramesAndRecordsTheirTimes)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.record("before_frames", 0, 10, 1);
+    profiler.mark_frame();
+    EXPECT_EQ(profiler.frame_index(), 1u);
+    profiler.record("inside_frame", 0, 10, 1);
+    profiler.mark_frame();
+    EXPECT_EQ(profiler.frame_index(), 2u);
+
+    // Without a budget every frame is kept, and each closed frame adds a sample of its own.
+    const std::string json = profiler.export_chrome_json();
+    EXPECT_NE(json.find("before_frames"), std::string::npos);
+    EXPECT_NE(json.find("inside_frame"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"frame")"), std::string::npos);
+    EXPECT_EQ(profiler.total_samples_recorded(), 3u);
+    EXPECT_EQ(profiler.scope_stats(Profiler::FRAME_SAMPLE_NAME)->count, 1u);
+    EXPECT_EQ(profiler.frames_over_budget(), 0u);
+
+    profiler.reset();
+    EXPECT_EQ(profiler.frame_index(), 0u);
+}
+
+TEST_F(ProfilerRecordTest, FrameBudget_KeepsOnlyFramesOverIt)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.set_frame_budget_us(20'000);
+    EXPECT_EQ(profiler.frame_budget_us(), 20'000u);
+
+    profiler.mark_frame();
+    // Frame 1 is well under budget; a worker records in it too and never records again.
+    profiler.record("fast_work", 0, 10, 1);
+    std::thread worker([&profiler]() { profiler.record("worker_fast_work", 0, 10, 2); });
+    worker.join();
+    profiler.mark_frame();
+
+    // Frame 2 runs over.
+    profiler.record("slow_work", 0, 10, 1);
+    spin_for_us(40'000);
+    profiler.mark_frame();
+    profiler.record("next_frame_work", 0, 10, 1);
+
+    EXPECT_EQ(profiler.frames_over_budget(), 1u);
+    const std::string json = profiler.export_chrome_json();
+    EXPECT_EQ(json.find("fast_work"), std::string::npos);
+    EXPECT_EQ(json.find("worker_fast_work"), std::string::npos);
+    EXPECT_NE(json.find("slow_work"), std::string::npos);
+    EXPECT_NE(json.find(R"("name":"frame")"), std::string::npos);
+    // The open frame is not judged yet.
+    EXPECT_NE(json.find("next_frame_work"), std::string::npos);
+
+    // This thread's ring took back frame 1's two slots; the worker's sample waits in its ring, hidden from exports.
+    EXPECT_EQ(profiler.total_samples_recorded(), 4u);
+    // Statistics still count every sample.
+    EXPECT_EQ(profiler.scope_stats("fast_work")->count, 1u);
+    EXPECT_EQ(profiler.scope_stats(Profiler::FRAME_SAMPLE_NAME)->count, 2u);
+}
+
+// Counters and flows
+
+TEST_F(ProfilerRecordTest, Counter_ExportsAsAChromeCounterEvent)
+{
+    auto &profiler = Profiler::get_instance();
+    profiler.record_counter("queue_depth", 7);
+    profiler.record_counter("queue_depth", -2);
+    profiler.record_counter(nullptr, 1);
+
+    EXPECT_EQ(profiler.total_samples_recorded(), 2u);
+    const std::string json = profiler.export_chrome_json();
+    EXPECT_NE(json.find(R"({"name":"queue_depth","ph":"C",)"), std::string::npos);
+    EXPECT_NE(json.find(R"("args":{"value":7}})"), std::string::npos);
+    EXPECT_NE(json.find(R"("args":{"value":-2}})"), std::string::npos);
+    // A counter is a value, not a duration: it stays out of the scope statistics.
+    EXPECT_FALSE(profiler.scope_stats("queue_depth").has_value());
+}
+
+TEST_F(ProfilerRecordTest, Flow_ExportsAsAMatchedStartAndEnd)
+{
+    auto &profiler = Profiler::get_instance();
+    const uint64_t flow = profiler.new_flow_id();
+    EXPECT_NE(flow, 0u);
+    EXPECT_NE(profiler.new_flow_id(), flow);
+
+    profiler.record_flow_begin("handoff", flow);
+    std::thread consumer([&profiler, flow]() { profiler.record_flow_end("handoff", flow); });
+    consumer.join();
+
+    const std::string json = profiler.export_chrome_json();
+    const std::string id = std::format(R"("id":{},)", flow);
+    EXPECT_NE(json.find(R"({"name":"handoff","cat":"flow","ph":"s",)" + id), std::string::npos);
+    EXPECT_NE(json.find(R"({"name":"handoff","cat":"flow","ph":"f","bp":"e",)" + id), std::string::npos);
+    EXPECT_FALSE(profiler.scope_stats("handoff").has_value());
+}
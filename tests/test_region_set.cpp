@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+
+#include "DetourModKit/region_set.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    [[nodiscard]] Region span_at(std::uintptr_t base, std::size_t size) noexcept
+    {
+        return Region{Address{base}, size};
+    }
+} // namespace
+
+TEST(RegionSet, OfSortsAndCoalescesOverlappingAndTouchingSpans)
+{
+    const std::array<Region, 5> input = {
+        span_at(0x50000, 0x1000), // isolated
+        span_at(0x10000, 0x2000), // overlaps the next one
+        span_at(0x11000, 0x3000),
+        span_at(0x14000, 0x1000), // touches the merged run's end
+        span_at(0x30000, 0),      // empty: skipped
+    };
+    const Result<RegionSet> set = RegionSet::of(input);
+    ASSERT_TRUE(set.has_value());
+
+    ASSERT_EQ(set->ranges().size(), 2u);
+    EXPECT_EQ(set->ranges()[0].base.raw(), 0x10000u);
+    EXPECT_EQ(set->ranges()[0].size, 0x5000u);
+    EXPECT_EQ(set->ranges()[1].base.raw(), 0x50000u);
+    EXPECT_EQ(set->ranges()[1].size, 0x1000u);
+    EXPECT_EQ(set->byte_size(), 0x6000u);
+    EXPECT_EQ(set->bounds().base.raw(), 0x10000u);
+    EXPECT_EQ(set->bounds().size, 0x41000u);
+}
+
+TEST(RegionSet, MembershipIsHalfOpenAndExcludesGaps)
+{
+    const std::array<Region, 3> input = {span_at(0x10000, 0x100), span_at(0x20000, 0x100), span_at(0x30000, 0x100)};
+    const Result<RegionSet> set = RegionSet::of(input);
+    ASSERT_TRUE(set.has_value());
+
+    EXPECT_TRUE(set->contains(Address{0x10000}));
+    EXPECT_TRUE(set->contains(Address{0x200FF}));
+    EXPECT_FALSE(set->contains(Address{0x20100}));
+    EXPECT_FALSE(set->contains(Address{0x25000}));
+    EXPECT_FALSE(set->contains(Address{0x0FFFF}));
+    EXPECT_FALSE(set->contains(Address{0x30100}));
+
+    const std::optional<Region> range = set->range_of(Address{0x30080});
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range->base.raw(), 0x30000u);
+    EXPECT_FALSE(set->range_of(Address{0x28000}).has_value());
+}
+
+TEST(RegionSet, AddMergesASpanBridgingTwoNeighbours)
+{
+    const std::array<Region, 2> input = {span_at(0x10000, 0x1000), span_at(0x13000, 0x1000)};
+    Result<RegionSet> set = RegionSet::of(input);
+    ASSERT_TRUE(set.has_value());
+    ASSERT_EQ(set->ranges().size(), 2u);
+
+    ASSERT_TRUE(set->add(span_at(0x10800, 0x2800)).has_value());
+    ASSERT_EQ(set->ranges().size(), 1u);
+    EXPECT_EQ(set->ranges()[0].base.raw(), 0x10000u);
+    EXPECT_EQ(set->ranges()[0].size, 0x4000u);
+
+    // An empty Region is a no-op rather than an error.
+    EXPECT_TRUE(set->add(Region{}).has_value());
+    EXPECT_EQ(set->ranges().size(), 1u);
+}
+
+TEST(RegionSet, RejectsNullBasedAndWrappingSpansWithoutChangingTheSet)
+{
+    const std::array<Region, 1> null_based = {span_at(0, 0x1000)};
+    const Result<RegionSet> rejected = RegionSet::of(null_based);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidRange);
+
+    const std::array<Region, 1> input = {span_at(0x10000, 0x1000)};
+    Result<RegionSet> set = RegionSet::of(input);
+    ASSERT_TRUE(set.has_value());
+    const Result<void> wrapped = set->add(span_at(UINTPTR_MAX - 0xFF, 0x200));
+    ASSERT_FALSE(wrapped.has_value());
+    EXPECT_EQ(wrapped.error().code, ErrorCode::InvalidRange);
+    ASSERT_EQ(set->ranges().size(), 1u);
+    EXPECT_EQ(set->ranges()[0].base.raw(), 0x10000u);
+}
+
+TEST(RegionSet, EmptySetHasNoBoundsAndContainsNothing)
+{
+    const RegionSet set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.byte_size(), 0u);
+    EXPECT_EQ(set.bounds().size, 0u);
+    EXPECT_FALSE(set.contains(Address{0x10000}));
+}
@@ -5,8 +5,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <optional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 #include <windows.h>
 
@@ -565,6 +567,146 @@ TEST_F(RttiTest, ResolveRejectsHeapAllocatedVtable)
     EXPECT_FALSE(rtti::vtable_is_type(Address{fake_vt}, ".?AVAnything@@"));
 }
 
+// interned_type_name
+
+namespace
+{
+    /// Makes the pages that wholly hold [@p begin, @p end) read-only for the scope, so the name cache may intern them.
+    class ReadOnlyPages
+    {
+    public:
+        ReadOnlyPages(std::uintptr_t begin, std::uintptr_t end) noexcept
+            : m_begin(begin & ~std::uintptr_t{0xFFF}), m_size(((end + 0xFFF) & ~std::uintptr_t{0xFFF}) - m_begin)
+        {
+            DWORD old_protect = 0;
+            m_ok = ::VirtualProtect(reinterpret_cast<void *>(m_begin), m_size, PAGE_READONLY, &old_protect) != 0;
+            memory::invalidate_range(DetourModKit::Region{Address{m_begin}, m_size});
+        }
+
+        ~ReadOnlyPages()
+        {
+            DWORD old_protect = 0;
+            (void)::VirtualProtect(reinterpret_cast<void *>(m_begin), m_size, PAGE_READWRITE, &old_protect);
+            memory::invalidate_range(DetourModKit::Region{Address{m_begin}, m_size});
+        }
+
+        ReadOnlyPages(const ReadOnlyPages &) = delete;
+        ReadOnlyPages &operator=(const ReadOnlyPages &) = delete;
+
+        [[nodiscard]] bool ok() const noexcept { return m_ok; }
+
+    private:
+        std::uintptr_t m_begin;
+        std::size_t m_size;
+        bool m_ok = false;
+    };
+} // anonymous namespace
+
+TEST_F(RttiTest, InternedTypeName_ReadOnlyRttiIsInternedOnce)
+{
+    // The middle fixture's pages hold only pool bytes, so protecting them cannot touch another global.
+    SyntheticVtable before(".?AVInternBefore@@");
+    SyntheticVtable v(".?AVInterned@@");
+    SyntheticVtable after(".?AVInternAfter@@");
+    const std::uintptr_t buf = v.vtable() - SYN_VTABLE_OFFSET;
+    ReadOnlyPages pages(buf, buf + SYN_BUF_SIZE);
+    ASSERT_TRUE(pages.ok());
+
+    const auto first = rtti::interned_type_name(Address{v.vtable()});
+    const auto second = rtti::interned_type_name(Address{v.vtable()});
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(*first, ".?AVInterned@@");
+    EXPECT_EQ(first->data(), second->data());
+
+    // The other entry points answer from the same record.
+    EXPECT_EQ(rtti::type_name_of(Address{v.vtable()}), std::optional<std::string>(".?AVInterned@@"));
+    EXPECT_EQ(rtti::type_name_of(Address{v.vtable()}, 6), std::optional<std::string>(".?AVIn"));
+    char out[8] = {0};
+    EXPECT_EQ(rtti::type_name_into(Address{v.vtable()}, out, sizeof(out)), 7u);
+    EXPECT_STREQ(out, ".?AVInt");
+    EXPECT_TRUE(rtti::vtable_is_type(Address{v.vtable()}, ".?AVInterned@@"));
+    EXPECT_FALSE(rtti::vtable_is_type(Address{v.vtable()}, ".?AVInterned"));
+}
+
+TEST_F(RttiTest, InternedTypeName_WritableRttiIsNeverCached)
+{
+    // The pool is writable, so a rewrite in place must be seen by the next call.
+    SyntheticVtable v(".?AVWritableOne@@");
+    EXPECT_FALSE(rtti::interned_type_name(Address{v.vtable()}).has_value());
+    EXPECT_TRUE(rtti::vtable_is_type(Address{v.vtable()}, ".?AVWritableOne@@"));
+
+    syn_reset();
+    SyntheticVtable rewritten(".?AVWritableTwo@@");
+    ASSERT_EQ(rewritten.vtable(), v.vtable());
+    EXPECT_EQ(rtti::type_name_of(Address{rewritten.vtable()}), std::optional<std::string>(".?AVWritableTwo@@"));
+    EXPECT_FALSE(rtti::vtable_is_type(Address{rewritten.vtable()}, ".?AVWritableOne@@"));
+}
+
+TEST_F(RttiTest, InternedTypeName_UnresolvedVtableReturnsNullopt)
+{
+    EXPECT_FALSE(rtti::interned_type_name(Address{}).has_value());
+    EXPECT_FALSE(rtti::interned_type_name(Address{0x100}).has_value());
+}
+
+// find_instances
+
+TEST(RttiInstancesTest, FindInstances_FindsObjectsOfEachVtableInScope)
+{
+    constexpr std::size_t arena_bytes = 0x10000;
+    auto *arena =
+        static_cast<std::byte *>(VirtualAlloc(nullptr, arena_bytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(arena, nullptr);
+
+    // Twenty distinct fake vtables exercise the table path; the first two alone exercise the direct compare.
+    static const std::uintptr_t fake_vtables[20][2] = {};
+    std::array<Address, 20> vtables{};
+    for (std::size_t i = 0; i < vtables.size(); ++i)
+    {
+        vtables[i] = Address{&fake_vtables[i][0]};
+    }
+    const std::array<std::size_t, 4> offsets = {0x40, 0x1008, 0x8000, 0xFFF8};
+    for (std::size_t i = 0; i < offsets.size(); ++i)
+    {
+        const std::uintptr_t vptr = vtables[i % 2 == 0 ? 0 : 1].raw();
+        std::memcpy(arena + offsets[i], &vptr, sizeof(vptr));
+    }
+    // A misaligned copy is not an object.
+    const std::uintptr_t misaligned = vtables[0].raw();
+    std::memcpy(arena + 0x2004, &misaligned, sizeof(misaligned));
+
+    rtti::InstanceScanOptions options;
+    const std::array<DetourModKit::Region, 1> scope = {DetourModKit::Region{Address{arena}, arena_bytes}};
+    options.scope = DetourModKit::RegionSet::of(scope).value();
+
+    for (const std::size_t set_size : {std::size_t{2}, vtables.size()})
+    {
+        const DetourModKit::Result<rtti::InstanceScan> found =
+            rtti::find_instances(std::span<const Address>(vtables).first(set_size), options);
+        ASSERT_TRUE(found.has_value());
+        EXPECT_FALSE(found->incomplete);
+        ASSERT_EQ(found->matches.size(), offsets.size());
+        for (std::size_t i = 0; i < offsets.size(); ++i)
+        {
+            EXPECT_EQ(found->matches[i].object, Address{arena + offsets[i]});
+            EXPECT_EQ(found->matches[i].vtable, i % 2);
+        }
+    }
+
+    VirtualFree(arena, 0, MEM_RELEASE);
+}
+
+TEST(RttiInstancesTest, FindInstances_RejectsBadSets)
+{
+    EXPECT_EQ(rtti::find_instances({}).error().code, DetourModKit::ErrorCode::InvalidArg);
+    const std::array<Address, 2> with_null = {Address{std::uintptr_t{0x10000}}, Address{}};
+    const auto rejected = rtti::find_instances(with_null);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, DetourModKit::ErrorCode::InvalidArg);
+    const std::vector<Address> too_many(rtti::MAX_INSTANCE_VTABLES + 1, Address{std::uintptr_t{0x10000}});
+    EXPECT_EQ(rtti::find_instances(too_many).error().code, DetourModKit::ErrorCode::SizeTooLarge);
+}
+
 // Default values / constants
 
 TEST(RttiConstantsTest, Defaults)
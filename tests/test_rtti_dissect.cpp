@@ -9,6 +9,7 @@
 #include <cstring>
 #include <new>
 #include <span>
+#include <stop_token>
 #include <string>
 #include <string_view>
 #include <type_traits>
@@ -579,6 +580,73 @@ TEST_F(RttiDissectTest, ScanBlock_AppendsToExistingVector)
     EXPECT_EQ(out[1].type.name(), ".?AVAppend@@");
 }
 
+TEST_F(RttiDissectTest, ScanBlock_BulkScreenLabelsAmongNoiseAcrossGroups)
+{
+    SyntheticVtable direct(".?AVBulkDirect@@");
+    SyntheticVtable pointed(".?AVBulkPointed@@");
+    const std::uintptr_t obj = syn_heap_object(pointed.vtable());
+    ASSERT_NE(obj, 0u);
+
+    // Several 64-slot screening groups of the values a real struct holds: floats, small ints, nulls, kernel-half and
+    // misaligned addresses. Only the two real slots may be labelled, wherever they fall in a group.
+    std::vector<std::uintptr_t> block(300);
+    for (std::size_t i = 0; i < block.size(); ++i)
+    {
+        switch (i % 5)
+        {
+        case 0:
+            block[i] = 0x3F8000003F800000ull; // two packed 1.0f
+            break;
+        case 1:
+            block[i] = i;
+            break;
+        case 2:
+            block[i] = 0;
+            break;
+        case 3:
+            block[i] = 0xFFFFF80000001000ull;
+            break;
+        default:
+            block[i] = obj + 1;
+            break;
+        }
+    }
+    block[63] = direct.vtable();
+    block[257] = obj;
+    const std::uintptr_t start = reinterpret_cast<std::uintptr_t>(block.data());
+
+    std::vector<rtti::LabeledSlot> out;
+    const std::size_t added = rtti::reverse_scan_block(Address{start}, block.size(), out);
+    ASSERT_EQ(added, 2u);
+    EXPECT_EQ(out[0].slot_index, 63u);
+    EXPECT_FALSE(out[0].type.was_pointer);
+    EXPECT_EQ(out[0].type.name(), ".?AVBulkDirect@@");
+    EXPECT_EQ(out[1].slot_index, 257u);
+    EXPECT_TRUE(out[1].type.was_pointer);
+    EXPECT_EQ(out[1].type.name(), ".?AVBulkPointed@@");
+}
+
+TEST_F(RttiDissectTest, ScanBlock_RunsIntoUnreadablePage)
+{
+    SyntheticVtable v(".?AVEdgeOfPage@@");
+    auto *pages = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, 8192, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(pages, nullptr);
+    const std::uintptr_t vt = v.vtable();
+    std::memcpy(pages, &vt, sizeof(vt));
+    std::memcpy(pages + 4096 - sizeof(vt), &vt, sizeof(vt));
+    ASSERT_NE(VirtualFree(pages + 4096, 4096, MEM_DECOMMIT), 0);
+
+    // The second page faults: its slots are skipped, the readable page is still labelled.
+    std::vector<rtti::LabeledSlot> out;
+    const std::size_t added =
+        rtti::reverse_scan_block(Address{reinterpret_cast<std::uintptr_t>(pages)}, 8192 / sizeof(vt), out);
+    EXPECT_EQ(added, 2u);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].slot_index, 0u);
+    EXPECT_EQ(out[1].slot_index, 4096 / sizeof(vt) - 1);
+    VirtualFree(pages, 0, MEM_RELEASE);
+}
+
 TEST_F(RttiDissectTest, ScanBlock_OverflowingCountRejected)
 {
     std::vector<rtti::LabeledSlot> out;
@@ -644,6 +712,85 @@ TEST_F(RttiDissectTest, ScanBlockBytes_ZeroStrideTreatedAsPointerSize)
     EXPECT_EQ(added, 2u);
 }
 
+// L2 crawl
+
+TEST_F(RttiDissectTest, Crawl_FollowsLevelsOnceEachWithBackEdges)
+{
+    SyntheticVtable va(".?AVCrawlA@@");
+    SyntheticVtable vb(".?AVCrawlB@@");
+    SyntheticVtable vc(".?AVCrawlC@@");
+    SyntheticVtable vd(".?AVCrawlD@@");
+    const std::uintptr_t a = syn_heap_object(va.vtable());
+    const std::uintptr_t b = syn_heap_object(vb.vtable());
+    const std::uintptr_t c = syn_heap_object(vc.vtable());
+    const std::uintptr_t d = syn_heap_object(vd.vtable());
+    ASSERT_TRUE(a != 0 && b != 0 && c != 0 && d != 0);
+    const auto put = [](std::uintptr_t object, std::size_t offset, std::uintptr_t value) noexcept
+    { std::memcpy(reinterpret_cast<void *>(object + offset), &value, sizeof(value)); };
+    put(a, 0x10, b);
+    put(a, 0x18, c);
+    put(a, 0x20, 0x3F8000003F800000ull); // a float pair, not an edge
+    put(b, 0x08, a);                     // back edge to the root: an edge, no new node
+    put(c, 0x08, d);
+
+    const auto shallow = rtti::crawl(Address{a}, 1, 0x40);
+    ASSERT_TRUE(shallow.has_value());
+    ASSERT_EQ(shallow->nodes.size(), 3u);
+    EXPECT_EQ(shallow->nodes[0].object.raw(), a);
+    EXPECT_EQ(shallow->nodes[1].object.raw(), b);
+    EXPECT_EQ(shallow->nodes[2].object.raw(), c);
+    EXPECT_EQ(shallow->nodes[1].depth, 1u);
+    ASSERT_EQ(shallow->edges.size(), 2u);
+    EXPECT_EQ(shallow->edges[0].offset, 0x10);
+    EXPECT_EQ(shallow->edges[1].offset, 0x18);
+    EXPECT_FALSE(shallow->edges[0].embedded);
+    EXPECT_EQ(shallow->bytes_scanned, 0x40u);
+
+    const auto deep = rtti::crawl(Address{a}, 3, 0x40, 4);
+    ASSERT_TRUE(deep.has_value());
+    ASSERT_EQ(deep->nodes.size(), 4u);
+    EXPECT_EQ(deep->nodes[3].object.raw(), d);
+    EXPECT_EQ(deep->nodes[3].depth, 2u);
+    EXPECT_EQ(deep->types[deep->nodes[3].type].name, ".?AVCrawlD@@");
+    ASSERT_EQ(deep->types.size(), 4u);
+    for (const rtti::CrawlType &type : deep->types)
+    {
+        EXPECT_EQ(type.count, 1u);
+    }
+    ASSERT_EQ(deep->edges.size(), 4u);
+    EXPECT_EQ(deep->edges[2].from, 1u); // B -> A, the back edge
+    EXPECT_EQ(deep->edges[2].to, 0u);
+    EXPECT_EQ(deep->edges[3].from, 2u); // C -> D
+    EXPECT_EQ(deep->edges[3].to, 3u);
+    EXPECT_FALSE(deep->truncated);
+}
+
+TEST_F(RttiDissectTest, Crawl_RejectsBadBudgetAndNonObjectRoot)
+{
+    SyntheticVtable v(".?AVCrawlRoot@@");
+    const std::uintptr_t obj = syn_heap_object(v.vtable());
+    ASSERT_NE(obj, 0u);
+
+    auto bad = rtti::crawl(Address{obj}, 1, 0);
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error().code, ErrorCode::InvalidArg);
+    bad = rtti::crawl(Address{obj}, 1, rtti::MAX_CRAWL_OBJECT_BYTES + 8);
+    ASSERT_FALSE(bad.has_value());
+    EXPECT_EQ(bad.error().code, ErrorCode::InvalidArg);
+
+    // A slot holding a pointer to the object is not itself an object.
+    const std::uintptr_t holder = obj;
+    const auto pointer_root = rtti::crawl(Address{reinterpret_cast<std::uintptr_t>(&holder)}, 1, 0x40);
+    ASSERT_FALSE(pointer_root.has_value());
+    EXPECT_EQ(pointer_root.error().code, ErrorCode::NoRtti);
+
+    const auto alone = rtti::crawl(Address{obj}, 0, 0x40);
+    ASSERT_TRUE(alone.has_value());
+    EXPECT_EQ(alone->nodes.size(), 1u);
+    EXPECT_TRUE(alone->edges.empty());
+    EXPECT_EQ(alone->bytes_scanned, 0u);
+}
+
 // L3 heal_landmark
 
 namespace
@@ -1359,6 +1506,47 @@ TEST_F(RttiDissectTest, Fingerprint_AllocatesNothing)
     EXPECT_EQ(after - before, 0);
 }
 
+TEST_F(RttiDissectTest, Fingerprint_FullWindowAcrossSeparateRunsAndPhases)
+{
+    // A full MAX_HEAL_WINDOW solve over noise: A and B share one overlapping window run, C's window is a separate
+    // run, and the optional D sits on a slot grid 4 bytes off the others. A decoy A elsewhere fits A alone but not the
+    // template, so only the rigid delta survives.
+    FpTypes ty;
+    SyntheticVtable d(".?AVFpPhase@@");
+    constexpr std::size_t buf_len = 0x6000;
+    auto *buf = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, buf_len, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(buf, nullptr);
+    for (std::size_t off = 0; off + sizeof(std::uint32_t) <= buf_len; off += sizeof(std::uint32_t))
+    {
+        const std::uint32_t noise = (off % 12 == 0) ? 0x3F800000u : static_cast<std::uint32_t>(off);
+        std::memcpy(buf + off, &noise, sizeof(noise));
+    }
+    const std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buf) + 0x1000;
+    const auto put = [base](std::ptrdiff_t off, std::uintptr_t value) noexcept
+    { std::memcpy(reinterpret_cast<void *>(base + static_cast<std::uintptr_t>(off)), &value, sizeof(value)); };
+
+    constexpr std::ptrdiff_t drift = -0x208;
+    put(0x10 + drift, syn_heap_object(ty.a.vtable()));
+    put(0x58 + drift, syn_heap_object(ty.b.vtable()));
+    put(0x2800 + drift, syn_heap_object(ty.c.vtable()));
+    put(0x5C + 0x40 + drift, syn_heap_object(d.vtable()));
+    put(0x10 + 0x300, syn_heap_object(ty.a.vtable()));
+
+    const std::array<rtti::Landmark, 4> fp{
+        rtti::Landmark{.base = Address{base}, .nominal_offset = 0x10, .expected_mangled = ".?AVFpA@@"},
+        rtti::Landmark{.base = Address{base}, .nominal_offset = 0x58, .expected_mangled = ".?AVFpB@@"},
+        rtti::Landmark{.base = Address{base}, .nominal_offset = 0x2800, .expected_mangled = ".?AVFpC@@"},
+        rtti::Landmark{
+            .base = Address{base}, .nominal_offset = 0x9C, .expected_mangled = ".?AVFpPhase@@", .required = false},
+    };
+    const auto hit = rtti::solve_fingerprint(Address{base}, fp, rtti::MAX_HEAL_WINDOW);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->delta, drift);
+    EXPECT_EQ(hit->matched, 3u);
+    EXPECT_EQ(hit->optional_matched, 1u);
+    VirtualFree(buf, 0, MEM_RELEASE);
+}
+
 TEST_F(RttiDissectTest, Fingerprint_CapGuards)
 {
     SynStruct st;
@@ -1452,6 +1640,71 @@ TEST_F(RttiDissectTest, HealReport_RecordsTypedFailure)
     EXPECT_EQ(report[0].delta, 0);             // reset, not the stale 0x1234
 }
 
+TEST_F(RttiDissectTest, HealReportParallel_MatchesSerialReportInInputOrder)
+{
+    SyntheticVtable a(".?AVParA@@");
+    SyntheticVtable b(".?AVParB@@");
+    SyntheticVtable c(".?AVParC@@");
+    SynStruct st;
+    st.put(0x40, syn_heap_object(a.vtable())); // healed in place
+    st.put(0x90, syn_heap_object(b.vtable())); // drifted +0x10
+    st.put(0x1F0, c.vtable());                 // a direct object either side of 0x200: ambiguous
+    st.put(0x210, c.vtable());
+
+    // Many landmarks over few vtables, so workers meet on the same cached verdicts.
+    const rtti::Landmark shapes[] = {
+        {.base = Address{st.base()}, .nominal_offset = 0x40, .expected_mangled = ".?AVParA@@"},
+        {.base = Address{st.base()}, .nominal_offset = 0x80, .expected_mangled = ".?AVParB@@"},
+        {.base = Address{st.base()}, .nominal_offset = 0x100, .expected_mangled = ".?AVParMissing@@"},
+        {.base = Address{st.base()}, .nominal_offset = 0x200, .expected_mangled = ".?AVParC@@"},
+    };
+    std::vector<rtti::Landmark> lms;
+    for (std::size_t i = 0; i < 32; ++i)
+        lms.push_back(shapes[i % std::size(shapes)]);
+
+    std::vector<rtti::DriftEntry> serial(lms.size());
+    std::vector<rtti::DriftEntry> parallel(lms.size());
+    ASSERT_EQ(rtti::heal_report(lms, serial), lms.size());
+    ASSERT_EQ(rtti::heal_report_parallel(lms, parallel, 4), lms.size());
+
+    for (std::size_t i = 0; i < lms.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        EXPECT_EQ(parallel[i].name, serial[i].name);
+        EXPECT_EQ(parallel[i].ok, serial[i].ok);
+        EXPECT_EQ(parallel[i].healed_offset, serial[i].healed_offset);
+        EXPECT_EQ(parallel[i].delta, serial[i].delta);
+        EXPECT_EQ(parallel[i].error, serial[i].error);
+    }
+    EXPECT_TRUE(parallel[0].ok);
+    EXPECT_EQ(parallel[1].delta, 0x10);
+    EXPECT_EQ(parallel[2].error, ErrorCode::HealNoMatch);
+    EXPECT_EQ(parallel[3].error, ErrorCode::HealAmbiguous);
+}
+
+TEST_F(RttiDissectTest, HealReportParallel_StoppedBeforeStartReportsCancelled)
+{
+    SyntheticVtable a(".?AVParStop@@");
+    SynStruct st;
+    st.put(0x40, syn_heap_object(a.vtable()));
+    const rtti::Landmark lms[] = {
+        {.base = Address{st.base()}, .nominal_offset = 0x40, .expected_mangled = ".?AVParStop@@"},
+        {.base = Address{st.base()}, .nominal_offset = 0x40, .expected_mangled = ".?AVParStop@@"},
+    };
+
+    std::stop_source source;
+    source.request_stop();
+    rtti::DriftEntry report[2];
+    ASSERT_EQ(rtti::heal_report_parallel(lms, report, 2, source.get_token()), 2u);
+    for (const rtti::DriftEntry &entry : report)
+    {
+        EXPECT_FALSE(entry.ok);
+        EXPECT_EQ(entry.error, ErrorCode::Cancelled);
+        EXPECT_EQ(entry.name, ".?AVParStop@@");
+        EXPECT_EQ(entry.nominal_offset, 0x40);
+    }
+}
+
 TEST_F(RttiDissectTest, HealReport_RespectsOutputCapacity)
 {
     SyntheticVtable a(".?AVCapReport@@");
@@ -291,6 +291,75 @@ TEST_F(RttiReverseTest, TypeIdentityUnresolvedNeverMatches)
     EXPECT_FALSE(id.matches(Address{0x1000}));
 }
 
+TEST_F(RttiReverseTest, ClassifyLabelsObjectsAcrossBatches)
+{
+    const std::uintptr_t vt_a = build_synth(".?AVRevClassA@@", 0);
+    const std::uintptr_t vt_b = build_synth(".?AVRevClassB@@", 0);
+    ASSERT_NE(vt_a, 0u);
+    ASSERT_NE(vt_b, 0u);
+
+    // Index 1 never resolves, so it labels nothing; a listed-twice identity keeps the first label.
+    const std::array<rtti::TypeIdentity, 4> ids{
+        rtti::TypeIdentity{".?AVRevClassA@@", pool_range()},
+        rtti::TypeIdentity{".?AVRevClassAbsent@@", pool_range()},
+        rtti::TypeIdentity{".?AVRevClassB@@", pool_range()},
+        rtti::TypeIdentity{".?AVRevClassB@@", pool_range()},
+    };
+
+    // Objects are bare vptr slots: A, B, a foreign vtable, and null or unreadable addresses, spread over more than one
+    // gather batch and a ragged tail.
+    void *page = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(page, nullptr);
+    auto *slots = static_cast<std::uintptr_t *>(page);
+    slots[0] = vt_a;
+    slots[1] = vt_b;
+    slots[2] = vt_a + 8;
+    void *gone = VirtualAlloc(nullptr, 4096, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(gone, nullptr);
+    VirtualFree(gone, 0, MEM_RELEASE);
+
+    std::array<Address, 301> objects{};
+    std::array<std::uint8_t, 301> expected{};
+    for (std::size_t i = 0; i < objects.size(); ++i)
+    {
+        switch (i % 5)
+        {
+        case 0:
+            objects[i] = Address{reinterpret_cast<std::uintptr_t>(&slots[0])};
+            expected[i] = 0;
+            break;
+        case 1:
+            objects[i] = Address{reinterpret_cast<std::uintptr_t>(&slots[1])};
+            expected[i] = 2;
+            break;
+        case 2:
+            objects[i] = Address{reinterpret_cast<std::uintptr_t>(&slots[2])};
+            expected[i] = rtti::CLASSIFY_NO_MATCH;
+            break;
+        case 3:
+            objects[i] = Address{};
+            expected[i] = rtti::CLASSIFY_NO_MATCH;
+            break;
+        default:
+            objects[i] = Address{reinterpret_cast<std::uintptr_t>(gone)};
+            expected[i] = rtti::CLASSIFY_NO_MATCH;
+            break;
+        }
+    }
+
+    std::array<std::uint8_t, 301> labels{};
+    EXPECT_EQ(rtti::classify(objects, ids, labels), objects.size());
+    EXPECT_EQ(labels, expected);
+
+    // A shorter output span bounds the write.
+    std::array<std::uint8_t, 3> head{};
+    EXPECT_EQ(rtti::classify(objects, ids, head), head.size());
+    EXPECT_EQ(head[0], 0u);
+    EXPECT_EQ(head[1], 2u);
+    EXPECT_EQ(head[2], rtti::CLASSIFY_NO_MATCH);
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
 TEST_F(RttiReverseTest, TypeIdentityFailedResolveRetriesWhenTypeAppearsLater)
 {
     // A failed resolve must not latch permanently: the owning module may map the type later (a DLL loads, or a patch
@@ -482,3 +551,94 @@ TEST_F(RttiReverseTest, RegionHasRttiScansHostPeSections)
     EXPECT_FALSE(rtti::region_has_rtti(Region::host()));
 #endif
 }
+
+TEST_F(RttiReverseTest, TypeIndexAnswersForwardAndReverseQueries)
+{
+    const std::uintptr_t single = build_synth(".?AVIdxSingle@@", 0);
+    const std::uintptr_t multi_secondary = build_synth(".?AVIdxMulti@@", 0x10);
+    const std::uintptr_t multi_primary = build_synth(".?AVIdxMulti@@", 0);
+    ASSERT_NE(build_synth(".?AVIdxDup@@", 0), 0u);
+    ASSERT_NE(build_synth(".?AVIdxDup@@", 0), 0u);
+    ASSERT_NE(single, 0u);
+    ASSERT_NE(multi_secondary, 0u);
+    ASSERT_NE(multi_primary, 0u);
+
+    const auto index = rtti::TypeIndex::build(pool_range());
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(index->type_count(), 3u);
+    EXPECT_EQ(index->vtable_count(), 5u);
+
+    // Every answer matches what the per-query sweep gives over the same scope.
+    for (const std::string_view name : {".?AVIdxSingle@@", ".?AVIdxMulti@@", ".?AVIdxDup@@", ".?AVIdxAbsent@@"})
+    {
+        EXPECT_EQ(index->vtable_for(name), rtti::vtable_for_type(name, pool_range())) << name;
+        Address swept[4]{};
+        Address indexed[4]{};
+        const std::size_t n = rtti::vtables_for_type(name, swept, 4, pool_range());
+        ASSERT_EQ(index->vtables_for(name, indexed, 4), n) << name;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            EXPECT_EQ(indexed[i], swept[i]) << name;
+        }
+    }
+
+    ASSERT_TRUE(index->vtable_for(".?AVIdxMulti@@").has_value());
+    EXPECT_EQ(index->vtable_for(".?AVIdxMulti@@")->raw(), multi_primary);
+    EXPECT_FALSE(index->vtable_for(".?AVIdxDup@@").has_value());
+    EXPECT_EQ(index->vtables_for(".?AVIdxMulti@@", nullptr, 0), 2u);
+
+    EXPECT_EQ(index->type_name_of(Address{single}), std::optional<std::string_view>(".?AVIdxSingle@@"));
+    EXPECT_EQ(index->type_name_of(Address{multi_secondary}), std::optional<std::string_view>(".?AVIdxMulti@@"));
+    EXPECT_FALSE(index->type_name_of(Address{single + 8}).has_value());
+}
+
+TEST_F(RttiReverseTest, TypeIndexKeepsExactCountPastTheSweepCap)
+{
+    // 64 vtables saturate the per-query collector; the index counts all of them and fails the primary closed the
+    // same way.
+    ASSERT_NE(build_synth(".?AVIdxSaturate@@", 0), 0u);
+    for (std::size_t i = 1; i < REV_POOL_FIXTURES; ++i)
+    {
+        ASSERT_NE(build_synth(".?AVIdxSaturate@@", 0x10), 0u);
+    }
+
+    const auto index = rtti::TypeIndex::build(pool_range(), 4);
+    ASSERT_TRUE(index.has_value());
+    EXPECT_EQ(index->vtables_for(".?AVIdxSaturate@@", nullptr, 0), REV_POOL_FIXTURES);
+    EXPECT_FALSE(index->vtable_for(".?AVIdxSaturate@@").has_value());
+}
+
+TEST_F(RttiReverseTest, TypeIndexFindsFixtureViaHostModuleSectionWalk)
+{
+    const std::uintptr_t vt = build_synth(".?AVIdxHostWalk@@", 0);
+    ASSERT_NE(vt, 0u);
+
+    const auto index = rtti::TypeIndex::build(Region::host());
+    ASSERT_TRUE(index.has_value());
+    ASSERT_TRUE(index->vtable_for(".?AVIdxHostWalk@@").has_value());
+    EXPECT_EQ(index->vtable_for(".?AVIdxHostWalk@@")->raw(), vt);
+    EXPECT_EQ(index->type_name_of(Address{vt}), std::optional<std::string_view>(".?AVIdxHostWalk@@"));
+}
+
+TEST_F(RttiReverseTest, TypeIndexSharedReusesOneIndexPerScope)
+{
+    const std::uintptr_t vt = build_synth(".?AVIdxShared@@", 0);
+    ASSERT_NE(vt, 0u);
+    ASSERT_NE(build_synth(".?AVIdxSharedOther@@", 0), 0u);
+
+    const auto first = rtti::TypeIndex::shared(pool_range());
+    const auto second = rtti::TypeIndex::shared(pool_range());
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->get(), second->get());
+    ASSERT_TRUE((*first)->vtable_for(".?AVIdxShared@@").has_value());
+    EXPECT_EQ((*first)->vtable_for(".?AVIdxShared@@")->raw(), vt);
+}
+
+TEST_F(RttiReverseTest, TypeIndexRejectsInvalidRange)
+{
+    const auto built = rtti::TypeIndex::build(Region{});
+    ASSERT_FALSE(built.has_value());
+    EXPECT_EQ(built.error().code, DetourModKit::ErrorCode::InvalidRange);
+    EXPECT_FALSE(rtti::TypeIndex::shared(Region{}).has_value());
+}
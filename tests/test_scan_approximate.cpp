@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "DetourModKit/scan.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    void plant(std::vector<std::uint8_t> &buffer, std::size_t at, std::initializer_list<std::uint8_t> bytes)
+    {
+        std::size_t i = at;
+        for (const std::uint8_t b : bytes)
+        {
+            buffer[i++] = b;
+        }
+    }
+
+    [[nodiscard]] std::uintptr_t at(const std::vector<std::uint8_t> &buffer, std::size_t offset)
+    {
+        return reinterpret_cast<std::uintptr_t>(buffer.data() + offset);
+    }
+} // namespace
+
+TEST(ScanApproximateTest, ReportsSitesAndTheirMismatchPositions)
+{
+    std::vector<std::uint8_t> buffer(0x1000, 0xCC);
+    plant(buffer, 0x100, {0x9E, 0x27, 0xB3, 0x51, 0x6D, 0x42}); // exact
+    plant(buffer, 0x400, {0x9E, 0x27, 0xB4, 0x51, 0x6D, 0x42}); // position 2 changed
+    plant(buffer, 0x800, {0x9E, 0x11, 0xB3, 0x51, 0x6D, 0x99}); // positions 1 and 5 changed
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const scan::Pattern pattern = scan::Pattern::literal("9E 27 B3 | 51 6D 42");
+
+    std::array<scan::ApproximateMatch, 8> sites{};
+    const auto one = scan::find_approximate(pattern, scope, 1, sites);
+    ASSERT_TRUE(one.has_value()) << one.error().message();
+    EXPECT_TRUE(one->complete());
+    ASSERT_EQ(one->matches, 2u);
+    EXPECT_EQ(sites[0].site.raw(), at(buffer, 0x100));
+    EXPECT_EQ(sites[0].mismatches, 0u);
+    EXPECT_EQ(sites[1].site.raw(), at(buffer, 0x400));
+    ASSERT_EQ(sites[1].mismatch_positions().size(), 1u);
+    EXPECT_EQ(sites[1].mismatch_positions()[0], 2u);
+
+    const auto two = scan::find_approximate(pattern, scope, 2, sites, scan::Pages::Readable, 1);
+    ASSERT_TRUE(two.has_value());
+    ASSERT_EQ(two->matches, 3u);
+    EXPECT_EQ(sites[2].site.raw(), at(buffer, 0x800));
+    ASSERT_EQ(sites[2].mismatches, 2u);
+    EXPECT_EQ(sites[2].positions[0], 1u);
+    EXPECT_EQ(sites[2].positions[1], 5u);
+
+    std::array<scan::ApproximateMatch, 1> small{};
+    const auto partial = scan::find_approximate(pattern, scope, 2, small);
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_TRUE(partial->stopped);
+    EXPECT_EQ(partial->matches, 1u);
+    EXPECT_EQ(small[0].site.raw(), at(buffer, 0x100));
+}
+
+TEST(ScanApproximateTest, WildcardsAndNibblesNeverCountAsMismatches)
+{
+    std::vector<std::uint8_t> buffer(0x800, 0x00);
+    plant(buffer, 0x200, {0x48, 0x8B, 0x77, 0x3D, 0xA1, 0xE8});
+    const Region scope{Address{buffer.data()}, buffer.size()};
+
+    std::array<scan::ApproximateMatch, 4> sites{};
+    // ?? takes any byte, and 3? fixes only the 3 of 0x3D.
+    const auto found = scan::find_approximate(scan::Pattern::literal("48 8B ?? 3? A1 E9"), scope, 1, sites);
+    ASSERT_TRUE(found.has_value());
+    ASSERT_EQ(found->matches, 1u);
+    EXPECT_EQ(sites[0].site.raw(), at(buffer, 0x200));
+    ASSERT_EQ(sites[0].mismatches, 1u);
+    EXPECT_EQ(sites[0].positions[0], 5u);
+}
+
+TEST(ScanApproximateTest, FindsASiteAcrossAChunkBoundaryOnce)
+{
+    // The sweep cuts its scope into 1 MiB chunks; sites starting just before each cut straddle it.
+    std::vector<std::uint8_t> buffer((std::size_t{3} << 20) + 0x100, 0xCC);
+    const std::size_t cuts[] = {(std::size_t{1} << 20) - 3, (std::size_t{2} << 20) - 1};
+    for (const std::size_t cut : cuts)
+    {
+        plant(buffer, cut, {0x5A, 0x3C, 0x71, 0x0F, 0xE2, 0x66, 0x19, 0x84});
+    }
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const scan::Pattern pattern = scan::Pattern::literal("5A 3C 71 0F E2 66 19 85");
+
+    std::array<scan::ApproximateMatch, 8> sites{};
+    const auto found = scan::find_approximate(pattern, scope, 1, sites, scan::Pages::Readable, 4);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_TRUE(found->complete());
+    ASSERT_EQ(found->matches, 2u);
+    EXPECT_EQ(sites[0].site.raw(), at(buffer, cuts[0]));
+    EXPECT_EQ(sites[1].site.raw(), at(buffer, cuts[1]));
+    EXPECT_EQ(sites[1].mismatches, 1u);
+    EXPECT_EQ(sites[1].positions[0], 7u);
+}
+
+TEST(ScanApproximateTest, RejectsBudgetsAndPatternsItCannotSearch)
+{
+    std::vector<std::uint8_t> buffer(0x100, 0xCC);
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    std::array<scan::ApproximateMatch, 4> sites{};
+
+    // Two constrained positions: a budget of two would match every site.
+    const auto wide = scan::find_approximate(scan::Pattern::literal("11 ?? 22"), scope, 2, sites);
+    ASSERT_FALSE(wide.has_value());
+    EXPECT_EQ(wide.error().code, ErrorCode::InvalidArg);
+
+    const auto deep = scan::find_approximate(scan::Pattern::literal("01 02 03 04 05 06 07 08 09 0A"), scope,
+                                             scan::MAX_APPROXIMATE_MISMATCHES + 1, sites);
+    ASSERT_FALSE(deep.has_value());
+    EXPECT_EQ(deep.error().code, ErrorCode::InvalidArg);
+
+    const auto jumps = scan::find_approximate(scan::Pattern::literal("11 22 [1-4] 33 44"), scope, 1, sites);
+    ASSERT_FALSE(jumps.has_value());
+    EXPECT_EQ(jumps.error().code, ErrorCode::InvalidArg);
+
+    const auto empty = scan::find_approximate(scan::Pattern::literal("11 22 33"), Region{}, 1, sites);
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, ErrorCode::InvalidRange);
+}
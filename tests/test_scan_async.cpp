@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_async.hpp"
+
+using namespace DetourModKit;
+using scan::Candidate;
+
+namespace
+{
+    // A committed heap haystack pre-filled with 0xCC, as in test_scan_resolve.cpp, so planted signatures are unique.
+    class ReadableBuffer
+    {
+    public:
+        explicit ReadableBuffer(std::size_t size) : m_bytes(size, std::byte{0xCC}) {}
+
+        [[nodiscard]] Region region() const noexcept { return Region{Address{m_bytes.data()}, m_bytes.size()}; }
+        [[nodiscard]] std::uintptr_t address_of(std::size_t offset) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(m_bytes.data() + offset);
+        }
+
+        void put(std::size_t offset, std::initializer_list<std::uint8_t> sequence) noexcept
+        {
+            for (const std::uint8_t value : sequence)
+            {
+                m_bytes[offset] = std::byte{value};
+                ++offset;
+            }
+        }
+
+    private:
+        std::vector<std::byte> m_bytes;
+    };
+
+    [[nodiscard]] scan::OwnedScanRequest request_for(const ReadableBuffer &buffer, std::string name,
+                                                     scan::Pattern pattern)
+    {
+        scan::OwnedScanRequest request;
+        request.ladder.push_back(Candidate::direct(name, pattern));
+        request.label = std::move(name);
+        request.scope = buffer.region();
+        return request;
+    }
+} // anonymous namespace
+
+TEST(ScanAsyncTest, ResolveAsyncMatchesBlockingResolve)
+{
+    ReadableBuffer buffer(0x400);
+    buffer.put(0x180, {0xDE, 0xAD, 0xBE, 0xEF});
+    const scan::OwnedScanRequest request = request_for(buffer, "hit", scan::Pattern::literal("DE AD BE EF"));
+
+    auto future = scan::resolve_async(request);
+    ASSERT_TRUE(future.has_value());
+    const Result<scan::Hit> &async_hit = future->get();
+    EXPECT_TRUE(future->ready());
+    const auto blocking_hit = scan::resolve(request.view());
+
+    ASSERT_TRUE(async_hit.has_value());
+    ASSERT_TRUE(blocking_hit.has_value());
+    EXPECT_EQ(async_hit->address, blocking_hit->address);
+    EXPECT_EQ(async_hit->address.raw(), buffer.address_of(0x180));
+    EXPECT_EQ(async_hit->winning_name, "hit");
+}
+
+TEST(ScanAsyncTest, CallbackReceivesThePublishedResult)
+{
+    ReadableBuffer buffer(0x400);
+    buffer.put(0x40, {0xCA, 0xFE, 0xBA, 0xBE});
+
+    std::promise<std::uintptr_t> seen;
+    std::future<std::uintptr_t> seen_future = seen.get_future();
+    auto future = scan::resolve_async(request_for(buffer, "cb", scan::Pattern::literal("CA FE BA BE")),
+                                      [&seen](const Result<scan::Hit> &hit)
+                                      { seen.set_value(hit.has_value() ? hit->address.raw() : 0); });
+    ASSERT_TRUE(future.has_value());
+
+    ASSERT_EQ(seen_future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(seen_future.get(), buffer.address_of(0x40));
+    EXPECT_TRUE(future->wait_for(std::chrono::milliseconds{0}));
+}
+
+TEST(ScanAsyncTest, FailedResolveReportsTheBlockingError)
+{
+    ReadableBuffer buffer(0x200);
+    scan::OwnedScanRequest empty;
+    empty.scope = buffer.region();
+
+    auto missing = scan::resolve_async(request_for(buffer, "missing", scan::Pattern::literal("01 02 03 04")));
+    auto no_ladder = scan::resolve_async(std::move(empty));
+    ASSERT_TRUE(missing.has_value());
+    ASSERT_TRUE(no_ladder.has_value());
+
+    ASSERT_FALSE(missing->get().has_value());
+    EXPECT_EQ(missing->get().error().code, ErrorCode::NoMatch);
+    ASSERT_FALSE(no_ladder->get().has_value());
+    EXPECT_EQ(no_ladder->get().error().code, ErrorCode::EmptyCandidates);
+}
+
+TEST(ScanAsyncTest, BatchAsyncMatchesBlockingBatch)
+{
+    ReadableBuffer buffer(0x400);
+    buffer.put(0x100, {0xDE, 0xAD, 0xBE, 0xEF});
+    buffer.put(0x200, {0xCA, 0xFE, 0xBA, 0xBE});
+
+    std::vector<scan::OwnedScanRequest> requests;
+    requests.push_back(request_for(buffer, "first", scan::Pattern::literal("DE AD BE EF")));
+    requests.push_back(request_for(buffer, "second", scan::Pattern::literal("CA FE BA BE")));
+    requests.push_back(request_for(buffer, "missing", scan::Pattern::literal("01 02 03 04")));
+
+    std::vector<scan::ScanRequest> views;
+    for (const scan::OwnedScanRequest &owned : requests)
+        views.push_back(owned.view());
+    const auto blocking = scan::resolve_batch(views);
+    ASSERT_TRUE(blocking.has_value());
+
+    std::promise<std::size_t> seen;
+    std::future<std::size_t> seen_future = seen.get_future();
+    auto future = scan::resolve_batch_async(requests, 2,
+                                            [&seen](const scan::BatchResult &batch)
+                                            { seen.set_value(batch.has_value() ? batch->size() : 0); });
+    ASSERT_TRUE(future.has_value());
+    const scan::BatchResult &async_batch = future->get();
+    ASSERT_TRUE(async_batch.has_value());
+    ASSERT_EQ(async_batch->size(), blocking->size());
+    for (std::size_t i = 0; i < blocking->size(); ++i)
+    {
+        ASSERT_EQ((*async_batch)[i].has_value(), (*blocking)[i].has_value()) << "request " << i;
+        if ((*blocking)[i].has_value())
+            EXPECT_EQ((*async_batch)[i]->address, (*blocking)[i]->address);
+        else
+            EXPECT_EQ((*async_batch)[i].error().code, (*blocking)[i].error().code);
+    }
+    ASSERT_EQ(seen_future.wait_for(std::chrono::seconds{10}), std::future_status::ready);
+    EXPECT_EQ(seen_future.get(), 3u);
+}
+
+TEST(ScanAsyncTest, MovedFromFutureReportsInvalidArg)
+{
+    ReadableBuffer buffer(0x200);
+    buffer.put(0x10, {0xAA, 0xBB, 0xCC, 0xDD});
+    auto future = scan::resolve_async(request_for(buffer, "moved", scan::Pattern::literal("AA BB CC DD")));
+    ASSERT_TRUE(future.has_value());
+
+    scan::ResolveFuture moved = std::move(*future);
+    EXPECT_TRUE(future->ready());
+    ASSERT_FALSE(future->get().has_value());
+    EXPECT_EQ(future->get().error().code, ErrorCode::InvalidArg);
+    ASSERT_TRUE(moved.get().has_value());
+    EXPECT_EQ(moved.get()->address.raw(), buffer.address_of(0x10));
+}
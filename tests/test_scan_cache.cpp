@@ -0,0 +1,460 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <windows.h>
+
+#include <process.h> // _getpid for collision-free temp paths under parallel CTest
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_cache.hpp"
+#include "DetourModKit/session.hpp"
+
+using namespace DetourModKit;
+using scan::Candidate;
+
+namespace
+{
+    constexpr std::size_t IMAGE_BYTES = 0x4000;
+    constexpr LONG NT_OFFSET = 0x80;
+
+    // A heap buffer laid out as a minimal mapped PE32+ image: DOS header, NT headers, one section header, then 0xCC
+    // noise the tests plant signatures into. module_identity() reads only the headers, so this is enough for the
+    // cache to key on without loading a real module.
+    class FakeImage
+    {
+    public:
+        explicit FakeImage(DWORD time_date_stamp) : m_bytes(IMAGE_BYTES, std::byte{0xCC})
+        {
+            std::memset(m_bytes.data(), 0, 0x400);
+
+            IMAGE_DOS_HEADER dos{};
+            dos.e_magic = IMAGE_DOS_SIGNATURE;
+            dos.e_lfanew = NT_OFFSET;
+            std::memcpy(m_bytes.data(), &dos, sizeof(dos));
+
+            IMAGE_NT_HEADERS64 nt{};
+            nt.Signature = IMAGE_NT_SIGNATURE;
+            nt.FileHeader.Machine = IMAGE_FILE_MACHINE_AMD64;
+            nt.FileHeader.NumberOfSections = 1;
+            nt.FileHeader.TimeDateStamp = time_date_stamp;
+            nt.FileHeader.SizeOfOptionalHeader = sizeof(IMAGE_OPTIONAL_HEADER64);
+            nt.OptionalHeader.Magic = IMAGE_NT_OPTIONAL_HDR64_MAGIC;
+            nt.OptionalHeader.SizeOfImage = static_cast<DWORD>(IMAGE_BYTES);
+            std::memcpy(m_bytes.data() + NT_OFFSET, &nt, sizeof(nt));
+
+            IMAGE_SECTION_HEADER section{};
+            std::memcpy(section.Name, ".text", 5);
+            section.VirtualAddress = 0x1000;
+            section.Misc.VirtualSize = 0x3000;
+            section.SizeOfRawData = 0x3000;
+            section.Characteristics = IMAGE_SCN_CNT_CODE | IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_MEM_READ;
+            std::memcpy(m_bytes.data() + NT_OFFSET + sizeof(IMAGE_NT_HEADERS64), &section, sizeof(section));
+        }
+
+        [[nodiscard]] Region region() const noexcept { return Region{Address{m_bytes.data()}, m_bytes.size()}; }
+        [[nodiscard]] std::uintptr_t address_of(std::size_t offset) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(m_bytes.data() + offset);
+        }
+
+        void put(std::size_t offset, std::initializer_list<unsigned char> sequence)
+        {
+            for (const unsigned char value : sequence)
+            {
+                m_bytes[offset] = std::byte{value};
+                ++offset;
+            }
+        }
+
+    private:
+        std::vector<std::byte> m_bytes;
+    };
+
+    const std::array<Candidate, 2> &marker_ladder()
+    {
+        static const std::array<Candidate, 2> ladder = {
+            Candidate::direct("primary", scan::Pattern::literal("11 22 33 44 55 66")),
+            Candidate::direct("marker", scan::Pattern::literal("DE AD BE EF")),
+        };
+        return ladder;
+    }
+} // anonymous namespace
+
+TEST(ScanCacheTest, HostIdentityIsStable)
+{
+    const auto first = scan::module_identity(Region::host());
+    const auto second = scan::module_identity(Region::host());
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(*first, *second);
+    EXPECT_NE(first->size_of_image, 0u);
+}
+
+TEST(ScanCacheTest, IdentityRejectsNonImage)
+{
+    std::vector<std::byte> noise(0x1000, std::byte{0xCC});
+    const auto identity = scan::module_identity(Region{Address{noise.data()}, noise.size()});
+    ASSERT_FALSE(identity.has_value());
+    EXPECT_EQ(identity.error().code, ErrorCode::InvalidRange);
+    EXPECT_FALSE(scan::module_identity(Region{}).has_value());
+}
+
+TEST(ScanCacheTest, IdentityTracksTimestamp)
+{
+    const FakeImage a(0x11111111);
+    const FakeImage b(0x22222222);
+    const auto ia = scan::module_identity(a.region());
+    const auto ib = scan::module_identity(b.region());
+    ASSERT_TRUE(ia.has_value());
+    ASSERT_TRUE(ib.has_value());
+    EXPECT_NE(*ia, *ib);
+    EXPECT_EQ(ia->section_hash, ib->section_hash);
+}
+
+TEST(ScanCacheTest, WarmResolveHitsAndMatchesCold)
+{
+    FakeImage image(0x5EED);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache cache;
+    const scan::ScanRequest request{.ladder = marker_ladder(), .scope = image.region(), .cache = &cache};
+
+    const auto cold = scan::resolve(request);
+    ASSERT_TRUE(cold.has_value());
+    EXPECT_EQ(cold->address.raw(), image.address_of(0x2100));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+
+    const auto warm = scan::resolve(request);
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address, cold->address);
+    EXPECT_EQ(warm->winning_name, "marker");
+    EXPECT_EQ(cache.stats().hits, 1u);
+}
+
+TEST(ScanCacheTest, MovedSiteIsRejectedAndReplaced)
+{
+    FakeImage image(0x5EED);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache cache;
+    const scan::ScanRequest request{.ladder = marker_ladder(), .scope = image.region(), .cache = &cache};
+    ASSERT_TRUE(scan::resolve(request).has_value());
+
+    // Same identity, different live bytes: the remembered site no longer matches, so the full ladder runs and its
+    // result replaces the stale entry.
+    image.put(0x2100, {0xCC, 0xCC, 0xCC, 0xCC});
+    image.put(0x3200, {0xDE, 0xAD, 0xBE, 0xEF});
+    const auto moved = scan::resolve(request);
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved->address.raw(), image.address_of(0x3200));
+    EXPECT_EQ(cache.stats().rejected, 1u);
+    EXPECT_EQ(cache.size(), 1u);
+
+    ASSERT_TRUE(scan::resolve(request).has_value());
+    EXPECT_EQ(cache.stats().hits, 1u);
+}
+
+TEST(ScanCacheTest, DifferentBuildMisses)
+{
+    FakeImage old_build(0x1000);
+    FakeImage new_build(0x2000);
+    old_build.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    new_build.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache cache;
+    ASSERT_TRUE(
+        scan::resolve(scan::ScanRequest{.ladder = marker_ladder(), .scope = old_build.region(), .cache = &cache}));
+    ASSERT_TRUE(
+        scan::resolve(scan::ScanRequest{.ladder = marker_ladder(), .scope = new_build.region(), .cache = &cache}));
+    EXPECT_EQ(cache.stats().hits, 0u);
+    EXPECT_EQ(cache.stats().misses, 2u);
+    // One entry per request: the new build overwrote the old one.
+    EXPECT_EQ(cache.size(), 1u);
+}
+
+TEST(ScanCacheTest, NonImageScopeIsNotCached)
+{
+    std::vector<std::byte> noise(0x1000, std::byte{0xCC});
+    noise[0x100] = std::byte{0xDE};
+    noise[0x101] = std::byte{0xAD};
+    noise[0x102] = std::byte{0xBE};
+    noise[0x103] = std::byte{0xEF};
+    scan::ResolutionCache cache;
+    const auto hit = scan::resolve(scan::ScanRequest{
+        .ladder = marker_ladder(), .scope = Region{Address{noise.data()}, noise.size()}, .cache = &cache});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(ScanCacheTest, SerializeRoundTripKeepsWarmStart)
+{
+    FakeImage image(0x5EED);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache cold;
+    ASSERT_TRUE(scan::resolve(scan::ScanRequest{.ladder = marker_ladder(), .scope = image.region(), .cache = &cold}));
+
+    auto loaded = scan::ResolutionCache::parse(cold.serialize());
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->size(), 1u);
+    EXPECT_EQ(loaded->serialize(), cold.serialize());
+
+    const auto warm =
+        scan::resolve(scan::ScanRequest{.ladder = marker_ladder(), .scope = image.region(), .cache = &*loaded});
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address.raw(), image.address_of(0x2100));
+    EXPECT_EQ(loaded->stats().hits, 1u);
+}
+
+TEST(ScanCacheTest, ParseRejectsBadInput)
+{
+    EXPECT_EQ(scan::ResolutionCache::parse("").error().code, ErrorCode::MissingHeader);
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v0\n").error().code,
+              ErrorCode::MissingHeader);
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v1\n1\t2\t3\n").error().code,
+              ErrorCode::MalformedLine);
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v1\n1\t2\t3\t4\t5\t6\tzz\n").error().code,
+              ErrorCode::MalformedLine);
+
+    const auto crlf = scan::ResolutionCache::parse("# DetourModKit resolution cache v1\r\n\r\n1\t2\t3\t4\t0\t6\t7\r\n");
+    ASSERT_TRUE(crlf.has_value());
+    EXPECT_EQ(crlf->size(), 1u);
+}
+
+TEST(ScanCacheTest, SaveAndLoadFile)
+{
+    FakeImage image(0x5EED);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache cache;
+    ASSERT_TRUE(scan::resolve(scan::ScanRequest{.ladder = marker_ladder(), .scope = image.region(), .cache = &cache}));
+
+    const std::string path = std::string("dmk_resolution_cache_") + std::to_string(_getpid()) + ".tmp";
+    ASSERT_TRUE(cache.save(path).has_value());
+    const auto loaded = scan::ResolutionCache::load(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->serialize(), cache.serialize());
+
+    EXPECT_EQ(scan::ResolutionCache::load("dmk_resolution_cache_missing.tmp").error().code, ErrorCode::FileOpenFailed);
+}
+
+TEST(ScanCacheTest, SharedTableServesAnotherInstance)
+{
+    // The table outlives every cache in the process, so each shared test uses its own build identity.
+    FakeImage image(0x5A4ED001);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache first;
+    scan::ResolutionCache second;
+    ASSERT_TRUE(first.share_in_process().has_value());
+    ASSERT_TRUE(second.share_in_process().has_value());
+    EXPECT_TRUE(second.shares_in_process());
+    EXPECT_TRUE(second.share_in_process().has_value());
+
+    const scan::ScanRequest cold_request{.ladder = marker_ladder(), .scope = image.region(), .cache = &first};
+    const auto cold = scan::resolve(cold_request);
+    ASSERT_TRUE(cold.has_value());
+    EXPECT_EQ(first.stats().misses, 1u);
+
+    const scan::ScanRequest warm_request{.ladder = marker_ladder(), .scope = image.region(), .cache = &second};
+    const auto warm = scan::resolve(warm_request);
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address, cold->address);
+    EXPECT_EQ(second.stats().hits, 1u);
+    EXPECT_EQ(second.stats().shared_hits, 1u);
+    EXPECT_EQ(second.stats().misses, 0u);
+    // Adopted after it re-verified, so it persists with this cache too.
+    EXPECT_EQ(second.size(), 1u);
+}
+
+TEST(ScanCacheTest, StaleSharedEntryIsRejected)
+{
+    FakeImage image(0x5A4ED002);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    scan::ResolutionCache first;
+    scan::ResolutionCache second;
+    ASSERT_TRUE(first.share_in_process().has_value());
+    ASSERT_TRUE(second.share_in_process().has_value());
+    ASSERT_TRUE(scan::resolve({.ladder = marker_ladder(), .scope = image.region(), .cache = &first}).has_value());
+
+    // The published site no longer matches: the second instance scans in full and republishes the new site.
+    image.put(0x2100, {0xCC, 0xCC, 0xCC, 0xCC});
+    image.put(0x3200, {0xDE, 0xAD, 0xBE, 0xEF});
+    const auto moved = scan::resolve({.ladder = marker_ladder(), .scope = image.region(), .cache = &second});
+    ASSERT_TRUE(moved.has_value());
+    EXPECT_EQ(moved->address.raw(), image.address_of(0x3200));
+    EXPECT_EQ(second.stats().rejected, 1u);
+    EXPECT_EQ(second.stats().shared_hits, 0u);
+
+    scan::ResolutionCache third;
+    ASSERT_TRUE(third.share_in_process().has_value());
+    const auto warm = scan::resolve({.ladder = marker_ladder(), .scope = image.region(), .cache = &third});
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address.raw(), image.address_of(0x3200));
+    EXPECT_EQ(third.stats().shared_hits, 1u);
+}
+
+TEST(ScanCacheTest, ReloadCacheServesUncachedRequestsAcrossAnUnload)
+{
+    FakeImage image(0x7E10AD01);
+    image.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+    const scan::ScanRequest request{.ladder = marker_ladder(), .scope = image.region()};
+    ASSERT_TRUE(enable_reload_cache().has_value());
+    scan::ResolutionCache *const cache = reload_cache();
+    ASSERT_NE(cache, nullptr);
+
+    const auto cold = scan::resolve(request);
+    ASSERT_TRUE(cold.has_value());
+    EXPECT_EQ(cold->source, scan::HitSource::Ladder);
+    EXPECT_EQ(cache->stats().misses, 1u);
+
+    // The Logic DLL's unload keeps the cache, so its reload answers from the remembered site.
+    on_logic_dll_unload({});
+    const auto warm = scan::resolve(request);
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address, cold->address);
+    EXPECT_EQ(warm->source, scan::HitSource::Cache);
+
+    disable_reload_cache();
+    EXPECT_EQ(reload_cache(), nullptr);
+    EXPECT_EQ(cache->size(), 0u);
+    const auto after = scan::resolve(request);
+    ASSERT_TRUE(after.has_value());
+    EXPECT_EQ(after->source, scan::HitSource::Ladder);
+}
+
+TEST(ScanCacheTest, AdaptiveOrderPromotesTheTierThatResolves)
+{
+    // A non-image scope keeps no entry, so every resolve walks the ladder and only the tier history carries over.
+    std::vector<std::byte> noise(0x1000, std::byte{0xCC});
+    for (const std::size_t at : {std::size_t{0x100}, std::size_t{0x300}})
+    {
+        noise[at] = std::byte{0xC3};
+        noise[at + 1] = std::byte{0x90};
+    }
+    noise[0x200] = std::byte{0xDE};
+    noise[0x201] = std::byte{0xAD};
+    noise[0x202] = std::byte{0xBE};
+    noise[0x203] = std::byte{0xEF};
+    const std::array<Candidate, 3> ladder = {
+        Candidate::direct("absent", scan::Pattern::literal("11 22 33 44 55 66")),
+        Candidate::direct("twice", scan::Pattern::literal("C3 90")),
+        Candidate::direct("marker", scan::Pattern::literal("DE AD BE EF")),
+    };
+    scan::ResolutionCache cache;
+    const scan::ScanRequest request{.ladder = ladder,
+                                    .scope = Region{Address{noise.data()}, noise.size()},
+                                    .order = scan::CandidateOrder::Adaptive,
+                                    .cache = &cache};
+
+    EXPECT_EQ(cache.tier_history(request), std::vector<scan::TierStats>(3));
+    const auto cold = scan::resolve(request);
+    ASSERT_TRUE(cold.has_value());
+    EXPECT_EQ(cold->winning_name, "marker");
+    std::vector<scan::TierStats> history = cache.tier_history(request);
+    ASSERT_EQ(history.size(), 3u);
+    EXPECT_EQ(history[0].misses, 1u);
+    EXPECT_EQ(history[1].ambiguous, 1u);
+    EXPECT_EQ(history[2].hits, 1u);
+    EXPECT_EQ(cache.size(), 0u);
+
+    // The tier that resolved now leads, so the warm walk tries it alone and the losing tiers keep their one attempt.
+    const auto warm = scan::resolve(request);
+    ASSERT_TRUE(warm.has_value());
+    EXPECT_EQ(warm->address, cold->address);
+    history = cache.tier_history(request);
+    EXPECT_EQ(history[0].attempts(), 1u);
+    EXPECT_EQ(history[1].attempts(), 1u);
+    EXPECT_EQ(history[2].hits, 2u);
+
+    // A tier tried a full window's worth of times has its counters halved.
+    for (std::uint32_t i = 2; i < scan::ResolutionCache::TIER_HISTORY_WINDOW; ++i)
+    {
+        ASSERT_TRUE(scan::resolve(request).has_value());
+    }
+    EXPECT_EQ(cache.tier_history(request)[2].hits, scan::ResolutionCache::TIER_HISTORY_WINDOW / 2);
+
+    // Other orders neither read nor record history.
+    scan::ScanRequest declared = request;
+    declared.order = scan::CandidateOrder::AsDeclared;
+    ASSERT_TRUE(scan::resolve(declared).has_value());
+    EXPECT_EQ(cache.tier_history(declared), std::vector<scan::TierStats>(3));
+
+    cache.clear();
+    EXPECT_EQ(cache.tier_history(request), std::vector<scan::TierStats>(3));
+}
+
+TEST(ScanCacheTest, TierHistorySurvivesSerializeAndV1StillLoads)
+{
+    std::vector<std::byte> noise(0x1000, std::byte{0xCC});
+    noise[0x200] = std::byte{0xDE};
+    noise[0x201] = std::byte{0xAD};
+    noise[0x202] = std::byte{0xBE};
+    noise[0x203] = std::byte{0xEF};
+    scan::ResolutionCache cache;
+    const scan::ScanRequest request{.ladder = marker_ladder(),
+                                    .scope = Region{Address{noise.data()}, noise.size()},
+                                    .order = scan::CandidateOrder::Adaptive,
+                                    .cache = &cache};
+    ASSERT_TRUE(scan::resolve(request).has_value());
+
+    const std::string text = cache.serialize();
+    EXPECT_EQ(text.rfind("# DetourModKit resolution cache v3\n", 0), 0u);
+    auto loaded = scan::ResolutionCache::parse(text);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->serialize(), text);
+    EXPECT_EQ(loaded->tier_history(request), cache.tier_history(request));
+
+    const auto v1 = scan::ResolutionCache::parse("# DetourModKit resolution cache v1\n1\t2\t3\t4\t0\t6\t7\n");
+    ASSERT_TRUE(v1.has_value());
+    EXPECT_EQ(v1->size(), 1u);
+    // A v1 file has no tier lines, and a tier index past the cap is a corrupt line.
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v1\ntier\t1\t0\t1\t0\t0\t5\n").error().code,
+              ErrorCode::MalformedLine);
+    const auto past_cap = scan::ResolutionCache::parse("# DetourModKit resolution cache v2\ntier\t1\t40\t1\t0\t0\t5\n");
+    EXPECT_EQ(past_cap.error().code, ErrorCode::MalformedLine);
+}
+
+TEST(ScanCacheTest, CalibrationSurvivesSerializeAndNeedsV3)
+{
+    scan::ResolutionCache cache;
+    EXPECT_FALSE(cache.calibration().has_value());
+    scan::SimdCalibration calibration{};
+    calibration.level = scan::SimdLevel::Avx2;
+    calibration.workers = 6;
+    calibration.tier_nanos = {0, 4100, 2300, 0};
+    calibration.speedup_permille = 5800;
+    calibration.host_key = 0xABCDEF0123456789ULL;
+    calibration.from_cache = true;
+    cache.record_calibration(calibration);
+
+    const std::string text = cache.serialize();
+    EXPECT_NE(text.find("simd\tabcdef0123456789\t2\t6\t16a8\t1004\t8fc\t0\n"), std::string::npos);
+    auto loaded = scan::ResolutionCache::parse(text);
+    ASSERT_TRUE(loaded.has_value());
+    ASSERT_TRUE(loaded->calibration().has_value());
+    // from_cache describes how calibrate_simd got a result, so it is not part of what the cache stores.
+    calibration.from_cache = false;
+    EXPECT_EQ(*loaded->calibration(), calibration);
+    EXPECT_EQ(loaded->serialize(), text);
+
+    // A v2 file predates the line, and a level past Avx512 or a short line is corrupt.
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v2\nsimd\t1\t2\t6\t0\t1\t2\t0\n")
+                  .error()
+                  .code,
+              ErrorCode::MalformedLine);
+    EXPECT_EQ(scan::ResolutionCache::parse("# DetourModKit resolution cache v3\nsimd\t1\t9\t6\t0\t1\t2\t0\n")
+                  .error()
+                  .code,
+              ErrorCode::MalformedLine);
+    EXPECT_EQ(
+        scan::ResolutionCache::parse("# DetourModKit resolution cache v3\nsimd\t1\t2\t6\t0\t1\t2\n").error().code,
+        ErrorCode::MalformedLine);
+
+    loaded->clear();
+    EXPECT_FALSE(loaded->calibration().has_value());
+}
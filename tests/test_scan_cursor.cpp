@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+
+#include <windows.h>
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_cursor.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    // Three cursor slices of committed, zero-filled memory, so a walk needs several steps and a planted match can sit
+    // across a slice boundary.
+    constexpr std::size_t ARENA_BYTES = 3 * scan::SCAN_CURSOR_SLICE_BYTES;
+
+    class Arena
+    {
+    public:
+        Arena()
+            : m_base(static_cast<std::uint8_t *>(
+                  VirtualAlloc(nullptr, ARENA_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+        {
+        }
+        ~Arena()
+        {
+            if (m_base != nullptr)
+                VirtualFree(m_base, 0, MEM_RELEASE);
+        }
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        [[nodiscard]] bool ok() const noexcept { return m_base != nullptr; }
+        [[nodiscard]] Region region() const noexcept { return Region{Address{m_base}, ARENA_BYTES}; }
+        [[nodiscard]] std::uintptr_t address_of(std::size_t offset) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(m_base + offset);
+        }
+
+        void put(std::size_t offset, std::initializer_list<std::uint8_t> sequence) noexcept
+        {
+            for (const std::uint8_t value : sequence)
+            {
+                m_base[offset] = value;
+                ++offset;
+            }
+        }
+
+    private:
+        std::uint8_t *m_base;
+    };
+
+    // Steps a cursor with a zero budget (one slice per step) until it is done; returns the step count.
+    std::size_t drain(scan::ScanCursor &cursor)
+    {
+        std::size_t steps = 0;
+        while (!cursor.done())
+        {
+            (void)cursor.step(std::chrono::microseconds{0});
+            ++steps;
+        }
+        return steps;
+    }
+} // anonymous namespace
+
+TEST(ScanCursorTest, SlicedWalkMatchesOneShotScan)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    // The first occurrence straddles the first slice boundary; the second lies two slices in.
+    arena.put(scan::SCAN_CURSOR_SLICE_BYTES - 2, {0xDE, 0xAD, 0xBE, 0xEF});
+    arena.put(2 * scan::SCAN_CURSOR_SLICE_BYTES + 0x123, {0xDE, 0xAD, 0xBE, 0xEF});
+    const auto pattern = scan::Pattern::compile("DE AD | BE EF");
+    ASSERT_TRUE(pattern.has_value());
+
+    for (const std::size_t occurrence : {std::size_t{1}, std::size_t{2}, std::size_t{3}})
+    {
+        auto cursor = scan::ScanCursor::start(*pattern, arena.region(), occurrence);
+        ASSERT_TRUE(cursor.has_value());
+        EXPECT_FALSE(cursor->done());
+        EXPECT_FALSE(cursor->result().has_value());
+        const std::size_t steps = drain(*cursor);
+        EXPECT_GE(steps, occurrence == 1 ? 1u : 3u);
+
+        const auto sliced = cursor->result();
+        ASSERT_TRUE(sliced.has_value());
+        const auto one_shot = scan::scan(*pattern, arena.region(), occurrence);
+        ASSERT_EQ(sliced->has_value(), one_shot.has_value()) << "occurrence " << occurrence;
+        if (one_shot.has_value())
+        {
+            EXPECT_EQ(**sliced, *one_shot);
+        }
+        else
+        {
+            EXPECT_EQ(sliced->error().code, ErrorCode::NoMatch);
+        }
+    }
+
+    auto first = scan::ScanCursor::start(*pattern, arena.region());
+    ASSERT_TRUE(first.has_value());
+    (void)drain(*first);
+    EXPECT_EQ(first->result()->value().raw(), arena.address_of(scan::SCAN_CURSOR_SLICE_BYTES));
+}
+
+TEST(ScanCursorTest, ProgressAdvancesAndStopsAtTheVerdict)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    const auto pattern = scan::Pattern::compile("11 22 33 44 55");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto cursor = scan::ScanCursor::start(*pattern, arena.region());
+    ASSERT_TRUE(cursor.has_value());
+    const scan::ScanProgress first = cursor->step(std::chrono::microseconds{0});
+    EXPECT_FALSE(first.done);
+    EXPECT_EQ(first.total_bytes, ARENA_BYTES);
+    EXPECT_EQ(first.scanned_bytes, scan::SCAN_CURSOR_SLICE_BYTES);
+
+    (void)drain(*cursor);
+    const scan::ScanProgress last = cursor->progress();
+    EXPECT_TRUE(last.done);
+    EXPECT_EQ(last.scanned_bytes, last.total_bytes);
+    ASSERT_TRUE(cursor->result().has_value());
+    EXPECT_EQ(cursor->result()->error().code, ErrorCode::NoMatch);
+
+    // A finished cursor does no further work.
+    const scan::ScanProgress again = cursor->step(std::chrono::microseconds{1000});
+    EXPECT_TRUE(again.done);
+    EXPECT_EQ(again.scanned_bytes, last.scanned_bytes);
+}
+
+TEST(ScanCursorTest, GenerousBudgetFinishesInOneStep)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    arena.put(ARENA_BYTES - 0x40, {0xCA, 0xFE, 0xBA, 0xBE});
+    const auto pattern = scan::Pattern::compile("CA FE BA BE");
+    ASSERT_TRUE(pattern.has_value());
+
+    auto cursor = scan::ScanCursor::start(*pattern, arena.region());
+    ASSERT_TRUE(cursor.has_value());
+    const scan::ScanProgress progress = cursor->step(std::chrono::seconds{10});
+    EXPECT_TRUE(progress.done);
+    ASSERT_TRUE(cursor->result().has_value());
+    ASSERT_TRUE(cursor->result()->has_value());
+    EXPECT_EQ(cursor->result()->value().raw(), arena.address_of(ARENA_BYTES - 0x40));
+}
+
+TEST(ScanCursorTest, StartRejectsWhatScanRejects)
+{
+    std::uint8_t bytes[64] = {};
+    const Region scope{Address{bytes}, sizeof(bytes)};
+    const auto pattern = scan::Pattern::compile("AA BB");
+    ASSERT_TRUE(pattern.has_value());
+
+    EXPECT_EQ(scan::ScanCursor::start(*pattern, scope, 0).error().code, ErrorCode::NoMatch);
+    EXPECT_EQ(scan::ScanCursor::start(*pattern, Region{}).error().code, ErrorCode::InvalidRange);
+    EXPECT_EQ(scan::ScanCursor::start(*pattern, scope, 1, static_cast<scan::Pages>(7)).error().code,
+              ErrorCode::InvalidArg);
+}
+
+TEST(ScanCursorTest, MovedFromCursorReportsDone)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    const auto pattern = scan::Pattern::compile("AA BB CC");
+    ASSERT_TRUE(pattern.has_value());
+    auto cursor = scan::ScanCursor::start(*pattern, arena.region());
+    ASSERT_TRUE(cursor.has_value());
+
+    scan::ScanCursor moved = std::move(*cursor);
+    EXPECT_FALSE(moved.done());
+    EXPECT_TRUE(cursor->done());
+    ASSERT_TRUE(cursor->result().has_value());
+    EXPECT_EQ(cursor->result()->error().code, ErrorCode::InvalidArg);
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <windows.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "DetourModKit/scan.hpp"
+
+using namespace DetourModKit;
+
+#if defined(_MSC_VER)
+#define DMK_TEST_NOINLINE __declspec(noinline)
+#elif defined(__GNUC__) || defined(__clang__)
+#define DMK_TEST_NOINLINE [[gnu::noinline]]
+#else
+#define DMK_TEST_NOINLINE
+#endif
+
+namespace
+{
+    // An address inside the calling test body. A test body always calls out, so it registers unwind data, and asking
+    // for a return address sidesteps the incremental-link thunk that taking a function's address can yield.
+    DMK_TEST_NOINLINE std::uintptr_t caller_address()
+    {
+#if defined(_MSC_VER)
+        return reinterpret_cast<std::uintptr_t>(_ReturnAddress());
+#else
+        return reinterpret_cast<std::uintptr_t>(__builtin_return_address(0));
+#endif
+    }
+} // namespace
+
+TEST(FunctionTableTest, MatchesTheLoaderForCodeInThisImage)
+{
+    const std::uintptr_t inside = caller_address();
+
+    DWORD64 image_base = 0;
+    const PRUNTIME_FUNCTION loader = RtlLookupFunctionEntry(inside, &image_base, nullptr);
+    ASSERT_NE(loader, nullptr);
+
+    const Result<scan::FunctionBounds> bounds = scan::function_containing(Address{inside});
+    ASSERT_TRUE(bounds.has_value()) << bounds.error().message();
+    EXPECT_EQ(bounds->begin.raw(), static_cast<std::uintptr_t>(image_base) + loader->BeginAddress);
+    EXPECT_EQ(bounds->end.raw(), static_cast<std::uintptr_t>(image_base) + loader->EndAddress);
+    EXPECT_LE(bounds->begin.raw(), inside);
+    EXPECT_LT(inside, bounds->end.raw());
+    EXPECT_NE(bounds->entry.raw(), 0u);
+
+    // The second query answers from the cached index with the same range.
+    const Result<scan::FunctionBounds> again = scan::function_containing(Address{inside});
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(again->entry.raw(), bounds->entry.raw());
+    EXPECT_EQ(again->begin.raw(), bounds->begin.raw());
+    EXPECT_EQ(again->end.raw(), bounds->end.raw());
+}
+
+TEST(FunctionTableTest, ImageHeadersAreNotInAnyFunction)
+{
+    const auto base = reinterpret_cast<std::uintptr_t>(GetModuleHandleW(nullptr));
+    ASSERT_NE(base, 0u);
+
+    const Result<scan::FunctionBounds> bounds = scan::function_containing(Address{base});
+    ASSERT_FALSE(bounds.has_value());
+    EXPECT_EQ(bounds.error().code, ErrorCode::FunctionNotFound);
+    EXPECT_EQ(bounds.error().detail, base);
+}
+
+TEST(FunctionTableTest, RejectsNullAndNonImageAddresses)
+{
+    const Result<scan::FunctionBounds> null_bounds = scan::function_containing(Address{});
+    ASSERT_FALSE(null_bounds.has_value());
+    EXPECT_EQ(null_bounds.error().code, ErrorCode::NullInput);
+
+    const std::vector<std::byte> heap(64);
+    const auto heap_address = reinterpret_cast<std::uintptr_t>(heap.data());
+    const Result<scan::FunctionBounds> heap_bounds = scan::function_containing(Address{heap_address});
+    ASSERT_FALSE(heap_bounds.has_value());
+    EXPECT_EQ(heap_bounds.error().code, ErrorCode::InvalidRange);
+    EXPECT_EQ(heap_bounds.error().detail, heap_address);
+}
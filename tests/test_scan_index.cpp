@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_index.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    void plant(std::vector<std::uint8_t> &buffer, std::size_t at, std::initializer_list<std::uint8_t> bytes)
+    {
+        std::size_t i = at;
+        for (const std::uint8_t b : bytes)
+        {
+            buffer[i++] = b;
+        }
+    }
+
+    [[nodiscard]] std::uintptr_t at(const std::vector<std::uint8_t> &buffer, std::size_t offset)
+    {
+        return reinterpret_cast<std::uintptr_t>(buffer.data() + offset);
+    }
+
+    [[nodiscard]] scan::CodeIndexOptions readable_options()
+    {
+        scan::CodeIndexOptions options;
+        options.pages = scan::Pages::Readable;
+        return options;
+    }
+} // namespace
+
+TEST(ScanIndexTest, AnswersMatchTheLiveScan)
+{
+    // Noise with a low period so most grams repeat, plus a few planted sites.
+    std::vector<std::uint8_t> buffer(0x20000);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer[i] = static_cast<std::uint8_t>((i * 7) % 13);
+    }
+    plant(buffer, 0x1230, {0x48, 0x8B, 0x05, 0x11, 0x22, 0x33, 0x44, 0xE8});
+    plant(buffer, 0x9000, {0x48, 0x8B, 0x05, 0x55, 0x66, 0x77, 0x88, 0xE8});
+    plant(buffer, 0x1FF00, {0x48, 0x8B, 0x05, 0x99, 0xAA, 0xBB, 0xCC, 0xE8});
+    const Region scope{Address{buffer.data()}, buffer.size()};
+
+    const auto index = scan::CodeIndex::build(scope, readable_options());
+    ASSERT_TRUE(index.has_value()) << index.error().message();
+    EXPECT_TRUE(index->stats().complete);
+
+    const scan::Pattern pattern = scan::Pattern::literal("48 8B 05 | ?? ?? ?? ?? E8");
+    ASSERT_TRUE(index->accelerates(pattern));
+
+    std::array<Address, 8> indexed{};
+    std::array<Address, 8> live{};
+    const auto from_index = index->find_all(pattern, indexed);
+    const auto from_live = scan::find_all(pattern, scope, live, scan::Pages::Readable);
+    ASSERT_TRUE(from_index.has_value());
+    ASSERT_TRUE(from_live.has_value());
+    EXPECT_TRUE(from_index->complete());
+    ASSERT_EQ(from_index->matches, 3u);
+    ASSERT_EQ(from_index->matches, from_live->matches);
+    for (std::size_t i = 0; i < from_index->matches; ++i)
+    {
+        EXPECT_EQ(indexed[i].raw(), live[i].raw());
+    }
+    EXPECT_EQ(indexed[0].raw(), at(buffer, 0x1233));
+
+    const auto second = index->scan(pattern, 2);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(second->raw(), at(buffer, 0x9003));
+    EXPECT_FALSE(index->scan(pattern, 4).has_value());
+    EXPECT_FALSE(index->scan(pattern, 0).has_value());
+
+    std::array<Address, 2> small{};
+    const auto partial = index->find_all(pattern, small);
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_TRUE(partial->stopped);
+    EXPECT_EQ(partial->matches, 2u);
+}
+
+TEST(ScanIndexTest, SiteAcrossAShardBoundaryIsFoundOnce)
+{
+    std::vector<std::uint8_t> buffer(scan::CODE_INDEX_SHARD_BYTES + 0x10000, 0x90);
+    // The first gram sits in the first shard and the rest of the site in the second.
+    plant(buffer, scan::CODE_INDEX_SHARD_BYTES - 2, {0xF3, 0x0F, 0x10, 0x4D, 0xC2, 0x7A, 0x19, 0x3E});
+    const Region scope{Address{buffer.data()}, buffer.size()};
+
+    const auto index = scan::CodeIndex::build(scope, readable_options());
+    ASSERT_TRUE(index.has_value()) << index.error().message();
+    EXPECT_EQ(index->stats().shards, 2u);
+
+    std::array<Address, 4> found{};
+    const auto straddling = index->find_all(scan::Pattern::literal("F3 0F 10 4D C2 7A 19 3E"), found);
+    ASSERT_TRUE(straddling.has_value());
+    ASSERT_EQ(straddling->matches, 1u);
+    EXPECT_EQ(found[0].raw(), at(buffer, scan::CODE_INDEX_SHARD_BYTES - 2));
+
+    // Its rarest grams may now both lie in the second shard.
+    const auto tail = index->find_all(scan::Pattern::literal("?? 0F 10 4D C2 7A 19"), found);
+    ASSERT_TRUE(tail.has_value());
+    ASSERT_EQ(tail->matches, 1u);
+    EXPECT_EQ(found[0].raw(), at(buffer, scan::CODE_INDEX_SHARD_BYTES - 2));
+}
+
+TEST(ScanIndexTest, UnnarrowablePatternsFallBackToALiveScan)
+{
+    std::vector<std::uint8_t> buffer(0x4000, 0xCC);
+    plant(buffer, 0x800, {0xE8, 0x10, 0x20, 0x30, 0x40, 0x90, 0x90, 0xC3});
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const auto index = scan::CodeIndex::build(scope, readable_options());
+    ASSERT_TRUE(index.has_value());
+
+    const scan::Pattern jump = scan::Pattern::literal("E8 10 20 30 [1-4] C3");
+    const scan::Pattern sparse = scan::Pattern::literal("E8 ?? 20 ?? 40");
+    for (const scan::Pattern &pattern : {jump, sparse})
+    {
+        EXPECT_FALSE(index->accelerates(pattern));
+        const auto indexed = index->scan(pattern);
+        const auto live = scan::scan(pattern, scope, 1, scan::Pages::Readable);
+        ASSERT_TRUE(indexed.has_value());
+        ASSERT_TRUE(live.has_value());
+        EXPECT_EQ(indexed->raw(), live->raw());
+    }
+}
+
+TEST(ScanIndexTest, StaleSitesAreNotReported)
+{
+    std::vector<std::uint8_t> buffer(0x4000, 0x00);
+    plant(buffer, 0x100, {0x40, 0x53, 0x48, 0x83, 0xEC, 0x20});
+    plant(buffer, 0x200, {0x40, 0x53, 0x48, 0x83, 0xEC, 0x20});
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const auto index = scan::CodeIndex::build(scope, readable_options());
+    ASSERT_TRUE(index.has_value());
+
+    buffer[0x104] = 0xED;
+    const auto first = index->scan(scan::Pattern::literal("40 53 48 83 EC 20"));
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->raw(), at(buffer, 0x200));
+}
+
+TEST(ScanIndexTest, ReportsItsCostAndHonoursTheBudget)
+{
+    std::vector<std::uint8_t> buffer(0x8000);
+    for (std::size_t i = 0; i < buffer.size(); ++i)
+    {
+        buffer[i] = static_cast<std::uint8_t>(i * 31 + (i >> 8));
+    }
+    const Region scope{Address{buffer.data()}, buffer.size()};
+
+    const auto index = scan::CodeIndex::build(scope, readable_options());
+    ASSERT_TRUE(index.has_value());
+    const scan::CodeIndexStats stats = index->stats();
+    EXPECT_EQ(stats.indexed_bytes, buffer.size());
+    EXPECT_EQ(stats.postings, buffer.size() - 3);
+    EXPECT_GT(stats.grams, 0u);
+    EXPECT_GT(stats.bytes_per_indexed_byte(), 0.0);
+    EXPECT_EQ(index->scope().base.raw(), scope.base.raw());
+
+    scan::CodeIndexOptions tight = readable_options();
+    tight.memory_budget = 1;
+    const auto refused = scan::CodeIndex::build(scope, tight);
+    ASSERT_FALSE(refused.has_value());
+    EXPECT_EQ(refused.error().code, ErrorCode::OutOfMemory);
+    EXPECT_EQ(refused.error().detail, stats.resident_bytes);
+
+    EXPECT_FALSE(scan::CodeIndex::build(Region{}, readable_options()).has_value());
+    scan::CodeIndexOptions bad = readable_options();
+    bad.pages = static_cast<scan::Pages>(0x7F);
+    const auto invalid = scan::CodeIndex::build(scope, bad);
+    ASSERT_FALSE(invalid.has_value());
+    EXPECT_EQ(invalid.error().code, ErrorCode::InvalidArg);
+}
@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_ladder_store.hpp"
+
+using namespace DetourModKit;
+using scan::Candidate;
+using scan::LadderHandle;
+using scan::LadderStore;
+
+namespace
+{
+    // One rung of every tier, with a name long enough to leave the small-string buffer.
+    [[nodiscard]] std::vector<Candidate> mixed_ladder()
+    {
+        std::vector<Candidate> ladder;
+        ladder.push_back(Candidate::direct("direct-with-a-long-diagnostic-name",
+                                           scan::Pattern::literal("48 8B 05 ?? ?? ?? ?? | 8B 4?"), -2));
+        ladder.push_back(Candidate::rip_relative("rip", scan::Pattern::literal("48 8D 0D [1-3] ?? ?? ?? ?? C3"), 3, 7));
+        ladder.push_back(Candidate::rtti_vtable("rtti", ".?AVCameraManager@@"));
+        const scan::StringRefQuery query{.text = "PlayerController",
+                                         .encoding = scan::StringEncoding::Utf16le,
+                                         .require_terminator = false,
+                                         .return_mode = scan::XrefReturn::EnclosingFunction,
+                                         .broad_match = true};
+        ladder.push_back(Candidate::string_xref("xref", query));
+        return ladder;
+    }
+
+    void expect_same_pattern(const scan::Pattern &a, const scan::Pattern &b)
+    {
+        EXPECT_EQ(a.size(), b.size());
+        EXPECT_EQ(a.offset(), b.offset());
+        EXPECT_EQ(a.segment_count(), b.segment_count());
+        EXPECT_EQ(a.min_match_length(), b.min_match_length());
+        EXPECT_EQ(a.max_match_length(), b.max_match_length());
+        EXPECT_EQ(a.has_anchor(), b.has_anchor());
+        EXPECT_EQ(a.anchor_index(), b.anchor_index());
+        EXPECT_TRUE(std::ranges::equal(a.bytes(), b.bytes()));
+        EXPECT_TRUE(std::ranges::equal(a.mask(), b.mask()));
+    }
+} // namespace
+
+TEST(LadderStoreTest, RebuildsEveryTierWithItsContent)
+{
+    const std::vector<Candidate> original = mixed_ladder();
+    LadderStore store;
+    const Result<LadderHandle> handle = store.add(original);
+    ASSERT_TRUE(handle.has_value()) << handle.error().message();
+    EXPECT_TRUE(store.contains(*handle));
+    EXPECT_EQ(store.size(*handle), original.size());
+    EXPECT_EQ(store.name(*handle, 0), "direct-with-a-long-diagnostic-name");
+    EXPECT_EQ(store.name(*handle, 3), "xref");
+    EXPECT_TRUE(store.name(*handle, 4).empty());
+
+    const Result<std::vector<Candidate>> rebuilt = store.ladder(*handle);
+    ASSERT_TRUE(rebuilt.has_value());
+    ASSERT_EQ(rebuilt->size(), original.size());
+    for (std::size_t i = 0; i < original.size(); ++i)
+    {
+        EXPECT_EQ((*rebuilt)[i].name(), original[i].name());
+        EXPECT_EQ((*rebuilt)[i].mode(), original[i].mode());
+    }
+
+    const scan::DirectPattern &direct = *(*rebuilt)[0].as_direct();
+    expect_same_pattern(direct.pattern, original[0].as_direct()->pattern);
+    EXPECT_EQ(direct.walk_back, -2);
+
+    const scan::RipRelativePattern &rip = *(*rebuilt)[1].as_rip_relative();
+    expect_same_pattern(rip.pattern, original[1].as_rip_relative()->pattern);
+    EXPECT_TRUE(rip.pattern.has_jumps());
+    EXPECT_EQ(rip.displacement_at, 3);
+    EXPECT_EQ(rip.instruction_length, 7u);
+
+    EXPECT_EQ((*rebuilt)[2].as_rtti_vtable()->mangled, ".?AVCameraManager@@");
+
+    const scan::StringXref &xref = *(*rebuilt)[3].as_string_xref();
+    EXPECT_EQ(xref.text, "PlayerController");
+    EXPECT_EQ(xref.encoding, scan::StringEncoding::Utf16le);
+    EXPECT_FALSE(xref.require_terminator);
+    EXPECT_EQ(xref.return_mode, scan::XrefReturn::EnclosingFunction);
+    EXPECT_TRUE(xref.broad_match);
+}
+
+TEST(LadderStoreTest, IdenticalLaddersShareOneHandleAndPool)
+{
+    LadderStore store;
+    const Result<LadderHandle> first = store.add(mixed_ladder());
+    const Result<LadderHandle> again = store.add(mixed_ladder());
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(again.has_value());
+    EXPECT_EQ(*first, *again);
+
+    // A ladder that differs only in one rung's walk-back is a different ladder, but its patterns and strings are
+    // already pooled.
+    std::vector<Candidate> shifted = mixed_ladder();
+    shifted[0] = Candidate::direct("direct-with-a-long-diagnostic-name",
+                                   scan::Pattern::literal("48 8B 05 ?? ?? ?? ?? | 8B 4?"), 0);
+    const Result<LadderHandle> other = store.add(shifted);
+    ASSERT_TRUE(other.has_value());
+    EXPECT_NE(*other, *first);
+
+    const scan::LadderStoreStats stats = store.stats();
+    EXPECT_EQ(stats.ladders, 2u);
+    EXPECT_EQ(stats.ladders_added, 3u);
+    EXPECT_EQ(stats.rungs, 8u);
+    EXPECT_EQ(stats.patterns, 2u);
+    // Four rung names, the mangled name and the literal.
+    EXPECT_EQ(stats.strings, 6u);
+    EXPECT_GE(stats.candidate_bytes, 12 * sizeof(Candidate));
+    EXPECT_LT(stats.resident_bytes, stats.candidate_bytes);
+}
+
+TEST(LadderStoreTest, RejectsEmptyLadderAndUnknownHandles)
+{
+    LadderStore store;
+    const Result<LadderHandle> empty = store.add({});
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, ErrorCode::EmptyCandidates);
+
+    EXPECT_FALSE(store.contains(LadderHandle::Invalid));
+    EXPECT_EQ(store.size(LadderHandle::Invalid), 0u);
+    const Result<std::vector<Candidate>> missing = store.ladder(LadderHandle::Invalid);
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_EQ(missing.error().code, ErrorCode::InvalidArg);
+
+    const Result<LadderHandle> handle = store.add(mixed_ladder());
+    ASSERT_TRUE(handle.has_value());
+    store.clear();
+    EXPECT_FALSE(store.contains(*handle));
+    EXPECT_EQ(store.stats().ladders, 0u);
+
+    LadderStore moved = std::move(store);
+    const Result<LadderHandle> after_move = store.add(mixed_ladder());
+    ASSERT_FALSE(after_move.has_value());
+    EXPECT_EQ(after_move.error().code, ErrorCode::InvalidArg);
+    EXPECT_TRUE(moved.add(mixed_ladder()).has_value());
+}
+
+TEST(LadderStoreTest, ResolveMatchesTheOriginalLadder)
+{
+    std::array<std::byte, 4096> buffer{};
+    buffer.fill(std::byte{0xCC});
+    constexpr std::array<std::uint8_t, 8> signature{0x4C, 0x8B, 0x3D, 0x5A, 0xA5, 0x17, 0x71, 0xE9};
+    std::memcpy(buffer.data() + 1500, signature.data(), signature.size());
+
+    const Candidate ladder[] = {
+        Candidate::direct("absent", scan::Pattern::literal("11 22 33 44 55 66 77 88")),
+        Candidate::direct("present", scan::Pattern::literal("4C 8B 3D 5A A5 17 71 E9"), 4),
+    };
+    const Region scope{Address{reinterpret_cast<std::uintptr_t>(buffer.data())}, buffer.size()};
+    const scan::ScanRequest request{.ladder = ladder, .label = "ladder-store", .scope = scope};
+
+    LadderStore store;
+    const Result<LadderHandle> handle = store.add(ladder);
+    ASSERT_TRUE(handle.has_value());
+
+    const Result<scan::Hit> direct = scan::resolve(request);
+    const Result<scan::Hit> stored = store.resolve(*handle, request);
+    ASSERT_TRUE(direct.has_value()) << direct.error().message();
+    ASSERT_TRUE(stored.has_value()) << stored.error().message();
+    EXPECT_EQ(stored->address, direct->address);
+    EXPECT_EQ(stored->address.raw(), reinterpret_cast<std::uintptr_t>(buffer.data()) + 1504);
+    EXPECT_EQ(stored->winning_name, "present");
+
+    const Result<scan::Hit> unknown = store.resolve(LadderHandle::Invalid, request);
+    ASSERT_FALSE(unknown.has_value());
+    EXPECT_EQ(unknown.error().code, ErrorCode::InvalidArg);
+}
@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DetourModKit/scan.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    [[nodiscard]] bool same_compiled(const scan::Pattern &a, const scan::Pattern &b)
+    {
+        return std::ranges::equal(a.bytes(), b.bytes()) && std::ranges::equal(a.mask(), b.mask()) &&
+               a.offset() == b.offset() && a.has_anchor() == b.has_anchor() && a.anchor_index() == b.anchor_index();
+    }
+} // namespace
+
+TEST(PatternIntern, RepeatedCompileIsAnsweredFromTheTable)
+{
+    // Text unique to this test, so no other test could have interned it first.
+    constexpr const char *dsl = "4C 8D 0D ?? ?? ?? ?? | 41 B8 7A 13 00 00";
+
+    const scan::PatternInternStats before = scan::pattern_intern_stats();
+    const Result<scan::Pattern> first = scan::Pattern::compile(dsl);
+    ASSERT_TRUE(first.has_value());
+    const scan::PatternInternStats after_first = scan::pattern_intern_stats();
+    EXPECT_EQ(after_first.misses, before.misses + 1);
+
+    const Result<scan::Pattern> second = scan::Pattern::compile(dsl);
+    ASSERT_TRUE(second.has_value());
+    const scan::PatternInternStats after_second = scan::pattern_intern_stats();
+    EXPECT_EQ(after_second.hits, after_first.hits + 1);
+    EXPECT_EQ(after_second.misses, after_first.misses);
+
+    EXPECT_TRUE(same_compiled(*first, *second));
+    EXPECT_EQ(first->offset(), 7u);
+    EXPECT_LE(after_second.entries, after_second.capacity);
+}
+
+TEST(PatternIntern, InternedResultMatchesTheConstevalCompile)
+{
+    constexpr scan::Pattern literal = scan::Pattern::literal("E8 ?? ?? ?? ?? 84 C0 0F 84 3D 5A");
+    for (int round = 0; round < 3; ++round)
+    {
+        const Result<scan::Pattern> runtime = scan::Pattern::compile("E8 ?? ?? ?? ?? 84 C0 0F 84 3D 5A");
+        ASSERT_TRUE(runtime.has_value());
+        EXPECT_TRUE(same_compiled(literal, *runtime));
+    }
+}
+
+TEST(PatternIntern, MalformedTextIsNeverInterned)
+{
+    const scan::PatternInternStats before = scan::pattern_intern_stats();
+    for (int round = 0; round < 2; ++round)
+    {
+        const Result<scan::Pattern> bad = scan::Pattern::compile("48 8B ZZ");
+        ASSERT_FALSE(bad.has_value());
+        EXPECT_EQ(bad.error().code, ErrorCode::BadPattern);
+    }
+    const scan::PatternInternStats after = scan::pattern_intern_stats();
+    EXPECT_EQ(after.misses, before.misses + 2);
+    EXPECT_EQ(after.entries, before.entries);
+}
+
+TEST(PatternIntern, ConcurrentCompilesOfOneTextAgree)
+{
+    constexpr const char *dsl = "48 89 5C 24 ?? 57 48 83 EC 20 8B F9 E8 ?? ?? ?? ?? C3 91";
+    constexpr std::size_t THREADS = 8;
+
+    std::vector<std::vector<std::byte>> seen(THREADS);
+    std::vector<std::thread> workers;
+    workers.reserve(THREADS);
+    for (std::size_t t = 0; t < THREADS; ++t)
+    {
+        workers.emplace_back(
+            [&seen, t, dsl]
+            {
+                for (int round = 0; round < 64; ++round)
+                {
+                    const Result<scan::Pattern> compiled = scan::Pattern::compile(dsl);
+                    if (!compiled)
+                    {
+                        return;
+                    }
+                    seen[t].assign(compiled->bytes().begin(), compiled->bytes().end());
+                }
+            });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    const Result<scan::Pattern> reference = scan::Pattern::compile(dsl);
+    ASSERT_TRUE(reference.has_value());
+    for (const std::vector<std::byte> &bytes : seen)
+    {
+        EXPECT_TRUE(std::ranges::equal(bytes, reference->bytes()));
+    }
+}
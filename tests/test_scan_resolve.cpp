@@ -14,6 +14,7 @@
 #include <windows.h>
 
 #include "DetourModKit/memory.hpp"
+#include "DetourModKit/region_set.hpp"
 #include "DetourModKit/scan.hpp"
 
 using namespace DetourModKit;
@@ -634,6 +635,127 @@ TEST(ScanResolve, OwnedScanRequestViewResolves)
     EXPECT_EQ(hit->winning_name, "owned");
 }
 
+// A RegionSet scope: one ladder resolved across several disjoint spans as though they were one scope.
+TEST(ScanResolve, RegionSetScopeProvesUniquenessAcrossEverySpan)
+{
+    ReadableBuffer first(0x400);
+    ReadableBuffer second(0x400);
+    first.put(0x100, {0xDE, 0xAD, 0xBE, 0xEF});
+    second.put(0x200, {0xDE, 0xAD, 0xBE, 0xEF});
+    second.put(0x300, {0xCA, 0xFE, 0xBA, 0xBE});
+
+    const std::array<Region, 2> spans = {first.region(), second.region()};
+    const Result<RegionSet> scope = RegionSet::of(spans);
+    ASSERT_TRUE(scope.has_value());
+
+    // Each span alone holds one DEADBEEF; across the set it is ambiguous, so the ladder falls through to CAFEBABE.
+    const std::array<Candidate, 2> ladder = {
+        Candidate::direct("split", scan::Pattern::literal("DE AD BE EF")),
+        Candidate::direct("unique", scan::Pattern::literal("CA FE BA BE")),
+    };
+    const auto alone = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = first.region()});
+    ASSERT_TRUE(alone.has_value());
+    EXPECT_EQ(alone->winning_name, "split");
+
+    const auto hit = scan::resolve(scan::ScanRequest{.ladder = ladder, .regions = &*scope});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->address.raw(), second.address_of(0x300));
+    EXPECT_EQ(hit->winning_name, "unique");
+
+    // The set, not the ignored scope field, bounds the owned form too.
+    scan::OwnedScanRequest owned;
+    owned.ladder.assign(ladder.begin(), ladder.end());
+    owned.scope = first.region();
+    owned.regions = *scope;
+    const auto owned_hit = scan::resolve(owned.view());
+    ASSERT_TRUE(owned_hit.has_value());
+    EXPECT_EQ(owned_hit->winning_name, "unique");
+}
+
+TEST(ScanResolve, HintWindowProvesUniquenessLocallyAndReportsItsSource)
+{
+    ReadableBuffer buffer(0x4000);
+    buffer.put(0x0100, {0xDE, 0xAD, 0xBE, 0xEF});
+    buffer.put(0x3100, {0xDE, 0xAD, 0xBE, 0xEF});
+
+    const std::array<Candidate, 1> ladder = {Candidate::direct("moved", scan::Pattern::literal("DE AD BE EF"))};
+    const auto full = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = buffer.region()});
+    EXPECT_FALSE(full.has_value());
+
+    // The window around the last-seen offset holds one copy, so it answers before the ambiguous full scope.
+    const auto hinted = scan::resolve(
+        scan::ScanRequest{.ladder = ladder, .scope = buffer.region(), .hint_rva = 0x3000, .hint_window = 0x400});
+    ASSERT_TRUE(hinted.has_value());
+    EXPECT_EQ(hinted->address.raw(), buffer.address_of(0x3100));
+    EXPECT_EQ(hinted->source, scan::HitSource::HintWindow);
+
+    // An offset past the scope's end is ignored rather than clamped onto the last bytes.
+    const auto outside = scan::resolve(
+        scan::ScanRequest{.ladder = ladder, .scope = buffer.region(), .hint_rva = 0x8000, .hint_window = 0x400});
+    EXPECT_FALSE(outside.has_value());
+}
+
+TEST(ScanResolve, EmptyHintWindowWidensToTheFullLadder)
+{
+    ReadableBuffer buffer(0x4000);
+    buffer.put(0x0500, {0xCA, 0xFE, 0xBA, 0xBE});
+
+    const std::array<Candidate, 1> ladder = {Candidate::direct("far", scan::Pattern::literal("CA FE BA BE"))};
+    const auto hit = scan::resolve(
+        scan::ScanRequest{.ladder = ladder, .scope = buffer.region(), .hint_rva = 0x2000, .hint_window = 0x100});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->address.raw(), buffer.address_of(0x500));
+    EXPECT_EQ(hit->source, scan::HitSource::Ladder);
+}
+
+TEST(ScanResolve, RegionSetScanCountsOccurrencesInAddressOrderAndSkipsGaps)
+{
+    ReadableBuffer buffer(0x3000);
+    buffer.put(0x0100, {0xDE, 0xAD, 0xBE, 0xEF});
+    buffer.put(0x1100, {0xDE, 0xAD, 0xBE, 0xEF}); // in the gap
+    buffer.put(0x2100, {0xDE, 0xAD, 0xBE, 0xEF});
+
+    // Two spans of one buffer with its middle third cut out; listed high span first to prove the set sorts them.
+    const Region whole = buffer.region();
+    const std::array<Region, 2> spans = {whole.sub(0x2000, 0x1000), whole.sub(0, 0x1000)};
+    const Result<RegionSet> scope = RegionSet::of(spans);
+    ASSERT_TRUE(scope.has_value());
+
+    const scan::Pattern pattern = scan::Pattern::literal("DE AD BE EF");
+    const auto first = scan::scan(pattern, *scope, 1);
+    const auto second = scan::scan(pattern, *scope, 2);
+    const auto third = scan::scan(pattern, *scope, 3);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(second.has_value());
+    EXPECT_EQ(first->raw(), buffer.address_of(0x0100));
+    EXPECT_EQ(second->raw(), buffer.address_of(0x2100));
+    ASSERT_FALSE(third.has_value());
+    EXPECT_EQ(third.error().code, ErrorCode::NoMatch);
+
+    // A Direct walk-back that lands in the gap is out of scope, exactly as past the end of a Region.
+    const std::array<Candidate, 1> into_gap = {
+        Candidate::direct("gap", scan::Pattern::literal("DE AD BE EF"), -0x1000)};
+    const std::array<Region, 2> around_gap = {whole.sub(0, 0x80), whole.sub(0x2000, 0x1000)};
+    const Result<RegionSet> unique_scope = RegionSet::of(around_gap);
+    ASSERT_TRUE(unique_scope.has_value());
+    const auto gap_hit = scan::resolve(scan::ScanRequest{.ladder = into_gap, .regions = &*unique_scope});
+    ASSERT_FALSE(gap_hit.has_value());
+    EXPECT_EQ(gap_hit.error().code, ErrorCode::NoMatch);
+}
+
+TEST(ScanResolve, EmptyRegionSetReturnsInvalidRange)
+{
+    const std::array<Candidate, 1> ladder = {Candidate::direct("marker", scan::Pattern::literal("DE AD BE EF"))};
+    const RegionSet empty;
+    const auto hit = scan::resolve(scan::ScanRequest{.ladder = ladder, .regions = &empty});
+    ASSERT_FALSE(hit.has_value());
+    EXPECT_EQ(hit.error().code, ErrorCode::InvalidRange);
+
+    const auto scanned = scan::scan(scan::Pattern::literal("DE AD BE EF"), empty);
+    ASSERT_FALSE(scanned.has_value());
+    EXPECT_EQ(scanned.error().code, ErrorCode::InvalidRange);
+}
+
 // The resolver's page-class knob (ScanRequest::pages). A byte candidate can restrict its sweep to executable pages so a
 // signature that has to land on an instruction cannot alias an identical run in a data section. The discriminating case
 // is a match that lives only on a non-executable page: Readable resolves it, Executable excludes it.
@@ -685,6 +807,7 @@ static_assert(noexcept(scan::candidate_order_to_string(scan::CandidateOrder::AsD
               "candidate_order_to_string must be noexcept: it is a callback-safe pure value map.");
 static_assert(scan::candidate_order_to_string(scan::CandidateOrder::AsDeclared) == "AsDeclared");
 static_assert(scan::candidate_order_to_string(scan::CandidateOrder::UniqueFirst) == "UniqueFirst");
+static_assert(scan::candidate_order_to_string(scan::CandidateOrder::Adaptive) == "Adaptive");
 static_assert(scan::candidate_order_to_string(static_cast<scan::CandidateOrder>(0xFF)) == "Unknown");
 
 TEST(ScanResolve, CandidateOrderToStringIsTotalAndDistinct)
@@ -692,6 +815,7 @@ TEST(ScanResolve, CandidateOrderToStringIsTotalAndDistinct)
     // Every declared enumerator maps to its own non-empty name.
     EXPECT_EQ(scan::candidate_order_to_string(scan::CandidateOrder::AsDeclared), "AsDeclared");
     EXPECT_EQ(scan::candidate_order_to_string(scan::CandidateOrder::UniqueFirst), "UniqueFirst");
+    EXPECT_EQ(scan::candidate_order_to_string(scan::CandidateOrder::Adaptive), "Adaptive");
     EXPECT_NE(scan::candidate_order_to_string(scan::CandidateOrder::AsDeclared),
               scan::candidate_order_to_string(scan::CandidateOrder::UniqueFirst));
 
@@ -1523,3 +1647,95 @@ TEST(ScanResolve, InvalidPageClassFailsClosed)
     ASSERT_FALSE(matched.has_value());
     EXPECT_EQ(matched.error().code, ErrorCode::InvalidArg);
 }
+
+TEST(ScanResolve, TunedAnchorsLeaveScanVerdictsUnchanged)
+{
+    // Sixteen bytes of real host code, compiled as a runtime pattern, give an Executable host scan a genuine target.
+    const auto *code = reinterpret_cast<const unsigned char *>(&scan::active_simd_level);
+    std::string dsl;
+    for (std::size_t i = 0; i < 16; ++i)
+    {
+        constexpr std::string_view digits = "0123456789ABCDEF";
+        dsl += digits[code[i] >> 4];
+        dsl += digits[code[i] & 0x0F];
+        dsl += ' ';
+    }
+    const auto pattern = scan::Pattern::compile(dsl);
+    ASSERT_TRUE(pattern.has_value());
+    const auto before = scan::scan(*pattern, Region::host(), 1, scan::Pages::Executable);
+
+    const auto tuned = scan::tune_anchors(Region::host());
+    ASSERT_TRUE(tuned.has_value());
+    EXPECT_GT(*tuned, 0u);
+
+    // The profile only changes which byte the prefilter sweeps for, never the verdict.
+    const auto after = scan::scan(*pattern, Region::host(), 1, scan::Pages::Executable);
+    ASSERT_EQ(after.has_value(), before.has_value());
+    if (before.has_value())
+    {
+        EXPECT_EQ(*after, *before);
+    }
+    const std::array<Candidate, 1> ladder = {
+        Candidate::direct("host-marker", scan::Pattern::literal("7A 6B 68 71 44 4D 4B 48 6F 73 74 4D 61 72 6B 21"))};
+    const auto marker = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = Region::host()});
+    ASSERT_TRUE(marker.has_value());
+    EXPECT_EQ(marker->address.raw(),
+              reinterpret_cast<std::uintptr_t>(const_cast<const unsigned char *>(g_host_scan_marker)));
+}
+
+TEST(ScanResolve, TuneAnchorsRejectsNonImages)
+{
+    ReadableBuffer buffer(0x2000);
+    EXPECT_EQ(scan::tune_anchors(Region{}).error().code, ErrorCode::InvalidRange);
+    EXPECT_EQ(scan::tune_anchors(buffer.region()).error().code, ErrorCode::InvalidRange);
+}
+
+#ifdef DMK_ENABLE_SCAN_TELEMETRY
+TEST(ScanResolve, TelemetryCountsTheWorkOfAScanAndAResolve)
+{
+    static_assert(scan::SCAN_TELEMETRY_ENABLED);
+    ReadableBuffer buffer(0x4000);
+    buffer.put(0x1000, {0xDE, 0xAD, 0xBE, 0xEF});
+    buffer.put(0x2000, {0xDE, 0xAD, 0x90, 0xBE, 0xEF});
+
+    const scan::ScanTelemetryTotals before = scan::scan_telemetry_totals();
+    const auto site = scan::scan(scan::Pattern::literal("DE AD BE EF"), buffer.region(), 1, scan::Pages::Readable);
+    ASSERT_TRUE(site.has_value());
+    const scan::ScanTelemetry scanned = scan::last_scan_telemetry();
+    EXPECT_GE(scanned.regions_walked, 1u);
+    EXPECT_GE(scanned.bytes_scanned, 0x4000u);
+    EXPECT_GE(scanned.anchor_candidates, 1u);
+    EXPECT_GE(scanned.verify_calls, 1u);
+    EXPECT_EQ(scanned.segmented_steps, 0u);
+    EXPECT_EQ(scanned.faults, 0u);
+
+    // Only the site at 0x2000 has a one-byte gap; the jump matcher's steps are counted too.
+    const std::array<Candidate, 1> gapped = {Candidate::direct("gapped", scan::Pattern::literal("DE AD [1-2] BE EF"))};
+    const auto hit = scan::resolve(scan::ScanRequest{.ladder = gapped, .scope = buffer.region()});
+    ASSERT_TRUE(hit.has_value()) << hit.error().message();
+    EXPECT_GE(hit->telemetry.bytes_scanned, 0x4000u);
+    EXPECT_GT(hit->telemetry.segmented_steps, 0u);
+    EXPECT_EQ(scan::last_scan_telemetry().bytes_scanned, hit->telemetry.bytes_scanned);
+
+    const scan::ScanTelemetryTotals after = scan::scan_telemetry_totals();
+    EXPECT_GE(after.scans, before.scans + 2);
+    EXPECT_GE(after.totals.bytes_scanned, before.totals.bytes_scanned + 2 * 0x4000u);
+
+    scan::reset_scan_telemetry_totals();
+    EXPECT_EQ(scan::scan_telemetry_totals().scans, 0u);
+}
+#else
+TEST(ScanResolve, TelemetryStaysZeroWhenCompiledOut)
+{
+    static_assert(!scan::SCAN_TELEMETRY_ENABLED);
+    ReadableBuffer buffer(0x1000);
+    buffer.put(0x100, {0xDE, 0xAD, 0xBE, 0xEF});
+    const std::array<Candidate, 1> ladder = {Candidate::direct("marker", scan::Pattern::literal("DE AD BE EF"))};
+    const auto hit = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = buffer.region()});
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_EQ(hit->telemetry.bytes_scanned, 0u);
+    EXPECT_EQ(hit->telemetry.elapsed.count(), 0);
+    EXPECT_EQ(scan::last_scan_telemetry().verify_calls, 0u);
+    EXPECT_EQ(scan::scan_telemetry_totals().scans, 0u);
+}
+#endif
@@ -3,8 +3,10 @@
 #include <array>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <span>
+#include <stdexcept>
 #include <stop_token>
 #include <string>
 #include <string_view>
@@ -12,6 +14,7 @@
 #include <vector>
 
 #include "DetourModKit/scan.hpp"
+#include "DetourModKit/scan_cache.hpp"
 
 // White-box engine tests: the raw matcher, page walks, and batch live in the private engine.
 #include "internal/scan_engine.hpp"
@@ -275,9 +278,9 @@ TEST(ScannerJumpsTest, SegmentZeroWithoutLiteralAnchor)
 }
 
 // A multi-gap pattern with an all-wildcard leading segment drives the worst-case matcher shape: no anchor forces an
-// iterate-every-start sweep, and each start explores the product of the gap spans (no memoization). This pins that the
-// shape TERMINATES and is CORRECT -- a miss returns nullptr after exhausting every start x skip combination, and a
-// reachable target is still found -- documenting that the cost is bounded in depth but combinatorial in work.
+// iterate-every-start sweep, and a backtracking search would explore the product of the gap spans at each start. This
+// pins that the shape TERMINATES and is CORRECT -- a miss returns nullptr after ruling out every start x skip
+// combination, and a reachable target is still found.
 TEST(ScannerJumpsTest, MultiGapExhaustiveBacktrackingTerminates)
 {
     const auto p = detail::parse_aob("?? [0-3] ?? [0-3] FF");
@@ -453,10 +456,11 @@ TEST(ScannerJumpsTest, UncheckedScanFailsClosedOnBudgetExhaustion)
 
 // Nth-occurrence scans restart at the byte after each prior match. The shared work state must survive that real suffix
 // loop: after the first two-node match consumes the final two visits, the second suffix must fail closed rather than
-// reset the region budget and return the second match.
+// reset the region budget and return the second match. The gap is wider than BITAP_MAX_MATCH_LENGTH allows, so the
+// pattern stays on the budgeted backtracking matcher.
 TEST(ScannerJumpsTest, SharedRegionBudgetPersistsAcrossNthSuffixScan)
 {
-    const auto pattern = detail::parse_aob("A5 [0] FF");
+    const auto pattern = detail::parse_aob("A5 [0-200] FF");
     ASSERT_TRUE(pattern.has_value());
 
     detail::SegmentedScanBudget budget{.node_visits = detail::SEGMENT_MATCH_REGION_STEP_BUDGET - 2};
@@ -468,6 +472,52 @@ TEST(ScannerJumpsTest, SharedRegionBudgetPersistsAcrossNthSuffixScan)
     EXPECT_TRUE(budget.region_exhausted);
 }
 
+// A span that fits the bit-parallel automaton is matched in one linear sweep, not by backtracking. Eight 15-wide gaps
+// give roughly 15^8 gap combinations from the lone anchor -- far past SEGMENT_MATCH_STEP_BUDGET for the search tree --
+// yet the 121-byte span fits BITAP_MAX_MATCH_LENGTH, so the miss is proven and a later match is a confident leftmost
+// hit: no budget is spent and nothing is flagged incomplete.
+TEST(ScannerJumpsTest, NarrowSpanPatternNeedsNoBacktrackingBudget)
+{
+    const auto p = detail::parse_aob("A5 [0-14] ?? [0-14] ?? [0-14] ?? [0-14] ?? [0-14] ?? [0-14] ?? [0-14] ?? "
+                                     "[0-14] FF");
+    ASSERT_TRUE(p.has_value());
+    ASSERT_LE(p->max_match_length(), detail::BITAP_MAX_MATCH_LENGTH);
+
+    std::vector<std::byte> region(1024, std::byte{0x00});
+    region[0] = std::byte{0xA5}; // no FF within its reach: a clean, exhaustive miss
+
+    detail::SegmentedScanBudget budget{};
+    const detail::RawMatch miss = detail::find_pattern_raw(region.data(), 512, *p, &budget);
+    EXPECT_EQ(miss.start, nullptr);
+    EXPECT_FALSE(miss.budget_exhausted);
+    EXPECT_EQ(budget.node_visits, 0u);
+
+    region[600] = std::byte{0xA5};
+    region[700] = std::byte{0xFF}; // 100 bytes on: reachable through a mix of gap widths
+    const detail::RawMatch hit = detail::find_pattern_raw(region.data(), region.size(), *p, &budget);
+    ASSERT_EQ(hit.start, region.data() + 600);
+    EXPECT_EQ(hit.end, region.data() + 701);
+    EXPECT_FALSE(hit.budget_exhausted);
+    EXPECT_EQ(detail::find_pattern(region.data(), region.size(), *p), region.data() + 600);
+}
+
+// The automaton reports the same placement the backtracking search would: the leftmost start, then the smallest gap at
+// each boundary that still lets the rest of the pattern fit. Here the nearest BB strands CC, so the second BB wins, and
+// the offset marker resolves through the chosen gaps.
+TEST(ScannerJumpsTest, NarrowSpanPatternKeepsLeftmostSmallestGapPlacement)
+{
+    const auto p = detail::parse_aob("AA [0-4] BB [1-3] | CC");
+    ASSERT_TRUE(p.has_value());
+
+    const auto region = bytes_of({0x00, 0xAA, 0xBB, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xCC, 0xCC, 0x00, 0x00});
+
+    const detail::RawMatch raw = detail::find_pattern_raw(region.data(), region.size(), *p);
+    ASSERT_EQ(raw.start, region.data() + 1);
+    EXPECT_EQ(raw.point, region.data() + 8); // BB at 6, one-byte gap: the first CC, not the second
+    EXPECT_EQ(raw.end, region.data() + 9);
+    EXPECT_FALSE(raw.budget_exhausted);
+}
+
 // The runtime AOB parser grows a heap-backed pattern, so an allocation failure mid-parse must fail closed to nullopt
 // rather than terminate. parse_pattern_into is intentionally not noexcept, and parse_aob catches bad_alloc; without
 // that, the bad_alloc would cross a noexcept boundary and std::terminate would abort this process.
@@ -1306,6 +1356,68 @@ TEST(ScannerTest, compile_anchor_empty_pattern_marks_no_anchor)
     EXPECT_EQ(empty.anchor, empty.size());
 }
 
+// parse_aob() also caches the paired-prefilter partner: the rarest segment-0 literal other than the anchor. A later
+// segment's byte never qualifies, because it sits at a gap-dependent distance from the anchor.
+TEST(ScannerTest, parse_aob_caches_partner_index)
+{
+    const auto pattern = detail::parse_aob("48 8B 37 0F E8 90 CC");
+    ASSERT_TRUE(pattern.has_value());
+    EXPECT_EQ(pattern->anchor, 2u);
+    EXPECT_EQ(pattern->partner, 4u);
+
+    const auto repeated = detail::parse_aob("37 ?? ?? 37");
+    ASSERT_TRUE(repeated.has_value());
+    EXPECT_EQ(repeated->anchor, 0u);
+    EXPECT_EQ(repeated->partner, 3u);
+
+    const auto lone = detail::parse_aob("?? 37 ??");
+    ASSERT_TRUE(lone.has_value());
+    EXPECT_EQ(lone->partner, lone->size());
+
+    const auto jumped = detail::parse_aob("37 [2-4] 5A");
+    ASSERT_TRUE(jumped.has_value());
+    EXPECT_EQ(jumped->partner, jumped->size());
+}
+
+// The paired prefilter tests the anchor and its partner in one vector step. With every byte an anchor hit, only the
+// planted partner byte decides the first candidate, so the sweep must agree with the single-byte sweep at every lane
+// seam of both vector bodies, and for a partner on either side of the anchor.
+TEST(ScannerTest, PairedPrefilterMatchesSingleAnchorSweep)
+{
+    const auto pattern = detail::parse_aob("37 ?? ?? ?? 5A");
+    ASSERT_TRUE(pattern.has_value());
+    ASSERT_EQ(pattern->anchor, 0u);
+    ASSERT_EQ(pattern->partner, 4u);
+
+    detail::EnginePattern single = *pattern;
+    single.partner = single.size();
+    // Anchored on the trailing 5A with the inline-selected partner 37 four bytes before it.
+    detail::EnginePattern backwards = *pattern;
+    backwards.anchor = 4;
+    backwards.partner = std::numeric_limits<std::size_t>::max();
+
+    for (const std::size_t size : {std::size_t{40}, std::size_t{96}})
+    {
+        for (const std::size_t planted : {4u, 15u, 16u, 19u, 20u, 31u, 32u, 35u, 36u, 47u, 63u, 95u})
+        {
+            if (planted >= size)
+            {
+                continue;
+            }
+            std::vector<std::byte> data(size, std::byte{0x37});
+            data[planted] = std::byte{0x5A};
+            const std::byte *const expected = data.data() + (planted - 4);
+
+            EXPECT_EQ(detail::find_pattern(data.data(), data.size(), *pattern), expected) << size << "/" << planted;
+            EXPECT_EQ(detail::find_pattern(data.data(), data.size(), single), expected) << size << "/" << planted;
+            EXPECT_EQ(detail::find_pattern(data.data(), data.size(), backwards), expected) << size << "/" << planted;
+        }
+
+        std::vector<std::byte> miss(size, std::byte{0x37});
+        EXPECT_EQ(detail::find_pattern(miss.data(), miss.size(), *pattern), nullptr);
+    }
+}
+
 TEST(ScannerTest, parse_aob_invariant)
 {
     auto result = detail::parse_aob("48 ?? 8B 05 ?? ??");
@@ -2482,6 +2594,86 @@ TEST(ScannerTest, active_simd_level_print)
     std::printf("[  DIAG   ] Scanner SIMD level: %s\n", names[static_cast<int>(level)]);
 }
 
+// Startup SIMD calibration
+
+TEST(ScannerTest, calibrate_simd_measures_every_supported_tier_and_applies_the_pick)
+{
+    std::vector<std::byte> sample(16 * 1024);
+    for (std::size_t i = 0; i < sample.size(); ++i)
+    {
+        sample[i] = static_cast<std::byte>((i * 131 + 7) & 0xFF);
+    }
+    const scan::SimdLevel detected = scan::active_simd_level();
+
+    scan::CalibrationOptions options;
+    options.rounds = 2;
+    const auto calibration = scan::calibrate_simd(Region{Address{sample.data()}, sample.size()}, options);
+    ASSERT_TRUE(calibration.has_value());
+    EXPECT_FALSE(calibration->from_cache);
+    EXPECT_EQ(calibration->host_key, scan::calibration_host_key());
+    EXPECT_GE(calibration->level, scan::SimdLevel::Sse2);
+    EXPECT_LE(calibration->level, detected);
+    for (auto tier = static_cast<std::size_t>(scan::SimdLevel::Sse2); tier <= static_cast<std::size_t>(detected);
+         ++tier)
+    {
+        EXPECT_GT(calibration->tier_nanos[tier], 0u) << tier;
+    }
+    EXPECT_LE(calibration->workers, std::max(1u, std::thread::hardware_concurrency()));
+    EXPECT_EQ(scan::active_simd_level(), calibration->level);
+
+    // The capped engine still matches: the tier only changes how wide each compare is.
+    std::string aob;
+    for (int i = 0; i < 64; ++i)
+    {
+        aob += "?? ";
+    }
+    aob += std::format("{:02X}", std::to_integer<unsigned>(sample[1000 + 64]));
+    const auto pattern = detail::parse_aob(aob);
+    ASSERT_TRUE(pattern.has_value());
+    const std::byte *hit = detail::find_pattern(sample.data() + 1000, sample.size() - 1000, *pattern);
+    EXPECT_EQ(hit, sample.data() + 1000);
+
+    scan::reset_simd_calibration();
+    EXPECT_EQ(scan::active_simd_level(), detected);
+}
+
+TEST(ScannerTest, calibrate_simd_rejects_a_tiny_sample_and_reuses_a_cached_result)
+{
+    std::vector<std::byte> tiny(64, std::byte{0x90});
+    const auto rejected = scan::calibrate_simd(Region{Address{tiny.data()}, tiny.size()});
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::RegionTooSmall);
+
+    scan::ResolutionCache cache;
+    scan::SimdCalibration recorded{};
+    recorded.level = scan::SimdLevel::Sse2;
+    recorded.workers = 1;
+    recorded.host_key = scan::calibration_host_key();
+    cache.record_calibration(recorded);
+
+    // A cached result for this host is returned without reading the sample at all.
+    scan::CalibrationOptions options;
+    options.cache = &cache;
+    const auto reused = scan::calibrate_simd(Region{Address{tiny.data()}, tiny.size()}, options);
+    ASSERT_TRUE(reused.has_value());
+    EXPECT_TRUE(reused->from_cache);
+    EXPECT_EQ(reused->level, scan::SimdLevel::Sse2);
+    EXPECT_EQ(scan::active_simd_level(), scan::SimdLevel::Sse2);
+    scan::reset_simd_calibration();
+
+    // One recorded for another host is ignored, and the fresh measurement replaces it.
+    recorded.host_key ^= 1;
+    cache.record_calibration(recorded);
+    std::vector<std::byte> sample(4096, std::byte{0xCC});
+    options.apply = false;
+    options.measure_workers = false;
+    const auto fresh = scan::calibrate_simd(Region{Address{sample.data()}, sample.size()}, options);
+    ASSERT_TRUE(fresh.has_value());
+    EXPECT_FALSE(fresh->from_cache);
+    ASSERT_TRUE(cache.calibration().has_value());
+    EXPECT_EQ(cache.calibration()->host_key, scan::calibration_host_key());
+}
+
 // AVX2 path tests (32+ byte patterns)
 // Correctness tests for patterns that exercise the AVX2 verification tier. active_simd_level() above confirms whether
 // AVX2 is actually in use.
@@ -3408,3 +3600,151 @@ TEST(ScannerRegionGuard, SurvivesConcurrentDecommitMidSweep)
     EXPECT_TRUE(event_payload_ok);
 }
 #endif // _MSC_VER || _WIN64
+
+// for_each_match visits exactly the matches the occurrence scan counts, in order and each once. 150 planted copies
+// overrun several enumeration batches, and one copy straddles a protection split so the carry is exercised too.
+TEST(ScannerEnumerateTest, ForEachMatchAgreesWithOccurrenceScan)
+{
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+    const SIZE_T page = si.dwPageSize;
+    auto *base = static_cast<std::uint8_t *>(VirtualAlloc(nullptr, page * 3, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    ASSERT_NE(base, nullptr);
+    std::memset(base, 0xCC, page * 3);
+
+    const std::uint8_t sig[8] = {0x7D, 0x1B, 0xE4, 0x39, 0x62, 0xA0, 0x5F, 0xC8};
+    std::vector<const std::uint8_t *> planted;
+    for (std::size_t i = 0; i < 150; ++i)
+    {
+        planted.push_back(base + 16 + i * 24);
+    }
+    planted.push_back(base + page * 2 - 4);
+    for (const std::uint8_t *at : planted)
+    {
+        std::memcpy(const_cast<std::uint8_t *>(at), sig, sizeof(sig));
+    }
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(base + page * 2, page, PAGE_READONLY, &old_protect));
+
+    const Region scope{Address{base}, page * 3};
+    const auto pattern = scan::Pattern::compile("7D 1B E4 39 62 A0 5F C8");
+    ASSERT_TRUE(pattern.has_value());
+
+    std::vector<Address> visited;
+    const auto summary = scan::for_each_match(*pattern, scope, [&](Address match) { visited.push_back(match); });
+    ASSERT_TRUE(summary.has_value());
+    EXPECT_TRUE(summary->complete());
+    EXPECT_EQ(summary->matches, planted.size());
+    ASSERT_EQ(visited.size(), planted.size());
+    for (std::size_t i = 0; i < planted.size(); ++i)
+    {
+        EXPECT_EQ(visited[i], Address{planted[i]}) << i;
+    }
+    const auto last = scan::scan(*pattern, scope, planted.size());
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(*last, visited.back());
+    EXPECT_FALSE(scan::scan(*pattern, scope, planted.size() + 1).has_value());
+
+    VirtualFree(base, 0, MEM_RELEASE);
+}
+
+TEST(ScannerEnumerateTest, FindAllReportsAnUndersizedTable)
+{
+    std::vector<std::uint8_t> buffer(0x800, 0xCC);
+    for (const std::size_t at : {std::size_t{0x40}, std::size_t{0x300}, std::size_t{0x7F0}})
+    {
+        const std::uint8_t sig[4] = {0x9E, 0x27, 0xB3, 0x51};
+        std::memcpy(buffer.data() + at, sig, sizeof(sig));
+    }
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const scan::Pattern pattern = scan::Pattern::literal("9E 27 | B3 51");
+
+    std::array<Address, 3> exact{};
+    const auto full = scan::find_all(pattern, scope, exact);
+    ASSERT_TRUE(full.has_value());
+    EXPECT_TRUE(full->complete());
+    EXPECT_EQ(full->matches, 3u);
+    EXPECT_EQ(exact[0].raw(), reinterpret_cast<std::uintptr_t>(buffer.data() + 0x42));
+    EXPECT_EQ(exact[2].raw(), reinterpret_cast<std::uintptr_t>(buffer.data() + 0x7F2));
+
+    std::array<Address, 2> small_table{};
+    const auto partial = scan::find_all(pattern, scope, small_table);
+    ASSERT_TRUE(partial.has_value());
+    EXPECT_TRUE(partial->stopped);
+    EXPECT_FALSE(partial->complete());
+    EXPECT_EQ(partial->matches, 2u);
+    EXPECT_EQ(small_table[1], exact[1]);
+
+    const auto none = scan::find_all(scan::Pattern::literal("01 02 03 04"), scope, exact);
+    ASSERT_TRUE(none.has_value());
+    EXPECT_TRUE(none->complete());
+    EXPECT_EQ(none->matches, 0u);
+}
+
+TEST(ScannerEnumerateTest, VisitorEndsTheWalk)
+{
+    std::vector<std::uint8_t> buffer(0x400, 0x5B);
+    const Region scope{Address{buffer.data()}, buffer.size()};
+    const scan::Pattern pattern = scan::Pattern::literal("5B 5B");
+
+    std::size_t seen = 0;
+    const auto stopped = scan::for_each_match(pattern, scope, [&](Address) { return ++seen < 10; });
+    ASSERT_TRUE(stopped.has_value());
+    EXPECT_TRUE(stopped->stopped);
+    EXPECT_EQ(stopped->matches, 9u);
+    EXPECT_EQ(seen, 10u);
+
+    const auto thrown = scan::for_each_match(pattern, scope, [](Address) -> bool { throw std::runtime_error("x"); });
+    ASSERT_TRUE(thrown.has_value());
+    EXPECT_TRUE(thrown->stopped);
+    EXPECT_EQ(thrown->matches, 0u);
+
+    const auto empty = scan::for_each_match(pattern, Region{}, [](Address) {});
+    ASSERT_FALSE(empty.has_value());
+    EXPECT_EQ(empty.error().code, ErrorCode::InvalidRange);
+    const auto bad_pages = scan::for_each_match(pattern, scope, [](Address) {}, static_cast<scan::Pages>(7));
+    ASSERT_FALSE(bad_pages.has_value());
+    EXPECT_EQ(bad_pages.error().code, ErrorCode::InvalidArg);
+}
+
+// The streaming sweep walks the region in blocks; a match on either side of a block edge, and a paired anchor whose
+// partner lies across one, must be found exactly as the plain sweep finds them.
+TEST(ScannerStreamingTest, StreamingSweepFindsWhatThePlainSweepFinds)
+{
+    std::vector<std::byte> data(detail::STREAMING_BLOCK_BYTES * 12, std::byte{0x48});
+    const std::array<std::size_t, 4> sites{detail::STREAMING_BLOCK_BYTES - 3, detail::STREAMING_BLOCK_BYTES * 5,
+                                           detail::STREAMING_BLOCK_BYTES * 9 - 1, data.size() - 6};
+    for (const std::size_t at : sites)
+    {
+        const std::array<std::uint8_t, 6> bytes{0x37, 0x8B, 0x05, 0xC3, 0x90, 0xE8};
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            data[at + i] = std::byte{bytes[i]};
+        }
+    }
+    auto pattern = detail::parse_aob("37 8B 05 C3 ?? E8");
+    ASSERT_TRUE(pattern.has_value());
+
+    const std::size_t saved = detail::streaming_sweep_threshold();
+    std::array<const std::byte *, 5> plain{};
+    std::array<const std::byte *, 5> streamed{};
+    detail::set_streaming_sweep_threshold(std::numeric_limits<std::size_t>::max());
+    for (std::size_t n = 0; n < plain.size(); ++n)
+    {
+        plain[n] = detail::find_pattern(data.data(), data.size(), *pattern, n + 1);
+    }
+    detail::set_streaming_sweep_threshold(0);
+    for (std::size_t n = 0; n < streamed.size(); ++n)
+    {
+        streamed[n] = detail::find_pattern(data.data(), data.size(), *pattern, n + 1);
+    }
+    detail::set_streaming_sweep_threshold(saved);
+
+    for (std::size_t n = 0; n < sites.size(); ++n)
+    {
+        EXPECT_EQ(plain[n], data.data() + sites[n]);
+        EXPECT_EQ(streamed[n], plain[n]);
+    }
+    EXPECT_EQ(streamed[4], nullptr);
+    EXPECT_EQ(plain[4], nullptr);
+}
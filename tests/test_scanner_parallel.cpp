@@ -3,10 +3,13 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 #include <span>
 #include <stdexcept>
+#include <stop_token>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "DetourModKit/memory.hpp"
@@ -14,6 +17,7 @@
 
 #include "internal/scan_batch.hpp"
 #include "internal/scan_engine.hpp"
+#include "internal/scan_multi.hpp"
 #include "internal/scan_pages.hpp"
 
 // White-box include of the generic fork-join driver and the test binary's allocation-failure injector: the noexcept
@@ -420,6 +424,398 @@ TEST(ScannerBatchTest, ModuleBatchFailsClosedOnIncompleteSweep)
     EXPECT_EQ(results[0], nullptr);
 }
 
+// A module batch at or above MULTI_SCAN_MIN_PATTERNS takes the single-pass multi-pattern sweep. Every slot must resolve
+// exactly as its own serial module scan would: unique sigs, an Nth occurrence of a twice-planted sig, an absent sig, a
+// bounded-jump pattern (which falls back to its own scan), and a null item all sit in one batch.
+TEST(ScannerBatchTest, MultiSweepModuleBatchMatchesSerialScans)
+{
+    CommittedPage page(64 * 1024, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+
+    constexpr std::size_t UNIQUE_COUNT = 10;
+    std::vector<detail::EnginePattern> patterns;
+    patterns.reserve(UNIQUE_COUNT + 3);
+    for (std::size_t i = 0; i < UNIQUE_COUNT; ++i)
+    {
+        const auto sig = make_unique_sig(static_cast<std::uint32_t>(7600 + i));
+        std::memcpy(page.bytes() + 256 + i * 1024, sig.data(), sig.size());
+        patterns.push_back(detail::parse_aob(sig_to_aob(sig)).value());
+    }
+    const auto twice = make_unique_sig(7650);
+    std::memcpy(page.bytes() + 40000, twice.data(), twice.size());
+    std::memcpy(page.bytes() + 50000, twice.data(), twice.size());
+    patterns.push_back(detail::parse_aob(sig_to_aob(twice)).value());
+    patterns.push_back(detail::parse_aob(sig_to_aob(make_unique_sig(7651))).value()); // never planted
+    page.bytes()[60000] = std::byte{0xA7};
+    page.bytes()[60003] = std::byte{0x5E};
+    patterns.push_back(detail::parse_aob("A7 [1-4] 5E").value());
+
+    std::vector<detail::BatchScanItem> items;
+    for (std::size_t i = 0; i < UNIQUE_COUNT; ++i)
+    {
+        items.push_back(detail::BatchScanItem{&patterns[i], 1});
+    }
+    items.push_back(detail::BatchScanItem{&patterns[UNIQUE_COUNT], 2});
+    items.push_back(detail::BatchScanItem{&patterns[UNIQUE_COUNT + 1], 1});
+    items.push_back(detail::BatchScanItem{&patterns[UNIQUE_COUNT + 2], 1});
+    items.push_back(detail::BatchScanItem{nullptr, 1});
+    ASSERT_GE(items.size(), detail::MULTI_SCAN_MIN_PATTERNS);
+
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const detail::ModuleSpan range{base, base + page.size};
+    const auto results = detail::scan_module_batch(items, range, detail::ScannerKind::Readable);
+    ASSERT_EQ(results.size(), items.size());
+    for (std::size_t i = 0; i + 1 < items.size(); ++i)
+    {
+        const detail::MatchResult serial = detail::scan_module_readable(*items[i].pattern, range, items[i].occurrence);
+        EXPECT_EQ(results[i], serial.incomplete ? nullptr : serial.match) << "item=" << i;
+    }
+    EXPECT_EQ(results[UNIQUE_COUNT], page.bytes() + 50000);
+    EXPECT_EQ(results[UNIQUE_COUNT + 1], nullptr);
+    EXPECT_EQ(results[UNIQUE_COUNT + 2], page.bytes() + 60000);
+    EXPECT_EQ(results.back(), nullptr);
+}
+
+// The sweep's nibble-fingerprint skip may stop on a byte no pattern is anchored on (the exact bucket probe then
+// rejects it) but must never step over one that is: with at most eight anchor values the fingerprint is exact, and
+// beyond that it stays a superset. Both the vector body and the scalar tail are covered by the odd buffer length.
+TEST(ScannerBatchTest, AnchorClassSkipNeverPassesAnAnchorByte)
+{
+    std::vector<std::byte> buffer(4099);
+    std::uint32_t state = 0x1234567u;
+    for (std::byte &b : buffer)
+    {
+        state = state * 1664525u + 1013904223u;
+        b = std::byte{static_cast<std::uint8_t>(state >> 24)};
+    }
+    for (const std::size_t value_count : {std::size_t{1}, std::size_t{8}, std::size_t{24}})
+    {
+        detail::AnchorClass set;
+        std::array<bool, 256> member{};
+        for (std::size_t i = 0; i < value_count; ++i)
+        {
+            const auto value = static_cast<std::uint8_t>(i * 37u + 11u);
+            set.add(value, static_cast<unsigned>(i));
+            member[value] = true;
+        }
+        if (value_count <= 8)
+        {
+            for (std::size_t v = 0; v < 256; ++v)
+            {
+                EXPECT_EQ(set.may_contain(static_cast<std::uint8_t>(v)), member[v]) << "value=" << v;
+            }
+        }
+
+        const std::byte *const end = buffer.data() + buffer.size();
+        const std::byte *p = buffer.data();
+        const std::byte *expected = buffer.data();
+        while (true)
+        {
+            while (expected < end && !set.may_contain(std::to_integer<std::uint8_t>(*expected)))
+            {
+                ++expected;
+            }
+            p = detail::find_anchor_class(p, end, set);
+            ASSERT_EQ(p, expected) << "values=" << value_count;
+            if (p == end)
+            {
+                break;
+            }
+            ++p;
+            ++expected;
+        }
+    }
+}
+
+// The uniqueness-check form records the occurrence after the requested one, so the resolver needs no second sweep.
+TEST(ScannerBatchTest, MultiSweepRecordsNextOccurrence)
+{
+    CommittedPage page(16 * 1024, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+
+    const auto twice = make_unique_sig(7700);
+    const auto once = make_unique_sig(7701);
+    std::memcpy(page.bytes() + 1000, twice.data(), twice.size());
+    std::memcpy(page.bytes() + 9000, twice.data(), twice.size());
+    std::memcpy(page.bytes() + 5000, once.data(), once.size());
+    const auto twice_pattern = detail::parse_aob(sig_to_aob(twice)).value();
+    const auto once_pattern = detail::parse_aob(sig_to_aob(once)).value();
+
+    const detail::BatchScanItem items[] = {detail::BatchScanItem{&twice_pattern, 1},
+                                           detail::BatchScanItem{&once_pattern, 1}};
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const auto results =
+        detail::scan_module_multi(items, detail::ModuleSpan{base, base + page.size}, scan::Pages::Readable, true);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].match, page.bytes() + 1000);
+    EXPECT_EQ(results[0].next, page.bytes() + 9000);
+    EXPECT_FALSE(results[0].incomplete);
+    EXPECT_FALSE(results[0].next_incomplete);
+    EXPECT_EQ(results[1].match, page.bytes() + 5000);
+    EXPECT_EQ(results[1].next, nullptr);
+    EXPECT_FALSE(results[1].next_incomplete);
+}
+
+// Two adjacent readable regions with different protections form one contiguous run, so a signature straddling the
+// split is still found, exactly as the serial walk's cross-boundary carry finds it.
+TEST(ScannerBatchTest, MultiSweepFindsMatchStraddlingProtectionSplit)
+{
+    CommittedPage page(0x2000, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+    const auto sig = make_unique_sig(7800);
+    std::memcpy(page.bytes() + 0x1000 - 8, sig.data(), sig.size());
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(page.bytes() + 0x1000, 0x1000, PAGE_READONLY, &old_protect));
+
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const detail::BatchScanItem items[] = {detail::BatchScanItem{&pattern, 1}};
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const auto results =
+        detail::scan_module_multi(items, detail::ModuleSpan{base, base + page.size}, scan::Pages::Readable, false);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].match, page.bytes() + 0x1000 - 8);
+    EXPECT_FALSE(results[0].incomplete);
+}
+
+// The split scan cuts an image of at least SPLIT_SCAN_MIN_BYTES into chunks scanned in parallel. Copies placed to
+// straddle, end on, and begin on chunk boundaries must be counted exactly once and in address order, so every
+// occurrence -- including the one past the last copy -- matches the serial walk.
+TEST(ScannerBatchTest, SplitScanMatchesSerialAcrossChunkBoundaries)
+{
+    constexpr std::size_t image_bytes = std::size_t{24} << 20;
+    constexpr std::size_t chunk = detail::SPLIT_SCAN_MIN_CHUNK_BYTES;
+    CommittedPage page(image_bytes, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+
+    const auto sig = make_unique_sig(7900);
+    const std::size_t offsets[] = {chunk - 8, 2 * chunk - sig.size(), 2 * chunk, 3 * chunk + 100,
+                                   5 * chunk - 3};
+    for (const std::size_t offset : offsets)
+    {
+        std::memcpy(page.bytes() + offset, sig.data(), sig.size());
+    }
+
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const detail::ModuleSpan range{base, base + page.size};
+    for (std::size_t occurrence = 1; occurrence <= std::size(offsets) + 1; ++occurrence)
+    {
+        const detail::MatchResult serial = detail::scan_module_pages(pattern, range, scan::Pages::Readable, occurrence);
+        const detail::MatchResult split =
+            detail::scan_module_pages_split(pattern, range, scan::Pages::Readable, occurrence, 4);
+        EXPECT_EQ(split.match, serial.match) << "occurrence=" << occurrence;
+        EXPECT_FALSE(split.incomplete) << "occurrence=" << occurrence;
+        if (occurrence <= std::size(offsets))
+        {
+            EXPECT_EQ(split.match, page.bytes() + offsets[occurrence - 1]) << "occurrence=" << occurrence;
+        }
+    }
+
+    // The page class still gates the split: a read-write image holds no executable page.
+    EXPECT_EQ(detail::scan_module_pages_split(pattern, range, scan::Pages::Executable, 1, 4).match, nullptr);
+}
+
+// A whole-process scope is partitioned by allocation, not by address, and scheduled largest-first; the Nth match is
+// still the serial walk's, across a large private region cut into several chunks and a second small allocation.
+TEST(ScannerBatchTest, WholeProcessSplitScanMatchesSerial)
+{
+    constexpr std::size_t image_bytes = std::size_t{24} << 20;
+    constexpr std::size_t chunk = detail::SPLIT_SCAN_MIN_CHUNK_BYTES;
+    CommittedPage large(image_bytes, PAGE_READWRITE);
+    CommittedPage small(0x1000, PAGE_READWRITE);
+    ASSERT_NE(large.base, nullptr);
+    ASSERT_NE(small.base, nullptr);
+    std::memset(large.bytes(), 0xCC, large.size);
+    std::memset(small.bytes(), 0xCC, small.size);
+
+    const auto sig = make_unique_sig(7930);
+    const std::size_t offsets[] = {chunk - 8, 2 * chunk, 5 * chunk - 3};
+    for (const std::size_t offset : offsets)
+    {
+        std::memcpy(large.bytes() + offset, sig.data(), sig.size());
+    }
+    std::memcpy(small.bytes() + 64, sig.data(), sig.size());
+
+    // The sig's own heap buffer is a copy too, so only agreement with the serial walk is checked.
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const detail::ModuleSpan whole = detail::module_span(Region::whole_process());
+    ASSERT_GE(whole.end - whole.base, detail::SPARSE_SCAN_MIN_SPAN_BYTES);
+    for (std::size_t occurrence = 1; occurrence <= std::size(offsets) + 3; ++occurrence)
+    {
+        const detail::MatchResult serial = detail::scan_module_pages(pattern, whole, scan::Pages::Readable, occurrence);
+        const detail::MatchResult split =
+            detail::scan_module_pages_split(pattern, whole, scan::Pages::Readable, occurrence, 4);
+        EXPECT_EQ(split.match, serial.match) << "occurrence=" << occurrence;
+    }
+}
+
+// A RegionSet scope splits by the set's total bytes, never across a span: a copy straddling a span's end into the gap
+// and a copy inside a gap are not matches, and the rest count in address order exactly as the serial walk counts them.
+TEST(ScannerBatchTest, SetSplitScanMatchesSerialAcrossSpans)
+{
+    constexpr std::size_t image_bytes = std::size_t{24} << 20;
+    constexpr std::size_t mib = std::size_t{1} << 20;
+    CommittedPage page(image_bytes, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+
+    const auto sig = make_unique_sig(7950);
+    const std::size_t counted[] = {100, 7 * mib, 11 * mib - 5, 16 * mib, image_bytes - sig.size()};
+    const std::size_t excluded[] = {6 * mib - 3, 6 * mib + mib / 2};
+    for (const std::size_t offset : counted)
+    {
+        std::memcpy(page.bytes() + offset, sig.data(), sig.size());
+    }
+    for (const std::size_t offset : excluded)
+    {
+        std::memcpy(page.bytes() + offset, sig.data(), sig.size());
+    }
+
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const detail::ModuleSpan spans[] = {
+        detail::ModuleSpan{base, base + 6 * mib},
+        detail::ModuleSpan{base + 7 * mib, base + 15 * mib},
+        detail::ModuleSpan{base + 16 * mib, base + image_bytes},
+    };
+    for (std::size_t occurrence = 1; occurrence <= std::size(counted) + 1; ++occurrence)
+    {
+        const detail::MatchResult serial =
+            detail::scan_module_set_split(pattern, spans, scan::Pages::Readable, occurrence, 1);
+        const detail::MatchResult split =
+            detail::scan_module_set_split(pattern, spans, scan::Pages::Readable, occurrence, 4);
+        EXPECT_EQ(split.match, serial.match) << "occurrence=" << occurrence;
+        EXPECT_FALSE(split.incomplete) << "occurrence=" << occurrence;
+        const std::byte *expected =
+            (occurrence <= std::size(counted)) ? page.bytes() + counted[occurrence - 1] : nullptr;
+        EXPECT_EQ(split.match, expected) << "occurrence=" << occurrence;
+    }
+    EXPECT_TRUE(detail::spans_contain(spans, base + 7 * mib));
+    EXPECT_FALSE(detail::spans_contain(spans, base + 6 * mib));
+    EXPECT_FALSE(detail::spans_contain(spans, base + image_bytes));
+}
+
+TEST(ScannerBatchTest, PageSnapshotReplaysTheLiveGate)
+{
+    constexpr std::size_t page_bytes = 0x1000;
+    CommittedPage page(4 * page_bytes, PAGE_READWRITE);
+    ASSERT_NE(page.base, nullptr);
+    std::memset(page.bytes(), 0xCC, page.size);
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(page.bytes() + page_bytes, page_bytes, PAGE_NOACCESS, &old_protect));
+    ASSERT_TRUE(VirtualProtect(page.bytes() + 2 * page_bytes, page_bytes, PAGE_EXECUTE_READ, &old_protect));
+
+    const auto sig = make_unique_sig(7950);
+    std::memcpy(page.bytes() + 64, sig.data(), sig.size());
+    std::memcpy(page.bytes() + 3 * page_bytes + 64, sig.data(), sig.size());
+
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const auto base = reinterpret_cast<std::uintptr_t>(page.base);
+    const detail::ModuleSpan range{base, base + page.size};
+    const std::vector<detail::PageSnapshot> snapshots{detail::capture_page_snapshot(range)};
+    // The no-access page is excluded; the read-write, execute-read and read-write regions are recorded.
+    ASSERT_EQ(snapshots[0].regions.size(), 3u);
+
+    const detail::MatchResult live_first = detail::scan_module_pages(pattern, range, scan::Pages::Readable, 1);
+    const detail::MatchResult live_second = detail::scan_module_pages(pattern, range, scan::Pages::Readable, 2);
+    const std::size_t live_windows = detail::collect_page_windows(range, scan::Pages::Executable).size();
+    {
+        const detail::ScopedPageSnapshots install(snapshots);
+        EXPECT_EQ(detail::installed_page_snapshots().size(), 1u);
+        EXPECT_EQ(detail::scan_module_pages(pattern, range, scan::Pages::Readable, 1).match, live_first.match);
+        EXPECT_EQ(detail::scan_module_pages(pattern, range, scan::Pages::Readable, 2).match, live_second.match);
+        EXPECT_EQ(detail::scan_module_pages(pattern, range, scan::Pages::Executable, 1).match, nullptr);
+        EXPECT_EQ(detail::collect_page_windows(range, scan::Pages::Executable).size(), live_windows);
+
+        // A page decommitted after capture is still read through the fault guard: the replay skips it and reports
+        // the count incomplete rather than faulting or claiming the match is absent.
+        ASSERT_TRUE(VirtualProtect(page.bytes() + 3 * page_bytes, page_bytes, PAGE_NOACCESS, &old_protect));
+        const detail::MatchResult stale = detail::scan_module_pages(pattern, range, scan::Pages::Readable, 2);
+        EXPECT_EQ(stale.match, nullptr);
+        EXPECT_TRUE(stale.incomplete);
+    }
+    EXPECT_TRUE(detail::installed_page_snapshots().empty());
+    EXPECT_EQ(live_first.match, page.bytes() + 64);
+    EXPECT_EQ(live_second.match, page.bytes() + 3 * page_bytes + 64);
+}
+
+namespace
+{
+    // Initialized, so it lands in the test image's .data rather than in demand-zero memory of its own.
+    alignas(0x1000) std::uint8_t g_image_data[8 * 0x1000] = {1};
+
+    /// Number of VirtualQuery regions intersecting [lo, hi): what a live walk pays one query for.
+    [[nodiscard]] std::size_t live_region_count(std::uintptr_t lo, std::uintptr_t hi) noexcept
+    {
+        std::size_t regions = 0;
+        MEMORY_BASIC_INFORMATION mbi{};
+        for (std::uintptr_t addr = lo; addr < hi && VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi));
+             addr = reinterpret_cast<std::uintptr_t>(mbi.BaseAddress) + mbi.RegionSize)
+        {
+            ++regions;
+        }
+        return regions;
+    }
+} // namespace
+
+// Inside a loaded image the walk follows the section table: each executable window is one whole code section, and a
+// section split into many VirtualQuery regions of one protection class (here, alternate .data pages made read-only)
+// is still visited as one region -- with a match straddling the split found exactly as the live walk finds it.
+TEST(ScannerBatchTest, HostImageWalkFollowsTheSectionTable)
+{
+    const detail::ModuleSpan range = detail::module_span(Region::host());
+    ASSERT_TRUE(range.valid());
+    const auto *dos = reinterpret_cast<const IMAGE_DOS_HEADER *>(range.base);
+    const auto *nt =
+        reinterpret_cast<const IMAGE_NT_HEADERS64 *>(range.base + static_cast<std::uintptr_t>(dos->e_lfanew));
+    const IMAGE_SECTION_HEADER *sections = IMAGE_FIRST_SECTION(nt);
+    std::size_t code_sections = 0;
+    for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i)
+    {
+        code_sections += (sections[i].Characteristics & IMAGE_SCN_MEM_EXECUTE) != 0 ? 1 : 0;
+    }
+
+    const std::vector<detail::ExecutableWindow> code = detail::collect_page_windows(range, scan::Pages::Executable);
+    ASSERT_FALSE(code.empty());
+    EXPECT_LE(code.size(), code_sections);
+    const auto self = reinterpret_cast<std::uintptr_t>(&live_region_count);
+    bool self_covered = false;
+    for (const detail::ExecutableWindow &window : code)
+    {
+        self_covered = self_covered || (window.base <= self && self < window.base + window.span);
+    }
+    EXPECT_TRUE(self_covered);
+
+    const auto data = reinterpret_cast<std::uintptr_t>(g_image_data);
+    const std::size_t readable_before = detail::collect_page_windows(range, scan::Pages::Readable).size();
+    const std::size_t live_before = live_region_count(data, data + sizeof(g_image_data));
+
+    const auto sig = make_unique_sig(7975);
+    std::memcpy(g_image_data + 2 * 0x1000 - 8, sig.data(), sig.size());
+    DWORD old_protect = 0;
+    for (const std::size_t page : {1u, 3u, 5u})
+    {
+        ASSERT_TRUE(VirtualProtect(g_image_data + page * 0x1000, 0x1000, PAGE_READONLY, &old_protect));
+    }
+    EXPECT_GT(live_region_count(data, data + sizeof(g_image_data)), live_before);
+    EXPECT_EQ(detail::collect_page_windows(range, scan::Pages::Readable).size(), readable_before);
+
+    const auto pattern = detail::parse_aob(sig_to_aob(sig)).value();
+    const detail::MatchResult found = detail::scan_module_pages(pattern, range, scan::Pages::Readable, 1);
+    EXPECT_EQ(found.match, reinterpret_cast<const std::byte *>(g_image_data + 2 * 0x1000 - 8));
+    EXPECT_FALSE(found.incomplete);
+    EXPECT_EQ(detail::scan_module_pages(pattern, range, scan::Pages::Executable, 1).match, nullptr);
+
+    for (const std::size_t page : {1u, 3u, 5u})
+    {
+        ASSERT_TRUE(VirtualProtect(g_image_data + page * 0x1000, 0x1000, PAGE_READWRITE, &old_protect));
+    }
+}
+
 TEST(ScannerBatchTest, ResolveBatchEmptyReturnsEmpty)
 {
     const std::vector<scan::ScanRequest> requests;
@@ -501,6 +897,70 @@ TEST(ScannerBatchTest, ResolveBatchMatchesSerialResolve)
     EXPECT_EQ(results[4].error().code, ErrorCode::InvalidRange);
 }
 
+// A batch whose byte candidates reach MULTI_SCAN_MIN_PATTERNS is prescanned in one sweep. Its verdicts -- a unique hit,
+// an ambiguous twice-planted sig that must fail closed, a ladder that falls through to its second rung, and an absent
+// sig -- must equal the serial resolver's, request for request.
+TEST(ScannerBatchTest, ResolveBatchPrescannedLargeBatchMatchesSerialResolve)
+{
+    CommittedPage code_page(64 * 1024, PAGE_EXECUTE_READWRITE);
+    ASSERT_NE(code_page.base, nullptr);
+    std::memset(code_page.bytes(), 0xCC, code_page.size);
+    const Region range{Address{reinterpret_cast<std::uintptr_t>(code_page.base)}, code_page.size};
+
+    constexpr std::size_t UNIQUE_COUNT = 8;
+    std::vector<std::string> labels;
+    std::vector<scan::Candidate> candidates;
+    labels.reserve(UNIQUE_COUNT + 4);
+    candidates.reserve(UNIQUE_COUNT + 4);
+    for (std::size_t i = 0; i < UNIQUE_COUNT; ++i)
+    {
+        const auto sig = make_unique_sig(static_cast<std::uint32_t>(7900 + i));
+        std::memcpy(code_page.bytes() + 512 + i * 2048, sig.data(), sig.size());
+        labels.push_back("unique_" + std::to_string(i));
+        candidates.push_back(scan::Candidate::direct(labels.back(), aob(sig_to_aob(sig))));
+    }
+    const auto twice = make_unique_sig(7950);
+    std::memcpy(code_page.bytes() + 40000, twice.data(), twice.size());
+    std::memcpy(code_page.bytes() + 50000, twice.data(), twice.size());
+    labels.push_back("ambiguous");
+    candidates.push_back(scan::Candidate::direct(labels.back(), aob(sig_to_aob(twice))));
+    labels.push_back("absent");
+    candidates.push_back(scan::Candidate::direct(labels.back(), aob(sig_to_aob(make_unique_sig(7951)))));
+
+    std::vector<scan::ScanRequest> requests;
+    for (std::size_t i = 0; i < candidates.size(); ++i)
+    {
+        requests.push_back(scan::ScanRequest{
+            .ladder = std::span<const scan::Candidate>(&candidates[i], 1), .label = labels[i], .scope = range});
+    }
+    // Two-rung ladder: the ambiguous rung fails closed and the ladder falls through to a unique one.
+    const scan::Candidate fall_through[] = {candidates[UNIQUE_COUNT], candidates[0]};
+    requests.push_back(scan::ScanRequest{.ladder = fall_through, .label = "fall-through", .scope = range});
+
+    const auto batch = scan::resolve_batch(requests, 4);
+    ASSERT_TRUE(batch.has_value());
+    ASSERT_EQ(batch->size(), requests.size());
+    for (std::size_t i = 0; i < requests.size(); ++i)
+    {
+        const auto serial = scan::resolve(requests[i]);
+        ASSERT_EQ((*batch)[i].has_value(), serial.has_value()) << "request=" << i;
+        if (serial.has_value())
+        {
+            EXPECT_EQ((*batch)[i]->address, serial->address) << "request=" << i;
+            EXPECT_EQ((*batch)[i]->winning_name, serial->winning_name) << "request=" << i;
+        }
+        else
+        {
+            EXPECT_EQ((*batch)[i].error().code, serial.error().code) << "request=" << i;
+        }
+    }
+    EXPECT_EQ((*batch)[0]->address.raw(), reinterpret_cast<std::uintptr_t>(code_page.bytes() + 512));
+    EXPECT_FALSE((*batch)[UNIQUE_COUNT].has_value());
+    EXPECT_FALSE((*batch)[UNIQUE_COUNT + 1].has_value());
+    ASSERT_TRUE(batch->back().has_value());
+    EXPECT_EQ(batch->back()->winning_name, labels[0]);
+}
+
 TEST(ScannerBatchTest, ResolveBatchWorkerCountYieldsIdenticalResults)
 {
     CommittedPage code_page(64 * 1024, PAGE_EXECUTE_READWRITE);
@@ -552,11 +1012,124 @@ TEST(ScannerBatchTest, ResolveBatchWorkerCountYieldsIdenticalResults)
 }
 
 // A string-xref Candidate resolves identically through the fork-join batch path and the serial resolver, confirming
+// The span overload writes the same results into caller-owned slots, and rejects a span shorter than the batch
+// without touching it.
+TEST(ScannerBatchTest, ResolveBatchSpanOverloadMatchesVectorOverload)
+{
+    CommittedPage code_page(64 * 1024, PAGE_EXECUTE_READWRITE);
+    ASSERT_NE(code_page.base, nullptr);
+    std::memset(code_page.bytes(), 0xCC, code_page.size);
+
+    const auto sig_a = make_unique_sig(4101);
+    std::byte *target_a = code_page.bytes() + 1024;
+    std::memcpy(target_a, sig_a.data(), sig_a.size());
+
+    const scan::Candidate cands_a[] = {scan::Candidate::direct("span-a", aob(sig_to_aob(sig_a)))};
+    const Region range{Address{reinterpret_cast<std::uintptr_t>(code_page.base)}, code_page.size};
+    const std::vector<scan::ScanRequest> requests{
+        scan::ScanRequest{.ladder = cands_a, .label = "span-a", .scope = range},
+        scan::ScanRequest{.ladder = {}, .label = "span-empty"},
+    };
+
+    std::vector<Result<scan::Hit>> short_out(1, std::unexpected(Error{ErrorCode::Unknown, "test"}));
+    const Result<void> rejected = scan::resolve_batch(requests, short_out, 2);
+    ASSERT_FALSE(rejected.has_value());
+    EXPECT_EQ(rejected.error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(short_out[0].error().code, ErrorCode::Unknown);
+
+    std::vector<Result<scan::Hit>> out(requests.size());
+    const Result<void> filled = scan::resolve_batch(requests, out, 2);
+    ASSERT_TRUE(filled.has_value()) << filled.error().message();
+    const auto batch = scan::resolve_batch(requests, 2);
+    ASSERT_TRUE(batch.has_value());
+
+    ASSERT_TRUE(out[0].has_value());
+    EXPECT_EQ(out[0]->address.raw(), reinterpret_cast<std::uintptr_t>(target_a));
+    EXPECT_EQ(out[0]->address, (*batch)[0]->address);
+    ASSERT_FALSE(out[1].has_value());
+    EXPECT_EQ(out[1].error().code, (*batch)[1].error().code);
+}
+
+TEST(ScannerBatchTest, ResolveBatchStopTokenCancelsEveryRequest)
+{
+    CommittedPage code_page(64 * 1024, PAGE_EXECUTE_READWRITE);
+    ASSERT_NE(code_page.base, nullptr);
+    std::memset(code_page.bytes(), 0xCC, code_page.size);
+
+    const auto sig_a = make_unique_sig(4121);
+    std::memcpy(code_page.bytes() + 256, sig_a.data(), sig_a.size());
+    const scan::Candidate cands_a[] = {scan::Candidate::direct("stop-a", aob(sig_to_aob(sig_a)))};
+    const Region range{Address{reinterpret_cast<std::uintptr_t>(code_page.base)}, code_page.size};
+    const std::vector<scan::ScanRequest> requests(4, scan::ScanRequest{.ladder = cands_a, .label = "stop-a",
+                                                                       .scope = range});
+
+    std::stop_source stop;
+    const auto live = scan::resolve_batch(requests, scan::BatchOptions{.max_workers = 2, .stop = stop.get_token()});
+    ASSERT_TRUE(live.has_value());
+    for (const Result<scan::Hit> &hit : *live)
+    {
+        EXPECT_TRUE(hit.has_value());
+    }
+
+    // A token that already fired resolves nothing: every slot reports the cancellation, not a miss.
+    stop.request_stop();
+    std::vector<Result<scan::Hit>> out(requests.size());
+    const Result<void> cancelled =
+        scan::resolve_batch(requests, out, scan::BatchOptions{.max_workers = 2, .stop = stop.get_token()});
+    ASSERT_TRUE(cancelled.has_value());
+    for (std::size_t i = 0; i < out.size(); ++i)
+    {
+        ASSERT_FALSE(out[i].has_value()) << "request=" << i;
+        EXPECT_EQ(out[i].error().code, ErrorCode::Cancelled) << "request=" << i;
+    }
+}
+
 // resolve_batch uses the same variant dispatch as the serial path. StringXref is the representative tier:
 // find_string_xref is the non-noexcept backend, so the request is replicated into a batch larger than one worker to
 // exercise that throwing dispatch running on a spawned worker thread (not just the calling thread). Every copy aliases
 // the same immutable RWX fixture -- one literal plus one RIP-relative lea reference -- so each concurrent resolve must
 // agree with the serial result; disagreement would signal a data race in the shared read-only scan path.
+// A raced ladder overlaps its tiers but must settle on the tier the serial walk stops at: an absent rung and an
+// ambiguous one lose, and of two unique rungs the earlier-ordered one wins even though both resolve.
+TEST(ScannerBatchTest, RaceTiersPicksTheSerialWinner)
+{
+    CommittedPage code_page(64 * 1024, PAGE_EXECUTE_READWRITE);
+    ASSERT_NE(code_page.base, nullptr);
+    std::memset(code_page.bytes(), 0xCC, code_page.size);
+
+    const auto absent = make_unique_sig(4100);
+    const auto twice = make_unique_sig(4101);
+    const auto first = make_unique_sig(4102);
+    const auto second = make_unique_sig(4103);
+    std::memcpy(code_page.bytes() + 1024, twice.data(), twice.size());
+    std::memcpy(code_page.bytes() + 8192, twice.data(), twice.size());
+    std::memcpy(code_page.bytes() + 16384, first.data(), first.size());
+    std::memcpy(code_page.bytes() + 512, second.data(), second.size());
+
+    const scan::Candidate ladder[] = {scan::Candidate::direct("absent", aob(sig_to_aob(absent))),
+                                      scan::Candidate::direct("twice", aob(sig_to_aob(twice))),
+                                      scan::Candidate::direct("first", aob(sig_to_aob(first))),
+                                      scan::Candidate::direct("second", aob(sig_to_aob(second)))};
+    const Region range{Address{reinterpret_cast<std::uintptr_t>(code_page.base)}, code_page.size};
+
+    const auto serial = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = range});
+    const auto raced = scan::resolve(scan::ScanRequest{.ladder = ladder, .scope = range, .race_tiers = true});
+    ASSERT_TRUE(serial.has_value());
+    ASSERT_TRUE(raced.has_value());
+    EXPECT_EQ(raced->winning_name, "first");
+    EXPECT_EQ(raced->address, serial->address);
+    EXPECT_EQ(raced->address.raw(), reinterpret_cast<std::uintptr_t>(code_page.bytes() + 16384));
+
+    // Every tier missing is the same miss either way.
+    const scan::Candidate misses[] = {scan::Candidate::direct("absent", aob(sig_to_aob(absent))),
+                                      scan::Candidate::direct("twice", aob(sig_to_aob(twice)))};
+    const auto serial_miss = scan::resolve(scan::ScanRequest{.ladder = misses, .scope = range});
+    const auto raced_miss = scan::resolve(scan::ScanRequest{.ladder = misses, .scope = range, .race_tiers = true});
+    ASSERT_FALSE(serial_miss.has_value());
+    ASSERT_FALSE(raced_miss.has_value());
+    EXPECT_EQ(raced_miss.error().code, serial_miss.error().code);
+}
+
 TEST(ScannerBatchTest, ResolveBatchResolvesStringXrefTierLikeSerial)
 {
     // No memory::init_cache() by design: find_string_xref installs its fault guard lazily (MinGW) or uses SEH (MSVC),
@@ -728,3 +1301,295 @@ TEST(ForkJoinTest, PerItemThrowKeepsFailClosedSeedAndIsolatesNeighbours)
     EXPECT_EQ(results[3], 30);
     EXPECT_EQ(results[4], 40);
 }
+
+TEST(ForkJoinTest, WorkerFlagIsSetOnlyWhileABatchItemRuns)
+{
+    // A nested fan-out primitive (the split module scan) reads this flag to stay serial inside a parallel batch, so it
+    // must be set on every worker -- the calling thread included -- and cleared again once the batch returns.
+    EXPECT_FALSE(detail::in_fork_join_worker());
+    const std::array<int, 8> items{0, 1, 2, 3, 4, 5, 6, 7};
+    const auto results = detail::run_fork_join<int, int>(
+        std::span<const int>(items), 4, [](const int &) -> int { return detail::in_fork_join_worker() ? 1 : 0; },
+        [](const int &) noexcept -> int { return -1; });
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        EXPECT_EQ(results[i], 1) << "item=" << i;
+    }
+    EXPECT_FALSE(detail::in_fork_join_worker());
+}
+
+TEST(ForkJoinTest, PoolThreadsAreReusedAcrossBatches)
+{
+    std::vector<int> items(64);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        items[i] = static_cast<int>(i);
+    }
+    const auto square = [](const int &value) -> int { return value * value; };
+    const auto fail = [](const int &) noexcept -> int { return -1; };
+
+    const auto first = detail::run_fork_join<int, int>(std::span<const int>(items), 4, square, fail);
+    ASSERT_GT(detail::fork_join_pool_size(), 0u);
+    const std::uint64_t started = detail::fork_join_pool_threads_started();
+
+    const auto second = detail::run_fork_join<int, int>(std::span<const int>(items), 4, square, fail);
+    // The second batch woke the pool's threads instead of creating its own.
+    EXPECT_EQ(detail::fork_join_pool_threads_started(), started);
+    ASSERT_EQ(first.size(), items.size());
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ(first[i], items[i] * items[i]) << "item=" << i;
+        EXPECT_EQ(second[i], first[i]) << "item=" << i;
+    }
+}
+
+TEST(ForkJoinTest, ShutdownStopsThePoolAndTheNextBatchRestartsIt)
+{
+    const std::array<int, 16> items{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    (void)detail::run_fork_join<int, int>(
+        std::span<const int>(items), 4, [](const int &value) -> int { return value; },
+        [](const int &) noexcept -> int { return -1; });
+    detail::shutdown_fork_join_pool();
+    EXPECT_EQ(detail::fork_join_pool_size(), 0u);
+    // Idempotent.
+    detail::shutdown_fork_join_pool();
+
+    const auto results = detail::run_fork_join<int, int>(
+        std::span<const int>(items), 4, [](const int &value) -> int { return value + 1; },
+        [](const int &) noexcept -> int { return -1; });
+    EXPECT_GT(detail::fork_join_pool_size(), 0u);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ(results[i], items[i] + 1) << "item=" << i;
+    }
+}
+
+TEST(ForkJoinTest, BatchIssuedFromInsideABatchItemCompletes)
+{
+    // Every pool worker can be busy in the outer batch when an item starts an inner one. The inner batch must not wait
+    // for a worker to free up: its caller runs whatever no worker takes.
+    std::array<int, 12> outer{};
+    for (std::size_t i = 0; i < outer.size(); ++i)
+    {
+        outer[i] = static_cast<int>(i);
+    }
+    const auto results = detail::run_fork_join<int, int>(
+        std::span<const int>(outer), 0,
+        [](const int &base) -> int
+        {
+            std::array<int, 32> inner{};
+            for (std::size_t i = 0; i < inner.size(); ++i)
+            {
+                inner[i] = base + static_cast<int>(i);
+            }
+            const auto doubled = detail::run_fork_join<int, int>(
+                std::span<const int>(inner), 0, [](const int &value) -> int { return value * 2; },
+                [](const int &) noexcept -> int { return 0; });
+            int sum = 0;
+            for (const int value : doubled)
+            {
+                sum += value;
+            }
+            return sum;
+        },
+        [](const int &) noexcept -> int { return -1; });
+
+    for (std::size_t i = 0; i < outer.size(); ++i)
+    {
+        // 2 * sum(base .. base + 31).
+        EXPECT_EQ(results[i], 2 * (32 * outer[i] + 496)) << "item=" << i;
+    }
+}
+
+TEST(ForkJoinTest, PlanRunsCostliestFirstAndGroupsCheapItems)
+{
+    // Two big items and eight cheap ones for two workers: a task is worth 1/16th of the total (1'008), so each big item
+    // stands alone and the cheap ones fold into one another until a group reaches that share.
+    const std::array<std::uint64_t, 10> costs{1, 500, 1, 1, 1, 1, 500, 1, 1, 1};
+    const detail::ForkJoinPlan plan = detail::plan_fork_join(costs, 2);
+
+    ASSERT_EQ(plan.order.size(), costs.size());
+    EXPECT_EQ(plan.order[0], 1u);
+    EXPECT_EQ(plan.order[1], 6u);
+    // Equal costs keep their input order.
+    EXPECT_EQ(plan.order[2], 0u);
+    EXPECT_EQ(plan.order[3], 2u);
+
+    ASSERT_EQ(plan.task_cost.size(), 3u);
+    ASSERT_EQ(plan.task_begin.size(), 4u);
+    EXPECT_EQ(plan.task_cost[0], 500u);
+    EXPECT_EQ(plan.task_cost[1], 500u);
+    EXPECT_EQ(plan.task_cost[2], 8u);
+    EXPECT_EQ(plan.task_begin[2], 2u);
+    EXPECT_EQ(plan.task_begin[3], costs.size());
+}
+
+TEST(ForkJoinTest, CostHintReordersWorkButNotResults)
+{
+    std::vector<int> items(40);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        items[i] = static_cast<int>(i);
+    }
+    const auto results = detail::run_fork_join<int, int>(
+        std::span<const int>(items), 4, [](const int &value) -> int { return value * 3; },
+        [](const int &) noexcept -> int { return -1; },
+        [](const int &value) noexcept -> std::uint64_t { return (value % 7 == 0) ? 1'000u : 1u; });
+
+    ASSERT_EQ(results.size(), items.size());
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        EXPECT_EQ(results[i], items[i] * 3) << "item=" << i;
+    }
+}
+
+TEST(ForkJoinTest, GraphRunsEachChildAfterItsParentAndSkipsUnreachableNodes)
+{
+    // Two chains (0 <- 2 <- 4 and 1 <- 3), an out-of-range parent (5) and a two-node cycle (6 <-> 7). Each item adds
+    // one to its parent's result, so a chain's depth shows up in the value and a child that ran early would read the
+    // seed.
+    const std::array<int, 8> items{0, 1, 2, 3, 4, 5, 6, 7};
+    const std::array<std::size_t, 8> parents{detail::FORK_JOIN_NO_PARENT,
+                                             detail::FORK_JOIN_NO_PARENT,
+                                             0,
+                                             1,
+                                             2,
+                                             99,
+                                             7,
+                                             6};
+    for (const std::size_t workers : {std::size_t{1}, std::size_t{4}})
+    {
+        const auto results = detail::run_fork_join_graph<int, int>(
+            std::span<const int>(items), parents, workers,
+            [](const int &, const int *parent) -> int { return parent == nullptr ? 1 : *parent + 1; },
+            [](const int &) noexcept -> int { return -1; });
+        ASSERT_EQ(results.size(), items.size());
+        EXPECT_EQ(results[0], 1) << "workers=" << workers;
+        EXPECT_EQ(results[1], 1) << "workers=" << workers;
+        EXPECT_EQ(results[2], 2) << "workers=" << workers;
+        EXPECT_EQ(results[3], 2) << "workers=" << workers;
+        EXPECT_EQ(results[4], 3) << "workers=" << workers;
+        EXPECT_EQ(results[5], -1) << "workers=" << workers;
+        EXPECT_EQ(results[6], -1) << "workers=" << workers;
+        EXPECT_EQ(results[7], -1) << "workers=" << workers;
+    }
+}
+
+TEST(ForkJoinTest, CancelSkipsTheItemsNotYetStartedAndReachesNestedBatches)
+{
+    // A skipped item keeps its fail_one seed, which sees the batch cancelled and so can tell a skip from a plain miss.
+    const std::array<int, 6> items{0, 1, 2, 3, 4, 5};
+    const auto fail = [](const int &) noexcept -> int { return detail::batch_cancelled() ? -2 : -1; };
+
+    std::stop_source stopped;
+    stopped.request_stop();
+    {
+        const detail::BatchCancel cancel(stopped.get_token());
+        const detail::ScopedBatchCancel install(&cancel);
+        const auto results = detail::run_fork_join<int, int>(
+            std::span<const int>(items), 4, [](const int &value) -> int { return value; }, fail);
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            EXPECT_EQ(results[i], -2) << "item=" << i;
+        }
+    }
+    EXPECT_FALSE(detail::batch_cancelled());
+
+    // Fail-fast: item 2 trips the batch on one worker, so it keeps its own answer and everything after it is skipped.
+    {
+        detail::BatchCancel cancel;
+        const detail::ScopedBatchCancel install(&cancel);
+        const auto results = detail::run_fork_join<int, int>(
+            std::span<const int>(items), 1,
+            [&cancel](const int &value) -> int
+            {
+                if (value == 2)
+                {
+                    cancel.cancel();
+                }
+                return value;
+            },
+            fail);
+        EXPECT_EQ(results[0], 0);
+        EXPECT_EQ(results[1], 1);
+        EXPECT_EQ(results[2], 2);
+        for (std::size_t i = 3; i < items.size(); ++i)
+        {
+            EXPECT_EQ(results[i], -2) << "item=" << i;
+        }
+    }
+
+    // A batch issued from an item links to the outer one, even on a pool worker.
+    {
+        std::stop_source outer_stop;
+        const detail::BatchCancel cancel(outer_stop.get_token());
+        const detail::ScopedBatchCancel install(&cancel);
+        const auto results = detail::run_fork_join<int, int>(
+            std::span<const int>(items), 4,
+            [&outer_stop](const int &) -> int
+            {
+                outer_stop.request_stop();
+                const detail::BatchCancel inner;
+                return inner.cancelled() ? 1 : 0;
+            },
+            [](const int &) noexcept -> int { return 1; });
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            EXPECT_EQ(results[i], 1) << "item=" << i;
+        }
+    }
+}
+
+TEST(ForkJoinTest, WorkerPlacementClampsTheFractionAndKeepsItOnNaN)
+{
+    scan::set_worker_placement(scan::WorkerPlacement{true, 2.0});
+    EXPECT_TRUE(scan::worker_placement().background);
+    EXPECT_DOUBLE_EQ(scan::worker_placement().foreground_core_fraction, 1.0);
+
+    scan::set_worker_placement(scan::WorkerPlacement{false, std::numeric_limits<double>::quiet_NaN()});
+    EXPECT_FALSE(scan::worker_placement().background);
+    EXPECT_DOUBLE_EQ(scan::worker_placement().foreground_core_fraction, 1.0);
+
+    scan::set_worker_placement(scan::WorkerPlacement{false, -1.0});
+    EXPECT_DOUBLE_EQ(scan::worker_placement().foreground_core_fraction, 0.0);
+
+    scan::set_worker_placement(scan::WorkerPlacement{});
+    EXPECT_DOUBLE_EQ(scan::worker_placement().foreground_core_fraction, 0.5);
+}
+
+TEST(ForkJoinTest, BackgroundPlacementLowersPoolWorkersButNotTheCaller)
+{
+    std::vector<int> items(256);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        items[i] = static_cast<int>(i);
+    }
+    const DWORD caller = GetCurrentThreadId();
+    const int caller_priority = GetThreadPriority(GetCurrentThread());
+
+    // Each item reports the priority of the thread that ran it, tagged with whether that was the caller.
+    const auto run_batch = [&items, caller]()
+    {
+        return detail::run_fork_join<int, std::pair<bool, int>>(
+            std::span<const int>(items), 4,
+            [caller](const int &) -> std::pair<bool, int>
+            {
+                // A little work per item, so the pool's worker gets a share before the caller drains the batch.
+                Sleep(0);
+                return {GetCurrentThreadId() == caller, GetThreadPriority(GetCurrentThread())};
+            },
+            [](const int &) noexcept -> std::pair<bool, int> { return {true, THREAD_PRIORITY_ERROR_RETURN}; });
+    };
+
+    scan::set_worker_placement(scan::WorkerPlacement{true, 1.0});
+    for (const auto &[on_caller, priority] : run_batch())
+    {
+        EXPECT_EQ(priority, on_caller ? caller_priority : THREAD_PRIORITY_BELOW_NORMAL);
+    }
+
+    scan::set_worker_placement(scan::WorkerPlacement{});
+    for (const auto &[on_caller, priority] : run_batch())
+    {
+        EXPECT_EQ(priority, on_caller ? caller_priority : THREAD_PRIORITY_NORMAL);
+    }
+}
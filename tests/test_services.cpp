@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include "DetourModKit/diagnostics.hpp"
+#include "DetourModKit/services.hpp"
+#include "internal/background_service.hpp"
+#include "internal/shared_services.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+using namespace DetourModKit;
+
+namespace
+{
+    using namespace std::chrono_literals;
+
+    template <typename Done>
+    [[nodiscard]] bool eventually(Done done, std::chrono::milliseconds limit = 5000ms)
+    {
+        const auto deadline = std::chrono::steady_clock::now() + limit;
+        while (!done())
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return true;
+    }
+
+    void count_run(void *context) noexcept
+    {
+        static_cast<std::atomic<int> *>(context)->fetch_add(1);
+    }
+} // namespace
+
+TEST(ServicesTest, TheOnlyInstanceHostsAndLeavesStandalone)
+{
+    const auto role = services::enable();
+    ASSERT_TRUE(role.has_value()) << role.error().message();
+    EXPECT_EQ(*role, services::Role::Host);
+    EXPECT_TRUE(detail::shared_services_joined());
+
+    // Joining twice keeps the role taken.
+    EXPECT_EQ(services::enable().value(), services::Role::Host);
+    services::Status status = services::status();
+    EXPECT_EQ(status.role, services::Role::Host);
+    EXPECT_EQ(status.instances, 1u);
+    EXPECT_EQ(status.host_abi_major, services::ABI_MAJOR);
+
+    services::disable();
+    status = services::status();
+    EXPECT_EQ(status.role, services::Role::Standalone);
+    EXPECT_EQ(status.instances, 0u);
+    EXPECT_FALSE(detail::shared_services_joined());
+    // Leaving twice is harmless.
+    services::disable();
+}
+
+TEST(ServicesTest, AHostNeverLeasesItsOwnScheduler)
+{
+    ASSERT_TRUE(services::enable().has_value());
+    EXPECT_FALSE(detail::lease_host_scheduler());
+    services::disable();
+}
+
+TEST(ServicesTest, SharedRegionsAreServedUntilInvalidated)
+{
+    detail::SharedRegion region;
+    region.base = 0x7FF6'1234'0000;
+    region.size = 0x2000;
+    region.protection = 0x20; // PAGE_EXECUTE_READ
+    region.state = 0x1000;    // MEM_COMMIT
+    region.type = 0x1000000;  // MEM_IMAGE
+
+    // Not joined: nothing is published or served.
+    detail::shared_region_publish(region.base + 0x10, region, detail::shared_region_epoch());
+    EXPECT_FALSE(detail::shared_region_lookup(region.base + 0x10).has_value());
+
+    ASSERT_TRUE(services::enable().has_value());
+    const std::uint64_t hits_before = services::status().shared_region_hits;
+    detail::shared_region_publish(region.base + 0x10, region, detail::shared_region_epoch());
+    const auto found = detail::shared_region_lookup(region.base + 0x1F00);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->base, region.base);
+    EXPECT_EQ(found->size, region.size);
+    EXPECT_EQ(found->protection, region.protection);
+    EXPECT_EQ(found->state, region.state);
+    EXPECT_EQ(found->type, region.type);
+    EXPECT_EQ(services::status().shared_region_hits, hits_before + 1);
+
+    // Outside the published bounds is a miss even in the same granule.
+    EXPECT_FALSE(detail::shared_region_lookup(region.base + 0x2000).has_value());
+
+    // A region queried before an invalidation is never served after it.
+    const std::uint64_t stale_epoch = detail::shared_region_epoch();
+    detail::shared_region_invalidate();
+    EXPECT_FALSE(detail::shared_region_lookup(region.base + 0x10).has_value());
+    detail::shared_region_publish(region.base + 0x10, region, stale_epoch);
+    EXPECT_FALSE(detail::shared_region_lookup(region.base + 0x10).has_value());
+    detail::shared_region_publish(region.base + 0x10, region, detail::shared_region_epoch());
+    EXPECT_TRUE(detail::shared_region_lookup(region.base + 0x10).has_value());
+
+    detail::shared_region_invalidate();
+    services::disable();
+}
+
+TEST(ServicesTest, TheKeySweepOwnerNeverReadsItsOwnSweep)
+{
+    EXPECT_FALSE(detail::claim_key_sweep().has_value());
+
+    ASSERT_TRUE(services::enable().has_value());
+    const auto others = detail::claim_key_sweep();
+    ASSERT_TRUE(others.has_value());
+    EXPECT_TRUE(others->empty());
+    // Claiming again as the owner still answers.
+    EXPECT_TRUE(detail::claim_key_sweep().has_value());
+
+    detail::KeyMask down;
+    detail::KeyMask covered;
+    down.set(0x41);
+    covered.set(0x41);
+    detail::publish_key_sweep(down, covered);
+    detail::KeyMask read_down;
+    detail::KeyMask read_covered;
+    EXPECT_FALSE(detail::read_key_sweep(1000ms, read_down, read_covered));
+
+    detail::release_key_sweep();
+    services::disable();
+    EXPECT_FALSE(detail::claim_key_sweep().has_value());
+}
+
+TEST(ServicesTest, LeavingAsHostCancelsTheTasksItRuns)
+{
+    ASSERT_TRUE(services::enable().has_value());
+    std::atomic<int> runs{0};
+    const auto id = detail::host_background_task("foreign", 2ms, nullptr, count_run, &runs);
+    ASSERT_TRUE(id.has_value());
+    EXPECT_EQ(detail::hosted_background_task_count(), 1u);
+    EXPECT_EQ(services::status().hosted_tasks, 1u);
+    EXPECT_TRUE(eventually([&runs]() { return runs.load() >= 2; }));
+
+    services::disable();
+    EXPECT_EQ(detail::hosted_background_task_count(), 0u);
+    const int after_leave = runs.load();
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(runs.load(), after_leave);
+}
+
+// A lease still out when the host leaves bounds the drain: the host stays registered with its table withdrawn, keeps
+// its hosted tasks, and records the leak; once the lease is returned a later disable() leaves in full.
+TEST(ServicesTest, ALeaseHeldAcrossDisableKeepsTheHostRegistered)
+{
+    ASSERT_TRUE(services::enable().has_value());
+    std::atomic<int> runs{0};
+    const auto id = detail::host_background_task("leased", 2ms, nullptr, count_run, &runs);
+    ASSERT_TRUE(id.has_value());
+    const std::size_t leaks_before = diagnostics::intentional_leak_count(diagnostics::LeakSubsystem::Worker);
+
+    detail::stage_host_lease_for_test(true);
+    const auto started = std::chrono::steady_clock::now();
+    services::disable();
+    EXPECT_LT(std::chrono::steady_clock::now() - started, 5s);
+    services::Status status = services::status();
+    EXPECT_EQ(status.role, services::Role::Host);
+    EXPECT_EQ(status.instances, 1u);
+    EXPECT_TRUE(detail::shared_services_joined());
+    EXPECT_EQ(detail::hosted_background_task_count(), 1u);
+    EXPECT_EQ(diagnostics::intentional_leak_count(diagnostics::LeakSubsystem::Worker), leaks_before + 1);
+
+    detail::stage_host_lease_for_test(false);
+    services::disable();
+    status = services::status();
+    EXPECT_EQ(status.role, services::Role::Standalone);
+    EXPECT_EQ(status.instances, 0u);
+    EXPECT_EQ(detail::hosted_background_task_count(), 0u);
+    // The module stays pinned from the first timeout; leaving later records nothing more.
+    EXPECT_EQ(diagnostics::intentional_leak_count(diagnostics::LeakSubsystem::Worker), leaks_before + 1);
+}
+
+TEST(ServicesTest, HostedTasksRejectAMissingBody)
+{
+    EXPECT_EQ(detail::host_background_task("empty", 2ms, nullptr, nullptr, nullptr).error().code,
+              ErrorCode::InvalidArg);
+    EXPECT_EQ(detail::host_background_task("zero", 0ms, nullptr, count_run, nullptr).error().code,
+              ErrorCode::InvalidArg);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -9,6 +10,7 @@
 #include <fstream>
 #include <memory>
 #include <mutex>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -1235,3 +1237,231 @@ TEST(SessionShutdownEventRace, RequestShutdownRacingOffLoaderLockDetachLeaksNotC
     EXPECT_EQ(bootstrap_shutdown_event_for_test(), nullptr) << "detach must retire the event pointer to null";
     EXPECT_EQ(module_handle(), nullptr) << "off-loader-lock detach must clear the module handle";
 }
+
+// Two independent stages each wait for the other to have started, so they finish only if the pipeline overlaps them;
+// the stage depending on both starts after the later of the two.
+TEST(SessionStartupPipeline, IndependentStagesOverlapAndDependentsWait)
+{
+    if (std::thread::hardware_concurrency() < 2)
+    {
+        GTEST_SKIP() << "needs a second hardware thread to overlap stages";
+    }
+    std::atomic<int> started{0};
+    std::atomic<bool> overlapped{true};
+    const auto meet = [&started, &overlapped]() -> Result<void>
+    {
+        started.fetch_add(1);
+        const auto deadline = std::chrono::steady_clock::now() + kTestTimeout;
+        while (started.load() < 2)
+        {
+            if (std::chrono::steady_clock::now() >= deadline)
+            {
+                overlapped.store(false);
+                break;
+            }
+            std::this_thread::sleep_for(1ms);
+        }
+        return {};
+    };
+    std::atomic<int> started_when_joined{0};
+    const std::vector<StartupStage> stages = {
+        {.name = "config", .run = meet},
+        {.name = "prewarm", .run = meet},
+        {.name = "hooks",
+         .after = {"config", "prewarm"},
+         .run = [&started, &started_when_joined]() -> Result<void>
+         {
+             started_when_joined.store(started.load());
+             return {};
+         }},
+    };
+
+    auto report = run_startup_pipeline(stages, 2);
+    ASSERT_TRUE(report.has_value());
+    EXPECT_TRUE(report->ok());
+    EXPECT_TRUE(overlapped.load()) << "independent stages must run concurrently";
+    EXPECT_EQ(started_when_joined.load(), 2);
+    ASSERT_EQ(report->stages.size(), 3u);
+    EXPECT_EQ(report->stages[2].name, "hooks");
+    EXPECT_GE(report->stages[2].started_at, report->stages[0].started_at + report->stages[0].elapsed);
+    EXPECT_GE(report->stages[2].started_at, report->stages[1].started_at + report->stages[1].elapsed);
+    EXPECT_LE(report->total, report->serial) << "the overlap must show as wall time below the summed stage time";
+}
+
+TEST(SessionStartupPipeline, FailureSkipsOnlyItsDependents)
+{
+    std::atomic<int> ran{0};
+    const auto count = [&ran]() -> Result<void>
+    {
+        ran.fetch_add(1);
+        return {};
+    };
+    const std::vector<StartupStage> stages = {
+        {.name = "manifest", .run = []() -> Result<void> { throw std::runtime_error("unreadable"); }},
+        {.name = "config", .run = count},
+        {.name = "types", .after = {"manifest"}, .run = count},
+        {.name = "hooks", .after = {"types", "config"}, .run = count},
+        {.name = "input", .after = {"config"}, .run = count},
+    };
+
+    auto report = run_startup_pipeline(stages);
+    ASSERT_TRUE(report.has_value());
+    EXPECT_FALSE(report->ok());
+    EXPECT_EQ(ran.load(), 2) << "config and input run; types and hooks sit behind the failed manifest";
+    EXPECT_EQ(report->stages[0].status, StartupStageStatus::Failed);
+    ASSERT_TRUE(report->stages[0].error.has_value());
+    EXPECT_EQ(report->stages[0].error->code, ErrorCode::Unknown);
+    EXPECT_EQ(report->stages[1].status, StartupStageStatus::Succeeded);
+    EXPECT_EQ(report->stages[2].status, StartupStageStatus::Skipped);
+    EXPECT_EQ(report->stages[3].status, StartupStageStatus::Skipped);
+    EXPECT_EQ(report->stages[4].status, StartupStageStatus::Succeeded);
+    EXPECT_EQ(report->stages[3].elapsed.count(), 0);
+    log_startup_report(*report);
+}
+
+TEST(SessionStartupPipeline, RejectsMalformedGraphsBeforeRunningAnything)
+{
+    std::atomic<int> ran{0};
+    const auto count = [&ran]() -> Result<void>
+    {
+        ran.fetch_add(1);
+        return {};
+    };
+    const auto rejected_at = [](const std::vector<StartupStage> &stages) -> std::uintptr_t
+    {
+        auto report = run_startup_pipeline(stages);
+        EXPECT_FALSE(report.has_value());
+        if (report.has_value())
+        {
+            return static_cast<std::uintptr_t>(-1);
+        }
+        EXPECT_EQ(report.error().code, ErrorCode::InvalidArg);
+        return report.error().detail;
+    };
+
+    EXPECT_EQ(rejected_at({{.name = "a", .run = count}, {.name = "a", .run = count}}), 1u);
+    EXPECT_EQ(rejected_at({{.name = "a", .after = {"missing"}, .run = count}}), 0u);
+    EXPECT_EQ(rejected_at({{.name = "a", .after = {"a"}, .run = count}}), 0u);
+    EXPECT_EQ(rejected_at({{.name = "a", .run = {}}}), 0u);
+    EXPECT_EQ(rejected_at({{.name = "root", .run = count},
+                           {.name = "a", .after = {"root", "b"}, .run = count},
+                           {.name = "b", .after = {"a"}, .run = count}}),
+              1u);
+    EXPECT_EQ(ran.load(), 0);
+
+    auto empty = run_startup_pipeline({});
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->stages.empty());
+    EXPECT_TRUE(empty->ok());
+}
+
+TEST(SessionLifecycleTimings, StartTeardownAndUnloadPhasesReachTheDiagnosticsSnapshot)
+{
+    const auto names = [](const std::vector<diagnostics::PhaseTiming> &phases)
+    {
+        std::vector<std::string> out;
+        for (const diagnostics::PhaseTiming &phase : phases)
+        {
+            out.push_back(phase.name);
+        }
+        return out;
+    };
+
+    {
+        auto session = start_local_session("LifecycleTimings", "test_lifecycle_timings.log");
+        ASSERT_TRUE(session.has_value());
+        const diagnostics::LifecycleTimings started = diagnostics::collect().lifecycle;
+        EXPECT_EQ(names(started.start), (std::vector<std::string>{"process_gate", "instance_mutex", "logger_start"}));
+
+        const std::vector<StartupStage> stages = {
+            {.name = "config", .run = []() -> Result<void> { return {}; }},
+            {.name = "hooks", .after = {"config"}, .run = []() -> Result<void> { return {}; }},
+        };
+        ASSERT_TRUE(run_startup_pipeline(stages).has_value());
+        EXPECT_EQ(names(diagnostics::collect().lifecycle.startup_stages),
+                  (std::vector<std::string>{"config", "hooks"}));
+
+        on_logic_dll_unload_all();
+        const std::vector<std::string> unload = names(diagnostics::collect().lifecycle.unload);
+        EXPECT_EQ(unload,
+                  (std::vector<std::string>{"bindings", "config_watcher", "config_registry", "reload_quiesce"}));
+    }
+
+    const diagnostics::LifecycleTimings ended = diagnostics::collect().lifecycle;
+    const std::vector<std::string> teardown = names(ended.teardown);
+    ASSERT_FALSE(teardown.empty());
+    EXPECT_EQ(teardown.front(), "scope_clear");
+    EXPECT_EQ(teardown.back(), "logger") << "the logger shuts down last";
+    EXPECT_EQ(ended.shutdown_latency.count(), 0) << "a directly held Session ends without a shutdown request";
+}
+
+// A session that never touches input, the memory cache, auto-reload or the pool tears down only what it always owns:
+// its scope, the config registry and the logger. Whatever it does start is shut down as before.
+TEST(SessionLifecycleTimings, TeardownSkipsSubsystemsThatNeverStarted)
+{
+    const auto teardown_names = []()
+    {
+        std::vector<std::string> out;
+        for (const diagnostics::PhaseTiming &phase : diagnostics::collect().lifecycle.teardown)
+        {
+            out.push_back(phase.name);
+        }
+        return out;
+    };
+
+    // A first session clears whatever earlier tests left started.
+    {
+        auto session = start_local_session("LazyTeardownReset", "test_lazy_teardown.log");
+        ASSERT_TRUE(session.has_value());
+    }
+
+    {
+        auto session = start_local_session("LazyTeardownIdle", "test_lazy_teardown.log");
+        ASSERT_TRUE(session.has_value());
+    }
+    EXPECT_EQ(teardown_names(), (std::vector<std::string>{"scope_clear", "config_registry", "logger"}));
+
+    {
+        auto session = start_local_session("LazyTeardownCache", "test_lazy_teardown.log");
+        ASSERT_TRUE(session.has_value());
+        ASSERT_TRUE(memory::init_cache());
+    }
+    const std::vector<std::string> names = teardown_names();
+    EXPECT_NE(std::ranges::find(names, "memory_cache"), names.end()) << "a started cache must still be shut down";
+    EXPECT_EQ(names.back(), "logger");
+}
+
+namespace DetourModKit::detail
+{
+    extern bool (*g_process_terminating_override)() noexcept;
+} // namespace DetourModKit::detail
+
+namespace
+{
+    bool always_terminating() noexcept
+    {
+        return true;
+    }
+} // namespace
+
+// On the process-exit pass ~Session stops nothing: every started subsystem is left running and counted as an
+// intentional leak, and the destructor returns without the drains and joins of the ordered teardown.
+TEST(SessionProcessExit, DestructorDuringProcessExitLeaksStartedSubsystemsInsteadOfStoppingThem)
+{
+    const std::size_t cache_leaks = diagnostics::intentional_leak_count(diagnostics::LeakSubsystem::MemoryCache);
+    {
+        auto session = start_local_session("ProcessExit", "test_process_exit.log");
+        ASSERT_TRUE(session.has_value());
+        ASSERT_TRUE(memory::init_cache());
+        log().info("last line before exit");
+        DetourModKit::detail::g_process_terminating_override = &always_terminating;
+    }
+    DetourModKit::detail::g_process_terminating_override = nullptr;
+
+    EXPECT_EQ(diagnostics::intentional_leak_count(diagnostics::LeakSubsystem::MemoryCache), cache_leaks + 1);
+
+    // The session is gone, so a new one may start; the cache it left behind is shut down by hand.
+    memory::shutdown_cache();
+    auto next = start_local_session("ProcessExitNext", "test_process_exit.log");
+    EXPECT_TRUE(next.has_value());
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <cstddef>
 #include <initializer_list>
 #include <optional>
 #include <string>
@@ -502,7 +503,8 @@ TEST(SigHealthFormat, StringifiersNeverEmptyForNamedValues)
           sh::FindingKind::ShortestAnchorRun, sh::FindingKind::CommonBytesOnly, sh::FindingKind::HighWildcardRatio,
           sh::FindingKind::LowByteEntropy, sh::FindingKind::WeakSelectivity, sh::FindingKind::EmptyAnchorText,
           sh::FindingKind::ShortAnchorText, sh::FindingKind::UnhealableManual, sh::FindingKind::NonSerializableKind,
-          sh::FindingKind::NoRobustRung, sh::FindingKind::UncompilableRecord})
+          sh::FindingKind::NoRobustRung, sh::FindingKind::UncompilableRecord, sh::FindingKind::ExpensiveScan,
+          sh::FindingKind::BacktrackingRisk})
     {
         EXPECT_FALSE(sh::to_string(kind).empty());
     }
@@ -559,3 +561,269 @@ TEST(SigHealthFormat, RecordReportRendersExportNameKind)
     EXPECT_NE(report.find("ExportName"), std::string::npos);
     EXPECT_NE(report.find("anchor text"), std::string::npos);
 }
+
+// Scan-cost model
+
+TEST(SigHealthCost, CommonAnchorCostsFarMoreThanARareOne)
+{
+    // 0x11 is a rare anchor; a wall of 0x90 anchors on NOP fill, so its prefilter fires on a third of all bytes.
+    const sh::PatternHealth rare = sh::analyze_pattern(make_pattern("11 22 33 44 55 66"));
+    const sh::PatternHealth common = sh::analyze_pattern(make_pattern("90 90 90 90 90 90"));
+
+    EXPECT_EQ(rare.cost.anchor_index, 0u);
+    EXPECT_EQ(rare.cost.gap_combinations, 1u);
+    EXPECT_DOUBLE_EQ(rare.cost.backtrack_steps_per_mib, 0.0);
+    EXPECT_GT(common.cost.anchor_hits_per_mib, 50.0 * rare.cost.anchor_hits_per_mib);
+    EXPECT_GT(common.cost.estimated_us, rare.cost.estimated_us);
+    EXPECT_LT(rare.cost.estimated_us, sh::HealthPolicy{}.warn_scan_us);
+    EXPECT_FALSE(has_finding(rare.findings, sh::FindingKind::ExpensiveScan));
+    EXPECT_TRUE(has_finding(common.findings, sh::FindingKind::ExpensiveScan));
+    EXPECT_FALSE(rare.cost.calibrated);
+    EXPECT_DOUBLE_EQ(rare.cost.expected_us(), rare.cost.estimated_us);
+
+    // No anchor at all verifies at every position.
+    const sh::PatternHealth unanchored = sh::analyze_pattern(make_pattern("?? ?? ?? ??"));
+    EXPECT_EQ(unanchored.cost.anchor_index, 4u);
+    EXPECT_DOUBLE_EQ(unanchored.cost.anchor_hits_per_mib, 1024.0 * 1024.0);
+}
+
+TEST(SigHealthCost, WideJumpsRaiseBacktrackingRisk)
+{
+    const sh::PatternHealth one = sh::analyze_pattern(make_pattern("11 22 33 [2-5] 44 55 66"));
+    EXPECT_EQ(one.cost.gap_combinations, 4u);
+    EXPECT_GT(one.cost.backtrack_steps_per_mib, 0.0);
+    EXPECT_FALSE(has_finding(one.findings, sh::FindingKind::BacktrackingRisk));
+
+    // Two full-width gaps multiply to exactly the matcher's per-position budget: risky, but every placement fits.
+    const sh::PatternHealth two = sh::analyze_pattern(make_pattern("11 22 33 [0-255] 44 55 [0-255] 66 77"));
+    EXPECT_EQ(two.cost.gap_combinations, 256u * 256u);
+    EXPECT_EQ(severity_of(two.findings, sh::FindingKind::BacktrackingRisk), sh::Severity::Warning);
+    EXPECT_GT(two.cost.backtrack_steps_per_mib, one.cost.backtrack_steps_per_mib);
+
+    // A third one can exhaust the budget, so a real match could be dropped.
+    const sh::PatternHealth three =
+        sh::analyze_pattern(make_pattern("11 22 33 [0-255] 44 55 [0-255] 66 77 [0-255] 88 99"));
+    EXPECT_GT(three.cost.gap_combinations, 256u * 256u);
+    EXPECT_EQ(severity_of(three.findings, sh::FindingKind::BacktrackingRisk), sh::Severity::Critical);
+    EXPECT_EQ(three.grade, sh::Grade::Unusable);
+}
+
+TEST(SigHealthCost, CalibratedModeMeasuresARealScan)
+{
+    std::vector<std::byte> haystack(0x10000, std::byte{0xCC});
+    const auto put = [&haystack](std::size_t at, std::initializer_list<unsigned char> sequence)
+    {
+        for (const unsigned char value : sequence)
+        {
+            haystack[at++] = std::byte{value};
+        }
+    };
+    put(0x1000, {0x11, 0x22, 0x33, 0x44, 0x55, 0x66});
+    put(0x2000, {0x11});
+    put(0x3000, {0x11, 0x22});
+    const DetourModKit::Region scope{DetourModKit::Address{haystack.data()}, haystack.size()};
+
+    // A negative ceiling flags every scan, so the re-judged finding must appear exactly once.
+    sh::HealthPolicy policy;
+    policy.warn_scan_us = -1.0;
+    const auto health = sh::analyze_pattern_calibrated(make_pattern("11 22 33 44 55 66"), scope, policy);
+    ASSERT_TRUE(health.has_value());
+    EXPECT_TRUE(health->cost.calibrated);
+    EXPECT_EQ(health->cost.measured_bytes, haystack.size());
+    EXPECT_EQ(health->cost.measured_matches, 1u);
+    // Three 0x11 bytes in 1/16 MiB.
+    EXPECT_DOUBLE_EQ(health->cost.measured_anchor_hits_per_mib, 48.0);
+    EXPECT_DOUBLE_EQ(health->cost.expected_us(), health->cost.projected_us);
+    EXPECT_EQ(std::count_if(health->findings.begin(), health->findings.end(),
+                            [](const sh::Finding &f) { return f.kind == sh::FindingKind::ExpensiveScan; }),
+              1);
+    EXPECT_NE(sh::format_report(*health).find("measured"), std::string::npos);
+
+    EXPECT_FALSE(sh::analyze_pattern_calibrated(make_pattern("11 22"), DetourModKit::Region{}).has_value());
+}
+
+// Live uniqueness and margin analysis
+
+TEST(SigHealthLive, CountsMatchesAndNearMissesPerRung)
+{
+    std::vector<std::byte> haystack(0x10000, std::byte{0xCC});
+    const auto put = [&haystack](std::size_t at, std::initializer_list<unsigned char> sequence)
+    {
+        for (const unsigned char value : sequence)
+        {
+            haystack[at++] = std::byte{value};
+        }
+    };
+    // "thin": one exact site, one site a byte away, one two bytes away.
+    put(0x1000, {0x11, 0x22, 0x33, 0x44, 0x55, 0x66});
+    put(0x2000, {0x11, 0x22, 0x33, 0x44, 0x55, 0x00});
+    put(0x3000, {0x11, 0x22, 0x00, 0x44, 0x00, 0x66});
+    // "twice": two exact sites.
+    put(0x4000, {0xA1, 0xB2, 0xC3, 0xD4, 0xE5});
+    put(0x5000, {0xA1, 0xB2, 0xC3, 0xD4, 0xE5});
+    // "wide": one exact site and nothing near it; its first rung never matches.
+    put(0x6000, {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08});
+    const DetourModKit::Region scope{DetourModKit::Address{haystack.data()}, haystack.size()};
+
+    mf::Manifest manifest;
+    mf::SignatureRecord thin;
+    thin.label = "thin";
+    thin.kind = an::AnchorKind::RipGlobal;
+    thin.ladder.push_back(direct_rung("11 22 33 44 55 66"));
+    manifest.records.push_back(thin);
+    mf::SignatureRecord twice;
+    twice.label = "twice";
+    twice.kind = an::AnchorKind::CodeOperand;
+    twice.ladder.push_back(direct_rung("A1 B2 C3 D4 E5"));
+    manifest.records.push_back(twice);
+    mf::SignatureRecord wide;
+    wide.label = "wide";
+    wide.kind = an::AnchorKind::RipGlobal;
+    wide.ladder.push_back(direct_rung("7A 7B 7C 7D 7E 7F"));
+    wide.ladder.push_back(string_rung("a long enough literal"));
+    wide.ladder.push_back(direct_rung("01 02 03 04 05 06 07 08"));
+    manifest.records.push_back(wide);
+    mf::SignatureRecord text;
+    text.label = "text";
+    text.kind = an::AnchorKind::StringXref;
+    manifest.records.push_back(text);
+
+    const auto health = sh::analyze_manifest_live(manifest, scope);
+    ASSERT_TRUE(health.has_value());
+    ASSERT_EQ(health->records.size(), 4u);
+    EXPECT_TRUE(health->complete);
+    EXPECT_GE(health->scanned_bytes, haystack.size());
+
+    // Every block of the exact site matches, yet it is counted once.
+    const sh::RungLiveHealth &thin_rung = health->records[0].ladder[0];
+    ASSERT_TRUE(thin_rung.analyzed);
+    EXPECT_EQ(thin_rung.distance, 2u);
+    EXPECT_EQ(thin_rung.matches, 1u);
+    EXPECT_EQ(thin_rung.near_misses, (std::vector<std::size_t>{1, 1}));
+    EXPECT_EQ(thin_rung.margin, 1u);
+    EXPECT_EQ(health->records[0].winning_rung, std::optional<std::size_t>{0});
+    EXPECT_EQ(health->records[0].grade, sh::Grade::Fragile);
+
+    EXPECT_EQ(health->records[1].ladder[0].matches, 2u);
+    EXPECT_EQ(health->records[1].ladder[0].margin, 0u);
+    EXPECT_FALSE(health->records[1].winning_rung.has_value());
+    EXPECT_EQ(health->records[1].grade, sh::Grade::Unusable);
+
+    const sh::RecordLiveHealth &wide_live = health->records[2];
+    EXPECT_EQ(wide_live.ladder[0].matches, 0u);
+    EXPECT_FALSE(wide_live.ladder[1].analyzed);
+    EXPECT_EQ(wide_live.winning_rung, std::optional<std::size_t>{2});
+    EXPECT_EQ(wide_live.margin, 3u); // nothing within two mismatches
+    EXPECT_EQ(wide_live.grade, sh::Grade::Robust);
+
+    EXPECT_FALSE(health->records[3].analyzed);
+    EXPECT_EQ(health->robust, 1u);
+    EXPECT_EQ(health->fragile, 1u);
+    EXPECT_EQ(health->unusable, 1u);
+    EXPECT_EQ(health->skipped, 1u);
+    EXPECT_EQ(health->grade, sh::Grade::Unusable);
+
+    const std::string report = sh::format_report(*health);
+    EXPECT_NE(report.find("[thin]"), std::string::npos);
+    EXPECT_NE(report.find("margin=1"), std::string::npos);
+    EXPECT_NE(report.find("not analyzed"), std::string::npos);
+}
+
+TEST(SigHealthLive, DepthFollowsThePolicyAndThePattern)
+{
+    std::vector<std::byte> haystack(0x4000, std::byte{0xCC});
+    haystack[0x100] = std::byte{0x11};
+    haystack[0x101] = std::byte{0x00};
+    haystack[0x102] = std::byte{0x33};
+    const DetourModKit::Region scope{DetourModKit::Address{haystack.data()}, haystack.size()};
+
+    mf::Manifest manifest;
+    mf::SignatureRecord record;
+    record.label = "short";
+    record.kind = an::AnchorKind::RipGlobal;
+    record.ladder.push_back(direct_rung("11 22 33"));
+    record.ladder.push_back(direct_rung("11 ?? 33 [1-4] 44"));
+    manifest.records.push_back(record);
+
+    // Three fully-known bytes split into at most three blocks, so a depth of four is lowered to two.
+    sh::HealthPolicy policy;
+    policy.near_miss_distance = 4;
+    const auto health = sh::analyze_manifest_live(manifest, scope, policy, sc::Pages::Readable, 1);
+    ASSERT_TRUE(health.has_value());
+    const sh::RungLiveHealth &rung = health->records[0].ladder[0];
+    EXPECT_EQ(rung.distance, 2u);
+    EXPECT_EQ(rung.matches, 0u);
+    EXPECT_EQ(rung.near_misses.size(), 2u);
+    EXPECT_EQ(rung.near_misses[0], 1u);
+    // Bounded jumps are outside the block split.
+    EXPECT_FALSE(health->records[0].ladder[1].analyzed);
+    EXPECT_EQ(health->records[0].grade, sh::Grade::Unusable);
+
+    EXPECT_FALSE(sh::analyze_manifest_live(manifest, DetourModKit::Region{}).has_value());
+    EXPECT_FALSE(sh::analyze_manifest_live(manifest, scope, {}, static_cast<sc::Pages>(0xFFU)).has_value());
+}
+
+TEST(SigHealthRepair, SuggestsBothRewritesForAUniqueNearestSite)
+{
+    std::vector<std::byte> haystack(0x4000, std::byte{0xCC});
+    const std::uint8_t moved[] = {0x48, 0x8B, 0x0D, 0x11, 0x22, 0x33, 0x44, 0xE8, 0x7F};
+    for (std::size_t i = 0; i < sizeof(moved); ++i)
+    {
+        haystack[0x1230 + i] = std::byte{moved[i]};
+    }
+    const DetourModKit::Region scope{DetourModKit::Address{haystack.data()}, haystack.size()};
+
+    // The patch renumbered the register (05 -> 0D) and the call byte after the displacement (E9 -> E8).
+    const sc::Pattern broken = make_pattern("48 8B 05 ?? ?? ?? ?? | E9 7?");
+    const auto suggestion = sh::suggest_repair(broken, scope);
+    ASSERT_TRUE(suggestion.has_value()) << suggestion.error().message();
+    EXPECT_EQ(suggestion->matches, 0u);
+    EXPECT_EQ(suggestion->distance, 2u);
+    EXPECT_EQ(suggestion->nearest, 2u);
+    EXPECT_EQ(suggestion->nearest_sites, 1u);
+    ASSERT_TRUE(suggestion->repairable);
+    EXPECT_EQ(suggestion->site.raw(), reinterpret_cast<std::uintptr_t>(haystack.data() + 0x1230));
+    EXPECT_EQ(suggestion->mismatch_positions, (std::vector<std::size_t>{2, 7}));
+    EXPECT_EQ(suggestion->relearned, "48 8B 0D ?? ?? ?? ?? | E8 7?");
+    EXPECT_EQ(suggestion->loosened, "48 8B ?? ?? ?? ?? ?? | ?? 7?");
+    EXPECT_EQ(suggestion->relearned_matches, 1u);
+    EXPECT_TRUE(suggestion->complete);
+
+    const std::string report = sh::format_report(*suggestion, "ammo_global");
+    EXPECT_NE(report.find("ammo_global: one site 2 substitution(s) away"), std::string::npos);
+    EXPECT_NE(report.find("relearned: 48 8B 0D"), std::string::npos);
+}
+
+TEST(SigHealthRepair, ReportsExactMatchesAndAmbiguity)
+{
+    std::vector<std::byte> haystack(0x2000, std::byte{0xCC});
+    const DetourModKit::Region scope{DetourModKit::Address{haystack.data()}, haystack.size()};
+    for (const std::size_t at : {std::size_t{0x100}, std::size_t{0x900}})
+    {
+        haystack[at] = std::byte{0x51};
+        haystack[at + 1] = std::byte{0x62};
+        haystack[at + 2] = std::byte{0x73};
+        haystack[at + 3] = std::byte{0x84};
+    }
+
+    const auto exact = sh::suggest_repair(make_pattern("51 62 73 84"), scope);
+    ASSERT_TRUE(exact.has_value());
+    EXPECT_EQ(exact->matches, 2u);
+    EXPECT_FALSE(exact->repairable);
+
+    // Both copies are one substitution away, so no single site can be named.
+    const auto ambiguous = sh::suggest_repair(make_pattern("51 62 73 85"), scope);
+    ASSERT_TRUE(ambiguous.has_value());
+    EXPECT_EQ(ambiguous->nearest, 1u);
+    EXPECT_EQ(ambiguous->nearest_sites, 2u);
+    EXPECT_FALSE(ambiguous->repairable);
+    EXPECT_TRUE(ambiguous->relearned.empty());
+
+    const auto lost = sh::suggest_repair(make_pattern("A1 A2 A3 A4"), scope);
+    ASSERT_TRUE(lost.has_value());
+    EXPECT_EQ(lost->nearest, 0u);
+    EXPECT_FALSE(lost->repairable);
+
+    EXPECT_FALSE(sh::suggest_repair(make_pattern("?? ??"), scope).has_value());
+    EXPECT_FALSE(sh::suggest_repair(make_pattern("51 [1-2] 73"), scope).has_value());
+}
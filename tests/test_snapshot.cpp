@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <windows.h>
+
+#include "DetourModKit/rtti_dissect.hpp"
+#include "DetourModKit/snapshot.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    struct Actor
+    {
+        std::uint64_t vtable = 0;
+        std::int32_t health = 100;
+        float speed = 4.5f;
+        std::uint8_t team = 2;
+        std::uint8_t pad[7] = {};
+        std::int32_t moved_ammo = 0;
+        std::int32_t ammo = 30;
+    };
+
+    struct Health : memory::Field<std::int32_t, offsetof(Actor, health)>
+    {
+    };
+    struct Speed : memory::Field<float, offsetof(Actor, speed)>
+    {
+    };
+    struct Ammo : memory::Field<std::int32_t, offsetof(Actor, ammo)>
+    {
+    };
+
+    using ActorLayout = memory::Layout<Health, Speed, Ammo>;
+} // anonymous namespace
+
+TEST(Snapshot, OneReadCoversEveryFieldAndDecodesTypedValues)
+{
+    static_assert(ActorLayout::nominal_begin == offsetof(Actor, health));
+    static_assert(ActorLayout::nominal_end == offsetof(Actor, ammo) + sizeof(std::int32_t));
+    static_assert(ActorLayout::index_of<Ammo>() == 2);
+
+    Actor actor;
+    memory::Snapshot<ActorLayout> snapshot;
+    EXPECT_FALSE(snapshot.valid());
+    EXPECT_EQ(snapshot.span_bytes(), offsetof(Actor, ammo) + sizeof(std::int32_t) - offsetof(Actor, health));
+
+    ASSERT_TRUE(snapshot.read(Address{&actor}).has_value());
+    EXPECT_TRUE(snapshot.valid());
+    EXPECT_EQ(snapshot.get<Health>(), 100);
+    EXPECT_FLOAT_EQ(snapshot.get<Speed>(), 4.5f);
+    EXPECT_EQ(snapshot.get<Ammo>(), 30);
+
+    // The snapshot is a copy: later writes are seen only by the next read.
+    actor.health = 40;
+    EXPECT_EQ(snapshot.get<Health>(), 100);
+    ASSERT_TRUE(snapshot.read(Address{&actor}).has_value());
+    EXPECT_EQ(snapshot.get<Health>(), 40);
+}
+
+TEST(Snapshot, RuntimeOffsetsRedirectAFieldWithinTheSlack)
+{
+    Actor actor;
+    actor.moved_ammo = 17;
+    memory::Snapshot<ActorLayout> snapshot;
+
+    ASSERT_TRUE(snapshot.set_offset<Ammo>(offsetof(Actor, moved_ammo)).has_value());
+    EXPECT_EQ(snapshot.offset<Ammo>(), static_cast<std::ptrdiff_t>(offsetof(Actor, moved_ammo)));
+    ASSERT_TRUE(snapshot.read(Address{&actor}).has_value());
+    EXPECT_EQ(snapshot.get<Ammo>(), 17);
+
+    rtti::HealHit hit;
+    hit.healed_offset = offsetof(Actor, ammo);
+    ASSERT_TRUE(snapshot.set_offset<Ammo>(hit).has_value());
+    EXPECT_FALSE(snapshot.valid());
+    ASSERT_TRUE(snapshot.read(Address{&actor}).has_value());
+    EXPECT_EQ(snapshot.get<Ammo>(), 30);
+
+    const Result<rtti::HealHit> failed = std::unexpected(Error{ErrorCode::HealNoMatch, "test"});
+    const auto propagated = snapshot.set_offset<Ammo>(failed);
+    ASSERT_FALSE(propagated.has_value());
+    EXPECT_EQ(propagated.error().code, ErrorCode::HealNoMatch);
+
+    const auto too_far =
+        snapshot.set_offset<Health>(static_cast<std::ptrdiff_t>(memory::Snapshot<ActorLayout>::CAPACITY) + 0x100);
+    ASSERT_FALSE(too_far.has_value());
+    EXPECT_EQ(too_far.error().code, ErrorCode::SizeTooLarge);
+    EXPECT_EQ(snapshot.offset<Health>(), static_cast<std::ptrdiff_t>(offsetof(Actor, health)));
+}
+
+TEST(Snapshot, AFaultingOrNullBaseFailsClosed)
+{
+    memory::Snapshot<ActorLayout> snapshot;
+    const auto null_base = snapshot.read(Address{});
+    ASSERT_FALSE(null_base.has_value());
+    EXPECT_EQ(null_base.error().code, ErrorCode::NullTargetAddress);
+
+    void *page = VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_NOACCESS);
+    ASSERT_NE(page, nullptr);
+    const auto faulted = snapshot.read(Address{page});
+    ASSERT_FALSE(faulted.has_value());
+    EXPECT_EQ(faulted.error().code, ErrorCode::ReadFaulted);
+    EXPECT_FALSE(snapshot.valid());
+    VirtualFree(page, 0, MEM_RELEASE);
+}
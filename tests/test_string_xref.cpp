@@ -110,7 +110,7 @@ namespace
     // pages in one
     // VirtualAlloc keeps them contiguous so a single Region spans them, and the distinct protections keep the
     // planted string out of the executable sweep -- exactly as production strings in .rdata are never decoded as code.
-    // This is the fixture the broad (Zydis) phase-2 tests use so the decoder only ever walks the code page, never the
+    // This is the fixture the broad phase-2 tests use so the decoder only ever walks the code page, never the
     // string bytes.
     class SplitImage
     {
@@ -1138,7 +1138,7 @@ TEST(StringXrefTest, BroadMatchRecoversFromDecodeFailure)
     const char str[] = "BroadRecoveryAnchorString";
     img.write_data(0x40, str, sizeof(str));
 
-    // 0x06 (PUSH ES) has no valid 64-bit encoding, so ZydisDecoderDecodeFull rejects it and the sweep must byte-restart
+    // 0x06 (PUSH ES) has no valid 64-bit encoding, so the length decoder rejects it and the sweep must byte-restart
     // (offset += 1) to realign. The zero-filled lead-in decodes cleanly as `add [rax], al` (00 00) in 2-byte steps,
     // landing the cursor exactly on this even offset before the failure.
     const std::uint8_t invalid_opcode = 0x06;
@@ -1293,7 +1293,7 @@ TEST(StringXrefTest, BroadReferenceStraddlingProtectionSplitIsFound)
     const char str[] = "StraddleBroadString";
     img.write_string(0, str, sizeof(str));
 
-    // The broad (Zydis) phase-2 scan carries ZYDIS_MAX_INSTRUCTION_LENGTH-1 bytes back into the previous window and
+    // The broad phase-2 scan carries X86_MAX_INSTRUCTION_LENGTH-1 bytes back into the previous window and
     // de-duplicates with a count floor, so a boundary straddler is decoded whole here too.
     const std::size_t straddle_off = img.page_size() - 3;
     img.plant_lea(straddle_off, 0);
@@ -1335,6 +1335,78 @@ TEST(StringXrefTest, BroadCountFloorDedupSkipsPrevWindowReference)
     EXPECT_EQ(result->raw(), img.code_addr(img.page_size() - 7));
 }
 
+// A batch resolve locates every string literal in one multi-literal sweep and answers every reference lookup from one
+// shared index per image instead of re-sweeping per query. Both must reproduce the per-query scans exactly -- unique
+// narrow and broad-only references, ambiguity, no reference, and a pooled literal -- so each batch slot is compared
+// against the same request resolved alone.
+TEST(StringXrefTest, BatchReferenceIndexMatchesPerQuerySweeps)
+{
+    SplitImage img;
+    if (!img.ok())
+    {
+        GTEST_SKIP() << "could not allocate a synthetic split image";
+    }
+    const char lea_str[] = "BatchLeaAnchor";
+    const char cmp_str[] = "BatchCmpAnchor";
+    const char twice_str[] = "BatchTwiceAnchor";
+    const char lonely_str[] = "BatchLonelyAnchor";
+    const char pooled_str[] = "BatchPooledAnchor";
+    img.write_data(0x40, lea_str, sizeof(lea_str));
+    img.write_data(0x80, cmp_str, sizeof(cmp_str));
+    img.write_data(0xC0, twice_str, sizeof(twice_str));
+    img.write_data(0x100, lonely_str, sizeof(lonely_str));
+    img.write_data(0x140, pooled_str, sizeof(pooled_str));
+    img.write_data(0x180, pooled_str, sizeof(pooled_str));
+    // Each instruction starts an even distance past the previous one's end, so the broad sweep's two-byte walk of the
+    // zero padding (`00 00` = `add [rax], al`) lands on every planted start.
+    img.plant_code_rip_insn(0x10, 0x40, {0x48, 0x8D, 0x05}, 7);   // lea rax, [rip+lea_str]
+    img.plant_code_rip_insn(0x31, 0x80, {0x83, 0x3D}, 7, {0x01}); // cmp dword ptr [rip+cmp_str], 1
+    img.plant_code_rip_insn(0x50, 0xC0, {0x48, 0x8D, 0x05}, 7);   // lea rax, [rip+twice_str]
+    img.plant_code_rip_insn(0x71, 0xC0, {0x48, 0x8D, 0x05}, 7);   // lea rax, [rip+twice_str]
+
+    const std::vector<std::vector<scan::Candidate>> ladders = {
+        {scan::Candidate::string_xref("lea", utf8_query("BatchLeaAnchor"))},
+        {scan::Candidate::string_xref("lea_broad", broad_query("BatchLeaAnchor"))},
+        {scan::Candidate::string_xref("cmp", utf8_query("BatchCmpAnchor"))},
+        {scan::Candidate::string_xref("cmp_broad", broad_query("BatchCmpAnchor"))},
+        {scan::Candidate::string_xref("twice", broad_query("BatchTwiceAnchor"))},
+        {scan::Candidate::string_xref("lonely", broad_query("BatchLonelyAnchor"))},
+        {scan::Candidate::string_xref("pooled", utf8_query("BatchPooledAnchor"))},
+    };
+    std::vector<scan::ScanRequest> requests;
+    for (const auto &ladder : ladders)
+    {
+        requests.push_back(scan::ScanRequest{.ladder = ladder, .scope = img.range()});
+    }
+
+    for (const std::size_t workers : {std::size_t{1}, std::size_t{4}})
+    {
+        const auto batch = scan::resolve_batch(requests, workers);
+        ASSERT_TRUE(batch.has_value());
+        ASSERT_EQ(batch->size(), requests.size());
+        for (std::size_t i = 0; i < requests.size(); ++i)
+        {
+            const auto alone = scan::resolve(requests[i]);
+            ASSERT_EQ((*batch)[i].has_value(), alone.has_value()) << "request " << i;
+            if (alone.has_value())
+            {
+                EXPECT_EQ((*batch)[i]->address, alone->address) << "request " << i;
+            }
+            else
+            {
+                EXPECT_EQ((*batch)[i].error().code, alone.error().code) << "request " << i;
+            }
+        }
+        EXPECT_EQ((*batch)[0]->address.raw(), img.code_addr(0x10));
+        EXPECT_EQ((*batch)[1]->address.raw(), img.code_addr(0x10));
+        EXPECT_FALSE((*batch)[2].has_value()); // the narrow scan cannot see a cmp
+        EXPECT_EQ((*batch)[3]->address.raw(), img.code_addr(0x31));
+        EXPECT_FALSE((*batch)[4].has_value());
+        EXPECT_FALSE((*batch)[5].has_value());
+        EXPECT_FALSE((*batch)[6].has_value());
+    }
+}
+
 TEST(StringXrefTest, StringPointerSlotResolvesStore)
 {
     SyntheticImage img;
@@ -1677,7 +1749,7 @@ TEST(StringXrefTest, ErrorToStringIsNoexceptAndTotal)
 #if defined(_MSC_VER) || defined(_WIN64)
 // Mirror of the scanner region guard for the string-xref window scans. find_string_xref reads each
 // execute-readable window returned by collect_executable_windows with unguarded byte reads (narrow shape scan) and
-// Zydis decoding (broad scan); scan_window_narrow_guarded / scan_window_broad_guarded backstop a concurrent decommit /
+// length decoding (broad scan); scan_window_narrow_guarded / scan_window_broad_guarded backstop a concurrent decommit /
 // reprotect that the per-window VirtualQuery gate cannot close. This test resolves a planted anchor in the first
 // executable window while a second thread decommits and recommits a separate trailing executable window. Every
 // iteration returns either the stable site (no fault landed) or a fail-closed ambiguity verdict (a faulted trailing
@@ -1739,7 +1811,7 @@ TEST(StringXrefRegionGuard, SurvivesConcurrentDecommitMidScan)
         });
 
     // The toggler races every iteration; a few hundred resolves give the decommit ample chance to land mid-scan while
-    // keeping the broad Zydis sweep's per-iteration cost bounded. Page 0 (anchor + reference) is never decommitted, so
+    // keeping the broad sweep's per-iteration cost bounded. Page 0 (anchor + reference) is never decommitted, so
     // a fault-free resolve returns reference_site; when the decommit lands mid-scan the trailing window is skipped,
     // which taints uniqueness and fails the resolve closed to ambiguous. Each result is therefore the stable site or a
     // fail-closed ambiguity verdict -- never a wrong address, never a crash.
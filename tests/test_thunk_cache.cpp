@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <windows.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "DetourModKit/memory.hpp"
+#include "internal/thunk_cache.hpp"
+#include "x86_decode.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    // One executable page holding an E9 thunk at offset 0 that jumps to a `ret` at offset 0x100.
+    struct ThunkPage
+    {
+        ThunkPage()
+            : bytes(static_cast<std::uint8_t *>(
+                  VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE)))
+        {
+            point_at(0x100);
+        }
+        ~ThunkPage()
+        {
+            VirtualFree(bytes, 0, MEM_RELEASE);
+        }
+        ThunkPage(const ThunkPage &) = delete;
+        ThunkPage &operator=(const ThunkPage &) = delete;
+
+        void point_at(std::size_t offset) noexcept
+        {
+            bytes[offset] = 0xC3;
+            const auto disp = static_cast<std::int32_t>(offset - 5);
+            bytes[0] = 0xE9;
+            std::memcpy(bytes + 1, &disp, sizeof(disp));
+        }
+
+        [[nodiscard]] std::uintptr_t address(std::size_t offset = 0) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(bytes) + offset;
+        }
+
+        std::uint8_t *bytes;
+    };
+} // namespace
+
+TEST(ThunkCacheTest, ADistinctThunkDecodesOnce)
+{
+    ThunkPage page;
+    ASSERT_NE(page.bytes, nullptr);
+    detail::invalidate_thunk_targets();
+
+    const detail::ThunkCacheStats before = detail::thunk_cache_stats();
+    EXPECT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x100));
+    EXPECT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x100));
+    const detail::ThunkCacheStats after = detail::thunk_cache_stats();
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+
+    // The same address under another decoder is another entry, and this one refuses it.
+    EXPECT_FALSE(detail::resolve_thunk_target(page.address(), &detail::decode_ff25_indirect).has_value());
+}
+
+TEST(ThunkCacheTest, InvalidateRangeRetiresCachedDestinations)
+{
+    ThunkPage page;
+    ASSERT_NE(page.bytes, nullptr);
+    detail::invalidate_thunk_targets();
+    ASSERT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x100));
+
+    // Re-pointed without an invalidation, the old destination is still served.
+    page.point_at(0x200);
+    EXPECT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x100));
+
+    memory::invalidate_range(Region{Address{page.address()}, 5});
+    EXPECT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x200));
+}
+
+TEST(ThunkCacheTest, ARefusedDestinationIsNotCached)
+{
+    ThunkPage page;
+    ASSERT_NE(page.bytes, nullptr);
+    detail::invalidate_thunk_targets();
+
+    // Jump into a page that is not executable: refused, and decoded again next time rather than cached.
+    DWORD old_protection = 0;
+    ASSERT_TRUE(VirtualProtect(page.bytes, 0x1000, PAGE_READWRITE, &old_protection));
+    const detail::ThunkCacheStats before = detail::thunk_cache_stats();
+    EXPECT_FALSE(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32).has_value());
+    EXPECT_FALSE(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32).has_value());
+    EXPECT_EQ(detail::thunk_cache_stats().misses - before.misses, 2u);
+
+    ASSERT_TRUE(VirtualProtect(page.bytes, 0x1000, PAGE_EXECUTE_READWRITE, &old_protection));
+    EXPECT_EQ(detail::resolve_thunk_target(page.address(), &detail::decode_e9_rel32), page.address(0x100));
+}
@@ -0,0 +1,209 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+#include "DetourModKit/region_set.hpp"
+#include "DetourModKit/value_scanner.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    // Three sweep chunks of committed, zero-filled memory plus a page, so a scan spans several chunks and workers.
+    constexpr std::size_t CHUNK_BYTES = std::size_t{1} << 20;
+    constexpr std::size_t ARENA_BYTES = 3 * CHUNK_BYTES + 0x1000;
+
+    class Arena
+    {
+    public:
+        Arena()
+            : m_base(static_cast<std::byte *>(
+                  VirtualAlloc(nullptr, ARENA_BYTES, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE)))
+        {
+        }
+        ~Arena()
+        {
+            if (m_base != nullptr)
+                VirtualFree(m_base, 0, MEM_RELEASE);
+        }
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        [[nodiscard]] bool ok() const noexcept { return m_base != nullptr; }
+        [[nodiscard]] std::byte *data() const noexcept { return m_base; }
+        [[nodiscard]] std::uintptr_t address_of(std::size_t offset) const noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(m_base + offset);
+        }
+
+        // A scan scope of just this arena, so the rest of the process's writable memory cannot add hits.
+        [[nodiscard]] memory::ValueScanOptions options(std::size_t max_workers = 0) const
+        {
+            const std::array<Region, 1> ranges = {Region{Address{m_base}, ARENA_BYTES}};
+            memory::ValueScanOptions result;
+            result.scope = RegionSet::of(ranges).value();
+            result.max_workers = max_workers;
+            return result;
+        }
+
+        template <typename T> void put(std::size_t offset, T value) noexcept
+        {
+            std::memcpy(m_base + offset, &value, sizeof(T));
+        }
+
+    private:
+        std::byte *m_base;
+    };
+
+    [[nodiscard]] std::vector<std::uintptr_t> raw_addresses(const memory::ValueScanner &scanner)
+    {
+        std::vector<std::uintptr_t> out;
+        for (const Address address : scanner.addresses().value())
+        {
+            out.push_back(address.raw());
+        }
+        return out;
+    }
+} // anonymous namespace
+
+TEST(ValueScanner, FirstScanFindsEveryAlignedSlotAcrossChunksOnAnyWorkerCount)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    constexpr std::int32_t needle = 0x5EED1234;
+    arena.put(0, needle);
+    arena.put(CHUNK_BYTES - sizeof(needle), needle); // last slot of the first chunk
+    arena.put(2 * CHUNK_BYTES + 100, needle);
+    arena.put(3 * CHUNK_BYTES + 0x1000 - sizeof(needle), needle); // last slot of the short final chunk
+    arena.put(0x2002, needle);                                     // misaligned: not a slot
+
+    const std::vector<std::uintptr_t> expected = {arena.address_of(0), arena.address_of(CHUNK_BYTES - 4),
+                                                  arena.address_of(2 * CHUNK_BYTES + 100),
+                                                  arena.address_of(ARENA_BYTES - 4)};
+    for (const std::size_t workers : {std::size_t{1}, std::size_t{0}})
+    {
+        Result<memory::ValueScanner> scanner = memory::ValueScanner::first_scan(needle, arena.options(workers));
+        ASSERT_TRUE(scanner.has_value());
+        EXPECT_EQ(scanner->type(), memory::ValueType::I32);
+        EXPECT_EQ(scanner->size(), expected.size());
+        EXPECT_FALSE(scanner->incomplete());
+        EXPECT_EQ(raw_addresses(*scanner), expected);
+    }
+}
+
+TEST(ValueScanner, RefinePassesNarrowByChangeDirectionAndValue)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    const std::array<std::size_t, 4> slots = {0x40, 0x1000, CHUNK_BYTES + 8, 2 * CHUNK_BYTES + 0x800};
+    for (const std::size_t slot : slots)
+    {
+        arena.put<std::int32_t>(slot, 100);
+    }
+
+    Result<memory::ValueScanner> scanner = memory::ValueScanner::first_scan<std::int32_t>(100, arena.options());
+    ASSERT_TRUE(scanner.has_value());
+    ASSERT_EQ(scanner->size(), 4u);
+
+    EXPECT_EQ(scanner->refine(memory::Refine::Unchanged).value(), 4u);
+
+    arena.put<std::int32_t>(slots[1], 150);
+    arena.put<std::int32_t>(slots[2], 50);
+    EXPECT_EQ(scanner->refine(memory::Refine::Changed).value(), 2u);
+
+    // The survivors' stored values are now 150 and 50; only the first goes up again.
+    arena.put<std::int32_t>(slots[1], 160);
+    arena.put<std::int32_t>(slots[2], 40);
+    EXPECT_EQ(scanner->refine(memory::Refine::Increased).value(), 1u);
+    const std::vector<std::uintptr_t> increased = {arena.address_of(slots[1])};
+    EXPECT_EQ(raw_addresses(*scanner), increased);
+
+    EXPECT_EQ(scanner->refine_equals<std::int32_t>(161).value(), 0u);
+    EXPECT_TRUE(scanner->empty());
+    EXPECT_TRUE(scanner->addresses().value().empty());
+}
+
+TEST(ValueScanner, FloatingPointScansCompareNumericallyAndNeverMatchNaN)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    arena.put(0x100, 1.5f);
+    arena.put(0x104, 1.75f);
+    arena.put(0x108, 2.5f);
+    arena.put(0x10C, std::numeric_limits<float>::quiet_NaN());
+
+    Result<memory::ValueScanner> floats = memory::ValueScanner::first_scan_between(1.25f, 2.0f, arena.options());
+    ASSERT_TRUE(floats.has_value());
+    const std::vector<std::uintptr_t> in_range = {arena.address_of(0x100), arena.address_of(0x104)};
+    EXPECT_EQ(raw_addresses(*floats), in_range);
+    EXPECT_EQ(floats->refine_between(1.6f, 1.8f).value(), 1u);
+
+    arena.put(0x2000, 3.25);
+    arena.put(0x2010, 3.25);
+    arena.put(0x2024, 3.25); // 4- but not 8-aligned: not a double slot
+    Result<memory::ValueScanner> doubles = memory::ValueScanner::first_scan(3.25, arena.options());
+    ASSERT_TRUE(doubles.has_value());
+    EXPECT_EQ(doubles->type(), memory::ValueType::F64);
+    const std::vector<std::uintptr_t> aligned = {arena.address_of(0x2000), arena.address_of(0x2010)};
+    EXPECT_EQ(raw_addresses(*doubles), aligned);
+
+    arena.put(0x2000, std::numeric_limits<double>::quiet_NaN());
+    EXPECT_EQ(doubles->refine(memory::Refine::Decreased).value(), 0u);
+}
+
+TEST(ValueScanner, DecommittedHitsAreDroppedAndReportedIncomplete)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+    arena.put<std::int32_t>(0x10, 0x7A11);
+    arena.put<std::int32_t>(0x2010, 0x7A11);
+
+    Result<memory::ValueScanner> scanner = memory::ValueScanner::first_scan<std::int32_t>(0x7A11, arena.options());
+    ASSERT_TRUE(scanner.has_value());
+    ASSERT_EQ(scanner->size(), 2u);
+
+    ASSERT_NE(VirtualFree(arena.data() + 0x2000, 0x1000, MEM_DECOMMIT), 0);
+    EXPECT_EQ(scanner->refine(memory::Refine::Unchanged).value(), 1u);
+    EXPECT_TRUE(scanner->incomplete());
+    const std::vector<std::uintptr_t> survivor = {arena.address_of(0x10)};
+    EXPECT_EQ(raw_addresses(*scanner), survivor);
+}
+
+TEST(ValueScanner, RejectsNaNInvertedBoundsTypeMismatchAndAMovedFromScanner)
+{
+    Arena arena;
+    ASSERT_TRUE(arena.ok());
+
+    const Result<memory::ValueScanner> nan_scan =
+        memory::ValueScanner::first_scan(std::numeric_limits<float>::quiet_NaN(), arena.options());
+    ASSERT_FALSE(nan_scan.has_value());
+    EXPECT_EQ(nan_scan.error().code, ErrorCode::InvalidArg);
+
+    const Result<memory::ValueScanner> inverted =
+        memory::ValueScanner::first_scan_between<std::int32_t>(5, 4, arena.options());
+    ASSERT_FALSE(inverted.has_value());
+    EXPECT_EQ(inverted.error().code, ErrorCode::InvalidArg);
+
+    arena.put<std::int32_t>(0x80, 77);
+    Result<memory::ValueScanner> scanner = memory::ValueScanner::first_scan<std::int32_t>(77, arena.options());
+    ASSERT_TRUE(scanner.has_value());
+    const Result<std::size_t> mismatch = scanner->refine_equals(77.0f);
+    ASSERT_FALSE(mismatch.has_value());
+    EXPECT_EQ(mismatch.error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(scanner->size(), 1u);
+
+    memory::ValueScanner moved = std::move(*scanner);
+    EXPECT_TRUE(scanner->empty());
+    const Result<std::size_t> after_move = scanner->refine(memory::Refine::Changed);
+    ASSERT_FALSE(after_move.has_value());
+    EXPECT_EQ(after_move.error().code, ErrorCode::InvalidArg);
+    EXPECT_EQ(moved.size(), 1u);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <windows.h>
+
+#include "DetourModKit/memory.hpp"
+#include "DetourModKit/watch_set.hpp"
+
+using namespace DetourModKit;
+
+namespace
+{
+    [[nodiscard]] std::vector<std::size_t> changed_of(memory::WatchSet &set)
+    {
+        const std::span<const std::size_t> changed = set.poll();
+        return {changed.begin(), changed.end()};
+    }
+} // anonymous namespace
+
+TEST(WatchSet, ReportsFirstReadsThenOnlyTheEntriesThatChanged)
+{
+    struct Player
+    {
+        std::int32_t health = 100;
+        std::uint8_t flags = 0;
+        float position[3] = {1.0f, 2.0f, 3.0f};
+    };
+    Player player;
+    std::uint64_t tick = 0;
+
+    memory::WatchSet set;
+    EXPECT_TRUE(set.poll().empty());
+    ASSERT_EQ(set.add(Address{&player.health}, sizeof(player.health)).value(), 0u);
+    ASSERT_EQ(set.add(Address{&player.flags}, sizeof(player.flags)).value(), 1u);
+    ASSERT_EQ(set.add(Address{&player.position}, sizeof(player.position)).value(), 2u);
+    ASSERT_EQ(set.add(Address{&tick}, sizeof(tick)).value(), 3u);
+    EXPECT_EQ(set.size(), 4u);
+    EXPECT_FALSE(set.value<std::int32_t>(0).has_value());
+
+    // Every entry reads for the first time, zero-valued ones included.
+    EXPECT_EQ(changed_of(set), (std::vector<std::size_t>{0, 1, 2, 3}));
+    EXPECT_TRUE(changed_of(set).empty());
+
+    player.position[2] = 4.0f;
+    tick = 1;
+    EXPECT_EQ(changed_of(set), (std::vector<std::size_t>{2, 3}));
+
+    player.health = 75;
+    player.flags = 0x80;
+    EXPECT_EQ(changed_of(set), (std::vector<std::size_t>{0, 1}));
+    EXPECT_EQ(set.value<std::int32_t>(0).value(), 75);
+    EXPECT_EQ(set.value<std::uint8_t>(1).value(), 0x80);
+    EXPECT_TRUE(set.valid(3));
+
+    const auto wrong_size = set.value<std::int64_t>(0);
+    ASSERT_FALSE(wrong_size.has_value());
+    EXPECT_EQ(wrong_size.error().code, ErrorCode::InvalidArg);
+}
+
+TEST(WatchSet, EntriesThatStopAndResumeReadingAreReportedOnTheFlip)
+{
+    void *page = VirtualAlloc(nullptr, 0x1000, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    ASSERT_NE(page, nullptr);
+    auto *value = static_cast<std::uint32_t *>(page);
+    *value = 7;
+    std::uint32_t steady = 9;
+
+    memory::WatchSet set;
+    ASSERT_TRUE(set.add(Address{value}, sizeof(*value)).has_value());
+    ASSERT_TRUE(set.add(Address{&steady}, sizeof(steady)).has_value());
+    EXPECT_EQ(changed_of(set).size(), 2u);
+
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(page, 0x1000, PAGE_NOACCESS, &old_protect));
+    EXPECT_EQ(changed_of(set), (std::vector<std::size_t>{0}));
+    EXPECT_FALSE(set.valid(0));
+    EXPECT_EQ(set.value<std::uint32_t>(0).value(), 7u);
+    EXPECT_TRUE(changed_of(set).empty());
+
+    ASSERT_TRUE(VirtualProtect(page, 0x1000, PAGE_READWRITE, &old_protect));
+    EXPECT_EQ(changed_of(set), (std::vector<std::size_t>{0}));
+    EXPECT_TRUE(set.valid(0));
+
+    VirtualFree(page, 0, MEM_RELEASE);
+}
+
+TEST(WatchSet, ChainEntriesFollowTheirRootAndFailWhileItIsNull)
+{
+    struct Actor
+    {
+        std::uint64_t pad = 0;
+        std::int32_t ammo = 30;
+    };
+    Actor first;
+    Actor second;
+    second.ammo = 12;
+    Actor *volatile root = &first;
+
+    const std::array<memory::ChainStep, 2> steps = {memory::ChainStep{0}, memory::ChainStep{offsetof(Actor, ammo)}};
+    auto chain = memory::CompiledChain::make(Address{&root}, steps, 0);
+    ASSERT_TRUE(chain.has_value());
+
+    memory::WatchSet set;
+    ASSERT_TRUE(set.add(std::move(*chain), sizeof(std::int32_t)).has_value());
+    EXPECT_EQ(changed_of(set).size(), 1u);
+    EXPECT_EQ(set.value<std::int32_t>(0).value(), 30);
+
+    root = &second;
+    EXPECT_EQ(changed_of(set).size(), 1u);
+    EXPECT_EQ(set.value<std::int32_t>(0).value(), 12);
+
+    root = nullptr;
+    EXPECT_EQ(changed_of(set).size(), 1u);
+    EXPECT_FALSE(set.valid(0));
+}
+
+TEST(WatchSet, RejectsNullAddressesAndBadSizes)
+{
+    std::uint32_t value = 0;
+    memory::WatchSet set;
+
+    const auto null_address = set.add(Address{}, 4);
+    ASSERT_FALSE(null_address.has_value());
+    EXPECT_EQ(null_address.error().code, ErrorCode::NullTargetAddress);
+
+    const auto zero_size = set.add(Address{&value}, 0);
+    ASSERT_FALSE(zero_size.has_value());
+    EXPECT_EQ(zero_size.error().code, ErrorCode::InvalidArg);
+
+    const auto too_large = set.add(Address{&value}, memory::MAX_WATCH_SIZE + 1);
+    ASSERT_FALSE(too_large.has_value());
+    EXPECT_EQ(too_large.error().code, ErrorCode::SizeTooLarge);
+    EXPECT_TRUE(set.empty());
+
+    ASSERT_TRUE(set.add(Address{&value}, sizeof(value)).has_value());
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_TRUE(set.poll().empty());
+}
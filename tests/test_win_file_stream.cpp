@@ -257,6 +257,66 @@ TEST_F(WinFileStreamBufTest, Xsputn_LargeWrite_ByteExactAcrossFlushBoundaries)
     EXPECT_TRUE(content == data);
 }
 
+TEST_F(WinFileStreamBufTest, Overlapped_PagesReachTheFileInOrderAfterTheSynchronousPrefix)
+{
+    WinFileStreamBuf buf;
+    EXPECT_FALSE(buf.enable_overlapped(4096, 2));
+    ASSERT_TRUE(buf.open(m_test_path.string(), std::ios_base::out));
+    EXPECT_FALSE(buf.enable_overlapped(4096, 1));
+    EXPECT_FALSE(buf.enable_overlapped(4096, WinFileStreamBuf::MAX_WRITE_BUFFERS + 1));
+
+    const std::string prefix = "synchronous prefix\n";
+    ASSERT_EQ(buf.sputn(prefix.data(), static_cast<std::streamsize>(prefix.size())),
+              static_cast<std::streamsize>(prefix.size()));
+    ASSERT_TRUE(buf.enable_overlapped(4096, 3));
+    EXPECT_TRUE(buf.is_overlapped());
+    EXPECT_FALSE(buf.enable_overlapped(4096, 3));
+
+    // Many rotations through three pages, with explicit submits at ragged points in between.
+    std::string expected = prefix;
+    for (size_t chunk = 0; chunk < 64; ++chunk)
+    {
+        std::string data(977 + chunk * 13, '\0');
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            data[i] = static_cast<char>((chunk * 7u + i * 31u) & 0xFFu);
+        }
+        ASSERT_EQ(buf.sputn(data.data(), static_cast<std::streamsize>(data.size())),
+                  static_cast<std::streamsize>(data.size()));
+        expected += data;
+        if (chunk % 5 == 0)
+        {
+            EXPECT_TRUE(buf.submit());
+            EXPECT_EQ(buf.buffered(), 0u);
+        }
+    }
+    EXPECT_EQ(buf.pubsync(), 0);
+    buf.close();
+    EXPECT_FALSE(buf.is_overlapped());
+
+    const auto content = read_file(m_test_path);
+    ASSERT_EQ(content.size(), expected.size());
+    EXPECT_TRUE(content == expected);
+}
+
+TEST_F(WinFileStreamBufTest, Overlapped_AppendModeKeepsTheExistingContent)
+{
+    {
+        std::ofstream seed(m_test_path, std::ios::binary);
+        seed << "existing line\n";
+    }
+
+    WinFileStreamBuf buf;
+    ASSERT_TRUE(buf.open(m_test_path.string(), std::ios_base::app));
+    ASSERT_TRUE(buf.enable_overlapped(4096, 2));
+    const std::string data(4096 * 5 + 17, 'p');
+    ASSERT_EQ(buf.sputn(data.data(), static_cast<std::streamsize>(data.size())),
+              static_cast<std::streamsize>(data.size()));
+    buf.close();
+
+    EXPECT_EQ(read_file(m_test_path), "existing line\n" + data);
+}
+
 TEST_F(WinFileStreamBufTest, Xsputn_ZeroCount_ReturnsZero)
 {
     WinFileStreamBuf buf;
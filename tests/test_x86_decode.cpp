@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <initializer_list>
+#include <vector>
 
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
@@ -12,7 +15,10 @@
 using DetourModKit::detail::decode_e9_rel32;
 using DetourModKit::detail::decode_eb_rel8;
 using DetourModKit::detail::decode_ff25_indirect;
+using DetourModKit::detail::decode_hotpatch_site;
+using DetourModKit::detail::decode_insn_shape;
 using DetourModKit::detail::decode_mov_rax_imm64_jmp_rax;
+using DetourModKit::detail::InsnShape;
 
 namespace
 {
@@ -22,6 +28,18 @@ namespace
     {
         std::memcpy(dst, &value, sizeof(value));
     }
+
+    // Decodes @p bytes as one instruction; a zero length means the decoder rejected them.
+    InsnShape shape_of(std::initializer_list<std::uint8_t> bytes)
+    {
+        const std::vector<std::uint8_t> code(bytes);
+        InsnShape shape;
+        if (!decode_insn_shape(code.data(), code.size(), shape))
+        {
+            return InsnShape{};
+        }
+        return shape;
+    }
 } // namespace
 
 TEST(X86DecodeTest, DecodeE9Rel32_NullAddressRejected)
@@ -241,3 +259,162 @@ TEST(X86DecodeTest, DecodeMovRaxJmpRax_UnmappedInstructionRejected)
 
     VirtualFree(region, 0, MEM_RELEASE);
 }
+
+TEST(X86DecodeTest, DecodeHotpatchSite_AcceptsFillerBeforeAReplayableEntry)
+{
+    // Five filler bytes, then the entry at offset 6 of an 8-aligned buffer; the filler may mix INT3 and NOP.
+    alignas(8) std::array<std::uint8_t, 9> buf{0x00, 0xCC, 0xCC, 0x90, 0xCC, 0xCC, 0x8B, 0xFF, 0xC3};
+    const auto entry = reinterpret_cast<std::uintptr_t>(buf.data() + 6);
+
+    const auto site = decode_hotpatch_site(entry);
+    ASSERT_TRUE(site.has_value());
+    EXPECT_EQ(site->pad, (std::array<std::uint8_t, 5>{0xCC, 0xCC, 0x90, 0xCC, 0xCC}));
+    EXPECT_EQ(site->entry, (std::array<std::uint8_t, 2>{0x8B, 0xFF}));
+
+    buf[6] = 0x66;
+    buf[7] = 0x90;
+    EXPECT_TRUE(decode_hotpatch_site(entry).has_value());
+    buf[6] = 0x41;
+    buf[7] = 0x57;
+    EXPECT_TRUE(decode_hotpatch_site(entry).has_value()) << "push r15";
+}
+
+TEST(X86DecodeTest, DecodeHotpatchSite_RejectsLiveFillerOtherEntriesAndOddAddresses)
+{
+    alignas(8) std::array<std::uint8_t, 10> buf{0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x8B, 0xFF, 0xC3, 0xC3};
+    const auto entry = reinterpret_cast<std::uintptr_t>(buf.data() + 6);
+    ASSERT_TRUE(decode_hotpatch_site(entry).has_value());
+
+    buf[3] = 0xE9; // the filler already holds someone's jump
+    EXPECT_FALSE(decode_hotpatch_site(entry).has_value());
+    buf[3] = 0xCC;
+
+    buf[6] = 0xEB; // a short jump cannot be replayed from a stub
+    buf[7] = 0xF9;
+    EXPECT_FALSE(decode_hotpatch_site(entry).has_value());
+    buf[6] = 0x48; // a REX.W prefix starts a longer instruction
+    buf[7] = 0x89;
+    EXPECT_FALSE(decode_hotpatch_site(entry).has_value());
+
+    // An odd entry could not be armed with one atomic 2-byte store.
+    buf[6] = 0xCC;
+    buf[7] = 0x8B;
+    buf[8] = 0xFF;
+    EXPECT_FALSE(decode_hotpatch_site(entry + 1).has_value());
+    EXPECT_FALSE(decode_hotpatch_site(0).has_value());
+}
+
+TEST(X86DecodeTest, DecodeHotpatchSite_UnmappedFillerRejected)
+{
+    // The filler sits on a no-access page right before the entry's page; the guarded read fails closed.
+    SYSTEM_INFO si{};
+    GetSystemInfo(&si);
+    auto *region = static_cast<std::uint8_t *>(
+        VirtualAlloc(nullptr, 2 * si.dwPageSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    ASSERT_NE(region, nullptr);
+    std::uint8_t *entry = region + si.dwPageSize;
+    entry[0] = 0x8B;
+    entry[1] = 0xFF;
+    DWORD old_protect = 0;
+    ASSERT_TRUE(VirtualProtect(region, si.dwPageSize, PAGE_NOACCESS, &old_protect));
+
+    EXPECT_FALSE(decode_hotpatch_site(reinterpret_cast<std::uintptr_t>(entry)).has_value());
+
+    VirtualFree(region, 0, MEM_RELEASE);
+}
+
+TEST(X86DecodeTest, DecodeInsnShape_RipRelativeReferenceShapes)
+{
+    // lea rax, [rip+0x10]
+    InsnShape shape = shape_of({0x48, 0x8D, 0x05, 0x10, 0x00, 0x00, 0x00});
+    EXPECT_EQ(shape.length, 7u);
+    EXPECT_TRUE(shape.rip_relative);
+    EXPECT_EQ(shape.displacement, 0x10);
+    EXPECT_EQ(shape.rip_target(0x1000), 0x1017u);
+
+    // cmp dword ptr [rip-0x10], 1: the target is relative to the end of the instruction, past the immediate.
+    shape = shape_of({0x83, 0x3D, 0xF0, 0xFF, 0xFF, 0xFF, 0x01});
+    EXPECT_EQ(shape.length, 7u);
+    EXPECT_TRUE(shape.rip_relative);
+    EXPECT_EQ(shape.rip_target(0x1000), 0x0FF7u);
+
+    // test dword ptr [rip+1], imm32 (group 3 /0 carries an immediate; 66 narrows it to imm16).
+    EXPECT_EQ(shape_of({0xF7, 0x05, 0x01, 0x00, 0x00, 0x00, 0x01, 0x02, 0x03, 0x04}).length, 10u);
+    EXPECT_EQ(shape_of({0x66, 0xF7, 0x05, 0x01, 0x00, 0x00, 0x00, 0x01, 0x02}).length, 9u);
+    // not dword ptr [rip+1] (group 3 /2) has none.
+    EXPECT_EQ(shape_of({0xF7, 0x15, 0x01, 0x00, 0x00, 0x00}).length, 6u);
+
+    // vpalignr-shaped VEX 0F3A with an imm8, and EVEX vmovups zmm0, [rip+1].
+    shape = shape_of({0xC4, 0xE3, 0x79, 0x0F, 0x05, 0x01, 0x00, 0x00, 0x00, 0x08});
+    EXPECT_EQ(shape.length, 10u);
+    EXPECT_TRUE(shape.rip_relative);
+    shape = shape_of({0x62, 0xF1, 0x7C, 0x48, 0x10, 0x05, 0x01, 0x00, 0x00, 0x00});
+    EXPECT_EQ(shape.length, 10u);
+    EXPECT_TRUE(shape.rip_relative);
+
+    // A 0x67 prefix makes the same ModRM [eip+disp32], which is not a RIP reference.
+    shape = shape_of({0x67, 0x8B, 0x05, 0x01, 0x00, 0x00, 0x00});
+    EXPECT_EQ(shape.length, 7u);
+    EXPECT_FALSE(shape.rip_relative);
+}
+
+TEST(X86DecodeTest, DecodeInsnShape_LengthsWithoutRipOperands)
+{
+    EXPECT_EQ(shape_of({0x48, 0xB8, 1, 2, 3, 4, 5, 6, 7, 8}).length, 10u); // mov rax, imm64
+    EXPECT_EQ(shape_of({0x66, 0xB8, 1, 2}).length, 4u);                   // mov ax, imm16
+    EXPECT_EQ(shape_of({0x48, 0x89, 0x5C, 0x24, 0x08}).length, 5u);        // mov [rsp+8], rbx
+    EXPECT_EQ(shape_of({0x8B, 0x04, 0x25, 1, 2, 3, 4}).length, 7u);        // mov eax, [disp32] via SIB
+    EXPECT_EQ(shape_of({0x0F, 0x1F, 0x44, 0x00, 0x00}).length, 5u);        // nop dword ptr [rax+rax]
+    EXPECT_EQ(shape_of({0x0F, 0x84, 1, 2, 3, 4}).length, 6u);              // je rel32
+    EXPECT_EQ(shape_of({0x0F, 0x20, 0x05}).length, 3u);                    // mov rbp, cr0 ignores ModRM.mod
+    EXPECT_EQ(shape_of({0xA1, 1, 2, 3, 4, 5, 6, 7, 8}).length, 9u);        // mov eax, moffs64
+    EXPECT_EQ(shape_of({0x67, 0xA1, 1, 2, 3, 4}).length, 6u);              // mov eax, moffs32
+    EXPECT_EQ(shape_of({0xC8, 1, 2, 3}).length, 4u);                       // enter iw, ib
+    EXPECT_EQ(shape_of({0xC5, 0xF8, 0x77}).length, 3u);                    // vzeroupper
+    EXPECT_EQ(shape_of({0x8F, 0xE8, 0x78, 0xC2, 0xC1, 0x05}).length, 6u);  // XOP vprotb xmm0, xmm1, 5
+    EXPECT_EQ(shape_of({0x8F, 0xC0}).length, 2u);                          // pop rax (8F /0 is not XOP)
+}
+
+TEST(X86DecodeTest, DecodeInsnShape_TerminatorsBehindPrefixes)
+{
+    EXPECT_TRUE(shape_of({0xC3}).never_falls_through());                    // ret
+    EXPECT_TRUE(shape_of({0xF3, 0xC3}).never_falls_through());              // rep ret
+    EXPECT_TRUE(shape_of({0x66, 0xC3}).never_falls_through());              // ret under an operand-size prefix
+    EXPECT_TRUE(shape_of({0xC2, 0x08, 0x00}).never_falls_through());        // ret imm16
+    EXPECT_TRUE(shape_of({0x48, 0xFF, 0xE0}).never_falls_through());        // jmp rax under REX.W
+    EXPECT_TRUE(shape_of({0xFF, 0x25, 1, 2, 3, 4}).never_falls_through());  // jmp [rip + disp32]
+    EXPECT_FALSE(shape_of({0xFF, 0xD0}).never_falls_through());             // call rax
+    EXPECT_FALSE(shape_of({0x0F, 0x84, 1, 2, 3, 4}).never_falls_through()); // je rel32
+    EXPECT_FALSE(shape_of({0x0F, 0xC3, 0x00}).never_falls_through());       // movnti: C3 in the 0F map
+    EXPECT_EQ(shape_of({0xF3, 0x48, 0xFF, 0xE0}).opcode, 0xFFu);
+    EXPECT_EQ(shape_of({0xF3, 0x48, 0xFF, 0xE0}).modrm_reg, 4u);
+}
+
+TEST(X86DecodeTest, DecodeInsnShape_RejectsInvalidAndTruncatedEncodings)
+{
+    EXPECT_EQ(shape_of({0x06}).length, 0u);                           // push es: removed in 64-bit mode
+    EXPECT_EQ(shape_of({0xC6, 0xC8, 0x00}).length, 0u);               // C6 /1 is undefined
+    EXPECT_EQ(shape_of({0x8D, 0xC0}).length, 0u);                     // lea with a register source
+    EXPECT_EQ(shape_of({0x66, 0xC5, 0xF8, 0x77}).length, 0u);         // VEX behind 0x66
+    EXPECT_EQ(shape_of({0x41}).length, 0u);                           // a lone REX
+    EXPECT_EQ(shape_of({0xE8, 0x00, 0x00}).length, 0u);               // call rel32 cut short
+    EXPECT_EQ(shape_of({0x48, 0x8D, 0x05, 0x01, 0x00}).length, 0u);   // displacement cut short
+
+    // Fourteen prefixes and a one-byte opcode is the 15-byte limit; one prefix more is past it.
+    std::vector<std::uint8_t> code(14, 0x66);
+    code.push_back(0x90);
+    InsnShape shape;
+    ASSERT_TRUE(decode_insn_shape(code.data(), code.size(), shape));
+    EXPECT_EQ(shape.length, 15u);
+    code.insert(code.begin(), 0x66);
+    EXPECT_FALSE(decode_insn_shape(code.data(), code.size(), shape));
+}
+
+static_assert(
+    []
+    {
+        // The decoder is constexpr, so a shape can be pinned at compile time: lea rcx, [rip+0].
+        const std::uint8_t code[] = {0x48, 0x8D, 0x0D, 0x00, 0x00, 0x00, 0x00};
+        InsnShape shape;
+        return decode_insn_shape(code, sizeof(code), shape) && shape.length == 7 && shape.rip_relative;
+    }());
@@ -0,0 +1,84 @@
+/**
+ * @file log_kv_decode.cpp
+ * @brief Command-line structured log decoder: prints the log_kv() records of a structured log, oldest first.
+ *
+ * Usage: DetourModKit_log_kv_decode [--json] <structured log> [timestamp_format]
+ *
+ * Each record is printed as the text log would render it, under timestamp_format (AsyncLoggerConfig's default when
+ * omitted), or with --json as one JSON object per line. A summary of the schemas and records goes to stderr. The file
+ * may still be open in a running process; see log_kv.hpp for the format.
+ *
+ * Exit status: 0 when the whole file decoded, 1 when it ends inside a record (a crash mid-write), 2 on a usage error
+ * or a file that is not a structured log.
+ *
+ * Build with -DDMK_BUILD_TOOLS=ON. Executable: DetourModKit_log_kv_decode
+ */
+
+#include "DetourModKit/log_kv.hpp"
+
+#include <cstdio>
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    namespace dmk = DetourModKit;
+
+    /// One formatted line to @p stream.
+    template <typename... Args> void print_line(std::FILE *stream, std::format_string<Args...> format, Args &&...args)
+    {
+        const std::string line = std::format(format, std::forward<Args>(args)...);
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+
+    int usage()
+    {
+        print_line(stderr, "usage: DetourModKit_log_kv_decode [--json] <structured log> [timestamp_format]");
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool json = false;
+    std::vector<std::string_view> positional;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg == "--json")
+        {
+            json = true;
+        }
+        else
+        {
+            positional.push_back(arg);
+        }
+    }
+    if (positional.empty() || positional.size() > 2)
+    {
+        return usage();
+    }
+    const std::string path{positional[0]};
+    const std::string_view timestamp_format = positional.size() == 2 ? positional[1] : dmk::DEFAULT_TIMESTAMP_FORMAT;
+
+    const dmk::Result<dmk::log_kv::Decoded> decoded = dmk::log_kv::read_file(path);
+    if (!decoded)
+    {
+        print_line(stderr, "{}: {}", path, decoded.error().message());
+        return 2;
+    }
+    for (const dmk::log_kv::Event &event : decoded->events)
+    {
+        const std::string line = json ? dmk::log_kv::format_json(*decoded, event)
+                                      : dmk::log_kv::format_text(*decoded, event, timestamp_format);
+        std::fputs(line.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
+    print_line(stderr, "{}: {} schemas, {} records{}", path, decoded->schemas.size(), decoded->events.size(),
+               decoded->truncated ? ", cut short" : "");
+    return decoded->truncated ? 1 : 0;
+}
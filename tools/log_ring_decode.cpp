@@ -0,0 +1,68 @@
+/**
+ * @file log_ring_decode.cpp
+ * @brief Command-line crash ring decoder: prints the lines an async logger left in its crash ring, oldest first.
+ *
+ * Usage: DetourModKit_log_ring_decode <ring file> [timestamp_format]
+ *
+ * Each surviving line is printed the way the log file renders it, under timestamp_format (AsyncLoggerConfig's
+ * default when omitted). A summary of the lines claimed, kept and torn goes to stderr. The ring may still be mapped by
+ * a running process; see log_ring.hpp for the format.
+ *
+ * Exit status: 0 when every written slot decoded, 1 when some were torn, 2 on a usage error or a file that is not a
+ * crash ring.
+ *
+ * Build with -DDMK_BUILD_TOOLS=ON. Executable: DetourModKit_log_ring_decode
+ */
+
+#include "DetourModKit/log_ring.hpp"
+
+#include <cstdio>
+#include <format>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+    namespace dmk = DetourModKit;
+
+    /// One formatted line to @p stream.
+    template <typename... Args> void print_line(std::FILE *stream, std::format_string<Args...> format, Args &&...args)
+    {
+        const std::string line = std::format(format, std::forward<Args>(args)...);
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+
+    int usage()
+    {
+        print_line(stderr, "usage: DetourModKit_log_ring_decode <ring file> [timestamp_format]");
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        return usage();
+    }
+    const std::string path = argv[1];
+    const std::string_view timestamp_format = argc == 3 ? std::string_view{argv[2]} : dmk::DEFAULT_TIMESTAMP_FORMAT;
+
+    const dmk::Result<dmk::log_ring::Decoded> decoded = dmk::log_ring::read_file(path);
+    if (!decoded)
+    {
+        print_line(stderr, "{}: {}", path, decoded.error().message());
+        return 2;
+    }
+    for (const dmk::log_ring::Record &record : decoded->records)
+    {
+        const std::string line = dmk::log_ring::format_line(record, timestamp_format);
+        std::fputs(line.c_str(), stdout);
+        std::fputc('\n', stdout);
+    }
+    print_line(stderr, "{}: {} lines logged, {} kept, {} torn", path, decoded->total_sequence,
+               decoded->records.size(), decoded->torn_slots);
+    return decoded->torn_slots == 0 ? 0 : 1;
+}
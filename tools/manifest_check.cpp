@@ -0,0 +1,137 @@
+/**
+ * @file manifest_check.cpp
+ * @brief Command-line offline manifest validation: grades a signature manifest, then gates it against PE files.
+ *
+ * Usage: DetourModKit_manifest_check [--strict] [--jobs N] <manifest.ini> <image> [<image> ...]
+ *
+ * Prints the sighealth report for the manifest once, then one block per image: the trusted signatures with their RVAs,
+ * the rejected ones with their resolve status and fingerprint verdict, and the records skipped because they target a
+ * different module or do not compile. No image is loaded or executed; see offline.hpp.
+ *
+ * Exit status: 0 when every image trusts every gated signature, 1 when any image rejected one or failed to map, 2 on a
+ * usage error or an unreadable manifest.
+ *
+ * Build with -DDMK_BUILD_TOOLS=ON. Executable: DetourModKit_manifest_check
+ */
+
+#include "DetourModKit/anchor.hpp"
+#include "DetourModKit/manifest.hpp"
+#include "DetourModKit/offline.hpp"
+#include "DetourModKit/sighealth.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    namespace dmk = DetourModKit;
+
+    /// One formatted line to @p stream.
+    template <typename... Args> void print_line(std::FILE *stream, std::format_string<Args...> format, Args &&...args)
+    {
+        const std::string line = std::format(format, std::forward<Args>(args)...);
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+
+    int usage()
+    {
+        print_line(stderr, "usage: DetourModKit_manifest_check [--strict] [--jobs N] <manifest.ini> <image>...");
+        return 2;
+    }
+
+    std::string_view skip_reason(dmk::offline::SkipReason reason)
+    {
+        return reason == dmk::offline::SkipReason::ForeignModule ? "other module" : "does not compile";
+    }
+
+    /// Prints one image's block; returns true when nothing was rejected.
+    bool print_report(const std::filesystem::path &path, const dmk::Result<dmk::offline::ImageReport> &result)
+    {
+        if (!result)
+        {
+            print_line(stdout, "{}: not validated: {}", path.string(), result.error().message());
+            return false;
+        }
+        const dmk::offline::ImageReport &report = *result;
+        print_line(stdout, "{}: {} trusted, {} rejected, {} skipped (image base 0x{:X}, {} bytes)", path.string(),
+                   report.gate.trusted.size(), report.gate.rejected.size(), report.skipped.size(),
+                   report.preferred_base, report.image_size);
+        for (const dmk::manifest::GatedSignature &trusted : report.gate.trusted)
+        {
+            print_line(stdout, "  ok       {}  rva 0x{:X}", trusted.label, report.rva(trusted));
+        }
+        for (const dmk::manifest::RejectedSignature &rejected : report.gate.rejected)
+        {
+            print_line(stdout, "  REJECTED {}  {} / fingerprint {}", rejected.label,
+                       dmk::anchor::anchor_status_to_string(rejected.status),
+                       dmk::manifest::fingerprint_state_to_string(rejected.fingerprint));
+        }
+        for (const dmk::offline::SkippedRecord &skipped : report.skipped)
+        {
+            print_line(stdout, "  skipped  {}  ({})", skipped.label, skip_reason(skipped.reason));
+        }
+        return report.gate.rejected.empty();
+    }
+} // anonymous namespace
+
+int main(int argc, char **argv)
+{
+    dmk::manifest::GatePolicy policy;
+    std::size_t jobs = 0;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; ++arg)
+    {
+        const std::string_view option = argv[arg];
+        if (option == "--strict")
+        {
+            policy = dmk::manifest::GatePolicy::strict();
+        }
+        else if (option == "--jobs" && arg + 1 < argc)
+        {
+            const std::string_view value = argv[++arg];
+            if (std::from_chars(value.data(), value.data() + value.size(), jobs).ec != std::errc{})
+            {
+                return usage();
+            }
+        }
+        else
+        {
+            return usage();
+        }
+    }
+    if (argc - arg < 2)
+    {
+        return usage();
+    }
+
+    const dmk::Result<dmk::manifest::Manifest> manifest = dmk::manifest::load(argv[arg]);
+    if (!manifest)
+    {
+        print_line(stderr, "{}: {}", argv[arg], manifest.error().message());
+        return 2;
+    }
+    print_line(stdout, "{}", dmk::sighealth::format_report(dmk::sighealth::analyze_manifest(*manifest)));
+
+    const std::vector<std::filesystem::path> images(argv + arg + 1, argv + argc);
+    const auto reports = dmk::offline::validate_all(images, *manifest, policy, jobs);
+    if (!reports)
+    {
+        print_line(stderr, "validation failed: {}", reports.error().message());
+        return 2;
+    }
+    bool clean = true;
+    for (std::size_t i = 0; i < images.size(); ++i)
+    {
+        clean = print_report(images[i], (*reports)[i]) && clean;
+    }
+    return clean ? 0 : 1;
+}
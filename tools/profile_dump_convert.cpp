@@ -0,0 +1,76 @@
+/**
+ * @file profile_dump_convert.cpp
+ * @brief Command-line profile dump converter: turns a Profiler::export_binary() dump into Chrome trace JSON.
+ *
+ * Usage: DetourModKit_profile_dump_convert <dump> [output.json]
+ *
+ * The JSON goes to output.json, or to stdout when it is omitted, and matches what Profiler::export_chrome_json() would
+ * have produced from the same samples; open it in chrome://tracing or https://ui.perfetto.dev. A summary of the names
+ * and samples goes to stderr. See profile_dump.hpp for the format.
+ *
+ * Exit status: 0 when the whole dump converted, 1 when it ends inside a record (the process died mid-export), 2 on a
+ * usage error, a file that is not a profile dump, or an output file that cannot be written.
+ *
+ * Build with -DDMK_BUILD_TOOLS=ON. Executable: DetourModKit_profile_dump_convert
+ */
+
+#include "DetourModKit/profile_dump.hpp"
+
+#include <cstdio>
+#include <format>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace
+{
+    namespace dmk = DetourModKit;
+
+    /// One formatted line to @p stream.
+    template <typename... Args> void print_line(std::FILE *stream, std::format_string<Args...> format, Args &&...args)
+    {
+        const std::string line = std::format(format, std::forward<Args>(args)...);
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+
+    int usage()
+    {
+        print_line(stderr, "usage: DetourModKit_profile_dump_convert <dump> [output.json]");
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        return usage();
+    }
+    const std::string path{argv[1]};
+
+    const dmk::Result<dmk::profile_dump::Decoded> decoded = dmk::profile_dump::read_file(path);
+    if (!decoded)
+    {
+        print_line(stderr, "{}: {}", path, decoded.error().message());
+        return 2;
+    }
+    const std::string json = dmk::profile_dump::format_chrome_json(*decoded);
+    if (argc == 3)
+    {
+        std::ofstream out(argv[2], std::ios::binary);
+        if (!out || !out.write(json.data(), static_cast<std::streamsize>(json.size())))
+        {
+            print_line(stderr, "{}: cannot write", argv[2]);
+            return 2;
+        }
+    }
+    else
+    {
+        std::fwrite(json.data(), 1, json.size(), stdout);
+        std::fputc('\n', stdout);
+    }
+    print_line(stderr, "{}: {} names, {} samples{}", path, decoded->names.size(), decoded->samples.size(),
+               decoded->truncated ? ", cut short" : "");
+    return decoded->truncated ? 1 : 0;
+}
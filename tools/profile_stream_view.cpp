@@ -0,0 +1,135 @@
+/**
+ * @file profile_stream_view.cpp
+ * @brief Command-line live profile viewer: follows a running process's profile stream and writes Chrome trace JSON.
+ *
+ * Usage: DetourModKit_profile_stream_view <pid> [seconds]
+ *
+ * The process must have called Profiler::start_stream(). Every sample published while the viewer runs goes to stdout
+ * as one Chrome Trace Event per line, inside a JSON array that is closed when the viewer stops, so the output opens
+ * in chrome://tracing or https://ui.perfetto.dev. It stops after @p seconds (default: until the process stops
+ * streaming or exits). A summary of the samples read and lost goes to stderr. See profile_stream.hpp for the format.
+ *
+ * Exit status: 0 when every sample published while it ran was read, 1 when some were lost (the viewer fell a whole
+ * ring behind), 2 on a usage error or a process with no stream.
+ *
+ * Build with -DDMK_BUILD_TOOLS=ON. Executable: DetourModKit_profile_stream_view
+ */
+
+#include "DetourModKit/profile_dump.hpp"
+#include "DetourModKit/profile_stream.hpp"
+
+#include <windows.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <format>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    namespace dmk = DetourModKit;
+
+    /// How long the viewer sleeps when a poll finds nothing new.
+    constexpr auto IDLE_POLL_INTERVAL = std::chrono::milliseconds(5);
+
+    /// One formatted line to @p stream.
+    template <typename... Args> void print_line(std::FILE *stream, std::format_string<Args...> format, Args &&...args)
+    {
+        const std::string line = std::format(format, std::forward<Args>(args)...);
+        std::fputs(line.c_str(), stream);
+        std::fputc('\n', stream);
+    }
+
+    int usage()
+    {
+        print_line(stderr, "usage: DetourModKit_profile_stream_view <pid> [seconds]");
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        return usage();
+    }
+    char *end = nullptr;
+    const unsigned long pid = std::strtoul(argv[1], &end, 10);
+    if (end == argv[1] || *end != '\0' || pid == 0)
+    {
+        return usage();
+    }
+    double seconds = 0.0;
+    if (argc == 3)
+    {
+        seconds = std::strtod(argv[2], &end);
+        if (end == argv[2] || *end != '\0' || seconds <= 0.0)
+        {
+            return usage();
+        }
+    }
+
+    dmk::Result<dmk::profile_stream::StreamReader> opened =
+        dmk::profile_stream::StreamReader::open(static_cast<std::uint32_t>(pid));
+    if (!opened)
+    {
+        print_line(stderr, "process {}: no profile stream: {}", pid, opened.error().message());
+        return 2;
+    }
+    dmk::profile_stream::StreamReader &reader = *opened;
+    const double ticks_to_us = 1'000'000.0 / static_cast<double>(reader.qpc_frequency());
+    // A process that dies while streaming never takes its producer count back, so its exit is watched as well.
+    HANDLE process = OpenProcess(SYNCHRONIZE, FALSE, static_cast<DWORD>(pid));
+    const auto process_running = [process]()
+    { return process == nullptr || WaitForSingleObject(process, 0) == WAIT_TIMEOUT; };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(seconds);
+
+    std::vector<dmk::profile_stream::StreamSample> samples;
+    std::string chunk;
+    std::uint64_t read = 0;
+    std::fputs("[", stdout);
+    for (;;)
+    {
+        samples.clear();
+        // A producer that stopped is read to its end before the viewer leaves.
+        const bool live = reader.producer_live() && process_running();
+        if (reader.poll(samples) == 0)
+        {
+            if (!live || (seconds > 0.0 && std::chrono::steady_clock::now() >= deadline))
+            {
+                break;
+            }
+            std::this_thread::sleep_for(IDLE_POLL_INTERVAL);
+            continue;
+        }
+        chunk.clear();
+        for (const dmk::profile_stream::StreamSample &sample : samples)
+        {
+            chunk += read++ == 0 ? "\n" : ",\n";
+            const std::string_view name = reader.name(sample.name);
+            dmk::profile_dump::detail::append_chrome_event(chunk, name.empty() ? std::string_view{"?"} : name,
+                                                           sample.start_ticks, sample.duration_us, sample.thread_id,
+                                                           ticks_to_us);
+        }
+        std::fwrite(chunk.data(), 1, chunk.size(), stdout);
+        std::fflush(stdout);
+        if (seconds > 0.0 && std::chrono::steady_clock::now() >= deadline)
+        {
+            break;
+        }
+    }
+    std::fputs(read == 0 ? "]\n" : "\n]\n", stdout);
+    if (process != nullptr)
+    {
+        CloseHandle(process);
+    }
+
+    print_line(stderr, "process {}: {} samples, {} lost", pid, read, reader.dropped());
+    return reader.dropped() == 0 ? 0 : 1;
+}